@@ -58,13 +58,16 @@
 #include <fm_alos_logging.h>
 #include <fm_alos_init.h>
 #include <fm_alos_time.h>
+#include <fm_alos_lock_prof.h>
 #include <fm_alos_lock.h>
 #include <fm_alos_rwlock.h>
 #include <fm_alos_sem.h>
 #include <fm_alos_event_queue.h>
 #include <fm_alos_threads.h>
 #include <fm_alos_alloc.h>
+#include <fm_alos_arena.h>
 #include <fm_alos_dynamic_load.h>
 #include <fm_alos_rand.h>
+#include <fm_alos_atomic.h>
 
 #endif /* __FM_FM_ALOS_H */
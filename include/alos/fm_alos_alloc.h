@@ -53,6 +53,43 @@
 typedef fm_status (*fm_getDataRootHandler)(void);
 
 
+/**************************************************/
+/** \ingroup constSystem
+ *  The number of allocation tags, one per log
+ *  category bit plus ''FM_ALLOC_TAG_UNTAGGED''.
+ *  See ''fmAllocTagged''.
+ **************************************************/
+#define FM_ALLOC_NUM_TAGS       65
+
+/** The allocation tag of memory allocated with
+ *  ''fmAlloc''.
+ *  \ingroup constSystem */
+#define FM_ALLOC_TAG_UNTAGGED   64
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ *  Memory statistics of an allocation tag, as
+ *  returned by ''fmGetAllocTagStats''. Sizes include
+ *  the allocator's rounding and object header.
+ **************************************************/
+typedef struct _fm_allocTagStats
+{
+    /** Bytes currently allocated. */
+    fm_uint64 liveBytes;
+
+    /** Highest value liveBytes ever reached. */
+    fm_uint64 peakBytes;
+
+    /** Number of allocations since the shared memory was created. */
+    fm_uint64 allocs;
+
+    /** Number of frees since the shared memory was created. */
+    fm_uint64 frees;
+
+} fm_allocTagStats;
+
+
 /** A legacy synonym for ''fmDbgDumpAllocStats''. 
  *  \ingroup macroSynonym */
 #define fmPrintAllocationStatistics fmDbgDumpAllocStats
@@ -60,19 +97,23 @@ typedef fm_status (*fm_getDataRootHandler)(void);
 
 /* Public functions */
 void *fmAlloc(fm_uint size);
+void *fmAllocTagged(fm_uint size, fm_uint64 category);
 void fmFree(void *obj);
 
 fm_status fmGetRoot(const char *          rootName,
                     void **               rootPtr,
                     fm_getDataRootHandler rootFunc);
+fm_status fmFindRoot(const char *rootName, void **rootPtr);
 fm_status fmGetAvailableSharedVirtualBaseAddress(void **ptr);
 fm_status fmIsMasterProcess(fm_bool *isMaster);
+fm_status fmGetAllocTagStats(fm_uint64 category, fm_allocTagStats *stats);
 
 
 /***************************************************
  * Private functions
  **************************************************/
 fm_status fmMemInitialize(void);
+fm_status fmMemAttach(void);
 
 
 /***************************************************
@@ -80,6 +121,8 @@ fm_status fmMemInitialize(void);
  **************************************************/
 void fmPrintAllocationStatistics(void);
 void fmGetAllocatedMemorySize(fm_uint32 *allocMemory);
+void fmGetSharedMemoryFootprint(fm_uint64 *footprint);
+void fmDbgDumpAllocTagStats(void);
 void fmDbgDumpAllocCallStacks(fm_uint bufSize);
 
 
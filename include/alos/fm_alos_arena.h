@@ -0,0 +1,60 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:           fm_alos_arena.h
+ * Creation Date:  October 14, 2026
+ * Description:    ALOS arena allocator for transient allocations
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#ifndef __FM_FM_ALOS_ARENA_H
+#define __FM_FM_ALOS_ARENA_H
+
+
+/** Default arena chunk size, in bytes */
+#define FM_ARENA_DEFAULT_CHUNK_SIZE     16384
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ * An arena hands out memory carved sequentially
+ * from large fmAlloc'd chunks. Individual
+ * allocations are never freed; all of them are
+ * released at once with ''fmResetArena'' or
+ * ''fmDestroyArena''. An arena is not thread safe,
+ * the caller is responsible for serializing access.
+ * The structure is opaque, see fm_alos_arena.c.
+ **************************************************/
+typedef struct _fm_arena    fm_arena;
+
+
+fm_status fmCreateArena(fm_uint chunkSize, fm_arena **arena);
+void *fmArenaAlloc(fm_arena *arena, fm_uint size);
+void fmResetArena(fm_arena *arena);
+void fmDestroyArena(fm_arena *arena);
+
+#endif /* __FM_FM_ALOS_ARENA_H */
@@ -0,0 +1,95 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:           fm_alos_atomic.h
+ * Creation Date:  October, 2026
+ * Description:    ALOS wrappers for atomic memory operations
+ *
+ * Copyright (c) 2013, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#ifndef __FM_FM_ALOS_ATOMIC_H
+#define __FM_FM_ALOS_ATOMIC_H
+
+
+/*****************************************************************************
+ * Atomic operations on naturally aligned integer and pointer variables.
+ *
+ * FM_ATOMIC_LOAD has acquire semantics and FM_ATOMIC_STORE has release
+ * semantics, so a value published with FM_ATOMIC_STORE makes every prior
+ * write visible to the thread that observes it with FM_ATOMIC_LOAD. The
+ * read-modify-write operations are sequentially consistent.
+ *****************************************************************************/
+
+#define FM_ATOMIC_LOAD(ptr)                                 \
+    __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+
+#define FM_ATOMIC_STORE(ptr, val)                           \
+    __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+
+/* Returns the value after the addition */
+#define FM_ATOMIC_ADD(ptr, val)                             \
+    __atomic_add_fetch((ptr), (val), __ATOMIC_SEQ_CST)
+
+/* Returns the value after the subtraction */
+#define FM_ATOMIC_SUB(ptr, val)                             \
+    __atomic_sub_fetch((ptr), (val), __ATOMIC_SEQ_CST)
+
+/* Returns the value after the bitwise or */
+#define FM_ATOMIC_OR(ptr, val)                              \
+    __atomic_or_fetch((ptr), (val), __ATOMIC_SEQ_CST)
+
+/* Returns the previous value */
+#define FM_ATOMIC_EXCHANGE(ptr, val)                        \
+    __atomic_exchange_n((ptr), (val), __ATOMIC_SEQ_CST)
+
+/* Stores desired in *ptr if it equals *expectedPtr and returns TRUE.
+ * Otherwise loads the current value into *expectedPtr and returns FALSE. */
+#define FM_ATOMIC_CAS(ptr, expectedPtr, desired)            \
+    __atomic_compare_exchange_n((ptr),                      \
+                                (expectedPtr),              \
+                                (desired),                  \
+                                FALSE,                      \
+                                __ATOMIC_SEQ_CST,           \
+                                __ATOMIC_SEQ_CST)
+
+/* Relaxed variants, for statistics counters that order nothing else.
+ * FM_ATOMIC_ADD_RELAXED returns the value after the addition. */
+#define FM_ATOMIC_LOAD_RELAXED(ptr)                         \
+    __atomic_load_n((ptr), __ATOMIC_RELAXED)
+
+#define FM_ATOMIC_STORE_RELAXED(ptr, val)                   \
+    __atomic_store_n((ptr), (val), __ATOMIC_RELAXED)
+
+#define FM_ATOMIC_ADD_RELAXED(ptr, val)                     \
+    __atomic_add_fetch((ptr), (val), __ATOMIC_RELAXED)
+
+/* Full memory barrier */
+#define FM_ATOMIC_FENCE()                                   \
+    __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+
+#endif /* __FM_FM_ALOS_ATOMIC_H */
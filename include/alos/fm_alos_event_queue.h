@@ -36,6 +36,90 @@
 #define __FM_FM_ALOS_EVENT_QUEUE_H
 
 
+/* Flags for fmEventQueueInitializeV2 */
+
+/* The queue is a lock-free ring of preallocated slots instead of a list */
+#define FM_EVENT_QUEUE_FLAG_RING        (1 << 0)
+
+/** Number of log2 buckets in the event queue depth and dwell time
+ *  histograms, see ''fm_eventQueueStats''. */
+#define FM_EVENT_QUEUE_HIST_BUCKETS     24
+
+/** Number of event types with a dwell time histogram of their own, one
+ *  per bit of the FM_EVENT_XXX event type values. */
+#define FM_EVENT_QUEUE_EVENT_TYPES      32
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ *
+ *  Telemetry of an event queue, returned by
+ *  ''fmGetEventQueueStats''. Bucket 0 of a
+ *  histogram counts zero values, and bucket i > 0
+ *  counts values from 2^(i-1) to 2^i - 1. The last
+ *  bucket also counts all larger values.
+ **************************************************/
+typedef struct _fm_eventQueueStats
+{
+    /** Number of events currently in the queue. */
+    fm_int    size;
+
+    /** Highest number of events the queue has held. */
+    fm_int    maxSize;
+
+    /** Maximum number of events the queue can hold. */
+    fm_int    max;
+
+    /** Number of events added to the queue. */
+    fm_uint64 posted;
+
+    /** Number of events taken out of the queue. */
+    fm_uint64 popped;
+
+    /** Number of events refused with FM_ERR_EVENT_QUEUE_FULL. */
+    fm_uint64 fullDrops;
+
+    /** Histogram of the number of events in the queue, sampled each
+     *  time an event is added. */
+    fm_uint64 depthHist[FM_EVENT_QUEUE_HIST_BUCKETS];
+
+    /** Histograms of the time in microseconds events spent in the queue,
+     *  indexed by the bit number of their event type (for example, index
+     *  7 for FM_EVENT_PORT). */
+    fm_uint64 dwellHist[FM_EVENT_QUEUE_EVENT_TYPES]
+                       [FM_EVENT_QUEUE_HIST_BUCKETS];
+
+    /** Number of times ''fmAllocateEvent'' blocked a low priority event
+     *  because free events were running low. This counter is common to
+     *  all queues. */
+    fm_uint64 lowPriorityBlocks;
+
+    /** Number of those blocked allocations that timed out and failed.
+     *  This counter is common to all queues. */
+    fm_uint64 lowPriorityTimeouts;
+
+} fm_eventQueueStats;
+
+
+/**************************************************/
+/** \ingroup intTypeStruct
+ *
+ *  A slot of a ring event queue.
+ **************************************************/
+typedef struct _fm_eventQueueSlot
+{
+    /** Ring position the slot is ready for: equal to the position when
+     *  the slot is free for a producer, to the position plus one when it
+     *  holds the event of that position for a consumer. */
+    fm_uint64 seq;
+
+    /** The queued event, or NULL (a tombstone) if it was taken out by
+     *  fmEventQueueRemove. */
+    fm_event *event;
+
+} fm_eventQueueSlot;
+
+
 /**************************************************/
 /** \ingroup intTypeStruct
  *
@@ -46,6 +130,24 @@ typedef struct _fm_eventQueue
     /** The heart of the queue is a doubly-linked list */
     fm_dlist eventQueue;
 
+    /** TRUE if the queue is a ring of slots, used instead of eventQueue
+     *  and accessLock. The ring is a bounded multi-producer multi-consumer
+     *  queue, where producers and consumers claim positions with atomic
+     *  operations on enqueuePos and dequeuePos. */
+    fm_bool            isRing;
+
+    /** Ring slots, a power of two in number */
+    fm_eventQueueSlot *ring;
+
+    /** Number of ring slots minus one */
+    fm_uint64          ringMask;
+
+    /** Next ring position to enqueue at */
+    fm_uint64          enqueuePos;
+
+    /** Next ring position to dequeue from */
+    fm_uint64          dequeuePos;
+
     /** lock for both queue read and write access */
     fm_lock  accessLock;
 
@@ -68,11 +170,21 @@ typedef struct _fm_eventQueue
     fm_float minTime;
     fm_float maxTime;
 
+    /** Telemetry, always maintained, see ''fm_eventQueueStats''. */
+    fm_uint64 fullDrops;
+    fm_uint64 depthHist[FM_EVENT_QUEUE_HIST_BUCKETS];
+    fm_uint64 dwellHist[FM_EVENT_QUEUE_EVENT_TYPES]
+                       [FM_EVENT_QUEUE_HIST_BUCKETS];
+
 } fm_eventQueue;
 
 
 /* (non-blocking) initializes the queue, should be only done once */
 fm_status fmEventQueueInitialize(fm_eventQueue *q, int maxSize, fm_text qName);
+fm_status fmEventQueueInitializeV2(fm_eventQueue *q,
+                                   int            maxSize,
+                                   fm_text        qName,
+                                   fm_uint        flags);
 
 
 /* (blocking) enqueue an event at current + timeDelta time */
@@ -83,6 +195,17 @@ fm_status fmEventQueueAdd(fm_eventQueue *q, fm_event *event);
 fm_status fmEventQueueGet(fm_eventQueue *q, fm_event **eventPtr);
 
 
+/* (blocking) enqueue or get a batch of events under a single lock hold */
+fm_status fmEventQueueAddMultiple(fm_eventQueue *q,
+                                  fm_int         numEvents,
+                                  fm_event **    events,
+                                  fm_int *       numAdded);
+fm_status fmEventQueueGetMultiple(fm_eventQueue *q,
+                                  fm_int         maxEvents,
+                                  fm_event **    events,
+                                  fm_int *       numEvents);
+
+
 /* (non-blocking) peek the next event */
 fm_status fmEventQueuePeek(fm_eventQueue *q, fm_event **eventPtr);
 
@@ -98,5 +221,14 @@ fm_status fmEventQueueCount(fm_eventQueue *q, fm_int *eventCount);
 fm_status fmEventQueueRemove(fm_eventQueue *q,
                              fm_event *eventPtr);
 
+/* (non-blocking) snapshot or clear the queue telemetry */
+void fmEventQueueGetStats(fm_eventQueue *q, fm_eventQueueStats *stats);
+void fmEventQueueResetStats(fm_eventQueue *q);
+
+/* file descriptors to poll for API notifications */
+fm_status fmCreateEventNotifier(fm_int *fd);
+fm_status fmSignalEventNotifier(fm_int fd);
+fm_status fmDestroyEventNotifier(fm_int fd);
+
 
 #endif /* __FM_FM_ALOS_EVENT_QUEUE_H */
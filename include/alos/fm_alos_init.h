@@ -37,6 +37,7 @@
 
 /* sets up any ALOS related initial structures */
 fm_status fmOSInitialize(void);
+fm_status fmOSAttach(void);
 fm_status fmInitProcess(void);
 
 
@@ -77,6 +77,19 @@ typedef struct _fm_lock
     /** Used internally by ALOS to hold the thread ID of owner. */
     void *              owner;
 
+    /** Used internally by ALOS. TRUE if handle points to a futex word
+     *  rather than to an operating system mutex. See the api.lock.fastPath
+     *  property. */
+    fm_bool             fastPath;
+
+    /** Used internally by ALOS to hold the contention profile of the lock
+     *  when the SDK is built with FM_LOCK_PROFILING, NULL otherwise. */
+    struct _fm_lockProfile *profile;
+
+    /** Used internally by ALOS to hold the time at which the owner took
+     *  the lock, while the lock is being profiled. */
+    fm_uint64           profHoldStart;
+
 } fm_lock;
 
 
@@ -0,0 +1,76 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:           fm_alos_lock_prof.h
+ * Creation Date:  October 15, 2026
+ * Description:    Lock contention profiling
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#ifndef __FM_FM_ALOS_LOCK_PROF_H
+#define __FM_FM_ALOS_LOCK_PROF_H
+
+
+/** Number of log2 buckets in the wait and hold time histograms */
+#define FM_LOCK_PROF_HIST_BUCKETS       40
+
+/** Number of longest holds recorded per lock, with their call sites */
+#define FM_LOCK_PROF_TOP_HOLDERS        8
+
+/** Size of the call site string recorded for each of the longest holds */
+#define FM_LOCK_PROF_CALLER_SIZE        160
+
+/** Number of stack frames recorded as the call site of a hold */
+#define FM_LOCK_PROF_CALLER_DEPTH       3
+
+
+/**************************************************/
+/** \ingroup intTypeStruct
+ * Contention profile of a lock or reader-writer
+ * lock, present when the SDK is built with
+ * FM_LOCK_PROFILING. The structure is opaque, see
+ * fm_alos_lock_prof.c.
+ **************************************************/
+typedef struct _fm_lockProfile  fm_lockProfile;
+
+
+/* Timestamp used for wait and hold times: the time stamp counter where
+ * there is one, nanoseconds otherwise. */
+#define FM_LOCK_PROF_TSC()              FM_GET_CYCLES()
+
+fm_lockProfile *fmAllocLockProfile(void);
+void fmFreeLockProfile(fm_lockProfile *prof);
+void fmLockProfRecordAcquire(fm_lockProfile *prof,
+                             fm_uint64       waitStart,
+                             fm_uint64       acquired);
+void fmLockProfRecordRelease(fm_lockProfile *prof, fm_uint64 holdStart);
+
+fm_status fmDbgEnableLockProfile(fm_bool enable);
+void fmDbgDumpLockProfile(void);
+void fmDbgResetLockProfile(void);
+
+#endif /* __FM_FM_ALOS_LOCK_PROF_H */
@@ -163,6 +163,15 @@ enum _fm_loggingAttr
      *  as specified by ''fmSetLoggingType''. */
     FM_LOG_ATTR_LOG_FILENAME,
 
+    /** Type fm_bool: Indicates whether the calling process queues console
+     *  and file log messages for its background writer thread, as set by
+     *  ''fmSetLoggingAsync''. */
+    FM_LOG_ATTR_ASYNC,
+
+    /** Type fm_uint64: Number of log messages the calling process has
+     *  discarded because a thread's asynchronous logging ring was full. */
+    FM_LOG_ATTR_ASYNC_DROPPED,
+
     /** UNPUBLISHED: For internal use only. */
     FM_LOG_ATTRIBUTE_MAX
 
@@ -804,6 +813,8 @@ fm_status fmSetLoggingType(fm_loggingType logType,
                            fm_bool        clear,
                            void *         arg);
 
+fm_status fmSetLoggingAsync(fm_bool enable);
+
 fm_status fmSetLoggingVerbosity(fm_uint32 verbosityMask);
 fm_status fmGetLoggingVerbosity(fm_uint32 *verbosityMask);
 
@@ -817,6 +828,8 @@ fm_status fmSetLoggingFilter(fm_uint64   categoryMask,
                              const char *functionFilter,
                              const char *fileFilter);
 
+fm_bool fmLogIsEnabled(fm_uint64 categories, fm_uint64 logLevel);
+
 fm_status fmLogMessage(fm_uint64   categories,
                        fm_uint64   logLevel,
                        const char *srcFile,
@@ -934,6 +947,43 @@ fm_status fmFaultInjection(const char *functionName);
 #define FM_INJECT_FAULT_ON_EXIT()
 #endif
 
+/***************************************************************************/
+/** \ingroup constSystem
+ * @{ */
+
+/** Log levels that are compiled in. Messages at any other level are
+ *  eliminated at compile time, arguments included, instead of being
+ *  filtered out at run time by ''fmEnableLoggingLevel''. Normally set
+ *  with the --with-log-static-level-mask configure option. Error, fatal,
+ *  assert and print messages are always compiled in. */
+#ifndef FM_LOG_STATIC_LEVEL_MASK
+#define FM_LOG_STATIC_LEVEL_MASK        FM_LOG_LEVEL_ALL_VERBOSE
+#endif
+
+/** Log categories that are compiled in, see ''FM_LOG_STATIC_LEVEL_MASK''.
+ *  Normally set with the --with-log-static-category-mask configure
+ *  option. */
+#ifndef FM_LOG_STATIC_CATEGORY_MASK
+#define FM_LOG_STATIC_CATEGORY_MASK     FM_LOG_CAT_ALL
+#endif
+
+/** @} (end of Doxygen group) */
+
+/* Log levels that FM_LOG_STATIC_LEVEL_MASK cannot compile out */
+#define FM_LOG_STATIC_LEVEL_ALWAYS  \
+    (FM_LOG_LEVEL_FATAL   |         \
+     FM_LOG_LEVEL_ERROR   |         \
+     FM_LOG_LEVEL_ASSERT  |         \
+     FM_LOG_LEVEL_PRINT)
+
+/* TRUE if a message with the given category and level is compiled in.
+ * Folds to a constant when cat and level are constants, which lets the
+ * compiler drop the call altogether. */
+#define FM_LOG_STATIC_ENABLED(cat, level)                                   \
+    ( ( (level) & FM_LOG_STATIC_LEVEL_ALWAYS ) != 0 ||                      \
+      ( ( (level) & FM_LOG_STATIC_LEVEL_MASK ) == (level) &&                \
+        ( (cat) & FM_LOG_STATIC_CATEGORY_MASK ) != 0 ) )
+
 /***************************************************************************/
 /** A generic logging macro. May be used at any place in the code to
  *  generate a log message, but is typically called from the other
@@ -955,9 +1005,11 @@ fm_status fmFaultInjection(const char *functionName);
 #ifndef FM_ALOS_LOGGING_SUBSYSTEM
 #define FM_LOG_PRINTF(cat, level, ...)  { }
 #else
-#define FM_LOG_PRINTF(cat, level, ...)      \
-    fmLogMessage( (cat), (level), __FILE__, \
-                 __func__, __LINE__, __VA_ARGS__ )
+#define FM_LOG_PRINTF(cat, level, ...)                          \
+    ( FM_LOG_STATIC_ENABLED( (cat), (level) ) ?                 \
+      (void) fmLogMessage( (cat), (level), __FILE__,            \
+                           __func__, __LINE__, __VA_ARGS__ ) :  \
+      (void) 0 )
 #endif
 
 /***************************************************************************/
@@ -985,9 +1037,11 @@ fm_status fmFaultInjection(const char *functionName);
 #ifndef FM_ALOS_LOGGING_SUBSYSTEM
 #define FM_LOG_PRINTF_V2(cat, level, objectId, ...)  { }
 #else
-#define FM_LOG_PRINTF_V2(cat, level, objectId, ...)      \
-    fmLogMessageV2( (cat), (level), (objectId), __FILE__, \
-                   __func__, __LINE__, __VA_ARGS__ )
+#define FM_LOG_PRINTF_V2(cat, level, objectId, ...)                 \
+    ( FM_LOG_STATIC_ENABLED( (cat), (level) ) ?                     \
+      (void) fmLogMessageV2( (cat), (level), (objectId), __FILE__,  \
+                             __func__, __LINE__, __VA_ARGS__ ) :    \
+      (void) 0 )
 #endif
 
 
@@ -1011,9 +1065,11 @@ fm_status fmFaultInjection(const char *functionName);
 #ifndef FM_ALOS_FUNCTION_LOGGING
 #define FM_LOG_FUNC(cat, level, ...)  { }
 #else
-#define FM_LOG_FUNC(cat, level, ...)                \
-   fmLogMessage((cat), (level), __FILE__,           \
-                __func__, __LINE__, __VA_ARGS__ )
+#define FM_LOG_FUNC(cat, level, ...)                          \
+   ( FM_LOG_STATIC_ENABLED( (cat), (level) ) ?                \
+     (void) fmLogMessage((cat), (level), __FILE__,            \
+                         __func__, __LINE__, __VA_ARGS__ ) :  \
+     (void) 0 )
 #endif
 
 /***************************************************************************/
@@ -1039,9 +1095,11 @@ fm_status fmFaultInjection(const char *functionName);
 #ifndef FM_ALOS_FUNCTION_LOGGING
 #define FM_LOG_FUNC_V2(cat, level, objectId, ...)  { }
 #else
-#define FM_LOG_FUNC_V2(cat, level, objectId, ...)           \
-   fmLogMessageV2((cat), (level), (objectId), __FILE__,     \
-                  __func__, __LINE__, __VA_ARGS__ )
+#define FM_LOG_FUNC_V2(cat, level, objectId, ...)                 \
+   ( FM_LOG_STATIC_ENABLED( (cat), (level) ) ?                    \
+     (void) fmLogMessageV2((cat), (level), (objectId), __FILE__,  \
+                           __func__, __LINE__, __VA_ARGS__ ) :    \
+     (void) 0 )
 #endif
 
 
@@ -1137,6 +1195,7 @@ fm_status fmFaultInjection(const char *functionName);
     {                                                                                 \
         FM_LOG_FUNC( (cat), FM_LOG_LEVEL_FUNC_ENTRY_API, "Entering... " __VA_ARGS__ ); \
         FM_DBG_TRACK_FUNC();                                                          \
+        FM_DBG_API_PROF_ENTRY();                                                      \
     }    
 
 /***************************************************************************/
@@ -1159,6 +1218,7 @@ fm_status fmFaultInjection(const char *functionName);
                          (objectId),                   \
                          "Entering... " __VA_ARGS__ ); \
         FM_DBG_TRACK_FUNC();                           \
+        FM_DBG_API_PROF_ENTRY();                       \
     }
         
 
@@ -1575,6 +1635,7 @@ fm_status fmFaultInjection(const char *functionName);
         FM_INJECT_FAULT_ON_EXIT();                                                 \
         FM_LOG_FUNC( (cat), FM_LOG_LEVEL_FUNC_EXIT_API, "Exit Status %d (%s)\n",   \
                       (errcode), fmErrorMsg( (errcode) ) );                        \
+        FM_DBG_API_PROF_EXIT(errcode);                                             \
         return errcode;                                                            \
     }
 
@@ -1607,6 +1668,7 @@ fm_status fmFaultInjection(const char *functionName);
                         "Exit Status %d (%s)\n",                             \
                         (errcode),                                           \
                         fmErrorMsg( (errcode) ) );                           \
+        FM_DBG_API_PROF_EXIT(errcode);                                       \
         return errcode;                                                      \
     }
 
@@ -58,6 +58,10 @@ typedef struct _fm_rwLockThreadEntry
      *  collection. */
     fm_uint             takenCount;
 
+    /** Time at which the thread took the lock, while the lock is being
+     *  profiled. */
+    fm_uint64           profHoldStart;
+
 } fm_rwLockThreadEntry;
 
 
@@ -118,6 +122,10 @@ typedef struct _fm_rwLock
         waiting to be promoted */
     fm_bitArray           readerToBePromoted;
 
+    /** Used internally by ALOS to hold the contention profile of the lock
+     *  when the SDK is built with FM_LOCK_PROFILING, NULL otherwise. */
+    struct _fm_lockProfile *profile;
+
 } fm_rwLock;
 
 fm_status fmCreateRwLock(fm_text lockName, fm_rwLock *lck);
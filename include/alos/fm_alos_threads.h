@@ -52,6 +52,41 @@
 typedef void *(*fm_threadBody)(void *);
 
 
+/**************************************************/
+/** \ingroup typeScalar
+ * A function called on thread exit with the
+ * thread's non-NULL value of an ''fm_threadLocal''
+ * variable.
+ **************************************************/
+typedef void (*fm_threadLocalDestructor)(void *);
+
+
+/**************************************************/
+/** \ingroup intTypeStruct
+ * A thread-local storage variable, holding one
+ * pointer per thread. It must be process-local
+ * memory (not in a shared root), statically
+ * initialized with FM_THREAD_LOCAL_INIT.
+ **************************************************/
+typedef struct _fm_threadLocal
+{
+    /** Called on thread exit with the thread's value, may be NULL. */
+    fm_threadLocalDestructor destructor;
+
+    /** Used internally by ALOS: whether the key has been created. */
+    fm_bool                  created;
+
+    /** Used internally by ALOS: whether the key could be created. */
+    fm_bool                  valid;
+
+    /** Used internally by ALOS to hold the operating system's key. */
+    fm_uint                  key;
+
+} fm_threadLocal;
+
+#define FM_THREAD_LOCAL_INIT(destructor)  { (destructor), FALSE, FALSE, 0 }
+
+
 /**************************************************/
 /** \ingroup intTypeStruct
  * Thread type used to abstract operating system
@@ -86,7 +121,7 @@ typedef struct _fm_thread
      *  is specified in the call to fmCreateThread. */
     void *              arguments[2];
 
-    /** Pointer to the thread's entry point function (not used). */
+    /** Pointer to the thread's entry point function. */
     fm_threadBody       threadFunc;
 
 } fm_thread;
@@ -97,6 +132,12 @@ extern fm_status fmCreateThread(fm_text       threadName,
                                 fm_threadBody threadFunc,
                                 void *        threadArg,
                                 fm_thread *   thread);
+extern fm_status fmCreateThreadV2(fm_text       threadName,
+                                  fm_int        eventQueueSize,
+                                  fm_uint       eventQueueFlags,
+                                  fm_threadBody threadFunc,
+                                  void *        threadArg,
+                                  fm_thread *   thread);
 
 
 /* called from within a thread to cleanup */
@@ -107,12 +148,28 @@ extern fm_status fmExitThread(fm_thread *thread);
 extern fm_status fmSendThreadEvent(fm_thread *thread,
                                    fm_event * event);
 
+/* posts several events to a thread's event queue at once */
+extern fm_status fmSendThreadEventBatch(fm_thread *thread,
+                                        fm_int     numEvents,
+                                        fm_event **events,
+                                        fm_int *   numSent);
+
 
 /* (blocks) grabs an event off the queue */
 extern fm_status fmGetThreadEvent(fm_thread *   thread,
                                   fm_event **   eventPtr,
                                   fm_timestamp *timeout);
 
+/* (blocks) grabs up to maxEvents events off the queue */
+extern fm_status fmGetThreadEventBatch(fm_thread *   thread,
+                                       fm_int        maxEvents,
+                                       fm_event **   events,
+                                       fm_int *      numEvents,
+                                       fm_timestamp *timeout);
+
+/* (blocks) waits for an event to be on the queue, leaving it there */
+extern fm_status fmWaitForThreadEvent(fm_thread *thread, fm_timestamp *timeout);
+
 
 /* (unblocking) looks at the next event in queue */
 extern fm_status fmPeekThreadEvent(fm_thread *thread,
@@ -127,6 +184,10 @@ extern fm_status fmSignalThreadEventHandler(fm_thread *thread);
 extern fm_status fmWaitThreadExit(fm_thread *thread);
 
 
+/* returns the CPU time consumed so far by a thread */
+extern fm_status fmGetThreadCpuTime(fm_thread *thread, fm_uint64 *nsec);
+
+
 /* yields control to other threads */
 extern fm_status fmYield(void);
 
@@ -153,9 +214,14 @@ extern fm_status fmGetThreadState(void *             threadHandle,
 
 extern fm_lockPrecedence *fmGetCurrentThreadLockCollection(void);
 
+/* Thread-local storage */
+extern void *fmGetThreadLocal(fm_threadLocal *var);
+extern fm_status fmSetThreadLocal(fm_threadLocal *var, void *value);
+
 /* Diagnostics */
 extern fm_status fmDbgRegisterThread(fm_text threadName);
 extern fm_status fmDbgUnregisterThread(void);
+extern fm_status fmDbgDumpThreadPlacement(void);
 
 
 
@@ -89,6 +89,15 @@ typedef void (*fm_timerCallback)( void *arg );
 /* Constant representing an infinite number of timer occurrences */ 
 #define FM_TIMER_REPEAT_FOREVER  -1
 
+/* Reads the free-running cycle counter used for hot-path timestamps: the
+ * time stamp counter on x86, CLOCK_MONOTONIC nanoseconds otherwise. Use
+ * fmCyclesToNsec and fmCyclesToTimestamp to convert readings. */
+#if defined(__x86_64__) || defined(__i386__)
+#define FM_GET_CYCLES()          __builtin_ia32_rdtsc()
+#else
+#define FM_GET_CYCLES()          fmGetMonotonicNsec()
+#endif
+
 
 /*****************************************************************************
  * Global Variables
@@ -118,6 +127,11 @@ void fmSubTimestamps(const fm_timestamp *t1,
                      fm_timestamp *      t3);
 
 fm_status fmGetTime(fm_timestamp *tvp);
+fm_status fmGetTimeFast(fm_timestamp *ts);
+fm_uint64 fmGetMonotonicNsec(void);
+fm_uint64 fmGetCycles(void);
+fm_uint64 fmCyclesToNsec(fm_uint64 cycles);
+void fmCyclesToTimestamp(fm_uint64 cycles, fm_timestamp *ts);
 
 fm_status fmGetTimeRes(fm_timestamp *tr);
 
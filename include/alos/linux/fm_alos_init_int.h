@@ -87,6 +87,17 @@ typedef struct _fm_rootAlos
     fm_int              nrTimerTasks;
     fm_timerTask        timerTasks[FM_ALOS_INTERNAL_MAX_TIMER_TASKS];
 
+    /* Cycle counter and CLOCK_MONOTONIC time at initialization, and the
+     * counter rate, measured on first use. */
+    fm_uint64           cyclesStart;
+    fm_uint64           cyclesStartNsec;
+    fm_float            cyclesPerNsec;
+
+    /* fm_alos_lock_prof.c */
+    fm_bool             lockProfEnabled;
+    fm_uint64           lockProfStartTsc;
+    fm_uint64           lockProfStartNsec;
+
 } fm_rootAlos;
 
 extern fm_rootAlos *      fmRootAlos;
@@ -120,6 +131,14 @@ fm_status fmAlosThreadInit(void);
 fm_status fmAlosLoggingInit(void);
 fm_status fmAlosTimeInit(void);
 
+/* locks used with condition variables, which must be operating system
+ * mutexes regardless of the api.lock.fastPath property */
+fm_status fmCreateCondLock(fm_text lockName, fm_lock *lck);
+
+/* TRUE if a lock with the given profile is to be profiled now */
+#define FM_LOCK_PROF_ACTIVE(prof)   \
+    ( (prof) != NULL && fmRootAlos->lockProfEnabled )
+
 #define GET_PROPERTY()  (&fmRootAlos->property)
 #define GET_FM10000_PROPERTY()  (&fmRootAlos->fm10000_property)
 
@@ -55,6 +55,10 @@
 #include <sys/time.h>
 #include <sys/ipc.h>
 #include <sys/shm.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <linux/mempolicy.h>
 #include <asm/param.h>
 #include <netinet/in.h>
 #include <execinfo.h>
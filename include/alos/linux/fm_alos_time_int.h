@@ -39,6 +39,58 @@ typedef struct _fm_timer fm_timer;
 typedef struct _fm_timerTask fm_timerTask;
 
 
+/* Geometry of the timer wheel: each of the FM_TIMER_WHEEL_LEVELS levels has
+ * FM_TIMER_WHEEL_SLOTS slots, and each slot of a level spans a full
+ * revolution of the level below it. */
+#define FM_TIMER_WHEEL_SLOT_BITS        6
+#define FM_TIMER_WHEEL_SLOTS            (1 << FM_TIMER_WHEEL_SLOT_BITS)
+#define FM_TIMER_WHEEL_SLOT_MASK        (FM_TIMER_WHEEL_SLOTS - 1)
+#define FM_TIMER_WHEEL_LEVELS           4
+
+/* tick of the timer wheel of event-driven timer tasks, in microseconds */
+#define FM_TIMER_WHEEL_EVENT_DRIVEN_TICK    1000
+
+
+/* list of active timers, linked through their active timer node */
+typedef struct _fm_timerList
+{
+    FM_DLL_DEFINE_LIST( _fm_timer, firstActiveTimer, lastActiveTimer );
+
+} fm_timerList;
+
+
+/* hashed hierarchical timer wheel holding the active timers of a task */
+typedef struct _fm_timerWheel
+{
+    /* duration of a tick, in microseconds */
+    fm_uint64        tickUsec;
+
+    /* last tick processed (absolute time divided by tickUsec) */
+    fm_uint64        curTick;
+
+    /* tick at which an event-driven timer task is due to wake up, or 0
+       if it is waiting to be signalled */
+    fm_uint64        wakeupTick;
+
+    /* absolute time matching wakeupTick */
+    fm_timestamp     wakeupTime;
+
+    /* number of timers linked in the slots and the expired list */
+    fm_int           nrTimers;
+
+    /* number of timers linked in the slots of each level */
+    fm_int           levelTimers[FM_TIMER_WHEEL_LEVELS];
+
+    /* timers due to expire, hashed by their expiration tick */
+    fm_timerList     slots[FM_TIMER_WHEEL_LEVELS][FM_TIMER_WHEEL_SLOTS];
+
+    /* timers that expired in the current tick and whose callback hasn't
+       been invoked yet */
+    fm_timerList     expired;
+
+} fm_timerWheel;
+
+
 /* definition of the internal timer structure */
 struct _fm_timer
 {
@@ -69,6 +121,16 @@ struct _fm_timer
     /* number of repetitions so far */
     fm_int         nrRepetitionsSoFar;
 
+    /* expiration tick of the current repetition */
+    fm_uint64      expiryTick;
+
+    /* list of the timer wheel this timer is linked in, NULL if none */
+    fm_timerList   *list;
+
+    /* level of the timer wheel slot this timer is linked in, -1 if it is
+       in the expired list */
+    fm_int         level;
+
     /* callback funciton */
     fm_timerCallback callback;
 
@@ -78,7 +140,7 @@ struct _fm_timer
     /* existing timers linked list node */
     FM_DLL_DEFINE_NODE( _fm_timer, nextTimer, prevTimer );
 
-    /* active timers linked list node */
+    /* timer wheel list node */
     FM_DLL_DEFINE_NODE( _fm_timer, nextActiveTimer, prevActiveTimer );
 
 };
@@ -117,8 +179,8 @@ struct _fm_timerTask
     /* linked list of existing timers */
     FM_DLL_DEFINE_LIST( _fm_timer, firstTimer, lastTimer );
 
-    /* linked list of active timers */
-    FM_DLL_DEFINE_LIST( _fm_timer, firstActiveTimer, lastActiveTimer );
+    /* wheel of active timers */
+    fm_timerWheel    wheel;
 
 };
 
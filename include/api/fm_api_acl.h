@@ -2563,6 +2563,69 @@ typedef struct _fm_aclValue
 
 
 
+/**************************************************/
+/** \ingroup typeStruct
+ * An ACL rule, as returned by ''fmGetACLRuleTableFirst''
+ * and ''fmGetACLRuleTableNext''.
+ **************************************************/
+typedef struct _fm_aclRuleEntry
+{
+    /** The rule number. */
+    fm_int           rule;
+
+    /** Bitmask of the conditions to match on (see ''fm_aclCondition''). */
+    fm_aclCondition  cond;
+
+    /** Values associated with the conditions. */
+    fm_aclValue      value;
+
+    /** Bitmask of the actions of the rule (see ''fm_aclActionExt''). */
+    fm_aclActionExt  action;
+
+    /** Parameters associated with the actions. */
+    fm_aclParamExt   param;
+
+    /** Whether the rule is valid or not. */
+    fm_aclEntryState state;
+
+} fm_aclRuleEntry;
+
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ * Position of a paged walk of the rules of an ACL.
+ * Initialized by ''fmGetACLRuleTableFirst'' and
+ * advanced by ''fmGetACLRuleTableNext''.
+ **************************************************/
+typedef struct _fm_aclCursor
+{
+    /** The ACL being walked. */
+    fm_int          acl;
+
+    /** Position in the rule table. For internal use only. */
+    fm_treeIterator iter;
+
+    /** Generations of the ACL table and of the rule table for which
+     *  iter is valid. For internal use only. */
+    fm_uint         aclsGeneration;
+    fm_uint         rulesGeneration;
+
+    /** Last rule returned, after which the walk resumes if the tables
+     *  changed between pages. For internal use only. */
+    fm_int          lastRule;
+
+    /** TRUE once lastRule is valid. For internal use only. */
+    fm_bool         started;
+
+    /** Set to TRUE if rules were added or deleted while the walk was in
+     *  progress. Rules added behind the cursor are not reported. */
+    fm_bool         tableChanged;
+
+} fm_aclCursor;
+
+
+
 /**************************************************/
 /** \ingroup typeStruct
  * ACL Counters
@@ -2579,6 +2642,25 @@ typedef struct _fm_aclCounters
 } fm_aclCounters;
 
 
+/**************************************************/
+/** \ingroup typeStruct
+ * ACL rule counters
+ * Used as an argument to ''fmGetACLCountList''.
+ **************************************************/
+typedef struct _fm_aclCountEntry
+{
+    /** The ACL number of the counting rule. */
+    fm_int         acl;
+
+    /** The rule number of the counting rule. */
+    fm_int         rule;
+
+    /** The frame and octet counts of the rule. */
+    fm_aclCounters counters;
+
+} fm_aclCountEntry;
+
+
 /**************************************************/
 /** \ingroup typeStruct
  * ACL compiler statistics
@@ -2628,6 +2710,16 @@ typedef struct _fm_aclCompilerStats
     /** Number of IP mapper slots consume by the ACLs. */
     fm_uint     ipMapperSlots;
 
+    /** Number of L4 port mapper ranges merged into the previous range
+     *  because they follow it with the same protocol and mapped value.
+     *  Each merge frees two L4 port mapper slots. */
+    fm_uint     l4MapperRangesMerged;
+
+    /** Number of TCAM entries saved by matching the L4 port ranges
+     *  through the mapper instead of expanding each range into port
+     *  prefixes, counted once for every mapped range. */
+    fm_uint     l4MapperTcamEntriesSaved;
+
     /** Number of cascaded minslices group configured. */
     fm_uint     slicesUsed;
     
@@ -2637,6 +2729,16 @@ typedef struct _fm_aclCompilerStats
     /** Last minslice used by the combined ingress and egress ACLs. */
     fm_uint     lastMinSliceUsed;
 
+    /** Number of ingress ACL rule writes, rule moves included, needed to
+     *  apply the changes without disrupting traffic. Only returned by
+     *  compilations made with the ''FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE''
+     *  or ''FM_ACL_COMPILE_FLAG_INCREMENTAL'' flag, and by applies made
+     *  with the ''FM_ACL_APPLY_FLAG_NON_DISRUPTIVE'' flag. */
+    fm_uint     nonDisruptRuleWrites;
+
+    /** Number of existing rules moved by those writes. */
+    fm_uint     nonDisruptRuleMoves;
+
 } fm_aclCompilerStats;
 
 
@@ -3116,6 +3218,24 @@ typedef struct _fm_aclRuleSliceUsage
  *  \chips  FM6000, FM10000 */
 #define FM_ACL_COMPILE_FLAG_TRY_ALLOC               (1 << 7)
 
+/** The compiler will reuse the ACL image currently applied to the hardware
+ *  and only compile the ACL rules added, deleted or updated since the last
+ *  call to ''fmApplyACL''. ACLs that were not modified keep their FFU
+ *  slices, keys and mappers. A subsequent call to ''fmApplyACL'' without
+ *  flags then only writes these changes to the hardware, without disrupting
+ *  traffic.
+ *                                                                      \lb\lb
+ *  The compiler falls back to a full compilation, followed by a regular
+ *  disruptive ''fmApplyACL'', if no ACL image has been applied yet, if ACL
+ *  attributes or port associations changed since the last disruptive apply,
+ *  or if the changes cannot be placed in the current FFU slice layout.
+ *  Internal ACLs are left as applied. This flag is ignored when
+ *  ''FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE'' or
+ *  ''FM_ACL_COMPILE_FLAG_TRY_ALLOC'' is also specified.
+ *  
+ *  \chips  FM10000 */
+#define FM_ACL_COMPILE_FLAG_INCREMENTAL             (1 << 9)
+
 /** @} (end of Doxygen group) */
 
 /* Placeholders for unimplemented flags - don't include in API document: */
@@ -3442,6 +3562,19 @@ fm_status fmGetACLRuleNextExt(fm_int           sw,
                               fm_aclActionExt *action,
                               fm_aclParamExt * param);
 
+/* reads the rules of an ACL one page at a time */
+fm_status fmGetACLRuleTableFirst(fm_int           sw,
+                                 fm_int           acl,
+                                 fm_aclCursor *   cursor,
+                                 fm_int *         numRules,
+                                 fm_aclRuleEntry *rules,
+                                 fm_int           maxRules);
+fm_status fmGetACLRuleTableNext(fm_int           sw,
+                                fm_aclCursor *   cursor,
+                                fm_int *         numRules,
+                                fm_aclRuleEntry *rules,
+                                fm_int           maxRules);
+
 fm_status fmGetACL(fm_int           sw,
                    fm_int           acl,
                    fm_aclArguments *args);
@@ -3500,6 +3633,11 @@ fm_status fmGetACLCountExt(fm_int          sw,
 fm_status fmResetACLCount(fm_int sw,
                           fm_int acl,
                           fm_int rule);
+fm_status fmGetACLCountList(fm_int            sw,
+                            fm_int            maxEntries,
+                            fm_aclCountEntry *entries,
+                            fm_int *          numEntries,
+                            fm_bool           clear);
 
 fm_status fmGetACLEgressCount(fm_int          sw,
                               fm_int          logicalPort,
@@ -398,6 +398,152 @@ typedef struct _fm_securityStats
 } fm_securityStats;
 
 
+/**************************************************/
+/** \ingroup typeStruct
+ * Position of a paged walk of the MA Table. Initialized
+ * by ''fmGetAddressTableFirst'' and advanced by
+ * ''fmGetAddressTableNext''.
+ **************************************************/
+typedef struct _fm_macTableCursor
+{
+    /** Index of the next MA Table entry to be examined. For internal
+     *  use only. */
+    fm_int      index;
+
+    /** Only the entries written after this generation are returned.
+     *  Zero returns every entry. */
+    fm_uint64   sinceGeneration;
+
+    /** Generation of the MA Table when the walk began. Passing it as the
+     *  sinceGeneration argument of a later walk returns only the entries
+     *  added or modified since this walk began. */
+    fm_uint64   generation;
+
+} fm_macTableCursor;
+
+
+/**************************************************/
+/** \ingroup typeEnum
+ *  Kind of change recorded in the MA Table change
+ *  journal. Reported in the change field of
+ *  ''fm_macJournalEntry''.
+ **************************************************/
+typedef enum
+{
+    /** The entry was added to the MA Table, or rewritten in place without
+     *  a change of port. */
+    FM_MAC_JOURNAL_ADDED = 0,
+
+    /** The entry moved to another port. */
+    FM_MAC_JOURNAL_MOVED,
+
+    /** The entry was removed from the MA Table after it aged out. */
+    FM_MAC_JOURNAL_AGED,
+
+    /** The entry was removed from the MA Table for any other reason. */
+    FM_MAC_JOURNAL_DELETED,
+
+    /** UNPUBLISHED: For internal use only. */
+    FM_MAC_JOURNAL_MAX
+
+} fm_macJournalChange;
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ * One change of the MA Table, as returned by
+ * ''fmGetAddressJournal''.
+ **************************************************/
+typedef struct _fm_macJournalEntry
+{
+    /** Sequence number of the change. Sequence numbers are strictly
+     *  increasing and never reused for the life of the switch. */
+    fm_uint64   sequence;
+
+    /** Kind of change (see ''fm_macJournalChange''). */
+    fm_int      change;
+
+    /** MAC address of the entry. */
+    fm_macaddr  macAddress;
+
+    /** VLAN ID of the entry. */
+    fm_uint16   vlanID;
+
+    /** Logical port of the entry. For FM_MAC_JOURNAL_MOVED, the port the
+     *  entry moved to. */
+    fm_int      port;
+
+    /** Address type. See 'MA Table Entry Types'. */
+    fm_uint16   type;
+
+} fm_macJournalEntry;
+
+
+/** Maximum number of MA Table entries a MAC address and VLAN can hash to.
+ *  \ingroup constSystem */
+#define FM_MAX_MAC_TABLE_BIN_SIZE       4
+
+/** Number of most colliding bins reported in ''fm_macTableStats''.
+ *  \ingroup constSystem */
+#define FM_MAC_TABLE_NUM_HOT_BINS       8
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ * A MA Table bin that overflowed, as reported in
+ * ''fm_macTableStats''.
+ **************************************************/
+typedef struct _fm_macTableHotBin
+{
+    /** MA Table index the MAC addresses of the bin hash to in the first
+     *  bank, -1 if this slot of the report is unused. */
+    fm_int      hashIndex;
+
+    /** Number of addresses that could not be added because the bin was
+     *  full (approximate for bins that entered the report late). */
+    fm_uint64   numFull;
+
+} fm_macTableHotBin;
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ * MA Table occupancy and collision statistics, as
+ * returned by ''fmGetAddressTableStats''. Maintained
+ * as addresses are added, without scanning the
+ * table.
+ **************************************************/
+typedef struct _fm_macTableStats
+{
+    /** Number of entries in the MA Table. */
+    fm_int              tableSize;
+
+    /** Number of valid entries in the MA Table. */
+    fm_int              numValid;
+
+    /** Highest number of valid entries seen. */
+    fm_int              peakValid;
+
+    /** Histogram of the occupancy of the bins new addresses hashed to:
+     *  element N counts the new addresses that found N of the entries of
+     *  their bin already in use. */
+    fm_uint64           binOccupancy[FM_MAX_MAC_TABLE_BIN_SIZE + 1];
+
+    /** Number of addresses that could not be added because their bin was
+     *  full. */
+    fm_uint64           numBinFull;
+
+    /** Number of valid entries when a bin was first found full, being the
+     *  projected usable capacity of the MA Table with the current hash
+     *  inputs. Zero if no bin has been found full. */
+    fm_int              validAtFirstBinFull;
+
+    /** Bins found full most often, most often first. */
+    fm_macTableHotBin   hotBins[FM_MAC_TABLE_NUM_HOT_BINS];
+
+} fm_macTableStats;
+
+
 /*****************************************************************************
  * Function prototypes.
  *****************************************************************************/
@@ -405,6 +551,11 @@ typedef struct _fm_securityStats
 /* adds a new entry to the MA table */
 fm_status fmAddAddress(fm_int sw, fm_macAddressEntry *entry);
 
+/* adds a list of entries to the MA table */
+fm_status fmAddAddressList(fm_int              sw,
+                           fm_int              numEntries,
+                           fm_macAddressEntry *entries);
+
 fm_status fmGetAddress(fm_int              sw,
                        fm_macaddr          address,
                        fm_int              vlanID,
@@ -425,10 +576,48 @@ fm_status fmGetAddressTableExt(fm_int              sw,
 /* deletes an entry from the MA table */
 fm_status fmDeleteAddress(fm_int sw, fm_macAddressEntry *entry);
 
+/* deletes a list of entries from the MA table */
+fm_status fmDeleteAddressList(fm_int              sw,
+                              fm_int              numEntries,
+                              fm_macAddressEntry *entries);
+
 fm_status fmGetAddressTable(fm_int              sw,
                             fm_int *            nEntries,
                             fm_macAddressEntry *entries);
 
+/* reads the MA table one page at a time */
+fm_status fmGetAddressTableFirst(fm_int              sw,
+                                 fm_macTableCursor * cursor,
+                                 fm_uint64           sinceGeneration,
+                                 fm_int *            nEntries,
+                                 fm_macAddressEntry *entries,
+                                 fm_int              maxEntries);
+
+fm_status fmGetAddressTableNext(fm_int              sw,
+                                fm_macTableCursor * cursor,
+                                fm_int *            nEntries,
+                                fm_macAddressEntry *entries,
+                                fm_int              maxEntries);
+
+/* reads the MA table one page at a time without taking any lock */
+fm_status fmGetAddressTableSnapshot(fm_int              sw,
+                                    fm_macTableCursor * cursor,
+                                    fm_int *            nEntries,
+                                    fm_macAddressEntry *entries,
+                                    fm_int              maxEntries);
+
+/* reads the changes of the MA table since a given sequence number */
+fm_status fmGetAddressJournal(fm_int              sw,
+                              fm_uint64           sinceSequence,
+                              fm_int *            nEntries,
+                              fm_macJournalEntry *entries,
+                              fm_int              maxEntries);
+fm_status fmGetAddressJournalSequence(fm_int sw, fm_uint64 *sequence);
+
+/* MA table occupancy and collision statistics */
+fm_status fmGetAddressTableStats(fm_int sw, fm_macTableStats *stats);
+fm_status fmResetAddressTableStats(fm_int sw);
+
 fm_status fmDeleteAllAddresses(fm_int sw);
 fm_status fmDeleteAllAddressesInternal(fm_int sw);
 
@@ -1116,6 +1116,65 @@ enum _fm_switchAttr
      *  \chips  FM10000 */
     FM_SWITCH_NVM_MAC,
 
+    /** Type ''fm_bootPhase'': Used to retrieve the timing of one phase
+     *  of the most recent switch bring-up, selected by the index field.
+     *  Phases are numbered in the order in which they started. Returns
+     *  FM_ERR_NO_MORE when the index is past the last recorded phase.
+     *  This attribute is read-only.
+     *
+     *  \chips  FM10000 */
+    FM_SWITCH_BOOT_PHASE,
+
+    /** Type fm_uint32: Period, in milliseconds, at which a background
+     *  task reads the counters of all cardinal ports and of all allocated
+     *  VLAN counters into a cache. While the cache is enabled, the 32-bit
+     *  MAC error counters returned by ''fmGetPortCounters'' are extended
+     *  to 64 bits across hardware wraps. The smallest period is 10
+     *  milliseconds. The default of 0 disables the cache.
+     *                                                                  \lb\lb
+     *  See ''FM_SWITCH_COUNTER_CACHE_MAX_AGE'' for the reads that are
+     *  served from the cache.
+     *
+     *  \chips  FM10000 */
+    FM_SWITCH_COUNTER_CACHE_INTERVAL,
+
+    /** Type fm_uint32: Largest age, in milliseconds, of the cached
+     *  counters that ''fmGetPortCounters'' and ''fmGetVLANCounters''
+     *  return without accessing the hardware or taking any switch lock.
+     *  Older counters are read from the hardware, which also refreshes
+     *  the cache. Only used while ''FM_SWITCH_COUNTER_CACHE_INTERVAL''
+     *  is nonzero. The default of 0 makes every read access the
+     *  hardware.
+     *
+     *  \chips  FM10000 */
+    FM_SWITCH_COUNTER_CACHE_MAX_AGE,
+
+    /** Type fm_uint32: Number of records in the telemetry ring of the
+     *  switch, see ''fmGetTelemetryRing''. While this attribute and
+     *  ''FM_SWITCH_COUNTER_CACHE_INTERVAL'' are nonzero, each refresh of
+     *  the counter cache also exports the port and VLAN counters to the
+     *  ring. The ring is allocated in shared memory the first time this
+     *  attribute is set and keeps its size until the switch is removed;
+     *  setting another size afterwards returns FM_ERR_INVALID_VALUE. The
+     *  default of 0 means there is no ring.
+     *
+     *  \chips  FM10000 */
+    FM_SWITCH_TELEMETRY_RING_SIZE,
+
+    /** Type fm_uint32: Number of samples held by the sFlow sample ring of
+     *  the switch. While nonzero, frames sampled by an sFlow are placed
+     *  on the ring by the packet receive path, instead of being
+     *  delivered as ''FM_EVENT_SFLOW_PKT_RECV'' events, and are read
+     *  with ''fmReadSFlowSamples''. Only the first
+     *  ''FM_SFLOW_SAMPLE_HEADER_SIZE'' bytes of a frame are kept. The
+     *  ring is allocated the first time this attribute is set and keeps
+     *  its size until the switch is removed; setting another size
+     *  afterwards returns FM_ERR_INVALID_VALUE. The default of 0 means
+     *  there is no ring.
+     *
+     *  \chips  FM10000 */
+    FM_SWITCH_SFLOW_SAMPLE_RING_SIZE,
+
     /** UNPUBLISHED: For internal use only. */
     FM_SWITCH_ATTRIBUTE_MAX
 
@@ -1689,6 +1748,37 @@ typedef enum
 } fm_pcieSpeed;
 
 
+/**************************************************/
+/** \ingroup typeStruct
+ *
+ *  Link-flap damping state of a port. Used as an
+ *  argument to ''fmGetPortAttribute'' for the port
+ *  attribute ''FM_PORT_LINK_DAMPING_STATUS''.
+ **************************************************/
+typedef struct _fm_linkDampingStatus
+{
+    /** TRUE while link up/down events are suppressed. */
+    fm_bool     suppressed;
+
+    /** The link state last reported to the application, which is held
+     *  while the port is suppressed. */
+    fm_bool     reportedLinkUp;
+
+    /** The current penalty, decayed to the time of the read. */
+    fm_uint32   penalty;
+
+    /** Number of link down transitions that were charged a penalty. */
+    fm_uint64   flaps;
+
+    /** Number of times the port entered the suppressed state. */
+    fm_uint64   suppressions;
+
+    /** Number of link up/down events withheld while suppressed. */
+    fm_uint64   suppressedEvents;
+
+} fm_linkDampingStatus;
+
+
 
 /**************************************************/
 /** \ingroup typeEnum
@@ -5037,6 +5127,55 @@ enum _fm_portAttr
      *  \chips  FM10000 */
     FM_PORT_AUTODETECT_MODULE,
 
+    /** Type fm_uint32: The half-life, in milliseconds, of the link-flap
+     *  damping penalty. Each link down transition adds
+     *  ''FM_PORT_LINK_DAMPING_PENALTY'' to the port's penalty, which then
+     *  decays exponentially with this half-life. When the penalty reaches
+     *  ''FM_PORT_LINK_DAMPING_SUPPRESS'' the port is suppressed: further
+     *  link up/down events are not reported and the port holds its last
+     *  reported link state. Once the penalty decays below
+     *  ''FM_PORT_LINK_DAMPING_REUSE'' the suppression is lifted and the
+     *  current link state is reported if it differs from the held one.
+     *                                                                  \lb\lb
+     *  A value of 0 (default) disables link-flap damping and releases any
+     *  port currently suppressed.
+     *
+     *  \portType ETH
+     *  \chips  FM10000 */
+    FM_PORT_LINK_DAMPING_HALF_LIFE,
+
+    /** Type fm_uint32: The penalty added by each link down transition
+     *  when link-flap damping is enabled (see
+     *  ''FM_PORT_LINK_DAMPING_HALF_LIFE''). Default is 1000.
+     *
+     *  \portType ETH
+     *  \chips  FM10000 */
+    FM_PORT_LINK_DAMPING_PENALTY,
+
+    /** Type fm_uint32: The penalty at or above which link up/down events
+     *  are suppressed (see ''FM_PORT_LINK_DAMPING_HALF_LIFE''). Must be
+     *  greater than ''FM_PORT_LINK_DAMPING_REUSE''. Default is 2000.
+     *
+     *  \portType ETH
+     *  \chips  FM10000 */
+    FM_PORT_LINK_DAMPING_SUPPRESS,
+
+    /** Type fm_uint32: The penalty below which a suppressed port is
+     *  released (see ''FM_PORT_LINK_DAMPING_HALF_LIFE''). Must be lower
+     *  than ''FM_PORT_LINK_DAMPING_SUPPRESS''. Default is 750.
+     *
+     *  \portType ETH
+     *  \chips  FM10000 */
+    FM_PORT_LINK_DAMPING_REUSE,
+
+    /** Type ''fm_linkDampingStatus'': The link-flap damping state and
+     *  counters of the port. The counters are cleared by setting
+     *  ''FM_PORT_LINK_DAMPING_HALF_LIFE''.
+     *
+     *  \portType ETH:ro
+     *  \chips  FM10000 */
+    FM_PORT_LINK_DAMPING_STATUS,
+
     /** UNPUBLISHED: For internal use only. */
     FM_PORT_ATTRIBUTE_MAX
 
@@ -8918,6 +9057,51 @@ typedef struct _fm_nvmMac
 } fm_nvmMac;
 
 
+/**************************************************/
+/** \ingroup constSystem
+ *  The maximum length of a boot phase name, including
+ *  the terminating NUL, in the ''fm_bootPhase'' type.
+ **************************************************/
+#define FM_BOOT_PHASE_NAME_LENGTH   32
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ *  Used as the argument type for the
+ *  ''FM_SWITCH_BOOT_PHASE'' switch attribute.
+ **************************************************/
+typedef struct _fm_bootPhase
+{
+    /** The index of the phase to retrieve. */
+    fm_int     index;
+
+    /** The name of the phase. This field is read-only. */
+    fm_char    name[FM_BOOT_PHASE_NAME_LENGTH];
+
+    /** The port or other instance the phase applies to, or -1 if the
+     *  phase is not specific to one. This field is read-only. */
+    fm_int     instance;
+
+    /** The nesting depth of the phase, 0 for a phase that is not
+     *  contained in another one. This field is read-only. */
+    fm_int     depth;
+
+    /** The time at which the phase started, in microseconds since the
+     *  bring-up started. This field is read-only. */
+    fm_uint64  startTime;
+
+    /** The duration of the phase in microseconds, or 0 if the phase did
+     *  not complete. This field is read-only. */
+    fm_uint64  duration;
+
+    /** The number of bytes by which the shared memory footprint grew
+     *  during the phase, including the phases nested in it, or 0 if the
+     *  phase did not complete. This field is read-only. */
+    fm_uint64  memory;
+
+} fm_bootPhase;
+
+
 /****************************************************************/
 /** \ingroup constSystem 
  *  The maximum number of reserved MAC addresses that may be
@@ -100,6 +100,18 @@ typedef struct _fm_buffer
      *  member. Node in the buffer queue in which this buffer is present.*/
     fm_dlist_node   *bufferQueueNode;
 
+    /** Private data used by the API. The application should not touch this
+     *  member. Number of owners of the chain headed by this buffer, see
+     *  ''fmRetainBufferChain''. Only meaningful in the first buffer of a
+     *  chain. */
+    fm_int          refCount;
+
+    /** Private data used by the API. The application should not touch this
+     *  member. Cycle count (see ''fmGetCycles'') when the platform handed
+     *  the frame to the API, used by ''fmDbgPacketRxLatencyStart''. Only
+     *  meaningful in the first buffer of a received chain. */
+    fm_uint64       rxCycles;
+
 } fm_buffer;
 
 
@@ -144,4 +156,21 @@ fm_status fmAddBufferChainInQueue(int sw,
  * else allocates from common pool. */
 fm_buffer *fmAllocateBufferV2(int sw, fm_bufferType bufferType);
 
+/* Allocate or free a number of buffers with a single pool access */
+fm_status fmAllocateBufferBulk(int            sw,
+                               fm_bufferType  bufferType,
+                               fm_int         numBuffers,
+                               fm_buffer    **bufs);
+fm_status fmFreeBufferBulk(int sw, fm_int numBuffers, fm_buffer **bufs);
+
+/* Link an array of buffers into a chain */
+fm_status fmLinkBufferChain(fm_int numBuffers, fm_buffer **bufs);
+
+/* Share a chain between several owners, freed when the last one releases it */
+fm_status fmRetainBufferChain(fm_buffer *bufChain, fm_int count);
+fm_status fmReleaseBufferChain(int sw, fm_buffer *bufChain);
+
+/* Allocate a chain of buffers holding numBytes of frame data */
+fm_buffer *fmAllocateBufferChain(int sw, fm_bufferType bufferType, fm_int numBytes);
+
 #endif /* __FM_FM_API_BUFFER_H */
@@ -67,6 +67,7 @@ fm_status fmEventHandlingInitialize(void);
 /* prototypes for the generic event tasks */
 void *fmDebounceLinkStateTask(void *args);
 void *fmInterruptHandler(void *args);
+void *fmSwitchInterruptHandler(void *args);
 fm_status fmSendSoftwareEvent(fm_int sw, fm_uint32 events);
 
 
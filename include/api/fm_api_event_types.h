@@ -339,6 +339,14 @@ typedef struct _fm_interrupt
  */
 #define FM_EVENT_CABLE_MISMATCH             (1 << 21)
 
+/** Reported by the flow aging engine when flows of a table with a non-zero
+ *  ''FM_FLOW_TABLE_AGING_TIMEOUT'' have been idle for the timeout.
+ *  The associated event structure is ''fm_eventFlowAged''.
+ *  
+ * \chips FM10000
+ */
+#define FM_EVENT_FLOW_AGED                  (1 << 22)
+
 /** @} (end of Doxygen group) */
 
 
@@ -418,6 +426,15 @@ enum _fm_tblUpdateEvent
      *  \chips  FM6000 */
     FM_EVENT_ENTRY_MEMORY_ERROR,
 
+    /** New source addresses are being dropped by the learning rate
+     *  limiter. Reported once when throttling begins; the port member
+     *  of the update holds the logical port that exceeded its limit,
+     *  or -1 if the switch-wide limit was exceeded. See the
+     *  ''api.FM10000.ma.learningRateLimit'' and
+     *  ''api.FM10000.ma.portLearningRateLimit'' API properties.
+     *  \chips  FM10000 */
+    FM_EVENT_ENTRY_LEARN_THROTTLED,
+
     /** UNPUBLISHED: For internal use only. */
     FM_EVENT_ENTRY_MAX
 
@@ -789,6 +806,35 @@ typedef struct _fm_eventCableMismatch
 } fm_eventCableMismatch;
 
 
+/** The maximum number of flows reported by a single ''FM_EVENT_FLOW_AGED''
+ *  event.
+ *  \ingroup constSystem */
+#define FM_FLOW_AGED_EVENT_BURST  16
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ * Structure used to report an ''FM_EVENT_FLOW_AGED''
+ * event.
+ **************************************************/
+typedef struct _fm_eventFlowAged
+{
+    /** The flow table to which the idle flows belong. */
+    fm_int  tableIndex;
+
+    /** The number of flow IDs in flowIds. */
+    fm_int  numFlows;
+
+    /** The IDs of the idle flows. */
+    fm_int  flowIds[FM_FLOW_AGED_EVENT_BURST];
+
+    /** TRUE if the flows have been deleted by the aging engine
+     *  (see ''FM_FLOW_TABLE_AGING_AUTO_DELETE''). */
+    fm_bool deleted;
+
+} fm_eventFlowAged;
+
+
 /**************************************************/
 /* Internal event type identifier.
  **************************************************/
@@ -812,6 +858,7 @@ typedef enum
     FM_EVID_ARP,
     FM_EVID_PLATFORM,
     FM_EVID_CABLE_MISMATCH,
+    FM_EVID_FLOW_AGED,
 
     /* Add new types above this line */
     FM_EVID_OUT_OF_EVENTS,
@@ -916,13 +963,13 @@ typedef enum
     /** A software correctable parity error was detected. The API will have
      *  attempted to correct the error. No further action is required.
      *  
-     *  \chips  FM3000, FM4000, FM6000 */
+     *  \chips  FM3000, FM4000, FM6000, FM10000 */
     FM_PARITY_SEVERITY_USER_FIXABLE,
 
     /** A parity error occurred on a single packet. The error is not
      *  persistent, has no consequence and no further action is required.
      *  
-     *  \chips  FM3000, FM4000, FM6000 */
+     *  \chips  FM3000, FM4000, FM6000, FM10000 */
     FM_PARITY_SEVERITY_TRANSIENT,
 
     /** A cumulative parity error occurred, causing some memory to be lost,
@@ -1156,8 +1203,10 @@ typedef struct _fm_eventParityError
 
     /** The number of invalid entries in the register table.
      *  Used when errType is ''FM_PARITY_ERRTYPE_CACHE_MISMATCH''.
+     *  On FM10000, the number of errors reported against the memory,
+     *  including errors that were coalesced into this event.
      *  
-     *  \chips  FM6000 */
+     *  \chips  FM6000, FM10000 */
     fm_int              numErrors;
 
     /** The SRAM number in which the error was detected.
@@ -1307,6 +1356,11 @@ typedef union _fm_eventPayload
      *  \chips  FM10000 */
     fm_eventCableMismatch    cableMismatchEvent;
 
+    /** Idle flows reported by the flow aging engine.
+     *  
+     *  \chips  FM10000 */
+    fm_eventFlowAged         flowAgedEvent;
+
 } fm_eventPayload;
 
 
@@ -1356,6 +1410,10 @@ struct _fm_event
     /** Records when the event was popped from the queue. */
     fm_timestamp     poppedTimestamp;
 
+    /** Cycle count (see ''fmGetCycles'') when the event was posted to an
+     *  event queue, used for the queue latency statistics. */
+    fm_uint64        postedCycles;
+
     /** Priority of the event. */
     fm_eventPriority priority;
 
@@ -1365,6 +1423,9 @@ struct _fm_event
     /** Node in the event queue containing this event. */
     fm_dlist_node    *node;
 
+    /** Position of this event in a ring event queue. */
+    fm_uint64        queuePos;
+
     /** Union of event information payloads for different event types. */
     fm_eventPayload  info;
 
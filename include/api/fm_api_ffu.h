@@ -1934,6 +1934,46 @@ typedef enum
 } fm_ffuOwnerType;
 
 
+/** Number of rows described by an ''fm_ffuSliceMap''. */
+#define FM_FFU_SLICE_MAP_ROWS                    1024
+
+/*****************************************************************************/
+/** \ingroup typeStruct
+ * This structure describes the occupancy of one FFU TCAM slice. It is
+ * returned by ''fmGetFFUSliceMap''. A row is used when the slice owner has
+ * a rule placed in it, whether or not that rule is currently enabled.
+ *****************************************************************************/
+typedef struct _fm_ffuSliceMap
+{
+    /** Owner of the slice. */
+    fm_ffuOwnerType owner;
+
+    /** One bit per row, set when the row is used. Row N is bit (N % 64) of
+     *  word (N / 64). */
+    fm_uint64       usedRows[FM_FFU_SLICE_MAP_ROWS / 64];
+
+    /** Number of used rows. */
+    fm_int          usedRules;
+
+    /** Number of free rows. */
+    fm_int          freeRules;
+
+    /** Number of runs of contiguous free rows. */
+    fm_int          freeRuns;
+
+    /** Number of free runs with used rows on both sides. These are the
+     *  runs that ''fmDefragmentFFU'' reclaims. */
+    fm_int          holes;
+
+    /** Number of free rows held in holes. */
+    fm_int          holeRules;
+
+    /** Size of the largest run of contiguous free rows. */
+    fm_int          largestFreeBlock;
+
+} fm_ffuSliceMap;
+
+
 /**************************************************/
 /** \ingroup intTypeEnum
  * These enumerated values indicate the type of
@@ -2550,6 +2590,13 @@ typedef enum
 
 } fm_ffuColorSource;
 
+/* FFU occupancy functions */
+fm_status fmGetFFUSliceMap(fm_int sw, fm_int slice, fm_ffuSliceMap *sliceMap);
+fm_status fmDefragmentFFU(fm_int          sw,
+                          fm_ffuOwnerType owner,
+                          fm_int          budget,
+                          fm_int *        numMoved);
+
 #ifdef FM_SUPPORT_FM4000
 
 /* ownership functions */
@@ -679,6 +679,33 @@ enum _fm_flowGroupAttr
      *  \chips FM10000 */
     FM_FLOW_TABLE_EMPTY_ENTRIES,
 
+    /** Type fm_uint32: Idle timeout of the flow aging engine in
+     *  milliseconds. When non-zero, the API periodically checks the
+     *  counters of the flows in the table and reports the flows whose
+     *  counters have not changed for at least this long with an
+     *  ''FM_EVENT_FLOW_AGED'' event. Only flows with the
+     *  ''FM_FLOW_ACTION_COUNT'' action are aged. A flow that stays idle is
+     *  reported again after each further timeout. The default value is
+     *  0, which disables aging. This attribute may be set before or after
+     *  the table is created.
+     *
+     *  \chips FM10000 */
+    FM_FLOW_TABLE_AGING_TIMEOUT,
+
+    /** Type fm_bool: Specifies whether the flow aging engine deletes the
+     *  idle flows it reports: FM_ENABLED or FM_DISABLED (default).
+     *
+     *  \chips FM10000 */
+    FM_FLOW_TABLE_AGING_AUTO_DELETE,
+
+    /** Type fm_uint32: Maximum time in microseconds the flow aging engine
+     *  spends scanning the table on each of its periodic ticks. A scan
+     *  that does not complete within this budget resumes where it left
+     *  off on the next tick. The default value is 1000.
+     *
+     *  \chips FM10000 */
+    FM_FLOW_TABLE_AGING_SCAN_BUDGET,
+
    /** UNPUBLISHED: For internal use only. */
     FM_FLOW_ATTR_MAX
 };
@@ -1434,6 +1461,42 @@ typedef fm_uint64       fm_flowCondition;
 typedef fm_uint64       fm_flowAction;
 
 
+/**************************************************/
+/** \ingroup typeStruct
+ *  A flow to add, used as an argument to
+ *  ''fmAddFlowList''. The fields are those taken by
+ *  ''fmAddFlow''.
+ **************************************************/
+typedef struct _fm_flowListEntry
+{
+    /** Priority of the flow within the table. */
+    fm_uint16        priority;
+
+    /** Inter-table flow precedence. */
+    fm_uint32        precedence;
+
+    /** Bit mask of matching conditions, see ''Flow Condition Masks''. */
+    fm_flowCondition condition;
+
+    /** Values and masks to match against for the condition. */
+    fm_flowValue     condVal;
+
+    /** Bit mask of actions, see ''Flow Action Masks''. */
+    fm_flowAction    action;
+
+    /** Values used by some actions. */
+    fm_flowParam     param;
+
+    /** Initial state of the flow. */
+    fm_flowState     flowState;
+
+    /** Returned handle identifying the flow entry, or -1 if the flow
+     *  could not be added. */
+    fm_int           flowId;
+
+} fm_flowListEntry;
+
+
 fm_status fmCreateFlowTCAMTable(fm_int           sw, 
                                 fm_int           tableIndex, 
                                 fm_flowCondition condition,
@@ -1472,6 +1535,12 @@ fm_status fmAddFlow(fm_int           sw,
                     fm_flowState     flowState,
                     fm_int          *flowId);
 
+fm_status fmAddFlowList(fm_int            sw,
+                        fm_int            tableIndex,
+                        fm_int            numFlows,
+                        fm_flowListEntry *flows,
+                        fm_status *       results);
+
 fm_status fmGetFlow(fm_int             sw, 
                     fm_int             tableIndex,
                     fm_int             flowId,
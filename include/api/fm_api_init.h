@@ -486,6 +486,88 @@ typedef struct _fm_schedulerConfig
  **************************************************/
 typedef void (*fm_eventHandler)(fm_int event, fm_int sw, void *ptr);
 
+
+/**************************************************/
+/** \ingroup typeScalar
+ * An event batch handler call-back function,
+ * provided by the application and called by the
+ * API to report several events at once. This function
+ * is registered with the API in the call to
+ * ''fmSetEventBatchHandler'' and takes as arguments:
+ *                                                                      \lb\lb
+ *  - fm_int numEvents - The number of events being
+ *  reported, at most ''FM_EVENT_BATCH_SIZE'',
+ *                                                                      \lb\lb
+ *  - fm_event **events - An array of numEvents pointers
+ *  to the ''fm_event'' structures of the events, in the
+ *  order in which they were reported.
+ *                                                                      \lb\lb
+ * As for an ''fm_eventHandler'', the call-back function
+ * is not responsible for disposing of the event structures,
+ * which must not be used after it returns, but is
+ * responsible for disposing of the ''fm_buffer'' chain of
+ * each received packet event.
+ **************************************************/
+typedef void (*fm_eventBatchHandler)(fm_int numEvents, fm_event **events);
+
+
+/** The number of VLAN IDs covered by an ''fm_eventFilter''.
+ *  \ingroup constSystem
+ */
+#define FM_EVENT_FILTER_MAX_VLAN    4096
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ * Refines, per event type, which of the events
+ * selected by ''fmSetProcessEventMask'' are delivered
+ * to the current process. Used as an argument to
+ * ''fmSetProcessEventFilter''. Use
+ * ''FM_EVENT_FILTER_SET_VLAN'' to fill in vlanMask.
+ **************************************************/
+typedef struct _fm_eventFilter
+{
+    /** Mask of the 'MA Table Update Events' delivered in
+     *  ''FM_EVENT_TABLE_UPDATE'' events, with bit (1 << updateEvent)
+     *  set for each update event to be delivered. */
+    fm_uint32 tableUpdateMask;
+
+    /** Bit mask of the VLAN IDs for which MA Table updates of
+     *  ''FM_EVENT_TABLE_UPDATE'' events, and ''FM_EVENT_PKT_RECV'' and
+     *  ''FM_EVENT_SFLOW_PKT_RECV'' events, are delivered. */
+    fm_uint32 vlanMask[FM_EVENT_FILTER_MAX_VLAN / 32];
+
+} fm_eventFilter;
+
+
+/** Selects a VLAN ID in an ''fm_eventFilter''.
+ *  \ingroup macroSystem
+ */
+#define FM_EVENT_FILTER_SET_VLAN(filter, vlan)                  \
+    ( (filter)->vlanMask[(vlan) / 32] |= (1U << ( (vlan) % 32 ) ) )
+
+
+/** Tests whether a VLAN ID is selected in an ''fm_eventFilter''.
+ *  \ingroup macroSystem
+ */
+#define FM_EVENT_FILTER_HAS_VLAN(filter, vlan)                  \
+    ( ( (vlan) >= 0 ) && ( (vlan) < FM_EVENT_FILTER_MAX_VLAN ) && \
+      ( (filter)->vlanMask[(vlan) / 32] & (1U << ( (vlan) % 32 ) ) ) )
+
+
+/** The largest number of packet queues the received packets of a process
+ *  can be spread over, see ''fmSetPacketQueueCount''.
+ *  \ingroup constSystem
+ */
+#define FM_MAX_PACKET_QUEUES        16
+
+
+/** The number of received packet events each packet queue holds.
+ *  \ingroup constSystem
+ */
+#define FM_PACKET_QUEUE_MAX_EVENTS  1024
+
+
 #define FM_PRE_INIT_FLAG_NO_RESET  1
 
 fm_status fmSetPreInitializationFlags(fm_int sw, fm_uint32 flags);
@@ -494,6 +576,9 @@ fm_status fmSetPreInitializationFlags(fm_int sw, fm_uint32 flags);
 /* main function which initializes the API and other components */
 fm_status fmInitialize(fm_eventHandler fPtr);
 
+/* attaches a monitoring process to a running API without initializing it */
+fm_status fmInitializeMonitor(void);
+
 /* terminates access to the API */
 fm_status fmTerminate(void);
 
@@ -513,6 +598,33 @@ fm_status fmSetEventHandler(fm_eventHandler fPtr);
 /* sets which events are delivered to the current process */
 fm_status fmSetProcessEventMask(fm_uint32 mask);
 
+/* sets the handler reporting events to the current process in batches */
+fm_status fmSetEventBatchHandler(fm_eventBatchHandler fPtr);
+
+/* refines which events are delivered to the current process */
+fm_status fmSetProcessEventFilter(const fm_eventFilter *filter);
+
+/* returns a file descriptor signalling events await fmGetEventBatch */
+fm_status fmGetEventNotifyFd(fm_int *fd);
+
+/* pulls the events delivered to the current process */
+fm_status fmGetEventBatch(fm_int maxEvents, fm_event **events, fm_int *numEvents);
+
+/* spreads the packets received by the current process over packet queues */
+fm_status fmSetPacketQueueCount(fm_int numQueues);
+
+/* returns a file descriptor signalling packets await fmGetPacketQueueBatch */
+fm_status fmGetPacketQueueNotifyFd(fm_int queue, fm_int *fd);
+
+/* pulls the received packet events of one packet queue */
+fm_status fmGetPacketQueueBatch(fm_int     queue,
+                                fm_int     maxEvents,
+                                fm_event **events,
+                                fm_int *   numEvents);
+
+/* returns the depth and drop count of one packet queue */
+fm_status fmGetPacketQueueDepth(fm_int queue, fm_int *depth, fm_uint64 *dropped);
+
 
 /* retrieves information about the state of a switch */
 fm_status fmGetSwitchInfo(fm_int sw, fm_switchInfo *info);
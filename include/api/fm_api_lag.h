@@ -83,6 +83,14 @@ fm_status fmCreateLAG(fm_int sw, fm_int *lagNumber);
 fm_status fmDeleteLAG(fm_int sw, fm_int lagNumber);
 fm_status fmAddLAGPort(fm_int sw, fm_int lagNumber, fm_int port);
 fm_status fmDeleteLAGPort(fm_int sw, fm_int lagNumber, fm_int port);
+fm_status fmAddLAGPortList(fm_int  sw,
+                           fm_int  lagNumber,
+                           fm_int  numPorts,
+                           fm_int *portList);
+fm_status fmDeleteLAGPortList(fm_int  sw,
+                              fm_int  lagNumber,
+                              fm_int  numPorts,
+                              fm_int *portList);
 
 fm_status fmGetLAGList(fm_int  sw,
                        fm_int* nLAG,
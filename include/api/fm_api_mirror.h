@@ -372,6 +372,12 @@ fm_status fmAddMirrorPortExt(fm_int        sw,
                              fm_int        port,
                              fm_mirrorType type);
 
+fm_status fmAddMirrorPortList(fm_int        sw,
+                              fm_int        group,
+                              fm_int        numPorts,
+                              fm_int *      portList,
+                              fm_mirrorType mirrorType);
+
 fm_status fmDeleteMirrorPort(fm_int sw, fm_int group, fm_int port);
 
 fm_status fmGetMirrorPortFirst(fm_int sw, fm_int group, fm_int *firstPort);
@@ -413,6 +419,13 @@ fm_status fmAddMirrorVlanExt(fm_int            sw,
                              fm_uint16         vlanID,
                              fm_mirrorVlanType direction);
 
+fm_status fmAddMirrorVlanList(fm_int            sw,
+                              fm_int            group,
+                              fm_vlanSelect     vlanSel,
+                              fm_int            numVlans,
+                              fm_uint16 *       vlanList,
+                              fm_mirrorVlanType direction);
+
 fm_status fmDeleteMirrorVlan(fm_int sw, fm_int group, fm_uint16 vlanID);
 
 fm_status fmDeleteMirrorVlanExt(fm_int        sw, 
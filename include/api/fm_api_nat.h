@@ -585,6 +585,31 @@ typedef struct _fm_natActionParam
 } fm_natActionParam;
 
 
+/*****************************************************************************/
+/** \ingroup typeStruct
+ * A NAT rule to add, used as an argument to ''fmAddNatRuleList''. The
+ * fields are those taken by ''fmAddNatRule''.
+ *****************************************************************************/
+typedef struct _fm_natRuleListEntry
+{
+    /** Rule ID. */
+    fm_int               rule;
+
+    /** Bit mask of matching conditions, see ''fm_natConditionMask''. */
+    fm_natCondition      condition;
+
+    /** Values to match against for the condition. */
+    fm_natConditionParam cndParam;
+
+    /** Bit mask of actions, see ''fm_natActionMask''. */
+    fm_natAction         action;
+
+    /** Values used by some actions. */
+    fm_natActionParam    actParam;
+
+} fm_natRuleListEntry;
+
+
 
 
 /*****************************************************************************
@@ -626,6 +651,16 @@ fm_status fmAddNatRule(fm_int                sw,
                        fm_natAction          action,
                        fm_natActionParam *   actParam);
 fm_status fmDeleteNatRule(fm_int sw, fm_int table, fm_int rule);
+fm_status fmAddNatRuleList(fm_int               sw,
+                           fm_int               table,
+                           fm_int               numRules,
+                           fm_natRuleListEntry *rules,
+                           fm_status *          results);
+fm_status fmDeleteNatRuleList(fm_int     sw,
+                              fm_int     table,
+                              fm_int     numRules,
+                              fm_int *   rules,
+                              fm_status *results);
 fm_status fmGetNatRule(fm_int                sw,
                        fm_int                table,
                        fm_int                rule,
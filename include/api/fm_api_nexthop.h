@@ -517,6 +517,17 @@ typedef struct _fm_ecmpGroupInfo
      *  \chips  FM6000 */
     fm_bool isMpls;
 
+    /** Whether the ECMP group is a resilient ECMP group. A resilient
+     *  group is a fixed-size group whose numFixedEntries next-hop entries
+     *  are hash buckets shared among a set of members. Members are
+     *  added and removed with ''fmAddResilientECMPGroupMembers'' and
+     *  ''fmDeleteResilientECMPGroupMembers''; only the buckets that change
+     *  owner are rewritten, so flows hashed to the other members are
+     *  not disturbed. numFixedEntries must be greater than zero.
+     *
+     *  \chips  FM10000 */
+    fm_bool isResilient;
+
 } fm_ecmpGroupInfo;
 
 
@@ -635,6 +646,14 @@ fm_status fmSetECMPGroupNextHops(fm_int          sw,
                                  fm_int          firstIndex,
                                  fm_int          numNextHops,
                                  fm_ecmpNextHop *nextHopList);
+fm_status fmAddResilientECMPGroupMembers(fm_int          sw,
+                                         fm_int          groupId,
+                                         fm_int          numMembers,
+                                         fm_ecmpNextHop *memberList);
+fm_status fmDeleteResilientECMPGroupMembers(fm_int          sw,
+                                            fm_int          groupId,
+                                            fm_int          numMembers,
+                                            fm_ecmpNextHop *memberList);
 fm_status fmGetECMPGroupFirst(fm_int sw, fm_int *firstGroupId);
 fm_status fmGetECMPGroupNext(fm_int  sw,
                              fm_int  prevGroupId,
@@ -683,6 +702,10 @@ fm_status fmDeleteARPEntry(fm_int       sw,
                            fm_arpEntry *arp);
 fm_status fmUpdateARPEntryDMAC(fm_int       sw,
                                fm_arpEntry *arp);
+fm_status fmUpdateARPEntryDMACList(fm_int       sw,
+                                   fm_int       numEntries,
+                                   fm_arpEntry *arpList,
+                                   fm_status *  results);
 fm_status fmUpdateARPEntryVrid(fm_int       sw,
                                fm_arpEntry *arp,
                                fm_int       vrid);
@@ -191,9 +191,167 @@ typedef struct _fm_packetInfoV2
      *  \chips  FM6000  */
     fm_uint32   fcsValue;
 
+    /** Opaque value reported to the switch's ''fm_txCompletionHandler''
+     *  once the packet has left the TX packet queue. No completion is
+     *  reported if NULL.
+     *  \chips  FM10000  */
+    void *      txCookie;
+
+    /** If TRUE, the send returns FM_ERR_LOCK_TIMEOUT rather than waiting
+     *  while another thread is adding to the TX packet queue. Together
+     *  with ''fmGetTxQueueSpace'', this lets a sender pace itself instead
+     *  of blocking.
+     *  \chips  FM10000  */
+    fm_bool     noWait;
+
 } fm_packetInfoV2;
 
 
+/**************************************************/
+/** \ingroup typeStruct
+ * Reports the outcome of one packet sent with a
+ * non-NULL txCookie, see ''fm_txCompletionHandler''.
+ **************************************************/
+typedef struct _fm_txCompletion
+{
+    /** The txCookie of the ''fm_packetInfoV2'' the packet was sent
+     *  with. */
+    void *      cookie;
+
+    /** FM_OK if the packet was handed to the host interface, otherwise
+     *  the reason it was dropped. */
+    fm_status   status;
+
+} fm_txCompletion;
+
+
+/** Maximum number of completions reported by a single call to a
+ *  ''fm_txCompletionHandler''. */
+#define FM_TX_COMPLETION_BATCH_SIZE         64
+
+
+/**************************************************/
+/** \ingroup typeScalar
+ * TX completion handler, registered with
+ * ''fmSetTxCompletionHandler''. Called from the
+ * packet transmit thread after each pass over a TX
+ * packet queue, with the completions of the packets
+ * retired in that pass, in queue order. A packet
+ * sent to several ports completes once, after its
+ * last copy has left the queue. The packet buffers
+ * have already been released by the API.
+ *                                              \lb\lb
+ * The handler may send packets, but must not block.
+ **************************************************/
+typedef void (*fm_txCompletionHandler)(fm_int           sw,
+                                       fm_int           numCompletions,
+                                       fm_txCompletion *completions,
+                                       void *           handlerCookie);
+
+
+/** Number of receive packet filters of a switch, see
+ *  ''fmSetRxPacketFilter''. */
+#define FM_MAX_RX_PACKET_FILTERS            32
+
+/** Number of TX destination handles of a switch, see
+ *  ''fmCreateTxDestination''. */
+#define FM_MAX_TX_DESTINATIONS              64
+
+/****************************************************************************/
+/** Rx Packet Filter Match Fields
+ *  \ingroup constRxPacketFilterMatch
+ *  \page RxPacketFilterMatch
+ *
+ *  The following bit masks may be ORed together to produce the matchFields
+ *  of an ''fm_rxPacketFilter''. A received frame matches a filter when it
+ *  matches every selected field.
+ ****************************************************************************/
+
+/** \ingroup constRxPacketFilterMatch
+ * @{ */
+
+/** Match the EtherType following any 802.1Q tag. */
+#define FM_RX_FILTER_MATCH_ETHERTYPE        (1U << 0)
+
+/** Match the destination MAC address under dmacMask. */
+#define FM_RX_FILTER_MATCH_DMAC             (1U << 1)
+
+/** Match the source MAC address under smacMask. */
+#define FM_RX_FILTER_MATCH_SMAC             (1U << 2)
+
+/** Match the VLAN the frame was received on. */
+#define FM_RX_FILTER_MATCH_VLAN             (1U << 3)
+
+/** Match the trap code of a trapped frame. */
+#define FM_RX_FILTER_MATCH_TRAP_CODE        (1U << 4)
+
+/** Match the logical port the frame was received on. */
+#define FM_RX_FILTER_MATCH_SRC_PORT         (1U << 5)
+
+/** @} (end of Doxygen group) */
+
+
+/**************************************************/
+/** \ingroup typeEnum 
+ * Action taken on a received frame that matches
+ * an ''fm_rxPacketFilter''.
+ **************************************************/
+typedef enum
+{
+    /** Drop the frame before an event is allocated for it. */
+    FM_RX_FILTER_ACTION_DROP = 0,
+
+    /** Deliver the frame to the application, without evaluating the
+     *  filters that follow. Used to exempt frames from a broader drop
+     *  filter with a higher number. */
+    FM_RX_FILTER_ACTION_DELIVER
+
+} fm_rxPacketFilterAction;
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ * A receive packet filter, used as an argument to
+ * ''fmSetRxPacketFilter''. Filters are evaluated
+ * in increasing number and the first match decides
+ * what happens to the frame. Frames matching no
+ * filter are delivered.
+ **************************************************/
+typedef struct _fm_rxPacketFilter
+{
+    /** Fields to match, see ''Rx Packet Filter Match Fields''. */
+    fm_uint32               matchFields;
+
+    /** The EtherType to match. */
+    fm_uint16               etherType;
+
+    /** The VLAN to match. */
+    fm_uint16               vlan;
+
+    /** The destination MAC address to match. */
+    fm_macaddr              dmac;
+
+    /** Bits of the destination MAC address to compare. */
+    fm_macaddr              dmacMask;
+
+    /** The source MAC address to match. */
+    fm_macaddr              smac;
+
+    /** Bits of the source MAC address to compare. */
+    fm_macaddr              smacMask;
+
+    /** The trap code to match (see ''FM_SWITCH_TRAP_CODE''). */
+    fm_int                  trapCode;
+
+    /** The logical port to match. */
+    fm_int                  srcPort;
+
+    /** Action taken on matching frames. */
+    fm_rxPacketFilterAction action;
+
+} fm_rxPacketFilter;
+
+
 
 /****************************************************************************/
 /** Rx Packet Driver Destination Masks
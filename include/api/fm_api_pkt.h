@@ -55,4 +55,30 @@ fm_status fmSendPacketISL(fm_int          sw,
                           fm_islTagFormat islTagFormat,
                           fm_buffer *     pkt);
 
+fm_status fmCreateTxDestination(fm_int  sw,
+                                fm_int *portList,
+                                fm_int  numPorts,
+                                fm_int *destHandle);
+fm_status fmDeleteTxDestination(fm_int sw, fm_int destHandle);
+fm_status fmSendPacketTxDestination(fm_int           sw,
+                                    fm_int           destHandle,
+                                    fm_buffer *      pkt,
+                                    fm_packetInfoV2 *info);
+
+fm_status fmSetTxCompletionHandler(fm_int                 sw,
+                                   fm_txCompletionHandler handler,
+                                   void *                 handlerCookie);
+fm_status fmGetTxQueueSpace(fm_int    sw,
+                            fm_uint32 switchPriority,
+                            fm_int *  space);
+
+fm_status fmSetRxPacketFilter(fm_int              sw,
+                              fm_int              filterId,
+                              fm_rxPacketFilter * filter);
+fm_status fmDeleteRxPacketFilter(fm_int sw, fm_int filterId);
+fm_status fmGetRxPacketFilterHits(fm_int      sw,
+                                  fm_int      filterId,
+                                  fm_uint64 * hits);
+fm_status fmResetRxPacketFilterHits(fm_int sw, fm_int filterId);
+
 #endif /* __FM_FM_API_PKT_H */
@@ -775,6 +775,15 @@ fm_status fmGetPortAttributeV2(fm_int sw,
                                fm_int lane,
                                fm_int attr,
                                void * value);
+fm_status fmSetPortAttributeList(fm_int  sw,
+                                 fm_int  numEntries,
+                                 fm_int *portList,
+                                 fm_int *attrList,
+                                 void ** valueList);
+fm_status fmGetPortAttributeSnapshot(fm_int sw,
+                                     fm_int port,
+                                     fm_int attr,
+                                     void * value);
 fm_status fmSetPortSecurity(fm_int  sw,
                             fm_int  port,
                             fm_bool enable,
@@ -142,6 +142,13 @@ fm_status fmSetPortQOS(fm_int sw,
                        fm_int attr,
                        fm_int index,
                        void * value);
+fm_status fmSetPortQOSList(fm_int  sw,
+                           fm_int  numPorts,
+                           fm_int *portList,
+                           fm_int  numAttrs,
+                           fm_int *attrList,
+                           fm_int *indexList,
+                           void ** valueList);
 fm_status fmGetPortQOS(fm_int sw,
                        fm_int port,
                        fm_int attr,
@@ -162,4 +162,10 @@ fm_status fmI2cWriteRead(fm_int     sw,
                          fm_uint    wl,
                          fm_uint    rl);
 
+/* Queue the register writes of the calling thread until the batch is
+ * committed */
+fm_status fmRegBatchBegin(fm_int sw);
+fm_status fmRegBatchCommit(fm_int sw);
+fm_status fmRegBatchAbort(fm_int sw);
+
 #endif /* __FM_FM_API_REGS_H */
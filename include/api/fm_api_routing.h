@@ -846,6 +846,36 @@ typedef struct _fm_routeEntry
 } fm_routeEntry;
 
 
+/****************************************************************************/
+/** \ingroup typeStruct
+ *
+ * Position of a paged walk of the route table. Initialized by
+ * ''fmGetRouteTableFirst'' and advanced by ''fmGetRouteTableNext''.
+ ****************************************************************************/
+
+typedef struct _fm_routeCursor
+{
+    /** Position in the route table. For internal use only. */
+    fm_customTreeIterator iter;
+
+    /** Route table generation for which iter is valid. For internal use
+     *  only. */
+    fm_uint               generation;
+
+    /** Last route returned, after which the walk resumes if the route
+     *  table changed between pages. For internal use only. */
+    fm_routeEntry         lastRoute;
+
+    /** TRUE once lastRoute is valid. For internal use only. */
+    fm_bool               started;
+
+    /** Set to TRUE if routes were added or deleted while the walk was in
+     *  progress. Routes added behind the cursor are not reported. */
+    fm_bool               tableChanged;
+
+} fm_routeCursor;
+
+
 /****************************************************************************
  * Used to specify an IPv6 stateless autoconfig ARP entry. This could be used
  * as the macAddr field of the ''fm_arpEntry'' structure.
@@ -901,6 +931,16 @@ fm_status fmAddRouteExt(fm_int          sw,
                         fm_routeAction *action);
 fm_status fmDeleteRoute(fm_int         sw,
                         fm_routeEntry *route);
+fm_status fmAddRouteList(fm_int          sw,
+                         fm_int          numRoutes,
+                         fm_routeEntry * routes,
+                         fm_routeState * states,
+                         fm_routeAction *actions,
+                         fm_status *     results);
+fm_status fmDeleteRouteList(fm_int         sw,
+                            fm_int         numRoutes,
+                            fm_routeEntry *routes,
+                            fm_status *    results);
 fm_status fmReplaceRouteECMP(fm_int         sw,
                              fm_routeEntry *oldRoute,
                              fm_routeEntry *newRoute);
@@ -926,6 +966,16 @@ fm_status fmGetRouteFirst(fm_int         sw,
 fm_status fmGetRouteNext(fm_int         sw,
                          fm_voidptr *   searchToken,
                          fm_routeEntry *nextRoute);
+fm_status fmGetRouteTableFirst(fm_int          sw,
+                               fm_routeCursor *cursor,
+                               fm_int *        numRoutes,
+                               fm_routeEntry * routes,
+                               fm_int          maxRoutes);
+fm_status fmGetRouteTableNext(fm_int          sw,
+                              fm_routeCursor *cursor,
+                              fm_int *        numRoutes,
+                              fm_routeEntry * routes,
+                              fm_int          maxRoutes);
 
 fm_bool fmIsRouteEntryUnicast(fm_routeEntry *route);
 fm_bool fmIsRouteEntryMulticast(fm_routeEntry *route);
@@ -951,6 +1001,7 @@ void fmDbgTestRouteMask(fm_char *               route,
 void fmGetRouteDestAddress(fm_routeEntry *route, fm_ipAddr *destAddr);
 void fmGetRouteMcastSourceAddress(fm_routeEntry *route, fm_ipAddr *srcAddr);
 fm_status fmDbgGetRouteCount(fm_int sw, fm_int *countPtr);
+fm_status fmDbgDumpRouteMemory(fm_int sw);
 fm_status fmSetRouteAttribute(fm_int         sw,
                               fm_routeEntry *route,
                               fm_int         attr,
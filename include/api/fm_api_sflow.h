@@ -38,6 +38,10 @@
 #define FM_SFLOW_NO_TRUNC          -1
 #define FM_SFLOW_PRIORITY_ORIGINAL  FM_MIRROR_PRIORITY_ORIGINAL
 
+/** Largest number of bytes of a sampled frame carried by an
+ *  ''fm_sFlowSample''. */
+#define FM_SFLOW_SAMPLE_HEADER_SIZE 128
+
 
 /****************************************************************************/
 /** \ingroup typeEnum
@@ -105,8 +109,12 @@ enum _fm_sFlowAttr
      *                                                                  \lb\lb
      *  For FM6000 devices, any value other than FM_SFLOW_NO_TRUNC 
      *  will enable truncation to a fixed length of 160 bytes.
+     *                                                                  \lb\lb
+     *  For FM10000 devices, the value only applies to the samples placed
+     *  on the sFlow sample ring (see ''fmReadSFlowSamples''), which never
+     *  carry more than ''FM_SFLOW_SAMPLE_HEADER_SIZE'' bytes.
      *
-     *  \chips  FM3000, FM4000, FM6000 */
+     *  \chips  FM3000, FM4000, FM6000, FM10000 */
     FM_SFLOW_TRUNC_LENGTH,
     
     /** Type fm_int: A read-only attribute used to get an identifier for a
@@ -138,12 +146,58 @@ enum _fm_sFlowAttr
      *  \chips FM6000 */
     FM_SFLOW_PRIORITY,
 
+    /** Type fm_uint: Largest number of samples per second this sFlow
+     *  should deliver to the CPU. While nonzero, the sampling rate in
+     *  effect is raised above ''FM_SFLOW_SAMPLE_RATE'' whenever the
+     *  samples arrive faster than this, and lowered back towards it
+     *  once they slow down. The rate in effect is reported in each
+     *  ''fm_sFlowSample''. The adjustment is made as samples are read
+     *  with ''fmReadSFlowSamples''. The default of 0 disables it.
+     *
+     *  \chips  FM10000 */
+    FM_SFLOW_MAX_CPU_RATE,
+
     /** UNPUBLISHED: For internal use only. */
     FM_SFLOW_ATTR_MAX
     
 };  /* end enum _fm_sFlowAttr */
 
 
+/****************************************************************************/
+/** \ingroup typeStruct
+ *
+ *  A frame sampled by an sFlow, as returned by ''fmReadSFlowSamples''.
+ ****************************************************************************/
+typedef struct _fm_sFlowSample
+{
+    /** The sFlow instance that sampled the frame. */
+    fm_int    sFlowId;
+
+    /** The logical port on which the frame was received. */
+    fm_int    srcPort;
+
+    /** The VLAN of the frame. */
+    fm_int    vlan;
+
+    /** The sampling rate in effect when the frame was sampled: one frame
+     *  in sampleRate was delivered. */
+    fm_uint   sampleRate;
+
+    /** Length of the sampled frame in bytes. */
+    fm_uint32 frameLength;
+
+    /** Number of bytes of the frame copied to header. */
+    fm_uint32 headerLength;
+
+    /** Time at which the sample was received, in microseconds. */
+    fm_uint64 timestamp;
+
+    /** The first headerLength bytes of the frame. */
+    fm_byte   header[FM_SFLOW_SAMPLE_HEADER_SIZE];
+
+} fm_sFlowSample;
+
+
 /*****************************************************************************
  * Public function prototypes.
  *****************************************************************************/
@@ -187,4 +241,10 @@ fm_status fmCheckSFlowLogging(fm_int            sw,
                               fm_eventPktRecv * pktEvent, 
                               fm_bool         * isPktSFlowLogged);
 
+fm_status fmReadSFlowSamples(fm_int           sw,
+                             fm_int           maxSamples,
+                             fm_sFlowSample * samples,
+                             fm_int *         numSamples,
+                             fm_uint64 *      dropped);
+
 #endif /* __FM_FM_API_SFLOW_H */
@@ -213,6 +213,11 @@ fm_status fmCreateStackMcastGroupExt(fm_int  sw,
                                      fm_int  logicalPort,
                                      fm_int *mcastGroup);
 
+fm_status fmCreateStackMcastGroupOnSwitches(fm_int        numSwitches,
+                                            const fm_int *swList,
+                                            fm_int        mcastGroup,
+                                            fm_status *   results);
+
 fm_status fmAllocateStackLAGs(fm_int     sw,
                               fm_uint    startGlort,
                               fm_uint    glortCount,
@@ -224,6 +229,11 @@ fm_status fmFreeStackLAGs(fm_int sw, fm_int baseLagNumber);
 
 fm_status fmCreateStackLAG(fm_int sw, fm_int lagNumber);
 
+fm_status fmCreateStackLAGOnSwitches(fm_int        numSwitches,
+                                     const fm_int *swList,
+                                     fm_int        lagNumber,
+                                     fm_status *   results);
+
 fm_status fmAllocateStackLBGs(fm_int     sw,
                               fm_uint    startGlort,
                               fm_uint    glortCount,
@@ -1695,14 +1695,140 @@ typedef struct _fm_switchCounters
 
 } fm_switchCounters;
 
+
+/** Version of the ''fm_telemetryRing'' and ''fm_telemetryRecord'' layout.
+ *  Incremented whenever the layout changes.
+ *  \ingroup constSystem */
+#define FM_TELEMETRY_VERSION                1
+
+
+/**************************************************/
+/** \ingroup typeEnum
+ *  Type of the counters carried by an ''fm_telemetryRecord''.
+ **************************************************/
+typedef enum
+{
+    /** The record carries the ''fm_portCounters'' of a logical port. */
+    FM_TELEMETRY_RECORD_PORT = 1,
+
+    /** The record carries the ''fm_vlanCounters'' of a VLAN. */
+    FM_TELEMETRY_RECORD_VLAN,
+
+} fm_telemetryRecordType;
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ *  A timestamped counter snapshot exported to the telemetry ring, see
+ *  ''fmReadTelemetryRecord''.
+ **************************************************/
+typedef struct _fm_telemetryRecord
+{
+    /** Layout version, ''FM_TELEMETRY_VERSION''. */
+    fm_uint16 version;
+
+    /** Record type, see ''fm_telemetryRecordType''. */
+    fm_uint16 type;
+
+    /** Number of valid bytes in data. */
+    fm_uint32 size;
+
+    /** Time at which the counters were read, in microseconds. */
+    fm_uint64 timestamp;
+
+    /** Switch the counters belong to. */
+    fm_int    sw;
+
+    /** Logical port or VLAN ID, according to type. */
+    fm_int    id;
+
+    /** The counters. */
+    union
+    {
+        fm_portCounters port;
+        fm_vlanCounters vlan;
+
+    } data;
+
+} fm_telemetryRecord;
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ *  One slot of the telemetry ring.
+ **************************************************/
+typedef struct _fm_telemetrySlot
+{
+    /** Position of the record in the ring plus 1, or 0 while the slot is
+     *  being written. */
+    fm_uint64          seq;
+
+    /** The record. */
+    fm_telemetryRecord record;
+
+} fm_telemetrySlot;
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ *  Telemetry ring of a switch. The ring lives in the SDK shared memory
+ *  and is only written by the SDK. Any process attached to the shared
+ *  memory may read it with ''fmReadTelemetryRecord'', without API calls
+ *  or locks.
+ **************************************************/
+typedef struct _fm_telemetryRing
+{
+    /** Layout version, ''FM_TELEMETRY_VERSION''. */
+    fm_uint32          version;
+
+    /** sizeof(''fm_telemetrySlot'') as built into the SDK. */
+    fm_uint32          slotSize;
+
+    /** Number of slots. */
+    fm_uint32          numSlots;
+
+    /** TRUE while counter snapshots are being exported. */
+    fm_uint32          active;
+
+    /** Number of records ever written. The next record goes in slot
+     *  (head % numSlots). */
+    fm_uint64          head;
+
+    /** The slots, which follow this header in the same allocation. */
+    fm_telemetrySlot * slots;
+
+} fm_telemetryRing;
+
+
 fm_status fmGetPortCounters(fm_int sw, fm_int port, fm_portCounters *cnt);
+fm_status fmGetPortCountersSnapshot(fm_int           sw,
+                                    fm_int           port,
+                                    fm_portCounters *cnt);
+fm_status fmGetAllPortCounters(fm_int           sw,
+                               fm_int *         portList,
+                               fm_int           numPorts,
+                               fm_portCounters *cnt);
 fm_status fmResetPortCounters(fm_int sw, fm_int port);
 fm_status fmGetVLANCounters(fm_int sw, fm_int vlan, fm_vlanCounters *cnt);
 fm_status fmResetVLANCounters(fm_int sw, fm_int vlan);
+fm_status fmGetVLANCountersRange(fm_int           sw,
+                                 fm_int           firstVlan,
+                                 fm_int           lastVlan,
+                                 fm_int           maxVlans,
+                                 fm_int *         vlanList,
+                                 fm_vlanCounters *cnt,
+                                 fm_int *         numVlans);
 fm_status fmAllocateVLANCounters(fm_int sw, fm_int vlan);
 fm_status fmFreeVLANCounters(fm_int sw, fm_int vlan);
+fm_status fmAllocateVLANCountersList(fm_int sw, fm_int numVlans, fm_int *vlanList);
+fm_status fmFreeVLANCountersList(fm_int sw, fm_int numVlans, fm_int *vlanList);
 fm_status fmGetSwitchCounters(fm_int sw, fm_switchCounters *cnt);
 fm_status fmResetSwitchCounters(fm_int sw);
+fm_status fmGetTelemetryRing(fm_int sw, fm_telemetryRing **ring);
+fm_status fmReadTelemetryRecord(fm_telemetryRing *  ring,
+                                fm_uint64 *         cursor,
+                                fm_telemetryRecord *record,
+                                fm_uint64 *         lost);
 
 
 #endif /* __FM_FM_API_STATS_H */
@@ -581,6 +581,8 @@ fm_status fmGetStormCtrlActionNext(fm_int          sw,
                                    fm_int          stormController,
                                    fm_stormAction *currentAction,
                                    fm_stormAction *nextAction);
+fm_status fmBeginStormCtrlUpdate(fm_int sw, fm_int stormController);
+fm_status fmCommitStormCtrlUpdate(fm_int sw, fm_int stormController);
 
 void fmDbgDumpStormCtrl(fm_int sw, fm_int stormController);
 
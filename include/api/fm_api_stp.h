@@ -75,6 +75,12 @@ fm_status fmGetSpanningTreePortState(fm_int  sw,
                                      fm_int  port,
                                      fm_int *stpState);
 
+fm_status fmSetSpanningTreePortStateList(fm_int  sw,
+                                         fm_int  numEntries,
+                                         fm_int *stpInstanceList,
+                                         fm_int *portList,
+                                         fm_int *stpStateList);
+
 fm_status fmGetSpanningTreeFirst(fm_int  sw,
                                  fm_int *firstStpInstance);
 
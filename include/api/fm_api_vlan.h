@@ -206,6 +206,20 @@ fm_status fmSetVlanPortListState(fm_int    sw,
                                  fm_int *  portList,
                                  fm_int    state);
 
+/* functions to update a list of ports in a range of VLANs */
+fm_status fmAddVlanRangePortList(fm_int    sw,
+                                 fm_uint16 firstVlanID,
+                                 fm_uint16 lastVlanID,
+                                 fm_int    numPorts,
+                                 fm_int *  portList,
+                                 fm_bool   tag);
+
+fm_status fmDeleteVlanRangePortList(fm_int    sw,
+                                    fm_uint16 firstVlanID,
+                                    fm_uint16 lastVlanID,
+                                    fm_int    numPorts,
+                                    fm_int *  portList);
+
 
 /* attribute setting for VLAN settings */
 fm_status fmGetVlanAttribute(fm_int    sw,
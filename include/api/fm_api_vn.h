@@ -651,6 +651,10 @@ fm_status fmGetVNVsiNext(fm_int    sw,
                          fm_int *  searchToken,
                          fm_int *  vsi);
 
+fm_status fmVNBatchBegin(fm_int sw);
+
+fm_status fmVNBatchCommit(fm_int sw);
+
 fm_status fmDbgDumpVN(fm_int sw);
 
 
@@ -151,6 +151,8 @@
 
 #define FM10000_FIRST_4BITS_ABSTRACT_KEY                73
 
+#define FM10000_ABSTRACT_KEY_WORDS                      ((FM10000_NUM_ABSTRACT + 63) / 64)
+
 #define FM10000_SPECIAL_PORT_PER_ACL_KEY                0xfffaafff
 
 #define FM10000_MAX_RULE_PER_ACL_PART                   1024
@@ -174,6 +176,9 @@
 
 #define FM10000_ACL_MAX_ACTIONS_PER_RULE                5
 
+/* Maximum number of threads taking part in an ACL compilation */
+#define FM10000_MAX_ACL_COMPILE_THREADS                 16
+
 #define FM10000_ACL_NUM_KEY_POS                         5
 #define FM10000_ACL_NUM_KEY_MASK                        0xffffffffLL
 #define FM10000_ACL_PART_KEY_POS                        0
@@ -228,6 +233,19 @@
                                       FM_ACL_MATCH_SCENARIO_FLAGS |            \
                                       FM_ACL_MATCH_SRC_PORT )
 
+/* Abstract keys needed by a rule or an ACL, indexed by abstract key */
+typedef struct _fm_fm10000AbstractKey
+{
+    /**  One bit per abstract key needed */
+    fm_uint64  used[FM10000_ABSTRACT_KEY_WORDS];
+
+    /**  Mask (bits 15:8) and value (bits 7:0) of each needed key, as
+     *   given by the first condition that needed it */
+    fm_uint16  data[FM10000_NUM_ABSTRACT];
+
+} fm_fm10000AbstractKey;
+
+
 typedef struct _fm_fm10000AclRule
 {
     /**  ACL ID */
@@ -488,6 +506,19 @@ typedef struct _fm_fm10000CompiledAcls
     /**  indicate if the compiled image is valid */
     fm_bool   valid;
 
+    /**  indicate if the compiled image was produced by incremental
+     *   compilation, in which case applying it only writes the changes
+     *   made since the last apply. */
+    fm_bool   incremental;
+
+    /**  Number of FFU rule writes, rule moves included, made on this image
+     *   by the non disruptive compilation. Counted whether or not the
+     *   changes are applied to the hardware. */
+    fm_uint   ndRuleWrites;
+
+    /**  Number of those writes that moved an existing rule. */
+    fm_uint   ndRuleMoves;
+
 } fm_fm10000CompiledAcls;
 
 
@@ -529,6 +560,12 @@ fm_status fm10000ResetACLCount(fm_int sw,
                                fm_int acl,
                                fm_int rule);
 
+fm_status fm10000GetACLCountList(fm_int            sw,
+                                 fm_int            maxEntries,
+                                 fm_aclCountEntry *entries,
+                                 fm_int *          numEntries,
+                                 fm_bool           clear);
+
 fm_status fm10000GetACLEgressCount(fm_int          sw,
                                    fm_int          logicalPort,
                                    fm_aclCounters *counters);
@@ -611,6 +648,8 @@ fm_status fm10000VerifyMappers(fm_int               sw,
 
 fm_status fm10000ApplyMappers(fm_int sw);
 
+void fm10000GetMapperStats(fm_int sw, fm_aclCompilerStats *stats);
+
 /* Function located in fm10000_api_acl_non_disrupt.c */
 fm_status fm10000NonDisruptCompile(fm_int                  sw,
                                    fm_fm10000CompiledAcls *cacls,
@@ -652,6 +691,12 @@ fm_status fm10000ValidateACLAttribute(fm_int sw, fm_int attr);
 fm_status fm10000GetAclFfuRuleUsage(fm_int  sw,
                                     fm_int *ffuRuleUsed,
                                     fm_int *ffuRuleAvailable);
+fm_status fm10000GetAclFFUSliceRows(fm_int     sw,
+                                    fm_int     slice,
+                                    fm_uint64 *usedRows);
+fm_status fm10000DefragmentAclFFU(fm_int  sw,
+                                  fm_int  budget,
+                                  fm_int *numMoved);
 fm_status fm10000ValidateAclLogicalPort(fm_int      sw,
                                         fm_int      logicalPort,
                                         fm_bool *   referenced);
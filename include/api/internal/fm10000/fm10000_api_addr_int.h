@@ -127,6 +127,10 @@ typedef enum
 
 fm_status fm10000AddAddress(fm_int sw, fm_macAddressEntry *entry);
 
+fm_status fm10000AddAddressList(fm_int               sw,
+                                fm_int               numEntries,
+                                fm_macAddressEntry * entries);
+
 fm_status fm10000AddMacTableEntry(fm_int               sw,
                                   fm_macAddressEntry * entry,
                                   fm_macSource         source,
@@ -134,6 +138,13 @@ fm_status fm10000AddMacTableEntry(fm_int               sw,
                                   fm_uint32 *          numUpdates,
                                   fm_event **          outEvent);
 
+fm_status fm10000AddMacTableEntryList(fm_int               sw,
+                                      fm_macAddressEntry * entries,
+                                      fm_int               numEntries,
+                                      fm_macSource         source,
+                                      fm_uint32 *          numUpdates,
+                                      fm_event **          outEvent);
+
 fm_status fm10000AssignTableEntry(fm_int              sw,
                                   fm_macAddressEntry *entry,
                                   fm_int              targetBank,
@@ -167,6 +178,10 @@ fm_status fm10000ConvertWordsToEntry(fm_int                      sw,
                                      fm_uint32 *              words);
 #endif
 
+fm_status fm10000DeleteAddressList(fm_int               sw,
+                                   fm_int               numEntries,
+                                   fm_macAddressEntry * entries);
+
 fm_status fm10000FillInUserEntryFromTable(fm_int                   sw,
                                           fm_internalMacAddrEntry *tblentry,
                                           fm_macAddressEntry *     entry);
@@ -182,10 +197,24 @@ fm_status fm10000GetAddressTable(fm_int              sw,
                                  fm_macAddressEntry *entries,
                                  fm_int              maxEntries);
 
+fm_status fm10000GetAddressTablePage(fm_int              sw,
+                                     fm_macTableCursor * cursor,
+                                     fm_int *            nEntries,
+                                     fm_macAddressEntry *entries,
+                                     fm_int              maxEntries);
+
+fm_status fm10000GetAddressTableSnapshot(fm_int              sw,
+                                         fm_macTableCursor * cursor,
+                                         fm_int *            nEntries,
+                                         fm_macAddressEntry *entries,
+                                         fm_int              maxEntries);
+
 fm_status fm10000GetAddressTableAttribute(fm_int sw, 
                                           fm_int attr, 
                                           void * value);
 
+fm_status fm10000GetAddressTableStats(fm_int sw, fm_macTableStats *stats);
+
 fm_status fm10000GetLearningFID(fm_int      sw,
                                 fm_uint16   vlanId,
                                 fm_uint16 * learningFid);
@@ -202,6 +231,8 @@ fm_status fm10000ReadEntryAtIndex(fm_int                   sw,
                                   fm_internalMacAddrEntry *entry);
 #endif
 
+fm_status fm10000ResetAddressTableStats(fm_int sw);
+
 fm_status fm10000SetAddressTableAttribute(fm_int sw, 
                                           fm_int attr, 
                                           void * value);
@@ -274,5 +305,12 @@ void fm10000DbgDumpMACTableEntry(fm_int     sw,
                                  fm_macaddr address, 
                                  fm_uint16  vlan);
 
+fm_status fm10000DbgInjectMACTableEvents(fm_int     sw,
+                                         fm_macaddr firstAddress,
+                                         fm_uint16  vlanID,
+                                         fm_int     port,
+                                         fm_int     numEntries,
+                                         fm_int *   numInjected);
+
 
 #endif /* __FM_FM10000_API_ADDR_INT_H */
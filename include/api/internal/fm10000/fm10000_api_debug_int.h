@@ -61,6 +61,10 @@ void fm10000DbgGetRegisterName(fm_int   sw,
                                fm_bool  logicalPorts,
                                fm_bool  partialLongRegs);
 
+fm_status fm10000DbgGetRegisterId(fm_int  sw,
+                                  fm_uint regAddress,
+                                  fm_int *regId);
+
 void fm10000DbgReadRegister(fm_int  sw,
                             fm_int  firstIndex,
                             fm_int  secondIndex,
@@ -103,6 +107,13 @@ void fm10000DbgTakeChipSnapshot(fm_int                sw,
                                 fmDbgFulcrumSnapshot *pSnapshot,
                                 fm_regDumpCallback    callback);
 
+fm_status fm10000DbgStreamRegisters(fm_int                sw,
+                                    fm_text               regName,
+                                    fm_text               fileName,
+                                    fm_dbgRegStreamFormat format);
+
+fm_status fm10000DbgDecodeRegisterStream(fm_text fileName);
+
 fm_status fm10000DbgGetRegInfo(fm_text    registerName,
                                fm_uint32 *registerAddr,
                                fm_int *   wordCnt,
@@ -136,6 +147,11 @@ fm_status fm10000DbgPlotEyeDiagram(fm_eyeDiagramSample *sampleTable);
 
 fm_status fm10000DbgDeleteEyeDiagram(fm_eyeDiagramSample *sampleTable);
 
+fm_status fm10000DbgTakeEyeMetrics(fm_int               sw,
+                                   fm_int               maxLanesPerRing,
+                                   fm_eyeMetricCallback callback,
+                                   fm_voidptr           callbackInfo);
+
 fm_status fm10000DbgDumpPortMap(fm_int sw, fm_int port, fm_int portType);
 
 fm_status fm10000DbgGetNominalSwitchVoltages(fm_int     sw,
@@ -35,6 +35,73 @@
 #define __FM_FM10000_API_EVENT_MAC_MAINT_INT_H
 
 
+/* Statistics on the passes over the MA Table Change Notification FIFO. */
+typedef struct _fm10000_tcnBurstStats
+{
+    /* Number of passes that found at least one entry in the FIFO. */
+    fm_uint64   numBursts;
+
+    /* Total number of FIFO entries processed. */
+    fm_uint64   numEntries;
+
+    /* Largest number of FIFO entries processed in a single pass. */
+    fm_uint32   maxEntries;
+
+    /* Number of passes that stopped at the burst size limit. */
+    fm_uint64   numLimited;
+
+    /* Total time spent processing FIFO entries, in microseconds. */
+    fm_uint64   totalLatency;
+
+    /* Longest time spent in a single pass, in microseconds. */
+    fm_uint64   maxLatency;
+
+} fm10000_tcnBurstStats;
+
+
+/* Token bucket used to limit the rate at which new source addresses
+ * are learned. */
+typedef struct _fm10000_learnBucket
+{
+    /* Available tokens, in thousandths of an address. */
+    fm_uint64   tokens;
+
+    /* Time of the last refill, in milliseconds. */
+    fm_uint64   lastRefill;
+
+    /* Time of the last dropped address, in milliseconds. */
+    fm_uint64   lastDrop;
+
+    /* Whether addresses are currently being dropped. */
+    fm_bool     throttled;
+
+    /* Number of addresses dropped. */
+    fm_uint64   numDropped;
+
+    /* Number of times throttling began. */
+    fm_uint64   numThrottled;
+
+} fm10000_learnBucket;
+
+
+/* State of the learning rate limiter. */
+typedef struct _fm10000_learnLimiter
+{
+    /* Switch-wide limit, in addresses per second. 0 means no limit. */
+    fm_uint32               rate;
+
+    /* Per-port limit, in addresses per second. 0 means no limit. */
+    fm_uint32               portRate;
+
+    /* Switch-wide token bucket. */
+    fm10000_learnBucket     global;
+
+    /* Token bucket for each physical port. */
+    fm10000_learnBucket     port[FM10000_NUM_FABRIC_PORTS];
+
+} fm10000_learnLimiter;
+
+
 /*****************************************************************************
  * Public function prototypes.
  *****************************************************************************/
@@ -53,6 +120,9 @@ fm_uint64 fm10000GetAgingTimer(void);
 
 fm_status fm10000HandleMACTableEvents(fm_int sw);
 fm_status fm10000TCNInterruptHandler(fm_int sw, fm_uint32 events);
+void fm10000DbgDumpTcnBurstStats(fm_int sw);
+void fm10000DbgResetTcnBurstStats(fm_int sw);
+void fm10000InitLearnLimiter(fm_int sw);
 
 
 /**************************************************
@@ -60,6 +60,28 @@ typedef struct _fm_fm10000ffuOwnershipInfo
 } fm_fm10000FfuOwnershipInfo;
 
 
+/* FFU rule writes held back by fm10000StartFFUWriteQueue */
+typedef struct _fm_fm10000FfuWriteQueue
+{
+    /* Thread that owns the queue, NULL when no queue is open */
+    void *             owner;
+
+    /* Number of nested fm10000StartFFUWriteQueue calls made by the owner */
+    fm_int             depth;
+
+    /* Slice chains with queued writes. Chains never overlap, the
+     * caseLocation of each chain points into chainCase. */
+    fm_ffuSliceInfo    chains[FM_FM10000_NUM_FFU_SLICES];
+    fm_ffuCaseLocation chainCase[FM_FM10000_NUM_FFU_SLICES]
+                                [FM_FM10000_NUM_FFU_SLICES];
+    fm_int             numChains;
+
+    /* Queued writes keyed on (chain << 16) | ruleIndex */
+    fm_tree            writes;
+
+} fm_fm10000FfuWriteQueue;
+
+
 /**************************************************/
 /** \ingroup typeStruct
  *  Referenced by ''fm_fm10000FfuSliceKey'', this 
@@ -131,8 +153,20 @@ fm_status fm10000GetFFUSliceOwner(fm_int           sw,
                                   fm_int           slice,
                                   fm_ffuOwnerType *owner);
 
+fm_status fm10000GetFFUSliceMap(fm_int          sw,
+                                fm_int          slice,
+                                fm_ffuSliceMap *sliceMap);
+
+fm_status fm10000DefragmentFFU(fm_int          sw,
+                               fm_ffuOwnerType owner,
+                               fm_int          budget,
+                               fm_int *        numMoved);
+
 fm_status fm10000FFUInit(fm_int sw);
 
+fm_status fm10000StartFFUWriteQueue(fm_int sw);
+fm_status fm10000FlushFFUWriteQueue(fm_int sw);
+
 
 /* slice functions */
 fm_status fm10000SetFFUMasterValid(fm_int    sw,
@@ -150,6 +150,48 @@
  * TE table. */
 #define FM10000_TE_TABLE_MAX_ACTIONS   1
 
+/* Default scan budget of the flow aging engine per tick, in microseconds. */
+#define FM10000_FLOW_AGING_DEFAULT_BUDGET  1000
+
+/* Activity tracked by the flow aging engine for one flow. */
+typedef struct _fm10000_flowAgingEntry
+{
+    /* Frame count seen on the previous scan. */
+    fm_uint64              lastPkts;
+
+    /* Time of the last observed activity in milliseconds, 0 if the flow
+     * has not been scanned yet. */
+    fm_uint64              lastActive;
+
+} fm10000_flowAgingEntry;
+
+/* Per-table state of the flow aging engine. */
+typedef struct _fm10000_flowAgingInfo
+{
+    /* Switch and table served by the aging timer, passed to its callback. */
+    fm_int                  sw;
+    fm_int                  tableIndex;
+
+    /* Idle timeout in milliseconds, 0 if aging is disabled. */
+    fm_uint32               timeout;
+
+    /* Indicates if idle flows are deleted by the aging engine. */
+    fm_bool                 autoDelete;
+
+    /* Maximum scan time per tick, in microseconds. */
+    fm_uint32               scanBudget;
+
+    /* Activity of each flow, indexed by flow ID. */
+    fm10000_flowAgingEntry *entries;
+
+    /* Flow ID from which the next tick resumes scanning. */
+    fm_int                  cursor;
+
+    /* Timer driving the scan ticks, NULL until aging is first enabled. */
+    fm_timerHandle          timer;
+
+} fm10000_flowAgingInfo;
+
 /*  Structure that contains information related to the Flow API table. */
 typedef struct _fm10000_flowTableInfo
 {
@@ -207,6 +249,12 @@ typedef struct _fm10000_flowTableInfo
     /* Maximum number of actions that can be set for a flow in a table. */
     fm_uint32              maxAction;
 
+    /* Flow ID of the catch-all default flow, -1 if none. */
+    fm_int                 defaultFlowId;
+
+    /* Flow aging engine state. */
+    fm10000_flowAgingInfo  aging;
+
 } fm10000_flowTableInfo;
 
 /*  Structure that contains information related to the Flow API. */
@@ -282,6 +330,12 @@ fm_status fm10000AddFlow(fm_int           sw,
                          fm_flowState     flowState,
                          fm_int *         flowId);
 
+fm_status fm10000AddFlowList(fm_int            sw,
+                             fm_int            tableIndex,
+                             fm_int            numFlows,
+                             fm_flowListEntry *flows,
+                             fm_status *       results);
+
 fm_status fm10000GetFlow(fm_int             sw,
                          fm_int             tableIndex,
                          fm_int             flowId,
@@ -392,4 +446,10 @@ fm_status fm10000GetFlowTableSupportedActions(fm_int           sw,
                                               fm_flowTableType flowTableType,
                                               fm_flowAction *  flowAction);
 
+fm_status fm10000UpdateFlowAging(fm_int sw, fm_int tableIndex);
+
+void fm10000ResetFlowAgingEntry(fm_int sw, fm_int tableIndex, fm_int flowId);
+
+void fm10000FreeFlowAging(fm_int sw, fm_int tableIndex);
+
 #endif /* __FM_FM10000_API_FLOW_INT_H */
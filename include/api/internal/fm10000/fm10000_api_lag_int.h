@@ -79,9 +79,11 @@ void fm10000FreeLAG(fm_int sw, fm_int lagIndex);
 
 fm_status fm10000AddPortToLag(fm_int sw, fm_int lagIndex, fm_int port);
 fm_status fm10000DeletePortFromLag(fm_int sw, fm_int lagIndex, fm_int port);
+fm_status fm10000FlushLagUpdates(fm_int sw);
 
 fm_status fm10000InformLAGPortUp(fm_int sw, fm_int port);
 fm_status fm10000InformLAGPortDown(fm_int sw, fm_int port);
+fm_status fm10000LagFastFailover(fm_int sw, fm_int port);
 
 fm_status fm10000SetLagAttribute(fm_int sw,
                                  fm_int attribute,
@@ -130,6 +130,12 @@
 fm_status fm10000PCIeMailboxInterruptHandler(fm_int sw,
                                              fm_int pepNb);
 
+fm_status fm10000PCIeMailboxBatchInterruptHandler(fm_int    sw,
+                                                  fm_uint32 pepMask);
+
+fm_status fm10000MailboxServicePeps(fm_int    sw,
+                                    fm_uint32 pepMask);
+
 fm_status fm10000WriteResponseMessage(fm_int                        sw,
                                       fm_int                        pepNb,
                                       fm_mailboxControlHeader *     ctrlHdr,
@@ -85,6 +85,11 @@ fm_status fm10000DeleteMirror(fm_int              sw,
 fm_status fm10000WritePortMirrorGroup(fm_int              sw,
                                       fm_portMirrorGroup *grp);
 
+fm_status fm10000UpdateMirrorGroupPorts(fm_int              sw,
+                                        fm_portMirrorGroup *grp,
+                                        fm_int              numPorts,
+                                        fm_int *            portList);
+
 fm_status fm10000SetMirrorAttribute(fm_int              sw,
                                     fm_portMirrorGroup *grp,
                                     fm_int              attr,
@@ -74,6 +74,10 @@ typedef struct _fm10000_mtableInfo
     /* A bit array representing the quarantined entries in MCAST_VLAN_TABLE */
     fm_bitArray   clonedEntriesBitArray;
 
+    /* A bit array representing the quarantined entries in MCAST_VLAN_TABLE
+     * that the ongoing cleanup will recover */
+    fm_bitArray   recoveringEntriesBitArray;
+
     /* entry count */
     fm_int        clonedEntriesCount;
 
@@ -112,9 +116,58 @@ typedef struct _fm10000_mtableInfo
     /* Whether or not to attempt automatic cleanup */
     fm_bool       autoCleanup;
 
+    /* the epoch that has to drain before the ongoing cleanup may recover
+     * the entries in recoveringEntriesBitArray */
+    fm_byte       cleanupEpoch;
+
+    /* whether or not cleanupEpoch has drained */
+    fm_bool       cleanupDrained;
+
+    /* last MCAST_VLAN_TABLE index examined by the ongoing cleanup, -1 once
+     * all entries have been recovered */
+    fm_int        cleanupIndex;
+
+    /* maximum time spent recovering entries per maintenance pass, in
+     * nanoseconds. 0 means no limit. */
+    fm_uint64     cleanupBudget;
+
+    /* largest free MCAST_VLAN_TABLE block size that triggers a cleanup
+     * before the watermark is reached */
+    fm_int        cleanupFreeBlock;
+
+    /* vlanTableCount when the fragmentation was last checked */
+    fm_int        fragCheckVlanTableCount;
+
+    /* number of completed cleanups */
+    fm_uint64     cleanupCount;
+
+    /* number of cleanups forced by an allocation failure */
+    fm_uint64     forcedCleanupCount;
+
+    /* number of cleanups started because the table was fragmented */
+    fm_uint64     fragCleanupCount;
+
 } fm10000_mtableInfo;
 
 
+/* Fragmentation statistics of the MCAST_LEN_TABLE or MCAST_VLAN_TABLE */
+typedef struct _fm10000_mtableFragStats
+{
+    /* number of free entries */
+    fm_int freeEntries;
+
+    /* number of blocks of contiguous free entries */
+    fm_int freeBlocks;
+
+    /* size of the largest block of contiguous free entries */
+    fm_int largestFreeBlock;
+
+    /* number of expired entries waiting to be recovered */
+    fm_int expiredEntries;
+
+} fm10000_mtableFragStats;
+
+
 /* Wraps the MTable entry list mapping (port, vlan) -> list < entries > */
 typedef struct
 {
@@ -178,6 +231,13 @@ fm_status fm10000MTableAddListener(fm_int               sw,
                                    fm_int               repliGroup,
                                    fm10000_mtableEntry  listener);
 
+fm_status fm10000MTableAddListenerList(fm_int               sw,
+                                       fm_int               mcastGroup,
+                                       fm_int               repliGroup,
+                                       fm_int               numListeners,
+                                       fm10000_mtableEntry *listeners,
+                                       fm_int *             numAdded);
+
 fm_status fm10000MTableDeleteListener(fm_int              sw,
                                       fm_int               mcastGroup,
                                       fm_int               repliGroup,
@@ -194,6 +254,10 @@ fm_status fm10000GetAvailableMulticastListenerCount(fm_int  sw,
 
 fm_status fm10000MTablePeriodicMaintenance(fm_int sw);
 
+fm_status fm10000GetMTableFragmentation(fm_int                   sw,
+                                        fm10000_mtableFragStats *vlanStats,
+                                        fm10000_mtableFragStats *lenStats);
+
 
 fm_status fm10000DbgDumpMulticastVlanTable(fm_int sw);
 
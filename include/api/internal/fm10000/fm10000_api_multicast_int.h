@@ -69,6 +69,11 @@ fm_status fm10000DeleteMcastGroup(fm_int sw, fm_intMulticastGroup *group);
 fm_status fm10000AddMulticastListener(fm_int                   sw,
                                       fm_intMulticastGroup *   group,
                                       fm_intMulticastListener *listener);
+fm_status fm10000AddMulticastListenerList(fm_int                    sw,
+                                          fm_intMulticastGroup *    group,
+                                          fm_int                    numListeners,
+                                          fm_intMulticastListener **listeners,
+                                          fm_int *                  numAdded);
 fm_status fm10000DeleteMulticastListener(fm_int                   sw,
                                          fm_intMulticastGroup *   group,
                                          fm_intMulticastListener *listener);
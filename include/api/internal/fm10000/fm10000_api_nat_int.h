@@ -143,6 +143,9 @@ typedef struct _fm_fm10000NatCfg
      *   Value is a fm_fm10000NatTable* type. */
     fm_tree             tables;
 
+    /** TRUE while the tunnel engine writes of a NAT rule list are being
+     *  batched, see ''fm10000BeginNatRuleList''. */
+    fm_bool             listWriteBatch;
 
 } fm_fm10000NatCfg;
 
@@ -169,6 +172,8 @@ fm_status fm10000AddNatRule(fm_int                sw,
                             fm_natAction          action,
                             fm_natActionParam *   actParam);
 fm_status fm10000DeleteNatRule(fm_int sw, fm_int table, fm_int rule);
+fm_status fm10000BeginNatRuleList(fm_int sw, fm_int table);
+fm_status fm10000EndNatRuleList(fm_int sw, fm_int table);
 fm_status fm10000AddNatPrefilter(fm_int                sw,
                                  fm_int                table,
                                  fm_int                entry,
@@ -63,6 +63,15 @@
 #define FM10000_ARP_PACKING_DEFRAG_STAGES_MAX_ITERATIONS    16
 #define FM10000_ARP_PACKING_STAGES_MAX_ITERATIONS           128
 
+/* ARP table background packing parameters: packing starts when the
+ * fragmentation index [0..100] reaches the start level, stops when it falls
+ * to the stop level, and moves at most the given number of blocks, out of
+ * the given number of free groups scanned, per maintenance tick. */
+#define FM10000_ARP_BG_PACKING_START_FRAG_INDEX             20
+#define FM10000_ARP_BG_PACKING_STOP_FRAG_INDEX              5
+#define FM10000_ARP_BG_PACKING_BLOCKS_PER_TICK              8
+#define FM10000_ARP_BG_PACKING_SCANS_PER_TICK               64
+
 /* ARP statistics: forced update trigger level */
 #define FM10000_ARP_STATS_UPDATE_TRIGGER_LEVEL              4096
 #define FM_10000_ARP_HISTOGRAM_MAX_LENGTH                   20
@@ -361,6 +370,15 @@ typedef struct _fm10000_NextHopSysCtrl
      */
     fm_uint16              freeBlkStatInfo[8];
 
+    /* TRUE while background packing is in progress. */
+    fm_bool                arpBgPackingActive;
+
+    /* ARP table index at which background packing resumes. */
+    fm_int                 arpBgPackingScanIndex;
+
+    /* Number of blocks moved by background packing. */
+    fm_uint64              arpBgPackingMovedBlocks;
+
 
     /************************* 
      *  ECMP section
@@ -425,6 +443,7 @@ fm_status fm10000NotifyArpBlockChange (fm_int    sw,
                                        fm_int    oldBlockOffset);
 fm_status fm10000CheckValidArpBlockSize (fm_int  blockSize);
 fm_status fm10000DefragArpTable (fm_int     sw);
+fm_status fm10000ArpTablePeriodicMaintenance(fm_int sw);
 
 /* interface group */
 
@@ -51,6 +51,10 @@
 #define DROP_PARITY_LOCK(sw) \
     fmReleaseLock(GET_PARITY_LOCK(sw));
 
+/* Number of SRAM_ERR_IP and CRM_IP InterruptPending bits tracked
+ * by the coalescing window. */
+#define FM10000_COALESCE_BITS   64
+
 
 /******************************************
  * FM10000 SRAM identifiers. 
@@ -373,6 +377,23 @@ enum
 };
 
 
+/******************************************
+ * Parity error coalescing window state.
+ ******************************************/
+enum
+{
+    /** No coalescing window is open. */
+    FM10000_COALESCE_IDLE = 0,
+
+    /** A first-stage handler has opened a window. The decoder has
+     *  yet to start the window timer. */
+    FM10000_COALESCE_OPEN,
+
+    /** The window timer is running. */
+    FM10000_COALESCE_ARMED,
+};
+
+
 /******************************************
  * Parity error repair data. 
  *  
@@ -430,6 +451,28 @@ typedef struct _fm10000_parityInfo
     /** CRM timeout in milliseconds. */
     fm_timestamp        crmTimeout;
 
+    /** Time budget for a single pass of the repair task. A zero
+     *  budget leaves the pass unbounded. */
+    fm_timestamp        sweepBudget;
+
+    /** Time at which the current repair pass must yield. */
+    fm_timestamp        sweepDeadline;
+
+    /** Entry at which to resume each partially repaired register table.
+     *  Indexed by fm_repairType. */
+    fm_int              resumeIndex[FM_REPAIR_TYPE_MAX];
+
+    /** Repair currently being performed, if it may be suspended and
+     *  resumed on a later pass. FM_REPAIR_TYPE_NONE otherwise. */
+    fm_int              activeRepair;
+
+    /** Entry at which the active repair starts; updated with the
+     *  entry at which to resume when the repair is suspended. */
+    fm_int              activeIndex;
+
+    /** Whether the active repair was suspended. */
+    fm_bool             activeSuspended;
+
     /** The number of correctable POLICER parity errors that may occur
      * before the API sends a Deferred Reset event to the application.
      * A value of zero disables the event. */
@@ -466,6 +509,42 @@ typedef struct _fm10000_parityInfo
     fm_uint32          refcountUerrError;
     fm_uint32          refcountUerrFatal;
 
+    /** Length of the error coalescing window. A zero window decodes
+     *  every SRAM_ERR and CRM error as it is reported. */
+    fm_timestamp        coalesceWindow;
+
+    /** Number of errors a FRAME_MEMORY segment may report within one
+     *  window before its interrupt is held masked. */
+    fm_uint32           coalesceThreshold;
+
+    /** Timer that closes the coalescing window. */
+    fm_timerHandle      coalesceTimer;
+
+    /** Coalescing window state. Protected by the register lock. */
+    fm_int              coalesceState;
+
+    /** Set by the window timer once the window has elapsed. */
+    fm_bool             coalesceExpired;
+
+    /** Errors reported against each SRAM_ERR_IP and CRM_IP
+     *  InterruptPending bit in the current window. Protected by the
+     *  register lock. */
+    fm_uint32           sramErrCount[FM10000_COALESCE_BITS];
+    fm_uint32           crmErrCount[FM10000_COALESCE_BITS];
+
+    /** Memories that have been decoded in the current window. Further
+     *  errors against them are only counted. */
+    fm_uint64           sramErrDecoded;
+    fm_uint64           crmErrDecoded;
+
+    /** SRAM_ERR_IP bits held masked until the window closes. */
+    fm_uint64           sramErrThrottled;
+
+    /** CRM_IP InterruptPending bits whose repair is deferred until the
+     *  window closes. The CRM keeps these interrupts masked until the
+     *  repair completes. */
+    fm_uint64           crmErrDeferred;
+
 } fm10000_parityInfo;
 
 
@@ -502,6 +581,8 @@ fm_status fm10000DbgDumpParityConfig(fm_int sw);
 
 fm_status fm10000ParityErrorDecoder(fm_switch * switchPtr);
 
+fm_status fm10000CloseParityCoalesceWindow(fm_int sw);
+
 /******************************************
  * fm10000_api_parity_intr.c
  ******************************************/
@@ -55,4 +55,20 @@ fm_status fm10000SendPacketISL(fm_int          sw,
                                fm_islTagFormat islTagFormat,
                                fm_buffer *     pkt);
 
+fm_status fm10000CreateTxDestination(fm_int  sw,
+                                     fm_int *portList,
+                                     fm_int  numPorts,
+                                     fm_int *destHandle);
+
+fm_status fm10000DeleteTxDestination(fm_int sw, fm_int destHandle);
+
+fm_status fm10000SendPacketTxDestination(fm_int           sw,
+                                         fm_int           destHandle,
+                                         fm_buffer *      pkt,
+                                         fm_packetInfoV2 *info);
+
+fm_status fm10000GetTxQueueSpace(fm_int    sw,
+                                 fm_uint32 switchPriority,
+                                 fm_int *  space);
+
 #endif  /* __FM_FM10000_API_PKT_INT_H */
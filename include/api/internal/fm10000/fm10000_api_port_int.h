@@ -118,6 +118,11 @@ typedef enum
 #define WHICH_PORT_OF_EPL_GROUP_MASK            0x3
 #define EPL_PORT_GROUP_MASK                     (~WHICH_PORT_OF_EPL_GROUP_MASK)
 
+/* Link-flap damping defaults, see FM_PORT_LINK_DAMPING_HALF_LIFE */
+#define FM10000_LINK_DAMPING_DEF_PENALTY        1000
+#define FM10000_LINK_DAMPING_DEF_SUPPRESS       2000
+#define FM10000_LINK_DAMPING_DEF_REUSE          750
+
 /* Tx Drain Modes */
 #define FM10000_PORT_TX_DRAIN_ALWAYS             0
 #define FM10000_PORT_TX_DRAIN_ON_LINK_DOWN       1
@@ -334,6 +339,11 @@ typedef struct _fm10000_portAttrEntryTable
     fm_portAttrEntry txClkCompensation;
     fm_portAttrEntry smpLosslessPause;
     fm_portAttrEntry autoDetectModule;
+    fm_portAttrEntry linkDampingHalfLife;
+    fm_portAttrEntry linkDampingPenalty;
+    fm_portAttrEntry linkDampingSuppress;
+    fm_portAttrEntry linkDampingReuse;
+    fm_portAttrEntry linkDampingStatus;
 
 } fm10000_portAttrEntryTable;
 
@@ -393,6 +403,11 @@ typedef struct _fm10000_portAttr
     fm_bool            parserVlan2First;
     fm_bool            modifyVid2First;
     fm_bool            replaceVlanFields;
+    fm_uint32          linkDampingHalfLife;
+    fm_uint32          linkDampingPenalty;
+    fm_uint32          linkDampingSuppress;
+    fm_uint32          linkDampingReuse;
+    fm_bool            linkDampingSuppressed;
 
 } fm10000_portAttr;
 
@@ -579,6 +594,16 @@ struct _fm10000_port
     /* chip-specific port attributes defined in _fm_portAttr */
     fm10000_portAttr      attributes;
 
+    /* Copy of the attribute blocks published by
+     * fm10000PublishPortAttributes for readers that do not take the
+     * port attribute lock. attrSeq is odd while the copy is rewritten;
+     * readers retry until they observe the same even value before and
+     * after their read. */
+    fm_uint32             attrSeq;
+    fm_bool               attrPublished;
+    fm_portAttr           pubAttr;
+    fm10000_portAttr      pubAttrExt;
+
     /***************************************************
      * For multicast group ports.
      **************************************************/
@@ -622,6 +647,15 @@ struct _fm10000_port
     /* timer associated to the pcie port interrupt stuck recovery */
     fm_timerHandle        pcieIntrTimerHandle;
 
+    /* link-flap damping state and counters */
+    fm_linkDampingStatus  linkDamping;
+
+    /* monotonic time (nsec) at which linkDamping.penalty was last decayed */
+    fm_uint64             linkDampingNsec;
+
+    /* timer releasing a suppressed port, created on first suppression */
+    fm_timerHandle        linkDampingTimer;
+
     /* native lane for Ethernet ports */
     struct _fm10000_lane *nativeLaneExt;
 
@@ -707,6 +741,22 @@ fm_status fm10000SetPortAttributeOnLAGs(fm_int sw, fm_int attr, void * value);
 
 fm_bool   fm10000IsPerLagPortAttribute(fm_int sw, fm_uint attr);
 
+fm_status fm10000BeginPortAttributeUpdate(fm_int sw);
+
+fm_status fm10000EndPortAttributeUpdate(fm_int sw);
+
+fm_status fm10000GetPortAttributeSnapshot(fm_int sw,
+                                          fm_int port,
+                                          fm_int attr,
+                                          void * value);
+
+void fm10000PublishPortAttributes(fm_int sw, fm_int port);
+
+fm_status fm10000ResetLinkDamping(fm_int sw, fm_int port);
+fm_status fm10000GetLinkDampingStatus(fm_int                sw,
+                                      fm_int                port,
+                                      fm_linkDampingStatus *status);
+
 void fm10000DbgDumpPortAttributes(fm_int sw, fm_int port);
 
 fm_status fm10000IsPortBistActive(fm_int   sw,
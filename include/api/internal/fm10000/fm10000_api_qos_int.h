@@ -159,6 +159,9 @@ typedef struct _fm10000_priorityMapSet
     fm10000_priorityMapperList      mapperPool;
     /* The list of supported priority maps.  */
     fm10000_internalPriorityMapList maps;
+    /* Storage for the priority maps, one per internal trap class and
+     * indexed by it, so a map is found without walking the list.  */
+    fm10000_internalPriorityMap *   mapTable;
 
 } fm10000_priorityMapSet;
 
@@ -306,6 +309,10 @@ fm_status fm10000InitializeCM(fm_int sw);
 
 fm_status fm10000InitQOS(fm_int sw);
 
+fm_status fm10000BeginWatermarkUpdate(fm_int sw);
+
+fm_status fm10000EndWatermarkUpdate(fm_int sw);
+
 fm_status fm10000QOSPriorityMapperAllocateResources(fm_int sw);
 
 fm_status fm10000QOSPriorityMapperFreeResources(fm_int sw);
@@ -48,8 +48,9 @@
 
 /* Debug flag to maintain route contents in the TCAM route entry structure
  * so that diagnostic software can validate the hardware TCAM against
- * the expected contents. */
-#if 1
+ * the expected contents. This more than doubles the size of every TCAM
+ * route entry, so it is off unless needed for debugging. */
+#if 0
 #define FM10000_DBG_TRACK_ROUTE_CONTENTS
 #endif
 
@@ -171,11 +172,11 @@ typedef struct _fm10000_TcamRouteEntry
     fm_intRouteEntry *           routePtr;
     fm_routeAction               action;
     fm_bool                      dirty;
+    int                          tcamSliceRow;
     struct _fm10000_RoutingTable *routeTable;
     struct _fm10000_RoutePrefix * routePrefix;
     struct _fm10000_RouteSlice *  routeSlice;
     struct _fm10000_EcmpGroup *   ecmpGroup;
-    int                          tcamSliceRow;
     FM_DLL_DEFINE_NODE(_fm10000_TcamRouteEntry, nextTcamRoute, prevTcamRoute);
     FM_DLL_DEFINE_NODE(_fm10000_TcamRouteEntry,
                        nextPrefixRoute,
@@ -402,6 +403,19 @@ typedef struct _fm10000_RoutingState
     /* Array of route table pointers, indexed by route type. */
     fm10000_RoutingTable * routeTables[FM10000_NUM_ROUTE_TYPES];
 
+    /* Number of routes placed in the TCAM. Only maintained for the
+     * actual state. */
+    fm_uint64              tcamRouteInserts;
+
+    /* Number of route moves within the TCAM, for any reason. */
+    fm_uint64              tcamRouteMoves;
+
+    /* Number of route moves made to place new routes. */
+    fm_uint64              tcamInsertMoves;
+
+    /* Highest number of route moves made to place a single route. */
+    fm_uint64              tcamMaxInsertMoves;
+
 } fm10000_RoutingState;
 
 
@@ -472,6 +486,14 @@ fm_status fm10000GetRouteAttribute(fm_int sw,
                                    void *pValue);
 fm_status fm10000DbgValidateRouteTables(fm_int sw);
 void fm10000DbgDumpRouteStats(fm_int sw);
+fm_status fm10000GetRouteMoveCount(fm_int sw, fm_uint64 *moveCount);
+fm_status fm10000GetRouteMemoryUsage(fm_int sw, fm_uint64 *bytes);
+fm_status fm10000GetRouteFFUSliceRows(fm_int     sw,
+                                      fm_int     slice,
+                                      fm_uint64 *usedRows);
+fm_status fm10000DefragmentRouteFFU(fm_int  sw,
+                                    fm_int  budget,
+                                    fm_int *numMoved);
 void fm10000DbgDumpStateTable(fm_int sw);
 void fm10000DbgDumpPrefixLists(fm_int sw);
 void fm10000DbgDumpRouteTables(fm_int sw, fm_int flags);
@@ -46,6 +46,9 @@
 
 #define FM10000_MAX_SCHEDULE_LENGTH         512
 
+/* Number of generated schedules kept for reuse by speed profile */
+#define FM10000_SCHED_PROFILE_CACHE_SIZE    4
+
 /* Redefinitions of because this file is included for low-lev APIs
  *    - FM10000_NUM_PORTS
  *    - FM10000_NUM_FABRIC_PORTS
@@ -260,6 +263,34 @@ typedef struct _fm10000_schedInfoInt
 
 
 
+/* Scheduler configuration generated for one reserved speed profile */
+typedef struct _fm10000_schedProfile
+{
+    /* TRUE if the entry holds a generated schedule */
+    fm_bool               valid;
+
+    /* Value of profileUseCount when the entry was last used */
+    fm_uint64             lastUse;
+
+    /* Profile key: schedule length and reserved speed/quad per physical
+     * port at generation time */
+    fm_int                schedLen;
+    fm10000_schedSpeed    reservedSpeed[FM10000_SCHED_NUM_PORTS];
+    fm_bool               reservedQuad[FM10000_SCHED_NUM_PORTS];
+
+    /* Generated schedule, see fm10000_schedInfoInt */
+    fm10000_schedSpeed    physPortSpeed[FM10000_SCHED_NUM_PORTS];
+    fm10000_schedSpeed    fabricPortSpeed[FM10000_SCHED_NUM_FABRIC_PORTS];
+    fm10000_schedPortDifficulty diffTable[FM10000_SCHED_NUM_PORTS];
+    fm_schedulerToken     schedList[FM10000_MAX_SCHEDULE_LENGTH];
+    fm10000_schedSpeed    speedList[FM10000_MAX_SCHEDULE_LENGTH];
+    fm_int                spare25GSlots;
+
+} fm10000_schedProfile;
+
+
+
+
 /* Structure that tracks the scheduler software/HW state */
 typedef struct _fm10000_schedInfo
 {
@@ -314,6 +345,15 @@ typedef struct _fm10000_schedInfo
     fm10000_schedSpeed    preReservedSpeed[FM10000_SCHED_NUM_PORTS];
     fm_bool               preReservedQuad[FM10000_SCHED_NUM_PORTS];
 
+    /* Schedules generated by fm10000RegenerateSchedule, indexed by reserved
+     * speed profile so that returning to a known profile (e.g. undoing a
+     * breakout) reuses its rings. Array of FM10000_SCHED_PROFILE_CACHE_SIZE
+     * entries, allocated on first use. */
+    fm10000_schedProfile *profileCache;
+
+    /* Number of regenerations, used for LRU replacement in profileCache */
+    fm_uint64             profileUseCount;
+
 } fm10000_schedInfo;
 
 
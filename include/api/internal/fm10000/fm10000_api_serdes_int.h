@@ -160,6 +160,14 @@
 #define FM10000_SERDES_DFE_TUNING_MAX_CYCLES    100
 
 
+/* Number of tuning durations to observe before timeouts are learned */
+#define FM10000_SERDES_DFE_SCHED_MIN_SAMPLES    8
+
+
+/* Lower bound of a learned tuning timeout, in milliseconds */
+#define FM10000_SERDES_DFE_SCHED_MIN_LIMIT_MS   1000
+
+
 
 
 #define FM10000_SERDES_DFE_DATA_LEVEL0_THRESHLD 10
@@ -532,6 +540,38 @@ typedef struct
 
 
 
+/* Tuning duration history for one DFE tuning phase */
+typedef struct
+{
+    fm_uint32        samples;
+
+    fm_uint32        avgMs;
+
+    fm_uint32        maxMs;
+
+} fm10000_dfeTuningHist;
+
+
+
+
+/* Per-switch DFE tuning scheduler state */
+typedef struct
+{
+    fm_uint32             nextSeq;
+
+    fm_uint32             grantCnt;
+
+    fm_uint32             deferCnt;
+
+    fm10000_dfeTuningHist iCalHist;
+
+    fm10000_dfeTuningHist pCalHist;
+
+} fm10000_dfeSched;
+
+
+
+
 struct _fm10000_serdes
 {
     fm_uint32                       magicNumber;
@@ -693,6 +733,12 @@ struct  _fm10000_laneDfe
     fm_bool                     pCalKrMode;
 
 
+    fm_bool                     schedWaiting;
+
+
+    fm_uint32                   schedSeq;
+
+
 
 
     fm_int                      dfeDebounceTime;
@@ -1153,6 +1199,8 @@ fm_status fm10000SerdesRead(fm_int sw, fm_int serdes, fm_uint regAddr, fm_uint32
 
 fm_status fm10000SbmSpicoIntWrite(fm_int sw, fm_serdesRing ring, fm_uint sbusAddr, fm_uint intNum, fm_uint32 param);
 fm_status fm10000SbmSpicoIntRead(fm_int sw, fm_serdesRing ring, fm_uint sbusAddr, fm_uint32 *value);
+fm_bool fm10000SerdesSpicoIntUsesSBus(fm_int sw,
+                                      fm_int serdes);
 fm_status fm10000SerdesSpicoInt(fm_int     sw,
                                 fm_int     serdes,
                                 fm_uint    intNum,
@@ -1293,6 +1341,11 @@ fm_status fm10000SerdesChckCrcVersionBuildId(fm_int     sw,
                                              fm_int     firstSerdes,
                                              fm_int     lastSerdes,
                                              fm_uint32  expectedCodeVersionBuildId);
+fm_status fm10000SerdesIsSpicoFwLoaded(fm_int     sw,
+                                       fm_int     firstSerdes,
+                                       fm_int     lastSerdes,
+                                       fm_uint32  expectedCodeVersionBuildId,
+                                       fm_bool   *pLoaded);
 fm_status fm10000SbmChckCrcVersionBuildId(fm_int     sw,
                                           fm_int     ring,
                                           fm_uint32  expectedCodeVersionBuildId);
@@ -1552,6 +1605,12 @@ fm_status fm10000SerdesGetEyeHeight(fm_int  sw,
                                     fm_int  serDes,
                                     fm_int *pEyeScore,
                                     fm_int *pHeightmV);
+fm_status fm10000SerdesGetEyeHeightBatch(fm_int        sw,
+                                         fm_int        numSerdes,
+                                         const fm_int *serdesList,
+                                         fm_int       *pEyeScore,
+                                         fm_int       *pHeightmV,
+                                         fm_status    *pLaneErr);
 fm_status fm10000SerdesReadExt(fm_int     sw,
                                fm_int     serdes,
                                fm_uint    regAddr,
@@ -1596,6 +1655,14 @@ fm_status fm10000SerdesSavePCalTuningDelayInfo(fm_int       sw,
 fm_status fm10000SerdesSaveStopTuningDelayInfo(fm_int       sw,
                                                fm_int       serDes);
 fm_uint32 fm10000SerdesGetTimestampMs(void);
+fm_bool fm10000SerdesDfeSchedRequest(fm_int sw, fm_int serDes);
+fm_bool fm10000SerdesDfeSchedTryGrant(fm_int sw, fm_int serDes);
+void fm10000SerdesDfeSchedCancel(fm_int sw, fm_int serDes);
+void fm10000SerdesDfeSchedRecordTuning(fm_int    sw,
+                                       fm_bool   pCal,
+                                       fm_uint32 durationMs);
+fm_int fm10000SerdesDfeSchedGetMaxCycles(fm_int sw, fm_bool pCal);
+fm_status fm10000DbgDumpDfeSched(fm_int sw);
 fm_bool fm10000SerdesGetTimestampDiffMs(fm_uint32  start,
                                         fm_uint32  stop,
                                         fm_uint32 *pDiff);
@@ -1636,10 +1703,11 @@ fm_status fm10000SerdesSetupKrConfigClause84(fm_int     sw,
 fm_status fm10000SerdesSetupKrConfig(fm_int       sw,
                                      fm_int       serDes,
                                      fm_bool     *pKrIsRunning);
-fm_status fm10000SerDesEventHandler( fm_int    sw,
-                                     fm_int    epl,
-                                     fm_int    lane,
-                                     fm_uint32 serDesIp );
+fm_status fm10000SerDesEventHandler( fm_int           sw,
+                                     fm_int           epl,
+                                     fm_int           lane,
+                                     fm_uint32        serDesIp,
+                                     fm_smEventBatch *batch );
 fm_status fm10000SerDesGetEyeHeightWidth(fm_int     sw,
                                          fm_int     serDes,
                                          fm_int     *pHeigth,
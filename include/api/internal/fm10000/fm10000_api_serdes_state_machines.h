@@ -109,6 +109,10 @@ typedef enum
 
 } fm10000_serdesSmEvents;
 
+/* Coalescing group of the signalOk indications, see
+ * fmSetStateMachineEventCoalesceGroup */
+#define FM10000_SERDES_COALESCE_SIGNALOK    0
+
 extern fm_text fm10000SerDesEventsMap[FM10000_SERDES_EVENT_MAX];
 
 /* declaration of external counterparts of action callbacks */
@@ -48,6 +48,10 @@
 #define FM10000_SFLOW_MAX_SAMPLE_RATE   0xffffff
 #define FM10000_SFLOW_TRAPCODE_ID_START 12
 
+/* Interval over which the CPU sample rate of an sFlow is measured before
+ * its sampling rate is adjusted to FM_SFLOW_MAX_CPU_RATE. */
+#define FM10000_SFLOW_RATE_INTERVAL_NSEC    1000000000ULL
+
 /**************************************************
  * Information related to an sFlow.
  **************************************************/
@@ -67,6 +71,26 @@ typedef struct _fm10000_sflowEntry
      * attribute. */
     fm_uint         sampleRate;
 
+    /* Sampling rate programmed in the mirror. Above sampleRate while the
+     * FM_SFLOW_MAX_CPU_RATE limit is being enforced. */
+    fm_uint         activeRate;
+
+    /* Number of bytes kept in ring samples, as specified by the
+     * FM_SFLOW_TRUNC_LENGTH attribute. */
+    fm_int          truncLength;
+
+    /* Samples per second allowed by the FM_SFLOW_MAX_CPU_RATE attribute,
+     * 0 if unlimited. */
+    fm_uint         maxCpuRate;
+
+    /* Number of samples received through the sample ring path. */
+    fm_uint64       sampleCount;
+
+    /* sampleCount and time, in nanoseconds, of the last check of the
+     * CPU sample rate. */
+    fm_uint64       rateCheckCount;
+    fm_uint64       rateCheckTime;
+
     /* Whether this sFlow is valid. */
     fm_bool         isValid;
 
@@ -121,6 +145,12 @@ fm_status fm10000CheckSFlowLogging(fm_int            sw,
                                    fm_eventPktRecv *pktEvent,
                                    fm_bool         *isPktSFlowLogged);
 
+fm_status fm10000DeliverSFlowSample(fm_int            sw,
+                                    fm_eventPktRecv *pktEvent,
+                                    fm_bool         *isPktSFlowLogged);
+
+fm_status fm10000UpdateSFlowSampleRates(fm_int sw);
+
 fm_status fm10000GetSFlowType(fm_int         sw, 
                               fm_int         sFlowId,
                               fm_sFlowType * sFlowType);
@@ -35,6 +35,66 @@
 #ifndef __FM_FM10000_API_STATS_INT_H
 #define __FM_FM10000_API_STATS_INT_H
 
+/* Number of 32-bit EPL counters that the counter cache extends to 64 bits */
+#define FM10000_NUM_CACHED_EPL_COUNTERS     7
+
+/* Cached counters of a cardinal port. Written under the state lock and
+ * read without any lock: seq is odd while the snapshot is being written. */
+typedef struct _fm10000_portCounterSnapshot
+{
+    fm_uint32       seq;
+    fm_bool         valid;
+
+    /* Counters as returned to readers, timestamp included. */
+    fm_portCounters counters;
+
+    /* Last raw value and 64-bit total of each 32-bit EPL counter. */
+    fm_uint32       eplLast[FM10000_NUM_CACHED_EPL_COUNTERS];
+    fm_uint64       eplTotal[FM10000_NUM_CACHED_EPL_COUNTERS];
+
+} fm10000_portCounterSnapshot;
+
+
+/* Cached values of a VLAN counter, protected as the port snapshots. */
+typedef struct _fm10000_vlanCounterSnapshot
+{
+    fm_uint32       seq;
+    fm_bool         valid;
+
+    /* Time of the snapshot in microseconds. */
+    fm_uint64       timestamp;
+
+    fm_vlanCounters counters;
+
+} fm10000_vlanCounterSnapshot;
+
+
+/* Background counter cache of a switch. */
+typedef struct _fm10000_counterCache
+{
+    fm_int                        sw;
+
+    /* Refresh period in milliseconds, 0 when the cache is disabled. */
+    fm_uint32                     interval;
+
+    /* Oldest snapshot, in milliseconds, that readers are given. 0 makes
+     * readers always access the hardware. */
+    fm_uint32                     maxAge;
+
+    fm_timerHandle                timer;
+
+    /* Cardinal ports refreshed by the timer, and their snapshots indexed
+     * by cardinal port index. */
+    fm_int                        numPorts;
+    fm_int *                      portList;
+    fm_portCounters *             scratch;
+    fm10000_portCounterSnapshot * ports;
+
+    fm10000_vlanCounterSnapshot   vlans[FM10000_MAX_VLAN_COUNTER + 1];
+
+} fm10000_counterCache;
+
+
 fm_status fm10000ResetPortCounters(fm_int sw,
                                    fm_int port);
 
@@ -42,10 +102,24 @@ fm_status fm10000GetPortCounters(fm_int sw,
                                  fm_int port,
                                  fm_portCounters *counters);
 
+fm_status fm10000GetAllPortCounters(fm_int           sw,
+                                    fm_int *         portList,
+                                    fm_int           numPorts,
+                                    fm_portCounters *counters);
+
 fm_status fm10000GetVLANCounters(fm_int sw,
                                  fm_int vcid,
                                  fm_vlanCounters *counters);
 
+fm_status fm10000GetVLANCountersList(fm_int           sw,
+                                     fm_int           numCounters,
+                                     fm_int *         vcidList,
+                                     fm_vlanCounters *counters);
+
+fm_status fm10000ReadVLANCounters(fm_int           sw,
+                                  fm_int           vcid,
+                                  fm_vlanCounters *counters);
+
 fm_status fm10000ResetVLANCounters(fm_int sw,
                                    fm_int vcid);
 
@@ -57,6 +131,34 @@ fm_status fm10000SetStatsFrameAdjustment(fm_int sw,
                                          fm_int physPort,
                                          fm_int nbBytes);
 
+fm_status fm10000SetCounterCacheInterval(fm_int sw, fm_uint32 interval);
+
+fm_bool fm10000ReadCachedPortCounters(fm_int           sw,
+                                      fm_int           port,
+                                      fm_portCounters *counters);
+
+fm_status fm10000GetPortCountersSnapshot(fm_int           sw,
+                                         fm_int           port,
+                                         fm_portCounters *counters);
+
+void fm10000UpdateCachedPortCounters(fm_int           sw,
+                                     fm_int           port,
+                                     fm_portCounters *counters);
+
+void fm10000InvalidateCachedPortCounters(fm_int sw, fm_int port);
+
+fm_bool fm10000ReadCachedVLANCounters(fm_int           sw,
+                                      fm_int           vcid,
+                                      fm_vlanCounters *counters);
+
+void fm10000UpdateCachedVLANCounters(fm_int           sw,
+                                     fm_int           vcid,
+                                     fm_vlanCounters *counters);
+
+void fm10000InvalidateCachedVLANCounters(fm_int sw, fm_int vcid);
+
+void fm10000FreeCounterCache(fm_int sw);
+
 
 #endif	/* __FM_FM10000_API_STATS_INT_H */
 
@@ -68,6 +68,17 @@ typedef struct _fm10000_stormController
      * it can only be used in one storm controller. */
     fm_bool           macMoveViolCondUsed;
 
+    /* Nesting depth of ''fm10000BeginStormCtrlUpdate'' calls. While non-zero,
+     * condition and action changes are only recorded and the trigger is
+     * rewritten once by the outermost ''fm10000CommitStormCtrlUpdate''. */
+    fm_int            updateDepth;
+
+    /* The trigger condition must be reapplied at commit time. */
+    fm_bool           condPending;
+
+    /* The trigger action must be reapplied at commit time. */
+    fm_bool           actionPending;
+
 } fm10000_stormController;
 
 /* Structure that tracks all storm controllers */
@@ -159,6 +170,10 @@ fm_status fm10000GetStormCtrlActionNext(fm_int          sw,
                                         fm_stormAction *currentAction,
                                         fm_stormAction *nextAction);
 
+fm_status fm10000BeginStormCtrlUpdate(fm_int sw, fm_int stormController);
+
+fm_status fm10000CommitStormCtrlUpdate(fm_int sw, fm_int stormController);
+
 void fm10000DbgDumpStormCtrl(fm_int sw, fm_int stormController);
 
 #endif /* __FM_FM10000_API_STORM_INT_H */
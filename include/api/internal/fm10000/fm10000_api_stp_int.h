@@ -64,6 +64,11 @@ fm_status fm10000RefreshSpanningTree(fm_int sw,
                                      fm_int vlan,
                                      fm_int port);
 
+fm_status fm10000RefreshSpanningTreePortList(fm_int              sw,
+                                             fm_stpInstanceInfo *instance,
+                                             fm_int              numPorts,
+                                             fm_int *            portList);
+
 fm_status fm10000ResetVlanSpanningTreeState(fm_int sw,
                                             fm_uint16
                                             vlanID);
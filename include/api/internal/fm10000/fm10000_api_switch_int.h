@@ -59,6 +59,9 @@ typedef struct _fm10000_switch
     /* holds ownership information for the FFU */
     fm_fm10000FfuOwnershipInfo  ffuOwnershipInfo;
 
+    /* FFU rule writes queued by fm10000StartFFUWriteQueue */
+    fm_fm10000FfuWriteQueue     ffuWriteQueue;
+
     /* holds ownership information for the Policer */
     fm_fm10000PolOwnershipInfo  polOwnershipInfo;
 
@@ -171,6 +174,11 @@ typedef struct _fm10000_switch
      ***************************************************/
     fm10000_serdes              serdesXServices;
 
+    /***************************************************
+     * DFE tuning scheduler (concurrency and timeouts)
+     **************************************************/
+    fm10000_dfeSched            dfeSched;
+
     /***************************************************
      * Information regarding the trigger API
      **************************************************/
@@ -210,6 +218,22 @@ typedef struct _fm10000_switch
     /* Maximum number of TCN FIFO entries to process in a cycle. */
     fm_int                      tcnFifoBurstSize;
 
+    /* Whether to drain the TCN FIFO with multi-word burst reads. */
+    fm_bool                     tcnBurstRead;
+
+    /* Statistics on the passes over the TCN FIFO. */
+    fm10000_tcnBurstStats       tcnBurstStats;
+
+    /* Learning rate limiter for the TCN FIFO. */
+    fm10000_learnLimiter        learnLimiter;
+
+    /* MA Table occupancy and collision statistics, protected by the L2
+     * lock. */
+    fm_macTableStats            maTableStats;
+
+    /* Whether the MA Table occupancy warning has been logged. */
+    fm_bool                     maOccupancyWarned;
+
     /* Current state of MA_USED_TABLE sweeper. */
     fm_int                      usedTableSweeperState;
 
@@ -264,6 +288,11 @@ typedef struct _fm10000_switch
      **************************************************/
     fm10000_flowInfo            flowInfo;
 
+    /**************************************************
+     * Background counter cache.
+     **************************************************/
+    fm10000_counterCache        counterCache;
+
     /**************************************************
      * Information related to the SFlow API.
      **************************************************/
@@ -317,6 +346,14 @@ typedef struct _fm10000_switch
     /* The decapsulation ACL Number. */
     fm_int                      vnDecapAcl;
 
+    /* TRUE while VN provisioning is batched, see fmVNBatchBegin. */
+    fm_bool                     vnBatchOpen;
+
+    /* TRUE if the encapsulation/decapsulation ACL has rule changes that
+     * an open VN batch has not compiled yet. */
+    fm_bool                     vnEncapAclPending;
+    fm_bool                     vnDecapAclPending;
+
     /* Number of virtual networks in use. */
     fm_int                      numVirtualNetworks;
 
@@ -405,12 +442,42 @@ typedef struct _fm10000_switch
     /* Priority mapper mapSet list*/
     fm10000_priorityMapSet *    priorityMapSet;
 
+    /* Watermark configuration last written by the automatic watermark
+     * computation, used to skip unchanged registers on recompute. */
+    fm10000_wmParam *           appliedWm;
+
+    /* TRUE if appliedWm matches the chip watermark registers */
+    fm_bool                     appliedWmValid;
+
+    /* Nesting depth of open watermark update batches */
+    fm_int                      wmBatchDepth;
+
+    /* TRUE if a watermark recompute was deferred by an open batch */
+    fm_bool                     wmRecomputePending;
+
+    /* defaultMaps argument of the deferred recompute */
+    fm_bool                     wmPendingDefaultMaps;
+
     /**************************************************
      * Information related to Generic Receive.
      **************************************************/
     /* Drop frames received by user part on unknown port */
     fm_bool                     dropPacketUnknownPort;
 
+    /**************************************************
+     * Information related to port initialization.
+     **************************************************/
+    /* TRUE while fm10000InitPortTable defers the ethernet port binding */
+    fm_bool                     deferEplPortInit;
+
+    /* Worker threads binding the ethernet ports, one EPL at a time */
+    fm_thread                   portInitThreads[FM10000_NUM_EPLS];
+
+    /**************************************************
+     * Information related to the ACL compiler.
+     **************************************************/
+    /* Worker threads selecting the keys of the ingress ACLs */
+    fm_thread                   aclCompileThreads[FM10000_MAX_ACL_COMPILE_THREADS];
 
 } fm10000_switch;
 
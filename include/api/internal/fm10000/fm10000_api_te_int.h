@@ -1834,6 +1834,25 @@ fm_status fm10000GetTeFlowUsed(fm_int   sw,
 fm_status fm10000ResetTeFlowUsed(fm_int  sw,
                                  fm_int  te);
 
+fm_status fm10000GetTeFlowCntRange(fm_int     sw,
+                                   fm_int     te,
+                                   fm_int     firstIndex,
+                                   fm_int     numEntries,
+                                   fm_uint64 *frameCnt,
+                                   fm_uint64 *byteCnt);
+
+fm_status fm10000GetTeFlowUsedRange(fm_int     sw,
+                                    fm_int     te,
+                                    fm_int     firstWord,
+                                    fm_int     numWords,
+                                    fm_uint64 *usedWords);
+
+fm_status fm10000ResetTeFlowUsedRange(fm_int     sw,
+                                      fm_int     te,
+                                      fm_int     firstWord,
+                                      fm_int     numWords,
+                                      fm_uint64 *usedWords);
+
 fm_status fm10000SetTeLookup(fm_int              sw,
                              fm_int              te,
                              fm_int              index,
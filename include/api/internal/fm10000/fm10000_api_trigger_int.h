@@ -357,6 +357,12 @@ typedef struct _fm10000_triggerInfo
 {
     /* The number of used trigger entries in HW */
     fm_int numUsedTriggers;
+
+    /* Trigger entry occupying each HW index, NULL if the index is free.
+     * Triggers are kept in tree order in HW but not necessarily packed;
+     * free indexes between them have MatchByPrecedence set so that they
+     * never split a precedence group. */
+    fm10000_triggerEntry *slotEntry[FM10000_MAX_HW_TRIGGERS];
     
     /******************************************************************* 
      * Trigger resources.
@@ -484,6 +490,13 @@ fm_status fm10000CreateTrigger(fm_int  sw,
                                fm_bool isInternal, 
                                fm_text name);
 
+fm_status fm10000CreateTriggerList(fm_int   sw,
+                                   fm_int   numTriggers,
+                                   fm_int * groupList,
+                                   fm_int * ruleList,
+                                   fm_bool  isInternal,
+                                   fm_text *nameList);
+
 fm_status fm10000DeleteTrigger(fm_int  sw, 
                                fm_int  group, 
                                fm_int  rule, 
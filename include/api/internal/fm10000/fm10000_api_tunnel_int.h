@@ -56,6 +56,11 @@
 /* Limit the number of teData entry per bin on hash lookup */
 #define FM10000_TUNNEL_MAX_TE_DATA_BIN_SIZE     FM10000_TE_MAX_DATA_BIN_SIZE
 
+/* Largest block a single TE_LOOKUP entry can refer to, in TE_DATA entries */
+#define FM10000_TUNNEL_MAX_TE_LOOKUP_LENGTH                                   \
+    ( (1 << (FM10000_TE_LOOKUP_h_DataLength -                                 \
+             FM10000_TE_LOOKUP_l_DataLength + 1)) - 1 )
+
 /* Initial TeData swap size that also refer to the minimum value */
 #define FM10000_TUNNEL_TE_DATA_MIN_SWAP_SIZE    20
 
@@ -70,6 +75,16 @@
  * the table */
 #define FM10000_TUNNEL_TE_DATA_MIN_FREE_SIZE   (FM10000_TE_DATA_ENTRIES_0 / 100)
 
+/* Period of the background teData compaction, in milliseconds */
+#define FM10000_TUNNEL_TE_DATA_COMPACT_PERIOD     1000
+
+/* Fragmentation percentage of the free teData entries from which the
+ * background compaction starts moving blocks */
+#define FM10000_TUNNEL_TE_DATA_COMPACT_THRESHOLD  25
+
+/* Maximum number of teData blocks moved per TE on each compaction period */
+#define FM10000_TUNNEL_TE_DATA_COMPACT_MOVES      16
+
 typedef struct _fm_fm10000TunnelLookupBin
 {
     /**  teData location of that bin */
@@ -210,12 +225,16 @@ typedef struct _fm_fm10000TunnelTeDataBlockCtrl
  *****************************************************************************/
 typedef struct _fm_fm10000TunnelTeDataCtrl
 {
-    /** teData handler used to map hardware index to block control. */
-    fm_uint16              teDataHandler[FM10000_TE_DATA_ENTRIES_0];
+    /** teData handler used to map hardware index to block control, an
+     *  array of FM10000_TE_DATA_ENTRIES_0 entries. Allocated along with
+     *  teDataBlkCtrl on the first teData block search of the TE, NULL
+     *  until then. */
+    fm_uint16             *teDataHandler;
 
     /** block control table that refer to dynamically allocated entry that
-     *  specify the owner and chain property of any block. */
-    fm_fm10000TunnelTeDataBlockCtrl *teDataBlkCtrl[FM10000_TE_DATA_ENTRIES_0];
+     *  specify the owner and chain property of any block, an array of
+     *  FM10000_TE_DATA_ENTRIES_0 entries. */
+    fm_fm10000TunnelTeDataBlockCtrl **teDataBlkCtrl;
 
     /** number of free entries in teDataHandler[] table */
     fm_int                 teDataFreeEntryCount;
@@ -230,9 +249,79 @@ typedef struct _fm_fm10000TunnelTeDataCtrl
     /** index of the last allocated position in the teDataBlkCtrl[] table */
     fm_uint                lastTeDataBlkCtrlIndex;
 
+    /** number of defrags run because no free block was large enough */
+    fm_uint64              defragCount;
+
+    /** number of blocks moved by the background compaction */
+    fm_uint64              compactMoveCount;
+
+    /** number of block searches that failed for lack of free entries */
+    fm_uint64              allocFailCount;
+
+    /** number of hash bin blocks rebuilt at a new location and swapped in
+     *  by a rule add, update or delete */
+    fm_uint64              binRewriteCount;
+
+    /** number of rule adds or updates rejected because the hash bin block
+     *  would exceed what a single lookup entry can refer to */
+    fm_uint64              binFullCount;
+
 } fm_fm10000TunnelTeDataCtrl;
 
 
+/*****************************************************************************
+ *
+ *  TeData Table Statistics
+ *
+ *  This structure reports the occupancy and fragmentation of the TeData
+ *  table of a TE, see ''fm10000GetTeDataStats''.
+ *
+ *****************************************************************************/
+typedef struct _fm_fm10000TeDataStats
+{
+    /** number of entries used by teData blocks */
+    fm_int                 usedEntries;
+
+    /** number of teData blocks */
+    fm_int                 usedBlocks;
+
+    /** number of free entries, excluding the swap area */
+    fm_int                 freeEntries;
+
+    /** number of runs of consecutive free entries */
+    fm_int                 freeExtents;
+
+    /** size of the largest run of consecutive free entries */
+    fm_int                 largestFreeExtent;
+
+    /** size of the swap area at the end of the table */
+    fm_int                 swapSize;
+
+    /** percentage of free entries outside the largest free run */
+    fm_int                 fragmentation;
+
+    /** number of hash bins over all hash lookup groups of the TE */
+    fm_int                 hashBins;
+
+    /** number of hash bins holding at least one rule */
+    fm_int                 usedHashBins;
+
+    /** number of rules in the hash lookup groups */
+    fm_int                 hashRules;
+
+    /** size of the largest hash bin block, in TE_DATA entries */
+    fm_int                 maxBinLength;
+
+    /** copies of the teData control counters */
+    fm_uint64              defragCount;
+    fm_uint64              compactMoveCount;
+    fm_uint64              allocFailCount;
+    fm_uint64              binRewriteCount;
+    fm_uint64              binFullCount;
+
+} fm_fm10000TeDataStats;
+
+
 typedef struct _fm_fm10000TunnelCfg
 {
     /**  Tunnel Group */
@@ -251,6 +340,13 @@ typedef struct _fm_fm10000TunnelCfg
     /**  The tunnel engine's protocol mode */
     fm_teMode                  tunnelMode[FM10000_NUM_TE];
 
+    /**  Thread whose TE register writes are batched, NULL if none */
+    void *                     writeBatchOwner;
+
+    /**  Timer of the background teData compaction, NULL until the first
+     *   teData block search */
+    fm_timerHandle             compactTimer;
+
 } fm_fm10000TunnelCfg;
 
 
@@ -260,6 +356,8 @@ typedef struct _fm_fm10000TunnelCfg
 
 fm_status fm10000TunnelInit(fm_int sw);
 fm_status fm10000TunnelFree(fm_int sw);
+fm_status fm10000TunnelBeginWriteBatch(fm_int sw);
+fm_status fm10000TunnelEndWriteBatch(fm_int sw);
 fm_status fm10000CreateTunnel(fm_int          sw,
                               fm_int *        group,
                               fm_tunnelParam *tunnelParam);
@@ -347,6 +445,12 @@ fm_status fm10000GetTunnelRuleCount(fm_int             sw,
                                     fm_int             group,
                                     fm_int             rule,
                                     fm_tunnelCounters *counters);
+fm_status fm10000GetTunnelRuleCountList(fm_int     sw,
+                                        fm_int     group,
+                                        fm_int     numRules,
+                                        fm_int *   rules,
+                                        fm_uint64 *frameCnt,
+                                        fm_bool *  valid);
 fm_status fm10000GetTunnelEncapFlowCount(fm_int             sw,
                                          fm_int             group,
                                          fm_int             encapFlow,
@@ -380,6 +484,9 @@ fm_status fm10000GetTunnelApiAttribute(fm_int sw,
                                        fm_int attr,
                                        void * value);
 
+fm_status fm10000GetTeDataStats(fm_int                 sw,
+                                fm_int                 te,
+                                fm_fm10000TeDataStats *stats);
 fm_status fm10000DbgDumpTunnel(fm_int sw);
 
  
@@ -113,6 +113,17 @@ fm_status fm10000DeleteVlanPortList(fm_int    sw,
                                     fm_uint16 vlanID,
                                     fm_int    numPorts,
                                     fm_int *  portList);
+fm_status fm10000AddVlanRangePortList(fm_int    sw,
+                                      fm_uint16 firstVlanID,
+                                      fm_uint16 lastVlanID,
+                                      fm_int    numPorts,
+                                      fm_int *  portList,
+                                      fm_bool   tag);
+fm_status fm10000DeleteVlanRangePortList(fm_int    sw,
+                                         fm_uint16 firstVlanID,
+                                         fm_uint16 lastVlanID,
+                                         fm_int    numPorts,
+                                         fm_int *  portList);
 fm_status fm10000GetVlanAttribute(fm_int    sw,
                                   fm_uint16 vlanID,
                                   fm_int    attr,
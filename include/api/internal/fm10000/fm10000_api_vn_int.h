@@ -427,6 +427,8 @@ fm_status fm10000GetVNVsiNext(fm_int    sw,
 fm_status fm10000IsVNTunnelInUseByACLs(fm_int   sw,
                                        fm_int   tunnelId,
                                        fm_bool *inUse);
+fm_status fm10000BeginVNBatch(fm_int sw);
+fm_status fm10000CommitVNBatch(fm_int sw);
 fm_status fm10000FreeVNResources(fm_int sw);
 fm_status fm10000DbgDumpVN(fm_int sw);
 fm_status fm10000DbgDumpVirtualNetwork(fm_int sw,
@@ -209,6 +209,11 @@ typedef struct
     /* maps mapper key to a mapper entry */
     fm_tree mappers;
 
+    /* TRUE if ACL attributes or port associations changed since the last
+     * disruptive apply. Unlike rules, these changes are not tracked per
+     * ACL, so they prevent incremental compilation. */
+    fm_bool layoutChanged;
+
 } fm_aclInfo;
 
 
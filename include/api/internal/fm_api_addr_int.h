@@ -274,6 +274,119 @@ typedef struct _fm_internalMacAddrEntry
 typedef fm_internalMacAddrEntry fm_internal_mac_addr_entry;
 
 
+/* Marks the end of a MA table index list. */
+#define FM_MA_INDEX_NONE                0xFFFF
+
+/* Number of slots of the aging wheel of the MA table index. */
+#define FM_MA_AGE_WHEEL_SLOTS           256
+
+
+/* Links of one MA table entry in the secondary indexes. */
+typedef struct _fm_maIndexLink
+{
+    /* Neighbours in the list of the entry's logical port. */
+    fm_uint16 portNext;
+    fm_uint16 portPrev;
+
+    /* Neighbours in the list of the entry's FID. */
+    fm_uint16 vlanNext;
+    fm_uint16 vlanPrev;
+
+    /* Logical port and FID the entry is listed under. */
+    fm_uint16 port;
+    fm_uint16 vlanID;
+
+    /* TRUE if the entry is in the index. */
+    fm_bool   linked;
+
+    /* Generation of the MA table at which the entry was last written. */
+    fm_uint64 generation;
+
+    /* Neighbours in the aging wheel slot of the entry. */
+    fm_uint16 ageNext;
+    fm_uint16 agePrev;
+
+    /* Aging wheel slot of the entry, FM_MA_INDEX_NONE if the entry is not
+     * on the wheel. */
+    fm_uint16 ageSlot;
+
+} fm_maIndexLink;
+
+
+/* Secondary indexes of the MA table cache, listing the valid entries of
+ * each logical port and FID so that flushes only visit the affected
+ * entries. Protected by the L2 lock, like the cache. */
+typedef struct _fm_maTableIndex
+{
+    /* One per MA table entry. */
+    fm_maIndexLink *links;
+
+    /* First entry of the list of each logical port, FM_MAX_LOGICAL_PORT + 1
+     * entries. */
+    fm_uint16 *     portHead;
+
+    /* First entry of the list of each FID. */
+    fm_uint16       vlanHead[FM_MAX_VLAN];
+
+    /* Number of valid entries. */
+    fm_int          numValid;
+
+    /* Number of valid entries whose port or FID is out of range of the
+     * lists. They are counted in numValid only. */
+    fm_int          numUnlisted;
+
+    /* Number of entries in the EXPIRED state. Every purge removes them,
+     * whatever port or FID it targets. */
+    fm_int          numExpired;
+
+    /* Incremented each time an entry is written to the cache. Never
+     * reset, so that paged readers can ask for the entries changed since
+     * a given generation. */
+    fm_uint64       generation;
+
+    /* Aging wheel: the YOUNG and OLD entries, bucketed by the time they
+     * were last hit, so that aging only visits the slots that are due.
+     * Slot N holds the entries whose agingCounter divided by ageSlotWidth
+     * is N, modulo FM_MA_AGE_WHEEL_SLOTS. */
+    fm_uint16       ageHead[FM_MA_AGE_WHEEL_SLOTS];
+
+    /* Aging timer ticks covered by one slot, 0 if the wheel is unused. */
+    fm_uint64       ageSlotWidth;
+
+    /* Last slot whose YOUNG entries have been made OLD, and last slot
+     * whose entries have been expired, counted from the epoch. */
+    fm_uint64       ageOldCursor;
+    fm_uint64       ageExpireCursor;
+
+} fm_maTableIndex;
+
+
+/* Bounded journal of the changes of the MA table cache, fed by the index
+ * link and unlink hooks. Protected by the L2 lock, like the cache. */
+typedef struct _fm_maJournal
+{
+    /* Ring of records, the record of sequence number N is at N % size. */
+    fm_macJournalEntry *records;
+
+    /* Number of records in the ring. */
+    fm_int              size;
+
+    /* Sequence number of the next record. Starts at 1 and is never
+     * reset. */
+    fm_uint64           nextSeq;
+
+    /* Oldest sequence number still readable. Raised past every record
+     * when the cache is reset, so that readers resynchronize. */
+    fm_uint64           oldestSeq;
+
+    /* Removal held back until the next link, so that an unlink followed by
+     * a link of the same MAC and FID is recorded as one change. */
+    fm_bool             pendingValid;
+    fm_macJournalEntry  pending;
+
+} fm_maJournal;
+
+
 /*****************************************************************************
  * Function prototypes.
  *****************************************************************************/
@@ -365,5 +478,47 @@ fm_status fmCommonFreeAddrTableCache(fm_switch *switchPtr);
 fm_status fmCommonDeleteAddressPre(fm_int sw, fm_macAddressEntry *entry);
 fm_status fmCommonDeleteAllAddresses(fm_int sw, fm_bool dynamicOnly);
 
+fm_status fmAllocAddrIndex(fm_switch *switchPtr);
+void fmFreeAddrIndex(fm_switch *switchPtr);
+void fmResetAddrIndex(fm_switch *switchPtr);
+void fmAddrIndexLink(fm_switch *switchPtr, fm_uint32 index);
+void fmAddrIndexUnlink(fm_switch *switchPtr, fm_uint32 index);
+void fmAddrIndexNoteExpired(fm_switch *switchPtr, fm_uint32 index);
+void fmAddrIndexNoteHit(fm_switch *switchPtr, fm_uint32 index);
+fm_bool fmAddrIndexHasAgeWheel(fm_switch *switchPtr);
+void fmAddrIndexSetAgeWheel(fm_switch *switchPtr,
+                            fm_uint64  slotWidth,
+                            fm_uint64  currentTime);
+fm_status fmAddrIndexGetAgeDue(fm_switch * switchPtr,
+                               fm_uint64   cutoffTime,
+                               fm_bool     forExpiry,
+                               fm_uint32 **indexes,
+                               fm_int *    numIndexes);
+fm_int fmAddrIndexCountValid(fm_switch *switchPtr);
+fm_uint64 fmAddrIndexGetGeneration(fm_switch *switchPtr);
+fm_bool fmAddrIndexChangedSince(fm_switch *switchPtr,
+                                fm_uint32  index,
+                                fm_uint64  generation);
+fm_bool fmAddrIndexReadEntry(fm_switch *              switchPtr,
+                             fm_uint32                index,
+                             fm_internalMacAddrEntry *entry);
+fm_status fmAddrIndexGetEntries(fm_switch * switchPtr,
+                                fm_int      port,
+                                fm_int      vlanID,
+                                fm_uint32 **indexes,
+                                fm_int *    numIndexes);
+
+fm_status fmAllocAddrJournal(fm_switch *switchPtr);
+void fmFreeAddrJournal(fm_switch *switchPtr);
+void fmResetAddrJournal(fm_switch *switchPtr);
+void fmAddrJournalNoteLink(fm_switch *switchPtr, fm_uint32 index);
+void fmAddrJournalNoteUnlink(fm_switch *switchPtr, fm_uint32 index);
+fm_uint64 fmAddrJournalGetSequence(fm_switch *switchPtr);
+fm_status fmAddrJournalRead(fm_switch *         switchPtr,
+                            fm_uint64           sinceSequence,
+                            fm_int *            nEntries,
+                            fm_macJournalEntry *entries,
+                            fm_int              maxEntries);
+
 
 #endif /* __FM_FM_API_ADDR_INT_H */
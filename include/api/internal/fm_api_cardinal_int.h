@@ -41,6 +41,13 @@
 
 #define DEFINE_CARDINAL_PORT_MACROS 1
 
+/* Fast-path state flags kept per cardinal port in
+ * fm_cardinalPortInfo.portFlags. */
+#define FM_CARDINAL_PORT_LINK_UP        (1 << 0)
+#define FM_CARDINAL_PORT_ADMIN_DOWN     (1 << 1)
+#define FM_CARDINAL_PORT_FORCE_UP       (1 << 2)
+#define FM_CARDINAL_PORT_DRAINING       (1 << 3)
+
 
 /*****************************************************************************
  * Types
@@ -96,6 +103,56 @@ typedef struct
      */ 
     fm_int              maxLogicalPort;
 
+    /**
+     * Physical port index table.
+     *
+     * Index is a physical port number in the range 0..FM_PORTMASK_NUM_BITS-1.
+     * Value is the cardinal port index of the specified physical port,
+     * or -1 if the physical port is not mapped. Lets port mask conversions
+     * walk only the bits that are set instead of every cardinal port.
+     */
+    fm_int              physIndexTable[FM_PORTMASK_NUM_BITS];
+
+    /**
+     * TRUE if every cardinal port index equals its physical port number,
+     * in which case logical and physical port masks are identical.
+     */
+    fm_bool             identityMap;
+
+    /**
+     * Cardinal port mask of the ports that are link-up or are management
+     * ports. Maintained by ''fmUpdateCardinalPortState'' whenever a
+     * port's linkUp state changes.
+     */
+    fm_portmask         linkUpMask;
+
+    /**
+     * Fast-path port state flags (FM_CARDINAL_PORT_xxx).
+     *
+     * Index is the cardinal port index. One byte per port, so that loops
+     * over every cardinal port (port mask and flooding updates) read a
+     * few cache lines instead of each port's fm_port and extension
+     * structures. The flags mirror fields of those structures and are
+     * maintained by ''fmUpdateCardinalPortState'' and
+     * ''fmSetCardinalPortFlag''.
+     */
+    fm_byte             portFlags[FM_PORTMASK_NUM_BITS];
+
+    /**
+     * Cardinal port mask of the ports whose link state changed since the
+     * hardware source masks were last rewritten. Filled by
+     * ''fmDeferSwitchPortMaskUpdate'' and drained by
+     * ''fmFlushSwitchPortMaskUpdates''. Protected by the port attribute
+     * lock.
+     */
+    fm_portmask         pendingMaskUpdate;
+
+    /**
+     * Monotonic time, in nanoseconds, at which the oldest update in
+     * pendingMaskUpdate was deferred.
+     */
+    fm_uint64           pendingMaskNsec;
+
 } fm_cardinalPortInfo;
 
 
@@ -113,6 +170,13 @@ fm_status fmDbgDumpCardinalPorts(fm_int sw);
 
 fm_status fmFreeCardinalPortDataStructures(fm_switch * switchPtr);
 
+void fmUpdateCardinalPortState(fm_switch * switchPtr, fm_int port);
+
+void fmSetCardinalPortFlag(fm_switch * switchPtr,
+                           fm_int      port,
+                           fm_byte     flag,
+                           fm_bool     enable);
+
 int fmCompareCardinalPorts(const void * aPtr, const void * bPtr);
 
 /* BitArray functions */
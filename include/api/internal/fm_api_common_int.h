@@ -65,6 +65,9 @@ typedef struct _fm_lag       fm_lag;
 /* pointer to stack event handler */
 extern fm_eventHandler fmEventHandler;
 
+/* pointer to stack event batch handler */
+extern fm_eventBatchHandler fmEventBatchHandler;
+
 
 #define FID_OUT_OF_BOUNDS(f)   ( (f) >= FM_MAX_VLAN )
 
@@ -76,14 +79,29 @@ extern fm_eventHandler fmEventHandler;
     ( ( ( (sw) >= 0 ) && ( (sw) < fmRootPlatform->cfg.numSwitches ) &&    \
        (fmRootApi->fmSwitchLockTable[sw] != NULL) ) ? TRUE : FALSE )
 
-#define PROTECT_SWITCH(sw) \
-    fmCaptureReadLock(fmRootApi->fmSwitchLockTable[sw], FM_WAIT_FOREVER)
-
-#define UNPROTECT_SWITCH(sw) \
-    fmReleaseReadLock(fmRootApi->fmSwitchLockTable[sw])
-
-#define LOCK_SWITCH(sw) \
-    fmCaptureWriteLock(fmRootApi->fmSwitchLockTable[sw], FM_WAIT_FOREVER)
+/* Within a profiled API call, the time taken to capture the switch lock
+ * is charged to the call as lock wait. */
+#define CAPTURE_SWITCH_READ_LOCK(sw)                                            \
+    ( FM_DBG_API_PROF_ACTIVE()                                                  \
+      ? fmDbgApiProfCaptureLock(fmRootApi->fmSwitchLockTable[sw], FALSE)        \
+      : fmCaptureReadLock(fmRootApi->fmSwitchLockTable[sw], FM_WAIT_FOREVER) )
+
+/* Register writes to a remote (FIBM slave) switch are batched for as long
+ * as the switch is protected. */
+#define PROTECT_SWITCH(sw)                                                      \
+    ( fmRootApi->isSwitchFibmSlave[sw]                                          \
+      ? fmFibmProtectSwitch(sw)                                                 \
+      : CAPTURE_SWITCH_READ_LOCK(sw) )
+
+#define UNPROTECT_SWITCH(sw)                                                    \
+    ( fmRootApi->isSwitchFibmSlave[sw]                                          \
+      ? fmFibmUnprotectSwitch(sw)                                               \
+      : fmReleaseReadLock(fmRootApi->fmSwitchLockTable[sw]) )
+
+#define LOCK_SWITCH(sw)                                                         \
+    ( FM_DBG_API_PROF_ACTIVE()                                                  \
+      ? fmDbgApiProfCaptureLock(fmRootApi->fmSwitchLockTable[sw], TRUE)         \
+      : fmCaptureWriteLock(fmRootApi->fmSwitchLockTable[sw], FM_WAIT_FOREVER) )
 
 #define UNLOCK_SWITCH(sw) \
     fmReleaseWriteLock(fmRootApi->fmSwitchLockTable[sw])
@@ -159,8 +177,33 @@ extern fm_eventHandler fmEventHandler;
     }                                      \
 
 
+/**************************************************
+ * A receive packet filter of a switch. The API
+ * writers serialize on the state lock and bracket
+ * their update with seq, which is odd meanwhile, so
+ * the packet receive task reads it without a lock.
+ **************************************************/
+typedef struct _fm_rxFilterEntry
+{
+    fm_uint32         seq;
+
+    fm_bool           valid;
+
+    fm_rxPacketFilter filter;
+
+    /* Number of frames that matched, counted by the receive task. */
+    fm_uint64         hits;
+
+} fm_rxFilterEntry;
+
+
 fm_macaddr fmGetPacketDestAddr(fm_int sw, fm_buffer *pkt);
 fm_macaddr fmGetPacketSrcAddr(fm_int sw, fm_buffer *pkt);
+fm_bool fmRxPacketFilterDrop(fm_int      sw,
+                             fm_buffer * pkt,
+                             fm_int      srcPort,
+                             fm_int      vlan,
+                             fm_int      trapCode);
 
 
 #endif /* __FM_FM_API_COMMON_INT_H */
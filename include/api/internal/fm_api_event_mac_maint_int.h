@@ -246,6 +246,9 @@ typedef struct _fm_maPurgeStats
      * to be executed. */
     fm_uint32   numCompletedWithMorePending;
 
+    /* Number of times a purge yielded after using up its slice budget. */
+    fm_uint32   numSlicesYielded;
+
     /* Number of port-specific entries on the purge list (i.e. not including 
      * the maPurgeGlobalListEntry) that were allocated. */
     fm_uint32   numEntriesAllocated;
@@ -410,6 +413,20 @@ typedef struct _fm_maPurge
     /* Indicates whether an FM_UPD_FLUSH_EXPIRED request is pending. */
     fm_bool                 flushExpired;
 
+    /* Number of MA Table entries to be examined by the active purge, or
+     * -1 if not yet determined. A purge is executed in slices bounded by
+     * the "api.ma.maintSliceEntries" and "api.ma.maintSliceTime" API
+     * attributes, and resumes at the cursor on the next maintenance
+     * pass. */
+    fm_int                  numScope;
+
+    /* MA Table indexes to be examined by the active purge, or NULL if it
+     * visits the whole table. */
+    fm_uint32 *             scope;
+
+    /* Position in the scope of the next entry to be examined. */
+    fm_int                  cursor;
+
 } fm_maPurge;
 
 
@@ -569,6 +586,10 @@ typedef enum
 
     FM_MAC_REASON_MEM_ERROR,
 
+    /* Generated when the learning rate limiter starts dropping new
+     * source addresses. */
+    FM_MAC_REASON_LEARN_THROTTLED,
+
 } fm_macReason;
 
 
@@ -733,6 +754,7 @@ fm_status fmIssueMacMaintRequest(fm_int         sw,
                                  fm_maWorkType  workType);
 
 void *fmTableMaintenanceHandler(void *args);
+void *fmSwitchTableMaintenanceHandler(void *args);
 
 fm_status fmFlushPortAddrInternal(fm_int              sw,
                                   fm_int              port,
@@ -37,26 +37,69 @@
 typedef struct _fm_localDelivery
 {
     /* each bit represents an event type-- set means deliver to this thread */
-    fm_uint32  mask;
+    fm_uint32      mask;
 
     /* thread that delivers events to its process */
-    fm_thread *thread;
+    fm_thread *    thread;
 
     /* the ID of the process that this thread is for */
-    fm_int     processId;
+    fm_int         processId;
+
+    /* whether filter applies */
+    fm_bool        filterEnabled;
+
+    /* refines mask, see fmSetProcessEventFilter */
+    fm_eventFilter filter;
 
 } fm_localDelivery;
 
 
+/* Immutable copy of the local delivery list, read by fmDistributeEvent
+ * without taking the local delivery lock. A new copy is published each
+ * time the list or a mask changes. */
+typedef struct _fm_localDeliverySnapshot
+{
+    /* next snapshot waiting to be freed, once replaced */
+    struct _fm_localDeliverySnapshot *nextRetired;
+
+    /* number of entries in delivery */
+    fm_uint                           count;
+
+    /* copy of each fm_localDelivery of the list */
+    fm_localDelivery                  delivery[];
+
+} fm_localDeliverySnapshot;
+
+
+/* Dispatch classes of the global event handler, each with its own queue.
+ * Port events are always dispatched first, the other classes in a
+ * weighted round robin. */
+typedef enum
+{
+    FM_EVENT_DISPATCH_LINK = 0,
+    FM_EVENT_DISPATCH_MAILBOX,
+    FM_EVENT_DISPATCH_TABLE_UPDATE,
+    FM_EVENT_DISPATCH_PACKET,
+    FM_EVENT_DISPATCH_OTHER,
+
+    /* Must be last */
+    FM_EVENT_DISPATCH_MAX
+
+} fm_eventDispatchClass;
+
+
 /* event handler for dispatching events to the stack */
 void *fmGlobalEventHandler(void *args);
 
+fm_eventDispatchClass fmGetEventDispatchClass(fm_int eventType);
+
 
 /* event handler for dispatching events to a particular process */
 void *fmLocalEventHandler(void *args);
 
 /* Receive Packet Thread */
 void *fmReceivePacketTask(void *args);
+void *fmSwitchReceivePacketTask(void *args);
 
 void *fmFastMaintenanceTask(void *args);
 
@@ -69,6 +112,13 @@ void fmDistributeEvent(fm_event *event);
 /* Remove event handler */
 fm_status fmRemoveEventHandler(fm_localDelivery ** delivery);
 
+/* Publish the local delivery list, called with the local delivery lock
+ * taken */
+fm_status fmPublishLocalDelivery(void);
+
+/* Post the events fmDistributeEvent staged for local delivery */
+void fmFlushDistributedEvents(void);
+
 /* Switch-Specific Event Handler */
 typedef void (*fm_switchEventHandler)(fm_event *event);
 
@@ -0,0 +1,93 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_api_fanout_int.h
+ * Creation Date:   October 15, 2026
+ * Description:     Parallel fan-out of an operation to several switches.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#ifndef __FM_FM_API_FANOUT_INT_H
+#define __FM_FM_API_FANOUT_INT_H
+
+
+/**************************************************
+ * Operation applied to one switch by
+ * ''fmFanOutToSwitches''. It runs on the worker
+ * thread of that switch and must take whatever
+ * switch locks it needs itself.
+ **************************************************/
+typedef fm_status (*fm_fanOutFunc)(fm_int sw, void *cookie);
+
+
+/**************************************************
+ * One operation queued to a switch worker.
+ **************************************************/
+typedef struct _fm_fanOutJob
+{
+    /* operation to run and its argument */
+    fm_fanOutFunc  func;
+    void *         cookie;
+
+    /* status returned by func */
+    fm_status      result;
+
+    /* signaled once func has returned */
+    fm_semaphore * doneSem;
+
+} fm_fanOutJob;
+
+
+/**************************************************
+ * Worker thread running the fanned-out operations
+ * of one switch, in the order they were queued.
+ **************************************************/
+typedef struct _fm_fanOutWorker
+{
+    /* switch served by this worker */
+    fm_int       sw;
+
+    /* FIFO of fm_fanOutJob pointers not yet run */
+    fm_dlist     jobs;
+
+    /* protects jobs */
+    fm_lock      jobLock;
+
+    /* counts the entries in jobs */
+    fm_semaphore requestSem;
+
+    fm_thread    thread;
+
+} fm_fanOutWorker;
+
+
+fm_status fmFanOutToSwitches(fm_int         numSwitches,
+                             const fm_int * swList,
+                             fm_fanOutFunc  apply,
+                             fm_fanOutFunc  undo,
+                             void *         cookie,
+                             fm_status *    results);
+
+#endif /* __FM_FM_API_FANOUT_INT_H */
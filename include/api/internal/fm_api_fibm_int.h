@@ -43,6 +43,11 @@
  * Note that a register read flushes the batch, so
  * these macros will not help accelerate alternating 
  * reads and writes.
+ *
+ * Writes made while the switch is protected are
+ * batched automatically (see PROTECT_SWITCH), so
+ * these macros are only needed by code that accesses
+ * a remote switch without protecting it.
  **************************************************/
     
 #define FM_BEGIN_FIBM_BATCH(sw, err, cat)                                   \
@@ -73,5 +78,7 @@ fm_bool fmFibmSlaveIsLogicalPortMgmt(fm_int sw, fm_int logicalPort);
 fm_int fmFibmSlaveGetMasterSwitch(fm_int slaveSw);
 
 fm_status fmFibmStartBatching(fm_int sw, fm_bool start);
+fm_status fmFibmProtectSwitch(fm_int sw);
+fm_status fmFibmUnprotectSwitch(fm_int sw);
 
 #endif /* __FM_FM_API_FIBM_INT_H */
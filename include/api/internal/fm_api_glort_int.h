@@ -170,6 +170,32 @@ typedef enum
 #define FM_GLORT_STATE_USED_BITS    \
         (FM_GLORT_STATE_IN_USE | FM_GLORT_STATE_FREE_PEND)
 
+/*******************************************************************
+ * Free-range indexes kept alongside the glortState array, one per
+ * kind of search done by fmFindFreeGlortRangeInt. A set bit marks a
+ * GloRT that the search must skip.
+ *******************************************************************/
+
+typedef enum
+{
+    /* Free, regardless of reservation. */
+    FM_GLORT_INDEX_FREE = 0,
+
+    /* Free and not reserved for the given type. */
+    FM_GLORT_INDEX_LAG,
+    FM_GLORT_INDEX_MCG,
+    FM_GLORT_INDEX_LBG,
+
+    /* Free and reserved for the given type. */
+    FM_GLORT_INDEX_RESV_LAG,
+    FM_GLORT_INDEX_RESV_MCG,
+    FM_GLORT_INDEX_RESV_LBG,
+
+    /* UPDATE THIS WHEN ADDING NEW INDEXES */
+    FM_GLORT_INDEX_MAX
+
+} fm_glortIndexType;
+
 /***************************************************
  * Utility macros.
  **************************************************/
@@ -61,9 +61,11 @@
 #include <api/internal/fm_api_acl_int.h>
 #include <api/internal/fm_api_mirror_int.h>
 #include <api/internal/fm_api_stat_int.h>
+#include <api/internal/fm_api_sflow_int.h>
 #include <api/internal/fm_api_vn_int.h>
 #include <api/internal/fm_api_flow_int.h>
 #include <api/internal/fm_api_mailbox_int.h>
+#include <api/internal/fm_api_fanout_int.h>
 
 /* Switch and port Generic Definitions */
 #include <api/internal/fm_api_switch_int.h>
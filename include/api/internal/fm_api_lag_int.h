@@ -193,6 +193,18 @@ typedef struct
      * lock. */
     fm_uint32  allowedPortTypes;
 
+    /* TRUE while a member port list is being applied. The LAG-wide
+     * hardware updates of each port change are then only recorded below
+     * and done once at the end by the FlushLagUpdates switch function. */
+    fm_bool    deferUpdates;
+
+    /* LAGs whose hardware tables must be rewritten at the end of the list. */
+    fm_bool    updatePending[FM_MAX_NUM_LAGS];
+
+    /* The glort destination table of all LAGs must be rewritten at the end
+     * of the list, because an internal port was added or removed. */
+    fm_bool    updateAllLags;
+
 } fm_lagInfo;
 
 
@@ -350,6 +350,9 @@ typedef struct
     fm_glortCamEntry *  camEntries;
     fm_int              numCamEntries;
 
+    /* No CAM entry below this index is unused */
+    fm_int              camFreeHint;
+
     /***************************************************
      * Manages the glort dest table.
      **************************************************/
@@ -370,6 +373,25 @@ typedef struct
      **************************************************/
     fm_byte             lportState[FM_MAX_LOGICAL_PORT+1];
 
+    /***************************************************
+     * Free-range indexes over glortState and lportState
+     * so that contiguous free blocks are found a word at
+     * a time. A set bit marks an entry that cannot be
+     * allocated. Only update them through the state
+     * macros.
+     **************************************************/
+    fm_bitArray         glortIndex[FM_GLORT_INDEX_MAX];
+    fm_bitArray         lportIndex;
+
+    /***************************************************
+     * Direct-mapped glort to logical port index, with
+     * FM_MAX_GLORT + 1 entries. Each entry holds the
+     * lowest logical port whose fm_port carries that
+     * glort, or -1. Kept in sync with portTable by
+     * fmAddGlortLogicalPort and fmRemoveGlortLogicalPort.
+     **************************************************/
+    fm_int *            glortToPort;
+
     fm_uint32           physicalPortCamIndex;
     fm_uint32           specialPortCamIndex;
     fm_uint32           cpuPortCamIndex;
@@ -417,23 +439,29 @@ typedef struct
  *******************************************************************/
 
 #define FM_RELEASE_LPORT(info, port)        \
-        (info)->lportState[port] = 0
+        fmSetLogicalPortState((info), (port), 0)
 
 #define FM_SET_LPORT_FREE(info, port)       \
-        (info)->lportState[port] &= ~(FM_LPORT_STATE_IN_USE | \
-                                      FM_LPORT_STATE_FREE_PEND)
+        fmSetLogicalPortState((info), (port), \
+                              (info)->lportState[port] &  \
+                              ~(FM_LPORT_STATE_IN_USE |   \
+                                FM_LPORT_STATE_FREE_PEND))
 
 #define FM_SET_LPORT_IN_USE(info, port)     \
-        (info)->lportState[port] |= FM_LPORT_STATE_IN_USE
+        fmSetLogicalPortState((info), (port), \
+                              (info)->lportState[port] | FM_LPORT_STATE_IN_USE)
 
 #define FM_RESERVE_LPORT_MCG(info, port)    \
-        (info)->lportState[port] |= FM_LPORT_STATE_RESV_MCG
+        fmSetLogicalPortState((info), (port), \
+                              (info)->lportState[port] | FM_LPORT_STATE_RESV_MCG)
 
 #define FM_RESERVE_LPORT_LAG(info, port)    \
-        (info)->lportState[port] |= FM_LPORT_STATE_RESV_LAG
+        fmSetLogicalPortState((info), (port), \
+                              (info)->lportState[port] | FM_LPORT_STATE_RESV_LAG)
 
 #define FM_RESERVE_LPORT_LBG(info, port)    \
-        (info)->lportState[port] |= FM_LPORT_STATE_RESV_LBG
+        fmSetLogicalPortState((info), (port), \
+                              (info)->lportState[port] | FM_LPORT_STATE_RESV_LBG)
 
 #define FM_IS_LPORT_RSVD_FOR_LBG(info, port) \
         (((info)->lportState[port] & FM_LPORT_STATE_RESV_LBG) != 0)
@@ -458,7 +486,8 @@ typedef struct
  * groups
  */
 #define FM_SET_LPORT_FREE_PEND(info, port)  \
-        (info)->lportState[port] |= FM_LPORT_STATE_FREE_PEND
+        fmSetLogicalPortState((info), (port), \
+                              (info)->lportState[port] | FM_LPORT_STATE_FREE_PEND)
 
 #define FM_IS_LPORT_FREE_PEND(info, port)   \
         (((info)->lportState[port] & FM_LPORT_STATE_FREE_PEND) != 0)
@@ -500,6 +529,8 @@ fm_status fmFreeLogicalPortForMailboxGlort(fm_int sw,
 
 fm_status fmGetLogicalPortGlort(fm_int sw, fm_int logicalPort, fm_uint32 *glort);
 fm_status fmGetGlortLogicalPort(fm_int sw, fm_uint32 glort, fm_int *logicalPort);
+void fmAddGlortLogicalPort(fm_switch *switchPtr, fm_int port);
+void fmRemoveGlortLogicalPort(fm_switch *switchPtr, fm_int port);
 fm_status fmGetLogicalPortRange(fm_int sw, fm_int *portRange);
 
 fm_bool fmIsLagPort(fm_int sw, fm_int port);
@@ -544,6 +575,7 @@ fm_lbgAllocEntry * fmFindLbgEntryByHandle(fm_int sw, fm_int handle);
 fm_mcgAllocEntry * fmFindMcgEntryByHandle(fm_int sw, fm_int handle);
 
 fm_int fmFindUnusedCamEntry(fm_int sw);
+void fmMarkCamEntryUnused(fm_int sw, fm_int camIndex);
 
 fm_int fmFindUnusedDestEntries(fm_int   sw,
                                fm_int   numEntries,
@@ -584,6 +616,9 @@ const char * fmSpecialPortToText(fm_int port);
 fm_status fmRemoveGlortCamEntry(fm_int sw, fm_uint32 camIndex);
 
 void fmResetLogicalPortInfo(fm_logicalPortInfo *lportInfo);
+void fmSetLogicalPortState(fm_logicalPortInfo *lportInfo,
+                           fm_int              port,
+                           fm_int              state);
 
 fm_status fmFreeMcastLogicalPort(fm_int sw, fm_int port);
 
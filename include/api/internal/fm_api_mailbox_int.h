@@ -1119,6 +1119,23 @@ typedef struct _fm_mailboxFlowTable
 
 } fm_mailboxFlowTable;
 
+/* Maximum number of mailbox worker threads (api.mailbox.workerThreads). */
+#define FM_MAX_MAILBOX_WORKERS                                     8
+
+/* Work queue of a mailbox worker thread. */
+typedef struct _fm_mailboxWorker
+{
+    /* Protects pendingPepMask. */
+    fm_lock lock;
+
+    /* Signaled when PEPs are queued to the worker. */
+    fm_semaphore wake;
+
+    /* Bitmask, per switch, of the PEPs waiting to be serviced. */
+    fm_uint32 pendingPepMask[FM_MAX_NUM_SWITCHES];
+
+} fm_mailboxWorker;
+
 /* Holds the state of mailbox related information. */
 typedef struct _fm_mailboxInfo
 {
@@ -1165,14 +1182,15 @@ typedef struct _fm_mailboxInfo
      * In SWAG configuration these number will be stored only by SWAG members. */
     fm_int *numberOfVirtualPortsAddedToBcastFlood;
 
-    /* Tree tracking resources used on host interface requests. */
-    fm_tree mailboxResourcesPerVirtualPort;
+    /* Map tracking resources used on host interface requests,
+     * keyed by logical port. */
+    fm_hashMap mailboxResourcesPerVirtualPort;
 
-    /* A tree holding default PVID value per GLORT related to virtual ports.
+    /* A map holding default PVID value per GLORT related to virtual ports.
      * This is to cache PVID values even if virtual ports are deleted as
      * host driver calls LPORT_DELETE/LPORT_CREATE during resets. 
      * After such reset we want to keep PVID values. */
-    fm_tree defaultPvidPerGlort;
+    fm_hashMap defaultPvidPerGlort;
 
     /* Indicates which acl rule are currently used or free. */
     fm_bitArray innOutMacRuleInUse;
@@ -1202,9 +1220,21 @@ typedef struct _fm_mailboxInfo
     /* Inner/Outer Mac filtering entries counter per PEP */
     fm_int *innerOuterMacEntriesAdded;
 
-    /* A tree tracking mcast MAC addresses and VNIs needed for 
+    /* A map tracking mcast MAC addresses and VNIs needed for 
      * FILTER_INNER_OUTER_MAC message. This will be used for inner mcast MACs. */
-    fm_customTree mcastMacVni;
+    fm_customHashMap mcastMacVni;
+
+    /* Set while the requests of several PEPs are processed as one batch
+     * (see ''api.FM10000.mailbox.batchRequests''). */
+    fm_bool batchActive;
+
+    /* The MAC filtering ACL changed during the batch and must be
+     * committed before the responses are signaled. */
+    fm_bool batchAclCommitPending;
+
+    /* Bitmask of the PEPs whose responses were written during the batch
+     * but not yet signaled to the host. */
+    fm_uint32 batchResponsePepMask;
 
 } fm_mailboxInfo;
 
@@ -1317,6 +1347,14 @@ fm_status fmMailboxInit(fm_int sw);
 
 fm_status fmMailboxFreeResources(fm_int sw);
 
+fm_status fmMailboxBeginBatch(fm_int sw);
+
+fm_status fmMailboxEndBatch(fm_int sw);
+
+fm_status fmMailboxStartWorkers(void);
+
+fm_status fmMailboxQueuePeps(fm_int sw, fm_uint32 pepMask);
+
 fm_status fmNotifyPvidUpdate(fm_int sw,
                              fm_int logicalPort,
                              fm_int pvid);
@@ -1340,6 +1378,10 @@ void fmFreeMailboxResources(void *value);
 
 void fmFreeMcastMacVni(void *key, void *value);
 
+fm_uint32 fmHashMcastMacVniKey(const void *key);
+
+fm_int fmCompareMcastMacVniKeys(const void *key1, const void *key2);
+
 void fmFreeSrvInnOutMac(void *key, void *value);
 
 fm_status fmSetMgmtPepXcastModes(fm_int sw, 
@@ -425,6 +425,8 @@ fm_status fmGetMcastGroupUsedInt(fm_int   sw,
 fm_int fmCompareMulticastAddresses(const void *key1,
                                    const void *key2);
 
+fm_uint32 fmHashMulticastAddress(const void *key);
+
 fm_status fmAddMcastGroupListenerInternal(fm_int                 sw,
                                           fm_int                 mcastGroup,
                                           fm_mcastGroupListener *listener);
@@ -469,4 +471,6 @@ fm_status fmUpdateMcastHNIFloodingGroups(fm_int  sw,
                                          fm_int  port,
                                          fm_bool state);
 
+fm_status fmFlushMcastHNIFloodingGroups(fm_int sw);
+
 #endif
@@ -254,6 +254,23 @@ typedef struct _fm_intEcmpGroup
 
     /** number of nextHops in fixed ECMP group */
     fm_int                        numFixedEntries;    
+
+    /* TRUE if the ECMP group is a resilient group. The group's next-hops
+     * are hash buckets, each one owned by one of the members below. */
+    fm_bool                       resilient;
+
+    /* Table of resilient group members, numFixedEntries long. */
+    fm_ecmpNextHop *              resilientMembers;
+
+    /* Number of buckets owned by each member. */
+    fm_int *                      resilientMemberBuckets;
+
+    /* Number of entries used in resilientMembers. */
+    fm_int                        resilientMemberCount;
+
+    /* Index of the member owning each bucket, -1 if none. */
+    fm_int *                      resilientBucketOwner;
+
 } fm_intEcmpGroup;
 
 
@@ -338,6 +355,14 @@ fm_status fmSetECMPGroupNextHopsInternal(fm_int          sw,
                                          fm_int          firstIndex,
                                          fm_int          numNextHops,
                                          fm_ecmpNextHop *nextHopList);
+fm_status fmAddResilientECMPGroupMembersInternal(fm_int          sw,
+                                                 fm_int          groupId,
+                                                 fm_int          numMembers,
+                                                 fm_ecmpNextHop *memberList);
+fm_status fmDeleteResilientECMPGroupMembersInternal(fm_int          sw,
+                                                    fm_int          groupId,
+                                                    fm_int          numMembers,
+                                                    fm_ecmpNextHop *memberList);
 
 fm_status fmGetECMPGroupNextHopListInternal(fm_int          sw,
                                             fm_int          groupId,
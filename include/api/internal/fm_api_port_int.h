@@ -404,12 +404,13 @@ typedef struct
 struct _fm_port
 {
     /**************************************************
-     * Port Identification and Capabilities
+     * Fast-path fields. These are read on every packet
+     * path and by loops over all ports, so they are
+     * kept together at the head of the structure where
+     * they share a single cache line. Configuration and
+     * state-machine data follows.
      **************************************************/
 
-    /* switch number, kept here for cross-referencing purposes */
-    fm_int                 switchNumber;
-
     /* port number */
     /* NOTE: For LAG member glort port, the port number
      * is changed to the physical port or remote port
@@ -418,21 +419,63 @@ struct _fm_port
      */
     fm_int                 portNumber;
 
-    /* port family */
-    fm_portFamily          portFamily;
-
     /* port type */
     fm_portType            portType;
 
-    /* port capabilities bit field */
-    fm_uint                capabilities;
+    /* The index of this port in the cardinal port map.
+     * Also used to index logical port bit masks and bit arrays.
+     * Will be >= 0 if this is a cardinal port (a logical port that 
+     * represents one of the switch's physical ports). 
+     * Will be -1 if this is not a cardinal port. */
+    fm_int                 portIndex;
 
-    /* pointer to the switch definition table */
-    fm_switch *            switchPtr;
+    /* Physical port number if this is a cardinal port. */
+    fm_int                 physicalPort;
+
+    /* Global resource tag for this port. */
+    fm_uint32              glort;
+
+    /* current link state whether up or down */
+    fm_bool                linkUp;
+
+    /* port state */
+    fm_int                 mode;
+    fm_int                 submode;
+
+    /* The index in the switch LAG table (fm_lagInfo.lag) of the 
+     * link aggregation group to which this port belongs.
+     * Will be >= 0 if this is a LAG port or a LAG member port.
+     * Will be -1 if the port is not associated with a LAG. */
+    fm_int                 lagIndex;
+
+    /* The index of this port in the member table (fm_lag.memberPorts) 
+     * of the link aggregation group to which this port belongs.
+     * Will be >= 0 if the port is a LAG member port.
+     * Will be -1 if it is not a LAG member port. */
+    fm_int                 memberIndex;
+
+    /* Indicate if the port must be forced up in the port mask */
+    fm_bool                isPortForceUp;
 
     /* pointer to additional port information specific to the port type */
     void *                 extension;
 
+    /* pointer to the switch definition table */
+    fm_switch *            switchPtr;
+
+    /**************************************************
+     * Port Identification and Capabilities
+     **************************************************/
+
+    /* switch number, kept here for cross-referencing purposes */
+    fm_int                 switchNumber;
+
+    /* port family */
+    fm_portFamily          portFamily;
+
+    /* port capabilities bit field */
+    fm_uint                capabilities;
+
     /* switch aggregate port number for this port, if its switch is in a
      * switch aggregate. -1 if not in a switch aggregate. */
     fm_int                 swagPort;
@@ -441,16 +484,6 @@ struct _fm_port
      * switch aggregate. */
     fm_swagLinkType        swagLinkType;
 
-    /* The index of this port in the cardinal port map.
-     * Also used to index logical port bit masks and bit arrays.
-     * Will be >= 0 if this is a cardinal port (a logical port that 
-     * represents one of the switch's physical ports). 
-     * Will be -1 if this is not a cardinal port. */
-    fm_int                 portIndex;
-
-    /* Physical port number if this is a cardinal port. */
-    fm_int                 physicalPort;
-
     /**************************************************
      * Glort table management fields. (FM4000/FM6000/FM10000)
      **************************************************/
@@ -469,9 +502,6 @@ struct _fm_port
      * but that is the compromise. */
     fm_int                  numDestEntries;
 
-    /* Global resource tag for this port. */
-    fm_uint32               glort;
-
     /* Number of logical ports to delete when port is freed. */
     fm_int                  freeCount;
 
@@ -479,25 +509,6 @@ struct _fm_port
      * Current Configuration
      **************************************************/
 
-    /* port state */
-    fm_int                 mode;
-    fm_int                 submode;
-
-    /* current link state whether up or down */
-    fm_bool                linkUp;
-
-    /* The index in the switch LAG table (fm_lagInfo.lag) of the 
-     * link aggregation group to which this port belongs.
-     * Will be >= 0 if this is a LAG port or a LAG member port.
-     * Will be -1 if the port is not associated with a LAG. */
-    fm_int                 lagIndex;
-
-    /* The index of this port in the member table (fm_lag.memberPorts) 
-     * of the link aggregation group to which this port belongs.
-     * Will be >= 0 if the port is a LAG member port.
-     * Will be -1 if it is not a LAG member port. */
-    fm_int                 memberIndex;
-
     /* phy interface table */
     fmPhyInterfaceTable    phyInfo;
 
@@ -528,10 +539,6 @@ struct _fm_port
     /* list of all multicast groups to which this port is listening */
     fm_tree                mcastGroupList;
 
-    /* Indicate if the port must be forced up in the port mask */
-
-    fm_bool                isPortForceUp;
-
     /* Structure used to cache all port attributes */
     fm_portAttr            attributes;
 
@@ -708,6 +715,9 @@ fm_status fmSetPortAttributeInternal(fm_int sw,
                                      fm_int attr,
                                      void * value);
 fm_status fmUpdateSwitchPortMasks(fm_int sw);
+fm_status fmUpdateSwitchPortMasksForPort(fm_int sw, fm_int port);
+fm_status fmDeferSwitchPortMaskUpdate(fm_int sw, fm_int port);
+fm_status fmFlushSwitchPortMaskUpdates(fm_int sw, fm_uint64 maxDelay);
 fm_status fmSetFaultState(fm_int  sw,
                           fm_int  port,
                           fm_bool enable);
@@ -146,6 +146,51 @@ typedef struct _fm_registerSGListEntry
 } fm_registerSGListEntry;
 
 
+/******************************************************************/
+/** Write statistics of a cached register set. Registers written
+ *  with useCache set that already hold the new value in the cache
+ *  are suppressed rather than written to the hardware.
+ ******************************************************************/
+typedef struct _fm_regCacheWriteStats
+{
+    /** pointer to the register set descriptor */
+    const fm_cachedRegs *registerSet;
+
+    /** number of registers written to the hardware */
+    fm_uint64            writesIssued;
+
+    /** number of registers not written because the cache matched */
+    fm_uint64            writesSuppressed;
+
+} fm_regCacheWriteStats;
+
+
+/******************************************************************/
+/** Running CRM checksum of a block of consecutive entries in the
+ *  register cache. The checksum is an XOR over the cached words, so
+ *  each write to the cache folds the difference between the old and
+ *  new words into it, see fmRegCacheGetChecksum.
+ ******************************************************************/
+typedef struct _fm_regCacheChecksum
+{
+    /** pointer to the register set descriptor */
+    const fm_cachedRegs *registerSet;
+
+    /** offset of the first word of the block in the cache */
+    fm_uint32            firstWord;
+
+    /** number of cache words in the block */
+    fm_uint32            numWords;
+
+    /** current checksum of the block */
+    fm_uint32            value;
+
+    /** next tracked block */
+    struct _fm_regCacheChecksum *next;
+
+} fm_regCacheChecksum;
+
+
 /******************************************************************/
 /** This enum is used by all methods that allow to read/write the
  *  keyValid local cache bit array. Each value  represents one of
@@ -390,6 +435,17 @@ fm_status fmRegCacheCopyKeyValid(fm_int               sw,
                                  fm_uint32           *fromIdx,
                                  fm_uint32           *toIdx);
 
+fm_status fmRegCacheWriteKeyValidRange(fm_int                        sw,
+                                       fm_int                        nEntries,
+                                       const fm_registerSGListEntry *sgList,
+                                       fm_int                        nKeyEntries,
+                                       const fm_regsCacheKeyValid *  keyValid,
+                                       const fm_bool *               validate,
+                                       fm_uint                       keyBit,
+                                       fm_uint                       keyInvertBit,
+                                       fm_bool                       hitless,
+                                       fm_bool                       useCache);
+
 fm_status fmRegCacheIsAddrRangeCached(fm_int     sw,
                                       fm_uint32  lowAddr,
                                       fm_uint32  hiAddr,
@@ -406,10 +462,26 @@ fm_status fmRegCacheComputeChecksum(fm_int                sw,
                                     fm_int                nEntries,
                                     fm_uint32 *           checksum);
 
+fm_status fmRegCacheGetChecksum(fm_int                sw,
+                                const fm_cachedRegs * regSet,
+                                const fm_uint32 *     indices,
+                                fm_int                nEntries,
+                                fm_uint32 *           checksum);
+
+void fmRegCacheInvalidateChecksums(fm_int sw, const fm_cachedRegs * regSet);
+
+fm_status fmRegCacheSaveSnapshot(fm_int sw, fm_text fileName);
+
+fm_status fmRegCacheRestoreSnapshot(fm_int sw, fm_text fileName);
+
 fm_status fmDbgDumpRegCacheEntry(fm_int                sw,
                                  const fm_cachedRegs * regSet,
                                  const fm_uint32 *     indices,
                                  fm_int                nEntries);
 
+fm_status fmDbgDumpRegCacheWriteStats(fm_int sw);
+
+fm_status fmDbgResetRegCacheWriteStats(fm_int sw);
+
 #endif /* __FM_FM_API_REGS_CACHE_INT_H */
 
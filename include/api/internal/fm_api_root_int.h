@@ -50,6 +50,28 @@ typedef enum
 
 } fm_TIBState;
 
+
+/* Tasks serving a single switch when api.perSwitchTasks is enabled */
+typedef struct _fm_switchTasks
+{
+    /* Switch served by the tasks */
+    fm_int              sw;
+
+    /* Interrupt-Processing Thread and its signaling semaphore */
+    fm_thread           interruptTask;
+    fm_semaphore        intrAvail;
+
+    /* MAC Table Maintenance Thread and its wake-up semaphore */
+    fm_thread           maintenanceTask;
+    fm_semaphore        macTableMaintSemaphore;
+
+    /* Packet reception Thread and its signaling semaphore */
+    fm_thread           packetReceiveTask;
+    fm_semaphore        packetReceiveSemaphore;
+
+} fm_switchTasks;
+
+
 typedef struct _fm_rootApi
 {
     /**************************************************
@@ -82,6 +104,10 @@ typedef struct _fm_rootApi
     /* flags to indicate remote switch */
     fm_bool             isSwitchFibmSlave[FM_MAX_NUM_SWITCHES];
 
+    /* number of callers holding each remote switch protected, and so
+     * sharing its automatic write batch */
+    fm_int              fibmBatchDepth[FM_MAX_NUM_SWITCHES];
+
     /* MAC Table Maintenance Thread */
     fm_thread           maintenanceTask;
 
@@ -109,6 +135,25 @@ typedef struct _fm_rootApi
     /* semaphore to wait on buffer shortage */
     fm_semaphore        waitForBufferSemaphore;
 
+    /* TRUE when the interrupt, MAC table maintenance and packet receive
+     * tasks run per switch, see api.perSwitchTasks */
+    fm_bool             perSwitchTasks;
+
+    /* Tasks of each switch, valid when perSwitchTasks is TRUE */
+    fm_switchTasks      switchTasks[FM_MAX_NUM_SWITCHES];
+
+    /**************************************************
+     * fm_api_mailbox.c
+     **************************************************/
+    /* Threads servicing the PCIe mailboxes, see api.mailbox.workerThreads */
+    fm_thread           mailboxWorkerTasks[FM_MAX_MAILBOX_WORKERS];
+
+    /* Work queues of the mailbox worker threads */
+    fm_mailboxWorker    mailboxWorkers[FM_MAX_MAILBOX_WORKERS];
+
+    /* Number of mailbox worker threads running */
+    fm_int              numMailboxWorkers;
+
     /**************************************************
      * fm_api_parity.c
      **************************************************/
@@ -133,12 +178,31 @@ typedef struct _fm_rootApi
     /**************************************************
      * fm_api_event_mgmt.c
      **************************************************/
-    /* the free event queue */
+    /* the free event queue of events able to hold a table update burst */
     fm_eventQueue       fmEventFreeQueue;
 
+    /* the free event queue of the other events */
+    fm_eventQueue       fmSmallEventFreeQueue;
+
+    /* backing memory of the events of each free queue */
+    fm_byte *           eventPool;
+    fm_byte *           smallEventPool;
+
+    /* number of free events of both sizes, including the events cached
+     * by threads */
+    fm_int              numFreeEvents;
+
+    /* number of free events of the smaller size, including the events
+     * cached by threads */
+    fm_int              numFreeSmallEvents;
+
     /* the semaphore used for throttling low priority events */
     fm_semaphore        fmLowPriorityEventSem;
 
+    /* times a low priority event allocation blocked, and timed out */
+    fm_uint64           lowPriorityEventBlocks;
+    fm_uint64           lowPriorityEventTimeouts;
+
     /**************************************************
      * fm_api_event_mac_maint.c
      **************************************************/
@@ -179,6 +243,21 @@ typedef struct _fm_rootApi
     /* lock for the above list and count */
     fm_lock             localDeliveryLock;
 
+    /* published copy of the above list, see fmPublishLocalDelivery */
+    fm_localDeliverySnapshot *localDeliverySnapshot;
+
+    /* replaced copies of the above list not yet freed */
+    fm_localDeliverySnapshot *localDeliveryRetired;
+
+    /**************************************************
+     * fm_api_fanout.c
+     **************************************************/
+    /* per-switch fan-out workers, created on first use */
+    fm_fanOutWorker *   fanOutWorkers[FM_MAX_NUM_SWITCHES];
+
+    /* protects the creation of the above workers */
+    fm_lock             fanOutLock;
+
     /* semaphore to start the global event handler thread */
     fm_semaphore        startGlobalEventHandler;
 
@@ -191,4 +270,20 @@ extern FM_GLOBAL_DECL fm_rootApi *fmRootApi;
 
 #define fmApiTimerTask &fmRootApi->timerTask
 
+/* Semaphores waking up the tasks serving a switch */
+#define FM_INTR_AVAIL_SEM(sw)                                           \
+    ( fmRootApi->perSwitchTasks ?                                       \
+          &fmRootApi->switchTasks[(sw)].intrAvail :                     \
+          &fmRootApi->intrAvail )
+
+#define FM_MAC_MAINT_SEM(sw)                                            \
+    ( fmRootApi->perSwitchTasks ?                                       \
+          &fmRootApi->switchTasks[(sw)].macTableMaintSemaphore :        \
+          &fmRootApi->macTableMaintSemaphore )
+
+#define FM_PKT_RECV_SEM(sw)                                             \
+    ( fmRootApi->perSwitchTasks ?                                       \
+          &fmRootApi->switchTasks[(sw)].packetReceiveSemaphore :        \
+          &fmRootApi->packetReceiveSemaphore )
+
 #endif /* __FM_FM_API_ROOT_INT_H */
@@ -56,22 +56,28 @@
  * Internal Route Entry
  *
  *****************************************************************************/
+/* One record is kept per route, so the layout matters at scale: the
+ * pointers are grouped so that no padding is needed between members, and
+ * rarely used data is held out of line. */
 typedef struct _fm_intRouteEntry
 {
     /* Pointer to the switch structure. */
     fm_switch *                   switchPtr;
 
-    /* State of this route. */
-    fm_routeState                 state;
+    /* Pointer to the destination IP address within the 'route' element below. */
+    fm_ipAddr *                   destIPAddress;
 
-    /* Action to be performed when this route hits. */
-    fm_routeAction                action;
+    /* Pointer to the multicast group if this route is a multicast route. NULL
+     * if the route is not a multicast route. */
+    struct _fm_intMulticastGroup *mcastGroup;
 
-    /* Route Contents. */
-    fm_routeEntry                 route;
+    /* Tree containing all Virtual Network tunnels using this route.
+     * Key is virtual network ID, value is pointer to VN tunnel record.
+     * Allocated when the first tunnel uses the route, NULL otherwise. */
+    fm_tree *                     vnTunnelsTree;
 
-    /* Pointer to the destination IP address within the 'route' element above. */
-    fm_ipAddr *                   destIPAddress;
+    /* State of this route. */
+    fm_routeState                 state;
 
     /* Prefix value. */
     fm_int                        prefix;
@@ -88,17 +94,79 @@ typedef struct _fm_intRouteEntry
      * real ECMP group id from here. */
     fm_int                        routeEcmpGroupId;
 
-    /* Pointer to the multicast group if this route is a multicast route. NULL
-     * if the route is not a multicast route. */
-    struct _fm_intMulticastGroup *mcastGroup;
+    /* Action to be performed when this route hits. */
+    fm_routeAction                action;
 
-    /* Tree containing all Virtual Network tunnels using this route.
-     * Key is virtual network ID, value is pointer to VN tunnel record. */
-    fm_tree                       vnTunnelsTree;
+    /* Route Contents. */
+    fm_routeEntry                 route;
 
 } fm_intRouteEntry;
 
 
+/*****************************************************************************
+ *
+ * Longest-Prefix-Match Index
+ *
+ * A multibit trie with a stride of 8 bits per virtual router and address
+ * family. Each node covers one byte of the address. A prefix ending
+ * within a node is expanded over the slots it covers, each slot keeping
+ * the longest such prefix, so that a lookup is one slot access per byte.
+ *
+ *****************************************************************************/
+
+/* Number of address bits consumed per trie level. */
+#define FM_ROUTE_LPM_STRIDE         8
+
+/* Number of slots in a trie node. */
+#define FM_ROUTE_LPM_NODE_SLOTS     (1 << FM_ROUTE_LPM_STRIDE)
+
+/* Maximum depth of the trie (IPv6). */
+#define FM_ROUTE_LPM_MAX_LEVELS                                     \
+    (FM_IPV6_MAX_PREFIX_LENGTH / FM_ROUTE_LPM_STRIDE)
+
+struct _fm_routeLpmNode;
+
+typedef struct _fm_routeLpmSlot
+{
+    /* Longest route ending within this node that covers the slot, NULL
+     * if there is none. */
+    fm_intRouteEntry *        route;
+
+    /* Prefix length of route. */
+    fm_int                    prefixLength;
+
+    /* Node for the next byte of the address, NULL if there is none. */
+    struct _fm_routeLpmNode * child;
+
+} fm_routeLpmSlot;
+
+typedef struct _fm_routeLpmNode
+{
+    fm_routeLpmSlot slots[FM_ROUTE_LPM_NODE_SLOTS];
+
+    /* Number of slots that hold a route or a child. */
+    fm_int          numUsed;
+
+} fm_routeLpmNode;
+
+typedef struct _fm_routeLpm
+{
+    /* Root nodes, indexed by virtual router offset and address family.
+     * The last virtual router is FM_ROUTER_ANY. */
+    fm_routeLpmNode **roots;
+
+    /* Number of entries in roots. */
+    fm_int            numRoots;
+
+    /* Number of nodes currently allocated. */
+    fm_int            numNodes;
+
+    /* Highest number of nodes allocated at any time. */
+    fm_int            peakNodes;
+
+} fm_routeLpm;
+
+
 /*****************************************************************************
  *
  * Internal Function Macros
@@ -143,6 +211,24 @@ fm_status fmGetIntRouteForIP(fm_int             sw,
                              fm_int             vrid,
                              fm_ipAddr *        ip,
                              fm_intRouteEntry **routePtrPtr);
+fm_status fmAllocRouteLpm(fm_int sw);
+void fmFreeRouteLpm(fm_int sw);
+void fmClearRouteLpm(fm_int sw);
+fm_status fmRouteLpmInsert(fm_int            sw,
+                           fm_int            vrid,
+                           fm_int            prefixLength,
+                           fm_intRouteEntry *route);
+void fmRouteLpmRemove(fm_int            sw,
+                      fm_int            vrid,
+                      fm_int            prefixLength,
+                      fm_intRouteEntry *route);
+fm_intRouteEntry *fmRouteLpmLookup(fm_int     sw,
+                                   fm_int     vrid,
+                                   fm_ipAddr *ip);
+void fmGetRouteLpmMemory(fm_int  sw,
+                         fm_int *numNodes,
+                         fm_int *peakNodes,
+                         fm_int *numBytes);
 fm_status fmValidateVirtualRouterId(fm_int  sw,
                                     fm_int  vrid,
                                     fm_int *vroffPtr);
@@ -0,0 +1,73 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_api_sflow_int.h
+ * Creation Date:   October 15, 2026
+ * Description:     Structures and functions for the sFlow sample ring.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef __FM_FM_API_SFLOW_INT_H
+#define __FM_FM_API_SFLOW_INT_H
+
+
+/**************************************************
+ * sFlow sample ring of a switch. The packet receive
+ * task is the only writer and advances head; readers
+ * claim samples by advancing tail with a
+ * compare-and-swap, so the ring needs no lock.
+ **************************************************/
+typedef struct _fm_sflowSampleRing
+{
+    /* Number of samples in the ring. */
+    fm_uint32        numSlots;
+
+    /* Number of samples ever written. */
+    fm_uint64        head;
+
+    /* Number of samples ever read. */
+    fm_uint64        tail;
+
+    /* Samples dropped because the ring was full, since the last read. */
+    fm_uint64        dropped;
+
+    fm_sFlowSample * slots;
+
+} fm_sflowSampleRing;
+
+
+fm_status fmSetSFlowSampleRingSize(fm_int sw, fm_uint32 numSlots);
+fm_uint32 fmGetSFlowSampleRingSize(fm_int sw);
+void fmFreeSFlowSampleRing(fm_int sw);
+fm_bool fmPushSFlowSample(fm_int            sw,
+                          fm_int            sFlowId,
+                          fm_uint           sampleRate,
+                          fm_int            truncLength,
+                          fm_eventPktRecv * pktEvent);
+
+
+#endif /* __FM_FM_API_SFLOW_INT_H */
@@ -36,6 +36,17 @@
 #define __FM_FM_API_STACKING_INT_H
 
 
+/***************************************************
+ * Key of a forwarding rule in fwdRulesByValue:
+ * the glort bits the rule cares about, their value
+ * and the rule ID, from most to least significant.
+ **************************************************/
+#define FM_FWD_RULE_INDEX_KEY(careMask, glort, ruleId)                  \
+    ( ( (fm_uint64) ( (careMask) & FM_MAX_GLORT ) << 48 ) |             \
+      ( (fm_uint64) ( (glort) & (careMask) & FM_MAX_GLORT ) << 32 ) |   \
+      (fm_uint64) (fm_uint32) (ruleId) )
+
+
 /***************************************************
  * The internal version of the forwarding rule
  * object, pointing at the specific CAM entry that
@@ -64,6 +75,16 @@ typedef struct _fm_stackingInfo
      **************************************************/
     fm_tree fwdRules;
 
+    /***************************************************
+     * Indexes the same rules by FM_FWD_RULE_INDEX_KEY,
+     * so that the rules matching a glort can be found
+     * without walking all of them.
+     **************************************************/
+    fm_tree fwdRulesByValue;
+
+    /* Number of rules using each care mask, keyed by care mask */
+    fm_tree fwdRuleMasks;
+
     /* Holds a list of used forwarding rule IDs */
     fm_bitArray usedRuleIDs;
 
@@ -71,6 +92,10 @@ typedef struct _fm_stackingInfo
 
 fm_status fmInitStacking(fm_int sw);
 fm_status fmFreeStackingResources(fm_int sw);
+fm_status fmFindForwardingRuleByGlort(fm_int                   sw,
+                                      fm_uint32                glort,
+                                      fm_int *                 ruleId,
+                                      fm_forwardRuleInternal **rule);
 fm_status fmFindForwardingRulePortByGlort(fm_int    sw, 
                                           fm_uint32 glort, 
                                           fm_int *  logicalPort);
@@ -219,5 +219,15 @@ fm_status fmAllocateCounterDataStructures(fm_switch *swState);
 fm_status fmInitCounters(fm_int sw);
 fm_status fmFreeCounterDataStructures(fm_switch *swState);
 
+fm_status fmSetTelemetryRingSize(fm_int sw, fm_uint32 numSlots);
+fm_uint32 fmGetTelemetryRingSize(fm_int sw);
+void fmSetTelemetryRingActive(fm_int sw, fm_bool active);
+void fmPushTelemetryRecord(fm_int       sw,
+                           fm_int       type,
+                           fm_int       id,
+                           fm_uint64    timestamp,
+                           const void * data,
+                           fm_uint32    size);
+
 
 #endif /* __FM_FM_API_STAT_INT_H */
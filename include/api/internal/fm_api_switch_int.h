@@ -136,6 +136,62 @@ typedef union
 } fm_islTag;
 
 
+/* A register write queued by a write batch */
+typedef struct
+{
+    fm_uint32   addr;
+    fm_uint32   value;
+
+} fm_regBatchWrite;
+
+
+/* State of the register write batch of a switch, see fmRegBatchBegin */
+typedef struct
+{
+    /* Thread that owns the batch, NULL when no batch is open */
+    void *              owner;
+
+    /* Number of nested fmRegBatchBegin calls made by the owner */
+    fm_int              depth;
+
+    /* Queued writes, one per register address, in arrival order */
+    fm_regBatchWrite *  writes;
+    fm_int              numWrites;
+    fm_int              maxWrites;
+
+    /* Maps a register address to its index + 1 in writes */
+    fm_hashMap          index;
+
+    /* Register access functions of the switch, saved while the batching
+     * functions are installed in their place */
+    fm_status (*WriteUINT32)(fm_int sw, fm_uint reg, fm_uint32 value);
+    fm_status (*ReadUINT32)(fm_int sw, fm_uint reg, fm_uint32 *value);
+    fm_status (*MaskUINT32)(fm_int    sw,
+                            fm_uint   reg,
+                            fm_uint32 mask,
+                            fm_bool   on);
+    fm_status (*WriteUINT32Mult)(fm_int     sw,
+                                 fm_uint    reg,
+                                 fm_int     count,
+                                 fm_uint32 *ptr);
+    fm_status (*ReadUINT32Mult)(fm_int     sw,
+                                fm_uint    reg,
+                                fm_int     count,
+                                fm_uint32 *value);
+    fm_status (*WriteUINT64)(fm_int sw, fm_uint reg, fm_uint64 value);
+    fm_status (*ReadUINT64)(fm_int sw, fm_uint reg, fm_uint64 *value);
+    fm_status (*WriteUINT64Mult)(fm_int     sw,
+                                 fm_uint    reg,
+                                 fm_int     count,
+                                 fm_uint64 *ptr);
+    fm_status (*ReadUINT64Mult)(fm_int     sw,
+                                fm_uint    reg,
+                                fm_int     count,
+                                fm_uint64 *value);
+
+} fm_regBatch;
+
+
 
 
 /****************************************************************************/
@@ -372,6 +428,15 @@ struct _fm_switch
     fm_bool                     supportRoutingLookups;
     fm_customTree *             routeLookupTrees;
 
+    /* Longest-prefix-match index kept alongside routeLookupTrees, NULL if
+     * route lookups are not supported. */
+    fm_routeLpm *               routeLpm;
+
+    /* TRUE while a route list operation is in progress. */
+    fm_bool                     routeListActive;
+
+    /* TRUE if the routing table changed during the route list operation. */
+    fm_bool                     routeListChanged;
 
     fm_int *                    virtualRouterIds;
     fm_macaddr                  physicalRouterMac;
@@ -411,10 +476,23 @@ struct _fm_switch
      * group record. */
     fm_tree                     mcastTree;
 
-    /* tree containing one record for each created multicast group which has
-     * an assigned multicast address. The key is the multicast address; the
-     * value is a pointer to the multicast group record. */
-    fm_customTree               mcastAddressTree;
+    /* hash map with the same records as mcastTree, for lookups by handle
+     * that do not need the handle order. */
+    fm_hashMap                  mcastHandleMap;
+
+    /* hash map containing one record for each multicast address assigned
+     * to a multicast group. The key is the multicast address; the value is
+     * a pointer to the multicast group record. */
+    fm_customHashMap            mcastAddressMap;
+
+    /* tree of multicast flooding changes not yet applied to the HNI
+     * flooding multicast groups. The key is the logical port; the value
+     * is the new flooding state of the port. */
+    fm_tree                     mcastHNIFloodPending;
+
+    /* time, in nanoseconds, at which the pending HNI flooding changes
+     * are due to be applied. */
+    fm_uint64                   mcastHNIFloodDeadline;
 
     /* tree containing one record for each multicast group which has an
      * associated logical port.  The key is the logical port; the value is
@@ -486,6 +564,13 @@ struct _fm_switch
     /* MAC Table cache */
     fm_internalMacAddrEntry *   maTable;
 
+    /* Per-port and per-FID indexes of the MAC Table cache, NULL if the
+     * table is too large to be indexed */
+    fm_maTableIndex *           maIndex;
+
+    /* Change journal of the MAC Table cache, NULL if disabled */
+    fm_maJournal *              maJournal;
+
     /* VLAN Table */
     fm_vlanEntry *              vidTable;
     fm_uint16                   reservedVlan;
@@ -506,6 +591,24 @@ struct _fm_switch
     /* Counter Table */
     fm_counterInfo              counterInfo;
 
+    /* Telemetry ring in shared memory, NULL until it is first enabled */
+    fm_telemetryRing *          telemetryRing;
+
+    /* sFlow sample ring, NULL until it is first enabled */
+    fm_sflowSampleRing *        sflowSampleRing;
+
+    /* Receive packet filters, and one more than the highest valid one */
+    fm_rxFilterEntry            rxFilters[FM_MAX_RX_PACKET_FILTERS];
+    fm_int                      rxFilterLimit;
+
+    /* Bumped whenever port, LAG or glort configuration changes, so that
+     * precompiled TX destinations are rebuilt before their next use. */
+    fm_uint32                   txDestGeneration;
+
+    /* TX completion handler and its cookie, NULL if none */
+    fm_txCompletionHandler      txCompletionHandler;
+    void *                      txCompletionCookie;
+
     /* NAT Table */
     fm_natInfo *                natInfo;
 
@@ -567,6 +670,12 @@ struct _fm_switch
 
     /* Lock taken to protect various state structures. */
     fm_lock                     stateLock;
+
+    /* Protects the counter bookkeeping (fm_counterInfo, the counter cache
+     * and the temporary buffers used for 128-bit counters) so that the
+     * statistics getters do not serialize with configuration changes
+     * that hold the state lock. */
+    fm_lock                     statsLock;
     
     /* Lock to protect packet send/receive interrupt flags. */
     fm_lock                     pktIntLock;
@@ -648,6 +757,11 @@ struct _fm_switch
     fm_bool                     intrSendPackets;
     fm_bool                     intrReceivePackets;
 
+    /* Time, in microseconds, for which the interrupt task should keep
+     * polling the switch with its interrupt masked, as requested by the
+     * last pass of the chip specific handler. 0 means no polling. */
+    fm_uint                     intrPollTime;
+
     /**************************************************
      * State information related to buffer and event 
      * management.
@@ -778,6 +892,17 @@ struct _fm_switch
     fm_bool                     (*IsPerLagPortAttribute)(fm_int sw,
                                                          fm_uint attr);
 
+    fm_status                   (*BeginPortAttributeUpdate)(fm_int sw);
+
+    fm_status                   (*EndPortAttributeUpdate)(fm_int sw);
+
+    /* Reads a port attribute from the copy published for lock-free
+     * readers, without taking any lock. May be NULL. */
+    fm_status                   (*GetPortAttributeSnapshot)(fm_int sw,
+                                                            fm_int port,
+                                                            fm_int attr,
+                                                            void * value);
+
     /**************************************************
      * PortSet Operations
      **************************************************/
@@ -861,6 +986,11 @@ struct _fm_switch
     fm_status                   (*ResetACLCount)(fm_int sw,
                                                  fm_int                   acl,
                                                  fm_int                   rule);
+    fm_status                   (*GetACLCountList)(fm_int            sw,
+                                                   fm_int            maxEntries,
+                                                   fm_aclCountEntry *entries,
+                                                   fm_int *          numEntries,
+                                                   fm_bool           clear);
     fm_status                   (*GetACLEgressCount)(fm_int          sw,
                                                      fm_int          logicalPort,
                                                      fm_aclCounters *counters);
@@ -910,6 +1040,17 @@ struct _fm_switch
                                                       fm_int *ffuRuleUsed,
                                                       fm_int *ffuRuleAvailable);
 
+    /**************************************************
+     * FFU Occupancy Functions
+     **************************************************/
+    fm_status                   (*GetFFUSliceMap)(fm_int          sw,
+                                                  fm_int          slice,
+                                                  fm_ffuSliceMap *sliceMap);
+    fm_status                   (*DefragmentFFU)(fm_int          sw,
+                                                 fm_ffuOwnerType owner,
+                                                 fm_int          budget,
+                                                 fm_int *        numMoved);
+
     /**************************************************
      * Policer Functions
      **************************************************/
@@ -934,6 +1075,11 @@ struct _fm_switch
     fm_status   (*AddAddress)(fm_int              sw,
                               fm_macAddressEntry *entry);
 
+    /* Adds a list of entries to the MA table. May be NULL. */
+    fm_status   (*AddAddressList)(fm_int              sw,
+                                  fm_int              numEntries,
+                                  fm_macAddressEntry *entries);
+
     /* Preprocesses an entry to be added to the MA table. May be NULL. */
     fm_status   (*AddAddressToTablePre)(fm_int sw,
                                         fm_macAddressEntry *entry,
@@ -979,6 +1125,11 @@ struct _fm_switch
     fm_status   (*DeleteAddressPre)(fm_int sw,
                                     fm_macAddressEntry *entry);
 
+    /* Deletes a list of entries from the MA table. May be NULL. */
+    fm_status   (*DeleteAddressList)(fm_int              sw,
+                                     fm_int              numEntries,
+                                     fm_macAddressEntry *entries);
+
     /* Deletes all addresses from the MA table. */
     fm_status   (*DeleteAllAddresses)(fm_int sw, fm_bool dynamicOnly);
 
@@ -1028,6 +1179,30 @@ struct _fm_switch
                                    fm_macAddressEntry *entries,
                                    fm_int              maxEntries);
 
+    /* Retrieves the next page of a cursor walk of the MA table.
+     * May be NULL. */
+    fm_status   (*GetAddressTablePage)(fm_int              sw,
+                                       fm_macTableCursor * cursor,
+                                       fm_int *            nEntries,
+                                       fm_macAddressEntry *entries,
+                                       fm_int              maxEntries);
+
+    /* Same as GetAddressTablePage, but without taking any lock, for
+     * monitoring processes. May be NULL. */
+    fm_status   (*GetAddressTableSnapshot)(fm_int              sw,
+                                           fm_macTableCursor * cursor,
+                                           fm_int *            nEntries,
+                                           fm_macAddressEntry *entries,
+                                           fm_int              maxEntries);
+
+    /* Retrieves the MA table occupancy and collision statistics.
+     * May be NULL. */
+    fm_status   (*GetAddressTableStats)(fm_int sw, fm_macTableStats *stats);
+
+    /* Resets the MA table occupancy and collision statistics.
+     * May be NULL. */
+    fm_status   (*ResetAddressTableStats)(fm_int sw);
+
     /* Returns the value of an MA table related attribute. */
     fm_status   (*GetAddressTableAttribute)(fm_int  sw,
                                             fm_int  attr,
@@ -1101,6 +1276,7 @@ struct _fm_switch
     void        (*FreeLAG)(fm_int sw, fm_int lagIndex);
     fm_status   (*DeletePortFromLag)(fm_int sw, fm_int lagIndex, fm_int port);
     fm_status   (*AddPortToLag)(fm_int sw, fm_int lagIndex, fm_int port);
+    fm_status   (*FlushLagUpdates)(fm_int sw);
     fm_status   (*GetLagAttribute)(fm_int   sw,
                                    fm_int   attribute,
                                    fm_int   index,
@@ -1130,6 +1306,11 @@ struct _fm_switch
     fm_status   (*WritePortMirrorGroup)(fm_int              sw,
                                         fm_portMirrorGroup *grp);
 
+    fm_status   (*UpdateMirrorGroupPorts)(fm_int              sw,
+                                          fm_portMirrorGroup *grp,
+                                          fm_int              numPorts,
+                                          fm_int *            portList);
+
     fm_status   (*UpdateMirrorGroups)(fm_int sw, 
                                       fm_int physPort, 
                                       fm_bool up);
@@ -1188,11 +1369,24 @@ struct _fm_switch
     fm_status   (*GetPortCounters)(fm_int           sw,
                                    fm_int           port,
                                    fm_portCounters *counters);
+    fm_status   (*GetAllPortCounters)(fm_int           sw,
+                                      fm_int *         portList,
+                                      fm_int           numPorts,
+                                      fm_portCounters *counters);
+    /* Returns the cached counters of a port without taking any lock.
+     * May be NULL. */
+    fm_status   (*GetPortCountersSnapshot)(fm_int           sw,
+                                           fm_int           port,
+                                           fm_portCounters *counters);
     fm_status   (*AllocateVLANCounters)(fm_int sw, fm_int vlan);
     fm_status   (*FreeVLANCounters)(fm_int sw, fm_int vlan);
     fm_status   (*GetVLANCounters)(fm_int           sw,
                                    fm_int           vcid,
                                    fm_vlanCounters *counters);
+    fm_status   (*GetVLANCountersList)(fm_int           sw,
+                                       fm_int           numCounters,
+                                       fm_int *         vcidList,
+                                       fm_vlanCounters *counters);
     fm_status   (*ResetVLANCounters)(fm_int sw,
                                      fm_int vcid);
     fm_status   (*GetSwitchCounters)(fm_int             sw, 
@@ -1260,6 +1454,17 @@ struct _fm_switch
                                         fm_int    numPorts,
                                         fm_int *  portList,
                                         fm_int    state);
+    fm_status   (*AddVlanRangePortList)(fm_int    sw,
+                                        fm_uint16 firstVlanID,
+                                        fm_uint16 lastVlanID,
+                                        fm_int    numPorts,
+                                        fm_int *  portList,
+                                        fm_bool   tag);
+    fm_status   (*DeleteVlanRangePortList)(fm_int    sw,
+                                           fm_uint16 firstVlanID,
+                                           fm_uint16 lastVlanID,
+                                           fm_int    numPorts,
+                                           fm_int *  portList);
 
     /* functions to manage customer VLANs for provider bridging */
     fm_status   (*AddCVlan)(fm_int      sw,
@@ -1290,6 +1495,10 @@ struct _fm_switch
                                        fm_stpInstanceInfo *instance,
                                        fm_int              vlan, 
                                        fm_int              port);
+    fm_status   (*RefreshSpanningTreePortList)(fm_int              sw,
+                                               fm_stpInstanceInfo *instance,
+                                               fm_int              numPorts,
+                                               fm_int *            portList);
     fm_status   (*CreateSpanningTree)(fm_int sw, 
                                       fm_int stpInstance);
     fm_status   (*DeleteSpanningTree)(fm_int sw, 
@@ -1343,6 +1552,11 @@ struct _fm_switch
                            fm_flowParam *   param,
                            fm_flowState     flowState,
                            fm_int *         flowId);
+    fm_status   (*AddFlowList)(fm_int            sw,
+                               fm_int            tableIndex,
+                               fm_int            numFlows,
+                               fm_flowListEntry *flows,
+                               fm_status *       results);
     fm_status   (*GetFlow)(fm_int             sw, 
                            fm_int             tableIndex,
                            fm_int             flowId,
@@ -1574,6 +1788,10 @@ struct _fm_switch
     fm_status   (*DeleteNatRule)(fm_int sw,
                                  fm_int table,
                                  fm_int rule);
+    fm_status   (*BeginNatRuleList)(fm_int sw,
+                                    fm_int table);
+    fm_status   (*EndNatRuleList)(fm_int sw,
+                                  fm_int table);
     fm_status   (*AddNatPrefilter)(fm_int                sw,
                                    fm_int                table,
                                    fm_int                entry,
@@ -1649,6 +1867,8 @@ struct _fm_switch
                                            fm_int          stormController,
                                            fm_stormAction *currentAction, 
                                            fm_stormAction *nextAction );
+    fm_status   (*BeginStormCtrlUpdate)(fm_int sw, fm_int stormController);
+    fm_status   (*CommitStormCtrlUpdate)(fm_int sw, fm_int stormController);
     void        (*DbgDumpStormCtrl)(fm_int sw, fm_int stormController);
 
     /**************************************************
@@ -1706,6 +1926,12 @@ struct _fm_switch
     void        (*DbgDumpMACTableEntry)( fm_int sw, 
                                          fm_macaddr address, 
                                          fm_uint16 vlan );
+    fm_status   (*DbgInjectMACTableEvents)(fm_int     sw,
+                                           fm_macaddr firstAddress,
+                                           fm_uint16  vlanID,
+                                           fm_int     port,
+                                           fm_int     numEntries,
+                                           fm_int *   numInjected);
     void        (*DbgListRegisters)( fm_int sw, 
                                      fm_bool showGlobals, 
                                      fm_bool showPorts );
@@ -1720,6 +1946,9 @@ struct _fm_switch
                                        fm_int  *index2Ptr,
                                        fm_bool  logicalPorts,
                                        fm_bool  partialLongRegs );
+    fm_status   (*DbgGetRegisterId)( fm_int  sw,
+                                     fm_uint regAddress,
+                                     fm_int *regId );
     void        (*DbgWriteRegisterBits)(fm_int     sw,
                                         fm_uint    reg,
                                         fm_uint32  mask,
@@ -1727,6 +1956,10 @@ struct _fm_switch
     void        (*DbgTakeChipSnapshot)(fm_int                sw,
                                        fmDbgFulcrumSnapshot *pSnapshot,
                                        fm_regDumpCallback    callback);
+    fm_status   (*DbgStreamRegisters)(fm_int                sw,
+                                      fm_text               regName,
+                                      fm_text               fileName,
+                                      fm_dbgRegStreamFormat format);
     fm_status   (*DbgDumpPortMap)(fm_int sw, fm_int port, fm_int portType);
     fm_status   (*DbgDumpPortMasks)(fm_int sw);
     fm_status   (*DbgDumpLag)(fm_int sw);
@@ -1939,6 +2172,10 @@ struct _fm_switch
                                      **eyeDiagramPtr );
     fm_status   (*DbgPlotEyeDiagram)( fm_eyeDiagramSample *sampleTable );
     fm_status   (*DbgDeleteEyeDiagram)( fm_eyeDiagramSample *sampleTable );
+    fm_status   (*DbgTakeEyeMetrics)( fm_int               sw,
+                                      fm_int               maxLanesPerRing,
+                                      fm_eyeMetricCallback callback,
+                                      fm_voidptr           callbackInfo );
 
     /**************************************************
      * MAC Table Maintenance Task functions
@@ -2048,6 +2285,22 @@ struct _fm_switch
                                fm_islTagFormat  islTagFormat,
                                fm_buffer        *pkt);
 
+    fm_status (*CreateTxDestination)(fm_int  sw,
+                                     fm_int *portList,
+                                     fm_int  numPorts,
+                                     fm_int *destHandle);
+
+    fm_status (*DeleteTxDestination)(fm_int sw, fm_int destHandle);
+
+    fm_status (*SendPacketTxDestination)(fm_int           sw,
+                                         fm_int           destHandle,
+                                         fm_buffer *      pkt,
+                                         fm_packetInfoV2 *info);
+
+    fm_status (*GetTxQueueSpace)(fm_int    sw,
+                                 fm_uint32 switchPriority,
+                                 fm_int *  space);
+
     fm_status (*GeneratePacketISL)(fm_int          sw,
                                    fm_buffer      *buffer,
                                    fm_packetInfo  *info,
@@ -2145,6 +2398,14 @@ struct _fm_switch
     void       (*DbgDumpRouteStats)(fm_int sw);
     void       (*DbgDumpRouteTables)(fm_int sw, fm_int flags);
     fm_status  (*DbgValidateRouteTables)(fm_int sw);
+
+    /* Returns the number of route moves made in the routing TCAM since
+     * the switch came up. May be NULL. */
+    fm_status  (*GetRouteMoveCount)(fm_int sw, fm_uint64 *moveCount);
+
+    /* Returns the number of bytes used by the chip-specific route
+     * records. May be NULL. */
+    fm_status  (*GetRouteMemoryUsage)(fm_int sw, fm_uint64 *bytes);
     fm_status  (*SetRouteAttribute)(fm_int            sw,
                                     fm_intRouteEntry *route,
                                     fm_int            attr,
@@ -2243,6 +2504,8 @@ struct _fm_switch
     fm_status  (*GetVNDefaultGpe)(fm_int sw, fm_vnGpeCfg *defaultGpe);
     fm_status  (*GetVNDefaultNsh)(fm_int sw, fm_vnNshCfg *defaultGpe);
     fm_status  (*FreeVNResources)(fm_int sw);
+    fm_status  (*BeginVNBatch)(fm_int sw);
+    fm_status  (*CommitVNBatch)(fm_int sw);
     fm_status  (*AddVNLocalPort)(fm_int             sw,
                                  fm_virtualNetwork *vn,
                                  fm_int             port);
@@ -2396,6 +2659,11 @@ struct _fm_switch
     fm_status  (*AddMulticastListener)(fm_int sw,
                                        fm_intMulticastGroup *group,
                                        fm_intMulticastListener *listener);
+    fm_status  (*AddMulticastListenerList)(fm_int sw,
+                                           fm_intMulticastGroup *group,
+                                           fm_int numListeners,
+                                           fm_intMulticastListener **listeners,
+                                           fm_int *numAdded);
     fm_status  (*DeleteMulticastListener)(fm_int sw,
                                           fm_intMulticastGroup *group,
                                           fm_intMulticastListener *listener);
@@ -2433,6 +2701,8 @@ struct _fm_switch
     fm_status  (*GetMcastGroupHwIndex)(fm_int                sw,
                                        fm_intMulticastGroup *group,
                                        fm_int *              hwIndex);
+    /* Only equality matters for the switch's multicast address map; equal
+     * keys must also hash alike with fmHashMulticastAddress. */
     fm_int     (*CompareMulticastAddresses)(const void *key1,
                                             const void *key2);
     fm_status  (*GetMcastGroupForSWAGGroup)(fm_int                sw,
@@ -2896,6 +3166,30 @@ struct _fm_switch
     /* pointer to chipset-specific Cached Register List */
     void       **CachedRegisterList;
 
+    /* Write statistics of each cached register set, in the order of
+     * CachedRegisterList */
+    struct _fm_regCacheWriteStats *regCacheWriteStats;
+
+    /* Maps each cached register set descriptor to its entry in
+     * regCacheWriteStats */
+    fm_hashMap  regCacheWriteStatsMap;
+
+    /* Sequence count of the register cache contents, odd while a writer
+     * holding the register lock is updating them. Lets cached reads
+     * proceed without the lock, see fmRegCacheRead. */
+    fm_uint32   regCacheSeq;
+
+    /* Checksums maintained incrementally over blocks of the register
+     * cache, see fmRegCacheGetChecksum */
+    struct _fm_regCacheChecksum *regCacheChecksums;
+
+    /* Register write batch, see fmRegBatchBegin */
+    fm_regBatch regBatch;
+
+    /* Register access profile, NULL until fmDbgStartRegProfile is first
+     * called on the switch */
+    struct _fm_regProfile *regProfile;
+
     /* I2C write read function */
     fm_status                   (*I2cWriteRead)(fm_int   sw,
                                                 fm_uint  device,
@@ -2959,6 +3253,10 @@ struct _fm_switch
     fm_status  (*CheckSFlowLogging)(fm_int           sw,
                                     fm_eventPktRecv *pktEvent,
                                     fm_bool         *isPktSFlowLogged);
+    fm_status  (*DeliverSFlowSample)(fm_int           sw,
+                                     fm_eventPktRecv *pktEvent,
+                                     fm_bool         *isPktSFlowLogged);
+    fm_status  (*UpdateSFlowSampleRates)(fm_int sw);
 
     fm_status  (*UpdateRemoveDownPortsTrigger)(fm_int sw,
                                                fm_int physPort,
@@ -3144,6 +3442,8 @@ struct _fm_switch
 
     fm_status (*MailboxFreeResources)(fm_int sw);
 
+    fm_status (*MailboxServicePeps)(fm_int sw, fm_uint32 pepMask);
+
     fm_status (*GetSchedPortSpeedForPep)(fm_int  sw,
                                          fm_int  pepId,
                                          fm_int *speed);
@@ -3264,6 +3564,22 @@ struct _fm_switch
     swProtected = TRUE
 
 
+/*  VALIDATE_SWITCH_LOCK_FREE validates a switch without taking the switch
+ *  lock, for the snapshot accessors that monitoring processes may call.
+ *  It does not synchronize with switch removal: the switch may go down
+ *  right after the check. */
+#define VALIDATE_SWITCH_LOCK_FREE(sw)                                              \
+    if ( (sw) < 0 || (sw) >= FM_MAX_NUM_SWITCHES || fmRootApi == NULL )            \
+    {                                                                              \
+        return FM_ERR_INVALID_SWITCH;                                              \
+    }                                                                              \
+    if ( fmRootApi->fmSwitchStateTable[(sw)] == NULL ||                            \
+         fmRootApi->fmSwitchStateTable[(sw)]->state != FM_SWITCH_STATE_UP )        \
+    {                                                                              \
+        return FM_ERR_SWITCH_NOT_UP;                                               \
+    }
+
+
 /*  Similar to VALIDATE_AND_PROTECT_SWITCH, but set error code rather than
  *  returning and don't define or set local swProtected variable, so cannot
  *  be blindly followed by other VALIDATE macros. 
@@ -3408,6 +3724,11 @@ struct _fm_switch
  * been validated. */
 #define GET_PORT_PTR(sw, port)  GET_SWITCH_PTR(sw)->portTable[(port)]
 
+/* Marks every precompiled TX destination of a switch as stale - assumes
+ * that the switch number and presence have been validated. */
+#define FM_INVALIDATE_TX_DESTINATIONS(sw)                                   \
+    (void) FM_ATOMIC_ADD(&GET_SWITCH_PTR(sw)->txDestGeneration, 1)
+
 /* Function to return a port extension - assumes that switch and port have
  * been validated. */
 #define GET_PORT_EXT(sw, port)  GET_SWITCH_PTR(sw)->portTable[(port)]->extension
@@ -3575,6 +3896,27 @@ struct _fm_switch
                                     FM_DROP_STATE_LOCK(sw); \
                                     stateLockTaken = FALSE;
                                     
+/**************************************************
+ * The stats lock protects the counter bookkeeping.
+ * It ranks below every configuration lock, so it may
+ * be taken while holding the state lock but nothing
+ * other than register access may be done under it.
+ **************************************************/
+
+#define FM_TAKE_STATS_LOCK(sw) \
+    fmCaptureLock(&fmRootApi->fmSwitchStateTable[(sw)]->statsLock, FM_WAIT_FOREVER);
+
+#define FM_DROP_STATS_LOCK(sw) \
+    fmReleaseLock(&fmRootApi->fmSwitchStateTable[(sw)]->statsLock);
+
+#define FM_FLAG_TAKE_STATS_LOCK(sw)                         \
+                                    FM_TAKE_STATS_LOCK(sw); \
+                                    statsLockTaken = TRUE;
+
+#define FM_FLAG_DROP_STATS_LOCK(sw)                         \
+                                    FM_DROP_STATS_LOCK(sw); \
+                                    statsLockTaken = FALSE;
+
 /**************************************************
  * The port attribute lock is used to protect the 
  * structures (i.e. fm_portAttr, fmX000_portAttr) 
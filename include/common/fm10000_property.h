@@ -393,6 +393,164 @@
 #define FM_AAT_API_FM10000_CRM_TIMEOUT   FM_API_ATTR_INT
 #define FM_AAD_API_FM10000_CRM_TIMEOUT   20
 
+/** Time budget, in microseconds, for a single pass of the parity repair
+ *  task. Once the budget is spent, the task yields and resumes the
+ *  remaining repairs on its next pass, continuing a partially refreshed
+ *  register table from the entry at which it stopped. A value of zero
+ *  leaves each pass unbounded. */
+#define FM_AAK_API_FM10000_PARITY_SWEEP_BUDGET   "api.FM10000.parity.sweepBudget"
+#define FM_AAT_API_FM10000_PARITY_SWEEP_BUDGET   FM_API_ATTR_INT
+#define FM_AAD_API_FM10000_PARITY_SWEEP_BUDGET   0
+
+/** Length, in milliseconds, of the window over which repeated SRAM_ERR
+ *  and CRM memory errors are coalesced. Each memory is decoded once per
+ *  window; further errors against it are only counted, and a single
+ *  summary parity event is reported for it when the window closes. A
+ *  value of zero decodes every error as it is reported. */
+#define FM_AAK_API_FM10000_PARITY_COALESCE_WINDOW   "api.FM10000.parity.coalesceWindow"
+#define FM_AAT_API_FM10000_PARITY_COALESCE_WINDOW   FM_API_ATTR_INT
+#define FM_AAD_API_FM10000_PARITY_COALESCE_WINDOW   1000
+
+/** Number of errors a FRAME_MEMORY segment may report within one
+ *  coalescing window before its SRAM_ERR interrupt is left masked until
+ *  the window closes. */
+#define FM_AAK_API_FM10000_PARITY_COALESCE_THRESHOLD   "api.FM10000.parity.coalesceThreshold"
+#define FM_AAT_API_FM10000_PARITY_COALESCE_THRESHOLD   FM_API_ATTR_INT
+#define FM_AAD_API_FM10000_PARITY_COALESCE_THRESHOLD   4
+
+/** Number of worker threads used to bind the ethernet ports to their port
+ *  and SerDes state machines during switch initialization. Ports are
+ *  handed out one EPL at a time, so the ports sharing an EPL are always
+ *  initialized in order by the same thread. A value of 1 or less
+ *  initializes the ports sequentially on the calling thread. */
+#define FM_AAK_API_FM10000_PORT_INIT_THREADS     "api.FM10000.portInitThreads"
+#define FM_AAT_API_FM10000_PORT_INIT_THREADS     FM_API_ATTR_INT
+#define FM_AAD_API_FM10000_PORT_INIT_THREADS     1
+
+/** Whether the MA Table Change Notification FIFO is drained in bursts.
+ *  When TRUE, the pending entries are read from the FIFO memory with one
+ *  multi-word read per pass, and the new source addresses they report are
+ *  learned with one batched update of the MA Table. When FALSE, the
+ *  entries are dequeued and learned one at a time. */
+#define FM_AAK_API_FM10000_MA_TCN_BURST_READ     "api.FM10000.ma.tcnBurstRead"
+#define FM_AAT_API_FM10000_MA_TCN_BURST_READ     FM_API_ATTR_BOOL
+#define FM_AAD_API_FM10000_MA_TCN_BURST_READ     FALSE
+
+/** Maximum rate, in addresses per second, at which new source addresses
+ *  reported by the MA Table Change Notification FIFO are learned on the
+ *  switch. Addresses in excess of the rate are dropped and will be
+ *  reported again by the hardware when the station next transmits.
+ *  A single ''FM_EVENT_ENTRY_LEARN_THROTTLED'' update is reported when
+ *  dropping begins. Zero means no limit. */
+#define FM_AAK_API_FM10000_MA_LEARNING_RATE_LIMIT "api.FM10000.ma.learningRateLimit"
+#define FM_AAT_API_FM10000_MA_LEARNING_RATE_LIMIT FM_API_ATTR_INT
+#define FM_AAD_API_FM10000_MA_LEARNING_RATE_LIMIT 0
+
+/** Maximum rate, in addresses per second, at which new source addresses
+ *  are learned on each physical port. Behaves as
+ *  ''api.FM10000.ma.learningRateLimit'', but is enforced separately for
+ *  every port. Zero means no limit. */
+#define FM_AAK_API_FM10000_MA_PORT_LEARNING_RATE_LIMIT "api.FM10000.ma.portLearningRateLimit"
+#define FM_AAT_API_FM10000_MA_PORT_LEARNING_RATE_LIMIT FM_API_ATTR_INT
+#define FM_AAD_API_FM10000_MA_PORT_LEARNING_RATE_LIMIT 0
+
+/** Number of threads used by the ACL compiler to select the TCAM keys of
+ *  the ingress ACLs, the calling thread included. ACLs are handed out in
+ *  ACL order and the results are merged in that order, so the compiled
+ *  ACL image does not depend on the number of threads. A value of 1 or
+ *  less compiles all the ACLs sequentially on the calling thread. */
+#define FM_AAK_API_FM10000_ACL_COMPILE_THREADS   "api.FM10000.acl.compileThreads"
+#define FM_AAT_API_FM10000_ACL_COMPILE_THREADS   FM_API_ATTR_INT
+#define FM_AAD_API_FM10000_ACL_COMPILE_THREADS   1
+
+/** Whether the ACL compiler should check the keys selected by its worker
+ *  threads (see ''api.FM10000.acl.compileThreads'') against a sequential
+ *  selection. A mismatch fails the compilation with
+ *  ''FM_ERR_ACL_COMPILE''. Intended for validation only, since it more
+ *  than doubles the cost of key selection. */
+#define FM_AAK_API_FM10000_ACL_COMPILE_VALIDATE  "api.FM10000.acl.compileValidate"
+#define FM_AAT_API_FM10000_ACL_COMPILE_VALIDATE  FM_API_ATTR_BOOL
+#define FM_AAD_API_FM10000_ACL_COMPILE_VALIDATE  FALSE
+
+/** Time, in microseconds, for which the interrupt handler keeps polling
+ *  the switch with its interrupt masked after it has handled an Ethernet
+ *  port (link, auto-negotiation or SerDes) interrupt. The window restarts
+ *  each time a polling pass finds more work of this kind, up to
+ *  ''api.intr.pollBudget'' passes spaced by ''api.intr.pollInterval''.
+ *  Polling coalesces bursts, such as many links changing state at once,
+ *  into fewer interrupts. Zero disables polling for these interrupts. */
+#define FM_AAK_API_FM10000_INTR_LINK_POLL_TIME    "api.FM10000.intr.linkPollTime"
+#define FM_AAT_API_FM10000_INTR_LINK_POLL_TIME    FM_API_ATTR_INT
+#define FM_AAD_API_FM10000_INTR_LINK_POLL_TIME    0
+
+/** Behaves as ''api.FM10000.intr.linkPollTime'' for MA Table Change
+ *  Notification interrupts. */
+#define FM_AAK_API_FM10000_INTR_MATCN_POLL_TIME   "api.FM10000.intr.maTcnPollTime"
+#define FM_AAT_API_FM10000_INTR_MATCN_POLL_TIME   FM_API_ATTR_INT
+#define FM_AAD_API_FM10000_INTR_MATCN_POLL_TIME   0
+
+/** Behaves as ''api.FM10000.intr.linkPollTime'' for PCIe mailbox
+ *  interrupts. */
+#define FM_AAK_API_FM10000_INTR_MAILBOX_POLL_TIME "api.FM10000.intr.mailboxPollTime"
+#define FM_AAT_API_FM10000_INTR_MAILBOX_POLL_TIME FM_API_ATTR_INT
+#define FM_AAD_API_FM10000_INTR_MAILBOX_POLL_TIME 0
+
+/** Maximum number of SerDes on the same SBus ring that may run DFE or KR
+ *  pCal tuning at the same time. Lanes asking to tune beyond this limit
+ *  wait their turn, highest priority first (see
+ *  ''api.FM10000.dfe.uplinkEplMask''). Zero disables the limit. */
+#define FM_AAK_API_FM10000_DFE_MAX_CONCURRENT_TUNINGS "api.FM10000.dfe.maxConcurrentTunings"
+#define FM_AAT_API_FM10000_DFE_MAX_CONCURRENT_TUNINGS FM_API_ATTR_INT
+#define FM_AAD_API_FM10000_DFE_MAX_CONCURRENT_TUNINGS 0
+
+/** Bit mask of the EPLs whose lanes are tuned first when DFE tuning is
+ *  limited by ''api.FM10000.dfe.maxConcurrentTunings'', typically the
+ *  EPLs of the uplink ports. Among lanes of equal rank, faster lanes are
+ *  tuned first. */
+#define FM_AAK_API_FM10000_DFE_UPLINK_EPL_MASK    "api.FM10000.dfe.uplinkEplMask"
+#define FM_AAT_API_FM10000_DFE_UPLINK_EPL_MASK    FM_API_ATTR_INT
+#define FM_AAD_API_FM10000_DFE_UPLINK_EPL_MASK    0
+
+/** Whether the iCal and pCal tuning timeouts are learned from the tuning
+ *  durations measured on the switch, instead of always using the fixed
+ *  maximums. Learned timeouts never exceed the fixed ones. */
+#define FM_AAK_API_FM10000_DFE_ADAPTIVE_TIMEOUT   "api.FM10000.dfe.adaptiveTimeout"
+#define FM_AAT_API_FM10000_DFE_ADAPTIVE_TIMEOUT   FM_API_ATTR_BOOL
+#define FM_AAD_API_FM10000_DFE_ADAPTIVE_TIMEOUT   TRUE
+
+/** Whether the mailbox requests pending on all PEPs are serviced in a
+ *  single pass per interrupt. Changes to the MAC filtering ACL are then
+ *  compiled and applied once for the whole batch, before the responses
+ *  are signaled to the host drivers. */
+#define FM_AAK_API_FM10000_MAILBOX_BATCH_REQUESTS "api.FM10000.mailbox.batchRequests"
+#define FM_AAT_API_FM10000_MAILBOX_BATCH_REQUESTS FM_API_ATTR_BOOL
+#define FM_AAD_API_FM10000_MAILBOX_BATCH_REQUESTS FALSE
+
+/** Whether a LAG member port that loses link is removed from the LAG's
+ *  hash distribution directly from the port state machine, before the
+ *  link down event reaches the global event handler. The event handler
+ *  still performs the full LAG update afterwards. */
+#define FM_AAK_API_FM10000_LAG_FAST_FAILOVER "api.FM10000.lag.fastFailover"
+#define FM_AAT_API_FM10000_LAG_FAST_FAILOVER FM_API_ATTR_BOOL
+#define FM_AAD_API_FM10000_LAG_FAST_FAILOVER FALSE
+
+/** Maximum time, in microseconds, that one MTable cleanup step may spend
+ *  recovering expired MCAST_VLAN_TABLE entries from the fast maintenance
+ *  task. A cleanup that does not complete within the budget resumes on
+ *  the next maintenance pass. Set to 0 to recover all entries in one
+ *  pass. */
+#define FM_AAK_API_FM10000_MTABLE_CLEANUP_BUDGET "api.FM10000.mtable.cleanupBudget"
+#define FM_AAT_API_FM10000_MTABLE_CLEANUP_BUDGET FM_API_ATTR_INT
+#define FM_AAD_API_FM10000_MTABLE_CLEANUP_BUDGET 500
+
+/** Size, in entries, below which the largest free block of the
+ *  MCAST_VLAN_TABLE causes an MTable cleanup to be started even though
+ *  the number of expired entries is still under the cleanup watermark.
+ *  Set to 0 to only start cleanups on the watermark. */
+#define FM_AAK_API_FM10000_MTABLE_CLEANUP_FREE_BLOCK "api.FM10000.mtable.cleanupFreeBlock"
+#define FM_AAT_API_FM10000_MTABLE_CLEANUP_FREE_BLOCK FM_API_ATTR_INT
+#define FM_AAD_API_FM10000_MTABLE_CLEANUP_FREE_BLOCK 64
+
 /* -------- Add new DOCUMENTED api properties above this line! -------- */
 
 /** @} (end of Doxygen group) */
@@ -561,6 +719,16 @@
 #define FM_AAT_API_FM10000_ALLOW_KRPCAL_ON_EEE      FM_API_ATTR_BOOL
 #define FM_AAD_API_FM10000_ALLOW_KRPCAL_ON_EEE      FALSE
 
+/* Whether to keep the SPICO firmware already running in the SBus master and
+ * the SerDes when it matches the image that would be uploaded and its CRC is
+ * valid. This skips the RAM BIST and the firmware upload on a restart that
+ * did not reset the SerDes. On a cold start the probe waits for the SBus
+ * master interrupt to time out, so this should only be enabled when the
+ * firmware is expected to survive the restart. */
+#define FM_AAK_API_FM10000_REUSE_LOADED_SPICO_FW    "api.FM10000.reuseLoadedSpicoFw"
+#define FM_AAT_API_FM10000_REUSE_LOADED_SPICO_FW    FM_API_ATTR_BOOL
+#define FM_AAD_API_FM10000_REUSE_LOADED_SPICO_FW    FALSE
+
 /************************************************************************
  ****                                                                ****
  ****              END UNDOCUMENTED API PROPERTIES                   ****
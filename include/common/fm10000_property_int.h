@@ -190,6 +190,27 @@ typedef struct _fm10000_property
     /* Parity CRM timeout */
     fm_int parityCrmTimeout;
 
+    /* Parity repair sweep budget */
+    fm_int paritySweepBudget;
+
+    /* Parity error coalescing window and threshold */
+    fm_int parityCoalesceWindow;
+    fm_int parityCoalesceThreshold;
+
+    /* Number of threads used for the ethernet port initialization */
+    fm_int portInitThreads;
+
+    /* Drain the MA TCN FIFO in bursts */
+    fm_bool maTcnBurstRead;
+
+    /* Learning rate limits, in addresses per second (0 = no limit) */
+    fm_int  maLearningRateLimit;
+    fm_int  maPortLearningRateLimit;
+
+    /* ACL compiler worker threads, and whether to check their results */
+    fm_int  aclCompileThreads;
+    fm_bool aclCompileValidate;
+
     /* Scheduler overspeed */
     fm_int  schedOverspeed;
 
@@ -203,6 +224,20 @@ typedef struct _fm10000_property
     fm_int  intrSwIgnoreMask;
     fm_int  intrTeIgnoreMask;
 
+    /* Interrupt polling windows (usec) per interrupt type (0 = no polling) */
+    fm_int  intrLinkPollTime;
+    fm_int  intrMaTcnPollTime;
+    fm_int  intrMailboxPollTime;
+
+    /* DFE tuning scheduler */
+    fm_int  dfeMaxConcurrentTunings;
+    fm_int  dfeUplinkEplMask;
+    fm_bool dfeAdaptiveTimeout;
+    fm_bool mailboxBatchRequests;
+    fm_bool lagFastFailover;
+    fm_int  mtableCleanupBudget;
+    fm_int  mtableCleanupFreeBlock;
+
     /* Enable EEE spico interrupt */
     fm_bool enableEeeSpicoIntr;
 
@@ -212,6 +247,9 @@ typedef struct _fm10000_property
     /* Allow Kr PCAL on EEE */
     fm_bool allowKrPcalOnEee;
 
+    /* Reuse the SPICO firmware when already loaded */
+    fm_bool reuseLoadedSpicoFw;
+
 } fm10000_property;
 
 #endif /* __FM_FM10000_PROPERTY_INT_H */
@@ -283,6 +283,32 @@ fm_status fmFindBitBlockInBitArray(fm_bitArray *bitArray,
                                    fm_int *     foundBit);
 
 
+/*****************************************************************************
+ * fmFindBitRunInBitArray
+ *
+ * Description: Searches a bit array, starting with a specified bit,
+ *              looking for a run of contiguous clear bits, for use by
+ *              block allocators. Runs in time linear in the word count.
+ *
+ * Arguments:   bitArray                pointer to the bit array
+ *
+ *              firstBitNumber          starting bit number (0 to bitCount-1)
+ *
+ *              runLength               Number of clear bits required.
+ *
+ *              foundBit                pointer for returned bit position,
+ *                                      will be 0 to bitCount-1 if found,
+ *                                      -1 if not found
+ *
+ * Returns:     Fulcrum API status code
+ *
+ *****************************************************************************/
+fm_status fmFindBitRunInBitArray(fm_bitArray *bitArray,
+                                 fm_int       firstBitNumber,
+                                 fm_int       runLength,
+                                 fm_int *     foundBit);
+
+
 /*****************************************************************************
  * fmFindLastBitBlockInBitArray
  *
@@ -52,10 +52,12 @@
  * referenced here.
  * As of 11/13/2007, fm_dlist.h depends on fmFreeFunc, which is defined
  * in fm_tree.h.
+ * fm_hash_map.h depends on the function pointer typedefs of fm_tree.h.
  **********************************************************************/
 
 #include <common/fm_errno.h>
 #include <common/fm_tree.h>
+#include <common/fm_hash_map.h>
 #include <common/fm_dlist.h>
 #include <common/fm_bitarray.h>
 #include <common/fm_bitfield.h>
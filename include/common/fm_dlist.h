@@ -208,10 +208,27 @@ typedef struct
 {
     FM_DLL_DEFINE_LIST(_fm_dlist_node, head, tail);
 
+    /* Recycled nodes, chained through nextPtr. Only used when the list
+     * was initialized with fmDListInitPooled. */
+    fm_dlist_node *freeNodes;
+
+    /* Number of nodes currently held in freeNodes. */
+    fm_int         numFreeNodes;
+
+    /* Maximum number of nodes retained in freeNodes; 0 disables pooling. */
+    fm_int         maxFreeNodes;
+
+    /* TRUE if nodes are embedded in the caller's structures and must
+     * never be allocated or freed by the list functions. */
+    fm_bool        intrusive;
+
 } fm_dlist;
 
 
 void fmDListInit(fm_dlist *list);
+void fmDListInitPooled(fm_dlist *list, fm_int maxFreeNodes);
+void fmDListInitIntrusive(fm_dlist *list);
+fm_status fmDListReserveNodes(fm_dlist *list, fm_int numNodes);
 
 fm_status fmDListInsertEnd(fm_dlist *list, void *data);
 fm_status fmDListInsertBegin(fm_dlist *list, void *data);
@@ -231,5 +248,7 @@ fm_uint fmDListSize(fm_dlist *list);
 fm_status fmDListPeekFirst(fm_dlist *list, void **dataPtr);
 fm_status fmDListInsertEndV2(fm_dlist *list, void *data, fm_dlist_node **node);
 fm_status fmDListInsertBeginV2(fm_dlist *list, void *data, fm_dlist_node **node);
+void fmDListInsertNodeEnd(fm_dlist *list, fm_dlist_node *node, void *data);
+void fmDListInsertNodeBegin(fm_dlist *list, fm_dlist_node *node, void *data);
 
 #endif /* __FM_FM_DLIST_H */
@@ -913,6 +913,10 @@ typedef fm_int fm_status;
 /** This operation is invalid for the current TE mode. */
 #define FM_ERR_TE_MODE                            284
 
+/** Changes were dropped from a journal before they could be read; the
+ *  reader must resynchronize. */
+#define FM_ERR_JOURNAL_OVERFLOW                   285
+
 
 /** @} (end of Doxygen group) */
 
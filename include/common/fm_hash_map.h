@@ -0,0 +1,178 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_hash_map.h
+ * Creation Date:   October 15, 2026
+ * Description:     Open-addressing hash maps, for exact-match lookups which
+ *                  do not need the key ordering of fm_tree.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+
+#ifndef __FM_FM_HASH_MAP_H
+#define __FM_FM_HASH_MAP_H
+
+/* function pointer typedefs, see fm_tree.h for the others */
+
+typedef fm_uint32 (*fmHashFunc)(const void *key);
+
+
+/* private types */
+
+struct _fm_hashMapSlot;
+
+
+typedef struct _fm_internalHashMap
+{
+    /** TRUE if the map is a custom map */
+    fm_bool                 customMap;
+
+    /** Slot array, NULL until the first insertion. */
+    struct _fm_hashMapSlot *slots;
+
+    /** Number of slots, always a power of two. */
+    fm_uint                 capacity;
+
+    /** Number of items in the map. */
+    fm_uint                 size;
+
+    /** Incremented with each change, to implement fail-fast iterators. */
+    fm_uint                 serial;
+
+    /** Function to allocate the slot array. */
+    fmAllocFunc             allocFunc;
+
+    /** Function to free the slot array. */
+    fmFreeFunc              freeFunc;
+
+    /** Function to hash a key, NULL for fm_hashMap. */
+    fmHashFunc              hashFunc;
+
+    /** Function to compare keys, NULL for fm_hashMap. Only equality
+     *  matters, so it only needs to return 0 for equal keys. */
+    fmCompareFunc           compareFunc;
+
+    /** FM_HASH_MAP_SIGNATURE while the map is initialized. */
+    fm_uint32               signature;
+
+} fm_internalHashMap;
+
+
+typedef struct _fm_internalHashMapIterator
+{
+    fm_internalHashMap *map;
+    fm_uint             index;
+    fm_uint             serial;
+
+} fm_internalHashMapIterator;
+
+
+/* public types */
+
+/** A map from 64-bit unsigned integers to void* pointers. */
+typedef struct _fm_hashMap
+{
+    fm_internalHashMap internalMap;
+
+} fm_hashMap;
+
+
+/** A map from void* keys to void* pointers, with caller-supplied hash
+ *  and comparison functions. */
+typedef struct _fm_customHashMap
+{
+    fm_internalHashMap internalMap;
+
+} fm_customHashMap;
+
+
+typedef struct _fm_hashMapIterator
+{
+    fm_internalHashMapIterator internalIterator;
+
+} fm_hashMapIterator;
+
+
+typedef struct _fm_customHashMapIterator
+{
+    fm_internalHashMapIterator internalIterator;
+
+} fm_customHashMapIterator;
+
+
+/* functions for fm_hashMap */
+
+void fmHashMapInit(fm_hashMap *map);
+void fmHashMapInitWithAllocator(fm_hashMap *map,
+                                fmAllocFunc allocFunc,
+                                fmFreeFunc  freeFunc);
+void fmHashMapDestroy(fm_hashMap *map, fmFreeFunc delFunc);
+fm_status fmHashMapClone(fm_hashMap *srcMap,
+                         fm_hashMap *dstMap,
+                         fmCloneFunc cloneFunc,
+                         void *      cloneFuncArg);
+fm_uint fmHashMapSize(fm_hashMap *map);
+fm_bool fmHashMapIsInitialized(fm_hashMap *map);
+fm_status fmHashMapInsert(fm_hashMap *map, fm_uint64 key, void *value);
+fm_status fmHashMapRemove(fm_hashMap *map, fm_uint64 key, fmFreeFunc delFunc);
+fm_status fmHashMapFind(fm_hashMap *map, fm_uint64 key, void **value);
+void fmHashMapIterInit(fm_hashMapIterator *it, fm_hashMap *map);
+fm_status fmHashMapIterNext(fm_hashMapIterator *it,
+                            fm_uint64 *         nextKey,
+                            void **             nextValue);
+void fmHashMapDbgDump(fm_hashMap *map);
+
+
+/* functions for fm_customHashMap */
+
+void fmCustomHashMapInit(fm_customHashMap *map,
+                         fmHashFunc        hashFunc,
+                         fmCompareFunc     compareFunc);
+void fmCustomHashMapInitWithAllocator(fm_customHashMap *map,
+                                      fmHashFunc        hashFunc,
+                                      fmCompareFunc     compareFunc,
+                                      fmAllocFunc       allocFunc,
+                                      fmFreeFunc        freeFunc);
+void fmCustomHashMapDestroy(fm_customHashMap *map, fmFreePairFunc delFunc);
+fm_uint fmCustomHashMapSize(fm_customHashMap *map);
+fm_bool fmCustomHashMapIsInitialized(fm_customHashMap *map);
+fm_status fmCustomHashMapInsert(fm_customHashMap *map, void *key, void *value);
+fm_status fmCustomHashMapRemove(fm_customHashMap *map,
+                                const void *      key,
+                                fmFreePairFunc    delFunc);
+fm_status fmCustomHashMapFind(fm_customHashMap *map,
+                              const void *      key,
+                              void **           value);
+void fmCustomHashMapIterInit(fm_customHashMapIterator *it,
+                             fm_customHashMap *        map);
+fm_status fmCustomHashMapIterNext(fm_customHashMapIterator *it,
+                                  void **                   nextKey,
+                                  void **                   nextValue);
+void fmCustomHashMapDbgDump(fm_customHashMap *map);
+
+
+#endif /* __FM_FM_HASH_MAP_H */
@@ -64,6 +64,7 @@ enum
     FM_LOCK_PREC_FFU,                       /* switchExt->ffuAtomicAccessLock */
     FM_LOCK_PREC_PORT_SET,                  /* switchExt->portSetLock */
     FM_LOCK_PREC_SCHEDULER,                 /* switchExt->schedulerLock */
+    FM_LOCK_PREC_STATS,                     /* swstate->statsLock */
     FM_LOCK_PREC_PLATFORM,                  /* ps->accessLocks[FM_MEM_TYPE_CSR] */
     FM_LOCK_PREC_TREE_TREE,                 /* fmRootApi->treeTreeLock */
 
@@ -191,6 +191,26 @@ typedef enum
 #define FM_AAT_API_EVENT_SEM_TIMEOUT                FM_API_ATTR_INT
 #define FM_AAD_API_EVENT_SEM_TIMEOUT                1000
 
+/** Specifies the number of free events reserved for port (link state)
+ *  events. Events of the other types are not allocated when this many
+ *  events or fewer remain, so that a flood of packet or MAC Table events
+ *  cannot delay link state changes by exhausting the event pool.
+ *                                                                      \lb\lb
+ *  Note that the Default value will be FM_MAX_EVENTS/64. */
+#define FM_AAK_API_EVENT_LINK_RESERVE               "api.event.linkReserve"
+#define FM_AAT_API_EVENT_LINK_RESERVE               FM_API_ATTR_INT
+#define FM_AAD_API_EVENT_LINK_RESERVE               (FM_MAX_EVENTS/64)
+
+/** Specifies the number of free events reserved for logical port events
+ *  reported by the PCIe mailbox, on top of ''api.event.linkReserve''.
+ *  Events other than port and logical port events are not allocated when
+ *  the sum of both reservations or fewer remain.
+ *                                                                      \lb\lb
+ *  Note that the Default value will be FM_MAX_EVENTS/128. */
+#define FM_AAK_API_EVENT_MAILBOX_RESERVE            "api.event.mailboxReserve"
+#define FM_AAT_API_EVENT_MAILBOX_RESERVE            FM_API_ATTR_INT
+#define FM_AAD_API_EVENT_MAILBOX_RESERVE            (FM_MAX_EVENTS/128)
+
 /** Indicates whether received packets are to be queued directly to the 
  *  application's event handler callback function (see ''fm_eventHandler'')
  *  from the packet receive thread. This will greatly improve the packet
@@ -289,6 +309,62 @@ typedef enum
 #define FM_AAT_API_MA_TCN_FIFO_BURST_SIZE       FM_API_ATTR_INT
 #define FM_AAD_API_MA_TCN_FIFO_BURST_SIZE       512
 
+/** Specifies the maximum number of MA Table entries a purge examines in
+ *  a single slice. When the budget is used up, the purge yields the
+ *  switch to other API users and resumes where it left off on the next
+ *  pass of the MA Table maintenance thread. Zero means no limit. */
+#define FM_AAK_API_MA_MAINT_SLICE_ENTRIES       "api.ma.maintSliceEntries"
+#define FM_AAT_API_MA_MAINT_SLICE_ENTRIES       FM_API_ATTR_INT
+#define FM_AAD_API_MA_MAINT_SLICE_ENTRIES       2048
+
+/** Specifies the maximum time, in microseconds, a purge runs in a single
+ *  slice before it yields the switch, as for
+ *  ''api.ma.maintSliceEntries''. Zero means no limit. */
+#define FM_AAK_API_MA_MAINT_SLICE_TIME          "api.ma.maintSliceTime"
+#define FM_AAT_API_MA_MAINT_SLICE_TIME          FM_API_ATTR_INT
+#define FM_AAD_API_MA_MAINT_SLICE_TIME          5000
+
+/** Specifies the number of changes held by the MA Table change journal
+ *  of each switch, read with ''fmGetAddressJournal''. Older changes are
+ *  dropped when the journal is full. Zero disables the journal. */
+#define FM_AAK_API_MA_JOURNAL_SIZE              "api.ma.journalSize"
+#define FM_AAT_API_MA_JOURNAL_SIZE              FM_API_ATTR_INT
+#define FM_AAD_API_MA_JOURNAL_SIZE              0
+
+/** Specifies the maximum number of additional passes the interrupt handler
+ *  makes over a switch, with its interrupt still masked, after handling an
+ *  interrupt from a source that requests polling. See the per-source
+ *  ''api.FM10000.intr.linkPollTime'' properties. Zero disables polling. */
+#define FM_AAK_API_INTR_POLL_BUDGET             "api.intr.pollBudget"
+#define FM_AAT_API_INTR_POLL_BUDGET             FM_API_ATTR_INT
+#define FM_AAD_API_INTR_POLL_BUDGET             16
+
+/** Specifies the delay, in microseconds, between the polling passes of the
+ *  interrupt handler, as for ''api.intr.pollBudget''. */
+#define FM_AAK_API_INTR_POLL_INTERVAL           "api.intr.pollInterval"
+#define FM_AAT_API_INTR_POLL_INTERVAL           FM_API_ATTR_INT
+#define FM_AAD_API_INTR_POLL_INTERVAL           100
+
+/** Specifies the number of threads servicing the PCIe mailboxes. Each PEP
+ *  is always serviced by the same thread (PEP number modulo the number of
+ *  threads), so the requests of one host keep their order while the
+ *  mailboxes of other hosts are serviced in parallel. Zero services the
+ *  mailboxes from the interrupt handler thread. At most 8 threads are
+ *  created. */
+#define FM_AAK_API_MAILBOX_WORKER_THREADS       "api.mailbox.workerThreads"
+#define FM_AAT_API_MAILBOX_WORKER_THREADS       FM_API_ATTR_INT
+#define FM_AAD_API_MAILBOX_WORKER_THREADS       0
+
+/** Specifies whether the interrupt handler, MAC table maintenance and
+ *  packet receive tasks run as one thread per switch, each woken up by
+ *  its own semaphore, rather than as single threads serving all the
+ *  switches in turn. On multi-switch systems this keeps the work on one
+ *  switch from delaying the others. The global event handler is still
+ *  shared by all the switches. */
+#define FM_AAK_API_PER_SWITCH_TASKS             "api.perSwitchTasks"
+#define FM_AAT_API_PER_SWITCH_TASKS             FM_API_ATTR_BOOL
+#define FM_AAD_API_PER_SWITCH_TASKS             FALSE
+
 /** Indicates whether the API should collect VLAN statistics for internal
  *  ports in a switch aggregate. */
 #define FM_AAK_API_SWAG_INTERNAL_VLAN_STATS       "api.swag.internalPort.vlanStats"
@@ -576,8 +652,15 @@ typedef enum
 
 /* Specifies the method of receiving or injecting a packet into the fabric.
  * 'raw' to use the raw packet socket handling interface.  
+ * 'tpacket' to use the raw packet socket with memory-mapped TPACKET_V3
+ * RX and TX rings.
+ * 'xdp' to use an AF_XDP socket on queue 0 of the netdev, with the packet
+ * buffers as its UMEM, when the API is built with libxdp. Needs
+ * api.platform.bufferHugePages and an api.platform.bufferSize of 2048 or
+ * 4096.
  * 'pti' to use the PTI (Packet Test Interface) to inject or receive packets 
- * via the FIBM port. */
+ * via the FIBM port.
+ * The 'raw' interface is used if 'tpacket' or 'xdp' cannot be initialized. */
 #define FM_AAK_API_PLATFORM_PKT_INTERFACE       "api.platform.pktInterface"
 #define FM_AAT_API_PLATFORM_PKT_INTERFACE       FM_API_ATTR_TEXT
 #define FM_AAD_API_PLATFORM_PKT_INTERFACE       "raw"
@@ -705,6 +788,14 @@ typedef enum
 #define FM_AAT_API_MULTICAST_HNI_FLOODING              FM_API_ATTR_BOOL
 #define FM_AAD_API_MULTICAST_HNI_FLOODING              TRUE
 
+/* Time window, in milliseconds, within which multicast flooding changes
+ * requested for virtual ports are coalesced before the HNI flooding
+ * multicast groups are updated. The pending changes are applied by the
+ * fast maintenance task. Set to 0 to update the groups immediately. */
+#define FM_AAK_API_MULTICAST_HNI_FLOOD_COALESCE        "api.multicast.hni.floodCoalesceTime"
+#define FM_AAT_API_MULTICAST_HNI_FLOOD_COALESCE        FM_API_ATTR_INT
+#define FM_AAD_API_MULTICAST_HNI_FLOOD_COALESCE        20
+
 /* Specifies maximum number of MAC table entries per PEP port added 
  * on driver demand. */
 #define FM_AAK_API_HNI_MAC_ENTRIES_PER_PEP       "api.hni.macEntriesPerPep"
@@ -764,6 +855,120 @@ typedef enum
 #define FM_AAT_API_HNI_FLOW_ENTRIES_VF           FM_API_ATTR_INT
 #define FM_AAD_API_HNI_FLOW_ENTRIES_VF           64
 
+/* Specifies the maximum number of packets the raw packet socket transmit
+ * path hands to the kernel in a single sendmmsg() call. A value of 1
+ * selects the legacy one sendmsg() call per packet behavior. */
+#define FM_AAK_API_PLATFORM_RAW_SOCKET_TX_BATCH  "api.platform.rawSocket.txBatchSize"
+#define FM_AAT_API_PLATFORM_RAW_SOCKET_TX_BATCH  FM_API_ATTR_INT
+#define FM_AAD_API_PLATFORM_RAW_SOCKET_TX_BATCH  32
+
+/* Specifies the maximum number of frames the raw packet socket receive
+ * thread drains with a single recvmmsg() call per wakeup. A value of 1
+ * selects the legacy one recvmsg() call per wakeup behavior. */
+#define FM_AAK_API_PLATFORM_RAW_SOCKET_RX_BATCH  "api.platform.rawSocket.rxBatchSize"
+#define FM_AAT_API_PLATFORM_RAW_SOCKET_RX_BATCH  FM_API_ATTR_INT
+#define FM_AAD_API_PLATFORM_RAW_SOCKET_RX_BATCH  16
+
+/* Specifies the number of 64KB blocks in the RX ring of the 'tpacket'
+ * packet interface. */
+#define FM_AAK_API_PLATFORM_TPACKET_RX_BLOCKS    "api.platform.tpacket.rxBlockCount"
+#define FM_AAT_API_PLATFORM_TPACKET_RX_BLOCKS    FM_API_ATTR_INT
+#define FM_AAD_API_PLATFORM_TPACKET_RX_BLOCKS    64
+
+/* Specifies the number of 16KB frames in the TX ring of the 'tpacket'
+ * packet interface. Rounded down to a multiple of 4. */
+#define FM_AAK_API_PLATFORM_TPACKET_TX_FRAMES    "api.platform.tpacket.txFrameCount"
+#define FM_AAT_API_PLATFORM_TPACKET_TX_FRAMES    FM_API_ATTR_INT
+#define FM_AAD_API_PLATFORM_TPACKET_TX_FRAMES    256
+
+/* Specifies whether the 'tpacket' packet interface collects the hardware
+ * transmit timestamp of every frame from its TX ring. The timestamps are
+ * retrieved with fmPlatformGetTxTimestamps. Requires a build with
+ * ENABLE_TIMESTAMP. */
+#define FM_AAK_API_PLATFORM_TPACKET_TX_TIMESTAMPS  "api.platform.tpacket.txTimestamps"
+#define FM_AAT_API_PLATFORM_TPACKET_TX_TIMESTAMPS  FM_API_ATTR_BOOL
+#define FM_AAD_API_PLATFORM_TPACKET_TX_TIMESTAMPS  FALSE
+
+/* Specifies the number of entries in the software TX packet queue shared by
+ * the generic packet send paths and the packet interface drain. */
+#define FM_AAK_API_PLATFORM_PKT_QUEUE_SIZE       "api.platform.pktQueueSize"
+#define FM_AAT_API_PLATFORM_PKT_QUEUE_SIZE       FM_API_ATTR_INT
+#define FM_AAD_API_PLATFORM_PKT_QUEUE_SIZE       256
+
+/* Specifies the size in bytes of each packet buffer, rounded up to a
+ * multiple of 4. A value that holds a full jumbo frame lets every
+ * received frame fit in a single buffer. */
+#define FM_AAK_API_PLATFORM_BUFFER_SIZE           "api.platform.bufferSize"
+#define FM_AAT_API_PLATFORM_BUFFER_SIZE           FM_API_ATTR_INT
+#define FM_AAD_API_PLATFORM_BUFFER_SIZE           FM_BUFFER_SIZE_BYTES
+
+/* Specifies the number of packet buffers allocated when the separate
+ * RX and TX buffer pools are disabled. */
+#define FM_AAK_API_PLATFORM_NUM_BUFFERS           "api.platform.numBuffers"
+#define FM_AAT_API_PLATFORM_NUM_BUFFERS           FM_API_ATTR_INT
+#define FM_AAD_API_PLATFORM_NUM_BUFFERS           FM_NUM_BUFFERS
+
+/* Specifies whether the packet buffer memory is backed by 2MB huge
+ * pages, pre-faulted at initialization. The memory is then private to
+ * the process that initializes the platform and its children. */
+#define FM_AAK_API_PLATFORM_BUFFER_HUGE_PAGES     "api.platform.bufferHugePages"
+#define FM_AAT_API_PLATFORM_BUFFER_HUGE_PAGES     FM_API_ATTR_BOOL
+#define FM_AAD_API_PLATFORM_BUFFER_HUGE_PAGES     FALSE
+
+/* Specifies whether the global event queue and the free event queue are
+ * implemented as lock-free rings of preallocated slots rather than as
+ * lists guarded by a lock. The queues are created before the platform
+ * reads its configuration file, so this property must be set with
+ * fmSetApiProperty after fmOSInitialize and before fmInitialize. */
+#define FM_AAK_API_EVENT_RING_QUEUES              "api.event.ringQueues"
+#define FM_AAT_API_EVENT_RING_QUEUES              FM_API_ATTR_BOOL
+#define FM_AAD_API_EVENT_RING_QUEUES              FALSE
+
+/* Specifies whether ALOS locks use an uncontended atomic fast path with a
+ * futex fallback instead of an operating system mutex. Such locks skip
+ * lock precedence checking. The mode of a lock is fixed when it is
+ * created, so locks created before the platform reads its configuration
+ * file follow the value set with fmSetApiProperty after fmOSInitialize.
+ * The default is set by FM_LOCK_FAST_PATH at build time. */
+#define FM_AAK_API_LOCK_FAST_PATH                 "api.lock.fastPath"
+#define FM_AAT_API_LOCK_FAST_PATH                 FM_API_ATTR_BOOL
+#define FM_AAD_API_LOCK_FAST_PATH                 FM_LOCK_FAST_PATH
+
+/* Specifies the CPU affinity, scheduling policy and NUMA memory node of
+ * threads created with fmCreateThread, by thread name. The value is a
+ * list of entries separated by semicolons, each of the form
+ * "<threadName>:<setting> <setting> ...", where a setting is one of
+ * "cpus=<list>" (e.g. "2-3,6"), "sched=fifo|rr|other", "priority=<n>" and
+ * "node=<n>". For example:
+ * "PacketReceiveTask:cpus=2-3 sched=fifo priority=10 node=0;
+ *  InterruptHandlerTask:cpus=1".
+ * Threads not listed keep the default placement. The placement is applied
+ * when a thread starts, so threads created before the platform reads its
+ * configuration file follow the value set with fmSetApiProperty after
+ * fmOSInitialize. See fmDbgDumpThreadPlacement. */
+#define FM_AAK_API_THREAD_PLACEMENT               "api.thread.placement"
+#define FM_AAT_API_THREAD_PLACEMENT               FM_API_ATTR_TEXT
+#define FM_AAD_API_THREAD_PLACEMENT               ""
+
+/* Path of a file holding a snapshot of the register cache. When set, the
+ * register cache is saved to this file when the switch is removed, and
+ * reloaded from it when the switch is next initialized: the snapshot is
+ * verified against the hardware and any registers that differ are
+ * rewritten from it, so that the register writes made while initializing
+ * the switch are skipped wherever the cache already holds the value being
+ * written. A missing or mismatched snapshot is ignored. An empty value
+ * disables the snapshot. */
+#define FM_AAK_API_REG_CACHE_SNAPSHOT_FILE        "api.regCache.snapshotFile"
+#define FM_AAT_API_REG_CACHE_SNAPSHOT_FILE        FM_API_ATTR_TEXT
+#define FM_AAD_API_REG_CACHE_SNAPSHOT_FILE        ""
+
+/* Path of a file to which the boot phase profile of a switch is written
+ * once the switch is up, in the folded stack format read by flame graph
+ * tools. See fmDbgDumpBootPhases. An empty value disables the file. */
+#define FM_AAK_API_DEBUG_BOOT_PROFILE_FILE        "api.debug.bootProfileFile"
+#define FM_AAT_API_DEBUG_BOOT_PROFILE_FILE        FM_API_ATTR_TEXT
+#define FM_AAD_API_DEBUG_BOOT_PROFILE_FILE        ""
+
 /************************************************************************
  ****                                                                ****
  ****              END UNDOCUMENTED API PROPERTIES                   ****
@@ -789,6 +994,15 @@ fm_bool fmGetBoolApiProperty(fm_text key, fm_bool defaultValue);
 fm_float fmGetFloatApiProperty(fm_text key, fm_float defaultValue);
 fm_text fmGetTextApiProperty(fm_text key, fm_text defaultValue);
 
+/* Precompiled property handles for lock-free reads of properties that do
+ * not change after initialization. */
+fm_int fmGetApiPropertyHandle(fm_text key);
+fm_status fmGetApiPropertyByHandle(fm_int         handle,
+                                   fm_apiAttrType attrType,
+                                   void *         value);
+fm_int fmGetIntApiPropertyByHandle(fm_int handle, fm_int defaultValue);
+fm_bool fmGetBoolApiPropertyByHandle(fm_int handle, fm_bool defaultValue);
+
 void fmDbgDumpApiProperties(void);
 
 
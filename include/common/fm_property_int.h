@@ -71,6 +71,10 @@ typedef struct _fm_property
     /* Timeout (millisecond) value for the semaphore blocking on event free */
     fm_int  eventSemTimeout;
 
+    /* Free events reserved for port and mailbox events */
+    fm_int  eventLinkReserve;
+    fm_int  eventMailboxReserve;
+
     /* Received packets are to be queued directly to the application */
     fm_bool rxDirectEnqueueing;
 
@@ -101,6 +105,23 @@ typedef struct _fm_property
     /* Maximum number of TCN FIFO entries to be processed in a single cycle */
     fm_int  maTcnFifoBurstSize;
 
+    /* Maximum number of entries and time (usec) per MA purge slice */
+    fm_int  maMaintSliceEntries;
+    fm_int  maMaintSliceTime;
+
+    /* Number of changes held by the MA table change journal */
+    fm_int  maJournalSize;
+
+    /* Maximum number of polling passes and delay (usec) between them */
+    fm_int  intrPollBudget;
+    fm_int  intrPollInterval;
+
+    /* Number of threads servicing the PCIe mailboxes */
+    fm_int  mailboxWorkerThreads;
+
+    /* Run the interrupt, maintenance and receive tasks per switch */
+    fm_bool perSwitchTasks;
+
     /* Collect VLAN statistics for internal ports */
     fm_bool swagIntVlanStats;
 
@@ -272,6 +293,9 @@ typedef struct _fm_property
     /* Create multicast groups on HNI request as flooding ones */
     fm_bool hniMcastFlooding;
 
+    /* Window for coalescing HNI flooding group updates, in msec */
+    fm_int  hniMcastFloodCoalesceTime;
+
     /* Maximum number of MAC table entries per PEP port */
     fm_int  hniMacEntriesPerPep;
 
@@ -308,6 +332,48 @@ typedef struct _fm_property
     /* Number of GloRTs per PEP port */
     fm_int  hniGlortsPerPep;
 
+    /* Maximum number of packets sent per raw socket sendmmsg() call */
+    fm_int  rawSocketTxBatchSize;
+
+    /* Maximum number of frames received per raw socket recvmmsg() call */
+    fm_int  rawSocketRxBatchSize;
+
+    /* Number of blocks in the TPACKET_V3 RX ring */
+    fm_int  tpacketRxBlockCount;
+
+    /* Number of frames in the TPACKET_V3 TX ring */
+    fm_int  tpacketTxFrameCount;
+
+    /* Collect hardware TX timestamps from the TPACKET_V3 TX ring */
+    fm_bool tpacketTxTimestamps;
+
+    /* Number of entries in the software TX packet queue */
+    fm_int  pktQueueSize;
+
+    /* Size in bytes of each packet buffer */
+    fm_int  bufferSize;
+
+    /* Number of packet buffers when the buffer pool is shared */
+    fm_int  numBuffers;
+
+    /* Whether the packet buffer memory is backed by huge pages */
+    fm_bool bufferHugePages;
+
+    /* Whether the event queues are lock-free rings */
+    fm_bool eventRingQueues;
+
+    /* Whether new locks use the futex-based fast path */
+    fm_bool lockFastPath;
+
+    /* CPU affinity, scheduling and NUMA node of threads, by thread name */
+    fm_char threadPlacement[256];
+
+    /* Register cache snapshot file */
+    fm_char regCacheSnapshotFile[256];
+
+    /* Boot phase profile file */
+    fm_char bootProfileFile[256];
+
 } fm_property;
 
 
@@ -42,6 +42,12 @@
 #define FM_STATE_UNSPECIFIED  -1
 #define FM_EVENT_UNSPECIFIED  -1
 
+/* Coalescing group of events that are never coalesced */
+#define FM_SM_COALESCE_GROUP_NONE -1
+
+/* Maximum number of events queued in a batch before it is flushed */
+#define FM_SM_MAX_BATCH_EVENTS    64
+
 /***********************************************************/
 /** \ingroup typeStruct
  * Definition of the generic State Machine Event info header 
@@ -175,6 +181,50 @@ typedef enum
 typedef void *fm_smHandle;
 
 
+/**************************************************/
+/** \ingroup typeStruct
+ * State machine event queued in a batch
+ **************************************************/
+typedef struct _fm_smBatchEvent
+{
+    /** handle of the state machine */
+    fm_smHandle    handle;
+
+    /** copy of the generic event descriptor */
+    fm_smEventInfo eventInfo;
+
+    /** purpose-specific event info */
+    void          *userInfo;
+
+    /** purpose-specific data to save in the transition record */
+    void          *recordData;
+
+    /** coalescing group of the event */
+    fm_int         group;
+
+} fm_smBatchEvent;
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ * Batch of state machine events processed in a
+ * single pass
+ **************************************************/
+typedef struct _fm_smEventBatch
+{
+    /** number of queued events */
+    fm_int          nrEvents;
+
+    /** number of events dropped because superseded, since the batch was
+     *  initialized */
+    fm_int          nrCoalesced;
+
+    /** queued events, in queuing order */
+    fm_smBatchEvent events[FM_SM_MAX_BATCH_EVENTS];
+
+} fm_smEventBatch;
+
+
 /* Declaration of a function to initialize the state machine engine */
 fm_status fmInitStateMachineEngine( fm_timestamp       *initTime,
                                     fm_smTimestampMode  mode );
@@ -223,6 +273,22 @@ fm_status fmNotifyStateMachineEvent( fm_smHandle     handle,
                                      void           *userInfo,
                                      void           *dataToLog );
 
+/* Declaration of functions to notify state machine events in batches */
+fm_status fmInitStateMachineEventBatch( fm_smEventBatch *batch );
+fm_status fmQueueStateMachineEvent( fm_smEventBatch *batch,
+                                    fm_smHandle      handle,
+                                    fm_smEventInfo  *eventInfo,
+                                    void            *userInfo,
+                                    void            *recordData );
+fm_status fmFlushStateMachineEventBatch( fm_smEventBatch *batch );
+fm_status fmSetStateMachineEventCoalesceGroup( fm_int smType,
+                                               fm_int eventId,
+                                               fm_int group );
+
+/* Declaration of a function to set the log categories of a type */
+fm_status fmSetStateTransitionLogCategories( fm_int    smType,
+                                             fm_uint64 categories );
+
 /* Declaration of a function to return the current state of a state machine */
 fm_status fmGetStateMachineCurrentState( fm_smHandle  handle,
                                          fm_int      *state );
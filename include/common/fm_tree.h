@@ -48,6 +48,15 @@ typedef void (*fmDeletingFunc)(const void *key, void *value,
                                const void *prevKey, void *prevValue,
                                const void *nextKey, void *nextValue);
 
+/* Supplies the next key/value pair to a bulk load, in ascending key order.
+ * Returns FM_OK, or FM_ERR_NO_MORE once the input is exhausted. */
+typedef fm_status (*fmTreeLoadFunc)(void *loadArg,
+                                    fm_uint64 *key,
+                                    void **value);
+typedef fm_status (*fmCustomTreeLoadFunc)(void *loadArg,
+                                          void **key,
+                                          void **value);
+
 /* a typedef'd union in which an application can store a discrete value for
  * portable storage into a tree. */
 typedef union
@@ -77,7 +86,12 @@ typedef union
 /* private types */
 
 struct _fm_treeNode;
+struct _fm_btreeNode;
+
+/* see fm_alos_arena.h, the ALOS headers are included after this one */
+struct _fm_arena;
 typedef struct _fm_treeNode    fm_treeNode;
+typedef struct _fm_btreeNode   fm_btreeNode;
 
 
 typedef struct _fm_internalTree
@@ -85,9 +99,16 @@ typedef struct _fm_internalTree
     /** TRUE if the tree is a custom tree */
     fm_bool        customTree;
 
+    /** TRUE if the tree is a B+tree with wide nodes rather than a
+     *  red-black tree with one node per key. */
+    fm_bool        btree;
+
     /** Root node */
     fm_treeNode *  root;
 
+    /** Root node of a B+tree. */
+    fm_btreeNode * btreeRoot;
+
     /** Incremented with each change, to implement fail-fast iterators. */
     fm_uint        serial;
 
@@ -100,6 +121,10 @@ typedef struct _fm_internalTree
     /** Function to free a tree node. */
     fmFreeFunc     freeFunc;
 
+    /** Arena tree nodes are allocated from instead of allocFunc, in which
+     *  case they are only freed with the arena. May be null. */
+    struct _fm_arena *arena;
+
     /** Optional function to be executed immediately after an insert
      *  operation. May be null. */
     fmInsertedFunc insertFunc;
@@ -132,6 +157,8 @@ typedef struct _fm_internalTreeIterator
 {
     fm_internalTree *tree;
     fm_treeNode *    nextPtr;
+    fm_btreeNode *   nextLeaf;
+    fm_int           nextIndex;
     fm_uint          serial;
     fm_dir           dir;
 
@@ -179,13 +206,21 @@ void fmTreeInit(fm_tree *tree);
 void fmTreeInitWithAllocator(fm_tree *   tree,
                              fmAllocFunc allocFunc,
                              fmFreeFunc  freeFunc);
+void fmTreeInitWithArena(fm_tree *tree, struct _fm_arena *arena);
+void fmTreeInitBtree(fm_tree *tree);
 void fmTreeDestroy(fm_tree *tree, fmFreeFunc delfunc);
 fm_status fmTreeClone(fm_tree *srcTree,
                       fm_tree *dstTree,
                       fmCloneFunc cloneFunc,
                       void *cloneFuncArg);
+fm_status fmTreeBulkLoad(fm_tree *      tree,
+                         fm_uint        numItems,
+                         fmTreeLoadFunc loadFunc,
+                         void *         loadArg);
 fm_uint fmTreeSize(fm_tree *tree);
+fm_uint fmTreeGeneration(fm_tree *tree);
 fm_bool fmTreeIsInitialized(fm_tree *tree);
+fm_uint64 fmTreeMemoryUsage(fm_tree *tree);
 fm_status fmTreeValidate(fm_tree *tree);
 fm_status fmTreeInsert(fm_tree *tree, fm_uint64 key, void *value);
 fm_status fmTreeRemove(fm_tree *tree, fm_uint64 key, fmFreeFunc delfunc);
@@ -210,6 +245,9 @@ fm_status fmTreeIterInitFromKeyBackwards(fm_treeIterator *it,
 fm_status fmTreeIterInitFromSuccessor(fm_treeIterator *it,
                                       fm_tree *        tree,
                                       fm_uint64        key);
+void fmTreeIterInitAfterKey(fm_treeIterator *it,
+                            fm_tree *        tree,
+                            fm_uint64        key);
 fm_status fmTreeIterNext(fm_treeIterator *it,
                          fm_uint64 *      nextKey,
                          void **          nextValue);
@@ -224,12 +262,22 @@ void fmCustomTreeInitWithAllocator(fm_customTree *tree,
                                    fmCompareFunc  compareFunc,
                                    fmAllocFunc    allocFunc,
                                    fmFreeFunc     freeFunc);
+void fmCustomTreeInitWithArena(fm_customTree *   tree,
+                               fmCompareFunc     compareFunc,
+                               struct _fm_arena *arena);
+void fmCustomTreeInitBtree(fm_customTree *tree, fmCompareFunc compareFunc);
 void fmCustomTreeRequestCallbacks(fm_customTree *tree,
                                   fmInsertedFunc insertFunc,
                                   fmDeletingFunc deleteFunc);
 void fmCustomTreeDestroy(fm_customTree *tree, fmFreePairFunc delfunc);
+fm_status fmCustomTreeBulkLoad(fm_customTree *      tree,
+                               fm_uint              numItems,
+                               fmCustomTreeLoadFunc loadFunc,
+                               void *               loadArg);
 fm_uint fmCustomTreeSize(fm_customTree *tree);
+fm_uint fmCustomTreeGeneration(fm_customTree *tree);
 fm_bool fmCustomTreeIsInitialized(fm_customTree *tree);
+fm_uint64 fmCustomTreeMemoryUsage(fm_customTree *tree);
 fm_status fmCustomTreeValidate(fm_customTree *tree);
 fm_status fmCustomTreeInsert(fm_customTree *tree, void *key, void *value);
 fm_status fmCustomTreeRemove(fm_customTree *tree,
@@ -256,6 +304,9 @@ fm_status fmCustomTreeIterInitFromKey(fm_customTreeIterator *it,
 fm_status fmCustomTreeIterInitFromSuccessor(fm_customTreeIterator *it,
                                             fm_customTree *        tree,
                                             const void *           key);
+void fmCustomTreeIterInitAfterKey(fm_customTreeIterator *it,
+                                  fm_customTree *        tree,
+                                  const void *           key);
 fm_status fmCustomTreeIterNext(fm_customTreeIterator *it,
                                void **                nextKey,
                                void **                nextValue);
@@ -103,6 +103,25 @@ typedef enum
 
 
 
+/*****************************************************************************/
+/** \ingroup typeEnum
+ *  Output formats of ''fmDbgStreamRegisters''.
+ *****************************************************************************/
+typedef enum
+{
+    /** One line of comma-separated values per register entry, with the
+     *  register name and indexes, address, word count and words. */
+    FM_DBG_REG_STREAM_CSV = 0,
+
+    /** Fixed-size binary records in host byte order, which can be decoded
+     *  offline field by field. */
+    FM_DBG_REG_STREAM_BINARY
+
+}   fm_dbgRegStreamFormat;
+
+
+
+
 /*****************************************************************************/
 /** \ingroup typeEnum
  *  Identifies individual diagnostic counters. Used as an argument to
@@ -178,6 +197,11 @@ typedef enum
      *  \chips  FM10000 */
     FM_CTR_RX_PKT_DROPS_SV_EVENT,
 
+    /** Incremented when the user part receives a packet, but drops it
+     *  because it matched a receive packet filter.
+     *  \chips  FM10000 */
+    FM_CTR_RX_PKT_DROPS_FILTER,
+
     /** Incremented when the user part receives a pkt, but unable to
      *  match to a logical port. */
     FM_CTR_RX_PKT_DROPS_NO_PORT,
@@ -259,6 +283,10 @@ typedef enum
     /** Incremented when a learn event is discarded by the event handler. */
     FM_CTR_MAC_LEARN_DISCARDED,
 
+    /** Incremented when a new source address is dropped by the learning
+     *  rate limiter. */
+    FM_CTR_MAC_LEARN_THROTTLED,
+
     /**************************************************
      * MA Table Age Events
      **************************************************/
@@ -520,6 +548,12 @@ typedef enum
      *  change. */
     FM_CTR_LINK_CHANGE_OUT_OF_EVENTS,
 
+    /** Incremented when a LAG member that lost link is removed from the
+     *  LAG's hash distribution by the link down fast path (see
+     *  ''api.FM10000.lag.fastFailover'').
+     *  \chips  FM10000 */
+    FM_CTR_LINK_CHANGE_LAG_FAST_FAILOVER,
+
     /**************************************************
      * Timestamp events
      **************************************************/
@@ -669,6 +703,12 @@ typedef enum
      *  \chips  FM4000, FM6000, FM10000 */
     FM_CTR_PARITY_EVENT_LOST,
 
+    /** Incremented by the number of SRAM_ERR and CRM memory errors that
+     *  were counted in a coalescing window instead of being decoded
+     *  individually.
+     *  \chips  FM10000 */
+    FM_CTR_PARITY_COALESCED,
+
     /**************************************************
      * Parity Repair events
      **************************************************/
@@ -713,6 +753,54 @@ typedef enum
      *  is not delivered to local handler. */
     FM_CTR_LOW_PRI_PKT_EVENT_NOT_DELIVERED,
 
+    /**************************************************
+     * Raw packet socket transmit batching
+     **************************************************/
+
+    /** Incremented when a batch of packets is handed to the kernel with a
+     *  single sendmmsg() call or TPACKET_V3 TX ring kick. */
+    FM_CTR_TX_BATCH_FLUSH,
+
+    /** Incremented by the number of packets accepted by the kernel in a
+     *  batched send. Dividing by ''FM_CTR_TX_BATCH_FLUSH'' gives the
+     *  average batch size. */
+    FM_CTR_TX_BATCH_PKTS,
+
+    /** Incremented when sendmmsg() accepts only part of a batch. */
+    FM_CTR_TX_BATCH_PARTIAL,
+
+    /**************************************************
+     * Raw packet socket receive batching
+     **************************************************/
+
+    /** Incremented when the receive thread drains a batch of frames, either
+     *  with a single recvmmsg() call or from one TPACKET_V3 ring block. */
+    FM_CTR_RX_BATCH_DRAIN,
+
+    /** Incremented by the number of frames returned by a batched receive.
+     *  Dividing by ''FM_CTR_RX_BATCH_DRAIN'' gives the average number of
+     *  frames per wakeup. */
+    FM_CTR_RX_BATCH_PKTS,
+
+    /** Incremented when a batched receive fills every pre-posted buffer
+     *  chain, meaning more frames may still be pending in the socket. */
+    FM_CTR_RX_BATCH_FULL,
+
+    /**************************************************
+     * Interrupt polling
+     **************************************************/
+
+    /** Incremented when the interrupt task starts polling a switch with
+     *  its interrupt masked instead of re-enabling it. */
+    FM_CTR_INTR_POLL_START,
+
+    /** Incremented for each polling pass made by the interrupt task. */
+    FM_CTR_INTR_POLL_PASS,
+
+    /** Incremented when a polling pass finds an interrupt type that
+     *  restarts the polling window. */
+    FM_CTR_INTR_POLL_HIT,
+
     /* ----  Add new entries above this line.  ---- */
 
     /** UNPUBLISHED: Number of entries in the switch counter array. */
@@ -750,6 +838,28 @@ typedef enum
 
 
 
+/*****************************************************************************/
+/** \ingroup typeEnum
+ * Prefix distributions of the routes added by ''fmDbgRouteBenchmark''.
+ *****************************************************************************/
+typedef enum
+{
+    /** IPv4 prefixes whose lengths follow the mix of an Internet BGP table,
+     *  most of them /24. */
+    FM_DBG_ROUTE_BENCH_BGP_MIX = 0,
+
+    /** Consecutive /24 prefixes. */
+    FM_DBG_ROUTE_BENCH_SEQUENTIAL,
+
+    /** Random IPv4 prefixes with lengths from /8 to /32. */
+    FM_DBG_ROUTE_BENCH_RANDOM,
+
+    /** UNPUBLISHED: For internal use only. */
+    FM_DBG_ROUTE_BENCH_MAX
+
+} fm_dbgRouteBenchMix;
+
+
 /*****************************************************************************/
 /** \ingroup typeEnum
  * A global set of diagnostic counters are kept for:
@@ -799,6 +909,10 @@ typedef enum
     /** Incremented when a buffer queue node is freed. */
     FM_GLOBAL_CTR_BUFFER_QUEUE_NODE_FREES,
 
+    /** Incremented when a request for an event is refused because the
+     *  remaining free events are reserved for port or mailbox events. */
+    FM_GLOBAL_CTR_EVENT_RESERVED,
+
     /* ----  Add new entries above this line.  ---- */
 
     /** Used internally as the length of the global counter array. */
@@ -849,6 +963,81 @@ typedef struct _fm_eyeDiagramSample
 } fm_eyeDiagramSample;
 
 
+/**************************************************/
+/** \ingroup typeStruct
+ *  Summary eye metrics of a single SerDes lane,
+ *  reported by ''fmDbgTakeEyeMetrics'' and stored
+ *  in the file it writes.
+ **************************************************/
+typedef struct _fm_eyeMetric
+{
+    /** SerDes number. */
+    fm_int    serdes;
+
+    /** Logical port the SerDes belongs to, or -1 if it is not mapped. */
+    fm_int    port;
+
+    /** Eye height score in the range [0..64], or -1 if it could not be
+     *  measured. */
+    fm_int    eyeScore;
+
+    /** Eye height in mV. */
+    fm_int    heightmV;
+
+    /** Eye width, or -1 if the device cannot measure it. */
+    fm_int    width;
+
+    /** Status of the measurement. */
+    fm_status status;
+
+} fm_eyeMetric;
+
+
+/** Number of log2 buckets of the API latency histograms. Bucket i counts
+ *  the times t, in nanoseconds, with 2^(i-1) <= t < 2^i. Bucket 0 counts
+ *  zero times and the last bucket everything beyond. */
+#define FM_API_PROF_HIST_BUCKETS        32
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ *  Call count and latency profile of one API
+ *  function, used as an argument to
+ *  ''fmDbgGetApiProfile''. All times are in
+ *  nanoseconds.
+ **************************************************/
+typedef struct _fm_apiProfileEntry
+{
+    /** Name of the API function. */
+    const char *name;
+
+    /** Number of calls made while profiling was enabled. */
+    fm_uint64   calls;
+
+    /** Number of those calls that returned an error. */
+    fm_uint64   errors;
+
+    /** Sum of the call durations. */
+    fm_uint64   totalTime;
+
+    /** Longest call duration. */
+    fm_uint64   maxTime;
+
+    /** Sum of the time spent waiting for the switch lock. */
+    fm_uint64   totalWait;
+
+    /** Longest wait for the switch lock within a single call. */
+    fm_uint64   maxWait;
+
+    /** Histogram of the call durations. */
+    fm_uint64   timeHist[FM_API_PROF_HIST_BUCKETS];
+
+    /** Histogram of the switch lock wait within each call. */
+    fm_uint64   waitHist[FM_API_PROF_HIST_BUCKETS];
+
+} fm_apiProfileEntry;
+
+
 
 /***************************************************
  * All public debug functions.
@@ -901,6 +1090,62 @@ void fmDbgRegisterUpdate(fm_int    sw,
                                 fm_uint32 regOffset,
                                 fm_uint32 regValue);
 
+/* Register access profiling */
+fm_status fmDbgStartRegProfile(fm_int sw, fm_int samplePeriod);
+fm_status fmDbgStopRegProfile(fm_int sw);
+fm_status fmDbgDumpRegProfile(fm_int sw, fm_int maxEntries);
+fm_status fmDbgResetRegProfile(fm_int sw);
+
+/* API call latency profiling */
+fm_status fmDbgEnableApiProfile(fm_bool enable);
+fm_status fmDbgDumpApiProfile(fm_int maxEntries);
+fm_status fmDbgResetApiProfile(void);
+fm_status fmDbgGetApiProfile(fm_int              maxEntries,
+                             fm_apiProfileEntry *entries,
+                             fm_int *            numEntries);
+
+/* Global event handler statistics */
+fm_status fmDbgDumpGlobalEventStats(void);
+fm_status fmDbgResetGlobalEventStats(void);
+fm_status fmGetEventQueueStats(fm_text queueName, fm_eventQueueStats *stats);
+fm_status fmResetEventQueueStats(fm_text queueName);
+
+/* Switch bring-up timeline */
+fm_status fmDbgDumpBootPhases(fm_int sw, fm_text fileName);
+
+/* Route programming benchmark */
+fm_status fmDbgRouteBenchmark(fm_int    sw,
+                              fm_int    vrid,
+                              fm_int    numRoutes,
+                              fm_int    mix,
+                              fm_int    numEcmpGroups,
+                              fm_uint32 seed,
+                              fm_bool   stubRegisters);
+
+/* ACL compile and apply benchmark */
+fm_status fmDbgAclBenchmark(fm_int    sw,
+                            fm_int    firstAcl,
+                            fm_int    numAcls,
+                            fm_int    numRules,
+                            fm_uint32 seed);
+
+/* Packet I/O benchmark */
+fm_status fmDbgPacketBenchmark(fm_int sw,
+                               fm_int port,
+                               fm_int numFrames,
+                               fm_int frameSize);
+fm_status fmDbgPacketRxLatencyStart(fm_int maxSamples);
+fm_status fmDbgPacketRxLatencyStop(void);
+
+/* ALOS primitive micro-benchmarks */
+fm_status fmDbgAlosBenchmark(fm_int iterations, fm_int maxThreads);
+
+/* MAC address subsystem scale benchmark */
+fm_status fmDbgMacBenchmark(fm_int sw,
+                            fm_int port,
+                            fm_int vlanID,
+                            fm_int numAddresses);
+
 /* Memory and buffer management */
 fm_status fmDbgBfrDump(fm_int sw);
 fm_status fmDbgDumpDeviceMemoryStats(int sw);
@@ -920,6 +1165,10 @@ fm_status fmDbgDumpRegisterV3(fm_int  sw,
 void fmDbgListRegisters(fm_int  sw,
                         fm_bool showGlobals,
                         fm_bool showPorts);
+fm_status fmDbgStreamRegisters(fm_int                sw,
+                               fm_text               regName,
+                               fm_text               fileName,
+                               fm_dbgRegStreamFormat format);
 void fmDbgGetRegisterName(fm_int   sw,
                           fm_int   regId,
                           fm_uint  regAddress,
@@ -975,6 +1224,9 @@ void fmDbgTakeChipSnapshot(fm_int sw, fm_int snapshot);
 void fmDbgDeleteChipSnapshot(fm_int snapshot);
 void fmDbgPrintChipSnapshot(fm_int snapshot, fm_bool showZeroValues);
 void fmDbgCompareChipSnapshots(fm_uint snapshotMask);
+void fmDbgDiffChipSnapshots(fm_int snapshot1, fm_int snapshot2);
+fm_status fmDbgExportChipSnapshot(fm_int snapshot, fm_text fileName);
+fm_status fmDbgImportChipSnapshot(fm_int snapshot, fm_text fileName);
 
 /* Timer management */
 void fmDbgTimerDump(void);
@@ -1158,6 +1410,7 @@ void fmDbgEventQueueCreated(fm_eventQueue *inQueue);
 void fmDbgEventQueueDestroyed(fm_eventQueue *inQueue);
 void fmDbgEventQueueEventPopped(fm_eventQueue *inQueue, fm_event *event);
 void fmDbgEventQueueDump(void);
+fm_eventQueue *fmDbgEventQueueFind(fm_text name);
 
 
 /* Switch insertion/removal debug API
@@ -1206,6 +1459,42 @@ fm_status fmDbgDumpPortIdxMap(fm_int sw, fm_int port, fm_int attr);
 fm_status fmDbgDumpPolicers(fm_int sw);
 void fmDbgDumpStatChanges(fm_int sw, fm_bool resetCopy);
 
+#if FM_API_PROFILING
+/* TRUE while API latency profiling is enabled in this process */
+extern fm_bool fmApiProfEnabled;
+
+/* Number of profiled API calls in progress on the calling thread */
+extern __thread fm_int fmApiProfDepth;
+
+void fmDbgApiProfEnter(const char *funcName);
+void fmDbgApiProfExit(const char *funcName, fm_status err);
+fm_status fmDbgApiProfCaptureLock(fm_rwLock *lck, fm_bool write);
+
+/* Opens a profiled call, invoked from FM_LOG_ENTRY_API */
+#define FM_DBG_API_PROF_ENTRY()                                 \
+    if (fmApiProfEnabled)                                       \
+    {                                                           \
+        fmDbgApiProfEnter(__func__);                            \
+    }
+
+/* Closes a profiled call, invoked from FM_LOG_EXIT_API. A call opened
+ * before profiling was disabled is still closed. */
+#define FM_DBG_API_PROF_EXIT(errcode)                           \
+    if (fmApiProfDepth > 0)                                     \
+    {                                                           \
+        fmDbgApiProfExit(__func__, (errcode));                  \
+    }
+
+/* TRUE if the calling thread is inside a profiled call */
+#define FM_DBG_API_PROF_ACTIVE()    (fmApiProfDepth > 0)
+
+#else
+#define FM_DBG_API_PROF_ENTRY()
+#define FM_DBG_API_PROF_EXIT(errcode)
+#define FM_DBG_API_PROF_ACTIVE()    FALSE
+#endif
+
+
 /* this is defined outside the conditional below because it is called from the test 
    enviroment using an expert call. The function will be empty if FM_API_FUNCTION_TRACKING is 
    not define.
@@ -1257,6 +1546,14 @@ fm_status fmDbgTakeEyeDiagram( fm_int sw,
 
 fm_status fmDbgDeleteEyeDiagram( fm_int eyeDiagramId );
 
+fm_status fmDbgTakeEyeMetrics( fm_int  sw,
+                               fm_int  maxLanesPerRing,
+                               fm_text fileName );
+
+fm_status fmDbgGetEyeMetricsProgress( fm_int  *lanesDone,
+                                      fm_int  *numLanes,
+                                      fm_bool *active );
+
 fm_status fmDbgGetEyeDiagramSampleFirst( fm_int eyeDiagramId, 
                                          fm_eyeDiagramSample *sample );
 
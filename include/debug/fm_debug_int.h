@@ -89,6 +89,27 @@ typedef fm_bool (*fm_regDumpCallback)(fm_int    sw,
                                       fm_voidptr callbackInfo);
 
 
+/**************************************************/
+/** \ingroup intTypeScalar
+ * Callback invoked for each lane measured by the
+ * chip-specific eye metrics capture. Returns FALSE
+ * to stop the capture. Takes as arguments:
+ *                                                                      \lb\lb
+ * sw - The switch being measured.
+ *                                                                      \lb\lb
+ * numLanes - The total number of lanes in the
+ *            capture.
+ *                                                                      \lb\lb
+ * metric - The metrics of the lane.
+ *                                                                      \lb\lb
+ * callbackInfo - Cookie provided to callback.
+ **************************************************/
+typedef fm_bool (*fm_eyeMetricCallback)(fm_int              sw,
+                                        fm_int              numLanes,
+                                        const fm_eyeMetric *metric,
+                                        fm_voidptr          callbackInfo);
+
+
 /*****************************************************************************
  * Structures and Typedefs
  *****************************************************************************/
@@ -104,12 +125,41 @@ typedef struct
 
 } fmDbgFulcrumRegisterSnapshot;
 
+/* Run of consecutive snapshot entries of one register whose addresses are
+ * evenly spaced. Only the register values are stored per entry. */
 typedef struct
 {
-    fm_int                       sw;
-    fm_timestamp                 timestamp;
-    fm_int                       regCount;
-    fmDbgFulcrumRegisterSnapshot registers[FM_DBG_MAX_SNAPSHOT_REGS];
+    fm_int    regId;
+    fm_uint   regAddress;
+    fm_uint   addressStep;
+    fm_int    regSize;
+    fm_bool   isStatReg;
+
+    /* Snapshot index of the first entry of the run */
+    fm_int    firstEntry;
+    fm_int    numEntries;
+
+    /* Position in values of the first word of the run, every entry of
+     * the run takes regSize words. */
+    fm_int    firstWord;
+
+} fmDbgSnapshotRun;
+
+typedef struct
+{
+    fm_int            sw;
+    fm_timestamp      timestamp;
+    fm_int            regCount;
+
+    /* Entries, grouped in runs sorted by firstEntry */
+    fmDbgSnapshotRun *runs;
+    fm_int            numRuns;
+    fm_int            maxRuns;
+
+    /* Register values, 32-bit words in entry order */
+    fm_uint32 *       values;
+    fm_int            numWords;
+    fm_int            maxWords;
 
 } fmDbgFulcrumSnapshot;
 
@@ -126,6 +176,17 @@ typedef struct
 } fmDbgEyeDiagram;
 
 
+/* Progress of the eye metrics capture, read without locking by
+ * fmDbgGetEyeMetricsProgress while the capture runs */
+typedef struct
+{
+    volatile fm_bool active;
+    volatile fm_int  numLanes;
+    volatile fm_int  lanesDone;
+
+} fmDbgEyeMetricsProgress;
+
+
 #ifdef FM_DBG_NEED_TRACK_FUNC
 
 typedef struct
@@ -184,6 +245,11 @@ typedef struct
  * all words, except the event code must never be
  * 00000000 or FFFFFFFF, which are reserved for
  * future use.
+ *
+ * Each thread posts to its own ring of
+ * FM_DBG_TRACE_BFR_SIZE entries, without locking.
+ * Entries are stamped with the time stamp counter
+ * and merged by time stamp when dumped.
  **************************************************/
 typedef struct
 {
@@ -191,10 +257,34 @@ typedef struct
     unsigned int data1;
     unsigned int data2;
     unsigned int data3;
-    fm_timestamp timestamp;
+    fm_uint64    tsc;
 
 } TRACE_ENTRY;
 
+typedef struct _fm_traceRing
+{
+    /* Trace generation the contents belong to. Bumping
+     * traceGeneration empties every ring at once. */
+    fm_uint64              generation;
+
+    /* Number of events posted in this generation, only
+     * written by the owning thread */
+    fm_uint64              count;
+
+    /* TRUE while a thread owns the ring */
+    fm_bool                inUse;
+
+    struct _fm_traceRing * next;
+
+    TRACE_ENTRY            entries[FM_DBG_TRACE_BFR_SIZE];
+
+} fm_traceRing;
+
+/* Size in 64-bit words of the hashed bitmaps used to
+ * screen event codes against the trigger and exclusion
+ * tables (4096 bits) */
+#define FM_DBG_TRACE_FILTER_WORDS  64
+
 typedef struct
 {
     int          samples;
@@ -227,9 +317,6 @@ typedef struct _fm_rootDebug
     /* used for tracking packet receive size histograms */
     int                   dbgPacketSizeDist[FM_DBG_MAX_PACKET_SIZE];
 
-    /* generic debug subsystem lock */
-    fm_lock               fmDbgLock;
-
     /**************************************************
      * fm_debug_regs.c
      **************************************************/
@@ -246,17 +333,22 @@ typedef struct _fm_rootDebug
      * fm_debug_eye_diagrams.c
      **************************************************/
     fmDbgEyeDiagram      *fmDbgEyeDiagrams[FM_DBG_MAX_EYE_DIAGRAMS];
+    fmDbgEyeMetricsProgress fmDbgEyeMetrics;
     
 
     /**************************************************
      * fm_debug_trace.c
      **************************************************/
     drvEventCounter       drvEventCounters[FM_EVID_MAX];
-    TRACE_ENTRY           traceBfr[FM_DBG_TRACE_BFR_SIZE];
-    TRACE_ENTRY *         TBInPtr;  /* Input pointer */
-    TRACE_ENTRY *         TBOutPtr; /* Output pointer */
-    int                   TBcount;
+
+    /* Trace rings of all threads, never unlinked */
+    fm_traceRing *        traceRings;
+    fm_uint64             traceGeneration;
+
+    /* Time and time stamp counter when the trace was last
+     * cleared, used to convert time stamps in dumps */
     fm_timestamp          traceStartTime;
+    fm_uint64             traceStartTsc;
 
     /**************************************************
      * When TBlock is non-zero, fmDbgTracePost (which
@@ -283,6 +375,7 @@ typedef struct _fm_rootDebug
      * event capture to cease if TBmode = MODE_TRIGGER.
      **************************************************/
     int                   trigTable[5];
+    fm_uint64             trigFilter[FM_DBG_TRACE_FILTER_WORDS];
 
     /**************************************************
      * Exclusion table
@@ -293,6 +386,7 @@ typedef struct _fm_rootDebug
      **************************************************/
     int                   exclusions[FM_DBG_EXCLUSION_TABLE_SIZE];
     int                   numberOfExclusions;
+    fm_uint64             exclFilter[FM_DBG_TRACE_FILTER_WORDS];
     fmTimerMeasurement    dbgTimerMeas[FM_DBG_MAX_TIMER_MEAS];
 
     /* Event queue debugging globals. */
@@ -303,6 +397,21 @@ typedef struct _fm_rootDebug
 
 extern fm_rootDebug *fmRootDebug;
 
+
+/* Stages of the receive path sampled by fmDbgPacketRxLatencyRecord */
+typedef enum
+{
+    /* The frame is handed to fmDistributeEvent */
+    FM_DBG_PKT_RX_STAGE_DISTRIBUTE = 0,
+
+    /* The frame is handed to the application */
+    FM_DBG_PKT_RX_STAGE_DELIVER,
+
+    FM_DBG_PKT_RX_STAGE_MAX
+
+} fm_dbgPktRxStage;
+
+
 /*****************************************************************************
  * Function Prototypes
  *****************************************************************************/
@@ -310,6 +419,7 @@ extern fm_rootDebug *fmRootDebug;
 void      fmDbgInitSnapshots(void);
 void      fmDbgInitTrace(void);
 fm_status fmDbgInitEyeDiagrams(void);
+fm_status fmDbgInitPacketBench(void);
 
 fm_bool fmDbgPrintRegValue(fm_int    sw,
                            fm_int    regId,
@@ -322,5 +432,15 @@ fm_bool fmDbgPrintRegValue(fm_int    sw,
 
 fm_status fmDbgSetMiscAttribute(fm_int sw, fm_uint attr, fm_int value);
 
+void fmDbgFreeRegProfile(fm_int sw);
+
+void fmDbgBootPhaseStart(fm_int sw);
+void fmDbgBootPhaseBegin(fm_int sw, fm_text name, fm_int instance);
+void fmDbgBootPhaseEnd(fm_int sw, fm_text name);
+void fmDbgBootPhaseStop(fm_int sw);
+fm_status fmDbgGetBootPhase(fm_int sw, fm_bootPhase *phase);
+
+void fmDbgPacketRxLatencyRecord(fm_int stage, void *pkt);
+
 
 #endif /* __FM_FM_DEBUG_INT_H */
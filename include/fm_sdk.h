@@ -93,10 +93,34 @@
  *
  */
 
-/* Enable ALOS lock inversion defense by default */
+/* Default for the api.lock.fastPath property: ALOS locks take an atomic
+ * fast path with a futex fallback and skip lock precedence checking. */
+#ifndef FM_LOCK_FAST_PATH
+#define FM_LOCK_FAST_PATH               FM_DISABLED
+#endif
+
+/* Enable ALOS lock inversion defense by default, except in builds that
+ * select the fast path locks */
 #ifndef FM_LOCK_INVERSION_DEFENSE
+#if FM_LOCK_FAST_PATH
+#define FM_LOCK_INVERSION_DEFENSE       FM_DISABLED
+#else
 #define FM_LOCK_INVERSION_DEFENSE       FM_ENABLED
 #endif
+#endif
+
+/* Lock contention profiling is compiled out by default. When compiled in,
+ * it is turned on at run time with fmDbgEnableLockProfile. */
+#ifndef FM_LOCK_PROFILING
+#define FM_LOCK_PROFILING               FM_DISABLED
+#endif
+
+/* API call latency profiling is compiled in by default, since it costs a
+ * single test per API call while turned off. It is turned on at run time
+ * with fmDbgEnableApiProfile. */
+#ifndef FM_API_PROFILING
+#define FM_API_PROFILING                FM_ENABLED
+#endif
 
 
 /*
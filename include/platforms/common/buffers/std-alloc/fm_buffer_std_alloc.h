@@ -49,7 +49,8 @@ typedef struct
     /* Total number of available buffers */
     fm_int     totalBufferCount;
 
-    /* Number of available buffers */
+    /* Number of available buffers, including those cached in per-thread
+     * magazines. Updated atomically, without the buffer lock. */
     fm_int     availableBuffers[FM_NUM_BUFFER_TYPES];
 
     /* Table of buffers */
@@ -58,9 +59,21 @@ typedef struct
     /* Pointer to the backing memory pool */
     fm_uint32 *pool;
 
-    /* Buffer lock to protect against simultaneous access */
+    /* Size in bytes of the backing memory pool, when allocated here */
+    fm_uint64  poolSize;
+
+    /* Whether the backing memory pool is mapped from huge pages */
+    fm_bool    poolHugePage;
+
+    /* Size in bytes of the data area of every buffer */
+    fm_int     bufferSize;
+
+    /* Buffer lock to protect the free list against simultaneous access */
     fm_lock    bufferLock;
 
+    /* Received buffers awaiting delivery, when priority scheduling is on */
+    fm_priorityBufferQueues bufferQueues;
+
 } fm_bufferAllocState;
 
 #define TAKE_BUFFER_LOCK()                                           \
@@ -71,7 +84,15 @@ typedef struct
 
 fm_status fmPlatformInitBuffers(fm_uint32 *bufferMemoryPool);
 fm_status fmPlatformInitBuffersV2(fm_uint32 *bufferMemoryPool, fm_int numBuffers);
+fm_status fmPlatformInitBuffersV3(fm_uint32 *bufferMemoryPool, fm_int numBuffers);
+fm_int    fmPlatformGetBufferSize(void);
 fm_buffer *fmPlatformAllocateBufferV2(fm_bufferType type);
+fm_status fmPlatformGetBufferPool(void **pool, fm_uint64 *size);
+fm_buffer *fmPlatformGetBufferAtOffset(fm_uint64 offset);
+fm_status fmPlatformAllocateBufferBulk(fm_bufferType type,
+                                       fm_int        numBuffers,
+                                       fm_buffer **  bufs);
+fm_status fmPlatformFreeBufferBulk(fm_int numBuffers, fm_buffer **bufs);
 fm_status fmPlatformGetAvailableBuffersV2(fm_bufferType type, fm_int *count);
 
 
@@ -0,0 +1,76 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_priority_buffer_queues.h
+ * Creation Date:   October 15, 2026
+ * Description:     Per-priority queues of received frame buffers.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#ifndef __FM_FM_PRIORITY_BUFFER_QUEUES_H
+#define __FM_FM_PRIORITY_BUFFER_QUEUES_H
+
+/* Number of switch priorities, one buffer queue each */
+#define FM_NUM_PRIORITY_BUFFER_QUEUES   16
+
+/**************************************************
+ * Receive buffers awaiting delivery, kept in one
+ * FIFO per switch priority. The list nodes are
+ * preallocated, one per buffer of the pool, so the
+ * node of a queued buffer is found through its
+ * bufferQueueNode field and unlinked in constant
+ * time, without any allocation.
+ **************************************************/
+typedef struct
+{
+    /* One FIFO of buffer chains per switch priority, oldest at the head */
+    fm_dlist        queues[FM_NUM_PRIORITY_BUFFER_QUEUES];
+
+    /* Number of buffer chains in each queue */
+    fm_int          depth[FM_NUM_PRIORITY_BUFFER_QUEUES];
+
+    /* Bit mask of the non-empty queues, bit N for priority N */
+    fm_uint32       nonEmptyMask;
+
+    /* List nodes indexed by buffer index */
+    fm_dlist_node * nodes;
+
+    /* Queue of each buffer, indexed by buffer index, valid while queued */
+    fm_byte *       nodeQueue;
+
+    /* Protects all of the above except nodes, which is fixed after init */
+    fm_lock         lock;
+
+} fm_priorityBufferQueues;
+
+fm_status fmPlatformInitBufferQueues(fm_int numBuffers);
+fm_status fmPlatformAddBufferChain(fm_buffer *buf,
+                                   fm_uint32  pri,
+                                   fm_bool    isInsertBegin);
+fm_status fmPlatformFreeBufferQueueNode(fm_eventPktRecv *rcvPktEvent);
+fm_status fmPlatformGetEvictableBuffer(fm_uint32 pri, fm_buffer **bufPtr);
+
+
+#endif /* __FM_FM_PRIORITY_BUFFER_QUEUES_H */
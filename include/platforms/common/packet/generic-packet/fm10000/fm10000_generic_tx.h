@@ -42,6 +42,18 @@ fm_status fm10000GenericSendPacketDirected(fm_int           sw,
 
 fm_status fm10000GenericSendPacketSwitched(fm_int sw, fm_buffer *packet);
 
+fm_status fm10000GenericCreateTxDestination(fm_int  sw,
+                                            fm_int *portList,
+                                            fm_int  numPorts,
+                                            fm_int *destHandle);
+
+fm_status fm10000GenericDeleteTxDestination(fm_int sw, fm_int destHandle);
+
+fm_status fm10000GenericSendPacketTxDestination(fm_int           sw,
+                                                fm_int           destHandle,
+                                                fm_buffer *      packet,
+                                                fm_packetInfoV2 *info);
+
 fm_status fm10000GenericSendPacketISL(fm_int          sw,
                                       fm_uint32 *     islTag,
                                       fm_islTagFormat islTagFormat,
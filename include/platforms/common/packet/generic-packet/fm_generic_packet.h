@@ -38,6 +38,16 @@
 #define FM_MAX_FDS_NUM                            1024
 #define FM_FDS_POLL_TIMEOUT_USEC                  1000
 
+/**************************************************
+ * Number of TX packet queues (traffic classes).
+ * Switch priorities are spread evenly across the
+ * queues, and higher queue indices are drained
+ * first. Packets with no switch priority use
+ * FM_PACKET_TX_QUEUE_DEFAULT.
+ **************************************************/
+#define FM_PACKET_TX_QUEUES                       4
+#define FM_PACKET_TX_QUEUE_DEFAULT                0
+
 /* holds a packet entry */
 typedef struct _fm_packetEntry
 {
@@ -65,19 +75,28 @@ typedef struct _fm_packetEntry
     /* This is filled in by the API when useEgressRules is set to true. */
     fm_uint32       egressVlanTag;
 
-    /*  This is used to indicate whether or not to free
-     *  the packet buffer. For direct sending to a single port this will be
-     *  set to TRUE. For direct sending to an entire vlan or to a group
-     *  of ports, the last packet entry will have this field set to TRUE. */
+    /*  This is used to indicate whether or not the entry holds a reference
+     *  on the packet buffer, released with fmReleaseBufferChain once the
+     *  entry is sent. For direct sending to an entire vlan or to a group
+     *  of ports, every entry holds a reference on the shared buffer, so
+     *  the entries may complete in any order. */
     fm_bool         freePacketBuffer;
 
+    /* Reported to the TX completion handler once the entry is retired,
+     * NULL if none. Only the last entry of a packet sent to several
+     * ports carries the cookie. */
+    void *          txCookie;
+
 } fm_packetEntry;
 
 
 typedef struct _fm_packetQueue
 {
     /* holds the current send queue of packets in a circular buffer */
-    fm_packetEntry packetQueueList[FM_PACKET_QUEUE_SIZE];
+    fm_packetEntry *packetQueueList;
+
+    /* Number of entries in packetQueueList, fixed at init time */
+    fm_uint         size;
 
     /**************************************************
      * The packetQueue is a rotary queue of packets
@@ -92,30 +111,125 @@ typedef struct _fm_packetQueue
      * The queue is full when incrementing the push
      * index would make it equal to the pull index
      * (push + 1 % QueueSize == pull => full).
+     *
+     * Producers stage entries at pushIndex while
+     * holding the queue lock, and may roll it back on
+     * error. The staged entries are made visible to
+     * the consumer by publishing pushIndex into
+     * publishIndex when the lock is dropped.
+     *
+     * The consumer never takes the queue lock: it
+     * reads publishIndex and advances pullIndex with
+     * atomic operations.
      **************************************************/
-    fm_uint        pushIndex;
-    fm_uint        pullIndex;
+    fm_uint         pushIndex;
+    fm_uint         publishIndex;
+    fm_uint         pullIndex;
 
-    fm_int         switchNum;
+    fm_int          switchNum;
 
+    /* Serializes producers */
     pthread_mutex_t mutex;
 
+    /* Recursion depth of mutex, publishIndex is written at depth 0 */
+    fm_int          lockDepth;
+
+    /* Serializes consumers, never held by producers */
+    pthread_mutex_t drainMutex;
+
+    /* Statistics, updated by producers under mutex */
+    fm_uint64       numEnqueued;
+    fm_uint64       numDrops;
+    fm_uint         maxDepth;
+
 } fm_packetQueue;
 
 
+/**************************************************
+ * Number of VLAN1 EtherTypes a TX destination
+ * records for the CPU port. Covers every parser
+ * VLAN tag entry of the supported families.
+ **************************************************/
+#define FM_TX_DESTINATION_VLAN_TYPES              4
+
+/* A destination port of a precompiled TX destination */
+typedef struct _fm_txDestinationPort
+{
+    /* Logical port number, as given by the application */
+    fm_int          port;
+
+    /* LAG ports are sent to regardless of link state */
+    fm_bool         isLag;
+
+    /* Filtered out when the destination was compiled */
+    fm_bool         skip;
+
+    /* TRUE if this is the CPU port and sending to it is allowed */
+    fm_bool         directSendToCpu;
+
+    /* ISL tag with every field that does not depend on the frame */
+    fm_islTagFormat islTagFormat;
+    fm_islTag       islTag;
+
+} fm_txDestinationPort;
+
+
+/**************************************************
+ * A TX destination handle. The port list is
+ * validated and resolved once, when the handle is
+ * compiled, instead of on every send. The compiled
+ * state is rebuilt on first use after the switch's
+ * txDestGeneration moves.
+ **************************************************/
+typedef struct _fm_txDestination
+{
+    /* Whether the handle is allocated */
+    fm_bool                 used;
+
+    /* Whether the compiled state below is valid for generation */
+    fm_bool                 compiled;
+    fm_uint32               generation;
+
+    fm_int                  numPorts;
+    fm_txDestinationPort *  ports;
+
+    /* CPU port and its maximum frame size at compile time */
+    fm_int                  cpuPort;
+    fm_int                  cpuMaxFrameSize;
+
+    /* Source port of sent frames, negative for a zero source glort */
+    fm_int                  sourcePort;
+
+    /* Default VLAN of the CPU port, used for untagged frames */
+    fm_uint16               cpuDefVlan;
+
+    /* VLAN1 EtherTypes recognized on the CPU port */
+    fm_uint32               vlanEtherTypes[FM_TX_DESTINATION_VLAN_TYPES];
+    fm_int                  numVlanEtherTypes;
+
+} fm_txDestination;
+
+
 /* manages packet sending state */
 typedef struct
 {
     /**************************************************
-     * Packet sending state.
+     * Packet sending state, one queue per traffic
+     * class. See FM_PACKET_TX_QUEUES.
      **************************************************/
-    fm_packetQueue txQueue;
+    fm_packetQueue txQueue[FM_PACKET_TX_QUEUES];
 
     /* To signal receive thread to continue when events
      * are available again
      */
     fm_semaphore   eventsAvailableSignal;
 
+    /* TX destination handles, see fmCreateTxDestination */
+    fm_txDestination txDestinations[FM_MAX_TX_DESTINATIONS];
+
+    /* Serializes access to txDestinations */
+    pthread_mutex_t  txDestMutex;
+
     /**************************************************
      * This control whether packets are directly
      * enqueued to the application, bypassing
@@ -188,6 +302,15 @@ typedef struct
 } fm_packetHandlingState;
 
 
+/* Completions gathered by a consumer during one pass over a TX queue */
+typedef struct _fm_txCompletionBatch
+{
+    fm_int          numCompletions;
+    fm_txCompletion completions[FM_TX_COMPLETION_BATCH_SIZE];
+
+} fm_txCompletionBatch;
+
+
 /* Defines any side band data that needs to be passed along with the
  * packet transfer functions */
 typedef struct _fm_pktSideBandData
@@ -204,9 +327,23 @@ typedef struct _fm_pktSideBandData
 
 fm_status fmPacketQueueInit(fm_packetQueue *queue, fm_int sw);
 fm_status fmPacketQueueFree(fm_int sw);
-void      fmPacketQueueLock(fm_packetQueue *queue);
+fm_status fmPacketQueueLock(fm_packetQueue *queue);
+fm_bool   fmPacketQueueTryLock(fm_packetQueue *queue);
 void      fmPacketQueueUnlock(fm_packetQueue *queue);
 fm_status fmPacketQueueUpdate(fm_packetQueue *queue);
+void      fmPacketQueueDrainLock(fm_packetQueue *queue);
+void      fmPacketQueueDrainUnlock(fm_packetQueue *queue);
+fm_uint   fmPacketQueueGetTail(fm_packetQueue *queue);
+void      fmPacketQueueAdvance(fm_packetQueue *queue);
+fm_uint   fmPacketQueueNextIndex(fm_packetQueue *queue, fm_uint index);
+fm_packetQueue *fmPacketQueueSelect(fm_int sw, fm_uint32 switchPriority);
+fm_packetQueue *fmPacketQueueGetNextToDrain(fm_int sw);
+fm_status fmPacketQueueDumpStats(fm_int sw);
+void      fmPacketQueueRetire(fm_int                sw,
+                              fm_packetQueue *      queue,
+                              fm_status             status,
+                              fm_txCompletionBatch *batch);
+void      fmPacketFlushTxCompletions(fm_int sw, fm_txCompletionBatch *batch);
 
 fm_status fmPacketQueueEnqueue(fm_packetQueue * queue,
                                fm_buffer *      packet,
@@ -216,6 +353,14 @@ fm_status fmPacketQueueEnqueue(fm_packetQueue * queue,
                                fm_bool          suppressVlanTag,
                                fm_bool          freeBuffer);
 
+fm_status fmPacketQueueTryEnqueue(fm_packetQueue * queue,
+                                  fm_buffer *      packet,
+                                  fm_int           packetLength,
+                                  fm_islTag *      islTag,
+                                  fm_islTagFormat  islTagFormat,
+                                  fm_bool          suppressVlanTag,
+                                  fm_bool          freeBuffer);
+
 fm_status fmPacketReceiveEnqueue(fm_int sw, fm_event *event,
                                  fm_switchEventHandler selfTestEventHandler);
 
@@ -249,13 +394,44 @@ fm_status fmGenericSendPacketDirected(fm_int     sw,
                                       fm_buffer *packet,
                                       fm_uint32  fcsValue,
                                       fm_int     cpuPort,
-                                      fm_uint32  switchPriority);
+                                      fm_uint32  switchPriority,
+                                      void *     txCookie,
+                                      fm_bool    noWait);
 
 fm_status fmGenericSendPacketSwitched(fm_int     sw,
                                       fm_buffer *packet,
                                       fm_int     cpuPort,
                                       fm_uint32  switchPriority);
 
+fm_status fmGenericEnqueueDirectedPacket(fm_int            sw,
+                                         fm_buffer *       packet,
+                                         fm_int            packetLength,
+                                         fm_uint32         fcsValue,
+                                         fm_uint32         switchPriority,
+                                         fm_int            numEntries,
+                                         fm_int *          portList,
+                                         fm_islTagFormat * islTagFormats,
+                                         fm_islTag *       islTags,
+                                         fm_bool *         suppressVlanTags,
+                                         void *            txCookie,
+                                         fm_bool           noWait);
+fm_status fmGenericGetTxQueueSpace(fm_int    sw,
+                                   fm_uint32 switchPriority,
+                                   fm_int *  space);
+
+fm_status fmGenericCreateTxDestination(fm_int  sw,
+                                       fm_int *portList,
+                                       fm_int  numPorts,
+                                       fm_int *destHandle);
+fm_status fmGenericDeleteTxDestination(fm_int sw, fm_int destHandle);
+fm_status fmGenericAcquireTxDestination(fm_int             sw,
+                                        fm_int             destHandle,
+                                        fm_txDestination **destPtr);
+void      fmGenericReleaseTxDestination(fm_int sw);
+fm_status fmGenericCompileTxDestination(fm_int             sw,
+                                        fm_txDestination * dest,
+                                        fm_int             cpuPort);
+
 fm_status fmGenericSendPacket(fm_int         sw,
                               fm_packetInfo *info,
                               fm_buffer *    packet,
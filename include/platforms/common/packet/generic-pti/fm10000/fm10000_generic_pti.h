@@ -40,6 +40,11 @@ fm_status fm10000PTISendPackets(fm_int sw);
 void * fm10000PTIReceivePackets(void *args);
 
 fm_status fm10000PTISend(fm_int sw, fm_byte *data, fm_int length);
+fm_status fm10000PTISendBatch(fm_int    sw,
+                              fm_byte **frames,
+                              fm_int *  lengths,
+                              fm_int    numFrames,
+                              fm_int *  numSent);
 
 fm_status fm10000PTIReceive(fm_int      sw, 
                             fm_byte *   data, 
@@ -38,15 +38,40 @@
 /* This is the maximum MTU supported by the fm10k driver*/
 #define FM_MAX_JUMBO_FRAME_SIZE 15342
 
+struct iovec;
+
+/* Header words referenced by the iovec of one transmitted message. They
+ * must stay valid until the message has been handed to the kernel. */
+typedef struct _fm_rawSocketTxTags
+{
+    /* Timetag, overwritten by the PEP */
+    fm_uint64 rawTS;
+
+    /* ISL tag in network byte order */
+    fm_islTag islTag;
+
+    /* User-supplied FCS in network byte order */
+    fm_uint32 fcs;
+
+} fm_rawSocketTxTags;
+
 /* raw packet socket function prototypes */
 fm_status fmRawPacketSocketSendPackets(fm_int sw);
 void * fmRawPacketSocketReceivePackets(void *args);
 fm_status fmRawPacketSocketHandlingInitialize(fm_int  sw, 
                                               fm_bool hasFcs, 
                                               fm_text iface);
+fm_status fmRawPacketSocketOpen(fm_int  sw, 
+                                fm_bool hasFcs, 
+                                fm_text iface);
 fm_status fmRawPacketSocketDestroy(fm_int sw);
 fm_bool fmIsRawPacketSocketDeviceOperational(fm_int   sw,
                                              fm_bool *isRawSocket,
                                              fm_int * mtu);
+fm_int fmRawPacketSocketCountTxIovecs(fm_packetEntry *packet);
+fm_int fmRawPacketSocketBuildTxIovecs(fm_packetHandlingState *pktState,
+                                      fm_packetEntry *        packet,
+                                      fm_rawSocketTxTags *    tags,
+                                      struct iovec *          iov);
 
 #endif /* __FM_FM_GENERIC_RAWSOCKET_H */
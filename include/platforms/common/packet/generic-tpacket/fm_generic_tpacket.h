@@ -0,0 +1,133 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_generic_tpacket.h
+ * Creation Date:   October, 2026
+ * Description:     Header file for the memory-mapped (TPACKET_V3) packet
+ *                  socket I/O
+ *
+ * Copyright (c) 2006 - 2015, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#ifndef __FM_FM_GENERIC_TPACKET_H
+#define __FM_FM_GENERIC_TPACKET_H
+
+/* Number of leading frame bytes kept with each TX timestamp, enough to
+ * identify a PTP event message. */
+#define FM_TPACKET_TX_TS_HDR_LEN        64
+
+/* Hardware transmit timestamp of one frame sent through the TX ring. */
+typedef struct _fm_tpacketTxTimestamp
+{
+    /* Sequence number assigned when the frame was placed in the ring.
+     * A gap between consecutive entries means completions were
+     * overwritten before being retrieved. */
+    fm_uint64   seqNum;
+
+    /* Logical port the frame was sent to */
+    fm_int      logicalPort;
+
+    /* Length of the frame in bytes, as handed to the API */
+    fm_uint     length;
+
+    /* TRUE if the kernel reported a hardware timestamp for the frame */
+    fm_bool     valid;
+
+    /* Egress timestamp, only meaningful if valid is TRUE */
+    fm_timespec txTimestamp;
+
+    /* Number of valid bytes in header */
+    fm_int      headerLen;
+
+    /* Leading bytes of the frame, starting with the destination MAC */
+    fm_byte     header[FM_TPACKET_TX_TS_HDR_LEN];
+
+} fm_tpacketTxTimestamp;
+
+/* State of the memory-mapped RX and TX rings attached to the raw packet
+ * socket. */
+typedef struct _fm_tpacketState
+{
+    /* Start of the mapping, RX ring blocks followed by TX ring frames */
+    fm_byte *ringBase;
+
+    /* Total size of the mapping in bytes */
+    fm_uint  ringSize;
+
+    /* RX ring geometry */
+    fm_uint  rxBlockSize;
+    fm_uint  rxBlockCount;
+
+    /* Next RX block to be handed back by the kernel */
+    fm_uint  rxBlockIndex;
+
+    /* TX ring geometry */
+    fm_uint  txFrameSize;
+    fm_uint  txFrameCount;
+
+    /* Next TX frame to be filled */
+    fm_uint  txFrameIndex;
+
+    /* TRUE if hardware TX timestamps are collected from the TX ring */
+    fm_bool  txTimestamps;
+
+    /* Protects the TX timestamp state below, which is updated by the
+     * send path and by fmTpacketGetTxTimestamps */
+    pthread_mutex_t txTsLock;
+
+    /* Frame in flight in each TX ring frame, indexed like the ring */
+    fm_tpacketTxTimestamp *txFrameMeta;
+
+    /* Oldest TX ring frame whose completion has not been collected */
+    fm_uint  txReapIndex;
+
+    /* Number of TX ring frames handed to the kernel and not collected */
+    fm_uint  txPending;
+
+    /* Sequence number given to the next frame placed in the ring */
+    fm_uint64 txSeqNum;
+
+    /* Completed TX timestamps, a circular buffer of txFrameCount entries
+     * starting at txTsHead. The oldest entry is overwritten when full. */
+    fm_tpacketTxTimestamp *txTsRing;
+    fm_uint  txTsHead;
+    fm_uint  txTsCount;
+
+} fm_tpacketState;
+
+/* TPACKET_V3 packet socket function prototypes */
+fm_status fmTpacketHandlingInitialize(fm_int  sw, 
+                                      fm_bool hasFcs, 
+                                      fm_text iface);
+fm_status fmTpacketDestroy(fm_int sw);
+fm_status fmTpacketSendPackets(fm_int sw);
+void * fmTpacketReceivePackets(void *args);
+fm_status fmTpacketGetTxTimestamps(fm_int                 sw,
+                                   fm_tpacketTxTimestamp *entries,
+                                   fm_int                 maxEntries,
+                                   fm_int *               numEntries);
+
+#endif /* __FM_FM_GENERIC_TPACKET_H */
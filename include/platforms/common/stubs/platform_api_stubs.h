@@ -111,6 +111,30 @@
         fm10000GenericSendPacketDirected(sw, portList, numPorts, pkt, info)
 #endif
 
+/* Can be overridden in platform_defines.h */
+#ifndef FM_FM10000_CREATE_TX_DESTINATION
+#define FM_FM10000_CREATE_TX_DESTINATION(sw, portList, numPorts, destHandle) \
+        fm10000GenericCreateTxDestination(sw, portList, numPorts, destHandle)
+#endif
+
+/* Can be overridden in platform_defines.h */
+#ifndef FM_FM10000_DELETE_TX_DESTINATION
+#define FM_FM10000_DELETE_TX_DESTINATION(sw, destHandle)                    \
+        fm10000GenericDeleteTxDestination(sw, destHandle)
+#endif
+
+/* Can be overridden in platform_defines.h */
+#ifndef FM_FM10000_SEND_PACKET_TX_DESTINATION
+#define FM_FM10000_SEND_PACKET_TX_DESTINATION(sw, destHandle, pkt, info)    \
+        fm10000GenericSendPacketTxDestination(sw, destHandle, pkt, info)
+#endif
+
+/* Can be overridden in platform_defines.h */
+#ifndef FM_FM10000_GET_TX_QUEUE_SPACE
+#define FM_FM10000_GET_TX_QUEUE_SPACE(sw, switchPriority, space)            \
+        fmGenericGetTxQueueSpace(sw, switchPriority, space)
+#endif
+
 /* Can be overridden in platform_defines.h to call fmPlatformSendPacketSwitched. */
 #ifndef FM_FM10000_SEND_PACKET_SWITCHED      
 #define FM_FM10000_SEND_PACKET_SWITCHED(sw, pkt)                            \
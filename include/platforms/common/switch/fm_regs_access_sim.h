@@ -0,0 +1,75 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_regs_access_sim.h
+ * Creation Date:   October 15, 2026
+ * Description:     Functions to access a simulated switch register file
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#ifndef __FM_REGS_ACCESS_SIM_H
+#define __FM_REGS_ACCESS_SIM_H
+
+fm_status fmPlatformSimInit(fm_int sw, fm_uint accessLatencyNsec);
+fm_status fmPlatformSimFree(fm_int sw);
+fm_status fmPlatformSimGetStats(fm_int     sw,
+                                fm_uint64 *numReads,
+                                fm_uint64 *numWrites,
+                                fm_int    *numPages);
+
+fm_status fmPlatformSimReadCSR(fm_int sw, fm_uint32 addr, fm_uint32 *value);
+fm_status fmPlatformSimWriteCSR(fm_int sw, fm_uint32 addr, fm_uint32 value);
+fm_status fmPlatformSimReadCSRMult(fm_int     sw,
+                                   fm_uint32  addr,
+                                   fm_int     n,
+                                   fm_uint32 *value);
+fm_status fmPlatformSimWriteCSRMult(fm_int     sw,
+                                    fm_uint32  addr,
+                                    fm_int     n,
+                                    fm_uint32 *value);
+fm_status fmPlatformSimReadCSR64(fm_int sw, fm_uint32 addr, fm_uint64 *value);
+fm_status fmPlatformSimWriteCSR64(fm_int sw, fm_uint32 addr, fm_uint64 value);
+fm_status fmPlatformSimReadCSRMult64(fm_int     sw,
+                                     fm_uint32  addr,
+                                     fm_int     n,
+                                     fm_uint64 *value);
+fm_status fmPlatformSimWriteCSRMult64(fm_int     sw,
+                                      fm_uint32  addr,
+                                      fm_int     n,
+                                      fm_uint64 *value);
+fm_status fmPlatformSimReadRawCSR(fm_int sw, fm_uint32 addr, fm_uint32 *value);
+fm_status fmPlatformSimWriteRawCSR(fm_int sw, fm_uint32 addr, fm_uint32 value);
+fm_status fmPlatformSimWriteRawCSRSeq(fm_int     sw,
+                                      fm_uint32 *addr,
+                                      fm_uint32 *value,
+                                      fm_int     n);
+fm_status fmPlatformSimMaskCSR(fm_int    sw,
+                               fm_uint   reg,
+                               fm_uint32 mask,
+                               fm_bool   on);
+
+#endif  /* __FM_REGS_ACCESS_SIM_H */
@@ -60,6 +60,7 @@ fm_status fmPlatformHostDrvDisableInterrupt(fm_int sw, fm_uint intrTypes);
 fm_status fmPlatformHostDrvWaitForInterrupt(fm_int   sw,
                                             fm_int   timeout,
                                             fm_uint *intrStatus);
+fm_status fmPlatformHostDrvGetInterruptNotifyFd(fm_int *fd);
 
 fm_status fmPlatformMmapUioDevice(fm_text devName, 
                                   fm_int *fd, 
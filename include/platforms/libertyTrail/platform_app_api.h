@@ -34,6 +34,8 @@
 #ifndef __FM_PLATFORM_APP_API_H
 #define __FM_PLATFORM_APP_API_H
 
+/* See fm_generic_tpacket.h */
+struct _fm_tpacketTxTimestamp;
 
 /* Should be used for input argument in function fmPlatformSetVrmVoltage and  */
 /* fmPlatformGetVrmVoltage  */
@@ -70,6 +72,7 @@ fm_status fmPlatformSwitchInsert(fm_int sw);
 fm_status fmPlatformSwitchRemove(fm_int sw);
 fm_status fmPlatformSetRegAccessMode(fm_int sw, fm_int mode);
 fm_status fmPlatformSetInterruptPollingPeriod(fm_int sw, fm_int periodMsec);
+fm_status fmPlatformGetInterruptNotifyFd(fm_int *fd);
 fm_status fmPlatformReadUnlockCSR(fm_int sw, fm_uint32 addr, fm_uint32 *value);
 fm_status fmPlatformWriteUnlockCSR(fm_int sw, fm_uint32 addr, fm_uint32 value);
 
@@ -115,6 +118,15 @@ fm_status fmPlatformXcvrEepromRead(fm_int   sw,
                                    fm_byte *data,
                                    fm_int   length);
 
+fm_status fmPlatformXcvrEepromReadNoLock(fm_int   sw,
+                                         fm_int   port,
+                                         fm_int   page,
+                                         fm_int   offset,
+                                         fm_byte *data,
+                                         fm_int   length);
+
+fm_status fmPlatformXcvrInvalidateCache(fm_int sw, fm_int port);
+
 fm_status fmPlatformSetVrmVoltage(fm_int         sw,
                                   fm_platVrmType vrmId,
                                   fm_uint32      mVolt);
@@ -147,4 +159,9 @@ fm_status fmPlatformGetNominalSwitchVoltages(fm_int     sw,
                                              fm_uint32 *vddf,
                                              fm_bool   *defVoltages);
 
+fm_status fmPlatformGetTxTimestamps(fm_int                         sw,
+                                    struct _fm_tpacketTxTimestamp *entries,
+                                    fm_int                         maxEntries,
+                                    fm_int *                       numEntries);
+
 #endif /* __FM_PLATFORM_APP_API_H */
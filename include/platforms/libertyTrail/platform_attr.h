@@ -1284,6 +1284,8 @@
  *    'PCIE' : The switch will be managed from PCIE bus
  *    'EBI'  : The switch will be managed from EBI bus (debug)
  *    'I2C'  : The switch will be managed from I2C bus (debug)
+ *    'SIM'  : The registers are kept in host memory and no switch is
+ *             accessed (benchmarking without hardware)
  */
 #define FM_AAK_API_PLATFORM_REGISTER_ACCESS     "api.platform.config.switch.%d.regAccess"
 #define FM_AAT_API_PLATFORM_REGISTER_ACCESS     FM_API_ATTR_TEXT
@@ -1325,6 +1327,15 @@
 #define FM_AAT_API_PLATFORM_PHY_ENABLE_DEEMPHASIS     FM_API_ATTR_INT
 #define FM_AAD_API_PLATFORM_PHY_ENABLE_DEEMPHASIS     0
 
+/* (optional) Delay in nanoseconds added to every register access when
+ * regAccess is SIM. A block access (Mult) is charged once, like a single
+ * bus transaction. Use it to approximate the cost of the real bus when
+ * benchmarking without hardware.
+ */
+#define FM_AAK_API_PLATFORM_SIM_ACCESS_LATENCY    "api.platform.config.switch.%d.simAccessLatencyNsec"
+#define FM_AAT_API_PLATFORM_SIM_ACCESS_LATENCY    FM_API_ATTR_INT
+#define FM_AAD_API_PLATFORM_SIM_ACCESS_LATENCY    0
+
 /************************************************************
  * The following attributes are used as the boot 
  * configuration when not booting from SPI Flash. 
@@ -1657,6 +1668,45 @@
 #define FM_AAD_API_PLATFORM_I2C_CLKDIVIDER             10
 
 
+/**
+ * Specifies whether bulk accesses to the switch registers over PCIe may
+ * use 64-bit reads and writes, moving two consecutive 32-bit registers
+ * per access. Only enable it if the register BAR accepts 64-bit accesses.
+ */
+#define FM_AAK_API_PLATFORM_CSR_WIDE_ACCESS            "api.platform.config.switch.%d.csrWideAccess"
+#define FM_AAT_API_PLATFORM_CSR_WIDE_ACCESS            FM_API_ATTR_BOOL
+#define FM_AAD_API_PLATFORM_CSR_WIDE_ACCESS            FALSE
+
+
+/**
+ * Specifies the maximum number of consecutive 32-bit registers that may be
+ * transferred in a single I2C transaction when the switch registers are
+ * accessed over I2C (regAccess set to I2C). The switch I2C slave then
+ * auto-increments the register address after each word. Values of 0 and 1
+ * make every register a separate transaction. Values above 64 are treated
+ * as 64.
+ */
+#define FM_AAK_API_PLATFORM_I2C_BURST_WORDS            "api.platform.config.switch.%d.i2cBurstWords"
+#define FM_AAT_API_PLATFORM_I2C_BURST_WORDS            FM_API_ATTR_INT
+#define FM_AAD_API_PLATFORM_I2C_BURST_WORDS            0
+
+
+/**
+ * (Optional) Transceiver memory reads are served from a per-port cache that
+ * is dropped when the module is removed or inserted. This specifies, in
+ * milliseconds, how long the diagnostic monitoring areas (the QSFP lower
+ * page and the SFP+ A2h lower half) are served from the cache before being
+ * read from the module again.
+ *                                                                      \lb\lb
+ * Set to 0 to always read them from the module.
+ *                                                                      \lb\lb
+ * Default is set to 1000 msec
+ */
+#define FM_AAK_API_PLATFORM_XCVR_DOM_REFRESH_MSEC      "api.platform.config.switch.%d.xcvrDomRefreshMsec"
+#define FM_AAT_API_PLATFORM_XCVR_DOM_REFRESH_MSEC      FM_API_ATTR_INT
+#define FM_AAD_API_PLATFORM_XCVR_DOM_REFRESH_MSEC      1000
+
+
 #ifdef FM_LT_WHITE_MODEL_SUPPORT
 /****************************************************************************
  * Platform attributes, used as an argument to ''fmPlatformSetAttribute'' and
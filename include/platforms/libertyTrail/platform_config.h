@@ -111,6 +111,7 @@
 #define FM_PLAT_DISABLE_POST_INIT_FUNC           (1 << 11)
 #define FM_PLAT_DISABLE_SET_VRM_VOLTAGE_FUNC     (1 << 12)
 #define FM_PLAT_DISABLE_GET_VRM_VOLTAGE_FUNC     (1 << 13)
+#define FM_PLAT_DISABLE_GET_XCVR_BUS_FUNC        (1 << 14)
 
 /* Maximum number of voltage regulator module. */ 
 #define FM_PLAT_MAX_VRM        3
@@ -152,6 +153,7 @@ typedef enum
     FM_PLAT_REG_ACCESS_PCIE = 0, /* Switch managed from PCIe interface */
     FM_PLAT_REG_ACCESS_EBI  = 1, /* Switch managed from EBI interface */
     FM_PLAT_REG_ACCESS_I2C  = 2, /* Switch managed from I2C interface */
+    FM_PLAT_REG_ACCESS_SIM  = 3, /* Simulated register file, no hardware */
 
 } fm_platRegAccessMode;
 
@@ -446,7 +448,7 @@ typedef struct
     /* Switch boot mode (SPI FLASH, EBI, I2C) */
     fm_platBootMode         bootMode;
 
-    /* Register access mode (PCIe, EBI, I2C) */
+    /* Register access mode (PCIe, EBI, I2C, SIM) */
     fm_platRegAccessMode    regAccess;
 
     /* PCIE ISR mode (AUTO, SW, SPI) */
@@ -526,6 +528,18 @@ typedef struct
     /* I2C clock divider */
     fm_uint         i2cClkDivider;
 
+    /* Bulk register accesses may use 64-bit reads and writes */
+    fm_bool         csrWideAccess;
+
+    /* Maximum number of registers per I2C register access transaction */
+    fm_int          i2cBurstWords;
+
+    /* Delay added to each simulated register access, in nanoseconds */
+    fm_int          simAccessLatencyNsec;
+
+    /* Age in msec after which cached transceiver DOM data is read again */
+    fm_int          xcvrDomRefreshMsec;
+
 } fm_platformCfgSwitch;
 
 
@@ -560,6 +574,9 @@ typedef struct
 
 fm_status fmPlatformCfgInit(void);
 fm_status fmPlatformLoadPropertiesFromLine(fm_text line);
+fm_status fmPlatformEncodePropertiesFromLine(fm_text  line,
+                                             fm_byte *records,
+                                             fm_int * length);
 void fmPlatformCfgDump(void);
 fm_platformCfgSwitch *fmPlatformCfgSwitchGet(fm_int sw);
 fm_int fmPlatformCfgPortGetIndex(fm_int sw, fm_int port);
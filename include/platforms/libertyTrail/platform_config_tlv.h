@@ -34,11 +34,21 @@
 #ifndef __FM_PLATFORM_CONFIG_TLV_H
 #define __FM_PLATFORM_CONFIG_TLV_H
 
+/* Loader of a record in a compiled configuration image */
+#define FM_PLAT_CFG_IMAGE_API       0
+#define FM_PLAT_CFG_IMAGE_LT        1
+#define FM_PLAT_CFG_IMAGE_LIB       2
+
+/* Maximum length of the records encoded from one configuration line */
+#define FM_PLAT_CFG_IMAGE_LINE_MAX  (2 * (FM_TLV_MAX_BUF_SIZE + 1))
+
 fm_status fmPlatformLoadTlvFile(fm_text fileName);
 fm_status fmPlatformLoadTlv(fm_byte *tlv);
 fm_status fmPlatformLoadApiPropertyTlv(fm_byte *tlv);
 fm_status fmPlatformLoadLTCfgTlv(fm_byte *tlv);
 fm_status fmPlatformLoadLibCfgTlv(fm_byte *tlv);
 fm_status fmPlatformCfgVerifyAndUpdate(void);
+fm_status fmPlatformCompileConfigImage(fm_text fileName, fm_text imageName);
+fm_status fmPlatformLoadConfigImage(fm_text imageName, fm_text fileName);
 
 #endif /* __FM_PLATFORM_CONFIG_TLV_H */
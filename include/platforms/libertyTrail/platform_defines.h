@@ -280,6 +280,22 @@ typedef enum _fm_platformSwitchType
 #define FM_MAX_EVENTS                       4096
 
 
+/** The number of the event buffers of ''FM_MAX_EVENTS'' that are large
+ *  enough to report a burst of table updates. The other event buffers
+ *  only hold the event structure.
+ *  \ingroup constSystem
+ */
+#define FM_MAX_TABLE_UPDATE_EVENTS          1024
+
+
+/** The maximum number of events the API posts at once to the event queue
+ *  of a process, and reports in a single call to an
+ *  ''fm_eventBatchHandler''.
+ *  \ingroup constSystem
+ */
+#define FM_EVENT_BATCH_SIZE                 16
+
+
 /** The event queue size for API threads that require a large event queue.
  *  Memory will not be allocated until an event is actually sent to the
  *  thread. This value dictates the maximum number of events that can be in
@@ -38,12 +38,16 @@ typedef struct
 {
     fm_platPortLedSpeed  speed;
     fm_int               linkState;
-    fm_int               linkState2;
     fm_int               trafficState;
 
+    /* LED state and speed last written, valid when ledStateValid is set */
+    fm_platPortLedState  ledState;
+    fm_bool              ledStateValid;
+
 } fm_platLedInfo;
 
 fm_status fmPlatformLedInit(fm_int sw);
+fm_status fmPlatformLedStart(fm_int sw);
 fm_status fmPlatformLedSetPortState(fm_int  sw,
                                     fm_int  port,
                                     fm_bool isConfig,
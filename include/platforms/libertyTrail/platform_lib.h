@@ -49,6 +49,7 @@
 #define FM_PLAT_POST_INIT_FUNC_NAME           "fmPlatformLibPostInit"
 #define FM_PLAT_SET_VRM_VOLTAGE_FUNC_NAME     "fmPlatformLibSetVrmVoltage"
 #define FM_PLAT_GET_VRM_VOLTAGE_FUNC_NAME     "fmPlatformLibGetVrmVoltage"
+#define FM_PLAT_GET_XCVR_BUS_FUNC_NAME        "fmPlatformLibGetXcvrBus"
 
 #define FM_PLAT_DEBUG_FUNC_NAME_SHORT               "DebugDump"
 #define FM_PLAT_INIT_SW_FUNC_NAME_SHORT             "InitSwitch"
@@ -63,6 +64,7 @@
 #define FM_PLAT_POST_INIT_FUNC_NAME_SHORT           "PostInit"
 #define FM_PLAT_SET_VRM_VOLTAGE_FUNC_NAME_SHORT     "SetVrmVoltage"
 #define FM_PLAT_GET_VRM_VOLTAGE_FUNC_NAME_SHORT     "GetVrmVoltage"
+#define FM_PLAT_GET_XCVR_BUS_FUNC_NAME_SHORT        "GetXcvrBus"
 
 typedef fm_status (*fm_platDoDebug)(fm_int sw,
                                     fm_uint32 hwResourceId,
@@ -124,6 +126,11 @@ typedef fm_status (*fm_platGetVrmVoltage)(fm_int     sw,
                                           fm_uint32  hwResourceId,
                                           fm_uint32 *mVolt);
 
+/* I2C bus of a transceiver, for accessing several buses in parallel */
+typedef fm_status (*fm_platGetXcvrBus)(fm_int     swNum,
+                                       fm_uint32  hwResourceId,
+                                       fm_int    *bus);
+
 #define FM_PLAT_GET_LIB_FUNCS_PTR(sw) (&(fmPlatformProcessState[0].libFuncs))
 
 /* Structure to store platform shared library function pointers */
@@ -142,6 +149,7 @@ typedef struct _fm_platformLib
     fm_platPostInit             PostInit;
     fm_platSetVrmVoltage        SetVrmVoltage;
     fm_platGetVrmVoltage        GetVrmVoltage;
+    fm_platGetXcvrBus           GetXcvrBus;
 
 } fm_platformLib;
 
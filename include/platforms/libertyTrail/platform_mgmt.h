@@ -36,6 +36,23 @@
 
 #define XCVR_EEPROM_CACHE_SIZE  128
 
+/* Transceiver memory is cached in 128-byte blocks: the QSFP lower page and
+ * upper pages 0-3, or the SFP+ A0h and A2h halves */
+#define XCVR_PAGE_CACHE_BLOCK_SIZE  128
+#define XCVR_PAGE_CACHE_NUM_BLOCKS  5
+
+typedef struct
+{
+    /* Indicates whether data holds the block content read from the module */
+    fm_bool valid;
+
+    /* Time the block was read, as returned by fmGetMonotonicNsec */
+    fm_uint64 readTime;
+
+    fm_byte data[XCVR_PAGE_CACHE_BLOCK_SIZE];
+
+} fm_platXcvrPageBlock;
+
 typedef struct
 {
     /* Current ETH mode set on the port associated to this transceiver */
@@ -74,6 +91,20 @@ typedef struct
     /* Transceiver cable length read from the eeprom */
     fm_int cableLength;
 
+    /* Index of the I2C bus worker reading the EEPROM in parallel with the
+     * other buses, or -1 if it is only read by the management thread */
+    fm_int busWorker;
+
+    /* Whether eepromStage holds the EEPROM content read in advance by the
+     * bus worker, and the status of that read */
+    fm_bool   eepromStaged;
+    fm_status eepromStageStatus;
+    fm_byte   eepromStage[XCVR_EEPROM_CACHE_SIZE];
+
+    /* Module memory served to fmPlatformXcvrMemRead and
+     * fmPlatformXcvrEepromRead, dropped on presence change */
+    fm_platXcvrPageBlock pageCache[XCVR_PAGE_CACHE_NUM_BLOCKS];
+
 } fm_platXcvrInfo;
 
 fm_status fmPlatformMgmtTakeSwitchLock(fm_int sw);
@@ -38,6 +38,7 @@
 #include <platforms/common/switch/fm_regs_access_memmap.h>
 #include <platforms/common/switch/fm_regs_access_ebi.h>
 #include <platforms/common/switch/fm_regs_access_i2c.h>
+#include <platforms/common/switch/fm_regs_access_sim.h>
 
 /* For switch utility functions */
 #include <platforms/common/switch/fm10000/fm10000_utils.h>
@@ -46,12 +47,15 @@
 /* For packet transfer */
 #include <platforms/common/packet/generic-packet/fm_generic_packet.h>
 #include <platforms/common/packet/generic-rawsocket/fm_generic_rawsocket.h>
+#include <platforms/common/packet/generic-tpacket/fm_generic_tpacket.h>
+#include <platforms/common/packet/generic-xdp/fm_generic_xdp.h>
 #include <platforms/common/packet/generic-pti/fm10000/fm10000_generic_pti.h>
 //#include <platforms/common/packet/generic-nic/fm_generic_nic.h>
 #include <platforms/common/packet/generic-packet/fm10000/fm10000_generic_tx.h>
 #include <platforms/common/packet/generic-packet/fm10000/fm10000_generic_rx.h>
 
 /* For buffer management */
+#include <platforms/common/buffers/std-alloc/fm_priority_buffer_queues.h>
 #include <platforms/common/buffers/std-alloc/fm_buffer_std_alloc.h>
 
 /* For attribute loader */
@@ -134,6 +138,18 @@ typedef struct
     /* Name of raw packet socket interface  */
     fm_char                 ifaceName[IF_NAMESIZE];
 
+    /* Maximum number of packets per raw socket sendmmsg() call */
+    fm_int                  rawSocketTxBatchSize;
+
+    /* Maximum number of frames per raw socket recvmmsg() call */
+    fm_int                  rawSocketRxBatchSize;
+
+    /* Memory-mapped ring state, NULL unless the 'tpacket' interface is used */
+    fm_tpacketState *       tpacketState;
+
+    /* AF_XDP socket state, NULL unless the 'xdp' interface is used */
+    fm_xdpState *           xdpState;
+
     /**************************************************
      * Memory mapping
      **************************************************/
@@ -176,7 +192,6 @@ typedef struct
     /**************************************************
      *  LED Management
      **************************************************/
-    fm_thread               ledThread;
     fm_platLedInfo         *ledInfo;
 
     /***************************************************
@@ -236,6 +251,9 @@ typedef struct
     /* Optional shared library functions */
     fm_platformLib libFuncs;
 
+    /* Host netdev packet backend initialized for the switch, NULL if none */
+    const struct _fm_platNetdevBackend *netdevBackend;
+
 } fm_platformProcessState;
 
 
@@ -254,6 +272,10 @@ typedef struct _fm_rootPlatform
     fm_platformState       *platformState;
     fm_bufferAllocState     bufferAllocState;
 
+    /* Whether received buffers are tracked in priority buffer queues,
+     * from api.platform.priorityBufferQueues */
+    fm_bool                 enablePriorityScheduling;
+
     fm_int                  switchBootVersion;
 
     /* switch aggregate information */
@@ -82,6 +82,13 @@ fm_status fmPlatformI2cWriteRead(fm_int     sw,
                                  fm_int     write_length,
                                  fm_int     read_length);
 
+fm_status fmPlatformI2cWriteReadBuf(fm_int   sw,
+                                    fm_int   bus,
+                                    fm_int   address,
+                                    fm_byte *data,
+                                    fm_int   wl,
+                                    fm_int   rl);
+
 
 /**************************************************
  * MDIO services
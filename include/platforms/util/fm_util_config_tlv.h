@@ -149,6 +149,30 @@
 #define FM_TVL_API_SERDES_VALIDATE_TIMER            0x103c
 #define FM_TVL_API_SERDES_ACTION_UP_ALLOWED         0x103d
 #define FM_TLV_API_HNI_FLOW_ENTRIES_PER_VF          0x103e
+#define FM_TLV_API_PLAT_RAW_SOCK_TX_BATCH           0x103f
+#define FM_TLV_API_PLAT_RAW_SOCK_RX_BATCH           0x1040
+#define FM_TLV_API_PLAT_TPACKET_RX_BLOCKS           0x1041
+#define FM_TLV_API_PLAT_TPACKET_TX_FRAMES           0x1042
+#define FM_TLV_API_PLAT_PKT_QUEUE_SIZE              0x1043
+#define FM_TLV_API_PLAT_BUFFER_SIZE                 0x1044
+#define FM_TLV_API_PLAT_NUM_BUFFERS                 0x1045
+#define FM_TLV_API_PLAT_BUF_HUGE_PAGES              0x1046
+#define FM_TLV_API_EVENT_RING_QUEUES                0x1047
+#define FM_TLV_API_LOCK_FAST_PATH                   0x1048
+#define FM_TLV_API_THREAD_PLACEMENT                 0x1049
+#define FM_TLV_API_REG_CACHE_SNAPSHOT_FILE          0x104a
+#define FM_TLV_API_DEBUG_BOOT_PROFILE_FILE          0x104b
+#define FM_TLV_API_MA_MAINT_SLICE_ENTRIES           0x104c
+#define FM_TLV_API_MA_MAINT_SLICE_TIME              0x104d
+#define FM_TLV_API_MA_JOURNAL_SIZE                  0x104e
+#define FM_TLV_API_INTR_POLL_BUDGET                 0x104f
+#define FM_TLV_API_INTR_POLL_INTERVAL               0x1050
+#define FM_TLV_API_EVENT_LINK_RESERVE               0x1051
+#define FM_TLV_API_EVENT_MAILBOX_RESERVE            0x1052
+#define FM_TLV_API_MAILBOX_WORKER_THREADS           0x1053
+#define FM_TLV_API_MC_HNI_FLOOD_COALESCE            0x1054
+#define FM_TLV_API_PER_SWITCH_TASKS                 0x1055
+#define FM_TLV_API_PLAT_TPACKET_TX_TIMESTAMPS       0x1056
 
 
 /* FM10K properties */
@@ -194,6 +218,25 @@
 #define FM_TLV_FM10K_UPD_SCHED_ON_LNK_CHANGE        0x2027
 #define FM_TLV_FM10K_PARITY_CRM_TIMEOUT             0x2028
 #define FM_TLV_FM10K_INIT_RESERVED_MAC_TRIGGERS     0x2029
+#define FM_TLV_FM10K_PARITY_SWEEP_BUDGET            0x202a
+#define FM_TLV_FM10K_PORT_INIT_THREADS              0x202b
+#define FM_TLV_FM10K_MA_TCN_BURST_READ              0x202c
+#define FM_TLV_FM10K_MA_LEARNING_RATE_LIMIT         0x202d
+#define FM_TLV_FM10K_MA_PORT_LEARNING_RATE_LIMIT    0x202e
+#define FM_TLV_FM10K_ACL_COMPILE_THREADS            0x202f
+#define FM_TLV_FM10K_ACL_COMPILE_VALIDATE           0x2030
+#define FM_TLV_FM10K_INTR_LINK_POLL_TIME            0x2031
+#define FM_TLV_FM10K_INTR_MATCN_POLL_TIME           0x2032
+#define FM_TLV_FM10K_INTR_MAILBOX_POLL_TIME         0x2033
+#define FM_TLV_FM10K_DFE_MAX_CONCURRENT_TUNINGS     0x2034
+#define FM_TLV_FM10K_DFE_UPLINK_EPL_MASK            0x2035
+#define FM_TLV_FM10K_DFE_ADAPTIVE_TIMEOUT           0x2036
+#define FM_TLV_FM10K_MAILBOX_BATCH_REQUESTS         0x2037
+#define FM_TLV_FM10K_LAG_FAST_FAILOVER              0x2038
+#define FM_TLV_FM10K_MTABLE_CLEANUP_BUDGET          0x2039
+#define FM_TLV_FM10K_MTABLE_CLEANUP_FREE_BLOCK      0x203A
+#define FM_TLV_FM10K_PARITY_COALESCE_WINDOW         0x203B
+#define FM_TLV_FM10K_PARITY_COALESCE_THRESHOLD      0x203C
 
 
 /* Undocumented FM10K properties  */
@@ -219,6 +262,7 @@
 #define FM_TLV_FM10K_EEE_SPICO_INTR                 0x2816 
 #define FM_TLV_FM10K_USE_ALTERNATE_SPICO_FW         0x2817 
 #define FM_TLV_FM10K_ALLOW_KRPCAL_ON_EEE            0x2818 
+#define FM_TLV_FM10K_REUSE_LOADED_SPICO_FW          0x2819
 
 
 /* Liberty Trail platform properties */
@@ -318,6 +362,9 @@
 #define FM_TLV_PLAT_SW_PORTIDX_LANE_ALL_RX_TERM     0x3059
 #define FM_TLV_PLAT_SW_PORTIDX_LANE_RX_TERM         0x305a
 #define FM_TLV_PLAT_SW_I2C_CLKDIVIDER               0x305b
+#define FM_TLV_PLAT_SW_CSR_WIDE_ACCESS              0x305c
+#define FM_TLV_PLAT_SW_I2C_BURST_WORDS              0x305d
+#define FM_TLV_PLAT_SW_XCVR_DOM_REFRESH_PER         0x305e
 
 /* Undocumented Liberty Trail platform properties */
 #define FM_TLV_PLAT_EBI_DEVNAME                     0x4000
@@ -332,6 +379,7 @@
 #define FM_TLV_PLAT_CPU_PORT                        0x4009
 #define FM_TLV_PLAT_INTR_POLL_PER                   0x400a
 #define FM_TLV_PLAT_PHY_EN_DEEMPHASIS               0x400b
+#define FM_TLV_PLAT_SIM_ACCESS_LATENCY              0x400c
 
 
 /* Shared library properties */
@@ -152,6 +152,16 @@ fm_status fmUtilGN2412Initialize(fm_uintptr                  handle,
                                  fm_uint                     dev,
                                  fm_gn2412Cfg *              cfg);
 
+fm_status fmUtilGN2412InitializeStart(fm_uintptr                  handle,
+                                      fm_utilI2cWriteReadHdnlFunc func,
+                                      fm_uint                     dev,
+                                      fm_gn2412Cfg *              cfg);
+
+fm_status fmUtilGN2412InitializeComplete(fm_uintptr                  handle,
+                                         fm_utilI2cWriteReadHdnlFunc func,
+                                         fm_uint                     dev,
+                                         fm_gn2412Cfg *              cfg);
+
 void fmUtilGN2412DumpConnections(fm_uintptr                  handle,
                                  fm_utilI2cWriteReadHdnlFunc func,
                                  fm_uint                     dev);
@@ -166,6 +176,13 @@ fm_status fmUtilGN2412SetAppMode(fm_uintptr                  handle,
                                  fm_int                      lane,
                                  fm_int                      mode);
 
+fm_status fmUtilGN2412SetAppModes(fm_uintptr                  handle,
+                                  fm_utilI2cWriteReadHdnlFunc func,
+                                  fm_uint                     dev,
+                                  fm_int                      numLanes,
+                                  const fm_int *              lanes,
+                                  const fm_int *              modes);
+
 void fmUtilGN2412DumpAppMode(fm_uintptr                  handle,
                              fm_utilI2cWriteReadHdnlFunc func,
                              fm_uint                     dev);
@@ -44,6 +44,54 @@
 #define MEMORY_DEBUG_CALLER  FALSE
 #define FM_SHM_TIMEOUT       60
 
+/**************************************************
+ * Small objects are allocated from and freed to a
+ * per-thread cache of free objects of each size,
+ * refilled from and spilled to the shared buckets
+ * in batches. The cache is disabled when valgrind
+ * or caller tracking need to see every allocation.
+ **************************************************/
+#if defined(FM_HAVE_VALGRIND) || MEMORY_DEBUG_CALLER
+#define USE_ALLOC_CACHE      FALSE
+#else
+#define USE_ALLOC_CACHE      TRUE
+#endif
+
+/* Largest cached bucket size, object header included */
+#define ALLOC_CACHE_MAX_SIZE 512
+
+/* Number of cached sizes, one per multiple of 8 bytes */
+#define ALLOC_CACHE_CLASSES  (ALLOC_CACHE_MAX_SIZE / 8)
+
+/* Maximum number of free objects cached per size */
+#define ALLOC_CACHE_DEPTH    32
+
+/* Number of objects moved between a cache and a bucket at once */
+#define ALLOC_CACHE_BATCH    16
+
+/* Cache size class of a bucket size */
+#define ALLOC_CACHE_CLASS(size)  ( ( (size) / 8 ) - 1 )
+
+/**************************************************
+ * The shared memory can be backed by huge pages
+ * from the hugetlb pool, so that the tables kept
+ * in it are covered by a few TLB entries. Set the
+ * variable to "2M" or "1G" to request them; the
+ * region falls back to smaller pages when the pool
+ * is empty or the size does not fit the region.
+ **************************************************/
+#define FM_SHM_HUGEPAGES_ENV "FM_API_SHM_HUGEPAGES"
+
+#define HUGE_PAGE_SIZE_2M    FM_LITERAL_U64(0x200000)
+#define HUGE_PAGE_SIZE_1G    FM_LITERAL_U64(0x40000000)
+
+/* shmget and mmap encode the huge page size the same way */
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT       26
+#endif
+
+#define HUGE_PAGE_FLAGS(size)  ( __builtin_ctzll(size) << MAP_HUGE_SHIFT )
+
 #if MEMORY_DEBUG_CALLER
 
 #define DBG_FULL_CALLER_DEPTH FALSE
@@ -100,6 +148,9 @@ typedef struct _fm_memoryBucket
     /* Linked list of free objects (first word contains next pointer) */
     void *  freeList;
 
+    /* Spin lock protecting freeList, see LockBucket */
+    fm_int  lock;
+
     /* Next-larger-sized memory bucket (must be in sorted order) */
     struct _fm_memoryBucket *next;
 
@@ -159,9 +210,23 @@ typedef struct _fm_sharedHeader
     /* First byte in the shared memory that has never been allocated */
     void *           freeSpace;
 
-    /* Mutex used to lock "buckets" and "freeSpace" during alloc/free */
+    /* Mutex used to lock "buckets" and "freeSpace" during alloc/free.
+     * Each bucket's free list has its own lock. */
     pthread_mutex_t  mutex;
 
+    /* Thread cache allocations served from and not from the cache,
+     * accumulated from each thread at cache misses and thread exit */
+    fm_uint64        cacheHits;
+    fm_uint64        cacheMisses;
+
+    /* Live objects of each allocation tag, see fmAllocTagged */
+    fm_allocTagStats tagStats[FM_ALLOC_NUM_TAGS];
+
+    /* Size of the pages backing the shared memory, and whether they
+     * come from the hugetlb pool */
+    fm_uint64        pageSize;
+    fm_bool          hugeTlb;
+
     /* Mutex used to lock root list during fmGetRoot */
     pthread_mutex_t  rootMutex;
 
@@ -180,8 +245,13 @@ typedef struct _fm_sharedHeader
 /* Additional information kept below the allocated object */
 typedef struct _fm_objectHeader
 {
-    /* Memory bucket this object was allocated from */
-    fm_memoryBucket *myBucket;
+    /* Offset in the shared memory of the memory bucket this object was
+     * allocated from. Storing an offset rather than a pointer leaves room
+     * for the tag without growing the header on 64-bit builds. */
+    fm_uint32        bucketOffset;
+
+    /* Allocation tag of the object, see fmAllocTagged */
+    fm_uint32        tag;
 
 #if MEMORY_DEBUG_CALLER
     void *           caller;
@@ -209,6 +279,25 @@ typedef struct _fm_callerInfo
 #endif
 
 
+/* Per-thread cache of free small objects, process-local */
+typedef struct _fm_allocCache
+{
+    /* Free objects of each size class, linked through their first word */
+    void *           freeList[ALLOC_CACHE_CLASSES];
+
+    /* Number of objects in each of the above lists */
+    fm_int           count[ALLOC_CACHE_CLASSES];
+
+    /* Bucket of each size class, once known */
+    fm_memoryBucket *bucket[ALLOC_CACHE_CLASSES];
+
+    /* Hits and misses not yet added to the shared header */
+    fm_uint64        hits;
+    fm_uint64        misses;
+
+} fm_allocCache;
+
+
 #define BUCKET_SIGNATURE     0x4ffe874
 
 #define IN_SHARED_MEMORY(x)                                         \
@@ -219,6 +308,11 @@ typedef struct _fm_callerInfo
 /* Round up to a multiple of 8 */
 #define ROUND_UP(x)  ( ( (x - 1) | 7 ) + 1 )
 
+/* Memory bucket an object was allocated from */
+#define OBJ_BUCKET(objHdr)                                          \
+    ( (fm_memoryBucket *) ( (fm_uintptr) FM_SHARED_MEMORY_ADDR +    \
+                            (fm_uintptr) (objHdr)->bucketOffset ) )
+
 /* FNV hash constants from http://isthe.com/chongo/tech/comp/fnv/ */
 #define FNV_OFFSET_BASIS_64  FM_LITERAL_U64(14695981039346656037)
 #define FNV_PRIME_64         FM_LITERAL_U64(1099511628211)
@@ -234,6 +328,13 @@ typedef struct _fm_callerInfo
 /* Process local variable indicating whether the process created the SHM */
 fm_bool processCreatedSHM = FALSE;
 
+#if USE_ALLOC_CACHE
+static void DestroyAllocCache(void *arg);
+
+/* The calling thread's allocation cache */
+static fm_threadLocal allocCache = FM_THREAD_LOCAL_INIT(DestroyAllocCache);
+#endif
+
 /*****************************************************************************
  * Local function prototypes.
  *****************************************************************************/
@@ -302,6 +403,288 @@ static void MemoryCorruptionWarning(void)
 
 
 
+/*****************************************************************************/
+/** GetRequestedHugePageSize
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Return the huge page size requested for the shared
+ *                  memory through the FM_API_SHM_HUGEPAGES environment
+ *                  variable, "2M" or "1G".
+ *
+ * \param           None.
+ *
+ * \return          The requested page size in bytes, or 0 if huge pages
+ *                  were not requested.
+ *
+ *****************************************************************************/
+static fm_uint64 GetRequestedHugePageSize(void)
+{
+    fm_text value;
+
+    value = getenv(FM_SHM_HUGEPAGES_ENV);
+
+    if (value == NULL)
+    {
+        return 0;
+    }
+    else if (strcasecmp(value, "1G") == 0)
+    {
+        return HUGE_PAGE_SIZE_1G;
+    }
+    else if (strcasecmp(value, "2M") == 0)
+    {
+        return HUGE_PAGE_SIZE_2M;
+    }
+
+    FM_LOG_WARNING(FM_LOG_CAT_ALOS,
+                   FM_SHM_HUGEPAGES_ENV " should be \"2M\" or \"1G\", "
+                   "using base pages\n");
+
+    return 0;
+
+}   /* end GetRequestedHugePageSize */
+
+
+
+
+/*****************************************************************************/
+/** NextHugePageSize
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Return the huge page size to fall back to when pages
+ *                  of the given size cannot back the shared memory.
+ *                  Sizes that do not divide both the fixed address and
+ *                  the size of the region are skipped.
+ *
+ * \param[in]       pageSize is the page size to fall back from.
+ *
+ * \param[in]       first is TRUE to consider pageSize itself.
+ *
+ * \return          The next usable huge page size, or 0 if the region
+ *                  must use base pages.
+ *
+ *****************************************************************************/
+static fm_uint64 NextHugePageSize(fm_uint64 pageSize, fm_bool first)
+{
+    if (!first)
+    {
+        pageSize = (pageSize == HUGE_PAGE_SIZE_1G) ? HUGE_PAGE_SIZE_2M : 0;
+    }
+
+    while (pageSize != 0)
+    {
+        if ( ( ( (fm_uintptr) FM_SHARED_MEMORY_ADDR % pageSize ) == 0 ) &&
+             ( ( (fm_uint64) FM_SHARED_MEMORY_SIZE % pageSize ) == 0 ) )
+        {
+            break;
+        }
+
+        pageSize = (pageSize == HUGE_PAGE_SIZE_1G) ? HUGE_PAGE_SIZE_2M : 0;
+    }
+
+    return pageSize;
+
+}   /* end NextHugePageSize */
+
+
+
+
+/*****************************************************************************/
+/** CreateHugePageShm
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Create the SysV shared memory segment from the hugetlb
+ *                  pool, trying the requested page size first and then
+ *                  smaller huge pages.
+ *
+ * \param[in]       shmKey is the key of the segment.
+ *
+ * \param[in]       flags are the permission flags of the segment.
+ *
+ * \param[in,out]   pageSize points to the requested page size on entry,
+ *                  and receives the page size of the segment on success.
+ *
+ * \return          The segment ID, or -1 if the hugetlb pool could not
+ *                  back the segment. errno is left as set by shmget.
+ *
+ *****************************************************************************/
+static fm_int CreateHugePageShm(fm_int shmKey, fm_int flags, fm_uint64 *pageSize)
+{
+    fm_uint64 size;
+    fm_int    shmId = -1;
+
+    for (size = NextHugePageSize(*pageSize, TRUE) ;
+         size != 0 ;
+         size = NextHugePageSize(size, FALSE))
+    {
+        shmId = shmget(shmKey,
+                       FM_SHARED_MEMORY_SIZE,
+                       IPC_CREAT | IPC_EXCL | SHM_HUGETLB |
+                           HUGE_PAGE_FLAGS(size) | flags);
+
+        if (shmId != -1)
+        {
+            *pageSize = size;
+            break;
+        }
+
+        FM_LOG_DEBUG(FM_LOG_CAT_ALOS,
+                     "No %" FM_FORMAT_64 "uK huge pages for shared memory "
+                     "(errno %d)\n",
+                     size / 1024,
+                     errno);
+    }
+
+    return shmId;
+
+}   /* end CreateHugePageShm */
+
+
+
+
+/*****************************************************************************/
+/** MapHugePages
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Map the anonymous memory region from the hugetlb pool,
+ *                  trying the requested page size first and then smaller
+ *                  huge pages. A mapping the kernel placed away from the
+ *                  fixed address is released.
+ *
+ * \param[in,out]   pageSize points to the requested page size on entry,
+ *                  and receives the page size of the mapping on success.
+ *
+ * \return          Address of the mapping, or MAP_FAILED if the hugetlb
+ *                  pool could not back the region.
+ *
+ *****************************************************************************/
+static void *MapHugePages(fm_uint64 *pageSize)
+{
+    fm_uint64 size;
+    void *    addr = MAP_FAILED;
+
+    for (size = NextHugePageSize(*pageSize, TRUE) ;
+         size != 0 ;
+         size = NextHugePageSize(size, FALSE))
+    {
+        addr = mmap( (void *) FM_SHARED_MEMORY_ADDR,
+                     FM_SHARED_MEMORY_SIZE,
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB |
+                         HUGE_PAGE_FLAGS(size),
+                     -1,
+                     0);
+
+        if (addr == (void *) FM_SHARED_MEMORY_ADDR)
+        {
+            *pageSize = size;
+            break;
+        }
+
+        if (addr != MAP_FAILED)
+        {
+            munmap(addr, FM_SHARED_MEMORY_SIZE);
+            addr = MAP_FAILED;
+        }
+
+        FM_LOG_DEBUG(FM_LOG_CAT_ALOS,
+                     "No %" FM_FORMAT_64 "uK huge pages for shared memory\n",
+                     size / 1024);
+    }
+
+    return addr;
+
+}   /* end MapHugePages */
+
+
+
+
+/*****************************************************************************/
+/** DumpTlbStats
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Print the page size backing the shared memory and the
+ *                  number of TLB entries needed to cover its used part,
+ *                  along with the kernel's view of the mapping from
+ *                  /proc/self/smaps, which also shows transparent huge
+ *                  pages backing a base page mapping.
+ *
+ * \param[in]       hdr points to the shared memory header.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void DumpTlbStats(fm_sharedHeader *hdr)
+{
+    fm_uint64     footprint;
+    fm_uint64     basePage;
+    unsigned long start;
+    unsigned long end;
+    unsigned long value;
+    unsigned long kernelPageKb = 0;
+    unsigned long anonHugeKb   = 0;
+    unsigned long shmemPmdKb   = 0;
+    fm_bool       inRegion     = FALSE;
+    char          line[256];
+    FILE *        f;
+
+    footprint = (fm_uintptr) hdr->freeSpace - (fm_uintptr) FM_SHARED_MEMORY_ADDR;
+    basePage  = (fm_uint64) sysconf(_SC_PAGESIZE);
+
+    FM_LOG_PRINT("Page size: %" FM_FORMAT_64 "uK (%s)\n",
+                 hdr->pageSize / 1024,
+                 hdr->hugeTlb ? "hugetlb" : "base pages");
+    FM_LOG_PRINT("TLB entries to cover %" FM_FORMAT_64 "u bytes used: %"
+                 FM_FORMAT_64 "u, with base pages: %" FM_FORMAT_64 "u\n",
+                 footprint,
+                 (footprint + hdr->pageSize - 1) / hdr->pageSize,
+                 (footprint + basePage - 1) / basePage);
+
+    f = fopen("/proc/self/smaps", "r");
+
+    if (f == NULL)
+    {
+        return;
+    }
+
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        /* Each mapping starts with a "start-end" address range line */
+        if (sscanf(line, "%lx-%lx ", &start, &end) == 2)
+        {
+            inRegion = ( start == (unsigned long) FM_SHARED_MEMORY_ADDR );
+        }
+        else if (!inRegion)
+        {
+            continue;
+        }
+        else if (sscanf(line, "KernelPageSize: %lu kB", &value) == 1)
+        {
+            kernelPageKb = value;
+        }
+        else if (sscanf(line, "AnonHugePages: %lu kB", &value) == 1)
+        {
+            anonHugeKb = value;
+        }
+        else if (sscanf(line, "ShmemPmdMapped: %lu kB", &value) == 1)
+        {
+            shmemPmdKb = value;
+        }
+    }
+
+    fclose(f);
+
+    FM_LOG_PRINT("Kernel page size: %luK, transparent huge pages: "
+                 "%luK anonymous, %luK shared\n",
+                 kernelPageKb,
+                 anonHugeKb,
+                 shmemPmdKb);
+
+}   /* end DumpTlbStats */
+
+
+
+
 /*****************************************************************************/
 /** GetBucket
  * \ingroup intAlosAlloc
@@ -361,6 +744,7 @@ static fm_memoryBucket *GetBucket(fm_sharedHeader *hdr, fm_uint size)
         bucket->signature                  = BUCKET_SIGNATURE;
         bucket->size                       = size;
         bucket->freeList                   = NULL;
+        bucket->lock                       = 0;
         bucket->next                       = *ptr;
         bucket->allocationRemainderBitmask = 0;
 
@@ -525,6 +909,499 @@ static void UnlockRootMutex(fm_sharedHeader *hdr)
 
 
 
+/*****************************************************************************/
+/** LockBucket
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Lock the free list of a memory bucket. This is a spin
+ *                  lock in shared memory, so that it works across processes;
+ *                  it is only held for a few pointer updates. When both are
+ *                  needed, the shared memory mutex is taken first.
+ *
+ * \param[in]       bucket points to the memory bucket.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void LockBucket(fm_memoryBucket *bucket)
+{
+    fm_int expected;
+
+    while (1)
+    {
+        expected = 0;
+
+        if ( FM_ATOMIC_CAS(&bucket->lock, &expected, 1) )
+        {
+            return;
+        }
+
+        while (FM_ATOMIC_LOAD(&bucket->lock) != 0)
+        {
+            sched_yield();
+        }
+    }
+
+}   /* end LockBucket */
+
+
+
+
+/*****************************************************************************/
+/** UnlockBucket
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Unlock the free list of a memory bucket.
+ *
+ * \param[in]       bucket points to the memory bucket.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void UnlockBucket(fm_memoryBucket *bucket)
+{
+    FM_ATOMIC_STORE(&bucket->lock, 0);
+
+}   /* end UnlockBucket */
+
+
+
+
+#if USE_ALLOC_CACHE
+/*****************************************************************************/
+/** ReleaseToBucket
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Put a list of free objects back on their bucket's free
+ *                  list.
+ *
+ * \param[in]       bucket points to the memory bucket.
+ *
+ * \param[in]       head is the first object of the list, linked through
+ *                  the first word of each object.
+ *
+ * \param[in]       tail is the last object of the list.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReleaseToBucket(fm_memoryBucket *bucket, void *head, void *tail)
+{
+    LockBucket(bucket);
+
+    *(void **) tail  = bucket->freeList;
+    bucket->freeList = head;
+
+    UnlockBucket(bucket);
+
+}   /* end ReleaseToBucket */
+
+
+
+
+/*****************************************************************************/
+/** FlushCacheStats
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Add a thread's cache hits and misses to the shared
+ *                  header's.
+ *
+ * \param[in]       cache points to the thread's allocation cache.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void FlushCacheStats(fm_allocCache *cache)
+{
+    fm_sharedHeader *hdr = (fm_sharedHeader *) FM_SHARED_MEMORY_ADDR;
+
+    FM_ATOMIC_ADD(&hdr->cacheHits, cache->hits);
+    FM_ATOMIC_ADD(&hdr->cacheMisses, cache->misses);
+
+    cache->hits   = 0;
+    cache->misses = 0;
+
+}   /* end FlushCacheStats */
+
+
+
+
+/*****************************************************************************/
+/** DestroyAllocCache
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Called upon thread exit, returns the objects cached by
+ *                  the thread to their buckets.
+ *
+ * \param[in]       arg points to the thread's allocation cache.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void DestroyAllocCache(void *arg)
+{
+    fm_allocCache *cache = arg;
+    void *         tail;
+    fm_int         i;
+
+    for (i = 0 ; i < ALLOC_CACHE_CLASSES ; i++)
+    {
+        if (cache->count[i] > 0)
+        {
+            for (tail = cache->freeList[i] ;
+                 *(void **) tail != NULL ;
+                 tail = *(void **) tail)
+            {
+            }
+
+            ReleaseToBucket(cache->bucket[i], cache->freeList[i], tail);
+        }
+    }
+
+    FlushCacheStats(cache);
+
+    free(cache);
+
+}   /* end DestroyAllocCache */
+
+
+
+
+/*****************************************************************************/
+/** GetAllocCache
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Return the calling thread's allocation cache, creating
+ *                  it on first use. The cache is process-local, so it is
+ *                  allocated from the process heap.
+ *
+ * \param           None.
+ *
+ * \return          Pointer to the cache, or NULL if it could not be created,
+ *                  in which case the buckets are used directly.
+ *
+ *****************************************************************************/
+static fm_allocCache *GetAllocCache(void)
+{
+    fm_allocCache *cache;
+
+    cache = fmGetThreadLocal(&allocCache);
+
+    if (cache == NULL)
+    {
+        cache = calloc( 1, sizeof(fm_allocCache) );
+
+        if (cache == NULL)
+        {
+            return NULL;
+        }
+
+        if (fmSetThreadLocal(&allocCache, cache) != FM_OK)
+        {
+            free(cache);
+            return NULL;
+        }
+    }
+
+    return cache;
+
+}   /* end GetAllocCache */
+
+
+
+
+/*****************************************************************************/
+/** CacheAlloc
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Allocate a small object from the calling thread's cache,
+ *                  refilling it with a batch of objects from the bucket's
+ *                  free list when empty.
+ *
+ * \param[in]       hdr points to the shared memory header.
+ *
+ * \param[in]       size is the bucket size, object header included.
+ *
+ * \param[in]       remainderBit is the bit of the
+ *                  allocationRemainderBitmask statistic for this request.
+ *
+ * \return          Pointer to the object, or NULL if the caller has to
+ *                  allocate it from the shared memory.
+ *
+ *****************************************************************************/
+static void *CacheAlloc(fm_sharedHeader *hdr, fm_uint size, fm_byte remainderBit)
+{
+    fm_allocCache *  cache;
+    fm_memoryBucket *bucket;
+    void *           obj;
+    void *           tail;
+    fm_int           sizeClass;
+    fm_int           n;
+
+    cache = GetAllocCache();
+
+    if (cache == NULL)
+    {
+        return NULL;
+    }
+
+    sizeClass = ALLOC_CACHE_CLASS(size);
+
+    if (cache->count[sizeClass] > 0)
+    {
+        cache->hits++;
+        bucket = cache->bucket[sizeClass];
+    }
+    else
+    {
+        cache->misses++;
+        FlushCacheStats(cache);
+
+        bucket = cache->bucket[sizeClass];
+
+        if (bucket == NULL)
+        {
+            LockMutex(hdr);
+            bucket = GetBucket(hdr, size);
+            UnlockMutex(hdr);
+
+            if (bucket == NULL)
+            {
+                return NULL;
+            }
+
+            cache->bucket[sizeClass] = bucket;
+        }
+
+        /* Take a batch of objects off the bucket's free list */
+        LockBucket(bucket);
+
+        obj  = bucket->freeList;
+        tail = NULL;
+
+        for (n = 0 ; (n < ALLOC_CACHE_BATCH) && (obj != NULL) ; n++)
+        {
+            tail = obj;
+            obj  = *(void **) obj;
+        }
+
+        if (tail != NULL)
+        {
+            cache->freeList[sizeClass] = bucket->freeList;
+            bucket->freeList           = obj;
+            *(void **) tail            = NULL;
+        }
+
+        UnlockBucket(bucket);
+
+        if (n == 0)
+        {
+            /* The caller carves a new object out of the shared memory */
+            return NULL;
+        }
+
+        cache->count[sizeClass] = n;
+    }
+
+    obj = cache->freeList[sizeClass];
+    cache->freeList[sizeClass] = *(void **) obj;
+    cache->count[sizeClass]--;
+
+    if ( (bucket->allocationRemainderBitmask & remainderBit) == 0 )
+    {
+        FM_ATOMIC_OR(&bucket->allocationRemainderBitmask, remainderBit);
+    }
+
+    return obj;
+
+}   /* end CacheAlloc */
+
+
+
+
+/*****************************************************************************/
+/** CacheFree
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Free a small object to the calling thread's cache,
+ *                  returning a batch of objects to the bucket's free list
+ *                  when full.
+ *
+ * \param[in]       bucket points to the object's memory bucket.
+ *
+ * \param[in]       obj is the object to free.
+ *
+ * \return          TRUE if the object was freed, FALSE if the caller has
+ *                  to put it back on the bucket's free list.
+ *
+ *****************************************************************************/
+static fm_bool CacheFree(fm_memoryBucket *bucket, void *obj)
+{
+    fm_allocCache *cache;
+    fm_int         sizeClass;
+    void *         head;
+    void *         tail;
+    fm_int         n;
+
+    if (bucket->size > ALLOC_CACHE_MAX_SIZE)
+    {
+        return FALSE;
+    }
+
+    cache = GetAllocCache();
+
+    if (cache == NULL)
+    {
+        return FALSE;
+    }
+
+    sizeClass                = ALLOC_CACHE_CLASS(bucket->size);
+    cache->bucket[sizeClass] = bucket;
+
+    *(void **) obj             = cache->freeList[sizeClass];
+    cache->freeList[sizeClass] = obj;
+
+    if (++cache->count[sizeClass] > ALLOC_CACHE_DEPTH)
+    {
+        /* Return the most recently freed batch to the bucket */
+        head = cache->freeList[sizeClass];
+        tail = head;
+
+        for (n = 1 ; n < ALLOC_CACHE_BATCH ; n++)
+        {
+            tail = *(void **) tail;
+        }
+
+        cache->freeList[sizeClass] = *(void **) tail;
+        cache->count[sizeClass]   -= ALLOC_CACHE_BATCH;
+
+        ReleaseToBucket(bucket, head, tail);
+    }
+
+    return TRUE;
+
+}   /* end CacheFree */
+#endif  /* USE_ALLOC_CACHE */
+
+
+
+
+/*****************************************************************************/
+/** TagIndex
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Returns the allocation tag of a log category.
+ *
+ * \param[in]       category is the log category, a single FM_LOG_CAT_XXX
+ *                  bit. If several bits are set, the lowest one is used.
+ *
+ * \return          The tag, FM_ALLOC_TAG_UNTAGGED if category is
+ *                  FM_LOG_CAT_NONE.
+ *
+ *****************************************************************************/
+static fm_uint TagIndex(fm_uint64 category)
+{
+
+    if (category == FM_LOG_CAT_NONE)
+    {
+        return FM_ALLOC_TAG_UNTAGGED;
+    }
+
+    return (fm_uint) __builtin_ctzll(category);
+
+}   /* end TagIndex */
+
+
+
+
+/*****************************************************************************/
+/** AccountAlloc
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Tags a newly allocated object and adds it to the
+ *                  statistics of its tag.
+ *
+ * \param[in]       hdr points to the shared memory header.
+ *
+ * \param[in]       obj is the object.
+ *
+ * \param[in]       tag is the allocation tag.
+ *
+ * \param[in]       size is the bucket size of the object, object header
+ *                  included.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void AccountAlloc(fm_sharedHeader *hdr,
+                         void *           obj,
+                         fm_uint          tag,
+                         fm_uint          size)
+{
+    fm_objectHeader * objHdr;
+    fm_allocTagStats *stats;
+    fm_uint64         live;
+    fm_uint64         peak;
+
+    objHdr      = (fm_objectHeader *)
+                  ( (unsigned char *) obj - sizeof(fm_objectHeader) );
+    objHdr->tag = tag;
+
+    stats = &hdr->tagStats[tag];
+
+    FM_ATOMIC_ADD_RELAXED(&stats->allocs, 1);
+    live = FM_ATOMIC_ADD_RELAXED(&stats->liveBytes, size);
+    peak = FM_ATOMIC_LOAD_RELAXED(&stats->peakBytes);
+
+    /* On failure, FM_ATOMIC_CAS reloads the current peak */
+    while ( (live > peak) && !FM_ATOMIC_CAS(&stats->peakBytes, &peak, live) )
+    {
+    }
+
+}   /* end AccountAlloc */
+
+
+
+
+/*****************************************************************************/
+/** AccountFree
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Removes an object being freed from the statistics of
+ *                  its tag.
+ *
+ * \param[in]       hdr points to the shared memory header.
+ *
+ * \param[in]       objHdr points to the header of the object.
+ *
+ * \param[in]       size is the bucket size of the object, object header
+ *                  included.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void AccountFree(fm_sharedHeader *hdr,
+                        fm_objectHeader *objHdr,
+                        fm_uint          size)
+{
+    fm_allocTagStats *stats;
+
+    if (objHdr->tag >= FM_ALLOC_NUM_TAGS)
+    {
+        MemoryCorruptionWarning();
+        return;
+    }
+
+    stats = &hdr->tagStats[objHdr->tag];
+
+    FM_ATOMIC_ADD_RELAXED(&stats->frees, 1);
+    FM_ATOMIC_ADD_RELAXED(&stats->liveBytes, -(fm_uint64) size);
+
+}   /* end AccountFree */
+
+
+
+
 #if MEMORY_DEBUG_CALLER
 static void DeleteCallerInfo(void *p)
 {
@@ -538,7 +1415,66 @@ static void DeleteCallerInfo(void *p)
 
 
 
-#endif
+#endif
+
+
+
+
+/*****************************************************************************/
+/** CheckSharedHeader
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Verifies that a shared memory region created by another
+ *                  process was set up by this build of the API and is
+ *                  mapped where that process mapped it.
+ *
+ * \param[in]       hdr points to the header of the shared memory region.
+ *
+ * \param[in]       addr is the address at which the region is mapped.
+ *
+ * \return          FM_OK if the region can be used.
+ * \return          FM_FAIL otherwise.
+ *
+ *****************************************************************************/
+static fm_status CheckSharedHeader(fm_sharedHeader *hdr, void *addr)
+{
+
+    if ( hdr->versionIdentifier != VersionIdentifier() )
+    {
+        FM_LOG_FATAL(FM_LOG_CAT_ALOS,
+                     "Version signature mismatch in shared memory\n");
+        return FM_FAIL;
+    }
+
+    if (hdr->self != addr)
+    {
+        FM_LOG_FATAL(FM_LOG_CAT_ALOS,
+                     "Start address mismatch in shared memory\n");
+        return FM_FAIL;
+    }
+
+    if ( hdr->end != (void *) ((fm_uintptr)FM_SHARED_MEMORY_ADDR +
+                               (fm_uintptr)FM_SHARED_MEMORY_SIZE) )
+    {
+        FM_LOG_FATAL(FM_LOG_CAT_ALOS,
+                     "End address mismatch in shared memory\n");
+        return FM_FAIL;
+    }
+
+    if (hdr->funcInSharedLibrary != MemoryCorruptionWarning)
+    {
+        FM_LOG_FATAL(FM_LOG_CAT_ALOS,
+                     "Shared library seems to be loaded at a "
+                     "different address\n");
+        return FM_FAIL;
+    }
+
+    return FM_OK;
+
+}   /* end CheckSharedHeader */
+
+
+
 
 /*****************************************************************************
  * Public Functions
@@ -557,12 +1493,41 @@ static void DeleteCallerInfo(void *p)
  *
  *****************************************************************************/
 void *fmAlloc(fm_uint size)
+{
+
+    return fmAllocTagged(size, FM_LOG_CAT_NONE);
+
+}   /* end fmAlloc */
+
+
+
+
+/*****************************************************************************/
+/** fmAllocTagged
+ * \ingroup alosAlloc
+ *
+ * \desc            Allocates memory on behalf of a subsystem. The memory
+ *                  is counted in the statistics of the subsystem until it
+ *                  is freed with fmFree, see fmGetAllocTagStats.
+ *
+ * \param[in]       size is the number of bytes to allocate
+ *
+ * \param[in]       category is the log category of the subsystem, a single
+ *                  FM_LOG_CAT_XXX bit, or FM_LOG_CAT_NONE for memory that
+ *                  is not tagged, as allocated by fmAlloc.
+ *
+ * \return          pointer to allocated memory if successful.
+ *                  NULL if not successful.
+ *
+ *****************************************************************************/
+void *fmAllocTagged(fm_uint size, fm_uint64 category)
 {
     fm_memoryBucket *bucket;
     fm_objectHeader *objHdr;
     fm_sharedHeader *hdr = (fm_sharedHeader *) FM_SHARED_MEMORY_ADDR;
     fm_uint          originalSize;
     fm_uint          unroundedSize;
+    fm_uint          tag;
     unsigned char *  ptr;
     void *           newObject = NULL;
 
@@ -573,7 +1538,7 @@ void *fmAlloc(fm_uint size)
 
 #if MEMORY_DEBUG_CALLER
 #if !DBG_FULL_CALLER_DEPTH
-    void *           btBuffer[2];
+    void *           btBuffer[3];
 #endif
 #endif
 
@@ -593,6 +1558,29 @@ void *fmAlloc(fm_uint size)
                            FM_SHARED_MEMORY_SIZE);
     }
 
+    tag           = TagIndex(category);
+    originalSize  = size;
+    size         += sizeof(fm_objectHeader);
+    unroundedSize = size;
+    size          = ROUND_UP(size);
+
+#if USE_ALLOC_CACHE
+    if (size <= ALLOC_CACHE_MAX_SIZE)
+    {
+        newObject = CacheAlloc(hdr, size, 1 << (size - unroundedSize));
+
+        if (newObject != NULL)
+        {
+            AccountAlloc(hdr, newObject, tag, size);
+
+            FM_LOG_DEBUG(FM_LOG_CAT_ALOS,
+                          "Exiting... (object=%p)\n", newObject);
+
+            return newObject;
+        }
+    }
+#endif
+
     LockMutex(hdr);
 
 #ifdef FM_HAVE_VALGRIND
@@ -600,16 +1588,21 @@ void *fmAlloc(fm_uint size)
     FM_VALGRIND_MAKE_BUCKET_MEM_DEFINED(hdr, it);
 #endif
 
-    originalSize  = size;
-    size         += sizeof(fm_objectHeader);
-    unroundedSize = size;
-    size          = ROUND_UP(size);
-    bucket        = GetBucket(hdr, size);
+    bucket = GetBucket(hdr, size);
 
     if (bucket != NULL)
     {
+        LockBucket(bucket);
+
         newObject = bucket->freeList;
 
+        if (newObject != NULL)
+        {
+            bucket->freeList = *(void **) newObject;
+        }
+
+        UnlockBucket(bucket);
+
         if (newObject == NULL)
         {
             ptr = hdr->freeSpace;
@@ -632,7 +1625,9 @@ void *fmAlloc(fm_uint size)
                                        size - sizeof(fm_objectHeader));
 #endif
 
-                objHdr->myBucket = bucket;
+                objHdr->bucketOffset = (fm_uint32)
+                                       ( (unsigned char *) bucket -
+                                         (unsigned char *) FM_SHARED_MEMORY_ADDR );
 
                 hdr->freeSpace = ptr + size;
 
@@ -646,8 +1641,6 @@ void *fmAlloc(fm_uint size)
                                    size - sizeof(fm_objectHeader));
 #endif
 
-            bucket->freeList = *(void **) newObject;
-
             ptr = newObject;
 
             objHdr = (fm_objectHeader *) ( ptr - sizeof(fm_objectHeader) );
@@ -658,6 +1651,8 @@ void *fmAlloc(fm_uint size)
 
         if (newObject)
         {
+            AccountAlloc(hdr, newObject, tag, size);
+
             /* set info only when newObject allocated succesfully */
 #if MEMORY_DEBUG_CALLER
 #if DBG_FULL_CALLER_DEPTH
@@ -668,22 +1663,24 @@ void *fmAlloc(fm_uint size)
 #endif  /* DBG_TRACK_MAX_BUCKET != 0 */
                 objHdr->callerDepth = backtrace(objHdr->callerArray,
                                                 DBG_CALLER_DEPTH);
-                objHdr->caller = objHdr->callerArray[1];
+                objHdr->caller =
+                    objHdr->callerArray[(tag == FM_ALLOC_TAG_UNTAGGED) ? 2 : 1];
 #if DBG_TRACK_MAX_BUCKET != 0
             }
             else
             {
-                /* first function in backtrace is fmAlloc itself, so we need
-                 * the second function */
-                objHdr->callerDepth = backtrace(objHdr->callerArray, 2);
-                objHdr->caller      = objHdr->callerArray[1];
+                /* first function in backtrace is fmAllocTagged itself,
+                 * followed by fmAlloc for untagged memory */
+                objHdr->callerDepth = backtrace(objHdr->callerArray, 3);
+                objHdr->caller      =
+                    objHdr->callerArray[(tag == FM_ALLOC_TAG_UNTAGGED) ? 2 : 1];
             }
 #endif  /* DBG_TRACK_MAX_BUCKET != 0 */
 #else
-            /* first function in backtrace is fmAlloc itself, so we need the
-             * second function */
-            backtrace(btBuffer, 2);
-            objHdr->caller = btBuffer[1];
+            /* first function in backtrace is fmAllocTagged itself,
+             * followed by fmAlloc for untagged memory */
+            backtrace(btBuffer, 3);
+            objHdr->caller = btBuffer[(tag == FM_ALLOC_TAG_UNTAGGED) ? 2 : 1];
 #endif  /* DBG_FULL_CALLER_DEPTH */
 #endif  /* MEMORY_DEBUG_CALLER */
 
@@ -691,7 +1688,9 @@ void *fmAlloc(fm_uint size)
             VALGRIND_MAKE_MEM_NOACCESS(objHdr, sizeof(fm_objectHeader));
 #endif
 
-            bucket->allocationRemainderBitmask |= 1 << (size - unroundedSize);
+            /* Also updated by CacheAlloc without the mutex */
+            FM_ATOMIC_OR(&bucket->allocationRemainderBitmask,
+                         1 << (size - unroundedSize));
         }
     }
 
@@ -707,7 +1706,7 @@ void *fmAlloc(fm_uint size)
 
     return newObject;
 
-}   /* end fmAlloc */
+}   /* end fmAllocTagged */
 
 
 
@@ -729,6 +1728,7 @@ void fmFree(void *obj)
     fm_objectHeader *objHdr;
     fm_sharedHeader *hdr = (fm_sharedHeader *) FM_SHARED_MEMORY_ADDR;
     unsigned char *  ptr;
+    fm_bool          valid;
 
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "object=%p\n", obj);
 
@@ -749,8 +1749,6 @@ void fmFree(void *obj)
     }
     else
     {
-        LockMutex(hdr);
-
         ptr = obj;
         ptr -= sizeof(fm_objectHeader);
 
@@ -759,19 +1757,36 @@ void fmFree(void *obj)
         VALGRIND_MAKE_MEM_DEFINED(objHdr, sizeof(fm_objectHeader));
 #endif
 
-        bucket = objHdr->myBucket;
+        bucket = OBJ_BUCKET(objHdr);
 #ifdef FM_HAVE_VALGRIND
         VALGRIND_MAKE_MEM_DEFINED(bucket, sizeof(fm_memoryBucket));
 #endif
 
-        if (!IN_SHARED_MEMORY(bucket) || bucket->signature != BUCKET_SIGNATURE)
+        valid = IN_SHARED_MEMORY(bucket) &&
+                (bucket->signature == BUCKET_SIGNATURE);
+
+        if (valid)
+        {
+            /* Before the object can be reused by another thread */
+            AccountFree(hdr, objHdr, bucket->size);
+        }
+
+        if (!valid)
         {
             MemoryCorruptionWarning();
         }
+#if USE_ALLOC_CACHE
+        else if ( CacheFree(bucket, obj) )
+        {
+            /* Kept in the calling thread's cache */
+        }
+#endif
         else
         {
+            LockBucket(bucket);
             *(void **) obj   = bucket->freeList;
             bucket->freeList = obj;
+            UnlockBucket(bucket);
 #if MEMORY_DEBUG_CALLER
             objHdr->caller = NULL;
 #if DBG_FULL_CALLER_DEPTH
@@ -785,8 +1800,6 @@ void fmFree(void *obj)
         VALGRIND_MAKE_MEM_NOACCESS(bucket, sizeof(fm_memoryBucket));
         VALGRIND_MAKE_MEM_NOACCESS(objHdr, sizeof(fm_objectHeader));
 #endif
-
-        UnlockMutex(hdr);
     }
 
 #ifdef FM_HAVE_VALGRIND
@@ -834,6 +1847,8 @@ void fmDbgDumpAllocStats(void)
     fm_uint          bucketSpace;
     fm_rootInfo *    rootInfo;
     FILE *           f;
+    fm_uint64        cacheHits;
+    fm_uint64        cacheMisses;
 
 #ifdef FM_HAVE_VALGRIND
     fm_memoryBucket *it;
@@ -890,18 +1905,22 @@ void fmDbgDumpAllocStats(void)
         size     = bucket->size - sizeof(fm_objectHeader);
         unused   = 0;
         total    = 0;
-        freeList = bucket->freeList;
 
         /**************************************************
          * Count the amount of free space on this bucket's freelist
          **************************************************/
-        while (freeList != NULL)
+        LockBucket(bucket);
+
+        for (freeList = bucket->freeList ;
+             freeList != NULL ;
+             freeList = *(void **) freeList)
         {
             unused++;
-            freeList = *(void **) freeList;
-            freed   += size;
+            freed += size;
         }
 
+        UnlockBucket(bucket);
+
         /**************************************************
          * Walk through all the object headers, and count the
          * amount of space that points to this bucket (whether
@@ -919,7 +1938,7 @@ void fmDbgDumpAllocStats(void)
             VALGRIND_MAKE_MEM_DEFINED(objHdr, sizeof(fm_objectHeader));
 #endif
 
-            if (objHdr->myBucket == bucket)
+            if (OBJ_BUCKET(objHdr) == bucket)
             {
                 total++;
                 overhead += sizeof(fm_objectHeader);
@@ -980,7 +1999,7 @@ void fmDbgDumpAllocStats(void)
 #endif
             }
 
-            ptr += objHdr->myBucket->size;
+            ptr += OBJ_BUCKET(objHdr)->size;
 
 #ifdef FM_HAVE_VALGRIND
             VALGRIND_MAKE_MEM_NOACCESS(objHdr, sizeof(fm_objectHeader));
@@ -1080,6 +2099,29 @@ void fmDbgDumpAllocStats(void)
     FM_LOG_PRINT("Never allocated: %u bytes\n", FM_SHARED_MEMORY_SIZE - managed);
     FM_LOG_PRINT("\n");
 
+    /**************************************************
+     * Objects held in the threads' caches are counted
+     * as used above. Hits and misses are accumulated
+     * by each thread at its cache misses.
+     **************************************************/
+    cacheHits   = FM_ATOMIC_LOAD(&hdr->cacheHits);
+    cacheMisses = FM_ATOMIC_LOAD(&hdr->cacheMisses);
+
+    FM_LOG_PRINT("Thread cache (objects up to %u bytes): %s\n",
+                 (fm_uint) (ALLOC_CACHE_MAX_SIZE - sizeof(fm_objectHeader)),
+                 USE_ALLOC_CACHE ? "enabled" : "disabled");
+    FM_LOG_PRINT("Thread cache hits: %" FM_FORMAT_64 "u, misses: %"
+                 FM_FORMAT_64 "u, hit rate: %u%%\n",
+                 cacheHits,
+                 cacheMisses,
+                 (cacheHits + cacheMisses) ?
+                     (fm_uint) ( (cacheHits * 100) / (cacheHits + cacheMisses) ) :
+                     0);
+    FM_LOG_PRINT("\n");
+
+    DumpTlbStats(hdr);
+    FM_LOG_PRINT("\n");
+
     buf     = requested;
     bufSize = sizeof(requested);
     *buf    = 0;
@@ -1189,7 +2231,7 @@ void fmDbgDumpAllocCallStacks(fm_uint bufSize)
             VALGRIND_MAKE_MEM_DEFINED(objHdr, sizeof(fm_objectHeader));
 #endif
 
-            if (objHdr->myBucket == bucket)
+            if (OBJ_BUCKET(objHdr) == bucket)
             {
                 if (objHdr->callerDepth > 0)
                 {
@@ -1202,7 +2244,7 @@ void fmDbgDumpAllocCallStacks(fm_uint bufSize)
                 bufNum++;
             }
 
-            ptr += objHdr->myBucket->size;
+            ptr += OBJ_BUCKET(objHdr)->size;
 
 #ifdef FM_HAVE_VALGRIND
             VALGRIND_MAKE_MEM_NOACCESS(objHdr, sizeof(fm_objectHeader));
@@ -1292,17 +2334,21 @@ void fmGetAllocatedMemorySize(fm_uint32 *allocMemory)
     while (bucket != NULL)
     {
         size     = bucket->size - sizeof(fm_objectHeader);
-        freeList = bucket->freeList;
 
         /**************************************************
          * Count the amount of free space on this bucket's freelist
          **************************************************/
-        while (freeList != NULL)
+        LockBucket(bucket);
+
+        for (freeList = bucket->freeList ;
+             freeList != NULL ;
+             freeList = *(void **) freeList)
         {
-            freeList = *(void **) freeList;
-            freed   += size;
+            freed += size;
         }
 
+        UnlockBucket(bucket);
+
         /**************************************************
          * Walk through all the object headers, and count the
          * amount of space that points to this bucket (whether
@@ -1317,12 +2363,12 @@ void fmGetAllocatedMemorySize(fm_uint32 *allocMemory)
             VALGRIND_MAKE_MEM_DEFINED(objHdr, sizeof(fm_objectHeader));
 #endif
 
-            if (objHdr->myBucket == bucket)
+            if (OBJ_BUCKET(objHdr) == bucket)
             {
                 overhead += sizeof(fm_objectHeader);
             }
 
-            ptr += objHdr->myBucket->size;
+            ptr += OBJ_BUCKET(objHdr)->size;
 
 #ifdef FM_HAVE_VALGRIND
             VALGRIND_MAKE_MEM_NOACCESS(objHdr, sizeof(fm_objectHeader));
@@ -1352,6 +2398,159 @@ void fmGetAllocatedMemorySize(fm_uint32 *allocMemory)
 
 
 
+/*****************************************************************************/
+/** fmGetSharedMemoryFootprint
+ * \ingroup intAlos
+ *
+ * \desc            Returns the number of bytes of the shared memory segment
+ *                  that have been put to use by the allocator. Freed objects
+ *                  go back to their bucket, so this only grows. Unlike
+ *                  fmGetAllocatedMemorySize, it does not walk the heap and
+ *                  is cheap enough to call around each step of the
+ *                  initialization.
+ *
+ * \param[out]      footprint points to caller allocated storage where
+ *                  the number of bytes is written.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmGetSharedMemoryFootprint(fm_uint64 *footprint)
+{
+    fm_sharedHeader *hdr = (fm_sharedHeader *) FM_SHARED_MEMORY_ADDR;
+
+    *footprint = (fm_uint64)
+                 ( (unsigned char *) hdr->freeSpace -
+                   (unsigned char *) FM_SHARED_MEMORY_ADDR );
+
+}   /* end fmGetSharedMemoryFootprint */
+
+
+
+
+/*****************************************************************************/
+/** fmGetAllocTagStats
+ * \ingroup alosAlloc
+ *
+ * \desc            Returns the memory statistics of a subsystem, counting
+ *                  the memory it allocated with ''fmAllocTagged''. The
+ *                  statistics are kept in all builds and are shared by all
+ *                  processes using the API.
+ *
+ * \param[in]       category is the log category of the subsystem, a single
+ *                  FM_LOG_CAT_XXX bit, or FM_LOG_CAT_NONE for the memory
+ *                  allocated with ''fmAlloc''.
+ *
+ * \param[out]      stats points to caller-allocated storage where the
+ *                  statistics are written.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if stats is NULL.
+ *
+ *****************************************************************************/
+fm_status fmGetAllocTagStats(fm_uint64 category, fm_allocTagStats *stats)
+{
+    fm_sharedHeader * hdr = (fm_sharedHeader *) FM_SHARED_MEMORY_ADDR;
+    fm_allocTagStats *tagStats;
+
+    if (stats == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    tagStats = &hdr->tagStats[TagIndex(category)];
+
+    stats->liveBytes = FM_ATOMIC_LOAD_RELAXED(&tagStats->liveBytes);
+    stats->peakBytes = FM_ATOMIC_LOAD_RELAXED(&tagStats->peakBytes);
+    stats->allocs    = FM_ATOMIC_LOAD_RELAXED(&tagStats->allocs);
+    stats->frees     = FM_ATOMIC_LOAD_RELAXED(&tagStats->frees);
+
+    return FM_OK;
+
+}   /* end fmGetAllocTagStats */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgDumpAllocTagStats
+ * \ingroup diagMisc
+ *
+ * \desc            Displays the memory statistics of each allocation tag
+ *                  that was ever used. The rate is the number of
+ *                  allocations per second since the previous call made by
+ *                  this process.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmDbgDumpAllocTagStats(void)
+{
+    static fm_uint64    prevAllocs[FM_ALLOC_NUM_TAGS];
+    static fm_timestamp prevTime;
+    fm_allocTagStats    stats;
+    fm_timestamp        now;
+    fm_timestamp        diff;
+    fm_uint64           usec;
+    fm_uint64           rate;
+    fm_uint             tag;
+
+    fmGetTime(&now);
+    fmSubTimestamps(&now, &prevTime, &diff);
+    usec = (diff.sec * 1000000) + diff.usec;
+
+    FM_LOG_PRINT("%-20s %12s %12s %12s %12s %12s\n",
+                 "Category", "Live (KB)", "Peak (KB)",
+                 "Allocs", "Frees", "Allocs/s");
+
+    for (tag = 0 ; tag < FM_ALLOC_NUM_TAGS ; tag++)
+    {
+        fmGetAllocTagStats( (tag == FM_ALLOC_TAG_UNTAGGED)
+                            ? FM_LOG_CAT_NONE
+                            : (FM_LITERAL_U64(1) << tag),
+                            &stats );
+
+        if (stats.allocs == 0)
+        {
+            continue;
+        }
+
+        rate = 0;
+
+        if (prevTime.sec != 0 && usec > 0)
+        {
+            rate = ( (stats.allocs - prevAllocs[tag]) * 1000000 ) / usec;
+        }
+
+        prevAllocs[tag] = stats.allocs;
+
+        if (tag == FM_ALLOC_TAG_UNTAGGED)
+        {
+            FM_LOG_PRINT("%-20s ", "untagged");
+        }
+        else
+        {
+            FM_LOG_PRINT("0x%016llx   ",
+                         (unsigned long long) (FM_LITERAL_U64(1) << tag));
+        }
+
+        FM_LOG_PRINT("%12llu %12llu %12llu %12llu %12llu\n",
+                     (unsigned long long) (stats.liveBytes / 1024),
+                     (unsigned long long) (stats.peakBytes / 1024),
+                     (unsigned long long) stats.allocs,
+                     (unsigned long long) stats.frees,
+                     (unsigned long long) rate);
+    }
+
+    prevTime = now;
+
+}   /* end fmDbgDumpAllocTagStats */
+
+
+
+
 /*****************************************************************************/
 /** fmGetRoot
  * \ingroup alosAlloc
@@ -1445,6 +2644,58 @@ fm_status fmGetRoot(const char *          rootName,
 
 
 
+/*****************************************************************************/
+/** fmFindRoot
+ * \ingroup alosAlloc
+ *
+ * \desc            Looks up a root that was created by ''fmGetRoot''.
+ *                  Unlike ''fmGetRoot'', the root is never created, so this
+ *                  can be used by processes which must not alter the
+ *                  shared state.
+ *
+ * \param[in]       rootName is the unique string identifying the root.
+ *
+ * \param[out]      rootPtr is a pointer to the per-process global
+ *                  pointer where this root is cached.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if the root has not been created.
+ * \return          the error returned by the function that created the
+ *                  root, if it failed.
+ *
+ *****************************************************************************/
+fm_status fmFindRoot(const char *rootName, void **rootPtr)
+{
+    fm_sharedHeader *hdr = (fm_sharedHeader *) FM_SHARED_MEMORY_ADDR;
+    fm_rootInfo *    rootInfo;
+    fm_status        err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "root=%s ptr=%p\n",
+                 rootName, (void *) rootPtr);
+
+    err = FM_ERR_NOT_FOUND;
+
+    LockRootMutex(hdr);
+
+    for (rootInfo = hdr->roots ; rootInfo != NULL ; rootInfo = rootInfo->next)
+    {
+        if (strcmp(rootName, rootInfo->name) == 0)
+        {
+            *rootPtr = rootInfo->root;
+            err      = rootInfo->err;
+            break;
+        }
+    }
+
+    UnlockRootMutex(hdr);
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
+
+}   /* end fmFindRoot */
+
+
+
+
 /*****************************************************************************/
 /** fmGetAvailableSharedVirtualBaseAddress
  * \ingroup alosAlloc
@@ -1516,9 +2767,15 @@ fm_status fmMemInitialize(void)
     fm_uint             s1max;
     char                strErrBuf[FM_STRERROR_BUF_SIZE];
     errno_t             strErrNum;
+    fm_uint64           hugePageSize;
+    fm_uint64           pageSize;
+    fm_bool             hugeTlb = FALSE;
 
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "(no arguments)\n");
 
+    hugePageSize = GetRequestedHugePageSize();
+    pageSize     = (fm_uint64) sysconf(_SC_PAGESIZE);
+
     /***************************************************
      * Default flags used for creating/attaching the
      * shared memory region.
@@ -1642,7 +2899,18 @@ fm_status fmMemInitialize(void)
          **************************************************/
         if ( (shmId == -1) && (errno == ENOENT) )
         {
-            shmId = shmget(shmKey, FM_SHARED_MEMORY_SIZE, IPC_CREAT | IPC_EXCL | flags);
+            if (hugePageSize != 0)
+            {
+                shmId = CreateHugePageShm(shmKey, flags, &hugePageSize);
+                hugeTlb = (shmId != -1);
+            }
+
+            if (shmId == -1)
+            {
+                shmId = shmget(shmKey,
+                               FM_SHARED_MEMORY_SIZE,
+                               IPC_CREAT | IPC_EXCL | flags);
+            }
 
             if (shmId == -1)
             {
@@ -1748,13 +3016,31 @@ fm_status fmMemInitialize(void)
      **************************************************/
     else
     {
-        /* Map file into memory. */
-        addr = mmap( (void*) FM_SHARED_MEMORY_ADDR,
-                     FM_SHARED_MEMORY_SIZE,
-                     PROT_READ | PROT_WRITE,
-                     MAP_PRIVATE | MAP_ANONYMOUS,
-                     -1,
-                     0);
+        addr = MAP_FAILED;
+
+        if (hugePageSize != 0)
+        {
+            addr    = MapHugePages(&hugePageSize);
+            hugeTlb = (addr != MAP_FAILED);
+        }
+
+        if (addr == MAP_FAILED)
+        {
+            /* Map file into memory. */
+            addr = mmap( (void*) FM_SHARED_MEMORY_ADDR,
+                         FM_SHARED_MEMORY_SIZE,
+                         PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS,
+                         -1,
+                         0);
+
+            /* Let the kernel back the region with transparent huge
+             * pages instead where it can */
+            if ( (addr != MAP_FAILED) && (hugePageSize != 0) )
+            {
+                madvise(addr, FM_SHARED_MEMORY_SIZE, MADV_HUGEPAGE);
+            }
+        }
 
         if (addr == MAP_FAILED)
         {
@@ -1807,8 +3093,14 @@ fm_status fmMemInitialize(void)
         hdr->bucketBucket.size      = ROUND_UP( sizeof(fm_memoryBucket) +
                                                sizeof(fm_objectHeader) );
         hdr->bucketBucket.freeList = NULL;
+        hdr->bucketBucket.lock     = 0;
         hdr->bucketBucket.next     = NULL;
         hdr->buckets               = &(hdr->bucketBucket);
+        hdr->cacheHits             = 0;
+        hdr->cacheMisses           = 0;
+        hdr->pageSize              = hugeTlb ? hugePageSize : pageSize;
+        hdr->hugeTlb               = hugeTlb;
+        FM_CLEAR(hdr->tagStats);
 
         offset = sizeof(fm_sharedHeader);
 
@@ -1955,40 +3247,113 @@ okay2:
         /**************************************************
          * Check sanity check information
          **************************************************/
-        if ( hdr->versionIdentifier != VersionIdentifier() )
+        if ( CheckSharedHeader(hdr, addr) != FM_OK )
         {
-            FM_LOG_FATAL(FM_LOG_CAT_ALOS,
-                         "Version signature mismatch in shared memory\n");
             FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_FAIL);
         }
+    }
 
-        if (hdr->self != addr)
-        {
-            FM_LOG_FATAL(FM_LOG_CAT_ALOS,
-                         "Start address mismatch in shared memory\n");
-            FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_FAIL);
-        }
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
 
-        if ( hdr->end != (void *) ((fm_uintptr)FM_SHARED_MEMORY_ADDR +
-                                   (fm_uintptr)FM_SHARED_MEMORY_SIZE) )
-        {
-            FM_LOG_FATAL(FM_LOG_CAT_ALOS,
-                         "End address mismatch in shared memory\n");
-            FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_FAIL);
-        }
+}   /* end fmMemInitialize */
+
+
+
+
+/*****************************************************************************/
+/** fmMemAttach
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Maps the API shared memory region of a running
+ *                  application, for a monitoring process. Unlike
+ *                  ''fmMemInitialize'', the region is never created,
+ *                  recreated or initialized, and the call fails instead of
+ *                  waiting when the region is not ready.
+ *
+ * \param           None.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the FM_API_SHM_KEY environment
+ *                  variable does not name a shared memory region.
+ * \return          FM_ERR_NOT_FOUND if the region does not exist or has
+ *                  not been initialized yet.
+ * \return          FM_FAIL if the region cannot be mapped or was created by
+ *                  a different build of the API.
+ *
+ *****************************************************************************/
+fm_status fmMemAttach(void)
+{
+    void *           addr;
+    fm_sharedHeader *hdr;
+    fm_text          shmKeyStr;
+    fm_text          shmKeyParseErr = NULL;
+    fm_int           shmKey;
+    fm_int           shmId;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "(no arguments)\n");
 
-        if (hdr->funcInSharedLibrary != MemoryCorruptionWarning)
+    /***************************************************
+     * Only the SysV region can be shared; the anonymous
+     * mapping is private to the process that made it.
+     * A ",restart" suffix is ignored: a monitor never
+     * recreates the region.
+     **************************************************/
+    shmKeyStr = getenv("FM_API_SHM_KEY");
+
+    if (shmKeyStr == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_UNSUPPORTED);
+    }
+
+    errno  = 0;
+    shmKey = (fm_int) strtol(shmKeyStr, &shmKeyParseErr, 10);
+
+    if ( (errno != 0) || (shmKeyParseErr == shmKeyStr) )
+    {
+        FM_LOG_FATAL(FM_LOG_CAT_ALOS,
+                     "Unable to convert key value %s\n",
+                     shmKeyStr);
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_UNSUPPORTED);
+    }
+
+    shmId = shmget(shmKey, FM_SHARED_MEMORY_SIZE, 0);
+
+    if (shmId == -1)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_NOT_FOUND);
+    }
+
+    addr = shmat(shmId, (void *) FM_SHARED_MEMORY_ADDR, 0);
+
+    if ( addr != ((void *) FM_SHARED_MEMORY_ADDR) )
+    {
+        if ( addr != ((void *) -1) )
         {
-            FM_LOG_FATAL(FM_LOG_CAT_ALOS,
-                         "Shared library seems to be loaded at a "
-                         "different address\n");
-            FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_FAIL);
+            shmdt(addr);
         }
+
+        FM_LOG_FATAL(FM_LOG_CAT_ALOS,
+                     "Unable to attach shared memory at requested address\n");
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_FAIL);
+    }
+
+    hdr = (fm_sharedHeader *) addr;
+
+    if (!hdr->initialized)
+    {
+        shmdt(addr);
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_NOT_FOUND);
+    }
+
+    if ( CheckSharedHeader(hdr, addr) != FM_OK )
+    {
+        shmdt(addr);
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_FAIL);
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
 
-}   /* end fmMemInitialize */
+}   /* end fmMemAttach */
 
 
 
@@ -0,0 +1,340 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_alos_arena.c
+ * Creation Date:   October 14, 2026
+ * Description:     Arena allocator. Memory is carved sequentially out of
+ *                  large chunks and released all at once, which suits the
+ *                  many short-lived objects built by a single operation
+ *                  such as an ACL compilation.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* Alignment of each allocation */
+#define ARENA_ALIGNMENT         8
+
+#define ARENA_ROUND_UP(size)    \
+    ( ( (size) + ARENA_ALIGNMENT - 1 ) & ~(ARENA_ALIGNMENT - 1) )
+
+/* Requests larger than this fraction of the chunk size get a chunk of
+ * their own, so that they do not waste the rest of the current chunk. */
+#define ARENA_LARGE_FRACTION    4
+
+/* A chunk of arena memory, followed by its data */
+typedef struct _fm_arenaChunk
+{
+    /* Next chunk, in most recently allocated first order */
+    struct _fm_arenaChunk *next;
+
+    /* Number of data bytes in this chunk */
+    fm_uint                size;
+
+    /* Number of data bytes handed out from this chunk */
+    fm_uint                used;
+
+} fm_arenaChunk;
+
+#define ARENA_CHUNK_HDR_SIZE    ARENA_ROUND_UP( sizeof(fm_arenaChunk) )
+
+#define ARENA_CHUNK_DATA(chunk) \
+    ( ( (fm_byte *) (chunk) ) + ARENA_CHUNK_HDR_SIZE )
+
+struct _fm_arena
+{
+    /* Chunks allocated so far. Allocations are carved from the first one,
+     * except for large ones, which are put behind it. */
+    fm_arenaChunk *chunks;
+
+    /* Data size of regular chunks */
+    fm_uint        chunkSize;
+
+};
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local function prototypes.
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** NewChunk
+ * \ingroup intAlosArena
+ *
+ * \desc            Allocate an empty arena chunk.
+ *
+ * \param[in]       size is the number of data bytes in the chunk.
+ *
+ * \return          Pointer to the chunk, or NULL if out of memory.
+ *
+ *****************************************************************************/
+static fm_arenaChunk *NewChunk(fm_uint size)
+{
+    fm_arenaChunk *chunk;
+
+    chunk = fmAlloc(ARENA_CHUNK_HDR_SIZE + size);
+
+    if (chunk != NULL)
+    {
+        chunk->next = NULL;
+        chunk->size = size;
+        chunk->used = 0;
+    }
+
+    return chunk;
+
+}   /* end NewChunk */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** fmCreateArena
+ * \ingroup intAlosArena
+ *
+ * \desc            Create an empty arena. Arena memory is allocated from
+ *                  the shared memory with fmAlloc.
+ *
+ * \param[in]       chunkSize is the number of bytes to allocate from the
+ *                  shared memory at a time, or 0 for
+ *                  FM_ARENA_DEFAULT_CHUNK_SIZE.
+ *
+ * \param[out]      arena points to caller-allocated storage where this
+ *                  function will place a pointer to the new arena.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if arena is NULL.
+ * \return          FM_ERR_NO_MEM if out of memory.
+ *
+ *****************************************************************************/
+fm_status fmCreateArena(fm_uint chunkSize, fm_arena **arena)
+{
+    fm_arena *newArena;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS,
+                 "chunkSize=%u arena=%p\n",
+                 chunkSize,
+                 (void *) arena);
+
+    if (arena == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    newArena = fmAlloc( sizeof(fm_arena) );
+
+    if (newArena == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_NO_MEM);
+    }
+
+    newArena->chunks    = NULL;
+    newArena->chunkSize = ARENA_ROUND_UP( (chunkSize == 0) ?
+                                          FM_ARENA_DEFAULT_CHUNK_SIZE :
+                                          chunkSize );
+
+    *arena = newArena;
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
+
+}   /* end fmCreateArena */
+
+
+
+
+/*****************************************************************************/
+/** fmArenaAlloc
+ * \ingroup intAlosArena
+ *
+ * \desc            Allocate memory from an arena. The memory is 8-byte
+ *                  aligned and stays valid until the arena is reset or
+ *                  destroyed; it must not be passed to fmFree.
+ *
+ * \param[in]       arena points to the arena.
+ *
+ * \param[in]       size is the number of bytes to allocate.
+ *
+ * \return          Pointer to the memory, or NULL if out of memory.
+ *
+ *****************************************************************************/
+void *fmArenaAlloc(fm_arena *arena, fm_uint size)
+{
+    fm_arenaChunk *chunk;
+    void *         ptr;
+
+    size  = ARENA_ROUND_UP(size);
+    chunk = arena->chunks;
+
+    if ( (chunk != NULL) && (chunk->size - chunk->used >= size) )
+    {
+        ptr          = ARENA_CHUNK_DATA(chunk) + chunk->used;
+        chunk->used += size;
+
+        return ptr;
+    }
+
+    if (size > arena->chunkSize / ARENA_LARGE_FRACTION)
+    {
+        /* Give the request a chunk of its own */
+        chunk = NewChunk(size);
+
+        if (chunk == NULL)
+        {
+            return NULL;
+        }
+
+        chunk->used = size;
+
+        if (arena->chunks != NULL)
+        {
+            chunk->next         = arena->chunks->next;
+            arena->chunks->next = chunk;
+        }
+        else
+        {
+            arena->chunks = chunk;
+        }
+
+        return ARENA_CHUNK_DATA(chunk);
+    }
+
+    chunk = NewChunk(arena->chunkSize);
+
+    if (chunk == NULL)
+    {
+        return NULL;
+    }
+
+    chunk->next   = arena->chunks;
+    chunk->used   = size;
+    arena->chunks = chunk;
+
+    return ARENA_CHUNK_DATA(chunk);
+
+}   /* end fmArenaAlloc */
+
+
+
+
+/*****************************************************************************/
+/** fmResetArena
+ * \ingroup intAlosArena
+ *
+ * \desc            Release all the memory allocated from an arena. One
+ *                  regular chunk is kept for reuse by subsequent
+ *                  allocations.
+ *
+ * \param[in]       arena points to the arena.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmResetArena(fm_arena *arena)
+{
+    fm_arenaChunk *chunk;
+    fm_arenaChunk *next;
+    fm_arenaChunk *keep;
+
+    keep = NULL;
+
+    for (chunk = arena->chunks ; chunk != NULL ; chunk = next)
+    {
+        next = chunk->next;
+
+        if ( (keep == NULL) && (chunk->size == arena->chunkSize) )
+        {
+            keep       = chunk;
+            keep->next = NULL;
+            keep->used = 0;
+        }
+        else
+        {
+            fmFree(chunk);
+        }
+    }
+
+    arena->chunks = keep;
+
+}   /* end fmResetArena */
+
+
+
+
+/*****************************************************************************/
+/** fmDestroyArena
+ * \ingroup intAlosArena
+ *
+ * \desc            Release all the memory allocated from an arena and the
+ *                  arena itself.
+ *
+ * \param[in]       arena points to the arena, may be NULL.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmDestroyArena(fm_arena *arena)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    fmResetArena(arena);
+
+    if (arena->chunks != NULL)
+    {
+        fmFree(arena->chunks);
+    }
+
+    fmFree(arena);
+
+}   /* end fmDestroyArena */
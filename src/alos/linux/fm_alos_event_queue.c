@@ -57,6 +57,370 @@
  * Local Functions
  *****************************************************************************/
 
+/*****************************************************************************/
+/** GetHistBucket
+ * \ingroup intAlosEvent
+ *
+ * \desc            Returns the log2 histogram bucket of a value.
+ *
+ * \param[in]       value is the queue depth or dwell time.
+ *
+ * \return          The bucket index.
+ *
+ *****************************************************************************/
+static inline fm_int GetHistBucket(fm_uint64 value)
+{
+    fm_int bucket;
+
+    if (value == 0)
+    {
+        return 0;
+    }
+
+    bucket = 64 - __builtin_clzll(value);
+
+    if (bucket >= FM_EVENT_QUEUE_HIST_BUCKETS)
+    {
+        bucket = FM_EVENT_QUEUE_HIST_BUCKETS - 1;
+    }
+
+    return bucket;
+
+}   /* end GetHistBucket */
+
+
+
+
+/*****************************************************************************/
+/** RecordDepth
+ * \ingroup intAlosEvent
+ *
+ * \desc            Counts the depth of a queue an event was just added to.
+ *
+ * \param[in]       q is the pointer to the event queue
+ *
+ * \param[in]       size is the number of events in the queue.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static inline void RecordDepth(fm_eventQueue *q, fm_int size)
+{
+    FM_ATOMIC_ADD_RELAXED(&q->depthHist[GetHistBucket(size)], 1);
+
+}   /* end RecordDepth */
+
+
+
+
+/*****************************************************************************/
+/** RecordDwell
+ * \ingroup intAlosEvent
+ *
+ * \desc            Counts the time an event just taken out of a queue
+ *                  spent in it.
+ *
+ * \param[in]       q is the pointer to the event queue
+ *
+ * \param[in]       ev is the event.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static inline void RecordDwell(fm_eventQueue *q, fm_event *ev)
+{
+    fm_uint64 usec;
+    fm_int    typeIndex;
+
+    if (ev->type == 0)
+    {
+        /* Free queues hold events that have no type yet */
+        return;
+    }
+
+    typeIndex = __builtin_ctz( (fm_uint) ev->type );
+    usec      = fmCyclesToNsec(FM_GET_CYCLES() - ev->postedCycles) / 1000;
+
+    FM_ATOMIC_ADD_RELAXED(&q->dwellHist[typeIndex][GetHistBucket(usec)], 1);
+
+}   /* end RecordDwell */
+
+
+
+
+/*****************************************************************************/
+/** RingAdd
+ * \ingroup intAlosEvent
+ *
+ * \desc            Enqueues an event in a ring event queue.
+ *
+ * \param[in]       q is the pointer to the event queue
+ *
+ * \param[in]       event is the pointer to the event to be added to the queue
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_EVENT_QUEUE_FULL if the queue holds its maximum
+ *                  number of events, or every slot of the ring is still
+ *                  occupied by events or tombstones.
+ *
+ *****************************************************************************/
+static fm_status RingAdd(fm_eventQueue *q, fm_event *event)
+{
+    fm_eventQueueSlot *slot;
+    fm_uint64          pos;
+    fm_int64           dif;
+    fm_int             size;
+    fm_int             maxSize;
+
+    /* Claim a place within the maximum number of events */
+    size = FM_ATOMIC_LOAD(&q->size);
+
+    do
+    {
+        if (size >= q->max)
+        {
+            FM_ATOMIC_ADD_RELAXED(&q->fullDrops, 1);
+            return FM_ERR_EVENT_QUEUE_FULL;
+        }
+    }
+    while ( !FM_ATOMIC_CAS(&q->size, &size, size + 1) );
+
+    event->postedCycles = FM_GET_CYCLES();
+
+#ifdef ENABLE_EVENTQ_TIMESTAMP
+    /* Don't enable by default, slow down packet delivery */
+    if (fmGetTime(&event->postedTimestamp) != 0)
+    {
+        FM_ATOMIC_SUB(&q->size, 1);
+        return FM_ERR_BAD_GETTIME;
+    }
+#endif
+
+    /* Claim the slot at the enqueue position */
+    pos = FM_ATOMIC_LOAD(&q->enqueuePos);
+
+    for ( ; ; )
+    {
+        slot = &q->ring[pos & q->ringMask];
+        dif  = (fm_int64) ( FM_ATOMIC_LOAD(&slot->seq) - pos );
+
+        if (dif == 0)
+        {
+            if ( FM_ATOMIC_CAS(&q->enqueuePos, &pos, pos + 1) )
+            {
+                break;
+            }
+        }
+        else if (dif < 0)
+        {
+            /* The slot has not been consumed yet */
+            FM_ATOMIC_SUB(&q->size, 1);
+            FM_ATOMIC_ADD_RELAXED(&q->fullDrops, 1);
+            return FM_ERR_EVENT_QUEUE_FULL;
+        }
+        else
+        {
+            pos = FM_ATOMIC_LOAD(&q->enqueuePos);
+        }
+    }
+
+    /* Fill the slot, then hand it over to the consumers */
+    event->queuePos = pos;
+    event->node     = NULL;
+    FM_ATOMIC_STORE(&slot->event, event);
+    event->q        = q;
+    FM_ATOMIC_STORE(&slot->seq, pos + 1);
+
+    FM_ATOMIC_ADD(&q->totalEventsPosted, 1);
+    RecordDepth(q, size + 1);
+
+    maxSize = FM_ATOMIC_LOAD(&q->maxSize);
+
+    while ( (size + 1 > maxSize) &&
+            !FM_ATOMIC_CAS(&q->maxSize, &maxSize, size + 1) )
+    {
+        /* maxSize was reloaded by the failed exchange */
+    }
+
+    return FM_OK;
+
+}   /* end RingAdd */
+
+
+
+
+/*****************************************************************************/
+/** RingGet
+ * \ingroup intAlosEvent
+ *
+ * \desc            Dequeues the next event of a ring event queue, skipping
+ *                  the tombstones left by fmEventQueueRemove.
+ *
+ * \param[in]       q is the pointer to the event queue
+ *
+ * \param[out]      eventPtr is a pointer to storage for the event pointer
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_EVENTS_AVAILABLE if the queue is empty.
+ *
+ *****************************************************************************/
+static fm_status RingGet(fm_eventQueue *q, fm_event **eventPtr)
+{
+    fm_eventQueueSlot *slot;
+    fm_event *         ev;
+    fm_uint64          pos;
+    fm_int64           dif;
+
+    ev  = NULL;
+    pos = FM_ATOMIC_LOAD(&q->dequeuePos);
+
+    while (ev == NULL)
+    {
+        slot = &q->ring[pos & q->ringMask];
+        dif  = (fm_int64) ( FM_ATOMIC_LOAD(&slot->seq) - (pos + 1) );
+
+        if (dif == 0)
+        {
+            if ( FM_ATOMIC_CAS(&q->dequeuePos, &pos, pos + 1) )
+            {
+                /* Take the event, racing with fmEventQueueRemove, then
+                 * free the slot for the producer one lap ahead. */
+                ev = FM_ATOMIC_EXCHANGE(&slot->event, NULL);
+                FM_ATOMIC_STORE(&slot->seq, pos + q->ringMask + 1);
+                pos++;
+            }
+        }
+        else if (dif < 0)
+        {
+            *eventPtr = NULL;
+
+            return FM_ERR_NO_EVENTS_AVAILABLE;
+        }
+        else
+        {
+            pos = FM_ATOMIC_LOAD(&q->dequeuePos);
+        }
+    }
+
+    FM_ATOMIC_SUB(&q->size, 1);
+
+#ifdef ENABLE_EVENTQ_TIMESTAMP
+    fmGetTime(&ev->poppedTimestamp);
+#endif
+    fmDbgEventQueueEventPopped(q, ev);
+    RecordDwell(q, ev);
+
+    ev->q    = NULL;
+    ev->node = NULL;
+
+    *eventPtr = ev;
+
+    return FM_OK;
+
+}   /* end RingGet */
+
+
+
+
+/*****************************************************************************/
+/** RingPeek
+ * \ingroup intAlosEvent
+ *
+ * \desc            Returns the oldest event of a ring event queue without
+ *                  dequeuing it. With concurrent consumers, the event may
+ *                  be dequeued by another thread at any time.
+ *
+ * \param[in]       q is the pointer to the event queue
+ *
+ * \param[out]      eventPtr is a pointer to storage for the event pointer
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_EVENTS_AVAILABLE if the queue is empty.
+ *
+ *****************************************************************************/
+static fm_status RingPeek(fm_eventQueue *q, fm_event **eventPtr)
+{
+    fm_eventQueueSlot *slot;
+    fm_event *         ev;
+    fm_uint64          pos;
+    fm_uint64          endPos;
+
+    endPos = FM_ATOMIC_LOAD(&q->enqueuePos);
+
+    for (pos = FM_ATOMIC_LOAD(&q->dequeuePos) ; pos < endPos ; pos++)
+    {
+        slot = &q->ring[pos & q->ringMask];
+
+        if (FM_ATOMIC_LOAD(&slot->seq) != pos + 1)
+        {
+            /* Not published yet, or already dequeued */
+            break;
+        }
+
+        ev = FM_ATOMIC_LOAD(&slot->event);
+
+        if (ev != NULL)
+        {
+            *eventPtr = ev;
+            return FM_OK;
+        }
+    }
+
+    *eventPtr = NULL;
+
+    return FM_ERR_NO_EVENTS_AVAILABLE;
+
+}   /* end RingPeek */
+
+
+
+
+/*****************************************************************************/
+/** RingRemove
+ * \ingroup intAlosEvent
+ *
+ * \desc            Takes an event out of a ring event queue by leaving a
+ *                  tombstone in its slot, which the consumers skip.
+ *
+ * \param[in]       q is the pointer to the event queue
+ *
+ * \param[in]       eventPtr is the pointer to event to be removed.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MORE if the event is not in this queue.
+ * \return          FM_ERR_NO_EVENTS_AVAILABLE if the event was dequeued
+ *                  concurrently.
+ *
+ *****************************************************************************/
+static fm_status RingRemove(fm_eventQueue *q, fm_event *eventPtr)
+{
+    fm_eventQueueSlot *slot;
+    fm_event *         expected;
+
+    if (eventPtr->q != q)
+    {
+        return FM_ERR_NO_MORE;
+    }
+
+    slot     = &q->ring[eventPtr->queuePos & q->ringMask];
+    expected = eventPtr;
+
+    if ( !FM_ATOMIC_CAS(&slot->event, &expected, NULL) )
+    {
+        return FM_ERR_NO_EVENTS_AVAILABLE;
+    }
+
+    FM_ATOMIC_SUB(&q->size, 1);
+
+    eventPtr->q = NULL;
+
+    return FM_OK;
+
+}   /* end RingRemove */
+
+
+
+
 
 /*****************************************************************************
  * Public Functions
@@ -81,13 +445,50 @@
  *
  *****************************************************************************/
 fm_status fmEventQueueInitialize(fm_eventQueue *q, int maxSize, fm_text qName)
+{
+    return fmEventQueueInitializeV2(q, maxSize, qName, 0);
+
+}   /* end fmEventQueueInitialize */
+
+
+
+
+/*****************************************************************************/
+/** fmEventQueueInitializeV2
+ * \ingroup intAlosEvent
+ *
+ * \desc            (non-blocking) initializes the queue, as a list guarded
+ *                  by a lock or as a lock-free ring.
+ *
+ * \note            should be only done once
+ *
+ * \param[in]       q is the pointer to the event queue to initialize
+ *
+ * \param[in]       maxSize is the maximum number of events in the queue
+ *
+ * \param[in]       qName is the name of the queue, for debugging purposes
+ *
+ * \param[in]       flags is a bit mask of FM_EVENT_QUEUE_FLAG_XXX values.
+ *                  With FM_EVENT_QUEUE_FLAG_RING, the slots for maxSize
+ *                  events are allocated up front and adding or getting an
+ *                  event neither allocates memory nor takes a lock.
+ *
+ * \return          Status code
+ *
+ *****************************************************************************/
+fm_status fmEventQueueInitializeV2(fm_eventQueue *q,
+                                   int            maxSize,
+                                   fm_text        qName,
+                                   fm_uint        flags)
 {
     fm_status err;
     fm_bool   lockInit;
+    fm_uint64 numSlots;
+    fm_uint64 i;
 
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS,
-                 "queue=%p maxSize=%d name=%s\n",
-                 (void *) q, maxSize, qName);
+                 "queue=%p maxSize=%d name=%s flags=0x%x\n",
+                 (void *) q, maxSize, qName, flags);
 
     if (q == NULL)
     {
@@ -97,12 +498,49 @@ fm_status fmEventQueueInitialize(fm_eventQueue *q, int maxSize, fm_text qName)
     FM_CLEAR(*q);
 
     lockInit = FALSE;
+    err      = FM_OK;
+
+    /* In list mode, recycle up to maxSize nodes so that steady-state
+     * posting does not take the shared-memory allocator lock. */
+    fmDListInitPooled(&q->eventQueue,
+                      (flags & FM_EVENT_QUEUE_FLAG_RING) ? 0 : maxSize);
+
+    if (flags & FM_EVENT_QUEUE_FLAG_RING)
+    {
+        if (maxSize <= 0)
+        {
+            FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_INVALID_ARGUMENT);
+        }
+
+        for (numSlots = 2 ; numSlots < (fm_uint64) maxSize ; numSlots <<= 1)
+        {
+            /* round up to a power of two */
+        }
 
-    fmDListInit(&q->eventQueue);
+        q->ring = (fm_eventQueueSlot *) fmAlloc(numSlots *
+                                                sizeof(fm_eventQueueSlot));
 
-    err = fmCreateLock(qName, &q->accessLock);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ALOS, err);
-    lockInit = TRUE;
+        if (q->ring == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            goto ABORT;
+        }
+
+        for (i = 0 ; i < numSlots ; i++)
+        {
+            q->ring[i].seq   = i;
+            q->ring[i].event = NULL;
+        }
+
+        q->ringMask = numSlots - 1;
+        q->isRing   = TRUE;
+    }
+    else
+    {
+        err = fmCreateLock(qName, &q->accessLock);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ALOS, err);
+        lockInit = TRUE;
+    }
 
     q->max  = maxSize;
     q->name = fmStringDuplicate(qName);
@@ -125,6 +563,11 @@ ABORT:
         fmFree(q->name);
     }
 
+    if (q->ring)
+    {
+        fmFree(q->ring);
+    }
+
     if (lockInit)
     {
         fmDeleteLock(&q->accessLock);
@@ -134,7 +577,7 @@ ABORT:
 
     FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
 
-}   /* end fmEventQueueInitialize */
+}   /* end fmEventQueueInitializeV2 */
 
 
 
@@ -160,8 +603,15 @@ fm_status fmEventQueueAdd(fm_eventQueue *q, fm_event *event)
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "queue=%p event=%p\n",
                  (void *) q, (void *) event);
 
+    if (q->isRing)
+    {
+        err = RingAdd(q, event);
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
+    }
+
     if (q->size == q->max)
     {
+        FM_ATOMIC_ADD_RELAXED(&q->fullDrops, 1);
         FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_EVENT_QUEUE_FULL);
     }
 
@@ -171,6 +621,8 @@ fm_status fmEventQueueAdd(fm_eventQueue *q, fm_event *event)
         FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
     }
 
+    event->postedCycles = FM_GET_CYCLES();
+
 #ifdef ENABLE_EVENTQ_TIMESTAMP
     /* Don't enable by default, slow down packet delivery */
     if (fmGetTime(&event->postedTimestamp) != 0)
@@ -187,6 +639,7 @@ fm_status fmEventQueueAdd(fm_eventQueue *q, fm_event *event)
             q->totalEventsPosted++;
             q->size++;
             q->maxSize = q->size > q->maxSize ? q->size : q->maxSize; 
+            RecordDepth(q, q->size);
 
             event->q = q;
             event->node = eventNode; 
@@ -235,6 +688,18 @@ fm_status fmEventQueueGet(fm_eventQueue *q, fm_event **eventPtr)
         FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_INVALID_ARGUMENT);
     }
 
+    if (q->isRing)
+    {
+        err = RingGet(q, eventPtr);
+
+        if (err == FM_ERR_NO_EVENTS_AVAILABLE)
+        {
+            fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_NO_EVENTS_AVAILABLE, 1);
+        }
+
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
+    }
+
     /* Timeout not implememented, so we block forever if we deadlock */
     if ( ( err = fmCaptureLock(&q->accessLock, FM_WAIT_FOREVER) ) != FM_OK )
     {
@@ -252,9 +717,8 @@ fm_status fmEventQueueGet(fm_eventQueue *q, fm_event **eventPtr)
 
         *eventPtr = ev;
         q->size--;
-#ifdef ENABLE_EVENTQ_TIMESTAMP
         fmDbgEventQueueEventPopped(q, ev);
-#endif
+        RecordDwell(q, ev);
 
         ev->q    = NULL;
         ev->node = NULL;
@@ -294,6 +758,209 @@ fm_status fmEventQueueGet(fm_eventQueue *q, fm_event **eventPtr)
 
 
 
+/*****************************************************************************/
+/** fmEventQueueAddMultiple
+ * \ingroup intAlosEvent
+ *
+ * \desc            (blocking) enqueue a batch of events, taking the queue
+ *                  lock once.
+ *
+ * \param[in]       q is the pointer to the event queue
+ *
+ * \param[in]       numEvents is the number of events in events.
+ *
+ * \param[in]       events points to an array of numEvents event pointers.
+ *
+ * \param[out]      numAdded points to caller-allocated storage where the
+ *                  number of events added, from the start of the array, is
+ *                  written.
+ *
+ * \return          FM_OK if every event was added.
+ * \return          FM_ERR_EVENT_QUEUE_FULL if the queue filled up first.
+ * \return          Other status code if an event could not be added.
+ *
+ *****************************************************************************/
+fm_status fmEventQueueAddMultiple(fm_eventQueue *q,
+                                  fm_int         numEvents,
+                                  fm_event **    events,
+                                  fm_int *       numAdded)
+{
+    fm_status      err, rerr = FM_OK;
+    fm_dlist_node *eventNode; 
+    fm_event *     event;
+    fm_int         i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "queue=%p numEvents=%d events=%p\n",
+                 (void *) q, numEvents, (void *) events);
+
+    i = 0;
+
+    if (q->isRing)
+    {
+        while ( (i < numEvents) && (rerr == FM_OK) )
+        {
+            rerr = RingAdd(q, events[i]);
+
+            if (rerr == FM_OK)
+            {
+                i++;
+            }
+        }
+
+        *numAdded = i;
+
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, rerr);
+    }
+
+    /* Timeout not implememented, so we block forever if we deadlock */
+    if ( ( err = fmCaptureLock(&q->accessLock, FM_WAIT_FOREVER) ) != FM_OK )
+    {
+        *numAdded = 0;
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
+    }
+
+    while ( (i < numEvents) && (rerr == FM_OK) )
+    {
+        event = events[i];
+
+        if (q->size == q->max)
+        {
+            FM_ATOMIC_ADD_RELAXED(&q->fullDrops, 1);
+            rerr = FM_ERR_EVENT_QUEUE_FULL;
+            break;
+        }
+
+        event->postedCycles = FM_GET_CYCLES();
+
+#ifdef ENABLE_EVENTQ_TIMESTAMP
+        /* Don't enable by default, slow down packet delivery */
+        if (fmGetTime(&event->postedTimestamp) != 0)
+        {
+            rerr = FM_ERR_BAD_GETTIME;
+            break;
+        }
+#endif
+
+        rerr = fmDListInsertEndV2(&q->eventQueue, event, &eventNode);
+
+        if (rerr == FM_OK)
+        {
+            q->totalEventsPosted++;
+            q->size++;
+            q->maxSize = q->size > q->maxSize ? q->size : q->maxSize; 
+            RecordDepth(q, q->size);
+
+            event->q    = q;
+            event->node = eventNode; 
+            i++;
+        }
+    }
+
+    *numAdded = i;
+
+    if ( ( err = fmReleaseLock(&q->accessLock) ) != FM_OK )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS, rerr);
+
+}   /* end fmEventQueueAddMultiple */
+
+
+
+
+/*****************************************************************************/
+/** fmEventQueueGetMultiple
+ * \ingroup intAlosEvent
+ *
+ * \desc            (blocking) get up to a number of events, taking the queue
+ *                  lock once.
+ *
+ * \param[in]       q is the pointer to the event queue
+ *
+ * \param[in]       maxEvents is the maximum number of events to get.
+ *
+ * \param[out]      events points to a caller-allocated array of maxEvents
+ *                  entries where the event pointers are written.
+ *
+ * \param[out]      numEvents points to caller-allocated storage where the
+ *                  number of events written to events is stored.
+ *
+ * \return          FM_OK if at least one event was returned.
+ * \return          FM_ERR_NO_EVENTS_AVAILABLE if the queue is empty.
+ *
+ *****************************************************************************/
+fm_status fmEventQueueGetMultiple(fm_eventQueue *q,
+                                  fm_int         maxEvents,
+                                  fm_event **    events,
+                                  fm_int *       numEvents)
+{
+    fm_status err;
+    fm_event *ev;
+    fm_int    i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "queue=%p maxEvents=%d events=%p\n",
+                 (void *) q, maxEvents, (void *) events);
+
+    i = 0;
+
+    if (q->isRing)
+    {
+        while ( (i < maxEvents) && (RingGet(q, &events[i]) == FM_OK) )
+        {
+            i++;
+        }
+    }
+    else
+    {
+        /* Timeout not implememented, so we block forever if we deadlock */
+        if ( ( err = fmCaptureLock(&q->accessLock, FM_WAIT_FOREVER) ) != FM_OK )
+        {
+            *numEvents = 0;
+            FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
+        }
+
+        while (i < maxEvents)
+        {
+            ev = (fm_event *) fmDListRemove(&q->eventQueue, q->eventQueue.head);
+
+            if (ev == NULL)
+            {
+                break;
+            }
+
+#ifdef ENABLE_EVENTQ_TIMESTAMP
+            fmGetTime(&ev->poppedTimestamp);
+#endif
+            fmDbgEventQueueEventPopped(q, ev);
+            RecordDwell(q, ev);
+
+            q->size--;
+
+            ev->q    = NULL;
+            ev->node = NULL;
+
+            events[i++] = ev;
+        }
+
+        if ( ( err = fmReleaseLock(&q->accessLock) ) != FM_OK )
+        {
+            *numEvents = i;
+            FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
+        }
+    }
+
+    *numEvents = i;
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS,
+                (i > 0) ? FM_OK : FM_ERR_NO_EVENTS_AVAILABLE);
+
+}   /* end fmEventQueueGetMultiple */
+
+
+
+
 /*****************************************************************************/
 /** fmEventQueuePeek
  * \ingroup intAlosEvent
@@ -320,6 +987,12 @@ fm_status fmEventQueuePeek(fm_eventQueue *q, fm_event **eventPtr)
         FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_INVALID_ARGUMENT);
     }
 
+    if (q->isRing)
+    {
+        err = RingPeek(q, eventPtr);
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
+    }
+
     /* Timeout not implememented, so we block forever if we deadlock */
     if ( ( err = fmCaptureLock(&q->accessLock, FM_WAIT_FOREVER) ) != FM_OK )
     {
@@ -375,7 +1048,12 @@ fm_status fmEventQueueDestroy(fm_eventQueue *q)
     /* Notify debug system first */
     fmDbgEventQueueDestroyed(q);
 
-    if ( ( err = fmDeleteLock(&q->accessLock) ) != FM_OK )
+    if (q->isRing)
+    {
+        fmFree(q->ring);
+        q->ring = NULL;
+    }
+    else if ( ( err = fmDeleteLock(&q->accessLock) ) != FM_OK )
     {
         FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
     }
@@ -411,7 +1089,7 @@ fm_status fmEventQueueCount(fm_eventQueue *q, fm_int *eventCount)
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "queue=%p count=%p\n",
                  (void *) q, (void *) eventCount);
 
-    *eventCount = q->size;
+    *eventCount = FM_ATOMIC_LOAD(&q->size);
 
     FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
 
@@ -420,6 +1098,87 @@ fm_status fmEventQueueCount(fm_eventQueue *q, fm_int *eventCount)
 
 
 
+/*****************************************************************************/
+/** fmEventQueueGetStats
+ * \ingroup intAlosEvent
+ *
+ * \desc            (non-blocking) takes a snapshot of the queue telemetry.
+ *                  Counters updated concurrently may be slightly out of
+ *                  step with each other.
+ *
+ * \param[in]       q is the pointer to the event queue
+ *
+ * \param[out]      stats points to caller-allocated storage where the
+ *                  telemetry is written. The low priority allocation
+ *                  counters, which are not per queue, are left unchanged.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmEventQueueGetStats(fm_eventQueue *q, fm_eventQueueStats *stats)
+{
+    fm_int type;
+    fm_int bucket;
+
+    stats->size      = FM_ATOMIC_LOAD_RELAXED(&q->size);
+    stats->maxSize   = FM_ATOMIC_LOAD_RELAXED(&q->maxSize);
+    stats->max       = q->max;
+    stats->posted    = FM_ATOMIC_LOAD_RELAXED(&q->totalEventsPosted);
+    stats->popped    = FM_ATOMIC_LOAD_RELAXED(&q->totalEventsPopped);
+    stats->fullDrops = FM_ATOMIC_LOAD_RELAXED(&q->fullDrops);
+
+    for (bucket = 0 ; bucket < FM_EVENT_QUEUE_HIST_BUCKETS ; bucket++)
+    {
+        stats->depthHist[bucket] =
+            FM_ATOMIC_LOAD_RELAXED(&q->depthHist[bucket]);
+
+        for (type = 0 ; type < FM_EVENT_QUEUE_EVENT_TYPES ; type++)
+        {
+            stats->dwellHist[type][bucket] =
+                FM_ATOMIC_LOAD_RELAXED(&q->dwellHist[type][bucket]);
+        }
+    }
+
+}   /* end fmEventQueueGetStats */
+
+
+
+
+/*****************************************************************************/
+/** fmEventQueueResetStats
+ * \ingroup intAlosEvent
+ *
+ * \desc            (non-blocking) clears the queue drop counter and
+ *                  histograms. Events in flight while the counters are
+ *                  cleared may or may not be counted.
+ *
+ * \param[in]       q is the pointer to the event queue
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmEventQueueResetStats(fm_eventQueue *q)
+{
+    fm_int type;
+    fm_int bucket;
+
+    FM_ATOMIC_STORE_RELAXED(&q->fullDrops, 0);
+
+    for (bucket = 0 ; bucket < FM_EVENT_QUEUE_HIST_BUCKETS ; bucket++)
+    {
+        FM_ATOMIC_STORE_RELAXED(&q->depthHist[bucket], 0);
+
+        for (type = 0 ; type < FM_EVENT_QUEUE_EVENT_TYPES ; type++)
+        {
+            FM_ATOMIC_STORE_RELAXED(&q->dwellHist[type][bucket], 0);
+        }
+    }
+
+}   /* end fmEventQueueResetStats */
+
+
+
+
 /*****************************************************************************/
 /** fmEventQueueRemove
  * \ingroup intAlosEvent
@@ -448,6 +1207,12 @@ fm_status fmEventQueueRemove(fm_eventQueue *q,
         FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_INVALID_ARGUMENT);
     }
 
+    if (q->isRing)
+    {
+        err = RingRemove(q, eventPtr);
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
+    }
+
 
     if ( ( err = fmCaptureLock(&q->accessLock, FM_WAIT_FOREVER) ) != FM_OK )
     {
@@ -483,3 +1248,111 @@ ABORT:
     FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
 
 }   /* end fmEventQueueRemove */
+
+
+
+
+/*****************************************************************************/
+/** fmCreateEventNotifier
+ * \ingroup intAlosEvent
+ *
+ * \desc            Creates a file descriptor that becomes readable when
+ *                  signalled by ''fmSignalEventNotifier'', so that waiting
+ *                  for the API can be integrated with poll/epoll loops.
+ *                  Reading 8 bytes from it clears it.
+ *                                                                      \lb\lb
+ *                  File descriptors are process-local: the notifier must
+ *                  be signalled from the process that created it.
+ *
+ * \param[out]      fd points to caller-allocated storage where this
+ *                  function places the file descriptor.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if fd is NULL.
+ * \return          FM_FAIL if the file descriptor could not be created.
+ *
+ *****************************************************************************/
+fm_status fmCreateEventNotifier(fm_int *fd)
+{
+    int newFd;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "fd=%p\n", (void *) fd);
+
+    if (fd == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    newFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (newFd < 0)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ALOS, "eventfd failed with errno %d\n", errno);
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_FAIL);
+    }
+
+    *fd = newFd;
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
+
+}   /* end fmCreateEventNotifier */
+
+
+
+
+/*****************************************************************************/
+/** fmSignalEventNotifier
+ * \ingroup intAlosEvent
+ *
+ * \desc            Makes a file descriptor created by
+ *                  ''fmCreateEventNotifier'' readable.
+ *
+ * \param[in]       fd is the file descriptor.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if the file descriptor could not be written.
+ *
+ *****************************************************************************/
+fm_status fmSignalEventNotifier(fm_int fd)
+{
+    eventfd_t value = 1;
+
+    /* Called on hot paths, so no entry/exit logging */
+    if (write(fd, &value, sizeof(value)) != sizeof(value))
+    {
+        /* Only fails with EAGAIN when the counter saturates, if valid */
+        return (errno == EAGAIN) ? FM_OK : FM_FAIL;
+    }
+
+    return FM_OK;
+
+}   /* end fmSignalEventNotifier */
+
+
+
+
+/*****************************************************************************/
+/** fmDestroyEventNotifier
+ * \ingroup intAlosEvent
+ *
+ * \desc            Closes a file descriptor created by
+ *                  ''fmCreateEventNotifier''.
+ *
+ * \param[in]       fd is the file descriptor.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if the file descriptor could not be closed.
+ *
+ *****************************************************************************/
+fm_status fmDestroyEventNotifier(fm_int fd)
+{
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "fd=%d\n", fd);
+
+    if (close(fd) != 0)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_FAIL);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
+
+}   /* end fmDestroyEventNotifier */
@@ -205,6 +205,52 @@ fm_status fmOSInitialize()
 }   /* end fmOSInitialize */
 
 
+/*****************************************************************************/
+/** fmOSAttach
+ * \ingroup alosInit
+ *
+ * \desc            Attach the calling process to the operating system
+ *                  abstraction state of a running application without
+ *                  creating or initializing any shared state. Used instead
+ *                  of ''fmOSInitialize'' by monitoring processes.
+ *
+ * \param           None.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if no application has initialized the
+ *                  shared state.
+ * \return          Other ''Status Codes'' as returned by ''fmMemAttach''.
+ *
+ *****************************************************************************/
+fm_status fmOSAttach(void)
+{
+    fm_status      err;
+    static fm_bool attachedAlready = FALSE;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "(no arguments)\n");
+
+    if (attachedAlready)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
+    }
+
+    err = fmMemAttach();
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ALOS, err);
+
+    /* Only initializes per-process thread bookkeeping. */
+    err = fmAlosThreadInit();
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ALOS, err);
+
+    err = fmFindRoot("alos", (void **) &fmRootAlos);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ALOS, err);
+
+    attachedAlready = TRUE;
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
+
+}   /* end fmOSAttach */
+
+
 /*****************************************************************************/
 /** fmInitProcess
  * \ingroup alosInit
@@ -51,6 +51,14 @@
 #define VALIDATE_LOCK_PRECEDENCE(err, lck, take)    \
                     err = FM_OK;
 #endif
+
+/* Fast path lock word: zero when the lock is free, otherwise the kernel
+ * thread ID of the owner, plus FAST_LOCK_WAITERS once a thread has had
+ * to sleep on it. */
+#define FAST_LOCK_WAITERS                       0x80000000U
+#define FAST_LOCK_OWNER_MASK                    (~FAST_LOCK_WAITERS)
+
+#define FAST_LOCK_WORD(lck)                     ( (fm_uint32 *) (lck)->handle )
     
 
 /*****************************************************************************
@@ -62,6 +70,11 @@
  * Local Variables
  *****************************************************************************/
 
+/* Kernel thread ID of the calling thread, used as fast path lock owner. */
+static __thread fm_uint32 fastLockTid = 0;
+
+static pthread_once_t fastLockOnce = PTHREAD_ONCE_INIT;
+
 /*****************************************************************************
  * Local function prototypes.
  *****************************************************************************/
@@ -71,6 +84,260 @@
  * Local Functions
  *****************************************************************************/
 
+/*****************************************************************************/
+/** ResetFastLockTid
+ * \ingroup intAlosLock
+ *
+ * \desc            Fork handler that forgets the cached kernel thread ID in
+ *                  the child process, whose only thread has a new ID.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ResetFastLockTid(void)
+{
+
+    fastLockTid = 0;
+
+}   /* end ResetFastLockTid */
+
+
+
+
+/*****************************************************************************/
+/** RegisterFastLockForkHandler
+ * \ingroup intAlosLock
+ *
+ * \desc            Registers ''ResetFastLockTid'' once per process.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void RegisterFastLockForkHandler(void)
+{
+
+    if ( pthread_atfork(NULL, NULL, ResetFastLockTid) != 0 )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ALOS_LOCK,
+                     "Unable to register fast lock fork handler\n");
+    }
+
+}   /* end RegisterFastLockForkHandler */
+
+
+
+
+/*****************************************************************************/
+/** GetFastLockTid
+ * \ingroup intAlosLock
+ *
+ * \desc            Returns the value the calling thread stores in a fast
+ *                  path lock word when it owns the lock.
+ *
+ * \param           None.
+ *
+ * \return          The kernel thread ID of the calling thread.
+ *
+ *****************************************************************************/
+static inline fm_uint32 GetFastLockTid(void)
+{
+
+    if (fastLockTid == 0)
+    {
+        pthread_once(&fastLockOnce, RegisterFastLockForkHandler);
+        fastLockTid = ( (fm_uint32) syscall(SYS_gettid) ) & FAST_LOCK_OWNER_MASK;
+    }
+
+    return fastLockTid;
+
+}   /* end GetFastLockTid */
+
+
+
+
+/*****************************************************************************/
+/** CaptureFastLock
+ * \ingroup intAlosLock
+ *
+ * \desc            Takes a fast path lock. The uncontended case is a single
+ *                  compare-and-swap of the lock word. A contended thread
+ *                  marks the word as having waiters and sleeps on it with
+ *                  FUTEX_WAIT. The futex is not process private since the
+ *                  lock word lives in shared memory.
+ *
+ * \param[in]       lck points to the lock state.
+ *
+ * \param[in]       timeout is the maximum amount of time to wait, or
+ *                  FM_WAIT_FOREVER.
+ *
+ * \param[out]      waitStart points to caller-allocated storage into which
+ *                  the time at which the lock was found taken is written,
+ *                  if the lock is being profiled.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_LOCK_TIMEOUT if the timeout expired.
+ * \return          FM_ERR_UNABLE_TO_LOCK if the futex wait failed.
+ *
+ *****************************************************************************/
+static fm_status CaptureFastLock(fm_lock *     lck,
+                                 fm_timestamp *timeout,
+                                 fm_uint64 *   waitStart)
+{
+    fm_uint32 *     word;
+    fm_uint32       tid;
+    fm_uint32       cur;
+    fm_uint32       expected;
+    struct timespec deadline;
+    long            rc;
+
+    word = FAST_LOCK_WORD(lck);
+    tid  = GetFastLockTid();
+    cur  = FM_ATOMIC_LOAD(word);
+
+    if ( (cur & FAST_LOCK_OWNER_MASK) == tid )
+    {
+        /* Nested capture by the owner. */
+        return FM_OK;
+    }
+
+    expected = 0;
+
+    if ( FM_ATOMIC_CAS(word, &expected, tid) )
+    {
+        return FM_OK;
+    }
+
+#if FM_LOCK_PROFILING
+    if ( FM_LOCK_PROF_ACTIVE(lck->profile) )
+    {
+        *waitStart = FM_LOCK_PROF_TSC();
+    }
+#else
+    FM_NOT_USED(waitStart);
+#endif
+
+    if (timeout != FM_WAIT_FOREVER)
+    {
+        /* FUTEX_WAIT_BITSET takes an absolute CLOCK_MONOTONIC deadline,
+         * which stays fixed across wakeups that lose the race. */
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec  += timeout->sec;
+        deadline.tv_nsec += timeout->usec * 1000;
+
+        while (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    for ( ; ; )
+    {
+        cur = FM_ATOMIC_LOAD(word);
+
+        if (cur == 0)
+        {
+            /**************************************************
+             * Take the lock with the waiters flag set: we
+             * cannot tell whether other threads are still
+             * sleeping, so the release must wake one.
+             **************************************************/
+
+            expected = 0;
+
+            if ( FM_ATOMIC_CAS(word, &expected, tid | FAST_LOCK_WAITERS) )
+            {
+                return FM_OK;
+            }
+
+            continue;
+        }
+
+        if ( (cur & FAST_LOCK_WAITERS) == 0 )
+        {
+            expected = cur;
+
+            if ( !FM_ATOMIC_CAS(word, &expected, cur | FAST_LOCK_WAITERS) )
+            {
+                continue;
+            }
+
+            cur |= FAST_LOCK_WAITERS;
+        }
+
+        rc = syscall(SYS_futex,
+                     word,
+                     FUTEX_WAIT_BITSET,
+                     cur,
+                     (timeout == FM_WAIT_FOREVER) ? NULL : &deadline,
+                     NULL,
+                     FUTEX_BITSET_MATCH_ANY);
+
+        if ( (rc != 0) && (errno != EAGAIN) && (errno != EINTR) )
+        {
+            if (errno == ETIMEDOUT)
+            {
+                return FM_ERR_LOCK_TIMEOUT;
+            }
+
+            FM_LOG_ERROR(FM_LOG_CAT_ALOS_LOCK,
+                         "futex wait failed on lock %s - %d\n",
+                         lck->name,
+                         errno);
+            return FM_ERR_UNABLE_TO_LOCK;
+        }
+    }
+
+}   /* end CaptureFastLock */
+
+
+
+
+/*****************************************************************************/
+/** ReleaseFastLock
+ * \ingroup intAlosLock
+ *
+ * \desc            Releases a fast path lock held by the calling thread,
+ *                  waking one sleeping thread if any.
+ *
+ * \param[in]       lck points to the lock state.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNABLE_TO_UNLOCK if the calling thread does not
+ *                  own the lock.
+ *
+ *****************************************************************************/
+static fm_status ReleaseFastLock(fm_lock *lck)
+{
+    fm_uint32 *word;
+    fm_uint32  prev;
+
+    word = FAST_LOCK_WORD(lck);
+
+    if ( (FM_ATOMIC_LOAD(word) & FAST_LOCK_OWNER_MASK) != GetFastLockTid() )
+    {
+        return FM_ERR_UNABLE_TO_UNLOCK;
+    }
+
+    prev = FM_ATOMIC_EXCHANGE(word, 0);
+
+    if (prev & FAST_LOCK_WAITERS)
+    {
+        syscall(SYS_futex, word, FUTEX_WAKE, 1, NULL, NULL, 0);
+    }
+
+    return FM_OK;
+
+}   /* end ReleaseFastLock */
+
+
+
+
+
 #if FM_LOCK_INVERSION_DEFENSE 
 /*****************************************************************************/
 /** ValidateLockPrecedence
@@ -239,170 +506,25 @@ static fm_status ValidateLockPrecedence(fm_lock *lck, fm_bool take)
 #endif  /* FM_LOCK_INVERSION_DEFENSE */
 
 
-/*****************************************************************************
- * Public Functions
- *****************************************************************************/
-
-/* This is a private function which should only be called from fmAlosRootInit */
-fm_status fmAlosLockInit(void)
-{
-    pthread_mutexattr_t attr;
-    int                 pterr;
-
-    FM_LOG_ENTRY(FM_LOG_CAT_ALOS_LOCK, "(no arguments)\n");
-
-    if (fmRootAlos == NULL)
-    {
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_UNINITIALIZED);
-    }
-
-    fmRootAlos->LockLock.handle =
-        (pthread_mutex_t *) fmAlloc( sizeof(pthread_mutex_t) );
-
-    if (fmRootAlos->LockLock.handle == NULL)
-    {
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_NO_MEM);
-    }
-
-    if ( pthread_mutexattr_init(&attr) )
-    {
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_LOCK_INIT);
-    }
-    else if ( pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) )
-    {
-        pterr = pthread_mutexattr_destroy(&attr);
-        if (pterr != 0)
-        {
-            FM_LOG_FATAL(FM_LOG_CAT_ALOS,
-                         "Error %d destroying mutex attr\n",
-                         pterr);
-        }
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_LOCK_INIT);
-    }
-    else if ( pthread_mutex_init( (pthread_mutex_t *) fmRootAlos->LockLock.handle,
-                                  &attr ) )
-    {
-        pterr = pthread_mutexattr_destroy(&attr);
-        if (pterr != 0)
-        {
-            FM_LOG_FATAL(FM_LOG_CAT_ALOS,
-                         "Error %d destroying mutex attr\n",
-                         pterr);
-        }
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_LOCK_INIT);
-    }
-    else if ( pthread_mutexattr_destroy(&attr) )
-    {
-        pterr = pthread_mutex_destroy( (pthread_mutex_t *) fmRootAlos->LockLock.handle );
-        if (pterr != 0)
-        {
-            FM_LOG_FATAL(FM_LOG_CAT_ALOS,
-                         "Error %d destroying mutex attr\n",
-                         pterr);
-        }
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_LOCK_INIT);
-    }
-
-    fmRootAlos->LockLock.name = fmStringDuplicate("LockLock");
-
-    if (fmRootAlos->LockLock.name == NULL)
-    {
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_NO_MEM);
-    }
-
-    FM_CLEAR(fmRootAlos->LockList);
-    fmRootAlos->LockList[0] = &(fmRootAlos->LockLock);
-
-    FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_OK);
-
-}   /* end fmAlosLockInit */
-
-
-
-
 /*****************************************************************************/
-/** fmCreateLock
- * \ingroup alosLock
- *
- * \desc            Deprecated. Use ''fmCreateLockV2''.
- *                                                                      \lb\lb
- *                  Create a critical section lock (mutex). A lock provides 
- *                  mutually exclusive access to a resource by multiple threads.  
- *                  If a particular thread already has the lock and attempts to 
- *                  get it again, it will succeed. If another thread attempts 
- *                  to get the lock, it will be blocked until the first thread 
- *                  releases it.
+/** CreateLock
+ * \ingroup intAlosLock
  *
- * \note            Locks created with this function may be taken in any order
- *                  with respect to all other locks. That is, there is no
- *                  defence against lock inversion as there is with locks
- *                  created with ''fmCreateLockV2''.
+ * \desc            Common implementation of ''fmCreateLockV2'' and
+ *                  ''fmCreateCondLock''.
  *
  * \param[in]       lockName is an arbitrary text string used to identify the
  *                  lock for debugging purposes.
  *
- * \param[out]      lck points to a caller-allocated fm_lock object to be 
- *                  filled in by this function.
- *
- * \return          FM_OK if successful.
- * \return          FM_ERR_NO_MEM if memory allocation error.
- * \return          FM_ERR_UNINITIALIZED if ALOS not intialized.
- * \return          FM_ERR_INVALID_ARGUMENT if lck is NULL.
- * \return          FM_ERR_LOCK_INIT if unable to initialize lock.
- *
- *****************************************************************************/
-fm_status fmCreateLock(fm_text lockName, fm_lock *lck)
-{
-    fm_status err;
-    
-    FM_LOG_ENTRY(FM_LOG_CAT_ALOS_LOCK, 
-                 "lockName=%s lck=%p\n",
-                 lockName, 
-                 (void *) lck);
-
-    err = fmCreateLockV2(lockName, 
-                         FM_LOCK_SWITCH_NONE,
-                         FM_LOCK_SUPER_PRECEDENCE, 
-                         lck);
-    
-    FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, err);
-
-}   /* end fmCreateLock */
-
-
-/*****************************************************************************/
-/** fmCreateLockV2
- * \ingroup alosLock
- *
- * \desc            Create a critical section lock (mutex) with support for 
- *                  lock precedence. A lock provides mutually exclusive access 
- *                  to a resource by multiple threads.  If a particular thread 
- *                  already has the lock and attempts to get it again, it will 
- *                  succeed. If another thread attempts to get the lock, it 
- *                  will be blocked until the first thread releases it.
- *                                                                      \lb\lb
- *                  Each lock created is assigned a precedence value by the
- *                  caller, which constrains the order in which a thread may
- *                  capture the locks. The precedence mechanism is used to
- *                  defend against lock inversion between two different
- *                  threads, which could cause a deadlock. Precedence values 
- *                  are global across locks and reader-writer locks 
- *                  (see ''fmCreateRwLockV2'').
- *
- * \param[in]       lockName is an arbitrary text string used to identify the
- *                  lock for debugging purposes.
+ * \param[in]       sw identifies the switch with which this lock is
+ *                  associated, or FM_LOCK_SWITCH_NONE.
  *
- * \param[in]       sw identifies the switch with which this lock is associated.
- *                  This should be specified as FM_LOCK_SWITCH_NONE for locks 
- *                  that are not associated with any particular switch.
+ * \param[in]       precedence indicates this lock's precedence, or
+ *                  FM_LOCK_SUPER_PRECEDENCE.
  *
- * \param[in]       precedence indicates this lock's precedence with respect
- *                  to all other locks (and reader-writer locks) in the system.
- *                  May be specified as FM_LOCK_SUPER_PRECEDENCE to transcend
- *                  precedence (lock may be taken in any order with respect to
- *                  any other lock). Note that specifying this argument as
- *                  FM_LOCK_SUPER_PRECEDENCE is equivalent to calling 
- *                  ''fmCreateLock'' instead of this function.
+ * \param[in]       allowFastPath is TRUE if the lock may use the futex-based
+ *                  fast path when the api.lock.fastPath property is set,
+ *                  FALSE if it must be an operating system mutex.
  *
  * \param[out]      lck points to a caller-allocated fm_lock object to be 
  *                  filled in by this function.
@@ -414,10 +536,11 @@ fm_status fmCreateLock(fm_text lockName, fm_lock *lck)
  * \return          FM_ERR_LOCK_INIT if unable to initialize lock.
  *
  *****************************************************************************/
-fm_status fmCreateLockV2(fm_text  lockName, 
-                         fm_int   sw,
-                         fm_int   precedence,
-                         fm_lock *lck)
+static fm_status CreateLock(fm_text  lockName,
+                            fm_int   sw,
+                            fm_int   precedence,
+                            fm_bool  allowFastPath,
+                            fm_lock *lck)
 {
     pthread_mutexattr_t attr;
     int                 i;
@@ -426,12 +549,14 @@ fm_status fmCreateLockV2(fm_text  lockName,
     fm_bool             attrInit;
     fm_bool             mutexInit;
     fm_bool             listLocked;
+    fm_bool             fastPath;
 
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS_LOCK, 
-                 "lockName=%s sw=%d, precedence=%d lck=%p\n",
+                 "lockName=%s sw=%d, precedence=%d allowFastPath=%d lck=%p\n",
                  lockName, 
                  sw,
                  precedence,
+                 allowFastPath,
                  (void *) lck);
 
     if (fmRootAlos == NULL)
@@ -463,7 +588,17 @@ fm_status fmCreateLockV2(fm_text  lockName,
         goto ABORT;
     }
 
-    lck->handle     = (pthread_mutex_t *) fmAlloc( sizeof(pthread_mutex_t) );
+    fastPath = allowFastPath && GET_PROPERTY()->lockFastPath;
+
+    if (fastPath)
+    {
+        lck->handle = (fm_uint32 *) fmAlloc( sizeof(fm_uint32) );
+    }
+    else
+    {
+        lck->handle = (pthread_mutex_t *) fmAlloc( sizeof(pthread_mutex_t) );
+    }
+
     lck->name       = fmStringDuplicate(lockName);
     
     if (lck->name == NULL || lck->handle == NULL)
@@ -472,6 +607,18 @@ fm_status fmCreateLockV2(fm_text  lockName,
         goto ABORT;
     }
 
+    lck->fastPath = fastPath;
+
+#if FM_LOCK_PROFILING
+    lck->profile = fmAllocLockProfile();
+
+    if (lck->profile == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+#endif
+
     if (sw != FM_LOCK_SWITCH_NONE)
     {
         lck->switchNumber = sw;
@@ -501,15 +648,22 @@ fm_status fmCreateLockV2(fm_text  lockName,
         lck->precedence = 0;
     }
 
-    pterr = pthread_mutex_init( (pthread_mutex_t *) lck->handle, &attr );
-    if (pterr != 0)
+    if (fastPath)
     {
-        FM_LOG_FATAL(FM_LOG_CAT_ALOS, "Error %d initializing mutex\n", pterr);
-        err = FM_ERR_LOCK_INIT;
-        goto ABORT;
+        *FAST_LOCK_WORD(lck) = 0;
     }
+    else
+    {
+        pterr = pthread_mutex_init( (pthread_mutex_t *) lck->handle, &attr );
+        if (pterr != 0)
+        {
+            FM_LOG_FATAL(FM_LOG_CAT_ALOS, "Error %d initializing mutex\n", pterr);
+            err = FM_ERR_LOCK_INIT;
+            goto ABORT;
+        }
 
-    mutexInit = TRUE;
+        mutexInit = TRUE;
+    }
 
     if ( pthread_mutexattr_destroy(&attr) )
     {
@@ -520,9 +674,10 @@ fm_status fmCreateLockV2(fm_text  lockName,
     attrInit = FALSE;
 
     FM_LOG_DEBUG(FM_LOG_CAT_ALOS_LOCK,
-                 "Lock with handle %p created (%s)\n",
+                 "Lock with handle %p created (%s%s)\n",
                  (void *) lck->handle,
-                 lockName);
+                 lockName,
+                 fastPath ? ", fast path" : "");
 
     if ( pthread_mutex_lock( (pthread_mutex_t *) fmRootAlos->LockLock.handle ) )
     {
@@ -577,37 +732,242 @@ ABORT:
 
     if (mutexInit)
     {
-        pterr = pthread_mutex_destroy( (pthread_mutex_t *) lck->handle );
+        pterr = pthread_mutex_destroy( (pthread_mutex_t *) lck->handle );
+        if (pterr != 0)
+        {
+            FM_LOG_FATAL(FM_LOG_CAT_ALOS,
+                         "Error %d destroying mutex\n",
+                         pterr);
+        }
+    }
+
+    if (attrInit)
+    {
+        pterr = pthread_mutexattr_destroy(&attr);
+        if (pterr != 0)
+        {
+            FM_LOG_FATAL(FM_LOG_CAT_ALOS,
+                         "Error %d destroying mutex attr\n",
+                         pterr);
+        }
+    }
+
+    if (lck->name)
+    {
+        fmFree(lck->name);
+    }
+
+    if (lck->handle)
+    {
+        fmFree(lck->handle);
+    }
+
+    fmFreeLockProfile(lck->profile);
+
+    FM_CLEAR(*lck);
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, err);
+
+}   /* end CreateLock */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/* This is a private function which should only be called from fmAlosRootInit */
+fm_status fmAlosLockInit(void)
+{
+    pthread_mutexattr_t attr;
+    int                 pterr;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS_LOCK, "(no arguments)\n");
+
+    if (fmRootAlos == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_UNINITIALIZED);
+    }
+
+    fmRootAlos->LockLock.handle =
+        (pthread_mutex_t *) fmAlloc( sizeof(pthread_mutex_t) );
+
+    if (fmRootAlos->LockLock.handle == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_NO_MEM);
+    }
+
+    if ( pthread_mutexattr_init(&attr) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_LOCK_INIT);
+    }
+    else if ( pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) )
+    {
+        pterr = pthread_mutexattr_destroy(&attr);
+        if (pterr != 0)
+        {
+            FM_LOG_FATAL(FM_LOG_CAT_ALOS,
+                         "Error %d destroying mutex attr\n",
+                         pterr);
+        }
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_LOCK_INIT);
+    }
+    else if ( pthread_mutex_init( (pthread_mutex_t *) fmRootAlos->LockLock.handle,
+                                  &attr ) )
+    {
+        pterr = pthread_mutexattr_destroy(&attr);
         if (pterr != 0)
         {
             FM_LOG_FATAL(FM_LOG_CAT_ALOS,
-                         "Error %d destroying mutex\n",
+                         "Error %d destroying mutex attr\n",
                          pterr);
         }
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_LOCK_INIT);
     }
-
-    if (attrInit)
+    else if ( pthread_mutexattr_destroy(&attr) )
     {
-        pterr = pthread_mutexattr_destroy(&attr);
+        pterr = pthread_mutex_destroy( (pthread_mutex_t *) fmRootAlos->LockLock.handle );
         if (pterr != 0)
         {
             FM_LOG_FATAL(FM_LOG_CAT_ALOS,
                          "Error %d destroying mutex attr\n",
                          pterr);
         }
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_LOCK_INIT);
     }
 
-    if (lck->name)
-    {
-        fmFree(lck->name);
-    }
+    fmRootAlos->LockLock.name = fmStringDuplicate("LockLock");
 
-    if (lck->handle)
+    if (fmRootAlos->LockLock.name == NULL)
     {
-        fmFree(lck->handle);
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_NO_MEM);
     }
 
-    FM_CLEAR(*lck);
+    FM_CLEAR(fmRootAlos->LockList);
+    fmRootAlos->LockList[0] = &(fmRootAlos->LockLock);
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_OK);
+
+}   /* end fmAlosLockInit */
+
+
+
+
+/*****************************************************************************/
+/** fmCreateLock
+ * \ingroup alosLock
+ *
+ * \desc            Deprecated. Use ''fmCreateLockV2''.
+ *                                                                      \lb\lb
+ *                  Create a critical section lock (mutex). A lock provides 
+ *                  mutually exclusive access to a resource by multiple threads.  
+ *                  If a particular thread already has the lock and attempts to 
+ *                  get it again, it will succeed. If another thread attempts 
+ *                  to get the lock, it will be blocked until the first thread 
+ *                  releases it.
+ *
+ * \note            Locks created with this function may be taken in any order
+ *                  with respect to all other locks. That is, there is no
+ *                  defence against lock inversion as there is with locks
+ *                  created with ''fmCreateLockV2''.
+ *
+ * \param[in]       lockName is an arbitrary text string used to identify the
+ *                  lock for debugging purposes.
+ *
+ * \param[out]      lck points to a caller-allocated fm_lock object to be 
+ *                  filled in by this function.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory allocation error.
+ * \return          FM_ERR_UNINITIALIZED if ALOS not intialized.
+ * \return          FM_ERR_INVALID_ARGUMENT if lck is NULL.
+ * \return          FM_ERR_LOCK_INIT if unable to initialize lock.
+ *
+ *****************************************************************************/
+fm_status fmCreateLock(fm_text lockName, fm_lock *lck)
+{
+    fm_status err;
+    
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS_LOCK, 
+                 "lockName=%s lck=%p\n",
+                 lockName, 
+                 (void *) lck);
+
+    err = fmCreateLockV2(lockName, 
+                         FM_LOCK_SWITCH_NONE,
+                         FM_LOCK_SUPER_PRECEDENCE, 
+                         lck);
+    
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, err);
+
+}   /* end fmCreateLock */
+
+
+/*****************************************************************************/
+/** fmCreateLockV2
+ * \ingroup alosLock
+ *
+ * \desc            Create a critical section lock (mutex) with support for 
+ *                  lock precedence. A lock provides mutually exclusive access 
+ *                  to a resource by multiple threads.  If a particular thread 
+ *                  already has the lock and attempts to get it again, it will 
+ *                  succeed. If another thread attempts to get the lock, it 
+ *                  will be blocked until the first thread releases it.
+ *                                                                      \lb\lb
+ *                  Each lock created is assigned a precedence value by the
+ *                  caller, which constrains the order in which a thread may
+ *                  capture the locks. The precedence mechanism is used to
+ *                  defend against lock inversion between two different
+ *                  threads, which could cause a deadlock. Precedence values 
+ *                  are global across locks and reader-writer locks 
+ *                  (see ''fmCreateRwLockV2'').
+ *                                                                      \lb\lb
+ *                  If the api.lock.fastPath property is set when the lock
+ *                  is created, the lock is taken with an atomic operation
+ *                  when uncontended and falls back to a futex otherwise.
+ *                  Such a lock is not checked against its precedence.
+ *
+ * \param[in]       lockName is an arbitrary text string used to identify the
+ *                  lock for debugging purposes.
+ *
+ * \param[in]       sw identifies the switch with which this lock is associated.
+ *                  This should be specified as FM_LOCK_SWITCH_NONE for locks 
+ *                  that are not associated with any particular switch.
+ *
+ * \param[in]       precedence indicates this lock's precedence with respect
+ *                  to all other locks (and reader-writer locks) in the system.
+ *                  May be specified as FM_LOCK_SUPER_PRECEDENCE to transcend
+ *                  precedence (lock may be taken in any order with respect to
+ *                  any other lock). Note that specifying this argument as
+ *                  FM_LOCK_SUPER_PRECEDENCE is equivalent to calling 
+ *                  ''fmCreateLock'' instead of this function.
+ *
+ * \param[out]      lck points to a caller-allocated fm_lock object to be 
+ *                  filled in by this function.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory allocation error.
+ * \return          FM_ERR_UNINITIALIZED if ALOS not intialized.
+ * \return          FM_ERR_INVALID_ARGUMENT if lck is NULL.
+ * \return          FM_ERR_LOCK_INIT if unable to initialize lock.
+ *
+ *****************************************************************************/
+fm_status fmCreateLockV2(fm_text  lockName, 
+                         fm_int   sw,
+                         fm_int   precedence,
+                         fm_lock *lck)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS_LOCK, 
+                 "lockName=%s sw=%d, precedence=%d lck=%p\n",
+                 lockName, 
+                 sw,
+                 precedence,
+                 (void *) lck);
+
+    err = CreateLock(lockName, sw, precedence, TRUE, lck);
 
     FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, err);
 
@@ -616,6 +976,51 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fmCreateCondLock
+ * \ingroup intAlosLock
+ *
+ * \desc            Create a lock without precedence that is always an
+ *                  operating system mutex, for use by ALOS together with a
+ *                  condition variable. Such locks are taken directly through
+ *                  their pthread handle, so they never use the fast path
+ *                  selected by the api.lock.fastPath property.
+ *
+ * \param[in]       lockName is an arbitrary text string used to identify the
+ *                  lock for debugging purposes.
+ *
+ * \param[out]      lck points to a caller-allocated fm_lock object to be 
+ *                  filled in by this function.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory allocation error.
+ * \return          FM_ERR_UNINITIALIZED if ALOS not intialized.
+ * \return          FM_ERR_INVALID_ARGUMENT if lck is NULL.
+ * \return          FM_ERR_LOCK_INIT if unable to initialize lock.
+ *
+ *****************************************************************************/
+fm_status fmCreateCondLock(fm_text lockName, fm_lock *lck)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS_LOCK, 
+                 "lockName=%s lck=%p\n",
+                 lockName, 
+                 (void *) lck);
+
+    err = CreateLock(lockName,
+                     FM_LOCK_SWITCH_NONE,
+                     FM_LOCK_SUPER_PRECEDENCE,
+                     FALSE,
+                     lck);
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, err);
+
+}   /* end fmCreateCondLock */
+
+
+
+
 /*****************************************************************************/
 /** fmDeleteLock
  * \ingroup alosLock
@@ -644,7 +1049,8 @@ fm_status fmDeleteLock(fm_lock *lck)
         FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_INVALID_ARGUMENT);
     }
 
-    if (pthread_mutex_destroy( (pthread_mutex_t *) lck->handle ) != 0)
+    if ( !lck->fastPath &&
+         pthread_mutex_destroy( (pthread_mutex_t *) lck->handle ) != 0 )
     {
         FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_LOCK_DESTROY);
     }
@@ -670,8 +1076,10 @@ fm_status fmDeleteLock(fm_lock *lck)
 
     fmFree(lck->name);
     fmFree(lck->handle);
-    lck->name   = NULL;
-    lck->handle = NULL;
+    fmFreeLockProfile(lck->profile);
+    lck->name    = NULL;
+    lck->handle  = NULL;
+    lck->profile = NULL;
 
     FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_OK);
 
@@ -714,6 +1122,10 @@ fm_status fmCaptureLock(fm_lock *lck, fm_timestamp *timeout)
     fm_status       err = FM_OK;
     char            strErrBuf[FM_STRERROR_BUF_SIZE];
     errno_t         strErrNum;
+    fm_uint64       waitStart = 0;
+#if FM_LOCK_PROFILING
+    fm_bool         profile;
+#endif
 
 #ifdef FM_ALOS_LOCK_FUNCTION_LOGGING   /* Performance-sensitive path */
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS_LOCK,
@@ -734,6 +1146,38 @@ fm_status fmCaptureLock(fm_lock *lck, fm_timestamp *timeout)
                      "Attempted to lock an uninitialized lock\n");
         FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_LOCK_UNINITIALIZED);
     }
+
+    if (lck->fastPath)
+    {
+        /**************************************************
+         * Fast path locks skip the precedence checks and
+         * the thread's lock collection entirely.
+         **************************************************/
+
+        err = CaptureFastLock(lck, timeout, &waitStart);
+
+        if (err != FM_OK)
+        {
+            FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, err);
+        }
+
+        ++lck->takenCount;
+        lck->owner = fmGetCurrentThreadId();
+
+#if FM_LOCK_PROFILING
+        if ( (lck->takenCount == 1) && FM_LOCK_PROF_ACTIVE(lck->profile) )
+        {
+            lck->profHoldStart = FM_LOCK_PROF_TSC();
+            fmLockProfRecordAcquire(lck->profile, waitStart, lck->profHoldStart);
+        }
+#endif
+
+#ifdef FM_ALOS_LOCK_FUNCTION_LOGGING   /* Performance-sensitive path */
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_OK);
+#else
+        return FM_OK;
+#endif
+    }
     
     /**************************************************
      * Validate the lock precedence. If this thread
@@ -747,7 +1191,35 @@ fm_status fmCaptureLock(fm_lock *lck, fm_timestamp *timeout)
     {
         FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_LOCK_PRECEDENCE);
     }
-    
+
+#if FM_LOCK_PROFILING
+    /**************************************************
+     * Only the outermost capture is profiled. It tries
+     * the mutex first so that a capture that has to
+     * wait can be told apart and timed.
+     **************************************************/
+
+    profile = FM_LOCK_PROF_ACTIVE(lck->profile) &&
+              !( lck->takenCount && (lck->owner == fmGetCurrentThreadId()) );
+
+    posixError = EBUSY;
+
+    if (profile)
+    {
+        posixError = pthread_mutex_trylock( (pthread_mutex_t *) lck->handle );
+
+        if (posixError != 0)
+        {
+            waitStart = FM_LOCK_PROF_TSC();
+        }
+    }
+
+    if (posixError == 0)
+    {
+        /* Taken by the trylock above. */
+    }
+    else
+#endif
     if (timeout == FM_WAIT_FOREVER)
     {
         if ( ( posixError = pthread_mutex_lock( (pthread_mutex_t *)
@@ -830,6 +1302,14 @@ fm_status fmCaptureLock(fm_lock *lck, fm_timestamp *timeout)
     ++lck->takenCount;
     lck->owner = fmGetCurrentThreadId();
 
+#if FM_LOCK_PROFILING
+    if (profile)
+    {
+        lck->profHoldStart = FM_LOCK_PROF_TSC();
+        fmLockProfRecordAcquire(lck->profile, waitStart, lck->profHoldStart);
+    }
+#endif
+
 #ifdef FM_ALOS_LOCK_FUNCTION_LOGGING   /* Performance-sensitive path */
     FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_OK);
 #else
@@ -885,6 +1365,55 @@ fm_status fmReleaseLock(fm_lock *lck)
         FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_LOCK_UNINITIALIZED);
     }
 
+    if (lck->fastPath)
+    {
+        if ( (lck->takenCount == 0) ||
+             (lck->owner != fmGetCurrentThreadId()) )
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_ALOS_LOCK,
+                         "Attempted to unlock lock %s not held by the "
+                         "calling thread\n",
+                         lck->name);
+            FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_ERR_UNABLE_TO_UNLOCK);
+        }
+
+        if (--lck->takenCount == 0)
+        {
+            lck->owner = NULL;
+
+#if FM_LOCK_PROFILING
+            if (lck->profHoldStart != 0)
+            {
+                if ( FM_LOCK_PROF_ACTIVE(lck->profile) )
+                {
+                    fmLockProfRecordRelease(lck->profile, lck->profHoldStart);
+                }
+
+                lck->profHoldStart = 0;
+            }
+#endif
+
+            err = ReleaseFastLock(lck);
+
+            if (err != FM_OK)
+            {
+                ++lck->takenCount;
+                lck->owner = fmGetCurrentThreadId();
+
+                FM_LOG_ERROR(FM_LOG_CAT_ALOS_LOCK,
+                             "Unable to release fast path lock %s\n",
+                             lck->name);
+                FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, err);
+            }
+        }
+
+#ifdef FM_ALOS_LOCK_FUNCTION_LOGGING   /* Performance-sensitive path */
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS_LOCK, FM_OK);
+#else
+        return FM_OK;
+#endif
+    }
+
     /**************************************************
      * If this thread is releasing the lock for
      * the last time, remove it from its lock collection.
@@ -902,6 +1431,18 @@ fm_status fmReleaseLock(fm_lock *lck)
         if(--lck->takenCount == 0)
         {
             lck->owner = NULL;
+
+#if FM_LOCK_PROFILING
+            if (lck->profHoldStart != 0)
+            {
+                if ( FM_LOCK_PROF_ACTIVE(lck->profile) )
+                {
+                    fmLockProfRecordRelease(lck->profile, lck->profHoldStart);
+                }
+
+                lck->profHoldStart = 0;
+            }
+#endif
         }
     }
     
@@ -1027,6 +1568,7 @@ void fmDbgDumpLocks(void)
 {
     fm_lock *  lck;
     fm_int     lockCount = 0;
+    fm_int     fastCount = 0;
     fm_int     i;
     fm_status  err;
     fm_char    threadName[MAX_THREAD_NAME_LENGTH];
@@ -1068,6 +1610,11 @@ void fmDbgDumpLocks(void)
             ++lockCount;
             lck = fmRootAlos->LockList[i];
 
+            if (lck->fastPath)
+            {
+                ++fastCount;
+            }
+
             /* Get owner info */
             err = fmGetThreadState(lck->owner,
                                    threadName,
@@ -1137,7 +1684,7 @@ void fmDbgDumpLocks(void)
     }
 
     FM_LOG_PRINT("----------------------------\n");
-    FM_LOG_PRINT("%d locks\n\n", lockCount);
+    FM_LOG_PRINT("%d locks (%d fast path)\n\n", lockCount, fastCount);
     
     /**************************************************
      * Now do reader-writer locks.
@@ -0,0 +1,826 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_alos_lock_prof.c
+ * Creation Date:   October 15, 2026
+ * Description:     Contention profiling of ALOS locks and reader-writer locks
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LOCK_PROF_UNIT          "cycles"
+#else
+#define LOCK_PROF_UNIT          "nsec"
+#endif
+
+/* Frames of the call stack belonging to the profiler and the lock release
+ * function, which are skipped when recording a call site. */
+#define LOCK_PROF_SKIP_FRAMES   2
+
+#define LOCK_PROF_CALLER_DELIM  " <- "
+
+/* One of the longest holds of a lock */
+typedef struct _fm_lockProfHolder
+{
+    /* Hold time */
+    fm_uint64 holdTime;
+
+    /* Call stack of the release, innermost first */
+    fm_char   caller[FM_LOCK_PROF_CALLER_SIZE];
+
+} fm_lockProfHolder;
+
+struct _fm_lockProfile
+{
+    /* Number of outermost captures */
+    fm_uint64         acquisitions;
+
+    /* Number of captures that had to wait for another thread */
+    fm_uint64         contended;
+
+    /* Sum and maximum of the wait times */
+    fm_uint64         totalWait;
+    fm_uint64         maxWait;
+
+    /* Sum and maximum of the hold times */
+    fm_uint64         totalHold;
+    fm_uint64         maxHold;
+
+    /* Bucket i counts the times t with 2^(i-1) <= t < 2^i, bucket 0
+     * counts zero times and the last bucket everything beyond. */
+    fm_uint64         waitHist[FM_LOCK_PROF_HIST_BUCKETS];
+    fm_uint64         holdHist[FM_LOCK_PROF_HIST_BUCKETS];
+
+    /* Guards the table of longest holds. A thread that finds it taken
+     * drops its sample rather than wait. */
+    fm_uint32         topLock;
+
+    /* Shortest hold in the table once it is full, zero before. Holds that
+     * do not exceed it skip the call stack lookup. */
+    fm_uint64         topMin;
+
+    fm_int            numTop;
+    fm_lockProfHolder top[FM_LOCK_PROF_TOP_HOLDERS];
+
+};
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local function prototypes.
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** GetBucket
+ * \ingroup intAlosLock
+ *
+ * \desc            Returns the log2 histogram bucket of a time.
+ *
+ * \param[in]       time is the wait or hold time.
+ *
+ * \return          The bucket index.
+ *
+ *****************************************************************************/
+static inline fm_int GetBucket(fm_uint64 time)
+{
+    fm_int bucket;
+
+    if (time == 0)
+    {
+        return 0;
+    }
+
+    bucket = 64 - __builtin_clzll(time);
+
+    if (bucket >= FM_LOCK_PROF_HIST_BUCKETS)
+    {
+        bucket = FM_LOCK_PROF_HIST_BUCKETS - 1;
+    }
+
+    return bucket;
+
+}   /* end GetBucket */
+
+
+
+
+/*****************************************************************************/
+/** UpdateMax
+ * \ingroup intAlosLock
+ *
+ * \desc            Atomically raises a maximum to a new value.
+ *
+ * \param[in,out]   max points to the maximum.
+ *
+ * \param[in]       value is the new sample.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void UpdateMax(fm_uint64 *max, fm_uint64 value)
+{
+    fm_uint64 cur;
+
+    cur = FM_ATOMIC_LOAD(max);
+
+    while (value > cur)
+    {
+        if ( FM_ATOMIC_CAS(max, &cur, value) )
+        {
+            break;
+        }
+    }
+
+}   /* end UpdateMax */
+
+
+
+
+/*****************************************************************************/
+/** RecordTopHolder
+ * \ingroup intAlosLock
+ *
+ * \desc            Enters a hold into the table of longest holds of a lock,
+ *                  replacing the shortest one if the table is full.
+ *
+ * \param[in]       prof points to the lock profile.
+ *
+ * \param[in]       holdTime is the hold time.
+ *
+ * \param[in]       caller is the call site of the hold.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void RecordTopHolder(fm_lockProfile *prof,
+                            fm_uint64       holdTime,
+                            fm_text         caller)
+{
+    fm_uint32 expected;
+    fm_int    slot;
+    fm_int    i;
+    fm_uint64 min;
+
+    expected = 0;
+
+    if ( !FM_ATOMIC_CAS(&prof->topLock, &expected, 1) )
+    {
+        return;
+    }
+
+    if (prof->numTop < FM_LOCK_PROF_TOP_HOLDERS)
+    {
+        slot = prof->numTop++;
+    }
+    else
+    {
+        slot = 0;
+
+        for (i = 1 ; i < prof->numTop ; i++)
+        {
+            if (prof->top[i].holdTime < prof->top[slot].holdTime)
+            {
+                slot = i;
+            }
+        }
+
+        if (holdTime <= prof->top[slot].holdTime)
+        {
+            slot = -1;
+        }
+    }
+
+    if (slot >= 0)
+    {
+        prof->top[slot].holdTime = holdTime;
+        fmStringCopy(prof->top[slot].caller,
+                     caller,
+                     FM_LOCK_PROF_CALLER_SIZE);
+
+        if (prof->numTop == FM_LOCK_PROF_TOP_HOLDERS)
+        {
+            min = prof->top[0].holdTime;
+
+            for (i = 1 ; i < prof->numTop ; i++)
+            {
+                if (prof->top[i].holdTime < min)
+                {
+                    min = prof->top[i].holdTime;
+                }
+            }
+
+            FM_ATOMIC_STORE(&prof->topMin, min);
+        }
+    }
+
+    FM_ATOMIC_STORE(&prof->topLock, 0);
+
+}   /* end RecordTopHolder */
+
+
+
+
+/*****************************************************************************/
+/** DumpProfile
+ * \ingroup intAlosLock
+ *
+ * \desc            Prints the profile of one lock.
+ *
+ * \param[in]       name is the name of the lock.
+ *
+ * \param[in]       kind describes the type of lock.
+ *
+ * \param[in]       prof points to the lock profile.
+ *
+ * \param[in]       perUsec is the number of time units per microsecond,
+ *                  or zero if unknown.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void DumpProfile(fm_text         name,
+                        fm_text         kind,
+                        fm_lockProfile *prof,
+                        fm_uint64       perUsec)
+{
+    fm_uint64 acquisitions;
+    fm_uint64 contended;
+    fm_int    last;
+    fm_int    i;
+
+    acquisitions = prof->acquisitions;
+    contended    = prof->contended;
+
+    if (acquisitions == 0)
+    {
+        return;
+    }
+
+    FM_LOG_PRINT("%s (%s):\n", name, kind);
+    FM_LOG_PRINT("    Acquisitions : %llu\n",
+                 (unsigned long long) acquisitions);
+    FM_LOG_PRINT("    Contended    : %llu (%.2f%%)\n",
+                 (unsigned long long) contended,
+                 100.0 * contended / acquisitions);
+    FM_LOG_PRINT("    Wait         : avg %llu max %llu %s\n",
+                 (unsigned long long) (prof->totalWait / acquisitions),
+                 (unsigned long long) prof->maxWait,
+                 LOCK_PROF_UNIT);
+    FM_LOG_PRINT("    Hold         : avg %llu max %llu %s\n",
+                 (unsigned long long) (prof->totalHold / acquisitions),
+                 (unsigned long long) prof->maxHold,
+                 LOCK_PROF_UNIT);
+
+    last = 0;
+
+    for (i = 0 ; i < FM_LOCK_PROF_HIST_BUCKETS ; i++)
+    {
+        if (prof->waitHist[i] || prof->holdHist[i])
+        {
+            last = i;
+        }
+    }
+
+    FM_LOG_PRINT("    %-12s %12s %12s %14s\n",
+                 "< " LOCK_PROF_UNIT,
+                 "Wait",
+                 "Hold",
+                 "(usec)");
+
+    for (i = 0 ; i <= last ; i++)
+    {
+        if (i == 0)
+        {
+            FM_LOG_PRINT("    %-12s ", "0");
+        }
+        else if (i == FM_LOCK_PROF_HIST_BUCKETS - 1)
+        {
+            FM_LOG_PRINT("    >= 2^%-7d ", i - 1);
+        }
+        else
+        {
+            FM_LOG_PRINT("    2^%-10d ", i);
+        }
+
+        FM_LOG_PRINT("%12llu %12llu",
+                     (unsigned long long) prof->waitHist[i],
+                     (unsigned long long) prof->holdHist[i]);
+
+        if (i > 0 && perUsec > 0)
+        {
+            FM_LOG_PRINT(" %14.3f", (double) (1ULL << i) / perUsec);
+        }
+
+        FM_LOG_PRINT("\n");
+    }
+
+    if (prof->numTop > 0)
+    {
+        FM_LOG_PRINT("    Longest holds (%s):\n", LOCK_PROF_UNIT);
+
+        for (i = 0 ; i < prof->numTop ; i++)
+        {
+            FM_LOG_PRINT("    %12llu %s\n",
+                         (unsigned long long) prof->top[i].holdTime,
+                         prof->top[i].caller);
+        }
+    }
+
+    FM_LOG_PRINT("\n");
+
+}   /* end DumpProfile */
+
+
+
+
+/*****************************************************************************/
+/** ResetProfile
+ * \ingroup intAlosLock
+ *
+ * \desc            Clears the profile of one lock.
+ *
+ * \param[in]       prof points to the lock profile.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ResetProfile(fm_lockProfile *prof)
+{
+    fm_uint32 expected;
+
+    /* Keep record holders out while the table is cleared. */
+    do
+    {
+        expected = 0;
+    }
+    while ( !FM_ATOMIC_CAS(&prof->topLock, &expected, 1) );
+
+    prof->acquisitions = 0;
+    prof->contended    = 0;
+    prof->totalWait    = 0;
+    prof->maxWait      = 0;
+    prof->totalHold    = 0;
+    prof->maxHold      = 0;
+    prof->topMin       = 0;
+    prof->numTop       = 0;
+    FM_CLEAR(prof->waitHist);
+    FM_CLEAR(prof->holdHist);
+
+    FM_ATOMIC_STORE(&prof->topLock, 0);
+
+}   /* end ResetProfile */
+
+
+
+
+/*****************************************************************************/
+/** StampProfileStart
+ * \ingroup intAlosLock
+ *
+ * \desc            Records the profiling start time in both timestamp and
+ *                  wall clock units, so that the dump can convert the
+ *                  histogram buckets to microseconds.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void StampProfileStart(void)
+{
+
+    fmRootAlos->lockProfStartTsc  = FM_LOCK_PROF_TSC();
+    fmRootAlos->lockProfStartNsec = fmGetMonotonicNsec();
+
+}   /* end StampProfileStart */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fmAllocLockProfile
+ * \ingroup intAlosLock
+ *
+ * \desc            Allocates an empty lock profile in shared memory.
+ *
+ * \param           None.
+ *
+ * \return          The profile, or NULL if out of memory.
+ *
+ *****************************************************************************/
+fm_lockProfile *fmAllocLockProfile(void)
+{
+    fm_lockProfile *prof;
+
+    prof = fmAlloc( sizeof(fm_lockProfile) );
+
+    if (prof != NULL)
+    {
+        FM_CLEAR(*prof);
+    }
+
+    return prof;
+
+}   /* end fmAllocLockProfile */
+
+
+
+
+/*****************************************************************************/
+/** fmFreeLockProfile
+ * \ingroup intAlosLock
+ *
+ * \desc            Frees a lock profile.
+ *
+ * \param[in]       prof points to the profile, may be NULL.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmFreeLockProfile(fm_lockProfile *prof)
+{
+
+    if (prof != NULL)
+    {
+        fmFree(prof);
+    }
+
+}   /* end fmFreeLockProfile */
+
+
+
+
+/*****************************************************************************/
+/** fmLockProfRecordAcquire
+ * \ingroup intAlosLock
+ *
+ * \desc            Records an outermost capture of a lock.
+ *
+ * \param[in]       prof points to the lock profile.
+ *
+ * \param[in]       waitStart is the time at which the thread found the
+ *                  lock taken, or zero if the capture did not wait.
+ *
+ * \param[in]       acquired is the time at which the lock was taken.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmLockProfRecordAcquire(fm_lockProfile *prof,
+                             fm_uint64       waitStart,
+                             fm_uint64       acquired)
+{
+    fm_uint64 wait;
+
+    wait = 0;
+
+    if (waitStart != 0)
+    {
+        FM_ATOMIC_ADD(&prof->contended, 1);
+
+        if (acquired > waitStart)
+        {
+            wait = acquired - waitStart;
+        }
+    }
+
+    FM_ATOMIC_ADD(&prof->acquisitions, 1);
+    FM_ATOMIC_ADD(&prof->totalWait, wait);
+    FM_ATOMIC_ADD(&prof->waitHist[GetBucket(wait)], 1);
+    UpdateMax(&prof->maxWait, wait);
+
+}   /* end fmLockProfRecordAcquire */
+
+
+
+
+/*****************************************************************************/
+/** fmLockProfRecordRelease
+ * \ingroup intAlosLock
+ *
+ * \desc            Records the last release of a lock by its holder. Holds
+ *                  that make it into the table of longest holds are
+ *                  attributed to the caller of the lock release function,
+ *                  as reported by ''fmGetCallerName''.
+ *
+ * \note            Must be called directly from the lock release function,
+ *                  since the frames of both functions are skipped.
+ *
+ * \param[in]       prof points to the lock profile.
+ *
+ * \param[in]       holdStart is the time at which the lock was taken.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmLockProfRecordRelease(fm_lockProfile *prof, fm_uint64 holdStart)
+{
+    fm_uint64 now;
+    fm_uint64 hold;
+    fm_char   stack[FM_MAX_CALL_STACK_BFR_SIZE];
+    fm_text   caller;
+    fm_int    i;
+
+    now  = FM_LOCK_PROF_TSC();
+    hold = (now > holdStart) ? (now - holdStart) : 0;
+
+    FM_ATOMIC_ADD(&prof->totalHold, hold);
+    FM_ATOMIC_ADD(&prof->holdHist[GetBucket(hold)], 1);
+    UpdateMax(&prof->maxHold, hold);
+
+    if ( hold <= FM_ATOMIC_LOAD(&prof->topMin) )
+    {
+        return;
+    }
+
+    /**************************************************
+     * fmGetCallerName lists its caller first and leaves
+     * out the outermost frame it is asked for.
+     **************************************************/
+
+    fmGetCallerName(stack,
+                    sizeof(stack),
+                    LOCK_PROF_SKIP_FRAMES + FM_LOCK_PROF_CALLER_DEPTH + 1,
+                    LOCK_PROF_CALLER_DELIM);
+
+    caller = stack;
+
+    for (i = 0 ; i < LOCK_PROF_SKIP_FRAMES && caller != NULL ; i++)
+    {
+        caller = strstr(caller, LOCK_PROF_CALLER_DELIM);
+
+        if (caller != NULL)
+        {
+            caller += strlen(LOCK_PROF_CALLER_DELIM);
+        }
+    }
+
+    RecordTopHolder(prof, hold, (caller != NULL) ? caller : stack);
+
+}   /* end fmLockProfRecordRelease */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgEnableLockProfile
+ * \ingroup diagMisc
+ *
+ * \desc            Turns lock contention profiling on or off. While it is
+ *                  on, every lock and reader-writer lock records its number
+ *                  of captures, the captures that had to wait, log2
+ *                  histograms of wait and hold times, and the call sites
+ *                  of its longest holds. Times are measured with the time
+ *                  stamp counter where available.
+ *
+ * \note            Profiling is only available if the SDK was built with
+ *                  FM_LOCK_PROFILING. Otherwise the lock functions carry
+ *                  no profiling code at all.
+ *
+ * \param[in]       enable is TRUE to turn profiling on, FALSE to turn it
+ *                  off. The collected profile is kept in both cases.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNINITIALIZED if ALOS not initialized.
+ * \return          FM_ERR_UNSUPPORTED if profiling was not compiled in.
+ *
+ *****************************************************************************/
+fm_status fmDbgEnableLockProfile(fm_bool enable)
+{
+
+    if (fmRootAlos == NULL)
+    {
+        return FM_ERR_UNINITIALIZED;
+    }
+
+#if FM_LOCK_PROFILING
+    if (enable && fmRootAlos->lockProfStartNsec == 0)
+    {
+        StampProfileStart();
+    }
+
+    FM_ATOMIC_STORE(&fmRootAlos->lockProfEnabled, enable);
+
+    return FM_OK;
+#else
+    FM_NOT_USED(enable);
+
+    return FM_ERR_UNSUPPORTED;
+#endif
+
+}   /* end fmDbgEnableLockProfile */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgDumpLockProfile
+ * \ingroup diagMisc
+ *
+ * \desc            Dumps the contention profile of every lock and
+ *                  reader-writer lock that has been captured since
+ *                  profiling was enabled or last reset.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmDbgDumpLockProfile(void)
+{
+    fm_lock *  lck;
+    fm_rwLock *rwl;
+    fm_uint64  elapsedNsec;
+    fm_uint64  perUsec;
+    fm_int     i;
+
+    if (fmRootAlos == NULL)
+    {
+        return;
+    }
+
+#if !FM_LOCK_PROFILING
+    FM_LOG_PRINT("Lock profiling is not compiled in (FM_LOCK_PROFILING)\n");
+    return;
+#endif
+
+    perUsec     = 0;
+    elapsedNsec = fmGetMonotonicNsec() - fmRootAlos->lockProfStartNsec;
+
+    if (fmRootAlos->lockProfStartNsec != 0 && elapsedNsec >= 1000)
+    {
+        perUsec = ( (FM_LOCK_PROF_TSC() - fmRootAlos->lockProfStartTsc) * 1000 )
+                  / elapsedNsec;
+    }
+
+    FM_LOG_PRINT("\nLock profile (%s, %llu %s per usec):\n\n",
+                 fmRootAlos->lockProfEnabled ? "enabled" : "disabled",
+                 (unsigned long long) perUsec,
+                 LOCK_PROF_UNIT);
+
+    if ( pthread_mutex_lock( (pthread_mutex_t *) fmRootAlos->LockLock.handle ) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ALOS_LOCK, "\nUnable to take lock lock!\n");
+        return;
+    }
+
+    for (i = 1 ; i < FM_ALOS_INTERNAL_MAX_LOCKS ; i++)
+    {
+        lck = fmRootAlos->LockList[i];
+
+        if (lck != NULL && lck->profile != NULL)
+        {
+            DumpProfile(lck->name, "lock", lck->profile, perUsec);
+        }
+    }
+
+    if ( pthread_mutex_unlock( (pthread_mutex_t *) fmRootAlos->LockLock.handle ) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ALOS_LOCK, "\nUnable to release lock lock!\n");
+        return;
+    }
+
+    if ( pthread_mutex_lock( (pthread_mutex_t *) fmRootAlos->dbgRwLockListLock.handle ) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ALOS_RWLOCK, "\nUnable to take rwlock list lock!\n");
+        return;
+    }
+
+    for (i = 0 ; i < FM_ALOS_INTERNAL_MAX_DBG_RW_LOCKS ; i++)
+    {
+        rwl = fmRootAlos->dbgRwLockList[i];
+
+        if (rwl != NULL && rwl->profile != NULL)
+        {
+            DumpProfile(rwl->name, "rwlock", rwl->profile, perUsec);
+        }
+    }
+
+    if ( pthread_mutex_unlock( (pthread_mutex_t *) fmRootAlos->dbgRwLockListLock.handle ) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ALOS_RWLOCK, "\nUnable to release rwlock list lock!\n");
+    }
+
+}   /* end fmDbgDumpLockProfile */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgResetLockProfile
+ * \ingroup diagMisc
+ *
+ * \desc            Clears the contention profile of every lock and
+ *                  reader-writer lock. Samples recorded concurrently with
+ *                  the reset may be partially lost.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmDbgResetLockProfile(void)
+{
+    fm_lock *  lck;
+    fm_rwLock *rwl;
+    fm_int     i;
+
+    if (fmRootAlos == NULL)
+    {
+        return;
+    }
+
+    if ( pthread_mutex_lock( (pthread_mutex_t *) fmRootAlos->LockLock.handle ) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ALOS_LOCK, "\nUnable to take lock lock!\n");
+        return;
+    }
+
+    for (i = 1 ; i < FM_ALOS_INTERNAL_MAX_LOCKS ; i++)
+    {
+        lck = fmRootAlos->LockList[i];
+
+        if (lck != NULL && lck->profile != NULL)
+        {
+            ResetProfile(lck->profile);
+        }
+    }
+
+    if ( pthread_mutex_unlock( (pthread_mutex_t *) fmRootAlos->LockLock.handle ) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ALOS_LOCK, "\nUnable to release lock lock!\n");
+        return;
+    }
+
+    if ( pthread_mutex_lock( (pthread_mutex_t *) fmRootAlos->dbgRwLockListLock.handle ) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ALOS_RWLOCK, "\nUnable to take rwlock list lock!\n");
+        return;
+    }
+
+    for (i = 0 ; i < FM_ALOS_INTERNAL_MAX_DBG_RW_LOCKS ; i++)
+    {
+        rwl = fmRootAlos->dbgRwLockList[i];
+
+        if (rwl != NULL && rwl->profile != NULL)
+        {
+            ResetProfile(rwl->profile);
+        }
+    }
+
+    if ( pthread_mutex_unlock( (pthread_mutex_t *) fmRootAlos->dbgRwLockListLock.handle ) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ALOS_RWLOCK, "\nUnable to release rwlock list lock!\n");
+    }
+
+    StampProfileStart();
+
+}   /* end fmDbgResetLockProfile */
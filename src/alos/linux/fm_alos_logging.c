@@ -32,6 +32,7 @@
  *****************************************************************************/
 
 #include <fm_sdk_int.h>
+#include <poll.h>
 
 /*****************************************************************************
  * Macros, Constants & Types
@@ -43,6 +44,95 @@
 #define GET_LOGGING_STATE() \
     ((fmRootAlos) ? &fmRootAlos->fmLoggingState : NULL);
 
+/* Number of records in each thread's asynchronous logging ring. Must be a
+ * power of two. */
+#define LOG_ASYNC_RING_SIZE     128
+#define LOG_ASYNC_RING_MASK     (LOG_ASYNC_RING_SIZE - 1)
+
+/* Longest interval, in milliseconds, between two passes of the writer */
+#define LOG_ASYNC_FLUSH_MSEC    10
+
+
+/* A log message queued by the thread that generated it */
+typedef struct _fm_logAsyncRecord
+{
+    fm_uint64    categories;
+    fm_uint64    logLevel;
+    const char * srcFile;
+    const char * srcFunction;
+    fm_uint32    srcLine;
+
+    /* Verbosity in effect when the message was generated */
+    fm_uint32    verbosityMask;
+
+    /* The message skips the file and function filters */
+    fm_bool      bypassFilter;
+
+    /* Wall clock and monotonic times at which the message was generated,
+     * only taken when the verbosity mask asks for them */
+    fm_uint64    wallTime;
+    fm_timestamp ts;
+
+    /* The message itself, already formatted */
+    fm_char      text[FM_LOG_MAX_LINE_SIZE];
+
+} fm_logAsyncRecord;
+
+
+/* Single-producer, single-consumer ring of one thread, process-local */
+typedef struct _fm_logAsyncRing
+{
+    /* Next record to fill, only written by the owning thread */
+    fm_uint32                head;
+
+    /* Next record to write out, only written while holding ringLock */
+    fm_uint32                tail;
+
+    /* Messages discarded because the ring was full, and how many of
+     * these the writer has reported so far */
+    fm_uint64                dropped;
+    fm_uint64                droppedReported;
+
+    /* Set when the owning thread exits; the writer then frees the ring
+     * once it is empty */
+    fm_bool                  orphaned;
+
+    fm_char                  threadName[64];
+
+    struct _fm_logAsyncRing *next;
+
+    fm_logAsyncRecord        records[LOG_ASYNC_RING_SIZE];
+
+} fm_logAsyncRing;
+
+
+/* Asynchronous logging state, process-local */
+typedef struct _fm_logAsyncState
+{
+    /* Whether LogMessage queues console and file messages */
+    fm_bool          enabled;
+
+    /* Asks the writer thread to exit */
+    fm_bool          stopping;
+
+    /* Serializes fmSetLoggingAsync */
+    pthread_mutex_t  controlLock;
+
+    /* Protects the ring list and serializes the draining of the rings */
+    pthread_mutex_t  ringLock;
+
+    fm_logAsyncRing *rings;
+
+    /* Dropped messages of the rings that have been freed */
+    fm_uint64        retiredDrops;
+
+    /* eventfd used to wake up the writer before its next pass */
+    int              wakeFd;
+
+    fm_thread        writer;
+
+} fm_logAsyncState;
+
 
 /*****************************************************************************
  * Global Variables
@@ -52,6 +142,24 @@
  * Local Variables
  *****************************************************************************/
 
+static void DestroyAsyncRing(void *arg);
+
+/* The calling thread's asynchronous logging ring */
+static fm_threadLocal asyncRing = FM_THREAD_LOCAL_INIT(DestroyAsyncRing);
+
+static fm_logAsyncState logAsync =
+{
+    FALSE,
+    FALSE,
+    PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER,
+    NULL,
+    0,
+    -1,
+};
+
+static pthread_once_t logAsyncForkOnce = PTHREAD_ONCE_INIT;
+
 /*****************************************************************************
  * Local function prototypes.
  *****************************************************************************/
@@ -123,6 +231,634 @@ static fm_bool ApplyLoggingFilter(const char *haystack, const char *needle)
 
 
 
+/*****************************************************************************/
+/** GetLogLevelString
+ * \ingroup intLogging
+ *
+ * \desc            Return the name under which a log level is printed.
+ *
+ * \param[in]       logLevel is the level flag (see ''Log Levels'') of the
+ *                  log message.
+ *
+ * \return          The name of the log level.
+ *
+ *****************************************************************************/
+static fm_text GetLogLevelString(fm_uint64 logLevel)
+{
+    switch (logLevel)
+    {
+        case FM_LOG_LEVEL_FUNC_ENTRY:
+        case FM_LOG_LEVEL_FUNC_ENTRY_API:
+        case FM_LOG_LEVEL_FUNC_ENTRY_VERBOSE:
+        case FM_LOG_LEVEL_FUNC_ENTRY_API_VERBOSE:
+            return "ENTRY";
+
+        case FM_LOG_LEVEL_FUNC_EXIT:
+        case FM_LOG_LEVEL_FUNC_EXIT_API:
+        case FM_LOG_LEVEL_FUNC_EXIT_VERBOSE:
+        case FM_LOG_LEVEL_FUNC_EXIT_API_VERBOSE:
+            return "EXIT";
+
+        case FM_LOG_LEVEL_WARNING:
+            return "WARNING";
+
+        case FM_LOG_LEVEL_ERROR:
+            return "ERROR";
+
+        case FM_LOG_LEVEL_FATAL:
+            return "FATAL";
+
+        case FM_LOG_LEVEL_INFO:
+            return "INFO";
+
+        case FM_LOG_LEVEL_DEBUG:
+        case FM_LOG_LEVEL_DEBUG_VERBOSE:
+            return "DEBUG";
+
+        case FM_LOG_LEVEL_PRINT:
+            return "PRINT";
+
+        case FM_LOG_LEVEL_DEBUG2:
+            return "DEBUG2";
+
+        case FM_LOG_LEVEL_DEBUG3:
+            return "DEBUG3";
+
+        case FM_LOG_LEVEL_ASSERT:
+            return "ASSERT";
+
+        default:
+            return "UNKNOWN_LVL";
+
+    }   /* end switch (logLevel) */
+
+}   /* end GetLogLevelString */
+
+
+
+
+/*****************************************************************************/
+/** DestroyAsyncRing
+ * \ingroup intLogging
+ *
+ * \desc            Thread-local destructor of a thread's asynchronous
+ *                  logging ring. Messages still queued belong to the writer,
+ *                  so the ring is only marked as orphaned here and the
+ *                  writer frees it once it has drained it.
+ *
+ * \param[in]       arg points to the ring.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void DestroyAsyncRing(void *arg)
+{
+    fm_logAsyncRing *ring = arg;
+
+    FM_ATOMIC_STORE(&ring->orphaned, TRUE);
+
+}   /* end DestroyAsyncRing */
+
+
+
+
+/*****************************************************************************/
+/** GetAsyncRing
+ * \ingroup intLogging
+ *
+ * \desc            Return the calling thread's asynchronous logging ring,
+ *                  creating it on first use. The ring is process-local, so
+ *                  it is allocated from the process heap, which also keeps
+ *                  the allocator's own logging out of this path.
+ *
+ * \param           None.
+ *
+ * \return          Pointer to the ring, or NULL if it could not be created.
+ *
+ *****************************************************************************/
+static fm_logAsyncRing *GetAsyncRing(void)
+{
+    fm_logAsyncRing *ring;
+    fm_text          threadName;
+
+    ring = fmGetThreadLocal(&asyncRing);
+
+    if (ring == NULL)
+    {
+        ring = calloc( 1, sizeof(fm_logAsyncRing) );
+
+        if (ring == NULL)
+        {
+            return NULL;
+        }
+
+        threadName = fmGetCurrentThreadName();
+
+        if (threadName != NULL)
+        {
+            FM_SNPRINTF_S(ring->threadName,
+                          sizeof(ring->threadName),
+                          "%s",
+                          threadName);
+        }
+        else
+        {
+            FM_SNPRINTF_S(ring->threadName,
+                          sizeof(ring->threadName),
+                          "<%p>",
+                          fmGetCurrentThreadId() );
+        }
+
+        if (fmSetThreadLocal(&asyncRing, ring) != FM_OK)
+        {
+            free(ring);
+            return NULL;
+        }
+
+        pthread_mutex_lock(&logAsync.ringLock);
+        ring->next     = logAsync.rings;
+        logAsync.rings = ring;
+        pthread_mutex_unlock(&logAsync.ringLock);
+    }
+
+    return ring;
+
+}   /* end GetAsyncRing */
+
+
+
+
+/*****************************************************************************/
+/** WakeAsyncWriter
+ * \ingroup intLogging
+ *
+ * \desc            Wake up the asynchronous logging writer before its next
+ *                  periodic pass.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void WakeAsyncWriter(void)
+{
+    fm_uint64 one = 1;
+
+    if (write(logAsync.wakeFd, &one, sizeof(one)) < 0)
+    {
+        /* The counter is already non-zero, the writer will wake up */
+    }
+
+}   /* end WakeAsyncWriter */
+
+
+
+
+/*****************************************************************************/
+/** PushAsyncRecord
+ * \ingroup intLogging
+ *
+ * \desc            Queue a log message on the calling thread's ring for the
+ *                  asynchronous logging writer. Only the message text is
+ *                  formatted here; the prefix is left to the writer.
+ *                                                                      \lb\lb
+ *                  When the ring is full, the message is discarded and
+ *                  counted as dropped. The writer is woken up early once
+ *                  the ring is half full.
+ *
+ * \param[in]       categories is the bitmask of categories of the message.
+ *
+ * \param[in]       logLevel is the level flag of the message.
+ *
+ * \param[in]       verbosityMask is the verbosity in effect for the message.
+ *
+ * \param[in]       bypassFilter is TRUE if the message skips the file and
+ *                  function filters.
+ *
+ * \param[in]       srcFile is the name of the source code file.
+ *
+ * \param[in]       srcFunction is the name of the source code function.
+ *
+ * \param[in]       srcLine is the source code line number.
+ *
+ * \param[in]       format is the printf-style format.
+ *
+ * \param[in]       ap is the printf var-args argument list.
+ *
+ * \return          FM_OK if the message was queued or dropped.
+ * \return          FM_ERR_NO_MEM if the calling thread has no ring, in which
+ *                  case ap has not been used.
+ *
+ *****************************************************************************/
+static fm_status PushAsyncRecord(fm_uint64   categories,
+                                 fm_uint64   logLevel,
+                                 fm_uint32   verbosityMask,
+                                 fm_bool     bypassFilter,
+                                 const char *srcFile,
+                                 const char *srcFunction,
+                                 fm_uint32   srcLine,
+                                 const char *format,
+                                 va_list     ap)
+{
+    fm_logAsyncRing *  ring;
+    fm_logAsyncRecord *rec;
+    fm_uint32          head;
+    fm_uint32          used;
+    struct timespec    tv;
+    int                len;
+
+    ring = GetAsyncRing();
+
+    if (ring == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    head = ring->head;
+    used = head - FM_ATOMIC_LOAD(&ring->tail);
+
+    if (used >= LOG_ASYNC_RING_SIZE)
+    {
+        FM_ATOMIC_STORE(&ring->dropped, ring->dropped + 1);
+        return FM_OK;
+    }
+
+    rec = &ring->records[head & LOG_ASYNC_RING_MASK];
+
+    rec->categories    = categories;
+    rec->logLevel      = logLevel;
+    rec->srcFile       = srcFile;
+    rec->srcFunction   = srcFunction;
+    rec->srcLine       = srcLine;
+    rec->verbosityMask = verbosityMask;
+    rec->bypassFilter  = bypassFilter;
+
+    if (verbosityMask & FM_LOG_VERBOSITY_DATE_TIME)
+    {
+        rec->wallTime = time(NULL);
+    }
+
+    if (verbosityMask & FM_LOG_VERBOSITY_TIMESTAMP)
+    {
+        /* same clock as fmGetTime, which would log on this path */
+        clock_gettime(CLOCK_MONOTONIC, &tv);
+        rec->ts.sec  = tv.tv_sec;
+        rec->ts.usec = tv.tv_nsec / 1000;
+    }
+
+    len = vsnprintf(rec->text, sizeof(rec->text), format, ap);
+
+    if ( len >= (int) sizeof(rec->text) )
+    {
+        /* keep the line break of a truncated message */
+        rec->text[sizeof(rec->text) - 2] = '\n';
+    }
+    else if (len < 0)
+    {
+        rec->text[0] = '\0';
+    }
+
+    FM_ATOMIC_STORE(&ring->head, head + 1);
+
+    if ( used + 1 == LOG_ASYNC_RING_SIZE / 2 )
+    {
+        WakeAsyncWriter();
+    }
+
+    return FM_OK;
+
+}   /* end PushAsyncRecord */
+
+
+
+
+/*****************************************************************************/
+/** WriteAsyncRecord
+ * \ingroup intLogging
+ *
+ * \desc            Write out one queued log message, prefixed the same way
+ *                  as ''LogMessage'' does for the console and file types.
+ *
+ * \param[in]       out is the destination stream.
+ *
+ * \param[in]       ring is the ring holding the message.
+ *
+ * \param[in]       rec is the message.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void WriteAsyncRecord(FILE *             out,
+                             fm_logAsyncRing *  ring,
+                             fm_logAsyncRecord *rec)
+{
+    fm_uint32 verbosityMask = rec->verbosityMask;
+    fm_char   dateStr[64];
+    time_t    wallTime;
+
+    if (verbosityMask & FM_LOG_VERBOSITY_DATE_TIME)
+    {
+        wallTime = (time_t) rec->wallTime;
+
+        if ( ctime_r(&wallTime, dateStr) )
+        {
+            /* chop off newline */
+            dateStr[strlen(dateStr) - 1] = 0;
+            FM_FPRINTF_S(out, "%s:", dateStr);
+        }
+    }
+
+    if (verbosityMask & FM_LOG_VERBOSITY_TIMESTAMP)
+    {
+        FM_FPRINTF_S(out, "%u.%04u:", rec->ts.sec, rec->ts.usec / 100);
+    }
+
+    if (verbosityMask & FM_LOG_VERBOSITY_LOG_LEVEL)
+    {
+        FM_FPRINTF_S(out, "%s:", GetLogLevelString(rec->logLevel) );
+    }
+
+    if (verbosityMask & FM_LOG_VERBOSITY_THREAD)
+    {
+        FM_FPRINTF_S(out, "%s:", ring->threadName);
+    }
+
+    if (verbosityMask & FM_LOG_VERBOSITY_FILE)
+    {
+        FM_FPRINTF_S(out, "%s:", rec->srcFile);
+    }
+
+    if (verbosityMask & FM_LOG_VERBOSITY_FUNC)
+    {
+        FM_FPRINTF_S(out, "%s:", rec->srcFunction);
+    }
+
+    if (verbosityMask & FM_LOG_VERBOSITY_LINE)
+    {
+        FM_FPRINTF_S(out, "%d:", rec->srcLine);
+    }
+
+    FM_FPRINTF_S(out, "%s", rec->text);
+
+}   /* end WriteAsyncRecord */
+
+
+
+
+/*****************************************************************************/
+/** DrainAsyncRings
+ * \ingroup intLogging
+ *
+ * \desc            Write out every message queued on the asynchronous
+ *                  logging rings of this process as one batch: the log file
+ *                  is opened once, the output is flushed once, and the
+ *                  logging access lock is held across the batch. Dropped
+ *                  messages are reported, and the rings of exited threads
+ *                  are freed once empty.
+ *                                                                      \lb\lb
+ *                  This function must not log, since the writer would then
+ *                  queue a message while holding ringLock.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void DrainAsyncRings(void)
+{
+    fm_loggingState *  ls = GET_LOGGING_STATE();
+    fm_logAsyncRing ** link;
+    fm_logAsyncRing *  ring;
+    fm_logAsyncRecord *rec;
+    fm_uint32          head;
+    fm_uint32          tail;
+    fm_uint64          dropped;
+    fm_bool            orphaned;
+    fm_bool            locked;
+    fm_bool            filter;
+    FILE *             out;
+
+    if ( !LOG_INITIALIZED(ls) )
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&logAsync.ringLock);
+
+    locked = FALSE;
+    out    = NULL;
+    link   = &logAsync.rings;
+
+    while ( (ring = *link) != NULL )
+    {
+        /* read orphaned first, so that no message can follow it */
+        orphaned = FM_ATOMIC_LOAD(&ring->orphaned);
+        head     = FM_ATOMIC_LOAD(&ring->head);
+        tail     = ring->tail;
+        dropped  = FM_ATOMIC_LOAD(&ring->dropped);
+
+        if ( tail != head || dropped != ring->droppedReported )
+        {
+            if (!locked)
+            {
+                if ( pthread_mutex_lock( (pthread_mutex_t *) ls->accessLock ) != 0 )
+                {
+                    break;
+                }
+
+                locked = TRUE;
+
+                if (ls->logType == FM_LOG_TYPE_FILE)
+                {
+                    out = fopen(ls->logFileName, "at");
+                }
+                else
+                {
+                    out = stdout;
+                }
+            }
+
+            while (tail != head)
+            {
+                rec    = &ring->records[tail & LOG_ASYNC_RING_MASK];
+                filter = TRUE;
+
+                if (!rec->bypassFilter)
+                {
+                    if (filter && ls->functionFilter[0])
+                    {
+                        filter = ApplyLoggingFilter(ls->functionFilter,
+                                                    rec->srcFunction);
+                    }
+
+                    if (filter && ls->fileFilter[0])
+                    {
+                        filter = ApplyLoggingFilter(ls->fileFilter,
+                                                    rec->srcFile);
+                    }
+                }
+
+                if (filter && out != NULL)
+                {
+                    WriteAsyncRecord(out, ring, rec);
+                }
+
+                tail++;
+            }
+
+            FM_ATOMIC_STORE(&ring->tail, tail);
+
+            if (dropped != ring->droppedReported)
+            {
+                if (out != NULL)
+                {
+                    FM_FPRINTF_S(out,
+                                 "-- %llu log messages dropped by %s --\n",
+                                 (unsigned long long) (dropped - ring->droppedReported),
+                                 ring->threadName);
+                }
+
+                ring->droppedReported = dropped;
+            }
+        }
+
+        if (orphaned)
+        {
+            *link = ring->next;
+            logAsync.retiredDrops += dropped;
+            free(ring);
+        }
+        else
+        {
+            link = &ring->next;
+        }
+    }
+
+    if (locked)
+    {
+        if (out == stdout)
+        {
+            fflush(out);
+        }
+        else if (out != NULL)
+        {
+            fclose(out);
+        }
+
+        pthread_mutex_unlock( (pthread_mutex_t *) ls->accessLock );
+    }
+
+    pthread_mutex_unlock(&logAsync.ringLock);
+
+}   /* end DrainAsyncRings */
+
+
+
+
+/*****************************************************************************/
+/** AsyncLogWriter
+ * \ingroup intLogging
+ *
+ * \desc            Main loop of the asynchronous logging writer thread.
+ *                  Drains the rings every LOG_ASYNC_FLUSH_MSEC, or earlier
+ *                  when a producer wakes it up.
+ *
+ * \param[in]       args is the thread argument pointer.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void *AsyncLogWriter(void *args)
+{
+    fm_thread *       thisThread;
+    fm_logAsyncState *state;
+    struct pollfd     pfd;
+    fm_uint64         count;
+
+    thisThread = FM_GET_THREAD_HANDLE(args);
+    state      = FM_GET_THREAD_PARAM(fm_logAsyncState, args);
+
+    pfd.fd     = state->wakeFd;
+    pfd.events = POLLIN;
+
+    while ( !FM_ATOMIC_LOAD(&state->stopping) )
+    {
+        if (poll(&pfd, 1, LOG_ASYNC_FLUSH_MSEC) > 0)
+        {
+            if (read(state->wakeFd, &count, sizeof(count)) < 0)
+            {
+                /* Someone else consumed the wakeup */
+            }
+        }
+
+        DrainAsyncRings();
+    }
+
+    fmExitThread(thisThread);
+
+    return NULL;
+
+}   /* end AsyncLogWriter */
+
+
+
+
+/*****************************************************************************/
+/** ResetAsyncLoggingInChild
+ * \ingroup intLogging
+ *
+ * \desc            fork() handler run in the child process. The writer
+ *                  thread does not survive the fork, so asynchronous
+ *                  logging is turned off in the child and the messages
+ *                  inherited from the parent are discarded.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ResetAsyncLoggingInChild(void)
+{
+    pthread_mutex_t  initLock = PTHREAD_MUTEX_INITIALIZER;
+    fm_logAsyncRing *ring;
+
+    logAsync.enabled     = FALSE;
+    logAsync.stopping    = FALSE;
+    logAsync.controlLock = initLock;
+    logAsync.ringLock    = initLock;
+
+    for (ring = logAsync.rings ; ring != NULL ; ring = ring->next)
+    {
+        ring->tail            = ring->head;
+        ring->droppedReported = ring->dropped;
+    }
+
+}   /* end ResetAsyncLoggingInChild */
+
+
+
+
+/*****************************************************************************/
+/** RegisterAsyncForkHandler
+ * \ingroup intLogging
+ *
+ * \desc            Register ''ResetAsyncLoggingInChild'' with pthread_atfork.
+ *                  Called once per process.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void RegisterAsyncForkHandler(void)
+{
+    pthread_atfork(NULL, NULL, ResetAsyncLoggingInChild);
+
+}   /* end RegisterAsyncForkHandler */
+
+
+
+
 /*****************************************************************************/
 /** LogMessage
  * \ingroup intLogging
@@ -244,6 +980,40 @@ static fm_status LogMessage( fm_uint64   filteredCategoryMask,
          ( (levelMask & logLevel) == logLevel ) )
     {
 
+        /**************************************************
+         * In asynchronous mode, console and file messages
+         * are queued for the writer thread, which applies
+         * the secondary filters. Fatal messages are written
+         * out right away, after anything queued before.
+         **************************************************/
+
+        if ( LOG_INITIALIZED(ls) &&
+             FM_ATOMIC_LOAD(&logAsync.enabled) &&
+             (logType == FM_LOG_TYPE_CONSOLE || logType == FM_LOG_TYPE_FILE) )
+        {
+            status = PushAsyncRecord(categories,
+                                     logLevel,
+                                     verbosityMask,
+                                     bypassFilter,
+                                     srcFile,
+                                     srcFunction,
+                                     srcLine,
+                                     format,
+                                     ap);
+
+            if (status == FM_OK)
+            {
+                if (logLevel & FM_LOG_LEVEL_FATAL)
+                {
+                    DrainAsyncRings();
+                }
+
+                return FM_OK;
+            }
+
+            /* No ring for this thread, log synchronously */
+        }
+
         if (verbosityMask & FM_LOG_VERBOSITY_THREAD)
         {
             /* Get the thread name before taking the access lock, to avoid
@@ -285,65 +1055,7 @@ static fm_status LogMessage( fm_uint64   filteredCategoryMask,
              
             if (verbosityMask & FM_LOG_VERBOSITY_LOG_LEVEL)
             {
-                switch (logLevel)
-                {
-                    case FM_LOG_LEVEL_FUNC_ENTRY:
-                    case FM_LOG_LEVEL_FUNC_ENTRY_API:
-                    case FM_LOG_LEVEL_FUNC_ENTRY_VERBOSE:
-                    case FM_LOG_LEVEL_FUNC_ENTRY_API_VERBOSE:
-                        levelStr = "ENTRY";
-                        break;
-                        
-                    case FM_LOG_LEVEL_FUNC_EXIT:
-                    case FM_LOG_LEVEL_FUNC_EXIT_API:
-                    case FM_LOG_LEVEL_FUNC_EXIT_VERBOSE:
-                    case FM_LOG_LEVEL_FUNC_EXIT_API_VERBOSE:
-                        levelStr = "EXIT";
-                        break;
-                        
-                    case FM_LOG_LEVEL_WARNING:
-                        levelStr = "WARNING";
-                        break;
-                    
-                    case FM_LOG_LEVEL_ERROR:
-                        levelStr = "ERROR";
-                        break;
-                        
-                    case FM_LOG_LEVEL_FATAL:
-                        levelStr = "FATAL";
-                        break;
-                        
-                    case FM_LOG_LEVEL_INFO:
-                        levelStr = "INFO";
-                        break;
-                        
-                    case FM_LOG_LEVEL_DEBUG:
-                    case FM_LOG_LEVEL_DEBUG_VERBOSE:
-                        levelStr = "DEBUG";
-                        break;
-                        
-                    case FM_LOG_LEVEL_PRINT:
-                        levelStr = "PRINT";
-                        break;
-                        
-                    case FM_LOG_LEVEL_DEBUG2:
-                        levelStr = "DEBUG2";
-                        break;
-                        
-                    case FM_LOG_LEVEL_DEBUG3:
-                        levelStr = "DEBUG3";
-                        break;
-                        
-                    case FM_LOG_LEVEL_ASSERT:
-                        levelStr = "ASSERT";
-                        break;
-                        
-                    default:
-                        levelStr = "UNKNOWN_LVL";
-                        break;
-                        
-                }   /* end switch (logLevel) */
-                
+                levelStr = GetLogLevelString(logLevel);
                 FM_SNPRINTF_S(logLevelStr, sizeof(logLevelStr), "%s", levelStr);
             }
 
@@ -1071,6 +1783,103 @@ fm_status fmSetLoggingType(fm_loggingType logType,
 
 
 
+/*****************************************************************************/
+/** fmSetLoggingAsync
+ * \ingroup alosLog
+ *
+ * \desc            Enable or disable asynchronous logging for the calling
+ *                  process. When enabled, console and file log messages
+ *                  are formatted into a per-thread lock-free ring and
+ *                  written out in batches by a background writer thread,
+ *                  instead of being written by the thread generating them.
+ *                  Other logging types are not affected.
+ *                                                                      \lb\lb
+ *                  A thread whose ring is full discards its messages; the
+ *                  writer reports how many were lost, and the total is
+ *                  available through the ''FM_LOG_ATTR_ASYNC_DROPPED''
+ *                  attribute. Fatal messages are written out immediately,
+ *                  along with everything queued before them.
+ *                                                                      \lb\lb
+ *                  Disabling asynchronous logging writes out the messages
+ *                  still queued before returning.
+ *
+ * \param[in]       enable is TRUE to queue log messages, FALSE to write
+ *                  them synchronously.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNINITIALIZED if the logging subsystem has not been
+ *                  initialized.
+ * \return          FM_FAIL if the writer could not be started.
+ *
+ *****************************************************************************/
+fm_status fmSetLoggingAsync(fm_bool enable)
+{
+    fm_loggingState *ls = GET_LOGGING_STATE();
+    fm_status        err = FM_OK;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_LOGGING, "enable=%d\n", enable);
+
+    if ( !LOG_INITIALIZED(ls) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_LOGGING, FM_ERR_UNINITIALIZED);
+    }
+
+    if ( pthread_mutex_lock(&logAsync.controlLock) != 0 )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_LOGGING, FM_ERR_UNABLE_TO_LOCK);
+    }
+
+    if (enable && !logAsync.enabled)
+    {
+        pthread_once(&logAsyncForkOnce, RegisterAsyncForkHandler);
+
+        if (logAsync.wakeFd < 0)
+        {
+            logAsync.wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+            if (logAsync.wakeFd < 0)
+            {
+                FM_LOG_ERROR(FM_LOG_CAT_LOGGING,
+                             "Unable to create the log writer eventfd: %s\n",
+                             strerror(errno));
+                err = FM_FAIL;
+                goto ABORT;
+            }
+        }
+
+        logAsync.stopping = FALSE;
+
+        err = fmCreateThread("logAsyncWriter",
+                             FM_EVENT_QUEUE_SIZE_NONE,
+                             AsyncLogWriter,
+                             &logAsync,
+                             &logAsync.writer);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LOGGING, err);
+
+        FM_ATOMIC_STORE(&logAsync.enabled, TRUE);
+    }
+    else if (!enable && logAsync.enabled)
+    {
+        FM_ATOMIC_STORE(&logAsync.enabled, FALSE);
+        FM_ATOMIC_STORE(&logAsync.stopping, TRUE);
+
+        WakeAsyncWriter();
+        fmWaitThreadExit(&logAsync.writer);
+
+        /* pick up what was queued while the writer was exiting */
+        DrainAsyncRings();
+    }
+
+ABORT:
+    pthread_mutex_unlock(&logAsync.controlLock);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_LOGGING, err);
+
+}   /* end fmSetLoggingAsync */
+
+
+
+
 /*****************************************************************************/
 /** fmEnableLoggingCategory
  * \ingroup alosLog
@@ -1300,6 +2109,58 @@ fm_status fmSetLoggingFilter(fm_uint64   categoryMask,
 
 
 
+/*****************************************************************************/
+/** fmLogIsEnabled
+ * \ingroup alosLog
+ *
+ * \desc            Tells whether a log message of the given categories and
+ *                  level would currently pass the category and level
+ *                  filters. Lets callers skip building the arguments of a
+ *                  message that would be dropped anyway.
+ *
+ * \note            The function and file filters, and the per-object
+ *                  filters of the V2 macros, are not applied, so a message
+ *                  reported as enabled may still be filtered out.
+ *
+ * \param[in]       categories is a bitmask of category flags (see
+ *                  ''Log Categories'').
+ *
+ * \param[in]       logLevel is a bitmask of level flags (see
+ *                  ''Log Levels'').
+ *
+ * \return          TRUE if such a message would be logged.
+ *
+ *****************************************************************************/
+fm_bool fmLogIsEnabled(fm_uint64 categories, fm_uint64 logLevel)
+{
+    fm_loggingState *ls = GET_LOGGING_STATE();
+
+    if ( !FM_LOG_STATIC_ENABLED(categories, logLevel) )
+    {
+        return FALSE;
+    }
+
+    if (logLevel & FM_LOG_LEVEL_DEFAULT)
+    {
+        return TRUE;
+    }
+
+    if ( !LOG_INITIALIZED(ls) )
+    {
+        return ( (logLevel & (FM_LOG_LEVEL_FATAL |
+                              FM_LOG_LEVEL_ERROR |
+                              FM_LOG_LEVEL_WARNING)) == logLevel );
+    }
+
+    return ( ls->enabled &&
+             (ls->categoryMask & categories) != 0 &&
+             (ls->levelMask & logLevel) == logLevel );
+
+}   /* end fmLogIsEnabled */
+
+
+
+
 /*****************************************************************************/
 /** fmLogMessage
  * \ingroup alosLog
@@ -1623,6 +2484,30 @@ fm_status fmGetLoggingAttribute(fm_int  attr,
             fmStringCopy( (char *) value, ls->logFileName, size );
             break;
 
+        case FM_LOG_ATTR_ASYNC:
+            *( (fm_bool *) value ) = FM_ATOMIC_LOAD(&logAsync.enabled);
+            break;
+
+        case FM_LOG_ATTR_ASYNC_DROPPED:
+            {
+                fm_logAsyncRing *ring;
+                fm_uint64        dropped;
+
+                pthread_mutex_lock(&logAsync.ringLock);
+
+                dropped = logAsync.retiredDrops;
+
+                for (ring = logAsync.rings ; ring != NULL ; ring = ring->next)
+                {
+                    dropped += FM_ATOMIC_LOAD(&ring->dropped);
+                }
+
+                pthread_mutex_unlock(&logAsync.ringLock);
+
+                *( (fm_uint64 *) value ) = dropped;
+            }
+            break;
+
         default:
             err = FM_ERR_INVALID_ATTRIB;
             break;
@@ -49,6 +49,43 @@
 #define VALIDATE_LOCK_PRECEDENCE(err, lck, index, take)    \
     err = FM_OK;
 #endif
+
+#if FM_LOCK_PROFILING
+/* Starts timing a capture that has to wait. */
+#define PROF_WAIT_START(lck, waitStart)                                 \
+    if ( FM_LOCK_PROF_ACTIVE((lck)->profile) )                          \
+    {                                                                   \
+        waitStart = FM_LOCK_PROF_TSC();                                 \
+    }
+
+/* Records a capture. The hold time of a thread runs from its first
+ * capture to the release that removes it from the lock. */
+#define PROF_ACQUIRED(lck, index, waitStart, firstHold)                 \
+    if ( FM_LOCK_PROF_ACTIVE((lck)->profile) )                          \
+    {                                                                   \
+        fm_uint64 profNow = FM_LOCK_PROF_TSC();                         \
+        if (firstHold)                                                  \
+        {                                                               \
+            (lck)->userList[index].profHoldStart = profNow;             \
+        }                                                               \
+        fmLockProfRecordAcquire((lck)->profile, waitStart, profNow);    \
+    }
+
+#define PROF_RELEASED(lck, index)                                       \
+    if ( (lck)->userList[index].profHoldStart != 0 )                    \
+    {                                                                   \
+        if ( FM_LOCK_PROF_ACTIVE((lck)->profile) )                      \
+        {                                                               \
+            fmLockProfRecordRelease((lck)->profile,                     \
+                                    (lck)->userList[index].profHoldStart); \
+        }                                                               \
+        (lck)->userList[index].profHoldStart = 0;                       \
+    }
+#else
+#define PROF_WAIT_START(lck, waitStart)
+#define PROF_ACQUIRED(lck, index, waitStart, firstHold)
+#define PROF_RELEASED(lck, index)
+#endif
     
 
 /**************************************************
@@ -792,6 +829,7 @@ fm_status fmCreateRwLockV2(fm_text lockName,
     lck->numActiveWriters   = 0;
     lck->numPendingReaders  = 0;
     lck->numPendingWriters  = 0;
+    lck->profile            = NULL;
 
     if (fmCreateBitArray(&(lck->readerToBePromoted), FM_MAX_THREADS) != FM_OK)
     {
@@ -980,6 +1018,11 @@ fm_status fmCreateRwLockV2(fm_text lockName,
     lck->readHandle   = (void *) read;
     lck->writeHandle  = (void *) write;
 
+#if FM_LOCK_PROFILING
+    /* Profiling is best effort, the lock works without it. */
+    lck->profile = fmAllocLockProfile();
+#endif
+
     DBG_LIST_ADD_RW_LOCK(lck);
 
 #ifdef FM_DBG_RWL_CTR
@@ -1029,6 +1072,8 @@ fm_status fmDeleteRwLock(fm_rwLock *lck)
     fmFree(lck->userList);
     fmFree(lck->name);
     fmDeleteBitArray(&(lck->readerToBePromoted));
+    fmFreeLockProfile(lck->profile);
+    lck->profile = NULL;
 
     if ( sem_destroy( (sem_t *) lck->readHandle ) )
     {
@@ -1086,6 +1131,9 @@ fm_status fmCaptureReadLock(fm_rwLock *lck, fm_timestamp *timeout)
     int       posixError;
     char      strErrBuf[FM_STRERROR_BUF_SIZE];
     errno_t   strErrNum;
+#if FM_LOCK_PROFILING
+    fm_uint64 profWaitStart = 0;
+#endif
 
 #ifdef FM_ALOS_LOCK_FUNCTION_LOGGING   /* Performance-sensitive path */
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS_RWLOCK,
@@ -1247,6 +1295,8 @@ fm_status fmCaptureReadLock(fm_rwLock *lck, fm_timestamp *timeout)
         lck->userList[index].numReaders++;
         lck->numActiveReaders++;
 
+        PROF_ACQUIRED(lck, index, 0, TRUE);
+
         GIVE_ACCESS(lck);
 
 #ifdef FM_DBG_RWL_CTR
@@ -1277,6 +1327,8 @@ fm_status fmCaptureReadLock(fm_rwLock *lck, fm_timestamp *timeout)
 
         lck->numPendingReaders++;
 
+        PROF_WAIT_START(lck, profWaitStart);
+
 #ifdef FM_DBG_RWL_CTR
         TAKE_DBG_CTR();
         fmRootAlos->rwLockDebugCounters[FM_RWL_RD_LCK_BLOCK_WR]++;
@@ -1305,6 +1357,8 @@ fm_status fmCaptureReadLock(fm_rwLock *lck, fm_timestamp *timeout)
 
         lck->userList[index].numReaders++;
 
+        PROF_ACQUIRED(lck, index, profWaitStart, TRUE);
+
 #ifdef FM_DBG_RWL_CTR
         TAKE_DBG_CTR();
         fmRootAlos->rwLockDebugCounters[FM_RWL_RD_LCK]++;
@@ -1357,6 +1411,9 @@ fm_status fmCaptureWriteLock(fm_rwLock *lck, fm_timestamp *timeout)
     fm_int    numReaderToBePromoted = 0;
     char      strErrBuf[FM_STRERROR_BUF_SIZE];
     errno_t   strErrNum;
+#if FM_LOCK_PROFILING
+    fm_uint64 profWaitStart = 0;
+#endif
 
 #ifdef FM_ALOS_LOCK_FUNCTION_LOGGING   /* Performance-sensitive path */
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS_RWLOCK,
@@ -1528,6 +1585,8 @@ fm_status fmCaptureWriteLock(fm_rwLock *lck, fm_timestamp *timeout)
 
         lck->userList[index].numWriters++;
 
+        PROF_ACQUIRED(lck, index, 0, newThread);
+
         GIVE_ACCESS(lck);
 
 #ifdef FM_DBG_RWL_CTR
@@ -1550,12 +1609,16 @@ fm_status fmCaptureWriteLock(fm_rwLock *lck, fm_timestamp *timeout)
             lck->numActiveWriters++;
             lck->userList[index].numWriters++;
 
+            PROF_ACQUIRED(lck, index, 0, newThread);
+
             GIVE_ACCESS(lck);
         }
         else
         {
             lck->numPendingWriters++;
 
+            PROF_WAIT_START(lck, profWaitStart);
+
             GIVE_ACCESS(lck);
 
             /***************************************************
@@ -1613,6 +1676,8 @@ fm_status fmCaptureWriteLock(fm_rwLock *lck, fm_timestamp *timeout)
 
             lck->userList[index].numWriters++;
 
+            PROF_ACQUIRED(lck, index, profWaitStart, newThread);
+
             /* If a reader blocks waiting to be promoted, it is now 
                a writer. Reset the "waiting-to-be-promoted" flag. */
             fmSetBitArrayBit(&lck->readerToBePromoted, index, FALSE); 
@@ -1738,6 +1803,7 @@ fm_status fmReleaseReadLock(fm_rwLock *lck)
              * make it non-active and delete the entry from our
              * list.
              **************************************************/
+            PROF_RELEASED(lck, index);
             DEL_THREAD(lck, index);
         }
 
@@ -1959,6 +2025,7 @@ fm_status fmReleaseWriteLock(fm_rwLock *lck)
          **************************************************/
         if (lck->userList[index].numReaders == 0)
         {
+            PROF_RELEASED(lck, index);
             DEL_THREAD(lck, index);
         }
     }
@@ -37,6 +37,25 @@
  * Macros, Constants & Types
  *****************************************************************************/
 
+/* NUMA nodes addressable by api.thread.placement */
+#define THREAD_MAX_NUMA_NODES   ( (fm_int) (sizeof(unsigned long) * 8) )
+
+/* Placement of a thread, from the api.thread.placement property */
+typedef struct
+{
+    /* TRUE if cpus holds the CPU affinity */
+    fm_bool   hasCpus;
+    cpu_set_t cpus;
+
+    /* Scheduling policy and priority, -1 if not configured */
+    fm_int    policy;
+    fm_int    priority;
+
+    /* Preferred NUMA memory node, -1 if not configured */
+    fm_int    node;
+
+} fm_threadPlacement;
+
 
 /*****************************************************************************
  * Global Variables
@@ -60,11 +79,20 @@ pthread_key_t fmTLSKeyLock;
  * Local Variables
  *****************************************************************************/
 
+/* Serializes the creation of fm_threadLocal keys in this process */
+static pthread_mutex_t threadLocalLock = PTHREAD_MUTEX_INITIALIZER;
+
 
 /*****************************************************************************
  * Local function prototypes.
  *****************************************************************************/
 
+static fm_bool ParseCpuList(fm_text str, cpu_set_t *cpus);
+static fm_bool GetThreadPlacement(fm_text             threadName,
+                                  fm_threadPlacement *placement);
+static void ApplyThreadPlacement(fm_thread *thread);
+static void *ThreadStart(void *args);
+
 
 /*****************************************************************************
  * Local Functions
@@ -177,6 +205,337 @@ static fm_status fmGetThreadStateCopy(pthread_t handle, fm_thread *thread)
 
 
 
+/*****************************************************************************/
+/** ParseCpuList
+ * \ingroup intAlosTask
+ *
+ * \desc            Parse a list of CPU numbers and ranges such as "0-3,6".
+ *
+ * \param[in]       str is the list.
+ *
+ * \param[out]      cpus points to caller-allocated storage where this
+ *                  function places the CPU set.
+ *
+ * \return          TRUE if the list is valid, FALSE otherwise.
+ *
+ *****************************************************************************/
+static fm_bool ParseCpuList(fm_text str, cpu_set_t *cpus)
+{
+    char *end;
+    long  first;
+    long  last;
+
+    CPU_ZERO(cpus);
+
+    while (*str != '\0')
+    {
+        first = strtol(str, &end, 10);
+
+        if (end == str || first < 0 || first >= CPU_SETSIZE)
+        {
+            return FALSE;
+        }
+
+        last = first;
+        str  = end;
+
+        if (*str == '-')
+        {
+            last = strtol(str + 1, &end, 10);
+
+            if (end == str + 1 || last < first || last >= CPU_SETSIZE)
+            {
+                return FALSE;
+            }
+
+            str = end;
+        }
+
+        while (first <= last)
+        {
+            CPU_SET(first, cpus);
+            first++;
+        }
+
+        if (*str == ',')
+        {
+            str++;
+        }
+        else if (*str != '\0')
+        {
+            return FALSE;
+        }
+    }
+
+    return (CPU_COUNT(cpus) > 0);
+
+}   /* end ParseCpuList */
+
+
+
+
+/*****************************************************************************/
+/** GetThreadPlacement
+ * \ingroup intAlosTask
+ *
+ * \desc            Look up the placement of a thread in the
+ *                  api.thread.placement property.
+ *
+ * \param[in]       threadName is the name of the thread.
+ *
+ * \param[out]      placement points to caller-allocated storage where this
+ *                  function places the placement of the thread.
+ *
+ * \return          TRUE if the thread is listed in the property.
+ *
+ *****************************************************************************/
+static fm_bool GetThreadPlacement(fm_text             threadName,
+                                  fm_threadPlacement *placement)
+{
+    char    buffer[sizeof(GET_PROPERTY()->threadPlacement)];
+    char *  entry;
+    char *  entryEnd;
+    char *  setting;
+    char *  settingEnd;
+    char *  name;
+    char *  colon;
+    char *  end;
+    fm_int  i;
+    fm_bool found;
+
+    placement->hasCpus  = FALSE;
+    placement->policy   = -1;
+    placement->priority = -1;
+    placement->node     = -1;
+
+    if (threadName == NULL)
+    {
+        return FALSE;
+    }
+
+    FM_STRNCPY_S(buffer,
+                 sizeof(buffer),
+                 GET_PROPERTY()->threadPlacement,
+                 sizeof(buffer) - 1);
+
+    found = FALSE;
+
+    for (entry = strtok_r(buffer, ";", &entryEnd) ;
+         entry != NULL && !found ;
+         entry = strtok_r(NULL, ";", &entryEnd))
+    {
+        colon = strchr(entry, ':');
+
+        if (colon == NULL)
+        {
+            continue;
+        }
+
+        *colon = '\0';
+
+        /* Trim blanks and quotes around the thread name. */
+        name = entry;
+
+        while (*name == ' ' || *name == '\t' || *name == '"')
+        {
+            name++;
+        }
+
+        for (i = strlen(name) - 1 ;
+             i >= 0 && (name[i] == ' ' || name[i] == '\t') ;
+             i--)
+        {
+            name[i] = '\0';
+        }
+
+        if (strcmp(name, threadName) != 0)
+        {
+            continue;
+        }
+
+        found = TRUE;
+
+        for (setting = strtok_r(colon + 1, " \t\"", &settingEnd) ;
+             setting != NULL ;
+             setting = strtok_r(NULL, " \t\"", &settingEnd))
+        {
+            if (strncmp(setting, "cpus=", 5) == 0)
+            {
+                placement->hasCpus = ParseCpuList(setting + 5, &placement->cpus);
+
+                if (!placement->hasCpus)
+                {
+                    FM_LOG_WARNING(FM_LOG_CAT_ALOS_THREAD,
+                                   "Thread '%s': invalid CPU list '%s'\n",
+                                   threadName,
+                                   setting + 5);
+                }
+            }
+            else if (strcmp(setting, "sched=fifo") == 0)
+            {
+                placement->policy = SCHED_FIFO;
+            }
+            else if (strcmp(setting, "sched=rr") == 0)
+            {
+                placement->policy = SCHED_RR;
+            }
+            else if (strcmp(setting, "sched=other") == 0)
+            {
+                placement->policy = SCHED_OTHER;
+            }
+            else if (strncmp(setting, "priority=", 9) == 0)
+            {
+                placement->priority = strtol(setting + 9, &end, 10);
+
+                if (*end != '\0')
+                {
+                    placement->priority = -1;
+                }
+            }
+            else if (strncmp(setting, "node=", 5) == 0)
+            {
+                placement->node = strtol(setting + 5, &end, 10);
+
+                if (*end != '\0' || placement->node >= THREAD_MAX_NUMA_NODES)
+                {
+                    placement->node = -1;
+                }
+            }
+            else
+            {
+                FM_LOG_WARNING(FM_LOG_CAT_ALOS_THREAD,
+                               "Thread '%s': unknown placement setting '%s'\n",
+                               threadName,
+                               setting);
+            }
+        }
+    }
+
+    return found;
+
+}   /* end GetThreadPlacement */
+
+
+
+
+/*****************************************************************************/
+/** ApplyThreadPlacement
+ * \ingroup intAlosTask
+ *
+ * \desc            Apply the placement configured for the calling thread.
+ *                  Failures are logged and otherwise ignored, so that a
+ *                  thread still runs if, for example, the process lacks
+ *                  the privilege to use a real-time scheduling policy.
+ *
+ * \param[in]       thread points to the calling thread's state.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ApplyThreadPlacement(fm_thread *thread)
+{
+    fm_threadPlacement placement;
+    struct sched_param param;
+    unsigned long      nodeMask;
+    int                posixError;
+
+    if ( !GetThreadPlacement(thread->name, &placement) )
+    {
+        return;
+    }
+
+    if (placement.hasCpus)
+    {
+        posixError = pthread_setaffinity_np(pthread_self(),
+                                            sizeof(placement.cpus),
+                                            &placement.cpus);
+        if (posixError != 0)
+        {
+            FM_LOG_WARNING(FM_LOG_CAT_ALOS_THREAD,
+                           "Thread '%s': unable to set CPU affinity (%d)\n",
+                           thread->name,
+                           posixError);
+        }
+    }
+
+    if (placement.policy >= 0)
+    {
+        param.sched_priority = placement.priority;
+
+        if (placement.policy == SCHED_OTHER)
+        {
+            param.sched_priority = 0;
+        }
+        else if (placement.priority < 0)
+        {
+            param.sched_priority = sched_get_priority_min(placement.policy);
+        }
+
+        posixError = pthread_setschedparam(pthread_self(),
+                                           placement.policy,
+                                           &param);
+        if (posixError != 0)
+        {
+            FM_LOG_WARNING(FM_LOG_CAT_ALOS_THREAD,
+                           "Thread '%s': unable to set scheduling policy "
+                           "%d priority %d (%d)\n",
+                           thread->name,
+                           placement.policy,
+                           param.sched_priority,
+                           posixError);
+        }
+    }
+
+    if (placement.node >= 0)
+    {
+        /* The memory policy is per thread and can only be set by the
+         * thread itself. */
+        nodeMask = 1UL << placement.node;
+
+        if ( syscall(SYS_set_mempolicy,
+                     MPOL_PREFERRED,
+                     &nodeMask,
+                     THREAD_MAX_NUMA_NODES + 1) != 0 )
+        {
+            FM_LOG_WARNING(FM_LOG_CAT_ALOS_THREAD,
+                           "Thread '%s': unable to prefer memory node %d "
+                           "(%d)\n",
+                           thread->name,
+                           placement.node,
+                           errno);
+        }
+    }
+
+}   /* end ApplyThreadPlacement */
+
+
+
+
+/*****************************************************************************/
+/** ThreadStart
+ * \ingroup intAlosTask
+ *
+ * \desc            Entry point of threads created with fmCreateThreadV2.
+ *                  Applies the thread's placement, then calls its body.
+ *
+ * \param[in]       args is the thread's argument array.
+ *
+ * \return          The value returned by the thread's body.
+ *
+ *****************************************************************************/
+static void *ThreadStart(void *args)
+{
+    fm_thread *thread = FM_GET_THREAD_HANDLE(args);
+
+    ApplyThreadPlacement(thread);
+
+    return thread->threadFunc(args);
+
+}   /* end ThreadStart */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -284,6 +643,66 @@ fm_status fmCreateThread(fm_text       threadName,
                          fm_threadBody threadFunc,
                          void *        threadArg,
                          fm_thread *   thread)
+{
+    return fmCreateThreadV2(threadName,
+                            eventQueueSize,
+                            0,
+                            threadFunc,
+                            threadArg,
+                            thread);
+
+}   /* end fmCreateThread */
+
+
+
+
+/*****************************************************************************/
+/** fmCreateThreadV2
+ * \ingroup alosTask
+ *
+ * \desc            Create a thread, choosing the kind of its event queue.
+ *
+ * \note            Threads are never completely cleaned up.  (Even if you
+ *                  call fmExitThread.)  Therefore, threads should be
+ *                  created on startup and live forever.  Constantly
+ *                  creating new threads will result in a memory leak.
+ *
+ * \param[in]       threadName is a text string used to identify the thread.
+ *                  This string is used for diagnostic purposes only.
+ *
+ * \param[in]       eventQueueSize is the number of event messages that can
+ *                  be held by the thread's event queue.
+ *
+ * \param[in]       eventQueueFlags is a bit mask of FM_EVENT_QUEUE_FLAG_XXX
+ *                  values, see ''fmEventQueueInitializeV2''.
+ *
+ * \param[in]       threadFunc is a pointer to the thread's entry point
+ *                  function.
+ *
+ * \param[in]       threadArg is an argument that will be passed to the
+ *                  thread's entry point function.
+ *
+ * \param[out]      thread points to the caller-allocated fm_thread structure.
+ *                  The structure will be filled in by this function. The
+ *                  API uses this structure to maintain housekeeping information
+ *                  for the thread; the application need never be concerned
+ *                  with its contents.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if thread does not point to a
+ *                  fm_thread structure.
+ * \return          FM_ERR_NO_MEM if unable to allocate memory for the thread.
+ * \return          FM_FAIL if unable to create a lock for the thread.
+ * \return          FM_ERR_UNABLE_TO_CREATE_THREAD if operating system thread
+ *                  creation failed.
+ *
+ *****************************************************************************/
+fm_status fmCreateThreadV2(fm_text       threadName,
+                           fm_int        eventQueueSize,
+                           fm_uint       eventQueueFlags,
+                           fm_threadBody threadFunc,
+                           void *        threadArg,
+                           fm_thread *   thread)
 {
     fm_status           err;
     pthread_attr_t      threadAttributes;
@@ -336,7 +755,7 @@ fm_status fmCreateThread(fm_text       threadName,
     lockNamePtr = (lockNameBuf[0]) ? lockNameBuf : threadName;
 
     /* create waiting lock */
-    err = fmCreateLock(lockNamePtr, &thread->waiter);
+    err = fmCreateCondLock(lockNamePtr, &thread->waiter);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ALOS_THREAD, err);
     lockInit = TRUE;
 
@@ -344,13 +763,17 @@ fm_status fmCreateThread(fm_text       threadName,
     lockNamePtr = (lockNameBuf[0]) ? lockNameBuf : threadName;
 
     /* set up the event queue */
-    err = fmEventQueueInitialize(&thread->events, eventQueueSize, lockNamePtr);
+    err = fmEventQueueInitializeV2(&thread->events,
+                                   eventQueueSize,
+                                   lockNamePtr,
+                                   eventQueueFlags);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ALOS_THREAD, err);
     queueInit = TRUE;
 
     /* setup arguments */
     thread->arguments[0] = thread;
     thread->arguments[1] = threadArg;
+    thread->threadFunc   = threadFunc;
 
     /* Make the conditional variable process shared. */
     if ( pthread_condattr_init(&attr) != 0 )
@@ -423,7 +846,7 @@ fm_status fmCreateThread(fm_text       threadName,
     {
         posixError = pthread_create( (pthread_t *) thread->handle,
                                      &threadAttributes,
-                                     threadFunc,
+                                     ThreadStart,
                                      thread->arguments );
     }
 
@@ -526,7 +949,7 @@ ABORT:
 
     FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, err);
 
-}   /* end fmCreateThread */
+}   /* end fmCreateThreadV2 */
 
 
 
@@ -737,6 +1160,183 @@ fm_status fmDbgUnregisterThread(void)
 
 
 
+/*****************************************************************************/
+/** fmDbgDumpThreadPlacement
+ * \ingroup diagMisc
+ *
+ * \desc            Display the CPU affinity and scheduling policy of every
+ *                  thread known to ALOS in the calling process, as reported
+ *                  by the operating system, along with the NUMA memory node
+ *                  configured by the api.thread.placement property.
+ *
+ * \param           None.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNINITIALIZED if ALOS is not initialized.
+ * \return          FM_ERR_NO_MEM if memory allocation error.
+ * \return          FM_FAIL if the thread list could not be locked.
+ *
+ *****************************************************************************/
+fm_status fmDbgDumpThreadPlacement(void)
+{
+    fm_treeIterator    it;
+    fm_uint64          key;
+    fm_thread *        thread;
+    pthread_t *        handles;
+    fm_text *          names;
+    fm_int             numThreads;
+    fm_int             i;
+    fm_int             cpu;
+    fm_int             last;
+    fm_int             len;
+    int                policy;
+    struct sched_param param;
+    cpu_set_t          cpus;
+    fm_threadPlacement placement;
+    const char *       policyStr;
+    char               cpuStr[128];
+    char               nodeStr[16];
+
+    if (!fmAlosThreadState.initialized)
+    {
+        return FM_ERR_UNINITIALIZED;
+    }
+
+    /**************************************************
+     * Copy the thread list, since logging looks up the
+     * thread name under the same lock.
+     **************************************************/
+
+    if (pthread_mutex_lock(&fmAlosThreadState.threadTreeLock) != 0)
+    {
+        return FM_FAIL;
+    }
+
+    numThreads = fmTreeSize(&fmAlosThreadState.dbgThreadTree);
+    handles    = malloc( (numThreads + 1) * sizeof(pthread_t) );
+    names      = malloc( (numThreads + 1) * sizeof(fm_text) );
+
+    if (handles == NULL || names == NULL)
+    {
+        pthread_mutex_unlock(&fmAlosThreadState.threadTreeLock);
+        free(handles);
+        free(names);
+        return FM_ERR_NO_MEM;
+    }
+
+    i = 0;
+
+    fmTreeIterInit(&it, &fmAlosThreadState.dbgThreadTree);
+
+    while ( i < numThreads &&
+            fmTreeIterNext(&it, &key, (void **) &thread) == FM_OK )
+    {
+        handles[i] = (pthread_t) key;
+        names[i]   = thread->name;
+        i++;
+    }
+
+    numThreads = i;
+
+    pthread_mutex_unlock(&fmAlosThreadState.threadTreeLock);
+
+    FM_LOG_PRINT("%-32s %-6s %4s %4s  %s\n",
+                 "Thread", "Policy", "Prio", "Node", "CPUs");
+
+    for (i = 0 ; i < numThreads ; i++)
+    {
+        policyStr = "?";
+        param.sched_priority = 0;
+
+        if (pthread_getschedparam(handles[i], &policy, &param) == 0)
+        {
+            switch (policy)
+            {
+                case SCHED_FIFO:
+                    policyStr = "fifo";
+                    break;
+
+                case SCHED_RR:
+                    policyStr = "rr";
+                    break;
+
+                default:
+                    policyStr = "other";
+                    break;
+            }
+        }
+
+        /* Format the affinity as a list of ranges. */
+        FM_SNPRINTF_S(cpuStr, sizeof(cpuStr), "?");
+
+        if (pthread_getaffinity_np(handles[i], sizeof(cpus), &cpus) == 0)
+        {
+            len       = 0;
+            cpuStr[0] = '\0';
+
+            for (cpu = 0 ; cpu < CPU_SETSIZE ; cpu++)
+            {
+                if ( !CPU_ISSET(cpu, &cpus) )
+                {
+                    continue;
+                }
+
+                for (last = cpu ;
+                     last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, &cpus) ;
+                     last++)
+                {
+                }
+
+                if (len < (fm_int) sizeof(cpuStr))
+                {
+                    if (last > cpu)
+                    {
+                        len += FM_SNPRINTF_S(cpuStr + len,
+                                             sizeof(cpuStr) - len,
+                                             "%s%d-%d",
+                                             len ? "," : "",
+                                             cpu,
+                                             last);
+                    }
+                    else
+                    {
+                        len += FM_SNPRINTF_S(cpuStr + len,
+                                             sizeof(cpuStr) - len,
+                                             "%s%d",
+                                             len ? "," : "",
+                                             cpu);
+                    }
+                }
+
+                cpu = last;
+            }
+        }
+
+        FM_SNPRINTF_S(nodeStr, sizeof(nodeStr), "-");
+
+        if ( GetThreadPlacement(names[i], &placement) && placement.node >= 0 )
+        {
+            FM_SNPRINTF_S(nodeStr, sizeof(nodeStr), "%d", placement.node);
+        }
+
+        FM_LOG_PRINT("%-32s %-6s %4d %4s  %s\n",
+                     (names[i] != NULL) ? names[i] : "<unnamed>",
+                     policyStr,
+                     param.sched_priority,
+                     nodeStr,
+                     cpuStr);
+    }
+
+    free(handles);
+    free(names);
+
+    return FM_OK;
+
+}   /* end fmDbgDumpThreadPlacement */
+
+
+
+
 /*****************************************************************************/
 /** fmSendThreadEvent
  * \ingroup alosTask
@@ -800,73 +1400,213 @@ fm_status fmSendThreadEvent(fm_thread *thread,
         err = FM_OK;
     }
 
-    i = pthread_mutex_unlock( (pthread_mutex_t *) thread->waiter.handle );
-    if (i != 0)
+    i = pthread_mutex_unlock( (pthread_mutex_t *) thread->waiter.handle );
+    if (i != 0)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ALOS_THREAD,
+                     "Error %d from pthread_mutex_unlock\n",
+                     i);
+        if (err == FM_OK)
+        {
+            err = FM_ERR_UNABLE_TO_UNLOCK;
+        }
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, err);
+
+}   /* end fmSendThreadEvent */
+
+
+
+
+/*****************************************************************************/
+/** fmSendThreadEventBatch
+ * \ingroup alosTask
+ *
+ * \desc            Send several events to a thread at once, waking it up a
+ *                  single time.
+ *
+ * \param[in]       thread points to the target thread's associated fm_thread
+ *                  structure that was filled in by ''fmCreateThread''.
+ *
+ * \param[in]       numEvents is the number of entries in events.
+ *
+ * \param[in]       events points to an array of caller-allocated events to
+ *                  be sent to the thread, in order.
+ *
+ * \param[out]      numSent points to caller-allocated storage where this
+ *                  function should place the number of events sent, which
+ *                  are the first ones of events. The caller still owns the
+ *                  others.
+ *
+ * \return          FM_OK if all the events were sent.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_EVENT_QUEUE_FULL if the thread's event queue
+ *                  filled up before all the events were sent.
+ * \return          FM_ERR_UNABLE_TO_LOCK if unable to access the thread's
+ *                  event queue.
+ *
+ *****************************************************************************/
+fm_status fmSendThreadEventBatch(fm_thread *thread,
+                                 fm_int     numEvents,
+                                 fm_event **events,
+                                 fm_int *   numSent)
+{
+    int       i;
+    fm_status err;
+    fm_status err2;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS_THREAD,
+                 "thread=%p numEvents=%d events=%p\n",
+                 (void *) thread,
+                 numEvents,
+                 (void *) events);
+
+    if (!thread || !events || !numSent || (numEvents < 0) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    /* Put events on thread's event queue. */
+    err = fmEventQueueAddMultiple(&thread->events, numEvents, events, numSent);
+
+    if (*numSent == 0)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, err);
+    }
+
+    /* Lock before calling pthread_cond_signal */
+    i = pthread_mutex_lock( (pthread_mutex_t *) thread->waiter.handle );
+    if (i != 0)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ALOS_THREAD,
+                     "Error %d from pthread_mutex_lock\n",
+                     i);
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, FM_ERR_UNABLE_TO_LOCK);
+    }
+
+    err2 = pthread_cond_signal(thread->cond) ? FM_ERR_UNABLE_TO_SIGNAL_COND :
+                                               FM_OK;
+
+    i = pthread_mutex_unlock( (pthread_mutex_t *) thread->waiter.handle );
+    if (i != 0)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ALOS_THREAD,
+                     "Error %d from pthread_mutex_unlock\n",
+                     i);
+        if (err2 == FM_OK)
+        {
+            err2 = FM_ERR_UNABLE_TO_UNLOCK;
+        }
+    }
+
+    if (err == FM_OK)
+    {
+        err = err2;
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, err);
+
+}   /* end fmSendThreadEventBatch */
+
+
+
+
+/*****************************************************************************/
+/** GetQueuedEvents
+ * \ingroup intAlosTask
+ *
+ * \desc            Pulls up to maxEvents events from the head of a thread's
+ *                  event queue, without waiting.
+ *
+ * \param[in]       thread points to the thread's fm_thread structure.
+ *
+ * \param[in]       maxEvents is the number of entries in events, or 0 to
+ *                  only check whether the queue holds events.
+ *
+ * \param[out]      events points to where the events are placed.
+ *
+ * \param[out]      numEvents points to where the number of events placed in
+ *                  events is returned, or the number of events in the
+ *                  queue if maxEvents is 0.
+ *
+ * \return          FM_OK if at least one event was pulled.
+ * \return          FM_ERR_NO_EVENTS_AVAILABLE if the queue is empty.
+ *
+ *****************************************************************************/
+static fm_status GetQueuedEvents(fm_thread *thread,
+                                 fm_int     maxEvents,
+                                 fm_event **events,
+                                 fm_int *   numEvents)
+{
+    fm_status err;
+
+    if (maxEvents == 0)
+    {
+        /* Only check whether an event is available */
+        err = fmEventQueueCount(&thread->events, numEvents);
+
+        if ( (err == FM_OK) && (*numEvents == 0) )
+        {
+            err = FM_ERR_NO_EVENTS_AVAILABLE;
+        }
+
+        return err;
+    }
+
+    if (maxEvents == 1)
     {
-        FM_LOG_ERROR(FM_LOG_CAT_ALOS_THREAD,
-                     "Error %d from pthread_mutex_unlock\n",
-                     i);
-        if (err == FM_OK)
-        {
-            err = FM_ERR_UNABLE_TO_UNLOCK;
-        }
+        err        = fmEventQueueGet(&thread->events, events);
+        *numEvents = (err == FM_OK) ? 1 : 0;
+
+        return err;
     }
 
-    FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, err);
+    return fmEventQueueGetMultiple(&thread->events,
+                                   maxEvents,
+                                   events,
+                                   numEvents);
 
-}   /* end fmSendThreadEvent */
+}   /* end GetQueuedEvents */
 
 
 
 
 /*****************************************************************************/
-/** fmGetThreadEvent
- * \ingroup alosTask
+/** WaitThreadEvents
+ * \ingroup intAlosTask
  *
- * \desc            Called by a thread to pull the event at the head of its
- *                  event queue.  If the queue is empty, this function will
- *                  block until an event becomes available.
+ * \desc            Pulls up to maxEvents events from the head of a thread's
+ *                  event queue, blocking until one is available or the
+ *                  timeout expires. See ''fmGetThreadEvent''.
  *
- * \param[in]       thread points to the thread's associated fm_thread
- *                  structure that was filled in by ''fmCreateThread''.
+ * \param[in]       thread points to the thread's fm_thread structure.
  *
- * \param[out]      eventPtr points to caller-allocated storage where this
- *                  function should place the address of the event pulled
- *                  from the queue. The caller must deallocate a successfully
- *                  retrieved event when it is done processing the event.
+ * \param[in]       maxEvents is the number of entries in events.
  *
- * \param[in]       timeout points to an ''fm_timestamp'' structure that
- *                  contains the time (in seconds/microseconds) to wait for
- *                  an event before giving up. If timeout is FM_WAIT_FOREVER
- *                  (NULL), this function will block until an event is
- *                  available without timing out. If timeout points to a
- *                  structure that indicates zero seconds/microseconds, this
- *                  function will return without waiting for an event if none
- *                  are currently available.
+ * \param[out]      events points to where the events are placed.
  *
- * \return          FM_OK if successful (an event was received).
- * \return          FM_ERR_INVALID_ARGUMENT if thread or eventPtr are invalid.
+ * \param[out]      numEvents points to where the number of events placed in
+ *                  events is returned.
+ *
+ * \param[in]       timeout is the time to wait, or FM_WAIT_FOREVER.
+ *
+ * \return          FM_OK if at least one event was pulled.
  * \return          FM_ERR_NO_EVENTS_AVAILABLE if timeout expired.
  * \return          FM_ERR_UNABLE_TO_LOCK if unable to access thread's queue.
  *
  *****************************************************************************/
-fm_status fmGetThreadEvent(fm_thread *   thread,
-                           fm_event **   eventPtr,
-                           fm_timestamp *timeout)
+static fm_status WaitThreadEvents(fm_thread *   thread,
+                                  fm_int        maxEvents,
+                                  fm_event **   events,
+                                  fm_int *      numEvents,
+                                  fm_timestamp *timeout)
 {
     fm_status       err;
     fm_timestamp    ct;
     struct timespec ts;
     int             i;
 
-    FM_LOG_ENTRY(FM_LOG_CAT_ALOS_THREAD, "thread=%p event=%p timeout=%p\n",
-                 (void *) thread, (void *) eventPtr, (void *) timeout);
-
-    if (!thread || !eventPtr)
-    {
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, FM_ERR_INVALID_ARGUMENT);
-    }
-
     /***************************************************
      * We use this mutex to protect the condition variable.
      * Since we can't guarantee that signal state caches
@@ -879,10 +1619,10 @@ fm_status fmGetThreadEvent(fm_thread *   thread,
         FM_LOG_ERROR(FM_LOG_CAT_ALOS_THREAD,
                      "Error %d from pthread_mutex_lock\n",
                      i);
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, FM_ERR_UNABLE_TO_LOCK);
+        return FM_ERR_UNABLE_TO_LOCK;
     }
 
-    err = fmEventQueueGet(&thread->events, eventPtr);
+    err = GetQueuedEvents(thread, maxEvents, events, numEvents);
 
     /* If there was an event then just return.
      * Otherwise return the error, if there was one, and
@@ -899,7 +1639,7 @@ fm_status fmGetThreadEvent(fm_thread *   thread,
                          i);
         }
 
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, FM_OK);
+        return FM_OK;
     }
 
     if (err != FM_ERR_NO_EVENTS_AVAILABLE)
@@ -913,7 +1653,7 @@ fm_status fmGetThreadEvent(fm_thread *   thread,
                          i);
         }
 
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, err);
+        return err;
     }
 
     if (timeout == FM_WAIT_FOREVER)
@@ -942,7 +1682,7 @@ fm_status fmGetThreadEvent(fm_thread *   thread,
                              i);
             }
 
-            FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, FM_ERR_NO_EVENTS_AVAILABLE);
+            return FM_ERR_NO_EVENTS_AVAILABLE;
         }
         else
         {
@@ -988,13 +1728,175 @@ fm_status fmGetThreadEvent(fm_thread *   thread,
     }
 
     /* Now try getting the next event. Return error regardless of type. */
-    return fmEventQueueGet(&thread->events, eventPtr);
+    return GetQueuedEvents(thread, maxEvents, events, numEvents);
+
+}   /* end WaitThreadEvents */
+
+
+
+
+
+
+
+
+
+/*****************************************************************************/
+/** fmGetThreadEvent
+ * \ingroup alosTask
+ *
+ * \desc            Called by a thread to pull the event at the head of its
+ *                  event queue.  If the queue is empty, this function will
+ *                  block until an event becomes available.
+ *
+ * \param[in]       thread points to the thread's associated fm_thread
+ *                  structure that was filled in by ''fmCreateThread''.
+ *
+ * \param[out]      eventPtr points to caller-allocated storage where this
+ *                  function should place the address of the event pulled
+ *                  from the queue. The caller must deallocate a successfully
+ *                  retrieved event when it is done processing the event.
+ *
+ * \param[in]       timeout points to an ''fm_timestamp'' structure that
+ *                  contains the time (in seconds/microseconds) to wait for
+ *                  an event before giving up. If timeout is FM_WAIT_FOREVER
+ *                  (NULL), this function will block until an event is
+ *                  available without timing out. If timeout points to a
+ *                  structure that indicates zero seconds/microseconds, this
+ *                  function will return without waiting for an event if none
+ *                  are currently available.
+ *
+ * \return          FM_OK if successful (an event was received).
+ * \return          FM_ERR_INVALID_ARGUMENT if thread or eventPtr are invalid.
+ * \return          FM_ERR_NO_EVENTS_AVAILABLE if timeout expired.
+ * \return          FM_ERR_UNABLE_TO_LOCK if unable to access thread's queue.
+ *
+ *****************************************************************************/
+fm_status fmGetThreadEvent(fm_thread *   thread,
+                           fm_event **   eventPtr,
+                           fm_timestamp *timeout)
+{
+    fm_status err;
+    fm_int    numEvents;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS_THREAD, "thread=%p event=%p timeout=%p\n",
+                 (void *) thread, (void *) eventPtr, (void *) timeout);
+
+    if (!thread || !eventPtr)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    err = WaitThreadEvents(thread, 1, eventPtr, &numEvents, timeout);
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, err);
 
 }   /* end fmGetThreadEvent */
 
 
 
 
+/*****************************************************************************/
+/** fmGetThreadEventBatch
+ * \ingroup alosTask
+ *
+ * \desc            Called by a thread to pull up to maxEvents events from
+ *                  the head of its event queue at once. If the queue is
+ *                  empty, this function will block until an event becomes
+ *                  available, like ''fmGetThreadEvent''.
+ *
+ * \param[in]       thread points to the thread's associated fm_thread
+ *                  structure that was filled in by ''fmCreateThread''.
+ *
+ * \param[in]       maxEvents is the number of entries in events.
+ *
+ * \param[out]      events points to a caller-allocated array of maxEvents
+ *                  entries where this function should place the addresses
+ *                  of the events pulled from the queue, in queue order.
+ *                  The caller must deallocate each of them.
+ *
+ * \param[out]      numEvents points to caller-allocated storage where this
+ *                  function should place the number of events pulled.
+ *
+ * \param[in]       timeout is as for ''fmGetThreadEvent''.
+ *
+ * \return          FM_OK if successful (at least one event was received).
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_NO_EVENTS_AVAILABLE if timeout expired.
+ * \return          FM_ERR_UNABLE_TO_LOCK if unable to access thread's queue.
+ *
+ *****************************************************************************/
+fm_status fmGetThreadEventBatch(fm_thread *   thread,
+                                fm_int        maxEvents,
+                                fm_event **   events,
+                                fm_int *      numEvents,
+                                fm_timestamp *timeout)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS_THREAD,
+                 "thread=%p maxEvents=%d events=%p timeout=%p\n",
+                 (void *) thread,
+                 maxEvents,
+                 (void *) events,
+                 (void *) timeout);
+
+    if (!thread || !events || !numEvents || (maxEvents <= 0) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    *numEvents = 0;
+
+    err = WaitThreadEvents(thread, maxEvents, events, numEvents, timeout);
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, err);
+
+}   /* end fmGetThreadEventBatch */
+
+
+
+
+/*****************************************************************************/
+/** fmWaitForThreadEvent
+ * \ingroup alosTask
+ *
+ * \desc            Called to wait until a thread's event queue holds an
+ *                  event, without pulling it. See ''fmGetThreadEvent'' for
+ *                  the timeout.
+ *
+ * \param[in]       thread points to the thread's associated fm_thread
+ *                  structure that was filled in by ''fmCreateThread''.
+ *
+ * \param[in]       timeout is as for ''fmGetThreadEvent''.
+ *
+ * \return          FM_OK if the queue holds an event.
+ * \return          FM_ERR_INVALID_ARGUMENT if thread is invalid.
+ * \return          FM_ERR_NO_EVENTS_AVAILABLE if timeout expired.
+ * \return          FM_ERR_UNABLE_TO_LOCK if unable to access thread's queue.
+ *
+ *****************************************************************************/
+fm_status fmWaitForThreadEvent(fm_thread *thread, fm_timestamp *timeout)
+{
+    fm_status err;
+    fm_int    numEvents;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS_THREAD, "thread=%p timeout=%p\n",
+                 (void *) thread, (void *) timeout);
+
+    if (!thread)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    err = WaitThreadEvents(thread, 0, NULL, &numEvents, timeout);
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS_THREAD, err);
+
+}   /* end fmWaitForThreadEvent */
+
+
+
+
 /*****************************************************************************/
 /** fmPeekThreadEvent
  * \ingroup intAlosTask
@@ -1149,6 +2051,55 @@ fm_status fmWaitThreadExit(fm_thread *thread)
 
 
 
+
+/*****************************************************************************/
+/** fmGetThreadCpuTime
+ * \ingroup alosTask
+ *
+ * \desc            Returns the CPU time consumed so far by a thread.
+ *
+ * \param[in]       thread points to the thread's associated fm_thread
+ *                  structure that was filled in by ''fmCreateThread''.
+ *
+ * \param[out]      nsec points to caller-allocated storage where the CPU
+ *                  time, in nanoseconds, is written.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is NULL or the
+ *                  thread was never started.
+ * \return          FM_FAIL if the operating system cannot report the
+ *                  CPU time of the thread.
+ *
+ *****************************************************************************/
+fm_status fmGetThreadCpuTime(fm_thread *thread, fm_uint64 *nsec)
+{
+    clockid_t       clockId;
+    struct timespec ts;
+
+    if (thread == NULL || thread->handle == NULL || nsec == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    if ( pthread_getcpuclockid(*( (pthread_t *) thread->handle ),
+                               &clockId) != 0 )
+    {
+        return FM_FAIL;
+    }
+
+    if (clock_gettime(clockId, &ts) != 0)
+    {
+        return FM_FAIL;
+    }
+
+    *nsec = (fm_uint64) ts.tv_sec * 1000000000ULL + (fm_uint64) ts.tv_nsec;
+
+    return FM_OK;
+
+}   /* end fmGetThreadCpuTime */
+
+
+
 /*****************************************************************************/
 /** fmGetCurrentProcessId
  * \ingroup alosTask
@@ -1621,4 +2572,99 @@ fm_status fmAddForeignThreadToList(fm_text threadName,
 
 
 
+/*****************************************************************************/
+/** CreateThreadLocalKey
+ * \ingroup intAlosTask
+ *
+ * \desc            Creates the operating system key of a thread-local
+ *                  variable on its first use in the process.
+ *
+ * \param[in]       var points to the thread-local variable.
+ *
+ * \return          TRUE if the key is usable.
+ *
+ *****************************************************************************/
+static fm_bool CreateThreadLocalKey(fm_threadLocal *var)
+{
+    pthread_key_t key;
+
+    if ( FM_ATOMIC_LOAD(&var->created) )
+    {
+        return var->valid;
+    }
+
+    pthread_mutex_lock(&threadLocalLock);
+
+    if (!var->created)
+    {
+        if (pthread_key_create(&key, var->destructor) == 0)
+        {
+            var->key   = (fm_uint) key;
+            var->valid = TRUE;
+        }
+
+        FM_ATOMIC_STORE(&var->created, TRUE);
+    }
+
+    pthread_mutex_unlock(&threadLocalLock);
+
+    return var->valid;
+
+}   /* end CreateThreadLocalKey */
+
+
+
+
+/*****************************************************************************/
+/** fmGetThreadLocal
+ * \ingroup intAlosTask
+ *
+ * \desc            Returns the calling thread's value of a thread-local
+ *                  variable.
+ *
+ * \param[in]       var points to the thread-local variable.
+ *
+ * \return          The value, NULL if the thread has not set one.
+ *
+ *****************************************************************************/
+void *fmGetThreadLocal(fm_threadLocal *var)
+{
+    if ( !CreateThreadLocalKey(var) )
+    {
+        return NULL;
+    }
+
+    return pthread_getspecific( (pthread_key_t) var->key );
+
+}   /* end fmGetThreadLocal */
+
+
+
+
+/*****************************************************************************/
+/** fmSetThreadLocal
+ * \ingroup intAlosTask
+ *
+ * \desc            Sets the calling thread's value of a thread-local
+ *                  variable. The variable's destructor is called with a
+ *                  non-NULL value when the thread exits.
+ *
+ * \param[in]       var points to the thread-local variable.
+ *
+ * \param[in]       value is the value to set.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if the operating system refused the value.
+ *
+ *****************************************************************************/
+fm_status fmSetThreadLocal(fm_threadLocal *var, void *value)
+{
+    if ( !CreateThreadLocalKey(var) ||
+         pthread_setspecific( (pthread_key_t) var->key, value ) != 0 )
+    {
+        return FM_FAIL;
+    }
+
+    return FM_OK;
 
+}   /* end fmSetThreadLocal */
@@ -38,8 +38,22 @@
  *****************************************************************************/
 
 #define NANOSECS_PER_SECOND     1000000000L
+#define USECS_PER_SECOND        1000000ULL
 #define TIMER_MAGIC_NUMBER      0xA87FCA3B
 
+/* minimum time over which the cycle counter rate is measured */
+#define CYCLES_CALIBRATION_NSEC 10000000ULL
+
+/* converts a timestamp to microseconds */
+#define TIMESTAMP_TO_USEC(ts)   ( (ts)->sec * USECS_PER_SECOND + (ts)->usec )
+
+/* number of bits of the tick used to index a timer wheel level */
+#define WHEEL_LEVEL_SHIFT(level)    ( (level) * FM_TIMER_WHEEL_SLOT_BITS )
+
+/* largest tick delta the timer wheel can hold */
+#define WHEEL_MAX_DELTA             \
+    ( ( 1ULL << WHEEL_LEVEL_SHIFT(FM_TIMER_WHEEL_LEVELS) ) - 1 )
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -66,9 +80,18 @@ static fm_status CreateTimerCondition( void **cond );
 static fm_status DeleteTimerCondition( void *cond );
 static fm_status WakeupTimerTask( fm_timerTask *task );
 static fm_status SuspendTimerTask( fm_timerTask *task, fm_timestamp *timeout );
-static fm_status AddActiveTimerToTask( fm_timerTask *task, fm_timer *timer );
+static void      InitTimerWheel( fm_timerWheel *wheel, fm_uint64 tickUsec );
+static void      AddTimerToWheel( fm_timerWheel *wheel, fm_timer *timer );
+static void      RemoveTimerFromWheel( fm_timerWheel *wheel, fm_timer *timer );
+static void      AdvanceTimerWheel( fm_timerWheel *wheel, fm_uint64 nowTick );
+static fm_uint64 GetTimerWheelNextTick( fm_timerWheel *wheel );
+static fm_timerList *GetTimerWheelList( fm_timerWheel *wheel, fm_int index );
+static fm_status ExpireTimers( fm_timerTask *task,
+                               fm_uint64     nowTick,
+                               fm_bool      *timerLockTaken );
 static fm_status StopTimer( fm_timer *timer );
 static void      PrintDbgRuler( void );
+static fm_float  GetCyclesPerNsec( void );
 
 /*****************************************************************************
  * Local Functions
@@ -170,14 +193,15 @@ static void *PeriodicTimerLoop( void *args )
 {
     fm_thread     *thisThread;
     fm_timerTask  *task;
+    fm_timerWheel *wheel;
     fm_timestamp  next;
     fm_status     status;
     fm_bool       timerLockTaken = FALSE;
-    fm_timer      *timer;
 
     /* grab arguments */
     thisThread =  FM_GET_THREAD_HANDLE( args );
     task       =  FM_GET_THREAD_PARAM( fm_timerTask, args );
+    wheel      =  &task->wheel;
 
     /* schedule the first check one period from now */
     fmGetTime( &next );
@@ -202,55 +226,10 @@ static void *PeriodicTimerLoop( void *args )
         FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
         timerLockTaken = TRUE;
 
-        timer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-        while ( timer && fmCompareTimestamps( &next, &timer->end ) >= 0 )
-        {
-            /* remove the timer only if no longer active, i.e.
-               if this was the last or only repetition, otherwise
-               put it back in the list of active timers but in
-               the right position */
-
-            FM_DLL_REMOVE_NODE( task, 
-                                firstActiveTimer,
-                                lastActiveTimer,
-                                timer,
-                                nextActiveTimer,
-                                prevActiveTimer );
-
-            /* is this the last repetition? */
-            timer->nrRepetitionsSoFar++;
-            if ( ( timer->nrRepetitions != FM_TIMER_REPEAT_FOREVER   ) && 
-                 ( timer->nrRepetitionsSoFar >= timer->nrRepetitions ) )
-            {
-                /* yes, this timer is no longer active */
-                timer->running = FALSE;
-            }
-            else
-            {
-                /* no, compute the next expiraration date and
-                   add the timer back in the active timer list
-                   for this task */
-                timer->start = timer->end;
-                fmAddTimestamps( &timer->end, &timer->timeout );
-                AddActiveTimerToTask( task, timer );
-            }
-
-            /* execute the callback, but release the lock temporarily
-               to prevent lock inversion problems */
-            status = fmReleaseLock( &task->lock );
-            FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
-            timerLockTaken = FALSE;
-
-            /* ignore the return code, we can't give up for a caller error */
-            timer->callback( timer->arg );
-
-            /* grab the lock again and move on to the next active timer */
-            status = fmCaptureLock( &task->lock, FM_WAIT_FOREVER );
-            FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
-            timerLockTaken = TRUE;
-
-            timer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-        }
+        status = ExpireTimers( task,
+                               TIMESTAMP_TO_USEC( &next ) / wheel->tickUsec,
+                               &timerLockTaken );
+        FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
 
         status = fmReleaseLock( &task->lock );
         FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
@@ -297,13 +276,15 @@ static void *EventDrivenTimerLoop( void *args )
     fm_timestamp   *timeout;
     fm_timestamp   curTime;
     fm_status      status;
-    fm_timer       *timer;
     fm_bool        timerLockTaken = FALSE;
     fm_timerTask   *task;
+    fm_timerWheel  *wheel;
+    fm_uint64      usec;
 
     /* grab arguments */
     thisThread =  FM_GET_THREAD_HANDLE( args );
     task       =  FM_GET_THREAD_PARAM( fm_timerTask, args );
+    wheel      =  &task->wheel;
 
     /* we need to enter the main loop holding the timer task lock */
     status = fmCaptureLock( &task->lock, FM_WAIT_FOREVER );
@@ -328,21 +309,14 @@ static void *EventDrivenTimerLoop( void *args )
         }
 
         /******************************************************
-         * Here's where we need to process the list of 
-         * timers handled by this thread. There are two cases: 
-         *  
-         * Case 1:
-         *  The timeout was NULL (infinite wait) or hasn't 
-         *  expired yet. That means we've been woken up by one
-         *  of these functions: fmStartTimer(), fmStopTimer()
-         *  or fmDeleteTimer(). In those cases we simply need
-         *  to check if there is a new timeout (indicating
-         *  the head of the list has changed) and suspend again
-         *  
-         * Case 2: 
-         *  The timeout has expired. In that case we need to 
-         *  process all the expired timers before suspending 
-         *  again. 
+         * We get here either because the timeout has expired
+         * or because we've been woken up by fmStartTimer()
+         * for a timer due before the current timeout. In
+         * both cases, process the timers that have expired
+         * by now, if any, and suspend again until the next
+         * tick that has something to do: either a timer
+         * expiration or a cascade of timers from the upper
+         * levels of the wheel.
          ******************************************************/
 
         status = fmGetTime( &curTime );
@@ -353,73 +327,24 @@ static void *EventDrivenTimerLoop( void *args )
                          "ERROR: fmGetTime: status = %d\n", status);
         }
 
-        timer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-        if ( timeout == NULL || fmCompareTimestamps( &curTime, timeout ) < 0 )
+        status = ExpireTimers( task,
+                               TIMESTAMP_TO_USEC( &curTime ) / wheel->tickUsec,
+                               &timerLockTaken );
+        FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
+
+        /* next cycle: if the wheel is empty we'll block until signalled */
+        wheel->wakeupTick = GetTimerWheelNextTick( wheel );
+        if ( wheel->wakeupTick != 0 )
         {
-            /* Case 1 */
-            timeout = ( (timer != NULL) ? &timer->end : NULL );
-            continue;
+            usec = wheel->wakeupTick * wheel->tickUsec;
+            wheel->wakeupTime.sec  = usec / USECS_PER_SECOND;
+            wheel->wakeupTime.usec = usec % USECS_PER_SECOND;
+            timeout = &wheel->wakeupTime;
         }
         else
         {
-            /* Case 2  */
-            while ( timer && fmCompareTimestamps( &curTime, &timer->end ) >= 0 ) 
-            {
-                /* remove the timer only if no longer active, i.e.
-                   if this was the last or only repetition, otherwise
-                   put it back in the list of active timers but in
-                   the right position */
-
-                FM_DLL_REMOVE_NODE( task, 
-                                    firstActiveTimer,
-                                    lastActiveTimer,
-                                    timer,
-                                    nextActiveTimer,
-                                    prevActiveTimer );
-
-                /* is this the last repetition? */
-                timer->nrRepetitionsSoFar++;
-                if ( ( timer->nrRepetitions != FM_TIMER_REPEAT_FOREVER   ) && 
-                     ( timer->nrRepetitionsSoFar >= timer->nrRepetitions ) )
-                {
-                    /* yes, this timer is no longer active */
-                    timer->running = FALSE;
-                }
-                else
-                {
-                    /* no, compute the next expiraration date and
-                       add the timer back in the active timer list
-                       for this task */
-                    timer->start = timer->end;
-                    fmAddTimestamps( &timer->end, &timer->timeout );
-                    AddActiveTimerToTask( task, timer );
-                }
-
-                /* execute the callback, but release the lock temporarily
-                   to prevent lock inversion problems */
-                status = fmReleaseLock( &task->lock );
-                FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
-                timerLockTaken = FALSE;
-
-                /* ignore the return code, we can't give up for a caller error */
-                timer->callback( timer->arg );
-
-                /* grab the lock again and move on to the next active timer */
-                status = fmCaptureLock( &task->lock, FM_WAIT_FOREVER );
-                FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
-                timerLockTaken = TRUE;
-
-                /* check next timer now */
-                timer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-
-            }   /* end while ( timer && ... ) */
-
-            /* next cycle: next timeout belongs to the  head of the active
-               timer list associated with this timer task. if the list is
-               empty then we'll block until signalled otherwise */
-            timeout = ( (timer != NULL) ? &timer->end : NULL );
-
-        }  /* end else  (i.e. one or more timers have expired ) */
+            timeout = NULL;
+        }
 
     }   /* end while (TRUE) i.e. timer thread main loop */
 
@@ -674,137 +599,493 @@ static fm_status SuspendTimerTask( fm_timerTask *task, fm_timestamp *timeout )
 
 
 /*****************************************************************************/
-/** AddActiveTimerToTask
+/** InitTimerWheel
  * \ingroup intTimer
  *
- * \desc            Adds a timer to the sorted list of active timers
- *                  associated with a given timer task. The list is sorted
- *                  based on the timer's expiration time, with the earliest
- *                  being the first in the list.
+ * \desc            Initializes an empty timer wheel, starting at the current
+ *                  time.
  * 
- * \param[in]       task is the pointer to the timer task data structure.
+ * \param[in]       wheel is the pointer to the timer wheel.
  * 
- * \param[in]       timer is the pointer to the timer data structure.
+ * \param[in]       tickUsec is the duration of a tick in microseconds.
  *
- * \return          FM_OK if successful.
+ * \return          None.
  * 
  *****************************************************************************/
-static fm_status AddActiveTimerToTask( fm_timerTask *task, fm_timer *timer )
+static void InitTimerWheel( fm_timerWheel *wheel, fm_uint64 tickUsec )
 {
-    fm_timer  *activeTimer;
-    fm_timer  *prevActiveTimer;
+    fm_timestamp curTime;
+
+    FM_MEMSET_S( wheel, sizeof(fm_timerWheel), 0, sizeof(fm_timerWheel) );
+
+    fmGetTime( &curTime );
+
+    wheel->tickUsec = ( (tickUsec > 0) ? tickUsec : 1 );
+    wheel->curTick  = TIMESTAMP_TO_USEC( &curTime ) / wheel->tickUsec;
+
+}   /* end InitTimerWheel */
+
 
-    /* scan the list of active timers */
-    prevActiveTimer = NULL;
-    activeTimer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-    while ( ( activeTimer != NULL ) &&
-            ( fmCompareTimestamps( &timer->end, &activeTimer->end ) > 0 ) ) 
+
+
+/*****************************************************************************/
+/** AddTimerToWheel
+ * \ingroup intTimer
+ *
+ * \desc            Adds a timer to the timer wheel of its task, in the slot
+ *                  matching its expiration time. Timers due in the next
+ *                  FM_TIMER_WHEEL_SLOTS ticks go to the first level, later
+ *                  ones go to upper levels and are cascaded down as the
+ *                  wheel turns.
+ * 
+ * \note            This function must be called with the timer task's lock
+ *                  already taken.
+ * 
+ * \param[in]       wheel is the pointer to the timer wheel.
+ * 
+ * \param[in]       timer is the pointer to the timer data structure. Its
+ *                  end time must already be set.
+ *
+ * \return          None.
+ * 
+ *****************************************************************************/
+static void AddTimerToWheel( fm_timerWheel *wheel, fm_timer *timer )
+{
+    fm_timerList *list;
+    fm_uint64     expiryTick;
+    fm_uint64     delta;
+    fm_int        level;
+
+    /* round up, so that the timer never expires early */
+    timer->expiryTick = ( TIMESTAMP_TO_USEC( &timer->end ) +
+                          wheel->tickUsec - 1 ) / wheel->tickUsec;
+
+    /* the current tick has been processed already */
+    if ( timer->expiryTick <= wheel->curTick )
     {
-        prevActiveTimer = activeTimer;
-        activeTimer = FM_DLL_GET_NEXT( activeTimer, nextActiveTimer );
+        timer->expiryTick = wheel->curTick + 1;
     }
 
-    /* check list consistency */
-    if ( activeTimer == NULL)
+    /* timers beyond the range of the wheel are parked in its last slot
+       and moved again each time they are cascaded */
+    expiryTick = timer->expiryTick;
+    delta      = expiryTick - wheel->curTick;
+    if ( delta > WHEEL_MAX_DELTA )
     {
-        if ( task->lastActiveTimer != prevActiveTimer )
+        delta      = WHEEL_MAX_DELTA;
+        expiryTick = wheel->curTick + delta;
+    }
+
+    for ( level = 0 ; level < FM_TIMER_WHEEL_LEVELS - 1 ; level++ )
+    {
+        if ( delta < ( 1ULL << WHEEL_LEVEL_SHIFT(level + 1) ) )
         {
-            FM_LOG_DEBUG( FM_LOG_CAT_ALOS_TIME, 
-                          "Invalid list of active timers (fixed)\n");
-            task->lastActiveTimer = prevActiveTimer;
+            break;
         }
     }
 
-    FM_DLL_INSERT_BEFORE( task, 
-                          firstActiveTimer, 
-                          lastActiveTimer, 
-                          activeTimer,
-                          nextActiveTimer,
-                          prevActiveTimer,
-                          timer );
+    list = &wheel->slots[level][ ( expiryTick >> WHEEL_LEVEL_SHIFT(level) ) &
+                                 FM_TIMER_WHEEL_SLOT_MASK ];
 
-    return FM_OK;
+    FM_DLL_INSERT_LAST( list,
+                        firstActiveTimer,
+                        lastActiveTimer,
+                        timer,
+                        nextActiveTimer,
+                        prevActiveTimer );
+    timer->list  = list;
+    timer->level = level;
+    wheel->levelTimers[level]++;
+    wheel->nrTimers++;
 
-}   /* end AddActiveTimerToTask */
+}   /* end AddTimerToWheel */
 
 
 
 
 /*****************************************************************************/
-/** StopTimer
+/** RemoveTimerFromWheel
  * \ingroup intTimer
  *
- * \desc            Internal version of ''fmStopTimer''. Stops a timer but
- *                  skips the initial sanity checks on the argument.
+ * \desc            Removes a timer from the timer wheel list it is linked
+ *                  in, if any.
  * 
- * \param[in]       timer is the pointer to the timer data structure.
+ * \note            This function must be called with the timer task's lock
+ *                  already taken.
  * 
- * \return          FM_OK if successful.
- * \return          FM_ERR_INVALID_ARGUMENT if one of the function arguments
- *                  was not valid (NULL pointer).
+ * \param[in]       wheel is the pointer to the timer wheel.
+ * 
+ * \param[in]       timer is the pointer to the timer data structure.
+ *
+ * \return          None.
  * 
  *****************************************************************************/
-static fm_status StopTimer( fm_timer *timer )
+static void RemoveTimerFromWheel( fm_timerWheel *wheel, fm_timer *timer )
 {
-    fm_timerTask *task;
-    fm_bool       timerLockTaken = FALSE;
-    fm_status     status;
-    fm_timer     *oldFirstActiveTimer;
-    fm_timer     *pTimer;
+    fm_timerList *list;
 
-    task = timer->task;
-    oldFirstActiveTimer = NULL;
+    list = timer->list;
+    if ( list == NULL )
+    {
+        return;
+    }
+
+    FM_DLL_REMOVE_NODE( list,
+                        firstActiveTimer,
+                        lastActiveTimer,
+                        timer,
+                        nextActiveTimer,
+                        prevActiveTimer );
+    timer->list = NULL;
+    if ( timer->level >= 0 )
+    {
+        wheel->levelTimers[timer->level]--;
+    }
+    wheel->nrTimers--;
+
+}   /* end RemoveTimerFromWheel */
 
-    status = fmCaptureLock( &task->lock, FM_WAIT_FOREVER );
-    FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
-    timerLockTaken = TRUE;
 
 
-    /* verify that the timer is in the active timers list, then remove it */
-    pTimer = FM_DLL_GET_FIRST( task, firstActiveTimer );
 
-    while ( pTimer != NULL ) 
+/*****************************************************************************/
+/** AdvanceTimerWheel
+ * \ingroup intTimer
+ *
+ * \desc            Turns the timer wheel up to a given tick. At each tick,
+ *                  the upper level slots whose time has come are cascaded
+ *                  down, then the timers of the current first level slot
+ *                  are moved to the list of expired timers.
+ * 
+ * \note            This function must be called with the timer task's lock
+ *                  already taken.
+ * 
+ * \param[in]       wheel is the pointer to the timer wheel.
+ * 
+ * \param[in]       nowTick is the current tick.
+ *
+ * \return          None.
+ * 
+ *****************************************************************************/
+static void AdvanceTimerWheel( fm_timerWheel *wheel, fm_uint64 nowTick )
+{
+    fm_timerList *list;
+    fm_timer     *timer;
+    fm_uint64     skipTick;
+    fm_int        level;
+
+    while ( wheel->curTick < nowTick )
     {
-        if ( pTimer == timer )
+        /* nothing to process, jump straight to the current tick */
+        if ( wheel->nrTimers == 0 )
         {
-            /* Peek at the head of the list, we may need to know if this was the
-               first active timer */
-            oldFirstActiveTimer = FM_DLL_GET_FIRST( task, firstActiveTimer );
+            wheel->curTick = nowTick;
+            break;
+        }
+
+        /* if the lower levels are empty, nothing happens until the next
+           cascade of the lowest non-empty level, skip the ticks before */
+        for ( level = 0 ; level < FM_TIMER_WHEEL_LEVELS - 1 ; level++ )
+        {
+            if ( wheel->levelTimers[level] != 0 )
+            {
+                break;
+            }
+        }
 
-            /* remove it from the list of active timers */
-            FM_DLL_REMOVE_NODE( task,
+        if ( level > 0 )
+        {
+            skipTick = ( ( ( wheel->curTick >> WHEEL_LEVEL_SHIFT(level) ) + 1 )
+                         << WHEEL_LEVEL_SHIFT(level) ) - 1;
+
+            if ( skipTick >= nowTick )
+            {
+                wheel->curTick = nowTick;
+                break;
+            }
+
+            wheel->curTick = skipTick;
+        }
+
+        wheel->curTick++;
+
+        /* cascade the upper levels whose lower levels have wrapped */
+        for ( level = 1 ; level < FM_TIMER_WHEEL_LEVELS ; level++ )
+        {
+            if ( ( wheel->curTick &
+                   ( ( 1ULL << WHEEL_LEVEL_SHIFT(level) ) - 1 ) ) != 0 )
+            {
+                break;
+            }
+
+            list = &wheel->slots[level][ ( wheel->curTick >>
+                                           WHEEL_LEVEL_SHIFT(level) ) &
+                                         FM_TIMER_WHEEL_SLOT_MASK ];
+
+            while ( ( timer = FM_DLL_GET_FIRST( list, 
+                                                firstActiveTimer ) ) != NULL )
+            {
+                RemoveTimerFromWheel( wheel, timer );
+                AddTimerToWheel( wheel, timer );
+            }
+        }
+
+        /* everything in the current first level slot is due now */
+        list = &wheel->slots[0][ wheel->curTick & FM_TIMER_WHEEL_SLOT_MASK ];
+
+        while ( ( timer = FM_DLL_GET_FIRST( list, firstActiveTimer ) ) != NULL )
+        {
+            FM_DLL_REMOVE_NODE( list,
                                 firstActiveTimer,
                                 lastActiveTimer,
                                 timer,
                                 nextActiveTimer,
                                 prevActiveTimer );
-            break;
+            FM_DLL_INSERT_LAST( &wheel->expired,
+                                firstActiveTimer,
+                                lastActiveTimer,
+                                timer,
+                                nextActiveTimer,
+                                prevActiveTimer );
+            timer->list  = &wheel->expired;
+            timer->level = -1;
+            wheel->levelTimers[0]--;
         }
+    }
+
+}   /* end AdvanceTimerWheel */
+
+
+
+
+/*****************************************************************************/
+/** GetTimerWheelNextTick
+ * \ingroup intTimer
+ *
+ * \desc            Returns the next tick at which the timer wheel has work
+ *                  to do, i.e. the earliest of the next non-empty first
+ *                  level slot and the next cascade of a non-empty upper
+ *                  level slot.
+ * 
+ * \note            This function must be called with the timer task's lock
+ *                  already taken.
+ * 
+ * \param[in]       wheel is the pointer to the timer wheel.
+ *
+ * \return          The next tick, or 0 if the wheel is empty.
+ * 
+ *****************************************************************************/
+static fm_uint64 GetTimerWheelNextTick( fm_timerWheel *wheel )
+{
+    fm_timerList *list;
+    fm_uint64     nextTick;
+    fm_uint64     tick;
+    fm_uint64     base;
+    fm_int        level;
+    fm_int        i;
 
-        pTimer = FM_DLL_GET_NEXT( pTimer, nextActiveTimer );
+    if ( wheel->nrTimers == 0 )
+    {
+        return 0;
     }
 
-    timer->running = FALSE;
+    /* expired timers still waiting for their callback */
+    if ( FM_DLL_GET_FIRST( &wheel->expired, firstActiveTimer ) != NULL )
+    {
+        return wheel->curTick;
+    }
 
-    /* For an event-driven timer task, signal the condition to the main loop */
-    if ( task->mode == FM_TIMER_TASK_MODE_EVENT_DRIVEN )
+    nextTick = 0;
+
+    for ( level = 0 ; level < FM_TIMER_WHEEL_LEVELS ; level++ )
     {
-        /* we do it only if it's the first active timer in the list */
-        if ( oldFirstActiveTimer == timer )
+        base = wheel->curTick >> WHEEL_LEVEL_SHIFT(level);
+
+        for ( i = 1 ; i <= FM_TIMER_WHEEL_SLOTS ; i++ )
         {
-            /* wakeup the timer task, so that it can process the new timer event */
-            status = WakeupTimerTask( task );
-            FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
+            list = &wheel->slots[level][ (base + i) & 
+                                         FM_TIMER_WHEEL_SLOT_MASK ];
+
+            if ( FM_DLL_GET_FIRST( list, firstActiveTimer ) != NULL )
+            {
+                tick = (base + i) << WHEEL_LEVEL_SHIFT(level);
+
+                if ( nextTick == 0 || tick < nextTick )
+                {
+                    nextTick = tick;
+                }
+                break;
+            }
         }
     }
 
-    status = FM_OK;
+    return nextTick;
 
-ABORT:
-    if ( timerLockTaken == TRUE )
+}   /* end GetTimerWheelNextTick */
+
+
+
+
+/*****************************************************************************/
+/** GetTimerWheelList
+ * \ingroup intTimer
+ *
+ * \desc            Returns a list of the timer wheel, by its index in
+ *                  expiration order: the expired timers first, then the
+ *                  slots of each level starting with the next tick.
+ * 
+ * \param[in]       wheel is the pointer to the timer wheel.
+ * 
+ * \param[in]       index is the index of the list.
+ *
+ * \return          Pointer to the list, or NULL if index is out of range.
+ * 
+ *****************************************************************************/
+static fm_timerList *GetTimerWheelList( fm_timerWheel *wheel, fm_int index )
+{
+    fm_int    level;
+    fm_uint64 slot;
+
+    if ( index == 0 )
     {
-        fmReleaseLock( &task->lock );
+        return &wheel->expired;
+    }
+
+    index--;
+    level = index / FM_TIMER_WHEEL_SLOTS;
+    if ( level >= FM_TIMER_WHEEL_LEVELS )
+    {
+        return NULL;
     }
+
+    slot = ( wheel->curTick >> WHEEL_LEVEL_SHIFT(level) ) + 1 + 
+           ( index % FM_TIMER_WHEEL_SLOTS );
+
+    return &wheel->slots[level][slot & FM_TIMER_WHEEL_SLOT_MASK];
+
+}   /* end GetTimerWheelList */
+
+
+
+
+/*****************************************************************************/
+/** ExpireTimers
+ * \ingroup intTimer
+ *
+ * \desc            Turns the timer wheel of a timer task up to a given tick
+ *                  and invokes the callbacks of all the timers that have
+ *                  expired, rescheduling those that have repetitions left.
+ *                  The timers due in the same tick are collected in one
+ *                  pass and their callbacks delivered back to back.
+ * 
+ * \note            This function must be called with the timer task's lock
+ *                  already taken. The lock is released while each callback
+ *                  runs, so that the callback may start, stop or delete
+ *                  timers, including those that have yet to be delivered.
+ * 
+ * \param[in]       task is the pointer to the timer task data structure.
+ * 
+ * \param[in]       nowTick is the current tick.
+ * 
+ * \param[in,out]   timerLockTaken points to the caller's flag tracking
+ *                  whether the timer task's lock is held.
+ *
+ * \return          FM_OK if successful.
+ * 
+ *****************************************************************************/
+static fm_status ExpireTimers( fm_timerTask *task,
+                               fm_uint64     nowTick,
+                               fm_bool      *timerLockTaken )
+{
+    fm_timerWheel *wheel;
+    fm_timer      *timer;
+    fm_status      status;
+
+    wheel = &task->wheel;
+
+    AdvanceTimerWheel( wheel, nowTick );
+
+    while ( ( timer = FM_DLL_GET_FIRST( &wheel->expired, 
+                                        firstActiveTimer ) ) != NULL )
+    {
+        RemoveTimerFromWheel( wheel, timer );
+
+        /* is this the last repetition? */
+        timer->nrRepetitionsSoFar++;
+        if ( ( timer->nrRepetitions != FM_TIMER_REPEAT_FOREVER   ) && 
+             ( timer->nrRepetitionsSoFar >= timer->nrRepetitions ) )
+        {
+            /* yes, this timer is no longer active */
+            timer->running = FALSE;
+        }
+        else
+        {
+            /* no, compute the next expiraration date and
+               put the timer back in the wheel */
+            timer->start = timer->end;
+            fmAddTimestamps( &timer->end, &timer->timeout );
+            AddTimerToWheel( wheel, timer );
+        }
+
+        /* execute the callback, but release the lock temporarily
+           to prevent lock inversion problems */
+        status = fmReleaseLock( &task->lock );
+        FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
+        *timerLockTaken = FALSE;
+
+        /* ignore the return code, we can't give up for a caller error */
+        timer->callback( timer->arg );
+
+        /* grab the lock again and move on to the next expired timer */
+        status = fmCaptureLock( &task->lock, FM_WAIT_FOREVER );
+        FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
+        *timerLockTaken = TRUE;
+    }
+
+    status = FM_OK;
+
+ABORT:
+    return status;
+
+}   /* end ExpireTimers */
+
+
+
+
+/*****************************************************************************/
+/** StopTimer
+ * \ingroup intTimer
+ *
+ * \desc            Internal version of ''fmStopTimer''. Stops a timer but
+ *                  skips the initial sanity checks on the argument.
+ * 
+ * \param[in]       timer is the pointer to the timer data structure.
+ * 
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if one of the function arguments
+ *                  was not valid (NULL pointer).
+ * 
+ *****************************************************************************/
+static fm_status StopTimer( fm_timer *timer )
+{
+    fm_timerTask *task;
+    fm_status     status;
+
+    task = timer->task;
+
+    status = fmCaptureLock( &task->lock, FM_WAIT_FOREVER );
+    FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
+
+    /* remove it from the timer wheel. There is no need to wake up an
+       event-driven timer task: if it was due to wake up for this timer,
+       it will find nothing to do and suspend again */
+    RemoveTimerFromWheel( &task->wheel, timer );
+
+    timer->running = FALSE;
+
+    fmReleaseLock( &task->lock );
+
+ABORT:
     return status;
 
 }   /* end StopTimer */
@@ -859,16 +1140,8 @@ static fm_status CleanupAllTimers( fm_timerTask *task )
         /* save the next pointer */
         nextTimer = FM_DLL_GET_NEXT( timer, nextTimer );
         
-        /* if active, remove it from the list of active timers */
-        if ( timer->running )
-        {
-            FM_DLL_REMOVE_NODE( task,
-                                firstActiveTimer,
-                                lastActiveTimer,
-                                timer,
-                                nextActiveTimer,
-                                prevActiveTimer );
-        }
+        /* if active, remove it from the timer wheel */
+        RemoveTimerFromWheel( &task->wheel, timer );
 
         /* remove it from the list of instantiated timers */
         FM_DLL_REMOVE_NODE( task,
@@ -887,6 +1160,52 @@ static fm_status CleanupAllTimers( fm_timerTask *task )
 }   /* end CleanupAllTimers */
 
 
+
+
+/*****************************************************************************/
+/** GetCyclesPerNsec
+ * \ingroup intAlosTime
+ *
+ * \desc            Return the rate of the cycle counter, measuring it
+ *                  against CLOCK_MONOTONIC over the time elapsed since
+ *                  ALOS initialization on first use.
+ *
+ * \param           None.
+ *
+ * \return          The number of cycles per nanosecond.
+ *
+ *****************************************************************************/
+static fm_float GetCyclesPerNsec( void )
+{
+#if defined(__x86_64__) || defined(__i386__)
+    fm_uint64 cycles;
+    fm_uint64 nsec;
+
+    if (fmRootAlos->cyclesPerNsec > 0.0)
+    {
+        return fmRootAlos->cyclesPerNsec;
+    }
+
+    do
+    {
+        cycles = FM_GET_CYCLES();
+        nsec   = fmGetMonotonicNsec();
+    }
+    while (nsec - fmRootAlos->cyclesStartNsec < CYCLES_CALIBRATION_NSEC);
+
+    fmRootAlos->cyclesPerNsec =
+        (fm_float) (cycles - fmRootAlos->cyclesStart) /
+        (fm_float) (nsec - fmRootAlos->cyclesStartNsec);
+
+    return fmRootAlos->cyclesPerNsec;
+#else
+    /* FM_GET_CYCLES counts nanoseconds. */
+    return 1.0;
+#endif
+
+}   /* end GetCyclesPerNsec */
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -1028,6 +1347,154 @@ fm_status fmGetTime(fm_timestamp *ts)
 
 
 
+/*****************************************************************************/
+/** fmGetTimeFast
+ * \ingroup alosTime
+ *
+ * \desc            Get the time on the same time base as ''fmGetTime'', at
+ *                  the resolution of the kernel tick (typically 1 to 4
+ *                  milliseconds). This is read from the vDSO without a
+ *                  system call and is suitable for hot paths that need
+ *                  only coarse timestamps.
+ *
+ * \param[out]      ts points to a caller-allocated fm_timestamp structure
+ *                  where this function should place the current time.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if not successful.
+ *
+ *****************************************************************************/
+fm_status fmGetTimeFast(fm_timestamp *ts)
+{
+    struct timespec tv;
+
+    if (clock_gettime(CLOCK_MONOTONIC_COARSE, &tv) != 0)
+    {
+        return FM_FAIL;
+    }
+
+    ts->sec  = tv.tv_sec;
+    ts->usec = tv.tv_nsec / 1000;
+
+    return FM_OK;
+
+}   /* end fmGetTimeFast */
+
+
+
+
+/*****************************************************************************/
+/** fmGetMonotonicNsec
+ * \ingroup intAlosTime
+ *
+ * \desc            Get the time on the same time base as ''fmGetTime'', in
+ *                  nanoseconds.
+ *
+ * \param           None.
+ *
+ * \return          The time in nanoseconds.
+ *
+ *****************************************************************************/
+fm_uint64 fmGetMonotonicNsec(void)
+{
+    struct timespec tv;
+
+    clock_gettime(CLOCK_MONOTONIC, &tv);
+
+    return ( (fm_uint64) tv.tv_sec * NANOSECS_PER_SECOND ) + tv.tv_nsec;
+
+}   /* end fmGetMonotonicNsec */
+
+
+
+
+/*****************************************************************************/
+/** fmGetCycles
+ * \ingroup alosTime
+ *
+ * \desc            Read the free-running cycle counter used for hot-path
+ *                  timestamps. Only differences between readings and
+ *                  conversions with ''fmCyclesToNsec'' and
+ *                  ''fmCyclesToTimestamp'' are meaningful. Callers in this
+ *                  SDK use the FM_GET_CYCLES macro, which is inlined.
+ *
+ * \param           None.
+ *
+ * \return          The cycle count.
+ *
+ *****************************************************************************/
+fm_uint64 fmGetCycles(void)
+{
+    return FM_GET_CYCLES();
+
+}   /* end fmGetCycles */
+
+
+
+
+/*****************************************************************************/
+/** fmCyclesToNsec
+ * \ingroup alosTime
+ *
+ * \desc            Convert a number of cycles, as the difference of two
+ *                  ''fmGetCycles'' readings, to nanoseconds. The rate of
+ *                  the counter is measured on the first call, which may
+ *                  wait up to 10 milliseconds if ALOS was initialized
+ *                  less than that long ago. The time stamp counter is
+ *                  assumed to be invariant.
+ *
+ * \param[in]       cycles is the number of cycles.
+ *
+ * \return          The number of nanoseconds.
+ *
+ *****************************************************************************/
+fm_uint64 fmCyclesToNsec(fm_uint64 cycles)
+{
+    return (fm_uint64) ( cycles / GetCyclesPerNsec() );
+
+}   /* end fmCyclesToNsec */
+
+
+
+
+/*****************************************************************************/
+/** fmCyclesToTimestamp
+ * \ingroup alosTime
+ *
+ * \desc            Convert a ''fmGetCycles'' reading to a time on the same
+ *                  time base as ''fmGetTime''.
+ *
+ * \param[in]       cycles is the cycle count.
+ *
+ * \param[out]      ts points to a caller-allocated fm_timestamp structure
+ *                  where this function should place the time.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmCyclesToTimestamp(fm_uint64 cycles, fm_timestamp *ts)
+{
+    fm_uint64 nsec;
+
+    nsec = fmRootAlos->cyclesStartNsec;
+
+    if (cycles >= fmRootAlos->cyclesStart)
+    {
+        nsec += fmCyclesToNsec(cycles - fmRootAlos->cyclesStart);
+    }
+    else
+    {
+        nsec -= fmCyclesToNsec(fmRootAlos->cyclesStart - cycles);
+    }
+
+    ts->sec  = nsec / NANOSECS_PER_SECOND;
+    ts->usec = (nsec % NANOSECS_PER_SECOND) / 1000;
+
+}   /* end fmCyclesToTimestamp */
+
+
+
+
 /*****************************************************************************/
 /** fmGetFormattedTime
  * \ingroup intAlosTime
@@ -1260,6 +1727,11 @@ fm_status fmAlosTimeInit( void )
         FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
     }
 
+    /* start measuring the cycle counter rate */
+    fmRootAlos->cyclesStart     = FM_GET_CYCLES();
+    fmRootAlos->cyclesStartNsec = fmGetMonotonicNsec();
+    fmRootAlos->cyclesPerNsec   = 0.0;
+
     /* clear all the timer task data structures */
     fmRootAlos->nrTimerTasks = 0;
     for (i = 0 ; i < FM_ALOS_INTERNAL_MAX_TIMER_TASKS  ; i++)
@@ -1469,11 +1941,18 @@ fm_status fmCreateTimerTask( fm_text           taskName,
     if ( mode == FM_TIMER_TASK_MODE_PERIODIC )
     {
         task->period   = *period;
+
+        /* the wheel turns once per period */
+        InitTimerWheel( &task->wheel, TIMESTAMP_TO_USEC( period ) );
+    }
+    else
+    {
+        InitTimerWheel( &task->wheel, FM_TIMER_WHEEL_EVENT_DRIVEN_TICK );
     }
 
     /* create the lock for this task */
     FM_SPRINTF_S( auxName, 32, "%sLock", taskName );
-    status = fmCreateLock( auxName, &task->lock );
+    status = fmCreateCondLock( auxName, &task->lock );
     FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
     taskLockInit = TRUE;
 
@@ -1885,7 +2364,6 @@ fm_status fmStartTimer( fm_timerHandle    handle,
 {
     fm_status      status;
     fm_timer      *timer;
-    fm_timer      *firstActiveTimer;
     fm_timerTask  *task;
     fm_timestamp   curTime;
     fm_bool        timerLockTaken = FALSE;
@@ -1949,16 +2427,23 @@ fm_status fmStartTimer( fm_timerHandle    handle,
     timer->end                = curTime;
     fmAddTimestamps( &timer->end, &timer->timeout );
 
-    /* add it to the list of active timers for this timer task */
-    status = AddActiveTimerToTask( task, timer );
-    FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
+    /* an empty wheel doesn't turn, bring it up to date first */
+    if ( task->wheel.nrTimers == 0 )
+    {
+        AdvanceTimerWheel( &task->wheel,
+                           TIMESTAMP_TO_USEC( &curTime ) / 
+                           task->wheel.tickUsec );
+    }
+
+    /* add it to the timer wheel of this timer task */
+    AddTimerToWheel( &task->wheel, timer );
 
     /* For an event-driven timer task, signal the condition to the main loop */
     if ( task->mode == FM_TIMER_TASK_MODE_EVENT_DRIVEN )
     {
-        /* we do it only if it's the first active timer in hte list */
-        firstActiveTimer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-        if ( firstActiveTimer == timer )
+        /* we do it only if the timer is due before the task wakes up */
+        if ( task->wheel.wakeupTick == 0 ||
+             timer->expiryTick < task->wheel.wakeupTick )
         {
             /* wakeup the timer task, so that it can process the new timer event */
             status = WakeupTimerTask( task );
@@ -2352,7 +2837,9 @@ fm_status fmDbgDumpActiveTimerList(void)
     fm_status     status;
     fm_timerTask *task;
     fm_timer     *timer;
+    fm_timerList *list;
     fm_int        i;
+    fm_int        listIndex;
     fm_int        timerCount;
     fm_timestamp  curTime;
     fm_char       auxStr[70];
@@ -2400,56 +2887,64 @@ fm_status fmDbgDumpActiveTimerList(void)
             FM_LOG_PRINT("|EXPIRATION TIME   |\n");
             PrintDbgRuler();
 
+            /* walk the timer wheel in expiration order */
             timerCount = 0;
-            timer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-            while ( timer != NULL )
+            for ( listIndex = 0 ;
+                  ( list = GetTimerWheelList( &task->wheel, 
+                                              listIndex ) ) != NULL ;
+                  listIndex++ )
             {
-
-                /* if ( 1 ) */
+                timer = FM_DLL_GET_FIRST( list, firstActiveTimer );
+                while ( timer != NULL )
                 {
-                    FM_LOG_PRINT( "|%-16s", timer->name );
-                    FM_LOG_PRINT( "|%-7s", 
-                                  (timer->running ? 
-                                   "Active" : 
-                                   "Idle") );
-                    if ( timer->running )
+
+                    /* if ( 1 ) */
                     {
-                        FM_LOG_PRINT("|%-11d", timer->nrRepetitionsSoFar );
-                        if ( timer->nrRepetitions == FM_TIMER_REPEAT_FOREVER )
+                        FM_LOG_PRINT( "|%-16s", timer->name );
+                        FM_LOG_PRINT( "|%-7s", 
+                                      (timer->running ? 
+                                       "Active" : 
+                                       "Idle") );
+                        if ( timer->running )
                         {
-                            FM_LOG_PRINT("|%-12s", "INF");
+                            FM_LOG_PRINT("|%-11d", timer->nrRepetitionsSoFar );
+                            if ( timer->nrRepetitions == FM_TIMER_REPEAT_FOREVER )
+                            {
+                                FM_LOG_PRINT("|%-12s", "INF");
+                            }
+                            else
+                            {
+                                FM_LOG_PRINT("|%-12d", timer->nrRepetitions );
+                            }
+                            FM_SPRINTF_S( auxStr,
+                                          sizeof(auxStr),
+                                          "|%llu.%03llus",
+                                          timer->start.sec, 
+                                          timer->start.usec/1000 );
+                            FM_LOG_PRINT("%-19s", auxStr );
+                            FM_SPRINTF_S( auxStr,
+                                          sizeof(auxStr),
+                                          "|%llu.%03llus",
+                                          timer->end.sec, 
+                                          timer->end.usec/1000 );
+                            FM_LOG_PRINT("%-19s|\n", auxStr);
                         }
                         else
                         {
-                            FM_LOG_PRINT("|%-12d", timer->nrRepetitions );
+                            FM_LOG_PRINT("|%-11s", "N/A");
+                            FM_LOG_PRINT("|%-12s", "N/A");
+                            FM_LOG_PRINT("|%-18s", "N/A");
+                            FM_LOG_PRINT("|%-18s|\n", "N/A");
                         }
-                        FM_SPRINTF_S( auxStr,
-                                      sizeof(auxStr),
-                                      "|%llu.%03llus",
-                                      timer->start.sec, 
-                                      timer->start.usec/1000 );
-                        FM_LOG_PRINT("%-19s", auxStr );
-                        FM_SPRINTF_S( auxStr,
-                                      sizeof(auxStr),
-                                      "|%llu.%03llus",
-                                      timer->end.sec, 
-                                      timer->end.usec/1000 );
-                        FM_LOG_PRINT("%-19s|\n", auxStr);
-                    }
-                    else
-                    {
-                        FM_LOG_PRINT("|%-11s", "N/A");
-                        FM_LOG_PRINT("|%-12s", "N/A");
-                        FM_LOG_PRINT("|%-18s", "N/A");
-                        FM_LOG_PRINT("|%-18s|\n", "N/A");
+                        timerCount++;
+
                     }
-                    timerCount++;
 
-                }
+                    timer = FM_DLL_GET_NEXT( timer, nextActiveTimer );
 
-                timer = FM_DLL_GET_NEXT( timer, nextActiveTimer );
+                }   /* end while ( timer != NULL ) */
 
-            }   /* end while ( timer != NULL ) */
+            }   /* end for ( listIndex = 0 ; ... ) */
 
             if ( timerCount == 0 )
             {
@@ -58,6 +58,64 @@
     }
 
 
+/* Size of the status text kept for each ACL whose keys are selected by the
+ * compiler worker threads. */
+#define FM10000_ACL_KEY_JOB_TEXT_LENGTH            256
+
+/* Key selection of one ingress ACL, done by the compiler worker threads. */
+typedef struct _fm10000_aclKeyJob
+{
+    /* ACL whose keys are to be selected */
+    fm_acl                *acl;
+
+    /* Compiled ACL receiving the selected keys */
+    fm_fm10000CompiledAcl *compiledAcl;
+
+    /* Largest number of action slices needed by a rule of the ACL */
+    fm_int                 maxActionSlices;
+
+    /* Outcome of the key selection */
+    fm_status              status;
+
+    /* Number of errors reported by the key selection */
+    fm_int                 numErrors;
+
+    /* Messages reported by the key selection */
+    fm_char                statusText[FM10000_ACL_KEY_JOB_TEXT_LENGTH];
+
+} fm10000_aclKeyJob;
+
+/* Work shared by the threads selecting the keys of the ingress ACLs. Jobs
+ * are handed out in ACL order. */
+typedef struct _fm10000_aclKeyPool
+{
+    /* Switch on which to operate */
+    fm_int             sw;
+
+    /* Key selection jobs, in ACL order */
+    fm10000_aclKeyJob *jobs;
+
+    /* Number of jobs */
+    fm_int             numJobs;
+
+    /* Next job to hand out */
+    fm_int             nextJob;
+
+    /* TRUE once a job has failed, no more jobs are handed out */
+    fm_bool            jobFailed;
+
+    /* First error not related to a particular job */
+    fm_status          status;
+
+    /* Protects nextJob, jobFailed and status */
+    fm_lock            lock;
+
+    /* Released by each worker thread when it runs out of work */
+    fm_semaphore       done;
+
+} fm10000_aclKeyPool;
+
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -960,38 +1018,38 @@ void fmFreeAclPortSet(void *value);
 void fmFreeEcmpGroup(void *value);
 void fmFreeCompiledPolicerEntry(void *value);
 
-fm_status fmAddAbstractKey(fm_tree * abstractKey,
-                           fm_byte   firstAbstract,
-                           fm_byte   lastAbstract,
-                           fm_byte   bitsPerKey,
-                           fm_uint64 mask,
-                           fm_uint64 value);
-fm_status fmAddIpAbstractKey(fm_tree * abstractKey,
-                             fm_byte   firstAbstract,
-                             fm_ipAddr mask,
-                             fm_ipAddr value);
-fm_status fmAddDeepInsAbstractKey(fm_tree * abstractKey,
-                                  fm_byte * abstractTable,
-                                  fm_byte   tableSize,
-                                  fm_byte * mask,
-                                  fm_byte * value);
-
-fm_status fmFillAbstractPortSetKeyTree(fm_aclErrorReporter *      errReport,
-                                       fm_aclRule *               rule,
-                                       fm_fm10000CompiledAclRule *compiledAclRule,
-                                       fm_tree *                  abstractKey,
-                                       fm_tree *                  portSetId);
-fm_status fmFillAbstractKeyTree(fm_int               sw,
-                                fm_aclErrorReporter *errReport,
-                                fm_aclRule *         rule,
-                                fm_tree *            abstractKey,
-                                fm_tree *            portSetId);
+fm_status fmAddAbstractKey(fm_fm10000AbstractKey *abstractKey,
+                           fm_byte                firstAbstract,
+                           fm_byte                lastAbstract,
+                           fm_byte                bitsPerKey,
+                           fm_uint64              mask,
+                           fm_uint64              value);
+fm_status fmAddIpAbstractKey(fm_fm10000AbstractKey *abstractKey,
+                             fm_byte                firstAbstract,
+                             fm_ipAddr              mask,
+                             fm_ipAddr              value);
+fm_status fmAddDeepInsAbstractKey(fm_fm10000AbstractKey *abstractKey,
+                                  fm_byte *              abstractTable,
+                                  fm_byte                tableSize,
+                                  fm_byte *              mask,
+                                  fm_byte *              value);
+
+fm_status fmFillAbstractPortSetKey(fm_aclErrorReporter *      errReport,
+                                   fm_aclRule *               rule,
+                                   fm_fm10000CompiledAclRule *compiledAclRule,
+                                   fm_fm10000AbstractKey *    abstractKey,
+                                   fm_tree *                  portSetId);
+fm_status fmFillAbstractKey(fm_int                 sw,
+                            fm_aclErrorReporter *  errReport,
+                            fm_aclRule *           rule,
+                            fm_fm10000AbstractKey *abstractKey,
+                            fm_tree *              portSetId);
 
 fm_int fmCountConditionSliceUsage(fm_byte *muxSelect);
 void fmInitializeConcreteKey(fm_byte *muxSelect);
-fm_status fmConvertAbstractToConcreteKey(fm_tree *      abstractKeyTree,
-                                         fm_byte *      muxSelect,
-                                         fm_uint16 *    muxUsed);
+fm_status fmConvertAbstractToConcreteKey(fm_fm10000AbstractKey *abstractKey,
+                                         fm_byte *              muxSelect,
+                                         fm_uint16 *            muxUsed);
 
 void fmTranslateAclScenario(fm_int      sw,
                             fm_uint32   aclScenario,
@@ -1124,6 +1182,9 @@ static void InitializeCompiledAcls(fm_int                  sw,
         fmTreeInit(&cacls->policers[i].policerEntry);
     }
 
+    cacls->ndRuleWrites = 0;
+    cacls->ndRuleMoves  = 0;
+
 }   /* end InitializeCompiledAcls */
 
 
@@ -1153,7 +1214,7 @@ static void * CloneEcmpGroup(void *value, void *funcArg)
 
     FM_NOT_USED(funcArg);
 
-    ecmpListClone = (fm_dlist *) fmAlloc(sizeof(fm_dlist));
+    ecmpListClone = (fm_dlist *) fmAllocTagged(sizeof(fm_dlist), FM_LOG_CAT_ACL);
     if (ecmpListClone == NULL)
     {
         return NULL;
@@ -1166,7 +1227,8 @@ static void * CloneEcmpGroup(void *value, void *funcArg)
     while (node != NULL)
     {
         ecmpRule = (fm_fm10000AclRule *) node->data;
-        ecmpRuleClone = (fm_fm10000AclRule *) fmAlloc(sizeof(fm_fm10000AclRule));
+        ecmpRuleClone = (fm_fm10000AclRule *) fmAllocTagged(sizeof(fm_fm10000AclRule),
+                                                            FM_LOG_CAT_ACL);
         if (ecmpRuleClone == NULL)
         {
             fmFreeEcmpGroup(ecmpListClone);
@@ -1219,7 +1281,8 @@ static void * CloneInstances(void *value, void *funcArg)
     fm_fm10000CompiledAclInstance *compiledAclInst = (fm_fm10000CompiledAclInstance *) value;
     fm_fm10000CompiledAclInstance *compiledAclInstClone;
 
-    compiledAclInstClone = (fm_fm10000CompiledAclInstance *) fmAlloc(sizeof(fm_fm10000CompiledAclInstance));
+    compiledAclInstClone = (fm_fm10000CompiledAclInstance *) fmAllocTagged(sizeof(fm_fm10000CompiledAclInstance),
+                                                                           FM_LOG_CAT_ACL);
     if (compiledAclInstClone == NULL)
     {
         return NULL;
@@ -1283,7 +1346,7 @@ static void * ClonePortSetId(void *value, void *funcArg)
 
     FM_NOT_USED(funcArg);
 
-    portSetClone = (fm_portSet *)fmAlloc(sizeof(fm_portSet));
+    portSetClone = (fm_portSet *)fmAllocTagged(sizeof(fm_portSet), FM_LOG_CAT_ACL);
     if (portSetClone == NULL)
     {
         return NULL;
@@ -1338,7 +1401,8 @@ static void * ClonePolicersEntries(void *value, void *funcArg)
 
     FM_NOT_USED(funcArg);
 
-    compiledPolEntryClone = (fm_fm10000CompiledPolicerEntry *) fmAlloc(sizeof(fm_fm10000CompiledPolicerEntry));
+    compiledPolEntryClone = (fm_fm10000CompiledPolicerEntry *) fmAllocTagged(sizeof(fm_fm10000CompiledPolicerEntry),
+                                                                             FM_LOG_CAT_ACL);
     if (compiledPolEntryClone == NULL)
     {
         return NULL;
@@ -1354,7 +1418,8 @@ static void * ClonePolicersEntries(void *value, void *funcArg)
     while (node != NULL)
     {
         aclRule = (fm_fm10000AclRule *) node->data;
-        aclRuleClone = (fm_fm10000AclRule *) fmAlloc(sizeof(fm_fm10000AclRule));
+        aclRuleClone = (fm_fm10000AclRule *) fmAllocTagged(sizeof(fm_fm10000AclRule),
+                                                           FM_LOG_CAT_ACL);
         if (aclRuleClone == NULL)
         {
             fmFreeCompiledPolicerEntry(compiledPolEntryClone);
@@ -1403,7 +1468,7 @@ static void * ClonePolicersAcls(void *value, void *funcArg)
 
     FM_NOT_USED(funcArg);
 
-    aclNumElementClone = (fm_int *) fmAlloc(sizeof(fm_int));
+    aclNumElementClone = (fm_int *) fmAllocTagged(sizeof(fm_int), FM_LOG_CAT_ACL);
     if (aclNumElementClone == NULL)
     {
         return NULL;
@@ -1438,7 +1503,8 @@ static void * CloneCompiledAclRule(void *value, void *funcArg)
 
     FM_NOT_USED(funcArg);
 
-    compiledAclRuleClone = fmAlloc(sizeof(fm_fm10000CompiledAclRule));
+    compiledAclRuleClone = fmAllocTagged(sizeof(fm_fm10000CompiledAclRule),
+                                         FM_LOG_CAT_ACL);
 
     if (compiledAclRuleClone == NULL)
     {
@@ -1500,7 +1566,7 @@ static void * CloneCompiledAcl(void *value, void *funcArg)
     fm_uint64 portNumber;
     fm_status err;
 
-    compiledAclClone = fmAlloc(sizeof(fm_fm10000CompiledAcl));
+    compiledAclClone = fmAllocTagged(sizeof(fm_fm10000CompiledAcl), FM_LOG_CAT_ACL);
     if (compiledAclClone == NULL)
     {
         return NULL;
@@ -1553,7 +1619,7 @@ static void * CloneCompiledAcl(void *value, void *funcArg)
     /* Clone the portSet tree */
     if (compiledAclClone->aclParts == 0)
     {
-        compiledAclClone->portSetId = fmAlloc(sizeof(fm_tree));
+        compiledAclClone->portSetId = fmAllocTagged(sizeof(fm_tree), FM_LOG_CAT_ACL);
         if (compiledAclClone->portSetId == NULL)
         {
             fmFreeCompiledAcl(compiledAclClone);
@@ -1642,7 +1708,7 @@ static fm_fm10000CompiledAcls* CloneCompiledAcls(fm_int                  sw,
     fm_int sizeOfMapper;
 
     compiledClone = (fm_fm10000CompiledAcls *)
-        fmAlloc( sizeof(fm_fm10000CompiledAcls) );
+        fmAllocTagged( sizeof(fm_fm10000CompiledAcls), FM_LOG_CAT_ACL );
 
     if (compiledClone == NULL)
     {
@@ -1779,7 +1845,7 @@ static fm_fm10000CompiledAcls* CloneCompiledAcls(fm_int                  sw,
                                     &sizeOfMapper);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-        mapperClone = fmAlloc(sizeOfMapper);
+        mapperClone = fmAllocTagged(sizeOfMapper, FM_LOG_CAT_ACL);
         if (mapperClone == NULL)
         {
             err = FM_ERR_NO_MEM;
@@ -1812,6 +1878,79 @@ ABORT:
 }   /* end CloneCompiledAcls */
 
 
+/*****************************************************************************/
+/** SetAbstractKey
+ * \ingroup intAcl
+ *
+ * \desc            Marks an abstract key as needed. The mask and value of a
+ *                  key already marked are left as they are.
+ *
+ * \param[in,out]   abstractKey points to the abstract key set to update.
+ *
+ * \param[in]       key is the abstract key, FM10000_ABSTRACT_XXX.
+ *
+ * \param[in]       mask is the mask of the key.
+ *
+ * \param[in]       value is the value of the key.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void SetAbstractKey(fm_fm10000AbstractKey *abstractKey,
+                           fm_byte                key,
+                           fm_byte                mask,
+                           fm_byte                value)
+{
+    fm_uint64 bit = FM_LITERAL_U64(1) << (key % 64);
+
+    if ( (abstractKey->used[key / 64] & bit) == 0 )
+    {
+        abstractKey->used[key / 64] |= bit;
+        abstractKey->data[key]       = (mask << 8) | value;
+    }
+
+}   /* end SetAbstractKey */
+
+
+
+
+/*****************************************************************************/
+/** GetAbstractKey
+ * \ingroup intAcl
+ *
+ * \desc            Retrieves the mask and value of an abstract key.
+ *
+ * \param[in]       abstractKey points to the abstract key set.
+ *
+ * \param[in]       key is the abstract key, FM10000_ABSTRACT_XXX.
+ *
+ * \param[out]      data points to caller-allocated storage where this
+ *                  function places the mask (bits 15:8) and value
+ *                  (bits 7:0) of the key.
+ *
+ * \return          TRUE if the key is needed.
+ * \return          FALSE otherwise.
+ *
+ *****************************************************************************/
+static fm_bool GetAbstractKey(const fm_fm10000AbstractKey *abstractKey,
+                              fm_int                       key,
+                              fm_uint16 *                  data)
+{
+    if ( (abstractKey->used[key / 64] &
+          (FM_LITERAL_U64(1) << (key % 64))) == 0 )
+    {
+        return FALSE;
+    }
+
+    *data = abstractKey->data[key];
+
+    return TRUE;
+
+}   /* end GetAbstractKey */
+
+
+
+
 /*****************************************************************************/
 /** FoundFree8BitsMux
  * \ingroup intAcl
@@ -1953,7 +2092,7 @@ static fm_bool FoundFree4BitsMux(fm_uint64  abstractKey,
  * \desc            This function go over all the possible abstract key and
  *                  try to find the one already configured by the mux. If
  *                  a mux fit an abstract key that is also part of the
- *                  abstract key tree then its value and mask are configured
+ *                  abstract key set then its value and mask are configured
  *                  at the proper key and keyMask position.
  *
  * \param[in]       selectedMux refer to the mux configuration.
@@ -1963,7 +2102,7 @@ static fm_bool FoundFree4BitsMux(fm_uint64  abstractKey,
  *                  in the range of 0-4 and will malfunction if this is
  *                  not true.
  *
- * \param[in]       abstractKey point to the filled abstract key containing
+ * \param[in]       abstractKey point to the filled abstract key set containing
  *                  all the key to configure for this rule.
  *
  * \param[in,out]   key points to the 36 bits key value of the rule.
@@ -1973,16 +2112,16 @@ static fm_bool FoundFree4BitsMux(fm_uint64  abstractKey,
  * \return          Nothing.
  *
  *****************************************************************************/
-static void ConfigureConditionKeyForMux(fm_byte     selectedMux,
-                                        fm_byte     muxPosition,
-                                        fm_tree *   abstractKey,
-                                        fm_uint64 * key,
-                                        fm_uint64 * keyMask)
+static void ConfigureConditionKeyForMux(fm_byte                      selectedMux,
+                                        fm_byte                      muxPosition,
+                                        const fm_fm10000AbstractKey *abstractKey,
+                                        fm_uint64 *                  key,
+                                        fm_uint64 *                  keyMask)
 {
     fm_int i;
     fm_uint64 value;
     fm_uint64 mask;
-    void *nextValue;
+    fm_uint16 data;
 
     /* Only try to match 8bits key when the muxPosition to process is not the
      * top key. */
@@ -1995,12 +2134,12 @@ static void ConfigureConditionKeyForMux(fm_byte     selectedMux,
             if (fmAbstractToConcrete8bits[i][muxPosition] == selectedMux)
             {
                 /* Is this abstract key is needed by this rule? */
-                if (fmTreeFind(abstractKey, i, &nextValue) == FM_OK)
+                if (GetAbstractKey(abstractKey, i, &data))
                 {
                     /* Yes it is, configure the abstract value and mask to the
                      * key and keyMask at the proper position. */
-                    value = (fm_uintptr)nextValue & 0xff;
-                    mask  = ((fm_uintptr)nextValue & 0xff00) >> 8;
+                    value = data & 0xff;
+                    mask  = (data & 0xff00) >> 8;
                     *key |= (value << (muxPosition * 8));
                     *keyMask |= (mask << (muxPosition * 8));
                 }
@@ -2022,20 +2161,20 @@ static void ConfigureConditionKeyForMux(fm_byte     selectedMux,
          * occupy half of the whole key. */
         if (fmAbstractToConcrete4bits[i][muxPosition * 2] == selectedMux)
         {
-            if (fmTreeFind(abstractKey, i, &nextValue) == FM_OK)
+            if (GetAbstractKey(abstractKey, i, &data))
             {
-                value = (fm_uintptr)nextValue & 0xf;
-                mask  = ((fm_uintptr )nextValue & 0xf00) >> 8;
+                value = data & 0xf;
+                mask  = (data & 0xf00) >> 8;
                 *key |= (value << (muxPosition * 8));
                 *keyMask |= (mask << (muxPosition * 8));
             }
         }
         else if (fmAbstractToConcrete4bits[i][(muxPosition * 2) + 1] == selectedMux)
         {
-            if (fmTreeFind(abstractKey, i, &nextValue) == FM_OK)
+            if (GetAbstractKey(abstractKey, i, &data))
             {
-                value = (fm_uintptr)nextValue & 0xf;
-                mask  = ((fm_uintptr)nextValue & 0xf00) >> 8;
+                value = data & 0xf;
+                mask  = (data & 0xf00) >> 8;
                 *key |= (value << ((muxPosition * 8) + 4));
                 *keyMask |= (mask << ((muxPosition * 8) + 4));
             }
@@ -2193,7 +2332,8 @@ static fm_status AllocatePortSetId(fm_int                  sw,
                 if (fmTreeFind(&cacls->portSetId, key, &nextValue) ==
                     FM_ERR_NOT_FOUND)
                 {
-                    portSet = (fm_portSet *)fmAlloc(sizeof(fm_portSet));
+                    portSet = (fm_portSet *)fmAllocTagged(sizeof(fm_portSet),
+                                                          FM_LOG_CAT_ACL);
                     if (portSet == NULL)
                     {
                         err = FM_ERR_NO_MEM;
@@ -2321,12 +2461,14 @@ ABORT:
  *
  * \desc            Fill the compilation statistics.
  *
+ * \param[in]       sw is the switch on which to operate.
+ *
  * \param[in,out]   cacls points to the compiled ACL structure to modify.
  *
  * \return          None
  *
  *****************************************************************************/
-static void FillCompileStats(fm_fm10000CompiledAcls *cacls)
+static void FillCompileStats(fm_int sw, fm_fm10000CompiledAcls *cacls)
 {
     fm_treeIterator itAcl;
     fm_uint64 aclNumber;
@@ -2423,6 +2565,11 @@ static void FillCompileStats(fm_fm10000CompiledAcls *cacls)
         cacls->compilerStats.firstMinSliceUsed = firstSlice;
     }
 
+    cacls->compilerStats.nonDisruptRuleWrites = cacls->ndRuleWrites;
+    cacls->compilerStats.nonDisruptRuleMoves  = cacls->ndRuleMoves;
+
+    fm10000GetMapperStats(sw, &cacls->compilerStats);
+
 }   /* end FillCompileStats */
 
 
@@ -2481,19 +2628,729 @@ static void FormatCompileStats(fm_aclCompilerStats* cstats,
                            cstats->chunksUsed,
                            FM10000_FFU_EGRESS_CHUNK_VALID_ENTRIES);
 
-    if (cstats->aclsSkipped || cstats->rulesSkipped)
+    if (cstats->aclsSkipped || cstats->rulesSkipped)
+    {
+        fm10000FormatAclStatus(errReport,
+                               FALSE,
+                               "Skipped %u unassigned ACL%s "
+                               "and %u unassigned rule%s.\n",
+                               cstats->aclsSkipped,
+                               (cstats->aclsSkipped != 1) ? "s" : "",
+                               cstats->rulesSkipped,
+                               (cstats->rulesSkipped != 1) ? "s" : "");
+    }
+
+    if (cstats->nonDisruptRuleWrites)
+    {
+        fm10000FormatAclStatus(errReport,
+                               FALSE,
+                               "Non disruptive apply needs %u rule writes, "
+                               "%u of which move existing rules.\n",
+                               cstats->nonDisruptRuleWrites,
+                               cstats->nonDisruptRuleMoves);
+    }
+
+    if (cstats->l4SrcMapperSlots || cstats->l4DstMapperSlots)
+    {
+        fm10000FormatAclStatus(errReport,
+                               FALSE,
+                               "Used %u (out of %u) L4 source and %u (out "
+                               "of %u) L4 destination port mapper slots.\n"
+                               "Merged %u contiguous L4 port ranges, the "
+                               "mapper saves %u TCAM entries per rule set "
+                               "matching every range.\n",
+                               cstats->l4SrcMapperSlots,
+                               FM10000_FFU_MAP_L4_SRC_ENTRIES,
+                               cstats->l4DstMapperSlots,
+                               FM10000_FFU_MAP_L4_DST_ENTRIES,
+                               cstats->l4MapperRangesMerged,
+                               cstats->l4MapperTcamEntriesSaved);
+    }
+
+}   /* end FormatCompileStats */
+
+
+
+
+/*****************************************************************************/
+/** CompileIncremental
+ * \ingroup intAcl
+ *
+ * \desc            Compiles the ACL configuration incrementally. The applied
+ *                  ACL image is cloned and only the ACL rules added, removed
+ *                  or updated since the last apply are compiled into it by
+ *                  the non-disruptive compiler, so untouched ACLs keep their
+ *                  slices, keys and mappers. On success, the clone becomes
+ *                  the compiled ACL image.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   errReport is the object which accepts the status messages.
+ *
+ * \param[in]       flags is a bitmask. See ''ACL Compiler Flags''.
+ *
+ * \param[out]      value points to the compiler extended flags entered.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ * \return          FM_ERR_ACL_COMPILE if a full compilation is required
+ *                  because no ACL image is applied, ACL attributes or ports
+ *                  changed, or the changes do not fit in the current slice
+ *                  layout.
+ *
+ *****************************************************************************/
+static fm_status CompileIncremental(fm_int               sw,
+                                    fm_aclErrorReporter *errReport,
+                                    fm_uint32            flags,
+                                    void *               value)
+{
+    fm_switch *             switchPtr;
+    fm10000_switch *        switchExt;
+    fm_fm10000CompiledAcls *compiledClone;
+    fm_status               err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ACL,
+                 "sw = %d, flags = 0x%x, value = %p\n",
+                 sw,
+                 flags,
+                 value);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    switchExt = (fm10000_switch *) switchPtr->extension;
+
+    if ( (switchExt->appliedAcls == NULL) ||
+         (switchExt->appliedAcls->valid != TRUE) ||
+         switchPtr->aclInfo.layoutChanged )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ACL, FM_ERR_ACL_COMPILE);
+    }
+
+    compiledClone = CloneCompiledAcls(sw, switchExt->appliedAcls);
+    if (compiledClone == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ACL, FM_ERR_ACL_COMPILE);
+    }
+
+    err = fm10000NonDisruptCompile(sw, compiledClone, -1, FALSE);
+    if (err != FM_OK)
+    {
+        FreeCompiledAclsStruct(compiledClone);
+
+        if (err != FM_ERR_NO_MEM)
+        {
+            FM_LOG_DEBUG(FM_LOG_CAT_ACL,
+                         "Incremental compilation failed (%s), "
+                         "doing a full compilation\n",
+                         fmErrorMsg(err));
+            err = FM_ERR_ACL_COMPILE;
+        }
+        FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+    }
+
+    compiledClone->valid       = TRUE;
+    compiledClone->incremental = TRUE;
+
+    FillCompileStats(sw, compiledClone);
+
+    fm10000FormatAclStatus(errReport,
+                           FALSE,
+                           "Compiled incrementally.\n");
+    FormatCompileStats(&compiledClone->compilerStats, errReport);
+
+    if (flags & FM_ACL_COMPILE_FLAG_RETURN_STATS)
+    {
+        FM_MEMCPY_S( value,
+                     sizeof(fm_aclCompilerStats),
+                     &compiledClone->compilerStats,
+                     sizeof(fm_aclCompilerStats) );
+    }
+
+    FreeCompiledAclsStruct(switchExt->compiledAcls);
+    switchExt->compiledAcls = compiledClone;
+
+    FM_LOG_EXIT(FM_LOG_CAT_ACL, FM_OK);
+
+}   /* end CompileIncremental */
+
+
+
+
+/*****************************************************************************/
+/** SelectAclKeys
+ * \ingroup intAcl
+ *
+ * \desc            Selects the TCAM keys of an ingress ACL. The abstract keys
+ *                  needed by all the rules of the ACL are collected and
+ *                  converted into a concrete mux configuration.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   errReport is the object used to report compilation errors.
+ *
+ * \param[in]       acl points to the ACL whose keys are to be selected.
+ *
+ * \param[in,out]   portSetId points to the portSetId tree of the ACL.
+ *
+ * \param[out]      muxSelect points to the mux selection array to fill.
+ *
+ * \param[out]      muxUsed points to the mux usage array to fill.
+ *
+ * \param[out]      keyEnd points to caller-allocated storage where this
+ *                  function places the last condition slice of the ACL,
+ *                  counting from 0.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status SelectAclKeys(fm_int               sw,
+                               fm_aclErrorReporter *errReport,
+                               fm_acl *             acl,
+                               fm_tree *            portSetId,
+                               fm_byte *            muxSelect,
+                               fm_uint16 *          muxUsed,
+                               fm_byte *            keyEnd)
+{
+    fm_fm10000AbstractKey abstractKey;
+    fm_treeIterator       itRule;
+    fm_uint64             ruleNumber;
+    void *                nextValue;
+    fm_aclRule *          rule;
+    fm_status             err;
+
+    FM_CLEAR(abstractKey);
+
+    for (fmTreeIterInit(&itRule, &acl->rules) ;
+         (err = fmTreeIterNext(&itRule, &ruleNumber, &nextValue)) == FM_OK ; )
+    {
+        rule = (fm_aclRule *) nextValue;
+
+        err = fmFillAbstractKey(sw,
+                                errReport,
+                                rule,
+                                &abstractKey,
+                                portSetId);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+        err = fmFillAbstractPortSetKey(errReport,
+                                       rule,
+                                       NULL,
+                                       &abstractKey,
+                                       portSetId);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+    if (err != FM_ERR_NO_MORE)
+    {
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+
+    fmInitializeConcreteKey(muxSelect);
+
+    err = fmConvertAbstractToConcreteKey(&abstractKey, muxSelect, muxUsed);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+    *keyEnd = fmCountConditionSliceUsage(muxSelect) - 1;
+
+ABORT:
+
+    return err;
+
+}   /* end SelectAclKeys */
+
+
+
+
+/*****************************************************************************/
+/** ProcessAclKeyPool
+ * \ingroup intAcl
+ *
+ * \desc            Takes jobs from the pool and selects the keys of their
+ *                  ACL until every job has been handed out or a job has
+ *                  failed.
+ *
+ * \param[in]       pool points to the shared work state.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ProcessAclKeyPool(fm10000_aclKeyPool *pool)
+{
+    fm10000_aclKeyJob *  job;
+    fm_fm10000CompiledAcl *compiledAcl;
+    fm_aclErrorReporter  jobReport;
+
+    for ( ; ; )
+    {
+        fmCaptureLock(&pool->lock, FM_WAIT_FOREVER);
+
+        if ( (pool->status != FM_OK) ||
+             pool->jobFailed ||
+             (pool->nextJob >= pool->numJobs) )
+        {
+            fmReleaseLock(&pool->lock);
+            break;
+        }
+
+        job = &pool->jobs[pool->nextJob++];
+
+        fmReleaseLock(&pool->lock);
+
+        compiledAcl = job->compiledAcl;
+
+        fm10000InitAclErrorReporter(&jobReport,
+                                    job->statusText,
+                                    sizeof(job->statusText));
+
+        job->status = SelectAclKeys(pool->sw,
+                                    &jobReport,
+                                    job->acl,
+                                    compiledAcl->portSetId,
+                                    compiledAcl->muxSelect,
+                                    compiledAcl->muxUsed,
+                                    &compiledAcl->sliceInfo.keyEnd);
+        job->numErrors = jobReport.numErrors;
+
+        if (job->status != FM_OK)
+        {
+            fmCaptureLock(&pool->lock, FM_WAIT_FOREVER);
+            pool->jobFailed = TRUE;
+            fmReleaseLock(&pool->lock);
+        }
+    }
+
+}   /* end ProcessAclKeyPool */
+
+
+
+
+/*****************************************************************************/
+/** AclKeyTask
+ * \ingroup intAcl
+ *
+ * \desc            Worker thread that selects ACL keys on behalf of
+ *                  ''SelectAclKeysInParallel''.
+ *
+ * \param[in]       args contains a pointer to the thread information.
+ *
+ * \return          NULL.
+ *
+ *****************************************************************************/
+static void *AclKeyTask(void *args)
+{
+    fm_thread *         thread;
+    fm10000_aclKeyPool *pool;
+
+    thread = FM_GET_THREAD_HANDLE(args);
+    pool   = FM_GET_THREAD_PARAM(fm10000_aclKeyPool, args);
+
+    ProcessAclKeyPool(pool);
+
+    /* The pool may be gone once the semaphore has been released */
+    fmReleaseSemaphore(&pool->done);
+
+    fmExitThread(thread);
+
+    return NULL;
+
+}   /* end AclKeyTask */
+
+
+
+
+/*****************************************************************************/
+/** ValidateAclKeys
+ * \ingroup intAcl
+ *
+ * \desc            Selects the keys of an ACL again on the calling thread
+ *                  and checks that the result matches the one produced by
+ *                  a compiler worker thread.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       job points to the completed key selection job.
+ *
+ * \return          FM_OK if both selections match.
+ * \return          FM_ERR_ACL_COMPILE if they differ.
+ *
+ *****************************************************************************/
+static fm_status ValidateAclKeys(fm_int sw, fm10000_aclKeyJob *job)
+{
+    fm_fm10000CompiledAcl *compiledAcl;
+    fm_aclErrorReporter    report;
+    fm_tree                portSetId;
+    fm_treeIterator        itParallel;
+    fm_treeIterator        itSerial;
+    fm_uint64              keyParallel;
+    fm_uint64              keySerial;
+    void *                 value;
+    fm_byte                muxSelect[FM_FFU_SELECTS_PER_MINSLICE *
+                                     FM10000_FFU_SLICE_VALID_ENTRIES];
+    fm_uint16              muxUsed[FM10000_FFU_SLICE_VALID_ENTRIES];
+    fm_byte                keyEnd;
+    fm_status              err;
+    fm_status              errParallel;
+
+    compiledAcl = job->compiledAcl;
+
+    FM_CLEAR(muxSelect);
+    FM_CLEAR(muxUsed);
+    keyEnd = 0;
+
+    /* Start from the portSetId tree as it was before key selection */
+    fmTreeInit(&portSetId);
+
+    err = FM_OK;
+    if (job->acl->numberOfPorts[FM_ACL_TYPE_INGRESS])
+    {
+        err = fmTreeInsert(&portSetId, FM10000_SPECIAL_PORT_PER_ACL_KEY, NULL);
+    }
+
+    if (err == FM_OK)
+    {
+        fm10000InitAclErrorReporter(&report, NULL, 0);
+
+        err = SelectAclKeys(sw,
+                            &report,
+                            job->acl,
+                            &portSetId,
+                            muxSelect,
+                            muxUsed,
+                            &keyEnd);
+    }
+
+    if (err == FM_OK)
+    {
+        if ( (keyEnd != compiledAcl->sliceInfo.keyEnd) ||
+             (memcmp(muxSelect,
+                     compiledAcl->muxSelect,
+                     sizeof(muxSelect)) != 0) ||
+             (memcmp(muxUsed,
+                     compiledAcl->muxUsed,
+                     sizeof(muxUsed)) != 0) ||
+             (fmTreeSize(&portSetId) != fmTreeSize(compiledAcl->portSetId)) )
+        {
+            err = FM_ERR_ACL_COMPILE;
+        }
+    }
+
+    if (err == FM_OK)
+    {
+        fmTreeIterInit(&itSerial, &portSetId);
+        fmTreeIterInit(&itParallel, compiledAcl->portSetId);
+
+        while ( (err = fmTreeIterNext(&itSerial, &keySerial, &value)) == FM_OK )
+        {
+            errParallel = fmTreeIterNext(&itParallel, &keyParallel, &value);
+
+            if ( (errParallel != FM_OK) || (keyParallel != keySerial) )
+            {
+                err = FM_ERR_ACL_COMPILE;
+                break;
+            }
+        }
+
+        if (err == FM_ERR_NO_MORE)
+        {
+            err = FM_OK;
+        }
+    }
+
+    fmTreeDestroy(&portSetId, NULL);
+
+    if (err != FM_OK)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ACL,
+                     "Key selection of ACL %d by the compiler threads "
+                     "does not match the sequential one: %s\n",
+                     compiledAcl->aclNum,
+                     fmErrorMsg(err));
+        err = FM_ERR_ACL_COMPILE;
+    }
+
+    return err;
+
+}   /* end ValidateAclKeys */
+
+
+
+
+/*****************************************************************************/
+/** SelectAclKeysInParallel
+ * \ingroup intAcl
+ *
+ * \desc            Selects the keys of the ingress ACLs on a pool of
+ *                  threads, the calling thread included. Each ACL is
+ *                  handled by exactly one thread, and the outcome of the
+ *                  jobs is merged in ACL order so that the result is the
+ *                  same as with sequential selection.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   errReport is the object used to report compilation errors.
+ *
+ * \param[in,out]   jobs points to the key selection jobs, in ACL order.
+ *
+ * \param[in]       numJobs is the number of jobs.
+ *
+ * \param[in]       numThreads is the number of threads to use.
+ *
+ * \return          FM_OK if successful.
+ * \return          the status of the first failing job, in ACL order.
+ *
+ *****************************************************************************/
+static fm_status SelectAclKeysInParallel(fm_int               sw,
+                                         fm_aclErrorReporter *errReport,
+                                         fm10000_aclKeyJob *  jobs,
+                                         fm_int               numJobs,
+                                         fm_int               numThreads)
+{
+    fm10000_switch *   switchExt;
+    fm10000_aclKeyPool pool;
+    fm_status          err;
+    fm_int             numWorkers;
+    fm_int             i;
+    fm_char            threadName[32];
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ACL,
+                 "sw = %d, numJobs = %d, numThreads = %d\n",
+                 sw,
+                 numJobs,
+                 numThreads);
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    if (numThreads > FM10000_MAX_ACL_COMPILE_THREADS)
+    {
+        numThreads = FM10000_MAX_ACL_COMPILE_THREADS;
+    }
+
+    if (numThreads > numJobs)
+    {
+        numThreads = numJobs;
+    }
+
+    FM_CLEAR(pool);
+    pool.sw      = sw;
+    pool.jobs    = jobs;
+    pool.numJobs = numJobs;
+    pool.status  = FM_OK;
+
+    err = fmCreateLock("AclKeyPoolLock", &pool.lock);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+    err = fmCreateSemaphore("AclKeyPoolDone",
+                            FM_SEM_COUNTING,
+                            &pool.done,
+                            0);
+    if (err != FM_OK)
+    {
+        fmDeleteLock(&pool.lock);
+        FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+    }
+
+    /* The calling thread is one of the numThreads */
+    numWorkers = 0;
+    for (i = 0 ; i < numThreads - 1 ; i++)
+    {
+        FM_SPRINTF_S(threadName, sizeof(threadName), "AclCompile%d", i);
+
+        err = fmCreateThread(threadName,
+                             FM_EVENT_QUEUE_SIZE_NONE,
+                             AclKeyTask,
+                             &pool,
+                             &switchExt->aclCompileThreads[i]);
+        if (err != FM_OK)
+        {
+            /* Carry on with the threads we have */
+            FM_LOG_WARNING(FM_LOG_CAT_ACL,
+                           "Unable to create ACL compiler thread %d: %s\n",
+                           i,
+                           fmErrorMsg(err));
+            break;
+        }
+
+        numWorkers++;
+    }
+
+    ProcessAclKeyPool(&pool);
+
+    for (i = 0 ; i < numWorkers ; i++)
+    {
+        fmWaitSemaphore(&pool.done, FM_WAIT_FOREVER);
+    }
+
+    fmDeleteSemaphore(&pool.done);
+    fmDeleteLock(&pool.lock);
+
+    err = pool.status;
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+    /* Jobs are handed out in order, so every job ahead of a failed one has
+     * been completed: report the first failure in ACL order, as the
+     * sequential compiler would. */
+    for (i = 0 ; i < numJobs ; i++)
+    {
+        if (jobs[i].status != FM_OK)
+        {
+            fm10000FormatAclStatus(errReport,
+                                   (jobs[i].numErrors > 0),
+                                   "%s",
+                                   jobs[i].statusText);
+            FM_LOG_EXIT(FM_LOG_CAT_ACL, jobs[i].status);
+        }
+    }
+
+    if (GET_FM10000_PROPERTY()->aclCompileValidate)
+    {
+        for (i = 0 ; i < numJobs ; i++)
+        {
+            err = ValidateAclKeys(sw, &jobs[i]);
+            if (err != FM_OK)
+            {
+                fm10000FormatAclStatus(errReport,
+                                       TRUE,
+                                       "Parallel key selection of ACL %d "
+                                       "does not match sequential "
+                                       "selection.\n",
+                                       jobs[i].compiledAcl->aclNum);
+                break;
+            }
+        }
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+
+}   /* end SelectAclKeysInParallel */
+
+
+
+
+/*****************************************************************************/
+/** AddAclToInstance
+ * \ingroup intAcl
+ *
+ * \desc            Adds an ingress ACL to its ACL instance, if it belongs to
+ *                  one, creating the instance if needed.
+ *
+ * \param[in,out]   errReport is the object used to report compilation errors.
+ *
+ * \param[in,out]   cacls points to the compiled ACL structure.
+ *
+ * \param[in]       compiledAcl points to the compiled ACL whose slice range
+ *                  has been computed.
+ *
+ * \param[in]       previousInst is the instance of the previous ingress ACL,
+ *                  in ACL order.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ACL if the instance configuration is
+ *                  invalid.
+ *
+ *****************************************************************************/
+static fm_status AddAclToInstance(fm_aclErrorReporter *   errReport,
+                                  fm_fm10000CompiledAcls *cacls,
+                                  fm_fm10000CompiledAcl * compiledAcl,
+                                  fm_int                  previousInst)
+{
+    fm_fm10000CompiledAclInstance* compiledAclInst;
+    fm_status err = FM_OK;
+
+    if (compiledAcl->aclInstance == FM_ACL_NO_INSTANCE)
+    {
+        return FM_OK;
+    }
+
+    if (compiledAcl->aclInstance < 0)
+    {
+        fm10000FormatAclStatus(errReport, TRUE,
+                               "Invalid Instance selected for ACL %d.\n",
+                               compiledAcl->aclNum);
+        err = FM_ERR_INVALID_ACL;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+
+    err = fmTreeFind(&cacls->instance,
+                     compiledAcl->aclInstance,
+                     (void**) &compiledAclInst);
+    if (err == FM_ERR_NOT_FOUND)
+    {
+        /* First user of this instance must create it */
+        compiledAclInst = fmAllocTagged(sizeof(fm_fm10000CompiledAclInstance),
+                                        FM_LOG_CAT_ACL);
+        if (compiledAclInst == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+        }
+        FM_CLEAR(*compiledAclInst);
+        fmTreeInit(&compiledAclInst->acl);
+
+        err = fmTreeInsert(&cacls->instance,
+                           compiledAcl->aclInstance,
+                           compiledAclInst);
+        if (err != FM_OK)
+        {
+            fmFreeCompiledAclInstance(compiledAclInst);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+        }
+    }
+    else if (err != FM_OK)
+    {
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+    else if (previousInst != compiledAcl->aclInstance)
+    {
+        fm10000FormatAclStatus(errReport, TRUE,
+                               "Instance %d must only contains "
+                               "consecutive ACL Id.\n",
+                               compiledAcl->aclInstance);
+        err = FM_ERR_INVALID_ACL;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+
+    /* Add this ACL to be part of the instance */
+    err = fmTreeInsert(&compiledAclInst->acl,
+                       FM_ACL_GET_MASTER_KEY(compiledAcl->aclNum),
+                       compiledAcl);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+    /* Validates the scenario to be mutually exclusive with all the
+     * others already defined. */
+    if (compiledAclInst->sliceInfo.validScenarios &
+        compiledAcl->sliceInfo.validScenarios)
     {
-        fm10000FormatAclStatus(errReport,
-                               FALSE,
-                               "Skipped %u unassigned ACL%s "
-                               "and %u unassigned rule%s.\n",
-                               cstats->aclsSkipped,
-                               (cstats->aclsSkipped != 1) ? "s" : "",
-                               cstats->rulesSkipped,
-                               (cstats->rulesSkipped != 1) ? "s" : "");
+        fm10000FormatAclStatus(errReport, TRUE,
+                               "Instance %d specify ACLs with non "
+                               "mutually exclusive scenarios.\n",
+                               compiledAcl->aclInstance);
+        err = FM_ERR_INVALID_ACL;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
     }
 
-}   /* end FormatCompileStats */
+    /* The instance scenario contains all the individual one. */
+    compiledAclInst->sliceInfo.validScenarios |= compiledAcl->sliceInfo.validScenarios;
+
+    /* Slice Range used by the instance is the maximum of all the ACLs
+     * that belongs to this instance. Slice range does not includes
+     * case selection key at this point. */
+    if (compiledAcl->sliceInfo.keyEnd > compiledAclInst->sliceInfo.keyEnd)
+    {
+        compiledAclInst->sliceInfo.keyEnd = compiledAcl->sliceInfo.keyEnd;
+    }
+
+    if (compiledAcl->sliceInfo.actionEnd > compiledAclInst->sliceInfo.actionEnd)
+    {
+        compiledAclInst->sliceInfo.actionEnd = compiledAcl->sliceInfo.actionEnd;
+    }
+
+    /* Update the total number of rules that belongs to this
+     * instance. */
+    compiledAclInst->numRules += compiledAcl->numRules;
+
+ABORT:
+
+    return err;
+
+}   /* end AddAclToInstance */
 
 
 
@@ -2530,7 +3387,7 @@ static fm_status AddAclRouteElement(fm_tree* ecmpGroups,
     /* Create the list */
     if (err == FM_ERR_NOT_FOUND)
     {
-        ecmpList = (fm_dlist *) fmAlloc(sizeof(fm_dlist));
+        ecmpList = (fm_dlist *) fmAllocTagged(sizeof(fm_dlist), FM_LOG_CAT_ACL);
         if (ecmpList == NULL)
         {
             err = FM_ERR_NO_MEM;
@@ -2552,7 +3409,8 @@ static fm_status AddAclRouteElement(fm_tree* ecmpGroups,
     /* Add elements to the list */
     if (err == FM_OK)
     {
-        ecmpRule = (fm_fm10000AclRule *) fmAlloc(sizeof(fm_fm10000AclRule));
+        ecmpRule = (fm_fm10000AclRule *) fmAllocTagged(sizeof(fm_fm10000AclRule),
+                                                       FM_LOG_CAT_ACL);
         if (ecmpRule == NULL)
         {
             err = FM_ERR_NO_MEM;
@@ -2624,7 +3482,8 @@ static fm_status BreakCompiledAcl(fm_fm10000CompiledAcls *cacls,
 
     for (; parts > 0 ; parts--)
     {
-        compiledAclParts = fmAlloc(sizeof(fm_fm10000CompiledAcl));
+        compiledAclParts = fmAllocTagged(sizeof(fm_fm10000CompiledAcl),
+                                         FM_LOG_CAT_ACL);
         if (compiledAclParts == NULL)
         {
             err = FM_ERR_NO_MEM;
@@ -2949,9 +3808,9 @@ void fmFreeCompiledPolicerEntry(void *value)
 /** fmAddAbstractKey
  * \ingroup intAcl
  *
- * \desc            Fill the abstract key tree with all the required key.
+ * \desc            Fill the abstract key set with all the required key.
  *
- * \param[in,out]   abstractKey points to the abstract key tree to fill.
+ * \param[in,out]   abstractKey points to the abstract key set to fill.
  *
  * \param[in]       firstAbstract is the first abstract key for this particular
  *                  condition. The mask associated with this key are the
@@ -2971,14 +3830,13 @@ void fmFreeCompiledPolicerEntry(void *value)
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
-fm_status fmAddAbstractKey(fm_tree * abstractKey,
-                           fm_byte   firstAbstract,
-                           fm_byte   lastAbstract,
-                           fm_byte   bitsPerKey,
-                           fm_uint64 mask,
-                           fm_uint64 value)
+fm_status fmAddAbstractKey(fm_fm10000AbstractKey *abstractKey,
+                           fm_byte                firstAbstract,
+                           fm_byte                lastAbstract,
+                           fm_byte                bitsPerKey,
+                           fm_uint64              mask,
+                           fm_uint64              value)
 {
-    fm_status err;
     fm_byte currentAbstract;
     fm_byte maskPerKey;
 
@@ -2998,17 +3856,10 @@ fm_status fmAddAbstractKey(fm_tree * abstractKey,
         /* Is this 4 or 8 bits key needed? */
         if (mask & maskPerKey)
         {
-            /* Keep the abstract key value and mask as node data. */
-            err = fmTreeInsert(abstractKey,
-                               currentAbstract,
-                               (void*) ((fm_uintptr)((mask & maskPerKey) << 8) |
-                                        (fm_uintptr)(value & maskPerKey)));
-            if (err == FM_ERR_ALREADY_EXISTS)
-            {
-                err = FM_OK;
-            }
-            FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ACL, err);
-
+            SetAbstractKey(abstractKey,
+                           currentAbstract,
+                           mask & maskPerKey,
+                           value & maskPerKey);
         }
         mask >>= bitsPerKey;
         value >>= bitsPerKey;
@@ -3024,9 +3875,9 @@ fm_status fmAddAbstractKey(fm_tree * abstractKey,
 /** fmAddIpAbstractKey
  * \ingroup intAcl
  *
- * \desc            Fill the abstract key tree with all the IP required key.
+ * \desc            Fill the abstract key set with all the IP required key.
  *
- * \param[in,out]   abstractKey points to the abstract key tree to fill.
+ * \param[in,out]   abstractKey points to the abstract key set to fill.
  *
  * \param[in]       firstAbstract is the first IP abstract key for this
  *                  particular condition.
@@ -3039,12 +3890,11 @@ fm_status fmAddAbstractKey(fm_tree * abstractKey,
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
-fm_status fmAddIpAbstractKey(fm_tree * abstractKey,
-                             fm_byte   firstAbstract,
-                             fm_ipAddr mask,
-                             fm_ipAddr value)
+fm_status fmAddIpAbstractKey(fm_fm10000AbstractKey *abstractKey,
+                             fm_byte                firstAbstract,
+                             fm_ipAddr              mask,
+                             fm_ipAddr              value)
 {
-    fm_status err;
     fm_byte currentAbstract;
     fm_int FourBytesBlocks;
     fm_int i;
@@ -3074,16 +3924,10 @@ fm_status fmAddIpAbstractKey(fm_tree * abstractKey,
         {
             if (maskWord & 0xff)
             {
-                err = fmTreeInsert(abstractKey,
-                                   currentAbstract,
-                                   (void*) (((maskWord & 0xff) << 8) |
-                                           (valueWord & 0xff)));
-                if (err == FM_ERR_ALREADY_EXISTS)
-                {
-                    err = FM_OK;
-                }
-                FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ACL, err);
-
+                SetAbstractKey(abstractKey,
+                               currentAbstract,
+                               maskWord & 0xff,
+                               valueWord & 0xff);
             }
             maskWord >>= FM10000_8BITS_ABSTRACT_KEY;
             valueWord >>= FM10000_8BITS_ABSTRACT_KEY;
@@ -3100,9 +3944,9 @@ fm_status fmAddIpAbstractKey(fm_tree * abstractKey,
 /** fmAddDeepInsAbstractKey
  * \ingroup intAcl
  *
- * \desc            Fill the abstract key tree with all the required key.
+ * \desc            Fill the abstract key set with all the required key.
  *
- * \param[in,out]   abstractKey points to the abstract key tree to fill.
+ * \param[in,out]   abstractKey points to the abstract key set to fill.
  *
  * \param[in]       abstractTable points to the abstract sorted list of the
  *                  data channel used to store this specific deep inspection
@@ -3118,30 +3962,19 @@ fm_status fmAddIpAbstractKey(fm_tree * abstractKey,
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
-fm_status fmAddDeepInsAbstractKey(fm_tree * abstractKey,
-                                  fm_byte * abstractTable,
-                                  fm_byte   tableSize,
-                                  fm_byte * mask,
-                                  fm_byte * value)
+fm_status fmAddDeepInsAbstractKey(fm_fm10000AbstractKey *abstractKey,
+                                  fm_byte *              abstractTable,
+                                  fm_byte                tableSize,
+                                  fm_byte *              mask,
+                                  fm_byte *              value)
 {
-    fm_status err;
     fm_int    i;
 
     for (i = 0 ; i < tableSize ; i++)
     {
         if (mask[i])
         {
-            /* Keep the abstract key value and mask as node data. */
-            err = fmTreeInsert(abstractKey,
-                               abstractTable[i],
-                               (void*) ((fm_uintptr)(mask[i] << 8) |
-                                        (fm_uintptr)(value[i])));
-            if (err == FM_ERR_ALREADY_EXISTS)
-            {
-                err = FM_OK;
-            }
-            FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ACL, err);
-
+            SetAbstractKey(abstractKey, abstractTable[i], mask[i], value[i]);
         }
     }
 
@@ -3153,11 +3986,11 @@ fm_status fmAddDeepInsAbstractKey(fm_tree * abstractKey,
 
 
 /*****************************************************************************/
-/** fmFillAbstractPortSetKeyTree
+/** fmFillAbstractPortSetKey
  * \ingroup intAcl
  *
  * \desc            Add all the portSet related abstract key from this
- *                  particular rule to the acl abstract tree.
+ *                  particular rule to the acl abstract key set.
  *
  * \param[in,out]   errReport is the object used to report compilation errors.
  *
@@ -3165,10 +3998,10 @@ fm_status fmAddDeepInsAbstractKey(fm_tree * abstractKey,
  *                  a portSet condition that may needs to be translated.
  *
  * \param[in,out]   compiledAclRule points to the compiled acl structure to
- *                  update. If NULL, the abstractKey tree will be filled
+ *                  update. If NULL, the abstractKey set will be filled
  *                  with MAP_SRC key with no specific data.
  *
- * \param[in,out]   abstractKey points to the abstract key tree to fill.
+ * \param[in,out]   abstractKey points to the abstract key set to fill.
  *
  * \param[in,out]   portSetId points to the portSetId tree that represent the
  *                  configured acl. This tree also contain the determined
@@ -3177,11 +4010,11 @@ fm_status fmAddDeepInsAbstractKey(fm_tree * abstractKey,
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
-fm_status fmFillAbstractPortSetKeyTree(fm_aclErrorReporter *      errReport,
-                                       fm_aclRule *               rule,
-                                       fm_fm10000CompiledAclRule *compiledAclRule,
-                                       fm_tree *                  abstractKey,
-                                       fm_tree *                  portSetId)
+fm_status fmFillAbstractPortSetKey(fm_aclErrorReporter *      errReport,
+                                   fm_aclRule *               rule,
+                                   fm_fm10000CompiledAclRule *compiledAclRule,
+                                   fm_fm10000AbstractKey *    abstractKey,
+                                   fm_tree *                  portSetId)
 {
     void *found;
     fm_aclCondition cond = rule->cond;
@@ -3257,19 +4090,18 @@ ABORT:
 
     return err;
 
-}   /* end fmFillAbstractPortSetKeyTree */
+}   /* end fmFillAbstractPortSetKey */
 
 
 
 
 /*****************************************************************************/
-/** fmFillAbstractKeyTree
+/** fmFillAbstractKey
  * \ingroup intAcl
  *
  * \desc            Add all the required abstract key from this particular
- *                  rule to the acl abstract tree. The tree functionality
- *                  also make sure that no more then one occurence of each key
- *                  is present in the structure. This function is also
+ *                  rule to the acl abstract key set. The set only keeps
+ *                  the first occurence of each key. This function is also
  *                  responsable to fill the acl portSetId tree.
  *
  * \param[in]       sw is the switch on which to operate.
@@ -3279,18 +4111,18 @@ ABORT:
  * \param[in]       rule points to the defined acl rule that contain all the
  *                  condition that needs to be translated in abstract key.
  *
- * \param[in,out]   abstractKey points to the abstract key tree to fill.
+ * \param[in,out]   abstractKey points to the abstract key set to fill.
  *
  * \param[in,out]   portSetId points to the portSetId tree to fill.
  * 
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
-fm_status fmFillAbstractKeyTree(fm_int               sw,
-                                fm_aclErrorReporter *errReport,
-                                fm_aclRule *         rule,
-                                fm_tree *            abstractKey,
-                                fm_tree *            portSetId)
+fm_status fmFillAbstractKey(fm_int                 sw,
+                            fm_aclErrorReporter *  errReport,
+                            fm_aclRule *           rule,
+                            fm_fm10000AbstractKey *abstractKey,
+                            fm_tree *              portSetId)
 {
     void *found;
     fm_aclCondition cond = rule->cond;
@@ -3961,7 +4793,7 @@ fm_status fmFillAbstractKeyTree(fm_int               sw,
 
     return err;
 
-}   /* end fmFillAbstractKeyTree */
+}   /* end fmFillAbstractKey */
 
 
 
@@ -4039,7 +4871,7 @@ void fmInitializeConcreteKey(fm_byte *muxSelect)
  *                  key will be processed first down to the easier one that
  *                  can be fit in almost any mux.
  *
- * \param[in]       abstractKeyTree point to the abstract key tree to convert.
+ * \param[in]       abstractKey point to the abstract key set to convert.
  *
  * \param[in,out]   muxSelect points to the acl structure to fill
  *                  with the proper mux configuration.
@@ -4050,81 +4882,80 @@ void fmInitializeConcreteKey(fm_byte *muxSelect)
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
-fm_status fmConvertAbstractToConcreteKey(fm_tree *   abstractKeyTree,
-                                         fm_byte *   muxSelect,
-                                         fm_uint16 * muxUsed)
+fm_status fmConvertAbstractToConcreteKey(fm_fm10000AbstractKey *abstractKey,
+                                         fm_byte *              muxSelect,
+                                         fm_uint16 *            muxUsed)
 {
-    fm_treeIterator itKey;
-    fm_uint64       abstractKey;
-    void *          nextValue;
-    fm_status       err;
+    fm_uint64       used;
+    fm_uint64       key;
+    fm_status       err = FM_OK;
+    fm_int          word;
     fm_int          i;
 
-    /* Process all the abstract key that was previously inserted in the tree. */
-    for (fmTreeIterInit(&itKey, abstractKeyTree) ;
-         (err = fmTreeIterNext(&itKey, &abstractKey, &nextValue)) == FM_OK ; )
+    /* Process all the abstract key that were previously added to the set,
+     * in increasing order. */
+    for (word = 0 ; word < FM10000_ABSTRACT_KEY_WORDS ; word++)
     {
-        /* 8 bits key */
-        if (abstractKey < FM10000_FIRST_4BITS_ABSTRACT_KEY)
+        for (used = abstractKey->used[word] ; used != 0 ; used &= used - 1)
         {
-            /* Try to find a free position for this key and configure the mux
-             * accordingly. */
-            for (i = 0 ; i < FM10000_FFU_SLICE_VALID_ENTRIES ; i++)
+            key = (word * 64) + __builtin_ctzll(used);
+
+            /* 8 bits key */
+            if (key < FM10000_FIRST_4BITS_ABSTRACT_KEY)
             {
-                if (FoundFree8BitsMux(abstractKey,
-                                      &muxSelect[i * FM_FFU_SELECTS_PER_MINSLICE],
-                                      &muxUsed[i]))
+                /* Try to find a free position for this key and configure
+                 * the mux accordingly. */
+                for (i = 0 ; i < FM10000_FFU_SLICE_VALID_ENTRIES ; i++)
                 {
-                    break;
-                }
-            }
-        }
-        /* 4 bits key */
-        else
-        {
-            /* If the abstract 4 bits key needed is already configure as part
-             * of a 8 bits key then no need to add another key. We may needs
-             * to set the proper 4 bits usage. */
-            for (i = 0 ; i < FM10000_FFU_SLICE_VALID_ENTRIES ; i++)
-            {
-                if (FoundExisting8BitsMux(abstractKey,
+                    if (FoundFree8BitsMux(key,
                                           &muxSelect[i * FM_FFU_SELECTS_PER_MINSLICE],
                                           &muxUsed[i]))
-                {
-                    break;
+                    {
+                        break;
+                    }
                 }
             }
-
-            /* This abstract 4 bits key was not found as a subset of a 8 bits
-             * key, we now need to try to find a free position for this key and
-             * configure the mux accordingly. Note that the top position is prefer
-             * against all the other 8 bits key. */
-            if (i == FM10000_FFU_SLICE_VALID_ENTRIES)
+            /* 4 bits key */
+            else
             {
+                /* If the abstract 4 bits key needed is already configure as
+                 * part of a 8 bits key then no need to add another key. We
+                 * may needs to set the proper 4 bits usage. */
                 for (i = 0 ; i < FM10000_FFU_SLICE_VALID_ENTRIES ; i++)
                 {
-                    if (FoundFree4BitsMux(abstractKey,
-                                          &muxSelect[i * FM_FFU_SELECTS_PER_MINSLICE],
-                                          &muxUsed[i]))
+                    if (FoundExisting8BitsMux(key,
+                                              &muxSelect[i * FM_FFU_SELECTS_PER_MINSLICE],
+                                              &muxUsed[i]))
                     {
                         break;
                     }
                 }
+
+                /* This abstract 4 bits key was not found as a subset of a
+                 * 8 bits key, we now need to try to find a free position for
+                 * this key and configure the mux accordingly. Note that the
+                 * top position is prefer against all the other 8 bits key. */
+                if (i == FM10000_FFU_SLICE_VALID_ENTRIES)
+                {
+                    for (i = 0 ; i < FM10000_FFU_SLICE_VALID_ENTRIES ; i++)
+                    {
+                        if (FoundFree4BitsMux(key,
+                                              &muxSelect[i * FM_FFU_SELECTS_PER_MINSLICE],
+                                              &muxUsed[i]))
+                        {
+                            break;
+                        }
+                    }
+                }
+            }
+            /* Did not find a free position for this abstract key. */
+            if (i == FM10000_FFU_SLICE_VALID_ENTRIES)
+            {
+                err = FM_ERR_ACLS_TOO_BIG;
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
             }
         }
-        /* Did not find a free position for this abstract key. */
-        if (i == FM10000_FFU_SLICE_VALID_ENTRIES)
-        {
-            err = FM_ERR_ACLS_TOO_BIG;
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-        }
-    }
-
-    if (err != FM_ERR_NO_MORE)
-    {
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
     }
-    err = FM_OK;
 
 ABORT:
 
@@ -4323,7 +5154,7 @@ fm_status fmConfigureConditionKey(fm_int                         sw,
     fm_int numConditionSlice;
     fm_fm10000CompiledAclRule *compiledAclRule;
     void *nextValue;
-    fm_tree abstractKey;
+    fm_fm10000AbstractKey abstractKey;
     fm_int i;
     fm_byte caseValue = 0;
     fm_byte caseMask = 0;
@@ -4337,30 +5168,22 @@ fm_status fmConfigureConditionKey(fm_int                         sw,
 
     compiledAclRule = (fm_fm10000CompiledAclRule *) nextValue;
 
-    fmTreeInit(&abstractKey);
+    FM_CLEAR(abstractKey);
 
     /* Fill the abstract key based on the requirement of this specific rule. */
-    err = fmFillAbstractKeyTree(sw,
-                                errReport,
-                                rule,
-                                &abstractKey,
-                                compiledAcl->portSetId);
-    if (err != FM_OK)
-    {
-        fmTreeDestroy(&abstractKey, NULL);
-        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ACL, err);
-    }
+    err = fmFillAbstractKey(sw,
+                            errReport,
+                            rule,
+                            &abstractKey,
+                            compiledAcl->portSetId);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-    err = fmFillAbstractPortSetKeyTree(errReport,
-                                       rule,
-                                       compiledAclRule,
-                                       &abstractKey,
-                                       compiledAcl->portSetId);
-    if (err != FM_OK)
-    {
-        fmTreeDestroy(&abstractKey, NULL);
-        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ACL, err);
-    }
+    err = fmFillAbstractPortSetKey(errReport,
+                                   rule,
+                                   compiledAclRule,
+                                   &abstractKey,
+                                   compiledAcl->portSetId);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ACL, err);
 
     /* Case is shared among multiple mutually exclusive scenarios? */
     if ( (compiledAclInst != NULL) &&
@@ -4424,8 +5247,6 @@ fm_status fmConfigureConditionKey(fm_int                         sw,
         }
     }
 
-    fmTreeDestroy(&abstractKey, NULL);
-
     return err;
 
 }   /* end fmConfigureConditionKey */
@@ -5436,7 +6257,7 @@ fm_status fmConvertAclPortToPortSet(fm_int                 sw,
 
     acl = (fm_acl *) nextValue;
 
-    portSet = (fm_portSet *)fmAlloc(sizeof(fm_portSet));
+    portSet = (fm_portSet *)fmAllocTagged(sizeof(fm_portSet), FM_LOG_CAT_ACL);
     if (portSet == NULL)
     {
         err = FM_ERR_NO_MEM;
@@ -6191,6 +7012,133 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** CompactAclPart
+ * \ingroup intAcl
+ *
+ * \desc            Slides the rules of an applied ingress ACL part down to
+ *                  the bottom of its slices, closing the holes left between
+ *                  them. Rules keep their relative order and each run of
+ *                  adjacent rules is moved with a single FFU move.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       compiledAcl points to the ingress ACL part to compact.
+ *
+ * \param[in,out]   budget points to the number of rules that may still be
+ *                  moved. It is decremented for each rule moved.
+ *
+ * \param[in,out]   numMoved points to the count of rules moved. It is
+ *                  incremented for each rule moved.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if the rules are not in position order.
+ *
+ *****************************************************************************/
+static fm_status CompactAclPart(fm_int                 sw,
+                                fm_fm10000CompiledAcl *compiledAcl,
+                                fm_int *               budget,
+                                fm_int *               numMoved)
+{
+    fm_status err = FM_OK;
+    fm_fm10000CompiledAclRule *compiledAclRule;
+    fm_treeIterator itRule;
+    fm_uint64 ruleNumber;
+    void *nextValue;
+    fm_int nextPhysical;
+    fm_int physicalPos;
+    fm_int runSrc;
+    fm_int runDst;
+    fm_int runLen;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ACL,
+                 "sw = %d, compiledAcl = %p, budget = %d\n",
+                 sw,
+                 (void*) compiledAcl,
+                 *budget);
+
+    nextPhysical = 0;
+    runSrc = 0;
+    runDst = 0;
+    runLen = 0;
+
+    /* The last rule sits at position 0, so walking the rules backward
+     * visits the positions in increasing order. */
+    for (fmTreeIterInitBackwards(&itRule, &compiledAcl->rules) ;
+         (err = fmTreeIterNext(&itRule, &ruleNumber, &nextValue)) == FM_OK ; )
+    {
+        compiledAclRule = (fm_fm10000CompiledAclRule*) nextValue;
+        physicalPos = compiledAclRule->physicalPos;
+
+        if (physicalPos < nextPhysical)
+        {
+            err = FM_FAIL;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+        }
+
+        /* This rule does not extend the pending run, move that run now. */
+        if ( (runLen > 0) && (physicalPos != (runSrc + runLen)) )
+        {
+            err = fm10000MoveFFURules(sw,
+                                      &compiledAcl->sliceInfo,
+                                      runSrc,
+                                      runLen,
+                                      runDst);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+            *numMoved += runLen;
+            runLen = 0;
+        }
+
+        if (physicalPos == nextPhysical)
+        {
+            nextPhysical++;
+            continue;
+        }
+
+        if (*budget == 0)
+        {
+            break;
+        }
+
+        if (runLen == 0)
+        {
+            runSrc = physicalPos;
+            runDst = nextPhysical;
+        }
+
+        runLen++;
+        (*budget)--;
+        compiledAclRule->physicalPos = nextPhysical++;
+    }
+
+    if ( (err != FM_OK) && (err != FM_ERR_NO_MORE) )
+    {
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+    err = FM_OK;
+
+    if (runLen > 0)
+    {
+        err = fm10000MoveFFURules(sw,
+                                  &compiledAcl->sliceInfo,
+                                  runSrc,
+                                  runLen,
+                                  runDst);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+        *numMoved += runLen;
+    }
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+
+}   /* end CompactAclPart */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -6346,7 +7294,7 @@ fm_status fm10000ACLCompile(fm_int    sw,
     fm_uint64 ruleNumber;
     fm_fm10000CompiledAcl* compiledAcl;
     fm_fm10000CompiledAclRule* compiledAclRule;
-    fm_tree abstractKey;
+    fm_fm10000AbstractKey abstractKey;
     fm_int  actionSlices;
     fm_int  maxActionSlices;
     fm_int  firstAclSlice;
@@ -6373,6 +7321,10 @@ fm_status fm10000ACLCompile(fm_int    sw,
     fm_bool strictCount;
     fm_int internalAcl;
     fm_bool egressAcl;
+    fm_int numThreads;
+    fm_bool deferKeys;
+    fm10000_aclKeyJob *keyJobs = NULL;
+    fm_int numKeyJobs = 0;
 
     FM_LOG_ENTRY(FM_LOG_CAT_ACL,
                  "sw = %d, "
@@ -6438,7 +7390,7 @@ fm_status fm10000ACLCompile(fm_int    sw,
                                            FALSE);
             if (err == FM_OK)
             {
-                FillCompileStats(compiledClone);
+                FillCompileStats(sw, compiledClone);
 
                 /**************************************************
                 * Print statistics on success, such as the number
@@ -6475,9 +7427,26 @@ fm_status fm10000ACLCompile(fm_int    sw,
         FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
     }
 
+    /* Incremental compilation falls back to the full one below when the
+     * changes can not be compiled into the applied image. */
+    if ( (flags & FM_ACL_COMPILE_FLAG_INCREMENTAL) &&
+         !(flags & FM_ACL_COMPILE_FLAG_TRY_ALLOC) )
+    {
+        err = CompileIncremental(sw, &errReport, flags, value);
+        if (err == FM_OK)
+        {
+            FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+        }
+        else if (err != FM_ERR_ACL_COMPILE)
+        {
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+        }
+        err = FM_OK;
+    }
+
     /* If non disruptive failed, try compiling it from scratch */
     caclsRetry = (fm_fm10000CompiledAcls *)
-        fmAlloc( sizeof(fm_fm10000CompiledAcls) );
+        fmAllocTagged( sizeof(fm_fm10000CompiledAcls), FM_LOG_CAT_ACL );
 
     if (caclsRetry == NULL)
     {
@@ -6501,6 +7470,27 @@ fm_status fm10000ACLCompile(fm_int    sw,
     err = fmTreeValidate(&info->acls);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
+    /* With several compiler threads, the keys of the ingress ACLs are
+     * selected once all of them have been pre-processed. */
+    numThreads = GET_FM10000_PROPERTY()->aclCompileThreads;
+    deferKeys  = ( (numThreads > 1) && (fmTreeSize(&info->acls) > 1) );
+
+    if (deferKeys)
+    {
+        keyJobs = fmAllocTagged(fmTreeSize(&info->acls) *
+                                    sizeof(fm10000_aclKeyJob),
+                                FM_LOG_CAT_ACL);
+        if (keyJobs == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+        }
+        FM_MEMSET_S( keyJobs,
+                     fmTreeSize(&info->acls) * sizeof(fm10000_aclKeyJob),
+                     0,
+                     fmTreeSize(&info->acls) * sizeof(fm10000_aclKeyJob) );
+    }
+
     previousInst = FM_ACL_NO_INSTANCE;
     /**************************************************
      * Pre-process each ACL in the configuration.
@@ -6510,7 +7500,7 @@ fm_status fm10000ACLCompile(fm_int    sw,
     {
         /* abstractKey is used to store all the 4 or 8 bits abstract key
          * needed by each ACL. */
-        fmTreeInit(&abstractKey);
+        FM_CLEAR(abstractKey);
         acl = (fm_acl *) nextValue;
 
         /* ACL with no rule will be skip. */
@@ -6529,7 +7519,7 @@ fm_status fm10000ACLCompile(fm_int    sw,
             continue;
         }
 
-        compiledAcl = fmAlloc(sizeof(fm_fm10000CompiledAcl));
+        compiledAcl = fmAllocTagged(sizeof(fm_fm10000CompiledAcl), FM_LOG_CAT_ACL);
         if (compiledAcl == NULL)
         {
             err = FM_ERR_NO_MEM;
@@ -6552,7 +7542,7 @@ fm_status fm10000ACLCompile(fm_int    sw,
 
         fmTreeInit(&compiledAcl->rules);
 
-        compiledAcl->portSetId = fmAlloc(sizeof(fm_tree));
+        compiledAcl->portSetId = fmAllocTagged(sizeof(fm_tree), FM_LOG_CAT_ACL);
         if (compiledAcl->portSetId == NULL)
         {
             fmFree(compiledAcl);
@@ -6581,7 +7571,6 @@ fm_status fm10000ACLCompile(fm_int    sw,
             err = fmTreeInsert(&caclsRetry->egressAcl, aclNumber, compiledAcl);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-            fmTreeDestroy(&abstractKey, NULL);
             continue;
         }
         else
@@ -6617,7 +7606,8 @@ fm_status fm10000ACLCompile(fm_int    sw,
         {
             rule = (fm_aclRule *) nextValue;
 
-            compiledAclRule = fmAlloc(sizeof(fm_fm10000CompiledAclRule));
+            compiledAclRule = fmAllocTagged(sizeof(fm_fm10000CompiledAclRule),
+                                            FM_LOG_CAT_ACL);
             if (compiledAclRule == NULL)
             {
                 err = FM_ERR_NO_MEM;
@@ -6635,22 +7625,26 @@ fm_status fm10000ACLCompile(fm_int    sw,
                                compiledAclRule);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-            /* The abstract key tree contains all the abstract keys needed for
-             * the whole ACL except for the key related to the port selection.*/
-            err = fmFillAbstractKeyTree(sw,
+            if (!deferKeys)
+            {
+                /* The abstract key set contains all the abstract keys needed
+                 * for the whole ACL except for the key related to the port
+                 * selection.*/
+                err = fmFillAbstractKey(sw,
                                         &errReport,
                                         rule,
                                         &abstractKey,
                                         compiledAcl->portSetId);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-            /* Add key related to the port selection */
-            err = fmFillAbstractPortSetKeyTree(&errReport,
+                /* Add key related to the port selection */
+                err = fmFillAbstractPortSetKey(&errReport,
                                                rule,
                                                NULL,
                                                &abstractKey,
                                                compiledAcl->portSetId);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+            }
 
             err = fm10000CountActionSlicesNeeded(sw,
                                                  &errReport,
@@ -6691,6 +7685,17 @@ fm_status fm10000ACLCompile(fm_int    sw,
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
         }
 
+        /* The keys of this ACL will be selected by the worker threads */
+        if (deferKeys)
+        {
+            keyJobs[numKeyJobs].acl             = acl;
+            keyJobs[numKeyJobs].compiledAcl     = compiledAcl;
+            keyJobs[numKeyJobs].maxActionSlices = maxActionSlices;
+            numKeyJobs++;
+
+            continue;
+        }
+
         fmInitializeConcreteKey(compiledAcl->muxSelect);
 
         /* Convert all the abstract key needed for this ACL into a concrete set
@@ -6709,98 +7714,12 @@ fm_status fm10000ACLCompile(fm_int    sw,
         compiledAcl->sliceInfo.actionEnd = compiledAcl->sliceInfo.keyEnd +
                                            maxActionSlices - 1;
 
-        /* The abstract key tree is only valid for each independent ACL. */
-        fmTreeDestroy(&abstractKey, NULL);
-
         /* Process instance specific functionality */
-        if (compiledAcl->aclInstance != FM_ACL_NO_INSTANCE)
-        {
-            if (compiledAcl->aclInstance < 0)
-            {
-                fm10000FormatAclStatus(&errReport, TRUE,
-                                       "Invalid Instance selected for ACL %d.\n",
-                                       compiledAcl->aclNum);
-                err = FM_ERR_INVALID_ACL;
-                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-            }
-
-            err = fmTreeFind(&caclsRetry->instance,
-                             compiledAcl->aclInstance,
-                             (void**) &compiledAclInst);
-            if (err == FM_ERR_NOT_FOUND)
-            {
-                /* First user of this instance must create it */
-                compiledAclInst = fmAlloc(sizeof(fm_fm10000CompiledAclInstance));
-                if (compiledAclInst == NULL)
-                {
-                    err = FM_ERR_NO_MEM;
-                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-                }
-                FM_CLEAR(*compiledAclInst);
-                fmTreeInit(&compiledAclInst->acl);
-
-                err = fmTreeInsert(&caclsRetry->instance,
-                                   compiledAcl->aclInstance,
-                                   compiledAclInst);
-                if (err != FM_OK)
-                {
-                    fmFreeCompiledAclInstance(compiledAclInst);
-                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-                }
-            }
-            else if (err != FM_OK)
-            {
-                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-            }
-            else if (previousInst != compiledAcl->aclInstance)
-            {
-                fm10000FormatAclStatus(&errReport, TRUE,
-                                       "Instance %d must only contains "
-                                       "consecutive ACL Id.\n",
-                                       compiledAcl->aclInstance);
-                err = FM_ERR_INVALID_ACL;
-                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-            }
-
-            /* Add this ACL to be part of the instance */
-            err = fmTreeInsert(&compiledAclInst->acl,
-                               FM_ACL_GET_MASTER_KEY(aclNumber),
-                               compiledAcl);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-
-            /* Validates the scenario to be mutually exclusive with all the
-             * others already defined. */
-            if (compiledAclInst->sliceInfo.validScenarios &
-                compiledAcl->sliceInfo.validScenarios)
-            {
-                fm10000FormatAclStatus(&errReport, TRUE,
-                                       "Instance %d specify ACLs with non "
-                                       "mutually exclusive scenarios.\n",
-                                       compiledAcl->aclInstance);
-                err = FM_ERR_INVALID_ACL;
-                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-            }
-
-            /* The instance scenario contains all the individual one. */
-            compiledAclInst->sliceInfo.validScenarios |= compiledAcl->sliceInfo.validScenarios;
-
-            /* Slice Range used by the instance is the maximum of all the ACLs
-             * that belongs to this instance. Slice range does not includes
-             * case selection key at this point. */
-            if (compiledAcl->sliceInfo.keyEnd > compiledAclInst->sliceInfo.keyEnd)
-            {
-                compiledAclInst->sliceInfo.keyEnd = compiledAcl->sliceInfo.keyEnd;
-            }
-
-            if (compiledAcl->sliceInfo.actionEnd > compiledAclInst->sliceInfo.actionEnd)
-            {
-                compiledAclInst->sliceInfo.actionEnd = compiledAcl->sliceInfo.actionEnd;
-            }
-
-            /* Update the total number of rules that belongs to this
-             * instance. */
-            compiledAclInst->numRules += compiledAcl->numRules;
-        }
+        err = AddAclToInstance(&errReport,
+                               caclsRetry,
+                               compiledAcl,
+                               previousInst);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
         previousInst = compiledAcl->aclInstance;
     }
@@ -6809,10 +7728,39 @@ fm_status fm10000ACLCompile(fm_int    sw,
     {
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
     }
+    err = FM_OK;
+
+    if (deferKeys && (numKeyJobs > 0))
+    {
+        err = SelectAclKeysInParallel(sw,
+                                      &errReport,
+                                      keyJobs,
+                                      numKeyJobs,
+                                      numThreads);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+        /* Complete the ACLs in order, as done above when sequential */
+        for (i = 0 ; i < numKeyJobs ; i++)
+        {
+            compiledAcl = keyJobs[i].compiledAcl;
+
+            compiledAcl->sliceInfo.keyStart = 0;
+            compiledAcl->sliceInfo.actionEnd = compiledAcl->sliceInfo.keyEnd +
+                                               keyJobs[i].maxActionSlices - 1;
+
+            err = AddAclToInstance(&errReport,
+                                   caclsRetry,
+                                   compiledAcl,
+                                   previousInst);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+            previousInst = compiledAcl->aclInstance;
+        }
+    }
 
     /* Now process the Egress ACL. All the Egress ACL must be grouped together
      * and share the same set of TCAM key. */
-    fmTreeInit(&abstractKey);
+    FM_CLEAR(abstractKey);
     for (fmTreeIterInit(&itAcl, &caclsRetry->egressAcl) ;
          (err = fmTreeIterNext(&itAcl, &aclNumber, &nextValue)) == FM_OK ; )
     {
@@ -6851,7 +7799,8 @@ fm_status fm10000ACLCompile(fm_int    sw,
         {
             rule = (fm_aclRule *) nextValue;
 
-            compiledAclRule = fmAlloc(sizeof(fm_fm10000CompiledAclRule));
+            compiledAclRule = fmAllocTagged(sizeof(fm_fm10000CompiledAclRule),
+                                            FM_LOG_CAT_ACL);
             if (compiledAclRule == NULL)
             {
                 err = FM_ERR_NO_MEM;
@@ -6868,21 +7817,21 @@ fm_status fm10000ACLCompile(fm_int    sw,
                                compiledAclRule);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-            /* The abstract key tree contain all the abstract key needed for
+            /* The abstract key set contain all the abstract key needed for
              * the all the egress ACLs.*/
-            err = fmFillAbstractKeyTree(sw,
-                                        &errReport,
-                                        rule,
-                                        &abstractKey,
-                                        NULL);
+            err = fmFillAbstractKey(sw,
+                                    &errReport,
+                                    rule,
+                                    &abstractKey,
+                                    NULL);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
             /* Add key related to the ingress port selection */
-            err = fmFillAbstractPortSetKeyTree(&errReport,
-                                               rule,
-                                               NULL,
-                                               &abstractKey,
-                                               NULL);
+            err = fmFillAbstractPortSetKey(&errReport,
+                                           rule,
+                                           NULL,
+                                           &abstractKey,
+                                           NULL);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
             compiledAcl->numRules++;
@@ -6925,8 +7874,6 @@ fm_status fm10000ACLCompile(fm_int    sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
     }
 
-    fmTreeDestroy(&abstractKey, NULL);
-
     /*************************************************************************
      * At this point, all the ACL/ACL-rule was pre-processed as if each of them
      * was compiled individually. Now, all of them will be processed as a
@@ -7315,7 +8262,7 @@ fm_status fm10000ACLCompile(fm_int    sw,
             caclsRetry->valid = TRUE;
         }
 
-        FillCompileStats(caclsRetry);
+        FillCompileStats(sw, caclsRetry);
 
         /**************************************************
          * Print statistics on success, such as the number
@@ -7345,9 +8292,9 @@ fm_status fm10000ACLCompile(fm_int    sw,
 
 ABORT:
 
-    if (fmTreeIsInitialized(&abstractKey))
+    if (keyJobs != NULL)
     {
-        fmTreeDestroy(&abstractKey, NULL);
+        fmFree(keyJobs);
     }
 
     compileTryAlloc = FALSE;
@@ -7420,6 +8367,7 @@ fm_status fm10000ACLApplyExt(fm_int    sw,
     fm_bitArray *originalPortMask = NULL;
     fm_bitArray zeroPortMask;
     fm_bool zeroPortMaskInit = FALSE;
+    fm_bool ffuQueueStarted = FALSE;
     fm_int numPorts;
     fm_int cpi;
     fm_int port;
@@ -7452,13 +8400,17 @@ fm_status fm10000ACLApplyExt(fm_int    sw,
                 internalAcl = -1;
             }
 
+            /* Only report the rule writes done by this apply. */
+            switchExt->appliedAcls->ndRuleWrites = 0;
+            switchExt->appliedAcls->ndRuleMoves  = 0;
+
             err = fm10000NonDisruptCompile(sw,
                                            switchExt->appliedAcls,
                                            internalAcl,
                                            TRUE);
             if (stats)
             {
-                FillCompileStats(switchExt->appliedAcls);
+                FillCompileStats(sw, switchExt->appliedAcls);
                 FM_MEMCPY_S( stats,
                              sizeof(fm_aclCompilerStats),
                              &switchExt->appliedAcls->compilerStats,
@@ -7486,6 +8438,21 @@ fm_status fm10000ACLApplyExt(fm_int    sw,
         FM_LOG_EXIT(FM_LOG_CAT_ACL, FM_ERR_INVALID_ARGUMENT);
     }
 
+    /* An incrementally compiled image only differs from the applied one by
+     * the pending rule changes, write them without disrupting traffic. */
+    if ( (cacls != NULL) && (cacls->valid == TRUE) && cacls->incremental &&
+         (aacls != NULL) )
+    {
+        err = fm10000NonDisruptCompile(sw, aacls, -1, TRUE);
+        if (err == FM_OK)
+        {
+            FreeCompiledAclsStruct(cacls);
+            switchExt->compiledAcls = NULL;
+        }
+
+        FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+    }
+
     /* Disruptive apply */
     if ((cacls == NULL) ||
         (cacls->valid != TRUE))
@@ -7505,7 +8472,7 @@ fm_status fm10000ACLApplyExt(fm_int    sw,
     err = fmSetBitArrayBlock(&zeroPortMask, 0, numPorts, 0);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-    originalPortMask = fmAlloc(numPorts * sizeof(fm_bitArray));
+    originalPortMask = fmAllocTagged(numPorts * sizeof(fm_bitArray), FM_LOG_CAT_ACL);
     if (originalPortMask == NULL)
     {
         err = FM_ERR_NO_MEM;
@@ -7591,6 +8558,11 @@ fm_status fm10000ACLApplyExt(fm_int    sw,
         }
     }
 
+    /* Queue the rule writes so each slice is written in bulk. */
+    err = fm10000StartFFUWriteQueue(sw);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    ffuQueueStarted = TRUE;
+
     /* Apply all the egress ACLs */
     egressInitialized = FALSE;
     cacls->chunkValid = 0;
@@ -7731,6 +8703,10 @@ fm_status fm10000ACLApplyExt(fm_int    sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
     }
 
+    ffuQueueStarted = FALSE;
+    err = fm10000FlushFFUWriteQueue(sw);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
     err = fmUpdateMasterValid(sw, cacls);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
@@ -7738,6 +8714,7 @@ fm_status fm10000ACLApplyExt(fm_int    sw,
     FreeCompiledAclsStruct(switchExt->appliedAcls);
     switchExt->appliedAcls = cacls;
     switchExt->compiledAcls = NULL;
+    switchPtr->aclInfo.layoutChanged = FALSE;
 
     err = fm10000ApplyMappers(sw);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
@@ -7762,7 +8739,7 @@ fm_status fm10000ACLApplyExt(fm_int    sw,
      **************************************************/
     if (stats)
     {
-        FillCompileStats(switchExt->appliedAcls);
+        FillCompileStats(sw, switchExt->appliedAcls);
         FM_MEMCPY_S( stats,
                      sizeof(fm_aclCompilerStats),
                      &switchExt->appliedAcls->compilerStats,
@@ -7771,6 +8748,11 @@ fm_status fm10000ACLApplyExt(fm_int    sw,
 
 ABORT:
 
+    if (ffuQueueStarted)
+    {
+        fm10000FlushFFUWriteQueue(sw);
+    }
+
     /* Restart Traffic */
     if (zeroPortMaskInit)
     {
@@ -8047,6 +9029,253 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000GetACLCountList
+ * \ingroup intAcl
+ *
+ * \desc            Retrieve the frame and octet counts of every applied
+ *                  FM_ACL_ACTION_COUNT or FM_ACL_ACTIONEXT_COUNT ACL rule.
+ *                  The counter region of each policer bank is read with a
+ *                  single multi-word access and each entry is then mapped
+ *                  back to the ACL rules that use it.
+ *
+ * \note            Switch is assumed to already be validated and
+ *                  protected, and ACL lock already acquired.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       maxEntries is the size of the entries array.
+ *
+ * \param[out]      entries points to a caller-allocated array of maxEntries
+ *                  elements where this function should place the counters
+ *                  of each rule.
+ *
+ * \param[out]      numEntries points to caller-allocated storage where this
+ *                  function should place the number of entries filled in.
+ *
+ * \param[in]       clear should be TRUE to reset each counter after it has
+ *                  been read.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_ACLS if no ACLs have been applied.
+ * \return          FM_ERR_BUFFER_FULL if entries is too small to hold the
+ *                  counters of every counting rule.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fm10000GetACLCountList(fm_int            sw,
+                                 fm_int            maxEntries,
+                                 fm_aclCountEntry *entries,
+                                 fm_int *          numEntries,
+                                 fm_bool           clear)
+{
+    fm_status                       err = FM_OK;
+    fm_switch *                     switchPtr = GET_SWITCH_PTR(sw);
+    fm10000_switch *                switchExt = (fm10000_switch *) switchPtr->extension;
+    fm_fm10000CompiledAcls *        aacls = switchExt->appliedAcls;
+    fm_fm10000CompiledAcl *         compiledAcl;
+    fm_fm10000CompiledAclRule *     compiledAclRule;
+    fm_fm10000CompiledPolicerEntry *compiledPolEntry;
+    fm_fm10000AclRule *             aclRule;
+    fm_dlist_node *                 node;
+    fm_treeIterator                 itEntry;
+    fm_uint64                       policerIndex;
+    fm_uint64                       aclNumKey;
+    fm_uint64 *                     frameCounts = NULL;
+    fm_uint64 *                     byteCounts = NULL;
+    void *                          nextValue;
+    fm_int                          firstIndex;
+    fm_int                          lastIndex;
+    fm_int                          runStart;
+    fm_int                          bank;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ACL,
+                 "sw = %d, maxEntries = %d, entries = %p, clear = %d\n",
+                 sw,
+                 maxEntries,
+                 (void *) entries,
+                 clear);
+
+    *numEntries = 0;
+
+    if (aacls == NULL)
+    {
+        err = FM_ERR_NO_ACLS;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+
+    frameCounts = fmAlloc( (FM_FM10000_MAX_POLICER_4K_INDEX + 1) *
+                           sizeof(fm_uint64) );
+    byteCounts  = fmAlloc( (FM_FM10000_MAX_POLICER_4K_INDEX + 1) *
+                           sizeof(fm_uint64) );
+
+    if ( (frameCounts == NULL) || (byteCounts == NULL) )
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+
+    for (bank = 0 ; bank < FM_FM10000_POLICER_BANK_MAX ; bank++)
+    {
+        /* Counter entries are allocated from the top of the bank, so they
+         * form a single region that can be read in one access. */
+        firstIndex = -1;
+        lastIndex  = -1;
+
+        for (fmTreeIterInit(&itEntry, &aacls->policers[bank].policerEntry) ;
+             fmTreeIterNext(&itEntry, &policerIndex, &nextValue) == FM_OK ; )
+        {
+            compiledPolEntry = (fm_fm10000CompiledPolicerEntry *) nextValue;
+
+            if (compiledPolEntry->countEntry)
+            {
+                if (firstIndex < 0)
+                {
+                    firstIndex = (fm_int) policerIndex;
+                }
+                lastIndex = (fm_int) policerIndex;
+            }
+        }
+
+        if (firstIndex < 0)
+        {
+            continue;
+        }
+
+        err = fm10000GetPolicerCounters(sw,
+                                        bank,
+                                        (fm_uint16) firstIndex,
+                                        (fm_uint16) (lastIndex - firstIndex + 1),
+                                        frameCounts,
+                                        byteCounts);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+        for (fmTreeIterInit(&itEntry, &aacls->policers[bank].policerEntry) ;
+             fmTreeIterNext(&itEntry, &policerIndex, &nextValue) == FM_OK ; )
+        {
+            compiledPolEntry = (fm_fm10000CompiledPolicerEntry *) nextValue;
+
+            if (!compiledPolEntry->countEntry)
+            {
+                continue;
+            }
+
+            node = FM_DLL_GET_FIRST( (&compiledPolEntry->policerRules), head );
+            while (node != NULL)
+            {
+                aclRule = (fm_fm10000AclRule *) node->data;
+
+                if (*numEntries >= maxEntries)
+                {
+                    err = FM_ERR_BUFFER_FULL;
+                    goto ABORT;
+                }
+
+                err = fmGetAclNumKey(&aacls->ingressAcl,
+                                     aclRule->aclNumber,
+                                     aclRule->ruleNumber,
+                                     &aclNumKey);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+                err = fmTreeFind(&aacls->ingressAcl, aclNumKey, &nextValue);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+                compiledAcl = (fm_fm10000CompiledAcl *) nextValue;
+                err = fmTreeFind(&compiledAcl->rules,
+                                 aclRule->ruleNumber,
+                                 &nextValue);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+                compiledAclRule = (fm_fm10000CompiledAclRule *) nextValue;
+
+                entries[*numEntries].acl  = aclRule->aclNumber;
+                entries[*numEntries].rule = aclRule->ruleNumber;
+                entries[*numEntries].counters.cntPkts =
+                    compiledAclRule->cntAdjustPkts +
+                    frameCounts[policerIndex - firstIndex];
+                entries[*numEntries].counters.cntOctets =
+                    compiledAclRule->cntAdjustOctets +
+                    byteCounts[policerIndex - firstIndex];
+                (*numEntries)++;
+
+                if (clear)
+                {
+                    compiledAclRule->cntAdjustPkts   = 0LL;
+                    compiledAclRule->cntAdjustOctets = 0LL;
+                }
+
+                node = FM_DLL_GET_NEXT(node, nextPtr);
+            }
+        }
+
+        if (!clear)
+        {
+            continue;
+        }
+
+        /* Reset each run of consecutive counter entries with one write,
+         * leaving any policer entry in between untouched. */
+        FM_MEMSET_S(frameCounts,
+                    (lastIndex - firstIndex + 1) * sizeof(fm_uint64),
+                    0,
+                    (lastIndex - firstIndex + 1) * sizeof(fm_uint64));
+
+        runStart = -1;
+
+        for (policerIndex = firstIndex ;
+             policerIndex <= (fm_uint64) lastIndex + 1 ;
+             policerIndex++)
+        {
+            compiledPolEntry = NULL;
+
+            if ( ( policerIndex <= (fm_uint64) lastIndex ) &&
+                 ( fmTreeFind(&aacls->policers[bank].policerEntry,
+                              policerIndex,
+                              &nextValue) == FM_OK ) )
+            {
+                compiledPolEntry = (fm_fm10000CompiledPolicerEntry *) nextValue;
+            }
+
+            if ( (compiledPolEntry != NULL) && compiledPolEntry->countEntry )
+            {
+                if (runStart < 0)
+                {
+                    runStart = (fm_int) policerIndex;
+                }
+            }
+            else if (runStart >= 0)
+            {
+                err = fm10000SetPolicerCounters(sw,
+                                                bank,
+                                                (fm_uint16) runStart,
+                                                (fm_uint16) (policerIndex - runStart),
+                                                frameCounts,
+                                                frameCounts);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+                runStart = -1;
+            }
+        }
+    }
+
+ABORT:
+    if (frameCounts != NULL)
+    {
+        fmFree(frameCounts);
+    }
+
+    if (byteCounts != NULL)
+    {
+        fmFree(byteCounts);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+
+}   /* end fm10000GetACLCountList */
+
+
+
+
 /*****************************************************************************/
 /** fm10000GetACLEgressCount
  * \ingroup intAcl
@@ -8174,7 +9403,8 @@ fm_status fm10000AclInit(fm_int sw)
         switchExt->compiledAcls = NULL;
     }
 
-    switchExt->appliedAcls = fmAlloc( sizeof(fm_fm10000CompiledAcls) );
+    switchExt->appliedAcls = fmAllocTagged( sizeof(fm_fm10000CompiledAcls),
+                                            FM_LOG_CAT_ACL );
 
     if (switchExt->appliedAcls == NULL)
     {
@@ -9740,6 +10970,181 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000GetAclFFUSliceRows
+ * \ingroup intAcl
+ *
+ * \desc            Marks the FFU rows of a slice that hold an applied ACL
+ *                  rule, whether the rule is enabled or not. The caller
+ *                  must take the ACL lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       slice is the FFU slice to report.
+ *
+ * \param[in,out]   usedRows points to a cleared bitmap of
+ *                  FM10000_FFU_ENTRIES_PER_SLICE bits in which each used row
+ *                  is set.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000GetAclFFUSliceRows(fm_int     sw,
+                                    fm_int     slice,
+                                    fm_uint64 *usedRows)
+{
+    fm10000_switch *switchExt;
+    fm_status err = FM_OK;
+    fm_fm10000CompiledAcl *compiledAcl;
+    fm_fm10000CompiledAclRule *compiledAclRule;
+    fm_tree *aclTrees[2];
+    fm_treeIterator itAcl;
+    fm_treeIterator itRule;
+    fm_uint64 aclNumber;
+    fm_uint64 ruleNumber;
+    void *nextValue;
+    fm_int i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ACL,
+                 "sw = %d, slice = %d, usedRows = %p\n",
+                 sw,
+                 slice,
+                 (void *) usedRows);
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    if (switchExt->appliedAcls == NULL)
+    {
+        goto ABORT;
+    }
+
+    aclTrees[0] = &switchExt->appliedAcls->ingressAcl;
+    aclTrees[1] = &switchExt->appliedAcls->egressAcl;
+
+    for (i = 0 ; i < 2 ; i++)
+    {
+        for (fmTreeIterInit(&itAcl, aclTrees[i]) ;
+             (err = fmTreeIterNext(&itAcl, &aclNumber, &nextValue)) == FM_OK ; )
+        {
+            compiledAcl = (fm_fm10000CompiledAcl*) nextValue;
+
+            if ( (slice < compiledAcl->sliceInfo.keyStart) ||
+                 (slice > compiledAcl->sliceInfo.actionEnd) )
+            {
+                continue;
+            }
+
+            for (fmTreeIterInit(&itRule, &compiledAcl->rules) ;
+                 (err = fmTreeIterNext(&itRule, &ruleNumber, &nextValue)) == FM_OK ; )
+            {
+                compiledAclRule = (fm_fm10000CompiledAclRule*) nextValue;
+
+                if ( (compiledAclRule->physicalPos >= 0) &&
+                     (compiledAclRule->physicalPos < FM10000_FFU_ENTRIES_PER_SLICE) )
+                {
+                    usedRows[compiledAclRule->physicalPos / 64] |=
+                        FM_LITERAL_U64(1) << (compiledAclRule->physicalPos % 64);
+                }
+            }
+            if (err != FM_ERR_NO_MORE)
+            {
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+            }
+        }
+        if (err != FM_ERR_NO_MORE)
+        {
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+        }
+    }
+    err = FM_OK;
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+
+}   /* end fm10000GetAclFFUSliceRows */
+
+
+
+
+/*****************************************************************************/
+/** fm10000DefragmentAclFFU
+ * \ingroup intAcl
+ *
+ * \desc            Compacts the rules of each applied ingress ACL part so
+ *                  that the holes left by non disruptive rule removal merge
+ *                  into one free block above the rules. Egress ACLs are
+ *                  left alone since their rules are bound to egress chunks.
+ *                  The caller must take the ACL lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       budget is the maximum number of rules to move.
+ *
+ * \param[out]      numMoved points to caller-allocated storage where this
+ *                  function places the number of rules moved.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_STATE if ACLs were compiled but not yet
+ *                  applied.
+ *
+ *****************************************************************************/
+fm_status fm10000DefragmentAclFFU(fm_int  sw,
+                                  fm_int  budget,
+                                  fm_int *numMoved)
+{
+    fm10000_switch *switchExt;
+    fm_status err = FM_OK;
+    fm_fm10000CompiledAcl *compiledAcl;
+    fm_treeIterator itAcl;
+    fm_uint64 aclNumber;
+    void *nextValue;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ACL,
+                 "sw = %d, budget = %d, numMoved = %p\n",
+                 sw,
+                 budget,
+                 (void *) numMoved);
+
+    switchExt = GET_SWITCH_EXT(sw);
+    *numMoved = 0;
+
+    if (switchExt->appliedAcls == NULL)
+    {
+        goto ABORT;
+    }
+
+    /* A pending compilation still refers to the current rule positions. */
+    if (switchExt->compiledAcls != NULL)
+    {
+        err = FM_ERR_INVALID_STATE;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+
+    for (fmTreeIterInit(&itAcl, &switchExt->appliedAcls->ingressAcl) ;
+         (budget > 0) &&
+         ((err = fmTreeIterNext(&itAcl, &aclNumber, &nextValue)) == FM_OK) ; )
+    {
+        compiledAcl = (fm_fm10000CompiledAcl*) nextValue;
+
+        err = CompactAclPart(sw, compiledAcl, &budget, numMoved);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+    if ( (err != FM_OK) && (err != FM_ERR_NO_MORE) )
+    {
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+    err = FM_OK;
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+
+}   /* end fm10000DefragmentAclFFU */
+
+
+
+
 /*****************************************************************************/
 /** fm10000CountActionSlicesNeeded
  * \ingroup intAcl
@@ -1150,6 +1150,168 @@ static fm_status ClaimMapperOwnership(fm_int                sw,
 }   /* end ClaimMapperOwnership */
 
 
+/*****************************************************************************/
+/** CountL4PortPrefixes
+ * \ingroup intAcl
+ *
+ * \desc            Count the number of value/mask pairs needed to match an
+ *                  L4 port range directly in the TCAM, which is what a rule
+ *                  would need if the range was not handled by the mapper.
+ *
+ * \param[in]       start is the first port of the range.
+ *
+ * \param[in]       end is the last port of the range.
+ *
+ * \return          The number of prefixes covering the range.
+ *
+ *****************************************************************************/
+static fm_uint32 CountL4PortPrefixes(fm_uint32 start, fm_uint32 end)
+{
+    fm_uint32 numPrefixes = 0;
+    fm_uint32 blockSize;
+
+    while (start <= end)
+    {
+        /* Largest aligned block starting at start that fits in the range */
+        blockSize = (start == 0) ? 0x10000 : (start & (~start + 1));
+        while ( (start + blockSize - 1) > end )
+        {
+            blockSize >>= 1;
+        }
+
+        numPrefixes++;
+        start += blockSize;
+    }
+
+    return numPrefixes;
+
+}   /* end CountL4PortPrefixes */
+
+
+/*****************************************************************************/
+/** IsL4PortRangeContiguous
+ * \ingroup intAcl
+ *
+ * \desc            Tells if an L4 port mapper range directly follows another
+ *                  one with the same protocol and mapped value, in which case
+ *                  both can share a single mapper range.
+ *
+ * \param[in]       prev points to the range with the lowest ports.
+ *
+ * \param[in]       next points to the range that may follow prev.
+ *
+ * \return          TRUE if next can be merged into prev.
+ *
+ *****************************************************************************/
+static fm_bool IsL4PortRangeContiguous(const fm_l4PortMapperValue *prev,
+                                       const fm_l4PortMapperValue *next)
+{
+    return ( (prev->mappedProtocol == next->mappedProtocol) &&
+             (prev->mappedL4PortValue == next->mappedL4PortValue) &&
+             (prev->l4PortEnd != 0xffff) &&
+             (next->l4PortStart == (prev->l4PortEnd + 1)) );
+
+}   /* end IsL4PortRangeContiguous */
+
+
+/*****************************************************************************/
+/** WriteL4PortMapperRanges
+ * \ingroup intAcl
+ *
+ * \desc            Writes the L4 port mapper ranges of the mapper tree to
+ *                  the hardware. Ranges that follow each other with the same
+ *                  protocol and mapped value are merged and written as a
+ *                  single range, which frees two mapper slots per merge.
+ *                  The hardware mapper must be cleared by the caller.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       mapper is either FM_MAPPER_L4_SRC or FM_MAPPER_L4_DST.
+ *
+ * \param[in]       skip points to a range of the tree that must not be
+ *                  written, or NULL to write them all.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_FFU_RES_FOUND if the mapper is full.
+ *
+ *****************************************************************************/
+static fm_status WriteL4PortMapperRanges(fm_int                      sw,
+                                         fm_mapper                   mapper,
+                                         const fm_l4PortMapperValue *skip)
+{
+    fm_switch *           switchPtr;
+    fm_treeIterator       it;
+    fm_uint64             nextKey;
+    void *                nextValue;
+    fm_l4PortMapperValue *l4PortMapValue;
+    fm_l4PortMapperValue  mergedRange;
+    fm_bool               pending = FALSE;
+    fm_status             err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ACL,
+                 "sw = %d, mapper = %d, skip = %p\n",
+                 sw,
+                 mapper,
+                 (void *) skip);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    for (fmTreeIterInit(&it, &switchPtr->aclInfo.mappers) ;
+         ( err = fmTreeIterNext(&it, &nextKey, &nextValue) ) == FM_OK ; )
+    {
+        if ( (nextKey >> FM_MAPPER_TYPE_KEY_POS) != (fm_uint64) mapper )
+        {
+            continue;
+        }
+
+        l4PortMapValue = (fm_l4PortMapperValue *) nextValue;
+
+        if ( (skip != NULL) &&
+             (l4PortMapValue->mappedProtocol == skip->mappedProtocol) &&
+             (l4PortMapValue->l4PortStart == skip->l4PortStart) &&
+             (l4PortMapValue->l4PortEnd == skip->l4PortEnd) )
+        {
+            continue;
+        }
+
+        /* Ranges are sorted by protocol then by port in the tree. */
+        if (pending && IsL4PortRangeContiguous(&mergedRange, l4PortMapValue))
+        {
+            mergedRange.l4PortEnd = l4PortMapValue->l4PortEnd;
+            continue;
+        }
+
+        if (pending)
+        {
+            err = SetL4PortMapperEntry(sw,
+                                       (mapper == FM_MAPPER_L4_SRC),
+                                       &mergedRange);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+        }
+
+        mergedRange = *l4PortMapValue;
+        pending = TRUE;
+    }
+    if (err != FM_ERR_NO_MORE)
+    {
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+
+    err = FM_OK;
+
+    if (pending)
+    {
+        err = SetL4PortMapperEntry(sw,
+                                   (mapper == FM_MAPPER_L4_SRC),
+                                   &mergedRange);
+    }
+
+ABORT:
+    FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+
+}   /* end WriteL4PortMapperRanges */
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -1405,7 +1567,7 @@ fm_status fm10000AddMapperEntry(fm_int             sw,
                          &mapperEntry);
         if (err == FM_ERR_NOT_FOUND)
         {
-            mapperEntry = fmAlloc(size);
+            mapperEntry = fmAllocTagged(size, FM_LOG_CAT_ACL);
             if (mapperEntry == NULL)
             {
                 FM_LOG_EXIT(FM_LOG_CAT_ACL, FM_ERR_NO_MEM);
@@ -1589,11 +1751,41 @@ fm_status fm10000DeleteMapperEntry(fm_int             sw,
         case FM_MAPPER_L4_SRC:
             l4PortMapValue = (fm_l4PortMapperValue *) value;
             err = ClearL4PortMapperEntry(sw, TRUE, l4PortMapValue);
+
+            /* The range may have been merged with its neighbours when the
+             * mapper was last applied, rewrite the mapper without it. */
+            if (err == FM_ERR_NOT_FOUND)
+            {
+                err = fm10000ClearMapper(sw,
+                                         FM_MAPPER_L4_SRC,
+                                         FM_MAPPER_ENTRY_MODE_APPLY);
+                if (err == FM_OK)
+                {
+                    err = WriteL4PortMapperRanges(sw,
+                                                  FM_MAPPER_L4_SRC,
+                                                  l4PortMapValue);
+                }
+            }
             break;
 
         case FM_MAPPER_L4_DST:
             l4PortMapValue = (fm_l4PortMapperValue *) value;
             err = ClearL4PortMapperEntry(sw, FALSE, l4PortMapValue);
+
+            /* The range may have been merged with its neighbours when the
+             * mapper was last applied, rewrite the mapper without it. */
+            if (err == FM_ERR_NOT_FOUND)
+            {
+                err = fm10000ClearMapper(sw,
+                                         FM_MAPPER_L4_DST,
+                                         FM_MAPPER_ENTRY_MODE_APPLY);
+                if (err == FM_OK)
+                {
+                    err = WriteL4PortMapperRanges(sw,
+                                                  FM_MAPPER_L4_DST,
+                                                  l4PortMapValue);
+                }
+            }
             break;
 
         case FM_MAPPER_MAC:
@@ -2092,9 +2284,11 @@ fm_status fm10000VerifyMappers(fm_int               sw,
     fm_int                  prevSrcProt = 0;
     fm_int                  prevSrcEnd = 0;
     fm_int                  numL4SrcRange = 0;
+    fm_l4PortMapperValue *  prevSrcRange = NULL;
     fm_int                  prevDstProt = 0;
     fm_int                  prevDstEnd = 0;
     fm_int                  numL4DstRange = 0;
+    fm_l4PortMapperValue *  prevDstRange = NULL;
     fm_int                  numMacMapEntry = 0;
     fm_int                  numEthTypeMapEntry = 0;
     fm_int                  numIpLengthRange = 0;
@@ -2158,6 +2352,7 @@ fm_status fm10000VerifyMappers(fm_int               sw,
                 {
                     prevSrcProt = l4PortMapValue->mappedProtocol;
                     prevSrcEnd = 0;
+                    prevSrcRange = NULL;
                 }
 
                 if (prevSrcEnd > l4PortMapValue->l4PortStart)
@@ -2182,7 +2377,14 @@ fm_status fm10000VerifyMappers(fm_int               sw,
                 }
 
                 prevSrcEnd = l4PortMapValue->l4PortEnd;
-                numL4SrcRange++;
+
+                /* Contiguous ranges share a single mapper range. */
+                if ( (prevSrcRange == NULL) ||
+                     !IsL4PortRangeContiguous(prevSrcRange, l4PortMapValue) )
+                {
+                    numL4SrcRange++;
+                }
+                prevSrcRange = l4PortMapValue;
                 break;
 
             case FM_MAPPER_L4_DST:
@@ -2194,6 +2396,7 @@ fm_status fm10000VerifyMappers(fm_int               sw,
                 {
                     prevDstProt = l4PortMapValue->mappedProtocol;
                     prevDstEnd = 0;
+                    prevDstRange = NULL;
                 }
 
                 if (prevDstEnd > l4PortMapValue->l4PortStart)
@@ -2218,7 +2421,14 @@ fm_status fm10000VerifyMappers(fm_int               sw,
                 }
 
                 prevDstEnd = l4PortMapValue->l4PortEnd;
-                numL4DstRange++;
+
+                /* Contiguous ranges share a single mapper range. */
+                if ( (prevDstRange == NULL) ||
+                     !IsL4PortRangeContiguous(prevDstRange, l4PortMapValue) )
+                {
+                    numL4DstRange++;
+                }
+                prevDstRange = l4PortMapValue;
                 break;
 
             case FM_MAPPER_MAC:
@@ -2582,19 +2792,126 @@ fm_status fm10000ApplyMappers(fm_int sw)
          ( err = fmTreeIterNext(&it, &nextKey, &nextValue) ) == FM_OK ; )
     {
         mapper = nextKey >> FM_MAPPER_TYPE_KEY_POS;
+
+        /* L4 port ranges are merged and written below. */
+        if ( (mapper == FM_MAPPER_L4_SRC) || (mapper == FM_MAPPER_L4_DST) )
+        {
+            continue;
+        }
+
         err = fm10000AddMapperEntry(sw,
                                     mapper,
                                     nextValue,
                                     FM_MAPPER_ENTRY_MODE_APPLY);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
     }
-    if (err == FM_ERR_NO_MORE)
+    if (err != FM_ERR_NO_MORE)
     {
-        err = FM_OK;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
     }
 
+    err = WriteL4PortMapperRanges(sw, FM_MAPPER_L4_SRC, NULL);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+    err = WriteL4PortMapperRanges(sw, FM_MAPPER_L4_DST, NULL);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
 ABORT:
     FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
 
 }   /* end fm10000ApplyMappers */
 
+
+/*****************************************************************************/
+/** fm10000GetMapperStats
+ * \ingroup intAcl
+ *
+ * \desc            Fills the mapper part of the ACL compiler statistics from
+ *                  the mapper tree, counting L4 port ranges as they will be
+ *                  written once contiguous ranges are merged.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   stats points to the statistics to update.
+ *
+ * eturn          None
+ *
+ *****************************************************************************/
+void fm10000GetMapperStats(fm_int sw, fm_aclCompilerStats *stats)
+{
+    fm_switch *           switchPtr;
+    fm_treeIterator       it;
+    fm_uint64             nextKey;
+    void *                nextValue;
+    fm_mapper             mapper;
+    fm_l4PortMapperValue *l4PortMapValue;
+    fm_l4PortMapperValue  mergedRange[2];
+    fm_bool               pending[2] = { FALSE, FALSE };
+    fm_int                dir;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    stats->l4SrcMapperSlots = 0;
+    stats->l4DstMapperSlots = 0;
+    stats->ipMapperSlots = 0;
+    stats->l4MapperRangesMerged = 0;
+    stats->l4MapperTcamEntriesSaved = 0;
+
+    for (fmTreeIterInit(&it, &switchPtr->aclInfo.mappers) ;
+         fmTreeIterNext(&it, &nextKey, &nextValue) == FM_OK ; )
+    {
+        mapper = nextKey >> FM_MAPPER_TYPE_KEY_POS;
+
+        if (mapper == FM_MAPPER_IP_ADDR)
+        {
+            stats->ipMapperSlots++;
+            continue;
+        }
+        else if ( (mapper != FM_MAPPER_L4_SRC) && (mapper != FM_MAPPER_L4_DST) )
+        {
+            continue;
+        }
+
+        dir = (mapper == FM_MAPPER_L4_SRC) ? 0 : 1;
+        l4PortMapValue = (fm_l4PortMapperValue *) nextValue;
+
+        if ( pending[dir] &&
+             IsL4PortRangeContiguous(&mergedRange[dir], l4PortMapValue) )
+        {
+            mergedRange[dir].l4PortEnd = l4PortMapValue->l4PortEnd;
+            stats->l4MapperRangesMerged++;
+            continue;
+        }
+
+        if (pending[dir])
+        {
+            stats->l4MapperTcamEntriesSaved +=
+                CountL4PortPrefixes(mergedRange[dir].l4PortStart,
+                                    mergedRange[dir].l4PortEnd) - 1;
+        }
+
+        if (dir == 0)
+        {
+            stats->l4SrcMapperSlots += 2;
+        }
+        else
+        {
+            stats->l4DstMapperSlots += 2;
+        }
+
+        mergedRange[dir] = *l4PortMapValue;
+        pending[dir] = TRUE;
+    }
+
+    for (dir = 0 ; dir < 2 ; dir++)
+    {
+        if (pending[dir])
+        {
+            stats->l4MapperTcamEntriesSaved +=
+                CountL4PortPrefixes(mergedRange[dir].l4PortStart,
+                                    mergedRange[dir].l4PortEnd) - 1;
+        }
+    }
+
+}   /* end fm10000GetMapperStats */
+
@@ -39,6 +39,20 @@
  * Macros, Constants & Types
  *****************************************************************************/
 
+/* Range of contiguous ingress ACL rules moved by the same distance. */
+typedef struct _fm10000_aclRuleRun
+{
+    /* Physical position of the first rule of the range */
+    fm_int from;
+
+    /* Number of rules in the range */
+    fm_int count;
+
+    /* Physical position where the first rule of the range goes */
+    fm_int to;
+
+} fm10000_aclRuleRun;
+
 
 /*****************************************************************************
  * Global Variables
@@ -64,38 +78,38 @@ extern void fmFreeAclPortSet(void *value);
 extern void fmFreeEcmpGroup(void *value);
 extern void fmFreeCompiledPolicerEntry(void *value);
 
-extern fm_status fmAddAbstractKey(fm_tree * abstractKey,
-                                  fm_byte   firstAbstract,
-                                  fm_byte   lastAbstract,
-                                  fm_byte   bitsPerKey,
-                                  fm_uint64 mask,
-                                  fm_uint64 value);
-extern fm_status fmAddIpAbstractKey(fm_tree * abstractKey,
-                                    fm_byte   firstAbstract,
-                                    fm_ipAddr mask,
-                                    fm_ipAddr value);
-extern fm_status fmAddDeepInsAbstractKey(fm_tree * abstractKey,
-                                         fm_byte * abstractTable,
-                                         fm_byte   tableSize,
-                                         fm_byte * mask,
-                                         fm_byte * value);
-
-extern fm_status fmFillAbstractPortSetKeyTree(fm_aclErrorReporter *      errReport,
-                                              fm_aclRule *               rule,
-                                              fm_fm10000CompiledAclRule *compiledAclRule,
-                                              fm_tree *                  abstractKey,
-                                              fm_tree *                  portSetId);
-extern fm_status fmFillAbstractKeyTree(fm_int               sw,
-                                       fm_aclErrorReporter *errReport,
-                                       fm_aclRule *         rule,
-                                       fm_tree *            abstractKey,
-                                       fm_tree *            portSetId);
+extern fm_status fmAddAbstractKey(fm_fm10000AbstractKey *abstractKey,
+                                  fm_byte                firstAbstract,
+                                  fm_byte                lastAbstract,
+                                  fm_byte                bitsPerKey,
+                                  fm_uint64              mask,
+                                  fm_uint64              value);
+extern fm_status fmAddIpAbstractKey(fm_fm10000AbstractKey *abstractKey,
+                                    fm_byte                firstAbstract,
+                                    fm_ipAddr              mask,
+                                    fm_ipAddr              value);
+extern fm_status fmAddDeepInsAbstractKey(fm_fm10000AbstractKey *abstractKey,
+                                         fm_byte *              abstractTable,
+                                         fm_byte                tableSize,
+                                         fm_byte *              mask,
+                                         fm_byte *              value);
+
+extern fm_status fmFillAbstractPortSetKey(fm_aclErrorReporter *      errReport,
+                                          fm_aclRule *               rule,
+                                          fm_fm10000CompiledAclRule *compiledAclRule,
+                                          fm_fm10000AbstractKey *    abstractKey,
+                                          fm_tree *                  portSetId);
+extern fm_status fmFillAbstractKey(fm_int                 sw,
+                                   fm_aclErrorReporter *  errReport,
+                                   fm_aclRule *           rule,
+                                   fm_fm10000AbstractKey *abstractKey,
+                                   fm_tree *              portSetId);
 
 extern fm_int fmCountConditionSliceUsage(fm_byte *muxSelect);
 extern void fmInitializeConcreteKey(fm_byte *muxSelect);
-extern fm_status fmConvertAbstractToConcreteKey(fm_tree *      abstractKeyTree,
-                                                fm_byte *      muxSelect,
-                                                fm_uint16 *    muxUsed);
+extern fm_status fmConvertAbstractToConcreteKey(fm_fm10000AbstractKey *abstractKey,
+                                                fm_byte *              muxSelect,
+                                                fm_uint16 *            muxUsed);
 
 extern void fmTranslateAclScenario(fm_int      sw,
                                    fm_uint32   aclScenario,
@@ -221,10 +235,11 @@ fm_status fm10000NonDisruptRemEgressAclRule(fm_int                 sw,
                                             fm_fm10000CompiledAcl *compiledAcl,
                                             fm_int                 rule,
                                             fm_bool                apply);
-fm_status fm10000NonDisruptRemIngAclRule(fm_int                 sw,
-                                         fm_fm10000CompiledAcl *compiledAcl,
-                                         fm_int                 rule,
-                                         fm_bool                apply);
+fm_status fm10000NonDisruptRemIngAclRule(fm_int                  sw,
+                                         fm_fm10000CompiledAcls *cacls,
+                                         fm_fm10000CompiledAcl * compiledAcl,
+                                         fm_int                  rule,
+                                         fm_bool                 apply);
 fm_status fm10000NonDisruptRemAcls(fm_int                  sw,
                                    fm_fm10000CompiledAcls *cacls,
                                    fm_int                  internalAcl,
@@ -1427,7 +1442,8 @@ static fm_status InsertPortSet(fm_int                  sw,
         portSetPos = (1 << bits);
         if ((cacls->usedPortSet & portSetPos) == 0)
         {
-            portSet = (fm_portSet *)fmAlloc(sizeof(fm_portSet));
+            portSet = (fm_portSet *)fmAllocTagged(sizeof(fm_portSet),
+                                                  FM_LOG_CAT_ACL);
             if (portSet == NULL)
             {
                 err = FM_ERR_NO_MEM;
@@ -1599,96 +1615,1068 @@ ABORT:
  * \ingroup intAcl
  *
  * \desc            This function extract all the abstract key that are part
- *                  of the abstractKey tree but without concrete translation
+ *                  of the abstractKey set but without concrete translation
  *                  into the compiled acl structure.
  *
  * \param[in]       compiledAcl points to the compiled acl structure that
  *                  contain all the concrete elements.
  *
- * \param[in]       abstractKeyTree points to the tree of abstract key to
+ * \param[in]       abstractKeySet points to the set of abstract key to
  *                  translate.
  *
- * \param[out]      remainAbstractKeyTree points to a tree that must be filled
- *                  with abstract key that are part of abstractKey but not in
- *                  the actual compiled acl structure.
+ * \param[out]      remainAbstractKeySet points to a cleared set that must be
+ *                  filled with abstract key that are part of abstractKeySet
+ *                  but not in the actual compiled acl structure.
  *
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
-static fm_status FindUnconfiguredAbstract(fm_fm10000CompiledAcl *compiledAcl,
-                                          fm_tree *              abstractKeyTree,
-                                          fm_tree *              remainAbstractKeyTree)
+static fm_status FindUnconfiguredAbstract(fm_fm10000CompiledAcl *      compiledAcl,
+                                          const fm_fm10000AbstractKey *abstractKeySet,
+                                          fm_fm10000AbstractKey *      remainAbstractKeySet)
 {
     fm_status err = FM_OK;
     fm_uint64 abstractKey;
-    void *nextValue;
-    fm_treeIterator itKey;
+    fm_uint64 used;
+    fm_int word;
     fm_int i;
     fm_int numCondition;
     fm_bool found;
 
     FM_LOG_ENTRY(FM_LOG_CAT_ACL,
                  "compiledAcl = %p, "
-                 "abstractKeyTree = %p, "
-                 "remainAbstractKeyTree = %p\n",
+                 "abstractKeySet = %p, "
+                 "remainAbstractKeySet = %p\n",
+                 (void*) compiledAcl,
+                 (void*) abstractKeySet,
+                 (void*) remainAbstractKeySet);
+
+    numCondition = compiledAcl->sliceInfo.keyEnd -
+                   compiledAcl->sliceInfo.keyStart + 1;
+
+    for (word = 0 ; word < FM10000_ABSTRACT_KEY_WORDS ; word++)
+    {
+        for (used = abstractKeySet->used[word] ; used != 0 ; used &= used - 1)
+        {
+            abstractKey = (word * 64) + __builtin_ctzll(used);
+            found = FALSE;
+
+            /* 8 bits abstract key only fit in 8 bits concrete key. */
+            if (abstractKey < FM10000_FIRST_4BITS_ABSTRACT_KEY)
+            {
+                for (i = 0 ; i < numCondition ; i++)
+                {
+                    if ( (fmAbstractToConcrete8bits[abstractKey][0] == compiledAcl->muxSelect[i * FM_FFU_SELECTS_PER_MINSLICE]) ||
+                         (fmAbstractToConcrete8bits[abstractKey][1] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 1]) ||
+                         (fmAbstractToConcrete8bits[abstractKey][2] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 2]) ||
+                         (fmAbstractToConcrete8bits[abstractKey][3] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 3]) )
+                    {
+                        found = TRUE;
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                /* If the abstract 4 bits key needed is already configure as part
+                 * of a 8 bits key then no need to add another key. */
+                for (i = 0 ; i < numCondition ; i++)
+                {
+                    if ( (fmAbstractToConcrete4bits[abstractKey][0] == compiledAcl->muxSelect[i * FM_FFU_SELECTS_PER_MINSLICE]) ||
+                         (fmAbstractToConcrete4bits[abstractKey][1] == compiledAcl->muxSelect[i * FM_FFU_SELECTS_PER_MINSLICE]) ||
+                         (fmAbstractToConcrete4bits[abstractKey][2] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 1]) ||
+                         (fmAbstractToConcrete4bits[abstractKey][3] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 1]) ||
+                         (fmAbstractToConcrete4bits[abstractKey][4] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 2]) ||
+                         (fmAbstractToConcrete4bits[abstractKey][5] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 2]) ||
+                         (fmAbstractToConcrete4bits[abstractKey][6] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 3]) ||
+                         (fmAbstractToConcrete4bits[abstractKey][7] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 3]) ||
+                         (fmAbstractToConcrete4bits[abstractKey][8] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 4]) ||
+                         (fmAbstractToConcrete4bits[abstractKey][9] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 4]) )
+
+                    {
+                        found = TRUE;
+                        break;
+                    }
+                }
+            }
+
+            /* This abstract key don't have its translation in the current compiled
+             * acl structure. */
+            if (!found)
+            {
+                remainAbstractKeySet->used[word] |= FM_LITERAL_U64(1) << (abstractKey % 64);
+                remainAbstractKeySet->data[abstractKey] =
+                    abstractKeySet->data[abstractKey];
+            }
+        }
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+
+}   /* end FindUnconfiguredAbstract */
+
+
+/*****************************************************************************/
+/** IsAbstractKeySetEmpty
+ * \ingroup intAcl
+ *
+ * \desc            Tells if a set of abstract key is empty.
+ *
+ * \param[in]       abstractKeySet points to the set of abstract key to test.
+ *
+ * \return          TRUE if no abstract key is part of the set.
+ * \return          FALSE otherwise.
+ *
+ *****************************************************************************/
+static fm_bool IsAbstractKeySetEmpty(const fm_fm10000AbstractKey *abstractKeySet)
+{
+    fm_int word;
+
+    for (word = 0 ; word < FM10000_ABSTRACT_KEY_WORDS ; word++)
+    {
+        if (abstractKeySet->used[word] != 0)
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+
+}   /* end IsAbstractKeySetEmpty */
+
+
+/*****************************************************************************/
+/** IsAclPortless
+ * \ingroup intAcl
+ *
+ * \desc            Tells if an ACL assigned to a type of port has no port of
+ *                  that type on this switch. This situation only make sense
+ *                  on SWAG.
+ *
+ * \param[in]       acl points to the ACL to test.
+ *
+ * \return          TRUE if the ACL must be skipped by the compiler.
+ * \return          FALSE otherwise.
+ *
+ *****************************************************************************/
+static fm_bool IsAclPortless(fm_acl *acl)
+{
+    if ( ((acl->aclPortType == FM_ACL_PORT_TYPE_INGRESS) &&
+          (acl->numberOfPorts[FM_ACL_TYPE_INGRESS] == 0)) ||
+         ((acl->aclPortType == FM_ACL_PORT_TYPE_EGRESS) &&
+          (acl->numberOfPorts[FM_ACL_TYPE_EGRESS] == 0)) )
+    {
+        return TRUE;
+    }
+
+    return FALSE;
+
+}   /* end IsAclPortless */
+
+
+/*****************************************************************************/
+/** NextPendingIngAclRule
+ * \ingroup intAcl
+ *
+ * \desc            Advance an iterator over the added rules of an ACL up to
+ *                  the next rule that is part of the actual ACL configuration
+ *                  but not of the ingress compiled ACL structure.
+ *
+ * \param[in]       compiledAcl points to the single part compiled ACL
+ *                  structure of the ACL.
+ *
+ * \param[in]       acl points to the defined ACL.
+ *
+ * \param[in,out]   itRule points to an iterator over the added rules tree
+ *                  of acl.
+ *
+ * \param[out]      ruleNumber points to caller-allocated storage where this
+ *                  function should place the rule Id.
+ *
+ * \param[out]      rule points to caller-allocated storage where this
+ *                  function should place the defined ACL rule.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MORE if there are no more rules to add.
+ *
+ *****************************************************************************/
+static fm_status NextPendingIngAclRule(fm_fm10000CompiledAcl *compiledAcl,
+                                       fm_acl *               acl,
+                                       fm_treeIterator *      itRule,
+                                       fm_uint64 *            ruleNumber,
+                                       fm_aclRule **          rule)
+{
+    fm_status err;
+    void *nextValue;
+
+    while ((err = fmTreeIterNext(itRule, ruleNumber, &nextValue)) == FM_OK)
+    {
+        err = fmTreeFind(&acl->rules, *ruleNumber, (void**) rule);
+        if (err == FM_ERR_NOT_FOUND)
+        {
+            continue;
+        }
+        else if (err != FM_OK)
+        {
+            break;
+        }
+
+        err = fmTreeFind(&compiledAcl->rules, *ruleNumber, &nextValue);
+        if (err == FM_ERR_NOT_FOUND)
+        {
+            err = FM_OK;
+            break;
+        }
+        else if (err != FM_OK)
+        {
+            break;
+        }
+    }
+
+    return err;
+
+}   /* end NextPendingIngAclRule */
+
+
+/*****************************************************************************/
+/** CountPendingIngAclRules
+ * \ingroup intAcl
+ *
+ * \desc            Count the rules that are part of the actual ACL
+ *                  configuration but not of the ingress compiled ACL
+ *                  structure.
+ *
+ * \param[in]       compiledAcl points to the single part compiled ACL
+ *                  structure of the ACL.
+ *
+ * \param[in]       acl points to the defined ACL.
+ *
+ * \param[out]      numPending points to caller-allocated storage where this
+ *                  function should place the number of rules to add.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status CountPendingIngAclRules(fm_fm10000CompiledAcl *compiledAcl,
+                                         fm_acl *               acl,
+                                         fm_int *               numPending)
+{
+    fm_status err;
+    fm_treeIterator itRule;
+    fm_uint64 ruleNumber;
+    fm_aclRule *rule;
+
+    *numPending = 0;
+
+    for (fmTreeIterInit(&itRule, &acl->addedRules) ;
+         (err = NextPendingIngAclRule(compiledAcl,
+                                      acl,
+                                      &itRule,
+                                      &ruleNumber,
+                                      &rule)) == FM_OK ; )
+    {
+        (*numPending)++;
+    }
+    if (err == FM_ERR_NO_MORE)
+    {
+        err = FM_OK;
+    }
+
+    return err;
+
+}   /* end CountPendingIngAclRules */
+
+
+/*****************************************************************************/
+/** PlanIngAclRuleMoves
+ * \ingroup intAcl
+ *
+ * \desc            Compute the final position of each rule of a single part
+ *                  ingress ACL once packed together with the rules to add.
+ *                  The rules that must move are returned as ranges of
+ *                  contiguous rules moved by the same distance, rules that
+ *                  already are at their final position are never moved.
+ *
+ * \param[in,out]   compiledAcl points to the single part compiled ACL
+ *                  structure to plan.
+ *
+ * \param[in]       acl points to the defined ACL whose added rules must be
+ *                  given a position. May be NULL to only pack the rules
+ *                  already compiled.
+ *
+ * \param[out]      runs points to an array of at least numRules entries
+ *                  where this function should place the ranges to move.
+ *                  Unused if update is TRUE.
+ *
+ * \param[out]      numRuns points to caller-allocated storage where this
+ *                  function should place the number of ranges to move.
+ *
+ * \param[out]      numFinal points to caller-allocated storage where this
+ *                  function should place the number of rules of the ACL
+ *                  once the added rules are inserted.
+ *
+ * \param[in]       update must be set to TRUE to update the physical position
+ *                  of the compiled rules instead of returning the ranges.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status PlanIngAclRuleMoves(fm_fm10000CompiledAcl *compiledAcl,
+                                     fm_acl *               acl,
+                                     fm10000_aclRuleRun *   runs,
+                                     fm_int *               numRuns,
+                                     fm_int *               numFinal,
+                                     fm_bool                update)
+{
+    fm_status err;
+    fm_status errPending = FM_ERR_NO_MORE;
+    fm_treeIterator itRule;
+    fm_treeIterator itPending;
+    fm_uint64 ruleNumber;
+    fm_uint64 pendingNumber = 0;
+    fm_fm10000CompiledAclRule *compiledAclRule;
+    fm_aclRule *rule;
+    fm10000_aclRuleRun *run = NULL;
+    fm_int finalPos = 0;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ACL,
+                 "compiledAcl = %p, "
+                 "acl = %p, "
+                 "update = %d\n",
+                 (void*) compiledAcl,
+                 (void*) acl,
+                 update);
+
+    *numRuns = 0;
+
+    if (acl != NULL)
+    {
+        fmTreeIterInitBackwards(&itPending, &acl->addedRules);
+        errPending = NextPendingIngAclRule(compiledAcl,
+                                           acl,
+                                           &itPending,
+                                           &pendingNumber,
+                                           &rule);
+    }
+
+    /* Less prioritized rules are at the lowest positions. */
+    for (fmTreeIterInitBackwards(&itRule, &compiledAcl->rules) ;
+         (err = fmTreeIterNext(&itRule,
+                               &ruleNumber,
+                               (void**) &compiledAclRule)) == FM_OK ; )
+    {
+        /* Leave a hole for each less prioritized rule to add. */
+        while ( (errPending == FM_OK) && (pendingNumber > ruleNumber) )
+        {
+            finalPos++;
+            errPending = NextPendingIngAclRule(compiledAcl,
+                                               acl,
+                                               &itPending,
+                                               &pendingNumber,
+                                               &rule);
+        }
+        if ( (errPending != FM_OK) && (errPending != FM_ERR_NO_MORE) )
+        {
+            err = errPending;
+            goto ABORT;
+        }
+
+        if (update)
+        {
+            compiledAclRule->physicalPos = finalPos;
+        }
+        else if (compiledAclRule->physicalPos == finalPos)
+        {
+            run = NULL;
+        }
+        else if ( (run != NULL) &&
+                  ((run->from + run->count) == compiledAclRule->physicalPos) &&
+                  ((run->to + run->count) == finalPos) )
+        {
+            run->count++;
+        }
+        else
+        {
+            run = &runs[(*numRuns)++];
+            run->from  = compiledAclRule->physicalPos;
+            run->count = 1;
+            run->to    = finalPos;
+        }
+
+        finalPos++;
+    }
+    if (err != FM_ERR_NO_MORE)
+    {
+        goto ABORT;
+    }
+
+    /* The most prioritized rules to add go above all the others. */
+    while (errPending == FM_OK)
+    {
+        finalPos++;
+        errPending = NextPendingIngAclRule(compiledAcl,
+                                           acl,
+                                           &itPending,
+                                           &pendingNumber,
+                                           &rule);
+    }
+    if (errPending != FM_ERR_NO_MORE)
+    {
+        err = errPending;
+        goto ABORT;
+    }
+
+    *numFinal = finalPos;
+    err = FM_OK;
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+
+}   /* end PlanIngAclRuleMoves */
+
+
+/*****************************************************************************/
+/** MoveIngAclRules
+ * \ingroup intAcl
+ *
+ * \desc            Move the rules of a single part ingress ACL to their
+ *                  packed position, leaving a hole where each rule to add
+ *                  goes. Only the rules whose position changes are moved and
+ *                  contiguous rules are moved together.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   cacls points to the compiled ACL structure to modify.
+ *
+ * \param[in,out]   compiledAcl points to the single part compiled ACL
+ *                  structure to update.
+ *
+ * \param[in]       acl points to the defined ACL whose added rules must be
+ *                  given a position. May be NULL to only pack the rules.
+ *                  The rules are only packed if the added ones do not fit.
+ *
+ * \param[in]       apply inform if the modification must be applied to the
+ *                  hardware.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ *
+ *****************************************************************************/
+static fm_status MoveIngAclRules(fm_int                  sw,
+                                 fm_fm10000CompiledAcls *cacls,
+                                 fm_fm10000CompiledAcl * compiledAcl,
+                                 fm_acl *                acl,
+                                 fm_bool                 apply)
+{
+    fm_status err = FM_OK;
+    fm10000_aclRuleRun *runs = NULL;
+    fm_int numRuns;
+    fm_int numFinal;
+    fm_int i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ACL,
+                 "sw = %d, "
+                 "cacls = %p, "
+                 "compiledAcl = %p, "
+                 "acl = %p, "
+                 "apply = %d\n",
+                 sw,
+                 (void*) cacls,
+                 (void*) compiledAcl,
+                 (void*) acl,
+                 apply);
+
+    if (compiledAcl->numRules == 0)
+    {
+        goto ABORT;
+    }
+
+    runs = fmAllocTagged(sizeof(fm10000_aclRuleRun) * compiledAcl->numRules,
+                         FM_LOG_CAT_ACL);
+    if (runs == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    err = PlanIngAclRuleMoves(compiledAcl, acl, runs, &numRuns, &numFinal, FALSE);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+    /* The added rules will be inserted one at a time, only pack. */
+    if ( (acl != NULL) && (numFinal > FM10000_MAX_RULE_PER_ACL_PART) )
+    {
+        acl = NULL;
+        err = PlanIngAclRuleMoves(compiledAcl,
+                                  acl,
+                                  runs,
+                                  &numRuns,
+                                  &numFinal,
+                                  FALSE);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+
+    if (apply)
+    {
+        /* Rules moving down are processed from the lowest position and rules
+         * moving up from the highest one so that the destination of a rule
+         * is always free when it is written. */
+        for (i = 0 ; i < numRuns ; i++)
+        {
+            if (runs[i].to < runs[i].from)
+            {
+                err = fm10000MoveFFURules(sw,
+                                          &compiledAcl->sliceInfo,
+                                          runs[i].from,
+                                          runs[i].count,
+                                          runs[i].to);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+            }
+        }
+
+        for (i = numRuns - 1 ; i >= 0 ; i--)
+        {
+            if (runs[i].to > runs[i].from)
+            {
+                err = fm10000MoveFFURules(sw,
+                                          &compiledAcl->sliceInfo,
+                                          runs[i].from,
+                                          runs[i].count,
+                                          runs[i].to);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+            }
+        }
+    }
+
+    for (i = 0 ; i < numRuns ; i++)
+    {
+        cacls->ndRuleWrites += runs[i].count;
+        cacls->ndRuleMoves  += runs[i].count;
+    }
+
+    err = PlanIngAclRuleMoves(compiledAcl, acl, NULL, &numRuns, &numFinal, TRUE);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+ABORT:
+
+    if (runs != NULL)
+    {
+        fmFree(runs);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+
+}   /* end MoveIngAclRules */
+
+
+/*****************************************************************************/
+/** AllocIngAclRule
+ * \ingroup intAcl
+ *
+ * \desc            Allocate the compiled structure of an ingress ACL rule to
+ *                  add and fill its basic configuration. The rule is not
+ *                  positioned yet.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       aclNumber is the acl Id attached to the rule.
+ *
+ * \param[in]       rule points to the defined acl rule.
+ *
+ * \param[in]       ruleNumber is the rule Id.
+ *
+ * \param[out]      compiledAclRule points to caller-allocated storage where
+ *                  this function should place the allocated rule.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ * \return          FM_ERR_INVALID_ACL_RULE if the rule needs too many
+ *                  actions.
+ *
+ *****************************************************************************/
+static fm_status AllocIngAclRule(fm_int                      sw,
+                                 fm_int                      aclNumber,
+                                 fm_aclRule *                rule,
+                                 fm_int                      ruleNumber,
+                                 fm_fm10000CompiledAclRule **compiledAclRule)
+{
+    fm_status err = FM_OK;
+    fm_fm10000CompiledAclRule *newCompiledAclRule;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ACL,
+                 "sw = %d, "
+                 "aclNumber = %d, "
+                 "rule = %p, "
+                 "ruleNumber = %d\n",
+                 sw,
+                 aclNumber,
+                 (void*) rule,
+                 ruleNumber);
+
+    /* Allocate memory space for this new acl rule. */
+    newCompiledAclRule = fmAllocTagged(sizeof(fm_fm10000CompiledAclRule),
+                                       FM_LOG_CAT_ACL);
+    if (newCompiledAclRule == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+    FM_CLEAR(*newCompiledAclRule);
+
+    /* Basic rule configuration */
+    newCompiledAclRule->aclNumber = aclNumber;
+    newCompiledAclRule->ruleNumber = ruleNumber;
+    newCompiledAclRule->valid = rule->state;
+    newCompiledAclRule->portSetId = FM_PORT_SET_ALL;
+    newCompiledAclRule->physicalPos = -1;
+
+    err = fm10000CountActionSlicesNeeded(sw,
+                                         NULL,
+                                         rule,
+                                         &newCompiledAclRule->numActions);
+    if ( (err == FM_OK) &&
+         (newCompiledAclRule->numActions > FM10000_ACL_MAX_ACTIONS_PER_RULE) )
+    {
+        err = FM_ERR_INVALID_ACL_RULE;
+    }
+
+    if (err != FM_OK)
+    {
+        fmFree(newCompiledAclRule);
+        goto ABORT;
+    }
+
+    *compiledAclRule = newCompiledAclRule;
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+
+}   /* end AllocIngAclRule */
+
+
+/*****************************************************************************/
+/** ConfigureIngAclRule
+ * \ingroup intAcl
+ *
+ * \desc            Configure the key, the actions and the policers of an
+ *                  ingress ACL rule that was inserted in the compiled ACL
+ *                  structure at its final position.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   cacls points to the compiled ACL structure to modify.
+ *
+ * \param[in,out]   compiledAcl points to the compiled ACL structure part
+ *                  that holds the rule.
+ *
+ * \param[in]       rule points to the defined acl rule that contain all the
+ *                  configuration to define.
+ *
+ * \param[in]       ruleNumber is the rule Id.
+ *
+ * \param[in,out]   compiledAclRule points to the compiled rule to
+ *                  configure.
+ *
+ * \param[in]       apply inform if the modification must be applied to the
+ *                  hardware.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status ConfigureIngAclRule(fm_int                     sw,
+                                     fm_fm10000CompiledAcls *   cacls,
+                                     fm_fm10000CompiledAcl *    compiledAcl,
+                                     fm_aclRule *               rule,
+                                     fm_int                     ruleNumber,
+                                     fm_fm10000CompiledAclRule *compiledAclRule,
+                                     fm_bool                    apply)
+{
+    fm_status err = FM_OK;
+    fm_switch *switchPtr = GET_SWITCH_PTR(sw);
+    fm10000_switch * switchExt;
+    fm_bool strictCount;
+    fm_fm10000CompiledPolicers *policers;
+    fm_fm10000CompiledPolicerEntry *compiledPolEntry;
+    void *nextValue;
+    fm_int i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ACL,
+                 "sw = %d, "
+                 "cacls = %p, "
+                 "compiledAcl = %p, "
+                 "rule = %p, "
+                 "ruleNumber = %d, "
+                 "compiledAclRule = %p, "
+                 "apply = %d\n",
+                 sw,
+                 (void*) cacls,
+                 (void*) compiledAcl,
+                 (void*) rule,
+                 ruleNumber,
+                 (void*) compiledAclRule,
+                 apply);
+
+    switchExt = (fm10000_switch *) switchPtr->extension;
+
+    /* Initialize the indexes of the policer. */
+    for (i = 0 ; i < FM_FM10000_POLICER_BANK_MAX ; i++)
+    {
+        compiledAclRule->policerIndex[i] = 0;
+    }
+
+    /* Configure the condition key and key mask based on the entered
+     * acl rule. */
+    err = fmConfigureConditionKey(sw,
+                                  NULL,
+                                  rule,
+                                  ruleNumber,
+                                  compiledAcl,
+                                  NULL);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+    strictCount = switchExt->aclStrictCount;
+
+    err = fm10000ConfigurePolicerBank(sw,
+                                      NULL,
+                                      cacls,
+                                      rule,
+                                      compiledAclRule,
+                                      strictCount);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+    /* Configure the action data based on the entered acl rule. */
+    err = fmConfigureActionData(sw,
+                                NULL,
+                                cacls->policers,
+                                &cacls->ecmpGroups,
+                                rule,
+                                compiledAcl,
+                                compiledAclRule);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+    if (apply)
+    {
+        for (i = 0 ; i < FM_FM10000_POLICER_BANK_MAX ; i++)
+        {
+            /* If the added rule needs a policer entry, configure it. */
+            if (compiledAclRule->policerIndex[i] != 0)
+            {
+                policers = &cacls->policers[i];
+
+                err = fmTreeFind(&policers->policerEntry,
+                                 compiledAclRule->policerIndex[i],
+                                 &nextValue);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+                compiledPolEntry = (fm_fm10000CompiledPolicerEntry*) nextValue;
+
+                if (compiledPolEntry->countEntry)
+                {
+                    err = fm10000SetPolicerCounter(sw,
+                                                   i,
+                                                   compiledAclRule->policerIndex[i],
+                                                   FM_LITERAL_64(0),
+                                                   FM_LITERAL_64(0));
+                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+                }
+                else
+                {
+                    err = fm10000SetPolicer(sw,
+                                            i,
+                                            compiledAclRule->policerIndex[i],
+                                            &compiledPolEntry->committed,
+                                            &compiledPolEntry->excess);
+                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+                    err = fm10000SetPolicerConfig(sw,
+                                                  i,
+                                                  policers->indexLastPolicer,
+                                                  policers->ingressColorSource,
+                                                  policers->markDSCP,
+                                                  policers->markSwitchPri,
+                                                  TRUE);
+                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+                }
+            }
+        }
+
+        err = fm10000SetFFURule(sw,
+                                &compiledAcl->sliceInfo,
+                                compiledAclRule->physicalPos,
+                                compiledAclRule->valid,
+                                compiledAclRule->sliceKey,
+                                compiledAclRule->actions,
+                                TRUE, /* Live */
+                                TRUE);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+
+    cacls->ndRuleWrites++;
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+
+}   /* end ConfigureIngAclRule */
+
+
+/*****************************************************************************/
+/** RemIngAclRules
+ * \ingroup intAcl
+ *
+ * \desc            Remove all the removed rules of a single part ingress ACL
+ *                  then pack the remaining ones in a single pass. If the
+ *                  added rules of the ACL are to be inserted by
+ *                  ''AddIngAclRules'', a hole is left where each of them goes
+ *                  so that no rule is moved twice.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   cacls points to the compiled ACL structure to modify.
+ *
+ * \param[in,out]   compiledAcl points to the single part compiled ACL
+ *                  structure to update.
+ *
+ * \param[in]       acl points to the defined ACL.
+ *
+ * \param[in]       apply inform if the modification must be applied to the
+ *                  hardware.
+ *
+ * \param[out]      removedRule points to caller-allocated storage set to
+ *                  TRUE if at least one rule was removed.
+ *
+ * \param[out]      portSetsClean points to caller-allocated storage set to
+ *                  TRUE if a removed rule was using a port set.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status RemIngAclRules(fm_int                  sw,
+                                fm_fm10000CompiledAcls *cacls,
+                                fm_fm10000CompiledAcl * compiledAcl,
+                                fm_acl *                acl,
+                                fm_bool                 apply,
+                                fm_bool *               removedRule,
+                                fm_bool *               portSetsClean)
+{
+    fm_status err = FM_OK;
+    fm_treeIterator itRule;
+    fm_uint64 ruleNumber;
+    void *nextValue;
+    fm_fm10000CompiledAclRule *compiledAclRule;
+    fm_bool removed = FALSE;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ACL,
+                 "sw = %d, "
+                 "cacls = %p, "
+                 "compiledAcl = %p, "
+                 "acl = %p, "
+                 "apply = %d\n",
+                 sw,
+                 (void*) cacls,
+                 (void*) compiledAcl,
+                 (void*) acl,
+                 apply);
+
+    for (fmTreeIterInit(&itRule, &acl->removedRules) ;
+         (err = fmTreeIterNext(&itRule, &ruleNumber, &nextValue)) == FM_OK ; )
+    {
+        err = fmTreeFind(&compiledAcl->rules,
+                         ruleNumber,
+                         (void**) &compiledAclRule);
+        if (err == FM_ERR_NOT_FOUND)
+        {
+            continue;
+        }
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+        removed = TRUE;
+
+        /* Remove any reference to policer index */
+        err = fm10000NonDisruptCleanPolicerRules(sw,
+                                                 cacls,
+                                                 compiledAclRule,
+                                                 0xf,
+                                                 apply);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+        if (compiledAclRule->portSetId != FM_PORT_SET_ALL)
+        {
+            *portSetsClean = TRUE;
+        }
+
+        if (apply)
+        {
+            err = fm10000SetFFURuleValid(sw,
+                                         &compiledAcl->sliceInfo,
+                                         compiledAclRule->physicalPos,
+                                         FALSE,
+                                         TRUE);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+        }
+        cacls->ndRuleWrites++;
+
+        err = fmTreeRemoveCertain(&compiledAcl->rules,
+                                  ruleNumber,
+                                  fmFreeCompiledAclRule);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+        compiledAcl->numRules--;
+    }
+    if (err != FM_ERR_NO_MORE)
+    {
+        goto ABORT;
+    }
+    err = FM_OK;
+
+    if (removed)
+    {
+        *removedRule = TRUE;
+
+        /* Only leave holes for the rules that will be added in place. */
+        if ( (fmTreeSize(&acl->rules) == 0) ||
+             IsAclPortless(acl) ||
+             (acl->numberOfPorts[FM_ACL_TYPE_EGRESS] != 0) )
+        {
+            acl = NULL;
+        }
+
+        err = MoveIngAclRules(sw, cacls, compiledAcl, acl, apply);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
+
+}   /* end RemIngAclRules */
+
+
+/*****************************************************************************/
+/** AddIngAclRules
+ * \ingroup intAcl
+ *
+ * \desc            Add all the added rules of a single part ingress ACL in a
+ *                  single pass. The existing rules are first moved to their
+ *                  final position, then each added rule is configured in the
+ *                  hole left for it.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   cacls points to the compiled ACL structure to modify.
+ *
+ * \param[in,out]   compiledAcl points to the single part compiled ACL
+ *                  structure to update. It must have room for all the added
+ *                  rules.
+ *
+ * \param[in]       acl points to the defined ACL.
+ *
+ * \param[in]       aclNumber is the acl Id.
+ *
+ * \param[in]       apply inform if the modification must be applied to the
+ *                  hardware.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status AddIngAclRules(fm_int                  sw,
+                                fm_fm10000CompiledAcls *cacls,
+                                fm_fm10000CompiledAcl * compiledAcl,
+                                fm_acl *                acl,
+                                fm_int                  aclNumber,
+                                fm_bool                 apply)
+{
+    fm_status err = FM_OK;
+    fm_treeIterator itRule;
+    fm_uint64 ruleNumber;
+    fm_uint64 nextRuleNumber;
+    fm_aclRule *rule;
+    fm_fm10000CompiledAclRule *compiledAclRule;
+    fm_fm10000CompiledAclRule *nextCompiledAclRule;
+    fm_fm10000CompiledAclRule *newCompiledAclRule = NULL;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ACL,
+                 "sw = %d, "
+                 "cacls = %p, "
+                 "compiledAcl = %p, "
+                 "acl = %p, "
+                 "aclNumber = %d, "
+                 "apply = %d\n",
+                 sw,
+                 (void*) cacls,
                  (void*) compiledAcl,
-                 (void*) abstractKeyTree,
-                 (void*) remainAbstractKeyTree);
-
-    numCondition = compiledAcl->sliceInfo.keyEnd -
-                   compiledAcl->sliceInfo.keyStart + 1;
+                 (void*) acl,
+                 aclNumber,
+                 apply);
 
-    for (fmTreeIterInit(&itKey, abstractKeyTree) ;
-         (err = fmTreeIterNext(&itKey, &abstractKey, &nextValue)) == FM_OK ; )
+    /* Select the keys of all the added rules first. */
+    for (fmTreeIterInitBackwards(&itRule, &acl->addedRules) ;
+         (err = NextPendingIngAclRule(compiledAcl,
+                                      acl,
+                                      &itRule,
+                                      &ruleNumber,
+                                      &rule)) == FM_OK ; )
+    {
+        err = fm10000NonDisruptAddSelect(sw, cacls, compiledAcl, rule, apply);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+    if (err != FM_ERR_NO_MORE)
     {
-        found = FALSE;
+        goto ABORT;
+    }
+
+    /* Open a hole for each of them. */
+    err = MoveIngAclRules(sw, cacls, compiledAcl, acl, apply);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+    /* Fill the holes from the less prioritized rule, each one goes right
+     * above the next less prioritized rule. */
+    for (fmTreeIterInitBackwards(&itRule, &acl->addedRules) ;
+         (err = NextPendingIngAclRule(compiledAcl,
+                                      acl,
+                                      &itRule,
+                                      &ruleNumber,
+                                      &rule)) == FM_OK ; )
+    {
+        err = AllocIngAclRule(sw,
+                              aclNumber,
+                              rule,
+                              ruleNumber,
+                              &newCompiledAclRule);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+        err = fmTreeInsert(&compiledAcl->rules, ruleNumber, newCompiledAclRule);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-        /* 8 bits abstract key only fit in 8 bits concrete key. */
-        if (abstractKey < FM10000_FIRST_4BITS_ABSTRACT_KEY)
+        compiledAclRule = newCompiledAclRule;
+        newCompiledAclRule = NULL;
+        compiledAcl->numRules++;
+
+        err = fmTreeSuccessor(&compiledAcl->rules,
+                              ruleNumber,
+                              &nextRuleNumber,
+                              (void**) &nextCompiledAclRule);
+        if (err == FM_OK)
         {
-            for (i = 0 ; i < numCondition ; i++)
-            {
-                if ( (fmAbstractToConcrete8bits[abstractKey][0] == compiledAcl->muxSelect[i * FM_FFU_SELECTS_PER_MINSLICE]) ||
-                     (fmAbstractToConcrete8bits[abstractKey][1] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 1]) ||
-                     (fmAbstractToConcrete8bits[abstractKey][2] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 2]) ||
-                     (fmAbstractToConcrete8bits[abstractKey][3] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 3]) )
-                {
-                    found = TRUE;
-                    break;
-                }
-            }
+            compiledAclRule->physicalPos = nextCompiledAclRule->physicalPos + 1;
         }
-        else
+        else if (err == FM_ERR_NO_MORE)
         {
-            /* If the abstract 4 bits key needed is already configure as part
-             * of a 8 bits key then no need to add another key. */
-            for (i = 0 ; i < numCondition ; i++)
-            {
-                if ( (fmAbstractToConcrete4bits[abstractKey][0] == compiledAcl->muxSelect[i * FM_FFU_SELECTS_PER_MINSLICE]) ||
-                     (fmAbstractToConcrete4bits[abstractKey][1] == compiledAcl->muxSelect[i * FM_FFU_SELECTS_PER_MINSLICE]) ||
-                     (fmAbstractToConcrete4bits[abstractKey][2] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 1]) ||
-                     (fmAbstractToConcrete4bits[abstractKey][3] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 1]) ||
-                     (fmAbstractToConcrete4bits[abstractKey][4] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 2]) ||
-                     (fmAbstractToConcrete4bits[abstractKey][5] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 2]) ||
-                     (fmAbstractToConcrete4bits[abstractKey][6] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 3]) ||
-                     (fmAbstractToConcrete4bits[abstractKey][7] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 3]) ||
-                     (fmAbstractToConcrete4bits[abstractKey][8] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 4]) ||
-                     (fmAbstractToConcrete4bits[abstractKey][9] == compiledAcl->muxSelect[(i * FM_FFU_SELECTS_PER_MINSLICE) + 4]) )
-
-                {
-                    found = TRUE;
-                    break;
-                }
-            }
+            compiledAclRule->physicalPos = 0;
         }
-
-        /* This abstract key don't have its translation in the current compiled
-         * acl structure. */
-        if (!found)
+        else
         {
-            err = fmTreeInsert(remainAbstractKeyTree, abstractKey, NULL);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+            goto ABORT;
         }
+
+        err = ConfigureIngAclRule(sw,
+                                  cacls,
+                                  compiledAcl,
+                                  rule,
+                                  ruleNumber,
+                                  compiledAclRule,
+                                  apply);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
     }
     if (err != FM_ERR_NO_MORE)
     {
@@ -1698,9 +2686,15 @@ static fm_status FindUnconfiguredAbstract(fm_fm10000CompiledAcl *compiledAcl,
 
 ABORT:
 
+    /* Free the rule if it was not inserted in the compiled acl structure. */
+    if (newCompiledAclRule != NULL)
+    {
+        fmFree(newCompiledAclRule);
+    }
+
     FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
 
-}   /* end FindUnconfiguredAbstract */
+}   /* end AddIngAclRules */
 
 
 /*****************************************************************************/
@@ -4613,6 +5607,8 @@ ABORT:
  *
  * \param[in]       sw is the switch on which to operate.
  *
+ * \param[in,out]   cacls points to the compiled ACL structure to modify.
+ *
  * \param[in,out]   compiledAcl points to the compiled acl structure to
  *                  update.
  *
@@ -4624,10 +5620,11 @@ ABORT:
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
-fm_status fm10000NonDisruptRemIngAclRule(fm_int                 sw,
-                                         fm_fm10000CompiledAcl *compiledAcl,
-                                         fm_int                 rule,
-                                         fm_bool                apply)
+fm_status fm10000NonDisruptRemIngAclRule(fm_int                  sw,
+                                         fm_fm10000CompiledAcls *cacls,
+                                         fm_fm10000CompiledAcl * compiledAcl,
+                                         fm_int                  rule,
+                                         fm_bool                 apply)
 {
     fm_status err = FM_OK;
     fm_fm10000CompiledAclRule* compiledAclRule;
@@ -4638,10 +5635,12 @@ fm_status fm10000NonDisruptRemIngAclRule(fm_int                 sw,
 
     FM_LOG_ENTRY(FM_LOG_CAT_ACL,
                  "sw = %d, "
+                 "cacls = %p, "
                  "compiledAcl = %p, "
                  "rule = %d, "
                  "apply = %d\n",
                  sw,
+                 (void*) cacls,
                  (void*) compiledAcl,
                  rule,
                  apply);
@@ -4660,6 +5659,7 @@ fm_status fm10000NonDisruptRemIngAclRule(fm_int                 sw,
                                      TRUE);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
     }
+    cacls->ndRuleWrites++;
 
     numRules = 0;
     fromIndex = 0;
@@ -4694,6 +5694,8 @@ fm_status fm10000NonDisruptRemIngAclRule(fm_int                 sw,
                                   fromIndex - 1);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
     }
+    cacls->ndRuleWrites += numRules;
+    cacls->ndRuleMoves  += numRules;
 
     /* Finally remove the rule from the tree. */
     err = fmTreeRemoveCertain(&compiledAcl->rules, rule, fmFreeCompiledAclRule);
@@ -4798,49 +5800,68 @@ fm_status fm10000NonDisruptRemAcls(fm_int                  sw,
         err = fmTreeFind(&info->acls, compiledAcl->aclNum, (void**) &acl);
         if (err == FM_OK)
         {
-            for (fmTreeIterInit(&itRule, &acl->removedRules) ;
-                 (err = fmTreeIterNext(&itRule, &ruleNumber, &nextValue)) ==
-                        FM_OK ; )
+            /* Single part ACL rules are all removed and packed at once. */
+            if ( (aclNumber == FM_ACL_GET_MASTER_KEY(compiledAcl->aclNum)) &&
+                 (fmTreeFind(&cacls->ingressAcl,
+                             aclNumber + 1LL,
+                             &nextValue) == FM_ERR_NOT_FOUND) )
             {
-                err = fmTreeFind(&compiledAcl->rules,
-                                 ruleNumber,
-                                 (void**) &compiledAclRule);
-                /* Found an ACL Rule that need to be remove from the compiled
-                 * ACL structure. */
-                if (err == FM_OK)
+                err = RemIngAclRules(sw,
+                                     cacls,
+                                     compiledAcl,
+                                     acl,
+                                     apply,
+                                     &removedRule,
+                                     &InitPortSetsClean);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+            }
+            else
+            {
+                for (fmTreeIterInit(&itRule, &acl->removedRules) ;
+                     (err = fmTreeIterNext(&itRule, &ruleNumber, &nextValue)) ==
+                            FM_OK ; )
                 {
-                    /* At least one rule was removed from this ACL. */
-                    removedRule = TRUE;
+                    err = fmTreeFind(&compiledAcl->rules,
+                                     ruleNumber,
+                                     (void**) &compiledAclRule);
+                    /* Found an ACL Rule that need to be remove from the
+                     * compiled ACL structure. */
+                    if (err == FM_OK)
+                    {
+                        /* At least one rule was removed from this ACL. */
+                        removedRule = TRUE;
+
+                        /* Remove any reference to policer index */
+                        err = fm10000NonDisruptCleanPolicerRules(sw,
+                                                                 cacls,
+                                                                 compiledAclRule,
+                                                                 0xf,
+                                                                 apply);
+                        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+                        if (compiledAclRule->portSetId != FM_PORT_SET_ALL)
+                        {
+                            InitPortSetsClean = TRUE;
+                        }
 
-                    /* Remove any reference to policer index */
-                    err = fm10000NonDisruptCleanPolicerRules(sw,
+                        /* Remove this Rule */
+                        err = fm10000NonDisruptRemIngAclRule(sw,
                                                              cacls,
-                                                             compiledAclRule,
-                                                             0xf,
+                                                             compiledAcl,
+                                                             ruleNumber,
                                                              apply);
-                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-
-                    if (compiledAclRule->portSetId != FM_PORT_SET_ALL)
+                        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+                    }
+                    else if (err != FM_ERR_NOT_FOUND)
                     {
-                        InitPortSetsClean = TRUE;
+                        goto ABORT;
                     }
-
-                    /* Remove this Rule */
-                    err = fm10000NonDisruptRemIngAclRule(sw,
-                                                         compiledAcl,
-                                                         ruleNumber,
-                                                         apply);
-                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
                 }
-                else if (err != FM_ERR_NOT_FOUND)
+                if (err != FM_ERR_NO_MORE)
                 {
                     goto ABORT;
                 }
             }
-            if (err != FM_ERR_NO_MORE)
-            {
-                goto ABORT;
-            }
 
             /* Process grouped ACLs as a whole */
             if (fmTreeFind(&cacls->ingressAcl, aclNumber - 1LL, &nextValue) == FM_OK)
@@ -5489,7 +6510,7 @@ fm_status fm10000NonDisruptAddMappers(fm_int                  sw,
         }
         else
         {
-            mapperValue = fmAlloc(sizeOfMapper);
+            mapperValue = fmAllocTagged(sizeOfMapper, FM_LOG_CAT_ACL);
             if (mapperValue == NULL)
             {
                 goto ABORT;
@@ -5558,8 +6579,8 @@ fm_status fm10000NonDisruptAddEgressAclRule(fm_int                  sw,
     fm_uint64 ruleNumberKey;
     fm_int newPhysicalPos;
     fm_int duplicatePhysicalPos;
-    fm_tree abstractKey;
-    fm_tree remainAbstractKey;
+    fm_fm10000AbstractKey abstractKey;
+    fm_fm10000AbstractKey remainAbstractKey;
     fm_int numCondition;
     fm_int newNumCondition;
     fm_uint64 nextKey;
@@ -5606,7 +6627,8 @@ fm_status fm10000NonDisruptAddEgressAclRule(fm_int                  sw,
     }
 
     /* Allocate memory space for this new acl rule. */
-    newCompiledAclRule = fmAlloc(sizeof(fm_fm10000CompiledAclRule));
+    newCompiledAclRule = fmAllocTagged(sizeof(fm_fm10000CompiledAclRule),
+                                       FM_LOG_CAT_ACL);
     if (newCompiledAclRule == NULL)
     {
         err = FM_ERR_NO_MEM;
@@ -5621,18 +6643,14 @@ fm_status fm10000NonDisruptAddEgressAclRule(fm_int                  sw,
     newCompiledAclRule->portSetId = FM_PORT_SET_ALL;
     newCompiledAclRule->physicalPos = -1;
 
-    fmTreeInit(&abstractKey);
-
     /* Translate all the rule condition in abstract key. */
-    err = fmFillAbstractKeyTree(sw,
-                                NULL,
-                                rule,
-                                &abstractKey,
-                                NULL);
+    err = fmFillAbstractKey(sw,
+                            NULL,
+                            rule,
+                            &abstractKey,
+                            NULL);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-    fmTreeInit(&remainAbstractKey);
-
     /* Extract all the abstract keys that are already supported in this compiled
      * acl and return only the one that needs to be added. */
     err = FindUnconfiguredAbstract(compiledAcl,
@@ -5835,7 +6853,7 @@ fm_status fm10000NonDisruptAddEgressAclRule(fm_int                  sw,
     }
 
     /* Apply any mux select update that may remain */
-    if (fmTreeSize(&remainAbstractKey))
+    if (!IsAbstractKeySetEmpty(&remainAbstractKey))
     {
         if (apply)
         {
@@ -5997,16 +7015,6 @@ fm_status fm10000NonDisruptAddEgressAclRule(fm_int                  sw,
 
 ABORT:
 
-    if (fmTreeIsInitialized(&abstractKey))
-    {
-        fmTreeDestroy(&abstractKey, NULL);
-    }
-
-    if (fmTreeIsInitialized(&remainAbstractKey))
-    {
-        fmTreeDestroy(&remainAbstractKey, NULL);
-    }
-
     /* Free the allocated memory structure of the compiled rule if this rule
      * was not inserted in any other compiled acl structure. */
     if ( newCompiledAclRule && (newCompiledAclRule->physicalPos < 0) )
@@ -6055,8 +7063,8 @@ fm_status fm10000NonDisruptAddSelect(fm_int                  sw,
     void *nextValue;
     fm_treeIterator itRule;
     fm_uint64 ruleNumberKey;
-    fm_tree abstractKey;
-    fm_tree remainAbstractKey;
+    fm_fm10000AbstractKey abstractKey;
+    fm_fm10000AbstractKey remainAbstractKey;
     fm_uint initialPortSetNum;
     fm_int numCondition;
     fm_int newNumCondition;
@@ -6097,17 +7105,17 @@ fm_status fm10000NonDisruptAddSelect(fm_int                  sw,
     numAction = compiledAcl->sliceInfo.actionEnd -
                 compiledAcl->sliceInfo.keyEnd + 1;
 
-    fmTreeInit(&abstractKey);
+    FM_CLEAR(abstractKey);
     FM_CLEAR(remainAbstractKey);
 
     initialPortSetNum = fmTreeSize(compiledAcl->portSetId);
 
     /* Translate all the rule condition in abstract key. */
-    err = fmFillAbstractKeyTree(sw,
-                                NULL,
-                                rule,
-                                &abstractKey,
-                                compiledAcl->portSetId);
+    err = fmFillAbstractKey(sw,
+                            NULL,
+                            rule,
+                            &abstractKey,
+                            compiledAcl->portSetId);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
     /* New PortSet has been defined */
@@ -6122,14 +7130,13 @@ fm_status fm10000NonDisruptAddSelect(fm_int                  sw,
     }
 
     /* Add all the abstract key related to the portSet if needed. */
-    err = fmFillAbstractPortSetKeyTree(NULL,
-                                       rule,
-                                       &newCompiledAclRule,
-                                       &abstractKey,
-                                       compiledAcl->portSetId);
+    err = fmFillAbstractPortSetKey(NULL,
+                                   rule,
+                                   &newCompiledAclRule,
+                                   &abstractKey,
+                                   compiledAcl->portSetId);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-    fmTreeInit(&remainAbstractKey);
     /* Extract all the abstract key that are already supported in this compiled
      * acl and return only the one that needs to be added. */
     err = FindUnconfiguredAbstract(compiledAcl,
@@ -6475,7 +7482,7 @@ fm_status fm10000NonDisruptAddSelect(fm_int                  sw,
     }
 
     /* Apply any mux select update that may remain */
-    if (apply && fmTreeSize(&remainAbstractKey))
+    if (apply && !IsAbstractKeySetEmpty(&remainAbstractKey))
     {
         /* Translate the virtual mux selection to a concrete one. */
         fmInitializeMuxSelect(compiledAcl->muxSelect, tmpMuxSelect);
@@ -6492,16 +7499,6 @@ fm_status fm10000NonDisruptAddSelect(fm_int                  sw,
 
 ABORT:
 
-    if (fmTreeIsInitialized(&abstractKey))
-    {
-        fmTreeDestroy(&abstractKey, NULL);
-    }
-
-    if (fmTreeIsInitialized(&remainAbstractKey))
-    {
-        fmTreeDestroy(&remainAbstractKey, NULL);
-    }
-
     FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
 
 }   /* end fm10000NonDisruptAddSelect */
@@ -6562,11 +7559,7 @@ fm_status fm10000NonDisruptAddIngAclRule(fm_int                  sw,
     fm_acl *aclEntry;
     fm_aclRule *aclRuleEntry;
     fm_switch *switchPtr = GET_SWITCH_PTR(sw);
-    fm10000_switch * switchExt;
     fm_uint16 numRules;
-    fm_bool strictCount;
-    fm_fm10000CompiledPolicers *policers;
-    fm_fm10000CompiledPolicerEntry *compiledPolEntry;
     fm_uint32 freeCondMask;
     fm_uint32 freeActMask;
 
@@ -6585,7 +7578,6 @@ fm_status fm10000NonDisruptAddIngAclRule(fm_int                  sw,
                  ruleNumber,
                  apply);
 
-    switchExt = (fm10000_switch *) switchPtr->extension;
     info = &switchPtr->aclInfo;
 
     aclNumKey = FM_ACL_GET_MASTER_KEY(aclNumber);
@@ -6601,34 +7593,13 @@ fm_status fm10000NonDisruptAddIngAclRule(fm_int                  sw,
     err = fmTreeFind(&cacls->ingressAcl, aclNumKey, (void**) &compiledAcl);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-    /* Allocate memory space for this new acl rule. */
-    newCompiledAclRule = fmAlloc(sizeof(fm_fm10000CompiledAclRule));
-    if (newCompiledAclRule == NULL)
-    {
-        err = FM_ERR_NO_MEM;
-        goto ABORT;
-    }
-    FM_CLEAR(*newCompiledAclRule);
-
-    /* Basic rule configuration */
-    newCompiledAclRule->aclNumber = aclNumber;
-    newCompiledAclRule->ruleNumber = ruleNumber;
-    newCompiledAclRule->valid = rule->state;
-    newCompiledAclRule->portSetId = FM_PORT_SET_ALL;
-    newCompiledAclRule->physicalPos = -1;
-
-    err = fm10000CountActionSlicesNeeded(sw,
-                                         NULL,
-                                         rule,
-                                         &newCompiledAclRule->numActions);
+    err = AllocIngAclRule(sw,
+                          aclNumber,
+                          rule,
+                          ruleNumber,
+                          &newCompiledAclRule);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-    if (newCompiledAclRule->numActions > FM10000_ACL_MAX_ACTIONS_PER_RULE)
-    {
-        err = FM_ERR_INVALID_ACL_RULE;
-        goto ABORT;
-    }
-
     if (compiledAcl->numRules == FM10000_MAX_RULE_PER_ACL_PART)
     {
         err = fmGetSlicePosition(sw,
@@ -6666,7 +7637,8 @@ fm_status fm10000NonDisruptAddIngAclRule(fm_int                  sw,
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
         }
 
-        nextCompiledAcl = fmAlloc(sizeof(fm_fm10000CompiledAcl));
+        nextCompiledAcl = fmAllocTagged(sizeof(fm_fm10000CompiledAcl),
+                                        FM_LOG_CAT_ACL);
         if (nextCompiledAcl == NULL)
         {
             err = FM_ERR_NO_MEM;
@@ -6802,6 +7774,8 @@ fm_status fm10000NonDisruptAddIngAclRule(fm_int                  sw,
                                           newPhysicalPos + 1);
                 FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
             }
+            cacls->ndRuleWrites += numRules;
+            cacls->ndRuleMoves  += numRules;
 
             err = FM_OK;
             break;
@@ -6866,6 +7840,8 @@ fm_status fm10000NonDisruptAddIngAclRule(fm_int                  sw,
             }
 
             nextCompiledAclRule->physicalPos = newPhysicalPos;
+            cacls->ndRuleWrites++;
+            cacls->ndRuleMoves++;
 
             numRules = 0;
 
@@ -6890,7 +7866,8 @@ fm_status fm10000NonDisruptAddIngAclRule(fm_int                  sw,
                                               compiledAclRule->physicalPos);
                     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
                 }
-
+                cacls->ndRuleWrites += numRules;
+                cacls->ndRuleMoves  += numRules;
             }
             else
             {
@@ -6914,99 +7891,15 @@ fm_status fm10000NonDisruptAddIngAclRule(fm_int                  sw,
 
     newCompiledAclRule->physicalPos = newPhysicalPos;
 
-    /* Initialize the indexes of the policer. */
-    for (i = 0 ; i < FM_FM10000_POLICER_BANK_MAX ; i++)
-    {
-        newCompiledAclRule->policerIndex[i] = 0;
-    }
-
-    /* Configure the condition key and key mask based on the entered
-     * acl rule. */
-    err = fmConfigureConditionKey(sw,
-                                  NULL,
-                                  rule,
-                                  ruleNumber,
-                                  compiledAcl,
-                                  NULL);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-
-    strictCount = switchExt->aclStrictCount;
-
-    err = fm10000ConfigurePolicerBank(sw,
-                                      NULL,
-                                      cacls,
-                                      rule,
-                                      newCompiledAclRule,
-                                      strictCount);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-
-    /* Configure the action data based on the entered acl rule. */
-    err = fmConfigureActionData(sw,
-                                NULL,
-                                cacls->policers,
-                                &cacls->ecmpGroups,
-                                rule,
-                                compiledAcl,
-                                newCompiledAclRule);
+    err = ConfigureIngAclRule(sw,
+                              cacls,
+                              compiledAcl,
+                              rule,
+                              ruleNumber,
+                              newCompiledAclRule,
+                              apply);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-    if (apply)
-    {
-        for (i = 0 ; i < FM_FM10000_POLICER_BANK_MAX ; i++)
-        {
-            /* If the added rule needs a policer entry, configure it. */
-            if (newCompiledAclRule->policerIndex[i] != 0)
-            {
-                policers = &cacls->policers[i];
-
-                err = fmTreeFind(&policers->policerEntry,
-                                 newCompiledAclRule->policerIndex[i],
-                                 &nextValue);
-                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-
-                compiledPolEntry = (fm_fm10000CompiledPolicerEntry*) nextValue;
-
-                if (compiledPolEntry->countEntry)
-                {
-                    err = fm10000SetPolicerCounter(sw,
-                                                   i,
-                                                   newCompiledAclRule->policerIndex[i],
-                                                   FM_LITERAL_64(0),
-                                                   FM_LITERAL_64(0));
-                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-                }
-                else
-                {
-                    err = fm10000SetPolicer(sw,
-                                            i,
-                                            newCompiledAclRule->policerIndex[i],
-                                            &compiledPolEntry->committed,
-                                            &compiledPolEntry->excess);
-                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-
-                    err = fm10000SetPolicerConfig(sw,
-                                                  i,
-                                                  policers->indexLastPolicer,
-                                                  policers->ingressColorSource,
-                                                  policers->markDSCP,
-                                                  policers->markSwitchPri,
-                                                  TRUE);
-                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-                }
-            }
-        }
-
-        err = fm10000SetFFURule(sw,
-                                &compiledAcl->sliceInfo,
-                                newCompiledAclRule->physicalPos,
-                                newCompiledAclRule->valid,
-                                newCompiledAclRule->sliceKey,
-                                newCompiledAclRule->actions,
-                                TRUE, /* Live */
-                                TRUE);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
-    }
-
 ABORT:
 
     /* Free the allocated memory structure of the compiled rule if this rule
@@ -7112,7 +8005,7 @@ fm_status fm10000NonDisruptAddEgressAcl(fm_int                  sw,
     }
 
     /* Create a blank ACL */
-    compiledAcl = fmAlloc(sizeof(fm_fm10000CompiledAcl));
+    compiledAcl = fmAllocTagged(sizeof(fm_fm10000CompiledAcl), FM_LOG_CAT_ACL);
     if (compiledAcl == NULL)
     {
         err = FM_ERR_NO_MEM;
@@ -7135,7 +8028,7 @@ fm_status fm10000NonDisruptAddEgressAcl(fm_int                  sw,
     compiledAcl->sliceInfo.caseLocation = compiledAcl->caseLocation;
     fmTreeInit(&compiledAcl->rules);
 
-    compiledAcl->portSetId = fmAlloc(sizeof(fm_tree));
+    compiledAcl->portSetId = fmAllocTagged(sizeof(fm_tree), FM_LOG_CAT_ACL);
     if (compiledAcl->portSetId == NULL)
     {
         err = FM_ERR_NO_MEM;
@@ -7372,7 +8265,7 @@ fm_status fm10000NonDisruptAddIngAcl(fm_int                  sw,
     }
 
     /* Create a blank ACL */
-    compiledAcl = fmAlloc(sizeof(fm_fm10000CompiledAcl));
+    compiledAcl = fmAllocTagged(sizeof(fm_fm10000CompiledAcl), FM_LOG_CAT_ACL);
     if (compiledAcl == NULL)
     {
         err = FM_ERR_NO_MEM;
@@ -7394,7 +8287,7 @@ fm_status fm10000NonDisruptAddIngAcl(fm_int                  sw,
     compiledAcl->sliceInfo.caseLocation = compiledAcl->caseLocation;
     fmTreeInit(&compiledAcl->rules);
 
-    compiledAcl->portSetId = fmAlloc(sizeof(fm_tree));
+    compiledAcl->portSetId = fmAllocTagged(sizeof(fm_tree), FM_LOG_CAT_ACL);
     if (compiledAcl->portSetId == NULL)
     {
         fmFreeCompiledAcl(compiledAcl);
@@ -7510,6 +8403,7 @@ fm_status fm10000NonDisruptAddAcls(fm_int                  sw,
     fm_int nextRuleToInsert;
     fm_int i;
     fm_int aclPartFreeSize;
+    fm_int numPending;
 
     FM_LOG_ENTRY(FM_LOG_CAT_ACL,
                  "sw = %d, "
@@ -7555,10 +8449,7 @@ fm_status fm10000NonDisruptAddAcls(fm_int                  sw,
 
         /* ACL with assigned port will be skip if no ports are part of that
          * switch. This situation only make sense on SWAG. */
-        if ( ((acl->aclPortType == FM_ACL_PORT_TYPE_INGRESS) &&
-              (acl->numberOfPorts[FM_ACL_TYPE_INGRESS] == 0)) ||
-             ((acl->aclPortType == FM_ACL_PORT_TYPE_EGRESS) &&
-              (acl->numberOfPorts[FM_ACL_TYPE_EGRESS] == 0)) )
+        if (IsAclPortless(acl))
         {
             continue;
         }
@@ -7640,8 +8531,29 @@ fm_status fm10000NonDisruptAddAcls(fm_int                  sw,
             err = fmTreeFind(&cacls->ingressAcl, aclNumKey, (void**) &compiledAcl);
             if (err == FM_OK)
             {
+                err = CountPendingIngAclRules(compiledAcl, acl, &numPending);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+                /* Single Part that can hold all the added rules */
+                if ( (fmTreeFind(&cacls->ingressAcl,
+                                 aclNumKey + 1LL,
+                                 &nextValue) == FM_ERR_NOT_FOUND) &&
+                     ((compiledAcl->numRules + numPending) <=
+                      FM10000_MAX_RULE_PER_ACL_PART) )
+                {
+                    if (numPending)
+                    {
+                        err = AddIngAclRules(sw,
+                                             cacls,
+                                             compiledAcl,
+                                             acl,
+                                             aclNumber,
+                                             apply);
+                        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+                    }
+                }
                 /* Single Part handling or single rule addition */
-                if ((fmTreeSize(&acl->addedRules) <=
+                else if ((fmTreeSize(&acl->addedRules) <=
                      (FM10000_MAX_RULE_PER_ACL_PART - compiledAcl->numRules)) ||
                     (fmTreeSize(&acl->addedRules) <= 1))
                 {
@@ -7987,8 +8899,8 @@ fm_status fm10000NonDisruptQuickUpdate(fm_int sw, fm_int acl, fm_int rule)
     fm_fm10000CompiledAcl *    compiledAcl;
     fm_uint64                  aclNumKey;
     fm_tree                    portSetKey;
-    fm_tree                    abstractKey;
-    fm_tree                    remainAbstractKey;
+    fm_fm10000AbstractKey      abstractKey;
+    fm_fm10000AbstractKey      remainAbstractKey;
     fm_treeIterator            itPortSet;
     fm_uint64                  portSetNumber;
     void *                     nextValue;
@@ -8077,15 +8989,14 @@ fm_status fm10000NonDisruptQuickUpdate(fm_int sw, fm_int acl, fm_int rule)
         }
     }
 
-    fmTreeInit(&abstractKey);
     fmTreeInit(&portSetKey);
 
     /* Translate all the rule condition in abstract key. */
-    err = fmFillAbstractKeyTree(sw,
-                                NULL,
-                                aclRuleEntry,
-                                &abstractKey,
-                                &portSetKey);
+    err = fmFillAbstractKey(sw,
+                            NULL,
+                            aclRuleEntry,
+                            &abstractKey,
+                            &portSetKey);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
     /* PortSet has been defined as condition */
@@ -8105,7 +9016,6 @@ fm_status fm10000NonDisruptQuickUpdate(fm_int sw, fm_int acl, fm_int rule)
         }
     }
 
-    fmTreeInit(&remainAbstractKey);
     /* Extract all the abstract key that are already supported in this compiled
      * acl and return only the one that needs to be added. */
     err = FindUnconfiguredAbstract(compiledAcl,
@@ -8115,7 +9025,7 @@ fm_status fm10000NonDisruptQuickUpdate(fm_int sw, fm_int acl, fm_int rule)
 
     /* This Quick Update function does not support new keys. If so, call a
      * full recompile/apply sequence. */
-    if (fmTreeSize(&remainAbstractKey))
+    if (!IsAbstractKeySetEmpty(&remainAbstractKey))
     {
         err = FM_ERR_INVALID_ACL_RULE;
         goto ABORT;
@@ -8387,21 +9297,11 @@ fm_status fm10000NonDisruptQuickUpdate(fm_int sw, fm_int acl, fm_int rule)
 
 ABORT:
 
-    if (fmTreeIsInitialized(&abstractKey))
-    {
-        fmTreeDestroy(&abstractKey, NULL);
-    }
-
     if (fmTreeIsInitialized(&portSetKey))
     {
         fmTreeDestroy(&portSetKey, NULL);
     }
 
-    if (fmTreeIsInitialized(&remainAbstractKey))
-    {
-        fmTreeDestroy(&remainAbstractKey, NULL);
-    }
-
 
     FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
 
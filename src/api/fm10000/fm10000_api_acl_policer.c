@@ -242,7 +242,7 @@ static fm_status SelectPolicerBank(fm_int                     sw,
         }
         else if (err == FM_ERR_NOT_FOUND)
         {
-            aclNumElement = (fm_int *) fmAlloc(sizeof(fm_int));
+            aclNumElement = (fm_int *) fmAllocTagged(sizeof(fm_int), FM_LOG_CAT_ACL);
             if (aclNumElement == NULL)
             {
                 err = FM_ERR_NO_MEM;
@@ -339,7 +339,8 @@ static fm_status SelectPolicerBank(fm_int                     sw,
                         }
                         if (err == FM_OK)
                         {
-                            aclNumElement = (fm_int *) fmAlloc(sizeof(fm_int));
+                            aclNumElement = (fm_int *) fmAllocTagged(sizeof(fm_int),
+                                                                     FM_LOG_CAT_ACL);
                             if (aclNumElement == NULL)
                             {
                                 err = FM_ERR_NO_MEM;
@@ -376,7 +377,8 @@ static fm_status SelectPolicerBank(fm_int                     sw,
                         err = fm10000SetPolicerOwnership(sw, FM_FFU_OWNER_ACL, i);
                         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-                        aclNumElement = (fm_int *) fmAlloc(sizeof(fm_int));
+                        aclNumElement = (fm_int *) fmAllocTagged(sizeof(fm_int),
+                                                                 FM_LOG_CAT_ACL);
                         if (aclNumElement == NULL)
                         {
                             err = FM_ERR_NO_MEM;
@@ -470,7 +472,8 @@ static fm_status SelectPolicerBank(fm_int                     sw,
             }
             else if (err == FM_ERR_NOT_FOUND)
             {
-                aclNumElement = (fm_int *) fmAlloc(sizeof(fm_int));
+                aclNumElement = (fm_int *) fmAllocTagged(sizeof(fm_int),
+                                                         FM_LOG_CAT_ACL);
                 if (aclNumElement == NULL)
                 {
                     err = FM_ERR_NO_MEM;
@@ -557,7 +560,8 @@ static fm_status AddPolicerEntry(fm_int                     sw,
         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ACL, err);
     }
 
-    compiledPolEntry = (fm_fm10000CompiledPolicerEntry *) fmAlloc(sizeof(fm_fm10000CompiledPolicerEntry));
+    compiledPolEntry = (fm_fm10000CompiledPolicerEntry *) fmAllocTagged(sizeof(fm_fm10000CompiledPolicerEntry),
+                                                                        FM_LOG_CAT_ACL);
     if (compiledPolEntry == NULL)
     {
         err = FM_ERR_NO_MEM;
@@ -624,7 +628,8 @@ static fm_status AddPolicerEntry(fm_int                     sw,
 
     /* Every Policer entry are mapped to at least one ACL/Rule tuple but can
      * be multiple if multiple rules police to a single ID. */
-    aclRule = (fm_fm10000AclRule *) fmAlloc(sizeof(fm_fm10000AclRule));
+    aclRule = (fm_fm10000AclRule *) fmAllocTagged(sizeof(fm_fm10000AclRule),
+                                                  FM_LOG_CAT_ACL);
     if (aclRule == NULL)
     {
         fmFree(compiledPolEntry);
@@ -831,7 +836,8 @@ fm_status fm10000PreallocatePolicerBank(fm_int                     sw,
                 }
                 else if (err == FM_ERR_NOT_FOUND)
                 {
-                    aclNumElement = (fm_int *) fmAlloc(sizeof(fm_int));
+                    aclNumElement = (fm_int *) fmAllocTagged(sizeof(fm_int),
+                                                             FM_LOG_CAT_ACL);
                     if (aclNumElement == NULL)
                     {
                         err = FM_ERR_NO_MEM;
@@ -854,7 +860,8 @@ fm_status fm10000PreallocatePolicerBank(fm_int                     sw,
                                  (void **) &compiledPolEntry);
                 FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-                aclRule = (fm_fm10000AclRule *) fmAlloc(sizeof(fm_fm10000AclRule));
+                aclRule = (fm_fm10000AclRule *) fmAllocTagged(sizeof(fm_fm10000AclRule),
+                                                              FM_LOG_CAT_ACL);
                 if (aclRule == NULL)
                 {
                     FM_LOG_EXIT(FM_LOG_CAT_ACL, FM_ERR_NO_MEM);
@@ -1120,7 +1127,8 @@ fm_status fm10000ConfigurePolicerBank(fm_int                     sw,
                     }
                     else if (err == FM_ERR_NOT_FOUND)
                     {
-                        aclNumElement = (fm_int *) fmAlloc(sizeof(fm_int));
+                        aclNumElement = (fm_int *) fmAllocTagged(sizeof(fm_int),
+                                                                 FM_LOG_CAT_ACL);
                         if (aclNumElement == NULL)
                         {
                             err = FM_ERR_NO_MEM;
@@ -1143,7 +1151,8 @@ fm_status fm10000ConfigurePolicerBank(fm_int                     sw,
                                      (void **) &compiledPolEntry);
                     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ACL, err);
 
-                    aclRule = (fm_fm10000AclRule *) fmAlloc(sizeof(fm_fm10000AclRule));
+                    aclRule = (fm_fm10000AclRule *) fmAllocTagged(sizeof(fm_fm10000AclRule),
+                                                                  FM_LOG_CAT_ACL);
                     if (aclRule == NULL)
                     {
                         FM_LOG_EXIT(FM_LOG_CAT_ACL, FM_ERR_NO_MEM);
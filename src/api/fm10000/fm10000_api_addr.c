@@ -40,6 +40,40 @@
 #define L2L_HASH_TABLE_SIZE             256
 #define MAX_UINT_VALUE                  4294967295
 
+/* Maximum number of MA table entries examined under a single hold of the
+ * L2 lock by a paged readout. */
+#define PAGE_CHUNK_SIZE                 64
+
+/* MA Table occupancy, in percent, above which a warning is logged, and
+ * below which the warning is re-armed. */
+#define OCCUPANCY_WARN_PERCENT          90
+#define OCCUPANCY_REARM_PERCENT         80
+
+/* Work item for one entry of an address list operation. */
+typedef struct _fm10000_addrListItem
+{
+    /* Hash table indexes of the entry. */
+    fm_uint16               indexes[FM10000_MAC_ADDR_BANK_COUNT];
+
+    /* Learning FID of the entry. */
+    fm_uint16               fid;
+
+    /* Trigger identifier to be stored in the entry. */
+    fm_uint32               trigger;
+
+    /* MA Table index the entry was written to or deleted from,
+     * or -1 if the entry was skipped. */
+    fm_int                  hashIndex;
+
+    /* Whether the overwritten entry needs to be aged out. */
+    fm_bool                 ageOld;
+
+    /* Cache entry before and after the operation. */
+    fm_internalMacAddrEntry oldEntry;
+    fm_internalMacAddrEntry newEntry;
+
+} fm10000_addrListItem;
+
 
 /*****************************************************************************
  * Global Variables
@@ -61,8 +95,150 @@
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/** RecordHotBin
+ * \ingroup intAddr
+ *
+ * \desc            Counts an overflow of a MA Table bin in the list of the
+ *                  most colliding bins. When the list is full, the least
+ *                  counted bin is replaced and its count inherited, so the
+ *                  bins that overflow most often stay in the list.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       stats points to the MA Table statistics.
+ *
+ * \param[in]       hashIndex is the index the bin hashes to in the first
+ *                  bank.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void RecordHotBin(fm_macTableStats *stats, fm_int hashIndex)
+{
+    fm_macTableHotBin *bins;
+    fm_macTableHotBin  tmp;
+    fm_int             slot;
+    fm_int             i;
+
+    bins = stats->hotBins;
+    slot = FM_MAC_TABLE_NUM_HOT_BINS - 1;
+
+    for (i = 0 ; i < FM_MAC_TABLE_NUM_HOT_BINS ; i++)
+    {
+        if (bins[i].numFull == 0 || bins[i].hashIndex == hashIndex)
+        {
+            slot = i;
+            break;
+        }
+    }
+
+    bins[slot].hashIndex = hashIndex;
+    bins[slot].numFull++;
+
+    /* Keep the list sorted, most often first. */
+    while (slot > 0 && bins[slot].numFull > bins[slot - 1].numFull)
+    {
+        tmp              = bins[slot - 1];
+        bins[slot - 1]   = bins[slot];
+        bins[slot]       = tmp;
+        slot--;
+    }
+
+}   /* end RecordHotBin */
+
+
+
+
+/*****************************************************************************/
+/** RecordBinStats
+ * \ingroup intAddr
+ *
+ * \desc            Updates the MA Table occupancy and collision statistics
+ *                  once a bin has been searched for a new address, and
+ *                  warns when the table is close to saturation.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       indexes is the array of MA Table indexes of the bin.
+ *
+ * \param[in]       numOccupied is the number of entries of the bin in use.
+ *
+ * \param[in]       binFull is TRUE if the address could not be added.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void RecordBinStats(fm_int     sw,
+                           fm_uint16 *indexes,
+                           fm_int     numOccupied,
+                           fm_bool    binFull)
+{
+    fm_switch *       switchPtr;
+    fm10000_switch *  switchExt;
+    fm_macTableStats *stats;
+    fm_int            numValid;
+    fm_int            percent;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    switchExt = GET_SWITCH_EXT(sw);
+    stats     = &switchExt->maTableStats;
+
+    if (numOccupied <= FM_MAX_MAC_TABLE_BIN_SIZE)
+    {
+        stats->binOccupancy[numOccupied]++;
+    }
+
+    numValid = fmAddrIndexCountValid(switchPtr);
+
+    if (binFull)
+    {
+        stats->numBinFull++;
+
+        if (stats->validAtFirstBinFull == 0)
+        {
+            stats->validAtFirstBinFull = numValid;
+        }
+
+        RecordHotBin(stats, indexes[0]);
+        return;
+    }
+
+    /* The address goes in an unused entry unless the bin is full. */
+    if (numOccupied < switchPtr->macTableBankCount)
+    {
+        numValid++;
+    }
+
+    if (numValid > stats->peakValid)
+    {
+        stats->peakValid = numValid;
+    }
+
+    percent = (numValid * 100) / switchPtr->macTableSize;
+
+    if (!switchExt->maOccupancyWarned && percent >= OCCUPANCY_WARN_PERCENT)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_ADDR,
+                       "MA Table of switch %d is %d%% full "
+                       "(%" FM_FORMAT_64 "u bin overflows)\n",
+                       sw,
+                       percent,
+                       stats->numBinFull);
+        switchExt->maOccupancyWarned = TRUE;
+    }
+    else if (switchExt->maOccupancyWarned && percent < OCCUPANCY_REARM_PERCENT)
+    {
+        switchExt->maOccupancyWarned = FALSE;
+    }
+
+}   /* end RecordBinStats */
+
+
+
 
-    
 /*****************************************************************************/
 /** FindBestIndex
  * \ingroup intAddr
@@ -117,6 +293,7 @@ static fm_status FindBestIndex(fm_int              sw,
     fm_int                      dynamicEntry;
     fm_int                      expiredEntry;
     fm_int                      matchingEntry;
+    fm_int                      numOccupied;
     fm_status                   err;
     fm_bool                     isDynamic;
     fm_bool                     isStatic;
@@ -143,6 +320,7 @@ static fm_status FindBestIndex(fm_int              sw,
     matchingEntry   = -1;
     unusedEntry     = -1;
     expiredEntry    = -1;
+    numOccupied     = 0;
 
     isDynamic       = FALSE;
     isStatic        = FALSE;
@@ -169,6 +347,11 @@ static fm_status FindBestIndex(fm_int              sw,
     for (bankId = 0 ; bankId < switchPtr->macTableBankCount ; bankId++)
     {
         cachePtr = &switchPtr->maTable[indexes[bankId]];
+
+        if (cachePtr->state != FM_MAC_ENTRY_STATE_INVALID)
+        {
+            numOccupied++;
+        }
         
         /**************************************************
          * Process unused entry.
@@ -442,6 +625,16 @@ static fm_status FindBestIndex(fm_int              sw,
                  FM_BOOLSTRING(*ageOld));
     
 ABORT:
+    /* Only new addresses tell how crowded the bins are. */
+    if ( matchingEntry == -1 &&
+         (err == FM_OK || err == FM_ERR_ADDR_BANK_FULL) )
+    {
+        RecordBinStats(sw,
+                       indexes,
+                       numOccupied,
+                       (err == FM_ERR_ADDR_BANK_FULL) );
+    }
+
     FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ADDR, err);
     
 }   /* end FindBestIndex */
@@ -561,55 +754,30 @@ static fm_status ValidateAddressFields(fm_macAddressEntry * entry)
 
 
 
-/*****************************************************************************
- * Public Functions
- *****************************************************************************/
-
-
-
-
 /*****************************************************************************/
-/** fm10000AddAddress
+/** ValidateAddressEntry
  * \ingroup intAddr
  *
- * \desc            Adds an entry to the MA Table. See ''fmAddAddress'' for
- *                  other information. Called through the AddAddress function
- *                  pointer.
+ * \desc            Validates an address entry to be added, including its
+ *                  destination port or tunnel rule.
  *
  * \param[in]       sw is the switch on which to operate.
  *
- * \param[in,out]   entry points to an ''fm_macAddressEntry'' structure that
+ * \param[in]       entry points to an ''fm_macAddressEntry'' structure that
  *                  describes the MA Table entry to be added.
  *
  * \return          FM_OK if successful.
- * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
- * \return          FM_ERR_INVALID_ARGUMENT if the entry type is unsupported.
- * \return          FM_ERR_ADDR_BANK_FULL if no room in MA Table for this
- *                  address.
- * \return          FM_ERR_USE_MCAST_FUNCTIONS if an attempt was made to
- *                  add a MAC address to a multicast group.
- * \return          FM_ERR_TUNNEL_INVALID_ENTRY if the entry specified when
- *                  using isTunnelEntry is not valid.
- * \return          FM_ERR_UNSUPPORTED if the retrieved tunnel entry GloRT
- *                  makes use of user field.
+ * \return          FM_ERR_INVALID_ARGUMENT if one or more of the fields
+ *                  is invalid.
+ * \return          FM_ERR_UNSUPPORTED if the tunnel entry GloRT makes use
+ *                  of user field.
  *
  *****************************************************************************/
-fm_status fm10000AddAddress(fm_int sw, fm_macAddressEntry *entry)
+static fm_status ValidateAddressEntry(fm_int sw, fm_macAddressEntry *entry)
 {
-    fm_uint32       trigger;
-    fm_status       err;
+    fm_status          err;
     fm_tunnelGlortUser glortUser;
 
-    FM_LOG_ENTRY(FM_LOG_CAT_ADDR,
-                 "sw=%d "
-                 "macAddress=" FM_FORMAT_ADDR " "
-                 "vlanID=%d "
-                 "port=%d\n",
-                 sw,
-                 entry->macAddress,
-                 entry->vlanID,
-                 entry->port);
-
     /* Validate the address. */
     err = ValidateAddressFields(entry);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
@@ -638,116 +806,609 @@ fm_status fm10000AddAddress(fm_int sw, fm_macAddressEntry *entry)
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
         }
     }
-    /* Select trigger identifier to use. */
-    err = fm10000AssignMacTrigger(sw, entry, &trigger);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
-
-    /* Add address to MAC table. */
-    err = fmAddAddressToTableInternal(sw, entry, trigger, TRUE, -1);
 
 ABORT:
-    FM_LOG_EXIT(FM_LOG_CAT_ADDR, err);
+    return err;
 
-}   /* end fm10000AddAddress */
+}   /* end ValidateAddressEntry */
 
 
 
 
 /*****************************************************************************/
-/** fm10000AddMacTableEntry
+/** InitCacheEntry
  * \ingroup intAddr
  *
- * \desc            Adds an entry to the MAC Address table.
+ * \desc            Initializes the MA Table cache entry for an address
+ *                  being added.
  *
  * \param[in]       sw is the switch on which to operate.
  *
  * \param[in]       entry points to the entry structure to add.
- * 
- * \param[in]       source is the source of the MA table entry.
  *
  * \param[in]       trigger is the trigger identifier to be stored in the
  *                  MA Table entry.
  *
- * \param[in,out]   numUpdates points to a variable containing the number of
- *                  updates stored in the event buffer. Will be updated if
- *                  an event is added to the buffer.
- *
- * \param[in,out]   outEvent points to a variable containing a pointer to
- *                  the buffer to which the learning and aging events
- *                  should be added. May be NULL, in which case an event
- *                  buffer will be allocated if one is needed. Will be
- *                  updated to point to the new event buffer.
+ * \param[out]      newEntry points to the cache entry to initialize.
  *
  * \return          FM_OK if successful.
- * \return          FM_ERR_ADDR_BANK_FULL if there is no room in the MA table
- *                  for the specified address.
  * \return          FM_ERR_TUNNEL_INVALID_ENTRY if the entry specified when
  *                  using isTunnelEntry is not valid.
  * \return          FM_ERR_UNSUPPORTED if the retrieved tunnel entry GloRT
  *                  makes use of user field.
  *
  *****************************************************************************/
-fm_status fm10000AddMacTableEntry(fm_int               sw,
-                                  fm_macAddressEntry * entry,
-                                  fm_macSource         source,
-                                  fm_uint32            trigger,
-                                  fm_uint32 *          numUpdates,
-                                  fm_event **          outEvent)
+static fm_status InitCacheEntry(fm_int                    sw,
+                                fm_macAddressEntry *      entry,
+                                fm_uint32                 trigger,
+                                fm_internalMacAddrEntry * newEntry)
 {
-    fm_internalMacAddrEntry oldEntry;
-    fm_internalMacAddrEntry newEntry;
-
-    fm_switch *     switchPtr;
-    fm_uint16       indexes[FM10000_MAC_ADDR_BANK_COUNT];
-    fm_int          bestIndex;
-    fm_uint32       dupMask;
-    fm_bool         ageOld;
-    fm_bool         l2Locked = FALSE;
-    fm_bool         isSecure;
-    fm_bool         isTcnEvent;
-    fm_bool         isAddrChange;
-    fm_int          hashIndex;
-    fm_int          i;
-    fm_int          reason;
-    fm_status       err;
+    fm_status          err;
     fm_tunnelGlortUser glortUser;
 
-    FM_LOG_ENTRY(FM_LOG_CAT_ADDR,
-                 "sw=%d macAddress=%012llx vlanID=%u type=%s "
-                 "source=%s trigger=%d "
-                 "numUpdates=%u outEvent=%p\n",
-                 sw,
-                 entry->macAddress,
-                 entry->vlanID,
-                 fmAddressTypeToText(entry->type),
-                 fmMacSourceToText(source),
-                 (fm_int) trigger,
-                 *numUpdates,
-                 (void *) *outEvent);
- 
-    switchPtr = GET_SWITCH_PTR(sw);
-    
-    /**************************************************
-     * Assign trigger if we don't have one.
-     **************************************************/
+    FM_CLEAR(*newEntry);
 
-    if (trigger == FM_DEFAULT_TRIGGER)
+    newEntry->destMask   = FM_DESTMASK_UNUSED;
+    newEntry->port       = entry->port;
+    newEntry->vlanID     = entry->vlanID;
+    newEntry->macAddress = entry->macAddress;
+    newEntry->addrType   = entry->type;
+    newEntry->secure     = FM_IS_ADDR_TYPE_SECURE(entry->type);
+
+    if (entry->isTunnelEntry)
     {
-        err = fm10000AssignMacTrigger(sw, entry, &trigger);
+        newEntry->isTunnelEntry = TRUE;
+        err = fm10000GetTunnelAttribute(sw,
+                                        entry->tunnelGrp,
+                                        entry->tunnelRule,
+                                        FM_TUNNEL_GLORT_USER,
+                                        &glortUser);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+
+        /* Only accept glortUser that doesn't make use of the user
+         * field. */
+        if ( (glortUser.userMask != 0) ||
+             (glortUser.glortMask != 0xFFFF) )
+        {
+            err = FM_ERR_UNSUPPORTED;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+        }
+        newEntry->glort = (fm_uint32) glortUser.glort;
+        newEntry->tunnelGrp = entry->tunnelGrp;
+        newEntry->tunnelRule = entry->tunnelRule;
     }
-    
+    else
+    {
+        newEntry->isTunnelEntry = FALSE;
+        err = fmGetLogicalPortGlort(sw, entry->port, &newEntry->glort);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+    }
+
+    if (FM_IS_ADDR_TYPE_STATIC(entry->type))
+    {
+        newEntry->state = FM_MAC_ENTRY_STATE_LOCKED;
+    }
+    else
+    {
+        newEntry->state = FM_MAC_ENTRY_STATE_YOUNG;
+        newEntry->agingCounter = fm10000GetAgingTimer();
+    }
+
+    if (trigger != FM_DEFAULT_TRIGGER)
+    {
+        newEntry->trigger = trigger;
+    }
+
+ABORT:
+    return err;
+
+}   /* end InitCacheEntry */
+
+
+
+
+/*****************************************************************************/
+/** ReportAddedEntry
+ * \ingroup intAddr
+ *
+ * \desc            Reports the AGED event for an overwritten MA Table entry
+ *                  and the LEARNED event for the entry that replaced it,
+ *                  as required by the event generation attributes.
+ *
+ * \note            The L2 lock must not be held by the caller.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       source is the source of the MA table entry.
+ *
+ * \param[in]       ageOld is TRUE if the old entry was aged out to make
+ *                  room for the new one.
+ *
+ * \param[in]       hashIndex is the MA Table index of the entry.
+ *
+ * \param[in]       oldEntry points to the overwritten cache entry.
+ *
+ * \param[in]       newEntry points to the new cache entry.
+ *
+ * \param[in,out]   numUpdates points to a variable containing the number of
+ *                  updates stored in the event buffer.
+ *
+ * \param[in,out]   outEvent points to a variable containing a pointer to
+ *                  the buffer to which the events should be added.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReportAddedEntry(fm_int                    sw,
+                             fm_macSource              source,
+                             fm_bool                   ageOld,
+                             fm_int                    hashIndex,
+                             fm_internalMacAddrEntry * oldEntry,
+                             fm_internalMacAddrEntry * newEntry,
+                             fm_uint32 *               numUpdates,
+                             fm_event **               outEvent)
+{
+    fm_switch * switchPtr;
+    fm_bool     isTcnEvent;
+    fm_bool     isAddrChange;
+    fm_int      reason;
+
+    switchPtr  = GET_SWITCH_PTR(sw);
+    isTcnEvent = FM_IS_MAC_SOURCE_TCN_FIFO(source);
+
     /**************************************************
-     * Find out whether this is a secure entry.
+     * Whether this is an address change event.
      **************************************************/
 
-    isSecure = FM_IS_ADDR_TYPE_SECURE(entry->type);
+    isAddrChange =
+        oldEntry->state != FM_MAC_ENTRY_STATE_INVALID &&
+        oldEntry->macAddress == newEntry->macAddress &&
+        oldEntry->vlanID == newEntry->vlanID;
     
     /**************************************************
-     * Find out whether this is a TCN FIFO event.
+     * Report an AGED event for the overwritten entry.
      **************************************************/
 
-    isTcnEvent = FM_IS_MAC_SOURCE_TCN_FIFO(source);
+    if (ageOld)
+    {
+        /* Determine reason for LEARN and AGE events. */
+        if (isAddrChange) 
+        {
+            reason =
+                (isTcnEvent) ?
+                FM_MAC_REASON_LEARN_CHANGED :
+                FM_MAC_REASON_API_LEARN_CHANGED;
+        }
+        else 
+        {
+            reason =
+                (isTcnEvent) ?
+                FM_MAC_REASON_LEARN_REPLACED :
+                FM_MAC_REASON_API_LEARN_REPLACED;
+        }
+
+        /**************************************************
+         * Report an AGED event for the old entry if: 
+         * 1) This is a TCN FIFO event, or
+         * 2) We are removing a static address and
+         *    generateEventOnStaticAddr is in effect, or
+         * 3) We are removing a dynamic address and
+         *    generateEventOnDynamicAddr is in effect, or
+         * 4) We are changing an existing address and
+         *    generateEventOnAddrChange is in effect.
+         **************************************************/
+
+        if ( isTcnEvent ||
+             (oldEntry->state == FM_MAC_ENTRY_STATE_LOCKED &&
+              switchPtr->generateEventOnStaticAddr) ||
+             (oldEntry->state != FM_MAC_ENTRY_STATE_LOCKED &&
+              switchPtr->generateEventOnDynamicAddr) ||
+             (isAddrChange && switchPtr->generateEventOnAddrChange) )
+        {
+            fmGenerateUpdateForEvent(sw,
+                                     &fmRootApi->eventThread,
+                                     FM_EVENT_ENTRY_AGED,
+                                     reason,
+                                     hashIndex,
+                                     oldEntry,
+                                     numUpdates,
+                                     outEvent);
+
+            if (isTcnEvent)
+            {
+                fmDbgDiagCountIncr(sw, FM_CTR_MAC_LEARN_AGED, 1);
+            }
+            else
+            {
+                fmDbgDiagCountIncr(sw, FM_CTR_MAC_API_AGED, 1);
+            }
+        }
+    }
+    else
+    {
+        /* Determine reason for LEARN event. */
+        reason =
+            (isTcnEvent) ?
+            FM_MAC_REASON_LEARN_EVENT :
+            FM_MAC_REASON_API_LEARNED;
+    }
+    
+    /**************************************************
+     * Report a LEARNED event for the new entry if:
+     * 1) This is a TCN FIFO event, or
+     * 2) We are adding a static address and
+     *    generateEventOnStaticAddr is in effect, or
+     * 3) We are adding a dynamic address and
+     *    generateEventOnDynamicAddr is in effect, or
+     * 4) We are changing an existing address and
+     *    generateEventOnAddrChange is in effect.
+     **************************************************/
+
+    if ( isTcnEvent ||
+         (newEntry->state == FM_MAC_ENTRY_STATE_LOCKED &&
+          switchPtr->generateEventOnStaticAddr) ||
+         (newEntry->state != FM_MAC_ENTRY_STATE_LOCKED &&
+          switchPtr->generateEventOnDynamicAddr) ||
+         (isAddrChange && switchPtr->generateEventOnAddrChange) )
+    {
+        fmGenerateUpdateForEvent(sw,
+                                 &fmRootApi->eventThread,
+                                 FM_EVENT_ENTRY_LEARNED,
+                                 reason,
+                                 hashIndex,
+                                 newEntry,
+                                 numUpdates,
+                                 outEvent);
+
+        if (isTcnEvent)
+        {
+            fmDbgDiagCountIncr(sw, FM_CTR_MAC_LEARN_LEARNED, 1);
+        }
+        else
+        {
+            fmDbgDiagCountIncr(sw, FM_CTR_MAC_API_LEARNED, 1);
+        }
+
+        if (source == FM_MAC_SOURCE_TCN_MOVED)
+        {
+            fmDbgDiagCountIncr(sw, FM_CTR_MAC_LEARN_PORT_CHANGED, 1);
+        }
+    }
+
+}   /* end ReportAddedEntry */
+
+
+
+
+/*****************************************************************************/
+/** CompareTableIndexes
+ * \ingroup intAddr
+ *
+ * \desc            Compares two MA Table indexes for qsort.
+ *
+ * \param[in]       a points to the first index.
+ *
+ * \param[in]       b points to the second index.
+ *
+ * \return          Negative, zero or positive as a is below, equal to or
+ *                  above b.
+ *
+ *****************************************************************************/
+static int CompareTableIndexes(const void *a, const void *b)
+{
+    fm_uint32 indexA = *( (const fm_uint32 *) a );
+    fm_uint32 indexB = *( (const fm_uint32 *) b );
+
+    return (indexA > indexB) - (indexA < indexB);
+
+}   /* end CompareTableIndexes */
+
+
+
+
+/*****************************************************************************/
+/** WriteTableIndexes
+ * \ingroup intAddr
+ *
+ * \desc            Writes the cached contents of a set of MA Table entries
+ *                  to the hardware. The entries are written in index order,
+ *                  so that the writes to each bank are contiguous, and an
+ *                  entry that was modified more than once is written once.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   tableIndexes points to the array of MA Table indexes to
+ *                  write. The array is sorted by this function.
+ *
+ * \param[in]       numIndexes is the number of entries in tableIndexes.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status WriteTableIndexes(fm_int      sw,
+                                   fm_uint32 * tableIndexes,
+                                   fm_int      numIndexes)
+{
+    fm_switch * switchPtr;
+    fm_status   err;
+    fm_status   status;
+    fm_int      i;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    err       = FM_OK;
+
+    qsort(tableIndexes, numIndexes, sizeof(fm_uint32), CompareTableIndexes);
+
+    for (i = 0 ; i < numIndexes ; i++)
+    {
+        if (i > 0 && tableIndexes[i] == tableIndexes[i - 1])
+        {
+            continue;
+        }
+
+        status = fmWriteEntryAtIndex(sw,
+                                     tableIndexes[i],
+                                     &switchPtr->maTable[tableIndexes[i]]);
+        FM_ERR_COMBINE(err, status);
+    }
+
+    return err;
+
+}   /* end WriteTableIndexes */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+
+
+/*****************************************************************************/
+/** fm10000AddAddress
+ * \ingroup intAddr
+ *
+ * \desc            Adds an entry to the MA Table. See ''fmAddAddress'' for
+ *                  other information. Called through the AddAddress function
+ *                  pointer.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   entry points to an ''fm_macAddressEntry'' structure that
+ *                  describes the MA Table entry to be added.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if the entry type is unsupported.
+ * \return          FM_ERR_ADDR_BANK_FULL if no room in MA Table for this
+ *                  address.
+ * \return          FM_ERR_USE_MCAST_FUNCTIONS if an attempt was made to
+ *                  add a MAC address to a multicast group.
+ * \return          FM_ERR_TUNNEL_INVALID_ENTRY if the entry specified when
+ *                  using isTunnelEntry is not valid.
+ * \return          FM_ERR_UNSUPPORTED if the retrieved tunnel entry GloRT
+ *                  makes use of user field.
+ *
+ *****************************************************************************/
+fm_status fm10000AddAddress(fm_int sw, fm_macAddressEntry *entry)
+{
+    fm_uint32       trigger;
+    fm_status       err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ADDR,
+                 "sw=%d "
+                 "macAddress=" FM_FORMAT_ADDR " "
+                 "vlanID=%d "
+                 "port=%d\n",
+                 sw,
+                 entry->macAddress,
+                 entry->vlanID,
+                 entry->port);
+
+    /* Validate the address and its destination. */
+    err = ValidateAddressEntry(sw, entry);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+
+    /* Select trigger identifier to use. */
+    err = fm10000AssignMacTrigger(sw, entry, &trigger);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+
+    /* Add address to MAC table. */
+    err = fmAddAddressToTableInternal(sw, entry, trigger, TRUE, -1);
+
+ABORT:
+    FM_LOG_EXIT(FM_LOG_CAT_ADDR, err);
+
+}   /* end fm10000AddAddress */
+
+
+
+
+/*****************************************************************************/
+/** fm10000AddAddressList
+ * \ingroup intAddr
+ *
+ * \desc            Adds a list of entries to the MA Table. See
+ *                  ''fmAddAddressList'' for details. Called through the
+ *                  AddAddressList function pointer.
+ *                                                                      \lb\lb
+ *                  The whole list is validated before the table is
+ *                  touched. The entries are then placed in the cache under
+ *                  a single hold of the L2 lock, the modified hardware
+ *                  entries are written in index order, and the resulting
+ *                  table update events are sent together.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numEntries is the number of entries in the list.
+ *
+ * \param[in,out]   entries points to an array of ''fm_macAddressEntry''
+ *                  structures describing the MA Table entries to be added.
+ *                  The vlanID of each entry is replaced by its learning
+ *                  FID.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an entry is not valid. No
+ *                  entry is added in that case.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ * \return          FM_ERR_ADDR_BANK_FULL if there is no room in the MA
+ *                  table for one of the addresses. The other entries are
+ *                  still added.
+ *
+ *****************************************************************************/
+fm_status fm10000AddAddressList(fm_int               sw,
+                                fm_int               numEntries,
+                                fm_macAddressEntry * entries)
+{
+    fm_macAddressEntry *    entry;
+    fm_uint32               numUpdates;
+    fm_event *              event;
+    fm_int                  i;
+    fm_status               err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ADDR,
+                 "sw=%d numEntries=%d entries=%p\n",
+                 sw,
+                 numEntries,
+                 (void *) entries);
+
+    numUpdates = 0;
+    event      = NULL;
+
+    /**************************************************
+     * Validate the whole list before touching the
+     * table.
+     **************************************************/
+
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        entry = &entries[i];
+
+        err = ValidateAddressEntry(sw, entry);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+
+        err = fm10000GetLearningFID(sw, entry->vlanID, &entry->vlanID);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+    }
+
+    err = fm10000AddMacTableEntryList(sw,
+                                      entries,
+                                      numEntries,
+                                      FM_MAC_SOURCE_API_ADDED,
+                                      &numUpdates,
+                                      &event);
+
+    if (numUpdates != 0)
+    {
+        fmSendMacUpdateEvent(sw,
+                             &fmRootApi->eventThread,
+                             &numUpdates,
+                             &event,
+                             FALSE);
+    }
+
+    if (event != NULL)
+    {
+        fmReleaseEvent(event);
+    }
+
+ABORT:
+    FM_LOG_EXIT(FM_LOG_CAT_ADDR, err);
+
+}   /* end fm10000AddAddressList */
+
+
+
+
+/*****************************************************************************/
+/** fm10000AddMacTableEntry
+ * \ingroup intAddr
+ *
+ * \desc            Adds an entry to the MAC Address table.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       entry points to the entry structure to add.
+ * 
+ * \param[in]       source is the source of the MA table entry.
+ *
+ * \param[in]       trigger is the trigger identifier to be stored in the
+ *                  MA Table entry.
+ *
+ * \param[in,out]   numUpdates points to a variable containing the number of
+ *                  updates stored in the event buffer. Will be updated if
+ *                  an event is added to the buffer.
+ *
+ * \param[in,out]   outEvent points to a variable containing a pointer to
+ *                  the buffer to which the learning and aging events
+ *                  should be added. May be NULL, in which case an event
+ *                  buffer will be allocated if one is needed. Will be
+ *                  updated to point to the new event buffer.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_ADDR_BANK_FULL if there is no room in the MA table
+ *                  for the specified address.
+ * \return          FM_ERR_TUNNEL_INVALID_ENTRY if the entry specified when
+ *                  using isTunnelEntry is not valid.
+ * \return          FM_ERR_UNSUPPORTED if the retrieved tunnel entry GloRT
+ *                  makes use of user field.
+ *
+ *****************************************************************************/
+fm_status fm10000AddMacTableEntry(fm_int               sw,
+                                  fm_macAddressEntry * entry,
+                                  fm_macSource         source,
+                                  fm_uint32            trigger,
+                                  fm_uint32 *          numUpdates,
+                                  fm_event **          outEvent)
+{
+    fm_internalMacAddrEntry oldEntry;
+    fm_internalMacAddrEntry newEntry;
+
+    fm_switch *     switchPtr;
+    fm_uint16       indexes[FM10000_MAC_ADDR_BANK_COUNT];
+    fm_int          bestIndex;
+    fm_uint32       dupMask;
+    fm_bool         ageOld;
+    fm_bool         l2Locked = FALSE;
+    fm_bool         isTcnEvent;
+    fm_int          hashIndex;
+    fm_int          i;
+    fm_status       err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ADDR,
+                 "sw=%d macAddress=%012llx vlanID=%u type=%s "
+                 "source=%s trigger=%d "
+                 "numUpdates=%u outEvent=%p\n",
+                 sw,
+                 entry->macAddress,
+                 entry->vlanID,
+                 fmAddressTypeToText(entry->type),
+                 fmMacSourceToText(source),
+                 (fm_int) trigger,
+                 *numUpdates,
+                 (void *) *outEvent);
+ 
+    switchPtr = GET_SWITCH_PTR(sw);
+    
+    /**************************************************
+     * Assign trigger if we don't have one.
+     **************************************************/
+
+    if (trigger == FM_DEFAULT_TRIGGER)
+    {
+        err = fm10000AssignMacTrigger(sw, entry, &trigger);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+    }
+    
+    /**************************************************
+     * Find out whether this is a TCN FIFO event.
+     **************************************************/
+
+    isTcnEvent = FM_IS_MAC_SOURCE_TCN_FIFO(source);
     
     /**************************************************
      * Get possible hash table indexes for entry.
@@ -818,59 +1479,9 @@ fm_status fm10000AddMacTableEntry(fm_int               sw,
      * Initialize the new MA table entry.
      **************************************************/
 
-    FM_CLEAR(newEntry);
-
-    newEntry.destMask   = FM_DESTMASK_UNUSED;
-    newEntry.port       = entry->port;
-    newEntry.vlanID     = entry->vlanID;
-    newEntry.macAddress = entry->macAddress;
-    newEntry.addrType   = entry->type;
-    newEntry.secure     = isSecure;
-
-    if (entry->isTunnelEntry)
-    {
-        newEntry.isTunnelEntry = TRUE;
-        err = fm10000GetTunnelAttribute(sw,
-                                        entry->tunnelGrp,
-                                        entry->tunnelRule,
-                                        FM_TUNNEL_GLORT_USER,
-                                        &glortUser);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
-
-        /* Only accept glortUser that doesn't make use of the user
-         * field. */
-        if ( (glortUser.userMask != 0) ||
-             (glortUser.glortMask != 0xFFFF) )
-        {
-            err = FM_ERR_UNSUPPORTED;
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
-        }
-        newEntry.glort = (fm_uint32) glortUser.glort;
-        newEntry.tunnelGrp = entry->tunnelGrp;
-        newEntry.tunnelRule = entry->tunnelRule;
-    }
-    else
-    {
-        newEntry.isTunnelEntry = FALSE;
-        err = fmGetLogicalPortGlort(sw, entry->port, &newEntry.glort);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
-    }
-
-    if (FM_IS_ADDR_TYPE_STATIC(entry->type))
-    {
-        newEntry.state = FM_MAC_ENTRY_STATE_LOCKED;
-    }
-    else
-    {
-        newEntry.state = FM_MAC_ENTRY_STATE_YOUNG;
-        newEntry.agingCounter = fm10000GetAgingTimer();
-    }
+    err = InitCacheEntry(sw, entry, trigger, &newEntry);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
 
-    if (trigger != FM_DEFAULT_TRIGGER)
-    {
-        newEntry.trigger = trigger;
-    }
-    
     /************************************************** 
      * Ignore the transaction if the new entry comes
      * from the TCN FIO and it matches the entry in the 
@@ -901,7 +1512,9 @@ fm_status fm10000AddMacTableEntry(fm_int               sw,
      * Write new entry to cache.
      **************************************************/
 
+    fmAddrIndexUnlink(switchPtr, hashIndex);
     switchPtr->maTable[hashIndex] = newEntry;
+    fmAddrIndexLink(switchPtr, hashIndex);
     
     /**************************************************
      * Write new entry to hardware.
@@ -936,126 +1549,262 @@ fm_status fm10000AddMacTableEntry(fm_int               sw,
      * Drop lock before generating events.
      **************************************************/
 
-    FM_DROP_L2_LOCK(sw);
-    l2Locked = FALSE;
-    
+    FM_DROP_L2_LOCK(sw);
+    l2Locked = FALSE;
+    
+    /**************************************************
+     * Report the table update.
+     **************************************************/
+
+    ReportAddedEntry(sw,
+                     source,
+                     ageOld,
+                     hashIndex,
+                     &oldEntry,
+                     &newEntry,
+                     numUpdates,
+                     outEvent);
+
+ABORT:
+    if (l2Locked)
+    {
+        FM_DROP_L2_LOCK(sw);
+    }
+    
+    FM_LOG_EXIT(FM_LOG_CAT_ADDR, err);
+
+}   /* end fm10000AddMacTableEntry */
+
+
+
+
+/*****************************************************************************/
+/** fm10000AddMacTableEntryList
+ * \ingroup intAddr
+ *
+ * \desc            Adds a list of entries to the MAC Address table. Each
+ *                  entry is handled as by ''fm10000AddMacTableEntry'', but
+ *                  the entries are placed in the cache under a single hold
+ *                  of the L2 lock, and the modified hardware entries are
+ *                  written in index order once all the entries have been
+ *                  placed.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       entries points to the array of entries to add. The
+ *                  vlanID of each entry must be its learning FID.
+ *
+ * \param[in]       numEntries is the number of entries in the list.
+ *
+ * \param[in]       source is the source of the MA table entries.
+ *
+ * \param[in,out]   numUpdates points to a variable containing the number of
+ *                  updates stored in the event buffer. Will be updated if
+ *                  an event is added to the buffer.
+ *
+ * \param[in,out]   outEvent points to a variable containing a pointer to
+ *                  the buffer to which the learning and aging events
+ *                  should be added. May be NULL, in which case an event
+ *                  buffer will be allocated if one is needed. Will be
+ *                  updated to point to the new event buffer.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ * \return          FM_ERR_ADDR_BANK_FULL if there is no room in the MA
+ *                  table for one of the addresses. The other entries are
+ *                  still added.
+ *
+ *****************************************************************************/
+fm_status fm10000AddMacTableEntryList(fm_int               sw,
+                                      fm_macAddressEntry * entries,
+                                      fm_int               numEntries,
+                                      fm_macSource         source,
+                                      fm_uint32 *          numUpdates,
+                                      fm_event **          outEvent)
+{
+    fm_switch *             switchPtr;
+    fm10000_addrListItem *  items;
+    fm10000_addrListItem *  item;
+    fm_macAddressEntry *    entry;
+    fm_internalMacAddrEntry *cachePtr;
+    fm_uint32 *             tableIndexes;
+    fm_int                  numIndexes;
+    fm_int                  bestIndex;
+    fm_uint32               dupMask;
+    fm_bool                 isTcnEvent;
+    fm_bool                 l2Locked;
+    fm_int                  i;
+    fm_int                  bankId;
+    fm_status               err;
+    fm_status               status;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ADDR,
+                 "sw=%d entries=%p numEntries=%d source=%s\n",
+                 sw,
+                 (void *) entries,
+                 numEntries,
+                 fmMacSourceToText(source));
+
+    switchPtr    = GET_SWITCH_PTR(sw);
+    isTcnEvent   = FM_IS_MAC_SOURCE_TCN_FIFO(source);
+    numIndexes   = 0;
+    l2Locked     = FALSE;
+    err          = FM_OK;
+
+    items = fmAllocTagged(numEntries * sizeof(fm10000_addrListItem),
+                          FM_LOG_CAT_ADDR);
+    tableIndexes =
+        fmAllocTagged(numEntries * (FM10000_MAC_ADDR_BANK_COUNT + 1) * sizeof(fm_uint32),
+                      FM_LOG_CAT_ADDR);
+
+    if (items == NULL || tableIndexes == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+    }
+
+    /**************************************************
+     * Compute the hash table indexes of every entry.
+     **************************************************/
+
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        entry = &entries[i];
+        item  = &items[i];
+
+        item->hashIndex = -1;
+
+        err = fm10000AssignMacTrigger(sw, entry, &item->trigger);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+
+        err = fm10000ComputeAddressIndex(sw,
+                                         entry->macAddress,
+                                         entry->vlanID,
+                                         0,
+                                         item->indexes);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+    }
+
     /**************************************************
-     * Whether this is an address change event.
+     * Place every entry in the cache.
      **************************************************/
 
-    isAddrChange =
-        oldEntry.state != FM_MAC_ENTRY_STATE_INVALID &&
-        oldEntry.macAddress == newEntry.macAddress &&
-        oldEntry.vlanID == newEntry.vlanID;
-    
-    /**************************************************
-     * Report an AGED event for the overwritten entry.
-     **************************************************/
+    FM_TAKE_L2_LOCK(sw);
+    l2Locked = TRUE;
 
-    if (ageOld)
+    for (i = 0 ; i < numEntries ; i++)
     {
-        /* Determine reason for LEARN and AGE events. */
-        if (isAddrChange) 
+        entry = &entries[i];
+        item  = &items[i];
+
+        /* Verify that the port is a member of the vlan. (Bug 28151) */
+        if (isTcnEvent &&
+            fm10000CheckVlanMembership(sw, entry->vlanID, entry->port) != FM_OK)
         {
-            reason =
-                (isTcnEvent) ?
-                FM_MAC_REASON_LEARN_CHANGED :
-                FM_MAC_REASON_API_LEARN_CHANGED;
+            fmDbgDiagCountIncr(sw, FM_CTR_MAC_VLAN_ERR, 1);
+            continue;
         }
-        else 
+
+        status = FindBestIndex(sw,
+                               entry,
+                               item->indexes,
+                               &bestIndex,
+                               &dupMask,
+                               &item->ageOld);
+
+        if (status == FM_ERR_STATIC_ADDR_EXISTS)
         {
-            reason =
-                (isTcnEvent) ?
-                FM_MAC_REASON_LEARN_REPLACED :
-                FM_MAC_REASON_API_LEARN_REPLACED;
+            /* A dynamic entry does not replace a static one. */
+            continue;
         }
 
-        /**************************************************
-         * Report an AGED event for the old entry if: 
-         * 1) This is a TCN FIFO event, or
-         * 2) We are removing a static address and
-         *    generateEventOnStaticAddr is in effect, or
-         * 3) We are removing a dynamic address and
-         *    generateEventOnDynamicAddr is in effect, or
-         * 4) We are changing an existing address and
-         *    generateEventOnAddrChange is in effect.
-         **************************************************/
+        if (status == FM_OK)
+        {
+            status = InitCacheEntry(sw, entry, item->trigger, &item->newEntry);
+        }
 
-        if ( isTcnEvent ||
-             (oldEntry.state == FM_MAC_ENTRY_STATE_LOCKED &&
-              switchPtr->generateEventOnStaticAddr) ||
-             (oldEntry.state != FM_MAC_ENTRY_STATE_LOCKED &&
-              switchPtr->generateEventOnDynamicAddr) ||
-             (isAddrChange && switchPtr->generateEventOnAddrChange) )
+        if (status != FM_OK)
         {
-            fmGenerateUpdateForEvent(sw,
-                                     &fmRootApi->eventThread,
-                                     FM_EVENT_ENTRY_AGED,
-                                     reason,
-                                     hashIndex,
-                                     &oldEntry,
-                                     numUpdates,
-                                     outEvent);
+            FM_LOG_DEBUG(FM_LOG_CAT_ADDR,
+                         "Could not add " FM_FORMAT_ADDR "/%u: %s\n",
+                         entry->macAddress,
+                         entry->vlanID,
+                         fmErrorMsg(status));
+            FM_ERR_COMBINE(err, status);
+            continue;
+        }
 
-            if (isTcnEvent)
-            {
-                fmDbgDiagCountIncr(sw, FM_CTR_MAC_LEARN_AGED, 1);
-            }
-            else
+        cachePtr = &switchPtr->maTable[item->indexes[bestIndex]];
+
+        /* Ignore a TCN FIFO entry that matches the cache. (Bug 28232) */
+        if (isTcnEvent &&
+            cachePtr->state != FM_MAC_ENTRY_STATE_INVALID &&
+            cachePtr->macAddress == item->newEntry.macAddress &&
+            cachePtr->vlanID     == item->newEntry.vlanID &&
+            cachePtr->isTunnelEntry == FM_DISABLED &&
+            item->newEntry.isTunnelEntry == FM_DISABLED &&
+            cachePtr->port       == item->newEntry.port &&
+            cachePtr->addrType   == item->newEntry.addrType &&
+            cachePtr->trigger    == item->newEntry.trigger)
+        {
+            continue;
+        }
+
+        item->hashIndex = item->indexes[bestIndex];
+        item->oldEntry  = *cachePtr;
+
+        fmAddrIndexUnlink(switchPtr, item->hashIndex);
+        *cachePtr = item->newEntry;
+        fmAddrIndexLink(switchPtr, item->hashIndex);
+
+        tableIndexes[numIndexes++] = item->hashIndex;
+
+        /* Invalidate all other entries for this MAC/VLAN. */
+        for (bankId = 0 ; bankId < FM10000_MAC_ADDR_BANK_COUNT ; bankId++)
+        {
+            if (dupMask & (1 << bankId))
             {
-                fmDbgDiagCountIncr(sw, FM_CTR_MAC_API_AGED, 1);
+                fmDbgDiagCountIncr(sw, FM_CTR_MAC_CACHE_DUP, 1);
+
+                fmAddrIndexUnlink(switchPtr, item->indexes[bankId]);
+                FM_CLEAR(switchPtr->maTable[item->indexes[bankId]]);
+
+                tableIndexes[numIndexes++] = item->indexes[bankId];
             }
         }
     }
-    else
-    {
-        /* Determine reason for LEARN event. */
-        reason =
-            (isTcnEvent) ?
-            FM_MAC_REASON_LEARN_EVENT :
-            FM_MAC_REASON_API_LEARNED;
-    }
-    
+
     /**************************************************
-     * Report a LEARNED event for the new entry if:
-     * 1) This is a TCN FIFO event, or
-     * 2) We are adding a static address and
-     *    generateEventOnStaticAddr is in effect, or
-     * 3) We are adding a dynamic address and
-     *    generateEventOnDynamicAddr is in effect, or
-     * 4) We are changing an existing address and
-     *    generateEventOnAddrChange is in effect.
+     * Write the modified entries to hardware.
      **************************************************/
 
-    if ( isTcnEvent ||
-         (newEntry.state == FM_MAC_ENTRY_STATE_LOCKED &&
-          switchPtr->generateEventOnStaticAddr) ||
-         (newEntry.state != FM_MAC_ENTRY_STATE_LOCKED &&
-          switchPtr->generateEventOnDynamicAddr) ||
-         (isAddrChange && switchPtr->generateEventOnAddrChange) )
+    status = WriteTableIndexes(sw, tableIndexes, numIndexes);
+    FM_ERR_COMBINE(err, status);
+
+    FM_DROP_L2_LOCK(sw);
+    l2Locked = FALSE;
+
+    /**************************************************
+     * Report the table updates.
+     **************************************************/
+
+    for (i = 0 ; i < numEntries ; i++)
     {
-        fmGenerateUpdateForEvent(sw,
-                                 &fmRootApi->eventThread,
-                                 FM_EVENT_ENTRY_LEARNED,
-                                 reason,
-                                 hashIndex,
-                                 &newEntry,
-                                 numUpdates,
-                                 outEvent);
+        item = &items[i];
 
-        if (isTcnEvent)
-        {
-            fmDbgDiagCountIncr(sw, FM_CTR_MAC_LEARN_LEARNED, 1);
-        }
-        else
+        if (item->hashIndex < 0)
         {
-            fmDbgDiagCountIncr(sw, FM_CTR_MAC_API_LEARNED, 1);
+            continue;
         }
 
-        if (source == FM_MAC_SOURCE_TCN_MOVED)
-        {
-            fmDbgDiagCountIncr(sw, FM_CTR_MAC_LEARN_PORT_CHANGED, 1);
-        }
+        ReportAddedEntry(sw,
+                         source,
+                         item->ageOld,
+                         item->hashIndex,
+                         &item->oldEntry,
+                         &item->newEntry,
+                         numUpdates,
+                         outEvent);
     }
 
 ABORT:
@@ -1063,10 +1812,20 @@ ABORT:
     {
         FM_DROP_L2_LOCK(sw);
     }
-    
+
+    if (items != NULL)
+    {
+        fmFree(items);
+    }
+
+    if (tableIndexes != NULL)
+    {
+        fmFree(tableIndexes);
+    }
+
     FM_LOG_EXIT(FM_LOG_CAT_ADDR, err);
 
-}   /* end fm10000AddMacTableEntry */
+}   /* end fm10000AddMacTableEntryList */
 
 
 
@@ -1445,80 +2204,299 @@ fm_status fm10000ConvertEntryToWords(fm_int                   sw,
 
         FM_ARRAY_SET_BIT(words, FM10000_MA_TABLE, valid, 1);
 
-        if (entry->secure)
+        if (entry->secure)
+        {
+            FM_ARRAY_SET_BIT(words, FM10000_MA_TABLE, secure, 1);
+        }
+
+        FM_ARRAY_SET_FIELD(words, FM10000_MA_TABLE, glort, entry->glort);
+
+        if (entry->trigger != FM_DEFAULT_TRIGGER)
+        {
+            FM_ARRAY_SET_FIELD(words, FM10000_MA_TABLE, trigId, entry->trigger);
+        }
+    }
+
+ABORT:
+    FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ADDR, status);
+
+}   /* end fm10000ConvertEntryToWords */
+
+
+
+
+#if 0
+
+/*****************************************************************************/
+/* fm10000ConvertWordsToEntry
+ * \ingroup intAddr
+ *
+ * \desc            Converts an array of four words to an MA Table entry
+ *                  structure.
+ *
+ * \note            The destination mask holds logical ports.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[out]      entry points to the MA Table entry structure to be filled
+ *                  in by this function.
+ *
+ * \param[in]       words points to the buffer where the 4 words
+ *                  are located.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000ConvertWordsToEntry(fm_int                   sw,
+                                     fm_internalMacAddrEntry *entry,
+                                     fm_uint32 *              words)
+{
+
+    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_ADDR,
+                         "sw=%d entry=%p words=%p<%08x%08x%08x%08x>\n",
+                         sw,
+                         (void *) entry,
+                         (void *) words,
+                         (words ? words[3] : 0),
+                         (words ? words[2] : 0),
+                         (words ? words[1] : 0),
+                         (words ? words[0] : 0));
+
+    FM_NOT_USED(sw);
+    FM_NOT_USED(entry);
+    FM_NOT_USED(words);
+
+    /*************************************************** 
+     * This function is not supported on the FM10000 
+     * because the hardware registers do not contain
+     * all the information necessary to recover the
+     * MAC Table entry.
+     **************************************************/
+
+    FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ADDR, FM_ERR_UNSUPPORTED);
+
+}   /* end fm10000ConvertWordsToEntry */
+
+#endif  /* 0 */
+
+
+
+
+/*****************************************************************************/
+/** fm10000DeleteAddressList
+ * \ingroup intAddr
+ *
+ * \desc            Deletes a list of entries from the MA Table. See
+ *                  ''fmDeleteAddressList'' for details. Called through the
+ *                  DeleteAddressList function pointer.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numEntries is the number of entries in the list.
+ *
+ * \param[in]       entries points to an array of ''fm_macAddressEntry''
+ *                  structures containing the address and vlan combinations
+ *                  to be deleted (other members are ignored, except port
+ *                  which is checked against multicast groups).
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_USE_MCAST_FUNCTIONS if an entry refers to a
+ *                  multicast group. No entry is deleted in that case.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ * \return          FM_ERR_ADDR_NOT_FOUND if one of the addresses was not
+ *                  found in the MA Table. The other entries are still
+ *                  deleted.
+ *
+ *****************************************************************************/
+fm_status fm10000DeleteAddressList(fm_int               sw,
+                                   fm_int               numEntries,
+                                   fm_macAddressEntry * entries)
+{
+    fm_switch *                 switchPtr;
+    fm10000_addrListItem *      items;
+    fm10000_addrListItem *      item;
+    fm_macAddressEntry *        entry;
+    fm_internalMacAddrEntry *   cachePtr;
+    fm_uint32 *                 tableIndexes;
+    fm_int                      numIndexes;
+    fm_uint16                   vlanID;
+    fm_uint32                   numUpdates;
+    fm_event *                  event;
+    fm_bool                     l2Locked;
+    fm_int                      i;
+    fm_int                      bankId;
+    fm_status                   err;
+    fm_status                   status;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ADDR,
+                 "sw=%d numEntries=%d entries=%p\n",
+                 sw,
+                 numEntries,
+                 (void *) entries);
+
+    switchPtr    = GET_SWITCH_PTR(sw);
+    numIndexes   = 0;
+    numUpdates   = 0;
+    event        = NULL;
+    l2Locked     = FALSE;
+    err          = FM_OK;
+
+    items        = fmAllocTagged(numEntries * sizeof(fm10000_addrListItem),
+                                 FM_LOG_CAT_ADDR);
+    tableIndexes = fmAllocTagged(numEntries * sizeof(fm_uint32),
+                                 FM_LOG_CAT_ADDR);
+
+    if (items == NULL || tableIndexes == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+    }
+
+    /**************************************************
+     * Validate the whole list and compute the hash
+     * table indexes of every entry.
+     **************************************************/
+
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        entry = &entries[i];
+        item  = &items[i];
+
+        err = fm10000DeleteAddressPre(sw, entry);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+
+        err = fm10000GetLearningFID(sw, entry->vlanID, &vlanID);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+
+        err = fm10000ComputeAddressIndex(sw,
+                                         entry->macAddress,
+                                         vlanID,
+                                         entry->vlanID2,
+                                         item->indexes);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+
+        item->fid       = vlanID;
+        item->hashIndex = -1;
+    }
+
+    /**************************************************
+     * Invalidate every entry in the cache.
+     **************************************************/
+
+    FM_TAKE_L2_LOCK(sw);
+    l2Locked = TRUE;
+
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        entry = &entries[i];
+        item  = &items[i];
+
+        for (bankId = FM10000_MAC_ADDR_BANK_COUNT - 1 ; bankId >= 0 ; bankId--)
+        {
+            cachePtr = &switchPtr->maTable[item->indexes[bankId]];
+
+            if ( (cachePtr->state != FM_MAC_ENTRY_STATE_INVALID) &&
+                 (cachePtr->macAddress == entry->macAddress) &&
+                 (cachePtr->vlanID == item->fid) &&
+                 (cachePtr->vlanID2 == entry->vlanID2) )
+            {
+                break;
+            }
+        }
+
+        if (bankId < 0)
         {
-            FM_ARRAY_SET_BIT(words, FM10000_MA_TABLE, secure, 1);
+            FM_LOG_DEBUG(FM_LOG_CAT_ADDR,
+                         "could not find address " FM_FORMAT_ADDR "/%u\n",
+                         entry->macAddress,
+                         item->fid);
+            FM_ERR_COMBINE(err, FM_ERR_ADDR_NOT_FOUND);
+            continue;
         }
 
-        FM_ARRAY_SET_FIELD(words, FM10000_MA_TABLE, glort, entry->glort);
+        item->hashIndex = item->indexes[bankId];
+        item->oldEntry  = *cachePtr;
 
-        if (entry->trigger != FM_DEFAULT_TRIGGER)
-        {
-            FM_ARRAY_SET_FIELD(words, FM10000_MA_TABLE, trigId, entry->trigger);
-        }
+        fmAddrIndexUnlink(switchPtr, item->hashIndex);
+        cachePtr->state = FM_MAC_ENTRY_STATE_INVALID;
+
+        tableIndexes[numIndexes++] = item->hashIndex;
     }
 
-ABORT:
-    FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ADDR, status);
+    /**************************************************
+     * Write the invalidated entries to hardware.
+     **************************************************/
 
-}   /* end fm10000ConvertEntryToWords */
+    status = WriteTableIndexes(sw, tableIndexes, numIndexes);
+    FM_ERR_COMBINE(err, status);
 
+    FM_DROP_L2_LOCK(sw);
+    l2Locked = FALSE;
 
+    /**************************************************
+     * Report the table updates.
+     **************************************************/
 
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        item = &items[i];
 
-#if 0
+        if (item->hashIndex < 0)
+        {
+            continue;
+        }
 
-/*****************************************************************************/
-/* fm10000ConvertWordsToEntry
- * \ingroup intAddr
- *
- * \desc            Converts an array of four words to an MA Table entry
- *                  structure.
- *
- * \note            The destination mask holds logical ports.
- *
- * \param[in]       sw is the switch number.
- *
- * \param[out]      entry points to the MA Table entry structure to be filled
- *                  in by this function.
- *
- * \param[in]       words points to the buffer where the 4 words
- *                  are located.
- *
- * \return          FM_OK if successful.
- *
- *****************************************************************************/
-fm_status fm10000ConvertWordsToEntry(fm_int                   sw,
-                                     fm_internalMacAddrEntry *entry,
-                                     fm_uint32 *              words)
-{
+        if ( (item->oldEntry.state == FM_MAC_ENTRY_STATE_LOCKED &&
+              switchPtr->generateEventOnStaticAddr) ||
+             (item->oldEntry.state != FM_MAC_ENTRY_STATE_LOCKED &&
+              switchPtr->generateEventOnDynamicAddr) )
+        {
+            fmGenerateUpdateForEvent(sw,
+                                     &fmRootApi->eventThread,
+                                     FM_EVENT_ENTRY_AGED,
+                                     FM_MAC_REASON_API_AGED,
+                                     item->hashIndex,
+                                     &item->oldEntry,
+                                     &numUpdates,
+                                     &event);
 
-    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_ADDR,
-                         "sw=%d entry=%p words=%p<%08x%08x%08x%08x>\n",
-                         sw,
-                         (void *) entry,
-                         (void *) words,
-                         (words ? words[3] : 0),
-                         (words ? words[2] : 0),
-                         (words ? words[1] : 0),
-                         (words ? words[0] : 0));
+            fmDbgDiagCountIncr(sw, FM_CTR_MAC_API_AGED, 1);
+        }
+    }
 
-    FM_NOT_USED(sw);
-    FM_NOT_USED(entry);
-    FM_NOT_USED(words);
+    if (numUpdates != 0)
+    {
+        fmSendMacUpdateEvent(sw,
+                             &fmRootApi->eventThread,
+                             &numUpdates,
+                             &event,
+                             FALSE);
+    }
 
-    /*************************************************** 
-     * This function is not supported on the FM10000 
-     * because the hardware registers do not contain
-     * all the information necessary to recover the
-     * MAC Table entry.
-     **************************************************/
+ABORT:
+    if (l2Locked)
+    {
+        FM_DROP_L2_LOCK(sw);
+    }
 
-    FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ADDR, FM_ERR_UNSUPPORTED);
+    if (event != NULL)
+    {
+        fmReleaseEvent(event);
+    }
 
-}   /* end fm10000ConvertWordsToEntry */
+    if (items != NULL)
+    {
+        fmFree(items);
+    }
 
-#endif  /* 0 */
+    if (tableIndexes != NULL)
+    {
+        fmFree(tableIndexes);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_ADDR, err);
+
+}   /* end fm10000DeleteAddressList */
 
 
 
@@ -1772,6 +2750,301 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000GetAddressTablePage
+ * \ingroup intAddr
+ *
+ * \desc            Retrieves the next page of a cursor walk of the MA
+ *                  Table. Called through the GetAddressTablePage function
+ *                  pointer.
+ *                                                                      \lb\lb
+ *                  The cache is examined in chunks of PAGE_CHUNK_SIZE
+ *                  entries, each under its own hold of the L2 lock, and
+ *                  the matching entries are converted once the lock has
+ *                  been released.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   cursor points to the cursor of the walk.
+ *
+ * \param[out]      nEntries points to caller-allocated storage where this
+ *                  function is to store the number of entries retrieved.
+ *
+ * \param[out]      entries points to an array of maxEntries entries that
+ *                  will be filled in by this function.
+ *
+ * \param[in]       maxEntries is the size of entries.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MORE if the end of the MA Table was reached
+ *                  and no entries were retrieved.
+ *
+ *****************************************************************************/
+fm_status fm10000GetAddressTablePage(fm_int              sw,
+                                     fm_macTableCursor * cursor,
+                                     fm_int *            nEntries,
+                                     fm_macAddressEntry *entries,
+                                     fm_int              maxEntries)
+{
+    fm_switch *              switchPtr;
+    fm_internalMacAddrEntry  chunk[PAGE_CHUNK_SIZE];
+    fm_internalMacAddrEntry *cachePtr;
+    fm_status                result = FM_OK;
+    fm_status                status;
+    fm_int                   numFound;
+    fm_int                   numScanned;
+    fm_int                   i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ADDR,
+                 "sw=%d index=%d since=%llu maxEntries=%d\n",
+                 sw,
+                 cursor->index,
+                 cursor->sinceGeneration,
+                 maxEntries);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    *nEntries = 0;
+
+    while ( *nEntries < maxEntries &&
+            cursor->index < switchPtr->macTableSize )
+    {
+        /***************************************************
+         * Copy the matching entries of the next chunk, never
+         * more than the page has room for.
+         **************************************************/
+
+        numFound   = 0;
+        numScanned = 0;
+
+        FM_TAKE_L2_LOCK(sw);
+
+        while ( numScanned < PAGE_CHUNK_SIZE &&
+                numFound < (maxEntries - *nEntries) &&
+                cursor->index < switchPtr->macTableSize )
+        {
+            cachePtr = &switchPtr->maTable[cursor->index];
+
+            if ( cachePtr->state != FM_MAC_ENTRY_STATE_INVALID &&
+                 ( cursor->sinceGeneration == 0 ||
+                   fmAddrIndexChangedSince(switchPtr,
+                                           cursor->index,
+                                           cursor->sinceGeneration) ) )
+            {
+                chunk[numFound++] = *cachePtr;
+            }
+
+            cursor->index++;
+            numScanned++;
+        }
+
+        FM_DROP_L2_LOCK(sw);
+
+        /***************************************************
+         * Convert them to the user representation. An entry
+         * that cannot be converted is skipped, and the first
+         * error is reported.
+         **************************************************/
+
+        for (i = 0 ; i < numFound ; i++)
+        {
+            status = fm10000FillInUserEntryFromTable(sw,
+                                                     &chunk[i],
+                                                     &entries[*nEntries]);
+            if (status != FM_OK)
+            {
+                FM_ERR_COMBINE(result, status);
+                continue;
+            }
+
+            (*nEntries)++;
+        }
+    }
+
+    if (*nEntries == 0 && result == FM_OK)
+    {
+        result = FM_ERR_NO_MORE;
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_ADDR, result);
+
+}   /* end fm10000GetAddressTablePage */
+
+
+
+
+/*****************************************************************************/
+/** fm10000GetAddressTableSnapshot
+ * \ingroup intAddr
+ *
+ * \desc            Retrieves the next page of a cursor walk of the MA
+ *                  Table without taking the L2 lock. Called through the
+ *                  GetAddressTableSnapshot function pointer.
+ *                                                                      \lb\lb
+ *                  Each entry is copied with ''fmAddrIndexReadEntry''; an
+ *                  entry that is being rewritten while it is read is
+ *                  skipped.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   cursor points to the cursor of the walk.
+ *
+ * \param[out]      nEntries points to caller-allocated storage where this
+ *                  function is to store the number of entries retrieved.
+ *
+ * \param[out]      entries points to an array of maxEntries entries that
+ *                  will be filled in by this function.
+ *
+ * \param[in]       maxEntries is the size of entries.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MORE if the end of the MA Table was reached
+ *                  and no entries were retrieved.
+ * \return          FM_ERR_UNSUPPORTED if the MA Table has no index, which
+ *                  the lock-free read relies on.
+ *
+ *****************************************************************************/
+fm_status fm10000GetAddressTableSnapshot(fm_int              sw,
+                                         fm_macTableCursor * cursor,
+                                         fm_int *            nEntries,
+                                         fm_macAddressEntry *entries,
+                                         fm_int              maxEntries)
+{
+    fm_switch *             switchPtr;
+    fm_internalMacAddrEntry copy;
+    fm_status               err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ADDR,
+                 "sw=%d index=%d since=%llu maxEntries=%d\n",
+                 sw,
+                 cursor->index,
+                 cursor->sinceGeneration,
+                 maxEntries);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    *nEntries = 0;
+
+    if (switchPtr->maIndex == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ADDR, FM_ERR_UNSUPPORTED);
+    }
+
+    while ( *nEntries < maxEntries &&
+            cursor->index < switchPtr->macTableSize )
+    {
+        if ( fmAddrIndexReadEntry(switchPtr, cursor->index, &copy) &&
+             ( cursor->sinceGeneration == 0 ||
+               fmAddrIndexChangedSince(switchPtr,
+                                       cursor->index,
+                                       cursor->sinceGeneration) ) )
+        {
+            err = fm10000FillInUserEntryFromTable(sw,
+                                                  &copy,
+                                                  &entries[*nEntries]);
+            if (err == FM_OK)
+            {
+                (*nEntries)++;
+            }
+        }
+
+        cursor->index++;
+    }
+
+    err = (*nEntries == 0) ? FM_ERR_NO_MORE : FM_OK;
+
+    FM_LOG_EXIT(FM_LOG_CAT_ADDR, err);
+
+}   /* end fm10000GetAddressTableSnapshot */
+
+
+
+
+/*****************************************************************************/
+/** fm10000GetAddressTableStats
+ * \ingroup intAddr
+ *
+ * \desc            Retrieves the MA Table occupancy and collision
+ *                  statistics. Called through the GetAddressTableStats
+ *                  function pointer.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      stats points to caller-allocated storage where this
+ *                  function is to store the statistics.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000GetAddressTableStats(fm_int sw, fm_macTableStats *stats)
+{
+    fm_switch *     switchPtr;
+    fm10000_switch *switchExt;
+    fm_int          i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ADDR, "sw=%d stats=%p\n", sw, (void *) stats);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    switchExt = GET_SWITCH_EXT(sw);
+
+    FM_TAKE_L2_LOCK(sw);
+
+    *stats           = switchExt->maTableStats;
+    stats->tableSize = switchPtr->macTableSize;
+    stats->numValid  = fmAddrIndexCountValid(switchPtr);
+
+    FM_DROP_L2_LOCK(sw);
+
+    for (i = 0 ; i < FM_MAC_TABLE_NUM_HOT_BINS ; i++)
+    {
+        if (stats->hotBins[i].numFull == 0)
+        {
+            stats->hotBins[i].hashIndex = -1;
+        }
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_ADDR, FM_OK);
+
+}   /* end fm10000GetAddressTableStats */
+
+
+
+
+/*****************************************************************************/
+/** fm10000ResetAddressTableStats
+ * \ingroup intAddr
+ *
+ * \desc            Resets the MA Table occupancy and collision statistics.
+ *                  Called through the ResetAddressTableStats function
+ *                  pointer.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000ResetAddressTableStats(fm_int sw)
+{
+    fm10000_switch *switchExt;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ADDR, "sw=%d\n", sw);
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    FM_TAKE_L2_LOCK(sw);
+
+    FM_CLEAR(switchExt->maTableStats);
+    switchExt->maOccupancyWarned = FALSE;
+
+    FM_DROP_L2_LOCK(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_ADDR, FM_OK);
+
+}   /* end fm10000ResetAddressTableStats */
+
+
+
+
 /*****************************************************************************/
 /** fm10000GetAddressTableAttribute
  * \ingroup intAddr
@@ -1928,7 +3201,8 @@ fm_status fm10000InitAddrHash(void)
     }
 
     fmRootApi->l2lHashTable =
-        (fm_int *) fmAlloc(sizeof(fm_int) * L2L_HASH_TABLE_SIZE);
+        (fm_int *) fmAllocTagged(sizeof(fm_int) * L2L_HASH_TABLE_SIZE,
+                                 FM_LOG_CAT_ADDR);
 
     if (fmRootApi->l2lHashTable == NULL)
     {
@@ -1984,6 +3258,8 @@ fm_status fm10000InitAddressTable(fm_switch * switchPtr)
         switchPtr->maTable[i].state = FM_MAC_ENTRY_STATE_INVALID;
     }
 
+    fmResetAddrIndex(switchPtr);
+
     err = fm10000InitAddrHash();
     
     FM_LOG_EXIT(FM_LOG_CAT_ADDR | FM_LOG_CAT_SWITCH, err);
@@ -2021,6 +3297,7 @@ fm_status fm10000InvalidateEntryAtIndex(fm_int sw, fm_uint32 index)
     cachePtr = &switchPtr->maTable[index];
 
     /* Invalidate software cache entry. */
+    fmAddrIndexUnlink(switchPtr, index);
     FM_CLEAR(*cachePtr);
 
     /* Invalidate hardware entries. */
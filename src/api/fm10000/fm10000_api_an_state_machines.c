@@ -1688,6 +1688,13 @@ fm_status fm10000RegisterClause73AnStateMachine( void )
                                              dynstt,
                                              logCallback,
                                              TRUE ); 
+    if ( status != FM_OK )
+    {
+        return status;
+    }
+
+    status = fmSetStateTransitionLogCategories( FM10000_CLAUSE73_AN_STATE_MACHINE,
+                                                FM_LOG_CAT_PORT );
     return status;
 
 }   /* end fm10000RegisterClause73AnStateMachine */
@@ -1771,6 +1778,13 @@ fm_status fm10000RegisterClause37AnStateMachine( void )
                                              dynstt,
                                              logCallback,
                                              TRUE ); 
+    if ( status != FM_OK )
+    {
+        return status;
+    }
+
+    status = fmSetStateTransitionLogCategories( FM10000_CLAUSE37_AN_STATE_MACHINE,
+                                                FM_LOG_CAT_PORT );
     return status;
 
 }   /* end fm10000RegisterClause37AnStateMachine */
@@ -2855,6 +2855,26 @@ fm_status fm10000GetSwitchAttribute(fm_int sw, fm_int attr, void *value)
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ATTR, err);
             break;
 
+        case FM_SWITCH_BOOT_PHASE:
+            err = fmDbgGetBootPhase(sw, (fm_bootPhase *) value);
+            break;
+
+        case FM_SWITCH_COUNTER_CACHE_INTERVAL:
+            *( (fm_uint32 *) value) = switchExt->counterCache.interval;
+            break;
+
+        case FM_SWITCH_COUNTER_CACHE_MAX_AGE:
+            *( (fm_uint32 *) value) = switchExt->counterCache.maxAge;
+            break;
+
+        case FM_SWITCH_TELEMETRY_RING_SIZE:
+            *( (fm_uint32 *) value) = fmGetTelemetryRingSize(sw);
+            break;
+
+        case FM_SWITCH_SFLOW_SAMPLE_RING_SIZE:
+            *( (fm_uint32 *) value) = fmGetSFlowSampleRingSize(sw);
+            break;
+
         default:
             err = FM_ERR_INVALID_ATTRIB;
             break;
@@ -4053,6 +4073,26 @@ fm_status fm10000SetSwitchAttribute(fm_int sw, fm_int attr, void *value)
             }
             break;
 
+        case FM_SWITCH_COUNTER_CACHE_INTERVAL:
+            err = fm10000SetCounterCacheInterval(sw, *( (fm_uint32 *) value));
+            break;
+
+        case FM_SWITCH_COUNTER_CACHE_MAX_AGE:
+            switchExt->counterCache.maxAge = *( (fm_uint32 *) value);
+            err = FM_OK;
+            break;
+
+        case FM_SWITCH_TELEMETRY_RING_SIZE:
+            err = fmSetTelemetryRingSize(sw, *( (fm_uint32 *) value));
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ATTR, err);
+
+            fmSetTelemetryRingActive(sw, (switchExt->counterCache.interval != 0));
+            break;
+
+        case FM_SWITCH_SFLOW_SAMPLE_RING_SIZE:
+            err = fmSetSFlowSampleRingSize(sw, *( (fm_uint32 *) value));
+            break;
+
         default:
             err = FM_ERR_INVALID_ATTRIB;
             break;
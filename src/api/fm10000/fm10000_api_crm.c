@@ -126,7 +126,9 @@ static fm_status WriteCrmEntry(fm_int sw, fm_int crmId, fm_crmCfg * cfg);
 /** ComputeChecksum
  * \ingroup intSwitch
  *
- * \desc            Computes the checksum for a CRM monitor.
+ * \desc            Computes the checksum for a CRM monitor. The checksum
+ *                  is maintained incrementally by the register cache, so
+ *                  only the first call for a monitor reads its whole table.
  *
  * \note            The caller has already taken the necessary locks.
  *
@@ -153,19 +155,19 @@ static fm_status ComputeChecksum(fm_int sw, fm_int crmId, fm_uint32 * checksum)
     {
         indices[1] = crmId;
 
-        err = fmRegCacheComputeChecksum(sw,
-                                        &fm10000CacheFfuSliceTcam,
-                                        indices,
-                                        FM10000_FFU_SLICE_TCAM_ENTRIES_0,
-                                        checksum);
+        err = fmRegCacheGetChecksum(sw,
+                                    &fm10000CacheFfuSliceTcam,
+                                    indices,
+                                    FM10000_FFU_SLICE_TCAM_ENTRIES_0,
+                                    checksum);
     }
     else if (crmId == FM10000_GLORT_CAM_CRM_ID)
     {
-        err = fmRegCacheComputeChecksum(sw,
-                                        &fm10000CacheGlortCam,
-                                        indices,
-                                        FM10000_GLORT_CAM_ENTRIES,
-                                        checksum);
+        err = fmRegCacheGetChecksum(sw,
+                                    &fm10000CacheGlortCam,
+                                    indices,
+                                    FM10000_GLORT_CAM_ENTRIES,
+                                    checksum);
     }
     else
     {
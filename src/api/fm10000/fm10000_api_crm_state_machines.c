@@ -565,6 +565,13 @@ fm_status fm10000RegisterBasicCrmStateMachine( void )
                                              dynstt,
                                              logCallback,
                                              TRUE ); 
+    if ( status != FM_OK )
+    {
+        return status;
+    }
+
+    status = fmSetStateTransitionLogCategories( FM10000_BASIC_CRM_STATE_MACHINE,
+                                                FM_LOG_CAT_PORT );
     return status;
 
 }   /* end fm10000RegisterBasicCrmStateMachine */
@@ -61,6 +61,10 @@
 #define FM_AAD_API_FM10000_MA_USED_TABLE_EXPIRY_FACTOR  1.05
 #define FM_AAD_API_FM10000_MA_USED_TABLE_READY_FACTOR   0.5
 
+/* Span of the MA table aging wheel, as a multiple of the expiry time.
+ * Must cover the expiry time plus the interval between two passes. */
+#define AGE_WHEEL_SPAN_FACTOR           2
+
 
 enum _fm_usedSweeperState
 {
@@ -127,6 +131,7 @@ static void EnterActiveState(fm_int sw, fm_uint64 currentTime)
     fm_float        agingTicks;
     fm_float        agingFactor;
     fm_float        expiryFactor;
+    fm_uint64       slotWidth;
 
     switchPtr = GET_SWITCH_PTR(sw);
     switchExt = switchPtr->extension;
@@ -140,6 +145,17 @@ static void EnterActiveState(fm_int sw, fm_uint64 currentTime)
     switchExt->usedTableAgingTime  = (fm_uint64) (agingTicks * agingFactor);
     switchExt->usedTableExpiryTime = (fm_uint64) (agingTicks * expiryFactor);
 
+    /* Size the aging wheel slots for the current aging time. The entries
+     * are put back on the wheel if it changed. */
+    slotWidth = AGE_WHEEL_SPAN_FACTOR * switchExt->usedTableExpiryTime /
+                FM_MA_AGE_WHEEL_SLOTS;
+
+    FM_TAKE_L2_LOCK(sw);
+    fmAddrIndexSetAgeWheel(switchPtr,
+                           (slotWidth > 0) ? slotWidth : 1,
+                           currentTime);
+    FM_DROP_L2_LOCK(sw);
+
     switchExt->usedTableSweeperIndex = 0;
     switchExt->usedTableNumExpired = 0;
     switchExt->usedTableLastSweepTime = currentTime;
@@ -156,6 +172,180 @@ static void EnterActiveState(fm_int sw, fm_uint64 currentTime)
 
 
 
+/*****************************************************************************/
+/** CheckEntryAge
+ * \ingroup intFastMaint
+ *
+ * \desc            Makes a YOUNG or OLD entry that was not hit OLD or
+ *                  EXPIRED, according to its age.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \param[in]       entryIndex is the MA table index of the entry.
+ *
+ * \param[in]       currentTime is the current value of the aging timer.
+ *
+ * \param[in]       agingTime is the length of time required for an entry
+ *                  to age from YOUNG to OLD.
+ *
+ * \param[in]       expiryTime is the length of time required for an entry
+ *                  to age out.
+ *
+ * \param[in,out]   stats points to the counters to be incremented.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void CheckEntryAge(fm_switch *     switchPtr,
+                          fm_int          entryIndex,
+                          fm_uint64       currentTime,
+                          fm_uint64       agingTime,
+                          fm_uint64       expiryTime,
+                          fm_sweepStats * stats)
+{
+    fm_internalMacAddrEntry * cachePtr;
+    fm_uint64                 elapsedTime;
+
+    cachePtr = &switchPtr->maTable[entryIndex];
+
+    if (cachePtr->state != FM_MAC_ENTRY_STATE_OLD &&
+        cachePtr->state != FM_MAC_ENTRY_STATE_YOUNG)
+    {
+        return;
+    }
+
+    /* Get the age of this entry. */
+    elapsedTime = currentTime - cachePtr->agingCounter;
+
+    if (elapsedTime >= expiryTime)
+    {
+        /* The entry has aged out. */
+        cachePtr->state = FM_MAC_ENTRY_STATE_EXPIRED;
+        fmAddrIndexNoteExpired(switchPtr, entryIndex);
+        ++stats->expired;
+        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_FAST_MAINT,
+                     "expired: index=%d mac=%012llx vid=%u "
+                     "elapsed=%llu\n",
+                     entryIndex,
+                     cachePtr->macAddress,
+                     cachePtr->vlanID,
+                     elapsedTime);
+    }
+    else if (cachePtr->state == FM_MAC_ENTRY_STATE_YOUNG &&
+             elapsedTime >= agingTime)
+    {
+        /* The entry has gone from YOUNG to OLD. */
+        cachePtr->state = FM_MAC_ENTRY_STATE_OLD;
+        ++stats->old;
+        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_FAST_MAINT,
+                     "aged: index=%d mac=%012llx vid=%u "
+                     "elapsed=%llu\n",
+                     entryIndex,
+                     cachePtr->macAddress,
+                     cachePtr->vlanID,
+                     elapsedTime);
+    }
+
+}   /* end CheckEntryAge */
+
+
+
+
+/*****************************************************************************/
+/** ProcessDueEntries
+ * \ingroup intFastMaint
+ *
+ * \desc            Ages the entries of the aging wheel slots that have
+ *                  become due, rather than every entry of the MA table.
+ *
+ * \param[in]       sw is the switch on which to operate
+ *
+ * \param[in]       currentTime is the current value of the aging timer.
+ *
+ * \param[in]       agingTime is the length of time required for an entry
+ *                  to age from YOUNG to OLD.
+ *
+ * \param[in]       expiryTime is the length of time required for an entry
+ *                  to age out.
+ *
+ * \param[in,out]   stats points to the counters to be incremented.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status ProcessDueEntries(fm_int          sw,
+                                   fm_uint64       currentTime,
+                                   fm_uint64       agingTime,
+                                   fm_uint64       expiryTime,
+                                   fm_sweepStats * stats)
+{
+    fm_switch * switchPtr;
+    fm_uint32 * indexes;
+    fm_int      numIndexes;
+    fm_status   status;
+    fm_bool     forExpiry;
+    fm_uint64   ageTime;
+    fm_int      i;
+    fm_int      j;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    status    = FM_OK;
+
+    FM_TAKE_L2_LOCK(sw);
+
+    /* Visit the slots due to go from YOUNG to OLD, then the slots due to
+     * expire. */
+    for (i = 0 ; i < 2 ; i++)
+    {
+        forExpiry = (i == 1);
+        ageTime   = forExpiry ? expiryTime : agingTime;
+
+        if (currentTime < ageTime)
+        {
+            continue;
+        }
+
+        status = fmAddrIndexGetAgeDue(switchPtr,
+                                      currentTime - ageTime,
+                                      forExpiry,
+                                      &indexes,
+                                      &numIndexes);
+
+        if (status != FM_OK)
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_EVENT_FAST_MAINT,
+                         "Error visiting the aging wheel: %s\n",
+                         fmErrorMsg(status));
+            break;
+        }
+
+        for (j = 0 ; j < numIndexes ; j++)
+        {
+            CheckEntryAge(switchPtr,
+                          indexes[j],
+                          currentTime,
+                          agingTime,
+                          expiryTime,
+                          stats);
+        }
+
+        if (indexes != NULL)
+        {
+            fmFree(indexes);
+        }
+    }
+
+    FM_DROP_L2_LOCK(sw);
+
+    return status;
+
+}   /* end ProcessDueEntries */
+
+
+
+
 /*****************************************************************************/
 /** ProcessSample
  * \ingroup intFastMaint
@@ -201,7 +391,7 @@ static fm_status ProcessSample(fm_int          sw,
     fm_int          entryIndex;
     fm_int          i;
     fm_int          j;
-    fm_uint64       elapsedTime;
+    fm_bool         useWheel;
     fm_sweepStats   sampleStats;
 
     switchPtr = GET_SWITCH_PTR(sw);
@@ -240,9 +430,18 @@ static fm_status ProcessSample(fm_int          sw,
         goto ABORT;
     }
 
+    /* With the aging wheel, only the hits are processed here; the
+     * entries that are due to age are visited at the end of the pass. */
+    useWheel = fmAddrIndexHasAgeWheel(switchPtr);
+
     /* Process each word in the sample. */
     for (i = 0 ; i < numWords ; ++i)
     {
+        if (useWheel && used[i] == 0)
+        {
+            continue;
+        }
+
         /* Process each bit in the word. */
         for (j = 0 ; j < ENTRIES_PER_WORD ; ++j)
         {
@@ -264,39 +463,19 @@ static fm_status ProcessSample(fm_int          sw,
             {
                 cachePtr->state = FM_MAC_ENTRY_STATE_YOUNG;
                 cachePtr->agingCounter = currentTime;
+                fmAddrIndexNoteHit(switchPtr, entryIndex);
                 ++sampleStats.young;
                 continue;
             }
 
-            /* Get the age of this entry. */
-            elapsedTime = currentTime - cachePtr->agingCounter;
-
-            if (elapsedTime >= expiryTime)
-            {
-                /* The entry has aged out. */
-                cachePtr->state = FM_MAC_ENTRY_STATE_EXPIRED;
-                ++sampleStats.expired;
-                FM_LOG_DEBUG(FM_LOG_CAT_EVENT_FAST_MAINT,
-                             "expired: index=%d mac=%012llx vid=%u "
-                             "elapsed=%llu\n",
-                             entryIndex,
-                             cachePtr->macAddress,
-                             cachePtr->vlanID,
-                             elapsedTime);
-            }
-            else if (cachePtr->state == FM_MAC_ENTRY_STATE_YOUNG &&
-                     elapsedTime >= agingTime)
+            if (!useWheel)
             {
-                /* The entry has gone from YOUNG to OLD. */
-                cachePtr->state = FM_MAC_ENTRY_STATE_OLD;
-                ++sampleStats.old;
-                FM_LOG_DEBUG(FM_LOG_CAT_EVENT_FAST_MAINT,
-                             "aged: index=%d mac=%012llx vid=%u "
-                             "elapsed=%llu\n",
-                             entryIndex,
-                             cachePtr->macAddress,
-                             cachePtr->vlanID,
-                             elapsedTime);
+                CheckEntryAge(switchPtr,
+                              entryIndex,
+                              currentTime,
+                              agingTime,
+                              expiryTime,
+                              &sampleStats);
             }
 
         }   /* end for (j = 0 ; j < ENTRIES_PER_WORD ; ++j) */
@@ -370,6 +549,16 @@ static void UsedSweeperActiveState(fm_int sw, fm_uint64 currentTime)
 
     }   /* end while (switchExt->usedTableSweeperIndex < upperBound) */
 
+    if (switchExt->usedTableSweeperIndex >= USED_TABLE_SIZE &&
+        fmAddrIndexHasAgeWheel(switchPtr))
+    {
+        ProcessDueEntries(sw,
+                          currentTime,
+                          switchExt->usedTableAgingTime,
+                          switchExt->usedTableExpiryTime,
+                          &stats);
+    }
+
     switchExt->usedTableNumExpired += stats.expired;
 
     if (switchExt->usedTableSweeperIndex >= USED_TABLE_SIZE)
@@ -635,6 +824,14 @@ void * fm10000FastMaintenanceTask(fm_int sw, void *args)
                      fmErrorMsg(err));
     }
 
+    err = fm10000ArpTablePeriodicMaintenance(sw);
+    if (err != FM_OK)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_EVENT_FAST_MAINT,
+                     "ArpTableMaintenance returned error: %s\n",
+                     fmErrorMsg(err));
+    }
+
     return NULL;
 
 }   /* end fm10000FastMaintenanceTask */
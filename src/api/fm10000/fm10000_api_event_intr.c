@@ -308,7 +308,11 @@ fm_status fm10000InterruptHandler(fm_switch *switchPtr)
     fm_bool             curPepState;
     fm_uint32           softReset;
     fm_uint32           pepLinkDownMask = 0;
+    fm_uint32           mailboxPepMask = 0;
     fm_int              port;
+    fm10000_property *  fm10kProp;
+    fm_int              pollTime;
+    fm_smEventBatch     serDesBatch;
 
     FM_LOG_ENTRY(FM_LOG_CAT_EVENT_INTR,
                  "switchPtr=%p\n",
@@ -316,6 +320,12 @@ fm_status fm10000InterruptHandler(fm_switch *switchPtr)
 
     sw = switchPtr->switchNumber;
 
+    /* SerDes events of all EPL lanes are processed in one pass. */
+    fmInitStateMachineEventBatch(&serDesBatch);
+
+    /* No polling unless this pass handles a moderated interrupt type. */
+    switchPtr->intrPollTime = 0;
+
     /**************************************************
      * Once signaled, we need to do interrupt processing
      * repeatedly until we see no more interrupts on
@@ -879,13 +889,17 @@ fm_status fm10000InterruptHandler(fm_switch *switchPtr)
                 status = fm10000SerDesEventHandler( sw,
                                                     i,
                                                     j,
-                                                    currentIntr.epl[i].serdes[j] );
+                                                    currentIntr.epl[i].serdes[j],
+                                                    &serDesBatch );
                 FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_INTR, status);
             }
 
         }   /* end for ( j = 0 ; j < FM10000_PORTS_PER_EPL ; j++ ) */
 
     }   /* end for ( i = 0 ; i < FM10000_NUM_EPLS ; i++ ) */
+
+    status = fmFlushStateMachineEventBatch(&serDesBatch);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_INTR, status);
     
 
     /***************************************************
@@ -930,6 +944,14 @@ fm_status fm10000InterruptHandler(fm_switch *switchPtr)
         /* Mailbox interrupts */
         if ( currentIntr.pcie[i] & FM10000_INT_PCIE_IP_MAILBOX )
         {
+            if ( (fmRootApi->numMailboxWorkers > 0) ||
+                 GET_FM10000_PROPERTY()->mailboxBatchRequests )
+            {
+                /* serviced below, together with the other PEPs */
+                mailboxPepMask |= (1U << i);
+                continue;
+            }
+
             status = fm10000PCIeMailboxInterruptHandler(sw, i);
 
             /* if switch is not up, do not handle next interrupts. */
@@ -942,6 +964,64 @@ fm_status fm10000InterruptHandler(fm_switch *switchPtr)
         }
     }   /* end for (i = 0 ; i < FM10000_NUM_PEPS ; i++) */
 
+    if ( (mailboxPepMask != 0) && (fmRootApi->numMailboxWorkers > 0) )
+    {
+        /* The workers re-enable the interrupts once serviced */
+        status = fmMailboxQueuePeps(sw, mailboxPepMask);
+        FM_ERR_COMBINE(retStatus, status);
+    }
+    else if (mailboxPepMask != 0)
+    {
+        status = fm10000PCIeMailboxBatchInterruptHandler(sw, mailboxPepMask);
+
+        if (status == FM_ERR_SWITCH_NOT_UP)
+        {
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_INTR, status);
+        }
+
+        FM_ERR_COMBINE(retStatus, status);
+    }
+
+    /**************************************************
+     * Ask the interrupt task to keep polling for the
+     * longest window among the moderated interrupt
+     * types handled in this pass.
+     **************************************************/
+    fm10kProp = GET_FM10000_PROPERTY();
+    pollTime  = 0;
+
+    eplIntMask = FM10000_INT_EPL_0;
+    for ( i = 0 ; i < FM10000_NUM_EPLS ; i++ )
+    {
+        if ( ( global & eplIntMask ) != 0 )
+        {
+            pollTime = fm10kProp->intrLinkPollTime;
+            break;
+        }
+
+        eplIntMask <<= 1;
+    }
+
+    if ( currentIntr.ma_tcn &&
+         ( fm10kProp->intrMaTcnPollTime > pollTime ) )
+    {
+        pollTime = fm10kProp->intrMaTcnPollTime;
+    }
+
+    for ( i = 0 ; i < FM10000_NUM_PEPS ; i++ )
+    {
+        if ( ( currentIntr.pcie[i] & FM10000_INT_PCIE_IP_MAILBOX ) &&
+             ( fm10kProp->intrMailboxPollTime > pollTime ) )
+        {
+            pollTime = fm10kProp->intrMailboxPollTime;
+        }
+    }
+
+    if (pollTime > 0)
+    {
+        switchPtr->intrPollTime = pollTime;
+    }
+
     FM_LOG_EXIT(FM_LOG_CAT_EVENT_INTR, FM_OK);
 
 ABORT:
@@ -952,6 +1032,12 @@ ABORT:
         DROP_REG_LOCK( sw );
     }
 
+    /* Don't lose the serDes events queued before the error */
+    if (serDesBatch.nrEvents > 0)
+    {
+        fmFlushStateMachineEventBatch(&serDesBatch);
+    }
+
     FM_ERR_COMBINE(retStatus, status);
 
     FM_LOG_EXIT(FM_LOG_CAT_EVENT_INTR, retStatus);
@@ -70,6 +70,15 @@ typedef struct _fm_fifoEntry
 } fm_fifoEntry;
 
 
+/* Scale of the learning rate limiter tokens: one address costs this
+ * many tokens, and a bucket gains its rate in tokens every millisecond. */
+#define FM10000_LEARN_TOKEN_SCALE       1000
+
+/* Time, in milliseconds, without a dropped address after which a
+ * throttled token bucket is considered to have recovered. */
+#define FM10000_LEARN_THROTTLE_HOLDOFF  1000
+
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -346,32 +355,35 @@ static fm_status EnableTcnPendingEvents(fm_int sw)
 
 
 /*****************************************************************************/
-/** GetTcnFifoBacklog
+/** ReadTcnFifoPointers
  * \ingroup intMacMaint
  *
- * \desc            Returns the number of pending events in the TCN FIFO.
+ * \desc            Reads the head and tail pointers of the TCN FIFO.
+ *
+ * \note            The caller is assumed to have taken the register lock.
  *
  * \param[in]       sw is the switch on which to operate.
  * 
- * \param[out]      backlog points to a location to receive the number of
- *                  pending events in the MA TCN FIFO.
+ * \param[out]      head points to a location to receive the index of the
+ *                  oldest entry in the FIFO.
+ * 
+ * \param[out]      tail points to a location to receive the index of the
+ *                  next entry to be written to the FIFO.
  *
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
-static fm_status GetTcnFifoBacklog(fm_int sw, fm_uint32 * backlog)
+static fm_status ReadTcnFifoPointers(fm_int      sw,
+                                     fm_uint32 * head,
+                                     fm_uint32 * tail)
 {
     fm_switch * switchPtr;
     fm_status   status;
     fm_uint32   tcnHead;
     fm_uint32   tcnTail;
-    fm_uint32   head;
-    fm_uint32   tail;
 
     switchPtr = GET_SWITCH_PTR(sw);
 
-    TAKE_REG_LOCK(sw);
-
     status = switchPtr->ReadUINT32(sw, FM10000_MA_TCN_PTR_HEAD(), &tcnHead);
 
     if (status == FM_OK)
@@ -379,13 +391,10 @@ static fm_status GetTcnFifoBacklog(fm_int sw, fm_uint32 * backlog)
         status = switchPtr->ReadUINT32(sw, FM10000_MA_TCN_PTR_TAIL(), &tcnTail);
     }
 
-    DROP_REG_LOCK(sw);
-
     if (status == FM_OK)
     {
-        head = FM_GET_FIELD(tcnHead, FM10000_MA_TCN_PTR_HEAD, Head);
-        tail = FM_GET_FIELD(tcnTail, FM10000_MA_TCN_PTR_TAIL, Tail);
-        *backlog = (tail - head) & (FM10000_MA_TCN_FIFO_ENTRIES - 1);
+        *head = FM_GET_FIELD(tcnHead, FM10000_MA_TCN_PTR_HEAD, Head);
+        *tail = FM_GET_FIELD(tcnTail, FM10000_MA_TCN_PTR_TAIL, Tail);
     }
     else
     {
@@ -394,6 +403,47 @@ static fm_status GetTcnFifoBacklog(fm_int sw, fm_uint32 * backlog)
                      "Error reading MA_TCN_PTR: %s\n",
                      fmErrorMsg(status));
         fmDbgDiagCountIncr(sw, FM_CTR_TCN_PTR_READ_ERR, 1);
+    }
+
+    return status;
+
+}   /* end ReadTcnFifoPointers */
+
+
+
+
+/*****************************************************************************/
+/** GetTcnFifoBacklog
+ * \ingroup intMacMaint
+ *
+ * \desc            Returns the number of pending events in the TCN FIFO.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ * 
+ * \param[out]      backlog points to a location to receive the number of
+ *                  pending events in the MA TCN FIFO.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status GetTcnFifoBacklog(fm_int sw, fm_uint32 * backlog)
+{
+    fm_status   status;
+    fm_uint32   head;
+    fm_uint32   tail;
+
+    TAKE_REG_LOCK(sw);
+
+    status = ReadTcnFifoPointers(sw, &head, &tail);
+
+    DROP_REG_LOCK(sw);
+
+    if (status == FM_OK)
+    {
+        *backlog = (tail - head) & (FM10000_MA_TCN_FIFO_ENTRIES - 1);
+    }
+    else
+    {
         *backlog = 0;
     }
 
@@ -404,6 +454,326 @@ static fm_status GetTcnFifoBacklog(fm_int sw, fm_uint32 * backlog)
 
 
 
+/*****************************************************************************/
+/** ReadTcnFifoBurst
+ * \ingroup intMacMaint
+ *
+ * \desc            Reads the pending entries of the TCN FIFO directly from
+ *                  the FIFO memory, with one multi-word read (two if the
+ *                  entries wrap around the end of the FIFO), and removes
+ *                  them from the FIFO by advancing its head pointer.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ * 
+ * \param[in]       maxEntries is the maximum number of entries to read.
+ * 
+ * \param[out]      tcnWords points to an array of at least
+ *                  maxEntries * FM10000_MA_TCN_FIFO_WIDTH words to receive
+ *                  the FIFO entries.
+ * 
+ * \param[out]      numEntries points to a location to receive the number
+ *                  of entries read.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status ReadTcnFifoBurst(fm_int      sw,
+                                  fm_int      maxEntries,
+                                  fm_uint32 * tcnWords,
+                                  fm_int *    numEntries)
+{
+    fm_switch * switchPtr;
+    fm_status   status;
+    fm_uint32   head;
+    fm_uint32   tail;
+    fm_uint32   tcnHead;
+    fm_int      backlog;
+    fm_int      numFirst;
+
+    switchPtr   = GET_SWITCH_PTR(sw);
+    *numEntries = 0;
+
+    TAKE_REG_LOCK(sw);
+
+    status = ReadTcnFifoPointers(sw, &head, &tail);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_MAC_MAINT, status);
+
+    backlog = (tail - head) & (FM10000_MA_TCN_FIFO_ENTRIES - 1);
+
+    if (backlog > maxEntries)
+    {
+        backlog = maxEntries;
+    }
+
+    if (backlog == 0)
+    {
+        goto ABORT;
+    }
+
+    /* Entries up to the end of the FIFO memory. */
+    numFirst = FM10000_MA_TCN_FIFO_ENTRIES - head;
+
+    if (numFirst > backlog)
+    {
+        numFirst = backlog;
+    }
+
+    status = switchPtr->ReadUINT32Mult(sw,
+                                       FM10000_MA_TCN_FIFO(head, 0),
+                                       numFirst * FM10000_MA_TCN_FIFO_WIDTH,
+                                       tcnWords);
+
+    /* Entries that wrapped around to the start of the FIFO memory. */
+    if (status == FM_OK && backlog > numFirst)
+    {
+        status = switchPtr->ReadUINT32Mult(sw,
+                                           FM10000_MA_TCN_FIFO(0, 0),
+                                           (backlog - numFirst) *
+                                               FM10000_MA_TCN_FIFO_WIDTH,
+                                           &tcnWords[numFirst *
+                                                     FM10000_MA_TCN_FIFO_WIDTH]);
+    }
+
+    if (status != FM_OK)
+    {
+        /* TCN FIFO read error. */
+        fmDbgDiagCountIncr(sw, FM_CTR_TCN_FIFO_READ_ERR, 1);
+        goto ABORT;
+    }
+
+    /* Consume the entries. */
+    head    = (head + backlog) & (FM10000_MA_TCN_FIFO_ENTRIES - 1);
+    tcnHead = 0;
+    FM_SET_FIELD(tcnHead, FM10000_MA_TCN_PTR_HEAD, Head, head);
+
+    status = switchPtr->WriteUINT32(sw, FM10000_MA_TCN_PTR_HEAD(), tcnHead);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_MAC_MAINT, status);
+
+    *numEntries = backlog;
+
+ABORT:
+    DROP_REG_LOCK(sw);
+
+    return status;
+
+}   /* end ReadTcnFifoBurst */
+
+
+
+
+/*****************************************************************************/
+/** RefillLearnBucket
+ * \ingroup intMacMaint
+ *
+ * \desc            Adds the tokens accumulated since the last refill to a
+ *                  learning rate limiter token bucket. The bucket holds at
+ *                  most one second worth of addresses.
+ *
+ * \param[in,out]   bucket points to the token bucket.
+ * 
+ * \param[in]       rate is the rate of the bucket, in addresses per second.
+ * 
+ * \param[in]       now is the current time, in milliseconds.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void RefillLearnBucket(fm10000_learnBucket * bucket,
+                              fm_uint32             rate,
+                              fm_uint64             now)
+{
+    fm_uint64   capacity;
+
+    capacity = (fm_uint64) rate * FM10000_LEARN_TOKEN_SCALE;
+
+    if (now > bucket->lastRefill)
+    {
+        bucket->tokens += (now - bucket->lastRefill) * rate;
+
+        if (bucket->tokens > capacity)
+        {
+            bucket->tokens = capacity;
+        }
+    }
+
+    /* A clock that went backwards simply restarts the interval. */
+    bucket->lastRefill = now;
+
+    if ( bucket->throttled &&
+         (now - bucket->lastDrop) >= FM10000_LEARN_THROTTLE_HOLDOFF )
+    {
+        bucket->throttled = FALSE;
+    }
+
+}   /* end RefillLearnBucket */
+
+
+
+
+/*****************************************************************************/
+/** ReportLearnThrottled
+ * \ingroup intMacMaint
+ *
+ * \desc            Reports the start of learning throttling with an
+ *                  ''FM_EVENT_ENTRY_LEARN_THROTTLED'' table update.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ * 
+ * \param[in]       port is the logical port that exceeded its limit, or -1
+ *                  if the switch-wide limit was exceeded.
+ * 
+ * \param[in,out]   numUpdates points to a variable containing the number of
+ *                  updates stored in the event buffer.
+ * 
+ * \param[in,out]   outEvent points to a pointer to the event buffer.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReportLearnThrottled(fm_int      sw,
+                                 fm_int      port,
+                                 fm_uint32 * numUpdates,
+                                 fm_event ** outEvent)
+{
+    fm_internalMacAddrEntry update;
+
+    FM_LOG_DEBUG(FM_LOG_CAT_EVENT_MAC_MAINT,
+                 "learning throttled: sw=%d port=%d\n",
+                 sw,
+                 port);
+
+    FM_CLEAR(update);
+
+    update.state    = FM_MAC_ENTRY_STATE_INVALID;
+    update.destMask = FM_DESTMASK_UNUSED;
+    update.port     = port;
+
+    fmGenerateUpdateForEvent(sw,
+                             &fmRootApi->eventThread,
+                             FM_EVENT_ENTRY_LEARN_THROTTLED,
+                             FM_MAC_REASON_LEARN_THROTTLED,
+                             -1,
+                             &update,
+                             numUpdates,
+                             outEvent);
+
+}   /* end ReportLearnThrottled */
+
+
+
+
+/*****************************************************************************/
+/** AdmitNewSource
+ * \ingroup intMacMaint
+ *
+ * \desc            Applies the learning rate limits to a NewSource event.
+ *                                                                      \lb\lb
+ *                  An address that exceeds the switch-wide or the source
+ *                  port limit is dropped; the hardware reports it again
+ *                  the next time the station transmits. A single
+ *                  ''FM_EVENT_ENTRY_LEARN_THROTTLED'' update is generated
+ *                  when a bucket starts dropping addresses, rather than
+ *                  one update per address.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ * 
+ * \param[in]       fifoEntry points to the decoded NewSource event.
+ * 
+ * \param[in,out]   numUpdates points to a variable containing the number of
+ *                  updates stored in the event buffer.
+ * 
+ * \param[in,out]   outEvent points to a pointer to the event buffer.
+ *
+ * \return          TRUE if the address may be learned.
+ * \return          FALSE if the address was dropped.
+ *
+ *****************************************************************************/
+static fm_bool AdmitNewSource(fm_int         sw,
+                              fm_fifoEntry * fifoEntry,
+                              fm_uint32 *    numUpdates,
+                              fm_event **    outEvent)
+{
+    fm10000_switch *        switchExt;
+    fm10000_learnLimiter *  limiter;
+    fm10000_learnBucket *   portBucket;
+    fm10000_learnBucket *   bucket;
+    fm_uint64               now;
+    fm_int                  port;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    limiter   = &switchExt->learnLimiter;
+
+    if (limiter->rate == 0 && limiter->portRate == 0)
+    {
+        return TRUE;
+    }
+
+    now        = fm10000GetAgingTimer();
+    portBucket = NULL;
+    bucket     = NULL;
+    port       = -1;
+
+    if ( limiter->portRate != 0 &&
+         fifoEntry->srcPort >= 0 &&
+         fifoEntry->srcPort < FM10000_NUM_FABRIC_PORTS )
+    {
+        portBucket = &limiter->port[fifoEntry->srcPort];
+        RefillLearnBucket(portBucket, limiter->portRate, now);
+
+        if (portBucket->tokens < FM10000_LEARN_TOKEN_SCALE)
+        {
+            bucket = portBucket;
+            port   = fifoEntry->logicalPort;
+        }
+    }
+
+    if (limiter->rate != 0)
+    {
+        RefillLearnBucket(&limiter->global, limiter->rate, now);
+
+        if ( bucket == NULL &&
+             limiter->global.tokens < FM10000_LEARN_TOKEN_SCALE )
+        {
+            bucket = &limiter->global;
+        }
+    }
+
+    if (bucket == NULL)
+    {
+        /* Both limits allow the address: charge it to both buckets. */
+        if (portBucket != NULL)
+        {
+            portBucket->tokens -= FM10000_LEARN_TOKEN_SCALE;
+        }
+
+        if (limiter->rate != 0)
+        {
+            limiter->global.tokens -= FM10000_LEARN_TOKEN_SCALE;
+        }
+
+        return TRUE;
+    }
+
+    bucket->numDropped++;
+    bucket->lastDrop = now;
+
+    fmDbgDiagCountIncr(sw, FM_CTR_MAC_LEARN_THROTTLED, 1);
+
+    if (!bucket->throttled)
+    {
+        bucket->throttled = TRUE;
+        bucket->numThrottled++;
+
+        ReportLearnThrottled(sw, port, numUpdates, outEvent);
+    }
+
+    return FALSE;
+
+}   /* end AdmitNewSource */
+
+
+
+
 /*****************************************************************************/
 /** HandleNewSourceEvent
  * \ingroup intMacMaint
@@ -520,6 +890,166 @@ static fm_status HandleMacMovedEvent(fm_int         sw,
 
 
 
+/*****************************************************************************/
+/** FlushLearnedEntries
+ * \ingroup intMacMaint
+ *
+ * \desc            Adds the new source addresses collected during a burst
+ *                  to the MA Table in a single batched update.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ * 
+ * \param[in]       learned points to the array of collected entries.
+ * 
+ * \param[in,out]   numLearned points to the number of collected entries.
+ *                  Reset to zero on return.
+ * 
+ * \param[in,out]   numUpdates points to a variable containing the number of
+ *                  updates stored in the event buffer.
+ * 
+ * \param[in,out]   outEvent points to a pointer to the event buffer.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void FlushLearnedEntries(fm_int               sw,
+                                fm_macAddressEntry * learned,
+                                fm_int *             numLearned,
+                                fm_uint32 *          numUpdates,
+                                fm_event **          outEvent)
+{
+
+    if (*numLearned > 0)
+    {
+        fm10000AddMacTableEntryList(sw,
+                                    learned,
+                                    *numLearned,
+                                    FM_MAC_SOURCE_TCN_LEARNED,
+                                    numUpdates,
+                                    outEvent);
+        *numLearned = 0;
+    }
+
+}   /* end FlushLearnedEntries */
+
+
+
+
+/*****************************************************************************/
+/** ProcessFifoEntry
+ * \ingroup intMacMaint
+ *
+ * \desc            Decodes and processes one TCN FIFO entry.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ * 
+ * \param[in]       tcnEntry points to the words of the TCN FIFO entry.
+ * 
+ * \param[in,out]   learned points to an array in which NewSource events
+ *                  are collected, to be added to the MA Table together by
+ *                  ''FlushLearnedEntries''. May be NULL, in which case
+ *                  NewSource events are handled at once.
+ * 
+ * \param[in,out]   numLearned points to the number of entries collected
+ *                  in learned. Ignored if learned is NULL.
+ * 
+ * \param[in,out]   numUpdates points to a variable containing the number of
+ *                  updates stored in the event buffer.
+ * 
+ * \param[in,out]   outEvent points to a pointer to the event buffer.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ProcessFifoEntry(fm_int               sw,
+                             fm_uint32 *          tcnEntry,
+                             fm_macAddressEntry * learned,
+                             fm_int *             numLearned,
+                             fm_uint32 *          numUpdates,
+                             fm_event **          outEvent)
+{
+    fm_fifoEntry         fifoEntry;
+    fm_macAddressEntry * entry;
+    fm_status            err;
+
+    if (FM_ARRAY_GET_BIT(tcnEntry, FM10000_MA_TCN_DEQUEUE, U_err))
+    {
+        /* Uncorrectable error in TCN FIFO entry. */
+        fmDbgDiagCountIncr(sw, FM_CTR_TCN_FIFO_PARITY_ERR, 1);
+        return;
+    }
+
+    /***************************************************
+     * Decode the TCN FIFO entry.
+     **************************************************/
+
+    err = DecodeFifoEntry(sw, tcnEntry, &fifoEntry);
+
+    if (err == FM_ERR_INVALID_PORT)
+    {
+        fmDbgDiagCountIncr(sw, FM_CTR_MAC_PORT_ERR, 1);
+        return;
+    }
+    else if (err != FM_OK)
+    {
+        /* TCN FIFO entry conversion error. */
+        fmDbgDiagCountIncr(sw, FM_CTR_TCN_FIFO_CONV_ERR, 1);
+        return;
+    }
+
+    /***************************************************
+     * Process the decoded entry.
+     **************************************************/
+
+    if (fifoEntry.macSource == FM_MAC_SOURCE_TCN_LEARNED)
+    {
+        /* Increment number of NewSource events removed from FIFO. */
+        fmDbgDiagCountIncr(sw, FM_CTR_TCN_LEARNED_EVENT, 1);
+
+        if (!AdmitNewSource(sw, &fifoEntry, numUpdates, outEvent))
+        {
+            return;
+        }
+
+        if (learned == NULL)
+        {
+            HandleNewSourceEvent(sw, &fifoEntry, numUpdates, outEvent);
+            return;
+        }
+
+        entry = &learned[*numLearned];
+
+        FM_CLEAR(*entry);
+
+        entry->macAddress = fifoEntry.macAddress;
+        entry->destMask   = FM_DESTMASK_UNUSED;
+        entry->port       = fifoEntry.logicalPort;
+        entry->type       = FM_ADDRESS_DYNAMIC;
+
+        if (fm10000GetLearningFID(sw, fifoEntry.vlanID, &entry->vlanID) == FM_OK)
+        {
+            ++(*numLearned);
+        }
+    }
+    else
+    {
+        /* Increment number of MacMoved events removed from FIFO. */
+        fmDbgDiagCountIncr(sw, FM_CTR_TCN_SEC_VIOL_MOVED_EVENT, 1);
+
+        /* Keep the events in FIFO order. */
+        if (learned != NULL)
+        {
+            FlushLearnedEntries(sw, learned, numLearned, numUpdates, outEvent);
+        }
+
+        HandleMacMovedEvent(sw, &fifoEntry, numUpdates, outEvent);
+    }
+
+}   /* end ProcessFifoEntry */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -533,6 +1063,14 @@ static fm_status HandleMacMovedEvent(fm_int         sw,
  *
  * \desc            Services the MA Table Change Notification (TCN) FIFO.
  *                  Called through the HandleMACTableEvents function pointer.
+ *                                                                      \lb\lb
+ *                  If the api.FM10000.ma.tcnBurstRead property is set, the
+ *                  pending entries are read from the FIFO memory in bursts
+ *                  and the new source addresses of each burst are learned
+ *                  with a single batched update of the MA Table.
+ *                                                                      \lb\lb
+ *                  In both modes, new source addresses are subject to the
+ *                  learning rate limits (see ''AdmitNewSource'').
  *
  * \param[in]       sw is the switch on which to operate.
  *
@@ -543,24 +1081,65 @@ fm_status fm10000HandleMACTableEvents(fm_int sw)
 {
     fm_switch *             switchPtr;
     fm10000_switch *        switchExt;
+    fm10000_tcnBurstStats * stats;
     fm_int                  numTcnEntries;
     fm_uint32               tcnEntry[FM10000_MA_TCN_DEQUEUE_WIDTH];
-    fm_fifoEntry            fifoEntry;
+    fm_uint32 *             tcnWords;
+    fm_macAddressEntry *    learned;
+    fm_int                  numLearned;
+    fm_int                  numRead;
+    fm_int                  maxRead;
+    fm_int                  i;
     fm_uint32               backlog;
     fm_uint32               numUpdates;
     fm_event *              outEvent;
+    fm_timestamp            start;
+    fm_timestamp            end;
+    fm_timestamp            diff;
+    fm_uint64               latency;
     fm_status               err;
 
     FM_LOG_ENTRY(FM_LOG_CAT_EVENT_MAC_MAINT, "sw=%d\n", sw);
 
     switchPtr       = GET_SWITCH_PTR(sw);
     switchExt       = GET_SWITCH_EXT(sw);
+    stats           = &switchExt->tcnBurstStats;
     numTcnEntries   = 0;
+    numLearned      = 0;
     numUpdates      = 0;
     outEvent        = NULL;
     backlog         = 0;
+    tcnWords        = NULL;
+    learned         = NULL;
     err             = FM_OK;
 
+    fmGetTime(&start);
+
+    if (switchExt->tcnBurstRead)
+    {
+        tcnWords = fmAlloc(FM10000_MA_TCN_FIFO_ENTRIES *
+                           FM10000_MA_TCN_FIFO_WIDTH *
+                           sizeof(fm_uint32));
+        learned  = fmAlloc(FM10000_MA_TCN_FIFO_ENTRIES *
+                           sizeof(fm_macAddressEntry));
+
+        if (tcnWords == NULL || learned == NULL)
+        {
+            /* Fall back on dequeuing the entries one at a time. */
+            if (tcnWords != NULL)
+            {
+                fmFree(tcnWords);
+                tcnWords = NULL;
+            }
+
+            if (learned != NULL)
+            {
+                fmFree(learned);
+                learned = NULL;
+            }
+        }
+    }
+
     for ( ; ; )
     {
         /***************************************************
@@ -579,6 +1158,47 @@ fm_status fm10000HandleMACTableEvents(fm_int sw)
             break;
         }
 
+        /***************************************************
+         * Read the pending entries from the FIFO memory
+         * and process them as a batch.
+         **************************************************/
+
+        if (tcnWords != NULL)
+        {
+            maxRead = switchExt->tcnFifoBurstSize - numTcnEntries;
+
+            if (maxRead > FM10000_MA_TCN_FIFO_ENTRIES)
+            {
+                maxRead = FM10000_MA_TCN_FIFO_ENTRIES;
+            }
+
+            err = ReadTcnFifoBurst(sw, maxRead, tcnWords, &numRead);
+
+            if (err != FM_OK || numRead == 0)
+            {
+                break;
+            }
+
+            numTcnEntries += numRead;
+
+            for (i = 0 ; i < numRead ; i++)
+            {
+                ProcessFifoEntry(sw,
+                                 &tcnWords[i * FM10000_MA_TCN_FIFO_WIDTH],
+                                 learned,
+                                 &numLearned,
+                                 &numUpdates,
+                                 &outEvent);
+            }
+
+            FlushLearnedEntries(sw,
+                                learned,
+                                &numLearned,
+                                &numUpdates,
+                                &outEvent);
+            continue;
+        }
+
         /***************************************************
          * Read next entry from MA TCN FIFO.
          **************************************************/
@@ -601,49 +1221,7 @@ fm_status fm10000HandleMACTableEvents(fm_int sw)
 
         ++numTcnEntries;
 
-        if (FM_ARRAY_GET_BIT(tcnEntry, FM10000_MA_TCN_DEQUEUE, U_err))
-        {
-            /* Uncorrectable error in TCN FIFO entry. */
-            fmDbgDiagCountIncr(sw, FM_CTR_TCN_FIFO_PARITY_ERR, 1);
-            continue;
-        }
-
-        /***************************************************
-         * Decode the TCN FIFO entry.
-         **************************************************/
-
-        err = DecodeFifoEntry(sw, tcnEntry, &fifoEntry);
-
-        if (err == FM_ERR_INVALID_PORT)
-        {
-            fmDbgDiagCountIncr(sw, FM_CTR_MAC_PORT_ERR, 1);
-            continue;
-        }
-        else if (err != FM_OK)
-        {
-            /* TCN FIFO entry conversion error. */
-            fmDbgDiagCountIncr(sw, FM_CTR_TCN_FIFO_CONV_ERR, 1);
-            continue;
-        }
-
-        /***************************************************
-         * Process the decoded entry.
-         **************************************************/
-
-        if (fifoEntry.macSource == FM_MAC_SOURCE_TCN_LEARNED)
-        {
-            /* Increment number of NewSource events removed from FIFO. */
-            fmDbgDiagCountIncr(sw, FM_CTR_TCN_LEARNED_EVENT, 1);
-
-            HandleNewSourceEvent(sw, &fifoEntry, &numUpdates, &outEvent);
-        }
-        else
-        {
-            /* Increment number of MacMoved events removed from FIFO. */
-            fmDbgDiagCountIncr(sw, FM_CTR_TCN_SEC_VIOL_MOVED_EVENT, 1);
-
-            HandleMacMovedEvent(sw, &fifoEntry, &numUpdates, &outEvent);
-        }
+        ProcessFifoEntry(sw, tcnEntry, NULL, NULL, &numUpdates, &outEvent);
 
     }   /* end for ( ; ; ) */
 
@@ -663,6 +1241,46 @@ fm_status fm10000HandleMACTableEvents(fm_int sw)
         fmReleaseEvent(outEvent);
     }
 
+    if (tcnWords != NULL)
+    {
+        fmFree(tcnWords);
+    }
+
+    if (learned != NULL)
+    {
+        fmFree(learned);
+    }
+
+    /***************************************************
+     * Update the burst statistics.
+     **************************************************/
+
+    if (numTcnEntries > 0)
+    {
+        fmGetTime(&end);
+        fmSubTimestamps(&end, &start, &diff);
+        latency = diff.sec * 1000000 + diff.usec;
+
+        stats->numBursts++;
+        stats->numEntries   += numTcnEntries;
+        stats->totalLatency += latency;
+
+        if ( (fm_uint32) numTcnEntries > stats->maxEntries )
+        {
+            stats->maxEntries = numTcnEntries;
+        }
+
+        if (latency > stats->maxLatency)
+        {
+            stats->maxLatency = latency;
+        }
+
+        if (backlog != 0)
+        {
+            stats->numLimited++;
+        }
+    }
+
     /* If the backlog is non-zero, we reached the TCN FIFO burst limit
      * without running out the TCN FIFO. Schedule another pass over the
      * FIFO, to pick up any stragglers. See bug #25096 for discussion. */
@@ -736,3 +1354,143 @@ fm_status fm10000TCNInterruptHandler(fm_int sw, fm_uint32 events)
 
 }   /* end fm10000TCNInterruptHandler */
 
+
+
+
+/*****************************************************************************/
+/** fm10000DbgDumpTcnBurstStats
+ * \ingroup intMacMaint
+ *
+ * \desc            Displays the statistics on the passes over the MA Table
+ *                  Change Notification FIFO.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000DbgDumpTcnBurstStats(fm_int sw)
+{
+    fm10000_switch *        switchExt;
+    fm10000_tcnBurstStats   stats;
+    fm10000_learnLimiter *  limiter;
+    fm10000_learnBucket *   bucket;
+    fm_int                  port;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    stats     = switchExt->tcnBurstStats;
+
+    FM_LOG_PRINT("TCN FIFO bursts (%s)\n",
+                 switchExt->tcnBurstRead ? "burst read" : "dequeue");
+    FM_LOG_PRINT("  bursts          : %llu\n", stats.numBursts);
+    FM_LOG_PRINT("  limited         : %llu\n", stats.numLimited);
+    FM_LOG_PRINT("  entries         : %llu\n", stats.numEntries);
+    FM_LOG_PRINT("  max entries     : %u\n", stats.maxEntries);
+    FM_LOG_PRINT("  avg entries     : %llu\n",
+                 (stats.numBursts != 0) ?
+                 stats.numEntries / stats.numBursts : 0);
+    FM_LOG_PRINT("  avg latency (us): %llu\n",
+                 (stats.numBursts != 0) ?
+                 stats.totalLatency / stats.numBursts : 0);
+    FM_LOG_PRINT("  max latency (us): %llu\n", stats.maxLatency);
+
+    limiter = &switchExt->learnLimiter;
+
+    FM_LOG_PRINT("Learning rate limiter (global %u/s, per port %u/s)\n",
+                 limiter->rate,
+                 limiter->portRate);
+    FM_LOG_PRINT("  global          : dropped %llu, throttled %llu%s\n",
+                 limiter->global.numDropped,
+                 limiter->global.numThrottled,
+                 limiter->global.throttled ? " (active)" : "");
+
+    for (port = 0 ; port < FM10000_NUM_FABRIC_PORTS ; port++)
+    {
+        bucket = &limiter->port[port];
+
+        if (bucket->numDropped != 0)
+        {
+            FM_LOG_PRINT("  port %2d         : "
+                         "dropped %llu, throttled %llu%s\n",
+                         port,
+                         bucket->numDropped,
+                         bucket->numThrottled,
+                         bucket->throttled ? " (active)" : "");
+        }
+    }
+
+}   /* end fm10000DbgDumpTcnBurstStats */
+
+
+
+
+/*****************************************************************************/
+/** fm10000DbgResetTcnBurstStats
+ * \ingroup intMacMaint
+ *
+ * \desc            Resets the statistics on the passes over the MA Table
+ *                  Change Notification FIFO, including the learning rate
+ *                  limiter drop counts.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000DbgResetTcnBurstStats(fm_int sw)
+{
+    fm10000_switch *        switchExt;
+    fm10000_learnLimiter *  limiter;
+    fm_int                  port;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    limiter   = &switchExt->learnLimiter;
+
+    FM_CLEAR(switchExt->tcnBurstStats);
+
+    limiter->global.numDropped   = 0;
+    limiter->global.numThrottled = 0;
+
+    for (port = 0 ; port < FM10000_NUM_FABRIC_PORTS ; port++)
+    {
+        limiter->port[port].numDropped   = 0;
+        limiter->port[port].numThrottled = 0;
+    }
+
+}   /* end fm10000DbgResetTcnBurstStats */
+
+
+
+
+/*****************************************************************************/
+/** fm10000InitLearnLimiter
+ * \ingroup intMacMaint
+ *
+ * \desc            Initializes the learning rate limiter from the
+ *                  api.FM10000.ma.learningRateLimit and
+ *                  api.FM10000.ma.portLearningRateLimit properties.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000InitLearnLimiter(fm_int sw)
+{
+    fm10000_switch *        switchExt;
+    fm10000_learnLimiter *  limiter;
+    fm_int                  rate;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    limiter   = &switchExt->learnLimiter;
+
+    FM_CLEAR(*limiter);
+
+    rate = GET_FM10000_PROPERTY()->maLearningRateLimit;
+    limiter->rate = (rate > 0) ? (fm_uint32) rate : 0;
+
+    rate = GET_FM10000_PROPERTY()->maPortLearningRateLimit;
+    limiter->portRate = (rate > 0) ? (fm_uint32) rate : 0;
+
+}   /* end fm10000InitLearnLimiter */
+
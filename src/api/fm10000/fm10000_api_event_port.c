@@ -228,6 +228,20 @@ fm_status fm10000SendLinkUpDownEventV2(fm_int           sw,
         return FM_FAIL;
     }
 
+    if (!linkUp)
+    {
+        /* Take the port out of its LAG's hash distribution now rather
+         * than when the event handler gets to the event. */
+        err = fm10000LagFastFailover(sw, logPort);
+        if (err != FM_OK)
+        {
+            FM_LOG_WARNING(FM_LOG_CAT_EVENT_PORT,
+                           "LAG fast failover failed on port %d: %s\n",
+                           logPort,
+                           fmErrorMsg(err));
+        }
+    }
+
     event = fmAllocateEvent(sw,
                             FM_EVID_HIGH_PORT,
                             FM_EVENT_PORT,
@@ -103,6 +103,22 @@ typedef fm_status (*fm_writeReg32Seq)(fm_int     sw,
                                       fm_uint32 *value,
                                       fm_int     n);
 
+/* A rule write or valid bit update held in the FFU write queue */
+typedef struct _fm10000_ffuQueuedWrite
+{
+    /* TRUE if the whole rule is written, FALSE if only its valid bit */
+    fm_bool                setRule;
+
+    fm_bool                valid;
+    fm_bool                live;
+    fm_bool                useCache;
+
+    /* Copies of the rule key and actions, NULL if setRule is FALSE */
+    fm_fm10000FfuSliceKey *ruleKey;
+    fm_ffuAction *         actionList;
+
+} fm10000_ffuQueuedWrite;
+
 /*****************************************************************************
  * Local Functions
  *****************************************************************************/
@@ -1018,97 +1034,983 @@ ABORT:
 
 
 
-/*****************************************************************************
- * Public Functions
- *****************************************************************************/
-
-
 /*****************************************************************************/
-/** fm10000SetFFUSliceOwnership
+/** WriteFFURules
  * \ingroup intLowlevFFU10k
  *
- * \desc            Sets the slice range ownership within the FFU.
+ * \desc            Writes a range of rules into the Filtering & Forwarding
+ *                  unit. The caller must have protected the switch and
+ *                  suspended the TCAM monitor on the slice.
  *
  * \param[in]       sw is the switch on which to operate.
  *
- * \param[in]       owner represents a valid software component.
+ * \param[in]       slice points to the slice or chain of slices on which
+ *                  to operate.
  *
- * \param[in]       firstSlice is the first slice number in the range.
+ * \param[in]       ruleIndex is the index of the first rule to set.
  *
- * \param[in]       lastSlice is the last slice number in the range.
+ * \param[in]       nRules is the number of rules to set.
+ *
+ * \param[in]       valid is an array indicating whether each rule is valid.
+ *
+ * \param[in]       ruleKeys is a two dimensional array of keys, see
+ *                  ''fm10000SetFFURules''.
+ *
+ * \param[in]       actionLists is a two dimensional array of actions, see
+ *                  ''fm10000SetFFURules''.
+ *
+ * \param[in]       live indicates whether the FFU is currently running.
+ *
+ * \param[in]       useCache indicates whether using the cache is allowed.
  *
  * \return          FM_OK if successful.
- * \return          FM_ERR_FFU_RES_OWNED if this range is already owned.
+ * \return          FM_ERR_INVALID_SLICE if any parameter in slice
+ *                  is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if any other parameter is
+ *                  invalid.
  *
  *****************************************************************************/
-fm_status fm10000SetFFUSliceOwnership(fm_int          sw,
-                                      fm_ffuOwnerType owner,
-                                      fm_int          firstSlice,
-                                      fm_int          lastSlice)
+static fm_status WriteFFURules(fm_int                        sw,
+                               const fm_ffuSliceInfo *       slice,
+                               fm_uint16                     ruleIndex,
+                               fm_uint16                     nRules,
+                               const fm_bool *               valid,
+                               const fm_fm10000FfuSliceKey **ruleKeys,
+                               const fm_ffuAction **         actionLists,
+                               fm_bool                       live,
+                               fm_bool                       useCache)
 {
-    fm10000_switch *            switchExt = NULL;
-    fm_fm10000FfuOwnershipInfo *info = NULL;
-    fm_int                      slice;
-    fm_status                   err = FM_OK;
+    fm_registerSGListEntry *sgList;
+    fm_uint                 nKeySlices;
+    fm_uint                 nActionSlices;
+    fm_uint32 *             data;
+    fm_uint32 *             dataPtr;
+    fm_uint                 sgIndex;
+    fm_int                  i;
+    fm_uint                 j;
+    fm_uint32               mask[2];
+    fm_uint32               value[2];
+    fm_uint32               key32[2];
+    fm_uint32               keyInvert32[2];
+    fm_byte                 bitPair;
+    fm_regsCacheKeyValid *  keyValid;
+    fm_bool *               keyValidate;
+    fm_uint                 reg;
+    fm_cleanupListEntry *   cleanupList = NULL;
+    fm_status               err = FM_OK;
 
     FM_LOG_ENTRY( FM_LOG_CAT_FFU,
                   "sw = %d, "
-                  "owner = %d, "
-                  "firstSlice = %d, "
-                  "lastSlice = %d\n",
+                  "slice->keyStart = %u, "
+                  "slice->keyEnd = %u, "
+                  "slice->actionEnd = %u, "
+                  "ruleIndex = %u, "
+                  "nRules = %u, "
+                  "live = %s, "
+                  "useCache = %s\n",
                   sw,
-                  owner,
-                  firstSlice,
-                  lastSlice);
+                  slice->keyStart,
+                  slice->keyEnd,
+                  slice->actionEnd,
+                  ruleIndex,
+                  nRules,
+                  FM_BOOLSTRING(live),
+                  FM_BOOLSTRING(useCache) );
 
-    VALIDATE_AND_PROTECT_SWITCH(sw);
+    FM_API_REQUIRE(nRules > 0, FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(ruleIndex + nRules <= FM10000_FFU_SLICE_TCAM_ENTRIES_0,
+                   FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(slice->keyStart < FM10000_FFU_SLICE_VALID_ENTRIES,
+                   FM_ERR_INVALID_SLICE);
+    FM_API_REQUIRE(slice->keyEnd < FM10000_FFU_SLICE_VALID_ENTRIES,
+                   FM_ERR_INVALID_SLICE);
+    FM_API_REQUIRE(slice->actionEnd < FM10000_FFU_SLICE_VALID_ENTRIES,
+                   FM_ERR_INVALID_SLICE);
+    FM_API_REQUIRE(slice->keyEnd >= slice->keyStart,
+                   FM_ERR_INVALID_SLICE);
+    FM_API_REQUIRE(slice->actionEnd >= slice->keyEnd,
+                   FM_ERR_INVALID_SLICE);
 
-    if ( !fmSupportsFfu(sw) )
-    {
-        err = FM_ERR_INVALID_SWITCH_TYPE;
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
-    }
+    nKeySlices    = 1 + slice->keyEnd - slice->keyStart;
+    nActionSlices = 1 + slice->actionEnd - slice->keyEnd;
 
-    switchExt = GET_SWITCH_EXT(sw);
-    info      = &switchExt->ffuOwnershipInfo;
+    FM_ALLOC_TEMP_ARRAY(sgList,
+                        fm_registerSGListEntry,
+                        nKeySlices + nActionSlices);
 
-    FM_API_REQUIRE(firstSlice >= 0,
-                   FM_ERR_INVALID_SLICE);
-    FM_API_REQUIRE(lastSlice < FM10000_FFU_SLICE_VALID_ENTRIES,
-                   FM_ERR_INVALID_SLICE);
+    FM_ALLOC_TEMP_ARRAY( data,
+                        fm_uint32,
+                        nRules *
+                        (nKeySlices * FM10000_FFU_SLICE_TCAM_WIDTH +
+                        nActionSlices * FM10000_FFU_SLICE_SRAM_WIDTH) );
 
-    for (slice = firstSlice ; slice <= lastSlice ; slice++)
+    /* Bit0 pair and validity of each TCAM entry, slice by slice */
+    FM_ALLOC_TEMP_ARRAY(keyValid,
+                        fm_regsCacheKeyValid,
+                        nRules * nKeySlices);
+    FM_ALLOC_TEMP_ARRAY(keyValidate, fm_bool, nRules * nKeySlices);
+
+    /* Translate the key part of the rule for all the condition slices */
+    dataPtr = data;
+    for (i = 0 ; (fm_uint) i < nKeySlices ; i++)
     {
-        if ( (info->sliceOwner[slice] != FM_FFU_OWNER_NONE) &&
-             (info->sliceOwner[slice] != owner) &&
-             (owner != FM_FFU_OWNER_NONE) )
+        FM_REGS_CACHE_FILL_SGLIST(&sgList[i],
+                                  &fm10000CacheFfuSliceTcam,
+                                  nRules,
+                                  ruleIndex,
+                                  slice->keyStart + i,
+                                  FM_REGS_CACHE_INDEX_UNUSED,
+                                  dataPtr,
+                                  FALSE);
+
+        for (j = 0 ; j < nRules ; j++)
         {
-            err = FM_ERR_FFU_RES_OWNED;
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+            reg = i * nRules + j;
+
+            /* translate the 64 bit key and mask to a 32 bit array of key and
+             * mask. The lower 32 bit part is the same as the 64 bit one while
+             * the top part mainly refer to the case location. */
+            value[0] = ruleKeys[j][i].key & ruleKeys[j][i].keyMask & 0xffffffff;
+            mask[0]  = ruleKeys[j][i].keyMask & 0xffffffff;
+
+            switch (slice->caseLocation[i])
+            {
+                case FM_FFU_CASE_NOT_MAPPED:
+                    value[1] = (ruleKeys[j][i].key >> 32) & 0xff;
+                    mask[1]  = (ruleKeys[j][i].keyMask >> 32) & 0xff;
+
+                    break;
+
+                case FM_FFU_CASE_TOP_LOW_NIBBLE:
+                    value[1] = (ruleKeys[j][i].kase.value & 0xf) |
+                               ( (ruleKeys[j][i].key >> 32) & 0xf0 );
+                    mask[1]  = (ruleKeys[j][i].kase.mask & 0xf) |
+                               ( (ruleKeys[j][i].keyMask >> 32) & 0xf0 );
+
+                    break;
+
+                case FM_FFU_CASE_TOP_HIGH_NIBBLE:
+                    value[1] = ( (ruleKeys[j][i].kase.value & 0xf) << 4 ) |
+                               ( (ruleKeys[j][i].key >> 32) & 0xf );
+                    mask[1]  = ( (ruleKeys[j][i].kase.mask & 0xf) << 4 ) |
+                               ( (ruleKeys[j][i].keyMask >> 32) & 0xf );
+
+                    break;
+
+                default:
+                    err = FM_ERR_INVALID_ARGUMENT;
+                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+            }
+
+            /* FFU key matching works with Key and KeyInvert. */
+            fmGenerateCAMKey2(value,
+                              mask,
+                              key32,
+                              keyInvert32,
+                              2);
+
+            /* save the Bit0 pair from key and keyInvert in the local cache */
+            bitPair = (keyInvert32[0] & 0x1) << 1;
+            bitPair |= (key32[0] & 0x1);
+            switch ( bitPair )
+            {
+                case 0:
+                    /* Bit0 unused for lookups, key and keyInvert set to '1' */ 
+                    keyValid[reg] = FM_REGS_CACHE_KEY_AND_KEYINVERT_BOTH_0;
+                    break;
+
+                case 1:
+                    /* Bit0 of key is '1' */
+                    keyValid[reg] = FM_REGS_CACHE_KEY_IS_1;
+                    break;
+            
+                case 2:
+                    /* Bit 0 of keyInvert is '1' */
+                    keyValid[reg] = FM_REGS_CACHE_KEYINVERT_IS_1;
+                    break;
+
+                case 3:
+                default:
+                    /* this shouldn't happen, assert if it does*/
+                    FM_LOG_ABORT_ON_ASSERT(FM_LOG_CAT_FFU, 
+                                           FALSE,
+                                           err = FM_FAIL,
+                                           "WriteFFURules: unexpected CAM key "
+                                           "generated: slice %d, rule %d, bitPair %u",
+                                           i,
+                                           j,
+                                           bitPair);
+
+                    /* the following assignment is to silence the compiler */
+                    keyValid[reg] = FM_REGS_CACHE_KEY_AND_KEYINVERT_BOTH_1;
+                    break;
+
+            }  /* end switch (bitPair) */
+
+            /* Bit0 of key and keyInvert are stored in the local cache and
+             * set in the TCAM when the range is written */
+            keyValidate[reg] = valid[j];
+
+            /* Apply the translated Key and KeyInvert. */
+            FM_ARRAY_SET_FIELD(dataPtr,
+                               FM10000_FFU_SLICE_TCAM,
+                               Key,
+                               key32[0]);
+            FM_ARRAY_SET_FIELD(dataPtr,
+                               FM10000_FFU_SLICE_TCAM,
+                               KeyTop,
+                               key32[1]);
+
+            FM_ARRAY_SET_FIELD(dataPtr,
+                               FM10000_FFU_SLICE_TCAM,
+                               KeyInvert,
+                               keyInvert32[0]);
+            FM_ARRAY_SET_FIELD(dataPtr,
+                               FM10000_FFU_SLICE_TCAM,
+                               KeyTopInvert,
+                               keyInvert32[1]);
+
+            dataPtr += FM10000_FFU_SLICE_TCAM_WIDTH;
         }
     }
 
-    for (slice = firstSlice ; slice <= lastSlice ; slice++)
+    sgIndex = nKeySlices;
+
+    /* Translate the action part of the rule for all the action slices */
+    for (i = 0 ; (fm_uint) i < nActionSlices ; i++)
     {
-        info->sliceOwner[slice] = owner;
+        FM_REGS_CACHE_FILL_SGLIST(&sgList[sgIndex + i],
+                                  &fm10000CacheFfuSliceSram,
+                                  nRules,
+                                  ruleIndex,
+                                  slice->keyEnd + i,
+                                  FM_REGS_CACHE_INDEX_UNUSED,
+                                  dataPtr,
+                                  FALSE);
+
+        for (j = 0 ; j < nRules ; j++)
+        {
+            err = TranslateFFUAction(sw, &(actionLists[j][i]), dataPtr);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+
+            dataPtr += FM10000_FFU_SLICE_SRAM_WIDTH;
+        }
     }
 
+    sgIndex += nActionSlices;
+
+    /* In live mode, the target rules are invalidated before their keys
+     * and actions are written, and validated after. */
+    err = fmRegCacheWriteKeyValidRange(sw,
+                                       sgIndex,
+                                       sgList,
+                                       nKeySlices,
+                                       keyValid,
+                                       keyValidate,
+                                       FM10000_FFU_SLICE_TCAM_l_Key,
+                                       FM10000_FFU_SLICE_TCAM_l_KeyInvert,
+                                       live,
+                                       useCache);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
 
 ABORT:
-    UNPROTECT_SWITCH(sw);
+    FM_FREE_TEMP_ARRAYS();
 
     FM_LOG_EXIT(FM_LOG_CAT_FFU, err);
 
-}   /* end fm10000SetFFUSliceOwnership */
-
+}   /* end WriteFFURules */
 
 
 
 /*****************************************************************************/
-/** fm10000GetFFUSliceOwnership
+/** FreeQueuedWrite
  * \ingroup intLowlevFFU10k
  *
- * \desc            Gets the slice range ownership within the FFU.
+ * \desc            Releases a write held in the FFU write queue.
+ *
+ * \param[in]       value points to the ''fm10000_ffuQueuedWrite'' to free.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void FreeQueuedWrite(void *value)
+{
+    fm10000_ffuQueuedWrite *write = value;
+
+    if (write->ruleKey != NULL)
+    {
+        fmFree(write->ruleKey);
+    }
+
+    if (write->actionList != NULL)
+    {
+        fmFree(write->actionList);
+    }
+
+    fmFree(write);
+
+}   /* end FreeQueuedWrite */
+
+
+
+
+/*****************************************************************************/
+/** IsWriteQueueOwned
+ * \ingroup intLowlevFFU10k
+ *
+ * \desc            Tells whether the calling thread has the FFU write queue
+ *                  of a switch open.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          TRUE if writes of the calling thread must be queued.
+ * \return          FALSE if they must be written to the hardware.
+ *
+ *****************************************************************************/
+static fm_bool IsWriteQueueOwned(fm_int sw)
+{
+    fm10000_switch *         switchExt = GET_SWITCH_EXT(sw);
+    fm_fm10000FfuWriteQueue *queue     = &switchExt->ffuWriteQueue;
+
+    return ( (queue->owner != NULL) &&
+             (queue->owner == fmGetCurrentThreadId()) );
+
+}   /* end IsWriteQueueOwned */
+
+
+
+
+/*****************************************************************************/
+/** IsQueuedWritePending
+ * \ingroup intLowlevFFU10k
+ *
+ * \desc            Tells whether the FFU write queue of a switch holds a
+ *                  write to any rule of a range.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       slice points to the slice or chain of slices holding
+ *                  the rules.
+ *
+ * \param[in]       ruleIndex is the index of the first rule.
+ *
+ * \param[in]       nRules is the number of rules.
+ *
+ * \return          TRUE if a write to one of the rules is queued.
+ *
+ *****************************************************************************/
+static fm_bool IsQueuedWritePending(fm_int                 sw,
+                                    const fm_ffuSliceInfo *slice,
+                                    fm_uint16              ruleIndex,
+                                    fm_uint16              nRules)
+{
+    fm10000_switch *         switchExt = GET_SWITCH_EXT(sw);
+    fm_fm10000FfuWriteQueue *queue     = &switchExt->ffuWriteQueue;
+    const fm_ffuSliceInfo *  chainInfo;
+    fm_int                   chain;
+    fm_uint                  i;
+    void *                   value;
+
+    for (chain = 0 ; chain < queue->numChains ; chain++)
+    {
+        chainInfo = &queue->chains[chain];
+
+        if ( (slice->keyStart > chainInfo->actionEnd) ||
+             (chainInfo->keyStart > slice->actionEnd) )
+        {
+            continue;
+        }
+
+        for (i = 0 ; i < nRules ; i++)
+        {
+            if (fmTreeFind(&queue->writes,
+                           ( (fm_uint64) chain << 16 ) | (ruleIndex + i),
+                           &value) == FM_OK)
+            {
+                return TRUE;
+            }
+        }
+    }
+
+    return FALSE;
+
+}   /* end IsQueuedWritePending */
+
+
+
+
+/*****************************************************************************/
+/** FlushQueuedWrites
+ * \ingroup intLowlevFFU10k
+ *
+ * \desc            Writes everything held in the FFU write queue of a
+ *                  switch and empties it. The TCAM monitor is suspended
+ *                  once per queued slice chain. Runs of contiguous rules
+ *                  are written with a single scatter-gather write per
+ *                  chain, then the valid bit only updates are applied,
+ *                  so that new rules are in place before old ones are
+ *                  invalidated.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if there is not enough memory.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status FlushQueuedWrites(fm_int sw)
+{
+    fm10000_switch *              switchExt;
+    fm_fm10000FfuWriteQueue *     queue;
+    fm10000_ffuQueuedWrite *      write;
+    fm_treeIterator               it;
+    fm_uint64                     key;
+    void *                        value;
+    fm_bool *                     valid;
+    const fm_fm10000FfuSliceKey **ruleKeys;
+    const fm_ffuAction **         actionLists;
+    fm_int                        chain = 0;
+    fm_int                        runChain = 0;
+    fm_uint16                     ruleIndex = 0;
+    fm_uint16                     runStart = 0;
+    fm_uint16                     nRules;
+    fm_bool                       runLive = FALSE;
+    fm_bool                       runUseCache = FALSE;
+    fm_int                        numSuspended = 0;
+    fm_cleanupListEntry *         cleanupList = NULL;
+    fm_status                     err = FM_OK;
+    fm_status                     resumeErr;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_FFU, "sw = %d\n", sw);
+
+    switchExt = GET_SWITCH_EXT(sw);
+    queue     = &switchExt->ffuWriteQueue;
+
+    if (fmTreeSize(&queue->writes) == 0)
+    {
+        goto ABORT;
+    }
+
+    FM_ALLOC_TEMP_ARRAY(valid, fm_bool, FM10000_FFU_SLICE_TCAM_ENTRIES_0);
+    FM_ALLOC_TEMP_ARRAY(ruleKeys,
+                        const fm_fm10000FfuSliceKey *,
+                        FM10000_FFU_SLICE_TCAM_ENTRIES_0);
+    FM_ALLOC_TEMP_ARRAY(actionLists,
+                        const fm_ffuAction *,
+                        FM10000_FFU_SLICE_TCAM_ENTRIES_0);
+
+    /* Suspend TCAM checking once per chain for the whole flush. */
+    while (numSuspended < queue->numChains)
+    {
+        err = SuspendTcamMonitor(sw, &queue->chains[numSuspended]);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+
+        numSuspended++;
+    }
+
+    /* The tree is ordered on chain then rule index, so each run of
+     * contiguous rules sharing the same write mode goes out at once. */
+    nRules = 0;
+    fmTreeIterInit(&it, &queue->writes);
+
+    while (TRUE)
+    {
+        err = fmTreeIterNext(&it, &key, &value);
+
+        if (err == FM_ERR_NO_MORE)
+        {
+            err   = FM_OK;
+            write = NULL;
+        }
+        else
+        {
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+
+            write     = value;
+            chain     = (fm_int) (key >> 16);
+            ruleIndex = (fm_uint16) (key & 0xffff);
+        }
+
+        if ( (nRules > 0) &&
+             ( (write == NULL) ||
+               !write->setRule ||
+               (chain != runChain) ||
+               (ruleIndex != runStart + nRules) ||
+               (write->live != runLive) ||
+               (write->useCache != runUseCache) ) )
+        {
+            err = WriteFFURules(sw,
+                                &queue->chains[runChain],
+                                runStart,
+                                nRules,
+                                valid,
+                                ruleKeys,
+                                actionLists,
+                                runLive,
+                                runUseCache);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+
+            nRules = 0;
+        }
+
+        if (write == NULL)
+        {
+            break;
+        }
+
+        if (!write->setRule)
+        {
+            continue;
+        }
+
+        if (nRules == 0)
+        {
+            runChain    = chain;
+            runStart    = ruleIndex;
+            runLive     = write->live;
+            runUseCache = write->useCache;
+        }
+
+        valid[nRules]       = write->valid;
+        ruleKeys[nRules]    = write->ruleKey;
+        actionLists[nRules] = write->actionList;
+        nRules++;
+    }
+
+    /* Valid bit only updates go last. */
+    fmTreeIterInit(&it, &queue->writes);
+
+    while ( (err = fmTreeIterNext(&it, &key, &value)) == FM_OK )
+    {
+        write = value;
+
+        if (write->setRule)
+        {
+            continue;
+        }
+
+        err = SetFFURuleValid(sw,
+                              &queue->chains[key >> 16],
+                              (fm_uint16) (key & 0xffff),
+                              write->valid,
+                              write->useCache);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+    }
+
+    if (err == FM_ERR_NO_MORE)
+    {
+        err = FM_OK;
+    }
+
+ABORT:
+    while (numSuspended > 0)
+    {
+        numSuspended--;
+
+        resumeErr = ResumeTcamMonitor(sw, &queue->chains[numSuspended]);
+
+        if (err == FM_OK)
+        {
+            err = resumeErr;
+        }
+    }
+
+    /* The queue is emptied even on failure, the writes are lost. */
+    fmTreeDestroy(&queue->writes, FreeQueuedWrite);
+    fmTreeInit(&queue->writes);
+    queue->numChains = 0;
+
+    FM_FREE_TEMP_ARRAYS();
+
+    FM_LOG_EXIT(FM_LOG_CAT_FFU, err);
+
+}   /* end FlushQueuedWrites */
+
+
+
+
+/*****************************************************************************/
+/** QueueFFUWrite
+ * \ingroup intLowlevFFU10k
+ *
+ * \desc            Holds a rule write or a valid bit update in the FFU
+ *                  write queue of a switch. A rule write replaces whatever
+ *                  was queued for the same rule; a valid bit update is
+ *                  merged into it. A write to a chain overlapping another
+ *                  queued chain flushes the queue first.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       slice points to the slice or chain of slices on which
+ *                  to operate.
+ *
+ * \param[in]       ruleIndex is the index of the rule to set.
+ *
+ * \param[in]       setRule is TRUE to write the whole rule, FALSE to only
+ *                  update its valid bit.
+ *
+ * \param[in]       valid indicates whether the rule is valid.
+ *
+ * \param[in]       ruleKey is the key of the rule, unused if setRule is
+ *                  FALSE.
+ *
+ * \param[in]       actionList is the action list of the rule, unused if
+ *                  setRule is FALSE.
+ *
+ * \param[in]       live indicates whether the FFU is currently running.
+ *
+ * \param[in]       useCache indicates whether using the cache is allowed.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if there is not enough memory.
+ * \return          FM_ERR_INVALID_SLICE if any parameter in slice
+ *                  is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if ruleIndex is invalid.
+ *
+ *****************************************************************************/
+static fm_status QueueFFUWrite(fm_int                       sw,
+                               const fm_ffuSliceInfo *      slice,
+                               fm_uint16                    ruleIndex,
+                               fm_bool                      setRule,
+                               fm_bool                      valid,
+                               const fm_fm10000FfuSliceKey *ruleKey,
+                               const fm_ffuAction *         actionList,
+                               fm_bool                      live,
+                               fm_bool                      useCache)
+{
+    fm10000_switch *         switchExt;
+    fm_fm10000FfuWriteQueue *queue;
+    fm_ffuSliceInfo *        chainInfo;
+    fm10000_ffuQueuedWrite * write = NULL;
+    fm_uint                  nKeySlices;
+    fm_uint                  nActionSlices;
+    fm_int                   chain;
+    fm_uint64                key;
+    void *                   value;
+    fm_status                err = FM_OK;
+
+    FM_LOG_ENTRY( FM_LOG_CAT_FFU,
+                  "sw = %d, "
+                  "slice->keyStart = %u, "
+                  "ruleIndex = %u, "
+                  "setRule = %s, "
+                  "valid = %s\n",
+                  sw,
+                  slice->keyStart,
+                  ruleIndex,
+                  FM_BOOLSTRING(setRule),
+                  FM_BOOLSTRING(valid) );
+
+    FM_API_REQUIRE(ruleIndex < FM10000_FFU_SLICE_TCAM_ENTRIES_0,
+                   FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(slice->keyStart < FM10000_FFU_SLICE_VALID_ENTRIES,
+                   FM_ERR_INVALID_SLICE);
+    FM_API_REQUIRE(slice->keyEnd < FM10000_FFU_SLICE_VALID_ENTRIES,
+                   FM_ERR_INVALID_SLICE);
+    FM_API_REQUIRE(slice->actionEnd < FM10000_FFU_SLICE_VALID_ENTRIES,
+                   FM_ERR_INVALID_SLICE);
+    FM_API_REQUIRE(slice->keyEnd >= slice->keyStart,
+                   FM_ERR_INVALID_SLICE);
+    FM_API_REQUIRE(slice->actionEnd >= slice->keyEnd,
+                   FM_ERR_INVALID_SLICE);
+
+    switchExt     = GET_SWITCH_EXT(sw);
+    queue         = &switchExt->ffuWriteQueue;
+    nKeySlices    = 1 + slice->keyEnd - slice->keyStart;
+    nActionSlices = 1 + slice->actionEnd - slice->keyEnd;
+
+    /* Find the queued chain. Valid bit updates do not depend on the case
+     * location, which callers may leave unset. */
+    for (chain = 0 ; chain < queue->numChains ; chain++)
+    {
+        chainInfo = &queue->chains[chain];
+
+        if ( (chainInfo->keyStart == slice->keyStart) &&
+             (chainInfo->keyEnd == slice->keyEnd) &&
+             (chainInfo->actionEnd == slice->actionEnd) &&
+             ( !setRule ||
+               (memcmp(chainInfo->caseLocation,
+                       slice->caseLocation,
+                       nKeySlices * sizeof(fm_ffuCaseLocation)) == 0) ) )
+        {
+            break;
+        }
+
+        if ( (slice->keyStart <= chainInfo->actionEnd) &&
+             (chainInfo->keyStart <= slice->actionEnd) )
+        {
+            /* The chains overlap, write out what is queued so the
+             * hardware sees both in the order they were made. */
+            err = FlushQueuedWrites(sw);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+
+            chain = 0;
+            break;
+        }
+    }
+
+    if (chain >= queue->numChains)
+    {
+        chain     = queue->numChains++;
+        chainInfo = &queue->chains[chain];
+
+        *chainInfo         = *slice;
+        chainInfo->selects = NULL;
+
+        FM_CLEAR(queue->chainCase[chain]);
+
+        if (slice->caseLocation != NULL)
+        {
+            FM_MEMCPY_S(queue->chainCase[chain],
+                        sizeof(queue->chainCase[chain]),
+                        slice->caseLocation,
+                        nKeySlices * sizeof(fm_ffuCaseLocation));
+        }
+
+        chainInfo->caseLocation = queue->chainCase[chain];
+    }
+
+    key = ( (fm_uint64) chain << 16 ) | ruleIndex;
+
+    err = fmTreeFind(&queue->writes, key, &value);
+
+    if (err == FM_OK)
+    {
+        if (!setRule)
+        {
+            write        = value;
+            write->valid = valid;
+
+            if (!write->setRule)
+            {
+                write->useCache = useCache;
+            }
+
+            goto ABORT;
+        }
+
+        err = fmTreeRemoveCertain(&queue->writes, key, FreeQueuedWrite);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+    }
+    else if (err != FM_ERR_NOT_FOUND)
+    {
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+    }
+
+    write = fmAlloc( sizeof(fm10000_ffuQueuedWrite) );
+    if (write == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+    }
+
+    FM_CLEAR(*write);
+
+    write->setRule  = setRule;
+    write->valid    = valid;
+    write->live     = live;
+    write->useCache = useCache;
+
+    if (setRule)
+    {
+        write->ruleKey    = fmAlloc(nKeySlices * sizeof(fm_fm10000FfuSliceKey));
+        write->actionList = fmAlloc(nActionSlices * sizeof(fm_ffuAction));
+
+        if ( (write->ruleKey == NULL) || (write->actionList == NULL) )
+        {
+            err = FM_ERR_NO_MEM;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+        }
+
+        FM_MEMCPY_S(write->ruleKey,
+                    nKeySlices * sizeof(fm_fm10000FfuSliceKey),
+                    ruleKey,
+                    nKeySlices * sizeof(fm_fm10000FfuSliceKey));
+        FM_MEMCPY_S(write->actionList,
+                    nActionSlices * sizeof(fm_ffuAction),
+                    actionList,
+                    nActionSlices * sizeof(fm_ffuAction));
+    }
+
+    err = fmTreeInsert(&queue->writes, key, write);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+
+    write = NULL;
+
+ABORT:
+    if ( (err != FM_OK) && (write != NULL) )
+    {
+        FreeQueuedWrite(write);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_FFU, err);
+
+}   /* end QueueFFUWrite */
+
+
+
+
+/*****************************************************************************/
+/** CountSliceMapRuns
+ * \ingroup intLowlevFFU10k
+ *
+ * \desc            Fills the counters of a slice map from its row bitmap.
+ *
+ * \param[in,out]   sliceMap points to the slice map whose usedRows bitmap
+ *                  is already filled. Its counters must be zero.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void CountSliceMapRuns(fm_ffuSliceMap *sliceMap)
+{
+    fm_int  row;
+    fm_int  runStart;
+    fm_int  runLength;
+    fm_bool seenUsed;
+
+    runStart = -1;
+    seenUsed = FALSE;
+
+    /* Walk one row past the end so that a trailing free run gets closed. */
+    for (row = 0 ; row <= FM10000_FFU_ENTRIES_PER_SLICE ; row++)
+    {
+        if ( (row < FM10000_FFU_ENTRIES_PER_SLICE) &&
+             ( (sliceMap->usedRows[row / 64] & (FM_LITERAL_U64(1) << (row % 64))) == 0 ) )
+        {
+            if (runStart < 0)
+            {
+                runStart = row;
+            }
+            continue;
+        }
+
+        if (runStart >= 0)
+        {
+            runLength = row - runStart;
+
+            sliceMap->freeRules += runLength;
+            sliceMap->freeRuns++;
+
+            if (runLength > sliceMap->largestFreeBlock)
+            {
+                sliceMap->largestFreeBlock = runLength;
+            }
+
+            /* Only runs bounded by used rows on both sides are holes. */
+            if ( seenUsed && (row < FM10000_FFU_ENTRIES_PER_SLICE) )
+            {
+                sliceMap->holes++;
+                sliceMap->holeRules += runLength;
+            }
+
+            runStart = -1;
+        }
+
+        if (row < FM10000_FFU_ENTRIES_PER_SLICE)
+        {
+            sliceMap->usedRules++;
+            seenUsed = TRUE;
+        }
+    }
+
+}   /* end CountSliceMapRuns */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** fm10000SetFFUSliceOwnership
+ * \ingroup intLowlevFFU10k
+ *
+ * \desc            Sets the slice range ownership within the FFU.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       owner represents a valid software component.
+ *
+ * \param[in]       firstSlice is the first slice number in the range.
+ *
+ * \param[in]       lastSlice is the last slice number in the range.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_FFU_RES_OWNED if this range is already owned.
+ *
+ *****************************************************************************/
+fm_status fm10000SetFFUSliceOwnership(fm_int          sw,
+                                      fm_ffuOwnerType owner,
+                                      fm_int          firstSlice,
+                                      fm_int          lastSlice)
+{
+    fm10000_switch *            switchExt = NULL;
+    fm_fm10000FfuOwnershipInfo *info = NULL;
+    fm_int                      slice;
+    fm_status                   err = FM_OK;
+
+    FM_LOG_ENTRY( FM_LOG_CAT_FFU,
+                  "sw = %d, "
+                  "owner = %d, "
+                  "firstSlice = %d, "
+                  "lastSlice = %d\n",
+                  sw,
+                  owner,
+                  firstSlice,
+                  lastSlice);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    if ( !fmSupportsFfu(sw) )
+    {
+        err = FM_ERR_INVALID_SWITCH_TYPE;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+    }
+
+    switchExt = GET_SWITCH_EXT(sw);
+    info      = &switchExt->ffuOwnershipInfo;
+
+    FM_API_REQUIRE(firstSlice >= 0,
+                   FM_ERR_INVALID_SLICE);
+    FM_API_REQUIRE(lastSlice < FM10000_FFU_SLICE_VALID_ENTRIES,
+                   FM_ERR_INVALID_SLICE);
+
+    for (slice = firstSlice ; slice <= lastSlice ; slice++)
+    {
+        if ( (info->sliceOwner[slice] != FM_FFU_OWNER_NONE) &&
+             (info->sliceOwner[slice] != owner) &&
+             (owner != FM_FFU_OWNER_NONE) )
+        {
+            err = FM_ERR_FFU_RES_OWNED;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+        }
+    }
+
+    for (slice = firstSlice ; slice <= lastSlice ; slice++)
+    {
+        info->sliceOwner[slice] = owner;
+    }
+
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_FFU, err);
+
+}   /* end fm10000SetFFUSliceOwnership */
+
+
+
+
+/*****************************************************************************/
+/** fm10000GetFFUSliceOwnership
+ * \ingroup intLowlevFFU10k
+ *
+ * \desc            Gets the slice range ownership within the FFU.
  *
  * \note            This assumes there is a single, contiguous slice range.
  *
@@ -1251,7 +2153,184 @@ ABORT:
 
 
 
- 
+
+/*****************************************************************************/
+/** fm10000GetFFUSliceMap
+ * \ingroup intLowlevFFU10k
+ *
+ * \desc            Returns the row occupancy of one FFU slice along with its
+ *                  owner, free runs, holes and largest free block. The rows
+ *                  used are reported by the slice owner so that rules that
+ *                  are placed but currently disabled count as used.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       slice is the slice number.
+ *
+ * \param[out]      sliceMap points to caller-allocated storage where this
+ *                  function places the slice map.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SLICE if slice is out of range.
+ * \return          FM_ERR_INVALID_ARGUMENT if sliceMap is NULL.
+ * \return          FM_ERR_UNSUPPORTED if the slice owner does not track its
+ *                  rows.
+ *
+ *****************************************************************************/
+fm_status fm10000GetFFUSliceMap(fm_int          sw,
+                                fm_int          slice,
+                                fm_ffuSliceMap *sliceMap)
+{
+    fm_switch *     switchPtr;
+    fm10000_switch *switchExt;
+    fm_status       err = FM_OK;
+
+    FM_LOG_ENTRY( FM_LOG_CAT_FFU,
+                  "sw = %d, "
+                  "slice = %d, "
+                  "sliceMap = %p\n",
+                  sw,
+                  slice,
+                  (void *) sliceMap);
+
+    if ( !fmSupportsFfu(sw) )
+    {
+        err = FM_ERR_INVALID_SWITCH_TYPE;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+    }
+
+    FM_API_REQUIRE(slice >= 0,
+                   FM_ERR_INVALID_SLICE);
+    FM_API_REQUIRE(slice < FM10000_FFU_SLICE_VALID_ENTRIES,
+                   FM_ERR_INVALID_SLICE);
+    FM_API_REQUIRE(sliceMap, FM_ERR_INVALID_ARGUMENT);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    switchExt = GET_SWITCH_EXT(sw);
+
+    FM_CLEAR(*sliceMap);
+    sliceMap->owner = switchExt->ffuOwnershipInfo.sliceOwner[slice];
+
+    switch (sliceMap->owner)
+    {
+        case FM_FFU_OWNER_NONE:
+            break;
+
+        case FM_FFU_OWNER_ACL:
+            FM_TAKE_ACL_LOCK(sw);
+            err = fm10000GetAclFFUSliceRows(sw, slice, sliceMap->usedRows);
+            FM_DROP_ACL_LOCK(sw);
+            break;
+
+        case FM_FFU_OWNER_ROUTING:
+            fmCaptureReadLock(&switchPtr->routingLock, FM_WAIT_FOREVER);
+            err = fm10000GetRouteFFUSliceRows(sw, slice, sliceMap->usedRows);
+            fmReleaseReadLock(&switchPtr->routingLock);
+            break;
+
+        default:
+            err = FM_ERR_UNSUPPORTED;
+            break;
+    }
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+
+    CountSliceMapRuns(sliceMap);
+
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_FFU, err);
+
+}   /* end fm10000GetFFUSliceMap */
+
+
+
+
+/*****************************************************************************/
+/** fm10000DefragmentFFU
+ * \ingroup intLowlevFFU10k
+ *
+ * \desc            Compacts the rules of one FFU owner so that the free rows
+ *                  of its slices merge into contiguous blocks. Rules keep
+ *                  their relative order, so lookups are not affected. At
+ *                  most budget rules are moved per call; the caller repeats
+ *                  the call until numMoved is zero.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       owner is the FFU owner whose slices are compacted.
+ *
+ * \param[in]       budget is the maximum number of rules to move.
+ *
+ * \param[out]      numMoved points to caller-allocated storage where this
+ *                  function places the number of rules moved.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if budget is negative or
+ *                  numMoved is NULL.
+ * \return          FM_ERR_UNSUPPORTED if owner cannot be compacted.
+ *
+ *****************************************************************************/
+fm_status fm10000DefragmentFFU(fm_int          sw,
+                               fm_ffuOwnerType owner,
+                               fm_int          budget,
+                               fm_int *        numMoved)
+{
+    fm_switch *switchPtr;
+    fm_status  err = FM_OK;
+
+    FM_LOG_ENTRY( FM_LOG_CAT_FFU,
+                  "sw = %d, "
+                  "owner = %d, "
+                  "budget = %d, "
+                  "numMoved = %p\n",
+                  sw,
+                  owner,
+                  budget,
+                  (void *) numMoved);
+
+    if ( !fmSupportsFfu(sw) )
+    {
+        err = FM_ERR_INVALID_SWITCH_TYPE;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+    }
+
+    FM_API_REQUIRE(budget >= 0, FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(numMoved, FM_ERR_INVALID_ARGUMENT);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    *numMoved = 0;
+
+    switch (owner)
+    {
+        case FM_FFU_OWNER_ACL:
+            FM_TAKE_ACL_LOCK(sw);
+            err = fm10000DefragmentAclFFU(sw, budget, numMoved);
+            FM_DROP_ACL_LOCK(sw);
+            break;
+
+        case FM_FFU_OWNER_ROUTING:
+            fmCaptureWriteLock(&switchPtr->routingLock, FM_WAIT_FOREVER);
+            err = fm10000DefragmentRouteFFU(sw, budget, numMoved);
+            fmReleaseWriteLock(&switchPtr->routingLock);
+            break;
+
+        default:
+            err = FM_ERR_UNSUPPORTED;
+            break;
+    }
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_FFU, err);
+
+}   /* end fm10000DefragmentFFU */
+
+
+
+
 /*****************************************************************************/
 /** fm10000FFUInit
  * \ingroup intLowlevFFU10k
@@ -1304,6 +2383,13 @@ fm_status fm10000FFUInit(fm_int sw)
         sliceInfo.actionEnd = slice;
         sliceInfo.caseLocation = &caseLocation;
 
+        /* Queue the slice so it is written in a single pass. */
+        err = fm10000StartFFUWriteQueue(sw);
+        if (err != FM_OK)
+        {
+            goto ABORT;
+        }
+
         for (rule = 0 ; rule < FM10000_FFU_SLICE_TCAM_ENTRIES_0 ; rule++)
         {
             err = fm10000SetFFURule(sw,
@@ -1316,10 +2402,17 @@ fm_status fm10000FFUInit(fm_int sw)
                                     FALSE);
             if (err != FM_OK)
             {
+                fm10000FlushFFUWriteQueue(sw);
                 goto ABORT;
             }
         }
 
+        err = fm10000FlushFFUWriteQueue(sw);
+        if (err != FM_OK)
+        {
+            goto ABORT;
+        }
+
         /* Force FFU_SLICE_VALID to always match for all scenarios */
         err = fmRegCacheWriteSingle1D(sw, 
                                       &fm10000CacheFfuSliceValid,
@@ -1328,13 +2421,147 @@ fm_status fm10000FFUInit(fm_int sw)
                                       FALSE);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
     }
-#endif
+#endif
+
+ABORT:
+
+    return err;
+
+}   /* end fm10000FFUInit */
+
+
+
+
+/*****************************************************************************/
+/** fm10000StartFFUWriteQueue
+ * \ingroup intLowlevFFU10k
+ *
+ * \desc            Opens the FFU write queue of a switch for the calling
+ *                  thread. Until the matching ''fm10000FlushFFUWriteQueue'',
+ *                  the rules and valid bits this thread sets through
+ *                  ''fm10000SetFFURule'', ''fm10000SetFFURules'' and
+ *                  ''fm10000SetFFURuleValid'' are held back, then written
+ *                  with one TCAM monitor suspension and one scatter-gather
+ *                  write per run of contiguous rules of each slice chain.
+ *                  Any other FFU function called by this thread writes the
+ *                  queue out first. Calls may be nested.
+ *                                                                      \lb\lb
+ *                  Writes of other threads are not queued. If another
+ *                  thread has the queue open, this call does nothing.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_SWITCH_TYPE if sw does not support this API.
+ *
+ *****************************************************************************/
+fm_status fm10000StartFFUWriteQueue(fm_int sw)
+{
+    fm10000_switch *         switchExt;
+    fm_fm10000FfuWriteQueue *queue;
+    void *                   self;
+    fm_status                err = FM_OK;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_FFU, "sw = %d\n", sw);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    if ( !fmSupportsFfu(sw) )
+    {
+        err = FM_ERR_INVALID_SWITCH_TYPE;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+    }
+
+    switchExt = GET_SWITCH_EXT(sw);
+    queue     = &switchExt->ffuWriteQueue;
+    self      = fmGetCurrentThreadId();
+
+    TAKE_REG_LOCK(sw);
+
+    if (queue->owner == self)
+    {
+        queue->depth++;
+    }
+    else if (queue->owner == NULL)
+    {
+        fmTreeInit(&queue->writes);
+
+        queue->numChains = 0;
+        queue->owner     = self;
+        queue->depth     = 1;
+    }
+
+    DROP_REG_LOCK(sw);
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_FFU, err);
+
+}   /* end fm10000StartFFUWriteQueue */
+
+
+
+
+/*****************************************************************************/
+/** fm10000FlushFFUWriteQueue
+ * \ingroup intLowlevFFU10k
+ *
+ * \desc            Closes the FFU write queue opened by
+ *                  ''fm10000StartFFUWriteQueue''. When the outermost queue
+ *                  is closed, the queued rule writes are applied first and
+ *                  the queued valid bit updates after them. Must also be
+ *                  called on error paths, the queued writes are then still
+ *                  applied.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_SWITCH_TYPE if sw does not support this API.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure to write the queued rules.
+ *
+ *****************************************************************************/
+fm_status fm10000FlushFFUWriteQueue(fm_int sw)
+{
+    fm10000_switch *         switchExt;
+    fm_fm10000FfuWriteQueue *queue;
+    fm_status                err = FM_OK;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_FFU, "sw = %d\n", sw);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    if ( !fmSupportsFfu(sw) )
+    {
+        err = FM_ERR_INVALID_SWITCH_TYPE;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+    }
+
+    switchExt = GET_SWITCH_EXT(sw);
+    queue     = &switchExt->ffuWriteQueue;
+
+    if ( !IsWriteQueueOwned(sw) || (--queue->depth > 0) )
+    {
+        goto ABORT;
+    }
+
+    err = FlushQueuedWrites(sw);
+
+    fmTreeDestroy(&queue->writes, FreeQueuedWrite);
+
+    TAKE_REG_LOCK(sw);
+    queue->owner = NULL;
+    DROP_REG_LOCK(sw);
 
 ABORT:
+    UNPROTECT_SWITCH(sw);
 
-    return err;
+    FM_LOG_EXIT(FM_LOG_CAT_FFU, err);
 
-}   /* end fm10000FFUInit */
+}   /* end fm10000FlushFFUWriteQueue */
 
 
 
@@ -1435,6 +2662,13 @@ fm_status fm10000MoveFFURules(fm_int                 sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
     }
 
+    /* Queued rule writes must reach the hardware first. */
+    if ( IsWriteQueueOwned(sw) )
+    {
+        err = FlushQueuedWrites(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+    }
+
     /* slice pointer must be valid */
     FM_API_REQUIRE(slice != NULL, FM_ERR_INVALID_ARGUMENT);
 
@@ -1529,6 +2763,11 @@ fm_status fm10000MoveFFURules(fm_int                 sw,
     TAKE_REG_LOCK(sw);   /* make access atomic */
     TAKE_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
     regLockTaken = TRUE;
+
+    /* The TCAM cache is updated in place below, bypassing the running
+     * checksums, so have the monitors recompute them in full. */
+    fmRegCacheInvalidateChecksums(sw, &fm10000CacheFfuSliceTcam);
+
     /* Process each rule and update all slice (condition + action) */
     for (i = 0 ; i < nRules ; i++)
     {
@@ -1731,6 +2970,13 @@ fm_status fm10000SetFFUMasterValid(fm_int    sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
     }
 
+    /* Queued rule writes must reach the hardware first. */
+    if ( IsWriteQueueOwned(sw) )
+    {
+        err = FlushQueuedWrites(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+    }
+
     FM_ARRAY_SET_FIELD(value, FM10000_FFU_MASTER_VALID, SliceValid, validIngress);
     FM_ARRAY_SET_FIELD(value, FM10000_FFU_MASTER_VALID, ChunkValid, validEgress);
 
@@ -1899,6 +3145,13 @@ fm_status fm10000ConfigureFFUSlice(fm_int                 sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
     }
 
+    /* Queued rule writes must reach the hardware first. */
+    if ( IsWriteQueueOwned(sw) )
+    {
+        err = FlushQueuedWrites(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+    }
+
     FM_API_REQUIRE(slice->keyStart < FM10000_FFU_SLICE_VALID_ENTRIES,
                    FM_ERR_INVALID_SLICE);
     FM_API_REQUIRE(slice->keyEnd < FM10000_FFU_SLICE_VALID_ENTRIES,
@@ -2136,6 +3389,13 @@ fm_status fm10000UnconfigureFFUSlice(fm_int                 sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
     }
 
+    /* Queued rule writes must reach the hardware first. */
+    if ( IsWriteQueueOwned(sw) )
+    {
+        err = FlushQueuedWrites(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+    }
+
     FM_API_REQUIRE(slice->keyStart < FM10000_FFU_SLICE_VALID_ENTRIES,
                    FM_ERR_INVALID_SLICE);
     FM_API_REQUIRE(slice->keyEnd < FM10000_FFU_SLICE_VALID_ENTRIES,
@@ -2361,6 +3621,20 @@ fm_status fm10000SetFFURule(fm_int                       sw,
     FM_API_REQUIRE(slice->actionEnd >= slice->keyEnd,
                    FM_ERR_INVALID_SLICE);
 
+    if ( IsWriteQueueOwned(sw) )
+    {
+        err = QueueFFUWrite(sw,
+                            slice,
+                            ruleIndex,
+                            TRUE,
+                            valid,
+                            ruleKey,
+                            actionList,
+                            live,
+                            useCache);
+        goto ABORT;
+    }
+
     nKeySlices    = 1 + slice->keyEnd - slice->keyStart;
     nActionSlices = 1 + slice->actionEnd - slice->keyEnd;
 
@@ -2623,23 +3897,8 @@ fm_status fm10000SetFFURules(fm_int                        sw,
                              fm_bool                       live,
                              fm_bool                       useCache)
 {
-    fm_registerSGListEntry *sgList;
-    fm_uint                 nKeySlices;
-    fm_uint                 nActionSlices;
-    fm_uint32 *             data;
-    fm_uint32 *             dataPtr;
-    fm_uint                 sgIndex;
-    fm_int                  i;
-    fm_uint                 j;
-    fm_uint32               mask[2];
-    fm_uint32               value[2];
-    fm_uint32               key32[2];
-    fm_uint32               keyInvert32[2];
-    fm_byte                 bitPair;
-    fm_regsCacheKeyValid    keyValid;
-    fm_uint32               idx[FM_REGS_CACHE_MAX_INDICES];
-    fm_cleanupListEntry *   cleanupList = NULL;
-    fm_status               err = FM_OK;
+    fm_int    i;
+    fm_status err = FM_OK;
 
     FM_LOG_ENTRY( FM_LOG_CAT_FFU,
                   "sw = %d, "
@@ -2667,219 +3926,45 @@ fm_status fm10000SetFFURules(fm_int                        sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
     }
 
-    FM_API_REQUIRE(nRules > 0, FM_ERR_INVALID_ARGUMENT);
-    FM_API_REQUIRE(ruleIndex + nRules <= FM10000_FFU_SLICE_TCAM_ENTRIES_0,
-                   FM_ERR_INVALID_ARGUMENT);
-    FM_API_REQUIRE(slice->keyStart < FM10000_FFU_SLICE_VALID_ENTRIES,
-                   FM_ERR_INVALID_SLICE);
-    FM_API_REQUIRE(slice->keyEnd < FM10000_FFU_SLICE_VALID_ENTRIES,
-                   FM_ERR_INVALID_SLICE);
-    FM_API_REQUIRE(slice->actionEnd < FM10000_FFU_SLICE_VALID_ENTRIES,
-                   FM_ERR_INVALID_SLICE);
-    FM_API_REQUIRE(slice->keyEnd >= slice->keyStart,
-                   FM_ERR_INVALID_SLICE);
-    FM_API_REQUIRE(slice->actionEnd >= slice->keyEnd,
-                   FM_ERR_INVALID_SLICE);
-
-    nKeySlices    = 1 + slice->keyEnd - slice->keyStart;
-    nActionSlices = 1 + slice->actionEnd - slice->keyEnd;
-
-    FM_ALLOC_TEMP_ARRAY(sgList,
-                        fm_registerSGListEntry,
-                        nKeySlices + nActionSlices);
-
-    FM_ALLOC_TEMP_ARRAY( data,
-                        fm_uint32,
-                        nRules *
-                        (nKeySlices * FM10000_FFU_SLICE_TCAM_WIDTH +
-                        nActionSlices * FM10000_FFU_SLICE_SRAM_WIDTH) );
-
-    /* Suspend TCAM checking during update. */
-    err = SuspendTcamMonitor(sw, slice);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
-
-    /* Translate the key part of the rule for all the condition slices */
-    dataPtr = data;
-    for (i = 0 ; (fm_uint) i < nKeySlices ; i++)
+    if ( IsWriteQueueOwned(sw) )
     {
-        idx[1]  = slice->keyStart + i;
-
-        FM_REGS_CACHE_FILL_SGLIST(&sgList[i],
-                                  &fm10000CacheFfuSliceTcam,
-                                  nRules,
-                                  ruleIndex,
-                                  slice->keyStart + i,
-                                  FM_REGS_CACHE_INDEX_UNUSED,
-                                  dataPtr,
-                                  FALSE);
-
-        for (j = 0 ; j < nRules ; j++)
+        for (i = 0 ; i < nRules ; i++)
         {
-            idx[0] = ruleIndex + j;
-
-            /* translate the 64 bit key and mask to a 32 bit array of key and
-             * mask. The lower 32 bit part is the same as the 64 bit one while
-             * the top part mainly refer to the case location. */
-            value[0] = ruleKeys[j][i].key & ruleKeys[j][i].keyMask & 0xffffffff;
-            mask[0]  = ruleKeys[j][i].keyMask & 0xffffffff;
-
-            switch (slice->caseLocation[i])
-            {
-                case FM_FFU_CASE_NOT_MAPPED:
-                    value[1] = (ruleKeys[j][i].key >> 32) & 0xff;
-                    mask[1]  = (ruleKeys[j][i].keyMask >> 32) & 0xff;
-
-                    break;
-
-                case FM_FFU_CASE_TOP_LOW_NIBBLE:
-                    value[1] = (ruleKeys[j][i].kase.value & 0xf) |
-                               ( (ruleKeys[j][i].key >> 32) & 0xf0 );
-                    mask[1]  = (ruleKeys[j][i].kase.mask & 0xf) |
-                               ( (ruleKeys[j][i].keyMask >> 32) & 0xf0 );
-
-                    break;
-
-                case FM_FFU_CASE_TOP_HIGH_NIBBLE:
-                    value[1] = ( (ruleKeys[j][i].kase.value & 0xf) << 4 ) |
-                               ( (ruleKeys[j][i].key >> 32) & 0xf );
-                    mask[1]  = ( (ruleKeys[j][i].kase.mask & 0xf) << 4 ) |
-                               ( (ruleKeys[j][i].keyMask >> 32) & 0xf );
-
-                    break;
-
-                default:
-                    err = FM_ERR_INVALID_ARGUMENT;
-                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
-            }
-
-            /* FFU key matching works with Key and KeyInvert. */
-            fmGenerateCAMKey2(value,
-                              mask,
-                              key32,
-                              keyInvert32,
-                              2);
-
-            /* save the Bit0 pair from key and keyInvert in the local cache */
-            bitPair = (keyInvert32[0] & 0x1) << 1;
-            bitPair |= (key32[0] & 0x1);
-            switch ( bitPair )
-            {
-                case 0:
-                    /* Bit0 unused for lookups, key and keyInvert set to '1' */ 
-                    keyValid = FM_REGS_CACHE_KEY_AND_KEYINVERT_BOTH_0;
-                    break;
-
-                case 1:
-                    /* Bit0 of key is '1' */
-                    keyValid = FM_REGS_CACHE_KEY_IS_1;
-                    break;
-            
-                case 2:
-                    /* Bit 0 of keyInvert is '1' */
-                    keyValid = FM_REGS_CACHE_KEYINVERT_IS_1;
-                    break;
-
-                case 3:
-                default:
-                    /* this shouldn't happen, assert if it does*/
-                    FM_LOG_ABORT_ON_ASSERT(FM_LOG_CAT_FFU, 
-                                           FALSE,
-                                           err = FM_FAIL,
-                                           "fm10000SetFFURules: unexpected CAM key "
-                                           "generated: slice %d, rule %d, bitPair %u",
-                                           i,
-                                           j,
-                                           bitPair);
-
-                    /* the following assignment is to silence the compiler */
-                    keyValid = FM_REGS_CACHE_KEY_AND_KEYINVERT_BOTH_1;
-                    break;
-
-            }  /* end switch (bitPair) */
-            
-            /* save Bit0 of key and keyInvert in the local cache */
-            err = fmRegCacheWriteKeyValid(sw,
-                                          &fm10000CacheFfuSliceTcam,
-                                          idx,
-                                          keyValid);
+            err = QueueFFUWrite(sw,
+                                slice,
+                                ruleIndex + i,
+                                TRUE,
+                                valid[i],
+                                ruleKeys[i],
+                                actionLists[i],
+                                live,
+                                useCache);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
-
-            /* if the rule is invalid set Bit0 of both key and keyInvert.
-             * The rule is also invalidated if applied in live mode. */
-            if ( (valid[j] == FALSE) || (live == TRUE) )
-            {
-                key32[0] |= 0x1;
-                keyInvert32[0] |= 0x1;
-            }
-
-            /* Apply the translated Key and KeyInvert. */
-            FM_ARRAY_SET_FIELD(dataPtr,
-                               FM10000_FFU_SLICE_TCAM,
-                               Key,
-                               key32[0]);
-            FM_ARRAY_SET_FIELD(dataPtr,
-                               FM10000_FFU_SLICE_TCAM,
-                               KeyTop,
-                               key32[1]);
-
-            FM_ARRAY_SET_FIELD(dataPtr,
-                               FM10000_FFU_SLICE_TCAM,
-                               KeyInvert,
-                               keyInvert32[0]);
-            FM_ARRAY_SET_FIELD(dataPtr,
-                               FM10000_FFU_SLICE_TCAM,
-                               KeyTopInvert,
-                               keyInvert32[1]);
-
-            dataPtr += FM10000_FFU_SLICE_TCAM_WIDTH;
         }
-    }
-
-    sgIndex = nKeySlices;
-
-    /* Translate the action part of the rule for all the action slices */
-    for (i = 0 ; (fm_uint) i < nActionSlices ; i++)
-    {
-        FM_REGS_CACHE_FILL_SGLIST(&sgList[sgIndex + i],
-                                  &fm10000CacheFfuSliceSram,
-                                  nRules,
-                                  ruleIndex,
-                                  slice->keyEnd + i,
-                                  FM_REGS_CACHE_INDEX_UNUSED,
-                                  dataPtr,
-                                  FALSE);
-
-        for (j = 0 ; j < nRules ; j++)
-        {
-            err = TranslateFFUAction(sw, &(actionLists[j][i]), dataPtr);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
 
-            dataPtr += FM10000_FFU_SLICE_SRAM_WIDTH;
-        }
+        goto ABORT;
     }
 
-    sgIndex += nActionSlices;
-
-    err = fmRegCacheWrite(sw, sgIndex, sgList, useCache);
+    /* Suspend TCAM checking during update. */
+    err = SuspendTcamMonitor(sw, slice);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
 
-    /* If we are in live mode, validate all target rules */
-    if ( live == TRUE )
-    {
-        for (i = 0 ; i < nRules  ; i++ )
-        {
-            err = SetFFURuleValid(sw, slice, ruleIndex + i, valid[i], useCache);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
-        }
-
-    }   /* end if ( live == TRUE ) */
+    err = WriteFFURules(sw,
+                        slice,
+                        ruleIndex,
+                        nRules,
+                        valid,
+                        ruleKeys,
+                        actionLists,
+                        live,
+                        useCache);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
 
     /* Resume checking of FFU TCAMs. */
     err = ResumeTcamMonitor(sw, slice);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
 
 ABORT:
-    FM_FREE_TEMP_ARRAYS();
     UNPROTECT_SWITCH(sw);
 
     FM_LOG_EXIT(FM_LOG_CAT_FFU, err);
@@ -2944,6 +4029,20 @@ fm_status fm10000SetFFURuleValid(fm_int                 sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
     }
 
+    if ( IsWriteQueueOwned(sw) )
+    {
+        err = QueueFFUWrite(sw,
+                            slice,
+                            ruleIndex,
+                            FALSE,
+                            valid,
+                            NULL,
+                            NULL,
+                            FALSE,
+                            useCache);
+        goto ABORT;
+    }
+
     err = SuspendTcamMonitor(sw, slice);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
 
@@ -3138,6 +4237,14 @@ fm_status fm10000GetFFURules(fm_int                  sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
     }
 
+    /* Rules with queued writes must reach the hardware first. */
+    if ( IsWriteQueueOwned(sw) &&
+         IsQueuedWritePending(sw, slice, ruleIndex, nRules) )
+    {
+        err = FlushQueuedWrites(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+    }
+
     FM_API_REQUIRE(nRules > 0, FM_ERR_INVALID_ARGUMENT);
     FM_API_REQUIRE(ruleIndex + nRules <= FM10000_FFU_SLICE_TCAM_ENTRIES_0,
                    FM_ERR_INVALID_ARGUMENT);
@@ -3632,6 +4739,13 @@ fm_status fm10000CopyFFURules(fm_int                 sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
     }
 
+    /* Queued rule writes must reach the hardware first. */
+    if ( IsWriteQueueOwned(sw) )
+    {
+        err = FlushQueuedWrites(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FFU, err);
+    }
+
     FM_API_REQUIRE(nRules > 0, FM_ERR_INVALID_ARGUMENT);
     FM_API_REQUIRE(fromIndex + nRules <= FM10000_FFU_SLICE_TCAM_ENTRIES_0,
                    FM_ERR_INVALID_ARGUMENT);
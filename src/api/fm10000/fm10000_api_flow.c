@@ -222,6 +222,9 @@ static fm_status InitFlowApiCommon(fm_int sw)
         switchExt->flowInfo.table[i].encap = TRUE;
         switchExt->flowInfo.table[i].scenario = (FM_ACL_SCENARIO_ANY_FRAME_TYPE |
                                                  FM_ACL_SCENARIO_ANY_ROUTING_TYPE);
+        switchExt->flowInfo.table[i].defaultFlowId = -1;
+        switchExt->flowInfo.table[i].aging.scanBudget =
+            FM10000_FLOW_AGING_DEFAULT_BUDGET;
     }
 
     switchExt->flowInfo.initialized = TRUE;
@@ -2499,12 +2502,16 @@ fm_status fm10000CreateFlowTCAMTable(fm_int           sw,
         /* Install the Default rule */
         err = AddDefaultRule(sw, tableIndex, &defFlowId);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FLOW, err);
+
+        switchExt->flowInfo.table[tableIndex].defaultFlowId = defFlowId;
     }
 
     switchExt->flowInfo.table[tableIndex].type = FM_FLOW_TCAM_TABLE;
     switchExt->flowInfo.table[tableIndex].created = TRUE;
 
-    FM_LOG_EXIT(FM_LOG_CAT_FLOW, FM_OK);
+    err = fm10000UpdateFlowAging(sw, tableIndex);
+
+    FM_LOG_EXIT(FM_LOG_CAT_FLOW, err);
 
 ABORT:
 
@@ -2647,9 +2654,12 @@ fm_status fm10000DeleteFlowTCAMTable(fm_int sw,
     switchExt->flowInfo.table[tableIndex].lastCnt = NULL;
     switchExt->flowInfo.table[tableIndex].useBit = NULL;
     switchExt->flowInfo.table[tableIndex].mapping = NULL;
+    switchExt->flowInfo.table[tableIndex].defaultFlowId = -1;
 
     switchExt->flowInfo.table[tableIndex].created = FALSE;
 
+    err = fm10000UpdateFlowAging(sw, tableIndex);
+
 ABORT:
 
     FM_LOG_EXIT(FM_LOG_CAT_FLOW, err);
@@ -2857,6 +2867,8 @@ fm_status fm10000CreateFlowTETable(fm_int           sw,
     switchExt->flowInfo.table[tableIndex].type = FM_FLOW_TE_TABLE;
     switchExt->flowInfo.table[tableIndex].created = TRUE;
 
+    err = fm10000UpdateFlowAging(sw, tableIndex);
+
 ABORT:
 
     FM_LOG_EXIT(FM_LOG_CAT_FLOW, err);
@@ -2957,9 +2969,12 @@ fm_status fm10000DeleteFlowTETable(fm_int sw,
     switchExt->flowInfo.table[tableIndex].lastCnt = NULL;
     switchExt->flowInfo.table[tableIndex].useBit = NULL;
     switchExt->flowInfo.table[tableIndex].mapping = NULL;
+    switchExt->flowInfo.table[tableIndex].defaultFlowId = -1;
 
     switchExt->flowInfo.table[tableIndex].created = FALSE;
 
+    err = fm10000UpdateFlowAging(sw, tableIndex);
+
 ABORT:
 
     FM_LOG_EXIT(FM_LOG_CAT_FLOW, err);
@@ -3531,6 +3546,125 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000AddFlowList
+ * \ingroup intFlow
+ *
+ * \desc            Add a list of flow entries to the specified table.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       tableIndex is the table instance to which the flows
+ *                  should be added.
+ *
+ * \param[in]       numFlows is the number of flows in the list.
+ *
+ * \param[in,out]   flows points to an array of numFlows flows to add. The
+ *                  flowId field of each entry receives the handle of the
+ *                  flow, or -1 if the flow could not be added.
+ *
+ * \param[out]      results points to a caller-allocated array of numFlows
+ *                  entries that receives the status of each flow. May be
+ *                  NULL.
+ *
+ * \return          FM_OK if every flow was added successfully.
+ * \return          FM_ERR_INVALID_ARGUMENT if tableIndex is invalid.
+ * \return          the status of the first flow that failed, in list order,
+ *                  otherwise. See ''fm10000AddFlow''.
+ *
+ *****************************************************************************/
+fm_status fm10000AddFlowList(fm_int            sw,
+                             fm_int            tableIndex,
+                             fm_int            numFlows,
+                             fm_flowListEntry *flows,
+                             fm_status *       results)
+{
+    fm_status       err = FM_OK;
+    fm_status       flowErr;
+    fm10000_switch *switchExt;
+    fm_bool         teBatch = FALSE;
+    fm_int          i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_FLOW,
+                 "sw = %d, tableIndex = %d, numFlows = %d, flows = %p, "
+                 "results = %p\n",
+                 sw,
+                 tableIndex,
+                 numFlows,
+                 (void *) flows,
+                 (void *) results);
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    if ( (tableIndex >= FM_FLOW_MAX_TABLE_TYPE) || (tableIndex < 0) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_FLOW, err);
+    }
+
+    /* TE lookup and data entries are independent from one flow to the
+     * other. Their writes are held back and issued together, so that data
+     * blocks allocated one after the other and the lookup entries pointing
+     * to them go out as multi-word bursts. */
+    if (switchExt->flowInfo.table[tableIndex].type == FM_FLOW_TE_TABLE)
+    {
+        err = fm10000TunnelBeginWriteBatch(sw);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_FLOW, err);
+
+        teBatch = TRUE;
+    }
+
+    for (i = 0 ; i < numFlows ; i++)
+    {
+        flowErr = fm10000AddFlow(sw,
+                                 tableIndex,
+                                 flows[i].priority,
+                                 flows[i].precedence,
+                                 flows[i].condition,
+                                 &flows[i].condVal,
+                                 flows[i].action,
+                                 &flows[i].param,
+                                 flows[i].flowState,
+                                 &flows[i].flowId);
+
+        if (flowErr != FM_OK)
+        {
+            flows[i].flowId = -1;
+
+            if (err == FM_OK)
+            {
+                err = flowErr;
+            }
+        }
+
+        if (results != NULL)
+        {
+            results[i] = flowErr;
+        }
+    }
+
+    if (teBatch)
+    {
+        flowErr = fm10000TunnelEndWriteBatch(sw);
+
+        if (flowErr != FM_OK)
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_FLOW,
+                         "Unable to write the TE entries of the flow list: "
+                         "%s\n",
+                         fmErrorMsg(flowErr));
+            err = flowErr;
+        }
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_FLOW, err);
+
+}   /* end fm10000AddFlowList */
+
+
+
+
+
 /*****************************************************************************/
 /** fm10000GetFlow
  * \ingroup intFlow
@@ -4878,6 +5012,8 @@ fm_status fm10000DeleteFlow(fm_int sw, fm_int tableIndex, fm_int flowId)
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FLOW, err);
     }
 
+    fm10000ResetFlowAgingEntry(sw, tableIndex, flowId);
+
 ABORT:
 
     FM_LOG_EXIT(FM_LOG_CAT_FLOW, err);
@@ -5452,6 +5588,29 @@ fm_status fm10000SetFlowAttribute(fm_int sw,
             }
             break;
 
+        case FM_FLOW_TABLE_AGING_TIMEOUT:
+            switchExt->flowInfo.table[tableIndex].aging.timeout =
+                *( (fm_uint32 *) value );
+            err = fm10000UpdateFlowAging(sw, tableIndex);
+            break;
+
+        case FM_FLOW_TABLE_AGING_AUTO_DELETE:
+            switchExt->flowInfo.table[tableIndex].aging.autoDelete =
+                *( (fm_bool *) value );
+            err = FM_OK;
+            break;
+
+        case FM_FLOW_TABLE_AGING_SCAN_BUDGET:
+            if ( *( (fm_uint32 *) value ) == 0 )
+            {
+                err = FM_ERR_INVALID_ARGUMENT;
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FLOW, err);
+            }
+            switchExt->flowInfo.table[tableIndex].aging.scanBudget =
+                *( (fm_uint32 *) value );
+            err = FM_OK;
+            break;
+
         default:
             err = FM_ERR_UNSUPPORTED;
             break;
@@ -5580,6 +5739,21 @@ fm_status fm10000GetFlowAttribute(fm_int sw,
                 switchExt->flowInfo.table[tableIndex].scenario;
             break;
 
+        case FM_FLOW_TABLE_AGING_TIMEOUT:
+            *( (fm_uint32 *) value ) =
+                switchExt->flowInfo.table[tableIndex].aging.timeout;
+            break;
+
+        case FM_FLOW_TABLE_AGING_AUTO_DELETE:
+            *( (fm_bool *) value ) =
+                switchExt->flowInfo.table[tableIndex].aging.autoDelete;
+            break;
+
+        case FM_FLOW_TABLE_AGING_SCAN_BUDGET:
+            *( (fm_uint32 *) value ) =
+                switchExt->flowInfo.table[tableIndex].aging.scanBudget;
+            break;
+
         case FM_FLOW_TABLE_CONDITION:
             *( (fm_flowCondition *) value ) =
                 switchExt->flowInfo.table[tableIndex].condition;
@@ -6009,6 +6183,8 @@ fm_status fm10000FreeFlowResource(fm_int sw)
     {
         for (i = 0 ; i < FM_FLOW_MAX_TABLE_TYPE ; i++)
         {
+            fm10000FreeFlowAging(sw, i);
+
             if (switchExt->flowInfo.table[i].lastCnt)
             {
                 fmFree(switchExt->flowInfo.table[i].lastCnt);
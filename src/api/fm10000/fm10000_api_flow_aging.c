@@ -0,0 +1,647 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm10000_api_flow_aging.c
+ * Creation Date:   October 15, 2026
+ * Description:     FM10000 flow aging engine.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <fm_sdk_fm10000_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* Number of scan ticks per idle timeout. A flow is reported at most one
+ * tick period after it became idle for the timeout. */
+#define FM10000_FLOW_AGING_TICKS_PER_TIMEOUT  4
+
+/* Shortest tick period, in milliseconds. */
+#define FM10000_FLOW_AGING_MIN_TICK_MSEC      10
+
+/* Number of flows whose counters are read together. The scan budget is
+ * checked after each batch. */
+#define FM10000_FLOW_AGING_BATCH              64
+
+/* Idle flows waiting to be reported in one event. */
+typedef struct _fm10000_flowAgedBatch
+{
+    fm_int  numFlows;
+    fm_int  flowIds[FM_FLOW_AGED_EVENT_BURST];
+    fm_bool deleted;
+
+} fm10000_flowAgedBatch;
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Local function prototypes.
+ *****************************************************************************/
+
+static void HandleFlowAgingTimer(void *arg);
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** StartFlowAgingTimer
+ * \ingroup intFlow
+ *
+ * \desc            Arms the aging timer of a flow table for its next tick.
+ *
+ * \note            The caller has taken the flow lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       tableIndex is the flow table.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status StartFlowAgingTimer(fm_int sw, fm_int tableIndex)
+{
+    fm10000_switch        *switchExt;
+    fm10000_flowAgingInfo *aging;
+    fm_timestamp           tick;
+    fm_uint32              period;
+    fm_status              err;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    aging     = &switchExt->flowInfo.table[tableIndex].aging;
+
+    period = aging->timeout / FM10000_FLOW_AGING_TICKS_PER_TIMEOUT;
+    if (period < FM10000_FLOW_AGING_MIN_TICK_MSEC)
+    {
+        period = FM10000_FLOW_AGING_MIN_TICK_MSEC;
+    }
+
+    tick.sec  = period / 1000;
+    tick.usec = (period % 1000) * 1000;
+
+    err = fmStartTimer(aging->timer,
+                       &tick,
+                       1,
+                       HandleFlowAgingTimer,
+                       aging);
+
+    return err;
+
+}   /* end StartFlowAgingTimer */
+
+
+
+
+/*****************************************************************************/
+/** ReadFlowPktCounts
+ * \ingroup intFlow
+ *
+ * \desc            Reads the frame counters of a batch of flows. TE tables
+ *                  read their counters in blocks through the tunnel layer;
+ *                  TCAM tables read the counter of each flow's ACL rule.
+ *
+ * \note            The caller has taken the flow lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       tableIndex is the flow table.
+ *
+ * \param[in]       numFlows is the number of flows in the batch.
+ *
+ * \param[in]       flowIds points to the IDs of the flows.
+ *
+ * \param[out]      pkts points to an array of numFlows elements that
+ *                  receives the frame count of each flow.
+ *
+ * \param[out]      valid points to an array of numFlows elements that is
+ *                  set to FALSE for flows without a counter.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status ReadFlowPktCounts(fm_int     sw,
+                                   fm_int     tableIndex,
+                                   fm_int     numFlows,
+                                   fm_int *   flowIds,
+                                   fm_uint64 *pkts,
+                                   fm_bool *  valid)
+{
+    fm10000_switch        *switchExt;
+    fm10000_flowTableInfo *table;
+    fm_aclCounters         aclCounters;
+    fm_status              err = FM_OK;
+    fm_int                 i;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    table     = &switchExt->flowInfo.table[tableIndex];
+
+    if (table->type == FM_FLOW_TE_TABLE)
+    {
+        err = fm10000GetTunnelRuleCountList(sw,
+                                            table->group,
+                                            numFlows,
+                                            flowIds,
+                                            pkts,
+                                            valid);
+    }
+    else
+    {
+        for (i = 0 ; i < numFlows ; i++)
+        {
+            /* Flows without a count action are never aged. */
+            valid[i] = (fmGetACLCountExt(sw,
+                                         FM10000_FLOW_BASE_ACL + tableIndex,
+                                         table->mapping[flowIds[i]],
+                                         &aclCounters) == FM_OK);
+            pkts[i] = valid[i] ? aclCounters.cntPkts : 0;
+        }
+    }
+
+    return err;
+
+}   /* end ReadFlowPktCounts */
+
+
+
+
+/*****************************************************************************/
+/** SendFlowAgedEvent
+ * \ingroup intFlow
+ *
+ * \desc            Reports a batch of idle flows to the application and
+ *                  empties the batch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       tableIndex is the flow table.
+ *
+ * \param[in,out]   batch points to the batch to report.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void SendFlowAgedEvent(fm_int                 sw,
+                              fm_int                 tableIndex,
+                              fm10000_flowAgedBatch *batch)
+{
+    fm_event         *event;
+    fm_eventFlowAged *flowAged;
+
+    if (batch->numFlows == 0)
+    {
+        return;
+    }
+
+    /* The timer task must not block waiting for an event buffer. */
+    event = fmAllocateEvent(sw,
+                            FM_EVID_FLOW_AGED,
+                            FM_EVENT_FLOW_AGED,
+                            FM_EVENT_PRIORITY_HIGH);
+
+    if (event == NULL)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_FLOW,
+                       "Out of event buffers, dropping %d aged flows of "
+                       "table %d\n",
+                       batch->numFlows,
+                       tableIndex);
+    }
+    else
+    {
+        flowAged = &event->info.flowAgedEvent;
+
+        flowAged->tableIndex = tableIndex;
+        flowAged->numFlows   = batch->numFlows;
+        flowAged->deleted    = batch->deleted;
+        FM_MEMCPY_S(flowAged->flowIds,
+                    sizeof(flowAged->flowIds),
+                    batch->flowIds,
+                    batch->numFlows * sizeof(fm_int));
+
+        if (fmSendThreadEvent(&fmRootApi->eventThread, event) != FM_OK)
+        {
+            fmReleaseEvent(event);
+        }
+    }
+
+    batch->numFlows = 0;
+
+}   /* end SendFlowAgedEvent */
+
+
+
+
+/*****************************************************************************/
+/** ScanFlowTable
+ * \ingroup intFlow
+ *
+ * \desc            Runs one aging tick on a flow table. Scanning resumes at
+ *                  the table's cursor and stops once the scan budget is
+ *                  spent or the end of the table is reached.
+ *
+ * \note            The caller has taken the flow lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       tableIndex is the flow table.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status ScanFlowTable(fm_int sw, fm_int tableIndex)
+{
+    fm10000_switch         *switchExt;
+    fm10000_flowTableInfo  *table;
+    fm10000_flowAgingInfo  *aging;
+    fm10000_flowAgingEntry *entry;
+    fm10000_flowAgedBatch   aged;
+    fm10000_flowAgedBatch   deleted;
+    fm_int                  flowIds[FM10000_FLOW_AGING_BATCH];
+    fm_uint64               pkts[FM10000_FLOW_AGING_BATCH];
+    fm_bool                 valid[FM10000_FLOW_AGING_BATCH];
+    fm_uint64               startNsec;
+    fm_uint64               now;
+    fm_int                  numFlows;
+    fm_int                  flowId;
+    fm_int                  i;
+    fm_status               err = FM_OK;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_FLOW,
+                 "sw = %d, tableIndex = %d\n",
+                 sw,
+                 tableIndex);
+
+    switchExt = GET_SWITCH_EXT(sw);
+    table     = &switchExt->flowInfo.table[tableIndex];
+    aging     = &table->aging;
+
+    aged.numFlows    = 0;
+    aged.deleted     = FALSE;
+    deleted.numFlows = 0;
+    deleted.deleted  = TRUE;
+
+    startNsec = fmGetMonotonicNsec();
+
+    /* 0 is reserved for flows not scanned yet. */
+    now = startNsec / 1000000 + 1;
+
+    flowId = aging->cursor;
+
+    do
+    {
+        /* Gather the next batch of flows in use. */
+        numFlows = 0;
+
+        while (numFlows < FM10000_FLOW_AGING_BATCH)
+        {
+            err = fmFindBitInBitArray(&table->idInUse, flowId, TRUE, &flowId);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FLOW, err);
+
+            if (flowId < 0)
+            {
+                break;
+            }
+
+            flowIds[numFlows++] = flowId++;
+        }
+
+        if (numFlows > 0)
+        {
+            err = ReadFlowPktCounts(sw, tableIndex, numFlows, flowIds, pkts, valid);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FLOW, err);
+        }
+
+        for (i = 0 ; i < numFlows ; i++)
+        {
+            if ( !valid[i] || (flowIds[i] == table->defaultFlowId) )
+            {
+                continue;
+            }
+
+            entry = &aging->entries[flowIds[i]];
+
+            if ( (entry->lastActive == 0) || (pkts[i] != entry->lastPkts) )
+            {
+                entry->lastPkts   = pkts[i];
+                entry->lastActive = now;
+                continue;
+            }
+
+            if ( (now - entry->lastActive) < aging->timeout )
+            {
+                continue;
+            }
+
+            /* Report an idle flow again only after a further timeout. */
+            entry->lastActive = now;
+
+            if ( aging->autoDelete &&
+                 (fm10000DeleteFlow(sw, tableIndex, flowIds[i]) == FM_OK) )
+            {
+                deleted.flowIds[deleted.numFlows++] = flowIds[i];
+
+                if (deleted.numFlows == FM_FLOW_AGED_EVENT_BURST)
+                {
+                    SendFlowAgedEvent(sw, tableIndex, &deleted);
+                }
+            }
+            else
+            {
+                aged.flowIds[aged.numFlows++] = flowIds[i];
+
+                if (aged.numFlows == FM_FLOW_AGED_EVENT_BURST)
+                {
+                    SendFlowAgedEvent(sw, tableIndex, &aged);
+                }
+            }
+        }
+
+        /* Wrap around at the end of the table. */
+        aging->cursor = (flowId < 0) ? 0 : flowId;
+    }
+    while ( (flowId >= 0) &&
+            ( (fmGetMonotonicNsec() - startNsec) <
+              (fm_uint64) aging->scanBudget * 1000 ) );
+
+ABORT:
+
+    SendFlowAgedEvent(sw, tableIndex, &aged);
+    SendFlowAgedEvent(sw, tableIndex, &deleted);
+
+    FM_LOG_EXIT(FM_LOG_CAT_FLOW, err);
+
+}   /* end ScanFlowTable */
+
+
+
+
+/*****************************************************************************/
+/** HandleFlowAgingTimer
+ * \ingroup intFlow
+ *
+ * \desc            Aging timer callback. Runs one aging tick on the flow
+ *                  table and rearms the timer while aging stays enabled.
+ *
+ * \param[in]       arg points to the ''fm10000_flowAgingInfo'' of the flow
+ *                  table.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void HandleFlowAgingTimer(void *arg)
+{
+    fm10000_flowAgingInfo *aging;
+    fm10000_switch        *switchExt;
+    fm10000_flowTableInfo *table;
+    fm_int                 sw;
+    fm_int                 tableIndex;
+    fm_status              err;
+
+    aging      = arg;
+    sw         = aging->sw;
+    tableIndex = aging->tableIndex;
+
+    VALIDATE_AND_PROTECT_SWITCH_NO_RETURN(err, sw);
+    if (err != FM_OK)
+    {
+        return;
+    }
+
+    TAKE_FLOW_LOCK(sw);
+
+    switchExt = GET_SWITCH_EXT(sw);
+    table     = &switchExt->flowInfo.table[tableIndex];
+
+    /* Aging may have been disabled while this tick was pending. */
+    if ( table->created && (table->aging.timeout > 0) &&
+         (table->aging.entries != NULL) )
+    {
+        err = ScanFlowTable(sw, tableIndex);
+        if (err != FM_OK)
+        {
+            FM_LOG_WARNING(FM_LOG_CAT_FLOW,
+                           "Aging scan of flow table %d failed: %s\n",
+                           tableIndex,
+                           fmErrorMsg(err));
+        }
+
+        err = StartFlowAgingTimer(sw, tableIndex);
+        if (err != FM_OK)
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_FLOW,
+                         "Unable to rearm aging timer of flow table %d: %s\n",
+                         tableIndex,
+                         fmErrorMsg(err));
+        }
+    }
+
+    DROP_FLOW_LOCK(sw);
+    UNPROTECT_SWITCH(sw);
+
+}   /* end HandleFlowAgingTimer */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fm10000UpdateFlowAging
+ * \ingroup intFlow
+ *
+ * \desc            Starts, restarts or stops the aging engine of a flow
+ *                  table to match its aging timeout and whether the table
+ *                  exists. Must be called after either changes.
+ *
+ * \note            The caller has taken the flow lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       tableIndex is the flow table.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if the per-flow state cannot be allocated.
+ *
+ *****************************************************************************/
+fm_status fm10000UpdateFlowAging(fm_int sw, fm_int tableIndex)
+{
+    fm10000_switch        *switchExt;
+    fm10000_flowTableInfo *table;
+    fm10000_flowAgingInfo *aging;
+    fm_char                timerName[32];
+    fm_uint                size;
+    fm_status              err = FM_OK;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_FLOW,
+                 "sw = %d, tableIndex = %d\n",
+                 sw,
+                 tableIndex);
+
+    switchExt = GET_SWITCH_EXT(sw);
+    table     = &switchExt->flowInfo.table[tableIndex];
+    aging     = &table->aging;
+
+    if ( !table->created || (aging->timeout == 0) )
+    {
+        if (aging->timer != NULL)
+        {
+            err = fmStopTimer(aging->timer);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FLOW, err);
+        }
+
+        if (aging->entries != NULL)
+        {
+            fmFree(aging->entries);
+            aging->entries = NULL;
+        }
+
+        aging->cursor = 0;
+        FM_LOG_EXIT(FM_LOG_CAT_FLOW, FM_OK);
+    }
+
+    if (aging->entries == NULL)
+    {
+        size = table->idInUse.bitCount * sizeof(fm10000_flowAgingEntry);
+
+        aging->entries = fmAlloc(size);
+        if (aging->entries == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FLOW, err);
+        }
+
+        FM_MEMSET_S(aging->entries, size, 0, size);
+        aging->cursor = 0;
+    }
+
+    if (aging->timer == NULL)
+    {
+        FM_SPRINTF_S(timerName,
+                     sizeof(timerName),
+                     "flowAging%02d%02dTimer",
+                     sw,
+                     tableIndex);
+
+        err = fmCreateTimer(timerName, fmApiTimerTask, &aging->timer);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FLOW, err);
+    }
+
+    aging->sw         = sw;
+    aging->tableIndex = tableIndex;
+
+    err = StartFlowAgingTimer(sw, tableIndex);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_FLOW, err);
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_FLOW, err);
+
+}   /* end fm10000UpdateFlowAging */
+
+
+
+
+/*****************************************************************************/
+/** fm10000ResetFlowAgingEntry
+ * \ingroup intFlow
+ *
+ * \desc            Forgets the activity recorded for a flow, so that a
+ *                  reused flow ID starts a new idle period.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       tableIndex is the flow table.
+ *
+ * \param[in]       flowId is the flow ID.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000ResetFlowAgingEntry(fm_int sw, fm_int tableIndex, fm_int flowId)
+{
+    fm10000_switch        *switchExt;
+    fm10000_flowAgingInfo *aging;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    aging     = &switchExt->flowInfo.table[tableIndex].aging;
+
+    if (aging->entries != NULL)
+    {
+        aging->entries[flowId].lastActive = 0;
+    }
+
+}   /* end fm10000ResetFlowAgingEntry */
+
+
+
+
+/*****************************************************************************/
+/** fm10000FreeFlowAging
+ * \ingroup intFlow
+ *
+ * \desc            Releases the aging timer and per-flow state of a flow
+ *                  table.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       tableIndex is the flow table.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000FreeFlowAging(fm_int sw, fm_int tableIndex)
+{
+    fm10000_switch        *switchExt;
+    fm10000_flowAgingInfo *aging;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    aging     = &switchExt->flowInfo.table[tableIndex].aging;
+
+    if (aging->timer != NULL)
+    {
+        fmDeleteTimer(aging->timer);
+        aging->timer = NULL;
+    }
+
+    if (aging->entries != NULL)
+    {
+        fmFree(aging->entries);
+        aging->entries = NULL;
+    }
+
+    aging->cursor = 0;
+
+}   /* end fm10000FreeFlowAging */
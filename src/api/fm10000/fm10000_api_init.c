@@ -94,6 +94,28 @@ enum
     FM10000_SOFT_RESET_LOCK_API  = 2,
 };
 
+/* Work shared by the threads binding the ethernet ports to their state
+ * machines. Each EPL is handed out to a single thread, which initializes
+ * the ports of that EPL in order. */
+typedef struct _fm10000_eplPortInitPool
+{
+    /* Switch on which to operate */
+    fm_int       sw;
+
+    /* Next EPL to hand out */
+    fm_int       nextEpl;
+
+    /* First error reported by any of the threads */
+    fm_status    status;
+
+    /* Protects nextEpl and status */
+    fm_lock      lock;
+
+    /* Released by each worker thread when it runs out of work */
+    fm_semaphore done;
+
+} fm10000_eplPortInitPool;
+
 
 /*****************************************************************************
  * Global Variables
@@ -178,6 +200,9 @@ const fm_switch FM10000SwitchDefaultTable =
      * Port Attributes
      **************************************************/
     .IsPerLagPortAttribute              = fm10000IsPerLagPortAttribute,
+    .BeginPortAttributeUpdate           = fm10000BeginPortAttributeUpdate,
+    .EndPortAttributeUpdate             = fm10000EndPortAttributeUpdate,
+    .GetPortAttributeSnapshot           = fm10000GetPortAttributeSnapshot,
 
     /**************************************************
      * Glort Management
@@ -204,6 +229,8 @@ const fm_switch FM10000SwitchDefaultTable =
     .WriteTagEntry                      = fm10000WriteTagEntry,
     .AddVlanPortList                    = fm10000AddVlanPortList,
     .DeleteVlanPortList                 = fm10000DeleteVlanPortList,
+    .AddVlanRangePortList               = fm10000AddVlanRangePortList,
+    .DeleteVlanRangePortList            = fm10000DeleteVlanRangePortList,
     .SetVlanCounterID                   = fm10000SetVlanCounterID,
 
     /**************************************************
@@ -213,6 +240,7 @@ const fm_switch FM10000SwitchDefaultTable =
     .AddSpanningTreeVlan                = fm10000AddSpanningTreeVlan,
     .DeleteSpanningTreeVlan             = fm10000DeleteSpanningTreeVlan,
     .RefreshSpanningTree                = fm10000RefreshSpanningTree,
+    .RefreshSpanningTreePortList        = fm10000RefreshSpanningTreePortList,
     .ResetVlanSpanningTreeState         = fm10000ResetVlanSpanningTreeState,
     .DbgDumpSpanningTree                = fm10000DbgDumpSpanningTree,
 
@@ -237,6 +265,8 @@ const fm_switch FM10000SwitchDefaultTable =
     .GetStormCtrlActionList             = fm10000GetStormCtrlActionList,
     .GetStormCtrlActionFirst            = fm10000GetStormCtrlActionFirst,
     .GetStormCtrlActionNext             = fm10000GetStormCtrlActionNext,
+    .BeginStormCtrlUpdate               = fm10000BeginStormCtrlUpdate,
+    .CommitStormCtrlUpdate              = fm10000CommitStormCtrlUpdate,
     .DbgDumpStormCtrl                   = fm10000DbgDumpStormCtrl,
 
     /**************************************************
@@ -255,6 +285,9 @@ const fm_switch FM10000SwitchDefaultTable =
      **************************************************/
     .GetCountersInitMode                = fm10000GetCountersInitMode,
     .GetVLANCounters                    = fm10000GetVLANCounters,
+    .GetVLANCountersList                = fm10000GetVLANCountersList,
+    .GetAllPortCounters                 = fm10000GetAllPortCounters,
+    .GetPortCountersSnapshot            = fm10000GetPortCountersSnapshot,
     .ResetVLANCounters                  = fm10000ResetVLANCounters,
 
     /**************************************************
@@ -263,6 +296,10 @@ const fm_switch FM10000SwitchDefaultTable =
     .GeneratePacketISL                  = fm10000GeneratePacketISL,
     .SendPacket                         = fm10000SendPacket,
     .SendPacketDirected                 = fm10000SendPacketDirected,
+    .CreateTxDestination                = fm10000CreateTxDestination,
+    .DeleteTxDestination                = fm10000DeleteTxDestination,
+    .SendPacketTxDestination            = fm10000SendPacketTxDestination,
+    .GetTxQueueSpace                    = fm10000GetTxQueueSpace,
     .SendPacketISL                      = fm10000SendPacketISL,
     .SendPacketSwitched                 = fm10000SendPacketSwitched,
     .SetPacketInfo                      = fm10000SetPacketInfo,
@@ -271,10 +308,12 @@ const fm_switch FM10000SwitchDefaultTable =
      * MAC Address Table Functions
      **************************************************/
     .AddAddress                         = fm10000AddAddress,
+    .AddAddressList                     = fm10000AddAddressList,
     .AllocAddrTableData                 = fm10000AllocAddrTableData,
     .AssignTableEntry                   = fm10000AssignTableEntry,
     .CheckFlushRequest                  = fm10000CheckFlushRequest,
     .ComputeAddressIndex                = fm10000ComputeAddressIndex,
+    .DeleteAddressList                  = fm10000DeleteAddressList,
     .DeleteAddressPre                   = fm10000DeleteAddressPre,
     .DeleteAllAddresses                 = fm10000DeleteAllAddresses,
     .DumpPurgeStats                     = fm10000DumpPurgeStats,
@@ -284,9 +323,13 @@ const fm_switch FM10000SwitchDefaultTable =
     .GetAddressOverride                 = fm10000GetAddress,
     .GetAddressTable                    = fm10000GetAddressTable,
     .GetAddressTableAttribute           = fm10000GetAddressTableAttribute,
+    .GetAddressTablePage                = fm10000GetAddressTablePage,
+    .GetAddressTableSnapshot            = fm10000GetAddressTableSnapshot,
+    .GetAddressTableStats               = fm10000GetAddressTableStats,
     .GetLearningFID                     = fm10000GetLearningFID,
     .GetSecurityStats                   = fm10000GetSecurityStats,
     .InitAddressTable                   = fm10000InitAddressTable,
+    .ResetAddressTableStats             = fm10000ResetAddressTableStats,
     .ResetPurgeStats                    = fm10000ResetPurgeStats,
     .ResetSecurityStats                 = fm10000ResetSecurityStats,
     .SetAddressTableAttribute           = fm10000SetAddressTableAttribute,
@@ -294,6 +337,7 @@ const fm_switch FM10000SwitchDefaultTable =
     .WriteEntryAtIndex                  = fm10000WriteEntryAtIndex,
     .DbgDumpMACTable                    = fm10000DbgDumpMACTable,
     .DbgDumpMACTableEntry               = fm10000DbgDumpMACTableEntry,
+    .DbgInjectMACTableEvents            = fm10000DbgInjectMACTableEvents,
 
     /**************************************************
      * MAC Maintenance Task functions
@@ -313,6 +357,7 @@ const fm_switch FM10000SwitchDefaultTable =
     .FreeLAG                            = fm10000FreeLAG,
     .DeletePortFromLag                  = fm10000DeletePortFromLag,
     .AddPortToLag                       = fm10000AddPortToLag,
+    .FlushLagUpdates                    = fm10000FlushLagUpdates,
     .GetLagAttribute                    = fm10000GetLagAttribute,
     .SetLagAttribute                    = fm10000SetLagAttribute,
 
@@ -322,6 +367,7 @@ const fm_switch FM10000SwitchDefaultTable =
     .CreateMirror                       = fm10000CreateMirror,
     .DeleteMirror                       = fm10000DeleteMirror,
     .WritePortMirrorGroup               = fm10000WritePortMirrorGroup,
+    .UpdateMirrorGroupPorts             = fm10000UpdateMirrorGroupPorts,
     .SetMirrorAttribute                 = fm10000SetMirrorAttribute,
     .GetMirrorAttribute                 = fm10000GetMirrorAttribute,
     .AddMirrorVlan                      = fm10000AddMirrorVlan,
@@ -332,6 +378,8 @@ const fm_switch FM10000SwitchDefaultTable =
      **************************************************/
     .AddSFlowPort                       = fm10000AddSFlowPort,
     .CheckSFlowLogging                  = fm10000CheckSFlowLogging,
+    .DeliverSFlowSample                 = fm10000DeliverSFlowSample,
+    .UpdateSFlowSampleRates             = fm10000UpdateSFlowSampleRates,
     .CreateSFlow                        = fm10000CreateSFlow,
     .DeleteSFlow                        = fm10000DeleteSFlow,
     .DeleteSFlowPort                    = fm10000DeleteSFlowPort,
@@ -363,6 +411,8 @@ const fm_switch FM10000SwitchDefaultTable =
     .DbgDumpRouteStats                  = fm10000DbgDumpRouteStats,
     .DbgDumpRouteTables                 = fm10000DbgDumpRouteTables,
     .DbgValidateRouteTables             = fm10000DbgValidateRouteTables,
+    .GetRouteMoveCount                  = fm10000GetRouteMoveCount,
+    .GetRouteMemoryUsage                = fm10000GetRouteMemoryUsage,
 
     /***************************************************
      * NextHop Functions
@@ -427,6 +477,8 @@ const fm_switch FM10000SwitchDefaultTable =
     .GetVNVsiNext                       = fm10000GetVNVsiNext,
     .IsVNTunnelInUseByACLs              = fm10000IsVNTunnelInUseByACLs,
     .FreeVNResources                    = fm10000FreeVNResources,
+    .BeginVNBatch                       = fm10000BeginVNBatch,
+    .CommitVNBatch                      = fm10000CommitVNBatch,
 #if 0
     .UpdateVNTunnelECMPGroup            = fm10000UpdateVNTunnelECMPGroup,
 #endif
@@ -439,6 +491,7 @@ const fm_switch FM10000SwitchDefaultTable =
      **************************************************/
     .GetACLCountExt                     = fm10000GetACLCountExt,
     .ResetACLCount                      = fm10000ResetACLCount,
+    .GetACLCountList                    = fm10000GetACLCountList,
     .GetACLEgressCount                  = fm10000GetACLEgressCount,
     .ResetACLEgressCount                = fm10000ResetACLEgressCount,
     .UpdateACLRule                      = fm10000UpdateACLRule,
@@ -456,11 +509,18 @@ const fm_switch FM10000SwitchDefaultTable =
     .ValidateACLAttribute               = fm10000ValidateACLAttribute,
     .GetAclFfuRuleUsage                 = fm10000GetAclFfuRuleUsage,
 
+    /**************************************************
+     * FFU Occupancy Functions
+     **************************************************/
+    .GetFFUSliceMap                     = fm10000GetFFUSliceMap,
+    .DefragmentFFU                      = fm10000DefragmentFFU,
+
     /**************************************************
      * Multicast Group Functions
      **************************************************/
     .ActivateMcastGroup                 = fm10000ActivateMcastGroup,
     .AddMulticastListener               = fm10000AddMulticastListener,
+    .AddMulticastListenerList           = fm10000AddMulticastListenerList,
     .AllocateMcastGroups                = fm10000AllocateMcastGroups,
     .CreateMcastGroup                   = fm10000CreateMcastGroup,
     .DeactivateMcastGroup               = fm10000DeactivateMcastGroup,
@@ -513,6 +573,7 @@ const fm_switch FM10000SwitchDefaultTable =
     .CreateFlowTETable                  = fm10000CreateFlowTETable,
     .DeleteFlowTETable                  = fm10000DeleteFlowTETable,
     .AddFlow                            = fm10000AddFlow,
+    .AddFlowList                        = fm10000AddFlowList,
     .GetFlow                            = fm10000GetFlow,
     .GetFlowTableType                   = fm10000GetFlowTableType,
     .GetFlowFirst                       = fm10000GetFlowFirst,
@@ -577,6 +638,8 @@ const fm_switch FM10000SwitchDefaultTable =
     .DeleteNatTunnel                    = fm10000DeleteNatTunnel,
     .AddNatRule                         = fm10000AddNatRule,
     .DeleteNatRule                      = fm10000DeleteNatRule,
+    .BeginNatRuleList                   = fm10000BeginNatRuleList,
+    .EndNatRuleList                     = fm10000EndNatRuleList,
     .AddNatPrefilter                    = fm10000AddNatPrefilter,
     .DeleteNatPrefilter                 = fm10000DeleteNatPrefilter,
     .GetNatRuleCount                    = fm10000GetNatRuleCount,
@@ -611,8 +674,10 @@ const fm_switch FM10000SwitchDefaultTable =
     .DbgDumpRegisterV2                  = fm10000DbgDumpRegisterV2,
     .DbgDumpRegisterV3                  = fm10000DbgDumpRegisterV3,
     .DbgGetRegisterName                 = fm10000DbgGetRegisterName,
+    .DbgGetRegisterId                   = fm10000DbgGetRegisterId,
     .DbgListRegisters                   = fm10000DbgListRegisters,
     .DbgTakeChipSnapshot                = fm10000DbgTakeChipSnapshot,
+    .DbgStreamRegisters                 = fm10000DbgStreamRegisters,
     .DbgReadRegister                    = fm10000DbgReadRegister,
     .DbgWriteRegister                   = fm10000DbgWriteRegister,
     .DbgWriteRegisterV2                 = fm10000DbgWriteRegisterV2,
@@ -626,6 +691,7 @@ const fm_switch FM10000SwitchDefaultTable =
     .DbgWriteSBusRegister               = fm10000DbgWriteSBusRegister,
     .DbgInterruptSpico                  = fm10000DbgInterruptSpico,
     .DbgTakeEyeDiagram                  = fm10000DbgTakeEyeDiagram,
+    .DbgTakeEyeMetrics                  = fm10000DbgTakeEyeMetrics,
     .DbgInitSerDes                      = fm10000DbgSerdesInit,
     .DbgRunSerDesDfeTuning              = fm10000DbgSerdesRunDfeTuning,
     .DbgReadSerDesRegister              = fm10000DbgReadSerDesRegister,
@@ -725,6 +791,7 @@ const fm_switch FM10000SwitchDefaultTable =
     .MailboxInit                         = fm10000MailboxInit,
     .MailboxFreeDataStructures           = fm10000MailboxFreeDataStructures,
     .MailboxFreeResources                = fm10000MailboxFreeResources,
+    .MailboxServicePeps                  = fm10000MailboxServicePeps,
     .GetSchedPortSpeedForPep             = fm10000GetSchedPortSpeedForPep,
     .FindInternalPortByMailboxGlort      = fm10000FindInternalPortByMailboxGlort,
     .SetXcastFlooding                    = fm10000SetXcastFlooding,
@@ -973,6 +1040,289 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** InitEplPortEthMode
+ * \ingroup intSwitch
+ *
+ * \desc            Binds an ethernet port and its native lane to their
+ *                  state machines, leaving the port disabled.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       portPtr points to the port state structure.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status InitEplPortEthMode(fm_int sw, fm_port *portPtr)
+{
+    fm10000_port *portExt;
+    fm_status     err;
+    fm_ethMode    ethMode;
+    fm_bool       unused;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH,
+                 "sw=%d port=%d\n",
+                 sw,
+                 portPtr->portNumber);
+
+    portExt = portPtr->extension;
+    ethMode = FM_ETH_MODE_DISABLED;
+
+    FM_TAKE_STATE_LOCK(sw);
+    err = fm10000ConfigureEthMode( sw,
+                                   portPtr->portNumber,
+                                   ethMode,
+                                   &unused );
+    if (err == FM_OK)
+    {
+        portExt->attributes.ethMode = ethMode;
+        portExt->ethMode            = ethMode;
+        portPtr->attributes.speed   = 0;
+        portExt->speed              = 0;
+
+        fm10000PublishPortAttributes(sw, portPtr->portNumber);
+    }
+    FM_DROP_STATE_LOCK(sw);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_OK);
+
+}   /* end InitEplPortEthMode */
+
+
+
+
+/*****************************************************************************/
+/** InitEplPortsOfEpl
+ * \ingroup intSwitch
+ *
+ * \desc            Binds the ethernet ports of one EPL to their state
+ *                  machines, in cardinal port order.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       epl is the EPL whose ports are to be initialized.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status InitEplPortsOfEpl(fm_int sw, fm_int epl)
+{
+    fm_switch *   switchPtr;
+    fm_port *     portPtr;
+    fm10000_port *portExt;
+    fm_status     err;
+    fm_int        cpi;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d epl=%d\n", sw, epl);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    err       = FM_OK;
+
+    for (cpi = 0 ; cpi < switchPtr->numCardinalPorts ; cpi++)
+    {
+        portPtr = GET_PORT_PTR(sw, GET_LOGICAL_PORT(sw, cpi));
+        if (portPtr == NULL)
+        {
+            continue;
+        }
+
+        portExt = portPtr->extension;
+        if ( (portExt->ring != FM10000_SERDES_RING_EPL) ||
+             (portExt->endpoint.epl != epl) )
+        {
+            continue;
+        }
+
+        err = InitEplPortEthMode(sw, portPtr);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end InitEplPortsOfEpl */
+
+
+
+
+/*****************************************************************************/
+/** ProcessEplPortInitPool
+ * \ingroup intSwitch
+ *
+ * \desc            Takes EPLs from the pool and initializes their ports
+ *                  until every EPL has been handed out or a thread has
+ *                  reported an error.
+ *
+ * \param[in]       pool points to the shared work state.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ProcessEplPortInitPool(fm10000_eplPortInitPool *pool)
+{
+    fm_status err;
+    fm_int    epl;
+
+    for ( ; ; )
+    {
+        fmCaptureLock(&pool->lock, FM_WAIT_FOREVER);
+
+        if ( (pool->status != FM_OK) || (pool->nextEpl >= FM10000_NUM_EPLS) )
+        {
+            fmReleaseLock(&pool->lock);
+            break;
+        }
+
+        epl = pool->nextEpl++;
+
+        fmReleaseLock(&pool->lock);
+
+        err = InitEplPortsOfEpl(pool->sw, epl);
+
+        if (err != FM_OK)
+        {
+            fmCaptureLock(&pool->lock, FM_WAIT_FOREVER);
+            FM_ERR_COMBINE(pool->status, err);
+            fmReleaseLock(&pool->lock);
+        }
+    }
+
+}   /* end ProcessEplPortInitPool */
+
+
+
+
+/*****************************************************************************/
+/** EplPortInitTask
+ * \ingroup intSwitch
+ *
+ * \desc            Worker thread that initializes ethernet ports on behalf
+ *                  of ''InitEplPorts''.
+ *
+ * \param[in]       args contains a pointer to the thread information.
+ *
+ * \return          NULL.
+ *
+ *****************************************************************************/
+static void *EplPortInitTask(void *args)
+{
+    fm_thread *              thread;
+    fm10000_eplPortInitPool *pool;
+
+    thread = FM_GET_THREAD_HANDLE(args);
+    pool   = FM_GET_THREAD_PARAM(fm10000_eplPortInitPool, args);
+
+    ProcessEplPortInitPool(pool);
+
+    /* The pool may be gone once the semaphore has been released */
+    fmReleaseSemaphore(&pool->done);
+
+    fmExitThread(thread);
+
+    return NULL;
+
+}   /* end EplPortInitTask */
+
+
+
+
+/*****************************************************************************/
+/** InitEplPorts
+ * \ingroup intSwitch
+ *
+ * \desc            Binds all ethernet ports to their state machines,
+ *                  spreading the EPLs over the number of threads given by
+ *                  the api.FM10000.portInitThreads property. The calling
+ *                  thread takes part in the work and returns once every
+ *                  EPL has been processed.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status InitEplPorts(fm_int sw)
+{
+    fm10000_switch *        switchExt;
+    fm10000_eplPortInitPool pool;
+    fm_status               err;
+    fm_int                  numThreads;
+    fm_int                  numWorkers;
+    fm_int                  i;
+    fm_char                 threadName[32];
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    switchExt  = GET_SWITCH_EXT(sw);
+    numThreads = GET_FM10000_PROPERTY()->portInitThreads;
+
+    if (numThreads > FM10000_NUM_EPLS)
+    {
+        numThreads = FM10000_NUM_EPLS;
+    }
+
+    FM_CLEAR(pool);
+    pool.sw      = sw;
+    pool.nextEpl = 0;
+    pool.status  = FM_OK;
+
+    err = fmCreateLock("EplPortInitLock", &pool.lock);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+    err = fmCreateSemaphore("EplPortInitDone",
+                            FM_SEM_COUNTING,
+                            &pool.done,
+                            0);
+    if (err != FM_OK)
+    {
+        fmDeleteLock(&pool.lock);
+        FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+    }
+
+    /* The calling thread is one of the numThreads */
+    numWorkers = 0;
+    for (i = 0 ; i < numThreads - 1 ; i++)
+    {
+        FM_SPRINTF_S(threadName, sizeof(threadName), "EplPortInit%d", i);
+
+        err = fmCreateThread(threadName,
+                             FM_EVENT_QUEUE_SIZE_NONE,
+                             EplPortInitTask,
+                             &pool,
+                             &switchExt->portInitThreads[i]);
+        if (err != FM_OK)
+        {
+            /* Carry on with the threads we have */
+            FM_LOG_WARNING(FM_LOG_CAT_SWITCH,
+                           "Unable to create port init thread %d: %s\n",
+                           i,
+                           fmErrorMsg(err));
+            break;
+        }
+
+        numWorkers++;
+    }
+
+    ProcessEplPortInitPool(&pool);
+
+    for (i = 0 ; i < numWorkers ; i++)
+    {
+        fmWaitSemaphore(&pool.done, FM_WAIT_FOREVER);
+    }
+
+    err = pool.status;
+
+    fmDeleteSemaphore(&pool.done);
+    fmDeleteLock(&pool.lock);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end InitEplPorts */
+
+
+
+
 /*****************************************************************************/
 /** InitPortQoS
  * \ingroup intSwitch
@@ -1333,7 +1683,9 @@ static fm_status fm10000InitializeAfterReset(fm_int sw)
     /***************************************************
      * Initialize glort ranges
      **************************************************/
+    fmDbgBootPhaseBegin(sw, "InitGlortRanges", -1);
     err = fm10000InitializeGlortRanges(sw);
+    fmDbgBootPhaseEnd(sw, "InitGlortRanges");
     if (err != FM_OK)
     {
         FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
@@ -1345,7 +1697,9 @@ static fm_status fm10000InitializeAfterReset(fm_int sw)
     /***************************************************
      * Initialize all the cache arrays
      **************************************************/
+    fmDbgBootPhaseBegin(sw, "InitRegisterCache", -1);
     err = fm10000InitRegisterCache(sw);
+    fmDbgBootPhaseEnd(sw, "InitRegisterCache");
     if (err != FM_OK)
     {
         FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
@@ -1373,7 +1727,9 @@ static fm_status fm10000InitializeAfterReset(fm_int sw)
     /***************************************************
      * Initialize glort cam
      **************************************************/
+    fmDbgBootPhaseBegin(sw, "InitGlortCam", -1);
     err = fm10000InitGlortCam(sw);
+    fmDbgBootPhaseEnd(sw, "InitGlortCam");
     if (err != FM_OK)
     {
         FM_LOG_FATAL( FM_LOG_CAT_SWITCH,
@@ -1397,7 +1753,9 @@ static fm_status fm10000InitializeAfterReset(fm_int sw)
     /***************************************************
      * Initialize the port tables
      **************************************************/
+    fmDbgBootPhaseBegin(sw, "InitPortTable", -1);
     err = fm10000InitPortTable(switchPtr);
+    fmDbgBootPhaseEnd(sw, "InitPortTable");
     if (err != FM_OK)
     {
         FM_LOG_FATAL( FM_LOG_CAT_SWITCH,
@@ -3100,6 +3458,8 @@ fm_status fm10000FreeResources(fm_int sw)
         /* Don't return, just continue on */
     }
 
+    fm10000FreeCounterCache(sw);
+
     err = fmFreeLogicalPortResources(sw);
     if (err != FM_OK)
     {
@@ -3110,6 +3470,19 @@ fm_status fm10000FreeResources(fm_int sw)
         /* Don't return, just continue on */
     }
 
+    /* Save the register cache for the next initialization */
+    if (GET_PROPERTY()->regCacheSnapshotFile[0] != '\0')
+    {
+        err = fmRegCacheSaveSnapshot(sw, GET_PROPERTY()->regCacheSnapshotFile);
+        if (err != FM_OK)
+        {
+            FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
+                          "Error saving register cache snapshot: %s\n",
+                          fmErrorMsg(err) );
+            /* Don't return, just continue on */
+        }
+    }
+
     /* Free register cache */
     err = fmFreeRegisterCache(sw);
     if (err != FM_OK)
@@ -3207,13 +3580,6 @@ fm_status fm10000BootSwitch(fm_int sw)
     fm_uint32           rvMult[4] = {0,0,0,0};
     fm_bool             regLockTaken;
     fm_int              fhClock;
-#if 0
-    fm_timestamp t1;
-    fm_timestamp t2;
-    fm_timestamp tDiff;
-
-    fmGetTime(&t1);
-#endif
 
     FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
 
@@ -3261,7 +3627,9 @@ fm_status fm10000BootSwitch(fm_int sw)
     }
 
     /* Configure the clock */
+    fmDbgBootPhaseBegin(sw, "SetFHClockFreq", -1);
     err = SetFHClockFreq(sw, fhClock);
+    fmDbgBootPhaseEnd(sw, "SetFHClockFreq");
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
     /***************************************************
@@ -3291,7 +3659,9 @@ fm_status fm10000BootSwitch(fm_int sw)
     /***************************************************
      * Step 1c: Initialize switch SERDES
      **************************************************/
+    fmDbgBootPhaseBegin(sw, "InitSwSerdes", -1);
     err = fm10000InitSwSerdes(sw);
+    fmDbgBootPhaseEnd(sw, "InitSwSerdes");
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
     if (GET_PROPERTY()->isWhiteModel)
@@ -3326,7 +3696,9 @@ fm_status fm10000BootSwitch(fm_int sw)
 
         /* Configure the clock (because the Release Switch cleared
          * register values) */
+        fmDbgBootPhaseBegin(sw, "SetFHClockFreq", -1);
         err = SetFHClockFreq(sw, fhClock);
+        fmDbgBootPhaseEnd(sw, "SetFHClockFreq");
         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
     }
 
@@ -3439,17 +3811,11 @@ fm_status fm10000BootSwitch(fm_int sw)
     /***************************************************
      * Step 8: Proceed with initialization per block
      **************************************************/
+    fmDbgBootPhaseBegin(sw, "InitializeAfterReset", -1);
     err = fm10000InitializeAfterReset(sw);
+    fmDbgBootPhaseEnd(sw, "InitializeAfterReset");
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
-#if 0
-    fmGetTime(&t2);
-
-    fmSubTimestamps(&t2, &t1, &tDiff);
-
-    FM_LOG_PRINT("fm10000BootSwitch:    %d.%d sec\n", (fm_uint)tDiff.sec, (fm_uint)tDiff.usec/1000);
-#endif
-
 ABORT:
     if (regLockTaken)
     {
@@ -4017,7 +4383,9 @@ fm_status fm10000SetSwitchState(fm_int sw, fm_bool state)
 
     if (state)
     {
+        fmDbgBootPhaseBegin(sw, "BootSwitch", -1);
         err = fm10000BootSwitch(sw);
+        fmDbgBootPhaseEnd(sw, "BootSwitch");
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
         /**************************************************
@@ -4062,6 +4430,7 @@ fm_status fm10000InitPortTable(fm_switch *switchPtr)
 {
     fm_status           err = FM_OK;
     fm_int              sw;
+    fm10000_switch *    switchExt;
     fm_logicalPortInfo *lportInfo;
     fm_lane            *lanePtr;
     fm10000_lane       *laneExtPtr;
@@ -4081,6 +4450,7 @@ fm_status fm10000InitPortTable(fm_switch *switchPtr)
                  (void *) switchPtr);
 
     sw        = switchPtr->switchNumber;
+    switchExt = GET_SWITCH_EXT(sw);
     lportInfo = &switchPtr->logicalPortInfo;
 
     /***************************************************
@@ -4303,11 +4673,28 @@ fm_status fm10000InitPortTable(fm_switch *switchPtr)
         portCount  = switchPtr->numCardinalPorts;
     }
 
+    /* With several port init threads, the ethernet ports are bound to
+       their state machines once they have all been allocated */
+    switchExt->deferEplPortInit =
+        (GET_FM10000_PROPERTY()->portInitThreads > 1);
+
     err = fm10000AllocLogicalPort(sw,
                                   FM_PORT_TYPE_PHYSICAL,
                                   portCount,
                                   &portNumber,
                                   0);
+
+    if (switchExt->deferEplPortInit)
+    {
+        switchExt->deferEplPortInit = FALSE;
+
+        if (err == FM_OK)
+        {
+            fmDbgBootPhaseBegin(sw, "InitEplPorts", -1);
+            err = InitEplPorts(sw);
+            fmDbgBootPhaseEnd(sw, "InitEplPorts");
+        }
+    }
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
     /* set the destmask for all cardinal ports */
@@ -4425,6 +4812,7 @@ fm_status fm10000InitPortTable(fm_switch *switchPtr)
 fm_status fm10000InitPort( fm_int sw, fm_port *portPtr )
 {
     fm_switch        *switchPtr;
+    fm10000_switch   *switchExt;
     fm_status         err;
     fm10000_port     *portExt;
     fm_portAttr      *portAttr;
@@ -4438,8 +4826,6 @@ fm_status fm10000InitPort( fm_int sw, fm_port *portPtr )
     fm_char           pcieTimerName[16];
     fm_int            fabricPort;
     fm_bool           isPciePort;
-    fm_ethMode        ethMode;
-    fm_bool           unused;
 
     FM_LOG_ENTRY( FM_LOG_CAT_SWITCH,
                   "sw=%d portPtr=%p\n",
@@ -4448,6 +4834,7 @@ fm_status fm10000InitPort( fm_int sw, fm_port *portPtr )
 
     err         = FM_OK;
     switchPtr   = GET_SWITCH_PTR(sw);
+    switchExt   = GET_SWITCH_EXT(sw);
 
     portExt     = portPtr->extension;
     portAttr    = &portPtr->attributes;
@@ -4519,6 +4906,12 @@ fm_status fm10000InitPort( fm_int sw, fm_port *portPtr )
     portAttrExt->autoNegLinkInhbTimerKx =  LINK_INHIBIT_TIMER_MILLISEC_KX;
     portAttrExt->autoNegIgnoreNonce     =  FM_DISABLED;
 
+    portAttrExt->linkDampingHalfLife    =  0;
+    portAttrExt->linkDampingPenalty     =  FM10000_LINK_DAMPING_DEF_PENALTY;
+    portAttrExt->linkDampingSuppress    =  FM10000_LINK_DAMPING_DEF_SUPPRESS;
+    portAttrExt->linkDampingReuse       =  FM10000_LINK_DAMPING_DEF_REUSE;
+    portAttrExt->linkDampingSuppressed  =  FALSE;
+
     portAttrExt->taggingMode             = FM_PORT_TAGGING_8021Q;
     portAttrExt->parserVlan1Tag          = 1;
     portAttrExt->parserVlan2Tag          = 0;
@@ -4646,20 +5039,13 @@ fm_status fm10000InitPort( fm_int sw, fm_port *portPtr )
                 laneExt->channel       = channel;
                 laneExt->physLane      = physLane;
 
-                ethMode = FM_ETH_MODE_DISABLED;
-
-                FM_TAKE_STATE_LOCK(sw);
-                err = fm10000ConfigureEthMode( sw,
-                                               portPtr->portNumber,
-                                               ethMode,
-                                               &unused );
-                FM_DROP_STATE_LOCK(sw);
-                FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-                portAttrExt->ethMode = ethMode;
-                portExt->ethMode     = ethMode;
-                portAttr->speed      = 0;
-                portExt->speed       = 0;
+                /* fm10000InitPortTable binds the ports of each EPL
+                   once all the physical ports have been allocated */
+                if (!switchExt->deferEplPortInit)
+                {
+                    err = InitEplPortEthMode(sw, portPtr);
+                    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+                }
 
             }
             else if ( ring == FM10000_SERDES_RING_PCIE )
@@ -4680,6 +5066,7 @@ fm_status fm10000InitPort( fm_int sw, fm_port *portPtr )
                 FM_LOG_EXIT_ON_ERR( FM_LOG_CAT_SWITCH, err );
 
                 portPtr->mode   = FM_PORT_MODE_UP;
+                fmUpdateCardinalPortState(switchPtr, portPtr->portNumber);
                 portExt->ring   = FM10000_SERDES_RING_PCIE;
                 portExt->smType = FM10000_PCIE_PORT_STATE_MACHINE;
                 portExt->pcieInterruptMask = FM10000_PCIE_INT_MASK;
@@ -4865,13 +5252,17 @@ fm_status fm10000PostBootSwitch(fm_int sw)
 
     switchPtr->aclInfo.enabled = TRUE;
 
+    fmDbgBootPhaseBegin(sw, "FFUInit", -1);
     err = fm10000FFUInit(sw);
+    fmDbgBootPhaseEnd(sw, "FFUInit");
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
     err = fm10000PolicerInit(sw);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
+    fmDbgBootPhaseBegin(sw, "TeInit", -1);
     err = fm10000TeInit(sw);
+    fmDbgBootPhaseEnd(sw, "TeInit");
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
     /***************************************************
@@ -4961,6 +5352,9 @@ fm_status fm10000PostBootSwitch(fm_int sw)
 
     /* Maximum number of TCN FIFO entries to process in a cycle. */
     switchExt->tcnFifoBurstSize = GET_PROPERTY()->maTcnFifoBurstSize;
+    switchExt->tcnBurstRead     = GET_FM10000_PROPERTY()->maTcnBurstRead;
+    FM_CLEAR(switchExt->tcnBurstStats);
+    fm10000InitLearnLimiter(sw);
 
     /* Automatic creation of logical ports for remote glorts/ */
     switchExt->createRemoteLogicalPorts =
@@ -4975,6 +5369,7 @@ fm_status fm10000PostBootSwitch(fm_int sw)
     switchExt->vnOuterTTL      = 0;
     switchExt->vnEncapAcl      = -1;
     switchExt->vnDecapAcl      = -1;
+    switchExt->vnBatchOpen     = FALSE;
 
     FM_MEMSET_S( switchExt->vnTunnelGroups,
                  sizeof(switchExt->vnTunnelGroups),
@@ -4994,25 +5389,35 @@ fm_status fm10000PostBootSwitch(fm_int sw)
     err = fm10000NextHopInit(sw);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
+    fmDbgBootPhaseBegin(sw, "RouterInit", -1);
     err = fm10000RouterInit(sw);
+    fmDbgBootPhaseEnd(sw, "RouterInit");
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
     err = fm10000InitMacSecurity(sw);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
+    fmDbgBootPhaseBegin(sw, "InitCounters", -1);
     err = fm10000InitCounters(sw);
+    fmDbgBootPhaseEnd(sw, "InitCounters");
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
     err = fm10000MirrorInit(sw);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
+    fmDbgBootPhaseBegin(sw, "AclInit", -1);
     err = fm10000AclInit(sw);
+    fmDbgBootPhaseEnd(sw, "AclInit");
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
+    fmDbgBootPhaseBegin(sw, "TunnelInit", -1);
     err = fm10000TunnelInit(sw);
+    fmDbgBootPhaseEnd(sw, "TunnelInit");
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
+    fmDbgBootPhaseBegin(sw, "NatInit", -1);
     err = fm10000NatInit(sw);
+    fmDbgBootPhaseEnd(sw, "NatInit");
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
     err = fm10000InitFlooding(sw);
@@ -5026,7 +5431,9 @@ fm_status fm10000PostBootSwitch(fm_int sw)
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 #endif
 
+    fmDbgBootPhaseBegin(sw, "McastGroupInit", -1);
     err = fm10000McastGroupInit(sw, FALSE);
+    fmDbgBootPhaseEnd(sw, "McastGroupInit");
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
     err = fm10000MailboxInit(sw);
@@ -5104,7 +5511,9 @@ fm_status fm10000PostBootSwitch(fm_int sw)
      * QoS initialization.
      **************************************************/
 
+    fmDbgBootPhaseBegin(sw, "InitQOS", -1);
     err = fm10000InitQOS(sw);
+    fmDbgBootPhaseEnd(sw, "InitQOS");
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
     /**************************************************
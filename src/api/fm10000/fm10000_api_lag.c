@@ -367,9 +367,13 @@ static fm_status UpdatePortMaskForLagRemove(fm_int sw,
 
     switchPtr = GET_SWITCH_PTR(sw);
 
-    /* Update portmasks for remaining member ports */
-    err = UpdatePortMaskForLag(sw, lagIndex);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+    /* Update portmasks for remaining member ports, unless that is
+     * deferred to the end of a member port list. */
+    if (!switchPtr->lagInfoTable.deferUpdates)
+    {
+        err = UpdatePortMaskForLag(sw, lagIndex);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+    }
 
     if (!fmIsCardinalPort(sw, port))
     {
@@ -514,6 +518,61 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** UpdateLagCfgList
+ * \ingroup intLag
+ *
+ * \desc            Updates the LAG_CFG register of each port in a list of
+ *                  active LAG member ports.
+ * 
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       lagIndex is the index of the lag on which to operate.
+ * 
+ * \param[in]       portList points to the list of active member ports.
+ * 
+ * \param[in]       numPorts is the number of ports in portList.
+ * 
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status UpdateLagCfgList(fm_int  sw,
+                                  fm_int  lagIndex,
+                                  fm_int *portList,
+                                  fm_int  numPorts)
+{
+    fm_status err = FM_OK;
+    fm_int    i;
+    fm_lag *  lagPtr;      
+
+    lagPtr = GET_LAG_PTR(sw, lagIndex);
+
+    /* Update LAG_CFG for all members */
+    for (i = 0; i < numPorts; i++)
+    {
+        /* Only update local ports */
+        if (fmIsCardinalPort(sw, portList[i]))
+        {
+            err = WritePortLagCfg(sw, 
+                                  portList[i], 
+                                  i, 
+                                  numPorts,
+                                  lagPtr->hashRotation,
+                                  lagPtr->filteringEnabled);
+            if (err != FM_OK)
+            {
+                break;
+            }
+        }
+    }
+
+    return err;
+
+}   /* end UpdateLagCfgList */
+
+
+
+
 /*****************************************************************************/
 /** UpdateLagCfg
  * \ingroup intLag
@@ -535,16 +594,12 @@ static fm_status UpdateLagCfg(fm_int sw, fm_int lagIndex)
     fm_status err;
     fm_int    portList[FM_MAX_NUM_LAG_MEMBERS];
     fm_int    numPorts;
-    fm_int    i;
-    fm_lag *  lagPtr;      
 
     FM_LOG_ENTRY(FM_LOG_CAT_LAG,
                  "sw = %d, lagIndex = %d\n",
                  sw,
                  lagIndex);
 
-    lagPtr = GET_LAG_PTR(sw, lagIndex);
-
     /* Get the active member port list */
     err = fmGetLAGMemberPorts(sw, 
                               lagIndex, 
@@ -554,21 +609,8 @@ static fm_status UpdateLagCfg(fm_int sw, fm_int lagIndex)
                               TRUE);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
 
-    /* Update LAG_CFG for all members */
-    for (i = 0; i < numPorts; i++)
-    {
-        /* Only update local ports */
-        if (fmIsCardinalPort(sw, portList[i]))
-        {
-            err = WritePortLagCfg(sw, 
-                                  portList[i], 
-                                  i, 
-                                  numPorts,
-                                  lagPtr->hashRotation,
-                                  lagPtr->filteringEnabled);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
-        }
-    }
+    err = UpdateLagCfgList(sw, lagIndex, portList, numPorts);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
 
 ABORT:    
     FM_LOG_EXIT(FM_LOG_CAT_LAG, err);
@@ -977,6 +1019,53 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** DeferLagUpdate
+ * \ingroup intLag
+ *
+ * \desc            Records that the hardware tables of a LAG must be
+ *                  rewritten when the current member port list has been
+ *                  applied (see ''fm10000FlushLagUpdates'').
+ * 
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       lagIndex is the index of the LAG whose membership
+ *                  changed.
+ * 
+ * \param[in]       allLags is TRUE if the glort destination table of all
+ *                  LAGs must be rewritten, as when an internal port is
+ *                  added or removed.
+ *
+ * \return          TRUE if the update was deferred.
+ * \return          FALSE if updates are not being deferred, in which case
+ *                  the caller must update the hardware itself.
+ *
+ *****************************************************************************/
+static fm_bool DeferLagUpdate(fm_int sw, fm_int lagIndex, fm_bool allLags)
+{
+    fm_lagInfo *lagInfo;
+
+    lagInfo = GET_LAG_INFO_PTR(sw);
+
+    if (!lagInfo->deferUpdates)
+    {
+        return FALSE;
+    }
+
+    lagInfo->updatePending[lagIndex] = TRUE;
+
+    if (allLags)
+    {
+        lagInfo->updateAllLags = TRUE;
+    }
+
+    return TRUE;
+
+}   /* end DeferLagUpdate */
+
+
+
+
 /*****************************************************************************/
 /** DeletePortRegisters
  * \ingroup intLag
@@ -1520,6 +1609,184 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000LagFastFailover
+ * \ingroup intLag
+ *
+ * \desc            Link down fast path. Called from the port state machine
+ *                  when a port loses link, before the link down event is
+ *                  queued to the global event handler. If the port is an
+ *                  active member of a LAG, it is removed from the LAG's hash
+ *                  distribution with as few register writes as possible:
+ *                                                                      \lb\lb
+ *                  - Under pruning, only the failed member's glort
+ *                    destination table entry (hash bucket) is rewritten, to
+ *                    point at the next active member.
+ *                                                                      \lb\lb
+ *                  - Under filtering, the member is removed from the LAG's
+ *                    destination mask and the LAG_CFG of the remaining local
+ *                    members is renumbered.
+ *                                                                      \lb\lb
+ *                  The event handler later calls ''fm10000InformLAGPortDown'',
+ *                  which does the full update.
+ *
+ * \note            The fast path never waits for the LAG lock. If the lock
+ *                  is busy, the port is left to the event handler.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port that lost link.
+ *
+ * \return          FM_OK if successful or if there was nothing to do.
+ *
+ *****************************************************************************/
+fm_status fm10000LagFastFailover(fm_int sw, fm_int port)
+{
+    fm_status          err;
+    fm_switch *        switchPtr;
+    fm_lag *           lagPtr;
+    fm_port *          lagPortPtr;
+    fm_glortCamEntry * camEntry;
+    fm_glortDestEntry *destEntry;
+    fm_portmask        destMask;
+    fm_timestamp       noWait;
+    fm_int             portList[FM_MAX_NUM_LAG_MEMBERS];
+    fm_int             numPorts;
+    fm_int             lagIndex;
+    fm_int             failedIndex;
+    fm_int             survivor;
+    fm_int             i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_LAG, "sw = %d, port = %d\n", sw, port);
+
+    if (!GET_FM10000_PROPERTY()->lagFastFailover)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_LAG, FM_OK);
+    }
+
+    switchPtr    = GET_SWITCH_PTR(sw);
+    noWait.sec   = 0;
+    noWait.usec  = 0;
+
+    if (fmCaptureLock(&switchPtr->lagLock, &noWait) != FM_OK)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_LAG, FM_OK);
+    }
+
+    err = FM_OK;
+
+    /* Internal ports affect the glort table of all LAGs, leave them to
+     * the full update. */
+    lagIndex = fmGetPortLagIndex(sw, port);
+
+    if ( (lagIndex < 0) ||
+         (lagIndex >= FM_MAX_NUM_LAGS) ||
+         !fmIsCardinalPort(sw, port) ||
+         fmIsInternalPort(sw, port) )
+    {
+        goto ABORT;
+    }
+
+    lagPtr = GET_LAG_PTR(sw, lagIndex);
+
+    if (lagPtr == NULL)
+    {
+        goto ABORT;
+    }
+
+    /* The port's link state has not been updated yet, so it is still in
+     * the active member list, at the position the hardware uses. */
+    err = fmGetLAGMemberPorts(sw,
+                              lagIndex,
+                              &numPorts,
+                              portList,
+                              FM_MAX_NUM_LAG_MEMBERS,
+                              TRUE);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+
+    failedIndex = -1;
+
+    for (i = 0 ; i < numPorts ; i++)
+    {
+        if (portList[i] == port)
+        {
+            failedIndex = i;
+            break;
+        }
+    }
+
+    if (failedIndex < 0)
+    {
+        goto ABORT;
+    }
+
+    lagPortPtr = GET_PORT_PTR(sw, fmGetLagLogicalPort(sw, lagIndex));
+    camEntry   = lagPortPtr->camEntry;
+
+    if (camEntry->destCount > 1)
+    {
+        /**************************************************
+         * Pruning: the CAM hashes over one destination
+         * entry per active member.
+         **************************************************/
+
+        if (camEntry->destCount != (fm_uint32) numPorts)
+        {
+            goto ABORT;
+        }
+
+        survivor = portList[(failedIndex + 1) % numPorts];
+
+        if (fmIsRemotePort(sw, survivor))
+        {
+            err = fmGetRemotePortDestMask(sw, survivor, NULL, &destMask);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+        }
+        else
+        {
+            err = fmAssignPortToPortMask(sw, &destMask, survivor);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+        }
+
+        destEntry = &switchPtr->logicalPortInfo.
+                        destEntries[camEntry->destIndex + failedIndex];
+
+        err = fm10000SetGlortDestMask(sw, destEntry, &destMask);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+    }
+    else
+    {
+        /**************************************************
+         * Filtering: the member ports select among
+         * themselves using their LAG_CFG index and size.
+         **************************************************/
+
+        for (i = failedIndex ; i < numPorts - 1 ; i++)
+        {
+            portList[i] = portList[i + 1];
+        }
+
+        numPorts--;
+
+        err = UpdateGlortDestTableFiltering(sw, lagIndex, portList, numPorts);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+
+        err = UpdateLagCfgList(sw, lagIndex, portList, numPorts);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+    }
+
+    fmDbgDiagCountIncr(sw, FM_CTR_LINK_CHANGE_LAG_FAST_FAILOVER, 1);
+
+ABORT:
+    DROP_LAG_LOCK(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_LAG, err);
+
+}   /* end fm10000LagFastFailover */
+
+
+
+
 /*****************************************************************************/
 /** fm10000AllocateLAGs
  * \ingroup intLag
@@ -1883,6 +2150,7 @@ fm_status fm10000AddPortToLag(fm_int sw, fm_int lagIndex, fm_int port)
     fm_switch *switchPtr;
     fm_lag *   lagPtr;
     fm_bool    mcastReserved = FALSE;
+    fm_bool    deferred;
     
     FM_LOG_ENTRY(FM_LOG_CAT_LAG,
                  "sw = %d, lagIndex = %d, port = %d\n",
@@ -1939,40 +2207,50 @@ fm_status fm10000AddPortToLag(fm_int sw, fm_int lagIndex, fm_int port)
     err = fmAddLAGMember(sw, lagIndex, port);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
 
+    /* The LAG-wide updates below are done once by fm10000FlushLagUpdates
+     * when a member port list is being applied. */
+    deferred = DeferLagUpdate(sw, lagIndex, fmIsInternalPort(sw, port));
+
     /**************************************************
      * Set up port registers
      **************************************************/
     if (fmIsCardinalPort(sw, port))
     {
-        err = UpdatePortMaskForLag(sw, lagIndex); 
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+        if (!deferred)
+        {
+            err = UpdatePortMaskForLag(sw, lagIndex); 
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+        }
 
         err = fm10000UpdateLoopbackSuppress(sw, port);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
     }
 
-    err = UpdatePortCfgISL(sw, lagIndex);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
-
-    if ( fmIsPortLinkUp(sw, port) )
+    if (!deferred)
     {
-        /* The LAG_CFG register only needs to be
-         * updated when active ports are added/removed */
-        err = UpdateLagCfg(sw, lagIndex);
+        err = UpdatePortCfgISL(sw, lagIndex);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
-    }
 
-    if (fmIsInternalPort(sw, port))
-    {
-        /* We need to update the glort table of all LAGs that make use
-         * of the internal port. */
-        err = UpdateGlortDestTableAllLags(sw);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
-    }
-    else
-    {
-        err = UpdateGlortDestTable(sw, lagIndex);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+        if ( fmIsPortLinkUp(sw, port) )
+        {
+            /* The LAG_CFG register only needs to be
+             * updated when active ports are added/removed */
+            err = UpdateLagCfg(sw, lagIndex);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+        }
+
+        if (fmIsInternalPort(sw, port))
+        {
+            /* We need to update the glort table of all LAGs that make use
+             * of the internal port. */
+            err = UpdateGlortDestTableAllLags(sw);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+        }
+        else
+        {
+            err = UpdateGlortDestTable(sw, lagIndex);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+        }
     }
     
     /**************************************************
@@ -2061,24 +2339,27 @@ fm_status fm10000DeletePortFromLag(fm_int sw, fm_int lagIndex, fm_int port)
      * Update hardware with member removed 
      **************************************************/
 
-    if (fmIsInternalPort(sw, port))
+    if ( !DeferLagUpdate(sw, lagIndex, fmIsInternalPort(sw, port)) )
     {
-        /* We need to update the glort table of all LAGs that make use
-         * of the internal port. */
-        err = UpdateGlortDestTableAllLags(sw);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
-    }
-    else
-    {
-        err = UpdateGlortDestTable(sw, lagIndex);
+        if (fmIsInternalPort(sw, port))
+        {
+            /* We need to update the glort table of all LAGs that make use
+             * of the internal port. */
+            err = UpdateGlortDestTableAllLags(sw);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+        }
+        else
+        {
+            err = UpdateGlortDestTable(sw, lagIndex);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
+        }
+
+        /* The LAG_CFG register only needs to be
+         * updated when active, non-remote ports are added/removed */
+        err = UpdateLagCfg(sw, lagIndex);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
     }
 
-    /* The LAG_CFG register only needs to be
-     * updated when active, non-remote ports are added/removed */
-    err = UpdateLagCfg(sw, lagIndex);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
-
     /**************************************************
      * Unset port registers
      **************************************************/
@@ -2118,6 +2399,85 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000FlushLagUpdates
+ * \ingroup intLag
+ *
+ * \desc            Rewrites the port masks, PORT_CFG_ISL, LAG_CFG and
+ *                  glort destination table entries of every LAG whose
+ *                  membership changed while updates were deferred. Each
+ *                  LAG is rewritten once, however many of its member ports
+ *                  were added or removed.
+ *
+ * \note            The caller must hold the LAG lock and must have cleared
+ *                  the deferUpdates flag.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000FlushLagUpdates(fm_int sw)
+{
+    fm_status   err;
+    fm_status   retStatus;
+    fm_lagInfo *lagInfo;
+    fm_bool     updateAllLags;
+    fm_int      lagIndex;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_LAG, "sw = %d\n", sw);
+
+    lagInfo       = GET_LAG_INFO_PTR(sw);
+    updateAllLags = lagInfo->updateAllLags;
+    retStatus     = FM_OK;
+
+    lagInfo->updateAllLags = FALSE;
+
+    for (lagIndex = 0 ; lagIndex < FM_MAX_NUM_LAGS ; lagIndex++)
+    {
+        if (!lagInfo->updatePending[lagIndex])
+        {
+            continue;
+        }
+
+        lagInfo->updatePending[lagIndex] = FALSE;
+
+        if (lagInfo->lag[lagIndex] == NULL)
+        {
+            continue;
+        }
+
+        err = UpdatePortMaskForLag(sw, lagIndex);
+        FM_ERR_COMBINE(retStatus, err);
+
+        err = UpdatePortCfgISL(sw, lagIndex);
+        FM_ERR_COMBINE(retStatus, err);
+
+        err = UpdateLagCfg(sw, lagIndex);
+        FM_ERR_COMBINE(retStatus, err);
+
+        if (!updateAllLags)
+        {
+            err = UpdateGlortDestTable(sw, lagIndex);
+            FM_ERR_COMBINE(retStatus, err);
+        }
+    }
+
+    if (updateAllLags)
+    {
+        /* An internal port was added or removed, so the glort table of all
+         * LAGs that make use of it must be updated. */
+        err = UpdateGlortDestTableAllLags(sw);
+        FM_ERR_COMBINE(retStatus, err);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_LAG, retStatus);
+
+}   /* end fm10000FlushLagUpdates */
+
+
+
+
 /*****************************************************************************/
 /** fm10000GetLagAttribute
  * \ingroup intLag
@@ -357,6 +357,144 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** RemapBin
+ * \ingroup intLbg
+ *
+ * \desc            Returns the offset in the group's ARP block of the
+ *                  ARP_TABLE entry used for a bin.
+ *
+ * \note            Bins are remapped to improve hashing. FM10000 can hash
+ *                  over up to 4096 bins using a checksum algorithm. The
+ *                  result is scrambled using a 4-bit pTable applied to the
+ *                  lowest 4-bit position. Due to linear CRC and usage of
+ *                  only last 4-bit, similar keys result in similar bin
+ *                  selection.
+ *                                                                      \lb\lb
+ *                  This mostly impact bins configured in block as opposed to
+ *                  stripped, e.g.: Bin[0..99] = Port 1, Bin[100..199] =
+ *                  Port 2,...
+ *                                                                      \lb\lb
+ *                  The following algorithm is used to scramble the block in
+ *                  software to improve hashing:
+ *                                                                      \lb\lb
+ *                  1 - Divide the global size in group of 16 entries.
+ *                                                                      \lb\lb
+ *                  2 - Select the group based on the low order bits.
+ *                                                                      \lb\lb
+ *                  3 - Scramble the group selection in a non linear way by
+ *                      inverting low bit position with high one.
+ *                                                                      \lb\lb
+ *                  4 - Use the high order bit to index the entry inside the
+ *                      group.
+ *
+ * \param[in]       group points to the state structure for the group.
+ *
+ * \param[in]       bin is the bin number.
+ *
+ * \return          The ARP block offset for the bin.
+ *
+ *****************************************************************************/
+static fm_int RemapBin(fm_LBGGroup *group, fm_int bin)
+{
+    fm_int numGroup;
+    fm_int numGroupBit;
+    fm_int numGroupLowBit;
+    fm_int numGroupHighBit;
+    fm_int numGroupMask;
+    fm_int selectGroup;
+    fm_int remapGroup;
+
+    numGroup = group->numBins / FM10000_NUM_LBG_BIN_PER_GROUP;
+
+    if (numGroup <= 1)
+    {
+        return bin;
+    }
+
+    numGroupMask = (numGroup - 1);
+    FM_COUNT_SET_BITS(numGroupMask, numGroupBit);
+    numGroupLowBit = (numGroupBit >> 1) + (numGroupBit & 0x1);
+    numGroupHighBit = (numGroupBit >> 1);
+
+    selectGroup = bin & numGroupMask;
+    remapGroup = ((selectGroup & ((numGroupMask >> numGroupLowBit) << numGroupLowBit)) >> numGroupLowBit) |
+                 ((selectGroup & (numGroupMask >> numGroupHighBit)) << numGroupHighBit);
+
+    return (remapGroup * FM10000_NUM_LBG_BIN_PER_GROUP) + (bin >> numGroupBit);
+
+}   /* end RemapBin */
+
+
+
+
+/*****************************************************************************/
+/** FillArpDataFromBin
+ * \ingroup intLbg
+ *
+ * \desc            Fills in the ARP_TABLE entry for a bin of the group's
+ *                  hardware distribution.
+ *
+ * \param[in]       sw is the switch number to operate on.
+ *
+ * \param[in]       group points to the state structure for the group.
+ *
+ * \param[in]       bin is the bin number.
+ *
+ * \param[out]      arpData is where the filled in ARP_TABLE entry has to
+ *                  be stored.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_PORT if the bin's port is not valid.
+ *
+ *****************************************************************************/
+static fm_status FillArpDataFromBin(fm_int       sw,
+                                    fm_LBGGroup *group,
+                                    fm_int       bin,
+                                    fm_uint64 *  arpData)
+{
+    fm_status err = FM_OK;
+    fm_port * memberPortPtr;
+
+    *arpData = 0LL;
+
+    if (group->lbgMode == FM_LBG_MODE_REDIRECT)
+    {
+        memberPortPtr = GET_PORT_PTR(sw, group->hwDistribution[bin]);
+
+        if (!memberPortPtr)
+        {
+            return FM_ERR_INVALID_PORT;
+        }
+
+        FM_SET_FIELD64(*arpData,
+                       FM10000_ARP_ENTRY_GLORT,
+                       DGLORT,
+                       memberPortPtr->glort);
+        FM_SET_BIT64(*arpData, FM10000_ARP_ENTRY_GLORT, markRouted, 0);
+    }
+    else
+    {
+        err = FillArpDataFromLBGMember(sw,
+                                       &group->hwDistributionV2[bin],
+                                       arpData);
+    }
+
+    /* Note that the following fields are set to 0 and are not used by the
+     * chip in this scenario:
+     * -FM10000_ARP_ENTRY_GLORT.MTU_Index
+     * -FM10000_ARP_ENTRY_GLORT.IPv6Entry
+     * -FM10000_ARP_ENTRY_GLORT.RouterIdGlort
+     * -FM10000_ARP_ENTRY_GLORT.EVID
+     * -FM10000_ARP_ENTRY_GLORT.RouterId */
+
+    return err;
+
+}   /* end FillArpDataFromBin */
+
+
+
+
 /*****************************************************************************/
 /** UpdateDistributionInHWArpTable
  * \ingroup intLbg
@@ -381,21 +519,11 @@ static fm_status UpdateDistributionInHWArpTable(fm_int       sw,
                                                 fm_int       numberOfBins)
 {
     fm_status                 err = FM_OK;
-    fm_port *                 memberPortPtr;
-    fm_uint32                 dglort;
     fm_int                    bin;
     fm10000_LBGGroup *        groupExt;
     fm_switch *               switchPtr;
-    fm_int                    numGroup;
-    fm_int                    numGroupBit;
-    fm_int                    numGroupLowBit;
-    fm_int                    numGroupHighBit;
-    fm_int                    numGroupMask;
-    fm_int                    selectGroup;
-    fm_int                    remapGroup;
     fm_int                    remapBin;
     fm_uint64                 arpData;
-    fm_LBGMember *            lbgMember;
     
     FM_LOG_ENTRY(FM_LOG_CAT_LBG,
                  "sw=%d group=%p, firstBin=%d, numberOfBins=%d\n",
@@ -417,94 +545,145 @@ static fm_status UpdateDistributionInHWArpTable(fm_int       sw,
         FM_LOG_EXIT(FM_LOG_CAT_LBG, FM_FAIL);
     }
 
-    /* Compute some variable used to scramble the hash bin */
-    numGroup = group->numBins / FM10000_NUM_LBG_BIN_PER_GROUP;
-    numGroupMask = (numGroup - 1);
-    FM_COUNT_SET_BITS(numGroupMask, numGroupBit);
-    numGroupLowBit = (numGroupBit >> 1) + (numGroupBit & 0x1);
-    numGroupHighBit = (numGroupBit >> 1);
+    for ( bin = firstBin ; bin < firstBin + numberOfBins ; bin++ )
+    {
+        remapBin = RemapBin(group, bin);
 
-    for ( bin = 0 ; bin < numberOfBins ; bin++ )
-    {
-        /* Remap the bins to improve hashing. FM10000 can hash over up
-         * to 4096 bins using a checksum algorithm. The result is scrambled
-         * using a 4-bit pTable applied to the lowest 4-bit position. Due to
-         * linear CRC and usage of only last 4-bit, similar keys result in
-         * similar bin selection. 
-         *
-         * This mostly impact bins configured in block as opposed to
-         * stripped, e.g.: Bin[0..99] = Port 1, Bin[100..199] = Port 2,...
-         *
-         * The following algorithm is used to scramble the block in software
-         * to improve hashing:
-         * 
-         * 1 - Divide the global size in group of 16 entries.
-         * 2 - Select the group based on the low order bits.
-         * 3 - Scramble the group selection in a non linear way by inverting
-         *     low bit position with high one.
-         * 4 - Use the high order bit to index the entry inside the group. */ 
-        if (numGroup > 1)
-        {
-            selectGroup = (firstBin + bin) & numGroupMask;
-            remapGroup = ((selectGroup & ((numGroupMask >> numGroupLowBit) << numGroupLowBit)) >> numGroupLowBit) |
-                         ((selectGroup & (numGroupMask >> numGroupHighBit)) << numGroupHighBit);
+        /* Update ARP table entry in the remapBin */
+        err = FillArpDataFromBin(sw, group, bin, &arpData);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LBG, err);
 
-            remapBin = (remapGroup * FM10000_NUM_LBG_BIN_PER_GROUP) +
-                       ((firstBin + bin) >> numGroupBit);
-        }
-        else
+        err = switchPtr->WriteUINT64(sw,
+                                     FM10000_ARP_TABLE(groupExt->arpBlockIndex + remapBin,
+                                                       0),
+                                     arpData);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LBG, err);
+    }
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_LBG, err);
+
+}   /* end UpdateDistributionInHWArpTable */
+
+
+
+
+/*****************************************************************************/
+/** UpdateChangedBinsInHWArpTable
+ * \ingroup intLbg
+ *
+ * \desc            Updates the hardware with the bins of a redirect mode
+ *                  group whose hwDistribution differs from a previous copy.
+ *                  Bins that did not change are left alone, so flows hashed
+ *                  to them stay on their port.
+ *                                                                      \lb\lb
+ *                  The ARP_TABLE entries spanning the changed bins are
+ *                  rebuilt in memory and written with a single
+ *                  ''WriteUINT64Mult'' call. Unchanged entries inside that
+ *                  span are rewritten with their current value.
+ *
+ * \param[in]       sw is the switch number to operate on.
+ *
+ * \param[in]       group points to the state structure for the group.
+ *
+ * \param[in]       oldDistribution points to the copy of hwDistribution
+ *                  taken before the change, numBins entries long.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status UpdateChangedBinsInHWArpTable(fm_int       sw,
+                                               fm_LBGGroup *group,
+                                               fm_int *     oldDistribution)
+{
+    fm_status          err = FM_OK;
+    fm10000_LBGGroup * groupExt;
+    fm_switch *        switchPtr;
+    fm_uint64 *        arpData;
+    fm_int             bin;
+    fm_int             remapBin;
+    fm_int             firstEntry;
+    fm_int             lastEntry;
+    fm_int             numEntries;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_LBG,
+                 "sw=%d group=%p\n",
+                 sw, (void *) group);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    groupExt  = group->extension;
+    arpData   = NULL;
+
+    if ( (groupExt->arpBlockIndex == NO_ARP_BLOCK_INDEX) ||
+         (groupExt->arpBlockIndex >= (FM10000_ARP_TABLE_ENTRIES - 1) ) )
+    {
+        /* Unexpected failure */
+        FM_LOG_EXIT(FM_LOG_CAT_LBG, FM_FAIL);
+    }
+
+    /* Find the span of ARP block entries holding changed bins */
+    firstEntry = group->numBins;
+    lastEntry  = -1;
+
+    for ( bin = 0 ; bin < group->numBins ; bin++ )
+    {
+        if (group->hwDistribution[bin] != oldDistribution[bin])
         {
-            remapBin = firstBin + bin;
+            remapBin   = RemapBin(group, bin);
+            firstEntry = (remapBin < firstEntry) ? remapBin : firstEntry;
+            lastEntry  = (remapBin > lastEntry) ? remapBin : lastEntry;
         }
+    }
 
-        /* Update ARP table entry in the remapBin */
-        arpData = 0LL;
-        if (group->lbgMode == FM_LBG_MODE_REDIRECT)
-        {
-            memberPortPtr = GET_PORT_PTR(sw, group->hwDistribution[firstBin + bin]);
+    if (lastEntry < 0)
+    {
+        FM_LOG_DEBUG(FM_LOG_CAT_LBG, "No bins changed\n");
+        FM_LOG_EXIT(FM_LOG_CAT_LBG, FM_OK);
+    }
 
-            if (!memberPortPtr)
-            {
-                err = FM_ERR_INVALID_PORT;
-                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LBG, err);
-            }
-            
-            dglort = memberPortPtr->glort;
-
-            FM_SET_FIELD64(arpData, FM10000_ARP_ENTRY_GLORT, DGLORT, dglort);
-            FM_SET_BIT64(arpData, FM10000_ARP_ENTRY_GLORT, markRouted, 0);
-            err = switchPtr->WriteUINT64(sw,
-                                         FM10000_ARP_TABLE(groupExt->arpBlockIndex + remapBin,
-                                                           0),
-                                         arpData);
-        }
-        else
-        {
-            lbgMember = &group->hwDistributionV2[firstBin + bin];
+    numEntries = lastEntry - firstEntry + 1;
 
-            err = FillArpDataFromLBGMember(sw, lbgMember, &arpData);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+    arpData = fmAlloc(numEntries * sizeof(fm_uint64));
 
-            err = switchPtr->WriteUINT64(sw,
-                                         FM10000_ARP_TABLE(groupExt->arpBlockIndex + remapBin,
-                                                           0),
-                                         arpData);
-        }
+    if (arpData == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_LBG, FM_ERR_NO_MEM);
+    }
+
+    for ( bin = 0 ; bin < group->numBins ; bin++ )
+    {
+        remapBin = RemapBin(group, bin);
 
-        /* Note that the following fields are set to 0 and are not used by the
-         * chip in this scenario:
-         * -FM10000_ARP_ENTRY_GLORT.MTU_Index
-         * -FM10000_ARP_ENTRY_GLORT.IPv6Entry
-         * -FM10000_ARP_ENTRY_GLORT.RouterIdGlort
-         * -FM10000_ARP_ENTRY_GLORT.EVID
-         * -FM10000_ARP_ENTRY_GLORT.RouterId */
+        if ( (remapBin >= firstEntry) && (remapBin <= lastEntry) )
+        {
+            err = FillArpDataFromBin(sw,
+                                     group,
+                                     bin,
+                                     &arpData[remapBin - firstEntry]);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LBG, err);
+        }
     }
 
+    FM_LOG_DEBUG(FM_LOG_CAT_LBG,
+                 "Writing ARP block entries %d..%d\n",
+                 firstEntry,
+                 lastEntry);
+
+    err = switchPtr->WriteUINT64Mult(sw,
+                                     FM10000_ARP_TABLE(groupExt->arpBlockIndex + firstEntry,
+                                                       0),
+                                     numEntries,
+                                     arpData);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LBG, err);
+
 ABORT:
+    fmFree(arpData);
 
     FM_LOG_EXIT(FM_LOG_CAT_LBG, err);
 
-}   /* end UpdateDistributionInHWArpTable */
+}   /* end UpdateChangedBinsInHWArpTable */
 
 
 
@@ -2116,6 +2295,7 @@ fm_status fm10000SetLBGPortAttribute(fm_int sw,
     fm_int            newMode;
     fm_bool           hwUpdateNeeded;
     fm_int            redirectTarget;
+    fm_int *          oldDistribution;
     
     FM_LOG_ENTRY(FM_LOG_CAT_LBG,
                  "sw=%d, lbgNumber=%d, port=%d, attr=%d, value=%p\n",
@@ -2125,7 +2305,8 @@ fm_status fm10000SetLBGPortAttribute(fm_int sw,
                  attr,
                  (void *) value);
 
-    info = GET_LBG_INFO(sw);
+    info            = GET_LBG_INFO(sw);
+    oldDistribution = NULL;
 
     err = fmTreeFind(&info->groups, lbgNumber, (void **) &group);
 
@@ -2173,6 +2354,21 @@ fm_status fm10000SetLBGPortAttribute(fm_int sw,
                 goto ABORT;
             }
 
+            /* Keep the current distribution so that only the bins
+             * the transition moves are written to the hardware. */
+            oldDistribution = fmAlloc(group->numBins * sizeof(fm_int));
+
+            if (oldDistribution == NULL)
+            {
+                err = FM_ERR_NO_MEM;
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LBG, err);
+            }
+
+            FM_MEMCPY_S(oldDistribution,
+                        group->numBins * sizeof(fm_int),
+                        group->hwDistribution,
+                        group->numBins * sizeof(fm_int));
+
             /***************************************************
              * Filter out any disallowed transitions.
              **************************************************/
@@ -2187,7 +2383,7 @@ fm_status fm10000SetLBGPortAttribute(fm_int sw,
             if (hwUpdateNeeded)
             {
                 /* Update the hardware */
-                err = UpdateDistributionInHWArpTable(sw, group, 0, group->numBins);
+                err = UpdateChangedBinsInHWArpTable(sw, group, oldDistribution);
                 FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LBG, err);
             }
             break;
@@ -2230,6 +2426,11 @@ fm_status fm10000SetLBGPortAttribute(fm_int sw,
     }   /* end switch (attr) */
 
 ABORT:
+    if (oldDistribution != NULL)
+    {
+        fmFree(oldDistribution);
+    }
+
     FM_LOG_EXIT(FM_LOG_CAT_LBG, err);
 
 }   /* end fm10000SetLBGPortAttribute */
@@ -1462,6 +1462,11 @@ fm_status fm10000FreeLogicalPort( fm_int sw, fm_int logicalPort )
         portExt = GET_PORT_EXT( sw, logicalPort );
         fmDeleteTimer( portExt->timerHandle );
         fmDeleteTimer( portExt->pcieIntrTimerHandle );
+
+        if (portExt->linkDampingTimer != NULL)
+        {
+            fmDeleteTimer( portExt->linkDampingTimer );
+        }
         fmDeleteStateMachine( portExt->smHandle );
 
         if (portExt->anSmHandle)
@@ -41,6 +41,10 @@
  * the L2 resource lock. */
 #define SKIP_THRESHOLD      16
 
+/* The number of entries to examine between checks of the time spent
+ * in a purge slice. */
+#define SLICE_TIME_CHECK    64
+
 
 /*****************************************************************************
  * Global Variables
@@ -184,6 +188,10 @@ static fm_status InitiatePurge(fm_int sw)
     purgePtr->restoreLocked = FALSE;
     purgePtr->purgeTimeout = 0;
 
+    /* The scope is determined by the first slice of the purge. */
+    purgePtr->numScope = -1;
+    purgePtr->cursor   = 0;
+
     /* Get purge start time. */
     err = fmGetTime( &purgePtr->startTime );
     if (err != FM_OK)
@@ -305,11 +313,75 @@ static fm_bool MeetsPurgeCriteria(fm_int                   sw,
 
 
 
+/*****************************************************************************/
+/** IsSliceExhausted
+ * \ingroup intMacMaint
+ *
+ * \desc            Determines whether the current purge slice has used up
+ *                  its budget, as given by the api.ma.maintSliceEntries
+ *                  and api.ma.maintSliceTime properties.
+ *
+ * \param[in]       numExamined is the number of entries examined so far
+ *                  in this slice.
+ *
+ * \param[in]       sliceStart points to the time at which the slice began.
+ *
+ * \return          TRUE if the purge should yield.
+ *
+ *****************************************************************************/
+static fm_bool IsSliceExhausted(fm_int numExamined, fm_timestamp *sliceStart)
+{
+    fm_int          maxEntries;
+    fm_int          maxTime;
+    fm_timestamp    now;
+    fm_timestamp    diff;
+    fm_uint64       elapsed;
+
+    if (numExamined == 0)
+    {
+        /* Always make progress. */
+        return FALSE;
+    }
+
+    maxEntries = GET_PROPERTY()->maMaintSliceEntries;
+    maxTime    = GET_PROPERTY()->maMaintSliceTime;
+
+    if (maxEntries > 0 && numExamined >= maxEntries)
+    {
+        return TRUE;
+    }
+
+    if (maxTime > 0 && (numExamined % SLICE_TIME_CHECK) == 0)
+    {
+        fmGetTime(&now);
+        fmSubTimestamps(&now, sliceStart, &diff);
+        elapsed = diff.sec * 1000000 + diff.usec;
+
+        if (elapsed >= (fm_uint64) maxTime)
+        {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+
+}   /* end IsSliceExhausted */
+
+
+
+
 /*****************************************************************************/
 /** PerformPurge
  * \ingroup intMacMaint
  *
- * \desc            Initiates an MA table purge operation.
+ * \desc            Executes one slice of the active MA table purge.
+ *                                                                      \lb\lb
+ *                  If the slice budget runs out before the purge is done,
+ *                  the position is saved in the purge cursor and another
+ *                  purge pass is requested, so that the maintenance thread
+ *                  releases the switch between slices. The purge is
+ *                  finished, and its callbacks processed, only once every
+ *                  entry in its scope has been examined.
  *
  * \param[in]       sw is the switch on which to operate.
  *
@@ -319,24 +391,38 @@ static fm_bool MeetsPurgeCriteria(fm_int                   sw,
 static fm_status PerformPurge(fm_int sw)
 {
     fm_switch *     switchPtr;
+    fm_maPurge *    purgePtr;
     fm_bool         l2Locked;
+    fm_bool         yielded;
     fm_int          numSkipped;
+    fm_int          numExamined;
     fm_event *      eventPtr;
     fm_uint32       numUpdates;
     fm_int          entryIndex;
     fm_status       err;
+    fm_uint32 *     scope;
+    fm_int          numEntries;
+    fm_int          i;
+    fm_timestamp    sliceStart;
 
     fm_internalMacAddrEntry *   cachePtr;
     fm_internalMacAddrEntry     oldEntry;
+    fm_maPurgeRequest *         request;
 
     FM_LOG_ENTRY(FM_LOG_CAT_EVENT_MAC_MAINT, "sw=%d\n", sw);
 
     switchPtr = GET_SWITCH_PTR(sw);
+    purgePtr  = &switchPtr->maPurge;
+    request   = &purgePtr->request;
 
     l2Locked    = FALSE;
+    yielded     = FALSE;
     numSkipped  = 0;
+    numExamined = 0;
     numUpdates  = 0;
 
+    fmGetTime(&sliceStart);
+
     /***************************************************
      * Preallocate an event buffer.
      **************************************************/
@@ -357,13 +443,58 @@ static fm_status PerformPurge(fm_int sw)
     }
 
     /***************************************************
-     * Iterate over MAC table cache.
+     * On the first slice, determine the scope of the 
+     * purge. A purge on a port or a VLAN only visits the
+     * entries listed for them in the MA table index.
+     * Any other purge iterates over the whole cache.
      **************************************************/
 
-    for ( entryIndex = 0 ;
-          entryIndex < switchPtr->macTableSize ;
-          ++entryIndex )
+    if (purgePtr->numScope < 0)
     {
+        scope      = NULL;
+        numEntries = switchPtr->macTableSize;
+
+        if ( !request->expired && (request->port >= 0 || request->vid1 >= 0) )
+        {
+            FM_TAKE_L2_LOCK(sw);
+
+            err = fmAddrIndexGetEntries(switchPtr,
+                                        request->port,
+                                        request->vid1,
+                                        &scope,
+                                        &numEntries);
+
+            FM_DROP_L2_LOCK(sw);
+
+            if (err != FM_OK)
+            {
+                scope      = NULL;
+                numEntries = switchPtr->macTableSize;
+            }
+            else if (scope == NULL)
+            {
+                numEntries = 0;
+            }
+        }
+
+        purgePtr->scope    = scope;
+        purgePtr->numScope = numEntries;
+        purgePtr->cursor   = 0;
+    }
+
+    scope      = purgePtr->scope;
+    numEntries = purgePtr->numScope;
+
+    for ( i = purgePtr->cursor ; i < numEntries ; ++i, ++numExamined )
+    {
+        if ( IsSliceExhausted(numExamined, &sliceStart) )
+        {
+            yielded = TRUE;
+            break;
+        }
+
+        entryIndex = (scope != NULL) ? (fm_int) scope[i] : i;
+
         if (!l2Locked)
         {
             FM_TAKE_L2_LOCK(sw);
@@ -434,7 +565,9 @@ static fm_status PerformPurge(fm_int sw)
 
         fmDbgDiagCountIncr(sw, FM_CTR_MAC_PURGE_AGED, 1);
 
-    }   /* end for ( entryIndex = 0 ; ... ) */
+    }   /* end for ( i = purgePtr->cursor ; i < numEntries ; ++i, ... ) */
+
+    purgePtr->cursor = i;
 
     if (l2Locked)
     {
@@ -455,6 +588,35 @@ static fm_status PerformPurge(fm_int sw)
         fmReleaseEvent(eventPtr);
     }
 
+    if (yielded)
+    {
+        /***************************************************
+         * Resume on the next maintenance pass.
+         **************************************************/
+
+        FM_TAKE_MA_PURGE_LOCK(sw);
+        ++purgePtr->stats.numSlicesYielded;
+        FM_DROP_MA_PURGE_LOCK(sw);
+
+        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_MAC_MAINT,
+                     "purge yielded: sw=%d cursor=%d of %d\n",
+                     sw,
+                     i,
+                     numEntries);
+
+        err = fmIssueMacMaintRequest(sw, FM_UPD_HANDLE_PURGE);
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_MAC_MAINT, err);
+    }
+
+    if (purgePtr->scope != NULL)
+    {
+        fmFree(purgePtr->scope);
+        purgePtr->scope = NULL;
+    }
+
+    purgePtr->numScope = -1;
+    purgePtr->cursor   = 0;
+
     err = FinishPurge(sw);
 
     FM_LOG_EXIT(FM_LOG_CAT_EVENT_MAC_MAINT, err);
@@ -474,7 +636,8 @@ static fm_status PerformPurge(fm_int sw)
  * \ingroup intMacMaint
  *
  * \desc            Services the purge request queue. Called through the
- *                  HandlePurgeRequest function pointer.
+ *                  HandlePurgeRequest function pointer. Resumes the
+ *                  active purge if it yielded at the end of a slice.
  *
  * \param[in]       sw is the switch on which to operate.
  *
@@ -499,6 +662,15 @@ fm_status fm10000HandlePurgeRequest(fm_int sw)
     if (purgePtr->purgeState == FM_PURGE_STATE_ACTIVE)
     {
         err = FM_OK;
+
+        if (purgePtr->numScope >= 0)
+        {
+            /* Execute the next slice of the active purge. */
+            FM_DROP_MA_PURGE_LOCK(sw);
+            purgeLocked = FALSE;
+
+            err = PerformPurge(sw);
+        }
         goto ABORT;
     }
 
@@ -878,7 +878,9 @@ static fm_status UpdateMacEntry(fm_int                    sw,
     secInfo   = &switchExt->securityInfo;
 
     /* Update cache entry to new configuration. */
+    fmAddrIndexUnlink(GET_SWITCH_PTR(sw), index);
     entry->port   = newPort;
+    fmAddrIndexLink(GET_SWITCH_PTR(sw), index);
     entry->secure = FM_IS_ADDR_TYPE_SECURE(entry->addrType);
 
     switch (entry->addrType)
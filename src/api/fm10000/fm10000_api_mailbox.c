@@ -1063,6 +1063,63 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** FlushMailboxBatch
+ * \ingroup intMailbox
+ *
+ * \desc            Commits the hardware updates deferred by the current
+ *                  batch of mailbox requests, then signals the responses
+ *                  written during the batch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       endBatch is TRUE to end the batch, FALSE to keep
+ *                  batching the following requests.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status FlushMailboxBatch(fm_int  sw,
+                                   fm_bool endBatch)
+{
+    fm_mailboxInfo *info;
+    fm_status       status;
+    fm_status       err;
+    fm_int          pepNb;
+
+    info = GET_MAILBOX_INFO(sw);
+
+    /* Responses are signaled even if the commit failed, so that the host
+     * drivers are not left waiting. */
+    status = fmMailboxEndBatch(sw);
+
+    for (pepNb = 0 ; pepNb < FM10000_NUM_PEPS ; pepNb++)
+    {
+        if (info->batchResponsePepMask & (1U << pepNb))
+        {
+            err = SignalResponseSent(sw, pepNb);
+
+            if (status == FM_OK)
+            {
+                status = err;
+            }
+        }
+    }
+
+    info->batchResponsePepMask = 0;
+
+    if (!endBatch)
+    {
+        fmMailboxBeginBatch(sw);
+    }
+
+    return status;
+
+}   /* end FlushMailboxBatch */
+
+
+
+
 /*****************************************************************************/
 /** WriteDataToQueue
  * \ingroup intMailbox
@@ -1098,10 +1155,12 @@ static fm_status WriteDataToQueue(
                       fm_byte                       flags,
                       fm_uint32 *                   dataToWrite)
 {
-    fm_switch *switchPtr;
-    fm_status  status;
+    fm_switch *     switchPtr;
+    fm_mailboxInfo *info;
+    fm_status       status;
 
     switchPtr = GET_SWITCH_PTR(sw);
+    info      = GET_MAILBOX_INFO(sw);
 
     status = WriteResponseMessageHeader(
                   sw,
@@ -1140,6 +1199,22 @@ static fm_status WriteDataToQueue(
                        FM_UPDATE_CTRL_HDR_REQUEST_HEAD);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
+    /* Within a batch, complete responses are signaled once the batch has
+     * been committed. Fragmented ones need the host to read each part, so
+     * the batch is flushed first. */
+    if (info->batchActive)
+    {
+        if ( (flags & FM_MAILBOX_HEADER_START_OF_MESSAGE) &&
+             (flags & FM_MAILBOX_HEADER_END_OF_MESSAGE) )
+        {
+            info->batchResponsePepMask |= (1U << pepNb);
+            goto ABORT;
+        }
+
+        status = FlushMailboxBatch(sw, FALSE);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
+    }
+
     /* Signal that response from SM to PF has been sent */
     status = SignalResponseSent(sw,
                                 pepNb);
@@ -1622,32 +1697,376 @@ static fm_status PCIeMailboxProcessGlobalAck(fm_int sw,
     fm_uint64 regAddr;
     fm_uint32 rv;
 
-    FM_LOG_ENTRY(FM_LOG_CAT_MAILBOX,
-                 "sw=%d, pepNb=%d\n",
-                 sw,
-                 pepNb);
+    FM_LOG_ENTRY(FM_LOG_CAT_MAILBOX,
+                 "sw=%d, pepNb=%d\n",
+                 sw,
+                 pepNb);
+
+    status  = FM_OK;
+
+    regAddr = FM10000_PCIE_GMBX();
+    rv = 0;
+    
+    FM_SET_BIT(rv,
+               FM10000_PCIE_GMBX,
+               GlobalAckInterrupt,
+               1);
+
+    status = fm10000WritePep(sw,
+                             regAddr,
+                             pepNb,
+                             rv);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_MAILBOX, status);
+ 
+}   /* end PCIeMailboxProcessGlobalAck */
+
+
+
+
+/*****************************************************************************/
+/** ServicePepMailbox
+ * \ingroup intMailbox
+ *
+ * \desc            Processes the pending requests, or the global
+ *                  acknowledge, signaled on the mailbox of a PEP.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       pepNb is the PEP number.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status ServicePepMailbox(fm_int sw,
+                                   fm_int pepNb)
+{
+    fm_status status;
+    fm_uint64 regAddr;
+    fm_uint32 rv;
+    fm_bool   processRequest;
+    fm_bool   processGlobalAck;
+
+    regAddr = FM10000_PCIE_GMBX();
+    rv      = 0;
+
+    status = fm10000ReadPep(sw,
+                            regAddr,
+                            pepNb,
+                            &rv);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
+
+    processRequest = FM_GET_BIT(rv,
+                                FM10000_PCIE_GMBX,
+                                GlobalReqInterrupt);
+
+    processGlobalAck = FM_GET_BIT(rv,
+                                  FM10000_PCIE_GMBX,
+                                  GlobalAckInterrupt);
+
+    if (processRequest)
+    {
+        status = PCIeMailboxProcessRequest(sw, pepNb);
+    }
+    else if (processGlobalAck)
+    {
+        status = PCIeMailboxProcessGlobalAck(sw, pepNb);
+    }
+
+    return status;
+
+}   /* end ServicePepMailbox */
+
+
+
+
+/*****************************************************************************/
+/** ReenablePepMailboxInterrupt
+ * \ingroup intMailbox
+ *
+ * \desc            Re-enables the mailbox interrupt of a PEP once it has
+ *                  been serviced, waiting for the PEP to leave reset.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       pepNb is the PEP number.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status ReenablePepMailboxInterrupt(fm_int sw,
+                                             fm_int pepNb)
+{
+    fm_status  status2;
+    fm_status  maskStatus;
+    fm_uint64  regAddr;
+    fm_uint32  rv;
+    fm_uint32  retries;
+    fm_bool    pepResetState;
+
+    pepResetState = 1; /* Pep in active state*/
+
+    status2 = fm10000GetPepResetState(sw,
+                                     pepNb,
+                                     &pepResetState);
+    FM_LOG_ASSERT(FM_LOG_CAT_MAILBOX, status2==FM_OK, "Unexpected\n");
+
+    if (status2 == FM_OK)
+    {
+        retries = 0;
+        while (pepResetState == 0 && retries < PEP_RESET_RECOVERY_RETRIES)
+        {
+            /* The PEP could be in DataPathReset, retry every 1ms */
+            FM_LOG_DEBUG2(FM_LOG_CAT_MAILBOX,
+                          "PEP %d is in reset while trying to re-enable mailbox "
+                          "interrupts, retyring in 1ms\n",
+                          pepNb);
+
+            fmDelay(0, PEP_RESET_RECOVERY_DELAY);
+
+            status2 = fm10000GetPepResetState(sw,
+                                              pepNb,
+                                              &pepResetState);
+            if (status2 != FM_OK)
+            {
+                FM_LOG_ASSERT(FM_LOG_CAT_MAILBOX, status2==FM_OK, "Unexpected\n");
+                break;
+            }
+            
+            retries++;
+        }
+
+        if (status2 == FM_OK)
+        {
+            /* If pep is in active state*/
+            if (pepResetState)
+            {
+                /* Re-enable Mailbox Interrupts */
+                rv = 0;
+                FM_SET_BIT(rv, FM10000_PCIE_IP, Mailbox, 1);
+                regAddr = FM10000_PCIE_PF_ADDR(FM10000_PCIE_IM(),
+                                               pepNb);
+
+
+
+               maskStatus = fmMaskUINT32(sw,
+                                          regAddr,
+                                          rv,
+                                          FALSE);
+
+                if (maskStatus != FM_OK)
+                {
+                    FM_LOG_DEBUG(FM_LOG_CAT_MAILBOX,
+                                 "MaskUINT32 error(%d)\n",
+                                 maskStatus);
+                }
+            }
+            else
+            {
+                FM_LOG_DEBUG2(FM_LOG_CAT_MAILBOX,
+                              "Failed to re-enable interrupts on PEP %d in %d retries\n",
+                              pepNb,
+                              retries);
+            }
+        }
+    }
+
+    return status2;
+
+}   /* end ReenablePepMailboxInterrupt */
+
+
+
+
+/*****************************************************************************/
+/** LockMailbox
+ * \ingroup intMailbox
+ *
+ * \desc            Swaps the switch read lock held by the caller for the
+ *                  switch write lock and takes the mailbox lock, for the
+ *                  switch and for its switch aggregate if any.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void LockMailbox(fm_int sw)
+{
+    fm_int swToExecute;
+
+    swToExecute = sw;
+
+#if FM_SUPPORT_SWAG
+    swToExecute = GET_SWITCH_AGGREGATE_ID_IF_EXIST(sw);
+#endif
+
+    /* Take the Write lock instead of the Read one to protect the Logical Port
+     * Structure from parallel access at the application level. At this point,
+     * only the Read Switch lock was taken by the interrupt handler 
+     * thread. It would be preferable here to have the lock promoted from read 
+     * to write lock, but this can cause a deadlock if other locks have been 
+     * taken prior to this. */ 
+    UNPROTECT_SWITCH(sw);
+    
+    if (sw != swToExecute)
+    {
+        /* Take lock for SWAG switch. */
+        LOCK_SWITCH(swToExecute);
+    }
+
+    LOCK_SWITCH(sw);
+
+    if (sw != swToExecute)
+    {
+        /* Take mailbox lock for SWAG switch. */
+        FM_TAKE_MAILBOX_LOCK(swToExecute);
+    }
+
+    FM_TAKE_MAILBOX_LOCK(sw);
+
+}   /* end LockMailbox */
+
+
+
+
+/*****************************************************************************/
+/** UnlockMailbox
+ * \ingroup intMailbox
+ *
+ * \desc            Releases the locks taken by ''LockMailbox'' and takes
+ *                  the switch read lock back.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void UnlockMailbox(fm_int sw)
+{
+    fm_int swToExecute;
+
+    swToExecute = sw;
+
+#if FM_SUPPORT_SWAG
+    swToExecute = GET_SWITCH_AGGREGATE_ID_IF_EXIST(sw);
+#endif
+
+    FM_DROP_MAILBOX_LOCK(sw);
+
+    if (sw != swToExecute)
+    {
+        FM_DROP_MAILBOX_LOCK(swToExecute);
+    }
+
+    UNLOCK_SWITCH(sw);
+
+    if (sw != swToExecute)
+    {
+        UNLOCK_SWITCH(swToExecute);
+    }
+
+    /* Other threads can take the write lock in this gap. */
+    PROTECT_SWITCH(sw);
+
+}   /* end UnlockMailbox */
+
+
+
+
+/*****************************************************************************/
+/** HandleMailboxInterrupts
+ * \ingroup intMailbox
+ *
+ * \desc            Services the mailbox interrupts of a set of PEPs under
+ *                  the switch and mailbox locks.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       pepMask is the bitmask of the PEPs to service.
+ *
+ * \param[in]       batch is TRUE to process the requests of all the PEPs
+ *                  as one batch (see ''fmMailboxBeginBatch'').
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status HandleMailboxInterrupts(fm_int    sw,
+                                         fm_uint32 pepMask,
+                                         fm_bool   batch)
+{
+    fm_status  status;
+    fm_status  status2;
+    fm_status  err;
+    fm_switch *switchPtr;
+    fm_int     pepNb;
+
+    status  = FM_OK;
+    status2 = FM_OK;
+
+    LockMailbox(sw);
+
+    /* Ensure that the switch is UP, otherwise just ignore the interrupt. 
+       This is to avoid race condition. */
+    switchPtr = GET_SWITCH_PTR(sw);
+    if (switchPtr->state != FM_SWITCH_STATE_UP)
+    {
+        status = FM_ERR_SWITCH_NOT_UP;
+        goto ABORT;
+    }
+
+    if (batch)
+    {
+        fmMailboxBeginBatch(sw);
+    }
+
+    for (pepNb = 0 ; pepNb < FM10000_NUM_PEPS ; pepNb++)
+    {
+        if (pepMask & (1U << pepNb))
+        {
+            err = ServicePepMailbox(sw, pepNb);
+            FM_ERR_COMBINE(status, err);
+        }
+    }
+
+    if (batch)
+    {
+        err = FlushMailboxBatch(sw, TRUE);
+        FM_ERR_COMBINE(status, err);
+    }
 
-    status  = FM_OK;
+ABORT:
 
-    regAddr = FM10000_PCIE_GMBX();
-    rv = 0;
-    
-    FM_SET_BIT(rv,
-               FM10000_PCIE_GMBX,
-               GlobalAckInterrupt,
-               1);
+    for (pepNb = 0 ; pepNb < FM10000_NUM_PEPS ; pepNb++)
+    {
+        if (pepMask & (1U << pepNb))
+        {
+            err = ReenablePepMailboxInterrupt(sw, pepNb);
+            FM_ERR_COMBINE(status2, err);
+        }
+    }
 
-    status = fm10000WritePep(sw,
-                             regAddr,
-                             pepNb,
-                             rv);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
+    UnlockMailbox(sw);
 
-ABORT:
+    /* Another thread may have taken the switch lock when we swapped the switch
+     * write lock for the read lock. Verify there has not been a switch status
+     * change to avoid fatal conditions. */
+    if (switchPtr->state != FM_SWITCH_STATE_UP)
+    {
+        status = FM_ERR_SWITCH_NOT_UP;
+    }
 
-    FM_LOG_EXIT(FM_LOG_CAT_MAILBOX, status);
- 
-}   /* end PCIeMailboxProcessGlobalAck */
+    if (status == FM_OK && status2 != FM_OK)
+    {
+        status = status2;
+    }
+
+    return status;
+
+}   /* end HandleMailboxInterrupts */
 
 
 
@@ -1782,7 +2201,7 @@ static fm_status AllocateMailboxGlortCams(fm_int sw)
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
         size      = destEntriesUsed * sizeof(fm_glortDestEntry *);
-        destEntry = fmAlloc(size);
+        destEntry = fmAllocTagged(size, FM_LOG_CAT_MAILBOX);
 
         if (destEntry == NULL)
         {
@@ -2441,9 +2860,9 @@ static fm_status CleanupFlowResources(fm_int               sw,
 
             if (type == FM_PCIE_PORT_VF)
             {
-                status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                                    logicalPort,
-                                    (void **) &mailboxVfResources);
+                status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                                       logicalPort,
+                                       (void **) &mailboxVfResources);
                 FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
                 key = GET_FLOW_TABLE_KEY(flowId, mailboxFlowTable->tableIndex);
@@ -2521,9 +2940,9 @@ static fm_status CleanupFlowResources(fm_int               sw,
                                       &logicalPort);
         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-        status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                            logicalPort,
-                            (void **) &mailboxPfResources);
+        status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                               logicalPort,
+                               (void **) &mailboxPfResources);
         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
         /* Check if match table index is valid. */
@@ -2659,9 +3078,9 @@ static fm_status CleanupMacFilteringResources(fm_int               sw,
             macVniKey.macAddr = macFilterVal->innerMacAddr;
             macVniKey.vni     = macFilterVal->vni;
 
-            status = fmCustomTreeFind(&info->mcastMacVni,
-                                      &macVniKey,
-                                      (void **) &macVniVal);
+            status = fmCustomHashMapFind(&info->mcastMacVni,
+                                         &macVniKey,
+                                         (void **) &macVniVal);
             FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
             FM_CLEAR(listener);
@@ -2688,9 +3107,9 @@ static fm_status CleanupMacFilteringResources(fm_int               sw,
                                             macVniVal->mcastGroup);
                 FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-                status = fmCustomTreeRemoveCertain(&info->mcastMacVni,
-                                                   &macVniKey,
-                                                   fmFreeMcastMacVni);
+                status = fmCustomHashMapRemove(&info->mcastMacVni,
+                                               &macVniKey,
+                                               fmFreeMcastMacVni);
                 FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
             }
             else if (status != FM_OK)
@@ -2786,9 +3205,9 @@ static fm_status CleanupResourcesWhenDeletingLport(fm_int sw,
     info                 = GET_MAILBOX_INFO(sw);
     mailboxResourcesUsed = NULL;
 
-    status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                        portNumber,
-                        (void **) &mailboxResourcesUsed);
+    status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                           portNumber,
+                           (void **) &mailboxResourcesUsed);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
     /* Delete MAC entries associated with logical port. */
@@ -5099,9 +5518,9 @@ static fm_status ReadActionParams(fm_int                   sw,
         /* Table index and flow ID are match values, we need to remap
          * them to internal values.
          */
-        status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                            logicalPort,
-                            (void **) &mailboxResourcesUsed);
+        status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                               logicalPort,
+                               (void **) &mailboxResourcesUsed);
         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
         /* Check if match table index is valid. */
@@ -7122,9 +7541,9 @@ static void FillFlowActionData(fm_int        sw,
              * them to match values.
              */
 
-            status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                                logicalPort,
-                                (void **) &mailboxResourcesUsed);
+            status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                                   logicalPort,
+                                   (void **) &mailboxResourcesUsed);
 
             if (status != FM_OK)
             {
@@ -7332,7 +7751,7 @@ static fm_status BuildErrorResp(fm_hostSrvErr *response,
 
     status = FM_OK;
 
-    *data = fmAlloc(FM_HOST_SRV_ERR_TYPE_SIZE);
+    *data = fmAllocTagged(FM_HOST_SRV_ERR_TYPE_SIZE, FM_LOG_CAT_MAILBOX);
     if (*data == NULL)
     {
         status = FM_ERR_NO_MEM;
@@ -7424,7 +7843,7 @@ static fm_status BuildMapLportResp(fm_hostSrvLportMap *response,
 
     status = FM_OK;
 
-    *data = fmAlloc(FM_HOST_SRV_LPORT_MAP_TYPE_SIZE);
+    *data = fmAllocTagged(FM_HOST_SRV_LPORT_MAP_TYPE_SIZE, FM_LOG_CAT_MAILBOX);
     if (*data == NULL)
     {
         status = FM_ERR_NO_MEM;
@@ -7485,7 +7904,7 @@ static fm_status BuildUpdatePvidResp(fm_hostSrvUpdatePvid *response,
 
     status = FM_OK;
 
-    *data = fmAlloc(FM_HOST_SRV_UPDATE_PVID_TYPE_SIZE);
+    *data = fmAllocTagged(FM_HOST_SRV_UPDATE_PVID_TYPE_SIZE, FM_LOG_CAT_MAILBOX);
     if (*data == NULL)
     {
         status = FM_ERR_NO_MEM;
@@ -7548,7 +7967,8 @@ static fm_status BuildPacketTimestampResp(
 
     status = FM_OK;
 
-    *data = fmAlloc(FM_HOST_SRV_PACKET_TIMESTAMP_TYPE_SIZE);
+    *data = fmAllocTagged(FM_HOST_SRV_PACKET_TIMESTAMP_TYPE_SIZE,
+                          FM_LOG_CAT_MAILBOX);
     if (*data == NULL)
     {
         status = FM_ERR_NO_MEM;
@@ -7644,7 +8064,8 @@ static fm_status BuildTimestampModeResp(
 
     status = FM_OK;
 
-    *data = fmAlloc(FM_HOST_SRV_TMSTAMP_MODE_RESP_TYPE_SIZE);
+    *data = fmAllocTagged(FM_HOST_SRV_TMSTAMP_MODE_RESP_TYPE_SIZE,
+                          FM_LOG_CAT_MAILBOX);
     if (*data == NULL)
     {
         status = FM_ERR_NO_MEM;
@@ -7706,7 +8127,8 @@ static fm_status BuildMasterClkOffsetResp(
 
     status = FM_OK;
 
-    *data = fmAlloc(FM_HOST_SRV_MASTER_CLK_OFFSET_TYPE_SIZE);
+    *data = fmAllocTagged(FM_HOST_SRV_MASTER_CLK_OFFSET_TYPE_SIZE,
+                          FM_LOG_CAT_MAILBOX);
     if (*data == NULL)
     {
         status = FM_ERR_NO_MEM;
@@ -7993,9 +8415,9 @@ static fm_status BuildGetTablesResp(fm_int                    sw,
                                   &logicalPort);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-    status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                        logicalPort,
-                        (void **) &resourcesUsed);
+    status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                           logicalPort,
+                           (void **) &resourcesUsed);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
     FM_API_CALL_FAMILY(status,
@@ -8028,7 +8450,7 @@ static fm_status BuildGetTablesResp(fm_int                    sw,
 
     if (allocSize > 0)
     {
-        *data = fmAlloc(allocSize);
+        *data = fmAllocTagged(allocSize, FM_LOG_CAT_MAILBOX);
     }
     else
     {
@@ -8280,9 +8702,9 @@ static fm_status BuildGetRulesResp(fm_int               sw,
                                   &logicalPort);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-    status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                        logicalPort,
-                        (void **) &mailboxResourcesUsed);
+    status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                           logicalPort,
+                           (void **) &mailboxResourcesUsed);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
     /* Check if match table index is valid. */
@@ -8334,7 +8756,7 @@ static fm_status BuildGetRulesResp(fm_int               sw,
 
     if (allocSize > 0)
     {
-        *data = fmAlloc(allocSize);
+        *data = fmAllocTagged(allocSize, FM_LOG_CAT_MAILBOX);
     }
     else
     {
@@ -9173,7 +9595,7 @@ fm_status fm10000ProcessLoopbackRequest(fm_int                   sw,
     /* Add one more entry for transaction header */
     nbOfEntries++;
 
-    values  = fmAlloc(sizeof(fm_uint32) * nbOfEntries);
+    values  = fmAllocTagged(sizeof(fm_uint32) * nbOfEntries, FM_LOG_CAT_MAILBOX);
 
     if (values == NULL)
     {
@@ -9442,9 +9864,7 @@ void fm10000SetHostSrvErrResponse(fm_int         sw,
     fm_switch *switchPtr;
     fm10000_switch *ext;
     fm_status status;
-    fm_internalMacAddrEntry *cacheEntry;
     fm_int rowsUsed;
-    fm_int i;
     fm_int ffuRulesUsed;
     fm_int ffuRulesAvailable;
 
@@ -9455,14 +9875,7 @@ void fm10000SetHostSrvErrResponse(fm_int         sw,
     ffuRulesUsed = 0;
     ffuRulesAvailable = 0;
 
-    for (i = 0 ; i < switchPtr->macTableSize ; i++)
-    {
-        cacheEntry = &switchPtr->maTable[i];
-        if (cacheEntry->state != FM_MAC_ENTRY_STATE_INVALID)
-        {
-            rowsUsed++;
-        }
-    }
+    rowsUsed = fmAddrIndexCountValid(switchPtr);
 
     srvErr->macTableRowsUsed      = rowsUsed;
     srvErr->macTableRowsAvailable = switchPtr->macTableSize - rowsUsed;
@@ -9514,194 +9927,191 @@ void fm10000SetHostSrvErrResponse(fm_int         sw,
 fm_status fm10000PCIeMailboxInterruptHandler(fm_int sw,
                                              fm_int pepNb)
 {
-    fm_status  status;
-    fm_status  status2;
-    fm_status  maskStatus;
-    fm_switch *switchPtr;
-    fm_int     swToExecute;
-    fm_uint64  regAddr;
-    fm_uint32  rv;
-    fm_uint32  retries;
-    fm_bool    processRequest;
-    fm_bool    processGlobalAck;
-    fm_bool    pepResetState;
-    
+    fm_status status;
+
     FM_LOG_ENTRY(FM_LOG_CAT_MAILBOX,
                  "sw=%d, pepNb=%d\n",
                  sw,
                  pepNb);
 
-    status           = FM_OK;
-    processRequest   = FALSE;
-    processGlobalAck = FALSE;
-    swToExecute      = sw;
-    pepResetState    = 1; /* Pep in active state*/
-    rv               = 0;
-    
+    status = HandleMailboxInterrupts(sw, 1U << pepNb, FALSE);
+
+    FM_LOG_EXIT(FM_LOG_CAT_MAILBOX, status);
+
+}   /* end fm10000PCIeMailboxInterruptHandler */
+
+
+
+
+/*****************************************************************************/
+/** fm10000PCIeMailboxBatchInterruptHandler
+ * \ingroup intMailbox
+ *
+ * \desc            Handle the mailbox interrupts of several PEPs as one
+ *                  batch: the requests of all the PEPs are processed, the
+ *                  hardware updates they share are committed once, then
+ *                  all the responses are signaled.
+ *                                                                      \lb\lb
+ *                  Switch aggregates are handled one PEP at a time.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       pepMask is the bitmask of the PEPs with a pending
+ *                  mailbox interrupt.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000PCIeMailboxBatchInterruptHandler(fm_int    sw,
+                                                  fm_uint32 pepMask)
+{
+    fm_status status;
+    fm_bool   batch;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_MAILBOX,
+                 "sw=%d, pepMask=0x%x\n",
+                 sw,
+                 pepMask);
+
+    batch = TRUE;
+
 #if FM_SUPPORT_SWAG
-    swToExecute = GET_SWITCH_AGGREGATE_ID_IF_EXIST(sw);
+    batch = (GET_SWITCH_AGGREGATE_ID_IF_EXIST(sw) == sw);
 #endif
 
-    /* Take the Write lock instead of the Read one to protect the Logical Port
-     * Structure from parallel access at the application level. At this point,
-     * only the Read Switch lock was taken by the interrupt handler 
-     * thread. It would be preferable here to have the lock promoted from read 
-     * to write lock, but this can cause a deadlock if other locks have been 
-     * taken prior to this. */ 
-    UNPROTECT_SWITCH(sw);
-    
-    if (sw != swToExecute)
-    {
-        /* Take lock for SWAG switch. */
-        LOCK_SWITCH(swToExecute);
-    }
+    status = HandleMailboxInterrupts(sw, pepMask, batch);
 
-    LOCK_SWITCH(sw);
+    FM_LOG_EXIT(FM_LOG_CAT_MAILBOX, status);
 
-    if (sw != swToExecute)
-    {
-        /* Take mailbox lock for SWAG switch. */
-        FM_TAKE_MAILBOX_LOCK(swToExecute);
-    }
+}   /* end fm10000PCIeMailboxBatchInterruptHandler */
 
-    FM_TAKE_MAILBOX_LOCK(sw);
 
-    /* Ensure that the switch is UP, otherwise just ignore the interrupt. 
-       This is to avoid race condition. */
-    switchPtr = GET_SWITCH_PTR(sw);
-    if (switchPtr->state != FM_SWITCH_STATE_UP)
-    {
-        status = FM_ERR_SWITCH_NOT_UP;
-        goto ABORT;
-    }
 
-    regAddr = FM10000_PCIE_GMBX();
 
-    status = fm10000ReadPep(sw,
-                            regAddr,
-                            pepNb,
-                            &rv);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
+/*****************************************************************************/
+/** fm10000MailboxServicePeps
+ * \ingroup intMailbox
+ *
+ * \desc            Services the mailboxes of a set of PEPs on behalf of a
+ *                  mailbox worker thread (see api.mailbox.workerThreads).
+ *                                                                      \lb\lb
+ *                  Only the requests are processed under the switch write
+ *                  lock and the mailbox lock, since they update state
+ *                  shared by all the PEPs. Reading the interrupt cause,
+ *                  acknowledging a global ack and re-enabling the interrupt,
+ *                  which may wait for the PEP to leave reset, only access
+ *                  the registers of the PEP and are done under the switch
+ *                  read lock, so the workers of other PEPs are not held up.
+ *                  A PEP is only ever serviced by one worker.
+ *
+ * \param[in]       sw is the switch on which to operate. The caller holds
+ *                  the switch read lock.
+ *
+ * \param[in]       pepMask is the bitmask of the PEPs to service.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000MailboxServicePeps(fm_int    sw,
+                                    fm_uint32 pepMask)
+{
+    fm_switch *switchPtr;
+    fm_status  status;
+    fm_status  err;
+    fm_uint32  requestMask;
+    fm_uint32  rv;
+    fm_int     pepNb;
+    fm_bool    batch;
 
-    processRequest = FM_GET_BIT(rv,
-                                FM10000_PCIE_GMBX,
-                                GlobalReqInterrupt);
+    FM_LOG_ENTRY(FM_LOG_CAT_MAILBOX,
+                 "sw=%d, pepMask=0x%x\n",
+                 sw,
+                 pepMask);
 
-    processGlobalAck = FM_GET_BIT(rv,
-                                  FM10000_PCIE_GMBX,
-                                  GlobalAckInterrupt);
+    switchPtr   = GET_SWITCH_PTR(sw);
+    status      = FM_OK;
+    requestMask = 0;
 
-    if (processRequest)
-    {
-        status = PCIeMailboxProcessRequest(sw, pepNb);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
-    }
-    else if (processGlobalAck)
+    for (pepNb = 0 ; pepNb < FM10000_NUM_PEPS ; pepNb++)
     {
-        status = PCIeMailboxProcessGlobalAck(sw, pepNb);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
-    }
+        if ( (pepMask & (1U << pepNb)) == 0 )
+        {
+            continue;
+        }
 
-ABORT:
+        rv  = 0;
+        err = fm10000ReadPep(sw, FM10000_PCIE_GMBX(), pepNb, &rv);
 
-    status2 = fm10000GetPepResetState(sw,
-                                     pepNb,
-                                     &pepResetState);
-    FM_LOG_ASSERT(FM_LOG_CAT_MAILBOX, status2==FM_OK, "Unexpected\n");
+        if (err != FM_OK)
+        {
+            FM_ERR_COMBINE(status, err);
+        }
+        else if ( FM_GET_BIT(rv, FM10000_PCIE_GMBX, GlobalReqInterrupt) )
+        {
+            requestMask |= (1U << pepNb);
+        }
+        else if ( FM_GET_BIT(rv, FM10000_PCIE_GMBX, GlobalAckInterrupt) )
+        {
+            err = PCIeMailboxProcessGlobalAck(sw, pepNb);
+            FM_ERR_COMBINE(status, err);
+        }
+    }
 
-    if (status2 == FM_OK)
+    if (requestMask != 0)
     {
-        retries = 0;
-        while (pepResetState == 0 && retries < PEP_RESET_RECOVERY_RETRIES)
+        batch = GET_FM10000_PROPERTY()->mailboxBatchRequests;
+
+#if FM_SUPPORT_SWAG
+        if (GET_SWITCH_AGGREGATE_ID_IF_EXIST(sw) != sw)
         {
-            /* The PEP could be in DataPathReset, retry every 1ms */
-            FM_LOG_DEBUG2(FM_LOG_CAT_MAILBOX,
-                          "PEP %d is in reset while trying to re-enable mailbox "
-                          "interrupts, retyring in 1ms\n",
-                          pepNb);
+            batch = FALSE;
+        }
+#endif
 
-            fmDelay(0, PEP_RESET_RECOVERY_DELAY);
+        LockMailbox(sw);
 
-            status2 = fm10000GetPepResetState(sw,
-                                              pepNb,
-                                              &pepResetState);
-            if (status2 != FM_OK)
+        if (switchPtr->state == FM_SWITCH_STATE_UP)
+        {
+            if (batch)
             {
-                FM_LOG_ASSERT(FM_LOG_CAT_MAILBOX, status2==FM_OK, "Unexpected\n");
-                break;
+                fmMailboxBeginBatch(sw);
             }
-            
-            retries++;
-        }
 
-        if (status2 == FM_OK)
-        {
-            /* If pep is in active state*/
-            if (pepResetState)
+            for (pepNb = 0 ; pepNb < FM10000_NUM_PEPS ; pepNb++)
             {
-                /* Re-enable Mailbox Interrupts */
-                rv = 0;
-                FM_SET_BIT(rv, FM10000_PCIE_IP, Mailbox, 1);
-                regAddr = FM10000_PCIE_PF_ADDR(FM10000_PCIE_IM(),
-                                               pepNb);
-
-
-
-               maskStatus = fmMaskUINT32(sw,
-                                          regAddr,
-                                          rv,
-                                          FALSE);
-
-                if (maskStatus != FM_OK)
+                if (requestMask & (1U << pepNb))
                 {
-                    FM_LOG_DEBUG(FM_LOG_CAT_MAILBOX,
-                                 "MaskUINT32 error(%d)\n",
-                                 maskStatus);
+                    err = PCIeMailboxProcessRequest(sw, pepNb);
+                    FM_ERR_COMBINE(status, err);
                 }
             }
-            else
+
+            if (batch)
             {
-                FM_LOG_DEBUG2(FM_LOG_CAT_MAILBOX,
-                              "Failed to re-enable interrupts on PEP %d in %d retries\n",
-                              pepNb,
-                              retries);
+                err = FlushMailboxBatch(sw, TRUE);
+                FM_ERR_COMBINE(status, err);
             }
         }
-    }
-
-    FM_DROP_MAILBOX_LOCK(sw);
-
-    if (sw != swToExecute)
-    {
-        FM_DROP_MAILBOX_LOCK(swToExecute);
-    }
-
-    UNLOCK_SWITCH(sw);
-
-    if (sw != swToExecute)
-    {
-        UNLOCK_SWITCH(swToExecute);
-    }
-
-    /* Other threads can take the write lock in this gap. */
-    PROTECT_SWITCH(sw);
+        else
+        {
+            status = FM_ERR_SWITCH_NOT_UP;
+        }
 
-    /* Another thread may have taken the switch lock when we swapped the switch
-     * write lock for the read lock. Verify there has not been a switch status
-     * change to avoid fatal conditions. */
-    if (switchPtr->state != FM_SWITCH_STATE_UP)
-    {
-        status = FM_ERR_SWITCH_NOT_UP;
+        UnlockMailbox(sw);
     }
 
-    if (status == FM_OK && status2 != FM_OK)
+    for (pepNb = 0 ; pepNb < FM10000_NUM_PEPS ; pepNb++)
     {
-        status = status2;
+        if (pepMask & (1U << pepNb))
+        {
+            err = ReenablePepMailboxInterrupt(sw, pepNb);
+            FM_ERR_COMBINE(status, err);
+        }
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_MAILBOX, status);
 
-}   /* end fm10000PCIeMailboxInterruptHandler */
+}   /* end fm10000MailboxServicePeps */
 
 
 
@@ -9732,7 +10142,8 @@ fm_status fm10000MailboxAllocateDataStructures(fm_int sw)
 
     nbytes = sizeof(fm_int) * FM10000_NUM_PEPS;
 
-    info->numberOfVirtualPortsAddedToUcastFlood = fmAlloc(nbytes);
+    info->numberOfVirtualPortsAddedToUcastFlood = fmAllocTagged(nbytes,
+                                                                FM_LOG_CAT_MAILBOX);
 
     if (info->numberOfVirtualPortsAddedToUcastFlood == NULL)
     {
@@ -9740,7 +10151,8 @@ fm_status fm10000MailboxAllocateDataStructures(fm_int sw)
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
     }
 
-    info->numberOfVirtualPortsAddedToMcastFlood = fmAlloc(nbytes);
+    info->numberOfVirtualPortsAddedToMcastFlood = fmAllocTagged(nbytes,
+                                                                FM_LOG_CAT_MAILBOX);
 
     if (info->numberOfVirtualPortsAddedToMcastFlood == NULL)
     {
@@ -9748,7 +10160,8 @@ fm_status fm10000MailboxAllocateDataStructures(fm_int sw)
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
     }
 
-    info->numberOfVirtualPortsAddedToBcastFlood = fmAlloc(nbytes);
+    info->numberOfVirtualPortsAddedToBcastFlood = fmAllocTagged(nbytes,
+                                                                FM_LOG_CAT_MAILBOX);
 
     if (info->numberOfVirtualPortsAddedToBcastFlood == NULL)
     {
@@ -10236,11 +10649,11 @@ fm_status fm10000FreeVirtualLogicalPort(fm_int  sw,
         status = fmFreeLogicalPort(sw, firstPort + i);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-        if (fmTreeIsInitialized(&info->mailboxResourcesPerVirtualPort))
+        if (fmHashMapIsInitialized(&info->mailboxResourcesPerVirtualPort))
         {
-            status = fmTreeRemove(&info->mailboxResourcesPerVirtualPort,
-                                  firstPort + i,
-                                  fmFree);
+            status = fmHashMapRemove(&info->mailboxResourcesPerVirtualPort,
+                                     firstPort + i,
+                                     fmFree);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
         }
     }
@@ -11080,7 +11493,7 @@ fm_status fm10000MailboxConfigureCounters(fm_int sw)
 
     nbytes = sizeof(fm_int) * FM10000_NUM_PEPS;
 
-    info->macEntriesAdded = fmAlloc(nbytes);
+    info->macEntriesAdded = fmAllocTagged(nbytes, FM_LOG_CAT_MAILBOX);
 
     if (info->macEntriesAdded == NULL)
     {
@@ -11090,7 +11503,7 @@ fm_status fm10000MailboxConfigureCounters(fm_int sw)
 
     FM_CLEAR(*info->macEntriesAdded);
 
-    info->innerOuterMacEntriesAdded = fmAlloc(nbytes);
+    info->innerOuterMacEntriesAdded = fmAllocTagged(nbytes, FM_LOG_CAT_MAILBOX);
 
     if (info->innerOuterMacEntriesAdded == NULL)
     {
@@ -396,6 +396,124 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** WriteMirrorConditions
+ * \ingroup intMirror
+ *
+ * \desc            Writes the trigger conditions of a mirror group from its
+ *                  current VLAN, ACL, sampling and port set state. The mirror
+ *                  profile and the trigger actions are left untouched.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       grp points to the mirror group structure.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status WriteMirrorConditions(fm_int              sw,
+                                       fm_portMirrorGroup *grp)
+{
+    fm10000_switch *            switchExt;
+    fm_fm10000PortMirrorGroup * grpExt;
+    fm_triggerCondition         trigCondition;
+    fm_int                      group;
+    fm_status                   err;
+
+    group     = grp->groupId;
+    switchExt = GET_SWITCH_EXT(sw);
+    grpExt    = &switchExt->mirrorGroups[group];
+
+    /* Configure the Trigger Conditions */
+    err = fmInitTriggerCondition(sw, &trigCondition);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
+
+    /* VLAN Condition */
+    if ( (grpExt->vlanResId != FM10000_MIRROR_NO_VLAN_RES) &&
+         (grp->mirrorType == FM_MIRROR_TYPE_EGRESS) )
+    {
+        trigCondition.cfg.matchVlan = FM_TRIGGER_MATCHCASE_MATCHIFEQUAL;
+        trigCondition.param.vidId = grpExt->vlanResId;
+    }
+
+    /* ACL Condition */
+    if (grpExt->ffuResId != FM10000_MIRROR_NO_FFU_RES)
+    {
+        trigCondition.cfg.matchFFU = FM_TRIGGER_MATCHCASE_MATCHIFEQUAL;
+        trigCondition.param.ffuId = grpExt->ffuResId;
+        trigCondition.param.ffuIdMask = grpExt->ffuResIdMask;
+    }
+
+    /* Sampling Condition */
+    if ( (grp->sample != FM_MIRROR_SAMPLE_RATE_DISABLED) &&
+         (grp->sample > 1) )
+    {
+        trigCondition.cfg.matchRandomNumber = TRUE;
+        trigCondition.param.randGenerator = FM_TRIGGER_RAND_GEN_A;
+        trigCondition.param.randMatchThreshold =
+            ((FM10000_MIRROR_TRIG_MAX_SAMPLE + 1) / grp->sample) - 1;
+    }
+
+    trigCondition.cfg.rxPortset = grpExt->rxPortSet;
+
+    if (grp->mirrorType == FM_MIRROR_TYPE_EGRESS)
+    {
+        trigCondition.cfg.matchTx = FM_TRIGGER_TX_MASK_CONTAINS;
+        trigCondition.cfg.txPortset = grpExt->txPortSet;
+    }
+    else
+    {
+        trigCondition.cfg.matchTx = FM_TRIGGER_TX_MASK_DOESNT_CONTAIN;
+        trigCondition.cfg.txPortset = FM_PORT_SET_NONE;
+    }
+
+    /* Mirror all frames */
+    trigCondition.cfg.matchFtypeMask = (FM_TRIGGER_FTYPE_NORMAL |
+                                        FM_TRIGGER_FTYPE_SPECIAL);
+    trigCondition.cfg.HAMask = 0xffffffffffffffffLL;
+
+    /* First Trigger */
+    err = fm10000SetTriggerCondition(sw,
+                                     FM10000_TRIGGER_GROUP_MIRROR,
+                                     MIRROR_RULE(group, 0),
+                                     &trigCondition,
+                                     TRUE);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
+
+    /* Bidirectional mirror type uses the second trigger to cover the
+       Egress direction. */
+    if (grp->mirrorType == FM_MIRROR_TYPE_BIDIRECTIONAL)
+    {
+        /* VLAN Condition */
+        if (grpExt->vlanResId != FM10000_MIRROR_NO_VLAN_RES)
+        {
+            trigCondition.cfg.matchVlan = FM_TRIGGER_MATCHCASE_MATCHIFEQUAL;
+            trigCondition.param.vidId = grpExt->vlanResId;
+        }
+
+        trigCondition.cfg.rxPortset = FM_PORT_SET_ALL;
+        trigCondition.cfg.matchTx = FM_TRIGGER_TX_MASK_CONTAINS;
+        trigCondition.cfg.txPortset = grpExt->txPortSet;
+
+        /* Second Trigger */
+        err = fm10000SetTriggerCondition(sw,
+                                         FM10000_TRIGGER_GROUP_MIRROR,
+                                         MIRROR_RULE(group, 1),
+                                         &trigCondition,
+                                         TRUE);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
+
+    }
+
+ABORT:
+
+    return err;
+
+}   /* end WriteMirrorConditions */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -863,7 +981,6 @@ fm_status fm10000WritePortMirrorGroup(fm_int              sw,
     fm10000_mirrorCfg           config;
     fm_int                      group;
     fm_triggerAction            trigAction;
-    fm_triggerCondition         trigCondition;
     fm_int                      cpi;
     fm_status                   err;
 
@@ -945,36 +1062,6 @@ fm_status fm10000WritePortMirrorGroup(fm_int              sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
     }
 
-    /* Configure the Trigger Conditions */
-    err = fmInitTriggerCondition(sw, &trigCondition);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
-
-    /* VLAN Condition */
-    if ( (grpExt->vlanResId != FM10000_MIRROR_NO_VLAN_RES) &&
-         (grp->mirrorType == FM_MIRROR_TYPE_EGRESS) )
-    {
-        trigCondition.cfg.matchVlan = FM_TRIGGER_MATCHCASE_MATCHIFEQUAL;
-        trigCondition.param.vidId = grpExt->vlanResId;
-    }
-
-    /* ACL Condition */
-    if (grpExt->ffuResId != FM10000_MIRROR_NO_FFU_RES)
-    {
-        trigCondition.cfg.matchFFU = FM_TRIGGER_MATCHCASE_MATCHIFEQUAL;
-        trigCondition.param.ffuId = grpExt->ffuResId;
-        trigCondition.param.ffuIdMask = grpExt->ffuResIdMask;
-    }
-
-    /* Sampling Condition */
-    if ( (grp->sample != FM_MIRROR_SAMPLE_RATE_DISABLED) &&
-         (grp->sample > 1) )
-    {
-        trigCondition.cfg.matchRandomNumber = TRUE;
-        trigCondition.param.randGenerator = FM_TRIGGER_RAND_GEN_A;
-        trigCondition.param.randMatchThreshold =
-            ((FM10000_MIRROR_TRIG_MAX_SAMPLE + 1) / grp->sample) - 1;
-    }
-
     /* Rebuild the Rx PortSet based on the Ingress Ports selected */
     if (grpExt->rxPortSet != FM_PORT_SET_ALL)
     {
@@ -1017,62 +1104,114 @@ fm_status fm10000WritePortMirrorGroup(fm_int              sw,
         }
     }
 
-    trigCondition.cfg.rxPortset = grpExt->rxPortSet;
+    err = WriteMirrorConditions(sw, grp);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
 
-    if (grp->mirrorType == FM_MIRROR_TYPE_EGRESS)
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_MIRROR, err);
+
+}   /* end fm10000WritePortMirrorGroup */
+
+
+
+
+/*****************************************************************************/
+/** fm10000UpdateMirrorGroupPorts
+ * \ingroup intMirror
+ *
+ * \desc            Brings the hardware in line with the ingress and egress
+ *                  membership of the listed ports after the caller changed
+ *                  them in the mirror group. Only the Rx and Tx port sets
+ *                  entries of those ports and the trigger conditions are
+ *                  rewritten. Called through the UpdateMirrorGroupPorts
+ *                  function pointer.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       grp points to the mirror group structure.
+ *
+ * \param[in]       numPorts is the number of ports in portList.
+ *
+ * \param[in]       portList is the list of logical ports whose membership
+ *                  changed.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000UpdateMirrorGroupPorts(fm_int              sw,
+                                        fm_portMirrorGroup *grp,
+                                        fm_int              numPorts,
+                                        fm_int *            portList)
+{
+    fm_switch *                 switchPtr;
+    fm10000_switch *            switchExt;
+    fm_fm10000PortMirrorGroup * grpExt;
+    fm_port *                   portPtr;
+    fm_bool                     ingress;
+    fm_bool                     egress;
+    fm_int                      i;
+    fm_status                   err = FM_OK;
+
+    FM_LOG_ENTRY( FM_LOG_CAT_MIRROR,
+                  "sw = %d, grp = %p (%d), numPorts = %d\n",
+                  sw,
+                  (void *) grp,
+                  grp->groupId,
+                  numPorts );
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    switchExt = GET_SWITCH_EXT(sw);
+    grpExt    = &switchExt->mirrorGroups[grp->groupId];
+
+    /* The profile and actions only depend on the destination */
+    if (grp->mirrorPortType != FM_PORT_IDENTIFIER_PORT_NUMBER)
     {
-        trigCondition.cfg.matchTx = FM_TRIGGER_TX_MASK_CONTAINS;
-        trigCondition.cfg.txPortset = grpExt->txPortSet;
+        err = FM_ERR_UNSUPPORTED;
+        FM_LOG_EXIT(FM_LOG_CAT_MIRROR, err);
     }
-    else
+
+    for (i = 0 ; i < numPorts ; i++)
     {
-        trigCondition.cfg.matchTx = FM_TRIGGER_TX_MASK_DOESNT_CONTAIN;
-        trigCondition.cfg.txPortset = FM_PORT_SET_NONE;
-    }
+        portPtr = switchPtr->portTable[portList[i]];
 
-    /* Mirror all frames */
-    trigCondition.cfg.matchFtypeMask = (FM_TRIGGER_FTYPE_NORMAL |
-                                        FM_TRIGGER_FTYPE_SPECIAL);
-    trigCondition.cfg.HAMask = 0xffffffffffffffffLL;
+        err = fmGetBitArrayBit(&grp->ingressPortUsed,
+                               portPtr->portIndex,
+                               &ingress);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
 
-    /* First Trigger */
-    err = fm10000SetTriggerCondition(sw,
-                                     FM10000_TRIGGER_GROUP_MIRROR,
-                                     MIRROR_RULE(group, 0),
-                                     &trigCondition,
-                                     TRUE);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
+        err = fmGetBitArrayBit(&grp->egressPortUsed,
+                               portPtr->portIndex,
+                               &egress);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
 
-    /* Bidirectional mirror type uses the second trigger to cover the
-       Egress direction. */
-    if (grp->mirrorType == FM_MIRROR_TYPE_BIDIRECTIONAL)
-    {
-        /* VLAN Condition */
-        if (grpExt->vlanResId != FM10000_MIRROR_NO_VLAN_RES)
+        if (grpExt->rxPortSet != FM_PORT_SET_ALL)
         {
-            trigCondition.cfg.matchVlan = FM_TRIGGER_MATCHCASE_MATCHIFEQUAL;
-            trigCondition.param.vidId = grpExt->vlanResId;
+            err = fmSetPortSetPortInt(sw,
+                                      grpExt->rxPortSet,
+                                      portList[i],
+                                      ingress);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
         }
 
-        trigCondition.cfg.rxPortset = FM_PORT_SET_ALL;
-        trigCondition.cfg.matchTx = FM_TRIGGER_TX_MASK_CONTAINS;
-        trigCondition.cfg.txPortset = grpExt->txPortSet;
-
-        /* Second Trigger */
-        err = fm10000SetTriggerCondition(sw,
-                                         FM10000_TRIGGER_GROUP_MIRROR,
-                                         MIRROR_RULE(group, 1),
-                                         &trigCondition,
-                                         TRUE);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
-
+        if (grpExt->txPortSet != FM_PORT_SET_ALL)
+        {
+            err = fmSetPortSetPortInt(sw,
+                                      grpExt->txPortSet,
+                                      portList[i],
+                                      egress);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
+        }
     }
 
+    err = WriteMirrorConditions(sw, grp);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
+
 ABORT:
 
     FM_LOG_EXIT(FM_LOG_CAT_MIRROR, err);
 
-}   /* end fm10000WritePortMirrorGroup */
+}   /* end fm10000UpdateMirrorGroupPorts */
 
 
 
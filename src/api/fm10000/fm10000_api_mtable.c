@@ -66,6 +66,10 @@ portmask.maskWord[2] = 0;
  * all the segments in the memory should be scheduled. */
 #define EPOCH_USAGE_SCAN_INTERVAL 3000000
 
+/* Number of MCAST_VLAN_TABLE entries recovered between two checks of the
+ * cleanup time budget. */
+#define CLEANUP_BUDGET_CHECK_INTERVAL 32
+
 /* definition of a structure of listeners count */
 typedef struct _MTableListenersCount
 {
@@ -96,6 +100,38 @@ typedef enum
 
 } fm10000_MTableID;
 
+
+/* Per physical port state used while adding a list of listeners */
+typedef struct _MTableBatchPort
+{
+    /* number of forwarding listeners being added on the port */
+    fm_int    addCount;
+
+    /* number of active listeners the port already has */
+    fm_int    oldCount;
+
+    /* MCAST_LEN_TABLE entry of the port in the current block, 0 if none */
+    fm_int    oldLenIndex;
+
+    /* MCAST_LEN_TABLE entry of the port in the new block */
+    fm_int    newLenIndex;
+
+    /* current value of the port's MCAST_LEN_TABLE entry */
+    fm_uint32 lenTableReg;
+
+    /* first MCAST_VLAN_TABLE entry of the port's block, before and after */
+    fm_int    oldVlanIndex;
+    fm_int    newVlanIndex;
+
+    /* MCAST_VLAN_TABLE entries reserved for the port */
+    fm_int    resvIndex;
+    fm_int    resvCount;
+
+    /* next MCAST_VLAN_TABLE entry to fill */
+    fm_int    nextVlanIndex;
+
+} fm10000_MTableBatchPort;
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -134,11 +170,18 @@ static fm_status MarkVlanIndexAvailable(fm10000_mtableInfo *info, fm_int index);
 static fm_status MarkVlanIndexUsed(fm10000_mtableInfo *info, fm_int index);
 static fm_status MarkVlanIndexExpired(fm10000_mtableInfo *info, fm_int index);
 static fm_bool   VlanIndexInUse(fm10000_mtableInfo *info, fm_int index );
+static fm_status GetVlanIndexExpired(fm10000_mtableInfo *info,
+                                     fm_int              index,
+                                     fm_bool *           expired);
 static fm_status FindUnusedVlanTableBlock(fm_int             sw,
                                           fm10000_mtableInfo *info,
                                           fm_int             size,
                                           fm_int *           index);
-static fm_status RecoverExpiredVlanIndices(fm_int sw, fm10000_mtableInfo *info);
+static fm_status RecoverExpiredVlanIndices(fm_int              sw,
+                                           fm10000_mtableInfo *info,
+                                           fm_uint64           budget);
+static fm_status GetTableFragmentation(fm_bitArray *            usage,
+                                       fm10000_mtableFragStats *stats);
 static fm_status MarkLenTableIndexAvailable(fm10000_mtableInfo *info, fm_int index);
 static fm_status MarkLenTableIndexUsed(fm10000_mtableInfo *info, fm_int index);
 static fm_status MarkLenTableIndexExpired(fm10000_mtableInfo *info, fm_int index);
@@ -452,9 +495,7 @@ static fm_status ValidateMTableConsistency(fm_int sw)
                                      vlanIndex);
                     }
 
-                    err = fmGetBitArrayBit(&info->clonedEntriesBitArray,
-                                           vlanIndex,
-                                           &expiring);
+                    err = GetVlanIndexExpired(info, vlanIndex, &expiring);
                     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
                     if (expiring)
                     {
@@ -1738,6 +1779,45 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** BuildVlanTableEntry
+ *
+ * \desc            Builds the MCAST_VLAN_TABLE entry for a listener.
+ *
+ * \param[in]       listener points to the listener.
+ *
+ * \return          The MCAST_VLAN_TABLE register value.
+ *
+ *****************************************************************************/
+static fm_uint64 BuildVlanTableEntry(fm10000_mtableEntry *listener)
+{
+    fm_uint64 vlanTableReg;
+
+    FM_CLEAR(vlanTableReg);
+    FM_SET_FIELD64( vlanTableReg,
+                    FM10000_MOD_MCAST_VLAN_TABLE,
+                    VID,
+                    listener->vlan );
+    FM_SET_FIELD64( vlanTableReg,
+                    FM10000_MOD_MCAST_VLAN_TABLE,
+                    DGLORT,
+                    listener->dglort );
+    FM_SET_BIT64( vlanTableReg, 
+                  FM10000_MOD_MCAST_VLAN_TABLE, 
+                  ReplaceVID, 
+                  listener->vlanUpdate );
+    FM_SET_BIT64( vlanTableReg, 
+                  FM10000_MOD_MCAST_VLAN_TABLE, 
+                  ReplaceDGLORT, 
+                  listener->dglortUpdate );
+
+    return vlanTableReg;
+
+}   /* end BuildVlanTableEntry */
+
+
+
+
 /*****************************************************************************/
 /** AddListener
  *
@@ -1814,23 +1894,7 @@ static fm_status AddListener(fm_int               sw,
                  L3_Repcnt,
                  activeCount);
 
-    FM_CLEAR(vlanTableReg);
-    FM_SET_FIELD64( vlanTableReg,
-                    FM10000_MOD_MCAST_VLAN_TABLE,
-                    VID,
-                    listener.vlan );
-    FM_SET_FIELD64( vlanTableReg,
-                    FM10000_MOD_MCAST_VLAN_TABLE,
-                    DGLORT,
-                    listener.dglort );
-    FM_SET_BIT64( vlanTableReg, 
-                  FM10000_MOD_MCAST_VLAN_TABLE, 
-                  ReplaceVID, 
-                  listener.vlanUpdate );
-    FM_SET_BIT64( vlanTableReg, 
-                  FM10000_MOD_MCAST_VLAN_TABLE, 
-                  ReplaceDGLORT, 
-                  listener.dglortUpdate );
+    vlanTableReg = BuildVlanTableEntry(&listener);
     
     listenerIndex = finalVlanIndex + activeCount;
     /* listenerIndex should be reserved for this group before calling this function */
@@ -1886,33 +1950,176 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** StartMTableCleanup
+ * \ingroup intMulticast
+ *
+ * \desc            Starts an MTable cleanup by switching to the other
+ *                  epoch. The MCAST_VLAN_TABLE entries expired so far are
+ *                  recovered once the hardware is done with the old epoch.
+ *
+ * \param[in]       sw the switch on which to operate
+ *
+ * \param[in]       info points to the state structure that holds the
+ *                  mtable management state.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status StartMTableCleanup(fm_int sw, fm10000_mtableInfo *info)
+{
+    fm_switch * switchPtr;
+    fm_bitArray expiredEntries;
+    fm_status   err;
+    fm_byte     newEpoch;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,
+                 "MTable Cleanup: cloned=%d - watermark=%d\n",
+                 info->clonedEntriesCount,
+                 info->clonedEntriesWatermark);
+
+    newEpoch = (info->epoch == 0) ? 1 : 0;
+
+    err = switchPtr->WriteUINT32( sw,
+                                  FM10000_MCAST_EPOCH(),
+                                  newEpoch );
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    /* Entries that expire from now on may be in use by frames of the new
+     * epoch, so they are left for the next cleanup. recoveringEntriesBitArray
+     * is empty whenever no cleanup is ongoing. */
+    expiredEntries                  = info->recoveringEntriesBitArray;
+    info->recoveringEntriesBitArray = info->clonedEntriesBitArray;
+    info->clonedEntriesBitArray     = expiredEntries;
+
+    info->cleanupEpoch   = info->epoch;
+    info->epoch          = newEpoch;
+    info->cleanupDrained = FALSE;
+    info->cleanupIndex   = 0;
+    info->cleanupRetries = 0;
+    info->cleanupOnGoing = TRUE;
+
+    return FM_OK;
+
+}   /* end StartMTableCleanup */
+
+
+
+
+/*****************************************************************************/
+/** ContinueMTableCleanup
+ * \ingroup intMulticast
+ *
+ * \desc            Performs the next step of the ongoing MTable cleanup.
+ *
+ * \param[in]       sw the switch on which to operate
+ *
+ * \param[in]       info points to the state structure that holds the
+ *                  mtable management state.
+ *
+ * \param[in]       budget is the maximum time, in nanoseconds, to spend
+ *                  recovering entries. 0 means no limit.
+ *
+ * \param[in]       waitForEpoch is TRUE to wait for the old epoch to drain,
+ *                  FALSE to return and retry on the next call.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status ContinueMTableCleanup(fm_int              sw,
+                                       fm10000_mtableInfo *info,
+                                       fm_uint64           budget,
+                                       fm_bool             waitForEpoch)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+    fm_uint32  prevEpochCounter;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    while (!info->cleanupDrained)
+    {
+        err = switchPtr->ReadUINT32( sw,
+                                     FM10000_MCAST_EPOCH_USAGE(info->cleanupEpoch),
+                                     &prevEpochCounter );
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+        if (prevEpochCounter == 0)
+        {
+            info->cleanupDrained = TRUE;
+            break;
+        }
+
+        info->cleanupRetries++;
+
+        if (!waitForEpoch)
+        {
+            return FM_OK;
+        }
+
+        fmDelay(0, EPOCH_USAGE_SCAN_INTERVAL);
+    }
+
+    err = RecoverExpiredVlanIndices(sw, info, budget);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    if (info->cleanupIndex < 0)
+    {
+        info->cleanupOnGoing = FALSE;
+        info->cleanupCount++;
+
+        FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,
+                     "MTable Cleanup done after %d retries: cloned=%d\n",
+                     info->cleanupRetries,
+                     info->clonedEntriesCount);
+
+#ifdef FM_DEBUG_CHECK_CONSISTENCY
+        ValidateMTableConsistency(sw);
+#endif
+    }
+
+    return FM_OK;
+
+}   /* end ContinueMTableCleanup */
+
+
+
+
 /*****************************************************************************/
 /** MTableCleanup
  * \ingroup intMulticast
  *
  * \desc            Function to cleanup MTable expired resources.
+ *                                                                      \lb\lb
+ *                  Unless forced, a cleanup is started when clonedEntries
+ *                  is higher than the watermark, or when the largest free
+ *                  block of the MCAST_VLAN_TABLE is smaller than the
+ *                  configured size. A started cleanup is performed in
+ *                  steps: each call polls the old epoch once and then
+ *                  recovers expired entries within the time budget.
  *
  * \param[in]       sw the switch on which to operate
  *
  * \param[in]       forceClean specifies if this cleanup has to be performed
- *                  irrespective of clonedEntries being higher than the watermark.
+ *                  irrespective of clonedEntries being higher than the
+ *                  watermark. A forced cleanup completes the ongoing one,
+ *                  if any, then recovers all expired entries before
+ *                  returning.
  *
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
 static fm_status MTableCleanup(fm_int sw, fm_bool forceClean)
 {
-    fm_switch          *switchPtr;
-    fm10000_mtableInfo *info;
-    fm_status           err = FM_OK;
-    fm_byte             newEpoch;
-    fm_byte             oldEpoch;
-    fm_uint32           prevEpochCounter;
+    fm10000_mtableInfo *    info;
+    fm10000_mtableFragStats fragStats;
+    fm_status               err = FM_OK;
 
     FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_MULTICAST, "sw = %d\n", sw);
 
-    switchPtr = GET_SWITCH_PTR(sw);
-    info      = GET_MTABLE_INFO(sw);
+    info = GET_MTABLE_INFO(sw);
 
     /* wait for the MTABLE to be initialized */
     if ( info->isInitialized == FALSE )
@@ -1921,45 +2128,72 @@ static fm_status MTableCleanup(fm_int sw, fm_bool forceClean)
         FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
     }
 
-    /* Proceed to cleanup when clonedEntries is greater than watermark% of remaining
-     * available entries or forceClean is enabled. */
-    if (info->clonedEntriesCount <= info->clonedEntriesWatermark && !forceClean )
+    if (forceClean)
     {
+        if (info->cleanupOnGoing)
+        {
+            err = ContinueMTableCleanup(sw, info, 0, TRUE);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+        }
+
+        if (info->clonedEntriesCount == 0)
+        {
+            FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
+        }
+
+        err = StartMTableCleanup(sw, info);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+        info->forcedCleanupCount++;
+
+        err = ContinueMTableCleanup(sw, info, 0, TRUE);
         FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
     }
-    //else
-    FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,
-                 "MTable Cleanup: cloned=%d - watermark=%d\n",
-                 info->clonedEntriesCount,
-                 info->clonedEntriesWatermark);
 
-    oldEpoch = info->epoch;
-    newEpoch = (oldEpoch == 0) ? 1 : 0;
+    if (!info->cleanupOnGoing)
+    {
+        if (info->clonedEntriesCount == 0)
+        {
+            FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
+        }
 
-    err = switchPtr->WriteUINT32( sw,
-                                  FM10000_MCAST_EPOCH(),
-                                  newEpoch );
-    FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_MULTICAST, err );
-    info->epoch = newEpoch;
+        /* Proceed to cleanup when clonedEntries is greater than watermark%
+         * of remaining available entries. */
+        if (info->clonedEntriesCount <= info->clonedEntriesWatermark)
+        {
+            /* Otherwise, start early when the free space is so fragmented
+             * that a new block may soon not be found. */
+            if ( (info->cleanupFreeBlock <= 0) ||
+                 (info->vlanTableCount == info->fragCheckVlanTableCount) )
+            {
+                FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
+            }
 
-    prevEpochCounter = 0;
-    do
-    {
-        err = switchPtr->ReadUINT32( sw,
-                                     FM10000_MCAST_EPOCH_USAGE(oldEpoch),
-                                     &prevEpochCounter );
-        FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_MULTICAST, err );
+            info->fragCheckVlanTableCount = info->vlanTableCount;
 
-        fmDelay(0, EPOCH_USAGE_SCAN_INTERVAL);
+            err = GetTableFragmentation(&info->vlanTableUsage, &fragStats);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
-    } while (prevEpochCounter != 0);
+            if (fragStats.largestFreeBlock >= info->cleanupFreeBlock)
+            {
+                FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
+            }
 
-    err = RecoverExpiredVlanIndices(sw, info);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+            FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,
+                         "MTable fragmented: largest free block %d, "
+                         "%d free blocks\n",
+                         fragStats.largestFreeBlock,
+                         fragStats.freeBlocks);
 
-#ifdef FM_DEBUG_CHECK_CONSISTENCY
-    ValidateMTableConsistency(sw);
-#endif
+            info->fragCleanupCount++;
+        }
+
+        err = StartMTableCleanup(sw, info);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+    }
+
+    err = ContinueMTableCleanup(sw, info, info->cleanupBudget, FALSE);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
 ABORT:
 
@@ -2000,11 +2234,10 @@ static fm_status FindUnusedLenTableBlock(fm10000_mtableInfo *info,
     }
 
     /* find the first available unused entry */
-    err = fmFindBitBlockInBitArray(&info->lenTableUsage,
-                                   1,
-                                   size,
-                                   FALSE,
-                                   &bit);
+    err = fmFindBitRunInBitArray(&info->lenTableUsage,
+                                 1,
+                                 size,
+                                 &bit);
     /* bail out if there's an error */
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
@@ -2284,11 +2517,10 @@ static fm_status FindUnusedVlanTableBlock(fm_int             sw,
     }
 
     /* find the first available unused entry */
-    err = fmFindBitBlockInBitArray(&info->vlanTableUsage,
-                                   1,
-                                   size,
-                                   FALSE,
-                                   &bit);
+    err = fmFindBitRunInBitArray(&info->vlanTableUsage,
+                                 1,
+                                 size,
+                                 &bit);
 
     if (err == FM_OK)
     {
@@ -2298,11 +2530,10 @@ static fm_status FindUnusedVlanTableBlock(fm_int             sw,
             FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
             
             /* find the first available unused entry */
-            err = fmFindBitBlockInBitArray(&info->vlanTableUsage,
-                                           1,
-                                           size,
-                                           FALSE,
-                                           &bit);
+            err = fmFindBitRunInBitArray(&info->vlanTableUsage,
+                                         1,
+                                         size,
+                                         &bit);
             if (err == FM_OK)
             {
                 if (bit < 0)
@@ -2346,7 +2577,7 @@ static fm_status MarkVlanIndexAvailable(fm10000_mtableInfo *info, fm_int index)
 {
     fm_status err;
 
-    err = fmSetBitArrayBit(&info->clonedEntriesBitArray,
+    err = fmSetBitArrayBit(&info->recoveringEntriesBitArray,
                            index,
                            FALSE );
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
@@ -2471,34 +2702,97 @@ static fm_bool VlanIndexInUse(fm10000_mtableInfo *info, fm_int index)
 }   /* end VlanIndexInUse */
 
 
+/*****************************************************************************/
+/** GetVlanIndexExpired
+ *
+ * \desc            Helper function to tell whether an MCAST_VLAN_TABLE entry
+ *                  has expired, whether or not the ongoing cleanup is about
+ *                  to recover it.
+ *
+ * \param[in]       info points to the state structure that holds the
+ *                  mtable management state.
+ *
+ * \param[in]       index is the MCAST_VLAN_TABLE index to check.
+ *
+ * \param[out]      expired points to caller allocated storage where TRUE
+ *                  is stored if the entry has expired.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status GetVlanIndexExpired(fm10000_mtableInfo *info,
+                                     fm_int              index,
+                                     fm_bool *           expired)
+{
+    fm_status err;
+
+    err = fmGetBitArrayBit(&info->clonedEntriesBitArray, index, expired);
+
+    if ( (err == FM_OK) && !*expired )
+    {
+        err = fmGetBitArrayBit(&info->recoveringEntriesBitArray,
+                               index,
+                               expired);
+    }
+
+    return err;
+
+}   /* end GetVlanIndexExpired */
+
+
 /*****************************************************************************/
 /** RecoverExpiredVlanIndices
  *
  * \desc            Helper function to recover expired entries in the
- *                  MCAST_VLAN_TABLE. This marks the expired indices as 
- *                  available.
+ *                  MCAST_VLAN_TABLE. This marks the entries of the ongoing
+ *                  cleanup as available, resuming after info->cleanupIndex.
+ *                  info->cleanupIndex is set to -1 once all of them have
+ *                  been recovered.
  * 
  * \param[in]       sw is the switch on which to operate.
  *
  * \param[in]       info points to the state structure that holds the
  *                  mtable management state.
  *
+ * \param[in]       budget is the maximum time, in nanoseconds, to spend
+ *                  recovering entries. 0 means no limit.
+ *
  * \return          FM_OK if success.
  *
  *****************************************************************************/
-static fm_status RecoverExpiredVlanIndices(fm_int sw, fm10000_mtableInfo *info)
+static fm_status RecoverExpiredVlanIndices(fm_int              sw,
+                                           fm10000_mtableInfo *info,
+                                           fm_uint64           budget)
 {
-    fm_status err;
-    fm_int    vlanIndex;
+    fm_status  err;
+    fm_int     vlanIndex;
+    fm_int     recovered;
+    fm_uint64  startTime;
     fm_switch *switchPtr;
     
     switchPtr = GET_SWITCH_PTR(sw);
+    startTime = fmGetMonotonicNsec();
+    recovered = 0;
     
     /* walk the list of cloned entries and mark them as available */
-    vlanIndex = 0;
+    vlanIndex = info->cleanupIndex;
     while (vlanIndex >= 0)
     {
-        err = fmFindBitInBitArray(&info->clonedEntriesBitArray,
+        if ( (budget != 0) &&
+             (recovered != 0) &&
+             ( (recovered % CLEANUP_BUDGET_CHECK_INTERVAL) == 0 ) &&
+             ( (fmGetMonotonicNsec() - startTime) >= budget ) )
+        {
+            break;
+        }
+
+        if ( (vlanIndex + 1) >= info->recoveringEntriesBitArray.bitCount )
+        {
+            vlanIndex = -1;
+            break;
+        }
+
+        err = fmFindBitInBitArray(&info->recoveringEntriesBitArray,
                                   vlanIndex + 1,
                                   TRUE,
                                   &vlanIndex);
@@ -2513,46 +2807,112 @@ static fm_status RecoverExpiredVlanIndices(fm_int sw, fm10000_mtableInfo *info)
                                           FM10000_MOD_MCAST_VLAN_TABLE(vlanIndex, 0),
                                           0 );
             FM_LOG_EXIT_ON_ERR( FM_LOG_CAT_MULTICAST, err );
+
+            recovered++;
         }
     }
 
-    info->clonedEntriesCount = 0;
+    info->cleanupIndex = vlanIndex;
 
-    /* Clear the MCAST_VLAN_TABLE cloned entries bit array */
-    err = fmClearBitArray(&info->clonedEntriesBitArray);
-    return err;
+    return FM_OK;
 
 }   /* end RecoverExpiredVlanIndices */
 
 
 
+
 /*****************************************************************************/
-/** MTableAddListener
- * \ingroup intMulticast
- *
- * \desc            Internal version of the function to add listener
- *
- * \param[in]       sw is the switch on which to operate
- *
- * \param[in]       mcastGroup is the Multicast Group on which to operate
+/** GetTableFragmentation
  *
- * \param[in]       repliGroup is the replication group number.
+ * \desc            Helper function to compute the fragmentation of the free
+ *                  space of an MTable table from its usage bit array.
+ *                  Index 0 is never allocated and is not counted.
  *
- * \param[in]       physPort is the physical port the listener belongs to
- * 
- * \param[in]       listener is the structure which has all MCAST_VLAN_TABLE fields
- *                  that has to be added.
+ * \param[in]       usage points to the usage bit array of the table.
  *
- * \param[in]       stpState is the STP state of this listener
+ * \param[out]      stats points to caller allocated storage where the
+ *                  statistics are stored. expiredEntries is set to 0.
  *
- * \return          FM_OK if successful
+ * \return          FM_OK if success.
  *
  *****************************************************************************/
-static fm_status MTableAddListener(fm_int              sw, 
-                                   fm_int              mcastGroup, 
-                                   fm_int              repliGroup,
-                                   fm_int              physPort, 
-                                   fm10000_mtableEntry listener,
+static fm_status GetTableFragmentation(fm_bitArray *            usage,
+                                       fm10000_mtableFragStats *stats)
+{
+    fm_status err;
+    fm_int    freeStart;
+    fm_int    freeEnd;
+    fm_int    index;
+
+    FM_CLEAR(*stats);
+
+    index = 1;
+    while (index < usage->bitCount)
+    {
+        err = fmFindBitInBitArray(usage, index, FALSE, &freeStart);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+        if (freeStart < 0)
+        {
+            break;
+        }
+
+        freeEnd = -1;
+        if ( (freeStart + 1) < usage->bitCount )
+        {
+            err = fmFindBitInBitArray(usage, freeStart + 1, TRUE, &freeEnd);
+            FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+        }
+
+        if (freeEnd < 0)
+        {
+            freeEnd = usage->bitCount;
+        }
+
+        stats->freeEntries += freeEnd - freeStart;
+        stats->freeBlocks++;
+
+        if ( (freeEnd - freeStart) > stats->largestFreeBlock )
+        {
+            stats->largestFreeBlock = freeEnd - freeStart;
+        }
+
+        index = freeEnd + 1;
+    }
+
+    return FM_OK;
+
+}   /* end GetTableFragmentation */
+
+
+
+/*****************************************************************************/
+/** MTableAddListener
+ * \ingroup intMulticast
+ *
+ * \desc            Internal version of the function to add listener
+ *
+ * \param[in]       sw is the switch on which to operate
+ *
+ * \param[in]       mcastGroup is the Multicast Group on which to operate
+ *
+ * \param[in]       repliGroup is the replication group number.
+ *
+ * \param[in]       physPort is the physical port the listener belongs to
+ * 
+ * \param[in]       listener is the structure which has all MCAST_VLAN_TABLE fields
+ *                  that has to be added.
+ *
+ * \param[in]       stpState is the STP state of this listener
+ *
+ * \return          FM_OK if successful
+ *
+ *****************************************************************************/
+static fm_status MTableAddListener(fm_int              sw, 
+                                   fm_int              mcastGroup, 
+                                   fm_int              repliGroup,
+                                   fm_int              physPort, 
+                                   fm10000_mtableEntry listener,
                                    fm_int              stpState ) 
 {
     fm_status      err = FM_OK;
@@ -2844,69 +3204,632 @@ static fm_status MTableAddListener(fm_int              sw,
                      mcastMask.maskWord[0]);
     }
 
-    /* Yes, because its state is forwarding, or we are in STP bypass mode */
-    FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,  "adding listener...\n");
-    err = AddListener(sw,
-                      info,
-                      mcastGroup,
-                      repliGroup,
-                      lenTableIndex,
-                      vlanIndex,
-                      &mcastMask,
-                      physPort,
-                      listener);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
-
-    /**************************************************
-     * To conclude update the MCAST_DEST_TABLE register
-     * and update the attributes for the logical port
-     * corresponding to this multicast group
+    /* Yes, because its state is forwarding, or we are in STP bypass mode */
+    FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,  "adding listener...\n");
+    err = AddListener(sw,
+                      info,
+                      mcastGroup,
+                      repliGroup,
+                      lenTableIndex,
+                      vlanIndex,
+                      &mcastMask,
+                      physPort,
+                      listener);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    /**************************************************
+     * To conclude update the MCAST_DEST_TABLE register
+     * and update the attributes for the logical port
+     * corresponding to this multicast group
+     **************************************************/
+
+    COPY_PORTMASK_TO_DESTMASK(mcastMask, mcastDestReg);
+
+    FM_SET_FIELD64(mcastDestReg,
+                   FM10000_SCHED_MCAST_DEST_TABLE,
+                   LenTableIdx,
+                   lenTableIdx);
+
+    err = switchPtr->WriteUINT64( sw,
+                                  FM10000_SCHED_MCAST_DEST_TABLE(mcastIndex, 0),
+                                  mcastDestReg );
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,
+                 "For dest table index %" FM_FORMAT_64 "u, "
+                 "multicast lenTable index %u, "
+                 "multicast vlan index %u\n",
+                 (fm_uint64) mcastIndex,
+                 lenTableIndex,
+                 vlanIndex);
+
+    /* Now we can recover the expired len indices, since DEST_TABLE
+     * is already modified to point to new LenTable entries. */
+    err = RecoverExpiredLenIndices(sw, info);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    /*******************************************************
+     * get the logical port and update the mask accordingly
+     * basically we'll set the bit in the GLORT_DEST_TABLE
+     * only if there are active listeners
+     ******************************************************/
+
+    err = fmMapPhysicalPortToLogical(switchPtr, physPort, &logicalPort);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    err = GetListenersCount(info, repliGroup, physPort, &activeCount, NULL);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    /***************************************************
+     * Here we make sure that the L2 mask's bit for
+     * this port is only set if the number of active
+     * listeners is non-zero.  The activeCount only
+     * includes forwarding (port, vlan) pairs.
+     **************************************************/
+    fmSetPortInPortMask(sw, &logicalMask, logicalPort, (activeCount != 0));
+
+    err = switchPtr->SetLogicalPortAttribute(sw,
+                                             mcastGroup,
+                                             FM_LPORT_DEST_MASK,
+                                             &logicalMask);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,
+                 "Physical multicast destination mask for group %d, index %d: %08x%08x\n",
+                 repliGroup,
+                 vlanIndex,
+                 mcastMask.maskWord[1],
+                 mcastMask.maskWord[0]);
+
+    FM_LOG_DEBUG( FM_LOG_CAT_MULTICAST,
+                  "Logical destination mask for port %d, glort 0x%x: %08x%08x\n",
+                  mcastGroup,
+                  GET_PORT_PTR(sw, mcastGroup)->glort,
+                  logicalMask.maskWord[1],
+                  logicalMask.maskWord[0] );
+
+ABORT:
+    FM_LOG_EXIT(FM_LOG_CAT_MULTICAST, err);
+
+}   /* end MTableAddListener */
+
+
+
+/*****************************************************************************/
+/** GetListenerPortState
+ * \ingroup intMulticast
+ *
+ * \desc            Returns the physical port of a listener and the STP
+ *                  state that decides whether it goes to the hardware.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       listener points to the listener.
+ *
+ * \param[out]      physPort points to caller-provided storage where the
+ *                  physical port is returned.
+ *
+ * \param[out]      stpState points to caller-provided storage where the
+ *                  STP state is returned.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status GetListenerPortState(fm_int               sw,
+                                      fm10000_mtableEntry *listener,
+                                      fm_int *             physPort,
+                                      fm_int *             stpState)
+{
+    fm_status err;
+
+    /* map the listener logical port to its parent physical port */
+    err = fmMapLogicalPortToPhysical(GET_SWITCH_PTR(sw),
+                                     listener->port,
+                                     physPort);
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    /* For flooding listeners set STP to FM_STP_STATE_FORWARDING */
+    if (listener->vlan == FM_MAILBOX_DEF_VLAN_FOR_FLOOD_MCAST_GROUPS)
+    {
+        *stpState = FM_STP_STATE_FORWARDING;
+    }
+    else if (listener->vlanUpdate == TRUE)
+    {
+        /* get the current STP state for this listener */
+        err = fmGetVlanPortStateInternal(sw,
+                                         listener->vlan,
+                                         listener->port,
+                                         stpState);
+    }
+    else
+    {
+        *stpState = FM_STP_STATE_FORWARDING;
+    }
+
+    return err;
+
+}   /* end GetListenerPortState */
+
+
+
+
+/*****************************************************************************/
+/** ReleaseBatchReservations
+ * \ingroup intMulticast
+ *
+ * \desc            Releases the MCAST_LEN_TABLE and MCAST_VLAN_TABLE
+ *                  entries reserved by ''MTableAddListenerBatch'' when
+ *                  the reservation could not be completed.
+ *
+ * \param[in]       info points to the multicast table state information.
+ *
+ * \param[in]       ports points to the per physical port batch state.
+ *
+ * \param[in]       lenIndex is the first reserved MCAST_LEN_TABLE entry,
+ *                  or -1 if none.
+ *
+ * \param[in]       lenCount is the number of reserved MCAST_LEN_TABLE
+ *                  entries.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReleaseBatchReservations(fm10000_mtableInfo *     info,
+                                     fm10000_MTableBatchPort *ports,
+                                     fm_int                   lenIndex,
+                                     fm_int                   lenCount)
+{
+    fm_int physPort;
+    fm_int i;
+
+    for (physPort = 0 ; physPort < FM10000_NUM_PORTS ; physPort++)
+    {
+        for (i = 0 ; i < ports[physPort].resvCount ; i++)
+        {
+            fmSetBitArrayBit(&info->vlanTableUsage,
+                             ports[physPort].resvIndex + i,
+                             FALSE);
+            UpdateUsageCounters(info, 0, 0, -1, 0);
+        }
+
+        ports[physPort].resvCount = 0;
+    }
+
+    if (lenIndex > 0)
+    {
+        for (i = 0 ; i < lenCount ; i++)
+        {
+            MarkLenTableIndexAvailable(info, lenIndex + i);
+        }
+    }
+
+}   /* end ReleaseBatchReservations */
+
+
+
+
+/*****************************************************************************/
+/** MTableAddListenerBatch
+ * \ingroup intMulticast
+ *
+ * \desc            Adds a list of listeners to a replication group with one
+ *                  MCAST_DEST_TABLE update.
+ *                                                                      \lb\lb
+ *                  A new MCAST_LEN_TABLE block sized for the final port
+ *                  set is allocated. Each port that gains listeners gets its
+ *                  MCAST_VLAN_TABLE block grown in place, or moved once to
+ *                  a block of the final size. All entries are written before
+ *                  the MCAST_DEST_TABLE entry is switched to the new block.
+ *
+ * \note            Every table entry is reserved before any state changes.
+ *                  If a reservation fails, the reservations are released
+ *                  and FM_ERR_NO_MCAST_RESOURCES is returned with nothing
+ *                  modified.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       mcastGroup is the multicast group on which to operate.
+ *
+ * \param[in]       repliGroup is the replication group number.
+ *
+ * \param[in]       numListeners is the number of entries in listeners.
+ *
+ * \param[in]       listeners points to the listeners to add.
+ *
+ * \param[in]       physPorts points to the physical port of each listener.
+ *
+ * \param[in]       stpStates points to the STP state of each listener.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MCAST_RESOURCES if the tables are too full or
+ *                  too fragmented to hold the blocks.
+ *
+ *****************************************************************************/
+static fm_status MTableAddListenerBatch(fm_int               sw,
+                                        fm_int               mcastGroup,
+                                        fm_int               repliGroup,
+                                        fm_int               numListeners,
+                                        fm10000_mtableEntry *listeners,
+                                        fm_int *             physPorts,
+                                        fm_int *             stpStates)
+{
+    fm_status               err;
+    fm_switch *             switchPtr;
+    fm10000_mtableInfo *    info;
+    fm_intMulticastGroup *  mcastGroupInfo;
+    fm10000_MTableBatchPort ports[FM10000_NUM_PORTS];
+    fm10000_MTableBatchPort *port;
+    fm_bool *               forwarding;
+    fm_uintptr              mcastIndex;
+    fm_uint64               mcastDestReg;
+    fm_uint64               vlanTableReg;
+    fm_portmask             logicalMask;
+    fm_portmask             oldMask;
+    fm_portmask             newMask;
+    fm_int                  oldLenIdx;
+    fm_int                  newLenIdx;
+    fm_int                  newSize;
+    fm_int                  oldPos;
+    fm_int                  newPos;
+    fm_int                  physPort;
+    fm_int                  logicalPort;
+    fm_int                  total;
+    fm_int                  i;
+    fm_bool                 inPlace;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_MULTICAST,
+                 "sw=%d mcastGroup=%d repliGroup=%d numListeners=%d\n",
+                 sw,
+                 mcastGroup,
+                 repliGroup,
+                 numListeners);
+
+    switchPtr  = GET_SWITCH_PTR(sw);
+    info       = GET_MTABLE_INFO(sw);
+    newLenIdx  = -1;
+    newSize    = 0;
+    forwarding = NULL;
+
+    FM_CLEAR(ports);
+
+    err = fmTreeFind(&info->mtableDestIndex, repliGroup, (void **) &mcastIndex);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    err = fmTreeFind(&switchPtr->mcastPortTree,
+                     mcastGroup,
+                     (void **) &mcastGroupInfo);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    forwarding = fmAlloc(numListeners * sizeof(fm_bool));
+    if (forwarding == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
+    }
+
+    /***************************************************
+     * Count the listeners that go to the hardware on
+     * each port. The others are only remembered until
+     * their STP state becomes forwarding.
+     **************************************************/
+
+    FM_PORTMASK_DISABLE_ALL(&newMask);
+
+    for (i = 0 ; i < numListeners ; i++)
+    {
+        forwarding[i] = !( listeners[i].vlanUpdate &&
+                           (stpStates[i] != FM_STP_STATE_FORWARDING) &&
+                           !mcastGroupInfo->bypassEgressSTPCheck );
+
+        if (forwarding[i])
+        {
+            ports[physPorts[i]].addCount++;
+            FM_PORTMASK_SET_BIT(&newMask, physPorts[i], 1);
+        }
+    }
+
+    err = switchPtr->GetLogicalPortAttribute(sw,
+                                             mcastGroup,
+                                             FM_LPORT_DEST_MASK,
+                                             &logicalMask);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    err = switchPtr->ReadUINT64(sw,
+                                FM10000_SCHED_MCAST_DEST_TABLE(mcastIndex, 0),
+                                &mcastDestReg);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    COPY_DESTMASK_TO_PORTMASK(mcastDestReg, oldMask);
+
+    oldLenIdx = FM_GET_FIELD64(mcastDestReg,
+                               FM10000_SCHED_MCAST_DEST_TABLE,
+                               LenTableIdx);
+
+    /***************************************************
+     * Collect the current layout of each port.
+     **************************************************/
+
+    for (physPort = 0, oldPos = 0 ; physPort < FM10000_NUM_PORTS ; physPort++)
+    {
+        port = &ports[physPort];
+
+        if ( FM_PORTMASK_GET_BIT(&oldMask, physPort) )
+        {
+            FM_PORTMASK_SET_BIT(&newMask, physPort, 1);
+
+            port->oldLenIndex = oldLenIdx + oldPos;
+            oldPos++;
+
+            err = switchPtr->ReadUINT32(sw,
+                                        FM10000_SCHED_MCAST_LEN_TABLE(port->oldLenIndex),
+                                        &port->lenTableReg);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+            port->oldVlanIndex = FM_GET_FIELD(port->lenTableReg,
+                                              FM10000_SCHED_MCAST_LEN_TABLE,
+                                              L3_McastIdx);
+
+            err = GetListenersCount(info,
+                                    repliGroup,
+                                    physPort,
+                                    &port->oldCount,
+                                    NULL);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+        }
+
+        port->newVlanIndex = port->oldVlanIndex;
+
+        if ( FM_PORTMASK_GET_BIT(&newMask, physPort) )
+        {
+            newSize++;
+        }
+    }
+
+    /***************************************************
+     * Reserve all table entries up front.
+     **************************************************/
+
+    if (newSize > 0)
+    {
+        err = FindUnusedLenTableBlock(info, newSize, &newLenIdx);
+        if (err != FM_OK)
+        {
+            newLenIdx = -1;
+            FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
+        }
+
+        for (i = 0 ; i < newSize ; i++)
+        {
+            MarkLenTableIndexUsed(info, newLenIdx + i);
+        }
+    }
+
+    for (physPort = 0 ; physPort < FM10000_NUM_PORTS ; physPort++)
+    {
+        port = &ports[physPort];
+
+        if (port->addCount == 0)
+        {
+            continue;
+        }
+
+        /* Grow the current block in place if the entries behind it are
+         * free, as MTableAddListener does for a single listener. */
+        inPlace = (port->oldCount > 0) &&
+                  ( (port->oldVlanIndex + port->oldCount + port->addCount) <
+                    FM10000_MAX_MCAST_VLAN_INDEX );
+
+        for (i = 0 ; inPlace && (i < port->addCount) ; i++)
+        {
+            if ( VlanIndexInUse(info, port->oldVlanIndex + port->oldCount + i) )
+            {
+                inPlace = FALSE;
+            }
+        }
+
+        if (inPlace)
+        {
+            port->resvIndex = port->oldVlanIndex + port->oldCount;
+            port->resvCount = port->addCount;
+        }
+        else
+        {
+            err = FindUnusedVlanTableBlock(sw,
+                                           info,
+                                           port->oldCount + port->addCount,
+                                           &port->resvIndex);
+            if (err != FM_OK)
+            {
+                ReleaseBatchReservations(info, ports, newLenIdx, newSize);
+                FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
+            }
+
+            port->resvCount    = port->oldCount + port->addCount;
+            port->newVlanIndex = port->resvIndex;
+        }
+
+        for (i = 0 ; i < port->resvCount ; i++)
+        {
+            MarkVlanIndexUsed(info, port->resvIndex + i);
+        }
+
+        port->nextVlanIndex = port->newVlanIndex + port->oldCount;
+    }
+
+    /***************************************************
+     * Move the existing entries to the new blocks.
+     **************************************************/
+
+    for (physPort = 0, newPos = 0 ; physPort < FM10000_NUM_PORTS ; physPort++)
+    {
+        port = &ports[physPort];
+
+        if ( !FM_PORTMASK_GET_BIT(&newMask, physPort) )
+        {
+            continue;
+        }
+
+        port->newLenIndex = newLenIdx + newPos;
+        newPos++;
+
+        if (port->oldLenIndex == 0)
+        {
+            continue;
+        }
+
+        err = ModifyEntryListLenIndex(info, port->oldLenIndex, port->newLenIndex);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+        MarkLenTableIndexExpired(info, port->oldLenIndex);
+
+        if (port->newVlanIndex == port->oldVlanIndex)
+        {
+            continue;
+        }
+
+        for (i = 0 ; i < port->oldCount ; i++)
+        {
+            err = switchPtr->ReadUINT64(sw,
+                                        FM10000_MOD_MCAST_VLAN_TABLE(port->oldVlanIndex + i, 0),
+                                        &vlanTableReg);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+            err = switchPtr->WriteUINT64(sw,
+                                         FM10000_MOD_MCAST_VLAN_TABLE(port->newVlanIndex + i, 0),
+                                         vlanTableReg);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+            MarkVlanIndexExpired(info, port->oldVlanIndex + i);
+
+            err = ModifyEntryListForListener(info,
+                                             physPort,
+                                             FM_GET_FIELD64(vlanTableReg,
+                                                            FM10000_MOD_MCAST_VLAN_TABLE,
+                                                            VID),
+                                             FM_GET_FIELD64(vlanTableReg,
+                                                            FM10000_MOD_MCAST_VLAN_TABLE,
+                                                            DGLORT),
+                                             mcastGroup,
+                                             repliGroup,
+                                             port->oldVlanIndex + i,
+                                             port->newVlanIndex + i,
+                                             port->newLenIndex,
+                                             port->newLenIndex);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+        }
+    }
+
+    /***************************************************
+     * Write the new listeners.
+     **************************************************/
+
+    for (i = 0 ; i < numListeners ; i++)
+    {
+        if (!forwarding[i])
+        {
+            /* Remember the listener, it will be added when its STP state
+             * becomes forwarding. */
+            err = AddToEntryListForListener(info,
+                                            physPorts[i],
+                                            listeners[i].vlan,
+                                            listeners[i].dglort,
+                                            mcastGroup,
+                                            repliGroup,
+                                            0,
+                                            0);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+            continue;
+        }
+
+        port = &ports[physPorts[i]];
+
+        err = switchPtr->WriteUINT64(sw,
+                                     FM10000_MOD_MCAST_VLAN_TABLE(port->nextVlanIndex, 0),
+                                     BuildVlanTableEntry(&listeners[i]));
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+        err = AddToEntryListForListener(info,
+                                        physPorts[i],
+                                        listeners[i].vlan,
+                                        listeners[i].dglort,
+                                        mcastGroup,
+                                        repliGroup,
+                                        port->nextVlanIndex,
+                                        port->newLenIndex);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+        port->nextVlanIndex++;
+    }
+
+    /***************************************************
+     * Write the new MCAST_LEN_TABLE block.
+     **************************************************/
+
+    for (physPort = 0 ; physPort < FM10000_NUM_PORTS ; physPort++)
+    {
+        port = &ports[physPort];
+
+        if ( !FM_PORTMASK_GET_BIT(&newMask, physPort) )
+        {
+            continue;
+        }
+
+        if (port->addCount > 0)
+        {
+            total = port->oldCount + port->addCount;
+
+            FM_SET_FIELD(port->lenTableReg,
+                         FM10000_SCHED_MCAST_LEN_TABLE,
+                         L3_McastIdx,
+                         port->newVlanIndex);
+            FM_SET_FIELD(port->lenTableReg,
+                         FM10000_SCHED_MCAST_LEN_TABLE,
+                         L3_Repcnt,
+                         (total - 1));
+
+            err = SetListenersCount(info, repliGroup, physPort, &total, NULL);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+        }
+
+        err = switchPtr->WriteUINT32(sw,
+                                     FM10000_SCHED_MCAST_LEN_TABLE(port->newLenIndex),
+                                     port->lenTableReg);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+    }
+
+    /***************************************************
+     * Switch the replication group to the new block.
      **************************************************/
 
-    COPY_PORTMASK_TO_DESTMASK(mcastMask, mcastDestReg);
+    COPY_PORTMASK_TO_DESTMASK(newMask, mcastDestReg);
 
     FM_SET_FIELD64(mcastDestReg,
                    FM10000_SCHED_MCAST_DEST_TABLE,
                    LenTableIdx,
-                   lenTableIdx);
+                   newLenIdx);
 
-    err = switchPtr->WriteUINT64( sw,
-                                  FM10000_SCHED_MCAST_DEST_TABLE(mcastIndex, 0),
-                                  mcastDestReg );
+    err = switchPtr->WriteUINT64(sw,
+                                 FM10000_SCHED_MCAST_DEST_TABLE(mcastIndex, 0),
+                                 mcastDestReg);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
-    FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,
-                 "For dest table index %" FM_FORMAT_64 "u, "
-                 "multicast lenTable index %u, "
-                 "multicast vlan index %u\n",
-                 (fm_uint64) mcastIndex,
-                 lenTableIndex,
-                 vlanIndex);
-
-    /* Now we can recover the expired len indices, since DEST_TABLE
-     * is already modified to point to new LenTable entries. */
     err = RecoverExpiredLenIndices(sw, info);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
-    /*******************************************************
-     * get the logical port and update the mask accordingly
-     * basically we'll set the bit in the GLORT_DEST_TABLE
-     * only if there are active listeners
-     ******************************************************/
-
-    err = fmMapPhysicalPortToLogical(switchPtr, physPort, &logicalPort);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
-
-    err = GetListenersCount(info, repliGroup, physPort, &activeCount, NULL);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+    /* Ports that gained active listeners now belong in the L2 mask */
+    for (physPort = 0 ; physPort < FM10000_NUM_PORTS ; physPort++)
+    {
+        if (ports[physPort].addCount > 0)
+        {
+            err = fmMapPhysicalPortToLogical(switchPtr, physPort, &logicalPort);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
-    /***************************************************
-     * Here we make sure that the L2 mask's bit for
-     * this port is only set if the number of active
-     * listeners is non-zero.  The activeCount only
-     * includes forwarding (port, vlan) pairs.
-     **************************************************/
-    fmSetPortInPortMask(sw, &logicalMask, logicalPort, (activeCount != 0));
+            fmSetPortInPortMask(sw, &logicalMask, logicalPort, TRUE);
+        }
+    }
 
     err = switchPtr->SetLogicalPortAttribute(sw,
                                              mcastGroup,
@@ -2915,23 +3838,23 @@ static fm_status MTableAddListener(fm_int              sw,
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
     FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,
-                 "Physical multicast destination mask for group %d, index %d: %08x%08x\n",
+                 "repliGroup %d: %d listeners added, lenTable block %d "
+                 "size %d\n",
                  repliGroup,
-                 vlanIndex,
-                 mcastMask.maskWord[1],
-                 mcastMask.maskWord[0]);
-
-    FM_LOG_DEBUG( FM_LOG_CAT_MULTICAST,
-                  "Logical destination mask for port %d, glort 0x%x: %08x%08x\n",
-                  mcastGroup,
-                  GET_PORT_PTR(sw, mcastGroup)->glort,
-                  logicalMask.maskWord[1],
-                  logicalMask.maskWord[0] );
+                 numListeners,
+                 newLenIdx,
+                 newSize);
 
 ABORT:
+    if (forwarding != NULL)
+    {
+        fmFree(forwarding);
+    }
+
     FM_LOG_EXIT(FM_LOG_CAT_MULTICAST, err);
 
-}   /* end MTableAddListener */
+}   /* end MTableAddListenerBatch */
+
 
 
 
@@ -4172,12 +5095,26 @@ fm_status fm10000MTableInitialize(fm_int sw)
     err = fmClearBitArray(&info->clonedEntriesBitArray);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
+    err = fmClearBitArray(&info->recoveringEntriesBitArray);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
     /* Initialize the garbage collection watermark */
     info->watermarkPercentage    =  GET_FM10000_PROPERTY()->mtableCleanupWm;
     info->clonedEntriesWatermark = FM10000_MAX_MCAST_VLAN_INDEX - 1;
     info->clonedEntriesWatermark *= info->watermarkPercentage;
     info->clonedEntriesWatermark /= 100;
 
+    /* Initialize the incremental cleanup parameters */
+    info->cleanupBudget    = GET_FM10000_PROPERTY()->mtableCleanupBudget;
+    info->cleanupBudget   *= 1000;
+    info->cleanupFreeBlock = GET_FM10000_PROPERTY()->mtableCleanupFreeBlock;
+    info->cleanupOnGoing   = FALSE;
+    info->cleanupIndex     = -1;
+    info->fragCheckVlanTableCount = 0;
+    info->cleanupCount       = 0;
+    info->forcedCleanupCount = 0;
+    info->fragCleanupCount   = 0;
+
     /* initialize the group map */
     fmTreeInit(&info->groups);
 
@@ -4269,6 +5206,12 @@ fm_status fm10000AllocateMTableDataStructures(fm_switch *switchPtr)
                            FM10000_MAX_MCAST_VLAN_INDEX);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
+    /* Create the entries being recovered bit array. It is swapped with the
+     * cloned entries bit array, so it has the same size. */
+    err = fmCreateBitArray(&info->recoveringEntriesBitArray,
+                           FM10000_MAX_MCAST_VLAN_INDEX);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
     /* Create the cloned entries bit array. The size is set
      * to FM10000_MAX_MCAST_LEN_INDEX to guaranty that the last entry
      * will not be used. This entry is use for memory repair */
@@ -4337,6 +5280,10 @@ fm_status fm10000FreeMTableDataStructures(fm_switch *switchPtr)
     err = fmDeleteBitArray( &info->clonedEntriesBitArray );
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
+    /* Delete the entries being recovered bit array */
+    err = fmDeleteBitArray( &info->recoveringEntriesBitArray );
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
     /* Delete the cloned entries bit array */
     err = fmDeleteBitArray( &info->clonedLenEntriesBitArray );
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
@@ -4447,7 +5394,6 @@ fm_status fm10000MTableAddListener(fm_int               sw,
                                    fm10000_mtableEntry  listener)
 {
     fm_status               err = FM_OK;
-    fm_switch *             switchPtr;
     fm_port *               portPtr;
     fm10000_mtableInfo *    info;
     fm_uintptr              mcastIndex;
@@ -4458,8 +5404,6 @@ fm_status fm10000MTableAddListener(fm_int               sw,
                  "sw=%d mcastGroup=%d repliGroup %d listener=<%d,%d>\n",
                  sw, mcastGroup, repliGroup, listener.port, listener.vlan);
 
-    /* get the switch pointer */
-    switchPtr = GET_SWITCH_PTR(sw);
     portPtr   = GET_PORT_PTR(sw, mcastGroup);
     info      = GET_MTABLE_INFO(sw);
 
@@ -4491,27 +5435,7 @@ fm_status fm10000MTableAddListener(fm_int               sw,
         FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
     }
 
-    /* map the listener logical port to its parent physical port */
-    err = fmMapLogicalPortToPhysical(switchPtr, listener.port, &physPort);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
-
-    /* For flooding listeners set STP to FM_STP_STATE_FORWARDING */
-    if (listener.vlan == FM_MAILBOX_DEF_VLAN_FOR_FLOOD_MCAST_GROUPS)
-    {
-        stpState = FM_STP_STATE_FORWARDING;
-    }
-    else if (listener.vlanUpdate == TRUE)
-    {
-        /* get the current STP state for this listener */
-        err = fmGetVlanPortStateInternal(sw,
-                                         listener.vlan,
-                                         listener.port,
-                                         &stpState);
-    }
-    else
-    {
-        stpState = FM_STP_STATE_FORWARDING;
-    }
+    err = GetListenerPortState(sw, &listener, &physPort, &stpState);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
     err = MTableAddListener(sw, 
@@ -4537,6 +5461,167 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000MTableAddListenerList
+ * \ingroup intMulticast
+ *
+ * \desc            Adds a list of listeners to the given multicast group.
+ *                  The final MCAST_LEN_TABLE and MCAST_VLAN_TABLE blocks of
+ *                  the replication group are allocated and written once,
+ *                  then the MCAST_DEST_TABLE entry is switched to them with
+ *                  a single write.
+ *                                                                      \lb\lb
+ *                  If the tables cannot hold the final blocks alongside the
+ *                  current ones, the listeners are added one at a time
+ *                  instead, stopping at the first failure.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       mcastGroup is the logical port assigned to the multicast
+ *                  group.
+ *
+ * \param[in]       repliGroup is the replication group number.
+ *
+ * \param[in]       numListeners is the number of entries in listeners.
+ *
+ * \param[in]       listeners points to the listeners to add.
+ *
+ * \param[out]      numAdded points to caller-provided storage where the
+ *                  number of listeners added, counted from the start of the
+ *                  list, is returned.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_MCAST_INVALID_STATE if the group is not enabled.
+ * \return          FM_ERR_NO_MCAST_RESOURCES if the tables are full.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fm10000MTableAddListenerList(fm_int               sw,
+                                       fm_int               mcastGroup,
+                                       fm_int               repliGroup,
+                                       fm_int               numListeners,
+                                       fm10000_mtableEntry *listeners,
+                                       fm_int *             numAdded)
+{
+    fm_status               err = FM_OK;
+    fm_port *               portPtr;
+    fm10000_mtableInfo *    info;
+    fm_uintptr              mcastIndex;
+    fm_int *                physPorts;
+    fm_int *                stpStates;
+    fm_int                  i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_MULTICAST,
+                 "sw=%d mcastGroup=%d repliGroup %d numListeners=%d\n",
+                 sw, mcastGroup, repliGroup, numListeners);
+
+    portPtr   = GET_PORT_PTR(sw, mcastGroup);
+    info      = GET_MTABLE_INFO(sw);
+    physPorts = NULL;
+    stpStates = NULL;
+    *numAdded = 0;
+
+    if (numListeners <= 0)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_MULTICAST, FM_OK);
+    }
+
+    physPorts = fmAlloc(numListeners * sizeof(fm_int));
+    stpStates = fmAlloc(numListeners * sizeof(fm_int));
+
+    if ( (physPorts == NULL) || (stpStates == NULL) )
+    {
+        if (physPorts != NULL)
+        {
+            fmFree(physPorts);
+        }
+
+        if (stpStates != NULL)
+        {
+            fmFree(stpStates);
+        }
+
+        FM_LOG_EXIT(FM_LOG_CAT_MULTICAST, FM_ERR_NO_MEM);
+    }
+
+    FM_TAKE_L2_LOCK(sw);
+    FM_TAKE_MTABLE_LOCK(sw);
+
+    /* reject it if it's too early */
+    if ( info->isInitialized == FALSE )
+    {
+        err = FM_ERR_MCAST_INVALID_STATE;
+        FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
+    }
+
+    err = fmTreeFind(&info->mtableDestIndex, repliGroup, (void **) &mcastIndex);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    if ( ((fm10000_port *)(portPtr->extension))->groupEnabled == FALSE ||
+          mcastIndex <= 0 )
+    {
+        err = FM_ERR_MCAST_INVALID_STATE;
+        FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
+    }
+
+    for (i = 0 ; i < numListeners ; i++)
+    {
+        err = GetListenerPortState(sw, &listeners[i], &physPorts[i], &stpStates[i]);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+    }
+
+    err = MTableAddListenerBatch(sw,
+                                 mcastGroup,
+                                 repliGroup,
+                                 numListeners,
+                                 listeners,
+                                 physPorts,
+                                 stpStates);
+
+    if (err == FM_OK)
+    {
+        *numAdded = numListeners;
+    }
+    else if (err == FM_ERR_NO_MCAST_RESOURCES)
+    {
+        FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,
+                     "No room for the final blocks of repliGroup %d, "
+                     "adding listeners one at a time\n",
+                     repliGroup);
+
+        for (i = 0 ; i < numListeners ; i++)
+        {
+            err = MTableAddListener(sw,
+                                    mcastGroup,
+                                    repliGroup,
+                                    physPorts[i],
+                                    listeners[i],
+                                    stpStates[i]);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+            (*numAdded)++;
+        }
+    }
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+ABORT:
+#ifdef FM_DEBUG_CHECK_CONSISTENCY
+    ValidateMTableConsistency(sw);
+#endif
+
+    FM_DROP_MTABLE_LOCK(sw);
+    FM_DROP_L2_LOCK(sw);
+
+    fmFree(physPorts);
+    fmFree(stpStates);
+
+    FM_LOG_EXIT(FM_LOG_CAT_MULTICAST, err);
+
+}   /* end fm10000MTableAddListenerList */
+
+
+
+
 /*****************************************************************************/
 /** fm10000MTableDeleteListener
  * \ingroup intMulticast
@@ -5296,10 +6381,15 @@ fm_status fm10000MTablePeriodicMaintenance(fm_int sw)
         FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_MULTICAST,  err);
     }
 
-    /* Proceed to cleanup when clonedEntries is greater than watermark% of 
-     * remaining available entries or forceClean is enabled. This check is 
-     * done here first to avoid taking lock if it is below watermark.  */
-    if (info->clonedEntriesCount <= info->clonedEntriesWatermark)
+    /* There is something to do when a cleanup is ongoing, when clonedEntries
+     * is greater than watermark% of remaining available entries, or when the
+     * table has changed since its fragmentation was last checked. This check
+     * is done here first to avoid taking the lock otherwise. */
+    if ( !info->cleanupOnGoing &&
+         ( (info->clonedEntriesCount == 0) ||
+           ( (info->clonedEntriesCount <= info->clonedEntriesWatermark) &&
+             ( (info->cleanupFreeBlock <= 0) ||
+               (info->vlanTableCount == info->fragCheckVlanTableCount) ) ) ) )
     {
         err = FM_OK;
         FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_MULTICAST,  err);
@@ -5318,6 +6408,80 @@ fm_status fm10000MTablePeriodicMaintenance(fm_int sw)
 
 
 
+/*****************************************************************************/
+/** fm10000GetMTableFragmentation
+ * \ingroup intMulticast
+ *
+ * \desc            Returns the fragmentation statistics of the
+ *                  MCAST_VLAN_TABLE and MCAST_LEN_TABLE.
+ *
+ * \param[in]       sw the switch on which to operate
+ *
+ * \param[out]      vlanStats points to caller allocated storage where the
+ *                  MCAST_VLAN_TABLE statistics are stored. May be NULL.
+ *
+ * \param[out]      lenStats points to caller allocated storage where the
+ *                  MCAST_LEN_TABLE statistics are stored. May be NULL.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000GetMTableFragmentation(fm_int                   sw,
+                                        fm10000_mtableFragStats *vlanStats,
+                                        fm10000_mtableFragStats *lenStats)
+{
+    fm10000_mtableInfo *info;
+    fm_status           err;
+    fm_int              recovering;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_MULTICAST,
+                 "sw=%d vlanStats=%p lenStats=%p\n",
+                 sw,
+                 (void *) vlanStats,
+                 (void *) lenStats);
+
+    FM_TAKE_MTABLE_LOCK(sw);
+
+    info = GET_MTABLE_INFO(sw);
+    err  = FM_OK;
+
+    if (vlanStats != NULL)
+    {
+        err = GetTableFragmentation(&info->vlanTableUsage, vlanStats);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+        err = fmGetBitArrayNonZeroBitCount(&info->clonedEntriesBitArray,
+                                           &vlanStats->expiredEntries);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+        err = fmGetBitArrayNonZeroBitCount(&info->recoveringEntriesBitArray,
+                                           &recovering);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+        vlanStats->expiredEntries += recovering;
+    }
+
+    if (lenStats != NULL)
+    {
+        err = GetTableFragmentation(&info->lenTableUsage, lenStats);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+        err = fmGetBitArrayNonZeroBitCount(&info->clonedLenEntriesBitArray,
+                                           &lenStats->expiredEntries);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+    }
+
+ABORT:
+
+    FM_DROP_MTABLE_LOCK(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_MULTICAST, err);
+
+}   /* end fm10000GetMTableFragmentation */
+
+
+
+
 /*****************************************************************************/
 /** fm10000DbgDumpMulticastVlanTable
  * \ingroup intMulticast
@@ -5356,6 +6520,7 @@ fm_status fm10000DbgDumpMulticastVlanTable(fm_int sw)
     fm10000_entryListWrapper *entry;
     fm_bool                  indexUsedByGroup;
     fm_bool                  invalidPort = FALSE;
+    fm10000_mtableFragStats  fragStats;
     fm_bool                  indexShared;
     fm10000_MTableGroupInfo *groupInfo;
     fm_uint64                mcastMaskField;
@@ -5534,9 +6699,7 @@ fm_status fm10000DbgDumpMulticastVlanTable(fm_int sw)
 
     for ( i = 0 ; i < FM10000_MAX_MCAST_VLAN_INDEX ; i++ )
     {
-        err = fmGetBitArrayBit(&info->clonedEntriesBitArray,
-                               i,
-                               &expiring);
+        err = GetVlanIndexExpired(info, i, &expiring);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
         err = fmGetBitArrayBit(&info->vlanTableUsage,
@@ -5659,6 +6822,28 @@ fm_status fm10000DbgDumpMulticastVlanTable(fm_int sw)
     FM_LOG_PRINT("dest table usage count: %d\n", info->destTableCount);
     FM_LOG_PRINT("number of cloned entries in vlan table: %d\n", info->clonedEntriesCount);
 
+    err = GetTableFragmentation(&info->vlanTableUsage, &fragStats);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    FM_LOG_PRINT("vlan table free entries: %d in %d blocks, largest %d\n",
+                 fragStats.freeEntries,
+                 fragStats.freeBlocks,
+                 fragStats.largestFreeBlock);
+
+    err = GetTableFragmentation(&info->lenTableUsage, &fragStats);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    FM_LOG_PRINT("len table free entries: %d in %d blocks, largest %d\n",
+                 fragStats.freeEntries,
+                 fragStats.freeBlocks,
+                 fragStats.largestFreeBlock);
+
+    FM_LOG_PRINT("cleanups: %lld (forced %lld, fragmentation %lld)%s\n",
+                 info->cleanupCount,
+                 info->forcedCleanupCount,
+                 info->fragCleanupCount,
+                 info->cleanupOnGoing ? ", one ongoing" : "");
+
 ABORT:
 
     FM_DROP_MTABLE_LOCK(sw);
@@ -5886,9 +7071,7 @@ fm_status fm10000MTableFreeMcastGroupVlanEntries(fm_int sw,
                 FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
             }
 
-            err = fmGetBitArrayBit(&info->clonedEntriesBitArray,
-                                   vlanIndex,
-                                   &expired);
+            err = GetVlanIndexExpired(info, vlanIndex, &expired);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
             if (expired)
             {
@@ -121,6 +121,116 @@ fm_status EnableMtableGroup(fm_int sw, fm_intMulticastGroup *group)
 
 
 
+/*****************************************************************************/
+/** InitPortMTableEntry
+ * \ingroup intMulticast
+ *
+ * \desc            Fills in the MTable entry of a port/VLAN listener on a
+ *                  physical port.
+ *
+ * \param[in]       listener points to the multicast listener entry.
+ *
+ * \param[in]       port is the listener's logical port.
+ *
+ * \param[in]       vlan is the listener's VLAN.
+ *
+ * \param[in]       hasPort is TRUE if port is a valid logical port rather
+ *                  than the CPU port substituted for an internal listener.
+ *
+ * \param[out]      mtableEntry points to the entry to fill in.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void InitPortMTableEntry(fm_intMulticastListener *listener,
+                                fm_int                   port,
+                                fm_uint16                vlan,
+                                fm_bool                  hasPort,
+                                fm10000_mtableEntry *    mtableEntry)
+{
+    FM_CLEAR(*mtableEntry);
+
+    mtableEntry->vlan = vlan;
+    mtableEntry->port = port;
+
+    if (listener->floodListener)
+    {
+        /* We do not want to update vlan for mcast flood filtering. */
+        mtableEntry->vlanUpdate = FALSE;
+        if (hasPort)
+        {
+            mtableEntry->dglortUpdate = TRUE;
+            mtableEntry->dglort = 
+                        listener->listener.info.portVlanListener.xcastGlort;
+        }
+    }
+    else
+    {
+        mtableEntry->vlanUpdate = TRUE;
+    }
+
+}   /* end InitPortMTableEntry */
+
+
+
+
+/*****************************************************************************/
+/** GetBatchedMTableEntry
+ * \ingroup intMulticast
+ *
+ * \desc            Tells whether ''AddListenerToGroup'' would add a listener
+ *                  as a single MTable entry on a physical port, in which
+ *                  case it can be added as part of a list.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       group points to the multicast group entry.
+ *
+ * \param[in]       listener points to the multicast listener entry.
+ *
+ * \param[out]      mtableEntry points to the entry to fill in when TRUE is
+ *                  returned.
+ *
+ * \return          TRUE if the listener can be added with
+ *                  ''fm10000MTableAddListenerList''.
+ *
+ *****************************************************************************/
+static fm_bool GetBatchedMTableEntry(fm_int                   sw,
+                                     fm_intMulticastGroup *   group,
+                                     fm_intMulticastListener *listener,
+                                     fm10000_mtableEntry *    mtableEntry)
+{
+    fm_int    port;
+    fm_uint16 vlan;
+
+    if ( listener->addedToChip ||
+         (listener->listener.listenerType != FM_MCAST_GROUP_LISTENER_PORT_VLAN) ||
+         !group->hasL3Resources ||
+         group->readOnlyRepliGroup )
+    {
+        return FALSE;
+    }
+
+    port = listener->listener.info.portVlanListener.port;
+    vlan = listener->listener.info.portVlanListener.vlan;
+
+    if ( ( (port == -1) && (vlan == 0) ) ||
+         (GET_PORT_PTR(sw, port) == NULL) ||
+         !fmIsCardinalPort(sw, port) ||
+         fmIsInternalPort(sw, port) )
+    {
+        return FALSE;
+    }
+
+    InitPortMTableEntry(listener, port, vlan, TRUE, mtableEntry);
+
+    return TRUE;
+
+}   /* end GetBatchedMTableEntry */
+
+
+
+
 /*****************************************************************************/
 /** AddListenerToGroup
  * \ingroup intMulticast
@@ -317,26 +427,11 @@ static fm_status AddListenerToGroup(fm_int                   sw,
         && group->hasL3Resources 
         && !group->readOnlyRepliGroup)
     {
-        FM_CLEAR(mtableEntry);
-
-        mtableEntry.vlan       = vlan;
-        mtableEntry.port       = port;
-    
-        if (listener->floodListener)
-        {
-            /* We do not want to update vlan for mcast flood filtering. */
-            mtableEntry.vlanUpdate = FALSE;
-            if ( portPtr != NULL )
-            {
-                mtableEntry.dglortUpdate = TRUE;
-                mtableEntry.dglort = 
-                            listener->listener.info.portVlanListener.xcastGlort;
-            }
-        }
-        else
-        {
-            mtableEntry.vlanUpdate = TRUE;
-        }
+        InitPortMTableEntry(listener,
+                            port,
+                            vlan,
+                            (portPtr != NULL),
+                            &mtableEntry);
  
         status = fm10000MTableAddListener(sw,
                                           group->logicalPort,
@@ -1474,6 +1569,141 @@ fm_status fm10000AddMulticastListener(fm_int                   sw,
 
 
 
+/*****************************************************************************/
+/** fm10000AddMulticastListenerList
+ * \ingroup intMulticast
+ *
+ * \desc            Add a list of multicast listeners to a multicast group.
+ *                  Consecutive port/VLAN listeners on physical ports are
+ *                  written to the MTable together with
+ *                  ''fm10000MTableAddListenerList''. Other listeners are
+ *                  added one at a time, in list order.
+ *
+ * \note            This function assumes that it will only be executed
+ *                  when the group is active.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       group points to the multicast group entry.
+ *
+ * \param[in]       numListeners is the number of entries in listeners.
+ *
+ * \param[in]       listeners points to the array of listeners to add.
+ *
+ * \param[out]      numAdded points to caller-provided storage where the
+ *                  number of listeners added, counted from the start of the
+ *                  list, is returned.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if group is null.
+ * \return          FM_ERR_MCAST_GROUP_NOT_ACTIVE if the group is not active.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fm10000AddMulticastListenerList(fm_int                    sw,
+                                          fm_intMulticastGroup *    group,
+                                          fm_int                    numListeners,
+                                          fm_intMulticastListener **listeners,
+                                          fm_int *                  numAdded)
+{
+    fm_status            status;
+    fm10000_mtableEntry *entries;
+    fm_int               runLength;
+    fm_int               added;
+    fm_int               i;
+
+    FM_LOG_ENTRY( FM_LOG_CAT_MULTICAST,
+                  "sw=%d group=%p<%d> numListeners=%d listeners=%p\n",
+                  sw,
+                  (void *) group,
+                  group ? group->handle : -1,
+                  numListeners,
+                  (void *) listeners);
+
+    *numAdded = 0;
+
+    if (group == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_MULTICAST, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    if (!group->activated)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_MULTICAST, FM_ERR_MCAST_GROUP_NOT_ACTIVE);
+    }
+
+    if (numListeners <= 0)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_MULTICAST, FM_OK);
+    }
+
+    entries = fmAlloc(numListeners * sizeof(fm10000_mtableEntry));
+
+    if (entries == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_MULTICAST, FM_ERR_NO_MEM);
+    }
+
+    status = FM_OK;
+    i      = 0;
+
+    while (i < numListeners)
+    {
+        runLength = 0;
+
+        while ( ( (i + runLength) < numListeners ) &&
+                GetBatchedMTableEntry(sw,
+                                      group,
+                                      listeners[i + runLength],
+                                      &entries[runLength]) )
+        {
+            runLength++;
+        }
+
+        if (runLength == 0)
+        {
+            status = AddListenerToGroup(sw, group, listeners[i]);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, status);
+
+            (*numAdded)++;
+            i++;
+            continue;
+        }
+
+        added  = 0;
+        status = fm10000MTableAddListenerList(sw,
+                                              group->logicalPort,
+                                              group->repliGroup,
+                                              runLength,
+                                              entries,
+                                              &added);
+
+        for ( ; added > 0 ; added--)
+        {
+            listeners[i]->addedToChip = TRUE;
+            (*numAdded)++;
+            i++;
+        }
+
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, status);
+
+        FM_LOG_DEBUG( FM_LOG_CAT_MULTICAST,
+                      "mcast group %p (%d), %d listeners added to mtable\n",
+                      (void *) group,
+                      group->handle,
+                      runLength );
+    }
+
+ABORT:
+    fmFree(entries);
+
+    FM_LOG_EXIT(FM_LOG_CAT_MULTICAST, status);
+
+}   /* end fm10000AddMulticastListenerList */
+
+
+
+
 /*****************************************************************************/
 /** fm10000DeleteMulticastListener
  * \ingroup intMulticast
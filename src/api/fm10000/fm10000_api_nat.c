@@ -384,6 +384,7 @@ static void FreeNatCfgStruct(fm_fm10000NatCfg *natCfg)
 static void InitializeNatCfgStruct(fm_fm10000NatCfg *natCfg)
 {
     fmTreeInit(&natCfg->tables);
+    natCfg->listWriteBatch = FALSE;
 
 }   /* end InitializeNatCfgStruct */
 
@@ -3201,6 +3202,97 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000BeginNatRuleList
+ * \ingroup intNat
+ *
+ * \desc            Prepare a table for a list of NAT rule additions or
+ *                  removals, see ''fmAddNatRuleList''. On a
+ *                  ''FM_NAT_MODE_RESOURCE'' table, the tunnel engine
+ *                  register writes are batched until
+ *                  ''fm10000EndNatRuleList''.
+ *                                                                      \lb\lb
+ *                  Rules of a ''FM_NAT_MODE_PERFORMANCE'' table also update
+ *                  their precompiled ACL rule and ECMP group in place,
+ *                  which must be written in order, so their writes are
+ *                  left unbatched.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       table is the table ID.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000BeginNatRuleList(fm_int sw, fm_int table)
+{
+    fm_switch *     switchPtr = GET_SWITCH_PTR(sw);
+    fm10000_switch *switchExt = (fm10000_switch *) switchPtr->extension;
+    fm_status       err;
+    fm_natTable *   publicNatTable;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_NAT, "sw = %d, table = %d\n", sw, table);
+
+    err = fmTreeFind(&switchPtr->natInfo->tables,
+                     table,
+                     (void **) &publicNatTable);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
+
+    if (publicNatTable->natParam.mode == FM_NAT_MODE_RESOURCE)
+    {
+        err = fm10000TunnelBeginWriteBatch(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
+
+        switchExt->natCfg->listWriteBatch = TRUE;
+    }
+
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_NAT, err);
+
+}   /* end fm10000BeginNatRuleList */
+
+
+
+
+/*****************************************************************************/
+/** fm10000EndNatRuleList
+ * \ingroup intNat
+ *
+ * \desc            Issue the tunnel engine register writes batched since
+ *                  ''fm10000BeginNatRuleList''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       table is the table ID.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000EndNatRuleList(fm_int sw, fm_int table)
+{
+    fm10000_switch *switchExt = GET_SWITCH_EXT(sw);
+    fm_status       err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_NAT, "sw = %d, table = %d\n", sw, table);
+
+    err = FM_OK;
+
+    if (switchExt->natCfg->listWriteBatch)
+    {
+        switchExt->natCfg->listWriteBatch = FALSE;
+
+        err = fm10000TunnelEndWriteBatch(sw);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_NAT, err);
+
+}   /* end fm10000EndNatRuleList */
+
+
+
+
 /*****************************************************************************/
 /** fm10000AddNatPrefilter
  * \ingroup intNat
@@ -165,6 +165,7 @@ static fm_status PackArpTablePackingStage(fm_int  sw,
 static fm_status PackArpTable(fm_int  sw,
                               fm_int  blkLength,
                               fm_int  maxIterations);
+static fm_int GetArpFragmentationIndex(fm_int sw);
 static fm_status MaintenanceArpTablePacking(fm_int  sw,
                                             fm_int  startIndex);
 static fm_status GetNewArpBlkHndl(fm_int     sw,
@@ -3007,6 +3008,44 @@ static fm_status MaintenanceArpTablePacking(fm_int  sw,
 
 
 
+/*****************************************************************************/
+/** GetArpFragmentationIndex
+ * \ingroup intNextHop
+ *
+ * \desc            Computes the fragmentation index of the ARP table from
+ *                  the free block statistics. The index is 0 when all free
+ *                  entries are contiguous and grows with the number of
+ *                  separate groups of free entries.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          the fragmentation index, from 0 to 100.
+ *
+ *****************************************************************************/
+static fm_int GetArpFragmentationIndex(fm_int sw)
+{
+    fm10000_switch *pSwitchExt;
+    fm_int          index;
+    fm_int          totalFreeArpAreas;
+
+    pSwitchExt = GET_SWITCH_EXT(sw);
+
+    totalFreeArpAreas = 0;
+
+    for (index = 0; index < FM10000_ARP_BLOCK_SIZE_MAX; index++)
+    {
+        totalFreeArpAreas += (pSwitchExt->pNextHopSysCtrl->freeBlkStatInfo)[index];
+    }
+
+    totalFreeArpAreas = totalFreeArpAreas? totalFreeArpAreas: 1;
+
+    return ((totalFreeArpAreas-1) * 200)/FM10000_ARP_TABLE_ENTRIES;
+
+}   /* end GetArpFragmentationIndex */
+
+
+
+
 /*****************************************************************************/
 /** GetNewArpBlkHndl
  * \ingroup intNextHop
@@ -5540,6 +5579,9 @@ fm_status fm10000NextHopInit(fm_int sw)
         pNextHopCtrl->arpHndlTabLastUsedEntry = 0;
         pNextHopCtrl->arpStatsAgingCounter = 0;
         pNextHopCtrl->lastArpBlkCtrlTabLookupNdx = 1;
+        pNextHopCtrl->arpBgPackingActive = FALSE;
+        pNextHopCtrl->arpBgPackingScanIndex = 1;
+        pNextHopCtrl->arpBgPackingMovedBlocks = 0;
 
         /* intialize ARP handle table */
         err = FillArpHndlTable(sw, 1, FM10000_ARP_TAB_SIZE-1, FM10000_ARP_BLOCK_INVALID_HANDLE);
@@ -6748,6 +6790,121 @@ fm_status fm10000DefragArpTable(fm_int sw)
 
 
 
+/*****************************************************************************/
+/** fm10000ArpTablePeriodicMaintenance
+ * \ingroup intNextHop
+ *
+ * \desc            Packs the ARP table in the background, a bounded number
+ *                  of blocks per call, so that allocations rarely have to
+ *                  wait for a full repack. Packing starts when the
+ *                  fragmentation index reaches
+ *                  FM10000_ARP_BG_PACKING_START_FRAG_INDEX and continues
+ *                  over successive calls until it falls to
+ *                  FM10000_ARP_BG_PACKING_STOP_FRAG_INDEX or no more blocks
+ *                  can be moved. Called from the fast maintenance task.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000ArpTablePeriodicMaintenance(fm_int sw)
+{
+    fm_status               err;
+    fm_switch *             switchPtr;
+    fm10000_switch *        pSwitchExt;
+    fm10000_NextHopSysCtrl *pNextHopCtrl;
+    fm_int                  movedBlockSize;
+    fm_int                  movedBlocks;
+    fm_int                  scans;
+    fm_int                  scanIndex;
+
+    switchPtr    = GET_SWITCH_PTR(sw);
+    pSwitchExt   = GET_SWITCH_EXT(sw);
+    pNextHopCtrl = pSwitchExt->pNextHopSysCtrl;
+
+    /* nothing to do until the ARP table has been initialized */
+    if (pNextHopCtrl == NULL || pNextHopCtrl->ppArpBlkCtrlTab == NULL)
+    {
+        return FM_OK;
+    }
+
+    /* check the start condition before taking the lock */
+    if ( !pNextHopCtrl->arpBgPackingActive &&
+         GetArpFragmentationIndex(sw) < FM10000_ARP_BG_PACKING_START_FRAG_INDEX )
+    {
+        return FM_OK;
+    }
+
+    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_ROUTING, "sw=%d\n", sw);
+
+    err = fmCaptureWriteLock(&switchPtr->routingLock, FM_WAIT_FOREVER);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ROUTING, err);
+
+    if (!pNextHopCtrl->arpBgPackingActive)
+    {
+        pNextHopCtrl->arpBgPackingActive = TRUE;
+        pNextHopCtrl->arpBgPackingScanIndex = pNextHopCtrl->arpHndlTabFirstFreeEntry;
+    }
+
+    movedBlocks = 0;
+    scans = 0;
+    scanIndex = pNextHopCtrl->arpBgPackingScanIndex;
+
+    while ( err == FM_OK &&
+            movedBlocks < FM10000_ARP_BG_PACKING_BLOCKS_PER_TICK &&
+            scans++ < FM10000_ARP_BG_PACKING_SCANS_PER_TICK )
+    {
+        if ( scanIndex < 1 || scanIndex > FM10000_ARP_TAB_AVAILABLE_ENTRIES )
+        {
+            /* the end of the table was reached */
+            pNextHopCtrl->arpBgPackingActive = FALSE;
+            break;
+        }
+
+        err = MoveArpBlockIntoFreeEntries(sw,
+                                          scanIndex,
+                                          TRUE,
+                                          &movedBlockSize);
+
+        if (err == FM_OK)
+        {
+            if (movedBlockSize > 0)
+            {
+                /* a block has been moved, resume from the first free entry */
+                scanIndex = pNextHopCtrl->arpHndlTabFirstFreeEntry;
+                movedBlocks++;
+            }
+            else
+            {
+                scanIndex = GetNextGroupOfArpFreeEntries(sw, scanIndex);
+            }
+        }
+    }
+
+    pNextHopCtrl->arpBgPackingScanIndex = scanIndex;
+    pNextHopCtrl->arpBgPackingMovedBlocks += movedBlocks;
+
+    if ( err != FM_OK ||
+         GetArpFragmentationIndex(sw) <= FM10000_ARP_BG_PACKING_STOP_FRAG_INDEX )
+    {
+        pNextHopCtrl->arpBgPackingActive = FALSE;
+    }
+
+    fmReleaseWriteLock(&switchPtr->routingLock);
+
+    FM_LOG_DEBUG(FM_LOG_CAT_ROUTING,
+                 "ARP background packing: moved blocks=%d, active=%d\n",
+                 movedBlocks,
+                 pNextHopCtrl->arpBgPackingActive);
+
+    FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ROUTING, err);
+
+}   /* end fm10000ArpTablePeriodicMaintenance */
+
+
+
+
 /*****************************************************************************/
 /** fm10000SetInterfaceAttribute
  * \ingroup intNextHopIf
@@ -9427,7 +9584,11 @@ void fm10000DbgPrintArpFragmentationInfo(fm_int  sw)
     FM_LOG_PRINT(" Total allocated blocks...........%d\n", totalAllocatedBlocks);
     FM_LOG_PRINT(" Total free entries...............%d\n", pSwitchExt->pNextHopSysCtrl->arpTabFreeEntryCount);
     FM_LOG_PRINT(" Total free areas.................%d\n", totalFreeArpAreas);
-    FM_LOG_PRINT(" Fragmentation index [0..100].....%d\n\n", ((totalFreeArpAreas-1) * 200)/FM10000_ARP_TABLE_ENTRIES);
+    FM_LOG_PRINT(" Fragmentation index [0..100].....%d\n", GetArpFragmentationIndex(sw));
+    FM_LOG_PRINT(" Background packing...............%s\n",
+                 pSwitchExt->pNextHopSysCtrl->arpBgPackingActive ? "active" : "idle");
+    FM_LOG_PRINT(" Background packing moved blocks..%" FM_FORMAT_64 "u\n\n",
+                 pSwitchExt->pNextHopSysCtrl->arpBgPackingMovedBlocks);
 
 }   /* end fm10000DbgPrintArpFragmentationInfo */
 
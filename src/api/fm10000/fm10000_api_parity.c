@@ -422,6 +422,9 @@ fm_status fm10000InitParity(fm_switch * switchPtr)
     fm_int              sw;
     fm_status           err;
     fm_int              crmTimeout;
+    fm_int              sweepBudget;
+    fm_int              coalesceWindow;
+    fm_char             timerName[32];
     fm10000_parityInfo *parityInfo;
 
     FM_LOG_ENTRY(FM_LOG_CAT_PARITY,
@@ -454,6 +457,42 @@ fm_status fm10000InitParity(fm_switch * switchPtr)
         parityInfo->crmTimeout.usec =  FM10000_CRM_TIMEOUT * 1000;
     }
 
+    sweepBudget = GET_FM10000_PROPERTY()->paritySweepBudget;
+
+    if (sweepBudget > 0)
+    {
+        parityInfo->sweepBudget.sec  = sweepBudget / 1000000;
+        parityInfo->sweepBudget.usec = sweepBudget % 1000000;
+    }
+    else
+    {
+        parityInfo->sweepBudget.sec  = 0;
+        parityInfo->sweepBudget.usec = 0;
+    }
+
+    coalesceWindow = GET_FM10000_PROPERTY()->parityCoalesceWindow;
+
+    if (coalesceWindow > 0)
+    {
+        parityInfo->coalesceWindow.sec  = coalesceWindow / 1000;
+        parityInfo->coalesceWindow.usec = (coalesceWindow % 1000) * 1000;
+    }
+    else
+    {
+        parityInfo->coalesceWindow.sec  = 0;
+        parityInfo->coalesceWindow.usec = 0;
+    }
+
+    parityInfo->coalesceThreshold =
+        (fm_uint32) GET_FM10000_PROPERTY()->parityCoalesceThreshold;
+
+    parityInfo->coalesceState = FM10000_COALESCE_IDLE;
+
+    FM_SPRINTF_S(timerName, sizeof(timerName), "parityCoalesce%02dTimer", sw);
+
+    err = fmCreateTimer(timerName, fmApiTimerTask, &parityInfo->coalesceTimer);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PARITY, err);
+
 ABORT:
     FM_LOG_EXIT(FM_LOG_CAT_PARITY, err);
 
@@ -481,6 +520,12 @@ fm_status fm10000FreeParityResources(fm_switch * switchPtr)
 
     switchExt = switchPtr->extension;
 
+    if (switchExt->parityInfo.coalesceTimer != NULL)
+    {
+        fmDeleteTimer(switchExt->parityInfo.coalesceTimer);
+        switchExt->parityInfo.coalesceTimer = NULL;
+    }
+
     err = fmDeleteLock(&switchExt->parityLock);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PARITY, err);
 
@@ -826,6 +871,12 @@ fm_status fm10000DbgDumpParityConfig(fm_int sw)
     FM_LOG_PRINT("Refcount UERR fatal           : %d\n\n",
                  parityInfo->refcountUerrFatal);
 
+    FM_LOG_PRINT("Coalesce window (msec)        : %" FM_FORMAT_64 "u\n",
+                 parityInfo->coalesceWindow.sec * 1000 +
+                 parityInfo->coalesceWindow.usec / 1000);
+    FM_LOG_PRINT("Coalesce threshold            : %u\n\n",
+                 parityInfo->coalesceThreshold);
+
     FM_LOG_EXIT(FM_LOG_CAT_PARITY, FM_OK);
 
 }   /* end fm10000DbgDumpParityConfig */
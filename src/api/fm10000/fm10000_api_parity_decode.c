@@ -930,6 +930,10 @@ static fm_status RequestRepair(fm_int     sw,
         parityInfo->pendingUerrs |= bitMask;
     }
 
+    /* A new error restarts any partially completed repair of the
+     * same memory from the beginning. */
+    parityInfo->resumeIndex[repairType] = 0;
+
     switch (repairType)
     {
         case FM_REPAIR_FFU_SLICE_SRAM:
@@ -3941,23 +3945,27 @@ static fm_status DecodeTunnelEngine(fm_switch * switchPtr, fm_int teId)
 
 
 /*****************************************************************************/
-/** DecodeCrm
+/** NotifyCrmFaults
  * \ingroup intParity
  *
- * \desc            Decodes CRM interrupts.
+ * \desc            Notifies the CRM of TCAM checksum faults and posts
+ *                  requests to the sweeper task to repair the TCAMs.
  *
  * \param[in]       switchPtr points to the switch structure.
  *
+ * \param[in]       crmInt is the set of CRM_IP InterruptPending bits
+ *                  to be processed.
+ *
+ * \param[in,out]   counters points to the error counters to be updated.
+ *
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
-static fm_status DecodeCrm(fm_switch * switchPtr)
+static fm_status NotifyCrmFaults(fm_switch *     switchPtr,
+                                 fm_uint64       crmInt,
+                                 errorCounters * counters)
 {
     fm10000_switch *    switchExt;
-    fm10000_parityInfo *parityInfo;
-    errorCounters       counters;
-    fm_uint64           crmInt;
-    fm_uint32           crmErr;
     fm_uint32           sliceMask;
     fm_uint32           errCount;
     fm_status           retStatus;
@@ -3968,34 +3976,10 @@ static fm_status DecodeCrm(fm_switch * switchPtr)
     fm_int              crmId;
 
     switchExt  = switchPtr->extension;
-    parityInfo = &switchExt->parityInfo;
     sw = switchPtr->switchNumber;
 
-    FM_LOG_ENTRY(FM_LOG_CAT_PARITY, "sw=%d\n", sw);
-
-    FM_CLEAR(counters);
-
     retStatus = FM_OK;
 
-    /**************************************************
-     * Decode CRM_IP interrupt bits.
-     **************************************************/
-
-    crmInt = FM_ARRAY_GET_FIELD64(parityInfo->crm_ip,
-                                  FM10000_CRM_IP,
-                                  InterruptPending);
-
-    crmErr = FM_ARRAY_GET_FIELD(parityInfo->crm_ip,
-                                FM10000_CRM_IP,
-                                SramErr);
-
-    FM_CLEAR(parityInfo->crm_ip);
-
-    FM_LOG_ERROR(FM_LOG_CAT_PARITY,
-                 "crmInt=%08llx crmErr=%d\n",
-                 crmInt,
-                 crmErr);
-
     /**************************************************
      * Handle FFU_SLICE_TCAM checksum errors.
      **************************************************/
@@ -4005,8 +3989,8 @@ static fm_status DecodeCrm(fm_switch * switchPtr)
     {
         errCount = CountBits(sliceMask);
 
-        counters.errors     += errCount;
-        counters.repairable += errCount;
+        counters->errors     += errCount;
+        counters->repairable += errCount;
 
         for (sliceId = 0 ; sliceId < FM10000_FFU_SLICE_SRAM_ENTRIES_1 ; sliceId++)
         {
@@ -4032,8 +4016,8 @@ static fm_status DecodeCrm(fm_switch * switchPtr)
 
     if ( (crmInt & CRM_GLORT_CAM_INT_MASK ) && switchExt->isCrmStarted )
     {
-        counters.errors     += 1;
-        counters.repairable += 1;
+        counters->errors     += 1;
+        counters->repairable += 1;
 
         FM_LOG_ERROR(FM_LOG_CAT_PARITY,
                      "FM10000_CRM_EVENT_FAULT_IND for crmId %d\n",
@@ -4045,6 +4029,67 @@ static fm_status DecodeCrm(fm_switch * switchPtr)
         RequestRepair(sw, FM_REPAIR_GLORT_CAM, TRUE, 0);
     }
 
+    return retStatus;
+
+}   /* end NotifyCrmFaults */
+
+
+
+
+/*****************************************************************************/
+/** DecodeCrm
+ * \ingroup intParity
+ *
+ * \desc            Decodes CRM interrupts.
+ *
+ * \param[in]       switchPtr points to the switch structure.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status DecodeCrm(fm_switch * switchPtr)
+{
+    fm10000_switch *    switchExt;
+    fm10000_parityInfo *parityInfo;
+    errorCounters       counters;
+    fm_uint64           crmInt;
+    fm_uint32           crmErr;
+    fm_status           retStatus;
+    fm_status           err;
+    fm_int              sw;
+
+    switchExt  = switchPtr->extension;
+    parityInfo = &switchExt->parityInfo;
+    sw = switchPtr->switchNumber;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PARITY, "sw=%d\n", sw);
+
+    FM_CLEAR(counters);
+
+    retStatus = FM_OK;
+
+    /**************************************************
+     * Decode CRM_IP interrupt bits.
+     **************************************************/
+
+    crmInt = FM_ARRAY_GET_FIELD64(parityInfo->crm_ip,
+                                  FM10000_CRM_IP,
+                                  InterruptPending);
+
+    crmErr = FM_ARRAY_GET_FIELD(parityInfo->crm_ip,
+                                FM10000_CRM_IP,
+                                SramErr);
+
+    FM_CLEAR(parityInfo->crm_ip);
+
+    FM_LOG_ERROR(FM_LOG_CAT_PARITY,
+                 "crmInt=%08llx crmErr=%d\n",
+                 crmInt,
+                 crmErr);
+
+    err = NotifyCrmFaults(switchPtr, crmInt, &counters);
+    FM_ERR_COMBINE(retStatus, err);
+
 #if 0
     /**************************************************
      * Handle CRM parity errors.
@@ -4067,6 +4112,97 @@ static fm_status DecodeCrm(fm_switch * switchPtr)
 
 
 
+/*****************************************************************************/
+/** HandleCoalesceTimer
+ * \ingroup intParity
+ *
+ * \desc            Coalescing window timer callback. Hands the closing
+ *                  of the window to the parity repair task.
+ *
+ * \param[in]       arg points to the ''fm10000_parityInfo'' structure.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void HandleCoalesceTimer(void * arg)
+{
+    fm10000_parityInfo *parityInfo;
+
+    parityInfo = arg;
+
+    parityInfo->coalesceExpired = TRUE;
+
+    fmSignalSemaphore(&fmRootApi->parityRepairSemaphore);
+
+}   /* end HandleCoalesceTimer */
+
+
+
+
+/*****************************************************************************/
+/** ArmCoalesceWindow
+ * \ingroup intParity
+ *
+ * \desc            Starts the timer for a coalescing window that was
+ *                  opened by a first-stage interrupt handler.
+ *
+ * \param[in]       switchPtr points to the switch structure.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status ArmCoalesceWindow(fm_switch * switchPtr)
+{
+    fm10000_switch *    switchExt;
+    fm10000_parityInfo *parityInfo;
+    fm_bool             arm;
+    fm_status           err;
+    fm_int              sw;
+
+    switchExt  = switchPtr->extension;
+    parityInfo = &switchExt->parityInfo;
+    sw = switchPtr->switchNumber;
+
+    arm = FALSE;
+
+    TAKE_REG_LOCK(sw);
+
+    if (parityInfo->coalesceState == FM10000_COALESCE_OPEN)
+    {
+        parityInfo->coalesceState = FM10000_COALESCE_ARMED;
+        arm = TRUE;
+    }
+
+    DROP_REG_LOCK(sw);
+
+    if (!arm)
+    {
+        return FM_OK;
+    }
+
+    err = fmStartTimer(parityInfo->coalesceTimer,
+                       &parityInfo->coalesceWindow,
+                       1,
+                       HandleCoalesceTimer,
+                       parityInfo);
+
+    if (err != FM_OK)
+    {
+        /* Close the window right away rather than leave memories
+         * masked with nothing to unmask them. */
+        FM_LOG_ERROR(FM_LOG_CAT_PARITY,
+                     "Unable to start coalescing timer: %s\n",
+                     fmErrorMsg(err));
+        HandleCoalesceTimer(parityInfo);
+    }
+
+    return err;
+
+}   /* end ArmCoalesceWindow */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -4202,6 +4338,9 @@ fm_status fm10000ParityErrorDecoder(fm_switch * switchPtr)
         FM_ERR_COMBINE(retStatus, err);
     }
 
+    err = ArmCoalesceWindow(switchPtr);
+    FM_ERR_COMBINE(retStatus, err);
+
     parityInfo->parityState = FM10000_PARITY_STATE_INACTIVE;
 
 ABORT:
@@ -4210,3 +4349,194 @@ ABORT:
 
 }   /* end fm10000ParityErrorDecoder */
 
+
+
+
+
+/*****************************************************************************/
+/** fm10000CloseParityCoalesceWindow
+ * \ingroup intParity
+ *
+ * \desc            Closes an expired error coalescing window. Reports
+ *                  one summary event for each memory whose errors were
+ *                  coalesced, repairs the TCAMs whose CRM errors were
+ *                  deferred, and unmasks the FRAME_MEMORY segments that
+ *                  were throttled.
+ *
+ * \note            Called from the parity repair task.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000CloseParityCoalesceWindow(fm_int sw)
+{
+    fm_switch *         switchPtr;
+    fm10000_parityInfo *parityInfo;
+    fm_eventParityError parityEvent;
+    errorCounters       counters;
+    fm_uint32           sramErrCount[FM10000_COALESCE_BITS];
+    fm_uint32           crmErrCount[FM10000_COALESCE_BITS];
+    fm_uint64           throttled;
+    fm_uint64           deferred;
+    fm_uint64           imVal;
+    fm_uint32           crmErrTotal;
+    fm_uint32           coalesced;
+    fm_int              bitNo;
+    fm_status           retStatus;
+    fm_status           err;
+
+    switchPtr  = GET_SWITCH_PTR(sw);
+    parityInfo = GET_PARITY_INFO(sw);
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PARITY, "sw=%d\n", sw);
+
+    retStatus = FM_OK;
+
+    /**************************************************
+     * Take a snapshot of the window and start afresh.
+     **************************************************/
+
+    TAKE_REG_LOCK(sw);
+
+    parityInfo->coalesceExpired = FALSE;
+
+    FM_MEMCPY_S(sramErrCount,
+                sizeof(sramErrCount),
+                parityInfo->sramErrCount,
+                sizeof(parityInfo->sramErrCount));
+
+    FM_MEMCPY_S(crmErrCount,
+                sizeof(crmErrCount),
+                parityInfo->crmErrCount,
+                sizeof(parityInfo->crmErrCount));
+
+    throttled = parityInfo->sramErrThrottled;
+    deferred  = parityInfo->crmErrDeferred;
+
+    FM_CLEAR(parityInfo->sramErrCount);
+    FM_CLEAR(parityInfo->crmErrCount);
+
+    parityInfo->sramErrDecoded   = 0;
+    parityInfo->crmErrDecoded    = 0;
+    parityInfo->sramErrThrottled = 0;
+    parityInfo->crmErrDeferred   = 0;
+    parityInfo->coalesceState    = FM10000_COALESCE_IDLE;
+
+    /**************************************************
+     * Unmask the throttled segments. Errors latched
+     * while they were masked are reported at once and
+     * open the next window.
+     **************************************************/
+
+    if ( throttled &&
+         parityInfo->interruptsEnabled &&
+         (parityInfo->parityState < FM10000_PARITY_STATE_FATAL) )
+    {
+        err = switchPtr->ReadUINT64(sw, FM10000_SRAM_ERR_IM(0), &imVal);
+        FM_ERR_COMBINE(retStatus, err);
+
+        if (err == FM_OK)
+        {
+            err = switchPtr->WriteUINT64(sw,
+                                         FM10000_SRAM_ERR_IM(0),
+                                         imVal & ~throttled);
+            FM_ERR_COMBINE(retStatus, err);
+        }
+    }
+
+    DROP_REG_LOCK(sw);
+
+    if (parityInfo->parityState >= FM10000_PARITY_STATE_FATAL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PARITY, retStatus);
+    }
+
+    /**************************************************
+     * Count and report the FRAME_MEMORY errors that
+     * were not decoded individually.
+     **************************************************/
+
+    for (bitNo = 0 ; bitNo < FM10000_COALESCE_BITS ; bitNo++)
+    {
+        if (sramErrCount[bitNo] <= 1)
+        {
+            continue;
+        }
+
+        coalesced = sramErrCount[bitNo] - 1;
+
+        fmDbgDiagCountIncr(sw, FM_CTR_PARITY_AREA_ARRAY, coalesced);
+        fmDbgDiagCountIncr(sw, FM_CTR_PARITY_SEVERITY_TRANSIENT, coalesced);
+        fmDbgDiagCountIncr(sw, FM_CTR_PARITY_COALESCED, coalesced);
+
+        FM_CLEAR(parityEvent);
+
+        parityEvent.errType = FM_PARITY_ERRTYPE_SRAM_CORRECTED;
+        parityEvent.paritySeverity = FM_PARITY_SEVERITY_TRANSIENT;
+        parityEvent.memoryArea = FM_PARITY_AREA_ARRAY;
+        parityEvent.parityStatus = FM_PARITY_STATUS_NO_ACTION_REQUIRED;
+        parityEvent.numErrors = (fm_int) sramErrCount[bitNo];
+        parityEvent.sramNo = FM10000_SRAM_FRAME_MEMORY + bitNo;
+
+        err = fmSendParityErrorEvent(sw, parityEvent, &fmRootApi->eventThread);
+        if (err != FM_OK)
+        {
+            fmDbgDiagCountIncr(sw, FM_CTR_PARITY_EVENT_LOST, 1);
+            FM_ERR_COMBINE(retStatus, err);
+        }
+    }
+
+    /**************************************************
+     * Repair the TCAMs whose CRM errors were deferred,
+     * and report the CRM errors in a single event.
+     **************************************************/
+
+    if (deferred)
+    {
+        FM_CLEAR(counters);
+
+        err = NotifyCrmFaults(switchPtr, deferred, &counters);
+        FM_ERR_COMBINE(retStatus, err);
+    }
+
+    crmErrTotal = 0;
+    coalesced   = 0;
+
+    for (bitNo = 0 ; bitNo < FM10000_COALESCE_BITS ; bitNo++)
+    {
+        if (crmErrCount[bitNo] > 1)
+        {
+            crmErrTotal += crmErrCount[bitNo];
+            coalesced   += crmErrCount[bitNo] - 1;
+        }
+    }
+
+    if (coalesced)
+    {
+        fmDbgDiagCountIncr(sw, FM_CTR_PARITY_AREA_TCAM, coalesced);
+        fmDbgDiagCountIncr(sw, FM_CTR_PARITY_SEVERITY_REPAIRABLE, coalesced);
+        fmDbgDiagCountIncr(sw, FM_CTR_PARITY_COALESCED, coalesced);
+
+        FM_CLEAR(parityEvent);
+
+        parityEvent.errType = FM_PARITY_ERRTYPE_SRAM_CORRECTED;
+        parityEvent.paritySeverity = FM_PARITY_SEVERITY_USER_FIXABLE;
+        parityEvent.memoryArea = FM_PARITY_AREA_TCAM;
+        parityEvent.parityStatus = FM_PARITY_STATUS_NO_ACTION_REQUIRED;
+        parityEvent.numErrors = (fm_int) crmErrTotal;
+        parityEvent.sramNo = FM10000_SRAM_UNDEF;
+
+        err = fmSendParityErrorEvent(sw, parityEvent, &fmRootApi->eventThread);
+        if (err != FM_OK)
+        {
+            fmDbgDiagCountIncr(sw, FM_CTR_PARITY_EVENT_LOST, 1);
+            FM_ERR_COMBINE(retStatus, err);
+        }
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_PARITY, retStatus);
+
+}   /* end fm10000CloseParityCoalesceWindow */
+
@@ -85,6 +85,65 @@
 
 
 
+/*****************************************************************************/
+/** CoalesceErrors
+ * \ingroup intParity
+ *
+ * \desc            Counts a set of memory errors against the current
+ *                  coalescing window, opening a window if none is open.
+ *
+ * \note            The caller has taken the register lock.
+ *
+ * \param[in]       parityInfo points to the parity state structure.
+ *
+ * \param[in]       ipVal is the set of interrupt bits being reported.
+ *
+ * \param[in,out]   errCount points to the per-bit error counts for the
+ *                  current window.
+ *
+ * \param[in,out]   decoded points to the set of bits that have already
+ *                  been decoded in the current window.
+ *
+ * \return          The subset of ipVal that is to be decoded now.
+ *
+ *****************************************************************************/
+static fm_uint64 CoalesceErrors(fm10000_parityInfo * parityInfo,
+                                fm_uint64            ipVal,
+                                fm_uint32 *          errCount,
+                                fm_uint64 *          decoded)
+{
+    fm_uint64   newVal;
+    fm_int      bitNo;
+
+    if ( (parityInfo->coalesceWindow.sec == 0) &&
+         (parityInfo->coalesceWindow.usec == 0) )
+    {
+        return ipVal;
+    }
+
+    if (parityInfo->coalesceState == FM10000_COALESCE_IDLE)
+    {
+        parityInfo->coalesceState = FM10000_COALESCE_OPEN;
+    }
+
+    for (bitNo = 0 ; bitNo < FM10000_COALESCE_BITS ; bitNo++)
+    {
+        if ( ipVal & (FM_LITERAL_U64(1) << bitNo) )
+        {
+            errCount[bitNo]++;
+        }
+    }
+
+    newVal = ipVal & ~(*decoded);
+    *decoded |= ipVal;
+
+    return newVal;
+
+}   /* end CoalesceErrors */
+
+
+
+
 /*****************************************************************************/
 /** fm10000CrossbarInterruptHandler
  * \ingroup intSwitch
@@ -302,6 +361,9 @@ static fm_status fm10000SramErrInterruptHandler(fm_switch * switchPtr,
     fm10000_parityInfo *parityInfo;
     fm_uint64           ipVal;
     fm_uint64           imVal;
+    fm_uint64           decodeVal;
+    fm_uint64           throttleVal;
+    fm_int              bitNo;
     fm_int              sw;
     fm_status           err;
     fm_status           retStatus;
@@ -339,8 +401,48 @@ static fm_status fm10000SramErrInterruptHandler(fm_switch * switchPtr,
         err = switchPtr->WriteUINT64(sw, FM10000_SRAM_ERR_IP(0), ipVal);
         FM_LOG_COMBINE_ON_ERR(FM_LOG_CAT_PARITY, err, retStatus);
 
-        parityInfo->sram_ip |= ipVal;
-        parityInfo->parityState = FM10000_PARITY_STATE_DECODE;
+        decodeVal = CoalesceErrors(parityInfo,
+                                   ipVal,
+                                   parityInfo->sramErrCount,
+                                   &parityInfo->sramErrDecoded);
+
+        /**************************************************
+         * A segment that keeps reporting errors within the
+         * window is masked until the window closes, so a
+         * marginal memory cannot monopolize the interrupt
+         * thread.
+         **************************************************/
+
+        throttleVal = 0;
+
+        if (parityInfo->coalesceThreshold)
+        {
+            for (bitNo = 0 ; bitNo < FM10000_COALESCE_BITS ; bitNo++)
+            {
+                if ( (ipVal & (FM_LITERAL_U64(1) << bitNo)) &&
+                     (parityInfo->sramErrCount[bitNo] >=
+                      parityInfo->coalesceThreshold) )
+                {
+                    throttleVal |= FM_LITERAL_U64(1) << bitNo;
+                }
+            }
+        }
+
+        if (throttleVal)
+        {
+            err = switchPtr->WriteUINT64(sw,
+                                         FM10000_SRAM_ERR_IM(0),
+                                         imVal | throttleVal);
+            FM_LOG_COMBINE_ON_ERR(FM_LOG_CAT_PARITY, err, retStatus);
+
+            parityInfo->sramErrThrottled |= throttleVal;
+        }
+
+        if (decodeVal)
+        {
+            parityInfo->sram_ip |= decodeVal;
+            parityInfo->parityState = FM10000_PARITY_STATE_DECODE;
+        }
 
     }   /* end if (ipVal) */
 
@@ -482,6 +584,8 @@ fm_status fm10000CrmInterruptHandler(fm_switch * switchPtr)
     fm_uint32           ipVal[FM10000_CRM_IP_WIDTH];
     fm_uint32           imVal[FM10000_CRM_IP_WIDTH];
     fm_uint32           maskVal[FM10000_CRM_IP_WIDTH];
+    fm_uint64           crmInt;
+    fm_uint64           decodeInt;
     fm_int              sw;
     fm_status           err;
     fm_status           retStatus;
@@ -541,12 +645,28 @@ fm_status fm10000CrmInterruptHandler(fm_switch * switchPtr)
                                          ipVal);
         FM_LOG_COMBINE_ON_ERR(FM_LOG_CAT_PARITY, err, retStatus);
 
+        /* Repeated errors within the coalescing window stay masked, and
+         * are repaired when the window closes. */
+        crmInt = FM_ARRAY_GET_FIELD64(ipVal, FM10000_CRM_IP, InterruptPending);
+
+        decodeInt = CoalesceErrors(parityInfo,
+                                   crmInt,
+                                   parityInfo->crmErrCount,
+                                   &parityInfo->crmErrDecoded);
+
+        parityInfo->crmErrDeferred |= crmInt & ~decodeInt;
+
+        FM_ARRAY_SET_FIELD64(ipVal, FM10000_CRM_IP, InterruptPending, decodeInt);
+
         for (i = 0 ; i < FM10000_CRM_IP_WIDTH ; i++)
         {
             parityInfo->crm_ip[i] |= ipVal[i];
         }
 
-        parityInfo->parityState = FM10000_PARITY_STATE_DECODE;
+        if (ipVal[0] || ipVal[1] || ipVal[2])
+        {
+            parityInfo->parityState = FM10000_PARITY_STATE_DECODE;
+        }
 
     }   /* end if (ipVal[0] || ipVal[1] || ipVal[2]) */
 
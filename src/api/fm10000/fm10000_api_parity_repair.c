@@ -52,6 +52,10 @@
 
 #define MOD_STATS_QUANTUM       8
 
+/* Number of entries restored from the register cache between checks of
+ * the repair pass time budget. */
+#define RESTORE_QUANTUM         64
+
 typedef struct _fm_regDesc
 {
     const char *regName;
@@ -198,6 +202,83 @@ fm_status fm10000RepairTeUsed(fm_int sw, fm_int teId)
 
 
 
+/*****************************************************************************/
+/** SweepBudgetSpent
+ * \ingroup intParity
+ *
+ * \desc            Determines whether the current repair pass has used up
+ *                  its time budget.
+ *
+ * \param[in]       parityInfo points to the parity state structure.
+ *
+ * \return          TRUE if the repair pass should yield.
+ * \return          FALSE if the pass may continue, or is unbounded.
+ *
+ *****************************************************************************/
+static fm_bool SweepBudgetSpent(fm10000_parityInfo * parityInfo)
+{
+    fm_timestamp    now;
+
+    if (parityInfo->sweepBudget.sec == 0 && parityInfo->sweepBudget.usec == 0)
+    {
+        return FALSE;
+    }
+
+    if (fmGetTime(&now) != FM_OK)
+    {
+        return FALSE;
+    }
+
+    return (fmCompareTimestamps(&now, &parityInfo->sweepDeadline) >= 0);
+
+}   /* end SweepBudgetSpent */
+
+
+
+
+/*****************************************************************************/
+/** SuspendRepair
+ * \ingroup intParity
+ *
+ * \desc            Suspends the active repair if the current repair pass
+ *                  has used up its time budget, recording the entry at
+ *                  which the repair is to resume on the next pass.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       nextIndex is the first entry not yet repaired.
+ *
+ * \return          TRUE if the repair was suspended.
+ * \return          FALSE if the repair should continue.
+ *
+ *****************************************************************************/
+static fm_bool SuspendRepair(fm_int sw, fm_int nextIndex)
+{
+    fm10000_parityInfo *parityInfo;
+
+    parityInfo = GET_PARITY_INFO(sw);
+
+    if ( (parityInfo->activeRepair == FM_REPAIR_TYPE_NONE) ||
+         !SweepBudgetSpent(parityInfo) )
+    {
+        return FALSE;
+    }
+
+    parityInfo->activeIndex     = nextIndex;
+    parityInfo->activeSuspended = TRUE;
+
+    FM_LOG_DEBUG(FM_LOG_CAT_PARITY,
+                 "%s: suspended at entry %d\n",
+                 fmRepairTypeToText(parityInfo->activeRepair),
+                 nextIndex);
+
+    return TRUE;
+
+}   /* end SuspendRepair */
+
+
+
+
 /*****************************************************************************/
 /** RefreshRegisterTable
  * \ingroup intParity
@@ -223,6 +304,10 @@ fm_status fm10000RepairTeUsed(fm_int sw, fm_int teId)
  *                  when no soft state is available, or when an uncorrectable
  *                  error will require a reset anyway.
  *
+ *                  If the repair pass runs out of time, the refresh is
+ *                  suspended and resumes from the same entry on the
+ *                  next pass.
+ *
  * \param[in]       sw is the switch on which to operate.
  * 
  * \param[in]       regDesc points to the register table descriptor.
@@ -234,6 +319,7 @@ static fm_status RefreshRegisterTable(fm_int sw, const fm_regDesc * regDesc)
 {
     fm_uint32   regVal[64];
     fm_switch * switchPtr;
+    fm10000_parityInfo *parityInfo;
     fm_int      index;
     fm_uint32   regAddr;
     fm_int      limit;
@@ -256,7 +342,8 @@ static fm_status RefreshRegisterTable(fm_int sw, const fm_regDesc * regDesc)
         FM_LOG_EXIT(FM_LOG_CAT_PARITY, FM_ERR_ASSERTION_FAILED);
     }
 
-    switchPtr = GET_SWITCH_PTR(sw);
+    switchPtr  = GET_SWITCH_PTR(sw);
+    parityInfo = GET_PARITY_INFO(sw);
     err = FM_OK;
 
     quantum = (fm_int)FM_NENTRIES(regVal) / regDesc->width;
@@ -275,7 +362,14 @@ static fm_status RefreshRegisterTable(fm_int sw, const fm_regDesc * regDesc)
                  regDesc->entries / quantum,
                  regDesc->entries % quantum);
 
-    for (index = 0 ; index < regDesc->entries ; index += quantum)
+    index = 0;
+    if ( (parityInfo->activeRepair != FM_REPAIR_TYPE_NONE) &&
+         (parityInfo->activeIndex < regDesc->entries) )
+    {
+        index = parityInfo->activeIndex;
+    }
+
+    for ( ; index < regDesc->entries ; index += quantum)
     {
         regAddr = regDesc->regAddr + (index * regDesc->stride);
 
@@ -308,7 +402,12 @@ static fm_status RefreshRegisterTable(fm_int sw, const fm_regDesc * regDesc)
             break;
         }
 
-    }   /* end for (index = 0 ; index < maxIndex ; index += 32) */
+        if ( (limit < regDesc->entries) && SuspendRepair(sw, limit) )
+        {
+            break;
+        }
+
+    }   /* end for ( ; index < regDesc->entries ; index += quantum) */
 
     FM_LOG_EXIT(FM_LOG_CAT_PARITY, err);
 
@@ -324,6 +423,11 @@ static fm_status RefreshRegisterTable(fm_int sw, const fm_regDesc * regDesc)
  * \desc            Repairs the specified register table by rewriting its
  *                  contents from the software cache.
  *
+ *                  If the repair pass has a time budget, the table is
+ *                  written RESTORE_QUANTUM entries at a time, and the
+ *                  restore is suspended and resumed on the next pass once
+ *                  the budget is spent.
+ *
  * \param[in]       sw is the switch on which to operate.
  * 
  * \param[in]       regName is the register table name.
@@ -343,9 +447,32 @@ static fm_status RestoreFromCache(fm_int                sw,
                                   fm_int                index1,
                                   fm_int                nEntries)
 {
+    fm10000_parityInfo *parityInfo;
     fm_uint32   indices[FM_REGS_CACHE_MAX_INDICES];
+    fm_int      index;
+    fm_int      quantum;
+    fm_int      count;
     fm_status   err;
 
+    parityInfo = GET_PARITY_INFO(sw);
+
+    index   = 0;
+    quantum = nEntries;
+
+    if (parityInfo->activeRepair != FM_REPAIR_TYPE_NONE)
+    {
+        if (parityInfo->activeIndex < nEntries)
+        {
+            index = parityInfo->activeIndex;
+        }
+
+        if ( (parityInfo->sweepBudget.sec != 0) ||
+             (parityInfo->sweepBudget.usec != 0) )
+        {
+            quantum = RESTORE_QUANTUM;
+        }
+    }
+
     if (regSet->nIndices == 2)
     {
         FM_LOG_DEBUG(FM_LOG_CAT_PARITY,
@@ -360,7 +487,31 @@ static fm_status RestoreFromCache(fm_int                sw,
     FM_CLEAR(indices);
     indices[1] = index1;
 
-    err = fmRegCacheWriteFromCache(sw, regSet, indices, nEntries);
+    err = FM_OK;
+
+    while (index < nEntries)
+    {
+        count = nEntries - index;
+        if (count > quantum)
+        {
+            count = quantum;
+        }
+
+        indices[0] = index;
+
+        err = fmRegCacheWriteFromCache(sw, regSet, indices, count);
+        if (err != FM_OK)
+        {
+            break;
+        }
+
+        index += count;
+
+        if ( (index < nEntries) && SuspendRepair(sw, index) )
+        {
+            return FM_OK;
+        }
+    }
 
     if (err == FM_OK)
     {
@@ -1919,6 +2070,13 @@ static fm_status PerformRepair(fm_int               sw,
  * \desc            Scans the bitmasks indicating which SRAMS need to be
  *                  repaired, processing each SRAM individually.
  *
+ *                  If a time budget is configured for the repair pass,
+ *                  the sweep yields once the budget is spent. Repairs
+ *                  that were not reached remain pending, a register table
+ *                  whose refresh was cut short is resumed from the entry
+ *                  at which it stopped, and the repair task is signalled
+ *                  to run another pass.
+ *
  * \param[in]       sw is the switch on which to operate.
  *
  * \param[in,out]   switchProtected points to a Boolean that indicates
@@ -1940,6 +2098,9 @@ static fm_status SweepPendingRepairs(fm_int      sw,
     fm_uint64           bitMask;
     fm_bool             found;
     fm_bool             isUerr;
+    fm_bool             resumable;
+    fm_bool             performed;
+    fm_bool             yielded;
 
     static const fm10000_repairData ZERO_REPAIR_DATA = { 0 };
 
@@ -1947,19 +2108,35 @@ static fm_status SweepPendingRepairs(fm_int      sw,
 
     parityInfo = GET_PARITY_INFO(sw);
 
+    performed = FALSE;
+    yielded   = FALSE;
+
     if ( (parityInfo->parityState < FM10000_PARITY_STATE_FATAL) &&
          (parityInfo->pendingRepairs != 0) )
     {
+        fmGetTime(&parityInfo->sweepDeadline);
+        fmAddTimestamps(&parityInfo->sweepDeadline, &parityInfo->sweepBudget);
+
         for (repairType = 0 ; repairType < FM_REPAIR_TYPE_MAX ; repairType++)
         {
             bitMask = FM_LITERAL_U64(1) << repairType;
 
             FM_CLEAR(auxData);
+            resumable = TRUE;
 
             TAKE_PARITY_LOCK(sw);
 
             found = (parityInfo->pendingRepairs & bitMask) != 0;
 
+            /* Always make some progress, then stop once the budget
+             * is spent and leave the remaining repairs pending. */
+            if (found && performed && SweepBudgetSpent(parityInfo))
+            {
+                DROP_PARITY_LOCK(sw);
+                yielded = TRUE;
+                break;
+            }
+
             if (found)
             {
                 isUerr = (parityInfo->pendingUerrs & bitMask) != 0;
@@ -1972,26 +2149,37 @@ static fm_status SweepPendingRepairs(fm_int      sw,
                     case FM_REPAIR_FFU_SLICE_SRAM:
                         auxData = parityInfo->ffuRamRepair;
                         parityInfo->ffuRamRepair = ZERO_REPAIR_DATA;
+                        resumable = FALSE;
                         break;
 
                     case FM_REPAIR_FFU_SLICE_TCAM:
                         auxData = parityInfo->ffuTcamRepair;
                         parityInfo->ffuTcamRepair = ZERO_REPAIR_DATA;
+                        resumable = FALSE;
                         break;
 
                     case FM_REPAIR_RX_STATS_BANK:
                         auxData = parityInfo->rxStatsRepair;
                         parityInfo->rxStatsRepair = ZERO_REPAIR_DATA;
+                        resumable = FALSE;
                         break;
 
                     case FM_REPAIR_TUNNEL_ENGINE_0:
                         auxData = parityInfo->teErrRepair[0];
                         parityInfo->teErrRepair[0] = ZERO_REPAIR_DATA;
+                        resumable = FALSE;
                         break;
 
                     case FM_REPAIR_TUNNEL_ENGINE_1:
                         auxData = parityInfo->teErrRepair[1];
                         parityInfo->teErrRepair[1] = ZERO_REPAIR_DATA;
+                        resumable = FALSE;
+                        break;
+
+                    case FM_REPAIR_GLORT_CAM:
+                        /* The CRM is notified once the whole table
+                         * has been restored. */
+                        resumable = FALSE;
                         break;
 
                     default:
@@ -1999,23 +2187,74 @@ static fm_status SweepPendingRepairs(fm_int      sw,
 
                 }   /* end switch (repairType) */
 
+                parityInfo->activeRepair =
+                    (resumable) ? repairType : FM_REPAIR_TYPE_NONE;
+                parityInfo->activeIndex =
+                    (resumable) ? parityInfo->resumeIndex[repairType] : 0;
+                parityInfo->activeSuspended = FALSE;
+
             }   /* end if (found) */
 
             DROP_PARITY_LOCK(sw);
 
-            if (found)
+            if (!found)
             {
-                PerformRepair(sw,
-                              switchProtected,
-                              eventHandler,
-                              repairType,
-                              isUerr,
-                              &auxData);
+                continue;
+            }
+
+            PerformRepair(sw,
+                          switchProtected,
+                          eventHandler,
+                          repairType,
+                          isUerr,
+                          &auxData);
+
+            performed = TRUE;
+
+            TAKE_PARITY_LOCK(sw);
+
+            if (parityInfo->activeSuspended)
+            {
+                /* If another error was reported against this table
+                 * while it was being repaired, start over from the
+                 * beginning on the next pass. */
+                parityInfo->resumeIndex[repairType] =
+                    (parityInfo->pendingRepairs & bitMask) ?
+                    0 : parityInfo->activeIndex;
+
+                parityInfo->pendingRepairs |= bitMask;
+
+                if (isUerr)
+                {
+                    parityInfo->pendingUerrs |= bitMask;
+                }
+
+                yielded = TRUE;
+            }
+            else
+            {
+                parityInfo->resumeIndex[repairType] = 0;
+            }
+
+            parityInfo->activeRepair    = FM_REPAIR_TYPE_NONE;
+            parityInfo->activeSuspended = FALSE;
+
+            DROP_PARITY_LOCK(sw);
+
+            if (yielded)
+            {
+                break;
             }
 
         }   /* end for (index = 0 ; index < FM_REPAIR_TYPE_MAX ; index++) */
     }
 
+    if (yielded)
+    {
+        /* Run another pass to finish the remaining repairs. */
+        fmSignalSemaphore(&fmRootApi->parityRepairSemaphore);
+    }
+
     FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_PARITY, FM_OK);
 
 }   /* end SweepPendingRepairs */
@@ -2256,6 +2495,7 @@ void * fm10000ParityRepairTask(fm_int    sw,
 {
     fm_thread * thread;
     fm_thread * eventHandler;
+    fm10000_parityInfo * parityInfo;
 
     thread       = FM_GET_THREAD_HANDLE(args);
     eventHandler = FM_GET_THREAD_PARAM(fm_thread, args);
@@ -2266,6 +2506,15 @@ void * fm10000ParityRepairTask(fm_int    sw,
 
     fmDbgDiagCountIncr(sw, FM_CTR_PARITY_REPAIR_DISPATCH, 1);
 
+    parityInfo = GET_PARITY_INFO(sw);
+
+    /* Close an expired coalescing window first, so that deferred TCAM
+     * repairs are performed on this pass. */
+    if (parityInfo->coalesceExpired)
+    {
+        fm10000CloseParityCoalesceWindow(sw);
+    }
+
     SweepPendingRepairs(sw, switchProtected, eventHandler);
 
     FM_LOG_EXIT_CUSTOM_VERBOSE(FM_LOG_CAT_PARITY, NULL, "\n");
@@ -176,6 +176,159 @@ fm_status fm10000SendPacketDirected(fm_int           sw,
 
 
 
+/*****************************************************************************/
+/** fm10000CreateTxDestination
+ * \ingroup intPkt
+ *
+ * \desc            Allocates a TX destination handle for a list of ports.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       portList points to an array of logical port numbers.
+ *
+ * \param[in]       numPorts is the number of elements in portList.
+ *
+ * \param[out]      destHandle points to caller-allocated storage where
+ *                  this function should place the handle.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_PORT if portList contains an invalid port.
+ * \return          FM_ERR_NO_FREE_RESOURCES if all handles are in use.
+ *
+ *****************************************************************************/
+fm_status fm10000CreateTxDestination(fm_int  sw,
+                                     fm_int *portList,
+                                     fm_int  numPorts,
+                                     fm_int *destHandle)
+{
+    fm_status   err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
+                 "sw=%d portList=%p numPorts=%d\n",
+                 sw,
+                 (void *) portList,
+                 numPorts);
+
+    err = FM_FM10000_CREATE_TX_DESTINATION(sw, portList, numPorts, destHandle);
+
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+}   /* end fm10000CreateTxDestination */
+
+
+
+/*****************************************************************************/
+/** fm10000DeleteTxDestination
+ * \ingroup intPkt
+ *
+ * \desc            Releases a TX destination handle.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       destHandle is the handle to release.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if destHandle is out of range.
+ * \return          FM_ERR_NOT_FOUND if destHandle is not allocated.
+ *
+ *****************************************************************************/
+fm_status fm10000DeleteTxDestination(fm_int sw, fm_int destHandle)
+{
+    fm_status   err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
+                 "sw=%d destHandle=%d\n",
+                 sw,
+                 destHandle);
+
+    err = FM_FM10000_DELETE_TX_DESTINATION(sw, destHandle);
+
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+}   /* end fm10000DeleteTxDestination */
+
+
+
+/*****************************************************************************/
+/** fm10000SendPacketTxDestination
+ * \ingroup intPkt
+ *
+ * \desc            Sends a packet to the ports of a TX destination handle.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       destHandle is the TX destination handle.
+ *
+ * \param[in]       pkt points to the packet buffer's first ''fm_buffer''
+ *                  structure in a chain of one or more buffers.
+ *
+ * \param[in]       info is a pointer to the packet information structure.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_PORT_STATE if none of the destination
+ *                  ports is in the proper port state.
+ * \return          FM_ERR_NOT_FOUND if destHandle is not allocated.
+ * \return          FM_ERR_TX_PACKET_QUEUE_FULL if the transmit packet queue
+ *                  is full.
+ *
+ *****************************************************************************/
+fm_status fm10000SendPacketTxDestination(fm_int           sw,
+                                         fm_int           destHandle,
+                                         fm_buffer *      pkt,
+                                         fm_packetInfoV2 *info)
+{
+    fm_status   err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
+                 "sw=%d destHandle=%d pkt=%p\n",
+                 sw,
+                 destHandle,
+                 (void *) pkt);
+
+    err = FM_FM10000_SEND_PACKET_TX_DESTINATION(sw, destHandle, pkt, info);
+
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+}   /* end fm10000SendPacketTxDestination */
+
+
+
+/*****************************************************************************/
+/** fm10000GetTxQueueSpace
+ * \ingroup intPkt
+ *
+ * \desc            Returns the number of free entries in the TX packet
+ *                  queue serving a switch priority.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       switchPriority is the switch priority.
+ *
+ * \param[out]      space points to caller-allocated storage where this
+ *                  function should place the number of free entries.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000GetTxQueueSpace(fm_int    sw,
+                                 fm_uint32 switchPriority,
+                                 fm_int *  space)
+{
+    fm_status   err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
+                 "sw=%d switchPriority=%u\n",
+                 sw,
+                 switchPriority);
+
+    err = FM_FM10000_GET_TX_QUEUE_SPACE(sw, switchPriority, space);
+
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+}   /* end fm10000GetTxQueueSpace */
+
+
+
 /*****************************************************************************/
 /** fm10000SendPacketSwitched
  * \ingroup intPkt
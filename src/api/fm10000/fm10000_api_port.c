@@ -1475,6 +1475,63 @@ static fm10000_portAttrEntryTable portAttributeTable =
         .excludedPhyPortTypes = ( EXCLUDE_PCIE | EXCLUDE_TE | EXCLUDE_LPBK ),
     },
 
+    .linkDampingHalfLife =
+    {
+        .attr                 = FM_PORT_LINK_DAMPING_HALF_LIFE,
+        .str                  = "FM_PORT_LINK_DAMPING_HALF_LIFE",
+        .type                 = FM_TYPE_UINT32,
+        .perLag               = FALSE,
+        .attrType             = FM_PORT_ATTR_EXTENSION,
+        .offset               = offsetof(fm10000_portAttr, linkDampingHalfLife),
+        .excludedPhyPortTypes = ( EXCLUDE_PCIE | EXCLUDE_TE | EXCLUDE_LPBK ),
+    },
+
+    .linkDampingPenalty =
+    {
+        .attr                 = FM_PORT_LINK_DAMPING_PENALTY,
+        .str                  = "FM_PORT_LINK_DAMPING_PENALTY",
+        .type                 = FM_TYPE_UINT32,
+        .perLag               = FALSE,
+        .attrType             = FM_PORT_ATTR_EXTENSION,
+        .offset               = offsetof(fm10000_portAttr, linkDampingPenalty),
+        .excludedPhyPortTypes = ( EXCLUDE_PCIE | EXCLUDE_TE | EXCLUDE_LPBK ),
+    },
+
+    .linkDampingSuppress =
+    {
+        .attr                 = FM_PORT_LINK_DAMPING_SUPPRESS,
+        .str                  = "FM_PORT_LINK_DAMPING_SUPPRESS",
+        .type                 = FM_TYPE_UINT32,
+        .perLag               = FALSE,
+        .attrType             = FM_PORT_ATTR_EXTENSION,
+        .offset               = offsetof(fm10000_portAttr, linkDampingSuppress),
+        .excludedPhyPortTypes = ( EXCLUDE_PCIE | EXCLUDE_TE | EXCLUDE_LPBK ),
+    },
+
+    .linkDampingReuse =
+    {
+        .attr                 = FM_PORT_LINK_DAMPING_REUSE,
+        .str                  = "FM_PORT_LINK_DAMPING_REUSE",
+        .type                 = FM_TYPE_UINT32,
+        .perLag               = FALSE,
+        .attrType             = FM_PORT_ATTR_EXTENSION,
+        .offset               = offsetof(fm10000_portAttr, linkDampingReuse),
+        .excludedPhyPortTypes = ( EXCLUDE_PCIE | EXCLUDE_TE | EXCLUDE_LPBK ),
+    },
+
+    /* The table entry tracks the suppressed flag; the full status is
+     * read from the port extension by fm10000GetLinkDampingStatus. */
+    .linkDampingStatus =
+    {
+        .attr                 = FM_PORT_LINK_DAMPING_STATUS,
+        .str                  = "FM_PORT_LINK_DAMPING_STATUS",
+        .type                 = FM_TYPE_BOOL,
+        .perLag               = FALSE,
+        .attrType             = FM_PORT_ATTR_EXTENSION,
+        .offset               = offsetof(fm10000_portAttr, linkDampingSuppressed),
+        .excludedPhyPortTypes = ( EXCLUDE_ETH_WR | EXCLUDE_PCIE | EXCLUDE_TE | EXCLUDE_LPBK ),
+    },
+
 
 };  /* end portAttributeTable */
 
@@ -2170,6 +2227,131 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** IsPublishedPortAttribute
+ * \ingroup intPort
+ *
+ * \desc            Indicates whether an attribute may be served from the
+ *                  published attribute copy. Only scalar attributes whose
+ *                  getter is a plain cache read, and whose cache is only
+ *                  written with the port attribute lock held, qualify.
+ *
+ * \param[in]       attr is the port attribute.
+ *
+ * \return          TRUE if the attribute is served lock-free.
+ *
+ *****************************************************************************/
+static fm_bool IsPublishedPortAttribute(fm_int attr)
+{
+
+    switch (attr)
+    {
+        case FM_PORT_MIN_FRAME_SIZE:
+        case FM_PORT_MAX_FRAME_SIZE:
+        case FM_PORT_DEF_PRI:
+        case FM_PORT_ETHERNET_INTERFACE_MODE:
+            return TRUE;
+
+        default:
+            return FALSE;
+    }
+
+}   /* end IsPublishedPortAttribute */
+
+
+
+
+/*****************************************************************************/
+/** GetPublishedPortAttribute
+ * \ingroup intPort
+ *
+ * \desc            Read a scalar attribute from the copy published by
+ *                  ''fm10000PublishPortAttributes'' without taking any lock.
+ *                  The read is retried if a publication overlapped it; a
+ *                  publication is a memory copy, so a reader never waits
+ *                  behind hardware programming.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the port on which to operate.
+ *
+ * \param[in]       attrEntry points to the attribute table entry.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function should place the attribute value.
+ *
+ * \return          TRUE if the value was read, FALSE if the attribute has
+ *                  no published copy and must be read through the
+ *                  regular path.
+ *
+ *****************************************************************************/
+static fm_bool GetPublishedPortAttribute(fm_int            sw,
+                                         fm_int            port,
+                                         fm_portAttrEntry *attrEntry,
+                                         void *            value)
+{
+    fm10000_port *portExt;
+    fm_uint32     seq;
+    void *        ptr;
+
+    portExt = GET_PORT_EXT(sw, port);
+
+    if ( !FM_ATOMIC_LOAD(&portExt->attrPublished) )
+    {
+        return FALSE;
+    }
+
+    if (attrEntry->attrType == FM_PORT_ATTR_GENERIC)
+    {
+        ptr = GET_PORT_ATTR_ADDRESS(&portExt->pubAttr, attrEntry);
+    }
+    else if (attrEntry->attrType == FM_PORT_ATTR_EXTENSION)
+    {
+        ptr = GET_PORT_ATTR_ADDRESS(&portExt->pubAttrExt, attrEntry);
+    }
+    else
+    {
+        return FALSE;
+    }
+
+    do
+    {
+        seq = FM_ATOMIC_LOAD(&portExt->attrSeq);
+
+        if (seq & 1)
+        {
+            continue;
+        }
+
+        switch (attrEntry->type)
+        {
+            case FM_TYPE_INT:
+                *( (fm_int *) value ) = *( (volatile fm_int *) ptr );
+                break;
+
+            case FM_TYPE_UINT32:
+                *( (fm_uint32 *) value ) = *( (volatile fm_uint32 *) ptr );
+                break;
+
+            case FM_TYPE_BOOL:
+                *( (fm_bool *) value ) = *( (volatile fm_bool *) ptr );
+                break;
+
+            default:
+                return FALSE;
+        }
+
+        FM_ATOMIC_FENCE();
+    }
+    while ( (seq & 1) || (FM_ATOMIC_LOAD_RELAXED(&portExt->attrSeq) != seq) );
+
+    return TRUE;
+
+}   /* end GetPublishedPortAttribute */
+
+
+
+
 /*****************************************************************************/
 /** SetLAGPortAttribute
  * \ingroup intPort
@@ -2225,6 +2407,8 @@ static fm_status SetLAGPortAttribute(fm_int sw,
     fm_bool           isPciePort;
     fm_bitArray       tmpMaskBitArray;
     fm10000_switch   *switchExt;
+    fm_bool           wmBatch;
+    fm_status         err;
 
     FM_LOG_ENTRY_V2(FM_LOG_CAT_PORT,
                  port,
@@ -2238,6 +2422,7 @@ static fm_status SetLAGPortAttribute(fm_int sw,
     switchExt = GET_SWITCH_EXT(sw);
     portPtr   = GET_PORT_PTR(sw, port);
     portAttr  = GET_PORT_ATTR(sw, port);
+    wmBatch   = FALSE;
 
     if (portPtr->portType != FM_PORT_TYPE_LAG)
     {
@@ -2326,6 +2511,14 @@ static fm_status SetLAGPortAttribute(fm_int sw,
         FM_LOG_ABORT_ON_ERR_V2(FM_LOG_CAT_PORT, port, status);
     }
 
+    /* Recompute the watermarks once for all members */
+    if (attribute == FM_PORT_SMP_LOSSLESS_PAUSE)
+    {
+        status = fm10000BeginWatermarkUpdate(sw);
+        FM_LOG_ABORT_ON_ERR_V2(FM_LOG_CAT_PORT, port, status);
+        wmBatch = TRUE;
+    }
+
     /* Apply attribute to each member ports */
     for (i = 0 ; i < numMembers ; i++)
     {
@@ -2356,6 +2549,16 @@ static fm_status SetLAGPortAttribute(fm_int sw,
     }
 
 ABORT:
+    if (wmBatch)
+    {
+        err = fm10000EndWatermarkUpdate(sw);
+
+        if (status == FM_OK)
+        {
+            status = err;
+        }
+    }
+
     FM_LOG_EXIT_V2(FM_LOG_CAT_PORT, port, status);
 
 }   /* end SetLAGPortAttribute */
@@ -5862,6 +6065,53 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000PublishPortAttributes
+ * \ingroup intPort
+ *
+ * \desc            Publish the port's cached attribute blocks for readers
+ *                  that do not take the port attribute lock. Must be called
+ *                  after the cache is modified, before the lock is
+ *                  released.
+ *
+ * \note            The caller is assumed to have claimed the port attribute
+ *                  lock (PORT_ATTR_LOCK), which serializes publishers.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the cardinal port on which to operate.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000PublishPortAttributes(fm_int sw, fm_int port)
+{
+    fm10000_port *portExt;
+
+    portExt = GET_PORT_EXT(sw, port);
+
+    (void) FM_ATOMIC_ADD(&portExt->attrSeq, 1);
+    FM_ATOMIC_FENCE();
+
+    FM_MEMCPY_S(&portExt->pubAttr,
+                sizeof(portExt->pubAttr),
+                GET_PORT_ATTR(sw, port),
+                sizeof(portExt->pubAttr));
+
+    FM_MEMCPY_S(&portExt->pubAttrExt,
+                sizeof(portExt->pubAttrExt),
+                &portExt->attributes,
+                sizeof(portExt->pubAttrExt));
+
+    FM_ATOMIC_STORE(&portExt->attrPublished, TRUE);
+
+    (void) FM_ATOMIC_ADD(&portExt->attrSeq, 1);
+
+}   /* end fm10000PublishPortAttributes */
+
+
+
+
 /*****************************************************************************/
 /** fm10000ApplyLagMemberPortAttr
  * \ingroup intPort
@@ -6010,6 +6260,8 @@ ABORT:
         fmDeleteBitArray(&bitArray);
     }
 
+    fm10000PublishPortAttributes(sw, port);
+
     FM_DROP_PORT_ATTR_LOCK(sw);
 
     FM_LOG_EXIT_V2(FM_LOG_CAT_PORT, port, err);
@@ -6162,6 +6414,8 @@ ABORT:
         fmDeleteBitArray(&bitArray);
     }
 
+    fm10000PublishPortAttributes(sw, port);
+
     FM_DROP_PORT_ATTR_LOCK(sw);
 
     FM_LOG_EXIT_V2(FM_LOG_CAT_PORT, port, err);
@@ -6201,6 +6455,135 @@ fm_bool fm10000IsPerLagPortAttribute(fm_int sw, fm_uint attr)
 
 
 
+/*****************************************************************************/
+/** fm10000BeginPortAttributeUpdate
+ * \ingroup intPort
+ *
+ * \desc            Start a bulk port attribute update. Watermark
+ *                  recomputation triggered by the attributes set until
+ *                  ''fm10000EndPortAttributeUpdate'' is deferred and done
+ *                  once at the end.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000BeginPortAttributeUpdate(fm_int sw)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PORT, "sw=%d\n", sw);
+
+    err = fm10000BeginWatermarkUpdate(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
+
+}   /* end fm10000BeginPortAttributeUpdate */
+
+
+
+
+/*****************************************************************************/
+/** fm10000EndPortAttributeUpdate
+ * \ingroup intPort
+ *
+ * \desc            End a bulk port attribute update started with
+ *                  ''fm10000BeginPortAttributeUpdate'' and apply the deferred
+ *                  derived state.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000EndPortAttributeUpdate(fm_int sw)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PORT, "sw=%d\n", sw);
+
+    err = fm10000EndWatermarkUpdate(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
+
+}   /* end fm10000EndPortAttributeUpdate */
+
+
+
+
+/*****************************************************************************/
+/** fm10000GetPortAttributeSnapshot
+ * \ingroup intPort
+ *
+ * \desc            Read a port attribute from the copy published by
+ *                  ''fm10000PublishPortAttributes'', without taking any
+ *                  lock. Called through the GetPortAttributeSnapshot
+ *                  function pointer.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the port on which to operate.
+ *
+ * \param[in]       attr is the port attribute to read.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function should place the attribute value.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the attribute is not published,
+ *                  or port is not a cardinal port.
+ * \return          FM_ERR_NOT_FOUND if the port's attributes have not been
+ *                  published yet.
+ *
+ *****************************************************************************/
+fm_status fm10000GetPortAttributeSnapshot(fm_int sw,
+                                          fm_int port,
+                                          fm_int attr,
+                                          void * value)
+{
+    fm_port *         portPtr;
+    fm10000_port *    portExt;
+    fm_portAttrEntry *attrEntry;
+    fm_status         err;
+
+    FM_LOG_ENTRY_V2(FM_LOG_CAT_PORT,
+                    port,
+                    "sw=%d port=%d attr=%d value=%p\n",
+                    sw,
+                    port,
+                    attr,
+                    value);
+
+    attrEntry = NULL;
+
+    if ( IsPublishedPortAttribute(attr) && fmIsCardinalPort(sw, port) )
+    {
+        portPtr   = GET_PORT_PTR(sw, port);
+        portExt   = GET_PORT_EXT(sw, port);
+        attrEntry = GetPortAttrEntry(attr);
+    }
+
+    if ( (attrEntry == NULL) || !IS_ATTRIBUTE_READABLE(attrEntry) )
+    {
+        err = FM_ERR_UNSUPPORTED;
+    }
+    else if ( !GetPublishedPortAttribute(sw, port, attrEntry, value) )
+    {
+        err = FM_ERR_NOT_FOUND;
+    }
+    else
+    {
+        err = FM_OK;
+    }
+
+    FM_LOG_EXIT_V2(FM_LOG_CAT_PORT, port, err);
+
+}   /* end fm10000GetPortAttributeSnapshot */
+
+
+
+
 /*****************************************************************************/
 /** fm10000DbgDumpPortAttributes
  * \ingroup intPort
@@ -10700,6 +11083,86 @@ fm_status fm10000SetPortAttributeInt(fm_int sw,
             }
         }
     }
+    else if (attr == FM_PORT_LINK_DAMPING_HALF_LIFE)
+    {
+        VALIDATE_ATTRIBUTE_WRITE_ACCESS(&portAttributeTable.linkDampingHalfLife);
+        VALIDATE_PORT_ATTRIBUTE(&portAttributeTable.linkDampingHalfLife);
+
+        if (isLagAttr)
+        {
+            err = SetLAGPortAttribute(sw, port, lane, attr, value);
+            FM_LOG_ABORT_ON_ERR_V2(FM_LOG_CAT_PORT, port, err);
+        }
+        else
+        {
+            portAttrExt->linkDampingHalfLife = *( (fm_uint32 *) value );
+
+            err = fm10000ResetLinkDamping(sw, port);
+            FM_LOG_ABORT_ON_ERR_V2(FM_LOG_CAT_PORT, port, err);
+        }
+    }
+    else if (attr == FM_PORT_LINK_DAMPING_PENALTY)
+    {
+        VALIDATE_ATTRIBUTE_WRITE_ACCESS(&portAttributeTable.linkDampingPenalty);
+        VALIDATE_PORT_ATTRIBUTE(&portAttributeTable.linkDampingPenalty);
+
+        if (isLagAttr)
+        {
+            err = SetLAGPortAttribute(sw, port, lane, attr, value);
+            FM_LOG_ABORT_ON_ERR_V2(FM_LOG_CAT_PORT, port, err);
+        }
+        else
+        {
+            portAttrExt->linkDampingPenalty = *( (fm_uint32 *) value );
+        }
+    }
+    else if (attr == FM_PORT_LINK_DAMPING_SUPPRESS)
+    {
+        VALIDATE_ATTRIBUTE_WRITE_ACCESS(&portAttributeTable.linkDampingSuppress);
+        VALIDATE_PORT_ATTRIBUTE(&portAttributeTable.linkDampingSuppress);
+
+        tmpUint32 = *( (fm_uint32 *) value );
+
+        if ( !isLagAttr && (tmpUint32 <= portAttrExt->linkDampingReuse) )
+        {
+            err = FM_ERR_INVALID_VALUE;
+            FM_LOG_ABORT_ON_ERR_V2(FM_LOG_CAT_PORT, port, err);
+        }
+
+        if (isLagAttr)
+        {
+            err = SetLAGPortAttribute(sw, port, lane, attr, &tmpUint32);
+            FM_LOG_ABORT_ON_ERR_V2(FM_LOG_CAT_PORT, port, err);
+        }
+        else
+        {
+            portAttrExt->linkDampingSuppress = tmpUint32;
+        }
+    }
+    else if (attr == FM_PORT_LINK_DAMPING_REUSE)
+    {
+        VALIDATE_ATTRIBUTE_WRITE_ACCESS(&portAttributeTable.linkDampingReuse);
+        VALIDATE_PORT_ATTRIBUTE(&portAttributeTable.linkDampingReuse);
+
+        tmpUint32 = *( (fm_uint32 *) value );
+
+        if ( (tmpUint32 == 0) ||
+             ( !isLagAttr && (tmpUint32 >= portAttrExt->linkDampingSuppress) ) )
+        {
+            err = FM_ERR_INVALID_VALUE;
+            FM_LOG_ABORT_ON_ERR_V2(FM_LOG_CAT_PORT, port, err);
+        }
+
+        if (isLagAttr)
+        {
+            err = SetLAGPortAttribute(sw, port, lane, attr, &tmpUint32);
+            FM_LOG_ABORT_ON_ERR_V2(FM_LOG_CAT_PORT, port, err);
+        }
+        else
+        {
+            portAttrExt->linkDampingReuse = tmpUint32;
+        }
+    }
     else 
     {
        err = fmIsValidPortAttribute(attr) ? FM_ERR_UNSUPPORTED :
@@ -10724,6 +11187,11 @@ ABORT:
 
     if (portAttrLockTaken)
     {
+        if (fmIsCardinalPort(sw, port))
+        {
+            fm10000PublishPortAttributes(sw, port);
+        }
+
         FM_DROP_PORT_ATTR_LOCK(sw);
     }
 
@@ -10833,6 +11301,22 @@ fm_status fm10000GetPortAttribute(fm_int sw,
     portAttrExt = GET_FM10000_PORT_ATTR(sw, port);
     err         = FM_OK;
 
+    /* Frequently polled attributes are read from the published copy so
+     * they never wait for a writer holding the port attribute lock. */
+    if ( (lane == FM_PORT_LANE_NA) &&
+         IsPublishedPortAttribute(attribute) &&
+         fmIsCardinalPort(sw, port) )
+    {
+        attrEntry = GetPortAttrEntry(attribute);
+
+        if ( (attrEntry != NULL) &&
+             IS_ATTRIBUTE_READABLE(attrEntry) &&
+             GetPublishedPortAttribute(sw, port, attrEntry, value) )
+        {
+            FM_LOG_EXIT_V2(FM_LOG_CAT_PORT, port, FM_OK);
+        }
+    }
+
     if (fmIsCardinalPort(sw, port))
     {
         /**************************************************
@@ -11796,6 +12280,33 @@ fm_status fm10000GetPortAttribute(fm_int sw,
             *( (fm_bool *) value ) = portAttr->autoDetectModule;
             break;
 
+        case FM_PORT_LINK_DAMPING_HALF_LIFE:
+            VALIDATE_ATTRIBUTE_READ_ACCESS(&portAttributeTable.linkDampingHalfLife);
+            *( (fm_uint32 *) value ) = portAttrExt->linkDampingHalfLife;
+            break;
+
+        case FM_PORT_LINK_DAMPING_PENALTY:
+            VALIDATE_ATTRIBUTE_READ_ACCESS(&portAttributeTable.linkDampingPenalty);
+            *( (fm_uint32 *) value ) = portAttrExt->linkDampingPenalty;
+            break;
+
+        case FM_PORT_LINK_DAMPING_SUPPRESS:
+            VALIDATE_ATTRIBUTE_READ_ACCESS(&portAttributeTable.linkDampingSuppress);
+            *( (fm_uint32 *) value ) = portAttrExt->linkDampingSuppress;
+            break;
+
+        case FM_PORT_LINK_DAMPING_REUSE:
+            VALIDATE_ATTRIBUTE_READ_ACCESS(&portAttributeTable.linkDampingReuse);
+            *( (fm_uint32 *) value ) = portAttrExt->linkDampingReuse;
+            break;
+
+        case FM_PORT_LINK_DAMPING_STATUS:
+            VALIDATE_ATTRIBUTE_READ_ACCESS(&portAttributeTable.linkDampingStatus);
+            err = fm10000GetLinkDampingStatus(sw,
+                                              port,
+                                              (fm_linkDampingStatus *) value);
+            break;
+
         default:
             err = fmIsValidPortAttribute(attribute) ? FM_ERR_UNSUPPORTED :
                                                       FM_ERR_INVALID_ATTRIB;
@@ -12203,6 +12714,7 @@ fm_status fm10000SetPortState( fm_int sw,
 
                 portPtr->mode    = mode;
                 portPtr->submode = submode;
+                fmUpdateCardinalPortState(GET_SWITCH_PTR(sw), port);
             }
             else
             {
@@ -12270,6 +12782,7 @@ fm_status fm10000SetPortState( fm_int sw,
 
                 portPtr->mode = mode;
                 portPtr->submode = submode;
+                fmUpdateCardinalPortState(GET_SWITCH_PTR(sw), port);
             }
 
         }
@@ -12295,6 +12808,8 @@ fm_status fm10000SetPortState( fm_int sw,
                 sendUpdate = TRUE;
             }
 
+            fmUpdateCardinalPortState(GET_SWITCH_PTR(sw), port);
+
             if ( sendUpdate == TRUE )
             {
                 err = fm10000SendLinkUpDownEvent( sw, 
@@ -13194,9 +13709,9 @@ fm_status fm10000UpdatePortMask(fm_int sw, fm_int port)
     fm_uint32     maskbit;
     fm_status     err;
     fm_int        cpi;
-    fm_int        mp;
     fm_uint64     regVal64;
-    fm10000_port *txPortExt;
+    fm_byte *     portFlags;
+    fm_byte       flags;
 
     FM_LOG_ENTRY_V2(FM_LOG_CAT_PORT, port, "sw=%d port=%d\n", sw, port);
 
@@ -13226,19 +13741,21 @@ fm_status fm10000UpdatePortMask(fm_int sw, fm_int port)
      **************************************************/
     if (portPtr->linkUp)
     {
-        /* remove the ports that are administratively down */
+        /* remove the ports that are administratively down, using the
+         * per-cardinal-port flags rather than each port's structures */
+        portFlags = switchPtr->cardinalPortInfo.portFlags;
+
         for (cpi = 1 ; cpi < switchPtr->numCardinalPorts ; cpi++)
         {
             if ( FM_PORTMASK_IS_BIT_SET(&mask, cpi) )
             {
-                mp          = GET_LOGICAL_PORT(sw, cpi);
-                txPortExt   = GET_PORT_EXT(sw, mp);
+                flags   = portFlags[cpi];
                 maskbit = 1;
-                if (switchPtr->portTable[mp]->mode == FM_PORT_STATE_ADMIN_DOWN || 
-                    txPortExt->isDraining)
+                if ( flags & (FM_CARDINAL_PORT_ADMIN_DOWN |
+                              FM_CARDINAL_PORT_DRAINING) )
                 {
-                    if (switchPtr->portTable[mp]->isPortForceUp || 
-                        txPortExt->isDraining)
+                    if ( flags & (FM_CARDINAL_PORT_FORCE_UP |
+                                  FM_CARDINAL_PORT_DRAINING) )
                     {
                         maskbit = 0;
                     }
@@ -13665,8 +14182,13 @@ fm_status fm10000DrainPhysPort( fm_int  sw,
     }
 
     portExt->isDraining = drain;
+    fmSetCardinalPortFlag(switchPtr,
+                          logPort,
+                          FM_CARDINAL_PORT_DRAINING,
+                          drain);
 
-    err = fmUpdateSwitchPortMasks(sw);
+    /* Only the masks that include the drained port are affected */
+    err = fmUpdateSwitchPortMasksForPort(sw, logPort);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
 
     /* For Ethernet port Drain mode is configured in MAC. */
@@ -96,6 +96,13 @@
 #define FM10000_PORT_EEE_TX_LPI_HOLD_TIMEOUT        20
 #define FM10000_PORT_EEE_TX_LPI_HOLD_TIMESCALE       1 /* 1us scale */
 
+/* The link-flap damping penalty is capped at this multiple of the suppress
+ * threshold, bounding how long a port can stay suppressed after a burst */
+#define FM10000_LINK_DAMPING_MAX_PENALTY_MULT       4
+
+/* Delay before a suppressed port is re-evaluated after reconfiguration */
+#define FM10000_LINK_DAMPING_REEVAL_MSEC             1
+
 
 /*****************************************************************************
  * Local function prototypes
@@ -141,6 +148,9 @@ static fm_status SetPepLoopback( fm_smEventInfo *eventInfo,
 static fm_status ConfigureEeeLane( fm_smEventInfo *eventInfo,
                                    void           *userInfo );
 
+static fm_status StartLinkDampingTimer( fm10000_port *portExt,
+                                        fm_uint64     msec );
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -840,6 +850,407 @@ static void HandlePortStatusPollingTimerEvent( void *arg )
 
 
 
+/*****************************************************************************/
+/** GetDecayedLinkDampingPenalty
+ * \ingroup intPort
+ *
+ * \desc            Computes the link-flap damping penalty of a port decayed
+ *                  to the given time. Whole half-lives halve the penalty;
+ *                  the remaining fraction f is applied using the quadratic
+ *                  approximation 2^-f ~= 1 - f * (0.693 - 0.195 * f), so
+ *                  that repeated partial decays compose accurately.
+ *
+ * \param[in]       portExt points to the port extension structure.
+ *
+ * \param[in]       halfLife is the damping half-life in milliseconds.
+ *
+ * \param[in]       now is the current monotonic time in nanoseconds.
+ *
+ * \return          The decayed penalty.
+ *
+ *****************************************************************************/
+static fm_uint32 GetDecayedLinkDampingPenalty( fm10000_port *portExt,
+                                               fm_uint32     halfLife,
+                                               fm_uint64     now )
+{
+    fm_uint64 penalty;
+    fm_uint64 elapsed;
+    fm_uint64 halfLifeNsec;
+    fm_uint64 halfLives;
+    fm_uint64 frac;
+
+    penalty = portExt->linkDamping.penalty;
+
+    if ( (halfLife == 0) || (penalty == 0) )
+    {
+        return (fm_uint32) penalty;
+    }
+
+    elapsed      = now - portExt->linkDampingNsec;
+    halfLifeNsec = (fm_uint64) halfLife * 1000000;
+    halfLives    = elapsed / halfLifeNsec;
+
+    if (halfLives >= 32)
+    {
+        return 0;
+    }
+
+    penalty >>= halfLives;
+
+    /* Remaining fraction of a half-life, in 1/1024 units */
+    frac     = ( (elapsed % halfLifeNsec) * 1024 ) / halfLifeNsec;
+    penalty -= ( penalty * frac * (710 - ( (200 * frac) >> 10 )) ) >> 20;
+
+    return (fm_uint32) penalty;
+
+}   /* end GetDecayedLinkDampingPenalty */
+
+
+
+
+/*****************************************************************************/
+/** GetLinkDampingReuseDelay
+ * \ingroup intPort
+ *
+ * \desc            Returns the time it takes for a penalty to decay below
+ *                  the reuse threshold, rounded up to whole half-lives.
+ *
+ * \param[in]       penalty is the current penalty.
+ *
+ * \param[in]       reuse is the reuse threshold.
+ *
+ * \param[in]       halfLife is the damping half-life in milliseconds.
+ *
+ * \return          The delay in milliseconds.
+ *
+ *****************************************************************************/
+static fm_uint64 GetLinkDampingReuseDelay( fm_uint32 penalty,
+                                           fm_uint32 reuse,
+                                           fm_uint32 halfLife )
+{
+    fm_uint halfLives;
+
+    halfLives = 1;
+
+    while ( (halfLives < 31) && ( (penalty >> halfLives) >= reuse ) )
+    {
+        halfLives++;
+    }
+
+    return (fm_uint64) halfLives * halfLife;
+
+}   /* end GetLinkDampingReuseDelay */
+
+
+
+
+/*****************************************************************************/
+/** ReleaseLinkDamping
+ * \ingroup intPort
+ *
+ * \desc            Lifts the link-flap suppression of a port once its
+ *                  penalty has decayed below the reuse threshold, or once
+ *                  damping has been disabled, and reports the current link
+ *                  state if it differs from the state held while the port
+ *                  was suppressed. Otherwise the reuse timer is restarted.
+ *
+ * \note            The caller is assumed to hold the state lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       portExt points to the port extension structure.
+ *
+ * \return          FM_OK if successful
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status ReleaseLinkDamping( fm_int sw, fm10000_port *portExt )
+{
+    fm_port              *portPtr;
+    fm10000_portAttr     *portAttrExt;
+    fm_linkDampingStatus *damping;
+    fm_uint64             now;
+
+    portPtr     = portExt->base;
+    portAttrExt = &portExt->attributes;
+    damping     = &portExt->linkDamping;
+
+    if (!damping->suppressed)
+    {
+        return FM_OK;
+    }
+
+    now = fmGetMonotonicNsec();
+    damping->penalty = GetDecayedLinkDampingPenalty(portExt,
+                                                    portAttrExt->linkDampingHalfLife,
+                                                    now);
+    portExt->linkDampingNsec = now;
+
+    if (portAttrExt->linkDampingHalfLife == 0)
+    {
+        damping->penalty = 0;
+    }
+    else if (damping->penalty >= portAttrExt->linkDampingReuse)
+    {
+        return StartLinkDampingTimer(portExt,
+                                     GetLinkDampingReuseDelay(damping->penalty,
+                                                              portAttrExt->linkDampingReuse,
+                                                              portAttrExt->linkDampingHalfLife));
+    }
+
+    damping->suppressed                = FALSE;
+    portAttrExt->linkDampingSuppressed = FALSE;
+
+    FM_LOG_DEBUG_V2( FM_LOG_CAT_PORT,
+                     portPtr->portNumber,
+                     "Link damping released on port %d (penalty=%u linkUp=%d)\n",
+                     portPtr->portNumber,
+                     damping->penalty,
+                     portPtr->linkUp );
+
+    if (portPtr->linkUp == damping->reportedLinkUp)
+    {
+        return FM_OK;
+    }
+
+    damping->reportedLinkUp = portPtr->linkUp;
+
+    return fm10000SendLinkUpDownEvent( sw,
+                                       portPtr->physicalPort,
+                                       0,
+                                       portPtr->linkUp,
+                                       FM_EVENT_PRIORITY_LOW );
+
+}   /* end ReleaseLinkDamping */
+
+
+
+
+/*****************************************************************************/
+/** HandleLinkDampingTimer
+ * \ingroup intPort
+ *
+ * \desc            Handles the expiration of the timer used to release a
+ *                  port from link-flap suppression.
+ *
+ * \param[in]       arg is the pointer to the argument passed when the timer
+ *                  was started, in this case the pointer to the port
+ *                  extension structure (type ''fm10000_port'')
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+static void HandleLinkDampingTimer( void *arg )
+{
+    fm10000_port *portExt;
+    fm_status     status;
+    fm_int        sw;
+    fm_int        port;
+
+    portExt = arg;
+    sw      = portExt->eventInfo.switchPtr->switchNumber;
+    port    = portExt->base->portNumber;
+
+    PROTECT_SWITCH( sw );
+    FM_TAKE_STATE_LOCK( sw );
+
+    status = ReleaseLinkDamping( sw, portExt );
+    if (status != FM_OK)
+    {
+        FM_LOG_ERROR_V2( FM_LOG_CAT_PORT,
+                         port,
+                         "Unable to release link damping on port %d: %s\n",
+                         port,
+                         fmErrorMsg(status) );
+    }
+
+    FM_DROP_STATE_LOCK( sw );
+    UNPROTECT_SWITCH( sw );
+
+}   /* end HandleLinkDampingTimer */
+
+
+
+
+/*****************************************************************************/
+/** StartLinkDampingTimer
+ * \ingroup intPort
+ *
+ * \desc            Starts the timer releasing a port from link-flap
+ *                  suppression, creating it on first use.
+ *
+ * \param[in]       portExt points to the port extension structure.
+ *
+ * \param[in]       msec is the timeout in milliseconds.
+ *
+ * \return          FM_OK if successful
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status StartLinkDampingTimer( fm10000_port *portExt,
+                                        fm_uint64     msec )
+{
+    fm_timestamp timeout;
+    fm_char      timerName[20];
+    fm_status    status;
+
+    if (portExt->linkDampingTimer == NULL)
+    {
+        FM_SPRINTF_S( timerName,
+                      sizeof(timerName),
+                      "Port%02dDamping",
+                      portExt->base->portNumber );
+
+        status = fmCreateTimer( timerName,
+                                fmApiTimerTask,
+                                &portExt->linkDampingTimer );
+        if (status != FM_OK)
+        {
+            return status;
+        }
+    }
+
+    timeout.sec  = msec / 1000;
+    timeout.usec = (msec % 1000) * 1000;
+
+    return fmStartTimer( portExt->linkDampingTimer,
+                         &timeout,
+                         1,
+                         HandleLinkDampingTimer,
+                         portExt );
+
+}   /* end StartLinkDampingTimer */
+
+
+
+
+/*****************************************************************************/
+/** ReportLinkState
+ * \ingroup intPort
+ *
+ * \desc            Reports a link up/down transition to the application,
+ *                  subject to link-flap damping. Each link down transition
+ *                  adds ''FM_PORT_LINK_DAMPING_PENALTY'' to the decaying
+ *                  penalty of the port. The transition that takes the
+ *                  penalty to the suppress threshold is still reported;
+ *                  later ones are withheld until ''ReleaseLinkDamping''
+ *                  lifts the suppression.
+ *
+ * \note            The caller is assumed to hold the state lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       portExt points to the port extension structure.
+ *
+ * \param[in]       port is the port number passed to
+ *                  ''fm10000SendLinkUpDownEvent''.
+ *
+ * \param[in]       linkUp is TRUE for a link up transition, FALSE for a
+ *                  link down transition.
+ *
+ * \return          FM_OK if successful
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status ReportLinkState( fm_int        sw,
+                                  fm10000_port *portExt,
+                                  fm_int        port,
+                                  fm_bool       linkUp )
+{
+    fm10000_portAttr     *portAttrExt;
+    fm_linkDampingStatus *damping;
+    fm_uint64             now;
+    fm_uint64             penalty;
+    fm_uint64             maxPenalty;
+    fm_status             status;
+
+    portAttrExt = &portExt->attributes;
+    damping     = &portExt->linkDamping;
+
+    if (portAttrExt->linkDampingHalfLife == 0)
+    {
+        if (damping->suppressed)
+        {
+            /* Damping was disabled while the port was suppressed */
+            fmStopTimer(portExt->linkDampingTimer);
+            damping->suppressed                = FALSE;
+            portAttrExt->linkDampingSuppressed = FALSE;
+        }
+
+        damping->penalty = 0;
+    }
+    else
+    {
+        now = fmGetMonotonicNsec();
+        penalty = GetDecayedLinkDampingPenalty(portExt,
+                                               portAttrExt->linkDampingHalfLife,
+                                               now);
+        portExt->linkDampingNsec = now;
+
+        if (!linkUp)
+        {
+            maxPenalty = (fm_uint64) portAttrExt->linkDampingSuppress *
+                         FM10000_LINK_DAMPING_MAX_PENALTY_MULT;
+
+            penalty += portAttrExt->linkDampingPenalty;
+            penalty  = (penalty > maxPenalty) ? maxPenalty : penalty;
+            penalty  = (penalty > 0xFFFFFFFF) ? 0xFFFFFFFF : penalty;
+            damping->flaps++;
+        }
+
+        damping->penalty = (fm_uint32) penalty;
+
+        if (damping->suppressed)
+        {
+            damping->suppressedEvents++;
+
+            FM_LOG_DEBUG_V2( FM_LOG_CAT_PORT,
+                             port,
+                             "Link %s suppressed on port %d (penalty=%u)\n",
+                             linkUp ? "up" : "down",
+                             port,
+                             damping->penalty );
+
+            return FM_OK;
+        }
+
+        if (damping->penalty >= portAttrExt->linkDampingSuppress)
+        {
+            status = StartLinkDampingTimer(portExt,
+                                           GetLinkDampingReuseDelay(damping->penalty,
+                                                                    portAttrExt->linkDampingReuse,
+                                                                    portAttrExt->linkDampingHalfLife));
+            if (status == FM_OK)
+            {
+                damping->suppressed                = TRUE;
+                portAttrExt->linkDampingSuppressed = TRUE;
+                damping->suppressions++;
+            }
+            else
+            {
+                /* Without a reuse timer the port could never be released */
+                FM_LOG_WARNING_V2( FM_LOG_CAT_PORT,
+                                   port,
+                                   "Link damping not applied on port %d: %s\n",
+                                   port,
+                                   fmErrorMsg(status) );
+            }
+        }
+    }
+
+    damping->reportedLinkUp = linkUp;
+
+    return fm10000SendLinkUpDownEvent( sw,
+                                       port,
+                                       0,
+                                       linkUp,
+                                       FM_EVENT_PRIORITY_LOW );
+
+}   /* end ReportLinkState */
+
+
+
+
 /*****************************************************************************/
 /** SendAnEventReq
  * \ingroup intPort
@@ -2328,6 +2739,7 @@ fm_status fm10000NotifyApiPortUp( fm_smEventInfo *eventInfo, void *userInfo )
     fm_int            port;
     fm_int            physPort;
     fm_port          *portPtr;
+    fm10000_port     *portExt;
     fm_portAttr      *portAttr;
     fm10000_portAttr *portAttrExt;
 
@@ -2335,6 +2747,7 @@ fm_status fm10000NotifyApiPortUp( fm_smEventInfo *eventInfo, void *userInfo )
     FM_NOT_USED(eventInfo);
 
     portPtr     = ((fm10000_portSmEventInfo *)userInfo)->portPtr;
+    portExt     = ((fm10000_portSmEventInfo *)userInfo)->portExt;
     portAttr    = ((fm10000_portSmEventInfo *)userInfo)->portAttr;
     portAttrExt = ((fm10000_portSmEventInfo *)userInfo)->portAttrExt;
 
@@ -2364,22 +2777,21 @@ fm_status fm10000NotifyApiPortUp( fm_smEventInfo *eventInfo, void *userInfo )
             if (portPtr->linkUp == TRUE)
             {
                 portPtr->linkUp = FALSE;
+                fmUpdateCardinalPortState(GET_SWITCH_PTR(sw), port);
                 FM_LOG_DEBUG_V2(FM_LOG_CAT_PORT,
                                 port,
                                 "Request PORT DOWN port=%d LinkUp=%d\n",
                                 port,
                                 portPtr->linkUp);
-                status = fm10000SendLinkUpDownEvent(sw,
-                                                    port,
-                                                    0,
-                                                    FALSE,
-                                                    FM_EVENT_PRIORITY_LOW);
+                status = ReportLinkState(sw, portExt, port, FALSE);
             }
         }
         FM_LOG_EXIT(FM_LOG_CAT_PORT, status);
     }
 
     portPtr->linkUp = TRUE;
+    fmUpdateCardinalPortState(GET_SWITCH_PTR(sw), port);
+
     if ( (portPtr->portType == FM_PORT_TYPE_PHYSICAL)
          || ( (portPtr->portType == FM_PORT_TYPE_CPU) && (portPtr->portNumber != 0) ) )
     {
@@ -2396,11 +2808,7 @@ fm_status fm10000NotifyApiPortUp( fm_smEventInfo *eventInfo, void *userInfo )
 
         /* We may need to drop the state lock */
         //  FM_DROP_STATE_LOCK( sw );
-        status = fm10000SendLinkUpDownEvent( sw,
-                                             physPort,
-                                             0,
-                                             TRUE,
-                                             FM_EVENT_PRIORITY_LOW );
+        status = ReportLinkState( sw, portExt, physPort, TRUE );
         // FM_TAKE_STATE_LOCK( sw );
 
     }
@@ -2460,11 +2868,9 @@ fm_status fm10000NotifyApiPortDown( fm_smEventInfo *eventInfo, void *userInfo )
             FM_LOG_ABORT_ON_ERR_V2(FM_LOG_CAT_PORT, port, status);
 
             portPtr->linkUp = FALSE;
-            status = fm10000SendLinkUpDownEvent( sw,
-                                                 physPort,
-                                                 0,
-                                                 FALSE,
-                                                 FM_EVENT_PRIORITY_LOW );
+            fmUpdateCardinalPortState(GET_SWITCH_PTR(sw), port);
+
+            status = ReportLinkState( sw, portExt, physPort, FALSE );
         }
     }
 ABORT:
@@ -2476,6 +2882,102 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000ResetLinkDamping
+ * \ingroup intPort
+ *
+ * \desc            Clears the link-flap damping counters of a port after its
+ *                  damping configuration changed. A suppressed port is
+ *                  re-evaluated shortly under the new configuration, which
+ *                  releases it if damping was disabled.
+ *
+ * \note            The caller is assumed to hold the port attribute lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the port on which to operate.
+ *
+ * \return          FM_OK if successful
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+fm_status fm10000ResetLinkDamping(fm_int sw, fm_int port)
+{
+    fm10000_port         *portExt;
+    fm_linkDampingStatus *damping;
+    fm_status             status;
+
+    portExt = GET_PORT_EXT(sw, port);
+    damping = &portExt->linkDamping;
+    status  = FM_OK;
+
+    FM_TAKE_STATE_LOCK(sw);
+
+    damping->flaps            = 0;
+    damping->suppressions     = 0;
+    damping->suppressedEvents = 0;
+
+    if (damping->suppressed)
+    {
+        status = StartLinkDampingTimer(portExt,
+                                       FM10000_LINK_DAMPING_REEVAL_MSEC);
+    }
+    else if (portExt->attributes.linkDampingHalfLife == 0)
+    {
+        damping->penalty = 0;
+    }
+
+    FM_DROP_STATE_LOCK(sw);
+
+    return status;
+
+}   /* end fm10000ResetLinkDamping */
+
+
+
+
+/*****************************************************************************/
+/** fm10000GetLinkDampingStatus
+ * \ingroup intPort
+ *
+ * \desc            Retrieves the link-flap damping state and counters of a
+ *                  port, with the penalty decayed to the current time.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the port on which to operate.
+ *
+ * \param[out]      status points to caller-allocated storage where this
+ *                  function should place the damping status.
+ *
+ * \return          FM_OK
+ *
+ *****************************************************************************/
+fm_status fm10000GetLinkDampingStatus(fm_int                sw,
+                                      fm_int                port,
+                                      fm_linkDampingStatus *status)
+{
+    fm10000_port *portExt;
+
+    portExt = GET_PORT_EXT(sw, port);
+
+    FM_TAKE_STATE_LOCK(sw);
+
+    *status = portExt->linkDamping;
+    status->penalty =
+        GetDecayedLinkDampingPenalty(portExt,
+                                     portExt->attributes.linkDampingHalfLife,
+                                     fmGetMonotonicNsec());
+
+    FM_DROP_STATE_LOCK(sw);
+
+    return FM_OK;
+
+}   /* end fm10000GetLinkDampingStatus */
+
+
+
+
 /*****************************************************************************/
 /** fm10000InitPcs
  * \ingroup intPort
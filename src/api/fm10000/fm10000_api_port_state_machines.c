@@ -7731,6 +7731,13 @@ fm_status fm10000RegisterAnPortStateMachine( void )
                                              dynstt,
                                              logCallback,
                                              TRUE ); 
+    if ( status != FM_OK )
+    {
+        return status;
+    }
+
+    status = fmSetStateTransitionLogCategories( FM10000_AN_PORT_STATE_MACHINE,
+                                                FM_LOG_CAT_PORT );
     return status;
 
 }   /* end fm10000RegisterAnPortStateMachine */
@@ -7813,6 +7820,13 @@ fm_status fm10000RegisterBasicPortStateMachine( void )
                                              dynstt,
                                              logCallback,
                                              TRUE ); 
+    if ( status != FM_OK )
+    {
+        return status;
+    }
+
+    status = fmSetStateTransitionLogCategories( FM10000_BASIC_PORT_STATE_MACHINE,
+                                                FM_LOG_CAT_PORT );
     return status;
 
 }   /* end fm10000RegisterBasicPortStateMachine */
@@ -7895,6 +7909,13 @@ fm_status fm10000RegisterPciePortStateMachine( void )
                                              dynstt,
                                              logCallback,
                                              TRUE ); 
+    if ( status != FM_OK )
+    {
+        return status;
+    }
+
+    status = fmSetStateTransitionLogCategories( FM10000_PCIE_PORT_STATE_MACHINE,
+                                                FM_LOG_CAT_PORT );
     return status;
 
 }   /* end fm10000RegisterPciePortStateMachine */
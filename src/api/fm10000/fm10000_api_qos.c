@@ -110,6 +110,11 @@
 
 #define FM10000_QOS_QUEUE_DRR_Q_UNIT                    167772
 
+/* TRUE if a watermark field differs from the value last written to the
+ * chip, or if nothing is known about the chip contents. */
+#define FM10000_QOS_WM_CHANGED(prev, wpm, field)                  \
+    ( ((prev) == NULL) || ((prev)->field != (wpm)->field) )
+
 
 /***************************************************************************/
 /* Convert from bytes to segments.
@@ -437,6 +442,9 @@ static fm_status SetMappingTables(fm_int sw,
 
 static fm_status SetWatermarks(fm_int sw, 
                                fm10000_wmParam *wpm);
+static void InvalidateAppliedWatermarks(fm_int  sw,
+                                        fm_bool portAttr,
+                                        fm_int  attr);
 
 static fm_status SetDefaultMaps(fm_int smpId, 
                                 fm10000_wmParam *wpm);
@@ -547,6 +555,7 @@ static fm_status SetAutoPauseMode(fm_int    sw,
                                   fm_bool   enable)
 {
     fm_switch *         switchPtr;
+    fm10000_switch *    switchExt;
     fm_status           err;
     fm_status           err2;
     fm_text             wmScheme;
@@ -564,6 +573,17 @@ static fm_status SetAutoPauseMode(fm_int    sw,
 
     /* Get the switch pointer */
     switchPtr = GET_SWITCH_PTR(sw);
+    switchExt = GET_SWITCH_EXT(sw);
+
+    if (switchExt->wmBatchDepth > 0)
+    {
+        /* Recompute once when the outermost batch is closed */
+        switchPtr->autoPauseMode = enable;
+        switchExt->wmRecomputePending = TRUE;
+        switchExt->wmPendingDefaultMaps |= defaultMaps;
+
+        FM_LOG_EXIT(FM_LOG_CAT_QOS, FM_OK);
+    }
 
     /* Allocate memory for watermark configuration */
     wpm = fmAlloc(sizeof(fm10000_wmParam));
@@ -708,6 +728,84 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** InvalidateAppliedWatermarks
+ * \ingroup intQos
+ *
+ * \desc            Forget the watermark configuration saved by
+ *                  ''SetWatermarks'' if the given QoS attribute writes a
+ *                  watermark register directly, so that the next
+ *                  recompute rewrites every register.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       portAttr is TRUE if attr is a port QoS attribute,
+ *                  FALSE if it is a switch QoS attribute.
+ *
+ * \param[in]       attr is the QoS attribute being set.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void InvalidateAppliedWatermarks(fm_int  sw,
+                                        fm_bool portAttr,
+                                        fm_int  attr)
+{
+    fm10000_switch *switchExt;
+    fm_bool         directWrite;
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    if (portAttr)
+    {
+        switch (attr)
+        {
+            case FM_QOS_PRIVATE_PAUSE_ON_WM:
+            case FM_QOS_PRIVATE_PAUSE_OFF_WM:
+            case FM_QOS_RX_HOG_WM:
+            case FM_QOS_RX_PRIVATE_WM:
+            case FM_QOS_TX_TC_PRIVATE_WM:
+            case FM_QOS_TX_SOFT_DROP_ON_PRIVATE:
+            case FM_QOS_TX_SOFT_DROP_ON_RXMP_FREE:
+            case FM_QOS_TX_HOG_WM:
+                directWrite = TRUE;
+                break;
+
+            default:
+                directWrite = FALSE;
+                break;
+        }
+    }
+    else
+    {
+        switch (attr)
+        {
+            case FM_QOS_PRIV_WM:
+            case FM_QOS_SHARED_PAUSE_OFF_WM:
+            case FM_QOS_SHARED_PAUSE_ON_WM:
+            case FM_QOS_SHARED_PRI_WM:
+            case FM_QOS_SHARED_SOFT_DROP_WM:
+            case FM_QOS_SHARED_SOFT_DROP_WM_HOG:
+            case FM_QOS_SHARED_SOFT_DROP_WM_JITTER:
+                directWrite = TRUE;
+                break;
+
+            default:
+                directWrite = FALSE;
+                break;
+        }
+    }
+
+    if (directWrite)
+    {
+        switchExt->appliedWmValid = FALSE;
+    }
+
+}   /* end InvalidateAppliedWatermarks */
+
+
+
+
 /*****************************************************************************/
 /** ReadCmRegMaps
  * \ingroup intQos
@@ -878,13 +976,19 @@ ABORT:
 /** SetWatermarks
  * \ingroup intQos
  *
- * \desc            Set the watermark configuration into chip registers
+ * \desc            Set the watermark configuration into chip registers.
+ *                  Only the registers whose value differs from the last
+ *                  configuration written by this function are updated, so
+ *                  a recompute triggered by a single port only touches
+ *                  that port's partitions and the global pools.
  *
  * \param[in]       sw is the switch on which to operate.
  *
  * \param[in]       wpm is a pointer to the watermark parameters to set
  *
  * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if the applied configuration could not
+ *                  be saved.
  *
  *****************************************************************************/
 static fm_status SetWatermarks(fm_int sw, 
@@ -897,25 +1001,49 @@ static fm_status SetWatermarks(fm_int sw,
     fm_int              smp;
     fm_int              swPri;
     fm_switch *         switchPtr;
+    fm10000_switch *    switchExt;
+    fm10000_wmParam *   prev;
     fm_bool             regLockTaken = FALSE;
 
     FM_LOG_ENTRY(FM_LOG_CAT_QOS, "sw=%d\n", sw);
 
     /* Get the switch pointer */
     switchPtr = GET_SWITCH_PTR(sw);
+    switchExt = GET_SWITCH_EXT(sw);
 
     /* Initialize local variables */
     err = FM_OK;
     regLockTaken = FALSE;
 
+    if (switchExt->appliedWm == NULL)
+    {
+        switchExt->appliedWm = fmAlloc(sizeof(fm10000_wmParam));
+
+        if (switchExt->appliedWm == NULL)
+        {
+            FM_LOG_EXIT(FM_LOG_CAT_QOS, FM_ERR_NO_MEM);
+        }
+
+        switchExt->appliedWmValid = FALSE;
+    }
+
+    /* Without a known chip configuration every register is written */
+    prev = switchExt->appliedWmValid ? switchExt->appliedWm : NULL;
+
+    /* The saved copy is only trusted again once all writes succeed */
+    switchExt->appliedWmValid = FALSE;
+
     /* Acquire register lock */
     FM_FLAG_TAKE_REG_LOCK(sw);
 
     /* CM_GLOBAL_WM */
-    err = switchPtr->WriteUINT32(sw, 
-                                 FM10000_CM_GLOBAL_WM(), 
-                                 wpm->cmGlobalWm);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+    if (FM10000_QOS_WM_CHANGED(prev, wpm, cmGlobalWm))
+    {
+        err = switchPtr->WriteUINT32(sw, 
+                                     FM10000_CM_GLOBAL_WM(), 
+                                     wpm->cmGlobalWm);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+    }
 
     for (cpi = 0 ; cpi < switchPtr->numCardinalPorts ; cpi++)
     {
@@ -927,80 +1055,128 @@ static fm_status SetWatermarks(fm_int sw,
         for (smp = 0 ; smp <= FM10000_QOS_MAX_SMP; smp++)
         {
             /* CM_RX_SMP_PRIVATE_WM */
-            err = switchPtr->WriteUINT32(sw, 
+            if (FM10000_QOS_WM_CHANGED(prev,
+                                       wpm,
+                                       cmRxSmpPrivateWm[physPort][smp]))
+            {
+                err = switchPtr->WriteUINT32(sw, 
                                     FM10000_CM_RX_SMP_PRIVATE_WM(physPort, smp), 
                                     wpm->cmRxSmpPrivateWm[physPort][smp]);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+            }
 
             /* CM_RX_SMP_PAUSE_WM */
-            err = switchPtr->WriteUINT32(sw, 
+            if (FM10000_QOS_WM_CHANGED(prev,
+                                       wpm,
+                                       cmRxSmpPauseWm[physPort][smp]))
+            {
+                err = switchPtr->WriteUINT32(sw, 
                                       FM10000_CM_RX_SMP_PAUSE_WM(physPort, smp), 
                                       wpm->cmRxSmpPauseWm[physPort][smp]);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+            }
 
             /* CM_RX_SMP_HOG_WM */ 
-            err = switchPtr->WriteUINT32(sw, 
+            if (FM10000_QOS_WM_CHANGED(prev,
+                                       wpm,
+                                       cmRxSmpHogWm[physPort][smp]))
+            {
+                err = switchPtr->WriteUINT32(sw, 
                                         FM10000_CM_RX_SMP_HOG_WM(physPort, smp), 
                                         wpm->cmRxSmpHogWm[physPort][smp]);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+            }
         }
 
         for (tc = 0 ; tc <= FM10000_QOS_MAX_TC; tc++)
         {
             /* CM_TX_TC_HOG_WM */
-            err = switchPtr->WriteUINT32(sw, 
+            if (FM10000_QOS_WM_CHANGED(prev,
+                                       wpm,
+                                       cmTxTcHogWm[physPort][tc]))
+            {
+                err = switchPtr->WriteUINT32(sw, 
                                          FM10000_CM_TX_TC_HOG_WM(physPort, tc), 
                                          wpm->cmTxTcHogWm[physPort][tc]);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+            }
 
             /* CM_TX_TC_PRIVATE_WM */
-            err = switchPtr->WriteUINT32(sw, 
+            if (FM10000_QOS_WM_CHANGED(prev,
+                                       wpm,
+                                       cmTxTcPrivateWm[physPort][tc]))
+            {
+                err = switchPtr->WriteUINT32(sw, 
                                       FM10000_CM_TX_TC_PRIVATE_WM(physPort, tc), 
                                       wpm->cmTxTcPrivateWm[physPort][tc]);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+            }
         }
 
         for (swPri = 0 ; swPri <= FM10000_QOS_MAX_SW_PRI; swPri++)
         {
             /* CM_APPLY_TX_SOFTDROP_CFG */
-            err = switchPtr->WriteUINT32(sw, 
+            if (FM10000_QOS_WM_CHANGED(prev,
+                                       wpm,
+                                       cmApplyTxSoftDropCfg[physPort][swPri]))
+            {
+                err = switchPtr->WriteUINT32(sw, 
                               FM10000_CM_APPLY_TX_SOFTDROP_CFG(physPort, swPri), 
                               wpm->cmApplyTxSoftDropCfg[physPort][swPri]);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+            }
         }
     }
 
     for (smp = 0 ; smp <= FM10000_QOS_MAX_SMP; smp++)
     {
         /* CM_SHARED_SMP_PAUSE_WM */
-        err = switchPtr->WriteUINT32(sw, 
-                                FM10000_CM_SHARED_SMP_PAUSE_WM(smp), 
-                                wpm->cmSharedSmpPauseWm[smp]);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+        if (FM10000_QOS_WM_CHANGED(prev, wpm, cmSharedSmpPauseWm[smp]))
+        {
+            err = switchPtr->WriteUINT32(sw, 
+                                    FM10000_CM_SHARED_SMP_PAUSE_WM(smp), 
+                                    wpm->cmSharedSmpPauseWm[smp]);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+        }
     }
 
     for (swPri = 0 ; swPri <= FM10000_QOS_MAX_SW_PRI; swPri++)
     {
         /* CM_SHARED_WM */
-        err = switchPtr->WriteUINT32(sw, 
-                                FM10000_CM_SHARED_WM(swPri), 
-                                wpm->cmSharedWm[swPri]);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+        if (FM10000_QOS_WM_CHANGED(prev, wpm, cmSharedWm[swPri]))
+        {
+            err = switchPtr->WriteUINT32(sw, 
+                                    FM10000_CM_SHARED_WM(swPri), 
+                                    wpm->cmSharedWm[swPri]);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+        }
         
         /* CM_SOFTDROP_WM */ 
-        err = switchPtr->WriteUINT32(sw, 
-                                FM10000_CM_SOFTDROP_WM(swPri), 
-                                wpm->cmSoftDropWm[swPri]);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+        if (FM10000_QOS_WM_CHANGED(prev, wpm, cmSoftDropWm[swPri]))
+        {
+            err = switchPtr->WriteUINT32(sw, 
+                                    FM10000_CM_SOFTDROP_WM(swPri), 
+                                    wpm->cmSoftDropWm[swPri]);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+        }
 
         /* CM_APPLY_SOFTDROP_CFG */
-        err = switchPtr->WriteUINT32(sw, 
-                                FM10000_CM_APPLY_SOFTDROP_CFG(swPri), 
-                                wpm->cmApplySoftDropCfg[swPri]);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+        if (FM10000_QOS_WM_CHANGED(prev, wpm, cmApplySoftDropCfg[swPri]))
+        {
+            err = switchPtr->WriteUINT32(sw, 
+                                    FM10000_CM_APPLY_SOFTDROP_CFG(swPri), 
+                                    wpm->cmApplySoftDropCfg[swPri]);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+        }
 
     }
 
+    FM_MEMCPY_S(switchExt->appliedWm,
+                sizeof(fm10000_wmParam),
+                wpm,
+                sizeof(fm10000_wmParam));
+    switchExt->appliedWmValid = TRUE;
+
 ABORT:
     if (regLockTaken)
     {
@@ -3253,22 +3429,16 @@ static fm_status PriorityMapperFindMap(
     switchPtr = GET_SWITCH_PTR(sw);
     switchExt = (fm10000_switch *) switchPtr->extension;
 
-    priorityMap = 
-      FM10000_PRIORITY_MAPPER_FIRST_MAP_GET(&(switchExt->priorityMapSet->maps));
-
-    while (priorityMap != NULL)
+    if ( (trapClass >= 0) && (trapClass < FM10000_QOS_TRAP_CLASS_MAX) )
     {
+        priorityMap = &switchExt->priorityMapSet->mapTable[trapClass];
+
         if (priorityMap->trapClass == trapClass)
         {
             *internalMap = priorityMap;
 
             status = FM_OK;
-
-            break;
         }
-
-        priorityMap = FM10000_PRIORITY_MAPPER_NEXT_MAP_GET(priorityMap,
-                                                     FM10000_PRI_MAP_LIST_POOL);
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_QOS, status);
@@ -5051,6 +5221,8 @@ fm_status fm10000SetPortQOS(fm_int sw,
         FM_LOG_EXIT(FM_LOG_CAT_QOS, err);
     }
 
+    InvalidateAppliedWatermarks(sw, TRUE, attr);
+
     /* Take action for each attribute */
     switch (attr)
     {
@@ -6459,6 +6631,8 @@ fm_status fm10000SetSwitchQOS(fm_int sw,
 
     /* Get the switch pointer */
     switchPtr = GET_SWITCH_PTR(sw);
+
+    InvalidateAppliedWatermarks(sw, FALSE, attr);
     
     /* Take action for each attribute */
     switch (attr)
@@ -7606,6 +7780,7 @@ fm_status fm10000InitializeCM(fm_int sw)
     
         err = switchPtr->WriteUINT32(sw, FM10000_CM_GLOBAL_WM(), rv);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+        switchExt->appliedWmValid = FALSE;
     
         /* Set PAUSE base frequency */
         err = switchPtr->ReadUINT32(sw, FM10000_PLL_FABRIC_CTRL(), &rv);
@@ -7687,6 +7862,93 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000BeginWatermarkUpdate
+ * \ingroup intQos
+ *
+ * \desc            Opens a watermark update batch. While a batch is open,
+ *                  changes that would recompute the automatic watermarks
+ *                  (pause mode, MTU, per-port lossless pause) are only
+ *                  recorded; the watermarks are recomputed once by
+ *                  ''fm10000EndWatermarkUpdate''. Batches may be nested.
+ *
+ * \note            The caller must hold the same lock it uses to change
+ *                  the QoS attributes, and must close every batch it opens.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000BeginWatermarkUpdate(fm_int sw)
+{
+    fm10000_switch *switchExt;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_QOS, "sw=%d\n", sw);
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    switchExt->wmBatchDepth++;
+
+    FM_LOG_EXIT(FM_LOG_CAT_QOS, FM_OK);
+
+}   /* end fm10000BeginWatermarkUpdate */
+
+
+
+
+/*****************************************************************************/
+/** fm10000EndWatermarkUpdate
+ * \ingroup intQos
+ *
+ * \desc            Closes a watermark update batch opened by
+ *                  ''fm10000BeginWatermarkUpdate''. When the outermost
+ *                  batch is closed, the watermarks are recomputed once if
+ *                  any change was recorded while the batch was open.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if no batch is open.
+ *
+ *****************************************************************************/
+fm_status fm10000EndWatermarkUpdate(fm_int sw)
+{
+    fm_switch *     switchPtr;
+    fm10000_switch *switchExt;
+    fm_bool         defaultMaps;
+    fm_status       err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_QOS, "sw=%d\n", sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    switchExt = GET_SWITCH_EXT(sw);
+    err       = FM_OK;
+
+    if (switchExt->wmBatchDepth <= 0)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_QOS, FM_FAIL);
+    }
+
+    switchExt->wmBatchDepth--;
+
+    if ( (switchExt->wmBatchDepth == 0) && switchExt->wmRecomputePending )
+    {
+        defaultMaps = switchExt->wmPendingDefaultMaps;
+
+        switchExt->wmRecomputePending   = FALSE;
+        switchExt->wmPendingDefaultMaps = FALSE;
+
+        err = SetAutoPauseMode(sw, defaultMaps, switchPtr->autoPauseMode);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_QOS, err);
+
+}   /* end fm10000EndWatermarkUpdate */
+
+
+
+
 /*****************************************************************************/
 /** fm10000QOSPriorityMapperAllocateResources
  * \ingroup intQoS
@@ -7761,18 +8023,22 @@ fm_status fm10000QOSPriorityMapperAllocateResources(fm_int sw)
      **************************************************/
     FM10000_PRIORITY_MAPPER_LIST_MAP_INITIALIZE(&(priorityMapSet->maps));
 
-    size = (fm_uint) sizeof(fm10000_internalPriorityMap);
+    size = (fm_uint) (sizeof(fm10000_internalPriorityMap) *
+                      FM10000_QOS_TRAP_CLASS_MAX);
 
-    for (i = 0 ; i < FM10000_QOS_TRAP_CLASS_MAX ; i++)
+    priorityMapSet->mapTable = (fm10000_internalPriorityMap *) fmAlloc(size);
+
+    if (priorityMapSet->mapTable == NULL)
     {
-        priorityMap = (fm10000_internalPriorityMap *) fmAlloc(size);
+        status = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, status);
+    }
 
-        if (priorityMap == NULL)
-        {
-            status = FM_ERR_NO_MEM;
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, status);
+    memset((void *) priorityMapSet->mapTable, 0, size);
 
-        }   /* end if (priorityMap == NULL) */
+    for (i = 0 ; i < FM10000_QOS_TRAP_CLASS_MAX ; i++)
+    {
+        priorityMap = &priorityMapSet->mapTable[i];
 
         priorityMap->trapClass = i;
         priorityMap->priority   = FM_QOS_SWPRI_DEFAULT;
@@ -7809,8 +8075,6 @@ fm_status fm10000QOSPriorityMapperFreeResources(fm_int sw)
 {
     fm_switch *                  switchPtr;
     fm_status                    status = FM_OK;
-    fm10000_internalPriorityMap  *nextMap;
-    fm10000_internalPriorityMap  *priorityMap;
     fm10000_switch *             switchExt;
     fm_int                       i;
 
@@ -7821,6 +8085,13 @@ fm_status fm10000QOSPriorityMapperFreeResources(fm_int sw)
     switchPtr = GET_SWITCH_PTR(sw);
     switchExt = (fm10000_switch *) switchPtr->extension;
 
+    if (switchExt->appliedWm != NULL)
+    {
+        fmFree(switchExt->appliedWm);
+        switchExt->appliedWm      = NULL;
+        switchExt->appliedWmValid = FALSE;
+    }
+
     if (switchExt->priorityMapSet == NULL)
     {
         /* Either not created yet or already freed */
@@ -7844,19 +8115,7 @@ fm_status fm10000QOSPriorityMapperFreeResources(fm_int sw)
         }
     }
 
-    priorityMap = 
-      FM10000_PRIORITY_MAPPER_FIRST_MAP_GET(&(switchExt->priorityMapSet->maps));
-
-    while (priorityMap != NULL)
-    {
-
-        nextMap = FM10000_PRIORITY_MAPPER_NEXT_MAP_GET(priorityMap,
-                                                     FM10000_PRI_MAP_LIST_POOL);
-        fmFree((void *) priorityMap);
-        priorityMap = nextMap;
-
-    }
-
+    fmFree(switchExt->priorityMapSet->mapTable);
     fmFree(switchExt->priorityMapSet);
     switchExt->priorityMapSet = NULL;
 
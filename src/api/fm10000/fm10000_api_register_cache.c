@@ -1791,6 +1791,8 @@ static fm_uint32 fm10000GetCacheTeGlortMapDefault(fm_uint32 addr)
  * \ingroup intRegCache
  *
  * \desc            FM10000-specific register cache initialization.
+ *                  Restores the cache from the snapshot named by the
+ *                  api.regCache.snapshotFile property, if any.
  * 
  * \param[in]       sw is the switch whose cache is being initialized.
  * 
@@ -1806,6 +1808,8 @@ static fm_uint32 fm10000GetCacheTeGlortMapDefault(fm_uint32 addr)
 fm_status fm10000InitRegisterCache(fm_int sw)
 {
     fm_status      err;
+    fm_status      snapErr;
+    fm_text        fileName;
 
     /* sanity check on the switch ID */
     VALIDATE_SWITCH_INDEX(sw);
@@ -1815,6 +1819,22 @@ fm_status fm10000InitRegisterCache(fm_int sw)
     /* now invoke the generic initialization routine */
     err = fmInitRegisterCache(sw);
 
+    /* and reload the snapshot saved when the switch was last removed */
+    fileName = GET_PROPERTY()->regCacheSnapshotFile;
+
+    if ( (err == FM_OK) && (fileName[0] != '\0') )
+    {
+        snapErr = fmRegCacheRestoreSnapshot(sw, fileName);
+
+        if (snapErr != FM_OK && snapErr != FM_ERR_NOT_FOUND)
+        {
+            FM_LOG_WARNING(FM_LOG_CAT_SWITCH,
+                           "Ignoring register cache snapshot %s: %s\n",
+                           fileName,
+                           fmErrorMsg(snapErr));
+        }
+    }
+
     FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
 
 }   /* end fm10000InitRegisterCache */
@@ -737,6 +737,18 @@ static fm_bool IsValidCascadeForRouteType(fm_int                sw,
 static fm_status AllocateTemporaryCascade(fm_int                sw,
                                           fm10000_RoutingState *pStateTable,
                                           fm10000_RouteTypes    routeType);
+static fm_bool GetGapBetweenPrefixes(fm10000_RoutingTable * pRouteTable,
+                                     fm10000_RoutePrefix *  pPrevPrefix,
+                                     fm10000_RoutePrefix *  pNextPrefix,
+                                     fm10000_RouteSlice **  ppFirstSlice,
+                                     fm_int *               pFirstRow,
+                                     fm10000_RouteSlice **  ppLastSlice,
+                                     fm_int *               pLastRow);
+static fm_int PlanChainMoves(fm_int                  sw,
+                             fm10000_RoutingTable *  pRouteTable,
+                             fm10000_TcamRouteEntry *pRoute,
+                             fm_bool                 moveUp,
+                             fm_bool                 optimize);
 static fm_status FindFfuEntryForNewRoute(fm_int                  sw,
                                          fm_intRouteEntry *      pRoute,
                                          fm10000_RouteInfo *     pRouteInfo,
@@ -783,6 +795,10 @@ static fm_status SetVirtualRouterMacRegisters(fm_int         sw,
                                               fm_int         vroff,
                                               fm_int         vrMacId,
                                               fm_routerState state);
+static fm_status CompactRouteSlice(fm_int              sw,
+                                   fm10000_RouteSlice *pRouteSlice,
+                                   fm_int *            budget,
+                                   fm_int *            numMoved);
 
 
 
@@ -993,12 +1009,12 @@ static fm_status InitRouteTable(fm_int                 sw,
         pRouteTable->stateTable = &pSwitchExt->routeStateTable;
 
         /* Initialize tcam route tree "sorted by route" */
-        fmCustomTreeInit(&pRouteTable->tcamRouteRouteTree,
-                         fm10000CompareTcamRoutes);
+        fmCustomTreeInitBtree(&pRouteTable->tcamRouteRouteTree,
+                              fm10000CompareTcamRoutes);
 
         /* Initialize tcam route tree "sorted by slice number and row" */
-        fmCustomTreeInit(&pRouteTable->tcamSliceRouteTree,
-                         CompareTcamRoutesBySlice);
+        fmCustomTreeInitBtree(&pRouteTable->tcamSliceRouteTree,
+                              CompareTcamRoutesBySlice);
 
         fmCustomTreeRequestCallbacks(&pRouteTable->tcamSliceRouteTree,
                                      InsertTcamRouteCallback,
@@ -2795,6 +2811,11 @@ static fm_bool MoveRoute(fm_int                  sw,
                 routeMoved = TRUE;
             }
         }
+
+        if ( routeMoved && pRoute->stateTable->actualState )
+        {
+            pRoute->stateTable->tcamRouteMoves++;
+        }
     }
 
     return routeMoved;
@@ -3941,7 +3962,8 @@ static fm_status AllocateAndInitTcamRoute(fm_int                   sw,
     else
     {
         *ppTcamRoute = NULL;
-        pTcamRouteLoc = fmAlloc( sizeof(fm10000_TcamRouteEntry) );
+        pTcamRouteLoc = fmAllocTagged( sizeof(fm10000_TcamRouteEntry),
+                                       FM_LOG_CAT_ROUTING );
 
         if (pTcamRouteLoc == NULL)
         {
@@ -3996,6 +4018,268 @@ static fm_status AllocateAndInitTcamRoute(fm_int                   sw,
 
 
 
+/*****************************************************************************/
+/** GetGapBetweenPrefixes
+ * \ingroup intRouter
+ *
+ * \desc            Returns the range of rows between the last route of a
+ *                  prefix and the first route of the following prefix. This
+ *                  is the range within which a route of a prefix between the
+ *                  two may be placed.
+ *
+ * \param[in]       pRouteTable points to the route table.
+ *
+ * \param[in]       pPrevPrefix points to the preceding prefix, NULL to start
+ *                  at the top of the first slice.
+ *
+ * \param[in]       pNextPrefix points to the following prefix, NULL to end
+ *                  at the bottom of the last slice.
+ *
+ * \param[out]      ppFirstSlice points to caller-allocated storage where the
+ *                  first slice of the range is written.
+ *
+ * \param[out]      pFirstRow points to caller-allocated storage where the
+ *                  first row of the range is written.
+ *
+ * \param[out]      ppLastSlice points to caller-allocated storage where the
+ *                  last slice of the range is written.
+ *
+ * \param[out]      pLastRow points to caller-allocated storage where the
+ *                  last row of the range is written.
+ *
+ * \return          TRUE if the range is valid.
+ * \return          FALSE if a neighbouring prefix has no route or the range
+ *                  falls outside the route table's slices.
+ *
+ *****************************************************************************/
+static fm_bool GetGapBetweenPrefixes(fm10000_RoutingTable * pRouteTable,
+                                     fm10000_RoutePrefix *  pPrevPrefix,
+                                     fm10000_RoutePrefix *  pNextPrefix,
+                                     fm10000_RouteSlice **  ppFirstSlice,
+                                     fm_int *               pFirstRow,
+                                     fm10000_RouteSlice **  ppLastSlice,
+                                     fm_int *               pLastRow)
+{
+    fm10000_TcamRouteEntry *pTempTcamRoute;
+
+    *ppFirstSlice = NULL;
+    *pFirstRow    = -1;
+    *ppLastSlice  = NULL;
+    *pLastRow     = -1;
+
+    if (pPrevPrefix != NULL)
+    {
+        pTempTcamRoute = GetLastPrefixRoute(pPrevPrefix);
+
+        if (pTempTcamRoute != NULL)
+        {
+            *ppFirstSlice = pTempTcamRoute->routeSlice;
+            *pFirstRow    = pTempTcamRoute->tcamSliceRow - 1;
+
+            if (*pFirstRow < 0)
+            {
+                *ppFirstSlice = (*ppFirstSlice)->nextSlice;
+                *pFirstRow    = FM10000_FFU_ENTRIES_PER_SLICE - 1;
+            }
+        }
+    }
+    else
+    {
+        *ppFirstSlice = pRouteTable->firstSlice;
+        *pFirstRow    = FM10000_FFU_ENTRIES_PER_SLICE - 1;
+    }
+
+    if (pNextPrefix != NULL)
+    {
+        pTempTcamRoute = GetFirstPrefixRoute(pNextPrefix);
+
+        if (pTempTcamRoute != NULL)
+        {
+            *ppLastSlice = pTempTcamRoute->routeSlice;
+            *pLastRow    = pTempTcamRoute->tcamSliceRow + 1;
+
+            if (*pLastRow >= FM10000_FFU_ENTRIES_PER_SLICE)
+            {
+                *ppLastSlice = (*ppLastSlice)->prevSlice;
+                *pLastRow    = 0;
+            }
+        }
+    }
+    else
+    {
+        *ppLastSlice = pRouteTable->lastSlice;
+        *pLastRow    = 0;
+    }
+
+    return ( (*ppFirstSlice != NULL) && (*ppLastSlice != NULL) );
+
+}   /* end GetGapBetweenPrefixes */
+
+
+
+
+/*****************************************************************************/
+/** PlanChainMoves
+ * \ingroup intRouter
+ *
+ * \desc            Counts the route moves that MoveRouteUpWithinPrefix or
+ *                  MoveRouteDownWithinPrefix would make to free the row of a
+ *                  route. Each prefix crossed on the way to an empty row
+ *                  adds one move to the chain. Nothing is changed.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       pRouteTable points to the route table.
+ *
+ * \param[in]       pRoute points to the route whose row is to be freed.
+ *
+ * \param[in]       moveUp is TRUE to plan a chain towards the preceding
+ *                  prefixes, FALSE towards the following prefixes.
+ *
+ * \param[in]       optimize is TRUE if only rows that optimize slice
+ *                  sharing may be used.
+ *
+ * \return          the number of moves in the chain.
+ * \return          -1 if no empty row is reachable without reconfiguring
+ *                  slice cascades.
+ *
+ *****************************************************************************/
+static fm_int PlanChainMoves(fm_int                  sw,
+                             fm10000_RoutingTable *  pRouteTable,
+                             fm10000_TcamRouteEntry *pRoute,
+                             fm_bool                 moveUp,
+                             fm_bool                 optimize)
+{
+    fm10000_RoutePrefix *   pRoutePrefix;
+    fm10000_RoutePrefix *   pNeighbor;
+    fm10000_TcamRouteEntry *pNeighborRoute;
+    fm10000_RouteSlice *    pFirstSlice;
+    fm10000_RouteSlice *    pLastSlice;
+    fm10000_RouteSlice *    pSlice;
+    fm_int *                pTmpPrefixLength;
+    fm_int                  firstRow;
+    fm_int                  lastRow;
+    fm_int                  row;
+    fm_int                  moves;
+    fm_status               err;
+
+    moves = 0;
+
+    while (pRoute != NULL)
+    {
+        moves++;
+
+        pRoutePrefix = pRoute->routePrefix;
+
+        if (moveUp)
+        {
+            err = fmCustomTreePredecessor(&pRouteTable->prefixTree,
+                                          &pRoutePrefix->prefix,
+                                          (void **) &pTmpPrefixLength,
+                                          (void **) &pNeighbor);
+        }
+        else
+        {
+            err = fmCustomTreeSuccessor(&pRouteTable->prefixTree,
+                                        &pRoutePrefix->prefix,
+                                        (void **) &pTmpPrefixLength,
+                                        (void **) &pNeighbor);
+        }
+
+        if (err != FM_OK)
+        {
+            pNeighbor = NULL;
+        }
+
+        pNeighborRoute = NULL;
+
+        /* The range runs from the row next to the route, in the direction
+         * of the move, to the row before the neighbouring prefix. */
+        if (moveUp)
+        {
+            pFirstSlice = pRoute->routeSlice;
+            firstRow    = pRoute->tcamSliceRow + 1;
+
+            if (firstRow >= FM10000_FFU_ENTRIES_PER_SLICE)
+            {
+                pFirstSlice = pFirstSlice->prevSlice;
+                firstRow    = 0;
+            }
+
+            if (pNeighbor != NULL)
+            {
+                pNeighborRoute = GetLastPrefixRoute(pNeighbor);
+            }
+
+            if ( !GetGapBetweenPrefixes(pRouteTable,
+                                        pNeighbor,
+                                        NULL,
+                                        &pLastSlice,
+                                        &lastRow,
+                                        &pSlice,
+                                        &row) )
+            {
+                return -1;
+            }
+        }
+        else
+        {
+            pFirstSlice = pRoute->routeSlice;
+            firstRow    = pRoute->tcamSliceRow - 1;
+
+            if (firstRow < 0)
+            {
+                pFirstSlice = pFirstSlice->nextSlice;
+                firstRow    = FM10000_FFU_ENTRIES_PER_SLICE - 1;
+            }
+
+            if (pNeighbor != NULL)
+            {
+                pNeighborRoute = GetFirstPrefixRoute(pNeighbor);
+            }
+
+            if ( !GetGapBetweenPrefixes(pRouteTable,
+                                        NULL,
+                                        pNeighbor,
+                                        &pSlice,
+                                        &row,
+                                        &pLastSlice,
+                                        &lastRow) )
+            {
+                return -1;
+            }
+        }
+
+        if (pFirstSlice == NULL)
+        {
+            return -1;
+        }
+
+        if ( FindEmptyRowWithinSliceRange(sw,
+                                          pFirstSlice,
+                                          firstRow,
+                                          pLastSlice,
+                                          lastRow,
+                                          optimize,
+                                          &pSlice,
+                                          &row,
+                                          NULL,
+                                          NULL) )
+        {
+            return moves;
+        }
+
+        /* The neighbouring prefix must give up a row first. */
+        pRoute = pNeighborRoute;
+    }
+
+    return -1;
+
+}   /* end PlanChainMoves */
+
+
+
+
 /*****************************************************************************/
 /** FindFfuEntryForNewRoute
  * \ingroup intRouter
@@ -4040,6 +4324,15 @@ static fm_status FindFfuEntryForNewRoute(fm_int                  sw,
     fm_int                 firstSearchRow;
     fm10000_RouteSlice *   pLastSearchSlicePtr;
     fm_int                 lastSearchRow;
+    fm10000_TcamRouteEntry *pUpRoute;
+    fm10000_TcamRouteEntry *pDownRoute;
+    fm_int                 upMoves;
+    fm_int                 downMoves;
+    fm_bool                downFirst;
+    fm_bool                moveUp;
+    fm_int                 attempt;
+    fm_uint64              movesBefore;
+    fm_uint64              moves;
     fm_bool                optimize;
     fm_bool                entryFound;
 
@@ -4068,6 +4361,7 @@ static fm_status FindFfuEntryForNewRoute(fm_int                  sw,
         *pDestRow      = -1;
 
         pRouteTable = pRouteInfo->routeTable;
+        movesBefore = pRouteTable->stateTable->tcamRouteMoves;
 
 
         /* Is this the very first route for this route type? */
@@ -4152,125 +4446,102 @@ static fm_status FindFfuEntryForNewRoute(fm_int                  sw,
                     break;
                 }
 
-                /* Try to move the last route of the previous prefix up */
-                if (pPrevPrefix != NULL)
+                /* Determine the slice/row boundaries between the last row of the
+                 * previous prefix and the first route of the next prefix.
+                 * An empty row there takes no move at all, so it is preferred
+                 * to any chain of moves. */
+                if ( GetGapBetweenPrefixes(pRouteTable,
+                                           pPrevPrefix,
+                                           pNextPrefix,
+                                           &pFirstSearchSlicePtr,
+                                           &firstSearchRow,
+                                           &pLastSearchSlicePtr,
+                                           &lastSearchRow)
+                    && FindEmptyRowWithinSliceRange(sw,
+                                                    pFirstSearchSlicePtr,
+                                                    firstSearchRow,
+                                                    pLastSearchSlicePtr,
+                                                    lastSearchRow,
+                                                    optimize,
+                                                    ppDestSlice,
+                                                    pDestRow,
+                                                    NULL,
+                                                    NULL) )
                 {
-                    pTempTcamRoute = GetLastPrefixRoute(pPrevPrefix);
-
-                    if (pTempTcamRoute != NULL)
-                    {
-                        *ppDestSlice = pTempTcamRoute->routeSlice;
-                        *pDestRow = pTempTcamRoute->tcamSliceRow;
-
-                        if ( MoveRouteUpWithinPrefix(sw,
-                                                     pRouteTable,
-                                                     pTempTcamRoute,
-                                                     FALSE,
-                                                     optimize) )
-                        {
-                            entryFound = TRUE;
-                            break;
-                        }
-                    }
+                    /* found an empty row, write route to row */
+                    entryFound = TRUE;
+                    break;
                 }
 
-                /* Try to move the first route of the next prefix down */
-                if (pNextPrefix != NULL)
+                /* Plan the chain of moves needed on either side and try the
+                 * shorter one first. A chain that cannot be planned may still
+                 * succeed by clearing a cascade row, so it is tried last. */
+                pUpRoute   = (pPrevPrefix != NULL) ? GetLastPrefixRoute(pPrevPrefix)
+                                                   : NULL;
+                pDownRoute = (pNextPrefix != NULL) ? GetFirstPrefixRoute(pNextPrefix)
+                                                   : NULL;
+                upMoves    = (pUpRoute != NULL)
+                             ? PlanChainMoves(sw, pRouteTable, pUpRoute, TRUE, optimize)
+                             : -1;
+                downMoves  = (pDownRoute != NULL)
+                             ? PlanChainMoves(sw, pRouteTable, pDownRoute, FALSE, optimize)
+                             : -1;
+                downFirst  = (downMoves >= 0) && ( (upMoves < 0) || (downMoves < upMoves) );
+
+                for (attempt = 0 ; attempt < 2 ; attempt++)
                 {
-                    pTempTcamRoute = GetFirstPrefixRoute(pNextPrefix);
+                    moveUp = ( (attempt == 0) != downFirst );
 
-                    if (pTempTcamRoute != NULL)
-                    {
-                        *ppDestSlice = pTempTcamRoute->routeSlice;
-                        *pDestRow = pTempTcamRoute->tcamSliceRow;
+                    /* Move the last route of the previous prefix up, or the
+                     * first route of the next prefix down */
+                    pTempTcamRoute = moveUp ? pUpRoute : pDownRoute;
 
-                        if ( MoveRouteDownWithinPrefix(sw,
-                                                       pRouteTable,
-                                                       pTempTcamRoute,
-                                                       FALSE,
-                                                       optimize) )
-                        {
-                            entryFound = TRUE;
-                            break;
-                        }
+                    if (pTempTcamRoute == NULL)
+                    {
+                        continue;
                     }
-                }
 
-                /* Determine the slice/row boundaries between the last row of the
-                 * previous prefix and the first route of the next prefix.
-                 * If there is no previous prefix, use the top of the first slice.
-                 * If there is no next prefix, use the bottom of the last slice. */
-                pFirstSearchSlicePtr = NULL;
-                firstSearchRow      = -1;
-                pLastSearchSlicePtr  = NULL;
-                lastSearchRow       = -1;
-
-                if (pPrevPrefix != NULL)
-                {
-                    pTempTcamRoute = GetLastPrefixRoute(pPrevPrefix);
+                    *ppDestSlice = pTempTcamRoute->routeSlice;
+                    *pDestRow    = pTempTcamRoute->tcamSliceRow;
 
-                    if (pTempTcamRoute != NULL)
+                    if (moveUp)
                     {
-                        pFirstSearchSlicePtr = pTempTcamRoute->routeSlice;
-                        firstSearchRow      = pTempTcamRoute->tcamSliceRow - 1;
-
-                        if (firstSearchRow < 0)
-                        {
-                            pFirstSearchSlicePtr = pFirstSearchSlicePtr->nextSlice;
-                            firstSearchRow      = FM10000_FFU_ENTRIES_PER_SLICE - 1;
-                        }
+                        entryFound = MoveRouteUpWithinPrefix(sw,
+                                                             pRouteTable,
+                                                             pTempTcamRoute,
+                                                             FALSE,
+                                                             optimize);
                     }
-                }
-                else
-                {
-                    pFirstSearchSlicePtr = pRouteTable->firstSlice;
-                    firstSearchRow      = FM10000_FFU_ENTRIES_PER_SLICE - 1;
-                }
-
-                if (pNextPrefix != NULL)
-                {
-                    pTempTcamRoute = GetFirstPrefixRoute(pNextPrefix);
-
-                    if (pTempTcamRoute != NULL)
+                    else
                     {
-                        pLastSearchSlicePtr = pTempTcamRoute->routeSlice;
-                        lastSearchRow      = pTempTcamRoute->tcamSliceRow + 1;
+                        entryFound = MoveRouteDownWithinPrefix(sw,
+                                                               pRouteTable,
+                                                               pTempTcamRoute,
+                                                               FALSE,
+                                                               optimize);
+                    }
 
-                        if (lastSearchRow >= FM10000_FFU_ENTRIES_PER_SLICE)
-                        {
-                            pLastSearchSlicePtr = pLastSearchSlicePtr->prevSlice;
-                            lastSearchRow      = 0;
-                        }
+                    if (entryFound)
+                    {
+                        break;
                     }
                 }
-                else
+
+                if (entryFound)
                 {
-                    pLastSearchSlicePtr = pRouteTable->lastSlice;
-                    lastSearchRow      = 0;
+                    break;
                 }
 
-                /* If we have valid boundaries */
-                if ( (pFirstSearchSlicePtr != NULL)
-                    && (pLastSearchSlicePtr != NULL) )
+                /* The failed attempts may have moved routes, so determine the
+                 * boundaries again. */
+                if ( GetGapBetweenPrefixes(pRouteTable,
+                                           pPrevPrefix,
+                                           pNextPrefix,
+                                           &pFirstSearchSlicePtr,
+                                           &firstSearchRow,
+                                           &pLastSearchSlicePtr,
+                                           &lastSearchRow) )
                 {
-                    /* Try to find an empty row between the last route of the
-                     * previous prefix and the first route of the next prefix. */
-                    if ( FindEmptyRowWithinSliceRange(sw,
-                                                      pFirstSearchSlicePtr,
-                                                      firstSearchRow,
-                                                      pLastSearchSlicePtr,
-                                                      lastSearchRow,
-                                                      optimize,
-                                                      ppDestSlice,
-                                                      pDestRow,
-                                                      NULL,
-                                                      NULL) )
-                    {
-                        /* found an empty row, write route to row */
-                        entryFound = TRUE;
-                        break;
-                    }
-
                     /* Try to create an empty row between the last route of the
                      * previous prefix and the first route of the next prefix. */
                     if ( ClearCascadeRowWithinSliceRange(sw,
@@ -4301,6 +4572,19 @@ static fm_status FindFfuEntryForNewRoute(fm_int                  sw,
             *pDestRow      = -1;
             err = FM_ERR_NO_FFU_RES_FOUND;
         }
+        else if (pRouteTable->stateTable->actualState)
+        {
+            /* Account for the moves made to place this route */
+            moves = pRouteTable->stateTable->tcamRouteMoves - movesBefore;
+
+            pRouteTable->stateTable->tcamRouteInserts++;
+            pRouteTable->stateTable->tcamInsertMoves += moves;
+
+            if (moves > pRouteTable->stateTable->tcamMaxInsertMoves)
+            {
+                pRouteTable->stateTable->tcamMaxInsertMoves = moves;
+            }
+        }
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_ROUTING, err);
@@ -5166,7 +5450,7 @@ static void InsertPrefixCallback(const void *pKey,
 
     pNode = (fm10000_RoutePrefix*)pValue;
 
-    fmCustomTreeInit(&pNode->routeTree, ComparePrefixRoutes);
+    fmCustomTreeInitBtree(&pNode->routeTree, ComparePrefixRoutes);
     fmCustomTreeRequestCallbacks(&pNode->routeTree,
                                  InsertPrefixRouteCallback,
                                  DeletePrefixRouteCallback);
@@ -5447,7 +5731,7 @@ static fm10000_RoutePrefix *AllocatePrefix(fm10000_switch *pSwitchExt,
 
     FM_NOT_USED(pSwitchExt);
 
-    pPrefix = fmAlloc( sizeof(fm10000_RoutePrefix) );
+    pPrefix = fmAllocTagged( sizeof(fm10000_RoutePrefix), FM_LOG_CAT_ROUTING );
 
     if (pPrefix != NULL)
     {
@@ -6079,7 +6363,7 @@ static fm_status AllocateRouteSlice(fm_int                sw,
     if (err == FM_OK)
     {
         /* create a cascade record */
-        slicePtr = fmAlloc( sizeof(fm10000_RouteSlice) );
+        slicePtr = fmAllocTagged( sizeof(fm10000_RouteSlice), FM_LOG_CAT_ROUTING );
 
         if (slicePtr == NULL)
         {
@@ -7472,6 +7756,11 @@ static void FreeTcamRoute(void *pKey,
  *
  * \desc            Copies a new route table structure from an existing
  *                  structure.
+ *                                                                      \lb\lb
+ *                  Routes are copied in TCAM order, so consecutive routes
+ *                  mostly share their slice and prefix. The last slice
+ *                  and prefix looked up are reused, which keeps the cost
+ *                  of a copy close to that of the tree insertions.
  *
  * \param[in]       sw is the switch number.
  *
@@ -7500,14 +7789,14 @@ static fm_status CopyRoutingTable(fm_int                sw,
                                   fm10000_RoutingTable *pClone)
 {
     fm_status               err;
-    fm_customTreeIterator   iter;
     fm10000_RoutePrefix *   routePrefix;
-    fm10000_TcamRouteEntry *tcamRouteKey;
     fm10000_TcamRouteEntry *tcamOldRoute;
     fm10000_TcamRouteEntry *tcamNewRoute;
     fm_int                  index;
     fm10000_RouteSlice *    slicePtr;
     fm10000_RouteSlice *    pTempSlice;
+    fm10000_RouteSlice *    pLastOldSlice;
+    fm10000_RouteSlice *    pLastNewSlice;
     fm_int                  kase;
 
     FM_LOG_ENTRY(FM_LOG_CAT_ROUTING,
@@ -7526,10 +7815,12 @@ static fm_status CopyRoutingTable(fm_int                sw,
     pClone->defaultSliceInfo = pSource->defaultSliceInfo;
 
     /* Initialize tcam route tree "sorted by route" */
-    fmCustomTreeInit(&pClone->tcamRouteRouteTree, fm10000CompareTcamRoutes);
+    fmCustomTreeInitBtree(&pClone->tcamRouteRouteTree,
+                          fm10000CompareTcamRoutes);
 
     /* Initialize tcam route tree "sorted by slice number and row" */
-    fmCustomTreeInit(&pClone->tcamSliceRouteTree, CompareTcamRoutesBySlice);
+    fmCustomTreeInitBtree(&pClone->tcamSliceRouteTree,
+                          CompareTcamRoutesBySlice);
     fmCustomTreeRequestCallbacks(&pClone->tcamSliceRouteTree,
                                  InsertTcamRouteCallback,
                                  DeleteTcamRouteCallback);
@@ -7576,26 +7867,18 @@ static fm_status CopyRoutingTable(fm_int                sw,
         }
     }
 
-    /* Clone all routes from the TCAM source routing table */
-    fmCustomTreeIterInit(&iter, &pSource->tcamRouteRouteTree);
+    /* Clone all routes from the TCAM source routing table, walking the
+     * routes in slice and row order. */
+    pLastOldSlice = NULL;
+    pLastNewSlice = NULL;
+    routePrefix   = NULL;
 
-    while (1)
+    for (tcamOldRoute = pSource->firstTcamRoute ;
+         tcamOldRoute != NULL ;
+         tcamOldRoute = tcamOldRoute->nextTcamRoute)
     {
-        err = fmCustomTreeIterNext(&iter,
-                                      (void **) &tcamRouteKey,
-                                      (void **) &tcamOldRoute);
-
-        if (err != FM_OK)
-        {
-            if (err == FM_ERR_NO_MORE)
-            {
-                break;
-            }
-
-            FM_LOG_EXIT(FM_LOG_CAT_ROUTING, err);
-        }
-
-         tcamNewRoute = fmAlloc( sizeof(fm10000_TcamRouteEntry) );
+         tcamNewRoute = fmAllocTagged( sizeof(fm10000_TcamRouteEntry),
+                                       FM_LOG_CAT_ROUTING );
 
          if (tcamNewRoute == NULL)
          {
@@ -7614,36 +7897,46 @@ static fm_status CopyRoutingTable(fm_int                sw,
          FM_DLL_INIT_NODE(tcamNewRoute, nextTcamRoute, prevTcamRoute);
          FM_DLL_INIT_NODE(tcamNewRoute, nextPrefixRoute, prevPrefixRoute);
 
-         /* Get/create a prefix record */
-         err = GetPrefixRecord(sw,
-                               pClone,
-                               tcamNewRoute->routePtr->prefix,
-                               &routePrefix,
-                               NULL,
-                               NULL);
-
-        if (err != FM_OK)
+        /* Get/create a prefix record, unless it is the previous route's */
+        if ( (routePrefix == NULL)
+            || (routePrefix->prefix != tcamNewRoute->routePtr->prefix) )
         {
-            fmFree(tcamNewRoute);
-            FM_LOG_EXIT(FM_LOG_CAT_ROUTING, err);
+            err = GetPrefixRecord(sw,
+                                  pClone,
+                                  tcamNewRoute->routePtr->prefix,
+                                  &routePrefix,
+                                  NULL,
+                                  NULL);
+
+            if (err != FM_OK)
+            {
+                fmFree(tcamNewRoute);
+                FM_LOG_EXIT(FM_LOG_CAT_ROUTING, err);
+            }
         }
 
         tcamNewRoute->routePrefix = routePrefix;
 
-        slicePtr = NULL;
-
-        for (index = 0 ; index < FM10000_MAX_FFU_SLICES ; index++)
+        /* A route slice is entered in the cross-reference under each of
+         * its TCAM slices, so only the first one needs to be searched. */
+        if (tcamOldRoute->routeSlice != pLastOldSlice)
         {
+            pLastOldSlice = tcamOldRoute->routeSlice;
+            pLastNewSlice = NULL;
+            index         = pLastOldSlice->firstTcamSlice;
+
             for (kase = 0 ; kase < FM10000_ROUTE_NUM_CASES ; kase++)
             {
-                if (pRouteSliceXref[index][kase][0] == tcamOldRoute->routeSlice)
+                if (pRouteSliceXref[index][kase][0] == pLastOldSlice)
                 {
-                    slicePtr = pRouteSliceXref[index][kase][1];
+                    pLastNewSlice = pRouteSliceXref[index][kase][1];
                     break;
                 }
             }
         }
 
+        slicePtr = pLastNewSlice;
+
         if (slicePtr == NULL)
         {
             fmFree(tcamNewRoute);
@@ -7842,7 +8135,7 @@ static fm_status CloneRoutingState(fm_int                 sw,
     {
         FM_CLEAR(routeSliceXref);
 
-        newState = fmAlloc( sizeof(fm10000_RoutingState) );
+        newState = fmAllocTagged( sizeof(fm10000_RoutingState), FM_LOG_CAT_ROUTING );
 
         if (newState == NULL)
         {
@@ -7893,7 +8186,8 @@ static fm_status CloneRoutingState(fm_int                 sw,
                     if ( (srcRouteSlice != NULL)
                          && (routeSliceXref[index][kase][0] == NULL) )
                     {
-                        pNewRouteSlice = fmAlloc( sizeof(fm10000_RouteSlice) );
+                        pNewRouteSlice = fmAllocTagged( sizeof(fm10000_RouteSlice),
+                                                        FM_LOG_CAT_ROUTING );
 
                         if (pNewRouteSlice == NULL)
                         {
@@ -9343,6 +9637,115 @@ static fm_status SetVirtualRouterMacRegisters(fm_int         sw,
 
 
 
+/*****************************************************************************/
+/** CompactRouteSlice
+ * \ingroup intRouter
+ *
+ * \desc            Slides the routes of a route slice up toward its highest
+ *                  row, closing the free rows left between them. Routes keep
+ *                  their relative order, so route precedence is unchanged.
+ *                  Rows used by other cascades sharing the TCAM slices are
+ *                  never crossed.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       pRouteSlice points to the route slice to compact.
+ *
+ * \param[in,out]   budget points to the number of routes that may still be
+ *                  moved. It is decremented for each route moved.
+ *
+ * \param[in,out]   numMoved points to the count of routes moved. It is
+ *                  incremented for each route moved.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if a route could not be moved.
+ *
+ *****************************************************************************/
+static fm_status CompactRouteSlice(fm_int              sw,
+                                   fm10000_RouteSlice *pRouteSlice,
+                                   fm_int *            budget,
+                                   fm_int *            numMoved)
+{
+    fm_status               err;
+    fm10000_switch *        pSwitchExt;
+    fm10000_RoutingState *  pStateTable;
+    fm10000_RouteTcamSlice *pTcamSlice;
+    fm10000_TcamRouteEntry *pRouteEntry;
+    fm_int                  row;
+    fm_int                  destRow;
+    fm_int                  tcamSlice;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ROUTING,
+                 "sw=%d, pRouteSlice=%p (%d-%d), budget=%d\n",
+                 sw,
+                 (void *) pRouteSlice,
+                 pRouteSlice->firstTcamSlice,
+                 pRouteSlice->lastTcamSlice,
+                 *budget);
+
+    err        = FM_OK;
+    pSwitchExt = GET_SWITCH_EXT(sw);
+    pStateTable = (pRouteSlice->stateTable != NULL) ? pRouteSlice->stateTable : &pSwitchExt->routeStateTable;
+    destRow    = -1;
+
+    for (row = FM10000_FFU_ENTRIES_PER_SLICE - 1 ; (row >= 0) && (*budget > 0) ; row--)
+    {
+        pRouteEntry = pRouteSlice->routes[row];
+
+        if (pRouteEntry == NULL)
+        {
+            for (tcamSlice  = pRouteSlice->firstTcamSlice ;
+                 tcamSlice <= pRouteSlice->lastTcamSlice ;
+                 tcamSlice++)
+            {
+                pTcamSlice = GetTcamSlicePtr(sw, pStateTable, tcamSlice);
+
+                if (pTcamSlice->rowStatus[row] != FM10000_ROUTE_ROW_FREE)
+                {
+                    break;
+                }
+            }
+
+            if (tcamSlice > pRouteSlice->lastTcamSlice)
+            {
+                /* Free row, the highest one seen since the last used row
+                 * is where the next route goes. */
+                if (destRow < 0)
+                {
+                    destRow = row;
+                }
+            }
+            else
+            {
+                /* Row used by another cascade, routes can't cross it. */
+                destRow = -1;
+            }
+        }
+        else if (destRow >= 0)
+        {
+            if ( !MoveRoute(sw, pRouteEntry, pRouteSlice, destRow) )
+            {
+                err = FM_FAIL;
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
+            }
+
+            (*budget)--;
+            (*numMoved)++;
+
+            /* Every row from destRow down to the one just vacated is free. */
+            destRow--;
+        }
+    }
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_ROUTING, err);
+
+}   /* end CompactRouteSlice */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -9970,11 +10373,13 @@ fm_status fm10000AddRoute(fm_int            sw,
                             TRUE);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
 
+#ifdef FM10000_DBG_TRACK_ROUTE_CONTENTS
     /* Store the final FFU action structure into the route */
     FM_MEMCPY_S( &tcamRoute->ffuAction,
                  sizeof(tcamRoute->ffuAction),
                  &ffuAction,
                  sizeof(ffuAction) );
+#endif
 
     if ( !UpdateTcamRoutePosition(sw,
                                   tcamRoute,
@@ -10554,6 +10959,7 @@ fm_status fm10000UpdateEcmpRoutes(fm_int       sw,
                                   fm_int       pathCountType)
 {
     fm_status               err;
+    fm_status               flushErr;
     fm_switch *             switchPtr;
     fm_intEcmpGroup *       parent;
     fm_customTreeIterator   iter;
@@ -10587,6 +10993,14 @@ fm_status fm10000UpdateEcmpRoutes(fm_int       sw,
     }
     else
     {
+        /* Queue the rule updates so they are written per slice. */
+        err = fm10000StartFFUWriteQueue(sw);
+
+        if (err != FM_OK)
+        {
+            FM_LOG_EXIT(FM_LOG_CAT_ROUTING, err);
+        }
+
         fmCustomTreeIterInit(&iter, &parent->routeTree);
 
         while (1)
@@ -10609,7 +11023,8 @@ fm_status fm10000UpdateEcmpRoutes(fm_int       sw,
 
             if (routeTable == NULL)
             {
-                FM_LOG_EXIT(FM_LOG_CAT_ROUTING, FM_ERR_INVALID_ARGUMENT);
+                err = FM_ERR_INVALID_ARGUMENT;
+                break;
             }
 
             /* Try to find the TCAM route in the table */
@@ -10622,7 +11037,7 @@ fm_status fm10000UpdateEcmpRoutes(fm_int       sw,
 
             if (err != FM_OK)
             {
-                FM_LOG_EXIT(FM_LOG_CAT_ROUTING, err);
+                break;
             }
 
             if ( (tcamRoute->routeSlice != NULL) && (tcamRoute->tcamSliceRow >= 0) )
@@ -10639,7 +11054,7 @@ fm_status fm10000UpdateEcmpRoutes(fm_int       sw,
 
                 if (err != FM_OK)
                 {
-                    FM_LOG_EXIT(FM_LOG_CAT_ROUTING, err);
+                    break;
                 }
 
                 newValid = valid;
@@ -10686,13 +11101,22 @@ fm_status fm10000UpdateEcmpRoutes(fm_int       sw,
 
                     if (err != FM_OK)
                     {
-                        FM_LOG_EXIT(FM_LOG_CAT_ROUTING, err);
+                        break;
                     }
 
                     tcamRoute->dirty = FALSE;
                 }
             }
         }
+
+        flushErr = fm10000FlushFFUWriteQueue(sw);
+
+        if (err == FM_OK)
+        {
+            err = flushErr;
+        }
+
+        FM_LOG_EXIT(FM_LOG_CAT_ROUTING, err);
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_ROUTING, FM_OK);
@@ -10783,11 +11207,250 @@ void fm10000DbgDumpRouteStats(fm_int sw)
     FM_LOG_PRINT("    TCAM slices in use = %d.\n",
                  sliceCount);
 
+    FM_LOG_PRINT("    TCAM route placements = %" FM_FORMAT_64 "u, "
+                 "moves = %" FM_FORMAT_64 "u (for placements %" FM_FORMAT_64 "u, "
+                 "max per placement %" FM_FORMAT_64 "u)\n",
+                 pSwitchExt->routeStateTable.tcamRouteInserts,
+                 pSwitchExt->routeStateTable.tcamRouteMoves,
+                 pSwitchExt->routeStateTable.tcamInsertMoves,
+                 pSwitchExt->routeStateTable.tcamMaxInsertMoves);
+
 }   /* end fm10000DbgDumpRouteStats */
 
 
 
 
+/*****************************************************************************/
+/** fm10000GetRouteMoveCount
+ * \ingroup intRouter
+ *
+ * \desc            Returns the number of routes moved from one FFU row to
+ *                  another since the switch came up.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      moveCount points to caller-allocated storage where this
+ *                  function should place the number of moves.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if moveCount is NULL.
+ *
+ *****************************************************************************/
+fm_status fm10000GetRouteMoveCount(fm_int sw, fm_uint64 *moveCount)
+{
+    fm10000_switch *switchExt;
+
+    if (moveCount == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    switchExt  = GET_SWITCH_EXT(sw);
+    *moveCount = switchExt->routeStateTable.tcamRouteMoves;
+
+    return FM_OK;
+
+}   /* end fm10000GetRouteMoveCount */
+
+
+
+
+/*****************************************************************************/
+/** fm10000GetRouteMemoryUsage
+ * \ingroup intRouter
+ *
+ * \desc            Returns the number of bytes used by the FM10000 route
+ *                  records: TCAM route entries, prefix records and the
+ *                  trees that index them. The caller must take the
+ *                  routing lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      bytes points to caller-allocated storage where this
+ *                  function should place the number of bytes.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if bytes is NULL.
+ *
+ *****************************************************************************/
+fm_status fm10000GetRouteMemoryUsage(fm_int sw, fm_uint64 *bytes)
+{
+    fm10000_RoutingTable * routeTable;
+    fm10000_RoutePrefix *  prefixPtr;
+    fm_customTreeIterator  iter;
+    fm_int                 route;
+    fm_uint64              total;
+    fm_status              err;
+    void *                 key;
+
+    if (bytes == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    total = 0;
+
+    for (route = 0 ; RouteTypes[route] != FM10000_NUM_ROUTE_TYPES ; route++)
+    {
+        if (RouteTypes[route] == FM10000_ROUTE_TYPE_UNUSED)
+        {
+            continue;
+        }
+
+        routeTable = GetRouteTable(sw, RouteTypes[route]);
+
+        if (routeTable == NULL)
+        {
+            continue;
+        }
+
+        total += (fm_uint64) fmCustomTreeSize(&routeTable->tcamRouteRouteTree) *
+                 sizeof(fm10000_TcamRouteEntry);
+        total += fmCustomTreeMemoryUsage(&routeTable->tcamRouteRouteTree);
+        total += fmCustomTreeMemoryUsage(&routeTable->tcamSliceRouteTree);
+        total += fmCustomTreeMemoryUsage(&routeTable->prefixTree);
+
+        fmCustomTreeIterInit(&iter, &routeTable->prefixTree);
+
+        while (1)
+        {
+            err = fmCustomTreeIterNext(&iter, &key, (void **) &prefixPtr);
+            if (err != FM_OK)
+            {
+                break;
+            }
+
+            total += sizeof(fm10000_RoutePrefix);
+            total += fmCustomTreeMemoryUsage(&prefixPtr->routeTree);
+        }
+    }
+
+    *bytes = total;
+
+    return FM_OK;
+
+}   /* end fm10000GetRouteMemoryUsage */
+
+
+
+
+/*****************************************************************************/
+/** fm10000GetRouteFFUSliceRows
+ * \ingroup intRouter
+ *
+ * \desc            Marks the FFU rows of a TCAM slice that are used or
+ *                  reserved by the routing subsystem. The caller must take
+ *                  the routing lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       slice is the FFU slice to report.
+ *
+ * \param[in,out]   usedRows points to a cleared bitmap of
+ *                  FM10000_FFU_ENTRIES_PER_SLICE bits in which each used row
+ *                  is set.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SLICE if slice is out of range.
+ *
+ *****************************************************************************/
+fm_status fm10000GetRouteFFUSliceRows(fm_int     sw,
+                                      fm_int     slice,
+                                      fm_uint64 *usedRows)
+{
+    fm10000_RouteTcamSlice *pTcamSlice;
+    fm_int                  row;
+
+    if ( (slice < 0) || (slice >= FM10000_MAX_FFU_SLICES) )
+    {
+        return FM_ERR_INVALID_SLICE;
+    }
+
+    pTcamSlice = GetTcamSlicePtr(sw, NULL, slice);
+
+    for (row = 0 ; row < FM10000_FFU_ENTRIES_PER_SLICE ; row++)
+    {
+        if (pTcamSlice->rowStatus[row] != FM10000_ROUTE_ROW_FREE)
+        {
+            usedRows[row / 64] |= FM_LITERAL_U64(1) << (row % 64);
+        }
+    }
+
+    return FM_OK;
+
+}   /* end fm10000GetRouteFFUSliceRows */
+
+
+
+
+/*****************************************************************************/
+/** fm10000DefragmentRouteFFU
+ * \ingroup intRouter
+ *
+ * \desc            Compacts the routes of every route slice toward the top
+ *                  of the slice so that the free rows merge into one block
+ *                  below the routes. The caller must take the routing lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       budget is the maximum number of routes to move.
+ *
+ * \param[out]      numMoved points to caller-allocated storage where this
+ *                  function places the number of routes moved.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if a route could not be moved.
+ *
+ *****************************************************************************/
+fm_status fm10000DefragmentRouteFFU(fm_int  sw,
+                                    fm_int  budget,
+                                    fm_int *numMoved)
+{
+    fm_status             err;
+    fm10000_switch *      pSwitchExt;
+    fm10000_RoutingTable *pRouteTable;
+    fm10000_RouteSlice *  pRouteSlice;
+    fm_int                routeType;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ROUTING,
+                 "sw=%d, budget=%d, numMoved=%p\n",
+                 sw,
+                 budget,
+                 (void *) numMoved);
+
+    err        = FM_OK;
+    pSwitchExt = GET_SWITCH_EXT(sw);
+    *numMoved  = 0;
+
+    for (routeType = 0 ;
+         (routeType < FM10000_NUM_ROUTE_TYPES) && (budget > 0) ;
+         routeType++)
+    {
+        pRouteTable = pSwitchExt->routeStateTable.routeTables[routeType];
+
+        if (pRouteTable == NULL)
+        {
+            continue;
+        }
+
+        for (pRouteSlice = GetFirstSlice(pRouteTable) ;
+             (pRouteSlice != NULL) && (budget > 0) ;
+             pRouteSlice = GetNextSlice(pRouteSlice))
+        {
+            err = CompactRouteSlice(sw, pRouteSlice, &budget, numMoved);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
+        }
+    }
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_ROUTING, err);
+
+}   /* end fm10000DefragmentRouteFFU */
+
+
+
+
 /*****************************************************************************/
 /** fm10000DbgDumpStateTable
  * \ingroup intDebug
@@ -12584,11 +13247,13 @@ fm_status fm10000SetRouteAction(fm_int            sw,
                             TRUE);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
 
+#ifdef FM10000_DBG_TRACK_ROUTE_CONTENTS
     /* Store the final FFU action structure into the route */
     FM_MEMCPY_S( &tcamRoute->ffuAction,
                  sizeof(tcamRoute->ffuAction),
                  &ffuAction,
                  sizeof(ffuAction) );
+#endif
 
     if (foundRow)
     {
@@ -3735,450 +3735,769 @@ ABORT:
 
 
 
-/*****************************************************************************
- * Public Functions
- *****************************************************************************/
-
-
-
-
 /*****************************************************************************/
-/** fm10000InitScheduler
+/** BuildTmpSchedule
  * \ingroup intSwitch
  *
- * \desc            Initializes the scheduler.
+ * \desc            Generates the temporary schedule from the reserved
+ *                  speed of each physical port. The temporary structure
+ *                  must already hold a copy of the active configuration.
  * 
  * \param[in]       sw is the switch on which to operate.
  * 
  * \return          FM_OK if successful.
+ * \return          FM_ERR_SCHED_OVERSUBSCRIBED if the frequency of
+ *                  the chip is not high enough, resulting in oversuscription. 
+ * \return          FM_ERR_SCHED_VIOLATION if the schedule could not be
+ *                  generated because a violation was detected. 
  *
  *****************************************************************************/
-fm_status fm10000InitScheduler(fm_int sw)
+static fm_status BuildTmpSchedule(fm_int sw)
 {
-    fm_status          err = FM_OK;
-    fm10000_switch *   switchExt;
-    fm10000_schedInfo *sInfo;
-    fm_schedulerConfig sc;
-    fm_int             i;
-    fm_text            schedModeStr;
-    fm_int             fabricPort;
-    
-    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw = %d\n", sw);
+    fm_status           err = FM_OK;
+    fm10000_switch *    switchExt;
+    fm10000_schedInfo  *sInfo;
+    fm_int              i;
+    fm_int              j;
+    fm_int              slots100G;
+    fm_int              slots60G;
+    fm_int              slots40G;
+    fm_int              slots25G;
+    fm_int              slots10G;
+    fm_int              slots2500M;
+    fm_int              slotsIdle;
+    fm_schedulerToken  *sToken;
+    fm_uint64           logCat;
+    fm_uint64           logLvl;
+    fm_int              physPort;
+    fm_int              fabricPort;
+    fm_int              spare25GSlots;
 
-    TAKE_SCHEDULER_LOCK(sw);
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw = %d\n", sw);
 
     switchExt = GET_SWITCH_EXT(sw);
     sInfo     = &switchExt->schedInfo;
 
-    err = InitializeFreeLists(sw);
+    /* Initialize Internal Structures */
+    err = fmCreateBitArray(&sInfo->tmp.p2500M, FM10000_NUM_PORTS);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    err = fmCreateBitArray(&sInfo->tmp.p10G, FM10000_NUM_PORTS);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    err = fmCreateBitArray(&sInfo->tmp.p25G, FM10000_NUM_PORTS);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    err = fmCreateBitArray(&sInfo->tmp.p40G, FM10000_NUM_PORTS);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    err = fmCreateBitArray(&sInfo->tmp.p60G, FM10000_NUM_PORTS);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    err = fmCreateBitArray(&sInfo->tmp.p100G, FM10000_NUM_PORTS);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
-    schedModeStr = GET_FM10000_PROPERTY()->schedMode;
+    /*********************************************
+     * Sort all ports into speed bins 
+     *********************************************/
 
-    sInfo->attr.updateLnkChange = GET_FM10000_PROPERTY()->updateSchedOnLinkChange;
+    for (i = 0; i < FM10000_SCHED_NUM_PORTS; i++) 
+    {
+        if (sInfo->physicalToFabricMap[i] == -1)
+        {
+            continue;
+        }
 
-    if (strcmp(schedModeStr, "static") == 0)
+        fabricPort = sInfo->physicalToFabricMap[i];
+
+        sInfo->tmp.physPortSpeed[i] = sInfo->reservedSpeed[i];
+        sInfo->tmp.fabricPortSpeed[fabricPort] = sInfo->tmp.physPortSpeed[i];
+
+        switch (sInfo->tmp.physPortSpeed[i])
+        {
+            case FM10000_SCHED_SPEED_IDLE:
+                break;
+
+            case FM10000_SCHED_SPEED_2500M:
+                err = fmSetBitArrayBit(&sInfo->tmp.p2500M, i, 1);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+                break;
+
+            case FM10000_SCHED_SPEED_10G:
+                err = fmSetBitArrayBit(&sInfo->tmp.p10G, i, 1);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+                break;
+
+            case FM10000_SCHED_SPEED_25G:
+                err = fmSetBitArrayBit(&sInfo->tmp.p25G, i, 1);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+                break;
+
+            case FM10000_SCHED_SPEED_40G:
+                err = fmSetBitArrayBit(&sInfo->tmp.p40G, i, 1);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+                break;
+
+            case FM10000_SCHED_SPEED_60G:
+                err = fmSetBitArrayBit(&sInfo->tmp.p60G, i, 1);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+                break;
+
+            case FM10000_SCHED_SPEED_100G:
+                err = fmSetBitArrayBit(&sInfo->tmp.p100G, i, 1);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+                break;
+
+            default:
+                err = FM_ERR_SCHED_VIOLATION;
+                FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
+                             "Invalid Speed for entry: physPort=%d speed=%d\n",
+                             i,
+                             sInfo->tmp.physPortSpeed[i]);
+                goto ABORT;
+                break;
+        }
+    }
+        
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 100G Ports", GetNbPorts(&sInfo->tmp.p100G) );
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 60G Ports", GetNbPorts(&sInfo->tmp.p60G) );
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 40G Ports", GetNbPorts(&sInfo->tmp.p40G) );
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 25G Ports", GetNbPorts(&sInfo->tmp.p25G) );
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 10G Ports", GetNbPorts(&sInfo->tmp.p10G) );
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 2.5G Ports", GetNbPorts(&sInfo->tmp.p2500M) );
+
+    /*********************************************
+     * Validate that the frequency is sufficiently
+     * high to support 100G and 40G ports
+     *********************************************/
+    if ( GetNbPorts(&sInfo->tmp.p100G) &&
+         (sInfo->tmp.schedLen < (MIN_PORT_SPACING * SLOTS_PER_100G) ) )
     {
-        sInfo->attr.mode = FM10000_SCHED_MODE_STATIC;
+        err = FM_ERR_SCHED_OVERSUBSCRIBED;
+        FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
+                     "freq not high enough to support 100G w/4-cycle spacing\n");
+        goto ABORT;
     }
-    else if (strcmp(schedModeStr, "dynamic") == 0)
+
+    if ( GetNbPorts(&sInfo->tmp.p60G) &&
+         (sInfo->tmp.schedLen < (MIN_PORT_SPACING * SLOTS_PER_60G) ) )
     {
-        sInfo->attr.mode = FM10000_SCHED_MODE_DYNAMIC;
+        err = FM_ERR_SCHED_OVERSUBSCRIBED;
+        FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
+                     "freq not high enough to support 60G w/4-cycle spacing\n");
+        goto ABORT;
     }
-    else
+
+    if ( GetNbPorts(&sInfo->tmp.p40G) &&
+         (sInfo->tmp.schedLen < (MIN_PORT_SPACING * SLOTS_PER_40G) ) )
     {
-        FM_LOG_ERROR(FM_LOG_CAT_SWITCH, 
-                     "%s is not a valid scheduler mode\n", 
-                     schedModeStr);
-        err = FM_FAIL;
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+        err = FM_ERR_SCHED_OVERSUBSCRIBED;
+        FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
+                     "freq not high enough to support 40G w/4-cycle spacing\n");
+        goto ABORT;
     }
 
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, 
-                 "Scheduler Mode = %s (%d), updateLnkChange = %d\n", 
-                 schedModeStr, 
-                 sInfo->attr.mode,
-                 sInfo->attr.updateLnkChange);
+    /*********************************************
+     * Compute number of slots required per 
+     * speed bin. 
+     ********************************************/
+    slots100G   = GetNbPorts(&sInfo->tmp.p100G)  * SLOTS_PER_100G;
+    slots60G    = GetNbPorts(&sInfo->tmp.p60G)   * SLOTS_PER_60G;
+    slots40G    = GetNbPorts(&sInfo->tmp.p40G)   * SLOTS_PER_40G;
+    slots25G    = GetNbPorts(&sInfo->tmp.p25G)   * SLOTS_PER_25G;
+    slots10G    = GetNbPorts(&sInfo->tmp.p10G)   * SLOTS_PER_10G;
+    slots2500M  = GetNbPorts(&sInfo->tmp.p2500M) * SLOTS_PER_2500M;
+    slotsIdle   = sInfo->tmp.schedLen - slots100G - slots60G - slots40G - slots25G - slots10G - slots2500M;
     
-    err = fmPlatformGetSchedulerConfig(sw, &sc);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 100G Slots", slots100G);
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 60G Slots", slots60G);
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 40G Slots", slots40G);
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 25G Slots", slots25G);
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 10G Slots", slots10G);
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 2.5G Slots", slots2500M);
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number Idle Slots", slotsIdle);
 
-    switch ( sc.mode )
+    if (slotsIdle <= 0)
     {
-        case FM_SCHED_INIT_MODE_NONE:
-            /* If the scheduler config mode is none, let the platform code 
-             * initialize the scheduler */
-            err = FM_OK;
-            goto ABORT;
+        err = FM_ERR_SCHED_OVERSUBSCRIBED;
+        FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
+                     "Oversubscribed schedule, minimum of 1 idle slot needed\n");
+        FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
+                     "Requested %d slots (%.1fG), but only %d are available (%.1fG)\n",
+                     slots100G + slots60G + slots40G + slots25G + slots10G + slots2500M + 1,
+                     ((slots100G + slots60G + slots40G + slots25G + slots10G + slots2500M + 1) * (fm_float)(SLOT_SPEED)),
+                     sInfo->tmp.schedLen,
+                     (sInfo->tmp.schedLen * (fm_float)(SLOT_SPEED)));
+        goto ABORT;
+    }
 
-        case FM_SCHED_INIT_MODE_AUTOMATIC:
+    err = GetNumSpare25GSlots(sw, slotsIdle, &spare25GSlots);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
-            FM_CLEAR(sInfo->tmp);
+    slots25G  += spare25GSlots;
+    slotsIdle -= spare25GSlots;
+    sInfo->tmp.spare25GSlots = spare25GSlots;
 
-            /* Validate sc->nbPorts */    
-            FM_LOG_ABORT_ON_ASSERT(FM_LOG_CAT_SWITCH, 
-                           sc.nbPorts <= FM10000_SCHED_MAX_NUM_PORTS, 
-                           err = FM_FAIL,
-                           "Number of ports exceeded (%d > %d)\n",
-                           sc.nbPorts,
-                           FM10000_SCHED_MAX_NUM_PORTS);
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "Spare 25G Slots allocated: %d\n", spare25GSlots);
 
-            /* Copy the portlist locally, so that the API can update it
-             * as needed */
-            for (i = 0; i < sc.nbPorts; i++)
-            {
-                sInfo->tmp.portList[i] = sc.portList[i];
-            }
+    /*********************************************
+     * Split the bandwidth by populating the slots 
+     * with port speeds
+     *********************************************/
+    err = PopulateSpeedList(sw, slots100G, slots60G, slots40G, slots25G, slots10G, slots2500M, slotsIdle );
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
-            /* In dynamic mode, ignore any speed assigned to ethernet ports
-             * as those will be generated on the fly. */
-            if (sInfo->attr.mode == FM10000_SCHED_MODE_DYNAMIC)
-            {
-                for (i = 0; i < sc.nbPorts; i++)
-                {
-                    fabricPort = sInfo->tmp.portList[i].fabricPort;
 
-                    if ( (fabricPort >= FM10000_FIRST_EPL_FABRIC_PORT) && 
-                         (fabricPort <= FM10000_LAST_EPL_FABRIC_PORT) )
-                    {
-                        sInfo->tmp.portList[i].speed = 0;
-                    }
-                }
-            }
+    /*********************************************
+     * Need to find the first idle token, this 
+     * will be our implicit idle and it does not
+     * need to be added to the schedule 
+     *********************************************/
+    err = RotateSchedule(sw);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
-            sInfo->tmp.nbPorts = sc.nbPorts;
 
-            /*********************************************
-             * Generate the physical to fabric port 
-             * mapping and its reverse
-             *********************************************/
-            err = GeneratePortMappingTables(sw);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    /*********************************************
+     * Sort the ports by the difficulty level 
+     * of placing them in the schedule.
+     *********************************************/
+    err = SortPortsByDifficulty(sw);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
-            err = GenerateSchedule(sw);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    
+    /*********************************************
+     * We have the speed bins, fill them with 
+     * ports
+     *********************************************/
+    FM_CLEAR(sInfo->tmp.schedList);
+    for (i = 0; i < sInfo->tmp.schedLen; i++)
+    {
+        /* Mark all ports as invalid */
+        sInfo->tmp.schedList[i].port = -1;
+    }
 
-            err = GenerateQpcState(sw, 
-                                   sInfo->tmp.schedList, 
-                                   sInfo->tmp.schedLen, 
-                                   TRUE);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    err = AssignPortsByDifficulty(sw);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
-            for (i = 0; i < FM10000_SCHED_NUM_PORTS; i++)
+    /* Assign Idle Tokens */
+    for (i = 0; i < sInfo->tmp.schedLen; i++)
+    {
+        sToken = &sInfo->tmp.schedList[i];
+        if ( sInfo->tmp.speedList[i] == FM10000_SCHED_SPEED_IDLE )
+        {
+            sToken->port        = 0;
+            sToken->fabricPort  = 0;
+            sToken->quad        = 0;
+            sToken->idle        = 1;
+        }
+        else if ( (sInfo->tmp.speedList[i] == FM10000_SCHED_SPEED_25G) &&
+                  (sToken->port            == -1) ) 
+        {
+            sInfo->tmp.speedList[i] = FM10000_SCHED_SPEED_IDLE;
+            sToken->port        = 0;
+            sToken->fabricPort  = 0;
+            sToken->quad        = 0;
+            sToken->idle        = 1;
+        }
+    }
+
+    /* Fill in the fabricPort, Quad, and Idle fields per portList entries */
+    for (i = 0; i < sInfo->tmp.nbPorts; i++)
+    {
+        physPort = sInfo->tmp.portList[i].physPort;
+
+        for (j = 0; j < sInfo->tmp.schedLen; j++)
+        {
+            if ( (physPort == sInfo->tmp.schedList[j].port) &&
+                 (sInfo->tmp.schedList[j].idle == 0) )
             {
-                fabricPort = sInfo->physicalToFabricMap[i];
+                sInfo->tmp.schedList[j].fabricPort = sInfo->tmp.portList[i].fabricPort;
+                sInfo->tmp.schedList[j].quad       = sInfo->reservedQuad[physPort];
+                sInfo->tmp.schedList[j].idle       = 0;
 
-                if ( (fabricPort >= FM10000_FIRST_EPL_FABRIC_PORT) && 
-                     (fabricPort <= FM10000_LAST_EPL_FABRIC_PORT) )
+                /* If the entry is quad, force channel 0 (required for cases
+                 * where lane-reversal is used). */
+                if (sInfo->tmp.schedList[j].quad)
                 {
-                    /* skip, let port API to handle the reservation */
-                    continue;
+                    sInfo->tmp.schedList[j].fabricPort = 
+                        (sInfo->tmp.schedList[j].fabricPort / 4) * 4;
                 }
-
-                sInfo->preReservedSpeed[i] = sInfo->tmp.physPortSpeed[i];
-                sInfo->preReservedQuad[i]  = sInfo->tmp.isQuad[i];
-
-                sInfo->reservedSpeed[i]    = sInfo->preReservedSpeed[i];
-                sInfo->reservedQuad[i]     = sInfo->preReservedQuad[i];
             }
+        }
+    }
 
-            err = fm10000SetSchedRing(sw, 
-                                      FM10000_SCHED_RING_ALL, 
-                                      sInfo->tmp.schedList,
-                                      sInfo->tmp.schedLen);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    fmGetLoggingAttribute(FM_LOG_ATTR_CATEGORY_MASK, 
+                          0, 
+                          (void *) &logCat);
+    fmGetLoggingAttribute(FM_LOG_ATTR_LEVEL_MASK, 
+                          0, 
+                          (void *) &logLvl);
+    
+    if ( (logCat & FM_LOG_CAT_SWITCH) &&
+         (logLvl & FM_LOG_LEVEL_DEBUG) )
+    {
+        DbgDumpSchedulerConfig(sw, TMP_SCHEDULE, FALSE);
+    }
 
-            /* We have succeeded, store the scheduler state into the active
-             * structure */
-            FM_MEMCPY_S(&sInfo->active, 
-                        sizeof(sInfo->active), 
-                        &sInfo->tmp, 
-                        sizeof(sInfo->tmp) );
-            break;
+    err = CalcStats(sw);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
-        case FM_SCHED_INIT_MODE_MANUAL:
-            /* Not supported yet */
-            err = FM_FAIL;
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    }
+    err = ValidateSchedule(sw);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
 ABORT:
-    DROP_SCHEDULER_LOCK(sw);
+    
+    /* Delete Internal BitArrays */
+    fmDeleteBitArray(&sInfo->tmp.p2500M);
+    fmDeleteBitArray(&sInfo->tmp.p10G);
+    fmDeleteBitArray(&sInfo->tmp.p25G);
+    fmDeleteBitArray(&sInfo->tmp.p40G);
+    fmDeleteBitArray(&sInfo->tmp.p60G);
+    fmDeleteBitArray(&sInfo->tmp.p100G);
 
     FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
 
-}   /* end fm10000InitScheduler */
+}   /* end BuildTmpSchedule */
 
 
 
 
 /*****************************************************************************/
-/** fm10000FreeSchedulerResources
+/** FindSchedProfile
  * \ingroup intSwitch
  *
- * \desc            Free's resources allocated during init/generation
+ * \desc            Looks up a previously generated schedule for the current
+ *                  schedule length and reserved port speeds.
  * 
- * \param[in]       sw is the switch on which to operate.
+ * \param[in]       sInfo points to the scheduler state.
  * 
- * \return          FM_OK if successful.
+ * \return          Pointer to the cached profile, NULL if none matches.
  *
  *****************************************************************************/
-fm_status fm10000FreeSchedulerResources(fm_int sw)
+static fm10000_schedProfile *FindSchedProfile(fm10000_schedInfo *sInfo)
 {
-    fm_status           err = FM_OK;
-    fm10000_switch *    switchExt;
-    fm10000_schedInfo  *sInfo;
-    fm_int              i;
+    fm10000_schedProfile *profile;
+    fm_int                i;
 
-    switchExt = GET_SWITCH_EXT(sw);
-    sInfo     = &switchExt->schedInfo;
-
-    if (fmTreeIsInitialized(&sInfo->speedStatsTree))
+    if (sInfo->profileCache == NULL)
     {
-        fmTreeDestroy(&sInfo->speedStatsTree, FreeStatEntry); 
-        fmTreeDestroy(&sInfo->qpcStatsTree, FreeStatEntry);
-        fmTreeDestroy(&sInfo->portStatsTree, FreeStatEntry);
+        return NULL;
     }
 
-    for (i = 0; i < FM10000_NUM_QPC; i++)
+    for (i = 0 ; i < FM10000_SCHED_PROFILE_CACHE_SIZE ; i++)
     {
-        if (fmTreeIsInitialized(&sInfo->qpcState[i]))
+        profile = &sInfo->profileCache[i];
+
+        if ( profile->valid &&
+             (profile->schedLen == sInfo->tmp.schedLen) &&
+             (memcmp(profile->reservedSpeed,
+                     sInfo->reservedSpeed,
+                     sizeof(profile->reservedSpeed)) == 0) &&
+             (memcmp(profile->reservedQuad,
+                     sInfo->reservedQuad,
+                     sizeof(profile->reservedQuad)) == 0) )
         {
-            fmTreeDestroy(&sInfo->qpcState[i], FreeSchedEntryInfo);
+            return profile;
         }
     }
 
-    return err;
+    return NULL;
 
-}   /* end fm10000FreeSchedulerResources */
+}   /* end FindSchedProfile */
 
 
 
 
 /*****************************************************************************/
-/** fm10000MapPhysicalPortToFabricPort
+/** LoadSchedProfile
  * \ingroup intSwitch
  *
- * \desc            Maps a physical port to a fabric port.
- * 
- * \param[in]       sw is the switch on which to operate.
+ * \desc            Copies a cached schedule into the temporary scheduler
+ *                  structure.
  * 
- * \param[in]       physPort is the physical port to convert.
+ * \param[in,out]   sInfo points to the scheduler state.
  * 
- * \param[out]      fabricPort is a pointer to the caller allocated storage
- *                  where this function should store the associated fabric port.
+ * \param[in,out]   profile points to the cached profile to load.
  * 
- * \return          FM_OK if successful.
- * \return          FM_ERR_INVALID_PORT if the physical port is not tied to a
- *                  fabric port.
+ * \return          None.
  *
  *****************************************************************************/
-fm_status fm10000MapPhysicalPortToFabricPort(fm_int  sw, 
-                                             fm_int  physPort, 
-                                             fm_int *fabricPort)
+static void LoadSchedProfile(fm10000_schedInfo    *sInfo,
+                             fm10000_schedProfile *profile)
 {
-    fm_status          err = FM_OK;
-    fm10000_switch *   switchExt;
-    fm10000_schedInfo *sInfo;
-    
-    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH, "sw = %d, physPort = %d\n", sw, physPort);
+    FM_MEMCPY_S(sInfo->tmp.physPortSpeed,
+                sizeof(sInfo->tmp.physPortSpeed),
+                profile->physPortSpeed,
+                sizeof(profile->physPortSpeed));
+    FM_MEMCPY_S(sInfo->tmp.fabricPortSpeed,
+                sizeof(sInfo->tmp.fabricPortSpeed),
+                profile->fabricPortSpeed,
+                sizeof(profile->fabricPortSpeed));
+    FM_MEMCPY_S(sInfo->tmp.diffTable,
+                sizeof(sInfo->tmp.diffTable),
+                profile->diffTable,
+                sizeof(profile->diffTable));
+    FM_MEMCPY_S(sInfo->tmp.schedList,
+                sizeof(sInfo->tmp.schedList),
+                profile->schedList,
+                sizeof(profile->schedList));
+    FM_MEMCPY_S(sInfo->tmp.speedList,
+                sizeof(sInfo->tmp.speedList),
+                profile->speedList,
+                sizeof(profile->speedList));
+    sInfo->tmp.spare25GSlots = profile->spare25GSlots;
+
+    profile->lastUse = sInfo->profileUseCount;
+
+}   /* end LoadSchedProfile */
 
-    switchExt = GET_SWITCH_EXT(sw);
-    sInfo     = &switchExt->schedInfo;
 
-    TAKE_SCHEDULER_LOCK(sw);
 
-    /* Sanity check */
-    if (physPort < 0 || physPort >= FM10000_NUM_PORTS)
+
+/*****************************************************************************/
+/** SaveSchedProfile
+ * \ingroup intSwitch
+ *
+ * \desc            Stores the schedule just generated in the temporary
+ *                  scheduler structure in the profile cache, replacing the
+ *                  least recently used entry if the cache is full.
+ *
+ * \note            The cache is only an optimization, so an allocation
+ *                  failure simply leaves the schedule uncached.
+ * 
+ * \param[in,out]   sInfo points to the scheduler state.
+ * 
+ * \return          None.
+ *
+ *****************************************************************************/
+static void SaveSchedProfile(fm10000_schedInfo *sInfo)
+{
+    fm10000_schedProfile *profile;
+    fm_int                i;
+
+    if (sInfo->profileCache == NULL)
     {
-        err = FM_ERR_INVALID_PORT;
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+        sInfo->profileCache = fmAlloc( sizeof(fm10000_schedProfile) *
+                                       FM10000_SCHED_PROFILE_CACHE_SIZE );
+
+        if (sInfo->profileCache == NULL)
+        {
+            FM_LOG_DEBUG(FM_LOG_CAT_SWITCH,
+                         "Unable to allocate scheduler profile cache\n");
+            return;
+        }
+
+        FM_MEMSET_S(sInfo->profileCache,
+                    sizeof(fm10000_schedProfile) *
+                        FM10000_SCHED_PROFILE_CACHE_SIZE,
+                    0,
+                    sizeof(fm10000_schedProfile) *
+                        FM10000_SCHED_PROFILE_CACHE_SIZE);
     }
 
-    *fabricPort = sInfo->physicalToFabricMap[physPort]; 
+    profile = &sInfo->profileCache[0];
 
-    if ( *fabricPort == -1 )
+    for (i = 0 ; i < FM10000_SCHED_PROFILE_CACHE_SIZE ; i++)
     {
-        err = FM_ERR_INVALID_PORT;
-        
-        /* silently ABORT (port is not in the map) */
-        goto ABORT;
+        if (!sInfo->profileCache[i].valid)
+        {
+            profile = &sInfo->profileCache[i];
+            break;
+        }
+
+        if (sInfo->profileCache[i].lastUse < profile->lastUse)
+        {
+            profile = &sInfo->profileCache[i];
+        }
     }
 
-ABORT:
-    DROP_SCHEDULER_LOCK(sw);
+    profile->valid         = TRUE;
+    profile->lastUse       = sInfo->profileUseCount;
+    profile->schedLen      = sInfo->tmp.schedLen;
+    profile->spare25GSlots = sInfo->tmp.spare25GSlots;
+
+    FM_MEMCPY_S(profile->reservedSpeed,
+                sizeof(profile->reservedSpeed),
+                sInfo->reservedSpeed,
+                sizeof(sInfo->reservedSpeed));
+    FM_MEMCPY_S(profile->reservedQuad,
+                sizeof(profile->reservedQuad),
+                sInfo->reservedQuad,
+                sizeof(sInfo->reservedQuad));
+    FM_MEMCPY_S(profile->physPortSpeed,
+                sizeof(profile->physPortSpeed),
+                sInfo->tmp.physPortSpeed,
+                sizeof(sInfo->tmp.physPortSpeed));
+    FM_MEMCPY_S(profile->fabricPortSpeed,
+                sizeof(profile->fabricPortSpeed),
+                sInfo->tmp.fabricPortSpeed,
+                sizeof(sInfo->tmp.fabricPortSpeed));
+    FM_MEMCPY_S(profile->diffTable,
+                sizeof(profile->diffTable),
+                sInfo->tmp.diffTable,
+                sizeof(sInfo->tmp.diffTable));
+    FM_MEMCPY_S(profile->schedList,
+                sizeof(profile->schedList),
+                sInfo->tmp.schedList,
+                sizeof(sInfo->tmp.schedList));
+    FM_MEMCPY_S(profile->speedList,
+                sizeof(profile->speedList),
+                sInfo->tmp.speedList,
+                sizeof(sInfo->tmp.speedList));
+
+}   /* end SaveSchedProfile */
 
-    FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_SWITCH, err);
 
-}   /* end fm10000MapPhysicalPortToFabricPort */
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
 
 
 
 
 /*****************************************************************************/
-/** fm10000MapPhysicalPortToEplLane
+/** fm10000InitScheduler
  * \ingroup intSwitch
  *
- * \desc            Maps a physical port to an EPL/Lane tupple.
+ * \desc            Initializes the scheduler.
  * 
  * \param[in]       sw is the switch on which to operate.
  * 
- * \param[in]       physPort is the physical port to convert.
- * 
- * \param[out]      epl is a pointer to the caller allocated storage
- *                  where this function should store the associated EPL.
- * 
- * \param[out]      lane is a pointer to the caller allocated storage
- *                  where this function should store the associated lane.
- *                  
  * \return          FM_OK if successful.
- * \return          FM_ERR_INVALID_PORT if the physical port is not tied to an
- *                  EPL lane tupple.
  *
  *****************************************************************************/
-fm_status fm10000MapPhysicalPortToEplLane(fm_int  sw, 
-                                          fm_int  physPort, 
-                                          fm_int *epl,
-                                          fm_int *lane)
+fm_status fm10000InitScheduler(fm_int sw)
 {
     fm_status          err = FM_OK;
     fm10000_switch *   switchExt;
     fm10000_schedInfo *sInfo;
+    fm_schedulerConfig sc;
+    fm_int             i;
+    fm_text            schedModeStr;
     fm_int             fabricPort;
+    
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw = %d\n", sw);
 
-    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH, "sw = %d, physPort = %d\n", sw, physPort);
+    TAKE_SCHEDULER_LOCK(sw);
 
     switchExt = GET_SWITCH_EXT(sw);
     sInfo     = &switchExt->schedInfo;
 
-    TAKE_SCHEDULER_LOCK(sw);
+    err = InitializeFreeLists(sw);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
-    /* Sanity check */
-    if (physPort < 0 || physPort >= FM10000_NUM_PORTS)
-    {
-        err = FM_ERR_INVALID_PORT;
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    }
+    schedModeStr = GET_FM10000_PROPERTY()->schedMode;
 
-    fabricPort = sInfo->physicalToFabricMap[physPort]; 
+    sInfo->attr.updateLnkChange = GET_FM10000_PROPERTY()->updateSchedOnLinkChange;
 
-    if ( (fabricPort < 0) ||
-         (fabricPort > FM10000_LAST_EPL_FABRIC_PORT) )
+    if (strcmp(schedModeStr, "static") == 0)
     {
-        err = FM_ERR_INVALID_PORT;
-
-        /* silently ABORT (port is not in the map) */
-        goto ABORT;
+        sInfo->attr.mode = FM10000_SCHED_MODE_STATIC;
+    }
+    else if (strcmp(schedModeStr, "dynamic") == 0)
+    {
+        sInfo->attr.mode = FM10000_SCHED_MODE_DYNAMIC;
+    }
+    else
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH, 
+                     "%s is not a valid scheduler mode\n", 
+                     schedModeStr);
+        err = FM_FAIL;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, 
+                 "Scheduler Mode = %s (%d), updateLnkChange = %d\n", 
+                 schedModeStr, 
+                 sInfo->attr.mode,
+                 sInfo->attr.updateLnkChange);
+    
+    err = fmPlatformGetSchedulerConfig(sw, &sc);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+    switch ( sc.mode )
+    {
+        case FM_SCHED_INIT_MODE_NONE:
+            /* If the scheduler config mode is none, let the platform code 
+             * initialize the scheduler */
+            err = FM_OK;
+            goto ABORT;
+
+        case FM_SCHED_INIT_MODE_AUTOMATIC:
+
+            FM_CLEAR(sInfo->tmp);
+
+            /* Validate sc->nbPorts */    
+            FM_LOG_ABORT_ON_ASSERT(FM_LOG_CAT_SWITCH, 
+                           sc.nbPorts <= FM10000_SCHED_MAX_NUM_PORTS, 
+                           err = FM_FAIL,
+                           "Number of ports exceeded (%d > %d)\n",
+                           sc.nbPorts,
+                           FM10000_SCHED_MAX_NUM_PORTS);
+
+            /* Copy the portlist locally, so that the API can update it
+             * as needed */
+            for (i = 0; i < sc.nbPorts; i++)
+            {
+                sInfo->tmp.portList[i] = sc.portList[i];
+            }
+
+            /* In dynamic mode, ignore any speed assigned to ethernet ports
+             * as those will be generated on the fly. */
+            if (sInfo->attr.mode == FM10000_SCHED_MODE_DYNAMIC)
+            {
+                for (i = 0; i < sc.nbPorts; i++)
+                {
+                    fabricPort = sInfo->tmp.portList[i].fabricPort;
+
+                    if ( (fabricPort >= FM10000_FIRST_EPL_FABRIC_PORT) && 
+                         (fabricPort <= FM10000_LAST_EPL_FABRIC_PORT) )
+                    {
+                        sInfo->tmp.portList[i].speed = 0;
+                    }
+                }
+            }
+
+            sInfo->tmp.nbPorts = sc.nbPorts;
+
+            /*********************************************
+             * Generate the physical to fabric port 
+             * mapping and its reverse
+             *********************************************/
+            err = GeneratePortMappingTables(sw);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+            err = GenerateSchedule(sw);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+            err = GenerateQpcState(sw, 
+                                   sInfo->tmp.schedList, 
+                                   sInfo->tmp.schedLen, 
+                                   TRUE);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+            for (i = 0; i < FM10000_SCHED_NUM_PORTS; i++)
+            {
+                fabricPort = sInfo->physicalToFabricMap[i];
+
+                if ( (fabricPort >= FM10000_FIRST_EPL_FABRIC_PORT) && 
+                     (fabricPort <= FM10000_LAST_EPL_FABRIC_PORT) )
+                {
+                    /* skip, let port API to handle the reservation */
+                    continue;
+                }
+
+                sInfo->preReservedSpeed[i] = sInfo->tmp.physPortSpeed[i];
+                sInfo->preReservedQuad[i]  = sInfo->tmp.isQuad[i];
+
+                sInfo->reservedSpeed[i]    = sInfo->preReservedSpeed[i];
+                sInfo->reservedQuad[i]     = sInfo->preReservedQuad[i];
+            }
+
+            err = fm10000SetSchedRing(sw, 
+                                      FM10000_SCHED_RING_ALL, 
+                                      sInfo->tmp.schedList,
+                                      sInfo->tmp.schedLen);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+            /* We have succeeded, store the scheduler state into the active
+             * structure */
+            FM_MEMCPY_S(&sInfo->active, 
+                        sizeof(sInfo->active), 
+                        &sInfo->tmp, 
+                        sizeof(sInfo->tmp) );
+            break;
+
+        case FM_SCHED_INIT_MODE_MANUAL:
+            /* Not supported yet */
+            err = FM_FAIL;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
     }
 
-    *epl = fabricPort / 4;
-    *lane = fabricPort % 4;
-
 ABORT:
     DROP_SCHEDULER_LOCK(sw);
 
-    FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_SWITCH, err);
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
 
-}   /* end fm10000MapPhysicalPortToEplLane */
+}   /* end fm10000InitScheduler */
 
 
 
 
 /*****************************************************************************/
-/** fm10000MapFabricPortToPhysicalPort
+/** fm10000FreeSchedulerResources
  * \ingroup intSwitch
  *
- * \desc            Maps a fabric port to a physical port.
+ * \desc            Free's resources allocated during init/generation
  * 
  * \param[in]       sw is the switch on which to operate.
  * 
- * \param[in]       fabricPort is the fabric port to convert.
- * 
- * \param[out]      physPort is a pointer to the caller allocated storage
- *                  where this function should store the associated physical port.
- * 
  * \return          FM_OK if successful.
- * \return          FM_ERR_INVALID_ARGUMENT if fabric port is not a valid value.
- * \return          FM_ERR_INVALID_PORT if the fabric port is not tied to a
- *                  physical port.
  *
  *****************************************************************************/
-fm_status fm10000MapFabricPortToPhysicalPort(fm_int  sw, 
-                                             fm_int  fabricPort, 
-                                             fm_int *physPort)
+fm_status fm10000FreeSchedulerResources(fm_int sw)
 {
-    fm_status          err = FM_OK;
-    fm10000_switch *   switchExt;
-    fm10000_schedInfo *sInfo;
-    
-    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH, "sw = %d, fabricPort = %d\n", sw, fabricPort);
+    fm_status           err = FM_OK;
+    fm10000_switch *    switchExt;
+    fm10000_schedInfo  *sInfo;
+    fm_int              i;
 
     switchExt = GET_SWITCH_EXT(sw);
     sInfo     = &switchExt->schedInfo;
 
-    TAKE_SCHEDULER_LOCK(sw);
-
-    /* Sanity check */
-    if ( (fabricPort < 0) || 
-         (fabricPort >= FM10000_NUM_FABRIC_PORTS) )
+    if (fmTreeIsInitialized(&sInfo->speedStatsTree))
     {
-        err = FM_ERR_INVALID_ARGUMENT;
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+        fmTreeDestroy(&sInfo->speedStatsTree, FreeStatEntry); 
+        fmTreeDestroy(&sInfo->qpcStatsTree, FreeStatEntry);
+        fmTreeDestroy(&sInfo->portStatsTree, FreeStatEntry);
     }
 
-    *physPort = sInfo->fabricToPhysicalMap[fabricPort];
-
-    if (*physPort == -1)
+    for (i = 0; i < FM10000_NUM_QPC; i++)
     {
-        err = FM_ERR_INVALID_PORT;
-        
-        /* silently ABORT (port is not in the map) */
-        goto ABORT;
+        if (fmTreeIsInitialized(&sInfo->qpcState[i]))
+        {
+            fmTreeDestroy(&sInfo->qpcState[i], FreeSchedEntryInfo);
+        }
     }
 
-ABORT:
-    DROP_SCHEDULER_LOCK(sw);
+    if (sInfo->profileCache != NULL)
+    {
+        fmFree(sInfo->profileCache);
+        sInfo->profileCache = NULL;
+    }
 
-    FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_SWITCH, err);
+    return err;
 
-}   /* end fm10000MapFabricPortToPhysicalPort */
+}   /* end fm10000FreeSchedulerResources */
 
 
 
 
 /*****************************************************************************/
-/** fm10000MapEplLaneToPhysicalPort
+/** fm10000MapPhysicalPortToFabricPort
  * \ingroup intSwitch
  *
- * \desc            Maps an EPL/Lane tupple to a physical port.
+ * \desc            Maps a physical port to a fabric port.
  * 
  * \param[in]       sw is the switch on which to operate.
  * 
- * \param[in]       epl is the epl to convert.
+ * \param[in]       physPort is the physical port to convert.
  * 
- * \param[in]       lane is the lane to convert.
+ * \param[out]      fabricPort is a pointer to the caller allocated storage
+ *                  where this function should store the associated fabric port.
  * 
- * \param[out]      physPort is a pointer to the caller allocated storage
- *                  where this function should store the associated physical port.
- *                  
  * \return          FM_OK if successful.
- * \return          FM_ERR_INVALID_ARGUMENT if the EPL/Lane tupple is not
- *                  valid.
- * \return          FM_ERR_INVALID_PORT if the EPL/Lane tupple is not 
- *                  tied to a physical port.
+ * \return          FM_ERR_INVALID_PORT if the physical port is not tied to a
+ *                  fabric port.
  *
  *****************************************************************************/
-fm_status fm10000MapEplLaneToPhysicalPort(fm_int  sw, 
-                                          fm_int  epl,
-                                          fm_int  lane,
-                                          fm_int *physPort)
+fm_status fm10000MapPhysicalPortToFabricPort(fm_int  sw, 
+                                             fm_int  physPort, 
+                                             fm_int *fabricPort)
 {
     fm_status          err = FM_OK;
     fm10000_switch *   switchExt;
     fm10000_schedInfo *sInfo;
-    fm_int             fabricPort;
     
-    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH, "sw = %d, epl = %d, lane = %d\n", sw, epl, lane);
+    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH, "sw = %d, physPort = %d\n", sw, physPort);
 
     switchExt = GET_SWITCH_EXT(sw);
     sInfo     = &switchExt->schedInfo;
@@ -4186,25 +4505,15 @@ fm_status fm10000MapEplLaneToPhysicalPort(fm_int  sw,
     TAKE_SCHEDULER_LOCK(sw);
 
     /* Sanity check */
-    if ( (epl < 0) || 
-         (epl > FM10000_MAX_EPL) )
-    {
-        err = FM_ERR_INVALID_ARGUMENT;
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    }
-
-    if ( (lane < 0) || 
-         (lane >= FM10000_PORTS_PER_EPL) )
+    if (physPort < 0 || physPort >= FM10000_NUM_PORTS)
     {
-        err = FM_ERR_INVALID_ARGUMENT;
+        err = FM_ERR_INVALID_PORT;
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
     }
 
-    fabricPort = (epl * FM10000_PORTS_PER_EPL) + lane;
-
-    *physPort = sInfo->fabricToPhysicalMap[fabricPort];
+    *fabricPort = sInfo->physicalToFabricMap[physPort]; 
 
-    if (*physPort == -1)
+    if ( *fabricPort == -1 )
     {
         err = FM_ERR_INVALID_PORT;
         
@@ -4217,38 +4526,245 @@ ABORT:
 
     FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_SWITCH, err);
 
-}   /* end fm10000MapEplLaneToPhysicalPort */
+}   /* end fm10000MapPhysicalPortToFabricPort */
 
 
 
 
 /*****************************************************************************/
-/** fm10000MapLogicalPortToFabricPort
+/** fm10000MapPhysicalPortToEplLane
  * \ingroup intSwitch
  *
- * \desc            Maps a logical port to a fabric port.
+ * \desc            Maps a physical port to an EPL/Lane tupple.
  * 
  * \param[in]       sw is the switch on which to operate.
  * 
- * \param[in]       logPort is the logical port to convert.
+ * \param[in]       physPort is the physical port to convert.
  * 
- * \param[out]      fabricPort is a pointer to the caller allocated storage
- *                  where this function should store the associated fabric port.
+ * \param[out]      epl is a pointer to the caller allocated storage
+ *                  where this function should store the associated EPL.
  * 
+ * \param[out]      lane is a pointer to the caller allocated storage
+ *                  where this function should store the associated lane.
+ *                  
  * \return          FM_OK if successful.
- * \return          FM_ERR_INVALID_ARGUMENT if logPort has an invalid value.
- * \return          FM_ERR_INVALID_PORT if the logical port is not tied to a
- *                  fabric port.
+ * \return          FM_ERR_INVALID_PORT if the physical port is not tied to an
+ *                  EPL lane tupple.
  *
  *****************************************************************************/
-fm_status fm10000MapLogicalPortToFabricPort(fm_int  sw, 
-                                            fm_int  logPort, 
-                                            fm_int *fabricPort)
+fm_status fm10000MapPhysicalPortToEplLane(fm_int  sw, 
+                                          fm_int  physPort, 
+                                          fm_int *epl,
+                                          fm_int *lane)
 {
     fm_status          err = FM_OK;
-    fm_int             physSwitch;
-    fm_int             physPort;
-
+    fm10000_switch *   switchExt;
+    fm10000_schedInfo *sInfo;
+    fm_int             fabricPort;
+
+    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH, "sw = %d, physPort = %d\n", sw, physPort);
+
+    switchExt = GET_SWITCH_EXT(sw);
+    sInfo     = &switchExt->schedInfo;
+
+    TAKE_SCHEDULER_LOCK(sw);
+
+    /* Sanity check */
+    if (physPort < 0 || physPort >= FM10000_NUM_PORTS)
+    {
+        err = FM_ERR_INVALID_PORT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
+    fabricPort = sInfo->physicalToFabricMap[physPort]; 
+
+    if ( (fabricPort < 0) ||
+         (fabricPort > FM10000_LAST_EPL_FABRIC_PORT) )
+    {
+        err = FM_ERR_INVALID_PORT;
+
+        /* silently ABORT (port is not in the map) */
+        goto ABORT;
+    }
+
+    *epl = fabricPort / 4;
+    *lane = fabricPort % 4;
+
+ABORT:
+    DROP_SCHEDULER_LOCK(sw);
+
+    FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_SWITCH, err);
+
+}   /* end fm10000MapPhysicalPortToEplLane */
+
+
+
+
+/*****************************************************************************/
+/** fm10000MapFabricPortToPhysicalPort
+ * \ingroup intSwitch
+ *
+ * \desc            Maps a fabric port to a physical port.
+ * 
+ * \param[in]       sw is the switch on which to operate.
+ * 
+ * \param[in]       fabricPort is the fabric port to convert.
+ * 
+ * \param[out]      physPort is a pointer to the caller allocated storage
+ *                  where this function should store the associated physical port.
+ * 
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if fabric port is not a valid value.
+ * \return          FM_ERR_INVALID_PORT if the fabric port is not tied to a
+ *                  physical port.
+ *
+ *****************************************************************************/
+fm_status fm10000MapFabricPortToPhysicalPort(fm_int  sw, 
+                                             fm_int  fabricPort, 
+                                             fm_int *physPort)
+{
+    fm_status          err = FM_OK;
+    fm10000_switch *   switchExt;
+    fm10000_schedInfo *sInfo;
+    
+    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH, "sw = %d, fabricPort = %d\n", sw, fabricPort);
+
+    switchExt = GET_SWITCH_EXT(sw);
+    sInfo     = &switchExt->schedInfo;
+
+    TAKE_SCHEDULER_LOCK(sw);
+
+    /* Sanity check */
+    if ( (fabricPort < 0) || 
+         (fabricPort >= FM10000_NUM_FABRIC_PORTS) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
+    *physPort = sInfo->fabricToPhysicalMap[fabricPort];
+
+    if (*physPort == -1)
+    {
+        err = FM_ERR_INVALID_PORT;
+        
+        /* silently ABORT (port is not in the map) */
+        goto ABORT;
+    }
+
+ABORT:
+    DROP_SCHEDULER_LOCK(sw);
+
+    FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_SWITCH, err);
+
+}   /* end fm10000MapFabricPortToPhysicalPort */
+
+
+
+
+/*****************************************************************************/
+/** fm10000MapEplLaneToPhysicalPort
+ * \ingroup intSwitch
+ *
+ * \desc            Maps an EPL/Lane tupple to a physical port.
+ * 
+ * \param[in]       sw is the switch on which to operate.
+ * 
+ * \param[in]       epl is the epl to convert.
+ * 
+ * \param[in]       lane is the lane to convert.
+ * 
+ * \param[out]      physPort is a pointer to the caller allocated storage
+ *                  where this function should store the associated physical port.
+ *                  
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if the EPL/Lane tupple is not
+ *                  valid.
+ * \return          FM_ERR_INVALID_PORT if the EPL/Lane tupple is not 
+ *                  tied to a physical port.
+ *
+ *****************************************************************************/
+fm_status fm10000MapEplLaneToPhysicalPort(fm_int  sw, 
+                                          fm_int  epl,
+                                          fm_int  lane,
+                                          fm_int *physPort)
+{
+    fm_status          err = FM_OK;
+    fm10000_switch *   switchExt;
+    fm10000_schedInfo *sInfo;
+    fm_int             fabricPort;
+    
+    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH, "sw = %d, epl = %d, lane = %d\n", sw, epl, lane);
+
+    switchExt = GET_SWITCH_EXT(sw);
+    sInfo     = &switchExt->schedInfo;
+
+    TAKE_SCHEDULER_LOCK(sw);
+
+    /* Sanity check */
+    if ( (epl < 0) || 
+         (epl > FM10000_MAX_EPL) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
+    if ( (lane < 0) || 
+         (lane >= FM10000_PORTS_PER_EPL) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
+    fabricPort = (epl * FM10000_PORTS_PER_EPL) + lane;
+
+    *physPort = sInfo->fabricToPhysicalMap[fabricPort];
+
+    if (*physPort == -1)
+    {
+        err = FM_ERR_INVALID_PORT;
+        
+        /* silently ABORT (port is not in the map) */
+        goto ABORT;
+    }
+
+ABORT:
+    DROP_SCHEDULER_LOCK(sw);
+
+    FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_SWITCH, err);
+
+}   /* end fm10000MapEplLaneToPhysicalPort */
+
+
+
+
+/*****************************************************************************/
+/** fm10000MapLogicalPortToFabricPort
+ * \ingroup intSwitch
+ *
+ * \desc            Maps a logical port to a fabric port.
+ * 
+ * \param[in]       sw is the switch on which to operate.
+ * 
+ * \param[in]       logPort is the logical port to convert.
+ * 
+ * \param[out]      fabricPort is a pointer to the caller allocated storage
+ *                  where this function should store the associated fabric port.
+ * 
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if logPort has an invalid value.
+ * \return          FM_ERR_INVALID_PORT if the logical port is not tied to a
+ *                  fabric port.
+ *
+ *****************************************************************************/
+fm_status fm10000MapLogicalPortToFabricPort(fm_int  sw, 
+                                            fm_int  logPort, 
+                                            fm_int *fabricPort)
+{
+    fm_status          err = FM_OK;
+    fm_int             physSwitch;
+    fm_int             physPort;
+
     FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH, "sw = %d, logPort = %d\n", sw, logPort);
 
     err = fmPlatformMapLogicalPortToPhysical(sw, 
@@ -5840,24 +6356,10 @@ ABORT:
  *****************************************************************************/
 fm_status fm10000RegenerateSchedule(fm_int sw)
 {
-    fm_status           err = FM_OK;
-    fm10000_switch *    switchExt;
-    fm10000_schedInfo  *sInfo;
-    fm_int              i;
-    fm_int              j;
-    fm_int              slots100G;
-    fm_int              slots60G;
-    fm_int              slots40G;
-    fm_int              slots25G;
-    fm_int              slots10G;
-    fm_int              slots2500M;
-    fm_int              slotsIdle;
-    fm_schedulerToken  *sToken;
-    fm_uint64           logCat;
-    fm_uint64           logLvl;
-    fm_int              physPort;
-    fm_int              fabricPort;
-    fm_int              spare25GSlots;
+    fm_status             err = FM_OK;
+    fm10000_switch *      switchExt;
+    fm10000_schedInfo    *sInfo;
+    fm10000_schedProfile *profile;
 
     fm_timestamp       tStart = {0,0};
     fm_timestamp       tGen   = {0,0};
@@ -5877,268 +6379,28 @@ fm_status fm10000RegenerateSchedule(fm_int sw)
                 &sInfo->active, 
                 sizeof(sInfo->active) );
 
-    /* Initialize Internal Structures */
-    err = fmCreateBitArray(&sInfo->tmp.p2500M, FM10000_NUM_PORTS);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    err = fmCreateBitArray(&sInfo->tmp.p10G, FM10000_NUM_PORTS);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    err = fmCreateBitArray(&sInfo->tmp.p25G, FM10000_NUM_PORTS);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    err = fmCreateBitArray(&sInfo->tmp.p40G, FM10000_NUM_PORTS);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    err = fmCreateBitArray(&sInfo->tmp.p60G, FM10000_NUM_PORTS);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    err = fmCreateBitArray(&sInfo->tmp.p100G, FM10000_NUM_PORTS);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    sInfo->profileUseCount++;
 
-    /*********************************************
-     * Sort all ports into speed bins 
-     *********************************************/
+    profile = FindSchedProfile(sInfo);
 
-    for (i = 0; i < FM10000_SCHED_NUM_PORTS; i++) 
+    if (profile != NULL)
     {
-        if (sInfo->physicalToFabricMap[i] == -1)
-        {
-            continue;
-        }
-
-        fabricPort = sInfo->physicalToFabricMap[i];
-
-        sInfo->tmp.physPortSpeed[i] = sInfo->reservedSpeed[i];
-        sInfo->tmp.fabricPortSpeed[fabricPort] = sInfo->tmp.physPortSpeed[i];
-
-        switch (sInfo->tmp.physPortSpeed[i])
-        {
-            case FM10000_SCHED_SPEED_IDLE:
-                break;
-
-            case FM10000_SCHED_SPEED_2500M:
-                err = fmSetBitArrayBit(&sInfo->tmp.p2500M, i, 1);
-                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-                break;
-
-            case FM10000_SCHED_SPEED_10G:
-                err = fmSetBitArrayBit(&sInfo->tmp.p10G, i, 1);
-                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-                break;
-
-            case FM10000_SCHED_SPEED_25G:
-                err = fmSetBitArrayBit(&sInfo->tmp.p25G, i, 1);
-                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-                break;
-
-            case FM10000_SCHED_SPEED_40G:
-                err = fmSetBitArrayBit(&sInfo->tmp.p40G, i, 1);
-                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-                break;
-
-            case FM10000_SCHED_SPEED_60G:
-                err = fmSetBitArrayBit(&sInfo->tmp.p60G, i, 1);
-                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-                break;
-
-            case FM10000_SCHED_SPEED_100G:
-                err = fmSetBitArrayBit(&sInfo->tmp.p100G, i, 1);
-                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-                break;
-
-            default:
-                err = FM_ERR_SCHED_VIOLATION;
-                FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
-                             "Invalid Speed for entry: physPort=%d speed=%d\n",
-                             i,
-                             sInfo->tmp.physPortSpeed[i]);
-                goto ABORT;
-                break;
-        }
-    }
-        
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 100G Ports", GetNbPorts(&sInfo->tmp.p100G) );
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 60G Ports", GetNbPorts(&sInfo->tmp.p60G) );
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 40G Ports", GetNbPorts(&sInfo->tmp.p40G) );
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 25G Ports", GetNbPorts(&sInfo->tmp.p25G) );
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 10G Ports", GetNbPorts(&sInfo->tmp.p10G) );
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 2.5G Ports", GetNbPorts(&sInfo->tmp.p2500M) );
-
-    /*********************************************
-     * Validate that the frequency is sufficiently
-     * high to support 100G and 40G ports
-     *********************************************/
-    if ( GetNbPorts(&sInfo->tmp.p100G) &&
-         (sInfo->tmp.schedLen < (MIN_PORT_SPACING * SLOTS_PER_100G) ) )
-    {
-        err = FM_ERR_SCHED_OVERSUBSCRIBED;
-        FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
-                     "freq not high enough to support 100G w/4-cycle spacing\n");
-        goto ABORT;
-    }
-
-    if ( GetNbPorts(&sInfo->tmp.p60G) &&
-         (sInfo->tmp.schedLen < (MIN_PORT_SPACING * SLOTS_PER_60G) ) )
-    {
-        err = FM_ERR_SCHED_OVERSUBSCRIBED;
-        FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
-                     "freq not high enough to support 60G w/4-cycle spacing\n");
-        goto ABORT;
-    }
-
-    if ( GetNbPorts(&sInfo->tmp.p40G) &&
-         (sInfo->tmp.schedLen < (MIN_PORT_SPACING * SLOTS_PER_40G) ) )
-    {
-        err = FM_ERR_SCHED_OVERSUBSCRIBED;
-        FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
-                     "freq not high enough to support 40G w/4-cycle spacing\n");
-        goto ABORT;
-    }
-
-    /*********************************************
-     * Compute number of slots required per 
-     * speed bin. 
-     ********************************************/
-    slots100G   = GetNbPorts(&sInfo->tmp.p100G)  * SLOTS_PER_100G;
-    slots60G    = GetNbPorts(&sInfo->tmp.p60G)   * SLOTS_PER_60G;
-    slots40G    = GetNbPorts(&sInfo->tmp.p40G)   * SLOTS_PER_40G;
-    slots25G    = GetNbPorts(&sInfo->tmp.p25G)   * SLOTS_PER_25G;
-    slots10G    = GetNbPorts(&sInfo->tmp.p10G)   * SLOTS_PER_10G;
-    slots2500M  = GetNbPorts(&sInfo->tmp.p2500M) * SLOTS_PER_2500M;
-    slotsIdle   = sInfo->tmp.schedLen - slots100G - slots60G - slots40G - slots25G - slots10G - slots2500M;
-    
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 100G Slots", slots100G);
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 60G Slots", slots60G);
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 40G Slots", slots40G);
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 25G Slots", slots25G);
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 10G Slots", slots10G);
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number 2.5G Slots", slots2500M);
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "%-20s = %d\n", "Number Idle Slots", slotsIdle);
-
-    if (slotsIdle <= 0)
-    {
-        err = FM_ERR_SCHED_OVERSUBSCRIBED;
-        FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
-                     "Oversubscribed schedule, minimum of 1 idle slot needed\n");
-        FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
-                     "Requested %d slots (%.1fG), but only %d are available (%.1fG)\n",
-                     slots100G + slots60G + slots40G + slots25G + slots10G + slots2500M + 1,
-                     ((slots100G + slots60G + slots40G + slots25G + slots10G + slots2500M + 1) * (fm_float)(SLOT_SPEED)),
-                     sInfo->tmp.schedLen,
-                     (sInfo->tmp.schedLen * (fm_float)(SLOT_SPEED)));
-        goto ABORT;
-    }
-
-    err = GetNumSpare25GSlots(sw, slotsIdle, &spare25GSlots);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    slots25G  += spare25GSlots;
-    slotsIdle -= spare25GSlots;
-    sInfo->tmp.spare25GSlots = spare25GSlots;
+        /* This speed profile was generated before, reuse its rings */
+        FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "Reusing cached schedule\n");
 
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "Spare 25G Slots allocated: %d\n", spare25GSlots);
+        LoadSchedProfile(sInfo, profile);
 
-    /*********************************************
-     * Split the bandwidth by populating the slots 
-     * with port speeds
-     *********************************************/
-    err = PopulateSpeedList(sw, slots100G, slots60G, slots40G, slots25G, slots10G, slots2500M, slotsIdle );
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-
-    /*********************************************
-     * Need to find the first idle token, this 
-     * will be our implicit idle and it does not
-     * need to be added to the schedule 
-     *********************************************/
-    err = RotateSchedule(sw);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-
-    /*********************************************
-     * Sort the ports by the difficulty level 
-     * of placing them in the schedule.
-     *********************************************/
-    err = SortPortsByDifficulty(sw);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    
-    /*********************************************
-     * We have the speed bins, fill them with 
-     * ports
-     *********************************************/
-    FM_CLEAR(sInfo->tmp.schedList);
-    for (i = 0; i < sInfo->tmp.schedLen; i++)
-    {
-        /* Mark all ports as invalid */
-        sInfo->tmp.schedList[i].port = -1;
-    }
-
-    err = AssignPortsByDifficulty(sw);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    /* Assign Idle Tokens */
-    for (i = 0; i < sInfo->tmp.schedLen; i++)
-    {
-        sToken = &sInfo->tmp.schedList[i];
-        if ( sInfo->tmp.speedList[i] == FM10000_SCHED_SPEED_IDLE )
-        {
-            sToken->port        = 0;
-            sToken->fabricPort  = 0;
-            sToken->quad        = 0;
-            sToken->idle        = 1;
-        }
-        else if ( (sInfo->tmp.speedList[i] == FM10000_SCHED_SPEED_25G) &&
-                  (sToken->port            == -1) ) 
-        {
-            sInfo->tmp.speedList[i] = FM10000_SCHED_SPEED_IDLE;
-            sToken->port        = 0;
-            sToken->fabricPort  = 0;
-            sToken->quad        = 0;
-            sToken->idle        = 1;
-        }
+        err = CalcStats(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
     }
-
-    /* Fill in the fabricPort, Quad, and Idle fields per portList entries */
-    for (i = 0; i < sInfo->tmp.nbPorts; i++)
+    else
     {
-        physPort = sInfo->tmp.portList[i].physPort;
-
-        for (j = 0; j < sInfo->tmp.schedLen; j++)
-        {
-            if ( (physPort == sInfo->tmp.schedList[j].port) &&
-                 (sInfo->tmp.schedList[j].idle == 0) )
-            {
-                sInfo->tmp.schedList[j].fabricPort = sInfo->tmp.portList[i].fabricPort;
-                sInfo->tmp.schedList[j].quad       = sInfo->reservedQuad[physPort];
-                sInfo->tmp.schedList[j].idle       = 0;
-
-                /* If the entry is quad, force channel 0 (required for cases
-                 * where lane-reversal is used). */
-                if (sInfo->tmp.schedList[j].quad)
-                {
-                    sInfo->tmp.schedList[j].fabricPort = 
-                        (sInfo->tmp.schedList[j].fabricPort / 4) * 4;
-                }
-            }
-        }
-    }
+        err = BuildTmpSchedule(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
-    fmGetLoggingAttribute(FM_LOG_ATTR_CATEGORY_MASK, 
-                          0, 
-                          (void *) &logCat);
-    fmGetLoggingAttribute(FM_LOG_ATTR_LEVEL_MASK, 
-                          0, 
-                          (void *) &logLvl);
-    
-    if ( (logCat & FM_LOG_CAT_SWITCH) &&
-         (logLvl & FM_LOG_LEVEL_DEBUG) )
-    {
-        DbgDumpSchedulerConfig(sw, TMP_SCHEDULE, FALSE);
+        SaveSchedProfile(sInfo);
     }
 
-    err = CalcStats(sw);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    err = ValidateSchedule(sw);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
     err = GenerateQpcState(sw, sInfo->tmp.schedList, sInfo->tmp.schedLen, FALSE);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
@@ -6149,15 +6411,6 @@ fm_status fm10000RegenerateSchedule(fm_int sw)
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
    
 ABORT:
-    
-    /* Delete Internal BitArrays */
-    fmDeleteBitArray(&sInfo->tmp.p2500M);
-    fmDeleteBitArray(&sInfo->tmp.p10G);
-    fmDeleteBitArray(&sInfo->tmp.p25G);
-    fmDeleteBitArray(&sInfo->tmp.p40G);
-    fmDeleteBitArray(&sInfo->tmp.p60G);
-    fmDeleteBitArray(&sInfo->tmp.p100G);
-
     if (err == FM_OK)
     {
         /* We have succeeded, store the scheduler state into the active
@@ -96,6 +96,13 @@ static fm_status fm10000SerdesSpicoSaiInt(fm_int     sw,
                                           fm_uint32 *pResult);
 static fm_status fm10000SerdesInitGenericOptions(fm_int sw);
 static fm_status fm10000SerdesInitXServices(fm_int sw);
+static fm_bool fm10000SpicoFwIsLoaded(fm_int     sw,
+                                      fm_uint32  sbmCodeVersionBuildId,
+                                      fm_bool    checkSwap,
+                                      fm_int     swapCrcCode,
+                                      fm_int     firstSerdes,
+                                      fm_int     lastSerdes,
+                                      fm_uint32  serdesCodeVersionBuildId);
 
 
 /*****************************************************************************
@@ -790,6 +797,88 @@ static fm_int fm10000SerdesGetPepId(fm_int sw, fm_int serdes)
 
 
 
+/*****************************************************************************/
+/**  fm10000SpicoFwIsLoaded
+ * \ingroup intSerdes
+ *
+ * \desc            Determines whether the SBM, swap and SerDes SPICO images
+ *                  currently running on the EPL ring are the expected ones
+ *                  and pass their CRC check, so that the upload can be
+ *                  skipped. The SBM is probed first, since the SerDes image
+ *                  cannot be valid without it.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       sbmCodeVersionBuildId is the expected SBM version and
+ *                  build-Id.
+ *
+ * \param[in]       checkSwap specifies whether a swap image is expected.
+ *
+ * \param[in]       swapCrcCode is the swap image CRC code.
+ *
+ * \param[in]       firstSerdes is the first serdes to check.
+ *
+ * \param[in]       lastSerdes is the last serdes to check.
+ *
+ * \param[in]       serdesCodeVersionBuildId is the expected SerDes version
+ *                  and build-Id.
+ *
+ * \return          TRUE if all the expected images are already loaded.
+ * \return          FALSE otherwise.
+ *
+ *****************************************************************************/
+static fm_bool fm10000SpicoFwIsLoaded(fm_int     sw,
+                                      fm_uint32  sbmCodeVersionBuildId,
+                                      fm_bool    checkSwap,
+                                      fm_int     swapCrcCode,
+                                      fm_int     firstSerdes,
+                                      fm_int     lastSerdes,
+                                      fm_uint32  serdesCodeVersionBuildId)
+{
+    fm_status err;
+    fm_uint   versionBuildId;
+    fm_bool   loaded;
+
+    loaded = FALSE;
+
+    err = fm10000SbmGetBuildRevisionId(sw, FM10000_SERDES_RING_EPL, &versionBuildId);
+
+    if (err == FM_OK && versionBuildId == sbmCodeVersionBuildId)
+    {
+        err = fm10000SbmSpicoDoCrc(sw,
+                                   FM10000_SERDES_RING_EPL,
+                                   FM10000_SBUS_SPICO_BCAST_ADDR);
+
+        if (err == FM_OK && checkSwap)
+        {
+            err = fm10000SwapImageDoCrc(sw,
+                                        FM10000_SERDES_RING_EPL,
+                                        FM10000_SBUS_SPICO_BCAST_ADDR,
+                                        swapCrcCode);
+        }
+
+        if (err == FM_OK)
+        {
+            err = fm10000SerdesIsSpicoFwLoaded(sw,
+                                               firstSerdes,
+                                               lastSerdes,
+                                               serdesCodeVersionBuildId,
+                                               &loaded);
+        }
+    }
+
+    if (err != FM_OK)
+    {
+        loaded = FALSE;
+    }
+
+    return loaded;
+
+}
+
+
+
+
 /*****************************************************************************/
 /**  fm10000SerdesGetPepFromMap
  * \ingroup intSerdes
@@ -810,6 +899,46 @@ fm_int fm10000SerdesGetPepFromMap(fm_int serDes)
 
 
 
+/*****************************************************************************/
+/** NotifySerDesEvent
+ * \ingroup intSerdes
+ *
+ * \desc            Notifies an event to the state machine of a lane, or
+ *                  queues it in a batch if one is provided.
+ *
+ * \param[in,out]   batch is the event batch, or NULL.
+ *
+ * \param[in]       pLaneExt is the lane extension.
+ *
+ * \param[in]       eventInfo is the event to notify.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status NotifySerDesEvent(fm_smEventBatch *batch,
+                                   fm10000_lane    *pLaneExt,
+                                   fm_smEventInfo  *eventInfo)
+{
+    if (batch != NULL)
+    {
+        return fmQueueStateMachineEvent(batch,
+                                        pLaneExt->smHandle,
+                                        eventInfo,
+                                        &pLaneExt->eventInfo,
+                                        &pLaneExt->serDes);
+    }
+
+    return fmNotifyStateMachineEvent(pLaneExt->smHandle,
+                                     eventInfo,
+                                     &pLaneExt->eventInfo,
+                                     &pLaneExt->serDes);
+
+}   /* end NotifySerDesEvent */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -1030,7 +1159,11 @@ void fm10000SerDesPcieSetDebug(fm_int debug)
  * \desc            Uploads all the SPICO firmware, including the sBus Master
  *                  FW, the SERDES FW and the swap image, if required. The
  *                  operational mode and the useAlternateSpicoFw API property
- *                  determine the firmware versions to be uploaded.
+ *                  determine the firmware versions to be uploaded. The SPICO
+ *                  RAM BIST is run before the upload. When the
+ *                  reuseLoadedSpicoFw API property is set and the expected
+ *                  images are already running with a valid CRC, both the
+ *                  BIST and the upload are skipped.
  *
  * \param[in]       sw is the switch on which to operate.
  *
@@ -1058,6 +1191,8 @@ fm_status fm10000LoadSpicoCode(fm_int sw)
     fm_int          firstSerdes;
     fm_int          lastSerdes;
     fm_serDesOpMode serdesOpMode;
+    fm_bool         fwLoaded;
+    fm_status       bistErr;
 
 
 
@@ -1090,6 +1225,7 @@ fm_status fm10000LoadSpicoCode(fm_int sw)
     serdesImageSelector = (useProductionSpicoCodeVersions << 1) | imageOption;
 
 
+    fwLoaded = FALSE;
     swapCodeSize = 0;
     pSwapCodeImage = NULL;
     serdesCodeVersionBuildId = 0;
@@ -1175,15 +1311,49 @@ fm_status fm10000LoadSpicoCode(fm_int sw)
             FM_LOG_PRINT("Support for KR: %s\n", switchExt->serdesSupportsKR? "YES" : "NO");
         }
 
+        swapCrcCode = ((sbmCodeVersionBuildId & 0x00008000) == 0) ? 0x1a : 0x04;
+
+        if (GET_FM10000_PROPERTY()->reuseLoadedSpicoFw)
+        {
+            fwLoaded = fm10000SpicoFwIsLoaded(sw,
+                                              sbmCodeVersionBuildId,
+                                              (swapCodeSize > 0),
+                                              swapCrcCode,
+                                              firstSerdes,
+                                              lastSerdes,
+                                              serdesCodeVersionBuildId);
+
+            if (GET_FM10000_PROPERTY()->serdesDbgLevel > 0)
+            {
+                FM_LOG_PRINT("SPICO firmware already loaded: %s\n", fwLoaded? "YES" : "NO");
+            }
+        }
+
+        if (!fwLoaded)
+        {
+            /* The RAM BIST clears the SPICO RAM, so it only runs when the
+             * firmware is going to be uploaded. */
+            bistErr = fm10000SpicoRamBist(sw,
+                                          FM10000_SERDES_RING_EPL,
+                                          FM10000_SBUS_SPICO_BCAST_ADDR,
+                                          FM10000_SPICO_BIST_CMD_ALL);
+            if (bistErr != FM_OK)
+            {
+
+                FM_LOG_ERROR(FM_LOG_CAT_SERDES,
+                             "Spico Ram BIST Failed: %s\n",
+                             fmErrorMsg(bistErr));
+            }
 
-        err = fm10000SbmSpicoUploadImage(sw,
-                                         FM10000_SERDES_RING_EPL,
-                                         FM10000_SBUS_SPICO_BCAST_ADDR,
-                                         pSbmCodeImage,
-                                         sbmCodeSize);
+            err = fm10000SbmSpicoUploadImage(sw,
+                                             FM10000_SERDES_RING_EPL,
+                                             FM10000_SBUS_SPICO_BCAST_ADDR,
+                                             pSbmCodeImage,
+                                             sbmCodeSize);
+        }
     }
 
-    if (err == FM_OK)
+    if (err == FM_OK && !fwLoaded)
     {
 
         err = fm10000SbmChckCrcVersionBuildId(sw, FM10000_SERDES_RING_EPL, sbmCodeVersionBuildId);
@@ -1191,7 +1361,7 @@ fm_status fm10000LoadSpicoCode(fm_int sw)
 
 
 
-    if (err == FM_OK && swapCodeSize > 0)
+    if (err == FM_OK && !fwLoaded && swapCodeSize > 0)
     {
         if ((sbmCodeVersionBuildId & 0x00008000) == 0)
         {
@@ -1202,7 +1372,6 @@ fm_status fm10000LoadSpicoCode(fm_int sw)
                                                FM10000_SBUS_SPICO_BCAST_ADDR,
                                                pSwapCodeImage,
                                                swapCodeSize);
-            swapCrcCode = 0x1a;
         }
         else
         {
@@ -1211,7 +1380,6 @@ fm_status fm10000LoadSpicoCode(fm_int sw)
                                                   FM10000_SBUS_SPICO_BCAST_ADDR,
                                                   pSwapCodeImage,
                                                   swapCodeSize);
-            swapCrcCode = 0x04;
         }
 
         if (err == FM_OK)
@@ -1234,19 +1402,24 @@ fm_status fm10000LoadSpicoCode(fm_int sw)
 
 
 
-        err = fm10000SerdesSpicoUploadImage(sw,
-                                            FM10000_SERDES_RING_EPL,
-                                            FM10000_SERDES_EPL_BCAST,
-                                            pSerdesCodeImage,
-                                            serdesCodeSize);
-        if (err == FM_OK)
+        if (!fwLoaded)
         {
+            err = fm10000SerdesSpicoUploadImage(sw,
+                                                FM10000_SERDES_RING_EPL,
+                                                FM10000_SERDES_EPL_BCAST,
+                                                pSerdesCodeImage,
+                                                serdesCodeSize);
+        }
 
-
-            err = fm10000SerdesChckCrcVersionBuildId(sw,
-                                                     firstSerdes,
-                                                     lastSerdes,
-                                                     serdesCodeVersionBuildId);
+        if (err == FM_OK)
+        {
+            if (!fwLoaded)
+            {
+                err = fm10000SerdesChckCrcVersionBuildId(sw,
+                                                         firstSerdes,
+                                                         lastSerdes,
+                                                         serdesCodeVersionBuildId);
+            }
 
             fm10000SerdesSpicoSaveImageParam(pSerdesCodeImage,
                                              serdesCodeSize,
@@ -1299,20 +1472,9 @@ fm_status fm10000InitSwSerdes(fm_int sw)
             if (serdesOpMode != FM_SERDES_OPMODE_STUB_SM)
             {
 
-                err = fm10000SpicoRamBist(sw,
-                                          FM10000_SERDES_RING_EPL,
-                                          FM10000_SBUS_SPICO_BCAST_ADDR,
-                                          FM10000_SPICO_BIST_CMD_ALL);
-                if (err != FM_OK)
-                {
-
-                    FM_LOG_ERROR(FM_LOG_CAT_SERDES,
-                                 "Spico Ram BIST Failed: %s\n",
-                                 fmErrorMsg(err));
-                }
-
-
+                fmDbgBootPhaseBegin(sw, "LoadSpicoCode", -1);
                 err = fm10000LoadSpicoCode(sw);
+                fmDbgBootPhaseEnd(sw, "LoadSpicoCode");
 
 
                 if (err == FM_OK)
@@ -1549,6 +1711,49 @@ fm_status fm10000SerdesSpicoWrOnlyInt(fm_int      sw,
 
 
 
+/*****************************************************************************/
+/** fm10000SerdesSpicoIntUsesSBus
+ * \ingroup intSerdes
+ *
+ * \desc            Indicates whether SPICO interrupts to the given SERDES are
+ *                  issued over the sBus rather than the parallel (SAI or
+ *                  PCIe) interface. Only the sBus path allows the interrupt
+ *                  to be started and its result collected separately.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       serDes is the SERDES number on which to operate.
+ *
+ * \return          TRUE if the sBus interface is used.
+ * \return          FALSE otherwise.
+ *
+ *****************************************************************************/
+fm_bool fm10000SerdesSpicoIntUsesSBus(fm_int sw,
+                                      fm_int serDes)
+{
+    fm10000_switch *switchExt;
+    fm_bool         useParallelIntf;
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    useParallelIntf = FALSE;
+
+    if (switchExt->serdesIntUseLaneSai && switchExt->serdesIntAccssCtrlEna)
+    {
+        useParallelIntf = !eplUseSbusIntf;
+    }
+    if (serDes >= FM10000_EPL_RING_SERDES_NUM)
+    {
+        useParallelIntf = !pcieUseSbusIntf;
+    }
+
+    return !useParallelIntf;
+
+}
+
+
+
+
 /*****************************************************************************/
 /** fm10000SerdesSpicoInt
  * \ingroup intSerdes
@@ -1581,7 +1786,6 @@ fm_status fm10000SerdesSpicoInt(fm_int      sw,
                                 fm_uint32  *pValue)
 {
     fm_status           err;
-    fm10000_switch     *switchExt;
     fm_bool             isEplRing;
     fm_bool             useParallelIntf;
 
@@ -1593,9 +1797,6 @@ fm_status fm10000SerdesSpicoInt(fm_int      sw,
                             param,
                             (void *) pValue);
 
-    switchExt = GET_SWITCH_EXT(sw);
-
-
     if (pValue != NULL)
     {
         *pValue = 0;
@@ -1603,16 +1804,7 @@ fm_status fm10000SerdesSpicoInt(fm_int      sw,
 
     isEplRing = (serDes < FM10000_EPL_RING_SERDES_NUM);
 
-    useParallelIntf = FALSE;
-
-    if (switchExt->serdesIntUseLaneSai && switchExt->serdesIntAccssCtrlEna)
-    {
-        useParallelIntf = !eplUseSbusIntf;
-    }
-    if (!isEplRing)
-    {
-        useParallelIntf = !pcieUseSbusIntf;
-    }
+    useParallelIntf = !fm10000SerdesSpicoIntUsesSBus(sw, serDes);
 
     if (useParallelIntf)
     {
@@ -3561,13 +3753,19 @@ fm_status fm10000SerdesSetBistUserPattern(fm_int     sw,
  *
  * \param[in]       serDesIp is the interrupt pending mask for this EPL lane
  *
+ * \param[in,out]   batch is the batch in which to queue the resulting
+ *                  state machine events, so that bursts across lanes are
+ *                  processed in one pass. May be NULL to notify the events
+ *                  right away.
+ *
  * \return          FM_OK
  *
  *****************************************************************************/
-fm_status fm10000SerDesEventHandler( fm_int    sw,
-                                     fm_int    epl,
-                                     fm_int    lane,
-                                     fm_uint32 serDesIp )
+fm_status fm10000SerDesEventHandler( fm_int           sw,
+                                     fm_int           epl,
+                                     fm_int           lane,
+                                     fm_uint32        serDesIp,
+                                     fm_smEventBatch *batch )
 {
     fm_status       err;
     fm_int          serDes;
@@ -3632,10 +3830,7 @@ fm_status fm10000SerDesEventHandler( fm_int    sw,
                     }
                     if (eventInfo.eventId >= 0)
                     {
-                        err = fmNotifyStateMachineEvent(pLaneExt->smHandle,
-                                                &eventInfo,
-                                                &pLaneExt->eventInfo,
-                                                &pLaneExt->serDes);
+                        err = NotifySerDesEvent(batch, pLaneExt, &eventInfo);
                     }
                 }
             }
@@ -3658,10 +3853,7 @@ fm_status fm10000SerDesEventHandler( fm_int    sw,
                         eventInfo.eventId = FM10000_SERDES_EVENT_SIGNALOK_DEASSERTED_IND;
                     }
 
-                    err = fmNotifyStateMachineEvent(pLaneExt->smHandle,
-                                                    &eventInfo,
-                                                    &pLaneExt->eventInfo,
-                                                    &pLaneExt->serDes);
+                    err = NotifySerDesEvent(batch, pLaneExt, &eventInfo);
                 }
             }
 
@@ -41,6 +41,9 @@
 
 #define STR_EQ(str1, str2) (strcasecmp(str1, str2) == 0)
 
+/* Number of SPICO 0x26 reads used to derive the simple eye metric */
+#define EYE_METRIC_NUM_SAMPLES  8
+
 
 
 
@@ -189,6 +192,11 @@ static fm_status DbgSerdesGetDfeParmeter(fm_int      sw,
 static fm_bool SerdesValidateAttenuationCoefficients(fm_int  att,
                                                      fm_int  pre,
                                                      fm_int  post);
+static void SetEyeSimpleMetric(fm_int           sw,
+                               fm_int           serDes,
+                               const fm_uint32 *samples,
+                               fm_int          *pEyeScore,
+                               fm_int          *pHeightmV);
 static fm_status SerdesGetEyeSimpleMetric(fm_int  sw,
                                           fm_int  serDes,
                                           fm_int *pEyeScore,
@@ -205,6 +213,11 @@ static fm_status SbusReadExt(fm_int     sw,
                              fm_uint    sbusAddr,
                              fm_uint    sbusReg,
                              fm_uint32 *pValue);
+static fm_status SerdesCheckSpicoFw(fm_int     sw,
+                                    fm_int     firstSerdes,
+                                    fm_int     lastSerdes,
+                                    fm_uint32  expectedCodeVersionBuildId,
+                                    fm_bool    logErrors);
 
 
 /*****************************************************************************
@@ -2792,6 +2805,77 @@ static fm_bool SerdesValidateAttenuationCoefficients(fm_int  att,
 
 
 
+/*****************************************************************************/
+/** SetEyeSimpleMetric
+ * \ingroup intSerdes
+ *
+ * \desc            Derives the simple eye metric from the SPICO 0x26 reads
+ *                  and records it in the lane DFE state.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       serDes is the SerDes number on which to operate.
+ *
+ * \param[in]       samples points to the EYE_METRIC_NUM_SAMPLES values
+ *                  returned by the 0x26 interrupt, in read order.
+ *
+ * \param[out]      pEyeScore points to the caller-allocated storage where this
+ *                  function will return the eye metric [0..64]. It may be NULL.
+ *
+ * \param[out]      pHeightmV points to the caller-allocated storage where this
+ *                  function will return the eye metric [0..1000]. It may be
+ *                  NULL.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void SetEyeSimpleMetric(fm_int           sw,
+                               fm_int           serDes,
+                               const fm_uint32 *samples,
+                               fm_int          *pEyeScore,
+                               fm_int          *pHeightmV)
+{
+    fm_uint         index;
+    fm_uint32       results;
+    fm_uint32       value1;
+    fm_uint32       value2;
+    fm_uint32       vDiff;
+    fm10000_lane   *pLaneExt;
+
+    results = 1000;
+
+    for( index = 0; index < EYE_METRIC_NUM_SAMPLES; index += 2 )
+    {
+        value1 = samples[index];
+        value2 = samples[index + 1];
+
+        value1 = (value1 & 0x8000) ? value1 | 0xffff0000 : value1;
+        value2 = (value2 & 0x8000) ? value2 | 0xffff0000 : value2;
+        vDiff  = abs(value2 - value1);
+
+        results = (vDiff < results)? vDiff : results;
+    }
+
+    pLaneExt = GET_LANE_EXT(sw, serDes);
+
+    pLaneExt->dfeExt.eyeScoreHeight = results;
+    pLaneExt->dfeExt.eyeScoreHeightmV = (results * 1000) / 256;
+
+    if (pEyeScore)
+    {
+        *pEyeScore = pLaneExt->dfeExt.eyeScoreHeight;
+    }
+
+    if (pHeightmV)
+    {
+        *pHeightmV = pLaneExt->dfeExt.eyeScoreHeightmV;
+    }
+
+}
+
+
+
+
 /*****************************************************************************/
 /** SerdesGetEyeSimpleMetric
  * \ingroup intSerdes
@@ -2823,58 +2907,22 @@ static fm_status SerdesGetEyeSimpleMetric(fm_int  sw,
 {
     fm_status       err;
     fm_uint         index;
-    fm_uint32       results;
-    fm_uint32       value1;
-    fm_uint32       value2;
-    fm_uint32       vDiff;
-    fm10000_lane   *pLaneExt;
+    fm_uint32       samples[EYE_METRIC_NUM_SAMPLES];
 
     err = FM_OK;
-    results = 1000;
-    value1 = 0;
-    value2 = 0;
 
-    for( index = 0; index < 8 && err == FM_OK; index += 2 )
+    for( index = 0; index < EYE_METRIC_NUM_SAMPLES && err == FM_OK; index++ )
     {
         err = fm10000SerdesSpicoInt(sw,
                                     serDes,
                                     FM10000_SPICO_SERDES_INTR_0X26_READ,
-                                    (4 << 12) | ((index+0) << 8),
-                                    &value1);
-
-        if (err == FM_OK)
-        {
-            err = fm10000SerdesSpicoInt(sw,
-                                        serDes,
-                                        FM10000_SPICO_SERDES_INTR_0X26_READ,
-                                        (4 << 12) | ((index+1) << 8),
-                                        &value2);
-        }
-
-
-        value1 = (value1 & 0x8000) ? value1 | 0xffff0000 : value1;
-        value2 = (value2 & 0x8000) ? value2 | 0xffff0000 : value2;
-        vDiff  = abs(value2 - value1);
-
-        results = (vDiff < results)? vDiff : results;
+                                    (4 << 12) | (index << 8),
+                                    &samples[index]);
     }
 
     if (err == FM_OK)
     {
-        pLaneExt = GET_LANE_EXT(sw, serDes);
-
-        pLaneExt->dfeExt.eyeScoreHeight = results;
-        pLaneExt->dfeExt.eyeScoreHeightmV = (results * 1000) / 256;
-
-        if (pEyeScore)
-        {
-            *pEyeScore = pLaneExt->dfeExt.eyeScoreHeight;
-        }
-
-        if (pHeightmV)
-        {
-            *pHeightmV = pLaneExt->dfeExt.eyeScoreHeightmV;
-        }
+        SetEyeSimpleMetric(sw, serDes, samples, pEyeScore, pHeightmV);
     }
     else
     {
@@ -3058,6 +3106,155 @@ static fm_status SbusReadExt(fm_int     sw,
 
 
 
+/*****************************************************************************/
+/** SerdesCheckSpicoFw
+ * \ingroup intSerdes
+ *
+ * \desc            Verifies the CRC, the image version and the image build for
+ *                  every active serdes in the range [firstSerdes, lastSerdes].
+ *                  The CRC interrupt is first issued to every serdes reached
+ *                  over the sBus and the results are collected afterwards, so
+ *                  that the SPICOs compute their CRCs concurrently. Serdes
+ *                  using the parallel interface are checked one at a time.
+ *                  This function does not stop on errors.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       firstSerdes is the first serdes to check.
+ *
+ * \param[in]       lastSerdes is the last serdes to check
+ *
+ * \param[in]       expectedCodeVersionBuildId is the expected version (upper
+ *                  16 bits) and build-Id (lower 16 bits)
+ *
+ * \param[in]       logErrors specifies whether mismatches must be reported
+ *                  as errors.
+ *
+ * \return          FM_OK if CRC, version and build-Id are the expected ones
+ *                  for all serdes.
+ * \return          FM_ERR_INVALID_ARGUMENT if the serdes range is invalid.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status SerdesCheckSpicoFw(fm_int     sw,
+                                    fm_int     firstSerdes,
+                                    fm_int     lastSerdes,
+                                    fm_uint32  expectedCodeVersionBuildId,
+                                    fm_bool    logErrors)
+{
+    fm_status   err;
+    fm_status   localErr;
+    fm_status   crcErr[FM10000_NUM_SERDES];
+    fm_bool     crcPending[FM10000_NUM_SERDES];
+    fm_int      serdes;
+    fm_uint32   crc;
+    fm_uint32   versionBuildId;
+    fm_int      serdesDbgLvl;
+
+    if (firstSerdes < 0                   ||
+        lastSerdes >= FM10000_NUM_SERDES  ||
+        firstSerdes > lastSerdes)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    err = FM_OK;
+    versionBuildId = 0;
+
+    serdesDbgLvl = GET_FM10000_PROPERTY()->serdesDbgLevel;
+
+    /* Start the CRC computation on all the serdes before waiting on any */
+    for (serdes = firstSerdes; serdes <= lastSerdes; serdes++)
+    {
+        crcErr[serdes]     = FM_OK;
+        crcPending[serdes] = FALSE;
+
+        if ( fm10000SerdesCheckIfIsActive(sw, serdes) &&
+             fm10000SerdesSpicoIntUsesSBus(sw, serdes) )
+        {
+            crcErr[serdes] = fm10000SerdesSpicoIntSBusWrite(sw,
+                                                            serdes,
+                                                            FM10000_SPICO_SERDES_INTR_0X3C,
+                                                            0);
+            crcPending[serdes] = (crcErr[serdes] == FM_OK);
+        }
+    }
+
+    for (serdes = firstSerdes; serdes <= lastSerdes; serdes++)
+    {
+
+        if (!fm10000SerdesCheckIfIsActive(sw, serdes))
+        {
+            continue;
+        }
+
+        localErr = crcErr[serdes];
+
+        if (crcPending[serdes])
+        {
+            localErr = fm10000SerdesSpicoIntSBusRead(sw, serdes, &crc);
+
+            if (localErr == FM_OK && crc != 0)
+            {
+                localErr = FM_FAIL;
+                FM_LOG_DEBUG_V2(FM_LOG_CAT_SERDES, serdes,
+                                "SerDes CRC FAILED on serdes 0x%02x. CRC interrupt returned 0x%4.4x\n",
+                                serdes,
+                                crc);
+            }
+        }
+        else if (localErr == FM_OK)
+        {
+            localErr = fm10000SerdesSpicoDoCrc(sw, serdes);
+        }
+
+        if (localErr == FM_OK)
+        {
+             localErr = fm10000SerDesGetBuildRevisionId(sw, serdes, &versionBuildId);
+
+             if (localErr == FM_OK)
+             {
+                if ( versionBuildId != expectedCodeVersionBuildId)
+                {
+                    localErr = FM_FAIL;
+
+                    if (logErrors)
+                    {
+                        FM_LOG_ERROR(FM_LOG_CAT_SERDES, "EPL ring: Serdes %d: Bad image Version/Build-Id=0x%8.8x, expected=0x%8.8x\n",
+                                     serdes,
+                                     versionBuildId,
+                                     expectedCodeVersionBuildId);
+                    }
+                }
+                else if (serdesDbgLvl > 0)
+                {
+                    FM_LOG_PRINT(" EPL ring, SerDes #%d: CRC is OK, image version=0x%4.4x, BuildId=0x%4.4x\n",
+                                 serdes,
+                                 versionBuildId >> 16,
+                                 versionBuildId & 0xFFFF);
+                }
+             }
+             else if (logErrors)
+             {
+                 FM_LOG_ERROR(FM_LOG_CAT_SERDES, "EPL ring: Cannot verify Serdes SPICO Version and/or Build-Id, serdes=%d\n", serdes);
+             }
+        }
+        else if (logErrors)
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_SERDES, "EPL ring: Bad CRC on serdes #%d\n", serdes);
+        }
+
+
+        err = (err != FM_OK)? err : localErr;
+    }
+
+    return err;
+
+}
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -4955,10 +5152,6 @@ fm_status fm10000SerdesChckCrcVersionBuildId(fm_int     sw,
                                              fm_uint32  expectedCodeVersionBuildId)
 {
     fm_status   err;
-    fm_status   localErr;
-    fm_int      serdes;
-    fm_uint32   versionBuildId;
-    fm_int      serdesDbgLvl;
 
 
     FM_LOG_ENTRY(FM_LOG_CAT_SERDES,
@@ -4968,76 +5161,94 @@ fm_status fm10000SerdesChckCrcVersionBuildId(fm_int     sw,
                  lastSerdes,
                  expectedCodeVersionBuildId);
 
-    err = FM_OK;
-    versionBuildId = 0;
-
-    serdesDbgLvl = GET_FM10000_PROPERTY()->serdesDbgLevel;
+    err = SerdesCheckSpicoFw(sw,
+                             firstSerdes,
+                             lastSerdes,
+                             expectedCodeVersionBuildId,
+                             TRUE);
 
-    for (serdes = firstSerdes; serdes <= lastSerdes; serdes++)
+    if (err == FM_OK)
     {
+        FM_LOG_DEBUG(FM_LOG_CAT_SERDES, "EPL ring, all SerDes: CRC is OK, image version=0x%4.4x, BuildId=0x%4.4x\n",
+                     expectedCodeVersionBuildId >> 16,
+                     expectedCodeVersionBuildId & 0xFFFF);
 
-        if (!fm10000SerdesCheckIfIsActive(sw, serdes))
+        if (GET_FM10000_PROPERTY()->serdesDbgLevel > 0)
         {
-            continue;
+            FM_LOG_PRINT(" EPL ring, all SerDes are OK\n");
         }
+    }
 
 
-        localErr = fm10000SerdesSpicoDoCrc(sw, serdes);
+    FM_LOG_EXIT(FM_LOG_CAT_SERDES, err);
 
-        if (localErr == FM_OK)
-        {
-             localErr = fm10000SerDesGetBuildRevisionId(sw, serdes, &versionBuildId);
+}
 
-             if (localErr == FM_OK)
-             {
-                if ( versionBuildId != expectedCodeVersionBuildId)
-                {
-                    localErr = FM_FAIL;
 
-                    FM_LOG_ERROR(FM_LOG_CAT_SERDES, "EPL ring: Serdes %d: Bad image Version/Build-Id=0x%8.8x, expected=0x%8.8x\n",
-                                 serdes,
-                                 versionBuildId,
-                                 expectedCodeVersionBuildId);
-                }
-                else if (serdesDbgLvl > 0)
-                {
-                    FM_LOG_PRINT(" EPL ring, SerDes #%d: CRC is OK, image version=0x%4.4x, BuildId=0x%4.4x\n",
-                                 serdes,
-                                 versionBuildId >> 16,
-                                 versionBuildId && 0xFFFF);
-                }
-             }
-             else
-             {
-                 FM_LOG_ERROR(FM_LOG_CAT_SERDES, "EPL ring: Cannot verify Serdes SPICO Version and/or Build-Id, serdes=%d\n", serdes);
-             }
-        }
-        else
-        {
-            FM_LOG_ERROR(FM_LOG_CAT_SERDES, "EPL ring: Bad CRC on serdes #%d\n", serdes);
-        }
 
 
-        err = (err != FM_OK)? err : localErr;
-    }
+/*****************************************************************************/
+/**  fm10000SerdesIsSpicoFwLoaded
+ * \ingroup intSerdes
+ *
+ * \desc            Determines whether every active serdes in the range
+ *                  [firstSerdes, lastSerdes] is already running the expected
+ *                  SPICO image with a valid CRC, in which case the image does
+ *                  not need to be uploaded again. Mismatches are not reported
+ *                  as errors.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       firstSerdes is the first serdes to check.
+ *
+ * \param[in]       lastSerdes is the last serdes to check
+ *
+ * \param[in]       expectedCodeVersionBuildId is the expected version (upper
+ *                  16 bits) and build-Id (lower 16 bits)
+ *
+ * \param[out]      pLoaded points to caller-allocated storage where this
+ *                  function will place TRUE if the expected image is loaded
+ *                  on all serdes, FALSE otherwise.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if pLoaded is NULL.
+ *
+ *****************************************************************************/
+fm_status fm10000SerdesIsSpicoFwLoaded(fm_int     sw,
+                                       fm_int     firstSerdes,
+                                       fm_int     lastSerdes,
+                                       fm_uint32  expectedCodeVersionBuildId,
+                                       fm_bool   *pLoaded)
+{
+    fm_status   err;
 
-    if (err == FM_OK)
-    {
-        FM_LOG_DEBUG(FM_LOG_CAT_SERDES, "EPL ring, all SerDes: CRC is OK, image version=0x%4.4x, BuildId=0x%4.4x\n",
-                     expectedCodeVersionBuildId >> 16,
-                     expectedCodeVersionBuildId && 0xFFFF);
 
-        if (GET_FM10000_PROPERTY()->serdesDbgLevel > 0)
-        {
-            if (versionBuildId > 0)
-            {
-                FM_LOG_PRINT(" EPL ring, all SerDes are OK\n");
-            }
-        }
+    FM_LOG_ENTRY(FM_LOG_CAT_SERDES,
+                 "sw=%d, firstSerdes=%d, lastSerdes=%d, expectedCodeVersionBuildId=0x%8.8x\n",
+                 sw,
+                 firstSerdes,
+                 lastSerdes,
+                 expectedCodeVersionBuildId);
+
+    if (pLoaded == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_SERDES, FM_ERR_INVALID_ARGUMENT);
     }
 
+    err = SerdesCheckSpicoFw(sw,
+                             firstSerdes,
+                             lastSerdes,
+                             expectedCodeVersionBuildId,
+                             FALSE);
 
-    FM_LOG_EXIT(FM_LOG_CAT_SERDES, err);
+    *pLoaded = (err == FM_OK);
+
+    FM_LOG_DEBUG(FM_LOG_CAT_SERDES,
+                 "EPL ring: SerDes SPICO image 0x%8.8x %s loaded\n",
+                 expectedCodeVersionBuildId,
+                 (*pLoaded) ? "is" : "is not");
+
+    FM_LOG_EXIT(FM_LOG_CAT_SERDES, FM_OK);
 
 }
 
@@ -10060,6 +10271,136 @@ fm_status fm10000SerdesGetEyeHeight(fm_int  sw,
 
 
 
+/*****************************************************************************/
+/** fm10000SerdesGetEyeHeightBatch
+ * \ingroup intSerdes
+ *
+ * \desc            Computes the simple eye metric on several SerDes at once.
+ *                  Each of the 0x26 reads is started on every SerDes reached
+ *                  over the sBus before any result is collected, so the
+ *                  SPICO processors work in parallel. SerDes using the
+ *                  SAI/PCIe interface are measured one at a time.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numSerdes is the number of entries in serdesList.
+ *
+ * \param[in]       serdesList is the list of SerDes to measure.
+ *
+ * \param[out]      pEyeScore points to an array of numSerdes entries where
+ *                  this function will return the eye metric [0..64], or -1
+ *                  on failure.
+ *
+ * \param[out]      pHeightmV points to an array of numSerdes entries where
+ *                  this function will return the eye height in mV.
+ *
+ * \param[out]      pLaneErr points to an array of numSerdes entries where
+ *                  this function will return the status of each SerDes.
+ *
+ * \return          FM_OK if the batch was processed; per-SerDes errors are
+ *                  returned in pLaneErr.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_UNINITIALIZED if the SerDes services are not
+ *                  initialized.
+ *
+ *****************************************************************************/
+fm_status fm10000SerdesGetEyeHeightBatch(fm_int        sw,
+                                         fm_int        numSerdes,
+                                         const fm_int *serdesList,
+                                         fm_int       *pEyeScore,
+                                         fm_int       *pHeightmV,
+                                         fm_status    *pLaneErr)
+{
+    fm10000_serdes  *serdesPtr;
+    fm10000_switch  *switchExt;
+    fm_uint32        samples[FM10000_NUM_SERDES][EYE_METRIC_NUM_SAMPLES];
+    fm_bool          useSBus[FM10000_NUM_SERDES];
+    fm_uint          index;
+    fm_int           i;
+
+    if ( numSerdes < 0 || numSerdes > FM10000_NUM_SERDES ||
+         serdesList == NULL || pEyeScore == NULL ||
+         pHeightmV == NULL  || pLaneErr == NULL )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    switchExt = GET_SWITCH_EXT(sw);
+    serdesPtr = &switchExt->serdesXServices;
+
+    if (serdesPtr->magicNumber != FM10000_SERDES_STRUCT_MAGIG_NUMBER)
+    {
+        return FM_ERR_UNINITIALIZED;
+    }
+
+    for (i = 0; i < numSerdes; i++)
+    {
+        pLaneErr[i] = FM_OK;
+        useSBus[i]  = (serdesPtr->SerdesGetEyeHeight == SerdesGetEyeSimpleMetric) &&
+                      fm10000SerdesSpicoIntUsesSBus(sw, serdesList[i]);
+
+        if (!useSBus[i])
+        {
+            pLaneErr[i] = fm10000SerdesGetEyeHeight(sw,
+                                                    serdesList[i],
+                                                    &pEyeScore[i],
+                                                    &pHeightmV[i]);
+        }
+    }
+
+    for (index = 0; index < EYE_METRIC_NUM_SAMPLES; index++)
+    {
+        for (i = 0; i < numSerdes; i++)
+        {
+            if (useSBus[i] && pLaneErr[i] == FM_OK)
+            {
+                pLaneErr[i] = fm10000SerdesSpicoIntSBusWrite(sw,
+                                                             serdesList[i],
+                                                             FM10000_SPICO_SERDES_INTR_0X26_READ,
+                                                             (4 << 12) | (index << 8));
+            }
+        }
+
+        for (i = 0; i < numSerdes; i++)
+        {
+            if (useSBus[i] && pLaneErr[i] == FM_OK)
+            {
+                pLaneErr[i] = fm10000SerdesSpicoIntSBusRead(sw,
+                                                            serdesList[i],
+                                                            &samples[i][index]);
+            }
+        }
+    }
+
+    for (i = 0; i < numSerdes; i++)
+    {
+        if (!useSBus[i])
+        {
+            continue;
+        }
+
+        if (pLaneErr[i] == FM_OK)
+        {
+            SetEyeSimpleMetric(sw,
+                               serdesList[i],
+                               samples[i],
+                               &pEyeScore[i],
+                               &pHeightmV[i]);
+        }
+        else
+        {
+            pEyeScore[i] = -1;
+            pHeightmV[i] = 0;
+        }
+    }
+
+    return FM_OK;
+
+}
+
+
+
+
 /*****************************************************************************/
 /** fm10000SerDesGetEyeHeightnWidth
  * \ingroup intSerdes
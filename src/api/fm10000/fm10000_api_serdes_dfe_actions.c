@@ -49,6 +49,9 @@ static fm_status StartTimeoutTimer(fm_smEventInfo *eventInfo,
                                    void           *userInfo,
                                    fm_timestamp   *pTimeout);
 static void HandleDfeTuningTimeout(void *arg);
+static fm_status StartICalTuning(fm_int           sw,
+                                 fm_int           serDes,
+                                 fm10000_laneDfe *pLaneDfe);
 
 
 /*****************************************************************************
@@ -209,6 +212,45 @@ fm_status StartTimeoutTimer(fm_smEventInfo *eventInfo,
 
 
 
+/*****************************************************************************/
+/** StartICalTuning
+ * \ingroup intSerDesDfe
+ *
+ * \desc            Starts iCal tuning on a serdes that has been granted a
+ *                  tuning slot.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       serDes is the serdes number.
+ *
+ * \param[in]       pLaneDfe points to the DFE extension of the serdes.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status StartICalTuning(fm_int           sw,
+                                 fm_int           serDes,
+                                 fm10000_laneDfe *pLaneDfe)
+{
+    fm_status err;
+
+    pLaneDfe->refTimeMs = fm10000SerdesGetTimestampMs();
+
+    err = fm10000SerdesIncrStatsCounter(sw,serDes,0);
+
+    if (err == FM_OK)
+    {
+        err = fm10000SerdesDfeTuningStartICal(sw, serDes);
+    }
+
+    return err;
+
+}   /* end StartICalTuning */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -377,17 +419,16 @@ fm_status fm10000SerDesDfeStartTuning(fm_smEventInfo *eventInfo,
 
 
     pLaneDfe->dfeAdaptive = (pLaneExt->dfeMode == FM_DFE_MODE_CONTINUOUS);
-    pLaneDfe->refTimeMs = fm10000SerdesGetTimestampMs();
     pLaneDfe->pause = FALSE;
     pLaneExt->dfeExt.sendDfeComplete = FALSE;
     pLaneExt->dfeExt.pCalKrMode = FALSE;
 
-    err = fm10000SerdesIncrStatsCounter(sw,serDes,0);
+    /* iCal is started by the timeout handler if no slot is free now */
+    err = FM_OK;
 
-    if (err == FM_OK)
+    if (fm10000SerdesDfeSchedRequest(sw, serDes))
     {
-
-        err = fm10000SerdesDfeTuningStartICal(sw, serDes);
+        err = StartICalTuning(sw, serDes, pLaneDfe);
     }
 
     return err;
@@ -987,6 +1028,8 @@ fm_status fm10000SerDesDfeStopTuning(fm_smEventInfo *eventInfo,
     serDes = ((fm10000_dfeSmEventInfo *)userInfo)->laneExt->serDes;
     sw     = ((fm10000_dfeSmEventInfo *)userInfo)->switchPtr->switchNumber;
 
+    fm10000SerdesDfeSchedCancel(sw, serDes);
+
     err = fm10000SerdesDfeTuningStop(sw,serDes);
 
     return err;
@@ -1395,6 +1438,20 @@ fm_status fm10000SerDesDfeProcessICalTimeout(fm_smEventInfo *eventInfo,
     iCalInProgress = FALSE;
     iCalSuccessful = FALSE;
 
+    if (pLaneDfe->schedWaiting)
+    {
+        /* still waiting for a tuning slot: retry on every short timeout */
+        if (fm10000SerdesDfeSchedTryGrant(sw, serDes))
+        {
+            err = StartICalTuning(sw, serDes, pLaneDfe);
+        }
+
+        err2 = fm10000SerDesDfeStartTimeoutTimerShrt(eventInfo, userInfo);
+        eventInfo->dontSaveRecord = TRUE;
+
+        return (err != FM_OK) ? err : err2;
+    }
+
     if (pLaneDfe->cycleCntr == 0)
     {
 
@@ -1421,6 +1478,9 @@ fm_status fm10000SerDesDfeProcessICalTimeout(fm_smEventInfo *eventInfo,
 
                 fm10000SerdesSaveICalTuningStatsInfo(sw,serDes,pLaneDfe->cycleCntr + 1);
                 fm10000SerdesSaveICalTuningDelayInfo(sw,serDes);
+                fm10000SerdesDfeSchedRecordTuning(sw,
+                                                  FALSE,
+                                                  pLaneDfe->iCalDelayLastMs);
                 pLaneDfe->refTimeMs = fm10000SerdesGetTimestampMs();
                 pLaneDfe->cycleCntr = -1;
 
@@ -1473,13 +1533,13 @@ fm_status fm10000SerDesDfeProcessICalTimeout(fm_smEventInfo *eventInfo,
             else
             {
 
-                pLaneDfe->cycleCntr = FM10000_SERDES_ICAL_TUNING_MAX_CYCLES;
+                pLaneDfe->cycleCntr = fm10000SerdesDfeSchedGetMaxCycles(sw, FALSE);
             }
         }
     }
 
 
-    if (++pLaneDfe->cycleCntr > FM10000_SERDES_ICAL_TUNING_MAX_CYCLES )
+    if (++pLaneDfe->cycleCntr > fm10000SerdesDfeSchedGetMaxCycles(sw, FALSE) )
     {
         err = fm10000SerDesDfeStopTuning(eventInfo,userInfo);
 
@@ -1574,6 +1634,9 @@ fm_status fm10000SerDesDfeProcessPCalTimeout(fm_smEventInfo *eventInfo,
 
             fm10000SerdesSavePCalTuningStatsInfo(sw,serDes,pLaneDfe->cycleCntr + 1);
             fm10000SerdesSavePCalTuningDelayInfo(sw,serDes);
+            fm10000SerdesDfeSchedRecordTuning(sw,
+                                              TRUE,
+                                              pLaneDfe->pCalDelayLastMs);
         }
         else
         {
@@ -1609,7 +1672,7 @@ fm_status fm10000SerDesDfeProcessPCalTimeout(fm_smEventInfo *eventInfo,
     else
     {
 
-        if (++pLaneDfe->cycleCntr > FM10000_SERDES_DFE_TUNING_MAX_CYCLES )
+        if (++pLaneDfe->cycleCntr > fm10000SerdesDfeSchedGetMaxCycles(sw, TRUE) )
         {
 
             err = fm10000SerDesDfeStopTuning(eventInfo,userInfo);
@@ -0,0 +1,513 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm10000_api_serdes_dfe_sched.c
+ * Creation Date:   October 15, 2026
+ * Description:     Scheduling of concurrent DFE tunings on the FM10000
+ *                  SBus rings and learning of the tuning timeouts
+ *
+ * Copyright (c) 2014 - 2015, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <fm_sdk_fm10000_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* Weight of a new sample in the tuning duration average (1/2^N) */
+#define DFE_SCHED_AVG_SHIFT     3
+
+
+/*****************************************************************************
+ * Local function prototypes
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** GetLaneDfe
+ * \ingroup intSerDesDfe
+ *
+ * \desc            Returns the DFE extension of a serdes, if the lane has
+ *                  been initialized.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       serDes is the serdes number.
+ *
+ * \return          Pointer to the DFE extension or NULL.
+ *
+ *****************************************************************************/
+static fm10000_laneDfe *GetLaneDfe(fm_int sw, fm_int serDes)
+{
+    fm_switch    *switchPtr;
+    fm10000_lane *pLaneExt;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->laneTable == NULL || switchPtr->laneTable[serDes] == NULL)
+    {
+        return NULL;
+    }
+
+    pLaneExt = GET_LANE_EXT(sw, serDes);
+
+    if (pLaneExt == NULL || pLaneExt->dfeExt.smHandle == NULL)
+    {
+        return NULL;
+    }
+
+    return &pLaneExt->dfeExt;
+
+}   /* end GetLaneDfe */
+
+
+
+
+/*****************************************************************************/
+/** GetLanePriority
+ * \ingroup intSerDesDfe
+ *
+ * \desc            Returns the scheduling priority of a serdes. Lanes of the
+ *                  uplink EPLs are served first, then faster lanes before
+ *                  slower ones. Lower values are served first.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       serDes is the serdes number.
+ *
+ * \return          The priority of the serdes.
+ *
+ *****************************************************************************/
+static fm_int GetLanePriority(fm_int sw, fm_int serDes)
+{
+    fm10000_lane *pLaneExt;
+    fm_int        bitRate;
+    fm_int        uplinkMask;
+    fm_bool       isUplink;
+
+    pLaneExt   = GET_LANE_EXT(sw, serDes);
+    uplinkMask = GET_FM10000_PROPERTY()->dfeUplinkEplMask;
+
+    bitRate = pLaneExt->bitRate;
+    if (bitRate < 0 || bitRate >= FM10000_LANE_BITRATE_MAX)
+    {
+        bitRate = FM10000_LANE_BITRATE_MAX;
+    }
+
+    isUplink = ( pLaneExt->epl >= 0 &&
+                 pLaneExt->epl < 32 &&
+                 (uplinkMask & (1 << pLaneExt->epl)) != 0 );
+
+    return (isUplink ? 0 : (FM10000_LANE_BITRATE_MAX + 1)) + bitRate;
+
+}   /* end GetLanePriority */
+
+
+
+
+/*****************************************************************************/
+/** UpdateHistory
+ * \ingroup intSerDesDfe
+ *
+ * \desc            Adds a tuning duration sample to a history record.
+ *
+ * \param[in,out]   hist points to the history record.
+ *
+ * \param[in]       durationMs is the tuning duration, in milliseconds.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void UpdateHistory(fm10000_dfeTuningHist *hist, fm_uint32 durationMs)
+{
+
+    if (hist->samples == 0)
+    {
+        hist->avgMs = durationMs;
+    }
+    else
+    {
+        hist->avgMs = hist->avgMs -
+                      (hist->avgMs >> DFE_SCHED_AVG_SHIFT) +
+                      (durationMs >> DFE_SCHED_AVG_SHIFT);
+    }
+
+    if (durationMs > hist->maxMs)
+    {
+        hist->maxMs = durationMs;
+    }
+
+    if (hist->samples < 0xffffffff)
+    {
+        hist->samples++;
+    }
+
+}   /* end UpdateHistory */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fm10000SerdesDfeSchedRequest
+ * \ingroup intSerDesDfe
+ *
+ * \desc            Queues a serdes for DFE tuning and tries to grant it a
+ *                  tuning slot on its SBus ring right away.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       serDes is the serdes number.
+ *
+ * \return          TRUE if the serdes may start tuning now.
+ * \return          FALSE if the tuning has been deferred.
+ *
+ *****************************************************************************/
+fm_bool fm10000SerdesDfeSchedRequest(fm_int sw, fm_int serDes)
+{
+    fm10000_switch  *switchExt;
+    fm10000_laneDfe *pLaneDfe;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    pLaneDfe  = &((fm10000_lane *) GET_LANE_EXT(sw, serDes))->dfeExt;
+
+    pLaneDfe->schedWaiting = TRUE;
+    pLaneDfe->schedSeq     = switchExt->dfeSched.nextSeq++;
+
+    return fm10000SerdesDfeSchedTryGrant(sw, serDes);
+
+}   /* end fm10000SerdesDfeSchedRequest */
+
+
+
+
+/*****************************************************************************/
+/** fm10000SerdesDfeSchedTryGrant
+ * \ingroup intSerDesDfe
+ *
+ * \desc            Tries to grant a tuning slot to a deferred serdes. A slot
+ *                  is granted when the number of lanes tuning on the same
+ *                  SBus ring, plus the number of deferred lanes on that ring
+ *                  that rank ahead of this one, is below
+ *                  ''api.FM10000.dfe.maxConcurrentTunings''.
+ *                                                                      \lb\lb
+ *                  Lanes tuning are derived from the DFE state machine
+ *                  states, so a lane that is reset or stopped releases its
+ *                  slot implicitly.
+ *
+ * \note            Must be called with the state lock held.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       serDes is the serdes number.
+ *
+ * \return          TRUE if the serdes may start tuning now.
+ * \return          FALSE if the tuning remains deferred.
+ *
+ *****************************************************************************/
+fm_bool fm10000SerdesDfeSchedTryGrant(fm_int sw, fm_int serDes)
+{
+    fm10000_switch  *switchExt;
+    fm10000_laneDfe *pLaneDfe;
+    fm10000_laneDfe *pOtherDfe;
+    fm_serdesRing    ring;
+    fm_serdesRing    otherRing;
+    fm_uint          sbusAddr;
+    fm_int           maxTunings;
+    fm_int           priority;
+    fm_int           otherPriority;
+    fm_int           state;
+    fm_int           busy;
+    fm_int           s;
+
+    switchExt  = GET_SWITCH_EXT(sw);
+    pLaneDfe   = &((fm10000_lane *) GET_LANE_EXT(sw, serDes))->dfeExt;
+    maxTunings = GET_FM10000_PROPERTY()->dfeMaxConcurrentTunings;
+
+    if (!pLaneDfe->schedWaiting)
+    {
+        return TRUE;
+    }
+
+    if ( maxTunings > 0 &&
+         fm10000MapSerdesToSbus(sw, serDes, &sbusAddr, &ring) == FM_OK )
+    {
+        priority = GetLanePriority(sw, serDes);
+        busy     = 0;
+
+        for (s = 0 ; s < FM10000_NUM_SERDES && busy < maxTunings ; s++)
+        {
+            if ( s == serDes ||
+                 fm10000MapSerdesToSbus(sw, s, &sbusAddr, &otherRing) != FM_OK ||
+                 otherRing != ring )
+            {
+                continue;
+            }
+
+            pOtherDfe = GetLaneDfe(sw, s);
+
+            if ( pOtherDfe == NULL ||
+                 fmGetStateMachineCurrentState(pOtherDfe->smHandle,
+                                               &state) != FM_OK )
+            {
+                continue;
+            }
+
+            if (!pOtherDfe->schedWaiting)
+            {
+                if ( state == FM10000_SERDES_DFE_STATE_WAIT_ICAL ||
+                     state == FM10000_SERDES_DFE_STATE_WAIT_PCAL )
+                {
+                    busy++;
+                }
+            }
+            else if (state == FM10000_SERDES_DFE_STATE_WAIT_ICAL)
+            {
+                otherPriority = GetLanePriority(sw, s);
+
+                if ( otherPriority < priority ||
+                     ( otherPriority == priority &&
+                       (fm_int32) (pOtherDfe->schedSeq -
+                                   pLaneDfe->schedSeq) < 0 ) )
+                {
+                    busy++;
+                }
+            }
+        }
+
+        if (busy >= maxTunings)
+        {
+            switchExt->dfeSched.deferCnt++;
+            return FALSE;
+        }
+    }
+
+    pLaneDfe->schedWaiting = FALSE;
+    switchExt->dfeSched.grantCnt++;
+
+    return TRUE;
+
+}   /* end fm10000SerdesDfeSchedTryGrant */
+
+
+
+
+/*****************************************************************************/
+/** fm10000SerdesDfeSchedCancel
+ * \ingroup intSerDesDfe
+ *
+ * \desc            Removes a serdes from the tuning queue.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       serDes is the serdes number.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000SerdesDfeSchedCancel(fm_int sw, fm_int serDes)
+{
+
+    ((fm10000_lane *) GET_LANE_EXT(sw, serDes))->dfeExt.schedWaiting = FALSE;
+
+}   /* end fm10000SerdesDfeSchedCancel */
+
+
+
+
+/*****************************************************************************/
+/** fm10000SerdesDfeSchedRecordTuning
+ * \ingroup intSerDesDfe
+ *
+ * \desc            Records the duration of a successful iCal or pCal tuning
+ *                  in the per-switch history used to learn the timeouts.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       pCal is TRUE for a pCal tuning, FALSE for an iCal one.
+ *
+ * \param[in]       durationMs is the tuning duration, in milliseconds.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000SerdesDfeSchedRecordTuning(fm_int    sw,
+                                       fm_bool   pCal,
+                                       fm_uint32 durationMs)
+{
+    fm10000_switch *switchExt;
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    UpdateHistory(pCal ? &switchExt->dfeSched.pCalHist :
+                         &switchExt->dfeSched.iCalHist,
+                  durationMs);
+
+}   /* end fm10000SerdesDfeSchedRecordTuning */
+
+
+
+
+/*****************************************************************************/
+/** fm10000SerdesDfeSchedGetMaxCycles
+ * \ingroup intSerDesDfe
+ *
+ * \desc            Returns the maximum number of short timeout cycles a
+ *                  tuning phase may last before it is declared failed.
+ *                                                                      \lb\lb
+ *                  Once enough durations have been recorded and
+ *                  ''api.FM10000.dfe.adaptiveTimeout'' is enabled, the limit
+ *                  is the larger of four times the average and twice the
+ *                  maximum observed duration, bounded by
+ *                  FM10000_SERDES_DFE_SCHED_MIN_LIMIT_MS and by the fixed
+ *                  limits that are used otherwise.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       pCal is TRUE for a pCal tuning, FALSE for an iCal one.
+ *
+ * \return          The maximum number of cycles.
+ *
+ *****************************************************************************/
+fm_int fm10000SerdesDfeSchedGetMaxCycles(fm_int sw, fm_bool pCal)
+{
+    fm10000_switch        *switchExt;
+    fm10000_dfeTuningHist *hist;
+    fm_int                 maxCycles;
+    fm_uint32              limitMs;
+    fm_int                 cycles;
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    if (pCal)
+    {
+        hist      = &switchExt->dfeSched.pCalHist;
+        maxCycles = FM10000_SERDES_DFE_TUNING_MAX_CYCLES;
+    }
+    else
+    {
+        hist      = &switchExt->dfeSched.iCalHist;
+        maxCycles = FM10000_SERDES_ICAL_TUNING_MAX_CYCLES;
+    }
+
+    if ( !GET_FM10000_PROPERTY()->dfeAdaptiveTimeout ||
+         hist->samples < FM10000_SERDES_DFE_SCHED_MIN_SAMPLES )
+    {
+        return maxCycles;
+    }
+
+    limitMs = hist->avgMs * 4;
+
+    if (limitMs < hist->maxMs * 2)
+    {
+        limitMs = hist->maxMs * 2;
+    }
+
+    if (limitMs < FM10000_SERDES_DFE_SCHED_MIN_LIMIT_MS)
+    {
+        limitMs = FM10000_SERDES_DFE_SCHED_MIN_LIMIT_MS;
+    }
+
+    cycles = (fm_int) ( (limitMs + (FM10000_SERDES_DFE_SHORT_TIMEOUT / 1000) - 1) /
+                        (FM10000_SERDES_DFE_SHORT_TIMEOUT / 1000) );
+
+    return (cycles < maxCycles) ? cycles : maxCycles;
+
+}   /* end fm10000SerdesDfeSchedGetMaxCycles */
+
+
+
+
+/*****************************************************************************/
+/** fm10000DbgDumpDfeSched
+ * \ingroup intDiagPorts
+ *
+ * \desc            Dumps the state of the DFE tuning scheduler.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000DbgDumpDfeSched(fm_int sw)
+{
+    fm10000_switch  *switchExt;
+    fm10000_laneDfe *pLaneDfe;
+    fm_int           serDes;
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    FM_LOG_PRINT("DFE tuning scheduler, switch %d\n", sw);
+    FM_LOG_PRINT("  maxConcurrentTunings : %d\n",
+                 GET_FM10000_PROPERTY()->dfeMaxConcurrentTunings);
+    FM_LOG_PRINT("  grants/deferrals     : %u/%u\n",
+                 switchExt->dfeSched.grantCnt,
+                 switchExt->dfeSched.deferCnt);
+    FM_LOG_PRINT("  iCal samples/avg/max : %u/%u/%u ms, limit %d cycles\n",
+                 switchExt->dfeSched.iCalHist.samples,
+                 switchExt->dfeSched.iCalHist.avgMs,
+                 switchExt->dfeSched.iCalHist.maxMs,
+                 fm10000SerdesDfeSchedGetMaxCycles(sw, FALSE));
+    FM_LOG_PRINT("  pCal samples/avg/max : %u/%u/%u ms, limit %d cycles\n",
+                 switchExt->dfeSched.pCalHist.samples,
+                 switchExt->dfeSched.pCalHist.avgMs,
+                 switchExt->dfeSched.pCalHist.maxMs,
+                 fm10000SerdesDfeSchedGetMaxCycles(sw, TRUE));
+
+    for (serDes = 0 ; serDes < FM10000_NUM_SERDES ; serDes++)
+    {
+        pLaneDfe = GetLaneDfe(sw, serDes);
+
+        if (pLaneDfe != NULL && pLaneDfe->schedWaiting)
+        {
+            FM_LOG_PRINT("  serdes %2d waiting, seq %u, priority %d\n",
+                         serDes,
+                         pLaneDfe->schedSeq,
+                         GetLanePriority(sw, serDes));
+        }
+    }
+
+    return FM_OK;
+
+}   /* end fm10000DbgDumpDfeSched */
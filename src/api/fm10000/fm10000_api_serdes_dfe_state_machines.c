@@ -1757,6 +1757,13 @@ fm_status fm10000RegisterBasicSerDesDfeStateMachine( void )
                                              dynstt,
                                              logCallback,
                                              TRUE ); 
+    if ( status != FM_OK )
+    {
+        return status;
+    }
+
+    status = fmSetStateTransitionLogCategories( FM10000_BASIC_SERDES_DFE_STATE_MACHINE,
+                                                FM_LOG_CAT_SERDES );
     return status;
 
 }   /* end fm10000RegisterBasicSerDesDfeStateMachine */
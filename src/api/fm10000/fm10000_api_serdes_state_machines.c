@@ -7222,6 +7222,32 @@ fm_status fm10000RegisterBasicSerDesStateMachine( void )
                                              dynstt,
                                              logCallback,
                                              TRUE ); 
+    if ( status != FM_OK )
+    {
+        return status;
+    }
+
+    status = fmSetStateTransitionLogCategories( FM10000_BASIC_SERDES_STATE_MACHINE,
+                                                FM_LOG_CAT_SERDES );
+    if ( status != FM_OK )
+    {
+        return status;
+    }
+
+    /* only the latest signalOk indication of a batch matters */
+    status = fmSetStateMachineEventCoalesceGroup( 
+                                  FM10000_BASIC_SERDES_STATE_MACHINE,
+                                  FM10000_SERDES_EVENT_SIGNALOK_ASSERTED_IND,
+                                  FM10000_SERDES_COALESCE_SIGNALOK );
+    if ( status != FM_OK )
+    {
+        return status;
+    }
+
+    status = fmSetStateMachineEventCoalesceGroup( 
+                                  FM10000_BASIC_SERDES_STATE_MACHINE,
+                                  FM10000_SERDES_EVENT_SIGNALOK_DEASSERTED_IND,
+                                  FM10000_SERDES_COALESCE_SIGNALOK );
     return status;
 
 }   /* end fm10000RegisterBasicSerDesStateMachine */
@@ -7273,6 +7299,13 @@ fm_status fm10000RegisterPcieSerDesStateMachine( void )
                                              dynstt,
                                              logCallback,
                                              TRUE ); 
+    if ( status != FM_OK )
+    {
+        return status;
+    }
+
+    status = fmSetStateTransitionLogCategories( FM10000_PCIE_SERDES_STATE_MACHINE,
+                                                FM_LOG_CAT_SERDES );
     return status;
 
 }   /* end fm10000RegisterPcieSerDesStateMachine */
@@ -7354,6 +7387,13 @@ fm_status fm10000RegisterStubSerDesStateMachine( void )
                                              dynstt,
                                              logCallback,
                                              TRUE ); 
+    if ( status != FM_OK )
+    {
+        return status;
+    }
+
+    status = fmSetStateTransitionLogCategories( FM10000_STUB_SERDES_STATE_MACHINE,
+                                                FM_LOG_CAT_SERDES );
     return status;
 
 }   /* end fm10000RegisterStubSerDesStateMachine */
@@ -131,6 +131,93 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** FindSFlowByTrapCode
+ * \ingroup intSflow
+ *
+ * \desc            Returns the sFlow instance that trapped a received frame.
+ *                  Must be called with the sFlow lock taken.
+ *
+ * \param[in]       sw is the switch to operate on.
+ * 
+ * \param[in]       pktEvent points to the receive event of the frame.
+ *
+ * \param[out]      sflowId points to caller-allocated storage where this
+ *                  function places the sFlow identifier.
+ *
+ * \return          A pointer to the sFlow instance, NULL if the frame was
+ *                  not trapped by an sFlow.
+ *
+ *****************************************************************************/
+static fm10000_sflowEntry * FindSFlowByTrapCode(fm_int            sw,
+                                                fm_eventPktRecv * pktEvent,
+                                                fm_int *          sflowId)
+{
+    fm10000_sflowEntry *sflowEntry;
+    fm_int              sflowTrapCodeId;
+
+    sflowTrapCodeId   = pktEvent->trapAction - 
+                        FM10000_MIRROR_CPU_CODE_BASE -
+                        FM10000_SFLOW_TRAPCODE_ID_START;
+
+    for (*sflowId = 0 ; *sflowId < FM10000_MAX_SFLOWS ; ++(*sflowId))
+    {
+        sflowEntry = GetSflowEntry(sw, *sflowId);
+        if (sflowEntry && sflowEntry->isValid && 
+            sflowEntry->trapCodeId == sflowTrapCodeId)
+        {
+            return sflowEntry;
+        }
+    }
+
+    return NULL;
+
+}   /* end FindSFlowByTrapCode */
+
+
+
+
+/*****************************************************************************/
+/** ApplySampleRate
+ * \ingroup intSflow
+ *
+ * \desc            Programs the sampling rate of the mirror used by an
+ *                  SFlow, without changing its FM_SFLOW_SAMPLE_RATE.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ * 
+ * \param[in]       sflowEntry points to the SFlow.
+ * 
+ * \param[in]       sampleRate is the sample rate to program.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status ApplySampleRate(fm_int               sw,
+                                 fm10000_sflowEntry * sflowEntry,
+                                 fm_uint              sampleRate)
+{
+    fm_status err;
+
+    err = fmSetMirrorAttributeInt(sw, 
+                                  sflowEntry->mirrorId, 
+                                  FM_MIRROR_SAMPLE_RATE, 
+                                  (void *)&sampleRate);
+
+    if (err == FM_OK)
+    {
+        sflowEntry->activeRate     = sampleRate;
+        sflowEntry->rateCheckCount = sflowEntry->sampleCount;
+        sflowEntry->rateCheckTime  = fmGetMonotonicNsec();
+    }
+
+    return err;
+
+}   /* end ApplySampleRate */
+
+
+
+
 /*****************************************************************************/
 /** SetSampleRate
  * \ingroup intSflow
@@ -174,10 +261,7 @@ static fm_status SetSampleRate(fm_int sw, fm_int sflowId, fm_uint sampleRate)
 
     sflowEntry->sampleRate = sampleRate;
 
-    err = fmSetMirrorAttributeInt(sw, 
-                                  sflowEntry->mirrorId, 
-                                  FM_MIRROR_SAMPLE_RATE, 
-                                  (void *)&sampleRate);
+    err = ApplySampleRate(sw, sflowEntry, sampleRate);
 
 ABORT:
     FM_LOG_EXIT(FM_LOG_CAT_SFLOW, err);
@@ -354,6 +438,8 @@ fm_status fm10000FreeSFlows(fm_int sw)
         FM_ERR_COMBINE(retVal, err);
     }
 
+    fmFreeSFlowSampleRing(sw);
+
     FM_LOG_EXIT(FM_LOG_CAT_SFLOW, retVal);
 
 }   /* end fm10000FreeSFlows */
@@ -428,6 +514,8 @@ fm_status fm10000CreateSFlow(fm_int sw, fm_int sFlowId, fm_sFlowType sFlowType)
     sflowEntry->sampleRate  = 1;    /* is this correct? */
     sflowEntry->sflowType   = sFlowType;
     sflowEntry->vlanID      = FM_SFLOW_VLAN_ANY;
+    sflowEntry->truncLength = FM_SFLOW_NO_TRUNC;
+    sflowEntry->maxCpuRate  = 0;
 
     /**************************************************
      * Create mirror.
@@ -908,6 +996,35 @@ fm_status fm10000SetSFlowAttribute(fm_int sw,
             err = SetSampleRate(sw, sFlowId, *( (fm_uint *) value));
             break;
 
+        case FM_SFLOW_TRUNC_LENGTH:
+            if ( (*( (fm_int *) value) <= 0) &&
+                 (*( (fm_int *) value) != FM_SFLOW_NO_TRUNC) )
+            {
+                err = FM_ERR_INVALID_ARGUMENT;
+                break;
+            }
+
+            sflowEntry->truncLength = *( (fm_int *) value);
+            err = FM_OK;
+            break;
+
+        case FM_SFLOW_MAX_CPU_RATE:
+            sflowEntry->maxCpuRate = *( (fm_uint *) value);
+
+            /* Without a limit, go back to the configured rate. */
+            if ( (sflowEntry->maxCpuRate == 0) &&
+                 (sflowEntry->activeRate != sflowEntry->sampleRate) )
+            {
+                err = ApplySampleRate(sw, sflowEntry, sflowEntry->sampleRate);
+            }
+            else
+            {
+                sflowEntry->rateCheckCount = sflowEntry->sampleCount;
+                sflowEntry->rateCheckTime  = fmGetMonotonicNsec();
+                err = FM_OK;
+            }
+            break;
+
         default:
             err = FM_ERR_INVALID_SFLOW_ATTR;
             break;
@@ -1002,6 +1119,14 @@ fm_status fm10000GetSFlowAttribute(fm_int sw,
             *( (fm_uint *) value) = sflowEntry->sampleRate;
             break;
 
+        case FM_SFLOW_TRUNC_LENGTH:
+            *( (fm_int *) value) = sflowEntry->truncLength;
+            break;
+
+        case FM_SFLOW_MAX_CPU_RATE:
+            *( (fm_uint *) value) = sflowEntry->maxCpuRate;
+            break;
+
         default:
             err = FM_ERR_INVALID_SFLOW_ATTR;
             break;
@@ -1040,9 +1165,7 @@ fm_status fm10000CheckSFlowLogging(fm_int            sw,
                                    fm_eventPktRecv * pktEvent, 
                                    fm_bool         * isPktSFlowLogged)
 {
-    fm10000_sflowEntry *sflowEntry;
     fm_int              sflowId;
-    fm_int              sflowTrapCodeId;
 
     FM_LOG_ENTRY(FM_LOG_CAT_SFLOW,
                  "sw=%d, pktEvent=%p, isPktSFlowLogged=%p\n",
@@ -1050,29 +1173,166 @@ fm_status fm10000CheckSFlowLogging(fm_int            sw,
                  (void *) pktEvent,
                  (void *) isPktSFlowLogged);
 
-    *isPktSFlowLogged = FALSE;
-    sflowTrapCodeId   = pktEvent->trapAction - 
-                        FM10000_MIRROR_CPU_CODE_BASE -
-                        FM10000_SFLOW_TRAPCODE_ID_START;
+    TAKE_SFLOW_LOCK(sw);
+
+    *isPktSFlowLogged = (FindSFlowByTrapCode(sw, pktEvent, &sflowId) != NULL);
+
+    DROP_SFLOW_LOCK(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SFLOW, FM_OK);
+
+}   /* end fm10000CheckSFlowLogging */
+
+
+
+
+/*****************************************************************************/
+/** fm10000DeliverSFlowSample
+ * \ingroup intSflow
+ *
+ * \desc            Checks if a received frame was trapped by an sFlow
+ *                  instance and, if so, places it on the sFlow sample ring
+ *                  of the switch. Called by the packet receive task while
+ *                  the ring is enabled.
+ *
+ * \param[in]       sw is the switch number to operate on.
+ *
+ * \param[in]       pktEvent points to the FM_EVENT_PACKET_RECV event of the
+ *                  frame. The frame buffer is left to the caller.
+ *
+ * \param[out]      isPktSFlowLogged points to caller-supplied storage where
+ *                  this function places TRUE if the frame is an sFlow
+ *                  sample, in which case it must not be delivered as an
+ *                  event, even if the ring was full.
+ *
+ * \return          FM_OK.
+ *
+ *****************************************************************************/
+fm_status fm10000DeliverSFlowSample(fm_int            sw,
+                                    fm_eventPktRecv * pktEvent,
+                                    fm_bool         * isPktSFlowLogged)
+{
+    fm10000_sflowEntry *sflowEntry;
+    fm_int              sflowId;
+    fm_uint             sampleRate = 0;
+    fm_int              truncLength = FM_SFLOW_NO_TRUNC;
 
     TAKE_SFLOW_LOCK(sw);
 
+    sflowEntry = FindSFlowByTrapCode(sw, pktEvent, &sflowId);
+
+    if (sflowEntry != NULL)
+    {
+        sflowEntry->sampleCount++;
+        sampleRate  = sflowEntry->activeRate;
+        truncLength = sflowEntry->truncLength;
+    }
+
+    DROP_SFLOW_LOCK(sw);
+
+    *isPktSFlowLogged = (sflowEntry != NULL);
+
+    if (sflowEntry != NULL)
+    {
+        (void) fmPushSFlowSample(sw, sflowId, sampleRate, truncLength, pktEvent);
+    }
+
+    return FM_OK;
+
+}   /* end fm10000DeliverSFlowSample */
+
+
+
+
+/*****************************************************************************/
+/** fm10000UpdateSFlowSampleRates
+ * \ingroup intSflow
+ *
+ * \desc            Adjusts the sampling rate of the sFlows that have an
+ *                  FM_SFLOW_MAX_CPU_RATE, from the number of samples
+ *                  received over the last measurement interval. The rate
+ *                  is raised in proportion to the excess as soon as the
+ *                  limit is exceeded, and halved back towards the
+ *                  configured FM_SFLOW_SAMPLE_RATE while the samples
+ *                  arrive at less than half the limit.
+ *
+ * \param[in]       sw is the switch number to operate on.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000UpdateSFlowSampleRates(fm_int sw)
+{
+    fm10000_sflowEntry *sflowEntry;
+    fm_int              sflowId;
+    fm_uint64           now;
+    fm_uint64           elapsed;
+    fm_uint64           cpuRate;
+    fm_uint64           newRate;
+    fm_status           err = FM_OK;
+
+    TAKE_SFLOW_LOCK(sw);
+
+    now = fmGetMonotonicNsec();
+
     for (sflowId = 0 ; sflowId < FM10000_MAX_SFLOWS ; ++sflowId)
     {
         sflowEntry = GetSflowEntry(sw, sflowId);
-        if (sflowEntry && sflowEntry->isValid && 
-            sflowEntry->trapCodeId == sflowTrapCodeId)
+
+        if (!sflowEntry->isValid || (sflowEntry->maxCpuRate == 0))
         {
-            *isPktSFlowLogged = TRUE;
-            break;
+            continue;
+        }
+
+        elapsed = now - sflowEntry->rateCheckTime;
+
+        if (elapsed < FM10000_SFLOW_RATE_INTERVAL_NSEC)
+        {
+            continue;
+        }
+
+        cpuRate = (sflowEntry->sampleCount - sflowEntry->rateCheckCount) *
+                  FM10000_SFLOW_RATE_INTERVAL_NSEC / elapsed;
+        newRate = sflowEntry->activeRate;
+
+        if (cpuRate > sflowEntry->maxCpuRate)
+        {
+            newRate = (newRate * cpuRate + sflowEntry->maxCpuRate - 1) /
+                      sflowEntry->maxCpuRate;
+
+            if (newRate > FM10000_SFLOW_MAX_SAMPLE_RATE)
+            {
+                newRate = FM10000_SFLOW_MAX_SAMPLE_RATE;
+            }
+        }
+        else if ( (cpuRate * 2) < sflowEntry->maxCpuRate )
+        {
+            newRate /= 2;
+
+            if (newRate < sflowEntry->sampleRate)
+            {
+                newRate = sflowEntry->sampleRate;
+            }
+        }
+
+        if (newRate != sflowEntry->activeRate)
+        {
+            err = ApplySampleRate(sw, sflowEntry, (fm_uint) newRate);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SFLOW, err);
+        }
+        else
+        {
+            sflowEntry->rateCheckCount = sflowEntry->sampleCount;
+            sflowEntry->rateCheckTime  = now;
         }
     }
 
+ABORT:
     DROP_SFLOW_LOCK(sw);
 
-    FM_LOG_EXIT(FM_LOG_CAT_SFLOW, FM_OK);
+    return err;
 
-}   /* end fm10000CheckSFlowLogging */
+}   /* end fm10000UpdateSFlowSampleRates */
 
 
 
@@ -261,7 +261,7 @@ fm_status fm10000DeleteForwardingRule(fm_int sw, fm_int ruleId)
                  fwdExt->camEntry->camIndex);
 
     /* mark it available */
-    fwdExt->camEntry->useCount = 0;
+    fmMarkCamEntryUnused(sw, fwdExt->camEntry->camIndex);
 
     FM_LOG_EXIT(FM_LOG_CAT_STACKING, FM_OK);
 
@@ -303,14 +303,11 @@ fm_status fm10000CreateLogicalPortForGlort(fm_int    sw,
 {
     fm_status               err;
     fm_switch *             switchPtr;
-    fm_stackingInfo *       stackingInfo;
     fm_port *               portPtr;
     fm_glortCamEntry *      camEntry;
     fm10000_port *          portExt;
-    fm_treeIterator         iter;
     fm_forwardRuleInternal *tmpRule;
-    fm_uint64               tmpId;
-    fm_bool                 found;
+    fm_int                  tmpId;
 
     FM_LOG_ENTRY( FM_LOG_CAT_STACKING,
                   "sw=%d, glort=%d, logicalPort=%p\n",
@@ -318,9 +315,7 @@ fm_status fm10000CreateLogicalPortForGlort(fm_int    sw,
                   glort,
                   (void *) logicalPort );
 
-    switchPtr    = GET_SWITCH_PTR(sw);
-    stackingInfo = &switchPtr->stackingInfo;
-    found        = FALSE;
+    switchPtr = GET_SWITCH_PTR(sw);
 
     /* If there is an existing entry already, then return the existing one */
     err = fmGetGlortLogicalPort(sw, glort, logicalPort);
@@ -342,26 +337,11 @@ fm_status fm10000CreateLogicalPortForGlort(fm_int    sw,
     }
 
     /***************************************************
-     * Search the tree for a forwarding rule with a
-     * matching glort.
+     * Find a forwarding rule with a matching glort.
      **************************************************/
-    fmTreeIterInit(&iter, &stackingInfo->fwdRules);
+    err = fmFindForwardingRuleByGlort(sw, glort, &tmpId, &tmpRule);
 
-    err = fmTreeIterNext( &iter, &tmpId, (void **) &tmpRule );
-
-    while (err != FM_ERR_NO_MORE)
-    {
-        if ( ( ~tmpRule->rule.mask & tmpRule->rule.glort ) ==
-             ( ~tmpRule->rule.mask & glort ) )
-        {
-            found = TRUE;
-            break;
-        }
-
-        err = fmTreeIterNext( &iter, &tmpId, (void **) &tmpRule );
-    }
-
-    if ( !found )
+    if (err != FM_OK)
     {
         FM_LOG_DEBUG(FM_LOG_CAT_STACKING,
                      "Glort 0x%x was not matched to a forwarding rule\n",
@@ -371,7 +351,7 @@ fm_status fm10000CreateLogicalPortForGlort(fm_int    sw,
     }
 
     FM_LOG_DEBUG(FM_LOG_CAT_STACKING,
-                 "Glort 0x%x was matched to forwarding rule #%lld\n",
+                 "Glort 0x%x was matched to forwarding rule #%d\n",
                  glort,
                  tmpId);
 
@@ -433,6 +413,7 @@ fm_status fm10000CreateLogicalPortForGlort(fm_int    sw,
      * Add it to the logical port table.
      **************************************************/
     switchPtr->portTable[*logicalPort] = portPtr;
+    fmAddGlortLogicalPort(switchPtr, *logicalPort);
 
     FM_LOG_EXIT(FM_LOG_CAT_STACKING, err);
 
@@ -559,6 +540,7 @@ fm_status fm10000CreateLogicalPortForMailboxGlort(fm_int    sw,
      * Add it to the logical port table.
      **************************************************/
     switchPtr->portTable[*logicalPort] = portPtr;
+    fmAddGlortLogicalPort(switchPtr, *logicalPort);
 
     FM_LOG_EXIT(FM_LOG_CAT_STACKING, err);
 
@@ -46,6 +46,22 @@
 /* Max expected entries in read stats scatter gather list */
 #define MAX_STATS_SGLIST 128
 
+/* Number of 128bit counters (frame + bytes) of a VLAN counter set */
+#define FM10000_NB_VLAN_STATS   3
+
+/** Frame and byte counts of a 128bit VLAN counter */
+#define FM10000_VLAN_STAT_FRAMES(cnt128)                                    \
+    ( ( ( (fm_uint64) (cnt128)[1] ) << 32 ) | ( (fm_uint64) (cnt128)[0] ) )
+
+#define FM10000_VLAN_STAT_BYTES(cnt128)                                     \
+    ( ( ( (fm_uint64) (cnt128)[3] ) << 32 ) | ( (fm_uint64) (cnt128)[2] ) )
+
+/* Temporary bin array to retrieve the 128bit RX counters (frame + bytes) of
+ * a port */
+typedef fm_uint32 fm10000_rxPortStatsBank[FM10000_NB_RX_STATS_BANKS]
+                                         [FM10000_BINS_PER_RX_STATS_BANK]
+                                         [FM10000_WORDS_PER_RX_STATS_COUNTER];
+
 /** Add a 32bit read of an EPL counter to the scatter gather
  *  list.
  *  
@@ -317,6 +333,15 @@ typedef struct _fm10000_portCounterMapping
  *****************************************************************************/
 
 
+/* Bins of the VLAN counter set, in the order unicast, multicast and
+ * broadcast */
+static const fm_uint32 vlanStatBins[FM10000_NB_VLAN_STATS] =
+{
+    FM10000_RX_STAT_VLAN_UCAST,
+    FM10000_RX_STAT_VLAN_MCAST,
+    FM10000_RX_STAT_VLAN_BCAST,
+};
+
 /* Table of all RX port counters in the RX banks
  * This table is used for retrieving counters as
  * well as reseting them */
@@ -677,94 +702,44 @@ ABORT:
 
 
 /*****************************************************************************/
-/** fm10000GetPortCounters
+/** AddPortCountersReads
  * \ingroup intStats
  *
- * \desc            Retrieve port statistics.
+ * \desc            Append the reads of the counters of a port to a scatter
+ *                  gather list.
  *
- * \param[in]       sw is the switch on which to operate.
+ * \param[in]       physPort is the physical port.
  *
- * \param[in]       port is the logical port for which to retrieve statistics.
+ * \param[in]       epl is the EPL of the port.
  *
- * \param[out]      counters is a pointer to an fm_portCounters structure to be
- *                  filled in by this function.
- *                  If the requested port is parsing L3 headers then version
- *                  will be FM10000_STATS_VERSION | FM_VALID_IP_STATS_VERSION.
- *                  Otherwise the version will be FM10000_STATS_VERSION.
+ * \param[in]       lane is the EPL lane of the port.
+ *
+ * \param[in]       hasEpl is TRUE if the port has an EPL.
+ *
+ * \param[out]      counters points to the structure that receives the
+ *                  directly mapped counters of the port.
+ *
+ * \param[out]      cntRxPortStatsBank is the temporary array that receives
+ *                  the 128bit RX counters of the port.
+ *
+ * \param[out]      sgList is the scatter gather list.
+ *
+ * \param[in,out]   sgListCntPtr points to the number of entries in sgList.
+ *
+ * \return          Nothing.
  *
- * \return          FM_OK if successful.
- * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
- * \return          FM_ERR_INVALID_PORT if port is invalid.
- * \return          FM_ERR_INVALID_ARGUMENT if counters is NULL.
  *****************************************************************************/
-fm_status fm10000GetPortCounters(fm_int           sw,
-                                 fm_int           port,
-                                 fm_portCounters *counters)
+static void AddPortCountersReads(fm_int                     physPort,
+                                 fm_int                     epl,
+                                 fm_int                     lane,
+                                 fm_bool                    hasEpl,
+                                 fm_portCounters *          counters,
+                                 fm10000_rxPortStatsBank    cntRxPortStatsBank,
+                                 fm_scatterGatherListEntry *sgList,
+                                 fm_int *                   sgListCntPtr)
 {
-    fm_status                 err = FM_OK;
-    fm_switch *               switchPtr;
-    fm10000_switch *          switchExt;
-    fm_int                    physPort;
-    fm_int                    epl;
-    fm_int                    lane;
-    fm_bool                   hasEpl;
-    fm_uint32                 parserCfg     = 0;
-    fm_bool                   validIpStats = FALSE;
-    fm_uint32                 i;
-    fm_port *                 entry;
-    fm_scatterGatherListEntry sgList[MAX_STATS_SGLIST];
-    fm_int                    sgListCnt    = 0;
-    fm_timestamp              ts;
-    fm_bool                   stateLockTaken = FALSE;
-
-    /* Temporary bin array to retrieve 128bit port counters (frame + bytes). */
-    fm_uint32 cntRxPortStatsBank[FM10000_NB_RX_STATS_BANKS]
-                                [FM10000_BINS_PER_RX_STATS_BANK]
-                                [FM10000_WORDS_PER_RX_STATS_COUNTER];
-    
-    FM_LOG_ENTRY(FM_LOG_CAT_PORT, "sw=%d port=%d\n", sw, port);
-
-    switchPtr = GET_SWITCH_PTR(sw);
-    switchExt = GET_SWITCH_EXT(sw);
-    
-    entry     = GET_PORT_PTR(sw, port);
-    physPort  = entry->physicalPort;
-
-    err = fm10000MapPhysicalPortToEplLane(sw, physPort, &epl, &lane);
-    hasEpl = (err == FM_OK) ? TRUE : FALSE;
-
-    /* Some ports do not have an EPL */
-    if (err == FM_ERR_INVALID_PORT)
-    {
-        err = FM_OK;
-    }
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
-    
-    /* Fill the counters structure with 0 to assure all fields not explicitly
-     * set below, which will be the fields not supported by the FM10000,
-     * will be 0 on return. */
-    FM_MEMSET_S( (void *) counters, sizeof(*counters), 0, sizeof(*counters) );
-
-    /**************************************************
-     * Setting the counters version
-     **************************************************/
-    counters->cntVersion = FM10000_STATS_VERSION;
-
-    /* Determine if L3 headers are being parsed and set the valid IP
-     * stats version bit if so. */
-    err = fm10000GetPortAttribute(sw,
-                                  port,
-                                  FM_PORT_ACTIVE_MAC,
-                                  FM_PORT_LANE_NA,
-                                  FM_PORT_PARSER,
-                                  (void *) &parserCfg);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
-
-    if (parserCfg >= FM_PORT_PARSER_STOP_AFTER_L3)
-    {
-        counters->cntVersion |= (fm_uint64)FM_VALID_IP_STATS_VERSION;
-        validIpStats = TRUE;
-    }
+    fm_int    sgListCnt = *sgListCntPtr;
+    fm_uint32 i;
 
     /**************************************************
      * Reading counters for each RX bank
@@ -822,30 +797,39 @@ fm_status fm10000GetPortCounters(fm_int           sw,
         FM10000_GET_EPL_PORT_STAT_32(FM10000_MAC_UNDERRUN_COUNTER,   cntUnderrunPkts);
         FM10000_GET_EPL_PORT_STAT_32(FM10000_MAC_CODE_ERROR_COUNTER, cntCodeErrors);
     }
-    
-    /***************************************************
-     * 4. Execute scatter gather read.
-     **************************************************/
-    if (sgListCnt >= MAX_STATS_SGLIST)
-    {
-        /* Pretty static. Mainly to warn if something new added, 
-         * but the array size is not adjust accordingly */
-        FM_LOG_FATAL(FM_LOG_CAT_PORT,
-                     "fm4000GetPortCounters: Scatter list array %d overflow.\n", 
-                     sgListCnt);
-    }
 
-    /* Taking lock to protect temporary structures used to
-     * store 128b counters */
-    FM_FLAG_TAKE_STATE_LOCK(sw);
+    *sgListCntPtr = sgListCnt;
 
-    /* now get the stats in one shot, optimized for fibm */
-    err = fmReadScatterGather(sw, sgListCnt, sgList);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+}   /* end AddPortCountersReads */
+
+
+
+
+/*****************************************************************************/
+/** CompletePortCounters
+ * \ingroup intStats
+ *
+ * \desc            Complete the counters of a port once the reads added by
+ *                  ''AddPortCountersReads'' have been executed: retrieve
+ *                  the 128bit RX counters and compute the counters that
+ *                  are derived from other counters.
+ *
+ * \param[in,out]   counters points to the counters of the port.
+ *
+ * \param[in]       cntRxPortStatsBank is the temporary array holding the
+ *                  128bit RX counters of the port.
+ *
+ * \param[in]       validIpStats is TRUE if the port parses L3 headers.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void CompletePortCounters(fm_portCounters *       counters,
+                                 fm10000_rxPortStatsBank cntRxPortStatsBank,
+                                 fm_bool                 validIpStats)
+{
+    fm_uint32 i;
 
-    err = fmGetTime(&ts);
-    counters->timestamp = ts.sec * 1000000 + ts.usec;   
-    
     /***************************************************
      * 5. Retrieve the frame/byte counts from 128bit 
      *    registers stored in temporary array and set
@@ -859,8 +843,6 @@ fm_status fm10000GetPortCounters(fm_int           sw,
                                      rxPortCntMapTable[i].frameOffset,
                                      rxPortCntMapTable[i].byteOffset);
     }
-    
-    FM_FLAG_DROP_STATE_LOCK(sw);
 
     /***************************************************
      * 6. Set some counters that are not available 
@@ -942,10 +924,141 @@ fm_status fm10000GetPortCounters(fm_int           sw,
     counters->cntTxOctets += counters->cntTx8192to10239octets;
     counters->cntTxOctets += counters->cntTx10240toMaxOctets;
 
+}   /* end CompletePortCounters */
+
+
+
+
+/*****************************************************************************/
+/** fm10000GetPortCounters
+ * \ingroup intStats
+ *
+ * \desc            Retrieve port statistics.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port for which to retrieve statistics.
+ *
+ * \param[out]      counters is a pointer to an fm_portCounters structure to be
+ *                  filled in by this function.
+ *                  If the requested port is parsing L3 headers then version
+ *                  will be FM10000_STATS_VERSION | FM_VALID_IP_STATS_VERSION.
+ *                  Otherwise the version will be FM10000_STATS_VERSION.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_PORT if port is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if counters is NULL.
+ *****************************************************************************/
+fm_status fm10000GetPortCounters(fm_int           sw,
+                                 fm_int           port,
+                                 fm_portCounters *counters)
+{
+    fm_status                 err = FM_OK;
+    fm_int                    physPort;
+    fm_int                    epl;
+    fm_int                    lane;
+    fm_bool                   hasEpl;
+    fm_uint32                 parserCfg     = 0;
+    fm_bool                   validIpStats = FALSE;
+    fm_port *                 entry;
+    fm_scatterGatherListEntry sgList[MAX_STATS_SGLIST];
+    fm_int                    sgListCnt    = 0;
+    fm_timestamp              ts;
+    fm_bool                   statsLockTaken = FALSE;
+
+    /* Temporary bin array to retrieve 128bit port counters (frame + bytes). */
+    fm10000_rxPortStatsBank   cntRxPortStatsBank;
+    
+    FM_LOG_ENTRY(FM_LOG_CAT_PORT, "sw=%d port=%d\n", sw, port);
+
+    /* Serve the read from the counter cache when it is recent enough */
+    if ( fm10000ReadCachedPortCounters(sw, port, counters) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PORT, FM_OK);
+    }
+
+    entry     = GET_PORT_PTR(sw, port);
+    physPort  = entry->physicalPort;
+
+    err = fm10000MapPhysicalPortToEplLane(sw, physPort, &epl, &lane);
+    hasEpl = (err == FM_OK) ? TRUE : FALSE;
+
+    /* Some ports do not have an EPL */
+    if (err == FM_ERR_INVALID_PORT)
+    {
+        err = FM_OK;
+    }
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+    
+    /* Fill the counters structure with 0 to assure all fields not explicitly
+     * set below, which will be the fields not supported by the FM10000,
+     * will be 0 on return. */
+    FM_MEMSET_S( (void *) counters, sizeof(*counters), 0, sizeof(*counters) );
+
+    /**************************************************
+     * Setting the counters version
+     **************************************************/
+    counters->cntVersion = FM10000_STATS_VERSION;
+
+    /* Determine if L3 headers are being parsed and set the valid IP
+     * stats version bit if so. */
+    err = fm10000GetPortAttribute(sw,
+                                  port,
+                                  FM_PORT_ACTIVE_MAC,
+                                  FM_PORT_LANE_NA,
+                                  FM_PORT_PARSER,
+                                  (void *) &parserCfg);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+
+    if (parserCfg >= FM_PORT_PARSER_STOP_AFTER_L3)
+    {
+        counters->cntVersion |= (fm_uint64)FM_VALID_IP_STATS_VERSION;
+        validIpStats = TRUE;
+    }
+
+    AddPortCountersReads(physPort,
+                         epl,
+                         lane,
+                         hasEpl,
+                         counters,
+                         cntRxPortStatsBank,
+                         sgList,
+                         &sgListCnt);
+    
+    /***************************************************
+     * 4. Execute scatter gather read.
+     **************************************************/
+    if (sgListCnt >= MAX_STATS_SGLIST)
+    {
+        /* Pretty static. Mainly to warn if something new added, 
+         * but the array size is not adjust accordingly */
+        FM_LOG_FATAL(FM_LOG_CAT_PORT,
+                     "fm4000GetPortCounters: Scatter list array %d overflow.\n", 
+                     sgListCnt);
+    }
+
+    /* Taking lock to protect temporary structures used to
+     * store 128b counters */
+    FM_FLAG_TAKE_STATS_LOCK(sw);
+
+    /* now get the stats in one shot, optimized for fibm */
+    err = fmReadScatterGather(sw, sgListCnt, sgList);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+
+    err = fmGetTime(&ts);
+    counters->timestamp = ts.sec * 1000000 + ts.usec;   
+    
+    CompletePortCounters(counters, cntRxPortStatsBank, validIpStats);
+
+    fm10000UpdateCachedPortCounters(sw, port, counters);
+    
+    FM_FLAG_DROP_STATS_LOCK(sw);
+
 ABORT:
-    if (stateLockTaken)
+    if (statsLockTaken)
     {
-        FM_FLAG_DROP_STATE_LOCK(sw);
+        FM_FLAG_DROP_STATS_LOCK(sw);
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
@@ -955,6 +1068,210 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000GetAllPortCounters
+ * \ingroup intStats
+ *
+ * \desc            Retrieve the statistics of a list of ports with a single
+ *                  scatter gather read, see ''fmGetAllPortCounters''.
+ *                                                                      \lb\lb
+ *                  The EPL lanes of the ports are resolved under a single
+ *                  scheduler lock, and their parser configuration is taken
+ *                  from the cached port attributes while the state lock is
+ *                  held for the read. Ports that are not cardinal ports are
+ *                  handed to their own GetPortCounters function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       portList points to an array of numPorts logical ports.
+ *
+ * \param[in]       numPorts is the number of ports in portList.
+ *
+ * \param[out]      counters points to a caller-allocated array of numPorts
+ *                  entries that receives the counters of each port.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if the scatter gather list could not be
+ *                  allocated.
+ *
+ *****************************************************************************/
+fm_status fm10000GetAllPortCounters(fm_int           sw,
+                                    fm_int *         portList,
+                                    fm_int           numPorts,
+                                    fm_portCounters *counters)
+{
+    fm_status                  err = FM_OK;
+    fm10000_switch *           switchExt;
+    fm_port *                  portPtr;
+    fm_portAttr *              portAttr;
+    fm_scatterGatherListEntry *sgList = NULL;
+    fm10000_rxPortStatsBank *  rxBanks = NULL;
+    fm_int *                   fabricPorts = NULL;
+    fm_bool *                  batched = NULL;
+    fm_int                     sgListCnt = 0;
+    fm_int                     physPort;
+    fm_int                     fabricPort;
+    fm_bool                    hasEpl;
+    fm_bool                    validIpStats;
+    fm_bool                    statsLockTaken = FALSE;
+    fm_timestamp               ts;
+    fm_uint64                  timestamp;
+    fm_int                     i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PORT, "sw=%d numPorts=%d\n", sw, numPorts);
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    sgList      = fmAlloc(numPorts * MAX_STATS_SGLIST * sizeof(*sgList));
+    rxBanks     = fmAlloc(numPorts * sizeof(*rxBanks));
+    fabricPorts = fmAlloc(numPorts * sizeof(*fabricPorts));
+    batched     = fmAlloc(numPorts * sizeof(*batched));
+
+    if ( (sgList == NULL) || (rxBanks == NULL) ||
+         (fabricPorts == NULL) || (batched == NULL) )
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+    }
+
+    /* Resolve the EPL lane of every port under one scheduler lock. */
+    TAKE_SCHEDULER_LOCK(sw);
+
+    for (i = 0 ; i < numPorts ; i++)
+    {
+        portPtr    = GET_PORT_PTR(sw, portList[i]);
+        batched[i] = ( fmIsCardinalPort(sw, portList[i]) &&
+                       (portPtr->GetPortCounters == fm10000GetPortCounters) );
+
+        physPort       = portPtr->physicalPort;
+        fabricPorts[i] = -1;
+
+        if ( batched[i] && (physPort >= 0) && (physPort < FM10000_NUM_PORTS) )
+        {
+            fabricPorts[i] = switchExt->schedInfo.physicalToFabricMap[physPort];
+        }
+    }
+
+    DROP_SCHEDULER_LOCK(sw);
+
+    for (i = 0 ; i < numPorts ; i++)
+    {
+        if (!batched[i])
+        {
+            continue;
+        }
+
+        portPtr    = GET_PORT_PTR(sw, portList[i]);
+        fabricPort = fabricPorts[i];
+        hasEpl     = ( (fabricPort >= 0) &&
+                       (fabricPort <= FM10000_LAST_EPL_FABRIC_PORT) );
+
+        FM_MEMSET_S( (void *) &counters[i],
+                     sizeof(counters[i]),
+                     0,
+                     sizeof(counters[i]) );
+
+        AddPortCountersReads(portPtr->physicalPort,
+                             hasEpl ? fabricPort / 4 : 0,
+                             hasEpl ? fabricPort % 4 : 0,
+                             hasEpl,
+                             &counters[i],
+                             rxBanks[i],
+                             sgList,
+                             &sgListCnt);
+    }
+
+    FM_FLAG_TAKE_STATS_LOCK(sw);
+
+    /* now get the stats of every port in one shot */
+    if (sgListCnt > 0)
+    {
+        err = fmReadScatterGather(sw, sgListCnt, sgList);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+    }
+
+    fmGetTime(&ts);
+    timestamp = ts.sec * 1000000 + ts.usec;
+
+    for (i = 0 ; i < numPorts ; i++)
+    {
+        if (!batched[i])
+        {
+            continue;
+        }
+
+        /* The parser mode is a single word, so it is sampled without the
+         * port attribute lock; a concurrent change only affects whether
+         * this one sample is flagged as carrying IP statistics. */
+        portAttr = GET_PORT_ATTR(sw, portList[i]);
+
+        validIpStats = (portAttr->parser >= FM_PORT_PARSER_STOP_AFTER_L3);
+
+        counters[i].cntVersion = FM10000_STATS_VERSION;
+
+        if (validIpStats)
+        {
+            counters[i].cntVersion |= (fm_uint64)FM_VALID_IP_STATS_VERSION;
+        }
+
+        counters[i].timestamp = timestamp;
+
+        CompletePortCounters(&counters[i], rxBanks[i], validIpStats);
+
+        fm10000UpdateCachedPortCounters(sw, portList[i], &counters[i]);
+    }
+
+    FM_FLAG_DROP_STATS_LOCK(sw);
+
+    /* Ports with their own counter functions */
+    for (i = 0 ; i < numPorts ; i++)
+    {
+        if (!batched[i])
+        {
+            portPtr = GET_PORT_PTR(sw, portList[i]);
+
+            FM_API_CALL_FAMILY(err,
+                               portPtr->GetPortCounters,
+                               sw,
+                               portList[i],
+                               &counters[i]);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        }
+    }
+
+ABORT:
+    if (statsLockTaken)
+    {
+        FM_FLAG_DROP_STATS_LOCK(sw);
+    }
+
+    if (sgList != NULL)
+    {
+        fmFree(sgList);
+    }
+
+    if (rxBanks != NULL)
+    {
+        fmFree(rxBanks);
+    }
+
+    if (fabricPorts != NULL)
+    {
+        fmFree(fabricPorts);
+    }
+
+    if (batched != NULL)
+    {
+        fmFree(batched);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
+
+}   /* end fm10000GetAllPortCounters */
+
+
+
+
 /*****************************************************************************/
 /** fm10000ResetPortCounters
  * \ingroup intStats
@@ -983,7 +1300,7 @@ fm_status fm10000ResetPortCounters(fm_int sw,
     fm_int                    epl;
     fm_int                    lane;
     fm_bool                   hasEpl;
-    fm_bool                   stateLockTaken = FALSE;
+    fm_bool                   statsLockTaken = FALSE;
     fm_uint32                 i;
     fm_scatterGatherListEntry sgList[MAX_STATS_SGLIST];
     fm_int                    sgListCnt    = 0;
@@ -1075,7 +1392,7 @@ fm_status fm10000ResetPortCounters(fm_int sw,
      *    this process. Execute Scatter Gather Write
      ***********************************************/
 
-    FM_FLAG_TAKE_STATE_LOCK(sw);
+    FM_FLAG_TAKE_STATS_LOCK(sw);
 
     /* For atomic reset, we disable the banks before reseting */
     err = fm10000SetBankEnable(sw, 
@@ -1089,8 +1406,10 @@ fm_status fm10000ResetPortCounters(fm_int sw,
     err = fmWriteScatterGather(sw, sgListCnt, sgList);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
 
+    fm10000InvalidateCachedPortCounters(sw, port);
+
 ABORT:
-    if (stateLockTaken == TRUE)
+    if (statsLockTaken == TRUE)
     {
         /* We must re-enable banks */
         err2 = fm10000SetBankEnable(sw, 
@@ -1111,7 +1430,7 @@ ABORT:
             }
         }
 
-        FM_FLAG_DROP_STATE_LOCK(sw);
+        FM_FLAG_DROP_STATS_LOCK(sw);
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
@@ -1122,10 +1441,11 @@ ABORT:
 
 
 /*****************************************************************************/
-/** fm10000GetVLANCounters
+/** fm10000ReadVLANCounters
  * \ingroup intStats
  *
- * \desc            Retrieves the values of the specified VLAN counter.
+ * \desc            Reads the values of the specified VLAN counter from the
+ *                  hardware, bypassing the counter cache.
  *
  * \param[in]       sw is the switch on which to operate.
  *
@@ -1141,13 +1461,13 @@ ABORT:
  * \return          FM_ERR_INVALID_ARGUMENT if counters is NULL.
  *
  *****************************************************************************/
-fm_status fm10000GetVLANCounters(fm_int          sw,
-                                fm_int           vcid,
-                                fm_vlanCounters *counters)
+fm_status fm10000ReadVLANCounters(fm_int           sw,
+                                  fm_int           vcid,
+                                  fm_vlanCounters *counters)
 {
     fm_status       err = FM_FAIL;
     fm_switch *     switchPtr = NULL;
-    fm_bool         stateLockTaken = FALSE;
+    fm_bool         statsLockTaken = FALSE;
     fm_uint32       tmpUcstCnt128[4];
     fm_uint32       tmpMcstCnt128[4];
     fm_uint32       tmpBcstCnt128[4];
@@ -1169,7 +1489,7 @@ fm_status fm10000GetVLANCounters(fm_int          sw,
 
     counters->cntVersion = FM10000_STATS_VERSION;
 
-    FM_FLAG_TAKE_STATE_LOCK(sw);
+    FM_FLAG_TAKE_STATS_LOCK(sw);
 
     err = switchPtr->ReadUINT32Mult(sw, 
                                     FM10000_RX_STATS_BANK(
@@ -1211,13 +1531,61 @@ fm_status fm10000GetVLANCounters(fm_int          sw,
     counters->cntRxBcstOctets = (((fm_uint64)(tmpBcstCnt128[3])) << 32) |
                                 ((fm_uint64)  tmpBcstCnt128[2]);
 
+    fm10000UpdateCachedVLANCounters(sw, vcid, counters);
 
 ABORT:
-    if (stateLockTaken == TRUE)
+    if (statsLockTaken == TRUE)
+    {
+        FM_FLAG_DROP_STATS_LOCK(sw);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_VLAN, err);
+
+}   /* end fm10000ReadVLANCounters */
+
+
+
+
+/*****************************************************************************/
+/** fm10000GetVLANCounters
+ * \ingroup intStats
+ *
+ * \desc            Retrieves the values of the specified VLAN counter.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vcid is the ID of the VLAN counter set to retrieve.
+ *
+ * \param[out]      counters is a pointer to an fm_vlanCounters structure to be
+ *                  filled in by this function.
+ *                  The version will be 1.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_VCID if vcid is not valid.
+ * \return          FM_ERR_INVALID_ARGUMENT if counters is NULL.
+ *
+ *****************************************************************************/
+fm_status fm10000GetVLANCounters(fm_int           sw,
+                                 fm_int           vcid,
+                                 fm_vlanCounters *counters)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_VLAN,
+                 "sw=%d vcid=%d counters=%p\n",
+                 sw,
+                 vcid,
+                 (void *) counters);
+
+    /* Serve the read from the counter cache when it is recent enough */
+    if ( fm10000ReadCachedVLANCounters(sw, vcid, counters) )
     {
-        FM_FLAG_DROP_STATE_LOCK(sw);
+        FM_LOG_EXIT(FM_LOG_CAT_VLAN, FM_OK);
     }
 
+    err = fm10000ReadVLANCounters(sw, vcid, counters);
+
     FM_LOG_EXIT(FM_LOG_CAT_VLAN, err);
 
 }   /* end fm10000GetVLANCounters */
@@ -1225,6 +1593,130 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000GetVLANCountersList
+ * \ingroup intStats
+ *
+ * \desc            Retrieves the values of a list of VLAN counter sets
+ *                  with a single scatter gather read.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numCounters is the number of entries in vcidList.
+ *
+ * \param[in]       vcidList points to an array of VLAN counter set IDs.
+ *
+ * \param[out]      counters points to a caller-allocated array of
+ *                  numCounters entries that receives the values of each
+ *                  counter set. The version will be 1.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_VCID if a vcid is not valid.
+ * \return          FM_ERR_NO_MEM if the scatter gather list could not be
+ *                  allocated.
+ *
+ *****************************************************************************/
+fm_status fm10000GetVLANCountersList(fm_int           sw,
+                                     fm_int           numCounters,
+                                     fm_int *         vcidList,
+                                     fm_vlanCounters *counters)
+{
+    fm_status                  err = FM_OK;
+    fm_scatterGatherListEntry *sgList = NULL;
+    fm_uint32                (*cnt128)[FM10000_NB_VLAN_STATS][4] = NULL;
+    fm_int                     sgListCnt = 0;
+    fm_bool                    statsLockTaken = FALSE;
+    fm_int                     i;
+    fm_int                     j;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_VLAN,
+                 "sw=%d numCounters=%d\n",
+                 sw,
+                 numCounters);
+
+    if (numCounters <= 0)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_VLAN, FM_OK);
+    }
+
+    for (i = 0 ; i < numCounters ; i++)
+    {
+        if ( (vcidList[i] < 0) || (vcidList[i] > FM10000_MAX_VLAN_COUNTER) )
+        {
+            FM_LOG_EXIT(FM_LOG_CAT_VLAN, FM_ERR_INVALID_VCID);
+        }
+    }
+
+    sgList = fmAlloc(numCounters * FM10000_NB_VLAN_STATS * sizeof(*sgList));
+    cnt128 = fmAlloc(numCounters * sizeof(*cnt128));
+
+    if ( (sgList == NULL) || (cnt128 == NULL) )
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+    }
+
+    for (i = 0 ; i < numCounters ; i++)
+    {
+        for (j = 0 ; j < FM10000_NB_VLAN_STATS ; j++)
+        {
+            sgList[sgListCnt].addr =
+                FM10000_RX_STATS_BANK(FM10000_RX_STAT_BANK_VLAN,
+                                      (vlanStatBins[j] << 6 | vcidList[i]),
+                                      0);
+            sgList[sgListCnt].data  = cnt128[i][j];
+            sgList[sgListCnt].count = 4;
+            sgListCnt++;
+        }
+    }
+
+    FM_FLAG_TAKE_STATS_LOCK(sw);
+
+    err = fmReadScatterGather(sw, sgListCnt, sgList);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+
+    for (i = 0 ; i < numCounters ; i++)
+    {
+        FM_MEMSET_S(&counters[i],
+                    sizeof(fm_vlanCounters),
+                    0,
+                    sizeof(fm_vlanCounters));
+
+        counters[i].cntVersion = FM10000_STATS_VERSION;
+
+        counters[i].cntRxUcstPkts   = FM10000_VLAN_STAT_FRAMES(cnt128[i][0]);
+        counters[i].cntRxUcstOctets = FM10000_VLAN_STAT_BYTES(cnt128[i][0]);
+        counters[i].cntRxMcstPkts   = FM10000_VLAN_STAT_FRAMES(cnt128[i][1]);
+        counters[i].cntRxMcstOctets = FM10000_VLAN_STAT_BYTES(cnt128[i][1]);
+        counters[i].cntRxBcstPkts   = FM10000_VLAN_STAT_FRAMES(cnt128[i][2]);
+        counters[i].cntRxBcstOctets = FM10000_VLAN_STAT_BYTES(cnt128[i][2]);
+
+        fm10000UpdateCachedVLANCounters(sw, vcidList[i], &counters[i]);
+    }
+
+ABORT:
+    if (statsLockTaken == TRUE)
+    {
+        FM_FLAG_DROP_STATS_LOCK(sw);
+    }
+
+    if (sgList != NULL)
+    {
+        fmFree(sgList);
+    }
+
+    if (cnt128 != NULL)
+    {
+        fmFree(cnt128);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_VLAN, err);
+
+}   /* end fm10000GetVLANCountersList */
+
+
+
+
 /*****************************************************************************/
 /** fm10000ResetVLANCounters
  * \ingroup intStats
@@ -1246,7 +1738,7 @@ fm_status fm10000ResetVLANCounters(fm_int sw,
 {
     fm_status       err = FM_FAIL;
     fm_switch *     switchPtr = NULL;
-    fm_bool         stateLockTaken = FALSE;
+    fm_bool         statsLockTaken = FALSE;
     fm_uint32       zeros[4] = { 0, 0, 0, 0};
     
     FM_LOG_ENTRY(FM_LOG_CAT_VLAN,
@@ -1261,7 +1753,7 @@ fm_status fm10000ResetVLANCounters(fm_int sw,
         FM_LOG_EXIT(FM_LOG_CAT_VLAN, FM_ERR_INVALID_VCID);
     }
 
-    FM_FLAG_TAKE_STATE_LOCK(sw);
+    FM_FLAG_TAKE_STATS_LOCK(sw);
 
     err = switchPtr->WriteUINT32Mult(sw, 
                                      FM10000_RX_STATS_BANK(
@@ -1290,10 +1782,12 @@ fm_status fm10000ResetVLANCounters(fm_int sw,
                                      zeros);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
 
+    fm10000InvalidateCachedVLANCounters(sw, vcid);
+
 ABORT:
-    if (stateLockTaken == TRUE)
+    if (statsLockTaken == TRUE)
     {
-        FM_FLAG_DROP_STATE_LOCK(sw);
+        FM_FLAG_DROP_STATS_LOCK(sw);
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_VLAN, err);
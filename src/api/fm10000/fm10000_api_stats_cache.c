@@ -0,0 +1,936 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm10000_api_stats_cache.c
+ * Creation Date:   October 15, 2026
+ * Description:     FM10000 background counter cache.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <fm_sdk_fm10000_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* Shortest refresh period, in milliseconds. */
+#define FM10000_COUNTER_CACHE_MIN_INTERVAL  10
+
+/* Number of times a reader retries a snapshot that is being rewritten
+ * before falling back to a hardware read. */
+#define FM10000_COUNTER_CACHE_READ_RETRIES  16
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* The 32-bit EPL counters, which the cache extends to 64 bits. */
+static const fm_uint eplCounterOffsets[FM10000_NUM_CACHED_EPL_COUNTERS] =
+{
+    offsetof(fm_portCounters, cntRxOversizedPkts),
+    offsetof(fm_portCounters, cntRxJabberPkts),
+    offsetof(fm_portCounters, cntRxUndersizedPkts),
+    offsetof(fm_portCounters, cntRxFragmentPkts),
+    offsetof(fm_portCounters, cntOverrunPkts),
+    offsetof(fm_portCounters, cntUnderrunPkts),
+    offsetof(fm_portCounters, cntCodeErrors),
+};
+
+/*****************************************************************************
+ * Local function prototypes.
+ *****************************************************************************/
+
+static void HandleCounterCacheTimer(void *arg);
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** StartCounterCacheTimer
+ * \ingroup intStats
+ *
+ * \desc            Arms the counter cache timer for its next refresh.
+ *
+ * \param[in]       cache points to the counter cache of the switch.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status StartCounterCacheTimer(fm10000_counterCache *cache)
+{
+    fm_timestamp tick;
+
+    tick.sec  = cache->interval / 1000;
+    tick.usec = (cache->interval % 1000) * 1000;
+
+    return fmStartTimer(cache->timer,
+                        &tick,
+                        1,
+                        HandleCounterCacheTimer,
+                        cache);
+
+}   /* end StartCounterCacheTimer */
+
+
+
+
+/*****************************************************************************/
+/** BeginSnapshotWrite
+ * \ingroup intStats
+ *
+ * \desc            Marks a snapshot as being rewritten. Readers that
+ *                  observe the odd sequence number retry.
+ *
+ * \param[in,out]   seq points to the sequence number of the snapshot.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BeginSnapshotWrite(fm_uint32 *seq)
+{
+    FM_ATOMIC_STORE_RELAXED(seq, *seq + 1);
+    FM_ATOMIC_FENCE();
+
+}   /* end BeginSnapshotWrite */
+
+
+
+
+/*****************************************************************************/
+/** EndSnapshotWrite
+ * \ingroup intStats
+ *
+ * \desc            Publishes a rewritten snapshot.
+ *
+ * \param[in,out]   seq points to the sequence number of the snapshot.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void EndSnapshotWrite(fm_uint32 *seq)
+{
+    FM_ATOMIC_STORE(seq, *seq + 1);
+
+}   /* end EndSnapshotWrite */
+
+
+
+
+/*****************************************************************************/
+/** ReadSnapshot
+ * \ingroup intStats
+ *
+ * \desc            Copies a snapshot without taking any lock. The copy is
+ *                  retried while a writer is rewriting the snapshot.
+ *
+ * \param[in]       seq points to the sequence number of the snapshot.
+ *
+ * \param[in]       valid points to the valid flag of the snapshot.
+ *
+ * \param[in]       src points to the snapshot data.
+ *
+ * \param[out]      dst points to the caller's copy of the data.
+ *
+ * \param[in]       size is the size of the data.
+ *
+ * \return          TRUE if a consistent and valid copy was made.
+ *
+ *****************************************************************************/
+static fm_bool ReadSnapshot(fm_uint32 *   seq,
+                            const fm_bool *valid,
+                            const void *   src,
+                            void *         dst,
+                            fm_uint        size)
+{
+    fm_uint32 start;
+    fm_bool   isValid;
+    fm_int    retry;
+
+    for (retry = 0 ; retry < FM10000_COUNTER_CACHE_READ_RETRIES ; retry++)
+    {
+        start = FM_ATOMIC_LOAD(seq);
+
+        if (start & 1)
+        {
+            continue;
+        }
+
+        isValid = *valid;
+        FM_MEMCPY_S(dst, size, src, size);
+
+        FM_ATOMIC_FENCE();
+
+        if (FM_ATOMIC_LOAD_RELAXED(seq) == start)
+        {
+            return isValid;
+        }
+    }
+
+    return FALSE;
+
+}   /* end ReadSnapshot */
+
+
+
+
+/*****************************************************************************/
+/** IsSnapshotFresh
+ * \ingroup intStats
+ *
+ * \desc            Tells whether a snapshot is recent enough to be returned
+ *                  to a reader.
+ *
+ * \param[in]       cache points to the counter cache of the switch.
+ *
+ * \param[in]       timestamp is the time of the snapshot, in microseconds.
+ *
+ * \return          TRUE if the snapshot is no older than the maximum age.
+ *
+ *****************************************************************************/
+static fm_bool IsSnapshotFresh(fm10000_counterCache *cache, fm_uint64 timestamp)
+{
+    fm_timestamp now;
+    fm_uint64    nowUsec;
+
+    if (fmGetTime(&now) != FM_OK)
+    {
+        return FALSE;
+    }
+
+    nowUsec = now.sec * 1000000 + now.usec;
+
+    return ( (nowUsec >= timestamp) &&
+             ( (nowUsec - timestamp) <= (fm_uint64) cache->maxAge * 1000 ) );
+
+}   /* end IsSnapshotFresh */
+
+
+
+
+/*****************************************************************************/
+/** HandleCounterCacheTimer
+ * \ingroup intStats
+ *
+ * \desc            Counter cache timer callback. Reads the counters of all
+ *                  cardinal ports and of all allocated VLAN counters into
+ *                  the cache, and rearms the timer while the cache stays
+ *                  enabled.
+ *
+ * \param[in]       arg points to the ''fm10000_counterCache'' of the
+ *                  switch.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void HandleCounterCacheTimer(void *arg)
+{
+    fm10000_counterCache *cache;
+    fm_switch *           switchPtr;
+    fm_counterInfo *      ci;
+    fm_vlanCounters       vlanCounters;
+    fm_timestamp          now;
+    fm_int                sw;
+    fm_int                vcid;
+    fm_int                i;
+    fm_status             err;
+
+    cache = arg;
+    sw    = cache->sw;
+
+    VALIDATE_AND_PROTECT_SWITCH_NO_RETURN(err, sw);
+    if (err != FM_OK)
+    {
+        return;
+    }
+
+    /* The cache may have been disabled while this tick was pending. */
+    if (cache->interval == 0)
+    {
+        UNPROTECT_SWITCH(sw);
+        return;
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    err = fm10000GetAllPortCounters(sw,
+                                    cache->portList,
+                                    cache->numPorts,
+                                    cache->scratch);
+    if (err != FM_OK)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_PORT,
+                       "Counter cache refresh of switch %d failed: %s\n",
+                       sw,
+                       fmErrorMsg(err));
+    }
+    else
+    {
+        /* Export the snapshots to the telemetry ring, if there is one */
+        for (i = 0 ; i < cache->numPorts ; i++)
+        {
+            fmPushTelemetryRecord(sw,
+                                  FM_TELEMETRY_RECORD_PORT,
+                                  cache->portList[i],
+                                  cache->scratch[i].timestamp,
+                                  &cache->scratch[i],
+                                  sizeof(fm_portCounters));
+        }
+    }
+
+    ci = &switchPtr->counterInfo;
+
+    for (vcid = 0 ; vcid <= FM10000_MAX_VLAN_COUNTER ; vcid++)
+    {
+        if ( (vcid > switchPtr->maxVlanCounter) ||
+             (ci->vlanAssignedToCounter[vcid] == FM_UNALLOCATED_VLAN_COUNTER) )
+        {
+            continue;
+        }
+
+        err = fm10000ReadVLANCounters(sw, vcid, &vlanCounters);
+        if (err != FM_OK)
+        {
+            FM_LOG_WARNING(FM_LOG_CAT_VLAN,
+                           "Counter cache refresh of VLAN counter %d "
+                           "failed: %s\n",
+                           vcid,
+                           fmErrorMsg(err));
+        }
+        else if (fmGetTime(&now) == FM_OK)
+        {
+            fmPushTelemetryRecord(sw,
+                                  FM_TELEMETRY_RECORD_VLAN,
+                                  ci->vlanAssignedToCounter[vcid],
+                                  now.sec * 1000000 + now.usec,
+                                  &vlanCounters,
+                                  sizeof(fm_vlanCounters));
+        }
+    }
+
+    err = StartCounterCacheTimer(cache);
+    if (err != FM_OK)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_PORT,
+                     "Unable to rearm counter cache timer of switch %d: %s\n",
+                     sw,
+                     fmErrorMsg(err));
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+}   /* end HandleCounterCacheTimer */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fm10000SetCounterCacheInterval
+ * \ingroup intStats
+ *
+ * \desc            Starts, restarts or stops the counter cache, see
+ *                  ''FM_SWITCH_COUNTER_CACHE_INTERVAL''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       interval is the refresh period in milliseconds, or 0
+ *                  to stop the cache.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_VALUE if interval is nonzero and shorter
+ *                  than the minimum refresh period.
+ * \return          FM_ERR_NO_MEM if the snapshots cannot be allocated.
+ *
+ *****************************************************************************/
+fm_status fm10000SetCounterCacheInterval(fm_int sw, fm_uint32 interval)
+{
+    fm_switch *                  switchPtr;
+    fm10000_switch *             switchExt;
+    fm10000_counterCache *       cache;
+    fm10000_portCounterSnapshot *ports = NULL;
+    fm_portCounters *            scratch = NULL;
+    fm_int *                     portList = NULL;
+    fm_char                      timerName[32];
+    fm_uint                      size;
+    fm_int                       numPorts;
+    fm_int                       cpi;
+    fm_int                       vcid;
+    fm_bool                      statsLockTaken = FALSE;
+    fm_status                    err = FM_OK;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PORT, "sw=%d interval=%u\n", sw, interval);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    switchExt = GET_SWITCH_EXT(sw);
+    cache     = &switchExt->counterCache;
+
+    if ( (interval != 0) && (interval < FM10000_COUNTER_CACHE_MIN_INTERVAL) )
+    {
+        err = FM_ERR_INVALID_VALUE;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+    }
+
+    if (interval == 0)
+    {
+        if (cache->timer != NULL)
+        {
+            err = fmStopTimer(cache->timer);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        }
+
+        /* The snapshots stay allocated, as lock-free readers may still be
+         * looking at them. They are invalidated so that re-enabling the
+         * cache starts from fresh hardware values. */
+        FM_FLAG_TAKE_STATS_LOCK(sw);
+
+        cache->interval = 0;
+
+        for (cpi = 0 ; (cache->ports != NULL) && (cpi < cache->numPorts) ; cpi++)
+        {
+            BeginSnapshotWrite(&cache->ports[cpi].seq);
+            cache->ports[cpi].valid = FALSE;
+            EndSnapshotWrite(&cache->ports[cpi].seq);
+        }
+
+        for (vcid = 0 ; vcid <= FM10000_MAX_VLAN_COUNTER ; vcid++)
+        {
+            BeginSnapshotWrite(&cache->vlans[vcid].seq);
+            cache->vlans[vcid].valid = FALSE;
+            EndSnapshotWrite(&cache->vlans[vcid].seq);
+        }
+
+        FM_FLAG_DROP_STATS_LOCK(sw);
+
+        fmSetTelemetryRingActive(sw, FALSE);
+
+        FM_LOG_EXIT(FM_LOG_CAT_PORT, FM_OK);
+    }
+
+    if (cache->ports == NULL)
+    {
+        numPorts = switchPtr->numCardinalPorts;
+
+        portList = fmAlloc(numPorts * sizeof(fm_int));
+        scratch  = fmAlloc(numPorts * sizeof(fm_portCounters));
+        size     = numPorts * sizeof(fm10000_portCounterSnapshot);
+        ports    = fmAlloc(size);
+
+        if ( (portList == NULL) || (scratch == NULL) || (ports == NULL) )
+        {
+            err = FM_ERR_NO_MEM;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        }
+
+        for (cpi = 0 ; cpi < numPorts ; cpi++)
+        {
+            portList[cpi] = GET_LOGICAL_PORT(sw, cpi);
+        }
+
+        FM_MEMSET_S(ports, size, 0, size);
+
+        cache->numPorts = numPorts;
+        cache->portList = portList;
+        cache->scratch  = scratch;
+        portList        = NULL;
+        scratch         = NULL;
+
+        /* Publish the snapshots to the lock-free readers. */
+        FM_ATOMIC_STORE(&cache->ports, ports);
+        ports = NULL;
+    }
+
+    if (cache->timer == NULL)
+    {
+        FM_SPRINTF_S(timerName,
+                     sizeof(timerName),
+                     "counterCache%02dTimer",
+                     sw);
+
+        err = fmCreateTimer(timerName, fmApiTimerTask, &cache->timer);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+    }
+
+    cache->sw       = sw;
+    cache->interval = interval;
+
+    err = StartCounterCacheTimer(cache);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+
+    fmSetTelemetryRingActive(sw, TRUE);
+
+ABORT:
+    if (statsLockTaken)
+    {
+        FM_FLAG_DROP_STATS_LOCK(sw);
+    }
+
+    if (portList != NULL)
+    {
+        fmFree(portList);
+    }
+
+    if (scratch != NULL)
+    {
+        fmFree(scratch);
+    }
+
+    if (ports != NULL)
+    {
+        fmFree(ports);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
+
+}   /* end fm10000SetCounterCacheInterval */
+
+
+
+
+/*****************************************************************************/
+/** fm10000ReadCachedPortCounters
+ * \ingroup intStats
+ *
+ * \desc            Returns the cached counters of a port without accessing
+ *                  the hardware or taking any lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port.
+ *
+ * \param[out]      counters points to the structure that receives the
+ *                  counters.
+ *
+ * \return          TRUE if counters was filled from a snapshot no older
+ *                  than ''FM_SWITCH_COUNTER_CACHE_MAX_AGE''.
+ * \return          FALSE if the hardware must be read.
+ *
+ *****************************************************************************/
+fm_bool fm10000ReadCachedPortCounters(fm_int           sw,
+                                      fm_int           port,
+                                      fm_portCounters *counters)
+{
+    fm10000_switch *             switchExt;
+    fm10000_counterCache *       cache;
+    fm10000_portCounterSnapshot *ports;
+    fm_int                       cpi;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    cache     = &switchExt->counterCache;
+    ports = FM_ATOMIC_LOAD(&cache->ports);
+
+    if ( (cache->interval == 0) || (cache->maxAge == 0) || (ports == NULL) ||
+         !fmIsCardinalPort(sw, port) )
+    {
+        return FALSE;
+    }
+
+    cpi = GET_PORT_INDEX(sw, port);
+
+    if ( (cpi < 0) || (cpi >= cache->numPorts) )
+    {
+        return FALSE;
+    }
+
+    if ( !ReadSnapshot(&ports[cpi].seq,
+                       &ports[cpi].valid,
+                       &ports[cpi].counters,
+                       counters,
+                       sizeof(*counters)) )
+    {
+        return FALSE;
+    }
+
+    return IsSnapshotFresh(cache, counters->timestamp);
+
+}   /* end fm10000ReadCachedPortCounters */
+
+
+
+
+/*****************************************************************************/
+/** fm10000GetPortCountersSnapshot
+ * \ingroup intStats
+ *
+ * \desc            Returns the cached counters of a port without accessing
+ *                  the hardware or taking any lock. Called through the
+ *                  GetPortCountersSnapshot function pointer.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port.
+ *
+ * \param[out]      counters points to the structure that receives the
+ *                  counters.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if the counter cache holds no snapshot
+ *                  of the port no older than
+ *                  ''FM_SWITCH_COUNTER_CACHE_MAX_AGE''.
+ *
+ *****************************************************************************/
+fm_status fm10000GetPortCountersSnapshot(fm_int           sw,
+                                         fm_int           port,
+                                         fm_portCounters *counters)
+{
+
+    if ( !fm10000ReadCachedPortCounters(sw, port, counters) )
+    {
+        return FM_ERR_NOT_FOUND;
+    }
+
+    return FM_OK;
+
+}   /* end fm10000GetPortCountersSnapshot */
+
+
+
+
+/*****************************************************************************/
+/** fm10000UpdateCachedPortCounters
+ * \ingroup intStats
+ *
+ * \desc            Stores counters just read from the hardware in the
+ *                  cache. The 32-bit EPL counters are accumulated across
+ *                  wraps and counters is updated with the 64-bit values,
+ *                  so that cached and uncached reads agree.
+ *
+ * \note            The caller has taken the state lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port.
+ *
+ * \param[in,out]   counters points to the counters read from the hardware.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000UpdateCachedPortCounters(fm_int           sw,
+                                     fm_int           port,
+                                     fm_portCounters *counters)
+{
+    fm10000_switch *             switchExt;
+    fm10000_counterCache *       cache;
+    fm10000_portCounterSnapshot *snap;
+    fm_uint64 *                  field;
+    fm_uint32                    raw;
+    fm_int                       cpi;
+    fm_int                       i;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    cache     = &switchExt->counterCache;
+
+    if ( (cache->interval == 0) || (cache->ports == NULL) ||
+         !fmIsCardinalPort(sw, port) )
+    {
+        return;
+    }
+
+    cpi = GET_PORT_INDEX(sw, port);
+
+    if ( (cpi < 0) || (cpi >= cache->numPorts) )
+    {
+        return;
+    }
+
+    snap = &cache->ports[cpi];
+
+    BeginSnapshotWrite(&snap->seq);
+
+    for (i = 0 ; i < FM10000_NUM_CACHED_EPL_COUNTERS ; i++)
+    {
+        field = (fm_uint64 *) ( ( (fm_byte *) counters ) + eplCounterOffsets[i] );
+        raw   = (fm_uint32) *field;
+
+        if (snap->valid)
+        {
+            /* Unsigned 32-bit arithmetic absorbs a wrap of the counter. */
+            snap->eplTotal[i] += (fm_uint32) (raw - snap->eplLast[i]);
+        }
+        else
+        {
+            snap->eplTotal[i] = raw;
+        }
+
+        snap->eplLast[i] = raw;
+        *field           = snap->eplTotal[i];
+    }
+
+    snap->counters = *counters;
+    snap->valid    = TRUE;
+
+    EndSnapshotWrite(&snap->seq);
+
+}   /* end fm10000UpdateCachedPortCounters */
+
+
+
+
+/*****************************************************************************/
+/** fm10000InvalidateCachedPortCounters
+ * \ingroup intStats
+ *
+ * \desc            Drops the snapshot of a port whose hardware counters
+ *                  were reset.
+ *
+ * \note            The caller has taken the state lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000InvalidateCachedPortCounters(fm_int sw, fm_int port)
+{
+    fm10000_switch *      switchExt;
+    fm10000_counterCache *cache;
+    fm_int                cpi;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    cache     = &switchExt->counterCache;
+
+    if ( (cache->ports == NULL) || !fmIsCardinalPort(sw, port) )
+    {
+        return;
+    }
+
+    cpi = GET_PORT_INDEX(sw, port);
+
+    if ( (cpi >= 0) && (cpi < cache->numPorts) )
+    {
+        BeginSnapshotWrite(&cache->ports[cpi].seq);
+        cache->ports[cpi].valid = FALSE;
+        EndSnapshotWrite(&cache->ports[cpi].seq);
+    }
+
+}   /* end fm10000InvalidateCachedPortCounters */
+
+
+
+
+/*****************************************************************************/
+/** fm10000ReadCachedVLANCounters
+ * \ingroup intStats
+ *
+ * \desc            Returns the cached values of a VLAN counter without
+ *                  accessing the hardware or taking any lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vcid is the VLAN counter ID.
+ *
+ * \param[out]      counters points to the structure that receives the
+ *                  counters.
+ *
+ * \return          TRUE if counters was filled from a snapshot no older
+ *                  than ''FM_SWITCH_COUNTER_CACHE_MAX_AGE''.
+ * \return          FALSE if the hardware must be read.
+ *
+ *****************************************************************************/
+fm_bool fm10000ReadCachedVLANCounters(fm_int           sw,
+                                      fm_int           vcid,
+                                      fm_vlanCounters *counters)
+{
+    fm10000_switch *             switchExt;
+    fm10000_counterCache *       cache;
+    fm10000_vlanCounterSnapshot *snap;
+    fm10000_vlanCounterSnapshot  copy;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    cache     = &switchExt->counterCache;
+
+    if ( (cache->interval == 0) || (cache->maxAge == 0) ||
+         (vcid < 0) || (vcid > FM10000_MAX_VLAN_COUNTER) )
+    {
+        return FALSE;
+    }
+
+    snap = &cache->vlans[vcid];
+
+    if ( !ReadSnapshot(&snap->seq,
+                       &snap->valid,
+                       snap,
+                       &copy,
+                       sizeof(copy)) )
+    {
+        return FALSE;
+    }
+
+    if ( !IsSnapshotFresh(cache, copy.timestamp) )
+    {
+        return FALSE;
+    }
+
+    *counters = copy.counters;
+
+    return TRUE;
+
+}   /* end fm10000ReadCachedVLANCounters */
+
+
+
+
+/*****************************************************************************/
+/** fm10000UpdateCachedVLANCounters
+ * \ingroup intStats
+ *
+ * \desc            Stores the values of a VLAN counter just read from the
+ *                  hardware in the cache.
+ *
+ * \note            The caller has taken the state lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vcid is the VLAN counter ID.
+ *
+ * \param[in]       counters points to the counters read from the hardware.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000UpdateCachedVLANCounters(fm_int           sw,
+                                     fm_int           vcid,
+                                     fm_vlanCounters *counters)
+{
+    fm10000_switch *             switchExt;
+    fm10000_counterCache *       cache;
+    fm10000_vlanCounterSnapshot *snap;
+    fm_timestamp                 now;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    cache     = &switchExt->counterCache;
+
+    if ( (cache->interval == 0) || (fmGetTime(&now) != FM_OK) )
+    {
+        return;
+    }
+
+    snap = &cache->vlans[vcid];
+
+    BeginSnapshotWrite(&snap->seq);
+
+    snap->counters  = *counters;
+    snap->timestamp = now.sec * 1000000 + now.usec;
+    snap->valid     = TRUE;
+
+    EndSnapshotWrite(&snap->seq);
+
+}   /* end fm10000UpdateCachedVLANCounters */
+
+
+
+
+/*****************************************************************************/
+/** fm10000InvalidateCachedVLANCounters
+ * \ingroup intStats
+ *
+ * \desc            Drops the snapshot of a VLAN counter that was reset.
+ *
+ * \note            The caller has taken the state lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vcid is the VLAN counter ID.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000InvalidateCachedVLANCounters(fm_int sw, fm_int vcid)
+{
+    fm10000_switch *      switchExt;
+    fm10000_counterCache *cache;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    cache     = &switchExt->counterCache;
+
+    BeginSnapshotWrite(&cache->vlans[vcid].seq);
+    cache->vlans[vcid].valid = FALSE;
+    EndSnapshotWrite(&cache->vlans[vcid].seq);
+
+}   /* end fm10000InvalidateCachedVLANCounters */
+
+
+
+
+/*****************************************************************************/
+/** fm10000FreeCounterCache
+ * \ingroup intStats
+ *
+ * \desc            Stops the counter cache and releases its snapshots.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000FreeCounterCache(fm_int sw)
+{
+    fm10000_switch *      switchExt;
+    fm10000_counterCache *cache;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    cache     = &switchExt->counterCache;
+
+    cache->interval = 0;
+
+    if (cache->timer != NULL)
+    {
+        fmDeleteTimer(cache->timer);
+        cache->timer = NULL;
+    }
+
+    if (cache->ports != NULL)
+    {
+        fmFree(cache->ports);
+        cache->ports = NULL;
+    }
+
+    if (cache->scratch != NULL)
+    {
+        fmFree(cache->scratch);
+        cache->scratch = NULL;
+    }
+
+    if (cache->portList != NULL)
+    {
+        fmFree(cache->portList);
+        cache->portList = NULL;
+    }
+
+    cache->numPorts = 0;
+
+}   /* end fm10000FreeCounterCache */
@@ -1684,8 +1684,15 @@ fm_status fm10000AddStormCtrlCondition(fm_int             sw,
 
     scPtr->conditions[i] = *condition;
 
-    err = ApplyStormCtrlConditions(sw, stormController, scPtr);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STORM, err);
+    if (scPtr->updateDepth > 0)
+    {
+        scPtr->condPending = TRUE;
+    }
+    else
+    {
+        err = ApplyStormCtrlConditions(sw, stormController, scPtr);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STORM, err);
+    }
 
 ABORT:
     DROP_STORM_LOCK(sw);
@@ -1790,8 +1797,15 @@ fm_status fm10000DeleteStormCtrlCondition(fm_int             sw,
                 FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STORM, err);
             }
 
-            err = ApplyStormCtrlConditions(sw, stormController, scPtr);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STORM, err);
+            if (scPtr->updateDepth > 0)
+            {
+                scPtr->condPending = TRUE;
+            }
+            else
+            {
+                err = ApplyStormCtrlConditions(sw, stormController, scPtr);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STORM, err);
+            }
 
             break;
         }
@@ -2166,8 +2180,15 @@ fm_status fm10000AddStormCtrlAction(fm_int          sw,
 
     scPtr->action = *action;
 
-    err = ApplyStormCtrlActions(sw, stormController, scPtr);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STORM, err);
+    if (scPtr->updateDepth > 0)
+    {
+        scPtr->actionPending = TRUE;
+    }
+    else
+    {
+        err = ApplyStormCtrlActions(sw, stormController, scPtr);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STORM, err);
+    }
 
 ABORT:
     DROP_STORM_LOCK(sw);
@@ -2245,8 +2266,15 @@ fm_status fm10000DeleteStormCtrlAction(fm_int          sw,
 
     scPtr->action.type = FM_STORM_ACTION_DO_NOTHING;
 
-    err = ApplyStormCtrlActions(sw, stormController, scPtr);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STORM, err);
+    if (scPtr->updateDepth > 0)
+    {
+        scPtr->actionPending = TRUE;
+    }
+    else
+    {
+        err = ApplyStormCtrlActions(sw, stormController, scPtr);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STORM, err);
+    }
 
 ABORT:
     DROP_STORM_LOCK(sw);
@@ -2258,6 +2286,153 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000BeginStormCtrlUpdate
+ * \ingroup intstorm
+ *
+ * \desc            Start a bulk update of a storm controller. Conditions and
+ *                  actions added or deleted until the matching
+ *                  ''fm10000CommitStormCtrlUpdate'' are recorded but not
+ *                  applied to the backing trigger. Calls may be nested.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       stormController is the storm controller number (returned by
+ *                  ''fmCreateStormCtrl'') to update.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_STORM_CTRL if stormController is out of
+ *                  range or is not the handle of an existing storm controller.
+ *
+ *****************************************************************************/
+fm_status fm10000BeginStormCtrlUpdate(fm_int sw, fm_int stormController)
+{
+    fm_status                err = FM_OK;
+    fm10000_switch *         switchExt;
+    fm10000_scInfo *         scInfo;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_STORM,
+                 "sw = %d, stormController = %d\n",
+                 sw, stormController);
+
+    if ( (stormController >= FM10000_MAX_NUM_STORM_CTRL) ||
+         (stormController < 0) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_STORM, FM_ERR_INVALID_STORM_CTRL);
+    }
+
+    switchExt = GET_SWITCH_EXT(sw);
+    scInfo    = &switchExt->scInfo;
+
+    TAKE_STORM_LOCK(sw);
+
+    if (scInfo->used[stormController] == FM10000_STORM_CONTROLLER_UNUSED)
+    {
+        err = FM_ERR_INVALID_STORM_CTRL;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STORM, err);
+    }
+
+    scInfo->stormCtrl[stormController].updateDepth++;
+
+ABORT:
+    DROP_STORM_LOCK(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_STORM, err);
+
+}   /* end fm10000BeginStormCtrlUpdate */
+
+
+
+
+/*****************************************************************************/
+/** fm10000CommitStormCtrlUpdate
+ * \ingroup intstorm
+ *
+ * \desc            End a bulk update started by ''fm10000BeginStormCtrlUpdate''.
+ *                  When the outermost update is committed, the trigger
+ *                  action and condition are rewritten once if any change
+ *                  was recorded.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       stormController is the storm controller number (returned by
+ *                  ''fmCreateStormCtrl'') to update.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_STORM_CTRL if stormController is out of
+ *                  range or is not the handle of an existing storm controller.
+ * \return          FM_ERR_INVALID_STATE if no update is in progress.
+ *
+ *****************************************************************************/
+fm_status fm10000CommitStormCtrlUpdate(fm_int sw, fm_int stormController)
+{
+    fm_status                err = FM_OK;
+    fm10000_switch *         switchExt;
+    fm10000_scInfo *         scInfo;
+    fm10000_stormController *scPtr;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_STORM,
+                 "sw = %d, stormController = %d\n",
+                 sw, stormController);
+
+    if ( (stormController >= FM10000_MAX_NUM_STORM_CTRL) ||
+         (stormController < 0) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_STORM, FM_ERR_INVALID_STORM_CTRL);
+    }
+
+    switchExt = GET_SWITCH_EXT(sw);
+    scInfo    = &switchExt->scInfo;
+
+    TAKE_STORM_LOCK(sw);
+
+    if (scInfo->used[stormController] == FM10000_STORM_CONTROLLER_UNUSED)
+    {
+        err = FM_ERR_INVALID_STORM_CTRL;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STORM, err);
+    }
+
+    scPtr = &scInfo->stormCtrl[stormController];
+
+    if (scPtr->updateDepth <= 0)
+    {
+        err = FM_ERR_INVALID_STATE;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STORM, err);
+    }
+
+    if (--scPtr->updateDepth > 0)
+    {
+        goto ABORT;
+    }
+
+    /* Same order as InitStormCtrl: the rate limiter must be set up before
+     * the condition starts matching. */
+    if (scPtr->actionPending)
+    {
+        scPtr->actionPending = FALSE;
+
+        err = ApplyStormCtrlActions(sw, stormController, scPtr);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STORM, err);
+    }
+
+    if (scPtr->condPending)
+    {
+        scPtr->condPending = FALSE;
+
+        err = ApplyStormCtrlConditions(sw, stormController, scPtr);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STORM, err);
+    }
+
+ABORT:
+    DROP_STORM_LOCK(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_STORM, err);
+
+}   /* end fm10000CommitStormCtrlUpdate */
+
+
+
+
 /*****************************************************************************/
 /** fm10000GetStormCtrlActionList
  * \ingroup intstorm
@@ -221,6 +221,170 @@ static fm_status WriteEgressMstTable(fm_int sw, fm_int index, fm_uint64 value)
 
 
 
+/*****************************************************************************/
+/** WriteSpanningTreeState
+ * \ingroup intStp
+ *
+ * \desc            Updates the MTable listener state of a list of ports and
+ *                  writes the MST table entries of a spanning tree instance
+ *                  from its software states. The entries are written once,
+ *                  whatever the number of ports.
+ *
+ * \param[in]       sw is the switch number to operate on.
+ *
+ * \param[in]       instance points to the info structure for the
+ *                  STP instance.
+ *
+ * \param[in]       numPorts is the number of ports in portList.
+ *
+ * \param[in]       portList points to the list of ports whose state
+ *                  may have changed.
+ *
+ * \return          FM_OK on success.
+ *
+ *****************************************************************************/
+static fm_status WriteSpanningTreeState(fm_int              sw,
+                                        fm_stpInstanceInfo *instance,
+                                        fm_int              numPorts,
+                                        fm_int *            portList)
+{
+    fm_status   err;
+    fm_switch * switchPtr;
+    fm_int      currentPort;
+    fm_int      physPort;
+    fm_int      cpi;
+    fm_int      index;
+    fm_int      state;
+    fm_uint64   portIngressState;
+    fm_uint64   portEgressState;
+    fm_uint64   ingressStates[FM10000_INGRESS_MST_TABLE_ENTRIES_1];
+    fm_uint64   egressStates;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_STP,
+                 "sw=%d, instance=%p, numPorts=%d, portList=%p\n",
+                 sw,
+                 (void *) instance,
+                 numPorts,
+                 (void *) portList);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    err       = FM_OK;
+
+    /***************************************************
+     * Update the MTable state of the listed ports
+     **************************************************/
+
+    for ( index = 0 ; index < numPorts ; index++ )
+    {
+        currentPort = portList[index];
+        cpi = GET_PORT_INDEX(sw, currentPort);
+        state = instance->states[cpi];
+
+        /***************************************************
+         * The IP multicast table is not STP aware, so now
+         * let us inform the MTable code to skip any
+         * instances of this (port, instance) pair before we
+         * update the port's STP state.  Note that we 
+         * rely on the MTable code to maintain a list of
+         * (port, instance) pairs by keeping track of 
+         * the vlan to instance mapping.
+         **************************************************/
+        err = fm10000MTableUpdateListenerState(sw,
+                                              instance->instance, 
+                                              currentPort, 
+                                              state);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+
+    }
+
+    /***************************************************
+     * Now proceed to update the instance itself.  
+     **************************************************/
+
+    memset( ingressStates, 0, sizeof(ingressStates) );
+    egressStates = 0;
+
+    /***************************************************
+     * Build the ingress and egress state words.  To avoid
+     * reading, we always recompute the entire table
+     * since it takes the same amount of work and 
+     * all the information is already here.
+     **************************************************/
+    for ( cpi = 0 ; cpi < switchPtr->numCardinalPorts ; cpi++ )
+    {
+        fmMapCardinalPortInternal(switchPtr, cpi, &currentPort, &physPort);
+
+        state = instance->states[cpi];
+
+        /***************************************************
+         * In FM4xxx, the CPU port was always forwarding,
+         * so we preserve this behaviour.
+         **************************************************/
+        if (currentPort == switchPtr->cpuPort)
+        {
+            state = FM_STP_STATE_FORWARDING;
+        }
+
+        switch (state)
+        {
+            case FM_STP_STATE_DISABLED:
+            case FM_STP_STATE_BLOCKING:
+                portIngressState = FM10000_STPSTATE_DISABLED;
+                portEgressState  = 0;
+                break;
+
+            case FM_STP_STATE_LISTENING:
+                portIngressState = FM10000_STPSTATE_LISTENING;
+                portEgressState  = 0;
+                break;
+
+            case FM_STP_STATE_LEARNING:
+                portIngressState = FM10000_STPSTATE_LEARNING;
+                portEgressState  = 0;
+                break;
+
+            case FM_STP_STATE_FORWARDING:
+                portIngressState = FM10000_STPSTATE_FORWARDING;
+                portEgressState  = 1;
+                break;
+
+            default:
+                err = FM_FAIL;
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+        }
+
+        if (physPort <= 23)
+        {
+            ingressStates[0] |= portIngressState << (physPort * 2);
+        }
+        else
+        {
+            ingressStates[1] |= portIngressState << ( (physPort - 24) * 2 );
+        }
+
+        egressStates |= portEgressState << physPort;
+
+    }
+
+    err = WriteIngressMstTable(sw, 0, instance->instance, ingressStates[0]);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+
+    err = WriteIngressMstTable(sw, 1, instance->instance, ingressStates[1]);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+
+    err = WriteEgressMstTable(sw, instance->instance, egressStates);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_STP, err);
+
+}   /* end WriteSpanningTreeState */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -374,18 +538,8 @@ fm_status fm10000RefreshSpanningTree(fm_int             sw,
                                      fm_int              port)
 {
     fm_status   err;
-    fm_switch * switchPtr;
-    fm_int      currentPort;
-    fm_int      physPort;
-    fm_int      cpi;
     fm_int      mcastSearchPortList[FM10000_NUM_PORTS];
     fm_int      numPortsForMcastSearch;
-    fm_int      index;
-    fm_int      state;
-    fm_uint64   portIngressState;
-    fm_uint64   portEgressState;
-    fm_uint64   ingressStates[FM10000_INGRESS_MST_TABLE_ENTRIES_1];
-    fm_uint64   egressStates;
 
     FM_LOG_ENTRY(FM_LOG_CAT_STP,
                  "sw=%d, instance=%p, vlan=%d, port=%d\n",
@@ -394,8 +548,6 @@ fm_status fm10000RefreshSpanningTree(fm_int             sw,
                  vlan, 
                  port);
 
-    switchPtr = GET_SWITCH_PTR(sw);
-
     /***************************************************
      * On FM10000, we only need to write to the hardware
      * when we change STP state, not when VLANs are
@@ -427,118 +579,62 @@ fm_status fm10000RefreshSpanningTree(fm_int             sw,
         mcastSearchPortList[0] = port;
     }
 
-    /***************************************************
-     * Update the MTable state using the list of ports
-     * computed in mcastSearchPortList
-     **************************************************/
+    err = WriteSpanningTreeState(sw,
+                                 instance,
+                                 numPortsForMcastSearch,
+                                 mcastSearchPortList);
 
-    for ( index = 0 ; index < numPortsForMcastSearch ; index++ )
-    {
-        currentPort = mcastSearchPortList[index];
-        cpi = GET_PORT_INDEX(sw, currentPort);
-        state = instance->states[cpi];
-
-        /***************************************************
-         * The IP multicast table is not STP aware, so now
-         * let us inform the MTable code to skip any
-         * instances of this (port, instance) pair before we
-         * update the port's STP state.  Note that we 
-         * rely on the MTable code to maintain a list of
-         * (port, instance) pairs by keeping track of 
-         * the vlan to instance mapping.
-         **************************************************/
-        err = fm10000MTableUpdateListenerState(sw,
-                                              instance->instance, 
-                                              currentPort, 
-                                              state);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
-
-    }
-
-    /***************************************************
-     * Now proceed to update the instance itself.  
-     **************************************************/
-
-    memset( ingressStates, 0, sizeof(ingressStates) );
-    egressStates = 0;
-
-    /***************************************************
-     * Build the ingress and egress state words.  To avoid
-     * reading, we always recompute the entire table
-     * since it takes the same amount of work and 
-     * all the information is already here.
-     **************************************************/
-    for ( cpi = 0 ; cpi < switchPtr->numCardinalPorts ; cpi++ )
-    {
-        fmMapCardinalPortInternal(switchPtr, cpi, &currentPort, &physPort);
-
-        state = instance->states[cpi];
-
-        /***************************************************
-         * In FM4xxx, the CPU port was always forwarding,
-         * so we preserve this behaviour.
-         **************************************************/
-        if (currentPort == switchPtr->cpuPort)
-        {
-            state = FM_STP_STATE_FORWARDING;
-        }
-
-        switch (state)
-        {
-            case FM_STP_STATE_DISABLED:
-            case FM_STP_STATE_BLOCKING:
-                portIngressState = FM10000_STPSTATE_DISABLED;
-                portEgressState  = 0;
-                break;
-
-            case FM_STP_STATE_LISTENING:
-                portIngressState = FM10000_STPSTATE_LISTENING;
-                portEgressState  = 0;
-                break;
-
-            case FM_STP_STATE_LEARNING:
-                portIngressState = FM10000_STPSTATE_LEARNING;
-                portEgressState  = 0;
-                break;
-
-            case FM_STP_STATE_FORWARDING:
-                portIngressState = FM10000_STPSTATE_FORWARDING;
-                portEgressState  = 1;
-                break;
-
-            default:
-                err = FM_FAIL;
-                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
-        }
+ABORT:
 
-        if (physPort <= 23)
-        {
-            ingressStates[0] |= portIngressState << (physPort * 2);
-        }
-        else
-        {
-            ingressStates[1] |= portIngressState << ( (physPort - 24) * 2 );
-        }
+    FM_LOG_EXIT(FM_LOG_CAT_STP, err);
 
-        egressStates |= portEgressState << physPort;
+}   /* end fm10000RefreshSpanningTree */
 
-    }
 
-    err = WriteIngressMstTable(sw, 0, instance->instance, ingressStates[0]);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
 
-    err = WriteIngressMstTable(sw, 1, instance->instance, ingressStates[1]);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
 
-    err = WriteEgressMstTable(sw, instance->instance, egressStates);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+/*****************************************************************************/
+/** fm10000RefreshSpanningTreePortList
+ * \ingroup intStp
+ *
+ * \desc            Updates the hardware STP state of a spanning tree
+ *                  instance after the software state of several of its
+ *                  ports has been changed. The MST table entries are written
+ *                  once for the whole list. Called through the
+ *                  RefreshSpanningTreePortList function pointer.
+ *
+ * \param[in]       sw is the switch number to operate on.
+ *
+ * \param[in]       instance points to the info structure for the
+ *                  STP instance.
+ *
+ * \param[in]       numPorts is the number of ports in portList.
+ *
+ * \param[in]       portList points to the list of ports whose state
+ *                  changed.
+ *
+ * \return          FM_OK on success.
+ *
+ *****************************************************************************/
+fm_status fm10000RefreshSpanningTreePortList(fm_int              sw,
+                                             fm_stpInstanceInfo *instance,
+                                             fm_int              numPorts,
+                                             fm_int *            portList)
+{
+    fm_status err;
 
+    FM_LOG_ENTRY(FM_LOG_CAT_STP,
+                 "sw=%d, instance=%p, numPorts=%d, portList=%p\n",
+                 sw,
+                 (void *) instance,
+                 numPorts,
+                 (void *) portList);
 
-ABORT:
+    err = WriteSpanningTreeState(sw, instance, numPorts, portList);
 
     FM_LOG_EXIT(FM_LOG_CAT_STP, err);
 
-}   /* end fm10000RefreshSpanningTree */
+}   /* end fm10000RefreshSpanningTreePortList */
 
 
 
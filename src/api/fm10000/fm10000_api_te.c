@@ -57,6 +57,10 @@
 
 #define FM10000_TE_MAX_SYNC_RETRY       1000
 
+/* Number of flow counters or used words moved per register burst */
+#define FM10000_TE_FLOW_CNT_BURST       64
+#define FM10000_TE_USED_BURST           64
+
 #define FM10000_TE_ENCAP_VERSION_MAX    3
 #define FM10000_TE_MODE_MAX             1
 
@@ -4339,8 +4343,6 @@ ABORT:
 fm_status fm10000ResetTeFlowUsed(fm_int  sw,
                                  fm_int  te)
 {
-    fm_switch *switchPtr;
-    fm_int     i;
     fm_status  err = FM_OK;
 
     FM_LOG_ENTRY( FM_LOG_CAT_TE,
@@ -4357,17 +4359,208 @@ fm_status fm10000ResetTeFlowUsed(fm_int  sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
     }
 
+    /* sanity check on the arguments */
+    FM_API_REQUIRE(te < FM10000_TE_USED_ENTRIES_1, FM_ERR_INVALID_ARGUMENT);
+
+    /* Clear the whole table */
+    err = fm10000ResetTeFlowUsedRange(sw, te, 0, FM10000_TE_USED_ENTRIES_0, NULL);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_TE, err);
+
+}   /* end fm10000ResetTeFlowUsed */
+
+
+
+
+/*****************************************************************************/
+/** fm10000GetTeFlowCntRange
+ * \ingroup intlowlevTe10k
+ *
+ * \desc            Retrieve a range of consecutive tunneling engine flow
+ *                  counters, reading the counter table in blocks.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ * 
+ * \param[in]       te is the tunneling engine on which to operate.
+ * 
+ * \param[in]       firstIndex is the first counter index of the range.
+ * 
+ * \param[in]       numEntries is the number of counters in the range.
+ * 
+ * \param[out]      frameCnt points to an array of numEntries elements that
+ *                  receives the frame count of each counter.
+ * 
+ * \param[out]      byteCnt points to an array of numEntries elements that
+ *                  receives the byte count of each counter.
+ * 
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_SWITCH_TYPE if sw does not support this API.
+ * \return          FM_ERR_INVALID_ARGUMENT if the range is invalid.
+ *
+ *****************************************************************************/
+fm_status fm10000GetTeFlowCntRange(fm_int     sw,
+                                   fm_int     te,
+                                   fm_int     firstIndex,
+                                   fm_int     numEntries,
+                                   fm_uint64 *frameCnt,
+                                   fm_uint64 *byteCnt)
+{
+    fm_switch *switchPtr;
+    fm_status  err = FM_OK;
+    fm_uint32  teStats[FM10000_TE_FLOW_CNT_BURST * FM10000_TE_STATS_WIDTH];
+    fm_int     index;
+    fm_int     burst;
+    fm_int     i;
+
+    FM_LOG_ENTRY( FM_LOG_CAT_TE,
+                  "sw = %d, "
+                  "te = %d, "
+                  "firstIndex = %d, "
+                  "numEntries = %d, "
+                  "frameCnt = %p, "
+                  "byteCnt = %p\n",
+                  sw,
+                  te,
+                  firstIndex,
+                  numEntries,
+                  (void*) frameCnt,
+                  (void*) byteCnt );
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    if (!fmSupportsTe(sw))
+    {
+        err = FM_ERR_INVALID_SWITCH_TYPE;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    /* sanity check on the arguments */
+    FM_API_REQUIRE(te < FM10000_TE_STATS_ENTRIES_1, FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(firstIndex >= 0, FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(numEntries >= 0, FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(firstIndex + numEntries <= FM10000_TE_STATS_ENTRIES_0,
+                   FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(frameCnt != NULL, FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(byteCnt != NULL, FM_ERR_INVALID_ARGUMENT);
+
+    /* Cache API is not used for this register */
+    for (index = 0 ; index < numEntries ; index += burst)
+    {
+        burst = numEntries - index;
+        if (burst > FM10000_TE_FLOW_CNT_BURST)
+        {
+            burst = FM10000_TE_FLOW_CNT_BURST;
+        }
+
+        err = switchPtr->ReadUINT32Mult(sw,
+                                        FM10000_TE_STATS(te, firstIndex + index, 0),
+                                        burst * FM10000_TE_STATS_WIDTH,
+                                        teStats);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+
+        for (i = 0 ; i < burst ; i++)
+        {
+            frameCnt[index + i] =
+                FM_ARRAY_GET_FIELD64(&teStats[i * FM10000_TE_STATS_WIDTH],
+                                     FM10000_TE_STATS,
+                                     Frames);
+
+            byteCnt[index + i] =
+                FM_ARRAY_GET_FIELD64(&teStats[i * FM10000_TE_STATS_WIDTH],
+                                     FM10000_TE_STATS,
+                                     Bytes);
+        }
+    }
+
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_TE, err);
+
+}   /* end fm10000GetTeFlowCntRange */
+
+
+
+
+/*****************************************************************************/
+/** fm10000GetTeFlowUsedRange
+ * \ingroup intlowlevTe10k
+ *
+ * \desc            Retrieve a range of the tunneling engine usage bit table,
+ *                  64 flow pointers per word. The usage bit of flow pointer
+ *                  index is bit (index % 64) of word (index / 64).
+ *
+ * \param[in]       sw is the switch on which to operate.
+ * 
+ * \param[in]       te is the tunneling engine on which to operate.
+ * 
+ * \param[in]       firstWord is the first word of the range.
+ * 
+ * \param[in]       numWords is the number of words in the range.
+ * 
+ * \param[out]      usedWords points to an array of numWords elements that
+ *                  receives the usage bit words.
+ * 
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_SWITCH_TYPE if sw does not support this API.
+ * \return          FM_ERR_INVALID_ARGUMENT if the range is invalid.
+ *
+ *****************************************************************************/
+fm_status fm10000GetTeFlowUsedRange(fm_int     sw,
+                                    fm_int     te,
+                                    fm_int     firstWord,
+                                    fm_int     numWords,
+                                    fm_uint64 *usedWords)
+{
+    fm_switch *switchPtr;
+    fm_status  err = FM_OK;
+
+    FM_LOG_ENTRY( FM_LOG_CAT_TE,
+                  "sw = %d, "
+                  "te = %d, "
+                  "firstWord = %d, "
+                  "numWords = %d, "
+                  "usedWords = %p\n",
+                  sw,
+                  te,
+                  firstWord,
+                  numWords,
+                  (void*) usedWords );
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    if (!fmSupportsTe(sw))
+    {
+        err = FM_ERR_INVALID_SWITCH_TYPE;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+    }
+
     switchPtr = GET_SWITCH_PTR(sw);
 
     /* sanity check on the arguments */
     FM_API_REQUIRE(te < FM10000_TE_USED_ENTRIES_1, FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(firstWord >= 0, FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(numWords >= 0, FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(firstWord + numWords <= FM10000_TE_USED_ENTRIES_0,
+                   FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(usedWords != NULL, FM_ERR_INVALID_ARGUMENT);
 
-    /* Clear the whole table */
-    for (i = 0 ; i < FM10000_TE_USED_ENTRIES_0; i++)
+    if (numWords > 0)
     {
-        err = switchPtr->WriteUINT64(sw,
-                                     FM10000_TE_USED(te, i, 0),
-                                     0);
+        err = switchPtr->ReadUINT64Mult(sw,
+                                        FM10000_TE_USED(te, firstWord, 0),
+                                        numWords,
+                                        usedWords);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
     }
 
@@ -4377,7 +4570,132 @@ ABORT:
 
     FM_LOG_EXIT(FM_LOG_CAT_TE, err);
 
-}   /* end fm10000ResetTeFlowUsed */
+}   /* end fm10000GetTeFlowUsedRange */
+
+
+
+
+/*****************************************************************************/
+/** fm10000ResetTeFlowUsedRange
+ * \ingroup intlowlevTe10k
+ *
+ * \desc            Read and clear a range of the tunneling engine usage bit
+ *                  table, 64 flow pointers per word. The range is processed
+ *                  in blocks, each one read and cleared under the register
+ *                  lock. A bit set by the hardware between the read and the
+ *                  clear of its block is lost, as with
+ *                  ''fm10000GetTeFlowUsed'' followed by
+ *                  ''fm10000SetTeFlowUsed''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ * 
+ * \param[in]       te is the tunneling engine on which to operate.
+ * 
+ * \param[in]       firstWord is the first word of the range.
+ * 
+ * \param[in]       numWords is the number of words in the range.
+ * 
+ * \param[out]      usedWords points to an array of numWords elements that
+ *                  receives the usage bit words read before they were
+ *                  cleared. May be NULL to only clear them.
+ * 
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_SWITCH_TYPE if sw does not support this API.
+ * \return          FM_ERR_INVALID_ARGUMENT if the range is invalid.
+ *
+ *****************************************************************************/
+fm_status fm10000ResetTeFlowUsedRange(fm_int     sw,
+                                      fm_int     te,
+                                      fm_int     firstWord,
+                                      fm_int     numWords,
+                                      fm_uint64 *usedWords)
+{
+    fm_switch *switchPtr;
+    fm_status  err = FM_OK;
+    fm_uint64  zeros[FM10000_TE_USED_BURST];
+    fm_int     word;
+    fm_int     burst;
+    fm_bool    regLockTaken = FALSE;
+
+    FM_LOG_ENTRY( FM_LOG_CAT_TE,
+                  "sw = %d, "
+                  "te = %d, "
+                  "firstWord = %d, "
+                  "numWords = %d, "
+                  "usedWords = %p\n",
+                  sw,
+                  te,
+                  firstWord,
+                  numWords,
+                  (void*) usedWords );
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    if (!fmSupportsTe(sw))
+    {
+        err = FM_ERR_INVALID_SWITCH_TYPE;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    /* sanity check on the arguments */
+    FM_API_REQUIRE(te < FM10000_TE_USED_ENTRIES_1, FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(firstWord >= 0, FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(numWords >= 0, FM_ERR_INVALID_ARGUMENT);
+    FM_API_REQUIRE(firstWord + numWords <= FM10000_TE_USED_ENTRIES_0,
+                   FM_ERR_INVALID_ARGUMENT);
+
+    FM_CLEAR(zeros);
+
+    for (word = 0 ; word < numWords ; word += burst)
+    {
+        burst = numWords - word;
+        if (burst > FM10000_TE_USED_BURST)
+        {
+            burst = FM10000_TE_USED_BURST;
+        }
+
+        /**************************************************
+         * Acquire the regLock, so that no usage bit set
+         * through fm10000SetTeFlowUsed is lost between the
+         * read and the clear.
+         **************************************************/
+        TAKE_REG_LOCK(sw);
+        regLockTaken = TRUE;
+
+        if (usedWords != NULL)
+        {
+            err = switchPtr->ReadUINT64Mult(sw,
+                                            FM10000_TE_USED(te, firstWord + word, 0),
+                                            burst,
+                                            &usedWords[word]);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+        }
+
+        err = switchPtr->WriteUINT64Mult(sw,
+                                         FM10000_TE_USED(te, firstWord + word, 0),
+                                         burst,
+                                         zeros);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+
+        DROP_REG_LOCK(sw);
+        regLockTaken = FALSE;
+    }
+
+
+ABORT:
+    if (regLockTaken)
+    {
+        DROP_REG_LOCK(sw);
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_TE, err);
+
+}   /* end fm10000ResetTeFlowUsedRange */
 
 
 
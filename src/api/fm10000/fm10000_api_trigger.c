@@ -55,6 +55,15 @@
 
 #define RATE_LIM_USAGE_TO_BYTES               16
 
+/* HW index of a trigger entry that has not been placed yet */
+#define INVALID_TRIGGER_INDEX                 0xFFFFFFFF
+
+/* Number of free HW indexes left in front of a new precedence group
+ * appended after the last trigger (and behind one prepended before the
+ * first), so later rules of the neighbouring group can be added without
+ * moving any trigger. */
+#define TRIGGER_GROUP_GAP                     2
+
 /* The random value generator gives a 24-bit random value */
 #define MAX_RANDOM_VALUE    (1 << 24)
 #define MAX_RANDOM_EXP      0x18
@@ -1633,13 +1642,15 @@ static fm_status MoveTrigger(fm_int                sw,
                              fm10000_triggerEntry* trigEntry,
                              fm_bool               direction)
 {
-    fm_switch * switchPtr;
-    fm_status   err;
-    fm_uint32   srcIndex;
-    fm_uint32   dstIndex;
-    fm_uint32   regCondCfg;
-    fm_bool     srcMatchByPrec;
-    fm_uint64   srcCounter;
+    fm_switch *           switchPtr;
+    fm10000_switch *      switchExt;
+    fm10000_triggerInfo * trigInfo;
+    fm_status             err;
+    fm_uint32             srcIndex;
+    fm_uint32             dstIndex;
+    fm_uint32             regCondCfg;
+    fm_bool               srcMatchByPrec;
+    fm_uint64             srcCounter;
     
     FM_LOG_ENTRY(FM_LOG_CAT_TRIGGER, 
                  "sw = %d, trigEntry = %p, direction = %d\n",
@@ -1648,6 +1659,8 @@ static fm_status MoveTrigger(fm_int                sw,
                  direction);
 
     switchPtr = GET_SWITCH_PTR(sw);
+    switchExt = GET_SWITCH_EXT(sw);
+    trigInfo  = &switchExt->triggerInfo;
 
     srcIndex = trigEntry->index;
 
@@ -1734,6 +1747,9 @@ static fm_status MoveTrigger(fm_int                sw,
 
     trigEntry->index = dstIndex;
 
+    trigInfo->slotEntry[srcIndex] = NULL;
+    trigInfo->slotEntry[dstIndex] = trigEntry;
+
 ABORT:
     FM_LOG_EXIT(FM_LOG_CAT_TRIGGER, err);
 
@@ -1741,6 +1757,377 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** WriteMatchByPrec
+ * \ingroup triggerInt
+ *
+ * \desc            Updates the MatchByPrecedence bit of a HW trigger entry
+ *                  without touching the rest of its configuration.
+ * 
+ * \param[in]       sw is the switch to operate on.
+ * 
+ * \param[in]       index is the HW trigger index.
+ * 
+ * \param[in]       matchByPrec is the value to write.
+ * 
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status WriteMatchByPrec(fm_int   sw,
+                                  fm_uint32 index,
+                                  fm_bool  matchByPrec)
+{
+    fm_switch * switchPtr;
+    fm_status   err;
+    fm_uint32   regCondCfg;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    err = switchPtr->ReadUINT32(sw, 
+                                FM10000_TRIGGER_CONDITION_CFG(index),
+                                &regCondCfg);
+
+    if ( (err == FM_OK) &&
+         ( FM_GET_BIT(regCondCfg, 
+                      FM10000_TRIGGER_CONDITION_CFG, 
+                      MatchByPrecedence) != (fm_uint32) matchByPrec ) )
+    {
+        FM_SET_BIT(regCondCfg, 
+                   FM10000_TRIGGER_CONDITION_CFG, 
+                   MatchByPrecedence, 
+                   matchByPrec);
+
+        err = switchPtr->WriteUINT32(sw, 
+                                     FM10000_TRIGGER_CONDITION_CFG(index),
+                                     regCondCfg);
+    }
+
+    return err;
+
+}   /* end WriteMatchByPrec */
+
+
+
+
+/*****************************************************************************/
+/** FindPlacedNeighbour
+ * \ingroup triggerInt
+ *
+ * \desc            Finds the closest trigger before or after a tree key
+ *                  that already has a HW index.
+ * 
+ * \param[in]       trigInfo points to the trigger state.
+ * 
+ * \param[in]       key is the tree key to start from.
+ * 
+ * \param[in]       after is TRUE to search for the next trigger, FALSE for
+ *                  the previous one.
+ * 
+ * \param[out]      neighbourKey receives the key of the trigger found.
+ * 
+ * \param[out]      neighbour receives the trigger found.
+ * 
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MORE if there is no such trigger.
+ *
+ *****************************************************************************/
+static fm_status FindPlacedNeighbour(fm10000_triggerInfo *  trigInfo,
+                                     fm_uint64              key,
+                                     fm_bool                after,
+                                     fm_uint64 *            neighbourKey,
+                                     fm10000_triggerEntry **neighbour)
+{
+    fm_status err;
+
+    for ( ; ; )
+    {
+        if (after)
+        {
+            err = fmTreeSuccessor(&trigInfo->triggerTree,
+                                  key,
+                                  neighbourKey,
+                                  (void **) neighbour);
+        }
+        else
+        {
+            err = fmTreePredecessor(&trigInfo->triggerTree,
+                                    key,
+                                    neighbourKey,
+                                    (void **) neighbour);
+        }
+
+        if ( (err != FM_OK) || 
+             ((*neighbour)->index != INVALID_TRIGGER_INDEX) )
+        {
+            return err;
+        }
+
+        key = *neighbourKey;
+    }
+
+}   /* end FindPlacedNeighbour */
+
+
+
+
+/*****************************************************************************/
+/** PlaceTrigger
+ * \ingroup triggerInt
+ *
+ * \desc            Assigns a HW index to a trigger that has been inserted in
+ *                  the trigger tree, and writes it as an invalid trigger.
+ *                  A free index between the neighbouring triggers is used
+ *                  when there is one; otherwise the triggers between the
+ *                  insertion point and the closest free index are shifted
+ *                  by one, in whichever direction moves fewer triggers.
+ * 
+ * \param[in]       sw is the switch to operate on.
+ * 
+ * \param[in]       key is the tree key of the trigger.
+ * 
+ * \param[in]       trigEntry is the trigger to place.
+ * 
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_TRIGGER_UNAVAILABLE if there are no free
+ *                  triggers.
+ *
+ *****************************************************************************/
+static fm_status PlaceTrigger(fm_int                sw,
+                              fm_uint64             key,
+                              fm10000_triggerEntry *trigEntry)
+{
+    fm_status             err;
+    fm_switch *           switchPtr;
+    fm10000_switch *      switchExt;
+    fm10000_triggerInfo * trigInfo;
+    fm10000_triggerEntry *prevEntry;
+    fm10000_triggerEntry *nextEntry;
+    fm_uint64             prevKey;
+    fm_uint64             nextKey;
+    fm_int                group;
+    fm_int                lo;
+    fm_int                hi;
+    fm_int                index;
+    fm_int                upFree;
+    fm_int                downFree;
+    fm_int                i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_TRIGGER, 
+                 "sw = %d, key = 0x%llx\n",
+                 sw,
+                 key);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    switchExt = GET_SWITCH_EXT(sw);
+    trigInfo  = &switchExt->triggerInfo;
+    group     = FM10000_TRIGGER_KEY_TO_GROUP(key);
+
+    if (FindPlacedNeighbour(trigInfo, key, FALSE, &prevKey, &prevEntry) != FM_OK)
+    {
+        prevEntry = NULL;
+    }
+
+    if (FindPlacedNeighbour(trigInfo, key, TRUE, &nextKey, &nextEntry) != FM_OK)
+    {
+        nextEntry = NULL;
+    }
+
+    /* Range of free indexes between the neighbours */
+    lo = (prevEntry != NULL) ? (fm_int) prevEntry->index + 1 : 0;
+    hi = (nextEntry != NULL) ? (fm_int) nextEntry->index - 1 
+                             : FM10000_MAX_HW_TRIGGERS - 1;
+
+    if (lo <= hi)
+    {
+        /* Stay adjacent to a neighbour of the same group, so that a group
+         * never contains free indexes it did not get from a deletion. */
+        if ( (prevEntry != NULL) && 
+             (FM10000_TRIGGER_KEY_TO_GROUP(prevKey) == group) )
+        {
+            index = lo;
+        }
+        else if ( (nextEntry != NULL) && 
+                  (FM10000_TRIGGER_KEY_TO_GROUP(nextKey) == group) )
+        {
+            index = hi;
+        }
+        else if ( (prevEntry != NULL) && (nextEntry != NULL) )
+        {
+            /* New group between two others, split the room */
+            index = lo + (hi - lo) / 2;
+        }
+        else if (prevEntry != NULL)
+        {
+            index = lo + ( (hi - lo > TRIGGER_GROUP_GAP) ? TRIGGER_GROUP_GAP 
+                                                         : (hi - lo) / 2 );
+        }
+        else if (nextEntry != NULL)
+        {
+            index = hi - ( (hi - lo > TRIGGER_GROUP_GAP) ? TRIGGER_GROUP_GAP 
+                                                         : (hi - lo) / 2 );
+        }
+        else
+        {
+            index = 0;
+        }
+    }
+    else
+    {
+        /* No room between the neighbours: find the closest free index
+         * on each side and shift the triggers in between. */
+        upFree = -1;
+
+        if (prevEntry != NULL)
+        {
+            for (i = (fm_int) prevEntry->index ; i >= 0 ; i--)
+            {
+                if (trigInfo->slotEntry[i] == NULL)
+                {
+                    upFree = i;
+                    break;
+                }
+            }
+        }
+
+        downFree = -1;
+
+        if (nextEntry != NULL)
+        {
+            for (i = (fm_int) nextEntry->index ; 
+                 i < FM10000_MAX_HW_TRIGGERS ; 
+                 i++)
+            {
+                if (trigInfo->slotEntry[i] == NULL)
+                {
+                    downFree = i;
+                    break;
+                }
+            }
+        }
+
+        if ( (upFree < 0) && (downFree < 0) )
+        {
+            err = FM_ERR_TRIGGER_UNAVAILABLE;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
+        }
+
+        if ( (downFree >= 0) &&
+             ( (upFree < 0) || 
+               ( (downFree - (fm_int) nextEntry->index) <= 
+                 ((fm_int) prevEntry->index - upFree) ) ) )
+        {
+            index = nextEntry->index;
+
+            for (i = downFree - 1 ; i >= index ; i--)
+            {
+                err = MoveTrigger(sw, trigInfo->slotEntry[i], 1);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
+            }
+        }
+        else
+        {
+            index = prevEntry->index;
+
+            for (i = upFree + 1 ; i <= index ; i++)
+            {
+                err = MoveTrigger(sw, trigInfo->slotEntry[i], 0);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
+            }
+        }
+    }
+
+    trigEntry->index = index;
+
+    /* Write the trigger as invalid, start with condition in case
+     * there was an old trigger active and so that the
+     * matchByPrecedence has the right value in HW. */
+    err = fm10000WriteTriggerCondition(sw, 
+                                       trigEntry->index, 
+                                       trigEntry->cond, 
+                                       trigEntry->matchByPrec);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
+
+    err = fm10000WriteTriggerAction(sw, 
+                                    trigEntry->index, 
+                                    trigEntry->action,
+                                    trigEntry->mirrorIndex);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
+
+    /* Clear the trigger counter. */
+    err = switchPtr->WriteUINT64(sw, 
+                                 FM10000_TRIGGER_STATS(trigEntry->index, 0), 
+                                 0);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
+
+    trigInfo->slotEntry[index] = trigEntry;
+    trigInfo->numUsedTriggers++;
+
+ABORT:
+    if (err != FM_OK)
+    {
+        trigEntry->index = INVALID_TRIGGER_INDEX;
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_TRIGGER, err);
+
+}   /* end PlaceTrigger */
+
+
+
+
+/*****************************************************************************/
+/** RemoveTriggerEntry
+ * \ingroup triggerInt
+ *
+ * \desc            Invalidates the HW index of a trigger, if it has one,
+ *                  and removes the trigger from the tree. Other triggers
+ *                  are not moved; the freed index is left as a gap.
+ * 
+ * \param[in]       sw is the switch to operate on.
+ * 
+ * \param[in]       key is the tree key of the trigger.
+ * 
+ * \param[in]       trigEntry is the trigger to remove.
+ * 
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status RemoveTriggerEntry(fm_int                sw,
+                                    fm_uint64             key,
+                                    fm10000_triggerEntry *trigEntry)
+{
+    fm_status             err;
+    fm10000_switch *      switchExt;
+    fm10000_triggerInfo * trigInfo;
+    fm_uint32             index;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    trigInfo  = &switchExt->triggerInfo;
+    index     = trigEntry->index;
+    err       = FM_OK;
+
+    if (index != INVALID_TRIGGER_INDEX)
+    {
+        /* A gap always continues the previous precedence group */
+        err = fm10000WriteTriggerCondition(sw, index, &invalidCond, TRUE);
+
+        if (err == FM_OK)
+        {
+            err = fm10000WriteTriggerAction(sw, index, &invalidAction, 0);
+        }
+
+        trigInfo->slotEntry[index] = NULL;
+        trigInfo->numUsedTriggers--;
+    }
+
+    fmTreeRemoveCertain(&trigInfo->triggerTree, key, NULL);
+
+    return err;
+
+}   /* end RemoveTriggerEntry */
+
+
+
 
 /*****************************************************************************
  * Public Functions
@@ -2258,173 +2645,236 @@ fm_status fm10000CreateTrigger(fm_int  sw,
                                fm_int  rule, 
                                fm_bool isInternal,
                                fm_text name)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_TRIGGER, 
+                 "sw = %d, group = %d, rule = %d\n",
+                 sw,
+                 group, 
+                 rule);
+
+    err = fm10000CreateTriggerList(sw, 1, &group, &rule, isInternal, &name);
+
+    FM_LOG_EXIT(FM_LOG_CAT_TRIGGER, err);
+
+}   /* end fm10000CreateTrigger */
+
+
+
+
+/*****************************************************************************/
+/** fm10000CreateTriggerList
+ * \ingroup triggerInt
+ *
+ * \desc            Create a set of triggers in one operation. All triggers
+ *                  are inserted first, then each is given a HW index in
+ *                  precedence order, so existing triggers are shifted at
+ *                  most once per new trigger and only when there is no free
+ *                  index at the insertion point.
+ *
+ * \note            See ''fm10000CreateTrigger'' for the state of each
+ *                  created trigger. Either all triggers are created or none
+ *                  is.
+ * 
+ * \param[in]       sw is the switch on which to operate.
+ * 
+ * \param[in]       numTriggers is the number of entries in groupList,
+ *                  ruleList and nameList.
+ * 
+ * \param[in]       groupList points to the group of each trigger.
+ * 
+ * \param[in]       ruleList points to the rule number of each trigger.
+ * 
+ * \param[in]       isInternal should be set to true for the triggers to be
+ *                  only modifiable/deletable by internal calls.
+ * 
+ * \param[in]       nameList points to the name of each trigger, used for
+ *                  diagnostics only. May be NULL, as may any entry.
+ * 
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if a list pointer is NULL.
+ * \return          FM_ERR_ALREADY_EXISTS if a trigger already exists for
+ *                  one of the group/rule combinations, or a combination is
+ *                  listed twice.
+ * \return          FM_ERR_TRIGGER_UNAVAILABLE if there are not enough free
+ *                  triggers.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ * 
+ *****************************************************************************/
+fm_status fm10000CreateTriggerList(fm_int   sw,
+                                   fm_int   numTriggers,
+                                   fm_int * groupList,
+                                   fm_int * ruleList,
+                                   fm_bool  isInternal,
+                                   fm_text *nameList)
 {
     fm_status             err = FM_OK;
-    fm_switch *           switchPtr;
     fm10000_switch *      switchExt;
     fm10000_triggerInfo * trigInfo;
     fm10000_triggerEntry *trigEntry;
-    fm_bool               trigEntryAllocated;
-    fm_bool               trigEntryInserted;
-    
+    fm10000_triggerEntry *nextTrigEntry;
     fm_treeIterator       triggerIt;
-
+    fm_uint64             key;
     fm_uint64             nextKey;
-    fm10000_triggerEntry *nextTrigEntry;
-    fm10000_triggerEntry *lastTrigEntry;
-    
+    fm_int                numInserted;
+    fm_int                i;
+
     FM_LOG_ENTRY(FM_LOG_CAT_TRIGGER, 
-                 "sw = %d, group = %d, rule = %d\n",
+                 "sw = %d, numTriggers = %d\n",
                  sw,
-                 group, 
-                 rule);
+                 numTriggers);
+
+    if ( (numTriggers < 0) ||
+         ( (numTriggers > 0) && ((groupList == NULL) || (ruleList == NULL)) ) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_TRIGGER, FM_ERR_INVALID_ARGUMENT);
+    }
 
     TAKE_TRIGGER_LOCK(sw);
 
-    trigEntryAllocated = FALSE;
-    trigEntryInserted  = FALSE;
-    switchPtr          = GET_SWITCH_PTR(sw);
-    switchExt          = GET_SWITCH_EXT(sw);
-    trigInfo           = &switchExt->triggerInfo;
+    switchExt   = GET_SWITCH_EXT(sw);
+    trigInfo    = &switchExt->triggerInfo;
+    numInserted = 0;
 
-    if (trigInfo->numUsedTriggers >= FM10000_MAX_HW_TRIGGERS)
+    if ( (trigInfo->numUsedTriggers + numTriggers) > FM10000_MAX_HW_TRIGGERS )
     {
         err = FM_ERR_TRIGGER_UNAVAILABLE;
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
     }
 
-    if (fmTreeFind(&trigInfo->triggerTree, 
-                   FM10000_TRIGGER_GROUP_RULE_TO_KEY(group, rule),
-                   (void**) &trigEntry) == FM_OK)
-    {
-        err = FM_ERR_ALREADY_EXISTS;
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
-    }
-
-    trigEntry = fmAlloc(sizeof(fm10000_triggerEntry));
-    if (trigEntry == NULL)
-    {
-        err = FM_ERR_NO_MEM;
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
-    }
-    else
-    {
-        trigEntryAllocated = TRUE;
-    }
+    /**************************************************
+     * Insert all the entries in the tree. The HW index
+     * is unknown at this time.
+     **************************************************/
 
-    /* Initialize the trigger entry, the HW index is unknown at this time */
-    trigEntry->index        = 0xFFFFFFFF;
-    trigEntry->cond         = &invalidCond;
-    trigEntry->action       = &invalidAction;
-    trigEntry->counterCache = 0;
-    trigEntry->isInternal   = isInternal;
-    trigEntry->mirrorIndex  = 0;
-    trigEntry->logProfile   = -1;
-    trigEntry->isBound      = FALSE;
-
-    if (name != NULL)
-    {
-        trigEntry->name = fmStringDuplicate(name);
-    }
-    else
+    for (i = 0 ; i < numTriggers ; i++)
     {
-        trigEntry->name = NULL;
-    }
-
-    /* Insert the entry in the tree */
-    err = fmTreeInsert(&trigInfo->triggerTree, 
-                       FM10000_TRIGGER_GROUP_RULE_TO_KEY(group, rule), 
-                       (void*) trigEntry);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
+        key = FM10000_TRIGGER_GROUP_RULE_TO_KEY(groupList[i], ruleList[i]);
 
-    trigEntryInserted = TRUE;
-    lastTrigEntry     = NULL;
+        if (fmTreeFind(&trigInfo->triggerTree, key, (void**) &trigEntry) == FM_OK)
+        {
+            err = FM_ERR_ALREADY_EXISTS;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
+        }
 
-    err = UpdateMatchByPrec(sw);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
+        trigEntry = fmAlloc(sizeof(fm10000_triggerEntry));
+        if (trigEntry == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
+        }
 
-    /* Starting from the last trigger, move the trigger entries down
-     * until we reach our new trigger */
-    fmTreeIterInitBackwards(&triggerIt, &trigInfo->triggerTree);
+        trigEntry->index        = INVALID_TRIGGER_INDEX;
+        trigEntry->cond         = &invalidCond;
+        trigEntry->action       = &invalidAction;
+        trigEntry->counterCache = 0;
+        trigEntry->isInternal   = isInternal;
+        trigEntry->mirrorIndex  = 0;
+        trigEntry->logProfile   = -1;
+        trigEntry->isBound      = FALSE;
+        trigEntry->matchByPrec  = 0;
+
+        if ( (nameList != NULL) && (nameList[i] != NULL) )
+        {
+            trigEntry->name = fmStringDuplicate(nameList[i]);
+        }
+        else
+        {
+            trigEntry->name = NULL;
+        }
 
-    while ( (err = fmTreeIterNext(&triggerIt, 
-                                  &nextKey, 
-                                  (void**) &nextTrigEntry)) == FM_OK)
-    {
-        /* We're at the trigger we created, just update the index */
-        if (trigEntry == nextTrigEntry)
+        err = fmTreeInsert(&trigInfo->triggerTree, key, (void*) trigEntry);
+        if (err != FM_OK)
         {
-            if (lastTrigEntry != NULL)
-            {
-                trigEntry->index = (lastTrigEntry->index - 1);
-            }
-            else
+            if (trigEntry->name != NULL)
             {
-                trigEntry->index = trigInfo->numUsedTriggers;
+                fmFree(trigEntry->name);
             }
-
-            /* Write the trigger as invalid, start with condition in case
-             * there was an old trigger active and so that the
-             * matchByPrecedence has the right value in HW. */
-            err = fm10000WriteTriggerCondition(sw, 
-                                               trigEntry->index, 
-                                               trigEntry->cond, 
-                                               trigEntry->matchByPrec);
+            fmFree(trigEntry);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
+        }
 
-            err = fm10000WriteTriggerAction(sw, 
-                                            trigEntry->index, 
-                                            trigEntry->action,
-                                            trigEntry->mirrorIndex);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
+        numInserted++;
+    }
 
-            /* Clear the trigger counter. */
-            err = switchPtr->WriteUINT64(sw, 
-                                         FM10000_TRIGGER_STATS(trigEntry->index, 0), 
-                                         0);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
+    err = UpdateMatchByPrec(sw);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
 
-            trigInfo->numUsedTriggers++;
-            break;
-        }
+    /**************************************************
+     * Place the new entries in precedence order. Each
+     * placed trigger may change the MatchByPrecedence
+     * of the trigger that follows it.
+     **************************************************/
 
-        err = MoveTrigger(sw, nextTrigEntry, 1);
+    for (i = 0 ; i < numTriggers ; i++)
+    {
+        key = FM10000_TRIGGER_GROUP_RULE_TO_KEY(groupList[i], ruleList[i]);
+
+        err = fmTreeFind(&trigInfo->triggerTree, key, (void**) &trigEntry);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
 
-        lastTrigEntry = nextTrigEntry;
+        err = PlaceTrigger(sw, key, trigEntry);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
     }
 
-    /* End of iteration */
-    if (err == FM_ERR_NO_MORE)
+    for (i = 0 ; i < numTriggers ; i++)
     {
-        err = FM_OK;
+        key = FM10000_TRIGGER_GROUP_RULE_TO_KEY(groupList[i], ruleList[i]);
+
+        if (fmTreeSuccessor(&trigInfo->triggerTree,
+                            key,
+                            &nextKey,
+                            (void**) &nextTrigEntry) == FM_OK)
+        {
+            err = WriteMatchByPrec(sw, 
+                                   nextTrigEntry->index, 
+                                   nextTrigEntry->matchByPrec);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
+        }
     }
 
 ABORT:
-    if (err != FM_OK)
+    if ( (err != FM_OK) && (numInserted > 0) )
     {
-        if (trigEntryInserted)
+        /* Undo the entries inserted by this call */
+        for (i = 0 ; i < numInserted ; i++)
         {
-            fmTreeRemoveCertain(&trigInfo->triggerTree, 
-                                FM10000_TRIGGER_GROUP_RULE_TO_KEY(group, rule), 
-                                NULL);
-            UpdateMatchByPrec(sw);
-        }
+            key = FM10000_TRIGGER_GROUP_RULE_TO_KEY(groupList[i], ruleList[i]);
 
-        if (trigEntryAllocated)
-        {
-            if (trigEntry->name != NULL)
+            if (fmTreeFind(&trigInfo->triggerTree, 
+                           key, 
+                           (void**) &trigEntry) == FM_OK)
             {
-                fmFree(trigEntry->name);
+                RemoveTriggerEntry(sw, key, trigEntry);
+
+                if (trigEntry->name != NULL)
+                {
+                    fmFree(trigEntry->name);
+                }
+                fmFree(trigEntry);
             }
-            fmFree(trigEntry);
+        }
+
+        UpdateMatchByPrec(sw);
+
+        /* Restore the grouping of the remaining triggers */
+        fmTreeIterInit(&triggerIt, &trigInfo->triggerTree);
+
+        while (fmTreeIterNext(&triggerIt, 
+                              &nextKey, 
+                              (void**) &nextTrigEntry) == FM_OK)
+        {
+            WriteMatchByPrec(sw, 
+                             nextTrigEntry->index, 
+                             nextTrigEntry->matchByPrec);
         }
     }
 
     DROP_TRIGGER_LOCK(sw);
     FM_LOG_EXIT(FM_LOG_CAT_TRIGGER, err);
 
-}   /* end fm10000CreateTrigger */
+}   /* end fm10000CreateTriggerList */
 
 
 
@@ -2466,10 +2916,9 @@ fm_status fm10000DeleteTrigger(fm_int  sw,
     fm10000_switch *      switchExt;
     fm10000_triggerInfo * trigInfo;
     fm10000_triggerEntry *trigEntry;
-    fm_treeIterator       triggerIt;
     fm_uint64             nextKey;
     fm10000_triggerEntry *nextTrigEntry;
-    fm_bool               isLastEntry = FALSE;
+    fm_int                logProfile;
 
     FM_LOG_ENTRY(FM_LOG_CAT_TRIGGER, 
                  "sw = %d, group = %d, rule = %d\n",
@@ -2513,38 +2962,11 @@ fm_status fm10000DeleteTrigger(fm_int  sw,
         fmFree(trigEntry->name);
     }
 
-    /* We must first invalidate the trigger before moving the others */
     trigEntry->cond   = &invalidCond;
     trigEntry->action = &invalidAction;
     trigEntry->mirrorIndex = 0;
 
-    /* Start with condition to disable it, keep the same matchByPrec value
-     * as before */
-    err = fm10000WriteTriggerCondition(sw, 
-                                       trigEntry->index, 
-                                       trigEntry->cond, 
-                                       trigEntry->matchByPrec);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
-
-    err = fm10000WriteTriggerAction(sw, 
-                                    trigEntry->index, 
-                                    trigEntry->action,
-                                    trigEntry->mirrorIndex);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
-
-    /* Delete the log action mirror profile if we created one. */
-    if (trigEntry->logProfile >= 0)
-    {
-        err = fm10000DeleteLogProfile(sw, trigEntry->logProfile);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
-
-        trigEntry->logProfile = -1;
-        trigEntry->isBound = FALSE;
-    }
-
-    /* Before removing the trigger from the tree, get the successor which 
-     * will be used as the starting point for moving the entries up
-     * (to lower indexes). */
+    /* The successor's MatchByPrecedence may change once the entry is gone */
     err = fmTreeSuccessor(&trigInfo->triggerTree, 
                           FM10000_TRIGGER_GROUP_RULE_TO_KEY(group, rule), 
                           &nextKey,
@@ -2552,41 +2974,37 @@ fm_status fm10000DeleteTrigger(fm_int  sw,
 
     if (err == FM_ERR_NO_MORE)
     {
-        isLastEntry = TRUE;
+        nextTrigEntry = NULL;
         err = FM_OK;
     }
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
 
-    /* Remove the entry from the tree (and free memory) */
-    err = fmTreeRemoveCertain(&trigInfo->triggerTree, 
-                              FM10000_TRIGGER_GROUP_RULE_TO_KEY(group, rule),
-                              fmFree);
+    /* Invalidate the entry in place and leave its index free, other
+     * triggers are not moved. */
+    logProfile = trigEntry->logProfile;
+
+    err = RemoveTriggerEntry(sw, 
+                             FM10000_TRIGGER_GROUP_RULE_TO_KEY(group, rule),
+                             trigEntry);
+    fmFree(trigEntry);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
 
-    trigInfo->numUsedTriggers--;
+    /* Delete the log action mirror profile if we created one. */
+    if (logProfile >= 0)
+    {
+        err = fm10000DeleteLogProfile(sw, logProfile);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
+    }
 
     err = UpdateMatchByPrec(sw);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
 
-    if (!isLastEntry)
+    if (nextTrigEntry != NULL)
     {
-        /* Starting from the deleted trigger's next entry, move entries up
-         * (overwriting the deleted trigger) */
-        fmTreeIterInitFromKey(&triggerIt, &trigInfo->triggerTree, nextKey);
-
-        while ( (err = fmTreeIterNext(&triggerIt, 
-                                      &nextKey, 
-                                      (void**) &nextTrigEntry)) == FM_OK)
-        {
-            err = MoveTrigger(sw, nextTrigEntry, 0);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
-        }
-
-        /* End of iteration */        
-        if (err == FM_ERR_NO_MORE)
-        {
-            err = FM_OK;
-        }
+        err = WriteMatchByPrec(sw, 
+                               nextTrigEntry->index, 
+                               nextTrigEntry->matchByPrec);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TRIGGER, err);
     }
 
 ABORT:
@@ -43,6 +43,9 @@
 
 #define BUFFER_SIZE                     1024
 
+/* Number of flow counters read at once by fm10000GetTunnelRuleCountList */
+#define FM10000_TUNNEL_CNT_BLOCK        64
+
 
 /*****************************************************************************
  * Global Variables
@@ -180,12 +183,22 @@ static void FreeTunnelCfgStruct(fm_fm10000TunnelCfg *tunnelCfg)
 
             fmDeleteBitArray(&tunnelCfg->cntInUse[te]);
 
-            for (index = 0 ; index < FM10000_TE_DATA_ENTRIES_0 ; index++)
+            if (tunnelCfg->teDataCtrl[te].teDataBlkCtrl)
             {
-                if (tunnelCfg->teDataCtrl[te].teDataBlkCtrl[index])
+                for (index = 0 ; index < FM10000_TE_DATA_ENTRIES_0 ; index++)
                 {
-                    fmFree(tunnelCfg->teDataCtrl[te].teDataBlkCtrl[index]);
+                    if (tunnelCfg->teDataCtrl[te].teDataBlkCtrl[index])
+                    {
+                        fmFree(tunnelCfg->teDataCtrl[te].teDataBlkCtrl[index]);
+                    }
                 }
+
+                fmFree(tunnelCfg->teDataCtrl[te].teDataBlkCtrl);
+            }
+
+            if (tunnelCfg->teDataCtrl[te].teDataHandler)
+            {
+                fmFree(tunnelCfg->teDataCtrl[te].teDataHandler);
             }
         }
 
@@ -247,6 +260,62 @@ static fm_status InitializeTunnelCfgStruct(fm_fm10000TunnelCfg *tunnelCfg)
 
 
 
+/*****************************************************************************/
+/** AllocTeDataTables
+ * \ingroup intTunnel
+ *
+ * \desc            Allocate the teData handler and block control tables of
+ *                  a TE if not already done. Together they take over half
+ *                  a megabyte per TE, so they are only allocated once the
+ *                  TE gets its first teData block rather than at switch
+ *                  initialization.
+ *
+ * \param[in,out]   teDataCtrl points to the teData control of the TE.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ *
+ *****************************************************************************/
+static fm_status AllocTeDataTables(fm_fm10000TunnelTeDataCtrl *teDataCtrl)
+{
+    fm_uint handlerSize;
+    fm_uint blkCtrlSize;
+
+    if (teDataCtrl->teDataHandler != NULL)
+    {
+        return FM_OK;
+    }
+
+    handlerSize = sizeof(fm_uint16) * FM10000_TE_DATA_ENTRIES_0;
+    blkCtrlSize = sizeof(fm_fm10000TunnelTeDataBlockCtrl *) *
+                  FM10000_TE_DATA_ENTRIES_0;
+
+    teDataCtrl->teDataBlkCtrl = fmAlloc(blkCtrlSize);
+
+    if (teDataCtrl->teDataBlkCtrl == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    teDataCtrl->teDataHandler = fmAlloc(handlerSize);
+
+    if (teDataCtrl->teDataHandler == NULL)
+    {
+        fmFree(teDataCtrl->teDataBlkCtrl);
+        teDataCtrl->teDataBlkCtrl = NULL;
+        return FM_ERR_NO_MEM;
+    }
+
+    FM_MEMSET_S(teDataCtrl->teDataBlkCtrl, blkCtrlSize, 0, blkCtrlSize);
+    FM_MEMSET_S(teDataCtrl->teDataHandler, handlerSize, 0, handlerSize);
+
+    return FM_OK;
+
+}   /* end AllocTeDataTables */
+
+
+
+
 /*****************************************************************************/
 /** TunnelToTeHashKey
  * \ingroup intTunnel
@@ -1241,6 +1310,83 @@ static fm_uint16 ComputeTunnelHash(fm_tunnelCondition       cond,
 
 
 
+/*****************************************************************************/
+/** SuspendTeWriteBatch
+ * \ingroup intTunnel
+ *
+ * \desc            Issues the TE register writes batched by the calling
+ *                  thread and stops batching them. Must be called before
+ *                  a write sequence whose order matters, such as a TE data
+ *                  block move or the reuse of a freed block.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      suspended is set to TRUE if a batch was suspended and
+ *                  must be resumed with ''ResumeTeWriteBatch''.
+ *
+ * \return          FM_OK if successful
+ *
+ *****************************************************************************/
+static fm_status SuspendTeWriteBatch(fm_int sw, fm_bool *suspended)
+{
+    fm10000_switch *switchExt = GET_SWITCH_EXT(sw);
+    fm_status       err = FM_OK;
+
+    *suspended = FALSE;
+
+    if ( (switchExt->tunnelCfg->writeBatchOwner != NULL) &&
+         (switchExt->tunnelCfg->writeBatchOwner == fmGetCurrentThreadId()) )
+    {
+        switchExt->tunnelCfg->writeBatchOwner = NULL;
+        *suspended = TRUE;
+
+        err = fmRegBatchCommit(sw);
+    }
+
+    return err;
+
+}   /* end SuspendTeWriteBatch */
+
+
+
+
+/*****************************************************************************/
+/** ResumeTeWriteBatch
+ * \ingroup intTunnel
+ *
+ * \desc            Resumes the batching of TE register writes suspended by
+ *                  ''SuspendTeWriteBatch''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       suspended is the value returned by
+ *                  ''SuspendTeWriteBatch''.
+ *
+ * \return          FM_OK if successful
+ *
+ *****************************************************************************/
+static fm_status ResumeTeWriteBatch(fm_int sw, fm_bool suspended)
+{
+    fm10000_switch *switchExt = GET_SWITCH_EXT(sw);
+    fm_status       err = FM_OK;
+
+    if (suspended)
+    {
+        err = fmRegBatchBegin(sw);
+
+        if (err == FM_OK)
+        {
+            switchExt->tunnelCfg->writeBatchOwner = fmGetCurrentThreadId();
+        }
+    }
+
+    return err;
+
+}   /* end ResumeTeWriteBatch */
+
+
+
+
 /*****************************************************************************/
 /** MoveTeDataBlock
  * \ingroup intTunnel
@@ -1289,9 +1435,16 @@ static fm_status MoveTeDataBlock(fm_int     sw,
     fm_fm10000TeData teData[FM10000_TUNNEL_MAX_TE_DATA_BIN_SIZE];
     fm_int teDataPos;
     fm_int teDataOutSet;
+    fm_bool batchSuspended;
+    fm_status resumeErr;
 
     teDataCtrl = &switchExt->tunnelCfg->teDataCtrl[te];
 
+    /* The move waits on the hardware between the data copy and the lookup
+     * update, neither can be batched. */
+    err = SuspendTeWriteBatch(sw, &batchSuspended);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+
     /* Find the owner of the block */
     blockHandler = teDataCtrl->teDataHandler[srcIndex];
     if (blockHandler == 0)
@@ -1539,6 +1692,12 @@ static fm_status MoveTeDataBlock(fm_int     sw,
 
 ABORT:
 
+    resumeErr = ResumeTeWriteBatch(sw, batchSuspended);
+    if (err == FM_OK)
+    {
+        err = resumeErr;
+    }
+
     return err;
 
 }   /* end MoveTeDataBlock */
@@ -1799,6 +1958,7 @@ static fm_status DefragTeData(fm_int     sw,
     fm_uint16  maxBlockSize = FM10000_TUNNEL_TE_DATA_MIN_SWAP_SIZE;
 
     teDataCtrl = &switchExt->tunnelCfg->teDataCtrl[te];
+    teDataCtrl->defragCount++;
 
     firstBlockLength = 0;
     upperBound = (FM10000_TE_DATA_ENTRIES_0 - teDataCtrl->teDataSwapSize);
@@ -1915,45 +2075,437 @@ static fm_status DefragTeData(fm_int     sw,
             lastBlockLength++;
         }
 
-    }
-    /* Cover the last remaining block just before the upper boundary */
-    if (lastBlockLength > maxBlockSize)
+    }
+    /* Cover the last remaining block just before the upper boundary */
+    if (lastBlockLength > maxBlockSize)
+    {
+        maxBlockSize = lastBlockLength;
+    }
+
+    /* Make sure the new block fit into the defrag area */
+    if (size > maxBlockSize)
+    {
+        maxBlockSize = size;
+    }
+
+    /* is the new bigger block smaller than swap size? */
+    if (maxBlockSize < teDataCtrl->teDataSwapSize)
+    {
+        err = UpdateTeDataSwap(sw, te, maxBlockSize);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+    }
+
+    /* the table is now completely defrag, the first free entry refer to
+     * the first entry of the only free block located at the end of the
+     * table. */
+    if (size <= teDataCtrl->teDataFreeEntryCount)
+    {
+        *index = teDataCtrl->teDataHandlerFirstFreeEntry;
+    }
+    else
+    {
+        err = FM_ERR_TUNNEL_FLOW_FULL;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+    }
+
+
+ABORT:
+
+    return err;
+
+}   /* end DefragTeData */
+
+
+
+
+/*****************************************************************************/
+/** ComputeTeDataStats
+ * \ingroup intTunnel
+ *
+ * \desc            Compute the occupancy and fragmentation of the teData
+ *                  table of a TE.
+ *
+ * \param[in]       teDataCtrl points to the teData control of the TE.
+ *
+ * \param[out]      stats points to caller-allocated storage where this
+ *                  function should place the statistics.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void ComputeTeDataStats(fm_fm10000TunnelTeDataCtrl *teDataCtrl,
+                               fm_fm10000TeDataStats *     stats)
+{
+    fm_int    i;
+    fm_int    upperBound;
+    fm_int    freeLength;
+    fm_uint16 lastHandler;
+
+    FM_CLEAR(*stats);
+
+    stats->swapSize         = teDataCtrl->teDataSwapSize;
+    stats->defragCount      = teDataCtrl->defragCount;
+    stats->compactMoveCount = teDataCtrl->compactMoveCount;
+    stats->allocFailCount   = teDataCtrl->allocFailCount;
+    stats->binRewriteCount  = teDataCtrl->binRewriteCount;
+    stats->binFullCount     = teDataCtrl->binFullCount;
+
+    upperBound = FM10000_TE_DATA_ENTRIES_0 - teDataCtrl->teDataSwapSize;
+
+    /* Entry 0 is not usable */
+    if (teDataCtrl->teDataHandler == NULL)
+    {
+        stats->freeEntries       = upperBound - 1;
+        stats->freeExtents       = 1;
+        stats->largestFreeExtent = upperBound - 1;
+        return;
+    }
+
+    freeLength = 0;
+    lastHandler = 0;
+
+    for (i = 1 ; i <= upperBound ; i++)
+    {
+        if ( (i < upperBound) && (teDataCtrl->teDataHandler[i] == 0) )
+        {
+            freeLength++;
+            lastHandler = 0;
+            continue;
+        }
+
+        /* End of a free run */
+        if (freeLength)
+        {
+            stats->freeEntries += freeLength;
+            stats->freeExtents++;
+            if (freeLength > stats->largestFreeExtent)
+            {
+                stats->largestFreeExtent = freeLength;
+            }
+            freeLength = 0;
+        }
+
+        if (i < upperBound)
+        {
+            stats->usedEntries++;
+            if (teDataCtrl->teDataHandler[i] != lastHandler)
+            {
+                stats->usedBlocks++;
+                lastHandler = teDataCtrl->teDataHandler[i];
+            }
+        }
+    }
+
+    if (stats->freeEntries)
+    {
+        stats->fragmentation = 100 - (stats->largestFreeExtent * 100) /
+                                     stats->freeEntries;
+    }
+
+}   /* end ComputeTeDataStats */
+
+
+
+
+/*****************************************************************************/
+/** ComputeTeHashStats
+ * \ingroup intTunnel
+ *
+ * \desc            Compute the hash bin occupancy of the hash lookup groups
+ *                  of a TE.
+ *
+ * \param[in]       tunnelCfg points to the tunnel configuration.
+ *
+ * \param[in]       te is the tunneling engine on which to operate.
+ *
+ * \param[in,out]   stats points to the statistics to complete.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void ComputeTeHashStats(fm_fm10000TunnelCfg *  tunnelCfg,
+                               fm_int                 te,
+                               fm_fm10000TeDataStats *stats)
+{
+    fm_fm10000TunnelGrp *      tunnelGrp;
+    fm_fm10000TunnelLookupBin *lookupBin;
+    fm_treeIterator            itBin;
+    fm_uint64                  binNumber;
+    void *                     value;
+    fm_int                     i;
+
+    for (i = 0 ; i < FM10000_TE_DGLORT_MAP_ENTRIES_0 ; i++)
+    {
+        tunnelGrp = &tunnelCfg->tunnelGrp[te][i];
+
+        if ( !tunnelGrp->active ||
+             (tunnelGrp->teDGlort.lookupType != FM_FM10000_TE_LOOKUP_HASH) )
+        {
+            continue;
+        }
+
+        stats->hashBins += tunnelGrp->teDGlort.lookupData.hashLookup.hashSize;
+        stats->usedHashBins += fmTreeSize(&tunnelGrp->lookupBins);
+        stats->hashRules += fmTreeSize(&tunnelGrp->rules);
+
+        for (fmTreeIterInit(&itBin, &tunnelGrp->lookupBins) ;
+             fmTreeIterNext(&itBin, &binNumber, &value) == FM_OK ; )
+        {
+            lookupBin = (fm_fm10000TunnelLookupBin *) value;
+
+            if (lookupBin->teLookup.dataLength > stats->maxBinLength)
+            {
+                stats->maxBinLength = lookupBin->teLookup.dataLength;
+            }
+        }
+    }
+
+}   /* end ComputeTeHashStats */
+
+
+
+
+/*****************************************************************************/
+/** CompactTeData
+ * \ingroup intTunnel
+ *
+ * \desc            Incrementally compact the teData table of a TE. Each
+ *                  step moves the highest block of the table into the
+ *                  lowest free run that holds it, which never overlaps the
+ *                  block itself. ''MoveTeDataBlock'' copies the block and
+ *                  then repoints its lookup, so traffic keeps using either
+ *                  the old or the new copy.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       te is the tunneling engine on which to operate.
+ *
+ * \param[in]       maxMoves is the maximum number of blocks to move.
+ *
+ * \return          FM_OK if successful
+ *
+ *****************************************************************************/
+static fm_status CompactTeData(fm_int sw, fm_int te, fm_int maxMoves)
+{
+    fm_fm10000TunnelTeDataCtrl *teDataCtrl;
+    fm_fm10000TunnelTeDataBlockCtrl *teDataBlkCtrl;
+    fm_switch *      switchPtr = GET_SWITCH_PTR(sw);
+    fm10000_switch * switchExt = (fm10000_switch *) switchPtr->extension;
+    fm_status  err = FM_OK;
+    fm_int     moves;
+    fm_int     i;
+    fm_int     top;
+    fm_int     upperBound;
+    fm_int     freeLength;
+    fm_int     dstIndex;
+
+    teDataCtrl = &switchExt->tunnelCfg->teDataCtrl[te];
+    upperBound = FM10000_TE_DATA_ENTRIES_0 - teDataCtrl->teDataSwapSize;
+
+    for (moves = 0 ; moves < maxMoves ; moves++)
+    {
+        /* Find the highest used entry */
+        for (top = upperBound - 1 ; top > 0 ; top--)
+        {
+            if (teDataCtrl->teDataHandler[top] != 0)
+            {
+                break;
+            }
+        }
+
+        /* Everything is packed below the first free entry */
+        if (top < teDataCtrl->teDataHandlerFirstFreeEntry)
+        {
+            break;
+        }
+
+        teDataBlkCtrl = teDataCtrl->teDataBlkCtrl[teDataCtrl->teDataHandler[top]];
+
+        /* Find the lowest free run below the block that holds it */
+        dstIndex = -1;
+        freeLength = 0;
+        for (i = teDataCtrl->teDataHandlerFirstFreeEntry ;
+             i < teDataBlkCtrl->index ;
+             i++)
+        {
+            if (teDataCtrl->teDataHandler[i] != 0)
+            {
+                freeLength = 0;
+                continue;
+            }
+
+            freeLength++;
+            if (freeLength == teDataBlkCtrl->length)
+            {
+                dstIndex = i + 1 - freeLength;
+                break;
+            }
+        }
+
+        /* Only an on-demand defrag through the swap area can move it */
+        if (dstIndex < 0)
+        {
+            break;
+        }
+
+        err = MoveTeDataBlock(sw,
+                              te,
+                              teDataBlkCtrl->index,
+                              teDataBlkCtrl->length,
+                              dstIndex);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+
+        teDataCtrl->compactMoveCount++;
+
+        if (dstIndex == teDataCtrl->teDataHandlerFirstFreeEntry)
+        {
+            for (i = dstIndex ; i < FM10000_TE_DATA_ENTRIES_0 ; i++)
+            {
+                if (teDataCtrl->teDataHandler[i] == 0)
+                {
+                    teDataCtrl->teDataHandlerFirstFreeEntry = i;
+                    break;
+                }
+            }
+        }
+    }
+
+
+ABORT:
+
+    return err;
+
+}   /* end CompactTeData */
+
+
+
+
+/*****************************************************************************/
+/** HandleTeDataCompactTimer
+ * \ingroup intTunnel
+ *
+ * \desc            Background compaction timer callback. Compacts the
+ *                  teData table of each TE whose free entries are more
+ *                  fragmented than FM10000_TUNNEL_TE_DATA_COMPACT_THRESHOLD.
+ *
+ * \param[in]       arg is the switch number.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void HandleTeDataCompactTimer(void *arg)
+{
+    fm_fm10000TunnelTeDataCtrl *teDataCtrl;
+    fm_fm10000TeDataStats stats;
+    fm10000_switch * switchExt;
+    fm_status  err;
+    fm_int     sw;
+    fm_int     te;
+
+    sw = (fm_int) (fm_uintptr) arg;
+
+    VALIDATE_AND_PROTECT_SWITCH_NO_RETURN(err, sw);
+    if (err != FM_OK)
+    {
+        return;
+    }
+
+    TAKE_TUNNEL_LOCK(sw);
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    /* Writes batched by another thread may not have reached the teData
+     * table yet, leave it alone until the batch ends. */
+    if ( (switchExt->tunnelCfg == NULL) ||
+         (switchExt->tunnelCfg->writeBatchOwner != NULL) )
+    {
+        goto ABORT;
+    }
+
+    for (te = 0 ; te < FM10000_TE_DGLORT_MAP_ENTRIES_1 ; te++)
+    {
+        teDataCtrl = &switchExt->tunnelCfg->teDataCtrl[te];
+
+        if (teDataCtrl->teDataHandler == NULL)
+        {
+            continue;
+        }
+
+        ComputeTeDataStats(teDataCtrl, &stats);
+
+        if ( (stats.freeExtents < 2) ||
+             (stats.fragmentation < FM10000_TUNNEL_TE_DATA_COMPACT_THRESHOLD) )
+        {
+            continue;
+        }
+
+        err = CompactTeData(sw, te, FM10000_TUNNEL_TE_DATA_COMPACT_MOVES);
+        if (err != FM_OK)
+        {
+            FM_LOG_WARNING(FM_LOG_CAT_TE,
+                           "TE %d teData compaction failed: %s\n",
+                           te,
+                           fmErrorMsg(err));
+        }
+    }
+
+ABORT:
+
+    DROP_TUNNEL_LOCK(sw);
+    UNPROTECT_SWITCH(sw);
+
+}   /* end HandleTeDataCompactTimer */
+
+
+
+
+/*****************************************************************************/
+/** StartTeDataCompaction
+ * \ingroup intTunnel
+ *
+ * \desc            Start the background teData compaction timer of the
+ *                  switch if not already done.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful
+ *
+ *****************************************************************************/
+static fm_status StartTeDataCompaction(fm_int sw)
+{
+    fm10000_switch * switchExt = GET_SWITCH_EXT(sw);
+    fm_status    err;
+    fm_timestamp period;
+    fm_char      timerName[32];
+
+    if (switchExt->tunnelCfg->compactTimer != NULL)
     {
-        maxBlockSize = lastBlockLength;
+        return FM_OK;
     }
 
-    /* Make sure the new block fit into the defrag area */
-    if (size > maxBlockSize)
-    {
-        maxBlockSize = size;
-    }
+    FM_SPRINTF_S(timerName, sizeof(timerName), "teDataCompact%02dTimer", sw);
 
-    /* is the new bigger block smaller than swap size? */
-    if (maxBlockSize < teDataCtrl->teDataSwapSize)
-    {
-        err = UpdateTeDataSwap(sw, te, maxBlockSize);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
-    }
+    err = fmCreateTimer(timerName,
+                        fmApiTimerTask,
+                        &switchExt->tunnelCfg->compactTimer);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
 
-    /* the table is now completely defrag, the first free entry refer to
-     * the first entry of the only free block located at the end of the
-     * table. */
-    if (size <= teDataCtrl->teDataFreeEntryCount)
-    {
-        *index = teDataCtrl->teDataHandlerFirstFreeEntry;
-    }
-    else
-    {
-        err = FM_ERR_TUNNEL_FLOW_FULL;
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
-    }
+    period.sec  = FM10000_TUNNEL_TE_DATA_COMPACT_PERIOD / 1000;
+    period.usec = (FM10000_TUNNEL_TE_DATA_COMPACT_PERIOD % 1000) * 1000;
+
+    err = fmStartTimer(switchExt->tunnelCfg->compactTimer,
+                       &period,
+                       FM_TIMER_REPEAT_FOREVER,
+                       HandleTeDataCompactTimer,
+                       (void *) (fm_uintptr) sw);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
 
 
 ABORT:
 
     return err;
 
-}   /* end DefragTeData */
+}   /* end StartTeDataCompaction */
 
 
 
@@ -1991,6 +2543,12 @@ static fm_status FindTeDataBlock(fm_int     sw,
 
     teDataCtrl = &switchExt->tunnelCfg->teDataCtrl[te];
 
+    err = AllocTeDataTables(teDataCtrl);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+
+    err = StartTeDataCompaction(sw);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+
     /* Always keep some kind of buffer in the table to avoid continuous defrag
      * of the table at every add/remove rule when the usage is pretty high.
      * The current scheme reserve 1% of the table as buffer. This is only for
@@ -2048,6 +2606,11 @@ static fm_status FindTeDataBlock(fm_int     sw,
 
 ABORT:
 
+    if (err == FM_ERR_TUNNEL_FLOW_FULL)
+    {
+        teDataCtrl->allocFailCount++;
+    }
+
     return err;
 
 }   /* end FindTeDataBlock */
@@ -2195,9 +2758,17 @@ static fm_status FreeTeDataBlock(fm_int                            sw,
     fm_uint16  i;
     fm_uint16 tmpTeDataHandler;
     fm_uint16 teDataHandler;
+    fm_bool   batchSuspended;
 
     teDataCtrl = &switchExt->tunnelCfg->teDataCtrl[te];
 
+    /* No block can have been reserved before the tables exist */
+    if (teDataCtrl->teDataHandler == NULL)
+    {
+        err = FM_FAIL;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+    }
+
     /* Validate the block by making sure previous element is different. This is
      * also a sanity check that could be removed for performance enhancement. */
     tmpTeDataHandler = teDataCtrl->teDataHandler[index - 1];
@@ -2244,6 +2815,15 @@ static fm_status FreeTeDataBlock(fm_int                            sw,
 
     teDataCtrl->teDataFreeEntryCount += size;
 
+    /* The freed block may be reused right away. Issue the batched writes
+     * now so that the lookup entries move off the block before any new
+     * data lands in it. */
+    err = SuspendTeWriteBatch(sw, &batchSuspended);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+
+    err = ResumeTeWriteBatch(sw, batchSuspended);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+
 ABORT:
 
     return err;
@@ -2306,6 +2886,11 @@ fm_status fm10000TunnelInit(fm_int sw)
 
     if (switchExt->tunnelCfg != NULL)
     {
+        if (switchExt->tunnelCfg->compactTimer != NULL)
+        {
+            fmDeleteTimer(switchExt->tunnelCfg->compactTimer);
+        }
+
         FreeTunnelCfgStruct(switchExt->tunnelCfg);
         switchExt->tunnelCfg = NULL;
     }
@@ -2632,6 +3217,11 @@ fm_status fm10000TunnelFree(fm_int sw)
 
     if (switchExt->tunnelCfg != NULL)
     {
+        if (switchExt->tunnelCfg->compactTimer != NULL)
+        {
+            fmDeleteTimer(switchExt->tunnelCfg->compactTimer);
+        }
+
         FreeTunnelCfgStruct(switchExt->tunnelCfg);
         switchExt->tunnelCfg = NULL;
     }
@@ -2643,6 +3233,88 @@ fm_status fm10000TunnelFree(fm_int sw)
 
 
 
+/*****************************************************************************/
+/** fm10000TunnelBeginWriteBatch
+ * \ingroup intTunnel
+ *
+ * \desc            Starts batching the TE register writes of the calling
+ *                  thread. The writes are issued by
+ *                  ''fm10000TunnelEndWriteBatch'', and earlier whenever a
+ *                  TE data block is moved or freed, since those sequences
+ *                  depend on the order of the writes.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful
+ * \return          FM_ERR_INVALID_STATE if TE register writes are already
+ *                  being batched.
+ *
+ *****************************************************************************/
+fm_status fm10000TunnelBeginWriteBatch(fm_int sw)
+{
+    fm10000_switch *switchExt = GET_SWITCH_EXT(sw);
+    fm_status       err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_TE, "sw = %d\n", sw);
+
+    TAKE_TUNNEL_LOCK(sw);
+
+    if (switchExt->tunnelCfg->writeBatchOwner != NULL)
+    {
+        err = FM_ERR_INVALID_STATE;
+    }
+    else
+    {
+        err = fmRegBatchBegin(sw);
+
+        if (err == FM_OK)
+        {
+            switchExt->tunnelCfg->writeBatchOwner = fmGetCurrentThreadId();
+        }
+    }
+
+    DROP_TUNNEL_LOCK(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_TE, err);
+
+}   /* end fm10000TunnelBeginWriteBatch */
+
+
+
+
+/*****************************************************************************/
+/** fm10000TunnelEndWriteBatch
+ * \ingroup intTunnel
+ *
+ * \desc            Issues the TE register writes batched since
+ *                  ''fm10000TunnelBeginWriteBatch'' and stops batching them.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful
+ *
+ *****************************************************************************/
+fm_status fm10000TunnelEndWriteBatch(fm_int sw)
+{
+    fm_status err;
+    fm_bool   suspended;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_TE, "sw = %d\n", sw);
+
+    TAKE_TUNNEL_LOCK(sw);
+
+    /* A batch suspended by a failed resume has nothing left to issue. */
+    err = SuspendTeWriteBatch(sw, &suspended);
+
+    DROP_TUNNEL_LOCK(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_TE, err);
+
+}   /* end fm10000TunnelEndWriteBatch */
+
+
+
+
 /*****************************************************************************/
 /** fm10000CreateTunnel
  * \ingroup intTunnel
@@ -4894,6 +5566,11 @@ fm_status fm10000AddTunnelRule(fm_int                   sw,
 
         /* Get the needed length of the whole block */
         err = fm10000GetTeDataBlockLength(teData, teDataPos, &blockLength);
+        if ( (err == FM_OK) &&
+             (blockLength > FM10000_TUNNEL_MAX_TE_LOOKUP_LENGTH) )
+        {
+            err = FM_ERR_TUNNEL_BIN_FULL;
+        }
         if (err != FM_OK)
         {
             fmTreeRemoveCertain(&lookupBin->rules, rule, NULL);
@@ -5005,6 +5682,8 @@ fm_status fm10000AddTunnelRule(fm_int                   sw,
                                   lookupBin->teLookup.dataLength,
                                   &teDataBlkCtrl);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+
+            switchExt->tunnelCfg->teDataCtrl[group >> 3].binRewriteCount++;
         }
         /* Create the control block */
         else
@@ -5341,6 +6020,11 @@ fm_status fm10000AddTunnelRule(fm_int                   sw,
 ABORT:
     if (tunnelLockTaken)
     {
+        if (err == FM_ERR_TUNNEL_BIN_FULL)
+        {
+            switchExt->tunnelCfg->teDataCtrl[group >> 3].binFullCount++;
+        }
+
         DROP_TUNNEL_LOCK(sw);
     }
 
@@ -5595,6 +6279,8 @@ fm_status fm10000DeleteTunnelRule(fm_int sw, fm_int group, fm_int rule)
                                   &teDataBlkCtrl);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
 
+            switchExt->tunnelCfg->teDataCtrl[group >> 3].binRewriteCount++;
+
             lookupBin->teLookup = newTeLookup;
 
             /* Free counter index if one reserved */
@@ -5994,6 +6680,12 @@ fm_status fm10000UpdateTunnelRule(fm_int                   sw,
         err = fm10000GetTeDataBlockLength(teData, teDataPos, &blockLength);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
 
+        if (blockLength > FM10000_TUNNEL_MAX_TE_LOOKUP_LENGTH)
+        {
+            err = FM_ERR_TUNNEL_BIN_FULL;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+        }
+
         /* Find a block large enough */
         err = FindTeDataBlock(sw, group >> 3, blockLength, &baseIndex);
 
@@ -6072,6 +6764,8 @@ fm_status fm10000UpdateTunnelRule(fm_int                   sw,
                                   lookupBin->teLookup.dataLength,
                                   &teDataBlkCtrl);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+
+            switchExt->tunnelCfg->teDataCtrl[group >> 3].binRewriteCount++;
         }
         /* This Updated rule now refer to a new bin */
         else
@@ -6498,6 +7192,11 @@ fm_status fm10000UpdateTunnelRule(fm_int                   sw,
 ABORT:
     if (tunnelLockTaken)
     {
+        if (err == FM_ERR_TUNNEL_BIN_FULL)
+        {
+            switchExt->tunnelCfg->teDataCtrl[group >> 3].binFullCount++;
+        }
+
         DROP_TUNNEL_LOCK(sw);
     }
 
@@ -6926,6 +7625,150 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000GetTunnelRuleCountList
+ * \ingroup intTunnel
+ *
+ * \desc            Retrieve the frame counts associated with the
+ *                  ''FM_TUNNEL_COUNT'' action of a list of tunnel rules.
+ *                  Counters are read in aligned blocks of
+ *                  FM10000_TUNNEL_CNT_BLOCK entries, so rules whose counters
+ *                  were allocated close together cost a single block read.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       group is the group handler.
+ *
+ * \param[in]       numRules is the number of rules in the list.
+ *
+ * \param[in]       rules points to an array of numRules rule ids.
+ *
+ * \param[out]      frameCnt points to an array of numRules elements that
+ *                  receives the frame count of each rule.
+ *
+ * \param[out]      valid points to an array of numRules elements that is set
+ *                  to FALSE for rules that do not exist or do not have a
+ *                  count action, TRUE otherwise.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT on NULL pointer or out of range value.
+ * \return          FM_ERR_TUNNEL_INVALID_ENTRY if group is invalid.
+ *
+ *****************************************************************************/
+fm_status fm10000GetTunnelRuleCountList(fm_int     sw,
+                                        fm_int     group,
+                                        fm_int     numRules,
+                                        fm_int *   rules,
+                                        fm_uint64 *frameCnt,
+                                        fm_bool *  valid)
+{
+    fm_fm10000TunnelGrp *tunnelGrp;
+    fm_switch *     switchPtr = GET_SWITCH_PTR(sw);
+    fm10000_switch * switchExt = (fm10000_switch *) switchPtr->extension;
+    fm_status err = FM_OK;
+    fm_bool tunnelLockTaken = FALSE;
+    void *value;
+    fm_fm10000TunnelRule *tunnelRule;
+    fm_uint64 blockFrames[FM10000_TUNNEL_CNT_BLOCK];
+    fm_uint64 blockBytes[FM10000_TUNNEL_CNT_BLOCK];
+    fm_int blockBase;
+    fm_int blockSize;
+    fm_int i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_TE,
+                 "sw = %d, group = %d, numRules = %d\n",
+                 sw, group, numRules);
+
+    if ( (group >= FM10000_TE_DGLORT_MAP_ENTRIES_0 *
+                   FM10000_TE_DGLORT_MAP_ENTRIES_1) ||
+         (group < 0) )
+    {
+        err = FM_ERR_TUNNEL_INVALID_ENTRY;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+    }
+
+    if ( (numRules < 0) || (rules == NULL) ||
+         (frameCnt == NULL) || (valid == NULL) )
+    {
+       err = FM_ERR_INVALID_ARGUMENT;
+       FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+    }
+
+    TAKE_TUNNEL_LOCK(sw);
+    tunnelLockTaken = TRUE;
+
+    tunnelGrp = &switchExt->tunnelCfg->tunnelGrp[group >> 3][group & 0x7];
+
+    if (tunnelGrp->active == FALSE)
+    {
+        err = FM_ERR_TUNNEL_INVALID_ENTRY;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+    }
+
+    /* No block cached yet */
+    blockBase = -1;
+    blockSize = 0;
+
+    for (i = 0 ; i < numRules ; i++)
+    {
+        valid[i]    = FALSE;
+        frameCnt[i] = 0;
+
+        if (fmTreeFind(&tunnelGrp->rules, rules[i], &value) != FM_OK)
+        {
+            continue;
+        }
+
+        tunnelRule = (fm_fm10000TunnelRule *) value;
+
+        /* No Count Action defined */
+        if (tunnelRule->counter == 0)
+        {
+            continue;
+        }
+
+        if ( (tunnelRule->counter < blockBase) ||
+             (tunnelRule->counter >= blockBase + blockSize) )
+        {
+            blockBase = tunnelRule->counter & ~(FM10000_TUNNEL_CNT_BLOCK - 1);
+            blockSize = FM10000_TE_STATS_ENTRIES_0 - blockBase;
+            if (blockSize > FM10000_TUNNEL_CNT_BLOCK)
+            {
+                blockSize = FM10000_TUNNEL_CNT_BLOCK;
+            }
+
+            err = fm10000GetTeFlowCntRange(sw,
+                                           group >> 3,
+                                           blockBase,
+                                           blockSize,
+                                           blockFrames,
+                                           blockBytes);
+            if (err != FM_OK)
+            {
+                blockBase = -1;
+                blockSize = 0;
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_TE, err);
+            }
+        }
+
+        frameCnt[i] = blockFrames[tunnelRule->counter - blockBase];
+        valid[i]    = TRUE;
+    }
+
+
+ABORT:
+    if (tunnelLockTaken)
+    {
+        DROP_TUNNEL_LOCK(sw);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_TE, err);
+
+}   /* end fm10000GetTunnelRuleCountList */
+
+
+
+
 /*****************************************************************************/
 /** fm10000GetTunnelEncapFlowCount
  * \ingroup intTunnel
@@ -8017,6 +8860,55 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000GetTeDataStats
+ * \ingroup intTunnel
+ *
+ * \desc            Report the occupancy and fragmentation of the teData
+ *                  table of a TE.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       te is the tunneling engine on which to operate.
+ *
+ * \param[out]      stats points to caller-allocated storage where this
+ *                  function should place the statistics.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if te or stats is invalid.
+ *
+ *****************************************************************************/
+fm_status fm10000GetTeDataStats(fm_int                 sw,
+                                fm_int                 te,
+                                fm_fm10000TeDataStats *stats)
+{
+    fm_switch *      switchPtr = GET_SWITCH_PTR(sw);
+    fm10000_switch * switchExt = (fm10000_switch *) switchPtr->extension;
+    fm_status err = FM_OK;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_TE, "sw = %d, te = %d\n", sw, te);
+
+    if ( (te < 0) || (te >= FM10000_TE_DGLORT_MAP_ENTRIES_1) ||
+         (stats == NULL) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_EXIT(FM_LOG_CAT_TE, err);
+    }
+
+    TAKE_TUNNEL_LOCK(sw);
+
+    ComputeTeDataStats(&switchExt->tunnelCfg->teDataCtrl[te], stats);
+    ComputeTeHashStats(switchExt->tunnelCfg, te, stats);
+
+    DROP_TUNNEL_LOCK(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_TE, err);
+
+}   /* end fm10000GetTeDataStats */
+
+
+
+
 /*****************************************************************************/
 /** fm10000DbgDumpTunnel
  * \ingroup intDiagTunnel
@@ -8032,6 +8924,7 @@ fm_status fm10000DbgDumpTunnel(fm_int sw)
 {
     fm_status err = FM_OK;
     fm_fm10000TunnelTeDataCtrl *teDataCtrl;
+    fm_fm10000TeDataStats stats;
     fm_int te;
     fm_switch *      switchPtr = GET_SWITCH_PTR(sw);
     fm10000_switch * switchExt = (fm10000_switch *) switchPtr->extension;
@@ -8058,6 +8951,35 @@ fm_status fm10000DbgDumpTunnel(fm_int sw)
         FM_LOG_PRINT("teDataSwapSize:             %d\n", teDataCtrl->teDataSwapSize);
         FM_LOG_PRINT("lastTeDataBlkCtrlIndex:     %d\n\n", teDataCtrl->lastTeDataBlkCtrlIndex);
 
+        ComputeTeDataStats(teDataCtrl, &stats);
+        ComputeTeHashStats(switchExt->tunnelCfg, te, &stats);
+
+        FM_LOG_PRINT("usedEntries/usedBlocks:     %d/%d\n",
+                     stats.usedEntries, stats.usedBlocks);
+        FM_LOG_PRINT("freeEntries/freeExtents:    %d/%d\n",
+                     stats.freeEntries, stats.freeExtents);
+        FM_LOG_PRINT("largestFreeExtent:          %d\n", stats.largestFreeExtent);
+        FM_LOG_PRINT("fragmentation:              %d%%\n", stats.fragmentation);
+        FM_LOG_PRINT("defrag/compactMoves/allocFail: %" FM_FORMAT_64 "u/%"
+                     FM_FORMAT_64 "u/%" FM_FORMAT_64 "u\n",
+                     stats.defragCount,
+                     stats.compactMoveCount,
+                     stats.allocFailCount);
+        FM_LOG_PRINT("hashRules/usedBins/bins:    %d/%d/%d\n",
+                     stats.hashRules, stats.usedHashBins, stats.hashBins);
+        FM_LOG_PRINT("maxBinLength:               %d (limit %d)\n",
+                     stats.maxBinLength, FM10000_TUNNEL_MAX_TE_LOOKUP_LENGTH);
+        FM_LOG_PRINT("binRewrites/binFull:        %" FM_FORMAT_64 "u/%"
+                     FM_FORMAT_64 "u\n\n",
+                     stats.binRewriteCount,
+                     stats.binFullCount);
+
+        if (teDataCtrl->teDataHandler == NULL)
+        {
+            FM_LOG_PRINT("No teData block allocated yet\n\n");
+            continue;
+        }
+
         start = 0;
         oldLine[0] = 0;
         FM_LOG_PRINT("  TeData     Handler Index Length TunnelGrp TunnelType TunnelEntry\n"
@@ -59,11 +59,16 @@
  * \ingroup intVlan
  *
  * \desc            Sets the VLAN membership and tagging state for a list of
- *                  physical ports.
+ *                  physical ports in a range of VLANs. The new membership
+ *                  and tagging masks of each VLAN are computed in memory
+ *                  first, and the VLAN's table entries are written once,
+ *                  only if the masks changed.
  *
  * \param[in]       sw is the switch on which to operate.
  *
- * \param[in]       vlanID is the VLAN to be updated.
+ * \param[in]       firstVlanID is the first VLAN to be updated.
+ *
+ * \param[in]       lastVlanID is the last VLAN to be updated.
  *
  * \param[in]       numPorts is the number of entries in the port list.
  *
@@ -81,7 +86,8 @@
  *
  *****************************************************************************/
 static fm_status SetPerPortProperties(fm_int    sw,
-                                      fm_uint16 vlanID,
+                                      fm_uint16 firstVlanID,
+                                      fm_uint16 lastVlanID,
                                       fm_int    numPorts,
                                       fm_int *  portList,
                                       fm_bool   state,
@@ -89,38 +95,71 @@ static fm_status SetPerPortProperties(fm_int    sw,
 {
     fm_switch *        switchPtr;
     fm10000_vlanEntry *ventryExt;
+    fm_portmask        member;
+    fm_portmask        tagMask;
+    fm_int             physPortList[FM10000_NUM_PORTS];
     fm_int             index;
-    fm_int             physPort;
+    fm_int             vlanID;
     fm_status          status;
 
     FM_LOG_ENTRY(FM_LOG_CAT_VLAN,
-                 "sw=%d, vlanID=%u, numPorts=%d, portList=%p, state=%d, tag=%d\n",
+                 "sw=%d, firstVlanID=%u, lastVlanID=%u, numPorts=%d, "
+                 "portList=%p, state=%d, tag=%d\n",
                  sw,
-                 vlanID,
+                 firstVlanID,
+                 lastVlanID,
                  numPorts,
                  (void *) portList,
                  state,
                  tag);
 
     switchPtr = GET_SWITCH_PTR(sw);
-    ventryExt = GET_VLAN_EXT(sw, vlanID);
 
-    FM_TAKE_L2_LOCK(sw);
+    if (numPorts > FM10000_NUM_PORTS)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_VLAN, FM_ERR_INVALID_ARGUMENT);
+    }
 
     for (index = 0 ; index < numPorts ; index++)
     {
-        status = fmMapLogicalPortToPhysical(switchPtr, portList[index], &physPort);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+        status = fmMapLogicalPortToPhysical(switchPtr,
+                                            portList[index],
+                                            &physPortList[index]);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VLAN, status);
+    }
 
-        /* Set vlan membership. */
-        FM_PORTMASK_SET_BIT(&ventryExt->member, physPort, state);
+    FM_TAKE_L2_LOCK(sw);
 
-        /* Set vlan tag. */
-        FM_PORTMASK_SET_BIT(&ventryExt->tag, physPort, tag);
-    }
+    status = FM_OK;
 
-    status = fm10000WriteVlanEntryV2(sw, vlanID, -1);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+    for (vlanID = firstVlanID ; vlanID <= lastVlanID ; vlanID++)
+    {
+        ventryExt = GET_VLAN_EXT(sw, vlanID);
+
+        member  = ventryExt->member;
+        tagMask = ventryExt->tag;
+
+        for (index = 0 ; index < numPorts ; index++)
+        {
+            /* Set vlan membership. */
+            FM_PORTMASK_SET_BIT(&member, physPortList[index], state);
+
+            /* Set vlan tag. */
+            FM_PORTMASK_SET_BIT(&tagMask, physPortList[index], tag);
+        }
+
+        if ( (memcmp(&member, &ventryExt->member, sizeof(member)) == 0) &&
+             (memcmp(&tagMask, &ventryExt->tag, sizeof(tagMask)) == 0) )
+        {
+            continue;
+        }
+
+        ventryExt->member = member;
+        ventryExt->tag    = tagMask;
+
+        status = fm10000WriteVlanEntryV2(sw, (fm_uint16) vlanID, -1);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+    }
 
 
 ABORT:
@@ -134,6 +173,114 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** SetVlanRangePortList
+ * \ingroup intVlan
+ *
+ * \desc            Adds a list of ports to, or deletes it from, a range
+ *                  of VLANs. The port list is split into physical and LAG
+ *                  ports once for the whole range.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       firstVlanID is the first VLAN to be updated.
+ *
+ * \param[in]       lastVlanID is the last VLAN to be updated.
+ *
+ * \param[in]       numPorts is the number of ports in the list.
+ *
+ * \param[in]       portList points to an array containing the list of ports.
+ *
+ * \param[in]       state is TRUE to add the ports to the VLANs, FALSE to
+ *                  delete them.
+ *
+ * \param[in]       tag is TRUE if the ports are to transmit tagged frames.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status SetVlanRangePortList(fm_int    sw,
+                                      fm_uint16 firstVlanID,
+                                      fm_uint16 lastVlanID,
+                                      fm_int    numPorts,
+                                      fm_int *  portList,
+                                      fm_bool   state,
+                                      fm_bool   tag)
+{
+    fm_switch * switchPtr;
+    fm_int      physPortList[FM10000_NUM_PORTS];
+    fm_int      lagPortList[FM_MAX_NUM_LAGS];
+    fm_int      numPhysPorts;
+    fm_int      numLagPorts;
+    fm_int      vlanID;
+    fm_status   status;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_VLAN,
+                 "sw=%d, firstVlanID=%u, lastVlanID=%u, numPorts=%d, "
+                 "portList=%p, state=%d, tag=%d\n",
+                 sw,
+                 firstVlanID,
+                 lastVlanID,
+                 numPorts,
+                 (void *) portList,
+                 state,
+                 tag);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    /* Extract the list of physical ports. */
+    status = fmExtractVlanPhysicalPortList(sw,
+                                           numPorts,
+                                           portList,
+                                           &numPhysPorts,
+                                           physPortList,
+                                           FM10000_NUM_PORTS);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+
+    /* Extract the list of LAG ports. */
+    status = fmExtractVlanLagPortList(sw,
+                                      numPorts,
+                                      portList,
+                                      &numLagPorts,
+                                      lagPortList,
+                                      FM_MAX_NUM_LAGS);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+
+    /* If per-LAG management is enabled, set the VLAN membership
+     * and tagging properties for each of the LAG ports. */
+    if (switchPtr->perLagMgmt && numLagPorts != 0)
+    {
+        for (vlanID = firstVlanID ; vlanID <= lastVlanID ; vlanID++)
+        {
+            status = fmSetLagListVlanMembership(sw,
+                                                (fm_uint16) vlanID,
+                                                numLagPorts,
+                                                lagPortList,
+                                                state,
+                                                tag);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+        }
+    }
+
+    status = SetPerPortProperties(sw,
+                                  firstVlanID,
+                                  lastVlanID,
+                                  numPhysPorts,
+                                  physPortList,
+                                  state,
+                                  tag);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_VLAN, status);
+
+}   /* end SetVlanRangePortList */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -1083,11 +1230,6 @@ fm_status fm10000AddVlanPortList(fm_int    sw,
                                 fm_int *  portList,
                                 fm_bool   tag)
 {
-    fm_switch * switchPtr;
-    fm_int      physPortList[FM10000_NUM_PORTS];
-    fm_int      lagPortList[FM_MAX_NUM_LAGS];
-    fm_int      numPhysPorts;
-    fm_int      numLagPorts;
     fm_status   status;
 
     FM_LOG_ENTRY(FM_LOG_CAT_VLAN,
@@ -1098,49 +1240,13 @@ fm_status fm10000AddVlanPortList(fm_int    sw,
                  (void *) portList,
                  tag);
 
-    switchPtr = GET_SWITCH_PTR(sw);
-
-    /* Extract the list of physical ports. */
-    status = fmExtractVlanPhysicalPortList(sw,
-                                           numPorts,
-                                           portList,
-                                           &numPhysPorts,
-                                           physPortList,
-                                           FM10000_NUM_PORTS);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
-
-    /* Extract the list of LAG ports. */
-    status = fmExtractVlanLagPortList(sw,
-                                      numPorts,
-                                      portList,
-                                      &numLagPorts,
-                                      lagPortList,
-                                      FM_MAX_NUM_LAGS);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
-
-    /* If per-LAG management is enabled, set the VLAN membership
-     * and tagging properties for each of the LAG ports. */
-    if (switchPtr->perLagMgmt && numLagPorts != 0)
-    {
-        status = fmSetLagListVlanMembership(sw,
-                                            vlanID,
-                                            numLagPorts,
-                                            lagPortList,
-                                            TRUE,
-                                            tag);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
-    }
-
-    status = SetPerPortProperties(sw,
+    status = SetVlanRangePortList(sw,
                                   vlanID,
-                                  numPhysPorts,
-                                  physPortList,
+                                  vlanID,
+                                  numPorts,
+                                  portList,
                                   TRUE,
                                   tag);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
-
-
-ABORT:
 
     FM_LOG_EXIT(FM_LOG_CAT_VLAN, status);
 
@@ -1174,11 +1280,6 @@ fm_status fm10000DeleteVlanPortList(fm_int    sw,
                                     fm_int    numPorts,
                                     fm_int *  portList)
 {
-    fm_switch * switchPtr;
-    fm_int      physPortList[FM10000_NUM_PORTS];
-    fm_int      lagPortList[FM_MAX_NUM_LAGS];
-    fm_int      numPhysPorts;
-    fm_int      numLagPorts;
     fm_status   status;
 
     FM_LOG_ENTRY(FM_LOG_CAT_VLAN,
@@ -1188,53 +1289,134 @@ fm_status fm10000DeleteVlanPortList(fm_int    sw,
                  numPorts,
                  (void *) portList);
 
-    switchPtr = GET_SWITCH_PTR(sw);
+    status = SetVlanRangePortList(sw,
+                                  vlanID,
+                                  vlanID,
+                                  numPorts,
+                                  portList,
+                                  FALSE,
+                                  FALSE);
 
-    /* Extract the list of physical ports. */
-    status = fmExtractVlanPhysicalPortList(sw,
-                                           numPorts,
-                                           portList,
-                                           &numPhysPorts,
-                                           physPortList,
-                                           FM10000_NUM_PORTS);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+    FM_LOG_EXIT(FM_LOG_CAT_VLAN, status);
 
-    /* Extract the list of LAG ports. */
-    status = fmExtractVlanLagPortList(sw,
-                                      numPorts,
-                                      portList,
-                                      &numLagPorts,
-                                      lagPortList,
-                                      FM_MAX_NUM_LAGS);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+}   /* end fm10000DeleteVlanPortList */
 
-    /* If per-LAG management is enabled, set the VLAN membership
-     * and tagging properties for each of the LAG ports. */
-    if (switchPtr->perLagMgmt && numLagPorts != 0)
-    {
-        status = fmSetLagListVlanMembership(sw,
-                                            vlanID,
-                                            numLagPorts,
-                                            lagPortList,
-                                            FALSE,
-                                            FALSE);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
-    }
 
-    status = SetPerPortProperties(sw,
-                                  vlanID,
-                                  numPhysPorts,
-                                  physPortList,
-                                  FALSE,
-                                  FALSE);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
 
 
-ABORT:
+/*****************************************************************************/
+/** fm10000AddVlanRangePortList
+ * \ingroup intVlan
+ *
+ * \desc            Adds a list of ports to a range of VLANs.
+ *                  Called through the AddVlanRangePortList function pointer.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       firstVlanID is the first VLAN to which the ports should
+ *                  be added.
+ *
+ * \param[in]       lastVlanID is the last VLAN to which the ports should
+ *                  be added.
+ *
+ * \param[in]       numPorts is the number of ports in the list.
+ *
+ * \param[in]       portList points to an array containing the list of ports
+ *                  to be added to the VLANs.
+ *
+ * \param[in]       tag should be:
+ *                      - TRUE to tag egressing frames on port.
+ *                      - FALSE to not tag egressing frames on port.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000AddVlanRangePortList(fm_int    sw,
+                                      fm_uint16 firstVlanID,
+                                      fm_uint16 lastVlanID,
+                                      fm_int    numPorts,
+                                      fm_int *  portList,
+                                      fm_bool   tag)
+{
+    fm_status   status;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_VLAN,
+                 "sw=%d, firstVlanID=%u, lastVlanID=%u, numPorts=%d, "
+                 "portList=%p, tag=%d\n",
+                 sw,
+                 firstVlanID,
+                 lastVlanID,
+                 numPorts,
+                 (void *) portList,
+                 tag);
+
+    status = SetVlanRangePortList(sw,
+                                  firstVlanID,
+                                  lastVlanID,
+                                  numPorts,
+                                  portList,
+                                  TRUE,
+                                  tag);
 
     FM_LOG_EXIT(FM_LOG_CAT_VLAN, status);
 
-}   /* end fm10000DeleteVlanPortList */
+}   /* end fm10000AddVlanRangePortList */
+
+
+
+
+/*****************************************************************************/
+/** fm10000DeleteVlanRangePortList
+ * \ingroup intVlan
+ *
+ * \desc            Deletes a list of ports from a range of VLANs.
+ *                  Called through the DeleteVlanRangePortList function
+ *                  pointer.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       firstVlanID is the first VLAN from which the ports
+ *                  should be deleted.
+ *
+ * \param[in]       lastVlanID is the last VLAN from which the ports
+ *                  should be deleted.
+ *
+ * \param[in]       numPorts is the number of ports in the list.
+ *
+ * \param[in]       portList points to an array containing the list of ports
+ *                  to be removed from the VLANs.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000DeleteVlanRangePortList(fm_int    sw,
+                                         fm_uint16 firstVlanID,
+                                         fm_uint16 lastVlanID,
+                                         fm_int    numPorts,
+                                         fm_int *  portList)
+{
+    fm_status   status;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_VLAN,
+                 "sw=%d, firstVlanID=%u, lastVlanID=%u, numPorts=%d, "
+                 "portList=%p\n",
+                 sw,
+                 firstVlanID,
+                 lastVlanID,
+                 numPorts,
+                 (void *) portList);
+
+    status = SetVlanRangePortList(sw,
+                                  firstVlanID,
+                                  lastVlanID,
+                                  numPorts,
+                                  portList,
+                                  FALSE,
+                                  FALSE);
+
+    FM_LOG_EXIT(FM_LOG_CAT_VLAN, status);
+
+}   /* end fm10000DeleteVlanRangePortList */
 
 
 
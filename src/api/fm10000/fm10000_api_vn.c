@@ -2813,6 +2813,134 @@ static fm_status DeleteDecapTunnelRule(fm_int                   sw,
 
 
 
+/*****************************************************************************/
+/** CompileVNAcl
+ * \ingroup intVN
+ *
+ * \desc            Compiles and applies a virtual networking ACL after its
+ *                  rules changed. While a VN batch is open, the ACL is only
+ *                  marked as pending and is compiled by
+ *                  ''fm10000CommitVNBatch''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       acl is the ACL number, either the encapsulation or the
+ *                  decapsulation ACL.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status CompileVNAcl(fm_int sw, fm_int acl)
+{
+    fm_status       status;
+    fm10000_switch *switchExt;
+    fm_char         statusText[STATUS_TEXT_LEN];
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    if (switchExt->vnBatchOpen)
+    {
+        if (acl == switchExt->vnEncapAcl)
+        {
+            switchExt->vnEncapAclPending = TRUE;
+        }
+        else
+        {
+            switchExt->vnDecapAclPending = TRUE;
+        }
+
+        return FM_OK;
+    }
+
+    status = fmCompileACLExt(sw,
+                             statusText,
+                             sizeof(statusText),
+                             FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE
+                             | FM_ACL_COMPILE_FLAG_INTERNAL,
+                             &acl);
+    FM_LOG_DEBUG(FM_LOG_CAT_VN,
+                 "ACL compiled, status=%d, statusText=%s\n",
+                 status,
+                 statusText);
+
+    if (status == FM_OK)
+    {
+        status = fmApplyACLExt(sw,
+                               FM_ACL_APPLY_FLAG_NON_DISRUPTIVE
+                               | FM_ACL_APPLY_FLAG_INTERNAL,
+                               &acl);
+    }
+
+    return status;
+
+}   /* end CompileVNAcl */
+
+
+
+
+/*****************************************************************************/
+/** UpdateVNAclRule
+ * \ingroup intVN
+ *
+ * \desc            Updates a rule of a virtual networking ACL in place.
+ *                  While a VN batch is open the rule may not have been
+ *                  compiled yet, so it is replaced in the ACL instead and
+ *                  the ACL is left for ''fm10000CommitVNBatch'' to compile.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       acl is the ACL number.
+ *
+ * \param[in]       rule is the rule number.
+ *
+ * \param[in]       cond is the rule condition.
+ *
+ * \param[in]       value points to the rule condition values.
+ *
+ * \param[in]       action is the rule action.
+ *
+ * \param[in]       param points to the rule action parameters.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status UpdateVNAclRule(fm_int           sw,
+                                 fm_int           acl,
+                                 fm_int           rule,
+                                 fm_aclCondition  cond,
+                                 fm_aclValue *    value,
+                                 fm_aclActionExt  action,
+                                 fm_aclParamExt * param)
+{
+    fm_status       status;
+    fm10000_switch *switchExt;
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    if (!switchExt->vnBatchOpen)
+    {
+        return fmUpdateACLRule(sw, acl, rule, cond, value, action, param);
+    }
+
+    status = fmDeleteACLRule(sw, acl, rule);
+
+    if (status == FM_OK)
+    {
+        status = fmAddACLRuleExt(sw, acl, rule, cond, value, action, param);
+    }
+
+    if (status == FM_OK)
+    {
+        status = CompileVNAcl(sw, acl);
+    }
+
+    return status;
+
+}   /* end UpdateVNAclRule */
+
+
+
+
 /*****************************************************************************/
 /** WriteEncapAclRule
  * \ingroup intVN
@@ -2838,7 +2966,6 @@ static fm_status WriteEncapAclRule(fm_int                   sw,
     fm_aclParamExt     aclParam;
     fm_bool            encapAclRuleAdded;
     fm_vnAddressType   addrType;
-    fm_char            statusText[STATUS_TEXT_LEN];
 
     FM_LOG_ENTRY(FM_LOG_CAT_VN,
                  "sw = %d, addrRec = %p\n",
@@ -2933,27 +3060,12 @@ static fm_status WriteEncapAclRule(fm_int                   sw,
 
         encapAclRuleAdded = TRUE;
 
-        status = fmCompileACLExt(sw,
-                                 statusText,
-                                 sizeof(statusText),
-                                 FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE
-                                 | FM_ACL_COMPILE_FLAG_INTERNAL,
-                                 &switchExt->vnEncapAcl);
-        FM_LOG_DEBUG(FM_LOG_CAT_VN,
-                     "ACL compiled, status=%d, statusText=%s\n",
-                     status,
-                     statusText);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
-
-        status = fmApplyACLExt(sw,
-                               FM_ACL_APPLY_FLAG_NON_DISRUPTIVE
-                               | FM_ACL_APPLY_FLAG_INTERNAL,
-                               &switchExt->vnEncapAcl);
+        status = CompileVNAcl(sw, switchExt->vnEncapAcl);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
     }
     else
     {
-        status = fmUpdateACLRule(sw,
+        status = UpdateVNAclRule(sw,
                                  switchExt->vnEncapAcl,
                                  addrRec->encapAclRule,
                                  aclCond,
@@ -3008,7 +3120,6 @@ static fm_status DeleteEncapAclRule(fm_int                   sw,
 {
     fm_status          status;
     fm10000_switch *   switchExt;
-    fm_char            statusText[STATUS_TEXT_LEN];
 
     FM_LOG_ENTRY(FM_LOG_CAT_VN,
                  "sw = %d, addrRec = %p\n",
@@ -3025,22 +3136,7 @@ static fm_status DeleteEncapAclRule(fm_int                   sw,
                                  addrRec->encapAclRule);
         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
 
-        status = fmCompileACLExt(sw,
-                                 statusText,
-                                 sizeof(statusText),
-                                 FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE
-                                 | FM_ACL_COMPILE_FLAG_INTERNAL,
-                                 &switchExt->vnEncapAcl);
-        FM_LOG_DEBUG(FM_LOG_CAT_VN,
-                     "ACL compiled, status=%d, statusText=%s\n",
-                     status,
-                     statusText);
-        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
-
-        status = fmApplyACLExt(sw,
-                               FM_ACL_APPLY_FLAG_NON_DISRUPTIVE
-                               | FM_ACL_APPLY_FLAG_INTERNAL,
-                               &switchExt->vnEncapAcl);
+        status = CompileVNAcl(sw, switchExt->vnEncapAcl);
         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
 
         status = FreeTunnelAclRuleNum(sw,
@@ -3097,7 +3193,7 @@ static fm_status WriteDecapAclRule(fm_int                  sw,
                                &aclParam);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
 
-    status = fmUpdateACLRule(sw,
+    status = UpdateVNAclRule(sw,
                              switchExt->vnDecapAcl,
                              decapAclRule->aclRule,
                              aclCond,
@@ -3151,7 +3247,6 @@ static fm_status CreateDecapAclRule(fm_int                   sw,
     fm_bool                 decapAclRuleAdded;
     fm_bool                 decapAclRuleAllocated;
     fm_bool                 decapAclRuleInserted;
-    fm_char                 statusText[STATUS_TEXT_LEN];
 
     FM_LOG_ENTRY(FM_LOG_CAT_VN,
                  "sw = %d, vn = %p, tunnel = %p, decapTunnelGroup = %d, "
@@ -3230,22 +3325,7 @@ static fm_status CreateDecapAclRule(fm_int                   sw,
 
         decapAclRuleAdded = TRUE;
 
-        status = fmCompileACLExt(sw,
-                                 statusText,
-                                 sizeof(statusText),
-                                 FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE
-                                 | FM_ACL_COMPILE_FLAG_INTERNAL,
-                                 &switchExt->vnDecapAcl);
-        FM_LOG_DEBUG(FM_LOG_CAT_VN,
-                     "ACL compiled, status=%d, statusText=%s\n",
-                     status,
-                     statusText);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
-
-        status = fmApplyACLExt(sw,
-                               FM_ACL_APPLY_FLAG_NON_DISRUPTIVE
-                               | FM_ACL_APPLY_FLAG_INTERNAL,
-                               &switchExt->vnDecapAcl);
+        status = CompileVNAcl(sw, switchExt->vnDecapAcl);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
     }
     else
@@ -3326,7 +3406,6 @@ static fm_status WriteEncapFloodsetAclRule(fm_int             sw,
     fm_aclActionExt         aclAction;
     fm_aclParamExt          aclParam;
     fm_bool                 encapAclRuleAdded;
-    fm_char                 statusText[STATUS_TEXT_LEN];
     fm_intMulticastGroup *  mcastGroup;
 
     FM_LOG_ENTRY(FM_LOG_CAT_VN,
@@ -3380,22 +3459,7 @@ static fm_status WriteEncapFloodsetAclRule(fm_int             sw,
 
     encapAclRuleAdded = TRUE;
 
-    status = fmCompileACLExt(sw,
-                             statusText,
-                             sizeof(statusText),
-                             FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE
-                             | FM_ACL_COMPILE_FLAG_INTERNAL,
-                             &switchExt->vnEncapAcl);
-    FM_LOG_DEBUG(FM_LOG_CAT_VN,
-                 "ACL compiled, status=%d, statusText=%s\n",
-                 status,
-                 statusText);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
-
-    status = fmApplyACLExt(sw,
-                           FM_ACL_APPLY_FLAG_NON_DISRUPTIVE
-                           | FM_ACL_APPLY_FLAG_INTERNAL,
-                           &switchExt->vnEncapAcl);
+    status = CompileVNAcl(sw, switchExt->vnEncapAcl);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
 
 ABORT:
@@ -3444,7 +3508,6 @@ static fm_status DeleteEncapFloodsetAclRule(fm_int             sw,
     fm_status               status;
     fm10000_virtualNetwork *vnExt;
     fm10000_switch *        switchExt;
-    fm_char                 statusText[STATUS_TEXT_LEN];
 
     FM_LOG_ENTRY(FM_LOG_CAT_VN,
                  "sw = %d, vn = %p\n",
@@ -3462,22 +3525,7 @@ static fm_status DeleteEncapFloodsetAclRule(fm_int             sw,
                                  vnExt->floodsetEncapAclRule);
         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
 
-        status = fmCompileACLExt(sw,
-                                 statusText,
-                                 sizeof(statusText),
-                                 FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE
-                                 | FM_ACL_COMPILE_FLAG_INTERNAL,
-                                 &switchExt->vnEncapAcl);
-        FM_LOG_DEBUG(FM_LOG_CAT_VN,
-                     "ACL compiled, status=%d, statusText=%s\n",
-                     status,
-                     statusText);
-        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
-
-        status = fmApplyACLExt(sw,
-                               FM_ACL_APPLY_FLAG_NON_DISRUPTIVE
-                               | FM_ACL_APPLY_FLAG_INTERNAL,
-                               &switchExt->vnEncapAcl);
+        status = CompileVNAcl(sw, switchExt->vnEncapAcl);
         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
 
         status = FreeTunnelAclRuleNum(sw,
@@ -3582,7 +3630,6 @@ static fm_status DeleteDecapAclRule(fm_int                  sw,
 {
     fm_status       status;
     fm10000_switch *switchExt;
-    fm_char         statusText[STATUS_TEXT_LEN];
 
     FM_LOG_ENTRY(FM_LOG_CAT_VN,
                  "sw = %d, decapAclRule = %p\n",
@@ -3601,22 +3648,7 @@ static fm_status DeleteDecapAclRule(fm_int                  sw,
                              decapAclRule->aclRule);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
 
-    status = fmCompileACLExt(sw,
-                             statusText,
-                             sizeof(statusText),
-                             FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE
-                             | FM_ACL_COMPILE_FLAG_INTERNAL,
-                             &switchExt->vnDecapAcl);
-    FM_LOG_DEBUG(FM_LOG_CAT_VN,
-                 "ACL compiled, status=%d, statusText=%s\n",
-                 status,
-                 statusText);
-    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
-
-    status = fmApplyACLExt(sw,
-                           FM_ACL_APPLY_FLAG_NON_DISRUPTIVE
-                           | FM_ACL_APPLY_FLAG_INTERNAL,
-                           &switchExt->vnDecapAcl);
+    status = CompileVNAcl(sw, switchExt->vnDecapAcl);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
 
     status = FreeTunnelAclRuleNum(sw,
@@ -5104,7 +5136,6 @@ fm_status fm10000AddVNRemoteAddressMask(fm_int             sw,
     fm_aclParamExt               aclParam;
     fm_bool                      aclRuleAdded;
     fm_bool                      addedToTree;
-    fm_char                      statusText[STATUS_TEXT_LEN];
     fm10000_vnDecapAclRule *     decapAclRule;
     fm_int                       encapFlowType;
     fm10000_vnEncapTep *         tepRule;
@@ -5515,22 +5546,7 @@ fm_status fm10000AddVNRemoteAddressMask(fm_int             sw,
 
     aclRuleAdded = TRUE;
 
-    status = fmCompileACLExt(sw,
-                             statusText,
-                             sizeof(statusText),
-                             FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE
-                             | FM_ACL_COMPILE_FLAG_INTERNAL,
-                             &switchExt->vnEncapAcl);
-    FM_LOG_DEBUG(FM_LOG_CAT_VN,
-                 "ACL compiled, status=%d, statusText=%s\n",
-                 status,
-                 statusText);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
-
-    status = fmApplyACLExt(sw,
-                           FM_ACL_APPLY_FLAG_NON_DISRUPTIVE
-                           | FM_ACL_APPLY_FLAG_INTERNAL,
-                           &switchExt->vnEncapAcl);
+    status = CompileVNAcl(sw, switchExt->vnEncapAcl);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
 
     /* Remove affected remote address encap ACL rules. */
@@ -5597,16 +5613,7 @@ ABORT:
         if (aclRuleAdded)
         {
             fmDeleteACLRule(sw, switchExt->vnEncapAcl, aclRule);
-            fmCompileACLExt(sw,
-                            statusText,
-                            sizeof(statusText),
-                            FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE
-                            | FM_ACL_COMPILE_FLAG_INTERNAL,
-                            &switchExt->vnEncapAcl);
-            fmApplyACLExt(sw,
-                          FM_ACL_APPLY_FLAG_NON_DISRUPTIVE
-                          | FM_ACL_APPLY_FLAG_INTERNAL,
-                          &switchExt->vnEncapAcl);
+            CompileVNAcl(sw, switchExt->vnEncapAcl);
         }
 
         if (addressMask->encapAclRule >= 0)
@@ -5687,7 +5694,6 @@ fm_status fm10000DeleteVNRemoteAddressMask(fm_int             sw,
     fm_vnAddressType             addrType;
     fm_int                       encapTunnelGroup;
     fm_customTreeIterator        iter;
-    fm_char                      statusText[STATUS_TEXT_LEN];
     fm10000_vnDecapAclRule *     decapAclRule;
     fm_int                       encapFlowType;
     fm10000_vnRemoteAddress **   remAddrList;
@@ -5875,22 +5881,7 @@ fm_status fm10000DeleteVNRemoteAddressMask(fm_int             sw,
                                  addressMask->encapAclRule);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
 
-        status = fmCompileACLExt(sw,
-                                 statusText,
-                                 sizeof(statusText),
-                                 FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE
-                                 | FM_ACL_COMPILE_FLAG_INTERNAL,
-                                 &switchExt->vnEncapAcl);
-        FM_LOG_DEBUG(FM_LOG_CAT_VN,
-                     "ACL compiled, status=%d, statusText=%s\n",
-                     status,
-                     statusText);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
-
-        status = fmApplyACLExt(sw,
-                               FM_ACL_APPLY_FLAG_NON_DISRUPTIVE
-                               | FM_ACL_APPLY_FLAG_INTERNAL,
-                               &switchExt->vnEncapAcl);
+        status = CompileVNAcl(sw, switchExt->vnEncapAcl);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
 
         status = FreeTunnelAclRuleNum(sw,
@@ -7946,6 +7937,101 @@ fm_status fm10000FreeVNTunnel(fm_int sw, fm_vnTunnel *tunnel)
 
 
 
+/*****************************************************************************/
+/** fm10000BeginVNBatch
+ * \ingroup intVN
+ *
+ * \desc            Opens a VN provisioning batch, see ''fmVNBatchBegin''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_STATE if a batch is already open.
+ *
+ *****************************************************************************/
+fm_status fm10000BeginVNBatch(fm_int sw)
+{
+    fm10000_switch *switchExt;
+    fm_status       status;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_VN, "sw = %d\n", sw);
+
+    switchExt = GET_SWITCH_EXT(sw);
+    status    = FM_OK;
+
+    if (switchExt->vnBatchOpen)
+    {
+        status = FM_ERR_INVALID_STATE;
+        FM_LOG_EXIT(FM_LOG_CAT_VN, status);
+    }
+
+    switchExt->vnBatchOpen       = TRUE;
+    switchExt->vnEncapAclPending = FALSE;
+    switchExt->vnDecapAclPending = FALSE;
+
+    FM_LOG_EXIT(FM_LOG_CAT_VN, status);
+
+}   /* end fm10000BeginVNBatch */
+
+
+
+
+/*****************************************************************************/
+/** fm10000CommitVNBatch
+ * \ingroup intVN
+ *
+ * \desc            Closes the VN provisioning batch and compiles and applies
+ *                  the VN ACLs changed since ''fm10000BeginVNBatch''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_STATE if no batch is open.
+ *
+ *****************************************************************************/
+fm_status fm10000CommitVNBatch(fm_int sw)
+{
+    fm10000_switch *switchExt;
+    fm_status       status;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_VN, "sw = %d\n", sw);
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    if (!switchExt->vnBatchOpen)
+    {
+        status = FM_ERR_INVALID_STATE;
+        FM_LOG_EXIT(FM_LOG_CAT_VN, status);
+    }
+
+    /* The batch is closed even if a compilation fails: the rules stay in
+     * the ACLs and are compiled again by the next VN update. */
+    switchExt->vnBatchOpen = FALSE;
+    status                 = FM_OK;
+
+    if (switchExt->vnEncapAclPending)
+    {
+        status = CompileVNAcl(sw, switchExt->vnEncapAcl);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
+
+        switchExt->vnEncapAclPending = FALSE;
+    }
+
+    if (switchExt->vnDecapAclPending)
+    {
+        status = CompileVNAcl(sw, switchExt->vnDecapAcl);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
+
+        switchExt->vnDecapAclPending = FALSE;
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_VN, status);
+
+}   /* end fm10000CommitVNBatch */
+
+
+
+
 /*****************************************************************************/
 /** fm10000FreeVNResources
  * \ingroup intVN
@@ -7968,6 +8054,8 @@ fm_status fm10000FreeVNResources(fm_int sw)
 
     switchExt = GET_SWITCH_EXT(sw);
 
+    switchExt->vnBatchOpen = FALSE;
+
     /* Delete per-tunnel-group bit arrays. */
     for (i = 0 ; i < FM_VN_NUM_TUNNEL_GROUPS ; i++)
     {
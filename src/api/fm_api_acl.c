@@ -251,7 +251,7 @@ static void VoidFreeAcl(void *ptr)
  *****************************************************************************/
 static fm_acl *AllocateAcl(fm_int maxPorts)
 {
-    fm_acl *aclEntry = (fm_acl *) fmAlloc( sizeof(fm_acl) );
+    fm_acl *aclEntry = (fm_acl *) fmAllocTagged( sizeof(fm_acl), FM_LOG_CAT_ACL );
 
     if (aclEntry != NULL)
     {
@@ -275,6 +275,105 @@ static fm_acl *AllocateAcl(fm_int maxPorts)
 
 
 
+/*****************************************************************************/
+/** ReadAclRulePage
+ * \ingroup intAcl
+ *
+ * \desc            Copies the next page of an ACL rule walk. The cursor's
+ *                  tree iterator is reused as long as neither the ACL table
+ *                  nor the ACL's rule table has changed; otherwise the walk
+ *                  is repositioned after the last rule returned.
+ *
+ * \note            The caller must hold the ACL lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       aclEntry points to the ACL being walked.
+ *
+ * \param[in,out]   cursor points to the position of the walk.
+ *
+ * \param[out]      numRules receives the number of rules copied.
+ *
+ * \param[out]      rules points to the array to be filled in.
+ *
+ * \param[in]       maxRules is the size of rules.
+ *
+ * \return          FM_OK if at least one rule was copied.
+ * \return          FM_ERR_NO_MORE if the walk is complete.
+ *
+ *****************************************************************************/
+static fm_status ReadAclRulePage(fm_int           sw,
+                                 fm_acl *         aclEntry,
+                                 fm_aclCursor *   cursor,
+                                 fm_int *         numRules,
+                                 fm_aclRuleEntry *rules,
+                                 fm_int           maxRules)
+{
+    fm_status   err;
+    fm_uint     aclsGeneration;
+    fm_uint     rulesGeneration;
+    fm_uint64   nextKey;
+    void *      nextValue;
+    fm_aclRule *aclRule;
+    fm_int      count;
+
+    aclsGeneration  = fmTreeGeneration(&GET_SWITCH_PTR(sw)->aclInfo.acls);
+    rulesGeneration = fmTreeGeneration(&aclEntry->rules);
+
+    if (!cursor->started)
+    {
+        fmTreeIterInit(&cursor->iter, &aclEntry->rules);
+    }
+    else if ( (aclsGeneration != cursor->aclsGeneration) ||
+              (rulesGeneration != cursor->rulesGeneration) )
+    {
+        fmTreeIterInitAfterKey(&cursor->iter,
+                               &aclEntry->rules,
+                               (fm_uint64) cursor->lastRule);
+        cursor->tableChanged = TRUE;
+    }
+
+    cursor->aclsGeneration  = aclsGeneration;
+    cursor->rulesGeneration = rulesGeneration;
+
+    err   = FM_OK;
+    count = 0;
+
+    while (count < maxRules)
+    {
+        err = fmTreeIterNext(&cursor->iter, &nextKey, &nextValue);
+        if (err != FM_OK)
+        {
+            break;
+        }
+
+        aclRule = (fm_aclRule *) nextValue;
+
+        rules[count].rule   = (fm_int) nextKey;
+        rules[count].cond   = aclRule->cond;
+        rules[count].value  = aclRule->value;
+        rules[count].action = aclRule->action;
+        rules[count].param  = aclRule->param;
+        rules[count].state  = aclRule->state;
+        count++;
+    }
+
+    if (count > 0)
+    {
+        cursor->lastRule = rules[count - 1].rule;
+        cursor->started  = TRUE;
+        err              = FM_OK;
+    }
+
+    *numRules = count;
+
+    return err;
+
+}   /* end ReadAclRulePage */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -748,6 +847,11 @@ fm_status fmSetACLAttribute(fm_int sw, fm_int acl, fm_int attr, void *value)
         err = FM_ERR_INVALID_ARGUMENT;
     }
 
+    if (err == FM_OK)
+    {
+        switchPtr->aclInfo.layoutChanged = TRUE;
+    }
+
 ABORT:
     FM_DROP_ACL_LOCK(sw);
     UNPROTECT_SWITCH(sw);
@@ -1180,7 +1284,7 @@ fm_status fmAddACLRuleExt(fm_int                sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
     }
 
-    aclRule = (fm_aclRule *) fmAlloc( sizeof(fm_aclRule) );
+    aclRule = (fm_aclRule *) fmAllocTagged( sizeof(fm_aclRule), FM_LOG_CAT_ACL );
 
     if (aclRule == NULL)
     {
@@ -2348,6 +2452,168 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fmGetACLRuleTableFirst
+ * \ingroup acl
+ *
+ * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
+ *
+ * \desc            Begins a paged walk of the rules of an ACL, in rule
+ *                  number order, and retrieves its first page. Use
+ *                  ''fmGetACLRuleTableNext'' to retrieve the following
+ *                  pages.
+ *                                                                      \lb\lb
+ *                  Unlike ''fmGetACLRuleNextExt'', which searches for the
+ *                  current rule again on every call, the cursor keeps the
+ *                  walk's position, so reading a whole ACL takes time
+ *                  proportional to its size, with one lock acquisition
+ *                  per page. The ACL lock is not held between pages.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       acl is the ACL number.
+ *
+ * \param[out]      cursor points to caller-allocated storage where this
+ *                  function is to store the position of the walk.
+ *
+ * \param[out]      numRules points to caller-allocated storage where this
+ *                  function is to store the number of rules retrieved.
+ *
+ * \param[out]      rules points to an array of ''fm_aclRuleEntry''
+ *                  structures that will be filled in by this function.
+ *
+ * \param[in]       maxRules is the size of rules, being the maximum number
+ *                  of rules in a page.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MORE if acl has no rules.
+ * \return          FM_ERR_INVALID_ACL if acl does not exist.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_ACL_DISABLED if the ACL subsystem is disabled.
+ *
+ *****************************************************************************/
+fm_status fmGetACLRuleTableFirst(fm_int           sw,
+                                 fm_int           acl,
+                                 fm_aclCursor *   cursor,
+                                 fm_int *         numRules,
+                                 fm_aclRuleEntry *rules,
+                                 fm_int           maxRules)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ACL,
+                     "sw = %d, acl = %d, cursor = %p, numRules = %p, "
+                     "rules = %p, maxRules = %d\n",
+                     sw,
+                     acl,
+                     (void *) cursor,
+                     (void *) numRules,
+                     (void *) rules,
+                     maxRules);
+
+    if (cursor == NULL)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_ACL, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    FM_CLEAR(*cursor);
+    cursor->acl = acl;
+
+    err = fmGetACLRuleTableNext(sw, cursor, numRules, rules, maxRules);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ACL, err);
+
+}   /* end fmGetACLRuleTableFirst */
+
+
+
+
+/*****************************************************************************/
+/** fmGetACLRuleTableNext
+ * \ingroup acl
+ *
+ * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
+ *
+ * \desc            Retrieves the next page of a paged walk of the rules of
+ *                  an ACL begun by ''fmGetACLRuleTableFirst''.
+ *                                                                      \lb\lb
+ *                  If rules or ACLs are added or deleted between pages,
+ *                  the walk resumes after the last rule returned and the
+ *                  tableChanged field of the cursor is set.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   cursor points to the position of the walk, as returned
+ *                  by the previous call.
+ *
+ * \param[out]      numRules points to caller-allocated storage where this
+ *                  function is to store the number of rules retrieved.
+ *
+ * \param[out]      rules points to an array of ''fm_aclRuleEntry''
+ *                  structures that will be filled in by this function.
+ *
+ * \param[in]       maxRules is the size of rules, being the maximum number
+ *                  of rules in a page.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MORE if the walk is complete.
+ * \return          FM_ERR_INVALID_ACL if the ACL no longer exists.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_ACL_DISABLED if the ACL subsystem is disabled.
+ *
+ *****************************************************************************/
+fm_status fmGetACLRuleTableNext(fm_int           sw,
+                                fm_aclCursor *   cursor,
+                                fm_int *         numRules,
+                                fm_aclRuleEntry *rules,
+                                fm_int           maxRules)
+{
+    fm_acl *  aclEntry;
+    fm_status err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ACL,
+                     "sw = %d, cursor = %p, numRules = %p, rules = %p, "
+                     "maxRules = %d\n",
+                     sw,
+                     (void *) cursor,
+                     (void *) numRules,
+                     (void *) rules,
+                     maxRules);
+
+    if ( (cursor == NULL) || (numRules == NULL) || (rules == NULL) ||
+         (maxRules <= 0) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_ACL, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    *numRules = 0;
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+    VALIDATE_ACL_ID(sw, cursor->acl);
+    FM_TAKE_ACL_LOCK(sw);
+
+    GET_ACL_ENTRY(sw, aclEntry, cursor->acl);
+    if (aclEntry == NULL)
+    {
+        err = FM_ERR_INVALID_ACL;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+
+    err = ReadAclRulePage(sw, aclEntry, cursor, numRules, rules, maxRules);
+
+ABORT:
+    FM_DROP_ACL_LOCK(sw);
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ACL, err);
+
+}   /* end fmGetACLRuleTableNext */
+
+
+
+
 /*****************************************************************************/
 /** fmGetACL
  * \ingroup acl
@@ -2665,6 +2931,7 @@ fm_status fmAddACLPort(fm_int sw, fm_int acl, fm_int port, fm_aclType type)
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
     aclEntry->numberOfPorts[type]++;
+    switchPtr->aclInfo.layoutChanged = TRUE;
 
     if (type == FM_ACL_TYPE_INGRESS)
     {
@@ -2916,6 +3183,7 @@ fm_status fmDeleteACLPortExt(fm_int                   sw,
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
 
     aclEntry->numberOfPorts[type]--;
+    switchPtr->aclInfo.layoutChanged = TRUE;
 
     if (aclEntry->numberOfPorts[type] == 0)
     {
@@ -2997,6 +3265,7 @@ fm_status fmClearACLPort(fm_int sw, fm_int acl)
     aclEntry->numberOfPorts[FM_ACL_TYPE_INGRESS] = 0;
     aclEntry->numberOfPorts[FM_ACL_TYPE_EGRESS] = 0;
     aclEntry->aclPortType = FM_ACL_PORT_TYPE_NONE;
+    switchPtr->aclInfo.layoutChanged = TRUE;
 
     if ( (err == FM_OK) && (switchPtr->ClearACLPort != NULL) )
     {
@@ -3748,6 +4017,93 @@ fm_status fmResetACLCount(fm_int sw,
 
 
 
+/*****************************************************************************/
+/** fmGetACLCountList
+ * \ingroup acl
+ *
+ * \chips           FM10000
+ *
+ * \desc            Retrieve the frame and octet counts of every
+ *                  ''FM_ACL_ACTION_COUNT'' or ''FM_ACL_ACTIONEXT_COUNT''
+ *                  ingress ACL rule in a single call. Counters are read
+ *                  one policer bank at a time, which is considerably
+ *                  cheaper than calling ''fmGetACLCountExt'' per rule.
+ *
+ * \note            When clear is TRUE, frames counted between the read
+ *                  and the reset of a counter are lost, as they are with
+ *                  ''fmResetACLCount''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       maxEntries is the size of entries, being the maximum
+ *                  number of rule counters that may be returned.
+ *
+ * \param[out]      entries points to a caller-allocated array of
+ *                  maxEntries elements where this function should place
+ *                  the ACL, rule and counters of each counting rule.
+ *
+ * \param[out]      numEntries points to caller-allocated storage where
+ *                  this function should place the number of entries
+ *                  filled in.
+ *
+ * \param[in]       clear should be TRUE to reset each counter once it has
+ *                  been read.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_NO_ACLS if no ACLs have been applied.
+ * \return          FM_ERR_BUFFER_FULL if entries is too small to hold every
+ *                  rule counter. The first maxEntries are returned.
+ * \return          FM_ERR_UNSUPPORTED if the switch does not support this
+ *                  function.
+ *
+ *****************************************************************************/
+fm_status fmGetACLCountList(fm_int            sw,
+                            fm_int            maxEntries,
+                            fm_aclCountEntry *entries,
+                            fm_int *          numEntries,
+                            fm_bool           clear)
+{
+    fm_status  err;
+    fm_switch *switchPtr;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ACL,
+                     "sw = %d, maxEntries = %d, entries = %p, "
+                     "numEntries = %p, clear = %d\n",
+                     sw,
+                     maxEntries,
+                     (void *) entries,
+                     (void *) numEntries,
+                     clear);
+
+    if ( (maxEntries < 0) || (entries == NULL) || (numEntries == NULL) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_ACL, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+    FM_TAKE_ACL_LOCK(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_API_CALL_FAMILY(err,
+                       switchPtr->GetACLCountList,
+                       sw,
+                       maxEntries,
+                       entries,
+                       numEntries,
+                       clear);
+
+    FM_DROP_ACL_LOCK(sw);
+    UNPROTECT_SWITCH(sw);
+    FM_LOG_EXIT_API(FM_LOG_CAT_ACL, err);
+
+}   /* end fmGetACLCountList */
+
+
+
+
 /*****************************************************************************/
 /** fmGetACLEgressCount
  * \ingroup acl
@@ -3960,6 +4316,11 @@ fm_status fmCompileACL(fm_int    sw,
  *                  change is actually made to the internal ACL data 
  *                  structures.
  *
+ * \note            For FM10000 devices, if the flags argument has the
+ *                  ''FM_ACL_COMPILE_FLAG_INCREMENTAL'' bit set, only the
+ *                  ACL rules changed since the last apply are compiled,
+ *                  reusing the applied ACL image.
+ *
  * \note            This function is not needed for FM2000 family devices. If
  *                  called for an FM2000, it will return FM_OK without doing 
  *                  anything.
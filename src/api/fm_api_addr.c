@@ -639,6 +639,100 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fmAddAddressList
+ * \ingroup addr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Adds a list of entries to the MA Table. Each entry is
+ *                  handled as by ''fmAddAddress'', but the whole list is
+ *                  validated before any entry is added, the MA Table is
+ *                  updated in a single operation and the resulting table
+ *                  update events are reported together. This is
+ *                  considerably faster than adding the entries one by one
+ *                  when installing a large number of addresses.
+ *                                                                      \lb\lb
+ *                  On switches that do not support list operations, the
+ *                  entries are added one at a time after the whole list
+ *                  has been validated.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numEntries is the number of entries in the list.
+ *
+ * \param[in,out]   entries points to an array of ''fm_macAddressEntry''
+ *                  structures that describe the MA Table entries to be
+ *                  added.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if entries is NULL, numEntries
+ *                  is not positive or one of the entries is not valid. No
+ *                  entry is added in that case.
+ * \return          FM_ERR_INVALID_VLAN if the VLAN of one of the entries
+ *                  is out of range. No entry is added in that case.
+ * \return          FM_ERR_ADDR_BANK_FULL if there was no room in the MA
+ *                  Table for one of the addresses. The other entries are
+ *                  added.
+ *
+ *****************************************************************************/
+fm_status fmAddAddressList(fm_int              sw,
+                           fm_int              numEntries,
+                           fm_macAddressEntry *entries)
+{
+    fm_status  err;
+    fm_switch *switchPtr;
+    fm_int     i;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR,
+                     "sw=%d numEntries=%d entries=%p\n",
+                     sw,
+                     numEntries,
+                     (void *) entries);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    if (entries == NULL || numEntries <= 0)
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        goto ABORT;
+    }
+
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        if ( VLAN_OUT_OF_BOUNDS(entries[i].vlanID) )
+        {
+            err = FM_ERR_INVALID_VLAN;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+        }
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->AddAddressList != NULL)
+    {
+        err = switchPtr->AddAddressList(sw, numEntries, entries);
+    }
+    else
+    {
+        err = FM_OK;
+
+        for (i = 0 ; i < numEntries && err == FM_OK ; i++)
+        {
+            FM_API_CALL_FAMILY(err, switchPtr->AddAddress, sw, &entries[i]);
+        }
+    }
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+    FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, err);
+
+}   /* end fmAddAddressList */
+
+
+
+
 /*****************************************************************************/
 /** fmAddAddressInternal
  * \ingroup intAddr
@@ -1112,7 +1206,8 @@ fm_status fmGetAddressV2(fm_int              sw,
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
     vlanID = learningFID;
     
-    indexes = (fm_uint16 *) fmAlloc( sizeof(fm_uint16) * switchPtr->macTableBankCount );
+    indexes = (fm_uint16 *) fmAllocTagged( sizeof(fm_uint16) * switchPtr->macTableBankCount,
+                                           FM_LOG_CAT_ADDR );
     
     if (indexes == NULL)
     {
@@ -1234,7 +1329,8 @@ fm_status fmGetAddressInternal(fm_int                    sw,
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
     vlanID = learningFID;
 
-    indexes = (fm_uint16 *) fmAlloc( sizeof(fm_uint16) * switchPtr->macTableBankCount );
+    indexes = (fm_uint16 *) fmAllocTagged( sizeof(fm_uint16) * switchPtr->macTableBankCount,
+                                           FM_LOG_CAT_ADDR );
     
     if (indexes == NULL)
     {
@@ -1367,6 +1463,97 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fmDeleteAddressList
+ * \ingroup addr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Deletes a list of addresses from the MA Table. Each
+ *                  entry is handled as by ''fmDeleteAddress'', but the
+ *                  whole list is validated before any entry is deleted,
+ *                  the MA Table is updated in a single operation and the
+ *                  resulting table update events are reported together.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numEntries is the number of entries in the list.
+ *
+ * \param[in]       entries points to an array of ''fm_macAddressEntry''
+ *                  structures containing the address and vlan combinations
+ *                  to be deleted from the MA Table (other members of the
+ *                  structures are ignored).
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if entries is NULL or numEntries
+ *                  is not positive.
+ * \return          FM_ERR_USE_MCAST_FUNCTIONS if an attempt is made to
+ *                  delete a MAC address from a multicast group. No entry
+ *                  is deleted in that case.
+ * \return          FM_ERR_ADDR_NOT_FOUND if one of the address/vlan
+ *                  combinations was not found in the MA Table. The other
+ *                  entries are deleted.
+ *
+ *****************************************************************************/
+fm_status fmDeleteAddressList(fm_int              sw,
+                              fm_int              numEntries,
+                              fm_macAddressEntry *entries)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+    fm_status  status;
+    fm_int     i;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR,
+                     "sw=%d numEntries=%d entries=%p\n",
+                     sw,
+                     numEntries,
+                     (void *) entries);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    if (entries == NULL || numEntries <= 0)
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        goto ABORT;
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->DeleteAddressList != NULL)
+    {
+        err = switchPtr->DeleteAddressList(sw, numEntries, entries);
+        goto ABORT;
+    }
+
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        FM_API_CALL_FAMILY(err, switchPtr->DeleteAddressPre, sw, &entries[i]);
+
+        if ( (err != FM_OK) && (err != FM_ERR_UNSUPPORTED) )
+        {
+            goto ABORT;
+        }
+    }
+
+    err = FM_OK;
+
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        status = fmDeleteAddressFromTable(sw, &entries[i], FALSE, TRUE, -1);
+        FM_ERR_COMBINE(err, status);
+    }
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+    FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, err);
+
+}   /* end fmDeleteAddressList */
+
+
+
+
 /*****************************************************************************/
 /** fmDeleteAddressFromTable
  * \ingroup intAddr
@@ -1452,7 +1639,8 @@ fm_status fmDeleteAddressFromTable(fm_int              sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
     }
 
-    indexes = (fm_uint16 *) fmAlloc( sizeof(fm_uint16) * switchPtr->macTableBankCount );
+    indexes = (fm_uint16 *) fmAllocTagged( sizeof(fm_uint16) * switchPtr->macTableBankCount,
+                                           FM_LOG_CAT_ADDR );
     
     if (indexes == NULL)
     {
@@ -1638,6 +1826,529 @@ fm_status fmGetAddressTableExt(fm_int              sw,
 
 
 
+/*****************************************************************************/
+/** fmGetAddressTableFirst
+ * \ingroup addr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Begins a paged walk of the MA Table and retrieves its
+ *                  first page. Unlike ''fmGetAddressTableExt'', the switch
+ *                  and the MA Table are only locked while a page is being
+ *                  read, so address learning proceeds between pages.
+ *                  Use ''fmGetAddressTableNext'' to retrieve the following
+ *                  pages.
+ *                                                                      \lb\lb
+ *                  Entries added, moved or deleted during the walk may or
+ *                  may not be reported, depending on their position
+ *                  relative to the cursor. Deleted entries are reported
+ *                  by ''FM_EVENT_ENTRY_AGED'' table update events.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      cursor points to caller-allocated storage where this
+ *                  function is to store the position of the walk.
+ *
+ * \param[in]       sinceGeneration restricts the walk to the entries
+ *                  added or modified after the given MA Table generation,
+ *                  as recorded in the generation field of the cursor of an
+ *                  earlier walk. Zero retrieves every entry.
+ *
+ * \param[out]      nEntries points to caller-allocated storage where this
+ *                  function is to store the number of entries retrieved.
+ *
+ * \param[out]      entries points to an array of ''fm_macAddressEntry''
+ *                  structures that will be filled in by this function.
+ *
+ * \param[in]       maxEntries is the size of entries, being the maximum
+ *                  number of addresses in a page.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MORE if there are no entries to retrieve.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_UNSUPPORTED if the switch does not support paged
+ *                  walks, or does not track generations and
+ *                  sinceGeneration is not zero.
+ *
+ *****************************************************************************/
+fm_status fmGetAddressTableFirst(fm_int              sw,
+                                 fm_macTableCursor * cursor,
+                                 fm_uint64           sinceGeneration,
+                                 fm_int *            nEntries,
+                                 fm_macAddressEntry *entries,
+                                 fm_int              maxEntries)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR,
+                     "sw=%d cursor=%p sinceGeneration=%llu nEntries=%p "
+                     "entries=%p maxEntries=%d\n",
+                     sw,
+                     (void *) cursor,
+                     sinceGeneration,
+                     (void *) nEntries,
+                     (void *) entries,
+                     maxEntries);
+
+    if ( cursor == NULL || nEntries == NULL || entries == NULL ||
+         maxEntries <= 0 )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_CLEAR(*cursor);
+
+    if (switchPtr->GetAddressTablePage == NULL ||
+        (sinceGeneration != 0 && switchPtr->maIndex == NULL) )
+    {
+        err = FM_ERR_UNSUPPORTED;
+        goto ABORT;
+    }
+
+    FM_TAKE_L2_LOCK(sw);
+    cursor->generation = fmAddrIndexGetGeneration(switchPtr);
+    FM_DROP_L2_LOCK(sw);
+
+    cursor->sinceGeneration = sinceGeneration;
+
+    err = switchPtr->GetAddressTablePage(sw,
+                                         cursor,
+                                         nEntries,
+                                         entries,
+                                         maxEntries);
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, err);
+
+}   /* end fmGetAddressTableFirst */
+
+
+
+
+/*****************************************************************************/
+/** fmGetAddressTableNext
+ * \ingroup addr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Retrieves the next page of a paged walk of the MA Table
+ *                  begun by ''fmGetAddressTableFirst''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   cursor points to the position of the walk, as returned
+ *                  by the previous call.
+ *
+ * \param[out]      nEntries points to caller-allocated storage where this
+ *                  function is to store the number of entries retrieved.
+ *
+ * \param[out]      entries points to an array of ''fm_macAddressEntry''
+ *                  structures that will be filled in by this function.
+ *
+ * \param[in]       maxEntries is the size of entries, being the maximum
+ *                  number of addresses in a page.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MORE if the walk is complete.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_UNSUPPORTED if the switch does not support paged
+ *                  walks.
+ *
+ *****************************************************************************/
+fm_status fmGetAddressTableNext(fm_int              sw,
+                                fm_macTableCursor * cursor,
+                                fm_int *            nEntries,
+                                fm_macAddressEntry *entries,
+                                fm_int              maxEntries)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR,
+                     "sw=%d cursor=%p nEntries=%p entries=%p maxEntries=%d\n",
+                     sw,
+                     (void *) cursor,
+                     (void *) nEntries,
+                     (void *) entries,
+                     maxEntries);
+
+    if ( cursor == NULL || nEntries == NULL || entries == NULL ||
+         maxEntries <= 0 || cursor->index < 0 )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_API_CALL_FAMILY(err,
+                       switchPtr->GetAddressTablePage,
+                       sw,
+                       cursor,
+                       nEntries,
+                       entries,
+                       maxEntries);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, err);
+
+}   /* end fmGetAddressTableNext */
+
+
+
+
+/*****************************************************************************/
+/** fmGetAddressTableSnapshot
+ * \ingroup addr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Retrieves the next page of a walk of the MA Table
+ *                  without taking any API lock. May be called by a
+ *                  monitoring process attached with ''fmInitializeMonitor''.
+ *                                                                      \lb\lb
+ *                  Unlike ''fmGetAddressTableFirst'', the walk is started by
+ *                  clearing the cursor, setting its sinceGeneration field
+ *                  if desired. The generation field of the cursor is not
+ *                  updated. Entries that are being rewritten while they
+ *                  are read are skipped.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   cursor points to the position of the walk.
+ *
+ * \param[out]      nEntries points to caller-allocated storage where this
+ *                  function is to store the number of entries retrieved.
+ *
+ * \param[out]      entries points to an array of ''fm_macAddressEntry''
+ *                  structures that will be filled in by this function.
+ *
+ * \param[in]       maxEntries is the size of entries, being the maximum
+ *                  number of addresses in a page.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MORE if the walk is complete.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_SWITCH_NOT_UP if the switch is not up.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_UNSUPPORTED if the switch does not support
+ *                  lock-free walks.
+ *
+ *****************************************************************************/
+fm_status fmGetAddressTableSnapshot(fm_int              sw,
+                                    fm_macTableCursor * cursor,
+                                    fm_int *            nEntries,
+                                    fm_macAddressEntry *entries,
+                                    fm_int              maxEntries)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ADDR,
+                 "sw=%d cursor=%p nEntries=%p entries=%p maxEntries=%d\n",
+                 sw,
+                 (void *) cursor,
+                 (void *) nEntries,
+                 (void *) entries,
+                 maxEntries);
+
+    if ( cursor == NULL || nEntries == NULL || entries == NULL ||
+         maxEntries <= 0 || cursor->index < 0 )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ADDR, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_SWITCH_LOCK_FREE(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->GetAddressTableSnapshot == NULL)
+    {
+        err = FM_ERR_UNSUPPORTED;
+    }
+    else
+    {
+        err = switchPtr->GetAddressTableSnapshot(sw,
+                                                 cursor,
+                                                 nEntries,
+                                                 entries,
+                                                 maxEntries);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_ADDR, err);
+
+}   /* end fmGetAddressTableSnapshot */
+
+
+
+
+/*****************************************************************************/
+/** fmGetAddressJournal
+ * \ingroup addr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Retrieves the changes of the MA Table (additions, moves,
+ *                  agings and deletions) recorded after a given sequence
+ *                  number, oldest first. The journal holds the last
+ *                  api.ma.journalSize changes.
+ *                                                                      \lb\lb
+ *                  To export the MA Table incrementally, read the current
+ *                  sequence number with ''fmGetAddressJournalSequence'',
+ *                  then the whole table, then the changes since that
+ *                  sequence number. Changes already reflected in the table
+ *                  may be returned again. On FM_ERR_JOURNAL_OVERFLOW, start
+ *                  over.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       sinceSequence is the sequence number of the last change
+ *                  already read.
+ *
+ * \param[out]      nEntries points to caller-allocated storage where this
+ *                  function is to store the number of changes retrieved,
+ *                  zero if there is no new change.
+ *
+ * \param[out]      entries points to an array of ''fm_macJournalEntry''
+ *                  structures that will be filled in by this function.
+ *
+ * \param[in]       maxEntries is the size of entries. If more changes are
+ *                  available, call again with the sequence number of the
+ *                  last change retrieved.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_JOURNAL_OVERFLOW if changes following
+ *                  sinceSequence were dropped before they could be read,
+ *                  or the MA Table was reset. The caller must
+ *                  resynchronize from the whole table.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid or
+ *                  sinceSequence is beyond the last change.
+ * \return          FM_ERR_UNSUPPORTED if the journal is disabled.
+ *
+ *****************************************************************************/
+fm_status fmGetAddressJournal(fm_int              sw,
+                              fm_uint64           sinceSequence,
+                              fm_int *            nEntries,
+                              fm_macJournalEntry *entries,
+                              fm_int              maxEntries)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR,
+                     "sw=%d sinceSequence=%llu nEntries=%p entries=%p "
+                     "maxEntries=%d\n",
+                     sw,
+                     sinceSequence,
+                     (void *) nEntries,
+                     (void *) entries,
+                     maxEntries);
+
+    if (nEntries == NULL || entries == NULL || maxEntries <= 0)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    *nEntries = 0;
+
+    FM_TAKE_L2_LOCK(sw);
+
+    if (switchPtr->maJournal == NULL)
+    {
+        err = FM_ERR_UNSUPPORTED;
+    }
+    else
+    {
+        err = fmAddrJournalRead(switchPtr,
+                                sinceSequence,
+                                nEntries,
+                                entries,
+                                maxEntries);
+    }
+
+    FM_DROP_L2_LOCK(sw);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, err);
+
+}   /* end fmGetAddressJournal */
+
+
+
+
+/*****************************************************************************/
+/** fmGetAddressJournalSequence
+ * \ingroup addr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Retrieves the sequence number of the last change
+ *                  recorded in the MA Table change journal. See
+ *                  ''fmGetAddressJournal''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      sequence points to caller-allocated storage where this
+ *                  function is to store the sequence number, zero if no
+ *                  change has been recorded.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if sequence is NULL.
+ * \return          FM_ERR_UNSUPPORTED if the journal is disabled.
+ *
+ *****************************************************************************/
+fm_status fmGetAddressJournalSequence(fm_int sw, fm_uint64 *sequence)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR,
+                     "sw=%d sequence=%p\n",
+                     sw,
+                     (void *) sequence);
+
+    if (sequence == NULL)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    err       = FM_OK;
+
+    FM_TAKE_L2_LOCK(sw);
+
+    if (switchPtr->maJournal == NULL)
+    {
+        err = FM_ERR_UNSUPPORTED;
+    }
+    else
+    {
+        *sequence = fmAddrJournalGetSequence(switchPtr);
+    }
+
+    FM_DROP_L2_LOCK(sw);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, err);
+
+}   /* end fmGetAddressJournalSequence */
+
+
+
+
+/*****************************************************************************/
+/** fmGetAddressTableStats
+ * \ingroup addr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Retrieves the MA Table occupancy and collision
+ *                  statistics: how full the bins new addresses hash to
+ *                  are, how often a bin overflowed and which bins
+ *                  overflowed most. These help tune the hash inputs and
+ *                  anticipate saturation of the table.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      stats points to caller-allocated storage where this
+ *                  function is to store the statistics.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if stats is NULL.
+ * \return          FM_ERR_UNSUPPORTED if the switch does not maintain the
+ *                  statistics.
+ *
+ *****************************************************************************/
+fm_status fmGetAddressTableStats(fm_int sw, fm_macTableStats *stats)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR,
+                     "sw=%d stats=%p\n",
+                     sw,
+                     (void *) stats);
+
+    if (stats == NULL)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_API_CALL_FAMILY(err, switchPtr->GetAddressTableStats, sw, stats);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, err);
+
+}   /* end fmGetAddressTableStats */
+
+
+
+
+/*****************************************************************************/
+/** fmResetAddressTableStats
+ * \ingroup addr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Resets the MA Table occupancy and collision statistics
+ *                  returned by ''fmGetAddressTableStats''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_UNSUPPORTED if the switch does not maintain the
+ *                  statistics.
+ *
+ *****************************************************************************/
+fm_status fmResetAddressTableStats(fm_int sw)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR, "sw=%d\n", sw);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_API_CALL_FAMILY(err, switchPtr->ResetAddressTableStats, sw);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, err);
+
+}   /* end fmResetAddressTableStats */
+
+
+
+
 /*****************************************************************************/
 /** fmDeleteAllAddresses
  * \ingroup addr
@@ -2426,6 +3137,9 @@ fm_status fmCommonFindAndInvalidateAddr(fm_int     sw,
             tmpEntry = *tblentry;
             tmpEntry.state = FM_MAC_ENTRY_STATE_INVALID;
 
+            /* Unlist the entry while the L2 lock is still held. */
+            fmAddrIndexUnlink(switchPtr, addr);
+
             if (updateHw)
             {
                 err = fmWriteEntryAtIndex(sw, addr, &tmpEntry);
@@ -2529,7 +3243,8 @@ fm_status fmCommonAllocAddrTableCache(fm_switch *switchPtr)
     size  = (fm_uint) sizeof(fm_internalMacAddrEntry);
     size *= (fm_uint) switchPtr->macTableSize;
 
-    switchPtr->maTable = (fm_internalMacAddrEntry *) fmAlloc(size);
+    switchPtr->maTable = (fm_internalMacAddrEntry *) fmAllocTagged(size,
+                                                                   FM_LOG_CAT_ADDR);
 
     if (switchPtr->maTable == NULL)
     {
@@ -2538,6 +3253,11 @@ fm_status fmCommonAllocAddrTableCache(fm_switch *switchPtr)
     else
     {
         memset((void *) switchPtr->maTable, 0, (size_t) size);
+
+        err = fmAllocAddrIndex(switchPtr);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR | FM_LOG_CAT_SWITCH, err);
+
+        err = fmAllocAddrJournal(switchPtr);
     }
 
 ABORT:
@@ -2581,6 +3301,9 @@ fm_status fmCommonFreeAddrTableCache(fm_switch *switchPtr)
         fmFree(switchPtr->maTable);
         switchPtr->maTable = NULL;
     }
+
+    fmFreeAddrJournal(switchPtr);
+    fmFreeAddrIndex(switchPtr);
     
 ABORT:
     FM_LOG_EXIT(FM_LOG_CAT_ADDR | FM_LOG_CAT_SWITCH, err);
@@ -2810,6 +3533,7 @@ fm_status fmCommonDeleteAllAddresses(fm_int sw, fm_bool dynamicOnly)
              ( (cacheEntry->state != FM_MAC_ENTRY_STATE_INVALID) &&
                (cacheEntry->state != FM_MAC_ENTRY_STATE_LOCKED) ) )
         {
+            fmAddrIndexUnlink(switchPtr, (fm_uint32) i);
             cacheEntry->state = FM_MAC_ENTRY_STATE_INVALID;
 
             fmDbgDiagCountIncr(sw, FM_CTR_MAC_CACHE_DELETED, 1);
@@ -0,0 +1,1142 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_api_addr_index.c
+ * Creation Date:   October 15, 2026
+ * Description:     Per-port and per-FID indexes of the MA table cache
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* Whether a port or FID has a list of its own */
+#define IS_LISTED_PORT(port)    ( (port) >= 0 && (port) <= FM_MAX_LOGICAL_PORT )
+#define IS_LISTED_VLAN(vlanID)  ( (vlanID) < FM_MAX_VLAN )
+
+/* Whether an entry is subject to aging */
+#define IS_AGING_STATE(state)                   \
+    ( (state) == FM_MAC_ENTRY_STATE_YOUNG ||    \
+      (state) == FM_MAC_ENTRY_STATE_OLD )
+
+/* Attempts at a lock-free copy of an entry that is being rewritten */
+#define SNAPSHOT_READ_RETRIES   8
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** CollectList
+ * \ingroup intAddr
+ *
+ * \desc            Copies the entry indexes of one index list into an
+ *                  array allocated for the purpose.
+ *
+ * \param[in]       maIndex points to the MA table index.
+ *
+ * \param[in]       head is the first entry of the list.
+ *
+ * \param[in]       byPort is TRUE to follow the port links, FALSE to follow
+ *                  the FID links.
+ *
+ * \param[out]      indexes points to caller-allocated storage where the
+ *                  array is written, NULL if the list is empty. The caller
+ *                  frees it with fmFree.
+ *
+ * \param[out]      numIndexes points to caller-allocated storage where the
+ *                  number of entries is written.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if the array could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status CollectList(fm_maTableIndex *maIndex,
+                             fm_uint16        head,
+                             fm_bool          byPort,
+                             fm_uint32 **     indexes,
+                             fm_int *         numIndexes)
+{
+    fm_maIndexLink *link;
+    fm_uint16       entry;
+    fm_int          count;
+
+    count = 0;
+
+    for (entry = head ; entry != FM_MA_INDEX_NONE ; )
+    {
+        link  = &maIndex->links[entry];
+        entry = byPort ? link->portNext : link->vlanNext;
+        count++;
+    }
+
+    *indexes    = NULL;
+    *numIndexes = 0;
+
+    if (count == 0)
+    {
+        return FM_OK;
+    }
+
+    *indexes = fmAllocTagged(count * sizeof(fm_uint32), FM_LOG_CAT_ADDR);
+
+    if (*indexes == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    for (entry = head ; entry != FM_MA_INDEX_NONE ; )
+    {
+        (*indexes)[(*numIndexes)++] = entry;
+
+        link  = &maIndex->links[entry];
+        entry = byPort ? link->portNext : link->vlanNext;
+    }
+
+    return FM_OK;
+
+}   /* end CollectList */
+
+
+
+
+/*****************************************************************************/
+/** AgeInsert
+ * \ingroup intAddr
+ *
+ * \desc            Puts an entry on the aging wheel, in the slot of the
+ *                  time it was last hit. An entry whose slot has already
+ *                  been visited is put in the next slot to be visited, so
+ *                  that it is not missed.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \param[in]       index is the MA table index of the entry.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void AgeInsert(fm_switch *switchPtr, fm_uint32 index)
+{
+    fm_maTableIndex *        maIndex;
+    fm_maIndexLink *         link;
+    fm_internalMacAddrEntry *entry;
+    fm_uint64                slot;
+    fm_uint64                cursor;
+
+    maIndex = switchPtr->maIndex;
+    link    = &maIndex->links[index];
+    entry   = &switchPtr->maTable[index];
+
+    link->ageSlot = FM_MA_INDEX_NONE;
+
+    if (maIndex->ageSlotWidth == 0 || !IS_AGING_STATE(entry->state))
+    {
+        return;
+    }
+
+    slot   = entry->agingCounter / maIndex->ageSlotWidth;
+    cursor = (entry->state == FM_MAC_ENTRY_STATE_YOUNG) ?
+             maIndex->ageOldCursor : maIndex->ageExpireCursor;
+
+    if (slot <= cursor)
+    {
+        slot = cursor + 1;
+    }
+
+    link->ageSlot = (fm_uint16) (slot % FM_MA_AGE_WHEEL_SLOTS);
+    link->agePrev = FM_MA_INDEX_NONE;
+    link->ageNext = maIndex->ageHead[link->ageSlot];
+
+    if (link->ageNext != FM_MA_INDEX_NONE)
+    {
+        maIndex->links[link->ageNext].agePrev = (fm_uint16) index;
+    }
+
+    maIndex->ageHead[link->ageSlot] = (fm_uint16) index;
+
+}   /* end AgeInsert */
+
+
+
+
+/*****************************************************************************/
+/** AgeRemove
+ * \ingroup intAddr
+ *
+ * \desc            Takes an entry off the aging wheel, if it is on it.
+ *
+ * \param[in]       maIndex points to the MA table index.
+ *
+ * \param[in]       index is the MA table index of the entry.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void AgeRemove(fm_maTableIndex *maIndex, fm_uint32 index)
+{
+    fm_maIndexLink *link;
+
+    link = &maIndex->links[index];
+
+    if (link->ageSlot == FM_MA_INDEX_NONE)
+    {
+        return;
+    }
+
+    if (link->agePrev != FM_MA_INDEX_NONE)
+    {
+        maIndex->links[link->agePrev].ageNext = link->ageNext;
+    }
+    else
+    {
+        maIndex->ageHead[link->ageSlot] = link->ageNext;
+    }
+
+    if (link->ageNext != FM_MA_INDEX_NONE)
+    {
+        maIndex->links[link->ageNext].agePrev = link->agePrev;
+    }
+
+    link->ageSlot = FM_MA_INDEX_NONE;
+
+}   /* end AgeRemove */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** fmAllocAddrIndex
+ * \ingroup intAddr
+ *
+ * \desc            Allocates the per-port and per-FID indexes of the MA
+ *                  table cache. Tables too large for 16-bit entry indexes
+ *                  are left without an index, and every lookup on them
+ *                  walks the whole cache as before.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ *
+ *****************************************************************************/
+fm_status fmAllocAddrIndex(fm_switch *switchPtr)
+{
+    fm_maTableIndex *maIndex;
+
+    switchPtr->maIndex = NULL;
+
+    if (switchPtr->macTableSize >= FM_MA_INDEX_NONE)
+    {
+        return FM_OK;
+    }
+
+    maIndex = fmAllocTagged(sizeof(fm_maTableIndex), FM_LOG_CAT_ADDR);
+
+    if (maIndex == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    FM_CLEAR(*maIndex);
+
+    maIndex->links = fmAllocTagged(switchPtr->macTableSize * sizeof(fm_maIndexLink),
+                                   FM_LOG_CAT_ADDR);
+    maIndex->portHead = fmAllocTagged( (FM_MAX_LOGICAL_PORT + 1) * sizeof(fm_uint16),
+                                       FM_LOG_CAT_ADDR );
+
+    if (maIndex->links == NULL || maIndex->portHead == NULL)
+    {
+        if (maIndex->links != NULL)
+        {
+            fmFree(maIndex->links);
+        }
+
+        if (maIndex->portHead != NULL)
+        {
+            fmFree(maIndex->portHead);
+        }
+
+        fmFree(maIndex);
+
+        return FM_ERR_NO_MEM;
+    }
+
+    switchPtr->maIndex = maIndex;
+
+    fmResetAddrIndex(switchPtr);
+
+    return FM_OK;
+
+}   /* end fmAllocAddrIndex */
+
+
+
+
+/*****************************************************************************/
+/** fmFreeAddrIndex
+ * \ingroup intAddr
+ *
+ * \desc            Frees the indexes of the MA table cache.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmFreeAddrIndex(fm_switch *switchPtr)
+{
+    fm_maTableIndex *maIndex;
+
+    maIndex = switchPtr->maIndex;
+
+    if (maIndex == NULL)
+    {
+        return;
+    }
+
+    fmFree(maIndex->links);
+    fmFree(maIndex->portHead);
+    fmFree(maIndex);
+
+    switchPtr->maIndex = NULL;
+
+}   /* end fmFreeAddrIndex */
+
+
+
+
+/*****************************************************************************/
+/** fmResetAddrIndex
+ * \ingroup intAddr
+ *
+ * \desc            Empties the indexes of the MA table cache, and the
+ *                  change journal fed by them. Called when every entry of
+ *                  the cache is invalidated at once.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmResetAddrIndex(fm_switch *switchPtr)
+{
+    fm_maTableIndex *maIndex;
+    fm_int           i;
+
+    fmResetAddrJournal(switchPtr);
+
+    maIndex = switchPtr->maIndex;
+
+    if (maIndex == NULL)
+    {
+        return;
+    }
+
+    for (i = 0 ; i < switchPtr->macTableSize ; i++)
+    {
+        maIndex->links[i].linked  = FALSE;
+        maIndex->links[i].ageSlot = FM_MA_INDEX_NONE;
+    }
+
+    for (i = 0 ; i <= FM_MAX_LOGICAL_PORT ; i++)
+    {
+        maIndex->portHead[i] = FM_MA_INDEX_NONE;
+    }
+
+    for (i = 0 ; i < FM_MAX_VLAN ; i++)
+    {
+        maIndex->vlanHead[i] = FM_MA_INDEX_NONE;
+    }
+
+    for (i = 0 ; i < FM_MA_AGE_WHEEL_SLOTS ; i++)
+    {
+        maIndex->ageHead[i] = FM_MA_INDEX_NONE;
+    }
+
+    maIndex->numValid    = 0;
+    maIndex->numUnlisted = 0;
+    maIndex->numExpired  = 0;
+
+}   /* end fmResetAddrIndex */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrIndexLink
+ * \ingroup intAddr
+ *
+ * \desc            Adds a MA table cache entry to the lists of its port
+ *                  and FID, once the entry has been written to the cache.
+ *                  Invalid entries are not listed.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \param[in]       index is the MA table index of the entry.
+ *
+ *****************************************************************************/
+void fmAddrIndexLink(fm_switch *switchPtr, fm_uint32 index)
+{
+    fm_maTableIndex *        maIndex;
+    fm_maIndexLink *         link;
+    fm_internalMacAddrEntry *entry;
+
+    maIndex = switchPtr->maIndex;
+
+    if (maIndex == NULL)
+    {
+        return;
+    }
+
+    link  = &maIndex->links[index];
+    entry = &switchPtr->maTable[index];
+
+    if (link->linked || entry->state == FM_MAC_ENTRY_STATE_INVALID)
+    {
+        return;
+    }
+
+    /* The new generation is visible before the entry is marked linked,
+     * see fmAddrIndexReadEntry. */
+    FM_ATOMIC_STORE(&link->generation, ++maIndex->generation);
+
+    fmAddrJournalNoteLink(switchPtr, index);
+
+    maIndex->numValid++;
+
+    if (entry->state == FM_MAC_ENTRY_STATE_EXPIRED)
+    {
+        maIndex->numExpired++;
+    }
+
+    AgeInsert(switchPtr, index);
+
+    if ( !IS_LISTED_PORT(entry->port) || !IS_LISTED_VLAN(entry->vlanID) )
+    {
+        maIndex->numUnlisted++;
+        link->port = FM_MA_INDEX_NONE;
+        FM_ATOMIC_STORE(&link->linked, TRUE);
+        return;
+    }
+
+    link->port     = (fm_uint16) entry->port;
+    link->vlanID   = entry->vlanID;
+    link->portPrev = FM_MA_INDEX_NONE;
+    link->portNext = maIndex->portHead[link->port];
+    link->vlanPrev = FM_MA_INDEX_NONE;
+    link->vlanNext = maIndex->vlanHead[link->vlanID];
+
+    if (link->portNext != FM_MA_INDEX_NONE)
+    {
+        maIndex->links[link->portNext].portPrev = (fm_uint16) index;
+    }
+
+    if (link->vlanNext != FM_MA_INDEX_NONE)
+    {
+        maIndex->links[link->vlanNext].vlanPrev = (fm_uint16) index;
+    }
+
+    maIndex->portHead[link->port]   = (fm_uint16) index;
+    maIndex->vlanHead[link->vlanID] = (fm_uint16) index;
+    FM_ATOMIC_STORE(&link->linked, TRUE);
+
+}   /* end fmAddrIndexLink */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrIndexUnlink
+ * \ingroup intAddr
+ *
+ * \desc            Removes a MA table cache entry from the lists of its
+ *                  port and FID. Must be called before the entry is
+ *                  invalidated or overwritten in the cache.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \param[in]       index is the MA table index of the entry.
+ *
+ *****************************************************************************/
+void fmAddrIndexUnlink(fm_switch *switchPtr, fm_uint32 index)
+{
+    fm_maTableIndex *maIndex;
+    fm_maIndexLink * link;
+
+    maIndex = switchPtr->maIndex;
+
+    if (maIndex == NULL)
+    {
+        return;
+    }
+
+    link = &maIndex->links[index];
+
+    if (!link->linked)
+    {
+        return;
+    }
+
+    fmAddrJournalNoteUnlink(switchPtr, index);
+
+    maIndex->numValid--;
+
+    if (switchPtr->maTable[index].state == FM_MAC_ENTRY_STATE_EXPIRED)
+    {
+        maIndex->numExpired--;
+    }
+
+    AgeRemove(maIndex, index);
+
+    /* Lock-free readers must see the entry unlinked before the caller
+     * overwrites it. */
+    FM_ATOMIC_STORE(&link->linked, FALSE);
+    FM_ATOMIC_FENCE();
+
+    if (link->port == FM_MA_INDEX_NONE)
+    {
+        maIndex->numUnlisted--;
+        return;
+    }
+
+    if (link->portPrev != FM_MA_INDEX_NONE)
+    {
+        maIndex->links[link->portPrev].portNext = link->portNext;
+    }
+    else
+    {
+        maIndex->portHead[link->port] = link->portNext;
+    }
+
+    if (link->portNext != FM_MA_INDEX_NONE)
+    {
+        maIndex->links[link->portNext].portPrev = link->portPrev;
+    }
+
+    if (link->vlanPrev != FM_MA_INDEX_NONE)
+    {
+        maIndex->links[link->vlanPrev].vlanNext = link->vlanNext;
+    }
+    else
+    {
+        maIndex->vlanHead[link->vlanID] = link->vlanNext;
+    }
+
+    if (link->vlanNext != FM_MA_INDEX_NONE)
+    {
+        maIndex->links[link->vlanNext].vlanPrev = link->vlanPrev;
+    }
+
+}   /* end fmAddrIndexUnlink */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrIndexNoteExpired
+ * \ingroup intAddr
+ *
+ * \desc            Records that a listed entry of the MA table cache has
+ *                  moved to the EXPIRED state, and takes it off the aging
+ *                  wheel.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \param[in]       index is the MA table index of the entry.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmAddrIndexNoteExpired(fm_switch *switchPtr, fm_uint32 index)
+{
+
+    if (switchPtr->maIndex != NULL)
+    {
+        switchPtr->maIndex->numExpired++;
+        AgeRemove(switchPtr->maIndex, index);
+    }
+
+}   /* end fmAddrIndexNoteExpired */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrIndexNoteHit
+ * \ingroup intAddr
+ *
+ * \desc            Moves an entry to the aging wheel slot of its new
+ *                  agingCounter, after the entry was hit and made YOUNG.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \param[in]       index is the MA table index of the entry.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmAddrIndexNoteHit(fm_switch *switchPtr, fm_uint32 index)
+{
+
+    if (switchPtr->maIndex == NULL || !switchPtr->maIndex->links[index].linked)
+    {
+        return;
+    }
+
+    AgeRemove(switchPtr->maIndex, index);
+    AgeInsert(switchPtr, index);
+
+}   /* end fmAddrIndexNoteHit */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrIndexHasAgeWheel
+ * \ingroup intAddr
+ *
+ * \desc            Tells whether the entries subject to aging are on the
+ *                  aging wheel, so that aging can use
+ *                  ''fmAddrIndexGetAgeDue'' rather than walk the cache.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \return          TRUE if the aging wheel is in use.
+ *
+ *****************************************************************************/
+fm_bool fmAddrIndexHasAgeWheel(fm_switch *switchPtr)
+{
+
+    return (switchPtr->maIndex != NULL &&
+            switchPtr->maIndex->ageSlotWidth != 0);
+
+}   /* end fmAddrIndexHasAgeWheel */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrIndexSetAgeWheel
+ * \ingroup intAddr
+ *
+ * \desc            Sets the time covered by each slot of the aging wheel,
+ *                  and puts every entry subject to aging back on the wheel
+ *                  if it changed. The wheel must span the longest age of
+ *                  an entry, plus the interval between two visits.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \param[in]       slotWidth is the number of aging timer ticks covered
+ *                  by each slot, 0 to stop using the wheel.
+ *
+ * \param[in]       currentTime is the current value of the aging timer.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmAddrIndexSetAgeWheel(fm_switch *switchPtr,
+                            fm_uint64  slotWidth,
+                            fm_uint64  currentTime)
+{
+    fm_maTableIndex *maIndex;
+    fm_uint64        slot;
+    fm_int           i;
+
+    maIndex = switchPtr->maIndex;
+
+    if (maIndex == NULL || maIndex->ageSlotWidth == slotWidth)
+    {
+        return;
+    }
+
+    for (i = 0 ; i < FM_MA_AGE_WHEEL_SLOTS ; i++)
+    {
+        maIndex->ageHead[i] = FM_MA_INDEX_NONE;
+    }
+
+    maIndex->ageSlotWidth = slotWidth;
+
+    if (slotWidth == 0)
+    {
+        for (i = 0 ; i < switchPtr->macTableSize ; i++)
+        {
+            maIndex->links[i].ageSlot = FM_MA_INDEX_NONE;
+        }
+
+        return;
+    }
+
+    /* Entries last hit longer ago than the wheel spans go in the first
+     * slot, and are aged out at the next visit. */
+    slot = currentTime / slotWidth;
+
+    maIndex->ageOldCursor = (slot >= FM_MA_AGE_WHEEL_SLOTS) ?
+                            slot - FM_MA_AGE_WHEEL_SLOTS + 1 : 0;
+    maIndex->ageExpireCursor = maIndex->ageOldCursor;
+
+    for (i = 0 ; i < switchPtr->macTableSize ; i++)
+    {
+        if (maIndex->links[i].linked)
+        {
+            AgeInsert(switchPtr, i);
+        }
+        else
+        {
+            maIndex->links[i].ageSlot = FM_MA_INDEX_NONE;
+        }
+    }
+
+}   /* end fmAddrIndexSetAgeWheel */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrIndexGetAgeDue
+ * \ingroup intAddr
+ *
+ * \desc            Returns the entries of the aging wheel slots that have
+ *                  become due since the last call: the slots whose entries
+ *                  were all last hit at or before cutoffTime. The entries
+ *                  still have to be checked against their exact age.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \param[in]       cutoffTime is the latest agingCounter value that makes
+ *                  an entry due.
+ *
+ * \param[in]       forExpiry is TRUE to visit the slots due for expiry,
+ *                  FALSE to visit the slots due to go from YOUNG to OLD.
+ *                  Each kind of visit has its own position on the wheel.
+ *
+ * \param[out]      indexes points to caller-allocated storage where an
+ *                  array of entry indexes is written, NULL if there is
+ *                  none. The caller frees it with fmFree.
+ *
+ * \param[out]      numIndexes points to caller-allocated storage where the
+ *                  number of entry indexes is written.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the aging wheel is not in use.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ *
+ *****************************************************************************/
+fm_status fmAddrIndexGetAgeDue(fm_switch * switchPtr,
+                               fm_uint64   cutoffTime,
+                               fm_bool     forExpiry,
+                               fm_uint32 **indexes,
+                               fm_int *    numIndexes)
+{
+    fm_maTableIndex *maIndex;
+    fm_uint64 *      cursor;
+    fm_uint64        first;
+    fm_uint64        last;
+    fm_uint64        slot;
+    fm_uint16        entry;
+    fm_int           count;
+
+    *indexes    = NULL;
+    *numIndexes = 0;
+
+    if (!fmAddrIndexHasAgeWheel(switchPtr))
+    {
+        return FM_ERR_UNSUPPORTED;
+    }
+
+    maIndex = switchPtr->maIndex;
+    cursor  = forExpiry ? &maIndex->ageExpireCursor : &maIndex->ageOldCursor;
+
+    /* Last slot whose whole time range is at or before the cutoff. */
+    last = (cutoffTime + 1) / maIndex->ageSlotWidth;
+
+    if (last == 0 || last - 1 <= *cursor)
+    {
+        return FM_OK;
+    }
+
+    last--;
+
+    /* Each slot need only be visited once, however late the visit. */
+    first = *cursor + 1;
+
+    if (last - first >= FM_MA_AGE_WHEEL_SLOTS)
+    {
+        first = last - FM_MA_AGE_WHEEL_SLOTS + 1;
+    }
+
+    count = 0;
+
+    for (slot = first ; slot <= last ; slot++)
+    {
+        for (entry = maIndex->ageHead[slot % FM_MA_AGE_WHEEL_SLOTS] ;
+             entry != FM_MA_INDEX_NONE ;
+             entry = maIndex->links[entry].ageNext)
+        {
+            count++;
+        }
+    }
+
+    if (count > 0)
+    {
+        *indexes = fmAllocTagged(count * sizeof(fm_uint32), FM_LOG_CAT_ADDR);
+
+        if (*indexes == NULL)
+        {
+            return FM_ERR_NO_MEM;
+        }
+
+        for (slot = first ; slot <= last ; slot++)
+        {
+            for (entry = maIndex->ageHead[slot % FM_MA_AGE_WHEEL_SLOTS] ;
+                 entry != FM_MA_INDEX_NONE ;
+                 entry = maIndex->links[entry].ageNext)
+            {
+                (*indexes)[(*numIndexes)++] = entry;
+            }
+        }
+    }
+
+    *cursor = last;
+
+    return FM_OK;
+
+}   /* end fmAddrIndexGetAgeDue */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrIndexCountValid
+ * \ingroup intAddr
+ *
+ * \desc            Returns the number of valid entries in the MA table
+ *                  cache.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \return          The number of valid entries.
+ *
+ *****************************************************************************/
+fm_int fmAddrIndexCountValid(fm_switch *switchPtr)
+{
+    fm_int count;
+    fm_int i;
+
+    if (switchPtr->maIndex != NULL)
+    {
+        return switchPtr->maIndex->numValid;
+    }
+
+    count = 0;
+
+    for (i = 0 ; i < switchPtr->macTableSize ; i++)
+    {
+        if (switchPtr->maTable[i].state != FM_MAC_ENTRY_STATE_INVALID)
+        {
+            count++;
+        }
+    }
+
+    return count;
+
+}   /* end fmAddrIndexCountValid */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrIndexGetEntries
+ * \ingroup intAddr
+ *
+ * \desc            Returns the MA table indexes of the entries a purge on
+ *                  a port, a FID or both has to visit: the list of the
+ *                  port, or of the FID, whichever is shorter. The entries
+ *                  still have to be matched against the purge criteria.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \param[in]       port is the logical port, or -1 for any port.
+ *
+ * \param[in]       vlanID is the FID, or -1 for any FID.
+ *
+ * \param[out]      indexes points to caller-allocated storage where an
+ *                  array of entry indexes is written, NULL if there is
+ *                  none. The caller frees it with fmFree.
+ *
+ * \param[out]      numIndexes points to caller-allocated storage where the
+ *                  number of entry indexes is written.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the whole cache has to be walked:
+ *                  the table has no index, both port and vlanID are -1,
+ *                  some entries have expired and must be purged too, or
+ *                  some entries could not be listed.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ *
+ *****************************************************************************/
+fm_status fmAddrIndexGetEntries(fm_switch * switchPtr,
+                                fm_int      port,
+                                fm_int      vlanID,
+                                fm_uint32 **indexes,
+                                fm_int *    numIndexes)
+{
+    fm_maTableIndex *maIndex;
+    fm_uint32 *      vlanIndexes;
+    fm_int           numVlanIndexes;
+    fm_status        err;
+
+    maIndex = switchPtr->maIndex;
+
+    if ( maIndex == NULL ||
+         maIndex->numExpired > 0 ||
+         maIndex->numUnlisted > 0 ||
+         (port < 0 && vlanID < 0) ||
+         (port >= 0 && !IS_LISTED_PORT(port)) ||
+         (vlanID >= 0 && !IS_LISTED_VLAN(vlanID)) )
+    {
+        return FM_ERR_UNSUPPORTED;
+    }
+
+    if (vlanID < 0)
+    {
+        return CollectList(maIndex,
+                           maIndex->portHead[port],
+                           TRUE,
+                           indexes,
+                           numIndexes);
+    }
+
+    err = CollectList(maIndex,
+                      maIndex->vlanHead[vlanID],
+                      FALSE,
+                      &vlanIndexes,
+                      &numVlanIndexes);
+
+    if (err != FM_OK || port < 0)
+    {
+        *indexes    = vlanIndexes;
+        *numIndexes = numVlanIndexes;
+        return err;
+    }
+
+    err = CollectList(maIndex,
+                      maIndex->portHead[port],
+                      TRUE,
+                      indexes,
+                      numIndexes);
+
+    if (err != FM_OK || *numIndexes > numVlanIndexes)
+    {
+        if (*indexes != NULL)
+        {
+            fmFree(*indexes);
+        }
+
+        *indexes    = vlanIndexes;
+        *numIndexes = numVlanIndexes;
+        return FM_OK;
+    }
+
+    if (vlanIndexes != NULL)
+    {
+        fmFree(vlanIndexes);
+    }
+
+    return FM_OK;
+
+}   /* end fmAddrIndexGetEntries */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrIndexGetGeneration
+ * \ingroup intAddr
+ *
+ * \desc            Returns the current generation of the MA table cache.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \return          The generation, or 0 if the cache has no index.
+ *
+ *****************************************************************************/
+fm_uint64 fmAddrIndexGetGeneration(fm_switch *switchPtr)
+{
+
+    if (switchPtr->maIndex == NULL)
+    {
+        return 0;
+    }
+
+    return switchPtr->maIndex->generation;
+
+}   /* end fmAddrIndexGetGeneration */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrIndexChangedSince
+ * \ingroup intAddr
+ *
+ * \desc            Determines whether a MA table cache entry was written
+ *                  after a given generation.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \param[in]       index is the MA table index of the entry.
+ *
+ * \param[in]       generation is the generation to compare against.
+ *
+ * \return          TRUE if the entry was written after generation, or if
+ *                  the cache has no index.
+ *
+ *****************************************************************************/
+fm_bool fmAddrIndexChangedSince(fm_switch *switchPtr,
+                                fm_uint32  index,
+                                fm_uint64  generation)
+{
+
+    if (switchPtr->maIndex == NULL)
+    {
+        return TRUE;
+    }
+
+    return (switchPtr->maIndex->links[index].generation > generation);
+
+}   /* end fmAddrIndexChangedSince */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrIndexReadEntry
+ * \ingroup intAddr
+ *
+ * \desc            Copies a valid MA table cache entry without taking the
+ *                  L2 lock. Writers unlink an entry before overwriting it
+ *                  and give it a new generation when they link it again,
+ *                  so a copy taken while the entry stayed linked with the
+ *                  same generation is consistent.
+ *                                                                      \lb\lb
+ *                  Fields updated in place while the entry stays linked,
+ *                  such as its aging state, may be read before or after
+ *                  the update.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \param[in]       index is the MA table index of the entry.
+ *
+ * \param[out]      entry points to caller-allocated storage where the
+ *                  copy is written.
+ *
+ * \return          TRUE if a consistent copy of a valid entry was made.
+ * \return          FALSE if the entry is invalid, is being rewritten, or
+ *                  the cache has no index.
+ *
+ *****************************************************************************/
+fm_bool fmAddrIndexReadEntry(fm_switch *              switchPtr,
+                             fm_uint32                index,
+                             fm_internalMacAddrEntry *entry)
+{
+    fm_maIndexLink *link;
+    fm_uint64       generation;
+    fm_int          retry;
+
+    if (switchPtr->maIndex == NULL)
+    {
+        return FALSE;
+    }
+
+    link = &switchPtr->maIndex->links[index];
+
+    for (retry = 0 ; retry < SNAPSHOT_READ_RETRIES ; retry++)
+    {
+        generation = FM_ATOMIC_LOAD(&link->generation);
+
+        if ( !FM_ATOMIC_LOAD(&link->linked) )
+        {
+            return FALSE;
+        }
+
+        *entry = switchPtr->maTable[index];
+
+        FM_ATOMIC_FENCE();
+
+        if ( FM_ATOMIC_LOAD_RELAXED(&link->linked) &&
+             FM_ATOMIC_LOAD_RELAXED(&link->generation) == generation )
+        {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+
+}   /* end fmAddrIndexReadEntry */
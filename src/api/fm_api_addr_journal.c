@@ -0,0 +1,486 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_api_addr_journal.c
+ * Creation Date:   October 15, 2026
+ * Description:     Change journal of the MA table cache
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** FillRecord
+ * \ingroup intAddr
+ *
+ * \desc            Fills a journal record from a MA table cache entry.
+ *
+ * \param[out]      record points to the record to fill.
+ *
+ * \param[in]       entry points to the MA table cache entry.
+ *
+ * \param[in]       change is the kind of change (see
+ *                  ''fm_macJournalChange'').
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void FillRecord(fm_macJournalEntry *     record,
+                       fm_internalMacAddrEntry *entry,
+                       fm_int                   change)
+{
+
+    record->sequence   = 0;
+    record->change     = change;
+    record->macAddress = entry->macAddress;
+    record->vlanID     = entry->vlanID;
+    record->port       = entry->port;
+    record->type       = entry->addrType;
+
+}   /* end FillRecord */
+
+
+
+
+/*****************************************************************************/
+/** AppendRecord
+ * \ingroup intAddr
+ *
+ * \desc            Gives a record the next sequence number and writes it to
+ *                  the journal, dropping the oldest record if the journal
+ *                  is full.
+ *
+ * \param[in]       journal points to the journal.
+ *
+ * \param[in]       record points to the record to append.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void AppendRecord(fm_maJournal *journal, fm_macJournalEntry *record)
+{
+    fm_macJournalEntry *slot;
+
+    slot  = &journal->records[journal->nextSeq % (fm_uint64) journal->size];
+    *slot = *record;
+    slot->sequence = journal->nextSeq++;
+
+    if (journal->nextSeq - journal->oldestSeq > (fm_uint64) journal->size)
+    {
+        journal->oldestSeq = journal->nextSeq - (fm_uint64) journal->size;
+    }
+
+}   /* end AppendRecord */
+
+
+
+
+/*****************************************************************************/
+/** FlushPending
+ * \ingroup intAddr
+ *
+ * \desc            Appends the removal held back by the last unlink, if
+ *                  it was not followed by a link of the same entry.
+ *
+ * \param[in]       journal points to the journal.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void FlushPending(fm_maJournal *journal)
+{
+
+    if (journal->pendingValid)
+    {
+        AppendRecord(journal, &journal->pending);
+        journal->pendingValid = FALSE;
+    }
+
+}   /* end FlushPending */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** fmAllocAddrJournal
+ * \ingroup intAddr
+ *
+ * \desc            Allocates the change journal of the MA table cache,
+ *                  sized by the api.ma.journalSize property. The journal
+ *                  is fed by the index hooks, so it is left disabled when
+ *                  the cache has no index.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ *
+ *****************************************************************************/
+fm_status fmAllocAddrJournal(fm_switch *switchPtr)
+{
+    fm_maJournal *journal;
+    fm_int        size;
+
+    switchPtr->maJournal = NULL;
+
+    size = GET_PROPERTY()->maJournalSize;
+
+    if (size <= 0)
+    {
+        return FM_OK;
+    }
+
+    if (switchPtr->maIndex == NULL)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_ADDR,
+                       "MA table of switch %d is not indexed, "
+                       "change journal disabled\n",
+                       switchPtr->switchNumber);
+        return FM_OK;
+    }
+
+    journal = fmAllocTagged(sizeof(fm_maJournal), FM_LOG_CAT_ADDR);
+
+    if (journal == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    FM_CLEAR(*journal);
+
+    journal->records = fmAllocTagged(size * sizeof(fm_macJournalEntry),
+                                     FM_LOG_CAT_ADDR);
+
+    if (journal->records == NULL)
+    {
+        fmFree(journal);
+        return FM_ERR_NO_MEM;
+    }
+
+    journal->size      = size;
+    journal->nextSeq   = 1;
+    journal->oldestSeq = 1;
+
+    switchPtr->maJournal = journal;
+
+    return FM_OK;
+
+}   /* end fmAllocAddrJournal */
+
+
+
+
+/*****************************************************************************/
+/** fmFreeAddrJournal
+ * \ingroup intAddr
+ *
+ * \desc            Frees the change journal of the MA table cache.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmFreeAddrJournal(fm_switch *switchPtr)
+{
+    fm_maJournal *journal;
+
+    journal = switchPtr->maJournal;
+
+    if (journal == NULL)
+    {
+        return;
+    }
+
+    fmFree(journal->records);
+    fmFree(journal);
+
+    switchPtr->maJournal = NULL;
+
+}   /* end fmFreeAddrJournal */
+
+
+
+
+/*****************************************************************************/
+/** fmResetAddrJournal
+ * \ingroup intAddr
+ *
+ * \desc            Discards the journal when every entry of the cache is
+ *                  invalidated at once. A sequence number is consumed so
+ *                  that every reader gets FM_ERR_JOURNAL_OVERFLOW and
+ *                  resynchronizes from the table.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmResetAddrJournal(fm_switch *switchPtr)
+{
+    fm_maJournal *journal;
+
+    journal = switchPtr->maJournal;
+
+    if (journal == NULL)
+    {
+        return;
+    }
+
+    journal->pendingValid = FALSE;
+    journal->nextSeq++;
+    journal->oldestSeq = journal->nextSeq;
+
+}   /* end fmResetAddrJournal */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrJournalNoteLink
+ * \ingroup intAddr
+ *
+ * \desc            Records that a valid entry was written to the MA table
+ *                  cache. Called by the index once the entry is linked.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \param[in]       index is the MA table index of the entry.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmAddrJournalNoteLink(fm_switch *switchPtr, fm_uint32 index)
+{
+    fm_maJournal *           journal;
+    fm_internalMacAddrEntry *entry;
+    fm_macJournalEntry       record;
+    fm_int                   change;
+
+    journal = switchPtr->maJournal;
+
+    if (journal == NULL)
+    {
+        return;
+    }
+
+    entry  = &switchPtr->maTable[index];
+    change = FM_MAC_JOURNAL_ADDED;
+
+    if ( journal->pendingValid
+        && journal->pending.macAddress == entry->macAddress
+        && journal->pending.vlanID == entry->vlanID )
+    {
+        /* The entry was rewritten: one change, not a removal and an add. */
+        if (journal->pending.port != entry->port)
+        {
+            change = FM_MAC_JOURNAL_MOVED;
+        }
+
+        journal->pendingValid = FALSE;
+    }
+    else
+    {
+        FlushPending(journal);
+    }
+
+    FillRecord(&record, entry, change);
+    AppendRecord(journal, &record);
+
+}   /* end fmAddrJournalNoteLink */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrJournalNoteUnlink
+ * \ingroup intAddr
+ *
+ * \desc            Records that a valid entry is about to be removed from
+ *                  or rewritten in the MA table cache. The removal is held
+ *                  back until the next journal operation, so that a
+ *                  rewrite is recorded as a single change.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \param[in]       index is the MA table index of the entry.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmAddrJournalNoteUnlink(fm_switch *switchPtr, fm_uint32 index)
+{
+    fm_maJournal *           journal;
+    fm_internalMacAddrEntry *entry;
+
+    journal = switchPtr->maJournal;
+
+    if (journal == NULL)
+    {
+        return;
+    }
+
+    FlushPending(journal);
+
+    entry = &switchPtr->maTable[index];
+
+    FillRecord(&journal->pending,
+               entry,
+               (entry->state == FM_MAC_ENTRY_STATE_EXPIRED) ?
+                   FM_MAC_JOURNAL_AGED : FM_MAC_JOURNAL_DELETED);
+
+    journal->pendingValid = TRUE;
+
+}   /* end fmAddrJournalNoteUnlink */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrJournalGetSequence
+ * \ingroup intAddr
+ *
+ * \desc            Returns the sequence number of the last change recorded
+ *                  in the journal.
+ *
+ * \note            The caller is assumed to have taken the L2 lock and to
+ *                  have checked that the journal is enabled.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \return          The sequence number of the last change, 0 if none.
+ *
+ *****************************************************************************/
+fm_uint64 fmAddrJournalGetSequence(fm_switch *switchPtr)
+{
+
+    FlushPending(switchPtr->maJournal);
+
+    return switchPtr->maJournal->nextSeq - 1;
+
+}   /* end fmAddrJournalGetSequence */
+
+
+
+
+/*****************************************************************************/
+/** fmAddrJournalRead
+ * \ingroup intAddr
+ *
+ * \desc            Copies the changes recorded after a given sequence
+ *                  number, oldest first.
+ *
+ * \note            The caller is assumed to have taken the L2 lock and to
+ *                  have checked that the journal is enabled.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \param[in]       sinceSequence is the sequence number of the last change
+ *                  already read.
+ *
+ * \param[out]      nEntries points to caller-allocated storage where the
+ *                  number of changes copied is written.
+ *
+ * \param[out]      entries points to a caller-allocated array of
+ *                  maxEntries records.
+ *
+ * \param[in]       maxEntries is the size of entries.
+ *
+ * \return          FM_OK if successful, including when there is no new
+ *                  change.
+ * \return          FM_ERR_INVALID_ARGUMENT if sinceSequence was never
+ *                  issued.
+ * \return          FM_ERR_JOURNAL_OVERFLOW if changes following
+ *                  sinceSequence have been dropped.
+ *
+ *****************************************************************************/
+fm_status fmAddrJournalRead(fm_switch *         switchPtr,
+                            fm_uint64           sinceSequence,
+                            fm_int *            nEntries,
+                            fm_macJournalEntry *entries,
+                            fm_int              maxEntries)
+{
+    fm_maJournal *journal;
+    fm_uint64     seq;
+
+    journal   = switchPtr->maJournal;
+    *nEntries = 0;
+
+    FlushPending(journal);
+
+    if (sinceSequence >= journal->nextSeq)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    if (sinceSequence + 1 < journal->oldestSeq)
+    {
+        return FM_ERR_JOURNAL_OVERFLOW;
+    }
+
+    for (seq = sinceSequence + 1 ;
+         seq < journal->nextSeq && *nEntries < maxEntries ;
+         seq++)
+    {
+        entries[(*nEntries)++] =
+            journal->records[seq % (fm_uint64) journal->size];
+    }
+
+    return FM_OK;
+
+}   /* end fmAddrJournalRead */
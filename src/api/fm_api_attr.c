@@ -217,6 +217,11 @@ fm_status fmSetSwitchAttribute(fm_int sw, fm_int attr, void *value)
 
     FM_API_CALL_FAMILY(err, switchPtr->SetSwitchAttribute, sw, attr, value);
 
+    if (err == FM_OK)
+    {
+        FM_INVALIDATE_TX_DESTINATIONS(sw);
+    }
+
 ABORT:
 
     if (switchLocked)
@@ -37,6 +37,10 @@
  * Macros, Constants & Types
  *****************************************************************************/
 
+/* Number of buffers handed to the platform per bulk call when walking a
+ * chain */
+#define FM_BUFFER_BULK_BATCH    16
+
 
 /*****************************************************************************
  * Global Variables
@@ -204,6 +208,11 @@ fm_status fmFreeBuffer(int sw, fm_buffer *buf)
  * \desc            Return an entire chain of packet buffers, previously
  *                  allocated with calls to 'fmAllocateBuffer'', to the free
  *                  buffer pool.
+ *                                                                      \lb\lb
+ *                  If the chain has several owners (see
+ *                  ''fmRetainBufferChain''), only gives up the caller's
+ *                  ownership, and the chain is returned to the pool when
+ *                  its last owner frees it.
  *
  * \param[in]       sw is not used. This is a legacy argument for backward
  *                  compatibility with existing applications.
@@ -215,25 +224,36 @@ fm_status fmFreeBuffer(int sw, fm_buffer *buf)
  *****************************************************************************/
 fm_status fmFreeBufferChain(int sw, fm_buffer *bufChain)
 {
-    fm_buffer *nextBuffer;
+    fm_buffer *batch[FM_BUFFER_BULK_BATCH];
     fm_buffer *curBuffer;
     fm_status  status = FM_OK;
+    fm_int     numBuffers;
 
     FM_LOG_ENTRY_API(FM_LOG_CAT_BUFFER, "sw=%d\n", sw);
 
+    if ( (bufChain != NULL) && (FM_ATOMIC_SUB(&bufChain->refCount, 1) > 0) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_BUFFER, FM_OK);
+    }
+
     curBuffer = bufChain;
 
     while (curBuffer != NULL)
     {
-        nextBuffer = curBuffer->next;
-        status     = fmFreeBuffer(sw, curBuffer);
+        numBuffers = 0;
+
+        while ( (curBuffer != NULL) && (numBuffers < FM_BUFFER_BULK_BATCH) )
+        {
+            batch[numBuffers++] = curBuffer;
+            curBuffer           = curBuffer->next;
+        }
+
+        status = fmFreeBufferBulk(sw, numBuffers, batch);
 
         if (status != FM_OK)
         {
             break;
         }
-
-        curBuffer = nextBuffer;
     }
 
     FM_LOG_EXIT_API(FM_LOG_CAT_BUFFER, status);
@@ -243,6 +263,392 @@ fm_status fmFreeBufferChain(int sw, fm_buffer *bufChain)
 
 
 
+/*****************************************************************************/
+/** fmAllocateBufferBulk
+ * \ingroup buffer
+ *
+ * \desc            Allocate a number of packet buffers at once, all or none.
+ *                  Equivalent to numBuffers calls to ''fmAllocateBufferV2'',
+ *                  but the buffer pool is locked once per batch rather than
+ *                  once per buffer.
+ *
+ * \note            The buffers are returned unchained. See
+ *                  ''fmLinkBufferChain'' to chain them into a frame.
+ *
+ * \param[in]       sw is not used. This is a legacy argument for backward
+ *                  compatibility with existing applications.
+ *
+ * \param[in]       bufferType specifies whether the allocated buffers are
+ *                  for Send or Receive. Used to select the pool from which
+ *                  the buffers will be allocated.
+ *
+ * \param[in]       numBuffers is the number of buffers to allocate.
+ *
+ * \param[out]      bufs points to a caller-allocated array of numBuffers
+ *                  entries where the buffer pointers are written.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_NO_MEM if fewer than numBuffers buffers are
+ *                  available, in which case no buffer is allocated.
+ *
+ *****************************************************************************/
+fm_status fmAllocateBufferBulk(int            sw,
+                               fm_bufferType  bufferType,
+                               fm_int         numBuffers,
+                               fm_buffer    **bufs)
+{
+    fm_status err;
+
+    FM_NOT_USED(sw);
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_BUFFER,
+                     "sw=%d bufferType=%d numBuffers=%d bufs=%p\n",
+                     sw,
+                     bufferType,
+                     numBuffers,
+                     (void *) bufs);
+
+    err = fmPlatformAllocateBufferBulk(bufferType, numBuffers, bufs);
+
+    if (err == FM_ERR_NO_MEM)
+    {
+        fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_OUT_OF_BUFFERS, 1);
+    }
+    else if (err == FM_OK)
+    {
+        fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_BUFFER_ALLOCS, numBuffers);
+    }
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_BUFFER, err);
+
+}   /* end fmAllocateBufferBulk */
+
+
+
+
+/*****************************************************************************/
+/** fmFreeBufferBulk
+ * \ingroup buffer
+ *
+ * \desc            Return a number of packet buffers, previously allocated
+ *                  with ''fmAllocateBuffer'', ''fmAllocateBufferV2'' or
+ *                  ''fmAllocateBufferBulk'', to the free buffer pool at once.
+ *
+ * \note            Only the buffers in the array are freed; the other
+ *                  buffers of a chain are not. See ''fmFreeBufferChain'' for
+ *                  disposing of an entire chain.
+ *
+ * \param[in]       sw is not used. This is a legacy argument for backward
+ *                  compatibility with existing applications.
+ *
+ * \param[in]       numBuffers is the number of buffers in bufs.
+ *
+ * \param[in]       bufs points to an array of numBuffers buffer pointers.
+ *                  NULL entries are skipped.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid or one
+ *                  of the buffers was not allocated. The other buffers are
+ *                  still freed.
+ *
+ *****************************************************************************/
+fm_status fmFreeBufferBulk(int sw, fm_int numBuffers, fm_buffer **bufs)
+{
+    fm_status err;
+    fm_status semErr;
+    fm_int    numFreed;
+    fm_int    i;
+
+    FM_NOT_USED(sw);
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_BUFFER,
+                     "sw=%d numBuffers=%d bufs=%p\n",
+                     sw,
+                     numBuffers,
+                     (void *) bufs);
+
+    err = fmPlatformFreeBufferBulk(numBuffers, bufs);
+
+    if (err == FM_OK)
+    {
+        numFreed = 0;
+
+        for (i = 0 ; i < numBuffers ; i++)
+        {
+            if (bufs[i] != NULL)
+            {
+                numFreed++;
+            }
+        }
+
+        fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_BUFFER_FREES, numFreed);
+    }
+
+    if ( (numBuffers > 0) && (bufs != NULL) )
+    {
+        semErr = fmSignalSemaphore(&fmRootApi->waitForBufferSemaphore);
+
+        if (err == FM_OK)
+        {
+            err = semErr;
+        }
+    }
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_BUFFER, err);
+
+}   /* end fmFreeBufferBulk */
+
+
+
+
+/*****************************************************************************/
+/** fmLinkBufferChain
+ * \ingroup buffer
+ *
+ * \desc            Link an array of buffers, in order, into a chain. Used to
+ *                  assemble a frame from buffers allocated with
+ *                  ''fmAllocateBufferBulk'' without walking the chain once
+ *                  per buffer as ''fmAddBuffer'' does.
+ *
+ * \param[in]       numBuffers is the number of buffers in bufs.
+ *
+ * \param[in,out]   bufs points to an array of numBuffers buffer pointers.
+ *                  The next pointer of each buffer is set to the following
+ *                  entry, and that of the last buffer to NULL.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if numBuffers is not positive or
+ *                  bufs is NULL.
+ * \return          FM_ERR_BAD_BUFFER if an entry of bufs is NULL.
+ *
+ *****************************************************************************/
+fm_status fmLinkBufferChain(fm_int numBuffers, fm_buffer **bufs)
+{
+    fm_int i;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_BUFFER,
+                     "numBuffers=%d bufs=%p\n",
+                     numBuffers,
+                     (void *) bufs);
+
+    if ( (numBuffers <= 0) || (bufs == NULL) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_BUFFER, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    for (i = 0 ; i < numBuffers ; i++)
+    {
+        if (bufs[i] == NULL)
+        {
+            FM_LOG_EXIT_API(FM_LOG_CAT_BUFFER, FM_ERR_BAD_BUFFER);
+        }
+    }
+
+    for (i = 0 ; i < numBuffers - 1 ; i++)
+    {
+        bufs[i]->next = bufs[i + 1];
+    }
+
+    bufs[numBuffers - 1]->next = NULL;
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_BUFFER, FM_OK);
+
+}   /* end fmLinkBufferChain */
+
+
+
+
+/*****************************************************************************/
+/** fmAllocateBufferChain
+ * \ingroup buffer
+ *
+ * \desc            Allocate a chain of packet buffers large enough to hold
+ *                  a frame of the given length. The buffers are allocated in
+ *                  bulk and their lengths are set so that every buffer but
+ *                  the last is full, as required for a frame.
+ *
+ * \param[in]       sw is not used. This is a legacy argument for backward
+ *                  compatibility with existing applications.
+ *
+ * \param[in]       bufferType specifies whether the allocated buffers are
+ *                  for Send or Receive. Used to select the pool from which
+ *                  the buffers will be allocated.
+ *
+ * \param[in]       numBytes is the length of the frame in bytes.
+ *
+ * \return          Pointer to the first buffer in the new chain.
+ * \return          NULL if numBytes is not positive or the chain could not
+ *                  be allocated.
+ *
+ *****************************************************************************/
+fm_buffer *fmAllocateBufferChain(int sw, fm_bufferType bufferType, fm_int numBytes)
+{
+    fm_buffer *batch[FM_BUFFER_BULK_BATCH];
+    fm_buffer *chain;
+    fm_buffer *tail;
+    fm_status  err;
+    fm_int     bufferSize;
+    fm_int     numBuffers;
+    fm_int     i;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_BUFFER,
+                     "sw=%d bufferType=%d numBytes=%d\n",
+                     sw,
+                     bufferType,
+                     numBytes);
+
+    chain = NULL;
+    tail  = NULL;
+
+    bufferSize = fmPlatformGetBufferSize();
+
+    while (numBytes > 0)
+    {
+        numBuffers = (numBytes + bufferSize - 1) / bufferSize;
+
+        if (numBuffers > FM_BUFFER_BULK_BATCH)
+        {
+            numBuffers = FM_BUFFER_BULK_BATCH;
+        }
+
+        err = fmAllocateBufferBulk(sw, bufferType, numBuffers, batch);
+
+        if (err != FM_OK)
+        {
+            if (chain != NULL)
+            {
+                fmFreeBufferChain(sw, chain);
+                chain = NULL;
+            }
+
+            break;
+        }
+
+        for (i = 0 ; i < numBuffers ; i++)
+        {
+            batch[i]->len = (numBytes > bufferSize) ? bufferSize : numBytes;
+            numBytes     -= batch[i]->len;
+        }
+
+        fmLinkBufferChain(numBuffers, batch);
+
+        if (tail == NULL)
+        {
+            chain = batch[0];
+        }
+        else
+        {
+            tail->next = batch[0];
+        }
+
+        tail = batch[numBuffers - 1];
+    }
+
+    FM_LOG_EXIT_API_CUSTOM(FM_LOG_CAT_BUFFER,
+                           chain,
+                           "chain=%p\n",
+                           (void *) chain);
+
+}   /* end fmAllocateBufferChain */
+
+
+
+
+/*****************************************************************************/
+/** fmRetainBufferChain
+ * \ingroup buffer
+ *
+ * \desc            Add owners to a chain of packet buffers, so that it can
+ *                  be handed to several consumers without copying it. A
+ *                  newly allocated chain has a single owner. Each owner
+ *                  gives up the chain with ''fmReleaseBufferChain'', and the
+ *                  chain is freed when the last owner does.
+ *                                                                      \lb\lb
+ *                  An application sending the same frame in several calls
+ *                  to the packet send functions retains the chain once for
+ *                  each call beyond the first; the API releases it as each
+ *                  send completes.
+ *
+ * \note            The chain data must not be modified while it has more
+ *                  than one owner.
+ *
+ * \param[in]       bufChain points to the first buffer in the chain.
+ *
+ * \param[in]       count is the number of owners to add.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_BAD_BUFFER if bufChain is NULL.
+ * \return          FM_ERR_INVALID_ARGUMENT if count is not positive.
+ *
+ *****************************************************************************/
+fm_status fmRetainBufferChain(fm_buffer *bufChain, fm_int count)
+{
+    FM_LOG_ENTRY_API(FM_LOG_CAT_BUFFER,
+                     "bufChain=%p count=%d\n",
+                     (void *) bufChain,
+                     count);
+
+    if (bufChain == NULL)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_BUFFER, FM_ERR_BAD_BUFFER);
+    }
+
+    if (count <= 0)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_BUFFER, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    FM_ATOMIC_ADD(&bufChain->refCount, count);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_BUFFER, FM_OK);
+
+}   /* end fmRetainBufferChain */
+
+
+
+
+/*****************************************************************************/
+/** fmReleaseBufferChain
+ * \ingroup buffer
+ *
+ * \desc            Give up one ownership of a chain of packet buffers, and
+ *                  return the entire chain to the free buffer pool if it was
+ *                  the last one. See ''fmRetainBufferChain''. Equivalent to
+ *                  ''fmFreeBufferChain''.
+ *
+ * \param[in]       sw is not used. This is a legacy argument for backward
+ *                  compatibility with existing applications.
+ *
+ * \param[in]       bufChain points to the first buffer in the chain.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_BAD_BUFFER if bufChain is NULL.
+ *
+ *****************************************************************************/
+fm_status fmReleaseBufferChain(int sw, fm_buffer *bufChain)
+{
+    fm_status status = FM_OK;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_BUFFER,
+                     "sw=%d bufChain=%p\n",
+                     sw,
+                     (void *) bufChain);
+
+    if (bufChain == NULL)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_BUFFER, FM_ERR_BAD_BUFFER);
+    }
+
+    status = fmFreeBufferChain(sw, bufChain);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_BUFFER, status);
+
+}   /* end fmReleaseBufferChain */
+
+
+
+
 /*****************************************************************************/
 /** fmGetBufferDataPtr
  * \ingroup buffer
@@ -49,6 +49,51 @@
 #endif
 
 
+/*---------------------------------------------------------------------------*/
+/*                               Local Functions                             */
+/*---------------------------------------------------------------------------*/
+
+
+/*****************************************************************************/
+/** GetCardinalIndex
+ * \ingroup intSwitch
+ *
+ * \desc            Returns the cardinal port index of a logical port, for
+ *                  use with the per-cardinal-port state tables.
+ *
+ * \param[in]       cardinalPortInfo points to the cardinal port information.
+ *
+ * \param[in]       port is the logical port number.
+ *
+ * \return          The cardinal port index, or -1 if the port is not a
+ *                  cardinal port or its index is beyond the port mask.
+ *
+ *****************************************************************************/
+static fm_int GetCardinalIndex(fm_cardinalPortInfo * cardinalPortInfo,
+                               fm_int                port)
+{
+    fm_int cpi;
+
+    if (cardinalPortInfo->indexTable == NULL ||
+        port < 0 ||
+        port > cardinalPortInfo->maxLogicalPort)
+    {
+        return -1;
+    }
+
+    cpi = cardinalPortInfo->indexTable[port];
+    if (cpi < 0 || cpi >= FM_PORTMASK_NUM_BITS)
+    {
+        return -1;
+    }
+
+    return cpi;
+
+}   /* end GetCardinalIndex */
+
+
+
+
 /*---------------------------------------------------------------------------*/
 /*                              Internal Functions                           */
 /*---------------------------------------------------------------------------*/
@@ -118,7 +163,9 @@ fm_status fmAllocCardinalPortMap(fm_switch * switchPtr)
 /** fmCreateCardinalPortIndexTable
  * \ingroup intSwitch
  *
- * \desc            Creates the cardinal port index table.
+ * \desc            Creates the cardinal port index table, along with the
+ *                  physical port index table used for port mask
+ *                  conversions.
  *
  * \param[in]       switchPtr is the switch on which to operate.
  *
@@ -130,6 +177,7 @@ fm_status fmCreateCardinalPortIndexTable(fm_switch * switchPtr)
     fm_cardinalPortInfo * cardinalPortInfo;
     fm_int      nbytes;
     fm_int      logPort;
+    fm_int      physPort;
     fm_int      cpi;
 
     FM_LOG_ENTRY(FM_LOG_CAT_SWITCH,
@@ -151,10 +199,30 @@ fm_status fmCreateCardinalPortIndexTable(fm_switch * switchPtr)
 
     memset(cardinalPortInfo->indexTable, -1, nbytes);
 
+    memset(cardinalPortInfo->physIndexTable,
+           -1,
+           sizeof(cardinalPortInfo->physIndexTable));
+
+    cardinalPortInfo->identityMap = TRUE;
+    FM_PORTMASK_DISABLE_ALL(&cardinalPortInfo->linkUpMask);
+    FM_CLEAR(cardinalPortInfo->portFlags);
+
     for (cpi = 0 ; cpi < switchPtr->numCardinalPorts ; cpi++)
     {
-        logPort = cardinalPortInfo->portMap[cpi].logPort;
+        logPort  = cardinalPortInfo->portMap[cpi].logPort;
+        physPort = cardinalPortInfo->portMap[cpi].physPort;
+
         cardinalPortInfo->indexTable[logPort] = cpi;
+
+        if (physPort >= 0 && physPort < FM_PORTMASK_NUM_BITS)
+        {
+            cardinalPortInfo->physIndexTable[physPort] = cpi;
+        }
+
+        if (physPort != cpi)
+        {
+            cardinalPortInfo->identityMap = FALSE;
+        }
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_OK);
@@ -264,6 +332,10 @@ fm_status fmFreeCardinalPortDataStructures(fm_switch * switchPtr)
         switchPtr->cardinalPortInfo.indexTable = NULL;
     }
 
+    FM_PORTMASK_DISABLE_ALL(&switchPtr->cardinalPortInfo.linkUpMask);
+    FM_PORTMASK_DISABLE_ALL(&switchPtr->cardinalPortInfo.pendingMaskUpdate);
+    FM_CLEAR(switchPtr->cardinalPortInfo.portFlags);
+
     return FM_OK;
 
 }   /* end fmFreeCardinalPortDataStructures */
@@ -271,6 +343,130 @@ fm_status fmFreeCardinalPortDataStructures(fm_switch * switchPtr)
 
 
 
+/*****************************************************************************/
+/** fmUpdateCardinalPortState
+ * \ingroup intSwitch
+ *
+ * \desc            Refreshes a port's bit in the cached link-up mask and its
+ *                  fast-path state flags from its fm_port structure. Must
+ *                  be called whenever the linkUp, mode or isPortForceUp
+ *                  field of a cardinal port is modified.
+ *
+ * \note            Non-cardinal ports are silently ignored.
+ *
+ * \param[in]       switchPtr is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port number.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmUpdateCardinalPortState(fm_switch * switchPtr, fm_int port)
+{
+    fm_cardinalPortInfo * cardinalPortInfo;
+    fm_port *             portPtr;
+    fm_byte *             flags;
+    fm_int                cpi;
+
+    cardinalPortInfo = &switchPtr->cardinalPortInfo;
+
+    cpi = GetCardinalIndex(cardinalPortInfo, port);
+    if (cpi < 0)
+    {
+        return;
+    }
+
+    portPtr = switchPtr->portTable[port];
+    flags   = &cardinalPortInfo->portFlags[cpi];
+
+    /* The draining flag is owned by fmSetCardinalPortFlag. */
+    *flags &= FM_CARDINAL_PORT_DRAINING;
+
+    if (portPtr != NULL)
+    {
+        if (portPtr->linkUp)
+        {
+            *flags |= FM_CARDINAL_PORT_LINK_UP;
+        }
+
+        if (portPtr->mode == FM_PORT_STATE_ADMIN_DOWN)
+        {
+            *flags |= FM_CARDINAL_PORT_ADMIN_DOWN;
+        }
+
+        if (portPtr->isPortForceUp)
+        {
+            *flags |= FM_CARDINAL_PORT_FORCE_UP;
+        }
+    }
+
+    /* MGMT ports are always available to send to */
+    if ( (portPtr != NULL && portPtr->linkUp) ||
+         fmIsMgmtPort(switchPtr->switchNumber, port) )
+    {
+        FM_PORTMASK_ENABLE_BIT(&cardinalPortInfo->linkUpMask, cpi);
+    }
+    else
+    {
+        FM_PORTMASK_DISABLE_BIT(&cardinalPortInfo->linkUpMask, cpi);
+    }
+
+}   /* end fmUpdateCardinalPortState */
+
+
+
+
+/*****************************************************************************/
+/** fmSetCardinalPortFlag
+ * \ingroup intSwitch
+ *
+ * \desc            Sets or clears a fast-path state flag that does not
+ *                  mirror a generic fm_port field, such as
+ *                  FM_CARDINAL_PORT_DRAINING.
+ *
+ * \note            Non-cardinal ports are silently ignored.
+ *
+ * \param[in]       switchPtr is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port number.
+ *
+ * \param[in]       flag is the FM_CARDINAL_PORT_xxx flag to change.
+ *
+ * \param[in]       enable is TRUE to set the flag, FALSE to clear it.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmSetCardinalPortFlag(fm_switch * switchPtr,
+                           fm_int      port,
+                           fm_byte     flag,
+                           fm_bool     enable)
+{
+    fm_cardinalPortInfo * cardinalPortInfo;
+    fm_int                cpi;
+
+    cardinalPortInfo = &switchPtr->cardinalPortInfo;
+
+    cpi = GetCardinalIndex(cardinalPortInfo, port);
+    if (cpi < 0)
+    {
+        return;
+    }
+
+    if (enable)
+    {
+        cardinalPortInfo->portFlags[cpi] |= flag;
+    }
+    else
+    {
+        cardinalPortInfo->portFlags[cpi] &= ~flag;
+    }
+
+}   /* end fmSetCardinalPortFlag */
+
+
+
+
 /*****************************************************************************/
 /** fmCompareCardinalPorts
  * \ingroup intSwitch
@@ -85,6 +85,7 @@ void *fmFastMaintenanceTask(void *args)
 #endif
     fm_int       msecCount = 1000;  /* Trigger remote refresh on first run */
     fm_bool      checkRemoteRefresh;
+    fm_status    err;
 
     /* grab arguments */
     thread       = FM_GET_THREAD_HANDLE(args);
@@ -208,6 +209,22 @@ void *fmFastMaintenanceTask(void *args)
                 switchPtr->FastMaintenanceTask(sw, args);
             }
 
+            /* Apply HNI flooding group changes whose coalescing window
+             * has passed. */
+            if (switchPtr &&
+                switchPtr->state == FM_SWITCH_STATE_UP &&
+                GET_PROPERTY()->hniMcastFlooding)
+            {
+                err = fmFlushMcastHNIFloodingGroups(sw);
+                if (err != FM_OK)
+                {
+                    FM_LOG_ERROR(FM_LOG_CAT_EVENT_FAST_MAINT,
+                                 "HNI flooding group update returned "
+                                 "error: %s\n",
+                                 fmErrorMsg(err));
+                }
+            }
+
             UNPROTECT_SWITCH(sw);
 
         }   /* end for (sw = FM_FIRST_FOCALPOINT ; sw <= FM_LAST_FOCALPOINT ; sw++) */
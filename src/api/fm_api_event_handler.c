@@ -46,6 +46,114 @@
     fmDelay( (fm_int) ( (x) / NANOS_PER_SECOND ), \
             (fm_int) ( (x) % NANOS_PER_SECOND ) )
 
+/* Longest a link event burst may defer the source port mask updates
+ * (see ApplyPortMaskUpdates) */
+#define PORT_MASK_COALESCE_NANOS  FM_LITERAL_U64(1000000)  /* 1 millisecond */
+
+/* Number of local dispatch threads events can be staged for at once */
+#define MAX_PENDING_DELIVERIES  8
+
+/* How long the local dispatch thread waits for a polling process to drain
+ * its events before signalling it again */
+#define EVENT_DRAIN_TIMEOUT_SEC 1
+
+/* Events staged by fmDistributeEvent for a local dispatch thread */
+typedef struct _fm_pendingDelivery
+{
+    /* thread the events are for */
+    fm_thread *thread;
+
+    /* number of valid entries in events */
+    fm_int     count;
+
+    /* the staged events, in order */
+    fm_event * events[FM_EVENT_BATCH_SIZE];
+
+} fm_pendingDelivery;
+
+/* Events waiting to be dispatched by the global event handler in one
+ * dispatch class, as a ring in arrival order. Every event comes from the
+ * event pool, so a ring of FM_MAX_EVENTS entries cannot overflow. */
+typedef struct _fm_dispatchQueue
+{
+    /* index of the oldest event in events */
+    fm_int     head;
+
+    /* number of events in the ring */
+    fm_int     count;
+
+    /* the events */
+    fm_event * events[FM_MAX_EVENTS];
+
+} fm_dispatchQueue;
+
+/* Dispatch state of the event being handled by the global event handler */
+typedef struct _fm_globalEventCtx
+{
+    /* switch of the event */
+    fm_int                sw;
+
+    /* state of the switch, or NULL if it does not exist yet */
+    fm_switch *           switchPtr;
+
+    /* whether the switch is protected by the global event handler */
+    fm_bool               switchIsProtected;
+
+    /* FALSE for logical switches such as switch aggregates */
+    fm_bool               isPhysicalSwitch;
+
+    /* switch-specific event handler overriding the distribution */
+    fm_switchEventHandler eventHandler;
+
+} fm_globalEventCtx;
+
+/* Handles an event in the global event handler before it is distributed.
+ * Returns TRUE if the event is to be distributed. */
+typedef fm_bool (*fm_globalEventHandler)(fm_globalEventCtx *ctx,
+                                         fm_event *         event);
+
+/* Merges the next event of the same type and switch into an event about
+ * to be distributed. Returns TRUE if the next event was consumed. */
+typedef fm_bool (*fm_globalEventMerge)(fm_globalEventCtx *ctx,
+                                       fm_event *         event,
+                                       fm_event *         next);
+
+/* Releases what an event holds when it is discarded because its switch
+ * is not up */
+typedef void (*fm_globalEventDiscard)(fm_int sw, fm_event *event);
+
+/* Entry of the global event handler table, indexed by the bit number of
+ * the event type */
+typedef struct _fm_globalEventType
+{
+    /* handler of the event type, NULL for unknown types */
+    fm_globalEventHandler handler;
+
+    /* merges following events of the type, or NULL */
+    fm_globalEventMerge   merge;
+
+    /* releases a discarded event, or NULL */
+    fm_globalEventDiscard discard;
+
+    /* whether the event is handled while its switch is not up */
+    fm_bool               whileDown;
+
+    /* whether the event is handled before its switch exists */
+    fm_bool               withoutSwitch;
+
+    /* statistics, only written by the global event handler thread */
+    fm_uint64             numEvents;
+    fm_uint64             numMerged;
+    fm_uint64             numDistributed;
+    fm_uint64             numDiscarded;
+    fm_uint64             totalTime;
+    fm_uint64             maxTime;
+
+} fm_globalEventType;
+
+/* Number of entries of the global event handler table */
+#define NUM_GLOBAL_EVENT_TYPES  32
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -60,6 +168,51 @@ fm_bool localDispatchThreadExit = FALSE;
  *****************************************************************************/
 static fm_bool enableFramePriority = FALSE;
 
+/* Staged local deliveries, only used by the global event handler thread */
+static fm_pendingDelivery pendingDelivery[MAX_PENDING_DELIVERIES];
+static fm_int             numPendingDeliveries = 0;
+
+/* The local dispatch thread of the process, process-local */
+static fm_thread *        localDispatchThread = NULL;
+
+/* Signalled instead of reporting events once polling, or -1 */
+static fm_int             eventNotifyFd = -1;
+
+/* Signalled by fmGetEventBatch when it empties the event queue */
+static fm_semaphore       eventDrainedSem;
+
+/* Events sorted by dispatch class, only used by the global event handler
+ * thread */
+static fm_dispatchQueue   dispatchQueue[FM_EVENT_DISPATCH_MAX];
+static fm_int             numDispatchEvents = 0;
+
+/* Class currently served by the weighted round robin and the number of
+ * events it may still dispatch in its turn */
+static fm_int             dispatchClass   = FM_EVENT_DISPATCH_LINK + 1;
+static fm_int             dispatchCredits = 0;
+
+/* Number of events each class other than port events dispatches in its
+ * turn of the weighted round robin */
+static const fm_int       dispatchWeight[FM_EVENT_DISPATCH_MAX] =
+{
+    0,      /* FM_EVENT_DISPATCH_LINK, always served first */
+    8,      /* FM_EVENT_DISPATCH_MAILBOX */
+    4,      /* FM_EVENT_DISPATCH_TABLE_UPDATE */
+    4,      /* FM_EVENT_DISPATCH_PACKET */
+    2,      /* FM_EVENT_DISPATCH_OTHER */
+};
+
+/* Global event handler table, indexed by the bit number of the event type */
+static fm_globalEventType globalEventTypes[NUM_GLOBAL_EVENT_TYPES];
+
+/* Packet queues the received packets of the process are steered to, see
+ * fmSetPacketQueueCount. numPacketQueues is 0 until they are created, and
+ * -1 while they are being created. Process-local. */
+static fm_int             numPacketQueues = 0;
+static fm_eventQueue      packetQueues[FM_MAX_PACKET_QUEUES];
+static fm_int             packetQueueFds[FM_MAX_PACKET_QUEUES];
+static fm_uint64          packetQueueDrops[FM_MAX_PACKET_QUEUES];
+
 /*****************************************************************************
  * Local function prototypes.
  *****************************************************************************/
@@ -70,933 +223,2951 @@ static fm_bool enableFramePriority = FALSE;
  *****************************************************************************/
 
 
-/*****************************************************************************
- * Public Functions
+/*****************************************************************************/
+/** SortDispatchEvents
+ * \ingroup intSwitch
+ *
+ * \desc            Moves events into the queue of their dispatch class.
+ *
+ * \param[in]       numEvents is the number of entries in events.
+ *
+ * \param[in]       events points to the events, in arrival order.
+ *
+ * \return          Nothing.
+ *
  *****************************************************************************/
+static void SortDispatchEvents(fm_int numEvents, fm_event **events)
+{
+    fm_dispatchQueue *queue;
+    fm_int            i;
+
+    for (i = 0 ; i < numEvents ; i++)
+    {
+        queue = &dispatchQueue[fmGetEventDispatchClass(events[i]->type)];
+
+        queue->events[(queue->head + queue->count) % FM_MAX_EVENTS] =
+            events[i];
+        queue->count++;
+    }
+
+    numDispatchEvents += numEvents;
+
+}   /* end SortDispatchEvents */
+
+
 
 
 /*****************************************************************************/
-/** fmDistributeEvent
+/** SortPostedEvents
  * \ingroup intSwitch
  *
- * \desc            distributes events to those processes that have registered
- *                  an interest in the particular event.
+ * \desc            Moves the events posted to the global event handler's
+ *                  thread into the queues of their dispatch class, without
+ *                  blocking.
  *
- * \param[in]       event points to the event structure.
+ * \param[in]       thread points to the global event handler's thread.
  *
  * \return          Nothing.
  *
  *****************************************************************************/
-void fmDistributeEvent(fm_event *event)
+static void SortPostedEvents(fm_thread *thread)
 {
-    fmCaptureLock(&fmRootApi->localDeliveryLock, FM_WAIT_FOREVER);
+    fm_event *events[FM_EVENT_BATCH_SIZE];
+    fm_int    numEvents;
 
+    do
     {
-        /**************************************************
-         * We want to have a consistent snapshot of the
-         * local delivery list, but we don't want to hold
-         * the lock while we deliver all the events, so we
-         * briefly grab the lock and copy the list into a
-         * C99 variable-size array.
-         **************************************************/
+        numEvents = 0;
 
-        fm_uint          count = fmRootApi->localDeliveryCount;
-        fm_localDelivery delivery[count];
-        fm_dlist_node *  node;
-        fm_uint          i;
-        fm_uint          pktDeliveryCount = 0;
-        fm_eventPktRecv *rcvPktEvent = NULL;
-        fm_status        status;
-        fm_buffer        *buffer;
+        fmEventQueueGetMultiple(&thread->events,
+                                FM_EVENT_BATCH_SIZE,
+                                events,
+                                &numEvents);
 
-        node = FM_DLL_GET_FIRST( (&fmRootApi->localDeliveryThreads), head );
+        SortDispatchEvents(numEvents, events);
+    }
+    while (numEvents == FM_EVENT_BATCH_SIZE);
 
-        for (i = 0 ; (node != NULL) && (i < count) ; i++)
-        {
-            delivery[i] = *(fm_localDelivery *) node->data;
+}   /* end SortPostedEvents */
 
-            if ( (delivery[i].mask & 
-                  (FM_EVENT_PKT_RECV | FM_EVENT_SFLOW_PKT_RECV)) &
-                  event->type )
-            {
-                /* Found thread we need to deliver packet to. */
-                pktDeliveryCount++;
-            }
 
-            node = FM_DLL_GET_NEXT(node, nextPtr);
-        }
 
-        /**************************************************
-         * If the event is packet receive but no one has
-         * registered for the event, free the associated
-         * packet buffer and return.
-         **************************************************/
 
-        if ( ( (event->type == FM_EVENT_PKT_RECV) ||
-               (event->type == FM_EVENT_SFLOW_PKT_RECV) ) 
-             && (pktDeliveryCount == 0) )
-        {
-            rcvPktEvent = &event->info.fpPktEvent;
-            if (enableFramePriority)
-            {
-                status = fmFreeBufferQueueNode(event->sw, rcvPktEvent);
-                if (status != FM_OK)
-                {
-                    FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
-                                 "Freeing Buffer queue node from the queue failed"
-                                 "status = %d (%s) \n",
-                                  status,
-                                  fmErrorMsg(status));
+/*****************************************************************************/
+/** GetDispatchEvent
+ * \ingroup intSwitch
+ *
+ * \desc            Called by the global event handler to get the next event
+ *                  to dispatch. Events posted to the thread are first sorted
+ *                  by dispatch class. Port events are then dispatched before
+ *                  any other, and the other classes take turns dispatching
+ *                  up to their weight in events, so that a flood of one
+ *                  class cannot hold back the others.
+ *
+ * \param[in]       thread points to the global event handler's thread.
+ *
+ * \param[out]      eventPtr points to where the event is returned.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_EVENTS_AVAILABLE if no event was received.
+ *
+ *****************************************************************************/
+static fm_status GetDispatchEvent(fm_thread *thread, fm_event **eventPtr)
+{
+    fm_event *        events[FM_EVENT_BATCH_SIZE];
+    fm_dispatchQueue *queue;
+    fm_status         err;
+    fm_int            numEvents;
+    fm_int            i;
 
-                }
-            }
-            fmFreeBufferChain(event->sw, rcvPktEvent->pkt);
-            fmDbgDiagCountIncr(event->sw, FM_CTR_RX_API_PKT_DROPS, 1);
-            fmReleaseLock(&fmRootApi->localDeliveryLock);
-            return;
+    /* Sort the events already posted, without blocking */
+    SortPostedEvents(thread);
+
+    if (numDispatchEvents == 0)
+    {
+        err = fmGetThreadEventBatch(thread,
+                                    FM_EVENT_BATCH_SIZE,
+                                    events,
+                                    &numEvents,
+                                    FM_WAIT_FOREVER);
+
+        if (err != FM_OK)
+        {
+            return err;
         }
 
-        /* valid actually found */
-        count = i;
-        fmReleaseLock(&fmRootApi->localDeliveryLock);
+        SortDispatchEvents(numEvents, events);
+    }
 
-        /**************************************************
-         * Now we do the actual delivery
-         **************************************************/
+    queue = &dispatchQueue[FM_EVENT_DISPATCH_LINK];
 
-        for (i = 0 ; i < count ; i++)
+    /* Visit each of the other classes at least once */
+    for (i = 0 ; (queue->count == 0) && (i < FM_EVENT_DISPATCH_MAX) ; i++)
+    {
+        if ( (dispatchCredits > 0) &&
+             (dispatchQueue[dispatchClass].count > 0) )
         {
-            fm_event *localEvent = NULL;
-            fm_uint64 nanos      = MIN_WAIT_NANOS;
-            fm_status err        = FM_FAIL;
-            fm_uint32 numUpdates;
-
-            if ( (delivery[i].mask & event->type) == 0 )
-            {
-                continue;
-            }
+            queue = &dispatchQueue[dispatchClass];
+            dispatchCredits--;
+            break;
+        }
 
-            /**************************************************
-             * Always use high priority for the locally dispatched
-             * events, because DistributeEvent is only called from
-             * a single thread (the global event handler), and if
-             * we allocated both low and high priority events here,
-             * we could get priority inversion.
-             **************************************************/
+        dispatchClass = (dispatchClass < FM_EVENT_DISPATCH_MAX - 1) ?
+                        dispatchClass + 1 :
+                        FM_EVENT_DISPATCH_LINK + 1;
+        dispatchCredits = dispatchWeight[dispatchClass];
+    }
 
-            while (localEvent == NULL)
-            {
-                localEvent = fmAllocateEvent(event->sw,
-                                             event->eventID,
-                                             event->type,
-                                             FM_EVENT_PRIORITY_HIGH);
+    if (queue->count == 0)
+    {
+        /* Should never happen */
+        return FM_ERR_NO_EVENTS_AVAILABLE;
+    }
 
-                if (localEvent == NULL)
-                {
-                    DELAY_NANOS(nanos);
-                    nanos *= 2;
-
-                    if (nanos > MAX_WAIT_NANOS)
-                    {
-                        nanos = MAX_WAIT_NANOS;
-                        FM_LOG_WARNING(FM_LOG_CAT_EVENT,
-                                       "Waiting to allocate event of type %d "
-                                       "for switch %d\n",
-                                       event->type,
-                                       event->sw);
-                    }
-                }
-            }
+    *eventPtr   = queue->events[queue->head];
+    queue->head = (queue->head + 1) % FM_MAX_EVENTS;
+    queue->count--;
+    numDispatchEvents--;
 
-            if (event->type == FM_EVENT_TABLE_UPDATE)
-            {
-                /**************************************************
-                 * Because the updates field is a pointer to memory
-                 * that has been "secretly" allocated after the event,
-                 * rather than just being part of the union, we have
-                 * to handle it specially.
-                 **************************************************/
+    return FM_OK;
 
-                numUpdates = event->info.fpUpdateEvent.numUpdates;
-                localEvent->info.fpUpdateEvent.numUpdates = numUpdates;
-                FM_MEMCPY_S( localEvent->info.fpUpdateEvent.updates,
-                             numUpdates * sizeof(fm_eventTableUpdate),
-                             event->info.fpUpdateEvent.updates,
-                             numUpdates * sizeof(fm_eventTableUpdate) );
-            }
-            else if (event->type == FM_EVENT_PURGE_SCAN_COMPLETE)
-            {
-                localEvent->info.purgeScanComplete = event->info.purgeScanComplete;
-            } 
-            else if ( (event->type == FM_EVENT_PKT_RECV) ||
-                      (event->type == FM_EVENT_SFLOW_PKT_RECV) )
-            {
-                rcvPktEvent = &event->info.fpPktEvent;
+}   /* end GetDispatchEvent */
 
-                /**************************************************
-                 * Copy the whole event, including the packet, to
-                 * localEvent. If this is not the last registered
-                 * client, we will overwrite the packet with a
-                 * clone.
-                 **************************************************/
 
-                localEvent->info = event->info;
 
-                /**************************************************
-                 * If there is more than one remaining process that is
-                 * interested in receive packet events, clone the
-                 * receive buffer for delivery.
-                 **************************************************/
 
-                if (pktDeliveryCount-- > 1)
-                {
-                    if (enableFramePriority)
-                    {
-                        FM_LOG_ERROR(FM_LOG_CAT_EVENT,
-                                     "Prioritization is supported only for the"
-                                     "first registered process. Subsequent "
-                                     "processes follow normal buffer allocation"
-                                     " without prioritization.\n");
-                    }
-                    localEvent->info.fpPktEvent.pkt =
-                        fmDuplicateBufferChain(event->sw, rcvPktEvent->pkt);
-
-                    if (localEvent->info.fpPktEvent.pkt == NULL)
-                    {
-                        /**************************************************
-                         * Couldn't copy the packet. Free the event so that
-                         * it is not lost and continue the loop.
-                         **************************************************/
-
-                        fmReleaseEvent(localEvent);
-                        fmDbgDiagCountIncr(event->sw, FM_CTR_RX_API_PKT_DROPS, 1);
-                        continue;
-                    }
+/*****************************************************************************/
+/** DiscardPacketEvent
+ * \ingroup intSwitch
+ *
+ * \desc            Frees the frame held by a packet receive event that is
+ *                  discarded because its switch is not up.
+ *
+ * \param[in]       sw is the switch of the event.
+ *
+ * \param[in]       event points to the event.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void DiscardPacketEvent(fm_int sw, fm_event *event)
+{
+    fm_eventPktRecv *rcvPktEvent;
+    fm_status        err;
 
-                }
+    /* Only dig into the event if the switch is valid */
+    if ( (sw < 0) || (sw >= fmRootPlatform->cfg.numSwitches) )
+    {
+        return;
+    }
 
-                if (enableFramePriority)
-                {
-                    buffer = ((fm_buffer *)(localEvent->info.fpPktEvent.pkt));
-                    buffer->recvEvent = localEvent;
-                }
-            }
-            else
-            {
-                /**************************************************
-                 * Otherwise, we can just copy the whole union
-                 * without worrying what type it is.
-                 **************************************************/
+    rcvPktEvent = &event->info.fpPktEvent;
 
-                localEvent->info = event->info;
-            }
+    if (enableFramePriority)
+    {
+        err = fmFreeBufferQueueNode(sw, rcvPktEvent);
+        if (err != FM_OK)
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
+                         "Freeing Buffer queue node from the queue failed"
+                         "status = %d (%s) \n",
+                          err,
+                          fmErrorMsg(err));
 
-            /**************************************************
-             * Now try to send the event to the local dispatch
-             * thread, using exponential backoff if the event
-             * queue is full.
-             **************************************************/
+        }
+    }
 
-            nanos = MIN_WAIT_NANOS;
+    fmFreeBufferChain(sw, rcvPktEvent->pkt);
+    fmDbgDiagCountIncr(sw, FM_CTR_RX_API_PKT_DROPS, 1);
 
-            while (err != FM_OK)
-            {
-                err = fmSendThreadEvent(delivery[i].thread, localEvent);
+}   /* end DiscardPacketEvent */
 
-                if (err != FM_OK)
-                {
-                    DELAY_NANOS(nanos);
-                    nanos *= 2;
 
-                    if (nanos > MAX_WAIT_NANOS)
-                    {
-                        nanos = MAX_WAIT_NANOS;
-                    }
 
-                }   /* end if (err != FM_OK) */
 
-            }   /* end while (err != FM_OK) */
+/*****************************************************************************/
+/** HandleSwitchInserted
+ * \ingroup intSwitch
+ *
+ * \desc            Global event handler for ''FM_EVENT_SWITCH_INSERTED''.
+ *
+ * \param[in,out]   ctx points to the dispatch state of the event.
+ *
+ * \param[in]       event points to the event.
+ *
+ * \return          TRUE if the event is to be distributed.
+ *
+ *****************************************************************************/
+static fm_bool HandleSwitchInserted(fm_globalEventCtx *ctx, fm_event *event)
+{
+    if (ctx->switchIsProtected)
+    {
+        UNPROTECT_SWITCH(ctx->sw);
+        ctx->switchIsProtected = FALSE;
+    }
 
-        }   /* end for (i = 0 ; i < count ; i++) */
+    if (ctx->switchPtr == NULL)
+    {
+        if (fmHandleSwitchInserted(ctx->sw,
+                                   &event->info.fpSwitchInsertedEvent) != FM_OK)
+        {
+            /* Don't generate an insert event if there error */
+            return FALSE;
+        }
+    }
 
-    }   /* end (local scope) */
+    return TRUE;
 
-}   /* end fmDistributeEvent */
+}   /* end HandleSwitchInserted */
 
 
 
 
 /*****************************************************************************/
-/** fmGlobalEventHandler
+/** HandleSwitchRemoved
  * \ingroup intSwitch
  *
- * \desc            event handler for handling system events
+ * \desc            Global event handler for ''FM_EVENT_SWITCH_REMOVED''.
  *
- * \param[in]       args points to the thread arguments
+ * \param[in,out]   ctx points to the dispatch state of the event.
  *
- * \return          Nothing.
+ * \param[in]       event points to the event.
+ *
+ * \return          TRUE if the event is to be distributed.
  *
  *****************************************************************************/
-void *fmGlobalEventHandler(void *args)
+static fm_bool HandleSwitchRemoved(fm_globalEventCtx *ctx, fm_event *event)
 {
-    fm_thread *               thread;
-    fm_event *                event;
-    fm_status                 err       = FM_OK;
-    fm_eventPort *            portEvent = NULL;
-    fm_eventTableUpdateBurst *updateEvent;
-    fm_int                    physPort;
-    fm_int                    logicalPort;
-    fm_eventPktRecv *         rcvPktEvent;
-    fm_eventSwitchInserted *  insertEvent;
-    fm_eventSwitchRemoved *   removeEvent;
-    fm_int                    sw = 0;
-    fm_bool                   discardEvent;
-    fm_port *                 portPtr = NULL;
-    fm_bool                   switchIsProtected;
-    fm_switch *               switchPtr;
-    fm_int                    mode;
-    fm_int                    info[8];
-    fm_int                    state;
-    fm_int                    numLanes;
-    fm_uint32                 i;
-    fm_bool                   isPhysicalSwitch;
-    fm_switchEventHandler     eventHandler;
-    fm_bool                   distributeEvent;
-    fm_eventTableUpdate *     fpUpdateEvent;
+    if (ctx->switchIsProtected)
+    {
+        UNPROTECT_SWITCH(ctx->sw);
+        ctx->switchIsProtected = FALSE;
+    }
 
-    /* grab arguments */
-    thread = FM_GET_THREAD_HANDLE(args);
+    if (ctx->switchPtr != NULL)
+    {
+        fmHandleSwitchRemoved(ctx->sw, &event->info.fpSwitchRemovedEvent);
+    }
 
-    /* wait for initialization to finish before processing events */
-    fmCaptureSemaphore(&fmRootApi->startGlobalEventHandler, FM_WAIT_FOREVER);
+    return TRUE;
 
-    enableFramePriority = GET_PROPERTY()->priorityBufQueues;
+}   /* end HandleSwitchRemoved */
 
-    while (1)
-    {
-        /* wait forever for an event */
-        err = fmGetThreadEvent(thread, &event, FM_WAIT_FOREVER);
 
-        if (err == FM_ERR_NO_EVENTS_AVAILABLE)
-        {
-            /* A timeout occurred - should never happen. */
-            continue;
-        }
 
-        if (event == NULL)
-        {
-            /* NULL event should never happen. */
-            continue;
-        }
 
-        sw                = event->sw;
-        discardEvent      = FALSE;
-        switchIsProtected = FALSE;
-        switchPtr         = NULL;
+/*****************************************************************************/
+/** ApplyPortMaskUpdates
+ * \ingroup intSwitch
+ *
+ * \desc            Applies the source port mask updates deferred by the
+ *                  link events of a switch. While more link events of the
+ *                  switch are waiting to be dispatched the updates are held
+ *                  back, for at most PORT_MASK_COALESCE_NANOS, so that a
+ *                  burst of link events costs one register update pass.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void ApplyPortMaskUpdates(fm_int sw)
+{
+    fm_dispatchQueue *queue;
+    fm_uint64         maxDelay;
+    fm_status         err;
+    fm_int            i;
 
-        if (sw < 0 || sw >= fmRootPlatform->cfg.numSwitches)
-        {
-            discardEvent      = TRUE;
-            switchIsProtected = FALSE;
-        }
-        else if ( SWITCH_LOCK_EXISTS(sw) )
-        {
-            if ( ( err = PROTECT_SWITCH(sw) ) != FM_OK )
-            {
-                discardEvent      = TRUE;
-                switchIsProtected = FALSE;
-            }
-            else
-            {
-                switchIsProtected = TRUE;
-                switchPtr         = fmRootApi->fmSwitchStateTable[sw];
+    queue    = &dispatchQueue[FM_EVENT_DISPATCH_LINK];
+    maxDelay = 0;
 
-                if (!fmRootApi->fmSwitchStateTable[sw])
-                {
-                    if ((event->type != FM_EVENT_SWITCH_REMOVED) &&
-                        (event->type != FM_EVENT_SWITCH_INSERTED) )
-                    {
-                        discardEvent = TRUE;
-                    }
-                }
-                else if (fmRootApi->fmSwitchStateTable[sw]->state != FM_SWITCH_STATE_UP)
-                {
-                    if ((event->type != FM_EVENT_SWITCH_REMOVED) &&
-                        (event->type != FM_EVENT_SWITCH_INSERTED) )
-                    {
-                        discardEvent = TRUE;
-                    }
-                }
-            }
-        }
-        else if (event->type != FM_EVENT_SWITCH_INSERTED)
+    for (i = 0 ; i < queue->count ; i++)
+    {
+        if (queue->events[(queue->head + i) % FM_MAX_EVENTS]->sw == sw)
         {
-            discardEvent = TRUE;
+            maxDelay = PORT_MASK_COALESCE_NANOS;
+            break;
         }
+    }
 
+    err = fmFlushSwitchPortMaskUpdates(sw, maxDelay);
 
-        if (discardEvent)
-        {
-            switch (event->type)
-            {
-                case FM_EVENT_PKT_RECV:
-                case FM_EVENT_SFLOW_PKT_RECV:
-                    /* Only dig into the event if the switch is valid */
-                    if  ( (sw >= 0) && (sw < fmRootPlatform->cfg.numSwitches) )
-                    {
-                        rcvPktEvent = &event->info.fpPktEvent;
-                        if (enableFramePriority)
-                        {
-                            err = fmFreeBufferQueueNode(sw, rcvPktEvent);
-                            if (err != FM_OK)
-                            {
-                                FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
-                                             "Freeing Buffer queue node from the queue failed"
-                                             "status = %d (%s) \n",
-                                              err,
-                                              fmErrorMsg(err));
-
-                            }
-                        }
-                        fmFreeBufferChain(sw, rcvPktEvent->pkt);
-                        fmDbgDiagCountIncr(sw, FM_CTR_RX_API_PKT_DROPS, 1);
-                    }
-                    break;
-
-                default:
-                    break;
-            }
+    if (err != FM_OK)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_EVENT_PORT,
+                       "Unable to update port masks: %s\n",
+                       fmErrorMsg(err));
+    }
 
-            goto FINISHED;
-        }
+}   /* end ApplyPortMaskUpdates */
 
-        eventHandler     = NULL;
 
-        if (switchPtr != NULL)
+
+
+/*****************************************************************************/
+/** HandlePortEvent
+ * \ingroup intSwitch
+ *
+ * \desc            Global event handler for ''FM_EVENT_PORT''. Updates the
+ *                  MA Table, LAGs, LBGs, port masks and mirror groups on
+ *                  a link state change of a physical switch port, and
+ *                  notifies the platform.
+ *
+ * \param[in,out]   ctx points to the dispatch state of the event.
+ *
+ * \param[in]       event points to the event.
+ *
+ * \return          TRUE if the event is to be distributed.
+ *
+ *****************************************************************************/
+static fm_bool HandlePortEvent(fm_globalEventCtx *ctx, fm_event *event)
+{
+    fm_eventPort *portEvent;
+    fm_switch *   switchPtr;
+    fm_port *     portPtr;
+    fm_status     err;
+    fm_int        sw;
+    fm_int        physPort = 0;
+    fm_int        logicalPort;
+    fm_int        mode;
+    fm_int        info[8];
+    fm_int        state;
+    fm_int        numLanes;
+
+    sw        = ctx->sw;
+    switchPtr = ctx->switchPtr;
+    portEvent = &event->info.fpPortEvent;
+
+    if ( !ctx->isPhysicalSwitch || !portEvent->activeMac )
+    {
+        /* Do not leave the updates of a burst ending here pending */
+        if ( ctx->isPhysicalSwitch && (switchPtr != NULL) )
+        {
+            ApplyPortMaskUpdates(sw);
+        }
+
+        return TRUE;
+    }
+
+    logicalPort = portEvent->port;
+
+    if (switchPtr != NULL)
+    {
+        fmMapLogicalPortToPhysical(switchPtr,
+                                   logicalPort,
+                                   &physPort);
+
+        portPtr = switchPtr->portTable[logicalPort];
+    }
+    else
+    {
+        portPtr = NULL;
+    }
+
+    if (portPtr == NULL)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_EVENT_PORT,
+                     "Unexpected NULL port pointer for logical"
+                     " port %d\n",
+                     logicalPort);
+
+        if (switchPtr != NULL)
+        {
+            ApplyPortMaskUpdates(sw);
+        }
+
+        return FALSE;
+    }
+
+    /* This attribute indicate whether the API should flush
+     * all the addresses on a port down event or not. */
+    if (GET_PROPERTY()->maFlushOnPortDown)
+    {
+        /* If a link goes down for a non-LAG port, remove any
+         * addresses associated with the port from the MA Table. */
+        if (portEvent->linkStatus == FM_PORT_STATUS_LINK_DOWN)
+        {
+            if (portPtr->portType != FM_PORT_TYPE_LAG)
+            {
+                err = fmFlushPortAddresses(sw, portEvent->port);
+
+                if (err != FM_OK)
+                {
+                    FM_LOG_WARNING(FM_LOG_CAT_EVENT_PORT,
+                                   "%s\n",
+                                   fmErrorMsg(err));
+                }
+            }
+        }
+    }
+
+    FM_LOG_DEBUG( FM_LOG_CAT_EVENT_PORT,
+                  "Port %s event reported on port %d.\n",
+                  (portPtr->linkUp) ? "UP  " : "DOWN",
+                  portEvent->port );
+
+    /* inform LAG module of port state changes */
+    if (portEvent->linkStatus == FM_PORT_STATUS_LINK_UP)
+    {
+        fmInformLAGPortUp(sw, portEvent->port);
+        
+        /* Inform LBGs of port link state change. */
+        FM_API_CALL_FAMILY_VOID(switchPtr->InformLBGLinkChange,
+                                sw, 
+                                portEvent->port, 
+                                FM_PORT_STATUS_LINK_UP);
+    }
+    else if (portEvent->linkStatus == FM_PORT_STATUS_LINK_DOWN)
+    {
+        fmInformLAGPortDown(sw, portEvent->port);
+        
+        /* Inform LBGs of port link state change. */
+        FM_API_CALL_FAMILY_VOID(switchPtr->InformLBGLinkChange,
+                                sw, 
+                                portEvent->port, 
+                                FM_PORT_STATUS_LINK_DOWN);
+    }
+
+    /* now update the source masks that depend on this port, merging the
+     * updates of a burst of link events into one pass */
+    err = fmDeferSwitchPortMaskUpdate(sw, logicalPort);
+
+    if (err == FM_OK)
+    {
+        ApplyPortMaskUpdates(sw);
+    }
+    else
+    {
+        fmUpdateSwitchPortMasks(sw);
+    }
+
+    if (switchPtr->UpdateRemoveDownPortsTrigger != NULL)
+    {
+        /**************************************************** 
+         * Update the switchExt->removeDownPortsTrigger
+         * used to drop routed/multicast/special delivery 
+         * frames which can not be handled by the PORT_CFG_2. 
+         * See Bugzilla 11387.
+         ***************************************************/
+        if (portEvent->linkStatus == FM_PORT_STATUS_LINK_UP)
+        {
+            switchPtr->UpdateRemoveDownPortsTrigger(sw, 
+                                                    physPort,
+                                                    FALSE);
+        }
+        else if (portEvent->linkStatus == FM_PORT_STATUS_LINK_DOWN)
+        {
+            if (!portPtr->isPortForceUp)
+            {
+                switchPtr->UpdateRemoveDownPortsTrigger(sw, 
+                                                        physPort,
+                                                        TRUE);
+            }
+        }
+    }
+
+    if (switchPtr->UpdateMirrorGroups != NULL)
+    {
+        /**************************************************** 
+         * Enable/Disable mirror groups based on the link
+         * status of the mirror port.
+         * See Bugzilla 11387.
+         ***************************************************/
+        if (portEvent->linkStatus == FM_PORT_STATUS_LINK_UP)
+        {
+            switchPtr->UpdateMirrorGroups(sw, 
+                                          logicalPort,
+                                          TRUE);
+        }
+        else if (portEvent->linkStatus == FM_PORT_STATUS_LINK_DOWN)
+        {
+            switchPtr->UpdateMirrorGroups(sw, 
+                                          logicalPort,
+                                          FALSE);
+        }
+    }
+
+    /* notify anyone else who needs to know */
+    if (portPtr->NotifyLinkEvent)
+    {
+        err = portPtr->NotifyLinkEvent(sw, portEvent->port);
+
+        if (err != FM_OK)
+        {
+            FM_LOG_WARNING(FM_LOG_CAT_EVENT_PORT,
+                           "%s\n",
+                           fmErrorMsg(err));
+        }
+    }
+
+    /* Get port state and notify platform */
+
+    err = fmGetPortStateV3( sw,
+                            portEvent->port,
+                            portEvent->mac,
+                            8,
+                            &numLanes,
+                            &mode,
+                            &state,
+                            info );
+
+    if (err != FM_OK)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_EVENT_PORT,
+                       "fmGetPortState(%d,%u) failed: %s\n",
+                       sw,
+                       portEvent->port,
+                       fmErrorMsg(err));
+    }
+
+    fmPlatformNotifyPortState(sw,
+                              portEvent->port,
+                              portEvent->mac,
+                              FALSE,
+                              state);
+
+    if (ctx->switchIsProtected)
+    {
+        UNPROTECT_SWITCH(sw);
+        ctx->switchIsProtected = FALSE;
+    }
+
+    return TRUE;
+
+}   /* end HandlePortEvent */
+
+
+
+
+/*****************************************************************************/
+/** HandlePacketEvent
+ * \ingroup intSwitch
+ *
+ * \desc            Global event handler for ''FM_EVENT_PKT_RECV'' and
+ *                  ''FM_EVENT_SFLOW_PKT_RECV''.
+ *
+ * \param[in,out]   ctx points to the dispatch state of the event.
+ *
+ * \param[in]       event points to the event.
+ *
+ * \return          TRUE if the event is to be distributed.
+ *
+ *****************************************************************************/
+static fm_bool HandlePacketEvent(fm_globalEventCtx *ctx, fm_event *event)
+{
+    FM_NOT_USED(event);
+
+    fmDbgDiagCountIncr(ctx->sw, FM_CTR_RX_API_PKT_FWD, 1);
+
+    return TRUE;
+
+}   /* end HandlePacketEvent */
+
+
+
+
+/*****************************************************************************/
+/** HandleTableUpdate
+ * \ingroup intSwitch
+ *
+ * \desc            Global event handler for ''FM_EVENT_TABLE_UPDATE''.
+ *                  Removes the learn updates that no longer match the MA
+ *                  Table and updates the diagnostic counters.
+ *
+ * \param[in,out]   ctx points to the dispatch state of the event.
+ *
+ * \param[in]       event points to the event.
+ *
+ * \return          TRUE if the event is to be distributed, i.e. if any of
+ *                  its updates remain.
+ *
+ *****************************************************************************/
+static fm_bool HandleTableUpdate(fm_globalEventCtx *ctx, fm_event *event)
+{
+    fm_eventTableUpdateBurst *updateEvent;
+    fm_eventTableUpdate *     fpUpdateEvent;
+    fm_switch *               switchPtr;
+    fm_int                    sw;
+    fm_uint32                 i;
+
+    sw        = ctx->sw;
+    switchPtr = ctx->switchPtr;
+
+    if (switchPtr == NULL)
+    {
+        return FALSE;
+    }
+
+    /* Update diagnostic counters. */
+    updateEvent = &event->info.fpUpdateEvent;
+    i = 0;
+
+    while (i < updateEvent->numUpdates)
+    {
+        fpUpdateEvent = &updateEvent->updates[i];
+
+        if (fpUpdateEvent->event == FM_EVENT_ENTRY_LEARNED)
+        {
+            /* Make sure the MA Table entry matches the entry
+             * in the update event. */
+            if (switchPtr->RemoveStaleLearnEvent != NULL &&
+                switchPtr->RemoveStaleLearnEvent(sw, updateEvent, i))
+            {
+                /* The learn event has been removed.
+                 * Do not update 'i', since it now contains the 
+                 * following event (if any). */
+                fmDbgDiagCountIncr(sw, FM_CTR_MAC_LEARN_DISCARDED, 1);
+            }
+            else
+            {
+                fmDbgDiagCountIncr(sw, FM_CTR_MAC_ALPS_LEARN, 1);
+                i++;
+            }
+        }
+        else
+        {
+            if (fpUpdateEvent->event == FM_EVENT_ENTRY_AGED)
+            {
+                fmDbgDiagCountIncr(sw, FM_CTR_MAC_ALPS_AGE, 1);
+            }
+            i++;
+        }
+    }
+
+    /* If all updates have been removed, don't distribute the event */
+    return (updateEvent->numUpdates > 0);
+
+}   /* end HandleTableUpdate */
+
+
+
+
+/*****************************************************************************/
+/** MergeTableUpdate
+ * \ingroup intSwitch
+ *
+ * \desc            Merges the updates of the next table update event of the
+ *                  same switch into an event about to be distributed, so
+ *                  that both are delivered at once.
+ *
+ * \param[in,out]   ctx points to the dispatch state of the event.
+ *
+ * \param[in,out]   event points to the event about to be distributed.
+ *
+ * \param[in]       next points to the next event, which is released by the
+ *                  caller if merged.
+ *
+ * \return          TRUE if next was merged into event.
+ *
+ *****************************************************************************/
+static fm_bool MergeTableUpdate(fm_globalEventCtx *ctx,
+                                fm_event *         event,
+                                fm_event *         next)
+{
+    fm_eventTableUpdateBurst *updateEvent;
+    fm_eventTableUpdateBurst *nextEvent;
+
+    updateEvent = &event->info.fpUpdateEvent;
+    nextEvent   = &next->info.fpUpdateEvent;
+
+    /* Filtering can only remove updates, so check the room first */
+    if (updateEvent->numUpdates + nextEvent->numUpdates >
+        FM_TABLE_UPDATE_BURST_SIZE)
+    {
+        return FALSE;
+    }
+
+    if ( (next->eventID != event->eventID) ||
+         (next->priority != event->priority) )
+    {
+        return FALSE;
+    }
+
+    if ( HandleTableUpdate(ctx, next) )
+    {
+        FM_MEMCPY_S( &updateEvent->updates[updateEvent->numUpdates],
+                     sizeof(fm_eventTableUpdate) *
+                        (FM_TABLE_UPDATE_BURST_SIZE - updateEvent->numUpdates),
+                     nextEvent->updates,
+                     sizeof(fm_eventTableUpdate) * nextEvent->numUpdates );
+
+        updateEvent->numUpdates += nextEvent->numUpdates;
+    }
+
+    return TRUE;
+
+}   /* end MergeTableUpdate */
+
+
+
+
+/*****************************************************************************/
+/** HandleGenericEvent
+ * \ingroup intSwitch
+ *
+ * \desc            Global event handler for the event types that are
+ *                  distributed without any processing by the API.
+ *
+ * \param[in,out]   ctx points to the dispatch state of the event.
+ *
+ * \param[in]       event points to the event.
+ *
+ * \return          TRUE.
+ *
+ *****************************************************************************/
+static fm_bool HandleGenericEvent(fm_globalEventCtx *ctx, fm_event *event)
+{
+    FM_NOT_USED(ctx);
+    FM_NOT_USED(event);
+
+    return TRUE;
+
+}   /* end HandleGenericEvent */
+
+
+
+
+/*****************************************************************************/
+/** GetGlobalEventType
+ * \ingroup intSwitch
+ *
+ * \desc            Returns the global event handler table entry of an event
+ *                  type.
+ *
+ * \param[in]       eventType is the event type.
+ *
+ * \return          Pointer to the entry, or NULL if the type is unknown.
+ *
+ *****************************************************************************/
+static fm_globalEventType *GetGlobalEventType(fm_int eventType)
+{
+    fm_globalEventType *entry;
+    fm_int              index;
+
+    if ( (eventType <= 0) || ( (eventType & (eventType - 1) ) != 0 ) )
+    {
+        return NULL;
+    }
+
+    index = __builtin_ctz( (fm_uint) eventType );
+    entry = &globalEventTypes[index];
+
+    return (entry->handler != NULL) ? entry : NULL;
+
+}   /* end GetGlobalEventType */
+
+
+
+
+/*****************************************************************************/
+/** MergeFollowingEvents
+ * \ingroup intSwitch
+ *
+ * \desc            Merges into an event about to be distributed the events
+ *                  of the same type and switch that directly follow it in
+ *                  its dispatch class, if the event type supports it.
+ *
+ * \param[in]       thread points to the global event handler's thread.
+ *
+ * \param[in,out]   ctx points to the dispatch state of the event.
+ *
+ * \param[in]       entry points to the table entry of the event type.
+ *
+ * \param[in,out]   event points to the event.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void MergeFollowingEvents(fm_thread *         thread,
+                                 fm_globalEventCtx * ctx,
+                                 fm_globalEventType *entry,
+                                 fm_event *          event)
+{
+    fm_dispatchQueue *queue;
+    fm_event *        next;
+
+    if (entry->merge == NULL)
+    {
+        return;
+    }
+
+    SortPostedEvents(thread);
+
+    queue = &dispatchQueue[fmGetEventDispatchClass(event->type)];
+
+    while (queue->count > 0)
+    {
+        next = queue->events[queue->head];
+
+        if ( (next->type != event->type) || (next->sw != event->sw) )
+        {
+            break;
+        }
+
+        if ( !entry->merge(ctx, event, next) )
+        {
+            break;
+        }
+
+        queue->head = (queue->head + 1) % FM_MAX_EVENTS;
+        queue->count--;
+        numDispatchEvents--;
+
+        entry->numEvents++;
+        entry->numMerged++;
+
+        fmReleaseEvent(next);
+    }
+
+}   /* end MergeFollowingEvents */
+
+
+
+
+/*****************************************************************************/
+/** DeliverEvent
+ * \ingroup intSwitch
+ *
+ * \desc            Hands an event over to the switch-specific event handler,
+ *                  if any, or distributes it to the interested processes.
+ *
+ * \param[in,out]   ctx points to the dispatch state of the event.
+ *
+ * \param[in]       event points to the event.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void DeliverEvent(fm_globalEventCtx *ctx, fm_event *event)
+{
+    fm_eventPktRecv *rcvPktEvent;
+    fm_status        err;
+
+    if (ctx->switchIsProtected)
+    {
+        UNPROTECT_SWITCH(ctx->sw);
+        ctx->switchIsProtected = FALSE;
+    }
+
+    if (ctx->eventHandler == NULL)
+    {
+        fmDistributeEvent(event);
+        return;
+    }
+
+    if (enableFramePriority && 
+        ( (event->type == FM_EVENT_PKT_RECV) ||
+          (event->type == FM_EVENT_SFLOW_PKT_RECV) ) )
+    {
+        rcvPktEvent = &event->info.fpPktEvent;
+        err = fmFreeBufferQueueNode(ctx->sw, rcvPktEvent);
+        if (err != FM_OK)
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
+                         "Freeing Buffer queue node from the queue failed"
+                         "status = %d (%s) \n",
+                          err,
+                          fmErrorMsg(err));
+
+        }
+    }
+
+    ctx->eventHandler(event);
+
+}   /* end DeliverEvent */
+
+
+
+
+/*****************************************************************************/
+/** RegisterGlobalEventType
+ * \ingroup intSwitch
+ *
+ * \desc            Registers the handling of an event type in the global
+ *                  event handler table.
+ *
+ * \param[in]       eventType is the event type.
+ *
+ * \param[in]       handler is the handler of the event type.
+ *
+ * \param[in]       merge merges following events of the type, or is NULL.
+ *
+ * \param[in]       discard releases a discarded event, or is NULL.
+ *
+ * \param[in]       whileDown is TRUE if the event is handled while its
+ *                  switch is not up.
+ *
+ * \param[in]       withoutSwitch is TRUE if the event is handled before its
+ *                  switch exists.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void RegisterGlobalEventType(fm_int                eventType,
+                                    fm_globalEventHandler handler,
+                                    fm_globalEventMerge   merge,
+                                    fm_globalEventDiscard discard,
+                                    fm_bool               whileDown,
+                                    fm_bool               withoutSwitch)
+{
+    fm_globalEventType *entry;
+
+    entry = &globalEventTypes[__builtin_ctz( (fm_uint) eventType )];
+
+    FM_CLEAR(*entry);
+
+    entry->handler       = handler;
+    entry->merge         = merge;
+    entry->discard       = discard;
+    entry->whileDown     = whileDown;
+    entry->withoutSwitch = withoutSwitch;
+
+}   /* end RegisterGlobalEventType */
+
+
+
+
+/*****************************************************************************/
+/** InitGlobalEventTypes
+ * \ingroup intSwitch
+ *
+ * \desc            Fills the global event handler table.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void InitGlobalEventTypes(void)
+{
+    static const fm_int genericTypes[] =
+    {
+        FM_EVENT_PURGE_SCAN_COMPLETE,
+        FM_EVENT_SECURITY,
+        FM_EVENT_FRAME,
+        FM_EVENT_SOFTWARE,
+        FM_EVENT_PARITY_ERROR,
+        FM_EVENT_FIBM_THRESHOLD,
+        FM_EVENT_CRM,
+        FM_EVENT_ARP,
+        FM_EVENT_EGRESS_TIMESTAMP,
+        FM_EVENT_PLATFORM,
+        FM_EVENT_LOGICAL_PORT,
+        FM_EVENT_CABLE_MISMATCH,
+        FM_EVENT_FLOW_AGED,
+    };
+    fm_uint i;
+
+    FM_CLEAR(globalEventTypes);
+
+    RegisterGlobalEventType(FM_EVENT_SWITCH_INSERTED,
+                            HandleSwitchInserted,
+                            NULL,
+                            NULL,
+                            TRUE,
+                            TRUE);
+    RegisterGlobalEventType(FM_EVENT_SWITCH_REMOVED,
+                            HandleSwitchRemoved,
+                            NULL,
+                            NULL,
+                            TRUE,
+                            FALSE);
+    RegisterGlobalEventType(FM_EVENT_PORT,
+                            HandlePortEvent,
+                            NULL,
+                            NULL,
+                            FALSE,
+                            FALSE);
+    RegisterGlobalEventType(FM_EVENT_PKT_RECV,
+                            HandlePacketEvent,
+                            NULL,
+                            DiscardPacketEvent,
+                            FALSE,
+                            FALSE);
+    RegisterGlobalEventType(FM_EVENT_SFLOW_PKT_RECV,
+                            HandlePacketEvent,
+                            NULL,
+                            DiscardPacketEvent,
+                            FALSE,
+                            FALSE);
+    RegisterGlobalEventType(FM_EVENT_TABLE_UPDATE,
+                            HandleTableUpdate,
+                            MergeTableUpdate,
+                            NULL,
+                            FALSE,
+                            FALSE);
+
+    for (i = 0 ; i < FM_NENTRIES(genericTypes) ; i++)
+    {
+        RegisterGlobalEventType(genericTypes[i],
+                                HandleGenericEvent,
+                                NULL,
+                                NULL,
+                                FALSE,
+                                FALSE);
+    }
+
+}   /* end InitGlobalEventTypes */
+
+
+
+
+/*****************************************************************************/
+/** FreeRetiredSnapshots
+ * \ingroup intSwitch
+ *
+ * \desc            Frees the local delivery snapshots replaced since the
+ *                  last call.
+ *                                                                      \lb\lb
+ *                  fmDistributeEvent is the only reader of the snapshots
+ *                  and is called from a single thread, so a snapshot
+ *                  retired before it starts distributing an event can no
+ *                  longer be in use.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void FreeRetiredSnapshots(void)
+{
+    fm_localDeliverySnapshot *snapshot;
+    fm_localDeliverySnapshot *next;
+
+    if (FM_ATOMIC_LOAD(&fmRootApi->localDeliveryRetired) == NULL)
+    {
+        return;
+    }
+
+    snapshot = FM_ATOMIC_EXCHANGE(&fmRootApi->localDeliveryRetired, NULL);
+
+    while (snapshot != NULL)
+    {
+        next = snapshot->nextRetired;
+        fmFree(snapshot);
+        snapshot = next;
+    }
+
+}   /* end FreeRetiredSnapshots */
+
+
+
+
+/*****************************************************************************/
+/** SendLocalEvents
+ * \ingroup intSwitch
+ *
+ * \desc            Sends events to a local dispatch thread, using
+ *                  exponential backoff while its event queue is full.
+ *
+ * \param[in]       thread points to the local dispatch thread.
+ *
+ * \param[in]       numEvents is the number of entries in events.
+ *
+ * \param[in]       events points to the events to send, in order.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void SendLocalEvents(fm_thread *thread,
+                            fm_int     numEvents,
+                            fm_event **events)
+{
+    fm_uint64 nanos = MIN_WAIT_NANOS;
+    fm_int    numSent;
+
+    while (numEvents > 0)
+    {
+        if (numEvents == 1)
+        {
+            numSent = (fmSendThreadEvent(thread, events[0]) == FM_OK) ? 1 : 0;
+        }
+        else
+        {
+            fmSendThreadEventBatch(thread, numEvents, events, &numSent);
+        }
+
+        numEvents -= numSent;
+        events    += numSent;
+
+        if (numEvents > 0)
+        {
+            DELAY_NANOS(nanos);
+            nanos *= 2;
+
+            if (nanos > MAX_WAIT_NANOS)
+            {
+                nanos = MAX_WAIT_NANOS;
+            }
+        }
+    }
+
+}   /* end SendLocalEvents */
+
+
+
+
+/*****************************************************************************/
+/** StageLocalEvent
+ * \ingroup intSwitch
+ *
+ * \desc            Stages an event for a local dispatch thread, so that it
+ *                  is posted with the following ones in a single batch. See
+ *                  ''fmFlushDistributedEvents''.
+ *
+ * \param[in]       thread points to the local dispatch thread.
+ *
+ * \param[in]       event points to the event.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void StageLocalEvent(fm_thread *thread, fm_event *event)
+{
+    fm_pendingDelivery *pending;
+    fm_int              i;
+
+    for (i = 0 ; i < numPendingDeliveries ; i++)
+    {
+        if (pendingDelivery[i].thread == thread)
+        {
+            break;
+        }
+    }
+
+    if (i == numPendingDeliveries)
+    {
+        if (numPendingDeliveries == MAX_PENDING_DELIVERIES)
+        {
+            /* No room to stage it, send it now */
+            SendLocalEvents(thread, 1, &event);
+            return;
+        }
+
+        pendingDelivery[i].thread = thread;
+        pendingDelivery[i].count  = 0;
+        numPendingDeliveries++;
+    }
+
+    pending = &pendingDelivery[i];
+    pending->events[pending->count++] = event;
+
+    if (pending->count == FM_EVENT_BATCH_SIZE)
+    {
+        SendLocalEvents(pending->thread, pending->count, pending->events);
+        pending->count = 0;
+    }
+
+}   /* end StageLocalEvent */
+
+
+
+
+/*****************************************************************************/
+/** FilterTableUpdates
+ * \ingroup intSwitch
+ *
+ * \desc            Copies the MA Table updates of an event a local
+ *                  delivery filter selects to another event.
+ *
+ * \param[in]       filter points to the local delivery filter.
+ *
+ * \param[in]       event points to the event to copy updates from.
+ *
+ * \param[out]      localEvent points to the event to copy updates to.
+ *
+ * \return          The number of updates copied.
+ *
+ *****************************************************************************/
+static fm_uint32 FilterTableUpdates(fm_eventFilter *filter,
+                                    fm_event *      event,
+                                    fm_event *      localEvent)
+{
+    fm_eventTableUpdate *update;
+    fm_uint32            numUpdates = 0;
+    fm_uint32            i;
+
+    for (i = 0 ; i < event->info.fpUpdateEvent.numUpdates ; i++)
+    {
+        update = &event->info.fpUpdateEvent.updates[i];
+
+        if ( (update->event >= 0) && (update->event < 32) &&
+             (filter->tableUpdateMask & (1U << update->event)) &&
+             FM_EVENT_FILTER_HAS_VLAN(filter, update->vlanID) )
+        {
+            localEvent->info.fpUpdateEvent.updates[numUpdates++] = *update;
+        }
+    }
+
+    localEvent->info.fpUpdateEvent.numUpdates = numUpdates;
+
+    return numUpdates;
+
+}   /* end FilterTableUpdates */
+
+
+
+
+/*****************************************************************************/
+/** DeliveryWantsEvent
+ * \ingroup intSwitch
+ *
+ * \desc            Tells whether an event is to be delivered to a process,
+ *                  according to its event mask and filter. An
+ *                  ''FM_EVENT_TABLE_UPDATE'' event is further filtered
+ *                  update by update with ''FilterTableUpdates''.
+ *
+ * \param[in]       delivery points to the process's local delivery.
+ *
+ * \param[in]       event points to the event.
+ *
+ * \return          TRUE if the event is to be delivered.
+ *
+ *****************************************************************************/
+static fm_bool DeliveryWantsEvent(fm_localDelivery *delivery, fm_event *event)
+{
+    if ( (delivery->mask & event->type) == 0 )
+    {
+        return FALSE;
+    }
+
+    if ( delivery->filterEnabled &&
+         ( (event->type == FM_EVENT_PKT_RECV) ||
+           (event->type == FM_EVENT_SFLOW_PKT_RECV) ) )
+    {
+        return FM_EVENT_FILTER_HAS_VLAN(&delivery->filter,
+                                        event->info.fpPktEvent.vlan);
+    }
+
+    return TRUE;
+
+}   /* end DeliveryWantsEvent */
+
+
+
+
+/*****************************************************************************/
+/** HashPacketBytes
+ * \ingroup intSwitch
+ *
+ * \desc            Folds bytes into a 32-bit FNV-1a hash.
+ *
+ * \param[in]       hash is the hash so far.
+ *
+ * \param[in]       bytes points to the bytes to fold in.
+ *
+ * \param[in]       numBytes is the number of bytes to fold in.
+ *
+ * \return          The updated hash.
+ *
+ *****************************************************************************/
+static fm_uint32 HashPacketBytes(fm_uint32 hash, const fm_byte *bytes, fm_int numBytes)
+{
+    fm_int i;
+
+    for (i = 0 ; i < numBytes ; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619U;
+    }
+
+    return hash;
+
+}   /* end HashPacketBytes */
+
+
+
+
+/*****************************************************************************/
+/** HashPacketFlow
+ * \ingroup intSwitch
+ *
+ * \desc            Computes the flow hash steering a received packet to a
+ *                  packet queue: the addresses, protocol and TCP/UDP ports
+ *                  of IPv4 and IPv6 frames, or the VLAN and MAC addresses
+ *                  of other frames.
+ *                                                                      \lb\lb
+ *                  Only the first buffer of the frame is looked at, which
+ *                  always holds the headers used. The ports of IPv4
+ *                  fragments are left out so that all the fragments of a
+ *                  datagram hash alike.
+ *
+ * \param[in]       pktEvent points to the packet receive event.
+ *
+ * \return          The flow hash.
+ *
+ *****************************************************************************/
+static fm_uint32 HashPacketFlow(fm_eventPktRecv *pktEvent)
+{
+    fm_buffer *    buffer;
+    const fm_byte *frame;
+    fm_uint32      hash;
+    fm_int         len;
+    fm_int         off;
+    fm_int         ihl;
+    fm_uint16      etherType;
+    fm_uint16      fragment;
+    fm_byte        protocol;
+
+    hash   = 2166136261U;
+    buffer = pktEvent->pkt;
+
+    if ( (buffer == NULL) || (buffer->len < 14) )
+    {
+        return HashPacketBytes(hash, (const fm_byte *) &pktEvent->vlan,
+                               sizeof(pktEvent->vlan));
+    }
+
+    frame     = (const fm_byte *) buffer->data;
+    len       = buffer->len;
+    off       = 12;
+    etherType = (frame[off] << 8) | frame[off + 1];
+
+    /* Skip the 802.1Q and 802.1ad tags */
+    while ( ( (etherType == 0x8100) || (etherType == 0x88A8) ) &&
+            (len >= off + 6) )
+    {
+        off      += 4;
+        etherType = (frame[off] << 8) | frame[off + 1];
+    }
+
+    off += 2;
+
+    if ( (etherType == 0x0800) && (len >= off + 20) )
+    {
+        ihl      = (frame[off] & 0xF) * 4;
+        protocol = frame[off + 9];
+        fragment = ( (frame[off + 6] & 0x3F) << 8 ) | frame[off + 7];
+
+        hash = HashPacketBytes(hash, &frame[off + 12], 8);
+        hash = HashPacketBytes(hash, &protocol, 1);
+
+        if ( ( (protocol == 6) || (protocol == 17) ) &&
+             (fragment == 0) &&
+             (len >= off + ihl + 4) )
+        {
+            hash = HashPacketBytes(hash, &frame[off + ihl], 4);
+        }
+
+        return hash;
+    }
+
+    if ( (etherType == 0x86DD) && (len >= off + 40) )
+    {
+        protocol = frame[off + 6];
+
+        hash = HashPacketBytes(hash, &frame[off + 8], 32);
+        hash = HashPacketBytes(hash, &protocol, 1);
+
+        if ( ( (protocol == 6) || (protocol == 17) ) &&
+             (len >= off + 44) )
+        {
+            hash = HashPacketBytes(hash, &frame[off + 40], 4);
+        }
+
+        return hash;
+    }
+
+    hash = HashPacketBytes(hash, (const fm_byte *) &pktEvent->vlan,
+                           sizeof(pktEvent->vlan));
+
+    return HashPacketBytes(hash, frame, 12);
+
+}   /* end HashPacketFlow */
+
+
+
+
+/*****************************************************************************/
+/** SteerPacketEvent
+ * \ingroup intSwitch
+ *
+ * \desc            Moves a received packet event to the packet queue its
+ *                  flow hashes to, dropping it if that queue is full.
+ *                                                                      \lb\lb
+ *                  Only called from the single thread reporting the
+ *                  process's events at a time, so that the packets of a
+ *                  flow stay in order.
+ *
+ * \param[in]       numQueues is the number of packet queues.
+ *
+ * \param[in]       event points to the event.
+ *
+ * \return          The packet queue the event was steered to, or -1 if it
+ *                  was dropped.
+ *
+ *****************************************************************************/
+static fm_int SteerPacketEvent(fm_int numQueues, fm_event *event)
+{
+    fm_int queue;
+
+    queue = HashPacketFlow(&event->info.fpPktEvent) % numQueues;
+
+    if (fmEventQueueAdd(&packetQueues[queue], event) != FM_OK)
+    {
+        FM_ATOMIC_ADD_RELAXED(&packetQueueDrops[queue], 1);
+
+        if ( (event->sw >= 0) && (event->sw < fmRootPlatform->cfg.numSwitches) )
+        {
+            fmFreeBufferChain(event->sw, event->info.fpPktEvent.pkt);
+            fmDbgDiagCountIncr(event->sw, FM_CTR_RX_API_PKT_DROPS, 1);
+        }
+
+        fmReleaseEvent(event);
+
+        return -1;
+    }
+
+    return queue;
+
+}   /* end SteerPacketEvent */
+
+
+
+
+/*****************************************************************************/
+/** PrepareLocalEvents
+ * \ingroup intSwitch
+ *
+ * \desc            Prepares events pulled from the local dispatch queue to
+ *                  be reported to the application, releasing those that
+ *                  cannot be.
+ *
+ * \param[in,out]   events points to the events, the ones to report being
+ *                  moved to the front.
+ *
+ * \param[in]       numEvents is the number of entries in events.
+ *
+ * \return          The number of events to report.
+ *
+ *****************************************************************************/
+static fm_int PrepareLocalEvents(fm_event **events, fm_int numEvents)
+{
+    fm_event *event;
+    fm_status status;
+    fm_uint32 steered = 0;
+    fm_int    numQueues;
+    fm_int    numValid = 0;
+    fm_int    queue;
+    fm_int    i;
+
+    numQueues = FM_ATOMIC_LOAD(&numPacketQueues);
+
+    for (i = 0 ; i < numEvents ; i++)
+    {
+        event = events[i];
+
+        if ( (event->type == FM_EVENT_PKT_RECV) ||
+             (event->type == FM_EVENT_SFLOW_PKT_RECV) )
+        {
+            fmDbgPacketRxLatencyRecord(FM_DBG_PKT_RX_STAGE_DELIVER,
+                                       event->info.fpPktEvent.pkt);
+        }
+
+        if (enableFramePriority &&
+            ( (event->type == FM_EVENT_PKT_RECV) ||
+              (event->type == FM_EVENT_SFLOW_PKT_RECV) ) )
+        {
+            status = fmFreeBufferQueueNode(FM_FIRST_FOCALPOINT, &event->info.fpPktEvent);
+            if (status != FM_OK)
+            {
+                FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
+                             "Freeing Buffer queue node from the queue failed"
+                             "status = %d (%s) \n",
+                              status,
+                              fmErrorMsg(status));
+
+                fmReleaseEvent(event);
+                continue;
+            }
+        }
+
+        if ( (numQueues > 0) &&
+             ( (event->type == FM_EVENT_PKT_RECV) ||
+               (event->type == FM_EVENT_SFLOW_PKT_RECV) ) )
+        {
+            queue = SteerPacketEvent(numQueues, event);
+
+            if (queue >= 0)
+            {
+                steered |= (1U << queue);
+            }
+
+            continue;
+        }
+
+        events[numValid++] = event;
+    }
+
+    /* Signal each packet queue once per batch rather than per packet */
+    for (queue = 0 ; steered != 0 ; queue++, steered >>= 1)
+    {
+        if (steered & 1)
+        {
+            fmSignalEventNotifier(packetQueueFds[queue]);
+        }
+    }
+
+    return numValid;
+
+}   /* end PrepareLocalEvents */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** fmPublishLocalDelivery
+ * \ingroup intSwitch
+ *
+ * \desc            Publishes a new copy of the local delivery list for
+ *                  fmDistributeEvent, which reads it without taking the
+ *                  local delivery lock. The copy it replaces is freed by
+ *                  fmDistributeEvent once it can no longer be in use.
+ *                                                                      \lb\lb
+ *                  Must be called with the local delivery lock taken,
+ *                  after any change to the list or to a delivery mask.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if the copy could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmPublishLocalDelivery(void)
+{
+    fm_localDeliverySnapshot *snapshot;
+    fm_localDeliverySnapshot *old;
+    fm_localDeliverySnapshot *retired;
+    fm_dlist_node *           node;
+    fm_uint                   count;
+
+    count    = fmRootApi->localDeliveryCount;
+    snapshot = fmAlloc( sizeof(fm_localDeliverySnapshot) +
+                        count * sizeof(fm_localDelivery) );
+
+    if (snapshot == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    snapshot->nextRetired = NULL;
+    snapshot->count       = 0;
+
+    for ( node = FM_DLL_GET_FIRST( (&fmRootApi->localDeliveryThreads), head ) ;
+          (node != NULL) && (snapshot->count < count) ;
+          node = FM_DLL_GET_NEXT(node, nextPtr) )
+    {
+        snapshot->delivery[snapshot->count++] =
+            *(fm_localDelivery *) node->data;
+    }
+
+    old = FM_ATOMIC_EXCHANGE(&fmRootApi->localDeliverySnapshot, snapshot);
+
+    if (old != NULL)
+    {
+        retired = FM_ATOMIC_LOAD(&fmRootApi->localDeliveryRetired);
+
+        do
+        {
+            old->nextRetired = retired;
+        }
+        while ( !FM_ATOMIC_CAS(&fmRootApi->localDeliveryRetired,
+                               &retired,
+                               old) );
+    }
+
+    return FM_OK;
+
+}   /* end fmPublishLocalDelivery */
+
+
+
+
+/*****************************************************************************/
+/** fmFlushDistributedEvents
+ * \ingroup intSwitch
+ *
+ * \desc            Posts the events staged by ''fmDistributeEvent'' to their
+ *                  local dispatch threads.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+void fmFlushDistributedEvents(void)
+{
+    fm_int i;
+
+    for (i = 0 ; i < numPendingDeliveries ; i++)
+    {
+        SendLocalEvents(pendingDelivery[i].thread,
+                        pendingDelivery[i].count,
+                        pendingDelivery[i].events);
+    }
+
+    numPendingDeliveries = 0;
+
+}   /* end fmFlushDistributedEvents */
+
+
+
+
+/*****************************************************************************/
+/** fmDistributeEvent
+ * \ingroup intSwitch
+ *
+ * \desc            distributes events to those processes that have registered
+ *                  an interest in the particular event.
+ *                                                                      \lb\lb
+ *                  Each process receives its own copy of the event, but a
+ *                  received packet is shared by all of them: its buffer
+ *                  chain gets one owner per process, and is freed when the
+ *                  last of them frees it.
+ *                                                                      \lb\lb
+ *                  The events for each process are staged and posted to it
+ *                  in batches; the caller must call
+ *                  ''fmFlushDistributedEvents'' before waiting for more
+ *                  events to distribute.
+ *
+ * \param[in]       event points to the event structure.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+void fmDistributeEvent(fm_event *event)
+{
+    fm_localDeliverySnapshot *snapshot;
+    fm_localDelivery *        delivery;
+    fm_uint                   count;
+    fm_uint                   i;
+    fm_uint                   pktDeliveryCount = 0;
+    fm_eventPktRecv *         rcvPktEvent = NULL;
+    fm_status                 status;
+    fm_buffer *               buffer;
+    fm_bool                   isPktEvent;
+    fm_bool                   recvEventSet = FALSE;
+
+    /**************************************************
+     * The published snapshot of the local delivery list
+     * is read without taking the local delivery lock.
+     * It is not freed until the next call once replaced.
+     **************************************************/
+
+    FreeRetiredSnapshots();
+
+    snapshot = FM_ATOMIC_LOAD(&fmRootApi->localDeliverySnapshot);
+    count    = (snapshot != NULL) ? snapshot->count : 0;
+
+    isPktEvent = ( (event->type == FM_EVENT_PKT_RECV) ||
+                   (event->type == FM_EVENT_SFLOW_PKT_RECV) );
+
+    for (i = 0 ; i < count ; i++)
+    {
+        if ( isPktEvent && DeliveryWantsEvent(&snapshot->delivery[i], event) )
+        {
+            /* Found thread we need to deliver packet to. */
+            pktDeliveryCount++;
+        }
+    }
+
+    if (isPktEvent)
+    {
+        rcvPktEvent = &event->info.fpPktEvent;
+
+        fmDbgPacketRxLatencyRecord(FM_DBG_PKT_RX_STAGE_DISTRIBUTE,
+                                   rcvPktEvent->pkt);
+
+        /**************************************************
+         * If the event is packet receive but no one has
+         * registered for the event, free the associated
+         * packet buffer and return.
+         **************************************************/
+
+        if (pktDeliveryCount == 0)
+        {
+            if (enableFramePriority)
+            {
+                status = fmFreeBufferQueueNode(event->sw, rcvPktEvent);
+                if (status != FM_OK)
+                {
+                    FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
+                                 "Freeing Buffer queue node from the queue failed"
+                                 "status = %d (%s) \n",
+                                  status,
+                                  fmErrorMsg(status));
+
+                }
+            }
+            fmFreeBufferChain(event->sw, rcvPktEvent->pkt);
+            fmDbgDiagCountIncr(event->sw, FM_CTR_RX_API_PKT_DROPS, 1);
+            return;
+        }
+
+        /**************************************************
+         * Rather than cloning the packet for each extra
+         * interested process, give the chain one owner per
+         * process.
+         **************************************************/
+
+        if (pktDeliveryCount > 1)
+        {
+            if (enableFramePriority)
+            {
+                FM_LOG_ERROR(FM_LOG_CAT_EVENT,
+                             "Prioritization is supported only for the"
+                             "first registered process. Subsequent "
+                             "processes follow normal buffer allocation"
+                             " without prioritization.\n");
+            }
+
+            fmRetainBufferChain(rcvPktEvent->pkt, pktDeliveryCount - 1);
+        }
+    }
+
+    /**************************************************
+     * Now we do the actual delivery
+     **************************************************/
+
+    for (i = 0 ; i < count ; i++)
+    {
+        fm_event *localEvent = NULL;
+        fm_uint64 nanos      = MIN_WAIT_NANOS;
+        fm_uint32 numUpdates;
+
+        delivery = &snapshot->delivery[i];
+
+        if ( !DeliveryWantsEvent(delivery, event) )
+        {
+            continue;
+        }
+
+        /**************************************************
+         * Always use high priority for the locally dispatched
+         * events, because DistributeEvent is only called from
+         * a single thread (the global event handler), and if
+         * we allocated both low and high priority events here,
+         * we could get priority inversion.
+         **************************************************/
+
+        while (localEvent == NULL)
+        {
+            localEvent = fmAllocateEvent(event->sw,
+                                         event->eventID,
+                                         event->type,
+                                         FM_EVENT_PRIORITY_HIGH);
+
+            if (localEvent == NULL)
+            {
+                DELAY_NANOS(nanos);
+                nanos *= 2;
+
+                if (nanos > MAX_WAIT_NANOS)
+                {
+                    nanos = MAX_WAIT_NANOS;
+                    FM_LOG_WARNING(FM_LOG_CAT_EVENT,
+                                   "Waiting to allocate event of type %d "
+                                   "for switch %d\n",
+                                   event->type,
+                                   event->sw);
+                }
+            }
+        }
+
+        if (event->type == FM_EVENT_TABLE_UPDATE)
+        {
+            /**************************************************
+             * Because the updates field is a pointer to memory
+             * that has been "secretly" allocated after the event,
+             * rather than just being part of the union, we have
+             * to handle it specially.
+             **************************************************/
+
+            if (delivery->filterEnabled)
+            {
+                if (FilterTableUpdates(&delivery->filter,
+                                       event,
+                                       localEvent) == 0)
+                {
+                    /* None of the updates is of interest */
+                    fmReleaseEvent(localEvent);
+                    continue;
+                }
+            }
+            else
+            {
+                numUpdates = event->info.fpUpdateEvent.numUpdates;
+                localEvent->info.fpUpdateEvent.numUpdates = numUpdates;
+                FM_MEMCPY_S( localEvent->info.fpUpdateEvent.updates,
+                             numUpdates * sizeof(fm_eventTableUpdate),
+                             event->info.fpUpdateEvent.updates,
+                             numUpdates * sizeof(fm_eventTableUpdate) );
+            }
+        }
+        else if (event->type == FM_EVENT_PURGE_SCAN_COMPLETE)
+        {
+            localEvent->info.purgeScanComplete = event->info.purgeScanComplete;
+        } 
+        else
+        {
+            /**************************************************
+             * Otherwise, we can just copy the whole union
+             * without worrying what type it is. A received
+             * packet is shared, see above.
+             **************************************************/
+
+            localEvent->info = event->info;
+
+            if (isPktEvent && enableFramePriority && !recvEventSet)
+            {
+                buffer = ((fm_buffer *)(localEvent->info.fpPktEvent.pkt));
+                buffer->recvEvent = localEvent;
+                recvEventSet      = TRUE;
+            }
+        }
+
+        /**************************************************
+         * Stage the event for the local dispatch thread, to
+         * be posted with the following ones in one batch.
+         **************************************************/
+
+        StageLocalEvent(delivery->thread, localEvent);
+
+    }   /* end for (i = 0 ; i < count ; i++) */
+
+}   /* end fmDistributeEvent */
+
+
+
+
+/*****************************************************************************/
+/** fmGlobalEventHandler
+ * \ingroup intSwitch
+ *
+ * \desc            event handler for handling system events
+ *                                                                      \lb\lb
+ *                  Each event is handed to the handler registered for its
+ *                  type in the global event handler table, which decides
+ *                  whether the event is distributed. Events of some types
+ *                  are merged with the following ones before being
+ *                  distributed. See ''fmDbgDumpGlobalEventStats''.
+ *
+ * \param[in]       args points to the thread arguments
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+void *fmGlobalEventHandler(void *args)
+{
+    fm_thread *               thread;
+    fm_event *                event;
+    fm_status                 err       = FM_OK;
+    fm_int                    sw = 0;
+    fm_bool                   discardEvent;
+    fm_bool                   distributeEvent;
+    fm_int                    numQueued;
+    fm_globalEventCtx         ctx;
+    fm_globalEventType *      entry;
+    fm_uint64                 startTime;
+    fm_uint64                 elapsed;
+
+    /* grab arguments */
+    thread = FM_GET_THREAD_HANDLE(args);
+
+    /* wait for initialization to finish before processing events */
+    fmCaptureSemaphore(&fmRootApi->startGlobalEventHandler, FM_WAIT_FOREVER);
+
+    enableFramePriority = GET_PROPERTY()->priorityBufQueues;
+
+    InitGlobalEventTypes();
+
+    while (1)
+    {
+        /* post the events staged for local delivery before waiting */
+        if ( (numDispatchEvents == 0) &&
+             (fmEventQueueCount(&thread->events, &numQueued) == FM_OK) &&
+             (numQueued == 0) )
+        {
+            fmFlushDistributedEvents();
+        }
+
+        /* wait forever for an event, taken in dispatch class order */
+        event = NULL;
+        err   = GetDispatchEvent(thread, &event);
+
+        if (err == FM_ERR_NO_EVENTS_AVAILABLE)
+        {
+            /* A timeout occurred - should never happen. */
+            continue;
+        }
+
+        if (event == NULL)
+        {
+            /* NULL event should never happen. */
+            continue;
+        }
+
+        startTime = fmGetMonotonicNsec();
+        entry     = GetGlobalEventType(event->type);
+
+        sw           = event->sw;
+        discardEvent = FALSE;
+
+        FM_CLEAR(ctx);
+        ctx.sw = sw;
+
+        if (sw < 0 || sw >= fmRootPlatform->cfg.numSwitches)
+        {
+            discardEvent = TRUE;
+        }
+        else if ( SWITCH_LOCK_EXISTS(sw) )
+        {
+            if ( ( err = PROTECT_SWITCH(sw) ) != FM_OK )
+            {
+                discardEvent = TRUE;
+            }
+            else
+            {
+                ctx.switchIsProtected = TRUE;
+                ctx.switchPtr         = fmRootApi->fmSwitchStateTable[sw];
+
+                if ( ( (ctx.switchPtr == NULL) ||
+                       (ctx.switchPtr->state != FM_SWITCH_STATE_UP) ) &&
+                     ( (entry == NULL) || !entry->whileDown ) )
+                {
+                    discardEvent = TRUE;
+                }
+            }
+        }
+        else if ( (entry == NULL) || !entry->withoutSwitch )
+        {
+            discardEvent = TRUE;
+        }
+
+        if (discardEvent)
+        {
+            if (entry != NULL)
+            {
+                if (entry->discard != NULL)
+                {
+                    entry->discard(sw, event);
+                }
+
+                entry->numDiscarded++;
+            }
+
+            goto FINISHED;
+        }
+
+        if (ctx.switchPtr != NULL)
+        {
+            /* If the switch state table has an eventHandler pointer,
+             * it overrides the global handler.  Call the switch-specific
+             * function to handle the event.  This is intended to be used
+             * for switches in a switch aggregate (and potentially
+             * nested switch aggregates inside other switch aggregates?).
+             */
+            ctx.eventHandler     = ctx.switchPtr->eventHandler;
+            ctx.isPhysicalSwitch =
+                (ctx.switchPtr->switchModel != FM_SWITCH_MODEL_SWAG);
+        }
+        else
+        {
+            /* Only physical switches should ever get here with a NULL pointer
+             * because logical switches such as switch aggregates are always
+             * created by application code before any events related to
+             * the switch are possible.
+             */
+            ctx.isPhysicalSwitch = TRUE;
+        }
+
+        if (entry == NULL)
+        {
+            FM_LOG_WARNING(FM_LOG_CAT_EVENT_PORT,
+                           "Received unknown event %d\n",
+                           event->type);
+            goto FINISHED;
+        }
+
+        distributeEvent = entry->handler(&ctx, event);
+
+        if (distributeEvent)
+        {
+            MergeFollowingEvents(thread, &ctx, entry, event);
+
+            DeliverEvent(&ctx, event);
+
+            entry->numDistributed++;
+        }
+
+FINISHED:
+
+        fmReleaseEvent(event);
+
+        /* release the switch lock if any is held */
+        if (ctx.switchIsProtected)
+        {
+            UNPROTECT_SWITCH(sw);
+        }
+
+        if (entry != NULL)
+        {
+            elapsed = fmGetMonotonicNsec() - startTime;
+
+            entry->numEvents++;
+            entry->totalTime += elapsed;
+
+            if (elapsed > entry->maxTime)
+            {
+                entry->maxTime = elapsed;
+            }
+        }
+
+    }   /* end while (1) */
+
+
+    fmExitThread(thread);
+
+    return NULL;
+
+}   /* end fmGlobalEventHandler */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgDumpGlobalEventStats
+ * \ingroup diagMisc
+ *
+ * \desc            Dumps, for each event type, the number of events handled
+ *                  by the global event handler, how many were merged into
+ *                  a preceding event, distributed or discarded because
+ *                  their switch was not up, and the time spent handling
+ *                  them. The time of an event includes its distribution
+ *                  and the handling of the events merged into it.
+ *
+ * \return          FM_OK.
+ *
+ *****************************************************************************/
+fm_status fmDbgDumpGlobalEventStats(void)
+{
+    fm_globalEventType *entry;
+    fm_int              i;
+
+    FM_LOG_PRINT("\nGlobal event handler statistics, times in usec:\n\n");
+    FM_LOG_PRINT("%-20s %12s %10s %12s %10s %12s %9s %9s\n",
+                 "Event type",
+                 "Events",
+                 "Merged",
+                 "Distributed",
+                 "Discarded",
+                 "Total",
+                 "Avg",
+                 "Max");
+
+    for (i = 0 ; i < NUM_GLOBAL_EVENT_TYPES ; i++)
+    {
+        entry = &globalEventTypes[i];
+
+        if ( (entry->handler == NULL) || (entry->numEvents == 0) )
         {
-            /* If the switch state table has an eventHandler pointer,
-             * it overrides the global handler.  Call the switch-specific
-             * function to handle the event.  This is intended to be used
-             * for switches in a switch aggregate (and potentially
-             * nested switch aggregates inside other switch aggregates?).
-             */
-            eventHandler = switchPtr->eventHandler;
+            continue;
+        }
+
+        FM_LOG_PRINT("%-20.20s %12" FM_FORMAT_64 "u %10" FM_FORMAT_64 "u "
+                     "%12" FM_FORMAT_64 "u %10" FM_FORMAT_64 "u "
+                     "%12" FM_FORMAT_64 "u %9.1f %9.1f\n",
+                     fmEventTypeToText(1 << i),
+                     entry->numEvents,
+                     entry->numMerged,
+                     entry->numDistributed,
+                     entry->numDiscarded,
+                     entry->totalTime / 1000,
+                     (double) entry->totalTime / entry->numEvents / 1000.0,
+                     entry->maxTime / 1000.0);
+    }
+
+    FM_LOG_PRINT("\n");
+
+    return FM_OK;
+
+}   /* end fmDbgDumpGlobalEventStats */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgResetGlobalEventStats
+ * \ingroup diagMisc
+ *
+ * \desc            Clears the statistics shown by
+ *                  ''fmDbgDumpGlobalEventStats''.
+ *
+ * \return          FM_OK.
+ *
+ *****************************************************************************/
+fm_status fmDbgResetGlobalEventStats(void)
+{
+    fm_globalEventType *entry;
+    fm_int              i;
+
+    for (i = 0 ; i < NUM_GLOBAL_EVENT_TYPES ; i++)
+    {
+        entry = &globalEventTypes[i];
+
+        entry->numEvents      = 0;
+        entry->numMerged      = 0;
+        entry->numDistributed = 0;
+        entry->numDiscarded   = 0;
+        entry->totalTime      = 0;
+        entry->maxTime        = 0;
+    }
+
+    return FM_OK;
+
+}   /* end fmDbgResetGlobalEventStats */
+
+
+
+
+/*****************************************************************************/
+/** fmGetEventQueueStats
+ * \ingroup diagMisc
+ *
+ * \desc            Returns the telemetry of an event queue: its depth
+ *                  histogram, the dwell time histogram of each event type,
+ *                  the number of events it refused because it was full,
+ *                  and the number of low priority event allocations that
+ *                  blocked or timed out. The telemetry is always
+ *                  maintained and cheap enough to poll, for instance to
+ *                  alert when port events back up in the global event
+ *                  handler queue.
+ *
+ * \param[in]       queueName is the name of the event queue, as shown by
+ *                  ''fmDbgEventQueueDump''. NULL selects the queue of the
+ *                  global event handler.
+ *
+ * \param[out]      stats points to caller-allocated storage where this
+ *                  function places the telemetry.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if stats is NULL.
+ * \return          FM_ERR_NOT_FOUND if there is no queue named queueName.
+ *
+ *****************************************************************************/
+fm_status fmGetEventQueueStats(fm_text queueName, fm_eventQueueStats *stats)
+{
+    fm_eventQueue *q;
+
+    if (stats == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    if (queueName == NULL)
+    {
+        q = &fmRootApi->eventThread.events;
+    }
+    else
+    {
+        q = fmDbgEventQueueFind(queueName);
+
+        if (q == NULL)
+        {
+            return FM_ERR_NOT_FOUND;
+        }
+    }
+
+    fmEventQueueGetStats(q, stats);
+
+    stats->lowPriorityBlocks =
+        FM_ATOMIC_LOAD_RELAXED(&fmRootApi->lowPriorityEventBlocks);
+    stats->lowPriorityTimeouts =
+        FM_ATOMIC_LOAD_RELAXED(&fmRootApi->lowPriorityEventTimeouts);
+
+    return FM_OK;
+
+}   /* end fmGetEventQueueStats */
+
+
+
+
+/*****************************************************************************/
+/** fmResetEventQueueStats
+ * \ingroup diagMisc
+ *
+ * \desc            Clears the telemetry returned by
+ *                  ''fmGetEventQueueStats'' for one event queue, except its
+ *                  current and highest number of events, and clears the
+ *                  low priority event allocation counters.
+ *
+ * \param[in]       queueName is the name of the event queue. NULL selects
+ *                  the queue of the global event handler.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if there is no queue named queueName.
+ *
+ *****************************************************************************/
+fm_status fmResetEventQueueStats(fm_text queueName)
+{
+    fm_eventQueue *q;
+
+    if (queueName == NULL)
+    {
+        q = &fmRootApi->eventThread.events;
+    }
+    else
+    {
+        q = fmDbgEventQueueFind(queueName);
+
+        if (q == NULL)
+        {
+            return FM_ERR_NOT_FOUND;
+        }
+    }
+
+    fmEventQueueResetStats(q);
+
+    FM_ATOMIC_STORE_RELAXED(&fmRootApi->lowPriorityEventBlocks, 0);
+    FM_ATOMIC_STORE_RELAXED(&fmRootApi->lowPriorityEventTimeouts, 0);
+
+    return FM_OK;
+
+}   /* end fmResetEventQueueStats */
+
+
+
+
+/*****************************************************************************/
+/** fmLocalEventHandler
+ * \ingroup intSwitch
+ *
+ * \desc            event handler for local dispatch thread
+ *
+ * \param[in]       args points to the thread arguments
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+void *fmLocalEventHandler(void *args)
+{
+    fm_thread *          thread;
+    fm_event *           events[FM_EVENT_BATCH_SIZE];
+    fm_eventBatchHandler batchHandler;
+    fm_timestamp         drainTimeout = { EVENT_DRAIN_TIMEOUT_SEC, 0 };
+    fm_int               numEvents;
+    fm_int               numValid;
+    fm_int               i;
+
+    /* grab arguments */
+    thread = FM_GET_THREAD_HANDLE(args);
+
+    if (fmCreateSemaphore("eventDrainedSem",
+                          FM_SEM_BINARY,
+                          &eventDrainedSem,
+                          0) == FM_OK)
+    {
+        FM_ATOMIC_STORE(&localDispatchThread, thread);
+    }
+
+    while (1)
+    {
+        if (FM_ATOMIC_LOAD(&eventNotifyFd) >= 0)
+        {
+            /**************************************************
+             * The process pulls its events with fmGetEventBatch.
+             * Signal it when events are waiting, then let it
+             * drain them.
+             **************************************************/
+
+            if (fmWaitForThreadEvent(thread, FM_WAIT_FOREVER) == FM_OK)
+            {
+                fmSignalEventNotifier(eventNotifyFd);
+                fmCaptureSemaphore(&eventDrainedSem, &drainTimeout);
+            }
+            else if (localDispatchThreadExit == TRUE)
+            {
+                break;
+            }
+
+            continue;
+        }
+
+        if (fmGetThreadEventBatch(thread,
+                                  FM_EVENT_BATCH_SIZE,
+                                  events,
+                                  &numEvents,
+                                  FM_WAIT_FOREVER) != FM_OK)
+        {
+            if (localDispatchThreadExit == TRUE)
+            {
+                break;
+            }
+            else
+            {
+                continue;
+            }
+        }
+
+        numValid = PrepareLocalEvents(events, numEvents);
+
+        /**************************************************
+         * Report the whole batch at once if the process
+         * has a batch handler, or else one event at a time.
+         **************************************************/
+
+        batchHandler = fmEventBatchHandler;
+
+        if ( (batchHandler != NULL) && (numValid > 0) )
+        {
+            batchHandler(numValid, events);
+        }
+        else if (fmEventHandler != NULL)
+        {
+            for (i = 0 ; i < numValid ; i++)
+            {
+                fmEventHandler(events[i]->type, events[i]->sw, &events[i]->info);
+            }
+        }
+
+        for (i = 0 ; i < numValid ; i++)
+        {
+            fmReleaseEvent(events[i]);
+        }
+    }
+
+    fmExitThread(thread);
+
+    return NULL;
+
+}   /* end fmLocalEventHandler */
+
+
+
+
+/*****************************************************************************/
+/** fmSetProcessEventMask
+ * \ingroup api
+ *
+ * \desc            Set which events are delivered to the current process's
+ *                  event handler function (set by ''fmInitialize'' or
+ *                  ''fmSetEventHandler'').
+ *                                                                      \lb\lb
+ *                  Multiple processes may subscribe to the same event. A
+ *                  copy of each event will be sent to all processes that
+ *                  subscribe to it.
+ *                                                                      \lb\lb
+ *                  When several processes subscribe to received packets,
+ *                  they all share the same packet buffer chain rather than
+ *                  a copy of it. Each process frees it with
+ *                  ''fmFreeBufferChain'' as usual, and it is returned to the
+ *                  pool when the last one does; the packet data must not be
+ *                  modified in place.
+ *
+ * \param[in]       mask is a logical OR of ''Event Identifiers''.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmSetProcessEventMask(fm_uint32 mask)
+{
+    fm_status         err;
+    fm_dlist_node *   node;
+    fm_uint           count = 0;
+    fm_localDelivery *delivery;
+    fm_int            myProcessId;
+    fm_uint           expectedCount;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_API, "mask=%u\n", mask);
+
+    myProcessId = fmGetCurrentProcessId();
+
+    err = fmCaptureLock(&fmRootApi->localDeliveryLock, FM_WAIT_FOREVER);
+
+    if (err == FM_OK)
+    {
+        expectedCount = fmRootApi->localDeliveryCount;
+
+        for ( node = FM_DLL_GET_FIRST( (&fmRootApi->localDeliveryThreads), head ) ;
+             node != NULL ;
+             node = FM_DLL_GET_NEXT(node, nextPtr) )
+        {
+            count++;
+            delivery = (fm_localDelivery *) node->data;
+
+            if (delivery->processId == myProcessId)
+            {
+                delivery->mask = mask;
+            }
+        }
+
+        if (count == expectedCount)
+        {
+            err = fmPublishLocalDelivery();
+        }
+
+        (void) fmReleaseLock(&fmRootApi->localDeliveryLock);
+
+        if (count != expectedCount)
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_EVENT,
+                         "Expected %d processes but found %d\n",
+                         expectedCount,
+                         count);
+            err = FM_FAIL;
+        }
+
+    }   /* end if (err == FM_OK) */
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_API, err);
+
+}   /* end fmSetProcessEventMask */
+
+
+
+
+/*****************************************************************************/
+/** fmSetProcessEventFilter
+ * \ingroup api
+ *
+ * \desc            Refine which of the events selected by
+ *                  ''fmSetProcessEventMask'' are delivered to the current
+ *                  process's event handler function:
+ *                                                                      \lb\lb
+ *                  - ''FM_EVENT_TABLE_UPDATE'' events only carry the MA
+ *                  Table updates whose update event and VLAN are selected
+ *                  by the filter, and are not delivered at all if none of
+ *                  their updates is.
+ *                                                                      \lb\lb
+ *                  - ''FM_EVENT_PKT_RECV'' and ''FM_EVENT_SFLOW_PKT_RECV''
+ *                  events are only delivered for the VLANs selected by the
+ *                  filter.
+ *                                                                      \lb\lb
+ *                  Other events are not affected. Filtering is done before
+ *                  the events are posted to the process, so filtered out
+ *                  events cost it no wakeup.
+ *
+ * \param[in]       filter points to the filter to apply, or is NULL to
+ *                  deliver all the events selected by the event mask again.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if the current process has no event
+ *                  delivery.
+ * \return          FM_ERR_NO_MEM if not enough memory is available.
+ *
+ *****************************************************************************/
+fm_status fmSetProcessEventFilter(const fm_eventFilter *filter)
+{
+    fm_status         err;
+    fm_dlist_node *   node;
+    fm_localDelivery *delivery;
+    fm_int            myProcessId;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_API, "filter=%p\n", (void *) filter);
+
+    myProcessId = fmGetCurrentProcessId();
+
+    err = fmCaptureLock(&fmRootApi->localDeliveryLock, FM_WAIT_FOREVER);
+
+    if (err == FM_OK)
+    {
+        err = FM_ERR_NOT_FOUND;
 
-            switch (switchPtr->switchModel)
+        for ( node = FM_DLL_GET_FIRST( (&fmRootApi->localDeliveryThreads), head ) ;
+             node != NULL ;
+             node = FM_DLL_GET_NEXT(node, nextPtr) )
+        {
+            delivery = (fm_localDelivery *) node->data;
+
+            if (delivery->processId == myProcessId)
             {
-                case FM_SWITCH_MODEL_SWAG:
-                    isPhysicalSwitch = FALSE;
-                    break;
+                delivery->filterEnabled = (filter != NULL);
+
+                if (filter != NULL)
+                {
+                    delivery->filter = *filter;
+                }
 
-                default:
-                    isPhysicalSwitch = TRUE;
-                    break;
+                err = FM_OK;
             }
         }
-        else
+
+        if (err == FM_OK)
         {
-            /* Only physical switches should ever get here with a NULL pointer
-             * because logical switches such as switch aggregates are always
-             * created by application code before any events related to
-             * the switch are possible.
-             */
-            isPhysicalSwitch = TRUE;
+            err = fmPublishLocalDelivery();
         }
 
-        distributeEvent = FALSE;
+        (void) fmReleaseLock(&fmRootApi->localDeliveryLock);
 
-        switch (event->type)
-        {
-            case FM_EVENT_SWITCH_INSERTED:
-                insertEvent = &event->info.fpSwitchInsertedEvent;
-                
-                if (switchIsProtected)
-                {
-                    UNPROTECT_SWITCH(sw);
-                    switchIsProtected = FALSE;
-                }
+    }   /* end if (err == FM_OK) */
 
-                if (switchPtr == NULL)
-                {
-                    if (fmHandleSwitchInserted(sw, insertEvent) != FM_OK)
-                    {
-                        /* Don't generate an insert event if there error */
-                        goto FINISHED;
-                    }
-                }
+    FM_LOG_EXIT_API(FM_LOG_CAT_API, err);
 
-                distributeEvent = TRUE;
+}   /* end fmSetProcessEventFilter */
 
-                break;
 
-            case FM_EVENT_SWITCH_REMOVED:
-                removeEvent = &event->info.fpSwitchRemovedEvent;
 
-                if (switchIsProtected)
-                {
-                    UNPROTECT_SWITCH(sw);
-                    switchIsProtected = FALSE;
-                }
 
-                if (switchPtr != NULL)
-                {
-                    fmHandleSwitchRemoved(sw, removeEvent);
-                }
+/*****************************************************************************/
+/** fmGetEventNotifyFd
+ * \ingroup api
+ *
+ * \desc            Switch the current process to pulling its events with
+ *                  ''fmGetEventBatch'', and return a file descriptor that
+ *                  becomes readable when events are waiting, so that the
+ *                  process can wait for them in its own poll/epoll loop.
+ *                                                                      \lb\lb
+ *                  Once readable, the application reads 8 bytes from the
+ *                  file descriptor to clear it, then calls
+ *                  ''fmGetEventBatch'' until it returns
+ *                  FM_ERR_NO_EVENTS_AVAILABLE. The file descriptor is
+ *                  signalled once per backlog of events, not per event.
+ *                                                                      \lb\lb
+ *                  From then on, the event handler is no longer called,
+ *                  except for events already being reported. The same
+ *                  file descriptor is returned by each call.
+ *
+ * \param[out]      fd points to caller-allocated storage where this
+ *                  function should place the file descriptor.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if fd is NULL.
+ * \return          FM_ERR_UNINITIALIZED if the process's event delivery is
+ *                  not running.
+ * \return          FM_FAIL if the file descriptor could not be created.
+ *
+ *****************************************************************************/
+fm_status fmGetEventNotifyFd(fm_int *fd)
+{
+    fm_status err;
+    fm_int    newFd;
+    fm_int    expected;
 
-                distributeEvent = TRUE;
-                break;
+    FM_LOG_ENTRY_API(FM_LOG_CAT_API, "fd=%p\n", (void *) fd);
 
-            case FM_EVENT_PORT:
-                portEvent = &event->info.fpPortEvent;
+    if (fd == NULL)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_ERR_INVALID_ARGUMENT);
+    }
 
-                if (isPhysicalSwitch && portEvent->activeMac)
-                {
-                    logicalPort = portEvent->port;
-
-                    if (switchPtr != NULL)
-                    {
-                        fmMapLogicalPortToPhysical(switchPtr,
-                                                   logicalPort,
-                                                   &physPort);
-
-                        portPtr = switchPtr->portTable[logicalPort];
-                    }
-                    else
-                    {
-                        portPtr = NULL;
-                    }
-
-                    if (portPtr == NULL)
-                    {
-                        FM_LOG_ERROR(FM_LOG_CAT_EVENT_PORT,
-                                     "Unexpected NULL port pointer for logical"
-                                     " port %d\n",
-                                     logicalPort);
-                        break;
-                    }
-
-                    /* This attribute indicate whether the API should flush
-                     * all the addresses on a port down event or not. */
-                    if (GET_PROPERTY()->maFlushOnPortDown)
-                    {
-                        /* If a link goes down for a non-LAG port, remove any
-                         * addresses associated with the port from the MA Table. */
-                        if (portEvent->linkStatus == FM_PORT_STATUS_LINK_DOWN)
-                        {
-                            if (portPtr->portType != FM_PORT_TYPE_LAG)
-                            {
-                                err = fmFlushPortAddresses(sw, portEvent->port);
-
-                                if (err != FM_OK)
-                                {
-                                    FM_LOG_WARNING(FM_LOG_CAT_EVENT_PORT,
-                                                   "%s\n",
-                                                   fmErrorMsg(err));
-                                }
-                            }
-                        }
-                    }
-
-                    FM_LOG_DEBUG( FM_LOG_CAT_EVENT_PORT,
-                                  "Port %s event reported on port %d.\n",
-                                  (portPtr != NULL )
-                                    ? ( (portPtr->linkUp) ? "UP  " : "DOWN" )
-                                    : "UNKN",
-                                  portEvent->port );
-
-                    /* inform LAG module of port state changes */
-                    if (portEvent->linkStatus == FM_PORT_STATUS_LINK_UP)
-                    {
-                        fmInformLAGPortUp(sw, portEvent->port);
-                        
-                        /* Inform LBGs of port link state change. */
-                        FM_API_CALL_FAMILY_VOID(switchPtr->InformLBGLinkChange,
-                                                sw, 
-                                                portEvent->port, 
-                                                FM_PORT_STATUS_LINK_UP);
-                    }
-                    else if (portEvent->linkStatus == FM_PORT_STATUS_LINK_DOWN)
-                    {
-                        fmInformLAGPortDown(sw, portEvent->port);
-                        
-                        /* Inform LBGs of port link state change. */
-                        FM_API_CALL_FAMILY_VOID(switchPtr->InformLBGLinkChange,
-                                                sw, 
-                                                portEvent->port, 
-                                                FM_PORT_STATUS_LINK_DOWN);
-                    }
-
-                    /* now update all the source masks */
-                    fmUpdateSwitchPortMasks(sw);
-
-                    if (switchPtr->UpdateRemoveDownPortsTrigger != NULL)
-                    {
-                        /**************************************************** 
-                         * Update the switchExt->removeDownPortsTrigger
-                         * used to drop routed/multicast/special delivery 
-                         * frames which can not be handled by the PORT_CFG_2. 
-                         * See Bugzilla 11387.
-                         ***************************************************/
-                        if (portEvent->linkStatus == FM_PORT_STATUS_LINK_UP)
-                        {
-                            switchPtr->UpdateRemoveDownPortsTrigger(sw, 
-                                                                    physPort,
-                                                                    FALSE);
-                        }
-                        else if (portEvent->linkStatus == FM_PORT_STATUS_LINK_DOWN)
-                        {
-                            if (!portPtr->isPortForceUp)
-                            {
-                                switchPtr->UpdateRemoveDownPortsTrigger(sw, 
-                                                                        physPort,
-                                                                        TRUE);
-                            }
-                        }
-                    }
-
-                    if (switchPtr->UpdateMirrorGroups != NULL)
-                    {
-                        /**************************************************** 
-                         * Enable/Disable mirror groups based on the link
-                         * status of the mirror port.
-                         * See Bugzilla 11387.
-                         ***************************************************/
-                        if (portEvent->linkStatus == FM_PORT_STATUS_LINK_UP)
-                        {
-                            switchPtr->UpdateMirrorGroups(sw, 
-                                                          logicalPort,
-                                                          TRUE);
-                        }
-                        else if (portEvent->linkStatus == FM_PORT_STATUS_LINK_DOWN)
-                        {
-                            switchPtr->UpdateMirrorGroups(sw, 
-                                                          logicalPort,
-                                                          FALSE);
-                        }
-                    }
-
-                    /* notify anyone else who needs to know */
-                    if (portPtr && portPtr->NotifyLinkEvent)
-                    {
-                        err = portPtr->NotifyLinkEvent(sw, portEvent->port);
-
-                        if (err != FM_OK)
-                        {
-                            FM_LOG_WARNING(FM_LOG_CAT_EVENT_PORT,
-                                           "%s\n",
-                                           fmErrorMsg(err));
-                        }
-                    }
-
-                    /* Get port state and notify platform */
-
-                    err = fmGetPortStateV3( sw,
-                                            portEvent->port,
-                                            portEvent->mac,
-                                            8,
-                                            &numLanes,
-                                            &mode,
-                                            &state,
-                                            info );
-
-                    if (err != FM_OK)
-                    {
-                        FM_LOG_WARNING(FM_LOG_CAT_EVENT_PORT,
-                                       "fmGetPortState(%d,%u) failed: %s\n",
-                                       sw,
-                                       portEvent->port,
-                                       fmErrorMsg(err));
-                    }
-
-                    fmPlatformNotifyPortState(sw,
-                                              portEvent->port,
-                                              portEvent->mac,
-                                              FALSE,
-                                              state);
-
-                    if (switchIsProtected)
-                    {
-                        UNPROTECT_SWITCH(sw);
-                        switchIsProtected = FALSE;
-                    }
-
-                }   /* end if (isPhysicalSwitch) */
-
-                distributeEvent = TRUE;
-                break;
+    if (FM_ATOMIC_LOAD(&localDispatchThread) == NULL)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_ERR_UNINITIALIZED);
+    }
 
-            case FM_EVENT_PKT_RECV:
-            case FM_EVENT_SFLOW_PKT_RECV:
-                fmDbgDiagCountIncr(sw, FM_CTR_RX_API_PKT_FWD, 1);
-                distributeEvent = TRUE;
-                break;
+    if (FM_ATOMIC_LOAD(&eventNotifyFd) < 0)
+    {
+        err = fmCreateEventNotifier(&newFd);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_API, err);
 
-            case FM_EVENT_PURGE_SCAN_COMPLETE:
-                distributeEvent = TRUE;
-                break; 
+        expected = -1;
 
-            case FM_EVENT_TABLE_UPDATE:
-                if (switchPtr == NULL)
-                {
-                    break;
-                }
+        if ( !FM_ATOMIC_CAS(&eventNotifyFd, &expected, newFd) )
+        {
+            /* Another thread created it first */
+            fmDestroyEventNotifier(newFd);
+        }
+        else
+        {
+            /* Let the application check for events already waiting */
+            fmSignalEventNotifier(newFd);
+        }
+    }
 
-                /* Update diagnostic counters. */
-                updateEvent = &event->info.fpUpdateEvent;
-                i = 0;
+    *fd = FM_ATOMIC_LOAD(&eventNotifyFd);
 
-                while (i < updateEvent->numUpdates)
-                {
-                    fpUpdateEvent = &updateEvent->updates[i];
-
-                    if (fpUpdateEvent->event == FM_EVENT_ENTRY_LEARNED)
-                    {
-                        /* Make sure the MA Table entry matches the entry
-                         * in the update event. */
-                        if (switchPtr->RemoveStaleLearnEvent != NULL &&
-                            switchPtr->RemoveStaleLearnEvent(sw, updateEvent, i))
-                        {
-                            /* The learn event has been removed.
-                             * Do not update 'i', since it now contains the 
-                             * following event (if any). */
-                            fmDbgDiagCountIncr(sw, FM_CTR_MAC_LEARN_DISCARDED, 1);
-                        }
-                        else
-                        {
-                            fmDbgDiagCountIncr(sw, FM_CTR_MAC_ALPS_LEARN, 1);
-                            i++;
-                        }
-                    }
-                    else
-                    {
-                        if (fpUpdateEvent->event == FM_EVENT_ENTRY_AGED)
-                        {
-                            fmDbgDiagCountIncr(sw, FM_CTR_MAC_ALPS_AGE, 1);
-                        }
-                        i++;
-                    }
-                }
+    FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_OK);
 
-                /* If all updates have been removed, don't distribute the
-                   event */
-                if (updateEvent->numUpdates > 0)
-                {
-                    distributeEvent = TRUE;
-                }
-                break;
+}   /* end fmGetEventNotifyFd */
 
-            case FM_EVENT_SECURITY:
-            case FM_EVENT_FRAME:
-            case FM_EVENT_SOFTWARE:
-            case FM_EVENT_PARITY_ERROR:
-            case FM_EVENT_FIBM_THRESHOLD:
-            case FM_EVENT_CRM:
-            case FM_EVENT_ARP:
-            case FM_EVENT_EGRESS_TIMESTAMP:
-            case FM_EVENT_PLATFORM:
-            case FM_EVENT_LOGICAL_PORT:
-            case FM_EVENT_CABLE_MISMATCH:
-                distributeEvent = TRUE;
-                break;
 
-            default:
-                FM_LOG_WARNING(FM_LOG_CAT_EVENT_PORT,
-                               "Received unknown event %d\n",
-                               event->type);
-                break;
 
-        }   /* end switch (event->type) */
 
-        if (distributeEvent)
-        {
-            if (switchIsProtected)
-            {
-                UNPROTECT_SWITCH(sw);
-                switchIsProtected = FALSE;
-            }
+/*****************************************************************************/
+/** fmGetEventBatch
+ * \ingroup api
+ *
+ * \desc            Pull up to maxEvents events delivered to the current
+ *                  process, without waiting, once it has switched to
+ *                  pulling its events with ''fmGetEventNotifyFd''.
+ *                                                                      \lb\lb
+ *                  The application must call ''fmReleaseEvent'' on each
+ *                  returned event when done with it, and dispose of the
+ *                  ''fm_buffer'' chain of received packet events as it
+ *                  would in an ''fm_eventHandler''.
+ *
+ * \param[in]       maxEvents is the number of entries in events.
+ *
+ * \param[out]      events points to a caller-allocated array of maxEvents
+ *                  entries where this function places the events, in the
+ *                  order in which they were reported.
+ *
+ * \param[out]      numEvents points to caller-allocated storage where this
+ *                  function places the number of events returned.
+ *
+ * \return          FM_OK if at least one event was returned.
+ * \return          FM_ERR_NO_EVENTS_AVAILABLE if no event is waiting.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_UNINITIALIZED if the process does not pull its
+ *                  events.
+ *
+ *****************************************************************************/
+fm_status fmGetEventBatch(fm_int maxEvents, fm_event **events, fm_int *numEvents)
+{
+    fm_thread *thread;
+    fm_status  err;
+    fm_int     numPulled;
 
-            if (eventHandler != NULL)
-            {
-                if (enableFramePriority && 
-                    ( (event->type == FM_EVENT_PKT_RECV) ||
-                      (event->type == FM_EVENT_SFLOW_PKT_RECV) ) )
-                {
-                    rcvPktEvent = &event->info.fpPktEvent;
-                    err = fmFreeBufferQueueNode(sw, rcvPktEvent);
-                    if (err != FM_OK)
-                    {
-                        FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
-                                     "Freeing Buffer queue node from the queue failed"
-                                     "status = %d (%s) \n",
-                                      err,
-                                      fmErrorMsg(err));
-
-                    }
-                }
+    FM_LOG_ENTRY_API(FM_LOG_CAT_API,
+                     "maxEvents=%d events=%p numEvents=%p\n",
+                     maxEvents,
+                     (void *) events,
+                     (void *) numEvents);
 
-                eventHandler(event);
-            }
-            else
-            {
-                fmDistributeEvent(event);
-            }
-        }
+    if ( (events == NULL) || (numEvents == NULL) || (maxEvents <= 0) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_ERR_INVALID_ARGUMENT);
+    }
 
-FINISHED:
+    *numEvents = 0;
+    thread     = FM_ATOMIC_LOAD(&localDispatchThread);
 
-        fmReleaseEvent(event);
+    if ( (thread == NULL) || (FM_ATOMIC_LOAD(&eventNotifyFd) < 0) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_ERR_UNINITIALIZED);
+    }
 
-        /* release the switch lock if any is held */
-        if (switchIsProtected)
-        {
-            UNPROTECT_SWITCH(sw);
-        }
+    do
+    {
+        err = fmEventQueueGetMultiple(&thread->events,
+                                      maxEvents,
+                                      events,
+                                      &numPulled);
 
-    }   /* end while (1) */
+        *numEvents = PrepareLocalEvents(events, numPulled);
+    }
+    while ( (*numEvents == 0) && (numPulled > 0) );
 
-    fmExitThread(thread);
+    if (numPulled < maxEvents)
+    {
+        /* The queue is empty, let the dispatch thread watch it again */
+        fmSignalSemaphore(&eventDrainedSem);
+    }
 
-    return NULL;
+    if ( (err == FM_OK) && (*numEvents == 0) )
+    {
+        err = FM_ERR_NO_EVENTS_AVAILABLE;
+    }
 
-}   /* end fmGlobalEventHandler */
+    FM_LOG_EXIT_API(FM_LOG_CAT_API, err);
+
+}   /* end fmGetEventBatch */
 
 
 
 
 /*****************************************************************************/
-/** fmLocalEventHandler
- * \ingroup intSwitch
+/** fmSetPacketQueueCount
+ * \ingroup api
  *
- * \desc            event handler for local dispatch thread
+ * \desc            Spread the ''FM_EVENT_PKT_RECV'' and
+ *                  ''FM_EVENT_SFLOW_PKT_RECV'' events delivered to the
+ *                  current process over numQueues packet queues, so that
+ *                  each worker thread of the application can consume its
+ *                  own queue with ''fmGetPacketQueueBatch''.
+ *                                                                      \lb\lb
+ *                  A packet is steered by a hash of its flow: addresses,
+ *                  protocol and TCP/UDP ports for IPv4 and IPv6 frames,
+ *                  VLAN and MAC addresses for other frames. The packets of
+ *                  a flow therefore go to the same queue, in the order in
+ *                  which they were received. Packets are steered after
+ *                  ''fmSetProcessEventMask'' and ''fmSetProcessEventFilter''
+ *                  have been applied, and are no longer reported to the
+ *                  event handler nor by ''fmGetEventBatch''. A process
+ *                  pulling its events must keep calling ''fmGetEventBatch''
+ *                  from a single thread for its packets to be steered.
+ *                                                                      \lb\lb
+ *                  Each queue holds ''FM_PACKET_QUEUE_MAX_EVENTS'' events;
+ *                  packets steered to a full queue are dropped and counted,
+ *                  see ''fmGetPacketQueueDepth''.
+ *                                                                      \lb\lb
+ *                  The packet queues can only be set up once per process.
  *
- * \param[in]       args points to the thread arguments
+ * \param[in]       numQueues is the number of packet queues, from 1 to
+ *                  ''FM_MAX_PACKET_QUEUES''.
  *
- * \return          Nothing.
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if numQueues is out of range.
+ * \return          FM_ERR_INVALID_STATE if the packet queues are already
+ *                  set up.
+ * \return          FM_ERR_NO_MEM if the queues could not be allocated.
+ * \return          FM_FAIL if a file descriptor could not be created.
  *
  *****************************************************************************/
-void *fmLocalEventHandler(void *args)
+fm_status fmSetPacketQueueCount(fm_int numQueues)
 {
-    fm_thread *thread;
-    fm_event * event;
-    fm_status  status;
+    fm_status err = FM_OK;
+    fm_char   name[32];
+    fm_int    expected;
+    fm_int    i;
 
-    /* grab arguments */
-    thread = FM_GET_THREAD_HANDLE(args);
+    FM_LOG_ENTRY_API(FM_LOG_CAT_API, "numQueues=%d\n", numQueues);
 
-    while (1)
+    if ( (numQueues < 1) || (numQueues > FM_MAX_PACKET_QUEUES) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    expected = 0;
+
+    if ( !FM_ATOMIC_CAS(&numPacketQueues, &expected, -1) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_ERR_INVALID_STATE);
+    }
+
+    for (i = 0 ; i < numQueues ; i++)
     {
-        if (fmGetThreadEvent(thread, &event, FM_WAIT_FOREVER) != FM_OK)
+        FM_SNPRINTF_S(name, sizeof(name), "packetQueue%d", i);
+
+        err = fmEventQueueInitializeV2(&packetQueues[i],
+                                       FM_PACKET_QUEUE_MAX_EVENTS,
+                                       name,
+                                       FM_EVENT_QUEUE_FLAG_RING);
+        if (err != FM_OK)
         {
-            if (localDispatchThreadExit == TRUE)
-            {
-                break;
-            }
-            else
-            {
-                continue;
-            }
+            break;
         }
 
-        if (enableFramePriority &&
-            ( (event->type == FM_EVENT_PKT_RECV) ||
-              (event->type == FM_EVENT_SFLOW_PKT_RECV) ) )
+        err = fmCreateEventNotifier(&packetQueueFds[i]);
+        if (err != FM_OK)
         {
-            status = fmFreeBufferQueueNode(FM_FIRST_FOCALPOINT, &event->info.fpPktEvent);
-            if (status != FM_OK)
-            {
-                FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
-                             "Freeing Buffer queue node from the queue failed"
-                             "status = %d (%s) \n",
-                              status,
-                              fmErrorMsg(status));
-
-                fmReleaseEvent(event);
-                continue;
-            }
+            fmEventQueueDestroy(&packetQueues[i]);
+            break;
         }
-        
-        if (fmEventHandler != NULL)
+
+        packetQueueDrops[i] = 0;
+    }
+
+    if (err != FM_OK)
+    {
+        while (--i >= 0)
         {
-            fmEventHandler(event->type, event->sw, &event->info);
+            fmDestroyEventNotifier(packetQueueFds[i]);
+            fmEventQueueDestroy(&packetQueues[i]);
         }
 
-        fmReleaseEvent(event);
+        FM_ATOMIC_STORE(&numPacketQueues, 0);
+        FM_LOG_EXIT_API(FM_LOG_CAT_API, err);
     }
 
-    fmExitThread(thread);
+    /* Publish the queues to the thread reporting the events */
+    FM_ATOMIC_STORE(&numPacketQueues, numQueues);
 
-    return NULL;
+    FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_OK);
 
-}   /* end fmLocalEventHandler */
+}   /* end fmSetPacketQueueCount */
 
 
 
 
 /*****************************************************************************/
-/** fmSetProcessEventMask
+/** fmGetPacketQueueNotifyFd
  * \ingroup api
  *
- * \desc            Set which events are delivered to the current process's
- *                  event handler function (set by ''fmInitialize'' or
- *                  ''fmSetEventHandler'').
+ * \desc            Return a file descriptor that becomes readable when
+ *                  packets are steered to a packet queue set up with
+ *                  ''fmSetPacketQueueCount''.
  *                                                                      \lb\lb
- *                  Multiple processes may subscribe to the same event. A
- *                  copy of each event will be sent to all processes that
- *                  subscribe to it.
+ *                  Once readable, the worker reads 8 bytes from the file
+ *                  descriptor to clear it, then calls
+ *                  ''fmGetPacketQueueBatch'' until it returns
+ *                  FM_ERR_NO_EVENTS_AVAILABLE.
  *
- * \param[in]       mask is a logical OR of ''Event Identifiers''.
+ * \param[in]       queue is the packet queue.
+ *
+ * \param[out]      fd points to caller-allocated storage where this
+ *                  function should place the file descriptor.
  *
  * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if queue is out of range or fd
+ *                  is NULL.
  *
  *****************************************************************************/
-fm_status fmSetProcessEventMask(fm_uint32 mask)
+fm_status fmGetPacketQueueNotifyFd(fm_int queue, fm_int *fd)
 {
-    fm_status         err;
-    fm_dlist_node *   node;
-    fm_uint           count = 0;
-    fm_localDelivery *delivery;
-    fm_int            myProcessId;
-    fm_uint           expectedCount;
+    FM_LOG_ENTRY_API(FM_LOG_CAT_API, "queue=%d fd=%p\n", queue, (void *) fd);
 
-    FM_LOG_ENTRY_API(FM_LOG_CAT_API, "mask=%u\n", mask);
+    if ( (fd == NULL) ||
+         (queue < 0) ||
+         (queue >= FM_ATOMIC_LOAD(&numPacketQueues)) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_ERR_INVALID_ARGUMENT);
+    }
 
-    myProcessId = fmGetCurrentProcessId();
+    *fd = packetQueueFds[queue];
 
-    err = fmCaptureLock(&fmRootApi->localDeliveryLock, FM_WAIT_FOREVER);
+    FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_OK);
 
-    if (err == FM_OK)
-    {
-        expectedCount = fmRootApi->localDeliveryCount;
+}   /* end fmGetPacketQueueNotifyFd */
 
-        for ( node = FM_DLL_GET_FIRST( (&fmRootApi->localDeliveryThreads), head ) ;
-             node != NULL ;
-             node = FM_DLL_GET_NEXT(node, nextPtr) )
-        {
-            count++;
-            delivery = (fm_localDelivery *) node->data;
 
-            if (delivery->processId == myProcessId)
-            {
-                delivery->mask = mask;
-            }
-        }
 
-        err = fmReleaseLock(&fmRootApi->localDeliveryLock);
 
-        if (count != expectedCount)
-        {
-            FM_LOG_ERROR(FM_LOG_CAT_EVENT,
-                         "Expected %d processes but found %d\n",
-                         expectedCount,
-                         count);
-            err = FM_FAIL;
-        }
+/*****************************************************************************/
+/** fmGetPacketQueueBatch
+ * \ingroup api
+ *
+ * \desc            Pull up to maxEvents received packet events from a
+ *                  packet queue set up with ''fmSetPacketQueueCount'',
+ *                  without waiting.
+ *                                                                      \lb\lb
+ *                  Each queue is meant to be consumed by a single worker
+ *                  thread, which must call ''fmReleaseEvent'' on each
+ *                  returned event when done with it, and dispose of its
+ *                  ''fm_buffer'' chain as it would in an ''fm_eventHandler''.
+ *
+ * \param[in]       queue is the packet queue.
+ *
+ * \param[in]       maxEvents is the number of entries in events.
+ *
+ * \param[out]      events points to a caller-allocated array of maxEvents
+ *                  entries where this function places the events, in the
+ *                  order in which they were steered to the queue.
+ *
+ * \param[out]      numEvents points to caller-allocated storage where this
+ *                  function places the number of events returned.
+ *
+ * \return          FM_OK if at least one event was returned.
+ * \return          FM_ERR_NO_EVENTS_AVAILABLE if the queue is empty.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ *
+ *****************************************************************************/
+fm_status fmGetPacketQueueBatch(fm_int     queue,
+                                fm_int     maxEvents,
+                                fm_event **events,
+                                fm_int *   numEvents)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_API,
+                     "queue=%d maxEvents=%d events=%p numEvents=%p\n",
+                     queue,
+                     maxEvents,
+                     (void *) events,
+                     (void *) numEvents);
+
+    if ( (events == NULL) ||
+         (numEvents == NULL) ||
+         (maxEvents <= 0) ||
+         (queue < 0) ||
+         (queue >= FM_ATOMIC_LOAD(&numPacketQueues)) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_ERR_INVALID_ARGUMENT);
+    }
 
-    }   /* end if (err == FM_OK) */
+    err = fmEventQueueGetMultiple(&packetQueues[queue],
+                                  maxEvents,
+                                  events,
+                                  numEvents);
+
+    if ( (err == FM_OK) && (*numEvents == 0) )
+    {
+        err = FM_ERR_NO_EVENTS_AVAILABLE;
+    }
 
     FM_LOG_EXIT_API(FM_LOG_CAT_API, err);
 
-}   /* end fmSetProcessEventMask */
+}   /* end fmGetPacketQueueBatch */
+
+
+
+
+/*****************************************************************************/
+/** fmGetPacketQueueDepth
+ * \ingroup api
+ *
+ * \desc            Return the number of events waiting in a packet queue
+ *                  set up with ''fmSetPacketQueueCount'', and the number of
+ *                  packets dropped because it was full.
+ *
+ * \param[in]       queue is the packet queue.
+ *
+ * \param[out]      depth points to caller-allocated storage where this
+ *                  function places the number of waiting events.
+ *
+ * \param[out]      dropped points to caller-allocated storage where this
+ *                  function places the number of dropped packets, or is
+ *                  NULL.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ *
+ *****************************************************************************/
+fm_status fmGetPacketQueueDepth(fm_int queue, fm_int *depth, fm_uint64 *dropped)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_API,
+                     "queue=%d depth=%p dropped=%p\n",
+                     queue,
+                     (void *) depth,
+                     (void *) dropped);
+
+    if ( (depth == NULL) ||
+         (queue < 0) ||
+         (queue >= FM_ATOMIC_LOAD(&numPacketQueues)) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    err = fmEventQueueCount(&packetQueues[queue], depth);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_API, err);
+
+    if (dropped != NULL)
+    {
+        *dropped = FM_ATOMIC_LOAD_RELAXED(&packetQueueDrops[queue]);
+    }
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_OK);
+
+}   /* end fmGetPacketQueueDepth */
 
 
 
@@ -1049,6 +3220,8 @@ fm_status fmRemoveEventHandler(fm_localDelivery ** delivery)
             fmDListRemove(&fmRootApi->localDeliveryThreads, node);
             *delivery = cur;
             fmRootApi->localDeliveryCount--;
+
+            err = fmPublishLocalDelivery();
         }
         else
         {
@@ -1140,6 +3313,9 @@ const char * fmEventTypeToText(fm_int eventType)
         case FM_EVENT_LOGICAL_PORT:
             return "LOGICAL_PORT";
 
+        case FM_EVENT_FLOW_AGED:
+            return "FLOW_AGED";
+
         default:
             return "UNKNOWN";
 
@@ -1179,6 +3355,9 @@ const char * fmUpdateTypeToText(fm_int updateType)
         case FM_EVENT_ENTRY_MEMORY_ERROR:
             return "MEMORY_ERROR";
 
+        case FM_EVENT_ENTRY_LEARN_THROTTLED:
+            return "LEARN_THROTTLED";
+
         default:
             return "UNKNOWN";
 
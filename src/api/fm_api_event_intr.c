@@ -57,6 +57,189 @@
  *****************************************************************************/
 
 
+/*****************************************************************************
+ * PollInterrupts
+ *
+ * Description: Keeps calling the chip specific interrupt handler of a
+ *              switch whose interrupt is still masked, so that a burst of
+ *              interrupts is handled without re-enabling the interrupt
+ *              for each of them.
+ *
+ * Arguments:   sw is the switch on which to operate.
+ *
+ *              pollTime is the polling window requested by the first
+ *              pass, in microseconds.
+ *
+ * Returns:     None.
+ *
+ * Polling stops when a window elapses without any pass requesting more
+ * polling, or after api.intr.pollBudget passes. The passes are spaced by
+ * api.intr.pollInterval microseconds, during which the switch is not
+ * protected.
+ *
+ *****************************************************************************/
+static void PollInterrupts(fm_int sw, fm_uint pollTime)
+{
+    fm_switch *switchPtr;
+    fm_uint64  deadline;
+    fm_uint64  now;
+    fm_int     budget;
+    fm_int     interval;
+    fm_int     pass;
+
+    budget   = GET_PROPERTY()->intrPollBudget;
+    interval = GET_PROPERTY()->intrPollInterval;
+
+    if (budget <= 0)
+    {
+        return;
+    }
+
+    if (interval < 0)
+    {
+        interval = 0;
+    }
+
+    fmDbgDiagCountIncr(sw, FM_CTR_INTR_POLL_START, 1);
+
+    deadline = fmGetMonotonicNsec() + (fm_uint64) pollTime * 1000;
+
+    for (pass = 0 ; pass < budget ; pass++)
+    {
+        fmDelay(interval / 1000000, (interval % 1000000) * 1000);
+
+        PROTECT_SWITCH(sw);
+
+        if ( (fmRootApi->fmSwitchStateTable[sw] == NULL)
+            || !FM_IS_STATE_ALIVE(fmRootApi->fmSwitchStateTable[sw]->state) )
+        {
+            UNPROTECT_SWITCH(sw);
+            break;
+        }
+
+        switchPtr = fmRootApi->fmSwitchStateTable[sw];
+
+        switchPtr->InterruptHandler(switchPtr);
+
+        pollTime = switchPtr->intrPollTime;
+
+        UNPROTECT_SWITCH(sw);
+
+        fmDbgDiagCountIncr(sw, FM_CTR_INTR_POLL_PASS, 1);
+
+        now = fmGetMonotonicNsec();
+
+        if (pollTime > 0)
+        {
+            /* More moderated work, restart the window */
+            fmDbgDiagCountIncr(sw, FM_CTR_INTR_POLL_HIT, 1);
+            deadline = now + (fm_uint64) pollTime * 1000;
+        }
+        else if (now >= deadline)
+        {
+            break;
+        }
+
+    }   /* end for (pass = 0 ; pass < budget ; pass++) */
+
+}   /* end PollInterrupts */
+
+
+
+
+/*****************************************************************************
+ * HandleSwitchInterrupt
+ *
+ * Description: Handles the pending interrupt sources of one switch.
+ *
+ * Arguments:   sw is the switch on which to operate.
+ *
+ * Returns:     None.
+ *
+ * Calls the chip specific interrupt handler, then polls the switch if the
+ * handler asked for it and re-enables the interrupt if it was triggered by
+ * the ISR.
+ *
+ *****************************************************************************/
+static void HandleSwitchInterrupt(fm_int sw)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+    fm_uint    intrSource;
+    fm_uint    pollTime;
+
+    if (!SWITCH_LOCK_EXISTS(sw))
+    {
+        return;
+    }
+
+    err = fmPlatformGetInterrupt(sw,
+                                 FM_INTERRUPT_SOURCE_ISR,
+                                 &intrSource);
+
+    if (err != FM_OK)
+    {
+        FM_LOG_FATAL( FM_LOG_CAT_EVENT_INTR, "%s\n", fmErrorMsg(err) );
+
+        return;
+    }
+
+    if (intrSource == FM_INTERRUPT_SOURCE_NONE)
+    {
+        return;
+    }
+
+    FM_LOG_DEBUG(FM_LOG_CAT_EVENT_INTR, "Interrupt seen (source 0x%x)\n",
+                 intrSource);
+
+    PROTECT_SWITCH(sw);
+
+    /* If the switch is not up yet, keep going */
+    if ( (fmRootApi->fmSwitchStateTable[sw] == NULL)
+        || !FM_IS_STATE_ALIVE(fmRootApi->fmSwitchStateTable[sw]->state) )
+    {
+        FM_LOG_DEBUG(FM_LOG_CAT_SWITCH,
+                     "Switch %d is not up, ignoring interrupts\n",
+                     sw);
+
+        UNPROTECT_SWITCH(sw);
+
+        return;
+    }
+
+    switchPtr = fmRootApi->fmSwitchStateTable[sw];
+
+    /* Call the chip specific handler */
+    switchPtr->InterruptHandler(switchPtr);
+
+    pollTime = switchPtr->intrPollTime;
+
+    UNPROTECT_SWITCH(sw);
+
+    if (intrSource & FM_INTERRUPT_SOURCE_ISR)
+    {
+        /* Poll for further work before unmasking */
+        if (pollTime > 0)
+        {
+            PollInterrupts(sw, pollTime);
+        }
+
+        /* Re-enable the interrupt */
+        err = fmPlatformEnableInterrupt(sw, intrSource);
+
+        if (err != FM_OK)
+        {
+            FM_LOG_FATAL( FM_LOG_CAT_EVENT_INTR, "%s\n", fmErrorMsg(err) );
+        }
+
+    }   /* end if (intrSource & FM_INTERRUPT_SOURCE_ISR) */
+
+}   /* end HandleSwitchInterrupt */
+
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -78,15 +261,15 @@
  * handler.
  *
  * Then, if the interrupt was triggered by the ISR, the task will
- * re-enable the interrupt.
+ * re-enable the interrupt. If the chip specific handler asked for
+ * polling, the interrupt is left masked while the task polls the switch
+ * (see PollInterrupts), and is re-enabled afterwards.
  *
  *****************************************************************************/
 void *fmInterruptHandler(void *args)
 {
     fm_int     sw;
-    fm_switch *switchPtr;
     fm_status  err;
-    fm_uint    intrSource;
     fm_int     handleFibmSlave;
 
     /* There is a duplicate interrupt handler thread if FIBM is enabled
@@ -135,68 +318,73 @@ void *fmInterruptHandler(void *args)
                 continue;
             }
 
-            if (!SWITCH_LOCK_EXISTS(sw))
-            {
-                continue;
-            }
+            HandleSwitchInterrupt(sw);
 
-            err = fmPlatformGetInterrupt(sw,
-                                         FM_INTERRUPT_SOURCE_ISR,
-                                         &intrSource);
+        }   /* end for (sw = FM_FIRST_FOCALPOINT ; sw <= FM_LAST_FOCALPOINT ; sw++) */
 
+    }   /* end while (TRUE) */
 
-            if (err != FM_OK)
-            {
-                FM_LOG_FATAL( FM_LOG_CAT_EVENT_INTR, "%s\n", fmErrorMsg(err) );
+    /**************************************************
+     * Should never exit.
+     **************************************************/
 
-                continue;
-            }
+    FM_LOG_FATAL(FM_LOG_CAT_EVENT_INTR, "Task exiting inadvertently!\n");
 
-            if (intrSource == FM_INTERRUPT_SOURCE_NONE)
-            {
-                continue;
-            }
+    return NULL;
 
-            FM_LOG_DEBUG(FM_LOG_CAT_EVENT_INTR, "Interrupt seen (source 0x%x)\n",
-                         intrSource);
+}   /* end fmInterruptHandler */
 
-            PROTECT_SWITCH(sw);
 
-            /* If the switch is not up yet, keep going */
-            if ( (fmRootApi->fmSwitchStateTable[sw] == NULL)
-                || !FM_IS_STATE_ALIVE(fmRootApi->fmSwitchStateTable[sw]->state) )
-            {
-                FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, 
-                             "Switch %d is not up, ignoring interrupts\n",
-                             sw);
 
-                UNPROTECT_SWITCH(sw);
 
-                continue;
-            }
+/*****************************************************************************
+ * fmSwitchInterruptHandler
+ *
+ * Description: Interrupt handler task serving a single switch, used when
+ *              api.perSwitchTasks is enabled.
+ *
+ * Arguments:   args is a pointer to the thread information, whose parameter
+ *              is the fm_switchTasks of the switch.
+ *
+ * Returns:     None.
+ *
+ * This task wakes up on the interrupt semaphore of its switch, so an
+ * interrupt burst on one switch does not delay the other switches.
+ * Remote (FIBM slave) switches are left to the FIBM interrupt handler.
+ *
+ *****************************************************************************/
+void *fmSwitchInterruptHandler(void *args)
+{
+    fm_switchTasks *tasks;
+    fm_status       err;
+    fm_int          sw;
 
-            switchPtr = fmRootApi->fmSwitchStateTable[sw];
+    tasks = FM_GET_THREAD_PARAM(fm_switchTasks, args);
+    sw    = tasks->sw;
 
-            /* Call the chip specific handler */
-            switchPtr->InterruptHandler(switchPtr);
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_INTR, "sw=%d\n", sw);
 
-            UNPROTECT_SWITCH(sw);
+    while (TRUE)
+    {
+        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_INTR,
+                     "Waiting for interrupt on switch %d..\n",
+                     sw);
 
-            if (intrSource & FM_INTERRUPT_SOURCE_ISR)
-            {
-                /* Re-enable the interrupt */
-                err = fmPlatformEnableInterrupt(sw, intrSource);
+        err = fmWaitSemaphore(&tasks->intrAvail, FM_WAIT_FOREVER);
 
-                if (err != FM_OK)
-                {
-                    FM_LOG_FATAL( FM_LOG_CAT_EVENT_INTR, "%s\n", fmErrorMsg(err) );
+        if (err != FM_OK)
+        {
+            FM_LOG_FATAL( FM_LOG_CAT_EVENT_INTR, "%s\n", fmErrorMsg(err) );
 
-                    continue;
-                }
+            continue;
+        }
 
-            }   /* end if (intrSource & FM_INTERRUPT_SOURCE_ISR) */
+        if (fmRootApi->isSwitchFibmSlave[sw])
+        {
+            continue;
+        }
 
-        }   /* end for (sw = FM_FIRST_FOCALPOINT ; sw <= FM_LAST_FOCALPOINT ; sw++) */
+        HandleSwitchInterrupt(sw);
 
     }   /* end while (TRUE) */
 
@@ -208,7 +396,7 @@ void *fmInterruptHandler(void *args)
 
     return NULL;
 
-}   /* end fmInterruptHandler */
+}   /* end fmSwitchInterruptHandler */
 
 
 
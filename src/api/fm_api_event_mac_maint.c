@@ -357,15 +357,11 @@ static void UpdateWorkStatistics(fm_int sw, fm_addrMaintWorkList* workList)
 
 
 
-/*****************************************************************************
- * Public Functions
- *****************************************************************************/
-
 /*****************************************************************************/
-/** fmTableMaintenanceHandler
+/** TableMaintenanceLoop
  * \ingroup intMacMaint
  *
- * \desc            This task runs in its own thread, reading the entire
+ * \desc            This loop runs in its own thread, reading the entire
  *                  MA Table, synchronizing the cached table with the
  *                  hardware and reporting changes to the application
  *                  as an update.
@@ -391,15 +387,26 @@ static void UpdateWorkStatistics(fm_int sw, fm_addrMaintWorkList* workList)
  *                  * When a VLAN is deleted, all table entries on that
  *                    VLAN must be deleted.
  *
- * \param[in]       args contains the pointer to the thread argument array
+ * \param[in]       thread is the thread running the loop.
+ *
+ * \param[in]       eventHandler is the global event handler thread.
+ *
+ * \param[in]       firstSw is the first switch served by the thread.
+ *
+ * \param[in]       lastSw is the last switch served by the thread.
+ *
+ * \param[in]       maintSem is the semaphore signaled when there is
+ *                  maintenance work for the served switches.
  *
  * \return          None.
  *
  *****************************************************************************/
-void *fmTableMaintenanceHandler(void *args)
+static void *TableMaintenanceLoop(fm_thread *   thread,
+                                  fm_thread *   eventHandler,
+                                  fm_int        firstSw,
+                                  fm_int        lastSw,
+                                  fm_semaphore *maintSem)
 {
-    fm_thread *           thread;
-    fm_thread *           eventHandler;
     fm_int                sw;
     fm_switch *           switchPtr;
     fm_bool               swIsProtected;
@@ -428,23 +435,24 @@ void *fmTableMaintenanceHandler(void *args)
         maintTimeoutPtr = FM_WAIT_FOREVER;
     }
 
-    /* grab arguments */
-    thread       = FM_GET_THREAD_HANDLE(args);
-    eventHandler = FM_GET_THREAD_PARAM(fm_thread, args);
-
     FM_LOG_ENTRY(FM_LOG_CAT_EVENT_MAC_MAINT,
-                 "thread = %s, eventHandler = %s\n",
+                 "thread = %s, eventHandler = %s, switches %d..%d\n",
                  thread->name,
-                 eventHandler->name);
+                 eventHandler->name,
+                 firstSw,
+                 lastSw);
 
     /* clear the maintenance statistics */
-    FM_CLEAR(fmRootApi->macTableMaintMaxTasks);
+    for (sw = firstSw ; sw <= lastSw ; sw++)
+    {
+        fmRootApi->macTableMaintMaxTasks[sw] = 0;
+    }
 
     /**************************************************
      * Main task loop.
      **************************************************/
 
-    sw = FM_FIRST_FOCALPOINT - 1;
+    sw = firstSw - 1;
     swIsProtected = FALSE;
 #if FM_SUPPORT_SWAG
     aggSwIsProtected = FALSE;
@@ -479,7 +487,7 @@ void *fmTableMaintenanceHandler(void *args)
 
         if (lockUsage != NULL)
         {
-            if ( (sw >= FM_FIRST_FOCALPOINT) && (lockUsage[sw] != 0) )
+            if ( (sw >= firstSw) && (lockUsage[sw] != 0) )
             {
                 FM_LOG_ERROR(FM_LOG_CAT_EVENT_MAC_MAINT,
                              "switch %d still holding a lock, usage=0x%X\n",
@@ -502,12 +510,12 @@ void *fmTableMaintenanceHandler(void *args)
          * all switches have been checked.  If back to the first switch,
          * wait for something to do or for a timeout before looping through
          * all switches again. */
-        if (++sw > FM_LAST_FOCALPOINT)
+        if (++sw > lastSw)
         {
-            sw = FM_FIRST_FOCALPOINT;
+            sw = firstSw;
         }
 
-        if (sw == FM_FIRST_FOCALPOINT)
+        if (sw == firstSw)
         {
             /*******************************************************
              * we will at least wait for FM_MA_TABLE_MAINT_THROTTLE
@@ -518,8 +526,7 @@ void *fmTableMaintenanceHandler(void *args)
             fmDelay(FM_API_MAC_TABLE_MAINT_THROTTLE, 0);
 
             /* wait for something to do, time out as often as configured */
-            err = fmWaitSemaphore(&fmRootApi->macTableMaintSemaphore,
-                                  maintTimeoutPtr);
+            err = fmWaitSemaphore(maintSem, maintTimeoutPtr);
             if ( (err != FM_OK) && (err != FM_ERR_SEM_TIMEOUT) )
             {
                 FM_LOG_ERROR( FM_LOG_CAT_EVENT_MAC_MAINT,
@@ -682,7 +689,10 @@ AGAIN:
         }
 
         /**************************************************
-         * Service the purge request queue.
+         * Service the purge request queue. A purge that
+         * uses up its slice budget requests another pass
+         * and resumes there, after the switch has been
+         * released below.
          **************************************************/
 
         if ((workList->maintFlags & FM_MAC_MAINT_HANDLE_PURGE) &&
@@ -774,11 +784,80 @@ AGAIN:
 
     return NULL;
 
+}   /* end TableMaintenanceLoop */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fmTableMaintenanceHandler
+ * \ingroup intMacMaint
+ *
+ * \desc            MAC table maintenance task serving all the switches in
+ *                  turn. See TableMaintenanceLoop.
+ *
+ * \param[in]       args contains the pointer to the thread argument array
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void *fmTableMaintenanceHandler(void *args)
+{
+    fm_thread *thread;
+    fm_thread *eventHandler;
+
+    /* grab arguments */
+    thread       = FM_GET_THREAD_HANDLE(args);
+    eventHandler = FM_GET_THREAD_PARAM(fm_thread, args);
+
+    return TableMaintenanceLoop(thread,
+                                eventHandler,
+                                FM_FIRST_FOCALPOINT,
+                                FM_LAST_FOCALPOINT,
+                                &fmRootApi->macTableMaintSemaphore);
+
 }   /* end fmTableMaintenanceHandler */
 
 
 
 
+/*****************************************************************************/
+/** fmSwitchTableMaintenanceHandler
+ * \ingroup intMacMaint
+ *
+ * \desc            MAC table maintenance task serving a single switch, used
+ *                  when api.perSwitchTasks is enabled. See
+ *                  TableMaintenanceLoop.
+ *
+ * \param[in]       args contains the pointer to the thread argument array,
+ *                  whose parameter is the fm_switchTasks of the switch.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void *fmSwitchTableMaintenanceHandler(void *args)
+{
+    fm_thread *     thread;
+    fm_switchTasks *tasks;
+
+    thread = FM_GET_THREAD_HANDLE(args);
+    tasks  = FM_GET_THREAD_PARAM(fm_switchTasks, args);
+
+    return TableMaintenanceLoop(thread,
+                                &fmRootApi->eventThread,
+                                tasks->sw,
+                                tasks->sw,
+                                &tasks->macTableMaintSemaphore);
+
+}   /* end fmSwitchTableMaintenanceHandler */
+
+
+
+
 /*****************************************************************************/
 /** fmAddUpdateToEvent
  * \ingroup intMacMaint
@@ -1374,7 +1453,7 @@ fm_status fmAddMacTableMaintenanceWork(fm_int                 sw,
         FM_LOG_DEBUG(FM_LOG_CAT_EVENT_MAC_MAINT,
                      "signaling MAC address maintenance task\n");
 
-        status = fmSignalSemaphore(&fmRootApi->macTableMaintSemaphore);
+        status = fmSignalSemaphore(FM_MAC_MAINT_SEM(sw));
         
     }   /* end if (workFound) */
 
@@ -2096,6 +2175,9 @@ const char* fmMATableReasonToText(fm_int reason)
         case FM_MAC_REASON_MEM_ERROR:
             return "MEM_ERROR";
 
+        case FM_MAC_REASON_LEARN_THROTTLED:
+            return "LEARN_THROTTLED";
+
         default:
             return "UNKNOWN";
 
@@ -2128,6 +2210,8 @@ void fmDbgDumpMacTableMaintStats(void)
     fm_uint64       totalTasks;
     macMaintStat*   stat;
     fm_status       err;
+    fm_macTableStats tableStats;
+    fm_int          i;
 
     FM_LOG_ENTRY_NOARGS(FM_LOG_CAT_EVENT_MAC_MAINT);
 
@@ -2163,6 +2247,45 @@ void fmDbgDumpMacTableMaintStats(void)
                              statValue);
             }
 
+            if (fmGetAddressTableStats(sw, &tableStats) == FM_OK)
+            {
+                FM_LOG_PRINT("    %-31s %d / %d (peak %d)\n",
+                             "Table occupancy",
+                             tableStats.numValid,
+                             tableStats.tableSize,
+                             tableStats.peakValid);
+
+                FM_LOG_PRINT("    %-31s", "Bin occupancy at insertion");
+                for (i = 0 ; i <= FM_MAX_MAC_TABLE_BIN_SIZE ; i++)
+                {
+                    FM_LOG_PRINT(" %d:%" FM_FORMAT_64 "u",
+                                 i,
+                                 tableStats.binOccupancy[i]);
+                }
+                FM_LOG_PRINT("\n");
+
+                FM_LOG_PRINT("    %-31s %" FM_FORMAT_64 "u\n",
+                             "Bin full",
+                             tableStats.numBinFull);
+
+                FM_LOG_PRINT("    %-31s %d\n",
+                             "Occupancy at first bin full",
+                             tableStats.validAtFirstBinFull);
+
+                for (i = 0 ; i < FM_MAC_TABLE_NUM_HOT_BINS ; i++)
+                {
+                    if (tableStats.hotBins[i].hashIndex < 0)
+                    {
+                        break;
+                    }
+
+                    FM_LOG_PRINT("    %-31s %5d: %" FM_FORMAT_64 "u\n",
+                                 (i == 0) ? "Most colliding bins" : "",
+                                 tableStats.hotBins[i].hashIndex,
+                                 tableStats.hotBins[i].numFull);
+                }
+            }
+
 
         } /* end if ( (sw == FM_FIRST_FOCALPOINT) || (pollCount > 0) ) */
 
@@ -1097,6 +1097,9 @@ fm_status fmAllocateMacTablePurgeList(fm_switch* switchPtr)
     purgePtr->purgeState   = FM_PURGE_STATE_IDLE;
     purgePtr->callbackList = NULL;
     purgePtr->nextSeq      = 1;
+    purgePtr->numScope     = -1;
+    purgePtr->scope        = NULL;
+    purgePtr->cursor       = 0;
 
     err = AllocatePurgeListEntry(&purgeEntry);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_MAC_MAINT, err);
@@ -1265,6 +1268,12 @@ fm_status fmFreeMacTablePurgeList(fm_switch* switchPtr)
         fmFree(callback);
     }
 
+    if (purgePtr->scope != NULL)
+    {
+        fmFree(purgePtr->scope);
+        purgePtr->scope = NULL;
+    }
+
     FM_DROP_MA_PURGE_LOCK(switchPtr->switchNumber);
 
 ABORT:
@@ -3317,6 +3326,16 @@ fm_status fmCancelMacTableFlushRequests(fm_int sw)
     purgePtr->purgeState = FM_PURGE_STATE_IDLE;
     tmpEntry = purgePtr->listHead;
 
+    /* Abandon the remaining slices of the active purge. */
+    if (purgePtr->scope != NULL)
+    {
+        fmFree(purgePtr->scope);
+        purgePtr->scope = NULL;
+    }
+
+    purgePtr->numScope = -1;
+    purgePtr->cursor   = 0;
+
     err2 = fmCreateBitArray(&vid1DelArray, FM_MAX_VLAN);
     FM_LOG_ABORT_ON_ASSERT(FM_LOG_CAT_EVENT_MAC_MAINT,
                            err2 == FM_OK,
@@ -3714,6 +3733,7 @@ fm_status fmCommonDumpPurgeStats(fm_int sw)
 
     FM_LOG_PRINT("      Total purges         : %u\n", stats.numCompletedOther);
     FM_LOG_PRINT("      With more pending    : %u\n", stats.numCompletedWithMorePending);
+    FM_LOG_PRINT("      Slices yielded       : %u\n", stats.numSlicesYielded);
 
     FM_LOG_PRINT("   Per-port purge list entries:\n");
     FM_LOG_PRINT("      Currently allocated  : %u\n", stats.numEntriesAllocated);
@@ -37,6 +37,39 @@
  * Macros, Constants & Types
  *****************************************************************************/
 
+/* Event size classes, each with its own free queue */
+#define EVENT_CLASS_SMALL               0
+#define EVENT_CLASS_TABLE_UPDATE        1
+#define NUM_EVENT_CLASSES               2
+
+/* Number of free events of each class a thread caches */
+#define EVENT_MAGAZINE_SIZE             16
+
+/* Number of events moved between a magazine and a free queue at once */
+#define EVENT_MAGAZINE_BATCH            8
+
+/* Size of an event able to hold the maximum table update burst */
+#define TABLE_UPDATE_EVENT_SIZE                                 \
+    ( ( sizeof(fm_event) +                                      \
+        sizeof(fm_eventTableUpdate) * FM_TABLE_UPDATE_BURST_SIZE \
+        + sizeof(fm_uint64) - 1 ) & ~(sizeof(fm_uint64) - 1) )
+
+/**************************************************
+ * Per-thread cache of free events, so that most
+ * allocations and releases do not go through the
+ * free queues. Only its owner thread touches it.
+ **************************************************/
+typedef struct _fm_eventMagazine
+{
+    /* Number of valid entries in events, per class */
+    fm_int    count[NUM_EVENT_CLASSES];
+
+    /* Free events, used as a stack per class */
+    fm_event *events[NUM_EVENT_CLASSES][EVENT_MAGAZINE_SIZE];
+
+} fm_eventMagazine;
+
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -49,6 +82,16 @@ static fm_timestamp eventTimeout;
 static fm_int       blockThreshold;
 static fm_int       unblockThreshold;
 
+/* Number of free small events below which allocations of each dispatch
+ * class are refused, leaving the rest to the classes favoured over it */
+static fm_int       reserveThreshold[FM_EVENT_DISPATCH_MAX];
+
+static void DestroyEventMagazine(void *arg);
+
+/* The calling thread's event magazine, process-local */
+static fm_threadLocal eventMagazine = 
+    FM_THREAD_LOCAL_INIT(DestroyEventMagazine);
+
 
 /*****************************************************************************
  * Local function prototypes.
@@ -58,6 +101,281 @@ static fm_int       unblockThreshold;
  * Local Functions
  *****************************************************************************/
 
+/*****************************************************************************
+ * GetFreeQueue
+ *
+ * Description: Returns the free queue of an event size class.
+ *
+ * Arguments:   eventClass is the size class.
+ *
+ * Returns:     Pointer to the free queue.
+ *
+ *****************************************************************************/
+static fm_eventQueue *GetFreeQueue(fm_int eventClass)
+{
+    return (eventClass == EVENT_CLASS_TABLE_UPDATE) ?
+           &fmRootApi->fmEventFreeQueue :
+           &fmRootApi->fmSmallEventFreeQueue;
+
+}   /* end GetFreeQueue */
+
+
+
+
+/*****************************************************************************
+ * GetEventClass
+ *
+ * Description: Returns the size class of an event, from the pool holding
+ *              it.
+ *
+ * Arguments:   event points to the event.
+ *
+ * Returns:     The size class.
+ *
+ *****************************************************************************/
+static fm_int GetEventClass(fm_event *event)
+{
+    fm_byte *ptr = (fm_byte *) event;
+
+    if ( (ptr >= fmRootApi->eventPool) &&
+         (ptr <  fmRootApi->eventPool +
+                 FM_MAX_TABLE_UPDATE_EVENTS * TABLE_UPDATE_EVENT_SIZE) )
+    {
+        return EVENT_CLASS_TABLE_UPDATE;
+    }
+
+    return EVENT_CLASS_SMALL;
+
+}   /* end GetEventClass */
+
+
+
+
+/*****************************************************************************
+ * DestroyEventMagazine
+ *
+ * Description: Called upon thread exit, returns the events cached by the
+ *              thread to the free queues.
+ *
+ * Arguments:   arg points to the thread's magazine.
+ *
+ * Returns:     None.
+ *
+ *****************************************************************************/
+static void DestroyEventMagazine(void *arg)
+{
+    fm_eventMagazine *magazine = arg;
+    fm_int            eventClass;
+    fm_int            numAdded;
+
+    for (eventClass = 0 ; eventClass < NUM_EVENT_CLASSES ; eventClass++)
+    {
+        fmEventQueueAddMultiple(GetFreeQueue(eventClass),
+                                magazine->count[eventClass],
+                                magazine->events[eventClass],
+                                &numAdded);
+    }
+
+    fmFree(magazine);
+
+}   /* end DestroyEventMagazine */
+
+
+
+
+/*****************************************************************************
+ * GetEventMagazine
+ *
+ * Description: Returns the calling thread's event magazine, creating it on
+ *              first use.
+ *
+ * Arguments:   None.
+ *
+ * Returns:     Pointer to the magazine, or NULL if it could not be created,
+ *              in which case the caller uses the free queues directly.
+ *
+ *****************************************************************************/
+static fm_eventMagazine *GetEventMagazine(void)
+{
+    fm_eventMagazine *magazine;
+
+    magazine = fmGetThreadLocal(&eventMagazine);
+
+    if (magazine == NULL)
+    {
+        magazine = fmAlloc( sizeof(fm_eventMagazine) );
+
+        if (magazine == NULL)
+        {
+            return NULL;
+        }
+
+        FM_CLEAR(*magazine);
+
+        if (fmSetThreadLocal(&eventMagazine, magazine) != FM_OK)
+        {
+            fmFree(magazine);
+            return NULL;
+        }
+    }
+
+    return magazine;
+
+}   /* end GetEventMagazine */
+
+
+
+
+/*****************************************************************************
+ * GetFreeEvent
+ *
+ * Description: Takes a free event of a size class from the calling
+ *              thread's magazine, refilling it with a batch from the free
+ *              queue when empty.
+ *
+ * Arguments:   eventClass is the size class.
+ *
+ * Returns:     Pointer to the event, or NULL if none is free.
+ *
+ *****************************************************************************/
+static fm_event *GetFreeEvent(fm_int eventClass)
+{
+    fm_eventMagazine *magazine;
+    fm_event *        event;
+    fm_int            numEvents;
+
+    magazine = GetEventMagazine();
+
+    if (magazine == NULL)
+    {
+        if (fmEventQueueGet(GetFreeQueue(eventClass), &event) != FM_OK)
+        {
+            return NULL;
+        }
+
+        return event;
+    }
+
+    if (magazine->count[eventClass] == 0)
+    {
+        fmEventQueueGetMultiple(GetFreeQueue(eventClass),
+                                EVENT_MAGAZINE_BATCH,
+                                magazine->events[eventClass],
+                                &numEvents);
+
+        if (numEvents == 0)
+        {
+            fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_NO_EVENTS_AVAILABLE, 1);
+            return NULL;
+        }
+
+        magazine->count[eventClass] = numEvents;
+    }
+
+    return magazine->events[eventClass][--magazine->count[eventClass]];
+
+}   /* end GetFreeEvent */
+
+
+
+
+/*****************************************************************************
+ * PutFreeEvent
+ *
+ * Description: Puts a free event in the calling thread's magazine,
+ *              returning a batch to the free queue when full.
+ *
+ * Arguments:   event points to the event.
+ *
+ *              eventClass is the size class of the event.
+ *
+ * Returns:     None.
+ *
+ *****************************************************************************/
+static void PutFreeEvent(fm_event *event, fm_int eventClass)
+{
+    fm_eventMagazine *magazine;
+    fm_int            numAdded;
+    fm_int            count;
+
+    magazine = GetEventMagazine();
+
+    if (magazine == NULL)
+    {
+        fmEventQueueAdd(GetFreeQueue(eventClass), event);
+        return;
+    }
+
+    count = magazine->count[eventClass];
+
+    if (count == EVENT_MAGAZINE_SIZE)
+    {
+        fmEventQueueAddMultiple(GetFreeQueue(eventClass),
+                                EVENT_MAGAZINE_BATCH,
+                                &magazine->events[eventClass][count -
+                                                  EVENT_MAGAZINE_BATCH],
+                                &numAdded);
+
+        count -= numAdded;
+        magazine->count[eventClass] = count;
+
+        if (count == EVENT_MAGAZINE_SIZE)
+        {
+            fmEventQueueAdd(GetFreeQueue(eventClass), event);
+            return;
+        }
+    }
+
+    magazine->events[eventClass][count++] = event;
+    magazine->count[eventClass]           = count;
+
+}   /* end PutFreeEvent */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************
+ * fmGetEventDispatchClass
+ *
+ * Description: Returns the class in which the global event handler
+ *              dispatches events of a given type.
+ *
+ * Arguments:   eventType is the event type.
+ *
+ * Returns:     The dispatch class.
+ *
+ *****************************************************************************/
+fm_eventDispatchClass fmGetEventDispatchClass(fm_int eventType)
+{
+    switch (eventType)
+    {
+        case FM_EVENT_PORT:
+            return FM_EVENT_DISPATCH_LINK;
+
+        case FM_EVENT_LOGICAL_PORT:
+            return FM_EVENT_DISPATCH_MAILBOX;
+
+        case FM_EVENT_TABLE_UPDATE:
+        case FM_EVENT_PURGE_SCAN_COMPLETE:
+            return FM_EVENT_DISPATCH_TABLE_UPDATE;
+
+        case FM_EVENT_PKT_RECV:
+        case FM_EVENT_SFLOW_PKT_RECV:
+            return FM_EVENT_DISPATCH_PACKET;
+
+        default:
+            return FM_EVENT_DISPATCH_OTHER;
+    }
+
+}   /* end fmGetEventDispatchClass */
+
+
+
+
 /*****************************************************************************
  * fmEventHandlingInitialize
  *
@@ -79,6 +397,8 @@ fm_status fmEventHandlingInitialize(void)
     fm_status    err;
     int          i;
     fm_int       timeout;
+    fm_uint      flags;
+    fm_int       dispatchClass;
 
     FM_LOG_ENTRY_NOARGS(FM_LOG_CAT_EVENT);
 
@@ -89,30 +409,59 @@ fm_status fmEventHandlingInitialize(void)
                             1);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT, err);
 
-    err = fmEventQueueInitialize(&fmRootApi->fmEventFreeQueue, FM_MAX_EVENTS,
-                                 "fmEventFreeQueue");
+    prop  = GET_PROPERTY();
+    flags = prop->eventRingQueues ? FM_EVENT_QUEUE_FLAG_RING : 0;
+
+    err = fmEventQueueInitializeV2(&fmRootApi->fmEventFreeQueue,
+                                   FM_MAX_TABLE_UPDATE_EVENTS,
+                                   "fmEventFreeQueue",
+                                   flags);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT, err);
+
+    err = fmEventQueueInitializeV2(&fmRootApi->fmSmallEventFreeQueue,
+                                   FM_MAX_EVENTS - FM_MAX_TABLE_UPDATE_EVENTS,
+                                   "fmSmallEventFreeQueue",
+                                   flags);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT, err);
 
-    /* put all event buffers into the free queue */
-    for (i = 0 ; i < FM_MAX_EVENTS ; i++)
+    /***************************************************
+     * Events able to carry a table update have the
+     * space for the maximum table update burst at the
+     * end of each event. The other events only hold
+     * the event structure.
+     **************************************************/
+
+    fmRootApi->eventPool =
+        fmAlloc(FM_MAX_TABLE_UPDATE_EVENTS * TABLE_UPDATE_EVENT_SIZE);
+    fmRootApi->smallEventPool =
+        fmAlloc( (FM_MAX_EVENTS - FM_MAX_TABLE_UPDATE_EVENTS) *
+                 sizeof(fm_event) );
+
+    if ( (fmRootApi->eventPool == NULL) || (fmRootApi->smallEventPool == NULL) )
     {
-        /***************************************************
-         * We allocate the space for the maximum table update
-         * burst at the end of each event.
-         **************************************************/
-        ptr = (fm_event *) fmAlloc( sizeof(fm_event) +
-                                   (sizeof(fm_eventTableUpdate) *
-                                    FM_TABLE_UPDATE_BURST_SIZE) );
-        if (ptr == NULL)
-        {
-            FM_LOG_EXIT(FM_LOG_CAT_EVENT, FM_ERR_NO_MEM);
-        }
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT, FM_ERR_NO_MEM);
+    }
+
+    /* put all event buffers into the free queues */
+    for (i = 0 ; i < FM_MAX_TABLE_UPDATE_EVENTS ; i++)
+    {
+        ptr = (fm_event *) (fmRootApi->eventPool +
+                            i * TABLE_UPDATE_EVENT_SIZE);
 
         err = fmEventQueueAdd(&fmRootApi->fmEventFreeQueue, ptr);
         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT, err);
     }
 
-    prop = GET_PROPERTY();
+    for (i = 0 ; i < FM_MAX_EVENTS - FM_MAX_TABLE_UPDATE_EVENTS ; i++)
+    {
+        ptr = ( (fm_event *) fmRootApi->smallEventPool ) + i;
+
+        err = fmEventQueueAdd(&fmRootApi->fmSmallEventFreeQueue, ptr);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT, err);
+    }
+
+    fmRootApi->numFreeEvents      = FM_MAX_EVENTS;
+    fmRootApi->numFreeSmallEvents = FM_MAX_EVENTS - FM_MAX_TABLE_UPDATE_EVENTS;
 
     /* Initialize variables */
     timeout           = prop->eventSemTimeout;
@@ -130,6 +479,41 @@ fm_status fmEventHandlingInitialize(void)
         FM_LOG_EXIT(FM_LOG_CAT_EVENT, FM_ERR_INVALID_ATTRIB);
     }
 
+    /***************************************************
+     * Port events may use every free event, logical
+     * port events all but the port event reservation,
+     * and the other events all but both reservations.
+     **************************************************/
+
+    if ( (prop->eventLinkReserve < 0) ||
+         (prop->eventMailboxReserve < 0) ||
+         (prop->eventLinkReserve + prop->eventMailboxReserve >=
+          FM_MAX_EVENTS - FM_MAX_TABLE_UPDATE_EVENTS) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT, FM_ERR_INVALID_ATTRIB);
+    }
+
+    for (dispatchClass = 0 ;
+         dispatchClass < FM_EVENT_DISPATCH_MAX ;
+         dispatchClass++)
+    {
+        switch (dispatchClass)
+        {
+            case FM_EVENT_DISPATCH_LINK:
+                reserveThreshold[dispatchClass] = 0;
+                break;
+
+            case FM_EVENT_DISPATCH_MAILBOX:
+                reserveThreshold[dispatchClass] = prop->eventLinkReserve;
+                break;
+
+            default:
+                reserveThreshold[dispatchClass] = prop->eventLinkReserve +
+                                                  prop->eventMailboxReserve;
+                break;
+        }
+    }
+
     FM_LOG_EXIT(FM_LOG_CAT_EVENT, FM_OK);
 
 }   /* end fmEventHandlingInitialize */
@@ -140,7 +524,11 @@ fm_status fmEventHandlingInitialize(void)
 /*****************************************************************************
  * fmAllocateEvent
  *
- * Description: Gets an event from the event free queue.
+ * Description: Gets an event from the calling thread's event cache, which
+ *              is refilled in batches from the event free queue of the
+ *              event's size class. Events that do not carry a table update
+ *              are refused when the remaining ones are reserved for event
+ *              types favoured by the global event handler.
  *
  * Arguments:   sw is the switch number.
  *
@@ -162,6 +550,8 @@ fm_event *fmAllocateEvent(fm_int           sw,
     fm_event *event;
     fm_status err;
     fm_int    eventCount;
+    fm_int    eventClass;
+    fm_int    reserve;
 
     FM_LOG_ENTRY(FM_LOG_CAT_EVENT,
                  "sw = %d, eventID = %d, eventType = %d, priority = %d\n",
@@ -172,32 +562,56 @@ fm_event *fmAllocateEvent(fm_int           sw,
 
     if (priority == FM_EVENT_PRIORITY_LOW)
     {
-        err = fmEventQueueCount(&fmRootApi->fmEventFreeQueue, &eventCount);
-        if (err != FM_OK)
-        {
-            FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_EVENT, NULL, "NULL\n");
-        }
+        eventCount = FM_ATOMIC_LOAD(&fmRootApi->numFreeEvents);
 
         if (eventCount < blockThreshold)
         {
+            FM_ATOMIC_ADD_RELAXED(&fmRootApi->lowPriorityEventBlocks, 1);
+
             /* block until the number of events is reasonable */
             err = fmCaptureSemaphore(&fmRootApi->fmLowPriorityEventSem, &eventTimeout);
             if (err != FM_OK)
             {
                 /* Timeout, then return NULL */
+                FM_ATOMIC_ADD_RELAXED(&fmRootApi->lowPriorityEventTimeouts, 1);
                 return NULL;
             }
         }
     }
 
-    err = fmEventQueueGet(&fmRootApi->fmEventFreeQueue, &event);
+    eventClass = (eventType == FM_EVENT_TABLE_UPDATE) ?
+                 EVENT_CLASS_TABLE_UPDATE :
+                 EVENT_CLASS_SMALL;
 
-    if (err != FM_OK)
+    if (eventClass == EVENT_CLASS_SMALL)
     {
+        eventCount = FM_ATOMIC_SUB(&fmRootApi->numFreeSmallEvents, 1);
+
+        reserve = reserveThreshold[fmGetEventDispatchClass(eventType)];
+
+        if ( (reserve > 0) && (eventCount < reserve) )
+        {
+            FM_ATOMIC_ADD(&fmRootApi->numFreeSmallEvents, 1);
+            fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_EVENT_RESERVED, 1);
+            FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_EVENT, NULL, "NULL\n");
+        }
+    }
+
+    event = GetFreeEvent(eventClass);
+
+    if (event == NULL)
+    {
+        if (eventClass == EVENT_CLASS_SMALL)
+        {
+            FM_ATOMIC_ADD(&fmRootApi->numFreeSmallEvents, 1);
+        }
+
         FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_EVENT, NULL, "NULL\n");
     }
     else
     {
+        FM_ATOMIC_SUB(&fmRootApi->numFreeEvents, 1);
+
         event->sw       = sw;
         event->eventID  = eventID;
         event->type     = eventType;
@@ -227,7 +641,9 @@ fm_event *fmAllocateEvent(fm_int           sw,
 /*****************************************************************************
  * fmReleaseEvent
  *
- * Description: Puts an event back onto the event free queue.
+ * Description: Puts an event back into the calling thread's event cache,
+ *              which spills in batches to the event free queue of the
+ *              event's size class.
  *
  * Arguments:   event points to the event to be freed.
  *
@@ -241,15 +657,25 @@ fm_status fmReleaseEvent(fm_event *event)
     fm_int           type;
     fm_eventFreeNotifyHndlr handler;
     fm_int           eventCount;
+    fm_int           eventClass;
 
 
     FM_LOG_ENTRY(FM_LOG_CAT_EVENT, "%p\n", (void *) event);
 
-    fmEventQueueAdd(&fmRootApi->fmEventFreeQueue, event);
+    eventClass = GetEventClass(event);
+
+    /* Keeps the dwell time of free events out of the queue telemetry */
+    event->type = 0;
+
+    PutFreeEvent(event, eventClass);
+
+    if (eventClass == EVENT_CLASS_SMALL)
+    {
+        FM_ATOMIC_ADD(&fmRootApi->numFreeSmallEvents, 1);
+    }
 
     /* Need to unblock regardless of priority */
-    eventCount = 0; /* incase call return error */
-    fmEventQueueCount(&fmRootApi->fmEventFreeQueue, &eventCount);
+    eventCount = FM_ATOMIC_ADD(&fmRootApi->numFreeEvents, 1);
 
     /* Only release when free event above a threshold */
     if (eventCount > unblockThreshold)
@@ -0,0 +1,524 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_api_fanout.c
+ * Creation Date:   October 15, 2026
+ * Description:     Runs one operation on several switches in parallel, one
+ *                  worker thread per switch.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <fm_sdk_int.h>
+
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Function Prototypes
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/* FanOutWorkerThread
+ * \ingroup intSwitch
+ *
+ * \desc            Thread running the operations queued to one switch,
+ *                  one at a time and in the order they were queued.
+ *
+ * \param[in]       args contains thread-initialization parameters
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void *FanOutWorkerThread(void *args)
+{
+    fm_fanOutWorker *worker;
+    fm_fanOutJob *   job;
+    fm_status        err;
+
+    worker = FM_GET_THREAD_PARAM(fm_fanOutWorker, args);
+
+    while (1)
+    {
+        if (fmWaitSemaphore(&worker->requestSem, FM_WAIT_FOREVER) != FM_OK)
+        {
+            continue;
+        }
+
+        fmCaptureLock(&worker->jobLock, FM_WAIT_FOREVER);
+        err = fmDListRemoveBegin(&worker->jobs, (void **) &job);
+        fmReleaseLock(&worker->jobLock);
+
+        if (err != FM_OK)
+        {
+            continue;
+        }
+
+        job->result = job->func(worker->sw, job->cookie);
+
+        fmSignalSemaphore(job->doneSem);
+    }
+
+    return NULL;
+
+}   /* end FanOutWorkerThread */
+
+
+
+
+/*****************************************************************************/
+/* GetFanOutWorker
+ * \ingroup intSwitch
+ *
+ * \desc            Return the fan-out worker of a switch, creating it the
+ *                  first time it is needed.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[out]      worker points to caller-allocated storage where this
+ *                  function should place the worker.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status GetFanOutWorker(fm_int sw, fm_fanOutWorker **worker)
+{
+    fm_fanOutWorker *newWorker;
+    fm_status        err;
+    fm_bool          lockCreated;
+    fm_bool          semCreated;
+
+    newWorker   = NULL;
+    lockCreated = FALSE;
+    semCreated  = FALSE;
+
+    fmCaptureLock(&fmRootApi->fanOutLock, FM_WAIT_FOREVER);
+
+    if (fmRootApi->fanOutWorkers[sw] != NULL)
+    {
+        *worker = fmRootApi->fanOutWorkers[sw];
+        err     = FM_OK;
+        goto ABORT;
+    }
+
+    newWorker = fmAlloc( sizeof(fm_fanOutWorker) );
+
+    if (newWorker == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
+    FM_CLEAR(*newWorker);
+
+    newWorker->sw = sw;
+    fmDListInit(&newWorker->jobs);
+
+    err = fmCreateLock("Switch fan-out job lock", &newWorker->jobLock);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    lockCreated = TRUE;
+
+    err = fmCreateSemaphore("fanOutRequestSem",
+                            FM_SEM_COUNTING,
+                            &newWorker->requestSem,
+                            0);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    semCreated = TRUE;
+
+    err = fmCreateThread("Switch Fan-Out Worker",
+                         FM_EVENT_QUEUE_SIZE_NONE,
+                         &FanOutWorkerThread,
+                         newWorker,
+                         &newWorker->thread);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+    /* The thread owns the worker from now on */
+    fmRootApi->fanOutWorkers[sw] = newWorker;
+    *worker   = newWorker;
+    newWorker = NULL;
+
+ABORT:
+    fmReleaseLock(&fmRootApi->fanOutLock);
+
+    if (newWorker != NULL)
+    {
+        if (semCreated)
+        {
+            fmDeleteSemaphore(&newWorker->requestSem);
+        }
+
+        if (lockCreated)
+        {
+            fmDeleteLock(&newWorker->jobLock);
+        }
+
+        fmFree(newWorker);
+    }
+
+    return err;
+
+}   /* end GetFanOutWorker */
+
+
+
+
+/*****************************************************************************/
+/* QueueFanOutJob
+ * \ingroup intSwitch
+ *
+ * \desc            Queue an operation to the worker of a switch.
+ *
+ * \param[in]       worker is the switch worker.
+ *
+ * \param[in]       job is the operation to queue. It must remain valid
+ *                  until its done semaphore has been signaled.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status QueueFanOutJob(fm_fanOutWorker *worker, fm_fanOutJob *job)
+{
+    fm_status err;
+
+    fmCaptureLock(&worker->jobLock, FM_WAIT_FOREVER);
+    err = fmDListInsertEnd(&worker->jobs, job);
+    fmReleaseLock(&worker->jobLock);
+
+    if (err == FM_OK)
+    {
+        fmSignalSemaphore(&worker->requestSem);
+    }
+
+    return err;
+
+}   /* end QueueFanOutJob */
+
+
+
+
+/*****************************************************************************/
+/* RunFanOutJobs
+ * \ingroup intSwitch
+ *
+ * \desc            Run an operation on the selected switches in parallel
+ *                  and wait until all of them have returned.
+ *
+ * \param[in]       numSwitches is the number of entries in swList.
+ *
+ * \param[in]       swList is the list of switches.
+ *
+ * \param[in]       selected is an array of numSwitches entries telling on
+ *                  which of the switches to run func.
+ *
+ * \param[in]       func is the operation to run.
+ *
+ * \param[in]       cookie is passed to func.
+ *
+ * \param[in]       jobs is an array of numSwitches entries used to track
+ *                  the operation on each switch. On return, the result
+ *                  of each selected switch is in its entry.
+ *
+ * \param[in]       doneSem is a counting semaphore, initially zero.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void RunFanOutJobs(fm_int         numSwitches,
+                          const fm_int * swList,
+                          const fm_bool *selected,
+                          fm_fanOutFunc  func,
+                          void *         cookie,
+                          fm_fanOutJob * jobs,
+                          fm_semaphore * doneSem)
+{
+    fm_fanOutWorker *worker;
+    fm_status        err;
+    fm_int           numQueued;
+    fm_int           i;
+
+    numQueued = 0;
+    worker    = NULL;
+
+    for (i = 0 ; i < numSwitches ; i++)
+    {
+        if (!selected[i])
+        {
+            continue;
+        }
+
+        jobs[i].func    = func;
+        jobs[i].cookie  = cookie;
+        jobs[i].result  = FM_OK;
+        jobs[i].doneSem = doneSem;
+
+        err = GetFanOutWorker(swList[i], &worker);
+
+        if (err == FM_OK)
+        {
+            err = QueueFanOutJob(worker, &jobs[i]);
+        }
+
+        if (err != FM_OK)
+        {
+            /* No worker for this switch, run it from this thread */
+            jobs[i].result = func(swList[i], cookie);
+            continue;
+        }
+
+        numQueued++;
+    }
+
+    while (numQueued > 0)
+    {
+        if (fmWaitSemaphore(doneSem, FM_WAIT_FOREVER) == FM_OK)
+        {
+            numQueued--;
+        }
+    }
+
+}   /* end RunFanOutJobs */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** fmFanOutToSwitches
+ * \ingroup intSwitch
+ *
+ * \desc            Apply an operation to several switches in parallel,
+ *                  each on a worker thread of its own, and wait until it
+ *                  has returned on all of them. This is meant for
+ *                  aggregate switches, where each member switch can be
+ *                  programmed independently of the others.
+ *                                                                      \lb\lb
+ *                  The operations queued to one switch run in the order
+ *                  they were queued, so a caller that serializes its
+ *                  aggregate calls also serializes what each member
+ *                  switch sees.
+ *                                                                      \lb\lb
+ *                  If the operation fails on any switch, undo is applied,
+ *                  again in parallel, to every switch on which it
+ *                  succeeded.
+ *
+ * \param[in]       numSwitches is the number of entries in swList.
+ *
+ * \param[in]       swList is the list of switches.
+ *
+ * \param[in]       apply is the operation to apply to each switch.
+ *
+ * \param[in]       undo reverts apply on one switch. It may be NULL if
+ *                  there is nothing to revert.
+ *
+ * \param[in]       cookie is passed to apply and undo.
+ *
+ * \param[out]      results points to an array of numSwitches entries where
+ *                  this function places the status apply returned on each
+ *                  switch. It may be NULL.
+ *
+ * \return          FM_OK if apply succeeded on all switches.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ * \return          The status of the first switch in swList on which
+ *                  apply failed otherwise.
+ *
+ *****************************************************************************/
+fm_status fmFanOutToSwitches(fm_int         numSwitches,
+                             const fm_int * swList,
+                             fm_fanOutFunc  apply,
+                             fm_fanOutFunc  undo,
+                             void *         cookie,
+                             fm_status *    results)
+{
+    fm_fanOutJob *jobs;
+    fm_bool *     selected;
+    fm_semaphore  doneSem;
+    fm_bool       semCreated;
+    fm_status     err;
+    fm_status     undoErr;
+    fm_int        i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH,
+                 "numSwitches=%d swList=%p apply=%p undo=%p "
+                 "cookie=%p results=%p\n",
+                 numSwitches,
+                 (void *) swList,
+                 (void *) apply,
+                 (void *) undo,
+                 cookie,
+                 (void *) results);
+
+    jobs       = NULL;
+    selected   = NULL;
+    semCreated = FALSE;
+
+    if ( numSwitches < 0 || (numSwitches > 0 && swList == NULL) ||
+         apply == NULL )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
+    for (i = 0 ; i < numSwitches ; i++)
+    {
+        if (swList[i] < 0 || swList[i] >= FM_MAX_NUM_SWITCHES)
+        {
+            err = FM_ERR_INVALID_ARGUMENT;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+        }
+    }
+
+    if (numSwitches <= 1)
+    {
+        /* Nothing to do in parallel */
+        err = (numSwitches == 1) ? apply(swList[0], cookie) : FM_OK;
+
+        if (results != NULL && numSwitches == 1)
+        {
+            results[0] = err;
+        }
+
+        goto ABORT;
+    }
+
+    jobs     = fmAlloc( numSwitches * sizeof(fm_fanOutJob) );
+    selected = fmAlloc( numSwitches * sizeof(fm_bool) );
+
+    if (jobs == NULL || selected == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
+    FM_MEMSET_S( jobs,
+                 numSwitches * sizeof(fm_fanOutJob),
+                 0,
+                 numSwitches * sizeof(fm_fanOutJob) );
+
+    err = fmCreateSemaphore("fanOutDoneSem", FM_SEM_COUNTING, &doneSem, 0);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    semCreated = TRUE;
+
+    for (i = 0 ; i < numSwitches ; i++)
+    {
+        selected[i] = TRUE;
+    }
+
+    RunFanOutJobs(numSwitches, swList, selected, apply, cookie, jobs, &doneSem);
+
+    err = FM_OK;
+
+    for (i = 0 ; i < numSwitches ; i++)
+    {
+        if (results != NULL)
+        {
+            results[i] = jobs[i].result;
+        }
+
+        if (jobs[i].result != FM_OK)
+        {
+            FM_LOG_DEBUG(FM_LOG_CAT_SWITCH,
+                         "Switch %d: fanned-out operation failed: %s\n",
+                         swList[i],
+                         fmErrorMsg(jobs[i].result));
+
+            if (err == FM_OK)
+            {
+                err = jobs[i].result;
+            }
+        }
+
+        /* Only the switches that took the change need undoing */
+        selected[i] = (jobs[i].result == FM_OK);
+    }
+
+    if (err != FM_OK && undo != NULL)
+    {
+        RunFanOutJobs(numSwitches,
+                      swList,
+                      selected,
+                      undo,
+                      cookie,
+                      jobs,
+                      &doneSem);
+
+        for (i = 0 ; i < numSwitches ; i++)
+        {
+            undoErr = jobs[i].result;
+
+            if (selected[i] && undoErr != FM_OK)
+            {
+                FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                             "Switch %d: unable to undo fanned-out "
+                             "operation: %s\n",
+                             swList[i],
+                             fmErrorMsg(undoErr));
+            }
+        }
+    }
+
+ABORT:
+    if (semCreated)
+    {
+        fmDeleteSemaphore(&doneSem);
+    }
+
+    if (jobs != NULL)
+    {
+        fmFree(jobs);
+    }
+
+    if (selected != NULL)
+    {
+        fmFree(selected);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end fmFanOutToSwitches */
@@ -0,0 +1,184 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_api_ffu.c
+ * Creation Date:   October 15, 2026
+ * Description:     FFU slice occupancy and defragmentation
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** fmGetFFUSliceMap
+ * \ingroup switch
+ *
+ * \chips           FM10000
+ *
+ * \desc            Returns the occupancy of one FFU TCAM slice: its owner,
+ *                  a bitmap of the rows in use and counts of the free runs,
+ *                  the holes between used rows and the largest free block.
+ *                  A high hole count with a small largest free block means
+ *                  the next ACL or route insert is likely to move many rules;
+ *                  see ''fmDefragmentFFU''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       slice is the FFU slice number.
+ *
+ * \param[out]      sliceMap points to caller-allocated storage where this
+ *                  function places the slice map.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_SLICE if slice is out of range.
+ * \return          FM_ERR_INVALID_ARGUMENT if sliceMap is NULL.
+ * \return          FM_ERR_UNSUPPORTED if the slice owner does not track the
+ *                  rows it uses.
+ *
+ *****************************************************************************/
+fm_status fmGetFFUSliceMap(fm_int sw, fm_int slice, fm_ffuSliceMap *sliceMap)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_FFU,
+                     "sw = %d, slice = %d, sliceMap = %p\n",
+                     sw,
+                     slice,
+                     (void *) sliceMap);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_API_CALL_FAMILY(err,
+                       switchPtr->GetFFUSliceMap,
+                       sw,
+                       slice,
+                       sliceMap);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_FFU, err);
+
+}   /* end fmGetFFUSliceMap */
+
+
+
+
+/*****************************************************************************/
+/** fmDefragmentFFU
+ * \ingroup switch
+ *
+ * \chips           FM10000
+ *
+ * \desc            Compacts the FFU rules of one owner so that the holes
+ *                  between them merge into contiguous free blocks. Rules
+ *                  keep their relative order, so traffic is not affected,
+ *                  but each move costs FFU writes. The work is bounded by
+ *                  budget so that it can be spread over maintenance windows:
+ *                  call again until numMoved is zero.
+ *                                                                      \lb\lb
+ *                  ACL compaction applies to ingress ACLs and requires that
+ *                  no compiled ACLs are waiting to be applied.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       owner is the FFU owner to compact, either
+ *                  FM_FFU_OWNER_ACL or FM_FFU_OWNER_ROUTING.
+ *
+ * \param[in]       budget is the maximum number of rules to move.
+ *
+ * \param[out]      numMoved points to caller-allocated storage where this
+ *                  function places the number of rules moved.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if budget is negative or numMoved
+ *                  is NULL.
+ * \return          FM_ERR_UNSUPPORTED if owner cannot be compacted.
+ * \return          FM_ERR_INVALID_STATE if compiled ACLs are waiting to be
+ *                  applied.
+ *
+ *****************************************************************************/
+fm_status fmDefragmentFFU(fm_int          sw,
+                          fm_ffuOwnerType owner,
+                          fm_int          budget,
+                          fm_int *        numMoved)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_FFU,
+                     "sw = %d, owner = %d, budget = %d, numMoved = %p\n",
+                     sw,
+                     owner,
+                     budget,
+                     (void *) numMoved);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_API_CALL_FAMILY(err,
+                       switchPtr->DefragmentFFU,
+                       sw,
+                       owner,
+                       budget,
+                       numMoved);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_FFU, err);
+
+}   /* end fmDefragmentFFU */
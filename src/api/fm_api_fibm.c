@@ -58,6 +58,45 @@
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/** SetAutoBatching
+ * \ingroup intFibm
+ *
+ * \desc            Starts, or stops and flushes, the automatic write batch
+ *                  of a remote switch.
+ *
+ * \param[in]       sw is switch number.
+ *
+ * \param[in]       start is TRUE to start batching, FALSE to flush.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void SetAutoBatching(fm_int sw, fm_bool start)
+{
+    fm_status   err;
+
+    if (fmRootApi->fmSwitchStateTable[sw] == NULL)
+    {
+        return;
+    }
+
+    err = fmFibmStartBatching(sw, start);
+
+    if ( err != FM_OK &&
+         err != FM_ERR_UNINITIALIZED &&
+         err != FM_ERR_UNSUPPORTED )
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_FIBM,
+                       "Unable to %s FIBM batching on switch %d: %s\n",
+                       (start) ? "start" : "flush",
+                       sw,
+                       fmErrorMsg(err));
+    }
+
+} /* end SetAutoBatching */
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -248,3 +287,87 @@ fm_status fmFibmStartBatching(fm_int sw, fm_bool start)
     FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_FIBM, err);
 
 } /* end fmFibmStartBatching */
+
+
+
+
+/*****************************************************************************/
+/** fmFibmProtectSwitch
+ * \ingroup intFibm
+ *
+ * \desc            Takes read access to the lock of a remote switch and
+ *                  starts batching its register writes. Used by
+ *                  PROTECT_SWITCH, so that API calls on a remote switch
+ *                  are batched without being bracketed explicitly.
+ *                  Callers that protect the switch at the same time share
+ *                  one batch.
+ *
+ * \param[in]       sw is switch number.
+ *
+ * \return          FM_OK if successful.
+ * \return          Otherwise the error returned when taking the lock.
+ *
+ *****************************************************************************/
+fm_status fmFibmProtectSwitch(fm_int sw)
+{
+    fm_status   err;
+
+    err = CAPTURE_SWITCH_READ_LOCK(sw);
+
+    if (err == FM_OK)
+    {
+        if (FM_ATOMIC_ADD(&fmRootApi->fibmBatchDepth[sw], 1) == 1)
+        {
+            SetAutoBatching(sw, TRUE);
+        }
+    }
+
+    return err;
+
+} /* end fmFibmProtectSwitch */
+
+
+
+
+/*****************************************************************************/
+/** fmFibmUnprotectSwitch
+ * \ingroup intFibm
+ *
+ * \desc            Flushes the register writes batched for a remote switch
+ *                  and releases read access to its lock. Used by
+ *                  UNPROTECT_SWITCH.
+ *
+ * \note            A read flushes the batch ahead of it, so reads always
+ *                  observe the writes that precede them.
+ *
+ * \param[in]       sw is switch number.
+ *
+ * \return          FM_OK if successful.
+ * \return          Otherwise the error returned when releasing the lock.
+ *
+ *****************************************************************************/
+fm_status fmFibmUnprotectSwitch(fm_int sw)
+{
+    fm_int  remaining;
+
+    remaining = FM_ATOMIC_SUB(&fmRootApi->fibmBatchDepth[sw], 1);
+
+    /* Every caller flushes its own writes before returning. */
+    SetAutoBatching(sw, FALSE);
+
+    if (remaining > 0)
+    {
+        /* Reopen the batch for the other callers. If they all left
+         * while it was being reopened, the last one may already have
+         * flushed, so flush again. */
+        SetAutoBatching(sw, TRUE);
+
+        if (FM_ATOMIC_LOAD(&fmRootApi->fibmBatchDepth[sw]) == 0)
+        {
+            SetAutoBatching(sw, FALSE);
+        }
+    }
+
+    return fmReleaseReadLock(fmRootApi->fmSwitchLockTable[sw]);
+
+} /* end fmFibmUnprotectSwitch */
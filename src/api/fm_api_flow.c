@@ -572,6 +572,127 @@ fm_status fmAddFlow(fm_int           sw,
 
 
 
+/*****************************************************************************/
+/** fmAddFlowList
+ * \ingroup flow
+ *
+ * \chips           FM10000
+ *
+ * \desc            Add a list of flow entries to the specified table in a
+ *                  single operation. The flow table is locked once for the
+ *                  whole list. Each flow is otherwise handled as by
+ *                  ''fmAddFlow''; a failing flow does not prevent the
+ *                  others from being added.
+ *                                                                      \lb\lb
+ *                  On a TE table, the register writes of the whole list
+ *                  are issued together once the list has been processed,
+ *                  so that the TE data blocks allocated one after the other
+ *                  and their lookup entries are written in bursts.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       tableIndex is the table instance to which the flows
+ *                  should be added.
+ *
+ * \param[in]       numFlows is the number of flows in the list.
+ *
+ * \param[in,out]   flows points to an array of numFlows flows to add. The
+ *                  flowId field of each entry receives the handle of the
+ *                  flow, or -1 if the flow could not be added.
+ *
+ * \param[out]      results points to a caller-allocated array of numFlows
+ *                  entries that receives the status of each flow. May be
+ *                  NULL.
+ *
+ * \return          FM_OK if every flow was added successfully.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if flows is NULL or numFlows is
+ *                  not positive.
+ * \return          the status of the first flow that failed, in list order,
+ *                  otherwise. See ''fmAddFlow''.
+ *
+ *****************************************************************************/
+fm_status fmAddFlowList(fm_int            sw,
+                        fm_int            tableIndex,
+                        fm_int            numFlows,
+                        fm_flowListEntry *flows,
+                        fm_status *       results)
+{
+    fm_status  err;
+    fm_status  flowErr;
+    fm_switch *switchPtr;
+    fm_int     i;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_FLOW,
+                     "sw = %d, tableIndex = %d, numFlows = %d, flows = %p, "
+                     "results = %p\n",
+                     sw,
+                     tableIndex,
+                     numFlows,
+                     (void *) flows,
+                     (void *) results);
+
+    if ( (flows == NULL) || (numFlows <= 0) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_FLOW, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+    TAKE_FLOW_LOCK(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->AddFlowList != NULL)
+    {
+        err = switchPtr->AddFlowList(sw, tableIndex, numFlows, flows, results);
+    }
+    else
+    {
+        /* Add the flows one by one under the same lock. */
+        err = FM_OK;
+
+        for (i = 0 ; i < numFlows ; i++)
+        {
+            FM_API_CALL_FAMILY(flowErr,
+                               switchPtr->AddFlow,
+                               sw,
+                               tableIndex,
+                               flows[i].priority,
+                               flows[i].precedence,
+                               flows[i].condition,
+                               &flows[i].condVal,
+                               flows[i].action,
+                               &flows[i].param,
+                               flows[i].flowState,
+                               &flows[i].flowId);
+
+            if (flowErr != FM_OK)
+            {
+                flows[i].flowId = -1;
+
+                if (err == FM_OK)
+                {
+                    err = flowErr;
+                }
+            }
+
+            if (results != NULL)
+            {
+                results[i] = flowErr;
+            }
+        }
+    }
+
+    DROP_FLOW_LOCK(sw);
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_FLOW, err);
+
+}   /* end fmAddFlowList */
+
+
+
+
 /*****************************************************************************/
 /** fmGetFlow
  * \ingroup flow
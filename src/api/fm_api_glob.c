@@ -55,6 +55,9 @@
 /* pointer to event handler */
 fm_eventHandler fmEventHandler;
 
+/* pointer to event batch handler, used instead of the above if set */
+fm_eventBatchHandler fmEventBatchHandler;
+
 /* state shared between processes */
 FM_GLOBAL_DECL fm_rootApi *    fmRootApi;
 
@@ -511,8 +514,8 @@ fm_status fmMapBitMaskLogicalToLinkUpMask(fm_switch * switchPtr,
         port = switchPtr->cardinalPortInfo.portMap[cpi].logPort;
 
         /* CPU port is always available to send to */
-        if ( switchPtr->portTable[port]->linkUp ||
-             switchPtr->portTable[port]->isPortForceUp ||
+        if ( (switchPtr->cardinalPortInfo.portFlags[cpi] &
+              (FM_CARDINAL_PORT_LINK_UP | FM_CARDINAL_PORT_FORCE_UP)) ||
              port == switchPtr->cpuPort)
         {
             um |= (1 << cpi);
@@ -44,22 +44,32 @@
  * is reserved or in use. */
 
 #define FM_RELEASE_GLORT(info, glort)       \
-        (info)->glortState[glort] = FM_GLORT_STATE_UNUSED
+        SetGlortState((info), (glort), FM_GLORT_STATE_UNUSED)
 
 #define FM_SET_GLORT_FREE(info, glort)      \
-        (info)->glortState[glort] &= ~FM_GLORT_STATE_USED_BITS
+        SetGlortState((info),               \
+                      (glort),              \
+                      (info)->glortState[glort] & ~FM_GLORT_STATE_USED_BITS)
 
 #define FM_SET_GLORT_IN_USE(info, glort)    \
-        (info)->glortState[glort] |= FM_GLORT_STATE_IN_USE
+        SetGlortState((info),               \
+                      (glort),              \
+                      (info)->glortState[glort] | FM_GLORT_STATE_IN_USE)
 
 #define FM_RESERVE_GLORT_MCG(info, glort)   \
-        (info)->glortState[glort] |= FM_GLORT_STATE_RESV_MCG
+        SetGlortState((info),               \
+                      (glort),              \
+                      (info)->glortState[glort] | FM_GLORT_STATE_RESV_MCG)
 
 #define FM_RESERVE_GLORT_LAG(info, glort)   \
-        (info)->glortState[glort] |= FM_GLORT_STATE_RESV_LAG
+        SetGlortState((info),               \
+                      (glort),              \
+                      (info)->glortState[glort] | FM_GLORT_STATE_RESV_LAG)
 
 #define FM_RESERVE_GLORT_LBG(info, glort)   \
-        (info)->glortState[glort] |= FM_GLORT_STATE_RESV_LBG
+        SetGlortState((info),               \
+                      (glort),              \
+                      (info)->glortState[glort] | FM_GLORT_STATE_RESV_LBG)
 
 /* Either used or reserved */
 #define FM_IS_GLORT_TAKEN(info, glort)      \
@@ -94,7 +104,9 @@
  * in the allocated groups, so we will need this so we can free the allocated
  * groups */
 #define FM_SET_GLORT_FREE_PEND(info, glort) \
-        (info)->glortState[glort] |= FM_GLORT_STATE_FREE_PEND
+        SetGlortState((info),               \
+                      (glort),              \
+                      (info)->glortState[glort] | FM_GLORT_STATE_FREE_PEND)
 
 #define FM_IS_GLORT_FREE_PEND(info, glort)  \
         (((info)->glortState[glort] & FM_GLORT_STATE_FREE_PEND) != 0)
@@ -104,6 +116,9 @@
  *****************************************************************************/
 
 
+static void SetGlortState(fm_logicalPortInfo *lportInfo,
+                          fm_uint32           glort,
+                          fm_int              state);
 static fm_status GetGlortRange(fm_switch *  switchPtr,
                                fm_glortType type,
                                fm_uint32 *  rangeBase,
@@ -157,6 +172,62 @@ static fm_status GlortStateToText(fm_int  state,
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/** SetGlortState
+ * \ingroup intPort
+ *
+ * \desc            Sets the state of a GloRT and updates the free-range
+ *                  indexes used by ''fmFindFreeGlortRangeInt'' to match.
+ *
+ * \param[in]       lportInfo points to the logical port information
+ *                  structure.
+ *
+ * \param[in]       glort is the GloRT whose state is set.
+ *
+ * \param[in]       state is the new state (see FM_GLORT_STATE_*).
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void SetGlortState(fm_logicalPortInfo *lportInfo,
+                          fm_uint32           glort,
+                          fm_int              state)
+{
+    fm_bitArray *index;
+    fm_bool      used;
+
+    lportInfo->glortState[glort] = (fm_byte) state;
+
+    index = lportInfo->glortIndex;
+    used  = ( (state & FM_GLORT_STATE_USED_BITS) != 0 );
+
+    fmSetBitArrayBit(&index[FM_GLORT_INDEX_FREE], glort, used);
+
+    fmSetBitArrayBit(&index[FM_GLORT_INDEX_LAG],
+                     glort,
+                     used || (state & FM_GLORT_STATE_RESV_LAG));
+    fmSetBitArrayBit(&index[FM_GLORT_INDEX_MCG],
+                     glort,
+                     used || (state & FM_GLORT_STATE_RESV_MCG));
+    fmSetBitArrayBit(&index[FM_GLORT_INDEX_LBG],
+                     glort,
+                     used || (state & FM_GLORT_STATE_RESV_LBG));
+
+    fmSetBitArrayBit(&index[FM_GLORT_INDEX_RESV_LAG],
+                     glort,
+                     used || !(state & FM_GLORT_STATE_RESV_LAG));
+    fmSetBitArrayBit(&index[FM_GLORT_INDEX_RESV_MCG],
+                     glort,
+                     used || !(state & FM_GLORT_STATE_RESV_MCG));
+    fmSetBitArrayBit(&index[FM_GLORT_INDEX_RESV_LBG],
+                     glort,
+                     used || !(state & FM_GLORT_STATE_RESV_LBG));
+
+}   /* end SetGlortState */
+
+
+
+
 /*****************************************************************************/
 /** GetGlortRange
  * \ingroup intPort
@@ -1985,8 +2056,8 @@ fm_status fmFindFreeGlortRangeInt(fm_int       sw,
     fm_switch *         switchPtr;
     fm_logicalPortInfo *lportInfo;
     fm_glortRange *     range;
-    fm_uint32           glort;
-    fm_int              freeCount;
+    fm_int              index;
+    fm_int              foundGlort;
     fm_uint32           start;
     fm_uint32           rangeBase;;
     fm_uint32           rangeMax;
@@ -2014,10 +2085,8 @@ fm_status fmFindFreeGlortRangeInt(fm_int       sw,
     rangeBase  = range->glortBase;
     rangeMax   = FM_MAX_GLORT;
     rangeCount = 0;
-    glort      = 0;
 
     rangeEnd  = rangeStart + rangeSize - 1;
-    freeCount = 0;
     start     = 0;
 
     /***************************************************
@@ -2068,48 +2137,48 @@ fm_status fmFindFreeGlortRangeInt(fm_int       sw,
     }
 
     /***************************************************
-     * Find an unused block of GloRTs.
+     * Pick the index matching the search. A GloRT
+     * qualifies if it is unused and its reservation
+     * for glortType matches the reserved argument.
      **************************************************/
 
-    for (glort = rangeStart ; glort <= rangeEnd ; glort++)
+    switch (glortType)
     {
-        /***************************************************
-         * Three conditions must be met:
-         *   (a) The GloRT is in range 0 - FM_MAX_GLORT
-         *   (b) The GloRT is unused
-         *   (c) The GloRT is correctly reserved unless
-         *       reserved GloRTs are not expected
-         **************************************************/
-
-        if (!IsGlortCorrect(glort))
-        {
-            FM_LOG_ABORT(FM_LOG_CAT_GLORT, FM_ERR_INVALID_ARGUMENT);
-        }
-
-        if ( FM_IS_GLORT_FREE(lportInfo, glort) &&
-             (reserved == IsGlortReservedForType(switchPtr, glort, glortType)) )
-        {
-            if (freeCount == 0)
+        case FM_GLORT_TYPE_LAG:
+            index = reserved ? FM_GLORT_INDEX_RESV_LAG : FM_GLORT_INDEX_LAG;
+            break;
+        case FM_GLORT_TYPE_MULTICAST:
+            index = reserved ? FM_GLORT_INDEX_RESV_MCG : FM_GLORT_INDEX_MCG;
+            break;
+        case FM_GLORT_TYPE_LBG:
+            index = reserved ? FM_GLORT_INDEX_RESV_LBG : FM_GLORT_INDEX_LBG;
+            break;
+        default:
+            /* Other types can not be reserved. */
+            if (reserved)
             {
-                start = glort;
+                err = FM_ERR_NOT_FOUND;
+                goto ABORT;
             }
+            index = FM_GLORT_INDEX_FREE;
+            break;
+    }
 
-            ++freeCount;
+    /***************************************************
+     * Find an unused block of GloRTs.
+     **************************************************/
 
-            if (freeCount >= numGlorts)
-            {
-                break;
-            }
-        }
-        else
-        {
-            freeCount = 0;
-            start = 0;
-        }
-    }
+    err = fmFindBitRunInBitArray(&lportInfo->glortIndex[index],
+                                 rangeStart,
+                                 numGlorts,
+                                 &foundGlort);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_GLORT, err);
 
-    if (freeCount >= numGlorts)
+    if ( (foundGlort >= 0) &&
+         ( (fm_uint32) foundGlort + numGlorts - 1 <= rangeEnd ) )
     {
+        start = foundGlort;
+
         if (startGlort != NULL)
         {
             *startGlort = start;
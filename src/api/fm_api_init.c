@@ -143,6 +143,9 @@ extern const fm_switch           FMSWAGSwitchDefaultTable;
 /* True if we are the process that owns the global event handler */
 static fm_bool                   fmFirstProcess = FALSE;
 
+/* True if this process attached with fmInitializeMonitor */
+static fm_bool                   fmMonitorProcess = FALSE;
+
 static const fm_switchModelEntry fmSwitchModelList[] =
 {
 #if FM_SUPPORT_FM2000
@@ -539,6 +542,12 @@ static fm_status fmAllocateSwitchLocks(fm_switch *swstate)
                          &swstate->stateLock);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
+    err = fmCreateLockV2("statsLock", 
+                         swstate->switchNumber,
+                         FM_LOCK_PREC_STATS,
+                         &swstate->statsLock);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
     err = fmCreateLockV2("L2Lock", 
                          swstate->switchNumber,
                          FM_LOCK_PREC_L2,
@@ -681,6 +690,11 @@ static fm_status fmFreeSwitchLocks(fm_switch *swstate)
         FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
     }
 
+    if ( ( err = fmDeleteLock(&swstate->statsLock) ) != FM_OK )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+    }
+
     if ( ( err = fmDeleteLock(&swstate->L2Lock) ) != FM_OK )
     {
         FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
@@ -989,7 +1003,11 @@ static fm_status fmAllocateSwitchDataStructures(fm_int sw)
     /**************************************************
      * Switch-Type-Specific Initializations
      **************************************************/
-    if ( ( err = swstate->InitSwitch(swstate) ) != FM_OK )
+    fmDbgBootPhaseBegin(sw, "InitSwitch", -1);
+    err = swstate->InitSwitch(swstate);
+    fmDbgBootPhaseEnd(sw, "InitSwitch");
+
+    if (err != FM_OK)
     {
         FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
     }
@@ -998,7 +1016,9 @@ static fm_status fmAllocateSwitchDataStructures(fm_int sw)
     /**************************************************
      * Allocate switch-specific data structures
      **************************************************/
+    fmDbgBootPhaseBegin(sw, "AllocSwitchExtension", -1);
     FM_API_CALL_FAMILY(err, swstate->AllocateDataStructures, swstate);
+    fmDbgBootPhaseEnd(sw, "AllocSwitchExtension");
 
     if (err != FM_OK)
     {
@@ -1008,7 +1028,11 @@ static fm_status fmAllocateSwitchDataStructures(fm_int sw)
     /**************************************************
      * Mac Table Maintenance
      **************************************************/
-    if ( ( err = fmAllocateMacTableMaintenanceDataStructures(swstate) ) != FM_OK )
+    fmDbgBootPhaseBegin(sw, "AllocMacTableMaintenance", -1);
+    err = fmAllocateMacTableMaintenanceDataStructures(swstate);
+    fmDbgBootPhaseEnd(sw, "AllocMacTableMaintenance");
+
+    if (err != FM_OK)
     {
         FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
     }
@@ -1016,7 +1040,11 @@ static fm_status fmAllocateSwitchDataStructures(fm_int sw)
     /**************************************************
      * Address Table
      **************************************************/
-    if ( ( err = fmAllocateAddressTableDataStructures(swstate) ) != FM_OK )
+    fmDbgBootPhaseBegin(sw, "AllocAddressTable", -1);
+    err = fmAllocateAddressTableDataStructures(swstate);
+    fmDbgBootPhaseEnd(sw, "AllocAddressTable");
+
+    if (err != FM_OK)
     {
         FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
     }
@@ -1024,7 +1052,11 @@ static fm_status fmAllocateSwitchDataStructures(fm_int sw)
     /**************************************************
      * Vlan Table
      **************************************************/
-    if ( ( err = fmAllocateVlanTableDataStructures(swstate) ) != FM_OK )
+    fmDbgBootPhaseBegin(sw, "AllocVlanTable", -1);
+    err = fmAllocateVlanTableDataStructures(swstate);
+    fmDbgBootPhaseEnd(sw, "AllocVlanTable");
+
+    if (err != FM_OK)
     {
         FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
     }
@@ -1044,7 +1076,11 @@ static fm_status fmAllocateSwitchDataStructures(fm_int sw)
     /**************************************************
      * STP Instance Table
      **************************************************/
-    if ( ( err = fmAllocateStpInstanceTreeDataStructures(swstate) ) != FM_OK )
+    fmDbgBootPhaseBegin(sw, "AllocStpInstances", -1);
+    err = fmAllocateStpInstanceTreeDataStructures(swstate);
+    fmDbgBootPhaseEnd(sw, "AllocStpInstances");
+
+    if (err != FM_OK)
     {
         FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
     }
@@ -1052,7 +1088,11 @@ static fm_status fmAllocateSwitchDataStructures(fm_int sw)
     /**************************************************
      * Mirror Groups
      **************************************************/
-    if ( ( err = fmAllocatePortMirrorDataStructures(swstate) ) != FM_OK )
+    fmDbgBootPhaseBegin(sw, "AllocMirrorGroups", -1);
+    err = fmAllocatePortMirrorDataStructures(swstate);
+    fmDbgBootPhaseEnd(sw, "AllocMirrorGroups");
+
+    if (err != FM_OK)
     {
         FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
     }
@@ -1060,7 +1100,11 @@ static fm_status fmAllocateSwitchDataStructures(fm_int sw)
     /**************************************************
      * Counter Storage
      **************************************************/
-    if ( ( err = fmAllocateCounterDataStructures(swstate) ) != FM_OK )
+    fmDbgBootPhaseBegin(sw, "AllocCounters", -1);
+    err = fmAllocateCounterDataStructures(swstate);
+    fmDbgBootPhaseEnd(sw, "AllocCounters");
+
+    if (err != FM_OK)
     {
         FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
     }
@@ -1068,7 +1112,11 @@ static fm_status fmAllocateSwitchDataStructures(fm_int sw)
     /**************************************************
      * Load balancing groups
      **************************************************/
-    if ( ( err = fmAllocateLBGDataStructures(swstate) ) != FM_OK )
+    fmDbgBootPhaseBegin(sw, "AllocLBGs", -1);
+    err = fmAllocateLBGDataStructures(swstate);
+    fmDbgBootPhaseEnd(sw, "AllocLBGs");
+
+    if (err != FM_OK)
     {
         FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
     }
@@ -1076,7 +1124,9 @@ static fm_status fmAllocateSwitchDataStructures(fm_int sw)
     /**************************************************
      * Virtual Networks.
      **************************************************/
+    fmDbgBootPhaseBegin(sw, "AllocVN", -1);
     err = fmVNAlloc(sw);
+    fmDbgBootPhaseEnd(sw, "AllocVN");
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
     /**************************************************
@@ -1085,7 +1135,9 @@ static fm_status fmAllocateSwitchDataStructures(fm_int sw)
      * If this switch does not support routing, this
      * function is expected to just return FM_OK.
      **************************************************/
+    fmDbgBootPhaseBegin(sw, "AllocRouter", -1);
     err = fmRouterAlloc(sw);
+    fmDbgBootPhaseEnd(sw, "AllocRouter");
     if (err != FM_OK)
     {
         FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
@@ -1094,7 +1146,9 @@ static fm_status fmAllocateSwitchDataStructures(fm_int sw)
     /************************************************** 
      *  NextHop resources allocation
      **************************************************/
+    fmDbgBootPhaseBegin(sw, "AllocNextHop", -1);
     err = fmNextHopAlloc(sw);
+    fmDbgBootPhaseEnd(sw, "AllocNextHop");
     if (err != FM_OK)
     {
         FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
@@ -1266,6 +1320,11 @@ static fm_status fmFreeSwitchDataStructures(fm_int sw)
         /* Don't return, just continue on */
     }
 
+    /**************************************************
+     * Register access profile.
+     **************************************************/
+    fmDbgFreeRegProfile(sw);
+
     /**************************************************
      * Multicast state.
      **************************************************/
@@ -1691,8 +1750,9 @@ static fm_status CreateLocalDispatchThread(void)
     firstProcess =
         (FM_DLL_GET_FIRST( (&fmRootApi->localDeliveryThreads), head ) == NULL);
 
-    delivery->mask      = ~(firstProcess ? 0 : FM_EVENT_PKT_RECV);
-    delivery->processId = myProcessId;
+    delivery->mask          = ~(firstProcess ? 0 : FM_EVENT_PKT_RECV);
+    delivery->processId     = myProcessId;
+    delivery->filterEnabled = FALSE;
 
     err = fmCreateThread(threadName,
                          FM_DISPATCH_QUEUE_SIZE,
@@ -1709,6 +1769,7 @@ static fm_status CreateLocalDispatchThread(void)
     if (err == FM_OK)
     {
         fmRootApi->localDeliveryCount++;
+        err = fmPublishLocalDelivery();
     }
 
 ABORT:
@@ -1892,6 +1953,9 @@ static fm_status fmApiRootInit(void)
                        &fmRootApi->localDeliveryLock);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
+    err = fmCreateLock("Switch fan-out lock", &fmRootApi->fanOutLock);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
     /* no switches are present at startup */
     for (sw = 0 ; sw < FM_MAX_NUM_SWITCHES ; sw++)
     {
@@ -1909,11 +1973,13 @@ static fm_status fmApiRootInit(void)
     /* start event thread, must be done before fmPlatformInitialize
      * so it can receive events from platform, such as switch insert.
      */
-    err = fmCreateThread("events",
-                         FM_EVENT_QUEUE_SIZE_LARGE,
-                         &fmGlobalEventHandler,
-                         NULL,
-                         &fmRootApi->eventThread);
+    err = fmCreateThreadV2("events",
+                           FM_EVENT_QUEUE_SIZE_LARGE,
+                           GET_PROPERTY()->eventRingQueues ?
+                               FM_EVENT_QUEUE_FLAG_RING : 0,
+                           &fmGlobalEventHandler,
+                           NULL,
+                           &fmRootApi->eventThread);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
     /* Initialize the event handling subsystem */
@@ -1965,6 +2031,112 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** StartSwitchTasks
+ * \ingroup intSwitch
+ *
+ * \desc            Creates an interrupt handler, a MAC table maintenance and
+ *                  a packet receive task for each switch, as selected by the
+ *                  api.perSwitchTasks property, in place of the tasks shared
+ *                  by all the switches.
+ *
+ * \param           None
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status StartSwitchTasks(void)
+{
+    fm_switchTasks *tasks;
+    fm_property *   prop;
+    fm_status       err;
+    fm_int          sw;
+    fm_char         name[32];
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "(no arguments)\n");
+
+    prop = GET_PROPERTY();
+
+    /* Create all the semaphores before they are signaled per switch */
+    for (sw = FM_FIRST_FOCALPOINT ; sw <= FM_LAST_FOCALPOINT ; sw++)
+    {
+        tasks     = &fmRootApi->switchTasks[sw];
+        tasks->sw = sw;
+
+        err = fmCreateSemaphore("intrAvail",
+                                FM_SEM_BINARY,
+                                &tasks->intrAvail,
+                                0);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+        err = fmCreateSemaphore("macTableMaintSemaphore",
+                                FM_SEM_BINARY,
+                                &tasks->macTableMaintSemaphore,
+                                0);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+        err = fmCreateSemaphore("Packet Receive",
+                                FM_SEM_BINARY,
+                                &tasks->packetReceiveSemaphore,
+                                0);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
+    fmRootApi->perSwitchTasks = TRUE;
+
+    for (sw = FM_FIRST_FOCALPOINT ; sw <= FM_LAST_FOCALPOINT ; sw++)
+    {
+        tasks = &fmRootApi->switchTasks[sw];
+
+        if (!prop->interruptHandlerDisable)
+        {
+            FM_SPRINTF_S(name, sizeof(name), "InterruptHandlerTask%d", sw);
+
+            err = fmCreateThread(name,
+                                 FM_EVENT_QUEUE_SIZE_NONE,
+                                 fmSwitchInterruptHandler,
+                                 tasks,
+                                 &tasks->interruptTask);
+            FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+            /* Pick up any interrupt signaled before the switch had a task */
+            fmSignalSemaphore(&tasks->intrAvail);
+        }
+
+        if (prop->maTableMaintenanceEnable)
+        {
+            FM_SPRINTF_S(name, sizeof(name), "MacTableMaintenanceTask%d", sw);
+
+            err = fmCreateThread(name,
+                                 FM_EVENT_QUEUE_SIZE_NONE,
+                                 fmSwitchTableMaintenanceHandler,
+                                 tasks,
+                                 &tasks->maintenanceTask);
+            FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+        }
+
+        if (prop->packetReceiveEnable)
+        {
+            FM_SPRINTF_S(name, sizeof(name), "PacketReceiveTask%d", sw);
+
+            err = fmCreateThread(name,
+                                 FM_EVENT_QUEUE_SIZE_NONE,
+                                 fmSwitchReceivePacketTask,
+                                 tasks,
+                                 &tasks->packetReceiveTask);
+            FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+        }
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_OK);
+
+}   /* end StartSwitchTasks */
+
+
+
+
 /*****************************************************************************/
 /** fmApiThreadInit
  * \ingroup intSwitch
@@ -2005,7 +2177,17 @@ static fm_status fmApiThreadInit(void)
 
     prop = GET_PROPERTY();
 
-    if (!prop->interruptHandlerDisable)
+    if (prop->perSwitchTasks)
+    {
+        /* The interrupt, maintenance and receive tasks run per switch */
+        err = StartSwitchTasks();
+
+        if (err != FM_OK)
+        {
+            FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+        }
+    }
+    else if (!prop->interruptHandlerDisable)
     {
         /* Create the interrupt handler task */
         err = fmCreateThread("InterruptHandlerTask",
@@ -2020,7 +2202,7 @@ static fm_status fmApiThreadInit(void)
         }
     }
 
-    if (prop->maTableMaintenanceEnable)
+    if (prop->maTableMaintenanceEnable && !prop->perSwitchTasks)
     {
         /* Create the table maintenance task */
         err = fmCreateThread("MacTableMaintenanceTask",
@@ -2053,7 +2235,7 @@ static fm_status fmApiThreadInit(void)
         }
     }
 
-    if (prop->packetReceiveEnable)
+    if (prop->packetReceiveEnable && !prop->perSwitchTasks)
     {
         /* Create the packet receive thread */
         err = fmCreateThread("PacketReceiveTask",
@@ -2094,6 +2276,13 @@ static fm_status fmApiThreadInit(void)
         }
     }
 
+    /* Create the mailbox worker threads, if any. */
+    if (prop->mailboxWorkerThreads > 0)
+    {
+        err = fmMailboxStartWorkers();
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
     FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
 
 }   /* end fmApiThreadInit */
@@ -2184,6 +2373,11 @@ fm_status fmInitialize(fm_eventHandler eventHandlerFunc)
                      "eventHandlerFunc=%p\n",
                      (void *) (fm_uintptr) eventHandlerFunc);
 
+    if (fmMonitorProcess)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_ERR_INVALID_STATE);
+    }
+
     err = fmOSInitialize();
     if (err != FM_OK)
     {
@@ -2299,6 +2493,74 @@ fm_status fmInitialize(fm_eventHandler eventHandlerFunc)
 
 
 
+/*****************************************************************************/
+/** fmInitializeMonitor
+ * \ingroup api
+ *
+ * \desc            Called by a monitoring application, instead of
+ *                  ''fmInitialize'', to attach to the API state of a
+ *                  running application in read-only mode.
+ *                                                                      \lb\lb
+ *                  The API shared memory region named by the
+ *                  FM_API_SHM_KEY environment variable is mapped, but no
+ *                  shared state is created or modified: the process does
+ *                  not register for events, starts no API thread and does
+ *                  not initialize the platform. Monitoring therefore has no
+ *                  effect on the latency of the controlling application.
+ *                                                                      \lb\lb
+ *                  Once attached, the process may only use the snapshot
+ *                  accessors, which never take an API lock:
+ *                  ''fmGetPortCountersSnapshot'',
+ *                  ''fmGetPortAttributeSnapshot'' and
+ *                  ''fmGetAddressTableSnapshot''. Other API services must
+ *                  not be called, and ''fmInitialize'' fails. A monitoring
+ *                  process need not call ''fmTerminate''.
+ *
+ * \param           None.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if FM_API_SHM_KEY is not set, so
+ *                  that there is no shared region to attach to.
+ * \return          FM_ERR_NOT_FOUND if no application has initialized
+ *                  the API in the shared region.
+ * \return          FM_FAIL if the shared region was created by a different
+ *                  build of the API.
+ *
+ *****************************************************************************/
+fm_status fmInitializeMonitor(void)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_API, "(no arguments)\n");
+
+    if (fmRootApi != NULL)
+    {
+        /* Already a full client, or already attached. */
+        FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_OK);
+    }
+
+    err = fmOSAttach();
+    if (err != FM_OK)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_API, err);
+    }
+
+    err = fmFindRoot("api", (void **) &fmRootApi);
+    if (err != FM_OK)
+    {
+        fmRootApi = NULL;
+        FM_LOG_EXIT_API(FM_LOG_CAT_API, err);
+    }
+
+    fmMonitorProcess = TRUE;
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_OK);
+
+}   /* end fmInitializeMonitor */
+
+
+
+
 /*****************************************************************************/
 /** fmTerminate
  * \ingroup api
@@ -2327,8 +2589,9 @@ fm_status fmTerminate(void)
                      "first process = %d\n",
                      fmFirstProcess);
 
-    /* Do not terminate if it's the first process */
-    if (!fmFirstProcess)
+    /* Do not terminate if it's the first process. A monitoring process
+     * has nothing to terminate. */
+    if (!fmFirstProcess && !fmMonitorProcess)
     {
         /* Terminate local event dispatch thread for this process */
         err = TerminateLocalDispatchThread();
@@ -3016,15 +3279,21 @@ RESTART:
         switchPtr->generateEventOnDynamicAddr = prop->maEventOnDynAddr;
         switchPtr->generateEventOnAddrChange = prop->maEventOnAddrChange;
 
+        fmDbgBootPhaseBegin(sw, "SetSwitchState", -1);
         FM_API_CALL_FAMILY(err, switchPtr->SetSwitchState, sw, state);
+        fmDbgBootPhaseEnd(sw, "SetSwitchState");
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
         /* initialize data structures */
+        fmDbgBootPhaseBegin(sw, "InitSwitchDataStructure", -1);
         err = fmInitializeSwitchDataStructure(sw);
+        fmDbgBootPhaseEnd(sw, "InitSwitchDataStructure");
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
         /* Call platform layer post initialization */
+        fmDbgBootPhaseBegin(sw, "PlatformPostInitialize", -1);
         err = fmPlatformSwitchPostInitialize(sw);
+        fmDbgBootPhaseEnd(sw, "PlatformPostInitialize");
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
         /* The switch is now up, so we can proceed with the
@@ -3034,7 +3303,9 @@ RESTART:
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
         /* Perform switch-specific post-boot processing */
+        fmDbgBootPhaseBegin(sw, "PostBootSwitch", -1);
         FM_API_CALL_FAMILY(err, switchPtr->PostBootSwitch, sw);
+        fmDbgBootPhaseEnd(sw, "PostBootSwitch");
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
 #if FM_SUPPORT_SWAG
@@ -3170,6 +3441,12 @@ ABORT:
         fmRootApi->fmSwitchStateTable[sw]->state = FM_SWITCH_STATE_FAILED;
     }
 
+    if (state)
+    {
+        /* The bring-up is over, whether it succeeded or not */
+        fmDbgBootPhaseStop(sw);
+    }
+
     if (switchLocked)
     {
         UNLOCK_SWITCH(sw);
@@ -3341,6 +3618,43 @@ fm_status fmSetEventHandler(fm_eventHandler eventHandlerFunc)
 
 
 
+/*****************************************************************************/
+/** fmSetEventBatchHandler
+ * \ingroup api
+ *
+ * \desc            Set or clear the application's event batch handler
+ *                  call-back function. When set, events delivered to the
+ *                  current process are reported to it, up to
+ *                  ''FM_EVENT_BATCH_SIZE'' at a time, instead of to the
+ *                  event handler set by ''fmInitialize'' or
+ *                  ''fmSetEventHandler''.
+ *
+ * \note            Packets received with the
+ *                  ''api.packet.rxDirectEnqueueing'' property set are
+ *                  still reported to the event handler.
+ *
+ * \param[in]       eventBatchHandlerFunc points to the event batch handler
+ *                  call-back function, or is NULL to report events to the
+ *                  event handler again. See ''fm_eventBatchHandler''.
+ *
+ * \return          FM_OK
+ *
+ *****************************************************************************/
+fm_status fmSetEventBatchHandler(fm_eventBatchHandler eventBatchHandlerFunc)
+{
+    FM_LOG_ENTRY_API(FM_LOG_CAT_API,
+                     "eventBatchHandlerFunc=%p\n",
+                     (void *) (fm_uintptr) eventBatchHandlerFunc);
+
+    fmEventBatchHandler = eventBatchHandlerFunc;
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_OK);
+
+}   /* end fmSetEventBatchHandler */
+
+
+
+
 /*****************************************************************************/
 /** fmSetSwitchEventHandler
  * \ingroup intApi
@@ -3930,6 +4244,9 @@ fm_status fmHandleSwitchInserted(fm_int sw, fm_eventSwitchInserted *insertEvent)
         FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_ERR_INVALID_ARGUMENT);
     }
 
+    /* Time the bring-up, if the platform has not already started to */
+    fmDbgBootPhaseStart(sw);
+
     /* Some platform must first initialize management path prior to access
      * the switch. */
     status = fmPlatformSwitchPreInsert(sw);
@@ -58,6 +58,274 @@
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/** ValidateLagPort
+ * \ingroup intLag
+ *
+ * \desc            Checks that a port may be added to or deleted from a LAG.
+ *
+ * \param[in]       sw is the switch number on which to operate.
+ *
+ * \param[in]       port is the logical port number.
+ *
+ * \param[in]       adding is TRUE if the port is being added, in which case
+ *                  it must also be LAG capable.
+ *
+ * \return          FM_OK if the port is valid.
+ * \return          FM_ERR_INVALID_PORT if the port is invalid.
+ *
+ *****************************************************************************/
+static fm_status ValidateLagPort(fm_int sw, fm_int port, fm_bool adding)
+{
+    fm_switch *switchPtr;
+    fm_port *  portPtr;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if ( !fmIsValidPort(sw, port, switchPtr->lagInfoTable.allowedPortTypes) )
+    {
+        return FM_ERR_INVALID_PORT;
+    }
+
+    portPtr = GET_PORT_PTR(sw, port);
+
+    if ( adding
+        && !fmIsRemotePort(sw, port)
+        && !(portPtr->capabilities & FM_PORT_CAPABILITY_LAG_CAPABLE) )
+    {
+        return FM_ERR_INVALID_PORT;
+    }
+
+    return FM_OK;
+
+}   /* end ValidateLagPort */
+
+
+
+
+/*****************************************************************************/
+/** AddLagPortInt
+ * \ingroup intLag
+ *
+ * \desc            Adds a validated port to a LAG.
+ *
+ * \note            The caller must hold the routing and LAG locks.
+ *
+ * \param[in]       sw is the switch number on which to operate.
+ *
+ * \param[in]       lagIndex is the index of the LAG.
+ *
+ * \param[in]       port is the number of the port to be added to the LAG.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_ALREADYUSED_PORT if the port is already a member
+ *                  of a LAG.
+ * \return          FM_FAIL if the port and the LAG are not both internal or
+ *                  both external.
+ *
+ *****************************************************************************/
+static fm_status AddLagPortInt(fm_int sw, fm_int lagIndex, fm_int port)
+{
+    fm_switch *switchPtr;
+    fm_lag *   lagPtr;
+    fm_status  err;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if ( fmPortIsInALAG(sw, port) )
+    {
+        return FM_ERR_ALREADYUSED_PORT;
+    }
+
+    /* Internal LAG should be filled only by Internal Port AND */
+    /* External LAG should be filled only by External Port     */
+    if (fmIsCardinalPort(sw, port))
+    {
+        lagPtr = GET_LAG_PTR(sw, lagIndex);
+        if ( lagPtr->isInternalPort != fmIsInternalPort(sw, port) )
+        {
+            return FM_FAIL;
+        }
+    }
+
+    switchPtr->portTable[port]->lagIndex = lagIndex;
+
+    FM_API_CALL_FAMILY(err, switchPtr->AddPortToLag, sw, lagIndex, port);
+
+    if (err != FM_OK)
+    {
+        switchPtr->portTable[port]->lagIndex = -1;
+    }
+    else
+    {
+        FM_INVALIDATE_TX_DESTINATIONS(sw);
+    }
+
+    return err;
+
+}   /* end AddLagPortInt */
+
+
+
+
+/*****************************************************************************/
+/** DeleteLagPortInt
+ * \ingroup intLag
+ *
+ * \desc            Deletes a validated port from a LAG.
+ *
+ * \note            The caller must hold the routing and LAG locks.
+ *
+ * \param[in]       sw is the switch number on which to operate.
+ *
+ * \param[in]       lagIndex is the index of the LAG.
+ *
+ * \param[in]       port is the number of the port to be deleted.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_PORT if the port is not a member of the
+ *                  LAG.
+ *
+ *****************************************************************************/
+static fm_status DeleteLagPortInt(fm_int sw, fm_int lagIndex, fm_int port)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    /* Check that the port is actually in the LAG we're trying to
+     * remove it from. */
+    if ( !fmPortIsInLAG(sw, port, lagIndex) )
+    {
+        return FM_ERR_INVALID_PORT;
+    }
+
+    FM_API_CALL_FAMILY(err, switchPtr->DeletePortFromLag, sw, lagIndex, port);
+
+    if (err == FM_OK)
+    {
+        FM_INVALIDATE_TX_DESTINATIONS(sw);
+    }
+
+    return err;
+
+}   /* end DeleteLagPortInt */
+
+
+
+
+/*****************************************************************************/
+/** ApplyLagPortList
+ * \ingroup intLag
+ *
+ * \desc            Adds or deletes a list of ports to or from a LAG, with
+ *                  the LAG-wide hardware updates deferred until the whole
+ *                  list has been applied.
+ *
+ * \param[in]       sw is the switch number on which to operate.
+ *
+ * \param[in]       lagNumber is the LAG number.
+ *
+ * \param[in]       numPorts is the number of ports in portList.
+ *
+ * \param[in]       portList points to the array of ports.
+ *
+ * \param[in]       adding is TRUE to add the ports, FALSE to delete them.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if portList is NULL or numPorts
+ *                  is negative.
+ * \return          FM_ERR_INVALID_PORT if a port is invalid.
+ * \return          FM_ERR_INVALID_LAG if lagNumber is invalid.
+ * \return          Any error returned by ''fmAddLAGPort'' or
+ *                  ''fmDeleteLAGPort''.
+ *
+ *****************************************************************************/
+static fm_status ApplyLagPortList(fm_int  sw,
+                                  fm_int  lagNumber,
+                                  fm_int  numPorts,
+                                  fm_int *portList,
+                                  fm_bool adding)
+{
+    fm_switch * switchPtr;
+    fm_lagInfo *lagInfo;
+    fm_int      lagIndex;
+    fm_int      i;
+    fm_status   err;
+    fm_status   err2;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    lagInfo   = &switchPtr->lagInfoTable;
+
+    if ( (numPorts < 0) || ( (numPorts > 0) && (portList == NULL) ) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    for (i = 0 ; i < numPorts ; i++)
+    {
+        err = ValidateLagPort(sw, portList[i], adding);
+        if (err != FM_OK)
+        {
+            return err;
+        }
+    }
+
+    err = fmCaptureWriteLock(&switchPtr->routingLock, FM_WAIT_FOREVER);
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    TAKE_LAG_LOCK(sw);
+
+    lagIndex = fmGetLagIndex(sw, lagNumber);
+    if (lagIndex < 0)
+    {
+        err = FM_ERR_INVALID_LAG;
+        goto ABORT;
+    }
+
+    /* Only defer when the chip can apply the deferred updates. */
+    lagInfo->deferUpdates = (switchPtr->FlushLagUpdates != NULL);
+
+    for (i = 0 ; i < numPorts ; i++)
+    {
+        if (adding)
+        {
+            err = AddLagPortInt(sw, lagIndex, portList[i]);
+        }
+        else
+        {
+            err = DeleteLagPortInt(sw, lagIndex, portList[i]);
+        }
+
+        if (err != FM_OK)
+        {
+            break;
+        }
+    }
+
+    /* Ports applied before any failure stay applied, so the hardware must
+     * be brought up to date in either case. */
+    if (lagInfo->deferUpdates)
+    {
+        lagInfo->deferUpdates = FALSE;
+
+        err2 = switchPtr->FlushLagUpdates(sw);
+        FM_ERR_COMBINE(err, err2);
+    }
+
+ABORT:
+    DROP_LAG_LOCK(sw);
+    fmReleaseWriteLock(&switchPtr->routingLock);
+
+    return err;
+
+}   /* end ApplyLagPortList */
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -209,6 +477,11 @@ fm_status fmDeleteLAG(fm_int sw, fm_int lagNumber)
 
     FM_API_CALL_FAMILY(err, switchPtr->DeleteLagFromSwitch, sw, lagIndex);
 
+    if (err == FM_OK)
+    {
+        FM_INVALIDATE_TX_DESTINATIONS(sw);
+    }
+
     if ( (err == FM_OK) && (lagPtr->deleteSemaphore != NULL) )
     {
         wait.sec = prop->lagDelSemTimeout;
@@ -283,7 +556,6 @@ fm_status fmAddLAGPort(fm_int sw, fm_int lagNumber, fm_int port)
     fm_switch *switchPtr;
     fm_int     lagIndex;
     fm_status  err;
-    fm_lag *   lagPtr;
     fm_port *  portPtr;
     fm_bool    lagLockTaken = FALSE;
     fm_bool    routeLockTaken = FALSE;
@@ -327,31 +599,8 @@ fm_status fmAddLAGPort(fm_int sw, fm_int lagNumber, fm_int port)
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err = FM_ERR_INVALID_LAG);
     }
 
-    if ( fmPortIsInALAG(sw, port) )
-    {
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err = FM_ERR_ALREADYUSED_PORT);
-    }
-
-    /* Internal LAG should be filled only by Internal Port AND */
-    /* External LAG should be filled only by External Port     */
-    if (fmIsCardinalPort(sw, port))
-    {
-        lagPtr = GET_LAG_PTR(sw, lagIndex);
-        if ( lagPtr->isInternalPort != fmIsInternalPort(sw, port) )
-        {
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err = FM_FAIL);
-        }
-    }
-
-    switchPtr->portTable[port]->lagIndex = lagIndex;
-
-    FM_API_CALL_FAMILY(err, switchPtr->AddPortToLag, sw, lagIndex, port);
-
-    if (err != FM_OK)
-    {
-        switchPtr->portTable[port]->lagIndex = -1;
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
-    }
+    err = AddLagPortInt(sw, lagIndex, port);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
 
 ABORT:
     if (lagLockTaken)
@@ -436,15 +685,7 @@ fm_status fmDeleteLAGPort(fm_int sw, fm_int lagNumber, fm_int port)
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
     }
 
-    /* Check that the port is actually in the LAG we're trying to
-     * remove it from. */
-    if ( !fmPortIsInLAG(sw, port, lagIndex) )
-    {
-        err = FM_ERR_INVALID_PORT;
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
-    }
-
-    FM_API_CALL_FAMILY(err, switchPtr->DeletePortFromLag, sw, lagIndex, port);
+    err = DeleteLagPortInt(sw, lagIndex, port);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_LAG, err);
 
 ABORT:
@@ -468,6 +709,134 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fmAddLAGPortList
+ * \ingroup lag
+ *
+ * \chips           FM10000
+ *
+ * \desc            Add a list of ports to a link aggregation group. This is
+ *                  equivalent to calling ''fmAddLAGPort'' for each port,
+ *                  except that the LAG's port masks, LAG configuration and
+ *                  glort destination table are written once for the whole
+ *                  list rather than once per port.
+ *
+ * \note            The ports are added in list order. If adding a port
+ *                  fails, the ports before it remain members of the LAG
+ *                  and the ports after it are not added.
+ *
+ * \param[in]       sw is the switch number on which to operate.
+ *
+ * \param[in]       lagNumber is the LAG number (returned by
+ *                  fmCreateLAG) to which the ports should be added.
+ *
+ * \param[in]       numPorts is the number of ports in portList.
+ *
+ * \param[in]       portList points to an array of the ports to be added.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if portList is NULL or numPorts
+ *                  is negative.
+ * \return          FM_ERR_INVALID_PORT if a port is invalid. No port is
+ *                  added in that case.
+ * \return          FM_ERR_INVALID_LAG if lagNumber is out of range or is
+ *                  not the handle of an existing LAG.
+ * \return          FM_ERR_ALREADYUSED_PORT if a port is already a member
+ *                  of a LAG.
+ * \return          FM_ERR_FULL_LAG if the LAG already contains the maximum
+ *                  number of ports (''FM_MAX_NUM_LAG_MEMBERS'').
+ *
+ *****************************************************************************/
+fm_status fmAddLAGPortList(fm_int  sw,
+                           fm_int  lagNumber,
+                           fm_int  numPorts,
+                           fm_int *portList)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_LAG,
+                     "sw = %d, lagNumber = %d, numPorts = %d, portList = %p\n",
+                     sw,
+                     lagNumber,
+                     numPorts,
+                     (void *) portList);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    err = ApplyLagPortList(sw, lagNumber, numPorts, portList, TRUE);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_LAG, err);
+
+}   /* end fmAddLAGPortList */
+
+
+
+
+/*****************************************************************************/
+/** fmDeleteLAGPortList
+ * \ingroup lag
+ *
+ * \chips           FM10000
+ *
+ * \desc            Delete a list of ports from a link aggregation group.
+ *                  This is equivalent to calling ''fmDeleteLAGPort'' for
+ *                  each port, except that the LAG's port masks, LAG
+ *                  configuration and glort destination table are written
+ *                  once for the whole list rather than once per port.
+ *
+ * \note            The ports are deleted in list order. If deleting a port
+ *                  fails, the ports before it have been deleted and the
+ *                  ports after it remain members of the LAG.
+ *
+ * \param[in]       sw is the switch number on which to operate.
+ *
+ * \param[in]       lagNumber is the LAG number (returned by
+ *                  fmCreateLAG) from which the ports should be deleted.
+ *
+ * \param[in]       numPorts is the number of ports in portList.
+ *
+ * \param[in]       portList points to an array of the ports to be deleted.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if portList is NULL or numPorts
+ *                  is negative.
+ * \return          FM_ERR_INVALID_PORT if a port is invalid or is not a
+ *                  member of the specified LAG.
+ * \return          FM_ERR_INVALID_LAG if lagNumber is out of range or is
+ *                  not the handle of an existing LAG.
+ *
+ *****************************************************************************/
+fm_status fmDeleteLAGPortList(fm_int  sw,
+                              fm_int  lagNumber,
+                              fm_int  numPorts,
+                              fm_int *portList)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_LAG,
+                     "sw = %d, lagNumber = %d, numPorts = %d, portList = %p\n",
+                     sw,
+                     lagNumber,
+                     numPorts,
+                     (void *) portList);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    err = ApplyLagPortList(sw, lagNumber, numPorts, portList, FALSE);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_LAG, err);
+
+}   /* end fmDeleteLAGPortList */
+
+
+
+
 /*****************************************************************************/
 /** fmGetLAGList
  * \ingroup lag
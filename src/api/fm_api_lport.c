@@ -146,6 +146,62 @@ static int CompareByGlort(const void *aPtr, const void *bPtr)
 
 
 
+/*****************************************************************************/
+/** ResetLogicalPortIndexes
+ * \ingroup intPort
+ *
+ * \desc            Resets the GloRT and logical port free-range indexes to
+ *                  match all-unused glortState and lportState arrays.
+ *
+ * \param[in,out]   lportInfo points to the logical port information
+ *                  structure.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ResetLogicalPortIndexes(fm_logicalPortInfo *lportInfo)
+{
+    fm_int index;
+
+    for (index = 0 ; index < FM_GLORT_INDEX_MAX ; index++)
+    {
+        if (lportInfo->glortIndex[index].bitCount == 0)
+        {
+            continue;
+        }
+
+        fmClearBitArray(&lportInfo->glortIndex[index]);
+
+        /* An unused GloRT is not reserved for anybody. */
+        if ( (index == FM_GLORT_INDEX_RESV_LAG) ||
+             (index == FM_GLORT_INDEX_RESV_MCG) ||
+             (index == FM_GLORT_INDEX_RESV_LBG) )
+        {
+            fmSetBitArrayBlock(&lportInfo->glortIndex[index],
+                               0,
+                               lportInfo->glortIndex[index].bitCount,
+                               TRUE);
+        }
+    }
+
+    if (lportInfo->lportIndex.bitCount != 0)
+    {
+        fmClearBitArray(&lportInfo->lportIndex);
+    }
+
+    if (lportInfo->glortToPort != NULL)
+    {
+        for (index = 0 ; index <= FM_MAX_GLORT ; index++)
+        {
+            lportInfo->glortToPort[index] = -1;
+        }
+    }
+
+}   /* end ResetLogicalPortIndexes */
+
+
+
+
 /*****************************************************************************/
 /** PortTypeToGlortType
  * \ingroup intPort
@@ -944,6 +1000,7 @@ static fm_status CreateLogicalPort(fm_switch *   switchPtr,
     portPtr->physicalPort   = physPort;
 
     switchPtr->portTable[port] = portPtr;
+    fmAddGlortLogicalPort(switchPtr, port);
 
     /* Allocate and initialize the port extension structure. */
     FM_API_CALL_FAMILY(err,
@@ -956,6 +1013,7 @@ static fm_status CreateLogicalPort(fm_switch *   switchPtr,
         /* Unable to create the port extension structure,
          * so free the fm_port structure allocated above and return an error.
          */
+        fmRemoveGlortLogicalPort(switchPtr, port);
         switchPtr->portTable[port] = NULL;
         fmFree(portPtr);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
@@ -1019,6 +1077,7 @@ static fm_status CreateLogicalPort(fm_switch *   switchPtr,
     err = fmInitPort(switchPtr->switchNumber, portPtr);
     if (err != FM_OK)
     {
+        fmRemoveGlortLogicalPort(switchPtr, port);
         switchPtr->portTable[port] = NULL;
 
         /* Free the port extension structure, which has been allocated in
@@ -1100,6 +1159,7 @@ static fm_status CreateVirtualLogicalPort(fm_switch *   switchPtr,
     portPtr->glort          = glort;
 
     switchPtr->portTable[port] = portPtr;
+    fmAddGlortLogicalPort(switchPtr, port);
 
     /* Allocate and initialize the port extension structure. */
     FM_API_CALL_FAMILY(err,
@@ -1112,6 +1172,7 @@ static fm_status CreateVirtualLogicalPort(fm_switch *   switchPtr,
         /* Unable to create the port extension structure,
          * so free the fm_port structure allocated above and return an error.
          */
+        fmRemoveGlortLogicalPort(switchPtr, port);
         switchPtr->portTable[port] = NULL;
         fmFree(portPtr);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
@@ -1129,6 +1190,7 @@ static fm_status CreateVirtualLogicalPort(fm_switch *   switchPtr,
     err = fmInitPort(switchPtr->switchNumber, portPtr);
     if (err != FM_OK)
     {
+        fmRemoveGlortLogicalPort(switchPtr, port);
         switchPtr->portTable[port] = NULL;
 
         /* Free the port extension structure, which has been allocated in
@@ -1924,6 +1986,8 @@ fm_status fmCommonFreeLogicalPort(fm_int sw, fm_int logicalPort)
          * Free the data structures.
          **************************************************/
 
+        fmRemoveGlortLogicalPort(switchPtr, port);
+
         fmFree(portPtr->extension);
         fmFree(portPtr);
 
@@ -1963,6 +2027,8 @@ fm_status fmAllocateLogicalPortDataStructures(fm_int sw,
     fm_logicalPortInfo *lportInfo;
     fm_switch *         switchPtr;
     fm_uint             nbytes;
+    fm_status           err;
+    fm_int              index;
 
     FM_LOG_ENTRY(FM_LOG_CAT_PORT,
                  "sw = %d numCamEntries = %d numDestEntries %d\n",
@@ -2003,6 +2069,34 @@ fm_status fmAllocateLogicalPortDataStructures(fm_int sw,
 
     memset(lportInfo->destEntries, 0, nbytes);
 
+    /***************************************************
+     * Allocate the GloRT and logical port free-range
+     * indexes.
+     **************************************************/
+
+    for (index = 0 ; index < FM_GLORT_INDEX_MAX ; index++)
+    {
+        err = fmCreateBitArray(&lportInfo->glortIndex[index], FM_MAX_GLORT + 1);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PORT, err);
+    }
+
+    err = fmCreateBitArray(&lportInfo->lportIndex, FM_MAX_LOGICAL_PORT + 1);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PORT, err);
+
+    /***************************************************
+     * Allocate the glort to logical port index.
+     **************************************************/
+
+    nbytes = sizeof(fm_int) * (FM_MAX_GLORT + 1);
+
+    lportInfo->glortToPort = fmAlloc(nbytes);
+    if (lportInfo->glortToPort == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PORT, FM_ERR_NO_MEM);
+    }
+
+    ResetLogicalPortIndexes(lportInfo);
+
     FM_LOG_EXIT(FM_LOG_CAT_PORT, FM_OK);
 
 }   /* end fmAllocateLogicalPortDataStructures */
@@ -2091,6 +2185,7 @@ fm_status fmFreeLogicalPortDataStructures(fm_switch *switchPtr)
     fm_logicalPortInfo *lportInfo;
     fm_int              lane;
     fm_status           err;
+    fm_int              index;
 
     FM_LOG_ENTRY(FM_LOG_CAT_PORT, "sw = %d\n", switchPtr->switchNumber);
 
@@ -2155,6 +2250,27 @@ fm_status fmFreeLogicalPortDataStructures(fm_switch *switchPtr)
         lportInfo->destEntries = NULL;
     }
 
+    /***************************************************
+     * Free the free-range indexes.
+     **************************************************/
+
+    for (index = 0 ; index < FM_GLORT_INDEX_MAX ; index++)
+    {
+        fmDeleteBitArray(&lportInfo->glortIndex[index]);
+    }
+
+    fmDeleteBitArray(&lportInfo->lportIndex);
+
+    /***************************************************
+     * Free the glort to logical port index.
+     **************************************************/
+
+    if (lportInfo->glortToPort)
+    {
+        fmFree(lportInfo->glortToPort);
+        lportInfo->glortToPort = NULL;
+    }
+
     FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
 
 }   /* end fmFreeLogicalPortDataStructures */
@@ -2685,6 +2801,8 @@ fm_status fmFreeLogicalPortForMailboxGlort(fm_int sw,
          * Free the data structures.
          **************************************************/
 
+        fmRemoveGlortLogicalPort(switchPtr, logicalPort);
+
         if (portPtr->extension != NULL)
         {
             fmFree(portPtr->extension);
@@ -3447,9 +3565,10 @@ fm_status fmSortPortByGlort(fm_int sw,
  *****************************************************************************/
 fm_status fmGetGlortLogicalPort(fm_int sw, fm_uint32 glort, fm_int *logicalPort)
 {
-    fm_status  err;
-    fm_port *  portPtr;
-    fm_int     i;
+    fm_switch *          switchPtr;
+    fm_logicalPortInfo * lportInfo;
+    fm_port *            portPtr;
+    fm_int               port;
 
     FM_LOG_ENTRY(FM_LOG_CAT_PORT, "sw=%d glort=0x%x\n", sw, glort);
 
@@ -3458,32 +3577,154 @@ fm_status fmGetGlortLogicalPort(fm_int sw, fm_uint32 glort, fm_int *logicalPort)
         FM_LOG_EXIT(FM_LOG_CAT_PORT, FM_ERR_INVALID_ARGUMENT);
     }
 
-    for (i = 0 ; i < FM_MAX_LOGICAL_PORT ; i++)
+    switchPtr = GET_SWITCH_PTR(sw);
+    lportInfo = &switchPtr->logicalPortInfo;
+
+    if ( (glort > FM_MAX_GLORT) || (lportInfo->glortToPort == NULL) )
     {
-        portPtr = GET_PORT_PTR(sw, i);
+        FM_LOG_EXIT(FM_LOG_CAT_PORT, FM_ERR_INVALID_PORT);
+    }
 
-        if (portPtr != NULL)
-        {
-            if (portPtr->glort == glort)
-            {
-                /* portNumber could point to different port than entry
-                 * For LAG member port, it points to remote or physical
-                 */
-                *logicalPort = portPtr->portNumber;
-                 FM_LOG_EXIT(FM_LOG_CAT_PORT, FM_OK);
-            }
-        }
+    port = lportInfo->glortToPort[glort];
+    if (port < 0)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PORT, FM_ERR_INVALID_PORT);
+    }
+
+    portPtr = switchPtr->portTable[port];
+    if ( (portPtr == NULL) || (portPtr->glort != glort) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PORT, FM_ERR_INVALID_PORT);
     }
 
-    err = FM_ERR_INVALID_PORT;
+    /* portNumber could point to different port than entry
+     * For LAG member port, it points to remote or physical
+     */
+    *logicalPort = portPtr->portNumber;
 
-    FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
+    FM_LOG_EXIT(FM_LOG_CAT_PORT, FM_OK);
 
 }   /* end fmGetGlortLogicalPort */
 
 
 
 
+/*****************************************************************************/
+/** fmAddGlortLogicalPort
+ * \ingroup intPort
+ *
+ * \desc            Records a logical port in the glort to logical port
+ *                  index. Must be called after the port's fm_port structure
+ *                  has been stored in portTable[] with its glort set.
+ *
+ * \note            When several logical ports share a glort, the index
+ *                  keeps the lowest port number, which is the port a scan
+ *                  of portTable[] would have found first.
+ *
+ * \param[in]       switchPtr points to the switch state structure.
+ *
+ * \param[in]       port is the logical port number.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmAddGlortLogicalPort(fm_switch *switchPtr, fm_int port)
+{
+    fm_logicalPortInfo * lportInfo;
+    fm_port *            portPtr;
+    fm_port *            curPtr;
+    fm_int               curPort;
+
+    lportInfo = &switchPtr->logicalPortInfo;
+    portPtr   = switchPtr->portTable[port];
+
+    if ( (lportInfo->glortToPort == NULL) ||
+         (portPtr == NULL) ||
+         (portPtr->glort > FM_MAX_GLORT) )
+    {
+        return;
+    }
+
+    curPort = lportInfo->glortToPort[portPtr->glort];
+    curPtr  = (curPort >= 0) ? switchPtr->portTable[curPort] : NULL;
+
+    /* Replace stale entries as well as higher-numbered owners. */
+    if ( (curPtr == NULL) ||
+         (curPtr->glort != portPtr->glort) ||
+         (port < curPort) )
+    {
+        lportInfo->glortToPort[portPtr->glort] = port;
+    }
+
+}   /* end fmAddGlortLogicalPort */
+
+
+
+
+/*****************************************************************************/
+/** fmRemoveGlortLogicalPort
+ * \ingroup intPort
+ *
+ * \desc            Removes a logical port from the glort to logical port
+ *                  index. Must be called while the port's fm_port structure
+ *                  is still present in portTable[]. If another logical port
+ *                  uses the same glort, it becomes the index entry.
+ *
+ * \param[in]       switchPtr points to the switch state structure.
+ *
+ * \param[in]       port is the logical port number.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmRemoveGlortLogicalPort(fm_switch *switchPtr, fm_int port)
+{
+    fm_logicalPortInfo * lportInfo;
+    fm_port *            portPtr;
+    fm_port *            otherPtr;
+    fm_uint32            glort;
+    fm_int               other;
+
+    lportInfo = &switchPtr->logicalPortInfo;
+    portPtr   = switchPtr->portTable[port];
+
+    /* The port is going away; any TX destination naming it is stale. */
+    (void) FM_ATOMIC_ADD(&switchPtr->txDestGeneration, 1);
+
+    if ( (lportInfo->glortToPort == NULL) ||
+         (portPtr == NULL) ||
+         (portPtr->glort > FM_MAX_GLORT) )
+    {
+        return;
+    }
+
+    glort = portPtr->glort;
+
+    if (lportInfo->glortToPort[glort] != port)
+    {
+        return;
+    }
+
+    /* Shared glorts are rare, so a scan on removal is acceptable. */
+    lportInfo->glortToPort[glort] = -1;
+
+    for (other = 0 ; other < switchPtr->maxPort ; other++)
+    {
+        otherPtr = switchPtr->portTable[other];
+
+        if ( (other != port) && (otherPtr != NULL) &&
+             (otherPtr->glort == glort) )
+        {
+            lportInfo->glortToPort[glort] = other;
+            break;
+        }
+    }
+
+}   /* end fmRemoveGlortLogicalPort */
+
+
+
+
 /*****************************************************************************/
 /** fmGetLogicalPortRange
  * \ingroup intPort
@@ -5031,7 +5272,7 @@ fm_mcgAllocEntry * fmFindMcgEntryByHandle(fm_int sw, fm_int handle)
 /** fmFindUnusedCamEntry
  * \ingroup intPort
  *
- * \desc            Finds an unused cam entry in the table.
+ * \desc            Finds the lowest unused cam entry in the table.
  *
  * \param[in]       sw is the switch number.
  *
@@ -5048,17 +5289,23 @@ fm_int fmFindUnusedCamEntry(fm_int sw)
     lportInfo = &switchPtr->logicalPortInfo;
 
     /***************************************************
-     * Find an unused CAM entry.
+     * Find an unused CAM entry. The entries below the
+     * hint are all in use, so the search starts there.
      **************************************************/
 
-    for (camIndex = 0 ; camIndex < lportInfo->numCamEntries ; ++camIndex)
+    for (camIndex = lportInfo->camFreeHint ;
+         camIndex < lportInfo->numCamEntries ;
+         ++camIndex)
     {
         if (lportInfo->camEntries[camIndex].useCount == 0)
         {
+            lportInfo->camFreeHint = camIndex;
             return camIndex;
         }
     }
 
+    lportInfo->camFreeHint = lportInfo->numCamEntries;
+
     return -1;
 
 }   /* end fmFindUnusedCamEntry */
@@ -5066,6 +5313,40 @@ fm_int fmFindUnusedCamEntry(fm_int sw)
 
 
 
+/*****************************************************************************/
+/** fmMarkCamEntryUnused
+ * \ingroup intPort
+ *
+ * \desc            Marks a cam entry as unused, so that
+ *                  ''fmFindUnusedCamEntry'' can return it again. The
+ *                  caller is responsible for invalidating the entry in
+ *                  hardware.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       camIndex is the index of the CAM entry.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmMarkCamEntryUnused(fm_int sw, fm_int camIndex)
+{
+    fm_logicalPortInfo *lportInfo;
+
+    lportInfo = &GET_SWITCH_PTR(sw)->logicalPortInfo;
+
+    lportInfo->camEntries[camIndex].useCount = 0;
+
+    if (camIndex < lportInfo->camFreeHint)
+    {
+        lportInfo->camFreeHint = camIndex;
+    }
+
+}   /* end fmMarkCamEntryUnused */
+
+
+
+
 /*****************************************************************************/
 /** fmFindUnusedDestEntries
  * \ingroup intPort
@@ -5170,42 +5451,75 @@ fm_int fmFindUnusedLogicalPorts(fm_int sw, fm_int numPorts)
     fm_switch *         switchPtr;
     fm_logicalPortInfo *lportInfo;
     fm_int              port;
-    fm_int              freeCount = 0;
+    fm_int              cpuPort;
+    fm_bool             cpuTaken;
     fm_int              start = -1;
 
     switchPtr = GET_SWITCH_PTR(sw);
     lportInfo = &switchPtr->logicalPortInfo;
+    cpuPort   = switchPtr->cpuPort;
 
     /***************************************************
-     * Find an unused logical port entry.
+     * A non-zero CPU port always counts as free, so
+     * hide any reservation on it from the index for
+     * the duration of the search.
      **************************************************/
 
-    for (port = 0 ; port < switchPtr->maxPort ; ++port)
+    cpuTaken = ( (cpuPort > 0) &&
+                 (cpuPort < switchPtr->maxPort) &&
+                 FM_IS_LPORT_TAKEN(lportInfo, cpuPort) );
+
+    if (cpuTaken)
     {
-        /* Port is free if not being used and not reserved. */
-        if ( ( !switchPtr->portTable[port] &&
-               !FM_IS_LPORT_TAKEN(lportInfo, port) )
-             || ( (port != 0) && (switchPtr->cpuPort == port) ) )
-        {
-            if (freeCount == 0)
-            {
-                start = port;
-            }
+        fmSetBitArrayBit(&lportInfo->lportIndex, cpuPort, FALSE);
+    }
 
-            ++freeCount;
+    /***************************************************
+     * The index skips reserved ports a word at a time.
+     * Each candidate block must then also be absent from
+     * the port table; if not, search again past the
+     * first port that is.
+     **************************************************/
+
+    port = 0;
+
+    while (port < switchPtr->maxPort)
+    {
+        if ( (fmFindBitRunInBitArray(&lportInfo->lportIndex,
+                                     port,
+                                     numPorts,
+                                     &start) != FM_OK) ||
+             (start < 0) ||
+             (start + numPorts > switchPtr->maxPort) )
+        {
+            start = -1;
+            break;
+        }
 
-            if (freeCount >= numPorts)
+        for (port = start ; port < start + numPorts ; ++port)
+        {
+            if ( switchPtr->portTable[port] &&
+                 ( (port == 0) || (port != cpuPort) ) )
             {
-                return start;
+                break;
             }
         }
-        else
+
+        if (port == start + numPorts)
         {
-            freeCount = 0;
+            break;
         }
+
+        ++port;
+        start = -1;
     }
 
-    return -1;
+    if (cpuTaken)
+    {
+        fmSetBitArrayBit(&lportInfo->lportIndex, cpuPort, TRUE);
+    }
+
+    return start;
 
 }   /* end fmFindUnusedLogicalPorts */
 
@@ -5783,7 +6097,7 @@ fm_status fmRemoveGlortCamEntry(fm_int sw, fm_uint32 camIndex)
 
     if (camEntry->useCount <= 0)
     {
-        camEntry->useCount = 0;
+        fmMarkCamEntryUnused(sw, camIndex);
 
         /* Only need to zero out the CAM entry, not the RAM. */
         camEntry->camKey = 0;
@@ -5820,11 +6134,21 @@ void fmResetLogicalPortInfo(fm_logicalPortInfo* lportInfo)
     fm_glortDestEntry *destEntries;
     fm_int             numCamEntries;
     fm_int             numDestEntries;
+    fm_bitArray        glortIndex[FM_GLORT_INDEX_MAX];
+    fm_bitArray        lportIndex;
+    fm_int *           glortToPort;
 
     camEntries           = lportInfo->camEntries;
     destEntries          = lportInfo->destEntries;
     numCamEntries        = lportInfo->numCamEntries;
     numDestEntries       = lportInfo->numDestEntries;
+    lportIndex           = lportInfo->lportIndex;
+    glortToPort          = lportInfo->glortToPort;
+
+    FM_MEMCPY_S(glortIndex,
+                sizeof(glortIndex),
+                lportInfo->glortIndex,
+                sizeof(lportInfo->glortIndex));
 
     memset(lportInfo, 0, sizeof(*lportInfo));
 
@@ -5842,11 +6166,51 @@ void fmResetLogicalPortInfo(fm_logicalPortInfo* lportInfo)
         lportInfo->numDestEntries = numDestEntries;
     }
 
+    FM_MEMCPY_S(lportInfo->glortIndex,
+                sizeof(lportInfo->glortIndex),
+                glortIndex,
+                sizeof(glortIndex));
+    lportInfo->lportIndex  = lportIndex;
+    lportInfo->glortToPort = glortToPort;
+
+    ResetLogicalPortIndexes(lportInfo);
+
 }   /* end fmResetLogicalPortInfo */
 
 
 
 
+/*****************************************************************************/
+/** fmSetLogicalPortState
+ * \ingroup intPort
+ *
+ * \desc            Sets the state of a logical port and updates the
+ *                  logical port free-range index to match. Use the
+ *                  FM_*_LPORT_* macros rather than calling this directly.
+ *
+ * \param[in,out]   lportInfo points to the logical port information
+ *                  structure.
+ *
+ * \param[in]       port is the logical port whose state is set.
+ *
+ * \param[in]       state is the new state (see FM_LPORT_STATE_*).
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmSetLogicalPortState(fm_logicalPortInfo *lportInfo,
+                           fm_int              port,
+                           fm_int              state)
+{
+    lportInfo->lportState[port] = (fm_byte) state;
+
+    fmSetBitArrayBit(&lportInfo->lportIndex, port, (state != 0));
+
+}   /* end fmSetLogicalPortState */
+
+
+
+
 /*****************************************************************************/
 /** fmFreeMcastLogicalPort
  * \ingroup intPort
@@ -267,6 +267,61 @@ static fm_status GetMaxSupportedTxTimestampMode(fm_int                   sw,
 
 
 
+/*****************************************************************************/
+/** CommitMacFilterAcl
+ * \ingroup intMailbox
+ *
+ * \desc            Compiles and applies the inner/outer MAC filtering ACL
+ *                  after one of its rules changed. While a mailbox request
+ *                  batch is in progress, the commit is deferred to
+ *                  ''fmMailboxEndBatch''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       acl is the ACL to commit.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status CommitMacFilterAcl(fm_int sw, fm_int acl)
+{
+    fm_mailboxInfo *info;
+    fm_status       status;
+    fm_char         statusText[1024];
+
+    info = GET_MAILBOX_INFO(sw);
+
+    if (info->batchActive)
+    {
+        info->batchAclCommitPending = TRUE;
+        return FM_OK;
+    }
+
+    status = fmCompileACLExt(sw,
+                             statusText,
+                             sizeof(statusText),
+                             FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE |
+                             FM_ACL_COMPILE_FLAG_INTERNAL,
+                             (void *) &acl);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
+
+    FM_LOG_DEBUG(FM_LOG_CAT_MAILBOX,
+                 "ACL compiled, status=%d, statusText=%s\n",
+                 status,
+                 statusText);
+
+    status = fmApplyACLExt(sw,
+                           FM_ACL_APPLY_FLAG_NON_DISRUPTIVE |
+                           FM_ACL_APPLY_FLAG_INTERNAL,
+                           (void *) &acl);
+
+    return status;
+
+}   /* end CommitMacFilterAcl */
+
+
+
+
 /*****************************************************************************/
 /** AddMacFilterAclRule
  * \ingroup intMailbox
@@ -302,7 +357,6 @@ static fm_status AddMacFilterAclRule(fm_int               sw,
     fm_int                 aclRule;
     fm_int                 bitNum;
     fm_uint32              allScenarios;
-    fm_char                statusText[1024];
 
     FM_LOG_ENTRY(FM_LOG_CAT_MAILBOX,
                  "sw = %d, macFilter = %p\n",
@@ -321,9 +375,9 @@ static fm_status AddMacFilterAclRule(fm_int               sw,
                                    &logicalPort);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-    status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                        logicalPort,
-                        (void **) &mlbxResUsed);
+    status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                           logicalPort,
+                           (void **) &mlbxResUsed);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
     /* Check if we don't exceed MAC filtering entries limits. */
@@ -556,9 +610,9 @@ static fm_status AddMacFilterAclRule(fm_int               sw,
         macVniKey.macAddr = macFilter->innerMacAddr;
         macVniKey.vni     = macFilter->vni;
 
-        status = fmCustomTreeFind(&info->mcastMacVni,
-                                  &macVniKey,
-                                  (void **) &macVniVal);
+        status = fmCustomHashMapFind(&info->mcastMacVni,
+                                     &macVniKey,
+                                     (void **) &macVniVal);
 
         /* Use existing mcast group */
         if (status == FM_OK)
@@ -582,7 +636,8 @@ static fm_status AddMacFilterAclRule(fm_int               sw,
         /* New entry */
         else if (status == FM_ERR_NOT_FOUND)
         {
-            macVniVal = fmAlloc( sizeof(fm_mailboxMcastMacVni) );
+            macVniVal = fmAllocTagged( sizeof(fm_mailboxMcastMacVni),
+                                       FM_LOG_CAT_MAILBOX );
 
             if (macVniVal == NULL)
             {
@@ -619,9 +674,9 @@ static fm_status AddMacFilterAclRule(fm_int               sw,
             macVniVal->macAddr = macFilter->innerMacAddr;
             macVniVal->vni     = macFilter->vni;
 
-            status = fmCustomTreeInsert(&info->mcastMacVni,
-                                        macVniVal,
-                                        (void *) macVniVal);
+            status = fmCustomHashMapInsert(&info->mcastMacVni,
+                                           macVniVal,
+                                           (void *) macVniVal);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
         }
         /* Unhandled error */
@@ -671,23 +726,7 @@ static fm_status AddMacFilterAclRule(fm_int               sw,
                              &aclActionData);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-    status = fmCompileACLExt(sw,
-                             statusText,
-                             sizeof(statusText),
-                             FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE |
-                             FM_ACL_COMPILE_FLAG_INTERNAL,
-                             (void*) &info->aclIdForMacFiltering);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
-
-    FM_LOG_DEBUG(FM_LOG_CAT_MAILBOX,
-                 "ACL compiled, status=%d, statusText=%s\n",
-                 status,
-                 statusText);
-
-    status = fmApplyACLExt(sw,
-                           FM_ACL_APPLY_FLAG_NON_DISRUPTIVE |
-                           FM_ACL_APPLY_FLAG_INTERNAL,
-                           (void*) &info->aclIdForMacFiltering);
+    status = CommitMacFilterAcl(sw, info->aclIdForMacFiltering);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status); 
 
     status = fmSetBitArrayBit(&info->innOutMacRuleInUse,
@@ -777,7 +816,6 @@ static fm_status DeleteMacFilterAclRule(fm_int               sw,
     fm_int                 logicalPort;
     fm_int                 aclRule;
     fm_int                 bitNum;
-    fm_char                statusText[1024];
     fm_aclCondition        cond;
     fm_aclValue            value;
     fm_aclActionExt        action;
@@ -796,9 +834,9 @@ static fm_status DeleteMacFilterAclRule(fm_int               sw,
                                    &logicalPort);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-    status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                        logicalPort,
-                        (void **) &mlbxResUsed);
+    status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                           logicalPort,
+                           (void **) &mlbxResUsed);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
     status = fmCustomTreeFind(&mlbxResUsed->innOutMacResource,
@@ -831,23 +869,7 @@ static fm_status DeleteMacFilterAclRule(fm_int               sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
     }
 
-    status = fmCompileACLExt(sw,
-                             statusText,
-                             sizeof(statusText),
-                             FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE |
-                             FM_ACL_COMPILE_FLAG_INTERNAL,
-                             (void *) &macFilterUsed->acl);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
-
-    FM_LOG_DEBUG(FM_LOG_CAT_MAILBOX,
-                 "ACL compiled, status=%d, statusText=%s\n",
-                 status,
-                 statusText);
-
-    status = fmApplyACLExt(sw,
-                           FM_ACL_APPLY_FLAG_NON_DISRUPTIVE |
-                           FM_ACL_APPLY_FLAG_INTERNAL,
-                           (void*) &macFilterUsed->acl);
+    status = CommitMacFilterAcl(sw, macFilterUsed->acl);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
     /* The rule id scheme is:
@@ -870,9 +892,9 @@ static fm_status DeleteMacFilterAclRule(fm_int               sw,
         macVniKey.macAddr = macFilter->innerMacAddr;
         macVniKey.vni     = macFilter->vni;
 
-        status = fmCustomTreeFind(&info->mcastMacVni,
-                                  &macVniKey,
-                                  (void **) &macVniVal);
+        status = fmCustomHashMapFind(&info->mcastMacVni,
+                                     &macVniKey,
+                                     (void **) &macVniVal);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
         FM_CLEAR(mcastListener);
@@ -900,9 +922,9 @@ static fm_status DeleteMacFilterAclRule(fm_int               sw,
                                         macVniVal->mcastGroup);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-            status = fmCustomTreeRemoveCertain(&info->mcastMacVni,
-                                               &macVniKey,
-                                               fmFreeMcastMacVni);
+            status = fmCustomHashMapRemove(&info->mcastMacVni,
+                                           &macVniKey,
+                                           fmFreeMcastMacVni);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
         }
         else if (status != FM_OK)
@@ -1323,9 +1345,9 @@ static fm_status CreateUserFlowTable(fm_int                 sw,
                                   &logicalPort);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-    status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                        logicalPort,
-                        (void **) &mailboxResourcesUsed);
+    status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                           logicalPort,
+                           (void **) &mailboxResourcesUsed);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
     /* Check if match table index is not in use. */
@@ -1431,7 +1453,8 @@ static fm_status CreateUserFlowTable(fm_int                 sw,
     DROP_FLOW_LOCK(sw);
     flowLockTaken = FALSE;
 
-    mailboxFlowTable = fmAlloc(sizeof(fm_mailboxFlowTable));
+    mailboxFlowTable = fmAllocTagged(sizeof(fm_mailboxFlowTable),
+                                     FM_LOG_CAT_MAILBOX);
     if (mailboxFlowTable == NULL)
     {
         status = FM_ERR_NO_MEM;
@@ -1554,9 +1577,9 @@ static fm_status CreateDriverFlowTable(fm_int                 sw,
             continue;
         }
 
-        status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                            logicalPort,
-                            (void **) &mailboxResourcesUsed);
+        status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                               logicalPort,
+                               (void **) &mailboxResourcesUsed);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
         /* Check if match table index is not in use. */
@@ -1662,7 +1685,8 @@ static fm_status CreateDriverFlowTable(fm_int                 sw,
         DROP_FLOW_LOCK(sw);
         flowLockTaken = FALSE;
 
-        mailboxFlowTable = fmAlloc(sizeof(fm_mailboxFlowTable));
+        mailboxFlowTable = fmAllocTagged(sizeof(fm_mailboxFlowTable),
+                                         FM_LOG_CAT_MAILBOX);
         if (mailboxFlowTable == NULL)
         {
             status = FM_ERR_NO_MEM;
@@ -1758,9 +1782,9 @@ static fm_status DestroyFlowTable(fm_int          sw,
                                   &logicalPort);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-    status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                        logicalPort,
-                        (void **) &resourcesUsed);
+    status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                           logicalPort,
+                           (void **) &resourcesUsed);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
     /* Check if match index is valid. */
@@ -1833,9 +1857,9 @@ static fm_status DestroyFlowTable(fm_int          sw,
 
         if (type == FM_PCIE_PORT_VF)
         {
-            status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                                logicalPort,
-                                (void **) &mailboxVfResources);
+            status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                                   logicalPort,
+                                   (void **) &mailboxVfResources);
             FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
             key = GET_FLOW_TABLE_KEY(flowId, mailboxFlowTable->tableIndex);
@@ -1930,9 +1954,9 @@ static fm_status SetRule(fm_int               sw,
 
     if (type == FM_PCIE_PORT_VF)
     {
-        status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                            logicalPort,
-                            (void **) &mailboxVfResourcesUsed);
+        status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                               logicalPort,
+                               (void **) &mailboxVfResourcesUsed);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
         /* Check flow counters for VF. */
@@ -1962,9 +1986,9 @@ static fm_status SetRule(fm_int               sw,
                                   &logicalPort);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-    status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                        logicalPort,
-                        (void **) &mailboxPfResourcesUsed);
+    status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                           logicalPort,
+                           (void **) &mailboxPfResourcesUsed);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
     /* Check if match table index is valid. */
@@ -2011,7 +2035,7 @@ static fm_status SetRule(fm_int               sw,
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
     /* Add mapping between match and internal flow IDs in both trees. */
-    flowGlortKey = fmAlloc(sizeof(fm_uint64));
+    flowGlortKey = fmAllocTagged(sizeof(fm_uint64), FM_LOG_CAT_MAILBOX);
     if (flowGlortKey == NULL)
     {
         status = FM_ERR_NO_MEM;
@@ -2121,9 +2145,9 @@ static fm_status DelRule(fm_int                sw,
                                   &logicalPort);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-    status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                        logicalPort,
-                        (void **) &mailboxPfResourcesUsed);
+    status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                           logicalPort,
+                           (void **) &mailboxPfResourcesUsed);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
     /* Check if match table index is valid. */
@@ -2179,9 +2203,9 @@ static fm_status DelRule(fm_int                sw,
     if (type == FM_PCIE_PORT_VF)
     {
         /* Update flow tree for given VF. */
-        status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                            logicalPort,
-                            (void **) &mailboxVfResourcesUsed);
+        status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                               logicalPort,
+                               (void **) &mailboxVfResourcesUsed);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
         treeValue = GET_FLOW_TABLE_KEY(flowId, mailboxFlowTable->tableIndex);
@@ -2270,9 +2294,9 @@ static fm_status HandleNoOfVfs(fm_int             sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
     }
 
-    status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                        logicalPort,
-                        (void **) &mailboxPfResourcesUsed);
+    status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                           logicalPort,
+                           (void **) &mailboxPfResourcesUsed);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
     mailboxPfResourcesUsed->noOfVfs = noOfVfs->noOfVfs;
@@ -2396,9 +2420,9 @@ static fm_status CreateVfFlowTable(fm_int sw,
                                   &logicalPort);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-    status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                        logicalPort,
-                        (void **) &mailboxResourcesUsed);
+    status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                           logicalPort,
+                           (void **) &mailboxResourcesUsed);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
     fmTreeIterInit(&treeIter, &mailboxResourcesUsed->mailboxFlowTableResource);
@@ -2506,7 +2530,8 @@ static fm_status CreateVfFlowTable(fm_int sw,
     DROP_FLOW_LOCK(sw);
     flowLockTaken = FALSE;
 
-    mailboxFlowTable = fmAlloc(sizeof(fm_mailboxFlowTable));
+    mailboxFlowTable = fmAllocTagged(sizeof(fm_mailboxFlowTable),
+                                     FM_LOG_CAT_MAILBOX);
     if (mailboxFlowTable == NULL)
     {
         status = FM_ERR_NO_MEM;
@@ -2530,9 +2555,9 @@ static fm_status CreateVfFlowTable(fm_int sw,
                                   &logicalPort);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-    status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                        logicalPort,
-                        (void **) &mailboxResourcesUsed);
+    status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                           logicalPort,
+                           (void **) &mailboxResourcesUsed);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
     /* Add mapping between match and internal table indexes. */
@@ -2558,6 +2583,99 @@ ABORT:
 }   /* end CreateVfFlowTable */
 
 
+
+
+/*****************************************************************************/
+/** MailboxWorkerTask
+ * \ingroup intMailbox
+ *
+ * \desc            Mailbox worker thread. Services the mailboxes of the
+ *                  PEPs queued to it by ''fmMailboxQueuePeps''.
+ *
+ * \param[in]       args contains a pointer to the thread information.
+ *
+ * \return          NULL.
+ *
+ *****************************************************************************/
+static void *MailboxWorkerTask(void *args)
+{
+    fm_thread *       thread;
+    fm_mailboxWorker *worker;
+    fm_switch *       switchPtr;
+    fm_status         err;
+    fm_uint32         pepMask[FM_MAX_NUM_SWITCHES];
+    fm_int            sw;
+
+    thread = FM_GET_THREAD_HANDLE(args);
+    worker = FM_GET_THREAD_PARAM(fm_mailboxWorker, args);
+
+    while (TRUE)
+    {
+        err = fmWaitSemaphore(&worker->wake, FM_WAIT_FOREVER);
+
+        if (err != FM_OK)
+        {
+            FM_LOG_FATAL(FM_LOG_CAT_MAILBOX, "%s\n", fmErrorMsg(err));
+            continue;
+        }
+
+        fmCaptureLock(&worker->lock, FM_WAIT_FOREVER);
+
+        FM_MEMCPY_S(pepMask,
+                    sizeof(pepMask),
+                    worker->pendingPepMask,
+                    sizeof(worker->pendingPepMask));
+        FM_CLEAR(worker->pendingPepMask);
+
+        fmReleaseLock(&worker->lock);
+
+        for (sw = 0 ; sw < FM_MAX_NUM_SWITCHES ; sw++)
+        {
+            if ( (pepMask[sw] == 0) || !SWITCH_LOCK_EXISTS(sw) )
+            {
+                continue;
+            }
+
+            PROTECT_SWITCH(sw);
+
+            switchPtr = fmRootApi->fmSwitchStateTable[sw];
+
+            /* The interrupts of a switch going down are dropped */
+            if ( (switchPtr != NULL) && FM_IS_STATE_ALIVE(switchPtr->state) )
+            {
+                FM_API_CALL_FAMILY(err,
+                                   switchPtr->MailboxServicePeps,
+                                   sw,
+                                   pepMask[sw]);
+
+                if (err != FM_OK)
+                {
+                    FM_LOG_DEBUG(FM_LOG_CAT_MAILBOX,
+                                 "Unable to service mailboxes 0x%x of "
+                                 "switch %d: %s\n",
+                                 pepMask[sw],
+                                 sw,
+                                 fmErrorMsg(err));
+                }
+            }
+
+            UNPROTECT_SWITCH(sw);
+        }
+    }
+
+    /**************************************************
+     * Should never exit.
+     **************************************************/
+
+    FM_LOG_FATAL(FM_LOG_CAT_MAILBOX, "Task exiting inadvertently!\n");
+
+    fmExitThread(thread);
+
+    return NULL;
+
+}   /* end MailboxWorkerTask */
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -2768,7 +2886,7 @@ fm_int fmCompareMcastMacVniKeys(const void *key1, const void *key2)
     {
         return -1;
     }
-    else if (macVniKey1->macAddr < macVniKey2->macAddr)
+    else if (macVniKey1->macAddr > macVniKey2->macAddr)
     {
         return 1;
     }
@@ -2777,7 +2895,7 @@ fm_int fmCompareMcastMacVniKeys(const void *key1, const void *key2)
     {
         return -1;
     }
-    else if (macVniKey1->vni < macVniKey2->vni)
+    else if (macVniKey1->vni > macVniKey2->vni)
     {
         return 1;
     }
@@ -2789,6 +2907,37 @@ fm_int fmCompareMcastMacVniKeys(const void *key1, const void *key2)
 
 
 
+/*****************************************************************************/
+/** fmHashMcastMacVniKey
+ * \ingroup intMailbox
+ *
+ * \desc            Hashes a fm_mailboxMcastMacVni structure, for the map
+ *                  of multicast MAC address and VNI pairs.
+ *
+ * \param[in]       key points to the key.
+ *
+ * \return          hash of the MAC address and VNI of the key.
+ *
+ *****************************************************************************/
+fm_uint32 fmHashMcastMacVniKey(const void *key)
+{
+    const fm_mailboxMcastMacVni *macVniKey;
+    fm_uint64                    hash;
+
+    macVniKey = (const fm_mailboxMcastMacVni *) key;
+
+    hash  = macVniKey->macAddr ^ ( (fm_uint64) macVniKey->vni << 48 );
+    hash ^= hash >> 29;
+    hash *= FM_LITERAL_U64(0xbf58476d1ce4e5b9);
+    hash ^= hash >> 32;
+
+    return (fm_uint32) hash;
+
+}   /* end fmHashMcastMacVniKey */
+
+
+
+
 /*****************************************************************************/
 /** fmSendHostSrvErrResponse
  * \ingroup intMailbox
@@ -2925,23 +3074,23 @@ fm_status fmNotifyPvidUpdate(fm_int sw,
     info = GET_MAILBOX_INFO(sw);
 
     /* Cache the PVID value */
-    if (fmTreeIsInitialized(&info->defaultPvidPerGlort))
+    if (fmHashMapIsInitialized(&info->defaultPvidPerGlort))
     {
-        status = fmTreeFind(&info->defaultPvidPerGlort,
-                            glort,
-                            (void **) &cachedPvid);
+        status = fmHashMapFind(&info->defaultPvidPerGlort,
+                               glort,
+                               (void **) &cachedPvid);
 
         if ( (status == FM_OK) && ( ( (fm_int) cachedPvid ) != pvid) )
         {
-            fmTreeRemoveCertain(&info->defaultPvidPerGlort,
-                                glort,
-                                NULL);
+            fmHashMapRemove(&info->defaultPvidPerGlort,
+                            glort,
+                            NULL);
 
             cachedPvid = pvid;
 
-            status = fmTreeInsert(&info->defaultPvidPerGlort,
-                                  glort,
-                                  (void *) cachedPvid);
+            status = fmHashMapInsert(&info->defaultPvidPerGlort,
+                                     glort,
+                                     (void *) cachedPvid);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
         }
         else if (status != FM_OK)
@@ -2953,9 +3102,9 @@ fm_status fmNotifyPvidUpdate(fm_int sw,
 
             cachedPvid = pvid;
 
-            status = fmTreeInsert(&info->defaultPvidPerGlort,
-                                  glort,
-                                  (void *) cachedPvid);
+            status = fmHashMapInsert(&info->defaultPvidPerGlort,
+                                     glort,
+                                     (void *) cachedPvid);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
         }
     }
@@ -3096,9 +3245,9 @@ fm_status fmMapLportProcess(fm_int                   sw,
     {
         /* Try to remove PVID value, it it's not present,
            just  go on with next values. */
-        status = fmTreeRemove(&info->defaultPvidPerGlort,
-                              i,
-                              NULL);
+        status = fmHashMapRemove(&info->defaultPvidPerGlort,
+                                 i,
+                                 NULL);
 
         if (status == FM_OK)
         {
@@ -3323,14 +3472,15 @@ fm_status fmCreateLportProcess(fm_int                   sw,
                                 (void *) &pvid);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-    if (fmTreeIsInitialized(&info->mailboxResourcesPerVirtualPort))
+    if (fmHashMapIsInitialized(&info->mailboxResourcesPerVirtualPort))
     {
         portsProcessed = TRUE;
 
         /* create instances to track resources created on host interface request. */
         for (i = firstPort ; i < (firstPort + srvPort.glortCount) ; i++)
         {
-            mailboxResource = fmAlloc(sizeof(fm_mailboxResources));
+            mailboxResource = fmAllocTagged(sizeof(fm_mailboxResources),
+                                            FM_LOG_CAT_MAILBOX);
 
             if (mailboxResource == NULL)
             {
@@ -3348,17 +3498,17 @@ fm_status fmCreateLportProcess(fm_int                   sw,
             mailboxResource->innerOuterMacEntriesAdded = 0;
             mailboxResource->flowEntriesAdded          = 0;
 
-            status = fmTreeInsert(&info->mailboxResourcesPerVirtualPort,
-                                  i,
-                                  (void *) mailboxResource);
+            status = fmHashMapInsert(&info->mailboxResourcesPerVirtualPort,
+                                     i,
+                                     (void *) mailboxResource);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
             status = fmGetLogicalPortGlort(sw, i, &glort);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-            status = fmTreeFind(&info->defaultPvidPerGlort,
-                                glort,
-                                (void **) &cachedPvid);
+            status = fmHashMapFind(&info->defaultPvidPerGlort,
+                                   glort,
+                                   (void **) &cachedPvid);
 
             if (status == FM_OK)
             {
@@ -3378,9 +3528,9 @@ fm_status fmCreateLportProcess(fm_int                   sw,
             {
                 cachedPvid = pvid;
 
-                status = fmTreeInsert(&info->defaultPvidPerGlort,
-                                      glort,
-                                      (void *) cachedPvid);
+                status = fmHashMapInsert(&info->defaultPvidPerGlort,
+                                         glort,
+                                         (void *) cachedPvid);
                 FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
             }
             else
@@ -3439,9 +3589,9 @@ fm_status fmCreateLportProcess(fm_int                   sw,
                                    &glort);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
 
-    status = fmTreeFind(&info->defaultPvidPerGlort,
-                        glort,
-                        (void **) &cachedPvid);
+    status = fmHashMapFind(&info->defaultPvidPerGlort,
+                           glort,
+                           (void **) &cachedPvid);
 
     if (status == FM_OK)
     {
@@ -3481,18 +3631,18 @@ ABORT:
     }
     else
     {
-        if ( fmTreeIsInitialized(&info->mailboxResourcesPerVirtualPort) &&
+        if ( fmHashMapIsInitialized(&info->mailboxResourcesPerVirtualPort) &&
              (portsProcessed == TRUE) )
         {
             for (i = firstPort ; i < (firstPort + srvPort.glortCount) ; i++)
             {
-                if (fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                               i,
-                               (void **) &mailboxResource) == FM_OK)
+                if (fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                                  i,
+                                  (void **) &mailboxResource) == FM_OK)
                 {
-                    local_status = fmTreeRemove(&info->mailboxResourcesPerVirtualPort,
-                                                i,
-                                                fmFree);
+                    local_status = fmHashMapRemove(&info->mailboxResourcesPerVirtualPort,
+                                                   i,
+                                                   fmFree);
                     if (local_status != FM_OK)
                     {
                         FM_LOG_ERROR(FM_LOG_CAT_MAILBOX,
@@ -4422,11 +4572,11 @@ fm_status fmUpdateMacFwdRuleProcess(fm_int                   sw,
 
     info = GET_MAILBOX_INFO(sw);
 
-    if (fmTreeIsInitialized(&info->mailboxResourcesPerVirtualPort))
+    if (fmHashMapIsInitialized(&info->mailboxResourcesPerVirtualPort))
     {
-        status = fmTreeFind(&info->mailboxResourcesPerVirtualPort,
-                            logicalPort,
-                            (void **) &mailboxResourcesUsed);
+        status = fmHashMapFind(&info->mailboxResourcesPerVirtualPort,
+                               logicalPort,
+                               (void **) &mailboxResourcesUsed);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MAILBOX, status);
     }
     else
@@ -5716,7 +5866,8 @@ fm_status fmFilterInnerOuterMacProcess(fm_int                   sw,
     {
         /* When adding new filtering rule, allocate new structure 
            as it will be stored in the tree. */
-        macFilterKey = fmAlloc( sizeof(fm_hostSrvInnOutMac) );
+        macFilterKey = fmAllocTagged( sizeof(fm_hostSrvInnOutMac),
+                                      FM_LOG_CAT_MAILBOX );
 
         if (macFilterKey == NULL)
         {
@@ -5862,7 +6013,8 @@ fm_status fmSetInnerOuterMacFilter(fm_int               sw,
     {
         /* When adding new filtering rule, allocate new structure 
            as it will be stored in the tree. */
-        macFilterKey = fmAlloc( sizeof(fm_hostSrvInnOutMac) );
+        macFilterKey = fmAllocTagged( sizeof(fm_hostSrvInnOutMac),
+                                      FM_LOG_CAT_MAILBOX );
 
         if (macFilterKey == NULL)
         {
@@ -6114,10 +6266,11 @@ fm_status fmMailboxInit(fm_int sw)
        or for aggregate switch. */
     if ( (GET_SWITCH_AGGREGATE_ID_IF_EXIST(sw)) == sw)
     {
-        fmTreeInit(&info->mailboxResourcesPerVirtualPort);
-        fmTreeInit(&info->defaultPvidPerGlort);
-        fmCustomTreeInit(&info->mcastMacVni,
-                         fmCompareMcastMacVniKeys);
+        fmHashMapInit(&info->mailboxResourcesPerVirtualPort);
+        fmHashMapInit(&info->defaultPvidPerGlort);
+        fmCustomHashMapInit(&info->mcastMacVni,
+                            fmHashMcastMacVniKey,
+                            fmCompareMcastMacVniKeys);
 
         info->aclIdForMacFiltering = FM_MAILBOX_MAC_FILTER_ACL;
 
@@ -6213,12 +6366,12 @@ fm_status fmMailboxFreeResources(fm_int sw)
        or for aggregate switch. */
     if ( (GET_SWITCH_AGGREGATE_ID_IF_EXIST(sw)) == sw)
     {
-        fmTreeDestroy(&info->mailboxResourcesPerVirtualPort,
-                      fmFreeMailboxResources);
-        fmTreeDestroy(&info->defaultPvidPerGlort,
-                      NULL);
-        fmCustomTreeDestroy(&info->mcastMacVni,
-                            fmFreeMcastMacVni);
+        fmHashMapDestroy(&info->mailboxResourcesPerVirtualPort,
+                         fmFreeMailboxResources);
+        fmHashMapDestroy(&info->defaultPvidPerGlort,
+                         NULL);
+        fmCustomHashMapDestroy(&info->mcastMacVni,
+                               fmFreeMcastMacVni);
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_MAILBOX, status);
@@ -6228,6 +6381,199 @@ fm_status fmMailboxFreeResources(fm_int sw)
 
 
 
+/*****************************************************************************/
+/** fmMailboxBeginBatch
+ * \ingroup intMailbox
+ *
+ * \desc            Starts a batch of mailbox requests. Until
+ *                  ''fmMailboxEndBatch'' is called, hardware updates that can
+ *                  be shared by several requests are only recorded.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmMailboxBeginBatch(fm_int sw)
+{
+    fm_mailboxInfo *info;
+
+    info = GET_MAILBOX_INFO(sw);
+
+    info->batchActive           = TRUE;
+    info->batchAclCommitPending = FALSE;
+
+    return FM_OK;
+
+}   /* end fmMailboxBeginBatch */
+
+
+
+
+/*****************************************************************************/
+/** fmMailboxEndBatch
+ * \ingroup intMailbox
+ *
+ * \desc            Ends a batch of mailbox requests, committing the hardware
+ *                  updates deferred during the batch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmMailboxEndBatch(fm_int sw)
+{
+    fm_mailboxInfo *info;
+    fm_status       status;
+
+    info   = GET_MAILBOX_INFO(sw);
+    status = FM_OK;
+
+    info->batchActive = FALSE;
+
+    if (info->batchAclCommitPending)
+    {
+        info->batchAclCommitPending = FALSE;
+
+        status = CommitMacFilterAcl(sw, info->aclIdForMacFiltering);
+    }
+
+    return status;
+
+}   /* end fmMailboxEndBatch */
+
+
+
+
+/*****************************************************************************/
+/** fmMailboxStartWorkers
+ * \ingroup intMailbox
+ *
+ * \desc            Starts the number of mailbox worker threads given by the
+ *                  api.mailbox.workerThreads property. Called once, when the
+ *                  API threads are created.
+ *
+ * \param           None.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmMailboxStartWorkers(void)
+{
+    fm_mailboxWorker *worker;
+    fm_status         err;
+    fm_int            numThreads;
+    fm_int            i;
+    fm_char           threadName[32];
+
+    FM_LOG_ENTRY(FM_LOG_CAT_MAILBOX, "(no arguments)\n");
+
+    numThreads = GET_PROPERTY()->mailboxWorkerThreads;
+
+    if (numThreads > FM_MAX_MAILBOX_WORKERS)
+    {
+        numThreads = FM_MAX_MAILBOX_WORKERS;
+    }
+
+    err = FM_OK;
+
+    for (i = 0 ; i < numThreads ; i++)
+    {
+        worker = &fmRootApi->mailboxWorkers[i];
+
+        err = fmCreateLock("MailboxWorkerLock", &worker->lock);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MAILBOX, err);
+
+        err = fmCreateSemaphore("MailboxWorkerWake",
+                                FM_SEM_BINARY,
+                                &worker->wake,
+                                0);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MAILBOX, err);
+
+        FM_SPRINTF_S(threadName, sizeof(threadName), "MailboxWorker%d", i);
+
+        err = fmCreateThread(threadName,
+                             FM_EVENT_QUEUE_SIZE_NONE,
+                             MailboxWorkerTask,
+                             worker,
+                             &fmRootApi->mailboxWorkerTasks[i]);
+        if (err != FM_OK)
+        {
+            /* Carry on with the threads we have */
+            FM_LOG_WARNING(FM_LOG_CAT_MAILBOX,
+                           "Unable to create mailbox worker thread %d: %s\n",
+                           i,
+                           fmErrorMsg(err));
+            err = FM_OK;
+            break;
+        }
+
+        fmRootApi->numMailboxWorkers++;
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_MAILBOX, err);
+
+}   /* end fmMailboxStartWorkers */
+
+
+
+
+/*****************************************************************************/
+/** fmMailboxQueuePeps
+ * \ingroup intMailbox
+ *
+ * \desc            Hands the mailbox interrupts of a set of PEPs over to the
+ *                  mailbox worker threads. A PEP is always queued to the
+ *                  same worker, so that its requests are processed in order.
+ *                                                                      \lb\lb
+ *                  The mailbox interrupts of the PEPs must be masked; the
+ *                  worker re-enables them once the mailbox is serviced.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       pepMask is the bitmask of the PEPs to service.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if no mailbox worker is running.
+ *
+ *****************************************************************************/
+fm_status fmMailboxQueuePeps(fm_int sw, fm_uint32 pepMask)
+{
+    fm_mailboxWorker *worker;
+    fm_int            numWorkers;
+    fm_int            pepNb;
+
+    numWorkers = fmRootApi->numMailboxWorkers;
+
+    if (numWorkers <= 0)
+    {
+        return FM_ERR_UNSUPPORTED;
+    }
+
+    for (pepNb = 0 ; pepMask != 0 ; pepNb++, pepMask >>= 1)
+    {
+        if ( (pepMask & 1) == 0 )
+        {
+            continue;
+        }
+
+        worker = &fmRootApi->mailboxWorkers[pepNb % numWorkers];
+
+        fmCaptureLock(&worker->lock, FM_WAIT_FOREVER);
+        worker->pendingPepMask[sw] |= (1U << pepNb);
+        fmReleaseLock(&worker->lock);
+
+        fmSignalSemaphore(&worker->wake);
+    }
+
+    return FM_OK;
+
+}   /* end fmMailboxQueuePeps */
+
+
+
+
 /*****************************************************************************/
 /** fmDeliverPacketTimestamp
  * \ingroup intMailbox
@@ -85,6 +85,11 @@ fm_status GetMirrorDirection(fm_mirrorType mirrorType,
                              fm_bool *     ingress,
                              fm_bool *     egress);
 
+static fm_status WriteMirrorGroupPorts(fm_int              sw,
+                                       fm_portMirrorGroup *grp,
+                                       fm_int              numPorts,
+                                       fm_int *            portList);
+
 /*****************************************************************************
  * Local Functions
  *****************************************************************************/
@@ -150,6 +155,53 @@ fm_status GetMirrorDirection(fm_mirrorType mirrorType,
 
 
 
+/*****************************************************************************/
+/** WriteMirrorGroupPorts
+ * \ingroup intMirror
+ *
+ * \desc            Writes the hardware after the membership of the listed
+ *                  ports changed in a mirror group. Only the listed ports
+ *                  are updated when the switch supports it, otherwise the
+ *                  whole group is rewritten.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       grp points to the mirror group structure.
+ *
+ * \param[in]       numPorts is the number of ports in portList.
+ *
+ * \param[in]       portList is the list of logical ports whose membership
+ *                  changed.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status WriteMirrorGroupPorts(fm_int              sw,
+                                       fm_portMirrorGroup *grp,
+                                       fm_int              numPorts,
+                                       fm_int *            portList)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->UpdateMirrorGroupPorts != NULL)
+    {
+        err = switchPtr->UpdateMirrorGroupPorts(sw, grp, numPorts, portList);
+    }
+    else
+    {
+        FM_API_CALL_FAMILY(err, switchPtr->WritePortMirrorGroup, sw, grp);
+    }
+
+    return err;
+
+}   /* end WriteMirrorGroupPorts */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -1452,13 +1504,11 @@ fm_status fmAddMirrorPortInternal(fm_int        sw,
     {
         err = switchPtr->AddMirrorPort(sw, grp, port, mirrorType);
     }
-    else
+    else if ( (oldPortIngress != portIngress) ||
+              (oldPortEgress != portEgress) )
     {
          /* write the entry to hardware */
-        FM_API_CALL_FAMILY(err,
-                           switchPtr->WritePortMirrorGroup,
-                           sw,
-                           grp);
+        err = WriteMirrorGroupPorts(sw, grp, 1, &port);
     }
 
     /* Restore original state on error */
@@ -1571,6 +1621,238 @@ fm_status fmAddMirrorPortExt(fm_int        sw,
 
 
 
+/*****************************************************************************/
+/** fmAddMirrorPortList
+ * \ingroup mirror
+ *
+ * \chips           FM10000
+ *
+ * \desc            Add a list of ports to a mirror group in a single
+ *                  hardware update. Each port is handled as by
+ *                  ''fmAddMirrorPortExt'' and ports whose membership does
+ *                  not change are not written. Either all the ports are
+ *                  added or the group is left unchanged.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       group is the mirror group number to which the ports
+ *                  should be added.
+ *
+ * \param[in]       numPorts is the number of ports in portList.
+ *
+ * \param[in]       portList points to the list of logical ports to add. The
+ *                  ports cannot be LAGs.
+ *
+ * \param[in]       mirrorType indicates whether the ports' ingress traffic,
+ *                  egress traffic or both are mirrored (see ''fm_mirrorType'').
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if numPorts or portList is
+ *                  invalid.
+ * \return          FM_ERR_INVALID_PORT_MIRROR_GROUP if group is out of range,
+ *                  does not exist or was not created with a ''fm_mirrorType''
+ *                  of ''FM_MIRROR_TYPE_BIDIRECTIONAL'' or that matches
+ *                  mirrorType.
+ * \return          FM_ERR_INVALID_PORT if one of the ports is invalid.
+ * \return          FM_ERR_NO_MEM if not enough memory is available.
+ *
+ *****************************************************************************/
+fm_status fmAddMirrorPortList(fm_int        sw,
+                              fm_int        group,
+                              fm_int        numPorts,
+                              fm_int *      portList,
+                              fm_mirrorType mirrorType)
+{
+    fm_portMirrorGroup *grp;
+    fm_status           err;
+    fm_switch *         switchPtr;
+    fm_port *           portPtr;
+    fm_bool             grpIngress;
+    fm_bool             grpEgress;
+    fm_bool             portIngress;
+    fm_bool             portEgress;
+    fm_bool             oldIngress;
+    fm_bool             oldEgress;
+    fm_byte *           oldState;
+    fm_int *            changedPorts;
+    fm_int              numChanged;
+    fm_int              i;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_MIRROR,
+                     "sw=%d group=%d numPorts=%d portList=%p type=%d\n",
+                     sw,
+                     group,
+                     numPorts,
+                     (void *) portList,
+                     mirrorType);
+
+    if ( (numPorts <= 0) || (portList == NULL) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_MIRROR, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    /* SWAG members are programmed port by port */
+    if (switchPtr->AddMirrorPort != NULL)
+    {
+        for (i = 0 ; i < numPorts ; i++)
+        {
+            err = fmAddMirrorPortInternal(sw, group, portList[i], mirrorType);
+            if (err != FM_OK)
+            {
+                break;
+            }
+        }
+
+        UNPROTECT_SWITCH(sw);
+        FM_LOG_EXIT_API(FM_LOG_CAT_MIRROR, err);
+    }
+
+    oldState     = NULL;
+    changedPorts = NULL;
+    numChanged   = 0;
+
+    GET_PORT_MIRROR_GROUP(sw, grp, group);
+
+    TAKE_MIRROR_LOCK(sw);
+
+    if (!grp->used)
+    {
+        err = FM_ERR_INVALID_PORT_MIRROR_GROUP;
+        goto ABORT;
+    }
+
+    err = GetMirrorDirection(grp->mirrorType, &grpIngress, &grpEgress);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
+
+    err = GetMirrorDirection(mirrorType, &portIngress, &portEgress);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
+
+    /* Validate the port mirrorType to be a subset of the group. */
+    if ( (portIngress && !grpIngress) ||
+         (portEgress  && !grpEgress) )
+    {
+        err = FM_ERR_INVALID_PORT_MIRROR_GROUP;
+        goto ABORT;
+    }
+
+    /* Validate every port before touching the group */
+    for (i = 0 ; i < numPorts ; i++)
+    {
+        if (!fmIsValidPort(sw, portList[i], ALLOW_CPU))
+        {
+            err = FM_ERR_INVALID_PORT;
+            goto ABORT;
+        }
+
+        switch (switchPtr->portTable[portList[i]]->portType)
+        {
+            case FM_PORT_TYPE_CPU:
+            case FM_PORT_TYPE_PHYSICAL:
+            case FM_PORT_TYPE_TE:
+            case FM_PORT_TYPE_LOOPBACK:
+                break;
+            default:
+                err = FM_ERR_INVALID_PORT;
+                goto ABORT;
+        }
+    }
+
+    oldState     = fmAlloc(numPorts * sizeof(fm_byte));
+    changedPorts = fmAlloc(numPorts * sizeof(fm_int));
+
+    if ( (oldState == NULL) || (changedPorts == NULL) )
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    /* Update the group membership, keeping the previous state of each port
+     * (bit 0 ingress, bit 1 egress) to restore it on failure. */
+    for (i = 0 ; i < numPorts ; i++)
+    {
+        portPtr = switchPtr->portTable[portList[i]];
+
+        err = fmGetBitArrayBit(&grp->ingressPortUsed,
+                               portPtr->portIndex,
+                               &oldIngress);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
+
+        err = fmGetBitArrayBit(&grp->egressPortUsed,
+                               portPtr->portIndex,
+                               &oldEgress);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MIRROR, err);
+
+        oldState[i] = (oldIngress ? 1 : 0) | (oldEgress ? 2 : 0);
+
+        if ( (oldIngress == portIngress) && (oldEgress == portEgress) )
+        {
+            continue;
+        }
+
+        fmSetBitArrayBit(&grp->ingressPortUsed,
+                         portPtr->portIndex,
+                         portIngress);
+        fmSetBitArrayBit(&grp->egressPortUsed,
+                         portPtr->portIndex,
+                         portEgress);
+
+        changedPorts[numChanged++] = portList[i];
+    }
+
+    if (numChanged > 0)
+    {
+        err = WriteMirrorGroupPorts(sw, grp, numChanged, changedPorts);
+
+        /* Restore original state on error */
+        if (err != FM_OK)
+        {
+            /* Reverse order so a port listed twice ends in its first state */
+            for (i = numPorts - 1 ; i >= 0 ; i--)
+            {
+                portPtr = switchPtr->portTable[portList[i]];
+
+                fmSetBitArrayBit(&grp->ingressPortUsed,
+                                 portPtr->portIndex,
+                                 (oldState[i] & 1) != 0);
+                fmSetBitArrayBit(&grp->egressPortUsed,
+                                 portPtr->portIndex,
+                                 (oldState[i] & 2) != 0);
+            }
+
+            if (switchPtr->WritePortMirrorGroup != NULL)
+            {
+                /* write the entry to hardware */
+                switchPtr->WritePortMirrorGroup(sw, grp);
+            }
+        }
+    }
+
+ABORT:
+    DROP_MIRROR_LOCK(sw);
+
+    if (oldState != NULL)
+    {
+        fmFree(oldState);
+    }
+
+    if (changedPorts != NULL)
+    {
+        fmFree(changedPorts);
+    }
+
+    UNPROTECT_SWITCH(sw);
+    FM_LOG_EXIT_API(FM_LOG_CAT_MIRROR, err);
+
+}   /* end fmAddMirrorPortList */
+
+
+
+
 /*****************************************************************************/
 /** fmDeleteMirrorPortInt
  * \ingroup intMirror
@@ -1666,13 +1948,10 @@ fm_status fmDeleteMirrorPortInt(fm_int sw, fm_int group, fm_int port)
     {
         err = switchPtr->DeleteMirrorPort(sw, grp, port);
     }
-    else
+    else if (oldPortIngress || oldPortEgress)
     {
         /* write the entry to hardware */
-        FM_API_CALL_FAMILY(err,
-                           switchPtr->WritePortMirrorGroup,
-                           sw,
-                           grp);
+        err = WriteMirrorGroupPorts(sw, grp, 1, &port);
     }
 
     /* Restore original state on error */
@@ -1993,6 +2272,143 @@ fm_status fmAddMirrorVlanExt(fm_int            sw,
 
 
 
+/*****************************************************************************/
+/** fmAddMirrorVlanList
+ * \ingroup mirror
+ *
+ * \chips           FM6000, FM10000
+ *
+ * \desc            Associate a list of VLANs with a mirror group under a
+ *                  single mirror lock. Each VLAN is handled as by
+ *                  ''fmAddMirrorVlanExt'': only the VLAN table entry of each
+ *                  VLAN is written, and the group itself is rewritten only
+ *                  when its first VLAN is added. Either all the VLANs are
+ *                  added or the group is left unchanged.
+ *
+ * \note            For the FM10000 switch family, a vlan can only be added to
+ *                  a single mirror group and the only direction available is
+ *                  FM_MIRROR_VLAN_EGRESS.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       group is the mirror group number to which the VLANs
+ *                  should be associated.
+ *
+ * \param[in]       vlanSel indicates which VLAN field in the frame the mirror
+ *                  group should operate on.
+ *
+ * \param[in]       numVlans is the number of VLANs in vlanList.
+ *
+ * \param[in]       vlanList points to the list of VLANs to add.
+ *
+ * \param[in]       direction indicates whether the VLANs' ingress traffic,
+ *                  egress traffic or both are mirrored (see
+ *                  ''fm_mirrorVlanType'').
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if numVlans or vlanList is
+ *                  invalid, or direction is not supported.
+ * \return          FM_ERR_INVALID_VLAN if one of the VLANs is invalid.
+ * \return          FM_ERR_INVALID_PORT_MIRROR_GROUP if group is out of range
+ *                  or does not exist.
+ *
+ *****************************************************************************/
+fm_status fmAddMirrorVlanList(fm_int            sw,
+                              fm_int            group,
+                              fm_vlanSelect     vlanSel,
+                              fm_int            numVlans,
+                              fm_uint16 *       vlanList,
+                              fm_mirrorVlanType direction)
+{
+    fm_portMirrorGroup *grp;
+    fm_status           err;
+    fm_switch *         switchPtr;
+    fm_tree *           vlanTree;
+    fm_int              i;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_MIRROR,
+                     "sw=%d group=%d vlanSel=%d numVlans=%d vlanList=%p "
+                     "direction=%d\n",
+                     sw,
+                     group,
+                     vlanSel,
+                     numVlans,
+                     (void *) vlanList,
+                     direction);
+
+    if ( (numVlans <= 0) || (vlanList == NULL) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_MIRROR, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    for (i = 0 ; i < numVlans ; i++)
+    {
+        VALIDATE_VLAN_ID(sw, vlanList[i]);
+    }
+
+    GET_PORT_MIRROR_GROUP(sw, grp, group);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    vlanTree  = (vlanSel == FM_VLAN_SELECT_VLAN2) ?  &grp->vlan2s : &grp->vlan1s;
+
+    TAKE_MIRROR_LOCK(sw);
+
+    if (!grp->used)
+    {
+        err = FM_ERR_INVALID_PORT_MIRROR_GROUP;
+        goto ABORT;
+    }
+
+    for (i = 0 ; i < numVlans ; i++)
+    {
+        err = fmTreeInsert(vlanTree, vlanList[i], (void*) direction);
+        if (err != FM_OK)
+        {
+            break;
+        }
+
+        FM_API_CALL_FAMILY(err,
+                           switchPtr->AddMirrorVlan,
+                           sw,
+                           grp,
+                           vlanSel,
+                           vlanList[i],
+                           direction);
+
+        if (err != FM_OK)
+        {
+            fmTreeRemoveCertain(vlanTree, vlanList[i], NULL);
+            break;
+        }
+    }
+
+    /* Remove the VLANs already added, last one first */
+    if (err != FM_OK)
+    {
+        while (--i >= 0)
+        {
+            fmTreeRemoveCertain(vlanTree, vlanList[i], NULL);
+
+            if (switchPtr->DeleteMirrorVlan != NULL)
+            {
+                switchPtr->DeleteMirrorVlan(sw, grp, vlanSel, vlanList[i]);
+            }
+        }
+    }
+
+ABORT:
+    DROP_MIRROR_LOCK(sw);
+    UNPROTECT_SWITCH(sw);
+    FM_LOG_EXIT_API(FM_LOG_CAT_MIRROR, err);
+
+}   /* end fmAddMirrorVlanList */
+
+
+
+
 /*****************************************************************************/
 /** fmDeleteMirrorVlanInternal
  * \ingroup intmirror
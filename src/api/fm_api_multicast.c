@@ -735,6 +735,117 @@ static fm_status AddListenerToHardware(fm_int                   sw,
 
 
 
+/*****************************************************************************/
+/** AddListenerListToHardware
+ * \ingroup intMulticast
+ *
+ * \desc            Adds a list of multicast listeners to the hardware.
+ *                  Consecutive port/VLAN listeners on physical, CPU and
+ *                  virtual ports are handed to the switch as a single list
+ *                  so that the replication tables are updated once per run
+ *                  instead of once per listener.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       group points to the multicast group.
+ *
+ * \param[in]       numListeners is the number of entries in intListeners.
+ *
+ * \param[in]       intListeners points to the array of listeners to add.
+ *
+ * \param[out]      numAdded points to caller-provided storage where the
+ *                  number of listeners added, counted from the start of the
+ *                  list, is returned. On error, the listener at that index
+ *                  is the one that failed.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status AddListenerListToHardware(fm_int                    sw,
+                                           fm_intMulticastGroup *    group,
+                                           fm_int                    numListeners,
+                                           fm_intMulticastListener **intListeners,
+                                           fm_int *                  numAdded)
+{
+    fm_switch *              switchPtr;
+    fm_intMulticastListener *intListener;
+    fm_port *                portPtr;
+    fm_status                err;
+    fm_int                   runLength;
+    fm_int                   added;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_MULTICAST,
+                 "sw = %d, group = %p(%d), numListeners = %d, "
+                 "intListeners = %p\n",
+                 sw,
+                 (void *) group,
+                 group->handle,
+                 numListeners,
+                 (void *) intListeners);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    *numAdded = 0;
+    err       = FM_OK;
+
+    while (*numAdded < numListeners)
+    {
+        runLength = 0;
+
+        if (switchPtr->AddMulticastListenerList != NULL)
+        {
+            while ( (*numAdded + runLength) < numListeners )
+            {
+                intListener = intListeners[*numAdded + runLength];
+
+                if (intListener->listener.listenerType !=
+                    FM_MCAST_GROUP_LISTENER_PORT_VLAN)
+                {
+                    break;
+                }
+
+                portPtr = GET_PORT_PTR(sw,
+                                       intListener->listener.info.portVlanListener.port);
+
+                if ( (portPtr == NULL) ||
+                     ( (portPtr->portType != FM_PORT_TYPE_PHYSICAL) &&
+                       (portPtr->portType != FM_PORT_TYPE_CPU) &&
+                       (portPtr->portType != FM_PORT_TYPE_VIRTUAL) ) )
+                {
+                    break;
+                }
+
+                runLength++;
+            }
+        }
+
+        if (runLength <= 1)
+        {
+            err = AddListenerToHardware(sw, group, intListeners[*numAdded]);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+            (*numAdded)++;
+            continue;
+        }
+
+        added = 0;
+        err   = switchPtr->AddMulticastListenerList(sw,
+                                                    group,
+                                                    runLength,
+                                                    &intListeners[*numAdded],
+                                                    &added);
+        *numAdded += added;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+    }
+
+ABORT:
+
+    FM_LOG_EXIT(FM_LOG_CAT_MULTICAST, err);
+
+}   /* end AddListenerListToHardware */
+
+
+
+
 /*****************************************************************************/
 /** DeleteListenerFromHardware
  * \ingroup intMulticast
@@ -1602,11 +1713,10 @@ fm_status fmAllocateMcastGroupsInt(fm_int    sw,
 
     /* Get a block of group handles for use with the logical ports that
      * were just allocated. */
-    err = fmFindBitBlockInBitArray(&switchPtr->mcastHandles,
-                                   0,
-                                   numMcastPorts,
-                                   FALSE,
-                                   &baseMcastHandle);
+    err = fmFindBitRunInBitArray(&switchPtr->mcastHandles,
+                                 0,
+                                 numMcastPorts,
+                                 &baseMcastHandle);
 
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
@@ -1777,6 +1887,7 @@ fm_status fmCreateMcastGroupInt(fm_int  sw,
     fm_bool               handleReserved       = FALSE;
     fm_bool               groupAllocated       = FALSE;
     fm_bool               groupInserted        = FALSE;
+    fm_bool               groupMapped          = FALSE;
     fm_bool               portGroupInserted    = FALSE;
     fm_bool               logicalPortAllocated = FALSE;
     fm_bool               forceRPFAction       = FALSE;
@@ -1945,6 +2056,13 @@ fm_status fmCreateMcastGroupInt(fm_int  sw,
 
     groupInserted = TRUE;
 
+    err = fmHashMapInsert( &switchPtr->mcastHandleMap,
+                           (fm_uint64) group->handle,
+                           (void *) group );
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
+    groupMapped = TRUE;
+
     if (group->logicalPort != FM_LOGICAL_PORT_NONE)
     {
         err = fmTreeInsert( &switchPtr->mcastPortTree,
@@ -1976,6 +2094,13 @@ ABORT:
                                 NULL );
         }
 
+        if (groupMapped)
+        {
+            fmHashMapRemove( &switchPtr->mcastHandleMap,
+                             (fm_uint64) group->handle,
+                             NULL );
+        }
+
         if (groupInserted)
         {
             fmTreeRemoveCertain( &switchPtr->mcastTree,
@@ -2173,90 +2298,173 @@ static fm_bool VerifyListener(fm_int                   sw,
 
 
 /*****************************************************************************/
-/** UpdateMcastHNIFloodingGroups
+/** ApplyHNIFloodingChanges
  * \ingroup intMulticast
  *
- * \desc            Updates mcast group configured as HNI flooding with given
- *                  listener.
+ * \desc            Applies the pending multicast flooding changes to every
+ *                  multicast group configured as HNI flooding. Listeners
+ *                  added to a group are written to the hardware as one
+ *                  list, so a burst of changes costs one replication
+ *                  table update per group instead of one per port.
  *
- * \param[in]       sw is the switch on which to operate.
- *
- * \param[in]       mcastGroup is the multicast group ID number.
+ * \note            The caller must hold the routing lock.
  *
- * \param[in]       listener points to an ''fm_mcastGroupListener'' structure
- *                  describing the listener to add/remove.
- *
- * \param[in]       state is TRUE if the listener should be added to mcast 
- *                  group, or FALSE if it should be removed from mcast group.
+ * \param[in]       sw is the switch on which to operate.
  *
  * \return          FM_OK if successful.
- * \return          FM_ERR_MCAST_GROUP_NOT_ACTIVE if the group is not active.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
  *
  *****************************************************************************/
-static fm_status UpdateMcastHNIFloodingGroups(fm_int                 sw,
-                                              fm_int                 mcastGroup,
-                                              fm_mcastGroupListener *listener,
-                                              fm_bool                state)
+static fm_status ApplyHNIFloodingChanges(fm_int sw)
 {
-    fm_status status;
+    fm_switch *               switchPtr;
+    fm_intMulticastGroup *    group;
+    fm_intMulticastListener * intListener;
+    fm_intMulticastListener **intListeners;
+    fm_mcastGroupListener *   changes;
+    fm_treeIterator           iter;
+    fm_uint64                 key;
+    fm_uint64                 listenerKey;
+    void *                    value;
+    fm_status                 status;
+    fm_int                    numPending;
+    fm_int                    numAdd;
+    fm_int                    numDel;
+    fm_int                    numCreated;
+    fm_int                    numAdded;
+    fm_int                    port;
+    fm_int                    i;
 
-    FM_LOG_ENTRY(FM_LOG_CAT_MULTICAST,
-                 "sw = %d, mcastGroup = %d, listener = %p, state = %d\n",
-                 sw,
-                 mcastGroup,
-                 (void *) listener,
-                 state);
+    FM_LOG_ENTRY(FM_LOG_CAT_MULTICAST, "sw = %d\n", sw);
+
+    switchPtr    = GET_SWITCH_PTR(sw);
+    changes      = NULL;
+    intListeners = NULL;
+    status       = FM_OK;
 
-    if (state)
+    numPending = (fm_int) fmTreeSize(&switchPtr->mcastHNIFloodPending);
+
+    if (numPending == 0)
     {
-        status = fmAddMcastGroupListenerInternalForFlood(sw,
-                                                         mcastGroup,
-                                                         listener);
+        FM_LOG_EXIT(FM_LOG_CAT_MULTICAST, FM_OK);
+    }
 
-        if (status == FM_ERR_ALREADY_EXISTS)
-        {
-            FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,
-                         "Listener (port, vlan) = (%d, %d)"
-                         " already added to mcast group %d\n",
-                         listener->info.portVlanListener.port,
-                         FM_MAILBOX_DEF_VLAN_FOR_FLOOD_MCAST_GROUPS,
-                         mcastGroup);
-        }
-        else if (status == FM_ERR_PORT_IS_IN_LAG)
+    changes      = fmAlloc(numPending * sizeof(fm_mcastGroupListener));
+    intListeners = fmAlloc(numPending * sizeof(fm_intMulticastListener *));
+
+    if ( (changes == NULL) || (intListeners == NULL) )
+    {
+        status = FM_ERR_NO_MEM;
+        FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, status);
+    }
+
+    /* Additions are stored from the start of the array and deletions
+     * from its end. */
+    numAdd = 0;
+    numDel = 0;
+
+    fmTreeIterInit(&iter, &switchPtr->mcastHNIFloodPending);
+
+    while ( fmTreeIterNext(&iter, &key, &value) == FM_OK )
+    {
+        port = (fm_int) key;
+
+        if (value != NULL)
         {
-            FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,
-                         "Port %d is a member of a Link Aggregation Group",
-                         listener->info.portVlanListener.port);
+            status = ValidateListenerPort(sw, port);
+
+            if (status != FM_OK)
+            {
+                FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,
+                             "Flooding port %d not added to HNI flooding "
+                             "groups: %s\n",
+                             port,
+                             fmErrorMsg(status));
+                continue;
+            }
+
+            i = numAdd++;
         }
         else
         {
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, status);
+            i = numPending - ++numDel;
         }
+
+        FM_CLEAR(changes[i]);
+
+        changes[i].listenerType = FM_MCAST_GROUP_LISTENER_PORT_VLAN;
+        changes[i].info.portVlanListener.vlan =
+                   FM_MAILBOX_DEF_VLAN_FOR_FLOOD_MCAST_GROUPS;
+        changes[i].info.portVlanListener.port = port;
     }
-    else
-    {
-        status = fmDeleteMcastGroupListenerInternalForFlood(sw,
-                                                            mcastGroup,
-                                                            listener);
 
-        if (status == FM_ERR_NOT_FOUND)
+    /* The changes are consumed even if applying them fails below. */
+    fmTreeDestroy(&switchPtr->mcastHNIFloodPending, NULL);
+    fmTreeInit(&switchPtr->mcastHNIFloodPending);
+
+    status = FM_OK;
+
+    fmTreeIterInit(&iter, &switchPtr->mcastTree);
+
+    while ( fmTreeIterNext(&iter, &key, (void **) &group) == FM_OK )
+    {
+        if (!group->isHNIFlooding)
         {
-            FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,
-                         "Listener (port, vlan) = (%d, %d)"
-                         " already deleted from mcast group %d\n",
-                         listener->info.portVlanListener.port,
-                         FM_MAILBOX_DEF_VLAN_FOR_FLOOD_MCAST_GROUPS,
-                         mcastGroup);
+            continue;
         }
-        else if (status == FM_ERR_PORT_IS_IN_LAG)
+
+        for (i = numPending - numDel ; i < numPending ; i++)
         {
-            FM_LOG_DEBUG(FM_LOG_CAT_MULTICAST,
-                         "Port %d is a member of a Link Aggregation Group",
-                         listener->info.portVlanListener.port);
+            listenerKey =
+                GET_LISTENER_KEY(changes[i].info.portVlanListener.port,
+                                 changes[i].info.portVlanListener.vlan);
+
+            if ( fmTreeFind(&group->listenerTree,
+                            listenerKey,
+                            (void **) &intListener) != FM_OK )
+            {
+                continue;
+            }
+
+            status = DeleteMulticastListener(sw, group, intListener);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, status);
         }
-        else
+
+        numCreated = 0;
+
+        for (i = 0 ; i < numAdd ; i++)
         {
+            status = CreateListener(sw,
+                                    group,
+                                    &changes[i],
+                                    &intListeners[numCreated]);
+
+            if (status == FM_ERR_ALREADY_EXISTS)
+            {
+                continue;
+            }
+
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, status);
+
+            intListeners[numCreated]->floodListener = TRUE;
+            numCreated++;
+        }
+
+        if (group->activated && (numCreated > 0))
+        {
+            status = AddListenerListToHardware(sw,
+                                               group,
+                                               numCreated,
+                                               intListeners,
+                                               &numAdded);
+            if (status != FM_OK)
+            {
+                for (i = numAdded ; i < numCreated ; i++)
+                {
+                    DeleteListener(sw, group, &intListeners[i]->listener);
+                }
+                FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, status);
+            }
         }
     }
 
@@ -2264,9 +2472,19 @@ static fm_status UpdateMcastHNIFloodingGroups(fm_int                 sw,
 
 ABORT:
 
+    if (changes != NULL)
+    {
+        fmFree(changes);
+    }
+
+    if (intListeners != NULL)
+    {
+        fmFree(intListeners);
+    }
+
     FM_LOG_EXIT(FM_LOG_CAT_MULTICAST, status);
 
-}   /* end UpdateMcastHNIFloodingGroups */
+}   /* end ApplyHNIFloodingChanges */
 
 
 /*****************************************************************************
@@ -2385,6 +2603,154 @@ fm_int fmCompareMulticastAddresses(const void *key1, const void *key2)
 
 
 
+/*****************************************************************************/
+/** MixMulticastHash
+ * \ingroup intMulticast
+ *
+ * \desc            Mixes one value into a multicast address hash.
+ *
+ * \param[in]       hash is the hash so far.
+ *
+ * \param[in]       value is the value to mix in.
+ *
+ * \return          The updated hash.
+ *
+ *****************************************************************************/
+static fm_uint64 MixMulticastHash(fm_uint64 hash, fm_uint64 value)
+{
+    hash ^= value;
+    hash *= FM_LITERAL_U64(0x9e3779b97f4a7c15);
+    hash ^= hash >> 29;
+
+    return hash;
+
+}   /* end MixMulticastHash */
+
+
+
+
+/*****************************************************************************/
+/** MixMulticastIPHash
+ * \ingroup intMulticast
+ *
+ * \desc            Mixes an IP address and its prefix length into a
+ *                  multicast address hash. Only the words compared by
+ *                  ''fmCompareIPAddresses'' are used.
+ *
+ * \param[in]       hash is the hash so far.
+ *
+ * \param[in]       addr points to the IP address.
+ *
+ * \param[in]       prefixLength is the prefix length of the address.
+ *
+ * \return          The updated hash.
+ *
+ *****************************************************************************/
+static fm_uint64 MixMulticastIPHash(fm_uint64        hash,
+                                    const fm_ipAddr *addr,
+                                    fm_int           prefixLength)
+{
+    fm_int i;
+
+    hash = MixMulticastHash(hash, (fm_uint64) addr->isIPv6);
+    hash = MixMulticastHash(hash, (fm_uint64) prefixLength);
+    hash = MixMulticastHash(hash, addr->addr[0]);
+
+    if (addr->isIPv6)
+    {
+        for (i = 1 ; i < 4 ; i++)
+        {
+            hash = MixMulticastHash(hash, addr->addr[i]);
+        }
+    }
+
+    return hash;
+
+}   /* end MixMulticastIPHash */
+
+
+
+
+/*****************************************************************************/
+/** fmHashMulticastAddress
+ * \ingroup intMulticast
+ *
+ * \desc            Hashes an fm_mcastAddrKey structure, for the switch's
+ *                  map of multicast addresses. Only the fields compared by
+ *                  ''fmCompareMulticastAddresses'' for the address type
+ *                  are used, so equal keys always hash alike.
+ *
+ * \param[in]       key points to the key.
+ *
+ * \return          hash of the key.
+ *
+ *****************************************************************************/
+fm_uint32 fmHashMulticastAddress(const void *key)
+{
+    const fm_mcastAddrKey *         addrKey;
+    const fm_multicastAddressInfo * info;
+    fm_uint64                       hash;
+
+    addrKey = (const fm_mcastAddrKey *) key;
+    info    = &addrKey->addr.info;
+
+    hash = MixMulticastHash(0, (fm_uint64) addrKey->addr.addressType);
+
+    switch (addrKey->addr.addressType)
+    {
+        case FM_MCAST_ADDR_TYPE_L2MAC_VLAN:
+            /* The VLANs are only compared in independent VLAN learning
+             * mode, so they cannot be part of the hash. */
+            hash = MixMulticastHash(hash, info->mac.destMacAddress);
+            break;
+
+        case FM_MCAST_ADDR_TYPE_DSTIP:
+            hash = MixMulticastIPHash(hash,
+                                      &info->dstIpRoute.dstAddr,
+                                      info->dstIpRoute.dstPrefixLength);
+            break;
+
+        case FM_MCAST_ADDR_TYPE_DSTIP_VLAN:
+            hash = MixMulticastIPHash(hash,
+                                      &info->dstIpVlanRoute.dstAddr,
+                                      info->dstIpVlanRoute.dstPrefixLength);
+            hash = MixMulticastHash(hash, info->dstIpVlanRoute.vlan);
+            hash = MixMulticastHash(hash,
+                                    info->dstIpVlanRoute.vlanPrefixLength);
+            break;
+
+        case FM_MCAST_ADDR_TYPE_DSTIP_SRCIP:
+            hash = MixMulticastIPHash(hash,
+                                      &info->dstSrcIpRoute.dstAddr,
+                                      info->dstSrcIpRoute.dstPrefixLength);
+            hash = MixMulticastIPHash(hash,
+                                      &info->dstSrcIpRoute.srcAddr,
+                                      info->dstSrcIpRoute.srcPrefixLength);
+            break;
+
+        case FM_MCAST_ADDR_TYPE_DSTIP_SRCIP_VLAN:
+            hash = MixMulticastIPHash(hash,
+                                      &info->dstSrcIpVlanRoute.dstAddr,
+                                      info->dstSrcIpVlanRoute.dstPrefixLength);
+            hash = MixMulticastIPHash(hash,
+                                      &info->dstSrcIpVlanRoute.srcAddr,
+                                      info->dstSrcIpVlanRoute.srcPrefixLength);
+            hash = MixMulticastHash(hash, info->dstSrcIpVlanRoute.vlan);
+            hash = MixMulticastHash(hash,
+                                    info->dstSrcIpVlanRoute.vlanPrefixLength);
+            break;
+
+        default:
+            break;
+    }
+
+    return (fm_uint32) ( hash ^ (hash >> 32) );
+
+}   /* end fmHashMulticastAddress */
+
+
+
+
 /*****************************************************************************/
 /** fmFindMcastGroup
  * \ingroup intMulticast
@@ -2406,9 +2772,9 @@ fm_intMulticastGroup *fmFindMcastGroup(fm_int sw, fm_int handle)
 
     switchPtr = GET_SWITCH_PTR(sw);
 
-    status = fmTreeFind( &switchPtr->mcastTree,
-                        (fm_uint64) handle,
-                        (void **) &group );
+    status = fmHashMapFind( &switchPtr->mcastHandleMap,
+                            (fm_uint64) handle,
+                            (void **) &group );
 
     if (status != FM_OK)
     {
@@ -2628,14 +2994,14 @@ fm_status fmFreeMcastGroupDataStructures(fm_switch *switchPtr)
                               fmErrorMsg(status) );
             }
 
-             status = fmCustomTreeRemove(&switchPtr->mcastAddressTree,
-                                         addrKey,
-                                         NULL);
+            status = fmCustomHashMapRemove(&switchPtr->mcastAddressMap,
+                                           addrKey,
+                                           NULL);
 
             if (status != FM_OK)
             {
                 FM_LOG_ERROR( FM_LOG_CAT_MULTICAST,
-                              "fmCustomTreeRemove returned error %d: %s\n",
+                              "fmCustomHashMapRemove returned error %d: %s\n",
                               status,
                               fmErrorMsg(status) );
             }
@@ -2660,6 +3026,13 @@ fm_status fmFreeMcastGroupDataStructures(fm_switch *switchPtr)
             break;
         }
 
+        status = fmHashMapRemove(&switchPtr->mcastHandleMap, key, NULL);
+
+        if (status != FM_OK)
+        {
+            break;
+        }
+
         /* release the logical port */
         if (group->logicalPort != FM_LOGICAL_PORT_NONE)
         {
@@ -2709,7 +3082,9 @@ fm_status fmFreeMcastGroupDataStructures(fm_switch *switchPtr)
     }
 
     fmTreeDestroy(&switchPtr->mcastTree, NULL);
-    fmCustomTreeDestroy(&switchPtr->mcastAddressTree, NULL);
+    fmHashMapDestroy(&switchPtr->mcastHandleMap, NULL);
+    fmTreeDestroy(&switchPtr->mcastHNIFloodPending, NULL);
+    fmCustomHashMapDestroy(&switchPtr->mcastAddressMap, NULL);
     fmTreeDestroy(&switchPtr->mcastPortTree, NULL);
     fmDeleteBitArray(&switchPtr->mcastHandles);
     fmTreeDestroy(&switchPtr->mcastHandlePortTree, NULL);
@@ -2746,14 +3121,20 @@ fm_status fmMcastGroupInit(fm_int sw)
     switchPtr = GET_SWITCH_PTR(sw);
 
     fmTreeInit(&switchPtr->mcastTree);
+    fmHashMapInit(&switchPtr->mcastHandleMap);
+    fmTreeInit(&switchPtr->mcastHNIFloodPending);
 
     if (switchPtr->CompareMulticastAddresses != NULL)
     {
-        fmCustomTreeInit(&switchPtr->mcastAddressTree, switchPtr->CompareMulticastAddresses);
+        fmCustomHashMapInit(&switchPtr->mcastAddressMap,
+                            fmHashMulticastAddress,
+                            switchPtr->CompareMulticastAddresses);
     }
     else
     {
-        fmCustomTreeInit(&switchPtr->mcastAddressTree, fmCompareMulticastAddresses);
+        fmCustomHashMapInit(&switchPtr->mcastAddressMap,
+                            fmHashMulticastAddress,
+                            fmCompareMulticastAddresses);
     }
 
     fmTreeInit(&switchPtr->mcastPortTree);
@@ -2995,6 +3376,11 @@ fm_status fmDeleteMcastGroupInt(fm_int sw, fm_int mcastGroup, fm_bool internal)
                        NULL );
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
+    err = fmHashMapRemove( &switchPtr->mcastHandleMap,
+                           (fm_uint64) group->handle,
+                           NULL );
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+
     if (group->logicalPort != FM_LOGICAL_PORT_NONE)
     {
         err = fmTreeRemove( &switchPtr->mcastPortTree,
@@ -3504,13 +3890,16 @@ fm_status fmAddMcastGroupListenerListInternal(fm_int                 sw,
 {
     fm_switch *              switchPtr;
     fm_mcastGroupListener *  listener;
-    fm_intMulticastGroup *   groupPtr;
-    fm_intMulticastListener *intListener;
-    fm_bool                  routingLockTaken;
-    fm_bool                  flowLockTaken;
-    fm_bool                  mcastHNIFlooding;
-    fm_status                err;
-    fm_int                   i;
+    fm_intMulticastGroup *    groupPtr;
+    fm_intMulticastListener **intListeners;
+    fm_bool                   routingLockTaken;
+    fm_bool                   flowLockTaken;
+    fm_bool                   mcastHNIFlooding;
+    fm_status                 err;
+    fm_status                 createErr;
+    fm_int                    numCreated;
+    fm_int                    numAdded;
+    fm_int                    i;
 
     FM_LOG_ENTRY(FM_LOG_CAT_MULTICAST,
                  "sw = %d, mcastGroup = %d, numListeners = %d "
@@ -3523,6 +3912,7 @@ fm_status fmAddMcastGroupListenerListInternal(fm_int                 sw,
     switchPtr        = GET_SWITCH_PTR(sw);
     routingLockTaken = FALSE;
     flowLockTaken    = FALSE;
+    intListeners     = NULL;
 
     mcastHNIFlooding = GET_PROPERTY()->hniMcastFlooding;
 
@@ -3586,32 +3976,66 @@ fm_status fmAddMcastGroupListenerListInternal(fm_int                 sw,
 
     /*****************************************************
      * Create internal listener objects and add them to
-     * the multicast group.
+     * the multicast group. The listeners created before
+     * a failure are still added to the hardware.
      *****************************************************/
 
-    for (i = 0 ; i < numListeners ; i++)
+    if (numListeners > 0)
     {
-        listener = &listenerList[i];
+        intListeners = fmAlloc(numListeners * sizeof(fm_intMulticastListener *));
+        if (intListeners == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
+        }
+    }
 
+    createErr  = FM_OK;
+    numCreated = 0;
+
+    while (numCreated < numListeners)
+    {
         /* Create a listener for this (vlan, port). */
-        err = CreateListener(sw, groupPtr, listener, &intListener);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
+        createErr = CreateListener(sw,
+                                   groupPtr,
+                                   &listenerList[numCreated],
+                                   &intListeners[numCreated]);
+        if (createErr != FM_OK)
+        {
+            break;
+        }
+
+        numCreated++;
+    }
 
-        /* Activate the listener. */
-        if (groupPtr->activated)
+    /* Activate the listeners. */
+    if (groupPtr->activated && (numCreated > 0))
+    {
+        err = AddListenerListToHardware(sw,
+                                        groupPtr,
+                                        numCreated,
+                                        intListeners,
+                                        &numAdded);
+        if (err != FM_OK)
         {
-            err = AddListenerToHardware(sw, groupPtr, intListener);
-            if (err != FM_OK)
+            for (i = numAdded ; i < numCreated ; i++)
             {
-                DeleteListener(sw, groupPtr, listener);
-                FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
+                DeleteListener(sw, groupPtr, &listenerList[i]);
             }
+            FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
         }
+    }
 
-    }   /* for (i = 0 ; i < numListeners ; i++) */
+    err = createErr;
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
 ABORT:
 
+    if (intListeners != NULL)
+    {
+        fmFree(intListeners);
+    }
+
     /* Check if group should be configured as requestes by HNI or not. */
     if ( (mcastHNIFlooding) && (err == FM_OK) && 
          (switchPtr->swag < 0)  && !(groupPtr->internal) )
@@ -5673,15 +6097,15 @@ fm_status fmSetMcastGroupAddress(fm_int               sw,
         }
     }
 
-    /* Add the address and group to the address tree */
-    err = fmCustomTreeInsert( &switchPtr->mcastAddressTree,
-                             (void *) addrKey,
-                             (void *) group );
+    /* Add the address and group to the address map */
+    err = fmCustomHashMapInsert( &switchPtr->mcastAddressMap,
+                                 (void *) addrKey,
+                                 (void *) group );
 
     if (err != FM_OK)
     {
         FM_LOG_FATAL( FM_LOG_CAT_MULTICAST,
-                     "mcastAddressTree insert failed for sw %d, group %d, "
+                     "mcastAddressMap insert failed for sw %d, group %d, "
                      "err %d (%s)\n",
                      sw,
                      group->handle,
@@ -5763,7 +6187,7 @@ fm_status fmAddMcastGroupAddressInt(fm_int               sw,
     fm_bool               lockTaken;
     fm_bool               addrKeyAllocated;
     fm_bool               addressTreeAdded;
-    fm_bool               mcastAddressTreeAdded;
+    fm_bool               mcastAddressMapAdded;
     fm_ipAddr             destIpAddr;
     fm_mcastAddrKey *     addrKey;
 
@@ -5779,7 +6203,7 @@ fm_status fmAddMcastGroupAddressInt(fm_int               sw,
     lockTaken             = FALSE;
     addrKeyAllocated      = FALSE;
     addressTreeAdded      = FALSE;
-    mcastAddressTreeAdded = FALSE;
+    mcastAddressMapAdded = FALSE;
 
     if (address->addressType == FM_MCAST_ADDR_TYPE_L2MAC_VLAN)
     {
@@ -5867,15 +6291,15 @@ fm_status fmAddMcastGroupAddressInt(fm_int               sw,
 
     addressTreeAdded = TRUE;
 
-    /* Add the address and group to the address tree */
-    err = fmCustomTreeInsert( &switchPtr->mcastAddressTree,
-                             (void *) addrKey,
-                             (void *) group );
+    /* Add the address and group to the address map */
+    err = fmCustomHashMapInsert( &switchPtr->mcastAddressMap,
+                                 (void *) addrKey,
+                                 (void *) group );
 
     if (err != FM_OK)
     {
         FM_LOG_FATAL( FM_LOG_CAT_MULTICAST,
-                     "mcastAddressTree insert failed for sw %d, group %d, "
+                     "mcastAddressMap insert failed for sw %d, group %d, "
                      "err %d (%s)\n",
                      sw,
                      group->handle,
@@ -5885,7 +6309,7 @@ fm_status fmAddMcastGroupAddressInt(fm_int               sw,
         FM_LOG_ABORT(FM_LOG_CAT_MULTICAST, err);
     }
 
-    mcastAddressTreeAdded = TRUE;
+    mcastAddressMapAdded = TRUE;
 
     if (switchPtr->AddMcastGroupAddress != NULL)
     {
@@ -5907,11 +6331,11 @@ ABORT:
 
     if (err != FM_OK)
     {
-        if (mcastAddressTreeAdded)
+        if (mcastAddressMapAdded)
         {
-            fmCustomTreeRemoveCertain( &switchPtr->mcastAddressTree,
-                                       (void *) addrKey,
-                                       NULL );
+            fmCustomHashMapRemove( &switchPtr->mcastAddressMap,
+                                   (void *) addrKey,
+                                   NULL );
         }
 
         if (addressTreeAdded)
@@ -6104,10 +6528,10 @@ fm_status fmDeleteMcastGroupAddress(fm_int               sw,
 
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
-    /* Remove the address/group from the switch's multicast address tree */
-    err = fmCustomTreeRemove( &switchPtr->mcastAddressTree,
-                              (void *) addrKey,
-                              NULL);
+    /* Remove the address/group from the switch's multicast address map */
+    err = fmCustomHashMapRemove( &switchPtr->mcastAddressMap,
+                                 (void *) addrKey,
+                                 NULL);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
     if (group->singleMcastAddr == addrKey)
@@ -6194,8 +6618,8 @@ fm_status fmClearMcastGroupAddressesInt(fm_int                sw,
 
         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
-        /* Remove this address from the address tree */
-        err = fmCustomTreeRemove(&switchPtr->mcastAddressTree, addrKey, NULL);
+        /* Remove this address from the address map */
+        err = fmCustomHashMapRemove(&switchPtr->mcastAddressMap, addrKey, NULL);
 
         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
 
@@ -6422,6 +6846,7 @@ fm_status fmActivateMcastGroupInt(fm_int sw,
     fm_intMulticastListener * intListener;
     fm_intMulticastListener **listenerList;
     fm_int                    listenerCount;
+    fm_int                    numAdded;
     fm_int                    nbytes;
     fm_int                    i;
     fm_treeIterator           iter;
@@ -6650,13 +7075,12 @@ fm_status fmActivateMcastGroupInt(fm_int sw,
         listenersAdded = TRUE;
 
         /* Add all listeners to the hardware */
-        for (i = 0 ; i < listenerCount ; i++)
-        {
-            err = AddListenerToHardware(sw,
+        err = AddListenerListToHardware(sw,
                                         group,
-                                        listenerList[i]);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
-        }
+                                        listenerCount,
+                                        listenerList,
+                                        &numAdded);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, err);
     }
 
     group->updateHardware = TRUE;
@@ -7221,9 +7645,9 @@ fm_status fmFindMcastGroupByAddress(fm_int               sw,
         key.routePtr = NULL;
         FM_MEMCPY_S( &key.addr, sizeof(key.addr), address, sizeof(*address));
 
-        err = fmCustomTreeFind( &switchPtr->mcastAddressTree,
-                               (void *) &key,
-                               (void **) &group);
+        err = fmCustomHashMapFind( &switchPtr->mcastAddressMap,
+                                   (void *) &key,
+                                   (void **) &group);
 
         if (err != FM_OK)
         {
@@ -9674,6 +10098,11 @@ fm_bool fmHasMcastGroupNonFloodingListeners(fm_int sw,
  * \ingroup intMulticast
  *
  * \desc            Updates mcast groups configured as HNI flooding.
+ *                  Changes are queued and applied together once the
+ *                  ''api.multicast.hni.floodCoalesceTime'' window opened
+ *                  by the first queued change has passed, either here or
+ *                  from ''fmFlushMcastHNIFloodingGroups''. Only the last
+ *                  state queued for a port is applied.
  *
  * \param[in]       sw is the switch on which to operate.
  *
@@ -9683,17 +10112,18 @@ fm_bool fmHasMcastGroupNonFloodingListeners(fm_int sw,
  *                  or FALSE if it should be removed from mcast groups.
  *
  * \return          FM_OK if successful.
- * \return          FM_ERR_MCAST_GROUP_NOT_ACTIVE if the group is not active.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
  *
  *****************************************************************************/
 fm_status fmUpdateMcastHNIFloodingGroups(fm_int  sw,
                                          fm_int  port,
                                          fm_bool state)
 {
-    fm_status             status;
-    fm_mcastGroupListener tempListener;
-    fm_int                mcastGroupNumber;
-    fm_int                currentMcastGroupNumber;
+    fm_switch *switchPtr;
+    fm_status  status;
+    fm_bool    lockTaken;
+    fm_uint64  coalesceTime;
+    fm_uint64  now;
 
     FM_LOG_ENTRY_API(FM_LOG_CAT_MULTICAST,
                      "sw = %d, port=%d, state=%d\n",
@@ -9701,38 +10131,99 @@ fm_status fmUpdateMcastHNIFloodingGroups(fm_int  sw,
                      port,
                      state);
 
-    status = fmGetMcastGroupFirst(sw, &mcastGroupNumber);
+    switchPtr = GET_SWITCH_PTR(sw);
+    lockTaken = FALSE;
 
-    while (status != FM_ERR_NO_MORE)
+    /* Without the fast maintenance task nothing would apply the queued
+     * changes later, so they are applied right away. */
+    if ( GET_PROPERTY()->fastMaintenanceEnable &&
+         (GET_PROPERTY()->hniMcastFloodCoalesceTime > 0) )
     {
-        if ( fmIsMcastGroupHNIFlooding(sw, mcastGroupNumber) )
-        {
-            /* Add new flood listener */
-            FM_CLEAR(tempListener);
+        coalesceTime =
+            (fm_uint64) GET_PROPERTY()->hniMcastFloodCoalesceTime * 1000000;
+    }
+    else
+    {
+        coalesceTime = 0;
+    }
 
-            tempListener.listenerType = FM_MCAST_GROUP_LISTENER_PORT_VLAN;
-            tempListener.info.portVlanListener.vlan =
-                         FM_MAILBOX_DEF_VLAN_FOR_FLOOD_MCAST_GROUPS;
-            tempListener.info.portVlanListener.port = port;
+    status = fmCaptureWriteLock(&switchPtr->routingLock, FM_WAIT_FOREVER);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, status);
 
-            status = UpdateMcastHNIFloodingGroups(sw,
-                                                  mcastGroupNumber,
-                                                  &tempListener,
-                                                  state);
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, status);
-        }
+    lockTaken = TRUE;
 
-        currentMcastGroupNumber = mcastGroupNumber;
+    (void) fmTreeRemove(&switchPtr->mcastHNIFloodPending, port, NULL);
 
-        status = fmGetMcastGroupNext(sw,
-                                     currentMcastGroupNumber,
-                                     &mcastGroupNumber);
+    status = fmTreeInsert(&switchPtr->mcastHNIFloodPending,
+                          port,
+                          (void *) (fm_uintptr) state);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_MULTICAST, status);
+
+    now = fmGetMonotonicNsec();
+
+    if (fmTreeSize(&switchPtr->mcastHNIFloodPending) == 1)
+    {
+        switchPtr->mcastHNIFloodDeadline = now + coalesceTime;
     }
 
-    status = FM_OK;
+    if (now >= switchPtr->mcastHNIFloodDeadline)
+    {
+        status = ApplyHNIFloodingChanges(sw);
+    }
 
 ABORT:
 
+    if (lockTaken)
+    {
+        fmReleaseWriteLock(&switchPtr->routingLock);
+    }
+
     FM_LOG_EXIT_API(FM_LOG_CAT_MULTICAST, status);
 
 }   /* end fmUpdateMcastHNIFloodingGroups */
+
+
+
+
+/*****************************************************************************/
+/** fmFlushMcastHNIFloodingGroups
+ * \ingroup intMulticast
+ *
+ * \desc            Applies the queued HNI flooding group changes once their
+ *                  coalescing window has passed. Called from the fast
+ *                  maintenance task.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmFlushMcastHNIFloodingGroups(fm_int sw)
+{
+    fm_switch *switchPtr;
+    fm_status  status;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    /* check for pending changes before taking the lock */
+    if ( !fmTreeIsInitialized(&switchPtr->mcastHNIFloodPending) ||
+         (fmTreeSize(&switchPtr->mcastHNIFloodPending) == 0) )
+    {
+        return FM_OK;
+    }
+
+    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_MULTICAST, "sw = %d\n", sw);
+
+    status = fmCaptureWriteLock(&switchPtr->routingLock, FM_WAIT_FOREVER);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_MULTICAST, status);
+
+    if (fmGetMonotonicNsec() >= switchPtr->mcastHNIFloodDeadline)
+    {
+        status = ApplyHNIFloodingChanges(sw);
+    }
+
+    fmReleaseWriteLock(&switchPtr->routingLock);
+
+    FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_MULTICAST, status);
+
+}   /* end fmFlushMcastHNIFloodingGroups */
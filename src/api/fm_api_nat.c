@@ -126,6 +126,161 @@ static void InitializeNatInfoStruct(fm_natInfo *natInfo)
 }   /* end InitializeNatInfoStruct */
 
 
+
+
+/*****************************************************************************/
+/** AddNatRuleEntry
+ * \ingroup intNat
+ *
+ * \desc            Add a NAT rule to a table, see ''fmAddNatRule''.
+ *
+ * \note            The caller must hold the NAT lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       table is the table ID.
+ *
+ * \param[in]       rule is the rule ID.
+ *
+ * \param[in]       condition is a condition mask.
+ *
+ * \param[in]       cndParam points to the condition parameters.
+ *
+ * \param[in]       action is an action mask.
+ *
+ * \param[in]       actParam points to the action parameters.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_ALREADY_EXISTS if the rule already exists.
+ *
+ *****************************************************************************/
+static fm_status AddNatRuleEntry(fm_int                sw,
+                                 fm_int                table,
+                                 fm_int                rule,
+                                 fm_natCondition       condition,
+                                 fm_natConditionParam *cndParam,
+                                 fm_natAction          action,
+                                 fm_natActionParam *   actParam)
+{
+    fm_status       err;
+    fm_switch *     switchPtr;
+    fm_natTable *   natTable;
+    fm_natRule *    natRule;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    err = fmTreeFind(&switchPtr->natInfo->tables, table, (void**) &natTable);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
+
+    err = fmTreeFind(&natTable->rules, rule, (void**) &natRule);
+    if (err == FM_OK)
+    {
+        err = FM_ERR_ALREADY_EXISTS;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
+    }
+    else if (err != FM_ERR_NOT_FOUND)
+    {
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
+    }
+
+    natRule = fmAlloc(sizeof(fm_natRule));
+
+    if (natRule == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
+    }
+
+    FM_CLEAR(*natRule);
+
+    /* Structure field might be updated by chip specific function if needed */
+    natRule->condition = condition;
+    natRule->cndParam = *cndParam;
+    natRule->action = action;
+    natRule->actParam = *actParam;
+
+    FM_API_CALL_FAMILY(err,
+                       switchPtr->AddNatRule,
+                       sw,
+                       table,
+                       rule,
+                       natRule->condition,
+                       &natRule->cndParam,
+                       natRule->action,
+                       &natRule->actParam);
+    if (err == FM_OK)
+    {
+        err = fmTreeInsert(&natTable->rules, rule, natRule);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
+    }
+    else
+    {
+        fmFree(natRule);
+    }
+
+
+ABORT:
+
+    return err;
+
+}   /* end AddNatRuleEntry */
+
+
+
+
+/*****************************************************************************/
+/** DeleteNatRuleEntry
+ * \ingroup intNat
+ *
+ * \desc            Remove a NAT rule from a table, see ''fmDeleteNatRule''.
+ *
+ * \note            The caller must hold the NAT lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       table is the table ID.
+ *
+ * \param[in]       rule is the rule ID.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if the table or rule could not be
+ *                  found.
+ *
+ *****************************************************************************/
+static fm_status DeleteNatRuleEntry(fm_int sw, fm_int table, fm_int rule)
+{
+    fm_status       err;
+    fm_switch *     switchPtr;
+    fm_natTable *   natTable;
+    fm_natRule *    natRule;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    err = fmTreeFind(&switchPtr->natInfo->tables, table, (void**) &natTable);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
+
+    err = fmTreeFind(&natTable->rules, rule, (void**) &natRule);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
+
+    FM_API_CALL_FAMILY(err,
+                       switchPtr->DeleteNatRule,
+                       sw,
+                       table,
+                       rule);
+    if (err == FM_OK)
+    {
+        err = fmTreeRemoveCertain(&natTable->rules, rule, fmFree);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
+    }
+
+
+ABORT:
+
+    return err;
+
+}   /* end DeleteNatRuleEntry */
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -1267,8 +1422,6 @@ fm_status fmAddNatRule(fm_int                sw,
     fm_status       err;
     fm_switch *     switchPtr;
     fm_bool         natLockTaken;
-    fm_natTable *   natTable;
-    fm_natRule *    natRule;
 
     FM_LOG_ENTRY_API(FM_LOG_CAT_NAT,
                      "sw = %d, table = %d, rule = %d, "
@@ -1299,53 +1452,214 @@ fm_status fmAddNatRule(fm_int                sw,
     TAKE_NAT_LOCK(sw);
     natLockTaken = TRUE;
 
-    err = fmTreeFind(&switchPtr->natInfo->tables, table, (void**) &natTable);
+    err = AddNatRuleEntry(sw,
+                          table,
+                          rule,
+                          condition,
+                          cndParam,
+                          action,
+                          actParam);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
 
-    err = fmTreeFind(&natTable->rules, rule, (void**) &natRule);
-    if (err == FM_OK)
+
+ABORT:
+
+    if (natLockTaken)
     {
-        err = FM_ERR_ALREADY_EXISTS;
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
+        DROP_NAT_LOCK(sw);
     }
-    else if (err != FM_ERR_NOT_FOUND)
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_NAT, err);
+
+}   /* end fmAddNatRule */
+
+
+
+
+/*****************************************************************************/
+/** fmDeleteNatRule
+ * \ingroup nat
+ *
+ * \chips           FM10000
+ *
+ * \desc            Remove a NAT rule from the table.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       table is the table ID.
+ * 
+ * \param[in]       rule is the rule ID.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if the table or rule could not be
+ *                  found.
+ *
+ *****************************************************************************/
+fm_status fmDeleteNatRule(fm_int sw, fm_int table, fm_int rule)
+{
+    fm_status       err = FM_OK;
+    fm_switch *     switchPtr;
+    fm_bool         natLockTaken = FALSE;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_NAT,
+                     "sw = %d, table = %d, rule = %d\n",
+                     sw, table, rule);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    /* This structure only gets initialized on switch family that support
+     * that support NAT. */
+    if (switchPtr->natInfo == NULL)
     {
+        err = FM_ERR_UNSUPPORTED;
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
     }
 
-    natRule = fmAlloc(sizeof(fm_natRule));
+    TAKE_NAT_LOCK(sw);
+    natLockTaken = TRUE;
 
-    if (natRule == NULL)
+    err = DeleteNatRuleEntry(sw, table, rule);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
+
+
+ABORT:
+
+    if (natLockTaken)
     {
-        err = FM_ERR_NO_MEM;
+        DROP_NAT_LOCK(sw);
+    }
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_NAT, err);
+
+}   /* end fmDeleteNatRule */
+
+
+
+
+/*****************************************************************************/
+/** fmAddNatRuleList
+ * \ingroup nat
+ *
+ * \chips           FM10000
+ *
+ * \desc            Add a list of NAT rules to a table in a single operation.
+ *                  The NAT table is locked once for the whole list. Each
+ *                  rule is otherwise handled as by ''fmAddNatRule''; a
+ *                  failing rule does not prevent the others from being
+ *                  added.
+ *                                                                      \lb\lb
+ *                  On a ''FM_NAT_MODE_RESOURCE'' table, the tunnel engine
+ *                  writes of the whole list are issued together once the
+ *                  list has been processed.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       table is the table ID.
+ *
+ * \param[in]       numRules is the number of rules in the list.
+ *
+ * \param[in]       rules points to an array of numRules rules to add.
+ *
+ * \param[out]      results points to a caller-allocated array of numRules
+ *                  entries that receives the status of each rule. May be
+ *                  NULL.
+ *
+ * \return          FM_OK if every rule was added successfully.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_UNSUPPORTED if NAT is not supported.
+ * \return          FM_ERR_INVALID_ARGUMENT if rules is NULL or numRules is
+ *                  not positive.
+ * \return          FM_ERR_NOT_FOUND if the table could not be found.
+ * \return          the status of the first rule that failed, in list order,
+ *                  otherwise. See ''fmAddNatRule''.
+ *
+ *****************************************************************************/
+fm_status fmAddNatRuleList(fm_int               sw,
+                           fm_int               table,
+                           fm_int               numRules,
+                           fm_natRuleListEntry *rules,
+                           fm_status *          results)
+{
+    fm_status       err;
+    fm_status       ruleErr;
+    fm_switch *     switchPtr;
+    fm_bool         natLockTaken;
+    fm_natTable *   natTable;
+    fm_int          i;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_NAT,
+                     "sw = %d, table = %d, numRules = %d, rules = %p, "
+                     "results = %p\n",
+                     sw,
+                     table,
+                     numRules,
+                     (void *) rules,
+                     (void *) results);
+
+    err          = FM_OK;
+    natLockTaken = FALSE;
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if ( (rules == NULL) || (numRules <= 0) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
     }
 
-    FM_CLEAR(*natRule);
+    /* This structure only gets initialized on switch family that support
+     * that support NAT. */
+    if (switchPtr->natInfo == NULL)
+    {
+        err = FM_ERR_UNSUPPORTED;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
+    }
 
-    /* Structure field might be updated by chip specific function if needed */
-    natRule->condition = condition;
-    natRule->cndParam = *cndParam;
-    natRule->action = action;
-    natRule->actParam = *actParam;
+    TAKE_NAT_LOCK(sw);
+    natLockTaken = TRUE;
 
-    FM_API_CALL_FAMILY(err,
-                       switchPtr->AddNatRule,
-                       sw,
-                       table,
-                       rule,
-                       natRule->condition,
-                       &natRule->cndParam,
-                       natRule->action,
-                       &natRule->actParam);
-    if (err == FM_OK)
+    err = fmTreeFind(&switchPtr->natInfo->tables, table, (void**) &natTable);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
+
+    if (switchPtr->BeginNatRuleList != NULL)
     {
-        err = fmTreeInsert(&natTable->rules, rule, natRule);
+        err = switchPtr->BeginNatRuleList(sw, table);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
     }
-    else
+
+    for (i = 0 ; i < numRules ; i++)
     {
-        fmFree(natRule);
+        ruleErr = AddNatRuleEntry(sw,
+                                  table,
+                                  rules[i].rule,
+                                  rules[i].condition,
+                                  &rules[i].cndParam,
+                                  rules[i].action,
+                                  &rules[i].actParam);
+
+        if ( (ruleErr != FM_OK) && (err == FM_OK) )
+        {
+            err = ruleErr;
+        }
+
+        if (results != NULL)
+        {
+            results[i] = ruleErr;
+        }
+    }
+
+    if (switchPtr->EndNatRuleList != NULL)
+    {
+        ruleErr = switchPtr->EndNatRuleList(sw, table);
+
+        if (err == FM_OK)
+        {
+            err = ruleErr;
+        }
     }
 
 
@@ -1359,45 +1673,78 @@ ABORT:
 
     FM_LOG_EXIT_API(FM_LOG_CAT_NAT, err);
 
-}   /* end fmAddNatRule */
+}   /* end fmAddNatRuleList */
 
 
 
 
 /*****************************************************************************/
-/** fmDeleteNatRule
+/** fmDeleteNatRuleList
  * \ingroup nat
  *
  * \chips           FM10000
  *
- * \desc            Remove a NAT rule from the table.
+ * \desc            Remove a list of NAT rules from a table in a single
+ *                  operation. Each rule is otherwise handled as by
+ *                  ''fmDeleteNatRule''; a failing rule does not prevent the
+ *                  others from being removed.
  *
  * \param[in]       sw is the switch on which to operate.
  *
  * \param[in]       table is the table ID.
- * 
- * \param[in]       rule is the rule ID.
  *
- * \return          FM_OK if successful.
- * \return          FM_ERR_NOT_FOUND if the table or rule could not be
- *                  found.
+ * \param[in]       numRules is the number of rules in the list.
+ *
+ * \param[in]       rules points to an array of numRules rule IDs.
+ *
+ * \param[out]      results points to a caller-allocated array of numRules
+ *                  entries that receives the status of each rule. May be
+ *                  NULL.
+ *
+ * \return          FM_OK if every rule was removed successfully.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_UNSUPPORTED if NAT is not supported.
+ * \return          FM_ERR_INVALID_ARGUMENT if rules is NULL or numRules is
+ *                  not positive.
+ * \return          FM_ERR_NOT_FOUND if the table could not be found.
+ * \return          the status of the first rule that failed, in list order,
+ *                  otherwise. See ''fmDeleteNatRule''.
  *
  *****************************************************************************/
-fm_status fmDeleteNatRule(fm_int sw, fm_int table, fm_int rule)
+fm_status fmDeleteNatRuleList(fm_int     sw,
+                              fm_int     table,
+                              fm_int     numRules,
+                              fm_int *   rules,
+                              fm_status *results)
 {
-    fm_status       err = FM_OK;
+    fm_status       err;
+    fm_status       ruleErr;
     fm_switch *     switchPtr;
-    fm_bool         natLockTaken = FALSE;
+    fm_bool         natLockTaken;
     fm_natTable *   natTable;
-    fm_natRule *    natRule;
+    fm_int          i;
 
     FM_LOG_ENTRY_API(FM_LOG_CAT_NAT,
-                     "sw = %d, table = %d, rule = %d\n",
-                     sw, table, rule);
+                     "sw = %d, table = %d, numRules = %d, rules = %p, "
+                     "results = %p\n",
+                     sw,
+                     table,
+                     numRules,
+                     (void *) rules,
+                     (void *) results);
+
+    err          = FM_OK;
+    natLockTaken = FALSE;
 
     VALIDATE_AND_PROTECT_SWITCH(sw);
     switchPtr = GET_SWITCH_PTR(sw);
 
+    if ( (rules == NULL) || (numRules <= 0) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
+    }
+
     /* This structure only gets initialized on switch family that support
      * that support NAT. */
     if (switchPtr->natInfo == NULL)
@@ -1412,20 +1759,37 @@ fm_status fmDeleteNatRule(fm_int sw, fm_int table, fm_int rule)
     err = fmTreeFind(&switchPtr->natInfo->tables, table, (void**) &natTable);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
 
-    err = fmTreeFind(&natTable->rules, rule, (void**) &natRule);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
-
-    FM_API_CALL_FAMILY(err,
-                       switchPtr->DeleteNatRule,
-                       sw,
-                       table,
-                       rule);
-    if (err == FM_OK)
+    if (switchPtr->BeginNatRuleList != NULL)
     {
-        err = fmTreeRemoveCertain(&natTable->rules, rule, fmFree);
+        err = switchPtr->BeginNatRuleList(sw, table);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_NAT, err);
     }
 
+    for (i = 0 ; i < numRules ; i++)
+    {
+        ruleErr = DeleteNatRuleEntry(sw, table, rules[i]);
+
+        if ( (ruleErr != FM_OK) && (err == FM_OK) )
+        {
+            err = ruleErr;
+        }
+
+        if (results != NULL)
+        {
+            results[i] = ruleErr;
+        }
+    }
+
+    if (switchPtr->EndNatRuleList != NULL)
+    {
+        ruleErr = switchPtr->EndNatRuleList(sw, table);
+
+        if (err == FM_OK)
+        {
+            err = ruleErr;
+        }
+    }
+
 
 ABORT:
 
@@ -1437,7 +1801,7 @@ ABORT:
 
     FM_LOG_EXIT_API(FM_LOG_CAT_NAT, err);
 
-}   /* end fmDeleteNatRule */
+}   /* end fmDeleteNatRuleList */
 
 
 
@@ -112,6 +112,18 @@ static fm_status UpdateArpEntriesVlanValue(fm_int                  sw,
                                            fm_uint16               vlan);
 static fm_status UpdateNextHopArpEntryRemovedInt(fm_int           sw,
                                                  fm_intArpEntry  *pArpEntry);
+static fm_status CheckFixedNextHopWidth(fm_intEcmpGroup *group,
+                                        fm_ecmpNextHop  *nextHop);
+static fm_status UpdateArpEntryDMACInt(fm_int       sw,
+                                       fm_arpEntry *pArp);
+static fm_status AllocResilientStateInt(fm_intEcmpGroup *pEcmpGroup);
+static fm_int FindResilientMember(fm_int           sw,
+                                  fm_intEcmpGroup *group,
+                                  fm_ecmpNextHop  *member);
+static fm_status SetResilientBucketOwner(fm_int           sw,
+                                         fm_intEcmpGroup *group,
+                                         fm_int           bucket,
+                                         fm_int           owner);
 
 /*****************************************************************************
  * Local Functions
@@ -282,6 +294,18 @@ static fm_status CleanupSingleEcmpGroupInt(fm_int           sw,
         {
             fmFree(pEcmpGroup->nextHops);
         }
+        if (pEcmpGroup->resilientMembers != NULL)
+        {
+            fmFree(pEcmpGroup->resilientMembers);
+        }
+        if (pEcmpGroup->resilientMemberBuckets != NULL)
+        {
+            fmFree(pEcmpGroup->resilientMemberBuckets);
+        }
+        if (pEcmpGroup->resilientBucketOwner != NULL)
+        {
+            fmFree(pEcmpGroup->resilientBucketOwner);
+        }
         fmFree(pEcmpGroup);
     }
 
@@ -2018,6 +2042,251 @@ static fm_status FindInterfaceAddrEntry(fm_int                          sw,
 
 
 
+
+/*****************************************************************************/
+/** CheckFixedNextHopWidth
+ * \ingroup intNextHopEcmp
+ *
+ * \desc            Verifies that a next-hop can be stored in a fixed-size
+ *                  ECMP group, i.e. that its width matches the group's.
+ *
+ * \param[in]       group points to the fixed-size ECMP group.
+ *
+ * \param[in]       nextHop points to the next-hop to check.
+ *
+ * \return          FM_OK if the next-hop can be stored in the group.
+ * \return          FM_ERR_MIXING_NARROW_AND_WIDE_NEXTHOPS if the widths
+ *                  do not match.
+ * \return          FM_ERR_INVALID_ARGUMENT if the next-hop type is invalid.
+ *
+ *****************************************************************************/
+static fm_status CheckFixedNextHopWidth(fm_intEcmpGroup *group,
+                                        fm_ecmpNextHop  *nextHop)
+{
+    fm_bool wideGroup;
+
+    wideGroup = group->wideGroup;
+
+    switch (nextHop->type)
+    {
+        case FM_NEXTHOP_TYPE_ARP:
+        case FM_NEXTHOP_TYPE_RAW_NARROW:
+        case FM_NEXTHOP_TYPE_DROP:
+        case FM_NEXTHOP_TYPE_DMAC:
+        case FM_NEXTHOP_TYPE_TUNNEL:
+        case FM_NEXTHOP_TYPE_VN_TUNNEL:
+        case FM_NEXTHOP_TYPE_LOGICAL_PORT:
+            if (wideGroup)
+            {
+                return FM_ERR_MIXING_NARROW_AND_WIDE_NEXTHOPS;
+            }
+            break;
+
+        case FM_NEXTHOP_TYPE_RAW_WIDE:
+            if (!wideGroup)
+            {
+                return FM_ERR_MIXING_NARROW_AND_WIDE_NEXTHOPS;
+            }
+            break;
+
+        case FM_NEXTHOP_TYPE_MPLS_ARP:
+            if (!wideGroup)
+            {
+                return FM_ERR_MIXING_NARROW_AND_WIDE_NEXTHOPS;
+            }
+
+            if (!group->mplsGroup)
+            {
+                return FM_ERR_INVALID_ARGUMENT;
+            }
+            break;
+
+        default:
+            return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    return FM_OK;
+
+}   /* end CheckFixedNextHopWidth */
+
+
+
+
+/*****************************************************************************/
+/** AllocResilientStateInt
+ * \ingroup intNextHopEcmp
+ *
+ * \desc            Allocates the member and bucket ownership tables of a
+ *                  resilient ECMP group. All buckets start unowned.
+ *
+ * \param[in]       pEcmpGroup points to the fixed-size ECMP group.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory cannot be allocated.
+ *
+ *****************************************************************************/
+static fm_status AllocResilientStateInt(fm_intEcmpGroup *pEcmpGroup)
+{
+    fm_int numBuckets;
+    fm_int bucket;
+
+    numBuckets = pEcmpGroup->numFixedEntries;
+
+    pEcmpGroup->resilientMembers =
+        fmAlloc(sizeof(fm_ecmpNextHop) * numBuckets);
+    pEcmpGroup->resilientMemberBuckets =
+        fmAlloc(sizeof(fm_int) * numBuckets);
+    pEcmpGroup->resilientBucketOwner =
+        fmAlloc(sizeof(fm_int) * numBuckets);
+
+    if ( pEcmpGroup->resilientMembers == NULL       ||
+         pEcmpGroup->resilientMemberBuckets == NULL ||
+         pEcmpGroup->resilientBucketOwner == NULL )
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    for (bucket = 0 ; bucket < numBuckets ; bucket++)
+    {
+        pEcmpGroup->resilientMemberBuckets[bucket] = 0;
+        pEcmpGroup->resilientBucketOwner[bucket]   = -1;
+    }
+
+    pEcmpGroup->resilient            = TRUE;
+    pEcmpGroup->resilientMemberCount = 0;
+
+    return FM_OK;
+
+}   /* end AllocResilientStateInt */
+
+
+
+
+/*****************************************************************************/
+/** FindResilientMember
+ * \ingroup intNextHopEcmp
+ *
+ * \desc            Finds a member of a resilient ECMP group.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       group points to the resilient ECMP group.
+ *
+ * \param[in]       member points to the member to look for.
+ *
+ * \return          the index of the member in the group's member table,
+ *                  or -1 if it is not a member of the group.
+ *
+ *****************************************************************************/
+static fm_int FindResilientMember(fm_int           sw,
+                                  fm_intEcmpGroup *group,
+                                  fm_ecmpNextHop  *member)
+{
+    fm_intNextHop hop1;
+    fm_intNextHop hop2;
+    fm_int        index;
+
+    FM_CLEAR(hop1);
+    hop1.sw        = sw;
+    hop1.ecmpGroup = group;
+    hop1.nextHop   = *member;
+
+    FM_CLEAR(hop2);
+    hop2.sw        = sw;
+    hop2.ecmpGroup = group;
+
+    for (index = 0 ; index < group->resilientMemberCount ; index++)
+    {
+        hop2.nextHop = group->resilientMembers[index];
+
+        if (fmCompareInternalNextHops(&hop1, &hop2) == 0)
+        {
+            return index;
+        }
+    }
+
+    return -1;
+
+}   /* end FindResilientMember */
+
+
+
+
+/*****************************************************************************/
+/** SetResilientBucketOwner
+ * \ingroup intNextHopEcmp
+ *
+ * \desc            Assigns a bucket of a resilient ECMP group to a member
+ *                  and rewrites the bucket's next-hop in place.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       group points to the resilient ECMP group.
+ *
+ * \param[in]       bucket is the bucket to assign.
+ *
+ * \param[in]       owner is the index of the new owner in the group's
+ *                  member table, or -1 to make the bucket drop traffic.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status SetResilientBucketOwner(fm_int           sw,
+                                         fm_intEcmpGroup *group,
+                                         fm_int           bucket,
+                                         fm_int           owner)
+{
+    fm_status       status;
+    fm_switch *     switchPtr;
+    fm_ecmpNextHop  dropHop;
+    fm_ecmpNextHop *nextHop;
+    fm_int          oldOwner;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (owner >= 0)
+    {
+        nextHop = &group->resilientMembers[owner];
+    }
+    else
+    {
+        FM_CLEAR(dropHop);
+        dropHop.type = FM_NEXTHOP_TYPE_DROP;
+        nextHop      = &dropHop;
+    }
+
+    FM_API_CALL_FAMILY(status,
+                       switchPtr->SetECMPGroupNextHops,
+                       sw,
+                       group,
+                       bucket,
+                       1,
+                       nextHop);
+
+    if (status == FM_OK)
+    {
+        oldOwner = group->resilientBucketOwner[bucket];
+
+        if (oldOwner >= 0)
+        {
+            group->resilientMemberBuckets[oldOwner]--;
+        }
+
+        if (owner >= 0)
+        {
+            group->resilientMemberBuckets[owner]++;
+        }
+
+        group->resilientBucketOwner[bucket] = owner;
+    }
+
+    return status;
+
+}   /* end SetResilientBucketOwner */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -3021,6 +3290,7 @@ fm_status fmCreateECMPGroupInternal(fm_int                sw,
     fm_bool            multicast;
     fm_bool            wideNextHops;
     fm_bool            mplsGroup;
+    fm_bool            resilient;
     fm_int             numFixedEntries;
     fm_int             maxNextHops;
     fm_uint16          lbsVlan;
@@ -3040,7 +3310,8 @@ fm_status fmCreateECMPGroupInternal(fm_int                sw,
 
     /* argument validation */
     if (groupId == NULL ||
-        ( (info != NULL) && (info->numFixedEntries < 0) ) )
+        ( (info != NULL) && (info->numFixedEntries < 0) ) ||
+        ( (info != NULL) && info->isResilient && (info->numFixedEntries == 0) ) )
     {
         err = FM_ERR_INVALID_ARGUMENT;
     }
@@ -3059,6 +3330,7 @@ fm_status fmCreateECMPGroupInternal(fm_int                sw,
             numFixedEntries = info->numFixedEntries;
             lbsVlan         = info->lbsVlan;
             mplsGroup       = info->isMpls;
+            resilient       = info->isResilient;
             maxNextHops     = numFixedEntries > 0 ? numFixedEntries : switchPtr->maxEcmpGroupSize;
         }
         else
@@ -3069,6 +3341,7 @@ fm_status fmCreateECMPGroupInternal(fm_int                sw,
             numFixedEntries = 0;
             lbsVlan         = 0;
             mplsGroup       = FALSE;
+            resilient       = FALSE;
         }
 
         /* assume mcastGroup is NULL */
@@ -3110,6 +3383,10 @@ fm_status fmCreateECMPGroupInternal(fm_int                sw,
                                       pEcmpGroup);
 
             }
+            if (err == FM_OK && resilient)
+            {
+                err = AllocResilientStateInt(pEcmpGroup);
+            }
             if (err == FM_OK)
             {
                 fmCustomTreeInit(&pEcmpGroup->routeTree, fmCompareIntRoutes);
@@ -4824,7 +5101,6 @@ fm_status fmSetECMPGroupNextHopsInternal(fm_int          sw,
     fm_switch *        switchPtr;
     fm_intEcmpGroup *  group;
     fm_bool            lockTaken;
-    fm_bool            wideGroup;
     fm_int             i;
 
 
@@ -4852,7 +5128,8 @@ fm_status fmSetECMPGroupNextHopsInternal(fm_int          sw,
     lockTaken = TRUE;
     group     = switchPtr->ecmpGroups[groupId];
 
-    if (!group->fixedSize)
+    /* Resilient groups manage their buckets through their members. */
+    if (!group->fixedSize || group->resilient)
     {
         status = FM_ERR_UNSUPPORTED;
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
@@ -4876,54 +5153,12 @@ fm_status fmSetECMPGroupNextHopsInternal(fm_int          sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
     }
 
-    wideGroup = group->wideGroup;
 
     /* Verify that all next-hops are the same width. */
     for (i = 0 ; i < numNextHops ; i++)
     {
-        switch (nextHopList[i].type)
-        {
-            case FM_NEXTHOP_TYPE_ARP:
-            case FM_NEXTHOP_TYPE_RAW_NARROW:
-            case FM_NEXTHOP_TYPE_DROP:
-            case FM_NEXTHOP_TYPE_DMAC:
-            case FM_NEXTHOP_TYPE_TUNNEL:
-            case FM_NEXTHOP_TYPE_VN_TUNNEL:
-            case FM_NEXTHOP_TYPE_LOGICAL_PORT:
-                if (wideGroup)
-                {
-                    status = FM_ERR_MIXING_NARROW_AND_WIDE_NEXTHOPS;
-                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
-                }
-                break;
-
-            case FM_NEXTHOP_TYPE_RAW_WIDE:
-                if (!wideGroup)
-                {
-                    status = FM_ERR_MIXING_NARROW_AND_WIDE_NEXTHOPS;
-                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
-                }
-                break;
-
-            case FM_NEXTHOP_TYPE_MPLS_ARP:
-                if (!wideGroup)
-                {
-                    status = FM_ERR_MIXING_NARROW_AND_WIDE_NEXTHOPS;
-                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
-                }
-
-                if (!group->mplsGroup)
-                {
-                    status = FM_ERR_INVALID_ARGUMENT;
-                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
-                }
-                break;
-
-            default:
-                status = FM_ERR_INVALID_ARGUMENT;
-                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
-                break;
-        }
+        status = CheckFixedNextHopWidth(group, &nextHopList[i]);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
     }
 
     /* Change the next-hop information in the hardware. */
@@ -5025,69 +5260,492 @@ fm_status fmSetECMPGroupNextHops(fm_int          sw,
 
 
 /*****************************************************************************/
-/** fmSetECMPGroupRawNextHop
+/** fmAddResilientECMPGroupMembersInternal
  * \ingroup intNextHopEcmp
  *
- * \chips           FM6000
+ * \chips           FM10000
  *
- * \desc            Stores a raw next-hop into an ECMP group.
+ * \desc            Adds one or more members to a resilient ECMP group.
+ *                  Each new member takes an equal share of the buckets
+ *                  from the members that own more than their share; the
+ *                  other buckets keep their next-hop.
  *
  * \param[in]       sw is the switch on which to operate.
  *
- * \param[in]       groupId is the ECMP group ID from a prior call to
- *                  ''fmCreateECMPGroup''.
+ * \param[in]       groupId is the ECMP group ID.
  *
- * \param[in]       index is the index of the next-hop in the ECMP group which
- *                  is to be updated.
- * 
- * \param[in]       nextHopType is the type of raw next hop entry, see
- *                  ''fm_rawNextHopType'' for more details
- *                  
- * \param[in]       value0 is the first 64-bit value in the raw next-hop.
+ * \param[in]       numMembers is the number of members in memberList.
  *
- * \param[in]       value1 is the second 64-bit value in the raw next-hop (for
- *                  raw wide next hop entry only).
+ * \param[in]       memberList points to an array of members to be added.
  *
  * \return          FM_OK if successful.
- * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
- * \return          FM_ERR_INVALID_ARGUMENT if groupId is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_UNSUPPORTED if the group is not resilient.
+ * \return          FM_ERR_ALREADY_EXISTS if a member is already in the group.
+ * \return          FM_ERR_ECMP_GROUP_IS_FULL if the group would have more
+ *                  members than buckets.
+ * \return          FM_ERR_MIXING_NARROW_AND_WIDE_NEXTHOPS if a member's
+ *                  width does not match the group.
  *
  *****************************************************************************/
-fm_status fmSetECMPGroupRawNextHop(fm_int               sw,
-                                   fm_int               groupId,
-                                   fm_int               index,
-                                   fm_ecmpNextHopType   nextHopType,
-                                   fm_uint64            value0,
-                                   fm_uint64            value1)
+fm_status fmAddResilientECMPGroupMembersInternal(fm_int          sw,
+                                                 fm_int          groupId,
+                                                 fm_int          numMembers,
+                                                 fm_ecmpNextHop *memberList)
 {
-    fm_status      status;
-    fm_ecmpNextHop nextHop;
+    fm_status        status;
+    fm_switch *      switchPtr;
+    fm_intEcmpGroup *group;
+    fm_bool          lockTaken;
+    fm_int           index;
+    fm_int           newMember;
+    fm_int           owner;
+    fm_int           bucket;
+    fm_int           share;
 
+    FM_LOG_ENTRY( FM_LOG_CAT_ROUTING,
+                  "sw = %d, groupId = %d, numMembers = %d, memberList = %p\n",
+                  sw,
+                  groupId,
+                  numMembers,
+                  (void *) memberList );
 
-    FM_LOG_ENTRY_API(FM_LOG_CAT_ROUTING,
-                     "sw = %d, groupId = %d, index = %d, nextHopType = %d, "
-                     "value0 = %" FM_FORMAT_64 "X, "
-                     "value1 = %" FM_FORMAT_64 "X\n",
-                     sw,
-                     groupId,
-                     index,
-                     nextHopType,
-                     value0,
-                     value1);
+    switchPtr = GET_SWITCH_PTR(sw);
+    lockTaken = FALSE;
 
-    VALIDATE_AND_PROTECT_SWITCH(sw);
+    if ( (groupId < 0) || (groupId >= switchPtr->maxArpEntries) ||
+         (numMembers <= 0) || (memberList == NULL) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ROUTING, FM_ERR_INVALID_ARGUMENT);
+    }
 
-    FM_CLEAR( nextHop );
+    /* gain exclusive access to routing tables */
+    status = fmCaptureWriteLock(&switchPtr->routingLock, FM_WAIT_FOREVER);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
 
-    nextHop.type = nextHopType;
-    
-    switch (nextHopType)
-    {
-        case FM_NEXTHOP_TYPE_RAW_NARROW:
-            nextHop.data.rawNarrow.value = value0;
-            break;
+    lockTaken = TRUE;
+    group     = switchPtr->ecmpGroups[groupId];
 
-        case FM_NEXTHOP_TYPE_RAW_WIDE:
+    if (group == NULL)
+    {
+        status = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
+    }
+
+    if (!group->resilient)
+    {
+        status = FM_ERR_UNSUPPORTED;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
+    }
+
+    if (group->resilientMemberCount + numMembers > group->numFixedEntries)
+    {
+        status = FM_ERR_ECMP_GROUP_IS_FULL;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
+    }
+
+    for (index = 0 ; index < numMembers ; index++)
+    {
+        status = CheckFixedNextHopWidth(group, &memberList[index]);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
+
+        if (memberList[index].type == FM_NEXTHOP_TYPE_DROP)
+        {
+            status = FM_ERR_INVALID_ARGUMENT;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
+        }
+
+        if (FindResilientMember(sw, group, &memberList[index]) >= 0)
+        {
+            status = FM_ERR_ALREADY_EXISTS;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
+        }
+    }
+
+    for (index = 0 ; index < numMembers ; index++)
+    {
+        newMember = group->resilientMemberCount++;
+        group->resilientMembers[newMember]       = memberList[index];
+        group->resilientMemberBuckets[newMember] = 0;
+
+        /* Take unowned buckets first, then buckets from the members above
+         * the new fair share. Every existing member keeps at least that
+         * share, and the members above it have enough buckets to give. */
+        share = group->numFixedEntries / group->resilientMemberCount;
+
+        for (bucket = 0 ;
+             bucket < group->numFixedEntries &&
+             group->resilientMemberBuckets[newMember] < share ;
+             bucket++)
+        {
+            owner = group->resilientBucketOwner[bucket];
+
+            if ( (owner < 0) ||
+                 ( (owner != newMember) &&
+                   (group->resilientMemberBuckets[owner] > share) ) )
+            {
+                status = SetResilientBucketOwner(sw, group, bucket, newMember);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
+            }
+        }
+    }
+
+ABORT:
+
+    if (lockTaken)
+    {
+        fmReleaseWriteLock(&switchPtr->routingLock);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_ROUTING, status);
+
+}   /* end fmAddResilientECMPGroupMembersInternal */
+
+
+
+
+/*****************************************************************************/
+/** fmDeleteResilientECMPGroupMembersInternal
+ * \ingroup intNextHopEcmp
+ *
+ * \chips           FM10000
+ *
+ * \desc            Deletes one or more members from a resilient ECMP group.
+ *                  Only the buckets owned by the deleted members are
+ *                  rewritten, each one to the least loaded remaining
+ *                  member. When the last member is deleted, its buckets
+ *                  drop traffic.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       groupId is the ECMP group ID.
+ *
+ * \param[in]       numMembers is the number of members in memberList.
+ *
+ * \param[in]       memberList points to an array of members to be deleted.
+ *                  Members that are not in the group are ignored.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_UNSUPPORTED if the group is not resilient.
+ *
+ *****************************************************************************/
+fm_status fmDeleteResilientECMPGroupMembersInternal(fm_int          sw,
+                                                    fm_int          groupId,
+                                                    fm_int          numMembers,
+                                                    fm_ecmpNextHop *memberList)
+{
+    fm_status        status;
+    fm_switch *      switchPtr;
+    fm_intEcmpGroup *group;
+    fm_bool          lockTaken;
+    fm_int           index;
+    fm_int           member;
+    fm_int           lastMember;
+    fm_int           newOwner;
+    fm_int           candidate;
+    fm_int           bucket;
+
+    FM_LOG_ENTRY( FM_LOG_CAT_ROUTING,
+                  "sw = %d, groupId = %d, numMembers = %d, memberList = %p\n",
+                  sw,
+                  groupId,
+                  numMembers,
+                  (void *) memberList );
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    lockTaken = FALSE;
+
+    if ( (groupId < 0) || (groupId >= switchPtr->maxArpEntries) ||
+         (numMembers <= 0) || (memberList == NULL) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ROUTING, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    /* gain exclusive access to routing tables */
+    status = fmCaptureWriteLock(&switchPtr->routingLock, FM_WAIT_FOREVER);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
+
+    lockTaken = TRUE;
+    group     = switchPtr->ecmpGroups[groupId];
+
+    if (group == NULL)
+    {
+        status = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
+    }
+
+    if (!group->resilient)
+    {
+        status = FM_ERR_UNSUPPORTED;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
+    }
+
+    for (index = 0 ; index < numMembers ; index++)
+    {
+        member = FindResilientMember(sw, group, &memberList[index]);
+
+        if (member < 0)
+        {
+            continue;
+        }
+
+        /* Hand the member's buckets over to the remaining members. */
+        for (bucket = 0 ;
+             bucket < group->numFixedEntries &&
+             group->resilientMemberBuckets[member] > 0 ;
+             bucket++)
+        {
+            if (group->resilientBucketOwner[bucket] != member)
+            {
+                continue;
+            }
+
+            newOwner = -1;
+
+            for (candidate = 0 ;
+                 candidate < group->resilientMemberCount ;
+                 candidate++)
+            {
+                if ( (candidate != member) &&
+                     ( (newOwner < 0) ||
+                       (group->resilientMemberBuckets[candidate] <
+                        group->resilientMemberBuckets[newOwner]) ) )
+                {
+                    newOwner = candidate;
+                }
+            }
+
+            status = SetResilientBucketOwner(sw, group, bucket, newOwner);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, status);
+        }
+
+        /* Fill the hole in the member table with the last member. */
+        lastMember = --group->resilientMemberCount;
+
+        if (member != lastMember)
+        {
+            group->resilientMembers[member] =
+                group->resilientMembers[lastMember];
+            group->resilientMemberBuckets[member] =
+                group->resilientMemberBuckets[lastMember];
+
+            for (bucket = 0 ; bucket < group->numFixedEntries ; bucket++)
+            {
+                if (group->resilientBucketOwner[bucket] == lastMember)
+                {
+                    group->resilientBucketOwner[bucket] = member;
+                }
+            }
+        }
+
+        group->resilientMemberBuckets[lastMember] = 0;
+    }
+
+ABORT:
+
+    if (lockTaken)
+    {
+        fmReleaseWriteLock(&switchPtr->routingLock);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_ROUTING, status);
+
+}   /* end fmDeleteResilientECMPGroupMembersInternal */
+
+
+
+
+/*****************************************************************************/
+/** fmAddResilientECMPGroupMembers
+ * \ingroup routerEcmp
+ *
+ * \chips           FM10000
+ *
+ * \desc            Adds one or more members to a resilient ECMP group
+ *                  (see the isResilient field of ''fm_ecmpGroupInfo'').
+ *                  Each new member takes an equal share of the group's
+ *                  buckets from the members that own more than their
+ *                  share. Buckets that do not change owner are not
+ *                  rewritten, so the flows hashed to them keep their
+ *                  next-hop.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       groupId is the ECMP group ID from a prior call to
+ *                  ''fmCreateECMPGroupV2''.
+ *
+ * \param[in]       numMembers is the number of members in memberList.
+ *
+ * \param[in]       memberList points to an array of members to be added.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_UNSUPPORTED if the group is not resilient.
+ * \return          FM_ERR_ALREADY_EXISTS if a member is already in the group.
+ * \return          FM_ERR_ECMP_GROUP_IS_FULL if the group would have more
+ *                  members than buckets.
+ * \return          FM_ERR_MIXING_NARROW_AND_WIDE_NEXTHOPS if a member's
+ *                  width does not match the group.
+ *
+ *****************************************************************************/
+fm_status fmAddResilientECMPGroupMembers(fm_int          sw,
+                                         fm_int          groupId,
+                                         fm_int          numMembers,
+                                         fm_ecmpNextHop *memberList)
+{
+    fm_status status;
+
+    FM_LOG_ENTRY_API( FM_LOG_CAT_ROUTING,
+                      "sw = %d, groupId = %d, numMembers = %d, "
+                      "memberList = %p\n",
+                      sw,
+                      groupId,
+                      numMembers,
+                      (void *) memberList );
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    status = fmAddResilientECMPGroupMembersInternal(sw,
+                                                    groupId,
+                                                    numMembers,
+                                                    memberList);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ROUTING, status);
+
+}   /* end fmAddResilientECMPGroupMembers */
+
+
+
+
+/*****************************************************************************/
+/** fmDeleteResilientECMPGroupMembers
+ * \ingroup routerEcmp
+ *
+ * \chips           FM10000
+ *
+ * \desc            Deletes one or more members from a resilient ECMP group
+ *                  (see the isResilient field of ''fm_ecmpGroupInfo'').
+ *                  Only the buckets owned by the deleted members are
+ *                  rewritten, in place, each one to the least loaded
+ *                  remaining member. Flows hashed to the other members
+ *                  are not disturbed. When the last member is deleted,
+ *                  the group drops traffic.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       groupId is the ECMP group ID from a prior call to
+ *                  ''fmCreateECMPGroupV2''.
+ *
+ * \param[in]       numMembers is the number of members in memberList.
+ *
+ * \param[in]       memberList points to an array of members to be deleted.
+ *                  Members that are not in the group are ignored.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_UNSUPPORTED if the group is not resilient.
+ *
+ *****************************************************************************/
+fm_status fmDeleteResilientECMPGroupMembers(fm_int          sw,
+                                            fm_int          groupId,
+                                            fm_int          numMembers,
+                                            fm_ecmpNextHop *memberList)
+{
+    fm_status status;
+
+    FM_LOG_ENTRY_API( FM_LOG_CAT_ROUTING,
+                      "sw = %d, groupId = %d, numMembers = %d, "
+                      "memberList = %p\n",
+                      sw,
+                      groupId,
+                      numMembers,
+                      (void *) memberList );
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    status = fmDeleteResilientECMPGroupMembersInternal(sw,
+                                                       groupId,
+                                                       numMembers,
+                                                       memberList);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ROUTING, status);
+
+}   /* end fmDeleteResilientECMPGroupMembers */
+
+
+
+
+/*****************************************************************************/
+/** fmSetECMPGroupRawNextHop
+ * \ingroup intNextHopEcmp
+ *
+ * \chips           FM6000
+ *
+ * \desc            Stores a raw next-hop into an ECMP group.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       groupId is the ECMP group ID from a prior call to
+ *                  ''fmCreateECMPGroup''.
+ *
+ * \param[in]       index is the index of the next-hop in the ECMP group which
+ *                  is to be updated.
+ * 
+ * \param[in]       nextHopType is the type of raw next hop entry, see
+ *                  ''fm_rawNextHopType'' for more details
+ *                  
+ * \param[in]       value0 is the first 64-bit value in the raw next-hop.
+ *
+ * \param[in]       value1 is the second 64-bit value in the raw next-hop (for
+ *                  raw wide next hop entry only).
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if groupId is invalid.
+ *
+ *****************************************************************************/
+fm_status fmSetECMPGroupRawNextHop(fm_int               sw,
+                                   fm_int               groupId,
+                                   fm_int               index,
+                                   fm_ecmpNextHopType   nextHopType,
+                                   fm_uint64            value0,
+                                   fm_uint64            value1)
+{
+    fm_status      status;
+    fm_ecmpNextHop nextHop;
+
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ROUTING,
+                     "sw = %d, groupId = %d, index = %d, nextHopType = %d, "
+                     "value0 = %" FM_FORMAT_64 "X, "
+                     "value1 = %" FM_FORMAT_64 "X\n",
+                     sw,
+                     groupId,
+                     index,
+                     nextHopType,
+                     value0,
+                     value1);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    FM_CLEAR( nextHop );
+
+    nextHop.type = nextHopType;
+    
+    switch (nextHopType)
+    {
+        case FM_NEXTHOP_TYPE_RAW_NARROW:
+            nextHop.data.rawNarrow.value = value0;
+            break;
+
+        case FM_NEXTHOP_TYPE_RAW_WIDE:
             nextHop.data.rawWide.values[0] = value0;
             nextHop.data.rawWide.values[1] = value1;
             break;
@@ -6918,6 +7576,99 @@ fm_status fmDeleteARPEntry(fm_int       sw,
 
 
 
+/*****************************************************************************/
+/** UpdateArpEntryDMACInt
+ * \ingroup intNextHopArp
+ *
+ * \desc            Writes a destination MAC address to an existing ARP
+ *                  entry and updates the next-hops that use it. Called with
+ *                  the routing lock taken.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       pArp points the ARP entry to modify. All fields of the
+ *                  ''fm_arpEntry'' structure except the macAddr field will
+ *                  be used to identify the existing ARP entry.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if the ARP entry does not exist.
+ *
+ *****************************************************************************/
+static fm_status UpdateArpEntryDMACInt(fm_int       sw,
+                                       fm_arpEntry *pArp)
+{
+    fm_switch              *switchPtr;
+    fm_status               err;
+    fm_intIpInterfaceEntry *pIfEntry;
+    fm_intArpEntry         *pArpEntry;
+    fm_customTreeIterator   iter;
+    fm_intNextHop          *pHopKey;
+    fm_intNextHop          *pNextHop;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    err       = FM_OK;
+
+    /* get the vlan */
+    if (pArp->interface >= 0)
+    {
+        err = fmGetInterface(sw, pArp->interface, &pIfEntry);
+
+        if (err == FM_OK && pIfEntry != NULL)
+        {
+            pArp->vlan = pIfEntry->vlan;
+        }
+    }
+    if (err == FM_OK)
+    {
+        /* try to find the entry in the table */
+        err = FindArpEntryExt(sw, pArp, &pArpEntry);
+    }
+
+    if (err == FM_OK)
+    {
+        /* update the destination mac address in the table entry */
+        FM_MEMCPY_S( &pArpEntry->arp.macAddr,
+                     sizeof(pArpEntry->arp.macAddr),
+                     &pArp->macAddr,
+                     sizeof(pArp->macAddr) );
+
+        /* Find and update all affected next-hops */
+        fmCustomTreeIterInit(&iter, &pArpEntry->nextHopTree);
+
+        while (err == FM_OK)
+        {
+            err = fmCustomTreeIterNext( &iter,
+                                       (void **) &pHopKey,
+                                       (void **) &pNextHop);
+
+            if (err == FM_OK)
+            {
+                FM_API_CALL_FAMILY(err,
+                                   switchPtr->UpdateNextHop,
+                                   sw,
+                                   pNextHop);
+            }
+        }
+        /* clear the error if == FM_ERR_NO_MORE, it is a normal loop ending condition */
+        err = (err == FM_ERR_NO_MORE) ? FM_OK : err;
+    }
+    if (err == FM_OK)
+    {
+        /* If the switch requires extra processing, call the switch-specific
+         * function now. */
+        if (switchPtr->UpdateArpEntryDestMac != NULL)
+        {
+            err = switchPtr->UpdateArpEntryDestMac(sw, pArp);
+        }
+    }
+
+    return err;
+
+}   /* end UpdateArpEntryDMACInt */
+
+
+
+
 /*****************************************************************************/
 /** fmUpdateARPEntryDMAC
  * \ingroup routerArp
@@ -6929,6 +7680,9 @@ fm_status fmDeleteARPEntry(fm_int       sw,
  *                  when the actual MAC address has been learned for an IP
  *                  address that had been previously routed to the CPU.
  *
+ * \note            To update many ARP entries at once, for instance after
+ *                  a link failover, see ''fmUpdateARPEntryDMACList''.
+ *
  * \param[in]       sw is the switch on which to operate.
  *
  * \param[in]       pArp points the ARP entry to modify. All fields of the
@@ -6945,11 +7699,6 @@ fm_status fmUpdateARPEntryDMAC(fm_int       sw,
 {
     fm_switch              *switchPtr;
     fm_status               err;
-    fm_intIpInterfaceEntry *pIfEntry;
-    fm_intArpEntry         *pArpEntry;
-    fm_customTreeIterator   iter;
-    fm_intNextHop          *pHopKey;
-    fm_intNextHop          *pNextHop;
 
     FM_LOG_ENTRY_API(FM_LOG_CAT_ROUTING,
                      "sw=%d, pArp=%p\n",
@@ -6974,68 +7723,135 @@ fm_status fmUpdateARPEntryDMAC(fm_int       sw,
 
         if (err == FM_OK)
         {
-            /* get the vlan */
-            if (pArp->interface >= 0)
-            {
-                err = fmGetInterface(sw, pArp->interface, &pIfEntry);
+            err = UpdateArpEntryDMACInt(sw, pArp);
+        }
+        fmReleaseWriteLock(&switchPtr->routingLock);
+    }
 
-                if (err == FM_OK && pIfEntry != NULL)
-                {
-                    pArp->vlan = pIfEntry->vlan;
-                }
-            }
-            if (err == FM_OK)
-            {
-                /* try to find the entry in the table */
-                err = FindArpEntryExt(sw, pArp, &pArpEntry);
-            }
+    UNPROTECT_SWITCH(sw);
 
-            if (err == FM_OK)
-            {
-                /* update the destination mac address in the table entry */
-                FM_MEMCPY_S( &pArpEntry->arp.macAddr,
-                             sizeof(pArpEntry->arp.macAddr),
-                             &pArp->macAddr,
-                             sizeof(pArp->macAddr) );
+    FM_LOG_EXIT_API(FM_LOG_CAT_ROUTING, err);
 
-                /* Find and update all affected next-hops */
-                fmCustomTreeIterInit(&iter, &pArpEntry->nextHopTree);
+}   /* end fmUpdateARPEntryDMAC */
 
-                while (err == FM_OK)
+
+
+
+/*****************************************************************************/
+/** fmUpdateARPEntryDMACList
+ * \ingroup routerArp
+ *
+ * \chips           FM10000
+ *
+ * \desc            Writes new destination MAC addresses to a list of
+ *                  existing ARP entries in a single operation, typically
+ *                  when many neighbors move at once after a link failover.
+ *                  The routing table is locked once for the whole list,
+ *                  and the next-hop table writes of all the entries are
+ *                  queued in a register write batch (see
+ *                  ''fmRegBatchBegin''), so that each run of consecutive
+ *                  next-hop entries is written once, with a single
+ *                  multi-word write. Each entry is otherwise handled as by
+ *                  ''fmUpdateARPEntryDMAC''; a failing entry does not
+ *                  prevent the others from being updated.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numEntries is the number of ARP entries in the list.
+ *
+ * \param[in]       arpList points to an array of numEntries ARP entries.
+ *                  All fields of each entry except the macAddr field are
+ *                  used to identify the existing ARP entry, and macAddr
+ *                  holds its new destination MAC address.
+ *
+ * \param[out]      results points to a caller-allocated array of numEntries
+ *                  entries that receives the status of each ARP entry. May
+ *                  be NULL.
+ *
+ * \return          FM_OK if every ARP entry was updated successfully.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if arpList is NULL or numEntries
+ *                  is not positive.
+ * \return          FM_ERR_UNSUPPORTED if routing is not available on the
+ *                  switch.
+ * \return          the status of the first ARP entry that failed, in list
+ *                  order, otherwise. See ''fmUpdateARPEntryDMAC''.
+ *
+ *****************************************************************************/
+fm_status fmUpdateARPEntryDMACList(fm_int       sw,
+                                   fm_int       numEntries,
+                                   fm_arpEntry *arpList,
+                                   fm_status *  results)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+    fm_status  entryErr;
+    fm_status  batchErr;
+    fm_int     i;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ROUTING,
+                     "sw=%d, numEntries=%d, arpList=%p, results=%p\n",
+                     sw,
+                     numEntries,
+                     (void *) arpList,
+                     (void *) results);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if ( (arpList == NULL) || (numEntries <= 0) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+    }
+    else if (switchPtr->maxArpEntries <= 0)
+    {
+        err = FM_ERR_UNSUPPORTED;
+    }
+    else
+    {
+        err = fmCaptureWriteLock(&switchPtr->routingLock, FM_WAIT_FOREVER);
+
+        if (err == FM_OK)
+        {
+            /* If another thread has a batch open, the writes are simply
+             * issued one by one. */
+            batchErr = fmRegBatchBegin(sw);
+
+            for (i = 0 ; i < numEntries ; i++)
+            {
+                entryErr = UpdateArpEntryDMACInt(sw, &arpList[i]);
+
+                if (results != NULL)
                 {
-                    err = fmCustomTreeIterNext( &iter,
-                                               (void **) &pHopKey,
-                                               (void **) &pNextHop);
+                    results[i] = entryErr;
+                }
 
-                    if (err == FM_OK)
-                    {
-                        FM_API_CALL_FAMILY(err,
-                                           switchPtr->UpdateNextHop,
-                                           sw,
-                                           pNextHop);
-                    }
+                if (err == FM_OK)
+                {
+                    err = entryErr;
                 }
-                /* clear the error if == FM_ERR_NO_MORE, it is a normal loop ending condition */
-                err = (err == FM_ERR_NO_MORE) ? FM_OK : err;
             }
-            if (err == FM_OK)
+
+            if (batchErr == FM_OK)
             {
-                /* If the switch requires extra processing, call the switch-specific
-                 * function now. */
-                if (switchPtr->UpdateArpEntryDestMac != NULL)
+                batchErr = fmRegBatchCommit(sw);
+
+                if (err == FM_OK)
                 {
-                    err = switchPtr->UpdateArpEntryDestMac(sw, pArp);
+                    err = batchErr;
                 }
             }
+
+            fmReleaseWriteLock(&switchPtr->routingLock);
         }
-        fmReleaseWriteLock(&switchPtr->routingLock);
     }
 
     UNPROTECT_SWITCH(sw);
 
     FM_LOG_EXIT_API(FM_LOG_CAT_ROUTING, err);
 
-}   /* end fmUpdateARPEntryDMAC */
+}   /* end fmUpdateARPEntryDMACList */
 
 
 
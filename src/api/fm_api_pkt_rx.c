@@ -37,6 +37,34 @@
  * Macros, Constants & Types
  *****************************************************************************/
 
+#define FM_RX_FILTER_MATCH_ALL      (FM_RX_FILTER_MATCH_ETHERTYPE |            \
+                                     FM_RX_FILTER_MATCH_DMAC      |            \
+                                     FM_RX_FILTER_MATCH_SMAC      |            \
+                                     FM_RX_FILTER_MATCH_VLAN      |            \
+                                     FM_RX_FILTER_MATCH_TRAP_CODE |            \
+                                     FM_RX_FILTER_MATCH_SRC_PORT)
+
+/* Fields that need the Ethernet header of the frame. */
+#define FM_RX_FILTER_MATCH_HEADER   (FM_RX_FILTER_MATCH_ETHERTYPE |            \
+                                     FM_RX_FILTER_MATCH_DMAC      |            \
+                                     FM_RX_FILTER_MATCH_SMAC)
+
+#define FM_RX_FILTER_VLAN_TPID      0x8100
+
+/* Fields of a received frame compared to the receive packet filters. */
+typedef struct
+{
+    /* FALSE if the frame is too short for the Ethernet header fields. */
+    fm_bool    hasHeader;
+    fm_macaddr dmac;
+    fm_macaddr smac;
+    fm_uint16  etherType;
+    fm_int     vlan;
+    fm_int     trapCode;
+    fm_int     srcPort;
+
+} rxFilterKey;
+
 
 /*****************************************************************************
  * Global Variables
@@ -58,6 +86,136 @@
  *****************************************************************************/
 
 
+
+
+/*****************************************************************************/
+/** MatchRxPacketFilter
+ * \ingroup intApi
+ *
+ * \desc            Determines whether a received frame matches a receive
+ *                  packet filter.
+ *
+ * \param[in]       filter points to the filter.
+ *
+ * \param[in]       key points to the fields of the frame.
+ *
+ * \return          TRUE if the frame matches.
+ *
+ *****************************************************************************/
+static fm_bool MatchRxPacketFilter(const fm_rxPacketFilter *filter,
+                                   const rxFilterKey *      key)
+{
+    fm_uint32 fields = filter->matchFields;
+
+    if ( (fields & FM_RX_FILTER_MATCH_HEADER) && !key->hasHeader )
+    {
+        return FALSE;
+    }
+
+    if ( (fields & FM_RX_FILTER_MATCH_ETHERTYPE) &&
+         (key->etherType != filter->etherType) )
+    {
+        return FALSE;
+    }
+
+    if ( (fields & FM_RX_FILTER_MATCH_DMAC) &&
+         ( (key->dmac & filter->dmacMask) !=
+           (filter->dmac & filter->dmacMask) ) )
+    {
+        return FALSE;
+    }
+
+    if ( (fields & FM_RX_FILTER_MATCH_SMAC) &&
+         ( (key->smac & filter->smacMask) !=
+           (filter->smac & filter->smacMask) ) )
+    {
+        return FALSE;
+    }
+
+    if ( (fields & FM_RX_FILTER_MATCH_VLAN) &&
+         (key->vlan != filter->vlan) )
+    {
+        return FALSE;
+    }
+
+    if ( (fields & FM_RX_FILTER_MATCH_TRAP_CODE) &&
+         (key->trapCode != filter->trapCode) )
+    {
+        return FALSE;
+    }
+
+    if ( (fields & FM_RX_FILTER_MATCH_SRC_PORT) &&
+         (key->srcPort != filter->srcPort) )
+    {
+        return FALSE;
+    }
+
+    return TRUE;
+
+}   /* end MatchRxPacketFilter */
+
+
+
+
+/*****************************************************************************/
+/** WriteRxPacketFilter
+ * \ingroup intApi
+ *
+ * \desc            Rewrites a receive packet filter so that the packet
+ *                  receive task, which reads it without a lock, never
+ *                  sees a partial update. Called with the state lock
+ *                  taken.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       filterId is the number of the filter.
+ *
+ * \param[in]       filter points to the new filter, or is NULL to
+ *                  invalidate it.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void WriteRxPacketFilter(fm_int              sw,
+                                fm_int              filterId,
+                                fm_rxPacketFilter * filter)
+{
+    fm_switch *       switchPtr;
+    fm_rxFilterEntry *entry;
+    fm_int            limit;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    entry     = &switchPtr->rxFilters[filterId];
+
+    FM_ATOMIC_ADD(&entry->seq, 1);
+
+    if (filter != NULL)
+    {
+        entry->filter = *filter;
+        entry->valid  = TRUE;
+    }
+    else
+    {
+        entry->valid  = FALSE;
+    }
+
+    FM_ATOMIC_STORE_RELAXED(&entry->hits, 0);
+
+    FM_ATOMIC_ADD(&entry->seq, 1);
+
+    for (limit = FM_MAX_RX_PACKET_FILTERS ; limit > 0 ; limit--)
+    {
+        if (switchPtr->rxFilters[limit - 1].valid)
+        {
+            break;
+        }
+    }
+
+    FM_ATOMIC_STORE(&switchPtr->rxFilterLimit, limit);
+
+}   /* end WriteRxPacketFilter */
+
+
 /*****************************************************************************/
 /** fmReceivePacket
  * \ingroup intApi
@@ -172,6 +330,71 @@ void *fmReceivePacketTask(void *args)
 
 
 
+/*****************************************************************************/
+/** fmSwitchReceivePacketTask
+ * \ingroup intApi
+ *
+ * \desc            Handles reception of packets on a single switch, used
+ *                  when api.perSwitchTasks is enabled.
+ *
+ * \param[in]       args contains a pointer to the thread information, whose
+ *                  parameter is the fm_switchTasks of the switch.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+void *fmSwitchReceivePacketTask(void *args)
+{
+    fm_thread *     thread;
+    fm_switchTasks *tasks;
+    fm_status       err;
+    fm_int          sw;
+
+    thread = FM_GET_THREAD_HANDLE(args);
+    tasks  = FM_GET_THREAD_PARAM(fm_switchTasks, args);
+    sw     = tasks->sw;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH,
+                 "thread = %s, sw = %d\n",
+                 thread->name,
+                 sw);
+
+    while (TRUE)
+    {
+        err = fmWaitSemaphore(&tasks->packetReceiveSemaphore,
+                              FM_WAIT_FOREVER);
+
+        if (err != FM_OK)
+        {
+            FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
+                         "%s: %s\n",
+                         thread->name,
+                         fmErrorMsg(err) );
+            continue;
+        }
+
+        if ( (fmRootApi->fmSwitchStateTable[sw] != NULL)
+              && (!fmRootApi->isSwitchFibmSlave[sw]) )
+        {
+            fmReceivePacket(sw);
+        }
+
+    } /* end while (TRUE) */
+
+    /**************************************************
+     * Should never exit.
+     **************************************************/
+
+    FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                 "ERROR: fmSwitchReceivePacketTask: exiting inadvertently!\n");
+
+    return NULL;
+
+}   /* end fmSwitchReceivePacketTask */
+
+
+
+
 /*****************************************************************************/
 /** fmGetPacketDestAddr
  * \ingroup intSwitch
@@ -260,3 +483,352 @@ fm_macaddr fmGetPacketSrcAddr(fm_int sw, fm_buffer *pkt)
                        srcMacAddress);
 
 }   /* end fmGetPacketSrcAddr */
+
+
+
+
+/*****************************************************************************/
+/** fmRxPacketFilterDrop
+ * \ingroup intApi
+ *
+ * \desc            Applies the receive packet filters of a switch to a
+ *                  received frame, counting a hit on the filter that
+ *                  matches. Called by the packet receive task before an
+ *                  event is allocated for the frame; takes no lock.
+ *
+ * \param[in]       sw is the switch on which the frame was received.
+ *
+ * \param[in]       pkt points to the frame, starting with its destination
+ *                  MAC address.
+ *
+ * \param[in]       srcPort is the logical port the frame was received on.
+ *
+ * \param[in]       vlan is the VLAN the frame was received on.
+ *
+ * \param[in]       trapCode is the trap code of the frame, -1 if it was
+ *                  not trapped.
+ *
+ * \return          TRUE if the frame must be dropped.
+ *
+ *****************************************************************************/
+fm_bool fmRxPacketFilterDrop(fm_int      sw,
+                             fm_buffer * pkt,
+                             fm_int      srcPort,
+                             fm_int      vlan,
+                             fm_int      trapCode)
+{
+    fm_switch *       switchPtr;
+    fm_rxFilterEntry *entry;
+    fm_rxPacketFilter filter;
+    rxFilterKey       key;
+    fm_bool           valid;
+    fm_uint32         seq;
+    fm_int            limit;
+    fm_int            filterId;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    limit     = FM_ATOMIC_LOAD(&switchPtr->rxFilterLimit);
+
+    if (limit == 0)
+    {
+        return FALSE;
+    }
+
+    key.hasHeader = (pkt->len >= 14);
+    key.vlan      = vlan;
+    key.trapCode  = trapCode;
+    key.srcPort   = srcPort;
+
+    if (key.hasHeader)
+    {
+        key.dmac = ( ( (fm_macaddr) ntohl(pkt->data[0]) ) << 16 ) |
+                   ( ntohl(pkt->data[1]) >> 16 );
+        key.smac = ( ( (fm_macaddr) (ntohl(pkt->data[1]) & 0xffff) ) << 32 ) |
+                   ntohl(pkt->data[2]);
+        key.etherType = ntohl(pkt->data[3]) >> 16;
+
+        if ( (key.etherType == FM_RX_FILTER_VLAN_TPID) && (pkt->len >= 18) )
+        {
+            key.etherType = ntohl(pkt->data[4]) >> 16;
+        }
+    }
+
+    for (filterId = 0 ; filterId < limit ; filterId++)
+    {
+        entry = &switchPtr->rxFilters[filterId];
+
+        do
+        {
+            seq    = FM_ATOMIC_LOAD(&entry->seq);
+            valid  = entry->valid;
+            filter = entry->filter;
+            FM_ATOMIC_FENCE();
+        }
+        while ( (seq & 1) || (FM_ATOMIC_LOAD_RELAXED(&entry->seq) != seq) );
+
+        if ( valid && MatchRxPacketFilter(&filter, &key) )
+        {
+            FM_ATOMIC_ADD_RELAXED(&entry->hits, 1);
+
+            return (filter.action == FM_RX_FILTER_ACTION_DROP);
+        }
+    }
+
+    return FALSE;
+
+}   /* end fmRxPacketFilterDrop */
+
+
+
+
+/*****************************************************************************/
+/** fmSetRxPacketFilter
+ * \ingroup packet
+ *
+ * \chips           FM10000
+ *
+ * \desc            Installs a receive packet filter, which the packet
+ *                  receive path applies to every frame sent to the CPU
+ *                  before an event is allocated for it. Frames the
+ *                  application would discard anyway, such as unwanted
+ *                  multicast or duplicate BPDUs, can so be dropped
+ *                  without the cost of event delivery.
+ *                                                                      \lb\lb
+ *                  Filters are evaluated in increasing filterId and the
+ *                  first that matches decides the fate of the frame.
+ *                  Replacing a filter clears its hit counter.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       filterId is the number of the filter, from 0 to
+ *                  ''FM_MAX_RX_PACKET_FILTERS'' - 1.
+ *
+ * \param[in]       filter points to the filter.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if filterId is out of range,
+ *                  filter is NULL or has unknown match fields or action.
+ *
+ *****************************************************************************/
+fm_status fmSetRxPacketFilter(fm_int              sw,
+                              fm_int              filterId,
+                              fm_rxPacketFilter * filter)
+{
+    fm_status err = FM_OK;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_EVENT_PKT_RX,
+                     "sw=%d filterId=%d filter=%p\n",
+                     sw,
+                     filterId,
+                     (void *) filter);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    if ( (filterId < 0) || (filterId >= FM_MAX_RX_PACKET_FILTERS) ||
+         (filter == NULL) ||
+         (filter->matchFields & ~FM_RX_FILTER_MATCH_ALL) ||
+         ( (filter->action != FM_RX_FILTER_ACTION_DROP) &&
+           (filter->action != FM_RX_FILTER_ACTION_DELIVER) ) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_RX, err);
+    }
+
+    FM_TAKE_STATE_LOCK(sw);
+
+    WriteRxPacketFilter(sw, filterId, filter);
+
+    FM_DROP_STATE_LOCK(sw);
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_EVENT_PKT_RX, err);
+
+}   /* end fmSetRxPacketFilter */
+
+
+
+
+/*****************************************************************************/
+/** fmDeleteRxPacketFilter
+ * \ingroup packet
+ *
+ * \chips           FM10000
+ *
+ * \desc            Removes a receive packet filter installed with
+ *                  ''fmSetRxPacketFilter''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       filterId is the number of the filter.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if filterId is out of range.
+ * \return          FM_ERR_NOT_FOUND if the filter is not installed.
+ *
+ *****************************************************************************/
+fm_status fmDeleteRxPacketFilter(fm_int sw, fm_int filterId)
+{
+    fm_switch *switchPtr;
+    fm_status  err = FM_OK;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_EVENT_PKT_RX,
+                     "sw=%d filterId=%d\n",
+                     sw,
+                     filterId);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    if ( (filterId < 0) || (filterId >= FM_MAX_RX_PACKET_FILTERS) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_RX, err);
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_TAKE_STATE_LOCK(sw);
+
+    if (switchPtr->rxFilters[filterId].valid)
+    {
+        WriteRxPacketFilter(sw, filterId, NULL);
+    }
+    else
+    {
+        err = FM_ERR_NOT_FOUND;
+    }
+
+    FM_DROP_STATE_LOCK(sw);
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_EVENT_PKT_RX, err);
+
+}   /* end fmDeleteRxPacketFilter */
+
+
+
+
+/*****************************************************************************/
+/** fmGetRxPacketFilterHits
+ * \ingroup packet
+ *
+ * \chips           FM10000
+ *
+ * \desc            Returns the number of received frames that matched a
+ *                  receive packet filter, whatever its action.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       filterId is the number of the filter.
+ *
+ * \param[out]      hits points to caller-allocated storage where this
+ *                  function places the number of frames.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if filterId is out of range or
+ *                  hits is NULL.
+ * \return          FM_ERR_NOT_FOUND if the filter is not installed.
+ *
+ *****************************************************************************/
+fm_status fmGetRxPacketFilterHits(fm_int      sw,
+                                  fm_int      filterId,
+                                  fm_uint64 * hits)
+{
+    fm_switch *switchPtr;
+    fm_status  err = FM_OK;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_EVENT_PKT_RX,
+                     "sw=%d filterId=%d hits=%p\n",
+                     sw,
+                     filterId,
+                     (void *) hits);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    if ( (filterId < 0) || (filterId >= FM_MAX_RX_PACKET_FILTERS) ||
+         (hits == NULL) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_RX, err);
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->rxFilters[filterId].valid)
+    {
+        *hits = FM_ATOMIC_LOAD_RELAXED(&switchPtr->rxFilters[filterId].hits);
+    }
+    else
+    {
+        err = FM_ERR_NOT_FOUND;
+    }
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_EVENT_PKT_RX, err);
+
+}   /* end fmGetRxPacketFilterHits */
+
+
+
+
+/*****************************************************************************/
+/** fmResetRxPacketFilterHits
+ * \ingroup packet
+ *
+ * \chips           FM10000
+ *
+ * \desc            Clears the hit counter of a receive packet filter.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       filterId is the number of the filter.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if filterId is out of range.
+ * \return          FM_ERR_NOT_FOUND if the filter is not installed.
+ *
+ *****************************************************************************/
+fm_status fmResetRxPacketFilterHits(fm_int sw, fm_int filterId)
+{
+    fm_switch *switchPtr;
+    fm_status  err = FM_OK;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_EVENT_PKT_RX,
+                     "sw=%d filterId=%d\n",
+                     sw,
+                     filterId);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    if ( (filterId < 0) || (filterId >= FM_MAX_RX_PACKET_FILTERS) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_RX, err);
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->rxFilters[filterId].valid)
+    {
+        FM_ATOMIC_STORE_RELAXED(&switchPtr->rxFilters[filterId].hits, 0);
+    }
+    else
+    {
+        err = FM_ERR_NOT_FOUND;
+    }
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_EVENT_PKT_RX, err);
+
+}   /* end fmResetRxPacketFilterHits */
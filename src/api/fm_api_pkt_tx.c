@@ -303,6 +303,12 @@ fm_status fmSendPacketExt(fm_int sw, fm_packetInfo *info, fm_buffer *pkt)
  *                  chain remains with the caller, who is responsible for
  *                  disposing of the chain appropriately.
  *
+ * \note            The chain is shared by all destination ports without
+ *                  being copied, and is freed once the packet has been sent
+ *                  to every port. To send the same chain in several calls,
+ *                  retain it with ''fmRetainBufferChain'' once for each
+ *                  call beyond the first.
+ *
  * \param[in]       sw is the switch on which to operate.
  *
  * \param[in]       portList points to an array of logical port numbers to
@@ -421,6 +427,8 @@ fm_status fmSendPacketDirected(fm_int       sw,
  *                  numPorts is not positive, or pkt is not a valid packet 
  *                  buffer.
  * \return          FM_ERR_TX_PACKET_QUEUE_FULL if the transmit packet queue is full.
+ * \return          FM_ERR_LOCK_TIMEOUT if info->noWait is TRUE and another
+ *                  thread is adding to the transmit packet queue.
  * \return          FM_ERR_FRAME_TOO_LARGE if the packet is too long.
  * \return          FM_FAIL if network device is not operational.
  *
@@ -464,6 +472,340 @@ fm_status fmSendPacketDirectedV2(fm_int           sw,
 
 
 
+/*****************************************************************************/
+/** fmCreateTxDestination
+ * \ingroup pkt
+ *
+ * \chips           FM10000
+ *
+ * \desc            Creates a TX destination handle for a list of ports, to
+ *                  be used with ''fmSendPacketTxDestination''. Applications
+ *                  that repeatedly send directed packets to the same ports
+ *                  should use a handle rather than ''fmSendPacketDirected'':
+ *                  the port list is validated, and the information needed
+ *                  to build each frame's ISL tag is resolved, once instead
+ *                  of on every send.
+ *                                                                      \lb\lb
+ *                  A handle stays valid across configuration changes. It
+ *                  is resolved again on its first use after any change to
+ *                  port attributes, LAG membership or logical ports.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       portList points to an array of logical port numbers to
+ *                  which packets are to be sent. These may be cardinal,
+ *                  LAG or remote ports, or the CPU port.
+ *
+ * \param[in]       numPorts is the number of elements in portList.
+ *
+ * \param[out]      destHandle points to caller-allocated storage where
+ *                  this function should place the handle.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if the switch number is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if portList or destHandle is
+ *                  NULL, or numPorts is not positive.
+ * \return          FM_ERR_INVALID_PORT if portList contains an invalid port
+ *                  number.
+ * \return          FM_ERR_NO_FREE_RESOURCES if ''FM_MAX_TX_DESTINATIONS''
+ *                  handles already exist.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmCreateTxDestination(fm_int  sw,
+                                fm_int *portList,
+                                fm_int  numPorts,
+                                fm_int *destHandle)
+{
+    fm_status   err;
+    fm_switch * switchPtr;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_EVENT_PKT_TX,
+                     "sw=%d portList=%p numPorts=%d destHandle=%p\n",
+                     sw,
+                     (void *) portList,
+                     numPorts,
+                     (void *) destHandle);
+
+    if ( (numPorts <= 0) || (portList == NULL) || (destHandle == NULL) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_API_CALL_FAMILY(err,
+                       switchPtr->CreateTxDestination,
+                       sw,
+                       portList,
+                       numPorts,
+                       destHandle);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+}   /* end fmCreateTxDestination */
+
+
+
+
+/*****************************************************************************/
+/** fmDeleteTxDestination
+ * \ingroup pkt
+ *
+ * \chips           FM10000
+ *
+ * \desc            Deletes a TX destination handle created with
+ *                  ''fmCreateTxDestination''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       destHandle is the handle to delete.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if the switch number is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if destHandle is out of range.
+ * \return          FM_ERR_NOT_FOUND if destHandle does not exist.
+ *
+ *****************************************************************************/
+fm_status fmDeleteTxDestination(fm_int sw, fm_int destHandle)
+{
+    fm_status   err;
+    fm_switch * switchPtr;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_EVENT_PKT_TX,
+                     "sw=%d destHandle=%d\n",
+                     sw,
+                     destHandle);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_API_CALL_FAMILY(err, switchPtr->DeleteTxDestination, sw, destHandle);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+}   /* end fmDeleteTxDestination */
+
+
+
+
+/*****************************************************************************/
+/** fmSendPacketTxDestination
+ * \ingroup pkt
+ *
+ * \chips           FM10000
+ *
+ * \desc            Sends a message packet in directed mode to the ports of
+ *                  a TX destination handle. The packet is handled as by
+ *                  ''fmSendPacketDirectedV2'': ports whose link is down are
+ *                  skipped, and the packet egresses with or without a VLAN
+ *                  tag exactly as provided by the caller.
+ *
+ * \note            Buffer ownership follows the same rules as for
+ *                  ''fmSendPacketDirected''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       destHandle is a handle returned by
+ *                  ''fmCreateTxDestination''.
+ *
+ * \param[in]       pkt points to the packet buffer's first ''fm_buffer''
+ *                  structure in a chain of one or more buffers.
+ *
+ * \param[in]       info is a pointer to the packet information structure,
+ *                  see ''fm_packetInfoV2''. May be NULL to send with the
+ *                  VLAN priority and the default FCS.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if the switch number is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if pkt is not a valid packet
+ *                  buffer or destHandle is out of range.
+ * \return          FM_ERR_NOT_FOUND if destHandle does not exist.
+ * \return          FM_ERR_INVALID_PORT if a port of the handle no longer
+ *                  exists.
+ * \return          FM_ERR_INVALID_PORT_STATE if none of the ports is in the
+ *                  proper port state.
+ * \return          FM_ERR_TX_PACKET_QUEUE_FULL if the transmit packet queue
+ *                  is full.
+ * \return          FM_ERR_LOCK_TIMEOUT if info->noWait is TRUE and another
+ *                  thread is adding to the transmit packet queue.
+ * \return          FM_ERR_FRAME_TOO_LARGE if the packet is too long.
+ * \return          FM_FAIL if network device is not operational.
+ *
+ *****************************************************************************/
+fm_status fmSendPacketTxDestination(fm_int           sw,
+                                    fm_int           destHandle,
+                                    fm_buffer *      pkt,
+                                    fm_packetInfoV2 *info)
+{
+    fm_status       err;
+    fm_switch *     switchPtr;
+    fm_packetInfoV2 defaultInfo;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_EVENT_PKT_TX,
+                     "sw=%d destHandle=%d pkt=%p info=%p\n",
+                     sw,
+                     destHandle,
+                     (void *) pkt,
+                     (void *) info);
+
+    if (pkt == NULL)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    if (info == NULL)
+    {
+        FM_CLEAR(defaultInfo);
+        defaultInfo.switchPriority = FM_USE_VLAN_PRIORITY;
+        info = &defaultInfo;
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_API_CALL_FAMILY(err,
+                       switchPtr->SendPacketTxDestination,
+                       sw,
+                       destHandle,
+                       pkt,
+                       info);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+}   /* end fmSendPacketTxDestination */
+
+
+
+
+/*****************************************************************************/
+/** fmSetTxCompletionHandler
+ * \ingroup pkt
+ *
+ * \chips           FM10000
+ *
+ * \desc            Registers the handler called as packets sent with a
+ *                  non-NULL txCookie in their ''fm_packetInfoV2'' leave the
+ *                  TX packet queue, so that the application can recycle
+ *                  its per-packet state and pace its sending. Completions
+ *                  are batched per pass of the transmit thread over a
+ *                  queue, see ''fm_txCompletionHandler''.
+ *
+ * \note            The handler should only be replaced while no packet
+ *                  with a txCookie is queued, otherwise a batch in flight
+ *                  may be reported to the previous handler.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       handler is the completion handler, NULL to stop
+ *                  reporting completions.
+ *
+ * \param[in]       handlerCookie is passed unchanged to the handler.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if the switch number is invalid.
+ *
+ *****************************************************************************/
+fm_status fmSetTxCompletionHandler(fm_int                 sw,
+                                   fm_txCompletionHandler handler,
+                                   void *                 handlerCookie)
+{
+    fm_switch * switchPtr;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_EVENT_PKT_TX,
+                     "sw=%d handlerCookie=%p\n",
+                     sw,
+                     handlerCookie);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    /* The transmit thread loads the handler before its cookie */
+    FM_ATOMIC_STORE(&switchPtr->txCompletionCookie, handlerCookie);
+    FM_ATOMIC_STORE(&switchPtr->txCompletionHandler, handler);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_EVENT_PKT_TX, FM_OK);
+
+}   /* end fmSetTxCompletionHandler */
+
+
+
+
+/*****************************************************************************/
+/** fmGetTxQueueSpace
+ * \ingroup pkt
+ *
+ * \chips           FM10000
+ *
+ * \desc            Returns the number of free entries in the TX packet
+ *                  queue serving a switch priority. A packet sent to N
+ *                  ports uses N entries. Senders using the noWait option
+ *                  of ''fm_packetInfoV2'' can use this to pace themselves
+ *                  rather than retry on FM_ERR_TX_PACKET_QUEUE_FULL.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       switchPriority is the switch priority the packets are
+ *                  sent with.
+ *
+ * \param[out]      space points to caller-allocated storage where this
+ *                  function should place the number of free entries.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if the switch number is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if space is NULL.
+ *
+ *****************************************************************************/
+fm_status fmGetTxQueueSpace(fm_int    sw,
+                            fm_uint32 switchPriority,
+                            fm_int *  space)
+{
+    fm_status   err;
+    fm_switch * switchPtr;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_EVENT_PKT_TX,
+                     "sw=%d switchPriority=%u space=%p\n",
+                     sw,
+                     switchPriority,
+                     (void *) space);
+
+    if (space == NULL)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_API_CALL_FAMILY(err,
+                       switchPtr->GetTxQueueSpace,
+                       sw,
+                       switchPriority,
+                       space);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+}   /* end fmGetTxQueueSpace */
+
+
+
+
 /*****************************************************************************/
 /** fmSendPacketSwitched
  * \ingroup pkt
@@ -60,6 +60,144 @@
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/** GetSetAttrAllowMode
+ * \ingroup intPort
+ *
+ * \desc            Return the port validation mode for setting an attribute,
+ *                  i.e. whether the attribute may be applied to the CPU
+ *                  interface port.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port number.
+ *
+ * \param[in]       attr is the port attribute to be set.
+ *
+ * \param[out]      mcastLocks points to caller-allocated storage where this
+ *                  function sets TRUE if the attribute requires the routing,
+ *                  LAG, L2 and MTABLE locks to be taken before it is set.
+ *
+ * \return          ALLOW_CPU or DISALLOW_CPU.
+ *
+ *****************************************************************************/
+static fm_int GetSetAttrAllowMode(fm_int   sw,
+                                  fm_int   port,
+                                  fm_int   attr,
+                                  fm_bool *mcastLocks)
+{
+    fm_switch *switchPtr;
+    fm_int     allowMode;
+
+    switchPtr   = GET_SWITCH_PTR(sw);
+    *mcastLocks = FALSE;
+
+    /* Some attributes can apply to the CPU interface port. */
+    switch (attr)
+    {
+        case FM_PORT_DEF_VLAN:
+        case FM_PORT_LEARNING:
+        case FM_PORT_DEF_PRI:
+        case FM_PORT_DEF_DSCP:
+        case FM_PORT_ROUTABLE:
+        case FM_PORT_MAX_FRAME_SIZE:
+        case FM_PORT_MIN_FRAME_SIZE:
+        case FM_PORT_MCAST_FLOODING:
+        case FM_PORT_UCAST_FLOODING:
+        case FM_PORT_UPDATE_ROUTED_FRAME:
+        case FM_PORT_UPDATE_TTL:
+        case FM_PORT_UPDATE_DSCP:
+        case FM_PORT_MASK:
+        case FM_PORT_MASK_WIDE:
+        case FM_PORT_DEF_CFI:
+        case FM_PORT_REPLACE_DSCP:
+        case FM_PORT_DEF_SWPRI:
+        case FM_PORT_DEF_ISL_USER:
+        case FM_PORT_PARSER:
+        case FM_PORT_PARSER_FLAG_OPTIONS:
+        case FM_PORT_LOG_ARP:
+        case FM_PORT_TRAP_ARP:
+        case FM_PORT_CHECK_LEARNING_VID2:
+        case FM_PORT_SWPRI_SOURCE:
+        case FM_PORT_TRAP_IEEE_8021X:
+        case FM_PORT_TRAP_IEEE_BPDU:
+        case FM_PORT_TRAP_IEEE_GARP:
+        case FM_PORT_TRAP_IEEE_LACP:
+        case FM_PORT_TRAP_IEEE_OTHER:
+        case FM_PORT_DEF_VLAN2:
+        case FM_PORT_DEF_PRI2:
+        case FM_PORT_DROP_BV:
+        case FM_PORT_PARSER_VLAN1_TAG:
+        case FM_PORT_PARSER_VLAN2_TAG:
+        case FM_PORT_MODIFY_VLAN1_TAG:
+        case FM_PORT_MODIFY_VLAN2_TAG:
+        case FM_PORT_PARSE_MPLS:
+        case FM_PORT_ROUTED_FRAME_UPDATE_FIELDS:
+        case FM_PORT_RX_CUT_THROUGH:
+        case FM_PORT_TX_CUT_THROUGH:
+        case FM_PORT_PARSER_FIRST_CUSTOM_TAG:
+        case FM_PORT_PARSER_SECOND_CUSTOM_TAG:
+        case FM_PORT_PARSER_STORE_MPLS:
+        case FM_PORT_TCN_FIFO_WM:
+        case FM_PORT_MIRROR_TRUNC_SIZE:
+        case FM_PORT_PARSER_VLAN2_FIRST:
+        case FM_PORT_MODIFY_VID2_FIRST:
+        case FM_PORT_REPLACE_VLAN_FIELDS:
+        case FM_PORT_TX_PAUSE:
+        case FM_PORT_RX_PAUSE:
+        case FM_PORT_TX_PAUSE_MODE:
+        case FM_PORT_RX_CLASS_PAUSE:
+        case FM_PORT_SMP_LOSSLESS_PAUSE:
+        case FM_PORT_TAGGING_MODE:
+        case FM_PORT_TXCFI:
+        case FM_PORT_TXCFI2:
+        case FM_PORT_TXVPRI:
+        case FM_PORT_TXVPRI2:
+        case FM_PORT_SWPRI_DSCP_PREF:
+        case FM_PORT_SECURITY_ACTION:
+        case FM_PORT_FABRIC_LOOPBACK:
+        case FM_PORT_TX_PAUSE_RESEND_TIME:
+        case FM_PORT_ISL_TAG_FORMAT:
+            allowMode = ALLOW_CPU;
+            break;
+
+        case FM_PORT_MCAST_PRUNING:
+            allowMode = DISALLOW_CPU;
+            /* We need to take different locks (routing, L2 and mtable lock),
+               for the benefit of updating multicast HNI flooding groups,
+               to prevent possible lock inversions. Lock must
+               be taken after VALIDATE_LOGICAL_PORT call for lock
+               inversion reason as well. */
+            *mcastLocks = TRUE;
+            break;
+
+        default:
+            allowMode = DISALLOW_CPU;
+            break;
+
+    }   /* end switch (attr) */
+
+    if ( (port != 0) && (port == switchPtr->cpuPort) )
+    {
+        allowMode = ALLOW_CPU;
+    }
+
+    if ( (allowMode == DISALLOW_CPU) &&
+         (switchPtr->IsCpuAttribute != NULL) )
+    {
+        if (switchPtr->IsCpuAttribute(sw, attr))
+        {
+            allowMode = ALLOW_CPU;
+        }
+    }
+
+    return allowMode;
+
+}   /* end GetSetAttrAllowMode */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -121,10 +259,14 @@ fm_status fmInitPort(fm_int sw, fm_port *portPtr)
         portPtr->linkUp = TRUE;
     }
 
+    fmUpdateCardinalPortState(GET_SWITCH_PTR(sw), portPtr->portNumber);
+
     /***************************************************
      * Call the port specific initialization.
      **************************************************/
+    fmDbgBootPhaseBegin(sw, "InitPort", portPtr->portNumber);
     FM_API_CALL_FAMILY(err, portPtr->InitPort, sw, portPtr);
+    fmDbgBootPhaseEnd(sw, "InitPort");
 
     FM_LOG_EXIT_V2(FM_LOG_CAT_PORT, portPtr->portNumber, err);
 
@@ -890,109 +1032,14 @@ fm_status fmSetPortAttributeV2(fm_int sw,
     routingLockTaken = FALSE;
     lagLockTaken = FALSE;
 
-    /* Some attributes can apply to the CPU interface port. */
-    switch (attr)
-    {
-        case FM_PORT_DEF_VLAN:
-            if ( *((fm_uint32 *) value) >= FM_MAX_VLAN )
-            {
-                err = FM_ERR_INVALID_VALUE;
-                goto ABORT;
-            }
-        case FM_PORT_LEARNING:
-        case FM_PORT_DEF_PRI:
-        case FM_PORT_DEF_DSCP:
-        case FM_PORT_ROUTABLE:
-        case FM_PORT_MAX_FRAME_SIZE:
-        case FM_PORT_MIN_FRAME_SIZE:
-        case FM_PORT_MCAST_FLOODING:
-        case FM_PORT_UCAST_FLOODING:
-        case FM_PORT_UPDATE_ROUTED_FRAME:
-        case FM_PORT_UPDATE_TTL:
-        case FM_PORT_UPDATE_DSCP:
-        case FM_PORT_MASK:
-        case FM_PORT_MASK_WIDE:
-        case FM_PORT_DEF_CFI:
-        case FM_PORT_REPLACE_DSCP:
-        case FM_PORT_DEF_SWPRI:
-        case FM_PORT_DEF_ISL_USER:
-        case FM_PORT_PARSER:
-        case FM_PORT_PARSER_FLAG_OPTIONS:
-        case FM_PORT_LOG_ARP:
-        case FM_PORT_TRAP_ARP:
-        case FM_PORT_CHECK_LEARNING_VID2:
-        case FM_PORT_SWPRI_SOURCE:
-        case FM_PORT_TRAP_IEEE_8021X:
-        case FM_PORT_TRAP_IEEE_BPDU:
-        case FM_PORT_TRAP_IEEE_GARP:
-        case FM_PORT_TRAP_IEEE_LACP:
-        case FM_PORT_TRAP_IEEE_OTHER:
-        case FM_PORT_DEF_VLAN2:
-        case FM_PORT_DEF_PRI2:
-        case FM_PORT_DROP_BV:
-        case FM_PORT_PARSER_VLAN1_TAG:
-        case FM_PORT_PARSER_VLAN2_TAG:
-        case FM_PORT_MODIFY_VLAN1_TAG:
-        case FM_PORT_MODIFY_VLAN2_TAG:
-        case FM_PORT_PARSE_MPLS:
-        case FM_PORT_ROUTED_FRAME_UPDATE_FIELDS:
-        case FM_PORT_RX_CUT_THROUGH:
-        case FM_PORT_TX_CUT_THROUGH:
-        case FM_PORT_PARSER_FIRST_CUSTOM_TAG:
-        case FM_PORT_PARSER_SECOND_CUSTOM_TAG:
-        case FM_PORT_PARSER_STORE_MPLS:
-        case FM_PORT_TCN_FIFO_WM:
-        case FM_PORT_MIRROR_TRUNC_SIZE:
-        case FM_PORT_PARSER_VLAN2_FIRST:
-        case FM_PORT_MODIFY_VID2_FIRST:
-        case FM_PORT_REPLACE_VLAN_FIELDS:
-        case FM_PORT_TX_PAUSE:
-        case FM_PORT_RX_PAUSE:
-        case FM_PORT_TX_PAUSE_MODE:
-        case FM_PORT_RX_CLASS_PAUSE:
-        case FM_PORT_SMP_LOSSLESS_PAUSE:
-        case FM_PORT_TAGGING_MODE:
-        case FM_PORT_TXCFI:
-        case FM_PORT_TXCFI2:
-        case FM_PORT_TXVPRI:
-        case FM_PORT_TXVPRI2:
-        case FM_PORT_SWPRI_DSCP_PREF:
-        case FM_PORT_SECURITY_ACTION:
-        case FM_PORT_FABRIC_LOOPBACK:
-        case FM_PORT_TX_PAUSE_RESEND_TIME:
-        case FM_PORT_ISL_TAG_FORMAT:
-            allowMode = ALLOW_CPU;
-            break;
-
-        case FM_PORT_MCAST_PRUNING:
-            allowMode = DISALLOW_CPU;
-            /* We need to take different locks (routing, L2 and mtable lock),
-               for the benefit of updating multicast HNI flooding groups,
-               to prevent possible lock inversions. Lock must
-               be taken after VALIDATE_LOGICAL_PORT call for lock
-               inversion reason as well. */
-            takeLocks = TRUE;
-            break;
-
-        default:
-            allowMode = DISALLOW_CPU;
-            break;
-
-    }   /* end switch (attr) */
-
-    if ( (port != 0) && (port == switchPtr->cpuPort) )
+    if ( (attr == FM_PORT_DEF_VLAN) &&
+         ( *((fm_uint32 *) value) >= FM_MAX_VLAN ) )
     {
-        allowMode = ALLOW_CPU;
+        err = FM_ERR_INVALID_VALUE;
+        goto ABORT;
     }
 
-    if ( (allowMode == DISALLOW_CPU) &&
-         (switchPtr->IsCpuAttribute != NULL) )
-    {
-        if (switchPtr->IsCpuAttribute(sw, attr))
-        {
-            allowMode = ALLOW_CPU;
-        }
-    }
+    allowMode = GetSetAttrAllowMode(sw, port, attr, &takeLocks);
 
     VALIDATE_LOGICAL_PORT(sw, port, ALLOW_LAG | allowMode);
 
@@ -1027,6 +1074,11 @@ fm_status fmSetPortAttributeV2(fm_int sw,
                        attr,
                        value);
 
+    if (err == FM_OK)
+    {
+        FM_INVALIDATE_TX_DESTINATIONS(sw);
+    }
+
 ABORT:
 
     if (mTableLockTaken)
@@ -1058,51 +1110,342 @@ ABORT:
 
 
 /*****************************************************************************/
-/** fmGetPortAttribute
+/** fmSetPortAttributeList
  * \ingroup port
  *
- * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
- *
- * \desc            Get a port attribute.
+ * \chips           FM10000
  *
- * \note            For FM6000 devices, this function may only be
- *                  used to get attributes that are per-port and per-MAC for
- *                  the active MAC of a port. To get per-MAC attributes for
- *                  the inactive MAC, or to get per-lane attributes, use
- *                  ''fmGetPortAttributeV2''.
+ * \desc            Set a list of port attributes, each entry giving a port,
+ *                  an attribute and a value, as with ''fmSetPortAttribute''.
+ *                  This is typically used to apply a whole configuration
+ *                  profile to many ports.
+ *                                                                      \lb\lb
+ *                  All entries are validated before any of them is applied.
+ *                  The locks needed by the list are taken once, and derived
+ *                  state such as the shared memory watermarks is recomputed
+ *                  once after the last entry instead of after each one.
+ *                                                                      \lb\lb
+ *                  Entries are applied in list order. If applying an entry
+ *                  fails, the entries before it remain applied and the
+ *                  remaining entries are not applied.
  *
  * \param[in]       sw is the switch on which to operate.
  *
- * \param[in]       port is the logical port number on which to operate. May
- *                  be a LAG logical port number. May also be the CPU interface
- *                  for some attributes. See ''Port Attributes'' for details.
+ * \param[in]       numEntries is the number of entries in portList, attrList
+ *                  and valueList.
  *
- * \param[in]       attr is the port attribute (see 'Port Attributes') to get.
+ * \param[in]       portList is an array of logical port numbers. May contain
+ *                  LAG logical ports and, for some attributes, the CPU
+ *                  interface port.
  *
- * \param[out]      value points to caller-allocated storage where this
- *                  function should place the attribute value.
+ * \param[in]       attrList is an array of port attributes
+ *                  (see 'Port Attributes').
+ *
+ * \param[in]       valueList is an array of pointers to the attribute values.
  *
  * \return          FM_OK if successful.
  * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
- * \return          FM_ERR_INVALID_PORT if port is invalid.
- * \return          FM_ERR_INVALID_PORT_MAC if an attempt was made to configure
- *                  a physical attribute for a port with no active MAC.
- * \return          FM_ERR_INVALID_PORT_LANE if an attempt was made to
- *                  configure a lane attribute for a port with no active lanes.
- * \return          FM_ERR_UNSUPPORTED if attribute is not supported for
- *                  this switch.
- * \return          FM_ERR_INVALID_ATTRIB if unrecognized attribute.
+ * \return          FM_ERR_INVALID_ARGUMENT if an array is NULL, numEntries is
+ *                  not positive or an entry's value is NULL.
+ * \return          FM_ERR_INVALID_PORT if an entry's port is invalid.
+ * \return          FM_ERR_INVALID_ATTRIB if an entry's attribute is
+ *                  unrecognized.
+ * \return          FM_ERR_INVALID_VALUE if an entry's default VLAN is out of
+ *                  range.
  *
  *****************************************************************************/
-fm_status fmGetPortAttribute(fm_int sw,
-                             fm_int port,
-                             fm_int attr,
-                             void * value)
+fm_status fmSetPortAttributeList(fm_int  sw,
+                                 fm_int  numEntries,
+                                 fm_int *portList,
+                                 fm_int *attrList,
+                                 void ** valueList)
 {
-    fm_status err;
-
-    err = fmGetPortAttributeV2(sw,
-                               port,
+    fm_status  err = FM_OK;
+    fm_status  err2;
+    fm_port *  portPtr;
+    fm_switch *switchPtr;
+    fm_int     allowMode;
+    fm_int     i;
+    fm_bool    needLocks;
+    fm_bool    takeLocks;
+    fm_bool    l2LockTaken;
+    fm_bool    mTableLockTaken;
+    fm_bool    routingLockTaken;
+    fm_bool    lagLockTaken;
+    fm_bool    updateStarted;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_PORT,
+                     "sw=%d numEntries=%d portList=%p attrList=%p "
+                     "valueList=%p\n",
+                     sw,
+                     numEntries,
+                     (void *) portList,
+                     (void *) attrList,
+                     (void *) valueList);
+
+    if ( (numEntries <= 0) ||
+         (portList == NULL) ||
+         (attrList == NULL) ||
+         (valueList == NULL) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_PORT, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    takeLocks        = FALSE;
+    l2LockTaken      = FALSE;
+    mTableLockTaken  = FALSE;
+    routingLockTaken = FALSE;
+    lagLockTaken     = FALSE;
+    updateStarted    = FALSE;
+
+    /**************************************************
+     * Validate every entry before applying any.
+     **************************************************/
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        if (valueList[i] == NULL)
+        {
+            err = FM_ERR_INVALID_ARGUMENT;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        }
+
+        if ( !fmIsValidPortAttribute(attrList[i]) )
+        {
+            err = FM_ERR_INVALID_ATTRIB;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        }
+
+        if ( (attrList[i] == FM_PORT_DEF_VLAN) &&
+             ( *((fm_uint32 *) valueList[i]) >= FM_MAX_VLAN ) )
+        {
+            err = FM_ERR_INVALID_VALUE;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        }
+
+        allowMode = GetSetAttrAllowMode(sw,
+                                        portList[i],
+                                        attrList[i],
+                                        &needLocks);
+
+        if ( !fmIsValidPort(sw, portList[i], ALLOW_LAG | allowMode) )
+        {
+            err = FM_ERR_INVALID_PORT;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        }
+
+        takeLocks |= needLocks;
+    }
+
+    /* Same lock order as fmSetPortAttributeV2 */
+    if (takeLocks)
+    {
+        err = fmCaptureWriteLock(&switchPtr->routingLock, FM_WAIT_FOREVER);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        routingLockTaken = TRUE;
+
+        err = TAKE_LAG_LOCK(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        lagLockTaken = TRUE;
+
+        err = FM_TAKE_L2_LOCK(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        l2LockTaken = TRUE;
+
+        err = FM_TAKE_MTABLE_LOCK(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        mTableLockTaken = TRUE;
+    }
+
+    if (switchPtr->BeginPortAttributeUpdate != NULL)
+    {
+        err = switchPtr->BeginPortAttributeUpdate(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        updateStarted = TRUE;
+    }
+
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        portPtr = GET_PORT_PTR(sw, portList[i]);
+
+        FM_API_CALL_FAMILY(err,
+                           portPtr->SetPortAttribute,
+                           sw,
+                           portList[i],
+                           FM_PORT_MAC_ALL,
+                           FM_PORT_LANE_ALL,
+                           attrList[i],
+                           valueList[i]);
+        FM_LOG_ABORT_ON_ERR_V2(FM_LOG_CAT_PORT, portList[i], err);
+    }
+
+ABORT:
+
+    if (updateStarted)
+    {
+        err2 = switchPtr->EndPortAttributeUpdate(sw);
+
+        if (err == FM_OK)
+        {
+            err = err2;
+        }
+    }
+
+    if (mTableLockTaken)
+    {
+        FM_DROP_MTABLE_LOCK(sw);
+    }
+
+    if (l2LockTaken)
+    {
+        FM_DROP_L2_LOCK(sw);
+    }
+
+    if (lagLockTaken)
+    {
+        DROP_LAG_LOCK(sw);
+    }
+
+    if (routingLockTaken)
+    {
+        fmReleaseWriteLock(&switchPtr->routingLock);
+    }
+
+    UNPROTECT_SWITCH(sw);
+    FM_LOG_EXIT_API(FM_LOG_CAT_PORT, err);
+
+}   /* end fmSetPortAttributeList */
+
+
+
+
+/*****************************************************************************/
+/** fmGetPortAttributeSnapshot
+ * \ingroup port
+ *
+ * \chips           FM10000
+ *
+ * \desc            Get a port attribute from the copy the API publishes for
+ *                  lock-free readers, without taking any API lock. May be
+ *                  called by a monitoring process attached with
+ *                  ''fmInitializeMonitor''.
+ *                                                                      \lb\lb
+ *                  Only frequently polled scalar attributes are published:
+ *                  ''FM_PORT_MIN_FRAME_SIZE'', ''FM_PORT_MAX_FRAME_SIZE'',
+ *                  ''FM_PORT_DEF_PRI'' and
+ *                  ''FM_PORT_ETHERNET_INTERFACE_MODE''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the port on which to operate.
+ *
+ * \param[in]       attr is the port attribute (see 'Port Attributes') to get.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function should place the attribute value.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_SWITCH_NOT_UP if the switch is not up.
+ * \return          FM_ERR_INVALID_PORT if port is not a cardinal port.
+ * \return          FM_ERR_INVALID_ARGUMENT if value is NULL.
+ * \return          FM_ERR_UNSUPPORTED if the attribute is not published.
+ * \return          FM_ERR_NOT_FOUND if the port's attributes have not been
+ *                  published yet.
+ *
+ *****************************************************************************/
+fm_status fmGetPortAttributeSnapshot(fm_int sw,
+                                     fm_int port,
+                                     fm_int attr,
+                                     void * value)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PORT,
+                 "sw=%d port=%d attr=%d value=%p\n",
+                 sw,
+                 port,
+                 attr,
+                 value);
+
+    if (value == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PORT, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_SWITCH_LOCK_FREE(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if ( !fmIsCardinalPort(sw, port) )
+    {
+        err = FM_ERR_INVALID_PORT;
+    }
+    else if (switchPtr->GetPortAttributeSnapshot == NULL)
+    {
+        err = FM_ERR_UNSUPPORTED;
+    }
+    else
+    {
+        err = switchPtr->GetPortAttributeSnapshot(sw, port, attr, value);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
+
+}   /* end fmGetPortAttributeSnapshot */
+
+
+
+
+/*****************************************************************************/
+/** fmGetPortAttribute
+ * \ingroup port
+ *
+ * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
+ *
+ * \desc            Get a port attribute.
+ *
+ * \note            For FM6000 devices, this function may only be
+ *                  used to get attributes that are per-port and per-MAC for
+ *                  the active MAC of a port. To get per-MAC attributes for
+ *                  the inactive MAC, or to get per-lane attributes, use
+ *                  ''fmGetPortAttributeV2''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port number on which to operate. May
+ *                  be a LAG logical port number. May also be the CPU interface
+ *                  for some attributes. See ''Port Attributes'' for details.
+ *
+ * \param[in]       attr is the port attribute (see 'Port Attributes') to get.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function should place the attribute value.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_PORT if port is invalid.
+ * \return          FM_ERR_INVALID_PORT_MAC if an attempt was made to configure
+ *                  a physical attribute for a port with no active MAC.
+ * \return          FM_ERR_INVALID_PORT_LANE if an attempt was made to
+ *                  configure a lane attribute for a port with no active lanes.
+ * \return          FM_ERR_UNSUPPORTED if attribute is not supported for
+ *                  this switch.
+ * \return          FM_ERR_INVALID_ATTRIB if unrecognized attribute.
+ *
+ *****************************************************************************/
+fm_status fmGetPortAttribute(fm_int sw,
+                             fm_int port,
+                             fm_int attr,
+                             void * value)
+{
+    fm_status err;
+
+    err = fmGetPortAttributeV2(sw,
+                               port,
                                FM_PORT_ACTIVE_MAC,
                                FM_PORT_LANE_NA,
                                attr,
@@ -1318,50 +1661,64 @@ fm_status fmSetPortSecurity(fm_int  sw,
 
 
 /*****************************************************************************/
-/** fmUpdateSwitchPortMasks
+/** UpdatePortMasks
  * \ingroup intPort
  *
- * \desc            Update switch port masks based upon port link states.
+ * \desc            Rewrites the hardware source masks of the cardinal ports
+ *                  whose flooding domain depends on a set of changed ports:
+ *                  the changed ports themselves, whose own link state
+ *                  filters their mask, and every port whose
+ *                  ''FM_PORT_MASK_WIDE'' includes one of them. The other
+ *                  masks cannot have changed and are left untouched.
+ *
+ * \note            The caller is assumed to hold the port attribute lock
+ *                  and the register lock.
  *
  * \param[in]       sw is the switch on which to operate.
  *
+ * \param[in]       changedMask points to the cardinal port mask of the
+ *                  changed ports, or is NULL to rewrite every mask.
+ *
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
-fm_status fmUpdateSwitchPortMasks(fm_int sw)
+static fm_status UpdatePortMasks(fm_int sw, const fm_portmask *changedMask)
 {
-    fm_int     cpi;
-    fm_int     port;
-    fm_switch *swstate;
-    fm_status  err = FM_OK;
-    fm_port *  portPtr;
+    fm_int        cpi;
+    fm_int        port;
+    fm_switch *   swstate;
+    fm_status     err = FM_OK;
+    fm_port *     portPtr;
+    fm_portAttr * portAttr;
+    fm_portmask   overlap;
 
     swstate = GET_SWITCH_PTR(sw);
 
-    /**************************************************
-     * Capture the PORT_ATTR lock for the exclusive
-     * access to portPtr->portMask and REG lock for the
-     * exclusive access to switch register
-     * (i.e. PORT_CFG_2).
-     **************************************************/
-
-    FM_TAKE_PORT_ATTR_LOCK(sw);
-    TAKE_REG_LOCK(sw);
-
     for (cpi = 0 ; cpi < swstate->numCardinalPorts ; cpi++)
     {
         port    = GET_LOGICAL_PORT(sw, cpi);
         portPtr = GET_PORT_PTR(sw, port);
 
+        if ( (changedMask != NULL) &&
+             !FM_PORTMASK_IS_BIT_SET(changedMask, cpi) )
+        {
+            portAttr = GET_PORT_ATTR(sw, port);
+
+            FM_AND_PORTMASKS(&overlap, &portAttr->portMask, changedMask);
+
+            if ( FM_PORTMASK_IS_ZERO(&overlap) )
+            {
+                continue;
+            }
+        }
+
         /***************************************************
-         * Note that this causes port changes to all ports
-         * but it is necessary: downed ports need their
-         * port masks reset (provided by the internal
-         * implementation of FM_PORT_MASK) and up ports
-         * need their port masks filtered.  Missing these
-         * cases can cause backpressure inside the
-         * switch fabric via sending to ports that have
-         * link down.
+         * Downed ports need their port masks reset
+         * (provided by the internal implementation of
+         * FM_PORT_MASK) and up ports need their port masks
+         * filtered. Missing these cases can cause
+         * backpressure inside the switch fabric via
+         * sending to ports that have link down.
          **************************************************/
         if (portPtr->UpdatePortMask)
         {
@@ -1383,6 +1740,55 @@ fm_status fmUpdateSwitchPortMasks(fm_int sw)
         }
     }
 
+    /* The pass covered every pending update it was given */
+    if (changedMask != NULL)
+    {
+        FM_PORTMASK_CLEAR_PORTS(&swstate->cardinalPortInfo.pendingMaskUpdate,
+                                &swstate->cardinalPortInfo.pendingMaskUpdate,
+                                changedMask);
+    }
+    else
+    {
+        FM_PORTMASK_DISABLE_ALL(&swstate->cardinalPortInfo.pendingMaskUpdate);
+    }
+
+    return err;
+
+}   /* end UpdatePortMasks */
+
+
+
+
+/*****************************************************************************/
+/** fmUpdateSwitchPortMasks
+ * \ingroup intPort
+ *
+ * \desc            Update switch port masks based upon port link states.
+ *                  Every cardinal port's mask is rewritten, which also
+ *                  applies any update deferred by
+ *                  ''fmDeferSwitchPortMaskUpdate''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmUpdateSwitchPortMasks(fm_int sw)
+{
+    fm_status err;
+
+    /**************************************************
+     * Capture the PORT_ATTR lock for the exclusive
+     * access to portPtr->portMask and REG lock for the
+     * exclusive access to switch register
+     * (i.e. PORT_CFG_2).
+     **************************************************/
+
+    FM_TAKE_PORT_ATTR_LOCK(sw);
+    TAKE_REG_LOCK(sw);
+
+    err = UpdatePortMasks(sw, NULL);
+
     DROP_REG_LOCK(sw);
     FM_DROP_PORT_ATTR_LOCK(sw);
 
@@ -1393,6 +1799,144 @@ fm_status fmUpdateSwitchPortMasks(fm_int sw)
 
 
 
+/*****************************************************************************/
+/** fmUpdateSwitchPortMasksForPort
+ * \ingroup intPort
+ *
+ * \desc            Update the switch port masks affected by a state change
+ *                  of one cardinal port, together with any update deferred
+ *                  by ''fmDeferSwitchPortMaskUpdate''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical number of the changed cardinal port.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_PORT if port is not a cardinal port.
+ *
+ *****************************************************************************/
+fm_status fmUpdateSwitchPortMasksForPort(fm_int sw, fm_int port)
+{
+    fm_switch * switchPtr;
+    fm_portmask changedMask;
+    fm_status   err;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_TAKE_PORT_ATTR_LOCK(sw);
+
+    changedMask = switchPtr->cardinalPortInfo.pendingMaskUpdate;
+
+    err = fmEnablePortInPortMask(sw, &changedMask, port);
+
+    if (err == FM_OK)
+    {
+        TAKE_REG_LOCK(sw);
+        err = UpdatePortMasks(sw, &changedMask);
+        DROP_REG_LOCK(sw);
+    }
+
+    FM_DROP_PORT_ATTR_LOCK(sw);
+
+    return err;
+
+}   /* end fmUpdateSwitchPortMasksForPort */
+
+
+
+
+/*****************************************************************************/
+/** fmDeferSwitchPortMaskUpdate
+ * \ingroup intPort
+ *
+ * \desc            Records a link state change of a cardinal port so that
+ *                  the switch port masks depending on it are updated by the
+ *                  next ''fmFlushSwitchPortMaskUpdates''. A burst of port
+ *                  events thus costs one register update pass.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical number of the changed cardinal port.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_PORT if port is not a cardinal port.
+ *
+ *****************************************************************************/
+fm_status fmDeferSwitchPortMaskUpdate(fm_int sw, fm_int port)
+{
+    fm_cardinalPortInfo *cardinalPortInfo;
+    fm_status            err;
+
+    cardinalPortInfo = &GET_SWITCH_PTR(sw)->cardinalPortInfo;
+
+    FM_TAKE_PORT_ATTR_LOCK(sw);
+
+    if ( FM_PORTMASK_IS_ZERO(&cardinalPortInfo->pendingMaskUpdate) )
+    {
+        cardinalPortInfo->pendingMaskNsec = fmGetMonotonicNsec();
+    }
+
+    err = fmEnablePortInPortMask(sw, &cardinalPortInfo->pendingMaskUpdate, port);
+
+    FM_DROP_PORT_ATTR_LOCK(sw);
+
+    return err;
+
+}   /* end fmDeferSwitchPortMaskUpdate */
+
+
+
+
+/*****************************************************************************/
+/** fmFlushSwitchPortMaskUpdates
+ * \ingroup intPort
+ *
+ * \desc            Applies the switch port mask updates deferred by
+ *                  ''fmDeferSwitchPortMaskUpdate'' in one pass, rewriting
+ *                  only the masks that depend on the changed ports.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       maxDelay is the coalescing window in nanoseconds: the
+ *                  updates are only applied once the oldest of them has
+ *                  been pending for at least this long. Zero applies them
+ *                  unconditionally.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmFlushSwitchPortMaskUpdates(fm_int sw, fm_uint64 maxDelay)
+{
+    fm_cardinalPortInfo *cardinalPortInfo;
+    fm_portmask          changedMask;
+    fm_status            err;
+
+    cardinalPortInfo = &GET_SWITCH_PTR(sw)->cardinalPortInfo;
+    err              = FM_OK;
+
+    FM_TAKE_PORT_ATTR_LOCK(sw);
+
+    changedMask = cardinalPortInfo->pendingMaskUpdate;
+
+    if ( !FM_PORTMASK_IS_ZERO(&changedMask) &&
+         ( (maxDelay == 0) ||
+           (fmGetMonotonicNsec() - cardinalPortInfo->pendingMaskNsec >=
+            maxDelay) ) )
+    {
+        TAKE_REG_LOCK(sw);
+        err = UpdatePortMasks(sw, &changedMask);
+        DROP_REG_LOCK(sw);
+    }
+
+    FM_DROP_PORT_ATTR_LOCK(sw);
+
+    return err;
+
+}   /* end fmFlushSwitchPortMaskUpdates */
+
+
+
+
 /*****************************************************************************/
 /** fmSetFaultState
  * \ingroup intPort
@@ -49,6 +49,7 @@
  * Local function prototypes.
  *****************************************************************************/
 static fm_int CountBitsInWord(fm_uint32 word);
+static fm_uint32 ValidBitsInWord(fm_int wordNo, fm_int numBits);
 
 
 /*****************************************************************************
@@ -80,6 +81,41 @@ static fm_int CountBitsInWord(fm_uint32 word)
 }   /* end CountBitsInWord */
 
 
+
+
+/*****************************************************************************/
+/** ValidBitsInWord
+ *
+ * \desc            Helper function that returns the mask of bits in one
+ *                  port mask word that lie below a bit limit.
+ *
+ * \param[in]       wordNo is the index of the port mask word.
+ *
+ * \param[in]       numBits is the number of valid bits in the port mask.
+ *
+ * \return          The mask of valid bits in the word.
+ *
+ *****************************************************************************/
+static fm_uint32 ValidBitsInWord(fm_int wordNo, fm_int numBits)
+{
+    fm_int  limit;
+
+    limit = numBits - (wordNo * 32);
+
+    if (limit <= 0)
+    {
+        return 0;
+    }
+    else if (limit >= 32)
+    {
+        return 0xffffffff;
+    }
+
+    return (1U << limit) - 1;
+
+}   /* end ValidBitsInWord */
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -144,7 +180,10 @@ fm_status fmPortMaskToBitArray(fm_portmask* maskPtr,
                                fm_bitArray* arrayPtr,
                                fm_int       numPorts)
 {
+    fm_int      wordNo;
     fm_int      bitNo;
+    fm_int      runLen;
+    fm_uint32   bits;
     fm_status   err;
 
     if (maskPtr == NULL || arrayPtr == NULL || 
@@ -164,15 +203,27 @@ fm_status fmPortMaskToBitArray(fm_portmask* maskPtr,
         numPorts = arrayPtr->bitCount;
     }
 
-    for (bitNo = 0 ; bitNo < numPorts; bitNo++)
+    /* Copy each run of consecutive ports as a single block. */
+    for (wordNo = 0 ; wordNo < FM_PORTMASK_NUM_WORDS ; wordNo++)
     {
-        if (FM_PORTMASK_IS_BIT_SET(maskPtr, bitNo))
+        bits = maskPtr->maskWord[wordNo] & ValidBitsInWord(wordNo, numPorts);
+
+        while (bits != 0)
         {
-            err = fmSetBitArrayBit(arrayPtr, bitNo, 1);
+            bitNo  = __builtin_ctz(bits);
+            runLen = (~bits >> bitNo) ? __builtin_ctz(~bits >> bitNo)
+                                      : 32 - bitNo;
+
+            err = fmSetBitArrayBlock(arrayPtr,
+                                     (wordNo * 32) + bitNo,
+                                     runLen,
+                                     TRUE);
             if (err != FM_OK)
             {
                 return err;
             }
+
+            bits &= ~(ValidBitsInWord(0, bitNo + runLen));
         }
     }
 
@@ -314,8 +365,11 @@ fm_status fmPortMaskLogicalToPhysical(fm_switch *   switchPtr,
                                       fm_portmask * logMask,
                                       fm_portmask * physMask)
 {
+    fm_cardinalPortInfo * cardinalPortInfo;
+    fm_int      wordNo;
     fm_int      cpi;
     fm_int      physPort;
+    fm_uint32   bits;
     fm_portmask newMask;
 
     FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH,
@@ -328,14 +382,27 @@ fm_status fmPortMaskLogicalToPhysical(fm_switch *   switchPtr,
                          logMask->maskWord[0],
                          (void *) physMask);
 
+    cardinalPortInfo = &switchPtr->cardinalPortInfo;
+
     FM_PORTMASK_DISABLE_ALL(&newMask);
 
-    for (cpi = 0 ; cpi < switchPtr->numCardinalPorts ; cpi++)
+    for (wordNo = 0 ; wordNo < FM_PORTMASK_NUM_WORDS ; wordNo++)
     {
-        if (FM_PORTMASK_IS_BIT_SET(logMask, cpi))
+        bits = logMask->maskWord[wordNo] &
+               ValidBitsInWord(wordNo, switchPtr->numCardinalPorts);
+
+        if (cardinalPortInfo->identityMap)
         {
-            physPort = switchPtr->cardinalPortInfo.portMap[cpi].physPort;
+            newMask.maskWord[wordNo] = bits;
+            continue;
+        }
+
+        while (bits != 0)
+        {
+            cpi      = (wordNo * 32) + __builtin_ctz(bits);
+            physPort = cardinalPortInfo->portMap[cpi].physPort;
             FM_PORTMASK_ENABLE_BIT(&newMask, physPort);
+            bits &= (bits - 1);
         }
     }
 
@@ -368,8 +435,12 @@ fm_status fmPortMaskPhysicalToLogical(fm_switch *   switchPtr,
                                       fm_portmask * physMask,
                                       fm_portmask * logMask)
 {
+    fm_cardinalPortInfo * cardinalPortInfo;
+    fm_int      wordNo;
     fm_int      cpi;
     fm_int      physPort;
+    fm_uint32   bits;
+    fm_portmask newMask;
 
     FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH,
                          "sw = %d, "
@@ -381,18 +452,37 @@ fm_status fmPortMaskPhysicalToLogical(fm_switch *   switchPtr,
                          physMask->maskWord[0],
                          (void *) logMask);
 
-    FM_PORTMASK_DISABLE_ALL(logMask);
+    cardinalPortInfo = &switchPtr->cardinalPortInfo;
+
+    FM_PORTMASK_DISABLE_ALL(&newMask);
 
-    for (cpi = 0 ; cpi < switchPtr->numCardinalPorts ; cpi++)
+    for (wordNo = 0 ; wordNo < FM_PORTMASK_NUM_WORDS ; wordNo++)
     {
-        physPort = switchPtr->cardinalPortInfo.portMap[cpi].physPort;
+        bits = physMask->maskWord[wordNo];
+
+        if (cardinalPortInfo->identityMap)
+        {
+            newMask.maskWord[wordNo] =
+                bits & ValidBitsInWord(wordNo, switchPtr->numCardinalPorts);
+            continue;
+        }
 
-        if (FM_PORTMASK_IS_BIT_SET(physMask, physPort))
+        while (bits != 0)
         {
-            FM_PORTMASK_ENABLE_BIT(logMask, cpi);
+            physPort = (wordNo * 32) + __builtin_ctz(bits);
+            cpi      = cardinalPortInfo->physIndexTable[physPort];
+
+            if (cpi >= 0)
+            {
+                FM_PORTMASK_ENABLE_BIT(&newMask, cpi);
+            }
+
+            bits &= (bits - 1);
         }
     }
 
+    *logMask = newMask;
+
     FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_SWITCH, FM_OK);
 
 }   /* end fmPortMaskPhysicalToLogical */
@@ -422,11 +512,6 @@ fm_status fmPortMaskLogicalToLinkUpMask(fm_switch *   switchPtr,
                                         fm_portmask * logMask,
                                         fm_portmask * upMask)
 {
-    fm_int      cpi;
-    fm_int      port;
-    fm_portmask um;
-    fm_bool     isMgmtPort;
-
     FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH,
                          "sw = %d, "
                          "logMask = 0x%06x %08x %08x, "
@@ -437,22 +522,8 @@ fm_status fmPortMaskLogicalToLinkUpMask(fm_switch *   switchPtr,
                          logMask->maskWord[0],
                          (void *) upMask);
 
-    FM_PORTMASK_DISABLE_ALL(&um);
-
-    for (cpi = 0 ; cpi < switchPtr->numCardinalPorts ; cpi++)
-    {
-        port = switchPtr->cardinalPortInfo.portMap[cpi].logPort;
-
-        isMgmtPort = fmIsMgmtPort(switchPtr->switchNumber, port);
-        
-        /* MGMT ports are always available to send to */
-        if ( switchPtr->portTable[port]->linkUp || isMgmtPort)
-        {
-            FM_PORTMASK_ENABLE_BIT(&um, cpi);
-        }
-    }
-
-    FM_AND_PORTMASKS(upMask, logMask, &um);
+    /* The link-up mask is maintained by fmUpdateCardinalPortState. */
+    FM_AND_PORTMASKS(upMask, logMask, &switchPtr->cardinalPortInfo.linkUpMask);
 
     FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_SWITCH, FM_OK);
 
@@ -171,6 +171,169 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fmSetPortQOSList
+ * \ingroup qos
+ *
+ * \chips           FM10000
+ *
+ * \desc            Apply a QoS profile, given as a list of port QoS
+ *                  attributes, to each port in a list of ports. Each
+ *                  attribute is set as with ''fmSetPortQOS''.
+ *                                                                      \lb\lb
+ *                  All ports are validated before any attribute is set,
+ *                  and the shared memory watermarks are recomputed once
+ *                  after the whole profile has been applied instead of
+ *                  after each attribute.
+ *                                                                      \lb\lb
+ *                  If setting an attribute fails, the attributes already
+ *                  set remain applied and the rest of the profile is not
+ *                  applied.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numPorts is the number of entries in portList.
+ *
+ * \param[in]       portList is an array of logical port numbers. May contain
+ *                  LAG logical ports and the CPU interface.
+ *
+ * \param[in]       numAttrs is the number of entries in attrList, indexList
+ *                  and valueList.
+ *
+ * \param[in]       attrList is an array of port QoS attributes
+ *                  (see 'Port QoS Attributes').
+ *
+ * \param[in]       indexList is an array of attribute-specific indexes, one
+ *                  per attribute. See ''fmSetPortQOS''.
+ *
+ * \param[in]       valueList is an array of pointers to the attribute values.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an array is NULL, numPorts or
+ *                  numAttrs is not positive, or an index or value is invalid.
+ * \return          FM_ERR_INVALID_PORT if a port is invalid.
+ * \return          FM_ERR_INVALID_ATTRIB if an attribute is invalid.
+ *
+ *****************************************************************************/
+fm_status fmSetPortQOSList(fm_int  sw,
+                           fm_int  numPorts,
+                           fm_int *portList,
+                           fm_int  numAttrs,
+                           fm_int *attrList,
+                           fm_int *indexList,
+                           void ** valueList)
+{
+    fm_switch *switchPtr;
+    fm_port *  portPtr;
+    fm_status  err = FM_OK;
+    fm_status  err2;
+    fm_int     members[FM_MAX_NUM_LAG_MEMBERS];
+    fm_int     numMembers;
+    fm_int     cnt;
+    fm_int     i;
+    fm_int     j;
+    fm_bool    updateStarted;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_QOS,
+                     "sw=%d numPorts=%d portList=%p numAttrs=%d "
+                     "attrList=%p indexList=%p valueList=%p\n",
+                     sw,
+                     numPorts,
+                     (void *) portList,
+                     numAttrs,
+                     (void *) attrList,
+                     (void *) indexList,
+                     (void *) valueList);
+
+    if ( (numPorts <= 0) ||
+         (numAttrs <= 0) ||
+         (portList == NULL) ||
+         (attrList == NULL) ||
+         (indexList == NULL) ||
+         (valueList == NULL) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_QOS, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr     = GET_SWITCH_PTR(sw);
+    updateStarted = FALSE;
+
+    for (i = 0 ; i < numPorts ; i++)
+    {
+        if ( !fmIsValidPort(sw, portList[i], ALLOW_CPU | ALLOW_LAG) )
+        {
+            err = FM_ERR_INVALID_PORT;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+        }
+    }
+
+    for (j = 0 ; j < numAttrs ; j++)
+    {
+        if (valueList[j] == NULL)
+        {
+            err = FM_ERR_INVALID_ARGUMENT;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+        }
+    }
+
+    if (switchPtr->BeginPortAttributeUpdate != NULL)
+    {
+        err = switchPtr->BeginPortAttributeUpdate(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+        updateStarted = TRUE;
+    }
+
+    for (i = 0 ; i < numPorts ; i++)
+    {
+        err = fmGetLAGCardinalPortList(sw,
+                                       portList[i],
+                                       &numMembers,
+                                       members,
+                                       FM_MAX_NUM_LAG_MEMBERS);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_QOS, err);
+
+        for (cnt = 0 ; cnt < numMembers ; cnt++)
+        {
+            portPtr = switchPtr->portTable[members[cnt]];
+
+            for (j = 0 ; j < numAttrs ; j++)
+            {
+                FM_API_CALL_FAMILY(err,
+                                   portPtr->SetPortQOS,
+                                   sw,
+                                   members[cnt],
+                                   attrList[j],
+                                   indexList[j],
+                                   valueList[j]);
+                FM_LOG_ABORT_ON_ERR_V2(FM_LOG_CAT_QOS, members[cnt], err);
+            }
+        }
+    }
+
+ABORT:
+
+    if (updateStarted)
+    {
+        err2 = switchPtr->EndPortAttributeUpdate(sw);
+
+        if (err == FM_OK)
+        {
+            err = err2;
+        }
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_QOS, err);
+
+}   /* end fmSetPortQOSList */
+
+
+
+
 /*****************************************************************************/
 /** fmGetPortQOS
  * \ingroup qos
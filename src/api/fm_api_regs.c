@@ -90,6 +90,637 @@
  * Local Functions
  *****************************************************************************/
 
+/*****************************************************************************/
+/** BatchIsOwned
+ * \ingroup intSwitch
+ *
+ * \desc            Tells whether the calling thread has a register write
+ *                  batch open on a switch.
+ *
+ * \param[in]       batch points to the write batch state of the switch.
+ *
+ * \return          TRUE if the calling thread owns the batch.
+ * \return          FALSE otherwise.
+ *
+ *****************************************************************************/
+static fm_bool BatchIsOwned(fm_regBatch *batch)
+{
+    return (batch->owner != NULL && batch->owner == fmGetCurrentThreadId());
+
+}   /* end BatchIsOwned */
+
+
+
+
+/*****************************************************************************/
+/** BatchFind
+ * \ingroup intSwitch
+ *
+ * \desc            Looks up the value queued for a register in a write batch.
+ *
+ * \param[in]       batch points to the write batch state of the switch.
+ *
+ * \param[in]       addr is the register address.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function places the queued value, if any.
+ *
+ * \return          TRUE if a write to addr is queued.
+ * \return          FALSE otherwise.
+ *
+ *****************************************************************************/
+static fm_bool BatchFind(fm_regBatch *batch, fm_uint32 addr, fm_uint32 *value)
+{
+    void *entry;
+
+    if (batch->numWrites == 0 ||
+        fmHashMapFind(&batch->index, addr, &entry) != FM_OK)
+    {
+        return FALSE;
+    }
+
+    *value = batch->writes[(unsigned long) entry - 1].value;
+
+    return TRUE;
+
+}   /* end BatchFind */
+
+
+
+
+/*****************************************************************************/
+/** BatchQueue
+ * \ingroup intSwitch
+ *
+ * \desc            Queues a register write in a write batch, replacing any
+ *                  write to the same register already queued.
+ *
+ * \param[in]       batch points to the write batch state of the switch.
+ *
+ * \param[in]       addr is the register address.
+ *
+ * \param[in]       value is the value to write.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if the queue could not be grown.
+ *
+ *****************************************************************************/
+static fm_status BatchQueue(fm_regBatch *batch, fm_uint32 addr, fm_uint32 value)
+{
+    fm_regBatchWrite *writes;
+    fm_status         err;
+    fm_int            maxWrites;
+    void *            entry;
+
+    if (fmHashMapFind(&batch->index, addr, &entry) == FM_OK)
+    {
+        batch->writes[(unsigned long) entry - 1].value = value;
+        return FM_OK;
+    }
+
+    if (batch->numWrites == batch->maxWrites)
+    {
+        maxWrites = (batch->maxWrites > 0) ? batch->maxWrites * 2 : 64;
+
+        writes = fmAlloc(maxWrites * sizeof(fm_regBatchWrite));
+
+        if (writes == NULL)
+        {
+            return FM_ERR_NO_MEM;
+        }
+
+        if (batch->writes != NULL)
+        {
+            FM_MEMCPY_S(writes,
+                        maxWrites * sizeof(fm_regBatchWrite),
+                        batch->writes,
+                        batch->numWrites * sizeof(fm_regBatchWrite));
+            fmFree(batch->writes);
+        }
+
+        batch->writes    = writes;
+        batch->maxWrites = maxWrites;
+    }
+
+    err = fmHashMapInsert(&batch->index,
+                          addr,
+                          (void *) (unsigned long) (batch->numWrites + 1));
+
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    batch->writes[batch->numWrites].addr  = addr;
+    batch->writes[batch->numWrites].value = value;
+    batch->numWrites++;
+
+    return FM_OK;
+
+}   /* end BatchQueue */
+
+
+
+
+/*****************************************************************************/
+/** CompareBatchWrites
+ * \ingroup intSwitch
+ *
+ * \desc            Orders two queued register writes by address, for qsort.
+ *
+ * \param[in]       a points to the first write.
+ *
+ * \param[in]       b points to the second write.
+ *
+ * \return          Negative, zero or positive as a's address is lower than,
+ *                  equal to or higher than b's.
+ *
+ *****************************************************************************/
+static int CompareBatchWrites(const void *a, const void *b)
+{
+    fm_uint32 addrA = ( (const fm_regBatchWrite *) a )->addr;
+    fm_uint32 addrB = ( (const fm_regBatchWrite *) b )->addr;
+
+    return (addrA > addrB) - (addrA < addrB);
+
+}   /* end CompareBatchWrites */
+
+
+
+
+/*****************************************************************************/
+/** BatchWriteUINT32
+ * \ingroup intSwitch
+ *
+ * \desc            Replaces the WriteUINT32 function of a switch while a
+ *                  write batch is open. The write is queued if the calling
+ *                  thread owns the batch and issued directly otherwise.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[in]       value is the value to write.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status BatchWriteUINT32(fm_int sw, fm_uint reg, fm_uint32 value)
+{
+    fm_regBatch *batch = &GET_SWITCH_PTR(sw)->regBatch;
+
+    if (!BatchIsOwned(batch))
+    {
+        return batch->WriteUINT32(sw, reg, value);
+    }
+
+    return BatchQueue(batch, reg, value);
+
+}   /* end BatchWriteUINT32 */
+
+
+
+
+/*****************************************************************************/
+/** BatchWriteUINT32Mult
+ * \ingroup intSwitch
+ *
+ * \desc            Replaces the WriteUINT32Mult function of a switch while
+ *                  a write batch is open, see ''BatchWriteUINT32''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the address of the first register.
+ *
+ * \param[in]       count is the number of registers to write.
+ *
+ * \param[in]       ptr points to the count values to write.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status BatchWriteUINT32Mult(fm_int     sw,
+                                      fm_uint    reg,
+                                      fm_int     count,
+                                      fm_uint32 *ptr)
+{
+    fm_regBatch *batch = &GET_SWITCH_PTR(sw)->regBatch;
+    fm_status    err;
+    fm_int       i;
+
+    if (!BatchIsOwned(batch))
+    {
+        return batch->WriteUINT32Mult(sw, reg, count, ptr);
+    }
+
+    for (i = 0 ; i < count ; i++)
+    {
+        err = BatchQueue(batch, reg + i, ptr[i]);
+
+        if (err != FM_OK)
+        {
+            return err;
+        }
+    }
+
+    return FM_OK;
+
+}   /* end BatchWriteUINT32Mult */
+
+
+
+
+/*****************************************************************************/
+/** BatchWriteUINT64
+ * \ingroup intSwitch
+ *
+ * \desc            Replaces the WriteUINT64 function of a switch while a
+ *                  write batch is open, see ''BatchWriteUINT32''. The low
+ *                  word is queued at reg and the high word at reg + 1.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[in]       value is the value to write.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status BatchWriteUINT64(fm_int sw, fm_uint reg, fm_uint64 value)
+{
+    fm_regBatch *batch = &GET_SWITCH_PTR(sw)->regBatch;
+    fm_status    err;
+
+    if (!BatchIsOwned(batch))
+    {
+        return batch->WriteUINT64(sw, reg, value);
+    }
+
+    err = BatchQueue(batch, reg, (fm_uint32) value);
+
+    if (err == FM_OK)
+    {
+        err = BatchQueue(batch, reg + 1, (fm_uint32) (value >> 32));
+    }
+
+    return err;
+
+}   /* end BatchWriteUINT64 */
+
+
+
+
+/*****************************************************************************/
+/** BatchWriteUINT64Mult
+ * \ingroup intSwitch
+ *
+ * \desc            Replaces the WriteUINT64Mult function of a switch while
+ *                  a write batch is open, see ''BatchWriteUINT64''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the address of the first register.
+ *
+ * \param[in]       count is the number of 64-bit registers to write.
+ *
+ * \param[in]       ptr points to the count values to write.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status BatchWriteUINT64Mult(fm_int     sw,
+                                      fm_uint    reg,
+                                      fm_int     count,
+                                      fm_uint64 *ptr)
+{
+    fm_regBatch *batch = &GET_SWITCH_PTR(sw)->regBatch;
+    fm_status    err;
+    fm_int       i;
+
+    if (!BatchIsOwned(batch))
+    {
+        return batch->WriteUINT64Mult(sw, reg, count, ptr);
+    }
+
+    for (i = 0 ; i < count ; i++)
+    {
+        err = BatchQueue(batch, reg + 2 * i, (fm_uint32) ptr[i]);
+
+        if (err == FM_OK)
+        {
+            err = BatchQueue(batch,
+                             reg + 2 * i + 1,
+                             (fm_uint32) (ptr[i] >> 32));
+        }
+
+        if (err != FM_OK)
+        {
+            return err;
+        }
+    }
+
+    return FM_OK;
+
+}   /* end BatchWriteUINT64Mult */
+
+
+
+
+/*****************************************************************************/
+/** BatchReadUINT32
+ * \ingroup intSwitch
+ *
+ * \desc            Replaces the ReadUINT32 function of a switch while a
+ *                  write batch is open. A register with a queued write
+ *                  reads as the queued value for the thread that owns
+ *                  the batch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function places the register value.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status BatchReadUINT32(fm_int sw, fm_uint reg, fm_uint32 *value)
+{
+    fm_regBatch *batch = &GET_SWITCH_PTR(sw)->regBatch;
+
+    if (BatchIsOwned(batch) && BatchFind(batch, reg, value))
+    {
+        return FM_OK;
+    }
+
+    return batch->ReadUINT32(sw, reg, value);
+
+}   /* end BatchReadUINT32 */
+
+
+
+
+/*****************************************************************************/
+/** BatchReadUINT32Mult
+ * \ingroup intSwitch
+ *
+ * \desc            Replaces the ReadUINT32Mult function of a switch while
+ *                  a write batch is open, see ''BatchReadUINT32''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the address of the first register.
+ *
+ * \param[in]       count is the number of registers to read.
+ *
+ * \param[out]      value points to caller-allocated storage of count words
+ *                  where this function places the register values.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status BatchReadUINT32Mult(fm_int     sw,
+                                     fm_uint    reg,
+                                     fm_int     count,
+                                     fm_uint32 *value)
+{
+    fm_regBatch *batch = &GET_SWITCH_PTR(sw)->regBatch;
+    fm_status    err;
+    fm_int       i;
+
+    err = batch->ReadUINT32Mult(sw, reg, count, value);
+
+    if (err == FM_OK && BatchIsOwned(batch))
+    {
+        for (i = 0 ; i < count ; i++)
+        {
+            BatchFind(batch, reg + i, &value[i]);
+        }
+    }
+
+    return err;
+
+}   /* end BatchReadUINT32Mult */
+
+
+
+
+/*****************************************************************************/
+/** BatchReadUINT64
+ * \ingroup intSwitch
+ *
+ * \desc            Replaces the ReadUINT64 function of a switch while a
+ *                  write batch is open, see ''BatchReadUINT32''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function places the register value.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status BatchReadUINT64(fm_int sw, fm_uint reg, fm_uint64 *value)
+{
+    fm_regBatch *batch = &GET_SWITCH_PTR(sw)->regBatch;
+    fm_status    err;
+    fm_uint32    lo;
+    fm_uint32    hi;
+
+    err = batch->ReadUINT64(sw, reg, value);
+
+    if (err == FM_OK && BatchIsOwned(batch))
+    {
+        lo = (fm_uint32) *value;
+        hi = (fm_uint32) (*value >> 32);
+
+        BatchFind(batch, reg, &lo);
+        BatchFind(batch, reg + 1, &hi);
+
+        *value = ( (fm_uint64) hi << 32 ) | lo;
+    }
+
+    return err;
+
+}   /* end BatchReadUINT64 */
+
+
+
+
+/*****************************************************************************/
+/** BatchReadUINT64Mult
+ * \ingroup intSwitch
+ *
+ * \desc            Replaces the ReadUINT64Mult function of a switch while
+ *                  a write batch is open, see ''BatchReadUINT32''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the address of the first register.
+ *
+ * \param[in]       count is the number of 64-bit registers to read.
+ *
+ * \param[out]      value points to caller-allocated storage of count
+ *                  long words where this function places the register
+ *                  values.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status BatchReadUINT64Mult(fm_int     sw,
+                                     fm_uint    reg,
+                                     fm_int     count,
+                                     fm_uint64 *value)
+{
+    fm_regBatch *batch = &GET_SWITCH_PTR(sw)->regBatch;
+    fm_status    err;
+    fm_uint32    lo;
+    fm_uint32    hi;
+    fm_int       i;
+
+    err = batch->ReadUINT64Mult(sw, reg, count, value);
+
+    if (err == FM_OK && BatchIsOwned(batch))
+    {
+        for (i = 0 ; i < count ; i++)
+        {
+            lo = (fm_uint32) value[i];
+            hi = (fm_uint32) (value[i] >> 32);
+
+            BatchFind(batch, reg + 2 * i, &lo);
+            BatchFind(batch, reg + 2 * i + 1, &hi);
+
+            value[i] = ( (fm_uint64) hi << 32 ) | lo;
+        }
+    }
+
+    return err;
+
+}   /* end BatchReadUINT64Mult */
+
+
+
+
+/*****************************************************************************/
+/** BatchMaskUINT32
+ * \ingroup intSwitch
+ *
+ * \desc            Replaces the MaskUINT32 function of a switch while a
+ *                  write batch is open. For the thread that owns the batch,
+ *                  the masked value is queued as a write.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[in]       mask is the mask of bits to set or clear.
+ *
+ * \param[in]       on is TRUE to set the bits and FALSE to clear them.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status BatchMaskUINT32(fm_int    sw,
+                                 fm_uint   reg,
+                                 fm_uint32 mask,
+                                 fm_bool   on)
+{
+    fm_regBatch *batch = &GET_SWITCH_PTR(sw)->regBatch;
+    fm_status    err;
+    fm_uint32    value;
+
+    if (!BatchIsOwned(batch))
+    {
+        return batch->MaskUINT32(sw, reg, mask, on);
+    }
+
+    err = BatchReadUINT32(sw, reg, &value);
+
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    value = on ? (value | mask) : (value & ~mask);
+
+    return BatchQueue(batch, reg, value);
+
+}   /* end BatchMaskUINT32 */
+
+
+
+
+/*****************************************************************************/
+/** BatchClose
+ * \ingroup intSwitch
+ *
+ * \desc            Closes the write batch of a switch, restoring its register
+ *                  access functions and discarding the queue.
+ *
+ * \note            The caller must hold the register lock.
+ *
+ * \param[in]       switchPtr points to the switch state.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BatchClose(fm_switch *switchPtr)
+{
+    fm_regBatch *batch = &switchPtr->regBatch;
+
+    /* Threads that already loaded one of the batching functions go through
+     * to the saved functions once the owner is cleared, so the saved
+     * pointers are left in place. */
+    switchPtr->WriteUINT32     = batch->WriteUINT32;
+    switchPtr->ReadUINT32      = batch->ReadUINT32;
+    switchPtr->MaskUINT32      = batch->MaskUINT32;
+    switchPtr->WriteUINT32Mult = batch->WriteUINT32Mult;
+    switchPtr->ReadUINT32Mult  = batch->ReadUINT32Mult;
+    switchPtr->WriteUINT64     = batch->WriteUINT64;
+    switchPtr->ReadUINT64      = batch->ReadUINT64;
+    switchPtr->WriteUINT64Mult = batch->WriteUINT64Mult;
+    switchPtr->ReadUINT64Mult  = batch->ReadUINT64Mult;
+
+    batch->owner = NULL;
+    batch->depth = 0;
+
+    fmHashMapDestroy(&batch->index, NULL);
+
+    if (batch->writes != NULL)
+    {
+        fmFree(batch->writes);
+    }
+
+    batch->writes    = NULL;
+    batch->numWrites = 0;
+    batch->maxWrites = 0;
+
+}   /* end BatchClose */
+
+
+
 
 /*****************************************************************************
  * Public Functions
@@ -1276,3 +1907,254 @@ fm_status fmI2cWriteRead(fm_int     sw,
     return err;
 
 }   /* end fmI2cWriteRead */
+
+
+
+
+/*****************************************************************************/
+/** fmRegBatchBegin
+ * \ingroup intSwitch
+ *
+ * \desc            Opens a register write batch on a switch for the calling
+ *                  thread. Until the matching call to ''fmRegBatchCommit'',
+ *                  the register writes this thread makes through the switch
+ *                  register access functions are queued rather than issued.
+ *                  Writes to the same register are merged, and reads of a
+ *                  register with a queued write return the queued value.
+ *                  Register accesses made by other threads are not affected.
+ *                                                                      \lb\lb
+ *                  Batches nest: each call must be matched by a call to
+ *                  ''fmRegBatchCommit'' or ''fmRegBatchAbort'', and the
+ *                  writes are issued by the outermost commit.
+ *
+ * \note            The queued writes are issued in register address order,
+ *                  not in the order they were made. Only write sequences
+ *                  whose effect does not depend on their order, and that
+ *                  do not wait on the hardware between writes, may be
+ *                  batched.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_STATE if another thread has a batch open
+ *                  on the switch.
+ *
+ *****************************************************************************/
+fm_status fmRegBatchBegin(fm_int sw)
+{
+    fm_switch *  switchPtr;
+    fm_regBatch *batch;
+    void *       self;
+    fm_status    err;
+
+    VALIDATE_AND_PROTECT_SW(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    batch     = &switchPtr->regBatch;
+    self      = fmGetCurrentThreadId();
+    err       = FM_OK;
+
+    TAKE_REG_LOCK(sw);
+
+    if (batch->owner == self)
+    {
+        batch->depth++;
+    }
+    else if (batch->owner != NULL)
+    {
+        err = FM_ERR_INVALID_STATE;
+    }
+    else
+    {
+        fmHashMapInit(&batch->index);
+
+        batch->WriteUINT32     = switchPtr->WriteUINT32;
+        batch->ReadUINT32      = switchPtr->ReadUINT32;
+        batch->MaskUINT32      = switchPtr->MaskUINT32;
+        batch->WriteUINT32Mult = switchPtr->WriteUINT32Mult;
+        batch->ReadUINT32Mult  = switchPtr->ReadUINT32Mult;
+        batch->WriteUINT64     = switchPtr->WriteUINT64;
+        batch->ReadUINT64      = switchPtr->ReadUINT64;
+        batch->WriteUINT64Mult = switchPtr->WriteUINT64Mult;
+        batch->ReadUINT64Mult  = switchPtr->ReadUINT64Mult;
+
+        batch->owner = self;
+        batch->depth = 1;
+
+        switchPtr->WriteUINT32     = BatchWriteUINT32;
+        switchPtr->ReadUINT32      = BatchReadUINT32;
+        switchPtr->MaskUINT32      = BatchMaskUINT32;
+        switchPtr->WriteUINT32Mult = BatchWriteUINT32Mult;
+        switchPtr->ReadUINT32Mult  = BatchReadUINT32Mult;
+        switchPtr->WriteUINT64     = BatchWriteUINT64;
+        switchPtr->ReadUINT64      = BatchReadUINT64;
+        switchPtr->WriteUINT64Mult = BatchWriteUINT64Mult;
+        switchPtr->ReadUINT64Mult  = BatchReadUINT64Mult;
+    }
+
+    DROP_REG_LOCK(sw);
+
+    UNPROTECT_SWITCH(sw);
+
+    return err;
+
+}   /* end fmRegBatchBegin */
+
+
+
+
+/*****************************************************************************/
+/** fmRegBatchCommit
+ * \ingroup intSwitch
+ *
+ * \desc            Closes a register write batch opened by
+ *                  ''fmRegBatchBegin''. When the outermost batch is closed,
+ *                  the queued writes are sorted by address and issued in a
+ *                  single pass under the register lock, one multi-word
+ *                  write per run of consecutive addresses.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_STATE if the calling thread has no batch
+ *                  open on the switch.
+ * \return          FM_ERR_NO_MEM if there was not enough memory to issue
+ *                  the writes.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmRegBatchCommit(fm_int sw)
+{
+    fm_switch *  switchPtr;
+    fm_regBatch *batch;
+    fm_uint32 *  values;
+    fm_status    err;
+    fm_int       first;
+    fm_int       i;
+
+    VALIDATE_AND_PROTECT_SW(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    batch     = &switchPtr->regBatch;
+    values    = NULL;
+    err       = FM_OK;
+
+    TAKE_REG_LOCK(sw);
+
+    if (!BatchIsOwned(batch))
+    {
+        err = FM_ERR_INVALID_STATE;
+        goto ABORT;
+    }
+
+    if (--batch->depth > 0)
+    {
+        goto ABORT;
+    }
+
+    if (batch->numWrites > 0)
+    {
+        values = fmAlloc(batch->numWrites * sizeof(fm_uint32));
+
+        if (values == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            BatchClose(switchPtr);
+            goto ABORT;
+        }
+
+        qsort(batch->writes,
+              batch->numWrites,
+              sizeof(fm_regBatchWrite),
+              CompareBatchWrites);
+
+        for (i = 0 ; i < batch->numWrites ; i++)
+        {
+            values[i] = batch->writes[i].value;
+        }
+
+        /* Issue one write per run of consecutive addresses */
+        first = 0;
+
+        for (i = 1 ; err == FM_OK && i <= batch->numWrites ; i++)
+        {
+            if ( i < batch->numWrites &&
+                 batch->writes[i].addr == batch->writes[i - 1].addr + 1 )
+            {
+                continue;
+            }
+
+            err = batch->WriteUINT32Mult(sw,
+                                         batch->writes[first].addr,
+                                         i - first,
+                                         &values[first]);
+            first = i;
+        }
+    }
+
+    BatchClose(switchPtr);
+
+ABORT:
+    DROP_REG_LOCK(sw);
+
+    if (values != NULL)
+    {
+        fmFree(values);
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    return err;
+
+}   /* end fmRegBatchCommit */
+
+
+
+
+/*****************************************************************************/
+/** fmRegBatchAbort
+ * \ingroup intSwitch
+ *
+ * \desc            Closes the register write batch opened by the calling
+ *                  thread, at every nesting level, and discards the queued
+ *                  writes without issuing them.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_STATE if the calling thread has no batch
+ *                  open on the switch.
+ *
+ *****************************************************************************/
+fm_status fmRegBatchAbort(fm_int sw)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    VALIDATE_AND_PROTECT_SW(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    err       = FM_OK;
+
+    TAKE_REG_LOCK(sw);
+
+    if (BatchIsOwned(&switchPtr->regBatch))
+    {
+        BatchClose(switchPtr);
+    }
+    else
+    {
+        err = FM_ERR_INVALID_STATE;
+    }
+
+    DROP_REG_LOCK(sw);
+
+    UNPROTECT_SWITCH(sw);
+
+    return err;
+
+}   /* end fmRegBatchAbort */
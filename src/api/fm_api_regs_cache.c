@@ -42,6 +42,17 @@
 
 #define CACHE_BURST_SIZE    512
 
+/* Number of times a read from the cache is retried without the register
+ * lock after racing with a writer, before falling back to the lock */
+#define CACHE_READ_RETRIES  8
+
+/* Register cache snapshot file identification, see fmRegCacheSaveSnapshot */
+#define SNAPSHOT_MAGIC      0x464d5243
+#define SNAPSHOT_VERSION    1
+
+/* Number of words in the header of each register set in a snapshot */
+#define SNAPSHOT_SET_WORDS  9
+
 
 /*****************************************************************************
  * Local function prototypes
@@ -55,6 +66,13 @@ static fm_status fmRegCacheInitKeyValid(fm_int sw, const fm_cachedRegs **regs);
 
 static fm_status fmRegCacheFreeKeyValid(fm_int sw, const fm_cachedRegs **regs);
 
+static fm_status fmRegCacheInitWriteStats(fm_int sw, const fm_cachedRegs **regs);
+
+static void fmRegCacheFreeWriteStats(fm_int sw);
+
+static fm_regCacheWriteStats *fmRegCacheGetWriteStats(fm_int               sw,
+                                                      const fm_cachedRegs *regs);
+
 static fm_uint32 fmRegCacheComputeOffset(const fm_uint32     *idx,
                                          const fm_cachedRegs *reg);
 
@@ -69,7 +87,8 @@ static void fmRegCacheConvSGEntry(fm_int                        sw,
                                   fm_int *                      nDest,
                                   const fm_registerSGListEntry *src,
                                   fm_scatterGatherListEntry    *dest,
-                                  fm_bool                       trimUnchanged);
+                                  fm_bool                       trimUnchanged,
+                                  fm_regCacheWriteStats *       stats);
 
 static fm_bool fmRegCacheStrideIsContiguous(const fm_cachedRegs *regs);
 
@@ -77,12 +96,42 @@ static fm_int fmRegCacheConvSGList(fm_int                        sw,
                                    fm_int                        nSrc,
                                    const fm_registerSGListEntry *src,
                                    fm_scatterGatherListEntry    *dest,
-                                   fm_bool                       trimUnchanged);
+                                   fm_bool                       trimUnchanged,
+                                   fm_bool                       countWrites);
 
 static fm_status fmRegCacheReadNC(fm_int                        sw,
                                   fm_int                        nEntries,
                                   const fm_registerSGListEntry *sgList);
 
+static void fmRegCacheSeqWriteBegin(fm_int sw);
+
+static void fmRegCacheSeqWriteEnd(fm_int sw);
+
+static fm_uint32 fmRegCacheSeqReadBegin(fm_int sw);
+
+static fm_bool fmRegCacheSeqReadRetry(fm_int sw, fm_uint32 seq);
+
+static void fmRegCacheUpdateChecksums(fm_int               sw,
+                                      const fm_cachedRegs *regSet,
+                                      fm_uint32            offset,
+                                      fm_uint32            numWords,
+                                      const fm_uint32 *    data);
+
+static fm_status fmRegCacheLoadSnapshot(fm_int sw, fm_text fileName);
+
+static fm_status fmRegCacheReconcile(fm_int sw, fm_int *nPatched);
+
+static void fmRegCacheSetKeyValidBits(fm_uint32 *          data,
+                                      fm_uint              keyBit,
+                                      fm_uint              keyInvertBit,
+                                      fm_regsCacheKeyValid valid);
+
+static fm_int fmRegCacheBuildRuns(fm_int                        nEntries,
+                                  const fm_registerSGListEntry *sgList,
+                                  fm_uint32 *                   data,
+                                  const fm_bool *               flags,
+                                  fm_registerSGListEntry *      runs);
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -419,6 +468,145 @@ static fm_status fmRegCacheFreeKeyValid(fm_int sw, const fm_cachedRegs **regs)
 
 
 
+/*****************************************************************************/
+/** fmRegCacheInitWriteStats
+ * \ingroup intRegCache
+ *
+ * \desc            Allocates the write statistics of each cached register
+ *                  set and indexes them by register set descriptor.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regs is a NULL-terminated array of pointers to
+ *                  fm_cachedRegs structures, which describe all of the
+ *                  registers that need to be cached.
+ * 
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if there is not enough memory.
+ *
+ *****************************************************************************/
+static fm_status fmRegCacheInitWriteStats(fm_int sw, const fm_cachedRegs **regs)
+{
+    fm_switch *            switchPtr;
+    fm_regCacheWriteStats *stats;
+    fm_int                 nRegs;
+    fm_int                 i;
+    fm_status              err = FM_OK;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    /* a re-initialization starts the statistics over */
+    fmRegCacheFreeWriteStats(sw);
+
+    for (nRegs = 0 ; regs[nRegs] != NULL ; nRegs++)
+    {
+        /* just count the register sets */
+    }
+
+    if (nRegs == 0)
+    {
+        return FM_OK;
+    }
+
+    /* one more entry, left clear, terminates the array */
+    stats = fmAlloc( (nRegs + 1) * sizeof(fm_regCacheWriteStats) );
+
+    if (stats == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    memset( stats, 0, (nRegs + 1) * sizeof(fm_regCacheWriteStats) );
+
+    switchPtr->regCacheWriteStats = stats;
+    fmHashMapInit(&switchPtr->regCacheWriteStatsMap);
+
+    for (i = 0 ; i < nRegs ; i++)
+    {
+        stats[i].registerSet = regs[i];
+
+        err = fmHashMapInsert(&switchPtr->regCacheWriteStatsMap,
+                              (fm_uint64) (fm_uintptr) regs[i],
+                              &stats[i]);
+        if (err != FM_OK)
+        {
+            fmRegCacheFreeWriteStats(sw);
+            break;
+        }
+    }
+
+    return err;
+
+}   /* end fmRegCacheInitWriteStats */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheFreeWriteStats
+ * \ingroup intRegCache
+ *
+ * \desc            Frees the write statistics of the cached register sets.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ * 
+ * \return          None
+ *
+ *****************************************************************************/
+static void fmRegCacheFreeWriteStats(fm_int sw)
+{
+    fm_switch *switchPtr;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->regCacheWriteStats != NULL)
+    {
+        fmHashMapDestroy(&switchPtr->regCacheWriteStatsMap, NULL);
+        fmFree(switchPtr->regCacheWriteStats);
+        switchPtr->regCacheWriteStats = NULL;
+    }
+
+}   /* end fmRegCacheFreeWriteStats */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheGetWriteStats
+ * \ingroup intRegCache
+ *
+ * \desc            Returns the write statistics of a cached register set.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regs is the register set descriptor.
+ * 
+ * \return          pointer to the statistics, or NULL if there are none.
+ *
+ *****************************************************************************/
+static fm_regCacheWriteStats *fmRegCacheGetWriteStats(fm_int               sw,
+                                                      const fm_cachedRegs *regs)
+{
+    fm_switch *switchPtr;
+    void *     value;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if ( (switchPtr->regCacheWriteStats == NULL) ||
+         (fmHashMapFind(&switchPtr->regCacheWriteStatsMap,
+                        (fm_uint64) (fm_uintptr) regs,
+                        &value) != FM_OK) )
+    {
+        return NULL;
+    }
+
+    return (fm_regCacheWriteStats *) value;
+
+}   /* end fmRegCacheGetWriteStats */
+
+
+
+
 /*****************************************************************************/
 /** fmRegCacheComputeOffset
  * \ingroup intRegCache
@@ -515,6 +703,180 @@ static fm_uint32 fmRegCacheComputeAddr(const fm_uint32 *    idx,
 
 
 
+/*****************************************************************************/
+/** fmRegCacheSeqWriteBegin
+ * \ingroup intRegCache
+ *
+ * \desc            Marks the start of an update of the cache contents.
+ *                  The sequence count of the switch becomes odd, so that
+ *                  readers that do not hold the register lock retry.
+ *
+ * \note            The caller must hold the register lock, which serializes
+ *                  the writers.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+static void fmRegCacheSeqWriteBegin(fm_int sw)
+{
+    fm_uint32 *seq = &GET_SWITCH_PTR(sw)->regCacheSeq;
+
+    FM_ATOMIC_STORE_RELAXED(seq, FM_ATOMIC_LOAD_RELAXED(seq) + 1);
+
+    /* Order the count update before the cache stores */
+    FM_ATOMIC_FENCE();
+
+}   /* end fmRegCacheSeqWriteBegin */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheSeqWriteEnd
+ * \ingroup intRegCache
+ *
+ * \desc            Marks the end of an update of the cache contents started
+ *                  with ''fmRegCacheSeqWriteBegin''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+static void fmRegCacheSeqWriteEnd(fm_int sw)
+{
+    fm_uint32 *seq = &GET_SWITCH_PTR(sw)->regCacheSeq;
+
+    FM_ATOMIC_STORE(seq, FM_ATOMIC_LOAD_RELAXED(seq) + 1);
+
+}   /* end fmRegCacheSeqWriteEnd */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheSeqReadBegin
+ * \ingroup intRegCache
+ *
+ * \desc            Samples the sequence count of the cache before a read
+ *                  that does not take the register lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          The sequence count, which is odd if a writer is
+ *                  updating the cache.
+ *
+ *****************************************************************************/
+static fm_uint32 fmRegCacheSeqReadBegin(fm_int sw)
+{
+    return FM_ATOMIC_LOAD(&GET_SWITCH_PTR(sw)->regCacheSeq);
+
+}   /* end fmRegCacheSeqReadBegin */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheSeqReadRetry
+ * \ingroup intRegCache
+ *
+ * \desc            Tells whether a read of the cache made without the
+ *                  register lock may have raced with a writer and must be
+ *                  retried.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       seq is the count returned by ''fmRegCacheSeqReadBegin''
+ *                  before the read.
+ *
+ * \return          TRUE if the read must be retried.
+ * \return          FALSE if the values read are consistent.
+ *
+ *****************************************************************************/
+static fm_bool fmRegCacheSeqReadRetry(fm_int sw, fm_uint32 seq)
+{
+    /* Order the cache loads before the second sample of the count */
+    FM_ATOMIC_FENCE();
+
+    return ( (seq & 1) != 0 ||
+             FM_ATOMIC_LOAD_RELAXED(&GET_SWITCH_PTR(sw)->regCacheSeq) != seq );
+
+}   /* end fmRegCacheSeqReadRetry */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheUpdateChecksums
+ * \ingroup intRegCache
+ *
+ * \desc            Folds a write to the cache into the running checksums
+ *                  of the blocks it overlaps. Must be called with the
+ *                  register lock held, before the cache is updated.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regSet points to the register set being written.
+ *
+ * \param[in]       offset is the offset in the cache of the first word
+ *                  being written.
+ *
+ * \param[in]       numWords is the number of words being written.
+ *
+ * \param[in]       data points to the new values of the words.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+static void fmRegCacheUpdateChecksums(fm_int               sw,
+                                      const fm_cachedRegs *regSet,
+                                      fm_uint32            offset,
+                                      fm_uint32            numWords,
+                                      const fm_uint32 *    data)
+{
+    fm_regCacheChecksum *block;
+    const fm_uint32 *    cache;
+    fm_uint32            first;
+    fm_uint32            last;
+    fm_uint32            delta;
+    fm_uint32            i;
+
+    cache = regSet->getCache.data(sw);
+
+    for (block = GET_SWITCH_PTR(sw)->regCacheChecksums ;
+         block != NULL ;
+         block = block->next)
+    {
+        if (block->registerSet != regSet)
+        {
+            continue;
+        }
+
+        first = (offset > block->firstWord) ? offset : block->firstWord;
+        last  = offset + numWords;
+
+        if (last > block->firstWord + block->numWords)
+        {
+            last = block->firstWord + block->numWords;
+        }
+
+        delta = 0;
+
+        for (i = first ; i < last ; i++)
+        {
+            delta ^= cache[i] ^ data[i - offset];
+        }
+
+        block->value ^= delta;
+    }
+
+}   /* end fmRegCacheUpdateChecksums */
+
+
+
+
 /*****************************************************************************/
 /** fmRegCacheReadC
  * \ingroup intRegCache
@@ -570,15 +932,21 @@ static fm_status fmRegCacheReadC(fm_int                        sw,
  *
  * \param[in]       sw is the switch on which to operate.
  *
- * \param[in,out]   nDest is incremented if this entry is not suppressed.
+ * \param[in,out]   nDest is incremented for each low-level entry
+ *                  generated.
  *
  * \param[in]       src is the entry in cached register format.
  *
- * \param[out]      dest is where the converted entry is written.
+ * \param[out]      dest is where the converted entries are written.
+ *
+ * \param[in]       trimUnchanged indicates that registers whose new value
+ *                  matches the cache should be dropped from the entry.
+ *                  The remaining registers are written as one low-level
+ *                  entry per run of changed registers, so the entry may
+ *                  be split, shrunk, or suppressed completely.
  *
- * \param[in]       trimUnchanged indicates that the entry should be
- *                  shrunk if part of it matches the cache, or suppressed
- *                  completely if it entirely matches the cache.
+ * \param[in,out]   stats points to the write statistics of the register
+ *                  set, or is NULL if the writes are not to be counted.
  *
  * \return          None
  *
@@ -587,20 +955,20 @@ static void fmRegCacheConvSGEntry(fm_int                        sw,
                                   fm_int *                      nDest,
                                   const fm_registerSGListEntry *src,
                                   fm_scatterGatherListEntry *   dest,
-                                  fm_bool                       trimUnchanged)
+                                  fm_bool                       trimUnchanged,
+                                  fm_regCacheWriteStats *       stats)
 {
     fm_registerSGListEntry entry;
     fm_int                 i;
     fm_int                 j;
     fm_uint32 *            cache;
     fm_bool                isEqual;
-    fm_bool                allEqual;
     fm_int                 nWords;
-    fm_int                 highestNotEqual = 0;
-    fm_int                 lowestNotEqual  = 0;
+    fm_int                 count;
+    fm_int                 runStart;
 
-    entry  = *src;
     nWords = src->registerSet->nWords;
+    count  = (fm_int) src->count;
 
     /*****************************************************
      *  do we want a hard, unconditional access to the
@@ -608,97 +976,103 @@ static void fmRegCacheConvSGEntry(fm_int                        sw,
      *  on the actual differences vs their cached values?
      ****************************************************/
     
-    if (trimUnchanged)
+    if (!trimUnchanged)
     {
-        /**************************************************
-         * soft, smart read. The register block is trimmed 
-         * to the largest one containing all registers that 
-         * we know will need to change, based on their 
-         * currently cached value. This could be as small 
-         * as no registers at all 
-         **************************************************/
-        
-        /* let's find the cache offset and read from there */
-        cache  = src->registerSet->getCache.data(sw);
-        cache += fmRegCacheComputeOffset(src->idx,
-                                         src->registerSet);
+        if (count > 0)
+        {
+            if (dest != NULL)
+            {
+                dest[*nDest].addr  = fmRegCacheComputeAddr(src->idx,
+                                                           src->registerSet);
+                dest[*nDest].count = count * nWords;
+                dest[*nDest].data  = src->data;
+            }
 
-        /* Assume no change to start with */
-        allEqual = TRUE;
+            (*nDest)++;
+        }
 
-        /* Scan the register block */
-        for (i = 0 ; i < (fm_int) src->count ; i++)
+        if (stats != NULL)
         {
-            /* Assume this register hasn't changed to start with */
-            isEqual = TRUE;
+            stats->writesIssued += count;
+        }
+
+        return;
+    }
 
+    /**************************************************
+     * soft, smart write. Registers whose cached value
+     * already matches the new value are dropped, and
+     * each run of changed registers becomes its own
+     * low-level entry. This could be as small as no
+     * registers at all. 
+     **************************************************/
+    
+    /* let's find the cache offset and compare from there */
+    cache  = src->registerSet->getCache.data(sw);
+    cache += fmRegCacheComputeOffset(src->idx,
+                                     src->registerSet);
+
+    runStart = -1;
+
+    /* Scan the register block, one past the end to close the last run */
+    for (i = 0 ; i <= count ; i++)
+    {
+        isEqual = TRUE;
+
+        if (i < count)
+        {
             /* scan all words of this register, one by one */
             for (j = 0 ; j < nWords ; j++)
             {
-                /* is this word different? */
                 if (cache[j + i * nWords] != src->data[j + i * nWords])
                 {
-                    /* yes, this register changed */
                     isEqual = FALSE;
+                    break;
                 }
             }
 
-            if (!isEqual)
-            {
-                /* register changed, mark the top of the trim area */
-                highestNotEqual = i;
-                allEqual        = FALSE;
-            }
-
-            if (allEqual)
+            if (isEqual && (stats != NULL))
             {
-                /****************************************
-                 * No register has changed for now, move 
-                 * the bottom of the trim area 
-                 ****************************************/
-                lowestNotEqual = i + 1;
+                stats->writesSuppressed++;
             }
+        }
 
-        }   /* end for (i = 0 ; i < (fm_int) src->count ; i++) */
-
-        /* we scanned the whole register block, any changes? */
-        if (allEqual)
+        if (!isEqual && (runStart < 0))
         {
-            /* no, nothing to do then */
-            entry.count = 0;
+            /* first changed register of a run */
+            runStart = i;
         }
-        else
+        else if (isEqual && (runStart >= 0))
         {
-            /* yes, modify the sgList entry based on the trim area */
-            entry.idx[0] += lowestNotEqual;
-            entry.count   = 1 + highestNotEqual - lowestNotEqual;
-            entry.data   += lowestNotEqual * nWords;
-        }
+            /**************************************************
+             * The run ends here. Fill out the low-level entry
+             * for it, unless all what we're doing is to count
+             * how many low-level entries are needed for
+             * allocation purposes (dest == NULL). In that case
+             * we'll be back here soon to prepare for the
+             * actual register access.
+             **************************************************/
+            if (dest != NULL)
+            {
+                entry         = *src;
+                entry.idx[0] += runStart;
 
-    }   /* end if (trimUnchanged) */
+                dest[*nDest].addr  = fmRegCacheComputeAddr(entry.idx,
+                                                           entry.registerSet);
+                dest[*nDest].count = (i - runStart) * nWords;
+                dest[*nDest].data  = src->data + runStart * nWords;
+            }
 
-    /**************************************************
-     * Now, if there are any changes, let's fill out the 
-     * low-level scatter-gather entry, unless all what 
-     * we're doing is to count how many low-level entries 
-     * are needed for allocation purposes (dest == NULL)
-     * In that case we'll be back here soon to prepare 
-     * for the actual register access 
-     **************************************************/
-    
-    if (entry.count > 0)
-    {
-        if (dest != NULL)
-        {
-            /* we're actually accessing the registers, not just counting */
-            dest[*nDest].addr = fmRegCacheComputeAddr(entry.idx,
-                                                      entry.registerSet);
-            dest[*nDest].count = entry.count * nWords;
-            dest[*nDest].data  = entry.data;
+            if (stats != NULL)
+            {
+                stats->writesIssued += i - runStart;
+            }
+
+            (*nDest)++;
+            runStart = -1;
         }
 
-        (*nDest)++;
-    }
+    }   /* end for (i = 0 ; i <= count ; i++) */
 
 }   /* end fmRegCacheConvSGEntry */
 
@@ -749,6 +1123,10 @@ static fm_bool fmRegCacheStrideIsContiguous(const fm_cachedRegs *regs)
  *                  shrunk or removed if the data to be written matches
  *                  the data already in the cache.
  *
+ * \param[in]       countWrites indicates that the registers issued and
+ *                  suppressed should be added to the write statistics
+ *                  when dest is not NULL.
+ *
  * \return          number of entries in the "dest" list.
  *
  *****************************************************************************/
@@ -756,13 +1134,15 @@ static fm_int fmRegCacheConvSGList(fm_int                        sw,
                                    fm_int                        nSrc,
                                    const fm_registerSGListEntry *src,
                                    fm_scatterGatherListEntry    *dest,
-                                   fm_bool                       trimUnchanged)
+                                   fm_bool                       trimUnchanged,
+                                   fm_bool                       countWrites)
 {
     fm_int                 nDest = 0;
     fm_int                 i;
     fm_int                 j;
     fm_registerSGListEntry single;
     fm_bool                trimIt;
+    fm_regCacheWriteStats *stats;
 
     /* Scan the list of input sgList entries */
     for (i = 0 ; i < nSrc ; i++)
@@ -776,6 +1156,16 @@ static fm_int fmRegCacheConvSGList(fm_int                        sw,
             trimIt = FALSE;
         }
 
+        /* Only count the pass that actually fills out the list */
+        if (countWrites && (dest != NULL))
+        {
+            stats = fmRegCacheGetWriteStats(sw, src[i].registerSet);
+        }
+        else
+        {
+            stats = NULL;
+        }
+
         /**************************************************
          * if for this entry all registers are contiguous 
          * in the address space take advantage of scatter- 
@@ -795,7 +1185,8 @@ static fm_int fmRegCacheConvSGList(fm_int                        sw,
                                   &nDest,
                                   src + i,
                                   dest,
-                                  trimIt );
+                                  trimIt,
+                                  stats);
         }
         else
         {
@@ -820,7 +1211,8 @@ static fm_int fmRegCacheConvSGList(fm_int                        sw,
                                       &nDest,
                                       &single,
                                       dest,
-                                      trimIt );
+                                      trimIt,
+                                      stats);
             }
         }
 
@@ -862,6 +1254,7 @@ static fm_status fmRegCacheReadNC(fm_int                        sw,
                                       nEntries,
                                       sgList,
                                       NULL,
+                                      FALSE,
                                       FALSE);
 
     if (nSGEntries > 0)
@@ -872,6 +1265,7 @@ static fm_status fmRegCacheReadNC(fm_int                        sw,
                              nEntries, 
                              sgList, 
                              hwSGList, 
+                             FALSE,
                              FALSE);
 
         err = fmReadScatterGather(sw, nSGEntries, hwSGList);
@@ -999,6 +1393,15 @@ fm_status fmInitRegisterCache(fm_int sw)
         /* Initialize the keyValid bit arrarys */
         err = fmRegCacheInitKeyValid(sw, cachedRegs);
 
+        /* ...and the write statistics */
+        if ( err == FM_OK )
+        {
+            err = fmRegCacheInitWriteStats(sw, cachedRegs);
+        }
+
+        /* The cache is about to be reloaded, so drop any checksums */
+        fmRegCacheInvalidateChecksums(sw, NULL);
+
         /* If that worked, perform the first read of into the cache */ 
         if ( err == FM_OK )
         {
@@ -1052,6 +1455,10 @@ fm_status fmFreeRegisterCache(fm_int sw)
 
     /* Free the cache key valids */
     err = fmRegCacheFreeKeyValid(sw, cachedRegs);
+
+    fmRegCacheFreeWriteStats(sw);
+
+    fmRegCacheInvalidateChecksums(sw, NULL);
              
     return err;
 
@@ -1089,6 +1496,8 @@ fm_status fmRegCacheRead(fm_int                        sw,
                          fm_bool                       useCache)
 {
     fm_status err;
+    fm_uint32 seq;
+    fm_int    retry;
 
     /* Sanity check on the scatter-gather list */
     if ( !IsScatterGatherListCorrect(sgList, nEntries) )
@@ -1099,13 +1508,35 @@ fm_status fmRegCacheRead(fm_int                        sw,
         return FM_ERR_INVALID_ARGUMENT;
     }
 
-    TAKE_REG_LOCK(sw);   /* make access atomic */
-
+    /* Cached reads do not contend with the writers for the register lock.
+     * The read is retried if a writer updated the cache meanwhile. */
     if (useCache)
     {
-        err = fmRegCacheReadC(sw, nEntries, sgList);
-    }
-    else
+        for (retry = 0 ; retry < CACHE_READ_RETRIES ; retry++)
+        {
+            seq = fmRegCacheSeqReadBegin(sw);
+
+            if ( (seq & 1) != 0 )
+            {
+                continue;
+            }
+
+            fmRegCacheReadC(sw, nEntries, sgList);
+
+            if ( !fmRegCacheSeqReadRetry(sw, seq) )
+            {
+                return FM_OK;
+            }
+        }
+    }
+
+    TAKE_REG_LOCK(sw);   /* make access atomic */
+
+    if (useCache)
+    {
+        err = fmRegCacheReadC(sw, nEntries, sgList);
+    }
+    else
     {
         err = fmRegCacheReadNC(sw, nEntries, sgList);
     }
@@ -1154,6 +1585,7 @@ fm_status fmRegCacheWrite(fm_int                        sw,
     fm_int                     i;
     fm_int                     j;
     fm_uint32 *                cache;
+    fm_uint32                  offset;
     fm_cleanupListEntry *      cleanupList = NULL;
 
     /* Sanity check on the scatter-gather list */
@@ -1175,7 +1607,8 @@ fm_status fmRegCacheWrite(fm_int                        sw,
                                       nEntries,
                                       sgList,
                                       NULL,
-                                      useCache);
+                                      useCache,
+                                      FALSE);
 
     if (nSGEntries > 0)
     {
@@ -1184,7 +1617,8 @@ fm_status fmRegCacheWrite(fm_int                        sw,
                              nEntries, 
                              sgList, 
                              hwSGList, 
-                             useCache);
+                             useCache,
+                             TRUE);
         err = fmWriteScatterGather(sw, nSGEntries, hwSGList);
     }
     else
@@ -1198,11 +1632,23 @@ fm_status fmRegCacheWrite(fm_int                        sw,
 
     if (err == FM_OK)
     {
+        fmRegCacheSeqWriteBegin(sw);
+
         for (i = 0 ; i < nEntries ; i++)
         {
-            cache  = sgList[i].registerSet->getCache.data(sw);
-            cache += fmRegCacheComputeOffset(sgList[i].idx,
+            offset = fmRegCacheComputeOffset(sgList[i].idx,
                                              sgList[i].registerSet);
+            cache  = sgList[i].registerSet->getCache.data(sw) + offset;
+
+            if (GET_SWITCH_PTR(sw)->regCacheChecksums != NULL)
+            {
+                fmRegCacheUpdateChecksums(sw,
+                                          sgList[i].registerSet,
+                                          offset,
+                                          sgList[i].count *
+                                              sgList[i].registerSet->nWords,
+                                          sgList[i].data);
+            }
 
             for (j = 0 ;
                  j < ((fm_int) sgList[i].count *
@@ -1212,6 +1658,8 @@ fm_status fmRegCacheWrite(fm_int                        sw,
                 *cache++ = sgList[i].data[j];
             }
         }
+
+        fmRegCacheSeqWriteEnd(sw);
     }
 
 ABORT:
@@ -1630,6 +2078,7 @@ fm_status fmRegCacheUpdateSingle1D(fm_int               sw,
                                    fm_uint32            idx)
 {
     fm_uint32 *cache;
+    fm_uint32  offset;
     fm_uint32 indices[FM_REGS_CACHE_MAX_INDICES] = {idx, 0, 0};
 
     /* sanity checks on the regSet argument */
@@ -1645,10 +2094,23 @@ fm_status fmRegCacheUpdateSingle1D(fm_int               sw,
         return FM_ERR_INVALID_ARGUMENT;
     }
 
-    cache   = regSet->getCache.data( sw );
-    cache  += fmRegCacheComputeOffset( indices, regSet );
+    offset  = fmRegCacheComputeOffset( indices, regSet );
+    cache   = regSet->getCache.data( sw ) + offset;
+
+    TAKE_REG_LOCK(sw);
+
+    if (GET_SWITCH_PTR(sw)->regCacheChecksums != NULL)
+    {
+        fmRegCacheUpdateChecksums(sw, regSet, offset, 1, &data);
+    }
+
+    fmRegCacheSeqWriteBegin(sw);
+
     *cache  = data;
 
+    fmRegCacheSeqWriteEnd(sw);
+    DROP_REG_LOCK(sw);
+
     return FM_OK;
 
 }   /* end fmRegCacheUpdateSingle1D */
@@ -1763,7 +2225,11 @@ fm_status fmRegCacheReadKeyValid(fm_int                sw,
     fm_int       i;
     fm_byte      bitPair;
     fm_bitArray *bitArray;
-    fm_bool      bitValue;
+    fm_bool      bitValue0;
+    fm_bool      bitValue1;
+    fm_uint32    seq;
+    fm_int       retry;
+    fm_bool      locked;
 
     /* validate the switch index */
     VALIDATE_SWITCH_INDEX(sw);
@@ -1815,24 +2281,51 @@ fm_status fmRegCacheReadKeyValid(fm_int                sw,
         product   *= regSet->nElements[i];
     }
 
-    /* get the value of bit at position bitOffset+1 */
-    err = fmGetBitArrayBit( bitArray, bitOffset+1, &bitValue );
+    /* get the values of the bits at positions bitOffset+1 and bitOffset.
+     * The pair is read without the register lock, and read again if a
+     * writer updated the cache meanwhile. */
+    for (retry = 0 ; ; retry++)
+    {
+        locked = (retry >= CACHE_READ_RETRIES);
+
+        if (locked)
+        {
+            TAKE_REG_LOCK(sw);
+        }
+
+        seq = fmRegCacheSeqReadBegin(sw);
+
+        err = fmGetBitArrayBit( bitArray, bitOffset+1, &bitValue1 );
+        if ( err == FM_OK )
+        {
+            fmGetBitArrayBit( bitArray, bitOffset, &bitValue0 );
+        }
+
+        if (locked)
+        {
+            DROP_REG_LOCK(sw);
+            break;
+        }
+
+        if ( err != FM_OK || !fmRegCacheSeqReadRetry(sw, seq) )
+        {
+            break;
+        }
+    }
+
     if ( err == FM_OK )
     {
         bitPair = 0;
 
-        /* is it a '1'? */
-        if (bitValue == TRUE)
+        /* is bit bitOffset+1 a '1'? */
+        if (bitValue1 == TRUE)
         {
             /* yes */
             bitPair = 2;
         }
 
-        /* get the value of bit at position bitOffset */
-        fmGetBitArrayBit( bitArray, bitOffset, &bitValue );
-
-        /* is it a '1'? */
-        if ( bitValue == TRUE )
+        /* is bit bitOffset a '1'? */
+        if ( bitValue0 == TRUE )
         {
             /* yes */
             bitPair += 1;
@@ -2005,6 +2498,9 @@ fm_status fmRegCacheWriteKeyValid(fm_int               sw,
     }   /* end switch (valid) */
     
 
+    TAKE_REG_LOCK(sw);
+    fmRegCacheSeqWriteBegin(sw);
+
     /* set the bit at offset 'bitOffset+1' first */
     err = fmSetBitArrayBit( bitArray, bitOffset + 1, bitValue1 );
     if ( err == FM_OK )
@@ -2013,6 +2509,9 @@ fm_status fmRegCacheWriteKeyValid(fm_int               sw,
         fmSetBitArrayBit( bitArray, bitOffset, bitValue0 );
     }
 
+    fmRegCacheSeqWriteEnd(sw);
+    DROP_REG_LOCK(sw);
+
 ABORT:
     return err;
 
@@ -2152,6 +2651,411 @@ fm_status fmRegCacheCopyKeyValid(fm_int                sw,
 
 
 
+/*****************************************************************************/
+/** fmRegCacheSetKeyValidBits
+ * \ingroup intRegCache
+ *
+ * \desc            Sets the Bit0 pair of key and keyInvert in the data of
+ *                  a CAM-type register.
+ *
+ * \param[in,out]   data points to the register data.
+ *
+ * \param[in]       keyBit is the bit position of Bit0 of the key in the
+ *                  register data.
+ *
+ * \param[in]       keyInvertBit is the bit position of Bit0 of keyInvert
+ *                  in the register data.
+ *
+ * \param[in]       valid is the Bit0 pair to set.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+static void fmRegCacheSetKeyValidBits(fm_uint32 *          data,
+                                      fm_uint              keyBit,
+                                      fm_uint              keyInvertBit,
+                                      fm_regsCacheKeyValid valid)
+{
+    fm_bool bitValue0;
+    fm_bool bitValue1;
+
+    bitValue0 = ( valid == FM_REGS_CACHE_KEY_IS_1 ||
+                  valid == FM_REGS_CACHE_KEY_AND_KEYINVERT_BOTH_1 );
+    bitValue1 = ( valid == FM_REGS_CACHE_KEYINVERT_IS_1 ||
+                  valid == FM_REGS_CACHE_KEY_AND_KEYINVERT_BOTH_1 );
+
+    fmMultiWordBitfieldSet32(data, keyBit, keyBit, bitValue0);
+    fmMultiWordBitfieldSet32(data, keyInvertBit, keyInvertBit, bitValue1);
+
+}   /* end fmRegCacheSetKeyValidBits */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheBuildRuns
+ * \ingroup intRegCache
+ *
+ * \desc            Builds a scatter-gather list covering the registers of
+ *                  a list that are flagged, one entry per run of
+ *                  consecutive flagged registers, so that each run is
+ *                  written as a single burst.
+ *
+ * \param[in]       nEntries is the number of entries in sgList.
+ *
+ * \param[in]       sgList is the scatter-gather list of the registers.
+ *
+ * \param[in]       data points to the data of all registers of sgList,
+ *                  in order.
+ *
+ * \param[in]       flags holds one flag per register of sgList, in order.
+ *
+ * \param[out]      runs points to caller-allocated storage for as many
+ *                  entries as there are registers in sgList.
+ *
+ * \return          number of entries in runs.
+ *
+ *****************************************************************************/
+static fm_int fmRegCacheBuildRuns(fm_int                        nEntries,
+                                  const fm_registerSGListEntry *sgList,
+                                  fm_uint32 *                   data,
+                                  const fm_bool *               flags,
+                                  fm_registerSGListEntry *      runs)
+{
+    fm_registerSGListEntry *run = NULL;
+    fm_int                  nRuns = 0;
+    fm_int                  i;
+    fm_uint32               j;
+    fm_uint32               nWords;
+
+    for (i = 0 ; i < nEntries ; i++)
+    {
+        nWords = sgList[i].registerSet->nWords;
+
+        for (j = 0 ; j < sgList[i].count ; j++)
+        {
+            if (!*flags++)
+            {
+                run = NULL;
+            }
+            else if (run != NULL)
+            {
+                run->count++;
+            }
+            else
+            {
+                run         = &runs[nRuns++];
+                *run        = sgList[i];
+                run->data   = data;
+                run->count  = 1;
+                run->idx[0] = sgList[i].idx[0] + j;
+            }
+
+            data += nWords;
+        }
+
+        /* runs do not span entries of the list */
+        run = NULL;
+    }
+
+    return nRuns;
+
+}   /* end fmRegCacheBuildRuns */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheWriteKeyValidRange
+ * \ingroup intRegCache
+ *
+ * \chips           FM6000, FM10000
+ *
+ * \desc            Writes ranges of CAM-type registers, along with the
+ *                  registers associated with them, and stores the Bit0
+ *                  pair of key and keyInvert of each CAM register in the
+ *                  local KeyValid cache, as ''fmRegCacheWriteKeyValid''
+ *                  does for a single register. Consecutive registers are
+ *                  coalesced into burst writes.
+ *                                                                      \lb\lb
+ *                  When hitless is TRUE, the registers are written in
+ *                  three passes so that lookups never see a partially
+ *                  written entry: the CAM registers currently valid in
+ *                  the cache are first invalidated, the new data is then
+ *                  written with both bits of the pair set, followed by
+ *                  the associated registers, and the CAM registers to be
+ *                  valid are finally written with their Bit0 pair
+ *                  restored. Otherwise, all registers are written in a
+ *                  single pass.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       nEntries is the number of entries in sgList.
+ *
+ * \param[in]       sgList is the list of ranges of registers to write,
+ *                  with their new data.
+ *
+ * \param[in]       nKeyEntries is the number of leading entries of sgList
+ *                  that are CAM-type registers. Bit0 of key and keyInvert
+ *                  in their data are ignored. Their register sets must
+ *                  have a local KeyValid cache.
+ *
+ * \param[in]       keyValid holds the Bit0 pair of each CAM register of
+ *                  sgList, in order.
+ *
+ * \param[in]       validate holds whether each CAM register of sgList, in
+ *                  order, is to be valid. NULL validates all of them.
+ *
+ * \param[in]       keyBit is the bit position of Bit0 of the key in the
+ *                  CAM register data.
+ *
+ * \param[in]       keyInvertBit is the bit position of Bit0 of keyInvert
+ *                  in the CAM register data.
+ *
+ * \param[in]       hitless indicates whether the CAM is in use and must
+ *                  be written in three passes.
+ *
+ * \param[in]       useCache indicates whether using the cache is allowed,
+ *                  see ''fmRegCacheWrite''.
+ *
+ * \return          FM_OK if successful
+ * \return          FM_ERR_INVALID_ARGUMENT if one or more of the arguments
+ *                  are invalid.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ *
+ *****************************************************************************/
+fm_status fmRegCacheWriteKeyValidRange(fm_int                        sw,
+                                       fm_int                        nEntries,
+                                       const fm_registerSGListEntry *sgList,
+                                       fm_int                        nKeyEntries,
+                                       const fm_regsCacheKeyValid *  keyValid,
+                                       const fm_bool *               validate,
+                                       fm_uint                       keyBit,
+                                       fm_uint                       keyInvertBit,
+                                       fm_bool                       hitless,
+                                       fm_bool                       useCache)
+{
+    fm_status               err = FM_OK;
+    fm_cleanupListEntry *   cleanupList = NULL;
+    fm_registerSGListEntry *runs;
+    fm_registerSGListEntry *scratchList;
+    fm_uint32 *             scratch;
+    fm_uint32 *             data;
+    fm_bool *               flags;
+    fm_bitArray *           bitArray;
+    fm_regsCacheKeyValid    pair;
+    fm_uint32               idx[FM_REGS_CACHE_MAX_INDICES];
+    fm_uint32               bitOffset;
+    fm_uint32               product;
+    fm_uint32               nWords;
+    fm_int                  nRegs;
+    fm_int                  nDataWords;
+    fm_int                  nRuns;
+    fm_int                  reg;
+    fm_int                  i;
+    fm_int                  k;
+    fm_uint32               j;
+    fm_bool                 regLockTaken = FALSE;
+
+    /* validate the switch index */
+    VALIDATE_SWITCH_INDEX(sw);
+
+    if ( keyValid == NULL || nKeyEntries <= 0 || nKeyEntries > nEntries ||
+         !IsScatterGatherListCorrect(sgList, nEntries) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    nRegs      = 0;
+    nDataWords = 0;
+
+    for (i = 0 ; i < nKeyEntries ; i++)
+    {
+        if ( sgList[i].registerSet->getCache.valid == NULL ||
+             sgList[i].registerSet->getCache.valid(sw) == NULL ||
+             keyBit >= sgList[i].registerSet->nWords * 32 ||
+             keyInvertBit >= sgList[i].registerSet->nWords * 32 )
+        {
+            return FM_ERR_INVALID_ARGUMENT;
+        }
+
+        nRegs      += sgList[i].count;
+        nDataWords += sgList[i].count * sgList[i].registerSet->nWords;
+    }
+
+    FM_ALLOC_TEMP_ARRAY(runs, fm_registerSGListEntry, nRegs);
+    FM_ALLOC_TEMP_ARRAY(scratchList, fm_registerSGListEntry, nEntries);
+    FM_ALLOC_TEMP_ARRAY(scratch, fm_uint32, nDataWords);
+    FM_ALLOC_TEMP_ARRAY(flags, fm_bool, nRegs);
+
+    /* The CAM entries of the scratch list are written from the scratch
+     * area, the associated ones straight from the caller's data */
+    data = scratch;
+    for (i = 0 ; i < nEntries ; i++)
+    {
+        scratchList[i] = sgList[i];
+
+        if (i < nKeyEntries)
+        {
+            scratchList[i].data = data;
+            data += sgList[i].count * sgList[i].registerSet->nWords;
+        }
+    }
+
+    TAKE_REG_LOCK(sw);
+    regLockTaken = TRUE;
+
+    /**************************************************
+     * Invalidate the CAM registers currently valid, as
+     * found in the cache.
+     **************************************************/
+    if (hitless)
+    {
+        err = fmRegCacheRead(sw, nKeyEntries, scratchList, TRUE);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+        data = scratch;
+        reg  = 0;
+        for (i = 0 ; i < nKeyEntries ; i++)
+        {
+            nWords = sgList[i].registerSet->nWords;
+
+            for (j = 0 ; j < sgList[i].count ; j++, reg++, data += nWords)
+            {
+                flags[reg] =
+                    !( fmMultiWordBitfieldGet32(data, keyBit, keyBit) &&
+                       fmMultiWordBitfieldGet32(data, keyInvertBit, keyInvertBit) );
+
+                fmRegCacheSetKeyValidBits(data,
+                                          keyBit,
+                                          keyInvertBit,
+                                          FM_REGS_CACHE_KEY_AND_KEYINVERT_BOTH_1);
+            }
+        }
+
+        nRuns = fmRegCacheBuildRuns(nKeyEntries, sgList, scratch, flags, runs);
+
+        if (nRuns > 0)
+        {
+            err = fmRegCacheWrite(sw, nRuns, runs, useCache);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+        }
+    }
+
+    /**************************************************
+     * Store the Bit0 pairs in the KeyValid cache and
+     * write the new data, invalid if hitless.
+     **************************************************/
+    fmRegCacheSeqWriteBegin(sw);
+
+    data = scratch;
+    reg  = 0;
+    for (i = 0 ; i < nKeyEntries ; i++)
+    {
+        nWords   = sgList[i].registerSet->nWords;
+        bitArray = sgList[i].registerSet->getCache.valid(sw);
+
+        for (k = 0 ; k < FM_REGS_CACHE_MAX_INDICES ; k++)
+        {
+            idx[k] = sgList[i].idx[k];
+        }
+
+        for (j = 0 ; j < sgList[i].count ; j++, reg++, data += nWords)
+        {
+            idx[0] = sgList[i].idx[0] + j;
+
+            /* same offset as computed by fmRegCacheWriteKeyValid */
+            bitOffset = 0;
+            product   = 2;
+            for (k = 0 ;
+                 k < sgList[i].registerSet->nIndices &&
+                     k < FM_REGS_CACHE_MAX_INDICES ;
+                 k++)
+            {
+                bitOffset += product * idx[k];
+                product   *= sgList[i].registerSet->nElements[k];
+            }
+
+            fmSetBitArrayBit(bitArray,
+                             bitOffset + 1,
+                             ( keyValid[reg] == FM_REGS_CACHE_KEYINVERT_IS_1 ||
+                               keyValid[reg] ==
+                                   FM_REGS_CACHE_KEY_AND_KEYINVERT_BOTH_1 ));
+            fmSetBitArrayBit(bitArray,
+                             bitOffset,
+                             ( keyValid[reg] == FM_REGS_CACHE_KEY_IS_1 ||
+                               keyValid[reg] ==
+                                   FM_REGS_CACHE_KEY_AND_KEYINVERT_BOTH_1 ));
+
+            for (k = 0 ; k < (fm_int) nWords ; k++)
+            {
+                data[k] = sgList[i].data[j * nWords + k];
+            }
+
+            flags[reg] = (validate == NULL) ? TRUE : validate[reg];
+
+            if (hitless || !flags[reg])
+            {
+                pair = FM_REGS_CACHE_KEY_AND_KEYINVERT_BOTH_1;
+            }
+            else
+            {
+                pair = keyValid[reg];
+            }
+
+            fmRegCacheSetKeyValidBits(data, keyBit, keyInvertBit, pair);
+        }
+    }
+
+    fmRegCacheSeqWriteEnd(sw);
+
+    err = fmRegCacheWrite(sw, nEntries, scratchList, useCache);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+    /**************************************************
+     * Validate the CAM registers.
+     **************************************************/
+    if (hitless)
+    {
+        data = scratch;
+        reg  = 0;
+        for (i = 0 ; i < nKeyEntries ; i++)
+        {
+            nWords = sgList[i].registerSet->nWords;
+
+            for (j = 0 ; j < sgList[i].count ; j++, reg++, data += nWords)
+            {
+                fmRegCacheSetKeyValidBits(data,
+                                          keyBit,
+                                          keyInvertBit,
+                                          keyValid[reg]);
+            }
+        }
+
+        nRuns = fmRegCacheBuildRuns(nKeyEntries, sgList, scratch, flags, runs);
+
+        if (nRuns > 0)
+        {
+            err = fmRegCacheWrite(sw, nRuns, runs, useCache);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+        }
+    }
+
+ABORT:
+    if (regLockTaken)
+    {
+        DROP_REG_LOCK(sw);
+    }
+
+    FM_FREE_TEMP_ARRAYS();
+
+    return err;
+
+}   /* end fmRegCacheWriteKeyValidRange */
+
+
+
+
 /*****************************************************************************/
 /** fmRegCacheWriteFromCache
  * \ingroup intRegCache
@@ -2218,7 +3122,7 @@ fm_status fmRegCacheWriteFromCache(fm_int                sw,
     entry.data += fmRegCacheComputeOffset(indices, regSet);
 
     /* Find out how many scatter-gather entries we will need. */
-    sgListSize = fmRegCacheConvSGList(sw, 1, &entry, NULL, FALSE);
+    sgListSize = fmRegCacheConvSGList(sw, 1, &entry, NULL, FALSE, FALSE);
 
     if (sgListSize != 1)
     {
@@ -2229,7 +3133,7 @@ fm_status fmRegCacheWriteFromCache(fm_int                sw,
     }
 
     /* Get the actual addresses. */
-    fmRegCacheConvSGList(sw, 1, &entry, sgList, FALSE);
+    fmRegCacheConvSGList(sw, 1, &entry, sgList, FALSE, FALSE);
 
     regAddr  = sgList[0].addr;
     numWords = sgList[0].count;
@@ -2344,7 +3248,7 @@ fm_status fmRegCacheComputeChecksum(fm_int                sw,
     entry.data += fmRegCacheComputeOffset(indices, regSet);
 
     /* Find out how many scatter-gather entries we will need. */
-    sgListSize = fmRegCacheConvSGList(sw, 1, &entry, NULL, FALSE);
+    sgListSize = fmRegCacheConvSGList(sw, 1, &entry, NULL, FALSE, FALSE);
 
     if (sgListSize != 1)
     {
@@ -2352,7 +3256,7 @@ fm_status fmRegCacheComputeChecksum(fm_int                sw,
         return FM_ERR_INVALID_ARGUMENT;
     }
 
-    fmRegCacheConvSGList(sw, 1, &entry, sgList, FALSE);
+    fmRegCacheConvSGList(sw, 1, &entry, sgList, FALSE, FALSE);
 
     numWords = sgList[0].count;
     cachePtr = sgList[0].data;
@@ -2386,53 +3290,754 @@ fm_status fmRegCacheComputeChecksum(fm_int                sw,
 
 
 /*****************************************************************************/
-/** fmDbgDumpRegCacheEntry
+/** fmRegCacheGetChecksum
  * \ingroup intRegCache
  *
  * \chips           FM10000
  *
- * \desc            Generates and dumps a scatter-gather list for a block
- *                  of consecutive entries in the register cache.
+ * \desc            Returns the CRM checksum for a block of consecutive
+ *                  entries in the register cache.
+ *
+ * \note            The first request for a block computes its checksum
+ *                  with ''fmRegCacheComputeChecksum'' and starts tracking
+ *                  it. From then on, each write to the cache updates the
+ *                  checksum with the difference between the old and new
+ *                  words, so later requests cost nothing regardless of
+ *                  the size of the block.
  *
  * \param[in]       sw is the switch on which to operate.
  *
  * \param[in]       regSet points to the register set descriptor.
  * 
  * \param[in]       indices points to an array specifying the indices of the
- *                  first entry to write.
+ *                  first entry of the block.
  * 
- * \param[in]       nEntries is the number of register entries to write.
+ * \param[in]       nEntries is the number of register entries in the block.
+ * 
+ * \param[out]      checksum points to the location to receive the checksum.
  *
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
-fm_status fmDbgDumpRegCacheEntry(fm_int                sw,
-                                 const fm_cachedRegs * regSet,
-                                 const fm_uint32 *     indices,
-                                 fm_int                nEntries)
+fm_status fmRegCacheGetChecksum(fm_int                sw,
+                                const fm_cachedRegs * regSet,
+                                const fm_uint32 *     indices,
+                                fm_int                nEntries,
+                                fm_uint32 *           checksum)
 {
-    fm_scatterGatherListEntry   sgList[10];
-    fm_scatterGatherListEntry * sgItem;
-    fm_registerSGListEntry      entry;
-    fm_int                      sgListSize;
-    fm_int                      i;
-
-    FM_NOT_USED(sw);
+    fm_switch *          switchPtr;
+    fm_regCacheChecksum *block;
+    fm_uint32            offset;
+    fm_uint32            numWords;
+    fm_status            err;
 
     if (regSet == NULL)
     {
         return FM_ERR_INVALID_ARGUMENT;
     }
 
-    entry.registerSet = regSet;
-    entry.data        = NULL;
-    entry.count       = nEntries;
-    entry.idx[0]      = indices[0];
-    entry.idx[1]      = indices[1];
-    entry.idx[2]      = indices[2];
-    entry.rewriting   = FALSE;
+    switchPtr = GET_SWITCH_PTR(sw);
+    offset    = fmRegCacheComputeOffset(indices, regSet);
+    numWords  = (fm_uint32) nEntries * regSet->nWords;
 
-    if ( !IsScatterGatherListCorrect(&entry, 1) )
+    TAKE_REG_LOCK(sw);
+
+    for (block = switchPtr->regCacheChecksums ;
+         block != NULL ;
+         block = block->next)
+    {
+        if ( (block->registerSet == regSet) &&
+             (block->firstWord == offset) &&
+             (block->numWords == numWords) )
+        {
+            *checksum = block->value;
+            DROP_REG_LOCK(sw);
+            return FM_OK;
+        }
+    }
+
+    err = fmRegCacheComputeChecksum(sw, regSet, indices, nEntries, checksum);
+
+    if (err == FM_OK)
+    {
+        /* If the block cannot be tracked, it will simply be computed
+         * again next time. */
+        block = fmAlloc( sizeof(fm_regCacheChecksum) );
+
+        if (block != NULL)
+        {
+            block->registerSet = regSet;
+            block->firstWord   = offset;
+            block->numWords    = numWords;
+            block->value       = *checksum;
+            block->next        = switchPtr->regCacheChecksums;
+
+            switchPtr->regCacheChecksums = block;
+        }
+    }
+
+    DROP_REG_LOCK(sw);
+
+    return err;
+
+}   /* end fmRegCacheGetChecksum */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheInvalidateChecksums
+ * \ingroup intRegCache
+ *
+ * \chips           FM10000
+ *
+ * \desc            Stops tracking the checksums of a register set, so that
+ *                  they are computed in full by the next call to
+ *                  ''fmRegCacheGetChecksum''. Must be called by code that
+ *                  updates the cache directly rather than through
+ *                  ''fmRegCacheWrite''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regSet points to the register set descriptor, or is
+ *                  NULL to drop the checksums of all register sets.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmRegCacheInvalidateChecksums(fm_int sw, const fm_cachedRegs * regSet)
+{
+    fm_regCacheChecksum **link;
+    fm_regCacheChecksum * block;
+
+    TAKE_REG_LOCK(sw);
+
+    link = &GET_SWITCH_PTR(sw)->regCacheChecksums;
+
+    while (*link != NULL)
+    {
+        block = *link;
+
+        if (regSet == NULL || block->registerSet == regSet)
+        {
+            *link = block->next;
+            fmFree(block);
+        }
+        else
+        {
+            link = &block->next;
+        }
+    }
+
+    DROP_REG_LOCK(sw);
+
+}   /* end fmRegCacheInvalidateChecksums */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheSetWords
+ * \ingroup intRegCache
+ *
+ * \desc            Returns the number of cache words held by a register set.
+ *
+ * \param[in]       regSet points to the register set descriptor.
+ *
+ * \return          The number of words.
+ *
+ *****************************************************************************/
+static fm_uint32 fmRegCacheSetWords(const fm_cachedRegs *regSet)
+{
+    fm_uint32 words;
+    fm_int    i;
+
+    words = regSet->nWords * regSet->nElements[0];
+
+    for (i = 1 ; i < regSet->nIndices && i < FM_REGS_CACHE_MAX_INDICES ; i++)
+    {
+        words *= regSet->nElements[i];
+    }
+
+    return words;
+
+}   /* end fmRegCacheSetWords */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheSnapshotHeader
+ * \ingroup intRegCache
+ *
+ * \desc            Fills out the snapshot header of a register set, which
+ *                  describes the layout of its cache so that a snapshot
+ *                  taken with a different register list is rejected.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regSet points to the register set descriptor.
+ *
+ * \param[out]      header points to an array of SNAPSHOT_SET_WORDS words
+ *                  to fill out.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+static void fmRegCacheSnapshotHeader(fm_int               sw,
+                                     const fm_cachedRegs *regSet,
+                                     fm_uint32 *          header)
+{
+    fm_bitArray *valid;
+
+    valid = (regSet->getCache.valid != NULL) ? regSet->getCache.valid(sw)
+                                             : NULL;
+
+    header[0] = regSet->baseAddr;
+    header[1] = regSet->nWords;
+    header[2] = regSet->nIndices;
+    header[3] = regSet->nElements[0];
+    header[4] = regSet->nElements[1];
+    header[5] = regSet->nElements[2];
+    header[6] = fmRegCacheSetWords(regSet);
+    header[7] = (valid != NULL) ? (fm_uint32) valid->bitCount : 0;
+    header[8] = (valid != NULL) ? (fm_uint32) valid->wordCount : 0;
+
+}   /* end fmRegCacheSnapshotHeader */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheSaveSnapshot
+ * \ingroup intRegCache
+ *
+ * \chips           FM10000
+ *
+ * \desc            Saves the contents of the register cache, including the
+ *                  key valid bits, to a file, so that it can be restored
+ *                  with ''fmRegCacheRestoreSnapshot'' when the switch is
+ *                  next initialized.
+ *
+ * \note            The snapshot is written in host byte order, to a
+ *                  temporary file that replaces the named file once it is
+ *                  complete.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       fileName is the name of the snapshot file.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNINITIALIZED if the switch has no register cache.
+ * \return          FM_FAIL if the file could not be written.
+ *
+ *****************************************************************************/
+fm_status fmRegCacheSaveSnapshot(fm_int sw, fm_text fileName)
+{
+    const fm_cachedRegs **regs;
+    fm_bitArray *         valid;
+    FILE *                fp;
+    fm_char               tmpName[FM_API_ATTR_TEXT_MAX_LENGTH + 8];
+    fm_uint32             header[SNAPSHOT_SET_WORDS];
+    fm_uint32             nSets;
+    fm_bool               ok;
+
+    regs = (const fm_cachedRegs **) GET_SWITCH_PTR(sw)->CachedRegisterList;
+
+    if (regs == NULL)
+    {
+        return FM_ERR_UNINITIALIZED;
+    }
+
+    for (nSets = 0 ; regs[nSets] != NULL ; nSets++)
+    {
+        /* just count the register sets */
+    }
+
+    FM_SNPRINTF_S(tmpName, sizeof(tmpName), "%s.tmp", fileName);
+
+    fp = fopen(tmpName, "wb");
+
+    if (fp == NULL)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                     "Unable to create register cache snapshot %s\n",
+                     tmpName);
+        return FM_FAIL;
+    }
+
+    header[0] = SNAPSHOT_MAGIC;
+    header[1] = SNAPSHOT_VERSION;
+    header[2] = nSets;
+
+    TAKE_REG_LOCK(sw);
+
+    ok = (fwrite(header, sizeof(fm_uint32), 3, fp) == 3);
+
+    for ( ; ok && *regs != NULL ; regs++)
+    {
+        fmRegCacheSnapshotHeader(sw, *regs, header);
+
+        ok = (fwrite(header, sizeof(fm_uint32), SNAPSHOT_SET_WORDS, fp) ==
+              SNAPSHOT_SET_WORDS);
+
+        if (ok)
+        {
+            ok = (fwrite((**regs).getCache.data(sw),
+                         sizeof(fm_uint32),
+                         header[6],
+                         fp) == header[6]);
+        }
+
+        if (ok && header[8] != 0)
+        {
+            valid = (**regs).getCache.valid(sw);
+            ok = (fwrite(valid->bitArrayData,
+                         sizeof(fm_uint32),
+                         header[8],
+                         fp) == header[8]);
+        }
+    }
+
+    DROP_REG_LOCK(sw);
+
+    if (fclose(fp) != 0)
+    {
+        ok = FALSE;
+    }
+
+    if (!ok || rename(tmpName, fileName) != 0)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                     "Unable to write register cache snapshot %s\n",
+                     fileName);
+        remove(tmpName);
+        return FM_FAIL;
+    }
+
+    return FM_OK;
+
+}   /* end fmRegCacheSaveSnapshot */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheLoadSnapshot
+ * \ingroup intRegCache
+ *
+ * \desc            Loads a snapshot saved by ''fmRegCacheSaveSnapshot''
+ *                  into the register cache, without touching the hardware.
+ *                  The whole snapshot is checked against the register
+ *                  list of the switch before the cache is updated, so the
+ *                  cache is left unchanged if the snapshot is rejected.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       fileName is the name of the snapshot file.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if the file does not exist.
+ * \return          FM_ERR_BAD_BUFFER if the snapshot is truncated or does
+ *                  not match the register list of the switch.
+ * \return          FM_ERR_NO_MEM if there is not enough memory.
+ * \return          FM_FAIL if the file could not be read.
+ *
+ *****************************************************************************/
+static fm_status fmRegCacheLoadSnapshot(fm_int sw, fm_text fileName)
+{
+    const fm_cachedRegs **regs;
+    const fm_cachedRegs **reg;
+    fm_bitArray *         valid;
+    FILE *                fp;
+    fm_uint32 *           snapshot;
+    fm_uint32 *           pos;
+    fm_uint32 *           data;
+    fm_uint32             header[SNAPSHOT_SET_WORDS];
+    fm_uint32             nSets;
+    fm_uint32             i;
+    fm_uint32             b;
+    long                  size;
+    fm_int                pass;
+    fm_status             err;
+
+    regs = (const fm_cachedRegs **) GET_SWITCH_PTR(sw)->CachedRegisterList;
+
+    if (regs == NULL)
+    {
+        return FM_ERR_UNINITIALIZED;
+    }
+
+    fp = fopen(fileName, "rb");
+
+    if (fp == NULL)
+    {
+        return FM_ERR_NOT_FOUND;
+    }
+
+    size = -1;
+
+    if (fseek(fp, 0, SEEK_END) == 0)
+    {
+        size = ftell(fp);
+        rewind(fp);
+    }
+
+    if (size < (long) (3 * sizeof(fm_uint32)))
+    {
+        fclose(fp);
+        return (size < 0) ? FM_FAIL : FM_ERR_BAD_BUFFER;
+    }
+
+    snapshot = fmAlloc(size);
+
+    if (snapshot == NULL)
+    {
+        fclose(fp);
+        return FM_ERR_NO_MEM;
+    }
+
+    if (fread(snapshot, 1, size, fp) != (size_t) size)
+    {
+        fclose(fp);
+        fmFree(snapshot);
+        return FM_FAIL;
+    }
+
+    fclose(fp);
+
+    for (nSets = 0 ; regs[nSets] != NULL ; nSets++)
+    {
+        /* just count the register sets */
+    }
+
+    err = FM_OK;
+
+    if ( (snapshot[0] != SNAPSHOT_MAGIC) ||
+         (snapshot[1] != SNAPSHOT_VERSION) ||
+         (snapshot[2] != nSets) )
+    {
+        err = FM_ERR_BAD_BUFFER;
+    }
+
+    /**************************************************
+     * The first pass only checks the snapshot, the
+     * second one copies it into the cache.
+     **************************************************/
+
+    for (pass = 0 ; pass < 2 && err == FM_OK ; pass++)
+    {
+        if (pass == 1)
+        {
+            TAKE_REG_LOCK(sw);
+            fmRegCacheSeqWriteBegin(sw);
+        }
+
+        pos = snapshot + 3;
+
+        for (reg = regs ; *reg != NULL ; reg++)
+        {
+            fmRegCacheSnapshotHeader(sw, *reg, header);
+
+            if ( ( (fm_byte *) (pos + SNAPSHOT_SET_WORDS + header[6] +
+                                header[8]) > (fm_byte *) snapshot + size ) ||
+                 (memcmp(pos, header, sizeof(header)) != 0) )
+            {
+                err = FM_ERR_BAD_BUFFER;
+                break;
+            }
+
+            pos += SNAPSHOT_SET_WORDS;
+
+            if (pass == 1)
+            {
+                data = (**reg).getCache.data(sw);
+
+                for (i = 0 ; i < header[6] ; i++)
+                {
+                    data[i] = pos[i];
+                }
+            }
+
+            pos += header[6];
+
+            if ( (pass == 1) && (header[8] != 0) )
+            {
+                /* Set the valid bits one by one, so that the bit array
+                 * keeps its count of non-zero bits. */
+                valid = (**reg).getCache.valid(sw);
+                fmClearBitArray(valid);
+
+                for (i = 0 ; i < header[8] ; i++)
+                {
+                    for (b = 0 ; b < (fm_uint32) valid->bitsPerWord ; b++)
+                    {
+                        if ( (pos[i] >> b) & 1 )
+                        {
+                            fmSetBitArrayBit(valid,
+                                             i * valid->bitsPerWord + b,
+                                             TRUE);
+                        }
+                    }
+                }
+            }
+
+            pos += header[8];
+        }
+
+        if (pass == 1)
+        {
+            fmRegCacheSeqWriteEnd(sw);
+            DROP_REG_LOCK(sw);
+        }
+    }
+
+    fmFree(snapshot);
+
+    if (err == FM_OK)
+    {
+        fmRegCacheInvalidateChecksums(sw, NULL);
+    }
+
+    return err;
+
+}   /* end fmRegCacheLoadSnapshot */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheReconcile
+ * \ingroup intRegCache
+ *
+ * \desc            Brings the hardware in line with the register cache,
+ *                  rewriting only the registers that differ from it.
+ *                  Register sets initialized from the hardware are read
+ *                  back and compared with the cache. Register sets
+ *                  initialized from a table of defaults are not read; any
+ *                  register whose cached value differs from its default is
+ *                  rewritten.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      nPatched points to the location to receive the number
+ *                  of registers rewritten.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if there is not enough memory.
+ *
+ *****************************************************************************/
+static fm_status fmRegCacheReconcile(fm_int sw, fm_int *nPatched)
+{
+    const fm_cachedRegs **   regs;
+    const fm_cachedRegs *    regSet;
+    fm_registerSGListEntry   entry;
+    fm_uint32                idx[FM_REGS_CACHE_MAX_INDICES];
+    fm_uint32 *              cache;
+    fm_uint32 *              hw;
+    fm_uint32                dims[FM_REGS_CACHE_MAX_INDICES];
+    fm_uint32                i;
+    fm_uint32                j;
+    fm_uint32                k;
+    fm_uint32                w;
+    fm_uint32                addr;
+    fm_bool                  differs;
+    fm_status                err;
+
+    *nPatched = 0;
+    err       = FM_OK;
+
+    regs = (const fm_cachedRegs **) GET_SWITCH_PTR(sw)->CachedRegisterList;
+
+    for ( ; regs != NULL && *regs != NULL && err == FM_OK ; regs++)
+    {
+        regSet  = *regs;
+        dims[0] = regSet->nElements[0];
+        dims[1] = (regSet->nIndices < 2) ? 1 : regSet->nElements[1];
+        dims[2] = (regSet->nIndices < 3) ? 1 : regSet->nElements[2];
+
+        hw = NULL;
+
+        if (regSet->getCache.defaults == NULL)
+        {
+            hw = fmAlloc(dims[0] * regSet->nWords * sizeof(fm_uint32));
+
+            if (hw == NULL)
+            {
+                err = FM_ERR_NO_MEM;
+                break;
+            }
+        }
+
+        for (k = 0 ; k < dims[2] && err == FM_OK ; k++)
+        {
+            for (j = 0 ; j < dims[1] && err == FM_OK ; j++)
+            {
+                idx[0] = 0;
+                idx[1] = j;
+                idx[2] = k;
+
+                TAKE_REG_LOCK(sw);
+
+                cache = regSet->getCache.data(sw) +
+                        fmRegCacheComputeOffset(idx, regSet);
+
+                if (hw != NULL)
+                {
+                    FM_CLEAR(entry);
+                    entry.registerSet = regSet;
+                    entry.data        = hw;
+                    entry.count       = dims[0];
+                    entry.idx[1]      = j;
+                    entry.idx[2]      = k;
+
+                    err = fmRegCacheReadNC(sw, 1, &entry);
+                }
+
+                for (i = 0 ; i < dims[0] && err == FM_OK ; i++)
+                {
+                    idx[0]  = i;
+                    addr    = fmRegCacheComputeAddr(idx, regSet);
+                    differs = FALSE;
+
+                    for (w = 0 ; w < regSet->nWords && !differs ; w++)
+                    {
+                        if (hw != NULL)
+                        {
+                            differs = (hw[i * regSet->nWords + w] !=
+                                       cache[i * regSet->nWords + w]);
+                        }
+                        else
+                        {
+                            differs = (regSet->getCache.defaults(addr + w) !=
+                                       cache[i * regSet->nWords + w]);
+                        }
+                    }
+
+                    if (differs)
+                    {
+                        err = fmRegCacheWriteFromCache(sw, regSet, idx, 1);
+                        (*nPatched)++;
+                    }
+                }
+
+                DROP_REG_LOCK(sw);
+            }
+        }
+
+        if (hw != NULL)
+        {
+            fmFree(hw);
+        }
+    }
+
+    return err;
+
+}   /* end fmRegCacheReconcile */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheRestoreSnapshot
+ * \ingroup intRegCache
+ *
+ * \chips           FM10000
+ *
+ * \desc            Reloads the register cache from a snapshot saved by
+ *                  ''fmRegCacheSaveSnapshot'', then verifies the hardware
+ *                  against it and rewrites the registers that differ.
+ *                  Register writes later made through ''fmRegCacheWrite''
+ *                  with useCache set are skipped wherever the restored
+ *                  cache already holds the value being written.
+ *
+ * \note            Must be called right after ''fmInitRegisterCache''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       fileName is the name of the snapshot file.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if the file does not exist.
+ * \return          FM_ERR_BAD_BUFFER if the snapshot does not match the
+ *                  register list of the switch. The cache is unchanged.
+ * \return          FM_ERR_NO_MEM if there is not enough memory.
+ * \return          FM_FAIL if the file could not be read.
+ *
+ *****************************************************************************/
+fm_status fmRegCacheRestoreSnapshot(fm_int sw, fm_text fileName)
+{
+    fm_int    nPatched;
+    fm_status err;
+
+    err = fmRegCacheLoadSnapshot(sw, fileName);
+
+    if (err == FM_OK)
+    {
+        err = fmRegCacheReconcile(sw, &nPatched);
+
+        FM_LOG_INFO(FM_LOG_CAT_SWITCH,
+                    "Restored register cache from %s, "
+                    "%d registers rewritten\n",
+                    fileName,
+                    nPatched);
+    }
+
+    return err;
+
+}   /* end fmRegCacheRestoreSnapshot */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgDumpRegCacheEntry
+ * \ingroup intRegCache
+ *
+ * \chips           FM10000
+ *
+ * \desc            Generates and dumps a scatter-gather list for a block
+ *                  of consecutive entries in the register cache.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regSet points to the register set descriptor.
+ * 
+ * \param[in]       indices points to an array specifying the indices of the
+ *                  first entry to write.
+ * 
+ * \param[in]       nEntries is the number of register entries to write.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmDbgDumpRegCacheEntry(fm_int                sw,
+                                 const fm_cachedRegs * regSet,
+                                 const fm_uint32 *     indices,
+                                 fm_int                nEntries)
+{
+    fm_scatterGatherListEntry   sgList[10];
+    fm_scatterGatherListEntry * sgItem;
+    fm_registerSGListEntry      entry;
+    fm_int                      sgListSize;
+    fm_int                      i;
+
+    FM_NOT_USED(sw);
+
+    if (regSet == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    entry.registerSet = regSet;
+    entry.data        = NULL;
+    entry.count       = nEntries;
+    entry.idx[0]      = indices[0];
+    entry.idx[1]      = indices[1];
+    entry.idx[2]      = indices[2];
+    entry.rewriting   = FALSE;
+
+    if ( !IsScatterGatherListCorrect(&entry, 1) )
     {
         FM_LOG_ERROR(FM_LOG_CAT_GENERAL, "invalid scatter-gather list\n");
         return FM_ERR_INVALID_ARGUMENT;
@@ -2441,7 +4046,7 @@ fm_status fmDbgDumpRegCacheEntry(fm_int                sw,
     entry.data  = regSet->getCache.data(sw);
     entry.data += fmRegCacheComputeOffset(indices, regSet);
 
-    sgListSize = fmRegCacheConvSGList(sw, 1, &entry, NULL, FALSE);
+    sgListSize = fmRegCacheConvSGList(sw, 1, &entry, NULL, FALSE, FALSE);
 
     if (sgListSize < 1 || sgListSize > (fm_int)FM_NENTRIES(sgList))
     {
@@ -2450,7 +4055,7 @@ fm_status fmDbgDumpRegCacheEntry(fm_int                sw,
         return FM_ERR_INVALID_ARGUMENT;
     }
 
-    fmRegCacheConvSGList(sw, 1, &entry, sgList, FALSE);
+    fmRegCacheConvSGList(sw, 1, &entry, sgList, FALSE, FALSE);
 
     FM_LOG_PRINT("No  Regaddr    Count\n");
     FM_LOG_PRINT("--  --------  ------\n");
@@ -2466,3 +4071,114 @@ fm_status fmDbgDumpRegCacheEntry(fm_int                sw,
 
 }   /* end fmDbgDumpRegCacheEntry */
 
+
+
+
+/*****************************************************************************/
+/** fmDbgDumpRegCacheWriteStats
+ * \ingroup intRegCache
+ *
+ * \chips           FM10000
+ *
+ * \desc            Displays, for each cached register set that has been
+ *                  written, the number of registers written to the hardware
+ *                  and the number suppressed because the cache already held
+ *                  the new value.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ *
+ *****************************************************************************/
+fm_status fmDbgDumpRegCacheWriteStats(fm_int sw)
+{
+    fm_switch *            switchPtr;
+    fm_regCacheWriteStats *stats;
+    fm_uint64              totalIssued     = 0;
+    fm_uint64              totalSuppressed = 0;
+
+    VALIDATE_SWITCH_INDEX(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr == NULL || switchPtr->regCacheWriteStats == NULL)
+    {
+        return FM_ERR_INVALID_SWITCH;
+    }
+
+    FM_LOG_PRINT("BaseAddr           Issued       Suppressed\n");
+    FM_LOG_PRINT("--------  ---------------  ---------------\n");
+
+    for (stats = switchPtr->regCacheWriteStats ;
+         stats->registerSet != NULL ;
+         stats++)
+    {
+        if (stats->writesIssued == 0 && stats->writesSuppressed == 0)
+        {
+            continue;
+        }
+
+        FM_LOG_PRINT("%08x  %15" FM_FORMAT_64 "u  %15" FM_FORMAT_64 "u\n",
+                     stats->registerSet->baseAddr,
+                     stats->writesIssued,
+                     stats->writesSuppressed);
+
+        totalIssued     += stats->writesIssued;
+        totalSuppressed += stats->writesSuppressed;
+    }
+
+    FM_LOG_PRINT("Total     %15" FM_FORMAT_64 "u  %15" FM_FORMAT_64 "u\n",
+                 totalIssued,
+                 totalSuppressed);
+
+    return FM_OK;
+
+}   /* end fmDbgDumpRegCacheWriteStats */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgResetRegCacheWriteStats
+ * \ingroup intRegCache
+ *
+ * \chips           FM10000
+ *
+ * \desc            Clears the write statistics of every cached register set.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ *
+ *****************************************************************************/
+fm_status fmDbgResetRegCacheWriteStats(fm_int sw)
+{
+    fm_switch *            switchPtr;
+    fm_regCacheWriteStats *stats;
+
+    VALIDATE_SWITCH_INDEX(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr == NULL || switchPtr->regCacheWriteStats == NULL)
+    {
+        return FM_ERR_INVALID_SWITCH;
+    }
+
+    TAKE_REG_LOCK(sw);
+
+    for (stats = switchPtr->regCacheWriteStats ;
+         stats->registerSet != NULL ;
+         stats++)
+    {
+        stats->writesIssued     = 0;
+        stats->writesSuppressed = 0;
+    }
+
+    DROP_REG_LOCK(sw);
+
+    return FM_OK;
+
+}   /* end fmDbgResetRegCacheWriteStats */
@@ -40,6 +40,17 @@
 #define DEBUG_TRACK_MEMORY_USE
 #endif
 
+/* Position of a route in a route list operation, sorted by prefix. */
+typedef struct _fm_routeListOrder
+{
+    /* Prefix length of the route. */
+    fm_int  prefixLength;
+
+    /* Index of the route in the caller's list. */
+    fm_int  index;
+
+} fm_routeListOrder;
+
 
 /*****************************************************************************
  * Global Variables
@@ -64,6 +75,21 @@ static void SetVirtualRouterMac(fm_switch *switchPtr,
                                 fm_int     vrMacId,
                                 fm_macaddr macAddr);
 static void DestroyRecord(void *key, void *data);
+static fm_status ValidateNewRoute(fm_routeEntry *route);
+static fm_status NotifyRouteChange(fm_int sw);
+static fm_int CompareRouteListOrder(const void *first, const void *second);
+static fm_status RunRouteList(fm_int          sw,
+                              fm_int          numRoutes,
+                              fm_routeEntry * routes,
+                              fm_routeState * states,
+                              fm_routeAction *actions,
+                              fm_status *     results,
+                              fm_bool         isDelete);
+static fm_status ReadRoutePage(fm_switch *     switchPtr,
+                               fm_routeCursor *cursor,
+                               fm_int *        numRoutes,
+                               fm_routeEntry * routes,
+                               fm_int          maxRoutes);
 
 
 /*****************************************************************************
@@ -147,6 +173,12 @@ static void FreeRoute(void *key, void *value)
 
     FM_NOT_USED(key);
 
+    if (routePtr->vnTunnelsTree != NULL)
+    {
+        fmTreeDestroy(routePtr->vnTunnelsTree, NULL);
+        fmFree(routePtr->vnTunnelsTree);
+    }
+
     fmFree(routePtr);
 
 }   /* end FreeRoute */
@@ -628,6 +660,388 @@ static void DestroyRecord(void *key, void *data)
 
 
 
+/*****************************************************************************/
+/** ValidateNewRoute
+ * \ingroup intRoute
+ *
+ * \desc            Checks a route passed to one of the functions that add
+ *                  unicast routes.
+ *
+ * \param[in]       route points to the route to check.
+ *
+ * \return          FM_OK if the route may be added.
+ * \return          FM_ERR_INVALID_ARGUMENT if route is NULL or its prefix
+ *                  length is out of range.
+ * \return          FM_ERR_USE_MCAST_FUNCTIONS if route is a multicast
+ *                  route.
+ *
+ *****************************************************************************/
+static fm_status ValidateNewRoute(fm_routeEntry *route)
+{
+    fm_ipAddr destAddr;
+    fm_int    maxPrefix;
+    fm_int    prefixLength;
+
+    if (route == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    if ( !fmIsRouteEntryUnicast(route) )
+    {
+        return FM_ERR_USE_MCAST_FUNCTIONS;
+    }
+
+    fmGetRouteDestAddress(route, &destAddr);
+
+    prefixLength = route->data.unicast.prefixLength;
+
+    maxPrefix = (destAddr.isIPv6)
+                ? FM_IPV6_MAX_PREFIX_LENGTH
+                : FM_IPV4_MAX_PREFIX_LENGTH;
+
+    if ( (prefixLength < 0) || (prefixLength > maxPrefix) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    return FM_OK;
+
+}   /* end ValidateNewRoute */
+
+
+
+
+/*****************************************************************************/
+/** NotifyRouteChange
+ * \ingroup intRoute
+ *
+ * \desc            Lets the virtual network tunnels follow a change of the
+ *                  routing table. During a route list operation, the
+ *                  tunnels are updated once, when the operation ends.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status NotifyRouteChange(fm_int sw)
+{
+    fm_switch *switchPtr;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->routeListActive)
+    {
+        switchPtr->routeListChanged = TRUE;
+        return FM_OK;
+    }
+
+    return fmNotifyVNTunnelAboutRouteChange(sw);
+
+}   /* end NotifyRouteChange */
+
+
+
+
+/*****************************************************************************/
+/** CompareRouteListOrder
+ * \ingroup intRoute
+ *
+ * \desc            Compares two routes of a route list operation, longest
+ *                  prefix first, then in the caller's order. Called
+ *                  through qsort.
+ *
+ * \param[in]       first points to the first ''fm_routeListOrder''.
+ *
+ * \param[in]       second points to the second ''fm_routeListOrder''.
+ *
+ * \return          -1 if the first route sorts before the second.
+ * \return           0 if the routes are identical.
+ * \return           1 if the first route sorts after the second.
+ *
+ *****************************************************************************/
+static fm_int CompareRouteListOrder(const void *first, const void *second)
+{
+    const fm_routeListOrder *a = first;
+    const fm_routeListOrder *b = second;
+
+    if (a->prefixLength != b->prefixLength)
+    {
+        return (a->prefixLength > b->prefixLength) ? -1 : 1;
+    }
+
+    if (a->index != b->index)
+    {
+        return (a->index < b->index) ? -1 : 1;
+    }
+
+    return 0;
+
+}   /* end CompareRouteListOrder */
+
+
+
+
+/*****************************************************************************/
+/** RunRouteList
+ * \ingroup intRoute
+ *
+ * \desc            Adds or deletes a list of unicast routes under a single
+ *                  acquisition of the routing lock. Routes are processed
+ *                  longest prefix first so that each prefix range of the
+ *                  routing table is changed in one place, and the virtual
+ *                  network tunnels are updated once at the end.
+ *                                                                      \lb\lb
+ *                  Called with the switch protected.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numRoutes is the number of entries in routes.
+ *
+ * \param[in]       routes points to the list of routes.
+ *
+ * \param[in]       states points to the list of route states, may be NULL.
+ *                  Not used when deleting.
+ *
+ * \param[in]       actions points to the list of route actions, may be
+ *                  NULL. Not used when deleting.
+ *
+ * \param[out]      results points to caller-allocated storage for the
+ *                  status of each route, may be NULL.
+ *
+ * \param[in]       isDelete is TRUE to delete the routes, FALSE to add them.
+ *
+ * \return          FM_OK if every route was processed successfully.
+ * \return          the status of the first failing route otherwise, in
+ *                  list order.
+ *
+ *****************************************************************************/
+static fm_status RunRouteList(fm_int          sw,
+                              fm_int          numRoutes,
+                              fm_routeEntry * routes,
+                              fm_routeState * states,
+                              fm_routeAction *actions,
+                              fm_status *     results,
+                              fm_bool         isDelete)
+{
+    fm_switch *         switchPtr;
+    fm_routeListOrder * order;
+    fm_status *         status;
+    fm_routeEntry *     route;
+    fm_routeState       state;
+    fm_routeAction      defaultAction;
+    fm_routeAction *    action;
+    fm_status           err;
+    fm_status           firstErr;
+    fm_int              numValid;
+    fm_int              i;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    order  = fmAlloc( numRoutes * sizeof(fm_routeListOrder) );
+    status = fmAlloc( numRoutes * sizeof(fm_status) );
+
+    if ( (order == NULL) || (status == NULL) )
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    /* Check every route before taking the lock. */
+    numValid = 0;
+
+    for (i = 0 ; i < numRoutes ; i++)
+    {
+        route = &routes[i];
+
+        if (isDelete)
+        {
+            status[i] = fmIsRouteEntryUnicast(route)
+                        ? FM_OK
+                        : FM_ERR_USE_MCAST_FUNCTIONS;
+        }
+        else
+        {
+            status[i] = ValidateNewRoute(route);
+        }
+
+        if (status[i] == FM_OK)
+        {
+            order[numValid].prefixLength = route->data.unicast.prefixLength;
+            order[numValid].index        = i;
+            numValid++;
+        }
+    }
+
+    qsort(order,
+          numValid,
+          sizeof(fm_routeListOrder),
+          CompareRouteListOrder);
+
+    defaultAction.action = FM_ROUTE_ACTION_ROUTE;
+
+    err = fmCaptureWriteLock(&switchPtr->routingLock, FM_WAIT_FOREVER);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
+
+    switchPtr->routeListActive  = TRUE;
+    switchPtr->routeListChanged = FALSE;
+
+    for (i = 0 ; i < numValid ; i++)
+    {
+        route = &routes[order[i].index];
+
+        if (isDelete)
+        {
+            status[order[i].index] = fmDeleteRouteInternal(sw, route);
+        }
+        else
+        {
+            state  = (states != NULL) ? states[order[i].index]
+                                      : FM_ROUTE_STATE_UP;
+            action = (actions != NULL) ? &actions[order[i].index]
+                                       : &defaultAction;
+
+            status[order[i].index] =
+                fmAddRouteInternal(sw, route, state, action);
+        }
+    }
+
+    switchPtr->routeListActive = FALSE;
+
+    if (switchPtr->routeListChanged)
+    {
+        switchPtr->routeListChanged = FALSE;
+        err = fmNotifyVNTunnelAboutRouteChange(sw);
+    }
+
+    fmReleaseWriteLock(&switchPtr->routingLock);
+
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
+
+    firstErr = FM_OK;
+
+    for (i = 0 ; i < numRoutes ; i++)
+    {
+        if ( (status[i] != FM_OK) && (firstErr == FM_OK) )
+        {
+            firstErr = status[i];
+        }
+
+        if (results != NULL)
+        {
+            results[i] = status[i];
+        }
+    }
+
+    err = firstErr;
+
+ABORT:
+
+    if (order != NULL)
+    {
+        fmFree(order);
+    }
+
+    if (status != NULL)
+    {
+        fmFree(status);
+    }
+
+    return err;
+
+}   /* end RunRouteList */
+
+
+
+
+/*****************************************************************************/
+/** ReadRoutePage
+ * \ingroup intRouter
+ *
+ * \desc            Copies the next page of a route table walk. The cursor's
+ *                  tree iterator is reused as long as the route table
+ *                  generation is unchanged; otherwise the walk is
+ *                  repositioned after the last route returned.
+ *
+ * \note            The caller must hold the routing lock for reading.
+ *
+ * \param[in]       switchPtr points to the switch state table.
+ *
+ * \param[in,out]   cursor points to the position of the walk.
+ *
+ * \param[out]      numRoutes receives the number of routes copied.
+ *
+ * \param[out]      routes points to the array to be filled in.
+ *
+ * \param[in]       maxRoutes is the size of routes.
+ *
+ * \return          FM_OK if at least one route was copied.
+ * \return          FM_ERR_NO_MORE if the walk is complete.
+ *
+ *****************************************************************************/
+static fm_status ReadRoutePage(fm_switch *     switchPtr,
+                               fm_routeCursor *cursor,
+                               fm_int *        numRoutes,
+                               fm_routeEntry * routes,
+                               fm_int          maxRoutes)
+{
+    fm_status         err;
+    fm_uint           generation;
+    fm_intRouteEntry  key;
+    fm_intRouteEntry *keyPtr;
+    fm_intRouteEntry *route;
+    fm_int            count;
+
+    generation = fmCustomTreeGeneration(&switchPtr->routeTree);
+
+    if (!cursor->started)
+    {
+        fmCustomTreeIterInit(&cursor->iter, &switchPtr->routeTree);
+    }
+    else if (generation != cursor->generation)
+    {
+        key.route = cursor->lastRoute;
+        fmCustomTreeIterInitAfterKey(&cursor->iter,
+                                     &switchPtr->routeTree,
+                                     &key);
+        cursor->tableChanged = TRUE;
+    }
+
+    cursor->generation = generation;
+
+    err   = FM_OK;
+    count = 0;
+
+    while (count < maxRoutes)
+    {
+        err = fmCustomTreeIterNext(&cursor->iter,
+                                   (void **) &keyPtr,
+                                   (void **) &route);
+        if (err != FM_OK)
+        {
+            break;
+        }
+
+        routes[count++] = route->route;
+    }
+
+    if (count > 0)
+    {
+        cursor->lastRoute = routes[count - 1];
+        cursor->started   = TRUE;
+        err               = FM_OK;
+    }
+
+    *numRoutes = count;
+
+    return err;
+
+}   /* end ReadRoutePage */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -985,6 +1399,19 @@ fm_status fmGetIntRouteForIP(fm_int             sw,
         FM_LOG_EXIT(FM_LOG_CAT_ROUTING, FM_ERR_INVALID_ARGUMENT);
     }
 
+    if (switchPtr->routeLpm != NULL)
+    {
+        route = fmRouteLpmLookup(sw, vrid, ip);
+
+        if (route == NULL)
+        {
+            FM_LOG_EXIT(FM_LOG_CAT_ROUTING, FM_ERR_NO_ROUTE_TO_HOST);
+        }
+
+        *routePtrPtr = route;
+        FM_LOG_EXIT(FM_LOG_CAT_ROUTING, FM_OK);
+    }
+
     if (ip->isIPv6)
     {
         prefixLength = FM_IPV6_MAX_PREFIX_LENGTH;
@@ -1141,6 +1568,7 @@ fm_status fmRouterAlloc(fm_int sw)
     switchPtr->virtualRouterMacModes = NULL;
     switchPtr->virtualRouterIds      = NULL;
     switchPtr->routeLookupTrees      = NULL;
+    switchPtr->routeLpm              = NULL;
 
     /* If routing is not supported, exit */
     if (switchPtr->RouterInit != NULL)
@@ -1151,7 +1579,8 @@ fm_status fmRouterAlloc(fm_int sw)
         if (switchPtr->maxVirtualRouters > 0)
         {
             tsize = sizeof(fm_routerState) * switchPtr->maxVirtualRouters;
-            switchPtr->virtualRouterStates = (fm_routerState *) fmAlloc(tsize);
+            switchPtr->virtualRouterStates = (fm_routerState *) fmAllocTagged(tsize,
+                                                                              FM_LOG_CAT_ROUTING);
 
             if (switchPtr->virtualRouterStates != NULL)
             {
@@ -1165,7 +1594,8 @@ fm_status fmRouterAlloc(fm_int sw)
             if (err == FM_OK)
             {
                 tsize = sizeof(fm_routerMacMode) * switchPtr->maxVirtualRouters;
-                switchPtr->virtualRouterMacModes = (fm_routerMacMode *) fmAlloc(tsize);
+                switchPtr->virtualRouterMacModes = (fm_routerMacMode *) fmAllocTagged(tsize,
+                                                                                      FM_LOG_CAT_ROUTING);
                 if (switchPtr->virtualRouterMacModes != NULL)
                 {
                     FM_MEMSET_S(switchPtr->virtualRouterMacModes, tsize, 0, tsize);
@@ -1179,7 +1609,8 @@ fm_status fmRouterAlloc(fm_int sw)
             if (err == FM_OK)
             {
                 tsize = sizeof(fm_int) * switchPtr->maxVirtualRouters;
-                switchPtr->virtualRouterIds = (fm_int *) fmAlloc(tsize);
+                switchPtr->virtualRouterIds = (fm_int *) fmAllocTagged(tsize,
+                                                                       FM_LOG_CAT_ROUTING);
                 if (switchPtr->virtualRouterIds != NULL)
                 {
                     FM_MEMSET_S(switchPtr->virtualRouterIds, tsize, 0, tsize);
@@ -1204,7 +1635,8 @@ fm_status fmRouterAlloc(fm_int sw)
                     /* Additional virtual number is for vrid = FM_ROUTER_ANY */
                     tsize = sizeof(fm_customTree) * (switchPtr->maxVirtualRouters + 1)
                             * FM_MAX_NUM_IP_PREFIXES;
-                    switchPtr->routeLookupTrees = fmAlloc(tsize);
+                    switchPtr->routeLookupTrees = fmAllocTagged(tsize,
+                                                                FM_LOG_CAT_ROUTING);
                     if (switchPtr->routeLookupTrees != NULL)
                     {
                         FM_MEMSET_S(switchPtr->routeLookupTrees, tsize, 0, tsize);
@@ -1213,6 +1645,11 @@ fm_status fmRouterAlloc(fm_int sw)
                     {
                         err = FM_ERR_NO_MEM;
                     }
+
+                    if (err == FM_OK)
+                    {
+                        err = fmAllocRouteLpm(sw);
+                    }
                 }
             }
         }
@@ -1274,6 +1711,8 @@ fm_status fmRouterFree(fm_int sw)
         switchPtr->routeLookupTrees = NULL;
     }
 
+    fmFreeRouteLpm(sw);
+
     FM_LOG_EXIT(FM_LOG_CAT_ROUTING, FM_OK);
 
 }   /* end fmRouterFree */
@@ -1311,12 +1750,15 @@ fm_status fmRouterInit(fm_int sw)
     }
 
     /**************************************************
-     * Init Route Table
+     * Init Route Table. The route tables can hold a
+     * very large number of routes and are walked in
+     * order, so they are B+trees.
      **************************************************/
     if (switchPtr->maxRoutes > 0)
     {
-        fmCustomTreeInit(&switchPtr->routeTree, fmCompareIntRoutes);
-        fmCustomTreeInit(&switchPtr->ecmpRouteTree, fmCompareEcmpIntRoutes);
+        fmCustomTreeInitBtree(&switchPtr->routeTree, fmCompareIntRoutes);
+        fmCustomTreeInitBtree(&switchPtr->ecmpRouteTree,
+                              fmCompareEcmpIntRoutes);
     }
 
     /**************************************************
@@ -1361,7 +1803,7 @@ fm_status fmRouterInit(fm_int sw)
         {
             for (index2 = 0 ; index2 < FM_MAX_NUM_IP_PREFIXES ; index2++)
             {
-                fmCustomTreeInit(routeLookupTree++, fmCompareIPAddrs);
+                fmCustomTreeInitBtree(routeLookupTree++, fmCompareIPAddrs);
             }
         }
     }
@@ -1412,6 +1854,8 @@ fm_status fmRouterCleanup(fm_int sw)
                 routeLookupTree++;
             }
         }
+
+        fmClearRouteLpm(sw);
     }
 
     /**************************************************
@@ -2678,7 +3122,7 @@ fm_status fmAddRouteInternal(fm_int          sw,
     }
 
     /* Allocate and initialize a new route record */
-    routeEntry = fmAlloc( sizeof(fm_intRouteEntry) );
+    routeEntry = fmAllocTagged( sizeof(fm_intRouteEntry), FM_LOG_CAT_ROUTING );
 
     if (routeEntry == NULL)
     {
@@ -2707,8 +3151,9 @@ fm_status fmAddRouteInternal(fm_int          sw,
     routeEntry->routeEcmpGroupId = -1;
     routeEntry->mcastGroup       = group;
 
-    /* Initialize vn tunnels tree. No tunnels are currently using this route. */
-    fmTreeInit(&routeEntry->vnTunnelsTree);
+    /* No tunnels are currently using this route, the vn tunnels tree is
+     * allocated when one does. */
+    routeEntry->vnTunnelsTree    = NULL;
 
     ecmpGroup = NULL;
 
@@ -2959,6 +3404,9 @@ fm_status fmAddRouteInternal(fm_int          sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
 
         routeAddedToLookupTree = TRUE;
+
+        err = fmRouteLpmInsert(sw, vrid, routePrefixLength, routeEntry);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
     }
 
     /* Now add the route into the hardware */
@@ -2973,7 +3421,7 @@ fm_status fmAddRouteInternal(fm_int          sw,
         *group->routePtrPtr = routeEntry;
     }
 
-    err = fmNotifyVNTunnelAboutRouteChange(sw);
+    err = NotifyRouteChange(sw);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
 
 
@@ -3012,6 +3460,7 @@ ABORT:
         if (routeAddedToLookupTree)
         {
             fmCustomTreeRemove(routeLookupTree, routeEntry->destIPAddress, NULL);
+            fmRouteLpmRemove(sw, vrid, routePrefixLength, routeEntry);
         }
 
         if (routeAllocated)
@@ -3162,9 +3611,6 @@ fm_status fmAddRouteExt(fm_int          sw,
 {
     fm_switch *           switchPtr;
     fm_status             err;
-    fm_ipAddr             destAddr;
-    fm_int                maxPrefix;
-    fm_int                prefixLength;
     static fm_routeAction defaultAction =
     {
         .action = FM_ROUTE_ACTION_ROUTE
@@ -3199,29 +3645,10 @@ fm_status fmAddRouteExt(fm_int          sw,
     }
 
     /* error-check incoming route information */
-    if (route == NULL)
-    {
-        err = FM_ERR_INVALID_ARGUMENT;
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
-    }
-
-    if ( !fmIsRouteEntryUnicast(route) )
-    {
-        err = FM_ERR_USE_MCAST_FUNCTIONS;
-        goto ABORT;
-    }
-
-    fmGetRouteDestAddress(route, &destAddr);
-
-    prefixLength = route->data.unicast.prefixLength;
-
-    maxPrefix = (destAddr.isIPv6)
-                ? FM_IPV6_MAX_PREFIX_LENGTH
-                : FM_IPV4_MAX_PREFIX_LENGTH;
+    err = ValidateNewRoute(route);
 
-    if ( (prefixLength < 0) || (prefixLength > maxPrefix) )
+    if (err != FM_OK)
     {
-        err = FM_ERR_INVALID_ARGUMENT;
         goto ABORT;
     }
 
@@ -3417,7 +3844,7 @@ fm_status fmDeleteRouteInternal(fm_int         sw,
     {
         /* Allocate storage for the nexthop(s) that need to be deleted. */
         size        = sizeof(fm_ecmpNextHop) * switchPtr->maxEcmpGroupSize;
-        nextHopList = fmAlloc(size);
+        nextHopList = fmAllocTagged(size, FM_LOG_CAT_ROUTING);
 
         if (nextHopList == NULL)
         {
@@ -3480,6 +3907,7 @@ fm_status fmDeleteRouteInternal(fm_int         sw,
                     fmCustomTreeRemove(routeLookupTree,
                                        ecmpRoute->destIPAddress,
                                        NULL);
+                    fmRouteLpmRemove(sw, vrid, routePrefixLength, ecmpRoute);
                 }
 
                 /* Get the first remaining next hop from the ECMP group. */
@@ -3515,6 +3943,12 @@ fm_status fmDeleteRouteInternal(fm_int         sw,
                                              ecmpRoute->destIPAddress,
                                              ecmpRoute);
                     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
+
+                    err = fmRouteLpmInsert(sw,
+                                           vrid,
+                                           routePrefixLength,
+                                           ecmpRoute);
+                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
                 }
 
                 /* Copy the route state into the new base ECMP route */
@@ -3536,7 +3970,7 @@ fm_status fmDeleteRouteInternal(fm_int         sw,
                              (void *) ecmpRoute);
             }
 
-            fmFree(curRoute);
+            FreeRoute(NULL, curRoute);
 
             err = FM_OK;
             goto ABORT;
@@ -3568,6 +4002,7 @@ fm_status fmDeleteRouteInternal(fm_int         sw,
     if (routeLookupTree != NULL)
     {
         fmCustomTreeRemove(routeLookupTree, curRoute->destIPAddress, NULL);
+        fmRouteLpmRemove(sw, vrid, routePrefixLength, curRoute);
     }
 
     switch (curRoute->route.routeType)
@@ -3593,9 +4028,9 @@ fm_status fmDeleteRouteInternal(fm_int         sw,
         *curRoute->mcastGroup->routePtrPtr = NULL;
     }
 
-    fmFree(curRoute);
+    FreeRoute(NULL, curRoute);
 
-    err = fmNotifyVNTunnelAboutRouteChange(sw);
+    err = NotifyRouteChange(sw);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
 
 
@@ -3698,6 +4133,176 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fmAddRouteList
+ * \ingroup routerRoute
+ *
+ * \chips           FM10000
+ *
+ * \desc            Add a list of unicast routes to the router table in a
+ *                  single operation. The routing table is locked once for
+ *                  the whole list, routes are inserted longest prefix
+ *                  first, and dependent virtual network tunnels are
+ *                  updated once at the end. Each route is otherwise
+ *                  handled as by ''fmAddRouteExt''; a failing route does
+ *                  not prevent the others from being added.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numRoutes is the number of routes in the list.
+ *
+ * \param[in]       routes points to an array of numRoutes routes.
+ *
+ * \param[in]       states points to an array of numRoutes initial route
+ *                  states. May be NULL, in which case every route is
+ *                  added with state ''FM_ROUTE_STATE_UP''.
+ *
+ * \param[in]       actions points to an array of numRoutes route actions.
+ *                  May be NULL, in which case every route is added with
+ *                  action ''FM_ROUTE_ACTION_ROUTE''.
+ *
+ * \param[out]      results points to a caller-allocated array of numRoutes
+ *                  entries that receives the status of each route. May be
+ *                  NULL.
+ *
+ * \return          FM_OK if every route was added successfully.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if routes is NULL or numRoutes
+ *                  is not positive.
+ * \return          FM_ERR_UNSUPPORTED if routing is not available on the
+ *                  switch.
+ * \return          FM_ERR_NO_MEM if the list could not be processed for
+ *                  lack of memory.
+ * \return          the status of the first route that failed, in list
+ *                  order, otherwise. See ''fmAddRouteExt''.
+ *
+ *****************************************************************************/
+fm_status fmAddRouteList(fm_int          sw,
+                         fm_int          numRoutes,
+                         fm_routeEntry * routes,
+                         fm_routeState * states,
+                         fm_routeAction *actions,
+                         fm_status *     results)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    FM_LOG_ENTRY_API( FM_LOG_CAT_ROUTING,
+                      "sw = %d, numRoutes=%d, routes=%p, states=%p, "
+                      "actions=%p, results=%p\n",
+                      sw,
+                      numRoutes,
+                      (void *) routes,
+                      (void *) states,
+                      (void *) actions,
+                      (void *) results );
+
+    if ( (routes == NULL) || (numRoutes <= 0) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_ROUTING, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if ( (switchPtr->AddRoute == NULL) || (switchPtr->maxRoutes <= 0) )
+    {
+        err = FM_ERR_UNSUPPORTED;
+        goto ABORT;
+    }
+
+    err = RunRouteList(sw, numRoutes, routes, states, actions, results, FALSE);
+
+ABORT:
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ROUTING, err);
+
+}   /* end fmAddRouteList */
+
+
+
+
+/*****************************************************************************/
+/** fmDeleteRouteList
+ * \ingroup routerRoute
+ *
+ * \chips           FM10000
+ *
+ * \desc            Delete a list of unicast routes from the router table in
+ *                  a single operation. The routing table is locked once
+ *                  for the whole list and dependent virtual network
+ *                  tunnels are updated once at the end. Each route is
+ *                  otherwise handled as by ''fmDeleteRoute''; a failing
+ *                  route does not prevent the others from being deleted.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numRoutes is the number of routes in the list.
+ *
+ * \param[in]       routes points to an array of numRoutes routes.
+ *
+ * \param[out]      results points to a caller-allocated array of numRoutes
+ *                  entries that receives the status of each route. May be
+ *                  NULL.
+ *
+ * \return          FM_OK if every route was deleted successfully.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if routes is NULL or numRoutes
+ *                  is not positive.
+ * \return          FM_ERR_UNSUPPORTED if routing is not available on the
+ *                  switch.
+ * \return          FM_ERR_NO_MEM if the list could not be processed for
+ *                  lack of memory.
+ * \return          the status of the first route that failed, in list
+ *                  order, otherwise. See ''fmDeleteRoute''.
+ *
+ *****************************************************************************/
+fm_status fmDeleteRouteList(fm_int         sw,
+                            fm_int         numRoutes,
+                            fm_routeEntry *routes,
+                            fm_status *    results)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    FM_LOG_ENTRY_API( FM_LOG_CAT_ROUTING,
+                      "sw = %d, numRoutes=%d, routes=%p, results=%p\n",
+                      sw,
+                      numRoutes,
+                      (void *) routes,
+                      (void *) results );
+
+    if ( (routes == NULL) || (numRoutes <= 0) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_ROUTING, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if ( (switchPtr->DeleteRoute == NULL) || (switchPtr->maxRoutes <= 0) )
+    {
+        err = FM_ERR_UNSUPPORTED;
+        goto ABORT;
+    }
+
+    err = RunRouteList(sw, numRoutes, routes, NULL, NULL, results, TRUE);
+
+ABORT:
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ROUTING, err);
+
+}   /* end fmDeleteRouteList */
+
+
+
+
 /*****************************************************************************/
 /** fmReplaceRouteECMP
  * \ingroup routerRoute
@@ -4806,6 +5411,170 @@ ABORT:
 
 
 
+
+/*****************************************************************************/
+/** fmGetRouteTableFirst
+ * \ingroup routerRoute
+ *
+ * \chips           FM4000, FM6000, FM10000
+ *
+ * \desc            Begins a paged walk of the route table and retrieves its
+ *                  first page. The routes are sorted by VRID and longest
+ *                  prefix match. Use ''fmGetRouteTableNext'' to retrieve
+ *                  the following pages.
+ *                                                                      \lb\lb
+ *                  Unlike ''fmGetRouteNext'', which looks up the previous
+ *                  route again on every call, the cursor keeps the walk's
+ *                  position so that reading the whole table takes time
+ *                  proportional to its size, with one lock acquisition per
+ *                  page. The routing lock is not held between pages.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      cursor points to caller-allocated storage where this
+ *                  function is to store the position of the walk.
+ *
+ * \param[out]      numRoutes points to caller-allocated storage where this
+ *                  function is to store the number of routes retrieved.
+ *
+ * \param[out]      routes points to an array of ''fm_routeEntry''
+ *                  structures that will be filled in by this function.
+ *
+ * \param[in]       maxRoutes is the size of routes, being the maximum
+ *                  number of routes in a page.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MORE if there are no routes in this switch.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_UNSUPPORTED if routing is not available on the switch.
+ *
+ *****************************************************************************/
+fm_status fmGetRouteTableFirst(fm_int          sw,
+                               fm_routeCursor *cursor,
+                               fm_int *        numRoutes,
+                               fm_routeEntry * routes,
+                               fm_int          maxRoutes)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ROUTING,
+                     "sw=%d cursor=%p numRoutes=%p routes=%p maxRoutes=%d\n",
+                     sw,
+                     (void *) cursor,
+                     (void *) numRoutes,
+                     (void *) routes,
+                     maxRoutes);
+
+    if (cursor == NULL)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_ROUTING, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    FM_CLEAR(*cursor);
+
+    err = fmGetRouteTableNext(sw, cursor, numRoutes, routes, maxRoutes);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ROUTING, err);
+
+}   /* end fmGetRouteTableFirst */
+
+
+
+
+/*****************************************************************************/
+/** fmGetRouteTableNext
+ * \ingroup routerRoute
+ *
+ * \chips           FM4000, FM6000, FM10000
+ *
+ * \desc            Retrieves the next page of a paged walk of the route
+ *                  table begun by ''fmGetRouteTableFirst''.
+ *                                                                      \lb\lb
+ *                  If routes are added or deleted between pages, the walk
+ *                  resumes after the last route returned and the
+ *                  tableChanged field of the cursor is set.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   cursor points to the position of the walk, as returned
+ *                  by the previous call.
+ *
+ * \param[out]      numRoutes points to caller-allocated storage where this
+ *                  function is to store the number of routes retrieved.
+ *
+ * \param[out]      routes points to an array of ''fm_routeEntry''
+ *                  structures that will be filled in by this function.
+ *
+ * \param[in]       maxRoutes is the size of routes, being the maximum
+ *                  number of routes in a page.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MORE if the walk is complete.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_UNSUPPORTED if routing is not available on the switch.
+ *
+ *****************************************************************************/
+fm_status fmGetRouteTableNext(fm_int          sw,
+                              fm_routeCursor *cursor,
+                              fm_int *        numRoutes,
+                              fm_routeEntry * routes,
+                              fm_int          maxRoutes)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+    fm_bool    lockTaken = FALSE;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ROUTING,
+                     "sw=%d cursor=%p numRoutes=%p routes=%p maxRoutes=%d\n",
+                     sw,
+                     (void *) cursor,
+                     (void *) numRoutes,
+                     (void *) routes,
+                     maxRoutes);
+
+    if ( cursor == NULL || numRoutes == NULL || routes == NULL ||
+         maxRoutes <= 0 )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_ROUTING, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    *numRoutes = 0;
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->maxRoutes <= 0)
+    {
+        err = FM_ERR_UNSUPPORTED;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
+    }
+
+    err = fmCaptureReadLock(&switchPtr->routingLock, FM_WAIT_FOREVER);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
+
+    lockTaken = TRUE;
+
+    err = ReadRoutePage(switchPtr, cursor, numRoutes, routes, maxRoutes);
+
+
+ABORT:
+
+    if (lockTaken)
+    {
+        fmReleaseReadLock(&switchPtr->routingLock);
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ROUTING, err);
+
+}   /* end fmGetRouteTableNext */
+
+
+
 /*****************************************************************************/
 /** fmIsUnicastIPAddress
  * \ingroup intRouter
@@ -6300,6 +7069,9 @@ fm_status fmDbgDumpRouteLookupTrees(fm_int sw, fm_int vrid)
     fm_ipAddr *           routeIP;
     fm_intRouteEntry *    route;
     fm_char               routeDesc[1000];
+    fm_int                numNodes;
+    fm_int                peakNodes;
+    fm_int                numBytes;
 
     VALIDATE_AND_PROTECT_SWITCH( sw );
 
@@ -6345,6 +7117,14 @@ fm_status fmDbgDumpRouteLookupTrees(fm_int sw, fm_int vrid)
         }
     }
 
+    fmGetRouteLpmMemory(sw, &numNodes, &peakNodes, &numBytes);
+
+    FM_LOG_PRINT( "\nLPM index (all virtual routers): %d nodes "
+                  "(peak %d), %d bytes\n",
+                  numNodes,
+                  peakNodes,
+                  numBytes );
+
     UNPROTECT_SWITCH( sw );
 
     return FM_OK;
@@ -6893,6 +7673,171 @@ fm_status fmDbgGetRouteCount(fm_int sw, fm_int *countPtr)
 }   /* end fmDbgGetRouteCount */
 
 
+
+
+/*****************************************************************************/
+/** fmDbgDumpRouteMemory
+ * \ingroup diagMisc
+ *
+ * \chips           FM10000
+ *
+ * \desc            Displays the memory used by the routing subsystem to hold
+ *                  its routes, broken down by record type, together with
+ *                  the average number of bytes per route.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_UNSUPPORTED if routing is not supported.
+ *
+ *****************************************************************************/
+fm_status fmDbgDumpRouteMemory(fm_int sw)
+{
+    fm_switch *           switchPtr;
+    fm_status             err;
+    fm_bool               lockTaken;
+    fm_customTreeIterator iter;
+    fm_intRouteEntry *    routePtr;
+    fm_intEcmpGroup *     ecmpGroup;
+    void *                key;
+    fm_uint               numRoutes;
+    fm_uint64             routeBytes;
+    fm_uint64             treeBytes;
+    fm_uint64             vnBytes;
+    fm_uint64             lpmBytes;
+    fm_uint64             chipBytes;
+    fm_uint64             total;
+    fm_int                numTrees;
+    fm_int                i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ROUTING, "sw = %d\n", sw);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    lockTaken = FALSE;
+
+    if (switchPtr->maxRoutes <= 0)
+    {
+        err = FM_ERR_UNSUPPORTED;
+        goto ABORT;
+    }
+
+    err = fmCaptureReadLock(&switchPtr->routingLock, FM_WAIT_FOREVER);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
+    lockTaken = TRUE;
+
+    numRoutes  = fmCustomTreeSize(&switchPtr->routeTree);
+    routeBytes = (fm_uint64) numRoutes * sizeof(fm_intRouteEntry);
+
+    /* Nodes of the trees that index the routes */
+    treeBytes  = fmCustomTreeMemoryUsage(&switchPtr->routeTree);
+    treeBytes += fmCustomTreeMemoryUsage(&switchPtr->ecmpRouteTree);
+
+    if (switchPtr->routeLookupTrees != NULL)
+    {
+        numTrees = (switchPtr->maxVirtualRouters + 1) * FM_MAX_NUM_IP_PREFIXES;
+
+        for (i = 0 ; i < numTrees ; i++)
+        {
+            treeBytes +=
+                fmCustomTreeMemoryUsage(&switchPtr->routeLookupTrees[i]);
+        }
+    }
+
+    if (switchPtr->ecmpGroups != NULL)
+    {
+        for (i = 0 ; i < switchPtr->maxArpEntries ; i++)
+        {
+            ecmpGroup = switchPtr->ecmpGroups[i];
+
+            if (ecmpGroup != NULL)
+            {
+                treeBytes += fmCustomTreeMemoryUsage(&ecmpGroup->routeTree);
+            }
+        }
+    }
+
+    /* Virtual network tunnel trees, only present on tunnel routes */
+    vnBytes = 0;
+
+    if ( fmCustomTreeIsInitialized(&switchPtr->vnTunnelRoutes) )
+    {
+        fmCustomTreeIterInit(&iter, &switchPtr->vnTunnelRoutes);
+
+        while ( fmCustomTreeIterNext(&iter,
+                                     &key,
+                                     (void **) &routePtr) == FM_OK )
+        {
+            if (routePtr->vnTunnelsTree != NULL)
+            {
+                vnBytes += sizeof(fm_tree) +
+                           fmTreeMemoryUsage(routePtr->vnTunnelsTree);
+            }
+        }
+    }
+
+    lpmBytes = 0;
+
+    if (switchPtr->routeLpm != NULL)
+    {
+        lpmBytes = (fm_uint64) switchPtr->routeLpm->numNodes *
+                   sizeof(fm_routeLpmNode);
+    }
+
+    chipBytes = 0;
+
+    if (switchPtr->GetRouteMemoryUsage != NULL)
+    {
+        err = switchPtr->GetRouteMemoryUsage(sw, &chipBytes);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
+    }
+
+    total = routeBytes + treeBytes + vnBytes + lpmBytes + chipBytes;
+
+    FM_LOG_PRINT("Route memory usage for switch %d\n", sw);
+    FM_LOG_PRINT("  Routes               : %u\n", numRoutes);
+    FM_LOG_PRINT("  Route records        : %" FM_FORMAT_64 "u bytes "
+                 "(%u bytes each)\n",
+                 routeBytes,
+                 (fm_uint) sizeof(fm_intRouteEntry));
+    FM_LOG_PRINT("  Route tree nodes     : %" FM_FORMAT_64 "u bytes\n",
+                 treeBytes);
+    FM_LOG_PRINT("  VN tunnel trees      : %" FM_FORMAT_64 "u bytes\n",
+                 vnBytes);
+    FM_LOG_PRINT("  LPM index nodes      : %" FM_FORMAT_64 "u bytes\n",
+                 lpmBytes);
+    FM_LOG_PRINT("  Chip route records   : %" FM_FORMAT_64 "u bytes\n",
+                 chipBytes);
+    FM_LOG_PRINT("  Total                : %" FM_FORMAT_64 "u bytes\n",
+                 total);
+
+    if (numRoutes > 0)
+    {
+        FM_LOG_PRINT("  Bytes per route      : %" FM_FORMAT_64 "u\n",
+                     total / numRoutes);
+    }
+
+#ifdef FM_SHARED_MEMORY_SIZE
+    FM_LOG_PRINT("  Shared memory size   : %" FM_FORMAT_64 "u bytes\n",
+                 (fm_uint64) FM_SHARED_MEMORY_SIZE);
+#endif
+
+ABORT:
+
+    if (lockTaken)
+    {
+        fmReleaseReadLock(&switchPtr->routingLock);
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_ROUTING, err);
+
+}   /* end fmDbgDumpRouteMemory */
+
+
 /*****************************************************************************/
 /** fmSetRouteAttribute
  * \ingroup routerRoute
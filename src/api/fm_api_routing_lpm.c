@@ -0,0 +1,789 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_api_routing_lpm.c
+ * Creation Date:   October 15, 2026
+ * Description:     Longest-prefix-match index of the routing table
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* Trie level at which a prefix of the given length ends */
+#define LPM_LEVEL(prefixLength)                                     \
+    ( ( (prefixLength) == 0 ) ? 0                                   \
+                              : ( (prefixLength) - 1 ) / FM_ROUTE_LPM_STRIDE )
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** GetRootPtr
+ * \ingroup intRouter
+ *
+ * \desc            Returns the location of the root node of the trie for a
+ *                  virtual router and address family.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vrid is the virtual router ID number.
+ *
+ * \param[in]       isIPv6 is TRUE for the IPv6 trie, FALSE for IPv4.
+ *
+ * \return          pointer to the root node pointer, NULL if the switch
+ *                  has no index or vrid is not a known virtual router.
+ *
+ *****************************************************************************/
+static fm_routeLpmNode **GetRootPtr(fm_int sw, fm_int vrid, fm_bool isIPv6)
+{
+    fm_switch *switchPtr;
+    fm_int     vroff;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->routeLpm == NULL)
+    {
+        return NULL;
+    }
+
+    if (vrid == FM_ROUTER_ANY)
+    {
+        vroff = switchPtr->maxVirtualRouters;
+    }
+    else if (fmValidateVirtualRouterId(sw, vrid, &vroff) != FM_OK)
+    {
+        return NULL;
+    }
+
+    return &switchPtr->routeLpm->roots[(vroff * 2) + (isIPv6 ? 1 : 0)];
+
+}   /* end GetRootPtr */
+
+
+
+
+/*****************************************************************************/
+/** GetAddressByte
+ * \ingroup intRouter
+ *
+ * \desc            Returns one byte of an IP address, most significant
+ *                  byte first.
+ *
+ * \param[in]       ip points to the IP address.
+ *
+ * \param[in]       byteIndex is the index of the byte, 0 being the most
+ *                  significant.
+ *
+ * \return          the value of the byte.
+ *
+ *****************************************************************************/
+static fm_int GetAddressByte(fm_ipAddr *ip, fm_int byteIndex)
+{
+    fm_uint32 word;
+
+    /* IPv6 addresses hold their most significant word in addr[3]. */
+    if (ip->isIPv6)
+    {
+        word = ntohl(ip->addr[3 - (byteIndex / 4)]);
+    }
+    else
+    {
+        word = ntohl(ip->addr[0]);
+    }
+
+    return (word >> ( 24 - ( (byteIndex % 4) * 8 ) ) ) & 0xff;
+
+}   /* end GetAddressByte */
+
+
+
+
+/*****************************************************************************/
+/** AllocNode
+ * \ingroup intRouter
+ *
+ * \desc            Allocates an empty trie node.
+ *
+ * \param[in]       lpm points to the index.
+ *
+ * \return          pointer to the node, NULL if out of memory.
+ *
+ *****************************************************************************/
+static fm_routeLpmNode *AllocNode(fm_routeLpm *lpm)
+{
+    fm_routeLpmNode *node;
+
+    node = fmAlloc( sizeof(fm_routeLpmNode) );
+
+    if (node == NULL)
+    {
+        return NULL;
+    }
+
+    FM_CLEAR(*node);
+
+    lpm->numNodes++;
+
+    if (lpm->numNodes > lpm->peakNodes)
+    {
+        lpm->peakNodes = lpm->numNodes;
+    }
+
+    return node;
+
+}   /* end AllocNode */
+
+
+
+
+/*****************************************************************************/
+/** FreeNode
+ * \ingroup intRouter
+ *
+ * \desc            Frees a trie node and all the nodes below it.
+ *
+ * \param[in]       lpm points to the index.
+ *
+ * \param[in]       node points to the node.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void FreeNode(fm_routeLpm *lpm, fm_routeLpmNode *node)
+{
+    fm_int i;
+
+    for (i = 0 ; i < FM_ROUTE_LPM_NODE_SLOTS ; i++)
+    {
+        if (node->slots[i].child != NULL)
+        {
+            FreeNode(lpm, node->slots[i].child);
+        }
+    }
+
+    fmFree(node);
+    lpm->numNodes--;
+
+}   /* end FreeNode */
+
+
+
+
+/*****************************************************************************/
+/** PrunePath
+ * \ingroup intRouter
+ *
+ * \desc            Frees the empty nodes at the end of a path from the
+ *                  root, deepest first.
+ *
+ * \param[in]       lpm points to the index.
+ *
+ * \param[in]       rootPtr points to the root node pointer.
+ *
+ * \param[in]       path points to the nodes of the path, path[0] being
+ *                  the root.
+ *
+ * \param[in]       address points to the IP address the path follows.
+ *
+ * \param[in]       depth is the number of nodes in path.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void PrunePath(fm_routeLpm *      lpm,
+                      fm_routeLpmNode ** rootPtr,
+                      fm_routeLpmNode ** path,
+                      fm_ipAddr *        address,
+                      fm_int             depth)
+{
+    fm_routeLpmSlot *parentSlot;
+    fm_int           level;
+
+    for (level = depth - 1 ; level >= 0 ; level--)
+    {
+        if (path[level]->numUsed != 0)
+        {
+            break;
+        }
+
+        fmFree(path[level]);
+        lpm->numNodes--;
+
+        if (level == 0)
+        {
+            *rootPtr = NULL;
+            break;
+        }
+
+        parentSlot = &path[level - 1]->slots[GetAddressByte(address,
+                                                            level - 1)];
+        parentSlot->child = NULL;
+
+        if (parentSlot->route == NULL)
+        {
+            path[level - 1]->numUsed--;
+        }
+    }
+
+}   /* end PrunePath */
+
+
+
+
+/*****************************************************************************/
+/** FindShorterRoute
+ * \ingroup intRouter
+ *
+ * \desc            Finds, in the route lookup trees, the longest route
+ *                  that covers an address with a prefix length in a given
+ *                  range.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vrid is the virtual router ID number.
+ *
+ * \param[in]       address points to the IP address.
+ *
+ * \param[in]       maxLength is the longest prefix length to consider.
+ *
+ * \param[in]       minLength is the shortest prefix length to consider.
+ *
+ * \param[out]      foundLength points to caller-allocated storage where
+ *                  the prefix length of the route found is written.
+ *
+ * \return          pointer to the route, NULL if there is none.
+ *
+ *****************************************************************************/
+static fm_intRouteEntry *FindShorterRoute(fm_int     sw,
+                                          fm_int     vrid,
+                                          fm_ipAddr *address,
+                                          fm_int     maxLength,
+                                          fm_int     minLength,
+                                          fm_int *   foundLength)
+{
+    fm_customTree *   lookupTree;
+    fm_intRouteEntry *route;
+    fm_ipAddr         maskedIP;
+    fm_int            prefixLength;
+
+    for (prefixLength = maxLength ;
+         prefixLength >= minLength ;
+         prefixLength--)
+    {
+        maskedIP = *address;
+        fmMaskIPAddress(&maskedIP, prefixLength);
+
+        if (fmGetRouteLookupTree(sw, vrid, prefixLength, &lookupTree) != FM_OK)
+        {
+            break;
+        }
+
+        if (fmCustomTreeFind(lookupTree,
+                             &maskedIP,
+                             (void **) &route) == FM_OK)
+        {
+            *foundLength = prefixLength;
+            return route;
+        }
+    }
+
+    return NULL;
+
+}   /* end FindShorterRoute */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** fmAllocRouteLpm
+ * \ingroup intRouter
+ *
+ * \desc            Allocates the longest-prefix-match index of a switch,
+ *                  with empty tries for every virtual router.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmAllocRouteLpm(fm_int sw)
+{
+    fm_switch *  switchPtr;
+    fm_routeLpm *lpm;
+    fm_int       size;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    lpm = fmAlloc( sizeof(fm_routeLpm) );
+
+    if (lpm == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    FM_CLEAR(*lpm);
+
+    /* Additional virtual router is for vrid = FM_ROUTER_ANY */
+    lpm->numRoots = (switchPtr->maxVirtualRouters + 1) * 2;
+
+    size       = lpm->numRoots * sizeof(fm_routeLpmNode *);
+    lpm->roots = fmAlloc(size);
+
+    if (lpm->roots == NULL)
+    {
+        fmFree(lpm);
+        return FM_ERR_NO_MEM;
+    }
+
+    FM_MEMSET_S(lpm->roots, size, 0, size);
+
+    switchPtr->routeLpm = lpm;
+
+    return FM_OK;
+
+}   /* end fmAllocRouteLpm */
+
+
+
+
+/*****************************************************************************/
+/** fmFreeRouteLpm
+ * \ingroup intRouter
+ *
+ * \desc            Frees the longest-prefix-match index of a switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmFreeRouteLpm(fm_int sw)
+{
+    fm_switch *switchPtr;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->routeLpm == NULL)
+    {
+        return;
+    }
+
+    fmClearRouteLpm(sw);
+
+    fmFree(switchPtr->routeLpm->roots);
+    fmFree(switchPtr->routeLpm);
+    switchPtr->routeLpm = NULL;
+
+}   /* end fmFreeRouteLpm */
+
+
+
+
+/*****************************************************************************/
+/** fmClearRouteLpm
+ * \ingroup intRouter
+ *
+ * \desc            Removes every route from the longest-prefix-match index
+ *                  of a switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmClearRouteLpm(fm_int sw)
+{
+    fm_switch *  switchPtr;
+    fm_routeLpm *lpm;
+    fm_int       i;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    lpm       = switchPtr->routeLpm;
+
+    if (lpm == NULL)
+    {
+        return;
+    }
+
+    for (i = 0 ; i < lpm->numRoots ; i++)
+    {
+        if (lpm->roots[i] != NULL)
+        {
+            FreeNode(lpm, lpm->roots[i]);
+            lpm->roots[i] = NULL;
+        }
+    }
+
+}   /* end fmClearRouteLpm */
+
+
+
+
+/*****************************************************************************/
+/** fmRouteLpmInsert
+ * \ingroup intRouter
+ *
+ * \desc            Adds a route to the longest-prefix-match index. Called
+ *                  after the route was added to its route lookup tree.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vrid is the virtual router ID number.
+ *
+ * \param[in]       prefixLength is the prefix length of the route.
+ *
+ * \param[in]       route points to the route.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmRouteLpmInsert(fm_int            sw,
+                           fm_int            vrid,
+                           fm_int            prefixLength,
+                           fm_intRouteEntry *route)
+{
+    fm_switch *       switchPtr;
+    fm_routeLpm *     lpm;
+    fm_routeLpmNode **rootPtr;
+    fm_routeLpmNode * path[FM_ROUTE_LPM_MAX_LEVELS];
+    fm_routeLpmNode * node;
+    fm_routeLpmSlot * slot;
+    fm_ipAddr *       address;
+    fm_int            level;
+    fm_int            depth;
+    fm_int            first;
+    fm_int            count;
+    fm_int            i;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    lpm       = switchPtr->routeLpm;
+    address   = route->destIPAddress;
+
+    rootPtr = GetRootPtr(sw, vrid, address->isIPv6);
+
+    if (rootPtr == NULL)
+    {
+        return FM_OK;
+    }
+
+    if (*rootPtr == NULL)
+    {
+        *rootPtr = AllocNode(lpm);
+
+        if (*rootPtr == NULL)
+        {
+            return FM_ERR_NO_MEM;
+        }
+    }
+
+    level = LPM_LEVEL(prefixLength);
+    node  = *rootPtr;
+
+    for (depth = 0 ; depth < level ; depth++)
+    {
+        path[depth] = node;
+        slot        = &node->slots[GetAddressByte(address, depth)];
+
+        if (slot->child == NULL)
+        {
+            slot->child = AllocNode(lpm);
+
+            if (slot->child == NULL)
+            {
+                PrunePath(lpm, rootPtr, path, address, depth + 1);
+                return FM_ERR_NO_MEM;
+            }
+
+            if (slot->route == NULL)
+            {
+                node->numUsed++;
+            }
+        }
+
+        node = slot->child;
+    }
+
+    /* Expand the prefix over the slots it covers in its last node. */
+    count = 1 << ( ( (level + 1) * FM_ROUTE_LPM_STRIDE ) - prefixLength );
+    first = GetAddressByte(address, level) & ~(count - 1);
+
+    for (i = first ; i < first + count ; i++)
+    {
+        slot = &node->slots[i];
+
+        if ( (slot->route == NULL) && (slot->child == NULL) )
+        {
+            node->numUsed++;
+        }
+
+        if ( (slot->route == NULL) || (slot->prefixLength <= prefixLength) )
+        {
+            slot->route        = route;
+            slot->prefixLength = prefixLength;
+        }
+    }
+
+    return FM_OK;
+
+}   /* end fmRouteLpmInsert */
+
+
+
+
+/*****************************************************************************/
+/** fmRouteLpmRemove
+ * \ingroup intRouter
+ *
+ * \desc            Removes a route from the longest-prefix-match index.
+ *                  Called after the route was removed from its route
+ *                  lookup tree, which supplies the shorter routes that
+ *                  take its place.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vrid is the virtual router ID number.
+ *
+ * \param[in]       prefixLength is the prefix length of the route.
+ *
+ * \param[in]       route points to the route.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmRouteLpmRemove(fm_int            sw,
+                      fm_int            vrid,
+                      fm_int            prefixLength,
+                      fm_intRouteEntry *route)
+{
+    fm_switch *       switchPtr;
+    fm_routeLpmNode **rootPtr;
+    fm_routeLpmNode * path[FM_ROUTE_LPM_MAX_LEVELS + 1];
+    fm_routeLpmNode * node;
+    fm_routeLpmSlot * slot;
+    fm_intRouteEntry *fallback;
+    fm_ipAddr *       address;
+    fm_int            fallbackLength;
+    fm_int            minLength;
+    fm_int            level;
+    fm_int            depth;
+    fm_int            first;
+    fm_int            count;
+    fm_int            i;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    address   = route->destIPAddress;
+
+    rootPtr = GetRootPtr(sw, vrid, address->isIPv6);
+
+    if ( (rootPtr == NULL) || (*rootPtr == NULL) )
+    {
+        return;
+    }
+
+    level = LPM_LEVEL(prefixLength);
+    node  = *rootPtr;
+
+    for (depth = 0 ; depth < level ; depth++)
+    {
+        path[depth] = node;
+        node        = node->slots[GetAddressByte(address, depth)].child;
+
+        if (node == NULL)
+        {
+            return;
+        }
+    }
+
+    path[level] = node;
+
+    /* The slots the route covered fall back to the longest shorter
+     * prefix that ends within the same node, if any. */
+    minLength      = (level == 0) ? 0 : (level * FM_ROUTE_LPM_STRIDE) + 1;
+    fallbackLength = 0;
+    fallback       = FindShorterRoute(sw,
+                                      vrid,
+                                      address,
+                                      prefixLength - 1,
+                                      minLength,
+                                      &fallbackLength);
+
+    count = 1 << ( ( (level + 1) * FM_ROUTE_LPM_STRIDE ) - prefixLength );
+    first = GetAddressByte(address, level) & ~(count - 1);
+
+    for (i = first ; i < first + count ; i++)
+    {
+        slot = &node->slots[i];
+
+        if ( (slot->route == NULL) || (slot->prefixLength != prefixLength) )
+        {
+            continue;
+        }
+
+        slot->route        = fallback;
+        slot->prefixLength = fallbackLength;
+
+        if ( (fallback == NULL) && (slot->child == NULL) )
+        {
+            node->numUsed--;
+        }
+    }
+
+    PrunePath(switchPtr->routeLpm, rootPtr, path, address, level + 1);
+
+}   /* end fmRouteLpmRemove */
+
+
+
+
+/*****************************************************************************/
+/** fmRouteLpmLookup
+ * \ingroup intRouter
+ *
+ * \desc            Finds the longest route that covers an IP address.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vrid is the virtual router ID number.
+ *
+ * \param[in]       ip points to the IP address.
+ *
+ * \return          pointer to the route, NULL if there is none.
+ *
+ *****************************************************************************/
+fm_intRouteEntry *fmRouteLpmLookup(fm_int     sw,
+                                   fm_int     vrid,
+                                   fm_ipAddr *ip)
+{
+    fm_routeLpmNode **rootPtr;
+    fm_routeLpmNode * node;
+    fm_routeLpmSlot * slot;
+    fm_intRouteEntry *route;
+    fm_int            numBytes;
+    fm_int            i;
+
+    rootPtr = GetRootPtr(sw, vrid, ip->isIPv6);
+
+    if (rootPtr == NULL)
+    {
+        return NULL;
+    }
+
+    numBytes = (ip->isIPv6 ? FM_IPV6_MAX_PREFIX_LENGTH
+                           : FM_IPV4_MAX_PREFIX_LENGTH) / FM_ROUTE_LPM_STRIDE;
+    node     = *rootPtr;
+    route    = NULL;
+
+    for (i = 0 ; (i < numBytes) && (node != NULL) ; i++)
+    {
+        slot = &node->slots[GetAddressByte(ip, i)];
+
+        if (slot->route != NULL)
+        {
+            route = slot->route;
+        }
+
+        node = slot->child;
+    }
+
+    return route;
+
+}   /* end fmRouteLpmLookup */
+
+
+
+
+/*****************************************************************************/
+/** fmGetRouteLpmMemory
+ * \ingroup intRouter
+ *
+ * \desc            Reports the memory used by the longest-prefix-match
+ *                  index of a switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      numNodes points to caller-allocated storage where the
+ *                  number of trie nodes is written.
+ *
+ * \param[out]      peakNodes points to caller-allocated storage where the
+ *                  highest number of trie nodes is written.
+ *
+ * \param[out]      numBytes points to caller-allocated storage where the
+ *                  number of bytes in use is written.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmGetRouteLpmMemory(fm_int  sw,
+                         fm_int *numNodes,
+                         fm_int *peakNodes,
+                         fm_int *numBytes)
+{
+    fm_switch *  switchPtr;
+    fm_routeLpm *lpm;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    lpm       = switchPtr->routeLpm;
+
+    if (lpm == NULL)
+    {
+        *numNodes  = 0;
+        *peakNodes = 0;
+        *numBytes  = 0;
+        return;
+    }
+
+    *numNodes  = lpm->numNodes;
+    *peakNodes = lpm->peakNodes;
+    *numBytes  = sizeof(fm_routeLpm)
+                 + ( lpm->numRoots * sizeof(fm_routeLpmNode *) )
+                 + ( lpm->numNodes * sizeof(fm_routeLpmNode) );
+
+}   /* end fmGetRouteLpmMemory */
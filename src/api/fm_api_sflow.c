@@ -53,6 +53,61 @@
  * Local Functions
  *****************************************************************************/
 
+
+
+
+/*****************************************************************************/
+/** CopySampleHeader
+ * \ingroup intsflow
+ *
+ * \desc            Copies the start of a received frame to an sFlow sample.
+ *
+ * \param[in]       buffer points to the first buffer of the frame.
+ *
+ * \param[in]       maxLength is the largest number of bytes to copy.
+ *
+ * \param[out]      sample points to the sample to fill in.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void CopySampleHeader(fm_buffer *      buffer,
+                             fm_uint32        maxLength,
+                             fm_sFlowSample * sample)
+{
+    fm_uint32 copyLength;
+
+    sample->frameLength  = 0;
+    sample->headerLength = 0;
+
+    for ( ; buffer != NULL ; buffer = buffer->next)
+    {
+        if (sample->headerLength < maxLength)
+        {
+            copyLength = maxLength - sample->headerLength;
+
+            if (copyLength > (fm_uint32) buffer->len)
+            {
+                copyLength = buffer->len;
+            }
+
+            FM_MEMCPY_S(&sample->header[sample->headerLength],
+                        sizeof(sample->header) - sample->headerLength,
+                        buffer->data,
+                        copyLength);
+
+            sample->headerLength += copyLength;
+        }
+
+        sample->frameLength += buffer->len;
+    }
+
+}   /* end CopySampleHeader */
+
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -659,3 +714,343 @@ fm_status fmCheckSFlowLogging(fm_int            sw,
     FM_LOG_EXIT(FM_LOG_CAT_SFLOW, err);
 
 }   /* end fmCheckSFlowLogging */
+
+
+
+
+/*****************************************************************************/
+/** fmSetSFlowSampleRingSize
+ * \ingroup intsflow
+ *
+ * \desc            Allocates the sFlow sample ring of a switch. The ring is
+ *                  kept until the switch is removed, so its size cannot
+ *                  change once allocated.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numSlots is the number of samples in the ring.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_VALUE if numSlots is 0 or differs from
+ *                  the size of the ring already allocated.
+ * \return          FM_ERR_NO_MEM if the ring cannot be allocated.
+ *
+ *****************************************************************************/
+fm_status fmSetSFlowSampleRingSize(fm_int sw, fm_uint32 numSlots)
+{
+    fm_switch *         switchPtr;
+    fm_sflowSampleRing *ring;
+    fm_uint             size;
+    fm_status           err = FM_OK;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SFLOW, "sw=%d numSlots=%u\n", sw, numSlots);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (numSlots == 0)
+    {
+        err = FM_ERR_INVALID_VALUE;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SFLOW, err);
+    }
+
+    if (switchPtr->sflowSampleRing != NULL)
+    {
+        if (switchPtr->sflowSampleRing->numSlots != numSlots)
+        {
+            err = FM_ERR_INVALID_VALUE;
+        }
+
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SFLOW, err);
+    }
+    else
+    {
+        size = sizeof(fm_sflowSampleRing) + numSlots * sizeof(fm_sFlowSample);
+
+        ring = fmAlloc(size);
+        if (ring == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SFLOW, err);
+        }
+
+        FM_MEMSET_S(ring, size, 0, size);
+
+        ring->numSlots = numSlots;
+        ring->slots    = (fm_sFlowSample *) (ring + 1);
+
+        /* The receive task starts placing samples on the ring as soon as
+         * it sees the pointer. */
+        FM_ATOMIC_STORE(&switchPtr->sflowSampleRing, ring);
+    }
+
+ABORT:
+    FM_LOG_EXIT(FM_LOG_CAT_SFLOW, err);
+
+}   /* end fmSetSFlowSampleRingSize */
+
+
+
+
+/*****************************************************************************/
+/** fmGetSFlowSampleRingSize
+ * \ingroup intsflow
+ *
+ * \desc            Returns the number of samples in the sFlow sample ring
+ *                  of a switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          The number of samples, 0 if the ring is not allocated.
+ *
+ *****************************************************************************/
+fm_uint32 fmGetSFlowSampleRingSize(fm_int sw)
+{
+    fm_switch *switchPtr;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    return (switchPtr->sflowSampleRing != NULL) ?
+           switchPtr->sflowSampleRing->numSlots : 0;
+
+}   /* end fmGetSFlowSampleRingSize */
+
+
+
+
+/*****************************************************************************/
+/** fmFreeSFlowSampleRing
+ * \ingroup intsflow
+ *
+ * \desc            Frees the sFlow sample ring of a switch being removed.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmFreeSFlowSampleRing(fm_int sw)
+{
+    fm_switch *switchPtr;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->sflowSampleRing != NULL)
+    {
+        fmFree(switchPtr->sflowSampleRing);
+        switchPtr->sflowSampleRing = NULL;
+    }
+
+}   /* end fmFreeSFlowSampleRing */
+
+
+
+
+/*****************************************************************************/
+/** fmPushSFlowSample
+ * \ingroup intsflow
+ *
+ * \desc            Places a sampled frame on the sFlow sample ring of a
+ *                  switch, keeping only the start of the frame. The sample
+ *                  is dropped and counted if the ring is full.
+ *
+ * \note            Must only be called by the packet receive task, which
+ *                  is the single writer of the ring.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       sFlowId is the sFlow instance that sampled the frame.
+ *
+ * \param[in]       sampleRate is the sampling rate in effect.
+ *
+ * \param[in]       truncLength is the number of bytes of the frame to keep,
+ *                  or FM_SFLOW_NO_TRUNC to keep as many as the sample holds.
+ *
+ * \param[in]       pktEvent points to the receive event of the frame. The
+ *                  frame buffer is left to the caller.
+ *
+ * \return          TRUE if the sample was placed on the ring.
+ * \return          FALSE if there is no ring or it is full.
+ *
+ *****************************************************************************/
+fm_bool fmPushSFlowSample(fm_int            sw,
+                          fm_int            sFlowId,
+                          fm_uint           sampleRate,
+                          fm_int            truncLength,
+                          fm_eventPktRecv * pktEvent)
+{
+    fm_switch *         switchPtr;
+    fm_sflowSampleRing *ring;
+    fm_sFlowSample *    sample;
+    fm_timestamp        ts;
+    fm_uint64           head;
+    fm_uint32           maxLength;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    ring      = switchPtr->sflowSampleRing;
+
+    if (ring == NULL)
+    {
+        return FALSE;
+    }
+
+    head = ring->head;
+
+    if ( (head - FM_ATOMIC_LOAD(&ring->tail)) >= ring->numSlots )
+    {
+        FM_ATOMIC_ADD_RELAXED(&ring->dropped, 1);
+        return FALSE;
+    }
+
+    maxLength = FM_SFLOW_SAMPLE_HEADER_SIZE;
+
+    if ( (truncLength != FM_SFLOW_NO_TRUNC) &&
+         ( (fm_uint32) truncLength < maxLength ) )
+    {
+        maxLength = truncLength;
+    }
+
+    sample = &ring->slots[head % ring->numSlots];
+
+    sample->sFlowId    = sFlowId;
+    sample->srcPort    = pktEvent->srcPort;
+    sample->vlan       = pktEvent->vlan;
+    sample->sampleRate = sampleRate;
+
+    CopySampleHeader((fm_buffer *) pktEvent->pkt, maxLength, sample);
+
+    fmGetTimeFast(&ts);
+    sample->timestamp = ts.sec * 1000000 + ts.usec;
+
+    /* Publishes the sample to the readers. */
+    FM_ATOMIC_STORE(&ring->head, head + 1);
+
+    return TRUE;
+
+}   /* end fmPushSFlowSample */
+
+
+
+
+/*****************************************************************************/
+/** fmReadSFlowSamples
+ * \ingroup sflow
+ *
+ * \chips           FM10000
+ *
+ * \desc            Reads the oldest samples from the sFlow sample ring of a
+ *                  switch, enabled with ''FM_SWITCH_SFLOW_SAMPLE_RING_SIZE''.
+ *                  Samples reach the ring straight from the packet receive
+ *                  path, without going through the event queue, and each
+ *                  sample is returned to only one caller.
+ *                                                                      \lb\lb
+ *                  This is also where sFlows with a nonzero
+ *                  ''FM_SFLOW_MAX_CPU_RATE'' have their sampling rate
+ *                  adjusted, so the ring should be read at least once a
+ *                  second.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       maxSamples is the number of entries in samples.
+ *
+ * \param[out]      samples points to a caller-allocated array of
+ *                  maxSamples entries where this function places the
+ *                  samples, oldest first.
+ *
+ * \param[out]      numSamples points to caller-allocated storage where this
+ *                  function places the number of samples read.
+ *
+ * \param[out]      dropped points to caller-allocated storage where this
+ *                  function places the number of samples dropped because
+ *                  the ring was full since the previous call. May be NULL.
+ *
+ * \return          FM_OK if at least one sample was read.
+ * \return          FM_ERR_NO_MORE if the ring is empty.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_NOT_FOUND if the ring was never enabled.
+ *
+ *****************************************************************************/
+fm_status fmReadSFlowSamples(fm_int           sw,
+                             fm_int           maxSamples,
+                             fm_sFlowSample * samples,
+                             fm_int *         numSamples,
+                             fm_uint64 *      dropped)
+{
+    fm_switch *         switchPtr;
+    fm_sflowSampleRing *ring;
+    fm_uint64           head;
+    fm_uint64           tail;
+    fm_uint64           count;
+    fm_uint64           i;
+    fm_status           err = FM_OK;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_SFLOW,
+                     "sw=%d, maxSamples=%d, samples=%p, numSamples=%p\n",
+                     sw,
+                     maxSamples,
+                     (void *) samples,
+                     (void *) numSamples);
+
+    if ( (maxSamples <= 0) || (samples == NULL) || (numSamples == NULL) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_SFLOW, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr   = GET_SWITCH_PTR(sw);
+    ring        = FM_ATOMIC_LOAD(&switchPtr->sflowSampleRing);
+    *numSamples = 0;
+
+    if (ring == NULL)
+    {
+        err = FM_ERR_NOT_FOUND;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SFLOW, err);
+    }
+
+    if (switchPtr->UpdateSFlowSampleRates != NULL)
+    {
+        err = switchPtr->UpdateSFlowSampleRates(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SFLOW, err);
+    }
+
+    /* The samples are copied before being claimed: if another reader
+     * claims them first, the receive task may have reused their slots,
+     * so the copy is redone from the new tail. */
+    tail = FM_ATOMIC_LOAD(&ring->tail);
+
+    do
+    {
+        head  = FM_ATOMIC_LOAD(&ring->head);
+        count = head - tail;
+
+        if (count > (fm_uint64) maxSamples)
+        {
+            count = maxSamples;
+        }
+
+        for (i = 0 ; i < count ; i++)
+        {
+            samples[i] = ring->slots[(tail + i) % ring->numSlots];
+        }
+    }
+    while ( (count > 0) && !FM_ATOMIC_CAS(&ring->tail, &tail, tail + count) );
+
+    *numSamples = (fm_int) count;
+
+    if (dropped != NULL)
+    {
+        *dropped = FM_ATOMIC_EXCHANGE(&ring->dropped, 0);
+    }
+
+    if (count == 0)
+    {
+        err = FM_ERR_NO_MORE;
+    }
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_SFLOW, err);
+
+}   /* end fmReadSFlowSamples */
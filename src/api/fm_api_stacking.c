@@ -308,6 +308,209 @@ static void DestroyForwardingRule(void *ptr)
 
 
 
+/*****************************************************************************/
+/** IndexForwardingRule
+ * \ingroup intStacking
+ *
+ * \desc            Adds a forwarding rule to the glort value index.
+ *
+ * \param[in]       stackingInfo points to the stacking state.
+ *
+ * \param[in]       ruleId is the ID of the rule.
+ *
+ * \param[in]       rule points to the internal rule.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status IndexForwardingRule(fm_stackingInfo *       stackingInfo,
+                                     fm_int                  ruleId,
+                                     fm_forwardRuleInternal *rule)
+{
+    fm_status err;
+    fm_uint32 careMask;
+    void *    value;
+
+    careMask = ~rule->rule.mask & FM_MAX_GLORT;
+
+    if (fmTreeFind(&stackingInfo->fwdRuleMasks,
+                   careMask,
+                   &value) != FM_OK)
+    {
+        err = fmTreeInsert(&stackingInfo->fwdRuleMasks, careMask, NULL);
+
+        if (err != FM_OK)
+        {
+            return err;
+        }
+    }
+
+    /* An unused care mask left behind on failure is harmless */
+    err = fmTreeInsert(&stackingInfo->fwdRulesByValue,
+                       FM_FWD_RULE_INDEX_KEY(careMask,
+                                             rule->rule.glort,
+                                             ruleId),
+                       rule);
+
+    return err;
+
+}   /* end IndexForwardingRule */
+
+
+
+
+/*****************************************************************************/
+/** UnindexForwardingRule
+ * \ingroup intStacking
+ *
+ * \desc            Removes a forwarding rule from the glort value index.
+ *
+ * \param[in]       stackingInfo points to the stacking state.
+ *
+ * \param[in]       ruleId is the ID of the rule.
+ *
+ * \param[in]       rule points to the internal rule.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void UnindexForwardingRule(fm_stackingInfo *       stackingInfo,
+                                  fm_int                  ruleId,
+                                  fm_forwardRuleInternal *rule)
+{
+    fm_uint32 careMask;
+    fm_uint64 firstKey;
+    fm_uint64 nextKey;
+    void *    value;
+
+    careMask = ~rule->rule.mask & FM_MAX_GLORT;
+
+    if (fmTreeRemove(&stackingInfo->fwdRulesByValue,
+                     FM_FWD_RULE_INDEX_KEY(careMask,
+                                           rule->rule.glort,
+                                           ruleId),
+                     NULL) != FM_OK)
+    {
+        return;
+    }
+
+    /* Forget the care mask once no other rule uses it */
+    firstKey = FM_FWD_RULE_INDEX_KEY(careMask, 0, 0);
+
+    if (fmTreeFind(&stackingInfo->fwdRulesByValue,
+                   firstKey,
+                   &value) == FM_OK)
+    {
+        return;
+    }
+
+    if ( (fmTreeSuccessor(&stackingInfo->fwdRulesByValue,
+                          firstKey,
+                          &nextKey,
+                          &value) == FM_OK) &&
+         ( (nextKey >> 48) == careMask ) )
+    {
+        return;
+    }
+
+    fmTreeRemove(&stackingInfo->fwdRuleMasks, careMask, NULL);
+
+}   /* end UnindexForwardingRule */
+
+
+
+
+/*****************************************************************************/
+/** CreateStackMcastGroupOnSwitch
+ * \ingroup intStacking
+ *
+ * \desc            Fan-out operation creating a stacked multicast group on
+ *                  one switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       cookie points to the multicast group handle.
+ *
+ * \return          The status of ''fmCreateStackMcastGroup''.
+ *
+ *****************************************************************************/
+static fm_status CreateStackMcastGroupOnSwitch(fm_int sw, void *cookie)
+{
+    return fmCreateStackMcastGroup(sw, *( (fm_int *) cookie ) );
+
+}   /* end CreateStackMcastGroupOnSwitch */
+
+
+
+
+/*****************************************************************************/
+/** DeleteStackMcastGroupOnSwitch
+ * \ingroup intStacking
+ *
+ * \desc            Fan-out operation deleting a stacked multicast group from
+ *                  one switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       cookie points to the multicast group handle.
+ *
+ * \return          The status of ''fmDeleteMcastGroup''.
+ *
+ *****************************************************************************/
+static fm_status DeleteStackMcastGroupOnSwitch(fm_int sw, void *cookie)
+{
+    return fmDeleteMcastGroup(sw, *( (fm_int *) cookie ) );
+
+}   /* end DeleteStackMcastGroupOnSwitch */
+
+
+
+
+/*****************************************************************************/
+/** CreateStackLAGOnSwitch
+ * \ingroup intStacking
+ *
+ * \desc            Fan-out operation creating a stacked LAG on one switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       cookie points to the LAG number.
+ *
+ * \return          The status of ''fmCreateStackLAG''.
+ *
+ *****************************************************************************/
+static fm_status CreateStackLAGOnSwitch(fm_int sw, void *cookie)
+{
+    return fmCreateStackLAG(sw, *( (fm_int *) cookie ) );
+
+}   /* end CreateStackLAGOnSwitch */
+
+
+
+
+/*****************************************************************************/
+/** DeleteStackLAGOnSwitch
+ * \ingroup intStacking
+ *
+ * \desc            Fan-out operation deleting a stacked LAG from one switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       cookie points to the LAG number.
+ *
+ * \return          The status of ''fmDeleteLAG''.
+ *
+ *****************************************************************************/
+static fm_status DeleteStackLAGOnSwitch(fm_int sw, void *cookie)
+{
+    return fmDeleteLAG(sw, *( (fm_int *) cookie ) );
+
+}   /* end DeleteStackLAGOnSwitch */
+
+
+
+
 /*****************************************************************************/
 /** ValidateStackGlortRange
  * \ingroup intStacking
@@ -385,6 +588,8 @@ fm_status fmInitStacking(fm_int sw)
     stackingInfo = &switchPtr->stackingInfo;
 
     fmTreeInit(&stackingInfo->fwdRules);
+    fmTreeInit(&stackingInfo->fwdRulesByValue);
+    fmTreeInit(&stackingInfo->fwdRuleMasks);
 
     err = fmCreateBitArray(&stackingInfo->usedRuleIDs, 
                            FM_MAX_STACKING_FORWARDING_RULES);
@@ -450,6 +655,8 @@ fm_status fmFreeStackingResources(fm_int sw)
         err = fmTreeIterNext(&iter, &tmpId, (void **) &tmpRule); 
     }
 
+    fmTreeDestroy(&stackingInfo->fwdRulesByValue, NULL);
+    fmTreeDestroy(&stackingInfo->fwdRuleMasks, NULL);
     fmTreeDestroy(&stackingInfo->fwdRules, DestroyForwardingRule);
 
     err = fmDeleteBitArray(&stackingInfo->usedRuleIDs);
@@ -462,6 +669,104 @@ fm_status fmFreeStackingResources(fm_int sw)
 
 
 
+/*****************************************************************************/
+/** fmFindForwardingRuleByGlort
+ * \ingroup intStacking
+ *
+ * \desc            Find the forwarding rule matching a given glort. If
+ *                  several rules match, the one with the lowest ID is
+ *                  returned.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       glort is glort value
+ *
+ * \param[out]      ruleId points to caller-allocated storage where this
+ *                  function should place the ID of the rule. It may be
+ *                  NULL.
+ *
+ * \param[out]      rule points to caller-allocated storage where this
+ *                  function should place the internal rule.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_FORWARDING_RULES if no rule matches glort.
+ *
+ *****************************************************************************/
+fm_status fmFindForwardingRuleByGlort(fm_int                   sw,
+                                      fm_uint32                glort,
+                                      fm_int *                 ruleId,
+                                      fm_forwardRuleInternal **rule)
+{
+    fm_stackingInfo *       stackingInfo;
+    fm_treeIterator         iter;
+    fm_forwardRuleInternal *tmpRule;
+    fm_uint64               careMask;
+    fm_uint64               firstKey;
+    fm_uint64               key;
+    fm_uint64               bestKey;
+    void *                  value;
+    fm_status               err;
+
+    stackingInfo = &GET_SWITCH_PTR(sw)->stackingInfo;
+    bestKey      = 0;
+    *rule        = NULL;
+
+    /***************************************************
+     * A glort can only match the rules whose care bits
+     * it shares, so look up each care mask in use once.
+     **************************************************/
+    fmTreeIterInit(&iter, &stackingInfo->fwdRuleMasks);
+
+    while (fmTreeIterNext(&iter, &careMask, &value) == FM_OK)
+    {
+        firstKey = FM_FWD_RULE_INDEX_KEY(careMask, glort, 0);
+
+        err = fmTreeFind(&stackingInfo->fwdRulesByValue,
+                         firstKey,
+                         (void **) &tmpRule);
+
+        if (err == FM_OK)
+        {
+            key = firstKey;
+        }
+        else
+        {
+            err = fmTreeSuccessor(&stackingInfo->fwdRulesByValue,
+                                  firstKey,
+                                  &key,
+                                  (void **) &tmpRule);
+
+            if ( (err != FM_OK) || ( (key >> 32) != (firstKey >> 32) ) )
+            {
+                continue;
+            }
+        }
+
+        if ( (*rule == NULL) ||
+             ( (key & 0xFFFFFFFF) < (bestKey & 0xFFFFFFFF) ) )
+        {
+            *rule   = tmpRule;
+            bestKey = key;
+        }
+    }
+
+    if (*rule == NULL)
+    {
+        return FM_ERR_NO_FORWARDING_RULES;
+    }
+
+    if (ruleId != NULL)
+    {
+        *ruleId = (fm_int) (bestKey & 0xFFFFFFFF);
+    }
+
+    return FM_OK;
+
+}   /* end fmFindForwardingRuleByGlort */
+
+
+
+
 /*****************************************************************************/
 /** fmFindForwardingRulePortByGlort
  * \ingroup intStacking
@@ -483,38 +788,16 @@ fm_status fmFindForwardingRulePortByGlort(fm_int    sw,
                                           fm_int *  logicalPort)
 {
     fm_status               err = FM_OK;
-    fm_switch *             switchPtr;
-    fm_stackingInfo *       stackingInfo;
-    fm_treeIterator         iter;
     fm_forwardRuleInternal *tmpRule;
-    fm_uint64               tmpId;
-    fm_bool                 found = FALSE;
 
 
     FM_LOG_ENTRY(FM_LOG_CAT_STACKING,
                  "sw=%d, glort=%d, logicalPort=%p\n",
                  sw, glort, (void *) logicalPort);
 
-    switchPtr = GET_SWITCH_PTR(sw);
-    stackingInfo = &switchPtr->stackingInfo;
-
-    fmTreeIterInit(&iter, &stackingInfo->fwdRules); 
-
-    err = fmTreeIterNext(&iter, &tmpId, (void **) &tmpRule); 
-
-    while (err != FM_ERR_NO_MORE)
-    {
-        if ( ( ~tmpRule->rule.mask & tmpRule->rule.glort ) ==
-             ( ~tmpRule->rule.mask & glort ) )
-        {
-            found = TRUE;
-            break;
-        }
-
-        err = fmTreeIterNext(&iter, &tmpId, (void **) &tmpRule); 
-    }
+    err = fmFindForwardingRuleByGlort(sw, glort, NULL, &tmpRule);
 
-    if ( !found )
+    if (err != FM_OK)
     {
         FM_LOG_DEBUG(FM_LOG_CAT_STACKING, 
                      "Glort 0x%x was not matched to a forwarding rule\n",
@@ -1107,6 +1390,7 @@ fm_status fmCreateStackForwardingRule(fm_int sw,
     fm_switch *         switchPtr;
     fm_stackingInfo *   stackingInfo;
     fm_bool             ruleInserted = FALSE;
+    fm_bool             ruleIndexed = FALSE;
  
     fm_forwardRuleInternal *newRule = NULL;
 
@@ -1175,6 +1459,12 @@ fm_status fmCreateStackForwardingRule(fm_int sw,
     /* The inserted rule is a copy */
     newRule->rule = *rule;
 
+    err = IndexForwardingRule(stackingInfo, *forwardingRuleID, newRule);
+
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STACKING, err);
+
+    ruleIndexed = TRUE;
+
     FM_LOG_DEBUG(FM_LOG_CAT_STACKING,
                  "Inserted rule at %p into tree with key %d\n", 
                  (void *) newRule, *forwardingRuleID);
@@ -1192,6 +1482,11 @@ ABORT:
                                *forwardingRuleID, 
                                FALSE);
 
+        if (ruleIndexed)
+        {
+            UnindexForwardingRule(stackingInfo, *forwardingRuleID, newRule);
+        }
+
         if (ruleInserted)
         {
             fmTreeRemoveCertain(&stackingInfo->fwdRules,
@@ -1433,6 +1728,8 @@ ABORT:
  *****************************************************************************/
 fm_status fmDeleteStackForwardingRule(fm_int sw, fm_int forwardingRuleID)
 {
+    fm_forwardRuleInternal *internalRule;
+
     REQUIRED_LOCALS;
 
     FM_LOG_ENTRY(FM_LOG_CAT_STACKING,
@@ -1449,6 +1746,14 @@ fm_status fmDeleteStackForwardingRule(fm_int sw, fm_int forwardingRuleID)
 
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STACKING, err);
 
+    err = fmTreeFind(&stackingInfo->fwdRules,
+                     forwardingRuleID,
+                     (void **) &internalRule);
+
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STACKING, err);
+
+    UnindexForwardingRule(stackingInfo, forwardingRuleID, internalRule);
+
     err = fmTreeRemove(&stackingInfo->fwdRules,
                        forwardingRuleID,
                        DestroyForwardingRule); 
@@ -2297,6 +2602,80 @@ fm_status fmCreateStackMcastGroupExt(fm_int  sw,
 
 
 
+/*****************************************************************************/
+/** fmCreateStackMcastGroupOnSwitches
+ * \ingroup stacking
+ *
+ * \chips           FM10000
+ *
+ * \desc            Create the same stacked multicast group on several
+ *                  switches of a stack, in parallel. This is equivalent to
+ *                  calling ''fmCreateStackMcastGroup'' on each switch in
+ *                  turn, except that the switches are programmed
+ *                  concurrently.
+ *                                                                      \lb\lb
+ *                  If the group cannot be created on one of the switches,
+ *                  it is deleted from the switches on which it was
+ *                  created.
+ *
+ * \note            The caller must not hold the lock of any of the
+ *                  switches, as each switch is programmed from a thread
+ *                  of its own.
+ *
+ * \param[in]       numSwitches is the number of entries in swList.
+ *
+ * \param[in]       swList is the list of switches on which to operate.
+ *
+ * \param[in]       mcastGroup is the multicast group (handle) of the
+ *                  desired multicast group. It must be from the set
+ *                  preallocated on every switch by
+ *                  ''fmAllocateStackMcastGroups''.
+ *
+ * \param[out]      results points to an array of numSwitches entries where
+ *                  this function places the status of the creation on each
+ *                  switch. It may be NULL.
+ *
+ * \return          FM_OK if the group was created on all switches.
+ * \return          FM_ERR_INVALID_ARGUMENT if swList is invalid.
+ * \return          FM_ERR_NO_MEM if not enough memory is available.
+ * \return          The status of the first switch in swList on which the
+ *                  group could not be created otherwise.
+ *
+ *****************************************************************************/
+fm_status fmCreateStackMcastGroupOnSwitches(fm_int        numSwitches,
+                                            const fm_int *swList,
+                                            fm_int        mcastGroup,
+                                            fm_status *   results)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_STACKING,
+                     "numSwitches = %d, swList = %p, mcastGroup = %d, "
+                     "results = %p\n",
+                     numSwitches,
+                     (void *) swList,
+                     mcastGroup,
+                     (void *) results);
+
+    if (mcastGroup == FM_LOGICAL_PORT_NONE)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_STACKING, FM_ERR_LOG_PORT_REQUIRED);
+    }
+
+    err = fmFanOutToSwitches(numSwitches,
+                             swList,
+                             CreateStackMcastGroupOnSwitch,
+                             DeleteStackMcastGroupOnSwitch,
+                             &mcastGroup,
+                             results);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_STACKING, err);
+
+}   /* end fmCreateStackMcastGroupOnSwitches */
+
+
+
+
 /*****************************************************************************/
 /** fmAllocateStackLAGs
  * \ingroup stacking 
@@ -2485,6 +2864,74 @@ fm_status fmCreateStackLAG(fm_int sw, fm_int lagNumber)
 
 
 
+/*****************************************************************************/
+/** fmCreateStackLAGOnSwitches
+ * \ingroup stacking
+ *
+ * \chips           FM10000
+ *
+ * \desc            Create the same stacked link aggregation group on
+ *                  several switches of a stack, in parallel. This is
+ *                  equivalent to calling ''fmCreateStackLAG'' on each
+ *                  switch in turn, except that the switches are programmed
+ *                  concurrently.
+ *                                                                      \lb\lb
+ *                  If the LAG cannot be created on one of the switches,
+ *                  it is deleted from the switches on which it was
+ *                  created.
+ *
+ * \note            The caller must not hold the lock of any of the
+ *                  switches, as each switch is programmed from a thread
+ *                  of its own.
+ *
+ * \param[in]       numSwitches is the number of entries in swList.
+ *
+ * \param[in]       swList is the list of switches on which to operate.
+ *
+ * \param[in]       lagNumber is the LAG number (handle) of the desired
+ *                  LAG. It must be from the set preallocated on every
+ *                  switch by ''fmAllocateStackLAGs''.
+ *
+ * \param[out]      results points to an array of numSwitches entries where
+ *                  this function places the status of the creation on each
+ *                  switch. It may be NULL.
+ *
+ * \return          FM_OK if the LAG was created on all switches.
+ * \return          FM_ERR_INVALID_ARGUMENT if swList is invalid.
+ * \return          FM_ERR_NO_MEM if not enough memory is available.
+ * \return          The status of the first switch in swList on which the
+ *                  LAG could not be created otherwise.
+ *
+ *****************************************************************************/
+fm_status fmCreateStackLAGOnSwitches(fm_int        numSwitches,
+                                     const fm_int *swList,
+                                     fm_int        lagNumber,
+                                     fm_status *   results)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_STACKING,
+                     "numSwitches = %d, swList = %p, lagNumber = %d, "
+                     "results = %p\n",
+                     numSwitches,
+                     (void *) swList,
+                     lagNumber,
+                     (void *) results);
+
+    err = fmFanOutToSwitches(numSwitches,
+                             swList,
+                             CreateStackLAGOnSwitch,
+                             DeleteStackLAGOnSwitch,
+                             &lagNumber,
+                             results);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_STACKING, err);
+
+}   /* end fmCreateStackLAGOnSwitches */
+
+
+
+
 /*****************************************************************************/
 /** fmAllocateStackLBGs
  * \ingroup stacking 
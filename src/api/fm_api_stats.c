@@ -94,7 +94,7 @@ static fm_bool LookupVlanCounterID(fm_int          sw,
 
     switchPtr = GET_SWITCH_PTR(sw);
 
-    FM_TAKE_STATE_LOCK(sw);
+    FM_TAKE_STATS_LOCK(sw);
 
     for (i = 0 ; i <= switchPtr->maxVlanCounter ; i++)
     {
@@ -114,7 +114,7 @@ static fm_bool LookupVlanCounterID(fm_int          sw,
         }
     }
 
-    FM_DROP_STATE_LOCK(sw);
+    FM_DROP_STATS_LOCK(sw);
 
     FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_VLAN,
                        found,
@@ -164,7 +164,7 @@ static fm_bool AllocateVlanCounterID(fm_int          sw,
 
     switchPtr = GET_SWITCH_PTR(sw);
 
-    FM_TAKE_STATE_LOCK(sw);
+    FM_TAKE_STATS_LOCK(sw);
 
     for (i = 0 ; i <= switchPtr->maxVlanCounter ; i++)
     {
@@ -185,7 +185,7 @@ static fm_bool AllocateVlanCounterID(fm_int          sw,
         }
     }
 
-    FM_DROP_STATE_LOCK(sw);
+    FM_DROP_STATS_LOCK(sw);
 
     FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_VLAN,
                        allocated,
@@ -198,6 +198,182 @@ static fm_bool AllocateVlanCounterID(fm_int          sw,
 
 
 
+/*****************************************************************************/
+/** AllocateVlanCounters
+ * \ingroup intStats
+ *
+ * \desc            Allocates a set of VLAN counters to a VLAN, see
+ *                  ''fmAllocateVLANCounters''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vlan is the VLAN to which the counters are to be
+ *                  allocated.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_VLANCOUNTER if no counter set is available.
+ *
+ *****************************************************************************/
+static fm_status AllocateVlanCounters(fm_int sw, fm_int vlan)
+{
+    fm_int          vcid;
+    fm_counterInfo *ci;
+    fm_status       err;
+    fm_switch *     switchPtr;
+    fm_bool         allocated = FALSE;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    ci        = &switchPtr->counterInfo;
+
+    if ( LookupVlanCounterID(sw, ci, vlan, &vcid) )
+    {
+        return FM_OK; /* Already allocated */
+    }
+
+    if ( !AllocateVlanCounterID(sw, ci, vlan, &vcid) )
+    {
+        err = FM_ERR_NO_VLANCOUNTER;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+    }
+
+    allocated = TRUE;
+
+    if (switchPtr->AllocateVLANCounters != NULL)
+    {
+        /* We arrive here in the SWAG case, which recursively
+           call this function on the component switches. */
+        err = switchPtr->AllocateVLANCounters(sw, vlan);
+    }
+    else
+    {
+        err = fmSetVlanCounterID(sw, vlan, vcid);
+    }
+
+ABORT:
+    if ( (err != FM_OK) && (allocated == TRUE) )
+    {
+        /* There was an error make sure the vlan counter ID is released */
+        FM_TAKE_STATS_LOCK(sw);
+        ci->vlanAssignedToCounter[vcid] = FM_UNALLOCATED_VLAN_COUNTER;
+        FM_DROP_STATS_LOCK(sw);
+    }
+
+    return err;
+
+}   /* end AllocateVlanCounters */
+
+
+
+
+/*****************************************************************************/
+/** FreeVlanCounters
+ * \ingroup intStats
+ *
+ * \desc            Deallocates the set of VLAN counters of a VLAN, see
+ *                  ''fmFreeVLANCounters''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vlan is the VLAN from which to deallocate counters.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_VLANCOUNTER if no counters are allocated to
+ *                  vlan.
+ *
+ *****************************************************************************/
+static fm_status FreeVlanCounters(fm_int sw, fm_int vlan)
+{
+    fm_int          vcid;
+    fm_counterInfo *ci;
+    fm_status       err;
+    fm_switch *     switchPtr;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    ci        = &switchPtr->counterInfo;
+
+    if ( !LookupVlanCounterID(sw, ci, vlan, &vcid) )
+    {
+        return FM_ERR_NO_VLANCOUNTER;
+    }
+
+    if (switchPtr->FreeVLANCounters != NULL)
+    {
+        /* We arrive here in the SWAG case, which recursively
+           call this function on the component switches. */
+        err = switchPtr->FreeVLANCounters(sw, vlan);
+    }
+    else
+    {
+        err = fmSetVlanCounterID(sw, vlan, FM_UNUSED_VLAN_COUNTER_ID);
+    }
+
+    if (err == FM_OK)
+    {
+        FM_TAKE_STATS_LOCK(sw);
+        ci->vlanAssignedToCounter[vcid] = FM_UNALLOCATED_VLAN_COUNTER;
+        FM_DROP_STATS_LOCK(sw);
+    }
+
+    return err;
+
+}   /* end FreeVlanCounters */
+
+
+
+
+/*****************************************************************************/
+/** ValidateCounterVlanList
+ * \ingroup intStats
+ *
+ * \desc            Checks a list of VLANs passed to the VLAN counter list
+ *                  functions.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numVlans is the number of VLANs in vlanList.
+ *
+ * \param[in]       vlanList points to an array of numVlans VLANs.
+ *
+ * \return          FM_OK if the list is valid.
+ * \return          FM_ERR_INVALID_ARGUMENT if vlanList is NULL or numVlans
+ *                  is not positive.
+ * \return          FM_ERR_INVALID_VLAN if a VLAN of the list is invalid.
+ *
+ *****************************************************************************/
+static fm_status ValidateCounterVlanList(fm_int  sw,
+                                         fm_int  numVlans,
+                                         fm_int *vlanList)
+{
+    fm_switch *switchPtr;
+    fm_int     vlan;
+    fm_int     i;
+
+    if ( (vlanList == NULL) || (numVlans <= 0) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    for (i = 0 ; i < numVlans ; i++)
+    {
+        vlan = vlanList[i];
+
+        if ( VLAN_OUT_OF_BOUNDS(vlan) ||
+             !switchPtr->vidTable[vlan].valid ||
+             (switchPtr->reservedVlan == (fm_uint16) vlan) )
+        {
+            return FM_ERR_INVALID_VLAN;
+        }
+    }
+
+    return FM_OK;
+
+}   /* end ValidateCounterVlanList */
+
+
+
+
 /*****************************************************************************/
 /** fmInitPortCounters
  * \ingroup intStats
@@ -530,6 +706,12 @@ fm_status fmFreeCounterDataStructures(fm_switch *swState)
         }
     }
 
+    if (swState->telemetryRing != NULL)
+    {
+        fmFree(swState->telemetryRing);
+        swState->telemetryRing = NULL;
+    }
+
     if (initMode & FM_STAT_VLAN_ASSIGNMENT_INIT_GENERIC)
     {
         if (swState->counterInfo.vlanAssignedToCounter)
@@ -602,6 +784,177 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fmGetPortCountersSnapshot
+ * \ingroup stats
+ *
+ * \chips           FM10000
+ *
+ * \desc            Retrieve port statistics from the counter cache without
+ *                  accessing the hardware or taking any API lock. May be
+ *                  called by a monitoring process attached with
+ *                  ''fmInitializeMonitor''.
+ *                                                                      \lb\lb
+ *                  The counter cache must have been enabled by the
+ *                  controlling application with the
+ *                  ''FM_SWITCH_COUNTER_CACHE_INTERVAL'' switch attribute.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the port for which to retrieve statistics.
+ *
+ * \param[out]      counters points to an ''fm_portCounters'' structure to be
+ *                  filled in by this function.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_SWITCH_NOT_UP if the switch is not up.
+ * \return          FM_ERR_INVALID_PORT if port is not a cardinal port.
+ * \return          FM_ERR_INVALID_ARGUMENT if counters is NULL.
+ * \return          FM_ERR_NOT_FOUND if the cache holds no recent enough
+ *                  snapshot of the port.
+ * \return          FM_ERR_UNSUPPORTED if the switch has no counter cache.
+ *
+ *****************************************************************************/
+fm_status fmGetPortCountersSnapshot(fm_int           sw,
+                                    fm_int           port,
+                                    fm_portCounters *counters)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PORT,
+                 "sw=%d port=%d counters=%p\n",
+                 sw,
+                 port,
+                 (void *) counters);
+
+    if (counters == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PORT, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_SWITCH_LOCK_FREE(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if ( !fmIsCardinalPort(sw, port) )
+    {
+        err = FM_ERR_INVALID_PORT;
+    }
+    else if (switchPtr->GetPortCountersSnapshot == NULL)
+    {
+        err = FM_ERR_UNSUPPORTED;
+    }
+    else
+    {
+        err = switchPtr->GetPortCountersSnapshot(sw, port, counters);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
+
+}   /* end fmGetPortCountersSnapshot */
+
+
+
+
+/*****************************************************************************/
+/** fmGetAllPortCounters
+ * \ingroup stats
+ *
+ * \chips           FM10000
+ *
+ * \desc            Retrieve the statistics of a list of ports in a single
+ *                  call. On switches that support it, the counters of all
+ *                  the ports are read with one scatter gather access while
+ *                  the switch locks are taken once, which is much cheaper
+ *                  than calling ''fmGetPortCounters'' for each port. Other
+ *                  switches retrieve the counters port by port.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       portList points to an array of numPorts ports. May
+ *                  include the CPU interface port.
+ *
+ * \param[in]       numPorts is the number of ports in portList.
+ *
+ * \param[out]      counters points to a caller-allocated array of numPorts
+ *                  ''fm_portCounters'' structures. Entry i receives the
+ *                  statistics of portList[i].
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_PORT if a port in portList is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if portList or counters is NULL
+ *                  or numPorts is not positive.
+ * \return          FM_ERR_NO_MEM if there is not enough memory.
+ *
+ *****************************************************************************/
+fm_status fmGetAllPortCounters(fm_int           sw,
+                               fm_int *         portList,
+                               fm_int           numPorts,
+                               fm_portCounters *counters)
+{
+    fm_status  err = FM_OK;
+    fm_switch *switchPtr;
+    fm_port *  portPtr;
+    fm_int     i;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_PORT, 
+                     "sw=%d portList=%p numPorts=%d counters=%p\n", 
+                     sw, 
+                     (void *) portList,
+                     numPorts, 
+                     (void *) counters);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    if ( (portList == NULL) || (counters == NULL) || (numPorts <= 0) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+    }
+
+    for (i = 0 ; i < numPorts ; i++)
+    {
+        if ( !fmIsValidPort(sw, portList[i], ALLOW_CPU) )
+        {
+            err = FM_ERR_INVALID_PORT;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        }
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->GetAllPortCounters != NULL)
+    {
+        err = switchPtr->GetAllPortCounters(sw, portList, numPorts, counters);
+    }
+    else
+    {
+        for (i = 0 ; i < numPorts ; i++)
+        {
+            portPtr = GET_PORT_PTR(sw, portList[i]);
+
+            FM_API_CALL_FAMILY(err,
+                               portPtr->GetPortCounters,
+                               sw,
+                               portList[i],
+                               &counters[i]);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        }
+    }
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_PORT, err);
+
+}   /* end fmGetAllPortCounters */
+
+
+
+
 /*****************************************************************************/
 /** fmResetPortCounters
  * \ingroup stats
@@ -716,6 +1069,180 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fmGetVLANCountersRange
+ * \ingroup stats
+ *
+ * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
+ *
+ * \desc            Retrieve the statistics of every VLAN of a range that has
+ *                  a set of counters allocated to it. On switches that
+ *                  support it, all the counter sets are read with a single
+ *                  scatter gather access, which is much cheaper than
+ *                  calling ''fmGetVLANCounters'' for each VLAN.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       firstVlan is the first VLAN of the range.
+ *
+ * \param[in]       lastVlan is the last VLAN of the range.
+ *
+ * \param[in]       maxVlans is the number of entries in vlanList and
+ *                  counters.
+ *
+ * \param[out]      vlanList points to a caller-allocated array where this
+ *                  function places the VLANs that have counters, in
+ *                  increasing order.
+ *
+ * \param[out]      counters points to a caller-allocated array where this
+ *                  function places the statistics of each VLAN in vlanList.
+ *
+ * \param[out]      numVlans points to caller-allocated storage where this
+ *                  function places the number of VLANs returned.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_VLAN if the range is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if a pointer argument is NULL or
+ *                  maxVlans is not positive.
+ * \return          FM_ERR_BUFFER_FULL if more than maxVlans VLANs of the
+ *                  range have counters. The first maxVlans are returned.
+ * \return          FM_ERR_NO_MEM if there is not enough memory.
+ *
+ *****************************************************************************/
+fm_status fmGetVLANCountersRange(fm_int           sw,
+                                 fm_int           firstVlan,
+                                 fm_int           lastVlan,
+                                 fm_int           maxVlans,
+                                 fm_int *         vlanList,
+                                 fm_vlanCounters *counters,
+                                 fm_int *         numVlans)
+{
+    fm_status       err = FM_OK;
+    fm_status       listErr = FM_OK;
+    fm_switch *     switchPtr;
+    fm_counterInfo *ci;
+    fm_int *        vcidList = NULL;
+    fm_int          vcid;
+    fm_int          vlan;
+    fm_int          count;
+    fm_int          i;
+    fm_int          j;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_VLAN,
+                     "sw=%d firstVlan=%d lastVlan=%d maxVlans=%d "
+                     "vlanList=%p counters=%p numVlans=%p\n",
+                     sw,
+                     firstVlan,
+                     lastVlan,
+                     maxVlans,
+                     (void *) vlanList,
+                     (void *) counters,
+                     (void *) numVlans);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    if ( (vlanList == NULL) || (counters == NULL) || (numVlans == NULL) ||
+         (maxVlans <= 0) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+    }
+
+    if ( VLAN_OUT_OF_BOUNDS(firstVlan) || VLAN_OUT_OF_BOUNDS(lastVlan) ||
+         (firstVlan > lastVlan) )
+    {
+        err = FM_ERR_INVALID_VLAN;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    ci        = &switchPtr->counterInfo;
+
+    vcidList = fmAlloc( maxVlans * sizeof(fm_int) );
+    if (vcidList == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+    }
+
+    /* Collect the counter sets of the range, sorted by VLAN */
+    count = 0;
+
+    FM_TAKE_STATS_LOCK(sw);
+
+    for (vcid = 0 ; vcid <= switchPtr->maxVlanCounter ; vcid++)
+    {
+        vlan = ci->vlanAssignedToCounter[vcid];
+
+        if ( (vcid == FM_UNUSED_VLAN_COUNTER_ID) ||
+             (vlan < firstVlan) || (vlan > lastVlan) )
+        {
+            continue;
+        }
+
+        if (count == maxVlans)
+        {
+            if (vlan > vlanList[count - 1])
+            {
+                listErr = FM_ERR_BUFFER_FULL;
+                continue;
+            }
+
+            /* Drop the highest VLAN to make room for this one */
+            listErr = FM_ERR_BUFFER_FULL;
+            count--;
+        }
+
+        for (i = count ; (i > 0) && (vlanList[i - 1] > vlan) ; i--)
+        {
+            vlanList[i] = vlanList[i - 1];
+            vcidList[i] = vcidList[i - 1];
+        }
+
+        vlanList[i] = vlan;
+        vcidList[i] = vcid;
+        count++;
+    }
+
+    FM_DROP_STATS_LOCK(sw);
+
+    if (switchPtr->GetVLANCountersList != NULL)
+    {
+        err = switchPtr->GetVLANCountersList(sw, count, vcidList, counters);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+    }
+    else
+    {
+        for (j = 0 ; j < count ; j++)
+        {
+            FM_API_CALL_FAMILY(err,
+                               switchPtr->GetVLANCounters,
+                               sw,
+                               vcidList[j],
+                               &counters[j]);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+        }
+    }
+
+    *numVlans = count;
+    err       = listErr;
+
+ABORT:
+    if (vcidList != NULL)
+    {
+        fmFree(vcidList);
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_VLAN, err);
+
+}   /* end fmGetVLANCountersRange */
+
+
+
+
 /*****************************************************************************/
 /** fmResetVLANCounters
  * \ingroup stats
@@ -770,11 +1297,11 @@ fm_status fmResetVLANCounters(fm_int sw, fm_int vlan)
         /* Bug 10428: Get counters before reset. */
         FM_API_CALL_FAMILY(err, switchPtr->GetVLANCounters, sw, vcid, &counters);
 
-        FM_TAKE_STATE_LOCK(sw);
+        FM_TAKE_STATS_LOCK(sw);
 
         ci->subtractVlan[vcid] = ci->lastReadVlan[vcid];
 
-        FM_DROP_STATE_LOCK(sw);
+        FM_DROP_STATS_LOCK(sw);
     }
 
 ABORT:
@@ -828,55 +1355,14 @@ ABORT:
  *****************************************************************************/
 fm_status fmAllocateVLANCounters(fm_int sw, fm_int vlan)
 {
-    fm_int          vcid;
-    fm_counterInfo *ci;
-    fm_status       err;
-    fm_switch *     switchPtr;
-    fm_bool         allocated = FALSE;
+    fm_status err;
 
     FM_LOG_ENTRY_API(FM_LOG_CAT_VLAN, "sw=%d vlan=%d\n", sw, vlan);
 
     VALIDATE_AND_PROTECT_SWITCH(sw);
     VALIDATE_VLAN_ID(sw, vlan);
 
-    switchPtr = GET_SWITCH_PTR(sw);
-
-    /* The non-swag physical switch case */
-    GET_SWITCH_COUNTER_INFO(sw, ci);
-
-    if ( LookupVlanCounterID(sw, ci, vlan, &vcid) )
-    {
-        err = FM_OK; /* Already allocated */
-        goto ABORT;
-    }
-
-    if ( !AllocateVlanCounterID(sw, ci, vlan, &vcid) )
-    {
-        err = FM_ERR_NO_VLANCOUNTER;
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
-    }
-
-    allocated = TRUE;
-
-    if (switchPtr->AllocateVLANCounters != NULL)
-    {
-        /* We arrive here in the SWAG case, which recursively
-           call this function on the component switches. */
-        err = switchPtr->AllocateVLANCounters(sw, vlan);
-    }
-    else
-    {
-        err = fmSetVlanCounterID(sw, vlan, vcid);
-    }
-
-ABORT:
-    if ( (err != FM_OK) && (allocated == TRUE) )
-    {
-        /* There was an error make sure the vlan counter ID is released */
-        FM_TAKE_STATE_LOCK(sw);
-        ci->vlanAssignedToCounter[vcid] = FM_UNALLOCATED_VLAN_COUNTER;
-        FM_DROP_STATE_LOCK(sw);
-    }
+    err = AllocateVlanCounters(sw, vlan);
 
     UNPROTECT_SWITCH(sw);
     FM_LOG_EXIT_API(FM_LOG_CAT_VLAN, err);
@@ -916,45 +1402,168 @@ ABORT:
  *****************************************************************************/
 fm_status fmFreeVLANCounters(fm_int sw, fm_int vlan)
 {
-    fm_int          vcid;
-    fm_counterInfo *ci;
-    fm_status       err;
-    fm_switch *     switchPtr;
+    fm_status err;
 
     FM_LOG_ENTRY_API(FM_LOG_CAT_VLAN, "sw=%d vlan=%d\n", sw, vlan);
 
     VALIDATE_AND_PROTECT_SWITCH(sw);
-    GET_SWITCH_COUNTER_INFO(sw, ci);
+    VALIDATE_VLAN_ID(sw, vlan);
 
-    switchPtr = GET_SWITCH_PTR(sw);
+    err = FreeVlanCounters(sw, vlan);
 
-    VALIDATE_VLAN_ID(sw, vlan);
+    UNPROTECT_SWITCH(sw);
 
-    if ( !LookupVlanCounterID(sw, ci, vlan, &vcid) )
+    FM_LOG_EXIT_API(FM_LOG_CAT_VLAN, err);
+
+}   /* end fmFreeVLANCounters */
+
+
+
+
+/*****************************************************************************/
+/** fmAllocateVLANCountersList
+ * \ingroup stats
+ *
+ * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
+ *
+ * \desc            Allocate a set of VLAN counters to each VLAN of a list,
+ *                  see ''fmAllocateVLANCounters''. Either all the VLANs get
+ *                  counters or, on error, the counter sets allocated by
+ *                  this call are released.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numVlans is the number of VLANs in vlanList.
+ *
+ * \param[in]       vlanList points to an array of numVlans VLANs.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if vlanList is NULL or numVlans
+ *                  is not positive.
+ * \return          FM_ERR_INVALID_VLAN if a VLAN of the list is invalid.
+ * \return          FM_ERR_NO_VLANCOUNTER if there are not enough counter
+ *                  sets for all the VLANs.
+ * \return          FM_ERR_NO_MEM if there is not enough memory.
+ *
+ *****************************************************************************/
+fm_status fmAllocateVLANCountersList(fm_int sw, fm_int numVlans, fm_int *vlanList)
+{
+    fm_status       err = FM_OK;
+    fm_switch *     switchPtr;
+    fm_counterInfo *ci;
+    fm_bool *       allocated = NULL;
+    fm_int          vcid;
+    fm_int          i;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_VLAN,
+                     "sw=%d numVlans=%d vlanList=%p\n",
+                     sw,
+                     numVlans,
+                     (void *) vlanList);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    err = ValidateCounterVlanList(sw, numVlans, vlanList);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    ci        = &switchPtr->counterInfo;
+
+    allocated = fmAlloc( numVlans * sizeof(fm_bool) );
+    if (allocated == NULL)
     {
-        err = FM_ERR_NO_VLANCOUNTER;
+        err = FM_ERR_NO_MEM;
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
     }
 
-    if (switchPtr->FreeVLANCounters != NULL)
+    for (i = 0 ; i < numVlans ; i++)
     {
-        /* We arrive here in the SWAG case, which recursively
-           call this function on the component switches. */
-        err = switchPtr->FreeVLANCounters(sw, vlan);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+        allocated[i] = !LookupVlanCounterID(sw, ci, vlanList[i], &vcid);
 
-        FM_TAKE_STATE_LOCK(sw);
-        ci->vlanAssignedToCounter[vcid] = FM_UNALLOCATED_VLAN_COUNTER;
-        FM_DROP_STATE_LOCK(sw);
+        err = AllocateVlanCounters(sw, vlanList[i]);
+
+        if (err != FM_OK)
+        {
+            /* Release what this call allocated */
+            while (--i >= 0)
+            {
+                if (allocated[i])
+                {
+                    FreeVlanCounters(sw, vlanList[i]);
+                }
+            }
+
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+        }
     }
-    else
+
+ABORT:
+    if (allocated != NULL)
     {
-        err = fmSetVlanCounterID(sw, vlan, FM_UNUSED_VLAN_COUNTER_ID);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+        fmFree(allocated);
+    }
 
-        FM_TAKE_STATE_LOCK(sw);
-        ci->vlanAssignedToCounter[vcid] = FM_UNALLOCATED_VLAN_COUNTER;
-        FM_DROP_STATE_LOCK(sw);
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_VLAN, err);
+
+}   /* end fmAllocateVLANCountersList */
+
+
+
+
+/*****************************************************************************/
+/** fmFreeVLANCountersList
+ * \ingroup stats
+ *
+ * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
+ *
+ * \desc            Deallocate the sets of VLAN counters of each VLAN of a
+ *                  list, see ''fmFreeVLANCounters''. All the VLANs are
+ *                  processed even if one of them fails.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numVlans is the number of VLANs in vlanList.
+ *
+ * \param[in]       vlanList points to an array of numVlans VLANs.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if vlanList is NULL or numVlans
+ *                  is not positive.
+ * \return          FM_ERR_INVALID_VLAN if a VLAN of the list is invalid.
+ * \return          FM_ERR_NO_VLANCOUNTER if a VLAN of the list has no
+ *                  counters. The other VLANs are still processed.
+ *
+ *****************************************************************************/
+fm_status fmFreeVLANCountersList(fm_int sw, fm_int numVlans, fm_int *vlanList)
+{
+    fm_status err = FM_OK;
+    fm_status err2;
+    fm_int    i;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_VLAN,
+                     "sw=%d numVlans=%d vlanList=%p\n",
+                     sw,
+                     numVlans,
+                     (void *) vlanList);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    err = ValidateCounterVlanList(sw, numVlans, vlanList);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+
+    for (i = 0 ; i < numVlans ; i++)
+    {
+        err2 = FreeVlanCounters(sw, vlanList[i]);
+
+        /* Report the first error */
+        if (err == FM_OK)
+        {
+            err = err2;
+        }
     }
 
 ABORT:
@@ -962,7 +1571,7 @@ ABORT:
 
     FM_LOG_EXIT_API(FM_LOG_CAT_VLAN, err);
 
-}   /* end fmFreeVLANCounters */
+}   /* end fmFreeVLANCountersList */
 
 
 
@@ -1051,11 +1660,11 @@ fm_status fmResetSwitchCounters(fm_int sw)
     /* Bug 10428: Get counters before reset. */
     FM_API_CALL_FAMILY(err, switchPtr->GetSwitchCounters, sw, &counters);
 
-    FM_TAKE_STATE_LOCK(sw);
+    FM_TAKE_STATS_LOCK(sw);
 
     ci->subtractSwitch = ci->lastReadSwitch;
 
-    FM_DROP_STATE_LOCK(sw);
+    FM_DROP_STATS_LOCK(sw);
 
     UNPROTECT_SWITCH(sw);
     FM_LOG_EXIT_API(FM_LOG_CAT_SWITCH, err);
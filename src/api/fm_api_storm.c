@@ -950,6 +950,110 @@ fm_status fmDeleteStormCtrlAction(fm_int          sw,
 
 
 
+/*****************************************************************************/
+/** fmBeginStormCtrlUpdate
+ * \ingroup storm
+ *
+ * \chips           FM10000
+ *
+ * \desc            Start a bulk update of a storm controller. Conditions and
+ *                  actions added or deleted with ''fmAddStormCtrlCondition'',
+ *                  ''fmDeleteStormCtrlCondition'', ''fmAddStormCtrlAction''
+ *                  and ''fmDeleteStormCtrlAction'' are validated and recorded
+ *                  immediately but only programmed into hardware when
+ *                  ''fmCommitStormCtrlUpdate'' is called. Calls may be
+ *                  nested; the outermost commit applies the changes.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       stormController is the storm controller number (returned by
+ *                  ''fmCreateStormCtrl'') to update.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_STORM_CTRL if stormController is not
+ *                  the handle of an existing storm controller.
+ * \return          FM_ERR_UNSUPPORTED if the switch does not support bulk
+ *                  storm controller updates.
+ *
+ *****************************************************************************/
+fm_status fmBeginStormCtrlUpdate(fm_int sw, fm_int stormController)
+{
+    fm_status  err = FM_OK;
+    fm_switch *switchPtr;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_STORM,
+                     "sw = %d, stormController = %d\n",
+                     sw,
+                     stormController);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_API_CALL_FAMILY(err,
+                       switchPtr->BeginStormCtrlUpdate,
+                       sw,
+                       stormController);
+
+    UNPROTECT_SWITCH(sw);
+    FM_LOG_EXIT_API(FM_LOG_CAT_STORM, err);
+
+}   /* end fmBeginStormCtrlUpdate */
+
+
+
+
+/*****************************************************************************/
+/** fmCommitStormCtrlUpdate
+ * \ingroup storm
+ *
+ * \chips           FM10000
+ *
+ * \desc            End a bulk update started with ''fmBeginStormCtrlUpdate''.
+ *                  When the outermost update is committed, the storm
+ *                  controller's trigger configuration is rewritten once
+ *                  with all recorded conditions and actions.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       stormController is the storm controller number (returned by
+ *                  ''fmCreateStormCtrl'') to update.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_STORM_CTRL if stormController is not
+ *                  the handle of an existing storm controller.
+ * \return          FM_ERR_INVALID_STATE if no update is in progress.
+ * \return          FM_ERR_UNSUPPORTED if the switch does not support bulk
+ *                  storm controller updates.
+ *
+ *****************************************************************************/
+fm_status fmCommitStormCtrlUpdate(fm_int sw, fm_int stormController)
+{
+    fm_status  err = FM_OK;
+    fm_switch *switchPtr;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_STORM,
+                     "sw = %d, stormController = %d\n",
+                     sw,
+                     stormController);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_API_CALL_FAMILY(err,
+                       switchPtr->CommitStormCtrlUpdate,
+                       sw,
+                       stormController);
+
+    UNPROTECT_SWITCH(sw);
+    FM_LOG_EXIT_API(FM_LOG_CAT_STORM, err);
+
+}   /* end fmCommitStormCtrlUpdate */
+
+
+
+
 /*****************************************************************************/
 /** fmGetStormCtrlActionList
  * \ingroup storm
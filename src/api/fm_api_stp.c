@@ -1931,6 +1931,302 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fmSetSpanningTreePortStateList
+ * \ingroup stp
+ *
+ * \chips           FM10000
+ *
+ * \desc            Set the spanning tree state of several (instance, port)
+ *                  pairs at one time. This function provides a performance
+ *                  optimization over calling ''fmSetSpanningTreePortState''
+ *                  for each pair: the hardware state of each spanning tree
+ *                  instance is written once, however many of its ports
+ *                  change state.
+ *
+ * \note            All entries are validated before any state is changed.
+ *                  If a pair appears more than once, the last entry wins.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numEntries is the number of entries in each of the
+ *                  stpInstanceList, portList and stpStateList arrays.
+ *
+ * \param[in]       stpInstanceList points to an array of spanning tree
+ *                  instance numbers. See ''fmSetSpanningTreePortState''
+ *                  for the valid values.
+ *
+ * \param[in]       portList points to an array of logical port numbers.
+ *                  Each must represent a physical port.
+ *
+ * \param[in]       stpStateList points to an array of spanning tree states.
+ *                  See ''Spanning Tree States'' for possible values.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_STP_MODE if a non-default instance is
+ *                  given and ''FM_SPANNING_TREE_MODE'' is not set to
+ *                  ''FM_SPANNING_TREE_MULTIPLE''.
+ * \return          FM_ERR_INVALID_ARGUMENT if an instance or a state is
+ *                  invalid, or if an array pointer is NULL.
+ * \return          FM_ERR_INVALID_PORT if a port is invalid.
+ * \return          FM_ERR_PORT_IS_INTERNAL if trying to change the state of
+ *                  an internal port.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmSetSpanningTreePortStateList(fm_int  sw,
+                                         fm_int  numEntries,
+                                         fm_int *stpInstanceList,
+                                         fm_int *portList,
+                                         fm_int *stpStateList)
+{
+    fm_status           err = FM_OK;
+    fm_switch *         switchPtr;
+    fm_tree *           stpInfo;
+    fm_stpInstanceInfo *instance;
+    fm_bool *           changed;
+    fm_int *            refreshPorts;
+    fm_int              numRefreshPorts;
+    fm_int              currentStpState;
+    fm_int              cpi;
+    fm_int              i;
+    fm_int              j;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_STP,
+                     "sw=%d numEntries=%d stpInstanceList=%p portList=%p "
+                     "stpStateList=%p\n",
+                     sw,
+                     numEntries,
+                     (void *) stpInstanceList,
+                     (void *) portList,
+                     (void *) stpStateList);
+
+    err = StpInstancePreamble(sw, FM_DEFAULT_STP_INSTANCE, -1, FALSE);
+
+    if (err != FM_OK)
+    {
+        err = StpInstancePostamble(sw, err, err);
+
+        FM_LOG_EXIT_API(FM_LOG_CAT_STP, err);
+    }
+
+    changed      = NULL;
+    refreshPorts = NULL;
+
+    if ( (numEntries < 0) ||
+         ( (numEntries > 0) &&
+           ( (stpInstanceList == NULL) ||
+             (portList == NULL) ||
+             (stpStateList == NULL) ) ) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+    }
+
+    if (numEntries == 0)
+    {
+        goto ABORT;
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    stpInfo   = GET_STP_INFO(sw);
+
+    /***************************************************
+     * Validate every entry before changing anything.
+     **************************************************/
+
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        if ( (stpInstanceList[i] != FM_DEFAULT_STP_INSTANCE) &&
+             (switchPtr->stpMode != FM_SPANNING_TREE_MULTIPLE) )
+        {
+            err = FM_ERR_INVALID_STP_MODE;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+        }
+
+        switch (stpStateList[i])
+        {
+            case FM_STP_STATE_DISABLED:
+            case FM_STP_STATE_LISTENING:
+            case FM_STP_STATE_LEARNING:
+            case FM_STP_STATE_FORWARDING:
+            case FM_STP_STATE_BLOCKING:
+                break;
+
+            default:
+                err = FM_ERR_INVALID_ARGUMENT;
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+        }
+
+        if ( !fmIsCardinalPort(sw, portList[i]) )
+        {
+            err = FM_ERR_INVALID_PORT;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+        }
+
+        err = fmTreeFind(stpInfo, stpInstanceList[i], (void **) &instance);
+
+        if (err == FM_ERR_NOT_FOUND)
+        {
+            err = FM_ERR_INVALID_ARGUMENT;
+        }
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+
+        if ( fmIsInternalPort(sw, portList[i]) &&
+             !GET_PROPERTY()->stpEnIntPortCtrl )
+        {
+            err = fmGetSpanningTreePortState(sw,
+                                             stpInstanceList[i],
+                                             portList[i],
+                                             &currentStpState);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+
+            if (currentStpState == FM_STP_STATE_FORWARDING)
+            {
+                err = FM_ERR_PORT_IS_INTERNAL;
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+            }
+        }
+    }
+
+    /***************************************************
+     * Switch aggregates keep the states in their member
+     * switches, so the entries are applied one by one.
+     **************************************************/
+
+    if (switchPtr->switchFamily == FM_SWITCH_FAMILY_SWAG)
+    {
+        for (i = 0 ; i < numEntries ; i++)
+        {
+            err = fmGetSpanningTreePortState(sw,
+                                             stpInstanceList[i],
+                                             portList[i],
+                                             &currentStpState);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+
+            if ( (currentStpState != stpStateList[i]) &&
+                 (switchPtr->SetSpanningTreePortState != NULL) )
+            {
+                err = switchPtr->SetSpanningTreePortState(sw,
+                                                          stpInstanceList[i],
+                                                          portList[i],
+                                                          stpStateList[i]);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+            }
+        }
+
+        goto ABORT;
+    }
+
+    changed      = fmAlloc( sizeof(fm_bool) * numEntries );
+    refreshPorts = fmAlloc( sizeof(fm_int) * numEntries );
+
+    if ( (changed == NULL) || (refreshPorts == NULL) )
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+    }
+
+    /***************************************************
+     * Update the software states.
+     **************************************************/
+
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        err = fmTreeFind(stpInfo, stpInstanceList[i], (void **) &instance);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+
+        cpi = GET_PORT_INDEX(sw, portList[i]);
+
+        changed[i] = (instance->states[cpi] != stpStateList[i]);
+
+        if (changed[i])
+        {
+            if (switchPtr->SetSpanningTreePortState != NULL)
+            {
+                err = switchPtr->SetSpanningTreePortState(sw,
+                                                          stpInstanceList[i],
+                                                          portList[i],
+                                                          stpStateList[i]);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+            }
+
+            instance->states[cpi] = stpStateList[i];
+        }
+    }
+
+    /***************************************************
+     * Refresh the hardware once per changed instance.
+     **************************************************/
+
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        if (!changed[i])
+        {
+            continue;
+        }
+
+        err = fmTreeFind(stpInfo, stpInstanceList[i], (void **) &instance);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+
+        /* Gather the changed ports of this instance. */
+        numRefreshPorts = 0;
+
+        for (j = i ; j < numEntries ; j++)
+        {
+            if ( changed[j] && (stpInstanceList[j] == stpInstanceList[i]) )
+            {
+                refreshPorts[numRefreshPorts++] = portList[j];
+                changed[j] = FALSE;
+            }
+        }
+
+        if ( (switchPtr->RefreshSpanningTreePortList != NULL) &&
+             !switchPtr->useEgressVIDasFID )
+        {
+            err = switchPtr->RefreshSpanningTreePortList(sw,
+                                                         instance,
+                                                         numRefreshPorts,
+                                                         refreshPorts);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+        }
+        else
+        {
+            for (j = 0 ; j < numRefreshPorts ; j++)
+            {
+                err = fmRefreshStpStateInternal(switchPtr,
+                                                instance,
+                                                -1,
+                                                refreshPorts[j]);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_STP, err);
+            }
+        }
+    }
+
+    /***************************************************
+     * Cleanup, release locks, etc.
+     **************************************************/
+ABORT:
+    if (changed != NULL)
+    {
+        fmFree(changed);
+    }
+
+    if (refreshPorts != NULL)
+    {
+        fmFree(refreshPorts);
+    }
+
+    err = StpInstancePostamble(sw, FM_OK, err);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_STP, err);
+
+}   /* end fmSetSpanningTreePortStateList */
+
+
+
+
 /*****************************************************************************/
 /** fmGetSpanningTreePortState
  * \ingroup stp
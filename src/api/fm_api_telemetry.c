@@ -0,0 +1,435 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_api_telemetry.c
+ * Creation Date:   October 15, 2026
+ * Description:     Export of counter snapshots to a shared memory ring.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* Number of times a reader retries a slot that is being rewritten before
+ * giving up for now. */
+#define FM_TELEMETRY_READ_RETRIES       16
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Local function prototypes.
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fmSetTelemetryRingSize
+ * \ingroup intStats
+ *
+ * \desc            Allocates the telemetry ring of a switch in shared
+ *                  memory. The ring is kept until the switch is removed,
+ *                  since readers in other processes may hold pointers to
+ *                  it, so its size cannot change once allocated.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numSlots is the number of records in the ring.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_VALUE if numSlots is 0 or differs from
+ *                  the size of the ring already allocated.
+ * \return          FM_ERR_NO_MEM if the ring cannot be allocated.
+ *
+ *****************************************************************************/
+fm_status fmSetTelemetryRingSize(fm_int sw, fm_uint32 numSlots)
+{
+    fm_switch *       switchPtr;
+    fm_telemetryRing *ring;
+    fm_uint           size;
+    fm_status         err = FM_OK;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d numSlots=%u\n", sw, numSlots);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (numSlots == 0)
+    {
+        err = FM_ERR_INVALID_VALUE;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
+    if (switchPtr->telemetryRing != NULL)
+    {
+        if (switchPtr->telemetryRing->numSlots != numSlots)
+        {
+            err = FM_ERR_INVALID_VALUE;
+        }
+
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+    else
+    {
+        size = sizeof(fm_telemetryRing) + numSlots * sizeof(fm_telemetrySlot);
+
+        ring = fmAlloc(size);
+        if (ring == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+        }
+
+        FM_MEMSET_S(ring, size, 0, size);
+
+        ring->version  = FM_TELEMETRY_VERSION;
+        ring->slotSize = sizeof(fm_telemetrySlot);
+        ring->numSlots = numSlots;
+        ring->slots    = (fm_telemetrySlot *) (ring + 1);
+
+        FM_ATOMIC_STORE(&switchPtr->telemetryRing, ring);
+    }
+
+ABORT:
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end fmSetTelemetryRingSize */
+
+
+
+
+/*****************************************************************************/
+/** fmGetTelemetryRingSize
+ * \ingroup intStats
+ *
+ * \desc            Returns the number of records in the telemetry ring of
+ *                  a switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          The number of records, 0 if the ring is not allocated.
+ *
+ *****************************************************************************/
+fm_uint32 fmGetTelemetryRingSize(fm_int sw)
+{
+    fm_switch *switchPtr;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    return (switchPtr->telemetryRing != NULL) ?
+           switchPtr->telemetryRing->numSlots : 0;
+
+}   /* end fmGetTelemetryRingSize */
+
+
+
+
+/*****************************************************************************/
+/** fmSetTelemetryRingActive
+ * \ingroup intStats
+ *
+ * \desc            Tells readers whether snapshots are being exported to
+ *                  the telemetry ring of a switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       active is TRUE while snapshots are exported.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmSetTelemetryRingActive(fm_int sw, fm_bool active)
+{
+    fm_switch *switchPtr;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->telemetryRing != NULL)
+    {
+        FM_ATOMIC_STORE(&switchPtr->telemetryRing->active,
+                        (fm_uint32) (active ? TRUE : FALSE));
+    }
+
+}   /* end fmSetTelemetryRingActive */
+
+
+
+
+/*****************************************************************************/
+/** fmPushTelemetryRecord
+ * \ingroup intStats
+ *
+ * \desc            Writes a counter snapshot to the telemetry ring of a
+ *                  switch, overwriting the oldest record once the ring is
+ *                  full. Does nothing if the ring is not allocated.
+ *
+ * \note            There is a single writer per ring: the caller must be
+ *                  the task that produces the snapshots of the switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       type is the record type (see ''fm_telemetryRecordType'').
+ *
+ * \param[in]       id is the logical port or VLAN ID.
+ *
+ * \param[in]       timestamp is the time of the snapshot in microseconds.
+ *
+ * \param[in]       data points to the counters.
+ *
+ * \param[in]       size is the size of the counters.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmPushTelemetryRecord(fm_int       sw,
+                           fm_int       type,
+                           fm_int       id,
+                           fm_uint64    timestamp,
+                           const void * data,
+                           fm_uint32    size)
+{
+    fm_switch *         switchPtr;
+    fm_telemetryRing *  ring;
+    fm_telemetrySlot *  slot;
+    fm_telemetryRecord *record;
+    fm_uint64           pos;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    ring      = switchPtr->telemetryRing;
+
+    if ( (ring == NULL) || (size > sizeof(record->data)) )
+    {
+        return;
+    }
+
+    pos    = ring->head;
+    slot   = &ring->slots[pos % ring->numSlots];
+    record = &slot->record;
+
+    /* Readers that see 0 know the slot is being rewritten. */
+    FM_ATOMIC_STORE_RELAXED(&slot->seq, 0);
+    FM_ATOMIC_FENCE();
+
+    record->version   = FM_TELEMETRY_VERSION;
+    record->type      = (fm_uint16) type;
+    record->size      = size;
+    record->timestamp = timestamp;
+    record->sw        = sw;
+    record->id        = id;
+    FM_MEMCPY_S(&record->data, sizeof(record->data), data, size);
+
+    FM_ATOMIC_STORE(&slot->seq, pos + 1);
+    FM_ATOMIC_STORE(&ring->head, pos + 1);
+
+}   /* end fmPushTelemetryRecord */
+
+
+
+
+/*****************************************************************************/
+/** fmGetTelemetryRing
+ * \ingroup stats
+ *
+ * \chips           FM10000
+ *
+ * \desc            Returns the telemetry ring of a switch, to which the
+ *                  SDK exports timestamped counter snapshots while
+ *                  ''FM_SWITCH_TELEMETRY_RING_SIZE'' and
+ *                  ''FM_SWITCH_COUNTER_CACHE_INTERVAL'' are nonzero.
+ *                                                                      \lb\lb
+ *                  The ring is in the SDK shared memory, so the pointer is
+ *                  valid in every process attached to it, until the switch
+ *                  is removed. The records are then read with
+ *                  ''fmReadTelemetryRecord'', which neither calls into the
+ *                  API nor takes any lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      ring points to caller-allocated storage where this
+ *                  function places the address of the ring.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if ring is NULL.
+ * \return          FM_ERR_NOT_FOUND if the ring was never enabled.
+ *
+ *****************************************************************************/
+fm_status fmGetTelemetryRing(fm_int sw, fm_telemetryRing **ring)
+{
+    fm_switch *switchPtr;
+    fm_status  err = FM_OK;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_SWITCH,
+                     "sw=%d ring=%p\n",
+                     sw,
+                     (void *) ring);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    if (ring == NULL)
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    *ring = FM_ATOMIC_LOAD(&switchPtr->telemetryRing);
+
+    if (*ring == NULL)
+    {
+        err = FM_ERR_NOT_FOUND;
+    }
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_SWITCH, err);
+
+}   /* end fmGetTelemetryRing */
+
+
+
+
+/*****************************************************************************/
+/** fmReadTelemetryRecord
+ * \ingroup stats
+ *
+ * \chips           FM10000
+ *
+ * \desc            Reads the next record of a telemetry ring without
+ *                  calling into the API or taking any lock. Each reader
+ *                  keeps its own cursor, so any number of processes may
+ *                  read the ring concurrently.
+ *                                                                      \lb\lb
+ *                  A reader that falls more than a ring size behind the
+ *                  writer skips to the oldest record still in the ring;
+ *                  the number of records skipped is reported in lost.
+ *                                                                      \lb\lb
+ *                  Readers should check that version and slotSize of the
+ *                  ring match the ''FM_TELEMETRY_VERSION'' and
+ *                  ''fm_telemetrySlot'' they were built with.
+ *
+ * \param[in]       ring points to the ring returned by
+ *                  ''fmGetTelemetryRing''.
+ *
+ * \param[in,out]   cursor points to the position of the next record to
+ *                  read. Set it to 0 to start with the oldest record in
+ *                  the ring, or to ring->head to only read new records.
+ *                  It is advanced past the record returned.
+ *
+ * \param[out]      record points to caller-allocated storage where this
+ *                  function places the record.
+ *
+ * \param[out]      lost points to caller-allocated storage where this
+ *                  function places the number of records skipped because
+ *                  they were overwritten before being read. May be NULL.
+ *
+ * \return          FM_OK if a record was read.
+ * \return          FM_ERR_NO_MORE if there is no new record.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is NULL.
+ *
+ *****************************************************************************/
+fm_status fmReadTelemetryRecord(fm_telemetryRing *  ring,
+                                fm_uint64 *         cursor,
+                                fm_telemetryRecord *record,
+                                fm_uint64 *         lost)
+{
+    fm_telemetrySlot *slot;
+    fm_uint64         head;
+    fm_uint64         pos;
+    fm_uint64         skipped = 0;
+    fm_int            retry;
+
+    if ( (ring == NULL) || (cursor == NULL) || (record == NULL) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    for (retry = 0 ; retry < FM_TELEMETRY_READ_RETRIES ; retry++)
+    {
+        head = FM_ATOMIC_LOAD(&ring->head);
+        pos  = *cursor;
+
+        if (pos >= head)
+        {
+            break;
+        }
+
+        if ( (head - pos) > ring->numSlots )
+        {
+            skipped += head - ring->numSlots - pos;
+            pos      = head - ring->numSlots;
+            *cursor  = pos;
+        }
+
+        slot = &ring->slots[pos % ring->numSlots];
+
+        if (FM_ATOMIC_LOAD(&slot->seq) != pos + 1)
+        {
+            /* Overwritten since head was read: catch up and retry. */
+            continue;
+        }
+
+        FM_MEMCPY_S(record, sizeof(*record), &slot->record, sizeof(*record));
+
+        FM_ATOMIC_FENCE();
+
+        if (FM_ATOMIC_LOAD_RELAXED(&slot->seq) == pos + 1)
+        {
+            *cursor = pos + 1;
+
+            if (lost != NULL)
+            {
+                *lost = skipped;
+            }
+
+            return FM_OK;
+        }
+    }
+
+    if (lost != NULL)
+    {
+        *lost = skipped;
+    }
+
+    return FM_ERR_NO_MORE;
+
+}   /* end fmReadTelemetryRecord */
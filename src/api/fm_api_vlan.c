@@ -60,6 +60,53 @@
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/** ValidateVlanRange
+ * \ingroup intVlan
+ *
+ * \desc            Checks that every VLAN in a range exists.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       firstVlanID is the first VLAN of the range.
+ *
+ * \param[in]       lastVlanID is the last VLAN of the range.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_VLAN if the range is empty or any VLAN in
+ *                  it is out of range or does not exist.
+ *
+ *****************************************************************************/
+static fm_status ValidateVlanRange(fm_int    sw,
+                                   fm_uint16 firstVlanID,
+                                   fm_uint16 lastVlanID)
+{
+    fm_switch *switchPtr;
+    fm_int     vlanID;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if ( (firstVlanID > lastVlanID) || VLAN_OUT_OF_BOUNDS(lastVlanID) )
+    {
+        return FM_ERR_INVALID_VLAN;
+    }
+
+    for (vlanID = firstVlanID ; vlanID <= lastVlanID ; vlanID++)
+    {
+        if ( !switchPtr->vidTable[vlanID].valid ||
+             (switchPtr->reservedVlan == (fm_uint16) vlanID) )
+        {
+            return FM_ERR_INVALID_VLAN;
+        }
+    }
+
+    return FM_OK;
+
+}   /* end ValidateVlanRange */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -1173,6 +1220,205 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fmAddVlanRangePortList
+ * \ingroup vlan
+ *
+ * \chips           FM10000
+ *
+ * \desc            Adds multiple ports to each VLAN of a range at one time.
+ *                  This function provides a performance optimization over
+ *                  calling ''fmAddVlanPortList'' once per VLAN: the port
+ *                  list is processed once and the table entries of each
+ *                  VLAN are written at most once.
+ *
+ * \note            When a port is added to a VLAN, by default it will be
+ *                  in a disabled state so that traffic is not forwarded.
+ *                  See ''fmAddVlanPortList''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       firstVlanID is the first VLAN number to which the ports
+ *                  should be added.
+ *
+ * \param[in]       lastVlanID is the last VLAN number to which the ports
+ *                  should be added. Every VLAN from firstVlanID to
+ *                  lastVlanID must exist.
+ *
+ * \param[in]       numPorts is the number of ports in the list.
+ * 
+ * \param[in]       portList points to an array containing the list of ports
+ *                  to be added to the VLANs.
+ *
+ * \param[in]       tag should be:
+ *                      - TRUE to tag egressing frames on port.
+ *                      - FALSE to not tag egressing frames on port.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_VLAN if the VLAN range is invalid or any
+ *                  VLAN in it does not exist.
+ * \return          FM_ERR_INVALID_PORT if any of the ports is invalid.
+ *
+ *****************************************************************************/
+fm_status fmAddVlanRangePortList(fm_int    sw,
+                                 fm_uint16 firstVlanID,
+                                 fm_uint16 lastVlanID,
+                                 fm_int    numPorts,
+                                 fm_int *  portList,
+                                 fm_bool   tag)
+{
+    fm_switch * switchPtr;
+    fm_status   err;
+    fm_int      vlanID;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_VLAN,
+                     "sw=%d firstVlanID=%u lastVlanID=%u numPorts=%d tag=%d\n",
+                     sw, firstVlanID, lastVlanID, numPorts, tag);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    err = ValidateVlanRange(sw, firstVlanID, lastVlanID);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+
+    if (switchPtr->AddVlanRangePortList != NULL)
+    {
+        err = switchPtr->AddVlanRangePortList(sw,
+                                              firstVlanID,
+                                              lastVlanID,
+                                              numPorts,
+                                              portList,
+                                              tag);
+    }
+    else
+    {
+        for (vlanID = firstVlanID ; vlanID <= lastVlanID ; vlanID++)
+        {
+            FM_API_CALL_FAMILY(err,
+                               switchPtr->AddVlanPortList,
+                               sw,
+                               (fm_uint16) vlanID,
+                               numPorts,
+                               portList,
+                               tag);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+        }
+    }
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_VLAN, err);
+
+}   /* end fmAddVlanRangePortList */
+
+
+
+
+/*****************************************************************************/
+/** fmDeleteVlanRangePortList
+ * \ingroup vlan
+ *
+ * \chips           FM10000
+ *
+ * \desc            Deletes multiple ports from each VLAN of a range at one
+ *                  time. This function provides a performance optimization
+ *                  over calling ''fmDeleteVlanPortList'' once per VLAN.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       firstVlanID is the first VLAN number from which the
+ *                  ports should be deleted.
+ *
+ * \param[in]       lastVlanID is the last VLAN number from which the ports
+ *                  should be deleted. Every VLAN from firstVlanID to
+ *                  lastVlanID must exist.
+ *
+ * \param[in]       numPorts is the number of ports in the list.
+ * 
+ * \param[in]       portList points to an array containing the list of ports
+ *                  to be removed from the VLANs.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_VLAN if the VLAN range is invalid or any
+ *                  VLAN in it does not exist.
+ * \return          FM_ERR_INVALID_PORT if any of the ports is invalid.
+ *
+ *****************************************************************************/
+fm_status fmDeleteVlanRangePortList(fm_int    sw,
+                                    fm_uint16 firstVlanID,
+                                    fm_uint16 lastVlanID,
+                                    fm_int    numPorts,
+                                    fm_int *  portList)
+{
+    fm_switch *    switchPtr;
+    fm_status      err;
+    fm_int         vlanID;
+    fm_int         i;
+    fm_flushParams flushParams;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_VLAN,
+                     "sw=%d firstVlanID=%u lastVlanID=%u numPorts=%d\n",
+                     sw, firstVlanID, lastVlanID, numPorts);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    err = ValidateVlanRange(sw, firstVlanID, lastVlanID);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+
+    if (switchPtr->DeleteVlanRangePortList != NULL)
+    {
+        err = switchPtr->DeleteVlanRangePortList(sw,
+                                                 firstVlanID,
+                                                 lastVlanID,
+                                                 numPorts,
+                                                 portList);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+    }
+    else
+    {
+        for (vlanID = firstVlanID ; vlanID <= lastVlanID ; vlanID++)
+        {
+            FM_API_CALL_FAMILY(err,
+                               switchPtr->DeleteVlanPortList,
+                               sw,
+                               (fm_uint16) vlanID,
+                               numPorts,
+                               portList);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+        }
+    }
+
+    if (GET_PROPERTY()->maFlushOnVlanChange)
+    {
+        for (vlanID = firstVlanID ; vlanID <= lastVlanID ; vlanID++)
+        {
+            flushParams.vid1 = vlanID;
+
+            for (i = 0 ; i < numPorts ; i++)
+            {
+                flushParams.port = portList[i];
+                err = fmFlushAddresses(sw, FM_FLUSH_MODE_PORT_VLAN, flushParams);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+            }
+        }
+    }
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_VLAN, err);
+
+}   /* end fmDeleteVlanRangePortList */
+
+
+
+
 /*****************************************************************************/
 /** fmChangeVlanPortInternal
  * \ingroup intVlan
@@ -110,13 +110,31 @@ static fm_status ConfigureTunnelRoute(fm_int            sw,
         FM_LOG_EXIT(FM_LOG_CAT_VN, FM_OK);
     }
 
-    if ( fmTreeSize(&route->vnTunnelsTree) == 0 )
+    /* Most routes never carry a tunnel, so the tree is only allocated
+     * for the first one. */
+    if (route->vnTunnelsTree == NULL)
     {
+        route->vnTunnelsTree = fmAlloc( sizeof(fm_tree) );
+        if (route->vnTunnelsTree == NULL)
+        {
+            tunnel->route = NULL;
+            FM_LOG_EXIT(FM_LOG_CAT_VN, FM_ERR_NO_MEM);
+        }
+
+        fmTreeInit(route->vnTunnelsTree);
+
         status = fmCustomTreeInsert( &switchPtr->vnTunnelRoutes, route, route );
-        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
+        if (status != FM_OK)
+        {
+            fmTreeDestroy(route->vnTunnelsTree, NULL);
+            fmFree(route->vnTunnelsTree);
+            route->vnTunnelsTree = NULL;
+            tunnel->route        = NULL;
+            FM_LOG_EXIT(FM_LOG_CAT_VN, status);
+        }
     }
 
-    status = fmTreeInsert(&route->vnTunnelsTree, tunnel->tunnelId, tunnel);
+    status = fmTreeInsert(route->vnTunnelsTree, tunnel->tunnelId, tunnel);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
 
     FM_LOG_EXIT(FM_LOG_CAT_VN, status);
@@ -160,11 +178,20 @@ static fm_status UnconfigureTunnelRoute(fm_int sw, fm_vnTunnel *tunnel)
     if (route != NULL)
     {
         /* Clean up the previous route */
-        status = fmTreeRemove(&route->vnTunnelsTree, tunnel->tunnelId, NULL);
+        if (route->vnTunnelsTree == NULL)
+        {
+            FM_LOG_EXIT(FM_LOG_CAT_VN, FM_ERR_NOT_FOUND);
+        }
+
+        status = fmTreeRemove(route->vnTunnelsTree, tunnel->tunnelId, NULL);
         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
 
-        if ( fmTreeSize(&route->vnTunnelsTree) == 0 )
+        if ( fmTreeSize(route->vnTunnelsTree) == 0 )
         {
+            fmTreeDestroy(route->vnTunnelsTree, NULL);
+            fmFree(route->vnTunnelsTree);
+            route->vnTunnelsTree = NULL;
+
             status = fmCustomTreeRemove(&switchPtr->vnTunnelRoutes, route, NULL);
             FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_VN, status);
         }
@@ -2596,7 +2623,7 @@ fm_status fmNotifyVNTunnelAboutEcmpChange(fm_int sw, fm_intRouteEntry *route)
         FM_LOG_EXIT(FM_LOG_CAT_VN, FM_OK);
     }
 
-    if ( fmTreeSize(&route->vnTunnelsTree) == 0)
+    if (route->vnTunnelsTree == NULL)
     {
         FM_LOG_EXIT(FM_LOG_CAT_VN, FM_OK);
     }
@@ -2606,7 +2633,7 @@ fm_status fmNotifyVNTunnelAboutEcmpChange(fm_int sw, fm_intRouteEntry *route)
         FM_LOG_EXIT(FM_LOG_CAT_VN, FM_OK);
     }
 
-    fmTreeIterInit(&iter, &route->vnTunnelsTree);
+    fmTreeIterInit(&iter, route->vnTunnelsTree);
 
     while (1)
     {
@@ -5420,6 +5447,155 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fmVNBatchBegin
+ * \ingroup virtualNetwork
+ *
+ * \chips           FM10000
+ *
+ * \desc            Opens a virtual network provisioning batch on a switch.
+ *                  Until ''fmVNBatchCommit'' is called, the virtual network
+ *                  functions update the encapsulation and decapsulation
+ *                  ACL rules without recompiling the ACLs, which are
+ *                  compiled and applied once by the commit. This makes
+ *                  bringing up a large number of virtual networks, tunnels
+ *                  and remote addresses much faster.
+ *
+ * \note            The batch applies to the switch, not to the calling
+ *                  thread. Traffic of the virtual networks provisioned
+ *                  inside the batch is not encapsulated or decapsulated
+ *                  until the batch is committed.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_UNSUPPORTED if virtual networks are not supported.
+ * \return          FM_ERR_INVALID_STATE if a batch is already open.
+ *
+ *****************************************************************************/
+fm_status fmVNBatchBegin(fm_int sw)
+{
+    fm_status  status;
+    fm_switch *switchPtr;
+    fm_bool    routingLockTaken;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_VN, "sw = %d\n", sw);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    routingLockTaken = FALSE;
+    switchPtr        = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->maxVNTunnels <= 0)
+    {
+        status = FM_ERR_UNSUPPORTED;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
+    }
+
+    status = fmCaptureWriteLock(&switchPtr->routingLock, FM_WAIT_FOREVER);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
+
+    routingLockTaken = TRUE;
+
+    FM_API_CALL_FAMILY(status, switchPtr->BeginVNBatch, sw);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
+
+ABORT:
+
+    if (routingLockTaken)
+    {
+        fmReleaseWriteLock(&switchPtr->routingLock);
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_VN, status);
+
+}   /* end fmVNBatchBegin */
+
+
+
+
+/*****************************************************************************/
+/** fmVNBatchCommit
+ * \ingroup virtualNetwork
+ *
+ * \chips           FM10000
+ *
+ * \desc            Closes the virtual network provisioning batch opened by
+ *                  ''fmVNBatchBegin'', then compiles and applies the ACLs
+ *                  changed inside the batch.
+ *
+ * \note            The batch is closed even if this function fails. The
+ *                  rules stay in the ACLs and are compiled again by the
+ *                  next virtual network update.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_UNSUPPORTED if virtual networks are not supported.
+ * \return          FM_ERR_INVALID_STATE if no batch is open.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure to compile or apply the ACLs.
+ *
+ *****************************************************************************/
+fm_status fmVNBatchCommit(fm_int sw)
+{
+    fm_status  status;
+    fm_switch *switchPtr;
+    fm_bool    routingLockTaken;
+    fm_bool    lbgLockTaken;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_VN, "sw = %d\n", sw);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    routingLockTaken = FALSE;
+    lbgLockTaken     = FALSE;
+    switchPtr        = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->maxVNTunnels <= 0)
+    {
+        status = FM_ERR_UNSUPPORTED;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
+    }
+
+    status = fmCaptureLock(&switchPtr->lbgInfo.lbgLock, FM_WAIT_FOREVER);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
+
+    lbgLockTaken = TRUE;
+
+    status = fmCaptureWriteLock(&switchPtr->routingLock, FM_WAIT_FOREVER);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
+
+    routingLockTaken = TRUE;
+
+    FM_API_CALL_FAMILY(status, switchPtr->CommitVNBatch, sw);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VN, status);
+
+ABORT:
+
+    if (routingLockTaken)
+    {
+        fmReleaseWriteLock(&switchPtr->routingLock);
+    }
+
+    if (lbgLockTaken)
+    {
+        fmReleaseLock(&switchPtr->lbgInfo.lbgLock);
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_VN, status);
+
+}   /* end fmVNBatchCommit */
+
+
+
+
 /*****************************************************************************/
 /** fmDbgDumpVN
  * \ingroup intDebug
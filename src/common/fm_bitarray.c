@@ -37,6 +37,19 @@
  * Macros, Constants & Types
  *****************************************************************************/
 
+/* Number of bits held by each word of the bit array data. */
+#define BITS_PER_WORD               ( (fm_int) sizeof(fm_uint) * 8 )
+
+/* Words processed per iteration of the AVX2 set operations. */
+#define AVX2_WORDS                  ( 32 / (fm_int) sizeof(fm_uint) )
+
+/* The AVX2 set operations are built with GCC's target attribute and selected
+ * at run time, so the rest of the file does not require AVX2 support. */
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define FM_BITARRAY_AVX2
+typedef fm_uint fm_bitArrayVec __attribute__ ( (vector_size(32)) );
+#endif
+
 
 /*****************************************************************************
  * Global Variables
@@ -58,6 +71,262 @@
  *****************************************************************************/
 
 
+/*****************************************************************************
+ * FindNextBit
+ *
+ * Description: Searches a bit array a word at a time, starting with a
+ *              specified bit, for the next bit that has the specified value.
+ *              The caller has already validated the arguments.
+ *
+ * Arguments:   bitArray                pointer to the bit array
+ *
+ *              firstBitNumber          starting bit number (0 to bitCount)
+ *
+ *              bitValue                specified bit value to find
+ *                                      (TRUE/FALSE)
+ *
+ * Returns:     the bit number found, or -1 if there is none.
+ *
+ *****************************************************************************/
+static fm_int FindNextBit(const fm_bitArray *bitArray,
+                          fm_int             firstBitNumber,
+                          fm_bool            bitValue)
+{
+    fm_uint invert;
+    fm_uint word;
+    fm_int  offset;
+    fm_int  bit;
+
+    if (firstBitNumber >= bitArray->bitCount)
+    {
+        return -1;
+    }
+
+    /* Searching for a clear bit is a search for a set bit in the
+     * complement, so every word is XORed with the inversion pattern. */
+    invert = bitValue ? 0 : ~0U;
+    offset = firstBitNumber / BITS_PER_WORD;
+    word   = (bitArray->bitArrayData[offset] ^ invert) &
+             ( ~0U << (firstBitNumber % BITS_PER_WORD) );
+
+    while (word == 0)
+    {
+        if (++offset >= bitArray->wordCount)
+        {
+            return -1;
+        }
+
+        word = bitArray->bitArrayData[offset] ^ invert;
+    }
+
+    /* The unused bits of the last word are always clear, so a search for
+     * a clear bit can land beyond the end of the array. */
+    bit = (offset * BITS_PER_WORD) + __builtin_ctz(word);
+
+    return (bit < bitArray->bitCount) ? bit : -1;
+
+}   /* end FindNextBit */
+
+
+
+
+/*****************************************************************************
+ * FindBitRun
+ *
+ * Description: Searches a bit array, starting with a specified bit, for
+ *              the first run of contiguous bits that have the specified
+ *              value. Each step skips a whole run of bits, so the search is
+ *              linear in the number of words. The caller has already
+ *              validated the arguments.
+ *
+ * Arguments:   bitArray                pointer to the bit array
+ *
+ *              firstBitNumber          starting bit number (0 to bitCount)
+ *
+ *              runLength               number of bits in the run
+ *
+ *              bitValue                specified bit value to find
+ *                                      (TRUE/FALSE)
+ *
+ * Returns:     the first bit of the run, or -1 if there is none.
+ *
+ *****************************************************************************/
+static fm_int FindBitRun(const fm_bitArray *bitArray,
+                         fm_int             firstBitNumber,
+                         fm_int             runLength,
+                         fm_bool            bitValue)
+{
+    fm_int start;
+    fm_int end;
+
+    start = FindNextBit(bitArray, firstBitNumber, bitValue);
+
+    while (start >= 0)
+    {
+        if (start + runLength > bitArray->bitCount)
+        {
+            return -1;
+        }
+
+        end = FindNextBit(bitArray, start + 1, !bitValue);
+
+        if ( (end < 0) || (end - start >= runLength) )
+        {
+            return start;
+        }
+
+        start = FindNextBit(bitArray, end + 1, bitValue);
+    }
+
+    return -1;
+
+}   /* end FindBitRun */
+
+
+
+
+/*****************************************************************************
+ * CombineWords
+ *
+ * Description: Computes the bitwise OR or AND of two word arrays and counts
+ *              the bits set in the result.
+ *
+ * Arguments:   src1                    pointer to the first word array
+ *
+ *              src2                    pointer to the second word array
+ *
+ *              dst                     pointer to the destination word array
+ *
+ *              wordCount               number of words in each array
+ *
+ *              isAnd                   TRUE to AND the arrays, FALSE to OR
+ *
+ * Returns:     the number of bits set in dst.
+ *
+ *****************************************************************************/
+static fm_int CombineWords(const fm_uint *src1,
+                           const fm_uint *src2,
+                           fm_uint *      dst,
+                           fm_int         wordCount,
+                           fm_bool        isAnd)
+{
+    fm_int  nonZeroBitCount = 0;
+    fm_int  i;
+    fm_uint word;
+
+    for (i = 0 ; i < wordCount ; i++)
+    {
+        word   = isAnd ? (src1[i] & src2[i]) : (src1[i] | src2[i]);
+        dst[i] = word;
+        nonZeroBitCount += __builtin_popcount(word);
+    }
+
+    return nonZeroBitCount;
+
+}   /* end CombineWords */
+
+
+
+
+#ifdef FM_BITARRAY_AVX2
+/*****************************************************************************
+ * CombineWordsAvx2
+ *
+ * Description: AVX2 version of CombineWords, processing 256 bits per
+ *              iteration. Must only be called when the CPU supports AVX2.
+ *
+ * Arguments:   See CombineWords.
+ *
+ * Returns:     the number of bits set in dst.
+ *
+ *****************************************************************************/
+__attribute__ ( (target("avx2,popcnt")) )
+static fm_int CombineWordsAvx2(const fm_uint *src1,
+                               const fm_uint *src2,
+                               fm_uint *      dst,
+                               fm_int         wordCount,
+                               fm_bool        isAnd)
+{
+    fm_bitArrayVec a;
+    fm_bitArrayVec b;
+    fm_int         nonZeroBitCount = 0;
+    fm_int         i;
+    fm_int         j;
+
+    for (i = 0 ; i + AVX2_WORDS <= wordCount ; i += AVX2_WORDS)
+    {
+        /* The word arrays come from fmAlloc and are not 32-byte aligned. */
+        __builtin_memcpy(&a, src1 + i, sizeof(a));
+        __builtin_memcpy(&b, src2 + i, sizeof(b));
+
+        a = isAnd ? (a & b) : (a | b);
+
+        __builtin_memcpy(dst + i, &a, sizeof(a));
+
+        for (j = 0 ; j < AVX2_WORDS ; j++)
+        {
+            nonZeroBitCount += __builtin_popcount(a[j]);
+        }
+    }
+
+    return nonZeroBitCount + CombineWords(src1 + i,
+                                          src2 + i,
+                                          dst + i,
+                                          wordCount - i,
+                                          isAnd);
+
+}   /* end CombineWordsAvx2 */
+#endif
+
+
+
+
+/*****************************************************************************
+ * CombineBitArrays
+ *
+ * Description: Computes the bitwise OR or AND of two bit arrays, using the
+ *              AVX2 version when the CPU supports it and the arrays are
+ *              wide enough to benefit.
+ *
+ * Arguments:   src1                    pointer to the first bit array
+ *
+ *              src2                    pointer to the second bit array
+ *
+ *              dst                     pointer to the destination bit array
+ *
+ *              isAnd                   TRUE to AND the arrays, FALSE to OR
+ *
+ * Returns:     None.
+ *
+ *****************************************************************************/
+static void CombineBitArrays(const fm_bitArray *src1,
+                             const fm_bitArray *src2,
+                             fm_bitArray *      dst,
+                             fm_bool            isAnd)
+{
+#ifdef FM_BITARRAY_AVX2
+    if ( (dst->wordCount >= AVX2_WORDS) && __builtin_cpu_supports("avx2") )
+    {
+        dst->nonZeroBitCount = CombineWordsAvx2(src1->bitArrayData,
+                                                src2->bitArrayData,
+                                                dst->bitArrayData,
+                                                dst->wordCount,
+                                                isAnd);
+        return;
+    }
+#endif
+
+    dst->nonZeroBitCount = CombineWords(src1->bitArrayData,
+                                        src2->bitArrayData,
+                                        dst->bitArrayData,
+                                        dst->wordCount,
+                                        isAnd);
+
+}   /* end CombineBitArrays */
+
+
+
+
 /*****************************************************************************
  * GetBitPosition
  *
@@ -334,24 +603,55 @@ fm_status fmSetBitArrayBlock(fm_bitArray *bitArray,
                              fm_int       numBits,
                              fm_bool      bitValue)
 {
-    fm_status status = FM_OK;
-    fm_int    i;
-    fm_int    j;
+    fm_uint *pWord;
+    fm_uint  mask;
+    fm_uint  old;
+    fm_int   bit;
+    fm_int   endBit;
+    fm_int   span;
 
-    /* This could be optimized by setting whole words at a time,
-     * watching out for the boundary words. */
+    if (numBits <= 0)
+    {
+        return FM_OK;
+    }
 
-    for (j = 0, i = startBitNumber ; j < numBits ; i++, j++)
+    if ( (bitArray == NULL)
+        || (startBitNumber < 0)
+        || (startBitNumber > bitArray->bitCount - numBits) )
     {
-        status = fmSetBitArrayBit(bitArray, i, bitValue);
+        return FM_ERR_INVALID_ARGUMENT;
+    }
 
-        if (status != FM_OK)
+    /* Update a word at a time, masking the partial words at each end. */
+    endBit = startBitNumber + numBits;
+
+    for (bit = startBitNumber ; bit < endBit ; bit += span)
+    {
+        pWord = bitArray->bitArrayData + (bit / BITS_PER_WORD);
+        span  = BITS_PER_WORD - (bit % BITS_PER_WORD);
+
+        if (span > endBit - bit)
+        {
+            span = endBit - bit;
+        }
+
+        mask = ( (span == BITS_PER_WORD) ? ~0U : ( (1U << span) - 1 ) )
+               << (bit % BITS_PER_WORD);
+        old  = *pWord;
+
+        if (bitValue)
         {
-            return status;
+            *pWord = old | mask;
+            bitArray->nonZeroBitCount += __builtin_popcount(~old & mask);
+        }
+        else
+        {
+            *pWord = old & ~mask;
+            bitArray->nonZeroBitCount -= __builtin_popcount(old & mask);
         }
     }
 
-    return status;
+    return FM_OK;
 
 }   /* end fmSetBitArrayBlock */
 
@@ -476,13 +776,6 @@ fm_status fmFindBitInBitArray(fm_bitArray *bitArray,
                               fm_bool      bitValue,
                               fm_int *     foundBit)
 {
-    fm_uint *pWord;
-    fm_int   offset;
-    fm_uint  bitMask;
-    fm_uint  curWord;
-    fm_int   curBit;
-    fm_uint  skipPattern;
-
     if ( (bitArray == NULL) || (firstBitNumber < 0)
         || (firstBitNumber > bitArray->bitCount) )
     {
@@ -499,62 +792,8 @@ fm_status fmFindBitInBitArray(fm_bitArray *bitArray,
      * bit array.
      **************************************************/
 
-    if (firstBitNumber == bitArray->bitCount)
-    {
-        *foundBit = -1;
-        return FM_OK;
-    }
-
-    curBit  = firstBitNumber;
-    offset  = curBit / bitArray->bitsPerWord;
-    bitMask = 1 << (curBit % bitArray->bitsPerWord);
-
-    if (bitValue)
-    {
-        skipPattern = 0;
-    }
-    else
-    {
-        skipPattern = ~0;
-    }
-
-    while (curBit < bitArray->bitCount)
-    {
-        pWord   = bitArray->bitArrayData + offset;
-        curWord = *pWord;
-
-        if (curWord == skipPattern)
-        {
-            /* all bits in this word are not what we are looking for.
-             *  Jump to the starting bit of the next word. */
-            offset++;
-            bitMask = 1;
-            curBit  = offset * bitArray->bitsPerWord;
-        }
-        else
-        {
-            /* at least one bit in this word is what we are looking for.
-             *  Scan the word from the starting bit position. */
-            while ( (curBit < bitArray->bitCount) && (bitMask != 0) )
-            {
-                if ( ( bitValue && (curWord & bitMask) ) ||
-                    ( !bitValue && !(curWord & bitMask) ) )
-                {
-                    *foundBit = curBit;
-                    return FM_OK;
-                }
-
-                bitMask <<= 1;
-                curBit++;
-            }
+    *foundBit = FindNextBit(bitArray, firstBitNumber, bitValue);
 
-            offset++;
-            bitMask = 1;
-        }
-    }
-
-    /* no more bits found */
-    *foundBit = -1;
     return FM_OK;
 
 }   /* end fmFindBitInBitArray */
@@ -703,11 +942,6 @@ fm_status fmFindBitBlockInBitArray(fm_bitArray *bitArray,
                                    fm_bool      bitValue,
                                    fm_int *     foundBit)
 {
-    fm_uint   bitCount;
-    fm_int    nextBitNumber;
-    fm_int    workingFoundBit;
-    fm_status status = FM_OK;
-
     if ( (bitArray == NULL)
         || (firstBitNumber < 0)
         || (firstBitNumber > bitArray->bitCount)
@@ -717,65 +951,57 @@ fm_status fmFindBitBlockInBitArray(fm_bitArray *bitArray,
         return FM_ERR_INVALID_ARGUMENT;
     }
 
-    /**************************************************
-     * Look for the first bit of the requested value.
-     **************************************************/
+    *foundBit = FindBitRun(bitArray, firstBitNumber, blockSize, bitValue);
 
-    status = fmFindBitInBitArray(bitArray,
-                                 firstBitNumber,
-                                 bitValue,
-                                 foundBit);
+    return FM_OK;
 
-    if ( (status != FM_OK) || (*foundBit == -1) )
-    {
-        /* Either error or no such bit. */
-        *foundBit = -1;
-    }
-    else
-    {
-        /**************************************************
-         * Check subsequent bits, looking for a contiguous
-         * block of the right value.
-         **************************************************/
+}   /* end fmFindBitBlockInBitArray */
 
-        nextBitNumber = *foundBit + 1;
-        bitCount      = blockSize - 1;
 
-        while (bitCount > 0)
-        {
-            /* Get next bit of the required value. */
-            status = fmFindBitInBitArray(bitArray,
-                                         nextBitNumber,
-                                         bitValue,
-                                         &workingFoundBit);
 
-            if ( (status != FM_OK) || (*foundBit == -1) )
-            {
-                /* An error occurred or no block big enough. */
-                *foundBit = -1;
-                break;
-            }
-            else if (workingFoundBit != nextBitNumber)
-            {
-                /* Block was not the required size. Restart search. */
-                *foundBit     = workingFoundBit;
-                nextBitNumber = workingFoundBit + 1;
-                bitCount      = blockSize - 1;
-            }
-            else
-            {
-                /* The current block is still a candidate. */
-                nextBitNumber = workingFoundBit + 1;
-                --bitCount;
-            }
 
-        }   /* end while (bitCount > 0) */
+/*****************************************************************************
+ * fmFindBitRunInBitArray
+ *
+ * Description: Searches a bit array in the forward direction, starting with
+ *              a specified bit, for the first run of contiguous clear bits
+ *              of the requested length. Intended for block allocators that
+ *              track used entries as set bits. The search skips whole runs
+ *              and words at a time, so it is linear in the number of words
+ *              rather than the number of bits.
+ *
+ * Arguments:   bitArray                pointer to the bit array
+ *
+ *              firstBitNumber          starting bit number (0 to bitCount)
+ *
+ *              runLength               number of clear bits required
+ *
+ *              foundBit                pointer for returned first bit of
+ *                                      the run, will be 0 to bitCount-1 if
+ *                                      found, -1 if not found
+ *
+ * Returns:     Fulcrum API status code
+ *
+ *****************************************************************************/
+fm_status fmFindBitRunInBitArray(fm_bitArray *bitArray,
+                                 fm_int       firstBitNumber,
+                                 fm_int       runLength,
+                                 fm_int *     foundBit)
+{
+    if ( (bitArray == NULL)
+        || (foundBit == NULL)
+        || (firstBitNumber < 0)
+        || (firstBitNumber > bitArray->bitCount)
+        || (runLength < 1) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
 
-    }       /* end if ( (status != FM_OK) || (*foundBit == -1) ) */
+    *foundBit = FindBitRun(bitArray, firstBitNumber, runLength, FALSE);
 
-    return status;
+    return FM_OK;
 
-}   /* end fmFindBitBlockInBitArray */
+}   /* end fmFindBitRunInBitArray */
 
 
 
@@ -1070,10 +1296,6 @@ fm_status fmUnionBitArrays(const fm_bitArray *src1,
                            const fm_bitArray *src2,
                            fm_bitArray *      dst)
 {
-    fm_int i;
-    fm_uint word;
-    fm_int nonZeroBitCount = 0;
-
     if (src1->bitsPerWord != src2->bitsPerWord ||
         src2->bitsPerWord != dst->bitsPerWord)
     {
@@ -1092,19 +1314,7 @@ fm_status fmUnionBitArrays(const fm_bitArray *src1,
         return FM_ERR_INVALID_ARGUMENT;
     }
 
-    for (i = 0 ; i < src1->wordCount ; i++)
-    {
-        word = (src1->bitArrayData[i] | src2->bitArrayData[i]);
-        dst->bitArrayData[i] = word;
-
-        /* "Brian Kernighan Algorithm" for counting 1 bits */
-        for ( ; word != 0 ; word &= word - 1)
-        {
-            nonZeroBitCount++;
-        }
-    }
-
-    dst->nonZeroBitCount = nonZeroBitCount;
+    CombineBitArrays(src1, src2, dst, FALSE);
 
     return FM_OK;
 
@@ -1165,27 +1375,13 @@ fm_status fmAndBitArrays(fm_bitArray *src1,
                          fm_bitArray *src2, 
                          fm_bitArray *dst)
 {
-    fm_int  i;
-    fm_uint word;
-
-    if (dst->wordCount != src1->wordCount)
+    if ( (dst->wordCount != src1->wordCount)
+        || (dst->wordCount != src2->wordCount) )
     {
         return FM_ERR_INVALID_ARGUMENT;
     }
 
-    dst->nonZeroBitCount = 0;
-
-    for ( i = 0 ; i < src1->wordCount ; i++ )
-    {
-        word = src1->bitArrayData[i] & src2->bitArrayData[i];
-        dst->bitArrayData[i] = word;
-
-        /* "Brian Kernighan Algorithm" for counting 1 bits */
-        for ( ; word != 0 ; word &= word - 1)
-        {
-            dst->nonZeroBitCount++;
-        }
-    }
+    CombineBitArrays(src1, src2, dst, TRUE);
 
     return FM_OK;
 
@@ -37,6 +37,25 @@
  * Macros, Constants & Types
  *****************************************************************************/
 
+/* The SSE4.2 and PCLMULQDQ versions are built with GCC's target attribute
+ * and selected at run time, so the rest of the file does not require
+ * these instructions. */
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define FM_CRC32_X86
+#include <immintrin.h>
+#endif
+
+/* Number of tables of the slice-by-8 versions */
+#define NUM_SLICES                  8
+
+/* Smallest buffer worth folding with PCLMULQDQ, in bytes */
+#define CLMUL_MIN_BYTES             64
+
+/* States of the slice-by-8 tables, built on first use */
+#define SLICE_TABLES_NONE           0
+#define SLICE_TABLES_BUILDING       1
+#define SLICE_TABLES_READY          2
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -191,6 +210,30 @@ static const fm_uint32 fmCrc32CTable[] =
     0xad7d5351U
 };
 
+/* Slice-by-8 tables of CRC-32 and CRC-32C. Entry [k][i] is the CRC of byte
+ * i followed by k zero bytes. */
+static fm_uint32 crc32Slices[NUM_SLICES][256];
+static fm_uint32 crc32CSlices[NUM_SLICES][256];
+
+/* State of crc32Slices and crc32CSlices, see SLICE_TABLES_* */
+static fm_int    sliceTablesState = SLICE_TABLES_NONE;
+
+#ifdef FM_CRC32_X86
+/* Folding constants of the bit-reflected CRC-32 polynomial for PCLMULQDQ,
+ * from "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+ * Instruction", Intel, 2009: x^(4*128+32) and x^(4*128-32) mod P, then
+ * x^(128+32) and x^(128-32) mod P, x^64 mod P, and P and the Barrett
+ * constant. */
+static const fm_uint64 crc32FoldBy4[2] __attribute__ ( (aligned(16)) ) =
+    { FM_LITERAL_U64(0x0154442bd4), FM_LITERAL_U64(0x01c6e41596) };
+static const fm_uint64 crc32FoldBy1[2] __attribute__ ( (aligned(16)) ) =
+    { FM_LITERAL_U64(0x01751997d0), FM_LITERAL_U64(0x00ccaa009e) };
+static const fm_uint64 crc32Fold64[2] __attribute__ ( (aligned(16)) ) =
+    { FM_LITERAL_U64(0x0163cd6124), FM_LITERAL_U64(0) };
+static const fm_uint64 crc32Barrett[2] __attribute__ ( (aligned(16)) ) =
+    { FM_LITERAL_U64(0x01db710641), FM_LITERAL_U64(0x01f7011641) };
+#endif
+
 /*****************************************************************************
  * Local function prototypes.
  *****************************************************************************/
@@ -199,6 +242,393 @@ static const fm_uint32 fmCrc32CTable[] =
  * Local Functions
  *****************************************************************************/
 
+/*****************************************************************************/
+/** BuildSliceTables
+ * \ingroup intUtil
+ *
+ * \desc            Derives the slice-by-8 tables of a CRC from its
+ *                  byte-at-a-time table.
+ *
+ * \param[in]       table points to the byte-at-a-time table.
+ *
+ * \param[out]      slices points to the slice-by-8 tables to fill in.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BuildSliceTables(const fm_uint32 *table,
+                             fm_uint32        slices[NUM_SLICES][256])
+{
+    fm_int i;
+    fm_int k;
+
+    for (i = 0 ; i < 256 ; i++)
+    {
+        slices[0][i] = table[i];
+
+        for (k = 1 ; k < NUM_SLICES ; k++)
+        {
+            slices[k][i] = table[slices[k - 1][i] & 0xff] ^
+                           (slices[k - 1][i] >> 8);
+        }
+    }
+
+}   /* end BuildSliceTables */
+
+
+
+
+/*****************************************************************************/
+/** SliceTablesReady
+ * \ingroup intUtil
+ *
+ * \desc            Builds the slice-by-8 tables on first use. A caller
+ *                  racing with the thread building them is told they are
+ *                  not ready rather than made to wait.
+ *
+ * \return          TRUE if the slice-by-8 tables can be used.
+ *
+ *****************************************************************************/
+static fm_bool SliceTablesReady(void)
+{
+    fm_int expected;
+
+    if (FM_ATOMIC_LOAD(&sliceTablesState) == SLICE_TABLES_READY)
+    {
+        return TRUE;
+    }
+
+    expected = SLICE_TABLES_NONE;
+
+    if ( !FM_ATOMIC_CAS(&sliceTablesState, &expected, SLICE_TABLES_BUILDING) )
+    {
+        return FALSE;
+    }
+
+    BuildSliceTables(fmCrc32Table, crc32Slices);
+    BuildSliceTables(fmCrc32CTable, crc32CSlices);
+
+    FM_ATOMIC_STORE(&sliceTablesState, SLICE_TABLES_READY);
+
+    return TRUE;
+
+}   /* end SliceTablesReady */
+
+
+
+
+/*****************************************************************************/
+/** UpdateCrc
+ * \ingroup intUtil
+ *
+ * \desc            Folds a buffer into a bit-reflected CRC register, eight
+ *                  bytes at a time with the slice-by-8 tables once they are
+ *                  built, or one byte at a time otherwise.
+ *
+ * \param[in]       table points to the byte-at-a-time table of the CRC.
+ *
+ * \param[in]       slices points to the slice-by-8 tables of the CRC.
+ *
+ * \param[in]       crc is the CRC register.
+ *
+ * \param[in]       buf points to the buffer.
+ *
+ * \param[in]       len is the number of bytes in buf.
+ *
+ * \return          The updated CRC register.
+ *
+ *****************************************************************************/
+static fm_uint32 UpdateCrc(const fm_uint32 *table,
+                           fm_uint32        slices[NUM_SLICES][256],
+                           fm_uint32        crc,
+                           const fm_byte *  buf,
+                           fm_int           len)
+{
+    fm_uint32 lo;
+    fm_uint32 hi;
+    fm_int    i = 0;
+
+    if ( (len >= NUM_SLICES) && SliceTablesReady() )
+    {
+        for ( ; i + NUM_SLICES <= len ; i += NUM_SLICES)
+        {
+            lo = crc ^ ( (fm_uint32) buf[i] |
+                         ( (fm_uint32) buf[i + 1] << 8 ) |
+                         ( (fm_uint32) buf[i + 2] << 16 ) |
+                         ( (fm_uint32) buf[i + 3] << 24 ) );
+            hi = (fm_uint32) buf[i + 4] |
+                 ( (fm_uint32) buf[i + 5] << 8 ) |
+                 ( (fm_uint32) buf[i + 6] << 16 ) |
+                 ( (fm_uint32) buf[i + 7] << 24 );
+
+            crc = slices[7][lo & 0xff] ^
+                  slices[6][(lo >> 8) & 0xff] ^
+                  slices[5][(lo >> 16) & 0xff] ^
+                  slices[4][lo >> 24] ^
+                  slices[3][hi & 0xff] ^
+                  slices[2][(hi >> 8) & 0xff] ^
+                  slices[1][(hi >> 16) & 0xff] ^
+                  slices[0][hi >> 24];
+        }
+    }
+
+    for ( ; i < len ; i++)
+    {
+        crc = table[(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
+    }
+
+    return crc;
+
+}   /* end UpdateCrc */
+
+
+
+
+#ifdef FM_CRC32_X86
+/*****************************************************************************/
+/** UpdateCrc32CSse42
+ * \ingroup intUtil
+ *
+ * \desc            Folds a buffer into a CRC-32C register with the SSE4.2
+ *                  crc32 instruction. Must only be called when the CPU
+ *                  supports SSE4.2.
+ *
+ * \param[in]       crc is the CRC register.
+ *
+ * \param[in]       buf points to the buffer.
+ *
+ * \param[in]       len is the number of bytes in buf.
+ *
+ * \return          The updated CRC register.
+ *
+ *****************************************************************************/
+__attribute__ ( (target("sse4.2")) )
+static fm_uint32 UpdateCrc32CSse42(fm_uint32 crc, const fm_byte *buf, fm_int len)
+{
+    fm_uint32 word32;
+    fm_int    i = 0;
+#ifdef __x86_64__
+    fm_uint64 word64;
+    fm_uint64 crc64 = crc;
+
+    for ( ; i + 8 <= len ; i += 8)
+    {
+        __builtin_memcpy(&word64, buf + i, sizeof(word64));
+        crc64 = _mm_crc32_u64(crc64, word64);
+    }
+
+    crc = (fm_uint32) crc64;
+#endif
+
+    for ( ; i + 4 <= len ; i += 4)
+    {
+        __builtin_memcpy(&word32, buf + i, sizeof(word32));
+        crc = _mm_crc32_u32(crc, word32);
+    }
+
+    for ( ; i < len ; i++)
+    {
+        crc = _mm_crc32_u8(crc, buf[i]);
+    }
+
+    return crc;
+
+}   /* end UpdateCrc32CSse42 */
+
+
+
+
+/*****************************************************************************/
+/** UpdateCrc32Clmul
+ * \ingroup intUtil
+ *
+ * \desc            Folds a buffer into a CRC-32 register with PCLMULQDQ,
+ *                  64 bytes at a time and then 16 bytes at a time, before
+ *                  a Barrett reduction back to 32 bits. Must only be called
+ *                  when the CPU supports PCLMULQDQ and SSE4.1.
+ *
+ * \param[in]       crc is the CRC register.
+ *
+ * \param[in]       buf points to the buffer.
+ *
+ * \param[in]       len is the number of bytes in buf, a multiple of 16 no
+ *                  smaller than CLMUL_MIN_BYTES.
+ *
+ * \return          The updated CRC register.
+ *
+ *****************************************************************************/
+__attribute__ ( (target("pclmul,sse4.1")) )
+static fm_uint32 UpdateCrc32Clmul(fm_uint32 crc, const fm_byte *buf, fm_int len)
+{
+    __m128i x0;
+    __m128i x1;
+    __m128i x2;
+    __m128i x3;
+    __m128i x4;
+    __m128i x5;
+    __m128i x6;
+    __m128i x7;
+    __m128i x8;
+    __m128i mask;
+
+    x1 = _mm_loadu_si128( (const __m128i *) (buf + 0x00) );
+    x2 = _mm_loadu_si128( (const __m128i *) (buf + 0x10) );
+    x3 = _mm_loadu_si128( (const __m128i *) (buf + 0x20) );
+    x4 = _mm_loadu_si128( (const __m128i *) (buf + 0x30) );
+    x1 = _mm_xor_si128( x1, _mm_cvtsi32_si128( (fm_int) crc ) );
+    x0 = _mm_load_si128( (const __m128i *) crc32FoldBy4 );
+
+    buf += 64;
+    len -= 64;
+
+    /* Fold four 128-bit lanes in parallel */
+    while (len >= 64)
+    {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        x1 = _mm_xor_si128( _mm_xor_si128(x1, x5),
+                            _mm_loadu_si128( (const __m128i *) (buf + 0x00) ) );
+        x2 = _mm_xor_si128( _mm_xor_si128(x2, x6),
+                            _mm_loadu_si128( (const __m128i *) (buf + 0x10) ) );
+        x3 = _mm_xor_si128( _mm_xor_si128(x3, x7),
+                            _mm_loadu_si128( (const __m128i *) (buf + 0x20) ) );
+        x4 = _mm_xor_si128( _mm_xor_si128(x4, x8),
+                            _mm_loadu_si128( (const __m128i *) (buf + 0x30) ) );
+
+        buf += 64;
+        len -= 64;
+    }
+
+    /* Fold the four lanes into one */
+    x0 = _mm_load_si128( (const __m128i *) crc32FoldBy1 );
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128( _mm_xor_si128(x1, x2), x5 );
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128( _mm_xor_si128(x1, x3), x5 );
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128( _mm_xor_si128(x1, x4), x5 );
+
+    /* Fold in the remaining 16-byte blocks */
+    while (len >= 16)
+    {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128( _mm_xor_si128( x1,
+                                           _mm_loadu_si128( (const __m128i *) buf ) ),
+                            x5 );
+
+        buf += 16;
+        len -= 16;
+    }
+
+    /* Fold 128 bits to 64 bits */
+    mask = _mm_setr_epi32(~0, 0, ~0, 0);
+    x2   = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x1   = _mm_xor_si128( _mm_srli_si128(x1, 8), x2 );
+    x0   = _mm_loadl_epi64( (const __m128i *) crc32Fold64 );
+    x2   = _mm_srli_si128(x1, 4);
+    x1   = _mm_and_si128(x1, mask);
+    x1   = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1   = _mm_xor_si128(x1, x2);
+
+    /* Barrett reduction to 32 bits */
+    x0 = _mm_load_si128( (const __m128i *) crc32Barrett );
+    x2 = _mm_and_si128(x1, mask);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, mask);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (fm_uint32) _mm_extract_epi32(x1, 1);
+
+}   /* end UpdateCrc32Clmul */
+#endif
+
+
+
+
+/*****************************************************************************/
+/** UpdateCrc32
+ * \ingroup intUtil
+ *
+ * \desc            Folds a buffer into a CRC-32 register, with PCLMULQDQ
+ *                  when the CPU supports it and the buffer is long enough
+ *                  to benefit, or with the slice-by-8 tables otherwise.
+ *
+ * \param[in]       crc is the CRC register.
+ *
+ * \param[in]       buf points to the buffer.
+ *
+ * \param[in]       len is the number of bytes in buf.
+ *
+ * \return          The updated CRC register.
+ *
+ *****************************************************************************/
+static fm_uint32 UpdateCrc32(fm_uint32 crc, const fm_byte *buf, fm_int len)
+{
+#ifdef FM_CRC32_X86
+    fm_int folded;
+
+    if ( (len >= CLMUL_MIN_BYTES) &&
+         __builtin_cpu_supports("pclmul") &&
+         __builtin_cpu_supports("sse4.1") )
+    {
+        folded = len & ~15;
+        crc    = UpdateCrc32Clmul(crc, buf, folded);
+        buf   += folded;
+        len   -= folded;
+    }
+#endif
+
+    return UpdateCrc(fmCrc32Table, crc32Slices, crc, buf, len);
+
+}   /* end UpdateCrc32 */
+
+
+
+
+/*****************************************************************************/
+/** UpdateCrc32C
+ * \ingroup intUtil
+ *
+ * \desc            Folds a buffer into a CRC-32C register, with the SSE4.2
+ *                  crc32 instruction when the CPU supports it, or with the
+ *                  slice-by-8 tables otherwise.
+ *
+ * \param[in]       crc is the CRC register.
+ *
+ * \param[in]       buf points to the buffer.
+ *
+ * \param[in]       len is the number of bytes in buf.
+ *
+ * \return          The updated CRC register.
+ *
+ *****************************************************************************/
+static fm_uint32 UpdateCrc32C(fm_uint32 crc, const fm_byte *buf, fm_int len)
+{
+#ifdef FM_CRC32_X86
+    if ( __builtin_cpu_supports("sse4.2") )
+    {
+        return UpdateCrc32CSse42(crc, buf, len);
+    }
+#endif
+
+    return UpdateCrc(fmCrc32CTable, crc32CSlices, crc, buf, len);
+
+}   /* end UpdateCrc32C */
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -219,15 +649,9 @@ static const fm_uint32 fmCrc32CTable[] =
  *****************************************************************************/
 fm_uint32 fmCrc32(fm_byte *buf, fm_int len)
 {
-    fm_int        i;
     fm_uint32     crc;
 
-    crc = 0xffffffffU;
-
-    for (i = 0 ; i < len ; i++)
-    {
-        crc = fmCrc32Table[(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
-    }
+    crc = UpdateCrc32(0xffffffffU, buf, len);
 
     crc = ~crc;
 
@@ -255,15 +679,9 @@ fm_uint32 fmCrc32(fm_byte *buf, fm_int len)
  *****************************************************************************/
 fm_uint32 fmCrc32Math(fm_byte *buf, fm_int len)
 {
-    fm_int        i;
     fm_uint32     crc;
 
-    crc = 0;
-
-    for (i = 0 ; i < len ; i++)
-    {
-        crc = fmCrc32Table[(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
-    }
+    crc = UpdateCrc32(0, buf, len);
 
     return crc;
 
@@ -288,15 +706,9 @@ fm_uint32 fmCrc32Math(fm_byte *buf, fm_int len)
  *****************************************************************************/
 fm_uint32 fmCrc32C(fm_byte *buf, fm_int len)
 {
-    fm_int    i;
     fm_uint32 crc;
 
-    crc = 0xffffffffU;
-
-    for (i = 0 ; i < len ; i++)
-    {
-        crc = fmCrc32CTable[(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
-    }
+    crc = UpdateCrc32C(0xffffffffU, buf, len);
 
     crc = ~crc;
 
@@ -58,6 +58,128 @@
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/** AllocNode
+ * \ingroup intList
+ *
+ * \desc            Obtains a node for a new list entry, taking it from the
+ *                  list's free pool when one is available so the insert
+ *                  does not go through the shared-memory allocator.
+ *
+ * \param[in]       list is the dlist the node will be inserted into.
+ *
+ * \param[out]      node points to caller-allocated storage where the node
+ *                  pointer will be written.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the list is intrusive.
+ * \return          FM_ERR_NO_MEM if no node could be allocated.
+ *
+ *****************************************************************************/
+static fm_status AllocNode(fm_dlist *list, fm_dlist_node **node)
+{
+    fm_dlist_node *nnode;
+
+    if (list->intrusive)
+    {
+        return FM_ERR_UNSUPPORTED;
+    }
+
+    nnode = list->freeNodes;
+
+    if (nnode != NULL)
+    {
+        list->freeNodes = nnode->nextPtr;
+        list->numFreeNodes--;
+    }
+    else
+    {
+        nnode = (fm_dlist_node *) fmAlloc( sizeof(fm_dlist_node) );
+
+        if (!nnode)
+        {
+            return FM_ERR_NO_MEM;
+        }
+    }
+
+    *node = nnode;
+
+    return FM_OK;
+
+}   /* end AllocNode */
+
+
+
+
+/*****************************************************************************/
+/** ReleaseNode
+ * \ingroup intList
+ *
+ * \desc            Disposes of a node that has been unlinked from the list.
+ *                  Nodes of an intrusive list belong to the caller and are
+ *                  left alone; otherwise the node is returned to the free
+ *                  pool if it has room, or freed.
+ *
+ * \param[in]       list is the dlist the node was removed from.
+ *
+ * \param[in]       node is the unlinked node.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+static void ReleaseNode(fm_dlist *list, fm_dlist_node *node)
+{
+    if (list->intrusive)
+    {
+        return;
+    }
+
+    if (list->numFreeNodes < list->maxFreeNodes)
+    {
+        node->data      = NULL;
+        node->prev      = NULL;
+        node->nextPtr   = list->freeNodes;
+        list->freeNodes = node;
+        list->numFreeNodes++;
+    }
+    else
+    {
+        fmFree(node);
+    }
+
+}   /* end ReleaseNode */
+
+
+
+
+/*****************************************************************************/
+/** DrainFreeNodes
+ * \ingroup intList
+ *
+ * \desc            Frees every node held in the list's free pool.
+ *
+ * \param[in]       list is the dlist on which to operate.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+static void DrainFreeNodes(fm_dlist *list)
+{
+    fm_dlist_node *p;
+
+    while (list->freeNodes != NULL)
+    {
+        p = list->freeNodes->nextPtr;
+        fmFree(list->freeNodes);
+        list->freeNodes = p;
+    }
+
+    list->numFreeNodes = 0;
+
+}   /* end DrainFreeNodes */
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -67,18 +189,138 @@ void fmDListInit(fm_dlist *list)
 {
     FM_DLL_INIT_LIST(list, head, tail);
 
+    list->freeNodes    = NULL;
+    list->numFreeNodes = 0;
+    list->maxFreeNodes = 0;
+    list->intrusive    = FALSE;
+
 }   /* end fmDListInit */
 
 
 
 
+/*****************************************************************************/
+/** fmDListInitPooled
+ * \ingroup intList
+ *
+ * \desc            Initializes a dlist that recycles its nodes. Nodes
+ *                  released by the remove functions are kept on a per-list
+ *                  free pool and reused by later inserts, so a list whose
+ *                  population stays within the pool size performs no
+ *                  allocator calls once warmed up (see
+ *                  ''fmDListReserveNodes'' to warm it up front).
+ *
+ * \note            The list performs no locking of its own; the pool is
+ *                  protected by whatever lock already guards the list.
+ *
+ * \param[in]       list is the dlist to initialize.
+ *
+ * \param[in]       maxFreeNodes is the maximum number of unused nodes the
+ *                  list retains. Nodes released beyond this are freed.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmDListInitPooled(fm_dlist *list, fm_int maxFreeNodes)
+{
+    fmDListInit(list);
+
+    list->maxFreeNodes = (maxFreeNodes > 0) ? maxFreeNodes : 0;
+
+}   /* end fmDListInitPooled */
+
+
+
+
+/*****************************************************************************/
+/** fmDListInitIntrusive
+ * \ingroup intList
+ *
+ * \desc            Initializes a dlist whose nodes are embedded in the
+ *                  caller's own structures. Entries are added with
+ *                  ''fmDListInsertNodeEnd'' or ''fmDListInsertNodeBegin''
+ *                  and no list function ever allocates or frees a node.
+ *
+ * \note            The allocating insert functions return
+ *                  FM_ERR_UNSUPPORTED on an intrusive list. A node must not
+ *                  be released by its owner while it is still linked.
+ *
+ * \param[in]       list is the dlist to initialize.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmDListInitIntrusive(fm_dlist *list)
+{
+    fmDListInit(list);
+
+    list->intrusive = TRUE;
+
+}   /* end fmDListInitIntrusive */
+
+
+
+
+/*****************************************************************************/
+/** fmDListReserveNodes
+ * \ingroup intList
+ *
+ * \desc            Pre-allocates nodes into the free pool of a pooled dlist
+ *                  so that subsequent inserts do not need to allocate.
+ *
+ * \param[in]       list is a dlist initialized with ''fmDListInitPooled''.
+ *
+ * \param[in]       numNodes is the number of free nodes wanted. The pool is
+ *                  never grown past the maximum given at initialization.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the list is intrusive.
+ * \return          FM_ERR_NO_MEM if a node could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmDListReserveNodes(fm_dlist *list, fm_int numNodes)
+{
+    fm_dlist_node *nnode;
+
+    if (list->intrusive)
+    {
+        return FM_ERR_UNSUPPORTED;
+    }
+
+    if (numNodes > list->maxFreeNodes)
+    {
+        numNodes = list->maxFreeNodes;
+    }
+
+    while (list->numFreeNodes < numNodes)
+    {
+        nnode = (fm_dlist_node *) fmAlloc( sizeof(fm_dlist_node) );
+
+        if (!nnode)
+        {
+            return FM_ERR_NO_MEM;
+        }
+
+        ReleaseNode(list, nnode);
+    }
+
+    return FM_OK;
+
+}   /* end fmDListReserveNodes */
+
+
+
+
 fm_status fmDListInsertEnd(fm_dlist *list, void *data)
 {
-    fm_dlist_node *nnode = (fm_dlist_node *) fmAlloc( sizeof(fm_dlist_node) );
+    fm_dlist_node *nnode;
+    fm_status      err;
 
-    if (!nnode)
+    err = AllocNode(list, &nnode);
+
+    if (err != FM_OK)
     {
-        return FM_ERR_NO_MEM;
+        return err;
     }
 
     nnode->data = data;
@@ -94,11 +336,14 @@ fm_status fmDListInsertEnd(fm_dlist *list, void *data)
 
 fm_status fmDListInsertBegin(fm_dlist *list, void *data)
 {
-    fm_dlist_node *nnode = (fm_dlist_node *) fmAlloc( sizeof(fm_dlist_node) );
+    fm_dlist_node *nnode;
+    fm_status      err;
 
-    if (!nnode)
+    err = AllocNode(list, &nnode);
+
+    if (err != FM_OK)
     {
-        return FM_ERR_NO_MEM;
+        return err;
     }
 
     nnode->data = data;
@@ -172,12 +417,13 @@ int fmDListInsertSorted(fm_dlist *list,
                         void *data)
 {
     fm_dlist_node *p, *nnode;
+    fm_status      err;
 
-    nnode = (fm_dlist_node *) fmAlloc( sizeof(fm_dlist_node) );
+    err = AllocNode(list, &nnode);
 
-    if (!nnode)
+    if (err != FM_OK)
     {
-        return FM_ERR_NO_MEM;
+        return err;
     }
 
     nnode->data = data;
@@ -218,7 +464,8 @@ void *fmDListFind(fm_dlist *list, int (*find)(void *, void *), void *key)
 
 
 
-/* assumes node is already in the list */
+/* assumes node is already in the list; the node itself is released to the
+ * list's pool, freed, or (for intrusive lists) left to its owner */
 void *fmDListRemove(fm_dlist *list, fm_dlist_node *node)
 {
     void *data;
@@ -228,7 +475,7 @@ void *fmDListRemove(fm_dlist *list, fm_dlist_node *node)
         FM_DLL_REMOVE_NODE(list, head, tail, node, nextPtr, prev);
 
         data = node->data;
-        fmFree(node);
+        ReleaseNode(list, node);
 
         return data;
     }
@@ -259,18 +506,7 @@ void *fmDListRemove(fm_dlist *list, fm_dlist_node *node)
  *****************************************************************************/
 void fmDListFree(fm_dlist *list)
 {
-    fm_dlist_node *p;
-
-    if (list->head)
-    {
-        do
-        {
-            p = list->head->nextPtr;
-            fmFree(list->head);
-            list->head = p;
-        }
-        while (p);
-    }
+    fmDListFreeWithDestructor(list, NULL);
 
 }   /* end fmDListFree */
 
@@ -281,7 +517,9 @@ void fmDListFree(fm_dlist *list)
 /** fmDListFreeWithDestructor
  * \ingroup intList
  *
- * \desc            Frees all space used by a dlist.
+ * \desc            Frees all space used by a dlist, including any nodes
+ *                  held in its free pool. The nodes of an intrusive list
+ *                  are only unlinked.
  *
  * \param[in]       list is the dlist on which to operate.
  *
@@ -305,12 +543,26 @@ void fmDListFreeWithDestructor(fm_dlist *list, fmFreeFunc delfunc)
             }
 
             p = list->head->nextPtr;
-            fmFree(list->head);
+
+            if (list->intrusive)
+            {
+                list->head->nextPtr = NULL;
+                list->head->prev    = NULL;
+            }
+            else
+            {
+                fmFree(list->head);
+            }
+
             list->head = p;
         }
         while (p);
     }
 
+    list->tail = NULL;
+
+    DrainFreeNodes(list);
+
 }   /* end fmDListFreeWithDestructor */
 
 
@@ -398,11 +650,14 @@ fm_status fmDListPeekFirst(fm_dlist *list, void **dataPtr)
  *****************************************************************************/
 fm_status fmDListInsertEndV2(fm_dlist *list, void *data, fm_dlist_node **node)
 {
-    fm_dlist_node *nnode = (fm_dlist_node *) fmAlloc( sizeof(fm_dlist_node) );
+    fm_dlist_node *nnode;
+    fm_status      err;
 
-    if (!nnode)
+    err = AllocNode(list, &nnode);
+
+    if (err != FM_OK)
     {
-        return FM_ERR_NO_MEM;
+        return err;
     }
 
     nnode->data = data;
@@ -436,11 +691,14 @@ fm_status fmDListInsertEndV2(fm_dlist *list, void *data, fm_dlist_node **node)
  *****************************************************************************/
 fm_status fmDListInsertBeginV2(fm_dlist *list, void *data, fm_dlist_node **node)
 {
-    fm_dlist_node *nnode = (fm_dlist_node *) fmAlloc( sizeof(fm_dlist_node) );
+    fm_dlist_node *nnode;
+    fm_status      err;
 
-    if (!nnode)
+    err = AllocNode(list, &nnode);
+
+    if (err != FM_OK)
     {
-        return FM_ERR_NO_MEM;
+        return err;
     }
 
     nnode->data = data;
@@ -453,3 +711,58 @@ fm_status fmDListInsertBeginV2(fm_dlist *list, void *data, fm_dlist_node **node)
 
 }   /* end fmDListInsertBeginV2 */
 
+
+
+
+/*****************************************************************************/
+/** fmDListInsertNodeEnd
+ * \ingroup intList
+ *
+ * \desc            Links a caller-owned node at the end of an intrusive
+ *                  list. No memory is allocated.
+ *
+ * \param[in]       list is a dlist initialized with ''fmDListInitIntrusive''.
+ *
+ * \param[in]       node is the node embedded in the caller's structure. It
+ *                  must not currently be linked into any list.
+ *
+ * \param[in]       data is the pointer to be stored in the node.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmDListInsertNodeEnd(fm_dlist *list, fm_dlist_node *node, void *data)
+{
+    node->data = data;
+
+    FM_DLL_INSERT_LAST(list, head, tail, node, nextPtr, prev);
+
+}   /* end fmDListInsertNodeEnd */
+
+
+
+
+/*****************************************************************************/
+/** fmDListInsertNodeBegin
+ * \ingroup intList
+ *
+ * \desc            Links a caller-owned node at the beginning of an
+ *                  intrusive list. No memory is allocated.
+ *
+ * \param[in]       list is a dlist initialized with ''fmDListInitIntrusive''.
+ *
+ * \param[in]       node is the node embedded in the caller's structure. It
+ *                  must not currently be linked into any list.
+ *
+ * \param[in]       data is the pointer to be stored in the node.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmDListInsertNodeBegin(fm_dlist *list, fm_dlist_node *node, void *data)
+{
+    node->data = data;
+
+    FM_DLL_INSERT_FIRST(list, head, tail, node, nextPtr, prev);
+
+}   /* end fmDListInsertNodeBegin */
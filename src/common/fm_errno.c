@@ -911,6 +911,9 @@ static const char *const fmErrorStrings[] =
     /* FM_ERR_TE_MODE */
     "This operation is invalid for the current TE mode.",
 
+    /* FM_ERR_JOURNAL_OVERFLOW */
+    "Journal overflowed, resynchronization required.",
+
 };
 
 
@@ -944,7 +947,7 @@ static const char *const fmErrorStrings[] =
  *****************************************************************************/
 const char *fmErrorMsg(fm_int err)
 {
-    if ( (err < 0) || (err >= 285) )
+    if ( (err < 0) || (err >= 286) )
     {
         return "Invalid error number (no such error)";
     }
@@ -972,7 +975,7 @@ fm_status fmErrorCode(const char *errString)
 {
     fm_int err;
 
-    for ( err = 0 ; err < 285 ; err++ )
+    for ( err = 0 ; err < 286 ; err++ )
     {
         if (strcasecmp(errString, fmErrorStrings[err]) == 0)
         {
@@ -0,0 +1,1212 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_hash_map.c
+ * Creation Date:   October 15, 2026
+ * Description:     Open-addressing hash maps, for exact-match lookups which
+ *                  do not need the key ordering of fm_tree.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+
+/**************************************************
+ * This file implements fm_hashMap, a map from 64-bit
+ * unsigned integers to arbitrary void* pointers, and
+ * fm_customHashMap, a map from void* to void* with
+ * custom hash and comparison functions.
+ *
+ * Both maps use the same implementation: a single
+ * array of slots, with robin hood linear probing.
+ * An entry never sits further from its home slot than
+ * the entries it passed on the way, which keeps
+ * probe sequences short even at a high load factor,
+ * and lets a failed lookup stop early. Removal shifts
+ * the following entries back instead of leaving
+ * tombstones. Iteration order is unspecified.
+ **************************************************/
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+#define FM_HASH_MAP_SIGNATURE       0x48A5D3C1
+
+/* Number of slots allocated on the first insertion */
+#define FM_HASH_MAP_MIN_CAPACITY    16
+
+/* The slot array doubles when it would be more than 7/8 full */
+#define FM_HASH_MAP_FULL(size, capacity)   \
+    ( (fm_uint64) (size) * 8 > (fm_uint64) (capacity) * 7 )
+
+#define FM_CHECK_SIGNATURE(...)                                         \
+    if (map->internalMap.signature != FM_HASH_MAP_SIGNATURE)            \
+    {                                                                   \
+        FM_LOG_ERROR(FM_LOG_CAT_GENERAL,                                \
+                     "Attempted to use a hash map which "               \
+                     "has not been initialized\n");                     \
+        FM_LOG_CALL_STACK(FM_LOG_CAT_GENERAL, FM_LOG_LEVEL_ERROR);      \
+        return __VA_ARGS__;                                             \
+    }
+
+/* See fm_tree.c */
+#define FM_CAST_PTR_TO_64(p)  ( (fm_uint64) (unsigned long) (p) )
+#define FM_CAST_64_TO_PTR(i)  ( (void *) (unsigned long) (i) )
+
+struct _fm_hashMapSlot
+{
+    fm_uint64 key;
+    void *    value;
+
+    /* Hash of the key, saves calls to the hash and comparison functions
+     * when moving or probing entries. */
+    fm_uint32 hash;
+
+    /* Distance from the home slot of the key plus one, 0 if empty */
+    fm_uint32 dist;
+
+};
+
+typedef struct _fm_hashMapSlot fm_hashMapSlot;
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Local function prototypes.
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+static fm_uint32 HashKey(fm_internalHashMap *map, fm_uint64 key)
+{
+    if (map->hashFunc != NULL)
+    {
+        return map->hashFunc( FM_CAST_64_TO_PTR(key) );
+    }
+
+    /* 64-bit finalizer of MurmurHash3, so that dense keys such as port
+     * numbers and glorts spread over the whole slot array. */
+    key ^= key >> 33;
+    key *= FM_LITERAL_U64(0xff51afd7ed558ccd);
+    key ^= key >> 33;
+    key *= FM_LITERAL_U64(0xc4ceb9fe1a85ec53);
+    key ^= key >> 33;
+
+    return (fm_uint32) key;
+
+}   /* end HashKey */
+
+
+
+
+static fm_bool KeysEqual(fm_internalHashMap *map, fm_uint64 x, fm_uint64 y)
+{
+    if (map->compareFunc != NULL)
+    {
+        return ( map->compareFunc( FM_CAST_64_TO_PTR(x),
+                                   FM_CAST_64_TO_PTR(y) ) == 0 );
+    }
+
+    return (x == y);
+
+}   /* end KeysEqual */
+
+
+
+
+static void MapInit(fm_internalHashMap *map,
+                    fmHashFunc          hashFunc,
+                    fmCompareFunc       compareFunc,
+                    fmAllocFunc         allocFunc,
+                    fmFreeFunc          freeFunc)
+{
+    map->customMap   = (hashFunc != NULL);
+    map->slots       = NULL;
+    map->capacity    = 0;
+    map->size        = 0;
+    map->serial      = 0;
+    map->allocFunc   = allocFunc;
+    map->freeFunc    = freeFunc;
+    map->hashFunc    = hashFunc;
+    map->compareFunc = compareFunc;
+    map->signature   = FM_HASH_MAP_SIGNATURE;
+
+}   /* end MapInit */
+
+
+
+
+/* Returns the slot holding key, or NULL if the key is not in the map */
+static fm_hashMapSlot *FindSlot(fm_internalHashMap *map, fm_uint64 key)
+{
+    fm_hashMapSlot *slot;
+    fm_uint32       hash;
+    fm_uint32       dist;
+    fm_uint         mask;
+    fm_uint         i;
+
+    if (map->size == 0)
+    {
+        return NULL;
+    }
+
+    hash = HashKey(map, key);
+    mask = map->capacity - 1;
+    i    = hash & mask;
+
+    for (dist = 1 ; ; dist++)
+    {
+        slot = &map->slots[i];
+
+        /* An empty slot, or an entry closer to its home than the key
+         * would be, means the key is not in the map. */
+        if (slot->dist < dist)
+        {
+            return NULL;
+        }
+
+        if ( (slot->hash == hash) && KeysEqual(map, slot->key, key) )
+        {
+            return slot;
+        }
+
+        i = (i + 1) & mask;
+    }
+
+}   /* end FindSlot */
+
+
+
+
+/* Places an entry known not to be in the map, which must have a free slot */
+static void PlaceEntry(fm_internalHashMap *map, fm_hashMapSlot *entry)
+{
+    fm_hashMapSlot  carry = *entry;
+    fm_hashMapSlot  tmp;
+    fm_hashMapSlot *slot;
+    fm_uint         mask  = map->capacity - 1;
+    fm_uint         i     = carry.hash & mask;
+
+    carry.dist = 1;
+
+    for ( ; ; )
+    {
+        slot = &map->slots[i];
+
+        if (slot->dist == 0)
+        {
+            *slot = carry;
+            return;
+        }
+
+        /* Take the slot from an entry closer to its home */
+        if (slot->dist < carry.dist)
+        {
+            tmp   = *slot;
+            *slot = carry;
+            carry = tmp;
+        }
+
+        i = (i + 1) & mask;
+        carry.dist++;
+    }
+
+}   /* end PlaceEntry */
+
+
+
+
+static fm_status Resize(fm_internalHashMap *map, fm_uint capacity)
+{
+    fm_hashMapSlot *oldSlots    = map->slots;
+    fm_uint         oldCapacity = map->capacity;
+    fm_hashMapSlot *slots;
+    fm_uint         i;
+
+    slots = map->allocFunc( capacity * sizeof(fm_hashMapSlot) );
+
+    if (slots == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    for (i = 0 ; i < capacity ; i++)
+    {
+        slots[i].dist = 0;
+    }
+
+    map->slots    = slots;
+    map->capacity = capacity;
+
+    for (i = 0 ; i < oldCapacity ; i++)
+    {
+        if (oldSlots[i].dist != 0)
+        {
+            PlaceEntry(map, &oldSlots[i]);
+        }
+    }
+
+    if (oldSlots != NULL)
+    {
+        map->freeFunc(oldSlots);
+    }
+
+    return FM_OK;
+
+}   /* end Resize */
+
+
+
+
+static void MapDestroy(fm_internalHashMap *map,
+                       fmFreeFunc          delFunc,
+                       fmFreePairFunc      delPairFunc)
+{
+    fm_uint i;
+
+    if ( (delFunc != NULL) || (delPairFunc != NULL) )
+    {
+        for (i = 0 ; i < map->capacity ; i++)
+        {
+            if (map->slots[i].dist == 0)
+            {
+                continue;
+            }
+
+            if (delFunc != NULL)
+            {
+                delFunc(map->slots[i].value);
+            }
+
+            if (delPairFunc != NULL)
+            {
+                delPairFunc(FM_CAST_64_TO_PTR(map->slots[i].key),
+                            map->slots[i].value);
+            }
+        }
+    }
+
+    if (map->slots != NULL)
+    {
+        map->freeFunc(map->slots);
+    }
+
+    /* this erases the signature, along with everything else */
+    FM_CLEAR(*map);
+
+}   /* end MapDestroy */
+
+
+
+
+static fm_status MapInsert(fm_internalHashMap *map,
+                           fm_uint64           key,
+                           void *              value)
+{
+    fm_hashMapSlot entry;
+    fm_status      err;
+
+    if (FindSlot(map, key) != NULL)
+    {
+        return FM_ERR_ALREADY_EXISTS;
+    }
+
+    if (map->capacity == 0)
+    {
+        err = Resize(map, FM_HASH_MAP_MIN_CAPACITY);
+    }
+    else if ( FM_HASH_MAP_FULL(map->size + 1, map->capacity) )
+    {
+        err = Resize(map, map->capacity * 2);
+    }
+    else
+    {
+        err = FM_OK;
+    }
+
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    entry.key   = key;
+    entry.value = value;
+    entry.hash  = HashKey(map, key);
+
+    PlaceEntry(map, &entry);
+
+    map->size++;
+    map->serial++;
+
+    return FM_OK;
+
+}   /* end MapInsert */
+
+
+
+
+static fm_status MapRemove(fm_internalHashMap *map,
+                           fm_uint64           key,
+                           fmFreeFunc          delFunc,
+                           fmFreePairFunc      delPairFunc)
+{
+    fm_hashMapSlot *slot;
+    fm_uint         mask;
+    fm_uint         i;
+    fm_uint         j;
+
+    slot = FindSlot(map, key);
+
+    if (slot == NULL)
+    {
+        return FM_ERR_NOT_FOUND;
+    }
+
+    if (delFunc != NULL)
+    {
+        delFunc(slot->value);
+    }
+
+    if (delPairFunc != NULL)
+    {
+        delPairFunc(FM_CAST_64_TO_PTR(slot->key), slot->value);
+    }
+
+    /* Shift the following entries of the probe sequence back by one */
+    mask = map->capacity - 1;
+    i    = slot - map->slots;
+    j    = (i + 1) & mask;
+
+    while (map->slots[j].dist > 1)
+    {
+        map->slots[i] = map->slots[j];
+        map->slots[i].dist--;
+
+        i = j;
+        j = (j + 1) & mask;
+    }
+
+    map->slots[i].dist = 0;
+
+    map->size--;
+    map->serial++;
+
+    return FM_OK;
+
+}   /* end MapRemove */
+
+
+
+
+static fm_status MapFind(fm_internalHashMap *map,
+                         fm_uint64           key,
+                         void **             value)
+{
+    fm_hashMapSlot *slot = FindSlot(map, key);
+
+    if (slot == NULL)
+    {
+        return FM_ERR_NOT_FOUND;
+    }
+
+    if (value != NULL)
+    {
+        *value = slot->value;
+    }
+
+    return FM_OK;
+
+}   /* end MapFind */
+
+
+
+
+static void MapIterInit(fm_internalHashMapIterator *it,
+                        fm_internalHashMap *        map)
+{
+    it->map    = map;
+    it->index  = 0;
+    it->serial = map->serial;
+
+}   /* end MapIterInit */
+
+
+
+
+static fm_status MapIterNext(fm_internalHashMapIterator *it,
+                             fm_uint64 *                 nextKey,
+                             void **                     nextValue)
+{
+    fm_internalHashMap *map = it->map;
+
+    if (it->serial != map->serial)
+    {
+        return FM_ERR_MODIFIED_WHILE_ITERATING;
+    }
+
+    while (it->index < map->capacity)
+    {
+        if (map->slots[it->index].dist != 0)
+        {
+            *nextKey   = map->slots[it->index].key;
+            *nextValue = map->slots[it->index].value;
+            it->index++;
+            return FM_OK;
+        }
+
+        it->index++;
+    }
+
+    return FM_ERR_NO_MORE;
+
+}   /* end MapIterNext */
+
+
+
+
+static void MapDbgDump(fm_internalHashMap *map)
+{
+    fm_uint   i;
+    fm_uint32 maxDist   = 0;
+    fm_uint64 totalDist = 0;
+
+    for (i = 0 ; i < map->capacity ; i++)
+    {
+        if (map->slots[i].dist > maxDist)
+        {
+            maxDist = map->slots[i].dist;
+        }
+
+        totalDist += map->slots[i].dist;
+    }
+
+    FM_LOG_PRINT("Hash map %p: %s, size %u, capacity %u, "
+                 "average probe %.2f, longest probe %u\n",
+                 (void *) map,
+                 map->customMap ? "Custom" : "Normal",
+                 map->size,
+                 map->capacity,
+                 (map->size > 0) ? (fm_float) totalDist / map->size : 0.0,
+                 maxDist);
+
+}   /* end MapDbgDump */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fmHashMapInit
+ * \ingroup intHashMap
+ *
+ * \desc            Initializes a user-supplied fm_hashMap structure to
+ *                  represent an empty map. No memory is allocated until
+ *                  the first insertion.
+ *
+ * \param[out]      map is the map on which to operate
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmHashMapInit(fm_hashMap *map)
+{
+    MapInit(&map->internalMap, NULL, NULL, fmAlloc, fmFree);
+
+}   /* end fmHashMapInit */
+
+
+
+
+/*****************************************************************************/
+/** fmHashMapInitWithAllocator
+ * \ingroup intHashMap
+ *
+ * \desc            Initializes a user-supplied fm_hashMap structure to
+ *                  represent an empty map.
+ *
+ * \note            allocFunc and freeFunc are only used for the slot
+ *                  array of the map. For freeing the value, see the
+ *                  "delFunc" argument of fmHashMapRemove and
+ *                  fmHashMapDestroy.
+ *
+ * \param[out]      map is the map on which to operate
+ *
+ * \param[in]       allocFunc is the function used to allocate slots
+ *
+ * \param[in]       freeFunc is the function used to deallocate slots
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmHashMapInitWithAllocator(fm_hashMap *map,
+                                fmAllocFunc allocFunc,
+                                fmFreeFunc  freeFunc)
+{
+    MapInit(&map->internalMap, NULL, NULL, allocFunc, freeFunc);
+
+}   /* end fmHashMapInitWithAllocator */
+
+
+
+
+/*****************************************************************************/
+/** fmHashMapDestroy
+ * \ingroup intHashMap
+ *
+ * \desc            Frees all space used by a map.
+ *
+ * \param[in]       map is the map on which to operate.
+ *
+ * \param[in]       delFunc is a function which is called once on each
+ *                  "value" pointer in the map, if it is not NULL.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmHashMapDestroy(fm_hashMap *map, fmFreeFunc delFunc)
+{
+    FM_CHECK_SIGNATURE();
+
+    MapDestroy(&map->internalMap, delFunc, NULL);
+
+}   /* end fmHashMapDestroy */
+
+
+
+
+/*****************************************************************************/
+/** fmHashMapClone
+ * \ingroup intHashMap
+ *
+ * \desc            Clone all the key/value pairs of the source map to a new
+ *                  one, which uses the allocator of the source map.
+ *
+ * \param[in]       srcMap is the map to clone.
+ * 
+ * \param[out]      dstMap is the new copy.
+ *
+ * \param[in]       cloneFunc is a function which is called to clone each
+ *                  value. If set to NULL, the value will be copied.
+ * 
+ * \param[in]       cloneFuncArg is the second parameter of the cloneFunc
+ *                  function.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNINITIALIZED if srcMap is not initialized.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ * \return          FM_FAIL if cloneFunc return NULL.
+ *
+ *****************************************************************************/
+fm_status fmHashMapClone(fm_hashMap *srcMap,
+                         fm_hashMap *dstMap,
+                         fmCloneFunc cloneFunc,
+                         void *      cloneFuncArg)
+{
+    fm_internalHashMap *src = &srcMap->internalMap;
+    fm_internalHashMap *dst = &dstMap->internalMap;
+    fm_status           err = FM_OK;
+    fm_uint             i;
+
+    if (src->signature != FM_HASH_MAP_SIGNATURE)
+    {
+        return FM_ERR_UNINITIALIZED;
+    }
+
+    MapInit(dst, NULL, NULL, src->allocFunc, src->freeFunc);
+
+    if (src->capacity == 0)
+    {
+        return FM_OK;
+    }
+
+    dst->slots = dst->allocFunc( src->capacity * sizeof(fm_hashMapSlot) );
+
+    if (dst->slots == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    /* Same capacity and hashes, so every entry keeps its slot */
+    dst->capacity = src->capacity;
+    dst->size     = src->size;
+
+    for (i = 0 ; i < src->capacity ; i++)
+    {
+        dst->slots[i] = src->slots[i];
+
+        if ( (src->slots[i].dist != 0) && (cloneFunc != NULL) )
+        {
+            dst->slots[i].value = cloneFunc(src->slots[i].value, cloneFuncArg);
+
+            /* NULL value equal failure */
+            if (dst->slots[i].value == NULL)
+            {
+                err = FM_FAIL;
+            }
+        }
+    }
+
+    return err;
+
+}   /* end fmHashMapClone */
+
+
+
+
+/*****************************************************************************/
+/** fmHashMapSize
+ * \ingroup intHashMap
+ *
+ * \desc            Returns the number of items in the map.
+ *
+ * \param[in]       map is the map on which to operate.
+ *
+ * \return          the number of items in the map.
+ *
+ *****************************************************************************/
+fm_uint fmHashMapSize(fm_hashMap *map)
+{
+    FM_CHECK_SIGNATURE(0);
+
+    return map->internalMap.size;
+
+}   /* end fmHashMapSize */
+
+
+
+
+/*****************************************************************************/
+/** fmHashMapIsInitialized
+ * \ingroup intHashMap
+ *
+ * \desc            Returns whether the map has been initialized or not.
+ *
+ * \param[in]       map is the map on which to operate.
+ *
+ * \return          TRUE or FALSE.
+ *
+ *****************************************************************************/
+fm_bool fmHashMapIsInitialized(fm_hashMap *map)
+{
+    return (map->internalMap.signature == FM_HASH_MAP_SIGNATURE);
+
+}   /* end fmHashMapIsInitialized */
+
+
+
+
+/*****************************************************************************/
+/** fmHashMapInsert
+ * \ingroup intHashMap
+ *
+ * \desc            Inserts a key/value pair into the map, if the
+ *                  key is not already present.
+ *
+ * \param[in]       map is the map on which to operate.
+ *
+ * \param[in]       key is the key to insert into the map
+ *
+ * \param[in]       value is the value to associate with the key.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_ALREADY_EXISTS if key exists in map.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ *
+ *****************************************************************************/
+fm_status fmHashMapInsert(fm_hashMap *map, fm_uint64 key, void *value)
+{
+    FM_CHECK_SIGNATURE(FM_ERR_UNINITIALIZED);
+
+    return MapInsert(&map->internalMap, key, value);
+
+}   /* end fmHashMapInsert */
+
+
+
+
+/*****************************************************************************/
+/** fmHashMapRemove
+ * \ingroup intHashMap
+ *
+ * \desc            Removes the specified key from the map.
+ *
+ * \param[in]       map is the map on which to operate.
+ *
+ * \param[in]       key is the key to remove from the map.
+ *
+ * \param[in]       delFunc is a function which (if not NULL) is called on
+ *                  the "value" pointer of the removed entry.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if key does not exist in map.
+ *
+ *****************************************************************************/
+fm_status fmHashMapRemove(fm_hashMap *map, fm_uint64 key, fmFreeFunc delFunc)
+{
+    FM_CHECK_SIGNATURE(FM_ERR_UNINITIALIZED);
+
+    return MapRemove(&map->internalMap, key, delFunc, NULL);
+
+}   /* end fmHashMapRemove */
+
+
+
+
+/*****************************************************************************/
+/** fmHashMapFind
+ * \ingroup intHashMap
+ *
+ * \desc            Finds the value associated with a given key.
+ *
+ * \param[in]       map is the map on which to operate.
+ *
+ * \param[in]       key is the key to look up.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function places the value associated with the key.
+ *                  May be NULL to only check whether the key is present.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if key does not exist in map.
+ *
+ *****************************************************************************/
+fm_status fmHashMapFind(fm_hashMap *map, fm_uint64 key, void **value)
+{
+    FM_CHECK_SIGNATURE(FM_ERR_UNINITIALIZED);
+
+    return MapFind(&map->internalMap, key, value);
+
+}   /* end fmHashMapFind */
+
+
+
+
+/*****************************************************************************/
+/** fmHashMapIterInit
+ * \ingroup intHashMap
+ *
+ * \desc            Initializes an iterator over all the entries of a map,
+ *                  in no particular order.
+ *
+ * \note            The iterator is invalidated by any insertion or
+ *                  removal, after which fmHashMapIterNext returns
+ *                  FM_ERR_MODIFIED_WHILE_ITERATING.
+ *
+ * \param[out]      it is the iterator to initialize.
+ *
+ * \param[in]       map is the map to iterate over.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmHashMapIterInit(fm_hashMapIterator *it, fm_hashMap *map)
+{
+    FM_CHECK_SIGNATURE();
+
+    MapIterInit(&it->internalIterator, &map->internalMap);
+
+}   /* end fmHashMapIterInit */
+
+
+
+
+/*****************************************************************************/
+/** fmHashMapIterNext
+ * \ingroup intHashMap
+ *
+ * \desc            Gets the next entry of a map.
+ *
+ * \param[in]       it is the iterator.
+ *
+ * \param[out]      nextKey points to caller-allocated storage where this
+ *                  function places the key of the next entry.
+ *
+ * \param[out]      nextValue points to caller-allocated storage where this
+ *                  function places the value of the next entry.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MORE if there are no more entries.
+ * \return          FM_ERR_MODIFIED_WHILE_ITERATING if the map was changed
+ *                  since the iterator was initialized.
+ *
+ *****************************************************************************/
+fm_status fmHashMapIterNext(fm_hashMapIterator *it,
+                            fm_uint64 *         nextKey,
+                            void **             nextValue)
+{
+    return MapIterNext(&it->internalIterator, nextKey, nextValue);
+
+}   /* end fmHashMapIterNext */
+
+
+
+
+/*****************************************************************************/
+/** fmHashMapDbgDump
+ * \ingroup intHashMap
+ *
+ * \desc            Prints the size, capacity and probe lengths of a map.
+ *
+ * \param[in]       map is the map on which to operate.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmHashMapDbgDump(fm_hashMap *map)
+{
+    FM_CHECK_SIGNATURE();
+
+    MapDbgDump(&map->internalMap);
+
+}   /* end fmHashMapDbgDump */
+
+
+
+
+/*****************************************************************************/
+/** fmCustomHashMapInit
+ * \ingroup intCustomHashMap
+ *
+ * \desc            Initializes a user-supplied fm_customHashMap structure
+ *                  to represent an empty map. No memory is allocated until
+ *                  the first insertion.
+ *
+ * \param[out]      map is the map on which to operate
+ *
+ * \param[in]       hashFunc is the function for hashing keys. Keys which
+ *                  compare equal must have the same hash.
+ *
+ * \param[in]       compareFunc is the function for comparing keys, which
+ *                  must return 0 for equal keys (the same comparison
+ *                  functions as for fm_customTree can be used).
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmCustomHashMapInit(fm_customHashMap *map,
+                         fmHashFunc        hashFunc,
+                         fmCompareFunc     compareFunc)
+{
+    MapInit(&map->internalMap, hashFunc, compareFunc, fmAlloc, fmFree);
+
+}   /* end fmCustomHashMapInit */
+
+
+
+
+/*****************************************************************************/
+/** fmCustomHashMapInitWithAllocator
+ * \ingroup intCustomHashMap
+ *
+ * \desc            Initializes a user-supplied fm_customHashMap structure
+ *                  to represent an empty map.
+ *
+ * \note            See the notes of ''fmHashMapInitWithAllocator''.
+ *
+ * \param[out]      map is the map on which to operate
+ *
+ * \param[in]       hashFunc is the function for hashing keys.
+ *
+ * \param[in]       compareFunc is the function for comparing keys.
+ *
+ * \param[in]       allocFunc is the function used to allocate slots
+ *
+ * \param[in]       freeFunc is the function used to deallocate slots
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmCustomHashMapInitWithAllocator(fm_customHashMap *map,
+                                      fmHashFunc        hashFunc,
+                                      fmCompareFunc     compareFunc,
+                                      fmAllocFunc       allocFunc,
+                                      fmFreeFunc        freeFunc)
+{
+    MapInit(&map->internalMap, hashFunc, compareFunc, allocFunc, freeFunc);
+
+}   /* end fmCustomHashMapInitWithAllocator */
+
+
+
+
+/*****************************************************************************/
+/** fmCustomHashMapDestroy
+ * \ingroup intCustomHashMap
+ *
+ * \desc            Frees all space used by a map.
+ *
+ * \param[in]       map is the map on which to operate.
+ *
+ * \param[in]       delFunc is a function which is called once on each pair of
+ *                  "key" and "value" pointers in the map, if it is not NULL.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmCustomHashMapDestroy(fm_customHashMap *map, fmFreePairFunc delFunc)
+{
+    FM_CHECK_SIGNATURE();
+
+    MapDestroy(&map->internalMap, NULL, delFunc);
+
+}   /* end fmCustomHashMapDestroy */
+
+
+
+
+/*****************************************************************************/
+/** fmCustomHashMapSize
+ * \ingroup intCustomHashMap
+ *
+ * \desc            Returns the number of items in the map.
+ *
+ * \param[in]       map is the map on which to operate.
+ *
+ * \return          the number of items in the map.
+ *
+ *****************************************************************************/
+fm_uint fmCustomHashMapSize(fm_customHashMap *map)
+{
+    FM_CHECK_SIGNATURE(0);
+
+    return map->internalMap.size;
+
+}   /* end fmCustomHashMapSize */
+
+
+
+
+/*****************************************************************************/
+/** fmCustomHashMapIsInitialized
+ * \ingroup intCustomHashMap
+ *
+ * \desc            Returns whether the map has been initialized or not.
+ *
+ * \param[in]       map is the map on which to operate.
+ *
+ * \return          TRUE or FALSE.
+ *
+ *****************************************************************************/
+fm_bool fmCustomHashMapIsInitialized(fm_customHashMap *map)
+{
+    return (map->internalMap.signature == FM_HASH_MAP_SIGNATURE);
+
+}   /* end fmCustomHashMapIsInitialized */
+
+
+
+
+/*****************************************************************************/
+/** fmCustomHashMapInsert
+ * \ingroup intCustomHashMap
+ *
+ * \desc            Inserts a key/value pair into the map, if the
+ *                  key is not already present.
+ *
+ * \param[in]       map is the map on which to operate.
+ *
+ * \param[in]       key is the key to insert into the map. The map keeps
+ *                  the pointer, not a copy of the key.
+ *
+ * \param[in]       value is the value to associate with the key.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_ALREADY_EXISTS if key exists in map.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ *
+ *****************************************************************************/
+fm_status fmCustomHashMapInsert(fm_customHashMap *map, void *key, void *value)
+{
+    FM_CHECK_SIGNATURE(FM_ERR_UNINITIALIZED);
+
+    return MapInsert(&map->internalMap, FM_CAST_PTR_TO_64(key), value);
+
+}   /* end fmCustomHashMapInsert */
+
+
+
+
+/*****************************************************************************/
+/** fmCustomHashMapRemove
+ * \ingroup intCustomHashMap
+ *
+ * \desc            Removes the specified key from the map.
+ *
+ * \param[in]       map is the map on which to operate.
+ *
+ * \param[in]       key is the key to remove from the map.
+ *
+ * \param[in]       delFunc is a function which (if not NULL) is called on
+ *                  the "key" and "value" pointers of the removed entry.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if key does not exist in map.
+ *
+ *****************************************************************************/
+fm_status fmCustomHashMapRemove(fm_customHashMap *map,
+                                const void *      key,
+                                fmFreePairFunc    delFunc)
+{
+    FM_CHECK_SIGNATURE(FM_ERR_UNINITIALIZED);
+
+    return MapRemove(&map->internalMap, FM_CAST_PTR_TO_64(key), NULL, delFunc);
+
+}   /* end fmCustomHashMapRemove */
+
+
+
+
+/*****************************************************************************/
+/** fmCustomHashMapFind
+ * \ingroup intCustomHashMap
+ *
+ * \desc            Finds the value associated with a given key.
+ *
+ * \param[in]       map is the map on which to operate.
+ *
+ * \param[in]       key is the key to look up.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function places the value associated with the key.
+ *                  May be NULL to only check whether the key is present.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if key does not exist in map.
+ *
+ *****************************************************************************/
+fm_status fmCustomHashMapFind(fm_customHashMap *map,
+                              const void *      key,
+                              void **           value)
+{
+    FM_CHECK_SIGNATURE(FM_ERR_UNINITIALIZED);
+
+    return MapFind(&map->internalMap, FM_CAST_PTR_TO_64(key), value);
+
+}   /* end fmCustomHashMapFind */
+
+
+
+
+/*****************************************************************************/
+/** fmCustomHashMapIterInit
+ * \ingroup intCustomHashMap
+ *
+ * \desc            Initializes an iterator over all the entries of a map,
+ *                  in no particular order.
+ *
+ * \note            See the notes of ''fmHashMapIterInit''.
+ *
+ * \param[out]      it is the iterator to initialize.
+ *
+ * \param[in]       map is the map to iterate over.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmCustomHashMapIterInit(fm_customHashMapIterator *it,
+                             fm_customHashMap *        map)
+{
+    FM_CHECK_SIGNATURE();
+
+    MapIterInit(&it->internalIterator, &map->internalMap);
+
+}   /* end fmCustomHashMapIterInit */
+
+
+
+
+/*****************************************************************************/
+/** fmCustomHashMapIterNext
+ * \ingroup intCustomHashMap
+ *
+ * \desc            Gets the next entry of a map.
+ *
+ * \param[in]       it is the iterator.
+ *
+ * \param[out]      nextKey points to caller-allocated storage where this
+ *                  function places the key of the next entry.
+ *
+ * \param[out]      nextValue points to caller-allocated storage where this
+ *                  function places the value of the next entry.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MORE if there are no more entries.
+ * \return          FM_ERR_MODIFIED_WHILE_ITERATING if the map was changed
+ *                  since the iterator was initialized.
+ *
+ *****************************************************************************/
+fm_status fmCustomHashMapIterNext(fm_customHashMapIterator *it,
+                                  void **                   nextKey,
+                                  void **                   nextValue)
+{
+    fm_status err;
+    fm_uint64 key;
+
+    err = MapIterNext(&it->internalIterator, &key, nextValue);
+
+    if (err == FM_OK)
+    {
+        *nextKey = FM_CAST_64_TO_PTR(key);
+    }
+
+    return err;
+
+}   /* end fmCustomHashMapIterNext */
+
+
+
+
+/*****************************************************************************/
+/** fmCustomHashMapDbgDump
+ * \ingroup intCustomHashMap
+ *
+ * \desc            Prints the size, capacity and probe lengths of a map.
+ *
+ * \param[in]       map is the map on which to operate.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmCustomHashMapDbgDump(fm_customHashMap *map)
+{
+    FM_CHECK_SIGNATURE();
+
+    MapDbgDump(&map->internalMap);
+
+}   /* end fmCustomHashMapDbgDump */
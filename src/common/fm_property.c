@@ -47,6 +47,43 @@
 
 #define TFSTR(x)      (x)?"true":"false"
 
+/* Number of slots in the property key hash index. Must be a power of two
+ * and at least twice the number of entries in propertyDescs. */
+#define PROPERTY_INDEX_SIZE     512
+
+/* Describes a property stored in fm_property. */
+#define PROP_DESC(key, type, field)                                          \
+    { key, type, FALSE, offsetof(fm_property, field), -1 }
+
+/* Describes a Boolean property that is TRUE when an integer field of
+ * fm_property holds the given value. */
+#define PROP_DESC_INT_EQ(key, field, trueValue)                              \
+    { key, FM_API_ATTR_BOOL, FALSE, offsetof(fm_property, field), trueValue }
+
+/* Describes a property stored in fm10000_property. */
+#define FM10K_PROP_DESC(key, type, field)                                    \
+    { key, type, TRUE, offsetof(fm10000_property, field), -1 }
+
+typedef struct _fm_propertyDesc
+{
+    /* Dotted property key. */
+    fm_text        key;
+
+    /* Type of the property value. */
+    fm_apiAttrType type;
+
+    /* Whether the value is stored in fm10000_property. */
+    fm_bool        fm10000;
+
+    /* Byte offset of the value within its property structure. */
+    fm_uint        offset;
+
+    /* For a Boolean view of an integer field, the field value that reads
+     * as TRUE; -1 otherwise. */
+    fm_int         trueValue;
+
+} fm_propertyDesc;
+
 
 
 /*****************************************************************************
@@ -57,6 +94,617 @@
  * Local Variables
  *****************************************************************************/
 
+/* Every property readable with fmGetApiProperty. A property handle is an
+ * index into this table. */
+static const fm_propertyDesc propertyDescs[] =
+{
+    PROP_DESC(FM_AAK_API_STP_DEF_STATE_VLAN_MEMBER,
+              FM_API_ATTR_INT,
+              defStateVlanMember),
+    PROP_DESC(FM_AAK_API_DIRECT_SEND_TO_CPU,
+              FM_API_ATTR_BOOL,
+              directSendToCpu),
+    PROP_DESC(FM_AAK_API_STP_DEF_STATE_VLAN_NON_MEMBER,
+              FM_API_ATTR_INT,
+              defStateVlanNonMember),
+    PROP_DESC(FM_AAK_DEBUG_BOOT_IDENTIFYSWITCH,
+              FM_API_ATTR_BOOL,
+              bootIdentifySw),
+    PROP_DESC(FM_AAK_DEBUG_BOOT_RESET,
+              FM_API_ATTR_BOOL,
+              bootReset),
+    PROP_DESC(FM_AAK_DEBUG_BOOT_AUTOINSERTSWITCH,
+              FM_API_ATTR_BOOL,
+              autoInsertSwitches),
+    PROP_DESC(FM_AAK_API_BOOT_RESET_TIME,
+              FM_API_ATTR_INT,
+              deviceResetTime),
+    PROP_DESC(FM_AAK_API_AUTO_ENABLE_SWAG_LINKS,
+              FM_API_ATTR_BOOL,
+              swagAutoEnableLinks),
+    PROP_DESC(FM_AAK_API_FREE_EVENT_BLOCK_THRESHOLD,
+              FM_API_ATTR_INT,
+              eventBlockThreshold),
+    PROP_DESC(FM_AAK_API_FREE_EVENT_UNBLOCK_THRESHOLD,
+              FM_API_ATTR_INT,
+              eventUnblockThreshold),
+    PROP_DESC(FM_AAK_API_EVENT_SEM_TIMEOUT,
+              FM_API_ATTR_INT,
+              eventSemTimeout),
+    PROP_DESC(FM_AAK_API_EVENT_LINK_RESERVE,
+              FM_API_ATTR_INT,
+              eventLinkReserve),
+    PROP_DESC(FM_AAK_API_EVENT_MAILBOX_RESERVE,
+              FM_API_ATTR_INT,
+              eventMailboxReserve),
+    PROP_DESC(FM_AAK_API_PACKET_RX_DIRECT_ENQUEUEING,
+              FM_API_ATTR_BOOL,
+              rxDirectEnqueueing),
+    PROP_DESC(FM_AAK_API_PACKET_RX_DRV_DEST,
+              FM_API_ATTR_INT,
+              rxDriverDestinations),
+    PROP_DESC(FM_AAK_API_ASYNC_LAG_DELETION,
+              FM_API_ATTR_BOOL,
+              lagAsyncDeletion),
+    PROP_DESC(FM_AAK_API_MA_EVENT_ON_STATIC_ADDR,
+              FM_API_ATTR_BOOL,
+              maEventOnStaticAddr),
+    PROP_DESC(FM_AAK_API_MA_EVENT_ON_DYNAMIC_ADDR,
+              FM_API_ATTR_BOOL,
+              maEventOnDynAddr),
+    PROP_DESC(FM_AAK_API_MA_EVENT_ON_ADDR_CHANGE,
+              FM_API_ATTR_BOOL,
+              maEventOnAddrChange),
+    PROP_DESC(FM_AAK_API_MA_FLUSH_ON_PORT_DOWN,
+              FM_API_ATTR_BOOL,
+              maFlushOnPortDown),
+    PROP_DESC(FM_AAK_API_MA_FLUSH_ON_VLAN_CHANGE,
+              FM_API_ATTR_BOOL,
+              maFlushOnVlanChange),
+    PROP_DESC(FM_AAK_API_MA_FLUSH_ON_LAG_CHANGE,
+              FM_API_ATTR_BOOL,
+              maFlushOnLagChange),
+    PROP_DESC(FM_AAK_API_MA_TCN_FIFO_BURST_SIZE,
+              FM_API_ATTR_INT,
+              maTcnFifoBurstSize),
+    PROP_DESC(FM_AAK_API_MA_MAINT_SLICE_ENTRIES,
+              FM_API_ATTR_INT,
+              maMaintSliceEntries),
+    PROP_DESC(FM_AAK_API_MA_MAINT_SLICE_TIME,
+              FM_API_ATTR_INT,
+              maMaintSliceTime),
+    PROP_DESC(FM_AAK_API_MA_JOURNAL_SIZE,
+              FM_API_ATTR_INT,
+              maJournalSize),
+    PROP_DESC(FM_AAK_API_INTR_POLL_BUDGET,
+              FM_API_ATTR_INT,
+              intrPollBudget),
+    PROP_DESC(FM_AAK_API_INTR_POLL_INTERVAL,
+              FM_API_ATTR_INT,
+              intrPollInterval),
+    PROP_DESC(FM_AAK_API_MAILBOX_WORKER_THREADS,
+              FM_API_ATTR_INT,
+              mailboxWorkerThreads),
+    PROP_DESC(FM_AAK_API_PER_SWITCH_TASKS,
+              FM_API_ATTR_BOOL,
+              perSwitchTasks),
+    PROP_DESC(FM_AAK_API_SWAG_INTERNAL_VLAN_STATS,
+              FM_API_ATTR_BOOL,
+              swagIntVlanStats),
+    PROP_DESC(FM_AAK_API_PER_LAG_MANAGEMENT,
+              FM_API_ATTR_BOOL,
+              perLagManagement),
+    PROP_DESC(FM_AAK_API_PARITY_REPAIR_ENABLE,
+              FM_API_ATTR_BOOL,
+              parityRepairEnable),
+    PROP_DESC(FM_AAK_API_SWAG_MAX_ACL_PORT_SETS,
+              FM_API_ATTR_INT,
+              swagMaxAclPortSets),
+    PROP_DESC(FM_AAK_API_MAX_PORT_SETS,
+              FM_API_ATTR_INT,
+              maxPortSets),
+    PROP_DESC(FM_AAK_API_PACKET_RECEIVE_ENABLE,
+              FM_API_ATTR_BOOL,
+              packetReceiveEnable),
+    PROP_DESC(FM_AAK_API_1_ADDR_PER_MCAST_GROUP,
+              FM_API_ATTR_BOOL,
+              multicastSingleAddress),
+    PROP_DESC(FM_AAK_API_PLATFORM_MODEL_POSITION,
+              FM_API_ATTR_INT,
+              modelPosition),
+    PROP_DESC(FM_AAK_API_NUM_VN_TUNNEL_NEXTHOPS,
+              FM_API_ATTR_INT,
+              vnNumNextHops),
+    PROP_DESC(FM_AAK_API_VN_ENCAP_PROTOCOL,
+              FM_API_ATTR_INT,
+              vnEncapProtocol),
+    PROP_DESC(FM_AAK_API_VN_ENCAP_VERSION,
+              FM_API_ATTR_INT,
+              vnEncapVersion),
+    PROP_DESC(FM_AAK_API_SUPPORT_ROUTE_LOOKUPS,
+              FM_API_ATTR_BOOL,
+              supportRouteLookups),
+    PROP_DESC(FM_AAK_API_ROUTING_MAINTENANCE_ENABLE,
+              FM_API_ATTR_BOOL,
+              routeMaintenanceEnable),
+    PROP_DESC(FM_AAK_API_AUTO_VLAN2_TAGGING,
+              FM_API_ATTR_BOOL,
+              autoVlan2Tagging),
+    PROP_DESC(FM_AAK_DEBUG_BOOT_INTERRUPT_HANDLER,
+              FM_API_ATTR_BOOL,
+              interruptHandlerDisable),
+    PROP_DESC(FM_AAK_API_MA_TABLE_MAINTENENANCE_ENABLE,
+              FM_API_ATTR_BOOL,
+              maTableMaintenanceEnable),
+    PROP_DESC(FM_AAK_API_FAST_MAINTENANCE_ENABLE,
+              FM_API_ATTR_BOOL,
+              fastMaintenanceEnable),
+    PROP_DESC(FM_AAK_API_FAST_MAINTENANCE_PERIOD,
+              FM_API_ATTR_INT,
+              fastMaintenancePer),
+    PROP_DESC(FM_AAK_API_STRICT_GLORT_PHYSICAL,
+              FM_API_ATTR_BOOL,
+              strictGlotPhysical),
+    PROP_DESC(FM_AAK_API_RESET_WATERMARK_AT_PAUSE_OFF,
+              FM_API_ATTR_BOOL,
+              resetWmAtPauseOff),
+    PROP_DESC(FM_AAK_API_SWAG_AUTO_SUB_SWITCHES,
+              FM_API_ATTR_BOOL,
+              swagAutoSubSwitches),
+    PROP_DESC(FM_AAK_API_SWAG_AUTO_INTERNAL_PORTS,
+              FM_API_ATTR_BOOL,
+              swagAutoIntPorts),
+    PROP_DESC(FM_AAK_API_SWAG_AUTO_VN_VSI,
+              FM_API_ATTR_BOOL,
+              swagAutoVNVsi),
+    PROP_DESC(FM_AAK_API_PLATFORM_BYPASS_ENABLE,
+              FM_API_ATTR_BOOL,
+              byPassEnable),
+    PROP_DESC(FM_AAK_API_LAG_DELETE_SEMAPHORE_TIMEOUT,
+              FM_API_ATTR_INT,
+              lagDelSemTimeout),
+    PROP_DESC(FM_AAK_API_STP_ENABLE_INTERNAL_PORT_CTRL,
+              FM_API_ATTR_BOOL,
+              stpEnIntPortCtrl),
+    PROP_DESC(FM_AAK_API_PLATFORM_MODEL_PORT_MAP_TYPE,
+              FM_API_ATTR_INT,
+              modelPortMapType),
+    PROP_DESC(FM_AAK_API_PLATFORM_MODEL_SWITCH_TYPE,
+              FM_API_ATTR_TEXT,
+              modelSwitchType),
+    PROP_DESC(FM_AAK_API_PLATFORM_MODEL_SEND_EOT,
+              FM_API_ATTR_BOOL,
+              modelSendEOT),
+    PROP_DESC(FM_AAK_API_PLATFORM_MODEL_LOG_EGRESS_INFO,
+              FM_API_ATTR_BOOL,
+              modelLogEgressInfo),
+    PROP_DESC(FM_AAK_API_PLATFORM_ENABLE_REF_CLOCK,
+              FM_API_ATTR_BOOL,
+              enableRefClock),
+    PROP_DESC(FM_AAK_API_PLATFORM_SET_REF_CLOCK,
+              FM_API_ATTR_BOOL,
+              setRefClock),
+    PROP_DESC(FM_AAK_API_PLATFORM_PRIORITY_BUFFER_QUEUES,
+              FM_API_ATTR_BOOL,
+              priorityBufQueues),
+    PROP_DESC(FM_AAK_API_PLATFORM_PKT_SCHED_TYPE,
+              FM_API_ATTR_INT,
+              pktSchedType),
+    PROP_DESC(FM_AAK_API_PLATFORM_SEPARATE_BUFFER_POOL_ENABLE,
+              FM_API_ATTR_BOOL,
+              separateBufPoolEnable),
+    PROP_DESC(FM_AAK_API_PLATFORM_NUM_BUFFERS_RX,
+              FM_API_ATTR_INT,
+              numBuffersRx),
+    PROP_DESC(FM_AAK_API_PLATFORM_NUM_BUFFERS_TX,
+              FM_API_ATTR_INT,
+              numBuffersTx),
+    PROP_DESC(FM_AAK_API_PLATFORM_MODEL_PKT_INTERFACE,
+              FM_API_ATTR_TEXT,
+              modelPktInterface),
+    PROP_DESC(FM_AAK_API_PLATFORM_PKT_INTERFACE,
+              FM_API_ATTR_TEXT,
+              pktInterface),
+    PROP_DESC(FM_AAK_API_PLATFORM_MODEL_TOPOLOGY_NAME,
+              FM_API_ATTR_TEXT,
+              modelTopologyName),
+    PROP_DESC(FM_AAK_API_PLATFORM_MODEL_TOPOLOGY_USE_MODEL_PATH,
+              FM_API_ATTR_BOOL,
+              modelUseModelPath),
+    PROP_DESC(FM_AAK_API_PLATFORM_MODEL_DEV_BOARD_IP,
+              FM_API_ATTR_TEXT,
+              modelDevBoardIp),
+    PROP_DESC(FM_AAK_API_PLATFORM_MODEL_DEV_BOARD_PORT,
+              FM_API_ATTR_INT,
+              modelDevBoardPort),
+    PROP_DESC(FM_AAK_API_PLATFORM_MODEL_DEVICE_CFG,
+              FM_API_ATTR_INT,
+              modelDeviceCfg),
+    PROP_DESC(FM_AAK_API_PLATFORM_MODEL_CHIP_VERSION,
+              FM_API_ATTR_INT,
+              modelChipVersion),
+    PROP_DESC(FM_AAK_API_PLATFORM_SBUS_SERVER_PORT,
+              FM_API_ATTR_INT,
+              sbusServerPort),
+    PROP_DESC(FM_AAK_API_PLATFORM_IS_WHITE_MODEL,
+              FM_API_ATTR_BOOL,
+              isWhiteModel),
+    PROP_DESC(FM_AAK_API_DEBUG_INIT_LOGGING_CAT,
+              FM_API_ATTR_TEXT,
+              initLoggingCat),
+    PROP_DESC(FM_AAK_API_PORT_ADD_PEPS_TO_FLOODING,
+              FM_API_ATTR_BOOL,
+              addPepsToFlooding),
+    PROP_DESC(FM_AAK_API_PORT_ALLOW_FTAG_VLAN_TAGGING,
+              FM_API_ATTR_BOOL,
+              allowFtagVlanTagging),
+    PROP_DESC_INT_EQ(FM_AAK_API_SCH_IGNORE_BW_VIOLATION,
+                     ignoreBwViolation,
+                     1),
+    PROP_DESC_INT_EQ(FM_AAK_API_SCH_IGNORE_BW_VIOLATION_NO_WARNING,
+                     ignoreBwViolation,
+                     2),
+    PROP_DESC(FM_AAK_API_DFE_ALLOW_EARLY_LINK_UP_MODE,
+              FM_API_ATTR_BOOL,
+              dfeAllowEarlyLinkUp),
+    PROP_DESC(FM_AAK_API_DFE_ALLOW_KR_PCAL_MODE,
+              FM_API_ATTR_BOOL,
+              dfeAllowKrPcal),
+    PROP_DESC(FM_AAK_API_DFE_ENABLE_SIGNALOK_DEBOUNCING,
+              FM_API_ATTR_BOOL,
+              dfeEnableSigOkDebounce),
+    PROP_DESC(FM_AAK_API_PORT_ENABLE_STATUS_POLLING,
+              FM_API_ATTR_BOOL,
+              enableStatusPolling),
+    PROP_DESC(FM_AAK_API_GSME_TIMESTAMP_MODE,
+              FM_API_ATTR_BOOL,
+              gsmeTimestampMode),
+    PROP_DESC(FM_AAK_API_MULTICAST_HNI_FLOODING,
+              FM_API_ATTR_BOOL,
+              hniMcastFlooding),
+    PROP_DESC(FM_AAK_API_MULTICAST_HNI_FLOOD_COALESCE,
+              FM_API_ATTR_INT,
+              hniMcastFloodCoalesceTime),
+    PROP_DESC(FM_AAK_API_HNI_MAC_ENTRIES_PER_PEP,
+              FM_API_ATTR_INT,
+              hniMacEntriesPerPep),
+    PROP_DESC(FM_AAK_API_HNI_MAC_ENTRIES_PER_PORT,
+              FM_API_ATTR_INT,
+              hniMacEntriesPerPort),
+    PROP_DESC(FM_AAK_API_HNI_INN_OUT_ENTRIES_PER_PEP,
+              FM_API_ATTR_INT,
+              hniInnOutEntriesPerPep),
+    PROP_DESC(FM_AAK_API_HNI_INN_OUT_ENTRIES_PER_PORT,
+              FM_API_ATTR_INT,
+              hniInnOutEntriesPerPort),
+    PROP_DESC(FM_AAK_API_AN_INHBT_TIMER_ALLOW_OUT_OF_SPEC,
+              FM_API_ATTR_BOOL,
+              anTimerAllowOutSpec),
+    PROP_DESC(FM_AAK_API_SERDES_VALIDATE,
+              FM_API_ATTR_BOOL,
+              serdesValidate),
+    PROP_DESC(FM_AAK_API_SBM_VALIDATE,
+              FM_API_ATTR_BOOL,
+              sbmasterValidate),
+    PROP_DESC(FM_AAK_API_SERDES_ACTION_IN_UP_STATE,
+              FM_API_ATTR_BOOL,
+              serdesErrActionUpState),
+    PROP_DESC(FM_AAK_API_SERDES_VALIDATE_TIMER,
+              FM_API_ATTR_INT,
+              serdesValidateTimer),
+    PROP_DESC(FM_AAK_API_HNI_FLOW_ENTRIES_VF,
+              FM_API_ATTR_INT,
+              hniFlowEntriesPerVf),
+    PROP_DESC(FM_AAK_API_CPU_PORT_XCAST_MODE,
+              FM_API_ATTR_BOOL,
+              cpuPortXCastMode),
+    PROP_DESC(FM_AAK_API_HNI_GLORTS_PER_PEP,
+              FM_API_ATTR_INT,
+              hniGlortsPerPep),
+    PROP_DESC(FM_AAK_API_PLATFORM_RAW_SOCKET_TX_BATCH,
+              FM_API_ATTR_INT,
+              rawSocketTxBatchSize),
+    PROP_DESC(FM_AAK_API_PLATFORM_RAW_SOCKET_RX_BATCH,
+              FM_API_ATTR_INT,
+              rawSocketRxBatchSize),
+    PROP_DESC(FM_AAK_API_PLATFORM_TPACKET_RX_BLOCKS,
+              FM_API_ATTR_INT,
+              tpacketRxBlockCount),
+    PROP_DESC(FM_AAK_API_PLATFORM_TPACKET_TX_FRAMES,
+              FM_API_ATTR_INT,
+              tpacketTxFrameCount),
+    PROP_DESC(FM_AAK_API_PLATFORM_TPACKET_TX_TIMESTAMPS,
+              FM_API_ATTR_BOOL,
+              tpacketTxTimestamps),
+    PROP_DESC(FM_AAK_API_PLATFORM_PKT_QUEUE_SIZE,
+              FM_API_ATTR_INT,
+              pktQueueSize),
+    PROP_DESC(FM_AAK_API_PLATFORM_BUFFER_SIZE,
+              FM_API_ATTR_INT,
+              bufferSize),
+    PROP_DESC(FM_AAK_API_PLATFORM_NUM_BUFFERS,
+              FM_API_ATTR_INT,
+              numBuffers),
+    PROP_DESC(FM_AAK_API_PLATFORM_BUFFER_HUGE_PAGES,
+              FM_API_ATTR_BOOL,
+              bufferHugePages),
+    PROP_DESC(FM_AAK_API_EVENT_RING_QUEUES,
+              FM_API_ATTR_BOOL,
+              eventRingQueues),
+    PROP_DESC(FM_AAK_API_LOCK_FAST_PATH,
+              FM_API_ATTR_BOOL,
+              lockFastPath),
+    PROP_DESC(FM_AAK_API_THREAD_PLACEMENT,
+              FM_API_ATTR_TEXT,
+              threadPlacement),
+    PROP_DESC(FM_AAK_API_REG_CACHE_SNAPSHOT_FILE,
+              FM_API_ATTR_TEXT,
+              regCacheSnapshotFile),
+    PROP_DESC(FM_AAK_API_DEBUG_BOOT_PROFILE_FILE,
+              FM_API_ATTR_TEXT,
+              bootProfileFile),
+
+#if defined(FM_SUPPORT_FM10000)
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_WMSELECT,
+                    FM_API_ATTR_TEXT,
+                    wmSelect),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_CM_RX_SMP_PRIVATE_BYTES,
+                    FM_API_ATTR_INT,
+                    cmRxSmpPrivBytes),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_CM_TX_TC_HOG_BYTES,
+                    FM_API_ATTR_INT,
+                    cmTxTcHogBytes),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_CM_SMP_SD_VS_HOG_PERCENT,
+                    FM_API_ATTR_INT,
+                    cmSmpSdVsHogPercent),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_CM_SMP_SD_JITTER_BITS,
+                    FM_API_ATTR_BOOL,
+                    cmSmpSdJitterBits),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_CM_TX_SD_ON_PRIVATE,
+                    FM_API_ATTR_BOOL,
+                    cmTxSdOnPrivate),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_CM_TX_SD_ON_SMP_FREE,
+                    FM_API_ATTR_BOOL,
+                    cmTxSdOnSmpFree),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_CM_PAUSE_BUFFER_BYTES,
+                    FM_API_ATTR_INT,
+                    cmPauseBufferBytes),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_MCAST_MAX_ENTRIES_PER_CAM,
+                    FM_API_ATTR_INT,
+                    mcastMaxEntriesPerCam),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_FFU_UNICAST_SLICE_1ST,
+                    FM_API_ATTR_INT,
+                    ffuUcastSliceRangeFirst),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_FFU_UNICAST_SLICE_LAST,
+                    FM_API_ATTR_INT,
+                    ffuUcastSliceRangeLast),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_FFU_MULTICAST_SLICE_1ST,
+                    FM_API_ATTR_INT,
+                    ffuMcastSliceRangeFirst),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_FFU_MULTICAST_SLICE_LAST,
+                    FM_API_ATTR_INT,
+                    ffuMcastSliceRangeLast),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_FFU_ACL_SLICE_1ST,
+                    FM_API_ATTR_INT,
+                    ffuAclSliceRangeFirst),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_FFU_ACL_SLICE_LAST,
+                    FM_API_ATTR_INT,
+                    ffuAclSliceRangeLast),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_FFU_MAPMAC_ROUTING,
+                    FM_API_ATTR_INT,
+                    ffuMapMacResvdForRoute),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_FFU_UNICAST_PRECEDENCE_MIN,
+                    FM_API_ATTR_INT,
+                    ffuUcastPrecedenceMin),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_FFU_UNICAST_PRECEDENCE_MAX,
+                    FM_API_ATTR_INT,
+                    ffuUcastPrecedenceMax),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_FFU_MULTICAST_PRECEDENCE_MIN,
+                    FM_API_ATTR_INT,
+                    ffuMcastPrecedenceMin),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_FFU_MULTICAST_PRECEDENCE_MAX,
+                    FM_API_ATTR_INT,
+                    ffuMcastPrecedenceMax),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_FFU_ACL_PRECEDENCE_MIN,
+                    FM_API_ATTR_INT,
+                    ffuAclPrecedenceMin),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_FFU_ACL_PRECEDENCE_MAX,
+                    FM_API_ATTR_INT,
+                    ffuAclPrecedenceMax),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_FFU_ACL_STRICT_COUNT_POLICE,
+                    FM_API_ATTR_BOOL,
+                    ffuAclStrictCountPolice),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_INIT_UCAST_FLOODING_TRIGGERS,
+                    FM_API_ATTR_BOOL,
+                    initUcastFloodTriggers),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_INIT_MCAST_FLOODING_TRIGGERS,
+                    FM_API_ATTR_BOOL,
+                    initMcastFloodTriggers),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_INIT_BCAST_FLOODING_TRIGGERS,
+                    FM_API_ATTR_BOOL,
+                    initBcastFloodTriggers),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_INIT_RESERVED_MAC_TRIGGERS,
+                    FM_API_ATTR_BOOL,
+                    initResvdMacTriggers),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_FLOODING_TRAP_PRIORITY,
+                    FM_API_ATTR_INT,
+                    floodingTrapPriority),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_AUTONEG_GENERATE_EVENTS,
+                    FM_API_ATTR_BOOL,
+                    autonegGenerateEvents),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_LINK_DEPENDS_ON_DFE,
+                    FM_API_ATTR_BOOL,
+                    linkDependsOfDfe),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_VN_USE_SHARED_ENCAP_FLOWS,
+                    FM_API_ATTR_BOOL,
+                    vnUseSharedEncapFlows),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_VN_MAX_TUNNEL_RULES,
+                    FM_API_ATTR_INT,
+                    vnMaxRemoteAddress),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_VN_TUNNEL_GROUP_HASH_SIZE,
+                    FM_API_ATTR_INT,
+                    vnTunnelGroupHashSize),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_VN_TE_VID,
+                    FM_API_ATTR_INT,
+                    vnTeVid),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_VN_ENCAP_ACL_NUM,
+                    FM_API_ATTR_INT,
+                    vnEncapAclNumber),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_VN_DECAP_ACL_NUM,
+                    FM_API_ATTR_INT,
+                    vnDecapAclNumber),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_MCAST_NUM_STACK_GROUPS,
+                    FM_API_ATTR_INT,
+                    mcastNumStackGroups),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_VN_TUNNEL_ONLY_IN_INGRESS,
+                    FM_API_ATTR_BOOL,
+                    vnTunnelOnlyOnIngress),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_MTABLE_CLEANUP_WATERMARK,
+                    FM_API_ATTR_INT,
+                    mtableCleanupWm),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_SCHED_MODE,
+                    FM_API_ATTR_TEXT,
+                    schedMode),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_UPD_SCHED_ON_LNK_CHANGE,
+                    FM_API_ATTR_BOOL,
+                    updateSchedOnLinkChange),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_CREATE_REMOTE_LOGICAL_PORTS,
+                    FM_API_ATTR_BOOL,
+                    createRemoteLogicalPorts),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_AUTONEG_CLAUSE_37_TIMEOUT,
+                    FM_API_ATTR_INT,
+                    autonegCl37Timeout),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_AUTONEG_SGMII_TIMEOUT,
+                    FM_API_ATTR_INT,
+                    autonegSgmiiTimeout),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_HNI_SERVICES_LOOPBACK,
+                    FM_API_ATTR_BOOL,
+                    useHniServicesLoopback),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_ANTI_BUBBLE_WM,
+                    FM_API_ATTR_INT,
+                    antiBubbleWm),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_SERDES_OP_MODE,
+                    FM_API_ATTR_INT,
+                    serdesOpMode),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_SERDES_DBG_LVL,
+                    FM_API_ATTR_INT,
+                    serdesDbgLevel),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_PARITY_INTERRUPTS,
+                    FM_API_ATTR_BOOL,
+                    parityEnableInterrupts),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_START_TCAM_MONITORS,
+                    FM_API_ATTR_BOOL,
+                    parityStartTcamMonitors),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_CRM_TIMEOUT,
+                    FM_API_ATTR_INT,
+                    parityCrmTimeout),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_PARITY_SWEEP_BUDGET,
+                    FM_API_ATTR_INT,
+                    paritySweepBudget),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_PARITY_COALESCE_WINDOW,
+                    FM_API_ATTR_INT,
+                    parityCoalesceWindow),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_PARITY_COALESCE_THRESHOLD,
+                    FM_API_ATTR_INT,
+                    parityCoalesceThreshold),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_PORT_INIT_THREADS,
+                    FM_API_ATTR_INT,
+                    portInitThreads),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_MA_TCN_BURST_READ,
+                    FM_API_ATTR_BOOL,
+                    maTcnBurstRead),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_MA_LEARNING_RATE_LIMIT,
+                    FM_API_ATTR_INT,
+                    maLearningRateLimit),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_MA_PORT_LEARNING_RATE_LIMIT,
+                    FM_API_ATTR_INT,
+                    maPortLearningRateLimit),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_ACL_COMPILE_THREADS,
+                    FM_API_ATTR_INT,
+                    aclCompileThreads),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_ACL_COMPILE_VALIDATE,
+                    FM_API_ATTR_BOOL,
+                    aclCompileValidate),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_INTR_LINK_POLL_TIME,
+                    FM_API_ATTR_INT,
+                    intrLinkPollTime),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_INTR_MATCN_POLL_TIME,
+                    FM_API_ATTR_INT,
+                    intrMaTcnPollTime),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_INTR_MAILBOX_POLL_TIME,
+                    FM_API_ATTR_INT,
+                    intrMailboxPollTime),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_DFE_MAX_CONCURRENT_TUNINGS,
+                    FM_API_ATTR_INT,
+                    dfeMaxConcurrentTunings),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_DFE_UPLINK_EPL_MASK,
+                    FM_API_ATTR_INT,
+                    dfeUplinkEplMask),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_DFE_ADAPTIVE_TIMEOUT,
+                    FM_API_ATTR_BOOL,
+                    dfeAdaptiveTimeout),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_MAILBOX_BATCH_REQUESTS,
+                    FM_API_ATTR_BOOL,
+                    mailboxBatchRequests),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_LAG_FAST_FAILOVER,
+                    FM_API_ATTR_BOOL,
+                    lagFastFailover),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_MTABLE_CLEANUP_BUDGET,
+                    FM_API_ATTR_INT,
+                    mtableCleanupBudget),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_MTABLE_CLEANUP_FREE_BLOCK,
+                    FM_API_ATTR_INT,
+                    mtableCleanupFreeBlock),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_SCHED_OVERSPEED,
+                    FM_API_ATTR_INT,
+                    schedOverspeed),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_INTR_LINK_IGNORE_MASK,
+                    FM_API_ATTR_INT,
+                    intrLinkIgnoreMask),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_INTR_AUTONEG_IGNORE_MASK,
+                    FM_API_ATTR_INT,
+                    intrAutonegIgnoreMask),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_INTR_SERDES_IGNORE_MASK,
+                    FM_API_ATTR_INT,
+                    intrSerdesIgnoreMask),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_INTR_PCIE_IGNORE_MASK,
+                    FM_API_ATTR_INT,
+                    intrPcieIgnoreMask),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_INTR_MATCN_IGNORE_MASK,
+                    FM_API_ATTR_INT,
+                    intrMaTcnIgnoreMask),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_INTR_FHTAIL_IGNORE_MASK,
+                    FM_API_ATTR_INT,
+                    intrFhTailIgnoreMask),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_INTR_SW_IGNORE_MASK,
+                    FM_API_ATTR_INT,
+                    intrSwIgnoreMask),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_INTR_TE_IGNORE_MASK,
+                    FM_API_ATTR_INT,
+                    intrTeIgnoreMask),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_ENABLE_EEE_SPICO_INTR,
+                    FM_API_ATTR_BOOL,
+                    enableEeeSpicoIntr),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_USE_ALTERNATE_SPICO_FW,
+                    FM_API_ATTR_BOOL,
+                    useAlternateSpicoFw),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_ALLOW_KRPCAL_ON_EEE,
+                    FM_API_ATTR_BOOL,
+                    allowKrPcalOnEee),
+    FM10K_PROP_DESC(FM_AAK_API_FM10000_REUSE_LOADED_SPICO_FW,
+                    FM_API_ATTR_BOOL,
+                    reuseLoadedSpicoFw),
+#endif
+
+};
+
+/* Open-addressing hash index of propertyDescs by key. Each slot holds a
+ * table index plus one, or zero when the slot is empty. The index depends
+ * only on the constant table, so each process builds its own copy. */
+static fm_int propertyIndex[PROPERTY_INDEX_SIZE];
+
+static pthread_once_t propertyIndexOnce = PTHREAD_ONCE_INIT;
+
 /*****************************************************************************
  * Local function prototypes.
  *****************************************************************************/
@@ -66,6 +714,210 @@
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/* HashPropertyKey
+ * \ingroup intApi
+ *
+ * \desc            Computes the FNV-1a hash of a property key.
+ *
+ * \param[in]       key is the dotted string key.
+ *
+ * \return          The hash value.
+ *
+ *****************************************************************************/
+static fm_uint32 HashPropertyKey(fm_text key)
+{
+    fm_uint32 hash = 2166136261U;
+
+    while (*key != '\0')
+    {
+        hash ^= (fm_byte) *key++;
+        hash *= 16777619U;
+    }
+
+    return hash;
+
+}   /* end HashPropertyKey */
+
+
+
+
+/*****************************************************************************/
+/* BuildPropertyIndex
+ * \ingroup intApi
+ *
+ * \desc            Builds the hash index of the property table. Called
+ *                  once per process through pthread_once.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BuildPropertyIndex(void)
+{
+    fm_uint32 slot;
+    fm_int    i;
+
+    if ( FM_NENTRIES(propertyDescs) * 2 > PROPERTY_INDEX_SIZE )
+    {
+        FM_LOG_FATAL(FM_LOG_CAT_ATTR,
+                     "PROPERTY_INDEX_SIZE is too small for %d properties\n",
+                     (fm_int) FM_NENTRIES(propertyDescs));
+        return;
+    }
+
+    for (i = 0 ; i < (fm_int) FM_NENTRIES(propertyDescs) ; i++)
+    {
+        slot = HashPropertyKey(propertyDescs[i].key) &
+               (PROPERTY_INDEX_SIZE - 1);
+
+        while (propertyIndex[slot] != 0)
+        {
+            slot = (slot + 1) & (PROPERTY_INDEX_SIZE - 1);
+        }
+
+        propertyIndex[slot] = i + 1;
+    }
+
+}   /* end BuildPropertyIndex */
+
+
+
+
+/*****************************************************************************/
+/* LookupPropertyHandle
+ * \ingroup intApi
+ *
+ * \desc            Finds the table index of a property key.
+ *
+ * \param[in]       key is the dotted string key.
+ *
+ * \return          The index into propertyDescs, or -1 if the key is
+ *                  unknown.
+ *
+ *****************************************************************************/
+static fm_int LookupPropertyHandle(fm_text key)
+{
+    fm_uint32 slot;
+    fm_int    entry;
+
+    if (key == NULL)
+    {
+        return -1;
+    }
+
+    pthread_once(&propertyIndexOnce, BuildPropertyIndex);
+
+    slot = HashPropertyKey(key) & (PROPERTY_INDEX_SIZE - 1);
+
+    while ( (entry = propertyIndex[slot]) != 0 )
+    {
+        if (strcmp(key, propertyDescs[entry - 1].key) == 0)
+        {
+            return entry - 1;
+        }
+
+        slot = (slot + 1) & (PROPERTY_INDEX_SIZE - 1);
+    }
+
+    return -1;
+
+}   /* end LookupPropertyHandle */
+
+
+
+
+/*****************************************************************************/
+/* LookupProperty
+ * \ingroup intApi
+ *
+ * \desc            Finds the descriptor of a property key.
+ *
+ * \param[in]       key is the dotted string key.
+ *
+ * \return          Pointer to the descriptor, or NULL if the key is
+ *                  unknown.
+ *
+ *****************************************************************************/
+static const fm_propertyDesc *LookupProperty(fm_text key)
+{
+    fm_int handle;
+
+    handle = LookupPropertyHandle(key);
+
+    return (handle < 0) ? NULL : &propertyDescs[handle];
+
+}   /* end LookupProperty */
+
+
+
+
+/*****************************************************************************/
+/* ReadProperty
+ * \ingroup intApi
+ *
+ * \desc            Copies the current value of a property to the caller.
+ *
+ * \param[in]       desc points to the property descriptor.
+ *
+ * \param[out]      value points to caller allocated storage of the
+ *                  property's type.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReadProperty(const fm_propertyDesc *desc, void *value)
+{
+    fm_byte *base;
+
+#if defined(FM_SUPPORT_FM10000)
+    if (desc->fm10000)
+    {
+        base = (fm_byte *) GET_FM10000_PROPERTY();
+    }
+    else
+#endif
+    {
+        base = (fm_byte *) GET_PROPERTY();
+    }
+
+    base += desc->offset;
+
+    if (desc->trueValue >= 0)
+    {
+        *(fm_bool *) value = ( *(fm_int *) base == desc->trueValue );
+        return;
+    }
+
+    switch (desc->type)
+    {
+        case FM_API_ATTR_INT:
+            *(fm_int *) value = *(fm_int *) base;
+            break;
+
+        case FM_API_ATTR_BOOL:
+            *(fm_bool *) value = *(fm_bool *) base;
+            break;
+
+        case FM_API_ATTR_FLOAT:
+            *(fm_float *) value = *(fm_float *) base;
+            break;
+
+        case FM_API_ATTR_TEXT:
+            *(fm_text *) value = (fm_text) base;
+            break;
+
+        default:
+            break;
+
+    }   /* end switch (desc->type) */
+
+}   /* end ReadProperty */
+
+
+
+
 
 /*****************************************************************************/
 /* CopyTlvStr
@@ -207,6 +1059,8 @@ fm_status fmInitializeApiProperties(void)
     prop->eventBlockThreshold = FM_AAD_API_FREE_EVENT_BLOCK_THRESHOLD;
     prop->eventUnblockThreshold = FM_AAD_API_FREE_EVENT_UNBLOCK_THRESHOLD;
     prop->eventSemTimeout = FM_AAD_API_EVENT_SEM_TIMEOUT;
+    prop->eventLinkReserve = FM_AAD_API_EVENT_LINK_RESERVE;
+    prop->eventMailboxReserve = FM_AAD_API_EVENT_MAILBOX_RESERVE;
     prop->rxDirectEnqueueing = FM_AAD_API_PACKET_RX_DIRECT_ENQUEUEING;
     prop->rxDriverDestinations = FM_AAD_API_PACKET_RX_DRV_DEST;
     prop->lagAsyncDeletion = FM_AAD_API_ASYNC_LAG_DELETION;
@@ -217,6 +1071,13 @@ fm_status fmInitializeApiProperties(void)
     prop->maFlushOnVlanChange = FM_AAD_API_MA_FLUSH_ON_VLAN_CHANGE;
     prop->maFlushOnLagChange = FM_AAD_API_MA_FLUSH_ON_LAG_CHANGE;
     prop->maTcnFifoBurstSize = FM_AAD_API_MA_TCN_FIFO_BURST_SIZE;
+    prop->maMaintSliceEntries = FM_AAD_API_MA_MAINT_SLICE_ENTRIES;
+    prop->maMaintSliceTime = FM_AAD_API_MA_MAINT_SLICE_TIME;
+    prop->maJournalSize = FM_AAD_API_MA_JOURNAL_SIZE;
+    prop->intrPollBudget = FM_AAD_API_INTR_POLL_BUDGET;
+    prop->intrPollInterval = FM_AAD_API_INTR_POLL_INTERVAL;
+    prop->mailboxWorkerThreads = FM_AAD_API_MAILBOX_WORKER_THREADS;
+    prop->perSwitchTasks = FM_AAD_API_PER_SWITCH_TASKS;
     prop->swagIntVlanStats = FM_AAD_API_SWAG_INTERNAL_VLAN_STATS;
     prop->perLagManagement = FM_AAD_API_PER_LAG_MANAGEMENT;
     prop->parityRepairEnable = FM_AAD_API_PARITY_REPAIR_ENABLE;
@@ -289,6 +1150,7 @@ fm_status fmInitializeApiProperties(void)
     prop->enableStatusPolling = FM_AAD_API_PORT_ENABLE_STATUS_POLLING;
     prop->gsmeTimestampMode = FM_AAD_API_GSME_TIMESTAMP_MODE;
     prop->hniMcastFlooding = FM_AAD_API_MULTICAST_HNI_FLOODING;
+    prop->hniMcastFloodCoalesceTime = FM_AAD_API_MULTICAST_HNI_FLOOD_COALESCE;
     prop->hniMacEntriesPerPep = FM_AAD_API_HNI_MAC_ENTRIES_PER_PEP;
     prop->hniMacEntriesPerPort = FM_AAD_API_HNI_MAC_ENTRIES_PER_PORT;
     prop->hniInnOutEntriesPerPep = FM_AAD_API_HNI_INN_OUT_ENTRIES_PER_PEP;
@@ -300,6 +1162,26 @@ fm_status fmInitializeApiProperties(void)
     prop->serdesValidateTimer = FM_AAD_API_SERDES_VALIDATE_TIMER;
     prop->hniFlowEntriesPerVf = FM_AAD_API_HNI_FLOW_ENTRIES_VF;
     prop->cpuPortXCastMode = FM_AAD_API_CPU_PORT_XCAST_MODE;
+    prop->rawSocketTxBatchSize = FM_AAD_API_PLATFORM_RAW_SOCKET_TX_BATCH;
+    prop->rawSocketRxBatchSize = FM_AAD_API_PLATFORM_RAW_SOCKET_RX_BATCH;
+    prop->tpacketRxBlockCount  = FM_AAD_API_PLATFORM_TPACKET_RX_BLOCKS;
+    prop->tpacketTxFrameCount  = FM_AAD_API_PLATFORM_TPACKET_TX_FRAMES;
+    prop->tpacketTxTimestamps  = FM_AAD_API_PLATFORM_TPACKET_TX_TIMESTAMPS;
+    prop->pktQueueSize         = FM_AAD_API_PLATFORM_PKT_QUEUE_SIZE;
+    prop->bufferSize = FM_AAD_API_PLATFORM_BUFFER_SIZE;
+    prop->numBuffers = FM_AAD_API_PLATFORM_NUM_BUFFERS;
+    prop->bufferHugePages = FM_AAD_API_PLATFORM_BUFFER_HUGE_PAGES;
+    prop->eventRingQueues = FM_AAD_API_EVENT_RING_QUEUES;
+    prop->lockFastPath = FM_AAD_API_LOCK_FAST_PATH;
+    FM_SNPRINTF_S(prop->threadPlacement,
+            sizeof(prop->threadPlacement), "%s",
+            FM_AAD_API_THREAD_PLACEMENT);
+    FM_SNPRINTF_S(prop->regCacheSnapshotFile,
+            sizeof(prop->regCacheSnapshotFile), "%s",
+            FM_AAD_API_REG_CACHE_SNAPSHOT_FILE);
+    FM_SNPRINTF_S(prop->bootProfileFile,
+            sizeof(prop->bootProfileFile), "%s",
+            FM_AAD_API_DEBUG_BOOT_PROFILE_FILE);
 
 
 #if defined(FM_SUPPORT_FM10000)
@@ -361,6 +1243,25 @@ fm_status fmInitializeApiProperties(void)
     fm10kProp->parityEnableInterrupts = FM_AAD_API_FM10000_PARITY_INTERRUPTS;
     fm10kProp->parityStartTcamMonitors = FM_AAD_API_FM10000_START_TCAM_MONITORS;
     fm10kProp->parityCrmTimeout = FM_AAD_API_FM10000_CRM_TIMEOUT;
+    fm10kProp->paritySweepBudget = FM_AAD_API_FM10000_PARITY_SWEEP_BUDGET;
+    fm10kProp->parityCoalesceWindow = FM_AAD_API_FM10000_PARITY_COALESCE_WINDOW;
+    fm10kProp->parityCoalesceThreshold = FM_AAD_API_FM10000_PARITY_COALESCE_THRESHOLD;
+    fm10kProp->portInitThreads = FM_AAD_API_FM10000_PORT_INIT_THREADS;
+    fm10kProp->maTcnBurstRead = FM_AAD_API_FM10000_MA_TCN_BURST_READ;
+    fm10kProp->maLearningRateLimit = FM_AAD_API_FM10000_MA_LEARNING_RATE_LIMIT;
+    fm10kProp->maPortLearningRateLimit = FM_AAD_API_FM10000_MA_PORT_LEARNING_RATE_LIMIT;
+    fm10kProp->aclCompileThreads = FM_AAD_API_FM10000_ACL_COMPILE_THREADS;
+    fm10kProp->aclCompileValidate = FM_AAD_API_FM10000_ACL_COMPILE_VALIDATE;
+    fm10kProp->intrLinkPollTime = FM_AAD_API_FM10000_INTR_LINK_POLL_TIME;
+    fm10kProp->intrMaTcnPollTime = FM_AAD_API_FM10000_INTR_MATCN_POLL_TIME;
+    fm10kProp->intrMailboxPollTime = FM_AAD_API_FM10000_INTR_MAILBOX_POLL_TIME;
+    fm10kProp->dfeMaxConcurrentTunings = FM_AAD_API_FM10000_DFE_MAX_CONCURRENT_TUNINGS;
+    fm10kProp->dfeUplinkEplMask = FM_AAD_API_FM10000_DFE_UPLINK_EPL_MASK;
+    fm10kProp->dfeAdaptiveTimeout = FM_AAD_API_FM10000_DFE_ADAPTIVE_TIMEOUT;
+    fm10kProp->mailboxBatchRequests = FM_AAD_API_FM10000_MAILBOX_BATCH_REQUESTS;
+    fm10kProp->lagFastFailover = FM_AAD_API_FM10000_LAG_FAST_FAILOVER;
+    fm10kProp->mtableCleanupBudget = FM_AAD_API_FM10000_MTABLE_CLEANUP_BUDGET;
+    fm10kProp->mtableCleanupFreeBlock = FM_AAD_API_FM10000_MTABLE_CLEANUP_FREE_BLOCK;
     fm10kProp->schedOverspeed = FM_AAD_API_FM10000_SCHED_OVERSPEED;
     fm10kProp->intrLinkIgnoreMask = FM_AAD_API_FM10000_INTR_LINK_IGNORE_MASK;
     fm10kProp->intrAutonegIgnoreMask = FM_AAD_API_FM10000_INTR_AUTONEG_IGNORE_MASK;
@@ -373,6 +1274,7 @@ fm_status fmInitializeApiProperties(void)
     fm10kProp->enableEeeSpicoIntr = FM_AAD_API_FM10000_ENABLE_EEE_SPICO_INTR;
     fm10kProp->useAlternateSpicoFw = FM_AAD_API_FM10000_USE_ALTERNATE_SPICO_FW;
     fm10kProp->allowKrPcalOnEee = FM_AAD_API_FM10000_ALLOW_KRPCAL_ON_EEE;
+    fm10kProp->reuseLoadedSpicoFw = FM_AAD_API_FM10000_REUSE_LOADED_SPICO_FW;
 #endif
 
     err = fmCreateLock("API Property Lock", 
@@ -451,6 +1353,12 @@ fm_status fmLoadApiPropertyTlv(fm_byte *tlv)
         case FM_TLV_API_EVENT_SEM_TIMEOUT:
             prop->eventSemTimeout = GetTlvInt(tlv + 3, tlvLen);
         break;
+        case FM_TLV_API_EVENT_LINK_RESERVE:
+            prop->eventLinkReserve = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_EVENT_MAILBOX_RESERVE:
+            prop->eventMailboxReserve = GetTlvInt(tlv + 3, tlvLen);
+        break;
         case FM_TLV_API_RX_DIRECTED_ENQ:
             prop->rxDirectEnqueueing = GetTlvBool(tlv + 3);
         break;
@@ -481,6 +1389,27 @@ fm_status fmLoadApiPropertyTlv(fm_byte *tlv)
         case FM_TLV_API_TCN_FIFO_BURST_SIZE:
             prop->maTcnFifoBurstSize = GetTlvInt(tlv + 3, tlvLen);
         break;
+        case FM_TLV_API_MA_MAINT_SLICE_ENTRIES:
+            prop->maMaintSliceEntries = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_MA_MAINT_SLICE_TIME:
+            prop->maMaintSliceTime = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_MA_JOURNAL_SIZE:
+            prop->maJournalSize = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_INTR_POLL_BUDGET:
+            prop->intrPollBudget = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_INTR_POLL_INTERVAL:
+            prop->intrPollInterval = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_MAILBOX_WORKER_THREADS:
+            prop->mailboxWorkerThreads = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_PER_SWITCH_TASKS:
+            prop->perSwitchTasks = GetTlvBool(tlv + 3);
+        break;
         case FM_TLV_API_SWAG_INT_VLAN_STATS:
             prop->swagIntVlanStats = GetTlvBool(tlv + 3);
         break;
@@ -672,6 +1601,9 @@ fm_status fmLoadApiPropertyTlv(fm_byte *tlv)
         case FM_TLV_API_MC_HNI_FLOODING:
             prop->hniMcastFlooding = GetTlvBool(tlv + 3);
         break;
+        case FM_TLV_API_MC_HNI_FLOOD_COALESCE:
+            prop->hniMcastFloodCoalesceTime = GetTlvInt(tlv + 3, tlvLen);
+        break;
         case FM_TLV_API_HNI_MAC_ENTRIES_PER_PEP:
             prop->hniMacEntriesPerPep = GetTlvInt(tlv + 3, tlvLen);
         break;
@@ -705,6 +1637,54 @@ fm_status fmLoadApiPropertyTlv(fm_byte *tlv)
         case FM_TLV_API_CPU_PORT_XCAST_MODE:
             prop->cpuPortXCastMode = GetTlvBool(tlv + 3);
         break;
+        case FM_TLV_API_PLAT_RAW_SOCK_TX_BATCH:
+            prop->rawSocketTxBatchSize = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_PLAT_RAW_SOCK_RX_BATCH:
+            prop->rawSocketRxBatchSize = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_PLAT_TPACKET_RX_BLOCKS:
+            prop->tpacketRxBlockCount = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_PLAT_TPACKET_TX_FRAMES:
+            prop->tpacketTxFrameCount = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_PLAT_TPACKET_TX_TIMESTAMPS:
+            prop->tpacketTxTimestamps = GetTlvBool(tlv + 3);
+        break;
+        case FM_TLV_API_PLAT_PKT_QUEUE_SIZE:
+            prop->pktQueueSize = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_PLAT_BUFFER_SIZE:
+            prop->bufferSize = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_PLAT_NUM_BUFFERS:
+            prop->numBuffers = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_PLAT_BUF_HUGE_PAGES:
+            prop->bufferHugePages = GetTlvBool(tlv + 3);
+        break;
+        case FM_TLV_API_EVENT_RING_QUEUES:
+            prop->eventRingQueues = GetTlvBool(tlv + 3);
+        break;
+        case FM_TLV_API_LOCK_FAST_PATH:
+            prop->lockFastPath = GetTlvBool(tlv + 3);
+        break;
+        case FM_TLV_API_THREAD_PLACEMENT:
+            CopyTlvStr(prop->threadPlacement,
+                    sizeof(prop->threadPlacement),
+                    tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_REG_CACHE_SNAPSHOT_FILE:
+            CopyTlvStr(prop->regCacheSnapshotFile,
+                    sizeof(prop->regCacheSnapshotFile),
+                    tlv + 3, tlvLen);
+        break;
+        case FM_TLV_API_DEBUG_BOOT_PROFILE_FILE:
+            CopyTlvStr(prop->bootProfileFile,
+                    sizeof(prop->bootProfileFile),
+                    tlv + 3, tlvLen);
+        break;
 
 #if defined(FM_SUPPORT_FM10000)
         case FM_TLV_FM10K_WMSELECT:
@@ -864,6 +1844,63 @@ fm_status fmLoadApiPropertyTlv(fm_byte *tlv)
         case FM_TLV_FM10K_PARITY_CRM_TIMEOUT:
             fm10kProp->parityCrmTimeout = GetTlvInt(tlv + 3, tlvLen);
         break;
+        case FM_TLV_FM10K_PARITY_SWEEP_BUDGET:
+            fm10kProp->paritySweepBudget = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_FM10K_PARITY_COALESCE_WINDOW:
+            fm10kProp->parityCoalesceWindow = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_FM10K_PARITY_COALESCE_THRESHOLD:
+            fm10kProp->parityCoalesceThreshold = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_FM10K_PORT_INIT_THREADS:
+            fm10kProp->portInitThreads = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_FM10K_MA_TCN_BURST_READ:
+            fm10kProp->maTcnBurstRead = GetTlvBool(tlv + 3);
+        break;
+        case FM_TLV_FM10K_MA_LEARNING_RATE_LIMIT:
+            fm10kProp->maLearningRateLimit = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_FM10K_MA_PORT_LEARNING_RATE_LIMIT:
+            fm10kProp->maPortLearningRateLimit = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_FM10K_ACL_COMPILE_THREADS:
+            fm10kProp->aclCompileThreads = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_FM10K_ACL_COMPILE_VALIDATE:
+            fm10kProp->aclCompileValidate = GetTlvBool(tlv + 3);
+        break;
+        case FM_TLV_FM10K_INTR_LINK_POLL_TIME:
+            fm10kProp->intrLinkPollTime = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_FM10K_INTR_MATCN_POLL_TIME:
+            fm10kProp->intrMaTcnPollTime = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_FM10K_INTR_MAILBOX_POLL_TIME:
+            fm10kProp->intrMailboxPollTime = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_FM10K_DFE_MAX_CONCURRENT_TUNINGS:
+            fm10kProp->dfeMaxConcurrentTunings = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_FM10K_DFE_UPLINK_EPL_MASK:
+            fm10kProp->dfeUplinkEplMask = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_FM10K_DFE_ADAPTIVE_TIMEOUT:
+            fm10kProp->dfeAdaptiveTimeout = GetTlvBool(tlv + 3);
+        break;
+        case FM_TLV_FM10K_MAILBOX_BATCH_REQUESTS:
+            fm10kProp->mailboxBatchRequests = GetTlvBool(tlv + 3);
+        break;
+        case FM_TLV_FM10K_LAG_FAST_FAILOVER:
+            fm10kProp->lagFastFailover = GetTlvBool(tlv + 3);
+        break;
+        case FM_TLV_FM10K_MTABLE_CLEANUP_BUDGET:
+            fm10kProp->mtableCleanupBudget = GetTlvInt(tlv + 3, tlvLen);
+        break;
+        case FM_TLV_FM10K_MTABLE_CLEANUP_FREE_BLOCK:
+            fm10kProp->mtableCleanupFreeBlock = GetTlvInt(tlv + 3, tlvLen);
+        break;
         case FM_TLV_FM10K_SCHED_OVERSPEED:
             fm10kProp->schedOverspeed = GetTlvInt(tlv + 3, tlvLen);
         break;
@@ -900,6 +1937,9 @@ fm_status fmLoadApiPropertyTlv(fm_byte *tlv)
         case FM_TLV_FM10K_ALLOW_KRPCAL_ON_EEE:
             fm10kProp->allowKrPcalOnEee = GetTlvBool(tlv + 3);
         break;
+        case FM_TLV_FM10K_REUSE_LOADED_SPICO_FW:
+            fm10kProp->reuseLoadedSpicoFw = GetTlvBool(tlv + 3);
+        break;
 #endif
 
         default:
@@ -1048,858 +2088,43 @@ fm_status fmGetApiProperty(fm_text        key,
                            fm_apiAttrType attrType,
                            void *         value)
 {
-    fm_status       err       = FM_OK;
-    fm_apiAttrType  expType   = FM_API_ATTR_MAX;
-    fm_int          valInt    = 0;
-    fm_bool         valBool   = FALSE;
-    fm_float        valFloat  = 0;
-    fm_text         valText   = NULL;
-    fm_property     *prop;
-#if defined(FM_SUPPORT_FM10000)
-    fm10000_property *fm10kProp;
-#endif
+    const fm_propertyDesc *desc;
+    fm_status              err;
 
     FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_ATTR,
                          "key=%s value=%p\n",
                          key,
                          value);
 
-    err = fmCaptureLock(&fmRootAlos->propertyLock, FM_WAIT_FOREVER);
-    if (err != FM_OK)
-    {
-        FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ATTR, err);
-    }
-
-    prop = GET_PROPERTY();
+    desc = LookupProperty(key);
 
-    if (strcmp(key, FM_AAK_API_STP_DEF_STATE_VLAN_MEMBER) == 0)
-    {
-        valInt = prop->defStateVlanMember;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_DIRECT_SEND_TO_CPU) == 0)
-    {
-        valBool = prop->directSendToCpu;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_STP_DEF_STATE_VLAN_NON_MEMBER) == 0)
-    {
-        valInt = prop->defStateVlanNonMember;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_DEBUG_BOOT_IDENTIFYSWITCH) == 0)
-    {
-        valBool = prop->bootIdentifySw;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_DEBUG_BOOT_RESET) == 0)
-    {
-        valBool = prop->bootReset;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_DEBUG_BOOT_AUTOINSERTSWITCH) == 0)
-    {
-        valBool = prop->autoInsertSwitches;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_BOOT_RESET_TIME) == 0)
-    {
-        valInt = prop->deviceResetTime;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_AUTO_ENABLE_SWAG_LINKS) == 0)
-    {
-        valBool = prop->swagAutoEnableLinks;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_FREE_EVENT_BLOCK_THRESHOLD) == 0)
-    {
-        valInt = prop->eventBlockThreshold;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_FREE_EVENT_UNBLOCK_THRESHOLD) == 0)
+    if (desc == NULL)
     {
-        valInt = prop->eventUnblockThreshold;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_EVENT_SEM_TIMEOUT) == 0)
-    {
-        valInt = prop->eventSemTimeout;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PACKET_RX_DIRECT_ENQUEUEING) == 0)
-    {
-        valBool = prop->rxDirectEnqueueing;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PACKET_RX_DRV_DEST) == 0)
-    {
-        valInt = prop->rxDriverDestinations;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_ASYNC_LAG_DELETION) == 0)
-    {
-        valBool = prop->lagAsyncDeletion;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_EVENT_ON_STATIC_ADDR) == 0)
-    {
-        valBool = prop->maEventOnStaticAddr;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_EVENT_ON_DYNAMIC_ADDR) == 0)
-    {
-        valBool = prop->maEventOnDynAddr;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_EVENT_ON_ADDR_CHANGE) == 0)
-    {
-        valBool = prop->maEventOnAddrChange;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_FLUSH_ON_PORT_DOWN) == 0)
-    {
-        valBool = prop->maFlushOnPortDown;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_FLUSH_ON_VLAN_CHANGE) == 0)
-    {
-        valBool = prop->maFlushOnVlanChange;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_FLUSH_ON_LAG_CHANGE) == 0)
-    {
-        valBool = prop->maFlushOnLagChange;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_TCN_FIFO_BURST_SIZE) == 0)
-    {
-        valInt = prop->maTcnFifoBurstSize;
-        expType = FM_API_ATTR_INT;
+        FM_LOG_FATAL(FM_LOG_CAT_ATTR,
+                     "Property %s not found\n",
+                     key);
+        FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ATTR, FM_ERR_INVALID_ARGUMENT);
     }
-    else if (strcmp(key, FM_AAK_API_SWAG_INTERNAL_VLAN_STATS) == 0)
+
+    if (attrType != desc->type)
     {
-        valBool = prop->swagIntVlanStats;
-        expType = FM_API_ATTR_BOOL;
+        FM_LOG_ERROR(FM_LOG_CAT_ATTR,
+                     "%s: Got type %d but expected %d\n",
+                     key, attrType, desc->type);
+
+        FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ATTR, FM_ERR_INVALID_ARGUMENT);
     }
-    else if (strcmp(key, FM_AAK_API_PER_LAG_MANAGEMENT) == 0)
+
+    err = fmCaptureLock(&fmRootAlos->propertyLock, FM_WAIT_FOREVER);
+    if (err != FM_OK)
     {
-        valBool = prop->perLagManagement;
-        expType = FM_API_ATTR_BOOL;
+        FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ATTR, err);
     }
-    else if (strcmp(key, FM_AAK_API_PARITY_REPAIR_ENABLE) == 0)
-    {
-        valBool = prop->parityRepairEnable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SWAG_MAX_ACL_PORT_SETS) == 0)
-    {
-        valInt = prop->swagMaxAclPortSets;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_MAX_PORT_SETS) == 0)
-    {
-        valInt = prop->maxPortSets;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PACKET_RECEIVE_ENABLE) == 0)
-    {
-        valBool = prop->packetReceiveEnable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_1_ADDR_PER_MCAST_GROUP) == 0)
-    {
-        valBool = prop->multicastSingleAddress;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_POSITION) == 0)
-    {
-        valInt = prop->modelPosition;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_NUM_VN_TUNNEL_NEXTHOPS) == 0)
-    {
-        valInt = prop->vnNumNextHops;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_VN_ENCAP_PROTOCOL) == 0)
-    {
-        valInt = prop->vnEncapProtocol;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_VN_ENCAP_VERSION) == 0)
-    {
-        valInt = prop->vnEncapVersion;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_SUPPORT_ROUTE_LOOKUPS) == 0)
-    {
-        valBool = prop->supportRouteLookups;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_ROUTING_MAINTENANCE_ENABLE) == 0)
-    {
-        valBool = prop->routeMaintenanceEnable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_AUTO_VLAN2_TAGGING) == 0)
-    {
-        valBool = prop->autoVlan2Tagging;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_DEBUG_BOOT_INTERRUPT_HANDLER) == 0)
-    {
-        valBool = prop->interruptHandlerDisable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_TABLE_MAINTENENANCE_ENABLE) == 0)
-    {
-        valBool = prop->maTableMaintenanceEnable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_FAST_MAINTENANCE_ENABLE) == 0)
-    {
-        valBool = prop->fastMaintenanceEnable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_FAST_MAINTENANCE_PERIOD) == 0)
-    {
-        valInt = prop->fastMaintenancePer;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_STRICT_GLORT_PHYSICAL) == 0)
-    {
-        valBool = prop->strictGlotPhysical;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_RESET_WATERMARK_AT_PAUSE_OFF) == 0)
-    {
-        valBool = prop->resetWmAtPauseOff;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SWAG_AUTO_SUB_SWITCHES) == 0)
-    {
-        valBool = prop->swagAutoSubSwitches;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SWAG_AUTO_INTERNAL_PORTS) == 0)
-    {
-        valBool = prop->swagAutoIntPorts;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SWAG_AUTO_VN_VSI) == 0)
-    {
-        valBool = prop->swagAutoVNVsi;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_BYPASS_ENABLE) == 0)
-    {
-        valBool = prop->byPassEnable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_LAG_DELETE_SEMAPHORE_TIMEOUT) == 0)
-    {
-        valInt = prop->lagDelSemTimeout;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_STP_ENABLE_INTERNAL_PORT_CTRL) == 0)
-    {
-        valBool = prop->stpEnIntPortCtrl;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_PORT_MAP_TYPE) == 0)
-    {
-        valInt = prop->modelPortMapType;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_SWITCH_TYPE) == 0)
-    {
-        valText = prop->modelSwitchType;
-        expType = FM_API_ATTR_TEXT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_SEND_EOT) == 0)
-    {
-        valBool = prop->modelSendEOT;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_LOG_EGRESS_INFO) == 0)
-    {
-        valBool = prop->modelLogEgressInfo;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_ENABLE_REF_CLOCK) == 0)
-    {
-        valBool = prop->enableRefClock;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_SET_REF_CLOCK) == 0)
-    {
-        valBool = prop->setRefClock;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_PRIORITY_BUFFER_QUEUES) == 0)
-    {
-        valBool = prop->priorityBufQueues;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_PKT_SCHED_TYPE) == 0)
-    {
-        valInt = prop->pktSchedType;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_SEPARATE_BUFFER_POOL_ENABLE) == 0)
-    {
-        valBool = prop->separateBufPoolEnable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_NUM_BUFFERS_RX) == 0)
-    {
-        valInt = prop->numBuffersRx;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_NUM_BUFFERS_TX) == 0)
-    {
-        valInt = prop->numBuffersTx;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_PKT_INTERFACE) == 0)
-    {
-        valText = prop->modelPktInterface;
-        expType = FM_API_ATTR_TEXT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_PKT_INTERFACE) == 0)
-    {
-        valText = prop->pktInterface;
-        expType = FM_API_ATTR_TEXT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_TOPOLOGY_NAME) == 0)
-    {
-        valText = prop->modelTopologyName;
-        expType = FM_API_ATTR_TEXT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_TOPOLOGY_USE_MODEL_PATH) == 0)
-    {
-        valBool = prop->modelUseModelPath;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_DEV_BOARD_IP) == 0)
-    {
-        valText = prop->modelDevBoardIp;
-        expType = FM_API_ATTR_TEXT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_DEV_BOARD_PORT) == 0)
-    {
-        valInt = prop->modelDevBoardPort;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_DEVICE_CFG) == 0)
-    {
-        valInt = prop->modelDeviceCfg;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_CHIP_VERSION) == 0)
-    {
-        valInt = prop->modelChipVersion;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_SBUS_SERVER_PORT) == 0)
-    {
-        valInt = prop->sbusServerPort;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_IS_WHITE_MODEL) == 0)
-    {
-        valBool = prop->isWhiteModel;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_DEBUG_INIT_LOGGING_CAT) == 0)
-    {
-        valText = prop->initLoggingCat;
-        expType = FM_API_ATTR_TEXT;
-    }
-    else if (strcmp(key, FM_AAK_API_PORT_ADD_PEPS_TO_FLOODING) == 0)
-    {
-        valBool = prop->addPepsToFlooding;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PORT_ALLOW_FTAG_VLAN_TAGGING) == 0)
-    {
-        valBool = prop->allowFtagVlanTagging;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SCH_IGNORE_BW_VIOLATION) == 0)
-    {
-        valBool = (prop->ignoreBwViolation == 1);
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SCH_IGNORE_BW_VIOLATION_NO_WARNING) == 0)
-    {
-        valBool = (prop->ignoreBwViolation == 2);
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_DFE_ALLOW_EARLY_LINK_UP_MODE) == 0)
-    {
-        valBool = prop->dfeAllowEarlyLinkUp;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_DFE_ALLOW_KR_PCAL_MODE) == 0)
-    {
-        valBool = prop->dfeAllowKrPcal;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_DFE_ENABLE_SIGNALOK_DEBOUNCING) == 0)
-    {
-        valBool = prop->dfeEnableSigOkDebounce;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PORT_ENABLE_STATUS_POLLING) == 0)
-    {
-        valBool = prop->enableStatusPolling;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_GSME_TIMESTAMP_MODE) == 0)
-    {
-        valBool = prop->gsmeTimestampMode;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MULTICAST_HNI_FLOODING) == 0)
-    {
-        valBool = prop->hniMcastFlooding;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_HNI_MAC_ENTRIES_PER_PEP) == 0)
-    {
-        valInt = prop->hniMacEntriesPerPep;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_HNI_MAC_ENTRIES_PER_PORT) == 0)
-    {
-        valInt = prop->hniMacEntriesPerPort;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_HNI_INN_OUT_ENTRIES_PER_PEP) == 0)
-    {
-        valInt = prop->hniInnOutEntriesPerPep;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_HNI_INN_OUT_ENTRIES_PER_PORT) == 0)
-    {
-        valInt = prop->hniInnOutEntriesPerPort;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_AN_INHBT_TIMER_ALLOW_OUT_OF_SPEC) == 0)
-    {
-        valBool = prop->anTimerAllowOutSpec;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SERDES_VALIDATE) == 0)
-    {
-        valBool = prop->serdesValidate;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SBM_VALIDATE) == 0)
-    {
-        valBool = prop->sbmasterValidate;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SERDES_ACTION_IN_UP_STATE) == 0)
-    {
-        valBool = prop->serdesErrActionUpState;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SERDES_VALIDATE_TIMER) == 0)
-    {
-        valInt = prop->serdesValidateTimer;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_HNI_FLOW_ENTRIES_VF) == 0)
-    {
-        valInt = prop->hniFlowEntriesPerVf;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_CPU_PORT_XCAST_MODE) == 0)
-    {
-        valBool = prop->cpuPortXCastMode;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_HNI_GLORTS_PER_PEP) == 0)
-    {
-        valInt = prop->hniGlortsPerPep;
-        expType = FM_API_ATTR_INT;
-    }
-
-
-#if defined(FM_SUPPORT_FM10000)
 
-    if (expType == FM_API_ATTR_MAX && 
-        strncmp(key, "api.FM10000.", 12) == 0)
-    {
-        fm10kProp = GET_FM10000_PROPERTY();
-
-        if (strcmp(key, FM_AAK_API_FM10000_WMSELECT) == 0)
-        {
-            valText = fm10kProp->wmSelect;
-            expType = FM_API_ATTR_TEXT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CM_RX_SMP_PRIVATE_BYTES) == 0)
-        {
-            valInt = fm10kProp->cmRxSmpPrivBytes;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CM_TX_TC_HOG_BYTES) == 0)
-        {
-            valInt = fm10kProp->cmTxTcHogBytes;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CM_SMP_SD_VS_HOG_PERCENT) == 0)
-        {
-            valInt = fm10kProp->cmSmpSdVsHogPercent;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CM_SMP_SD_JITTER_BITS) == 0)
-        {
-            valBool = fm10kProp->cmSmpSdJitterBits;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CM_TX_SD_ON_PRIVATE) == 0)
-        {
-            valBool = fm10kProp->cmTxSdOnPrivate;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CM_TX_SD_ON_SMP_FREE) == 0)
-        {
-            valBool = fm10kProp->cmTxSdOnSmpFree;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CM_PAUSE_BUFFER_BYTES) == 0)
-        {
-            valInt = fm10kProp->cmPauseBufferBytes;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_MCAST_MAX_ENTRIES_PER_CAM) == 0)
-        {
-            valInt = fm10kProp->mcastMaxEntriesPerCam;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_UNICAST_SLICE_1ST) == 0)
-        {
-            valInt = fm10kProp->ffuUcastSliceRangeFirst;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_UNICAST_SLICE_LAST) == 0)
-        {
-            valInt = fm10kProp->ffuUcastSliceRangeLast;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_MULTICAST_SLICE_1ST) == 0)
-        {
-            valInt = fm10kProp->ffuMcastSliceRangeFirst;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_MULTICAST_SLICE_LAST) == 0)
-        {
-            valInt = fm10kProp->ffuMcastSliceRangeLast;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_ACL_SLICE_1ST) == 0)
-        {
-            valInt = fm10kProp->ffuAclSliceRangeFirst;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_ACL_SLICE_LAST) == 0)
-        {
-            valInt = fm10kProp->ffuAclSliceRangeLast;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_MAPMAC_ROUTING) == 0)
-        {
-            valInt = fm10kProp->ffuMapMacResvdForRoute;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_UNICAST_PRECEDENCE_MIN) == 0)
-        {
-            valInt = fm10kProp->ffuUcastPrecedenceMin;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_UNICAST_PRECEDENCE_MAX) == 0)
-        {
-            valInt = fm10kProp->ffuUcastPrecedenceMax;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_MULTICAST_PRECEDENCE_MIN) == 0)
-        {
-            valInt = fm10kProp->ffuMcastPrecedenceMin;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_MULTICAST_PRECEDENCE_MAX) == 0)
-        {
-            valInt = fm10kProp->ffuMcastPrecedenceMax;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_ACL_PRECEDENCE_MIN) == 0)
-        {
-            valInt = fm10kProp->ffuAclPrecedenceMin;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_ACL_PRECEDENCE_MAX) == 0)
-        {
-            valInt = fm10kProp->ffuAclPrecedenceMax;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_ACL_STRICT_COUNT_POLICE) == 0)
-        {
-            valBool = fm10kProp->ffuAclStrictCountPolice;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INIT_UCAST_FLOODING_TRIGGERS) == 0)
-        {
-            valBool = fm10kProp->initUcastFloodTriggers;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INIT_MCAST_FLOODING_TRIGGERS) == 0)
-        {
-            valBool = fm10kProp->initMcastFloodTriggers;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INIT_BCAST_FLOODING_TRIGGERS) == 0)
-        {
-            valBool = fm10kProp->initBcastFloodTriggers;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INIT_RESERVED_MAC_TRIGGERS) == 0)
-        {
-            valBool = fm10kProp->initResvdMacTriggers;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FLOODING_TRAP_PRIORITY) == 0)
-        {
-            valInt = fm10kProp->floodingTrapPriority;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_AUTONEG_GENERATE_EVENTS) == 0)
-        {
-            valBool = fm10kProp->autonegGenerateEvents;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_LINK_DEPENDS_ON_DFE) == 0)
-        {
-            valBool = fm10kProp->linkDependsOfDfe;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_VN_USE_SHARED_ENCAP_FLOWS) == 0)
-        {
-            valBool = fm10kProp->vnUseSharedEncapFlows;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_VN_MAX_TUNNEL_RULES) == 0)
-        {
-            valInt = fm10kProp->vnMaxRemoteAddress;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_VN_TUNNEL_GROUP_HASH_SIZE) == 0)
-        {
-            valInt = fm10kProp->vnTunnelGroupHashSize;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_VN_TE_VID) == 0)
-        {
-            valInt = fm10kProp->vnTeVid;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_VN_ENCAP_ACL_NUM) == 0)
-        {
-            valInt = fm10kProp->vnEncapAclNumber;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_VN_DECAP_ACL_NUM) == 0)
-        {
-            valInt = fm10kProp->vnDecapAclNumber;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_MCAST_NUM_STACK_GROUPS) == 0)
-        {
-            valInt = fm10kProp->mcastNumStackGroups;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_VN_TUNNEL_ONLY_IN_INGRESS) == 0)
-        {
-            valBool = fm10kProp->vnTunnelOnlyOnIngress;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_MTABLE_CLEANUP_WATERMARK) == 0)
-        {
-            valInt = fm10kProp->mtableCleanupWm;
-            expType = FM_API_ATTR_INT;
-        }
-       else if (strcmp(key, FM_AAK_API_FM10000_SCHED_MODE) == 0)
-        {
-            valText = fm10kProp->schedMode;
-            expType = FM_API_ATTR_TEXT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_UPD_SCHED_ON_LNK_CHANGE) == 0)
-        {
-            valBool = fm10kProp->updateSchedOnLinkChange;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CREATE_REMOTE_LOGICAL_PORTS) == 0)
-        {
-            valBool = fm10kProp->createRemoteLogicalPorts;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_AUTONEG_CLAUSE_37_TIMEOUT) == 0)
-        {
-            valInt = fm10kProp->autonegCl37Timeout;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_AUTONEG_SGMII_TIMEOUT) == 0)
-        {
-            valInt = fm10kProp->autonegSgmiiTimeout;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_HNI_SERVICES_LOOPBACK) == 0)
-        {
-            valBool = fm10kProp->useHniServicesLoopback;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_ANTI_BUBBLE_WM) == 0)
-        {
-            valInt = fm10kProp->antiBubbleWm;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_SERDES_OP_MODE) == 0)
-        {
-            valInt = fm10kProp->serdesOpMode;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_SERDES_DBG_LVL) == 0)
-        {
-            valInt = fm10kProp->serdesDbgLevel;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_PARITY_INTERRUPTS) == 0)
-        {
-            valBool = fm10kProp->parityEnableInterrupts;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_START_TCAM_MONITORS) == 0)
-        {
-            valBool = fm10kProp->parityStartTcamMonitors;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CRM_TIMEOUT) == 0)
-        {
-            valBool = fm10kProp->parityCrmTimeout;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_SCHED_OVERSPEED) == 0)
-        {
-            valInt = fm10kProp->schedOverspeed;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_LINK_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrLinkIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_AUTONEG_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrAutonegIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_SERDES_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrSerdesIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_PCIE_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrPcieIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_MATCN_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrMaTcnIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_FHTAIL_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrFhTailIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_SW_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrSwIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_TE_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrTeIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_ENABLE_EEE_SPICO_INTR) == 0)
-        {
-            valBool = fm10kProp->enableEeeSpicoIntr;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_USE_ALTERNATE_SPICO_FW) == 0)
-        {
-            valBool = fm10kProp->useAlternateSpicoFw;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_ALLOW_KRPCAL_ON_EEE) == 0)
-        {
-            valBool = fm10kProp->allowKrPcalOnEee;
-            expType = FM_API_ATTR_BOOL;
-        }
-    }
-#endif
+    ReadProperty(desc, value);
 
     err = fmReleaseLock(&fmRootAlos->propertyLock);
 
-    if (expType != FM_API_ATTR_MAX)
-    {
-        if (attrType != expType)
-        {
-            FM_LOG_ERROR(FM_LOG_CAT_ATTR,
-                         "%s: Got type %d but expected %d\n",
-                         key, attrType, expType);
-        
-            FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ATTR, FM_ERR_INVALID_ARGUMENT);
-        }
-
-        switch (attrType)
-        {
-            case FM_API_ATTR_INT:
-                *(fm_int *)value = valInt;
-                break;
-
-            case FM_API_ATTR_BOOL:
-                *(fm_bool *)value = valBool;
-                break;
-
-            case FM_API_ATTR_FLOAT:
-                *(fm_float *)value = valFloat;
-                break;
-
-            case FM_API_ATTR_TEXT:
-                *(fm_text *)value = valText;
-                break;
-
-            default:
-                FM_LOG_FATAL(FM_LOG_CAT_ATTR,
-                             "Unknown type %d for get of property %s\n",
-                             attrType, key);
-
-        }   /* end switch (attrEntry->type) */
-    }
-    else
-    {
-        FM_LOG_FATAL(FM_LOG_CAT_ATTR,
-                     "Property %s not found\n",
-                     key);
-        err = FM_ERR_INVALID_ARGUMENT;
-    }
-
     FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ATTR, err);
 
 }   /* end fmGetApiProperty */
@@ -2106,6 +2331,136 @@ fm_text fmGetTextApiProperty(fm_text key, fm_text defaultValue)
 
 
 
+/*****************************************************************************/
+/** fmGetApiPropertyHandle
+ * \ingroup intApi
+ *
+ * \desc            Resolves a property key to a handle that can be passed to
+ *                  ''fmGetApiPropertyByHandle'' and its shortcuts. Handles
+ *                  are fixed for the life of the process, so hot paths can
+ *                  resolve a key once and cache the handle.
+ *
+ * \param[in]       key is the dotted string key (see ''API Properties'').
+ *
+ * \return          The property handle, or -1 if the key is unknown.
+ *
+ *****************************************************************************/
+fm_int fmGetApiPropertyHandle(fm_text key)
+{
+
+    return LookupPropertyHandle(key);
+
+}   /* end fmGetApiPropertyHandle */
+
+
+
+
+/*****************************************************************************/
+/** fmGetApiPropertyByHandle
+ * \ingroup intApi
+ *
+ * \desc            Retrieves the value of a property from its handle without
+ *                  taking the property lock. Intended for properties that
+ *                  are not changed once the API has been initialized; a text
+ *                  value may be read while it is being rewritten otherwise.
+ *
+ * \param[in]       handle is the value returned by
+ *                  ''fmGetApiPropertyHandle''.
+ *
+ * \param[in]       attrType is the expected type of the property. See
+ *                  ''fm_apiAttrType''.
+ *
+ * \param[in]       value points to caller allocated storage where the
+ *                  property's value will be stored.
+ *
+ * \return          FM_OK on success.
+ * \return          FM_ERR_INVALID_ARGUMENT if the handle is invalid or the
+ *                  property has a different type.
+ *
+ *****************************************************************************/
+fm_status fmGetApiPropertyByHandle(fm_int         handle,
+                                   fm_apiAttrType attrType,
+                                   void *         value)
+{
+
+    if ( (handle < 0) || (handle >= (fm_int) FM_NENTRIES(propertyDescs))
+        || (attrType != propertyDescs[handle].type)
+        || (value == NULL) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    ReadProperty(&propertyDescs[handle], value);
+
+    return FM_OK;
+
+}   /* end fmGetApiPropertyByHandle */
+
+
+
+
+/*****************************************************************************/
+/** fmGetIntApiPropertyByHandle
+ * \ingroup intApi
+ *
+ * \desc            Retrieves the value of an integer property from its
+ *                  handle. See ''fmGetApiPropertyByHandle''.
+ *
+ * \param[in]       handle is the value returned by
+ *                  ''fmGetApiPropertyHandle''.
+ *
+ * \param[in]       defaultValue is the value to return on an error.
+ *
+ * \return          The integer value (or the default if an error occurred).
+ *
+ *****************************************************************************/
+fm_int fmGetIntApiPropertyByHandle(fm_int handle, fm_int defaultValue)
+{
+    fm_int value;
+
+    if (fmGetApiPropertyByHandle(handle, FM_API_ATTR_INT, &value) != FM_OK)
+    {
+        return defaultValue;
+    }
+
+    return value;
+
+}   /* end fmGetIntApiPropertyByHandle */
+
+
+
+
+/*****************************************************************************/
+/** fmGetBoolApiPropertyByHandle
+ * \ingroup intApi
+ *
+ * \desc            Retrieves the value of a Boolean property from its
+ *                  handle. See ''fmGetApiPropertyByHandle''.
+ *
+ * \param[in]       handle is the value returned by
+ *                  ''fmGetApiPropertyHandle''.
+ *
+ * \param[in]       defaultValue is the value to return on an error.
+ *
+ * \return          The Boolean value (or the default if an error occurred).
+ *
+ *****************************************************************************/
+fm_bool fmGetBoolApiPropertyByHandle(fm_int handle, fm_bool defaultValue)
+{
+    fm_bool value;
+
+    if (fmGetApiPropertyByHandle(handle, FM_API_ATTR_BOOL, &value) != FM_OK)
+    {
+        return defaultValue;
+    }
+
+    return value;
+
+}   /* end fmGetBoolApiPropertyByHandle */
+
+
+
+
 /*****************************************************************************/
 /** fmDbgDumpApiProperties
  * \ingroup diagMisc
@@ -2139,6 +2494,8 @@ void fmDbgDumpApiProperties(void)
     FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FREE_EVENT_BLOCK_THRESHOLD, prop->eventBlockThreshold);
     FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FREE_EVENT_UNBLOCK_THRESHOLD, prop->eventUnblockThreshold);
     FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_EVENT_SEM_TIMEOUT, prop->eventSemTimeout);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_EVENT_LINK_RESERVE, prop->eventLinkReserve);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_EVENT_MAILBOX_RESERVE, prop->eventMailboxReserve);
     FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PACKET_RX_DIRECT_ENQUEUEING, TFSTR(prop->rxDirectEnqueueing));
     FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PACKET_RX_DRV_DEST, prop->rxDriverDestinations);
     FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_ASYNC_LAG_DELETION, TFSTR(prop->lagAsyncDeletion));
@@ -2149,6 +2506,13 @@ void fmDbgDumpApiProperties(void)
     FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_MA_FLUSH_ON_VLAN_CHANGE, TFSTR(prop->maFlushOnVlanChange));
     FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_MA_FLUSH_ON_LAG_CHANGE, TFSTR(prop->maFlushOnLagChange));
     FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_MA_TCN_FIFO_BURST_SIZE, prop->maTcnFifoBurstSize);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_MA_MAINT_SLICE_ENTRIES, prop->maMaintSliceEntries);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_MA_MAINT_SLICE_TIME, prop->maMaintSliceTime);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_MA_JOURNAL_SIZE, prop->maJournalSize);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_INTR_POLL_BUDGET, prop->intrPollBudget);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_INTR_POLL_INTERVAL, prop->intrPollInterval);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_MAILBOX_WORKER_THREADS, prop->mailboxWorkerThreads);
+    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PER_SWITCH_TASKS, TFSTR(prop->perSwitchTasks));
     FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_SWAG_INTERNAL_VLAN_STATS, TFSTR(prop->swagIntVlanStats));
     FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PER_LAG_MANAGEMENT, TFSTR(prop->perLagManagement));
     FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PARITY_REPAIR_ENABLE, TFSTR(prop->parityRepairEnable));
@@ -2209,6 +2573,7 @@ void fmDbgDumpApiProperties(void)
     FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PORT_ENABLE_STATUS_POLLING, TFSTR(prop->enableStatusPolling));
     FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_GSME_TIMESTAMP_MODE, prop->gsmeTimestampMode);
     FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_MULTICAST_HNI_FLOODING, TFSTR(prop->hniMcastFlooding));
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_MULTICAST_HNI_FLOOD_COALESCE, prop->hniMcastFloodCoalesceTime);
     FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_HNI_MAC_ENTRIES_PER_PEP, prop->hniMacEntriesPerPep);
     FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_HNI_MAC_ENTRIES_PER_PORT, prop->hniMacEntriesPerPort);
     FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_HNI_INN_OUT_ENTRIES_PER_PEP, prop->hniInnOutEntriesPerPep);
@@ -2221,6 +2586,20 @@ void fmDbgDumpApiProperties(void)
                  prop->serdesValidateTimer);
     FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_HNI_FLOW_ENTRIES_VF, prop->hniFlowEntriesPerVf);
     FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_CPU_PORT_XCAST_MODE, TFSTR(prop->cpuPortXCastMode));
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_RAW_SOCKET_TX_BATCH, prop->rawSocketTxBatchSize);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_RAW_SOCKET_RX_BATCH, prop->rawSocketRxBatchSize);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_TPACKET_RX_BLOCKS, prop->tpacketRxBlockCount);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_TPACKET_TX_FRAMES, prop->tpacketTxFrameCount);
+    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PLATFORM_TPACKET_TX_TIMESTAMPS, TFSTR(prop->tpacketTxTimestamps));
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_PKT_QUEUE_SIZE, prop->pktQueueSize);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_BUFFER_SIZE, prop->bufferSize);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_NUM_BUFFERS, prop->numBuffers);
+    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PLATFORM_BUFFER_HUGE_PAGES, TFSTR(prop->bufferHugePages));
+    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_EVENT_RING_QUEUES, TFSTR(prop->eventRingQueues));
+    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_LOCK_FAST_PATH, TFSTR(prop->lockFastPath));
+    FM_LOG_PRINT(_FORMAT_T, FM_AAK_API_THREAD_PLACEMENT, prop->threadPlacement);
+    FM_LOG_PRINT(_FORMAT_T, FM_AAK_API_REG_CACHE_SNAPSHOT_FILE, prop->regCacheSnapshotFile);
+    FM_LOG_PRINT(_FORMAT_T, FM_AAK_API_DEBUG_BOOT_PROFILE_FILE, prop->bootProfileFile);
 
 #if defined(FM_SUPPORT_FM10000)
     FM_LOG_PRINT("############################################################\n");
@@ -2279,6 +2658,25 @@ void fmDbgDumpApiProperties(void)
     FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_PARITY_INTERRUPTS, TFSTR(fm10kProp->parityEnableInterrupts));
     FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_START_TCAM_MONITORS, TFSTR(fm10kProp->parityStartTcamMonitors));
     FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_CRM_TIMEOUT, fm10kProp->parityCrmTimeout);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_PARITY_SWEEP_BUDGET, fm10kProp->paritySweepBudget);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_PARITY_COALESCE_WINDOW, fm10kProp->parityCoalesceWindow);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_PARITY_COALESCE_THRESHOLD, fm10kProp->parityCoalesceThreshold);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_PORT_INIT_THREADS, fm10kProp->portInitThreads);
+    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_MA_TCN_BURST_READ, TFSTR(fm10kProp->maTcnBurstRead));
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_MA_LEARNING_RATE_LIMIT, fm10kProp->maLearningRateLimit);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_MA_PORT_LEARNING_RATE_LIMIT, fm10kProp->maPortLearningRateLimit);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_ACL_COMPILE_THREADS, fm10kProp->aclCompileThreads);
+    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_ACL_COMPILE_VALIDATE, TFSTR(fm10kProp->aclCompileValidate));
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_INTR_LINK_POLL_TIME, fm10kProp->intrLinkPollTime);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_INTR_MATCN_POLL_TIME, fm10kProp->intrMaTcnPollTime);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_INTR_MAILBOX_POLL_TIME, fm10kProp->intrMailboxPollTime);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_DFE_MAX_CONCURRENT_TUNINGS, fm10kProp->dfeMaxConcurrentTunings);
+    FM_LOG_PRINT(_FORMAT_H, FM_AAK_API_FM10000_DFE_UPLINK_EPL_MASK, fm10kProp->dfeUplinkEplMask);
+    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_DFE_ADAPTIVE_TIMEOUT, TFSTR(fm10kProp->dfeAdaptiveTimeout));
+    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_MAILBOX_BATCH_REQUESTS, TFSTR(fm10kProp->mailboxBatchRequests));
+    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_LAG_FAST_FAILOVER, TFSTR(fm10kProp->lagFastFailover));
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_MTABLE_CLEANUP_BUDGET, fm10kProp->mtableCleanupBudget);
+    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_MTABLE_CLEANUP_FREE_BLOCK, fm10kProp->mtableCleanupFreeBlock);
     FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_SCHED_OVERSPEED, fm10kProp->schedOverspeed);
     FM_LOG_PRINT(_FORMAT_H, FM_AAK_API_FM10000_INTR_LINK_IGNORE_MASK, fm10kProp->intrLinkIgnoreMask);
     FM_LOG_PRINT(_FORMAT_H, FM_AAK_API_FM10000_INTR_AUTONEG_IGNORE_MASK, fm10kProp->intrAutonegIgnoreMask);
@@ -2291,6 +2689,7 @@ void fmDbgDumpApiProperties(void)
     FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_ENABLE_EEE_SPICO_INTR, fm10kProp->enableEeeSpicoIntr);
     FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_USE_ALTERNATE_SPICO_FW, TFSTR(fm10kProp->useAlternateSpicoFw));
     FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_ALLOW_KRPCAL_ON_EEE, TFSTR(fm10kProp->allowKrPcalOnEee));
+    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_REUSE_LOADED_SPICO_FW, TFSTR(fm10kProp->reuseLoadedSpicoFw));
 
 #endif
 
@@ -91,6 +91,12 @@ typedef struct _fm_stateMachineType
     /* default action callback */
     fm_smTransitionLogCallback  logCallback;
 
+    /* log categories used by logCallback, 0 if not known */
+    fm_uint64                   logCategories;
+
+    /* per-event coalescing group used by batched notification */
+    fm_int                     *eventGroup;
+
     /* linked list node */
     FM_DLL_DEFINE_NODE( _fm_stateMachineType, next, prev );
 
@@ -199,6 +205,15 @@ static fm_status ClearStateTransitionHistory( fm_stateMachine *sm );
 
 static fm_status SaveEventTime( fm_stateMachine *sm, fm_timestamp *ts );
 
+static fm_bool IsTransitionLogEnabled( fm_stateMachineType *type );
+
+static fm_status NotifyEvent( fm_smHandle     handle,
+                              fm_smEventInfo *eventInfo,
+                              void           *userInfo,
+                              void           *recordData );
+
+static fm_bool IsEventSuperseded( fm_smEventBatch *batch, fm_int index );
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -469,25 +484,31 @@ static fm_status StartStateMachine( fm_smHandle handle,
     sm->type     = type;
     sm->curState = initState;
 
-    /* fill out the transition record, with a pseudo-event */
-    SaveEventTime( sm, &record.eventTime );
-    record.eventInfo.smType  = type->smType;
-    record.eventInfo.eventId = FM_EVENT_UNSPECIFIED;
-    record.smUserID          = sm->smUserID;
-    record.currentState      = FM_STATE_UNSPECIFIED;
-    record.nextState         = initState;
-    record.status            = FM_OK;
-
-    recordData = fmAlloc( sm->recordDataSize );
-    if ( recordData )
-    {
-        FM_MEMSET_S( recordData, sm->recordDataSize, 0, sm->recordDataSize );
-        status = SaveTransitionRecord( sm, &record, recordData );
-        fmFree( recordData );
-    }
-    else
+    if ( sm->transitionHistorySize > 0 || IsTransitionLogEnabled( type ) )
     {
-        status = FM_ERR_NO_MEM;
+        /* fill out the transition record, with a pseudo-event */
+        SaveEventTime( sm, &record.eventTime );
+        record.eventInfo.smType  = type->smType;
+        record.eventInfo.eventId = FM_EVENT_UNSPECIFIED;
+        record.smUserID          = sm->smUserID;
+        record.currentState      = FM_STATE_UNSPECIFIED;
+        record.nextState         = initState;
+        record.status            = FM_OK;
+
+        recordData = fmAlloc( sm->recordDataSize );
+        if ( recordData )
+        {
+            FM_MEMSET_S( recordData, 
+                         sm->recordDataSize, 
+                         0, 
+                         sm->recordDataSize );
+            status = SaveTransitionRecord( sm, &record, recordData );
+            fmFree( recordData );
+        }
+        else
+        {
+            status = FM_ERR_NO_MEM;
+        }
     }
 
     /* successful if we got here */
@@ -606,9 +627,13 @@ static fm_status SaveTransitionRecord( fm_stateMachine       *sm,
         recordPtr->recordData = recordData;
     }
 
-    /* now log this transition */
+    /* now log this transition, unless nobody would see it */
     log = sm->type->logCallback;
-    if ( log != NULL )
+    if ( !IsTransitionLogEnabled( sm->type ) )
+    {
+        status = FM_OK;
+    }
+    else if ( log != NULL )
     {
         status = log( recordPtr );
     }
@@ -718,6 +743,265 @@ static fm_status SaveEventTime( fm_stateMachine *sm, fm_timestamp *ts )
 
 } /* end SaveEventTime */
 
+
+/*****************************************************************************/
+/** IsTransitionLogEnabled
+ * \ingroup intStateMachine
+ *
+ * \desc            Tells whether the transitions of a state machine type
+ *                  would currently produce any log output. Types whose log
+ *                  callback categories were never declared are assumed to
+ *                  always log.
+ *
+ * \param[in]       type is the state machine type.
+ * 
+ * \return          TRUE if the transition log callback must be called.
+ *****************************************************************************/
+static fm_bool IsTransitionLogEnabled( fm_stateMachineType *type )
+{
+    if ( type->logCallback == NULL )
+    {
+        return fmLogIsEnabled( FM_LOG_CAT_STATE_MACHINE, FM_LOG_LEVEL_DEBUG );
+    }
+
+    if ( type->logCategories == 0 )
+    {
+        return TRUE;
+    }
+
+    return fmLogIsEnabled( type->logCategories, FM_LOG_LEVEL_DEBUG );
+
+}   /* end IsTransitionLogEnabled */
+
+
+/*****************************************************************************/
+/** NotifyEvent
+ * \ingroup intStateMachine
+ *
+ * \desc            Processes one event on a state machine. Internal version
+ *                  of ''fmNotifyStateMachineEvent'', called with the
+ *                  caller's lock taken and the arguments already checked.
+ * 
+ * \param[in]       handle is the handle of the state machine.
+ * 
+ * \param[in]       eventInfo is the generic event descriptor.
+ * 
+ * \param[in]       userInfo is the purpose-specific event info.
+ * 
+ * \param[in]       recordData is the purpose-specific data saved in the
+ *                  transition record.
+ * 
+ * \return          See ''fmNotifyStateMachineEvent''.
+ *****************************************************************************/
+static fm_status NotifyEvent( fm_smHandle     handle,
+                              fm_smEventInfo *eventInfo,
+                              void           *userInfo,
+                              void           *recordData )
+{
+    fm_status                status;
+    fm_stateMachine         *sm;
+    fm_smTransitionEntry    *entry;
+    fm_smTransitionCallback  transition;
+    fm_smConditionCallback   condition;
+    fm_smTransitionRecord    record;
+    fm_int                   nextState;
+    fm_bool                  gsmeLockTaken   = FALSE;
+    fm_bool                  saveRecord;
+    fm_int                   smType;
+    fm_uint32                refValue;
+
+    FLAG_TAKE_GSME_LOCK( );
+
+    /* consistency check on the handle */
+    sm = (fm_stateMachine *)handle;
+    if ( sm == NULL || sm->smMagicNumber != STATE_MACHINE_MAGIC_NUMBER )
+    {
+        status = FM_ERR_STATE_MACHINE_HANDLE;
+        FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_STATE_MACHINE, status );
+    }
+
+
+    /* make sure there's no state machine type mismatch */
+    if ( sm->type           == NULL               || 
+         eventInfo->smType  != sm->type->smType   || 
+         eventInfo->eventId >= sm->type->nrEvents  )
+    {
+        status = FM_ERR_STATE_MACHINE_TYPE;
+        FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_STATE_MACHINE, status );
+    }
+
+    /* save the current reference value and state machine type
+       to perform a consistency check later on */
+    smType   = sm->type->smType;
+    refValue = sm->smRefValue;
+
+    /* before calling any action or condition, make sure this flag is
+     * set to its default value, which is FALSE*/
+    eventInfo->dontSaveRecord = FALSE;
+
+    /* retrieve the State Transition Table entry */
+    entry = GET_TABLE_ENTRY_PTR( sm->type->smTransitionTable, 
+                                 sm->curState,
+                                 eventInfo->eventId,
+                                 sm->type->nrEvents );
+
+    /* the transition record is only built if it is kept in the history
+       or logged, so the common case skips the timestamp entirely */
+    saveRecord = ( sm->transitionHistorySize > 0 ||
+                   IsTransitionLogEnabled( sm->type ) );
+
+    /* 
+     * Save event timestamp here. 
+     * Further processing may request another events which would be saved 
+     * with earlier time.
+     */
+    if ( saveRecord )
+    {
+        SaveEventTime( sm, &record.eventTime );
+    }
+
+    if ( entry->nextState         == FM_STATE_UNSPECIFIED && 
+         entry->conditionCallback != NULL )
+    {
+        condition = entry->conditionCallback;
+
+        /* by default, nextState is set to the current state */
+        nextState  = sm->curState;
+
+        /* drop the GSME lock to allow the callback to use other locks */
+        FLAG_DROP_GSME_LOCK();
+        status = condition( eventInfo, userInfo, &nextState );
+        FLAG_TAKE_GSME_LOCK();
+    }
+    else
+    {
+        /* retrieve the transition callback */
+        transition = entry->transitionCallback;
+
+        /* assume it'll be ok unless the transition callback
+           tell us otherwise */
+        status     = FM_OK;
+        nextState  = entry->nextState;
+
+        /* default action if the action list is empty */
+        if ( transition != NULL )
+        {
+            /* drop the GSME lock to allow the callback to use other locks */
+            FLAG_DROP_GSME_LOCK();
+            status = transition( eventInfo, userInfo );
+            FLAG_TAKE_GSME_LOCK();
+        }
+    }
+
+    /* we may have release the GSME lock temporarily, make sure the state
+       machine instance is still valid and nothing changed meanwhile */
+    if ( ( sm->smMagicNumber != STATE_MACHINE_MAGIC_NUMBER ) ||
+         ( sm->smRefValue    != refValue )                   ||
+         ( sm->type          == NULL )                       ||
+         ( sm->type->smType  != smType ) )
+    {
+        FM_LOG_DEBUG( FM_LOG_CAT_STATE_MACHINE, 
+                      "State Machine Instance modified during transition: "
+                      "sm->magicNumber=0x%08x "
+                      "sm->smRefValue=%d refValue=%d "
+                      "sm->type=%p sm->type->smType=%d smType=%d\n",
+                      sm->smMagicNumber,
+                      sm->smRefValue,
+                      refValue,
+                      (void *)sm->type,
+                      (sm->type ? sm->type->smType : -1 ),
+                      smType );
+        status = FM_OK;
+        goto ABORT;
+    }
+
+    /* make sure the next state is valid */
+    if ( nextState < 0 || nextState >= sm->type->nrStates )
+
+    {
+        status = FM_ERR_STATE_MACHINE_TYPE;
+        FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_STATE_MACHINE, status );
+    }
+
+    /* Check dontSaveRecord flag, it may been modified (set to TRUE)
+     * by an action or condition in order to not record the current
+     * transaction. Note that this flag is always restored to its
+     * default value when a new event is notified and processed */
+    if ( saveRecord && eventInfo->dontSaveRecord == FALSE )
+    {
+        /* fill out the transition record */
+        record.eventInfo    = *eventInfo;
+        record.currentState =  sm->curState;
+        record.status       =  status;
+        record.smUserID     = sm->smUserID;
+        if ( status == FM_OK )
+        {
+            record.nextState = nextState;
+        }
+        else
+        {
+            record.nextState = sm->curState;
+        }
+    
+        /* Save this transition record */
+        SaveTransitionRecord( sm, &record, recordData );
+    }
+
+    if ( status == FM_OK )
+    {
+        sm->curState = nextState;
+    }
+    
+ABORT:
+    if ( gsmeLockTaken )
+    {
+        DROP_GSME_LOCK();
+    }
+
+    return status;
+
+}   /* end NotifyEvent */
+
+
+/*****************************************************************************/
+/** IsEventSuperseded
+ * \ingroup intStateMachine
+ *
+ * \desc            Tells whether a batched event is superseded by the next
+ *                  event queued on the same state machine, that is, both
+ *                  events belong to the same coalescing group.
+ * 
+ * \param[in]       batch is the event batch.
+ * 
+ * \param[in]       index is the index of the event in the batch.
+ * 
+ * \return          TRUE if the event can be dropped.
+ *****************************************************************************/
+static fm_bool IsEventSuperseded( fm_smEventBatch *batch, fm_int index )
+{
+    fm_smBatchEvent *event;
+    fm_int           i;
+
+    event = &batch->events[index];
+
+    if ( event->group == FM_SM_COALESCE_GROUP_NONE )
+    {
+        return FALSE;
+    }
+
+    for ( i = index + 1 ; i < batch->nrEvents ; i++ )
+    {
+        if ( batch->events[i].handle == event->handle )
+        {
+            return ( batch->events[i].group == event->group );
+        }
+    }
+
+    return FALSE;
+
+}   /* end IsEventSuperseded */
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -868,6 +1152,7 @@ fm_status fmRegisterStateTransitionTable( fm_int smType,
         status = FM_ERR_NO_MEM;
         FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_STATE_MACHINE, status );
     }
+    FM_CLEAR( *type );
 
     /* allocate memory for the state transition table */
     type->smTransitionTable = 
@@ -880,6 +1165,19 @@ fm_status fmRegisterStateTransitionTable( fm_int smType,
         FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_STATE_MACHINE, status );
     }
 
+    /* no event is coalesced until a group is assigned to it */
+    type->eventGroup = (fm_int *)fmAlloc( sizeof(fm_int) * (nrEvents + 1) );
+    if ( type->eventGroup == NULL )
+    {
+        status = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_STATE_MACHINE, status );
+    }
+
+    for (j = 0 ; j < nrEvents ; j++)
+    {
+        type->eventGroup[j] = FM_SM_COALESCE_GROUP_NONE;
+    }
+
     /* fill out the state machine type structure */
     type->smType      = smType;
     type->nrStates    = nrStates;
@@ -921,6 +1219,14 @@ fm_status fmRegisterStateTransitionTable( fm_int smType,
 ABORT:
     if ( status != FM_OK && type != NULL )
     {
+        if ( type->smTransitionTable != NULL )
+        {
+            fmFree( type->smTransitionTable );
+        }
+        if ( type->eventGroup != NULL )
+        {
+            fmFree( type->eventGroup );
+        }
         fmFree( type );
     }
     if ( gsmeLockTaken )
@@ -1004,6 +1310,7 @@ fm_status fmUnregisterStateTransitionTable( fm_int  smType,
          ****************************************************/
         
         fmFree( type->smTransitionTable );
+        fmFree( type->eventGroup );
         fmFree( type );
 
         /* if we got here, we're ok */
@@ -1395,16 +1702,6 @@ fm_status fmNotifyStateMachineEvent( fm_smHandle     handle,
 {
 
     fm_status                status;
-    fm_stateMachine         *sm;
-    fm_smTransitionEntry     entry;
-    fm_smTransitionCallback  transition;
-    fm_smConditionCallback   condition;
-    fm_smTransitionRecord    record;
-    fm_int                   nextState;
-    fm_bool                  gsmeLockTaken   = FALSE;
-    fm_bool                  callerLockTaken = FALSE;
-    fm_int                   smType;
-    fm_uint32                refValue;
     fm_int                   precedence;
 
 
@@ -1437,154 +1734,365 @@ fm_status fmNotifyStateMachineEvent( fm_smHandle     handle,
         FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, FM_ERR_INVALID_ARGUMENT );
     }
 
+    TAKE_CALLER_LOCK( eventInfo );
 
-    FLAG_TAKE_CALLER_LOCK( eventInfo );
-    FLAG_TAKE_GSME_LOCK( );
+    status = NotifyEvent( handle, eventInfo, userInfo, recordData );
+
+    DROP_CALLER_LOCK( eventInfo );
+
+    FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, status );
+
+}   /* end fmNotifyStateMachineEvent */
+
+
+/*****************************************************************************/
+/** fmInitStateMachineEventBatch
+ * \ingroup intStateMachine
+ *
+ * \desc            This function initializes an empty batch of state
+ *                  machine events, to be filled with
+ *                  ''fmQueueStateMachineEvent'' and processed with
+ *                  ''fmFlushStateMachineEventBatch''
+ * 
+ * \param[out]      batch is a pointer to a caller-allocated batch
+ * 
+ * \return          FM_OK if successful
+ * 
+ * \return          FM_ERR_INVALID_ARGUMENT if batch is NULL
+ *****************************************************************************/
+fm_status fmInitStateMachineEventBatch( fm_smEventBatch *batch )
+{
+    if ( batch == NULL )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    batch->nrEvents    = 0;
+    batch->nrCoalesced = 0;
+
+    return FM_OK;
+
+}   /* end fmInitStateMachineEventBatch */
+
+
+/*****************************************************************************/
+/** fmQueueStateMachineEvent
+ * \ingroup intStateMachine
+ *
+ * \desc            This function queues an event in a batch instead of
+ *                  processing it right away as ''fmNotifyStateMachineEvent''
+ *                  does. The event info header is copied, but userInfo and
+ *                  recordData are only referenced and must remain valid
+ *                  until the batch is flushed. The batch is flushed first
+ *                  if it is full.
+ * 
+ * \param[in,out]   batch is the batch in which to queue the event
+ * 
+ * \param[in]       handle is the handle of the state machine
+ * 
+ * \param[in]       eventInfo is the generic event descriptor
+ * 
+ * \param[in]       userInfo is the purpose-specific event info
+ * 
+ * \param[in]       recordData is the purpose-specific data to be saved in
+ *                  the transition record
+ * 
+ * \return          FM_OK if successful
+ * 
+ * \return          FM_ERR_INVALID_ARGUMENT if one of the arguments is invalid
+ * 
+ * \return          FM_ERR_STATE_MACHINE_HANDLE if the specified handle does
+ *                  not correspond to a valid state machine
+ * 
+ * \return          Other status codes as returned by
+ *                  ''fmFlushStateMachineEventBatch''
+ *****************************************************************************/
+fm_status fmQueueStateMachineEvent( fm_smEventBatch *batch,
+                                    fm_smHandle      handle,
+                                    fm_smEventInfo  *eventInfo,
+                                    void            *userInfo,
+                                    void            *recordData )
+{
+    fm_status        status;
+    fm_stateMachine *sm;
+    fm_smBatchEvent *event;
+    fm_int           precedence;
+    fm_int           group;
+
+    FM_LOG_ENTRY( FM_LOG_CAT_STATE_MACHINE, 
+                  "batch=%p handle=%p eventInfo=%p\n", 
+                  (void *)batch,
+                  (void *)handle,
+                  (void *)eventInfo );
+
+    if ( smEngine.init != TRUE )
+    {
+        FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, FM_ERR_UNINITIALIZED );
+    }
+
+    if ( batch == NULL || eventInfo == NULL )
+    {
+        FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, FM_ERR_INVALID_ARGUMENT );
+    }
+
+    /* same lock restrictions as fmNotifyStateMachineEvent */
+    status = fmGetLockPrecedence( eventInfo->lock, &precedence );
+    if ( status != FM_OK )
+    {
+        FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, status );
+    }
+
+    if ( precedence == FM_LOCK_SUPER_PRECEDENCE )
+    {
+        FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, FM_ERR_INVALID_ARGUMENT );
+    }
+
+    /* retrieve the coalescing group of this event */
+    TAKE_GSME_LOCK();
 
-    /* consistency check on the handle */
     sm = (fm_stateMachine *)handle;
     if ( sm == NULL || sm->smMagicNumber != STATE_MACHINE_MAGIC_NUMBER )
     {
-        status = FM_ERR_STATE_MACHINE_HANDLE;
-        FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_STATE_MACHINE, status );
+        DROP_GSME_LOCK();
+        FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, FM_ERR_STATE_MACHINE_HANDLE );
+    }
+
+    group = FM_SM_COALESCE_GROUP_NONE;
+    if ( sm->type          != NULL                   &&
+         eventInfo->smType == sm->type->smType       &&
+         eventInfo->eventId >= 0                     &&
+         eventInfo->eventId < sm->type->nrEvents )
+    {
+        group = sm->type->eventGroup[eventInfo->eventId];
     }
 
+    DROP_GSME_LOCK();
 
-    /* make sure there's no state machine type mismatch */
-    if ( sm->type           == NULL               || 
-         eventInfo->smType  != sm->type->smType   || 
-         eventInfo->eventId >= sm->type->nrEvents  )
+    if ( batch->nrEvents >= FM_SM_MAX_BATCH_EVENTS )
     {
-        status = FM_ERR_STATE_MACHINE_TYPE;
+        status = fmFlushStateMachineEventBatch( batch );
         FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_STATE_MACHINE, status );
     }
 
-    /* save the current reference value and state machine type
-       to perform a consistency check later on */
-    smType   = sm->type->smType;
-    refValue = sm->smRefValue;
+    event = &batch->events[batch->nrEvents++];
 
-    /* before calling any action or condition, make sure this flag is
-     * set to its default value, which is FALSE*/
-    eventInfo->dontSaveRecord = FALSE;
+    event->handle     = handle;
+    event->eventInfo  = *eventInfo;
+    event->userInfo   = userInfo;
+    event->recordData = recordData;
+    event->group      = group;
 
-    /* retrieve the State Transition Table entry */
-    entry = GET_TABLE_ENTRY( sm->type->smTransitionTable, 
-                             sm->curState,
-                             eventInfo->eventId,
-                             sm->type->nrEvents );
+ABORT:
+    FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, status );
 
-    /* 
-     * Save event timestamp here. 
-     * Further processing may request another events which would be saved 
-     * with earlier time.
-     */
-    SaveEventTime( sm, &record.eventTime );
+}   /* end fmQueueStateMachineEvent */
 
-    if ( entry.nextState         == FM_STATE_UNSPECIFIED && 
-         entry.conditionCallback != NULL )
-    {
-        condition = entry.conditionCallback;
 
-        /* by default, nextState is set to the current state */
-        nextState  = sm->curState;
+/*****************************************************************************/
+/** fmFlushStateMachineEventBatch
+ * \ingroup intStateMachine
+ *
+ * \desc            This function processes the events queued in a batch, in
+ *                  queuing order, and empties the batch. Events sharing the
+ *                  same caller lock are processed in a single pass under
+ *                  that lock. An event whose next queued event on the same
+ *                  state machine belongs to the same coalescing group is
+ *                  superseded by it and dropped (see
+ *                  ''fmSetStateMachineEventCoalesceGroup'').
+ * 
+ * \param[in,out]   batch is the batch to flush
+ * 
+ * \return          FM_OK if all events were processed successfully
+ * 
+ * \return          FM_ERR_INVALID_ARGUMENT if batch is NULL
+ * 
+ * \return          The first error reported by ''fmNotifyStateMachineEvent''
+ *                  for one of the events. The remaining events are still
+ *                  processed.
+ *****************************************************************************/
+fm_status fmFlushStateMachineEventBatch( fm_smEventBatch *batch )
+{
+    fm_status        status;
+    fm_status        err;
+    fm_smBatchEvent *event;
+    fm_lock         *lockTaken;
+    fm_int           i;
 
-        /* drop the GSME lock to allow the callback to use other locks */
-        FLAG_DROP_GSME_LOCK();
-        status = condition( eventInfo, userInfo, &nextState );
-        FLAG_TAKE_GSME_LOCK();
+    FM_LOG_ENTRY( FM_LOG_CAT_STATE_MACHINE, "batch=%p\n", (void *)batch );
+
+    if ( batch == NULL )
+    {
+        FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, FM_ERR_INVALID_ARGUMENT );
     }
-    else
+
+    status    = FM_OK;
+    lockTaken = NULL;
+
+    for ( i = 0 ; i < batch->nrEvents ; i++ )
     {
-        /* retrieve the transition callback */
-        transition = entry.transitionCallback;
+        event = &batch->events[i];
 
-        /* assume it'll be ok unless the transition callback
-           tell us otherwise */
-        status     = FM_OK;
-        nextState  = entry.nextState;
+        if ( IsEventSuperseded( batch, i ) )
+        {
+            batch->nrCoalesced++;
+            continue;
+        }
 
-        /* default action if the action list is empty */
-        if ( transition != NULL )
+        if ( event->eventInfo.lock != lockTaken )
         {
-            /* drop the GSME lock to allow the callback to use other locks */
-            FLAG_DROP_GSME_LOCK();
-            status = transition( eventInfo, userInfo );
-            FLAG_TAKE_GSME_LOCK();
+            if ( lockTaken != NULL )
+            {
+                fmReleaseLock( lockTaken );
+            }
+
+            lockTaken = event->eventInfo.lock;
+            fmCaptureLock( lockTaken, FM_WAIT_FOREVER );
+        }
+
+        err = NotifyEvent( event->handle,
+                           &event->eventInfo,
+                           event->userInfo,
+                           event->recordData );
+
+        if ( status == FM_OK )
+        {
+            status = err;
         }
     }
 
-    /* we may have release the GSME lock temporarily, make sure the state
-       machine instance is still valid and nothing changed meanwhile */
-    if ( ( sm->smMagicNumber != STATE_MACHINE_MAGIC_NUMBER ) ||
-         ( sm->smRefValue    != refValue )                   ||
-         ( sm->type          == NULL )                       ||
-         ( sm->type->smType  != smType ) )
+    if ( lockTaken != NULL )
     {
-        FM_LOG_DEBUG( FM_LOG_CAT_STATE_MACHINE, 
-                      "State Machine Instance modified during transition: "
-                      "sm->magicNumber=0x%08x "
-                      "sm->smRefValue=%d refValue=%d "
-                      "sm->type=%p sm->type->smType=%d smType=%d\n",
-                      sm->smMagicNumber,
-                      sm->smRefValue,
-                      refValue,
-                      (void *)sm->type,
-                      (sm->type ? sm->type->smType : -1 ),
-                      smType );
-        status = FM_OK;
-        goto ABORT;
+        fmReleaseLock( lockTaken );
     }
 
-    /* make sure the next state is valid */
-    if ( nextState < 0 || nextState >= sm->type->nrStates )
+    batch->nrEvents = 0;
+
+    FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, status );
+
+}   /* end fmFlushStateMachineEventBatch */
+
+
+/*****************************************************************************/
+/** fmSetStateMachineEventCoalesceGroup
+ * \ingroup intStateMachine
+ *
+ * \desc            This function assigns an event of a registered state
+ *                  machine type to a coalescing group. When several events
+ *                  of the same group are queued back to back on the same
+ *                  state machine in a batch, only the last one is processed.
+ *                  This is meant for indications that report a level, such
+ *                  as signal detect toggles, where only the latest value
+ *                  matters.
+ * 
+ * \param[in]       smType is the state machine type
+ * 
+ * \param[in]       eventId is the event to assign
+ * 
+ * \param[in]       group is the coalescing group, or
+ *                  FM_SM_COALESCE_GROUP_NONE to never coalesce the event
+ * 
+ * \return          FM_OK if successful
+ * 
+ * \return          FM_ERR_INVALID_ARGUMENT if eventId is out of range
+ * 
+ * \return          FM_ERR_STATE_MACHINE_TYPE if smType is not registered
+ *****************************************************************************/
+fm_status fmSetStateMachineEventCoalesceGroup( fm_int smType,
+                                               fm_int eventId,
+                                               fm_int group )
+{
+    fm_status            status;
+    fm_stateMachineType *type;
 
+    FM_LOG_ENTRY( FM_LOG_CAT_STATE_MACHINE, 
+                  "smType=%d eventId=%d group=%d\n", 
+                  smType,
+                  eventId,
+                  group );
+
+    if ( smEngine.init != TRUE )
     {
-        status = FM_ERR_STATE_MACHINE_TYPE;
-        FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_STATE_MACHINE, status );
+        FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, FM_ERR_UNINITIALIZED );
     }
 
-    /* Check dontSaveRecord flag, it may been modified (set to TRUE)
-     * by an action or condition in order to not record the current
-     * transaction. Note that this flag is always restored to its
-     * default value when a new event is notified and processed */
-    if (eventInfo->dontSaveRecord == FALSE)
+    TAKE_GSME_LOCK();
+
+    type = SearchRegisteredStateMachineTypes( smType );
+    if ( type == NULL )
     {
-        /* fill out the transition record */
-        record.eventInfo    = *eventInfo;
-        record.currentState =  sm->curState;
-        record.status       =  status;
-        record.smUserID     = sm->smUserID;
-        if ( status == FM_OK )
-        {
-            record.nextState = nextState;
-        }
-        else
-        {
-            record.nextState = sm->curState;
-        }
-    
-        /* Save this transition record */
-        SaveTransitionRecord( sm, &record, recordData );
+        status = FM_ERR_STATE_MACHINE_TYPE;
+    }
+    else if ( eventId < 0 || eventId >= type->nrEvents )
+    {
+        status = FM_ERR_INVALID_ARGUMENT;
+    }
+    else
+    {
+        type->eventGroup[eventId] = group;
+        status = FM_OK;
     }
 
-    if ( status == FM_OK )
+    DROP_GSME_LOCK();
+
+    FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, status );
+
+}   /* end fmSetStateMachineEventCoalesceGroup */
+
+
+/*****************************************************************************/
+/** fmSetStateTransitionLogCategories
+ * \ingroup intStateMachine
+ *
+ * \desc            This function declares the log categories used by the
+ *                  transition log callback of a registered state machine
+ *                  type, at the debug level. Once declared, the callback
+ *                  is skipped, and no transition record is built for
+ *                  state machines without history, while debug logging is
+ *                  off for all of these categories.
+ * 
+ * \param[in]       smType is the state machine type
+ * 
+ * \param[in]       categories is a bitmask of log categories (see
+ *                  ''Log Categories''), or 0 to always call the callback
+ * 
+ * \return          FM_OK if successful
+ * 
+ * \return          FM_ERR_STATE_MACHINE_TYPE if smType is not registered
+ *****************************************************************************/
+fm_status fmSetStateTransitionLogCategories( fm_int    smType,
+                                             fm_uint64 categories )
+{
+    fm_status            status;
+    fm_stateMachineType *type;
+
+    FM_LOG_ENTRY( FM_LOG_CAT_STATE_MACHINE, 
+                  "smType=%d categories=0x%" FM_FORMAT_64 "x\n",
+                  smType,
+                  categories );
+
+    if ( smEngine.init != TRUE )
     {
-        sm->curState = nextState;
+        FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, FM_ERR_UNINITIALIZED );
     }
-    
-ABORT:
-    if ( gsmeLockTaken )
+
+    TAKE_GSME_LOCK();
+
+    type = SearchRegisteredStateMachineTypes( smType );
+    if ( type == NULL )
     {
-        DROP_GSME_LOCK();
+        status = FM_ERR_STATE_MACHINE_TYPE;
     }
-    if ( callerLockTaken )
+    else
     {
-        DROP_CALLER_LOCK( eventInfo );
+        type->logCategories = categories;
+        status = FM_OK;
     }
+
+    DROP_GSME_LOCK();
+
     FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, status );
 
-}   /* end fmNotifyStateMachineEvent */
+}   /* end fmSetStateTransitionLogCategories */
 
 
 /*****************************************************************************/
@@ -40,6 +40,10 @@
  * The implementation is a threaded red-black tree.
  * It is heavily based on the public-domain code
  * available at www.eternallyconfuzzled.com
+ *
+ * Trees initialized with fmTreeInitBtree or
+ * fmCustomTreeInitBtree are B+trees instead, with
+ * wide nodes and linked leaves, behind the same API.
  **************************************************/
 
 #include <fm_sdk_int.h>
@@ -112,6 +116,43 @@ struct _fm_treeNode
 
 #define FM_EMPTY_TREE_NODE  { 0, NULL, { NULL, NULL }, { FALSE, FALSE }, FALSE }
 
+/* Widest B+tree node. Leaves hold up to FM_BTREE_MAX_KEYS key/value pairs,
+ * internal nodes up to FM_BTREE_MAX_KEYS keys and one more child. Every
+ * node but the root holds at least FM_BTREE_MIN_KEYS keys. */
+#define FM_BTREE_MAX_KEYS   16
+#define FM_BTREE_MIN_KEYS   (FM_BTREE_MAX_KEYS / 2)
+
+/* With at least FM_BTREE_MIN_KEYS + 1 children per internal node, this
+ * is more levels than any tree can fill. */
+#define FM_BTREE_MAX_DEPTH  24
+
+struct _fm_btreeNode
+{
+    /* Number of keys in the node */
+    fm_int                count;
+
+    /* TRUE for a leaf, FALSE for an internal node */
+    fm_bool               leaf;
+
+    /* Keys in ascending order, kept apart from the values so that a
+     * search only touches the keys. */
+    fm_uint64             keys[FM_BTREE_MAX_KEYS];
+
+    union
+    {
+        /* Values of a leaf, values[i] goes with keys[i] */
+        void *                values[FM_BTREE_MAX_KEYS];
+
+        /* Children of an internal node */
+        struct _fm_btreeNode *child[FM_BTREE_MAX_KEYS + 1];
+
+    } u;
+
+    /* Previous and next leaf in key order, NULL for internal nodes */
+    struct _fm_btreeNode *link[2];
+
+};
+
 #define FM_TREE_SIGNATURE 0x7525F798
 
 #define FM_CHECK_SIGNATURE(...)                                         \
@@ -147,6 +188,14 @@ struct _fm_treeNode
      (c) (FM_CAST_64_TO_PTR(x),   \
           FM_CAST_64_TO_PTR(y) ) <= 0 )
 
+/* Adapts an fmCustomTreeLoadFunc to the fm_uint64 keys used internally. */
+typedef struct _fm_customTreeLoadThunk
+{
+    fmCustomTreeLoadFunc loadFunc;
+    void *               loadArg;
+
+} fm_customTreeLoadThunk;
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -159,13 +208,45 @@ struct _fm_treeNode
  * Local function prototypes.
  *****************************************************************************/
 
+static fm_status TreeInsert(fm_internalTree *tree,
+                            fm_uint64        key,
+                            void *           value,
+                            fmCompareFunc    cmp);
+
 /*****************************************************************************
  * Local Functions
  *****************************************************************************/
 
+static fm_treeNode *AllocNode(fm_internalTree *tree)
+{
+    if (tree->arena != NULL)
+    {
+        return fmArenaAlloc( tree->arena, sizeof(fm_treeNode) );
+    }
+
+    return tree->allocFunc( sizeof(fm_treeNode) );
+
+}   /* end AllocNode */
+
+
+
+
+static void FreeNode(fm_internalTree *tree, fm_treeNode *node)
+{
+    /* Arena nodes are freed along with the arena */
+    if (tree->arena == NULL)
+    {
+        tree->freeFunc(node);
+    }
+
+}   /* end FreeNode */
+
+
+
+
 static fm_treeNode *MakeNode(fm_internalTree *tree, fm_uint64 key, void *value)
 {
-    fm_treeNode *rn = tree->allocFunc(sizeof *rn);
+    fm_treeNode *rn = AllocNode(tree);
 
     if (rn != NULL)
     {
@@ -192,7 +273,7 @@ static fm_treeNode *CloneNode(fm_internalTree *srcTree,
                               void *           cloneFuncArg,
                               fm_status *      err)
 {
-    fm_treeNode *cn = srcTree->allocFunc(sizeof *cn);
+    fm_treeNode *cn = AllocNode(srcTree);
 
     if (cn != NULL)
     {
@@ -468,180 +549,1440 @@ static fm_treeNode *Next(fm_treeNode *it, fm_dir dir)
 }   /* end Next */
 
 
-#if FM_TREE_DEBUG_CALLER
-static void TreeInitCaller(fm_internalTree *tree)
+
+
+/*****************************************************************************
+ * B+tree implementation
+ *
+ * Keys and values are stored inline in wide nodes, so that a lookup touches
+ * a handful of cache lines instead of one node per level of a binary tree.
+ * All entries live in the leaves, which are linked in key order so that
+ * iteration walks them sequentially. Internal nodes only hold separator
+ * keys: child[i] holds the keys below keys[i] and not below keys[i - 1].
+ * Every separator is also a key present in the tree, which keeps custom
+ * tree comparisons away from keys the application has already freed.
+ *****************************************************************************/
+
+static fm_btreeNode *AllocBtreeNode(fm_internalTree *tree, fm_bool leaf)
 {
-#if !FM_TREE_DBG_FULL_CALLER_DEPTH
-    void *           btBuffer[4];
-#endif
+    fm_btreeNode *node;
 
-    /* first function in backtrace is TreeInitCaller itself, second function
-     * is TreeInit, third function is either fmCustomTreeInit or fmTreeInit,
-     * so we need the fourth function. */
-#if FM_TREE_DBG_FULL_CALLER_DEPTH
-    tree->callerDepth = backtrace(tree->callerArray, FM_TREE_DBG_CALLER_DEPTH);
-    tree->caller = tree->callerArray[3];
-#else
-    backtrace(btBuffer, 4);
-    tree->caller = btBuffer[3];
-#endif
+    if (tree->arena != NULL)
+    {
+        node = fmArenaAlloc( tree->arena, sizeof(fm_btreeNode) );
+    }
+    else
+    {
+        node = tree->allocFunc( sizeof(fm_btreeNode) );
+    }
 
-}   /* end TreeInitCaller */
-#endif
+    if (node != NULL)
+    {
+        node->leaf    = leaf;
+        node->count   = 0;
+        node->link[0] = NULL;
+        node->link[1] = NULL;
+    }
 
+    return node;
 
+}   /* end AllocBtreeNode */
 
 
-#if FM_TREE_DEBUG_CALLER
-static void UpdateTreeOfTrees(fm_internalTree *tree, fm_bool insert)
-{
-    fm_status err;
 
-    if ( (fmRootAlos != NULL) && (tree != &fmRootAlos->treeTree.internalTree) )
+
+static void FreeBtreeNode(fm_internalTree *tree, fm_btreeNode *node)
+{
+    /* Arena nodes are freed along with the arena */
+    if (tree->arena == NULL)
     {
-        pthread_mutex_lock(&fmRootAlos->treeTreeLock);
+        tree->freeFunc(node);
+    }
 
-        if (insert)
+}   /* end FreeBtreeNode */
+
+
+
+
+static void FreeBtreeNodes(fm_internalTree *tree, fm_btreeNode *node)
+{
+    fm_int i;
+
+    if (!node->leaf)
+    {
+        for (i = 0 ; i <= node->count ; i++)
         {
-            err = fmTreeInsert( &fmRootAlos->treeTree,
-                                FM_CAST_PTR_TO_64(tree),
-                                (void *) tree );
-            if (err != FM_OK)
-            {
-                FM_LOG_DEBUG( FM_LOG_CAT_GENERAL,
-                              "Error adding tree %p to Tree of Trees: %s\n",
-                              (void *) tree,
-                              fmErrorMsg(err) );
-#if 0
-#if FM_TREE_DBG_FULL_CALLER_DEPTH
-                if (tree->callerDepth > 0)
-                {
-                    FM_LOG_PRINT("call stack:\n");
-                    backtrace_symbols_fd(tree->callerArray,
-                                         tree->callerDepth,
-                                         1);
-                }
-#else
-                char **caller = backtrace_symbols(&tree->caller, 1);
+            FreeBtreeNodes(tree, node->u.child[i]);
+        }
+    }
 
-                FM_LOG_PRINT("Caller %s\n", caller[0]);
-#endif
-#endif
-            }
+    FreeBtreeNode(tree, node);
+
+}   /* end FreeBtreeNodes */
+
+
+
+
+static fm_int BtreeCompare(fmCompareFunc cmp, fm_uint64 x, fm_uint64 y)
+{
+    if (cmp != NULL)
+    {
+        return cmp( FM_CAST_64_TO_PTR(x), FM_CAST_64_TO_PTR(y) );
+    }
+
+    return (x < y) ? -1 : ( (x > y) ? 1 : 0 );
+
+}   /* end BtreeCompare */
+
+
+
+
+/* Returns the index of the first key of the node which is not below key,
+ * or which is above key if upper is TRUE. */
+static fm_int BtreeSearch(fm_btreeNode *node,
+                          fm_uint64     key,
+                          fmCompareFunc cmp,
+                          fm_bool       upper)
+{
+    fm_int lo = 0;
+    fm_int hi = node->count;
+    fm_int mid;
+    fm_int c;
+
+    while (lo < hi)
+    {
+        mid = (lo + hi) / 2;
+        c   = BtreeCompare(cmp, node->keys[mid], key);
+
+        if ( (c < 0) || (upper && (c == 0)) )
+        {
+            lo = mid + 1;
         }
         else
         {
-            err = fmTreeRemove( &fmRootAlos->treeTree,
-                                FM_CAST_PTR_TO_64(tree),
-                                NULL );
-            if (err != FM_OK)
-            {
-                FM_LOG_DEBUG( FM_LOG_CAT_GENERAL,
-                              "Error removing tree %p from Tree of Trees: %s\n",
-                              (void *) tree,
-                              fmErrorMsg(err) );
-#if 0
-#if FM_TREE_DBG_FULL_CALLER_DEPTH
-                if (tree->callerDepth > 0)
-                {
-                    FM_LOG_PRINT("call stack:\n");
-                    backtrace_symbols_fd(tree->callerArray,
-                                         tree->callerDepth,
-                                         1);
-                }
-#else
-                char **caller = backtrace_symbols(&tree->caller, 1);
+            hi = mid;
+        }
+    }
 
-                FM_LOG_PRINT("Caller %s\n", caller[0]);
-#endif
-#endif
+    return lo;
+
+}   /* end BtreeSearch */
+
+
+
+
+/* Descends to the leaf which holds (or would hold) key, recording the
+ * internal nodes on the way and the child index taken in each of them
+ * if path is not NULL. Returns NULL for an empty tree. */
+static fm_btreeNode *BtreeDescend(fm_internalTree *tree,
+                                  fm_uint64        key,
+                                  fmCompareFunc    cmp,
+                                  fm_btreeNode **  path,
+                                  fm_int *         index,
+                                  fm_int *         depth)
+{
+    fm_btreeNode *node = tree->btreeRoot;
+    fm_int        d    = 0;
+    fm_int        i;
+
+    if (node != NULL)
+    {
+        while (!node->leaf)
+        {
+            i = BtreeSearch(node, key, cmp, TRUE);
+
+            if (path != NULL)
+            {
+                path[d]  = node;
+                index[d] = i;
             }
+
+            d++;
+            node = node->u.child[i];
         }
+    }
 
-        pthread_mutex_unlock(&fmRootAlos->treeTreeLock);
+    if (depth != NULL)
+    {
+        *depth = d;
     }
 
-}   /* end UpdateTreeOfTrees */
-#endif
+    return node;
 
+}   /* end BtreeDescend */
 
 
 
-static void TreeInit(fm_internalTree *tree)
+
+static fm_status BtreeLocate(fm_internalTree *tree,
+                             fm_uint64        key,
+                             fmCompareFunc    cmp,
+                             fm_btreeNode **  leaf,
+                             fm_int *         pos)
 {
-    tree->root       = NULL;
-    tree->serial     = 0;
-    tree->size       = 0;
-    tree->allocFunc  = fmAlloc;
-    tree->freeFunc   = fmFree;
-    tree->insertFunc = NULL;
-    tree->deleteFunc = NULL;
-    tree->signature  = FM_TREE_SIGNATURE;
+    *leaf = BtreeDescend(tree, key, cmp, NULL, NULL, NULL);
 
-#if FM_TREE_DEBUG_CALLER
-    TreeInitCaller(tree);
+    if (*leaf == NULL)
+    {
+        return FM_ERR_NOT_FOUND;
+    }
 
-    UpdateTreeOfTrees(tree, TRUE);
-#endif
+    *pos = BtreeSearch(*leaf, key, cmp, FALSE);
 
-}   /* end TreeInit */
+    if ( (*pos < (*leaf)->count) &&
+         (BtreeCompare(cmp, (*leaf)->keys[*pos], key) == 0) )
+    {
+        return FM_OK;
+    }
+
+    return FM_ERR_NOT_FOUND;
 
+}   /* end BtreeLocate */
 
 
 
-static void TreeInitWithAllocator(fm_internalTree *tree,
-                                  fmAllocFunc      allocFunc,
-                                  fmFreeFunc       freeFunc)
+
+/* Moves a leaf position to the next entry in direction dir. The leaf is
+ * set to NULL when there are no more entries. */
+static void BtreeStep(fm_btreeNode **leaf, fm_int *pos, fm_dir dir)
 {
-    tree->root       = NULL;
-    tree->serial     = 0;
-    tree->size       = 0;
-    tree->allocFunc  = allocFunc;
-    tree->freeFunc   = freeFunc;
-    tree->insertFunc = NULL;
-    tree->deleteFunc = NULL;
-    tree->signature  = FM_TREE_SIGNATURE;
+    if (dir)
+    {
+        if ( ++(*pos) >= (*leaf)->count )
+        {
+            *leaf = (*leaf)->link[1];
+            *pos  = 0;
+        }
+    }
+    else if ( --(*pos) < 0 )
+    {
+        *leaf = (*leaf)->link[0];
+        *pos  = (*leaf != NULL) ? (*leaf)->count - 1 : 0;
+    }
 
-#if FM_TREE_DEBUG_CALLER
-    TreeInitCaller(tree);
+}   /* end BtreeStep */
 
-    UpdateTreeOfTrees(tree, TRUE);
-#endif
 
-}   /* end TreeInitWithAllocator */
 
 
+static fm_btreeNode *BtreeEdgeLeaf(fm_internalTree *tree, fm_dir dir)
+{
+    fm_btreeNode *node = tree->btreeRoot;
 
+    while ( (node != NULL) && !node->leaf )
+    {
+        node = node->u.child[dir ? node->count : 0];
+    }
 
-static void TreeDestroy(fm_internalTree *tree,
-                        fmFreeFunc       delFunc,
-                        fmFreePairFunc   delPairFunc)
+    return node;
+
+}   /* end BtreeEdgeLeaf */
+
+
+
+
+/* Retrieves the neighbours of a leaf entry, for the insert and delete
+ * callbacks. */
+static void BtreeNeighbours(fm_btreeNode *leaf,
+                            fm_int        pos,
+                            void **       prevKey,
+                            void **       prevValue,
+                            void **       nextKey,
+                            void **       nextValue)
 {
-    /**************************************************
-     * http://tinyurl.com/2hcg9k#destroy
-     **************************************************/
+    fm_btreeNode *node;
+    fm_int        i;
 
-    fm_status   err = FM_OK; 
-    fm_treeNode *it = tree->root;
-    fm_treeNode *save;
+    node = leaf;
+    i    = pos;
+    BtreeStep(&node, &i, 0);
 
-    FM_LOG_ABORT_ON_ASSERT(FM_LOG_CAT_GENERAL,
-                           !( delFunc != NULL && delPairFunc != NULL ),
-                           err = FM_ERR_ASSERTION_FAILED, 
-                           "Assertion failure in TreeDestroy\n");
+    if (node != NULL)
+    {
+        *prevKey   = FM_CAST_64_TO_PTR(node->keys[i]);
+        *prevValue = node->u.values[i];
+    }
+    else
+    {
+        *prevKey = *prevValue = NULL;
+    }
 
-    while (it != NULL)
+    node = leaf;
+    i    = pos;
+    BtreeStep(&node, &i, 1);
+
+    if (node != NULL)
     {
-        if ( !it->threaded[0] && it->link[0] != NULL )
-        {
-            /* Right rotation */
-            save                = it->link[0];
+        *nextKey   = FM_CAST_64_TO_PTR(node->keys[i]);
+        *nextValue = node->u.values[i];
+    }
+    else
+    {
+        *nextKey = *nextValue = NULL;
+    }
 
-            it->link[0]         = save->link[1];
-            it->threaded[0]     = save->threaded[1];
+}   /* end BtreeNeighbours */
 
-            save->link[1]       = it;
-            save->threaded[1]   = FALSE;
+
+
+
+static fm_status BtreeInsert(fm_internalTree *tree,
+                             fm_uint64        key,
+                             void *           value,
+                             fmCompareFunc    cmp)
+{
+    fm_btreeNode *path[FM_BTREE_MAX_DEPTH];
+    fm_int        index[FM_BTREE_MAX_DEPTH];
+    fm_btreeNode *spare[FM_BTREE_MAX_DEPTH + 2];
+    fm_uint64     tmpKeys[FM_BTREE_MAX_KEYS + 1];
+    void *        tmpPtrs[FM_BTREE_MAX_KEYS + 2];
+    fm_btreeNode *leaf;
+    fm_btreeNode *node;
+    fm_btreeNode *right;
+    fm_btreeNode *newLeaf;
+    fm_uint64     sepKey;
+    fm_int        depth;
+    fm_int        needed;
+    fm_int        used;
+    fm_int        pos;
+    fm_int        newPos;
+    fm_int        half;
+    fm_int        d;
+    fm_int        i;
+    void *        prevKey, *prevValue, *nextKey, *nextValue;
+
+    tree->serial++;
+
+    if (tree->btreeRoot == NULL)
+    {
+        tree->btreeRoot = AllocBtreeNode(tree, TRUE);
+
+        if (tree->btreeRoot == NULL)
+        {
+            return FM_ERR_NO_MEM;
+        }
+    }
+
+    leaf = BtreeDescend(tree, key, cmp, path, index, &depth);
+    pos  = BtreeSearch(leaf, key, cmp, FALSE);
+
+    if ( (pos < leaf->count) &&
+         (BtreeCompare(cmp, leaf->keys[pos], key) == 0) )
+    {
+        return FM_ERR_ALREADY_EXISTS;
+    }
+
+    /**************************************************
+     * Allocate every node the splits will need up
+     * front, so that running out of memory leaves the
+     * tree untouched.
+     **************************************************/
+
+    needed = 0;
+
+    if (leaf->count == FM_BTREE_MAX_KEYS)
+    {
+        needed = 1;
+
+        for (d = depth - 1 ;
+             (d >= 0) && (path[d]->count == FM_BTREE_MAX_KEYS) ;
+             d--)
+        {
+            needed++;
+        }
+
+        if (d < 0)
+        {
+            /* The root splits too */
+            needed++;
+        }
+    }
+
+    /* The split leaf comes first, then its parents, then the new root */
+    for (i = 0 ; i < needed ; i++)
+    {
+        spare[i] = AllocBtreeNode(tree, (i == 0) ? TRUE : FALSE);
+
+        if (spare[i] == NULL)
+        {
+            while (--i >= 0)
+            {
+                FreeBtreeNode(tree, spare[i]);
+            }
+
+            return FM_ERR_NO_MEM;
+        }
+    }
+
+    used = 0;
+
+    if (leaf->count < FM_BTREE_MAX_KEYS)
+    {
+        memmove( &leaf->keys[pos + 1],
+                 &leaf->keys[pos],
+                 (leaf->count - pos) * sizeof(fm_uint64) );
+        memmove( &leaf->u.values[pos + 1],
+                 &leaf->u.values[pos],
+                 (leaf->count - pos) * sizeof(void *) );
+
+        leaf->keys[pos]     = key;
+        leaf->u.values[pos] = value;
+        leaf->count++;
+
+        newLeaf = leaf;
+        newPos  = pos;
+    }
+    else
+    {
+        /**************************************************
+         * Split the leaf, the lower half stays in place.
+         **************************************************/
+
+        right = spare[used++];
+        half  = (FM_BTREE_MAX_KEYS + 1) / 2;
+
+        for (i = 0 ; i < pos ; i++)
+        {
+            tmpKeys[i] = leaf->keys[i];
+            tmpPtrs[i] = leaf->u.values[i];
+        }
+
+        tmpKeys[pos] = key;
+        tmpPtrs[pos] = value;
+
+        for (i = pos ; i < FM_BTREE_MAX_KEYS ; i++)
+        {
+            tmpKeys[i + 1] = leaf->keys[i];
+            tmpPtrs[i + 1] = leaf->u.values[i];
+        }
+
+        for (i = 0 ; i < half ; i++)
+        {
+            leaf->keys[i]     = tmpKeys[i];
+            leaf->u.values[i] = tmpPtrs[i];
+        }
+
+        for (i = half ; i <= FM_BTREE_MAX_KEYS ; i++)
+        {
+            right->keys[i - half]     = tmpKeys[i];
+            right->u.values[i - half] = tmpPtrs[i];
+        }
+
+        leaf->count  = half;
+        right->count = FM_BTREE_MAX_KEYS + 1 - half;
+
+        right->link[0] = leaf;
+        right->link[1] = leaf->link[1];
+
+        if (leaf->link[1] != NULL)
+        {
+            leaf->link[1]->link[0] = right;
+        }
+
+        leaf->link[1] = right;
+
+        if (pos < half)
+        {
+            newLeaf = leaf;
+            newPos  = pos;
+        }
+        else
+        {
+            newLeaf = right;
+            newPos  = pos - half;
+        }
+
+        /**************************************************
+         * Insert the separator in the parents, splitting
+         * them in turn while they are full.
+         **************************************************/
+
+        sepKey = right->keys[0];
+        node   = right;
+
+        for (d = depth - 1 ; d >= 0 ; d--)
+        {
+            fm_btreeNode *parent = path[d];
+
+            i = index[d];
+
+            if (parent->count < FM_BTREE_MAX_KEYS)
+            {
+                memmove( &parent->keys[i + 1],
+                         &parent->keys[i],
+                         (parent->count - i) * sizeof(fm_uint64) );
+                memmove( &parent->u.child[i + 2],
+                         &parent->u.child[i + 1],
+                         (parent->count - i) * sizeof(fm_btreeNode *) );
+
+                parent->keys[i]        = sepKey;
+                parent->u.child[i + 1] = node;
+                parent->count++;
+
+                node = NULL;
+                break;
+            }
+
+            right = spare[used++];
+
+            memcpy( tmpKeys, parent->keys, i * sizeof(fm_uint64) );
+            memcpy( tmpPtrs, parent->u.child, (i + 1) * sizeof(void *) );
+
+            tmpKeys[i]     = sepKey;
+            tmpPtrs[i + 1] = node;
+
+            memcpy( &tmpKeys[i + 1],
+                    &parent->keys[i],
+                    (FM_BTREE_MAX_KEYS - i) * sizeof(fm_uint64) );
+            memcpy( &tmpPtrs[i + 2],
+                    &parent->u.child[i + 1],
+                    (FM_BTREE_MAX_KEYS - i) * sizeof(void *) );
+
+            /* The middle key moves up to the grandparent */
+            memcpy( parent->keys, tmpKeys, half * sizeof(fm_uint64) );
+            memcpy( parent->u.child, tmpPtrs, (half + 1) * sizeof(void *) );
+            memcpy( right->keys,
+                    &tmpKeys[half + 1],
+                    (FM_BTREE_MAX_KEYS - half) * sizeof(fm_uint64) );
+            memcpy( right->u.child,
+                    &tmpPtrs[half + 1],
+                    (FM_BTREE_MAX_KEYS + 1 - half) * sizeof(void *) );
+
+            parent->count = half;
+            right->count  = FM_BTREE_MAX_KEYS - half;
+
+            sepKey = tmpKeys[half];
+            node   = right;
+        }
+
+        if (node != NULL)
+        {
+            /* The root was split, grow the tree by one level */
+            right = spare[used++];
+
+            right->keys[0]    = sepKey;
+            right->u.child[0] = tree->btreeRoot;
+            right->u.child[1] = node;
+            right->count      = 1;
+
+            tree->btreeRoot = right;
+        }
+    }
+
+    tree->size++;
+
+    if (tree->insertFunc != NULL)
+    {
+        BtreeNeighbours(newLeaf,
+                        newPos,
+                        &prevKey,
+                        &prevValue,
+                        &nextKey,
+                        &nextValue);
+
+        tree->insertFunc(FM_CAST_64_TO_PTR(key),
+                         value,
+                         prevKey,
+                         prevValue,
+                         nextKey,
+                         nextValue);
+    }
+
+    return FM_OK;
+
+}   /* end BtreeInsert */
+
+
+
+
+/* Refills child i of parent, which is one entry short, from one of its
+ * siblings, or merges it with a sibling when neither can spare one. */
+static void BtreeFixChild(fm_internalTree *tree,
+                          fm_btreeNode *   parent,
+                          fm_int           i)
+{
+    fm_btreeNode *node  = parent->u.child[i];
+    fm_btreeNode *left  = (i > 0) ? parent->u.child[i - 1] : NULL;
+    fm_btreeNode *right = (i < parent->count) ? parent->u.child[i + 1] : NULL;
+    fm_int        n     = node->count;
+
+    if ( (left != NULL) && (left->count > FM_BTREE_MIN_KEYS) )
+    {
+        /* Rotate the last entry of the left sibling through the parent */
+        memmove( &node->keys[1], &node->keys[0], n * sizeof(fm_uint64) );
+
+        if (node->leaf)
+        {
+            memmove( &node->u.values[1],
+                     &node->u.values[0],
+                     n * sizeof(void *) );
+
+            node->keys[0]       = left->keys[left->count - 1];
+            node->u.values[0]   = left->u.values[left->count - 1];
+            parent->keys[i - 1] = node->keys[0];
+        }
+        else
+        {
+            memmove( &node->u.child[1],
+                     &node->u.child[0],
+                     (n + 1) * sizeof(fm_btreeNode *) );
+
+            node->keys[0]       = parent->keys[i - 1];
+            node->u.child[0]    = left->u.child[left->count];
+            parent->keys[i - 1] = left->keys[left->count - 1];
+        }
+
+        left->count--;
+        node->count++;
+    }
+    else if ( (right != NULL) && (right->count > FM_BTREE_MIN_KEYS) )
+    {
+        /* Rotate the first entry of the right sibling through the parent */
+        if (node->leaf)
+        {
+            node->keys[n]     = right->keys[0];
+            node->u.values[n] = right->u.values[0];
+
+            memmove( &right->u.values[0],
+                     &right->u.values[1],
+                     (right->count - 1) * sizeof(void *) );
+        }
+        else
+        {
+            node->keys[n]        = parent->keys[i];
+            node->u.child[n + 1] = right->u.child[0];
+            parent->keys[i]      = right->keys[0];
+
+            memmove( &right->u.child[0],
+                     &right->u.child[1],
+                     right->count * sizeof(fm_btreeNode *) );
+        }
+
+        memmove( &right->keys[0],
+                 &right->keys[1],
+                 (right->count - 1) * sizeof(fm_uint64) );
+
+        if (node->leaf)
+        {
+            /* The new first key of the sibling is its separator */
+            parent->keys[i] = right->keys[0];
+        }
+
+        right->count--;
+        node->count++;
+    }
+    else
+    {
+        /* Merge child i + 1 into child i */
+        if (left != NULL)
+        {
+            right = node;
+            node  = left;
+            i--;
+        }
+
+        n = node->count;
+
+        if (node->leaf)
+        {
+            memcpy( &node->keys[n],
+                    right->keys,
+                    right->count * sizeof(fm_uint64) );
+            memcpy( &node->u.values[n],
+                    right->u.values,
+                    right->count * sizeof(void *) );
+
+            node->count   = n + right->count;
+            node->link[1] = right->link[1];
+
+            if (right->link[1] != NULL)
+            {
+                right->link[1]->link[0] = node;
+            }
+        }
+        else
+        {
+            node->keys[n] = parent->keys[i];
+
+            memcpy( &node->keys[n + 1],
+                    right->keys,
+                    right->count * sizeof(fm_uint64) );
+            memcpy( &node->u.child[n + 1],
+                    right->u.child,
+                    (right->count + 1) * sizeof(fm_btreeNode *) );
+
+            node->count = n + 1 + right->count;
+        }
+
+        memmove( &parent->keys[i],
+                 &parent->keys[i + 1],
+                 (parent->count - i - 1) * sizeof(fm_uint64) );
+        memmove( &parent->u.child[i + 1],
+                 &parent->u.child[i + 2],
+                 (parent->count - i - 1) * sizeof(fm_btreeNode *) );
+
+        parent->count--;
+
+        FreeBtreeNode(tree, right);
+    }
+
+}   /* end BtreeFixChild */
+
+
+
+
+static fm_status BtreeRemove(fm_internalTree *tree,
+                             fm_uint64        key,
+                             fmFreeFunc       delFunc,
+                             fmFreePairFunc   pairFunc,
+                             fmCompareFunc    cmp)
+{
+    fm_btreeNode *path[FM_BTREE_MAX_DEPTH];
+    fm_int        index[FM_BTREE_MAX_DEPTH];
+    fm_btreeNode *leaf;
+    fm_btreeNode *node;
+    fm_int        depth;
+    fm_int        pos;
+    fm_int        d;
+    void *        value;
+    void *        prevKey, *prevValue, *nextKey, *nextValue;
+
+    tree->serial++;
+
+    leaf = BtreeDescend(tree, key, cmp, path, index, &depth);
+    pos  = 0;
+
+    if (leaf != NULL)
+    {
+        pos = BtreeSearch(leaf, key, cmp, FALSE);
+    }
+
+    if ( (leaf == NULL) ||
+         (pos >= leaf->count) ||
+         (BtreeCompare(cmp, leaf->keys[pos], key) != 0) )
+    {
+        FM_LOG_FATAL(FM_LOG_CAT_GENERAL, 
+                     "Attempted to remove entry from tree that didn't "
+                     " exist.\n");
+        FM_LOG_CALL_STACK(FM_LOG_CAT_GENERAL, FM_LOG_LEVEL_FATAL);
+        return FM_ERR_NOT_FOUND;
+    }
+
+    value = leaf->u.values[pos];
+
+    if (tree->deleteFunc != NULL)
+    {
+        BtreeNeighbours(leaf,
+                        pos,
+                        &prevKey,
+                        &prevValue,
+                        &nextKey,
+                        &nextValue);
+
+        tree->deleteFunc(FM_CAST_64_TO_PTR(key),
+                         value,
+                         prevKey,
+                         prevValue,
+                         nextKey,
+                         nextValue);
+    }
+
+    if (delFunc != NULL)
+    {
+        delFunc(value);
+    }
+
+    if (pairFunc != NULL)
+    {
+        pairFunc(FM_CAST_64_TO_PTR(leaf->keys[pos]), value);
+    }
+
+    leaf->count--;
+
+    memmove( &leaf->keys[pos],
+             &leaf->keys[pos + 1],
+             (leaf->count - pos) * sizeof(fm_uint64) );
+    memmove( &leaf->u.values[pos],
+             &leaf->u.values[pos + 1],
+             (leaf->count - pos) * sizeof(void *) );
+
+    if ( (pos == 0) && (leaf->count > 0) )
+    {
+        /**************************************************
+         * The removed key may also be the separator in
+         * front of this leaf, held by the deepest ancestor
+         * we did not enter through its first child. Keep
+         * separators pointing at keys still in the tree.
+         **************************************************/
+
+        for (d = depth - 1 ; d >= 0 ; d--)
+        {
+            if (index[d] > 0)
+            {
+                path[d]->keys[index[d] - 1] = leaf->keys[0];
+                break;
+            }
+        }
+    }
+
+    /* Rebalance bottom-up while a node is short of entries */
+    node = leaf;
+
+    for (d = depth - 1 ;
+         (d >= 0) && (node->count < FM_BTREE_MIN_KEYS) ;
+         d--)
+    {
+        BtreeFixChild(tree, path[d], index[d]);
+        node = path[d];
+    }
+
+    node = tree->btreeRoot;
+
+    if (node->count == 0)
+    {
+        /* Shrink the tree by one level, or empty it */
+        tree->btreeRoot = node->leaf ? NULL : node->u.child[0];
+        FreeBtreeNode(tree, node);
+    }
+
+    tree->size--;
+
+    return FM_OK;
+
+}   /* end BtreeRemove */
+
+
+
+
+static void BtreeDestroy(fm_internalTree *tree,
+                         fmFreeFunc       delFunc,
+                         fmFreePairFunc   delPairFunc)
+{
+    fm_btreeNode *leaf;
+    fm_int        i;
+
+    if ( (tree->arena != NULL) && (delFunc == NULL) && (delPairFunc == NULL) )
+    {
+        /* Nothing to do per node, the arena owns the nodes */
+        tree->btreeRoot = NULL;
+        tree->size      = 0;
+        return;
+    }
+
+    for (leaf = BtreeEdgeLeaf(tree, 0) ; leaf != NULL ; leaf = leaf->link[1])
+    {
+        for (i = 0 ; i < leaf->count ; i++)
+        {
+            if (delFunc != NULL)
+            {
+                delFunc(leaf->u.values[i]);
+            }
+
+            if (delPairFunc != NULL)
+            {
+                delPairFunc(FM_CAST_64_TO_PTR(leaf->keys[i]),
+                            leaf->u.values[i]);
+            }
+        }
+
+        tree->size -= leaf->count;
+    }
+
+    if (tree->btreeRoot != NULL)
+    {
+        FreeBtreeNodes(tree, tree->btreeRoot);
+        tree->btreeRoot = NULL;
+    }
+
+}   /* end BtreeDestroy */
+
+
+
+
+static fm_btreeNode *BtreeCloneNode(fm_internalTree *tree,
+                                    fm_btreeNode *   sNode,
+                                    fm_btreeNode **  lastLeaf,
+                                    fmCloneFunc      cloneFunc,
+                                    void *           cloneFuncArg,
+                                    fm_status *      err)
+{
+    fm_btreeNode *cn = AllocBtreeNode(tree, sNode->leaf);
+    fm_int        i;
+
+    if (cn == NULL)
+    {
+        return NULL;
+    }
+
+    cn->count = sNode->count;
+    memcpy( cn->keys, sNode->keys, sNode->count * sizeof(fm_uint64) );
+
+    if (sNode->leaf)
+    {
+        for (i = 0 ; i < sNode->count ; i++)
+        {
+            if (cloneFunc == NULL)
+            {
+                cn->u.values[i] = sNode->u.values[i];
+            }
+            else
+            {
+                cn->u.values[i] = cloneFunc(sNode->u.values[i], cloneFuncArg);
+
+                /* NULL value equal failure */
+                if (cn->u.values[i] == NULL)
+                {
+                    *err = FM_FAIL;
+                }
+            }
+        }
+
+        /* Leaves are cloned in key order, chain them as we go */
+        cn->link[0] = *lastLeaf;
+
+        if (*lastLeaf != NULL)
+        {
+            (*lastLeaf)->link[1] = cn;
+        }
+
+        *lastLeaf = cn;
+    }
+    else
+    {
+        for (i = 0 ; i <= sNode->count ; i++)
+        {
+            cn->u.child[i] = BtreeCloneNode(tree,
+                                            sNode->u.child[i],
+                                            lastLeaf,
+                                            cloneFunc,
+                                            cloneFuncArg,
+                                            err);
+
+            if (cn->u.child[i] == NULL)
+            {
+                while (--i >= 0)
+                {
+                    FreeBtreeNodes(tree, cn->u.child[i]);
+                }
+
+                FreeBtreeNode(tree, cn);
+                return NULL;
+            }
+        }
+    }
+
+    return cn;
+
+}   /* end BtreeCloneNode */
+
+
+
+
+static fm_status BtreeFindRandom(fm_internalTree *tree,
+                                 fm_uint64 *      key,
+                                 void **          value)
+{
+    fm_btreeNode *node = tree->btreeRoot;
+    fm_int        i;
+
+    if (node == NULL)
+    {
+        return FM_ERR_NOT_FOUND;
+    }
+
+    while (!node->leaf)
+    {
+        node = node->u.child[fmRand() % (node->count + 1)];
+    }
+
+    i      = fmRand() % node->count;
+    *key   = node->keys[i];
+    *value = node->u.values[i];
+
+    return FM_OK;
+
+}   /* end BtreeFindRandom */
+
+
+
+
+static fm_status BtreeNeighbour(fm_internalTree *tree,
+                                fm_uint64        key,
+                                fm_uint64 *      nextKey,
+                                void **          nextValue,
+                                fmCompareFunc    cmp,
+                                fm_dir           dir)
+{
+    fm_btreeNode *leaf;
+    fm_int        pos;
+
+    if (BtreeLocate(tree, key, cmp, &leaf, &pos) != FM_OK)
+    {
+        return FM_ERR_NOT_FOUND;
+    }
+
+    BtreeStep(&leaf, &pos, dir);
+
+    if (leaf == NULL)
+    {
+        return FM_ERR_NO_MORE;
+    }
+
+    *nextKey   = leaf->keys[pos];
+    *nextValue = leaf->u.values[pos];
+
+    return FM_OK;
+
+}   /* end BtreeNeighbour */
+
+
+
+
+static void BtreeIterInit(fm_internalTreeIterator *it,
+                          fm_internalTree *        tree,
+                          fm_dir                   dir)
+{
+    it->tree      = tree;
+    it->serial    = tree->serial;
+    it->dir       = dir;
+    it->nextPtr   = NULL;
+    it->nextLeaf  = BtreeEdgeLeaf(tree, dir ? 0 : 1);
+    it->nextIndex = 0;
+
+    if ( !dir && (it->nextLeaf != NULL) )
+    {
+        it->nextIndex = it->nextLeaf->count - 1;
+    }
+
+}   /* end BtreeIterInit */
+
+
+
+
+static fm_status BtreeIterInitFromKey(fm_internalTreeIterator *it,
+                                      fm_internalTree *        tree,
+                                      fm_uint64                key,
+                                      fmCompareFunc            cmp,
+                                      fm_dir                   dir,
+                                      fm_bool                  successor)
+{
+    fm_btreeNode *leaf;
+    fm_int        pos;
+
+    it->tree    = tree;
+    it->serial  = tree->serial;
+    it->dir     = dir;
+    it->nextPtr = NULL;
+
+    if (BtreeLocate(tree, key, cmp, &leaf, &pos) != FM_OK)
+    {
+        return FM_ERR_NOT_FOUND;
+    }
+
+    if (successor)
+    {
+        BtreeStep(&leaf, &pos, dir);
+    }
+
+    it->nextLeaf  = leaf;
+    it->nextIndex = pos;
+
+    return FM_OK;
+
+}   /* end BtreeIterInitFromKey */
+
+
+
+
+static fm_status BtreeIterNext(fm_internalTreeIterator *it,
+                               fm_uint64 *              nextKey,
+                               void **                  nextValue)
+{
+    if (it->nextLeaf == NULL)
+    {
+        return FM_ERR_NO_MORE;
+    }
+    else if (it->serial != it->tree->serial)
+    {
+        return FM_ERR_MODIFIED_WHILE_ITERATING;
+    }
+
+    *nextKey   = it->nextLeaf->keys[it->nextIndex];
+    *nextValue = it->nextLeaf->u.values[it->nextIndex];
+
+    BtreeStep(&it->nextLeaf, &it->nextIndex, it->dir);
+
+    return FM_OK;
+
+}   /* end BtreeIterNext */
+
+
+
+
+/* Checks a subtree whose keys must lie in [lo, hi), where a NULL bound
+ * is open. Returns the depth of its leaves, or -1 if it is invalid. */
+static fm_int BtreeValidateNode(fm_btreeNode *   node,
+                                fm_bool          isRoot,
+                                const fm_uint64 *lo,
+                                const fm_uint64 *hi,
+                                fmCompareFunc    cmp)
+{
+    fm_int leafDepth = -1;
+    fm_int childDepth;
+    fm_int i;
+
+    if ( (node->count < (isRoot ? 1 : FM_BTREE_MIN_KEYS)) ||
+         (node->count > FM_BTREE_MAX_KEYS) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_GENERAL,
+                     "B+tree node %p holds %d keys\n",
+                     (void *) node,
+                     node->count);
+        return -1;
+    }
+
+    for (i = 0 ; i < node->count ; i++)
+    {
+        if ( ( (i > 0) &&
+               (BtreeCompare(cmp, node->keys[i - 1], node->keys[i]) >= 0) ) ||
+             ( (lo != NULL) && (BtreeCompare(cmp, node->keys[i], *lo) < 0) ) ||
+             ( (hi != NULL) && (BtreeCompare(cmp, node->keys[i], *hi) >= 0) ) )
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_GENERAL,
+                         "B+tree node %p key %d with key %"
+                         FM_FORMAT_64 "u is out of order\n",
+                         (void *) node,
+                         i,
+                         node->keys[i]);
+            return -1;
+        }
+    }
+
+    if (node->leaf)
+    {
+        return 0;
+    }
+
+    for (i = 0 ; i <= node->count ; i++)
+    {
+        childDepth = BtreeValidateNode(node->u.child[i],
+                                       FALSE,
+                                       (i == 0) ? lo : &node->keys[i - 1],
+                                       (i == node->count) ? hi : &node->keys[i],
+                                       cmp);
+
+        if (childDepth < 0)
+        {
+            return -1;
+        }
+
+        if ( (leafDepth >= 0) && (childDepth != leafDepth) )
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_GENERAL,
+                         "B+tree node %p has leaves at different depths\n",
+                         (void *) node);
+            return -1;
+        }
+
+        leafDepth = childDepth;
+    }
+
+    return leafDepth + 1;
+
+}   /* end BtreeValidateNode */
+
+
+
+
+static fm_status BtreeValidate(fm_internalTree *tree, fmCompareFunc cmp)
+{
+    fm_btreeNode *leaf;
+    fm_btreeNode *prev = NULL;
+    fm_uint       size = 0;
+
+    if (tree->btreeRoot == NULL)
+    {
+        return (tree->size == 0) ? FM_OK : FM_FAIL;
+    }
+
+    if (BtreeValidateNode(tree->btreeRoot, TRUE, NULL, NULL, cmp) < 0)
+    {
+        return FM_FAIL;
+    }
+
+    for (leaf = BtreeEdgeLeaf(tree, 0) ; leaf != NULL ; leaf = leaf->link[1])
+    {
+        if (leaf->link[0] != prev)
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_GENERAL,
+                         "B+tree leaf %p is not linked to leaf %p\n",
+                         (void *) leaf,
+                         (void *) prev);
+            return FM_FAIL;
+        }
+
+        size += leaf->count;
+        prev  = leaf;
+    }
+
+    if ( (prev != BtreeEdgeLeaf(tree, 1)) || (size != tree->size) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_GENERAL,
+                     "B+tree leaves hold %u entries, tree size is %u\n",
+                     size,
+                     tree->size);
+        return FM_FAIL;
+    }
+
+    return FM_OK;
+
+}   /* end BtreeValidate */
+
+
+
+
+static void BtreeDbgDumpNode(fm_btreeNode *node, fm_int level)
+{
+    fm_int i;
+
+    FM_LOG_PRINT( "    node=%p, level=%d, leaf=%d, count=%d, "
+                  "prev=%p, next=%p\n",
+                  (void *) node,
+                  level,
+                  node->leaf,
+                  node->count,
+                  (void *) node->link[0],
+                  (void *) node->link[1] );
+
+    for (i = 0 ; i < node->count ; i++)
+    {
+        FM_LOG_PRINT( "        key=%llu\n", node->keys[i] );
+    }
+
+    if (!node->leaf)
+    {
+        for (i = 0 ; i <= node->count ; i++)
+        {
+            BtreeDbgDumpNode(node->u.child[i], level + 1);
+        }
+    }
+
+}   /* end BtreeDbgDumpNode */
+
+
+
+
+static fm_uint BtreeCountNodes(fm_btreeNode *node)
+{
+    fm_uint count;
+    fm_int  i;
+
+    count = 1;
+
+    if (!node->leaf)
+    {
+        for (i = 0 ; i <= node->count ; i++)
+        {
+            count += BtreeCountNodes(node->u.child[i]);
+        }
+    }
+
+    return count;
+
+}   /* end BtreeCountNodes */
+
+
+#if FM_TREE_DEBUG_CALLER
+static void TreeInitCaller(fm_internalTree *tree)
+{
+#if !FM_TREE_DBG_FULL_CALLER_DEPTH
+    void *           btBuffer[4];
+#endif
+
+    /* first function in backtrace is TreeInitCaller itself, second function
+     * is TreeInit, third function is either fmCustomTreeInit or fmTreeInit,
+     * so we need the fourth function. */
+#if FM_TREE_DBG_FULL_CALLER_DEPTH
+    tree->callerDepth = backtrace(tree->callerArray, FM_TREE_DBG_CALLER_DEPTH);
+    tree->caller = tree->callerArray[3];
+#else
+    backtrace(btBuffer, 4);
+    tree->caller = btBuffer[3];
+#endif
+
+}   /* end TreeInitCaller */
+#endif
+
+
+
+
+#if FM_TREE_DEBUG_CALLER
+static void UpdateTreeOfTrees(fm_internalTree *tree, fm_bool insert)
+{
+    fm_status err;
+
+    if ( (fmRootAlos != NULL) && (tree != &fmRootAlos->treeTree.internalTree) )
+    {
+        pthread_mutex_lock(&fmRootAlos->treeTreeLock);
+
+        if (insert)
+        {
+            err = fmTreeInsert( &fmRootAlos->treeTree,
+                                FM_CAST_PTR_TO_64(tree),
+                                (void *) tree );
+            if (err != FM_OK)
+            {
+                FM_LOG_DEBUG( FM_LOG_CAT_GENERAL,
+                              "Error adding tree %p to Tree of Trees: %s\n",
+                              (void *) tree,
+                              fmErrorMsg(err) );
+#if 0
+#if FM_TREE_DBG_FULL_CALLER_DEPTH
+                if (tree->callerDepth > 0)
+                {
+                    FM_LOG_PRINT("call stack:\n");
+                    backtrace_symbols_fd(tree->callerArray,
+                                         tree->callerDepth,
+                                         1);
+                }
+#else
+                char **caller = backtrace_symbols(&tree->caller, 1);
+
+                FM_LOG_PRINT("Caller %s\n", caller[0]);
+#endif
+#endif
+            }
+        }
+        else
+        {
+            err = fmTreeRemove( &fmRootAlos->treeTree,
+                                FM_CAST_PTR_TO_64(tree),
+                                NULL );
+            if (err != FM_OK)
+            {
+                FM_LOG_DEBUG( FM_LOG_CAT_GENERAL,
+                              "Error removing tree %p from Tree of Trees: %s\n",
+                              (void *) tree,
+                              fmErrorMsg(err) );
+#if 0
+#if FM_TREE_DBG_FULL_CALLER_DEPTH
+                if (tree->callerDepth > 0)
+                {
+                    FM_LOG_PRINT("call stack:\n");
+                    backtrace_symbols_fd(tree->callerArray,
+                                         tree->callerDepth,
+                                         1);
+                }
+#else
+                char **caller = backtrace_symbols(&tree->caller, 1);
+
+                FM_LOG_PRINT("Caller %s\n", caller[0]);
+#endif
+#endif
+            }
+        }
+
+        pthread_mutex_unlock(&fmRootAlos->treeTreeLock);
+    }
+
+}   /* end UpdateTreeOfTrees */
+#endif
+
+
+
+
+static void TreeInit(fm_internalTree *tree)
+{
+    tree->btree      = FALSE;
+    tree->root       = NULL;
+    tree->btreeRoot  = NULL;
+    tree->serial     = 0;
+    tree->size       = 0;
+    tree->allocFunc  = fmAlloc;
+    tree->freeFunc   = fmFree;
+    tree->arena      = NULL;
+    tree->insertFunc = NULL;
+    tree->deleteFunc = NULL;
+    tree->signature  = FM_TREE_SIGNATURE;
+
+#if FM_TREE_DEBUG_CALLER
+    TreeInitCaller(tree);
+
+    UpdateTreeOfTrees(tree, TRUE);
+#endif
+
+}   /* end TreeInit */
+
+
+
+
+static void TreeInitWithAllocator(fm_internalTree *tree,
+                                  fmAllocFunc      allocFunc,
+                                  fmFreeFunc       freeFunc)
+{
+    tree->btree      = FALSE;
+    tree->root       = NULL;
+    tree->btreeRoot  = NULL;
+    tree->serial     = 0;
+    tree->size       = 0;
+    tree->allocFunc  = allocFunc;
+    tree->freeFunc   = freeFunc;
+    tree->arena      = NULL;
+    tree->insertFunc = NULL;
+    tree->deleteFunc = NULL;
+    tree->signature  = FM_TREE_SIGNATURE;
+
+#if FM_TREE_DEBUG_CALLER
+    TreeInitCaller(tree);
+
+    UpdateTreeOfTrees(tree, TRUE);
+#endif
+
+}   /* end TreeInitWithAllocator */
+
+
+
+
+static void TreeDestroy(fm_internalTree *tree,
+                        fmFreeFunc       delFunc,
+                        fmFreePairFunc   delPairFunc)
+{
+    /**************************************************
+     * http://tinyurl.com/2hcg9k#destroy
+     **************************************************/
+
+    fm_status   err = FM_OK; 
+    fm_treeNode *it = tree->root;
+    fm_treeNode *save;
+
+    FM_LOG_ABORT_ON_ASSERT(FM_LOG_CAT_GENERAL,
+                           !( delFunc != NULL && delPairFunc != NULL ),
+                           err = FM_ERR_ASSERTION_FAILED, 
+                           "Assertion failure in TreeDestroy\n");
+
+    if (tree->btree)
+    {
+        BtreeDestroy(tree, delFunc, delPairFunc);
+    }
+    else if ( (tree->arena != NULL) && (delFunc == NULL) && (delPairFunc == NULL) )
+    {
+        /* Nothing to do per node, the arena owns the nodes */
+        it         = NULL;
+        tree->size = 0;
+    }
+
+    while (it != NULL)
+    {
+        if ( !it->threaded[0] && it->link[0] != NULL )
+        {
+            /* Right rotation */
+            save                = it->link[0];
+
+            it->link[0]         = save->link[1];
+            it->threaded[0]     = save->threaded[1];
+
+            save->link[1]       = it;
+            save->threaded[1]   = FALSE;
         }
         else
         {
@@ -652,76 +1993,431 @@ static void TreeDestroy(fm_internalTree *tree,
                 delFunc(it->value);
             }
 
-            if (delPairFunc != NULL)
-            {
-                delPairFunc(FM_CAST_64_TO_PTR(it->key), it->value);
-            }
+            if (delPairFunc != NULL)
+            {
+                delPairFunc(FM_CAST_64_TO_PTR(it->key), it->value);
+            }
+
+            FreeNode(tree, it);
+            --tree->size;
+        }
+
+        it = save;
+    }
+
+    if (tree->size != 0)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_GENERAL,
+                     "Destroyed tree size (%u) != 0\n",
+                     tree->size);
+    }
+
+#if FM_TREE_DEBUG_CALLER
+    UpdateTreeOfTrees(tree, FALSE);
+#endif
+
+    /* this erases the signature, along with everything else */
+    FM_CLEAR(*tree);
+
+ABORT: 
+    return;
+}   /* end TreeDestroy */
+
+
+
+
+static fm_status TreeClone(fm_internalTree *srcTree,
+                           fm_internalTree *dstTree,
+                           fmCloneFunc cloneFunc,
+                           void *cloneFuncArg)
+{
+    fm_status     err = FM_OK;
+    fm_btreeNode *lastLeaf;
+
+    dstTree->btree      = srcTree->btree;
+    dstTree->serial     = srcTree->serial;
+    dstTree->size       = srcTree->size;
+    dstTree->allocFunc  = srcTree->allocFunc;
+    dstTree->freeFunc   = srcTree->freeFunc;
+    dstTree->arena      = srcTree->arena;
+    dstTree->insertFunc = srcTree->insertFunc;
+    dstTree->deleteFunc = srcTree->deleteFunc;
+    dstTree->signature  = srcTree->signature;
+    dstTree->root       = NULL;
+    dstTree->btreeRoot  = NULL;
+
+    if (srcTree->btreeRoot != NULL)
+    {
+        lastLeaf = NULL;
+
+        dstTree->btreeRoot = BtreeCloneNode(srcTree,
+                                            srcTree->btreeRoot,
+                                            &lastLeaf,
+                                            cloneFunc,
+                                            cloneFuncArg,
+                                            &err);
+        if (dstTree->btreeRoot == NULL)
+        {
+            dstTree->size = 0;
+            return FM_ERR_NO_MEM;
+        }
+    }
+    else if (srcTree->root != NULL)
+    {
+        dstTree->root = CloneNode(srcTree,
+                                  srcTree->root,
+                                  dstTree->root,
+                                  dstTree->root,
+                                  cloneFunc,
+                                  cloneFuncArg,
+                                  &err);
+        if (dstTree->root == NULL)
+        {
+            return FM_ERR_NO_MEM;
+        }
+    }
+
+    return err;
+
+}   /* end TreeClone */
+
+
+
+
+/*****************************************************************************/
+/** BulkBuild
+ * \ingroup intTree
+ *
+ * \desc            Recursively links count pre-filled nodes, taken in key
+ *                  order from a chain, into a size-balanced subtree. Nodes
+ *                  on the deepest level are coloured red and all others
+ *                  black, which gives every path the same black height.
+ *                  In-order threads are set up as the nodes are consumed.
+ *
+ * \param[in,out]   chain points to the next unused node; nodes are chained
+ *                  through link[1].
+ *
+ * \param[in]       count is the number of nodes in the subtree.
+ *
+ * \param[in]       depth is the depth of the subtree root.
+ *
+ * \param[in]       redDepth is the depth whose nodes are red, or -1.
+ *
+ * \param[in,out]   prevNode points to the in-order predecessor of the
+ *                  subtree's first node, updated to its last node.
+ *
+ * \return          the root of the subtree, NULL if count is zero.
+ *
+ *****************************************************************************/
+static fm_treeNode *BulkBuild(fm_treeNode **chain,
+                              fm_uint        count,
+                              fm_int         depth,
+                              fm_int         redDepth,
+                              fm_treeNode ** prevNode)
+{
+    fm_treeNode *node;
+    fm_treeNode *child;
+    fm_uint      leftCount;
+
+    if (count == 0)
+    {
+        return NULL;
+    }
+
+    leftCount = (count - 1) / 2;
+
+    child = BulkBuild(chain, leftCount, depth + 1, redDepth, prevNode);
+
+    node   = *chain;
+    *chain = node->link[1];
+
+    node->red = (depth == redDepth);
+
+    if (child != NULL)
+    {
+        node->link[0]     = child;
+        node->threaded[0] = FALSE;
+    }
+    else
+    {
+        node->link[0]     = *prevNode;
+        node->threaded[0] = TRUE;
+    }
+
+    /* Provisional right thread, replaced below if there is a right
+     * subtree, or by the successor when it is linked. */
+    node->link[1]     = NULL;
+    node->threaded[1] = TRUE;
+
+    if ( (*prevNode != NULL) && (*prevNode)->threaded[1] )
+    {
+        (*prevNode)->link[1] = node;
+    }
+
+    *prevNode = node;
+
+    child = BulkBuild(chain,
+                      count - 1 - leftCount,
+                      depth + 1,
+                      redDepth,
+                      prevNode);
+
+    if (child != NULL)
+    {
+        node->link[1]     = child;
+        node->threaded[1] = FALSE;
+    }
+
+    return node;
+
+}   /* end BulkBuild */
+
+
+
+
+/*****************************************************************************/
+/** TreeBulkLoad
+ * \ingroup intTree
+ *
+ * \desc            Populates an empty tree from input that is already in
+ *                  ascending key order. Every node is allocated and filled
+ *                  before any linking takes place, so a failure leaves the
+ *                  tree empty; the tree is then linked in a single O(N)
+ *                  pass with no comparisons or rotations.
+ *
+ * \param[in]       tree is the tree to populate.
+ *
+ * \param[in]       numItems is the maximum number of items to load.
+ *
+ * \param[in]       loadFunc supplies the items.
+ *
+ * \param[in]       loadArg is passed to loadFunc.
+ *
+ * \param[in]       cmp is the comparison function, NULL for fm_uint64 keys.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_STATE if the tree is not empty.
+ * \return          FM_ERR_INVALID_ARGUMENT if the keys are out of order.
+ * \return          FM_ERR_ALREADY_EXISTS if a key is repeated.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ * \return          any other error returned by loadFunc.
+ *
+ *****************************************************************************/
+static fm_status TreeBulkLoad(fm_internalTree *tree,
+                              fm_uint          numItems,
+                              fmTreeLoadFunc   loadFunc,
+                              void *           loadArg,
+                              fmCompareFunc    cmp)
+{
+    fm_status    err;
+    fm_treeNode *chain;
+    fm_treeNode *last;
+    fm_treeNode *node;
+    fm_treeNode *prev;
+    fm_uint64    key;
+    void *       value;
+    fm_uint      count;
+    fm_uint      i;
+    fm_int       height;
+
+    if (tree->size != 0)
+    {
+        return FM_ERR_INVALID_STATE;
+    }
+
+    if (tree->btree)
+    {
+        /* Appending in key order already fills B+tree leaves left to
+         * right, so the ordinary insert path is used. */
+        for (i = 0 ; i < numItems ; i++)
+        {
+            err = loadFunc(loadArg, &key, &value);
+
+            if (err == FM_ERR_NO_MORE)
+            {
+                break;
+            }
+            else if (err == FM_OK)
+            {
+                err = TreeInsert(tree, key, value, cmp);
+            }
+
+            if (err != FM_OK)
+            {
+                BtreeDestroy(tree, NULL, NULL);
+                tree->size = 0;
+                return err;
+            }
+        }
+
+        return FM_OK;
+    }
+
+    /* Allocate all the nodes up front, chained through link[1] */
+    chain = NULL;
+    last  = NULL;
+
+    for (i = 0 ; i < numItems ; i++)
+    {
+        node = AllocNode(tree);
+
+        if (node == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            goto ABORT;
+        }
+
+        node->link[1] = NULL;
+
+        if (last == NULL)
+        {
+            chain = node;
+        }
+        else
+        {
+            last->link[1] = node;
+        }
+
+        last = node;
+    }
+
+    /* Fill them in key order */
+    count = 0;
+    last  = NULL;
+
+    for (node = chain ; node != NULL ; node = node->link[1])
+    {
+        err = loadFunc(loadArg, &key, &value);
+
+        if (err == FM_ERR_NO_MORE)
+        {
+            break;
+        }
+        else if (err != FM_OK)
+        {
+            goto ABORT;
+        }
+
+        if ( (last != NULL) && !FM_KEY_LESS(cmp, last->key, key) )
+        {
+            err = FM_KEY_EQUAL(cmp, last->key, key) ? FM_ERR_ALREADY_EXISTS
+                                                    : FM_ERR_INVALID_ARGUMENT;
+            goto ABORT;
+        }
+
+        node->key   = key;
+        node->value = value;
+        last        = node;
+        count++;
+    }
+
+    /* Release whatever the input did not use */
+    if (last != NULL)
+    {
+        node          = last->link[1];
+        last->link[1] = NULL;
+    }
+    else
+    {
+        node  = chain;
+        chain = NULL;
+    }
+
+    while (node != NULL)
+    {
+        prev = node->link[1];
+        FreeNode(tree, node);
+        node = prev;
+    }
+
+    /* The deepest level of a size-balanced tree is floor(log2(count)) */
+    height = -1;
+
+    for (i = count ; i != 0 ; i >>= 1)
+    {
+        height++;
+    }
+
+    prev = NULL;
 
-            tree->freeFunc(it);
-            --tree->size;
+    tree->serial++;
+    tree->root = BulkBuild(&chain,
+                           count,
+                           0,
+                           (height > 0) ? height : -1,
+                           &prev);
+    tree->size = count;
+
+    if (tree->insertFunc != NULL)
+    {
+        /* Report the items as if they had been inserted one by one */
+        prev = NULL;
+
+        for (node = tree->root ; (node != NULL) && !node->threaded[0] ; )
+        {
+            node = node->link[0];
         }
 
-        it = save;
+        for ( ; node != NULL ; node = Next(node, 1) )
+        {
+            tree->insertFunc(FM_CAST_64_TO_PTR(node->key),
+                             node->value,
+                             (prev != NULL) ? FM_CAST_64_TO_PTR(prev->key)
+                                            : NULL,
+                             (prev != NULL) ? prev->value : NULL,
+                             NULL,
+                             NULL);
+            prev = node;
+        }
     }
 
-    if (tree->size != 0)
+    return FM_OK;
+
+ABORT:
+
+    while (chain != NULL)
     {
-        FM_LOG_ERROR(FM_LOG_CAT_GENERAL,
-                     "Destroyed tree size (%u) != 0\n",
-                     tree->size);
+        node = chain->link[1];
+        FreeNode(tree, chain);
+        chain = node;
     }
 
-#if FM_TREE_DEBUG_CALLER
-    UpdateTreeOfTrees(tree, FALSE);
-#endif
-
-    /* this erases the signature, along with everything else */
-    FM_CLEAR(*tree);
+    return err;
 
-ABORT: 
-    return;
-}   /* end TreeDestroy */
+}   /* end TreeBulkLoad */
 
 
 
 
-static fm_status TreeClone(fm_internalTree *srcTree,
-                           fm_internalTree *dstTree,
-                           fmCloneFunc cloneFunc,
-                           void *cloneFuncArg)
+/*****************************************************************************/
+/** CustomTreeLoadThunk
+ * \ingroup intTree
+ *
+ * \desc            fmTreeLoadFunc that forwards to a custom tree's loader.
+ *
+ * \param[in]       loadArg points to the fm_customTreeLoadThunk.
+ *
+ * \param[out]      key receives the next key.
+ *
+ * \param[out]      value receives the next value.
+ *
+ * \return          whatever the custom loader returns.
+ *
+ *****************************************************************************/
+static fm_status CustomTreeLoadThunk(void *     loadArg,
+                                     fm_uint64 *key,
+                                     void **    value)
 {
-    fm_status err = FM_OK;
-
-    dstTree->serial     = srcTree->serial;
-    dstTree->size       = srcTree->size;
-    dstTree->allocFunc  = srcTree->allocFunc;
-    dstTree->freeFunc   = srcTree->freeFunc;
-    dstTree->insertFunc = srcTree->insertFunc;
-    dstTree->deleteFunc = srcTree->deleteFunc;
-    dstTree->signature  = srcTree->signature;
+    fm_customTreeLoadThunk *thunk = loadArg;
+    fm_status               err;
+    void *                  customKey = NULL;
 
-    if (srcTree->root != NULL)
-    {
-        dstTree->root = CloneNode(srcTree,
-                                  srcTree->root,
-                                  dstTree->root,
-                                  dstTree->root,
-                                  cloneFunc,
-                                  cloneFuncArg,
-                                  &err);
-        if (dstTree->root == NULL)
-        {
-            return FM_ERR_NO_MEM;
-        }
-    }
-    else
-    {
-        dstTree->root = NULL;
-    }
+    err  = thunk->loadFunc(thunk->loadArg, &customKey, value);
+    *key = FM_CAST_PTR_TO_64(customKey);
 
     return err;
 
-}   /* end TreeClone */
+}   /* end CustomTreeLoadThunk */
 
 
 
@@ -742,9 +2438,33 @@ static fm_bool TreeIsInitialized(fm_internalTree *tree)
 
 
 
+static fm_uint64 TreeMemoryUsage(fm_internalTree *tree)
+{
+    if (tree->btree)
+    {
+        if (tree->btreeRoot == NULL)
+        {
+            return 0;
+        }
+
+        return (fm_uint64) BtreeCountNodes(tree->btreeRoot) *
+               sizeof(fm_btreeNode);
+    }
+
+    return (fm_uint64) tree->size * sizeof(fm_treeNode);
+
+}   /* end TreeMemoryUsage */
+
+
+
 
 static fm_status TreeValidate(fm_internalTree *tree, fmCompareFunc cmp)
 {
+    if (tree->btree)
+    {
+        return BtreeValidate(tree, cmp);
+    }
+
     return Validate(tree->root, 0, cmp) == 0 ? FM_FAIL : FM_OK;
 
 }   /* end TreeValidate */
@@ -765,6 +2485,11 @@ static fm_status TreeInsert(fm_internalTree *tree,
     fm_status    err     = FM_ERR_ALREADY_EXISTS;
     fm_treeNode *newNode = NULL;
 
+    if (tree->btree)
+    {
+        return BtreeInsert(tree, key, value, cmp);
+    }
+
     tree->serial++;
 
     if (tree->root == NULL)
@@ -948,6 +2673,11 @@ static fm_status TreeRemove(fm_internalTree *tree,
                            err = FM_ERR_ASSERTION_FAILED, 
                            "Assertion failure in TreeRemove\n"); 
 
+    if (tree->btree)
+    {
+        return BtreeRemove(tree, key, delFunc, pairFunc, cmp);
+    }
+
     tree->serial++;
 
     if (tree->root != NULL)
@@ -1110,7 +2840,7 @@ static fm_status TreeRemove(fm_internalTree *tree,
                     q->threaded[!childDirection];
             }
 
-            tree->freeFunc(q);
+            FreeNode(tree, q);
             err = FM_OK;
             tree->size--;
         }
@@ -1144,7 +2874,24 @@ static fm_status TreeFind(fm_internalTree *tree,
                           void **          value,
                           fmCompareFunc    cmp)
 {
-    fm_treeNode *it = tree->root;
+    fm_treeNode * it = tree->root;
+    fm_btreeNode *leaf;
+    fm_int        pos;
+
+    if (tree->btree)
+    {
+        if (BtreeLocate(tree, key, cmp, &leaf, &pos) != FM_OK)
+        {
+            return FM_ERR_NOT_FOUND;
+        }
+
+        if (value)
+        {
+            *value = leaf->u.values[pos];
+        }
+
+        return FM_OK;
+    }
 
     while (it != NULL)
     {
@@ -1187,6 +2934,11 @@ static fm_status TreeFindRandom(fm_internalTree *tree,
     fm_int       curDepth;
     fm_int       i;
 
+    if (tree->btree)
+    {
+        return BtreeFindRandom(tree, key, value);
+    }
+
     maxWeight     = fmRand() % tree->size;
     highestWeight = (fmFindNextPowerOf2(tree->size) >> 1) - 1;
     curWeight     = 0;
@@ -1303,6 +3055,11 @@ static fm_status TreePredecessor(fm_internalTree *tree,
 {
     fm_treeNode *it = tree->root;
 
+    if (tree->btree)
+    {
+        return BtreeNeighbour(tree, key, nextKey, nextValue, cmp, 0);
+    }
+
     while (it != NULL)
     {
         if ( FM_KEY_EQUAL(cmp, it->key, key) )
@@ -1342,6 +3099,11 @@ static fm_status TreeSuccessor(fm_internalTree *tree,
 {
     fm_treeNode *it = tree->root;
 
+    if (tree->btree)
+    {
+        return BtreeNeighbour(tree, key, nextKey, nextValue, cmp, 1);
+    }
+
     while (it != NULL)
     {
         if ( FM_KEY_EQUAL(cmp, it->key, key) )
@@ -1375,6 +3137,12 @@ static fm_status TreeSuccessor(fm_internalTree *tree,
 
 static void TreeIterInit(fm_internalTreeIterator *it, fm_internalTree *tree)
 {
+    if (tree->btree)
+    {
+        BtreeIterInit(it, tree, 1);
+        return;
+    }
+
     it->tree   = tree;
     it->serial = tree->serial;
     it->dir    = 1;
@@ -1397,6 +3165,12 @@ static void TreeIterInit(fm_internalTreeIterator *it, fm_internalTree *tree)
 static void TreeIterInitBackwards(fm_internalTreeIterator *it,
                                   fm_internalTree *        tree)
 {
+    if (tree->btree)
+    {
+        BtreeIterInit(it, tree, 0);
+        return;
+    }
+
     it->tree   = tree;
     it->serial = tree->serial;
     it->dir    = 0;
@@ -1423,6 +3197,11 @@ static fm_status TreeIterInitFromKey(fm_internalTreeIterator *it,
 {
     fm_treeNode *node = tree->root;
 
+    if (tree->btree)
+    {
+        return BtreeIterInitFromKey(it, tree, key, cmp, 1, FALSE);
+    }
+
     it->tree   = tree;
     it->serial = tree->serial;
     it->dir    = 1;
@@ -1455,6 +3234,11 @@ static fm_status TreeIterInitFromKeyBackwards(fm_internalTreeIterator *it,
 {
     fm_treeNode *node = tree->root;
 
+    if (tree->btree)
+    {
+        return BtreeIterInitFromKey(it, tree, key, cmp, 0, FALSE);
+    }
+
     it->tree   = tree;
     it->serial = tree->serial;
     it->dir    = 0;
@@ -1487,6 +3271,11 @@ static fm_status TreeIterInitFromSuccessor(fm_internalTreeIterator *it,
 {
     fm_treeNode *node = tree->root;
 
+    if (tree->btree)
+    {
+        return BtreeIterInitFromKey(it, tree, key, cmp, 1, TRUE);
+    }
+
     it->tree   = tree;
     it->serial = tree->serial;
     it->dir    = 1;
@@ -1513,10 +3302,78 @@ static fm_status TreeIterInitFromSuccessor(fm_internalTreeIterator *it,
 
 
 
+/* Positions an ascending iterator on the smallest key above key, whether
+ * or not key itself is in the tree. */
+static void TreeIterInitAfterKey(fm_internalTreeIterator *it,
+                                 fm_internalTree *        tree,
+                                 fm_uint64                key,
+                                 fmCompareFunc            cmp)
+{
+    fm_treeNode * node;
+    fm_treeNode * above;
+    fm_btreeNode *leaf;
+    fm_int        pos;
+    fm_dir        dir;
+
+    it->tree      = tree;
+    it->serial    = tree->serial;
+    it->dir       = 1;
+    it->nextPtr   = NULL;
+    it->nextLeaf  = NULL;
+    it->nextIndex = 0;
+
+    if (tree->btree)
+    {
+        leaf = BtreeDescend(tree, key, cmp, NULL, NULL, NULL);
+
+        if (leaf != NULL)
+        {
+            pos = BtreeSearch(leaf, key, cmp, TRUE);
+
+            if (pos >= leaf->count)
+            {
+                leaf = leaf->link[1];
+                pos  = 0;
+            }
+
+            it->nextLeaf  = leaf;
+            it->nextIndex = pos;
+        }
+
+        return;
+    }
+
+    above = NULL;
+    node  = tree->root;
+
+    while (node != NULL)
+    {
+        dir = !FM_KEY_LESS(cmp, key, node->key);
+
+        if (dir == 0)
+        {
+            above = node;
+        }
+
+        node = node->threaded[dir] ? NULL : node->link[dir];
+    }
+
+    it->nextPtr = above;
+
+}   /* end TreeIterInitAfterKey */
+
+
+
+
 static fm_status TreeIterNext(fm_internalTreeIterator *it,
                               fm_uint64 *              nextKey,
                               void **                  nextValue)
 {
+    if (it->tree->btree)
+    {
+        return BtreeIterNext(it, nextKey, nextValue);
+    }
+
     if (it->nextPtr == NULL)
     {
         return FM_ERR_NO_MORE;
@@ -1564,49 +3421,198 @@ static void DbgDumpNode(fm_treeNode *node)
 
 
 
-static void TreeDbgDump(fm_internalTree *tree)
+static void TreeDbgDump(fm_internalTree *tree)
+{
+    FM_LOG_PRINT( "Dumping contents of tree %p\n", (void *) tree );
+
+    if (tree->btree)
+    {
+        if (tree->btreeRoot != NULL)
+        {
+            BtreeDbgDumpNode(tree->btreeRoot, 0);
+        }
+        return;
+    }
+
+    DbgDumpNode(tree->root);
+
+}   /* end TreeDbgDump */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fmTreeInit
+ * \ingroup intTree
+ *
+ * \desc            Initializes a user-supplied fm_tree structure to
+ *                  represent an empty tree.
+ *
+ * \param[out]      tree is the tree on which to operate
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmTreeInit(fm_tree *tree)
+{
+    TreeInit(&tree->internalTree);
+    VALIDATE_TREE(tree);
+
+}   /* end fmTreeInit */
+
+
+
+
+/*****************************************************************************/
+/** fmCustomTreeInit
+ * \ingroup intCustomTree
+ *
+ * \desc            Initializes a user-supplied fm_customTree structure to
+ *                  represent an empty tree.
+ *
+ * \param[out]      tree is the tree on which to operate
+ *
+ * \param[in]       compareFunc is the function for comparing keys
+ *                  (takes two void* arguments and returns -1, 0, or 1,
+ *                  just like the comparison function you pass to the
+ *                  C library functions qsort and bsearch)
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmCustomTreeInit(fm_customTree *tree, fmCompareFunc compareFunc)
+{
+    TreeInit(&tree->internalTree);
+    tree->internalTree.customTree = TRUE;
+    tree->compareFunc = compareFunc;
+
+    VALIDATE_CUSTOM_TREE(tree);
+
+}   /* end fmCustomTreeInit */
+
+
+
+
+/*****************************************************************************/
+/** fmTreeInitWithAllocator
+ * \ingroup intTree
+ *
+ * \desc            Initializes a user-supplied fm_tree structure to
+ *                  represent an empty tree.
+ *
+ * \note            allocFunc and freeFunc are only used for the node
+ *                  structure itself.  For freeing the value, see the
+ *                  "delFunc" argument of fmTreeRemove and fmTreeDestroy.
+ *
+ * \param[out]      tree is the tree on which to operate
+ *
+ * \param[in]       allocFunc is the function used to allocate new nodes
+ *
+ * \param[in]       freeFunc is the function used to deallocate nodes
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmTreeInitWithAllocator(fm_tree *   tree,
+                             fmAllocFunc allocFunc,
+                             fmFreeFunc  freeFunc)
+{
+    TreeInitWithAllocator(&tree->internalTree, allocFunc, freeFunc);
+    VALIDATE_TREE(tree);
+
+}   /* end fmTreeInitWithAllocator */
+
+
+
+
+/*****************************************************************************/
+/** fmCustomTreeInitWithAllocator
+ * \ingroup intCustomTree
+ *
+ * \desc            Initializes a user-supplied fm_customTree structure to
+ *                  represent an empty tree.
+ *
+ * \note            allocFunc and freeFunc are only used for the node
+ *                  structure itself.  For freeing the value, see the
+ *                  "delFunc" argument of fmCustomTreeRemove and
+ *                  fmCustomTreeDestroy.
+ *
+ * \param[out]      tree is the tree on which to operate
+ *
+ * \param[in]       compareFunc is the function for comparing keys
+ *                  (takes two void* arguments and returns -1, 0, or 1,
+ *                  just like the comparison function you pass to the
+ *                  C library functions qsort and bsearch)
+ *
+ * \param[in]       allocFunc is the function used to allocate new nodes
+ *
+ * \param[in]       freeFunc is the function used to deallocate nodes
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmCustomTreeInitWithAllocator(fm_customTree *tree,
+                                   fmCompareFunc  compareFunc,
+                                   fmAllocFunc    allocFunc,
+                                   fmFreeFunc     freeFunc)
 {
-    FM_LOG_PRINT( "Dumping contents of tree %p\n", (void *) tree );
-
-    DbgDumpNode(tree->root);
+    TreeInitWithAllocator(&tree->internalTree, allocFunc, freeFunc);
+    tree->internalTree.customTree = TRUE;
+    tree->compareFunc = compareFunc;
 
-}   /* end TreeDbgDump */
+    VALIDATE_CUSTOM_TREE(tree);
 
+}   /* end fmCustomTreeInitWithAllocator */
 
 
 
-/*****************************************************************************
- * Public Functions
- *****************************************************************************/
 
 /*****************************************************************************/
-/** fmTreeInit
+/** fmTreeInitWithArena
  * \ingroup intTree
  *
  * \desc            Initializes a user-supplied fm_tree structure to
- *                  represent an empty tree.
+ *                  represent an empty tree whose nodes are allocated
+ *                  from an arena.
+ *
+ * \note            Nodes are only released with the arena, so removing
+ *                  entries does not return memory. Destroying the tree
+ *                  without a delFunc does not visit the nodes. The tree
+ *                  must be destroyed (or no longer used) before the arena
+ *                  is reset. Clones of the tree share its arena.
  *
  * \param[out]      tree is the tree on which to operate
  *
+ * \param[in]       arena is the arena to allocate nodes from.
+ *
  * \return          None
  *
  *****************************************************************************/
-void fmTreeInit(fm_tree *tree)
+void fmTreeInitWithArena(fm_tree *tree, fm_arena *arena)
 {
     TreeInit(&tree->internalTree);
+    tree->internalTree.arena = arena;
+
     VALIDATE_TREE(tree);
 
-}   /* end fmTreeInit */
+}   /* end fmTreeInitWithArena */
 
 
 
 
 /*****************************************************************************/
-/** fmCustomTreeInit
+/** fmCustomTreeInitWithArena
  * \ingroup intCustomTree
  *
  * \desc            Initializes a user-supplied fm_customTree structure to
- *                  represent an empty tree.
+ *                  represent an empty tree whose nodes are allocated
+ *                  from an arena.
+ *
+ * \note            See the notes of ''fmTreeInitWithArena''.
  *
  * \param[out]      tree is the tree on which to operate
  *
@@ -1615,65 +3621,70 @@ void fmTreeInit(fm_tree *tree)
  *                  just like the comparison function you pass to the
  *                  C library functions qsort and bsearch)
  *
+ * \param[in]       arena is the arena to allocate nodes from.
+ *
  * \return          None
  *
  *****************************************************************************/
-void fmCustomTreeInit(fm_customTree *tree, fmCompareFunc compareFunc)
+void fmCustomTreeInitWithArena(fm_customTree *tree,
+                               fmCompareFunc  compareFunc,
+                               fm_arena *     arena)
 {
     TreeInit(&tree->internalTree);
+    tree->internalTree.arena      = arena;
     tree->internalTree.customTree = TRUE;
-    tree->compareFunc = compareFunc;
+    tree->compareFunc             = compareFunc;
 
     VALIDATE_CUSTOM_TREE(tree);
 
-}   /* end fmCustomTreeInit */
+}   /* end fmCustomTreeInitWithArena */
 
 
 
 
 /*****************************************************************************/
-/** fmTreeInitWithAllocator
+/** fmTreeInitBtree
  * \ingroup intTree
  *
  * \desc            Initializes a user-supplied fm_tree structure to
- *                  represent an empty tree.
+ *                  represent an empty tree stored as a B+tree.
  *
- * \note            allocFunc and freeFunc are only used for the node
- *                  structure itself.  For freeing the value, see the
- *                  "delFunc" argument of fmTreeRemove and fmTreeDestroy.
+ * \note            A B+tree keeps many keys and values inline in each
+ *                  node and links its leaves in key order, so lookups
+ *                  and iteration over large trees touch far fewer cache
+ *                  lines than the default red-black tree. It is used
+ *                  through the same functions as any other fm_tree.
+ *                  Insertion and removal move entries within a node, so
+ *                  prefer it for large trees that are mostly searched
+ *                  and iterated.
  *
  * \param[out]      tree is the tree on which to operate
  *
- * \param[in]       allocFunc is the function used to allocate new nodes
- *
- * \param[in]       freeFunc is the function used to deallocate nodes
- *
  * \return          None
  *
  *****************************************************************************/
-void fmTreeInitWithAllocator(fm_tree *   tree,
-                             fmAllocFunc allocFunc,
-                             fmFreeFunc  freeFunc)
+void fmTreeInitBtree(fm_tree *tree)
 {
-    TreeInitWithAllocator(&tree->internalTree, allocFunc, freeFunc);
+    TreeInit(&tree->internalTree);
+    tree->internalTree.btree = TRUE;
+
     VALIDATE_TREE(tree);
 
-}   /* end fmTreeInitWithAllocator */
+}   /* end fmTreeInitBtree */
 
 
 
 
 /*****************************************************************************/
-/** fmCustomTreeInitWithAllocator
+/** fmCustomTreeInitBtree
  * \ingroup intCustomTree
  *
  * \desc            Initializes a user-supplied fm_customTree structure to
- *                  represent an empty tree.
+ *                  represent an empty tree stored as a B+tree.
  *
- * \note            allocFunc and freeFunc are only used for the node
- *                  structure itself.  For freeing the value, see the
- *                  "delFunc" argument of fmCustomTreeRemove and
- *                  fmCustomTreeDestroy.
+ * \note            See the notes of ''fmTreeInitBtree''. Only the key
+ *                  pointers are stored in the tree, so the comparison
+ *                  function still dereferences each key it compares.
  *
  * \param[out]      tree is the tree on which to operate
  *
@@ -1682,25 +3693,19 @@ void fmTreeInitWithAllocator(fm_tree *   tree,
  *                  just like the comparison function you pass to the
  *                  C library functions qsort and bsearch)
  *
- * \param[in]       allocFunc is the function used to allocate new nodes
- *
- * \param[in]       freeFunc is the function used to deallocate nodes
- *
  * \return          None
  *
  *****************************************************************************/
-void fmCustomTreeInitWithAllocator(fm_customTree *tree,
-                                   fmCompareFunc  compareFunc,
-                                   fmAllocFunc    allocFunc,
-                                   fmFreeFunc     freeFunc)
+void fmCustomTreeInitBtree(fm_customTree *tree, fmCompareFunc compareFunc)
 {
-    TreeInitWithAllocator(&tree->internalTree, allocFunc, freeFunc);
+    TreeInit(&tree->internalTree);
+    tree->internalTree.btree      = TRUE;
     tree->internalTree.customTree = TRUE;
-    tree->compareFunc = compareFunc;
+    tree->compareFunc             = compareFunc;
 
     VALIDATE_CUSTOM_TREE(tree);
 
-}   /* end fmCustomTreeInitWithAllocator */
+}   /* end fmCustomTreeInitBtree */
 
 
 
@@ -1835,6 +3840,112 @@ fm_status fmTreeClone(fm_tree *srcTree,
 
 
 
+/*****************************************************************************/
+/** fmTreeBulkLoad
+ * \ingroup intTree
+ *
+ * \desc            Builds a tree from items supplied in ascending key order,
+ *                  in time linear in the number of items. This is much
+ *                  cheaper than inserting the same items one at a time when
+ *                  a table is being rebuilt from an already sorted source.
+ *
+ * \param[in]       tree is the tree to populate. It must be initialized and
+ *                  empty.
+ *
+ * \param[in]       numItems is the number of items to load. loadFunc is
+ *                  called at most this many times; if it returns
+ *                  FM_ERR_NO_MORE earlier, the items supplied so far are
+ *                  loaded.
+ *
+ * \param[in]       loadFunc is called to obtain each key/value pair. Keys
+ *                  must be strictly ascending.
+ *
+ * \param[in]       loadArg is the first parameter of the loadFunc function.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNINITIALIZED if the tree is not initialized.
+ * \return          FM_ERR_INVALID_STATE if the tree is not empty.
+ * \return          FM_ERR_INVALID_ARGUMENT if the keys are out of order.
+ * \return          FM_ERR_ALREADY_EXISTS if a key is repeated.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ *
+ *****************************************************************************/
+fm_status fmTreeBulkLoad(fm_tree *      tree,
+                         fm_uint        numItems,
+                         fmTreeLoadFunc loadFunc,
+                         void *         loadArg)
+{
+    fm_status err;
+
+    FM_CHECK_SIGNATURE(FM_ERR_UNINITIALIZED);
+
+    err = TreeBulkLoad(&tree->internalTree, numItems, loadFunc, loadArg, NULL);
+
+    VALIDATE_TREE(tree);
+    return err;
+
+}   /* end fmTreeBulkLoad */
+
+
+
+
+/*****************************************************************************/
+/** fmCustomTreeBulkLoad
+ * \ingroup intCustomTree
+ *
+ * \desc            Builds a custom tree from items supplied in ascending key
+ *                  order, as defined by the tree's comparison function, in
+ *                  time linear in the number of items. Insert callbacks
+ *                  requested with ''fmCustomTreeRequestCallbacks'' are made
+ *                  in key order once the tree is built.
+ *
+ * \param[in]       tree is the tree to populate. It must be initialized and
+ *                  empty.
+ *
+ * \param[in]       numItems is the number of items to load. loadFunc is
+ *                  called at most this many times; if it returns
+ *                  FM_ERR_NO_MORE earlier, the items supplied so far are
+ *                  loaded.
+ *
+ * \param[in]       loadFunc is called to obtain each key/value pair.
+ *
+ * \param[in]       loadArg is the first parameter of the loadFunc function.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNINITIALIZED if the tree is not initialized.
+ * \return          FM_ERR_INVALID_STATE if the tree is not empty.
+ * \return          FM_ERR_INVALID_ARGUMENT if the keys are out of order.
+ * \return          FM_ERR_ALREADY_EXISTS if a key is repeated.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ *
+ *****************************************************************************/
+fm_status fmCustomTreeBulkLoad(fm_customTree *      tree,
+                               fm_uint              numItems,
+                               fmCustomTreeLoadFunc loadFunc,
+                               void *               loadArg)
+{
+    fm_customTreeLoadThunk thunk;
+    fm_status              err;
+
+    FM_CHECK_SIGNATURE(FM_ERR_UNINITIALIZED);
+
+    thunk.loadFunc = loadFunc;
+    thunk.loadArg  = loadArg;
+
+    err = TreeBulkLoad(&tree->internalTree,
+                       numItems,
+                       CustomTreeLoadThunk,
+                       &thunk,
+                       tree->compareFunc);
+
+    VALIDATE_CUSTOM_TREE(tree);
+    return err;
+
+}   /* end fmCustomTreeBulkLoad */
+
+
+
+
 /*****************************************************************************/
 /** fmTreeSize
  * \ingroup intTree
@@ -1858,6 +3969,31 @@ fm_uint fmTreeSize(fm_tree *tree)
 
 
 
+/*****************************************************************************/
+/** fmTreeGeneration
+ * \ingroup intTree
+ *
+ * \desc            Returns the generation of the tree, which changes
+ *                  whenever an item is inserted or removed. A saved
+ *                  iterator is only valid while the generation is
+ *                  unchanged.
+ *
+ * \param[in]       tree is the tree on which to operate.
+ *
+ * \return          the generation of the tree.
+ *
+ *****************************************************************************/
+fm_uint fmTreeGeneration(fm_tree *tree)
+{
+    FM_CHECK_SIGNATURE(0);
+
+    return tree->internalTree.serial;
+
+}   /* end fmTreeGeneration */
+
+
+
+
 /*****************************************************************************/
 /** fmTreeIsInitialized
  * \ingroup intTree
@@ -1878,6 +4014,29 @@ fm_bool fmTreeIsInitialized(fm_tree *tree)
 
 
 
+/*****************************************************************************/
+/** fmTreeMemoryUsage
+ * \ingroup intTree
+ *
+ * \desc            Returns the number of bytes of node storage used by the
+ *                  tree, not counting the keys and values it points to.
+ *
+ * \param[in]       tree is the tree on which to operate.
+ *
+ * \return          the number of bytes used by the tree's nodes.
+ *
+ *****************************************************************************/
+fm_uint64 fmTreeMemoryUsage(fm_tree *tree)
+{
+    FM_CHECK_SIGNATURE(0);
+
+    return TreeMemoryUsage(&tree->internalTree);
+
+}   /* end fmTreeMemoryUsage */
+
+
+
+
 /*****************************************************************************/
 /** fmCustomTreeSize
  * \ingroup intCustomTree
@@ -1900,6 +4059,29 @@ fm_uint fmCustomTreeSize(fm_customTree *tree)
 
 
 
+
+/*****************************************************************************/
+/** fmCustomTreeGeneration
+ * \ingroup intCustomTree
+ *
+ * \desc            Returns the generation of the tree, which changes
+ *                  whenever an item is inserted or removed.
+ *
+ * \param[in]       tree is the tree on which to operate.
+ *
+ * \return          the generation of the tree.
+ *
+ *****************************************************************************/
+fm_uint fmCustomTreeGeneration(fm_customTree *tree)
+{
+    FM_CHECK_SIGNATURE(0);
+
+    return tree->internalTree.serial;
+
+}   /* end fmCustomTreeGeneration */
+
+
+
 /*****************************************************************************/
 /** fmCustomTreeIsInitialized
  * \ingroup intTree
@@ -1920,6 +4102,28 @@ fm_bool fmCustomTreeIsInitialized(fm_customTree *tree)
 
 
 
+/*****************************************************************************/
+/** fmCustomTreeMemoryUsage
+ * \ingroup intCustomTree
+ *
+ * \desc            Returns the number of bytes of node storage used by the
+ *                  tree, not counting the keys and values it points to.
+ *
+ * \param[in]       tree is the tree on which to operate.
+ *
+ * \return          the number of bytes used by the tree's nodes.
+ *
+ *****************************************************************************/
+fm_uint64 fmCustomTreeMemoryUsage(fm_customTree *tree)
+{
+    FM_CHECK_SIGNATURE(0);
+
+    return TreeMemoryUsage(&tree->internalTree);
+
+}   /* end fmCustomTreeMemoryUsage */
+
+
+
 /*****************************************************************************/
 /** fmTreeValidate
  * \ingroup intTree
@@ -2853,6 +5057,79 @@ fm_status fmCustomTreeIterInitFromSuccessor(fm_customTreeIterator *it,
 
 
 
+/*****************************************************************************/
+/** fmTreeIterInitAfterKey
+ * \ingroup intTree
+ *
+ * \desc            Initializes the user-supplied iterator structure to
+ *                  iterate over the tree in ascending key order, starting
+ *                  with the smallest key in the tree which is greater
+ *                  than the specified key. Unlike
+ *                  ''fmTreeIterInitFromSuccessor'', key need not be in the
+ *                  tree, so a walk can be resumed after its last key has
+ *                  been removed.
+ *
+ * \param[out]      it is the iterator.
+ *
+ * \param[in]       tree is the tree on which to operate.
+ *
+ * \param[in]       key is the starting point.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmTreeIterInitAfterKey(fm_treeIterator *it,
+                            fm_tree *        tree,
+                            fm_uint64        key)
+{
+    FM_CHECK_SIGNATURE();
+    VALIDATE_TREE(tree);
+
+    TreeIterInitAfterKey(&it->internalIterator,
+                         &tree->internalTree,
+                         key,
+                         NULL);
+
+}   /* end fmTreeIterInitAfterKey */
+
+
+
+
+/*****************************************************************************/
+/** fmCustomTreeIterInitAfterKey
+ * \ingroup intCustomTree
+ *
+ * \desc            Initializes the user-supplied iterator structure to
+ *                  iterate over the tree in ascending key order, starting
+ *                  with the smallest key in the tree which is greater
+ *                  than the specified key, which need not be in the tree.
+ *
+ * \param[out]      it is the iterator.
+ *
+ * \param[in]       tree is the tree on which to operate.
+ *
+ * \param[in]       key is the starting point.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmCustomTreeIterInitAfterKey(fm_customTreeIterator *it,
+                                  fm_customTree *        tree,
+                                  const void *           key)
+{
+    FM_CHECK_SIGNATURE();
+    VALIDATE_CUSTOM_TREE(tree);
+
+    TreeIterInitAfterKey(&it->internalIterator,
+                         &tree->internalTree,
+                         FM_CAST_PTR_TO_64(key),
+                         tree->compareFunc);
+
+}   /* end fmCustomTreeIterInitAfterKey */
+
+
+
+
 /*****************************************************************************/
 /** fmTreeIterNext
  * \ingroup intTree
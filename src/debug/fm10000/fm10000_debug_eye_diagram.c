@@ -38,6 +38,9 @@
  * Macros, Constants & Types
  *****************************************************************************/
 
+/* Lanes measured at once on each sBus ring when the caller gives no limit */
+#define EYE_METRICS_DEFAULT_LANES_PER_RING  8
+
 
 /*****************************************************************************
  * Global Variables
@@ -329,3 +332,149 @@ fm_status fm10000DbgDeleteEyeDiagram( fm_eyeDiagramSample *sampleTable )
 }   /* end fm10000DbgDeleteEyeDiagram */
 
 
+
+
+/*****************************************************************************/
+/** fm10000DbgTakeEyeMetrics
+ * \ingroup intDiagEye
+ *
+ * \chips           FM10000
+ *
+ * \desc            Measures the eye height of every active SerDes of the
+ *                  switch. Lanes are processed in batches holding up to
+ *                  maxLanesPerRing SerDes of the EPL ring and as many of the
+ *                  PCIe ring; within a batch the SPICO measurements run in
+ *                  parallel. The callback is invoked for each lane as soon
+ *                  as its batch completes.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       maxLanesPerRing is the maximum number of lanes measured
+ *                  at once on each ring. Zero or a negative value selects
+ *                  a default of EYE_METRICS_DEFAULT_LANES_PER_RING.
+ *
+ * \param[in]       callback is the function called with each lane's metrics.
+ *
+ * \param[in]       callbackInfo is a cookie to be passed to the callback
+ *                  function.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if callback is NULL.
+ * \return          FM_FAIL if the callback stopped the capture.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+fm_status fm10000DbgTakeEyeMetrics(fm_int               sw,
+                                   fm_int               maxLanesPerRing,
+                                   fm_eyeMetricCallback callback,
+                                   fm_voidptr           callbackInfo)
+{
+    fm_status    err;
+    fm_int       eplList[FM10000_NUM_SERDES];
+    fm_int       pcieList[FM10000_NUM_SERDES];
+    fm_int       batch[FM10000_NUM_SERDES];
+    fm_int       eyeScore[FM10000_NUM_SERDES];
+    fm_int       heightmV[FM10000_NUM_SERDES];
+    fm_status    laneErr[FM10000_NUM_SERDES];
+    fm_int       numEpl;
+    fm_int       numPcie;
+    fm_int       eplNext;
+    fm_int       pcieNext;
+    fm_int       numBatch;
+    fm_int       numLanes;
+    fm_int       serdes;
+    fm_int       height;
+    fm_int       i;
+    fm_eyeMetric metric;
+
+    if ( callback == NULL )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    if ( maxLanesPerRing <= 0 )
+    {
+        maxLanesPerRing = EYE_METRICS_DEFAULT_LANES_PER_RING;
+    }
+
+    numEpl  = 0;
+    numPcie = 0;
+
+    for (serdes = 0 ; serdes < FM10000_NUM_SERDES ; serdes++)
+    {
+        if ( !fm10000SerdesCheckIfIsActive(sw, serdes) )
+        {
+            continue;
+        }
+
+        if ( serdes < FM10000_EPL_RING_SERDES_NUM )
+        {
+            eplList[numEpl++] = serdes;
+        }
+        else
+        {
+            pcieList[numPcie++] = serdes;
+        }
+    }
+
+    numLanes = numEpl + numPcie;
+    eplNext  = 0;
+    pcieNext = 0;
+    err      = FM_OK;
+
+    while ( eplNext < numEpl || pcieNext < numPcie )
+    {
+        numBatch = 0;
+
+        for (i = 0 ; i < maxLanesPerRing && eplNext < numEpl ; i++)
+        {
+            batch[numBatch++] = eplList[eplNext++];
+        }
+
+        for (i = 0 ; i < maxLanesPerRing && pcieNext < numPcie ; i++)
+        {
+            batch[numBatch++] = pcieList[pcieNext++];
+        }
+
+        err = fm10000SerdesGetEyeHeightBatch(sw,
+                                             numBatch,
+                                             batch,
+                                             eyeScore,
+                                             heightmV,
+                                             laneErr);
+        FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_PORT, err );
+
+        for (i = 0 ; i < numBatch ; i++)
+        {
+            metric.serdes   = batch[i];
+            metric.eyeScore = eyeScore[i];
+            metric.heightmV = heightmV[i];
+            metric.status   = laneErr[i];
+
+            if ( fm10000MapSerdesToLogicalPort(sw,
+                                               batch[i],
+                                               &metric.port) != FM_OK )
+            {
+                metric.port = -1;
+            }
+
+            if ( fm10000SerDesGetEyeHeightWidth(sw,
+                                                batch[i],
+                                                &height,
+                                                &metric.width) != FM_OK )
+            {
+                metric.width = -1;
+            }
+
+            if ( !callback(sw, numLanes, &metric, callbackInfo) )
+            {
+                err = FM_FAIL;
+                FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_PORT, err );
+            }
+        }
+    }
+
+ABORT:
+    return err;
+
+}   /* end fm10000DbgTakeEyeMetrics */
@@ -505,3 +505,145 @@ void fm10000DbgDumpMACTableEntry(fm_int sw, fm_macaddr address, fm_uint16 vlan)
 }   /* end fm10000DbgDumpMACTableEntry */
 
 
+
+
+
+
+/*****************************************************************************/
+/** fm10000DbgInjectMACTableEvents
+ * \ingroup intDiagMATable
+ *
+ * \desc            Appends synthetic NewSource entries to the MA Table
+ *                  Change Notification (TCN) FIFO, as the hardware does
+ *                  when it learns source addresses, so that the MAC
+ *                  maintenance path can be exercised at scale. The
+ *                  entries are written to the FIFO memory at the tail
+ *                  pointer, which is then advanced.
+ *                                                                      \lb\lb
+ *                  The FIFO is not serviced by this function; the caller
+ *                  requests that with FM_UPD_SERVICE_MAC_FIFO.
+ *
+ * \note            Only meaningful when the registers are simulated
+ *                  (regAccess "SIM"): on a switch, the hardware owns the
+ *                  FIFO tail pointer.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       firstAddress is the MAC address of the first entry.
+ *                  Each following entry uses the next address.
+ *
+ * \param[in]       vlanID is the VLAN the addresses are learned on.
+ *
+ * \param[in]       port is the logical port the addresses are learned on.
+ *
+ * \param[in]       numEntries is the number of entries to append.
+ *
+ * \param[out]      numInjected points to caller-allocated storage where
+ *                  the number of entries appended is written. It is less
+ *                  than numEntries if the FIFO filled up.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if numEntries is negative or
+ *                  numInjected is NULL.
+ * \return          FM_ERR_INVALID_PORT if port has no glort.
+ *
+ *****************************************************************************/
+fm_status fm10000DbgInjectMACTableEvents(fm_int     sw,
+                                         fm_macaddr firstAddress,
+                                         fm_uint16  vlanID,
+                                         fm_int     port,
+                                         fm_int     numEntries,
+                                         fm_int *   numInjected)
+{
+    fm_switch * switchPtr;
+    fm_uint32   tcnEntry[FM10000_MA_TCN_FIFO_WIDTH];
+    fm_uint32   tcnHead;
+    fm_uint32   tcnTail;
+    fm_uint32   head;
+    fm_uint32   tail;
+    fm_uint32   glort;
+    fm_int      physPort;
+    fm_int      i;
+    fm_status   status;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_DEBUG,
+                 "sw=%d firstAddress=%012llx vlanID=%u port=%d "
+                 "numEntries=%d\n",
+                 sw,
+                 firstAddress,
+                 vlanID,
+                 port,
+                 numEntries);
+
+    if (numEntries < 0 || numInjected == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    switchPtr    = GET_SWITCH_PTR(sw);
+    *numInjected = 0;
+
+    status = fmGetLogicalPortGlort(sw, port, &glort);
+    if (status != FM_OK)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_ERR_INVALID_PORT);
+    }
+
+    /* Remote and LAG ports have no physical port: report port 0 */
+    if (fmMapLogicalPortToPhysical(switchPtr, port, &physPort) != FM_OK)
+    {
+        physPort = 0;
+    }
+
+    TAKE_REG_LOCK(sw);
+
+    status = switchPtr->ReadUINT32(sw, FM10000_MA_TCN_PTR_HEAD(), &tcnHead);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_DEBUG, status);
+
+    status = switchPtr->ReadUINT32(sw, FM10000_MA_TCN_PTR_TAIL(), &tcnTail);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_DEBUG, status);
+
+    head = FM_GET_FIELD(tcnHead, FM10000_MA_TCN_PTR_HEAD, Head);
+    tail = FM_GET_FIELD(tcnTail, FM10000_MA_TCN_PTR_TAIL, Tail);
+
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        /* One slot stays empty, to tell a full FIFO from an empty one */
+        if ( ( (tail + 1) & (FM10000_MA_TCN_FIFO_ENTRIES - 1) ) == head )
+        {
+            break;
+        }
+
+        FM_CLEAR(tcnEntry);
+        FM_ARRAY_SET_FIELD64(tcnEntry,
+                             FM10000_MA_TCN_DEQUEUE,
+                             MACAddress,
+                             firstAddress + i);
+        FM_ARRAY_SET_FIELD(tcnEntry, FM10000_MA_TCN_DEQUEUE, VID, vlanID);
+        FM_ARRAY_SET_FIELD(tcnEntry, FM10000_MA_TCN_DEQUEUE, srcGlort, glort);
+        FM_ARRAY_SET_FIELD(tcnEntry, FM10000_MA_TCN_DEQUEUE, Port, physPort);
+        FM_ARRAY_SET_BIT(tcnEntry, FM10000_MA_TCN_DEQUEUE, EntryType, 0);
+        FM_ARRAY_SET_BIT(tcnEntry, FM10000_MA_TCN_DEQUEUE, Valid, 1);
+
+        status = switchPtr->WriteUINT32Mult(sw,
+                                            FM10000_MA_TCN_FIFO(tail, 0),
+                                            FM10000_MA_TCN_FIFO_WIDTH,
+                                            tcnEntry);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_DEBUG, status);
+
+        tail = (tail + 1) & (FM10000_MA_TCN_FIFO_ENTRIES - 1);
+    }
+
+    FM_SET_FIELD(tcnTail, FM10000_MA_TCN_PTR_TAIL, Tail, tail);
+
+    status = switchPtr->WriteUINT32(sw, FM10000_MA_TCN_PTR_TAIL(), tcnTail);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_DEBUG, status);
+
+    *numInjected = i;
+
+ABORT:
+    DROP_REG_LOCK(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_DEBUG, status);
+
+}   /* end fm10000DbgInjectMACTableEvents */
@@ -64,6 +64,9 @@
 #define CHANNEL_BIT_MASK                3
 #define MAX_WORD_PER_REG                16
 
+/* Number of words fetched per bulk read when taking a snapshot */
+#define SNAPSHOT_READ_WORDS             256
+
 #define REG_NAME_PREFIX                 "FM10000_"
 #define REG_NAME_PREFIX_LEN             8
 
@@ -87,6 +90,43 @@
 
 #define MAX_STR_LEN                     80
 
+/* Register stream file identification, see fm10000DbgStreamRegisters */
+#define REG_STREAM_FILE_MAGIC           0x46525354  /* "FRST" */
+#define REG_STREAM_FILE_VERSION         1
+
+/* Size of the stdio buffer used when writing a register stream */
+#define REG_STREAM_BUFFER_SIZE          (1024 * 1024)
+
+/* Binary register stream file header */
+typedef struct
+{
+    fm_uint32 magic;
+    fm_uint32 version;
+    fm_int32  sw;
+    fm_int32  regTableSize;
+    fm_uint32 numRecords;
+
+} regStreamHeader;
+
+/* Binary register stream record, one per group of up to four words */
+typedef struct
+{
+    fm_uint32 address;
+    fm_int32  regId;
+    fm_int32  wordCount;
+    fm_uint32 words[4];
+
+} regStreamRecord;
+
+/* State of a register stream, passed as the dump callback cookie */
+typedef struct
+{
+    FILE *                fp;
+    fm_dbgRegStreamFormat format;
+    fm_uint32             numRecords;
+
+} regStreamState;
+
 /*****************************************************************************
  * Local Variables
  *****************************************************************************/
@@ -1841,240 +1881,781 @@ fm_status fm10000DbgDumpRegisterFieldInt(fm_text registerName, fm_uint32 *value)
 
 
 
-/*****************************************************************************
- * Public Functions
- *****************************************************************************/
-
-
 /*****************************************************************************/
-/** fm10000DbgListRegisters
+/** RegisterContainsOffset
  * \ingroup intDiagReg
  *
- * \desc            Display a list of switch registers that may be displayed
- *                  by calling fmDbgDumpRegister.
- *
- * \param[in]       sw is the switch number
+ * \desc            Determines whether an offset from the base address of a
+ *                  register table entry falls within the register.
  *
- * \param[in]       showGlobals should be TRUE to include all global registers
- *                  in the list.
+ * \param[in]       pReg points to the register table entry.
  *
- * \param[in]       showPorts should be TRUE to include all port registers
- *                  in the list.
+ * \param[in]       offset is the offset from the register base address.
  *
- * \return          None.
+ * \return          TRUE if the offset addresses a word of the register.
  *
  *****************************************************************************/
-void fm10000DbgListRegisters(fm_int sw, fm_bool showGlobals, fm_bool showPorts)
+static fm_bool RegisterContainsOffset(const fm10000DbgFulcrumRegister *pReg,
+                                      fm_uint                          offset)
 {
-    const fm10000DbgFulcrumRegister *pReg;
-    fm_char registerName[MAX_REGISTER_NAME_LENGTH];
-
-    FM_NOT_USED(sw);
+    fm_int  step[3];
+    fm_int  min[3];
+    fm_int  max[3];
+    fm_int  numDims;
+    fm_int  index;
+    fm_int  tmp;
+    fm_int  i;
+    fm_int  j;
 
-    if (showGlobals)
+    switch (pReg->accessMethod)
     {
-        pReg = fm10000RegisterTable;
+        case SCALAR:
+            return (offset == 0);
 
-        FM_LOG_PRINT("\nGlobal Register List\n");
-        FM_LOG_PRINT("Name                                     Length  "
-                     "Min Index0   Max Index0   Min Index1   "
-                     "Max Index1   Min Index2   Max Index2\n");
+        case MULTIWRD:
+            return ( offset < (fm_uint) pReg->wordcount );
 
-        while (pReg->regname != NULL)
-        {
-            if ( !(pReg->flags & REG_FLAG_PER_PORT) &&
-                 !(pReg->flags & REG_FLAG_END_OF_REGS) )
-            {
-                FM_LOG_PRINT("%-41s  %-2d",
-                             pReg->regname, pReg->wordcount);
+        case INDEXED:
+        case MWINDEX:
+            numDims = 1;
+            break;
 
-                if ( (pReg->indexMax0 != 0) || 
-                     (pReg->indexMax1 != 0) ||
-                     (pReg->indexMax2 != 0) )
-                {
-                    FM_LOG_PRINT("      %-10d   %-10d   %-10d   %-10d   %-10d   %d", 
-                                 pReg->indexMin0, 
-                                 pReg->indexMax0, 
-                                 pReg->indexMin1, 
-                                 pReg->indexMax1,
-                                 pReg->indexMin2, 
-                                 pReg->indexMax2);
-                }
+        case DBLINDEX:
+        case MWDBLIDX:
+            numDims = 2;
+            break;
 
-                FM_LOG_PRINT("\n");
-            }
+        case TPLINDEX:
+        case MWTPLIDX:
+            numDims = 3;
+            break;
 
-            ++pReg;
+        default:
+            /* Composite and pseudo-registers have no address of their own */
+            return FALSE;
+    }
+
+    step[0] = pReg->indexStep0;
+    step[1] = pReg->indexStep1;
+    step[2] = pReg->indexStep2;
+    min[0]  = pReg->indexMin0;
+    min[1]  = pReg->indexMin1;
+    min[2]  = pReg->indexMin2;
+    max[0]  = pReg->indexMax0;
+    max[1]  = pReg->indexMax1;
+    max[2]  = pReg->indexMax2;
+
+    /* Sort the dimensions by decreasing index step */
+    for (i = 1 ; i < numDims ; i++)
+    {
+        for (j = i ; (j > 0) && (step[j] > step[j - 1]) ; j--)
+        {
+            tmp = step[j]; step[j] = step[j - 1]; step[j - 1] = tmp;
+            tmp = min[j];  min[j]  = min[j - 1];  min[j - 1]  = tmp;
+            tmp = max[j];  max[j]  = max[j - 1];  max[j - 1]  = tmp;
         }
     }
 
-    if (showPorts)
+    for (i = 0 ; i < numDims ; i++)
     {
-        pReg = fm10000RegisterTable;
+        if (step[i] <= 0)
+        {
+            return FALSE;
+        }
 
-        FM_LOG_PRINT("\nPort Register List\n");
-        FM_LOG_PRINT("Name                                     Length  "
-                     "Min Index0   Max Index0   Min Index1   "
-                     "Max Index1   Min Index2   Max Index2\n");
+        index = offset / step[i];
 
-        while (pReg->regname != NULL)
+        if ( (index < min[i]) || (index > max[i]) )
         {
-            if (pReg->flags & REG_FLAG_PER_PORT)
-            {
-                FM_LOG_PRINT("%-41s  %-2d      %-10d   %-10d   %-10d   "
-                             "%-10d   %-10d   %d\n",
-                             pReg->regname, 
-                             pReg->wordcount, 
-                             pReg->indexMin0, 
-                             pReg->indexMax0, 
-                             pReg->indexMin1, 
-                             pReg->indexMax1,
-                             pReg->indexMin2, 
-                             pReg->indexMax2);
+            return FALSE;
+        }
 
-                /**************************************************
-                 * If this is a register that is indexed by EPL and
-                 * channel, list it again with the special suffix
-                 * indicating it can be indexed by logical port
-                 * as well.
-                 *
-                 * The min and max values won't be exactly right
-                 * since they depend on the logical port map.
-                 * Just use the internal port range.
-                 **************************************************/
+        offset -= index * step[i];
+    }
 
-                if (pReg->flags & 
-                    (REG_FLAG_INDEX0_CHAN_1_EPL | REG_FLAG_INDEX0_PER_EPL))
-                {
-                    /* Copy the register name locally so that we can ...*/
-                    FM_STRCPY_S( registerName,
-                                 sizeof(registerName),
-                                 pReg->regname );
+    return ( offset < (fm_uint) pReg->wordcount );
 
-                    /* ...append the suffix to it. */
-                    FM_STRCAT_S( registerName,
-                                 sizeof(registerName),
-                                 regNameSuffixStr );
+}   /* end RegisterContainsOffset */
 
-                    FM_LOG_PRINT("%-41s  %d       %-10d   %-10d   %-10d   %-10d   %-10d   %d\n",
-                                 registerName, 
-                                 pReg->wordcount,
-                                 MIN_LOGICAL_PORT_INDEX,
-                                 MAX_LOGICAL_PORT_INDEX, 
-                                 0,
-                                 0,
-                                 0,
-                                 0);
 
-                }   /* end if (pReg->flags & REG_FLAG_INDEX0_CHAN_1_EPL ...) */
 
-            }   /* end if (pReg->flags & REG_FLAG_PER_PORT) */
 
-            ++pReg;
+/*****************************************************************************/
+/** IsBulkReadableRegister
+ * \ingroup intDiagReg
+ *
+ * \desc            Tells whether a register may be read with multi-word
+ *                  reads at all, regardless of the layout of its entries.
+ *
+ * \note            PCIe space is excluded since it depends on the PEP state
+ *                  and is validated word by word by IsInvalidPepAddress.
+ *
+ * \param[in]       pReg points to the register table entry.
+ *
+ * \return          TRUE if the register can be read in bulk.
+ *
+ *****************************************************************************/
+static fm_bool IsBulkReadableRegister(const fm10000DbgFulcrumRegister *pReg)
+{
 
-        }   /* end while (pReg->regname != NULL) */
+    if ( IS_REG_PCIE_INDEX(pReg) ||
+         ( (pReg->regAddr >= FM10000_PCIE_PF_BASE) &&
+           (pReg->regAddr < FM10000_TE_BASE) ) )
+    {
+        return FALSE;
+    }
 
-    }   /* end if (showPorts) */
+    return ( (pReg->wordcount >= 1) &&
+             (pReg->wordcount <= SNAPSHOT_READ_WORDS) );
 
-}   /* end fm10000DbgListRegisters */
+}   /* end IsBulkReadableRegister */
 
 
 
 
 /*****************************************************************************/
-/** fm10000DbgDumpRegisterV3
+/** CanSnapshotRegisterRun
  * \ingroup intDiagReg
  *
- * \desc            Display the contents of a switch register, or a group
- *                  of related registers.
+ * \desc            Tells whether the entries of a register along its first
+ *                  index can be captured with bulk reads by
+ *                  SnapshotRegisterRun.
+ *
+ * \note            The entries must be packed back to back.
+ *
+ * \param[in]       pReg points to the register table entry.
+ *
+ * \return          TRUE if the register can be read in bulk.
+ *
+ *****************************************************************************/
+static fm_bool CanSnapshotRegisterRun(const fm10000DbgFulcrumRegister *pReg)
+{
+
+    if ( !IsBulkReadableRegister(pReg) )
+    {
+        return FALSE;
+    }
+
+    return ( (pReg->indexStep0 == pReg->wordcount) ||
+             (pReg->indexMin0 == pReg->indexMax0) );
+
+}   /* end CanSnapshotRegisterRun */
+
+
+
+
+/*****************************************************************************/
+/** SnapshotRegisterRun
+ * \ingroup intDiagReg
+ *
+ * \desc            Reads consecutive entries of a register with multi-word
+ *                  reads and reports them to the snapshot callback exactly
+ *                  as fm10000DbgDumpChipRegister would, one callback per
+ *                  group of up to four words.
  *
  * \param[in]       sw is the switch on which to operate.
  *
- * \param[in]       indexA is used for all indexed registers and ignored
- *                  for non-indexed registers. If the register is doubly
- *                  or triply indexed, this argument specifies the left index 
- *                  as the register is described in the FocalPoint datasheet. 
- *                  For some indexed registers, this index may represent a 
- *                  port number. In those cases, this argument should specify 
- *                  the logical port number.
+ * \param[in]       regid is the index into the register table.
  *
- * \param[in]       indexB is used to index into doubly and triply indexed 
- *                  registers and is ignored for singly indexed and non-indexed
- *                  registers. For some registers, this index may represent a
- *                  port number. In those cases, this argument should specify
- *                  the logical port number.
+ * \param[in]       firstAddress is the address of the first entry.
  *
- * \param[in]       indexC is used to index into triply indexed registers and 
- *                  is ignored for singly indexed, doubly indexed and 
- *                  non-indexed registers.
+ * \param[in]       numEntries is the number of entries to read.
  *
- * \param[in]       regName is the name of the register or group of registers 
- *                  to be displayed.
- *                                                                      \lb\lb
- *                  Some registers are indexed by EPL and channel number, but
- *                  an EPL-channel tuple represents a port. These registers
- *                  have an alias by the same name, but with a "_P" suffix.
- *                  When referred to by the alias name, indexA may be
- *                  specified using a logical port number and indexB and
- *                  indexC will be ignored. This function will automatically
- *                  convert the logical port number into the corresponding
- *                  EPL and channel indexes.
+ * \param[in]       callbackInfo is a cookie to be passed to the callback
+ *                  function.
+ *
+ * \param[in]       callback points to the callback function.
  *
  * \return          FM_OK if successful.
- * \return          FM_ERR_UNKNOWN_REGISTER if regname is not recognized.
+ * \return          FM_ERR_REG_SNAPSHOT_FULL if the callback cancelled the
+ *                  scan.
+ * \return          Other error codes from the register read.
  *
  *****************************************************************************/
-fm_status fm10000DbgDumpRegisterV3(fm_int  sw,
-                                   fm_int  indexA,
-                                   fm_int  indexB,
-                                   fm_int  indexC,
-                                   fm_text regName)
+static fm_status SnapshotRegisterRun(fm_int             sw,
+                                     fm_int             regid,
+                                     fm_uint            firstAddress,
+                                     fm_int             numEntries,
+                                     fm_voidptr         callbackInfo,
+                                     fm_regDumpCallback callback)
 {
-    const fm10000DbgFulcrumRegister *pReg;
-    fm_int                          pepIdx;
-    fm_int                          tblIndex;
-    fm_bool                         indexByPort = FALSE;
-    fm_status                       err = FM_ERR_UNKNOWN_REGISTER;
-    fm_char                         registerName[MAX_REGISTER_NAME_LENGTH];
-    fm_bool                         exactMatch;
-    fm_int                          idxA;
-    fm_int                          idxB;
-    fm_int                          idxC;
-
-
+    const fm10000DbgFulcrumRegister *regEntry;
+    fm_switch *                      switchPtr;
+    fm_uint32                        words[SNAPSHOT_READ_WORDS];
+    fm_uint                          address;
+    fm_int                           wordcount;
+    fm_int                           entriesPerRead;
+    fm_int                           entries;
+    fm_int                           entry;
+    fm_int                           word;
+    fm_int                           dumpWc;
+    fm_int                           i;
+    fm_uint64                        val1;
+    fm_uint64                        val2;
+    fm_bool                          isStatReg;
+    fm_status                        err;
+
+    switchPtr      = GET_SWITCH_PTR(sw);
+    regEntry       = &fm10000RegisterTable[regid];
+    wordcount      = regEntry->wordcount;
+    isStatReg      = (regEntry->flags & REG_FLAG_STATISTIC) ? TRUE : FALSE;
+    entriesPerRead = SNAPSHOT_READ_WORDS / wordcount;
+    address        = firstAddress;
+
+    while (numEntries > 0)
+    {
+        entries = (numEntries < entriesPerRead) ? numEntries : entriesPerRead;
 
-    ParseRegName(regName, TRUE, registerName, &indexByPort);
+        if (switchPtr->ReadUncacheUINT32Mult)
+        {
+            err = switchPtr->ReadUncacheUINT32Mult(sw,
+                                                   address,
+                                                   entries * wordcount,
+                                                   words);
+        }
+        else
+        {
+            err = switchPtr->ReadUINT32Mult(sw,
+                                            address,
+                                            entries * wordcount,
+                                            words);
+        }
 
-    pReg       = fm10000RegisterTable;
-    exactMatch = FALSE;
-    regCount = 0;
-    tblIndex = 0;
+        if (err != FM_OK)
+        {
+            FM_LOG_PRINT("Error reading %d words at address %08X, "
+                         "error code = %d\n",
+                         entries * wordcount,
+                         address,
+                         err);
+            return err;
+        }
 
-    while (pReg->regname != NULL)
-    {
-        /* Do exact match first to avoid matching multiple registers
-         * when one register name is a substring of another or
-         * special FM_XXX.
-         */
-        if (strcasecmp(pReg->regname, registerName) == 0 ||
-            strcasecmp(pReg->regname + REG_NAME_PREFIX_LEN, registerName) == 0)
+        for (entry = 0 ; entry < entries ; entry++)
         {
-            if (IS_REG_PCIE_VF(pReg->regname))
-            {
-                FM_LOG_PRINT("%s not visible in global register space.\n",
-                             regName);
-                FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_ERR_UNKNOWN_REGISTER);
-            }
-            exactMatch = TRUE;
-            if (IS_REG_PCIE_INDEX(pReg))
+            for (word = 0 ; word < wordcount ; word += 4)
             {
-                if (!indexByPort)
+                dumpWc = wordcount - word;
+
+                if (dumpWc > 4)
                 {
-                    pepIdx = indexA;
-                    idxA = indexB;
-                    idxC = indexC / 1000;
-                    if ((idxC < 1000) && (idxC > 0))
-                    {
+                    dumpWc = 4;
+                }
+
+                i    = entry * wordcount + word;
+                val1 = words[i];
+                val2 = 0;
+
+                if (dumpWc > 1)
+                {
+                    val1 |= (fm_uint64) words[i + 1] << 32;
+                }
+
+                if (dumpWc > 2)
+                {
+                    val2 = words[i + 2];
+                }
+
+                if (dumpWc > 3)
+                {
+                    val2 |= (fm_uint64) words[i + 3] << 32;
+                }
+
+                if ( !callback(sw,
+                               regid,
+                               address + i,
+                               dumpWc,
+                               isStatReg,
+                               val1,
+                               val2,
+                               callbackInfo) )
+                {
+                    return FM_ERR_REG_SNAPSHOT_FULL;
+                }
+            }
+        }
+
+        address    += entries * wordcount;
+        numEntries -= entries;
+    }
+
+    return FM_OK;
+
+}   /* end SnapshotRegisterRun */
+
+
+
+
+/*****************************************************************************/
+/** StreamRegValue
+ * \ingroup intDiagReg
+ *
+ * \desc            Register dump callback that writes one group of up to
+ *                  four register words to a register stream file.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regId is the index into the register table.
+ *
+ * \param[in]       regAddress is the address of the first word.
+ *
+ * \param[in]       regSize is the number of words, 1 to 4.
+ *
+ * \param[in]       isStatReg is TRUE for statistics registers.
+ *
+ * \param[in]       regValue1 holds the first two words.
+ *
+ * \param[in]       regValue2 holds the last two words.
+ *
+ * \param[in]       callbackInfo points to the ''regStreamState''.
+ *
+ * \return          FALSE if the file could not be written, to stop the dump.
+ *
+ *****************************************************************************/
+static fm_bool StreamRegValue(fm_int     sw,
+                              fm_int     regId,
+                              fm_uint    regAddress,
+                              fm_int     regSize,
+                              fm_bool    isStatReg,
+                              fm_uint64  regValue1,
+                              fm_uint64  regValue2,
+                              fm_voidptr callbackInfo)
+{
+    regStreamState *state;
+    regStreamRecord record;
+    fm_char         regName[MAX_REGISTER_NAME_LENGTH];
+    fm_bool         isPort;
+    fm_int          index0;
+    fm_int          index1;
+    fm_int          index2;
+    fm_int          i;
+
+    FM_NOT_USED(isStatReg);
+
+    state = callbackInfo;
+
+    record.address   = regAddress;
+    record.regId     = regId;
+    record.wordCount = regSize;
+    record.words[0]  = (fm_uint32) regValue1;
+    record.words[1]  = (fm_uint32) (regValue1 >> 32);
+    record.words[2]  = (fm_uint32) regValue2;
+    record.words[3]  = (fm_uint32) (regValue2 >> 32);
+
+    if (state->format == FM_DBG_REG_STREAM_BINARY)
+    {
+        if (fwrite(&record, sizeof(record), 1, state->fp) != 1)
+        {
+            return FALSE;
+        }
+    }
+    else
+    {
+        fm10000DbgGetRegisterName(sw,
+                                  regId,
+                                  regAddress,
+                                  regName,
+                                  sizeof(regName),
+                                  &isPort,
+                                  &index0,
+                                  &index1,
+                                  &index2,
+                                  FALSE,
+                                  TRUE);
+
+        fprintf(state->fp, "%s,0x%06X,%d", regName, regAddress, regSize);
+
+        for (i = 0 ; i < regSize ; i++)
+        {
+            fprintf(state->fp, ",0x%08X", record.words[i]);
+        }
+
+        if (fputc('\n', state->fp) == EOF)
+        {
+            return FALSE;
+        }
+    }
+
+    state->numRecords++;
+
+    return TRUE;
+
+}   /* end StreamRegValue */
+
+
+
+
+/*****************************************************************************/
+/** StreamRegister
+ * \ingroup intDiagReg
+ *
+ * \desc            Writes every entry of a register to a register stream,
+ *                  using multi-word reads along whichever of the first two
+ *                  indexes has its entries packed back to back.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regId is the index into the register table.
+ *
+ * \param[in]       state points to the register stream state.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if the file could not be written.
+ * \return          Other error codes from the register reads.
+ *
+ *****************************************************************************/
+static fm_status StreamRegister(fm_int sw, fm_int regId, regStreamState *state)
+{
+    const fm10000DbgFulcrumRegister *pReg;
+    fm_int                           runIndex;
+    fm_int                           indexA;
+    fm_int                           indexB;
+    fm_int                           indexC;
+    fm_uint                          address;
+    fm_status                        err;
+
+    pReg = &fm10000RegisterTable[regId];
+
+    /* Index along which entries are read in bulk, or -1 */
+    if ( CanSnapshotRegisterRun(pReg) )
+    {
+        runIndex = 0;
+    }
+    else if ( IsBulkReadableRegister(pReg) &&
+              (pReg->indexStep1 == pReg->wordcount) &&
+              (pReg->indexMax1 > pReg->indexMin1) )
+    {
+        runIndex = 1;
+    }
+    else
+    {
+        runIndex = -1;
+    }
+
+    err = FM_OK;
+
+    for (indexC = pReg->indexMin2 ; indexC <= pReg->indexMax2 ; indexC++)
+    {
+        if (runIndex == 1)
+        {
+            for (indexA = pReg->indexMin0 ; indexA <= pReg->indexMax0 ; indexA++)
+            {
+                address = pReg->regAddr +
+                          indexA * pReg->indexStep0 +
+                          pReg->indexMin1 * pReg->indexStep1 +
+                          indexC * pReg->indexStep2;
+
+                err = SnapshotRegisterRun(sw,
+                                          regId,
+                                          address,
+                                          pReg->indexMax1 - pReg->indexMin1 + 1,
+                                          state,
+                                          StreamRegValue);
+                if (err != FM_OK)
+                {
+                    goto ABORT;
+                }
+            }
+
+            continue;
+        }
+
+        for (indexB = pReg->indexMin1 ; indexB <= pReg->indexMax1 ; indexB++)
+        {
+            if (runIndex == 0)
+            {
+                address = pReg->regAddr +
+                          pReg->indexMin0 * pReg->indexStep0 +
+                          indexB * pReg->indexStep1 +
+                          indexC * pReg->indexStep2;
+
+                err = SnapshotRegisterRun(sw,
+                                          regId,
+                                          address,
+                                          pReg->indexMax0 - pReg->indexMin0 + 1,
+                                          state,
+                                          StreamRegValue);
+                if (err != FM_OK)
+                {
+                    goto ABORT;
+                }
+
+                continue;
+            }
+
+            for (indexA = pReg->indexMin0 ; indexA <= pReg->indexMax0 ; indexA++)
+            {
+                err = fm10000DbgDumpChipRegister(sw,
+                                                 indexA,
+                                                 indexB,
+                                                 indexC,
+                                                 0,
+                                                 regId,
+                                                 FALSE,
+                                                 state,
+                                                 StreamRegValue);
+
+                /* Holes in the index space are skipped, as in a snapshot */
+                if (err == FM_ERR_INVALID_INDEX)
+                {
+                    err = FM_OK;
+                }
+                else if (err != FM_OK)
+                {
+                    goto ABORT;
+                }
+            }
+        }
+    }
+
+ABORT:
+    /* The callback stops the scan only when the file cannot be written */
+    if (err == FM_ERR_REG_SNAPSHOT_FULL)
+    {
+        err = FM_FAIL;
+    }
+
+    return err;
+
+}   /* end StreamRegister */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** fm10000DbgListRegisters
+ * \ingroup intDiagReg
+ *
+ * \desc            Display a list of switch registers that may be displayed
+ *                  by calling fmDbgDumpRegister.
+ *
+ * \param[in]       sw is the switch number
+ *
+ * \param[in]       showGlobals should be TRUE to include all global registers
+ *                  in the list.
+ *
+ * \param[in]       showPorts should be TRUE to include all port registers
+ *                  in the list.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000DbgListRegisters(fm_int sw, fm_bool showGlobals, fm_bool showPorts)
+{
+    const fm10000DbgFulcrumRegister *pReg;
+    fm_char registerName[MAX_REGISTER_NAME_LENGTH];
+
+    FM_NOT_USED(sw);
+
+    if (showGlobals)
+    {
+        pReg = fm10000RegisterTable;
+
+        FM_LOG_PRINT("\nGlobal Register List\n");
+        FM_LOG_PRINT("Name                                     Length  "
+                     "Min Index0   Max Index0   Min Index1   "
+                     "Max Index1   Min Index2   Max Index2\n");
+
+        while (pReg->regname != NULL)
+        {
+            if ( !(pReg->flags & REG_FLAG_PER_PORT) &&
+                 !(pReg->flags & REG_FLAG_END_OF_REGS) )
+            {
+                FM_LOG_PRINT("%-41s  %-2d",
+                             pReg->regname, pReg->wordcount);
+
+                if ( (pReg->indexMax0 != 0) || 
+                     (pReg->indexMax1 != 0) ||
+                     (pReg->indexMax2 != 0) )
+                {
+                    FM_LOG_PRINT("      %-10d   %-10d   %-10d   %-10d   %-10d   %d", 
+                                 pReg->indexMin0, 
+                                 pReg->indexMax0, 
+                                 pReg->indexMin1, 
+                                 pReg->indexMax1,
+                                 pReg->indexMin2, 
+                                 pReg->indexMax2);
+                }
+
+                FM_LOG_PRINT("\n");
+            }
+
+            ++pReg;
+        }
+    }
+
+    if (showPorts)
+    {
+        pReg = fm10000RegisterTable;
+
+        FM_LOG_PRINT("\nPort Register List\n");
+        FM_LOG_PRINT("Name                                     Length  "
+                     "Min Index0   Max Index0   Min Index1   "
+                     "Max Index1   Min Index2   Max Index2\n");
+
+        while (pReg->regname != NULL)
+        {
+            if (pReg->flags & REG_FLAG_PER_PORT)
+            {
+                FM_LOG_PRINT("%-41s  %-2d      %-10d   %-10d   %-10d   "
+                             "%-10d   %-10d   %d\n",
+                             pReg->regname, 
+                             pReg->wordcount, 
+                             pReg->indexMin0, 
+                             pReg->indexMax0, 
+                             pReg->indexMin1, 
+                             pReg->indexMax1,
+                             pReg->indexMin2, 
+                             pReg->indexMax2);
+
+                /**************************************************
+                 * If this is a register that is indexed by EPL and
+                 * channel, list it again with the special suffix
+                 * indicating it can be indexed by logical port
+                 * as well.
+                 *
+                 * The min and max values won't be exactly right
+                 * since they depend on the logical port map.
+                 * Just use the internal port range.
+                 **************************************************/
+
+                if (pReg->flags & 
+                    (REG_FLAG_INDEX0_CHAN_1_EPL | REG_FLAG_INDEX0_PER_EPL))
+                {
+                    /* Copy the register name locally so that we can ...*/
+                    FM_STRCPY_S( registerName,
+                                 sizeof(registerName),
+                                 pReg->regname );
+
+                    /* ...append the suffix to it. */
+                    FM_STRCAT_S( registerName,
+                                 sizeof(registerName),
+                                 regNameSuffixStr );
+
+                    FM_LOG_PRINT("%-41s  %d       %-10d   %-10d   %-10d   %-10d   %-10d   %d\n",
+                                 registerName, 
+                                 pReg->wordcount,
+                                 MIN_LOGICAL_PORT_INDEX,
+                                 MAX_LOGICAL_PORT_INDEX, 
+                                 0,
+                                 0,
+                                 0,
+                                 0);
+
+                }   /* end if (pReg->flags & REG_FLAG_INDEX0_CHAN_1_EPL ...) */
+
+            }   /* end if (pReg->flags & REG_FLAG_PER_PORT) */
+
+            ++pReg;
+
+        }   /* end while (pReg->regname != NULL) */
+
+    }   /* end if (showPorts) */
+
+}   /* end fm10000DbgListRegisters */
+
+
+
+
+/*****************************************************************************/
+/** fm10000DbgDumpRegisterV3
+ * \ingroup intDiagReg
+ *
+ * \desc            Display the contents of a switch register, or a group
+ *                  of related registers.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       indexA is used for all indexed registers and ignored
+ *                  for non-indexed registers. If the register is doubly
+ *                  or triply indexed, this argument specifies the left index 
+ *                  as the register is described in the FocalPoint datasheet. 
+ *                  For some indexed registers, this index may represent a 
+ *                  port number. In those cases, this argument should specify 
+ *                  the logical port number.
+ *
+ * \param[in]       indexB is used to index into doubly and triply indexed 
+ *                  registers and is ignored for singly indexed and non-indexed
+ *                  registers. For some registers, this index may represent a
+ *                  port number. In those cases, this argument should specify
+ *                  the logical port number.
+ *
+ * \param[in]       indexC is used to index into triply indexed registers and 
+ *                  is ignored for singly indexed, doubly indexed and 
+ *                  non-indexed registers.
+ *
+ * \param[in]       regName is the name of the register or group of registers 
+ *                  to be displayed.
+ *                                                                      \lb\lb
+ *                  Some registers are indexed by EPL and channel number, but
+ *                  an EPL-channel tuple represents a port. These registers
+ *                  have an alias by the same name, but with a "_P" suffix.
+ *                  When referred to by the alias name, indexA may be
+ *                  specified using a logical port number and indexB and
+ *                  indexC will be ignored. This function will automatically
+ *                  convert the logical port number into the corresponding
+ *                  EPL and channel indexes.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNKNOWN_REGISTER if regname is not recognized.
+ *
+ *****************************************************************************/
+fm_status fm10000DbgDumpRegisterV3(fm_int  sw,
+                                   fm_int  indexA,
+                                   fm_int  indexB,
+                                   fm_int  indexC,
+                                   fm_text regName)
+{
+    const fm10000DbgFulcrumRegister *pReg;
+    fm_int                          pepIdx;
+    fm_int                          tblIndex;
+    fm_bool                         indexByPort = FALSE;
+    fm_status                       err = FM_ERR_UNKNOWN_REGISTER;
+    fm_char                         registerName[MAX_REGISTER_NAME_LENGTH];
+    fm_bool                         exactMatch;
+    fm_int                          idxA;
+    fm_int                          idxB;
+    fm_int                          idxC;
+
+
+
+    ParseRegName(regName, TRUE, registerName, &indexByPort);
+
+    pReg       = fm10000RegisterTable;
+    exactMatch = FALSE;
+    regCount = 0;
+    tblIndex = 0;
+
+    while (pReg->regname != NULL)
+    {
+        /* Do exact match first to avoid matching multiple registers
+         * when one register name is a substring of another or
+         * special FM_XXX.
+         */
+        if (strcasecmp(pReg->regname, registerName) == 0 ||
+            strcasecmp(pReg->regname + REG_NAME_PREFIX_LEN, registerName) == 0)
+        {
+            if (IS_REG_PCIE_VF(pReg->regname))
+            {
+                FM_LOG_PRINT("%s not visible in global register space.\n",
+                             regName);
+                FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_ERR_UNKNOWN_REGISTER);
+            }
+            exactMatch = TRUE;
+            if (IS_REG_PCIE_INDEX(pReg))
+            {
+                if (!indexByPort)
+                {
+                    pepIdx = indexA;
+                    idxA = indexB;
+                    idxC = indexC / 1000;
+                    if ((idxC < 1000) && (idxC > 0))
+                    {
                         /* This function has only 3 arguments, 
                          * use indexC to specify both 3rd and 4th argument */
                         idxB = indexC % 1000;
@@ -3866,42 +4447,116 @@ void fm10000DbgGetRegisterName(fm_int   sw,
         fmStringAppend(regName, tempBuf, regNameLength);
     }
 
-    if (port >= 0)
+    if (port >= 0)
+    {
+        if (IS_EPL_QUAD_INDEX(regEntry))
+        {
+            /* Assume logical port is mapped continous in one EPL block */
+            FM_SNPRINTF_S(tempBuf, sizeof(tempBuf), ".P(%d..%d)", port, port + 3);
+        }
+        else
+        {
+            FM_SNPRINTF_S(tempBuf, sizeof(tempBuf), ".P(%d)", port);
+        }
+
+        fmStringAppend(regName, tempBuf, regNameLength);
+    }
+
+    if (isPort)
+    {
+        *isPort = (regEntry->flags & REG_FLAG_PER_PORT);
+    }
+
+    if (index0Ptr)
+    {
+        *index0Ptr = index0;
+    }
+
+    if (index1Ptr)
+    {
+        *index1Ptr = index1;
+    }
+
+    if (index2Ptr)
+    {
+        *index2Ptr = index2;
+    }
+
+}   /* end fm10000DbgGetRegisterName */
+
+
+
+
+/*****************************************************************************/
+/** fm10000DbgGetRegisterId
+ * \ingroup intDiagReg
+ *
+ * \desc            Given a register address, return the index of the register
+ *                  table entry describing the register block that contains
+ *                  it.
+ *
+ * \note            Indexed registers are resolved arithmetically, visiting
+ *                  their dimensions from the largest index step down, so the
+ *                  cost of a lookup does not depend on the size of the
+ *                  register arrays.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regAddress is the register address to look up.
+ *
+ * \param[out]      regId points to caller-allocated storage where this
+ *                  function will write the index into the register table.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if the address does not belong to any
+ *                  register in the table.
+ *
+ *****************************************************************************/
+fm_status fm10000DbgGetRegisterId(fm_int sw, fm_uint regAddress, fm_int *regId)
+{
+    const fm10000DbgFulcrumRegister *pReg;
+    fm_int                           id;
+    fm_uint                          offset;
+
+    FM_NOT_USED(sw);
+
+    for (id = 0 ; id < fm10000RegisterTableSize ; id++)
     {
-        if (IS_EPL_QUAD_INDEX(regEntry))
+        pReg = &fm10000RegisterTable[id];
+
+        if ( (pReg->regname == NULL) || (pReg->flags & REG_FLAG_END_OF_REGS) )
         {
-            /* Assume logical port is mapped continous in one EPL block */
-            FM_SNPRINTF_S(tempBuf, sizeof(tempBuf), ".P(%d..%d)", port, port + 3);
+            break;
         }
-        else
+
+        if (regAddress < pReg->regAddr)
         {
-            FM_SNPRINTF_S(tempBuf, sizeof(tempBuf), ".P(%d)", port);
+            continue;
         }
 
-        fmStringAppend(regName, tempBuf, regNameLength);
-    }
+        offset = regAddress - pReg->regAddr;
 
-    if (isPort)
-    {
-        *isPort = (regEntry->flags & REG_FLAG_PER_PORT);
-    }
+        /* PCIe registers are replicated once per PEP */
+        if (IS_REG_PCIE_INDEX(pReg))
+        {
+            if (offset / FM10000_PCIE_PF_SIZE > FM10000_MAX_PEP)
+            {
+                continue;
+            }
 
-    if (index0Ptr)
-    {
-        *index0Ptr = index0;
-    }
+            offset %= FM10000_PCIE_PF_SIZE;
+        }
 
-    if (index1Ptr)
-    {
-        *index1Ptr = index1;
+        if (RegisterContainsOffset(pReg, offset))
+        {
+            *regId = id;
+            return FM_OK;
+        }
     }
 
-    if (index2Ptr)
-    {
-        *index2Ptr = index2;
-    }
+    return FM_ERR_NOT_FOUND;
 
-}   /* end fm10000DbgGetRegisterName */
+}   /* end fm10000DbgGetRegisterId */
 
 
 
@@ -4000,6 +4655,9 @@ void fm10000DbgTakeChipSnapshot(fm_int                sw,
     fm_int                          indexB = 0;
     fm_int                          indexC = 0;
     fm_int                          regId;
+    fm_int                          numEntries;
+    fm_uint                         runAddress;
+    fm_bool                         bulkRead;
     fm_status                       err;
 
     if (invalidIndexEncountered == NULL)
@@ -4040,6 +4698,13 @@ void fm10000DbgTakeChipSnapshot(fm_int                sw,
             continue;
         }
 
+        /* Registers whose entries are packed along the first index are
+         * captured a row at a time with multi-word reads. */
+        bulkRead   = CanSnapshotRegisterRun(pRegister);
+        numEntries = pRegister->indexMax0 - pRegister->indexMin0 + 1;
+        runAddress = pRegister->regAddr +
+                     pRegister->indexMin0 * pRegister->indexStep0;
+
         switch (pRegister->accessMethod)
         {
             case ALL4PORT:
@@ -4054,6 +4719,29 @@ void fm10000DbgTakeChipSnapshot(fm_int                sw,
                      indexB <= pRegister->indexMax1 ;
                      indexB++)
                 {
+                    if (bulkRead)
+                    {
+                        err = SnapshotRegisterRun(sw,
+                                                  regId,
+                                                  runAddress +
+                                                  indexB * pRegister->indexStep1,
+                                                  numEntries,
+                                                  pSnapshot,
+                                                  callback);
+                        if (err != FM_OK)
+                        {
+                            FM_LOG_WARNING(FM_LOG_CAT_DEBUG,
+                                           "Snapshot is incomplete at register "
+                                           "%s, indexB=%d, err=%d (%s)\n",
+                                           pRegister->regname,
+                                           indexB,
+                                           err,
+                                           fmErrorMsg(err) );
+                        }
+
+                        continue;
+                    }
+
                     for (indexA = pRegister->indexMin0 ;
                          indexA <= pRegister->indexMax0 ;
                          indexA++)
@@ -4110,6 +4798,32 @@ void fm10000DbgTakeChipSnapshot(fm_int                sw,
                          indexB <= pRegister->indexMax1 ;
                          indexB++)
                     {
+                        if (bulkRead)
+                        {
+                            err = SnapshotRegisterRun(sw,
+                                                      regId,
+                                                      runAddress +
+                                                  indexB * pRegister->indexStep1 +
+                                                  indexC * pRegister->indexStep2,
+                                                      numEntries,
+                                                      pSnapshot,
+                                                      callback);
+                            if (err != FM_OK)
+                            {
+                                FM_LOG_WARNING(FM_LOG_CAT_DEBUG,
+                                               "Snapshot is incomplete at "
+                                               "register %s, indexC=%d, "
+                                               "indexB=%d, err=%d (%s)\n",
+                                               pRegister->regname,
+                                               indexC,
+                                               indexB,
+                                               err,
+                                               fmErrorMsg(err) );
+                            }
+
+                            continue;
+                        }
+
                         for (indexA = pRegister->indexMin0 ;
                              indexA <= pRegister->indexMax0 ;
                              indexA++)
@@ -4159,6 +4873,27 @@ void fm10000DbgTakeChipSnapshot(fm_int                sw,
 
             default:
 
+                if (bulkRead)
+                {
+                    err = SnapshotRegisterRun(sw,
+                                              regId,
+                                              runAddress,
+                                              numEntries,
+                                              pSnapshot,
+                                              callback);
+                    if (err != FM_OK)
+                    {
+                        FM_LOG_WARNING(FM_LOG_CAT_DEBUG,
+                                       "Snapshot is incomplete at register %s, "
+                                       "err=%d (%s)\n",
+                                       pRegister->regname,
+                                       err,
+                                       fmErrorMsg(err) );
+                    }
+
+                    break;
+                }
+
                 for (indexA = pRegister->indexMin0 ;
                      indexA <= pRegister->indexMax0 ;
                      indexA++)
@@ -4214,6 +4949,381 @@ void fm10000DbgTakeChipSnapshot(fm_int                sw,
 
 
 
+/*****************************************************************************/
+/** fm10000DbgStreamRegisters
+ * \ingroup intDiagReg
+ *
+ * \desc            Writes the contents of a register, a group of related
+ *                  registers or the whole register space to a file, reading
+ *                  tables in bulk and bypassing the logging system.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regName is the name of the register to be written. If
+ *                  it does not name a register exactly, every register
+ *                  whose name contains it is written. NULL or an empty
+ *                  string selects all registers.
+ *
+ * \param[in]       fileName is the name of the file to create.
+ *
+ * \param[in]       format is the output format, see
+ *                  ''fm_dbgRegStreamFormat''.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if fileName or format is invalid.
+ * \return          FM_ERR_UNKNOWN_REGISTER if regName matches no register.
+ * \return          FM_FAIL if the file could not be written.
+ *
+ *****************************************************************************/
+fm_status fm10000DbgStreamRegisters(fm_int                sw,
+                                    fm_text               regName,
+                                    fm_text               fileName,
+                                    fm_dbgRegStreamFormat format)
+{
+    const fm10000DbgFulcrumRegister *pReg;
+    regStreamState                   state;
+    regStreamHeader                  header;
+    fm_char                          registerName[MAX_REGISTER_NAME_LENGTH];
+    fm_bool                          indexByPort;
+    fm_bool                          exactMatch;
+    fm_bool                          selected;
+    fm_int                           regId;
+    fm_int                           numRegs;
+    fm_int                           numStreamed;
+    fm_timestamp                     start;
+    fm_timestamp                     end;
+    fm_status                        err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_DEBUG,
+                 "sw=%d regName=%s fileName=%s format=%d\n",
+                 sw,
+                 (regName != NULL) ? regName : "<all>",
+                 (fileName != NULL) ? fileName : "<NULL>",
+                 format);
+
+    if ( (fileName == NULL) ||
+         ( (format != FM_DBG_REG_STREAM_CSV) &&
+           (format != FM_DBG_REG_STREAM_BINARY) ) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    /**************************************************
+     * An exact name selects that register alone, as in
+     * fm10000DbgDumpRegisterV3.
+     **************************************************/
+
+    exactMatch = FALSE;
+    numRegs    = 0;
+
+    if ( (regName != NULL) && (regName[0] != '\0') )
+    {
+        ParseRegName(regName, TRUE, registerName, &indexByPort);
+    }
+    else
+    {
+        registerName[0] = '\0';
+    }
+
+    for (pReg = fm10000RegisterTable ; pReg->regname != NULL ; pReg++)
+    {
+        if ( (registerName[0] != '\0') &&
+             ( (strcasecmp(pReg->regname, registerName) == 0) ||
+               (strcasecmp(pReg->regname + REG_NAME_PREFIX_LEN,
+                           registerName) == 0) ) )
+        {
+            exactMatch = TRUE;
+        }
+
+        numRegs++;
+    }
+
+    state.fp = fopen(fileName, (format == FM_DBG_REG_STREAM_BINARY) ? "wb" : "w");
+
+    if (state.fp == NULL)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_DEBUG, "Unable to create %s\n", fileName);
+        FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_FAIL);
+    }
+
+    /* Entries are small, so let stdio gather them into large writes */
+    setvbuf(state.fp, NULL, _IOFBF, REG_STREAM_BUFFER_SIZE);
+
+    state.format     = format;
+    state.numRecords = 0;
+
+    memset(&header, 0, sizeof(header));
+
+    if (format == FM_DBG_REG_STREAM_BINARY)
+    {
+        /* Rewritten with the record count once the scan is done */
+        header.magic        = REG_STREAM_FILE_MAGIC;
+        header.version      = REG_STREAM_FILE_VERSION;
+        header.sw           = sw;
+        header.regTableSize = numRegs;
+
+        if (fwrite(&header, sizeof(header), 1, state.fp) != 1)
+        {
+            err = FM_FAIL;
+            goto ABORT;
+        }
+    }
+    else
+    {
+        fprintf(state.fp, "register,address,words,word0,word1,word2,word3\n");
+    }
+
+    fmGetTime(&start);
+
+    err         = FM_OK;
+    numStreamed = 0;
+
+    for (regId = 0 ; regId < numRegs ; regId++)
+    {
+        pReg = &fm10000RegisterTable[regId];
+
+        if (registerName[0] == '\0')
+        {
+            selected = TRUE;
+        }
+        else if (exactMatch)
+        {
+            selected =
+                ( (strcasecmp(pReg->regname, registerName) == 0) ||
+                  (strcasecmp(pReg->regname + REG_NAME_PREFIX_LEN,
+                              registerName) == 0) );
+        }
+        else
+        {
+            selected = (strcasestr(pReg->regname, registerName) != NULL);
+        }
+
+        if ( !selected ||
+             IS_REG_PCIE_VF(pReg->regname) ||
+             (strcmp(pReg->regname, "END_OF_REGISTERS") == 0) )
+        {
+            continue;
+        }
+
+        switch (pReg->accessMethod)
+        {
+            case ALL4PORT:
+            case GROUPREG:
+            case ALLCONFG:
+            case SPECIAL:
+                /* Aliases and pseudo-registers have no entries of their own */
+                continue;
+
+            default:
+                break;
+        }
+
+        err = StreamRegister(sw, regId, &state);
+
+        if (err != FM_OK)
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_DEBUG,
+                         "Register stream stopped at %s: %s\n",
+                         pReg->regname,
+                         fmErrorMsg(err));
+            goto ABORT;
+        }
+
+        numStreamed++;
+    }
+
+    if (numStreamed == 0)
+    {
+        err = FM_ERR_UNKNOWN_REGISTER;
+        goto ABORT;
+    }
+
+    if (format == FM_DBG_REG_STREAM_BINARY)
+    {
+        header.numRecords = state.numRecords;
+
+        if ( (fseek(state.fp, 0, SEEK_SET) != 0) ||
+             (fwrite(&header, sizeof(header), 1, state.fp) != 1) )
+        {
+            err = FM_FAIL;
+            goto ABORT;
+        }
+    }
+
+    fmGetTime(&end);
+    fmSubTimestamps(&end, &start, &end);
+
+    FM_LOG_PRINT("Wrote %u entries of %d registers to %s in "
+                 "%" FM_FORMAT_64 "u.%06" FM_FORMAT_64 "u s\n",
+                 state.numRecords,
+                 numStreamed,
+                 fileName,
+                 end.sec,
+                 end.usec);
+
+ABORT:
+    if ( (fclose(state.fp) != 0) && (err == FM_OK) )
+    {
+        err = FM_FAIL;
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_DEBUG, err);
+
+}   /* end fm10000DbgStreamRegisters */
+
+
+
+
+/*****************************************************************************/
+/** fm10000DbgDecodeRegisterStream
+ * \ingroup intDiagReg
+ *
+ * \desc            Prints the registers of a binary register stream written
+ *                  by ''fm10000DbgStreamRegisters'', with each register
+ *                  broken down into its fields. The switch is not accessed,
+ *                  so the file may be decoded on any host.
+ *
+ * \note            The file must have been written by the same software
+ *                  version, since records refer to the register table by
+ *                  index.
+ *
+ * \param[in]       fileName is the name of the file to decode.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if fileName is NULL or is not a
+ *                  register stream of this software version.
+ * \return          FM_FAIL if the file could not be read.
+ *
+ *****************************************************************************/
+fm_status fm10000DbgDecodeRegisterStream(fm_text fileName)
+{
+    const fm10000DbgFulcrumRegister *pReg;
+    regStreamHeader                  header;
+    regStreamRecord                  record;
+    FILE *                           fp;
+    fm_uint32                        value[MAX_WORD_PER_REG];
+    fm_uint                          entryAddress;
+    fm_uint32                        i;
+    fm_int                           numRegs;
+    fm_int                           numWords;
+    fm_int                           regId;
+    fm_int                           j;
+    fm_status                        err;
+
+    if (fileName == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    fp = fopen(fileName, "rb");
+
+    if (fp == NULL)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_DEBUG, "Unable to open %s\n", fileName);
+        return FM_FAIL;
+    }
+
+    numRegs = 0;
+
+    for (pReg = fm10000RegisterTable ; pReg->regname != NULL ; pReg++)
+    {
+        numRegs++;
+    }
+
+    if (fread(&header, sizeof(header), 1, fp) != 1)
+    {
+        err = FM_FAIL;
+        goto ABORT;
+    }
+
+    if ( (header.magic != REG_STREAM_FILE_MAGIC) ||
+         (header.version != REG_STREAM_FILE_VERSION) ||
+         (header.regTableSize != numRegs) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_DEBUG,
+                     "%s is not a register stream of this software version\n",
+                     fileName);
+        err = FM_ERR_INVALID_ARGUMENT;
+        goto ABORT;
+    }
+
+    FM_LOG_PRINT("Register stream of switch %d, %u entries\n",
+                 header.sw,
+                 header.numRecords);
+
+    err          = FM_OK;
+    regId        = -1;
+    numWords     = 0;
+    entryAddress = 0;
+
+    /**************************************************
+     * Registers wider than four words are stored as
+     * consecutive records, which are put back together
+     * before decoding.
+     **************************************************/
+
+    for (i = 0 ; i < header.numRecords ; i++)
+    {
+        if (fread(&record, sizeof(record), 1, fp) != 1)
+        {
+            err = FM_FAIL;
+            goto ABORT;
+        }
+
+        if ( (record.regId < 0) || (record.regId >= numRegs) ||
+             (record.wordCount < 1) || (record.wordCount > 4) )
+        {
+            err = FM_ERR_INVALID_ARGUMENT;
+            goto ABORT;
+        }
+
+        pReg = &fm10000RegisterTable[record.regId];
+
+        if ( (record.regId != regId) ||
+             (record.address != entryAddress + numWords) )
+        {
+            regId        = record.regId;
+            entryAddress = record.address;
+            numWords     = 0;
+        }
+
+        for (j = 0 ; j < record.wordCount && numWords < MAX_WORD_PER_REG ; j++)
+        {
+            value[numWords++] = record.words[j];
+        }
+
+        if ( (numWords < pReg->wordcount) && (numWords < MAX_WORD_PER_REG) )
+        {
+            continue;
+        }
+
+        FM_LOG_PRINT("%s @ 0x%06X:", pReg->regname, entryAddress);
+
+        for (j = numWords - 1 ; j >= 0 ; j--)
+        {
+            FM_LOG_PRINT(" %08X", value[j]);
+        }
+
+        FM_LOG_PRINT("\n");
+
+#if HAVE_REGISTER_FIELDS
+        fm10000DbgDumpRegField(pReg->regname, value);
+#endif
+
+        regId    = -1;
+        numWords = 0;
+    }
+
+ABORT:
+    fclose(fp);
+
+    return err;
+
+}   /* end fm10000DbgDecodeRegisterStream */
+
+
+
+
 /*****************************************************************************/
 /** fm10000DbgGetRegInfo
  * \ingroup intDiag
@@ -42,12 +42,6 @@
 #define FM_BUILD_IDENTIFIER            "<UNKNOWN>"
 #endif
 
-#define TAKE_DBG_LOCK() \
-    fmCaptureLock(&fmRootDebug->fmDbgLock, FM_WAIT_FOREVER);
-
-#define DROP_DBG_LOCK() \
-    fmReleaseLock(&fmRootDebug->fmDbgLock);
-
 #if 0
 #define MIN_MAC_FLUSH_THRESH           0.00000001
 #endif
@@ -77,6 +71,8 @@ void fmDbgUpdateMacFlushTime(int addrCount);
 #endif
 
 static fm_status DbgDiagCountInitialize(void);
+static void CopySwitchDiagnostics(fm_int sw, fm_switchDiagnostics *diags);
+static void CopyGlobalDiagnostics(fm_globalDiagnostics *diags);
 
 
 /*****************************************************************************
@@ -119,19 +115,10 @@ static fm_status fmDebugRootInit(void)
     
 #endif
 
-    err = fmCreateLockV2("fmDbgLock", 
-                         FM_LOCK_SWITCH_NONE,
-                         FM_LOCK_SUPER_PRECEDENCE,
-                         &fmRootDebug->fmDbgLock);
-
-    if (err != FM_OK)
-    {
-        return err;
-    }
-
     fmDbgInitTrace();
     fmDbgInitSnapshots();
     fmDbgInitEyeDiagrams();
+    fmDbgInitPacketBench();
 #if 0
     fmDbgInitMacFlushStat();
 #endif
@@ -318,6 +305,63 @@ fm_status DbgDiagCountInitialize(void)
 
 
 
+/**********************************************************************
+ * CopySwitchDiagnostics
+ *
+ * \desc            Takes a snapshot of a switch's diagnostic counters.
+ *                  The counters are updated with relaxed atomic adds and
+ *                  are read one at a time, so the snapshot is not
+ *                  consistent across counters.
+ *
+ * \param[in]       sw identifies the switch.
+ *
+ * \param[out]      diags points to caller-allocated storage where this
+ *                  function places the counters.
+ *
+ * \return          Nothing.
+ *
+ **********************************************************************/
+static void CopySwitchDiagnostics(fm_int sw, fm_switchDiagnostics *diags)
+{
+    fm_int i;
+
+    for (i = 0 ; i < FM_SWITCH_CTR_MAX ; i++)
+    {
+        diags->counters[i] =
+            FM_ATOMIC_LOAD_RELAXED(&fmRootDebug->fmSwitchDiagnostics[sw].counters[i]);
+    }
+
+}   /* end CopySwitchDiagnostics */
+
+
+
+
+/**********************************************************************
+ * CopyGlobalDiagnostics
+ *
+ * \desc            Takes a snapshot of the global diagnostic counters.
+ *
+ * \param[out]      diags points to caller-allocated storage where this
+ *                  function places the counters.
+ *
+ * \return          Nothing.
+ *
+ **********************************************************************/
+static void CopyGlobalDiagnostics(fm_globalDiagnostics *diags)
+{
+    fm_int i;
+
+    for (i = 0 ; i < FM_GLOBAL_CTR_MAX ; i++)
+    {
+        diags->counters[i] =
+            FM_ATOMIC_LOAD_RELAXED(&fmRootDebug->fmGlobalDiagnostics.counters[i]);
+    }
+
+}   /* end CopyGlobalDiagnostics */
+
+
+
+
 /*****************************************************************************/
 /** fmDbgDumpDriverCounts
  * \ingroup intDiagTrackingStats
@@ -344,11 +388,7 @@ fm_status fmDbgDumpDriverCounts(fm_int sw)
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    diags = fmRootDebug->fmSwitchDiagnostics[sw];
-
-    DROP_DBG_LOCK();
+    CopySwitchDiagnostics(sw, &diags);
 
 
     FM_LOG_PRINT("================== Rx Packets ==============\n");
@@ -370,6 +410,8 @@ fm_status fmDbgDumpDriverCounts(fm_int sw)
                  diags.counters[FM_CTR_RX_PKT_DROPS_SECURITY]);
     FM_LOG_PRINT("Rx user pkt drops SV event : %15" FM_FORMAT_64 "u\n",
                  diags.counters[FM_CTR_RX_PKT_DROPS_SV_EVENT]);
+    FM_LOG_PRINT("Rx user pkt drops filter   : %15" FM_FORMAT_64 "u\n",
+                 diags.counters[FM_CTR_RX_PKT_DROPS_FILTER]);
     FM_LOG_PRINT("Rx user pkt drops STP      : %15" FM_FORMAT_64 "u\n",
                  diags.counters[FM_CTR_RX_PKT_DROPS_STP]);
     FM_LOG_PRINT("Rx user pkt drops LACP     : %15" FM_FORMAT_64 "u\n",
@@ -392,6 +434,12 @@ fm_status fmDbgDumpDriverCounts(fm_int sw)
                  diags.counters[FM_CTR_RX_APPL_FRM_FWD]);
     FM_LOG_PRINT("Rx appl frame drops        : %15" FM_FORMAT_64 "u\n",
                  diags.counters[FM_CTR_RX_APPL_FRM_DROPS]);
+    FM_LOG_PRINT("Rx batch drains            : %15" FM_FORMAT_64 "u\n",
+                 diags.counters[FM_CTR_RX_BATCH_DRAIN]);
+    FM_LOG_PRINT("Rx batch pkts              : %15" FM_FORMAT_64 "u\n",
+                 diags.counters[FM_CTR_RX_BATCH_PKTS]);
+    FM_LOG_PRINT("Rx batch full              : %15" FM_FORMAT_64 "u\n",
+                 diags.counters[FM_CTR_RX_BATCH_FULL]);
 
     FM_LOG_PRINT("================== Tx Packets ==============\n");
     FM_LOG_PRINT("Tx appl pkt forwarded      : %15" FM_FORMAT_64 "u\n",
@@ -404,6 +452,20 @@ fm_status fmDbgDumpDriverCounts(fm_int sw)
                  diags.counters[FM_CTR_TX_PKT_COMPLETE]);
     FM_LOG_PRINT("Tx pkt drop                : %15" FM_FORMAT_64 "u\n",
                  diags.counters[FM_CTR_TX_PKT_DROP]);
+    FM_LOG_PRINT("Tx batch flushes           : %15" FM_FORMAT_64 "u\n",
+                 diags.counters[FM_CTR_TX_BATCH_FLUSH]);
+    FM_LOG_PRINT("Tx batch pkts              : %15" FM_FORMAT_64 "u\n",
+                 diags.counters[FM_CTR_TX_BATCH_PKTS]);
+    FM_LOG_PRINT("Tx batch partial sends     : %15" FM_FORMAT_64 "u\n",
+                 diags.counters[FM_CTR_TX_BATCH_PARTIAL]);
+
+    FM_LOG_PRINT("============ Interrupt Polling =============\n");
+    FM_LOG_PRINT("Polling windows            : %15" FM_FORMAT_64 "u\n",
+                 diags.counters[FM_CTR_INTR_POLL_START]);
+    FM_LOG_PRINT("Polling passes             : %15" FM_FORMAT_64 "u\n",
+                 diags.counters[FM_CTR_INTR_POLL_PASS]);
+    FM_LOG_PRINT("Polling passes with work   : %15" FM_FORMAT_64 "u\n",
+                 diags.counters[FM_CTR_INTR_POLL_HIT]);
 
     FM_LOG_PRINT("================ Dispatches ================\n");
     FM_LOG_PRINT("Rx Request Msgs            : %15" FM_FORMAT_64 "u\n",
@@ -457,11 +519,7 @@ fm_status fmDbgDumpMATableCounts(fm_int sw)
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    diags = fmRootDebug->fmSwitchDiagnostics[sw];
-
-    DROP_DBG_LOCK();
+    CopySwitchDiagnostics(sw, &diags);
 
     FM_LOG_PRINT("============= MA Learning Events ===========\n");
     FM_LOG_PRINT("Learned (LEARNED event)    : %15" FM_FORMAT_64 "u\n",
@@ -475,6 +533,8 @@ fm_status fmDbgDumpMATableCounts(fm_int sw)
                  diags.counters[FM_CTR_MAC_REPORT_LEARN]);
     FM_LOG_PRINT("Learn reports discarded    : %15" FM_FORMAT_64 "u\n",
                  diags.counters[FM_CTR_MAC_LEARN_DISCARDED]);
+    FM_LOG_PRINT("Learns throttled           : %15" FM_FORMAT_64 "u\n",
+                 diags.counters[FM_CTR_MAC_LEARN_THROTTLED]);
 
     FM_LOG_PRINT("============= MA Aging Events ==============\n");
     FM_LOG_PRINT("Aged (LEARNED event)       : %15" FM_FORMAT_64 "u\n",
@@ -622,17 +682,15 @@ fm_status fmDbgDumpLinkChangeCounts(fm_int sw)
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    diags = fmRootDebug->fmSwitchDiagnostics[sw];
-
-    DROP_DBG_LOCK();
+    CopySwitchDiagnostics(sw, &diags);
 
     FM_LOG_PRINT("============= Link Status ===========\n");
     FM_LOG_PRINT("Link Change                : %15" FM_FORMAT_64 "u\n",
                  diags.counters[FM_CTR_LINK_CHANGE_EVENT]);
     FM_LOG_PRINT("Link Change No Events      : %15" FM_FORMAT_64 "u\n",
                  diags.counters[FM_CTR_LINK_CHANGE_OUT_OF_EVENTS]);
+    FM_LOG_PRINT("LAG Fast Failovers         : %15" FM_FORMAT_64 "u\n",
+                 diags.counters[FM_CTR_LINK_CHANGE_LAG_FAST_FAILOVER]);
 
 
     return FM_OK;
@@ -666,11 +724,7 @@ fm_status fmDbgDumpMacSecurityCounts(fm_int sw)
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    diags = fmRootDebug->fmSwitchDiagnostics[sw];
-
-    DROP_DBG_LOCK();
+    CopySwitchDiagnostics(sw, &diags);
 
     FM_LOG_PRINT("============ MAC Security ===========\n");
 
@@ -724,11 +778,7 @@ fm_status fmDbgDumpMiscEventCounts(fm_int sw)
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    diags = fmRootDebug->fmSwitchDiagnostics[sw];
-
-    DROP_DBG_LOCK();
+    CopySwitchDiagnostics(sw, &diags);
 
     FM_LOG_PRINT("============= Timestamp Events ===========\n");
     FM_LOG_PRINT("Egress Timestamps          : %15" FM_FORMAT_64 "u\n",
@@ -779,11 +829,7 @@ fm_status fmDbgDumpParityErrorCounts(fm_int sw)
         return err;
     }
 
-    TAKE_DBG_LOCK();
-
-    diags = fmRootDebug->fmSwitchDiagnostics[sw];
-
-    DROP_DBG_LOCK();
+    CopySwitchDiagnostics(sw, &diags);
 
     FM_LOG_PRINT("============= Parity Error Area counters ===========\n");
 
@@ -831,6 +877,8 @@ fm_status fmDbgDumpParityErrorCounts(fm_int sw)
 
     FM_LOG_PRINT("Parity events lost         : %15" FM_FORMAT_64 "u\n",
                  diags.counters[FM_CTR_PARITY_EVENT_LOST]);
+    FM_LOG_PRINT("Coalesced parity errors    : %15" FM_FORMAT_64 "u\n",
+                 diags.counters[FM_CTR_PARITY_COALESCED]);
 
     return FM_OK;
 
@@ -874,11 +922,7 @@ fm_status fmDbgDumpParityRepairCounts(fm_int sw)
         return err;
     }
 
-    TAKE_DBG_LOCK();
-
-    diags = fmRootDebug->fmSwitchDiagnostics[sw];
-
-    DROP_DBG_LOCK();
+    CopySwitchDiagnostics(sw, &diags);
 
     FM_LOG_PRINT("============= Parity Repair Error counters ===========\n");
 
@@ -1000,11 +1044,8 @@ fm_status fmDbgDiagCountClear(fm_int sw, fm_trackingCounterIndex counter)
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    fmRootDebug->fmSwitchDiagnostics[sw].counters[counter] = 0;
-
-    DROP_DBG_LOCK();
+    FM_ATOMIC_STORE_RELAXED(&fmRootDebug->fmSwitchDiagnostics[sw].counters[counter],
+                            0);
 
     return err;
 
@@ -1034,18 +1075,18 @@ fm_status fmDbgDiagCountClear(fm_int sw, fm_trackingCounterIndex counter)
 fm_status fmDbgDiagCountClearAll(fm_int sw)
 {
     fm_status err = FM_OK;
+    fm_int    i;
 
     if (fmRootDebug == NULL)
     {
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    memset( fmRootDebug->fmSwitchDiagnostics[sw].counters, 0,
-           sizeof(fmRootDebug->fmSwitchDiagnostics[sw].counters) );
-
-    DROP_DBG_LOCK();
+    for (i = 0 ; i < FM_SWITCH_CTR_MAX ; i++)
+    {
+        FM_ATOMIC_STORE_RELAXED(&fmRootDebug->fmSwitchDiagnostics[sw].counters[i],
+                                0);
+    }
 
     return err;
 
@@ -1100,11 +1141,8 @@ fm_status fmDbgDiagCountGet(fm_int                  sw,
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    *outValue = fmRootDebug->fmSwitchDiagnostics[sw].counters[counter];
-
-    DROP_DBG_LOCK();
+    *outValue =
+        FM_ATOMIC_LOAD_RELAXED(&fmRootDebug->fmSwitchDiagnostics[sw].counters[counter]);
 
     return err;
 
@@ -1143,11 +1181,8 @@ fm_status fmDbgDiagCountSet(fm_int                  sw,
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    fmRootDebug->fmSwitchDiagnostics[sw].counters[counter] = value;
-
-    DROP_DBG_LOCK();
+    FM_ATOMIC_STORE_RELAXED(&fmRootDebug->fmSwitchDiagnostics[sw].counters[counter],
+                            value);
 
     return err;
 
@@ -1188,11 +1223,9 @@ fm_status fmDbgDiagCountIncr(fm_int                  sw,
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    fmRootDebug->fmSwitchDiagnostics[sw].counters[counter] += amount;
-
-    DROP_DBG_LOCK();
+    /* Lock-free: this is called on the packet path. */
+    FM_ATOMIC_ADD_RELAXED(&fmRootDebug->fmSwitchDiagnostics[sw].counters[counter],
+                          amount);
 
     return err;
 
@@ -1228,11 +1261,7 @@ fm_status fmDbgGlobalDiagCountDump(void)
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    diags = fmRootDebug->fmGlobalDiagnostics;
-
-    DROP_DBG_LOCK();
+    CopyGlobalDiagnostics(&diags);
 
     FM_LOG_PRINT("================== Buffer Management ==================\n");
     FM_LOG_PRINT("Total Allocations          : %15" FM_FORMAT_64 "u\n",
@@ -1264,6 +1293,8 @@ fm_status fmDbgGlobalDiagCountDump(void)
     FM_LOG_PRINT("================== Event Management ===================\n");
     FM_LOG_PRINT("Out of event storage events: %15" FM_FORMAT_64 "u\n",
                  diags.counters[FM_GLOBAL_CTR_NO_EVENTS_AVAILABLE]);
+    FM_LOG_PRINT("Refused for reservation    : %15" FM_FORMAT_64 "u\n",
+                 diags.counters[FM_GLOBAL_CTR_EVENT_RESERVED]);
 
     return err;
 
@@ -1298,11 +1329,8 @@ fm_status fmDbgGlobalDiagCountClear(fm_globalDiagCounter counter)
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    fmRootDebug->fmGlobalDiagnostics.counters[counter] = 0;
-
-    DROP_DBG_LOCK();
+    FM_ATOMIC_STORE_RELAXED(&fmRootDebug->fmGlobalDiagnostics.counters[counter],
+                            0);
 
     return err;
 
@@ -1328,18 +1356,18 @@ fm_status fmDbgGlobalDiagCountClear(fm_globalDiagCounter counter)
 fm_status fmDbgGlobalDiagCountClearAll(void)
 {
     fm_status err = FM_OK;
+    fm_int    i;
 
     if (fmRootDebug == NULL)
     {
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    memset( fmRootDebug->fmGlobalDiagnostics.counters, 0,
-           sizeof(fmRootDebug->fmGlobalDiagnostics.counters) );
-
-    DROP_DBG_LOCK();
+    for (i = 0 ; i < FM_GLOBAL_CTR_MAX ; i++)
+    {
+        FM_ATOMIC_STORE_RELAXED(&fmRootDebug->fmGlobalDiagnostics.counters[i],
+                                0);
+    }
 
     return err;
 
@@ -1384,11 +1412,8 @@ fm_status fmDbgGlobalDiagCountGet(fm_globalDiagCounter counter,
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    *outValue = fmRootDebug->fmGlobalDiagnostics.counters[counter];
-
-    DROP_DBG_LOCK();
+    *outValue =
+        FM_ATOMIC_LOAD_RELAXED(&fmRootDebug->fmGlobalDiagnostics.counters[counter]);
 
     return err;
 
@@ -1425,11 +1450,8 @@ fm_status fmDbgGlobalDiagCountSet(fm_globalDiagCounter counter,
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    fmRootDebug->fmGlobalDiagnostics.counters[counter] = value;
-
-    DROP_DBG_LOCK();
+    FM_ATOMIC_STORE_RELAXED(&fmRootDebug->fmGlobalDiagnostics.counters[counter],
+                            value);
 
     return err;
 
@@ -1467,11 +1489,9 @@ fm_status fmDbgGlobalDiagCountIncr(fm_globalDiagCounter counter,
         return FM_ERR_UNSUPPORTED;
     }
 
-    TAKE_DBG_LOCK();
-
-    fmRootDebug->fmGlobalDiagnostics.counters[counter] += amount;
-
-    DROP_DBG_LOCK();
+    /* Lock-free: this is called on the packet path. */
+    FM_ATOMIC_ADD_RELAXED(&fmRootDebug->fmGlobalDiagnostics.counters[counter],
+                          amount);
 
     return err;
 
@@ -1901,12 +1921,7 @@ void fmDbgDumpBstTable(fm_int sw)
  *****************************************************************************/
 void fmDbgDumpThreads(void)
 {
-    extern void i(int taskNameOrId);
-
-
-#if 0
-    i(0);
-#endif
+    fmDbgDumpThreadPlacement();
 
 }   /* end fmDbgDumpThreads */
 
@@ -4296,6 +4311,8 @@ fm_status fmDbgSetPacketDefaultSourcePort(fm_int sw, fm_int sourcePort)
     switchPtr = GET_SWITCH_PTR(sw);
     switchPtr->defaultSourcePort = sourcePort;
 
+    FM_INVALIDATE_TX_DESTINATIONS(sw);
+
     UNPROTECT_SWITCH(sw);
 
     return FM_OK;
@@ -0,0 +1,973 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_debug_acl_bench.c
+ * Creation Date:   October 15, 2026
+ * Description:     ACL compile and apply benchmark.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* Maximum number of policers shared by the ACLs of a run */
+#define ACL_BENCH_MAX_POLICERS          16
+
+/* Number of L4 destination port ranges programmed in the mapper */
+#define ACL_BENCH_NUM_L4_RANGES         4
+
+/* Number of rules added to each ACL after the first apply, one for the
+ * non-disruptive step and one for the incremental step */
+#define ACL_BENCH_EXTRA_RULES           2
+
+/* Condition mixes of the generated rules */
+typedef enum
+{
+    ACL_BENCH_RULE_L2 = 0,
+    ACL_BENCH_RULE_L3,
+    ACL_BENCH_RULE_L4,
+    ACL_BENCH_RULE_L4_RANGE,
+    ACL_BENCH_RULE_DEEP_INSPECTION,
+    ACL_BENCH_RULE_MAX
+
+} fm_aclBenchRuleType;
+
+
+/* Operations timed by the benchmark */
+typedef enum
+{
+    ACL_BENCH_OP_CREATE_ACL = 0,
+    ACL_BENCH_OP_ADD_RULE,
+    ACL_BENCH_OP_COMPILE_FULL,
+    ACL_BENCH_OP_APPLY_FULL,
+    ACL_BENCH_OP_UPDATE_RULE,
+    ACL_BENCH_OP_COMPILE_NON_DISRUPTIVE,
+    ACL_BENCH_OP_APPLY_NON_DISRUPTIVE,
+    ACL_BENCH_OP_COMPILE_INCREMENTAL,
+    ACL_BENCH_OP_APPLY_INCREMENTAL,
+    ACL_BENCH_OP_MAX
+
+} fm_aclBenchOp;
+
+
+/* Measurements of one operation */
+typedef struct
+{
+    /* Latency of each successful call, in nanoseconds */
+    fm_uint64 * latency;
+    fm_int      count;
+    fm_int      failures;
+
+} fm_aclBenchStats;
+
+
+/* State of a benchmark run, see fmDbgAclBenchmark */
+typedef struct
+{
+    /* State of the rule generator */
+    fm_uint32        randState;
+
+    /* Number of policers created for the run */
+    fm_int           numPolicers;
+
+    /* First policer number, equal to the first ACL number */
+    fm_int           firstPolicer;
+
+    fm_aclBenchStats stats[ACL_BENCH_OP_MAX];
+
+} fm_aclBench;
+
+
+/* Share, in percent, of each condition mix among the generated rules */
+typedef struct
+{
+    fm_aclBenchRuleType type;
+    fm_int              weight;
+
+} fm_aclBenchRuleWeight;
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+static const fm_aclBenchRuleWeight aclRuleMix[] =
+{
+    { ACL_BENCH_RULE_L2,              20 },
+    { ACL_BENCH_RULE_L3,              40 },
+    { ACL_BENCH_RULE_L4,              25 },
+    { ACL_BENCH_RULE_L4_RANGE,        10 },
+    { ACL_BENCH_RULE_DEEP_INSPECTION,  5 },
+};
+
+/* L4 destination port ranges matched through the mapper */
+static const fm_uint16 aclL4Ranges[ACL_BENCH_NUM_L4_RANGES][2] =
+{
+    { 1,     1023  },
+    { 1024,  4095  },
+    { 4096,  32767 },
+    { 32768, 65535 },
+};
+
+static const fm_text aclBenchOpNames[ACL_BENCH_OP_MAX] =
+{
+    "fmCreateACLExt",
+    "fmAddACLRuleExt",
+    "fmCompileACLExt",
+    "fmApplyACLExt",
+    "fmUpdateACLRule",
+    "fmCompileACLExt (ND)",
+    "fmApplyACLExt (ND)",
+    "fmCompileACLExt (incr)",
+    "fmApplyACLExt (incr)",
+};
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** BenchRandom
+ * \ingroup intDiagMisc
+ *
+ * \desc            Returns the next number of the benchmark's xorshift
+ *                  generator, so that a seed always produces the same
+ *                  rules.
+ *
+ * \param[in,out]   bench points to the benchmark state.
+ *
+ * \return          A pseudo-random 32-bit number.
+ *
+ *****************************************************************************/
+static fm_uint32 BenchRandom(fm_aclBench *bench)
+{
+    fm_uint32 x;
+
+    x  = bench->randState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    bench->randState = x;
+
+    return x;
+
+}   /* end BenchRandom */
+
+
+
+
+/*****************************************************************************/
+/** BenchPickRuleType
+ * \ingroup intDiagMisc
+ *
+ * \desc            Picks the condition mix of a rule.
+ *
+ * \param[in,out]   bench points to the benchmark state.
+ *
+ * \return          The condition mix, see ''fm_aclBenchRuleType''.
+ *
+ *****************************************************************************/
+static fm_aclBenchRuleType BenchPickRuleType(fm_aclBench *bench)
+{
+    fm_int weight;
+    fm_int i;
+
+    weight = BenchRandom(bench) % 100;
+
+    for (i = 0 ; i < (fm_int) FM_NENTRIES(aclRuleMix) - 1 ; i++)
+    {
+        if (weight < aclRuleMix[i].weight)
+        {
+            break;
+        }
+        weight -= aclRuleMix[i].weight;
+    }
+
+    return aclRuleMix[i].type;
+
+}   /* end BenchPickRuleType */
+
+
+
+
+/*****************************************************************************/
+/** BenchMakeRule
+ * \ingroup intDiagMisc
+ *
+ * \desc            Generates the conditions, values and actions of a rule.
+ *                  Calling it again with the same rule type produces the
+ *                  same conditions and actions with new values, as
+ *                  ''fmUpdateACLRule'' expects.
+ *
+ * \param[in,out]   bench points to the benchmark state.
+ *
+ * \param[in]       type is the condition mix, see ''fm_aclBenchRuleType''.
+ *
+ * \param[in]       aclIndex is the position of the ACL in the run.
+ *
+ * \param[in]       rule is the rule number.
+ *
+ * \param[out]      cond points to caller-allocated storage where this
+ *                  function should place the rule conditions.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function should place the condition values.
+ *
+ * \param[out]      action points to caller-allocated storage where this
+ *                  function should place the rule actions.
+ *
+ * \param[out]      param points to caller-allocated storage where this
+ *                  function should place the action parameters.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchMakeRule(fm_aclBench *        bench,
+                          fm_aclBenchRuleType  type,
+                          fm_int               aclIndex,
+                          fm_int               rule,
+                          fm_aclCondition *    cond,
+                          fm_aclValue *        value,
+                          fm_aclActionExt *    action,
+                          fm_aclParamExt *     param)
+{
+    fm_uint32 r;
+    fm_int    prefixLength;
+    fm_int    i;
+
+    FM_CLEAR(*value);
+    FM_CLEAR(*param);
+
+    r = BenchRandom(bench);
+
+    switch (type)
+    {
+        case ACL_BENCH_RULE_L2:
+            *cond = FM_ACL_MATCH_DST_MAC | FM_ACL_MATCH_ETHERTYPE;
+            value->dst         = 0x000100000000LL | r;
+            value->dstMask     = 0xFFFFFFFFFFFFLL;
+            value->ethType     = (r & 1) ? 0x86DD : 0x0800;
+            value->ethTypeMask = 0xFFFF;
+            break;
+
+        case ACL_BENCH_RULE_L3:
+            *cond = FM_ACL_MATCH_SRC_IP | FM_ACL_MATCH_DST_IP |
+                    FM_ACL_MATCH_PROTOCOL | FM_ACL_MATCH_DSCP;
+            prefixLength = 16 + (r % 17);
+            value->srcIp.addr[0]     = htonl(0x0A000000 | (r & 0xFFFFFF));
+            value->srcIpMask.addr[0] =
+                htonl( 0xFFFFFFFF << (32 - prefixLength) );
+            value->dstIp.addr[0]     = htonl(0xC0A80000 | (r >> 16));
+            value->dstIpMask.addr[0] = htonl(0xFFFFFF00);
+            value->protocol          = (r & 2) ? 17 : 6;
+            value->protocolMask      = 0xFF;
+            value->dscp              = (r >> 8) & 0x3F;
+            value->dscpMask          = 0x3F;
+            break;
+
+        case ACL_BENCH_RULE_L4:
+            *cond = FM_ACL_MATCH_DST_IP | FM_ACL_MATCH_PROTOCOL |
+                    FM_ACL_MATCH_L4_DST_PORT_WITH_MASK |
+                    FM_ACL_MATCH_TCP_FLAGS;
+            value->dstIp.addr[0]     = htonl(0xAC100000 | (r & 0xFFFFF));
+            value->dstIpMask.addr[0] = htonl(0xFFFFFFFF);
+            value->protocol          = 6;
+            value->protocolMask      = 0xFF;
+            value->L4DstStart        = r >> 16;
+            value->L4DstMask         = 0xFFFF;
+            value->tcpFlags          = 0x02;
+            value->tcpFlagsMask      = 0x12;
+            break;
+
+        case ACL_BENCH_RULE_L4_RANGE:
+            *cond = FM_ACL_MATCH_PROTOCOL | FM_ACL_MATCH_L4_DST_PORT_MAP;
+            value->protocol            = (r & 1) ? 17 : 6;
+            value->protocolMask        = 0xFF;
+            value->mappedL4DstPort     = 1 + (r >> 8) % ACL_BENCH_NUM_L4_RANGES;
+            value->mappedL4DstPortMask = 0xFFFF;
+            break;
+
+        default:
+            *cond = FM_ACL_MATCH_PROTOCOL | FM_ACL_MATCH_L4_DEEP_INSPECTION_EXT;
+            value->protocol     = 17;
+            value->protocolMask = 0xFF;
+
+            for (i = 0 ; i < 4 ; i++)
+            {
+                value->L4DeepInspectionExt[i]     = (fm_byte) (r >> (8 * i));
+                value->L4DeepInspectionExtMask[i] = 0xFF;
+            }
+            break;
+    }
+
+    /* Every other ACL is scoped to a VLAN */
+    if (aclIndex & 1)
+    {
+        *cond |= FM_ACL_MATCH_VLAN;
+        value->vlanId     = 1 + (aclIndex % 4094);
+        value->vlanIdMask = 0xFFF;
+    }
+
+    /* Permit and deny alternate, some rules count or police */
+    *action = (rule & 1) ? FM_ACL_ACTIONEXT_DENY : FM_ACL_ACTIONEXT_PERMIT;
+
+    if ( (rule % 4) == 0 )
+    {
+        *action |= FM_ACL_ACTIONEXT_COUNT;
+    }
+    else if ( ( (rule % 8) == 3 ) && (bench->numPolicers > 0) )
+    {
+        *action      |= FM_ACL_ACTIONEXT_POLICE;
+        param->policer = bench->firstPolicer +
+                         (aclIndex % bench->numPolicers);
+    }
+
+}   /* end BenchMakeRule */
+
+
+
+
+/*****************************************************************************/
+/** BenchEnd
+ * \ingroup intDiagMisc
+ *
+ * \desc            Accounts for a timed operation.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[in]       op is the operation.
+ *
+ * \param[in]       err is the status returned by the operation.
+ *
+ * \param[in]       start is the time the operation started, in
+ *                  nanoseconds.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchEnd(fm_aclBench * bench,
+                     fm_aclBenchOp op,
+                     fm_status     err,
+                     fm_uint64     start)
+{
+    fm_aclBenchStats *stats;
+    fm_uint64         end;
+
+    end   = fmGetMonotonicNsec();
+    stats = &bench->stats[op];
+
+    if (err != FM_OK)
+    {
+        stats->failures++;
+        return;
+    }
+
+    stats->latency[stats->count++] = end - start;
+
+}   /* end BenchEnd */
+
+
+
+
+/*****************************************************************************/
+/** BenchCompareLatency
+ * \ingroup intDiagMisc
+ *
+ * \desc            Orders latencies for qsort.
+ *
+ * \param[in]       a points to the first latency.
+ *
+ * \param[in]       b points to the second latency.
+ *
+ * \return          -1, 0 or 1 as a is less than, equal to or greater than b.
+ *
+ *****************************************************************************/
+static int BenchCompareLatency(const void *a, const void *b)
+{
+    fm_uint64 la = *(const fm_uint64 *) a;
+    fm_uint64 lb = *(const fm_uint64 *) b;
+
+    return (la < lb) ? -1 : (la > lb) ? 1 : 0;
+
+}   /* end BenchCompareLatency */
+
+
+
+
+/*****************************************************************************/
+/** BenchPrintStats
+ * \ingroup intDiagMisc
+ *
+ * \desc            Prints the measurements of one operation.
+ *
+ * \param[in]       op is the operation.
+ *
+ * \param[in]       stats points to the measurements, whose latencies are
+ *                  sorted by this function.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchPrintStats(fm_aclBenchOp op, fm_aclBenchStats *stats)
+{
+    fm_uint64 *lat;
+    fm_int     n;
+
+    n   = stats->count;
+    lat = stats->latency;
+
+    if (n == 0 && stats->failures == 0)
+    {
+        return;
+    }
+
+    if (n == 0)
+    {
+        FM_LOG_PRINT("%-24s %7d %5d\n",
+                     aclBenchOpNames[op],
+                     n,
+                     stats->failures);
+        return;
+    }
+
+    qsort(lat, n, sizeof(fm_uint64), BenchCompareLatency);
+
+    FM_LOG_PRINT("%-24s %7d %5d %11" FM_FORMAT_64 "u %11" FM_FORMAT_64 "u "
+                 "%11" FM_FORMAT_64 "u %11" FM_FORMAT_64 "u\n",
+                 aclBenchOpNames[op],
+                 n,
+                 stats->failures,
+                 lat[(n - 1) * 50 / 100],
+                 lat[(n - 1) * 90 / 100],
+                 lat[(n - 1) * 99 / 100],
+                 lat[n - 1]);
+
+}   /* end BenchPrintStats */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fmDbgAclBenchmark
+ * \ingroup diagMisc
+ *
+ * \chips           FM10000
+ *
+ * \desc            Measures the cost of compiling and applying ACLs. The
+ *                  benchmark generates numAcls ingress ACLs of numRules
+ *                  rules each. The rules mix L2, L3 and L4 conditions,
+ *                  L4 port ranges matched through the L4 destination port
+ *                  mapper and L4 deep inspection. Every other ACL is bound
+ *                  to a single port, the others to all cardinal ports, and
+ *                  every other ACL also matches a VLAN. Some rules count
+ *                  frames and some are policed.
+ *                                                                      \lb\lb
+ *                  The benchmark then times a full compile and a
+ *                  disruptive apply, an ''fmUpdateACLRule'' of every rule,
+ *                  a non-disruptive compile and apply after adding one
+ *                  rule to each ACL, and an incremental compile and apply
+ *                  after adding another one. For each operation it prints
+ *                  the number of calls and failures and the 50th, 90th and
+ *                  99th percentile and maximum latencies in nanoseconds.
+ *                  It also prints the FFU resources reported by the
+ *                  compiler and the memory taken by the compiled image,
+ *                  measured as the growth of the allocator across the full
+ *                  compile.
+ *                                                                      \lb\lb
+ *                  Everything the benchmark creates is deleted at the end
+ *                  and the emptied configuration is applied, so ACLs
+ *                  configured outside the range are reapplied as well.
+ *                  The same seed always produces the same rules, so that
+ *                  runs can be compared across SDK releases.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       firstAcl is the number of the first ACL to create. ACLs
+ *                  firstAcl to firstAcl + numAcls - 1 must not exist, nor
+ *                  policers firstAcl to firstAcl + 15.
+ *
+ * \param[in]       numAcls is the number of ACLs to create.
+ *
+ * \param[in]       numRules is the number of rules generated in each ACL.
+ *
+ * \param[in]       seed seeds the rule generator. Must not be 0.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ * \return          Another error code if the ACLs could not be created or
+ *                  the first compile or apply failed.
+ *
+ *****************************************************************************/
+fm_status fmDbgAclBenchmark(fm_int    sw,
+                            fm_int    firstAcl,
+                            fm_int    numAcls,
+                            fm_int    numRules,
+                            fm_uint32 seed)
+{
+    fm_switch *           switchPtr;
+    fm_aclBench *         bench;
+    fm_byte *             ruleTypes;
+    fm_bool *             ruleAdded;
+    fm_bool *             aclCreated;
+    fm_aclCondition       cond;
+    fm_aclValue           value;
+    fm_aclActionExt       action;
+    fm_aclParamExt        param;
+    fm_aclPortAndType     portAndType;
+    fm_aclCompilerStats   compilerStats;
+    fm_l4PortMapperValue  l4Range;
+    fm_bool               l4RangeAdded[ACL_BENCH_NUM_L4_RANGES];
+    fm_char               statusText[256];
+    fm_status             err;
+    fm_status             opErr;
+    fm_uint64             start;
+    fm_uint32             memBefore;
+    fm_uint32             memAfter;
+    fm_bool               compiled;
+    fm_int                rulesPerAcl;
+    fm_int                numOps;
+    fm_int                acl;
+    fm_int                op;
+    fm_int                cpi;
+    fm_int                onePort;
+    fm_int                i;
+    fm_int                j;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_DEBUG,
+                 "sw=%d firstAcl=%d numAcls=%d numRules=%d seed=%u\n",
+                 sw,
+                 firstAcl,
+                 numAcls,
+                 numRules,
+                 seed);
+
+    if ( (firstAcl < 0) || (numAcls < 1) || (numRules < 1) || (seed == 0) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr   = GET_SWITCH_PTR(sw);
+    err         = FM_OK;
+    compiled    = FALSE;
+    memBefore   = 0;
+    memAfter    = 0;
+    ruleTypes   = NULL;
+    ruleAdded   = NULL;
+    aclCreated  = NULL;
+    rulesPerAcl = numRules + ACL_BENCH_EXTRA_RULES;
+    numOps      = numAcls * rulesPerAcl;
+
+    FM_CLEAR(compilerStats);
+    FM_CLEAR(l4RangeAdded);
+
+    bench = fmAlloc( sizeof(fm_aclBench) );
+
+    if (bench == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    FM_CLEAR(*bench);
+
+    bench->randState    = seed;
+    bench->firstPolicer = firstAcl;
+
+    ruleTypes  = fmAlloc( numOps * sizeof(fm_byte) );
+    ruleAdded  = fmAlloc( numOps * sizeof(fm_bool) );
+    aclCreated = fmAlloc( numAcls * sizeof(fm_bool) );
+
+    if ( (ruleTypes == NULL) || (ruleAdded == NULL) || (aclCreated == NULL) )
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    FM_MEMSET_S(ruleAdded,
+                numOps * sizeof(fm_bool),
+                0,
+                numOps * sizeof(fm_bool));
+    FM_MEMSET_S(aclCreated,
+                numAcls * sizeof(fm_bool),
+                0,
+                numAcls * sizeof(fm_bool));
+
+    for (op = 0 ; op < ACL_BENCH_OP_MAX ; op++)
+    {
+        bench->stats[op].latency = fmAlloc( numOps * sizeof(fm_uint64) );
+
+        if (bench->stats[op].latency == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            goto ABORT;
+        }
+    }
+
+    /* Shared resources, set up outside the measurements. Rules that need
+     * a resource that could not be created fail and are counted as such. */
+    for (i = 0 ; i < ACL_BENCH_NUM_L4_RANGES ; i++)
+    {
+        FM_CLEAR(l4Range);
+        l4Range.l4PortStart       = aclL4Ranges[i][0];
+        l4Range.l4PortEnd         = aclL4Ranges[i][1];
+        l4Range.mappedL4PortValue = i + 1;
+
+        l4RangeAdded[i] = (fmAddMapperEntry(sw,
+                                            FM_MAPPER_L4_DST,
+                                            &l4Range,
+                                            FM_MAPPER_ENTRY_MODE_APPLY)
+                           == FM_OK);
+    }
+
+    while ( (bench->numPolicers < ACL_BENCH_MAX_POLICERS) &&
+            (bench->numPolicers < numAcls) &&
+            (fmCreatePolicer(sw,
+                             FM_POLICER_BANK_AUTOMATIC,
+                             bench->firstPolicer + bench->numPolicers,
+                             NULL) == FM_OK) )
+    {
+        bench->numPolicers++;
+    }
+
+    /* Rule set */
+    for (i = 0 ; i < numAcls ; i++)
+    {
+        acl = firstAcl + i;
+
+        start = fmGetMonotonicNsec();
+        opErr = fmCreateACLExt(sw,
+                               acl,
+                               FM_ACL_SCENARIO_ANY_FRAME_TYPE |
+                               FM_ACL_SCENARIO_ANY_ROUTING_TYPE,
+                               FM_ACL_DEFAULT_PRECEDENCE);
+        BenchEnd(bench, ACL_BENCH_OP_CREATE_ACL, opErr, start);
+
+        if (opErr != FM_OK)
+        {
+            err = opErr;
+            goto ABORT;
+        }
+
+        aclCreated[i] = TRUE;
+
+        /* Port scope: every other ACL on a single port. Cardinal port
+         * index 0 is the CPU port. */
+        portAndType.type = FM_ACL_TYPE_INGRESS;
+        onePort          = (switchPtr->numCardinalPorts > 1)
+                           ? 1 + ( i % (switchPtr->numCardinalPorts - 1) )
+                           : 0;
+
+        for (cpi = 1 ; cpi < switchPtr->numCardinalPorts ; cpi++)
+        {
+            if ( (i & 1) && (cpi != onePort) )
+            {
+                continue;
+            }
+
+            portAndType.port = GET_LOGICAL_PORT(sw, cpi);
+            fmAddACLPortExt(sw, acl, &portAndType);
+        }
+
+        for (j = 0 ; j < numRules ; j++)
+        {
+            ruleTypes[i * rulesPerAcl + j] = BenchPickRuleType(bench);
+
+            BenchMakeRule(bench,
+                          ruleTypes[i * rulesPerAcl + j],
+                          i,
+                          j,
+                          &cond,
+                          &value,
+                          &action,
+                          &param);
+
+            start = fmGetMonotonicNsec();
+            opErr = fmAddACLRuleExt(sw, acl, j, cond, &value, action, &param);
+            BenchEnd(bench, ACL_BENCH_OP_ADD_RULE, opErr, start);
+
+            ruleAdded[i * rulesPerAcl + j] = (opErr == FM_OK);
+        }
+    }
+
+    /* Full compile and disruptive apply */
+    fmGetAllocatedMemorySize(&memBefore);
+
+    start = fmGetMonotonicNsec();
+    opErr = fmCompileACLExt(sw,
+                            statusText,
+                            sizeof(statusText),
+                            FM_ACL_COMPILE_FLAG_RETURN_STATS,
+                            &compilerStats);
+    BenchEnd(bench, ACL_BENCH_OP_COMPILE_FULL, opErr, start);
+
+    fmGetAllocatedMemorySize(&memAfter);
+
+    if (opErr != FM_OK)
+    {
+        FM_LOG_PRINT("ACL compile failed: %s\n", statusText);
+        err = opErr;
+        goto ABORT;
+    }
+
+    compiled = TRUE;
+
+    start = fmGetMonotonicNsec();
+    opErr = fmApplyACLExt(sw, 0, NULL);
+    BenchEnd(bench, ACL_BENCH_OP_APPLY_FULL, opErr, start);
+
+    if (opErr != FM_OK)
+    {
+        err = opErr;
+        goto ABORT;
+    }
+
+    /* In-place rule updates */
+    for (i = 0 ; i < numAcls ; i++)
+    {
+        for (j = 0 ; j < numRules ; j++)
+        {
+            if (!ruleAdded[i * rulesPerAcl + j])
+            {
+                continue;
+            }
+
+            BenchMakeRule(bench,
+                          ruleTypes[i * rulesPerAcl + j],
+                          i,
+                          j,
+                          &cond,
+                          &value,
+                          &action,
+                          &param);
+
+            start = fmGetMonotonicNsec();
+            opErr = fmUpdateACLRule(sw,
+                                    firstAcl + i,
+                                    j,
+                                    cond,
+                                    &value,
+                                    action,
+                                    &param);
+            BenchEnd(bench, ACL_BENCH_OP_UPDATE_RULE, opErr, start);
+        }
+    }
+
+    /* One new rule per ACL, compiled and applied non-disruptively, then
+     * another one compiled incrementally */
+    for (op = ACL_BENCH_OP_COMPILE_NON_DISRUPTIVE ;
+         op <= ACL_BENCH_OP_COMPILE_INCREMENTAL ;
+         op += 2)
+    {
+        j = (op == ACL_BENCH_OP_COMPILE_NON_DISRUPTIVE) ? numRules
+                                                        : numRules + 1;
+
+        for (i = 0 ; i < numAcls ; i++)
+        {
+            ruleTypes[i * rulesPerAcl + j] = BenchPickRuleType(bench);
+
+            BenchMakeRule(bench,
+                          ruleTypes[i * rulesPerAcl + j],
+                          i,
+                          j,
+                          &cond,
+                          &value,
+                          &action,
+                          &param);
+
+            opErr = fmAddACLRuleExt(sw,
+                                    firstAcl + i,
+                                    j,
+                                    cond,
+                                    &value,
+                                    action,
+                                    &param);
+
+            ruleAdded[i * rulesPerAcl + j] = (opErr == FM_OK);
+        }
+
+        start = fmGetMonotonicNsec();
+        opErr = fmCompileACLExt(sw,
+                                statusText,
+                                sizeof(statusText),
+                                (op == ACL_BENCH_OP_COMPILE_NON_DISRUPTIVE)
+                                    ? FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE
+                                    : FM_ACL_COMPILE_FLAG_INCREMENTAL,
+                                NULL);
+        BenchEnd(bench, op, opErr, start);
+
+        if (opErr != FM_OK)
+        {
+            continue;
+        }
+
+        start = fmGetMonotonicNsec();
+        opErr = fmApplyACLExt(sw,
+                              (op == ACL_BENCH_OP_COMPILE_NON_DISRUPTIVE)
+                                  ? FM_ACL_APPLY_FLAG_NON_DISRUPTIVE
+                                  : 0,
+                              NULL);
+        BenchEnd(bench, op + 1, opErr, start);
+    }
+
+ABORT:
+
+    /* Delete whatever was created, even after a failure */
+    if (aclCreated != NULL)
+    {
+        for (i = 0 ; i < numAcls ; i++)
+        {
+            if (aclCreated[i])
+            {
+                fmDeleteACL(sw, firstAcl + i);
+            }
+        }
+
+        if (compiled)
+        {
+            if (fmCompileACLExt(sw, statusText, sizeof(statusText), 0, NULL)
+                == FM_OK)
+            {
+                fmApplyACLExt(sw, 0, NULL);
+            }
+        }
+    }
+
+    if (bench != NULL)
+    {
+        for (i = 0 ; i < bench->numPolicers ; i++)
+        {
+            fmDeletePolicer(sw, bench->firstPolicer + i);
+        }
+    }
+
+    for (i = 0 ; i < ACL_BENCH_NUM_L4_RANGES ; i++)
+    {
+        if (l4RangeAdded[i])
+        {
+            FM_CLEAR(l4Range);
+            l4Range.l4PortStart       = aclL4Ranges[i][0];
+            l4Range.l4PortEnd         = aclL4Ranges[i][1];
+            l4Range.mappedL4PortValue = i + 1;
+
+            fmDeleteMapperEntry(sw,
+                                FM_MAPPER_L4_DST,
+                                &l4Range,
+                                FM_MAPPER_ENTRY_MODE_APPLY);
+        }
+    }
+
+    if ( (bench != NULL) && (aclCreated != NULL) )
+    {
+        FM_LOG_PRINT("\nACL benchmark: sw=%d acls=%d-%d rules=%d seed=%u "
+                     "policers=%d\n",
+                     sw,
+                     firstAcl,
+                     firstAcl + numAcls - 1,
+                     numRules,
+                     seed,
+                     bench->numPolicers);
+        FM_LOG_PRINT("%-24s %7s %5s %11s %11s %11s %11s\n",
+                     "Operation",
+                     "Calls",
+                     "Fail",
+                     "p50 ns",
+                     "p90 ns",
+                     "p99 ns",
+                     "max ns");
+
+        for (op = 0 ; op < ACL_BENCH_OP_MAX ; op++)
+        {
+            BenchPrintStats(op, &bench->stats[op]);
+        }
+
+        if (compiled)
+        {
+            FM_LOG_PRINT("\nCompiled image: %u bytes, "
+                         "ingress minslices: %u, egress minslices: %u, "
+                         "policer banks: %u\n"
+                         "Most CAM lines: %u (ACL %d), "
+                         "L4 dst mapper slots: %u\n",
+                         (memAfter > memBefore) ? memAfter - memBefore : 0,
+                         compilerStats.minSlicesIngress,
+                         compilerStats.minSlicesEgress,
+                         compilerStats.policerBanksUsed,
+                         compilerStats.mostRulesUsed,
+                         compilerStats.aclWithMostRules,
+                         compilerStats.l4DstMapperSlots);
+        }
+    }
+
+    if (bench != NULL)
+    {
+        for (op = 0 ; op < ACL_BENCH_OP_MAX ; op++)
+        {
+            if (bench->stats[op].latency != NULL)
+            {
+                fmFree(bench->stats[op].latency);
+            }
+        }
+
+        fmFree(bench);
+    }
+
+    if (ruleTypes != NULL)
+    {
+        fmFree(ruleTypes);
+    }
+
+    if (ruleAdded != NULL)
+    {
+        fmFree(ruleAdded);
+    }
+
+    if (aclCreated != NULL)
+    {
+        fmFree(aclCreated);
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_DEBUG, err);
+
+}   /* end fmDbgAclBenchmark */
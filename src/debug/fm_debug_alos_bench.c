@@ -0,0 +1,1198 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_debug_alos_bench.c
+ * Creation Date:   October 15, 2026
+ * Description:     ALOS primitive micro-benchmarks.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* Size of the bit array searched by the bit array benchmarks */
+#define ALOS_BENCH_BIT_COUNT            16384
+
+/* The bit array is full except for a run of clear bits of this length
+ * every ALOS_BENCH_BIT_STRIDE bits */
+#define ALOS_BENCH_BIT_HOLE             16
+#define ALOS_BENCH_BIT_STRIDE           2048
+
+/* Length of the blocks and runs looked for in the bit array */
+#define ALOS_BENCH_BIT_LENGTH           8
+
+/* Operations timed by the benchmark */
+typedef enum
+{
+    ALOS_BENCH_LOCK = 0,
+    ALOS_BENCH_READ_LOCK,
+    ALOS_BENCH_WRITE_LOCK,
+    ALOS_BENCH_EVENT_QUEUE,
+    ALOS_BENCH_EVENT_RING,
+    ALOS_BENCH_ALLOCATE_EVENT,
+    ALOS_BENCH_ALLOC_64,
+    ALOS_BENCH_ALLOC_1K,
+    ALOS_BENCH_ALLOC_16K,
+    ALOS_BENCH_LOG_DISABLED,
+    ALOS_BENCH_TREE_INSERT,
+    ALOS_BENCH_TREE_FIND,
+    ALOS_BENCH_TREE_ITER,
+    ALOS_BENCH_BIT_FIND,
+    ALOS_BENCH_BIT_BLOCK,
+    ALOS_BENCH_BIT_RUN,
+    ALOS_BENCH_TIMER,
+    ALOS_BENCH_OP_MAX
+
+} fm_alosBenchOp;
+
+
+typedef struct _fm_alosBench fm_alosBench;
+
+
+/* A thread running an operation */
+typedef struct
+{
+    fm_alosBench * bench;
+
+    fm_thread      thread;
+
+    /* Event the worker moves through the event queues */
+    fm_event *     event;
+
+    /* Time the worker took to run the operation, in nanoseconds */
+    fm_uint64      elapsed;
+
+    fm_status      err;
+
+} fm_alosBenchWorker;
+
+
+/* Runs iterations of an operation on behalf of a worker */
+typedef fm_status (*fm_alosBenchFunc)(fm_alosBench *      bench,
+                                      fm_alosBenchWorker *worker);
+
+
+/* Description of an operation */
+typedef struct
+{
+    fm_text          name;
+
+    fm_alosBenchFunc func;
+
+    /* TRUE if the operation may run in several threads at once, FALSE
+     * for the ones working on structures that are not thread-safe */
+    fm_bool          threaded;
+
+} fm_alosBenchOpDesc;
+
+
+/* State of a benchmark run, see fmDbgAlosBenchmark */
+struct _fm_alosBench
+{
+    fm_int              iterations;
+
+    /* Operation being run */
+    fm_int              op;
+
+    /* Workers ready to run, and start signal */
+    fm_int              ready;
+    fm_bool             go;
+
+    fm_alosBenchWorker *workers;
+
+    fm_lock             lock;
+    fm_rwLock           rwLock;
+    fm_eventQueue       listQueue;
+    fm_eventQueue       ringQueue;
+    fm_tree             tree;
+    fm_bitArray         bits;
+    fm_timerHandle      timer;
+
+};
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local function prototypes.
+ *****************************************************************************/
+
+static fm_status BenchLock(fm_alosBench *bench, fm_alosBenchWorker *worker);
+static fm_status BenchReadLock(fm_alosBench *      bench,
+                               fm_alosBenchWorker *worker);
+static fm_status BenchWriteLock(fm_alosBench *      bench,
+                                fm_alosBenchWorker *worker);
+static fm_status BenchEventQueue(fm_alosBench *      bench,
+                                 fm_alosBenchWorker *worker);
+static fm_status BenchAllocateEvent(fm_alosBench *      bench,
+                                    fm_alosBenchWorker *worker);
+static fm_status BenchAlloc(fm_alosBench *bench, fm_alosBenchWorker *worker);
+static fm_status BenchLogDisabled(fm_alosBench *      bench,
+                                  fm_alosBenchWorker *worker);
+static fm_status BenchTree(fm_alosBench *bench, fm_alosBenchWorker *worker);
+static fm_status BenchBitArray(fm_alosBench *      bench,
+                               fm_alosBenchWorker *worker);
+static fm_status BenchTimer(fm_alosBench *bench, fm_alosBenchWorker *worker);
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+static const fm_alosBenchOpDesc alosBenchOps[ALOS_BENCH_OP_MAX] =
+{
+    { "fmCaptureLock+Release",       BenchLock,           TRUE  },
+    { "fmCaptureReadLock+Release",   BenchReadLock,       TRUE  },
+    { "fmCaptureWriteLock+Release",  BenchWriteLock,      TRUE  },
+    { "fmEventQueueAdd+Get",         BenchEventQueue,     TRUE  },
+    { "fmEventQueueAdd+Get (ring)",  BenchEventQueue,     TRUE  },
+    { "fmAllocateEvent+Release",     BenchAllocateEvent,  TRUE  },
+    { "fmAlloc+fmFree 64",           BenchAlloc,          TRUE  },
+    { "fmAlloc+fmFree 1K",           BenchAlloc,          TRUE  },
+    { "fmAlloc+fmFree 16K",          BenchAlloc,          TRUE  },
+    { "FM_LOG_DEBUG (disabled)",     BenchLogDisabled,    TRUE  },
+    { "fmTreeInsert",                BenchTree,           FALSE },
+    { "fmTreeFind",                  BenchTree,           FALSE },
+    { "fmTreeIterNext",              BenchTree,           FALSE },
+    { "fmFindBitInBitArray",         BenchBitArray,       FALSE },
+    { "fmFindBitBlockInBitArray",    BenchBitArray,       FALSE },
+    { "fmFindBitRunInBitArray",      BenchBitArray,       FALSE },
+    { "fmStartTimer+fmStopTimer",    BenchTimer,          FALSE },
+};
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** BenchTreeKey
+ * \ingroup intDiagMisc
+ *
+ * \desc            Returns the tree key of an iteration, scattered so that
+ *                  the keys are not inserted in order.
+ *
+ * \param[in]       i is the iteration.
+ *
+ * \return          The key.
+ *
+ *****************************************************************************/
+static fm_uint64 BenchTreeKey(fm_int i)
+{
+    return (fm_uint64) i * FM_LITERAL_U64(0x9E3779B97F4A7C15);
+
+}   /* end BenchTreeKey */
+
+
+
+
+/*****************************************************************************/
+/** BenchLock
+ * \ingroup intDiagMisc
+ *
+ * \desc            Takes and releases the shared lock.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[in]       worker points to the worker.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status BenchLock(fm_alosBench *bench, fm_alosBenchWorker *worker)
+{
+    fm_status err;
+    fm_int    i;
+
+    FM_NOT_USED(worker);
+
+    for (i = 0 ; i < bench->iterations ; i++)
+    {
+        err = fmCaptureLock(&bench->lock, FM_WAIT_FOREVER);
+
+        if (err != FM_OK)
+        {
+            return err;
+        }
+
+        fmReleaseLock(&bench->lock);
+    }
+
+    return FM_OK;
+
+}   /* end BenchLock */
+
+
+
+
+/*****************************************************************************/
+/** BenchReadLock
+ * \ingroup intDiagMisc
+ *
+ * \desc            Takes and releases the shared read/write lock for
+ *                  reading.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[in]       worker points to the worker.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status BenchReadLock(fm_alosBench *      bench,
+                               fm_alosBenchWorker *worker)
+{
+    fm_status err;
+    fm_int    i;
+
+    FM_NOT_USED(worker);
+
+    for (i = 0 ; i < bench->iterations ; i++)
+    {
+        err = fmCaptureReadLock(&bench->rwLock, FM_WAIT_FOREVER);
+
+        if (err != FM_OK)
+        {
+            return err;
+        }
+
+        fmReleaseReadLock(&bench->rwLock);
+    }
+
+    return FM_OK;
+
+}   /* end BenchReadLock */
+
+
+
+
+/*****************************************************************************/
+/** BenchWriteLock
+ * \ingroup intDiagMisc
+ *
+ * \desc            Takes and releases the shared read/write lock for
+ *                  writing.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[in]       worker points to the worker.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status BenchWriteLock(fm_alosBench *      bench,
+                                fm_alosBenchWorker *worker)
+{
+    fm_status err;
+    fm_int    i;
+
+    FM_NOT_USED(worker);
+
+    for (i = 0 ; i < bench->iterations ; i++)
+    {
+        err = fmCaptureWriteLock(&bench->rwLock, FM_WAIT_FOREVER);
+
+        if (err != FM_OK)
+        {
+            return err;
+        }
+
+        fmReleaseWriteLock(&bench->rwLock);
+    }
+
+    return FM_OK;
+
+}   /* end BenchWriteLock */
+
+
+
+
+/*****************************************************************************/
+/** BenchEventQueue
+ * \ingroup intDiagMisc
+ *
+ * \desc            Adds an event to a shared event queue and gets one
+ *                  back. The event got, which may be another worker's,
+ *                  is the one added next, so that no event is ever added
+ *                  while it is still queued. A ring slot that another
+ *                  worker is still filling or emptying makes the ring look
+ *                  empty or full for a moment, so both are retried.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[in,out]   worker points to the worker.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status BenchEventQueue(fm_alosBench *      bench,
+                                 fm_alosBenchWorker *worker)
+{
+    fm_eventQueue *q;
+    fm_status      err;
+    fm_int         i;
+
+    q = (bench->op == ALOS_BENCH_EVENT_RING) ? &bench->ringQueue
+                                             : &bench->listQueue;
+
+    for (i = 0 ; i < bench->iterations ; i++)
+    {
+        do
+        {
+            err = fmEventQueueAdd(q, worker->event);
+        }
+        while (err == FM_ERR_EVENT_QUEUE_FULL);
+
+        if (err != FM_OK)
+        {
+            return err;
+        }
+
+        do
+        {
+            err = fmEventQueueGet(q, &worker->event);
+        }
+        while (err == FM_ERR_NO_EVENTS_AVAILABLE);
+
+        if (err != FM_OK)
+        {
+            return err;
+        }
+    }
+
+    return FM_OK;
+
+}   /* end BenchEventQueue */
+
+
+
+
+/*****************************************************************************/
+/** BenchAllocateEvent
+ * \ingroup intDiagMisc
+ *
+ * \desc            Allocates and releases an event.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[in]       worker points to the worker.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_EVENTS_AVAILABLE if no event was available.
+ *
+ *****************************************************************************/
+static fm_status BenchAllocateEvent(fm_alosBench *      bench,
+                                    fm_alosBenchWorker *worker)
+{
+    fm_event *event;
+    fm_int    i;
+
+    FM_NOT_USED(worker);
+
+    for (i = 0 ; i < bench->iterations ; i++)
+    {
+        event = fmAllocateEvent(FM_FIRST_FOCALPOINT,
+                                FM_EVID_LOW_SOFTWARE,
+                                FM_EVENT_SOFTWARE,
+                                FM_EVENT_PRIORITY_LOW);
+
+        if (event == NULL)
+        {
+            return FM_ERR_NO_EVENTS_AVAILABLE;
+        }
+
+        fmReleaseEvent(event);
+    }
+
+    return FM_OK;
+
+}   /* end BenchAllocateEvent */
+
+
+
+
+/*****************************************************************************/
+/** BenchAlloc
+ * \ingroup intDiagMisc
+ *
+ * \desc            Allocates and frees a block of the operation's size.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[in]       worker points to the worker.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status BenchAlloc(fm_alosBench *bench, fm_alosBenchWorker *worker)
+{
+    void *    block;
+    fm_uint32 size;
+    fm_int    i;
+
+    FM_NOT_USED(worker);
+
+    switch (bench->op)
+    {
+        case ALOS_BENCH_ALLOC_64:
+            size = 64;
+            break;
+
+        case ALOS_BENCH_ALLOC_1K:
+            size = 1024;
+            break;
+
+        default:
+            size = 16384;
+            break;
+    }
+
+    for (i = 0 ; i < bench->iterations ; i++)
+    {
+        block = fmAlloc(size);
+
+        if (block == NULL)
+        {
+            return FM_ERR_NO_MEM;
+        }
+
+        fmFree(block);
+    }
+
+    return FM_OK;
+
+}   /* end BenchAlloc */
+
+
+
+
+/*****************************************************************************/
+/** BenchLogDisabled
+ * \ingroup intDiagMisc
+ *
+ * \desc            Logs a debug message in the debug category, which the
+ *                  caller checked is disabled.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[in]       worker points to the worker.
+ *
+ * \return          FM_OK.
+ *
+ *****************************************************************************/
+static fm_status BenchLogDisabled(fm_alosBench *      bench,
+                                  fm_alosBenchWorker *worker)
+{
+    fm_int i;
+
+    FM_NOT_USED(worker);
+
+    for (i = 0 ; i < bench->iterations ; i++)
+    {
+        FM_LOG_DEBUG(FM_LOG_CAT_DEBUG, "iteration %d\n", i);
+    }
+
+    return FM_OK;
+
+}   /* end BenchLogDisabled */
+
+
+
+
+/*****************************************************************************/
+/** BenchTree
+ * \ingroup intDiagMisc
+ *
+ * \desc            Inserts one key per iteration in the tree, finds each
+ *                  of them or iterates over them, depending on the
+ *                  operation. The operations run in that order.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[in]       worker points to the worker.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status BenchTree(fm_alosBench *bench, fm_alosBenchWorker *worker)
+{
+    fm_treeIterator it;
+    fm_status       err;
+    fm_uint64       key;
+    void *          value;
+    fm_int          i;
+
+    FM_NOT_USED(worker);
+
+    err = FM_OK;
+
+    switch (bench->op)
+    {
+        case ALOS_BENCH_TREE_INSERT:
+            for (i = 0 ; (i < bench->iterations) && (err == FM_OK) ; i++)
+            {
+                err = fmTreeInsert(&bench->tree, BenchTreeKey(i), bench);
+            }
+            break;
+
+        case ALOS_BENCH_TREE_FIND:
+            for (i = 0 ; (i < bench->iterations) && (err == FM_OK) ; i++)
+            {
+                err = fmTreeFind(&bench->tree, BenchTreeKey(i), &value);
+            }
+            break;
+
+        default:
+            fmTreeIterInit(&it, &bench->tree);
+
+            while ( (err = fmTreeIterNext(&it, &key, &value)) == FM_OK )
+            {
+            }
+
+            if (err == FM_ERR_NO_MORE)
+            {
+                err = FM_OK;
+            }
+            break;
+    }
+
+    return err;
+
+}   /* end BenchTree */
+
+
+
+
+/*****************************************************************************/
+/** BenchBitArray
+ * \ingroup intDiagMisc
+ *
+ * \desc            Searches the bit array for a clear bit, a block of
+ *                  clear bits or a run of clear bits, depending on the
+ *                  operation, from a starting bit that moves with each
+ *                  iteration.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[in]       worker points to the worker.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status BenchBitArray(fm_alosBench *      bench,
+                               fm_alosBenchWorker *worker)
+{
+    fm_status err;
+    fm_int    first;
+    fm_int    found;
+    fm_int    i;
+
+    FM_NOT_USED(worker);
+
+    err = FM_OK;
+
+    for (i = 0 ; (i < bench->iterations) && (err == FM_OK) ; i++)
+    {
+        first = (i * 97) % (ALOS_BENCH_BIT_COUNT - ALOS_BENCH_BIT_STRIDE);
+
+        switch (bench->op)
+        {
+            case ALOS_BENCH_BIT_FIND:
+                err = fmFindBitInBitArray(&bench->bits, first, FALSE, &found);
+                break;
+
+            case ALOS_BENCH_BIT_BLOCK:
+                err = fmFindBitBlockInBitArray(&bench->bits,
+                                               first,
+                                               ALOS_BENCH_BIT_LENGTH,
+                                               FALSE,
+                                               &found);
+                break;
+
+            default:
+                err = fmFindBitRunInBitArray(&bench->bits,
+                                             first,
+                                             ALOS_BENCH_BIT_LENGTH,
+                                             &found);
+                break;
+        }
+    }
+
+    return err;
+
+}   /* end BenchBitArray */
+
+
+
+
+/*****************************************************************************/
+/** BenchTimerCallback
+ * \ingroup intDiagMisc
+ *
+ * \desc            Callback of the benchmark timer, which is always
+ *                  stopped before it expires.
+ *
+ * \param[in]       arg is not used.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchTimerCallback(void *arg)
+{
+    FM_NOT_USED(arg);
+
+}   /* end BenchTimerCallback */
+
+
+
+
+/*****************************************************************************/
+/** BenchTimer
+ * \ingroup intDiagMisc
+ *
+ * \desc            Starts the timer for an hour and stops it.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[in]       worker points to the worker.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status BenchTimer(fm_alosBench *bench, fm_alosBenchWorker *worker)
+{
+    fm_timestamp timeout = { 3600, 0 };
+    fm_status    err;
+    fm_int       i;
+
+    FM_NOT_USED(worker);
+
+    for (i = 0 ; i < bench->iterations ; i++)
+    {
+        err = fmStartTimer(bench->timer,
+                           &timeout,
+                           1,
+                           BenchTimerCallback,
+                           NULL);
+
+        if (err != FM_OK)
+        {
+            return err;
+        }
+
+        err = fmStopTimer(bench->timer);
+
+        if (err != FM_OK)
+        {
+            return err;
+        }
+    }
+
+    return FM_OK;
+
+}   /* end BenchTimer */
+
+
+
+
+/*****************************************************************************/
+/** BenchRunWorker
+ * \ingroup intDiagMisc
+ *
+ * \desc            Waits for the start signal and runs the operation.
+ *
+ * \param[in,out]   worker points to the worker.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchRunWorker(fm_alosBenchWorker *worker)
+{
+    fm_alosBench *bench;
+    fm_uint64     start;
+
+    bench = worker->bench;
+
+    FM_ATOMIC_ADD(&bench->ready, 1);
+
+    while ( !FM_ATOMIC_LOAD(&bench->go) )
+    {
+        fmYield();
+    }
+
+    start           = fmGetMonotonicNsec();
+    worker->err     = alosBenchOps[bench->op].func(bench, worker);
+    worker->elapsed = fmGetMonotonicNsec() - start;
+
+}   /* end BenchRunWorker */
+
+
+
+
+/*****************************************************************************/
+/** BenchWorkerThread
+ * \ingroup intDiagMisc
+ *
+ * \desc            Body of the threads running an operation.
+ *
+ * \param[in]       args points to the thread arguments, the parameter
+ *                  being the worker.
+ *
+ * \return          NULL.
+ *
+ *****************************************************************************/
+static void *BenchWorkerThread(void *args)
+{
+    fm_thread *         thread;
+    fm_alosBenchWorker *worker;
+
+    thread = FM_GET_THREAD_HANDLE(args);
+    worker = FM_GET_THREAD_PARAM(fm_alosBenchWorker, args);
+
+    BenchRunWorker(worker);
+
+    fmExitThread(thread);
+
+    return NULL;
+
+}   /* end BenchWorkerThread */
+
+
+
+
+/*****************************************************************************/
+/** BenchRunOp
+ * \ingroup intDiagMisc
+ *
+ * \desc            Runs an operation in a number of threads at once and
+ *                  prints the time per operation seen by the slowest
+ *                  thread and the number of operations per second of all
+ *                  threads together. A single thread runs in the caller.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[in]       op is the operation.
+ *
+ * \param[in]       numThreads is the number of threads.
+ *
+ * \return          FM_OK if successful.
+ * \return          Another error code if a thread could not be created.
+ *
+ *****************************************************************************/
+static fm_status BenchRunOp(fm_alosBench *bench,
+                            fm_int        op,
+                            fm_int        numThreads)
+{
+    fm_alosBenchWorker *worker;
+    fm_status           err;
+    fm_status           opErr;
+    fm_uint64           elapsed;
+    fm_char             threadName[32];
+    fm_int              started;
+    fm_int              i;
+
+    bench->op    = op;
+    bench->ready = 0;
+    bench->go    = (numThreads == 1);
+    err          = FM_OK;
+
+    if (numThreads == 1)
+    {
+        BenchRunWorker(&bench->workers[0]);
+        started = 1;
+    }
+    else
+    {
+        for (started = 0 ; started < numThreads ; started++)
+        {
+            worker = &bench->workers[started];
+
+            FM_SPRINTF_S(threadName,
+                         sizeof(threadName),
+                         "alosBench%d",
+                         started);
+
+            err = fmCreateThread(threadName,
+                                 FM_EVENT_QUEUE_SIZE_NONE,
+                                 BenchWorkerThread,
+                                 worker,
+                                 &worker->thread);
+
+            if (err != FM_OK)
+            {
+                break;
+            }
+        }
+
+        while (FM_ATOMIC_LOAD(&bench->ready) < started)
+        {
+            fmYield();
+        }
+
+        FM_ATOMIC_STORE(&bench->go, TRUE);
+
+        for (i = 0 ; i < started ; i++)
+        {
+            fmWaitThreadExit(&bench->workers[i].thread);
+        }
+    }
+
+    elapsed = 0;
+    opErr   = FM_OK;
+
+    for (i = 0 ; i < started ; i++)
+    {
+        worker = &bench->workers[i];
+
+        if (worker->elapsed > elapsed)
+        {
+            elapsed = worker->elapsed;
+        }
+
+        if (worker->err != FM_OK)
+        {
+            opErr = worker->err;
+        }
+    }
+
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    if (opErr != FM_OK)
+    {
+        FM_LOG_PRINT("%-28s %7d failed: %s\n",
+                     alosBenchOps[op].name,
+                     numThreads,
+                     fmErrorMsg(opErr));
+    }
+    else
+    {
+        FM_LOG_PRINT("%-28s %7d %10" FM_FORMAT_64 "u %14" FM_FORMAT_64 "u\n",
+                     alosBenchOps[op].name,
+                     numThreads,
+                     elapsed / bench->iterations,
+                     (elapsed > 0)
+                     ? (fm_uint64) numThreads * bench->iterations *
+                       FM_LITERAL_U64(1000000000) / elapsed
+                     : 0);
+    }
+
+    return FM_OK;
+
+}   /* end BenchRunOp */
+
+
+
+
+/*****************************************************************************/
+/** BenchInitBits
+ * \ingroup intDiagMisc
+ *
+ * \desc            Fills the bit array, leaving holes of clear bits at
+ *                  regular intervals as a block allocator would.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status BenchInitBits(fm_alosBench *bench)
+{
+    fm_status err;
+    fm_int    bit;
+
+    err = fmCreateBitArray(&bench->bits, ALOS_BENCH_BIT_COUNT);
+
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    err = fmSetBitArrayBlock(&bench->bits, 0, ALOS_BENCH_BIT_COUNT, TRUE);
+
+    for (bit = ALOS_BENCH_BIT_STRIDE - ALOS_BENCH_BIT_HOLE ;
+         (bit < ALOS_BENCH_BIT_COUNT) && (err == FM_OK) ;
+         bit += ALOS_BENCH_BIT_STRIDE)
+    {
+        err = fmSetBitArrayBlock(&bench->bits,
+                                 bit,
+                                 ALOS_BENCH_BIT_HOLE,
+                                 FALSE);
+    }
+
+    return err;
+
+}   /* end BenchInitBits */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fmDbgAlosBenchmark
+ * \ingroup diagMisc
+ *
+ * \chips           FM10000
+ *
+ * \desc            Measures the cost of the ALOS primitives the API relies
+ *                  on, without using the switch: taking and releasing a
+ *                  lock and a read/write lock for reading and writing,
+ *                  adding an event to an event queue and getting it back,
+ *                  for list and ring queues, allocating and releasing an
+ *                  event, allocating and freeing 64 byte, 1 KB and 16 KB
+ *                  blocks and logging a debug message whose category is
+ *                  disabled. Each of these runs in 1, 2, 4 and so on up to
+ *                  maxThreads threads at once, all working on the same
+ *                  lock, queue or pool, so that the contended cases show
+ *                  how the primitive scales.
+ *                                                                      \lb\lb
+ *                  Inserting keys in a tree, finding them and iterating
+ *                  over them, searching a bit array for a clear bit, a
+ *                  block and a run of clear bits, and starting and
+ *                  stopping a timer run in a single thread, as these
+ *                  structures are not shared.
+ *                                                                      \lb\lb
+ *                  For each operation and number of threads the benchmark
+ *                  prints the nanoseconds per operation seen by the
+ *                  slowest thread and the operations per second of all
+ *                  threads together. The logging benchmark is skipped if
+ *                  debug messages of the debug category are enabled.
+ *
+ * \param[in]       iterations is the number of times each thread runs an
+ *                  operation.
+ *
+ * \param[in]       maxThreads is the largest number of threads running an
+ *                  operation at once.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ * \return          Another error code if a lock, queue, timer or thread
+ *                  could not be created.
+ *
+ *****************************************************************************/
+fm_status fmDbgAlosBenchmark(fm_int iterations, fm_int maxThreads)
+{
+    fm_alosBench *bench;
+    fm_status     err;
+    fm_bool       lockCreated;
+    fm_bool       rwLockCreated;
+    fm_bool       queuesCreated;
+    fm_bool       bitsCreated;
+    fm_bool       timerCreated;
+    fm_int        numThreads;
+    fm_int        op;
+    fm_int        i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_DEBUG,
+                 "iterations=%d maxThreads=%d\n",
+                 iterations,
+                 maxThreads);
+
+    if ( (iterations < 1) || (maxThreads < 1) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    lockCreated   = FALSE;
+    rwLockCreated = FALSE;
+    queuesCreated = FALSE;
+    bitsCreated   = FALSE;
+    timerCreated  = FALSE;
+
+    bench = fmAlloc( sizeof(fm_alosBench) );
+
+    if (bench == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_ERR_NO_MEM);
+    }
+
+    FM_CLEAR(*bench);
+
+    bench->iterations = iterations;
+
+    fmTreeInit(&bench->tree);
+
+    bench->workers = fmAlloc( maxThreads * sizeof(fm_alosBenchWorker) );
+
+    if (bench->workers == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    FM_MEMSET_S(bench->workers,
+                maxThreads * sizeof(fm_alosBenchWorker),
+                0,
+                maxThreads * sizeof(fm_alosBenchWorker));
+
+    for (i = 0 ; i < maxThreads ; i++)
+    {
+        bench->workers[i].bench = bench;
+        bench->workers[i].event = fmAlloc( sizeof(fm_event) );
+
+        if (bench->workers[i].event == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            goto ABORT;
+        }
+
+        FM_CLEAR(*bench->workers[i].event);
+    }
+
+    err = fmCreateLock("alosBenchLock", &bench->lock);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_DEBUG, err);
+    lockCreated = TRUE;
+
+    err = fmCreateRwLock("alosBenchRwLock", &bench->rwLock);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_DEBUG, err);
+    rwLockCreated = TRUE;
+
+    err = fmEventQueueInitialize(&bench->listQueue,
+                                 maxThreads,
+                                 "alosBenchList");
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_DEBUG, err);
+
+    err = fmEventQueueInitializeV2(&bench->ringQueue,
+                                   maxThreads,
+                                   "alosBenchRing",
+                                   FM_EVENT_QUEUE_FLAG_RING);
+
+    if (err != FM_OK)
+    {
+        fmEventQueueDestroy(&bench->listQueue);
+        goto ABORT;
+    }
+
+    queuesCreated = TRUE;
+
+    err = BenchInitBits(bench);
+    bitsCreated = TRUE;
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_DEBUG, err);
+
+    err = fmCreateTimer("alosBenchTimer", fmApiTimerTask, &bench->timer);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_DEBUG, err);
+    timerCreated = TRUE;
+
+    FM_LOG_PRINT("\nALOS benchmark: iterations=%d maxThreads=%d\n",
+                 iterations,
+                 maxThreads);
+    FM_LOG_PRINT("%-28s %7s %10s %14s\n",
+                 "Operation",
+                 "Threads",
+                 "ns/op",
+                 "ops/s");
+
+    for (op = 0 ; op < ALOS_BENCH_OP_MAX ; op++)
+    {
+        if ( (op == ALOS_BENCH_LOG_DISABLED) &&
+             fmLogIsEnabled(FM_LOG_CAT_DEBUG, FM_LOG_LEVEL_DEBUG) )
+        {
+            FM_LOG_PRINT("%-28s skipped, category enabled\n",
+                         alosBenchOps[op].name);
+            continue;
+        }
+
+        numThreads = 1;
+
+        while (TRUE)
+        {
+            err = BenchRunOp(bench, op, numThreads);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_DEBUG, err);
+
+            if ( !alosBenchOps[op].threaded || (numThreads == maxThreads) )
+            {
+                break;
+            }
+
+            numThreads *= 2;
+
+            if (numThreads > maxThreads)
+            {
+                numThreads = maxThreads;
+            }
+        }
+    }
+
+ABORT:
+    if (timerCreated)
+    {
+        fmDeleteTimer(bench->timer);
+    }
+
+    fmTreeDestroy(&bench->tree, NULL);
+
+    if (bitsCreated)
+    {
+        fmDeleteBitArray(&bench->bits);
+    }
+
+    if (queuesCreated)
+    {
+        fmEventQueueDestroy(&bench->listQueue);
+        fmEventQueueDestroy(&bench->ringQueue);
+    }
+
+    if (rwLockCreated)
+    {
+        fmDeleteRwLock(&bench->rwLock);
+    }
+
+    if (lockCreated)
+    {
+        fmDeleteLock(&bench->lock);
+    }
+
+    if (bench->workers != NULL)
+    {
+        for (i = 0 ; i < maxThreads ; i++)
+        {
+            if (bench->workers[i].event != NULL)
+            {
+                fmFree(bench->workers[i].event);
+            }
+        }
+
+        fmFree(bench->workers);
+    }
+
+    fmFree(bench);
+
+    FM_LOG_EXIT(FM_LOG_CAT_DEBUG, err);
+
+}   /* end fmDbgAlosBenchmark */
@@ -0,0 +1,711 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_debug_api_profile.c
+ * Creation Date:   October 15, 2026
+ * Description:     Sampling profiler of the register accesses of a switch.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* Number of API functions that can be profiled, a power of two */
+#define API_PROF_TABLE_SIZE         1024
+
+/* Number of nested API calls tracked per thread */
+#define API_PROF_MAX_DEPTH          16
+
+/* Number of entries shown by the dump when the caller does not say */
+#define API_PROF_DEFAULT_ENTRIES    30
+
+/* An API call in progress on a thread */
+typedef struct
+{
+    /* Name of the function, as given by __func__ */
+    const char *funcName;
+
+    /* Cycle count at the start of the call */
+    fm_uint64   startCycles;
+
+    /* Lock wait of the thread at the start of the call */
+    fm_uint64   startWait;
+
+} fm_apiProfFrame;
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+fm_bool fmApiProfEnabled = FALSE;
+
+__thread fm_int fmApiProfDepth = 0;
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Calls in progress on the calling thread, innermost last */
+static __thread fm_apiProfFrame profStack[API_PROF_MAX_DEPTH];
+
+/* Cycles the calling thread has spent capturing switch locks within
+ * profiled calls */
+static __thread fm_uint64 profLockWait = 0;
+
+/* Profile of each API function, indexed by a hash of the address of its
+ * name. The profile is local to the process, since the name pointers are. */
+static fm_apiProfileEntry profTable[API_PROF_TABLE_SIZE];
+
+/* Number of calls not recorded because the table was full */
+static fm_uint64 profDropped = 0;
+
+
+/*****************************************************************************
+ * Local function prototypes.
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** GetBucket
+ * \ingroup intDiagMisc
+ *
+ * \desc            Returns the log2 histogram bucket of a time.
+ *
+ * \param[in]       time is the time in nanoseconds.
+ *
+ * \return          The bucket index.
+ *
+ *****************************************************************************/
+static inline fm_int GetBucket(fm_uint64 time)
+{
+    fm_int bucket;
+
+    if (time == 0)
+    {
+        return 0;
+    }
+
+    bucket = 64 - __builtin_clzll(time);
+
+    if (bucket >= FM_API_PROF_HIST_BUCKETS)
+    {
+        bucket = FM_API_PROF_HIST_BUCKETS - 1;
+    }
+
+    return bucket;
+
+}   /* end GetBucket */
+
+
+
+
+/*****************************************************************************/
+/** UpdateMax
+ * \ingroup intDiagMisc
+ *
+ * \desc            Atomically raises a maximum to a new value.
+ *
+ * \param[in,out]   max points to the maximum.
+ *
+ * \param[in]       value is the new sample.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void UpdateMax(fm_uint64 *max, fm_uint64 value)
+{
+    fm_uint64 cur;
+
+    cur = FM_ATOMIC_LOAD_RELAXED(max);
+
+    while (value > cur)
+    {
+        if ( FM_ATOMIC_CAS(max, &cur, value) )
+        {
+            break;
+        }
+    }
+
+}   /* end UpdateMax */
+
+
+
+
+/*****************************************************************************/
+/** FindEntry
+ * \ingroup intDiagMisc
+ *
+ * \desc            Finds the profile of an API function, claiming a free
+ *                  slot of the table on its first call.
+ *
+ * \param[in]       funcName is the name of the function.
+ *
+ * \return          The profile, or NULL if the table is full.
+ *
+ *****************************************************************************/
+static fm_apiProfileEntry *FindEntry(const char *funcName)
+{
+    const char *name;
+    fm_uint     slot;
+    fm_int      i;
+
+    slot = (fm_uint) ( ( ( (fm_uintptr) funcName ) >> 3 ) *
+                       FM_LITERAL_U64(0x9E3779B97F4A7C15) >> 32 );
+
+    for (i = 0 ; i < API_PROF_TABLE_SIZE ; i++)
+    {
+        slot &= API_PROF_TABLE_SIZE - 1;
+        name  = FM_ATOMIC_LOAD(&profTable[slot].name);
+
+        if (name == NULL)
+        {
+            if ( FM_ATOMIC_CAS(&profTable[slot].name, &name, funcName) )
+            {
+                return &profTable[slot];
+            }
+        }
+
+        if (name == funcName)
+        {
+            return &profTable[slot];
+        }
+
+        slot++;
+    }
+
+    return NULL;
+
+}   /* end FindEntry */
+
+
+
+
+/*****************************************************************************/
+/** CompareEntries
+ * \ingroup intDiagMisc
+ *
+ * \desc            qsort comparison function ranking profiles by total
+ *                  time, longest first.
+ *
+ * \param[in]       a points to the first profile.
+ *
+ * \param[in]       b points to the second profile.
+ *
+ * \return          Negative if a ranks first, positive if b does.
+ *
+ *****************************************************************************/
+static int CompareEntries(const void *a, const void *b)
+{
+    const fm_apiProfileEntry *entryA = a;
+    const fm_apiProfileEntry *entryB = b;
+
+    if (entryA->totalTime != entryB->totalTime)
+    {
+        return (entryA->totalTime > entryB->totalTime) ? -1 : 1;
+    }
+
+    return strcmp(entryA->name, entryB->name);
+
+}   /* end CompareEntries */
+
+
+
+
+/*****************************************************************************/
+/** GetPercentile
+ * \ingroup intDiagMisc
+ *
+ * \desc            Estimates a percentile of a histogram as the upper bound
+ *                  of the bucket it falls in.
+ *
+ * \param[in]       hist is the histogram.
+ *
+ * \param[in]       count is the number of samples in hist.
+ *
+ * \param[in]       percent is the percentile, from 1 to 100.
+ *
+ * \return          The percentile in nanoseconds.
+ *
+ *****************************************************************************/
+static fm_uint64 GetPercentile(const fm_uint64 *hist,
+                               fm_uint64        count,
+                               fm_uint          percent)
+{
+    fm_uint64 target;
+    fm_uint64 sum;
+    fm_int    i;
+
+    target = (count * percent + 99) / 100;
+    sum    = 0;
+
+    for (i = 0 ; i < FM_API_PROF_HIST_BUCKETS ; i++)
+    {
+        sum += hist[i];
+
+        if (sum >= target)
+        {
+            break;
+        }
+    }
+
+    if (i == 0)
+    {
+        return 0;
+    }
+
+    if (i >= FM_API_PROF_HIST_BUCKETS - 1)
+    {
+        i = FM_API_PROF_HIST_BUCKETS - 1;
+    }
+
+    return FM_LITERAL_U64(1) << i;
+
+}   /* end GetPercentile */
+
+
+
+
+/*****************************************************************************/
+/** SnapshotEntries
+ * \ingroup intDiagMisc
+ *
+ * \desc            Copies the profiles of the functions called since
+ *                  profiling was enabled or last reset.
+ *
+ * \param[in]       maxEntries is the size of entries.
+ *
+ * \param[out]      entries points to a caller-allocated array receiving
+ *                  the profiles.
+ *
+ * \param[out]      numEntries receives the number of profiles copied.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_BUFFER_FULL if more than maxEntries functions
+ *                  were called.
+ *
+ *****************************************************************************/
+static fm_status SnapshotEntries(fm_int              maxEntries,
+                                 fm_apiProfileEntry *entries,
+                                 fm_int *            numEntries)
+{
+    fm_int i;
+
+    *numEntries = 0;
+
+    for (i = 0 ; i < API_PROF_TABLE_SIZE ; i++)
+    {
+        if ( (FM_ATOMIC_LOAD(&profTable[i].name) == NULL) ||
+             (FM_ATOMIC_LOAD_RELAXED(&profTable[i].calls) == 0) )
+        {
+            continue;
+        }
+
+        if (*numEntries >= maxEntries)
+        {
+            return FM_ERR_BUFFER_FULL;
+        }
+
+        entries[(*numEntries)++] = profTable[i];
+    }
+
+    return FM_OK;
+
+}   /* end SnapshotEntries */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fmDbgApiProfEnter
+ * \ingroup intDiagMisc
+ *
+ * \desc            Opens a profiled call of an API function on the calling
+ *                  thread. Invoked through FM_LOG_ENTRY_API.
+ *
+ * \param[in]       funcName is the name of the function.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmDbgApiProfEnter(const char *funcName)
+{
+    fm_apiProfFrame *frame;
+
+    /* A function that returns without FM_LOG_EXIT_API leaves its frame
+     * behind. Such frames are normally dropped when an enclosing call
+     * exits; should they fill the stack, start over. */
+    if (fmApiProfDepth >= API_PROF_MAX_DEPTH)
+    {
+        fmApiProfDepth = 0;
+    }
+
+    frame = &profStack[fmApiProfDepth++];
+
+    frame->funcName    = funcName;
+    frame->startWait   = profLockWait;
+    frame->startCycles = FM_GET_CYCLES();
+
+}   /* end fmDbgApiProfEnter */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgApiProfExit
+ * \ingroup intDiagMisc
+ *
+ * \desc            Closes a profiled call of an API function on the calling
+ *                  thread and records its duration and lock wait. Invoked
+ *                  through FM_LOG_EXIT_API.
+ *
+ * \param[in]       funcName is the name of the function.
+ *
+ * \param[in]       err is the status returned by the function.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmDbgApiProfExit(const char *funcName, fm_status err)
+{
+    fm_apiProfileEntry *entry;
+    fm_apiProfFrame *   frame;
+    fm_uint64           now;
+    fm_uint64           time;
+    fm_uint64           wait;
+    fm_int              i;
+
+    now = FM_GET_CYCLES();
+
+    /* Exits without a matching entry, as from functions that log their
+     * entry with FM_LOG_ENTRY, are ignored. */
+    for (i = fmApiProfDepth - 1 ; i >= 0 ; i--)
+    {
+        if (profStack[i].funcName == funcName)
+        {
+            break;
+        }
+    }
+
+    if (i < 0)
+    {
+        return;
+    }
+
+    frame          = &profStack[i];
+    fmApiProfDepth = i;
+
+    if (!fmApiProfEnabled)
+    {
+        return;
+    }
+
+    entry = FindEntry(funcName);
+
+    if (entry == NULL)
+    {
+        FM_ATOMIC_ADD_RELAXED(&profDropped, 1);
+        return;
+    }
+
+    time = (now > frame->startCycles) ?
+           fmCyclesToNsec(now - frame->startCycles) : 0;
+    wait = fmCyclesToNsec(profLockWait - frame->startWait);
+
+    FM_ATOMIC_ADD_RELAXED(&entry->calls, 1);
+
+    if (err != FM_OK)
+    {
+        FM_ATOMIC_ADD_RELAXED(&entry->errors, 1);
+    }
+
+    FM_ATOMIC_ADD_RELAXED(&entry->totalTime, time);
+    FM_ATOMIC_ADD_RELAXED(&entry->totalWait, wait);
+    FM_ATOMIC_ADD_RELAXED(&entry->timeHist[GetBucket(time)], 1);
+    FM_ATOMIC_ADD_RELAXED(&entry->waitHist[GetBucket(wait)], 1);
+    UpdateMax(&entry->maxTime, time);
+    UpdateMax(&entry->maxWait, wait);
+
+}   /* end fmDbgApiProfExit */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgApiProfCaptureLock
+ * \ingroup intDiagMisc
+ *
+ * \desc            Captures a switch lock on behalf of a profiled API
+ *                  call, charging the time it takes to the call.
+ *
+ * \param[in]       lck is the switch lock.
+ *
+ * \param[in]       write is TRUE to capture the lock for writing, FALSE
+ *                  for reading.
+ *
+ * \return          The status of the capture.
+ *
+ *****************************************************************************/
+fm_status fmDbgApiProfCaptureLock(fm_rwLock *lck, fm_bool write)
+{
+    fm_status err;
+    fm_uint64 start;
+
+    start = FM_GET_CYCLES();
+
+    if (write)
+    {
+        err = fmCaptureWriteLock(lck, FM_WAIT_FOREVER);
+    }
+    else
+    {
+        err = fmCaptureReadLock(lck, FM_WAIT_FOREVER);
+    }
+
+    profLockWait += FM_GET_CYCLES() - start;
+
+    return err;
+
+}   /* end fmDbgApiProfCaptureLock */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgEnableApiProfile
+ * \ingroup diagMisc
+ *
+ * \desc            Turns API call profiling on or off for the calling
+ *                  process. While it is on, every API function bracketed
+ *                  by FM_LOG_ENTRY_API and FM_LOG_EXIT_API records its
+ *                  number of calls and errors, and log2 histograms of its
+ *                  call duration and of the part of it spent waiting for
+ *                  the switch lock.
+ *
+ * \note            Profiling is only available if the SDK was built with
+ *                  FM_API_PROFILING, which is the default. While it is
+ *                  off, each API call carries a single test of a flag.
+ *
+ * \param[in]       enable is TRUE to turn profiling on, FALSE to turn it
+ *                  off. The collected profile is kept in both cases.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if profiling was not compiled in.
+ *
+ *****************************************************************************/
+fm_status fmDbgEnableApiProfile(fm_bool enable)
+{
+
+#if FM_API_PROFILING
+    FM_ATOMIC_STORE(&fmApiProfEnabled, enable);
+
+    return FM_OK;
+#else
+    FM_NOT_USED(enable);
+
+    return FM_ERR_UNSUPPORTED;
+#endif
+
+}   /* end fmDbgEnableApiProfile */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgDumpApiProfile
+ * \ingroup diagMisc
+ *
+ * \desc            Dumps the profile of the API functions called since
+ *                  profiling was enabled or last reset, ranked by total
+ *                  time spent in each. Percentiles are the upper bounds of
+ *                  the histogram buckets they fall in.
+ *
+ * \param[in]       maxEntries is the number of functions to show, or zero
+ *                  or less for the default.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmDbgDumpApiProfile(fm_int maxEntries)
+{
+    fm_apiProfileEntry *entries;
+    fm_apiProfileEntry *entry;
+    fm_int              numEntries;
+    fm_int              i;
+
+    if (maxEntries <= 0)
+    {
+        maxEntries = API_PROF_DEFAULT_ENTRIES;
+    }
+
+    entries = fmAlloc( API_PROF_TABLE_SIZE * sizeof(fm_apiProfileEntry) );
+
+    if (entries == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    SnapshotEntries(API_PROF_TABLE_SIZE, entries, &numEntries);
+
+    qsort(entries, numEntries, sizeof(fm_apiProfileEntry), CompareEntries);
+
+    FM_LOG_PRINT("\nAPI profile (%s, %d functions, %" FM_FORMAT_64 "u "
+                 "calls dropped), times in usec:\n\n",
+                 fmApiProfEnabled ? "enabled" : "disabled",
+                 numEntries,
+                 profDropped);
+    FM_LOG_PRINT("%-36s %10s %8s %10s %9s %9s %9s %9s %9s\n",
+                 "Function",
+                 "Calls",
+                 "Errors",
+                 "Total",
+                 "Avg",
+                 "P99",
+                 "Max",
+                 "AvgWait",
+                 "MaxWait");
+
+    for (i = 0 ; i < numEntries && i < maxEntries ; i++)
+    {
+        entry = &entries[i];
+
+        FM_LOG_PRINT("%-36.36s %10" FM_FORMAT_64 "u %8" FM_FORMAT_64 "u "
+                     "%10" FM_FORMAT_64 "u %9.1f %9.1f %9.1f %9.1f %9.1f\n",
+                     entry->name,
+                     entry->calls,
+                     entry->errors,
+                     entry->totalTime / 1000,
+                     (double) entry->totalTime / entry->calls / 1000.0,
+                     GetPercentile(entry->timeHist, entry->calls, 99) / 1000.0,
+                     entry->maxTime / 1000.0,
+                     (double) entry->totalWait / entry->calls / 1000.0,
+                     entry->maxWait / 1000.0);
+    }
+
+    FM_LOG_PRINT("\n");
+
+    fmFree(entries);
+
+    return FM_OK;
+
+}   /* end fmDbgDumpApiProfile */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgResetApiProfile
+ * \ingroup diagMisc
+ *
+ * \desc            Clears the profile of every API function. Calls
+ *                  recorded concurrently with the reset may be partially
+ *                  lost.
+ *
+ * \param           None.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmDbgResetApiProfile(void)
+{
+    fm_apiProfileEntry *entry;
+    fm_int              i;
+
+    for (i = 0 ; i < API_PROF_TABLE_SIZE ; i++)
+    {
+        entry = &profTable[i];
+
+        /* Keep the name, so the slot stays with its function. */
+        entry->calls     = 0;
+        entry->errors    = 0;
+        entry->totalTime = 0;
+        entry->maxTime   = 0;
+        entry->totalWait = 0;
+        entry->maxWait   = 0;
+        FM_CLEAR(entry->timeHist);
+        FM_CLEAR(entry->waitHist);
+    }
+
+    profDropped = 0;
+
+    return FM_OK;
+
+}   /* end fmDbgResetApiProfile */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgGetApiProfile
+ * \ingroup diagMisc
+ *
+ * \desc            Retrieves the profile of the API functions called since
+ *                  profiling was enabled or last reset, in no particular
+ *                  order.
+ *
+ * \param[in]       maxEntries is the size of entries.
+ *
+ * \param[out]      entries points to a caller-allocated array of
+ *                  maxEntries elements where this function should place
+ *                  the profile of each function.
+ *
+ * \param[out]      numEntries points to caller-allocated storage where this
+ *                  function should place the number of profiles returned.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_BUFFER_FULL if more than maxEntries functions
+ *                  were called. The first maxEntries are returned.
+ *
+ *****************************************************************************/
+fm_status fmDbgGetApiProfile(fm_int              maxEntries,
+                             fm_apiProfileEntry *entries,
+                             fm_int *            numEntries)
+{
+
+    if ( (maxEntries < 0) || (entries == NULL) || (numEntries == NULL) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    return SnapshotEntries(maxEntries, entries, numEntries);
+
+}   /* end fmDbgGetApiProfile */
@@ -0,0 +1,682 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_debug_boot_phase.c
+ * Creation Date:   October 15, 2026
+ * Description:     Timeline of the phases of a switch bring-up.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* Number of phases recorded per bring-up. Later phases are dropped. */
+#define BOOT_PHASE_MAX_PHASES           512
+
+/* Deepest nesting of open phases */
+#define BOOT_PHASE_MAX_DEPTH            16
+
+/* One phase of the bring-up */
+typedef struct
+{
+    /* Phase name, a string literal of the caller */
+    fm_text      name;
+
+    /* Port or other instance number, -1 if none */
+    fm_int       instance;
+
+    /* Index of the enclosing phase, -1 for a top-level phase */
+    fm_int       parent;
+
+    fm_int       depth;
+
+    fm_timestamp start;
+    fm_timestamp end;
+
+    /* Shared memory footprint at the start and the end of the phase */
+    fm_uint64    memStart;
+    fm_uint64    memEnd;
+
+    /* FALSE until fmDbgBootPhaseEnd is called on the phase */
+    fm_bool      ended;
+
+} fm_bootPhaseRecord;
+
+
+/* Bring-up timeline of a switch. It is written by the thread bringing the
+ * switch up, which holds the switch lock while doing so, and read under
+ * the switch lock afterwards. */
+typedef struct
+{
+    /* TRUE between fmDbgBootPhaseStart and fmDbgBootPhaseStop */
+    fm_bool            recording;
+
+    /* Time of fmDbgBootPhaseStart, the origin of the phase start times */
+    fm_timestamp       origin;
+
+    fm_bootPhaseRecord phases[BOOT_PHASE_MAX_PHASES];
+    fm_int             numPhases;
+
+    /* Number of phases dropped because the table was full */
+    fm_int             numDropped;
+
+    /* Indexes of the phases currently open, innermost last */
+    fm_int             open[BOOT_PHASE_MAX_DEPTH];
+    fm_int             numOpen;
+
+} fm_bootTimeline;
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+static fm_bootTimeline *bootTimelines[FM_MAX_NUM_SWITCHES];
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** GetTimeline
+ * \ingroup intDiag
+ *
+ * \desc            Returns the bring-up timeline of a switch.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          Pointer to the timeline, or NULL if sw is out of range or
+ *                  nothing was ever recorded for it.
+ *
+ *****************************************************************************/
+static fm_bootTimeline *GetTimeline(fm_int sw)
+{
+
+    if (sw < 0 || sw >= FM_MAX_NUM_SWITCHES)
+    {
+        return NULL;
+    }
+
+    return bootTimelines[sw];
+
+}   /* end GetTimeline */
+
+
+
+
+/*****************************************************************************/
+/** ElapsedUsec
+ * \ingroup intDiag
+ *
+ * \desc            Computes the time between two timestamps.
+ *
+ * \param[in]       from is the earlier timestamp.
+ *
+ * \param[in]       to is the later timestamp.
+ *
+ * \return          The elapsed time in microseconds.
+ *
+ *****************************************************************************/
+static fm_uint64 ElapsedUsec(fm_timestamp *from, fm_timestamp *to)
+{
+    fm_timestamp diff;
+
+    fmSubTimestamps(to, from, &diff);
+
+    return (diff.sec * 1000000) + diff.usec;
+
+}   /* end ElapsedUsec */
+
+
+
+
+/*****************************************************************************/
+/** PhaseDuration
+ * \ingroup intDiag
+ *
+ * \desc            Returns the duration of a phase.
+ *
+ * \param[in]       phase points to the phase.
+ *
+ * \return          The duration in microseconds, 0 if the phase did not end.
+ *
+ *****************************************************************************/
+static fm_uint64 PhaseDuration(fm_bootPhaseRecord *phase)
+{
+
+    if (!phase->ended)
+    {
+        return 0;
+    }
+
+    return ElapsedUsec(&phase->start, &phase->end);
+
+}   /* end PhaseDuration */
+
+
+
+
+/*****************************************************************************/
+/** PhaseSelfTime
+ * \ingroup intDiag
+ *
+ * \desc            Returns the time spent in a phase outside of the phases
+ *                  nested in it.
+ *
+ * \param[in]       timeline points to the timeline.
+ *
+ * \param[in]       index is the index of the phase.
+ *
+ * \return          The self time in microseconds.
+ *
+ *****************************************************************************/
+static fm_uint64 PhaseSelfTime(fm_bootTimeline *timeline, fm_int index)
+{
+    fm_uint64 self;
+    fm_uint64 child;
+    fm_int    i;
+
+    self = PhaseDuration(&timeline->phases[index]);
+
+    /* Children always start after their parent */
+    for (i = index + 1 ; i < timeline->numPhases ; i++)
+    {
+        if (timeline->phases[i].parent == index)
+        {
+            child = PhaseDuration(&timeline->phases[i]);
+            self  = (child < self) ? (self - child) : 0;
+        }
+    }
+
+    return self;
+
+}   /* end PhaseSelfTime */
+
+
+
+
+/*****************************************************************************/
+/** PhaseMemory
+ * \ingroup intDiag
+ *
+ * \desc            Returns the growth of the shared memory footprint during
+ *                  a phase, including the phases nested in it.
+ *
+ * \param[in]       phase points to the phase.
+ *
+ * \return          The growth in bytes, 0 if the phase did not end.
+ *
+ *****************************************************************************/
+static fm_uint64 PhaseMemory(fm_bootPhaseRecord *phase)
+{
+
+    if (!phase->ended || phase->memEnd < phase->memStart)
+    {
+        return 0;
+    }
+
+    return phase->memEnd - phase->memStart;
+
+}   /* end PhaseMemory */
+
+
+
+
+/*****************************************************************************/
+/** WriteFoldedStacks
+ * \ingroup intDiag
+ *
+ * \desc            Writes the timeline in the folded stack format read by
+ *                  flame graph tools: one line per phase, holding the names
+ *                  of its enclosing phases and its own separated by ';',
+ *                  followed by its self time in microseconds.
+ *
+ * \param[in]       timeline points to the timeline.
+ *
+ * \param[in]       fp is the file to write to.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void WriteFoldedStacks(fm_bootTimeline *timeline, FILE *fp)
+{
+    fm_bootPhaseRecord *phase;
+    fm_int              stack[BOOT_PHASE_MAX_DEPTH];
+    fm_int              depth;
+    fm_int              i;
+    fm_int              j;
+
+    for (i = 0 ; i < timeline->numPhases ; i++)
+    {
+        depth = 0;
+
+        for (j = i ; j >= 0 && depth < BOOT_PHASE_MAX_DEPTH ; j = timeline->phases[j].parent)
+        {
+            stack[depth++] = j;
+        }
+
+        while (depth > 0)
+        {
+            phase = &timeline->phases[stack[--depth]];
+
+            fprintf(fp, "%s%s", phase->name, (depth > 0) ? ";" : " ");
+        }
+
+        fprintf(fp, "%llu\n", (unsigned long long) PhaseSelfTime(timeline, i));
+    }
+
+}   /* end WriteFoldedStacks */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** fmDbgBootPhaseStart
+ * \ingroup intDiag
+ *
+ * \desc            Starts recording the bring-up timeline of a switch,
+ *                  unless it is already being recorded. Any earlier
+ *                  timeline of the switch is discarded.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmDbgBootPhaseStart(fm_int sw)
+{
+    fm_bootTimeline *timeline;
+
+    if (sw < 0 || sw >= FM_MAX_NUM_SWITCHES)
+    {
+        return;
+    }
+
+    timeline = bootTimelines[sw];
+
+    if (timeline == NULL)
+    {
+        timeline = fmAlloc( sizeof(fm_bootTimeline) );
+
+        if (timeline == NULL)
+        {
+            return;
+        }
+
+        FM_CLEAR(*timeline);
+        bootTimelines[sw] = timeline;
+    }
+    else if (timeline->recording)
+    {
+        return;
+    }
+
+    timeline->numPhases  = 0;
+    timeline->numDropped = 0;
+    timeline->numOpen    = 0;
+    timeline->recording  = TRUE;
+
+    fmGetTime(&timeline->origin);
+
+}   /* end fmDbgBootPhaseStart */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgBootPhaseBegin
+ * \ingroup intDiag
+ *
+ * \desc            Records the start of a bring-up phase. The phase is
+ *                  nested in the innermost phase still open. Does nothing
+ *                  when the timeline of the switch is not being recorded.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       name is the name of the phase. It must remain valid for
+ *                  the life of the process.
+ *
+ * \param[in]       instance is the port or other instance the phase
+ *                  applies to, or -1.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmDbgBootPhaseBegin(fm_int sw, fm_text name, fm_int instance)
+{
+    fm_bootTimeline *   timeline;
+    fm_bootPhaseRecord *phase;
+
+    timeline = GetTimeline(sw);
+
+    if (timeline == NULL || !timeline->recording)
+    {
+        return;
+    }
+
+    if ( timeline->numPhases >= BOOT_PHASE_MAX_PHASES ||
+         timeline->numOpen >= BOOT_PHASE_MAX_DEPTH )
+    {
+        timeline->numDropped++;
+        return;
+    }
+
+    phase = &timeline->phases[timeline->numPhases];
+
+    phase->name     = name;
+    phase->instance = instance;
+    phase->depth    = timeline->numOpen;
+    phase->parent   = (timeline->numOpen > 0)
+                      ? timeline->open[timeline->numOpen - 1]
+                      : -1;
+    phase->ended    = FALSE;
+
+    fmGetSharedMemoryFootprint(&phase->memStart);
+    fmGetTime(&phase->start);
+
+    timeline->open[timeline->numOpen++] = timeline->numPhases++;
+
+}   /* end fmDbgBootPhaseBegin */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgBootPhaseEnd
+ * \ingroup intDiag
+ *
+ * \desc            Records the end of the innermost open bring-up phase of
+ *                  the given name. Phases opened inside it and not ended,
+ *                  because of an early return on error, are left without
+ *                  a duration. Does nothing when the timeline of the switch
+ *                  is not being recorded.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       name is the name of the phase.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmDbgBootPhaseEnd(fm_int sw, fm_text name)
+{
+    fm_bootTimeline *   timeline;
+    fm_bootPhaseRecord *phase;
+    fm_int              i;
+
+    timeline = GetTimeline(sw);
+
+    if (timeline == NULL || !timeline->recording)
+    {
+        return;
+    }
+
+    for (i = timeline->numOpen - 1 ; i >= 0 ; i--)
+    {
+        phase = &timeline->phases[timeline->open[i]];
+
+        if (strcmp(phase->name, name) == 0)
+        {
+            fmGetTime(&phase->end);
+            fmGetSharedMemoryFootprint(&phase->memEnd);
+            phase->ended      = TRUE;
+            timeline->numOpen = i;
+            return;
+        }
+    }
+
+}   /* end fmDbgBootPhaseEnd */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgBootPhaseStop
+ * \ingroup intDiag
+ *
+ * \desc            Stops recording the bring-up timeline of a switch and,
+ *                  if the api.debug.bootProfileFile property is set, writes
+ *                  the timeline to that file. The timeline is kept until
+ *                  the next call to fmDbgBootPhaseStart.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmDbgBootPhaseStop(fm_int sw)
+{
+    fm_bootTimeline *timeline;
+    fm_text          fileName;
+    fm_status        err;
+
+    timeline = GetTimeline(sw);
+
+    if (timeline == NULL || !timeline->recording)
+    {
+        return;
+    }
+
+    timeline->recording = FALSE;
+
+    fileName = GET_PROPERTY()->bootProfileFile;
+
+    if (fileName[0] != '\0')
+    {
+        err = fmDbgDumpBootPhases(sw, fileName);
+
+        if (err != FM_OK)
+        {
+            FM_LOG_WARNING(FM_LOG_CAT_DEBUG,
+                           "Unable to write boot profile of switch %d to %s: %s\n",
+                           sw,
+                           fileName,
+                           fmErrorMsg(err));
+        }
+    }
+
+}   /* end fmDbgBootPhaseStop */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgGetBootPhase
+ * \ingroup intDiag
+ *
+ * \desc            Retrieves one phase of the bring-up timeline of a switch.
+ *                  Used to implement the ''FM_SWITCH_BOOT_PHASE'' switch
+ *                  attribute.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in,out]   phase points to the caller-allocated phase, whose index
+ *                  field selects the phase to retrieve.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if phase is NULL.
+ * \return          FM_ERR_NO_MORE if index is past the last phase.
+ *
+ *****************************************************************************/
+fm_status fmDbgGetBootPhase(fm_int sw, fm_bootPhase *phase)
+{
+    fm_bootTimeline *   timeline;
+    fm_bootPhaseRecord *record;
+
+    if (phase == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    timeline = GetTimeline(sw);
+
+    if ( timeline == NULL ||
+         phase->index < 0 ||
+         phase->index >= timeline->numPhases )
+    {
+        return FM_ERR_NO_MORE;
+    }
+
+    record = &timeline->phases[phase->index];
+
+    FM_SNPRINTF_S(phase->name, sizeof(phase->name), "%s", record->name);
+    phase->instance  = record->instance;
+    phase->depth     = record->depth;
+    phase->startTime = ElapsedUsec(&timeline->origin, &record->start);
+    phase->duration  = PhaseDuration(record);
+    phase->memory    = PhaseMemory(record);
+
+    return FM_OK;
+
+}   /* end fmDbgGetBootPhase */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgDumpBootPhases
+ * \ingroup diagMisc
+ *
+ * \chips           FM10000
+ *
+ * \desc            Displays the timeline of the most recent bring-up of a
+ *                  switch, from the insertion of the switch to the end of
+ *                  its post-boot processing, or writes it to a file in the
+ *                  folded stack format read by flame graph tools, where the
+ *                  value of each line is the time spent in the phase itself
+ *                  in microseconds. The displayed timeline also gives the
+ *                  growth of the shared memory footprint during each phase,
+ *                  which tells how much of the segment each subsystem
+ *                  takes.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       fileName is the file to write, or NULL to display the
+ *                  timeline.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_STATE if no timeline was recorded.
+ * \return          FM_FAIL if the file could not be written.
+ *
+ *****************************************************************************/
+fm_status fmDbgDumpBootPhases(fm_int sw, fm_text fileName)
+{
+    fm_bootTimeline *   timeline;
+    fm_bootPhaseRecord *phase;
+    FILE *              fp;
+    fm_char             label[FM_BOOT_PHASE_NAME_LENGTH + 16];
+    fm_int              i;
+
+    if (sw < 0 || sw >= FM_MAX_NUM_SWITCHES)
+    {
+        return FM_ERR_INVALID_SWITCH;
+    }
+
+    timeline = bootTimelines[sw];
+
+    if (timeline == NULL)
+    {
+        return FM_ERR_INVALID_STATE;
+    }
+
+    if (fileName != NULL)
+    {
+        fp = fopen(fileName, "w");
+
+        if (fp == NULL)
+        {
+            return FM_FAIL;
+        }
+
+        WriteFoldedStacks(timeline, fp);
+
+        return (fclose(fp) == 0) ? FM_OK : FM_FAIL;
+    }
+
+    FM_LOG_PRINT("Boot phases of switch %d%s\n",
+                 sw,
+                 timeline->recording ? " (in progress)" : "");
+    FM_LOG_PRINT("%-40s %12s %12s %12s %12s\n",
+                 "Phase", "Start (us)", "Total (us)", "Self (us)", "Memory (KB)");
+
+    for (i = 0 ; i < timeline->numPhases ; i++)
+    {
+        phase = &timeline->phases[i];
+
+        if (phase->instance >= 0)
+        {
+            FM_SNPRINTF_S(label, sizeof(label), "%s[%d]",
+                          phase->name, phase->instance);
+        }
+        else
+        {
+            FM_SNPRINTF_S(label, sizeof(label), "%s", phase->name);
+        }
+
+        FM_LOG_PRINT("%*s%-*s %12llu ",
+                     phase->depth * 2, "",
+                     40 - (phase->depth * 2), label,
+                     (unsigned long long)
+                         ElapsedUsec(&timeline->origin, &phase->start));
+
+        if (phase->ended)
+        {
+            FM_LOG_PRINT("%12llu %12llu %12llu\n",
+                         (unsigned long long) PhaseDuration(phase),
+                         (unsigned long long) PhaseSelfTime(timeline, i),
+                         (unsigned long long) (PhaseMemory(phase) / 1024));
+        }
+        else
+        {
+            FM_LOG_PRINT("%12s %12s %12s\n", "-", "-", "-");
+        }
+    }
+
+    if (timeline->numDropped > 0)
+    {
+        FM_LOG_PRINT("%d phases not recorded\n", timeline->numDropped);
+    }
+
+    return FM_OK;
+
+}   /* end fmDbgDumpBootPhases */
@@ -37,6 +37,39 @@
  * Macros, Constants & Types
  *****************************************************************************/
 
+/* Eye metrics file identification, see fmDbgTakeEyeMetrics */
+#define EYE_METRICS_FILE_MAGIC      0x46455945  /* "FEYE" */
+#define EYE_METRICS_FILE_VERSION    1
+
+typedef struct
+{
+    fm_uint32 magic;
+    fm_uint32 version;
+    fm_int32  sw;
+    fm_int32  recordSize;
+
+} eyeMetricsFileHeader;
+
+/* One lane in the eye metrics file */
+typedef struct
+{
+    fm_uint16 serdes;
+    fm_uint16 heightmV;
+    fm_int32  port;
+    fm_int32  eyeScore;
+    fm_int32  width;
+    fm_int32  status;
+
+} eyeMetricsFileRecord;
+
+/* State shared with RecordEyeMetric during a capture */
+typedef struct
+{
+    FILE   *fp;
+    fm_bool writeFailed;
+
+} eyeMetricsCapture;
+
 
 /*****************************************************************************
  * Global Variables
@@ -58,6 +91,10 @@ static fm_status DeleteEyeDiagram( fm_int               eyeDiagramId  );
 static fm_status GetEyeDiagramSample( fm_int               eyeDiagramId,
                                       fm_int               sampleId,
                                       fm_eyeDiagramSample *sample );
+static fm_bool RecordEyeMetric( fm_int              sw,
+                                fm_int              numLanes,
+                                const fm_eyeMetric *metric,
+                                fm_voidptr          callbackInfo );
 
 
 /*****************************************************************************
@@ -211,6 +248,74 @@ ABORT:
 }   /* end GetEyeDiagramSample */
 
 
+
+
+/*****************************************************************************/
+/** RecordEyeMetric
+ * \ingroup intDiagEye
+ *
+ * \chips           FM10000
+ *
+ * \desc            Eye metrics callback: updates the capture progress and
+ *                  appends the lane to the output file, or prints it when
+ *                  no file was requested.
+ *
+ * \param[in]       sw is the switch being measured.
+ *
+ * \param[in]       numLanes is the total number of lanes in the capture.
+ *
+ * \param[in]       metric points to the metrics of the lane.
+ *
+ * \param[in]       callbackInfo points to the eyeMetricsCapture state.
+ *
+ * \return          FALSE to stop the capture if the file write failed.
+ *
+ *****************************************************************************/
+static fm_bool RecordEyeMetric( fm_int              sw,
+                                fm_int              numLanes,
+                                const fm_eyeMetric *metric,
+                                fm_voidptr          callbackInfo )
+{
+    eyeMetricsCapture   *capture;
+    eyeMetricsFileRecord record;
+
+    FM_NOT_USED(sw);
+
+    capture = (eyeMetricsCapture *) callbackInfo;
+
+    fmRootDebug->fmDbgEyeMetrics.numLanes = numLanes;
+    fmRootDebug->fmDbgEyeMetrics.lanesDone++;
+
+    if ( capture->fp == NULL )
+    {
+        FM_LOG_PRINT("%6d  %4d  %5d  %6d mV  %5d  %s\n",
+                     metric->serdes,
+                     metric->port,
+                     metric->eyeScore,
+                     metric->heightmV,
+                     metric->width,
+                     fmErrorMsg(metric->status) );
+        return TRUE;
+    }
+
+    record.serdes   = (fm_uint16) metric->serdes;
+    record.heightmV = (fm_uint16) metric->heightmV;
+    record.port     = metric->port;
+    record.eyeScore = metric->eyeScore;
+    record.width    = metric->width;
+    record.status   = metric->status;
+
+    if ( fwrite(&record, sizeof(record), 1, capture->fp) != 1 )
+    {
+        capture->writeFailed = TRUE;
+        return FALSE;
+    }
+
+    return TRUE;
+
+}   /* end RecordEyeMetric */
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -232,6 +337,8 @@ fm_status fmDbgInitEyeDiagrams(void)
 {
     memset( fmRootDebug->fmDbgEyeDiagrams, 0, 
             sizeof(fmRootDebug->fmDbgEyeDiagrams) );
+    memset( &fmRootDebug->fmDbgEyeMetrics, 0,
+            sizeof(fmRootDebug->fmDbgEyeMetrics) );
 
     return FM_OK;
 
@@ -650,3 +757,169 @@ ABORT:
 
 }   /* end fmDbgGetEyeDiagramSampleCount */
 
+
+
+
+/*****************************************************************************/
+/** fmDbgTakeEyeMetrics
+ * \ingroup diagEye
+ *
+ * \chips           FM10000
+ *
+ * \desc            Measures the summary eye metrics (height, and width where
+ *                  the device supports it) of every active SerDes lane of a
+ *                  switch. Several lanes of each sBus ring are measured at
+ *                  once, and each lane is reported as soon as it completes,
+ *                  so no sample grid is kept in memory.
+ *                                                                      \lb\lb
+ *                  The progress of a running capture can be read from
+ *                  another thread with ''fmDbgGetEyeMetricsProgress''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       maxLanesPerRing is the maximum number of lanes measured
+ *                  at once on each sBus ring. Zero selects the
+ *                  chip default.
+ *
+ * \param[in]       fileName is the binary file the metrics are streamed
+ *                  to: a header (magic, version, switch, record size)
+ *                  followed by one fixed-size record per lane, in host byte
+ *                  order. If NULL, the metrics are printed instead.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if the switch ID is invalid.
+ * \return          FM_ERR_INVALID_STATE if a capture is already running.
+ * \return          FM_ERR_UNSUPPORTED if the switch cannot measure eyes.
+ * \return          FM_FAIL if the file could not be written.
+ *
+ *****************************************************************************/
+fm_status fmDbgTakeEyeMetrics( fm_int  sw,
+                               fm_int  maxLanesPerRing,
+                               fm_text fileName )
+{
+    fm_status            err;
+    fm_switch           *switchPtr;
+    eyeMetricsCapture    capture;
+    eyeMetricsFileHeader header;
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+    switchPtr = GET_SWITCH_PTR( sw );
+
+    capture.fp          = NULL;
+    capture.writeFailed = FALSE;
+
+    if ( fmRootDebug->fmDbgEyeMetrics.active )
+    {
+        err = FM_ERR_INVALID_STATE;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+    }
+
+    if ( switchPtr->DbgTakeEyeMetrics == NULL )
+    {
+        err = FM_ERR_UNSUPPORTED;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+    }
+
+    if ( fileName != NULL )
+    {
+        capture.fp = fopen(fileName, "wb");
+
+        if ( capture.fp == NULL )
+        {
+            FM_LOG_PRINT("Unable to create %s\n", fileName);
+            err = FM_FAIL;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        }
+
+        header.magic      = EYE_METRICS_FILE_MAGIC;
+        header.version    = EYE_METRICS_FILE_VERSION;
+        header.sw         = sw;
+        header.recordSize = sizeof(eyeMetricsFileRecord);
+
+        if ( fwrite(&header, sizeof(header), 1, capture.fp) != 1 )
+        {
+            err = FM_FAIL;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+        }
+    }
+    else
+    {
+        FM_LOG_PRINT("SerDes  Port  Score  Height     Width  Status\n");
+    }
+
+    fmRootDebug->fmDbgEyeMetrics.numLanes  = 0;
+    fmRootDebug->fmDbgEyeMetrics.lanesDone = 0;
+    fmRootDebug->fmDbgEyeMetrics.active    = TRUE;
+
+    err = switchPtr->DbgTakeEyeMetrics(sw,
+                                       maxLanesPerRing,
+                                       RecordEyeMetric,
+                                       &capture);
+
+    fmRootDebug->fmDbgEyeMetrics.active = FALSE;
+
+    if ( capture.writeFailed )
+    {
+        err = FM_FAIL;
+    }
+
+ABORT:
+    if ( capture.fp != NULL && fclose(capture.fp) != 0 && err == FM_OK )
+    {
+        err = FM_FAIL;
+    }
+
+    if ( swProtected )
+    {
+        UNPROTECT_SWITCH(sw);
+    }
+
+    return err;
+
+}   /* end fmDbgTakeEyeMetrics */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgGetEyeMetricsProgress
+ * \ingroup diagEye
+ *
+ * \chips           FM10000
+ *
+ * \desc            Reports the progress of the capture started by
+ *                  ''fmDbgTakeEyeMetrics''. It may be called from another
+ *                  thread while the capture runs; after the capture ends
+ *                  it reports the totals of the last capture.
+ *
+ * \param[out]      lanesDone points to caller-allocated storage where this
+ *                  function will return the number of lanes measured so far.
+ *
+ * \param[out]      numLanes points to caller-allocated storage where this
+ *                  function will return the number of lanes in the capture,
+ *                  or 0 if no lane has completed yet.
+ *
+ * \param[out]      active points to caller-allocated storage where this
+ *                  function will return TRUE while a capture is running.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if a pointer argument is NULL.
+ *
+ *****************************************************************************/
+fm_status fmDbgGetEyeMetricsProgress( fm_int  *lanesDone,
+                                      fm_int  *numLanes,
+                                      fm_bool *active )
+{
+
+    if ( lanesDone == NULL || numLanes == NULL || active == NULL )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    *lanesDone = fmRootDebug->fmDbgEyeMetrics.lanesDone;
+    *numLanes  = fmRootDebug->fmDbgEyeMetrics.numLanes;
+    *active    = fmRootDebug->fmDbgEyeMetrics.active;
+
+    return FM_OK;
+
+}   /* end fmDbgGetEyeMetricsProgress */
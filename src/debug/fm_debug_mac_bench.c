@@ -0,0 +1,792 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_debug_mac_bench.c
+ * Creation Date:   October 15, 2026
+ * Description:     MAC learning, flushing and aging scale benchmark.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* First of the locally administered addresses added through the API, and
+ * first of those learned through the TCN FIFO */
+#define MAC_BENCH_API_BASE              FM_LITERAL_U64(0x020000000000)
+#define MAC_BENCH_TCN_BASE              FM_LITERAL_U64(0x020001000000)
+
+/* Longest wait for the maintenance thread to complete a flush */
+#define MAC_BENCH_FLUSH_TIMEOUT_SEC     30
+
+/* Time without progress after which a TCN FIFO burst is given up on */
+#define MAC_BENCH_STALL_NSEC            FM_LITERAL_U64(1000000000)
+
+/* Diagnostic counters sampled around each operation */
+typedef enum
+{
+    MAC_BENCH_CTR_REPORT_LEARN = 0,
+    MAC_BENCH_CTR_REPORT_AGE,
+    MAC_BENCH_CTR_ALLOC_ERR,
+    MAC_BENCH_CTR_SEND_ERR,
+    MAC_BENCH_CTR_THROTTLED,
+    MAC_BENCH_CTR_TCN_LEARNED,
+    MAC_BENCH_CTR_MAX
+
+} fm_macBenchCounter;
+
+
+/* State sampled at the start and at the end of an operation */
+typedef struct
+{
+    /* Wall clock, in nanoseconds */
+    fm_uint64 wallNsec;
+
+    /* CPU time of the MAC maintenance and event handler threads */
+    fm_uint64 maintNsec;
+    fm_uint64 eventNsec;
+
+    /* Values of the counters listed in macBenchCounters */
+    fm_uint64 counters[MAC_BENCH_CTR_MAX];
+
+} fm_macBenchSample;
+
+
+/* Benchmark context */
+typedef struct
+{
+    fm_int               sw;
+    fm_int               port;
+    fm_uint16            vlanID;
+    fm_int               numAddresses;
+
+    /* Addresses added through the API */
+    fm_macAddressEntry * entries;
+
+    /* Thread running MAC table maintenance for the switch */
+    fm_thread *          maintThread;
+
+    /* Signaled by the maintenance thread when a flush has completed */
+    fm_semaphore         flushDone;
+
+} fm_macBench;
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+static const fm_trackingCounterIndex macBenchCounters[MAC_BENCH_CTR_MAX] =
+{
+    FM_CTR_MAC_REPORT_LEARN,
+    FM_CTR_MAC_REPORT_AGE,
+    FM_CTR_MAC_EVENT_ALLOC_ERR,
+    FM_CTR_MAC_EVENT_SEND_ERR,
+    FM_CTR_MAC_LEARN_THROTTLED,
+    FM_CTR_TCN_LEARNED_EVENT,
+};
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** BenchThreadNsec
+ * \ingroup intDiagMisc
+ *
+ * \desc            Returns the CPU time consumed by a thread.
+ *
+ * \param[in]       thread points to the thread.
+ *
+ * \return          The CPU time in nanoseconds, 0 if it is not available.
+ *
+ *****************************************************************************/
+static fm_uint64 BenchThreadNsec(fm_thread *thread)
+{
+    fm_uint64 nsec;
+
+    if (fmGetThreadCpuTime(thread, &nsec) != FM_OK)
+    {
+        return 0;
+    }
+
+    return nsec;
+
+}   /* end BenchThreadNsec */
+
+
+
+
+/*****************************************************************************/
+/** BenchGetCounter
+ * \ingroup intDiagMisc
+ *
+ * \desc            Returns the value of one of the sampled counters.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       counter is the counter to read.
+ *
+ * \return          The counter value, 0 if it cannot be read.
+ *
+ *****************************************************************************/
+static fm_uint64 BenchGetCounter(fm_int sw, fm_macBenchCounter counter)
+{
+    fm_uint64 value;
+
+    if (fmDbgDiagCountGet(sw, macBenchCounters[counter], &value) != FM_OK)
+    {
+        return 0;
+    }
+
+    return value;
+
+}   /* end BenchGetCounter */
+
+
+
+
+/*****************************************************************************/
+/** BenchSample
+ * \ingroup intDiagMisc
+ *
+ * \desc            Samples the clocks and counters.
+ *
+ * \param[in]       bench points to the benchmark context.
+ *
+ * \param[out]      sample points to caller-allocated storage where the
+ *                  sample is written.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchSample(fm_macBench *bench, fm_macBenchSample *sample)
+{
+    fm_int i;
+
+    for (i = 0 ; i < MAC_BENCH_CTR_MAX ; i++)
+    {
+        sample->counters[i] = BenchGetCounter(bench->sw, i);
+    }
+
+    sample->maintNsec = BenchThreadNsec(bench->maintThread);
+    sample->eventNsec = BenchThreadNsec(&fmRootApi->eventThread);
+    sample->wallNsec  = fmGetMonotonicNsec();
+
+}   /* end BenchSample */
+
+
+
+
+/*****************************************************************************/
+/** BenchStart
+ * \ingroup intDiagMisc
+ *
+ * \desc            Starts measuring an operation. The peak depth of the
+ *                  event handler queue is restarted from zero.
+ *
+ * \param[in]       bench points to the benchmark context.
+ *
+ * \param[out]      start points to caller-allocated storage where the
+ *                  starting sample is written.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchStart(fm_macBench *bench, fm_macBenchSample *start)
+{
+    fmRootApi->eventThread.events.maxSize = 0;
+
+    BenchSample(bench, start);
+
+}   /* end BenchStart */
+
+
+
+
+/*****************************************************************************/
+/** BenchReport
+ * \ingroup intDiagMisc
+ *
+ * \desc            Ends measuring an operation and prints its row.
+ *
+ * \param[in]       bench points to the benchmark context.
+ *
+ * \param[in]       name is the name of the operation.
+ *
+ * \param[in]       numOps is the number of addresses handled, before
+ *                  the failure if err is not FM_OK.
+ *
+ * \param[in]       start points to the sample taken by ''BenchStart''.
+ *
+ * \param[in]       err is the status of the operation.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchReport(fm_macBench *      bench,
+                        fm_text            name,
+                        fm_int             numOps,
+                        fm_macBenchSample *start,
+                        fm_status          err)
+{
+    fm_macBenchSample end;
+    fm_uint64         wallNsec;
+    fm_uint64         reported;
+    fm_uint64         dropped;
+    fm_uint64         throttled;
+    fm_float          dropPct;
+
+    BenchSample(bench, &end);
+
+    if (err != FM_OK)
+    {
+        FM_LOG_PRINT("%-24s %7d failed: %s\n",
+                     name,
+                     numOps,
+                     fmErrorMsg(err));
+        return;
+    }
+
+    wallNsec = end.wallNsec - start->wallNsec;
+
+    if (wallNsec == 0)
+    {
+        wallNsec = 1;
+    }
+
+    reported =
+        (end.counters[MAC_BENCH_CTR_REPORT_LEARN] -
+         start->counters[MAC_BENCH_CTR_REPORT_LEARN]) +
+        (end.counters[MAC_BENCH_CTR_REPORT_AGE] -
+         start->counters[MAC_BENCH_CTR_REPORT_AGE]);
+
+    dropped =
+        (end.counters[MAC_BENCH_CTR_ALLOC_ERR] -
+         start->counters[MAC_BENCH_CTR_ALLOC_ERR]) +
+        (end.counters[MAC_BENCH_CTR_SEND_ERR] -
+         start->counters[MAC_BENCH_CTR_SEND_ERR]);
+
+    throttled = end.counters[MAC_BENCH_CTR_THROTTLED] -
+                start->counters[MAC_BENCH_CTR_THROTTLED];
+
+    dropPct = 0.0;
+
+    if (reported + dropped != 0)
+    {
+        dropPct = (fm_float) (100.0 * dropped / (reported + dropped));
+    }
+
+    FM_LOG_PRINT("%-24s %7d %9" FM_FORMAT_64 "u %9" FM_FORMAT_64 "u "
+                 "%9" FM_FORMAT_64 "u %6d %8" FM_FORMAT_64 "u %5.1f "
+                 "%8" FM_FORMAT_64 "u\n",
+                 name,
+                 numOps,
+                 (fm_uint64) numOps * FM_LITERAL_U64(1000000000) / wallNsec,
+                 (end.maintNsec - start->maintNsec) / 1000,
+                 (end.eventNsec - start->eventNsec) / 1000,
+                 fmRootApi->eventThread.events.maxSize,
+                 reported,
+                 dropPct,
+                 throttled);
+
+}   /* end BenchReport */
+
+
+
+
+/*****************************************************************************/
+/** BenchFillEntries
+ * \ingroup intDiagMisc
+ *
+ * \desc            Fills the entries added through the API: dynamic
+ *                  addresses on the benchmark port and VLAN, so that the
+ *                  flushes remove them.
+ *
+ * \param[in]       bench points to the benchmark context.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchFillEntries(fm_macBench *bench)
+{
+    fm_macAddressEntry *entry;
+    fm_int              i;
+
+    for (i = 0 ; i < bench->numAddresses ; i++)
+    {
+        entry = &bench->entries[i];
+
+        FM_CLEAR(*entry);
+
+        entry->macAddress = MAC_BENCH_API_BASE + i;
+        entry->vlanID     = bench->vlanID;
+        entry->destMask   = FM_DESTMASK_UNUSED;
+        entry->port       = bench->port;
+        entry->type       = FM_ADDRESS_DYNAMIC;
+    }
+
+}   /* end BenchFillEntries */
+
+
+
+
+/*****************************************************************************/
+/** BenchFlushDone
+ * \ingroup intDiagMisc
+ *
+ * \desc            Called by the maintenance thread when a flush requested
+ *                  by ''BenchFlush'' has completed.
+ *
+ * \param[in]       sw is the switch on which the flush was done.
+ *
+ * \param[in]       context points to the semaphore to signal.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status BenchFlushDone(fm_int sw, void *context)
+{
+    FM_NOT_USED(sw);
+
+    return fmSignalSemaphore( (fm_semaphore *) context );
+
+}   /* end BenchFlushDone */
+
+
+
+
+/*****************************************************************************/
+/** BenchFlush
+ * \ingroup intDiagMisc
+ *
+ * \desc            Flushes the dynamic addresses of the benchmark port or
+ *                  VLAN, as ''fmFlushAddresses'' does, and waits for the
+ *                  maintenance thread to complete the purge.
+ *
+ * \param[in]       bench points to the benchmark context.
+ *
+ * \param[in]       mode is FM_FLUSH_MODE_PORT or FM_FLUSH_MODE_VLAN.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_SEM_TIMEOUT if the flush did not complete.
+ *
+ *****************************************************************************/
+static fm_status BenchFlush(fm_macBench *bench, fm_flushMode mode)
+{
+    fm_flushParams params;
+    fm_timestamp   timeout;
+    fm_status      err;
+
+    FM_CLEAR(params);
+    params.port = bench->port;
+    params.vid1 = bench->vlanID;
+
+    err = fmFlushMATable(bench->sw,
+                         mode,
+                         params,
+                         BenchFlushDone,
+                         &bench->flushDone);
+
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    timeout.sec  = MAC_BENCH_FLUSH_TIMEOUT_SEC;
+    timeout.usec = 0;
+
+    return fmWaitSemaphore(&bench->flushDone, &timeout);
+
+}   /* end BenchFlush */
+
+
+
+
+/*****************************************************************************/
+/** BenchTcnBurst
+ * \ingroup intDiagMisc
+ *
+ * \desc            Learns addresses through the TCN FIFO: the FIFO is
+ *                  filled with NewSource entries, the maintenance thread
+ *                  is asked to service it and the entries are counted out
+ *                  of the FIFO, until all the addresses have been handled.
+ *
+ * \param[in]       bench points to the benchmark context.
+ *
+ * \param[out]      numHandled points to caller-allocated storage where the
+ *                  number of entries taken out of the FIFO is written.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the switch cannot inject entries.
+ * \return          FM_FAIL if the maintenance thread stopped taking
+ *                  entries out of the FIFO.
+ *
+ *****************************************************************************/
+static fm_status BenchTcnBurst(fm_macBench *bench, fm_int *numHandled)
+{
+    fm_switch * switchPtr;
+    fm_status   err;
+    fm_uint64   target;
+    fm_uint64   count;
+    fm_uint64   last;
+    fm_uint64   lastProgress;
+    fm_int      injected;
+
+    switchPtr   = GET_SWITCH_PTR(bench->sw);
+    *numHandled = 0;
+
+    if (switchPtr->DbgInjectMACTableEvents == NULL)
+    {
+        return FM_ERR_UNSUPPORTED;
+    }
+
+    target = BenchGetCounter(bench->sw, MAC_BENCH_CTR_TCN_LEARNED);
+
+    while (*numHandled < bench->numAddresses)
+    {
+        err = switchPtr->DbgInjectMACTableEvents(bench->sw,
+                                                 MAC_BENCH_TCN_BASE +
+                                                     *numHandled,
+                                                 bench->vlanID,
+                                                 bench->port,
+                                                 bench->numAddresses -
+                                                     *numHandled,
+                                                 &injected);
+        if (err != FM_OK)
+        {
+            return err;
+        }
+
+        /* The FIFO was drained by the previous pass, so it has room */
+        if (injected == 0)
+        {
+            return FM_FAIL;
+        }
+
+        target += injected;
+
+        err = fmIssueMacMaintRequest(bench->sw, FM_UPD_SERVICE_MAC_FIFO);
+        if (err != FM_OK)
+        {
+            return err;
+        }
+
+        last         = 0;
+        lastProgress = fmGetMonotonicNsec();
+
+        for ( ; ; )
+        {
+            count = BenchGetCounter(bench->sw, MAC_BENCH_CTR_TCN_LEARNED);
+
+            if (count >= target)
+            {
+                break;
+            }
+
+            if (count != last)
+            {
+                last         = count;
+                lastProgress = fmGetMonotonicNsec();
+            }
+            else if (fmGetMonotonicNsec() - lastProgress >
+                     MAC_BENCH_STALL_NSEC)
+            {
+                return FM_FAIL;
+            }
+
+            fmYield();
+        }
+
+        *numHandled += injected;
+    }
+
+    return FM_OK;
+
+}   /* end BenchTcnBurst */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fmDbgMacBenchmark
+ * \ingroup diagMisc
+ *
+ * \chips           FM10000
+ *
+ * \desc            Measures the MAC address subsystem at scale. Each of
+ *                  the following operations handles numAddresses dynamic
+ *                  addresses on the given port and VLAN:
+ *                                                                      \lb\lb
+ *                  - ''fmAddAddress'' and ''fmDeleteAddress'', one
+ *                    address per call.
+ *                  - ''fmAddAddressList'' and ''fmDeleteAddressList'',
+ *                    all addresses in one call.
+ *                  - ''fmFlushAddresses'' by port, then by VLAN, timed
+ *                    until the maintenance thread has completed the purge.
+ *                  - Learning through the MA Table Change Notification
+ *                    (TCN) FIFO: synthetic NewSource entries are pushed
+ *                    into the FIFO in bursts and serviced by the
+ *                    maintenance thread.
+ *                                                                      \lb\lb
+ *                  For each operation, a row reports the addresses
+ *                  handled per second, the CPU time used by the MAC
+ *                  maintenance and event handler threads, the peak depth
+ *                  of the event handler queue, the number of table updates
+ *                  reported to the application, the percentage of table
+ *                  update events dropped for lack of event buffers or
+ *                  queue space, and the new addresses held back by the
+ *                  learning rate limiter.
+ *
+ * \note            Intended for a test system: every dynamic address on
+ *                  vlanID is flushed. The TCN FIFO operation requires the
+ *                  simulated register access mode (regAccess "SIM"),
+ *                  since on a switch the hardware owns the FIFO.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port the addresses are on.
+ *
+ * \param[in]       vlanID is the VLAN the addresses are on.
+ *
+ * \param[in]       numAddresses is the number of addresses handled by
+ *                  each operation.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if vlanID or numAddresses is
+ *                  out of range.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ * \return          Otherwise, the status of the first operation that
+ *                  failed.
+ *
+ *****************************************************************************/
+fm_status fmDbgMacBenchmark(fm_int sw,
+                            fm_int port,
+                            fm_int vlanID,
+                            fm_int numAddresses)
+{
+    fm_macBench       bench;
+    fm_macBenchSample start;
+    fm_status         err;
+    fm_status         opErr;
+    fm_bool           semCreated;
+    fm_int            numOps;
+    fm_int            i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_DEBUG,
+                 "sw=%d port=%d vlanID=%d numAddresses=%d\n",
+                 sw,
+                 port,
+                 vlanID,
+                 numAddresses);
+
+    if ( (vlanID < 1) || (vlanID >= FM_MAX_VLAN) || (numAddresses < 1) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    FM_CLEAR(bench);
+    bench.sw           = sw;
+    bench.port         = port;
+    bench.vlanID       = (fm_uint16) vlanID;
+    bench.numAddresses = numAddresses;
+    bench.maintThread  = fmRootApi->perSwitchTasks ?
+                         &fmRootApi->switchTasks[sw].maintenanceTask :
+                         &fmRootApi->maintenanceTask;
+    semCreated         = FALSE;
+    err                = FM_OK;
+
+    bench.entries = fmAlloc(numAddresses * sizeof(fm_macAddressEntry));
+
+    if (bench.entries == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_DEBUG, err);
+    }
+
+    err = fmCreateSemaphore("macBenchFlushDone",
+                            FM_SEM_BINARY,
+                            &bench.flushDone,
+                            0);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_DEBUG, err);
+    semCreated = TRUE;
+
+    FM_LOG_PRINT("\nMAC benchmark: sw=%d port=%d vlan=%d addresses=%d\n",
+                 sw,
+                 port,
+                 vlanID,
+                 numAddresses);
+    FM_LOG_PRINT("%-24s %7s %9s %9s %9s %6s %8s %5s %8s\n",
+                 "Operation",
+                 "addrs",
+                 "addrs/s",
+                 "maint us",
+                 "event us",
+                 "qpeak",
+                 "reported",
+                 "drop%",
+                 "throttle");
+
+    /**************************************************
+     * One address per call.
+     **************************************************/
+
+    BenchFillEntries(&bench);
+
+    BenchStart(&bench, &start);
+    opErr = FM_OK;
+
+    for (numOps = 0 ; numOps < numAddresses ; numOps++)
+    {
+        opErr = fmAddAddress(sw, &bench.entries[numOps]);
+        if (opErr != FM_OK)
+        {
+            break;
+        }
+    }
+
+    BenchReport(&bench, "fmAddAddress", numOps, &start, opErr);
+    err = (err != FM_OK) ? err : opErr;
+
+    BenchStart(&bench, &start);
+    opErr = FM_OK;
+
+    for (i = 0 ; i < numOps ; i++)
+    {
+        opErr = fmDeleteAddress(sw, &bench.entries[i]);
+        if (opErr != FM_OK)
+        {
+            break;
+        }
+    }
+
+    BenchReport(&bench, "fmDeleteAddress", i, &start, opErr);
+    err = (err != FM_OK) ? err : opErr;
+
+    /**************************************************
+     * All addresses in one call.
+     **************************************************/
+
+    BenchFillEntries(&bench);
+
+    BenchStart(&bench, &start);
+    opErr = fmAddAddressList(sw, numAddresses, bench.entries);
+    BenchReport(&bench, "fmAddAddressList", numAddresses, &start, opErr);
+    err = (err != FM_OK) ? err : opErr;
+
+    BenchFillEntries(&bench);
+
+    BenchStart(&bench, &start);
+    opErr = fmDeleteAddressList(sw, numAddresses, bench.entries);
+    BenchReport(&bench, "fmDeleteAddressList", numAddresses, &start, opErr);
+    err = (err != FM_OK) ? err : opErr;
+
+    /**************************************************
+     * Flushes, each of a freshly loaded table.
+     **************************************************/
+
+    BenchFillEntries(&bench);
+    opErr = fmAddAddressList(sw, numAddresses, bench.entries);
+
+    if (opErr == FM_OK)
+    {
+        BenchStart(&bench, &start);
+        opErr = BenchFlush(&bench, FM_FLUSH_MODE_PORT);
+    }
+
+    BenchReport(&bench,
+                "flush by port",
+                (opErr == FM_OK) ? numAddresses : 0,
+                &start,
+                opErr);
+    err = (err != FM_OK) ? err : opErr;
+
+    BenchFillEntries(&bench);
+    opErr = fmAddAddressList(sw, numAddresses, bench.entries);
+
+    if (opErr == FM_OK)
+    {
+        BenchStart(&bench, &start);
+        opErr = BenchFlush(&bench, FM_FLUSH_MODE_VLAN);
+    }
+
+    BenchReport(&bench,
+                "flush by VLAN",
+                (opErr == FM_OK) ? numAddresses : 0,
+                &start,
+                opErr);
+    err = (err != FM_OK) ? err : opErr;
+
+    /**************************************************
+     * Learning through the TCN FIFO, then a flush to
+     * remove the learned addresses.
+     **************************************************/
+
+    BenchStart(&bench, &start);
+    opErr = BenchTcnBurst(&bench, &numOps);
+    BenchReport(&bench, "TCN FIFO learning", numOps, &start, opErr);
+
+    if (opErr != FM_ERR_UNSUPPORTED)
+    {
+        err = (err != FM_OK) ? err : opErr;
+    }
+
+    if (numOps > 0)
+    {
+        opErr = BenchFlush(&bench, FM_FLUSH_MODE_VLAN);
+        err   = (err != FM_OK) ? err : opErr;
+    }
+
+ABORT:
+    if (semCreated)
+    {
+        fmDeleteSemaphore(&bench.flushDone);
+    }
+
+    if (bench.entries != NULL)
+    {
+        fmFree(bench.entries);
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_DEBUG, err);
+
+}   /* end fmDbgMacBenchmark */
@@ -0,0 +1,900 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_debug_pkt_bench.c
+ * Creation Date:   October 15, 2026
+ * Description:     Packet I/O throughput and latency benchmark.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* EtherType of the generated frames, the IEEE local experimental one */
+#define PKT_BENCH_ETHERTYPE             0x88B5
+
+/* Length of the Ethernet header written in the generated frames */
+#define PKT_BENCH_HEADER_BYTES          14
+
+/* Length of the FCS, counted in the frame size but not passed to the API */
+#define PKT_BENCH_FCS_BYTES             4
+
+/* Time without progress after which a run gives up waiting for buffers
+ * or for the transmit queue to drain */
+#define PKT_BENCH_STALL_NSEC            FM_LITERAL_U64(1000000000)
+
+/* Ways of sending a frame */
+typedef enum
+{
+    PKT_BENCH_TX_DIRECTED = 0,
+    PKT_BENCH_TX_SWITCHED,
+    PKT_BENCH_TX_MAX
+
+} fm_pktBenchTxMode;
+
+
+/* Measurements of one run */
+typedef struct
+{
+    /* Latency of each successful send call, in nanoseconds */
+    fm_uint64 * latency;
+    fm_int      count;
+
+    /* Number of times the transmit queue was full */
+    fm_int      busy;
+
+    /* Number of frames that could not be sent */
+    fm_int      failures;
+
+    /* Wall clock and process CPU time taken by the run, in nanoseconds */
+    fm_uint64   wallNsec;
+    fm_uint64   cpuNsec;
+
+} fm_pktBenchStats;
+
+
+/* Receive latency samples of one stage of the receive path */
+typedef struct
+{
+    /* Cycles from reception to the stage, for each sampled frame */
+    fm_uint64 * cycles;
+    fm_int      count;
+
+    /* Frames seen once the sample buffer was full */
+    fm_int      missed;
+
+} fm_pktRxStage;
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Frame sizes, FCS included, swept when no size is given */
+static const fm_int pktBenchFrameSizes[] =
+{
+    64, 128, 256, 512, 1024, 1518, 4096, 9216
+};
+
+static const fm_text pktBenchTxModeNames[PKT_BENCH_TX_MAX] =
+{
+    "directed",
+    "switched",
+};
+
+static const fm_text pktRxStageNames[FM_DBG_PKT_RX_STAGE_MAX] =
+{
+    "rx -> fmDistributeEvent",
+    "rx -> application",
+};
+
+/* Receive latency probe, see fmDbgPacketRxLatencyStart. The lock protects
+ * the samples, armed is also read without it to keep the receive path
+ * cheap while the probe is not running. */
+static fm_lock       pktRxLock;
+static fm_bool       pktRxArmed;
+static fm_int        pktRxMaxSamples;
+static fm_pktRxStage pktRxStages[FM_DBG_PKT_RX_STAGE_MAX];
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** BenchCpuNsec
+ * \ingroup intDiagMisc
+ *
+ * \desc            Returns the CPU time consumed by the process, which
+ *                  includes the API and platform threads moving the frames.
+ *
+ * \return          The CPU time in nanoseconds.
+ *
+ *****************************************************************************/
+static fm_uint64 BenchCpuNsec(void)
+{
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0)
+    {
+        return 0;
+    }
+
+    return ( (fm_uint64) ts.tv_sec * FM_LITERAL_U64(1000000000) ) +
+           ts.tv_nsec;
+
+}   /* end BenchCpuNsec */
+
+
+
+
+/*****************************************************************************/
+/** BenchBuildFrame
+ * \ingroup intDiagMisc
+ *
+ * \desc            Allocates and fills a frame. The frame is addressed
+ *                  from and to locally administered MAC addresses and
+ *                  carries a zeroed payload.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       frameSize is the size of the frame, FCS included.
+ *
+ * \return          Pointer to the buffer chain holding the frame.
+ * \return          NULL if no buffers are available.
+ *
+ *****************************************************************************/
+static fm_buffer *BenchBuildFrame(fm_int sw, fm_int frameSize)
+{
+    static const fm_byte header[PKT_BENCH_HEADER_BYTES] =
+    {
+        0x02, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x02, 0x00, 0x00, 0x00, 0x00, 0x02,
+        (PKT_BENCH_ETHERTYPE >> 8) & 0xFF, PKT_BENCH_ETHERTYPE & 0xFF
+    };
+    fm_buffer *chain;
+    fm_buffer *buf;
+    fm_byte *  data;
+
+    chain = fmAllocateBufferChain(sw,
+                                  FM_BUFFER_TX,
+                                  frameSize - PKT_BENCH_FCS_BYTES);
+
+    for (buf = chain ; buf != NULL ; buf = buf->next)
+    {
+        data = (fm_byte *) buf->data;
+
+        FM_MEMSET_S(data, buf->len, 0, buf->len);
+
+        if (buf == chain)
+        {
+            FM_MEMCPY_S(data, buf->len, header, sizeof(header));
+        }
+    }
+
+    return chain;
+
+}   /* end BenchBuildFrame */
+
+
+
+
+/*****************************************************************************/
+/** BenchWaitForBuffers
+ * \ingroup intDiagMisc
+ *
+ * \desc            Waits until the buffers taken by a run are back in the
+ *                  pool, which happens once every frame has been sent.
+ *
+ * \param[in]       numBuffers is the number of available buffers before
+ *                  the run.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchWaitForBuffers(fm_int numBuffers)
+{
+    fm_uint64 deadline;
+    fm_int    available;
+    fm_int    last;
+
+    last     = -1;
+    deadline = fmGetMonotonicNsec() + PKT_BENCH_STALL_NSEC;
+
+    while ( fmPlatformGetAvailableBuffers(&available) == FM_OK )
+    {
+        if (available >= numBuffers)
+        {
+            return;
+        }
+
+        if (available != last)
+        {
+            last     = available;
+            deadline = fmGetMonotonicNsec() + PKT_BENCH_STALL_NSEC;
+        }
+        else if (fmGetMonotonicNsec() > deadline)
+        {
+            FM_LOG_WARNING(FM_LOG_CAT_DEBUG,
+                           "%d buffers still in use after the run\n",
+                           numBuffers - available);
+            return;
+        }
+
+        fmYield();
+    }
+
+}   /* end BenchWaitForBuffers */
+
+
+
+
+/*****************************************************************************/
+/** BenchRun
+ * \ingroup intDiagMisc
+ *
+ * \desc            Sends a number of frames of one size one way and
+ *                  measures the run. A frame that finds the transmit queue
+ *                  full is sent again. The run stops at the first frame
+ *                  the API refuses for another reason.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       mode is the way the frames are sent.
+ *
+ * \param[in]       port is the destination port of directed frames.
+ *
+ * \param[in]       frameSize is the size of the frames, FCS included.
+ *
+ * \param[in]       numFrames is the number of frames to send.
+ *
+ * \param[out]      stats points to caller allocated storage where the
+ *                  measurements are written. Its latency array must hold
+ *                  numFrames entries.
+ *
+ * \return          FM_OK if every frame was sent.
+ * \return          The error returned by the API for the refused frame.
+ *
+ *****************************************************************************/
+static fm_status BenchRun(fm_int            sw,
+                          fm_pktBenchTxMode mode,
+                          fm_int            port,
+                          fm_int            frameSize,
+                          fm_int            numFrames,
+                          fm_pktBenchStats *stats)
+{
+    fm_buffer *pkt;
+    fm_status  err;
+    fm_uint64  wallStart;
+    fm_uint64  cpuStart;
+    fm_uint64  deadline;
+    fm_uint64  start;
+    fm_int     availableBuffers;
+    fm_int     i;
+
+    stats->count    = 0;
+    stats->busy     = 0;
+    stats->failures = 0;
+    err             = FM_OK;
+
+    if (fmPlatformGetAvailableBuffers(&availableBuffers) != FM_OK)
+    {
+        availableBuffers = 0;
+    }
+
+    wallStart = fmGetMonotonicNsec();
+    cpuStart  = BenchCpuNsec();
+
+    for (i = 0 ; i < numFrames ; i++)
+    {
+        deadline = fmGetMonotonicNsec() + PKT_BENCH_STALL_NSEC;
+
+        while ( (pkt = BenchBuildFrame(sw, frameSize)) == NULL )
+        {
+            if (fmGetMonotonicNsec() > deadline)
+            {
+                err = FM_ERR_NO_MEM;
+                break;
+            }
+
+            fmYield();
+        }
+
+        while (pkt != NULL)
+        {
+            start = fmGetMonotonicNsec();
+
+            if (mode == PKT_BENCH_TX_DIRECTED)
+            {
+                err = fmSendPacketDirected(sw, &port, 1, pkt);
+            }
+            else
+            {
+                err = fmSendPacketSwitched(sw, pkt);
+            }
+
+            if (err == FM_OK)
+            {
+                stats->latency[stats->count++] = fmGetMonotonicNsec() - start;
+                pkt = NULL;
+            }
+            else if ( (err == FM_ERR_TX_PACKET_QUEUE_FULL) &&
+                      (fmGetMonotonicNsec() <= deadline) )
+            {
+                stats->busy++;
+                fmYield();
+            }
+            else
+            {
+                fmFreeBufferChain(sw, pkt);
+                pkt = NULL;
+            }
+        }
+
+        if (err != FM_OK)
+        {
+            stats->failures = numFrames - i;
+            break;
+        }
+    }
+
+    BenchWaitForBuffers(availableBuffers);
+
+    stats->cpuNsec  = BenchCpuNsec() - cpuStart;
+    stats->wallNsec = fmGetMonotonicNsec() - wallStart;
+
+    return err;
+
+}   /* end BenchRun */
+
+
+
+
+/*****************************************************************************/
+/** BenchCompareLatency
+ * \ingroup intDiagMisc
+ *
+ * \desc            Orders latencies for qsort.
+ *
+ * \param[in]       a points to the first latency.
+ *
+ * \param[in]       b points to the second latency.
+ *
+ * \return          -1, 0 or 1 as a is less than, equal to or greater than b.
+ *
+ *****************************************************************************/
+static int BenchCompareLatency(const void *a, const void *b)
+{
+    fm_uint64 la = *(const fm_uint64 *) a;
+    fm_uint64 lb = *(const fm_uint64 *) b;
+
+    return (la < lb) ? -1 : (la > lb) ? 1 : 0;
+
+}   /* end BenchCompareLatency */
+
+
+
+
+/*****************************************************************************/
+/** BenchPrintRun
+ * \ingroup intDiagMisc
+ *
+ * \desc            Prints the measurements of one run.
+ *
+ * \param[in]       mode is the way the frames were sent.
+ *
+ * \param[in]       frameSize is the size of the frames, FCS included.
+ *
+ * \param[in]       stats points to the measurements, whose latencies are
+ *                  sorted by this function.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchPrintRun(fm_pktBenchTxMode mode,
+                          fm_int            frameSize,
+                          fm_pktBenchStats *stats)
+{
+    fm_uint64 *lat;
+    fm_uint64  framesPerSec;
+    fm_uint64  bytesPerSec;
+    fm_uint64  cpuPerFrame;
+    fm_int     bufferSize;
+    fm_int     n;
+
+    n          = stats->count;
+    lat        = stats->latency;
+    bufferSize = fmPlatformGetBufferSize();
+
+    framesPerSec = 0;
+    bytesPerSec  = 0;
+    cpuPerFrame  = 0;
+
+    if ( (n > 0) && (stats->wallNsec > 0) )
+    {
+        framesPerSec = (fm_uint64) n * FM_LITERAL_U64(1000000000) /
+                       stats->wallNsec;
+        bytesPerSec  = framesPerSec * frameSize;
+        cpuPerFrame  = stats->cpuNsec / n;
+        qsort(lat, n, sizeof(fm_uint64), BenchCompareLatency);
+    }
+
+    FM_LOG_PRINT("%-8s %5d %5d %7d %6d %6d %9" FM_FORMAT_64 "u "
+                 "%11" FM_FORMAT_64 "u %7" FM_FORMAT_64 "u "
+                 "%7" FM_FORMAT_64 "u %7" FM_FORMAT_64 "u "
+                 "%8" FM_FORMAT_64 "u\n",
+                 pktBenchTxModeNames[mode],
+                 frameSize,
+                 (frameSize - PKT_BENCH_FCS_BYTES + bufferSize - 1) /
+                     bufferSize,
+                 n,
+                 stats->busy,
+                 stats->failures,
+                 framesPerSec,
+                 bytesPerSec,
+                 cpuPerFrame,
+                 (n > 0) ? lat[(n - 1) * 50 / 100] : 0,
+                 (n > 0) ? lat[(n - 1) * 99 / 100] : 0,
+                 (n > 0) ? lat[n - 1] : 0);
+
+}   /* end BenchPrintRun */
+
+
+
+
+/*****************************************************************************/
+/** PrintRxStage
+ * \ingroup intDiagMisc
+ *
+ * \desc            Prints the receive latency samples of one stage.
+ *
+ * \param[in]       stage is the stage, see ''fm_dbgPktRxStage''.
+ *
+ * \param[in,out]   samples points to the stage's samples, which are
+ *                  converted to nanoseconds and sorted by this function.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void PrintRxStage(fm_int stage, fm_pktRxStage *samples)
+{
+    fm_uint64 *lat;
+    fm_int     n;
+    fm_int     i;
+
+    n   = samples->count;
+    lat = samples->cycles;
+
+    for (i = 0 ; i < n ; i++)
+    {
+        lat[i] = fmCyclesToNsec(lat[i]);
+    }
+
+    if (n > 0)
+    {
+        qsort(lat, n, sizeof(fm_uint64), BenchCompareLatency);
+    }
+
+    FM_LOG_PRINT("%-24s %7d %7d %9" FM_FORMAT_64 "u %9" FM_FORMAT_64 "u "
+                 "%9" FM_FORMAT_64 "u %9" FM_FORMAT_64 "u\n",
+                 pktRxStageNames[stage],
+                 n,
+                 samples->missed,
+                 (n > 0) ? lat[(n - 1) * 50 / 100] : 0,
+                 (n > 0) ? lat[(n - 1) * 90 / 100] : 0,
+                 (n > 0) ? lat[(n - 1) * 99 / 100] : 0,
+                 (n > 0) ? lat[n - 1] : 0);
+
+}   /* end PrintRxStage */
+
+
+
+
+/*****************************************************************************/
+/** FreeRxStages
+ * \ingroup intDiagMisc
+ *
+ * \desc            Releases the receive latency samples. Called with the
+ *                  probe lock taken.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void FreeRxStages(void)
+{
+    fm_int stage;
+
+    for (stage = 0 ; stage < FM_DBG_PKT_RX_STAGE_MAX ; stage++)
+    {
+        if (pktRxStages[stage].cycles != NULL)
+        {
+            fmFree(pktRxStages[stage].cycles);
+        }
+
+        FM_CLEAR(pktRxStages[stage]);
+    }
+
+}   /* end FreeRxStages */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fmDbgInitPacketBench
+ * \ingroup intDiagMisc
+ *
+ * \desc            Initializes the receive latency probe of the packet
+ *                  benchmark.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmDbgInitPacketBench(void)
+{
+    FM_CLEAR(pktRxStages);
+    pktRxArmed      = FALSE;
+    pktRxMaxSamples = 0;
+
+    return fmCreateLock("Packet Rx Latency", &pktRxLock);
+
+}   /* end fmDbgInitPacketBench */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgPacketRxLatencyRecord
+ * \ingroup intDiagMisc
+ *
+ * \desc            Samples the time a received frame took to reach a stage
+ *                  of the receive path, if the probe is running.
+ *
+ * \param[in]       stage is the stage reached, see ''fm_dbgPktRxStage''.
+ *
+ * \param[in]       pkt points to the first buffer of the frame.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmDbgPacketRxLatencyRecord(fm_int stage, void *pkt)
+{
+    fm_pktRxStage *samples;
+    fm_buffer *    buf;
+    fm_uint64      now;
+
+    if ( !FM_ATOMIC_LOAD_RELAXED(&pktRxArmed) )
+    {
+        return;
+    }
+
+    buf = pkt;
+
+    if ( (buf == NULL) || (buf->rxCycles == 0) )
+    {
+        return;
+    }
+
+    now = FM_GET_CYCLES();
+
+    fmCaptureLock(&pktRxLock, FM_WAIT_FOREVER);
+
+    if (pktRxArmed)
+    {
+        samples = &pktRxStages[stage];
+
+        if (samples->count < pktRxMaxSamples)
+        {
+            samples->cycles[samples->count++] = now - buf->rxCycles;
+        }
+        else
+        {
+            samples->missed++;
+        }
+    }
+
+    fmReleaseLock(&pktRxLock);
+
+}   /* end fmDbgPacketRxLatencyRecord */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgPacketRxLatencyStart
+ * \ingroup diagMisc
+ *
+ * \chips           FM10000
+ *
+ * \desc            Starts sampling the latency of received frames, from
+ *                  the moment the platform hands them to the API, right
+ *                  after the receive backend got them, to their hand-off
+ *                  to ''fmDistributeEvent'' and to their delivery to the
+ *                  application's event handler or event batch. Frames
+ *                  enqueued directly, bypassing the global event handler,
+ *                  are not sampled. Only frames received by the calling
+ *                  process are sampled.
+ *                                                                      \lb\lb
+ *                  Starting the probe again discards the samples taken so
+ *                  far. See ''fmDbgPacketRxLatencyStop''.
+ *
+ * \param[in]       maxSamples is the maximum number of frames sampled at
+ *                  each stage.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if maxSamples is not positive.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmDbgPacketRxLatencyStart(fm_int maxSamples)
+{
+    fm_status err;
+    fm_int    stage;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_DEBUG, "maxSamples=%d\n", maxSamples);
+
+    if (maxSamples < 1)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    err = FM_OK;
+
+    fmCaptureLock(&pktRxLock, FM_WAIT_FOREVER);
+
+    FM_ATOMIC_STORE(&pktRxArmed, FALSE);
+    FreeRxStages();
+
+    for (stage = 0 ; stage < FM_DBG_PKT_RX_STAGE_MAX ; stage++)
+    {
+        pktRxStages[stage].cycles = fmAlloc( maxSamples * sizeof(fm_uint64) );
+
+        if (pktRxStages[stage].cycles == NULL)
+        {
+            FreeRxStages();
+            err = FM_ERR_NO_MEM;
+            break;
+        }
+    }
+
+    if (err == FM_OK)
+    {
+        pktRxMaxSamples = maxSamples;
+        FM_ATOMIC_STORE(&pktRxArmed, TRUE);
+    }
+
+    fmReleaseLock(&pktRxLock);
+
+    FM_LOG_EXIT(FM_LOG_CAT_DEBUG, err);
+
+}   /* end fmDbgPacketRxLatencyStart */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgPacketRxLatencyStop
+ * \ingroup diagMisc
+ *
+ * \chips           FM10000
+ *
+ * \desc            Stops the probe started by ''fmDbgPacketRxLatencyStart''
+ *                  and prints, for each stage of the receive path, the
+ *                  number of sampled frames, the number of frames missed
+ *                  once the samples were full and the 50th, 90th and 99th
+ *                  percentile and maximum latencies in nanoseconds.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_STATE if the probe is not running.
+ *
+ *****************************************************************************/
+fm_status fmDbgPacketRxLatencyStop(void)
+{
+    fm_int stage;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_DEBUG, "(no arguments)\n");
+
+    fmCaptureLock(&pktRxLock, FM_WAIT_FOREVER);
+
+    if (!pktRxArmed)
+    {
+        fmReleaseLock(&pktRxLock);
+        FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_ERR_INVALID_STATE);
+    }
+
+    FM_ATOMIC_STORE(&pktRxArmed, FALSE);
+
+    FM_LOG_PRINT("\nPacket receive latency:\n");
+    FM_LOG_PRINT("%-24s %7s %7s %9s %9s %9s %9s\n",
+                 "Stage",
+                 "Frames",
+                 "Missed",
+                 "p50 ns",
+                 "p90 ns",
+                 "p99 ns",
+                 "max ns");
+
+    for (stage = 0 ; stage < FM_DBG_PKT_RX_STAGE_MAX ; stage++)
+    {
+        PrintRxStage(stage, &pktRxStages[stage]);
+    }
+
+    FreeRxStages();
+
+    fmReleaseLock(&pktRxLock);
+
+    FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_OK);
+
+}   /* end fmDbgPacketRxLatencyStop */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgPacketBenchmark
+ * \ingroup diagMisc
+ *
+ * \chips           FM10000
+ *
+ * \desc            Measures the cost of sending frames through the CPU
+ *                  port. For each frame size the benchmark sends numFrames
+ *                  frames with ''fmSendPacketDirected'' to a port, then
+ *                  numFrames frames with ''fmSendPacketSwitched''. The
+ *                  frames are sent from and to locally administered MAC
+ *                  addresses with EtherType 0x88B5, so switched frames
+ *                  are flooded in the default VLAN of the CPU port.
+ *                                                                      \lb\lb
+ *                  Each frame is allocated with ''fmAllocateBufferChain''
+ *                  and filled before being sent, and a run ends once every
+ *                  buffer is back in the pool, so that the measurements
+ *                  cover the allocator and the transmit backend. For each
+ *                  run the benchmark prints the frame size, the length of
+ *                  its buffer chain, the frames sent, the times the
+ *                  transmit queue was full, the frames not sent, frames
+ *                  and bytes per second, the CPU time of the process per
+ *                  frame and the 50th and 99th percentile and maximum
+ *                  latencies of the send call in nanoseconds.
+ *                                                                      \lb\lb
+ *                  Use ''fmDbgPacketRxLatencyStart'' to measure the
+ *                  receive path, for instance with the port looped back.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port directed frames are sent to.
+ *
+ * \param[in]       numFrames is the number of frames sent in each run.
+ *
+ * \param[in]       frameSize is the size of the frames, FCS included, or
+ *                  0 to sweep sizes from 64 to 9216 bytes.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmDbgPacketBenchmark(fm_int sw,
+                               fm_int port,
+                               fm_int numFrames,
+                               fm_int frameSize)
+{
+    fm_pktBenchStats stats;
+    fm_status        err;
+    fm_int           numSizes;
+    fm_int           size;
+    fm_int           mode;
+    fm_int           i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_DEBUG,
+                 "sw=%d port=%d numFrames=%d frameSize=%d\n",
+                 sw,
+                 port,
+                 numFrames,
+                 frameSize);
+
+    if ( (numFrames < 1) ||
+         ( (frameSize != 0) &&
+           (frameSize < PKT_BENCH_HEADER_BYTES + PKT_BENCH_FCS_BYTES) ) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    err = FM_OK;
+
+    FM_CLEAR(stats);
+
+    stats.latency = fmAlloc( numFrames * sizeof(fm_uint64) );
+
+    if (stats.latency == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    numSizes = (frameSize == 0) ? FM_NENTRIES(pktBenchFrameSizes) : 1;
+
+    FM_LOG_PRINT("\nPacket benchmark: sw=%d port=%d frames=%d "
+                 "buffer=%d bytes\n",
+                 sw,
+                 port,
+                 numFrames,
+                 fmPlatformGetBufferSize());
+    FM_LOG_PRINT("%-8s %5s %5s %7s %6s %6s %9s %11s %7s %7s %7s %8s\n",
+                 "Mode",
+                 "Size",
+                 "Chain",
+                 "Sent",
+                 "Busy",
+                 "Fail",
+                 "Frames/s",
+                 "Bytes/s",
+                 "CPU ns",
+                 "p50 ns",
+                 "p99 ns",
+                 "max ns");
+
+    for (mode = 0 ; mode < PKT_BENCH_TX_MAX ; mode++)
+    {
+        for (i = 0 ; i < numSizes ; i++)
+        {
+            size = (frameSize == 0) ? pktBenchFrameSizes[i] : frameSize;
+
+            if (BenchRun(sw, mode, port, size, numFrames, &stats) != FM_OK)
+            {
+                FM_LOG_DEBUG(FM_LOG_CAT_DEBUG,
+                             "%s run of %d byte frames stopped early\n",
+                             pktBenchTxModeNames[mode],
+                             size);
+            }
+
+            BenchPrintRun(mode, size, &stats);
+        }
+    }
+
+ABORT:
+    if (stats.latency != NULL)
+    {
+        fmFree(stats.latency);
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_DEBUG, err);
+
+}   /* end fmDbgPacketBenchmark */
@@ -0,0 +1,1711 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_debug_reg_profile.c
+ * Creation Date:   October 15, 2026
+ * Description:     Sampling profiler of the register accesses of a switch.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* Number of return addresses kept for each sampled access */
+#define REG_PROFILE_MAX_FRAMES          12
+
+/* Number of entries shown per table when the caller does not say */
+#define REG_PROFILE_DEFAULT_ENTRIES     20
+
+#define REG_PROFILE_NAME_LENGTH         100
+
+/* Access counts of a register, register block or caller */
+typedef struct
+{
+    /* Number of read and write accesses. A read-modify-write counts as
+     * both. */
+    fm_uint64   reads;
+    fm_uint64   writes;
+
+    /* Number of 32-bit words transferred */
+    fm_uint64   words;
+
+    /* Number of sampled accesses and their total and worst latency */
+    fm_uint64   samples;
+    fm_uint64   cycles;
+    fm_uint64   maxCycles;
+
+} fm_regProfileCounts;
+
+
+/* Counts of the accesses starting at one register address */
+typedef struct
+{
+    fm_uint             addr;
+    fm_regProfileCounts counts;
+
+} fm_regProfileReg;
+
+
+/* Counts of the sampled accesses made from one call stack */
+typedef struct
+{
+    void *              frames[REG_PROFILE_MAX_FRAMES];
+    fm_int              numFrames;
+    fm_regProfileCounts counts;
+
+} fm_regProfileStack;
+
+
+/* Register access profile of a switch, see fmDbgStartRegProfile */
+typedef struct _fm_regProfile
+{
+    /* Protects the maps and the counts */
+    fm_lock             lock;
+
+    /* TRUE while the profiling functions are installed */
+    fm_bool             active;
+
+    /* One access out of samplePeriod is timed and its call stack
+     * recorded */
+    fm_int              samplePeriod;
+
+    /* Number of accesses seen, used to pick the sampled ones */
+    fm_uint32           accessCount;
+
+    /* Maps a register address to its fm_regProfileReg */
+    fm_hashMap          regs;
+
+    /* Maps the hash of a call stack to its fm_regProfileStack */
+    fm_hashMap          stacks;
+
+    /* Register access functions of the switch, saved while the profiling
+     * functions are installed in their place */
+    fm_status (*WriteUINT32)(fm_int sw, fm_uint reg, fm_uint32 value);
+    fm_status (*ReadUINT32)(fm_int sw, fm_uint reg, fm_uint32 *value);
+    fm_status (*MaskUINT32)(fm_int    sw,
+                            fm_uint   reg,
+                            fm_uint32 mask,
+                            fm_bool   on);
+    fm_status (*WriteUINT32Mult)(fm_int     sw,
+                                 fm_uint    reg,
+                                 fm_int     count,
+                                 fm_uint32 *ptr);
+    fm_status (*ReadUINT32Mult)(fm_int     sw,
+                                fm_uint    reg,
+                                fm_int     count,
+                                fm_uint32 *value);
+    fm_status (*WriteUINT64)(fm_int sw, fm_uint reg, fm_uint64 value);
+    fm_status (*ReadUINT64)(fm_int sw, fm_uint reg, fm_uint64 *value);
+    fm_status (*WriteUINT64Mult)(fm_int     sw,
+                                 fm_uint    reg,
+                                 fm_int     count,
+                                 fm_uint64 *ptr);
+    fm_status (*ReadUINT64Mult)(fm_int     sw,
+                                fm_uint    reg,
+                                fm_int     count,
+                                fm_uint64 *value);
+
+} fm_regProfile;
+
+
+/* State of one access between ProfileBegin and ProfileEnd */
+typedef struct
+{
+    fm_bool     sampled;
+    fm_uint64   start;
+    void *      frames[REG_PROFILE_MAX_FRAMES];
+    fm_int      numFrames;
+
+} fm_regProfileSample;
+
+
+/* A line of the dump, with the counts copied out of the profile */
+typedef struct
+{
+    fm_uint             addr;
+    fm_int              regId;
+    fm_char             name[REG_PROFILE_NAME_LENGTH];
+    void *              frames[REG_PROFILE_MAX_FRAMES];
+    fm_int              numFrames;
+    fm_regProfileCounts counts;
+
+} fm_regProfileLine;
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Functions of the register access layers. A sampled call stack is
+ * attributed to its first frame outside of them. */
+static const fm_text profileSkipPrefixes[] =
+{
+    "fmRead",
+    "fmWrite",
+    "fmMask",
+    "fmRegCache",
+    "fmRegBatch",
+    "fmPlatform",
+    "fmEmulate",
+    NULL
+};
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** ProfileFreeEntry
+ * \ingroup intDiagReg
+ *
+ * \desc            Frees an entry of one of the profile maps.
+ *
+ * \param[in]       value points to the entry.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ProfileFreeEntry(void *value)
+{
+    fmFree(value);
+
+}   /* end ProfileFreeEntry */
+
+
+
+
+/*****************************************************************************/
+/** ProfileAddCounts
+ * \ingroup intDiagReg
+ *
+ * \desc            Accumulates access counts.
+ *
+ * \param[in,out]   dst points to the counts to update.
+ *
+ * \param[in]       src points to the counts to add.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ProfileAddCounts(fm_regProfileCounts *      dst,
+                             const fm_regProfileCounts *src)
+{
+    dst->reads   += src->reads;
+    dst->writes  += src->writes;
+    dst->words   += src->words;
+    dst->samples += src->samples;
+    dst->cycles  += src->cycles;
+
+    if (src->maxCycles > dst->maxCycles)
+    {
+        dst->maxCycles = src->maxCycles;
+    }
+
+}   /* end ProfileAddCounts */
+
+
+
+
+/*****************************************************************************/
+/** ProfileHashStack
+ * \ingroup intDiagReg
+ *
+ * \desc            Hashes the return addresses of a call stack.
+ *
+ * \param[in]       frames points to the return addresses.
+ *
+ * \param[in]       numFrames is the number of return addresses.
+ *
+ * \return          The 64-bit FNV-1a hash of the return addresses.
+ *
+ *****************************************************************************/
+static fm_uint64 ProfileHashStack(void **frames, fm_int numFrames)
+{
+    fm_uint64 hash;
+    fm_int    i;
+
+    hash = FM_LITERAL_U64(0xcbf29ce484222325);
+
+    for (i = 0 ; i < numFrames ; i++)
+    {
+        hash ^= (fm_uint64) (fm_uintptr) frames[i];
+        hash *= FM_LITERAL_U64(0x100000001b3);
+    }
+
+    return hash;
+
+}   /* end ProfileHashStack */
+
+
+
+
+/*****************************************************************************/
+/** ProfileBegin
+ * \ingroup intDiagReg
+ *
+ * \desc            Called by the profiling functions before a register
+ *                  access. Decides whether the access is sampled and, if
+ *                  so, records the call stack and starts the clock.
+ *
+ * \param[in]       profile points to the profile of the switch.
+ *
+ * \param[out]      sample points to caller-allocated storage for the state
+ *                  of the access.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ProfileBegin(fm_regProfile *profile, fm_regProfileSample *sample)
+{
+    fm_uint32 count;
+    fm_int    period;
+
+    count  = FM_ATOMIC_ADD_RELAXED(&profile->accessCount, 1);
+    period = FM_ATOMIC_LOAD_RELAXED(&profile->samplePeriod);
+
+    sample->sampled   = ( (period > 0) && (count % period) == 0 );
+    sample->numFrames = 0;
+
+    if (!sample->sampled)
+    {
+        return;
+    }
+
+#ifdef __gnu_linux__
+    sample->numFrames = backtrace(sample->frames, REG_PROFILE_MAX_FRAMES);
+#endif
+
+    /* Read the clock last so the stack walk is not part of the latency */
+    sample->start = FM_GET_CYCLES();
+
+}   /* end ProfileBegin */
+
+
+
+
+/*****************************************************************************/
+/** ProfileEnd
+ * \ingroup intDiagReg
+ *
+ * \desc            Called by the profiling functions after a register
+ *                  access to account for it.
+ *
+ * \param[in]       profile points to the profile of the switch.
+ *
+ * \param[in]       sample points to the state filled in by ProfileBegin.
+ *
+ * \param[in]       addr is the first register address accessed.
+ *
+ * \param[in]       words is the number of 32-bit words transferred.
+ *
+ * \param[in]       isRead is TRUE if the access read the register.
+ *
+ * \param[in]       isWrite is TRUE if the access wrote the register.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ProfileEnd(fm_regProfile *      profile,
+                       fm_regProfileSample *sample,
+                       fm_uint              addr,
+                       fm_int               words,
+                       fm_bool              isRead,
+                       fm_bool              isWrite)
+{
+    fm_regProfileCounts counts;
+    fm_regProfileReg *  reg;
+    fm_regProfileStack *stack;
+    fm_uint64           key;
+    fm_status           err;
+
+    FM_CLEAR(counts);
+
+    if (sample->sampled)
+    {
+        counts.samples   = 1;
+        counts.cycles    = FM_GET_CYCLES() - sample->start;
+        counts.maxCycles = counts.cycles;
+    }
+
+    counts.reads  = isRead ? 1 : 0;
+    counts.writes = isWrite ? 1 : 0;
+    counts.words  = words;
+
+    fmCaptureLock(&profile->lock, FM_WAIT_FOREVER);
+
+    /* A racing access may still get here after the profile was stopped */
+    if (!profile->active)
+    {
+        goto ABORT;
+    }
+
+    err = fmHashMapFind(&profile->regs, addr, (void **) &reg);
+
+    if (err != FM_OK)
+    {
+        reg = fmAlloc( sizeof(fm_regProfileReg) );
+
+        if (reg == NULL)
+        {
+            goto ABORT;
+        }
+
+        FM_CLEAR(*reg);
+        reg->addr = addr;
+
+        if (fmHashMapInsert(&profile->regs, addr, reg) != FM_OK)
+        {
+            fmFree(reg);
+            goto ABORT;
+        }
+    }
+
+    ProfileAddCounts(&reg->counts, &counts);
+
+    if (!sample->sampled)
+    {
+        goto ABORT;
+    }
+
+    key = ProfileHashStack(sample->frames, sample->numFrames);
+    err = fmHashMapFind(&profile->stacks, key, (void **) &stack);
+
+    if (err != FM_OK)
+    {
+        stack = fmAlloc( sizeof(fm_regProfileStack) );
+
+        if (stack == NULL)
+        {
+            goto ABORT;
+        }
+
+        FM_CLEAR(*stack);
+        FM_MEMCPY_S( stack->frames,
+                     sizeof(stack->frames),
+                     sample->frames,
+                     sample->numFrames * sizeof(void *) );
+        stack->numFrames = sample->numFrames;
+
+        if (fmHashMapInsert(&profile->stacks, key, stack) != FM_OK)
+        {
+            fmFree(stack);
+            goto ABORT;
+        }
+    }
+
+    ProfileAddCounts(&stack->counts, &counts);
+
+ABORT:
+    fmReleaseLock(&profile->lock);
+
+}   /* end ProfileEnd */
+
+
+
+
+/*****************************************************************************/
+/** ProfileWriteUINT32
+ * \ingroup intDiagReg
+ *
+ * \desc            Profiling replacement for the WriteUINT32 switch
+ *                  function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[in]       value is the value to write.
+ *
+ * \return          The status of the saved WriteUINT32 function.
+ *
+ *****************************************************************************/
+static fm_status ProfileWriteUINT32(fm_int sw, fm_uint reg, fm_uint32 value)
+{
+    fm_regProfile *     profile = GET_SWITCH_PTR(sw)->regProfile;
+    fm_regProfileSample sample;
+    fm_status           err;
+
+    ProfileBegin(profile, &sample);
+    err = profile->WriteUINT32(sw, reg, value);
+    ProfileEnd(profile, &sample, reg, 1, FALSE, TRUE);
+
+    return err;
+
+}   /* end ProfileWriteUINT32 */
+
+
+
+
+/*****************************************************************************/
+/** ProfileReadUINT32
+ * \ingroup intDiagReg
+ *
+ * \desc            Profiling replacement for the ReadUINT32 switch function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function should place the register value.
+ *
+ * \return          The status of the saved ReadUINT32 function.
+ *
+ *****************************************************************************/
+static fm_status ProfileReadUINT32(fm_int sw, fm_uint reg, fm_uint32 *value)
+{
+    fm_regProfile *     profile = GET_SWITCH_PTR(sw)->regProfile;
+    fm_regProfileSample sample;
+    fm_status           err;
+
+    ProfileBegin(profile, &sample);
+    err = profile->ReadUINT32(sw, reg, value);
+    ProfileEnd(profile, &sample, reg, 1, TRUE, FALSE);
+
+    return err;
+
+}   /* end ProfileReadUINT32 */
+
+
+
+
+/*****************************************************************************/
+/** ProfileMaskUINT32
+ * \ingroup intDiagReg
+ *
+ * \desc            Profiling replacement for the MaskUINT32 switch function.
+ *                  The access is counted both as a read and as a write.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[in]       mask is the mask of the bits to set or clear.
+ *
+ * \param[in]       on is TRUE to set the bits, FALSE to clear them.
+ *
+ * \return          The status of the saved MaskUINT32 function.
+ *
+ *****************************************************************************/
+static fm_status ProfileMaskUINT32(fm_int    sw,
+                                   fm_uint   reg,
+                                   fm_uint32 mask,
+                                   fm_bool   on)
+{
+    fm_regProfile *     profile = GET_SWITCH_PTR(sw)->regProfile;
+    fm_regProfileSample sample;
+    fm_status           err;
+
+    ProfileBegin(profile, &sample);
+    err = profile->MaskUINT32(sw, reg, mask, on);
+    ProfileEnd(profile, &sample, reg, 1, TRUE, TRUE);
+
+    return err;
+
+}   /* end ProfileMaskUINT32 */
+
+
+
+
+/*****************************************************************************/
+/** ProfileWriteUINT32Mult
+ * \ingroup intDiagReg
+ *
+ * \desc            Profiling replacement for the WriteUINT32Mult switch
+ *                  function. The access is accounted to its first address.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the first register address.
+ *
+ * \param[in]       count is the number of words to write.
+ *
+ * \param[in]       ptr points to the values to write.
+ *
+ * \return          The status of the saved WriteUINT32Mult function.
+ *
+ *****************************************************************************/
+static fm_status ProfileWriteUINT32Mult(fm_int     sw,
+                                        fm_uint    reg,
+                                        fm_int     count,
+                                        fm_uint32 *ptr)
+{
+    fm_regProfile *     profile = GET_SWITCH_PTR(sw)->regProfile;
+    fm_regProfileSample sample;
+    fm_status           err;
+
+    ProfileBegin(profile, &sample);
+    err = profile->WriteUINT32Mult(sw, reg, count, ptr);
+    ProfileEnd(profile, &sample, reg, count, FALSE, TRUE);
+
+    return err;
+
+}   /* end ProfileWriteUINT32Mult */
+
+
+
+
+/*****************************************************************************/
+/** ProfileReadUINT32Mult
+ * \ingroup intDiagReg
+ *
+ * \desc            Profiling replacement for the ReadUINT32Mult switch
+ *                  function. The access is accounted to its first address.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the first register address.
+ *
+ * \param[in]       count is the number of words to read.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function should place the register values.
+ *
+ * \return          The status of the saved ReadUINT32Mult function.
+ *
+ *****************************************************************************/
+static fm_status ProfileReadUINT32Mult(fm_int     sw,
+                                       fm_uint    reg,
+                                       fm_int     count,
+                                       fm_uint32 *value)
+{
+    fm_regProfile *     profile = GET_SWITCH_PTR(sw)->regProfile;
+    fm_regProfileSample sample;
+    fm_status           err;
+
+    ProfileBegin(profile, &sample);
+    err = profile->ReadUINT32Mult(sw, reg, count, value);
+    ProfileEnd(profile, &sample, reg, count, TRUE, FALSE);
+
+    return err;
+
+}   /* end ProfileReadUINT32Mult */
+
+
+
+
+/*****************************************************************************/
+/** ProfileWriteUINT64
+ * \ingroup intDiagReg
+ *
+ * \desc            Profiling replacement for the WriteUINT64 switch
+ *                  function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[in]       value is the value to write.
+ *
+ * \return          The status of the saved WriteUINT64 function.
+ *
+ *****************************************************************************/
+static fm_status ProfileWriteUINT64(fm_int sw, fm_uint reg, fm_uint64 value)
+{
+    fm_regProfile *     profile = GET_SWITCH_PTR(sw)->regProfile;
+    fm_regProfileSample sample;
+    fm_status           err;
+
+    ProfileBegin(profile, &sample);
+    err = profile->WriteUINT64(sw, reg, value);
+    ProfileEnd(profile, &sample, reg, 2, FALSE, TRUE);
+
+    return err;
+
+}   /* end ProfileWriteUINT64 */
+
+
+
+
+/*****************************************************************************/
+/** ProfileReadUINT64
+ * \ingroup intDiagReg
+ *
+ * \desc            Profiling replacement for the ReadUINT64 switch function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function should place the register value.
+ *
+ * \return          The status of the saved ReadUINT64 function.
+ *
+ *****************************************************************************/
+static fm_status ProfileReadUINT64(fm_int sw, fm_uint reg, fm_uint64 *value)
+{
+    fm_regProfile *     profile = GET_SWITCH_PTR(sw)->regProfile;
+    fm_regProfileSample sample;
+    fm_status           err;
+
+    ProfileBegin(profile, &sample);
+    err = profile->ReadUINT64(sw, reg, value);
+    ProfileEnd(profile, &sample, reg, 2, TRUE, FALSE);
+
+    return err;
+
+}   /* end ProfileReadUINT64 */
+
+
+
+
+/*****************************************************************************/
+/** ProfileWriteUINT64Mult
+ * \ingroup intDiagReg
+ *
+ * \desc            Profiling replacement for the WriteUINT64Mult switch
+ *                  function. The access is accounted to its first address.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the first register address.
+ *
+ * \param[in]       count is the number of 64-bit values to write.
+ *
+ * \param[in]       ptr points to the values to write.
+ *
+ * \return          The status of the saved WriteUINT64Mult function.
+ *
+ *****************************************************************************/
+static fm_status ProfileWriteUINT64Mult(fm_int     sw,
+                                        fm_uint    reg,
+                                        fm_int     count,
+                                        fm_uint64 *ptr)
+{
+    fm_regProfile *     profile = GET_SWITCH_PTR(sw)->regProfile;
+    fm_regProfileSample sample;
+    fm_status           err;
+
+    ProfileBegin(profile, &sample);
+    err = profile->WriteUINT64Mult(sw, reg, count, ptr);
+    ProfileEnd(profile, &sample, reg, count * 2, FALSE, TRUE);
+
+    return err;
+
+}   /* end ProfileWriteUINT64Mult */
+
+
+
+
+/*****************************************************************************/
+/** ProfileReadUINT64Mult
+ * \ingroup intDiagReg
+ *
+ * \desc            Profiling replacement for the ReadUINT64Mult switch
+ *                  function. The access is accounted to its first address.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the first register address.
+ *
+ * \param[in]       count is the number of 64-bit values to read.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function should place the register values.
+ *
+ * \return          The status of the saved ReadUINT64Mult function.
+ *
+ *****************************************************************************/
+static fm_status ProfileReadUINT64Mult(fm_int     sw,
+                                       fm_uint    reg,
+                                       fm_int     count,
+                                       fm_uint64 *value)
+{
+    fm_regProfile *     profile = GET_SWITCH_PTR(sw)->regProfile;
+    fm_regProfileSample sample;
+    fm_status           err;
+
+    ProfileBegin(profile, &sample);
+    err = profile->ReadUINT64Mult(sw, reg, count, value);
+    ProfileEnd(profile, &sample, reg, count * 2, TRUE, FALSE);
+
+    return err;
+
+}   /* end ProfileReadUINT64Mult */
+
+
+
+
+/*****************************************************************************/
+/** ProfileIsInstalled
+ * \ingroup intDiagReg
+ *
+ * \desc            Determines whether the profiling functions are still the
+ *                  ones installed in the switch function table, i.e. no
+ *                  other layer was stacked on top of them.
+ *
+ * \param[in]       switchPtr points to the switch state structure.
+ *
+ * \return          TRUE if the profiling functions are installed.
+ *
+ *****************************************************************************/
+static fm_bool ProfileIsInstalled(fm_switch *switchPtr)
+{
+    return ( (switchPtr->WriteUINT32     == ProfileWriteUINT32)     &&
+             (switchPtr->ReadUINT32      == ProfileReadUINT32)      &&
+             (switchPtr->MaskUINT32      == ProfileMaskUINT32)      &&
+             (switchPtr->WriteUINT32Mult == ProfileWriteUINT32Mult) &&
+             (switchPtr->ReadUINT32Mult  == ProfileReadUINT32Mult)  &&
+             (switchPtr->WriteUINT64     == ProfileWriteUINT64)     &&
+             (switchPtr->ReadUINT64      == ProfileReadUINT64)      &&
+             (switchPtr->WriteUINT64Mult == ProfileWriteUINT64Mult) &&
+             (switchPtr->ReadUINT64Mult  == ProfileReadUINT64Mult) );
+
+}   /* end ProfileIsInstalled */
+
+
+
+
+/*****************************************************************************/
+/** ProfileUninstall
+ * \ingroup intDiagReg
+ *
+ * \desc            Restores the register access functions saved when the
+ *                  profile was started. The saved functions are left in
+ *                  the profile for accesses racing with the restore.
+ *                  Must be called with the register lock taken.
+ *
+ * \param[in]       switchPtr points to the switch state structure.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ProfileUninstall(fm_switch *switchPtr)
+{
+    fm_regProfile *profile = switchPtr->regProfile;
+
+    switchPtr->WriteUINT32     = profile->WriteUINT32;
+    switchPtr->ReadUINT32      = profile->ReadUINT32;
+    switchPtr->MaskUINT32      = profile->MaskUINT32;
+    switchPtr->WriteUINT32Mult = profile->WriteUINT32Mult;
+    switchPtr->ReadUINT32Mult  = profile->ReadUINT32Mult;
+    switchPtr->WriteUINT64     = profile->WriteUINT64;
+    switchPtr->ReadUINT64      = profile->ReadUINT64;
+    switchPtr->WriteUINT64Mult = profile->WriteUINT64Mult;
+    switchPtr->ReadUINT64Mult  = profile->ReadUINT64Mult;
+
+    fmCaptureLock(&profile->lock, FM_WAIT_FOREVER);
+    profile->active = FALSE;
+    fmReleaseLock(&profile->lock);
+
+}   /* end ProfileUninstall */
+
+
+
+
+/*****************************************************************************/
+/** ProfileCompareLines
+ * \ingroup intDiagReg
+ *
+ * \desc            qsort comparison function ranking dump lines by
+ *                  decreasing number of accesses, then by decreasing
+ *                  sampled latency.
+ *
+ * \param[in]       a points to the first line.
+ *
+ * \param[in]       b points to the second line.
+ *
+ * \return          Negative if a ranks before b, positive if after, zero
+ *                  if they rank the same.
+ *
+ *****************************************************************************/
+static int ProfileCompareLines(const void *a, const void *b)
+{
+    const fm_regProfileCounts *ca = &( (const fm_regProfileLine *) a )->counts;
+    const fm_regProfileCounts *cb = &( (const fm_regProfileLine *) b )->counts;
+    fm_uint64                  na = ca->reads + ca->writes;
+    fm_uint64                  nb = cb->reads + cb->writes;
+
+    if (na != nb)
+    {
+        return (na > nb) ? -1 : 1;
+    }
+
+    if (ca->cycles != cb->cycles)
+    {
+        return (ca->cycles > cb->cycles) ? -1 : 1;
+    }
+
+    return 0;
+
+}   /* end ProfileCompareLines */
+
+
+
+
+/*****************************************************************************/
+/** ProfileCompareRegIds
+ * \ingroup intDiagReg
+ *
+ * \desc            qsort comparison function ordering dump lines by
+ *                  register table index.
+ *
+ * \param[in]       a points to the first line.
+ *
+ * \param[in]       b points to the second line.
+ *
+ * \return          Negative if a comes before b, positive if after, zero
+ *                  if they belong to the same register block.
+ *
+ *****************************************************************************/
+static int ProfileCompareRegIds(const void *a, const void *b)
+{
+    fm_int ia = ( (const fm_regProfileLine *) a )->regId;
+    fm_int ib = ( (const fm_regProfileLine *) b )->regId;
+
+    return (ia > ib) - (ia < ib);
+
+}   /* end ProfileCompareRegIds */
+
+
+
+
+/*****************************************************************************/
+/** ProfileCompareNames
+ * \ingroup intDiagReg
+ *
+ * \desc            qsort comparison function ordering dump lines by name.
+ *
+ * \param[in]       a points to the first line.
+ *
+ * \param[in]       b points to the second line.
+ *
+ * \return          The result of comparing the line names.
+ *
+ *****************************************************************************/
+static int ProfileCompareNames(const void *a, const void *b)
+{
+    return strcmp( ( (const fm_regProfileLine *) a )->name,
+                   ( (const fm_regProfileLine *) b )->name );
+
+}   /* end ProfileCompareNames */
+
+
+
+
+/*****************************************************************************/
+/** ProfileGetCallerName
+ * \ingroup intDiagReg
+ *
+ * \desc            Names the caller a sampled call stack is attributed to:
+ *                  the first frame with a symbol that does not belong to
+ *                  the register access layers.
+ *
+ * \param[in]       line points to the dump line holding the sampled call
+ *                  stack.
+ *
+ * \param[out]      name points to caller-allocated storage where this
+ *                  function will write the caller name.
+ *
+ * \param[in]       nameLength is the length of name.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ProfileGetCallerName(fm_regProfileLine *line,
+                                 fm_text            name,
+                                 fm_int             nameLength)
+{
+#ifdef __gnu_linux__
+    char **   symbols;
+    char *    first;
+    char *    last;
+    fm_int    i;
+    fm_int    j;
+    fm_bool   skip;
+
+    fmStringCopy(name, "<unknown>", nameLength);
+
+    symbols = backtrace_symbols(line->frames, line->numFrames);
+
+    if (symbols == NULL)
+    {
+        return;
+    }
+
+    for (i = 0 ; i < line->numFrames ; i++)
+    {
+        /* Symbols look like "object(function+0x12) [0x4567]" */
+        first = strchr(symbols[i], '(');
+        last  = (first != NULL) ? strpbrk(first, "+)") : NULL;
+
+        if ( (first == NULL) || (last == NULL) || (last == first + 1) )
+        {
+            /* Static functions have no symbol */
+            continue;
+        }
+
+        *last = '\0';
+        first++;
+
+        skip = FALSE;
+
+        for (j = 0 ; profileSkipPrefixes[j] != NULL ; j++)
+        {
+            if ( strncmp( first,
+                          profileSkipPrefixes[j],
+                          strlen(profileSkipPrefixes[j]) ) == 0 )
+            {
+                skip = TRUE;
+                break;
+            }
+        }
+
+        if (!skip)
+        {
+            fmStringCopy(name, first, nameLength);
+            break;
+        }
+    }
+
+    /**************************************************
+     * We use free instead of fm_free, because symbols
+     * was allocated with malloc by backtrace_symbols.
+     **************************************************/
+
+    free(symbols);
+#else
+    FM_NOT_USED(line);
+
+    fmStringCopy(name, "<unknown>", nameLength);
+#endif
+
+}   /* end ProfileGetCallerName */
+
+
+
+
+/*****************************************************************************/
+/** ProfileSnapshot
+ * \ingroup intDiagReg
+ *
+ * \desc            Copies the entries of one of the profile maps into an
+ *                  array of dump lines, so they can be sorted and printed
+ *                  without holding the profile lock.
+ *
+ * \param[in]       profile points to the profile.
+ *
+ * \param[in]       map points to the profile map to copy.
+ *
+ * \param[in]       isStacks is TRUE if map is the call stack map.
+ *
+ * \param[out]      linesPtr points to caller-allocated storage where this
+ *                  function will place the array, to be freed with fmFree.
+ *
+ * \param[out]      numLinesPtr points to caller-allocated storage where
+ *                  this function will place the number of lines.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if the array could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status ProfileSnapshot(fm_regProfile *     profile,
+                                 fm_hashMap *        map,
+                                 fm_bool             isStacks,
+                                 fm_regProfileLine **linesPtr,
+                                 fm_int *            numLinesPtr)
+{
+    fm_hashMapIterator  it;
+    fm_regProfileLine * lines;
+    fm_regProfileReg *  reg;
+    fm_regProfileStack *stack;
+    fm_uint64           key;
+    void *              value;
+    fm_status           err;
+    fm_int              numLines;
+
+    err      = FM_OK;
+    numLines = 0;
+
+    fmCaptureLock(&profile->lock, FM_WAIT_FOREVER);
+
+    lines = fmAlloc( (fmHashMapSize(map) + 1) * sizeof(fm_regProfileLine) );
+
+    if (lines == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    fmHashMapIterInit(&it, map);
+
+    while (fmHashMapIterNext(&it, &key, &value) == FM_OK)
+    {
+        FM_CLEAR(lines[numLines]);
+        lines[numLines].regId = -1;
+
+        if (isStacks)
+        {
+            stack = value;
+            lines[numLines].counts = stack->counts;
+
+            /* The caller is named once the lock is dropped */
+            FM_MEMCPY_S( lines[numLines].frames,
+                         sizeof(lines[numLines].frames),
+                         stack->frames,
+                         stack->numFrames * sizeof(void *) );
+            lines[numLines].numFrames = stack->numFrames;
+        }
+        else
+        {
+            reg = value;
+            lines[numLines].addr   = reg->addr;
+            lines[numLines].counts = reg->counts;
+        }
+
+        numLines++;
+    }
+
+ABORT:
+    fmReleaseLock(&profile->lock);
+
+    *linesPtr    = lines;
+    *numLinesPtr = numLines;
+
+    return err;
+
+}   /* end ProfileSnapshot */
+
+
+
+
+/*****************************************************************************/
+/** ProfilePrintLine
+ * \ingroup intDiagReg
+ *
+ * \desc            Prints the counts of a dump line.
+ *
+ * \param[in]       label is the text of the first column.
+ *
+ * \param[in]       counts points to the counts to print.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ProfilePrintLine(fm_text label, fm_regProfileCounts *counts)
+{
+    fm_uint64 avgNsec;
+
+    avgNsec = (counts->samples > 0)
+              ? fmCyclesToNsec(counts->cycles / counts->samples)
+              : 0;
+
+    FM_LOG_PRINT("%-40s %12" FM_FORMAT_64 "u %12" FM_FORMAT_64 "u "
+                 "%12" FM_FORMAT_64 "u %8" FM_FORMAT_64 "u "
+                 "%8" FM_FORMAT_64 "u\n",
+                 label,
+                 counts->reads,
+                 counts->writes,
+                 counts->words,
+                 avgNsec,
+                 fmCyclesToNsec(counts->maxCycles));
+
+}   /* end ProfilePrintLine */
+
+
+
+
+/*****************************************************************************/
+/** ProfilePrintHeader
+ * \ingroup intDiagReg
+ *
+ * \desc            Prints the header of a dump table.
+ *
+ * \param[in]       title is the title of the table.
+ *
+ * \param[in]       label is the heading of the first column.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ProfilePrintHeader(fm_text title, fm_text label)
+{
+    FM_LOG_PRINT("\n%s\n", title);
+    FM_LOG_PRINT("%-40s %12s %12s %12s %8s %8s\n",
+                 label,
+                 "Reads",
+                 "Writes",
+                 "Words",
+                 "AvgNs",
+                 "MaxNs");
+    FM_LOG_PRINT("---------------------------------------- ------------ "
+                 "------------ ------------ -------- --------\n");
+
+}   /* end ProfilePrintHeader */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fmDbgStartRegProfile
+ * \ingroup diagReg
+ *
+ * \chips           FM10000
+ *
+ * \desc            Starts profiling the register accesses of a switch.
+ *                  Every access is counted against its register address,
+ *                  and one access out of samplePeriod is also timed and
+ *                  its call stack recorded, so it can be attributed to the
+ *                  API function that made it. Counts accumulate across
+ *                  successive profiling sessions until
+ *                  ''fmDbgResetRegProfile'' is called.
+ *                                                                      \lb\lb
+ *                  The profile interposes on the register access functions
+ *                  of the switch and must not be started or stopped while
+ *                  a register write batch is open.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       samplePeriod is the number of accesses per sampled
+ *                  access. 1 samples every access.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if samplePeriod is not positive.
+ * \return          FM_ERR_INVALID_STATE if a register write batch is open
+ *                  on the switch.
+ * \return          FM_ERR_NO_MEM if the profile could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmDbgStartRegProfile(fm_int sw, fm_int samplePeriod)
+{
+    fm_switch *    switchPtr;
+    fm_regProfile *profile;
+    fm_status      err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_DEBUG, "sw=%d samplePeriod=%d\n", sw, samplePeriod);
+
+    if (samplePeriod <= 0)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    err       = FM_OK;
+
+    TAKE_REG_LOCK(sw);
+
+    if (switchPtr->regBatch.owner != NULL)
+    {
+        err = FM_ERR_INVALID_STATE;
+        goto ABORT;
+    }
+
+    profile = switchPtr->regProfile;
+
+    if (profile == NULL)
+    {
+        profile = fmAlloc( sizeof(fm_regProfile) );
+
+        if (profile == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            goto ABORT;
+        }
+
+        FM_CLEAR(*profile);
+
+        err = fmCreateLockV2("regProfileLock",
+                             sw,
+                             FM_LOCK_SUPER_PRECEDENCE,
+                             &profile->lock);
+
+        if (err != FM_OK)
+        {
+            fmFree(profile);
+            goto ABORT;
+        }
+
+        fmHashMapInit(&profile->regs);
+        fmHashMapInit(&profile->stacks);
+
+        switchPtr->regProfile = profile;
+    }
+
+    FM_ATOMIC_STORE_RELAXED(&profile->samplePeriod, samplePeriod);
+
+    if (!profile->active)
+    {
+        profile->WriteUINT32     = switchPtr->WriteUINT32;
+        profile->ReadUINT32      = switchPtr->ReadUINT32;
+        profile->MaskUINT32      = switchPtr->MaskUINT32;
+        profile->WriteUINT32Mult = switchPtr->WriteUINT32Mult;
+        profile->ReadUINT32Mult  = switchPtr->ReadUINT32Mult;
+        profile->WriteUINT64     = switchPtr->WriteUINT64;
+        profile->ReadUINT64      = switchPtr->ReadUINT64;
+        profile->WriteUINT64Mult = switchPtr->WriteUINT64Mult;
+        profile->ReadUINT64Mult  = switchPtr->ReadUINT64Mult;
+
+        fmCaptureLock(&profile->lock, FM_WAIT_FOREVER);
+        profile->active = TRUE;
+        fmReleaseLock(&profile->lock);
+
+        switchPtr->WriteUINT32     = ProfileWriteUINT32;
+        switchPtr->ReadUINT32      = ProfileReadUINT32;
+        switchPtr->MaskUINT32      = ProfileMaskUINT32;
+        switchPtr->WriteUINT32Mult = ProfileWriteUINT32Mult;
+        switchPtr->ReadUINT32Mult  = ProfileReadUINT32Mult;
+        switchPtr->WriteUINT64     = ProfileWriteUINT64;
+        switchPtr->ReadUINT64      = ProfileReadUINT64;
+        switchPtr->WriteUINT64Mult = ProfileWriteUINT64Mult;
+        switchPtr->ReadUINT64Mult  = ProfileReadUINT64Mult;
+    }
+
+ABORT:
+    DROP_REG_LOCK(sw);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_DEBUG, err);
+
+}   /* end fmDbgStartRegProfile */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgStopRegProfile
+ * \ingroup diagReg
+ *
+ * \chips           FM10000
+ *
+ * \desc            Stops profiling the register accesses of a switch. The
+ *                  counts are kept and can still be displayed with
+ *                  ''fmDbgDumpRegProfile''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_STATE if a register write batch is open
+ *                  on the switch, or if other functions have been
+ *                  installed over the profiling ones since the profile
+ *                  was started.
+ *
+ *****************************************************************************/
+fm_status fmDbgStopRegProfile(fm_int sw)
+{
+    fm_switch *    switchPtr;
+    fm_regProfile *profile;
+    fm_status      err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_DEBUG, "sw=%d\n", sw);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    profile   = switchPtr->regProfile;
+    err       = FM_OK;
+
+    TAKE_REG_LOCK(sw);
+
+    if ( (profile == NULL) || !profile->active )
+    {
+        goto ABORT;
+    }
+
+    if ( (switchPtr->regBatch.owner != NULL) ||
+         !ProfileIsInstalled(switchPtr) )
+    {
+        err = FM_ERR_INVALID_STATE;
+        goto ABORT;
+    }
+
+    ProfileUninstall(switchPtr);
+
+ABORT:
+    DROP_REG_LOCK(sw);
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_DEBUG, err);
+
+}   /* end fmDbgStopRegProfile */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgDumpRegProfile
+ * \ingroup diagReg
+ *
+ * \chips           FM10000
+ *
+ * \desc            Displays the register access profile of a switch: the
+ *                  hottest register blocks of the register table, the
+ *                  hottest individual registers, and the functions that
+ *                  made the most sampled accesses. Latencies are measured
+ *                  on the sampled accesses only.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       maxEntries is the maximum number of entries to display
+ *                  in each table, or 0 for a default of 20.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_STATE if the profile was never started.
+ * \return          FM_ERR_NO_MEM if there was not enough memory to sort
+ *                  the profile.
+ *
+ *****************************************************************************/
+fm_status fmDbgDumpRegProfile(fm_int sw, fm_int maxEntries)
+{
+    fm_switch *         switchPtr;
+    fm_regProfile *     profile;
+    fm_regProfileLine * regs;
+    fm_regProfileLine * callers;
+    fm_regProfileLine * blocks;
+    fm_regProfileCounts total;
+    fm_status           err;
+    fm_int              numRegs;
+    fm_int              numCallers;
+    fm_int              numBlocks;
+    fm_int              i;
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    profile   = switchPtr->regProfile;
+    regs      = NULL;
+    callers   = NULL;
+    blocks    = NULL;
+
+    if (profile == NULL)
+    {
+        err = FM_ERR_INVALID_STATE;
+        goto ABORT;
+    }
+
+    if (maxEntries <= 0)
+    {
+        maxEntries = REG_PROFILE_DEFAULT_ENTRIES;
+    }
+
+    err = ProfileSnapshot(profile, &profile->regs, FALSE, &regs, &numRegs);
+
+    if (err != FM_OK)
+    {
+        goto ABORT;
+    }
+
+    err = ProfileSnapshot(profile,
+                          &profile->stacks,
+                          TRUE,
+                          &callers,
+                          &numCallers);
+
+    if (err != FM_OK)
+    {
+        goto ABORT;
+    }
+
+    for (i = 0 ; i < numCallers ; i++)
+    {
+        ProfileGetCallerName(&callers[i],
+                             callers[i].name,
+                             REG_PROFILE_NAME_LENGTH);
+    }
+
+    blocks = fmAlloc( (numRegs + 1) * sizeof(fm_regProfileLine) );
+
+    if (blocks == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    FM_CLEAR(total);
+
+    /**************************************************
+     * Map each address to its register block and fold
+     * the addresses of each block together.
+     **************************************************/
+
+    for (i = 0 ; i < numRegs ; i++)
+    {
+        ProfileAddCounts(&total, &regs[i].counts);
+
+        err = FM_ERR_UNSUPPORTED;
+        FM_API_CALL_FAMILY(err,
+                           switchPtr->DbgGetRegisterId,
+                           sw,
+                           regs[i].addr,
+                           &regs[i].regId);
+
+        if (err != FM_OK)
+        {
+            regs[i].regId = -1;
+            FM_SNPRINTF_S(regs[i].name,
+                          REG_PROFILE_NAME_LENGTH,
+                          "0x%08x",
+                          regs[i].addr);
+        }
+        else
+        {
+            fmDbgGetRegisterName(sw,
+                                 regs[i].regId,
+                                 regs[i].addr,
+                                 regs[i].name,
+                                 REG_PROFILE_NAME_LENGTH,
+                                 NULL,
+                                 NULL,
+                                 NULL,
+                                 NULL,
+                                 FALSE,
+                                 TRUE);
+        }
+    }
+
+    err = FM_OK;
+
+    qsort(regs, numRegs, sizeof(fm_regProfileLine), ProfileCompareRegIds);
+
+    numBlocks = 0;
+
+    for (i = 0 ; i < numRegs ; i++)
+    {
+        if ( (numBlocks == 0) || (blocks[numBlocks - 1].regId != regs[i].regId) )
+        {
+            FM_CLEAR(blocks[numBlocks]);
+            blocks[numBlocks].regId = regs[i].regId;
+
+            if (regs[i].regId < 0)
+            {
+                fmStringCopy(blocks[numBlocks].name,
+                             "<unlisted>",
+                             REG_PROFILE_NAME_LENGTH);
+            }
+            else
+            {
+                /* The block name is the register name without indices */
+                fmDbgGetRegisterName(sw,
+                                     regs[i].regId,
+                                     regs[i].addr,
+                                     blocks[numBlocks].name,
+                                     REG_PROFILE_NAME_LENGTH,
+                                     NULL,
+                                     NULL,
+                                     NULL,
+                                     NULL,
+                                     FALSE,
+                                     FALSE);
+                blocks[numBlocks].name[strcspn(blocks[numBlocks].name,
+                                               "[")] = '\0';
+            }
+
+            numBlocks++;
+        }
+
+        ProfileAddCounts(&blocks[numBlocks - 1].counts, &regs[i].counts);
+    }
+
+    /**************************************************
+     * Fold the call stacks attributed to the same
+     * caller together.
+     **************************************************/
+
+    qsort(callers, numCallers, sizeof(fm_regProfileLine), ProfileCompareNames);
+
+    for (i = 1 ; i < numCallers ; i++)
+    {
+        if (strcmp(callers[i].name, callers[i - 1].name) == 0)
+        {
+            ProfileAddCounts(&callers[i].counts, &callers[i - 1].counts);
+            FM_CLEAR(callers[i - 1].counts);
+        }
+    }
+
+    qsort(blocks, numBlocks, sizeof(fm_regProfileLine), ProfileCompareLines);
+    qsort(regs, numRegs, sizeof(fm_regProfileLine), ProfileCompareLines);
+    qsort(callers, numCallers, sizeof(fm_regProfileLine), ProfileCompareLines);
+
+    FM_LOG_PRINT("Register access profile of switch %d: %s, "
+                 "1 access in %d sampled\n",
+                 sw,
+                 profile->active ? "running" : "stopped",
+                 FM_ATOMIC_LOAD_RELAXED(&profile->samplePeriod));
+
+    ProfilePrintHeader("Summary:", "");
+    ProfilePrintLine("All registers", &total);
+
+    ProfilePrintHeader("Hottest register blocks:", "Block");
+
+    for (i = 0 ; (i < numBlocks) && (i < maxEntries) ; i++)
+    {
+        ProfilePrintLine(blocks[i].name, &blocks[i].counts);
+    }
+
+    ProfilePrintHeader("Hottest registers:", "Register");
+
+    for (i = 0 ; (i < numRegs) && (i < maxEntries) ; i++)
+    {
+        ProfilePrintLine(regs[i].name, &regs[i].counts);
+    }
+
+    /* Only sampled accesses are attributed to a caller */
+    ProfilePrintHeader("Hottest callers (sampled accesses):", "Caller");
+
+    for (i = 0 ; (i < numCallers) && (i < maxEntries) ; i++)
+    {
+        if (callers[i].counts.samples == 0)
+        {
+            break;
+        }
+
+        ProfilePrintLine(callers[i].name, &callers[i].counts);
+    }
+
+ABORT:
+    if (regs != NULL)
+    {
+        fmFree(regs);
+    }
+
+    if (callers != NULL)
+    {
+        fmFree(callers);
+    }
+
+    if (blocks != NULL)
+    {
+        fmFree(blocks);
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    return err;
+
+}   /* end fmDbgDumpRegProfile */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgResetRegProfile
+ * \ingroup diagReg
+ *
+ * \chips           FM10000
+ *
+ * \desc            Clears the register access profile of a switch. A
+ *                  running profile keeps running.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ *
+ *****************************************************************************/
+fm_status fmDbgResetRegProfile(fm_int sw)
+{
+    fm_regProfile *profile;
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    profile = GET_SWITCH_PTR(sw)->regProfile;
+
+    if (profile != NULL)
+    {
+        fmCaptureLock(&profile->lock, FM_WAIT_FOREVER);
+
+        fmHashMapDestroy(&profile->regs, ProfileFreeEntry);
+        fmHashMapDestroy(&profile->stacks, ProfileFreeEntry);
+        fmHashMapInit(&profile->regs);
+        fmHashMapInit(&profile->stacks);
+
+        FM_ATOMIC_STORE_RELAXED(&profile->accessCount, 0);
+
+        fmReleaseLock(&profile->lock);
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    return FM_OK;
+
+}   /* end fmDbgResetRegProfile */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgFreeRegProfile
+ * \ingroup intDiagReg
+ *
+ * \desc            Frees the register access profile of a switch that is
+ *                  being removed, restoring the register access functions
+ *                  first if the profile is still running.
+ *                                                                      \lb\lb
+ *                  It is assumed that any protection required for
+ *                  performing this operation has already been done.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmDbgFreeRegProfile(fm_int sw)
+{
+    fm_switch *    switchPtr;
+    fm_regProfile *profile;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    profile   = switchPtr->regProfile;
+
+    if (profile == NULL)
+    {
+        return;
+    }
+
+    if ( profile->active && ProfileIsInstalled(switchPtr) )
+    {
+        ProfileUninstall(switchPtr);
+    }
+
+    fmHashMapDestroy(&profile->regs, ProfileFreeEntry);
+    fmHashMapDestroy(&profile->stacks, ProfileFreeEntry);
+    fmDeleteLock(&profile->lock);
+    fmFree(profile);
+
+    switchPtr->regProfile = NULL;
+
+}   /* end fmDbgFreeRegProfile */
@@ -604,6 +604,65 @@ fm_status fmDbgDumpRegisterV3(fm_int  sw,
 
 
 
+/*****************************************************************************/
+/** fmDbgStreamRegisters
+ * \ingroup diagReg
+ *
+ * \chips           FM10000
+ *
+ * \desc            Write the contents of a register, a group of registers
+ *                  or of all registers to a file. Unlike
+ *                  ''fmDbgDumpRegisterV3'', tables are read in bulk and
+ *                  the output bypasses the logging system, so that full
+ *                  tables such as the MAC table or the FFU can be captured
+ *                  quickly for support.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regName is the name of the register or group of
+ *                  registers to be written, matched as in
+ *                  ''fmDbgDumpRegisterV3''. NULL or an empty string selects
+ *                  all registers.
+ *
+ * \param[in]       fileName is the name of the file to create.
+ *
+ * \param[in]       format is the output format (see
+ *                  ''fm_dbgRegStreamFormat'').
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if fileName or format is invalid.
+ * \return          FM_ERR_UNKNOWN_REGISTER if regName is not recognized.
+ * \return          FM_FAIL if the file could not be written.
+ *
+ *****************************************************************************/
+fm_status fmDbgStreamRegisters(fm_int                sw,
+                               fm_text               regName,
+                               fm_text               fileName,
+                               fm_dbgRegStreamFormat format)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_API_CALL_FAMILY(err,
+                       switchPtr->DbgStreamRegisters,
+                       sw,
+                       regName,
+                       fileName,
+                       format);
+
+    UNPROTECT_SWITCH(sw);
+    return err;
+
+}   /* end fmDbgStreamRegisters */
+
+
+
+
 /*****************************************************************************/
 /** fmDbgWriteRegister
  * \ingroup diagReg 
@@ -0,0 +1,1406 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_debug_route_bench.c
+ * Creation Date:   October 15, 2026
+ * Description:     Route and next-hop programming benchmark.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* Maximum number of ECMP groups the routes are spread over */
+#define ROUTE_BENCH_MAX_ECMP_GROUPS     64
+
+/* Number of next-hops in each ECMP group */
+#define ROUTE_BENCH_HOPS_PER_GROUP      2
+
+/* Operations timed by the benchmark */
+typedef enum
+{
+    ROUTE_BENCH_OP_CREATE_VR = 0,
+    ROUTE_BENCH_OP_CREATE_ECMP,
+    ROUTE_BENCH_OP_ADD_ROUTE,
+    ROUTE_BENCH_OP_REPLACE_ECMP,
+    ROUTE_BENCH_OP_DELETE_ROUTE,
+    ROUTE_BENCH_OP_DELETE_ECMP,
+    ROUTE_BENCH_OP_DELETE_VR,
+    ROUTE_BENCH_OP_MAX
+
+} fm_routeBenchOp;
+
+
+/* Measurements of one operation */
+typedef struct
+{
+    /* Latency of each successful call, in nanoseconds */
+    fm_uint64 * latency;
+    fm_int      count;
+    fm_int      failures;
+
+    /* Number of 32-bit register words written and of routing TCAM moves
+     * made by the successful calls */
+    fm_uint64   regWrites;
+    fm_uint64   moves;
+
+} fm_routeBenchStats;
+
+
+/* State of a benchmark run, see fmDbgRouteBenchmark */
+typedef struct
+{
+    fm_int              sw;
+
+    /* TRUE if register accesses are absorbed by stubRegs instead of
+     * reaching the switch */
+    fm_bool             stubRegisters;
+
+    /* Maps a register address to the last value written by a stub */
+    fm_hashMap          stubRegs;
+
+    /* Number of 32-bit register words written so far */
+    fm_uint64           regWrites;
+
+    /* State of the prefix generator */
+    fm_uint32           randState;
+
+    fm_routeBenchStats  stats[ROUTE_BENCH_OP_MAX];
+
+    /* Register access functions of the switch, saved while the benchmark
+     * functions are installed in their place */
+    fm_status (*WriteUINT32)(fm_int sw, fm_uint reg, fm_uint32 value);
+    fm_status (*ReadUINT32)(fm_int sw, fm_uint reg, fm_uint32 *value);
+    fm_status (*MaskUINT32)(fm_int    sw,
+                            fm_uint   reg,
+                            fm_uint32 mask,
+                            fm_bool   on);
+    fm_status (*WriteUINT32Mult)(fm_int     sw,
+                                 fm_uint    reg,
+                                 fm_int     count,
+                                 fm_uint32 *ptr);
+    fm_status (*ReadUINT32Mult)(fm_int     sw,
+                                fm_uint    reg,
+                                fm_int     count,
+                                fm_uint32 *value);
+    fm_status (*WriteUINT64)(fm_int sw, fm_uint reg, fm_uint64 value);
+    fm_status (*ReadUINT64)(fm_int sw, fm_uint reg, fm_uint64 *value);
+    fm_status (*WriteUINT64Mult)(fm_int     sw,
+                                 fm_uint    reg,
+                                 fm_int     count,
+                                 fm_uint64 *ptr);
+    fm_status (*ReadUINT64Mult)(fm_int     sw,
+                                fm_uint    reg,
+                                fm_int     count,
+                                fm_uint64 *value);
+
+} fm_routeBench;
+
+
+/* Share, in thousandths, of each IPv4 prefix length in an Internet BGP
+ * table */
+typedef struct
+{
+    fm_int prefixLength;
+    fm_int weight;
+
+} fm_routeBenchLengthWeight;
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Benchmark in progress. Only one runs at a time. */
+static fm_routeBench *activeBench = NULL;
+
+static const fm_routeBenchLengthWeight bgpLengthMix[] =
+{
+    { 8,    1 },
+    { 12,   2 },
+    { 13,   3 },
+    { 14,   6 },
+    { 15,  10 },
+    { 16,  16 },
+    { 17,  10 },
+    { 18,  17 },
+    { 19,  30 },
+    { 20,  48 },
+    { 21,  55 },
+    { 22,  98 },
+    { 23,  90 },
+    { 24, 572 },
+    { 25,   8 },
+    { 26,   8 },
+    { 27,   7 },
+    { 28,   6 },
+    { 29,   5 },
+    { 30,   4 },
+    { 32,   4 },
+};
+
+static const fm_text routeBenchOpNames[ROUTE_BENCH_OP_MAX] =
+{
+    "fmCreateVirtualRouter",
+    "fmCreateECMPGroup",
+    "fmAddRoute",
+    "fmReplaceRouteECMP",
+    "fmDeleteRoute",
+    "fmDeleteECMPGroup",
+    "fmDeleteVirtualRouter",
+};
+
+static const fm_text routeBenchMixNames[FM_DBG_ROUTE_BENCH_MAX] =
+{
+    "bgp-mix",
+    "sequential",
+    "random",
+};
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** StubLoad
+ * \ingroup intDiagMisc
+ *
+ * \desc            Returns the last value written to a register by the
+ *                  register stubs, or 0 if none was written.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \return          The register value.
+ *
+ *****************************************************************************/
+static fm_uint32 StubLoad(fm_routeBench *bench, fm_uint reg)
+{
+    void *value;
+
+    if (fmHashMapFind(&bench->stubRegs, reg, &value) != FM_OK)
+    {
+        return 0;
+    }
+
+    return (fm_uint32) (fm_uintptr) value;
+
+}   /* end StubLoad */
+
+
+
+
+/*****************************************************************************/
+/** StubStore
+ * \ingroup intDiagMisc
+ *
+ * \desc            Records the value written to a register by the register
+ *                  stubs.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[in]       value is the value written.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if the value could not be recorded.
+ *
+ *****************************************************************************/
+static fm_status StubStore(fm_routeBench *bench, fm_uint reg, fm_uint32 value)
+{
+    fmHashMapRemove(&bench->stubRegs, reg, NULL);
+
+    return fmHashMapInsert(&bench->stubRegs,
+                           reg,
+                           (void *) (fm_uintptr) value);
+
+}   /* end StubStore */
+
+
+
+
+/*****************************************************************************/
+/** BenchWriteUINT32
+ * \ingroup intDiagMisc
+ *
+ * \desc            Benchmark replacement for the WriteUINT32 switch
+ *                  function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[in]       value is the value to write.
+ *
+ * \return          The status of the write.
+ *
+ *****************************************************************************/
+static fm_status BenchWriteUINT32(fm_int sw, fm_uint reg, fm_uint32 value)
+{
+    fm_routeBench *bench = activeBench;
+
+    bench->regWrites++;
+
+    if (bench->stubRegisters)
+    {
+        return StubStore(bench, reg, value);
+    }
+
+    return bench->WriteUINT32(sw, reg, value);
+
+}   /* end BenchWriteUINT32 */
+
+
+
+
+/*****************************************************************************/
+/** BenchReadUINT32
+ * \ingroup intDiagMisc
+ *
+ * \desc            Benchmark replacement for the ReadUINT32 switch
+ *                  function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function should place the register value.
+ *
+ * \return          The status of the read.
+ *
+ *****************************************************************************/
+static fm_status BenchReadUINT32(fm_int sw, fm_uint reg, fm_uint32 *value)
+{
+    fm_routeBench *bench = activeBench;
+
+    if (bench->stubRegisters)
+    {
+        *value = StubLoad(bench, reg);
+        return FM_OK;
+    }
+
+    return bench->ReadUINT32(sw, reg, value);
+
+}   /* end BenchReadUINT32 */
+
+
+
+
+/*****************************************************************************/
+/** BenchMaskUINT32
+ * \ingroup intDiagMisc
+ *
+ * \desc            Benchmark replacement for the MaskUINT32 switch
+ *                  function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[in]       mask is the mask of the bits to set or clear.
+ *
+ * \param[in]       on is TRUE to set the bits, FALSE to clear them.
+ *
+ * \return          The status of the access.
+ *
+ *****************************************************************************/
+static fm_status BenchMaskUINT32(fm_int    sw,
+                                 fm_uint   reg,
+                                 fm_uint32 mask,
+                                 fm_bool   on)
+{
+    fm_routeBench *bench = activeBench;
+    fm_uint32      value;
+
+    bench->regWrites++;
+
+    if (bench->stubRegisters)
+    {
+        value = StubLoad(bench, reg);
+        value = on ? (value | mask) : (value & ~mask);
+        return StubStore(bench, reg, value);
+    }
+
+    return bench->MaskUINT32(sw, reg, mask, on);
+
+}   /* end BenchMaskUINT32 */
+
+
+
+
+/*****************************************************************************/
+/** BenchWriteUINT32Mult
+ * \ingroup intDiagMisc
+ *
+ * \desc            Benchmark replacement for the WriteUINT32Mult switch
+ *                  function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the first register address.
+ *
+ * \param[in]       count is the number of words to write.
+ *
+ * \param[in]       ptr points to the values to write.
+ *
+ * \return          The status of the write.
+ *
+ *****************************************************************************/
+static fm_status BenchWriteUINT32Mult(fm_int     sw,
+                                      fm_uint    reg,
+                                      fm_int     count,
+                                      fm_uint32 *ptr)
+{
+    fm_routeBench *bench = activeBench;
+    fm_status      err;
+    fm_int         i;
+
+    bench->regWrites += count;
+
+    if (bench->stubRegisters)
+    {
+        for (i = 0, err = FM_OK ; i < count && err == FM_OK ; i++)
+        {
+            err = StubStore(bench, reg + i, ptr[i]);
+        }
+        return err;
+    }
+
+    return bench->WriteUINT32Mult(sw, reg, count, ptr);
+
+}   /* end BenchWriteUINT32Mult */
+
+
+
+
+/*****************************************************************************/
+/** BenchReadUINT32Mult
+ * \ingroup intDiagMisc
+ *
+ * \desc            Benchmark replacement for the ReadUINT32Mult switch
+ *                  function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the first register address.
+ *
+ * \param[in]       count is the number of words to read.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function should place the register values.
+ *
+ * \return          The status of the read.
+ *
+ *****************************************************************************/
+static fm_status BenchReadUINT32Mult(fm_int     sw,
+                                     fm_uint    reg,
+                                     fm_int     count,
+                                     fm_uint32 *value)
+{
+    fm_routeBench *bench = activeBench;
+    fm_int         i;
+
+    if (bench->stubRegisters)
+    {
+        for (i = 0 ; i < count ; i++)
+        {
+            value[i] = StubLoad(bench, reg + i);
+        }
+        return FM_OK;
+    }
+
+    return bench->ReadUINT32Mult(sw, reg, count, value);
+
+}   /* end BenchReadUINT32Mult */
+
+
+
+
+/*****************************************************************************/
+/** BenchWriteUINT64
+ * \ingroup intDiagMisc
+ *
+ * \desc            Benchmark replacement for the WriteUINT64 switch
+ *                  function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[in]       value is the value to write.
+ *
+ * \return          The status of the write.
+ *
+ *****************************************************************************/
+static fm_status BenchWriteUINT64(fm_int sw, fm_uint reg, fm_uint64 value)
+{
+    fm_routeBench *bench = activeBench;
+    fm_status      err;
+
+    bench->regWrites += 2;
+
+    if (bench->stubRegisters)
+    {
+        err = StubStore(bench, reg, (fm_uint32) value);
+
+        if (err == FM_OK)
+        {
+            err = StubStore(bench, reg + 1, (fm_uint32) (value >> 32));
+        }
+        return err;
+    }
+
+    return bench->WriteUINT64(sw, reg, value);
+
+}   /* end BenchWriteUINT64 */
+
+
+
+
+/*****************************************************************************/
+/** BenchReadUINT64
+ * \ingroup intDiagMisc
+ *
+ * \desc            Benchmark replacement for the ReadUINT64 switch
+ *                  function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the register address.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function should place the register value.
+ *
+ * \return          The status of the read.
+ *
+ *****************************************************************************/
+static fm_status BenchReadUINT64(fm_int sw, fm_uint reg, fm_uint64 *value)
+{
+    fm_routeBench *bench = activeBench;
+
+    if (bench->stubRegisters)
+    {
+        *value = ( (fm_uint64) StubLoad(bench, reg + 1) << 32 ) |
+                 StubLoad(bench, reg);
+        return FM_OK;
+    }
+
+    return bench->ReadUINT64(sw, reg, value);
+
+}   /* end BenchReadUINT64 */
+
+
+
+
+/*****************************************************************************/
+/** BenchWriteUINT64Mult
+ * \ingroup intDiagMisc
+ *
+ * \desc            Benchmark replacement for the WriteUINT64Mult switch
+ *                  function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the first register address.
+ *
+ * \param[in]       count is the number of 64-bit values to write.
+ *
+ * \param[in]       ptr points to the values to write.
+ *
+ * \return          The status of the write.
+ *
+ *****************************************************************************/
+static fm_status BenchWriteUINT64Mult(fm_int     sw,
+                                      fm_uint    reg,
+                                      fm_int     count,
+                                      fm_uint64 *ptr)
+{
+    fm_routeBench *bench = activeBench;
+    fm_status      err;
+    fm_int         i;
+
+    bench->regWrites += 2 * count;
+
+    if (bench->stubRegisters)
+    {
+        for (i = 0, err = FM_OK ; i < count && err == FM_OK ; i++)
+        {
+            err = StubStore(bench, reg + 2 * i, (fm_uint32) ptr[i]);
+
+            if (err == FM_OK)
+            {
+                err = StubStore(bench,
+                                reg + 2 * i + 1,
+                                (fm_uint32) (ptr[i] >> 32));
+            }
+        }
+        return err;
+    }
+
+    return bench->WriteUINT64Mult(sw, reg, count, ptr);
+
+}   /* end BenchWriteUINT64Mult */
+
+
+
+
+/*****************************************************************************/
+/** BenchReadUINT64Mult
+ * \ingroup intDiagMisc
+ *
+ * \desc            Benchmark replacement for the ReadUINT64Mult switch
+ *                  function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the first register address.
+ *
+ * \param[in]       count is the number of 64-bit values to read.
+ *
+ * \param[out]      value points to caller-allocated storage where this
+ *                  function should place the register values.
+ *
+ * \return          The status of the read.
+ *
+ *****************************************************************************/
+static fm_status BenchReadUINT64Mult(fm_int     sw,
+                                     fm_uint    reg,
+                                     fm_int     count,
+                                     fm_uint64 *value)
+{
+    fm_routeBench *bench = activeBench;
+    fm_int         i;
+
+    if (bench->stubRegisters)
+    {
+        for (i = 0 ; i < count ; i++)
+        {
+            value[i] = ( (fm_uint64) StubLoad(bench, reg + 2 * i + 1) << 32 ) |
+                       StubLoad(bench, reg + 2 * i);
+        }
+        return FM_OK;
+    }
+
+    return bench->ReadUINT64Mult(sw, reg, count, value);
+
+}   /* end BenchReadUINT64Mult */
+
+
+
+
+/*****************************************************************************/
+/** BenchInstall
+ * \ingroup intDiagMisc
+ *
+ * \desc            Installs the benchmark register access functions on the
+ *                  switch. Called with the register lock taken.
+ *
+ * \param[in]       switchPtr points to the switch.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchInstall(fm_switch *switchPtr, fm_routeBench *bench)
+{
+    bench->WriteUINT32     = switchPtr->WriteUINT32;
+    bench->ReadUINT32      = switchPtr->ReadUINT32;
+    bench->MaskUINT32      = switchPtr->MaskUINT32;
+    bench->WriteUINT32Mult = switchPtr->WriteUINT32Mult;
+    bench->ReadUINT32Mult  = switchPtr->ReadUINT32Mult;
+    bench->WriteUINT64     = switchPtr->WriteUINT64;
+    bench->ReadUINT64      = switchPtr->ReadUINT64;
+    bench->WriteUINT64Mult = switchPtr->WriteUINT64Mult;
+    bench->ReadUINT64Mult  = switchPtr->ReadUINT64Mult;
+
+    activeBench = bench;
+
+    switchPtr->WriteUINT32     = BenchWriteUINT32;
+    switchPtr->ReadUINT32      = BenchReadUINT32;
+    switchPtr->MaskUINT32      = BenchMaskUINT32;
+    switchPtr->WriteUINT32Mult = BenchWriteUINT32Mult;
+    switchPtr->ReadUINT32Mult  = BenchReadUINT32Mult;
+    switchPtr->WriteUINT64     = BenchWriteUINT64;
+    switchPtr->ReadUINT64      = BenchReadUINT64;
+    switchPtr->WriteUINT64Mult = BenchWriteUINT64Mult;
+    switchPtr->ReadUINT64Mult  = BenchReadUINT64Mult;
+
+}   /* end BenchInstall */
+
+
+
+
+/*****************************************************************************/
+/** BenchUninstall
+ * \ingroup intDiagMisc
+ *
+ * \desc            Restores the register access functions saved by
+ *                  BenchInstall. Called with the register lock taken.
+ *
+ * \param[in]       switchPtr points to the switch.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchUninstall(fm_switch *switchPtr, fm_routeBench *bench)
+{
+    switchPtr->WriteUINT32     = bench->WriteUINT32;
+    switchPtr->ReadUINT32      = bench->ReadUINT32;
+    switchPtr->MaskUINT32      = bench->MaskUINT32;
+    switchPtr->WriteUINT32Mult = bench->WriteUINT32Mult;
+    switchPtr->ReadUINT32Mult  = bench->ReadUINT32Mult;
+    switchPtr->WriteUINT64     = bench->WriteUINT64;
+    switchPtr->ReadUINT64      = bench->ReadUINT64;
+    switchPtr->WriteUINT64Mult = bench->WriteUINT64Mult;
+    switchPtr->ReadUINT64Mult  = bench->ReadUINT64Mult;
+
+    activeBench = NULL;
+
+}   /* end BenchUninstall */
+
+
+
+
+/*****************************************************************************/
+/** BenchRandom
+ * \ingroup intDiagMisc
+ *
+ * \desc            Returns the next number of the benchmark's xorshift
+ *                  generator, so that a seed always produces the same
+ *                  prefixes.
+ *
+ * \param[in,out]   bench points to the benchmark state.
+ *
+ * \return          A pseudo-random 32-bit number.
+ *
+ *****************************************************************************/
+static fm_uint32 BenchRandom(fm_routeBench *bench)
+{
+    fm_uint32 x;
+
+    x  = bench->randState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    bench->randState = x;
+
+    return x;
+
+}   /* end BenchRandom */
+
+
+
+
+/*****************************************************************************/
+/** BenchMakePrefix
+ * \ingroup intDiagMisc
+ *
+ * \desc            Generates the destination prefix of a route.
+ *
+ * \param[in,out]   bench points to the benchmark state.
+ *
+ * \param[in]       mix is the prefix distribution, see
+ *                  ''fm_dbgRouteBenchMix''.
+ *
+ * \param[in]       index is the number of the route.
+ *
+ * \param[out]      addr points to caller-allocated storage where this
+ *                  function should place the prefix.
+ *
+ * \param[out]      prefixLength points to caller-allocated storage where
+ *                  this function should place the prefix length.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchMakePrefix(fm_routeBench *bench,
+                            fm_int         mix,
+                            fm_int         index,
+                            fm_ipAddr *    addr,
+                            fm_int *       prefixLength)
+{
+    fm_uint32 host;
+    fm_uint32 mask;
+    fm_int    weight;
+    fm_int    i;
+
+    switch (mix)
+    {
+        case FM_DBG_ROUTE_BENCH_SEQUENTIAL:
+            /* Consecutive /24 prefixes starting at 1.0.0.0 */
+            host          = ( (fm_uint32) (index + 256) ) << 8;
+            *prefixLength = 24;
+            break;
+
+        case FM_DBG_ROUTE_BENCH_RANDOM:
+            host          = BenchRandom(bench);
+            *prefixLength = 8 + (BenchRandom(bench) % 25);
+            break;
+
+        default:
+            host   = BenchRandom(bench);
+            weight = BenchRandom(bench) % 1000;
+
+            for (i = 0 ; i < (fm_int) FM_NENTRIES(bgpLengthMix) - 1 ; i++)
+            {
+                if (weight < bgpLengthMix[i].weight)
+                {
+                    break;
+                }
+                weight -= bgpLengthMix[i].weight;
+            }
+
+            *prefixLength = bgpLengthMix[i].prefixLength;
+            break;
+    }
+
+    /* Keep the prefix in the unicast space, out of 0/8 and 127/8 */
+    host = (host & 0x00FFFFFF) | ( (1 + ( (host >> 24) % 223 ) ) << 24 );
+
+    if ( (host >> 24) == 127 )
+    {
+        host ^= 0x01000000;
+    }
+
+    mask = (*prefixLength == 0) ? 0 : 0xFFFFFFFF << (32 - *prefixLength);
+
+    FM_CLEAR(*addr);
+    addr->addr[0] = htonl(host & mask);
+    addr->isIPv6  = FALSE;
+
+}   /* end BenchMakePrefix */
+
+
+
+
+/*****************************************************************************/
+/** BenchBegin
+ * \ingroup intDiagMisc
+ *
+ * \desc            Records the counters before a timed operation.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[out]      regWrites points to caller-allocated storage for the
+ *                  register write count.
+ *
+ * \param[out]      moves points to caller-allocated storage for the routing
+ *                  TCAM move count.
+ *
+ * \return          The start time, in nanoseconds.
+ *
+ *****************************************************************************/
+static fm_uint64 BenchBegin(fm_int         sw,
+                            fm_routeBench *bench,
+                            fm_uint64 *    regWrites,
+                            fm_uint64 *    moves)
+{
+    fm_switch *switchPtr;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    *moves = 0;
+
+    if (switchPtr->GetRouteMoveCount != NULL)
+    {
+        switchPtr->GetRouteMoveCount(sw, moves);
+    }
+
+    *regWrites = bench->regWrites;
+
+    return fmGetMonotonicNsec();
+
+}   /* end BenchBegin */
+
+
+
+
+/*****************************************************************************/
+/** BenchEnd
+ * \ingroup intDiagMisc
+ *
+ * \desc            Accounts for a timed operation.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       bench points to the benchmark state.
+ *
+ * \param[in]       op is the operation.
+ *
+ * \param[in]       err is the status returned by the operation.
+ *
+ * \param[in]       start is the value returned by BenchBegin.
+ *
+ * \param[in]       regWrites is the register write count from BenchBegin.
+ *
+ * \param[in]       moves is the routing TCAM move count from BenchBegin.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchEnd(fm_int          sw,
+                     fm_routeBench * bench,
+                     fm_routeBenchOp op,
+                     fm_status       err,
+                     fm_uint64       start,
+                     fm_uint64       regWrites,
+                     fm_uint64       moves)
+{
+    fm_routeBenchStats *stats;
+    fm_switch *         switchPtr;
+    fm_uint64           end;
+    fm_uint64           endMoves;
+
+    end       = fmGetMonotonicNsec();
+    switchPtr = GET_SWITCH_PTR(sw);
+    stats     = &bench->stats[op];
+
+    if (err != FM_OK)
+    {
+        stats->failures++;
+        return;
+    }
+
+    endMoves = moves;
+
+    if (switchPtr->GetRouteMoveCount != NULL)
+    {
+        switchPtr->GetRouteMoveCount(sw, &endMoves);
+    }
+
+    stats->latency[stats->count++] = end - start;
+    stats->regWrites += bench->regWrites - regWrites;
+    stats->moves     += endMoves - moves;
+
+}   /* end BenchEnd */
+
+
+
+
+/*****************************************************************************/
+/** BenchCompareLatency
+ * \ingroup intDiagMisc
+ *
+ * \desc            Orders latencies for qsort.
+ *
+ * \param[in]       a points to the first latency.
+ *
+ * \param[in]       b points to the second latency.
+ *
+ * \return          -1, 0 or 1 as a is less than, equal to or greater than b.
+ *
+ *****************************************************************************/
+static int BenchCompareLatency(const void *a, const void *b)
+{
+    fm_uint64 la = *(const fm_uint64 *) a;
+    fm_uint64 lb = *(const fm_uint64 *) b;
+
+    return (la < lb) ? -1 : (la > lb) ? 1 : 0;
+
+}   /* end BenchCompareLatency */
+
+
+
+
+/*****************************************************************************/
+/** BenchPrintStats
+ * \ingroup intDiagMisc
+ *
+ * \desc            Prints the measurements of one operation.
+ *
+ * \param[in]       op is the operation.
+ *
+ * \param[in]       stats points to the measurements, whose latencies are
+ *                  sorted by this function.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BenchPrintStats(fm_routeBenchOp op, fm_routeBenchStats *stats)
+{
+    fm_uint64 *lat;
+    fm_int     n;
+
+    n   = stats->count;
+    lat = stats->latency;
+
+    if (n == 0 && stats->failures == 0)
+    {
+        return;
+    }
+
+    if (n == 0)
+    {
+        FM_LOG_PRINT("%-22s %7d %5d\n",
+                     routeBenchOpNames[op],
+                     n,
+                     stats->failures);
+        return;
+    }
+
+    qsort(lat, n, sizeof(fm_uint64), BenchCompareLatency);
+
+    FM_LOG_PRINT("%-22s %7d %5d %9" FM_FORMAT_64 "u %9" FM_FORMAT_64 "u "
+                 "%9" FM_FORMAT_64 "u %9" FM_FORMAT_64 "u %9.1f %8"
+                 FM_FORMAT_64 "u\n",
+                 routeBenchOpNames[op],
+                 n,
+                 stats->failures,
+                 lat[(n - 1) * 50 / 100],
+                 lat[(n - 1) * 90 / 100],
+                 lat[(n - 1) * 99 / 100],
+                 lat[n - 1],
+                 (double) stats->regWrites / n,
+                 stats->moves);
+
+}   /* end BenchPrintStats */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fmDbgRouteBenchmark
+ * \ingroup diagMisc
+ *
+ * \chips           FM10000
+ *
+ * \desc            Measures the cost of programming routes and next-hops.
+ *                  The benchmark creates the virtual router if vrid is not
+ *                  0, creates numEcmpGroups ECMP groups of two ARP
+ *                  next-hops, adds numRoutes ECMP routes spread over the
+ *                  groups, moves each route to the next group with
+ *                  ''fmReplaceRouteECMP'', then deletes everything it
+ *                  created. For each operation it prints the number of
+ *                  calls and failures, the 50th, 90th and 99th percentile
+ *                  and maximum latencies in nanoseconds, the average
+ *                  number of 32-bit register words written and the number
+ *                  of routing TCAM moves.
+ *                                                                      \lb\lb
+ *                  The same seed always produces the same prefixes, so
+ *                  that runs can be compared across SDK releases. Register
+ *                  writes made by other threads on the switch during the
+ *                  run are counted as well; results are most stable with
+ *                  the switch otherwise idle.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vrid is the virtual router to use. 0 is the physical
+ *                  router; any other virtual router must not exist yet.
+ *
+ * \param[in]       numRoutes is the number of routes to add.
+ *
+ * \param[in]       mix is the prefix distribution, see
+ *                  ''fm_dbgRouteBenchMix''.
+ *
+ * \param[in]       numEcmpGroups is the number of ECMP groups, from 1 to
+ *                  64. With a single group the replacement step is skipped.
+ *
+ * \param[in]       seed seeds the prefix generator. Must not be 0.
+ *
+ * \param[in]       stubRegisters is TRUE to keep register accesses away
+ *                  from the switch during the run: writes are recorded in
+ *                  memory and reads return the last value written. This
+ *                  measures the software cost alone and needs no device.
+ *                  Since the benchmark deletes everything it creates, the
+ *                  switch is left as it was.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_INVALID_STATE if another benchmark is running or
+ *                  a register write batch is open on the switch.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmDbgRouteBenchmark(fm_int    sw,
+                              fm_int    vrid,
+                              fm_int    numRoutes,
+                              fm_int    mix,
+                              fm_int    numEcmpGroups,
+                              fm_uint32 seed,
+                              fm_bool   stubRegisters)
+{
+    fm_switch *     switchPtr;
+    fm_routeBench * bench;
+    fm_routeEntry * routes;
+    fm_bool *       added;
+    fm_routeEntry   newRoute;
+    fm_nextHop      nextHops[ROUTE_BENCH_HOPS_PER_GROUP];
+    fm_int          groups[ROUTE_BENCH_MAX_ECMP_GROUPS];
+    fm_status       err;
+    fm_status       opErr;
+    fm_uint64       start;
+    fm_uint64       regWrites;
+    fm_uint64       moves;
+    fm_bool         installed;
+    fm_bool         vrCreated;
+    fm_int          numGroups;
+    fm_int          op;
+    fm_int          i;
+    fm_int          j;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_DEBUG,
+                 "sw=%d vrid=%d numRoutes=%d mix=%d numEcmpGroups=%d "
+                 "seed=%u stubRegisters=%d\n",
+                 sw,
+                 vrid,
+                 numRoutes,
+                 mix,
+                 numEcmpGroups,
+                 seed,
+                 stubRegisters);
+
+    if ( (vrid < 0) || (numRoutes < 0) ||
+         (mix < 0) || (mix >= FM_DBG_ROUTE_BENCH_MAX) ||
+         (numEcmpGroups < 1) ||
+         (numEcmpGroups > ROUTE_BENCH_MAX_ECMP_GROUPS) ||
+         (seed == 0) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_DEBUG, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    err       = FM_OK;
+    installed = FALSE;
+    vrCreated = FALSE;
+    numGroups = 0;
+    routes    = NULL;
+    added     = NULL;
+
+    bench = fmAlloc( sizeof(fm_routeBench) );
+
+    if (bench == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    FM_CLEAR(*bench);
+
+    bench->sw            = sw;
+    bench->stubRegisters = stubRegisters;
+    bench->randState     = seed;
+    fmHashMapInit(&bench->stubRegs);
+
+    routes = fmAlloc( (numRoutes + 1) * sizeof(fm_routeEntry) );
+    added  = fmAlloc( (numRoutes + 1) * sizeof(fm_bool) );
+
+    if ( (routes == NULL) || (added == NULL) )
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    FM_MEMSET_S(added,
+                (numRoutes + 1) * sizeof(fm_bool),
+                0,
+                (numRoutes + 1) * sizeof(fm_bool));
+
+    for (op = 0 ; op < ROUTE_BENCH_OP_MAX ; op++)
+    {
+        bench->stats[op].latency =
+            fmAlloc( (numRoutes + numEcmpGroups) * sizeof(fm_uint64) );
+
+        if (bench->stats[op].latency == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            goto ABORT;
+        }
+    }
+
+    TAKE_REG_LOCK(sw);
+
+    if ( (activeBench != NULL) || (switchPtr->regBatch.owner != NULL) )
+    {
+        err = FM_ERR_INVALID_STATE;
+    }
+    else
+    {
+        BenchInstall(switchPtr, bench);
+        installed = TRUE;
+    }
+
+    DROP_REG_LOCK(sw);
+
+    if (err != FM_OK)
+    {
+        goto ABORT;
+    }
+
+    /* Virtual router */
+    if (vrid != 0)
+    {
+        start = BenchBegin(sw, bench, &regWrites, &moves);
+        opErr = fmCreateVirtualRouter(sw, vrid);
+        BenchEnd(sw,
+                 bench,
+                 ROUTE_BENCH_OP_CREATE_VR,
+                 opErr,
+                 start,
+                 regWrites,
+                 moves);
+
+        if (opErr != FM_OK)
+        {
+            err = opErr;
+            goto ABORT;
+        }
+
+        vrCreated = TRUE;
+    }
+
+    /* ECMP groups of ARP next-hops in 192.0.2.0/24 */
+    for (i = 0 ; i < numEcmpGroups ; i++)
+    {
+        FM_CLEAR(nextHops);
+
+        for (j = 0 ; j < ROUTE_BENCH_HOPS_PER_GROUP ; j++)
+        {
+            nextHops[j].addr.addr[0] =
+                htonl(0xC0000200 + i * ROUTE_BENCH_HOPS_PER_GROUP + j + 1);
+            nextHops[j].vlan     = 1;
+            nextHops[j].trapCode = FM_DEFAULT_NEXTHOP_TRAPCODE;
+        }
+
+        start = BenchBegin(sw, bench, &regWrites, &moves);
+        opErr = fmCreateECMPGroupV2(sw, &groups[numGroups], NULL);
+
+        if (opErr == FM_OK)
+        {
+            numGroups++;
+            opErr = fmAddECMPGroupNextHops(sw,
+                                           groups[numGroups - 1],
+                                           ROUTE_BENCH_HOPS_PER_GROUP,
+                                           nextHops);
+        }
+
+        BenchEnd(sw,
+                 bench,
+                 ROUTE_BENCH_OP_CREATE_ECMP,
+                 opErr,
+                 start,
+                 regWrites,
+                 moves);
+
+        if (opErr != FM_OK)
+        {
+            err = opErr;
+            goto ABORT;
+        }
+    }
+
+    /* Routes */
+    for (i = 0 ; i < numRoutes ; i++)
+    {
+        FM_CLEAR(routes[i]);
+        routes[i].routeType                  = FM_ROUTE_TYPE_UNICAST_ECMP;
+        routes[i].data.unicastECMP.ecmpGroup = groups[i % numGroups];
+        routes[i].data.unicastECMP.vrid      = vrid;
+
+        BenchMakePrefix(bench,
+                        mix,
+                        i,
+                        &routes[i].data.unicastECMP.dstAddr,
+                        &routes[i].data.unicastECMP.prefixLength);
+
+        start = BenchBegin(sw, bench, &regWrites, &moves);
+        opErr = fmAddRoute(sw, &routes[i], FM_ROUTE_STATE_UP);
+        BenchEnd(sw,
+                 bench,
+                 ROUTE_BENCH_OP_ADD_ROUTE,
+                 opErr,
+                 start,
+                 regWrites,
+                 moves);
+
+        /* Random prefixes may repeat, such routes are just skipped */
+        added[i] = (opErr == FM_OK);
+    }
+
+    if (numGroups > 1)
+    {
+        for (i = 0 ; i < numRoutes ; i++)
+        {
+            if (!added[i])
+            {
+                continue;
+            }
+
+            newRoute = routes[i];
+            newRoute.data.unicastECMP.ecmpGroup = groups[(i + 1) % numGroups];
+
+            start = BenchBegin(sw, bench, &regWrites, &moves);
+            opErr = fmReplaceRouteECMP(sw, &routes[i], &newRoute);
+            BenchEnd(sw,
+                     bench,
+                     ROUTE_BENCH_OP_REPLACE_ECMP,
+                     opErr,
+                     start,
+                     regWrites,
+                     moves);
+
+            if (opErr == FM_OK)
+            {
+                routes[i] = newRoute;
+            }
+        }
+    }
+
+ABORT:
+
+    /* Delete whatever was created, even after a failure */
+    if (routes != NULL && added != NULL && installed)
+    {
+        for (i = 0 ; i < numRoutes ; i++)
+        {
+            if (!added[i])
+            {
+                continue;
+            }
+
+            start = BenchBegin(sw, bench, &regWrites, &moves);
+            opErr = fmDeleteRoute(sw, &routes[i]);
+            BenchEnd(sw,
+                     bench,
+                     ROUTE_BENCH_OP_DELETE_ROUTE,
+                     opErr,
+                     start,
+                     regWrites,
+                     moves);
+        }
+    }
+
+    for (i = 0 ; i < numGroups ; i++)
+    {
+        start = BenchBegin(sw, bench, &regWrites, &moves);
+        opErr = fmDeleteECMPGroup(sw, groups[i]);
+        BenchEnd(sw,
+                 bench,
+                 ROUTE_BENCH_OP_DELETE_ECMP,
+                 opErr,
+                 start,
+                 regWrites,
+                 moves);
+    }
+
+    if (vrCreated)
+    {
+        start = BenchBegin(sw, bench, &regWrites, &moves);
+        opErr = fmDeleteVirtualRouter(sw, vrid);
+        BenchEnd(sw,
+                 bench,
+                 ROUTE_BENCH_OP_DELETE_VR,
+                 opErr,
+                 start,
+                 regWrites,
+                 moves);
+    }
+
+    if (installed)
+    {
+        TAKE_REG_LOCK(sw);
+        BenchUninstall(switchPtr, bench);
+        DROP_REG_LOCK(sw);
+
+        FM_LOG_PRINT("\nRoute benchmark: sw=%d vrid=%d routes=%d mix=%s "
+                     "groups=%d seed=%u registers=%s\n",
+                     sw,
+                     vrid,
+                     numRoutes,
+                     routeBenchMixNames[mix],
+                     numEcmpGroups,
+                     seed,
+                     stubRegisters ? "stub" : "hardware");
+        FM_LOG_PRINT("%-22s %7s %5s %9s %9s %9s %9s %9s %8s\n",
+                     "Operation",
+                     "Calls",
+                     "Fail",
+                     "p50 ns",
+                     "p90 ns",
+                     "p99 ns",
+                     "max ns",
+                     "RegWr/op",
+                     "Moves");
+
+        for (op = 0 ; op < ROUTE_BENCH_OP_MAX ; op++)
+        {
+            BenchPrintStats(op, &bench->stats[op]);
+        }
+    }
+
+    if (bench != NULL)
+    {
+        for (op = 0 ; op < ROUTE_BENCH_OP_MAX ; op++)
+        {
+            if (bench->stats[op].latency != NULL)
+            {
+                fmFree(bench->stats[op].latency);
+            }
+        }
+
+        fmHashMapDestroy(&bench->stubRegs, NULL);
+        fmFree(bench);
+    }
+
+    if (routes != NULL)
+    {
+        fmFree(routes);
+    }
+
+    if (added != NULL)
+    {
+        fmFree(added);
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_DEBUG, err);
+
+}   /* end fmDbgRouteBenchmark */
@@ -55,6 +55,27 @@
 #define FREE  free
 #endif
 
+/* Initial capacity of the snapshot arrays, doubled as they fill up */
+#define SNAPSHOT_INITIAL_RUNS       1024
+#define SNAPSHOT_INITIAL_WORDS      65536
+
+/* Snapshot file identification, see fmDbgExportChipSnapshot */
+#define SNAPSHOT_FILE_MAGIC         0x46534E50  /* "FSNP" */
+#define SNAPSHOT_FILE_VERSION       1
+
+typedef struct
+{
+    fm_uint32 magic;
+    fm_uint32 version;
+    fm_int    sw;
+    fm_uint64 sec;
+    fm_uint64 usec;
+    fm_int    regCount;
+    fm_int    numRuns;
+    fm_int    numWords;
+
+} snapshotFileHeader;
+
 
 /*****************************************************************************
  * Global Variables
@@ -76,11 +97,110 @@
  *****************************************************************************/
 
 
+/*********************************************************************
+ *
+ * GrowArray
+ *
+ * Description: makes sure a snapshot array can hold the given number
+ *              of elements, doubling its capacity as needed
+ *
+ * Arguments:   array               points to the array pointer
+ *              maxElements         points to the array capacity
+ *              numElements         number of elements needed
+ *              elementSize         size of an element in bytes
+ *              initialElements     capacity of a new array
+ *
+ * Returns:     TRUE if the array is large enough
+ *              FALSE if memory could not be allocated
+ *
+ *********************************************************************/
+static fm_bool GrowArray(void **  array,
+                         fm_int * maxElements,
+                         fm_int   numElements,
+                         fm_int   elementSize,
+                         fm_int   initialElements)
+{
+    fm_int newMax;
+    void * newArray;
+
+    if (numElements <= *maxElements)
+    {
+        return TRUE;
+    }
+
+    newMax = (*maxElements > 0) ? *maxElements : initialElements;
+
+    while (newMax < numElements)
+    {
+        newMax *= 2;
+    }
+
+    newArray = ALLOC(newMax * elementSize);
+
+    if (newArray == NULL)
+    {
+        return FALSE;
+    }
+
+    if (*array != NULL)
+    {
+        memcpy(newArray, *array, *maxElements * elementSize);
+        FREE(*array);
+    }
+
+    *array       = newArray;
+    *maxElements = newMax;
+
+    return TRUE;
+
+}   /* end GrowArray */
+
+
+
+
+/*********************************************************************
+ *
+ * FreeSnapshot
+ *
+ * Description: releases a snapshot and its arrays
+ *
+ * Arguments:   pSnapshot           snapshot to free, may be NULL
+ *
+ * Returns:     nothing
+ *
+ *********************************************************************/
+static void FreeSnapshot(fmDbgFulcrumSnapshot *pSnapshot)
+{
+    if (pSnapshot == NULL)
+    {
+        return;
+    }
+
+    if (pSnapshot->runs != NULL)
+    {
+        FREE(pSnapshot->runs);
+    }
+
+    if (pSnapshot->values != NULL)
+    {
+        FREE(pSnapshot->values);
+    }
+
+    FREE(pSnapshot);
+
+}   /* end FreeSnapshot */
+
+
+
+
 /*********************************************************************
  *
  * fmDbgSaveRegValueInSnapshot
  *
- * Description: callback function to save register contents into a snapshot
+ * Description: callback function to save register contents into a snapshot.
+ *              An entry that continues the last run of the snapshot
+ *              (same register, next evenly spaced address) only adds
+ *              its value words.
  *
  * Arguments:   sw                  switch number
  *              regId               Index into register table
@@ -104,28 +224,100 @@ static fm_bool fmDbgSaveRegValueInSnapshot(fm_int    sw,
                                            fm_uint64 regValue2,
                                            fm_voidptr callbackInfo)
 {
-    fmDbgFulcrumSnapshot *        pSnapshot;
-    fmDbgFulcrumRegisterSnapshot *pRegSnapshot;
+    fmDbgFulcrumSnapshot *pSnapshot;
+    fmDbgSnapshotRun *    pRun;
+    fm_uint32 *           pWords;
+    fm_bool               extend;
 
     FM_NOT_USED(sw);
 
     pSnapshot = (fmDbgFulcrumSnapshot *) callbackInfo;
 
-    if (pSnapshot->regCount >= FM_DBG_MAX_SNAPSHOT_REGS)
+    if ( (pSnapshot->regCount >= FM_DBG_MAX_SNAPSHOT_REGS) ||
+         (regSize < 1) || (regSize > 4) )
     {
         return FALSE;
     }
 
-    pRegSnapshot = &pSnapshot->registers[pSnapshot->regCount];
+    if ( !GrowArray( (void **) &pSnapshot->values,
+                     &pSnapshot->maxWords,
+                     pSnapshot->numWords + regSize,
+                     sizeof(fm_uint32),
+                     SNAPSHOT_INITIAL_WORDS ) )
+    {
+        return FALSE;
+    }
 
-    pRegSnapshot->regId      = regId;
-    pRegSnapshot->regAddress = regAddress;
-    pRegSnapshot->regSize    = regSize;
-    pRegSnapshot->isStatReg  = isStatReg;
-    pRegSnapshot->regValue1  = regValue1;
-    pRegSnapshot->regValue2  = regValue2;
+    pRun   = (pSnapshot->numRuns > 0) ?
+             &pSnapshot->runs[pSnapshot->numRuns - 1] : NULL;
+    extend = FALSE;
 
+    if ( (pRun != NULL) &&
+         (pRun->regId == regId) &&
+         (pRun->regSize == regSize) &&
+         (pRun->isStatReg == isStatReg) )
+    {
+        if (pRun->numEntries == 1)
+        {
+            if (regAddress > pRun->regAddress)
+            {
+                pRun->addressStep = regAddress - pRun->regAddress;
+                extend            = TRUE;
+            }
+        }
+        else if ( regAddress == pRun->regAddress +
+                                pRun->numEntries * pRun->addressStep )
+        {
+            extend = TRUE;
+        }
+    }
+
+    if (!extend)
+    {
+        if ( !GrowArray( (void **) &pSnapshot->runs,
+                         &pSnapshot->maxRuns,
+                         pSnapshot->numRuns + 1,
+                         sizeof(fmDbgSnapshotRun),
+                         SNAPSHOT_INITIAL_RUNS ) )
+        {
+            return FALSE;
+        }
+
+        pRun = &pSnapshot->runs[pSnapshot->numRuns++];
+
+        pRun->regId       = regId;
+        pRun->regAddress  = regAddress;
+        pRun->addressStep = 0;
+        pRun->regSize     = regSize;
+        pRun->isStatReg   = isStatReg;
+        pRun->firstEntry  = pSnapshot->regCount;
+        pRun->numEntries  = 0;
+        pRun->firstWord   = pSnapshot->numWords;
+    }
+
+    pWords = &pSnapshot->values[pSnapshot->numWords];
+
+    pWords[0] = (fm_uint32) regValue1;
+
+    if (regSize > 1)
+    {
+        pWords[1] = (fm_uint32) (regValue1 >> 32);
+    }
+
+    if (regSize > 2)
+    {
+        pWords[2] = (fm_uint32) regValue2;
+    }
+
+    if (regSize > 3)
+    {
+        pWords[3] = (fm_uint32) (regValue2 >> 32);
+    }
+
+    pRun->numEntries++;
+    pSnapshot->numWords += regSize;
     pSnapshot->regCount++;
+
     return TRUE;
 
 }   /* end fmDbgSaveRegValueInSnapshot */
@@ -133,6 +325,170 @@ static fm_bool fmDbgSaveRegValueInSnapshot(fm_int    sw,
 
 
 
+/*********************************************************************
+ *
+ * GetSnapshotRegister
+ *
+ * Description: decodes one entry of a snapshot
+ *
+ * Arguments:   pSnapshot           snapshot to read
+ *              index               entry number, 0 to regCount - 1
+ *              pRegister           where the entry is written
+ *
+ * Returns:     TRUE if the entry exists
+ *              FALSE otherwise
+ *
+ *********************************************************************/
+static fm_bool GetSnapshotRegister(fmDbgFulcrumSnapshot *        pSnapshot,
+                                   fm_int                        index,
+                                   fmDbgFulcrumRegisterSnapshot *pRegister)
+{
+    fmDbgSnapshotRun *pRun;
+    fm_uint32 *       pWords;
+    fm_int            low;
+    fm_int            high;
+    fm_int            mid;
+    fm_int            entry;
+
+    if ( (index < 0) || (index >= pSnapshot->regCount) )
+    {
+        return FALSE;
+    }
+
+    /* Find the last run starting at or before the entry */
+    low  = 0;
+    high = pSnapshot->numRuns - 1;
+
+    while (low < high)
+    {
+        mid = (low + high + 1) / 2;
+
+        if (pSnapshot->runs[mid].firstEntry <= index)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+
+    pRun   = &pSnapshot->runs[low];
+    entry  = index - pRun->firstEntry;
+    pWords = &pSnapshot->values[pRun->firstWord + entry * pRun->regSize];
+
+    pRegister->regId      = pRun->regId;
+    pRegister->regAddress = pRun->regAddress + entry * pRun->addressStep;
+    pRegister->regSize    = pRun->regSize;
+    pRegister->isStatReg  = pRun->isStatReg;
+    pRegister->regValue1  = pWords[0];
+    pRegister->regValue2  = 0;
+
+    if (pRun->regSize > 1)
+    {
+        pRegister->regValue1 |= (fm_uint64) pWords[1] << 32;
+    }
+
+    if (pRun->regSize > 2)
+    {
+        pRegister->regValue2 = pWords[2];
+    }
+
+    if (pRun->regSize > 3)
+    {
+        pRegister->regValue2 |= (fm_uint64) pWords[3] << 32;
+    }
+
+    return TRUE;
+
+}   /* end GetSnapshotRegister */
+
+
+
+
+/*********************************************************************
+ *
+ * SameSnapshotLayout
+ *
+ * Description: tells whether two snapshots hold the same registers in
+ *              the same order, so that their values can be compared
+ *              word for word
+ *
+ * Arguments:   pSnap1              first snapshot
+ *              pSnap2              second snapshot
+ *
+ * Returns:     TRUE if the layouts are identical
+ *
+ *********************************************************************/
+static fm_bool SameSnapshotLayout(fmDbgFulcrumSnapshot *pSnap1,
+                                  fmDbgFulcrumSnapshot *pSnap2)
+{
+    fmDbgSnapshotRun *pRun1;
+    fmDbgSnapshotRun *pRun2;
+    fm_int            i;
+
+    if ( (pSnap1->regCount != pSnap2->regCount) ||
+         (pSnap1->numRuns != pSnap2->numRuns) ||
+         (pSnap1->numWords != pSnap2->numWords) )
+    {
+        return FALSE;
+    }
+
+    for (i = 0 ; i < pSnap1->numRuns ; i++)
+    {
+        pRun1 = &pSnap1->runs[i];
+        pRun2 = &pSnap2->runs[i];
+
+        if ( (pRun1->regId != pRun2->regId) ||
+             (pRun1->regAddress != pRun2->regAddress) ||
+             (pRun1->addressStep != pRun2->addressStep) ||
+             (pRun1->regSize != pRun2->regSize) ||
+             (pRun1->numEntries != pRun2->numEntries) )
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+
+}   /* end SameSnapshotLayout */
+
+
+
+
+/*********************************************************************
+ *
+ * EntryValuesDiffer
+ *
+ * Description: compares the value words of one entry of a run in two
+ *              snapshots with the same layout
+ *
+ * Arguments:   pRun                run of the entry
+ *              entry               entry number within the run
+ *              pWords1             values of the first snapshot
+ *              pWords2             values of the second snapshot
+ *
+ * Returns:     TRUE if the entry values differ
+ *
+ *********************************************************************/
+static fm_bool EntryValuesDiffer(fmDbgSnapshotRun *pRun,
+                                 fm_int            entry,
+                                 fm_uint32 *       pWords1,
+                                 fm_uint32 *       pWords2)
+{
+    fm_int offset;
+
+    offset = pRun->firstWord + entry * pRun->regSize;
+
+    return ( memcmp(&pWords1[offset],
+                    &pWords2[offset],
+                    pRun->regSize * sizeof(fm_uint32)) != 0 );
+
+}   /* end EntryValuesDiffer */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -200,10 +556,7 @@ void fmDbgTakeChipSnapshot(fm_int sw, fm_int snapshot)
         return;
     }
 
-    if (fmRootDebug->fmDbgSnapshots[snapshot] != NULL)
-    {
-        FREE(fmRootDebug->fmDbgSnapshots[snapshot]);
-    }
+    FreeSnapshot(fmRootDebug->fmDbgSnapshots[snapshot]);
 
     pSnapshot = (fmDbgFulcrumSnapshot *) ALLOC( sizeof(fmDbgFulcrumSnapshot) );
     fmRootDebug->fmDbgSnapshots[snapshot] = pSnapshot;
@@ -259,7 +612,7 @@ void fmDbgDeleteChipSnapshot(fm_int snapshot)
 
     if (fmRootDebug->fmDbgSnapshots[snapshot] != NULL)
     {
-        FREE(fmRootDebug->fmDbgSnapshots[snapshot]);
+        FreeSnapshot(fmRootDebug->fmDbgSnapshots[snapshot]);
         fmRootDebug->fmDbgSnapshots[snapshot] = NULL;
         FM_LOG_PRINT("Snapshot %d deleted\n", snapshot);
     }
@@ -296,9 +649,9 @@ void fmDbgDeleteChipSnapshot(fm_int snapshot)
  *****************************************************************************/
 void fmDbgPrintChipSnapshot(fm_int snapshot, fm_bool showZeroValues)
 {
-    fmDbgFulcrumSnapshot *        pSnapshot;
-    fm_int                        index;
-    fmDbgFulcrumRegisterSnapshot *pRegister;
+    fmDbgFulcrumSnapshot *       pSnapshot;
+    fm_int                       index;
+    fmDbgFulcrumRegisterSnapshot reg;
 
     if (snapshot < 0 || snapshot >= FM_DBG_MAX_SNAPSHOTS)
     {
@@ -321,8 +674,6 @@ void fmDbgPrintChipSnapshot(fm_int snapshot, fm_bool showZeroValues)
         return;
     }
 
-    pRegister = pSnapshot->registers;
-
     FM_LOG_PRINT("Snapshot %d was taken from switch %d at timestamp "
                  "%" FM_FORMAT_64 "u.%06" FM_FORMAT_64 "u with %d registers\n",
                  snapshot,
@@ -331,18 +682,23 @@ void fmDbgPrintChipSnapshot(fm_int snapshot, fm_bool showZeroValues)
                  pSnapshot->timestamp.usec,
                  pSnapshot->regCount);
 
-    for (index = 0 ; index < pSnapshot->regCount ; index++, pRegister++)
+    for (index = 0 ; index < pSnapshot->regCount ; index++)
     {
-        if ( (pRegister->regValue1 != 0) || (pRegister->regValue2 != 0)
+        if ( !GetSnapshotRegister(pSnapshot, index, &reg) )
+        {
+            break;
+        }
+
+        if ( (reg.regValue1 != 0) || (reg.regValue2 != 0)
             || (showZeroValues == TRUE) )
         {
             fmDbgPrintRegValue(pSnapshot->sw,
-                               pRegister->regId,
-                               pRegister->regAddress,
-                               pRegister->regSize,
-                               pRegister->isStatReg,
-                               pRegister->regValue1,
-                               pRegister->regValue2, 0);
+                               reg.regId,
+                               reg.regAddress,
+                               reg.regSize,
+                               reg.isStatReg,
+                               reg.regValue1,
+                               reg.regValue2, 0);
         }
     }
 
@@ -373,8 +729,12 @@ void fmDbgCompareChipSnapshots(fm_uint snapshotMask)
 {
     fmDbgFulcrumSnapshot *        pSnaps[FM_DBG_MAX_SNAPSHOTS];
     fm_int                        snapshotNumbers[FM_DBG_MAX_SNAPSHOTS];
-    fmDbgFulcrumRegisterSnapshot *pReg0 = NULL;
-    fmDbgFulcrumRegisterSnapshot *pRegX;
+    fmDbgFulcrumRegisterSnapshot  reg0;
+    fmDbgFulcrumRegisterSnapshot  regX;
+    fmDbgSnapshotRun *            pRun;
+    fm_bool                       sameLayout;
+    fm_bool                       runDiffers;
+    fm_int                        runIndex;
     fm_int                        snap;
     fm_int                        index;
     fm_bool                       different;
@@ -424,6 +784,22 @@ void fmDbgCompareChipSnapshots(fm_uint snapshotMask)
         return;
     }
 
+    /* When all snapshots hold the same registers, whole runs of
+     * unchanged entries can be skipped with a single memcmp. */
+    sameLayout = TRUE;
+
+    for (snap = 1 ; snap < activeCount ; snap++)
+    {
+        if ( !SameSnapshotLayout(pSnaps[0], pSnaps[snap]) )
+        {
+            sameLayout = FALSE;
+            break;
+        }
+    }
+
+    memset( &reg0, 0, sizeof(reg0) );
+    runIndex = 0;
+
     /* compare snapshot information and registers */
     for (index = -4 ; index < pSnaps[0]->regCount ; index++)
     {
@@ -432,6 +808,31 @@ void fmDbgCompareChipSnapshots(fm_uint snapshotMask)
             break;
         }
 
+        if ( sameLayout && (index >= 0)
+            && (index == pSnaps[0]->runs[runIndex].firstEntry) )
+        {
+            pRun       = &pSnaps[0]->runs[runIndex++];
+            runDiffers = FALSE;
+
+            for (snap = 1 ; snap < activeCount ; snap++)
+            {
+                if ( memcmp(&pSnaps[0]->values[pRun->firstWord],
+                            &pSnaps[snap]->values[pRun->firstWord],
+                            pRun->numEntries * pRun->regSize *
+                            sizeof(fm_uint32)) != 0 )
+                {
+                    runDiffers = TRUE;
+                    break;
+                }
+            }
+
+            if (!runDiffers)
+            {
+                index += pRun->numEntries - 1;
+                continue;
+            }
+        }
+
         different = FALSE;
 
         /* compare snapshot 0 against all other snapshots */
@@ -486,38 +887,49 @@ void fmDbgCompareChipSnapshots(fm_uint snapshotMask)
             }
             else
             {
-                pReg0 = &pSnaps[0]->registers[index];
-                pRegX = &pSnaps[snap]->registers[index];
+                GetSnapshotRegister(pSnaps[0], index, &reg0);
+
+                if ( !GetSnapshotRegister(pSnaps[snap], index, &regX) )
+                {
+                    FM_LOG_PRINT("ERROR!  Snapshot register tables do not match!\n"
+                                 "  index = %d, snapshot %d has only %d "
+                                 "registers\n",
+                                 index,
+                                 snap,
+                                 pSnaps[snap]->regCount);
+                    abort = TRUE;
+                    break;
+                }
 
-                if (pReg0->regAddress != pRegX->regAddress)
+                if (reg0.regAddress != regX.regAddress)
                 {
                     FM_LOG_PRINT("ERROR!  Snapshot register tables do not match!\n"
                                  "  index = %d, address 0 = %08X, "
                                  "address %d = %08X\n",
                                  index,
-                                 pReg0->regAddress,
+                                 reg0.regAddress,
                                  snap,
-                                 pRegX->regAddress);
+                                 regX.regAddress);
                     abort = TRUE;
                     break;
                 }
 
-                if (pReg0->regSize != pRegX->regSize)
+                if (reg0.regSize != regX.regSize)
                 {
                     FM_LOG_PRINT("ERROR!  Snapshot register sizes do not match!\n"
                                  " index = %d, address = %08X, size 0 = %d, "
                                  "size %d = %d\n",
                                  index,
-                                 pReg0->regAddress,
-                                 pReg0->regSize,
+                                 reg0.regAddress,
+                                 reg0.regSize,
                                  snap,
-                                 pRegX->regSize);
+                                 regX.regSize);
                     abort = TRUE;
                     break;
                 }
 
-                if ( (pReg0->regValue1 != pRegX->regValue1)
-                    || (pReg0->regValue2 != pRegX->regValue2) )
+                if ( (reg0.regValue1 != regX.regValue1)
+                    || (reg0.regValue2 != regX.regValue2) )
                 {
                     different = TRUE;
                     break;
@@ -561,8 +973,8 @@ void fmDbgCompareChipSnapshots(fm_uint snapshotMask)
             else
             {
                 fmDbgGetRegisterName(pSnaps[0]->sw,
-                                     pReg0->regId,
-                                     pReg0->regAddress,
+                                     reg0.regId,
+                                     reg0.regAddress,
                                      regName,
                                      MAX_REG_NAME_LENGTH,
                                      &isPort,
@@ -612,29 +1024,29 @@ void fmDbgCompareChipSnapshots(fm_uint snapshotMask)
                 }
                 else
                 {
-                    pRegX = &pSnaps[snap]->registers[index];
+                    GetSnapshotRegister(pSnaps[snap], index, &regX);
 
-                    switch (pRegX->regSize)
+                    switch (regX.regSize)
                     {
                         case 1:
                             FM_SNPRINTF_S(curReg1, sizeof(curReg1),
                                           "%08X",
-                                          (fm_uint32) pRegX->regValue1);
+                                          (fm_uint32) regX.regValue1);
                             break;
 
                         case 2:
 
-                            if (pRegX->isStatReg)
+                            if (regX.isStatReg)
                             {
                                 FM_SNPRINTF_S(curReg1, sizeof(curReg1),
                                               "%" FM_FORMAT_64 "u",
-                                              pRegX->regValue1);
+                                              regX.regValue1);
                             }
                             else
                             {
                                 FM_SNPRINTF_S(curReg1, sizeof(curReg1),
                                               "%016" FM_FORMAT_64 "X",
-                                              pRegX->regValue1);
+                                              regX.regValue1);
                             }
 
                             break;
@@ -642,22 +1054,22 @@ void fmDbgCompareChipSnapshots(fm_uint snapshotMask)
                         case 3:
                             FM_SNPRINTF_S(curReg1, sizeof(curReg1),
                                           "%016" FM_FORMAT_64 "X",
-                                          pRegX->regValue1);
+                                          regX.regValue1);
                             FM_SNPRINTF_S(curReg2, sizeof(curReg2),
                                           "%08X",
-                                          (fm_uint32) pRegX->regValue2);
+                                          (fm_uint32) regX.regValue2);
                             break;
 
                         case 4:
                             FM_SNPRINTF_S(curReg1, sizeof(curReg1),
                                           "%016" FM_FORMAT_64 "X",
-                                          pRegX->regValue1);
+                                          regX.regValue1);
                             FM_SNPRINTF_S(curReg2, sizeof(curReg2),
                                           "%016" FM_FORMAT_64 "X",
-                                          pRegX->regValue2);
+                                          regX.regValue2);
                             break;
 
-                    }    /* end switch (pRegX->regSize) */
+                    }    /* end switch (regX.regSize) */
 
                 }
 
@@ -682,3 +1094,428 @@ void fmDbgCompareChipSnapshots(fm_uint snapshotMask)
     }
 
 }   /* end fmDbgCompareChipSnapshots */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgDiffChipSnapshots
+ * \ingroup diagReg
+ *
+ * \chips           FM10000
+ *
+ * \desc            Display only the registers that changed between two
+ *                  snapshots of the same switch taken with prior calls to
+ *                  fmDbgTakeChipSnapshot. Consecutive changed entries of a
+ *                  register table are reported as a single range, and runs
+ *                  of unchanged entries are skipped without being decoded.
+ *                                                                      \lb\lb
+ *                  Both snapshots must hold the same set of registers; use
+ *                  fmDbgCompareChipSnapshots otherwise.
+ *
+ * \param[in]       snapshot1 is the reference snapshot number.
+ *
+ * \param[in]       snapshot2 is the snapshot number to compare against
+ *                  snapshot1.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmDbgDiffChipSnapshots(fm_int snapshot1, fm_int snapshot2)
+{
+    fmDbgFulcrumSnapshot *       pSnap1;
+    fmDbgFulcrumSnapshot *       pSnap2;
+    fmDbgSnapshotRun *           pRun;
+    fmDbgFulcrumRegisterSnapshot reg1;
+    fmDbgFulcrumRegisterSnapshot reg2;
+    fm_int                       runIndex;
+    fm_int                       entry;
+    fm_int                       first;
+    fm_int                       changedRegs;
+    fm_char                      firstName[MAX_REG_NAME_LENGTH];
+    fm_char                      lastName[MAX_REG_NAME_LENGTH];
+    fm_bool                      isPort;
+    fm_int                       index0Ptr;
+    fm_int                       index1Ptr;
+    fm_int                       index2Ptr;
+
+    if ( (snapshot1 < 0) || (snapshot1 >= FM_DBG_MAX_SNAPSHOTS)
+        || (snapshot2 < 0) || (snapshot2 >= FM_DBG_MAX_SNAPSHOTS) )
+    {
+        FM_LOG_PRINT("snapshot number must be between 0 and %d inclusive\n",
+                     FM_DBG_MAX_SNAPSHOTS - 1);
+        return;
+    }
+
+    pSnap1 = fmRootDebug->fmDbgSnapshots[snapshot1];
+    pSnap2 = fmRootDebug->fmDbgSnapshots[snapshot2];
+
+    if ( (pSnap1 == NULL) || (pSnap2 == NULL) )
+    {
+        FM_LOG_PRINT("snapshot %d is unused\n",
+                     (pSnap1 == NULL) ? snapshot1 : snapshot2);
+        return;
+    }
+
+    if ( !SameSnapshotLayout(pSnap1, pSnap2) )
+    {
+        FM_LOG_PRINT("Snapshots %d and %d do not hold the same registers, "
+                     "use fmDbgCompareChipSnapshots\n",
+                     snapshot1,
+                     snapshot2);
+        return;
+    }
+
+    FM_LOG_PRINT("Registers changed from snapshot %d to snapshot %d:\n",
+                 snapshot1,
+                 snapshot2);
+
+    changedRegs = 0;
+
+    for (runIndex = 0 ; runIndex < pSnap1->numRuns ; runIndex++)
+    {
+        pRun = &pSnap1->runs[runIndex];
+
+        if ( memcmp(&pSnap1->values[pRun->firstWord],
+                    &pSnap2->values[pRun->firstWord],
+                    pRun->numEntries * pRun->regSize *
+                    sizeof(fm_uint32)) == 0 )
+        {
+            continue;
+        }
+
+        entry = 0;
+
+        while (entry < pRun->numEntries)
+        {
+            if ( !EntryValuesDiffer(pRun, entry,
+                                    pSnap1->values, pSnap2->values) )
+            {
+                entry++;
+                continue;
+            }
+
+            first = entry;
+
+            while ( (entry < pRun->numEntries)
+                   && EntryValuesDiffer(pRun, entry,
+                                        pSnap1->values, pSnap2->values) )
+            {
+                entry++;
+            }
+
+            changedRegs += entry - first;
+
+            GetSnapshotRegister(pSnap1, pRun->firstEntry + first, &reg1);
+            GetSnapshotRegister(pSnap2, pRun->firstEntry + first, &reg2);
+
+            fmDbgGetRegisterName(pSnap1->sw,
+                                 reg1.regId,
+                                 reg1.regAddress,
+                                 firstName,
+                                 MAX_REG_NAME_LENGTH,
+                                 &isPort,
+                                 &index0Ptr,
+                                 &index1Ptr,
+                                 &index2Ptr,
+                                 TRUE,
+                                 FALSE);
+
+            if (entry - first == 1)
+            {
+                FM_LOG_PRINT("  %-40s  %016" FM_FORMAT_64 "X%016"
+                             FM_FORMAT_64 "X -> %016" FM_FORMAT_64 "X%016"
+                             FM_FORMAT_64 "X\n",
+                             firstName,
+                             reg1.regValue2,
+                             reg1.regValue1,
+                             reg2.regValue2,
+                             reg2.regValue1);
+            }
+            else
+            {
+                GetSnapshotRegister(pSnap1,
+                                    pRun->firstEntry + entry - 1,
+                                    &reg1);
+
+                fmDbgGetRegisterName(pSnap1->sw,
+                                     reg1.regId,
+                                     reg1.regAddress,
+                                     lastName,
+                                     MAX_REG_NAME_LENGTH,
+                                     &isPort,
+                                     &index0Ptr,
+                                     &index1Ptr,
+                                     &index2Ptr,
+                                     TRUE,
+                                     FALSE);
+
+                FM_LOG_PRINT("  %s .. %s (%d registers)\n",
+                             firstName,
+                             lastName,
+                             entry - first);
+            }
+        }
+    }
+
+    FM_LOG_PRINT("%d of %d registers changed\n",
+                 changedRegs,
+                 pSnap1->regCount);
+
+}   /* end fmDbgDiffChipSnapshots */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgExportChipSnapshot
+ * \ingroup diagReg
+ *
+ * \chips           FM10000
+ *
+ * \desc            Write a snapshot taken with fmDbgTakeChipSnapshot to a
+ *                  binary file, so that it can be reloaded with
+ *                  fmDbgImportChipSnapshot for offline comparison. The file
+ *                  uses the byte order of the host that wrote it.
+ *
+ * \param[in]       snapshot is the snapshot number to export.
+ *
+ * \param[in]       fileName is the name of the file to create.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if snapshot is out of range or
+ *                  fileName is NULL.
+ * \return          FM_ERR_NOT_FOUND if the snapshot is unused.
+ * \return          FM_FAIL if the file could not be written.
+ *
+ *****************************************************************************/
+fm_status fmDbgExportChipSnapshot(fm_int snapshot, fm_text fileName)
+{
+    fmDbgFulcrumSnapshot *pSnapshot;
+    snapshotFileHeader    header;
+    FILE *                fp;
+    fm_bool               ok;
+
+    if ( (snapshot < 0) || (snapshot >= FM_DBG_MAX_SNAPSHOTS)
+        || (fileName == NULL) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    pSnapshot = fmRootDebug->fmDbgSnapshots[snapshot];
+
+    if (pSnapshot == NULL)
+    {
+        return FM_ERR_NOT_FOUND;
+    }
+
+    memset( &header, 0, sizeof(header) );
+
+    header.magic    = SNAPSHOT_FILE_MAGIC;
+    header.version  = SNAPSHOT_FILE_VERSION;
+    header.sw       = pSnapshot->sw;
+    header.sec      = pSnapshot->timestamp.sec;
+    header.usec     = pSnapshot->timestamp.usec;
+    header.regCount = pSnapshot->regCount;
+    header.numRuns  = pSnapshot->numRuns;
+    header.numWords = pSnapshot->numWords;
+
+    fp = fopen(fileName, "wb");
+
+    if (fp == NULL)
+    {
+        FM_LOG_PRINT("Unable to create %s\n", fileName);
+        return FM_FAIL;
+    }
+
+    ok = (fwrite(&header, sizeof(header), 1, fp) == 1);
+
+    if (ok && (pSnapshot->numRuns > 0) )
+    {
+        ok = ( fwrite(pSnapshot->runs,
+                      sizeof(fmDbgSnapshotRun),
+                      pSnapshot->numRuns,
+                      fp) == (size_t) pSnapshot->numRuns );
+    }
+
+    if (ok && (pSnapshot->numWords > 0) )
+    {
+        ok = ( fwrite(pSnapshot->values,
+                      sizeof(fm_uint32),
+                      pSnapshot->numWords,
+                      fp) == (size_t) pSnapshot->numWords );
+    }
+
+    if (fclose(fp) != 0)
+    {
+        ok = FALSE;
+    }
+
+    return ok ? FM_OK : FM_FAIL;
+
+}   /* end fmDbgExportChipSnapshot */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgImportChipSnapshot
+ * \ingroup diagReg
+ *
+ * \chips           FM10000
+ *
+ * \desc            Load a snapshot written by fmDbgExportChipSnapshot,
+ *                  replacing any snapshot already recorded under the same
+ *                  number. The loaded snapshot can then be printed and
+ *                  compared like one taken from the switch.
+ *
+ * \param[in]       snapshot is the snapshot number to load into.
+ *
+ * \param[in]       fileName is the name of the file to read.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if snapshot is out of range or
+ *                  fileName is NULL.
+ * \return          FM_ERR_INVALID_VALUE if the file is not a valid
+ *                  snapshot file.
+ * \return          FM_ERR_NO_MEM if the snapshot could not be allocated.
+ * \return          FM_FAIL if the file could not be read.
+ *
+ *****************************************************************************/
+fm_status fmDbgImportChipSnapshot(fm_int snapshot, fm_text fileName)
+{
+    fmDbgFulcrumSnapshot *pSnapshot;
+    fmDbgSnapshotRun *    pRun;
+    snapshotFileHeader    header;
+    FILE *                fp;
+    fm_status             err;
+    fm_int                entries;
+    fm_int                words;
+    fm_int                i;
+
+    if ( (snapshot < 0) || (snapshot >= FM_DBG_MAX_SNAPSHOTS)
+        || (fileName == NULL) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    fp = fopen(fileName, "rb");
+
+    if (fp == NULL)
+    {
+        FM_LOG_PRINT("Unable to open %s\n", fileName);
+        return FM_FAIL;
+    }
+
+    pSnapshot = NULL;
+
+    if (fread(&header, sizeof(header), 1, fp) != 1)
+    {
+        err = FM_FAIL;
+        goto ABORT;
+    }
+
+    if ( (header.magic != SNAPSHOT_FILE_MAGIC)
+        || (header.version != SNAPSHOT_FILE_VERSION)
+        || (header.regCount < 0)
+        || (header.regCount > FM_DBG_MAX_SNAPSHOT_REGS)
+        || (header.numRuns < 0)
+        || (header.numRuns > header.regCount)
+        || (header.numWords < header.regCount)
+        || (header.numWords > header.regCount * 4) )
+    {
+        err = FM_ERR_INVALID_VALUE;
+        goto ABORT;
+    }
+
+    pSnapshot = (fmDbgFulcrumSnapshot *) ALLOC( sizeof(fmDbgFulcrumSnapshot) );
+
+    if (pSnapshot == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    memset( pSnapshot, 0, sizeof(fmDbgFulcrumSnapshot) );
+
+    if ( !GrowArray( (void **) &pSnapshot->runs,
+                     &pSnapshot->maxRuns,
+                     header.numRuns,
+                     sizeof(fmDbgSnapshotRun),
+                     SNAPSHOT_INITIAL_RUNS )
+        || !GrowArray( (void **) &pSnapshot->values,
+                       &pSnapshot->maxWords,
+                       header.numWords,
+                       sizeof(fm_uint32),
+                       SNAPSHOT_INITIAL_WORDS ) )
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    if ( (fread(pSnapshot->runs,
+                sizeof(fmDbgSnapshotRun),
+                header.numRuns,
+                fp) != (size_t) header.numRuns)
+        || (fread(pSnapshot->values,
+                  sizeof(fm_uint32),
+                  header.numWords,
+                  fp) != (size_t) header.numWords) )
+    {
+        err = FM_FAIL;
+        goto ABORT;
+    }
+
+    /* The runs must tile the entries and value words exactly */
+    entries = 0;
+    words   = 0;
+
+    for (i = 0 ; i < header.numRuns ; i++)
+    {
+        pRun = &pSnapshot->runs[i];
+
+        if ( (pRun->regSize < 1) || (pRun->regSize > 4)
+            || (pRun->numEntries < 1)
+            || (pRun->firstEntry != entries)
+            || (pRun->firstWord != words) )
+        {
+            err = FM_ERR_INVALID_VALUE;
+            goto ABORT;
+        }
+
+        entries += pRun->numEntries;
+        words   += pRun->numEntries * pRun->regSize;
+
+        if ( (entries > header.regCount) || (words > header.numWords) )
+        {
+            err = FM_ERR_INVALID_VALUE;
+            goto ABORT;
+        }
+    }
+
+    if ( (entries != header.regCount) || (words != header.numWords) )
+    {
+        err = FM_ERR_INVALID_VALUE;
+        goto ABORT;
+    }
+
+    pSnapshot->sw             = header.sw;
+    pSnapshot->timestamp.sec  = header.sec;
+    pSnapshot->timestamp.usec = header.usec;
+    pSnapshot->regCount       = header.regCount;
+    pSnapshot->numRuns        = header.numRuns;
+    pSnapshot->numWords       = header.numWords;
+
+    FreeSnapshot(fmRootDebug->fmDbgSnapshots[snapshot]);
+    fmRootDebug->fmDbgSnapshots[snapshot] = pSnapshot;
+    pSnapshot = NULL;
+
+    err = FM_OK;
+
+ABORT:
+    FreeSnapshot(pSnapshot);
+    fclose(fp);
+
+    return err;
+
+}   /* end fmDbgImportChipSnapshot */
@@ -76,6 +76,28 @@
 
 #define CHUNK_DUMP_PER_LINE    8
 
+/* Trace time stamps come from the hot-path cycle counter */
+#define TRACE_TSC()            FM_GET_CYCLES()
+
+/* Bit of an event code in the trigger and exclusion bitmaps */
+#define TRACE_FILTER_INDEX(eventCode)                   \
+    ( ( (fm_uint32) (eventCode) * 2654435761U ) >>      \
+      (32 - 12) )
+
+#define TRACE_FILTER_TEST(filter, eventCode)                                \
+    ( ( FM_ATOMIC_LOAD(&(filter)[TRACE_FILTER_INDEX(eventCode) / 64]) >>    \
+        (TRACE_FILTER_INDEX(eventCode) % 64) ) & 1 )
+
+
+/* Read position in one trace ring while merging the rings for a dump */
+typedef struct
+{
+    fm_traceRing *ring;
+    fm_uint64     next;
+    fm_uint64     end;
+
+} TRACE_CURSOR;
+
 
 /*****************************************************************************
  * Global Variables
@@ -108,6 +130,11 @@ static const char *const drvEventCounterDesc[] =
     "FM_EVID_MAX"
 };
 
+static void ReleaseTraceRing(void *arg);
+
+/* The calling thread's trace ring */
+static fm_threadLocal traceRing = FM_THREAD_LOCAL_INIT(ReleaseTraceRing);
+
 static const char *const modeDesc[] =
 {
     "Error! Should never be in this mode!)",                /* MODE_RESERVED  */
@@ -162,7 +189,12 @@ static const EC_DESC eventCodeDesc[] =
  *****************************************************************************/
 static void UnlockTB(void);
 static void LockTB(void);
-static void IncrementTBPtr(TRACE_ENTRY **ptrPtr);
+static fm_traceRing *GetTraceRing(void);
+static void RebuildTraceFilter(fm_uint64 *filter, const int *table, int size);
+static int CountTraceEvents(fm_bool *ringFull);
+static void TraceTscToTime(fm_uint64 tsc, fm_float ticksPerUsec, fm_timestamp *ts);
+static void CountTriggerTail(int eventCode);
+static int IsExcluded(int eventCode);
 static const char *FindECDesc(int eventCode);
 static void TraceInCriticalSection(int *lockKey);
 static void TraceOutCriticalSection(int lockKey);
@@ -226,6 +258,10 @@ static void InitTraceExclusions(void)
         ++ecDescPtr;
     }
 
+    RebuildTraceFilter(fmRootDebug->exclFilter,
+                       fmRootDebug->exclusions,
+                       FM_DBG_EXCLUSION_TABLE_SIZE);
+
 }   /* end InitTraceExclusions */
 
 
@@ -329,29 +365,325 @@ static void TraceOutCriticalSection(int lockKey)
 
 
 /**********************************************************************
- * IncrementTBPtr
+ * ReleaseTraceRing
  *
- * Description: Increment a trace buffer pointer, taking care to wrap
- *              if end of buffer encountered.
+ * Description: Thread-local destructor of a thread's trace ring. The
+ *              events stay in the ring; the ring can be claimed by a
+ *              new thread once the trace has been cleared.
  *
- *              NOTE:   It is assumed that tasks and interrupts are
- *                      locked by the caller.
+ * Arguments:   arg points to the ring.
  *
- * Arguments:   ptrPtr is the address of the pointer to increment.
+ * Returns:     None.
+ *
+ **********************************************************************/
+static void ReleaseTraceRing(void *arg)
+{
+    fm_traceRing *ring = arg;
+
+    FM_ATOMIC_STORE(&ring->inUse, FALSE);
+
+}   /* end ReleaseTraceRing */
+
+
+
+
+/**********************************************************************
+ * GetTraceRing
+ *
+ * Description: Return the calling thread's trace ring. On first use,
+ *              claim a ring released by an exited thread whose events
+ *              have been cleared, or allocate a new one and link it to
+ *              the ring list.
+ *
+ * Arguments:   None.
+ *
+ * Returns:     Pointer to the ring, or NULL if none could be obtained.
+ *
+ **********************************************************************/
+static fm_traceRing *GetTraceRing(void)
+{
+    fm_traceRing *ring;
+    fm_traceRing *head;
+    fm_uint64     generation;
+    fm_bool       inUse;
+
+    ring = fmGetThreadLocal(&traceRing);
+
+    if (ring != NULL)
+    {
+        return ring;
+    }
+
+    generation = FM_ATOMIC_LOAD(&fmRootDebug->traceGeneration);
+
+    for (ring = FM_ATOMIC_LOAD(&fmRootDebug->traceRings) ;
+         ring != NULL ;
+         ring = ring->next)
+    {
+        if ( FM_ATOMIC_LOAD(&ring->generation) != generation ||
+             FM_ATOMIC_LOAD(&ring->count) == 0 )
+        {
+            inUse = FALSE;
+
+            if ( FM_ATOMIC_CAS(&ring->inUse, &inUse, TRUE) )
+            {
+                break;
+            }
+        }
+    }
+
+    if (ring == NULL)
+    {
+        ring = fmAlloc( sizeof(fm_traceRing) );
+
+        if (ring == NULL)
+        {
+            return NULL;
+        }
+
+        memset( ring, 0, sizeof(fm_traceRing) );
+        ring->generation = generation;
+        ring->inUse      = TRUE;
+
+        head = FM_ATOMIC_LOAD(&fmRootDebug->traceRings);
+
+        do
+        {
+            ring->next = head;
+        }
+        while ( !FM_ATOMIC_CAS(&fmRootDebug->traceRings, &head, ring) );
+    }
+
+    if (fmSetThreadLocal(&traceRing, ring) != FM_OK)
+    {
+        FM_ATOMIC_STORE(&ring->inUse, FALSE);
+        return NULL;
+    }
+
+    return ring;
+
+}   /* end GetTraceRing */
+
+
+
+
+/**********************************************************************
+ * RebuildTraceFilter
+ *
+ * Description: Recompute the hashed bitmap that screens event codes
+ *              against the trigger or exclusion table. A clear bit
+ *              means the event code is not in the table, so
+ *              fmDbgTracePost only scans the table on a hit.
+ *
+ * Arguments:   filter is the bitmap to rebuild.
+ *
+ *              table is the trigger or exclusion table.
+ *
+ *              size is the number of entries in table.
  *
  * Returns:     None.
  *
  **********************************************************************/
-static void IncrementTBPtr(TRACE_ENTRY **ptrPtr)
+static void RebuildTraceFilter(fm_uint64 *filter, const int *table, int size)
 {
-    ++(*ptrPtr);
+    fm_uint64 bits[FM_DBG_TRACE_FILTER_WORDS];
+    fm_uint32 index;
+    int       i;
+
+    memset( bits, 0, sizeof(bits) );
 
-    if (*ptrPtr >= fmRootDebug->traceBfr + FM_DBG_TRACE_BFR_SIZE)
+    for (i = 0 ; i < size ; i++)
     {
-        *ptrPtr = fmRootDebug->traceBfr;
+        if (table[i] != EVENT_UNUSED)
+        {
+            index             = TRACE_FILTER_INDEX(table[i]);
+            bits[index / 64] |= FM_LITERAL_U64(1) << (index % 64);
+        }
     }
 
-}   /* end IncrementTBPtr */
+    for (i = 0 ; i < FM_DBG_TRACE_FILTER_WORDS ; i++)
+    {
+        FM_ATOMIC_STORE(&filter[i], bits[i]);
+    }
+
+}   /* end RebuildTraceFilter */
+
+
+
+
+/**********************************************************************
+ * CountTraceEvents
+ *
+ * Description: Count the events held in the trace rings.
+ *
+ * Arguments:   ringFull points to caller-allocated storage where this
+ *              function sets TRUE if any ring is full. May be NULL.
+ *
+ * Returns:     Number of events in all rings.
+ *
+ **********************************************************************/
+static int CountTraceEvents(fm_bool *ringFull)
+{
+    fm_traceRing *ring;
+    fm_uint64     generation;
+    fm_uint64     count;
+    int           total = 0;
+
+    if (ringFull != NULL)
+    {
+        *ringFull = FALSE;
+    }
+
+    generation = FM_ATOMIC_LOAD(&fmRootDebug->traceGeneration);
+
+    for (ring = FM_ATOMIC_LOAD(&fmRootDebug->traceRings) ;
+         ring != NULL ;
+         ring = ring->next)
+    {
+        if (FM_ATOMIC_LOAD(&ring->generation) != generation)
+        {
+            continue;
+        }
+
+        count = FM_ATOMIC_LOAD(&ring->count);
+
+        if (count >= FM_DBG_TRACE_BFR_SIZE)
+        {
+            count = FM_DBG_TRACE_BFR_SIZE;
+
+            if (ringFull != NULL)
+            {
+                *ringFull = TRUE;
+            }
+        }
+
+        total += (int) count;
+    }
+
+    return total;
+
+}   /* end CountTraceEvents */
+
+
+
+
+/**********************************************************************
+ * TraceTscToTime
+ *
+ * Description: Convert a trace time stamp to the time returned by
+ *              fmGetTime, relative to the time the trace was cleared.
+ *
+ * Arguments:   tsc is the time stamp of the event.
+ *
+ *              ticksPerUsec is the rate of the time stamp counter.
+ *
+ *              ts points to caller-allocated storage where this
+ *              function places the time.
+ *
+ * Returns:     None.
+ *
+ **********************************************************************/
+static void TraceTscToTime(fm_uint64 tsc, fm_float ticksPerUsec, fm_timestamp *ts)
+{
+    fm_uint64 usec;
+
+    usec = 0;
+
+    if (tsc > fmRootDebug->traceStartTsc)
+    {
+        usec = (fm_uint64) ( (tsc - fmRootDebug->traceStartTsc) / ticksPerUsec );
+    }
+
+    usec += fmRootDebug->traceStartTime.usec;
+
+    ts->sec  = fmRootDebug->traceStartTime.sec + usec / 1000000;
+    ts->usec = usec % 1000000;
+
+}   /* end TraceTscToTime */
+
+
+
+
+/**********************************************************************
+ * CountTriggerTail
+ *
+ * Description: In MODE_TRIGGER, arm the tail count when a trigger
+ *              event is posted, then count down the tail events and
+ *              transition to MODE_TRIGGERED after the last one. The
+ *              count is shared by all threads.
+ *
+ * Arguments:   eventCode is the event code just posted.
+ *
+ * Returns:     None.
+ *
+ **********************************************************************/
+static void CountTriggerTail(int eventCode)
+{
+    int tail;
+    int expected;
+
+    if ( FM_ATOMIC_LOAD(&fmRootDebug->TBtail) == 0 &&
+         CheckTriggerEvent(eventCode) )
+    {
+        /* Add 1 for this event. */
+        expected = 0;
+
+        if ( FM_ATOMIC_CAS(&fmRootDebug->TBtail,
+                           &expected,
+                           fmRootDebug->TBtailReset + 1) )
+        {
+            fmRootDebug->TBtriggerEvent = eventCode;
+        }
+    }
+
+    tail = FM_ATOMIC_LOAD(&fmRootDebug->TBtail);
+
+    while (tail > 0)
+    {
+        if ( FM_ATOMIC_CAS(&fmRootDebug->TBtail, &tail, tail - 1) )
+        {
+            if (tail == 1)
+            {
+                /**************************************************
+                 * We just captured the last tail event.  Transition
+                 * to MODE_TRIGGERED state.
+                 **************************************************/
+
+                expected = MODE_TRIGGER;
+                FM_ATOMIC_CAS(&fmRootDebug->TBmode, &expected, MODE_TRIGGERED);
+            }
+
+            break;
+        }
+    }
+
+}   /* end CountTriggerTail */
+
+
+
+
+/**********************************************************************
+ * IsExcluded
+ *
+ * Description: Determine if an event code is excluded from the trace.
+ *
+ * Arguments:   eventCode is the event code to check.
+ *
+ * Returns:     TRUE if the event code is excluded, else FALSE.
+ *
+ **********************************************************************/
+static int IsExcluded(int eventCode)
+{
+    int exclEntry;
+
+    if ( !TRACE_FILTER_TEST(fmRootDebug->exclFilter, eventCode) )
+    {
+        return FALSE;
+    }
+
+    return FindExclusion(eventCode, &exclEntry);
+
+}   /* end IsExcluded */
 
 
 
@@ -451,12 +783,13 @@ static const char *FindECDesc(int eventCode)
  **********************************************************************/
 void ResetTraceBuffer(void)
 {
-    fmRootDebug->TBInPtr        = fmRootDebug->traceBfr;
-    fmRootDebug->TBOutPtr       = fmRootDebug->traceBfr;
-    fmRootDebug->TBcount        = 0;
+    /* Each ring empties itself on its next post. */
+    FM_ATOMIC_ADD(&fmRootDebug->traceGeneration, 1);
+
     fmRootDebug->TBtail         = 0;
     fmRootDebug->TBtriggerEvent = EVENT_UNUSED;
     fmGetTime(&fmRootDebug->traceStartTime);
+    fmRootDebug->traceStartTsc = TRACE_TSC();
 
 }   /* end ResetTraceBuffer */
 
@@ -483,7 +816,8 @@ static void TransitionMode(int mode)
 {
 #define MODE_TRANS(from, to)  ( ( from * (MODE_MAX + 1) ) + to )
 
-    int transition;
+    int     transition;
+    fm_bool ringFull;
 
     transition = MODE_TRANS(fmRootDebug->TBmode, mode);
 
@@ -500,7 +834,7 @@ static void TransitionMode(int mode)
         case MODE_TRANS(MODE_TRIGGERED, MODE_ONE_SHOT):
         case MODE_TRANS(MODE_TRIGGERED, MODE_TRIGGER):
             ResetTraceBuffer();
-            fmRootDebug->TBmode = mode;
+            FM_ATOMIC_STORE(&fmRootDebug->TBmode, mode);
             break;
 
             /**************************************************
@@ -510,7 +844,7 @@ static void TransitionMode(int mode)
         case MODE_TRANS(MODE_FREE_RUN, MODE_ONE_SHOT):
         case MODE_TRANS(MODE_TRIGGER, MODE_ONE_SHOT):
             ResetTraceBuffer();
-            fmRootDebug->TBmode = mode;
+            FM_ATOMIC_STORE(&fmRootDebug->TBmode, mode);
             break;
 
             /**************************************************
@@ -519,7 +853,7 @@ static void TransitionMode(int mode)
         case MODE_TRANS(MODE_TRIGGER, MODE_FREE_RUN):
             fmRootDebug->TBtail         = 0;
             fmRootDebug->TBtriggerEvent = EVENT_UNUSED;
-            fmRootDebug->TBmode         = mode;
+            FM_ATOMIC_STORE(&fmRootDebug->TBmode, mode);
             break;
 
             /**************************************************
@@ -530,14 +864,16 @@ static void TransitionMode(int mode)
         case MODE_TRANS(MODE_ONE_SHOT, MODE_FREE_RUN):
         case MODE_TRANS(MODE_ONE_SHOT, MODE_TRIGGER):
 
-            if (fmRootDebug->TBcount >= FM_DBG_TRACE_BFR_SIZE)
+            CountTraceEvents(&ringFull);
+
+            if (ringFull)
             {
                 ResetTraceBuffer();
             }
 
             fmRootDebug->TBtail         = 0;
             fmRootDebug->TBtriggerEvent = EVENT_UNUSED;
-            fmRootDebug->TBmode         = mode;
+            FM_ATOMIC_STORE(&fmRootDebug->TBmode, mode);
             break;
 
             /**************************************************
@@ -546,7 +882,7 @@ static void TransitionMode(int mode)
         case MODE_TRANS(MODE_FREE_RUN, MODE_TRIGGER):
             fmRootDebug->TBtail         = 0;
             fmRootDebug->TBtriggerEvent = EVENT_UNUSED;
-            fmRootDebug->TBmode         = mode;
+            FM_ATOMIC_STORE(&fmRootDebug->TBmode, mode);
             break;
 
             /**************************************************
@@ -556,14 +892,14 @@ static void TransitionMode(int mode)
         case MODE_TRANS(MODE_ONE_SHOT, MODE_STOPPED):
         case MODE_TRANS(MODE_TRIGGER, MODE_STOPPED):
         case MODE_TRANS(MODE_TRIGGERED, MODE_STOPPED):
-            fmRootDebug->TBmode = mode;
+            FM_ATOMIC_STORE(&fmRootDebug->TBmode, mode);
             break;
 
             /**************************************************
              * From trigger to triggered.
              **************************************************/
         case MODE_TRANS(MODE_TRIGGER, MODE_TRIGGERED):
-            fmRootDebug->TBmode = mode;
+            FM_ATOMIC_STORE(&fmRootDebug->TBmode, mode);
             break;
 
             /**************************************************
@@ -576,7 +912,7 @@ static void TransitionMode(int mode)
         case MODE_TRANS(MODE_RESERVED, MODE_STOPPED):
         case MODE_TRANS(MODE_RESERVED, MODE_TRIGGER):
         case MODE_TRANS(MODE_RESERVED, MODE_TRIGGERED):
-            fmRootDebug->TBmode = mode;
+            FM_ATOMIC_STORE(&fmRootDebug->TBmode, mode);
             break;
 
             /**************************************************
@@ -631,6 +967,11 @@ static int CheckTriggerEvent(int eventCode)
     int i;
     int rtnCode = FALSE;
 
+    if ( !TRACE_FILTER_TEST(fmRootDebug->trigFilter, eventCode) )
+    {
+        return FALSE;
+    }
+
     /**************************************************
      * Scan the trigger table looking for this event
      * code.
@@ -936,18 +1277,20 @@ void fmDbgInitTrace(void)
     /**************************************************
      * Set globals to default values
      **************************************************/
-    fmRootDebug->traceBfr[0].eventCode = TB_END_OF_DATA;
-    fmRootDebug->TBInPtr               = fmRootDebug->traceBfr;
-    fmRootDebug->TBOutPtr              = fmRootDebug->traceBfr;
-    fmRootDebug->TBmode                = MODE_FREE_RUN;
-    fmRootDebug->TBtailReset           = TB_TAIL_RESET_DEFAULT;
-    fmRootDebug->TBtriggerEvent        = EVENT_UNUSED;
+    fmRootDebug->traceRings     = NULL;
+    fmRootDebug->TBmode         = MODE_FREE_RUN;
+    fmRootDebug->TBtailReset    = TB_TAIL_RESET_DEFAULT;
+    fmRootDebug->TBtriggerEvent = EVENT_UNUSED;
 
     for (i = 0 ; i < MAX_TRIGGERS ; i++)
     {
         fmRootDebug->trigTable[i] = EVENT_UNUSED;
     }
 
+    RebuildTraceFilter(fmRootDebug->trigFilter,
+                       fmRootDebug->trigTable,
+                       MAX_TRIGGERS);
+
     InitTraceExclusions();
 
     memset( fmRootDebug->dbgTimerMeas, 0, sizeof(fmRootDebug->dbgTimerMeas) );
@@ -1108,6 +1451,8 @@ void fmDbgDrvEventClear(void)
  *                      - Event code (identifying the type of event)
  *                      - Three auxiliary data words
  *                      - Text description of event code and aux data words
+ *                  The per-thread trace buffers are merged in time stamp
+ *                  order.
  *
  * \note            No new events may be posted to the trace buffer while it
  *                  is being dumped so any events that occur during the
@@ -1133,16 +1478,31 @@ void fmDbgDrvEventClear(void)
  *
  * \return          FM_OK if successful.
  * \return          FM_FAIL if invalid arguments.
+ * \return          FM_ERR_NO_MEM if memory allocation error.
  *
  *****************************************************************************/
 fm_status fmDbgTraceDump(fm_int start, fm_int end, fm_int stop)
 {
-    const char * desc;
-    fm_int       entry;
-    fm_int       keyLock = 0;
-    fm_int       dumpCount;
-    fm_int       rtnCode = FM_OK;
-    TRACE_ENTRY *outPtr;
+    const char *  desc;
+    fm_int        entry;
+    fm_int        dumpCount;
+    fm_int        skipCount;
+    fm_int        total;
+    fm_int        numCursors;
+    fm_int        i;
+    fm_int        oldest;
+    fm_int        rtnCode = FM_OK;
+    fm_uint64     generation;
+    fm_uint64     count;
+    fm_uint64     nowTsc;
+    fm_uint64     elapsedUsec;
+    fm_float      ticksPerUsec;
+    fm_timestamp  now;
+    fm_timestamp  eventTime;
+    fm_traceRing *ring;
+    TRACE_CURSOR *cursors;
+    TRACE_ENTRY * outPtr;
+    TRACE_ENTRY * nextPtr;
 
     /**************************************************
      * Don't allow any new entries to be put in buffer
@@ -1151,19 +1511,21 @@ fm_status fmDbgTraceDump(fm_int start, fm_int end, fm_int stop)
 
     LockTB();
 
+    total = CountTraceEvents(NULL);
+
     /**************************************************
      * Validate arguments.
      **************************************************/
 
-    if ( (start != 0 && end > start) || end > fmRootDebug->TBcount )
+    if ( (start != 0 && end > start) || end > total )
     {
         /* Invalid arguments. */
         rtnCode = FM_FAIL;
     }
-    else if (start > fmRootDebug->TBcount || start == 0)
+    else if (start > total || start == 0)
     {
         /* Ignore start argument. */
-        start = fmRootDebug->TBcount;
+        start = total;
     }
 
     /**************************************************
@@ -1178,9 +1540,70 @@ fm_status fmDbgTraceDump(fm_int start, fm_int end, fm_int stop)
 
         if (stop)
         {
-            TraceInCriticalSection(&keyLock);
-            fmRootDebug->TBmode = MODE_STOPPED;
-            TraceOutCriticalSection(keyLock);
+            FM_ATOMIC_STORE(&fmRootDebug->TBmode, MODE_STOPPED);
+        }
+
+        /**************************************************
+         * Set up a cursor on the oldest event of each ring
+         * holding events.
+         **************************************************/
+
+        numCursors = 0;
+
+        for (ring = FM_ATOMIC_LOAD(&fmRootDebug->traceRings) ;
+             ring != NULL ;
+             ring = ring->next)
+        {
+            numCursors++;
+        }
+
+        cursors = fmAlloc( (numCursors + 1) * sizeof(TRACE_CURSOR) );
+
+        if (cursors == NULL)
+        {
+            UnlockTB();
+            return FM_ERR_NO_MEM;
+        }
+
+        generation = FM_ATOMIC_LOAD(&fmRootDebug->traceGeneration);
+        numCursors = 0;
+
+        for (ring = FM_ATOMIC_LOAD(&fmRootDebug->traceRings) ;
+             ring != NULL ;
+             ring = ring->next)
+        {
+            count = FM_ATOMIC_LOAD(&ring->count);
+
+            if (FM_ATOMIC_LOAD(&ring->generation) != generation || count == 0)
+            {
+                continue;
+            }
+
+            cursors[numCursors].ring = ring;
+            cursors[numCursors].end  = count;
+            cursors[numCursors].next =
+                (count > FM_DBG_TRACE_BFR_SIZE) ? count - FM_DBG_TRACE_BFR_SIZE
+                                                : 0;
+            numCursors++;
+        }
+
+        /**************************************************
+         * Derive the time stamp counter rate from the time
+         * elapsed since the trace was cleared.
+         **************************************************/
+
+        fmGetTime(&now);
+        nowTsc = TRACE_TSC();
+
+        elapsedUsec = (now.sec - fmRootDebug->traceStartTime.sec) * 1000000 +
+                      now.usec - fmRootDebug->traceStartTime.usec;
+
+        ticksPerUsec = 1.0;
+
+        if ( elapsedUsec > 0 && nowTsc > fmRootDebug->traceStartTsc )
+        {
+            ticksPerUsec = (fm_float) (nowTsc - fmRootDebug->traceStartTsc) /
+                           (fm_float) elapsedUsec;
         }
 
         /**************************************************
@@ -1194,27 +1617,60 @@ fm_status fmDbgTraceDump(fm_int start, fm_int end, fm_int stop)
         }
 
         dumpCount = start - end;
-
-        outPtr = fmRootDebug->TBOutPtr + fmRootDebug->TBcount - start;
-
-        if (outPtr >= fmRootDebug->traceBfr + FM_DBG_TRACE_BFR_SIZE)
-        {
-            outPtr -= FM_DBG_TRACE_BFR_SIZE;
-        }
+        skipCount = total - start;
 
         FM_LOG_PRINT("Dumping %d of %d entries from %d to %d:\n", dumpCount,
-                     fmRootDebug->TBcount, start, end + 1);
+                     total, start, end + 1);
         DisplayTraceTime();
 
         entry = start;
 
+        /**************************************************
+         * Merge the rings by time stamp.
+         **************************************************/
+
         while (dumpCount > 0)
         {
+            outPtr = NULL;
+            oldest = -1;
+
+            for (i = 0 ; i < numCursors ; i++)
+            {
+                if (cursors[i].next >= cursors[i].end)
+                {
+                    continue;
+                }
+
+                nextPtr = &cursors[i].ring->entries[cursors[i].next %
+                                                    FM_DBG_TRACE_BFR_SIZE];
+
+                if (outPtr == NULL || nextPtr->tsc < outPtr->tsc)
+                {
+                    outPtr = nextPtr;
+                    oldest = i;
+                }
+            }
+
+            if (outPtr == NULL)
+            {
+                break;
+            }
+
+            cursors[oldest].next++;
+
+            if (skipCount > 0)
+            {
+                --skipCount;
+                continue;
+            }
+
+            TraceTscToTime(outPtr->tsc, ticksPerUsec, &eventTime);
+
             FM_LOG_PRINT("%06d:  %08" FM_FORMAT_64 "u.%06" FM_FORMAT_64
                          "u  %08x  %08x  %08x  %08x",
                          entry,
-                         outPtr->timestamp.sec,
-                         outPtr->timestamp.usec,
+                         eventTime.sec,
+                         eventTime.usec,
                          outPtr->eventCode,
                          outPtr->data1,
                          outPtr->data2,
@@ -1224,11 +1680,12 @@ fm_status fmDbgTraceDump(fm_int start, fm_int end, fm_int stop)
 
             FM_LOG_PRINT("  %s\n", desc);
 
-            IncrementTBPtr(&outPtr);
             --dumpCount;
             --entry;
         }
 
+        fmFree(cursors);
+
     }   /* end if (rtnCode == FM_OK) */
 
     UnlockTB();
@@ -1333,8 +1790,9 @@ void fmDbgTraceStatus(void)
     DisplayTriggerStatus();
     FM_LOG_PRINT("\n");
     DisplayExclusions();
-    FM_LOG_PRINT("%d events in trace buffer.  Trace buffer size is %d events.\n",
-                 fmRootDebug->TBcount, FM_DBG_TRACE_BFR_SIZE);
+    FM_LOG_PRINT("%d events in trace buffer.  Trace buffer size is %d events "
+                 "per thread.\n",
+                 CountTraceEvents(NULL), FM_DBG_TRACE_BFR_SIZE);
     return;
 
 }   /* end fmDbgTraceStatus */
@@ -1377,161 +1835,96 @@ fm_status fmDbgTracePost(fm_int    eventCode,
                          fm_uint32 data2,
                          fm_uint32 data3)
 {
-    fm_timestamp currentTime;
-    int          keyLock;
-    int          eventExcluded;
-    int          exclEntry;
-    int          rtnCode = FM_FAIL;
-
-    fmGetTime(&currentTime);
-    TraceInCriticalSection(&keyLock);
+    fm_traceRing *ring;
+    TRACE_ENTRY * entry;
+    fm_uint64     generation;
+    fm_uint64     count;
+    int           mode;
+    int           expected;
+
+    if ( fmRootDebug == NULL ||
+         FM_ATOMIC_LOAD(&fmRootDebug->TBlock) ||
+         IsExcluded(eventCode) )
+    {
+        return FM_FAIL;
+    }
 
-    eventExcluded = FindExclusion(eventCode, &exclEntry);
+    mode = FM_ATOMIC_LOAD(&fmRootDebug->TBmode);
 
-    if (!fmRootDebug->TBlock && !eventExcluded)
+    switch (mode)
     {
-        switch (fmRootDebug->TBmode)
-        {
+        /**************************************************
+         * Free-run: if the ring is full, overwrite the
+         * oldest entry.  One-shot: add the event unless the
+         * ring is already full.  Trigger: as free-run, then
+         * watch for the trigger event and count down the
+         * tail events.
+         **************************************************/
+        case MODE_FREE_RUN:
+        case MODE_ONE_SHOT:
+        case MODE_TRIGGER:
+            break;
+
             /**************************************************
-             * Add new event to trace buffer.  If buffer full,
-             * overwrite the oldest entry.
+             * Trace stopped, or invalid mode.  Do not add event
+             * to trace buffer.
              **************************************************/
-            case MODE_FREE_RUN:
-
-                if (fmRootDebug->TBcount < FM_DBG_TRACE_BFR_SIZE)
-                {
-                    /* Buffer not full. */
-                    ++fmRootDebug->TBcount;
-                }
-                else
-                {
-                    /* Buffer full. */
-                    IncrementTBPtr(&fmRootDebug->TBOutPtr);
-                }
-
-                /* Add the new event. */
-                fmRootDebug->TBInPtr->eventCode = eventCode;
-                fmRootDebug->TBInPtr->data1     = data1;
-                fmRootDebug->TBInPtr->data2     = data2;
-                fmRootDebug->TBInPtr->data3     = data3;
-                fmRootDebug->TBInPtr->timestamp = currentTime;
-                IncrementTBPtr(&fmRootDebug->TBInPtr);
-                rtnCode = FM_OK;
-                break;
-
-                /**************************************************
-                 * Add new event to trace buffer, unless it is
-                 * already full.
-                 **************************************************/
-            case MODE_ONE_SHOT:
-
-                if (fmRootDebug->TBcount < FM_DBG_TRACE_BFR_SIZE)
-                {
-                    fmRootDebug->TBInPtr->eventCode = eventCode;
-                    fmRootDebug->TBInPtr->data1     = data1;
-                    fmRootDebug->TBInPtr->data2     = data2;
-                    fmRootDebug->TBInPtr->data3     = data3;
-                    fmRootDebug->TBInPtr->timestamp = currentTime;
-                    IncrementTBPtr(&fmRootDebug->TBInPtr);
-                    ++fmRootDebug->TBcount;
-                    rtnCode = FM_OK;
-                }
-                else
-                {
-                    fmRootDebug->TBmode = MODE_STOPPED;
-                }
-
-                break;
-
-                /**************************************************
-                 * Add new event to trace buffer.  If buffer full,
-                 * overwrite the oldest entry.  Watch for trigger
-                 * event.  If trigger seen, count down TBtail number
-                 * of additional events before transitioning to
-                 * stopped mode.
-                 **************************************************/
-            case MODE_TRIGGER:
-
-                if (fmRootDebug->TBcount < FM_DBG_TRACE_BFR_SIZE)
-                {
-                    /* Buffer not full. */
-                    ++fmRootDebug->TBcount;
-                }
-                else
-                {
-                    /* Buffer full. */
-                    IncrementTBPtr(&fmRootDebug->TBOutPtr);
-                }
+        case MODE_STOPPED:
+        case MODE_TRIGGERED:
+        default:
+            return FM_FAIL;
 
-                /* Add the new event. */
-                fmRootDebug->TBInPtr->eventCode = eventCode;
-                fmRootDebug->TBInPtr->data1     = data1;
-                fmRootDebug->TBInPtr->data2     = data2;
-                fmRootDebug->TBInPtr->data3     = data3;
-                fmRootDebug->TBInPtr->timestamp = currentTime;
-                IncrementTBPtr(&fmRootDebug->TBInPtr);
-                rtnCode = FM_OK;
+    }   /* end switch (mode) */
 
-                /**************************************************
-                 * If not already triggered, see if this is a
-                 * triggering event.
-                 **************************************************/
+    ring = GetTraceRing();
 
-                if ( !fmRootDebug->TBtail && CheckTriggerEvent(eventCode) )
-                {
-                    /* Add 1 for this event. */
-                    fmRootDebug->TBtail         = fmRootDebug->TBtailReset + 1;
-                    fmRootDebug->TBtriggerEvent = eventCode;
-                }
-
-                /**************************************************
-                 * If we've already triggered, count down the
-                 * number of tail events.
-                 **************************************************/
+    if (ring == NULL)
+    {
+        return FM_FAIL;
+    }
 
-                if (fmRootDebug->TBtail)
-                {
-                    --fmRootDebug->TBtail;
+    /**************************************************
+     * The trace was cleared since this thread last
+     * posted: empty the ring.  Only the owning thread
+     * writes count, so no atomic read-modify-write is
+     * needed.
+     **************************************************/
 
-                    if (!fmRootDebug->TBtail)
-                    {
-                        /**************************************************
-                         * We just captured the last tail event.  Transition
-                         * to MODE_TRIGGERED state.
-                         **************************************************/
+    generation = FM_ATOMIC_LOAD(&fmRootDebug->traceGeneration);
 
-                        fmRootDebug->TBmode = MODE_TRIGGERED;
-                    }
-                }
+    if (ring->generation != generation)
+    {
+        FM_ATOMIC_STORE(&ring->count, 0);
+        FM_ATOMIC_STORE(&ring->generation, generation);
+    }
 
-                break;
+    count = ring->count;
 
+    if (mode == MODE_ONE_SHOT && count >= FM_DBG_TRACE_BFR_SIZE)
+    {
+        expected = MODE_ONE_SHOT;
+        FM_ATOMIC_CAS(&fmRootDebug->TBmode, &expected, MODE_STOPPED);
 
-                /**************************************************
-                 * Trace stopped.  Do not add event to trace
-                 * buffer.
-                 **************************************************/
-            case MODE_STOPPED:
-            case MODE_TRIGGERED:
-                break;
+        return FM_FAIL;
+    }
 
-                /**************************************************
-                 * Invalid mode!
-                 **************************************************/
-            default:
-                break;
+    entry = &ring->entries[count % FM_DBG_TRACE_BFR_SIZE];
 
-        }   /* end switch (fmRootDebug->TBmode) */
+    entry->eventCode = eventCode;
+    entry->data1     = data1;
+    entry->data2     = data2;
+    entry->data3     = data3;
+    entry->tsc       = TRACE_TSC();
 
-        /* end switch(fmRootDebug->TBmode) */
+    /* Publish the entry. */
+    FM_ATOMIC_STORE(&ring->count, count + 1);
 
+    if (mode == MODE_TRIGGER)
+    {
+        CountTriggerTail(eventCode);
     }
 
-    /* end if (!fmRootDebug->TBlock) */
-
-    TraceOutCriticalSection(keyLock);
-
-    return rtnCode;
+    return FM_OK;
 
 }   /* end fmDbgTracePost */
 
@@ -1753,6 +2146,10 @@ fm_status fmDbgTraceTrigger(fm_int eventCode, fm_int addOrDelete)
 
     /* end if (eventCode) */
 
+    RebuildTraceFilter(fmRootDebug->trigFilter,
+                       fmRootDebug->trigTable,
+                       MAX_TRIGGERS);
+
     /**************************************************
      * Dump trigger table and status.
      **************************************************/
@@ -1857,6 +2254,10 @@ fm_status fmDbgTraceExclude(fm_int eventCode, fm_int addOrDelete)
 
     /* end if (eventCode) */
 
+    RebuildTraceFilter(fmRootDebug->exclFilter,
+                       fmRootDebug->exclusions,
+                       FM_DBG_EXCLUSION_TABLE_SIZE);
+
     /**************************************************
      * Dump exclusion table and status.
      **************************************************/
@@ -2098,6 +2499,39 @@ void fmDbgEventQueueDestroyed(fm_eventQueue *inQueue)
 
 
 
+fm_eventQueue *fmDbgEventQueueFind(fm_text name)
+{
+    fm_eventQueue * eventQueue;
+    fm_eventQueue * found;
+    fm_treeIterator it;
+    fm_uint64       nextKey;
+    void *          nextValue;
+
+    found = NULL;
+
+    fmCaptureLock(&fmRootDebug->dbgEventQueueListLock, 0);
+
+    for (fmTreeIterInit(&it, &fmRootDebug->dbgEventQueueList) ;
+         fmTreeIterNext(&it, &nextKey, &nextValue) == FM_OK ; )
+    {
+        eventQueue = (fm_eventQueue *) (unsigned long) nextKey;
+
+        if (eventQueue->name && strcmp(eventQueue->name, name) == 0)
+        {
+            found = eventQueue;
+            break;
+        }
+    }
+
+    fmReleaseLock(&fmRootDebug->dbgEventQueueListLock);
+
+    return found;
+
+}   /* end fmDbgEventQueueFind */
+
+
+
+
 void fmDbgEventQueueDump(void)
 {
     fm_eventQueue * eventQueue;
@@ -2108,8 +2542,8 @@ void fmDbgEventQueueDump(void)
 
     fmCaptureLock(&fmRootDebug->dbgEventQueueListLock, 0);
 
-    FM_LOG_PRINT("Avg. Time (s)| Min. Time (s)| Max Time. (s)| Posted | Popped | In flight | Max In Flight | Name\n");
-    FM_LOG_PRINT("-----------------------------------------------------------------------------------------------\n"); 
+    FM_LOG_PRINT("Avg. Time (s)| Min. Time (s)| Max Time. (s)| Posted | Popped | In flight | Max In Flight |  Full  | Name\n");
+    FM_LOG_PRINT("--------------------------------------------------------------------------------------------------------\n");
     /* Just print out the event queue name for now. */
     for (fmTreeIterInit(&it, &fmRootDebug->dbgEventQueueList) ;
          ( err = fmTreeIterNext(&it, &nextKey, &nextValue) ) == FM_OK ; )
@@ -2118,7 +2552,7 @@ void fmDbgEventQueueDump(void)
 
         if (eventQueue && eventQueue->name)
         {
-            FM_LOG_PRINT("%13.8g|%14.8g|%14.8g|%8d|%8d|%11d|%15d| %s\n",             
+            FM_LOG_PRINT("%13.8g|%14.8g|%14.8g|%8d|%8d|%11d|%15d|%8" FM_FORMAT_64 "u| %s\n",
                          eventQueue->avgTime,
                          eventQueue->minTime,
                          eventQueue->maxTime,
@@ -2127,6 +2561,7 @@ void fmDbgEventQueueDump(void)
                          eventQueue->totalEventsPosted
                          - eventQueue->totalEventsPopped,
                          eventQueue->maxSize,                      
+                         eventQueue->fullDrops,
                          eventQueue->name);
         }
     }
@@ -2146,13 +2581,10 @@ void fmDbgEventQueueDump(void)
 
 void fmDbgEventQueueEventPopped(fm_eventQueue *inQueue, fm_event *event)
 {
-    fm_timestamp deltaTimestamp;
-    fm_float     deltaTime;
+    fm_float deltaTime;
 
-    fmSubTimestamps(&event->poppedTimestamp,
-                    &event->postedTimestamp,
-                    &deltaTimestamp);
-    deltaTime = deltaTimestamp.sec + 1.0e-6f * (fm_float) deltaTimestamp.usec;
+    deltaTime = 1.0e-9 * (fm_float) fmCyclesToNsec(FM_GET_CYCLES() -
+                                                   event->postedCycles);
 
     if (inQueue->totalEventsPopped > 0)
     {
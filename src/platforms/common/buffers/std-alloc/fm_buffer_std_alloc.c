@@ -40,11 +40,54 @@
 *****************************************************************************/
 
 #include <fm_sdk_int.h>
+#include <sys/mman.h>
 
 /*****************************************************************************
  * Macros, Constants & Types
  *****************************************************************************/
 
+/* freeList value of a buffer owned by the application or the driver */
+#define CHUNK_IN_USE                    -2
+
+/* freeList value of a free buffer held by a thread's magazine */
+#define CHUNK_CACHED                    -3
+
+/* Number of free buffers a thread's magazine can hold */
+#define FM_BUFFER_MAGAZINE_SIZE         32
+
+/* Number of buffers moved between a magazine and the free list at once */
+#define FM_BUFFER_MAGAZINE_BATCH        (FM_BUFFER_MAGAZINE_SIZE / 2)
+
+/* Size of the huge pages backing the buffer pool */
+#define FM_BUFFER_HUGE_PAGE_SIZE        (2 * 1024 * 1024)
+
+/**************************************************
+ * Per-thread cache of free buffer indices, so that
+ * most allocations and frees do not take the
+ * buffer lock. A magazine refills from and spills
+ * to the global free list in batches.
+ *
+ * The magazine lock is only contended when another
+ * thread finds the global free list empty and
+ * steals from this magazine.
+ **************************************************/
+typedef struct _fm_bufferMagazine
+{
+    /* Protects count and chunks */
+    pthread_mutex_t             lock;
+
+    /* Number of valid entries in chunks */
+    fm_int                      count;
+
+    /* Free buffer indices, used as a stack */
+    fm_int                      chunks[FM_BUFFER_MAGAZINE_SIZE];
+
+    /* Next magazine of this process, protected by the buffer lock */
+    struct _fm_bufferMagazine * next;
+
+} fm_bufferMagazine;
+
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -54,6 +97,14 @@
  * Local Variables
  *****************************************************************************/
 
+/* Thread-local storage key of the calling thread's magazine */
+static pthread_key_t      magazineKey;
+static pthread_once_t     magazineKeyOnce = PTHREAD_ONCE_INIT;
+static fm_bool            magazineKeyValid = FALSE;
+
+/* All magazines of this process, protected by the buffer lock */
+static fm_bufferMagazine *magazineList = NULL;
+
 
 /*****************************************************************************
  * Local function prototypes.
@@ -71,158 +122,782 @@
  * \desc            Returns the memory for a given chunk.  Assumes that the
  *                  pool field has already been setup.
  *
- * \param[in]       index is the chunk number from 0..N-1, where N is the value
- *                  of FM_NUM_BUFFERS
+ * \param[in]       index is the chunk number from 0..N-1, where N is the
+ *                  total number of buffers
  *
  * \return          the pointer to the chunk memory.
  *
  *****************************************************************************/
 static fm_uint32 *GetBufferMemory(fm_int index)
 {
-    return fmRootPlatform->bufferAllocState.pool + (index * FM_BUFFER_SIZE_WORDS);
+    fm_bufferAllocState *info = &fmRootPlatform->bufferAllocState;
+
+    return info->pool + (index * (info->bufferSize >> 2));
 
 }   /* end GetBufferMemory */
 
 
 
 
-/*****************************************************************************
- * Public Functions
+/*****************************************************************************/
+/** ReserveBuffers
+ * \ingroup intPlatform
+ *
+ * \desc            Takes a number of buffers from the available count of a
+ *                  pool, all or none.
+ *
+ * \param[in]       info points to the buffer allocator state.
+ *
+ * \param[in]       type specifies the buffer pool.
+ *
+ * \param[in]       numBuffers is the number of buffers to reserve.
+ *
+ * \return          TRUE if the buffers were reserved.
+ * \return          FALSE if the pool has fewer available buffers.
+ *
  *****************************************************************************/
+static fm_bool ReserveBuffers(fm_bufferAllocState *info,
+                              fm_bufferType        type,
+                              fm_int               numBuffers)
+{
+    fm_int available;
+
+    available = FM_ATOMIC_LOAD(&info->availableBuffers[type]);
+
+    while (available >= numBuffers)
+    {
+        if ( FM_ATOMIC_CAS(&info->availableBuffers[type],
+                           &available,
+                           available - numBuffers) )
+        {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+
+}   /* end ReserveBuffers */
+
+
+
 
 /*****************************************************************************/
-/** fmPlatformInitBuffersV2
+/** PopFreeChunk
  * \ingroup intPlatform
  *
- * \desc            Initializes the buffer allocator subsystem
+ * \desc            Removes a chunk from the head of the global free list.
+ *                  Must be called with the buffer lock held.
  *
- * \param[in]       bufferMemoryPool points to the caller-allocated memory
- *                  used to back the buffer data.
- * 
- * \param[in]       numScratchBuffers is the number of buffers used as scratch
- *                  to receive the maximum size frame on cpu.
+ * \param[in]       info points to the buffer allocator state.
  *
- * \return          fm_status code
+ * \return          The chunk index, marked as cached.
+ * \return          -1 if the free list is empty.
  *
  *****************************************************************************/
-fm_status fmPlatformInitBuffersV2(fm_uint32 *bufferMemoryPool, 
-                                  fm_int numScratchBuffers)
+static fm_int PopFreeChunk(fm_bufferAllocState *info)
+{
+    fm_int chunk;
+
+    chunk = info->firstFree;
+
+    if (chunk != -1)
+    {
+        info->firstFree       = info->freeList[chunk];
+        info->freeList[chunk] = CHUNK_CACHED;
+    }
+
+    return chunk;
+
+}   /* end PopFreeChunk */
+
+
+
+
+/*****************************************************************************/
+/** PushFreeChunk
+ * \ingroup intPlatform
+ *
+ * \desc            Returns a chunk to the head of the global free list.
+ *                  Must be called with the buffer lock held.
+ *
+ * \param[in]       info points to the buffer allocator state.
+ *
+ * \param[in]       chunk is the chunk index.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void PushFreeChunk(fm_bufferAllocState *info, fm_int chunk)
+{
+    info->freeList[chunk] = info->firstFree;
+    info->firstFree       = chunk;
+
+}   /* end PushFreeChunk */
+
+
+
+
+/*****************************************************************************/
+/** DestroyMagazine
+ * \ingroup intPlatform
+ *
+ * \desc            Called upon thread exit as a result of registering this
+ *                  function with pthread_key_create. Returns the cached
+ *                  buffers to the global free list.
+ *
+ * \param[in]       arg is the thread local storage value, which is the
+ *                  address of the thread's magazine.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void DestroyMagazine(void *arg)
 {
-    int                  i;
     fm_bufferAllocState *info;
-    fm_int               numRxBuffers;
-    fm_int               numTxBuffers;
-    fm_status            err;
+    fm_bufferMagazine *  magazine = arg;
+    fm_bufferMagazine ** link;
+
+    if (magazine == NULL)
+    {
+        return;
+    }
 
-    FM_LOG_ENTRY(FM_LOG_CAT_BUFFER, "pool=%p\n", (void *) bufferMemoryPool);
-    
     info = &fmRootPlatform->bufferAllocState;
 
-    memset( info, 0, sizeof(fm_bufferAllocState) );
+    TAKE_BUFFER_LOCK();
 
-    info->pool             = bufferMemoryPool;
+    for (link = &magazineList ; *link != NULL ; link = &(*link)->next)
+    {
+        if (*link == magazine)
+        {
+            *link = magazine->next;
+            break;
+        }
+    }
 
-    info->enableSeparatePool = GET_PROPERTY()->separateBufPoolEnable;
+    pthread_mutex_lock(&magazine->lock);
 
-    if (info->enableSeparatePool)
+    while (magazine->count > 0)
     {
-        numRxBuffers = GET_PROPERTY()->numBuffersRx;
-        numTxBuffers = GET_PROPERTY()->numBuffersTx;
+        PushFreeChunk(info, magazine->chunks[--magazine->count]);
+    }
 
-        if (numRxBuffers < 0 || numTxBuffers < 0)
+    pthread_mutex_unlock(&magazine->lock);
+
+    DROP_BUFFER_LOCK();
+
+    pthread_mutex_destroy(&magazine->lock);
+    fmFree(magazine);
+
+}   /* end DestroyMagazine */
+
+
+
+
+/*****************************************************************************/
+/** CreateMagazineKey
+ * \ingroup intPlatform
+ *
+ * \desc            Creates the thread local storage key of the magazines,
+ *                  once per process.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void CreateMagazineKey(void)
+{
+    magazineKeyValid =
+        (pthread_key_create(&magazineKey, DestroyMagazine) == 0);
+
+}   /* end CreateMagazineKey */
+
+
+
+
+/*****************************************************************************/
+/** GetMagazine
+ * \ingroup intPlatform
+ *
+ * \desc            Returns the calling thread's magazine, creating it on
+ *                  first use.
+ *
+ * \return          Pointer to the magazine.
+ * \return          NULL if it could not be created, in which case the
+ *                  caller uses the global free list directly.
+ *
+ *****************************************************************************/
+static fm_bufferMagazine *GetMagazine(void)
+{
+    fm_bufferMagazine *magazine;
+
+    pthread_once(&magazineKeyOnce, CreateMagazineKey);
+
+    if (!magazineKeyValid)
+    {
+        return NULL;
+    }
+
+    magazine = pthread_getspecific(magazineKey);
+
+    if (magazine == NULL)
+    {
+        magazine = (fm_bufferMagazine *) fmAlloc(sizeof(fm_bufferMagazine));
+
+        if (magazine == NULL)
         {
-           FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_INVALID_VALUE); 
+            return NULL;
         }
-        info->totalBufferCount = numRxBuffers + numTxBuffers + numScratchBuffers; 
 
-        info->availableBuffers[FM_BUFFER_RX]  = numRxBuffers + numScratchBuffers;
-        info->availableBuffers[FM_BUFFER_TX]  = numTxBuffers;
+        FM_CLEAR(*magazine);
 
-        /* When separate buffer pool is enabled, FM_BUFFER_ANY in 
-         * availableBuffers should not be used. */
-        info->availableBuffers[FM_BUFFER_ANY] = -1;
-        
+        if ( pthread_mutex_init(&magazine->lock, NULL) )
+        {
+            fmFree(magazine);
+            return NULL;
+        }
+
+        if ( pthread_setspecific(magazineKey, magazine) )
+        {
+            pthread_mutex_destroy(&magazine->lock);
+            fmFree(magazine);
+            return NULL;
+        }
+
+        TAKE_BUFFER_LOCK();
+        magazine->next = magazineList;
+        magazineList   = magazine;
+        DROP_BUFFER_LOCK();
     }
-    else
-    {
-#ifdef FM_NUM_BUFFERS
-        info->totalBufferCount = FM_NUM_BUFFERS + numScratchBuffers;
 
-        info->availableBuffers[FM_BUFFER_RX]  = -1;
-        info->availableBuffers[FM_BUFFER_TX]  = -1;
-        info->availableBuffers[FM_BUFFER_ANY] = info->totalBufferCount;
-#else
-        /* FM_NUM_BUFFERS must be defined */
-        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_INVALID_VALUE);
-#endif        
+    return magazine;
 
-    }   
+}   /* end GetMagazine */
 
-    info->table = (fm_buffer *) fmAlloc(sizeof(fm_buffer) *
-                                        info->totalBufferCount);
 
-    if (info->table == NULL)
+
+
+/*****************************************************************************/
+/** RefillMagazine
+ * \ingroup intPlatform
+ *
+ * \desc            Moves a batch of free buffers into an empty magazine,
+ *                  from the global free list or, when that is empty, from
+ *                  the magazine of another thread. Must be called with the
+ *                  magazine lock held.
+ *
+ * \param[in]       info points to the buffer allocator state.
+ *
+ * \param[in]       magazine points to the magazine to refill.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void RefillMagazine(fm_bufferAllocState *info,
+                           fm_bufferMagazine *  magazine)
+{
+    fm_bufferMagazine *other;
+    fm_int             chunk;
+    fm_int             numSteal;
+
+    TAKE_BUFFER_LOCK();
+
+    while (magazine->count < FM_BUFFER_MAGAZINE_BATCH)
     {
-        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_NO_MEM);
-    }
+        chunk = PopFreeChunk(info);
 
-    FM_LOG_DEBUG(FM_LOG_CAT_BUFFER,
-                 "Number of  buffers initialized = %d\n",
-                 info->totalBufferCount);
+        if (chunk == -1)
+        {
+            break;
+        }
+
+        magazine->chunks[magazine->count++] = chunk;
+    }
 
     /**************************************************
-     * Initialize allocator.  Each buffer in the pool
-     * is represented by its index into the pool memory
-     * block.  The allocator is an array of buffer
-     * indices, indexed by a buffer's index.  The cell
-     * content is the index of the next buffer in a
-     * virtual list of chunks.
-     *
-     * The list is terminated with a -1 entry.
-     *
-     * The for-loop below initializes the array as:
-     *
-     *          0    1    2    3         fd   fe   ff
-     *       +----+----+----+----+-----+----+----+----+
-     *       |  1 |  2 |  3 |  4 | ... | fe | ff | -1 |
-     *       +----+----+----+----+-----+----+----+----+
-     *
-     * for the case where the pool contains 256 buffers.
+     * The remaining free buffers are cached by other
+     * threads. Take half of the first magazine that is
+     * not busy; trylock avoids a lock order inversion
+     * with an owner waiting for the buffer lock.
      **************************************************/
+    for (other = magazineList ;
+         (other != NULL) && (magazine->count == 0) ;
+         other = other->next)
+    {
+        if ( (other == magazine) || pthread_mutex_trylock(&other->lock) )
+        {
+            continue;
+        }
 
-    /* Allocate the allocator. */
-    info->freeList = (fm_int *) fmAlloc(sizeof(fm_int) *
-                                        info->totalBufferCount);
+        numSteal = (other->count + 1) / 2;
 
-    if (info->freeList == NULL)
-    {
-        fmFree(info->table);
-        info->table = NULL;
-        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_NO_MEM);
+        while (numSteal-- > 0)
+        {
+            magazine->chunks[magazine->count++] =
+                other->chunks[--other->count];
+        }
+
+        pthread_mutex_unlock(&other->lock);
     }
 
-    /* Index of first buffer in list - used for allocating. */
-    info->firstFree = 0;
+    DROP_BUFFER_LOCK();
 
-    /* Initialize the allocator array. */
-    for (i = 0 ; i < info->totalBufferCount ; i++)
+}   /* end RefillMagazine */
+
+
+
+
+/*****************************************************************************/
+/** SpillMagazine
+ * \ingroup intPlatform
+ *
+ * \desc            Moves a batch of free buffers from a full magazine back
+ *                  to the global free list. Must be called with the
+ *                  magazine lock held.
+ *
+ * \param[in]       info points to the buffer allocator state.
+ *
+ * \param[in]       magazine points to the magazine to spill.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void SpillMagazine(fm_bufferAllocState *info,
+                          fm_bufferMagazine *  magazine)
+{
+    fm_int i;
+
+    TAKE_BUFFER_LOCK();
+
+    for (i = 0 ; i < FM_BUFFER_MAGAZINE_BATCH ; i++)
     {
-        info->freeList[i] = i + 1;
+        PushFreeChunk(info, magazine->chunks[--magazine->count]);
     }
 
-    /* Terminate the list. */
-    info->freeList[info->totalBufferCount - 1] = -1;
+    DROP_BUFFER_LOCK();
 
-    /* Initialize all buffers */
-    for (i = 0 ; i < info->totalBufferCount ; i++)
-    {
-        info->table[i].data = GetBufferMemory(i);
+}   /* end SpillMagazine */
 
-        info->table[i].next  = NULL;
-        info->table[i].len   = 0;
-        info->table[i].index = i;
-        info->table[i].bufferQueueNode = NULL;
-        info->table[i].recvEvent = NULL;
+
+
+
+/*****************************************************************************/
+/** UnlinkQueuedBuffer
+ * \ingroup intPlatform
+ *
+ * \desc            Removes a buffer from the priority buffer queue it is in.
+ *
+ * \note            The caller must hold the buffer queue lock and have
+ *                  checked that the buffer is queued.
+ *
+ * \param[in,out]   bq points to the priority buffer queues.
+ *
+ * \param[in,out]   buf points to the queued buffer.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void UnlinkQueuedBuffer(fm_priorityBufferQueues *bq, fm_buffer *buf)
+{
+    fm_dlist_node *node;
+    fm_int         q;
+
+    node = buf->bufferQueueNode;
+    q    = bq->nodeQueue[buf->index];
+
+    FM_DLL_REMOVE_NODE(&bq->queues[q], head, tail, node, nextPtr, prev);
+
+    if (--bq->depth[q] == 0)
+    {
+        bq->nonEmptyMask &= ~(1U << q);
+    }
+
+    buf->bufferQueueNode = NULL;
+
+}   /* end UnlinkQueuedBuffer */
+
+
+
+
+/*****************************************************************************/
+/** ReleaseChunk
+ * \ingroup intPlatform
+ *
+ * \desc            Validates a buffer being freed and resets it to the state
+ *                  of a newly allocated buffer, marking its chunk as cached.
+ *
+ * \param[in]       info points to the buffer allocator state.
+ *
+ * \param[in]       buf points to the buffer's ''fm_buffer'' structure.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if buf is not an allocated buffer.
+ *
+ *****************************************************************************/
+static fm_status ReleaseChunk(fm_bufferAllocState *info, fm_buffer *buf)
+{
+    fm_int index;
+    fm_int expected;
+
+    index = buf->index;
+
+    /**************************************************
+     * Validate chunk. Claiming the in-use marker
+     * atomically also catches concurrent double frees.
+     **************************************************/
+
+    expected = CHUNK_IN_USE;
+
+    /* Valid chunk index? */
+    if ( (index >= info->totalBufferCount) ||
+        (index < 0) ||
+        !FM_ATOMIC_CAS(&info->freeList[index], &expected, CHUNK_CACHED) )
+    {
+        /* Invalid chunk index. */
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    /**************************************************
+     * Reset its pointer to the base of the chunk
+     **************************************************/
+
+    info->table[index].data = GetBufferMemory(index);
+
+    /* A frame freed without being delivered leaves its queue here */
+    if (info->table[index].bufferQueueNode != NULL)
+    {
+        fmCaptureLock(&info->bufferQueues.lock, FM_WAIT_FOREVER);
+
+        if (info->table[index].bufferQueueNode != NULL)
+        {
+            UnlinkQueuedBuffer(&info->bufferQueues, &info->table[index]);
+        }
+
+        fmReleaseLock(&info->bufferQueues.lock);
+    }
+
+    /* Clear existing values */
+    info->table[index].recvEvent       = NULL;
+
+    /* The below statements were not there before. Any reason
+     * not to do the following? */
+    info->table[index].len = 0;
+    info->table[index].next = NULL;
+
+    return FM_OK;
+
+}   /* end ReleaseChunk */
+
+
+
+
+/*****************************************************************************/
+/** NotifyBufferWaiters
+ * \ingroup intPlatform
+ *
+ * \desc            Signals the frame receiver of every switch that could
+ *                  previously not get a chunk to try again, now that buffers
+ *                  have been freed.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void NotifyBufferWaiters(void)
+{
+    fm_switch *switchState;
+    fm_int     switchNum;
+
+    for (switchNum = FM_FIRST_FOCALPOINT ;
+         switchNum <= FM_LAST_FOCALPOINT ;
+         switchNum++)
+    {
+        switchState = fmRootApi->fmSwitchStateTable[switchNum];
+
+        if (switchState && switchState->state == FM_SWITCH_STATE_UP)
+        {
+            if (switchState->buffersNeeded)
+            {
+                /* Clear out the flag since we know we have a free buffer */
+                switchState->buffersNeeded      = FALSE;
+                
+                /**************************************************
+                 * We must take a lock before writing
+                 * intrReceivePackets because the lock is used
+                 * by the API to ensure an atomic read-modify-write
+                 * to intrReceivePackets.
+                 *
+                 * The platform lock is used instead of state lock
+                 * because on FIBM platforms, there is an access
+                 * to intrSendPackets that must be protected before
+                 * the switch's locks are even created. 
+                 **************************************************/
+                
+                FM_TAKE_PKT_INT_LOCK(switchNum);
+                switchState->intrReceivePackets = TRUE;
+                FM_DROP_PKT_INT_LOCK(switchNum);
+
+                /* Wake up the interrupt handler so it will see the message. */
+                fmPlatformTriggerInterrupt(switchNum, FM_INTERRUPT_SOURCE_API);
+            }
+        }
+    }
+
+}   /* end NotifyBufferWaiters */
+
+
+
+
+/*****************************************************************************/
+/** AllocateBufferPool
+ * \ingroup intPlatform
+ *
+ * \desc            Allocates the memory backing the buffer data, from
+ *                  pre-faulted huge pages when requested by the
+ *                  api.platform.bufferHugePages property, otherwise from
+ *                  the shared memory heap.
+ *
+ * \param[in]       info points to the buffer allocator state, whose
+ *                  bufferSize and totalBufferCount fields are set.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if the memory could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status AllocateBufferPool(fm_bufferAllocState *info)
+{
+    fm_uint64 size;
+    void *    pool;
+
+    size = (fm_uint64) info->bufferSize * info->totalBufferCount;
+
+#ifdef MAP_HUGETLB
+    if (GET_PROPERTY()->bufferHugePages)
+    {
+        /* Round up to a whole number of huge pages */
+        size = (size + FM_BUFFER_HUGE_PAGE_SIZE - 1) &
+               ~((fm_uint64) FM_BUFFER_HUGE_PAGE_SIZE - 1);
+
+        pool = mmap(NULL,
+                    size,
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE,
+                    -1,
+                    0);
+
+        if (pool != MAP_FAILED)
+        {
+            info->pool         = pool;
+            info->poolSize     = size;
+            info->poolHugePage = TRUE;
+            return FM_OK;
+        }
+
+        FM_LOG_WARNING(FM_LOG_CAT_BUFFER,
+                       "Unable to map %" FM_FORMAT_64 "u bytes of huge pages "
+                       "for packet buffers (errno %d), using the heap\n",
+                       size,
+                       errno);
+
+        size = (fm_uint64) info->bufferSize * info->totalBufferCount;
+    }
+#endif
+
+    pool = fmAlloc(size);
+
+    if (pool == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    info->pool         = pool;
+    info->poolSize     = size;
+    info->poolHugePage = FALSE;
+
+    return FM_OK;
+
+}   /* end AllocateBufferPool */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** fmPlatformInitBuffersV3
+ * \ingroup intPlatform
+ *
+ * \desc            Initializes the buffer allocator subsystem
+ *
+ * \param[in]       bufferMemoryPool points to the caller-allocated memory
+ *                  used to back the buffer data. If NULL, the memory is
+ *                  allocated here, sized from the api.platform.bufferSize
+ *                  and api.platform.numBuffers properties.
+ * 
+ * \param[in]       numScratchBuffers is the number of buffers used as scratch
+ *                  to receive the maximum size frame on cpu.
+ *
+ * \return          fm_status code
+ *
+ *****************************************************************************/
+fm_status fmPlatformInitBuffersV3(fm_uint32 *bufferMemoryPool, 
+                                  fm_int numScratchBuffers)
+{
+    int                  i;
+    fm_bufferAllocState *info;
+    fm_bufferMagazine *  magazine;
+    fm_int               numRxBuffers;
+    fm_int               numTxBuffers;
+    fm_status            err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_BUFFER, "pool=%p\n", (void *) bufferMemoryPool);
+    
+    info = &fmRootPlatform->bufferAllocState;
+
+    memset( info, 0, sizeof(fm_bufferAllocState) );
+
+    info->pool             = bufferMemoryPool;
+
+    if (bufferMemoryPool != NULL)
+    {
+        /* The caller sized the memory from the compile-time values */
+        info->bufferSize = FM_BUFFER_SIZE_BYTES;
+    }
+    else
+    {
+        info->bufferSize = (GET_PROPERTY()->bufferSize + 3) & ~3;
+
+        if (info->bufferSize <= 0)
+        {
+            FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_INVALID_VALUE);
+        }
+    }
+
+    info->enableSeparatePool = GET_PROPERTY()->separateBufPoolEnable;
+
+    if (info->enableSeparatePool)
+    {
+        numRxBuffers = GET_PROPERTY()->numBuffersRx;
+        numTxBuffers = GET_PROPERTY()->numBuffersTx;
+
+        if (numRxBuffers < 0 || numTxBuffers < 0)
+        {
+           FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_INVALID_VALUE); 
+        }
+        info->totalBufferCount = numRxBuffers + numTxBuffers + numScratchBuffers; 
+
+        info->availableBuffers[FM_BUFFER_RX]  = numRxBuffers + numScratchBuffers;
+        info->availableBuffers[FM_BUFFER_TX]  = numTxBuffers;
+
+        /* When separate buffer pool is enabled, FM_BUFFER_ANY in 
+         * availableBuffers should not be used. */
+        info->availableBuffers[FM_BUFFER_ANY] = -1;
+        
+    }
+    else
+    {
+#ifdef FM_NUM_BUFFERS
+        if (bufferMemoryPool != NULL)
+        {
+            info->totalBufferCount = FM_NUM_BUFFERS + numScratchBuffers;
+        }
+        else if (GET_PROPERTY()->numBuffers > 0)
+        {
+            info->totalBufferCount = GET_PROPERTY()->numBuffers +
+                                     numScratchBuffers;
+        }
+        else
+        {
+            FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_INVALID_VALUE);
+        }
+
+        info->availableBuffers[FM_BUFFER_RX]  = -1;
+        info->availableBuffers[FM_BUFFER_TX]  = -1;
+        info->availableBuffers[FM_BUFFER_ANY] = info->totalBufferCount;
+#else
+        /* FM_NUM_BUFFERS must be defined */
+        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_INVALID_VALUE);
+#endif        
+
+    }   
+
+    if (bufferMemoryPool == NULL)
+    {
+        err = AllocateBufferPool(info);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_BUFFER, err);
+    }
+
+    info->table = (fm_buffer *) fmAlloc(sizeof(fm_buffer) *
+                                        info->totalBufferCount);
+
+    if (info->table == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_NO_MEM);
+    }
+
+    FM_LOG_DEBUG(FM_LOG_CAT_BUFFER,
+                 "Number of  buffers initialized = %d\n",
+                 info->totalBufferCount);
+
+    /**************************************************
+     * Initialize allocator.  Each buffer in the pool
+     * is represented by its index into the pool memory
+     * block.  The allocator is an array of buffer
+     * indices, indexed by a buffer's index.  The cell
+     * content is the index of the next buffer in a
+     * virtual list of chunks.
+     *
+     * The list is terminated with a -1 entry.
+     *
+     * The for-loop below initializes the array as:
+     *
+     *          0    1    2    3         fd   fe   ff
+     *       +----+----+----+----+-----+----+----+----+
+     *       |  1 |  2 |  3 |  4 | ... | fe | ff | -1 |
+     *       +----+----+----+----+-----+----+----+----+
+     *
+     * for the case where the pool contains 256 buffers.
+     **************************************************/
+
+    /* Allocate the allocator. */
+    info->freeList = (fm_int *) fmAlloc(sizeof(fm_int) *
+                                        info->totalBufferCount);
+
+    if (info->freeList == NULL)
+    {
+        fmFree(info->table);
+        info->table = NULL;
+        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_NO_MEM);
+    }
+
+    /* Index of first buffer in list - used for allocating. */
+    info->firstFree = 0;
+
+    /* Initialize the allocator array. */
+    for (i = 0 ; i < info->totalBufferCount ; i++)
+    {
+        info->freeList[i] = i + 1;
+    }
+
+    /* Terminate the list. */
+    info->freeList[info->totalBufferCount - 1] = -1;
+
+    /* Magazines left over from a previous initialization are stale */
+    for (magazine = magazineList ; magazine != NULL ; magazine = magazine->next)
+    {
+        magazine->count = 0;
+    }
+
+    /* Initialize all buffers */
+    for (i = 0 ; i < info->totalBufferCount ; i++)
+    {
+        info->table[i].data = GetBufferMemory(i);
+
+        info->table[i].next  = NULL;
+        info->table[i].len   = 0;
+        info->table[i].index = i;
+        info->table[i].bufferQueueNode = NULL;
+        info->table[i].recvEvent = NULL;
 
         /**
          * Also initialize all the data areas.  This causes the page
@@ -230,370 +905,1067 @@ fm_status fmPlatformInitBuffersV2(fm_uint32 *bufferMemoryPool,
          * occur now, saving time during frame transmission/reception
          * later.
          */
-        memset(info->table[i].data, 'z', FM_BUFFER_SIZE_BYTES);
+        memset(info->table[i].data, 'z', info->bufferSize);
+    }
+
+    err = fmCreateLock("Buffer Lock", &info->bufferLock);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_BUFFER, err);
+
+    fmRootPlatform->enablePriorityScheduling =
+        GET_PROPERTY()->priorityBufQueues;
+
+    if (fmRootPlatform->enablePriorityScheduling)
+    {
+        err = fmPlatformInitBufferQueues(info->totalBufferCount);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_BUFFER, err);
+    }
+
+    FM_LOG_DEBUG(FM_LOG_CAT_BUFFER,
+                 "Initialized buffers left: RX: %d TX: %d Total: %d "
+                 "Size: %d HugePages: %s\n",
+                 info->availableBuffers[FM_BUFFER_RX],
+                 info->availableBuffers[FM_BUFFER_TX],
+                 info->availableBuffers[FM_BUFFER_ANY],
+                 info->bufferSize,
+                 FM_BOOLSTRING(info->poolHugePage));
+
+    FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_OK);
+
+}   /* end fmPlatformInitBuffersV3 */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformInitBuffersV2
+ * \ingroup intPlatform
+ *
+ * \desc            Initializes the buffer allocator subsystem
+ *
+ * \param[in]       bufferMemoryPool points to the caller-allocated memory
+ *                  used to back the buffer data, FM_BUFFER_SIZE_BYTES per
+ *                  buffer.
+ * 
+ * \param[in]       numScratchBuffers is the number of buffers used as scratch
+ *                  to receive the maximum size frame on cpu.
+ *
+ * \return          fm_status code
+ *
+ *****************************************************************************/
+fm_status fmPlatformInitBuffersV2(fm_uint32 *bufferMemoryPool, 
+                                  fm_int numScratchBuffers)
+{
+    if (bufferMemoryPool == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    return fmPlatformInitBuffersV3(bufferMemoryPool, numScratchBuffers);
+
+}   /* end fmPlatformInitBuffersV2 */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformInitBuffers
+ * \ingroup intPlatform
+ *
+ * \desc            Initializes the buffer allocator subsystem
+ *
+ * \param[in]       bufferMemoryPool points to the caller allocated memory used
+ *                  to back the buffer data.
+ *
+ * \return          fm_status code
+ *
+ *****************************************************************************/
+fm_status fmPlatformInitBuffers(fm_uint32 *bufferMemoryPool)
+{
+
+    return fmPlatformInitBuffersV2(bufferMemoryPool, 0);
+
+}   /* end fmPlatformInitBuffers */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformAllocateBuffer
+ * \ingroup platform
+ *
+ * \desc            Allocate a packet buffer.  The buffer is accessed through
+ *                  an ''fm_buffer'' structure, which keeps housekeeping
+ *                  information for chaining multiple data blocks together.
+ *
+ * \return          A pointer to an ''fm_buffer'' structure.
+ * \return          NULL is returned if there are no buffers available.
+ *
+ *****************************************************************************/
+fm_buffer *fmPlatformAllocateBuffer(void)
+{
+    fm_bufferAllocState *info;
+    fm_buffer *          ret;
+
+    FM_LOG_ENTRY_NOARGS(FM_LOG_CAT_BUFFER);
+    
+    info = &fmRootPlatform->bufferAllocState;
+
+    if (info->enableSeparatePool)
+    {
+        ret = fmPlatformAllocateBufferV2(FM_BUFFER_TX); 
+    }
+    else
+    {
+        ret = fmPlatformAllocateBufferV2(FM_BUFFER_ANY);
+    }
+
+    FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_BUFFER, ret, "%p\n", (void *) ret);
+
+}   /* end fmPlatformAllocateBuffer */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformFreeBuffer
+ * \ingroup platform
+ *
+ * \desc            Return a packet buffer, previously allocated with a
+ *                  call to ''fmAllocateBuffer'', to the free buffer pool.
+ *
+ * \note            If the buffer is part of a chain of buffers, this function
+ *                  will not dispose of the other buffers in the chain.  See
+ *                  fmFreeBufferChain for disposing of an entire chain.
+ *
+ * \param[in]       buf points to the buffer's ''fm_buffer'' structure.
+ *
+ * \return          FM_OK
+ *
+ *****************************************************************************/
+fm_status fmPlatformFreeBuffer(fm_buffer *buf)
+{
+    fm_bufferAllocState *info;
+    fm_bufferMagazine *  magazine;
+    fm_status            err;
+    fm_int               index;
+    fm_bufferType        type;
+
+    index = buf->index;
+    type  = buf->bufferType;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_BUFFER,
+                 "buf = %p, buf->index = %d\n",
+                 (void *) buf, index);
+
+    info = &fmRootPlatform->bufferAllocState;
+
+    err = ReleaseChunk(info, buf);
+
+    if (err != FM_OK)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, err);
+    }
+
+    /**************************************************
+     * Put the chunk back in this thread's magazine, or
+     * in the free list if there is no magazine.
+     **************************************************/
+
+    magazine = GetMagazine();
+
+    if (magazine != NULL)
+    {
+        pthread_mutex_lock(&magazine->lock);
+
+        if (magazine->count == FM_BUFFER_MAGAZINE_SIZE)
+        {
+            SpillMagazine(info, magazine);
+        }
+
+        magazine->chunks[magazine->count++] = index;
+
+        pthread_mutex_unlock(&magazine->lock);
+    }
+    else
+    {
+        TAKE_BUFFER_LOCK();
+        PushFreeChunk(info, index);
+        DROP_BUFFER_LOCK();
+    }
+
+    /**************************************************
+     * Count the free event.
+     **************************************************/
+
+    FM_ATOMIC_ADD(&info->availableBuffers[type], 1);
+
+    FM_LOG_DEBUG(FM_LOG_CAT_BUFFER,
+                 "Freed buffer #%d, %d RX buf left, %d TX buf left," 
+                 "%d ANY buf left\n", 
+                 index,
+                 info->availableBuffers[FM_BUFFER_RX],
+                 info->availableBuffers[FM_BUFFER_TX],
+                 info->availableBuffers[FM_BUFFER_ANY]);
+
+    /*************************************************************************
+     * The following should be done only when the separate pool is not enabled
+     * or separate pool is enabled and the buffer type is RX.
+     *************************************************************************/
+
+    if ( !info->enableSeparatePool || type != FM_BUFFER_TX )
+    {
+        NotifyBufferWaiters();
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_OK);
+
+}   /* end fmPlatformFreeBuffer */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformGetAvailableBuffers
+ * \ingroup intPlatform
+ *
+ * \desc            Returns the number of available buffers.
+ *
+ * \param[out]      count points to caller allocated storage where the number
+ *                  of available buffers is written.
+ *
+ * \return          fm_status code
+ *
+ *****************************************************************************/
+fm_status fmPlatformGetAvailableBuffers(fm_int *count)
+{
+    fm_status status;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_BUFFER, "count=%p\n", (void *) count);
+
+    if (fmRootPlatform->bufferAllocState.enableSeparatePool)
+    {
+        status = fmPlatformGetAvailableBuffersV2(FM_BUFFER_TX, count);
+    }
+    else
+    {
+        status = fmPlatformGetAvailableBuffersV2(FM_BUFFER_ANY, count);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_BUFFER, status);
+
+}   /* end fmPlatformGetAvailableBuffers */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformGetAvailableBuffersV2
+ * \ingroup intPlatform
+ *
+ * \desc            Returns the number of available buffers in appropriate pool.
+ *
+ * \param[in]       type specifies the type of buffer pool. 
+ *
+ * \param[out]      count points to caller allocated storage where the number
+ *                  of available buffers is written.
+ *
+ * \return          fm_status code
+ *
+ *****************************************************************************/
+fm_status fmPlatformGetAvailableBuffersV2(fm_bufferType type, fm_int *count)
+{
+    FM_LOG_ENTRY(FM_LOG_CAT_BUFFER, "count=%p\n", (void *) count);
+
+    if (!count)
+    {
+        FM_LOG_FATAL(FM_LOG_CAT_BUFFER, "Count pointer is null\n");
+
+        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_INVALID_ARGUMENT);
     }
 
-    err = fmCreateLock("Buffer Lock", &info->bufferLock);
-    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_BUFFER, err);
+    *count = FM_ATOMIC_LOAD(&fmRootPlatform->bufferAllocState.availableBuffers[type]);
+
+    FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_OK);
+
+}   /* end fmPlatformGetAvailableBuffersV2 */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformAllocateBufferV2
+ * \ingroup platform
+ *
+ * \desc            Allocate a packet buffer.  The buffer is accessed through
+ *                  an ''fm_buffer'' structure, which keeps housekeeping
+ *                  information for chaining multiple data blocks together.
+ *
+ * \param[in]       type specifies the type of buffer. When the buffer
+ *                  is freed, the type is used to handle freeing of the
+ *                  buffer to the appropriate pool.
+ *
+ * \return          A pointer to an ''fm_buffer'' structure.
+ * \return          NULL if there are no buffers available.
+ *
+ *****************************************************************************/
+fm_buffer *fmPlatformAllocateBufferV2(fm_bufferType type)
+{
+    fm_bufferAllocState *info;
+    fm_bufferMagazine *  magazine;
+    fm_int               chunk;
+    fm_buffer *          ret;
+
+    FM_LOG_ENTRY_NOARGS(FM_LOG_CAT_BUFFER);
+    
+    info = &fmRootPlatform->bufferAllocState;
+
+    if ( (!info->enableSeparatePool && type != FM_BUFFER_ANY) ||
+         (info->enableSeparatePool && type == FM_BUFFER_ANY) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_BUFFER,
+                     "Conflicting buffer type: %d\n", type);
+        FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_BUFFER, NULL, 
+                           "Conflicting buffer type: %d\n", type);
+        
+    }
+
+    if ( !ReserveBuffers(info, type, 1) )
+    {
+        FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_BUFFER, NULL, 
+                           "No free buffer available in pool: %d\n", type);
+    }
+
+    /**************************************************
+     * Get a chunk from this thread's magazine, or from
+     * the head of the free list if there is no
+     * magazine.
+     **************************************************/
+
+    magazine = GetMagazine();
+
+    if (magazine != NULL)
+    {
+        pthread_mutex_lock(&magazine->lock);
+
+        if (magazine->count == 0)
+        {
+            RefillMagazine(info, magazine);
+        }
+
+        chunk = (magazine->count > 0) ? magazine->chunks[--magazine->count] : -1;
+
+        pthread_mutex_unlock(&magazine->lock);
+    }
+    else
+    {
+        TAKE_BUFFER_LOCK();
+        chunk = PopFreeChunk(info);
+        DROP_BUFFER_LOCK();
+    }
+
+    if (chunk != -1)
+    {
+        FM_ATOMIC_STORE(&info->freeList[chunk], CHUNK_IN_USE);
+
+        FM_LOG_DEBUG(FM_LOG_CAT_BUFFER,
+                     "Allocated buffer #%d, %d left\n", chunk,
+                     info->availableBuffers[type]);
+    }
+    else
+    {
+        /* Every free buffer is cached by a busy thread */
+        FM_ATOMIC_ADD(&info->availableBuffers[type], 1);
+    }
+
+    ret = (chunk == -1) ? NULL : &info->table[chunk];
+
+    /* set the next pointer of the allocated buffer to NULL */
+    if (ret)
+    {
+        ret->next       = NULL;
+        ret->bufferType = type;
+        ret->refCount   = 1;
+    }
+
+    FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_BUFFER, ret, "%p\n", (void *) ret);
+
+}   /* end fmPlatformAllocateBufferV2 */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformAllocateBufferBulk
+ * \ingroup platform
+ *
+ * \desc            Allocate a number of packet buffers at once, all or none.
+ *                  Equivalent to numBuffers calls to
+ *                  ''fmPlatformAllocateBufferV2'', but the pool is reserved
+ *                  once and the buffer lock is taken at most once per
+ *                  magazine batch.
+ *
+ * \param[in]       type specifies the type of buffer. When the buffers
+ *                  are freed, the type is used to handle freeing of the
+ *                  buffers to the appropriate pool.
+ *
+ * \param[in]       numBuffers is the number of buffers to allocate.
+ *
+ * \param[out]      bufs points to a caller-allocated array of numBuffers
+ *                  entries where the buffer pointers are written.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_NO_MEM if fewer than numBuffers buffers are
+ *                  available.
+ *
+ *****************************************************************************/
+fm_status fmPlatformAllocateBufferBulk(fm_bufferType type,
+                                       fm_int        numBuffers,
+                                       fm_buffer **  bufs)
+{
+    fm_bufferAllocState *info;
+    fm_bufferMagazine *  magazine;
+    fm_buffer *          buf;
+    fm_int               numChunks;
+    fm_int               chunk;
+    fm_int               i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_BUFFER,
+                 "type=%d numBuffers=%d bufs=%p\n",
+                 type,
+                 numBuffers,
+                 (void *) bufs);
+
+    info = &fmRootPlatform->bufferAllocState;
+
+    if ( (numBuffers < 0) || ( (numBuffers > 0) && (bufs == NULL) ) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    if ( (!info->enableSeparatePool && type != FM_BUFFER_ANY) ||
+         (info->enableSeparatePool && type == FM_BUFFER_ANY) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_BUFFER,
+                     "Conflicting buffer type: %d\n", type);
+        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    if (numBuffers == 0)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_OK);
+    }
+
+    if ( !ReserveBuffers(info, type, numBuffers) )
+    {
+        FM_LOG_DEBUG(FM_LOG_CAT_BUFFER,
+                     "Fewer than %d free buffers available in pool: %d\n",
+                     numBuffers,
+                     type);
+        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_NO_MEM);
+    }
+
+    /**************************************************
+     * Drain this thread's magazine first, then take
+     * the rest straight from the free list under a
+     * single hold of the buffer lock. The chunk
+     * indices are collected in the output array and
+     * converted to buffer pointers once all are found.
+     **************************************************/
+
+    numChunks = 0;
+    magazine  = GetMagazine();
+
+    if (magazine != NULL)
+    {
+        pthread_mutex_lock(&magazine->lock);
+
+        while ( (numChunks < numBuffers) && (magazine->count > 0) )
+        {
+            bufs[numChunks++] = &info->table[magazine->chunks[--magazine->count]];
+        }
+    }
+
+    if (numChunks < numBuffers)
+    {
+        TAKE_BUFFER_LOCK();
+
+        while (numChunks < numBuffers)
+        {
+            chunk = PopFreeChunk(info);
+
+            if (chunk == -1)
+            {
+                break;
+            }
+
+            bufs[numChunks++] = &info->table[chunk];
+        }
+
+        DROP_BUFFER_LOCK();
+    }
+
+    /**************************************************
+     * The remaining free buffers are cached by other
+     * threads; steal them a batch at a time.
+     **************************************************/
+
+    if (magazine != NULL)
+    {
+        while (numChunks < numBuffers)
+        {
+            RefillMagazine(info, magazine);
+
+            if (magazine->count == 0)
+            {
+                break;
+            }
+
+            while ( (numChunks < numBuffers) && (magazine->count > 0) )
+            {
+                bufs[numChunks++] =
+                    &info->table[magazine->chunks[--magazine->count]];
+            }
+        }
+
+        pthread_mutex_unlock(&magazine->lock);
+    }
+
+    if (numChunks < numBuffers)
+    {
+        /* Every other free buffer is cached by a busy thread */
+        TAKE_BUFFER_LOCK();
+
+        for (i = 0 ; i < numChunks ; i++)
+        {
+            PushFreeChunk(info, bufs[i]->index);
+        }
+
+        DROP_BUFFER_LOCK();
+
+        FM_ATOMIC_ADD(&info->availableBuffers[type], numBuffers);
+
+        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_NO_MEM);
+    }
+
+    for (i = 0 ; i < numBuffers ; i++)
+    {
+        buf = bufs[i];
+
+        FM_ATOMIC_STORE(&info->freeList[buf->index], CHUNK_IN_USE);
+
+        buf->next       = NULL;
+        buf->bufferType = type;
+        buf->refCount   = 1;
+    }
+
+    FM_LOG_DEBUG(FM_LOG_CAT_BUFFER,
+                 "Allocated %d buffers, %d left\n",
+                 numBuffers,
+                 info->availableBuffers[type]);
+
+    FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_OK);
+
+}   /* end fmPlatformAllocateBufferBulk */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformFreeBufferBulk
+ * \ingroup platform
+ *
+ * \desc            Return a number of packet buffers to the free buffer
+ *                  pool at once. Equivalent to numBuffers calls to
+ *                  ''fmPlatformFreeBuffer'', but the buffer lock is taken
+ *                  at most once per magazine batch and the frame receivers
+ *                  are signalled once.
+ *
+ * \note            Only the buffers in the array are freed; the next
+ *                  pointers of chained buffers are not followed.
+ *
+ * \param[in]       numBuffers is the number of buffers in bufs.
+ *
+ * \param[in]       bufs points to an array of numBuffers buffer pointers.
+ *                  NULL entries are skipped.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid or one
+ *                  of the buffers was not allocated. The other buffers are
+ *                  still freed.
+ *
+ *****************************************************************************/
+fm_status fmPlatformFreeBufferBulk(fm_int numBuffers, fm_buffer **bufs)
+{
+    fm_bufferAllocState *info;
+    fm_bufferMagazine *  magazine;
+    fm_buffer *          buf;
+    fm_status            err;
+    fm_int               numFreed[FM_NUM_BUFFER_TYPES];
+    fm_int               i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_BUFFER,
+                 "numBuffers=%d bufs=%p\n",
+                 numBuffers,
+                 (void *) bufs);
+
+    if ( (numBuffers < 0) || ( (numBuffers > 0) && (bufs == NULL) ) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    info = &fmRootPlatform->bufferAllocState;
+    err  = FM_OK;
+
+    FM_CLEAR(numFreed);
+
+    /**************************************************
+     * Validate and reset each buffer, then put its
+     * chunk back in this thread's magazine, spilling a
+     * batch whenever it fills up, or in the free list
+     * if there is no magazine.
+     **************************************************/
+
+    magazine = GetMagazine();
+
+    if (magazine != NULL)
+    {
+        pthread_mutex_lock(&magazine->lock);
+    }
+    else
+    {
+        TAKE_BUFFER_LOCK();
+    }
+
+    for (i = 0 ; i < numBuffers ; i++)
+    {
+        buf = bufs[i];
+
+        if (buf == NULL)
+        {
+            continue;
+        }
+
+        if (ReleaseChunk(info, buf) != FM_OK)
+        {
+            err = FM_ERR_INVALID_ARGUMENT;
+            continue;
+        }
+
+        numFreed[buf->bufferType]++;
+
+        if (magazine == NULL)
+        {
+            PushFreeChunk(info, buf->index);
+            continue;
+        }
+
+        if (magazine->count == FM_BUFFER_MAGAZINE_SIZE)
+        {
+            SpillMagazine(info, magazine);
+        }
+
+        magazine->chunks[magazine->count++] = buf->index;
+    }
+
+    if (magazine != NULL)
+    {
+        pthread_mutex_unlock(&magazine->lock);
+    }
+    else
+    {
+        DROP_BUFFER_LOCK();
+    }
+
+    /**************************************************
+     * Count the free events.
+     **************************************************/
+
+    for (i = 0 ; i < FM_NUM_BUFFER_TYPES ; i++)
+    {
+        if (numFreed[i] > 0)
+        {
+            FM_ATOMIC_ADD(&info->availableBuffers[i], numFreed[i]);
+        }
+    }
 
     FM_LOG_DEBUG(FM_LOG_CAT_BUFFER,
-                 "Initialized buffers left: RX: %d TX: %d Total: %d\n",
-                 info->availableBuffers[FM_BUFFER_RX],
-                 info->availableBuffers[FM_BUFFER_TX],
-                 info->availableBuffers[FM_BUFFER_ANY]);
+                 "Freed %d RX, %d TX, %d ANY buffers\n",
+                 numFreed[FM_BUFFER_RX],
+                 numFreed[FM_BUFFER_TX],
+                 numFreed[FM_BUFFER_ANY]);
 
-    FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_OK);
+    if ( numFreed[FM_BUFFER_RX] > 0 || numFreed[FM_BUFFER_ANY] > 0 ||
+         (!info->enableSeparatePool && numFreed[FM_BUFFER_TX] > 0) )
+    {
+        NotifyBufferWaiters();
+    }
 
-}   /* end fmPlatformInitBuffersV2 */
+    FM_LOG_EXIT(FM_LOG_CAT_BUFFER, err);
+
+}   /* end fmPlatformFreeBufferBulk */
 
 
 
 
 /*****************************************************************************/
-/** fmPlatformInitBuffers
+/** fmPlatformGetBufferSize
  * \ingroup intPlatform
  *
- * \desc            Initializes the buffer allocator subsystem
- *
- * \param[in]       bufferMemoryPool points to the caller allocated memory used
- *                  to back the buffer data.
+ * \desc            Returns the size of the data area of every buffer.
  *
- * \return          fm_status code
+ * \return          The buffer size in bytes.
  *
  *****************************************************************************/
-fm_status fmPlatformInitBuffers(fm_uint32 *bufferMemoryPool)
+fm_int fmPlatformGetBufferSize(void)
 {
+    return fmRootPlatform->bufferAllocState.bufferSize;
 
-    return fmPlatformInitBuffersV2(bufferMemoryPool, 0);
-
-}   /* end fmPlatformInitBuffers */
+}   /* end fmPlatformGetBufferSize */
 
 
 
 
 /*****************************************************************************/
-/** fmPlatformAllocateBuffer
- * \ingroup platform
+/** fmPlatformGetBufferPool
+ * \ingroup intPlatform
  *
- * \desc            Allocate a packet buffer.  The buffer is accessed through
- *                  an ''fm_buffer'' structure, which keeps housekeeping
- *                  information for chaining multiple data blocks together.
+ * \desc            Returns the memory backing the data of every buffer.
+ *                  Buffer i starts i buffer sizes into it, which lets a
+ *                  packet backend register the whole pool with the kernel.
  *
- * \return          A pointer to an ''fm_buffer'' structure.
- * \return          NULL is returned if there are no buffers available.
+ * \param[out]      pool points to caller-allocated storage where the start
+ *                  of the memory is written.
+ *
+ * \param[out]      size points to caller-allocated storage where the size
+ *                  of the memory in bytes is written.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNINITIALIZED if the buffers are not initialized.
  *
  *****************************************************************************/
-fm_buffer *fmPlatformAllocateBuffer(void)
+fm_status fmPlatformGetBufferPool(void **pool, fm_uint64 *size)
 {
     fm_bufferAllocState *info;
-    fm_buffer *          ret;
 
-    FM_LOG_ENTRY_NOARGS(FM_LOG_CAT_BUFFER);
-    
     info = &fmRootPlatform->bufferAllocState;
 
-    if (info->enableSeparatePool)
-    {
-        ret = fmPlatformAllocateBufferV2(FM_BUFFER_TX); 
-    }
-    else
+    if (info->pool == NULL || info->table == NULL)
     {
-        ret = fmPlatformAllocateBufferV2(FM_BUFFER_ANY);
+        return FM_ERR_UNINITIALIZED;
     }
 
-    FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_BUFFER, ret, "%p\n", (void *) ret);
+    *pool = info->pool;
+    *size = (fm_uint64) info->bufferSize * info->totalBufferCount;
 
-}   /* end fmPlatformAllocateBuffer */
+    return FM_OK;
+
+}   /* end fmPlatformGetBufferPool */
 
 
 
 
 /*****************************************************************************/
-/** fmPlatformFreeBuffer
- * \ingroup platform
- *
- * \desc            Return a packet buffer, previously allocated with a
- *                  call to ''fmAllocateBuffer'', to the free buffer pool.
+/** fmPlatformGetBufferAtOffset
+ * \ingroup intPlatform
  *
- * \note            If the buffer is part of a chain of buffers, this function
- *                  will not dispose of the other buffers in the chain.  See
- *                  fmFreeBufferChain for disposing of an entire chain.
+ * \desc            Returns the buffer whose data area holds the given
+ *                  offset into the memory returned by
+ *                  ''fmPlatformGetBufferPool''.
  *
- * \param[in]       buf points to the buffer's ''fm_buffer'' structure.
+ * \param[in]       offset is the offset in bytes into the buffer memory.
  *
- * \return          FM_OK
+ * \return          A pointer to the buffer's ''fm_buffer'' structure.
+ * \return          NULL if the offset is outside the buffer memory.
  *
  *****************************************************************************/
-fm_status fmPlatformFreeBuffer(fm_buffer *buf)
+fm_buffer *fmPlatformGetBufferAtOffset(fm_uint64 offset)
 {
     fm_bufferAllocState *info;
-    fm_switch *          switchState;
-    fm_int               switchNum;
-    fm_int               index;
-
-    index = buf->index;
-
-    FM_LOG_ENTRY(FM_LOG_CAT_BUFFER,
-                 "buf = %p, buf->index = %d\n",
-                 (void *) buf, index);
-
-    info = &fmRootPlatform->bufferAllocState;
-
-    TAKE_BUFFER_LOCK();
+    fm_uint64            index;
 
-    /**************************************************
-     * Validate chunk.
-     **************************************************/
+    info  = &fmRootPlatform->bufferAllocState;
+    index = offset / info->bufferSize;
 
-    /* Valid chunk index? */
-    if ( (index >= info->totalBufferCount) ||
-        (index == -1) ||
-        (info->freeList[index] != -2) )
+    if (index >= (fm_uint64) info->totalBufferCount)
     {
-        /* Invalid chunk index. */
-        DROP_BUFFER_LOCK();
-
-        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_INVALID_ARGUMENT);
+        return NULL;
     }
 
-    /**************************************************
-     * Put the chunk back in the free list.
-     **************************************************/
+    return &info->table[index];
 
-    info->freeList[index] = info->firstFree;
-    info->firstFree       = index;
-
-    /**************************************************
-     * Reset its pointer to the base of the chunk
-     **************************************************/
+}   /* end fmPlatformGetBufferAtOffset */
 
-    info->table[index].data = GetBufferMemory(index);
 
-    /* Clear existing values */
-    info->table[index].bufferQueueNode = NULL;
-    info->table[index].recvEvent       = NULL;
 
-    /* The below statements were not there before. Any reason
-     * not to do the following? */
-    info->table[index].len = 0;
-    info->table[index].next = NULL;
 
-    /**************************************************
-     * Count the free event.
-     **************************************************/
+/*****************************************************************************/
+/** fmPlatformInitBufferQueues
+ * \ingroup intPlatform
+ *
+ * \desc            Initializes the priority buffer queues, preallocating
+ *                  one list node per buffer of the pool.
+ *
+ * \param[in]       numBuffers is the number of buffers in the pool.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if the nodes could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmPlatformInitBufferQueues(fm_int numBuffers)
+{
+    fm_priorityBufferQueues *bq;
+    fm_status                err;
+    fm_int                   q;
 
-    info->availableBuffers[buf->bufferType]++;
+    FM_LOG_ENTRY(FM_LOG_CAT_BUFFER, "numBuffers=%d\n", numBuffers);
 
-    FM_LOG_DEBUG(FM_LOG_CAT_BUFFER,
-                 "Freed buffer #%d, %d RX buf left, %d TX buf left," 
-                 "%d ANY buf left\n", 
-                 index,
-                 info->availableBuffers[FM_BUFFER_RX],
-                 info->availableBuffers[FM_BUFFER_TX],
-                 info->availableBuffers[FM_BUFFER_ANY]);
+    bq = &fmRootPlatform->bufferAllocState.bufferQueues;
 
-    DROP_BUFFER_LOCK();
+    bq->nodes     = fmAlloc(sizeof(fm_dlist_node) * numBuffers);
+    bq->nodeQueue = fmAlloc(sizeof(fm_byte) * numBuffers);
 
-    if ( info->enableSeparatePool && buf->bufferType == FM_BUFFER_TX)
+    if (bq->nodes == NULL || bq->nodeQueue == NULL)
     {
-
-        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_OK);
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
     }
 
-    /*************************************************************************
-     * The following should be done only when the separate pool is not enabled
-     * or separate pool is enabled and the buffer type is RX.
-     * 
-     * If any switch's frame receiver could previously  not get a chunk, then 
-     * signal it to try again now that there is one available.
-     *************************************************************************/
+    memset(bq->nodes, 0, sizeof(fm_dlist_node) * numBuffers);
+    memset(bq->nodeQueue, 0, sizeof(fm_byte) * numBuffers);
 
-    for (switchNum = FM_FIRST_FOCALPOINT ;
-         switchNum <= FM_LAST_FOCALPOINT ;
-         switchNum++)
+    for (q = 0 ; q < FM_NUM_PRIORITY_BUFFER_QUEUES ; q++)
     {
-        switchState = fmRootApi->fmSwitchStateTable[switchNum];
+        fmDListInit(&bq->queues[q]);
+        bq->depth[q] = 0;
+    }
 
-        if (switchState && switchState->state == FM_SWITCH_STATE_UP)
+    bq->nonEmptyMask = 0;
+
+    err = fmCreateLock("Buffer Queue Lock", &bq->lock);
+
+ABORT:
+    if (err != FM_OK)
+    {
+        if (bq->nodes != NULL)
         {
-            if (switchState->buffersNeeded)
-            {
-                /* Clear out the flag since we know we have a free buffer */
-                switchState->buffersNeeded      = FALSE;
-                
-                /**************************************************
-                 * We must take a lock before writing
-                 * intrReceivePackets because the lock is used
-                 * by the API to ensure an atomic read-modify-write
-                 * to intrReceivePackets.
-                 *
-                 * The platform lock is used instead of state lock
-                 * because on FIBM platforms, there is an access
-                 * to intrSendPackets that must be protected before
-                 * the switch's locks are even created. 
-                 **************************************************/
-                
-                FM_TAKE_PKT_INT_LOCK(switchNum);
-                switchState->intrReceivePackets = TRUE;
-                FM_DROP_PKT_INT_LOCK(switchNum);
+            fmFree(bq->nodes);
+            bq->nodes = NULL;
+        }
 
-                /* Wake up the interrupt handler so it will see the message. */
-                fmPlatformTriggerInterrupt(switchNum, FM_INTERRUPT_SOURCE_API);
-            }
+        if (bq->nodeQueue != NULL)
+        {
+            fmFree(bq->nodeQueue);
+            bq->nodeQueue = NULL;
         }
     }
 
-    FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_OK);
+    FM_LOG_EXIT(FM_LOG_CAT_BUFFER, err);
 
-}   /* end fmPlatformFreeBuffer */
+}   /* end fmPlatformInitBufferQueues */
 
 
 
 
 /*****************************************************************************/
-/** fmPlatformGetAvailableBuffers
+/** fmPlatformAddBufferChain
  * \ingroup intPlatform
  *
- * \desc            Returns the number of available buffers.
+ * \desc            Appends a received buffer chain to the buffer queue of
+ *                  its switch priority.
  *
- * \param[out]      count points to caller allocated storage where the number
- *                  of available buffers is written.
+ * \param[in,out]   buf points to the first buffer of the chain.
  *
- * \return          fm_status code
+ * \param[in]       pri is the switch priority of the frame.
+ *
+ * \param[in]       isInsertBegin is TRUE to insert the chain at the head of
+ *                  the queue rather than at its tail.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if priority buffer queues are disabled.
+ * \return          FM_ERR_INVALID_ARGUMENT if buf or pri is invalid.
+ * \return          FM_ERR_ALREADY_EXISTS if the chain is already queued.
  *
  *****************************************************************************/
-fm_status fmPlatformGetAvailableBuffers(fm_int *count)
+fm_status fmPlatformAddBufferChain(fm_buffer *buf,
+                                   fm_uint32  pri,
+                                   fm_bool    isInsertBegin)
 {
-    fm_status status;
+    fm_priorityBufferQueues *bq;
+    fm_dlist_node *          node;
+    fm_dlist *               queue;
 
-    FM_LOG_ENTRY(FM_LOG_CAT_BUFFER, "count=%p\n", (void *) count);
+    bq = &fmRootPlatform->bufferAllocState.bufferQueues;
 
-    if (fmRootPlatform->bufferAllocState.enableSeparatePool)
+    if (bq->nodes == NULL)
     {
-        status = fmPlatformGetAvailableBuffersV2(FM_BUFFER_TX, count);
+        return FM_ERR_UNSUPPORTED;
+    }
+
+    if ( (buf == NULL) ||
+         (buf->index < 0) ||
+         (buf->index >= fmRootPlatform->bufferAllocState.totalBufferCount) ||
+         (pri >= FM_NUM_PRIORITY_BUFFER_QUEUES) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    node  = &bq->nodes[buf->index];
+    queue = &bq->queues[pri];
+
+    fmCaptureLock(&bq->lock, FM_WAIT_FOREVER);
+
+    if (buf->bufferQueueNode != NULL)
+    {
+        fmReleaseLock(&bq->lock);
+        return FM_ERR_ALREADY_EXISTS;
+    }
+
+    node->data = buf;
+
+    if (isInsertBegin)
+    {
+        FM_DLL_INSERT_FIRST(queue, head, tail, node, nextPtr, prev);
     }
     else
     {
-        status = fmPlatformGetAvailableBuffersV2(FM_BUFFER_ANY, count);
+        FM_DLL_INSERT_LAST(queue, head, tail, node, nextPtr, prev);
     }
 
-    FM_LOG_EXIT(FM_LOG_CAT_BUFFER, status);
+    bq->nodeQueue[buf->index] = (fm_byte) pri;
+    bq->depth[pri]++;
+    bq->nonEmptyMask |= (1U << pri);
 
-}   /* end fmPlatformGetAvailableBuffers */
+    buf->bufferQueueNode = node;
+
+    fmReleaseLock(&bq->lock);
+
+    return FM_OK;
+
+}   /* end fmPlatformAddBufferChain */
 
 
 
 
 /*****************************************************************************/
-/** fmPlatformGetAvailableBuffersV2
+/** fmPlatformFreeBufferQueueNode
  * \ingroup intPlatform
  *
- * \desc            Returns the number of available buffers in appropriate pool.
- *
- * \param[in]       type specifies the type of buffer pool. 
+ * \desc            Removes the buffer chain of a received frame from its
+ *                  priority buffer queue, in constant time.
  *
- * \param[out]      count points to caller allocated storage where the number
- *                  of available buffers is written.
+ * \param[in]       rcvPktEvent points to the receive event of the frame.
  *
- * \return          fm_status code
+ * \return          FM_OK if successful, including when the chain is not
+ *                  queued.
+ * \return          FM_ERR_UNSUPPORTED if priority buffer queues are disabled.
+ * \return          FM_ERR_INVALID_ARGUMENT if rcvPktEvent is invalid.
  *
  *****************************************************************************/
-fm_status fmPlatformGetAvailableBuffersV2(fm_bufferType type, fm_int *count)
+fm_status fmPlatformFreeBufferQueueNode(fm_eventPktRecv *rcvPktEvent)
 {
-    FM_LOG_ENTRY(FM_LOG_CAT_BUFFER, "count=%p\n", (void *) count);
+    fm_priorityBufferQueues *bq;
+    fm_buffer *              buf;
 
-    if (!count)
+    bq = &fmRootPlatform->bufferAllocState.bufferQueues;
+
+    if (bq->nodes == NULL)
     {
-        FM_LOG_FATAL(FM_LOG_CAT_BUFFER, "Count pointer is null\n");
+        return FM_ERR_UNSUPPORTED;
+    }
 
-        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_INVALID_ARGUMENT);
+    if (rcvPktEvent == NULL || rcvPktEvent->pkt == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
     }
 
-    *count = fmRootPlatform->bufferAllocState.availableBuffers[type];
+    buf = (fm_buffer *) rcvPktEvent->pkt;
 
-    FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_OK);
+    /* Delivered frames are not queued, so skip the lock for them */
+    if (buf->bufferQueueNode == NULL)
+    {
+        return FM_OK;
+    }
 
-}   /* end fmPlatformGetAvailableBuffersV2 */
+    fmCaptureLock(&bq->lock, FM_WAIT_FOREVER);
+
+    if (buf->bufferQueueNode != NULL)
+    {
+        UnlinkQueuedBuffer(bq, buf);
+    }
+
+    fmReleaseLock(&bq->lock);
+
+    return FM_OK;
+
+}   /* end fmPlatformFreeBufferQueueNode */
 
 
 
 
 /*****************************************************************************/
-/** fmPlatformAllocateBufferV2
- * \ingroup platform
+/** fmPlatformGetEvictableBuffer
+ * \ingroup intPlatform
  *
- * \desc            Allocate a packet buffer.  The buffer is accessed through
- *                  an ''fm_buffer'' structure, which keeps housekeeping
- *                  information for chaining multiple data blocks together.
+ * \desc            Finds the oldest queued buffer chain of the lowest
+ *                  switch priority below a given priority, which is the
+ *                  one to give up to receive a frame of that priority.
+ *                  The lookup does not depend on the number of queued
+ *                  frames.
  *
- * \param[in]       type specifies the type of buffer. When the buffer
- *                  is freed, the type is used to handle freeing of the
- *                  buffer to the appropriate pool.
+ * \param[in]       pri is the switch priority of the frame to be received.
  *
- * \return          A pointer to an ''fm_buffer'' structure.
- * \return          NULL if there are no buffers available.
+ * \param[out]      bufPtr points to caller-allocated storage where this
+ *                  function places the first buffer of the chain. The
+ *                  chain is left in its queue.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if priority buffer queues are disabled.
+ * \return          FM_ERR_INVALID_ARGUMENT if bufPtr is NULL.
+ * \return          FM_ERR_NOT_FOUND if no lower-priority chain is queued.
  *
  *****************************************************************************/
-fm_buffer *fmPlatformAllocateBufferV2(fm_bufferType type)
+fm_status fmPlatformGetEvictableBuffer(fm_uint32 pri, fm_buffer **bufPtr)
 {
-    fm_bufferAllocState *info;
-    fm_int               chunk;
-    fm_buffer *          ret;
+    fm_priorityBufferQueues *bq;
+    fm_uint32                mask;
+    fm_status                err;
 
-    FM_LOG_ENTRY_NOARGS(FM_LOG_CAT_BUFFER);
-    
-    info = &fmRootPlatform->bufferAllocState;
+    bq = &fmRootPlatform->bufferAllocState.bufferQueues;
 
-    if ( (!info->enableSeparatePool && type != FM_BUFFER_ANY) ||
-         (info->enableSeparatePool && type == FM_BUFFER_ANY) )
+    if (bq->nodes == NULL)
     {
-        FM_LOG_ERROR(FM_LOG_CAT_BUFFER,
-                     "Conflicting buffer type: %d\n", type);
-        FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_BUFFER, NULL, 
-                           "Conflicting buffer type: %d\n", type);
-        
+        return FM_ERR_UNSUPPORTED;
     }
-    TAKE_BUFFER_LOCK();
 
-    if (info->availableBuffers[type] == 0)
+    if (bufPtr == NULL)
     {
-        DROP_BUFFER_LOCK();
-        FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_BUFFER, NULL, 
-                           "No free buffer available in pool: %d\n", type);
+        return FM_ERR_INVALID_ARGUMENT;
     }
 
-    /**************************************************
-     * Get a chunk from the head of the free list.
-     **************************************************/
+    fmCaptureLock(&bq->lock, FM_WAIT_FOREVER);
 
-    chunk = info->firstFree;
+    mask = bq->nonEmptyMask;
 
-    if (chunk != -1)
+    if (pri < FM_NUM_PRIORITY_BUFFER_QUEUES)
     {
-        info->firstFree       = info->freeList[chunk];
-        info->freeList[chunk] = -2;
-
-        info->availableBuffers[type]--;
-
-        FM_LOG_DEBUG(FM_LOG_CAT_BUFFER,
-                     "Allocated buffer #%d, %d left\n", chunk,
-                     info->availableBuffers[type]);
-
+        mask &= (1U << pri) - 1;
     }
 
-    DROP_BUFFER_LOCK();
-
-    ret = (chunk == -1) ? NULL : &info->table[chunk];
-
-    /* set the next pointer of the allocated buffer to NULL */
-    if (ret)
+    if (mask != 0)
     {
-        ret->next       = NULL;
-        ret->bufferType = type;
+        *bufPtr = bq->queues[__builtin_ctz(mask)].head->data;
+        err     = FM_OK;
+    }
+    else
+    {
+        err = FM_ERR_NOT_FOUND;
     }
 
-    FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_BUFFER, ret, "%p\n", (void *) ret);
+    fmReleaseLock(&bq->lock);
 
-}   /* end fmPlatformAllocateBufferV2 */
+    return err;
+
+}   /* end fmPlatformGetEvictableBuffer */
 
 
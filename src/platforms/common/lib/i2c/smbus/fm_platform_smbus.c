@@ -404,11 +404,12 @@ fm_status fmPlatformSMBusI2cWriteRead(int      fd,
         len = 0;
         off = data[0];
 
-        /* For EEPROM read, need to split into 32 chunks
-         * The rest should always be less than 32 bytes read */
+        /* For EEPROM read, need to split into 32 chunks, the driver
+         * rejects longer I2C block transfers */
         while (len < rl)
         {
-            smbusData.block[0] = rl - len;
+            smbusData.block[0] = ( (rl - len) > I2C_SMBUS_BLOCK_MAX ) ?
+                                 I2C_SMBUS_BLOCK_MAX : (rl - len);
             if ( I2CSmbusAccess(fd, I2C_SMBUS_READ, off + len,
                                 I2C_SMBUS_I2C_BLOCK_DATA,
                                 &smbusData) )
@@ -582,6 +582,21 @@ fm_status fm10000PacketReceiveProcess(fm_int              sw,
 #endif
 
     }   /* end if (IS_TRAP_GLORT(dstGlort)) */
+
+    /**************************************************
+     * Drop the frames the application filtered out
+     * before any event is allocated for them.
+     **************************************************/
+
+    if ( fmRxPacketFilterDrop(sw,
+                              buffer,
+                              srcPort,
+                              vlan,
+                              IS_TRAP_GLORT(dstGlort) ? trapAction : -1) )
+    {
+        fmDbgDiagCountIncr(sw, FM_CTR_RX_PKT_DROPS_FILTER, 1);
+        goto ABORT;
+    }
     
     /**************************************************
      * Allocate event object.
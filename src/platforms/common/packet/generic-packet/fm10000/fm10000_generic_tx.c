@@ -324,6 +324,297 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** GetFcsValue
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Returns the FCS value to send with a packet.
+ *
+ * \param[in]       info points to the packet information structure.
+ *
+ * \param[out]      fcsValue points to caller-allocated storage where this
+ *                  function should place the FCS value.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if the FCS mode is invalid.
+ *
+ *****************************************************************************/
+static fm_status GetFcsValue(fm_packetInfoV2 *info, fm_uint32 *fcsValue)
+{
+    switch (info->fcsMode)
+    {
+        case FM_FCS_MODE_DEFAULT:
+        case FM_FCS_MODE_VALUE:
+            *fcsValue = info->fcsValue;
+            break;
+
+        case FM_FCS_MODE_ZERO:
+            *fcsValue = 0;
+            break;
+
+        case FM_FCS_MODE_TIMESTAMP:
+            *fcsValue = 0x00000080;
+            break;
+
+        default:
+            return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    return FM_OK;
+
+}   /* end GetFcsValue */
+
+
+
+
+/*****************************************************************************/
+/** CompileTxDestinationISL
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Fills in the ISL tag templates of a TX destination with
+ *                  everything ''fm10000GeneratePacketISL'' derives from
+ *                  switch state for a directed frame: the source and
+ *                  destination glorts, the default VLAN of the CPU port and
+ *                  the VLAN1 EtherTypes its parser recognizes.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   dest points to the TX destination, already processed by
+ *                  ''fmGenericCompileTxDestination''.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status CompileTxDestinationISL(fm_int sw, fm_txDestination *dest)
+{
+    fm_txDestinationPort *destPort;
+    fm_status             err;
+    fm_int                switchNum;
+    fm_int                physPort;
+    fm_uint32             numEtherTypes;
+    fm_uint32             sglort;
+    fm_uint32             dglort;
+    fm_bool               regLockTaken;
+    fm_int                i;
+
+    regLockTaken = FALSE;
+
+    if (dest->sourcePort < 0)
+    {
+        sglort = 0;
+    }
+    else if (dest->sourcePort == dest->cpuPort)
+    {
+        err = fm10000GetTrapGlort(sw, &sglort);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+    }
+    else
+    {
+        err = fmGetLogicalPortGlort(sw, dest->sourcePort, &sglort);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+    }
+
+    err = fmGetPortDefVlanInt(sw, dest->cpuPort, &dest->cpuDefVlan);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+    err = fmPlatformMapLogicalPortToPhysical(sw,
+                                             dest->cpuPort,
+                                             &switchNum,
+                                             &physPort);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+    /* vlanEtherTypes holds FM_TX_DESTINATION_VLAN_TYPES (at least
+     * MAX_VLAN_ETHER_TYPES) entries. */
+    FM_FLAG_TAKE_REG_LOCK(sw);
+
+    err = fm10000GetVlanTypes(sw,
+                              physPort,
+                              VLAN1_TAG,
+                              dest->vlanEtherTypes,
+                              &numEtherTypes);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+    FM_FLAG_DROP_REG_LOCK(sw);
+
+    dest->numVlanEtherTypes = numEtherTypes;
+
+    for (i = 0 ; i < dest->numPorts ; i++)
+    {
+        destPort = &dest->ports[i];
+
+        if (destPort->skip)
+        {
+            continue;
+        }
+
+        err = fmGetLogicalPortGlort(sw, destPort->port, &dglort);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+        /* Directed frames are always special delivery, with a zero user
+         * field and vtype. The swpri and VLAN are added per frame. */
+        destPort->islTagFormat = FM_ISL_TAG_F56;
+
+        destPort->islTag.f56.tag[0] =
+            (FM_FTYPE_SPECIAL_DELIVERY & FM_F56_FTYPE_MASK) << FM_F56_FTYPE_POS;
+
+        destPort->islTag.f56.tag[1] =
+            ( (sglort & FM_F56_SGLORT_MASK) << FM_F56_SGLORT_POS) |
+            ( (dglort & FM_F56_DGLORT_MASK) << FM_F56_DGLORT_POS);
+    }
+
+ABORT:
+    if (regLockTaken)
+    {
+        FM_FLAG_DROP_REG_LOCK(sw);
+    }
+
+    return err;
+
+}   /* end CompileTxDestinationISL */
+
+
+
+
+/*****************************************************************************/
+/** SendToTxDestination
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Completes the ISL tag templates of a compiled TX
+ *                  destination for one frame and queues the frame to every
+ *                  destination port whose link is up.
+ *
+ * \param[in]       sw is the switch on which to send the packet.
+ *
+ * \param[in]       dest points to the compiled TX destination.
+ *
+ * \param[in]       packet points to the packet buffer's first ''fm_buffer''
+ *                  structure in a chain of one or more buffers.
+ *
+ * \param[in]       fcsValue is the value to be sent in the FCS field.
+ *
+ * \param[in]       switchPriority is the switch priority.
+ *
+ * \param[in]       txCookie is reported to the TX completion handler once
+ *                  the packet has been sent to every port, NULL if none.
+ *
+ * \param[in]       noWait is TRUE to fail rather than wait for the TX
+ *                  packet queue lock.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if packet is not a valid buffer.
+ * \return          FM_ERR_FRAME_TOO_LARGE if the packet exceeds the maximum
+ *                  frame size for the CPU port.
+ * \return          FM_ERR_INVALID_PORT_STATE if no destination port is up.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status SendToTxDestination(fm_int            sw,
+                                     fm_txDestination *dest,
+                                     fm_buffer *       packet,
+                                     fm_uint32         fcsValue,
+                                     fm_uint32         switchPriority,
+                                     void *            txCookie,
+                                     fm_bool           noWait)
+{
+    fm_txDestinationPort *destPort;
+    fm_int                packetLength;
+    fm_int                numEntries;
+    fm_int                i;
+    fm_uint32             outerHeader;
+    fm_uint16             outerEtherType;
+    fm_uint16             vpriVlan;
+    fm_byte               swpri;
+    fm_uint32             tag0;
+    fm_int                entryPorts[dest->numPorts];
+    fm_islTagFormat       islTagFormats[dest->numPorts];
+    fm_islTag             islTags[dest->numPorts];
+    fm_bool               suppressVlanTags[dest->numPorts];
+
+    packetLength = fmComputeTotalPacketLength(packet);
+    if (packetLength <= 0)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    if (packetLength > dest->cpuMaxFrameSize - 4)
+    {
+        return FM_ERR_FRAME_TOO_LARGE;
+    }
+
+    /* Outer VLAN1 tag or the CPU port's default VLAN */
+    outerHeader    = ntohl(packet->data[FM_PACKET_OFFSET_ETHERTYPE]);
+    outerEtherType = (outerHeader >> 16) & 0xffff;
+    vpriVlan       = dest->cpuDefVlan;
+
+    for (i = 0 ; i < dest->numVlanEtherTypes ; i++)
+    {
+        if (outerEtherType == dest->vlanEtherTypes[i])
+        {
+            vpriVlan = outerHeader & 0xFFFF;
+            break;
+        }
+    }
+
+    /* Directed frames never take their switch priority from the VLAN */
+    swpri = (switchPriority != FM_USE_VLAN_PRIORITY) ? (switchPriority & 0xf)
+                                                     : 0;
+
+    tag0 = ( (swpri    & FM_F56_SWPRI_MASK)   << FM_F56_SWPRI_POS) |
+           ( (vpriVlan & FM_F56_VPRIVLAN_MASK << FM_F56_VPRIVLAN_POS));
+
+    numEntries = 0;
+
+    for (i = 0 ; i < dest->numPorts ; i++)
+    {
+        destPort = &dest->ports[i];
+
+        if (destPort->skip)
+        {
+            continue;
+        }
+
+        /* Filter out down ports, LAGs are not checked */
+        if ( !destPort->isLag && !fmIsPortLinkUp(sw, destPort->port) )
+        {
+            continue;
+        }
+
+        entryPorts[numEntries]       = destPort->port;
+        islTagFormats[numEntries]    = destPort->islTagFormat;
+        islTags[numEntries]          = destPort->islTag;
+        suppressVlanTags[numEntries] = FALSE;
+
+        islTags[numEntries].f56.tag[0] |= tag0;
+
+        numEntries++;
+    }
+
+    if (numEntries == 0)
+    {
+        return FM_ERR_INVALID_PORT_STATE;
+    }
+
+    return fmGenericEnqueueDirectedPacket(sw,
+                                          packet,
+                                          packetLength,
+                                          fcsValue,
+                                          switchPriority,
+                                          numEntries,
+                                          entryPorts,
+                                          islTagFormats,
+                                          islTags,
+                                          suppressVlanTags,
+                                          txCookie,
+                                          noWait);
+
+}   /* end SendToTxDestination */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -378,24 +669,8 @@ fm_status fm10000GenericSendPacketDirected(fm_int           sw,
                  numPorts,
                  packet->index);
 
-    switch (info->fcsMode)
-    {
-        case FM_FCS_MODE_DEFAULT:
-        case FM_FCS_MODE_VALUE:
-            fcsValue = info->fcsValue;
-            break;
-
-        case FM_FCS_MODE_ZERO:
-            fcsValue = 0;
-            break;
-
-        case FM_FCS_MODE_TIMESTAMP:
-            fcsValue = 0x00000080;
-            break;
-
-        default:
-            FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_INVALID_ARGUMENT);
-    }
+    err = GetFcsValue(info, &fcsValue);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
     err = fmGetCpuPortInt(sw, &cpuPort);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
@@ -407,7 +682,9 @@ fm_status fm10000GenericSendPacketDirected(fm_int           sw,
                                       packet,
                                       fcsValue,
                                       cpuPort,
-                                      info->switchPriority);
+                                      info->switchPriority,
+                                      info->txCookie,
+                                      info->noWait);
 
     FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
 
@@ -416,6 +693,145 @@ fm_status fm10000GenericSendPacketDirected(fm_int           sw,
 
 
 
+/*****************************************************************************/
+/** fm10000GenericCreateTxDestination
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Allocates a TX destination handle for a list of ports.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       portList points to an array of logical port numbers.
+ *
+ * \param[in]       numPorts is the number of elements in portList.
+ *
+ * \param[out]      destHandle points to caller-allocated storage where
+ *                  this function should place the handle.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fm10000GenericCreateTxDestination(fm_int  sw,
+                                            fm_int *portList,
+                                            fm_int  numPorts,
+                                            fm_int *destHandle)
+{
+    return fmGenericCreateTxDestination(sw, portList, numPorts, destHandle);
+
+}   /* end fm10000GenericCreateTxDestination */
+
+
+
+
+/*****************************************************************************/
+/** fm10000GenericDeleteTxDestination
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Releases a TX destination handle.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       destHandle is the handle to release.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fm10000GenericDeleteTxDestination(fm_int sw, fm_int destHandle)
+{
+    return fmGenericDeleteTxDestination(sw, destHandle);
+
+}   /* end fm10000GenericDeleteTxDestination */
+
+
+
+
+/*****************************************************************************/
+/** fm10000GenericSendPacketTxDestination
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Sends a packet to the ports of a TX destination handle.
+ *                  The handle is compiled on first use and again after any
+ *                  port, LAG or glort configuration change; otherwise the
+ *                  port validation and ISL tag resolution done by
+ *                  ''fm10000GenericSendPacketDirected'' are skipped.
+ *
+ * \param[in]       sw is the switch on which to send the packet.
+ *
+ * \param[in]       destHandle is the TX destination handle.
+ *
+ * \param[in]       packet points to the packet buffer's first ''fm_buffer''
+ *                  structure in a chain of one or more buffers.
+ *
+ * \param[in]       info is a pointer to the packet information structure.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fm10000GenericSendPacketTxDestination(fm_int           sw,
+                                                fm_int           destHandle,
+                                                fm_buffer *      packet,
+                                                fm_packetInfoV2 *info)
+{
+    fm_switch *       switchPtr;
+    fm_txDestination *dest;
+    fm_status         err;
+    fm_int            cpuPort;
+    fm_uint32         fcsValue;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
+                 "sw = %d, destHandle = %d, packet->index = 0x%x\n",
+                 sw,
+                 destHandle,
+                 packet->index);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    err = GetFcsValue(info, &fcsValue);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+    err = fmGetCpuPortInt(sw, &cpuPort);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+    err = fmGenericAcquireTxDestination(sw, destHandle, &dest);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+    if ( !dest->compiled ||
+         (dest->cpuPort != cpuPort) ||
+         (dest->generation != FM_ATOMIC_LOAD(&switchPtr->txDestGeneration)) )
+    {
+        err = fmGenericCompileTxDestination(sw, dest, cpuPort);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+        err = CompileTxDestinationISL(sw, dest);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+        dest->compiled = TRUE;
+    }
+
+    err = SendToTxDestination(sw,
+                              dest,
+                              packet,
+                              fcsValue,
+                              info->switchPriority,
+                              info->txCookie,
+                              info->noWait);
+
+ABORT:
+    fmGenericReleaseTxDestination(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+}   /* end fm10000GenericSendPacketTxDestination */
+
+
+
+
 /*****************************************************************************/
 /** fm10000GenericSendPacketSwitched
  * \ingroup intPlatformCommon
@@ -375,6 +375,38 @@ ABORT:
 }   /* end FilterPortList */
 
 
+
+
+/*****************************************************************************/
+/** GetTxMasterSwitch
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Returns the switch through which packets of a switch
+ *                  are sent. FIBM slaves send through their master switch,
+ *                  or through themselves in standalone NIC mode.
+ *
+ * \param[in]       sw is the switch on which to send the packet.
+ *
+ * \return          The switch number to send through.
+ *
+ *****************************************************************************/
+static fm_int GetTxMasterSwitch(fm_int sw)
+{
+    fm_int masterSw;
+
+    if (!fmRootApi->isSwitchFibmSlave[sw])
+    {
+        return sw;
+    }
+
+    masterSw = fmFibmSlaveGetMasterSwitch(sw);
+
+    /* In standalone NIC mode, the master is also the same as the slave. */
+    return (masterSw < 0) ? sw : masterSw;
+
+}   /* end GetTxMasterSwitch */
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -384,36 +416,74 @@ ABORT:
 /** fmPacketQueueLock
  * \ingroup intPlatformCommon
  *
- * \desc            Lock packet queue.
+ * \desc            Lock packet queue for a producer.
+ *
+ * \note            The consumer side of the queue does not take this lock,
+ *                  see ''fmPacketQueueDrainLock''.
  *
  * \param[in]       queue is the pointer to the packet queue.
  *
- * \return          NONE
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNABLE_TO_LOCK if the queue's mutex could not be
+ *                  taken, in which case ''fmPacketQueueUnlock'' must not
+ *                  be called.
  *
  *****************************************************************************/
-void fmPacketQueueLock(fm_packetQueue *queue)
+fm_status fmPacketQueueLock(fm_packetQueue *queue)
 {
-#if 1
     if (pthread_mutex_lock(&queue->mutex))
     {
         FM_LOG_ASSERT(FM_LOG_CAT_EVENT_PKT_TX, 
                       FALSE,
                       "Failed to lock queue's mutex!\n");
+        return FM_ERR_UNABLE_TO_LOCK;
     }
-#else
-    TAKE_PLAT_LOCK(queue->switchNum, FM_PLAT_INFO);
-#endif
+
+    queue->lockDepth++;
+
+    return FM_OK;
 
 }   /* end fmPacketQueueLock */
 
 
 
 
+/*****************************************************************************/
+/** fmPacketQueueTryLock
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Lock packet queue for a producer, unless another
+ *                  producer holds it.
+ *
+ * \param[in]       queue is the pointer to the packet queue.
+ *
+ * \return          TRUE if the lock was taken.
+ * \return          FALSE if the lock is held by another thread.
+ *
+ *****************************************************************************/
+fm_bool fmPacketQueueTryLock(fm_packetQueue *queue)
+{
+    if (pthread_mutex_trylock(&queue->mutex))
+    {
+        return FALSE;
+    }
+
+    queue->lockDepth++;
+
+    return TRUE;
+
+}   /* end fmPacketQueueTryLock */
+
+
+
+
 /*****************************************************************************/
 /** fmPacketQueueUnlock
  * \ingroup intPlatformCommon
  *
- * \desc            Unlock packet queue.
+ * \desc            Unlock packet queue. When the outermost lock is dropped,
+ *                  the entries staged at the push index are published to
+ *                  the consumer.
  *
  * \param[in]       queue is the pointer to the packet queue.
  *
@@ -422,16 +492,17 @@ void fmPacketQueueLock(fm_packetQueue *queue)
  *****************************************************************************/
 void fmPacketQueueUnlock(fm_packetQueue *queue)
 {
-#if 1
+    if (--queue->lockDepth == 0)
+    {
+        FM_ATOMIC_STORE(&queue->publishIndex, queue->pushIndex);
+    }
+
     if (pthread_mutex_unlock(&queue->mutex))
     {
         FM_LOG_ASSERT(FM_LOG_CAT_EVENT_PKT_TX, 
                       FALSE,
                       "Failed to unlock queue's mutex!\n");
     }
-#else
-    DROP_PLAT_LOCK(queue->switchNum, FM_PLAT_INFO);
-#endif
 
 }   /* end fmPacketQueueUnlock */
 
@@ -439,1279 +510,2290 @@ void fmPacketQueueUnlock(fm_packetQueue *queue)
 
 
 /*****************************************************************************/
-/** fmPacketQueueInit
+/** fmPacketQueueDrainLock
  * \ingroup intPlatformCommon
  *
- * \desc            Initialize packet queue.
+ * \desc            Lock packet queue for the consumer. Only serializes
+ *                  concurrent drains; producers are not blocked.
  *
  * \param[in]       queue is the pointer to the packet queue.
  *
- * \param[in]       sw is the switch number.
- *
- * \return          FM_OK if successful.
- * \return          Other ''Status Codes'' as appropriate in case of
- *                  failure.
+ * \return          NONE
  *
  *****************************************************************************/
-fm_status fmPacketQueueInit(fm_packetQueue *queue, fm_int sw)
+void fmPacketQueueDrainLock(fm_packetQueue *queue)
 {
-    /* Initialize mutex if it is enabled */
-    pthread_mutexattr_t attr;
-
-    if (!queue) 
+    if (pthread_mutex_lock(&queue->drainMutex))
     {
-        return FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ASSERT(FM_LOG_CAT_EVENT_PKT_TX, 
+                      FALSE,
+                      "Failed to lock queue's drain mutex!\n");
     }
 
-    memset(queue, 0, sizeof(*queue));
-    queue->switchNum = sw;
+}   /* end fmPacketQueueDrainLock */
 
-    if ( pthread_mutexattr_init(&attr) )
-    {
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_LOCK_INIT);
-    }
 
-    if ( pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE) ||
-         pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) )
-    {
-        pthread_mutexattr_destroy(&attr);
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_LOCK_INIT);
-    }
 
-    if ( pthread_mutex_init(&queue->mutex, &attr) )
-    {
-        pthread_mutexattr_destroy(&attr);
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_LOCK_INIT);
-    }
 
-    if ( pthread_mutexattr_destroy(&attr) )
+/*****************************************************************************/
+/** fmPacketQueueDrainUnlock
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Unlock packet queue for the consumer.
+ *
+ * \param[in]       queue is the pointer to the packet queue.
+ *
+ * \return          NONE
+ *
+ *****************************************************************************/
+void fmPacketQueueDrainUnlock(fm_packetQueue *queue)
+{
+    if (pthread_mutex_unlock(&queue->drainMutex))
     {
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_LOCK_INIT);
+        FM_LOG_ASSERT(FM_LOG_CAT_EVENT_PKT_TX, 
+                      FALSE,
+                      "Failed to unlock queue's drain mutex!\n");
     }
 
-    return FM_OK;
-
-}   /* end fmPacketQueueInit */
+}   /* end fmPacketQueueDrainUnlock */
 
 
 
 
 /*****************************************************************************/
-/** fmPacketQueueFree
+/** fmPacketQueueGetTail
  * \ingroup intPlatformCommon
  *
- * \desc            Free all buffers in packet queue.
+ * \desc            Returns the index one past the last entry published to
+ *                  the consumer. All entries between the pull index and
+ *                  the returned index are fully written.
  *
- * \param[in]       sw is the switch number.
+ * \param[in]       queue is the pointer to the packet queue.
  *
- * \return          FM_OK if successful.
- * \return          Other ''Status Codes'' as appropriate in case of
- *                  failure.
+ * \return          The published tail index.
  *
  *****************************************************************************/
-fm_status fmPacketQueueFree(fm_int sw)
+fm_uint fmPacketQueueGetTail(fm_packetQueue *queue)
 {
-    fm_status       err       = FM_OK;
-    fm_packetQueue *txQueue;
-    fm_packetEntry *packet;
+    return FM_ATOMIC_LOAD(&queue->publishIndex);
 
-    txQueue = &GET_PLAT_PKT_STATE(sw)->txQueue;
-    fmPacketQueueLock(txQueue);
+}   /* end fmPacketQueueGetTail */
 
-    for ( ;
-          txQueue->pullIndex != txQueue->pushIndex ;
-          txQueue->pullIndex = (txQueue->pullIndex + 1) % FM_PACKET_QUEUE_SIZE)
-    {
-        packet = &txQueue->packetQueueList[txQueue->pullIndex];
 
-        if (packet && packet->freePacketBuffer)
-        {
-            fmFreeBuffer(sw, packet->packet);
-        }
 
-        fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_TX_BUFFER_FREES, 1);
 
-    }
+/*****************************************************************************/
+/** fmPacketQueueNextIndex
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Returns the queue index following the given one.
+ *
+ * \param[in]       queue is the pointer to the packet queue.
+ *
+ * \param[in]       index is the current index.
+ *
+ * \return          The next index, wrapping at the queue size.
+ *
+ *****************************************************************************/
+fm_uint fmPacketQueueNextIndex(fm_packetQueue *queue, fm_uint index)
+{
+    return (index + 1) % queue->size;
 
-    fmPacketQueueUnlock(txQueue);
+}   /* end fmPacketQueueNextIndex */
 
-    return err;
 
-}   /* end fmPacketQueueFree */
+
+
+/*****************************************************************************/
+/** fmPacketQueueAdvance
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Retires the entry at the pull index, handing its slot
+ *                  back to the producers. Must be called with the drain
+ *                  lock held, after the entry is no longer referenced.
+ *
+ * \param[in]       queue is the pointer to the packet queue.
+ *
+ * \return          NONE
+ *
+ *****************************************************************************/
+void fmPacketQueueAdvance(fm_packetQueue *queue)
+{
+    FM_ATOMIC_STORE(&queue->pullIndex,
+                    fmPacketQueueNextIndex(queue, queue->pullIndex));
+
+}   /* end fmPacketQueueAdvance */
 
 
 
 
 /*****************************************************************************/
-/** fmPacketQueueUpdate
+/** fmPacketQueueRetire
  * \ingroup intPlatformCommon
  *
- * \desc            Update packet queue by advancing one entry
+ * \desc            Retires the entry at the pull index once the consumer
+ *                  is done with it: drops the entry's reference on its
+ *                  packet buffer, records its TX completion, if any, and
+ *                  advances the pull index. Must be called with the drain
+ *                  lock held.
+ *
+ * \param[in]       sw is the switch number.
  *
  * \param[in]       queue is the pointer to the packet queue.
  *
- * \return          FM_OK if successful.
- * \return          FM_ERR_TX_PACKET_QUEUE_FULL if queue if full.
+ * \param[in]       status is the outcome reported for the entry, FM_OK if
+ *                  it was handed to the host interface.
+ *
+ * \param[in,out]   batch points to the completions gathered by the
+ *                  consumer during this pass. It is flushed early if full.
+ *
+ * \return          NONE
  *
  *****************************************************************************/
-fm_status fmPacketQueueUpdate(fm_packetQueue *queue)
+void fmPacketQueueRetire(fm_int                sw,
+                         fm_packetQueue *      queue,
+                         fm_status             status,
+                         fm_txCompletionBatch *batch)
 {
+    fm_packetEntry *entry;
 
-    /* check if the Tx queue is full */
-    if ( (queue->pushIndex + 1) % FM_PACKET_QUEUE_SIZE == queue->pullIndex )
+    entry = &queue->packetQueueList[queue->pullIndex];
+
+    if (entry->freePacketBuffer)
     {
-        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
-                     "fmPacketQueueUpdate:"
-                     "TX queue is full?: pushIndex = %d, pullIndex = %d\n",
-                     queue->pushIndex, queue->pullIndex);
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_TX_PACKET_QUEUE_FULL);
+        /* ignore the error code since it's better to continue */
+        (void) fmReleaseBufferChain(sw, entry->packet);
+
+        fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_TX_BUFFER_FREES, 1);
     }
-    else
+
+    if (entry->txCookie != NULL)
     {
-        /* updated indices */
-        ++queue->pushIndex;
-        queue->pushIndex = queue->pushIndex % FM_PACKET_QUEUE_SIZE;
+        if (batch->numCompletions == FM_TX_COMPLETION_BATCH_SIZE)
+        {
+            fmPacketFlushTxCompletions(sw, batch);
+        }
+
+        batch->completions[batch->numCompletions].cookie = entry->txCookie;
+        batch->completions[batch->numCompletions].status = status;
+        batch->numCompletions++;
     }
 
-    return FM_OK;
+    fmPacketQueueAdvance(queue);
 
-}   /* end fmPacketQueueUpdate */
+}   /* end fmPacketQueueRetire */
 
 
 
 
 /*****************************************************************************/
-/** fmPacketQueueEnqueue
+/** fmPacketFlushTxCompletions
  * \ingroup intPlatformCommon
  *
- * \desc            Queue packet to the tx packet queue
+ * \desc            Reports the completions gathered in a batch to the
+ *                  switch's TX completion handler, if one is registered,
+ *                  and empties the batch.
  *
- * \param[in]       queue is the pointer to the packet queue.
+ * \param[in]       sw is the switch number.
  *
- * \param[in]       packet is the buffer containing the packet.
+ * \param[in,out]   batch points to the completions to report.
  *
- * \param[in]       packetLength is the length of the packet.
+ * \return          NONE
  *
- * \param[in]       islTag is the pointer containing ISL tag words.
- * 
- * \param[in]       islTagFormat is the isl tag format.
+ *****************************************************************************/
+void fmPacketFlushTxCompletions(fm_int sw, fm_txCompletionBatch *batch)
+{
+    fm_switch *            switchPtr;
+    fm_txCompletionHandler handler;
+
+    if (batch->numCompletions == 0)
+    {
+        return;
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    handler   = FM_ATOMIC_LOAD(&switchPtr->txCompletionHandler);
+
+    if (handler != NULL)
+    {
+        handler(sw,
+                batch->numCompletions,
+                batch->completions,
+                FM_ATOMIC_LOAD(&switchPtr->txCompletionCookie));
+    }
+
+    batch->numCompletions = 0;
+
+}   /* end fmPacketFlushTxCompletions */
+
+
+
+
+/*****************************************************************************/
+/** fmPacketQueueSelect
+ * \ingroup intPlatformCommon
  *
- * \param[in]       suppressVlanTag is the flag to indicate whether
- *                  to suppress the vlan tag in the data.
+ * \desc            Returns the TX packet queue serving the given switch
+ *                  priority.
  *
- * \param[in]       freeBuffer is the flag to indicate whether
- *                  to free the packet buffer or not.
+ * \param[in]       sw is the switch number.
  *
- * \return          FM_OK if successful.
- * \return          Other ''Status Codes'' as appropriate in case of
- *                  failure.
+ * \param[in]       switchPriority is the switch priority of the packet.
+ *                  Out of range values, including FM_USE_VLAN_PRIORITY,
+ *                  select FM_PACKET_TX_QUEUE_DEFAULT.
+ *
+ * \return          Pointer to the packet queue.
  *
  *****************************************************************************/
-fm_status fmPacketQueueEnqueue(fm_packetQueue * queue,
-                               fm_buffer *      packet,
-                               fm_int           packetLength,
-                               fm_islTag *      islTag,
-                               fm_islTagFormat  islTagFormat,
-                               fm_bool          suppressVlanTag,
-                               fm_bool          freeBuffer)
+fm_packetQueue *fmPacketQueueSelect(fm_int sw, fm_uint32 switchPriority)
 {
-    fm_packetEntry *entry;
-
-    entry = &queue->packetQueueList[queue->pushIndex];
-
-    entry->packet = packet;
-    entry->length = packetLength;
-    entry->fcsVal = FM_USE_DEFAULT_FCS;
-    FM_MEMCPY_S( &entry->islTag,
-                 sizeof(entry->islTag),
-                 islTag,
-                 sizeof(fm_islTag) );
-    entry->islTagFormat = islTagFormat;
-    entry->suppressVlanTag  = suppressVlanTag;
-    entry->freePacketBuffer = freeBuffer;
-
-    FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
-                 "fm_packet_queue_enqueue: packet queued "
-                 "in slot %d, length %d bytes\n",
-                 queue->pushIndex,
-                 entry->length);
+    fm_int tc;
 
-    /* check if the Tx queue is full */
-    if ( (queue->pushIndex + 1) % FM_PACKET_QUEUE_SIZE == queue->pullIndex )
+    if (switchPriority < FM_SWITCH_PRIORITY_MAX)
     {
-        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
-                     "fm_packet_queue_enqueue:"
-                     "TX queue is full?: pushIndex = %d, pullIndex = %d\n",
-                     queue->pushIndex, queue->pullIndex);
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_TX_PACKET_QUEUE_FULL);
+        tc = (switchPriority * FM_PACKET_TX_QUEUES) / FM_SWITCH_PRIORITY_MAX;
     }
     else
     {
-        /* updated indices */
-        ++queue->pushIndex;
-        queue->pushIndex = queue->pushIndex % FM_PACKET_QUEUE_SIZE;
+        tc = FM_PACKET_TX_QUEUE_DEFAULT;
     }
 
-    return FM_OK;
+    return &GET_PLAT_PKT_STATE(sw)->txQueue[tc];
 
-}   /* end fmPacketQueueEnqueue */
+}   /* end fmPacketQueueSelect */
 
 
 
 
 /*****************************************************************************/
-/** fmPacketReceiveEnqueue
+/** fmPacketQueueGetNextToDrain
  * \ingroup intPlatformCommon
  *
- * \desc            Processes a complete received packet event and
- *                  tries to send it upward.
- *
- * \note            This is an optimized version for packet processing without
- *                  any locking. The input parameters should already been
- *                  validated before calling this function.
- *
- * \param[in]       sw is the switch to send the event for.
+ * \desc            Returns the highest priority TX packet queue with
+ *                  published entries. Consumers call this again after each
+ *                  batch, so a lower priority queue is only serviced while
+ *                  all higher priority queues are empty.
  *
- * \param[in]       event is a fully filled event structure.
+ * \param[in]       sw is the switch number.
  *
- * \param[in]       selfTestEventHandler is a pointer to the event handler.
- *
- * \return          FM_OK if successful
- * \return          Other ''Status Codes'' as appropriate in case of
- *                  failure.
+ * \return          Pointer to the packet queue, NULL if all queues are
+ *                  empty.
  *
  *****************************************************************************/
-fm_status fmPacketReceiveEnqueue(fm_int     sw,
-                                 fm_event * event,
-                                 fm_switchEventHandler selfTestEventHandler)
+fm_packetQueue *fmPacketQueueGetNextToDrain(fm_int sw)
 {
-    fm_eventPktRecv *pktEvent = &event->info.fpPktEvent;
-    fm_status               err      = FM_OK;
-    fm_bool                 isLacpToBeDropped;
-    fm_bool                 isPktSFlowLogged;
-    fm_switchEventHandler   switchEventHandler;
-    fm_switch              *switchPtr;
-    fm_bool                 enableFramePriority;
-
-    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_RX,
-                 "sw = %d, event->type = %d, event->sw = %d, "
-                 "event->eventID = %d\n",
-                 sw,
-                 event->type,
-                 event->sw,
-                 event->eventID);
-
-    switchPtr = GET_SWITCH_PTR(sw);
-
-    switchEventHandler = switchPtr->eventHandler;
-
-#ifdef __FM_FM_PRIORITY_BUFFER_QUEUES_H
-    enableFramePriority = fmRootPlatform->enablePriorityScheduling; 
-#else
-    enableFramePriority = FALSE;
-#endif
+    fm_packetHandlingState *ps;
+    fm_packetQueue *        queue;
+    fm_int                  tc;
 
-    /***************************************************
-     * Check the LACP filter configuration based on the
-     * switch the event is associated with, not the
-     * switch the frame was received on.  These are
-     * potentially different in an FIBM environment.
-     **************************************************/
-    fmCheckLACPFilter(event->sw, pktEvent, &isLacpToBeDropped);
+    ps = GET_PLAT_PKT_STATE(sw);
 
-    if (!isLacpToBeDropped)
+    for (tc = FM_PACKET_TX_QUEUES - 1 ; tc >= 0 ; tc--)
     {
-        /* Check if the packet is logged by a sFlow instance */
-        if (switchPtr->CheckSFlowLogging)
-        {
-            (void)switchPtr->CheckSFlowLogging(sw, pktEvent, &isPktSFlowLogged);
-
-            if (isPktSFlowLogged)
-            {
-                /* Change the type to FM_EVENT_SFLOW_PKT_RECV */
-                event->type = FM_EVENT_SFLOW_PKT_RECV;
-            }
-        }
-        
-        /* Don't do a direct enqueue if in self-test */
-        if (GET_PLAT_PKT_STATE(sw)->rxDirectEnqueueing &&
-            switchEventHandler != selfTestEventHandler)
-        {
-            /* Pass directly up to the application */
-            if (fmEventHandler != NULL)
-            {
-                if (enableFramePriority)
-                {
-                    err = fmFreeBufferQueueNode(sw, pktEvent);
-                    if (err == FM_ERR_NOT_FOUND)
-                    {
-                        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_RX,
-                                     "Node with buffer of priority: %d "
-                                     "already removed. Should have been"
-                                     " flushed due to prioritized allocation",
-                                     pktEvent->priority);
-                        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, FM_OK);
-                    }
-                    if (err != FM_OK)
-                    {
-                        FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
-                                     "Freeing Buffer queue node from the queue failed"
-                                     "status = %d (%s) \n",
-                                      err,
-                                      fmErrorMsg(err));
-                        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, err);
-                    }
-                }
-
-                fmEventHandler(event->type, event->sw, &event->info);
-                /* Don't need to release event, since event structure
-                 * is on the stack for direct enqueueing method
-                 */
-            }
-            else
-            {
-                if (enableFramePriority)
-                {
-                    err = fmFreeBufferQueueNode(sw, pktEvent);
-                    if (err == FM_ERR_NOT_FOUND)
-                    {
-                        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_RX,
-                                     "Node already removed. Should have been"
-                                     " flushed due to prioritized allocation");
-                        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, FM_OK);
-                    }
-                    else if (err != FM_OK)
-                    {
-                        FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
-                                     "Freeing Buffer queue node from the queue failed"
-                                     "status = %d (%s) \n",
-                                      err,
-                                      fmErrorMsg(err));
-                        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, err);
-
-                    }
-                }
-                /* Drop the packet without forwarding it. */
-                fmFreeBufferChain(sw, (fm_buffer *) pktEvent->pkt);
-                fmDbgDiagCountIncr(sw, FM_CTR_RX_PKT_DROPS_NO_PORT, 1);
-            }
-            FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, FM_OK);
-        }
-        else
-        {
-            err = fmSendThreadEvent(&fmRootApi->eventThread, event);
-
-            if (err != FM_OK)
-            {
-                if (enableFramePriority)
-                {
-                    err = fmFreeBufferQueueNode(sw, pktEvent);
-                    if (err == FM_ERR_NOT_FOUND)
-                    {
-                        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_RX,
-                                     "Node already removed. Should have been"
-                                     " flushed due to prioritized allocation");
+        queue = &ps->txQueue[tc];
 
-                        /* Buffer and Event already released while flushing 
-                         * low priority packet. */
-                        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, err);
-                    }
-                    if (err != FM_OK)
-                    {
-                        FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
-                                     "Freeing Buffer queue node from the queue failed"
-                                     "status = %d (%s) \n",
-                                      err,
-                                      fmErrorMsg(err));
-                        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, err);
-                    }
-                }
-                /* Free the event since we could not send it to thread */
-                fmFreeBufferChain(sw, (fm_buffer *) pktEvent->pkt);
-                fmDbgDiagCountIncr(sw, FM_CTR_RX_PKT_DROPS_NO_EVENT, 1);
-                fmReleaseEvent(event);
-            }
-        }
-
-    }
-    else
-    {
-        if (enableFramePriority)
+        if (FM_ATOMIC_LOAD(&queue->pullIndex) != fmPacketQueueGetTail(queue))
         {
-            err = fmFreeBufferQueueNode(sw, pktEvent);
-            if (err == FM_ERR_NOT_FOUND)
-            {
-                FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_RX,
-                             "Node already removed. Should have been"
-                             " flushed due to prioritized allocation");
-
-                /* Buffer and Event already released while flushing 
-                 * low priority packet. */
-                FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, err);
-            }
-
-            if (err != FM_OK)
-            {
-                FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
-                             "Freeing Buffer queue node from the queue failed"
-                             "status = %d (%s) \n",
-                              err,
-                              fmErrorMsg(err));
-
-            }
+            return queue;
         }
-        /* Drop the packet without forwarding it. */
-        fmFreeBufferChain(sw, (fm_buffer *) pktEvent->pkt);
-        fmDbgDiagCountIncr(sw, FM_CTR_RX_PKT_DROPS_LACP, 1);
-        fmReleaseEvent(event);
     }
 
-    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, err);
+    return NULL;
 
-}   /* end fmPacketReceiveEnqueue */
+}   /* end fmPacketQueueGetNextToDrain */
 
 
 
 
 /*****************************************************************************/
-/** fmPacketClearCRC
+/** fmPacketQueueDumpStats
  * \ingroup intPlatformCommon
  *
- * \desc            Clear the last 4 bytes in the buffer chain. 
+ * \desc            Display the depth and drop statistics of the TX packet
+ *                  queues.
  *
- * \param[in]       buffer points to the receive packet buffer.
+ * \param[in]       sw is the switch number.
  *
- * \return          NONE
+ * \return          FM_OK if successful.
  *
  *****************************************************************************/
-void fmPacketClearCRC(fm_buffer *buffer)
+fm_status fmPacketQueueDumpStats(fm_int sw)
 {
-    fm_buffer *lastBuf = buffer;
-    fm_buffer *nextToLastBuf = buffer;
-    fm_byte   *pByte;
-    fm_int    rem;
+    fm_packetQueue *queue;
+    fm_uint         depth;
+    fm_int          tc;
 
-    if (buffer->next == NULL)
-    {
-        /* Quick check for small packets */
-        pByte = (fm_byte*)buffer->data;
-        memset(pByte+buffer->len-4, 0, 4);
-        return;
-    }
+    FM_LOG_PRINT("TC  Size  Depth  MaxDepth          Enqueued             Drops\n");
 
-    while (buffer)
+    for (tc = FM_PACKET_TX_QUEUES - 1 ; tc >= 0 ; tc--)
     {
-        nextToLastBuf = lastBuf;
-        lastBuf = buffer;
-        buffer = buffer->next;
-    }
+        queue = &GET_PLAT_PKT_STATE(sw)->txQueue[tc];
 
+        if (queue->size == 0)
+        {
+            continue;
+        }
 
-    if (lastBuf->len >=4)
-    {
-        pByte = (fm_byte*)lastBuf->data;
-        memset(pByte+lastBuf->len-4, 0, 4);
+        depth = (fmPacketQueueGetTail(queue) + queue->size -
+                 FM_ATOMIC_LOAD(&queue->pullIndex)) % queue->size;
+
+        FM_LOG_PRINT("%2d  %4u  %5u  %8u  %16" FM_FORMAT_64 "u  %16"
+                     FM_FORMAT_64 "u\n",
+                     tc,
+                     queue->size,
+                     depth,
+                     queue->maxDepth,
+                     queue->numEnqueued,
+                     queue->numDrops);
     }
-    else
-    {
-        pByte = (fm_byte*)lastBuf->data;
-        memset(pByte, 0, lastBuf->len);
 
-        rem = 4 - lastBuf->len;
-        pByte = (fm_byte*)nextToLastBuf->data;
-        memset(pByte+nextToLastBuf->len-rem, 0, rem);
-    }
+    return FM_OK;
 
-}   /* end fmPacketClearCRC */
+}   /* end fmPacketQueueDumpStats */
 
 
 
 
 /*****************************************************************************/
-/** fmPacketGetCRC
+/** fmPacketQueueInit
  * \ingroup intPlatformCommon
  *
- * \desc            Returns the last 4 bytes in the buffer chain.
+ * \desc            Initialize packet queue.
  *
- * \param[in]       buffer points to the receive packet buffer.
+ * \param[in]       queue is the pointer to the packet queue.
  *
- * \return          FCS value for the buffer.
+ * \param[in]       sw is the switch number.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
  *
  *****************************************************************************/
-fm_uint32 fmPacketGetCRC(fm_buffer *buffer)
+fm_status fmPacketQueueInit(fm_packetQueue *queue, fm_int sw)
 {
-    fm_buffer * lastBuf = NULL;
-    fm_buffer * prevBuf = NULL;
-    fm_byte   * pByte;
-    fm_int      rem;
+    /* Initialize mutex if it is enabled */
+    pthread_mutexattr_t attr;
+    fm_int              size;
 
-    union {
-        fm_uint32 w;
-        fm_byte   b[4];
-    } fcsVal;
+    if (!queue) 
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
 
-    if (buffer == NULL)
+    memset(queue, 0, sizeof(*queue));
+    queue->switchNum = sw;
+
+    size = GET_PROPERTY()->pktQueueSize;
+
+    if (size < 2)
     {
-        return 0;
+        FM_LOG_WARNING(FM_LOG_CAT_EVENT_PKT_TX,
+                       "Invalid %s value %d, using %d\n",
+                       FM_AAK_API_PLATFORM_PKT_QUEUE_SIZE,
+                       size,
+                       FM_PACKET_QUEUE_SIZE);
+        size = FM_PACKET_QUEUE_SIZE;
     }
 
-    while (buffer)
+    queue->packetQueueList = fmAlloc(size * sizeof(fm_packetEntry));
+
+    if (queue->packetQueueList == NULL)
     {
-        prevBuf = lastBuf;
-        lastBuf = buffer;
-        buffer = buffer->next;
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_NO_MEM);
     }
 
-    if (lastBuf->len >= 4)
+    FM_MEMSET_S(queue->packetQueueList,
+                size * sizeof(fm_packetEntry),
+                0,
+                size * sizeof(fm_packetEntry));
+    queue->size = size;
+
+    if ( pthread_mutexattr_init(&attr) )
     {
-        pByte = ((fm_byte *) lastBuf->data) + lastBuf->len - 4;
-        FM_MEMCPY_S(&fcsVal.b[0], sizeof(fcsVal.b), pByte, 4);
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_LOCK_INIT);
     }
-    else if (prevBuf == NULL)
+
+    if ( pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE) ||
+         pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) )
     {
-        return 0;
+        pthread_mutexattr_destroy(&attr);
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_LOCK_INIT);
     }
-    else
+
+    if ( pthread_mutex_init(&queue->mutex, &attr) ||
+         pthread_mutex_init(&queue->drainMutex, &attr) )
     {
-        rem = 4 - lastBuf->len;
-        pByte = ((fm_byte *) prevBuf->data) + prevBuf->len - rem;
-        FM_MEMCPY_S(fcsVal.b, sizeof(fcsVal.b), pByte, rem);
-        FM_MEMCPY_S(&fcsVal.b[rem], 4 - rem, lastBuf->data, lastBuf->len);
+        pthread_mutexattr_destroy(&attr);
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_LOCK_INIT);
     }
 
-    return ntohl(fcsVal.w);
+    if ( pthread_mutexattr_destroy(&attr) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_LOCK_INIT);
+    }
 
-}   /* end fmPacketGetCRC */
+    return FM_OK;
+
+}   /* end fmPacketQueueInit */
 
 
 
 
 /*****************************************************************************/
-/** fmFindSlaveSwitchPortByGlort
+/** fmPacketQueueFree
  * \ingroup intPlatformCommon
  *
- * \desc            Find out which switch and port this glort belong to
- *
- * \param[in]       glort is the glort number.
- *
- * \param[out]      switchNum is the pointer to hold the switch number.
+ * \desc            Free all buffers in packet queue.
  *
- * \param[out]      port is the pointer to hold the port number.
+ * \param[in]       sw is the switch number.
  *
  * \return          FM_OK if successful.
- * \return          FM_FAIL if not found.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
  *
  *****************************************************************************/
-fm_status fmFindSlaveSwitchPortByGlort(fm_uint32 glort, 
-                                       fm_int *switchNum, 
-                                       fm_int *port)
+fm_status fmPacketQueueFree(fm_int sw)
 {
-    fm_int    sw;
-    fm_status err = FM_FAIL;
+    fm_status       err       = FM_OK;
+    fm_packetQueue *txQueue;
+    fm_packetEntry *packet;
+    fm_uint         tail;
+    fm_int          tc;
 
-    for (sw = FM_FIRST_FOCALPOINT ; sw <= FM_LAST_FOCALPOINT ; sw++)
+    for (tc = 0 ; tc < FM_PACKET_TX_QUEUES ; tc++)
     {
-        if (!SWITCH_LOCK_EXISTS(sw))
+        txQueue = &GET_PLAT_PKT_STATE(sw)->txQueue[tc];
+
+        if (txQueue->packetQueueList == NULL)
         {
             continue;
         }
 
-        fm_switch *switchPtr;
-
-        switchPtr = GET_SWITCH_PTR(sw);
-
-        if (!switchPtr)
+        if (fmPacketQueueLock(txQueue) != FM_OK)
         {
+            /* Leave the entries in place rather than race a producer */
+            err = FM_ERR_UNABLE_TO_LOCK;
             continue;
         }
-        /* Need to take a switch lock here ?? */
-        if ( (glort & ~switchPtr->glortRange.glortMask) ==
-            switchPtr->glortRange.glortBase )
+
+        fmPacketQueueDrainLock(txQueue);
+
+        tail = fmPacketQueueGetTail(txQueue);
+
+        while (txQueue->pullIndex != tail)
         {
-            *switchNum = sw;
-            err = fmGetGlortLogicalPort(sw, glort, port);
-            break;
+            packet = &txQueue->packetQueueList[txQueue->pullIndex];
+
+            if (packet->freePacketBuffer)
+            {
+                fmReleaseBufferChain(sw, packet->packet);
+            }
+
+            fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_TX_BUFFER_FREES, 1);
+
+            fmPacketQueueAdvance(txQueue);
         }
+
+        fmFree(txQueue->packetQueueList);
+        txQueue->packetQueueList = NULL;
+        txQueue->size            = 0;
+
+        fmPacketQueueDrainUnlock(txQueue);
+        fmPacketQueueUnlock(txQueue);
     }
 
     return err;
 
-}   /* end fmFindSlaveSwitchPortByGlort */
+}   /* end fmPacketQueueFree */
 
 
 
 
 /*****************************************************************************/
-/** fmComputeTotalPacketLength
+/** fmPacketQueueUpdate
  * \ingroup intPlatformCommon
  *
- * \desc            Computes the packet length by iterating through buffers.
+ * \desc            Update packet queue by advancing one entry
  *
- * \param[in]       packet is a pointer to an fm_buffer representing the first
- *                  buffer in the packet.
+ * \param[in]       queue is the pointer to the packet queue.
  *
- * \return          The packet length in bytes.
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_TX_PACKET_QUEUE_FULL if queue if full.
  *
  *****************************************************************************/
-fm_int fmComputeTotalPacketLength(fm_buffer *packet)
+fm_status fmPacketQueueUpdate(fm_packetQueue *queue)
 {
-    fm_int length = 0;
+    fm_uint nextIndex;
+    fm_uint pullIndex;
+    fm_uint depth;
 
-    while (packet)
+    nextIndex = fmPacketQueueNextIndex(queue, queue->pushIndex);
+    pullIndex = FM_ATOMIC_LOAD(&queue->pullIndex);
+
+    /* check if the Tx queue is full */
+    if ( nextIndex == pullIndex )
+    {
+        queue->numDrops++;
+
+        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
+                     "fmPacketQueueUpdate:"
+                     "TX queue is full?: pushIndex = %d, pullIndex = %d\n",
+                     queue->pushIndex, queue->pullIndex);
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_TX_PACKET_QUEUE_FULL);
+    }
+    else
     {
-        if ( (packet->len < 0) || (packet->len > FM_BUFFER_SIZE_BYTES) )
+        /* updated indices */
+        queue->pushIndex = nextIndex;
+        queue->numEnqueued++;
+
+        depth = (nextIndex + queue->size - pullIndex) % queue->size;
+        if (depth > queue->maxDepth)
         {
-            length = -1;
-            return length;
+            queue->maxDepth = depth;
         }
-        length += packet->len;
-        packet  = packet->next;
     }
 
-    return length;
+    return FM_OK;
 
-}   /* end fmComputeTotalPacketLength */
+}   /* end fmPacketQueueUpdate */
 
 
 
 
 /*****************************************************************************/
-/** fmGetPortDefVlanInt
+/** fmPacketQueueEnqueue
  * \ingroup intPlatformCommon
  *
- * \desc            Returns the port default vlan.
+ * \desc            Queue packet to the tx packet queue
+ *
+ * \note            The caller must hold the queue lock. The entry becomes
+ *                  visible to the consumer when the lock is dropped.
+ *
+ * \param[in]       queue is the pointer to the packet queue.
+ *
+ * \param[in]       packet is the buffer containing the packet.
+ *
+ * \param[in]       packetLength is the length of the packet.
+ *
+ * \param[in]       islTag is the pointer containing ISL tag words.
+ * 
+ * \param[in]       islTagFormat is the isl tag format.
+ *
+ * \param[in]       suppressVlanTag is the flag to indicate whether
+ *                  to suppress the vlan tag in the data.
+ *
+ * \param[in]       freeBuffer is the flag to indicate whether
+ *                  to free the packet buffer or not.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPacketQueueEnqueue(fm_packetQueue * queue,
+                               fm_buffer *      packet,
+                               fm_int           packetLength,
+                               fm_islTag *      islTag,
+                               fm_islTagFormat  islTagFormat,
+                               fm_bool          suppressVlanTag,
+                               fm_bool          freeBuffer)
+{
+    fm_packetEntry *entry;
+
+    entry = &queue->packetQueueList[queue->pushIndex];
+
+    entry->packet = packet;
+    entry->length = packetLength;
+    entry->fcsVal = FM_USE_DEFAULT_FCS;
+    FM_MEMCPY_S( &entry->islTag,
+                 sizeof(entry->islTag),
+                 islTag,
+                 sizeof(fm_islTag) );
+    entry->islTagFormat = islTagFormat;
+    entry->suppressVlanTag  = suppressVlanTag;
+    entry->freePacketBuffer = freeBuffer;
+    entry->txCookie         = NULL;
+
+    FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
+                 "fm_packet_queue_enqueue: packet queued "
+                 "in slot %d, length %d bytes\n",
+                 queue->pushIndex,
+                 entry->length);
+
+    return fmPacketQueueUpdate(queue);
+
+}   /* end fmPacketQueueEnqueue */
+
+
+
+
+/*****************************************************************************/
+/** fmPacketQueueTryEnqueue
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Queue a single packet to the tx packet queue without
+ *                  blocking on a contended queue lock, and publish it to
+ *                  the consumer.
+ *
+ * \param[in]       queue is the pointer to the packet queue.
+ *
+ * \param[in]       packet is the buffer containing the packet.
+ *
+ * \param[in]       packetLength is the length of the packet.
+ *
+ * \param[in]       islTag is the pointer containing ISL tag words.
+ * 
+ * \param[in]       islTagFormat is the isl tag format.
+ *
+ * \param[in]       suppressVlanTag is the flag to indicate whether
+ *                  to suppress the vlan tag in the data.
+ *
+ * \param[in]       freeBuffer is the flag to indicate whether
+ *                  to free the packet buffer or not.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_LOCK_TIMEOUT if another producer holds the queue.
+ * \return          FM_ERR_TX_PACKET_QUEUE_FULL if the queue is full.
+ *
+ *****************************************************************************/
+fm_status fmPacketQueueTryEnqueue(fm_packetQueue * queue,
+                                  fm_buffer *      packet,
+                                  fm_int           packetLength,
+                                  fm_islTag *      islTag,
+                                  fm_islTagFormat  islTagFormat,
+                                  fm_bool          suppressVlanTag,
+                                  fm_bool          freeBuffer)
+{
+    fm_status err;
+
+    if (!fmPacketQueueTryLock(queue))
+    {
+        return FM_ERR_LOCK_TIMEOUT;
+    }
+
+    err = fmPacketQueueEnqueue(queue,
+                               packet,
+                               packetLength,
+                               islTag,
+                               islTagFormat,
+                               suppressVlanTag,
+                               freeBuffer);
+
+    fmPacketQueueUnlock(queue);
+
+    return err;
+
+}   /* end fmPacketQueueTryEnqueue */
+
+
+
+
+/*****************************************************************************/
+/** fmPacketReceiveEnqueue
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Processes a complete received packet event and
+ *                  tries to send it upward.
  *
  * \note            This is an optimized version for packet processing without
  *                  any locking. The input parameters should already been
  *                  validated before calling this function.
  *
- * \param[in]       sw is the switch on which to operate.
+ * \param[in]       sw is the switch to send the event for.
  *
- * \param[in]       port is the logical port to get the default vlan.
+ * \param[in]       event is a fully filled event structure.
  *
- * \param[out]      vlan points to caller allocated storage where default vlan
- *                  is stored.
+ * \param[in]       selfTestEventHandler is a pointer to the event handler.
  *
- * \return          FM_OK if successful.
+ * \return          FM_OK if successful
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
  *
  *****************************************************************************/
-fm_status fmGetPortDefVlanInt(fm_int     sw,
-                              fm_int     port,
-                              fm_uint16 *vlan)
+fm_status fmPacketReceiveEnqueue(fm_int     sw,
+                                 fm_event * event,
+                                 fm_switchEventHandler selfTestEventHandler)
 {
-    fm_portAttr *portAttr;
+    fm_eventPktRecv *pktEvent = &event->info.fpPktEvent;
+    fm_status               err      = FM_OK;
+    fm_bool                 isLacpToBeDropped;
+    fm_bool                 isPktSFlowLogged;
+    fm_switchEventHandler   switchEventHandler;
+    fm_switch              *switchPtr;
+    fm_bool                 enableFramePriority;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_RX,
+                 "sw = %d, event->type = %d, event->sw = %d, "
+                 "event->eventID = %d\n",
+                 sw,
+                 event->type,
+                 event->sw,
+                 event->eventID);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    switchEventHandler = switchPtr->eventHandler;
+
+#ifdef __FM_FM_PRIORITY_BUFFER_QUEUES_H
+    enableFramePriority = fmRootPlatform->enablePriorityScheduling; 
+#else
+    enableFramePriority = FALSE;
+#endif
+
+    /***************************************************
+     * Track the frame in the buffer queue of its switch
+     * priority until it is delivered or dropped.
+     **************************************************/
+    if (enableFramePriority)
+    {
+        err = fmAddBufferChainInQueue(sw,
+                                      (fm_buffer *) pktEvent->pkt,
+                                      pktEvent->priority,
+                                      FALSE);
+        if (err != FM_OK)
+        {
+            FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_RX,
+                         "Frame of priority %d not queued: %s\n",
+                         pktEvent->priority,
+                         fmErrorMsg(err));
+            err = FM_OK;
+        }
+    }
+
+    /***************************************************
+     * Check the LACP filter configuration based on the
+     * switch the event is associated with, not the
+     * switch the frame was received on.  These are
+     * potentially different in an FIBM environment.
+     **************************************************/
+    fmCheckLACPFilter(event->sw, pktEvent, &isLacpToBeDropped);
+
+    if (!isLacpToBeDropped)
+    {
+        /* While the sFlow sample ring is enabled, samples are placed on it
+         * here instead of going through the event queue. */
+        if ( (switchPtr->sflowSampleRing != NULL) &&
+             (switchPtr->DeliverSFlowSample != NULL) )
+        {
+            (void)switchPtr->DeliverSFlowSample(sw, pktEvent, &isPktSFlowLogged);
+
+            if (isPktSFlowLogged)
+            {
+                if (enableFramePriority)
+                {
+                    err = fmFreeBufferQueueNode(sw, pktEvent);
+                    if (err == FM_ERR_NOT_FOUND)
+                    {
+                        /* Buffer and Event already released while flushing 
+                         * low priority packet. */
+                        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, FM_OK);
+                    }
+                }
+
+                fmFreeBufferChain(sw, (fm_buffer *) pktEvent->pkt);
+
+                /* The event is on the stack for direct enqueueing. */
+                if ( !GET_PLAT_PKT_STATE(sw)->rxDirectEnqueueing ||
+                     switchEventHandler == selfTestEventHandler )
+                {
+                    fmReleaseEvent(event);
+                }
+
+                FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, FM_OK);
+            }
+        }
+        /* Check if the packet is logged by a sFlow instance */
+        else if (switchPtr->CheckSFlowLogging)
+        {
+            (void)switchPtr->CheckSFlowLogging(sw, pktEvent, &isPktSFlowLogged);
+
+            if (isPktSFlowLogged)
+            {
+                /* Change the type to FM_EVENT_SFLOW_PKT_RECV */
+                event->type = FM_EVENT_SFLOW_PKT_RECV;
+            }
+        }
+        
+        /* Don't do a direct enqueue if in self-test */
+        if (GET_PLAT_PKT_STATE(sw)->rxDirectEnqueueing &&
+            switchEventHandler != selfTestEventHandler)
+        {
+            /* Pass directly up to the application */
+            if (fmEventHandler != NULL)
+            {
+                if (enableFramePriority)
+                {
+                    err = fmFreeBufferQueueNode(sw, pktEvent);
+                    if (err == FM_ERR_NOT_FOUND)
+                    {
+                        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_RX,
+                                     "Node with buffer of priority: %d "
+                                     "already removed. Should have been"
+                                     " flushed due to prioritized allocation",
+                                     pktEvent->priority);
+                        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, FM_OK);
+                    }
+                    if (err != FM_OK)
+                    {
+                        FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
+                                     "Freeing Buffer queue node from the queue failed"
+                                     "status = %d (%s) \n",
+                                      err,
+                                      fmErrorMsg(err));
+                        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, err);
+                    }
+                }
+
+                fmEventHandler(event->type, event->sw, &event->info);
+                /* Don't need to release event, since event structure
+                 * is on the stack for direct enqueueing method
+                 */
+            }
+            else
+            {
+                if (enableFramePriority)
+                {
+                    err = fmFreeBufferQueueNode(sw, pktEvent);
+                    if (err == FM_ERR_NOT_FOUND)
+                    {
+                        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_RX,
+                                     "Node already removed. Should have been"
+                                     " flushed due to prioritized allocation");
+                        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, FM_OK);
+                    }
+                    else if (err != FM_OK)
+                    {
+                        FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
+                                     "Freeing Buffer queue node from the queue failed"
+                                     "status = %d (%s) \n",
+                                      err,
+                                      fmErrorMsg(err));
+                        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, err);
+
+                    }
+                }
+                /* Drop the packet without forwarding it. */
+                fmFreeBufferChain(sw, (fm_buffer *) pktEvent->pkt);
+                fmDbgDiagCountIncr(sw, FM_CTR_RX_PKT_DROPS_NO_PORT, 1);
+            }
+            FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, FM_OK);
+        }
+        else
+        {
+            err = fmSendThreadEvent(&fmRootApi->eventThread, event);
+
+            if (err != FM_OK)
+            {
+                if (enableFramePriority)
+                {
+                    err = fmFreeBufferQueueNode(sw, pktEvent);
+                    if (err == FM_ERR_NOT_FOUND)
+                    {
+                        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_RX,
+                                     "Node already removed. Should have been"
+                                     " flushed due to prioritized allocation");
+
+                        /* Buffer and Event already released while flushing 
+                         * low priority packet. */
+                        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, err);
+                    }
+                    if (err != FM_OK)
+                    {
+                        FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
+                                     "Freeing Buffer queue node from the queue failed"
+                                     "status = %d (%s) \n",
+                                      err,
+                                      fmErrorMsg(err));
+                        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, err);
+                    }
+                }
+                /* Free the event since we could not send it to thread */
+                fmFreeBufferChain(sw, (fm_buffer *) pktEvent->pkt);
+                fmDbgDiagCountIncr(sw, FM_CTR_RX_PKT_DROPS_NO_EVENT, 1);
+                fmReleaseEvent(event);
+            }
+        }
+
+    }
+    else
+    {
+        if (enableFramePriority)
+        {
+            err = fmFreeBufferQueueNode(sw, pktEvent);
+            if (err == FM_ERR_NOT_FOUND)
+            {
+                FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_RX,
+                             "Node already removed. Should have been"
+                             " flushed due to prioritized allocation");
+
+                /* Buffer and Event already released while flushing 
+                 * low priority packet. */
+                FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, err);
+            }
+
+            if (err != FM_OK)
+            {
+                FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_RX,
+                             "Freeing Buffer queue node from the queue failed"
+                             "status = %d (%s) \n",
+                              err,
+                              fmErrorMsg(err));
+
+            }
+        }
+        /* Drop the packet without forwarding it. */
+        fmFreeBufferChain(sw, (fm_buffer *) pktEvent->pkt);
+        fmDbgDiagCountIncr(sw, FM_CTR_RX_PKT_DROPS_LACP, 1);
+        fmReleaseEvent(event);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_RX, err);
+
+}   /* end fmPacketReceiveEnqueue */
+
+
+
+
+/*****************************************************************************/
+/** fmPacketClearCRC
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Clear the last 4 bytes in the buffer chain. 
+ *
+ * \param[in]       buffer points to the receive packet buffer.
+ *
+ * \return          NONE
+ *
+ *****************************************************************************/
+void fmPacketClearCRC(fm_buffer *buffer)
+{
+    fm_buffer *lastBuf = buffer;
+    fm_buffer *nextToLastBuf = buffer;
+    fm_byte   *pByte;
+    fm_int    rem;
+
+    if (buffer->next == NULL)
+    {
+        /* Quick check for small packets */
+        pByte = (fm_byte*)buffer->data;
+        memset(pByte+buffer->len-4, 0, 4);
+        return;
+    }
+
+    while (buffer)
+    {
+        nextToLastBuf = lastBuf;
+        lastBuf = buffer;
+        buffer = buffer->next;
+    }
+
+
+    if (lastBuf->len >=4)
+    {
+        pByte = (fm_byte*)lastBuf->data;
+        memset(pByte+lastBuf->len-4, 0, 4);
+    }
+    else
+    {
+        pByte = (fm_byte*)lastBuf->data;
+        memset(pByte, 0, lastBuf->len);
+
+        rem = 4 - lastBuf->len;
+        pByte = (fm_byte*)nextToLastBuf->data;
+        memset(pByte+nextToLastBuf->len-rem, 0, rem);
+    }
+
+}   /* end fmPacketClearCRC */
+
+
+
+
+/*****************************************************************************/
+/** fmPacketGetCRC
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Returns the last 4 bytes in the buffer chain.
+ *
+ * \param[in]       buffer points to the receive packet buffer.
+ *
+ * \return          FCS value for the buffer.
+ *
+ *****************************************************************************/
+fm_uint32 fmPacketGetCRC(fm_buffer *buffer)
+{
+    fm_buffer * lastBuf = NULL;
+    fm_buffer * prevBuf = NULL;
+    fm_byte   * pByte;
+    fm_int      rem;
+
+    union {
+        fm_uint32 w;
+        fm_byte   b[4];
+    } fcsVal;
+
+    if (buffer == NULL)
+    {
+        return 0;
+    }
+
+    while (buffer)
+    {
+        prevBuf = lastBuf;
+        lastBuf = buffer;
+        buffer = buffer->next;
+    }
+
+    if (lastBuf->len >= 4)
+    {
+        pByte = ((fm_byte *) lastBuf->data) + lastBuf->len - 4;
+        FM_MEMCPY_S(&fcsVal.b[0], sizeof(fcsVal.b), pByte, 4);
+    }
+    else if (prevBuf == NULL)
+    {
+        return 0;
+    }
+    else
+    {
+        rem = 4 - lastBuf->len;
+        pByte = ((fm_byte *) prevBuf->data) + prevBuf->len - rem;
+        FM_MEMCPY_S(fcsVal.b, sizeof(fcsVal.b), pByte, rem);
+        FM_MEMCPY_S(&fcsVal.b[rem], 4 - rem, lastBuf->data, lastBuf->len);
+    }
+
+    return ntohl(fcsVal.w);
+
+}   /* end fmPacketGetCRC */
+
+
+
+
+/*****************************************************************************/
+/** fmFindSlaveSwitchPortByGlort
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Find out which switch and port this glort belong to
+ *
+ * \param[in]       glort is the glort number.
+ *
+ * \param[out]      switchNum is the pointer to hold the switch number.
+ *
+ * \param[out]      port is the pointer to hold the port number.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if not found.
+ *
+ *****************************************************************************/
+fm_status fmFindSlaveSwitchPortByGlort(fm_uint32 glort, 
+                                       fm_int *switchNum, 
+                                       fm_int *port)
+{
+    fm_int    sw;
+    fm_status err = FM_FAIL;
+
+    for (sw = FM_FIRST_FOCALPOINT ; sw <= FM_LAST_FOCALPOINT ; sw++)
+    {
+        if (!SWITCH_LOCK_EXISTS(sw))
+        {
+            continue;
+        }
+
+        fm_switch *switchPtr;
+
+        switchPtr = GET_SWITCH_PTR(sw);
+
+        if (!switchPtr)
+        {
+            continue;
+        }
+        /* Need to take a switch lock here ?? */
+        if ( (glort & ~switchPtr->glortRange.glortMask) ==
+            switchPtr->glortRange.glortBase )
+        {
+            *switchNum = sw;
+            err = fmGetGlortLogicalPort(sw, glort, port);
+            break;
+        }
+    }
+
+    return err;
+
+}   /* end fmFindSlaveSwitchPortByGlort */
+
+
+
+
+/*****************************************************************************/
+/** fmComputeTotalPacketLength
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Computes the packet length by iterating through buffers.
+ *
+ * \param[in]       packet is a pointer to an fm_buffer representing the first
+ *                  buffer in the packet.
+ *
+ * \return          The packet length in bytes.
+ *
+ *****************************************************************************/
+fm_int fmComputeTotalPacketLength(fm_buffer *packet)
+{
+    fm_int length = 0;
+
+    while (packet)
+    {
+        if ( (packet->len < 0) || (packet->len > fmPlatformGetBufferSize()) )
+        {
+            length = -1;
+            return length;
+        }
+        length += packet->len;
+        packet  = packet->next;
+    }
+
+    return length;
+
+}   /* end fmComputeTotalPacketLength */
+
+
+
+
+/*****************************************************************************/
+/** fmGetPortDefVlanInt
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Returns the port default vlan.
+ *
+ * \note            This is an optimized version for packet processing without
+ *                  any locking. The input parameters should already been
+ *                  validated before calling this function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port to get the default vlan.
+ *
+ * \param[out]      vlan points to caller allocated storage where default vlan
+ *                  is stored.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmGetPortDefVlanInt(fm_int     sw,
+                              fm_int     port,
+                              fm_uint16 *vlan)
+{
+    fm_portAttr *portAttr;
+
+    portAttr = GET_PORT_ATTR(sw, port);
+
+    *vlan = portAttr->defVlan;
+
+    return FM_OK;
+
+}   /* end fmGetPortDefVlanInt */
+
+
+
+
+/*****************************************************************************/
+/** fmGetPortDefVlanDefPriorityInt
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Returns the port default vlan and priority.
+ *
+ * \note            This is an optimized version for packet processing without
+ *                  any locking. The input parameters should already been
+ *                  validated before calling this function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port to get the default vlan and priority.
+ *
+ * \param[out]      vlan points to caller allocated storage where default vlan
+ *                  is stored.
+ *
+ * \param[out]      priority points to caller allocated storage where default priority
+ *                  is stored.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmGetPortDefVlanDefPriorityInt(fm_int     sw,
+                                         fm_int     port,
+                                         fm_uint16 *vlan,
+                                         fm_byte *  priority)
+{
+    fm_portAttr *portAttr;
+
+    portAttr = GET_PORT_ATTR(sw, port);
+
+    *vlan = portAttr->defVlan;
+    *priority = portAttr->defVlanPri;
+
+    return FM_OK;
+
+}   /* end fmGetPortDefVlanDefPriorityInt */
+
+
+
+
+/*****************************************************************************/
+/** fmGenericPacketDestroy
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Performs generic packet transfer cleanup.
+ *
+ * \param[in]       sw is the switch number to clean.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmGenericPacketDestroy(fm_int sw)
+{
+    fm_packetHandlingState *ps = GET_PLAT_PKT_STATE(sw);
+    fm_int                  handle;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX, "sw = %d\n", sw);
+
+    fmPacketQueueFree(sw);
+
+    for (handle = 0 ; handle < FM_MAX_TX_DESTINATIONS ; handle++)
+    {
+        if (ps->txDestinations[handle].ports != NULL)
+        {
+            fmFree(ps->txDestinations[handle].ports);
+        }
+    }
+
+    memset(ps->txDestinations, 0, sizeof(ps->txDestinations));
+    pthread_mutex_destroy(&ps->txDestMutex);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_OK);
+
+}   /* end fmGenericPacketDestroy */
+
+
+
+
+/*****************************************************************************/
+/** fmGenericPacketHandlingInitialize
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Performs generic packet transfer initialization.
+ *
+ * \param[in]       sw is the switch number to initialize.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmGenericPacketHandlingInitialize(fm_int sw)
+{
+    return fmGenericPacketHandlingInitializeV2(sw, FALSE);
+}
+
+
+
+
+/*****************************************************************************/
+/** fmGenericPacketHandlingInitializeV2
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Performs generic packet transfer initialization.
+ *
+ * \param[in]       sw is the switch number to initialize.
+ * 
+ * \param[in]       hasFcs is TRUE if the packet includes the FCS field.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmGenericPacketHandlingInitializeV2(fm_int sw, fm_bool hasFcs)
+{
+    fm_packetHandlingState *ps = GET_PLAT_PKT_STATE(sw);
+    pthread_mutexattr_t     attr;
+    fm_status               err;
+    fm_int                  tc;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
+                 "sw = %d hasFcs = %s\n",
+                 sw,
+                 FM_BOOLSTRING(hasFcs));
+
+    /* clear out all state */
+    memset( ps, 0, sizeof(fm_packetHandlingState) );
+
+    /* The packet state may live in memory shared between processes */
+    if ( pthread_mutexattr_init(&attr) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_LOCK_INIT);
+    }
+
+    if ( pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) ||
+         pthread_mutex_init(&ps->txDestMutex, &attr) )
+    {
+        pthread_mutexattr_destroy(&attr);
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_LOCK_INIT);
+    }
+
+    pthread_mutexattr_destroy(&attr);
+
+    for (tc = 0 ; tc < FM_PACKET_TX_QUEUES ; tc++)
+    {
+        err = fmPacketQueueInit(&ps->txQueue[tc], sw);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+    }
+
+    /* reset state here */
+    ps->recvInProgress       = FALSE;
+    ps->recvBufferOffset     = 0;
+    ps->currentWordsReceived = 0;
+    ps->cachedEndianness     = -1; /* -1 indicates unspecified endianness */
+    ps->sendUserFcs          = hasFcs;
+    ps->rxDirectEnqueueing   = GET_PROPERTY()->rxDirectEnqueueing;
+
+    /* initialize the signal sem for event availability */
+    err = fmCreateSemaphore("netdevEventsAvailable",
+                            FM_SEM_BINARY,
+                            &ps->eventsAvailableSignal, 
+                            0);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
+
+}   /* end fmGenericPacketHandlingInitializeV2 */
+
+
+
+
+/*****************************************************************************/
+/** fmGenericSendPacketISL
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Called to add a packet to the TX packet queue.
+ *
+ * \param[in]       sw is the switch on which to send the packet.
+ *
+ * \param[in]       islTagList points to an array of islTag to send out
+ *                  along with packet
+ * 
+ * \param[in]       islTagFormat is the isl tag format. 
+ *
+ * \param[in]       numPorts is the number of elements in islTagList.
+ *
+ * \param[in]       packet points to the packet buffer's first ''fm_buffer''
+ *                  structure in a chain of one or more buffers.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_TX_PACKET_QUEUE_FULL if transmit packet queue is full.
+ * \return          FM_FAIL if network device is not operational.
+ * \return          FM_ERR_FRAME_TOO_LARGE if the packet exceeds the maximum
+ *                  frame size for the CPU port.
+ * \return          FM_ERR_FRAME_SIZE_EXCEEDS_MTU if the frame size exceeds
+ *                  the MTU of the network interface.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmGenericSendPacketISL(fm_int          sw,
+                                 fm_islTag *     islTagList,
+                                 fm_islTagFormat islTagFormat,
+                                 fm_int          numPorts,
+                                 fm_buffer *     packet)
+{
+    fm_packetQueue *txQueue;
+    fm_int          packetLength;
+    fm_int          port;
+    fm_int          cpuMaxFrameSize;
+    fm_int          oldPushIndex;
+    fm_int          cpuPort;
+    fm_int          masterSw; /* For support FIBM slave switch */
+    fm_status       err = FM_OK;
+    fm_bool         isRawSocket;
+    fm_int          mtu;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
+                 "sw = %d, "
+                 "islTag = %p, "
+                 "numPorts = %d, "
+                 "packet->index = 0x%x\n",
+                 sw,
+                 (void *) islTagList,
+                 numPorts,
+                 packet->index);
+
+    masterSw = fmFibmSlaveGetMasterSwitch(sw);
+
+    if (masterSw >= 0)
+    {
+        VALIDATE_AND_PROTECT_SWITCH_NO_RETURN(err, masterSw);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+        
+        err = fmGetCpuPortInt(masterSw, &cpuPort);
+        
+        if (err == FM_OK)
+        {
+            err = fmGetPortMaxFrameSizeInt(masterSw,
+                                           cpuPort,
+                                           &cpuMaxFrameSize);
+        }
+        
+        UNPROTECT_SWITCH(masterSw);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+    }
+    else
+    {
+        /* This is for FIBM using the NIC. */
+        cpuMaxFrameSize = 10000; /* Just allow to pass */
+        
+        /* Standalone use itself as master switch */
+        masterSw = sw;
+    }
+
+    packetLength = fmComputeTotalPacketLength(packet);
+    if (packetLength <= 0)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    /* Verify that the packet respects the CPU maximum frame size. */
+    if (packetLength > cpuMaxFrameSize - 4)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_FRAME_TOO_LARGE);
+    }
+
+    /* Verify that the packet respects the MTU of the network device. */
+    if (!fmIsRawPacketSocketDeviceOperational(masterSw, &isRawSocket, &mtu))
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_FAIL);
+    }
+
+    if (isRawSocket && (packetLength > mtu - 4))
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_FRAME_SIZE_EXCEEDS_MTU);
+    }
+
+    if (islTagFormat == FM_ISL_TAG_F56)
+    {
+        txQueue = fmPacketQueueSelect(masterSw,
+                                      (islTagList[0].f56.tag[0] >>
+                                       FM_F56_SWPRI_POS) & FM_F56_SWPRI_MASK);
+    }
+    else
+    {
+        txQueue = fmPacketQueueSelect(masterSw, FM_USE_VLAN_PRIORITY);
+    }
+     
+    err = fmPacketQueueLock(txQueue);
+
+    if (err != FM_OK)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+    }
+
+    oldPushIndex = txQueue->pushIndex;
+
+    for (port = 0 ; port < numPorts ; port++)
+    {
+        err = fmPacketQueueEnqueue(txQueue,
+                                   packet,
+                                   packetLength,
+                                   &islTagList[port],
+                                   islTagFormat,
+                                   FALSE,
+                                   TRUE);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+    }
+
+    /* Every entry holds a reference on the shared packet buffer; the
+     * caller's reference is handed to the first one. */
+    if (numPorts > 1)
+    {
+        err = fmRetainBufferChain(packet, numPorts - 1);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+    }
+
+    fmPacketQueueUnlock(txQueue);
+
+    if (err == FM_OK)
+    {
+        if (!fmRootPlatform->dmaEnabled)
+        {
+            fm_switch *switchPtr;
+            switchPtr = GET_SWITCH_PTR(sw);
+
+            /**************************************************
+             * We must take a lock before writing
+             * intrSendPackets because the lock is used
+             * by the API to ensure an atomic read-modify-write
+             * to intrSendPackets.
+             *
+             * The platform lock is used instead of state lock
+             * because on FIBM platforms, there is an access
+             * to intrSendPackets that must be protected before
+             * the switch's locks are even created. 
+             **************************************************/
+            
+            FM_TAKE_PKT_INT_LOCK(sw);
+            switchPtr->intrSendPackets = TRUE;
+            FM_DROP_PKT_INT_LOCK(sw);
+        }
+
+        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
+                     "fmGenericSendPacketISL: triggering interrupt handler\n");
+
+        /* Handle the following error case cleanly! */
+        err = fmPlatformTriggerInterrupt(masterSw, FM_INTERRUPT_SOURCE_API);
+
+        if (err != FM_OK)
+        {
+            /***************************************************************
+             * We are here because sem_post() fails. In this case we can not
+             * cleanly unwind the TX queue to recover, so we simply log a
+             * fatal error, and return FM_OK.
+             **************************************************************/
+            FM_LOG_FATAL(FM_LOG_CAT_EVENT_PKT_TX,
+                         "fmGenericSendPacketISL: "
+                         "fmPlatformTriggerInterrupt returned error");
 
-    portAttr = GET_PORT_ATTR(sw, port);
+            err = FM_OK;
+        }
+    }
 
-    *vlan = portAttr->defVlan;
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
 
-    return FM_OK;
+ABORT:
+    txQueue->pushIndex = oldPushIndex;
+    fmPacketQueueUnlock(txQueue);
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
 
-}   /* end fmGetPortDefVlanInt */
+}   /* end fmGenericSendPacketISL */
 
 
 
 
 /*****************************************************************************/
-/** fmGetPortDefVlanDefPriorityInt
+/** fmGenericSendPacketDirected
  * \ingroup intPlatformCommon
  *
- * \desc            Returns the port default vlan and priority.
+ * \desc            Called to add a packet to the TX packet queue.
  *
- * \note            This is an optimized version for packet processing without
- *                  any locking. The input parameters should already been
- *                  validated before calling this function.
+ * \param[in]       sw is the switch on which to send the packet.
  *
- * \param[in]       sw is the switch on which to operate.
+ * \param[in]       portList points to an array of logical port numbers the
+ *                  switch is to send the packet.
  *
- * \param[in]       port is the logical port to get the default vlan and priority.
+ * \param[in]       numPorts is the number of elements in portList.
  *
- * \param[out]      vlan points to caller allocated storage where default vlan
- *                  is stored.
+ * \param[in]       packet points to the packet buffer's first ''fm_buffer''
+ *                  structure in a chain of one or more buffers.
+ * 
+ * \param[in]       fcsValue is the value to be sent in the FCS field.
  *
- * \param[out]      priority points to caller allocated storage where default priority
- *                  is stored.
+ * \param[in]       cpuPort contains the logical port number for the CPU port. 
+ *
+ * \param[in]       switchPriority is the switch priority.
+ *
+ * \param[in]       txCookie is reported to the TX completion handler once
+ *                  the packet has been sent to every port, NULL if none.
+ *
+ * \param[in]       noWait is TRUE to fail rather than wait for the TX
+ *                  packet queue lock.
  *
  * \return          FM_OK if successful.
+ * \return          FM_ERR_TX_PACKET_QUEUE_FULL if transmit packet queue is full.
+ * \return          FM_ERR_LOCK_TIMEOUT if noWait is TRUE and the transmit
+ *                  packet queue is locked by another thread.
+ * \return          FM_FAIL if network device is not operational.
+ * \return          FM_ERR_FRAME_TOO_LARGE if the packet exceeds the maximum
+ *                  frame size for the CPU port.
+ * \return          FM_ERR_FRAME_SIZE_EXCEEDS_MTU if the frame size exceeds
+ *                  the MTU of the network interface.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
  *
  *****************************************************************************/
-fm_status fmGetPortDefVlanDefPriorityInt(fm_int     sw,
-                                         fm_int     port,
-                                         fm_uint16 *vlan,
-                                         fm_byte *  priority)
+fm_status fmGenericSendPacketDirected(fm_int     sw,
+                                      fm_int *   portList,
+                                      fm_int     numPorts,
+                                      fm_buffer *packet,
+                                      fm_uint32  fcsValue,
+                                      fm_int     cpuPort,
+                                      fm_uint32  switchPriority,
+                                      void *     txCookie,
+                                      fm_bool    noWait)
 {
-    fm_portAttr *portAttr;
+    fm_status       err = FM_OK;
+    fm_switch      *switchPtr;
+    fm_int          packetLength;
+    fm_int          listIndex;
+    fm_int          port;
+    fm_int          numEntries;
+    fm_packetInfo   tempInfo;
+    fm_int          newPortList[numPorts];
+    fm_int          entryPorts[numPorts];
+    fm_islTagFormat islTagFormats[numPorts];
+    fm_islTag       islTags[numPorts];
+    fm_bool         suppressVlanTags[numPorts];
 
-    portAttr = GET_PORT_ATTR(sw, port);
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
+                 "sw = %d, "
+                 "portList = %p, "
+                 "numPorts = %d, "
+                 "packet->index = 0x%x\n",
+                 sw,
+                 (void *) portList,
+                 numPorts,
+                 packet->index);
 
-    *vlan = portAttr->defVlan;
-    *priority = portAttr->defVlanPri;
+    /* On FIBM slaves the ISL tags are generated by the master switch */
+    switchPtr  = GET_SWITCH_PTR(GetTxMasterSwitch(sw));
+    numEntries = 0;
+    
+    /* Validate all ports are valid */
+    err = ValidatePortList(sw, portList, numPorts);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
-    return FM_OK;
+    /* Validate that the frame respects the CPU frame length */
+    err = ValidateFrameLength(sw, cpuPort, packet, &packetLength);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err); 
+    
+    /* Strip out ports that are down */
+    err = FilterPortList(sw, portList, numPorts, newPortList, packet, cpuPort);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
-}   /* end fmGetPortDefVlanDefPriorityInt */
+    for (listIndex = 0 ; listIndex < numPorts ; listIndex++)
+    {
+        port  = newPortList[listIndex];
 
+        /* If port has been filtered out, skip it */
+        if (port == -1)
+        {
+            continue;
+        }
 
+        /* tempInfo will be used to generate ISL tag */
+        memset( &tempInfo, 0, sizeof(tempInfo) ); 
 
+        /***********************************************************
+         * Update some of the parameters in tempInfo which will
+         * be used to generate ISL tag
+         **********************************************************/
 
-/*****************************************************************************/
-/** fmGenericPacketDestroy
- * \ingroup intPlatformCommon
- *
- * \desc            Performs generic packet transfer cleanup.
- *
- * \param[in]       sw is the switch number to clean.
- *
- * \return          FM_OK if successful.
- *
- *****************************************************************************/
-fm_status fmGenericPacketDestroy(fm_int sw)
-{
-    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX, "sw = %d\n", sw);
+        /* The CPU port did not get filtered out */
+        if (port == cpuPort)
+        {
+            tempInfo.directSendToCpu = TRUE;
+        }
 
-    fmPacketQueueFree(sw);
+        tempInfo.logicalPort = port;
 
-    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_OK);
+        if (switchPtr->defaultSourcePort < 0)
+        {
+            tempInfo.zeroSourceGlort = TRUE;
+        }
+        else
+        {
+            tempInfo.sourcePort = switchPtr->defaultSourcePort;
+        }
+        
+        /***********************************************************
+         * Generate ISL tag header
+         **********************************************************/
+        err = switchPtr->GeneratePacketISL(sw,
+                                           packet,
+                                           &tempInfo,
+                                           cpuPort,
+                                           switchPriority,
+                                           &islTagFormats[numEntries],
+                                           &islTags[numEntries],
+                                           &suppressVlanTags[numEntries]);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
-}   /* end fmGenericPacketDestroy */
+        entryPorts[numEntries++] = port;
+    }
+
+    err = fmGenericEnqueueDirectedPacket(sw,
+                                         packet,
+                                         packetLength,
+                                         fcsValue,
+                                         switchPriority,
+                                         numEntries,
+                                         entryPorts,
+                                         islTagFormats,
+                                         islTags,
+                                         suppressVlanTags,
+                                         txCookie,
+                                         noWait);
+
+ABORT:
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+}   /* end fmGenericSendPacketDirected */
 
 
 
 
 /*****************************************************************************/
-/** fmGenericPacketHandlingInitialize
+/** fmGenericEnqueueDirectedPacket
  * \ingroup intPlatformCommon
  *
- * \desc            Performs generic packet transfer initialization.
+ * \desc            Adds one TX packet queue entry per destination for a
+ *                  packet whose destinations and ISL tags have already been
+ *                  resolved, then wakes up the transmit path. Either all
+ *                  entries are queued or none are.
  *
- * \param[in]       sw is the switch number to initialize.
+ * \param[in]       sw is the switch on which to send the packet.
  *
- * \return          FM_OK if successful.
+ * \param[in]       packet points to the packet buffer's first ''fm_buffer''
+ *                  structure in a chain of one or more buffers.
  *
- *****************************************************************************/
-fm_status fmGenericPacketHandlingInitialize(fm_int sw)
-{
-    return fmGenericPacketHandlingInitializeV2(sw, FALSE);
-}
-
-
-
-
-/*****************************************************************************/
-/** fmGenericPacketHandlingInitializeV2
- * \ingroup intPlatformCommon
+ * \param[in]       packetLength is the length of the packet in bytes.
  *
- * \desc            Performs generic packet transfer initialization.
+ * \param[in]       fcsValue is the value to be sent in the FCS field.
  *
- * \param[in]       sw is the switch number to initialize.
- * 
- * \param[in]       hasFcs is TRUE if the packet includes the FCS field.
+ * \param[in]       switchPriority is the switch priority, which selects
+ *                  the TX packet queue.
  *
- * \return          FM_OK if successful.
+ * \param[in]       numEntries is the number of elements in each of the
+ *                  following arrays.
  *
- *****************************************************************************/
-fm_status fmGenericPacketHandlingInitializeV2(fm_int sw, fm_bool hasFcs)
-{
-    fm_packetHandlingState *ps = GET_PLAT_PKT_STATE(sw);
-    fm_status               err;
-
-    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
-                 "sw = %d hasFcs = %s\n",
-                 sw,
-                 FM_BOOLSTRING(hasFcs));
-
-    /* clear out all state */
-    memset( ps, 0, sizeof(fm_packetHandlingState) );
-
-    fmPacketQueueInit(&ps->txQueue, sw);
-    
-    /* reset state here */
-    ps->recvInProgress       = FALSE;
-    ps->recvBufferOffset     = 0;
-    ps->currentWordsReceived = 0;
-    ps->cachedEndianness     = -1; /* -1 indicates unspecified endianness */
-    ps->sendUserFcs          = hasFcs;
-    ps->rxDirectEnqueueing   = GET_PROPERTY()->rxDirectEnqueueing;
-
-    /* initialize the signal sem for event availability */
-    err = fmCreateSemaphore("netdevEventsAvailable",
-                            FM_SEM_BINARY,
-                            &ps->eventsAvailableSignal, 
-                            0);
-
-    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
-
-}   /* end fmGenericPacketHandlingInitializeV2 */
-
-
-
-
-/*****************************************************************************/
-/** fmGenericSendPacketISL
- * \ingroup intPlatformCommon
+ * \param[in]       portList points to the destination logical ports, used
+ *                  for logging only.
  *
- * \desc            Called to add a packet to the TX packet queue.
+ * \param[in]       islTagFormats points to the ISL tag format of each entry.
  *
- * \param[in]       sw is the switch on which to send the packet.
+ * \param[in]       islTags points to the ISL tag of each entry.
  *
- * \param[in]       islTagList points to an array of islTag to send out
- *                  along with packet
- * 
- * \param[in]       islTagFormat is the isl tag format. 
+ * \param[in]       suppressVlanTags points to the suppressVlanTag flag of
+ *                  each entry.
  *
- * \param[in]       numPorts is the number of elements in islTagList.
+ * \param[in]       txCookie is reported to the TX completion handler once
+ *                  the last entry is retired, NULL if none.
  *
- * \param[in]       packet points to the packet buffer's first ''fm_buffer''
- *                  structure in a chain of one or more buffers.
+ * \param[in]       noWait is TRUE to fail rather than wait for the TX
+ *                  packet queue lock.
  *
  * \return          FM_OK if successful.
  * \return          FM_ERR_TX_PACKET_QUEUE_FULL if transmit packet queue is full.
+ * \return          FM_ERR_LOCK_TIMEOUT if noWait is TRUE and the transmit
+ *                  packet queue is locked by another thread.
  * \return          FM_FAIL if network device is not operational.
- * \return          FM_ERR_FRAME_TOO_LARGE if the packet exceeds the maximum
- *                  frame size for the CPU port.
  * \return          FM_ERR_FRAME_SIZE_EXCEEDS_MTU if the frame size exceeds
  *                  the MTU of the network interface.
- * \return          Other ''Status Codes'' as appropriate in case of
- *                  failure.
  *
  *****************************************************************************/
-fm_status fmGenericSendPacketISL(fm_int          sw,
-                                 fm_islTag *     islTagList,
-                                 fm_islTagFormat islTagFormat,
-                                 fm_int          numPorts,
-                                 fm_buffer *     packet)
+fm_status fmGenericEnqueueDirectedPacket(fm_int            sw,
+                                         fm_buffer *       packet,
+                                         fm_int            packetLength,
+                                         fm_uint32         fcsValue,
+                                         fm_uint32         switchPriority,
+                                         fm_int            numEntries,
+                                         fm_int *          portList,
+                                         fm_islTagFormat * islTagFormats,
+                                         fm_islTag *       islTags,
+                                         fm_bool *         suppressVlanTags,
+                                         void *            txCookie,
+                                         fm_bool           noWait)
 {
+    fm_status       err = FM_OK;
+    fm_switch      *switchPtr;
     fm_packetQueue *txQueue;
-    fm_int          packetLength;
-    fm_int          port;
-    fm_int          cpuMaxFrameSize;
+    fm_packetEntry *entry;
+    fm_int          index;
     fm_int          oldPushIndex;
-    fm_int          cpuPort;
-    fm_int          masterSw; /* For support FIBM slave switch */
-    fm_status       err = FM_OK;
-    fm_bool         isRawSocket;
-    fm_int          mtu;
-
-    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
-                 "sw = %d, "
-                 "islTag = %p, "
-                 "numPorts = %d, "
-                 "packet->index = 0x%x\n",
-                 sw,
-                 (void *) islTagList,
-                 numPorts,
-                 packet->index);
+    fm_int          masterSw; /* For support FIBM slave switch */
+    fm_bool         packetQueueLockFlag;
+    fm_bool         isRawSocket;
+    fm_int          mtu;
 
-    masterSw = fmFibmSlaveGetMasterSwitch(sw);
+    /* We are sending packet via master switch on FIBM slaves. There is
+     * no platform lock on slave switch in master slave mode. */
+    masterSw            = GetTxMasterSwitch(sw);
+    switchPtr           = GET_SWITCH_PTR(masterSw);
+    txQueue             = fmPacketQueueSelect(masterSw, switchPriority);
+    oldPushIndex        = -1;
+    packetQueueLockFlag = FALSE;
 
-    if (masterSw >= 0)
+    /* Verify that the packet respects the MTU of the network device. */
+    if (!fmIsRawPacketSocketDeviceOperational(masterSw, &isRawSocket, &mtu))
     {
-        VALIDATE_AND_PROTECT_SWITCH_NO_RETURN(err, masterSw);
-        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
-        
-        err = fmGetCpuPortInt(masterSw, &cpuPort);
-        
-        if (err == FM_OK)
-        {
-            err = fmGetPortMaxFrameSizeInt(masterSw,
-                                           cpuPort,
-                                           &cpuMaxFrameSize);
-        }
-        
-        UNPROTECT_SWITCH(masterSw);
-        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+        return FM_FAIL;
     }
-    else
+
+    if ( isRawSocket && (packetLength > mtu - 4) )
     {
-        /* This is for FIBM using the NIC. */
-        cpuMaxFrameSize = 10000; /* Just allow to pass */
-        
-        /* Standalone use itself as master switch */
-        masterSw = sw;
+        return FM_ERR_FRAME_SIZE_EXCEEDS_MTU;
     }
 
-    packetLength = fmComputeTotalPacketLength(packet);
-    if (packetLength <= 0)
+    if (noWait)
     {
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_INVALID_ARGUMENT);
+        if (!fmPacketQueueTryLock(txQueue))
+        {
+            return FM_ERR_LOCK_TIMEOUT;
+        }
+    }
+    else if (fmPacketQueueLock(txQueue) != FM_OK)
+    {
+        return FM_ERR_UNABLE_TO_LOCK;
     }
+    packetQueueLockFlag = TRUE;
 
-    /* Verify that the packet respects the CPU maximum frame size. */
-    if (packetLength > cpuMaxFrameSize - 4)
+    /***********************************************************
+     * oldSendPushIndex records the current push index in the TX
+     * queue. We use it to keep tab on where we started upon
+     * entering this function, in case of the need for roll back
+     * on the push index when (1) the tx queue is full; or (2)
+     * the function calls returns an error which we return to the
+     * user application, after having enqued some entries in the
+     * tx queue.
+     **********************************************************/
+    oldPushIndex = txQueue->pushIndex;
+
+    for (index = 0 ; index < numEntries ; index++)
     {
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_FRAME_TOO_LARGE);
+        entry = &txQueue->packetQueueList[txQueue->pushIndex];
+
+        /* Build the packetEntry */
+        entry->packet           = packet;
+        entry->length           = packetLength;
+        entry->fcsVal           = fcsValue;
+        entry->islTagFormat     = islTagFormats[index];
+        entry->islTag           = islTags[index];
+        entry->suppressVlanTag  = suppressVlanTags[index];
+        entry->freePacketBuffer = TRUE;
+        entry->txCookie         = (index == numEntries - 1) ? txCookie : NULL;
+
+        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
+                     "fmGenericSendPacketDirected: packet queued "
+                     "in slot %d, length %d bytes, port %d\n",
+                     txQueue->pushIndex,
+                     entry->length,
+                     portList[index]);
+
+        err = fmPacketQueueUpdate(txQueue);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
     }
 
-    /* Verify that the packet respects the MTU of the network device. */
-    if (!fmIsRawPacketSocketDeviceOperational(masterSw, &isRawSocket, &mtu))
+    /* Every entry holds a reference on the shared packet buffer; the
+     * caller's reference is handed to the first one. */
+    if (numEntries > 1)
     {
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_FAIL);
+        err = fmRetainBufferChain(packet, numEntries - 1);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
     }
 
-    if (isRawSocket && (packetLength > mtu - 4))
+    fmPacketQueueUnlock(txQueue);
+    packetQueueLockFlag = FALSE;
+
+    if (!fmRootPlatform->dmaEnabled)
     {
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_FRAME_SIZE_EXCEEDS_MTU);
+        /**************************************************
+         * We must take a lock before writing
+         * intrSendPackets because the lock is used
+         * by the API to ensure an atomic read-modify-write
+         * to intrSendPackets.
+         *
+         * The platform lock is used instead of state lock
+         * because on FIBM platforms, there is an access
+         * to intrSendPackets that must be protected before
+         * the switch's locks are even created. 
+         **************************************************/
+        
+        FM_TAKE_PKT_INT_LOCK(sw);
+        switchPtr->intrSendPackets = TRUE;
+        FM_DROP_PKT_INT_LOCK(sw);
     }
 
-    txQueue = &GET_PLAT_PKT_STATE(masterSw)->txQueue;
-     
-    fmPacketQueueLock(txQueue);
+    FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
+                 "fmGenericSendPacketDirected: "
+                 "triggering interrupt handler\n");
 
-    oldPushIndex = txQueue->pushIndex;
+    err = fmPlatformTriggerInterrupt(masterSw, FM_INTERRUPT_SOURCE_API);
 
-    for (port = 0 ; port < numPorts ; port++)
+    /* Handle the following error case cleanly! */
+    if (err != FM_OK)
     {
-        fm_bool freePacketBuffer;
+        /***************************************************************
+         * We are here because sem_post() fails. In this case we can not
+         * cleanly unwind the TX queue to recover, so we simply log a
+         * fatal error, and return FM_OK.
+         **************************************************************/
+        FM_LOG_FATAL(FM_LOG_CAT_EVENT_PKT_TX, 
+                     "fmGenericSendPacket: "
+                     "fmPlatformTriggerInterrupt returned error");
 
-        if (port < numPorts - 1)
-        {
-            freePacketBuffer = FALSE;
-        }
-        else
+        err = FM_OK;
+    }
+
+ABORT:
+    if (packetQueueLockFlag)
+    {
+        /* There was an error, lets restore the txQueue's push index */
+        if (oldPushIndex != -1)
         {
-            /* only free the packet buffer if we have sent to all target
-             *  ports in the vlan */
-            freePacketBuffer = TRUE;
+            txQueue->pushIndex = oldPushIndex;
         }
-        err = fmPacketQueueEnqueue(txQueue,
-                                   packet,
-                                   packetLength,
-                                   &islTagList[port],
-                                   islTagFormat,
-                                   FALSE,
-                                   freePacketBuffer);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+        fmPacketQueueUnlock(txQueue);
     }
 
-    fmPacketQueueUnlock(txQueue);
+    return err;
 
-    if (err == FM_OK)
-    {
-        if (!fmRootPlatform->dmaEnabled)
-        {
-            fm_switch *switchPtr;
-            switchPtr = GET_SWITCH_PTR(sw);
+}   /* end fmGenericEnqueueDirectedPacket */
 
-            /**************************************************
-             * We must take a lock before writing
-             * intrSendPackets because the lock is used
-             * by the API to ensure an atomic read-modify-write
-             * to intrSendPackets.
-             *
-             * The platform lock is used instead of state lock
-             * because on FIBM platforms, there is an access
-             * to intrSendPackets that must be protected before
-             * the switch's locks are even created. 
-             **************************************************/
-            
-            FM_TAKE_PKT_INT_LOCK(sw);
-            switchPtr->intrSendPackets = TRUE;
-            FM_DROP_PKT_INT_LOCK(sw);
-        }
 
-        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
-                     "fmGenericSendPacketISL: triggering interrupt handler\n");
 
-        /* Handle the following error case cleanly! */
-        err = fmPlatformTriggerInterrupt(masterSw, FM_INTERRUPT_SOURCE_API);
 
-        if (err != FM_OK)
-        {
-            /***************************************************************
-             * We are here because sem_post() fails. In this case we can not
-             * cleanly unwind the TX queue to recover, so we simply log a
-             * fatal error, and return FM_OK.
-             **************************************************************/
-            FM_LOG_FATAL(FM_LOG_CAT_EVENT_PKT_TX,
-                         "fmGenericSendPacketISL: "
-                         "fmPlatformTriggerInterrupt returned error");
+/*****************************************************************************/
+/** fmGenericGetTxQueueSpace
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Returns the number of free entries in the TX packet
+ *                  queue serving a switch priority. The queue is not
+ *                  locked, so the value is only a hint: entries staged by
+ *                  a producer that has not yet published them are counted
+ *                  as free.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       switchPriority is the switch priority.
+ *
+ * \param[out]      space points to caller-allocated storage where this
+ *                  function should place the number of free entries.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmGenericGetTxQueueSpace(fm_int    sw,
+                                   fm_uint32 switchPriority,
+                                   fm_int *  space)
+{
+    fm_packetQueue *txQueue;
+    fm_uint         pullIndex;
+    fm_uint         depth;
 
-            err = FM_OK;
-        }
+    txQueue = fmPacketQueueSelect(GetTxMasterSwitch(sw), switchPriority);
+
+    if (txQueue->size == 0)
+    {
+        *space = 0;
+        return FM_OK;
     }
 
-    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+    pullIndex = FM_ATOMIC_LOAD(&txQueue->pullIndex);
+    depth     = (fmPacketQueueGetTail(txQueue) + txQueue->size - pullIndex) %
+                txQueue->size;
 
-ABORT:
-    txQueue->pushIndex = oldPushIndex;
-    fmPacketQueueUnlock(txQueue);
-    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+    /* One slot always stays empty to tell a full queue from an empty one */
+    *space = txQueue->size - 1 - depth;
 
-}   /* end fmGenericSendPacketISL */
+    return FM_OK;
+
+}   /* end fmGenericGetTxQueueSpace */
 
 
 
 
 /*****************************************************************************/
-/** fmGenericSendPacketDirected
+/** fmGenericCreateTxDestination
  * \ingroup intPlatformCommon
  *
- * \desc            Called to add a packet to the TX packet queue.
+ * \desc            Allocates a TX destination handle for a list of ports.
+ *                  The handle is compiled on its first use.
  *
- * \param[in]       sw is the switch on which to send the packet.
+ * \param[in]       sw is the switch on which to operate.
  *
- * \param[in]       portList points to an array of logical port numbers the
- *                  switch is to send the packet.
+ * \param[in]       portList points to an array of logical port numbers.
  *
  * \param[in]       numPorts is the number of elements in portList.
  *
- * \param[in]       packet points to the packet buffer's first ''fm_buffer''
- *                  structure in a chain of one or more buffers.
- * 
- * \param[in]       fcsValue is the value to be sent in the FCS field.
- *
- * \param[in]       cpuPort contains the logical port number for the CPU port. 
- *
- * \param[in]       switchPriority is the switch priority.
+ * \param[out]      destHandle points to caller-allocated storage where
+ *                  this function should place the handle.
  *
  * \return          FM_OK if successful.
- * \return          FM_ERR_TX_PACKET_QUEUE_FULL if transmit packet queue is full.
- * \return          FM_FAIL if network device is not operational.
- * \return          FM_ERR_FRAME_TOO_LARGE if the packet exceeds the maximum
- *                  frame size for the CPU port.
- * \return          FM_ERR_FRAME_SIZE_EXCEEDS_MTU if the frame size exceeds
- *                  the MTU of the network interface.
- * \return          Other ''Status Codes'' as appropriate in case of
- *                  failure.
+ * \return          FM_ERR_INVALID_PORT if a port is invalid.
+ * \return          FM_ERR_NO_FREE_RESOURCES if all handles are in use.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
  *
  *****************************************************************************/
-fm_status fmGenericSendPacketDirected(fm_int     sw,
-                                      fm_int *   portList,
-                                      fm_int     numPorts,
-                                      fm_buffer *packet,
-                                      fm_uint32  fcsValue,
-                                      fm_int     cpuPort,
-                                      fm_uint32  switchPriority)
+fm_status fmGenericCreateTxDestination(fm_int  sw,
+                                       fm_int *portList,
+                                       fm_int  numPorts,
+                                       fm_int *destHandle)
 {
-    fm_status       err = FM_OK;
-    fm_switch      *switchPtr;
-    fm_packetQueue *txQueue;
-    fm_packetEntry *entry;
-    fm_int          packetLength;
-    fm_int          listIndex;
-    fm_int          port;
-    fm_packetInfo   tempInfo;
-    fm_int          oldPushIndex;
-    fm_int          masterSw; /* For support FIBM slave switch */
-    fm_int          newPortList[numPorts];
-    fm_bool         packetQueueLockFlag;
-    fm_bool         isRawSocket;
-    fm_int          mtu;
+    fm_packetHandlingState *ps;
+    fm_txDestination *      dest;
+    fm_txDestinationPort *  ports;
+    fm_status               err;
+    fm_int                  handle;
+    fm_int                  i;
 
     FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
-                 "sw = %d, "
-                 "portList = %p, "
-                 "numPorts = %d, "
-                 "packet->index = 0x%x\n",
+                 "sw = %d, portList = %p, numPorts = %d\n",
                  sw,
                  (void *) portList,
-                 numPorts,
-                 packet->index);
+                 numPorts);
+
+    ps = GET_PLAT_PKT_STATE(sw);
 
-    switchPtr           = GET_SWITCH_PTR(sw);
-    txQueue             = &GET_PLAT_PKT_STATE(sw)->txQueue;
-    oldPushIndex        = -1;
-    packetQueueLockFlag = FALSE;
-    
-    /* Validate all ports are valid */
     err = ValidatePortList(sw, portList, numPorts);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+    ports = fmAlloc(numPorts * sizeof(fm_txDestinationPort));
+    if (ports == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_NO_MEM);
+    }
+
+    memset(ports, 0, numPorts * sizeof(fm_txDestinationPort));
+
+    for (i = 0 ; i < numPorts ; i++)
+    {
+        ports[i].port = portList[i];
+    }
 
-    /* Validate that the frame respects the CPU frame length */
-    err = ValidateFrameLength(sw, cpuPort, packet, &packetLength);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err); 
-    
-    /* Strip out ports that are down */
-    err = FilterPortList(sw, portList, numPorts, newPortList, packet, cpuPort);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+    pthread_mutex_lock(&ps->txDestMutex);
 
-    if (fmRootApi->isSwitchFibmSlave[sw])
+    for (handle = 0 ; handle < FM_MAX_TX_DESTINATIONS ; handle++)
     {
-        masterSw  = fmFibmSlaveGetMasterSwitch(sw);
-        if (masterSw < 0)
-        {
-            /* In standalone NIC mode, the 
-             * master is also the same as the slave.
-             */
-            masterSw = sw;
-        }
-        else
+        if (!ps->txDestinations[handle].used)
         {
-            /* We are sending packet via master switch
-             * These is no platform lock on slave switch in 
-             * master slave mode.
-             */
-            switchPtr = GET_SWITCH_PTR(masterSw);
-            txQueue   = &GET_PLAT_PKT_STATE(masterSw)->txQueue;
+            break;
         }
     }
-    else
+
+    if (handle >= FM_MAX_TX_DESTINATIONS)
     {
-        masterSw = sw;
+        pthread_mutex_unlock(&ps->txDestMutex);
+        fmFree(ports);
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_NO_FREE_RESOURCES);
     }
 
-    /* Verify that the packet respects the MTU of the network device. */
-    if (!fmIsRawPacketSocketDeviceOperational(masterSw, &isRawSocket, &mtu))
+    dest = &ps->txDestinations[handle];
+
+    memset(dest, 0, sizeof(*dest));
+    dest->used     = TRUE;
+    dest->numPorts = numPorts;
+    dest->ports    = ports;
+
+    pthread_mutex_unlock(&ps->txDestMutex);
+
+    *destHandle = handle;
+
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_OK);
+
+}   /* end fmGenericCreateTxDestination */
+
+
+
+
+/*****************************************************************************/
+/** fmGenericDeleteTxDestination
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Releases a TX destination handle.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       destHandle is the handle to release.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if destHandle is out of range.
+ * \return          FM_ERR_NOT_FOUND if destHandle is not allocated.
+ *
+ *****************************************************************************/
+fm_status fmGenericDeleteTxDestination(fm_int sw, fm_int destHandle)
+{
+    fm_txDestination *dest;
+    fm_status         err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
+                 "sw = %d, destHandle = %d\n",
+                 sw,
+                 destHandle);
+
+    err = fmGenericAcquireTxDestination(sw, destHandle, &dest);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+    fmFree(dest->ports);
+    memset(dest, 0, sizeof(*dest));
+
+    fmGenericReleaseTxDestination(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_OK);
+
+}   /* end fmGenericDeleteTxDestination */
+
+
+
+
+/*****************************************************************************/
+/** fmGenericAcquireTxDestination
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Looks up a TX destination handle and locks the TX
+ *                  destination table. On success, the caller must release
+ *                  the table with ''fmGenericReleaseTxDestination''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       destHandle is the handle to look up.
+ *
+ * \param[out]      destPtr points to caller-allocated storage where this
+ *                  function should place a pointer to the handle state.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if destHandle is out of range.
+ * \return          FM_ERR_NOT_FOUND if destHandle is not allocated.
+ *
+ *****************************************************************************/
+fm_status fmGenericAcquireTxDestination(fm_int             sw,
+                                        fm_int             destHandle,
+                                        fm_txDestination **destPtr)
+{
+    fm_packetHandlingState *ps;
+
+    if ( (destHandle < 0) || (destHandle >= FM_MAX_TX_DESTINATIONS) )
     {
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_FAIL);
+        return FM_ERR_INVALID_ARGUMENT;
     }
 
-    if ( isRawSocket && (packetLength > mtu - 4) )
+    ps = GET_PLAT_PKT_STATE(sw);
+
+    pthread_mutex_lock(&ps->txDestMutex);
+
+    if (!ps->txDestinations[destHandle].used)
     {
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_FRAME_SIZE_EXCEEDS_MTU);
+        pthread_mutex_unlock(&ps->txDestMutex);
+        return FM_ERR_NOT_FOUND;
     }
 
-    fmPacketQueueLock(txQueue);
-    packetQueueLockFlag = TRUE;
+    *destPtr = &ps->txDestinations[destHandle];
 
-    /***********************************************************
-     * oldSendPushIndex records the current push index in the TX
-     * queue. We use it to keep tab on where we started upon
-     * entering this function, in case of the need for roll back
-     * on the push index when (1) the tx queue is full; or (2)
-     * the function calls returns an error which we return to the
-     * user application, after having enqued some entries in the
-     * tx queue.
-     **********************************************************/
-    oldPushIndex = txQueue->pushIndex;
+    return FM_OK;
 
-    for (listIndex = 0 ; listIndex < numPorts ; listIndex++)
-    {
-        port  = newPortList[listIndex];
+}   /* end fmGenericAcquireTxDestination */
 
-        /* If port has been filtered out, skip it */
-        if (port == -1)
-        {
-            continue;
-        }
 
-        /* tempInfo will be used to generate ISL tag */
-        memset( &tempInfo, 0, sizeof(tempInfo) ); 
-        entry = &txQueue->packetQueueList[txQueue->pushIndex];
 
-        /* Build the packetEntry */
-        entry->packet = packet;
-        entry->length = packetLength;
-        entry->fcsVal = fcsValue;
 
-        /***********************************************************
-         * Update some of the parameters in tempInfo which will
-         * be used to generate ISL tag
-         **********************************************************/
+/*****************************************************************************/
+/** fmGenericReleaseTxDestination
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Unlocks the TX destination table locked by
+ *                  ''fmGenericAcquireTxDestination''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmGenericReleaseTxDestination(fm_int sw)
+{
+    fm_packetHandlingState *ps;
 
-        /* The CPU port did not get filtered out */
-        if (port == cpuPort)
-        {
-            tempInfo.directSendToCpu = TRUE;
-        }
+    ps = GET_PLAT_PKT_STATE(sw);
 
-        tempInfo.logicalPort = port;
+    pthread_mutex_unlock(&ps->txDestMutex);
 
-        if (switchPtr->defaultSourcePort < 0)
-        {
-            tempInfo.zeroSourceGlort = TRUE;
-        }
-        else
-        {
-            tempInfo.sourcePort = switchPtr->defaultSourcePort;
-        }
-        
-        /***********************************************************
-         * Generate ISL tag header
-         **********************************************************/
-        err = switchPtr->GeneratePacketISL(sw,
-                                           packet,
-                                           &tempInfo,
-                                           cpuPort,
-                                           switchPriority,
-                                           &entry->islTagFormat,
-                                           &entry->islTag,
-                                           &entry->suppressVlanTag);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+}   /* end fmGenericReleaseTxDestination */
 
-        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
-                     "fmGenericSendPacketDirected: packet queued "
-                     "in slot %d, length %d bytes, port %d\n",
-                     txQueue->pushIndex,
-                     entry->length,
-                     port);
 
-        err = fmPacketQueueUpdate(txQueue);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
-        if (listIndex < numPorts - 1)
-        {
-            entry->freePacketBuffer = FALSE;
-        }
-        else
-        {
-            /* only free the packet buffer if we have sent to all target
-            *  ports in the vlan */
-            entry->freePacketBuffer = TRUE;
-        }
-    }
 
-    fmPacketQueueUnlock(txQueue);
-    packetQueueLockFlag = FALSE;
+/*****************************************************************************/
+/** fmGenericCompileTxDestination
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Performs the family-independent part of compiling a TX
+ *                  destination: validates its ports, filters out empty LAGs
+ *                  and the CPU port when direct sending to it is disabled,
+ *                  and records the CPU port maximum frame size and the
+ *                  default source port. These are the checks
+ *                  ''fmGenericSendPacketDirected'' repeats on every send.
+ *
+ * \note            The caller must have acquired the destination, and sets
+ *                  dest->compiled once the ISL tag templates are filled in.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   dest points to the TX destination to compile.
+ *
+ * \param[in]       cpuPort contains the logical port number for the CPU port.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_PORT if a port is no longer valid.
+ * \return          FM_ERR_INVALID_PORT_STATE if a LAG has no member ports.
+ *
+ *****************************************************************************/
+fm_status fmGenericCompileTxDestination(fm_int             sw,
+                                        fm_txDestination * dest,
+                                        fm_int             cpuPort)
+{
+    fm_switch *           switchPtr;
+    fm_txDestinationPort *destPort;
+    fm_port *             portPtr;
+    fm_status             err = FM_OK;
+    fm_uint32             generation;
+    fm_bool               isLagPortUp;
+    fm_int                i;
 
-    if (err == FM_OK)
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    /* Sample the generation first, so that a change made while compiling
+     * leaves the destination stale. */
+    generation     = FM_ATOMIC_LOAD(&switchPtr->txDestGeneration);
+    dest->compiled = FALSE;
+
+    for (i = 0 ; i < dest->numPorts ; i++)
     {
-        if (!fmRootPlatform->dmaEnabled)
+        destPort = &dest->ports[i];
+
+        if ( !fmIsValidPort(sw,
+                            destPort->port,
+                            ALLOW_CPU | ALLOW_LAG | ALLOW_REMOTE) )
         {
-            /**************************************************
-             * We must take a lock before writing
-             * intrSendPackets because the lock is used
-             * by the API to ensure an atomic read-modify-write
-             * to intrSendPackets.
-             *
-             * The platform lock is used instead of state lock
-             * because on FIBM platforms, there is an access
-             * to intrSendPackets that must be protected before
-             * the switch's locks are even created. 
-             **************************************************/
-            
-            FM_TAKE_PKT_INT_LOCK(sw);
-            switchPtr->intrSendPackets = TRUE;
-            FM_DROP_PKT_INT_LOCK(sw);
+            err = FM_ERR_INVALID_PORT;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
         }
 
-        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
-                     "fmGenericSendPacketDirected: "
-                     "triggering interrupt handler\n");
+        portPtr = GET_PORT_PTR(sw, destPort->port);
 
-        err = fmPlatformTriggerInterrupt(masterSw, FM_INTERRUPT_SOURCE_API);
+        destPort->isLag           = (portPtr->portType == FM_PORT_TYPE_LAG);
+        destPort->skip            = FALSE;
+        destPort->directSendToCpu = FALSE;
 
-        /* Handle the following error case cleanly! */
-        if (err != FM_OK)
+        if (destPort->isLag)
         {
-            /***************************************************************
-             * We are here because sem_post() fails. In this case we can not
-             * cleanly unwind the TX queue to recover, so we simply log a
-             * fatal error, and return FM_OK.
-             **************************************************************/
-            FM_LOG_FATAL(FM_LOG_CAT_EVENT_PKT_TX, 
-                         "fmGenericSendPacket: "
-                         "fmPlatformTriggerInterrupt returned error");
+            err = IsValidLagPort(sw, destPort->port, &isLagPortUp);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
-            err = FM_OK;
+            destPort->skip = !isLagPortUp;
         }
-    }
-
-ABORT:
-    if (packetQueueLockFlag)
-    {
-        /* There was an error, lets restore the txQueue's push index */
-        if (oldPushIndex != -1)
+        else if (destPort->port == cpuPort)
         {
-            txQueue->pushIndex = oldPushIndex;
+            if (GET_PROPERTY()->directSendToCpu)
+            {
+                destPort->directSendToCpu = TRUE;
+            }
+            else
+            {
+                destPort->skip = TRUE;
+            }
         }
-
-        fmPacketQueueUnlock(txQueue);
     }
 
-    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+    err = fmGetPortMaxFrameSizeInt(sw, cpuPort, &dest->cpuMaxFrameSize);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
-}   /* end fmGenericSendPacketDirected */
+    /* On FIBM slaves the source port is that of the master switch */
+    dest->sourcePort = GET_SWITCH_PTR(GetTxMasterSwitch(sw))->defaultSourcePort;
+    dest->cpuPort    = cpuPort;
+    dest->generation = generation;
+
+ABORT:
+    return err;
+
+}   /* end fmGenericCompileTxDestination */
 
 
 
@@ -1766,7 +2848,7 @@ fm_status fmGenericSendPacketSwitched(fm_int     sw,
                  sw,
                  packet->index);
 
-    txQueue   = &GET_PLAT_PKT_STATE(sw)->txQueue;
+    txQueue   = fmPacketQueueSelect(sw, switchPriority);
 
     err = ValidateFrameLength(sw, cpuPort, packet, &packetLength);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
@@ -1788,7 +2870,7 @@ fm_status fmGenericSendPacketSwitched(fm_int     sw,
              * master slave mode.
              */
             switchPtr = GET_SWITCH_PTR(masterSw);
-            txQueue   = &GET_PLAT_PKT_STATE(masterSw)->txQueue;
+            txQueue   = fmPacketQueueSelect(masterSw, switchPriority);
         }
     }
     else
@@ -1807,7 +2889,12 @@ fm_status fmGenericSendPacketSwitched(fm_int     sw,
         FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_FRAME_SIZE_EXCEEDS_MTU);
     }
 
-    fmPacketQueueLock(txQueue); 
+    err = fmPacketQueueLock(txQueue);
+
+    if (err != FM_OK)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+    }
 
     entry = &txQueue->packetQueueList[txQueue->pushIndex];
 
@@ -1816,6 +2903,7 @@ fm_status fmGenericSendPacketSwitched(fm_int     sw,
     entry->length           = packetLength;
     entry->fcsVal           = FM_USE_DEFAULT_FCS;
     entry->freePacketBuffer = TRUE;
+    entry->txCookie         = NULL;
 
     memset(&tempInfo,0,sizeof(fm_packetInfo));
     tempInfo.logicalPort     = FM_LOG_PORT_USE_FTYPE_NORMAL;
@@ -1953,7 +3041,7 @@ fm_status fmGenericSendPacket(fm_int         sw,
     fm_int          firstPort;
     fm_int          nextPort;
     fm_int          state;
-    fm_bool         packetSent = FALSE;
+    fm_int          numQueued = 0;
     fm_port        *dPort;
     fm_int          firstLAGPort;
     fm_bool         allowDirectSendToCpu = TRUE;
@@ -2032,9 +3120,18 @@ fm_status fmGenericSendPacket(fm_int         sw,
         FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_FRAME_SIZE_EXCEEDS_MTU);
     }
 
-    txQueue = &GET_PLAT_PKT_STATE(masterSw)->txQueue;
+    /* Same precedence as the SWPRI field of the ISL tag */
+    txQueue = fmPacketQueueSelect(masterSw,
+                                  (switchPriority != FM_USE_VLAN_PRIORITY)
+                                      ? switchPriority
+                                      : info->switchPriority);
 
-    fmPacketQueueLock(txQueue);
+    err = fmPacketQueueLock(txQueue);
+
+    if (err != FM_OK)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+    }
 
     /***********************************************************
      * oldSendPushIndex records the current push index in the TX
@@ -2134,6 +3231,7 @@ fm_status fmGenericSendPacket(fm_int         sw,
         entry->length = packetLength;
         entry->fcsVal = FM_USE_DEFAULT_FCS;
         entry->freePacketBuffer = TRUE;
+        entry->txCookie = NULL;
 
         /* The rest of entry fields are generated here */
         err = switchPtr->GeneratePacketISL(sw,
@@ -2185,11 +3283,13 @@ fm_status fmGenericSendPacket(fm_int         sw,
             entry->packet = packet;
             entry->length = packetLength;
             entry->fcsVal = FM_USE_DEFAULT_FCS;
+            entry->freePacketBuffer = TRUE;
+            entry->txCookie = NULL;
 
             /**********************************************************
              * If any of ports in the vlan info->directSendVlanId
              * is UP and not in Blocking or Disabled state in outVlanId
-             * we will flag packetSent as TRUE, so that the packet
+             * we will count it in numQueued, so that the packet
              * buffer will not be freed
              *********************************************************/
             if (firstPort != cpuPort)
@@ -2238,7 +3338,7 @@ fm_status fmGenericSendPacket(fm_int         sw,
                 err = fmPacketQueueUpdate(txQueue);
                 FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
-                packetSent = TRUE;
+                numQueued++;
             }
 
             err = fmGetVlanPortNext(sw,
@@ -2264,23 +3364,10 @@ fm_status fmGenericSendPacket(fm_int         sw,
                 FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
             }
 
-            if (nextPort != -1)
-            {
-                entry->freePacketBuffer = FALSE;
-            }
-            else
-            {
-                /*******************************************************
-                 * Free the packet buffer if we have sent to all target
-                 * ports in the vlan.
-                 ******************************************************/
-                entry->freePacketBuffer = TRUE;
-            }
-
             firstPort = nextPort;
         }
 
-        if (!packetSent)
+        if (numQueued == 0)
         {
             /***************************************************************
              * If none of the ports in the info->directSendVlanId is in the
@@ -2290,6 +3377,14 @@ fm_status fmGenericSendPacket(fm_int         sw,
             err = FM_ERR_INVALID_PORT_STATE;
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
         }
+
+        /* Every entry holds a reference on the shared packet buffer; the
+         * caller's reference is handed to the first one. */
+        if (numQueued > 1)
+        {
+            err = fmRetainBufferChain(packet, numQueued - 1);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+        }
     }
 
     fmPacketQueueUnlock(txQueue);
@@ -59,6 +59,18 @@
 #define RECV_BUFFER_THRESHOLD           4
 #define ABSOLUTE_MAX_MTU_BYTES          16384
 
+/**************************************************
+ * TX batching: frames taken from a TX queue per
+ * pass, and the staging space they share. Each
+ * frame adds at most an F56 tag and the FCS to the
+ * packet, and its slot is padded to 64 bits since
+ * the interface is fed 8 bytes at a time.
+ **************************************************/
+#define PTI_TX_BATCH_FRAMES             16
+#define PTI_TX_BATCH_BYTES              (4 * ABSOLUTE_MAX_MTU_BYTES)
+#define PTI_TX_FRAME_OVERHEAD           (8 + 4)
+#define PTI_TX_FRAME_SLOT(len)          ( ((len) + 7) & ~7 )
+
 /******************************************************************************
  * Local function prototypes
  *****************************************************************************/
@@ -66,6 +78,8 @@
 static fm_uint32 ReverseBytes(fm_uint32 word);
 static fm_status DumpPacket(fm_uint64 cat, fm_byte *data, fm_int length);
 static fm_status AppendCRC32(fm_byte* data, fm_int pktSize, fm_bool f56Tagged);
+static fm_int    BuildTxFrame(fm_packetEntry *pkt, fm_byte *data);
+static fm_status WaitTxIdle(fm_switch *switchPtr, fm_int sw);
 
 
 
@@ -223,6 +237,124 @@ static fm_status AppendCRC32(fm_byte* data, fm_int pktSize, fm_bool f56Tagged)
 
 
 
+/*****************************************************************************/
+/** BuildTxFrame
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Builds the frame sent over PTI for a TX queue entry:
+ *                  its F56 tag, if any, the packet data and the FCS.
+ *
+ * \param[in]       pkt points to the TX queue entry.
+ *
+ * \param[out]      data points to the space where the frame is built, at
+ *                  least pkt->length + PTI_TX_FRAME_OVERHEAD bytes.
+ *
+ * \return          The length of the frame in bytes.
+ *
+ *****************************************************************************/
+static fm_int BuildTxFrame(fm_packetEntry *pkt, fm_byte *data)
+{
+    fm_buffer * buffer;
+    fm_bool     f56Tagged;
+    fm_int      curB;
+    fm_int      curBufB;
+    fm_int      i;
+    fm_uint     mask;
+    fm_int      shiftBits;
+
+    f56Tagged = (pkt->islTagFormat == FM_ISL_TAG_F56);
+    curB      = 0;
+
+    if (f56Tagged)
+    {
+        data[curB++] = (pkt->islTag.f56.tag[0] & 0xFF000000) >> 24;
+        data[curB++] = (pkt->islTag.f56.tag[0] & 0x00FF0000) >> 16;
+        data[curB++] = (pkt->islTag.f56.tag[0] & 0x0000FF00) >> 8;
+        data[curB++] = (pkt->islTag.f56.tag[0] & 0x000000FF);
+
+        data[curB++] = (pkt->islTag.f56.tag[1] & 0xFF000000) >> 24;
+        data[curB++] = (pkt->islTag.f56.tag[1] & 0x00FF0000) >> 16;
+        data[curB++] = (pkt->islTag.f56.tag[1] & 0x0000FF00) >> 8;
+        data[curB++] = (pkt->islTag.f56.tag[1] & 0x000000FF);
+    }
+
+    /**************************************************
+     * Iterate through all buffers in this packet. The
+     * buffers cannot be modified, since the same buffer
+     * can be used to send to multiple ports.
+     **************************************************/
+
+    for (buffer = pkt->packet ; buffer != NULL ; buffer = buffer->next)
+    {
+        /* 32-bits at a time */
+        curBufB = 0;
+        for (i = 0 ; i < (buffer->len / 4) ; i++)
+        {
+            data[curB++] = (buffer->data[i] & 0x000000FF);
+            data[curB++] = (buffer->data[i] & 0x0000FF00) >> 8;
+            data[curB++] = (buffer->data[i] & 0x00FF0000) >> 16;
+            data[curB++] = (buffer->data[i] & 0xFF000000) >> 24;
+            curBufB += 4;
+        }
+
+        /* Remaining Bytes: 1 - 4 */
+        mask      = 0xFF;
+        shiftBits = 0;
+        while (curBufB < buffer->len)
+        {
+            data[curB++] = ((buffer->data[i] & mask) >> shiftBits);
+            mask <<= 8;
+            shiftBits += 8;
+            curBufB++;
+        }
+    }
+
+    /* Calculate and append FCS */
+    AppendCRC32(data, curB + 4, f56Tagged);
+
+    return curB + 4;
+
+}   /* end BuildTxFrame */
+
+
+
+
+/*****************************************************************************/
+/** WaitTxIdle
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Polls PTI_TX_CTRL until the interface has consumed the
+ *                  last word handed to it.
+ *
+ * \param[in]       switchPtr points to the switch state table.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' if the register read failed.
+ *
+ *****************************************************************************/
+static fm_status WaitTxIdle(fm_switch *switchPtr, fm_int sw)
+{
+    fm_status   err;
+    fm_uint32   rv32;
+
+    do
+    {
+        err = switchPtr->ReadUINT32(sw, FM10000_PTI_TX_CTRL(), &rv32);
+        if (err != FM_OK)
+        {
+            return err;
+        }
+    } while (FM_GET_BIT(rv32, FM10000_PTI_TX_CTRL, TxValid) == 1);
+
+    return FM_OK;
+
+}   /* end WaitTxIdle */
+
+
+
+
 /******************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -332,6 +464,7 @@ fm_status fm10000PTIInitialize(fm_int sw)
     portPtr             = switchPtr->portTable[fibmLogicalPort];
     portPtr->portType   = FM_PORT_TYPE_PTI;
     portPtr->linkUp     = TRUE;
+    fmUpdateCardinalPortState(switchPtr, fibmLogicalPort);
 
     FM_LOG_DEBUG(FM_LOG_CAT_SWITCH,
                  "fibmLogicalPort=%d portType=%d\n",
@@ -434,7 +567,10 @@ ABORT:
 /** fm10000PTISendPackets
  * \ingroup intPlatformCommon
  *
- * \desc            Send packets via the PTI interface.
+ * \desc            Send packets via the PTI interface. Up to
+ *                  PTI_TX_BATCH_FRAMES packets are taken from a TX queue
+ *                  at a time, built into a staging buffer allocated once
+ *                  per call, and streamed with ''fm10000PTISendBatch''.
  *
  * \param[in]       sw is the switch on which to operate.
  *
@@ -446,169 +582,129 @@ ABORT:
 fm_status fm10000PTISendPackets(fm_int sw)
 {
     fm_status                   err = FM_OK;
-    fm_switch *                 switchPtr;
-    fm_packetHandlingState *    pktState;
+    fm_status                   sendErr;
     fm_packetQueue *            txQueue;
     fm_packetEntry *            pkt;
-    fm_buffer *                 buffer;
-    fm_byte *                   data = NULL;
-    fm_int                      curWord;
-    fm_int                      curB;
-    fm_int                      lenB;
+    fm_byte *                   staging;
+    fm_byte *                   frames[PTI_TX_BATCH_FRAMES];
+    fm_int                      lengths[PTI_TX_BATCH_FRAMES];
+    fm_txCompletionBatch        completions;
+    fm_int                      numFrames;
+    fm_int                      numSent;
+    fm_int                      used;
     fm_int                      i;
-    fm_int                      pktLength;
-    fm_uint                     mask;
-    fm_int                      shiftBits;
+    fm_uint                     index;
+    fm_uint                     tail;
 
     FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX, "sw=%d\n", sw);
 
-    switchPtr   = GET_SWITCH_PTR(sw);
-    pktState    = GET_PLAT_PKT_STATE(sw);
-    txQueue     = &pktState->txQueue;
+    completions.numCompletions = 0;
 
-    fmPacketQueueLock(txQueue);
+    staging = (fm_byte *) fmAlloc(PTI_TX_BATCH_BYTES);
+    if (staging == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_NO_MEM);
+    }
 
     /**************************************************
-     * Iterate through the packets in the tx queue
+     * Send one batch at a time from the highest
+     * priority queue with published packets
      **************************************************/
 
-    for ( ; 
-         txQueue->pullIndex != txQueue->pushIndex ;
-         txQueue->pullIndex = (txQueue->pullIndex + 1) % FM_PACKET_QUEUE_SIZE)
+    while ( (txQueue = fmPacketQueueGetNextToDrain(sw)) != NULL )
     {
-        pkt = &txQueue->packetQueueList[txQueue->pullIndex];
-
-        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
-                     "Sending packet in slot %d, length=%d, "
-                     "suppressVlanTag=%d, fcsVal=0x%08x\n",
-                     txQueue->pullIndex,
-                     pkt->length,
-                     pkt->suppressVlanTag,
-                     pkt->fcsVal);
-
-        pktLength = pkt->length + 4;    /* +4 = FCS */
-        if (pkt->islTagFormat == FM_ISL_TAG_F56) 
-        {
-            pktLength += 8;
-        }
+        fmPacketQueueDrainLock(txQueue);
 
-        if (pkt->suppressVlanTag)
-        {
-            pktLength -= 4;
-        }
+        numFrames = 0;
+        used      = 0;
+        tail      = fmPacketQueueGetTail(txQueue);
 
-        data = (fm_byte*) fmAlloc(pktLength);
-        if (data == NULL)
+        for (index = txQueue->pullIndex ;
+             (index != tail) && (numFrames < PTI_TX_BATCH_FRAMES) ;
+             index = fmPacketQueueNextIndex(txQueue, index))
         {
-            err = FM_ERR_NO_MEM;
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
-        }
+            pkt = &txQueue->packetQueueList[index];
 
-        lenB    = 0;
-        curWord = 0;
-        curB    = 0;
-        if (pkt->islTagFormat == FM_ISL_TAG_F56)
-        {
-            data[curB++] = (pkt->islTag.f56.tag[0] & 0xFF000000) >> 24;
-            data[curB++] = (pkt->islTag.f56.tag[0] & 0x00FF0000) >> 16;
-            data[curB++] = (pkt->islTag.f56.tag[0] & 0x0000FF00) >> 8;
-            data[curB++] = (pkt->islTag.f56.tag[0] & 0x000000FF);
-
-            data[curB++] = (pkt->islTag.f56.tag[1] & 0xFF000000) >> 24;
-            data[curB++] = (pkt->islTag.f56.tag[1] & 0x00FF0000) >> 16;
-            data[curB++] = (pkt->islTag.f56.tag[1] & 0x0000FF00) >> 8;
-            data[curB++] = (pkt->islTag.f56.tag[1] & 0x000000FF);
+            if ( used + PTI_TX_FRAME_SLOT(pkt->length + PTI_TX_FRAME_OVERHEAD)
+                 > PTI_TX_BATCH_BYTES )
+            {
+                break;
+            }
 
-            lenB += 8;
+            FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
+                         "Sending packet in slot %d, length=%d, "
+                         "suppressVlanTag=%d, fcsVal=0x%08x\n",
+                         index,
+                         pkt->length,
+                         pkt->suppressVlanTag,
+                         pkt->fcsVal);
+
+            frames[numFrames]  = staging + used;
+            lengths[numFrames] = BuildTxFrame(pkt, frames[numFrames]);
+            used              += PTI_TX_FRAME_SLOT(lengths[numFrames]);
+            numFrames++;
         }
 
-        
-        /**************************************************
-         * Iterate through all buffers in this packet
-         **************************************************/
-
-        buffer  = pkt->packet;
-        while (buffer != NULL)
+        if (numFrames == 0)
         {
-            /* Cannot modify the send buffer, since the same buffer can be
-             * used multiple times to send to multiple ports */
-         
-            /* 32-bits at a time */
-            fm_int curBufB = 0;
-            for (i = 0 ; i < (buffer->len / 4) ; i++)
+            if (txQueue->pullIndex != tail)
             {
-                data[curB++] = (buffer->data[i] & 0x000000FF);
-                data[curB++] = (buffer->data[i] & 0x0000FF00) >> 8;
-                data[curB++] = (buffer->data[i] & 0x00FF0000) >> 16;
-                data[curB++] = (buffer->data[i] & 0xFF000000) >> 24;
-                curBufB += 4;
+                /* The head packet can never fit the staging buffer */
+                fmDbgDiagCountIncr(sw, FM_CTR_TX_PKT_DROP, 1);
+                fmPacketQueueRetire(sw,
+                                    txQueue,
+                                    FM_ERR_FRAME_TOO_LARGE,
+                                    &completions);
             }
 
-            /* Remaining Bytes: 1 - 4 */
-            mask = 0xFF;
-            shiftBits = 0;
-            while (curBufB < buffer->len)
-            {
-                data[curB++] = ((buffer->data[i] & mask) >> shiftBits);
-                mask <<= 8;
-                shiftBits += 8;
-                curBufB++;
-            }
-
-            if (pkt->suppressVlanTag)
-            {
-                /* Suppress the vlan tag */
+            /* Otherwise another consumer drained the queue first */
+            fmPacketQueueDrainUnlock(txQueue);
+            continue;
+        }
 
-            }
+        /**************************************************
+         * Send the batch
+         **************************************************/
 
-            lenB += curBufB;
-            buffer = buffer->next;
-        }
+        sendErr = fm10000PTISendBatch(sw, frames, lengths, numFrames, &numSent);
 
-        /* Calculate and append FCS */
-        AppendCRC32(data, pktLength, 
-                    (pkt->islTagFormat == FM_ISL_TAG_F56));
-        lenB += 4;  /* FCS +4B */
+        fmDbgDiagCountIncr(sw, FM_CTR_TX_BATCH_FLUSH, 1);
+        fmDbgDiagCountIncr(sw, FM_CTR_TX_BATCH_PKTS, numSent);
+        fmDbgDiagCountIncr(sw, FM_CTR_TX_PKT_COMPLETE, numSent);
 
+        for (i = 0 ; i < numSent ; i++)
+        {
+            fmPacketQueueRetire(sw, txQueue, FM_OK, &completions);
+        }
 
         /**************************************************
-         * Send the packet
+         * The packet being sent when the interface failed
+         * is dropped; the rest of the batch stays queued
+         * for the next pass.
          **************************************************/
-
-        err = fm10000PTISend(sw, data, lenB);
-        if (err != FM_OK)
+        if (sendErr != FM_OK)
         {
             FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_TX,
                          "Error sending packet: %d (%s)\n",
-                         err, 
-                         fmErrorMsg(err));
-        }
-        
+                         sendErr,
+                         fmErrorMsg(sendErr));
 
-        /**************************************************
-         * Free packet buffer if this is the last packet
-         * using this buffer
-         **************************************************/
+            if (numSent < numFrames)
+            {
+                fmDbgDiagCountIncr(sw, FM_CTR_TX_PKT_DROP, 1);
+                fmPacketQueueRetire(sw, txQueue, sendErr, &completions);
+            }
 
-        if (pkt->freePacketBuffer)
-        {
-            /* Ignore the error since it's better to continue */
-            (void) fmFreeBufferChain(sw, pkt->packet);
-            
-            fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_TX_BUFFER_FREES, 1);
+            err = sendErr;
         }
-      
-        fmFree(data);
-        data = NULL;
-    }
 
-ABORT:
-    fmPacketQueueUnlock(txQueue);
-    if (data != NULL)
-    {
-        fmFree(data);
+        fmPacketQueueDrainUnlock(txQueue);
     }
-    
+
+    fmFree(staging);
+
+    fmPacketFlushTxCompletions(sw, &completions);
+
     FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
 
 }   /* end fm10000PTISendPackets */
@@ -646,6 +742,7 @@ void * fm10000PTIReceivePackets(void *args)
     fm_int          curBufDataIdx;
     fm_int          byInWordNum;
     fm_int          curBufSize;
+    fm_int          bufferSize;
 
     thread  = FM_GET_THREAD_HANDLE(args);
     sw      = *(FM_GET_THREAD_PARAM(fm_int, args));
@@ -747,8 +844,9 @@ void * fm10000PTIReceivePackets(void *args)
         curByte             = 0;
         numBytesLeft        = dataLength;
         recvChainHead       = NULL;
-        numBuffersNeeded    = (dataLength / FM_BUFFER_SIZE_BYTES);
-        if ((dataLength % FM_BUFFER_SIZE_BYTES) > 0)
+        bufferSize          = fmPlatformGetBufferSize();
+        numBuffersNeeded    = (dataLength / bufferSize);
+        if ((dataLength % bufferSize) > 0)
         {
             numBuffersNeeded++;
         }
@@ -775,8 +873,8 @@ void * fm10000PTIReceivePackets(void *args)
             } while (nextBuffer == NULL);
             
             /* Fill data in network byte order */
-            curBufSize      = (numBytesLeft < FM_BUFFER_SIZE_BYTES) ?
-                              numBytesLeft : FM_BUFFER_SIZE_BYTES;
+            curBufSize      = (numBytesLeft < bufferSize) ?
+                              numBytesLeft : bufferSize;
 
             lastBufferByte  = curByte + curBufSize;
             curBufDataIdx   = 0;
@@ -891,111 +989,167 @@ void * fm10000PTIReceivePackets(void *args)
  *
  * \param[in]       sw is the switch on which to operate.
  *
- * \param[in]       data points to an array of bytes to send.
+ * \param[in]       data points to an array of bytes to send, padded to a
+ *                  multiple of 8 bytes.
  *
  * \param[in]       length is the number of bytes to send.
  *
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
-fm_status fm10000PTISend(fm_int         sw, 
-                         fm_byte        *data, 
+fm_status fm10000PTISend(fm_int         sw,
+                         fm_byte        *data,
                          fm_int         length)
+{
+    fm_status           err;
+    fm_int              numSent;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX, "sw=%d length=%d\n", sw, length);
+
+    err = fm10000PTISendBatch(sw, &data, &length, 1, &numSent);
+
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+}   /* end fm10000PTISend */
+
+
+
+
+/*****************************************************************************/
+/** fm10000PTISendBatch
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Send several packets back to back via Packet Test
+ *                  Interface. The interface takes one 64-bit word at a
+ *                  time; rather than polling TxValid right after handing
+ *                  over each word, the poll is deferred until the data
+ *                  registers are about to be reused, so that it overlaps
+ *                  with assembling the next word and, at frame boundaries,
+ *                  with starting the next frame. A single trailing poll
+ *                  covers the end of the batch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       frames points to an array of numFrames pointers to the
+ *                  frame data, each padded to a multiple of 8 bytes.
+ *
+ * \param[in]       lengths points to an array of numFrames frame lengths,
+ *                  in bytes.
+ *
+ * \param[in]       numFrames is the number of frames to send.
+ *
+ * \param[out]      numSent points to caller-allocated storage where this
+ *                  function places the number of frames whose last word
+ *                  was handed to the interface. On error, if it is less
+ *                  than numFrames, it is the index of the frame that
+ *                  failed.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' if a register access failed.
+ *
+ *****************************************************************************/
+fm_status fm10000PTISendBatch(fm_int    sw,
+                              fm_byte **frames,
+                              fm_int *  lengths,
+                              fm_int    numFrames,
+                              fm_int *  numSent)
 {
     fm_status           err = FM_OK;
     fm_switch           *switchPtr;
+    fm_byte             *data;
     fm_int              numWords64b;
+    fm_int              f;
     fm_int              i;
-    fm_int              curBy;
-    fm_uint             rv32 = 0;
-    fm_uint             word32;
-    fm_int              mark = 0;
-    fm_int              info = 0;
-    fm_int              n = 8;
-
-    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX, "sw=%d length=%d\n", sw, length);
+    fm_uint32           words[2];
+    fm_uint32           rv32;
+    fm_int              mark;
+    fm_int              n;
+    fm_bool             busy;
+    fm_bool             dump;
 
     switchPtr = GET_SWITCH_PTR(sw);
+    busy      = FALSE;
+    dump      = fmLogIsEnabled(FM_LOG_CAT_EVENT_PKT_TX, FM_LOG_LEVEL_DEBUG);
+    *numSent  = 0;
 
-    DumpPacket(FM_LOG_CAT_EVENT_PKT_TX, data, length);
-
-    numWords64b = ((length % 8) == 0) ? (length / 8) : (length / 8) + 1;
-
-    curBy = 0;
-    for (i = 0 ; i < numWords64b ; i++)
+    for (f = 0 ; f < numFrames ; f++)
     {
-        /**************************************************
-         * First 32-bits of data
-         **************************************************/
-        
-        word32 = data[curBy] |
-                 ((data[curBy + 1]) << 8) |
-                 ((data[curBy + 2]) << 16) |
-                 ((data[curBy + 3]) << 24);
+        data = frames[f];
 
-        curBy += 4;
-       
-        FM_SET_FIELD(rv32, FM10000_PTI_TX_DATA0, Data, word32);
-        err = switchPtr->WriteUINT32(sw, FM10000_PTI_TX_DATA0(), rv32);
-        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+        if (dump)
+        {
+            DumpPacket(FM_LOG_CAT_EVENT_PKT_TX, data, lengths[f]);
+        }
 
+        numWords64b = (lengths[f] + 7) / 8;
+        mark        = 0;
+        n           = 8;
 
-        /**************************************************
-         * Second 32-bits of data
-         **************************************************/
+        for (i = 0 ; i < numWords64b ; i++, data += 8)
+        {
+            words[0] = data[0] |
+                       (data[1] << 8) |
+                       (data[2] << 16) |
+                       (data[3] << 24);
+            words[1] = data[4] |
+                       (data[5] << 8) |
+                       (data[6] << 16) |
+                       (data[7] << 24);
 
-        word32 = data[curBy] |
-                 ((data[curBy + 1]) << 8) |
-                 ((data[curBy + 2]) << 16) |
-                 ((data[curBy + 3]) << 24);
+            /**************************************************
+             * Last word to write
+             **************************************************/
 
-        curBy += 4;
+            if (i >= (numWords64b - 1))
+            {
+                n    = ((lengths[f] & 0x7) != 0) ? (lengths[f] & 0x7) : 8;
+                mark = MARK_EOF;
+            }
 
-        FM_SET_FIELD(rv32, FM10000_PTI_TX_DATA1, Data, word32);
-        err = switchPtr->WriteUINT32(sw, FM10000_PTI_TX_DATA1(), rv32);
-        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
-       
+            /**************************************************
+             * Wait for the previous word to be consumed before
+             * overwriting the data registers
+             **************************************************/
 
-        /**************************************************
-         * Last word to write
-         **************************************************/
-        
-        if (i >= (numWords64b - 1))
-        {
-            n       = ((length & 0x7) != 0) ? (length & 0x7) : 8;
-            mark    = 3;
-        }
+            if (busy)
+            {
+                err = WaitTxIdle(switchPtr, sw);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+            }
 
+            err = switchPtr->WriteUINT32Mult(sw, FM10000_PTI_TX_DATA0(), 2, words);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
-        /**************************************************
-         * Start transmission of this 64-bits of data
-         **************************************************/
-        
-        rv32 = 0;
-        /* Could use Info field to generate error packets */
-        FM_SET_FIELD(rv32, FM10000_PTI_TX_CTRL, Info, info);
-        FM_SET_FIELD(rv32, FM10000_PTI_TX_CTRL, Mark, mark); 
-        FM_SET_FIELD(rv32, FM10000_PTI_TX_CTRL, Len, n); 
-        FM_SET_BIT(rv32, FM10000_PTI_TX_CTRL, TxValid, 1); 
-        err = switchPtr->WriteUINT32(sw, FM10000_PTI_TX_CTRL(), rv32);
-        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
-      
-        /**************************************************
-         * Poll for TxValid == 0
-         **************************************************/
+            /**************************************************
+             * Start transmission of this 64-bits of data
+             **************************************************/
 
-        do
-        {
-            err = switchPtr->ReadUINT32(sw, FM10000_PTI_TX_CTRL(), &rv32);
+            rv32 = 0;
+            /* Could use Info field to generate error packets */
+            FM_SET_FIELD(rv32, FM10000_PTI_TX_CTRL, Info, INFO_ERR_NONE);
+            FM_SET_FIELD(rv32, FM10000_PTI_TX_CTRL, Mark, mark);
+            FM_SET_FIELD(rv32, FM10000_PTI_TX_CTRL, Len, n);
+            FM_SET_BIT(rv32, FM10000_PTI_TX_CTRL, TxValid, 1);
+            err = switchPtr->WriteUINT32(sw, FM10000_PTI_TX_CTRL(), rv32);
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
-        } while (FM_GET_BIT(rv32, FM10000_PTI_TX_CTRL, TxValid) == 1);
-    }   /* end for (i = 0 ; i < numWords64b ; i++) */
+
+            busy = TRUE;
+        }
+
+        *numSent = f + 1;
+    }
+
+    if (busy)
+    {
+        err = WaitTxIdle(switchPtr, sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+    }
 
 ABORT:
 
-    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+    return err;
 
-}   /* end fm10000PTISend */
+}   /* end fm10000PTISendBatch */
 
 
 
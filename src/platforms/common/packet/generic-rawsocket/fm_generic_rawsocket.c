@@ -38,6 +38,7 @@
 
 #include <sys/socket.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <netpacket/packet.h>
 #include <linux/if_ether.h>
 #include <arpa/inet.h>
@@ -66,6 +67,12 @@ typedef __u8 u8;
 #define FM_MAC_HDR_BYTE_LEN         12
 #define FM_RECV_BUFFER_THRESHOLD    4
 
+/* Upper bound on the number of packets sent per sendmmsg() call */
+#define FM_RAW_SOCKET_MAX_TX_BATCH  64
+
+/* Upper bound on the number of frames received per recvmmsg() call */
+#define FM_RAW_SOCKET_MAX_RX_BATCH  32
+
 /* New linux socket protocol for IES (Intel Ethernet Switch) Frames
  *
  * With this protocol, the ethernet frame (DMAC, SMAC, ETYPE, etc) is
@@ -85,6 +92,26 @@ typedef __u8 u8;
 
 #define ETHTOOL_PRV_FLAG_IES        (1 << 0)
 
+/* One pre-posted receive message. */
+typedef struct _fm_rawSocketRxSlot
+{
+    /* Buffer chain the frame is received into, NULL if not posted */
+    fm_buffer *chain;
+
+    /* Timetag preceding the frame */
+    fm_byte    rawTS[8];
+
+#ifdef ENABLE_TIMESTAMP
+    /* Ancillary data carrying the ingress timestamp */
+    union {
+        struct cmsghdr  cm;
+        char            control[512];
+
+    } control;
+#endif
+
+} fm_rawSocketRxSlot;
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -97,12 +124,304 @@ typedef __u8 u8;
  * Local function prototypes.
  *****************************************************************************/
 
+static fm_buffer *AllocateRxChain(fm_int numBuffers, fm_bool wait);
+static void ReleaseRxChain(fm_buffer **chain);
+static fm_int BuildRxIovecs(fm_rawSocketRxSlot *slot, struct iovec *iov);
+static void DeliverRxFrame(fm_int              sw,
+                           fm_rawSocketRxSlot *slot,
+                           struct mmsghdr *    msg);
 
 /*****************************************************************************
  * Local Functions
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/** AllocateRxChain
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Allocates a receive buffer chain.
+ *
+ * \param[in]       numBuffers is the number of buffers in the chain.
+ *
+ * \param[in]       wait is TRUE to wait for buffers to be returned to the
+ *                  pool, FALSE to give up as soon as the pool is empty.
+ *
+ * \return          Pointer to the head of the chain, NULL if no chain could
+ *                  be allocated.
+ *
+ *****************************************************************************/
+static fm_buffer *AllocateRxChain(fm_int numBuffers, fm_bool wait)
+{
+    fm_buffer *chainHead = NULL;
+    fm_buffer *nextBuffer;
+    fm_status  status;
+    fm_int     i;
+
+    for (i = 0 ; i < numBuffers ; i++)
+    {
+        do
+        {
+            nextBuffer = fmAllocateBuffer(FM_FIRST_FOCALPOINT);
+
+            if (nextBuffer == NULL)
+            {
+                fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_RX_OUT_OF_BUFFERS, 1);
+
+                if (!wait)
+                {
+                    ReleaseRxChain(&chainHead);
+                    return NULL;
+                }
+
+                /* Wait a little while for buffer to return */
+                fmYield();
+            }
+        }
+        while (nextBuffer == NULL);
+
+        if (chainHead == NULL)
+        {
+            chainHead        = nextBuffer;
+            nextBuffer->next = NULL;
+        }
+        else
+        {
+            status = fmAddBuffer(chainHead, nextBuffer);
+
+            if (status != FM_OK)
+            {
+                FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
+                             "Unable to add buffer %d (%p) to chain %p\n",
+                             i,
+                             (void *) nextBuffer,
+                             (void *) chainHead );
+                fmFreeBuffer(FM_FIRST_FOCALPOINT, nextBuffer);
+                break;
+            }
+        }
+    }
+
+    return chainHead;
+
+}   /* end AllocateRxChain */
+
+
+
+
+/*****************************************************************************/
+/** ReleaseRxChain
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Returns a receive buffer chain to the buffer pool.
+ *
+ * \param[in,out]   chain points to the chain head, which is set to NULL.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReleaseRxChain(fm_buffer **chain)
+{
+    fm_status status;
+
+    if (*chain == NULL)
+    {
+        return;
+    }
+
+    status = fmFreeBufferChain(FM_FIRST_FOCALPOINT, *chain);
+
+    if (status != FM_OK)
+    {
+        FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
+                     "Unable to release receive buffer chain, "
+                     "status = %d (%s)\n",
+                     status,
+                     fmErrorMsg(status) );
+    }
+
+    *chain = NULL;
+
+}   /* end ReleaseRxChain */
+
+
+
+
+/*****************************************************************************/
+/** BuildRxIovecs
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Builds the iovec layout for one receive slot: timetag
+ *                  followed by every buffer of the pre-posted chain.
+ *
+ * \param[in]       slot points to the receive slot.
+ *
+ * \param[out]      iov points to caller-provided iovec storage.
+ *
+ * \return          Number of iovec entries used.
+ *
+ *****************************************************************************/
+static fm_int BuildRxIovecs(fm_rawSocketRxSlot *slot, struct iovec *iov)
+{
+    fm_buffer *buf;
+    fm_int     iovlen = 0;
+
+    /* 8-Byte Timestamp IOV */
+    iov[iovlen].iov_base = slot->rawTS;
+    iov[iovlen].iov_len  = sizeof(slot->rawTS);
+    iovlen++;
+
+    for ( buf = slot->chain ; buf ; buf = buf->next )
+    {
+        iov[iovlen].iov_base = buf->data;
+        iov[iovlen].iov_len  = fmPlatformGetBufferSize();
+        iovlen++;
+    }
+
+    return iovlen;
+
+}   /* end BuildRxIovecs */
+
+
+
+
+/*****************************************************************************/
+/** DeliverRxFrame
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Trims the buffer chain of a received frame to its
+ *                  length and hands it to the API. The slot no longer
+ *                  owns the chain on return.
+ *
+ * \param[in]       sw is the switch the frame was received on.
+ *
+ * \param[in,out]   slot points to the receive slot.
+ *
+ * \param[in]       msg points to the completed receive message.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void DeliverRxFrame(fm_int              sw,
+                           fm_rawSocketRxSlot *slot,
+                           struct mmsghdr *    msg)
+{
+    fm_buffer *        nextBuffer;
+    fm_buffer *        recvChainHead;
+    fm_int             len;
+    fm_status          status;
+    fm_pktSideBandData sbData;
+    fm_byte *          rawTS;
+#ifdef ENABLE_TIMESTAMP
+    struct cmsghdr *   cmsg;
+#endif
+
+    FM_CLEAR(sbData);
+
+    recvChainHead = slot->chain;
+    slot->chain   = NULL;
+    rawTS         = slot->rawTS;
+    len           = msg->msg_len;
+
+#ifdef ENABLE_TIMESTAMP
+    for (cmsg = CMSG_FIRSTHDR(&msg->msg_hdr);
+         cmsg;
+         cmsg = CMSG_NXTHDR(&msg->msg_hdr, cmsg)) 
+    {
+        if ( (cmsg->cmsg_level == SOL_SOCKET) &&
+             (cmsg->cmsg_type  == SO_TIMESTAMPING) &&
+             (cmsg->cmsg_len   == CMSG_LEN(sizeof(struct timespec) * 3)) )
+        {
+                struct timespec *stamp =
+                    (struct timespec *)CMSG_DATA(cmsg);
+                /* cmsg has 3 different timestamps. Timestamp we are interested is 
+                 * located in index 2 */
+                sbData.ingressTimestamp.seconds     = ( (fm_int64)(stamp[2].tv_sec) );
+                sbData.ingressTimestamp.nanoseconds = ( (fm_int64)(stamp[2].tv_nsec) );
+        }
+        else
+        {
+                FM_LOG_WARNING(FM_LOG_CAT_PLATFORM, 
+                              "Unknown control message of level %d type %d len %zu  received\n",
+                              cmsg->cmsg_level, 
+                              cmsg->cmsg_type,
+                              cmsg->cmsg_len);
+        }
+    }
+#endif
+
+    /* Remove the timestamp's length to get the length of the actual
+     * packet */
+    len -= sizeof(slot->rawTS);
+
+    /* The raw socket does not carry the FCS in either tx or rx, however
+     * the API expects it to be present. Because the API clears the 
+     * FCS value before sending the packet event to the application, don't 
+     * bother about setting the correct FCS value and just increment the 
+     * length. The FCS value is undefined (whatever is in the fm_buffer at 
+     * the FCS position). */
+    len += 4;
+
+    /* fill in the used buffer sizes */
+    nextBuffer = recvChainHead;
+
+    while (nextBuffer != NULL)
+    {
+        if (len > fmPlatformGetBufferSize())
+        {
+            nextBuffer->len = fmPlatformGetBufferSize();
+        }
+        else
+        {
+            nextBuffer->len = len;
+        }
+
+        len -= nextBuffer->len;
+
+        if ( (len <= 0) && (nextBuffer->next != NULL) )
+        {
+            ReleaseRxChain(&nextBuffer->next);
+        }
+
+        nextBuffer = nextBuffer->next;
+    }
+
+    if (recvChainHead == NULL)
+    {
+        return;
+    }
+
+    /* Store the raw timestamp in 64b format */
+    sbData.rawTimeStamp  = ((fm_uint64) (rawTS[0] & 0xFF)) << 56;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[1] & 0xFF)) << 48;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[2] & 0xFF)) << 40;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[3] & 0xFF)) << 32;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[4] & 0xFF)) << 24;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[5] & 0xFF)) << 16;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[6] & 0xFF)) << 8;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[7] & 0xFF));
+
+    /* Don't provide an ISL tag pointer, let the API handle the ISL
+     * tag information (included in the fm_buffer chain). */
+    status = fmPlatformReceiveProcessV2(sw,
+                                        recvChainHead,
+                                        NULL,
+                                        &sbData);
+
+    if (status != FM_OK)
+    {
+        FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
+                     "Returned error status %d "
+                     "(%s)\n",
+                     status,
+                     fmErrorMsg(status) );
+    }
+
+}   /* end DeliverRxFrame */
+
+
+
+
 /*****************************************************************************/
 /** fmRawPacketSocketDestroy
  * \ingroup intPlatformCommon
@@ -148,10 +467,13 @@ ABORT:
 
 
 /*****************************************************************************/
-/** fmRawPacketSocketHandlingInitialize
+/** fmRawPacketSocketOpen
  * \ingroup intPlatformCommon
  *
- * \desc            Initializes the raw packet socket transfer module.
+ * \desc            Opens and binds the raw packet socket to the given
+ *                  netdev, puts the driver in IES tagging mode and brings
+ *                  the interface up. No receive thread is started, this is
+ *                  left to the packet backend using the socket.
  *
  * \param[in]       sw is the switch number to initialize.
  * 
@@ -163,9 +485,9 @@ ABORT:
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
-fm_status fmRawPacketSocketHandlingInitialize(fm_int  sw, 
-                                              fm_bool hasFcs, 
-                                              fm_text iface)
+fm_status fmRawPacketSocketOpen(fm_int  sw, 
+                                fm_bool hasFcs, 
+                                fm_text iface)
 {
     fm_status                err = FM_OK;
     fm_int                   rawSock = -1;
@@ -183,7 +505,6 @@ fm_status fmRawPacketSocketHandlingInitialize(fm_int  sw,
 #endif
     char                     strErrBuf[FM_STRERROR_BUF_SIZE];
     errno_t                  strErrNum;
-    fm_switch               *switchPtr;
 
     FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                  "sw=%d hasFcs=%s\n",
@@ -388,6 +709,55 @@ fm_status fmRawPacketSocketHandlingInitialize(fm_int  sw,
 
     GET_PLAT_STATE(sw)->rawSocket = rawSock;
     FM_STRNCPY_S(GET_PLAT_STATE(sw)->ifaceName, IF_NAMESIZE, iface, IF_NAMESIZE);
+    GET_PLAT_STATE(sw)->rawSocketTxBatchSize =
+        GET_PROPERTY()->rawSocketTxBatchSize;
+    GET_PLAT_STATE(sw)->rawSocketRxBatchSize =
+        GET_PROPERTY()->rawSocketRxBatchSize;
+
+ABORT:
+    if ( (err != FM_OK) &&
+         (rawSock != -1) )
+    {
+        close(rawSock);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
+
+}   /* end fmRawPacketSocketOpen */
+
+
+
+
+/*****************************************************************************/
+/** fmRawPacketSocketHandlingInitialize
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Initializes the raw packet socket transfer module.
+ *
+ * \param[in]       sw is the switch number to initialize.
+ * 
+ * \param[in]       hasFcs is TRUE if the packet includes the FCS field.
+ * 
+ * \param[in]       iface is a string containing the netdev's interface name
+ *                  through which the packets should be sent / received.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmRawPacketSocketHandlingInitialize(fm_int  sw, 
+                                              fm_bool hasFcs, 
+                                              fm_text iface)
+{
+    fm_status  err;
+    fm_switch *switchPtr;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
+                 "sw=%d hasFcs=%s\n",
+                 sw,
+                 FM_BOOLSTRING(hasFcs));
+
+    err = fmRawPacketSocketOpen(sw, hasFcs, iface);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
 
     /* Create the receive packet thread */
     err = fmCreateThread("raw_packet_socket receive",
@@ -403,12 +773,6 @@ fm_status fmRawPacketSocketHandlingInitialize(fm_int  sw,
     }
 
 ABORT:
-    if ( (err != FM_OK) &&
-         (rawSock != -1) )
-    {
-        close(rawSock);
-    }
-
     FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
 
 }   /* end fmRawPacketSocketHandlingInitialize */
@@ -422,6 +786,10 @@ ABORT:
  *
  * \desc            When called, iterates through the packet queue and
  *                  continues to send packets until either the queue empties.
+ *                  Packets are handed to the kernel in batches of up to
+ *                  ''api.platform.rawSocket.txBatchSize'' messages per
+ *                  sendmmsg() call. A batch size of 1 sends each packet
+ *                  with its own sendmsg() call.
  *
  * \param[in]       sw refers to the switch number to send packets to.
  *
@@ -436,12 +804,18 @@ fm_status fmRawPacketSocketSendPackets(fm_int sw)
     fm_packetQueue *        txQueue;
     fm_packetEntry *        packet;
     fm_int32                rc;
-    fm_buffer               *sendBuf;
-    struct msghdr           msg;
+    struct mmsghdr          msgs[FM_RAW_SOCKET_MAX_TX_BATCH];
+    fm_rawSocketTxTags      tags[FM_RAW_SOCKET_MAX_TX_BATCH];
     struct iovec            iov[UIO_MAXIOV];
-    fm_islTag               islTag;
-    fm_uint32               fcs;
-    fm_uint64               rawTS;
+    fm_txCompletionBatch    completions;
+    fm_status               retireStatus;
+    fm_int                  batchSize;
+    fm_int                  numMsgs;
+    fm_int                  iovUsed;
+    fm_int                  iovNeeded;
+    fm_int                  i;
+    fm_uint                 index;
+    fm_uint                 tail;
     char                    strErrBuf[FM_STRERROR_BUF_SIZE];
     errno_t                 strErrNum;
     struct ifreq            ifr;
@@ -458,143 +832,160 @@ fm_status fmRawPacketSocketSendPackets(fm_int sw)
         FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_UNINITIALIZED);
     }
 
-    /* initialize the message header */
-    FM_CLEAR(msg);
-    msg.msg_name = NULL; /* Optional field */
-    msg.msg_namelen = 0;
-    msg.msg_iov = iov;
-    msg.msg_iovlen = 0;
-    msg.msg_flags = 0;
+    batchSize = GET_PLAT_STATE(sw)->rawSocketTxBatchSize;
+    if (batchSize < 1)
+    {
+        batchSize = 1;
+    }
+    else if (batchSize > FM_RAW_SOCKET_MAX_TX_BATCH)
+    {
+        batchSize = FM_RAW_SOCKET_MAX_TX_BATCH;
+    }
 
     FM_STRNCPY_S(ifr.ifr_name, IF_NAMESIZE, GET_PLAT_STATE(sw)->ifaceName, IF_NAMESIZE);
 
-    txQueue = &pktState->txQueue;
-    fmPacketQueueLock(txQueue);
+    txQueue                    = NULL;
+    completions.numCompletions = 0;
 
-    if (ioctl(GET_PLAT_STATE(sw)->rawSocket, SIOCGIFFLAGS, &ifr) == -1)
+    /**************************************************
+     * In batched mode the netdev state is only polled
+     * after a previous transmit attempt failed. While
+     * the transmitter is healthy a downed device shows
+     * up as a sendmmsg() error instead, which saves one
+     * ioctl() per call on the fast path.
+     **************************************************/
+    if ( (batchSize == 1) || switchPtr->transmitterLock )
     {
-        strErrNum = FM_STRERROR_S(strErrBuf, FM_STRERROR_BUF_SIZE, errno);
-        if (strErrNum == 0)
+        if (ioctl(GET_PLAT_STATE(sw)->rawSocket, SIOCGIFFLAGS, &ifr) == -1)
         {
-            FM_LOG_FATAL(FM_LOG_CAT_EVENT_PKT_TX, 
-                         "Failed to get socket %d flags for device %s: %s\n",
-                         GET_PLAT_STATE(sw)->rawSocket,
-                         ifr.ifr_name,
-                         strErrBuf);
-        }
-        else
-        {
-            FM_LOG_FATAL(FM_LOG_CAT_EVENT_PKT_TX, 
-                         "Failed to get socket %d flags for device %s: %d\n",
-                         GET_PLAT_STATE(sw)->rawSocket,
-                         ifr.ifr_name,
-                         errno);
+            strErrNum = FM_STRERROR_S(strErrBuf, FM_STRERROR_BUF_SIZE, errno);
+            if (strErrNum == 0)
+            {
+                FM_LOG_FATAL(FM_LOG_CAT_EVENT_PKT_TX, 
+                             "Failed to get socket %d flags for device %s: %s\n",
+                             GET_PLAT_STATE(sw)->rawSocket,
+                             ifr.ifr_name,
+                             strErrBuf);
+            }
+            else
+            {
+                FM_LOG_FATAL(FM_LOG_CAT_EVENT_PKT_TX, 
+                             "Failed to get socket %d flags for device %s: %d\n",
+                             GET_PLAT_STATE(sw)->rawSocket,
+                             ifr.ifr_name,
+                             errno);
+            }
+            switchPtr->transmitterLock = TRUE;
+            err = FM_FAIL;
+            FM_LOG_ABORT(FM_LOG_CAT_EVENT_PKT_TX, err);
         }
-        switchPtr->transmitterLock = TRUE;
-        err = FM_FAIL;
-        FM_LOG_ABORT(FM_LOG_CAT_EVENT_PKT_TX, err);
-    }
 
-    if ((ifr.ifr_flags & IFF_RUNNING) == 0)
-    {    
-        FM_LOG_WARNING(FM_LOG_CAT_EVENT_PKT_TX,
-                       "Network device %s resources are not allocated.\n",
-                       ifr.ifr_name);
-        switchPtr->transmitterLock = TRUE;
-        err = FM_FAIL;
-        FM_LOG_ABORT(FM_LOG_CAT_EVENT_PKT_TX, err);
+        if ((ifr.ifr_flags & IFF_RUNNING) == 0)
+        {    
+            FM_LOG_WARNING(FM_LOG_CAT_EVENT_PKT_TX,
+                           "Network device %s resources are not allocated.\n",
+                           ifr.ifr_name);
+            switchPtr->transmitterLock = TRUE;
+            err = FM_FAIL;
+            FM_LOG_ABORT(FM_LOG_CAT_EVENT_PKT_TX, err);
+        }
     }
 
-    /* Iterate through the packets in the tx queue */
-    for ( ;
-          txQueue->pullIndex != txQueue->pushIndex ;
-          txQueue->pullIndex = (txQueue->pullIndex + 1) % FM_PACKET_QUEUE_SIZE)
+    /**************************************************
+     * Send one batch at a time from the highest
+     * priority queue with published packets, so that
+     * a lower priority queue is only serviced while
+     * the higher priority ones are empty.
+     **************************************************/
+    while ( (txQueue = fmPacketQueueGetNextToDrain(sw)) != NULL )
     {
-        packet = &txQueue->packetQueueList[txQueue->pullIndex];
-
-        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
-                     "sending packet in slot %d, length=%d tag=%d fcs=%08x\n",
-                     txQueue->pullIndex, packet->length,
-                     packet->suppressVlanTag, packet->fcsVal);
-        msg.msg_iovlen = 0;
-
-        /* Add the 8 byte timetag iovec. Note that the value is ignored
-         * by the driver as it gets overwritten by the PEP. */
-        rawTS = 0;
-        iov[msg.msg_iovlen].iov_base = &rawTS;
-        iov[msg.msg_iovlen].iov_len = sizeof(rawTS);
-        msg.msg_iovlen++;
-
-        if (packet->islTagFormat == FM_ISL_TAG_F56)
+        fmPacketQueueDrainLock(txQueue);
+
+        /**************************************************
+         * Gather up to batchSize packets, without moving
+         * the pull index, until the iovec pool runs out.
+         **************************************************/
+        numMsgs = 0;
+        iovUsed = 0;
+        tail    = fmPacketQueueGetTail(txQueue);
+
+        for (index = txQueue->pullIndex ;
+             (index != tail) && (numMsgs < batchSize) ;
+             index = fmPacketQueueNextIndex(txQueue, index))
         {
-            /* Add the FTAG (F56) iovec */
-            islTag.f56.tag[0] = htonl(packet->islTag.f56.tag[0]);
-            islTag.f56.tag[1] = htonl(packet->islTag.f56.tag[1]);
-            iov[msg.msg_iovlen].iov_base = &islTag.f56.tag[0];
-            iov[msg.msg_iovlen].iov_len = FM_F56_BYTE_LEN;
-            msg.msg_iovlen++;
+            packet = &txQueue->packetQueueList[index];
+
+            iovNeeded = fmRawPacketSocketCountTxIovecs(packet);
+            if (iovUsed + iovNeeded > UIO_MAXIOV)
+            {
+                break;
+            }
+
+            FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
+                         "sending packet in slot %d, length=%d tag=%d fcs=%08x\n",
+                         index, packet->length,
+                         packet->suppressVlanTag, packet->fcsVal);
+
+            FM_CLEAR(msgs[numMsgs]);
+            msgs[numMsgs].msg_hdr.msg_iov    = &iov[iovUsed];
+            msgs[numMsgs].msg_hdr.msg_iovlen =
+                fmRawPacketSocketBuildTxIovecs(pktState,
+                                               packet,
+                                               &tags[numMsgs],
+                                               &iov[iovUsed]);
+            iovUsed += msgs[numMsgs].msg_hdr.msg_iovlen;
+            numMsgs++;
         }
-        
-        /* iterate through all buffers */
-        for ( sendBuf = packet->packet ; sendBuf ; sendBuf = sendBuf->next )
+
+        if (numMsgs == 0)
         {
-            /* if first buffer ... */
-            if (sendBuf == packet->packet)
+            if (txQueue->pullIndex != tail)
             {
-                /* Cannot modify the send buffer, since the same buffer can be
-                 * used multiple times to send to multiple ports */
+                /* The head packet needs more than UIO_MAXIOV iovecs
+                 * and can never be sent, drop it */
+                fmDbgDiagCountIncr(sw, FM_CTR_TX_PKT_DROP, 1);
+                fmPacketQueueRetire(sw, txQueue, FM_FAIL, &completions);
+            }
 
-                /* second iovec is the mac header */
-                iov[msg.msg_iovlen].iov_base = sendBuf->data;
-                iov[msg.msg_iovlen].iov_len = FM_MAC_HDR_BYTE_LEN;
-                msg.msg_iovlen++;
+            /* Otherwise another consumer drained the queue first */
+            fmPacketQueueDrainUnlock(txQueue);
+            continue;
+        }
 
-                if (packet->islTagFormat == FM_ISL_TAG_F64)
-                {
-                    /* Insert the F64 ISL tag */
-                    islTag.f64.tag[0] = htonl(packet->islTag.f64.tag[0]);
-                    islTag.f64.tag[1] = htonl(packet->islTag.f64.tag[1]);
-                    iov[msg.msg_iovlen].iov_base = &islTag.f64.tag[0];
-                    iov[msg.msg_iovlen].iov_len = FM_F64_BYTE_LEN;
-                    msg.msg_iovlen++;
-                }
+        /* now send it to the driver */
+        retireStatus = FM_OK;
+        errno        = 0;
+        if (batchSize == 1)
+        {
+            rc = sendmsg(GET_PLAT_STATE(sw)->rawSocket,
+                         &msgs[0].msg_hdr,
+                         MSG_DONTWAIT);
+            if (rc != -1)
+            {
+                FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX, "%d bytes were sent\n", rc);
+                rc = 1;
+            }
+        }
+        else
+        {
+            rc = sendmmsg(GET_PLAT_STATE(sw)->rawSocket,
+                          msgs,
+                          numMsgs,
+                          MSG_DONTWAIT);
+            if (rc != -1)
+            {
+                fmDbgDiagCountIncr(sw, FM_CTR_TX_BATCH_FLUSH, 1);
+                fmDbgDiagCountIncr(sw, FM_CTR_TX_BATCH_PKTS, rc);
 
-                /* Third is the data in the first chain */
-                if (packet->suppressVlanTag)
-                {
-                    iov[msg.msg_iovlen].iov_base = &sendBuf->data[4];
-                    iov[msg.msg_iovlen].iov_len = sendBuf->len-16;
-                    msg.msg_iovlen++;
-                }
-                else
+                if (rc < numMsgs)
                 {
-                    iov[msg.msg_iovlen].iov_base = &sendBuf->data[3];
-                    iov[msg.msg_iovlen].iov_len = sendBuf->len-12;
-                    msg.msg_iovlen++;
+                    /* The remainder stays queued; the error, if any,
+                     * is reported by the next sendmmsg() call. */
+                    fmDbgDiagCountIncr(sw, FM_CTR_TX_BATCH_PARTIAL, 1);
                 }
             }
-            else
-            {
-                /* The rest of the chain */
-                iov[msg.msg_iovlen].iov_base = sendBuf->data;
-                iov[msg.msg_iovlen].iov_len = sendBuf->len;
-                msg.msg_iovlen++;
-            }
-
-        }   /* end for (...) */
-
-        /* Append user-supplied FCS value to packet. */
-        if (pktState->sendUserFcs)
-        {
-            fcs = htonl(packet->fcsVal);
-            iov[msg.msg_iovlen].iov_base = &fcs;
-            iov[msg.msg_iovlen].iov_len = sizeof(fcs);
-            msg.msg_iovlen++;
         }
 
-        /* now send it to the driver */
-        errno = 0;
-        rc = sendmsg(GET_PLAT_STATE(sw)->rawSocket, &msg, MSG_DONTWAIT);
         if (rc == -1)
         {
             switchPtr->transmitterLock = TRUE;
@@ -624,7 +1015,10 @@ fm_status fmRawPacketSocketSendPackets(fm_int sw)
             }
             if (errno == EMSGSIZE)
             {
+                /* The head packet can never be sent, drop it */
                 switchPtr->transmitterLock = FALSE;
+                retireStatus               = FM_ERR_FRAME_SIZE_EXCEEDS_MTU;
+                rc                         = 1;
             }
             else
             {
@@ -633,30 +1027,31 @@ fm_status fmRawPacketSocketSendPackets(fm_int sw)
         }
         else
         {
-            FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX, "%d bytes were sent\n", rc);
-
             switchPtr->transmitterLock = FALSE;
-            fmDbgDiagCountIncr(sw, FM_CTR_TX_PKT_COMPLETE, 1);
+            fmDbgDiagCountIncr(sw, FM_CTR_TX_PKT_COMPLETE, rc);
         }
 
         /**************************************************
-         * free buffer only when
-         * (1) sending to a single port;
-         * or (2) this is the last packet of multiple 
-         * identical packets
+         * Retire the first rc packets. Each entry drops its
+         * reference on the packet buffer, which is freed
+         * once every entry sharing it has been sent.
          **************************************************/
-
-        if (packet->freePacketBuffer)
+        for (i = 0 ; i < rc ; i++)
         {
-            /* ignore the error code since it's better to continue */
-            (void) fmFreeBufferChain(sw, packet->packet);
-
-            fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_TX_BUFFER_FREES, 1);
+            fmPacketQueueRetire(sw, txQueue, retireStatus, &completions);
         }
+
+        fmPacketQueueDrainUnlock(txQueue);
     }
 
 ABORT:
-    fmPacketQueueUnlock(txQueue);
+    if (txQueue != NULL)
+    {
+        fmPacketQueueDrainUnlock(txQueue);
+    }
+
+    /* Report this pass's completions once no queue is held */
+    fmPacketFlushTxCompletions(sw, &completions);
 
     FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
 
@@ -670,6 +1065,11 @@ ABORT:
  * \ingroup intPlatformCommon
  *
  * \desc            Handles reception of packets by raw packet socket.
+ *                  Up to ''api.platform.rawSocket.rxBatchSize'' buffer
+ *                  chains are pre-posted and drained with a single
+ *                  recvmmsg() call per wakeup. Chains left unused at the
+ *                  end of the burst are returned to the buffer pool,
+ *                  except for one that is kept for the next wakeup.
  *
  * \param[in]       args is a pointer to the switch number.
  *
@@ -680,32 +1080,25 @@ void * fmRawPacketSocketReceivePackets(void *args)
 {
     fm_thread *        thread;
     fm_int             sw;
-    fm_buffer *        recvChainHead = NULL;
-    fm_buffer *        nextBuffer;
     struct pollfd      rfds;
-    struct msghdr      msg;
+    struct mmsghdr     msgs[FM_RAW_SOCKET_MAX_RX_BATCH];
+    fm_rawSocketRxSlot slots[FM_RAW_SOCKET_MAX_RX_BATCH];
     struct iovec       iov[UIO_MAXIOV];
     struct ifreq       ifr;
     fm_int             retval;
     fm_int             availableBuffers;
     fm_int             len;
-    fm_int             iov_offset;
     fm_int             iov_count = 0;
+    fm_int             iovUsed;
     fm_int             maxMtu = 0;
     fm_int             newMtu;
-    fm_status          status;
+    fm_int             batchSize;
+    fm_int             maxSlots = 1;
+    fm_int             numSlots;
+    fm_int             numPosted;
+    fm_int             i;
     char               strErrBuf[FM_STRERROR_BUF_SIZE];
     errno_t            strErrNum;
-    fm_byte            rawTS[8];
-    fm_pktSideBandData sbData;
-#ifdef ENABLE_TIMESTAMP
-    struct cmsghdr *   cmsg;
-    union {
-        struct cmsghdr  cm;
-        char            control[512];
-
-    } control;
-#endif
     
 
     thread = FM_GET_THREAD_HANDLE(args);
@@ -718,17 +1111,21 @@ void * fmRawPacketSocketReceivePackets(void *args)
                  thread->name,
                  sw);
 
-    /* initialize the message header */
-    FM_CLEAR(msg);
-    msg.msg_name = NULL; /* Optional field */
-    msg.msg_namelen = 0;
-    msg.msg_iov = iov;
-    msg.msg_iovlen = 0;
-    msg.msg_flags = 0;
-#ifdef ENABLE_TIMESTAMP
-    msg.msg_control = &control;
-    msg.msg_controllen = sizeof(control);
-#endif
+    FM_CLEAR(msgs);
+    for (i = 0 ; i < FM_RAW_SOCKET_MAX_RX_BATCH ; i++)
+    {
+        slots[i].chain = NULL;
+    }
+
+    batchSize = GET_PLAT_STATE(sw)->rawSocketRxBatchSize;
+    if (batchSize < 1)
+    {
+        batchSize = 1;
+    }
+    else if (batchSize > FM_RAW_SOCKET_MAX_RX_BATCH)
+    {
+        batchSize = FM_RAW_SOCKET_MAX_RX_BATCH;
+    }
 
     /* Setup the name of the interface */
     FM_STRNCPY_S(ifr.ifr_name, 
@@ -809,207 +1206,148 @@ void * fmRawPacketSocketReceivePackets(void *args)
         /* MTU Size change */
         if (newMtu != maxMtu)
         {
-            if (recvChainHead != NULL)
+            /* release the existing buffer chains */
+            for (i = 0 ; i < FM_RAW_SOCKET_MAX_RX_BATCH ; i++)
             {
-                /* release the existing buffer chain */
-                status = fmFreeBufferChain(FM_FIRST_FOCALPOINT, recvChainHead);
-
-                if (status != FM_OK)
-                {
-                    FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
-                                 "Unable to release prior buffer chain, "
-                                 "status = %d (%s)\n",
-                                 status,
-                                 fmErrorMsg(status) );
-                }
-
-                recvChainHead = NULL;
+                ReleaseRxChain(&slots[i].chain);
             }
 
             /* compute new buffer count */
-            iov_count = newMtu / FM_BUFFER_SIZE_BYTES;
-            if (newMtu % FM_BUFFER_SIZE_BYTES)
+            iov_count = newMtu / fmPlatformGetBufferSize();
+            if (newMtu % fmPlatformGetBufferSize())
             {
                 iov_count++;
             }
 
+            /* Each slot needs a timestamp iovec plus one per buffer */
+            maxSlots = UIO_MAXIOV / (iov_count + 1);
+            if (maxSlots < 1)
+            {
+                maxSlots = 1;
+            }
+
             maxMtu = newMtu;
         }
 
-        if (recvChainHead == NULL)
-        {
-            /* allocate a new buffer chain and initialize iovec array */
-            msg.msg_iovlen = 0;
-            
-            /* 8-Byte Timestamp IOV */
-            iov[msg.msg_iovlen].iov_base = rawTS;
-            iov[msg.msg_iovlen].iov_len  = sizeof(rawTS);
-            msg.msg_iovlen++;
+        numSlots = (batchSize < maxSlots) ? batchSize : maxSlots;
+
+        /**************************************************
+         * Pre-post buffer chains. The first slot waits for
+         * buffers like the legacy path did, the others are
+         * only filled while the pool stays above the
+         * receive threshold so a burst cannot starve the
+         * transmit side.
+         **************************************************/
+        iovUsed   = 0;
+        numPosted = 0;
 
-            for (iov_offset = 0 ; iov_offset < iov_count ; iov_offset++)
+        for (i = 0 ; i < numSlots ; i++)
+        {
+            if (slots[i].chain == NULL)
             {
-                do
+                if (i > 0)
                 {
-                    nextBuffer = fmAllocateBuffer(FM_FIRST_FOCALPOINT);
-
-                    if (nextBuffer == NULL)
+                    if (availableBuffers - iov_count <= FM_RECV_BUFFER_THRESHOLD)
                     {
-                        /* Wait a little while for buffer to return */
-                        fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_RX_OUT_OF_BUFFERS,
-                                                 1);
-                        fmYield();
+                        break;
                     }
                 }
-                while (nextBuffer == NULL);
 
-                if (recvChainHead == NULL)
-                {
-                    recvChainHead    = nextBuffer;
-                    nextBuffer->next = NULL;
-                }
-                else
-                {
-                    status = fmAddBuffer(recvChainHead, nextBuffer);
+                slots[i].chain = AllocateRxChain(iov_count, (i == 0));
 
-                    if (status != FM_OK)
-                    {
-                        FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
-                                     "Unable to add buffer %d (%p) to chain %p\n",
-                                     iov_offset,
-                                     (void *) nextBuffer,
-                                     (void *) recvChainHead );
-                        break;
-                    }
+                if (slots[i].chain == NULL)
+                {
+                    break;
                 }
 
-                iov[msg.msg_iovlen].iov_base = nextBuffer->data;
-                iov[msg.msg_iovlen].iov_len  = FM_BUFFER_SIZE_BYTES;
-                msg.msg_iovlen++;
+                availableBuffers -= iov_count;
             }
-        }
 
-        /* now receive from the driver */
-        len = recvmsg(GET_PLAT_STATE(sw)->rawSocket,
-                      &msg,
-                      0);
+            FM_CLEAR(msgs[i]);
+            msgs[i].msg_hdr.msg_iov    = &iov[iovUsed];
+            msgs[i].msg_hdr.msg_iovlen = BuildRxIovecs(&slots[i],
+                                                       &iov[iovUsed]);
+#ifdef ENABLE_TIMESTAMP
+            msgs[i].msg_hdr.msg_control    = &slots[i].control;
+            msgs[i].msg_hdr.msg_controllen = sizeof(slots[i].control);
+#endif
+            iovUsed += msgs[i].msg_hdr.msg_iovlen;
+            numPosted++;
+        }
 
-        if (len == -1)
+        if (numPosted == 0)
         {
             continue;
         }
 
-#ifdef ENABLE_TIMESTAMP
-        for (cmsg = CMSG_FIRSTHDR(&msg);
-             cmsg;
-             cmsg = CMSG_NXTHDR(&msg, cmsg)) 
+        /* now receive from the driver */
+        if (numPosted == 1)
         {
-            if ( (cmsg->cmsg_level == SOL_SOCKET) &&
-                 (cmsg->cmsg_type  == SO_TIMESTAMPING) &&
-                 (cmsg->cmsg_len   == CMSG_LEN(sizeof(struct timespec) * 3)) )
-            {
-                    struct timespec *stamp =
-                        (struct timespec *)CMSG_DATA(cmsg);
-                    /* cmsg has 3 different timestamps. Timestamp we are interested is 
-                     * located in index 2 */
-                    sbData.ingressTimestamp.seconds     = ( (fm_int64)(stamp[2].tv_sec) );
-                    sbData.ingressTimestamp.nanoseconds = ( (fm_int64)(stamp[2].tv_nsec) );
-            }
-            else
+            len = recvmsg(GET_PLAT_STATE(sw)->rawSocket,
+                          &msgs[0].msg_hdr,
+                          0);
+
+            if (len == -1)
             {
-                    FM_LOG_WARNING(FM_LOG_CAT_PLATFORM, 
-                                  "Unknown control message of level %d type %d len %zu  received\n",
-                                  cmsg->cmsg_level, 
-                                  cmsg->cmsg_type,
-                                  cmsg->cmsg_len);
+                continue;
             }
-        }
-#endif
-
-        /* Remove the timestamp's length to get the length of the actual
-         * packet */
-        len -= sizeof(rawTS);
-
-        /* The raw socket does not carry the FCS in either tx or rx, however
-         * the API expects it to be present. Because the API clears the 
-         * FCS value before sending the packet event to the application, don't 
-         * bother about setting the correct FCS value and just increment the 
-         * length. The FCS value is undefined (whatever is in the fm_buffer at 
-         * the FCS position). */
-        len += 4;
 
-        /* fill in the used buffer sizes */
-        nextBuffer = recvChainHead;
-
-        while (nextBuffer != NULL)
+            msgs[0].msg_len = len;
+            retval          = 1;
+        }
+        else
         {
-            if (len > FM_BUFFER_SIZE_BYTES)
+            retval = recvmmsg(GET_PLAT_STATE(sw)->rawSocket,
+                              msgs,
+                              numPosted,
+                              MSG_DONTWAIT,
+                              NULL);
+
+            if (retval == -1)
             {
-                nextBuffer->len = FM_BUFFER_SIZE_BYTES;
+                retval = 0;
             }
             else
             {
-                nextBuffer->len = len;
-            }
+                fmDbgDiagCountIncr(sw, FM_CTR_RX_BATCH_DRAIN, 1);
+                fmDbgDiagCountIncr(sw, FM_CTR_RX_BATCH_PKTS, retval);
 
-            len -= nextBuffer->len;
-
-            if ( (len <= 0) && (nextBuffer->next != NULL) )
-            {
-                status = fmFreeBufferChain(FM_FIRST_FOCALPOINT,
-                                           nextBuffer->next);
-
-                if (status != FM_OK)
+                if (retval == numPosted)
                 {
-                    FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
-                                 "Unable to release unused buffer chain, "
-                                 "status = %d (%s)\n",
-                                 status,
-                                 fmErrorMsg(status) );
+                    fmDbgDiagCountIncr(sw, FM_CTR_RX_BATCH_FULL, 1);
                 }
-
-                nextBuffer->next = NULL;
             }
-
-            nextBuffer = nextBuffer->next;
         }
 
-        if (recvChainHead == NULL)
+        for (i = 0 ; i < retval ; i++)
         {
-            continue;
+            DeliverRxFrame(sw, &slots[i], &msgs[i]);
         }
 
-        /* Store the raw timestamp in 64b format */
-        sbData.rawTimeStamp  = ((fm_uint64) (rawTS[0] & 0xFF)) << 56;
-        sbData.rawTimeStamp |= ((fm_uint64) (rawTS[1] & 0xFF)) << 48;
-        sbData.rawTimeStamp |= ((fm_uint64) (rawTS[2] & 0xFF)) << 40;
-        sbData.rawTimeStamp |= ((fm_uint64) (rawTS[3] & 0xFF)) << 32;
-        sbData.rawTimeStamp |= ((fm_uint64) (rawTS[4] & 0xFF)) << 24;
-        sbData.rawTimeStamp |= ((fm_uint64) (rawTS[5] & 0xFF)) << 16;
-        sbData.rawTimeStamp |= ((fm_uint64) (rawTS[6] & 0xFF)) << 8;
-        sbData.rawTimeStamp |= ((fm_uint64) (rawTS[7] & 0xFF));
-
-        /* Don't provide an ISL tag pointer, let the API handle the ISL
-         * tag information (included in the fm_buffer chain). */
-        status = fmPlatformReceiveProcessV2(sw,
-                                            recvChainHead,
-                                            NULL,
-                                            &sbData);
-
-        if (status != FM_OK)
+        /**************************************************
+         * End of burst: keep the first unused chain for the
+         * next wakeup and hand the rest back to the pool.
+         **************************************************/
+        for (i = retval ; i < numPosted ; i++)
         {
-            FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
-                         "Returned error status %d "
-                         "(%s)\n",
-                         status,
-                         fmErrorMsg(status) );
-
-
+            if (slots[0].chain == NULL)
+            {
+                slots[0].chain = slots[i].chain;
+                slots[i].chain = NULL;
+            }
+            else if (i > 0)
+            {
+                ReleaseRxChain(&slots[i].chain);
+            }
         }
-        /* Buffer chain has now been consumed */
-        recvChainHead = NULL; 
 
     }   /* end while (TRUE) */
 
+    for (i = 0 ; i < FM_RAW_SOCKET_MAX_RX_BATCH ; i++)
+    {
+        ReleaseRxChain(&slots[i].chain);
+    }
+
     fmExitThread(thread);
 
     return NULL;
@@ -1118,3 +1456,146 @@ fm_bool fmIsRawPacketSocketDeviceOperational(fm_int   sw,
 
 } /* fmIsRawPacketSocketDeviceOperational */
 
+
+
+
+/*****************************************************************************/
+/** fmRawPacketSocketCountTxIovecs
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Returns the worst-case number of iovec entries
+ *                  ''fmRawPacketSocketBuildTxIovecs'' needs for the given
+ *                  packet.
+ *
+ * \param[in]       packet points to the queued packet entry.
+ *
+ * \return          Number of iovec entries.
+ *
+ *****************************************************************************/
+fm_int fmRawPacketSocketCountTxIovecs(fm_packetEntry *packet)
+{
+    fm_buffer *buf;
+    fm_int     count;
+
+    /* timetag, F56 or F64 tag, MAC header and FCS */
+    count = 4;
+
+    for ( buf = packet->packet ; buf ; buf = buf->next )
+    {
+        count++;
+    }
+
+    return count;
+
+}   /* end fmRawPacketSocketCountTxIovecs */
+
+
+
+
+/*****************************************************************************/
+/** fmRawPacketSocketBuildTxIovecs
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Builds the iovec layout for one queued packet: timetag,
+ *                  optional F56 tag, MAC header, optional F64 tag, payload
+ *                  chain and optional user-supplied FCS.
+ *
+ * \param[in]       pktState points to the packet handling state.
+ *
+ * \param[in]       packet points to the queued packet entry.
+ *
+ * \param[out]      tags points to caller-provided storage for the header
+ *                  words referenced by the iovec entries. It must remain
+ *                  valid until the message has been sent.
+ *
+ * \param[out]      iov points to caller-provided iovec storage of at least
+ *                  ''fmRawPacketSocketCountTxIovecs'' entries.
+ *
+ * \return          Number of iovec entries used.
+ *
+ *****************************************************************************/
+fm_int fmRawPacketSocketBuildTxIovecs(fm_packetHandlingState *pktState,
+                                      fm_packetEntry *        packet,
+                                      fm_rawSocketTxTags *    tags,
+                                      struct iovec *          iov)
+{
+    fm_buffer *sendBuf;
+    fm_int     iovlen = 0;
+
+    /* Add the 8 byte timetag iovec. Note that the value is ignored
+     * by the driver as it gets overwritten by the PEP. */
+    tags->rawTS = 0;
+    iov[iovlen].iov_base = &tags->rawTS;
+    iov[iovlen].iov_len = sizeof(tags->rawTS);
+    iovlen++;
+
+    if (packet->islTagFormat == FM_ISL_TAG_F56)
+    {
+        /* Add the FTAG (F56) iovec */
+        tags->islTag.f56.tag[0] = htonl(packet->islTag.f56.tag[0]);
+        tags->islTag.f56.tag[1] = htonl(packet->islTag.f56.tag[1]);
+        iov[iovlen].iov_base = &tags->islTag.f56.tag[0];
+        iov[iovlen].iov_len = FM_F56_BYTE_LEN;
+        iovlen++;
+    }
+    
+    /* iterate through all buffers */
+    for ( sendBuf = packet->packet ; sendBuf ; sendBuf = sendBuf->next )
+    {
+        /* if first buffer ... */
+        if (sendBuf == packet->packet)
+        {
+            /* Cannot modify the send buffer, since the same buffer can be
+             * used multiple times to send to multiple ports */
+
+            /* second iovec is the mac header */
+            iov[iovlen].iov_base = sendBuf->data;
+            iov[iovlen].iov_len = FM_MAC_HDR_BYTE_LEN;
+            iovlen++;
+
+            if (packet->islTagFormat == FM_ISL_TAG_F64)
+            {
+                /* Insert the F64 ISL tag */
+                tags->islTag.f64.tag[0] = htonl(packet->islTag.f64.tag[0]);
+                tags->islTag.f64.tag[1] = htonl(packet->islTag.f64.tag[1]);
+                iov[iovlen].iov_base = &tags->islTag.f64.tag[0];
+                iov[iovlen].iov_len = FM_F64_BYTE_LEN;
+                iovlen++;
+            }
+
+            /* Third is the data in the first chain */
+            if (packet->suppressVlanTag)
+            {
+                iov[iovlen].iov_base = &sendBuf->data[4];
+                iov[iovlen].iov_len = sendBuf->len-16;
+                iovlen++;
+            }
+            else
+            {
+                iov[iovlen].iov_base = &sendBuf->data[3];
+                iov[iovlen].iov_len = sendBuf->len-12;
+                iovlen++;
+            }
+        }
+        else
+        {
+            /* The rest of the chain */
+            iov[iovlen].iov_base = sendBuf->data;
+            iov[iovlen].iov_len = sendBuf->len;
+            iovlen++;
+        }
+
+    }   /* end for (...) */
+
+    /* Append user-supplied FCS value to packet. */
+    if (pktState->sendUserFcs)
+    {
+        tags->fcs = htonl(packet->fcsVal);
+        iov[iovlen].iov_base = &tags->fcs;
+        iov[iovlen].iov_len = sizeof(tags->fcs);
+        iovlen++;
+    }
+
+    return iovlen;
+
+}   /* end fmRawPacketSocketBuildTxIovecs */
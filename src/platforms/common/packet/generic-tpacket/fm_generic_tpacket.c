@@ -0,0 +1,1202 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_generic_tpacket.c
+ * Creation Date:   October, 2026
+ * Description:     Memory-mapped (TPACKET_V3) packet socket methods. The
+ *                  RX and TX rings are attached to the raw packet socket
+ *                  opened by the generic raw socket code, so frames are
+ *                  exchanged with the kernel without a system call per
+ *                  packet.
+ *
+ * Copyright (c) 2006 - 2015, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <fm_sdk_int.h>
+#include <platforms/common/packet/generic-tpacket/fm_generic_tpacket.h>
+
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+#include <net/if.h>  
+#include <poll.h>
+
+#ifdef ENABLE_TIMESTAMP
+# include <linux/net_tstamp.h>
+# include <linux/sockios.h>
+#endif
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+#define FM_RECV_BUFFER_THRESHOLD        4
+
+/* RX ring block size. A block holds as many frames as fit, so it must be
+ * at least as large as the biggest frame plus its ring header. */
+#define FM_TPACKET_RX_BLOCK_SIZE        (1 << 16)
+
+/* Nominal RX frame size, only used for the kernel's ring sanity checks */
+#define FM_TPACKET_RX_FRAME_SIZE        (1 << 11)
+
+/* Timeout in msec after which the kernel retires a partially filled RX
+ * block, bounding the latency of a lone frame. */
+#define FM_TPACKET_RX_BLOCK_TIMEOUT     4
+
+/* TX ring geometry, a TX frame must hold a jumbo frame plus its tags */
+#define FM_TPACKET_TX_BLOCK_SIZE        (1 << 16)
+#define FM_TPACKET_TX_FRAME_SIZE        (1 << 14)
+#define FM_TPACKET_TX_FRAMES_PER_BLOCK  \
+    (FM_TPACKET_TX_BLOCK_SIZE / FM_TPACKET_TX_FRAME_SIZE)
+
+/* Offset of the frame data within a TX ring frame */
+#define FM_TPACKET_TX_DATA_OFFSET       \
+    (TPACKET3_HDRLEN - sizeof(struct sockaddr_ll))
+
+/* Length of the timetag preceding every frame */
+#define FM_TPACKET_TIMETAG_LEN          8
+
+/* TX frame states in which the kernel still owns the frame. A completed
+ * frame is AVAILABLE, possibly with timestamp status bits set. */
+#define FM_TPACKET_TX_BUSY              \
+    (TP_STATUS_SEND_REQUEST | TP_STATUS_SENDING)
+
+/* Number of error queue messages discarded per recvmmsg() call */
+#define FM_TPACKET_ERRQUEUE_BATCH       32
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Local function prototypes.
+ *****************************************************************************/
+
+static fm_status SetupRings(fm_int sw, fm_tpacketState *tpState);
+static void ReceiveRingFrame(fm_int sw, struct tpacket3_hdr *hdr);
+#ifdef ENABLE_TIMESTAMP
+static fm_status EnableTxTimestamps(fm_int           sw,
+                                    fm_tpacketState *tpState,
+                                    fm_text          iface);
+static void ReapTxFrames(fm_tpacketState *tpState);
+static void DrainTxErrorQueue(fm_int sw);
+#endif
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** SetupRings
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Switches the raw packet socket to TPACKET_V3, creates
+ *                  the RX and TX rings and maps them into the process.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in,out]   tpState points to the ring state to fill in.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if the kernel rejected the ring configuration.
+ *
+ *****************************************************************************/
+static fm_status SetupRings(fm_int sw, fm_tpacketState *tpState)
+{
+    fm_status           err = FM_OK;
+    fm_int              sock;
+    fm_int              val;
+    struct tpacket_req3 rxReq;
+    struct tpacket_req3 txReq;
+    void *              map;
+
+    sock = GET_PLAT_STATE(sw)->rawSocket;
+
+    val = TPACKET_V3;
+    if (setsockopt(sock, SOL_PACKET, PACKET_VERSION, &val, sizeof(val)) < 0)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
+                     "Failed to select TPACKET_V3: errno %d\n",
+                     errno);
+        err = FM_FAIL;
+        FM_LOG_ABORT(FM_LOG_CAT_PLATFORM, err);
+    }
+
+    /* Let the kernel skip malformed TX frames instead of stalling */
+    val = 1;
+    if (setsockopt(sock, SOL_PACKET, PACKET_LOSS, &val, sizeof(val)) < 0)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                       "Failed to set PACKET_LOSS: errno %d\n",
+                       errno);
+    }
+
+#ifdef ENABLE_TIMESTAMP
+    /* Report the hardware timestamp in the RX ring header */
+    val = SOF_TIMESTAMPING_RAW_HARDWARE;
+    if (setsockopt(sock, SOL_PACKET, PACKET_TIMESTAMP, &val, sizeof(val)) < 0)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
+                     "Failed to set PACKET_TIMESTAMP: errno %d\n",
+                     errno);
+        /* Continue without timestamp */
+    }
+#endif
+
+    tpState->rxBlockSize  = FM_TPACKET_RX_BLOCK_SIZE;
+    tpState->rxBlockCount = GET_PROPERTY()->tpacketRxBlockCount;
+    if (tpState->rxBlockCount < 2)
+    {
+        tpState->rxBlockCount = 2;
+    }
+
+    tpState->txFrameSize  = FM_TPACKET_TX_FRAME_SIZE;
+    tpState->txFrameCount = GET_PROPERTY()->tpacketTxFrameCount;
+    if (tpState->txFrameCount < FM_TPACKET_TX_FRAMES_PER_BLOCK)
+    {
+        tpState->txFrameCount = FM_TPACKET_TX_FRAMES_PER_BLOCK;
+    }
+    tpState->txFrameCount -= 
+        tpState->txFrameCount % FM_TPACKET_TX_FRAMES_PER_BLOCK;
+
+    FM_CLEAR(rxReq);
+    rxReq.tp_block_size       = tpState->rxBlockSize;
+    rxReq.tp_block_nr         = tpState->rxBlockCount;
+    rxReq.tp_frame_size       = FM_TPACKET_RX_FRAME_SIZE;
+    rxReq.tp_frame_nr         = (tpState->rxBlockSize / FM_TPACKET_RX_FRAME_SIZE) *
+                                tpState->rxBlockCount;
+    rxReq.tp_retire_blk_tov   = FM_TPACKET_RX_BLOCK_TIMEOUT;
+
+    if (setsockopt(sock, SOL_PACKET, PACKET_RX_RING, &rxReq, sizeof(rxReq)) < 0)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
+                     "Failed to create RX ring of %u blocks: errno %d\n",
+                     tpState->rxBlockCount,
+                     errno);
+        err = FM_FAIL;
+        FM_LOG_ABORT(FM_LOG_CAT_PLATFORM, err);
+    }
+
+    FM_CLEAR(txReq);
+    txReq.tp_block_size = FM_TPACKET_TX_BLOCK_SIZE;
+    txReq.tp_block_nr   = tpState->txFrameCount / FM_TPACKET_TX_FRAMES_PER_BLOCK;
+    txReq.tp_frame_size = tpState->txFrameSize;
+    txReq.tp_frame_nr   = tpState->txFrameCount;
+
+    if (setsockopt(sock, SOL_PACKET, PACKET_TX_RING, &txReq, sizeof(txReq)) < 0)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
+                     "Failed to create TX ring of %u frames: errno %d\n",
+                     tpState->txFrameCount,
+                     errno);
+        err = FM_FAIL;
+        FM_LOG_ABORT(FM_LOG_CAT_PLATFORM, err);
+    }
+
+    /* The TX ring is mapped right after the RX ring. Pre-fault the whole
+     * mapping so the packet path never takes a page fault. */
+    tpState->ringSize = (tpState->rxBlockSize * tpState->rxBlockCount) +
+                        (txReq.tp_block_size * txReq.tp_block_nr);
+
+    map = mmap(NULL,
+               tpState->ringSize,
+               PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE,
+               sock,
+               0);
+    if (map == MAP_FAILED)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
+                     "Failed to map %u bytes of packet rings: errno %d\n",
+                     tpState->ringSize,
+                     errno);
+        err = FM_FAIL;
+        FM_LOG_ABORT(FM_LOG_CAT_PLATFORM, err);
+    }
+
+    tpState->ringBase     = map;
+    tpState->rxBlockIndex = 0;
+    tpState->txFrameIndex = 0;
+
+ABORT:
+    return err;
+
+}   /* end SetupRings */
+
+
+
+
+/*****************************************************************************/
+/** ReceiveRingFrame
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Copies one frame out of an RX ring block into a buffer
+ *                  chain and hands it to the API.
+ *
+ * \param[in]       sw is the switch the frame was received on.
+ *
+ * \param[in]       hdr points to the frame's ring header.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReceiveRingFrame(fm_int sw, struct tpacket3_hdr *hdr)
+{
+    fm_buffer *        recvChainHead = NULL;
+    fm_buffer *        nextBuffer;
+    fm_byte *          data;
+    fm_byte *          rawTS;
+    fm_int             len;
+    fm_int             copyLen;
+    fm_int             bufferSize;
+    fm_status          status;
+    fm_pktSideBandData sbData;
+
+    FM_CLEAR(sbData);
+
+    bufferSize = fmPlatformGetBufferSize();
+
+    data = (fm_byte *) hdr + hdr->tp_mac;
+    len  = hdr->tp_snaplen;
+
+    if (len <= FM_TPACKET_TIMETAG_LEN)
+    {
+        return;
+    }
+
+    rawTS = data;
+    data += FM_TPACKET_TIMETAG_LEN;
+    len  -= FM_TPACKET_TIMETAG_LEN;
+
+#ifdef ENABLE_TIMESTAMP
+    if (hdr->tp_status & TP_STATUS_TS_RAW_HARDWARE)
+    {
+        sbData.ingressTimestamp.seconds     = (fm_int64) hdr->tp_sec;
+        sbData.ingressTimestamp.nanoseconds = (fm_int64) hdr->tp_nsec;
+    }
+#endif
+
+    /* The raw socket does not carry the FCS, however the API expects it to
+     * be present. Copy the frame and account for an undefined FCS. */
+    len += 4;
+
+    while (len > 0)
+    {
+        do
+        {
+            nextBuffer = fmAllocateBuffer(FM_FIRST_FOCALPOINT);
+
+            if (nextBuffer == NULL)
+            {
+                /* Wait a little while for buffer to return */
+                fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_RX_OUT_OF_BUFFERS, 1);
+                fmYield();
+            }
+        }
+        while (nextBuffer == NULL);
+
+        nextBuffer->next = NULL;
+        nextBuffer->len  = (len > bufferSize) ? bufferSize : len;
+
+        /* The trailing FCS bytes are not in the ring */
+        copyLen = nextBuffer->len;
+        if (copyLen > len - 4)
+        {
+            copyLen = (len - 4 > 0) ? len - 4 : 0;
+        }
+
+        FM_MEMCPY_S(nextBuffer->data, bufferSize, data, copyLen);
+        data += copyLen;
+        len  -= nextBuffer->len;
+
+        if (recvChainHead == NULL)
+        {
+            recvChainHead = nextBuffer;
+        }
+        else
+        {
+            status = fmAddBuffer(recvChainHead, nextBuffer);
+
+            if (status != FM_OK)
+            {
+                FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                             "Unable to add buffer %p to chain %p\n",
+                             (void *) nextBuffer,
+                             (void *) recvChainHead);
+                fmFreeBuffer(FM_FIRST_FOCALPOINT, nextBuffer);
+                fmFreeBufferChain(FM_FIRST_FOCALPOINT, recvChainHead);
+                return;
+            }
+        }
+    }
+
+    /* Store the raw timestamp in 64b format */
+    sbData.rawTimeStamp  = ((fm_uint64) (rawTS[0] & 0xFF)) << 56;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[1] & 0xFF)) << 48;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[2] & 0xFF)) << 40;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[3] & 0xFF)) << 32;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[4] & 0xFF)) << 24;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[5] & 0xFF)) << 16;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[6] & 0xFF)) << 8;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[7] & 0xFF));
+
+    /* Don't provide an ISL tag pointer, let the API handle the ISL
+     * tag information (included in the fm_buffer chain). */
+    status = fmPlatformReceiveProcessV2(sw, recvChainHead, NULL, &sbData);
+
+    if (status != FM_OK)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                     "Returned error status %d (%s)\n",
+                     status,
+                     fmErrorMsg(status));
+    }
+
+}   /* end ReceiveRingFrame */
+
+
+
+#ifdef ENABLE_TIMESTAMP
+/*****************************************************************************/
+/** EnableTxTimestamps
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Turns on hardware timestamping of transmitted frames.
+ *                  The kernel writes the egress timestamp into the TX ring
+ *                  frame header when it hands the frame back, so the
+ *                  timestamps are collected from the ring without any
+ *                  system call.
+ *
+ * \note            Must be called after SetupRings.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in,out]   tpState points to the ring state.
+ *
+ * \param[in]       iface is the name of the netdev bound to the socket.
+ *
+ * \return          FM_OK if successful, including when the device does not
+ *                  support TX timestamping, in which case timestamps
+ *                  stay disabled.
+ * \return          FM_ERR_NO_MEM if the timestamp records could not be
+ *                  allocated.
+ * \return          FM_FAIL if the lock could not be created.
+ *
+ *****************************************************************************/
+static fm_status EnableTxTimestamps(fm_int           sw,
+                                    fm_tpacketState *tpState,
+                                    fm_text          iface)
+{
+    fm_status              err = FM_OK;
+    fm_int                 sock;
+    fm_int                 val;
+    fm_uint                size;
+    struct ifreq           ifr;
+    struct hwtstamp_config hwconfig;
+
+    sock = GET_PLAT_STATE(sw)->rawSocket;
+
+    FM_CLEAR(ifr);
+    FM_CLEAR(hwconfig);
+
+    FM_STRNCPY_S(ifr.ifr_name, IF_NAMESIZE, iface, IF_NAMESIZE);
+    ifr.ifr_data       = (void *) &hwconfig;
+    hwconfig.tx_type   = HWTSTAMP_TX_ON;
+    hwconfig.rx_filter = HWTSTAMP_FILTER_ALL;
+
+    if ( (ioctl(sock, SIOCSHWTSTAMP, &ifr) < 0) ||
+         (hwconfig.tx_type != HWTSTAMP_TX_ON) )
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                       "TX hardware timestamps not supported by %s: "
+                       "errno %d\n",
+                       iface,
+                       errno);
+        goto ABORT;
+    }
+
+    /* The RAW_HARDWARE report flag is shared with the RX path */
+    val = SOF_TIMESTAMPING_RX_HARDWARE |
+          SOF_TIMESTAMPING_TX_HARDWARE |
+          SOF_TIMESTAMPING_RAW_HARDWARE;
+    if (setsockopt(sock, SOL_SOCKET, SO_TIMESTAMPING, &val, sizeof(val)) < 0)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                       "Failed to request TX timestamps: errno %d\n",
+                       errno);
+        goto ABORT;
+    }
+
+    size = sizeof(fm_tpacketTxTimestamp) * tpState->txFrameCount;
+
+    tpState->txFrameMeta = fmAlloc(size);
+    tpState->txTsRing    = fmAlloc(size);
+    if ( (tpState->txFrameMeta == NULL) || (tpState->txTsRing == NULL) )
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+    }
+
+    FM_MEMSET_S(tpState->txFrameMeta, size, 0, size);
+    FM_MEMSET_S(tpState->txTsRing, size, 0, size);
+
+    if ( pthread_mutex_init(&tpState->txTsLock, NULL) )
+    {
+        err = FM_FAIL;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+    }
+
+    tpState->txTimestamps = TRUE;
+
+ABORT:
+    if (!tpState->txTimestamps)
+    {
+        if (tpState->txFrameMeta != NULL)
+        {
+            fmFree(tpState->txFrameMeta);
+            tpState->txFrameMeta = NULL;
+        }
+
+        if (tpState->txTsRing != NULL)
+        {
+            fmFree(tpState->txTsRing);
+            tpState->txTsRing = NULL;
+        }
+    }
+
+    return err;
+
+}   /* end EnableTxTimestamps */
+
+
+
+
+/*****************************************************************************/
+/** ReapTxFrames
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Moves the TX ring frames the kernel has handed back,
+ *                  oldest first, into the completed timestamp buffer.
+ *                  The oldest completion is overwritten if the buffer is
+ *                  full.
+ *
+ * \note            The caller must hold txTsLock.
+ *
+ * \param[in,out]   tpState points to the ring state.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReapTxFrames(fm_tpacketState *tpState)
+{
+    struct tpacket3_hdr *  hdr;
+    fm_tpacketTxTimestamp *entry;
+    fm_uint                status;
+    fm_uint                slot;
+
+    while (tpState->txPending > 0)
+    {
+        hdr = (struct tpacket3_hdr *)
+                  ( tpState->ringBase +
+                    (tpState->rxBlockSize * tpState->rxBlockCount) +
+                    (tpState->txFrameSize * tpState->txReapIndex) );
+
+        status = hdr->tp_status;
+        if (status & FM_TPACKET_TX_BUSY)
+        {
+            /* Frames complete in order, nothing further is done */
+            break;
+        }
+
+        /* Read the timestamp only after the status */
+        FM_ATOMIC_FENCE();
+
+        slot = (tpState->txTsHead + tpState->txTsCount) %
+               tpState->txFrameCount;
+
+        if (tpState->txTsCount == tpState->txFrameCount)
+        {
+            tpState->txTsHead = (tpState->txTsHead + 1) %
+                                tpState->txFrameCount;
+        }
+        else
+        {
+            tpState->txTsCount++;
+        }
+
+        entry  = &tpState->txTsRing[slot];
+        *entry = tpState->txFrameMeta[tpState->txReapIndex];
+
+        if (status & TP_STATUS_TS_RAW_HARDWARE)
+        {
+            entry->valid                   = TRUE;
+            entry->txTimestamp.seconds     = (fm_int64) hdr->tp_sec;
+            entry->txTimestamp.nanoseconds = (fm_int64) hdr->tp_nsec;
+        }
+
+        tpState->txReapIndex = (tpState->txReapIndex + 1) %
+                               tpState->txFrameCount;
+        tpState->txPending--;
+    }
+
+}   /* end ReapTxFrames */
+
+
+
+
+/*****************************************************************************/
+/** DrainTxErrorQueue
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Discards the TX timestamp notifications the kernel
+ *                  queues on the socket error queue. The timestamps are
+ *                  taken from the TX ring instead, the queue only has to
+ *                  be emptied so that poll() stops reporting POLLERR.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void DrainTxErrorQueue(fm_int sw)
+{
+    struct mmsghdr msgs[FM_TPACKET_ERRQUEUE_BATCH];
+    fm_int         numMsgs;
+
+    FM_CLEAR(msgs);
+
+    do
+    {
+        /* Empty buffers, every message is truncated and dropped */
+        numMsgs = recvmmsg(GET_PLAT_STATE(sw)->rawSocket,
+                           msgs,
+                           FM_TPACKET_ERRQUEUE_BATCH,
+                           MSG_ERRQUEUE | MSG_DONTWAIT,
+                           NULL);
+    }
+    while (numMsgs == FM_TPACKET_ERRQUEUE_BATCH);
+
+}   /* end DrainTxErrorQueue */
+#endif
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** fmTpacketHandlingInitialize
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Initializes the memory-mapped packet socket transfer
+ *                  module. The raw packet socket is opened as for the
+ *                  ''raw'' packet interface, then switched to TPACKET_V3
+ *                  RX and TX rings.
+ *
+ * \param[in]       sw is the switch number to initialize.
+ * 
+ * \param[in]       hasFcs is TRUE if the packet includes the FCS field.
+ * 
+ * \param[in]       iface is a string containing the netdev's interface name
+ *                  through which the packets should be sent / received.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if the ring state could not be allocated.
+ * \return          FM_FAIL if the rings could not be set up.
+ *
+ *****************************************************************************/
+fm_status fmTpacketHandlingInitialize(fm_int  sw, 
+                                      fm_bool hasFcs, 
+                                      fm_text iface)
+{
+    fm_status        err;
+    fm_tpacketState *tpState = NULL;
+    fm_switch *      switchPtr;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
+                 "sw=%d hasFcs=%s\n",
+                 sw,
+                 FM_BOOLSTRING(hasFcs));
+
+    err = fmRawPacketSocketOpen(sw, hasFcs, iface);
+    if (err != FM_OK)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
+    }
+
+    tpState = fmAlloc(sizeof(fm_tpacketState));
+    if (tpState == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+    }
+
+    FM_CLEAR(*tpState);
+
+    err = SetupRings(sw, tpState);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+
+#ifdef ENABLE_TIMESTAMP
+    if (GET_PROPERTY()->tpacketTxTimestamps)
+    {
+        err = EnableTxTimestamps(sw, tpState, iface);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+    }
+#endif
+
+    GET_PLAT_STATE(sw)->tpacketState = tpState;
+
+    /* Create the receive packet thread */
+    err = fmCreateThread("tpacket receive",
+                         FM_EVENT_QUEUE_SIZE_NONE,
+                         &fmTpacketReceivePackets,
+                         &(GET_PLAT_STATE(sw)->sw),
+                         GET_PLAT_RAW_LISTENER(sw));
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    if (switchPtr)
+    {
+        switchPtr->isRawSocketInitialized = FM_ENABLED;
+    }
+
+ABORT:
+    if (err != FM_OK)
+    {
+        if (tpState != NULL)
+        {
+            if (tpState->ringBase != NULL)
+            {
+                munmap(tpState->ringBase, tpState->ringSize);
+            }
+
+            if (tpState->txTimestamps)
+            {
+                pthread_mutex_destroy(&tpState->txTsLock);
+                fmFree(tpState->txFrameMeta);
+                fmFree(tpState->txTsRing);
+            }
+
+            fmFree(tpState);
+        }
+
+        GET_PLAT_STATE(sw)->tpacketState = NULL;
+        (void) fmRawPacketSocketDestroy(sw);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
+
+}   /* end fmTpacketHandlingInitialize */
+
+
+
+
+/*****************************************************************************/
+/** fmTpacketDestroy
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Unmaps the packet rings and destroys the underlying raw
+ *                  packet socket. The receive thread must have exited.
+ *
+ * \param[in]       sw is the switch number to destroy.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmTpacketDestroy(fm_int sw)
+{
+    fm_status        err;
+    fm_tpacketState *tpState;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM, "sw=%d\n", sw);
+
+    tpState = GET_PLAT_STATE(sw)->tpacketState;
+
+    if (tpState != NULL)
+    {
+        if (munmap(tpState->ringBase, tpState->ringSize) == -1)
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
+                         "Failed to unmap packet rings: errno %d\n",
+                         errno);
+        }
+
+        if (tpState->txTimestamps)
+        {
+            pthread_mutex_destroy(&tpState->txTsLock);
+            fmFree(tpState->txFrameMeta);
+            fmFree(tpState->txTsRing);
+        }
+
+        fmFree(tpState);
+        GET_PLAT_STATE(sw)->tpacketState = NULL;
+    }
+
+    err = fmRawPacketSocketDestroy(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
+
+}   /* end fmTpacketDestroy */
+
+
+
+
+/*****************************************************************************/
+/** fmTpacketSendPackets
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Copies the packets queued in the TX queue into free TX
+ *                  ring frames and kicks the kernel once for the whole
+ *                  batch. Packets that do not fit in the ring stay queued
+ *                  and the transmitter is flagged as locked so the send is
+ *                  retried.
+ *
+ * \param[in]       sw is the switch number to send packets to.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNINITIALIZED if the rings are not set up.
+ * \return          FM_FAIL if the network device is down or the kernel
+ *                  refused the batch.
+ *
+ *****************************************************************************/
+fm_status fmTpacketSendPackets(fm_int sw)
+{
+    fm_status               err = FM_OK;
+    fm_switch *             switchPtr;
+    fm_packetHandlingState *pktState;
+    fm_packetQueue *        txQueue;
+    fm_packetEntry *        packet;
+    fm_tpacketState *       tpState;
+    fm_tpacketTxTimestamp * meta;
+    struct tpacket3_hdr *   hdr;
+    fm_rawSocketTxTags      tags;
+    struct iovec            iov[UIO_MAXIOV];
+    fm_txCompletionBatch    completions;
+    fm_status               retireStatus;
+    fm_byte *               frame;
+    fm_int                  iovlen;
+    fm_int                  numQueued = 0;
+    fm_uint                 frameLen;
+    fm_int                  i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX, "sw = %d\n", sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    pktState  = GET_PLAT_PKT_STATE(sw);
+    tpState   = GET_PLAT_STATE(sw)->tpacketState;
+
+    if (tpState == NULL)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_TX, 
+                     "Packet rings are not initialized.\n");
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_UNINITIALIZED);
+    }
+
+    /* Only poll the netdev state after a failed or blocked transmit */
+    if ( switchPtr->transmitterLock &&
+         !fmIsRawPacketSocketDeviceOperational(sw, NULL, NULL) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_FAIL);
+    }
+
+    switchPtr->transmitterLock = FALSE;
+    completions.numCompletions = 0;
+
+    if (tpState->txTimestamps)
+    {
+        pthread_mutex_lock(&tpState->txTsLock);
+    }
+
+    /**************************************************
+     * Copy one packet at a time from the highest
+     * priority queue with published packets.
+     **************************************************/
+    while ( (txQueue = fmPacketQueueGetNextToDrain(sw)) != NULL )
+    {
+        fmPacketQueueDrainLock(txQueue);
+
+        if (txQueue->pullIndex == fmPacketQueueGetTail(txQueue))
+        {
+            /* Another consumer drained the queue first */
+            fmPacketQueueDrainUnlock(txQueue);
+            continue;
+        }
+
+        packet = &txQueue->packetQueueList[txQueue->pullIndex];
+
+        frame = tpState->ringBase +
+                (tpState->rxBlockSize * tpState->rxBlockCount) +
+                (tpState->txFrameSize * tpState->txFrameIndex);
+        hdr   = (struct tpacket3_hdr *) frame;
+
+#ifdef ENABLE_TIMESTAMP
+        if ( tpState->txTimestamps &&
+             (tpState->txPending == tpState->txFrameCount) )
+        {
+            /* Collect the timestamps before the frames are reused */
+            ReapTxFrames(tpState);
+        }
+#endif
+
+        if ( (hdr->tp_status & FM_TPACKET_TX_BUSY) ||
+             ( tpState->txTimestamps &&
+               (tpState->txPending == tpState->txFrameCount) ) )
+        {
+            /* Ring is full, retry once the kernel catches up */
+            switchPtr->transmitterLock = TRUE;
+            fmPacketQueueDrainUnlock(txQueue);
+            break;
+        }
+
+        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
+                     "sending packet in slot %d, length=%d tag=%d fcs=%08x\n",
+                     txQueue->pullIndex, packet->length,
+                     packet->suppressVlanTag, packet->fcsVal);
+
+        if (fmRawPacketSocketCountTxIovecs(packet) <= UIO_MAXIOV)
+        {
+            iovlen   = fmRawPacketSocketBuildTxIovecs(pktState,
+                                                      packet,
+                                                      &tags,
+                                                      iov);
+            frameLen = 0;
+
+            for (i = 0 ; i < iovlen ; i++)
+            {
+                frameLen += iov[i].iov_len;
+            }
+        }
+        else
+        {
+            iovlen   = 0;
+            frameLen = tpState->txFrameSize;
+        }
+
+        retireStatus = FM_OK;
+
+        if (frameLen > tpState->txFrameSize - FM_TPACKET_TX_DATA_OFFSET)
+        {
+            /* The packet can never be sent, drop it */
+            fmDbgDiagCountIncr(sw, FM_CTR_TX_PKT_DROP, 1);
+            retireStatus = FM_ERR_FRAME_TOO_LARGE;
+        }
+        else
+        {
+            frameLen = 0;
+
+            for (i = 0 ; i < iovlen ; i++)
+            {
+                FM_MEMCPY_S(frame + FM_TPACKET_TX_DATA_OFFSET + frameLen,
+                            tpState->txFrameSize - FM_TPACKET_TX_DATA_OFFSET
+                                - frameLen,
+                            iov[i].iov_base,
+                            iov[i].iov_len);
+                frameLen += iov[i].iov_len;
+            }
+
+            hdr->tp_len         = frameLen;
+            hdr->tp_next_offset = 0;
+
+            if (tpState->txTimestamps)
+            {
+                /* Remember the frame so its timestamp can be matched */
+                meta = &tpState->txFrameMeta[tpState->txFrameIndex];
+                FM_CLEAR(*meta);
+
+                meta->seqNum      = tpState->txSeqNum++;
+                meta->logicalPort = packet->info.logicalPort;
+                meta->length      = packet->length;
+                meta->headerLen   = packet->packet->len;
+                if (meta->headerLen > FM_TPACKET_TX_TS_HDR_LEN)
+                {
+                    meta->headerLen = FM_TPACKET_TX_TS_HDR_LEN;
+                }
+
+                FM_MEMCPY_S(meta->header,
+                            sizeof(meta->header),
+                            packet->packet->data,
+                            meta->headerLen);
+
+                tpState->txPending++;
+            }
+
+            /* Hand the frame to the kernel once its content is visible */
+            FM_ATOMIC_FENCE();
+            hdr->tp_status = TP_STATUS_SEND_REQUEST;
+
+            tpState->txFrameIndex =
+                (tpState->txFrameIndex + 1) % tpState->txFrameCount;
+            numQueued++;
+        }
+
+        /**************************************************
+         * The frame has been copied into the ring. Drop
+         * this entry's reference on the buffer, which is
+         * freed once every entry sharing it has been sent.
+         **************************************************/
+        fmPacketQueueRetire(sw, txQueue, retireStatus, &completions);
+        fmPacketQueueDrainUnlock(txQueue);
+    }
+
+    if (tpState->txTimestamps)
+    {
+        pthread_mutex_unlock(&tpState->txTsLock);
+    }
+
+    if (numQueued > 0)
+    {
+        /* A single kick transmits every frame marked for sending */
+        if ( (send(GET_PLAT_STATE(sw)->rawSocket, NULL, 0, MSG_DONTWAIT) == -1) &&
+             (errno != EWOULDBLOCK) &&
+             (errno != ENOBUFS) )
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_TX,
+                         "TX ring kick failed - errno %d\n",
+                         errno);
+            switchPtr->transmitterLock = TRUE;
+            err = FM_FAIL;
+        }
+
+        fmDbgDiagCountIncr(sw, FM_CTR_TX_BATCH_FLUSH, 1);
+        fmDbgDiagCountIncr(sw, FM_CTR_TX_BATCH_PKTS, numQueued);
+        fmDbgDiagCountIncr(sw, FM_CTR_TX_PKT_COMPLETE, numQueued);
+    }
+
+    /* The frames are in the kernel's hands once the ring is kicked */
+    fmPacketFlushTxCompletions(sw, &completions);
+
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+}   /* end fmTpacketSendPackets */
+
+
+
+
+/*****************************************************************************/
+/** fmTpacketReceivePackets
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Handles reception of packets from the RX ring. Every
+ *                  block retired by the kernel is drained in one pass
+ *                  and handed back, so the thread only sleeps in poll()
+ *                  when the ring is empty.
+ *
+ * \param[in]       args is a pointer to the switch number.
+ *
+ * \return          NULL.
+ *
+ *****************************************************************************/
+void * fmTpacketReceivePackets(void *args)
+{
+    fm_thread *                thread;
+    fm_int                     sw;
+    fm_tpacketState *          tpState;
+    struct tpacket_block_desc *block;
+    struct tpacket3_hdr *      hdr;
+    struct pollfd              rfds;
+    fm_int                     availableBuffers;
+    fm_uint                    numPkts;
+    fm_uint                    i;
+
+    thread = FM_GET_THREAD_HANDLE(args);
+    sw     = *(FM_GET_THREAD_PARAM(fm_int, args));
+
+    FM_NOT_USED(thread);    /* If logging is disabled, thread won't be used */
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH,
+                 "thread = %s, sw = %d\n",
+                 thread->name,
+                 sw);
+
+    tpState = GET_PLAT_STATE(sw)->tpacketState;
+
+    /* Prepare the pollfd struct */
+    rfds.fd      = GET_PLAT_STATE(sw)->rawSocket;
+    rfds.events  = POLLIN | POLLERR;
+    rfds.revents = 0;
+
+    /**************************************************
+     * Loop forever calling packet receive handler.
+     **************************************************/
+
+    while (TRUE)
+    {
+        block = (struct tpacket_block_desc *)
+                    ( tpState->ringBase +
+                      (tpState->rxBlockSize * tpState->rxBlockIndex) );
+
+        if ( (block->hdr.bh1.block_status & TP_STATUS_USER) == 0 )
+        {
+            if (poll(&rfds, 1, FM_FDS_POLL_TIMEOUT_USEC) <= 0)
+            {
+                /* Switch was removed, kill the thread */
+                if (GET_SWITCH_PTR(sw) == NULL)
+                {
+                    break;
+                }
+            }
+#ifdef ENABLE_TIMESTAMP
+            else if (rfds.revents & POLLERR)
+            {
+                DrainTxErrorQueue(sw);
+            }
+#endif
+
+            continue;
+        }
+
+        /* get the number of available buffers from the buffer manager*/
+        fmPlatformGetAvailableBuffers(&availableBuffers);
+
+        if (availableBuffers <= FM_RECV_BUFFER_THRESHOLD)
+        {
+            /* wait for buffer to come back, before dequeueing data */
+            fmYield();
+            continue;
+        }
+
+        /* Read the block content only after its status */
+        FM_ATOMIC_FENCE();
+
+        numPkts = block->hdr.bh1.num_pkts;
+        hdr     = (struct tpacket3_hdr *)
+                      ( (fm_byte *) block + block->hdr.bh1.offset_to_first_pkt );
+
+        for (i = 0 ; i < numPkts ; i++)
+        {
+            ReceiveRingFrame(sw, hdr);
+            hdr = (struct tpacket3_hdr *)
+                      ( (fm_byte *) hdr + hdr->tp_next_offset );
+        }
+
+        fmDbgDiagCountIncr(sw, FM_CTR_RX_BATCH_DRAIN, 1);
+        fmDbgDiagCountIncr(sw, FM_CTR_RX_BATCH_PKTS, numPkts);
+
+        /* Return the block to the kernel */
+        FM_ATOMIC_FENCE();
+        block->hdr.bh1.block_status = TP_STATUS_KERNEL;
+
+        tpState->rxBlockIndex = (tpState->rxBlockIndex + 1) %
+                                tpState->rxBlockCount;
+
+    }   /* end while (TRUE) */
+
+    fmExitThread(thread);
+
+    return NULL;
+
+}   /* end fmTpacketReceivePackets */
+
+
+
+
+/*****************************************************************************/
+/** fmTpacketGetTxTimestamps
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Retrieves, oldest first, the hardware transmit
+ *                  timestamps of frames sent through the TX ring. Each
+ *                  entry carries the leading bytes of the frame so the
+ *                  caller can match it against the frame it sent. The
+ *                  timestamps are read from the ring, no system call is
+ *                  made.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[out]      entries points to a caller-allocated array of
+ *                  maxEntries elements where the timestamps are stored.
+ *
+ * \param[in]       maxEntries is the size of entries.
+ *
+ * \param[out]      numEntries points to caller-allocated storage where
+ *                  the number of entries stored is written.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_UNSUPPORTED if TX timestamps are not enabled.
+ *
+ *****************************************************************************/
+fm_status fmTpacketGetTxTimestamps(fm_int                 sw,
+                                   fm_tpacketTxTimestamp *entries,
+                                   fm_int                 maxEntries,
+                                   fm_int *               numEntries)
+{
+    fm_status        err = FM_OK;
+    fm_tpacketState *tpState;
+    fm_int           count = 0;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
+                 "sw=%d entries=%p maxEntries=%d numEntries=%p\n",
+                 sw,
+                 (void *) entries,
+                 maxEntries,
+                 (void *) numEntries);
+
+    if ( (entries == NULL) || (numEntries == NULL) || (maxEntries <= 0) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    *numEntries = 0;
+
+    tpState = GET_PLAT_STATE(sw)->tpacketState;
+
+    if ( (tpState == NULL) || !tpState->txTimestamps )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_UNSUPPORTED);
+    }
+
+#ifdef ENABLE_TIMESTAMP
+    pthread_mutex_lock(&tpState->txTsLock);
+
+    ReapTxFrames(tpState);
+
+    while ( (count < maxEntries) && (tpState->txTsCount > 0) )
+    {
+        entries[count++]  = tpState->txTsRing[tpState->txTsHead];
+        tpState->txTsHead = (tpState->txTsHead + 1) % tpState->txFrameCount;
+        tpState->txTsCount--;
+    }
+
+    pthread_mutex_unlock(&tpState->txTsLock);
+#endif
+
+    *numEntries = count;
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
+
+}   /* end fmTpacketGetTxTimestamps */
@@ -0,0 +1,1052 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_generic_xdp.c
+ * Creation Date:   October, 2026
+ * Description:     AF_XDP packet socket methods. The platform buffer pool
+ *                  is registered as the UMEM of an XDP socket, so frames
+ *                  are received straight into ''fm_buffer''s and sent from
+ *                  them through the RX, TX, fill and completion rings,
+ *                  bypassing the kernel network stack.
+ *
+ * Copyright (c) 2006 - 2015, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <fm_sdk_int.h>
+#include <platforms/common/packet/generic-xdp/fm_generic_xdp.h>
+
+#ifdef FM_HAVE_AF_XDP
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <poll.h>
+#include <unistd.h>
+
+#ifdef FM_HAVE_LIBBPF_XSK
+#include <bpf/xsk.h>
+#else
+#include <xdp/xsk.h>
+#endif
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+#define FM_RECV_BUFFER_THRESHOLD    4
+
+/* Size of each of the four rings. This bounds the number of buffers that
+ * can be in flight in either direction. */
+#define FM_XDP_RING_SIZE            2048
+
+/* Number of buffers kept in the fill ring for the kernel to receive into */
+#define FM_XDP_FILL_BUFFERS         64
+
+/* Upper bound on the number of frames received per pass */
+#define FM_XDP_RX_BATCH             64
+
+/* Netdev queue the socket is bound to */
+#define FM_XDP_QUEUE_ID             0
+
+/* Length of the timetag preceding every frame */
+#define FM_XDP_TIMETAG_LEN          8
+
+/* Smallest UMEM chunk the kernel accepts */
+#define FM_XDP_MIN_CHUNK_SIZE       2048
+
+/* Offset of a buffer's data area in the UMEM */
+#define FM_XDP_BUFFER_ADDR(xdpState, buf)                       \
+    ( (fm_uint64) ( (fm_byte *) (buf)->data - (xdpState)->umemArea ) )
+
+struct _fm_xdpState
+{
+    /* Platform buffer pool memory, registered as the UMEM */
+    fm_byte *            umemArea;
+
+    /* UMEM and its fill and completion rings */
+    struct xsk_umem *    umem;
+    struct xsk_ring_prod fill;
+    struct xsk_ring_cons comp;
+
+    /* XDP socket and its RX and TX rings */
+    struct xsk_socket *  xsk;
+    struct xsk_ring_cons rx;
+    struct xsk_ring_prod tx;
+
+    /* TRUE if the driver moves frames to and from the UMEM directly */
+    fm_bool              zeroCopy;
+
+    /* Number of buffers given to the fill ring and not received yet */
+    fm_int               fillPosted;
+
+    /* Buffers owned by the kernel, indexed by buffer number, so that they
+     * can be freed when the socket is deleted */
+    fm_buffer **         kernelOwned;
+
+    /* Number of entries in kernelOwned */
+    fm_int               numBuffers;
+};
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Local function prototypes.
+ *****************************************************************************/
+
+static fm_status SetupUmem(fm_int sw, fm_xdpState *xdpState);
+static fm_status CreateSocket(fm_int sw, fm_xdpState *xdpState, fm_text iface);
+static void FreeXdpState(fm_xdpState *xdpState);
+static void RefillRxBuffers(fm_xdpState *xdpState);
+static void ReapTxBuffers(fm_xdpState *xdpState);
+static void ReceiveFrame(fm_int                 sw,
+                         fm_xdpState *          xdpState,
+                         const struct xdp_desc *desc);
+static void *ReceivePackets(void *args);
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** SetupUmem
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Registers the platform buffer pool with the kernel as
+ *                  the UMEM of the socket, one buffer per UMEM chunk.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in,out]   xdpState points to the socket state to fill in.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the buffer pool cannot back a
+ *                  UMEM.
+ * \return          FM_ERR_NO_MEM if the socket state could not be
+ *                  allocated.
+ * \return          FM_FAIL if the kernel rejected the UMEM.
+ *
+ *****************************************************************************/
+static fm_status SetupUmem(fm_int sw, fm_xdpState *xdpState)
+{
+    struct xsk_umem_config cfg;
+    void *                 pool;
+    fm_uint64              poolSize;
+    fm_int                 bufferSize;
+    fm_int                 pageSize;
+    fm_status              err;
+    fm_int                 rv;
+
+    err = fmPlatformGetBufferPool(&pool, &poolSize);
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    bufferSize = fmPlatformGetBufferSize();
+    pageSize   = getpagesize();
+
+    /**************************************************
+     * The kernel takes UMEM chunks of a power of two
+     * size, from 2KB to a page, laid out from a page
+     * aligned start.
+     **************************************************/
+    if ( ( ( (fm_uintptr) pool % pageSize ) != 0 ) ||
+         (bufferSize < FM_XDP_MIN_CHUNK_SIZE) ||
+         (bufferSize > pageSize) ||
+         ( (bufferSize & (bufferSize - 1)) != 0 ) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
+                     "Packet buffers of switch %d cannot back a UMEM: the "
+                     "pool must be page aligned (api.platform."
+                     "bufferHugePages) and api.platform.bufferSize a power "
+                     "of two from %d to %d\n",
+                     sw,
+                     FM_XDP_MIN_CHUNK_SIZE,
+                     pageSize);
+        return FM_ERR_UNSUPPORTED;
+    }
+
+    xdpState->umemArea   = pool;
+    xdpState->numBuffers = (fm_int) (poolSize / bufferSize);
+
+    xdpState->kernelOwned =
+        fmAlloc(xdpState->numBuffers * sizeof(fm_buffer *));
+
+    if (xdpState->kernelOwned == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    FM_MEMSET_S(xdpState->kernelOwned,
+                xdpState->numBuffers * sizeof(fm_buffer *),
+                0,
+                xdpState->numBuffers * sizeof(fm_buffer *));
+
+    FM_CLEAR(cfg);
+    cfg.fill_size      = FM_XDP_RING_SIZE;
+    cfg.comp_size      = FM_XDP_RING_SIZE;
+    cfg.frame_size     = bufferSize;
+    cfg.frame_headroom = 0;
+
+    rv = xsk_umem__create(&xdpState->umem,
+                          pool,
+                          poolSize,
+                          &xdpState->fill,
+                          &xdpState->comp,
+                          &cfg);
+
+    if (rv != 0)
+    {
+        xdpState->umem = NULL;
+        FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
+                     "Unable to register the UMEM for switch %d: error %d\n",
+                     sw,
+                     rv);
+        return FM_FAIL;
+    }
+
+    return FM_OK;
+
+}   /* end SetupUmem */
+
+
+
+
+/*****************************************************************************/
+/** CreateSocket
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Creates the XDP socket on the netdev queue and attaches
+ *                  the XDP program redirecting the queue's frames to it.
+ *                  Zero-copy mode is tried first, then copy mode for
+ *                  drivers without AF_XDP support.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in,out]   xdpState points to the socket state, with the UMEM set
+ *                  up.
+ *
+ * \param[in]       iface is the netdev's interface name.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if the socket could not be created in either
+ *                  mode.
+ *
+ *****************************************************************************/
+static fm_status CreateSocket(fm_int sw, fm_xdpState *xdpState, fm_text iface)
+{
+    struct xsk_socket_config cfg;
+    fm_int                   rv;
+
+    FM_CLEAR(cfg);
+    cfg.rx_size    = FM_XDP_RING_SIZE;
+    cfg.tx_size    = FM_XDP_RING_SIZE;
+    cfg.bind_flags = XDP_USE_NEED_WAKEUP | XDP_ZEROCOPY;
+
+    rv = xsk_socket__create(&xdpState->xsk,
+                            iface,
+                            FM_XDP_QUEUE_ID,
+                            xdpState->umem,
+                            &xdpState->rx,
+                            &xdpState->tx,
+                            &cfg);
+
+    if (rv == 0)
+    {
+        xdpState->zeroCopy = TRUE;
+        return FM_OK;
+    }
+
+    cfg.bind_flags = XDP_USE_NEED_WAKEUP | XDP_COPY;
+
+    rv = xsk_socket__create(&xdpState->xsk,
+                            iface,
+                            FM_XDP_QUEUE_ID,
+                            xdpState->umem,
+                            &xdpState->rx,
+                            &xdpState->tx,
+                            &cfg);
+
+    if (rv != 0)
+    {
+        xdpState->xsk = NULL;
+        FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
+                     "Unable to create XDP socket on %s queue %d for "
+                     "switch %d: error %d\n",
+                     iface,
+                     FM_XDP_QUEUE_ID,
+                     sw,
+                     rv);
+        return FM_FAIL;
+    }
+
+    return FM_OK;
+
+}   /* end CreateSocket */
+
+
+
+
+/*****************************************************************************/
+/** FreeXdpState
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Deletes the XDP socket and the UMEM, returns the buffers
+ *                  the kernel still owned to the buffer pool and frees the
+ *                  socket state.
+ *
+ * \param[in]       xdpState points to the socket state, may be NULL.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void FreeXdpState(fm_xdpState *xdpState)
+{
+    fm_int i;
+
+    if (xdpState == NULL)
+    {
+        return;
+    }
+
+    /* The socket must go before the UMEM it is bound to */
+    if (xdpState->xsk != NULL)
+    {
+        xsk_socket__delete(xdpState->xsk);
+    }
+
+    if (xdpState->umem != NULL)
+    {
+        (void) xsk_umem__delete(xdpState->umem);
+    }
+
+    if (xdpState->kernelOwned != NULL)
+    {
+        for (i = 0 ; i < xdpState->numBuffers ; i++)
+        {
+            if (xdpState->kernelOwned[i] != NULL)
+            {
+                (void) fmPlatformFreeBuffer(xdpState->kernelOwned[i]);
+            }
+        }
+
+        fmFree(xdpState->kernelOwned);
+    }
+
+    fmFree(xdpState);
+
+}   /* end FreeXdpState */
+
+
+
+
+/*****************************************************************************/
+/** RefillRxBuffers
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Allocates buffers from the platform buffer pool and
+ *                  gives them to the fill ring, up to FM_XDP_FILL_BUFFERS.
+ *                  A few buffers are always left to the rest of the API.
+ *
+ * \param[in,out]   xdpState points to the socket state.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void RefillRxBuffers(fm_xdpState *xdpState)
+{
+    fm_buffer *bufs[FM_XDP_FILL_BUFFERS];
+    fm_int     availableBuffers;
+    fm_int     numBufs = 0;
+    fm_uint32  idx;
+    fm_int     i;
+
+    while (xdpState->fillPosted + numBufs < FM_XDP_FILL_BUFFERS)
+    {
+        fmPlatformGetAvailableBuffers(&availableBuffers);
+
+        if (availableBuffers <= FM_RECV_BUFFER_THRESHOLD)
+        {
+            fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_RX_OUT_OF_BUFFERS, 1);
+            break;
+        }
+
+        bufs[numBufs] = fmPlatformAllocateBuffer();
+
+        if (bufs[numBufs] == NULL)
+        {
+            fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_RX_OUT_OF_BUFFERS, 1);
+            break;
+        }
+
+        numBufs++;
+    }
+
+    if (numBufs == 0)
+    {
+        return;
+    }
+
+    /* The fill ring is larger than FM_XDP_FILL_BUFFERS, this cannot fail */
+    xsk_ring_prod__reserve(&xdpState->fill, numBufs, &idx);
+
+    for (i = 0 ; i < numBufs ; i++)
+    {
+        xdpState->kernelOwned[bufs[i]->index] = bufs[i];
+
+        *xsk_ring_prod__fill_addr(&xdpState->fill, idx + i) =
+            FM_XDP_BUFFER_ADDR(xdpState, bufs[i]);
+    }
+
+    xsk_ring_prod__submit(&xdpState->fill, numBufs);
+
+    xdpState->fillPosted += numBufs;
+
+}   /* end RefillRxBuffers */
+
+
+
+
+/*****************************************************************************/
+/** ReapTxBuffers
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Returns the buffers of the frames the kernel is done
+ *                  sending, as posted to the completion ring, to the
+ *                  platform buffer pool.
+ *
+ * \param[in,out]   xdpState points to the socket state.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReapTxBuffers(fm_xdpState *xdpState)
+{
+    fm_buffer *buf;
+    fm_uint32  idx;
+    fm_uint32  numDone;
+    fm_uint32  i;
+
+    numDone = xsk_ring_cons__peek(&xdpState->comp, FM_XDP_RING_SIZE, &idx);
+
+    for (i = 0 ; i < numDone ; i++)
+    {
+        buf = fmPlatformGetBufferAtOffset(
+                  *xsk_ring_cons__comp_addr(&xdpState->comp, idx + i) );
+
+        if (buf != NULL)
+        {
+            xdpState->kernelOwned[buf->index] = NULL;
+            (void) fmPlatformFreeBuffer(buf);
+        }
+    }
+
+    if (numDone > 0)
+    {
+        xsk_ring_cons__release(&xdpState->comp, numDone);
+    }
+
+}   /* end ReapTxBuffers */
+
+
+
+
+/*****************************************************************************/
+/** ReceiveFrame
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Hands the buffer a frame was received into to the API,
+ *                  without copying the frame.
+ *
+ * \param[in]       sw is the switch the frame was received on.
+ *
+ * \param[in,out]   xdpState points to the socket state.
+ *
+ * \param[in]       desc points to the RX ring descriptor of the frame,
+ *                  which starts with the timetag.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReceiveFrame(fm_int                 sw,
+                         fm_xdpState *          xdpState,
+                         const struct xdp_desc *desc)
+{
+    fm_buffer *        buf;
+    fm_byte *          chunk;
+    fm_byte *          data;
+    fm_byte *          rawTS;
+    fm_int             len;
+    fm_status          status;
+    fm_pktSideBandData sbData;
+
+    FM_CLEAR(sbData);
+
+    buf = fmPlatformGetBufferAtOffset(desc->addr);
+
+    if (buf == NULL)
+    {
+        return;
+    }
+
+    xdpState->kernelOwned[buf->index] = NULL;
+    xdpState->fillPosted--;
+
+    /* The buffer has not been touched since it was allocated */
+    chunk = (fm_byte *) buf->data;
+    data  = xdpState->umemArea + desc->addr;
+    len   = desc->len;
+
+    if (len <= FM_XDP_TIMETAG_LEN)
+    {
+        (void) fmPlatformFreeBuffer(buf);
+        return;
+    }
+
+    /* Store the raw timestamp in 64b format */
+    rawTS = data;
+    sbData.rawTimeStamp  = ((fm_uint64) (rawTS[0] & 0xFF)) << 56;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[1] & 0xFF)) << 48;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[2] & 0xFF)) << 40;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[3] & 0xFF)) << 32;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[4] & 0xFF)) << 24;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[5] & 0xFF)) << 16;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[6] & 0xFF)) << 8;
+    sbData.rawTimeStamp |= ((fm_uint64) (rawTS[7] & 0xFF));
+
+    data += FM_XDP_TIMETAG_LEN;
+    len  -= FM_XDP_TIMETAG_LEN;
+
+    /**************************************************
+     * The frame does not carry the FCS, however the
+     * API expects it to be present, with an undefined
+     * value. The kernel leaves headroom in front of the
+     * frame, so if it ends too close to the end of the
+     * buffer, or is not word aligned, it is moved to
+     * the start of the buffer.
+     **************************************************/
+    if ( ( ( (data - chunk) % 4 ) != 0 ) ||
+         ( (data - chunk) + len + 4 > fmPlatformGetBufferSize() ) )
+    {
+        memmove(chunk, data, len);
+        data = chunk;
+    }
+
+    buf->data = (fm_uint32 *) data;
+    buf->len  = len + 4;
+    buf->next = NULL;
+
+    /* Don't provide an ISL tag pointer, let the API handle the ISL
+     * tag information (included in the fm_buffer chain). */
+    status = fmPlatformReceiveProcessV2(sw, buf, NULL, &sbData);
+
+    if (status != FM_OK)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                     "Returned error status %d (%s)\n",
+                     status,
+                     fmErrorMsg(status));
+    }
+
+}   /* end ReceiveFrame */
+
+
+
+
+/*****************************************************************************/
+/** ReceivePackets
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Handles reception of packets from the RX ring. The
+ *                  buffers received into are handed to the API, and the
+ *                  fill ring is topped up with newly allocated ones.
+ *
+ * \param[in]       args contains a pointer to the thread information.
+ *
+ * \return          NULL.
+ *
+ *****************************************************************************/
+static void *ReceivePackets(void *args)
+{
+    fm_thread *   thread;
+    fm_int        sw;
+    fm_xdpState * xdpState;
+    struct pollfd rfds;
+    fm_uint32     rxIdx;
+    fm_uint32     numPkts;
+    fm_uint32     i;
+
+    thread = FM_GET_THREAD_HANDLE(args);
+    sw     = *(FM_GET_THREAD_PARAM(fm_int, args));
+
+    FM_NOT_USED(thread);    /* If logging is disabled, thread won't be used */
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH,
+                 "thread = %s, sw = %d\n",
+                 thread->name,
+                 sw);
+
+    xdpState = GET_PLAT_STATE(sw)->xdpState;
+
+    /* Prepare the pollfd struct */
+    rfds.fd      = xsk_socket__fd(xdpState->xsk);
+    rfds.events  = POLLIN;
+    rfds.revents = 0;
+
+    /**************************************************
+     * Loop forever calling packet receive handler.
+     **************************************************/
+
+    while (TRUE)
+    {
+        numPkts = xsk_ring_cons__peek(&xdpState->rx, FM_XDP_RX_BATCH, &rxIdx);
+
+        if (numPkts == 0)
+        {
+            /* Buffers may have been freed since the last refill */
+            RefillRxBuffers(xdpState);
+
+            if (poll(&rfds, 1, FM_FDS_POLL_TIMEOUT_USEC) <= 0)
+            {
+                /* Switch was removed, kill the thread */
+                if (GET_SWITCH_PTR(sw) == NULL)
+                {
+                    break;
+                }
+            }
+
+            continue;
+        }
+
+        for (i = 0 ; i < numPkts ; i++)
+        {
+            ReceiveFrame(sw,
+                         xdpState,
+                         xsk_ring_cons__rx_desc(&xdpState->rx, rxIdx + i));
+        }
+
+        xsk_ring_cons__release(&xdpState->rx, numPkts);
+
+        RefillRxBuffers(xdpState);
+
+        fmDbgDiagCountIncr(sw, FM_CTR_RX_BATCH_DRAIN, 1);
+        fmDbgDiagCountIncr(sw, FM_CTR_RX_BATCH_PKTS, numPkts);
+
+    }   /* end while (TRUE) */
+
+    fmExitThread(thread);
+
+    return NULL;
+
+}   /* end ReceivePackets */
+
+#endif  /* FM_HAVE_AF_XDP */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** fmXdpHandlingInitialize
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Initializes the AF_XDP packet transfer module. The raw
+ *                  packet socket is opened as for the ''raw'' packet
+ *                  interface, which switches the netdev to IES framing,
+ *                  then an XDP socket is bound to queue 0 of the netdev
+ *                  with an XDP program redirecting that queue's frames to
+ *                  it. The netdev should be configured with a single
+ *                  queue so that all frames are received.
+ *                                                                      \lb\lb
+ *                  The platform buffer pool is the UMEM of the socket:
+ *                  frames are received into buffers allocated with
+ *                  ''fmPlatformAllocateBuffer'' and handed to the API as
+ *                  is, and sent frames return to the pool with
+ *                  ''fmPlatformFreeBuffer'' once completed. A sent frame
+ *                  is assembled into a buffer of its own, as the timetag
+ *                  and ISL tag are inserted and the payload buffers may be
+ *                  shared by several ports. This requires a page aligned
+ *                  pool, as mapped with api.platform.bufferHugePages, and
+ *                  an api.platform.bufferSize of a power of two from 2KB
+ *                  to a page, which also bounds the frame size. Ingress
+ *                  hardware timestamps are not reported, the timetag
+ *                  preceding each frame is.
+ *
+ * \param[in]       sw is the switch number to initialize.
+ *
+ * \param[in]       hasFcs is TRUE if the packet includes the FCS field.
+ *
+ * \param[in]       iface is a string containing the netdev's interface name
+ *                  through which the packets should be sent / received.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the API was built without AF_XDP
+ *                  support or the buffer pool cannot back a UMEM.
+ * \return          FM_ERR_NO_MEM if the socket state could not be
+ *                  allocated.
+ * \return          FM_FAIL if the XDP socket could not be set up.
+ *
+ *****************************************************************************/
+fm_status fmXdpHandlingInitialize(fm_int  sw,
+                                  fm_bool hasFcs,
+                                  fm_text iface)
+{
+#ifdef FM_HAVE_AF_XDP
+    fm_status    err;
+    fm_xdpState *xdpState = NULL;
+    fm_switch *  switchPtr;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
+                 "sw=%d hasFcs=%s\n",
+                 sw,
+                 FM_BOOLSTRING(hasFcs));
+
+    err = fmRawPacketSocketOpen(sw, hasFcs, iface);
+    if (err != FM_OK)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
+    }
+
+    xdpState = fmAlloc(sizeof(fm_xdpState));
+    if (xdpState == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+    }
+
+    FM_CLEAR(*xdpState);
+
+    err = SetupUmem(sw, xdpState);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+
+    err = CreateSocket(sw, xdpState, iface);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+
+    RefillRxBuffers(xdpState);
+
+    FM_LOG_INFO(FM_LOG_CAT_PLATFORM,
+                "XDP socket on %s queue %d in %s mode\n",
+                iface,
+                FM_XDP_QUEUE_ID,
+                xdpState->zeroCopy ? "zero-copy" : "copy");
+
+    GET_PLAT_STATE(sw)->xdpState = xdpState;
+
+    /* Create the receive packet thread */
+    err = fmCreateThread("xdp receive",
+                         FM_EVENT_QUEUE_SIZE_NONE,
+                         &ReceivePackets,
+                         &(GET_PLAT_STATE(sw)->sw),
+                         GET_PLAT_RAW_LISTENER(sw));
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    if (switchPtr)
+    {
+        switchPtr->isRawSocketInitialized = FM_ENABLED;
+    }
+
+ABORT:
+    if (err != FM_OK)
+    {
+        FreeXdpState(xdpState);
+        GET_PLAT_STATE(sw)->xdpState = NULL;
+        (void) fmRawPacketSocketDestroy(sw);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
+#else
+    FM_NOT_USED(hasFcs);
+    FM_NOT_USED(iface);
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM, "sw=%d\n", sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_UNSUPPORTED);
+#endif
+
+}   /* end fmXdpHandlingInitialize */
+
+
+
+
+/*****************************************************************************/
+/** fmXdpDestroy
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Deletes the XDP socket and its UMEM, returns the buffers
+ *                  it held to the buffer pool and destroys the underlying
+ *                  raw packet socket. The receive thread must have exited.
+ *
+ * \param[in]       sw is the switch number to destroy.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the API was built without AF_XDP
+ *                  support.
+ *
+ *****************************************************************************/
+fm_status fmXdpDestroy(fm_int sw)
+{
+#ifdef FM_HAVE_AF_XDP
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM, "sw=%d\n", sw);
+
+    FreeXdpState(GET_PLAT_STATE(sw)->xdpState);
+    GET_PLAT_STATE(sw)->xdpState = NULL;
+
+    err = fmRawPacketSocketDestroy(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
+#else
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM, "sw=%d\n", sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_UNSUPPORTED);
+#endif
+
+}   /* end fmXdpDestroy */
+
+
+
+
+/*****************************************************************************/
+/** fmXdpSendPackets
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Assembles the packets of the TX packet queues into
+ *                  buffers allocated from the platform buffer pool, posts
+ *                  them to the TX ring, then wakes the kernel up once for
+ *                  the whole batch. The buffers of the frames the kernel
+ *                  is done with are freed first.
+ *
+ * \param[in]       sw refers to the switch number to send packets to.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the API was built without AF_XDP
+ *                  support.
+ * \return          FM_ERR_UNINITIALIZED if the socket is not initialized.
+ * \return          FM_FAIL if the netdev is down or the kernel could not be
+ *                  woken up.
+ *
+ *****************************************************************************/
+fm_status fmXdpSendPackets(fm_int sw)
+{
+#ifdef FM_HAVE_AF_XDP
+    fm_status               err = FM_OK;
+    fm_switch *             switchPtr;
+    fm_packetHandlingState *pktState;
+    fm_packetQueue *        txQueue;
+    fm_packetEntry *        packet;
+    fm_xdpState *           xdpState;
+    struct xdp_desc *       desc;
+    fm_rawSocketTxTags      tags;
+    struct iovec            iov[UIO_MAXIOV];
+    fm_txCompletionBatch    completions;
+    fm_status               retireStatus;
+    fm_buffer *             txBuf;
+    fm_byte *               frame;
+    fm_uint32               txIdx;
+    fm_int                  iovlen;
+    fm_int                  numQueued = 0;
+    fm_uint                 frameLen;
+    fm_uint                 bufferSize;
+    fm_int                  i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX, "sw = %d\n", sw);
+
+    switchPtr  = GET_SWITCH_PTR(sw);
+    pktState   = GET_PLAT_PKT_STATE(sw);
+    xdpState   = GET_PLAT_STATE(sw)->xdpState;
+    bufferSize = fmPlatformGetBufferSize();
+
+    if (xdpState == NULL)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_TX,
+                     "XDP socket is not initialized.\n");
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_UNINITIALIZED);
+    }
+
+    /* Only poll the netdev state after a failed or blocked transmit */
+    if ( switchPtr->transmitterLock &&
+         !fmIsRawPacketSocketDeviceOperational(sw, NULL, NULL) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_FAIL);
+    }
+
+    switchPtr->transmitterLock = FALSE;
+    completions.numCompletions = 0;
+
+    ReapTxBuffers(xdpState);
+
+    /**************************************************
+     * Copy one packet at a time from the highest
+     * priority queue with published packets.
+     **************************************************/
+    while ( (txQueue = fmPacketQueueGetNextToDrain(sw)) != NULL )
+    {
+        fmPacketQueueDrainLock(txQueue);
+
+        if (txQueue->pullIndex == fmPacketQueueGetTail(txQueue))
+        {
+            /* Another consumer drained the queue first */
+            fmPacketQueueDrainUnlock(txQueue);
+            continue;
+        }
+
+        packet = &txQueue->packetQueueList[txQueue->pullIndex];
+
+        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
+                     "sending packet in slot %d, length=%d tag=%d fcs=%08x\n",
+                     txQueue->pullIndex, packet->length,
+                     packet->suppressVlanTag, packet->fcsVal);
+
+        if (fmRawPacketSocketCountTxIovecs(packet) <= UIO_MAXIOV)
+        {
+            iovlen   = fmRawPacketSocketBuildTxIovecs(pktState,
+                                                      packet,
+                                                      &tags,
+                                                      iov);
+            frameLen = 0;
+
+            for (i = 0 ; i < iovlen ; i++)
+            {
+                frameLen += iov[i].iov_len;
+            }
+        }
+        else
+        {
+            iovlen   = 0;
+            frameLen = bufferSize + 1;
+        }
+
+        retireStatus = FM_OK;
+
+        if (frameLen > bufferSize)
+        {
+            /* The packet can never be sent, drop it */
+            fmDbgDiagCountIncr(sw, FM_CTR_TX_PKT_DROP, 1);
+            retireStatus = FM_ERR_FRAME_TOO_LARGE;
+        }
+        else
+        {
+            txBuf = fmPlatformAllocateBuffer();
+
+            if (txBuf == NULL)
+            {
+                /* Retry once frames complete or buffers are freed */
+                switchPtr->transmitterLock = TRUE;
+                fmPacketQueueDrainUnlock(txQueue);
+                break;
+            }
+
+            if (xsk_ring_prod__reserve(&xdpState->tx, 1, &txIdx) != 1)
+            {
+                /* TX ring is full, retry once the kernel catches up */
+                (void) fmPlatformFreeBuffer(txBuf);
+                switchPtr->transmitterLock = TRUE;
+                fmPacketQueueDrainUnlock(txQueue);
+                break;
+            }
+
+            frame    = (fm_byte *) txBuf->data;
+            frameLen = 0;
+
+            for (i = 0 ; i < iovlen ; i++)
+            {
+                FM_MEMCPY_S(frame + frameLen,
+                            bufferSize - frameLen,
+                            iov[i].iov_base,
+                            iov[i].iov_len);
+                frameLen += iov[i].iov_len;
+            }
+
+            xdpState->kernelOwned[txBuf->index] = txBuf;
+
+            desc       = xsk_ring_prod__tx_desc(&xdpState->tx, txIdx);
+            desc->addr = FM_XDP_BUFFER_ADDR(xdpState, txBuf);
+            desc->len  = frameLen;
+
+            numQueued++;
+        }
+
+        /**************************************************
+         * The frame has been assembled in its own buffer.
+         * Drop this entry's reference on the payload,
+         * which is freed once every entry sharing it has
+         * been sent.
+         **************************************************/
+        fmPacketQueueRetire(sw, txQueue, retireStatus, &completions);
+        fmPacketQueueDrainUnlock(txQueue);
+    }
+
+    if (numQueued > 0)
+    {
+        xsk_ring_prod__submit(&xdpState->tx, numQueued);
+
+        /* A single wakeup transmits every frame posted to the ring */
+        if ( xsk_ring_prod__needs_wakeup(&xdpState->tx) &&
+             (sendto(xsk_socket__fd(xdpState->xsk),
+                     NULL,
+                     0,
+                     MSG_DONTWAIT,
+                     NULL,
+                     0) == -1) &&
+             (errno != EAGAIN) &&
+             (errno != EBUSY) &&
+             (errno != ENOBUFS) )
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_TX,
+                         "TX ring wakeup failed - errno %d\n",
+                         errno);
+            switchPtr->transmitterLock = TRUE;
+            err = FM_FAIL;
+        }
+
+        fmDbgDiagCountIncr(sw, FM_CTR_TX_BATCH_FLUSH, 1);
+        fmDbgDiagCountIncr(sw, FM_CTR_TX_BATCH_PKTS, numQueued);
+        fmDbgDiagCountIncr(sw, FM_CTR_TX_PKT_COMPLETE, numQueued);
+    }
+
+    /* The frames are in the kernel's hands once the ring is submitted */
+    fmPacketFlushTxCompletions(sw, &completions);
+
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+#else
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX, "sw = %d\n", sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_UNSUPPORTED);
+#endif
+
+}   /* end fmXdpSendPackets */
@@ -48,6 +48,12 @@
 
 #define FM6000_I2C_ADDR 0x40
 
+/* Number of bytes of the register address that starts a transaction */
+#define I2C_ADDR_BYTES          3
+
+/* Largest number of consecutive registers moved in one transaction */
+#define I2C_BURST_MAX_WORDS     64
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -67,6 +73,225 @@
  * Local Functions
  *****************************************************************************/
 
+/*****************************************************************************/
+/** I2cBurstWords
+ * \ingroup intPlatform
+ *
+ * \desc            Returns the number of consecutive registers that may be
+ *                  moved in a single I2C transaction on a switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          The number of registers per transaction, 1 if bursts
+ *                  are disabled.
+ *
+ *****************************************************************************/
+static fm_int I2cBurstWords(fm_int sw)
+{
+    fm_int burstWords;
+
+    burstWords = FM_PLAT_GET_SWITCH_CFG(sw)->i2cBurstWords;
+
+    if (burstWords < 1)
+    {
+        return 1;
+    }
+
+    return (burstWords > I2C_BURST_MAX_WORDS) ? I2C_BURST_MAX_WORDS
+                                              : burstWords;
+
+}   /* end I2cBurstWords */
+
+
+
+
+/*****************************************************************************/
+/** I2cReadWords
+ * \ingroup intPlatform
+ *
+ * \desc            Reads consecutive 32-bit registers, packing up to
+ *                  ''I2cBurstWords'' of them into each I2C transaction.
+ *                  The caller must hold the CSR platform lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr contains the first CSR register address to read.
+ *
+ * \param[in]       n contains the number of registers to read.
+ *
+ * \param[out]      value points to an array of n elements where this
+ *                  function will place the register values.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status I2cReadWords(fm_int     sw,
+                              fm_uint32  addr,
+                              fm_int     n,
+                              fm_uint32 *value)
+{
+    fm_byte   buf[I2C_BURST_MAX_WORDS * 4];
+    fm_status err;
+    fm_int    burstWords;
+    fm_int    count;
+    fm_int    i;
+
+    err        = FM_OK;
+    burstWords = I2cBurstWords(sw);
+
+    if (burstWords == 1)
+    {
+        for (i = 0 ; i < n ; i++)
+        {
+            value[i] = addr + i;
+            err      = fmPlatformI2cWriteRead(sw, 0, FM6000_I2C_ADDR, &value[i], 3, 4);
+
+            if (err != FM_OK)
+            {
+                break;
+            }
+        }
+
+        return err;
+    }
+
+    while (n > 0)
+    {
+        count = (n < burstWords) ? n : burstWords;
+
+        /* Register address, big endian, then read the words back */
+        buf[0] = (addr >> 16) & 0xff;
+        buf[1] = (addr >> 8) & 0xff;
+        buf[2] = addr & 0xff;
+
+        err = fmPlatformI2cWriteReadBuf(sw,
+                                        0,
+                                        FM6000_I2C_ADDR,
+                                        buf,
+                                        I2C_ADDR_BYTES,
+                                        count * 4);
+
+        if (err != FM_OK)
+        {
+            break;
+        }
+
+        for (i = 0 ; i < count ; i++)
+        {
+            /* Reading from I2C is always big endian */
+            value[i] = ( (fm_uint32) buf[4 * i] << 24 )     |
+                       ( (fm_uint32) buf[4 * i + 1] << 16 ) |
+                       ( (fm_uint32) buf[4 * i + 2] << 8 )  |
+                       (fm_uint32) buf[4 * i + 3];
+        }
+
+        addr  += count;
+        value += count;
+        n     -= count;
+    }
+
+    return err;
+
+}   /* end I2cReadWords */
+
+
+
+
+/*****************************************************************************/
+/** I2cWriteWords
+ * \ingroup intPlatform
+ *
+ * \desc            Writes consecutive 32-bit registers, packing up to
+ *                  ''I2cBurstWords'' of them into each I2C transaction.
+ *                  The caller must hold the CSR platform lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr contains the first CSR register address to write.
+ *
+ * \param[in]       n contains the number of registers to write.
+ *
+ * \param[in]       value points to an array of the n values to write.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status I2cWriteWords(fm_int     sw,
+                               fm_uint32  addr,
+                               fm_int     n,
+                               fm_uint32 *value)
+{
+    fm_byte   buf[I2C_ADDR_BYTES + I2C_BURST_MAX_WORDS * 4];
+    fm_byte * data;
+    fm_uint64 longData;
+    fm_status err;
+    fm_int    burstWords;
+    fm_int    count;
+    fm_int    i;
+
+    err        = FM_OK;
+    burstWords = I2cBurstWords(sw);
+
+    if (burstWords == 1)
+    {
+        for (i = 0 ; i < n ; i++)
+        {
+            longData = ( ( ((fm_uint64)addr + i) ) << 32) | value[i];
+            err      = fmPlatformI2cWriteLong(sw, 0, FM6000_I2C_ADDR, longData, 7);
+
+            if (err != FM_OK)
+            {
+                break;
+            }
+        }
+
+        return err;
+    }
+
+    while (n > 0)
+    {
+        count = (n < burstWords) ? n : burstWords;
+
+        /* Register address then the words, all big endian */
+        buf[0] = (addr >> 16) & 0xff;
+        buf[1] = (addr >> 8) & 0xff;
+        buf[2] = addr & 0xff;
+
+        for (i = 0 ; i < count ; i++)
+        {
+            data    = &buf[I2C_ADDR_BYTES + 4 * i];
+            data[0] = (value[i] >> 24) & 0xff;
+            data[1] = (value[i] >> 16) & 0xff;
+            data[2] = (value[i] >> 8) & 0xff;
+            data[3] = value[i] & 0xff;
+        }
+
+        err = fmPlatformI2cWriteReadBuf(sw,
+                                        0,
+                                        FM6000_I2C_ADDR,
+                                        buf,
+                                        I2C_ADDR_BYTES + count * 4,
+                                        0);
+
+        if (err != FM_OK)
+        {
+            break;
+        }
+
+        addr  += count;
+        value += count;
+        n     -= count;
+    }
+
+    return err;
+
+}   /* end I2cWriteWords */
+
+
 
 
 /*****************************************************************************
@@ -279,7 +504,6 @@ fm_status fmPlatformI2cReadCSRMult(fm_int     sw,
                                        fm_uint32 *value)
 {
     fm_status err = FM_OK;
-    fm_int    i;
 
     CSR_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                   "sw = %d, addr = 0x%08x, n = %d, value = %p\n",
@@ -291,16 +515,7 @@ fm_status fmPlatformI2cReadCSRMult(fm_int     sw,
     TAKE_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
     /* Perform I2C access */
-    for (i = 0 ; i < n ; i++)
-    {
-        value[i] = addr + i;
-        err      = fmPlatformI2cWriteRead(sw, 0, FM6000_I2C_ADDR, &value[i], 3, 4);
-
-        if (err != FM_OK)
-        {
-            break;
-        }
-    }
+    err = I2cReadWords(sw, addr, n, value);
 
     DROP_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
@@ -338,8 +553,6 @@ fm_status fmPlatformI2cWriteCSRMult(fm_int     sw,
                                     fm_uint32 *value)
 {
     fm_status          err = FM_OK;
-    fm_int             i;
-    fm_uint64          data;
 
     CSR_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                   "sw = %d, addr = 0x%08x, n = %d, value = %p\n",
@@ -356,16 +569,7 @@ fm_status fmPlatformI2cWriteCSRMult(fm_int     sw,
     TAKE_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
     /* Perform I2C access */
-    for (i = 0 ; i < n ; i++)
-    {
-        data = ( ( ((fm_uint64)addr + i) ) << 32) | value[i];
-        err  = fmPlatformI2cWriteLong(sw, 0, FM6000_I2C_ADDR, data, 7);
-
-        if (err != FM_OK)
-        {
-            break;
-        }
-    }
+    err = I2cWriteWords(sw, addr, n, value);
 
     DROP_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
@@ -397,7 +601,7 @@ fm_status fmPlatformI2cWriteCSRMult(fm_int     sw,
 fm_status fmPlatformI2cReadCSR64(fm_int sw, fm_uint32 addr, fm_uint64 *value)
 {
     fm_status err = FM_OK;
-    fm_uint32 lo, hi;
+    fm_uint32 words[2];
 
     CSR_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                   "sw = %d, addr = 0x%08x, value = %p\n",
@@ -408,15 +612,11 @@ fm_status fmPlatformI2cReadCSR64(fm_int sw, fm_uint32 addr, fm_uint64 *value)
     TAKE_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
     /* Perform I2C access */
-    lo  = addr + 0;
-    err = fmPlatformI2cWriteRead(sw, 0, FM6000_I2C_ADDR, &lo, 3, 4);
+    err = I2cReadWords(sw, addr, 2, words);
 
     if (err == FM_OK)
     {
-        hi  = addr + 1;
-        err = fmPlatformI2cWriteRead(sw, 0, FM6000_I2C_ADDR, &hi, 3, 4);
-
-        *value = ( (fm_uint64) hi << 32 ) | lo;
+        *value = ( (fm_uint64) words[1] << 32 ) | words[0];
     }
 
     DROP_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
@@ -448,8 +648,7 @@ fm_status fmPlatformI2cReadCSR64(fm_int sw, fm_uint32 addr, fm_uint64 *value)
 fm_status fmPlatformI2cWriteCSR64(fm_int sw, fm_uint32 addr, fm_uint64 value)
 {
     fm_status          err = FM_OK;
-    fm_uint32          lo, hi;
-    fm_uint64          data;
+    fm_uint32          words[2];
 
     CSR_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                   "sw = %d, addr = 0x%08x, value = 0x%016" FM_FORMAT_64 "x\n",
@@ -465,17 +664,10 @@ fm_status fmPlatformI2cWriteCSR64(fm_int sw, fm_uint32 addr, fm_uint64 value)
     TAKE_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
     /* Perform I2C access */
-    lo = value;
-    hi = (value >> 32);
-
-    data = ( ( ((fm_uint64)addr + 0) ) << 32 ) | lo;
-    err  = fmPlatformI2cWriteLong(sw, 0, FM6000_I2C_ADDR, data, 7);
+    words[0] = value;
+    words[1] = (value >> 32);
 
-    if (err == FM_OK)
-    {
-        data = ( ( ((fm_uint64)addr + 1) ) << 32 ) | hi;
-        err  = fmPlatformI2cWriteLong(sw, 0, FM6000_I2C_ADDR, data, 7);
-    }
+    err = I2cWriteWords(sw, addr, 2, words);
 
     DROP_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
@@ -512,8 +704,10 @@ fm_status fmPlatformI2cReadCSRMult64(fm_int     sw,
                                          fm_int     n,
                                          fm_uint64 *value)
 {
+    fm_uint32 words[I2C_BURST_MAX_WORDS];
     fm_int    i;
-    fm_uint32 lo, hi;
+    fm_int    j;
+    fm_int    count;
     fm_status err = FM_OK;
 
     CSR_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
@@ -525,24 +719,28 @@ fm_status fmPlatformI2cReadCSRMult64(fm_int     sw,
 
     TAKE_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
-    for (i = 0 ; i < n ; i++)
+    for (i = 0 ; i < n ; i += count)
     {
-        /* Perform I2C access */
-        lo  = addr + (i * 2) + 0;
-        err = fmPlatformI2cWriteRead(sw, 0, FM6000_I2C_ADDR, &lo, 3, 4);
+        count = n - i;
 
-        if (err == FM_OK)
+        if (count > I2C_BURST_MAX_WORDS / 2)
         {
-            hi  = addr + (i * 2) + 1;
-            err = fmPlatformI2cWriteRead(sw, 0, FM6000_I2C_ADDR, &hi, 3, 4);
-
-            value[i] = ( (fm_uint64) hi << 32 ) | lo;
+            count = I2C_BURST_MAX_WORDS / 2;
         }
 
+        /* Perform I2C access */
+        err = I2cReadWords(sw, addr + (i * 2), count * 2, words);
+
         if (err != FM_OK)
         {
             break;
         }
+
+        for (j = 0 ; j < count ; j++)
+        {
+            value[i + j] = ( (fm_uint64) words[j * 2 + 1] << 32 ) |
+                           words[j * 2];
+        }
     }
 
     DROP_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
@@ -579,10 +777,11 @@ fm_status fmPlatformI2cWriteCSRMult64(fm_int     sw,
                                           fm_int     n,
                                           fm_uint64 *value)
 {
+    fm_uint32          words[I2C_BURST_MAX_WORDS];
     fm_int             i;
-    fm_uint32          lo, hi;
+    fm_int             j;
+    fm_int             count;
     fm_status          err = FM_OK;
-    fm_uint64          data;
 
     CSR_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                   "sw = %d, addr = 0x%08x, n = %d, value = %p\n",
@@ -598,21 +797,24 @@ fm_status fmPlatformI2cWriteCSRMult64(fm_int     sw,
 
     TAKE_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
-    for (i = 0 ; i < n ; i++)
+    for (i = 0 ; i < n ; i += count)
     {
-        /* Perform I2C access */
-        lo = (value[i] & 0xffffffffL);
-        hi = (value[i] >> 32);
+        count = n - i;
 
-        data = ( ( (fm_uint64) addr + (i * 2) + 0) << 32 ) | lo;
-        err  = fmPlatformI2cWriteLong(sw, 0, FM6000_I2C_ADDR, data, 7);
+        if (count > I2C_BURST_MAX_WORDS / 2)
+        {
+            count = I2C_BURST_MAX_WORDS / 2;
+        }
 
-        if (err == FM_OK)
+        for (j = 0 ; j < count ; j++)
         {
-            data = ( ( (fm_uint64) addr + (i * 2) + 1) << 32 ) | hi;
-            err  = fmPlatformI2cWriteLong(sw, 0, FM6000_I2C_ADDR, data, 7);
+            words[j * 2]     = (value[i + j] & 0xffffffffL);
+            words[j * 2 + 1] = (value[i + j] >> 32);
         }
 
+        /* Perform I2C access */
+        err = I2cWriteWords(sw, addr + (i * 2), count * 2, words);
+
         if (err != FM_OK)
         {
             break;
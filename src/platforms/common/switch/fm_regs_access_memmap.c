@@ -51,6 +51,18 @@
 #define CSR_LOG_EXIT(cat, status) return (status)
 #endif
 
+/* 64-bit accesses to the register BAR are only issued by x86-64 hosts,
+ * where a 64-bit load or store moves the register at the lower address
+ * in the low half and is a single PCIe transaction. */
+#if defined(__x86_64__)
+#define CSR_WIDE_ACCESS(sw)     (FM_PLAT_GET_SWITCH_CFG(sw)->csrWideAccess)
+#else
+#define CSR_WIDE_ACCESS(sw)     FALSE
+#endif
+
+/* Tells whether a mapped register address is 64-bit aligned */
+#define CSR_IS_ALIGNED64(ptr)   ( ( (fm_uintptr) (ptr) & 7 ) == 0 )
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -70,6 +82,128 @@
  * Local Functions
  *****************************************************************************/
 
+/*****************************************************************************/
+/** CsrReadBlock
+ * \ingroup intPlatform
+ *
+ * \desc            Copies a block of consecutive CSR registers into memory.
+ *                  If the platform allows it, the registers are read two at
+ *                  a time with 64-bit accesses.
+ *
+ * \note            The caller must hold the platform lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr is the address of the first register.
+ *
+ * \param[in]       n is the number of registers to read.
+ *
+ * \param[out]      value points to an array of n words where the register
+ *                  values are stored.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+static void CsrReadBlock(fm_int     sw,
+                         fm_uint32  addr,
+                         fm_int     n,
+                         fm_uint32 *value)
+{
+    volatile fm_uint32 *csr;
+    fm_uint64           pair;
+    fm_int              i;
+
+    csr = GET_PLAT_MEMMAP_CSR(sw) + addr;
+    i   = 0;
+
+    if ( CSR_WIDE_ACCESS(sw) && n > 1 )
+    {
+        if ( !CSR_IS_ALIGNED64(csr) )
+        {
+            value[i] = csr[i];
+            i++;
+        }
+
+        for ( ; i + 1 < n ; i += 2)
+        {
+            pair         = *(volatile fm_uint64 *) (csr + i);
+            value[i]     = (fm_uint32) pair;
+            value[i + 1] = (fm_uint32) (pair >> 32);
+        }
+    }
+
+    for ( ; i < n ; i++)
+    {
+        value[i] = csr[i];
+    }
+
+}   /* end CsrReadBlock */
+
+
+
+
+/*****************************************************************************/
+/** CsrWriteBlock
+ * \ingroup intPlatform
+ *
+ * \desc            Copies memory into a block of consecutive CSR registers.
+ *                  If the platform allows it, the registers are written two
+ *                  at a time with 64-bit accesses.
+ *
+ * \note            The caller must hold the platform lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr is the address of the first register.
+ *
+ * \param[in]       n is the number of registers to write.
+ *
+ * \param[in]       value points to an array of n words to write.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+static void CsrWriteBlock(fm_int           sw,
+                          fm_uint32        addr,
+                          fm_int           n,
+                          const fm_uint32 *value)
+{
+    volatile fm_uint32 *csr;
+    fm_int              i;
+
+    csr = GET_PLAT_MEMMAP_CSR(sw) + addr;
+    i   = 0;
+
+    if ( CSR_WIDE_ACCESS(sw) && n > 1 )
+    {
+        if ( !CSR_IS_ALIGNED64(csr) )
+        {
+            INSTRUMENT_REG_WRITE(sw, addr + i, value[i]);
+            csr[i] = value[i];
+            i++;
+        }
+
+        for ( ; i + 1 < n ; i += 2)
+        {
+            INSTRUMENT_REG_WRITE(sw, addr + i, value[i]);
+            INSTRUMENT_REG_WRITE(sw, addr + i + 1, value[i + 1]);
+
+            *(volatile fm_uint64 *) (csr + i) =
+                ( (fm_uint64) value[i + 1] << 32 ) | value[i];
+        }
+    }
+
+    for ( ; i < n ; i++)
+    {
+        INSTRUMENT_REG_WRITE(sw, addr + i, value[i]);
+        csr[i] = value[i];
+    }
+
+}   /* end CsrWriteBlock */
+
+
+
+
 
 
 /*****************************************************************************
@@ -254,8 +388,6 @@ fm_status fmPlatformReadCSRMult(fm_int     sw,
                                 fm_int     n,
                                 fm_uint32 *value)
 {
-    fm_int i;
-
     CSR_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                   "sw = %d, addr = 0x%08x, n = %d, value = %p\n",
                   sw,
@@ -265,10 +397,7 @@ fm_status fmPlatformReadCSRMult(fm_int     sw,
 
     TAKE_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
-    for (i = 0 ; i < n ; i++)
-    {
-        value[i] = GET_PLAT_MEMMAP_CSR(sw)[addr + i];
-    }
+    CsrReadBlock(sw, addr, n, value);
 
     DROP_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
@@ -305,8 +434,6 @@ fm_status fmPlatformWriteCSRMult(fm_int     sw,
                                  fm_int     n,
                                  fm_uint32 *value)
 {
-    fm_int i;
-
     CSR_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                   "sw = %d, addr = 0x%08x, n = %d, value = %p\n",
                   sw,
@@ -321,11 +448,7 @@ fm_status fmPlatformWriteCSRMult(fm_int     sw,
 
     TAKE_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
-    for (i = 0 ; i < n ; i++)
-    {
-        INSTRUMENT_REG_WRITE(sw, addr + i, value[i]);
-        GET_PLAT_MEMMAP_CSR(sw)[addr + i] = value[i];
-    }
+    CsrWriteBlock(sw, addr, n, value);
 
     DROP_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
@@ -356,7 +479,8 @@ fm_status fmPlatformWriteCSRMult(fm_int     sw,
  *****************************************************************************/
 fm_status fmPlatformReadCSR64(fm_int sw, fm_uint32 addr, fm_uint64 *value)
 {
-    fm_uint64 lo, hi;
+    volatile fm_uint32 *csr;
+    fm_uint64           lo, hi;
 
     CSR_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                   "sw = %d, addr = 0x%08x, value = %p\n",
@@ -366,9 +490,18 @@ fm_status fmPlatformReadCSR64(fm_int sw, fm_uint32 addr, fm_uint64 *value)
 
     TAKE_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
-    lo = GET_PLAT_MEMMAP_CSR(sw)[addr + 0];
-    hi = GET_PLAT_MEMMAP_CSR(sw)[addr + 1];
-    *value = (hi << 32) | lo;
+    csr = GET_PLAT_MEMMAP_CSR(sw) + addr;
+
+    if ( CSR_WIDE_ACCESS(sw) && CSR_IS_ALIGNED64(csr) )
+    {
+        *value = *(volatile fm_uint64 *) csr;
+    }
+    else
+    {
+        lo = csr[0];
+        hi = csr[1];
+        *value = (hi << 32) | lo;
+    }
 
     DROP_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
@@ -398,8 +531,9 @@ fm_status fmPlatformReadCSR64(fm_int sw, fm_uint32 addr, fm_uint64 *value)
  *****************************************************************************/
 fm_status fmPlatformWriteCSR64(fm_int sw, fm_uint32 addr, fm_uint64 value)
 {
-    fm_uint32 lo;
-    fm_uint32 hi;
+    volatile fm_uint32 *csr;
+    fm_uint32           lo;
+    fm_uint32           hi;
 
     CSR_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                   "sw = %d, addr = 0x%08x, "
@@ -421,8 +555,17 @@ fm_status fmPlatformWriteCSR64(fm_int sw, fm_uint32 addr, fm_uint64 value)
     INSTRUMENT_REG_WRITE(sw, addr + 0, lo);
     INSTRUMENT_REG_WRITE(sw, addr + 1, hi);
 
-    GET_PLAT_MEMMAP_CSR(sw)[addr + 0] = lo;
-    GET_PLAT_MEMMAP_CSR(sw)[addr + 1] = hi;
+    csr = GET_PLAT_MEMMAP_CSR(sw) + addr;
+
+    if ( CSR_WIDE_ACCESS(sw) && CSR_IS_ALIGNED64(csr) )
+    {
+        *(volatile fm_uint64 *) csr = value;
+    }
+    else
+    {
+        csr[0] = lo;
+        csr[1] = hi;
+    }
 
     DROP_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
@@ -459,8 +602,9 @@ fm_status fmPlatformReadCSRMult64(fm_int     sw,
                                   fm_int     n,
                                   fm_uint64 *value)
 {
-    fm_int    i;
-    fm_uint64 lo, hi;
+    volatile fm_uint32 *csr;
+    fm_int              i;
+    fm_uint64           lo, hi;
 
     CSR_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                   "sw = %d, addr = 0x%08x, n = %d, value = %p\n",
@@ -471,11 +615,23 @@ fm_status fmPlatformReadCSRMult64(fm_int     sw,
 
     TAKE_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
-    for (i = 0 ; i < n ; i++)
+    csr = GET_PLAT_MEMMAP_CSR(sw) + addr;
+
+    if ( CSR_WIDE_ACCESS(sw) && CSR_IS_ALIGNED64(csr) )
     {
-        lo = GET_PLAT_MEMMAP_CSR(sw)[addr + 0 + i*2];
-        hi = GET_PLAT_MEMMAP_CSR(sw)[addr + 1 + i*2];
-        value[i] = (hi << 32) | lo;
+        for (i = 0 ; i < n ; i++)
+        {
+            value[i] = *(volatile fm_uint64 *) (csr + i*2);
+        }
+    }
+    else
+    {
+        for (i = 0 ; i < n ; i++)
+        {
+            lo = csr[0 + i*2];
+            hi = csr[1 + i*2];
+            value[i] = (hi << 32) | lo;
+        }
     }
 
     DROP_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
@@ -512,8 +668,10 @@ fm_status fmPlatformWriteCSRMult64(fm_int     sw,
                                    fm_int     n,
                                    fm_uint64 *value)
 {
-    fm_int    i;
-    fm_uint32 lo, hi;
+    volatile fm_uint32 *csr;
+    fm_int              i;
+    fm_uint32           lo, hi;
+    fm_bool             wide;
 
     CSR_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                   "sw = %d, addr = 0x%08x, n = %d, value = %p\n",
@@ -529,6 +687,9 @@ fm_status fmPlatformWriteCSRMult64(fm_int     sw,
 
     TAKE_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
 
+    csr  = GET_PLAT_MEMMAP_CSR(sw) + addr;
+    wide = CSR_WIDE_ACCESS(sw) && CSR_IS_ALIGNED64(csr);
+
     for (i = 0 ; i < n ; i++)
     {
         lo = value[i];
@@ -537,8 +698,15 @@ fm_status fmPlatformWriteCSRMult64(fm_int     sw,
         INSTRUMENT_REG_WRITE(sw, addr + 0 + (i * 2), lo);
         INSTRUMENT_REG_WRITE(sw, addr + 1 + (i * 2), hi);
 
-        GET_PLAT_MEMMAP_CSR(sw)[addr + 0 + i*2] = lo;
-        GET_PLAT_MEMMAP_CSR(sw)[addr + 1 + i*2] = hi;
+        if (wide)
+        {
+            *(volatile fm_uint64 *) (csr + i*2) = value[i];
+        }
+        else
+        {
+            csr[0 + i*2] = lo;
+            csr[1 + i*2] = hi;
+        }
     }
 
     DROP_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
@@ -0,0 +1,1430 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_regs_access_sim.c
+ * Creation Date:   October 15, 2026
+ * Description:     Simulated register file used in place of the switch.
+ *
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+
+#include <fm_sdk_fm10000_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* The simulated register space spans the 64 MB register BAR */
+#define SIM_ADDR_BITS               24
+#define SIM_ADDR_SPACE              (1U << SIM_ADDR_BITS)
+
+/* Registers are stored in pages that are allocated on the first write.
+ * Registers that were never written read as zero. */
+#define SIM_PAGE_BITS               10
+#define SIM_PAGE_WORDS              (1U << SIM_PAGE_BITS)
+#define SIM_PAGE_MASK               (SIM_PAGE_WORDS - 1)
+#define SIM_NUM_PAGES               (SIM_ADDR_SPACE >> SIM_PAGE_BITS)
+
+/* Registers of the devices on the EPL (0) and PCIe (1) SBus rings */
+#define SIM_SBUS_NUM_RINGS          2
+#define SIM_SBUS_NUM_DEVICES        256
+#define SIM_SBUS_NUM_REGS           256
+#define SIM_SBUS_REG(ring, dev, reg)                                        \
+    ( ( ( (ring) * SIM_SBUS_NUM_DEVICES + (dev) ) * SIM_SBUS_NUM_REGS ) +   \
+      (reg) )
+
+/* SBus operations and result codes, as issued by fm10000_api_sbus.c */
+#define SIM_SBUS_OP_RESET           0x20
+#define SIM_SBUS_OP_WRITE           0x21
+#define SIM_SBUS_OP_READ            0x22
+#define SIM_SBUS_RESULT_RESET       0x0
+#define SIM_SBUS_RESULT_WRITE       0x1
+#define SIM_SBUS_RESULT_READ        0x4
+
+/* Value of VITAL_PRODUCT_DATA on an FM10000, see fm10000GetSwitchId */
+#define SIM_FM10000_VPD             0xAE21
+
+/* Mask of the MA_TCN FIFO head and tail pointers */
+#define SIM_TCN_PTR_MASK            (FM10000_MA_TCN_FIFO_ENTRIES - 1)
+
+/* Layout of the LANE_SAI_CFG registers across EPLs and lanes */
+#define SIM_SAI_EPL_STRIDE                                                  \
+    ( FM10000_LANE_SAI_CFG(1, 0, 0) - FM10000_LANE_SAI_CFG(0, 0, 0) )
+#define SIM_SAI_LANE_STRIDE                                                 \
+    ( FM10000_LANE_SAI_CFG(0, 1, 0) - FM10000_LANE_SAI_CFG(0, 0, 0) )
+
+typedef struct
+{
+    /* Serializes accesses to the register file */
+    fm_lock     lock;
+
+    /* Busy-wait applied once per access function call */
+    fm_uint     accessLatencyNsec;
+
+    /* Sparse register file, indexed by (address >> SIM_PAGE_BITS) */
+    fm_uint32 * pages[SIM_NUM_PAGES];
+
+    /* Number of pages allocated in the register file */
+    fm_int      numPages;
+
+    /* Registers behind the SBus controllers */
+    fm_uint32 * sbusRegs;
+
+    /* Number of register words read and written */
+    fm_uint64   numReads;
+    fm_uint64   numWrites;
+
+} fm_platSimState;
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+static fm_platSimState *simState[FM_MAX_NUM_SWITCHES];
+
+
+/*****************************************************************************
+ * Local function prototypes.
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** SimDelay
+ * \ingroup intPlatform
+ *
+ * \desc            Spins for the configured access latency. A sleep is
+ *                  not used because its granularity is far coarser than
+ *                  the bus latencies being modeled.
+ *
+ * \param[in]       state points to the simulation state of the switch.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+static void SimDelay(fm_platSimState *state)
+{
+    fm_uint64 start;
+
+    if (state->accessLatencyNsec == 0)
+    {
+        return;
+    }
+
+    start = fmGetMonotonicNsec();
+
+    while ( (fmGetMonotonicNsec() - start) < state->accessLatencyNsec )
+    {
+        /* spin */
+    }
+
+}   /* end SimDelay */
+
+
+
+
+/*****************************************************************************/
+/** SimGetReg
+ * \ingroup intPlatform
+ *
+ * \desc            Returns the value of a simulated register.
+ *
+ * \note            The caller must hold the simulation lock.
+ *
+ * \param[in]       state points to the simulation state of the switch.
+ *
+ * \param[in]       addr is the register address, which must be inside
+ *                  the simulated register space.
+ *
+ * \return          The register value.
+ *
+ *****************************************************************************/
+static fm_uint32 SimGetReg(fm_platSimState *state, fm_uint32 addr)
+{
+    fm_uint32 *page;
+
+    /* Read-only identification register */
+    if ( addr == FM10000_VITAL_PRODUCT_DATA() )
+    {
+        return SIM_FM10000_VPD;
+    }
+
+    page = state->pages[addr >> SIM_PAGE_BITS];
+
+    return (page != NULL) ? page[addr & SIM_PAGE_MASK] : 0;
+
+}   /* end SimGetReg */
+
+
+
+
+/*****************************************************************************/
+/** SimSetReg
+ * \ingroup intPlatform
+ *
+ * \desc            Stores the value of a simulated register, allocating
+ *                  its page if needed.
+ *
+ * \note            The caller must hold the simulation lock.
+ *
+ * \param[in]       state points to the simulation state of the switch.
+ *
+ * \param[in]       addr is the register address, which must be inside
+ *                  the simulated register space.
+ *
+ * \param[in]       value is the value to store.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if a page could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status SimSetReg(fm_platSimState *state,
+                           fm_uint32        addr,
+                           fm_uint32        value)
+{
+    fm_uint32 **page;
+
+    page = &state->pages[addr >> SIM_PAGE_BITS];
+
+    if (*page == NULL)
+    {
+        /* A zero write to an untouched page changes nothing */
+        if (value == 0)
+        {
+            return FM_OK;
+        }
+
+        *page = fmAlloc(SIM_PAGE_WORDS * sizeof(fm_uint32));
+        if (*page == NULL)
+        {
+            return FM_ERR_NO_MEM;
+        }
+
+        FM_MEMSET_S(*page,
+                    SIM_PAGE_WORDS * sizeof(fm_uint32),
+                    0,
+                    SIM_PAGE_WORDS * sizeof(fm_uint32));
+        state->numPages++;
+    }
+
+    (*page)[addr & SIM_PAGE_MASK] = value;
+
+    return FM_OK;
+
+}   /* end SimSetReg */
+
+
+
+
+
+/*****************************************************************************/
+/** SimSbusCommand
+ * \ingroup intPlatform
+ *
+ * \desc            Models an SBus controller after its COMMAND register has
+ *                  been written. The request completes at once: Busy reads
+ *                  back clear with the result code that
+ *                  fm10000_api_sbus.c expects, and a read loads the
+ *                  RESPONSE register.
+ *                                                                      \lb\lb
+ *                  A SPICO interrupt written to SerDes register 0x03 is
+ *                  reported as done by register 0x04, which returns the
+ *                  interrupt code as the result.
+ *
+ * \note            The caller must hold the simulation lock.
+ *
+ * \param[in]       state points to the simulation state of the switch.
+ *
+ * \param[in]       addr is the address of SBUS_EPL_COMMAND or
+ *                  SBUS_PCIE_COMMAND.
+ *
+ * \param[in]       value is the value written to the command register.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if a page could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status SimSbusCommand(fm_platSimState *state,
+                                fm_uint32        addr,
+                                fm_uint32        value)
+{
+    fm_status err;
+    fm_int    ring;
+    fm_uint32 reqAddr;
+    fm_uint32 respAddr;
+    fm_uint32 dev;
+    fm_uint32 reg;
+    fm_uint32 data;
+    fm_uint32 result;
+
+    if ( !FM_GET_BIT(value, FM10000_SBUS_EPL_COMMAND, Execute) )
+    {
+        return FM_OK;
+    }
+
+    /* SBUS_EPL_XXX and SBUS_PCIE_XXX have the same field format */
+    if ( addr == FM10000_SBUS_EPL_COMMAND() )
+    {
+        ring     = 0;
+        reqAddr  = FM10000_SBUS_EPL_REQUEST();
+        respAddr = FM10000_SBUS_EPL_RESPONSE();
+    }
+    else
+    {
+        ring     = 1;
+        reqAddr  = FM10000_SBUS_PCIE_REQUEST();
+        respAddr = FM10000_SBUS_PCIE_RESPONSE();
+    }
+
+    dev = FM_GET_FIELD(value, FM10000_SBUS_EPL_COMMAND, Address);
+    reg = FM_GET_FIELD(value, FM10000_SBUS_EPL_COMMAND, Register);
+    err = FM_OK;
+
+    switch ( FM_GET_FIELD(value, FM10000_SBUS_EPL_COMMAND, Op) )
+    {
+        case SIM_SBUS_OP_WRITE:
+            data = SimGetReg(state, reqAddr);
+            state->sbusRegs[SIM_SBUS_REG(ring, dev, reg)] = data;
+
+            if (reg == FM10000_SERDES_REG_03)
+            {
+                reg = FM10000_SERDES_REG_04;
+                state->sbusRegs[SIM_SBUS_REG(ring, dev, reg)] =
+                    (data >> 16) & 0xFFFF;
+            }
+            result = SIM_SBUS_RESULT_WRITE;
+            break;
+
+        case SIM_SBUS_OP_READ:
+            data   = state->sbusRegs[SIM_SBUS_REG(ring, dev, reg)];
+            err    = SimSetReg(state, respAddr, data);
+            result = SIM_SBUS_RESULT_READ;
+            break;
+
+        default:
+            result = SIM_SBUS_RESULT_RESET;
+            break;
+    }
+
+    if (err == FM_OK)
+    {
+        FM_SET_BIT(value, FM10000_SBUS_EPL_COMMAND, Execute, 0);
+        FM_SET_BIT(value, FM10000_SBUS_EPL_COMMAND, Busy, 0);
+        FM_SET_FIELD(value, FM10000_SBUS_EPL_COMMAND, ResultCode, result);
+
+        err = SimSetReg(state, addr, value);
+    }
+
+    return err;
+
+}   /* end SimSbusCommand */
+
+
+
+
+/*****************************************************************************/
+/** SimLaneSaiRequest
+ * \ingroup intPlatform
+ *
+ * \desc            Models the SerDes parallel interface of an EPL lane after
+ *                  the upper word of its LANE_SAI_CFG register has been
+ *                  written. A pending request completes at once:
+ *                  LANE_SAI_STATUS reports Complete, not Busy, with the
+ *                  interrupt code as the result.
+ *
+ * \note            The caller must hold the simulation lock.
+ *
+ * \param[in]       state points to the simulation state of the switch.
+ *
+ * \param[in]       addr is the address of the upper word of LANE_SAI_CFG.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if a page could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status SimLaneSaiRequest(fm_platSimState *state, fm_uint32 addr)
+{
+    fm_uint64 cfg;
+    fm_uint32 status;
+
+    cfg = ( (fm_uint64) SimGetReg(state, addr) << 32 ) |
+          SimGetReg(state, addr - 1);
+
+    if ( !FM_GET_BIT64(cfg, FM10000_LANE_SAI_CFG, Request) )
+    {
+        return FM_OK;
+    }
+
+    status = FM_GET_FIELD64(cfg, FM10000_LANE_SAI_CFG, Code) & 0xFFFF;
+    FM_SET_BIT(status, FM10000_LANE_SAI_STATUS, Complete, 1);
+
+    return SimSetReg(state,
+                     addr + FM10000_LANE_SAI_STATUS(0, 0) -
+                         FM10000_LANE_SAI_CFG(0, 0, 1),
+                     status);
+
+}   /* end SimLaneSaiRequest */
+
+
+
+
+/*****************************************************************************/
+/** SimPcieSerdesInterrupt
+ * \ingroup intPlatform
+ *
+ * \desc            Models a PCIe SerDes SPICO interrupt after the upper
+ *                  word of its PCIE_SERDES_CTRL register has been written.
+ *                  A pending interrupt completes at once: InProgess reads
+ *                  back clear and DataRead holds the interrupt code.
+ *
+ * \note            The caller must hold the simulation lock.
+ *
+ * \param[in]       state points to the simulation state of the switch.
+ *
+ * \param[in]       addr is the address of the upper word of
+ *                  PCIE_SERDES_CTRL.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if a page could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status SimPcieSerdesInterrupt(fm_platSimState *state, fm_uint32 addr)
+{
+    fm_status err;
+    fm_uint64 ctrl;
+    fm_uint64 code;
+
+    ctrl = ( (fm_uint64) SimGetReg(state, addr) << 32 ) |
+           SimGetReg(state, addr - 1);
+
+    if ( !FM_GET_BIT64(ctrl, FM10000_PCIE_SERDES_CTRL, Interrupt) )
+    {
+        return FM_OK;
+    }
+
+    code = FM_GET_FIELD64(ctrl, FM10000_PCIE_SERDES_CTRL, InterruptCode);
+
+    FM_SET_BIT64(ctrl, FM10000_PCIE_SERDES_CTRL, Interrupt, 0);
+    FM_SET_BIT64(ctrl, FM10000_PCIE_SERDES_CTRL, InProgess, 0);
+    FM_SET_FIELD64(ctrl, FM10000_PCIE_SERDES_CTRL, DataRead, code);
+
+    err = SimSetReg(state, addr - 1, (fm_uint32) ctrl);
+    if (err == FM_OK)
+    {
+        err = SimSetReg(state, addr, (fm_uint32) (ctrl >> 32));
+    }
+
+    return err;
+
+}   /* end SimPcieSerdesInterrupt */
+
+
+
+
+/*****************************************************************************/
+/** SimReadReg
+ * \ingroup intPlatform
+ *
+ * \desc            Reads a simulated register and runs the status model
+ *                  attached to it, if any.
+ *                                                                      \lb\lb
+ *                  MA_TCN_DEQUEUE returns the entry at the head of the
+ *                  MA_TCN_FIFO memory, with Valid set, or all zeroes if
+ *                  the FIFO is empty. Reading its last word pops the entry
+ *                  by advancing MA_TCN_PTR_HEAD.
+ *
+ * \note            The caller must hold the simulation lock.
+ *
+ * \param[in]       state points to the simulation state of the switch.
+ *
+ * \param[in]       addr is the register address, which must be inside
+ *                  the simulated register space.
+ *
+ * \param[out]      value points to caller-allocated storage where the
+ *                  register value is written.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if a page could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status SimReadReg(fm_platSimState *state,
+                            fm_uint32        addr,
+                            fm_uint32 *      value)
+{
+    fm_uint32 head;
+    fm_uint32 tail;
+    fm_uint32 word;
+
+    if ( addr < FM10000_MA_TCN_DEQUEUE(0) ||
+         addr > FM10000_MA_TCN_DEQUEUE(FM10000_MA_TCN_DEQUEUE_WIDTH - 1) )
+    {
+        *value = SimGetReg(state, addr);
+        return FM_OK;
+    }
+
+    head = SimGetReg(state, FM10000_MA_TCN_PTR_HEAD());
+    head = FM_GET_FIELD(head, FM10000_MA_TCN_PTR_HEAD, Head);
+    tail = SimGetReg(state, FM10000_MA_TCN_PTR_TAIL());
+    tail = FM_GET_FIELD(tail, FM10000_MA_TCN_PTR_TAIL, Tail);
+    word = addr - FM10000_MA_TCN_DEQUEUE(0);
+
+    if (head == tail)
+    {
+        *value = 0;
+        return FM_OK;
+    }
+
+    *value = SimGetReg(state, FM10000_MA_TCN_FIFO(head, word));
+
+    if ( word == (FM10000_MA_TCN_DEQUEUE_b_Valid / 32) )
+    {
+        *value |= 1U << (FM10000_MA_TCN_DEQUEUE_b_Valid % 32);
+    }
+
+    if ( word == (FM10000_MA_TCN_DEQUEUE_WIDTH - 1) )
+    {
+        head = (head + 1) & SIM_TCN_PTR_MASK;
+        word = 0;
+        FM_SET_FIELD(word, FM10000_MA_TCN_PTR_HEAD, Head, head);
+
+        return SimSetReg(state, FM10000_MA_TCN_PTR_HEAD(), word);
+    }
+
+    return FM_OK;
+
+}   /* end SimReadReg */
+
+
+
+
+/*****************************************************************************/
+/** SimWriteReg
+ * \ingroup intPlatform
+ *
+ * \desc            Writes a simulated register and runs the status model
+ *                  attached to it, if any.
+ *
+ * \note            The caller must hold the simulation lock.
+ *
+ * \param[in]       state points to the simulation state of the switch.
+ *
+ * \param[in]       addr is the register address, which must be inside
+ *                  the simulated register space.
+ *
+ * \param[in]       value is the value to write.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if a page could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status SimWriteReg(fm_platSimState *state,
+                             fm_uint32        addr,
+                             fm_uint32        value)
+{
+    fm_status err;
+    fm_uint32 offset;
+
+    err = SimSetReg(state, addr, value);
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    if ( addr == FM10000_SBUS_EPL_COMMAND() ||
+         addr == FM10000_SBUS_PCIE_COMMAND() )
+    {
+        return SimSbusCommand(state, addr, value);
+    }
+
+    /* Upper word of LANE_SAI_CFG[0..8][0..3] */
+    if ( addr >= FM10000_LANE_SAI_CFG(0, 0, 1) &&
+         addr <= FM10000_LANE_SAI_CFG(FM10000_LANE_SAI_CFG_ENTRIES_1 - 1,
+                                      FM10000_LANE_SAI_CFG_ENTRIES_0 - 1,
+                                      1) )
+    {
+        offset = (addr - FM10000_LANE_SAI_CFG(0, 0, 1)) % SIM_SAI_EPL_STRIDE;
+
+        if ( (offset % SIM_SAI_LANE_STRIDE) == 0 &&
+             (offset / SIM_SAI_LANE_STRIDE) < FM10000_LANE_SAI_CFG_ENTRIES_0 )
+        {
+            return SimLaneSaiRequest(state, addr);
+        }
+    }
+
+    /* Upper word of PCIE_SERDES_CTRL[0..7], in any PEP */
+    if ( addr >= FM10000_PCIE_PF_BASE &&
+         addr < FM10000_PCIE_PF_ADDR(FM10000_PCIE_PF_BASE, FM10000_NUM_PEPS) )
+    {
+        offset = ( (addr - FM10000_PCIE_PF_BASE) % FM10000_PCIE_PF_SIZE ) +
+                 FM10000_PCIE_PF_BASE;
+
+        if ( offset >= FM10000_PCIE_SERDES_CTRL(0, 1) &&
+             offset <= FM10000_PCIE_SERDES_CTRL(
+                           FM10000_PCIE_SERDES_CTRL_ENTRIES - 1, 1) &&
+             ( (offset - FM10000_PCIE_SERDES_CTRL(0, 1)) %
+               FM10000_PCIE_SERDES_CTRL_WIDTH ) == 0 )
+        {
+            return SimPcieSerdesInterrupt(state, addr);
+        }
+    }
+
+    return FM_OK;
+
+}   /* end SimWriteReg */
+
+
+
+
+/*****************************************************************************/
+/** SimAccess
+ * \ingroup intPlatform
+ *
+ * \desc            Reads or writes a block of consecutive simulated
+ *                  registers as one access: the latency is charged once.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr is the address of the first register.
+ *
+ * \param[in]       n is the number of 32-bit registers to access.
+ *
+ * \param[in,out]   value32 points to an array of n words holding the
+ *                  values to write or receiving the values read. Must be
+ *                  NULL if value64 is used.
+ *
+ * \param[in,out]   value64 points to an array of n / 2 64-bit values, the
+ *                  register at the lower address in the low half. May be
+ *                  NULL.
+ *
+ * \param[in]       write is TRUE to write the registers, FALSE to read them.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNINITIALIZED if the simulation was not
+ *                  initialized for this switch.
+ * \return          FM_ERR_INVALID_ARGUMENT if the block is outside the
+ *                  register space.
+ * \return          FM_ERR_NO_MEM if a page could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status SimAccess(fm_int     sw,
+                           fm_uint32  addr,
+                           fm_int     n,
+                           fm_uint32 *value32,
+                           fm_uint64 *value64,
+                           fm_bool    write)
+{
+    fm_platSimState *state;
+    fm_status        err;
+    fm_uint32        word;
+    fm_int           i;
+
+    if (sw < 0 || sw >= FM_MAX_NUM_SWITCHES || simState[sw] == NULL)
+    {
+        return FM_ERR_UNINITIALIZED;
+    }
+
+    if ( n < 0 || addr >= SIM_ADDR_SPACE ||
+         (fm_uint32) n > SIM_ADDR_SPACE - addr )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    state = simState[sw];
+    err   = FM_OK;
+
+    fmCaptureLock(&state->lock, FM_WAIT_FOREVER);
+
+    SimDelay(state);
+
+    for (i = 0 ; i < n && err == FM_OK ; i++)
+    {
+        if (write)
+        {
+            if (value64 != NULL)
+            {
+                word = (fm_uint32) ( value64[i / 2] >> ( (i & 1) * 32 ) );
+            }
+            else
+            {
+                word = value32[i];
+            }
+
+            err = SimWriteReg(state, addr + i, word);
+        }
+        else
+        {
+            err = SimReadReg(state, addr + i, &word);
+
+            if (value64 == NULL)
+            {
+                value32[i] = word;
+            }
+            else if ( (i & 1) == 0 )
+            {
+                value64[i / 2] = word;
+            }
+            else
+            {
+                value64[i / 2] |= (fm_uint64) word << 32;
+            }
+        }
+    }
+
+    if (write)
+    {
+        state->numWrites += i;
+    }
+    else
+    {
+        state->numReads += i;
+    }
+
+    fmReleaseLock(&state->lock);
+
+    return err;
+
+}   /* end SimAccess */
+
+
+
+
+/*****************************************************************************/
+/** SimSeedRegisters
+ * \ingroup intPlatform
+ *
+ * \desc            Loads the registers that describe a switch which has
+ *                  booted from its SPI flash: B0 silicon, PLLs locked and
+ *                  every PEP enabled and out of reset.
+ *
+ * \param[in]       state points to the simulation state of the switch.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if a page could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status SimSeedRegisters(fm_platSimState *state)
+{
+    fm_status err;
+    fm_uint32 rv;
+    fm_int    pep;
+
+    rv = 0;
+    FM_SET_FIELD(rv, FM10000_CHIP_VERSION, Version, FM10000_CHIP_VERSION_B0);
+    err = SimSetReg(state, FM10000_CHIP_VERSION(), rv);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+
+    /* The three PLL status registers share the PLL_PCIE_STAT layout */
+    rv = 0;
+    FM_SET_BIT(rv, FM10000_PLL_PCIE_STAT, PllLocked, 1);
+    err = SimSetReg(state, FM10000_PLL_PCIE_STAT(), rv);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+
+    err = SimSetReg(state, FM10000_PLL_EPL_STAT(), rv);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+
+    err = SimSetReg(state, FM10000_PLL_FABRIC_STAT(), rv);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+
+    rv = 0;
+    FM_SET_FIELD(rv,
+                 FM10000_DEVICE_CFG,
+                 PCIeEnable,
+                 ( (1 << FM10000_NUM_PEPS) - 1 ));
+    err = SimSetReg(state, FM10000_DEVICE_CFG(), rv);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+
+    rv = 0;
+    FM_SET_BIT(rv, FM10000_PCIE_IP, NotInReset, 1);
+
+    for (pep = 0 ; pep < FM10000_NUM_PEPS ; pep++)
+    {
+        err = SimSetReg(state,
+                        FM10000_PCIE_PF_ADDR(FM10000_PCIE_IP(), pep),
+                        rv);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+    }
+
+ABORT:
+    return err;
+
+}   /* end SimSeedRegisters */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+
+/*****************************************************************************/
+/** fmPlatformSimInit
+ * \ingroup intPlatform
+ *
+ * \desc            Creates the simulated register file of a switch, used
+ *                  when the register access mode is SIM. Calling it again
+ *                  only updates the access latency.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       accessLatencyNsec is the delay added to each register
+ *                  access function call, in nanoseconds.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if sw is out of range.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmPlatformSimInit(fm_int sw, fm_uint accessLatencyNsec)
+{
+    fm_platSimState *state;
+    fm_status        err;
+    fm_uint          sbusSize;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
+                 "sw = %d, accessLatencyNsec = %u\n",
+                 sw,
+                 accessLatencyNsec);
+
+    if (sw < 0 || sw >= FM_MAX_NUM_SWITCHES)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    if (simState[sw] != NULL)
+    {
+        simState[sw]->accessLatencyNsec = accessLatencyNsec;
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_OK);
+    }
+
+    state = fmAlloc(sizeof(fm_platSimState));
+    if (state == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_NO_MEM);
+    }
+
+    FM_CLEAR(*state);
+    state->accessLatencyNsec = accessLatencyNsec;
+
+    sbusSize = SIM_SBUS_NUM_RINGS * SIM_SBUS_NUM_DEVICES *
+               SIM_SBUS_NUM_REGS * sizeof(fm_uint32);
+
+    state->sbusRegs = fmAlloc(sbusSize);
+    if (state->sbusRegs == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+    }
+
+    FM_MEMSET_S(state->sbusRegs, sbusSize, 0, sbusSize);
+
+    err = fmCreateLock("Simulated Registers", &state->lock);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+
+    simState[sw] = state;
+
+    err = SimSeedRegisters(state);
+    if (err != FM_OK)
+    {
+        fmPlatformSimFree(sw);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
+
+ABORT:
+    if (state->sbusRegs != NULL)
+    {
+        fmFree(state->sbusRegs);
+    }
+    fmFree(state);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
+
+}   /* end fmPlatformSimInit */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformSimFree
+ * \ingroup intPlatform
+ *
+ * \desc            Releases the simulated register file of a switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if sw is out of range.
+ *
+ *****************************************************************************/
+fm_status fmPlatformSimFree(fm_int sw)
+{
+    fm_platSimState *state;
+    fm_int           i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM, "sw = %d\n", sw);
+
+    if (sw < 0 || sw >= FM_MAX_NUM_SWITCHES)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    state = simState[sw];
+    if (state == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_OK);
+    }
+
+    simState[sw] = NULL;
+
+    for (i = 0 ; i < (fm_int) SIM_NUM_PAGES ; i++)
+    {
+        if (state->pages[i] != NULL)
+        {
+            fmFree(state->pages[i]);
+        }
+    }
+
+    fmDeleteLock(&state->lock);
+    fmFree(state->sbusRegs);
+    fmFree(state);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_OK);
+
+}   /* end fmPlatformSimFree */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformSimGetStats
+ * \ingroup intPlatform
+ *
+ * \desc            Returns the activity of the simulated register file,
+ *                  for use by benchmarks.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      numReads points to storage where this function places
+ *                  the number of registers read.
+ *
+ * \param[out]      numWrites points to storage where this function places
+ *                  the number of registers written.
+ *
+ * \param[out]      numPages points to storage where this function places
+ *                  the number of register pages allocated.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNINITIALIZED if the simulation was not
+ *                  initialized for this switch.
+ *
+ *****************************************************************************/
+fm_status fmPlatformSimGetStats(fm_int     sw,
+                                fm_uint64 *numReads,
+                                fm_uint64 *numWrites,
+                                fm_int    *numPages)
+{
+    fm_platSimState *state;
+
+    if (sw < 0 || sw >= FM_MAX_NUM_SWITCHES || simState[sw] == NULL)
+    {
+        return FM_ERR_UNINITIALIZED;
+    }
+
+    state = simState[sw];
+
+    fmCaptureLock(&state->lock, FM_WAIT_FOREVER);
+
+    *numReads  = state->numReads;
+    *numWrites = state->numWrites;
+    *numPages  = state->numPages;
+
+    fmReleaseLock(&state->lock);
+
+    return FM_OK;
+
+}   /* end fmPlatformSimGetStats */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformSimReadCSR
+ * \ingroup intPlatform
+ *
+ * \desc            Read a CSR register.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr contains the CSR register address to read
+ *
+ * \param[out]      value points to storage where this function will place
+ *                  the read register value.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformSimReadCSR(fm_int sw, fm_uint32 addr, fm_uint32 *value)
+{
+    return SimAccess(sw, addr, 1, value, NULL, FALSE);
+
+}   /* end fmPlatformSimReadCSR */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformSimWriteCSR
+ * \ingroup intPlatform
+ *
+ * \desc            Write a CSR register.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr contains the CSR register address to read.
+ *
+ * \param[in]       value is the data value to write to the register.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformSimWriteCSR(fm_int sw, fm_uint32 addr, fm_uint32 value)
+{
+    return SimAccess(sw, addr, 1, &value, NULL, TRUE);
+
+}   /* end fmPlatformSimWriteCSR */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformSimMaskCSR
+ * \ingroup intPlatform
+ *
+ * \desc            Mask on or off the bits in a single 32-bit register.
+ *
+ * \note            This function is not called by the API directly, but by
+ *                  platform layer code that is commonly available to all
+ *                  platforms.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       reg is the word offset into the switch's register file.
+ *
+ * \param[in]       mask is the bit mask to turn on or off.
+ *
+ * \param[in]       on should be TRUE to set the masked bits in the register
+ *                   or FALSE to clear the masked bits in the register.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformSimMaskCSR(fm_int    sw,
+                               fm_uint   reg,
+                               fm_uint32 mask,
+                               fm_bool   on)
+{
+    fm_platSimState *state;
+    fm_status        err;
+    fm_uint32        value;
+
+    if (sw < 0 || sw >= FM_MAX_NUM_SWITCHES || simState[sw] == NULL)
+    {
+        return FM_ERR_UNINITIALIZED;
+    }
+
+    if (reg >= SIM_ADDR_SPACE)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    state = simState[sw];
+
+    fmCaptureLock(&state->lock, FM_WAIT_FOREVER);
+
+    SimDelay(state);
+
+    value = SimGetReg(state, reg);
+
+    if (on)
+    {
+        value |= mask;
+    }
+    else
+    {
+        value &= ~mask;
+    }
+
+    err = SimWriteReg(state, reg, value);
+
+    state->numReads++;
+    state->numWrites++;
+
+    fmReleaseLock(&state->lock);
+
+    return err;
+
+}   /* end fmPlatformSimMaskCSR */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformSimReadCSRMult
+ * \ingroup intPlatform
+ *
+ * \desc            Read multiple CSR registers.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr contains the starting CSR register address to read.
+ *
+ * \param[in]       n contains the number of consecutive register addresses
+ *                  to read.
+ *
+ * \param[out]      value points to an array to be filled in with
+ *                  the register data read. The array must be n elements in
+ *                  length.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformSimReadCSRMult(fm_int     sw,
+                                   fm_uint32  addr,
+                                   fm_int     n,
+                                   fm_uint32 *value)
+{
+    return SimAccess(sw, addr, n, value, NULL, FALSE);
+
+}   /* end fmPlatformSimReadCSRMult */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformSimWriteCSRMult
+ * \ingroup intPlatform
+ *
+ * \desc            Write multiple CSR registers.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr contains the starting CSR register address to write.
+ *
+ * \param[in]       n contains the number of consecutive register addresses
+ *                  to write.
+ *
+ * \param[in]       value points to an array of values to be written. The
+ *                  array must be n elements in length.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformSimWriteCSRMult(fm_int     sw,
+                                    fm_uint32  addr,
+                                    fm_int     n,
+                                    fm_uint32 *value)
+{
+    return SimAccess(sw, addr, n, value, NULL, TRUE);
+
+}   /* end fmPlatformSimWriteCSRMult */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformSimReadCSR64
+ * \ingroup intPlatform
+ *
+ * \desc            Read a 64-bit CSR register.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr contains the CSR register address to read.
+ *
+ * \param[out]      value points to storage where the 64-bit read data value
+ *                  will be stored by this function.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformSimReadCSR64(fm_int sw, fm_uint32 addr, fm_uint64 *value)
+{
+    return SimAccess(sw, addr, 2, NULL, value, FALSE);
+
+}   /* end fmPlatformSimReadCSR64 */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformSimWriteCSR64
+ * \ingroup intPlatform
+ *
+ * \desc            Writes a 64-bit CSR register.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr contains the CSR register address to write.
+ *
+ * \param[in]       value is the 64-bit data value to write.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformSimWriteCSR64(fm_int sw, fm_uint32 addr, fm_uint64 value)
+{
+    return SimAccess(sw, addr, 2, NULL, &value, TRUE);
+
+}   /* end fmPlatformSimWriteCSR64 */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformSimReadCSRMult64
+ * \ingroup intPlatform
+ *
+ * \desc            Read multiple 64-bit CSR registers.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr contains the starting CSR register address to read.
+ *
+ * \param[in]       n contains the number of register addresses to read.
+ *
+ * \param[out]      value points to an array of to be filled in with
+ *                  the 64-bit register data read. The array must be n elements
+ *                  in length.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformSimReadCSRMult64(fm_int     sw,
+                                     fm_uint32  addr,
+                                     fm_int     n,
+                                     fm_uint64 *value)
+{
+    return SimAccess(sw, addr, n * 2, NULL, value, FALSE);
+
+}   /* end fmPlatformSimReadCSRMult64 */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformSimWriteCSRMult64
+ * \ingroup intPlatform
+ *
+ * \desc            Write multiple 64-bit CSR registers.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr contains the starting CSR register address to write.
+ *
+ * \param[in]       n contains the number of register addresses to write.
+ *
+ * \param[in]       value points to an array of 64-bit values to write. The
+ *                  array must be n elements in length.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformSimWriteCSRMult64(fm_int     sw,
+                                      fm_uint32  addr,
+                                      fm_int     n,
+                                      fm_uint64 *value)
+{
+    return SimAccess(sw, addr, n * 2, NULL, value, TRUE);
+
+}   /* end fmPlatformSimWriteCSRMult64 */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformSimReadRawCSR
+ * \ingroup intPlatform
+ *
+ * \desc            Read a CSR register without taking the platform lock.
+ *                                                                      \lb\lb
+ *                  The caller must have taken the platform lock, or a write
+ *                  lock on the entire switch, prior to calling this function
+ *                  and is responsible for releasing the lock.
+ *                                                                      \lb\lb
+ *                  This function may be called multiple times consecutively
+ *                  for multiple word width registers since it is assumed that
+ *                  the caller has taken any locks necessary to assure
+ *                  atomicity.
+ *
+ * \note            Implementation of this function in the platform layer is
+ *                  optional. If not implemented, the calling function
+ *                  will automatically use the normal register read function,
+ *                  which will cause it to just execute much more slowly than
+ *                  if this "raw" function is implemented.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr contains the CSR register address to read
+ *
+ * \param[out]      value points to storage where this function will place
+ *                  the read register value.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformSimReadRawCSR(fm_int sw, fm_uint32 addr, fm_uint32 *value)
+{
+    return SimAccess(sw, addr, 1, value, NULL, FALSE);
+
+}   /* end fmPlatformSimReadRawCSR */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformSimWriteRawCSR
+ * \ingroup intPlatform
+ *
+ * \desc            Write a CSR register without taking the platform lock.
+ *                                                                      \lb\lb
+ *                  The caller must have taken the platform lock, or a write
+ *                  lock on the entire switch, prior to calling this function
+ *                  and is responsible for releasing the lock.
+ *                                                                      \lb\lb
+ *                  This function may be called multiple times consecutively
+ *                  for multiple word width registers since it is assumed that
+ *                  the caller has taken any locks necessary to assure
+ *                  atomicity.
+ *
+ * \note            Implementation of this function in the platform layer is
+ *                  optional. If not implemented, the calling function
+ *                  will automatically use the normal register write function,
+ *                  which will cause it to just execute much more slowly than
+ *                  if this "raw" function is implemented.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr contains the CSR register address to write.
+ *
+ * \param[in]       value is the data value to write to the register.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformSimWriteRawCSR(fm_int sw, fm_uint32 addr, fm_uint32 value)
+{
+    return SimAccess(sw, addr, 1, &value, NULL, TRUE);
+
+}   /* end fmPlatformSimWriteRawCSR */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformSimWriteRawCSRSeq
+ * \ingroup intPlatform
+ *
+ * \desc            Write a sequence of CSR register without taking the
+ *                  platform lock.
+ *                                                                      \lb\lb
+ *                  The caller must have taken the platform lock, or a write
+ *                  lock on the entire switch, prior to calling this function
+ *                  and is responsible for releasing the lock.
+ *
+ * \note            Implementation of this function in the platform layer is
+ *                  optional. If not implemented, the calling function
+ *                  will automatically use the normal register write function,
+ *                  which will cause it to just execute much more slowly than
+ *                  if this "raw" function is implemented.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       addr points to an array of register address to be written.
+ *                  The array must be n elements in length.
+ *
+ * \param[in]       value points to an array of values to be written. The
+ *                  array must be n elements in length.
+ *
+ * \param[in]       n contains the number of register addresses to write.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformSimWriteRawCSRSeq(fm_int     sw,
+                                      fm_uint32 *addr,
+                                      fm_uint32 *value,
+                                      fm_int     n)
+{
+    fm_status err;
+    fm_int    i;
+
+    err = FM_OK;
+
+    /* Scattered writes are separate accesses, each with its own latency */
+    for (i = 0 ; i < n && err == FM_OK ; i++)
+    {
+        err = SimAccess(sw, addr[i], 1, &value[i], NULL, TRUE);
+    }
+
+    return err;
+
+}   /* end fmPlatformSimWriteRawCSRSeq */
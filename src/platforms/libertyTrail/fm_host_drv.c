@@ -74,6 +74,9 @@
  * Local Variables
  *****************************************************************************/
 
+/* Notifier signalled on each host driver interrupt, process-local */
+static fm_int intrNotifyFd = -1;
+
 
 /*****************************************************************************
  * Local function prototypes.
@@ -2131,6 +2134,11 @@ fm_status fmPlatformHostDrvWaitForInterrupt(fm_int   sw,
         {
             *intrStatus = 1;
             status = FM_OK;
+
+            if (FM_ATOMIC_LOAD(&intrNotifyFd) >= 0)
+            {
+                fmSignalEventNotifier(intrNotifyFd);
+            }
         }
         else
         {
@@ -2181,6 +2189,64 @@ fm_status fmPlatformHostDrvWaitForInterrupt(fm_int   sw,
 
 
 
+/*****************************************************************************/
+/* fmPlatformHostDrvGetInterruptNotifyFd
+ * \ingroup platform
+ *
+ * \desc            Returns a file descriptor that becomes readable each time
+ *                  a host driver interrupt, such as for packet reception, is
+ *                  received by ''fmPlatformHostDrvWaitForInterrupt'', so that
+ *                  an application can poll for switch activity alongside
+ *                  its sockets. Reading 8 bytes from it clears it.
+ *                                                                      \lb\lb
+ *                  The file descriptor is only signalled by the interrupt
+ *                  handler of the calling process, and is shared by all
+ *                  switches. The same one is returned by each call.
+ *
+ * \param[out]      fd points to caller-provided storage into which the
+ *                  file descriptor is stored.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if fd is NULL.
+ * \return          FM_FAIL if the file descriptor could not be created.
+ *
+ *****************************************************************************/
+fm_status fmPlatformHostDrvGetInterruptNotifyFd(fm_int *fd)
+{
+    fm_status status;
+    fm_int    newFd;
+    fm_int    expected;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_INTR, "fd = %p\n", (void *) fd);
+
+    if (fd == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_INTR, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    if (FM_ATOMIC_LOAD(&intrNotifyFd) < 0)
+    {
+        status = fmCreateEventNotifier(&newFd);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_INTR, status);
+
+        expected = -1;
+
+        if ( !FM_ATOMIC_CAS(&intrNotifyFd, &expected, newFd) )
+        {
+            /* Another thread created it first */
+            fmDestroyEventNotifier(newFd);
+        }
+    }
+
+    *fd = FM_ATOMIC_LOAD(&intrNotifyFd);
+
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_INTR, FM_OK);
+
+}   /* end fmPlatformHostDrvGetInterruptNotifyFd */
+
+
+
+
 /*****************************************************************************/
 /* fmPlatformMmapUioDevice
  * \ingroup intPlatform
@@ -61,6 +61,25 @@
 
 #define SW_MEM_SIZE         0x04000000
 
+/* Host netdev packet backend, selected by api.platform.pktInterface. The
+ * rest of the stack only sees the SendPackets entry point installed in
+ * the switch structure and the events posted by the receive thread. */
+typedef struct _fm_platNetdevBackend
+{
+    /* Value of api.platform.pktInterface selecting this backend */
+    fm_text     name;
+
+    /* Opens the netdev and starts the receive thread */
+    fm_status (*Initialize)(fm_int sw, fm_bool hasFcs, fm_text iface);
+
+    /* Releases the netdev once the receive thread has exited */
+    fm_status (*Destroy)(fm_int sw);
+
+    /* Drains the switch TX queue */
+    fm_status (*SendPackets)(fm_int sw);
+
+} fm_platNetdevBackend;
+
 
 /*****************************************************************************
  * Global Variables
@@ -81,6 +100,25 @@ static void **desiredMemmapAddr;
 
 static fm_bool masterInstance = FALSE;
 
+/* The first entry is the default backend */
+static const fm_platNetdevBackend netdevBackends[] =
+{
+    { "raw",
+      fmRawPacketSocketHandlingInitialize,
+      fmRawPacketSocketDestroy,
+      fmRawPacketSocketSendPackets },
+
+    { "tpacket",
+      fmTpacketHandlingInitialize,
+      fmTpacketDestroy,
+      fmTpacketSendPackets },
+
+    { "xdp",
+      fmXdpHandlingInitialize,
+      fmXdpDestroy,
+      fmXdpSendPackets },
+};
+
 /*****************************************************************************
  * Local function prototypes.
  *****************************************************************************/
@@ -91,6 +129,46 @@ static fm_bool masterInstance = FALSE;
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/* GetNetdevBackend
+ *
+ * \desc            Returns the host netdev packet backend used by the
+ *                  switch. This is the backend initialized for the switch
+ *                  if any, otherwise the one selected by the
+ *                  api.platform.pktInterface property. The raw packet
+ *                  socket is used for unknown values and for interfaces
+ *                  that do not go through the netdev, such as PTI.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          Pointer to the backend descriptor.
+ *
+ *****************************************************************************/
+static const fm_platNetdevBackend *GetNetdevBackend(fm_int sw)
+{
+    fm_uint i;
+
+    if (GET_PLAT_PROC_STATE(sw)->netdevBackend != NULL)
+    {
+        return GET_PLAT_PROC_STATE(sw)->netdevBackend;
+    }
+
+    for (i = 0 ; i < FM_NENTRIES(netdevBackends) ; i++)
+    {
+        if (strcmp(GET_PROPERTY()->pktInterface, netdevBackends[i].name) == 0)
+        {
+            return &netdevBackends[i];
+        }
+    }
+
+    return &netdevBackends[0];
+
+}   /* end GetNetdevBackend */
+
+
+
+
+
 /*****************************************************************************/
 /* RoundUp
  *
@@ -480,7 +558,7 @@ static fm_status DisconnectFromPCIE(fm_int sw)
 /*****************************************************************************/
 /* SetRegAccessMode
  *
- * \desc            Set the register access mode (EBI/PCIe/I2C)
+ * \desc            Set the register access mode (EBI/PCIe/I2C/SIM)
  *
  * \param[in]       sw is the switch number on which to operate.
  *
@@ -558,6 +636,23 @@ static fm_status SetRegAccessMode(fm_int sw, fm_int mode)
             switchPtr->ReadIngressFid    = fmPlatformEbiReadCSR64;
             break;
 
+        case FM_PLAT_REG_ACCESS_SIM:
+            switchPtr->WriteUINT32       = fmPlatformSimWriteCSR;
+            switchPtr->ReadUINT32        = fmPlatformSimReadCSR;
+            switchPtr->MaskUINT32        = fmPlatformSimMaskCSR;
+            switchPtr->WriteUINT32Mult   = fmPlatformSimWriteCSRMult;
+            switchPtr->ReadUINT32Mult    = fmPlatformSimReadCSRMult;
+            switchPtr->WriteUINT64       = fmPlatformSimWriteCSR64;
+            switchPtr->ReadUINT64        = fmPlatformSimReadCSR64;
+            switchPtr->WriteUINT64Mult   = fmPlatformSimWriteCSRMult64;
+            switchPtr->ReadUINT64Mult    = fmPlatformSimReadCSRMult64;
+            switchPtr->WriteRawUINT32    = fmPlatformSimWriteRawCSR;
+            switchPtr->WriteRawUINT32Seq = fmPlatformSimWriteRawCSRSeq;
+            switchPtr->ReadRawUINT32     = fmPlatformSimReadRawCSR;
+            switchPtr->ReadEgressFid     = fmPlatformSimReadCSR;
+            switchPtr->ReadIngressFid    = fmPlatformSimReadCSR64;
+            break;
+
         default:
             status = FM_ERR_INVALID_ARGUMENT;
             break;
@@ -971,7 +1066,7 @@ static void NotifyInterrupt(fm_int sw, fm_uint intrStatus, fm_text msg)
     FM_LOG_DEBUG(FM_LOG_CAT_EVENT_INTR,
                   "Signaling semaphore\n");
 
-    fmSignalSemaphore(&fmRootApi->intrAvail);
+    fmSignalSemaphore(FM_INTR_AVAIL_SEM(sw));
 
 }   /* end NotifyInterrupt */
 
@@ -1347,6 +1442,58 @@ static fm_status LoadPropertiesFromFile(fm_text fileName)
 
 
 
+/*****************************************************************************/
+/** LoadPlatformConfigFile
+ * \ingroup intPlatform
+ *
+ * \desc            Loads the text platform configuration file. When the
+ *                  FM_LIBERTY_TRAIL_CONFIG_IMAGE environment variable names
+ *                  a configuration image, the image is loaded instead, and
+ *                  compiled again from the text file first if it is missing
+ *                  or out of date.
+ *
+ * \param[in]       fileName is the full path to a text file to load.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status LoadPlatformConfigFile(fm_text fileName)
+{
+    fm_status status;
+    fm_text   imageName;
+
+    imageName = getenv("FM_LIBERTY_TRAIL_CONFIG_IMAGE");
+
+    if (imageName == NULL || strlen(imageName) == 0)
+    {
+        return LoadPropertiesFromFile(fileName);
+    }
+
+    status = fmPlatformLoadConfigImage(imageName, fileName);
+
+    if (status != FM_OK)
+    {
+        status = fmPlatformCompileConfigImage(fileName, imageName);
+
+        if (status == FM_OK)
+        {
+            status = fmPlatformLoadConfigImage(imageName, fileName);
+        }
+    }
+
+    if (status != FM_OK)
+    {
+        status = LoadPropertiesFromFile(fileName);
+    }
+
+    return status;
+
+}   /* end LoadPlatformConfigFile */
+
+
+
+
+
 /*****************************************************************************/
 /* fmPlatformRootInit
  *
@@ -1372,7 +1519,6 @@ static fm_status fmPlatformRootInit(void)
     fm_int                i;
     fm_int                size;
     fm_char               objName[40];
-    fm_voidptr            packetBufferPool;
     fm_text               attrFile;
     fm_text               attrFile2;
     fm_char               nvmHeaderName[FM_UIO_MAX_NAME_SIZE];
@@ -1467,7 +1613,7 @@ static fm_status fmPlatformRootInit(void)
             }
             else
             {
-                status = LoadPropertiesFromFile(attrFile);
+                status = LoadPlatformConfigFile(attrFile);
             }
         }
     }
@@ -1477,7 +1623,7 @@ static fm_status fmPlatformRootInit(void)
         attrFile = "fm_platform_attributes.cfg";
         FM_LOG_PRINT("Loading %s\n", attrFile);
 
-        status = LoadPropertiesFromFile(attrFile);
+        status = LoadPlatformConfigFile(attrFile);
 
         if (status)
         {
@@ -1487,7 +1633,7 @@ static fm_status fmPlatformRootInit(void)
                         "Unable to load file '%s'. Trying '%s'.\n",
                         attrFile,
                         attrFile2);
-            status = LoadPropertiesFromFile(attrFile2);
+            status = LoadPlatformConfigFile(attrFile2);
         }
     }
 
@@ -1520,15 +1666,8 @@ static fm_status fmPlatformRootInit(void)
 
     memset(fmRootPlatform->platformState, 0, size);
 
-    /* Allocate and initialize buffer memory */
-    packetBufferPool = fmAlloc(FM_BUFFER_SIZE_BYTES * FM_NUM_BUFFERS);
-
-    if (packetBufferPool == NULL)
-    {
-        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_NO_MEM);
-    }
-
-    status = fmPlatformInitBuffers(packetBufferPool);
+    /* Allocate and initialize buffer memory, sized from the properties */
+    status = fmPlatformInitBuffersV3(NULL, 0);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
 
     /* Init per process data for first process here */
@@ -1857,6 +1996,7 @@ fm_status fmPlatformSwitchPreInsert(fm_int sw)
     fm_registerWriteUINT32Func writeFunc;
     fm_bool                    swIsr;
     fm_uint32                  pcieIsrMask;
+    const fm_platNetdevBackend *backend;
 #endif
 
     FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM, "sw = %d\n", sw);
@@ -1945,6 +2085,18 @@ fm_status fmPlatformSwitchPreInsert(fm_int sw)
             writeFunc = fmPlatformI2cWriteCSR;
             break;
 
+        case FM_PLAT_REG_ACCESS_SIM:
+            FM_LOG_DEBUG(FM_LOG_CAT_PLATFORM,
+                         "Register access mode set to SIM\n");
+
+            /* No device is opened, the registers live in host memory */
+            status = fmPlatformSimInit(sw, swCfg->simAccessLatencyNsec);
+            FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+
+            readFunc  = fmPlatformSimReadRawCSR;
+            writeFunc = fmPlatformSimWriteRawCSR;
+            break;
+
         default:
             FM_LOG_FATAL(FM_LOG_CAT_PLATFORM,
                          "Invalid reg access mode provided by property %s\n",
@@ -1978,9 +2130,27 @@ fm_status fmPlatformSwitchPreInsert(fm_int sw)
     /* Default net dev is not set */
     if (strcmp(swCfg->netDevName, FM_AAD_API_PLATFORM_NETDEV_NAME) != 0)
     {
-        status = fmRawPacketSocketHandlingInitialize(sw,
-                                                     FALSE,
-                                                     swCfg->netDevName);
+        backend = GetNetdevBackend(sw);
+        status  = backend->Initialize(sw, FALSE, swCfg->netDevName);
+
+        if (status != FM_OK && backend != &netdevBackends[0])
+        {
+            FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                           "Could not initialize %s packet interface for "
+                           "sw=%d (%s), falling back to %s\n",
+                           backend->name,
+                           sw,
+                           fmErrorMsg(status),
+                           netdevBackends[0].name);
+
+            backend = &netdevBackends[0];
+            status  = backend->Initialize(sw, FALSE, swCfg->netDevName);
+        }
+
+        if (status == FM_OK)
+        {
+            GET_PLAT_PROC_STATE(sw)->netdevBackend = backend;
+        }
     }
 
     if (status != FM_OK)
@@ -2055,7 +2225,10 @@ fm_status fmPlatformSwitchInsert(fm_int sw)
     fm_status                  status = FM_OK;
 
     FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM, "sw = %d\n", sw);
-    
+
+    /* The bring-up timeline starts with the insertion */
+    fmDbgBootPhaseStart(sw);
+
     /* Generate the switch inserted event for this switch. */
     status = fmPlatformSendSwitchEvent(sw, FM_EVENT_SWITCH_INSERTED);
 
@@ -2139,7 +2312,7 @@ fm_status fmPlatformSwitchInitialize(fm_int sw)
             }
             else
             {
-                switchPtr->SendPackets   = fmRawPacketSocketSendPackets;
+                switchPtr->SendPackets   = GetNetdevBackend(sw)->SendPackets;
                 if ((GET_PLAT_RAW_LISTENER(sw))->handle)
                 {
                     switchPtr->isRawSocketInitialized = FM_ENABLED;
@@ -2462,6 +2635,9 @@ fm_status fmPlatformSwitchPostInitialize(fm_int sw)
 
     fmPlatformMgmtEnableInterrupt(sw);
 
+    /* Start the LED polling */
+    fmPlatformLedStart(sw);
+
     /* make sure the interrupts are enabled */
     fmPlatformEnableInterrupt(sw, FM_INTERRUPT_SOURCE_ISR);
     
@@ -3307,7 +3483,7 @@ void *fmPlatformInterruptListener(void *args)
             FM_LOG_DEBUG(FM_LOG_CAT_EVENT_INTR,
                          "Signaling semaphore\n");
 
-            fmSignalSemaphore(&fmRootApi->intrAvail);
+            fmSignalSemaphore(FM_INTR_AVAIL_SEM(ps->sw));
         }
 
 #if 0
@@ -3366,7 +3542,7 @@ fm_status fmPlatformTriggerInterrupt(fm_int sw, fm_uint intrTypes)
         FM_LOG_DEBUG(FM_LOG_CAT_EVENT,
                      "fmPlatformTriggerInterrupt: signaling semaphore\n");
 
-        fmSignalSemaphore(&fmRootApi->intrAvail);
+        fmSignalSemaphore(FM_INTR_AVAIL_SEM(sw));
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_OK);
@@ -3466,9 +3642,11 @@ fm_status fmPlatformSwitchTerminate(fm_int sw)
         fmWaitThreadExit(&GET_PLAT_PROC_STATE(sw)->rawsocketThread);
     }
 
-    status = fmRawPacketSocketDestroy(sw);
+    status = GetNetdevBackend(sw)->Destroy(sw);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
 
+    GET_PLAT_PROC_STATE(sw)->netdevBackend = NULL;
+
     /* interrupt thread should terminate when switch state == NULL */
     if ((GET_PLAT_INTR_LISTENER(sw))->handle)
     {
@@ -3487,6 +3665,11 @@ fm_status fmPlatformSwitchTerminate(fm_int sw)
         status = DisconnectFromPCIE(sw);
         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
     }
+    else if (swCfg->regAccess == FM_PLAT_REG_ACCESS_SIM)
+    {
+        status = fmPlatformSimFree(sw);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+    }
 #endif
 
     FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_OK);
@@ -3576,6 +3759,9 @@ fm_status fmPlatformReceiveProcessV2(fm_int              sw,
                                      fm_uint32 *         pIslTag,
                                      fm_pktSideBandData *sbData)
 {
+    /* Reception time, for the receive latency probe */
+    buffer->rxCycles = FM_GET_CYCLES();
+
     switch (GET_PLAT_STATE(sw)->family)
     {
         case FM_SWITCH_FAMILY_FM10000:
@@ -3800,11 +3986,21 @@ fm_status fmPlatformSetRegAccessMode(fm_int sw, fm_int mode)
             /* break; let's go through */
         case FM_PLAT_REG_ACCESS_I2C:
         case FM_PLAT_REG_ACCESS_EBI:
+        case FM_PLAT_REG_ACCESS_SIM:
+            swCfg = FM_PLAT_GET_SWITCH_CFG(sw);
+
+            if (mode == FM_PLAT_REG_ACCESS_SIM)
+            {
+                status = fmPlatformSimInit(sw,
+                                           (swCfg != NULL) ?
+                                           swCfg->simAccessLatencyNsec : 0);
+                FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+            }
+
             /* No need to check the returned status as it can be != FM_OK
                if the switch doesn't exist yet. */
             SetRegAccessMode(sw,mode);
 
-            swCfg = FM_PLAT_GET_SWITCH_CFG(sw);
             if (swCfg != NULL)
             {
                 swCfg->regAccess = mode;
@@ -3861,6 +4057,42 @@ fm_status fmPlatformSetInterruptPollingPeriod(fm_int sw, fm_int periodMsec)
 
 
 
+/*****************************************************************************/
+/* fmPlatformGetInterruptNotifyFd
+ * \ingroup platformApp
+ *
+ * \desc            Get a file descriptor that becomes readable each time
+ *                  a host driver interrupt, such as for packet reception,
+ *                  is received, so that an application can wait for switch
+ *                  activity in its own poll or epoll loop. Reading 8 bytes
+ *                  from it clears it.
+ *                                                                      \lb\lb
+ *                  Only switches accessed over PCIe signal it, and it is
+ *                  shared by all switches of the process.
+ *
+ * \param[out]      fd points to caller-allocated storage where this
+ *                  function should place the file descriptor.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if fd is NULL.
+ * \return          FM_FAIL if the file descriptor could not be created.
+ *
+ *****************************************************************************/
+fm_status fmPlatformGetInterruptNotifyFd(fm_int *fd)
+{
+    fm_status status;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM, "fd=%p\n", (void *) fd);
+
+    status = fmPlatformHostDrvGetInterruptNotifyFd(fd);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, status);
+
+}   /* end fmPlatformGetInterruptNotifyFd */
+
+
+
+
 fm_status fmPlatformReadUnlockCSR(fm_int sw, fm_uint32 addr, fm_uint32 *value)
 {
     fm_switch *switchPtr;
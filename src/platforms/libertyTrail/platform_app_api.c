@@ -59,6 +59,600 @@
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/** XcvrMemRead
+ * \ingroup intPlatform
+ *
+ * \desc            Reads bytes from an SFP+/QSFP module on a given port.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       port is the logical port number.
+ *
+ * \param[in]       page is the page number.
+ *
+ * \param[in]       offset is the offset from start of page.
+ *
+ * \param[out]      data points to an array where this function will store
+ *                  the 8-bit data values read from the device. The array must
+ *                  be length bytes long.
+ *
+ * \param[in]       length is the number of data bytes to read.
+ *
+ * \param[in]       takeLocks is FALSE if the caller already serializes the
+ *                  accesses to the transceiver's I2C bus.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status XcvrMemRead(fm_int   sw,
+                             fm_int   port,
+                             fm_int   page,
+                             fm_int   offset,
+                             fm_byte *data,
+                             fm_int   length,
+                             fm_bool  takeLocks)
+{
+    fm_status           status;
+    fm_int              address;
+    fm_int              swNum;
+    fm_uint32           hwResId;
+    fm_bool             qsfp;
+    fm_platformCfgPort *portCfg;
+    fm_platformLib     *libFunc;
+    fm_byte             bytes[2];
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
+                 "sw = %d, port = %d, page = %d, offset = %d length = %d\n",
+                 sw,
+                 port,
+                 page,
+                 offset,
+                 length);
+
+    libFunc = FM_PLAT_GET_LIB_FUNCS_PTR(sw);
+
+    if ( !libFunc->I2cWriteRead )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_UNSUPPORTED);
+    }
+
+    status = fmPlatformMapLogicalPortToPlatform(sw,
+                                                port,
+                                                &sw,
+                                                &swNum,
+                                                &hwResId,
+                                                &portCfg);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+
+    switch (portCfg->intfType)
+    {
+        case FM_PLAT_INTF_TYPE_QSFP_LANE0:
+        case FM_PLAT_INTF_TYPE_QSFP_LANE1:
+        case FM_PLAT_INTF_TYPE_QSFP_LANE2:
+        case FM_PLAT_INTF_TYPE_QSFP_LANE3:
+            qsfp = TRUE;
+            break;
+
+        case FM_PLAT_INTF_TYPE_SFPP:
+            qsfp = FALSE;
+            break;
+
+        default:
+            FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_UNSUPPORTED);
+            break;
+    }   /* switch */
+
+    if (takeLocks)
+    {
+        if ((status = fmPlatformMgmtTakeSwitchLock(sw)) != FM_OK)
+        {
+             FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, status);
+        }
+        TAKE_PLAT_I2C_BUS_LOCK(sw);
+    }
+
+    if ( libFunc->SelectBus )
+    {
+        status = libFunc->SelectBus(swNum, FM_PLAT_BUS_XCVR_EEPROM, hwResId);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+    }
+
+    address = 0x50;
+
+    /* Set I2C address corresponding to page number */
+    if (qsfp)
+    {
+        if (page > 3)
+        {
+            status = FM_ERR_INVALID_ARGUMENT;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+        }
+
+        if ( (offset + length) > 128 && page >= 0 )
+        {
+            /* Refer to SFF-8436 */
+            bytes[0] = 127;
+            bytes[1] = page;
+            status   = libFunc->I2cWriteRead(swNum, address, bytes, 2, 0);
+
+            if (status == FM_OK)
+            {
+                /* For some modules, such as Aphenol 566570001, need a delay here */
+                fmDelay(0, 20 * 1000 * 1000);
+            }
+            else
+            {
+                /* For some modules, such as the Molex/74757-1031, the write to
+                   the page register doesn't work.
+                 
+                   In that case do not return an error and most likely page 0
+                   will be selected and the read to Upper Memory Map: Page 0
+                   will work. */
+            }
+        }
+    }
+    else
+    {
+        if (page > 1)
+        {
+            status = FM_ERR_INVALID_ARGUMENT;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+        }
+
+        if (page)
+        {
+            address = 0x51;
+        }
+    }
+
+    /* Write the offset to be read from. */
+    data[0] = offset & 0xFF;
+
+    status = libFunc->I2cWriteRead(swNum, address, data, 1, length);
+
+ABORT:
+    if (takeLocks)
+    {
+        DROP_PLAT_I2C_BUS_LOCK(sw);
+        fmPlatformMgmtDropSwitchLock(sw);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, status);
+
+}   /* end XcvrMemRead */
+
+
+
+
+/*****************************************************************************/
+/** GetXcvrInfo
+ * \ingroup intPlatform
+ *
+ * \desc            Returns the transceiver info structure of the module
+ *                  plugged on a given port. All the lanes of a QSFP module
+ *                  share the info structure of the lane 0 port.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       portCfg points to the port configuration.
+ *
+ * \return          Pointer to the transceiver info structure, or NULL if
+ *                  the port is not found.
+ *
+ *****************************************************************************/
+static fm_platXcvrInfo *GetXcvrInfo(fm_int sw, fm_platformCfgPort *portCfg)
+{
+    fm_int portIdx;
+
+    switch (portCfg->intfType)
+    {
+        case FM_PLAT_INTF_TYPE_QSFP_LANE1:
+        case FM_PLAT_INTF_TYPE_QSFP_LANE2:
+        case FM_PLAT_INTF_TYPE_QSFP_LANE3:
+            portIdx =
+               FM_PLAT_GET_SWITCH_CFG(sw)->epls[portCfg->epl].laneToPortIdx[0];
+            break;
+
+        default:
+            portIdx = fmPlatformCfgPortGetIndex(sw, portCfg->port);
+            break;
+    }
+
+    if (portIdx < 0)
+    {
+        return NULL;
+    }
+
+    return &GET_PLAT_STATE(sw)->xcvrInfo[portIdx];
+
+}   /* end GetXcvrInfo */
+
+
+
+
+/*****************************************************************************/
+/** GetXcvrCacheBlock
+ * \ingroup intPlatform
+ *
+ * \desc            Returns the page cache block holding a given byte of the
+ *                  module memory.
+ *
+ * \param[in]       qsfp is TRUE for a QSFP module, FALSE for an SFP+ module.
+ *
+ * \param[in]       page is the page number, as given to ''XcvrMemRead''.
+ *
+ * \param[in]       offset is the offset from start of page.
+ *
+ * \param[out]      dom points to caller-allocated storage where this
+ *                  function places TRUE if the block holds diagnostic
+ *                  monitoring values that change over time.
+ *
+ * \return          The block index, or -1 if the byte is not cached.
+ *
+ *****************************************************************************/
+static fm_int GetXcvrCacheBlock(fm_bool  qsfp,
+                                fm_int   page,
+                                fm_int   offset,
+                                fm_bool *dom)
+{
+    *dom = FALSE;
+
+    if (offset < 0 || offset >= 2 * XCVR_PAGE_CACHE_BLOCK_SIZE)
+    {
+        return -1;
+    }
+
+    if (qsfp)
+    {
+        /* The lower page does not depend on the selected page, but the
+         * upper page is only known when the page is selected (SFF-8436) */
+        if (offset < XCVR_PAGE_CACHE_BLOCK_SIZE)
+        {
+            *dom = TRUE;
+            return 0;
+        }
+
+        return (page >= 0 && page <= 3) ? (1 + page) : -1;
+    }
+
+    if (page < 0 || page > 1)
+    {
+        return -1;
+    }
+
+    /* A2h bytes 96-127 hold the real time diagnostics (SFF-8472) */
+    *dom = (page == 1 && offset < XCVR_PAGE_CACHE_BLOCK_SIZE);
+
+    return (page * 2) + (offset / XCVR_PAGE_CACHE_BLOCK_SIZE);
+
+}   /* end GetXcvrCacheBlock */
+
+
+
+
+/*****************************************************************************/
+/** XcvrCachedMemRead
+ * \ingroup intPlatform
+ *
+ * \desc            Reads bytes from an SFP+/QSFP module on a given port,
+ *                  through the port's page cache. A missing or expired
+ *                  block is read whole from the module, so that a single
+ *                  I2C block transfer sequence serves the subsequent reads
+ *                  of any byte in the block.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       port is the logical port number.
+ *
+ * \param[in]       page is the page number.
+ *
+ * \param[in]       offset is the offset from start of page.
+ *
+ * \param[out]      data points to an array where this function will store
+ *                  the 8-bit data values read from the device. The array must
+ *                  be length bytes long.
+ *
+ * \param[in]       length is the number of data bytes to read.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status XcvrCachedMemRead(fm_int   sw,
+                                   fm_int   port,
+                                   fm_int   page,
+                                   fm_int   offset,
+                                   fm_byte *data,
+                                   fm_int   length)
+{
+    fm_status             status;
+    fm_int                swNum;
+    fm_int                phySw;
+    fm_int                blk;
+    fm_int                base;
+    fm_int                segLen;
+    fm_uint32             hwResId;
+    fm_uint64             now;
+    fm_uint64             maxAge;
+    fm_bool               qsfp;
+    fm_bool               dom;
+    fm_platformCfgPort *  portCfg;
+    fm_platXcvrInfo *     xcvrInfo;
+    fm_platXcvrPageBlock *cache;
+
+    if ( length <= 0 ||
+         offset < 0 ||
+         (offset + length) > 2 * XCVR_PAGE_CACHE_BLOCK_SIZE )
+    {
+        return XcvrMemRead(sw, port, page, offset, data, length, TRUE);
+    }
+
+    status = fmPlatformMapLogicalPortToPlatform(sw,
+                                                port,
+                                                &phySw,
+                                                &swNum,
+                                                &hwResId,
+                                                &portCfg);
+    if (status != FM_OK)
+    {
+        return status;
+    }
+
+    switch (portCfg->intfType)
+    {
+        case FM_PLAT_INTF_TYPE_QSFP_LANE0:
+        case FM_PLAT_INTF_TYPE_QSFP_LANE1:
+        case FM_PLAT_INTF_TYPE_QSFP_LANE2:
+        case FM_PLAT_INTF_TYPE_QSFP_LANE3:
+            qsfp = TRUE;
+            break;
+
+        case FM_PLAT_INTF_TYPE_SFPP:
+            qsfp = FALSE;
+            break;
+
+        default:
+            return FM_ERR_UNSUPPORTED;
+    }   /* switch */
+
+    xcvrInfo = GetXcvrInfo(phySw, portCfg);
+
+    if (xcvrInfo == NULL)
+    {
+        return XcvrMemRead(sw, port, page, offset, data, length, TRUE);
+    }
+
+    maxAge = (fm_uint64) FM_PLAT_GET_SWITCH_CFG(phySw)->xcvrDomRefreshMsec *
+             1000000;
+
+    if ((status = fmPlatformMgmtTakeSwitchLock(phySw)) != FM_OK)
+    {
+        return status;
+    }
+    TAKE_PLAT_I2C_BUS_LOCK(phySw);
+
+    while (length > 0)
+    {
+        base   = offset - (offset % XCVR_PAGE_CACHE_BLOCK_SIZE);
+        segLen = base + XCVR_PAGE_CACHE_BLOCK_SIZE - offset;
+
+        if (segLen > length)
+        {
+            segLen = length;
+        }
+
+        blk = GetXcvrCacheBlock(qsfp, page, offset, &dom);
+
+        if ( blk < 0 || (dom && maxAge == 0) )
+        {
+            status = XcvrMemRead(sw, port, page, offset, data, segLen, FALSE);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+        }
+        else
+        {
+            cache = &xcvrInfo->pageCache[blk];
+            now   = fmGetMonotonicNsec();
+
+            if ( !cache->valid || (dom && (now - cache->readTime) >= maxAge) )
+            {
+                cache->valid = FALSE;
+
+                status = XcvrMemRead(sw,
+                                     port,
+                                     page,
+                                     base,
+                                     cache->data,
+                                     XCVR_PAGE_CACHE_BLOCK_SIZE,
+                                     FALSE);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+
+                cache->valid    = TRUE;
+                cache->readTime = now;
+            }
+
+            FM_MEMCPY_S(data,
+                        segLen,
+                        &cache->data[offset - base],
+                        segLen);
+        }
+
+        data   += segLen;
+        offset += segLen;
+        length -= segLen;
+    }
+
+ABORT:
+    DROP_PLAT_I2C_BUS_LOCK(phySw);
+    fmPlatformMgmtDropSwitchLock(phySw);
+
+    return status;
+
+}   /* end XcvrCachedMemRead */
+
+
+
+
+/*****************************************************************************/
+/** InvalidateXcvrCacheRange
+ * \ingroup intPlatform
+ *
+ * \desc            Drops the page cache blocks holding a range of the module
+ *                  memory. Must be called with the switch lock taken.
+ *
+ * \param[in]       xcvrInfo points to the transceiver info structure.
+ *
+ * \param[in]       qsfp is TRUE for a QSFP module, FALSE for an SFP+ module.
+ *
+ * \param[in]       page is the page number.
+ *
+ * \param[in]       offset is the offset from start of page.
+ *
+ * \param[in]       length is the number of bytes in the range.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void InvalidateXcvrCacheRange(fm_platXcvrInfo *xcvrInfo,
+                                     fm_bool          qsfp,
+                                     fm_int           page,
+                                     fm_int           offset,
+                                     fm_int           length)
+{
+    fm_int  blk;
+    fm_int  last;
+    fm_bool dom;
+
+    if (length <= 0)
+    {
+        return;
+    }
+
+    last = offset + length - 1;
+
+    for ( ; offset <= last ;
+          offset += XCVR_PAGE_CACHE_BLOCK_SIZE -
+                    (offset % XCVR_PAGE_CACHE_BLOCK_SIZE) )
+    {
+        blk = GetXcvrCacheBlock(qsfp, page, offset, &dom);
+
+        if (blk >= 0)
+        {
+            xcvrInfo->pageCache[blk].valid = FALSE;
+        }
+        else if (qsfp && offset >= XCVR_PAGE_CACHE_BLOCK_SIZE)
+        {
+            /* Unknown upper page */
+            for (blk = 1 ; blk < XCVR_PAGE_CACHE_NUM_BLOCKS ; blk++)
+            {
+                xcvrInfo->pageCache[blk].valid = FALSE;
+            }
+        }
+    }
+
+}   /* end InvalidateXcvrCacheRange */
+
+
+
+
+/*****************************************************************************/
+/** XcvrEepromRead
+ * \ingroup intPlatform
+ *
+ * \desc            Reads a byte (8 bits) from an SFP+/QSFP module's EEPROM
+ *                  on a given port.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       port is the logical port number.
+ *
+ * \param[in]       page is the page number.
+ *
+ * \param[in]       offset is the offset from start of page.
+ *
+ * \param[out]      data points to an array where this function will write
+ *                  the 8-bit data values read from the device. The array must
+ *                  be length bytes long.
+ *
+ * \param[in]       length is the number of data bytes to read.
+ *
+ * \param[in]       takeLocks is FALSE if the caller already serializes the
+ *                  accesses to the transceiver's I2C bus. The page cache is
+ *                  only used when it is TRUE.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status XcvrEepromRead(fm_int   sw,
+                                fm_int   port,
+                                fm_int   page,
+                                fm_int   offset,
+                                fm_byte *data,
+                                fm_int   length,
+                                fm_bool  takeLocks)
+{
+    fm_status           status;
+    fm_int              swNum;
+    fm_int              phySw;
+    fm_uint32           hwResId;
+    fm_platformCfgPort *portCfg;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
+                 "sw = %d, port = %d, page = %d, offset = %d length = %d\n",
+                 sw,
+                 port,
+                 page,
+                 offset,
+                 length);
+
+    status = fmPlatformMapLogicalPortToPlatform(sw,
+                                                port,
+                                                &phySw,
+                                                &swNum,
+                                                &hwResId,
+                                                &portCfg);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+
+    switch (portCfg->intfType)
+    {
+        case FM_PLAT_INTF_TYPE_QSFP_LANE0:
+        case FM_PLAT_INTF_TYPE_QSFP_LANE1:
+        case FM_PLAT_INTF_TYPE_QSFP_LANE2:
+        case FM_PLAT_INTF_TYPE_QSFP_LANE3:
+
+            if (offset + length > 128)
+            {
+                return FM_ERR_INVALID_ARGUMENT;
+            }
+
+            offset += 128;
+            break;
+
+        case FM_PLAT_INTF_TYPE_SFPP:
+            break;
+
+        default:
+            FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_UNSUPPORTED);
+            break;
+    }   /* switch */
+
+
+    if (takeLocks)
+    {
+        status = XcvrCachedMemRead(sw, port, page, offset, data, length);
+    }
+    else
+    {
+        status = XcvrMemRead(sw, port, page, offset, data, length, FALSE);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, status);
+
+}   /* end XcvrEepromRead */
+
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -366,19 +960,111 @@ fm_status fmPlatformI2cWriteLong(fm_int    sw,
                                  fm_int    length)
 {
     fm_int          swNum;
-    fm_byte         reg[8];
-    fm_int          i;
+    fm_byte         reg[8];
+    fm_int          i;
+    fm_status       status;
+    fm_platformLib *libFunc;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
+                 "sw = %d, bus = %d, address = %d, "
+                 "data = 0x%llx length = %d\n",
+                 sw,
+                 bus,
+                 address,
+                 data,
+                 length);
+
+    libFunc = FM_PLAT_GET_LIB_FUNCS_PTR(sw);
+
+    if ( !libFunc->I2cWriteRead )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_UNSUPPORTED);
+    }
+
+    if (length > 8)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    for (i = 0 ; i < length ; i++)
+    {
+        reg[i] = data >> ( 8 * (length - i - 1) );
+    }
+
+    TAKE_PLAT_I2C_BUS_LOCK(sw);
+
+    swNum   = FM_PLAT_GET_SWITCH_CFG(sw)->swNum;
+
+    if ( libFunc->SelectBus )
+    {
+        status = libFunc->SelectBus(swNum, FM_PLAT_BUS_NUMBER, bus);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+    }
+
+    status = libFunc->I2cWriteRead(swNum, address, reg, length, 0);
+
+ABORT:
+    DROP_PLAT_I2C_BUS_LOCK(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, status);
+
+}   /* end fmPlatformI2cWriteLong */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformI2cWriteReadBuf
+ * \ingroup platformApp
+ *
+ * \desc            Write to then immediately read from an I2C device, in a
+ *                  single transaction of any length.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       bus is one of the bus numbers provided through the
+ *                  api.platform.lib.config.bus%d.i2cDevName property.
+ *
+ * \param[in]       address is the I2C device address (0x00 - 0x7F).
+ *
+ * \param[in,out]   data points to the bytes to write, and into which the
+ *                  bytes read are placed. The buffer must be at least as
+ *                  long as the larger of wl and rl.
+ *
+ * \param[in]       wl is the number of bytes to write.
+ *
+ * \param[in]       rl is the number of bytes to read.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformI2cWriteReadBuf(fm_int   sw,
+                                    fm_int   bus,
+                                    fm_int   address,
+                                    fm_byte *data,
+                                    fm_int   wl,
+                                    fm_int   rl)
+{
+    fm_int          swNum;
     fm_status       status;
     fm_platformLib *libFunc;
 
     FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                  "sw = %d, bus = %d, address = %d, "
-                 "data = 0x%llx length = %d\n",
+                 "data = %p, wlength = %d rlength = %d\n",
                  sw,
                  bus,
                  address,
-                 data,
-                 length);
+                 (void *) data,
+                 wl,
+                 rl);
+
+    if (sw < 0 || sw >= FM_PLAT_NUM_SW)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
 
     libFunc = FM_PLAT_GET_LIB_FUNCS_PTR(sw);
 
@@ -387,16 +1073,11 @@ fm_status fmPlatformI2cWriteLong(fm_int    sw,
         FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_UNSUPPORTED);
     }
 
-    if (length > 8)
+    if (wl < 0 || rl < 0)
     {
         FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_INVALID_ARGUMENT);
     }
 
-    for (i = 0 ; i < length ; i++)
-    {
-        reg[i] = data >> ( 8 * (length - i - 1) );
-    }
-
     TAKE_PLAT_I2C_BUS_LOCK(sw);
 
     swNum   = FM_PLAT_GET_SWITCH_CFG(sw)->swNum;
@@ -407,14 +1088,14 @@ fm_status fmPlatformI2cWriteLong(fm_int    sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
     }
 
-    status = libFunc->I2cWriteRead(swNum, address, reg, length, 0);
+    status = libFunc->I2cWriteRead(swNum, address, data, wl, rl);
 
 ABORT:
     DROP_PLAT_I2C_BUS_LOCK(sw);
 
     FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, status);
 
-}   /* end fmPlatformI2cWriteLong */
+}   /* end fmPlatformI2cWriteReadBuf */
 
 
 
@@ -675,6 +1356,7 @@ fm_status fmPlatformXcvrMemWrite(fm_int   sw,
     fm_byte             bytes[MAX_XCVR_MEM_WRITE_BYTES + 1];
     fm_int              cnt;
     fm_platformLib *    libFunc;
+    fm_platXcvrInfo *   xcvrInfo;
 
     FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                  "sw = %d, port = %d, page = %d, offset = %d length = %d\n",
@@ -781,6 +1463,14 @@ fm_status fmPlatformXcvrMemWrite(fm_int   sw,
 
     status = libFunc->I2cWriteRead(swNum, address, bytes, length + 1, 0);
 
+    /* Even a failed write may have reached the module */
+    xcvrInfo = GetXcvrInfo(sw, portCfg);
+
+    if (xcvrInfo != NULL)
+    {
+        InvalidateXcvrCacheRange(xcvrInfo, qsfp, page, offset, length);
+    }
+
 ABORT:
     DROP_PLAT_I2C_BUS_LOCK(sw);
     fmPlatformMgmtDropSwitchLock(sw);
@@ -797,6 +1487,8 @@ ABORT:
  * \ingroup freedomApp
  *
  * \desc            Reads bytes from an SFP+/QSFP module on a given port.
+ *                  The bytes are served from the port's page cache, see
+ *                  the xcvrDomRefreshMsec platform property.
  *
  * \param[in]       sw is the switch number.
  *
@@ -822,126 +1514,7 @@ fm_status fmPlatformXcvrMemRead(fm_int   sw,
                                 fm_byte *data,
                                 fm_int   length)
 {
-    fm_status           status;
-    fm_int              address;
-    fm_int              swNum;
-    fm_uint32           hwResId;
-    fm_bool             qsfp;
-    fm_platformCfgPort *portCfg;
-    fm_platformLib     *libFunc;
-    fm_byte             bytes[2];
-
-    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
-                 "sw = %d, port = %d, page = %d, offset = %d length = %d\n",
-                 sw,
-                 port,
-                 page,
-                 offset,
-                 length);
-
-    libFunc = FM_PLAT_GET_LIB_FUNCS_PTR(sw);
-
-    if ( !libFunc->I2cWriteRead )
-    {
-        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_UNSUPPORTED);
-    }
-
-    status = fmPlatformMapLogicalPortToPlatform(sw,
-                                                port,
-                                                &sw,
-                                                &swNum,
-                                                &hwResId,
-                                                &portCfg);
-    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
-
-    switch (portCfg->intfType)
-    {
-        case FM_PLAT_INTF_TYPE_QSFP_LANE0:
-        case FM_PLAT_INTF_TYPE_QSFP_LANE1:
-        case FM_PLAT_INTF_TYPE_QSFP_LANE2:
-        case FM_PLAT_INTF_TYPE_QSFP_LANE3:
-            qsfp = TRUE;
-            break;
-
-        case FM_PLAT_INTF_TYPE_SFPP:
-            qsfp = FALSE;
-            break;
-
-        default:
-            FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_UNSUPPORTED);
-            break;
-    }   /* switch */
-
-    if ((status = fmPlatformMgmtTakeSwitchLock(sw)) != FM_OK)
-    {
-         FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, status);
-    }
-    TAKE_PLAT_I2C_BUS_LOCK(sw);
-
-    if ( libFunc->SelectBus )
-    {
-        status = libFunc->SelectBus(swNum, FM_PLAT_BUS_XCVR_EEPROM, hwResId);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
-    }
-
-    address = 0x50;
-
-    /* Set I2C address corresponding to page number */
-    if (qsfp)
-    {
-        if (page > 3)
-        {
-            status = FM_ERR_INVALID_ARGUMENT;
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
-        }
-
-        if ( (offset + length) > 128 && page >= 0 )
-        {
-            /* Refer to SFF-8436 */
-            bytes[0] = 127;
-            bytes[1] = page;
-            status   = libFunc->I2cWriteRead(swNum, address, bytes, 2, 0);
-
-            if (status == FM_OK)
-            {
-                /* For some modules, such as Aphenol 566570001, need a delay here */
-                fmDelay(0, 20 * 1000 * 1000);
-            }
-            else
-            {
-                /* For some modules, such as the Molex/74757-1031, the write to
-                   the page register doesn't work.
-                 
-                   In that case do not return an error and most likely page 0
-                   will be selected and the read to Upper Memory Map: Page 0
-                   will work. */
-            }
-        }
-    }
-    else
-    {
-        if (page > 1)
-        {
-            status = FM_ERR_INVALID_ARGUMENT;
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
-        }
-
-        if (page)
-        {
-            address = 0x51;
-        }
-    }
-
-    /* Write the offset to be read from. */
-    data[0] = offset & 0xFF;
-
-    status = libFunc->I2cWriteRead(swNum, address, data, 1, length);
-
-ABORT:
-    DROP_PLAT_I2C_BUS_LOCK(sw);
-    fmPlatformMgmtDropSwitchLock(sw);
-
-    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, status);
+    return XcvrCachedMemRead(sw, port, page, offset, data, length);
 
 }   /* end fmPlatformXcvrMemRead */
 
@@ -978,20 +1551,80 @@ fm_status fmPlatformXcvrEepromRead(fm_int   sw,
                                    fm_int   offset,
                                    fm_byte *data,
                                    fm_int   length)
+{
+    return XcvrEepromRead(sw, port, page, offset, data, length, TRUE);
+
+}   /* end fmPlatformXcvrEepromRead */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformXcvrEepromReadNoLock
+ * \ingroup intPlatform
+ *
+ * \desc            Reads from an SFP+/QSFP module's EEPROM on a given port
+ *                  like ''fmPlatformXcvrEepromRead'', without taking the
+ *                  switch lock nor the platform I2C bus lock.
+ *                                                                      \lb\lb
+ *                  The caller must make sure that no other thread accesses
+ *                  the I2C bus behind which the module sits meanwhile.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       port is the logical port number.
+ *
+ * \param[in]       page is the page number.
+ *
+ * \param[in]       offset is the offset from start of page.
+ *
+ * \param[out]      data points to an array where this function will write
+ *                  the 8-bit data values read from the device. The array must
+ *                  be length bytes long.
+ *
+ * \param[in]       length is the number of data bytes to read.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmPlatformXcvrEepromReadNoLock(fm_int   sw,
+                                         fm_int   port,
+                                         fm_int   page,
+                                         fm_int   offset,
+                                         fm_byte *data,
+                                         fm_int   length)
+{
+    return XcvrEepromRead(sw, port, page, offset, data, length, FALSE);
+
+}   /* end fmPlatformXcvrEepromReadNoLock */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformXcvrInvalidateCache
+ * \ingroup intPlatform
+ *
+ * \desc            Drops the cached memory content of the SFP+/QSFP module
+ *                  on a given port, so that the next reads get it from the
+ *                  module. Called when the module is inserted or removed.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       port is the logical port number.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmPlatformXcvrInvalidateCache(fm_int sw, fm_int port)
 {
     fm_status           status;
     fm_int              swNum;
     fm_int              phySw;
+    fm_int              blk;
     fm_uint32           hwResId;
     fm_platformCfgPort *portCfg;
-
-    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
-                 "sw = %d, port = %d, page = %d, offset = %d length = %d\n",
-                 sw,
-                 port,
-                 page,
-                 offset,
-                 length);
+    fm_platXcvrInfo *   xcvrInfo;
 
     status = fmPlatformMapLogicalPortToPlatform(sw,
                                                 port,
@@ -999,42 +1632,33 @@ fm_status fmPlatformXcvrEepromRead(fm_int   sw,
                                                 &swNum,
                                                 &hwResId,
                                                 &portCfg);
-    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
-
-    switch (portCfg->intfType)
+    if (status != FM_OK)
     {
-        case FM_PLAT_INTF_TYPE_QSFP_LANE0:
-        case FM_PLAT_INTF_TYPE_QSFP_LANE1:
-        case FM_PLAT_INTF_TYPE_QSFP_LANE2:
-        case FM_PLAT_INTF_TYPE_QSFP_LANE3:
-
-            if (offset + length > 128)
-            {
-                return FM_ERR_INVALID_ARGUMENT;
-            }
+        return status;
+    }
 
-            offset += 128;
-            break;
+    xcvrInfo = GetXcvrInfo(phySw, portCfg);
 
-        case FM_PLAT_INTF_TYPE_SFPP:
-            break;
+    if (xcvrInfo == NULL)
+    {
+        return FM_ERR_INVALID_PORT;
+    }
 
-        default:
-            FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_UNSUPPORTED);
-            break;
-    }   /* switch */
+    if ((status = fmPlatformMgmtTakeSwitchLock(phySw)) != FM_OK)
+    {
+        return status;
+    }
 
+    for (blk = 0 ; blk < XCVR_PAGE_CACHE_NUM_BLOCKS ; blk++)
+    {
+        xcvrInfo->pageCache[blk].valid = FALSE;
+    }
 
-    status = fmPlatformXcvrMemRead(sw,
-                                   port,
-                                   page,
-                                   offset,
-                                   data,
-                                   length);
+    fmPlatformMgmtDropSwitchLock(phySw);
 
-    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, status);
+    return FM_OK;
 
-}   /* end fmPlatformXcvrEepromRead */
+}   /* end fmPlatformXcvrInvalidateCache */
 
 
 
@@ -1498,3 +2122,52 @@ fm_status fmPlatformSwitchGpioGetValue(fm_int sw, fm_int gpio, fm_int *value)
     FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
 
 }  /* end fmPlatformSwitchGpioGetValue */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformGetTxTimestamps
+ * \ingroup freedomApp
+ *
+ * \desc            Retrieves, oldest first, the hardware egress timestamps
+ *                  of frames sent to the switch through the ''tpacket''
+ *                  packet interface. Timestamps are collected when
+ *                  api.platform.tpacket.txTimestamps is TRUE.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      entries points to a caller-allocated array of
+ *                  maxEntries elements where the function will store the
+ *                  timestamps. Each entry holds the leading bytes of the
+ *                  frame to match it against the frame that was sent.
+ *
+ * \param[in]       maxEntries is the size of entries.
+ *
+ * \param[out]      numEntries points to caller-allocated storage where
+ *                  the function will store the number of entries returned.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_UNSUPPORTED if TX timestamps are not collected.
+ *
+ *****************************************************************************/
+fm_status fmPlatformGetTxTimestamps(fm_int                 sw,
+                                    fm_tpacketTxTimestamp *entries,
+                                    fm_int                 maxEntries,
+                                    fm_int *               numEntries)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM, "sw=%d maxEntries=%d\n", sw, maxEntries);
+
+    if (sw < 0 || sw >= FM_PLAT_NUM_SW)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    err = fmTpacketGetTxTimestamps(sw, entries, maxEntries, numEntries);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
+
+}  /* end fmPlatformGetTxTimestamps */
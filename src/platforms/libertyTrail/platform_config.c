@@ -272,6 +272,7 @@ static fm_platformStrMap regAccessMode[] =
     { "PCIE",   FM_PLAT_REG_ACCESS_PCIE },
     { "EBI",    FM_PLAT_REG_ACCESS_EBI  },
     { "I2C",    FM_PLAT_REG_ACCESS_I2C  },
+    { "SIM",    FM_PLAT_REG_ACCESS_SIM  },
 
 };
 
@@ -306,6 +307,7 @@ static fm_platformStrMap disableFuncIntfMap[] =
     { FM_PLAT_POST_INIT_FUNC_NAME_SHORT,           FM_PLAT_DISABLE_POST_INIT_FUNC          },
     { FM_PLAT_SET_VRM_VOLTAGE_FUNC_NAME_SHORT,     FM_PLAT_DISABLE_SET_VRM_VOLTAGE_FUNC    },
     { FM_PLAT_GET_VRM_VOLTAGE_FUNC_NAME_SHORT,     FM_PLAT_DISABLE_GET_VRM_VOLTAGE_FUNC    },
+    { FM_PLAT_GET_XCVR_BUS_FUNC_NAME_SHORT,        FM_PLAT_DISABLE_GET_XCVR_BUS_FUNC       },
 
 };
 
@@ -673,6 +675,7 @@ void fmPlatformCfgDump(void)
                                 tmpStr,
                                 sizeof(tmpStr) ) );
         PRINT_VALUE(" xcvrPollPeriodMsec", swCfg->xcvrPollPeriodMsec);
+        PRINT_VALUE(" xcvrDomRefreshMsec", swCfg->xcvrDomRefreshMsec);
         PRINT_VALUE(" intrPollPeriodMsec", swCfg->intrPollPeriodMsec);
         PRINT_STRING(" uioDevName", swCfg->uioDevName);
         PRINT_STRING(" netDevName", swCfg->netDevName);
@@ -1022,6 +1025,92 @@ fm_status fmPlatformLoadPropertiesFromLine(fm_text line)
 
 
 
+/*****************************************************************************/
+/** fmPlatformEncodePropertiesFromLine
+ * \ingroup intPlatform
+ *
+ * \desc            Encodes a text line into the TLV records that
+ *                  ''fmPlatformLoadPropertiesFromLine'' would load, without
+ *                  loading them. Each record is one byte giving the loader
+ *                  (see ''FM_PLAT_CFG_IMAGE_API'') followed by the TLV.
+ *
+ * \param[in]       line is the text line to encode.
+ *
+ * \param[out]      records points to caller-allocated storage where the
+ *                  records are placed. It must hold at least
+ *                  FM_PLAT_CFG_IMAGE_LINE_MAX bytes.
+ *
+ * \param[out]      length points to caller-allocated storage where the
+ *                  total length of the records is placed. It is zero if
+ *                  the line does not load anything.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' if the line cannot be encoded.
+ *
+ *****************************************************************************/
+fm_status fmPlatformEncodePropertiesFromLine(fm_text  line,
+                                             fm_byte *records,
+                                             fm_int * length)
+{
+    fm_status status;
+    fm_byte   tlv[FM_TLV_MAX_BUF_SIZE];
+    fm_int    tlvLen;
+    fm_uint   tlvType;
+    fm_byte   loader;
+
+    *length = 0;
+
+    /* Don't support these properties here, only for NVM image generation */
+    if ( (strncmp(line, "api.platform.config.", 20) == 0) &&
+         (strstr(line, ".bootCfg.") != NULL) )
+    {
+        return FM_OK;
+    }
+
+    status = fmUtilConfigPropertyEncodeTlv(line, tlv, sizeof(tlv));
+    if (status)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
+                     "%s: Unable to encode config: [%s]\n",
+                     fmErrorMsg(status), line);
+        return status;
+    }
+
+    tlvLen  = tlv[2] + 3;
+    tlvType = (tlv[0] << 8) | tlv[1];
+
+    if (strncmp(line, "api.platform.config.", 20) == 0)
+    {
+        if (tlvType == FM_TLV_PLAT_FILE_LOCK_NAME)
+        {
+            /* Shared with platform config */
+            records[0] = FM_PLAT_CFG_IMAGE_LIB;
+            FM_MEMCPY_S(records + 1, tlvLen, tlv, tlvLen);
+            records += tlvLen + 1;
+            *length += tlvLen + 1;
+        }
+
+        loader = FM_PLAT_CFG_IMAGE_LT;
+    }
+    else if (strncmp(line, "api.platform.lib.config.", 24) == 0)
+    {
+        loader = FM_PLAT_CFG_IMAGE_LIB;
+    }
+    else
+    {
+        loader = FM_PLAT_CFG_IMAGE_API;
+    }
+
+    records[0] = loader;
+    FM_MEMCPY_S(records + 1, tlvLen, tlv, tlvLen);
+    *length += tlvLen + 1;
+
+    return FM_OK;
+
+}   /* end fmPlatformEncodePropertiesFromLine */
+
+
+
 /*****************************************************************************/
 /* fmPlatformRequestLibTlvCfg
  * \ingroup intPlatform
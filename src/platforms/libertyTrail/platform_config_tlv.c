@@ -67,6 +67,12 @@
 #define PLFS_RX_TERM_LANE           (1 << 12)
 #define PLFS_RX_TERM                (PLFS_RX_TERM_ALL_LANE | PLFS_RX_TERM_LANE)
 
+/* Compiled configuration image identification and header length, see
+ * fmPlatformCompileConfigImage */
+#define CFG_IMAGE_MAGIC             0x464d4349
+#define CFG_IMAGE_VERSION           1
+#define CFG_IMAGE_HEADER_WORDS      9
+
 /* Pair of switch number and port configuration on the switch */
 typedef struct
 {
@@ -1201,6 +1207,124 @@ static void SetPortTxEq(fm_int swIdx,
 
 
 
+/*****************************************************************************/
+/** ReadConfigSource
+ * \ingroup intPlatform
+ *
+ * \desc            Reads a whole text configuration file into memory.
+ *
+ * \param[in]       fileName is the name of the text file.
+ *
+ * \param[out]      text points to caller-allocated storage where the
+ *                  buffer holding the file is placed. The caller must
+ *                  free it with fmFree.
+ *
+ * \param[out]      info points to caller-allocated storage where the
+ *                  status of the file is placed.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if the file cannot be opened.
+ * \return          FM_ERR_NO_MEM if the buffer cannot be allocated.
+ * \return          FM_FAIL if the file cannot be read.
+ *
+ *****************************************************************************/
+static fm_status ReadConfigSource(fm_text      fileName,
+                                  fm_byte **   text,
+                                  struct stat *info)
+{
+    FILE *fp;
+    fm_bool ok;
+
+    *text = NULL;
+
+    fp = fopen(fileName, "rb");
+    if (fp == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    if ( fstat(fileno(fp), info) != 0 )
+    {
+        fclose(fp);
+        return FM_FAIL;
+    }
+
+    /* One extra byte so that an empty file still gets a buffer */
+    *text = fmAlloc(info->st_size + 1);
+    if (*text == NULL)
+    {
+        fclose(fp);
+        return FM_ERR_NO_MEM;
+    }
+
+    ok = ( fread(*text, 1, info->st_size, fp) == (size_t) info->st_size );
+    fclose(fp);
+
+    if (!ok)
+    {
+        fmFree(*text);
+        *text = NULL;
+        return FM_FAIL;
+    }
+
+    return FM_OK;
+
+}   /* end ReadConfigSource */
+
+
+
+
+/*****************************************************************************/
+/** LoadConfigImageRecord
+ * \ingroup intPlatform
+ *
+ * \desc            Loads one record of a compiled configuration image.
+ *
+ * \param[in]       loader is the loader the record was encoded for.
+ *
+ * \param[in]       tlv points to the TLV of the record.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status LoadConfigImageRecord(fm_byte loader, fm_byte *tlv)
+{
+    fm_status status;
+    fm_uint   tlvType;
+
+    switch (loader)
+    {
+        case FM_PLAT_CFG_IMAGE_API:
+            status = fmLoadApiPropertyTlv(tlv);
+            break;
+
+        case FM_PLAT_CFG_IMAGE_LT:
+            status = fmPlatformLoadLTCfgTlv(tlv);
+            break;
+
+        case FM_PLAT_CFG_IMAGE_LIB:
+            status = fmPlatformLoadLibCfgTlv(tlv);
+            break;
+
+        default:
+            status = FM_ERR_INVALID_ARGUMENT;
+            break;
+    }
+
+    if (status)
+    {
+        tlvType = (tlv[0] << 8) | tlv[1];
+        FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
+                     "%s: Unable to load tlv 0x%04x\n",
+                     fmErrorMsg(status), tlvType);
+    }
+
+    return status;
+
+}   /* end LoadConfigImageRecord */
+
+
+
 
 /*****************************************************************************
  * Public Functions
@@ -1324,6 +1448,12 @@ fm_status fmPlatformLoadLTCfgTlv(fm_byte *tlv)
                 swCfg->msiEnabled         = FM_AAD_API_PLATFORM_MSI_ENABLED;
                 swCfg->fhClock            = FM_AAD_API_PLATFORM_FH_CLOCK;
                 swCfg->i2cClkDivider      = FM_AAD_API_PLATFORM_I2C_CLKDIVIDER;
+                swCfg->csrWideAccess      = FM_AAD_API_PLATFORM_CSR_WIDE_ACCESS;
+                swCfg->i2cBurstWords      = FM_AAD_API_PLATFORM_I2C_BURST_WORDS;
+                swCfg->simAccessLatencyNsec =
+                    FM_AAD_API_PLATFORM_SIM_ACCESS_LATENCY;
+                swCfg->xcvrDomRefreshMsec =
+                    FM_AAD_API_PLATFORM_XCVR_DOM_REFRESH_MSEC;
                 FM_STRNCPY_S(swCfg->devMemOffset,
                      FM_PLAT_MAX_CFG_STR_LEN,
                      FM_AAD_API_PLATFORM_DEVMEM_OFFSET,
@@ -2571,6 +2701,16 @@ fm_status fmPlatformLoadLTCfgTlv(fm_byte *tlv)
             swCfg = FM_PLAT_GET_SWITCH_CFG(swIdx);
             swCfg->enablePhyDeEmphasis = GetTlvBool(tlv + 4);
             break;
+        case FM_TLV_PLAT_SIM_ACCESS_LATENCY:
+            swIdx = GetTlvInt(tlv + 3, 1);
+            if (swIdx >= platCfg->numSwitches)
+            {
+                SwIdxErrorMsg(swIdx, platCfg->numSwitches, tlv);
+                return FM_ERR_INVALID_SWITCH;
+            }
+            swCfg = FM_PLAT_GET_SWITCH_CFG(swIdx);
+            swCfg->simAccessLatencyNsec = GetTlvInt(tlv + 4, 4);
+            break;
         case FM_TLV_PLAT_SW_VDDS_USE_HW_RESOURCE_ID:
             swIdx = GetTlvInt(tlv + 3, 1);
             if (swIdx >= platCfg->numSwitches)
@@ -2621,6 +2761,36 @@ fm_status fmPlatformLoadLTCfgTlv(fm_byte *tlv)
             swCfg = FM_PLAT_GET_SWITCH_CFG(swIdx);
             swCfg->i2cClkDivider = GetTlvInt(tlv + 4, 1);
             break;
+        case FM_TLV_PLAT_SW_CSR_WIDE_ACCESS:
+            swIdx = GetTlvInt(tlv + 3, 1);
+            if (swIdx >= platCfg->numSwitches)
+            {
+                SwIdxErrorMsg(swIdx, platCfg->numSwitches, tlv);
+                return FM_ERR_INVALID_SWITCH;
+            }
+            swCfg = FM_PLAT_GET_SWITCH_CFG(swIdx);
+            swCfg->csrWideAccess = GetTlvBool(tlv + 4);
+            break;
+        case FM_TLV_PLAT_SW_I2C_BURST_WORDS:
+            swIdx = GetTlvInt(tlv + 3, 1);
+            if (swIdx >= platCfg->numSwitches)
+            {
+                SwIdxErrorMsg(swIdx, platCfg->numSwitches, tlv);
+                return FM_ERR_INVALID_SWITCH;
+            }
+            swCfg = FM_PLAT_GET_SWITCH_CFG(swIdx);
+            swCfg->i2cBurstWords = GetTlvInt(tlv + 4, 1);
+            break;
+        case FM_TLV_PLAT_SW_XCVR_DOM_REFRESH_PER:
+            swIdx = GetTlvInt(tlv + 3, 1);
+            if (swIdx >= platCfg->numSwitches)
+            {
+                SwIdxErrorMsg(swIdx, platCfg->numSwitches, tlv);
+                return FM_ERR_INVALID_SWITCH;
+            }
+            swCfg = FM_PLAT_GET_SWITCH_CFG(swIdx);
+            swCfg->xcvrDomRefreshMsec = GetTlvInt(tlv + 4, 2);
+            break;
         default:
             status = FM_ERR_INVALID_ARGUMENT;
             break;
@@ -2926,3 +3096,379 @@ fm_status fmPlatformLoadTlvFile(fm_text fileName)
 
 }    /* end fmPlatformLoadTlvFile */
 
+
+
+
+/*****************************************************************************/
+/** fmPlatformCompileConfigImage
+ * \ingroup intPlatform
+ *
+ * \desc            Compiles a text configuration file into a binary image
+ *                  that ''fmPlatformLoadConfigImage'' loads without parsing
+ *                  the text.
+ *                                                                      \lb\lb
+ *                  The image is a header followed by one record per TLV,
+ *                  in the order of the lines of the text file, so that a
+ *                  later line still overrides an earlier one. The header
+ *                  holds the size, modification time and CRC of the text
+ *                  file, and the CRC of the records.
+ *
+ * \note            The image is written in host byte order, to a
+ *                  temporary file that replaces the named file once it is
+ *                  complete.
+ *
+ * \param[in]       fileName is the full path to the text file to compile.
+ *
+ * \param[in]       imageName is the full path to the image to write.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if the text file cannot be
+ *                  opened.
+ * \return          FM_ERR_NO_MEM if memory cannot be allocated.
+ * \return          FM_FAIL if the image cannot be written.
+ *
+ *****************************************************************************/
+fm_status fmPlatformCompileConfigImage(fm_text fileName, fm_text imageName)
+{
+    fm_status   status;
+    struct stat info;
+    fm_byte *   text;
+    fm_byte *   data;
+    fm_byte *   grown;
+    fm_byte *   lineStart;
+    fm_byte *   textEnd;
+    fm_char     line[FM_PLATFORM_API_ATTRIBUTE_CFG_LINE_MAX_LEN];
+    fm_char     tmpName[FM_PLATFORM_API_ATTRIBUTE_CFG_LINE_MAX_LEN];
+    fm_uint32   header[CFG_IMAGE_HEADER_WORDS];
+    fm_int      dataLen;
+    fm_int      dataMax;
+    fm_int      recLen;
+    fm_int      lineLen;
+    fm_int      lineNo;
+    fm_int      numRecords;
+    fm_int      cnt;
+    FILE *      fp;
+    fm_bool     ok;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
+                 "fileName=%s imageName=%s\n",
+                 fileName,
+                 imageName);
+
+    status = ReadConfigSource(fileName, &text, &info);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+
+    /* Records are usually shorter than their text line, grown below if not */
+    dataMax = info.st_size + FM_PLAT_CFG_IMAGE_LINE_MAX;
+    data    = fmAlloc(dataMax);
+    if (data == NULL)
+    {
+        fmFree(text);
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_NO_MEM);
+    }
+
+    dataLen    = 0;
+    numRecords = 0;
+    lineNo     = 0;
+    lineStart  = text;
+    textEnd    = text + info.st_size;
+
+    /* Split the text the same way fgets does in LoadPropertiesFromFile */
+    while (lineStart < textEnd)
+    {
+        lineLen = 0;
+        while ( (lineStart + lineLen < textEnd) &&
+                (lineLen < (fm_int) sizeof(line) - 1) )
+        {
+            if (lineStart[lineLen++] == '\n')
+            {
+                break;
+            }
+        }
+
+        FM_MEMCPY_S(line, sizeof(line), lineStart, lineLen);
+        line[lineLen] = '\0';
+        lineStart    += lineLen;
+        lineNo++;
+
+        /* check for comment line */
+        if ( (line[0] == '#') || (lineLen <= 1) )
+        {
+            continue;
+        }
+
+        /* blank line */
+        for (cnt = 0 ; cnt < lineLen ; cnt++)
+        {
+            if (!isspace(line[cnt]))
+            {
+                break;
+            }
+        }
+        if (cnt == lineLen)
+        {
+            continue;
+        }
+
+        if (dataLen + FM_PLAT_CFG_IMAGE_LINE_MAX > dataMax)
+        {
+            grown = fmAlloc(dataMax * 2);
+            if (grown == NULL)
+            {
+                fmFree(data);
+                fmFree(text);
+                FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_NO_MEM);
+            }
+
+            FM_MEMCPY_S(grown, dataMax * 2, data, dataLen);
+            fmFree(data);
+            data     = grown;
+            dataMax *= 2;
+        }
+
+        status = fmPlatformEncodePropertiesFromLine(line,
+                                                    data + dataLen,
+                                                    &recLen);
+        if (status != FM_OK)
+        {
+            /* Skipped, as when the text file is loaded */
+            FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
+                         "Error encoding line %d of %s\n",
+                         lineNo,
+                         fileName);
+            continue;
+        }
+
+        for (cnt = dataLen ; cnt < dataLen + recLen ; cnt += data[cnt + 3] + 4)
+        {
+            numRecords++;
+        }
+
+        dataLen += recLen;
+    }
+
+    header[0] = CFG_IMAGE_MAGIC;
+    header[1] = CFG_IMAGE_VERSION;
+    header[2] = numRecords;
+    header[3] = dataLen;
+    header[4] = fmCrc32(data, dataLen);
+    header[5] = (fm_uint32) info.st_size;
+    header[6] = (fm_uint32) ((fm_uint64) info.st_mtime & 0xFFFFFFFF);
+    header[7] = (fm_uint32) ((fm_uint64) info.st_mtime >> 32);
+    header[8] = fmCrc32(text, info.st_size);
+
+    fmFree(text);
+
+    FM_SNPRINTF_S(tmpName, sizeof(tmpName), "%s.tmp", imageName);
+
+    fp = fopen(tmpName, "wb");
+    if (fp == NULL)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
+                     "Unable to create configuration image %s\n",
+                     tmpName);
+        fmFree(data);
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_FAIL);
+    }
+
+    ok = ( fwrite(header, sizeof(fm_uint32), CFG_IMAGE_HEADER_WORDS, fp) ==
+           CFG_IMAGE_HEADER_WORDS );
+
+    if (ok && dataLen > 0)
+    {
+        ok = ( fwrite(data, 1, dataLen, fp) == (size_t) dataLen );
+    }
+
+    fmFree(data);
+
+    if (fclose(fp) != 0)
+    {
+        ok = FALSE;
+    }
+
+    if (!ok || rename(tmpName, imageName) != 0)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
+                     "Unable to write configuration image %s\n",
+                     imageName);
+        remove(tmpName);
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_FAIL);
+    }
+
+    FM_LOG_DEBUG(FM_LOG_CAT_PLATFORM,
+                 "Compiled %d records from %s into %s\n",
+                 numRecords,
+                 fileName,
+                 imageName);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_OK);
+
+}   /* end fmPlatformCompileConfigImage */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformLoadConfigImage
+ * \ingroup intPlatform
+ *
+ * \desc            Loads a configuration image compiled by
+ *                  ''fmPlatformCompileConfigImage''.
+ *                                                                      \lb\lb
+ *                  The image is only used if it is still current for the
+ *                  text file it was compiled from. The text file is not
+ *                  read when its size and modification time are unchanged.
+ *                  Otherwise the image is still used if the CRC of the
+ *                  text is unchanged. The whole image is checked before
+ *                  any record is loaded.
+ *
+ * \param[in]       imageName is the full path to the image to load.
+ *
+ * \param[in]       fileName is the full path to the text file the image
+ *                  was compiled from.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if the image is missing, damaged or
+ *                  out of date, in which case nothing is loaded.
+ *
+ *****************************************************************************/
+fm_status fmPlatformLoadConfigImage(fm_text imageName, fm_text fileName)
+{
+    fm_status   status;
+    struct stat info;
+    struct stat srcInfo;
+    fm_uint32 * header;
+    fm_byte *   image;
+    fm_byte *   data;
+    fm_byte *   text;
+    fm_byte     tlv[FM_TLV_MAX_BUF_SIZE];
+    fm_uint32   dataLen;
+    fm_uint32   off;
+    fm_uint32   numRecords;
+    fm_uint32   tlvLen;
+    fm_uint64   mtime;
+    fm_bool     current;
+    int         fd;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
+                 "imageName=%s fileName=%s\n",
+                 imageName,
+                 fileName);
+
+    fd = open(imageName, O_RDONLY);
+    if (fd < 0)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_NOT_FOUND);
+    }
+
+    if ( (fstat(fd, &info) != 0) ||
+         (info.st_size < (off_t) (CFG_IMAGE_HEADER_WORDS * sizeof(fm_uint32))) )
+    {
+        close(fd);
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_NOT_FOUND);
+    }
+
+    image = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (image == MAP_FAILED)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_NOT_FOUND);
+    }
+
+    header  = (fm_uint32 *) image;
+    data    = image + CFG_IMAGE_HEADER_WORDS * sizeof(fm_uint32);
+    dataLen = info.st_size - CFG_IMAGE_HEADER_WORDS * sizeof(fm_uint32);
+    status  = FM_ERR_NOT_FOUND;
+
+    if ( (header[0] != CFG_IMAGE_MAGIC) ||
+         (header[1] != CFG_IMAGE_VERSION) ||
+         (header[3] != dataLen) ||
+         (header[4] != fmCrc32(data, dataLen)) )
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                       "Ignoring damaged configuration image %s\n",
+                       imageName);
+        goto ABORT;
+    }
+
+    /* Walk the records once so that a bad one loads nothing */
+    numRecords = 0;
+    for (off = 0 ; off < dataLen ; off += tlvLen + 1)
+    {
+        if (off + 4 > dataLen)
+        {
+            goto ABORT;
+        }
+
+        tlvLen = data[off + 3] + 3;
+        if (off + 1 + tlvLen > dataLen)
+        {
+            goto ABORT;
+        }
+
+        numRecords++;
+    }
+
+    if (numRecords != header[2])
+    {
+        goto ABORT;
+    }
+
+    /* Is the image still current for the text file? */
+    if (stat(fileName, &srcInfo) != 0)
+    {
+        goto ABORT;
+    }
+
+    mtime   = ((fm_uint64) header[7] << 32) | header[6];
+    current = ( ((fm_uint32) srcInfo.st_size == header[5]) &&
+                ((fm_uint64) srcInfo.st_mtime == mtime) );
+
+    if (!current && (fm_uint32) srcInfo.st_size == header[5])
+    {
+        if (ReadConfigSource(fileName, &text, &srcInfo) == FM_OK)
+        {
+            current = (fmCrc32(text, srcInfo.st_size) == header[8]);
+            fmFree(text);
+        }
+    }
+
+    if (!current)
+    {
+        FM_LOG_DEBUG(FM_LOG_CAT_PLATFORM,
+                     "Configuration image %s is older than %s\n",
+                     imageName,
+                     fileName);
+        goto ABORT;
+    }
+
+    for (off = 0 ; off < dataLen ; off += tlvLen + 1)
+    {
+        tlvLen = data[off + 3] + 3;
+        FM_MEMCPY_S(tlv, sizeof(tlv), data + off + 1, tlvLen);
+
+        /* Errors are logged, and the remaining records still loaded */
+        LoadConfigImageRecord(data[off], tlv);
+    }
+
+    FM_LOG_DEBUG(FM_LOG_CAT_PLATFORM,
+                 "Loaded %d records from %s\n",
+                 numRecords,
+                 imageName);
+
+    if (FM_PLAT_GET_CFG->debug & CFG_DBG_CONFIG)
+    {
+        fmPlatformCfgDump();
+    }
+
+    fmPlatformCfgVerifyAndUpdate();
+
+    status = FM_OK;
+
+ABORT:
+    munmap(image, info.st_size);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, status);
+
+}   /* end fmPlatformLoadConfigImage */
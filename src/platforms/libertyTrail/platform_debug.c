@@ -933,7 +933,8 @@ fm_status fmPlatformRetimerSetAppMode(fm_int sw, fm_int port, fm_int mode)
     fm_status           err;
     fm_uint32           hwResId;
     fm_int              phyIdx;
-    fm_int              lane;
+    fm_int              lanes[2];
+    fm_int              modes[2];
     fm_int              swNum;
 
     err = fmPlatformMapLogicalPortToPlatform(sw,
@@ -973,36 +974,33 @@ fm_status fmPlatformRetimerSetAppMode(fm_int sw, fm_int port, fm_int mode)
     }
 
     /* Set the internal PHY's port */
-    lane = portCfg->phyPort;
+    lanes[0] = portCfg->phyPort;
+    modes[0] = mode;
 
     FM_LOG_PRINT("Set app-mode %xh to internal port %d phy %d lane %d\n",
                  mode,
                  port,
                  phyIdx,
-                 lane);
-
-    err = fmUtilGN2412SetAppMode((fm_uintptr) sw,
-                                 PhyI2cWriteRead,
-                                 phyCfg->addr,
-                                 lane,
-                                 mode);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY, err);
+                 lanes[0]);
 
     /* Get the corresponding external PHY's port */
-    lane = 
+    lanes[1] =
         fmPlatformPhyInternalToExternalPort(sw, phyIdx, portCfg->phyPort);
+    modes[1] = mode;
 
     FM_LOG_PRINT("Set app-mode %xh to external port %d phy %d lane %d\n",
                  mode,
                  port,
                  phyIdx,
-                 lane);
+                 lanes[1]);
 
-    err = fmUtilGN2412SetAppMode((fm_uintptr) sw,
-                                 PhyI2cWriteRead,
-                                 phyCfg->addr,
-                                 lane,
-                                 mode);
+    /* Both sides of the port go down and come back up together */
+    err = fmUtilGN2412SetAppModes((fm_uintptr) sw,
+                                  PhyI2cWriteRead,
+                                  phyCfg->addr,
+                                  2,
+                                  lanes,
+                                  modes);
 
 ABORT:
     DropLocks(sw);
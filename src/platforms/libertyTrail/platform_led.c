@@ -37,6 +37,25 @@
  * Macros, Constants & Types
  *****************************************************************************/
 
+/* LED polling state of a switch */
+typedef struct
+{
+    /* Timer running the LED polling on the API timer task */
+    fm_timerHandle        timer;
+
+    /* Number of polling passes done */
+    fm_uint               pass;
+
+    /* Ports with software driven LEDs, as port indexes */
+    fm_int                numPorts;
+    fm_int *              portList;
+
+    /* LED updates of a polling pass */
+    fm_uint32 *           hwResIdList;
+    fm_platPortLedState * ledStateList;
+
+} fm_platLedPoll;
+
 
 /*****************************************************************************
  * Global Variables
@@ -47,6 +66,8 @@
  * Local Variables
  *****************************************************************************/
 
+static fm_platLedPoll ledPoll[FM_MAX_NUM_SWITCHES];
+
 
 /*****************************************************************************
  * Local function prototypes.
@@ -175,279 +196,154 @@ static fm_status GetPortTrafficLedState(fm_int  sw,
 
 
 /*****************************************************************************/
-/* fmPlatformLedThread
+/* UpdatePortLeds
  * \ingroup intPlatformLed
  *
- * \desc            Thread to handle LED status.
+ * \desc            Computes the LED state of all the ports with software
+ *                  driven LEDs, and writes the ones that differ from the
+ *                  state last written, in a single call to the platform
+ *                  library so that it updates each LED controller once.
  *
- * \param[in]       args contains thread-initialization parameters
+ * \param[in]       sw is the switch number.
  *
  * \return          None.
  *
  *****************************************************************************/
-void *fmPlatformLedThread(void *args)
+static void UpdatePortLeds(fm_int sw)
 {
-    fm_thread *           thread;
     fm_platformCfgSwitch *swCfg;
     fm_platformCfgPort *  portCfg;
-    fm_platformLib     *  libFunc;
+    fm_platformLib *      libFunc;
     fm_platLedInfo *      ledInfo;
-    fm_int *              ledPortList;
-    fm_uint32 *           hwResIdList;
-    fm_platPortLedState * ledStateList;
+    fm_platLedPoll *      poll;
     fm_platPortLedState   ledState;
-    fm_platPortLedSpeed   ledSpeed;
-    fm_int                sw;
-    fm_int                i;
-    fm_int                count;
+    fm_platPortLedState   newState;
     fm_int                cnt;
+    fm_int                numChanged;
     fm_int                portIdx;
-    fm_int                portLedPeriodMsec;
-    fm_int                portLedPeriodSec;
-    fm_int                portLedPeriodNsec;
     fm_int                trafficState;
-    fm_int                ledPortCnt;
-    fm_int                activePortCnt;
-    fm_bool               addPort;
+    fm_bool               sample;
     fm_bool               up;
 
-    /* grab arguments */
-    thread = FM_GET_THREAD_HANDLE(args);
-    sw     = *(FM_GET_THREAD_PARAM(fm_int, args));
-
-    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM, "thread = %s\n", thread->name);
-
+    poll    = &ledPoll[sw];
+    swCfg   = FM_PLAT_GET_SWITCH_CFG(sw);
     libFunc = FM_PLAT_GET_LIB_FUNCS_PTR(sw);
-    activePortCnt = 0;
-
-    if ( !libFunc->SetPortLed )
-    {
-        /* No support so no need to keep the thread alive */
-        FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
-                     "Unable to enable LED polling\n"
-                     "libFunc->SetPortLed is disabled from LT config file\n");
-        fmExitThread(thread);
-        return NULL;
-    }
 
-    /* Do not enable polling until the switch is UP */
-    up = FALSE;
-    while (!up)
-    {
-        fmDelay(1, 0);
-        fmGetSwitchState(sw, &up);
-    }
-
-    /* Pre-allocate memory to be used within the polling thread */
-    ledPortList  = fmAlloc( FM_PLAT_NUM_PORT(sw) * sizeof(fm_int) );
-    hwResIdList  = fmAlloc( FM_PLAT_NUM_PORT(sw) * sizeof(fm_uint32) );
-    ledStateList = fmAlloc( FM_PLAT_NUM_PORT(sw) * 
-                            sizeof(fm_platPortLedState) );
+    /* To cover the case the switch is brought down */
+    fmGetSwitchState(sw, &up);
 
-    if ( ledPortList && hwResIdList && ledStateList )
+    if (!up)
     {
-        /* Create the list of ports that need LED software support */
-        ledPortCnt = 0;
-        for (portIdx = 0 ; portIdx < FM_PLAT_NUM_PORT(sw) ; portIdx++)
+        /* Write all the LEDs again once the switch is back */
+        for (cnt = 0 ; cnt < poll->numPorts ; cnt++)
         {
-            portCfg = FM_PLAT_GET_PORT_CFG(sw, portIdx);
-
-            /* Don't add PCIE ports since traffic notification isn't required */
-            if ( !FM_PLAT_PORT_IS_SW_LED(portCfg) ||
-                 portCfg->intfType == FM_PLAT_INTF_TYPE_PCIE )
-            {
-                continue;
-            }
-
-            ledPortList[ledPortCnt] = portIdx;
-            ledPortCnt++;
-            MOD_LED_DEBUG("Add port %d to LED port list\n", portCfg->port);
+            GET_PLAT_STATE(sw)->ledInfo[poll->portList[cnt]].ledStateValid =
+                FALSE;
         }
+        return;
     }
-    else
-    {
-        /* Unable to allocate all the required lists above */
-        FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
-                     "Unable to enable LED polling\n");
 
-        /* Free those that were allocated */
-        if (ledPortList != NULL)  fmFree(ledPortList);
-        if (hwResIdList != NULL)  fmFree(hwResIdList);
-        if (ledStateList != NULL) fmFree(ledStateList);
-
-        fmExitThread(thread);
-        return NULL;
+    if ( fmPlatformMgmtTakeSwitchLock(sw) != FM_OK )
+    {
+        MOD_LED_DEBUG("UpdatePortLeds: sw=%d unable to get lock\n", sw);
+        return;
     }
 
-    swCfg = FM_PLAT_GET_SWITCH_CFG(sw);
-
-    portLedPeriodMsec = swCfg->ledPollPeriodMsec;
-    portLedPeriodSec  = portLedPeriodMsec / 1000;
-    portLedPeriodNsec = (portLedPeriodMsec % 1000) * 1000 * 1000;
-    count = 0;
-
-    MOD_LED_DEBUG("sw=%d total num port: %d, pollingPeriod: %d msec\n"
-                  "swCfg->ledBlinkMode %d\n", 
-                  sw, 
-                  ledPortCnt,
-                  portLedPeriodMsec,
-                  swCfg->ledBlinkMode);
+    /* Traffic is sampled every other pass. In the SW_CONTROL blink mode,
+     * the passes in between turn OFF the traffic LEDs turned ON. */
+    sample = ( (++poll->pass % 2) != 0 );
 
-    while (1)
+    for (cnt = 0, numChanged = 0 ; cnt < poll->numPorts ; cnt++)
     {
-        /* To cover the case the switch is brought down */
-        fmGetSwitchState(sw, &up);
-
-        if (!up)
-        {
-            goto ABORT;
-        }
+        portIdx = poll->portList[cnt];
+        portCfg = FM_PLAT_GET_PORT_CFG(sw, portIdx);
+        ledInfo = &GET_PLAT_STATE(sw)->ledInfo[portIdx];
 
-        if (++count % 2)
+        if (ledInfo->linkState)
         {
-            /* Required within GetPortTrafficLedState */
-            PROTECT_SWITCH(sw);
-
-            for (cnt = 0, i = 0 ; cnt < ledPortCnt ; cnt++)
+            if (sample)
             {
-                portIdx = ledPortList[cnt];
-                portCfg = FM_PLAT_GET_PORT_CFG(sw, portIdx);
-                ledInfo = &GET_PLAT_STATE(sw)->ledInfo[portIdx];
-                addPort = FALSE;
-
-                /* Handle only the ports that are UP */
-                if (ledInfo->linkState)
-                {
-                    ledInfo->linkState2 = 1;
-                    GetPortTrafficLedState(sw, portIdx, &trafficState);
-
-                    if (trafficState)
-                    {
-                        /* Indicate presence of traffic */
-                        ledState = FM_PLAT_PORT_LED_BLINK_ON;
-                    }
-                    else
-                    {
-                        /* No traffic then just indicate link UP */
-                        ledState = FM_PLAT_PORT_LED_LINK_UP;
-                    }
-
-                    if ( (swCfg->ledBlinkMode == FM_LED_BLINK_MODE_NO_BLINK ||
-                          swCfg->ledBlinkMode == FM_LED_BLINK_MODE_HW_ASSISTED) &&
-                         (ledInfo->trafficState != trafficState) )
-                    {
-                        /* Provide new LED state set above */
-                        addPort = TRUE;
-                        ledInfo->trafficState = trafficState;
-                    }
-                    else if (swCfg->ledBlinkMode == 
-                                                 FM_LED_BLINK_MODE_SW_CONTROL)
-                    {
-                        if (trafficState)
-                        {
-                            /* Turn ON traffic LED */
-                            addPort = TRUE;
-                            ledInfo->trafficState = trafficState;
-                        }
-                        else if (ledInfo->trafficState != trafficState)
-                        {
-                            /* No traffic then just indicate link UP */
-                            addPort = TRUE;
-                            ledInfo->trafficState = trafficState;
-                        }
-                    }
-                }
-                else if (ledInfo->linkState2)
-                {
-                    /* To avoid race condition with fmPlatformLedSetPortState */
-                    ledInfo->linkState2 = 0;
-                    ledInfo->trafficState = 0;
-                    addPort = TRUE;
-                    ledState = FM_PLAT_PORT_LED_LINK_DOWN;
-                    MOD_LED_DEBUG("Force DOWN port %d hwId=0x%x\n", 
-                                  portCfg->port,
-                                  portCfg->hwResourceId);
-                }
-
-                if (addPort)
-                {
-                    hwResIdList[i]  = portCfg->hwResourceId;
-                    ledStateList[i] = (HW_LED_STATE_SET_STATE(ledState) |
-                                       HW_LED_STATE_SET_SPEED(ledInfo->speed));
-
-                    MOD_LED_DEBUG("Add port %d to list at index %d "
-                                  "hwId=0x%x ledState 0x%x\n", 
-                                  portCfg->port,
-                                  i,
-                                  hwResIdList[i],
-                                  ledStateList[i]);
-                    i++;
-                }
+                GetPortTrafficLedState(sw, portIdx, &trafficState);
+                ledInfo->trafficState = trafficState;
             }
 
-            /* Save the number of port in ledStateList */
-            activePortCnt = i;
-
-            UNPROTECT_SWITCH(sw);
-        }
-        else if (swCfg->ledBlinkMode == FM_LED_BLINK_MODE_SW_CONTROL)
-        {
-            for (cnt = 0, i = 0 ; cnt < activePortCnt ; cnt++)
+            if (!ledInfo->trafficState)
             {
-                ledState = HW_LED_STATE_TO_STATE(ledStateList[cnt]);
-                ledSpeed = HW_LED_STATE_TO_SPEED(ledStateList[cnt]);
-
-                /* Force OFF if there is traffic indication from last poll */
-                if (ledState == FM_PLAT_PORT_LED_BLINK_ON)
-                {
-                    ledState = FM_PLAT_PORT_LED_BLINK_OFF;
-
-                    hwResIdList[i]  = hwResIdList[cnt];
-                    ledStateList[i] = ( HW_LED_STATE_SET_STATE(ledState) |
-                                        HW_LED_STATE_SET_SPEED(ledSpeed) );
-                    MOD_LED_DEBUG("Blink OFF: add to list at idx %d "
-                                  "hwId=0x%x ledState 0x%x\n", 
-                                  i,
-                                  hwResIdList[i],
-                                  ledStateList[i]);
-                    i++;
-                }
+                /* No traffic then just indicate link UP */
+                ledState = FM_PLAT_PORT_LED_LINK_UP;
+            }
+            else if ( swCfg->ledBlinkMode == FM_LED_BLINK_MODE_SW_CONTROL &&
+                      !sample )
+            {
+                ledState = FM_PLAT_PORT_LED_BLINK_OFF;
+            }
+            else
+            {
+                /* Indicate presence of traffic */
+                ledState = FM_PLAT_PORT_LED_BLINK_ON;
             }
-
-            /* Save the number of port in ledStateList */
-            activePortCnt = i;
         }
         else
         {
-            activePortCnt = 0;
+            ledInfo->trafficState = 0;
+            ledState = FM_PLAT_PORT_LED_LINK_DOWN;
         }
 
+        newState = HW_LED_STATE_SET_STATE(ledState) |
+                   HW_LED_STATE_SET_SPEED(ledInfo->speed);
 
-        if (activePortCnt)
+        if (ledInfo->ledStateValid && ledInfo->ledState == newState)
         {
-            if ( fmPlatformMgmtTakeSwitchLock(sw) == FM_OK )
-            {
-                MOD_LED_DEBUG("SetPortLed: port count %d\n", activePortCnt);
-                TAKE_PLAT_I2C_BUS_LOCK(sw);
-                libFunc->SetPortLed(swCfg->swNum,
-                                    hwResIdList,
-                                    activePortCnt,
-                                    ledStateList);
-                DROP_PLAT_I2C_BUS_LOCK(sw);
-                fmPlatformMgmtDropSwitchLock(sw);
-            }
-            else
-            {
-                MOD_LED_DEBUG("LedThread: sw=%d unable to get lock\n", sw);
-            }
+            continue;
         }
 
-ABORT:
-        fmDelay(portLedPeriodSec, portLedPeriodNsec);
+        poll->hwResIdList[numChanged]  = portCfg->hwResourceId;
+        poll->ledStateList[numChanged] = newState;
+        numChanged++;
 
-    }   /* end while (1) */
+        ledInfo->ledState      = newState;
+        ledInfo->ledStateValid = TRUE;
 
-}   /* end fmPlatformLedThread */
+        MOD_LED_DEBUG("Port %d hwId=0x%x ledState 0x%x\n",
+                      portCfg->port,
+                      portCfg->hwResourceId,
+                      newState);
+    }
+
+    if (numChanged)
+    {
+        MOD_LED_DEBUG("SetPortLed: port count %d\n", numChanged);
+        TAKE_PLAT_I2C_BUS_LOCK(sw);
+        libFunc->SetPortLed(swCfg->swNum,
+                            poll->hwResIdList,
+                            numChanged,
+                            poll->ledStateList);
+        DROP_PLAT_I2C_BUS_LOCK(sw);
+    }
+
+    fmPlatformMgmtDropSwitchLock(sw);
+
+}   /* end UpdatePortLeds */
+
+
+
+
+/*****************************************************************************/
+/* HandleLedTimer
+ * \ingroup intPlatformLed
+ *
+ * \desc            LED polling timer callback, run by the API timer task.
+ *
+ * \param[in]       arg is the switch number.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void HandleLedTimer(void *arg)
+{
+    UpdatePortLeds( (fm_int) (fm_uintptr) arg );
+
+}   /* end HandleLedTimer */
 
 
 
@@ -513,23 +409,131 @@ fm_status fmPlatformLedInit(fm_int sw)
             0,
             FM_PLAT_NUM_PORT(sw) * sizeof(fm_platLedInfo) );
 
-    if (FM_PLAT_GET_SWITCH_CFG(sw)->ledPollPeriodMsec <= 0)
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, status);
+
+}   /* end fmPlatformLedInit */
+
+
+
+
+/*****************************************************************************/
+/* fmPlatformLedStart
+ * \ingroup intPlatformLed
+ *
+ * \desc            Starts the LED polling of a switch, on the API timer
+ *                  task. Must be called once the API threads are created.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformLedStart(fm_int sw)
+{
+    fm_platformCfgPort *portCfg;
+    fm_platLedPoll *    poll;
+    fm_timestamp        period;
+    fm_status           status;
+    fm_int              portIdx;
+    fm_int              periodMsec;
+    fm_char             timerName[32];
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM, "sw = %d\n", sw);
+
+    poll = &ledPoll[sw];
+
+    if ( !GET_PLAT_STATE(sw)->ledInfo || poll->timer != NULL )
+    {
+        /* No support, or already started */
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_OK);
+    }
+
+    periodMsec = FM_PLAT_GET_SWITCH_CFG(sw)->ledPollPeriodMsec;
+
+    if (periodMsec <= 0)
     {
         FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
-                       "LED management thread not started\n");
+                       "LED management polling not started\n");
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_OK);
     }
-    else
+
+    /* Pre-allocate the lists used by the polling passes */
+    poll->portList     = fmAlloc( FM_PLAT_NUM_PORT(sw) * sizeof(fm_int) );
+    poll->hwResIdList  = fmAlloc( FM_PLAT_NUM_PORT(sw) * sizeof(fm_uint32) );
+    poll->ledStateList = fmAlloc( FM_PLAT_NUM_PORT(sw) *
+                                  sizeof(fm_platPortLedState) );
+
+    if ( !poll->portList || !poll->hwResIdList || !poll->ledStateList )
     {
-        status = fmCreateThread("LED Thread",
-                                FM_EVENT_QUEUE_SIZE_NONE,
-                                &fmPlatformLedThread,
-                                &(GET_PLAT_STATE(sw)->sw),
-                                &GET_PLAT_STATE(sw)->ledThread);
+        status = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+    }
+
+    /* Create the list of ports that need LED software support */
+    poll->numPorts = 0;
+    poll->pass     = 0;
+
+    for (portIdx = 0 ; portIdx < FM_PLAT_NUM_PORT(sw) ; portIdx++)
+    {
+        portCfg = FM_PLAT_GET_PORT_CFG(sw, portIdx);
+
+        /* Don't add PCIE ports since traffic notification isn't required */
+        if ( !FM_PLAT_PORT_IS_SW_LED(portCfg) ||
+             portCfg->intfType == FM_PLAT_INTF_TYPE_PCIE )
+        {
+            continue;
+        }
+
+        poll->portList[poll->numPorts++] = portIdx;
+        MOD_LED_DEBUG("Add port %d to LED port list\n", portCfg->port);
+    }
+
+    MOD_LED_DEBUG("sw=%d total num port: %d, pollingPeriod: %d msec\n"
+                  "swCfg->ledBlinkMode %d\n",
+                  sw,
+                  poll->numPorts,
+                  periodMsec,
+                  FM_PLAT_GET_SWITCH_CFG(sw)->ledBlinkMode);
+
+    FM_SPRINTF_S(timerName, sizeof(timerName), "platLed%02dTimer", sw);
+
+    status = fmCreateTimer(timerName, fmApiTimerTask, &poll->timer);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+
+    period.sec  = periodMsec / 1000;
+    period.usec = (periodMsec % 1000) * 1000;
+
+    status = fmStartTimer(poll->timer,
+                          &period,
+                          FM_TIMER_REPEAT_FOREVER,
+                          HandleLedTimer,
+                          (void *) (fm_uintptr) sw);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+
+ABORT:
+    if (status != FM_OK)
+    {
+        if (poll->timer != NULL)
+        {
+            fmDeleteTimer(poll->timer);
+            poll->timer = NULL;
+        }
+
+        if (poll->portList != NULL)     fmFree(poll->portList);
+        if (poll->hwResIdList != NULL)  fmFree(poll->hwResIdList);
+        if (poll->ledStateList != NULL) fmFree(poll->ledStateList);
+
+        poll->portList     = NULL;
+        poll->hwResIdList  = NULL;
+        poll->ledStateList = NULL;
+        poll->numPorts     = 0;
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, status);
 
-}   /* end fmPlatformLedInit */
+}   /* end fmPlatformLedStart */
 
 
 
@@ -654,6 +658,10 @@ fm_status fmPlatformLedSetPortState(fm_int  sw,
                             &ledState);
 
         DROP_PLAT_I2C_BUS_LOCK(sw);
+
+        /* Let the polling pass know what the LED shows */
+        GET_PLAT_STATE(sw)->ledInfo[portIdx].ledState      = ledState;
+        GET_PLAT_STATE(sw)->ledInfo[portIdx].ledStateValid = TRUE;
         fmPlatformMgmtDropSwitchLock(sw);
     }
     else
@@ -99,6 +99,7 @@ fm_status fmPlatformLibLoad(fm_int sw)
         fm_platPostInit           PostInitFunc;
         fm_platSetVrmVoltage      SetVrmVoltageFunc;
         fm_platGetVrmVoltage      GetVrmVoltageFunc;
+        fm_platGetXcvrBus         GetXcvrBusFunc;
         void *                    obj;
 
     } alias;
@@ -365,6 +366,19 @@ fm_status fmPlatformLibLoad(fm_int sw)
         }
     }
 
+    /* Not provided by older libraries, the transceivers are then accessed
+     * one at a time */
+    if ( (libHandle >= 0) && !(libCfg->disableFuncIntf & FM_PLAT_DISABLE_GET_XCVR_BUS_FUNC) )
+    {
+        status = fmGetDynamicLoadSymbol(libHandle, FM_PLAT_GET_XCVR_BUS_FUNC_NAME, &funcAddr);
+
+        if (status == FM_OK)
+        {
+            alias.obj           = funcAddr;
+            libFunc->GetXcvrBus = alias.GetXcvrBusFunc;
+        }
+    }
+
     return FM_OK;
 
 }   /* end fmPlatformLibLoad */
@@ -44,6 +44,40 @@
 /* Avoid calling fmAlloc for temporary variable */
 #define MAX_TEMP_PORTS         96
 
+/* Transceiver state read from the hardware, before it is applied */
+typedef struct _fm_xcvrStateScan
+{
+    /* Number of ports scanned */
+    fm_int    numPorts;
+
+    /* Hardware resource ID and port index of each port scanned */
+    fm_uint32 hwResIdList[MAX_TEMP_PORTS];
+    fm_int    hwResIdIdxList[MAX_TEMP_PORTS];
+
+    /* Transceiver state of each port scanned */
+    fm_uint32 xcvrStateValidList[MAX_TEMP_PORTS];
+    fm_uint32 xcvrStateList[MAX_TEMP_PORTS];
+
+} fm_xcvrStateScan;
+
+/* Worker thread reading the transceiver EEPROMs behind one I2C bus */
+typedef struct _fm_xcvrBusWorker
+{
+    /* Switch and I2C bus served */
+    fm_int       sw;
+    fm_int       bus;
+
+    fm_thread    thread;
+
+    /* Signalled when requests are queued */
+    fm_semaphore requestSem;
+
+    /* Indexes of the ports whose EEPROM is to be read */
+    fm_int       numRequests;
+    fm_int *     requests;
+
+} fm_xcvrBusWorker;
+
 
 /*****************************************************************************
  * Global Variables
@@ -58,6 +92,13 @@ static fm_semaphore mgmtSem[FM_MAX_NUM_SWITCHES];
 static fm_bool      pollingPendingTask[FM_MAX_NUM_SWITCHES] = {FALSE};
 static fm_bool      enableMgmt[FM_MAX_NUM_SWITCHES] = {FALSE};
 
+/* I2C bus workers of each switch, only used by its management thread */
+static fm_xcvrBusWorker *busWorkers[FM_MAX_NUM_SWITCHES];
+static fm_int            numBusWorkers[FM_MAX_NUM_SWITCHES] = {0};
+
+/* Signalled by each bus worker once done with its requests */
+static fm_semaphore      busWorkerDoneSem[FM_MAX_NUM_SWITCHES];
+
 
 /*****************************************************************************
  * Local function prototypes.
@@ -546,12 +587,30 @@ static fm_status XcvrReadAndValidateEeprom(fm_int  sw,
     portCfg = FM_PLAT_GET_PORT_CFG(sw, portIndex);
     xcvrInfo = &GET_PLAT_STATE(sw)->xcvrInfo[portIndex];
 
-    status = fmPlatformXcvrEepromRead(sw,
-                                      portCfg->port,
-                                      0,
-                                      0,
-                                      xcvrInfo->eeprom,
-                                      XCVR_EEPROM_CACHE_SIZE);
+    if (xcvrInfo->eepromStaged)
+    {
+        /* Already read by the bus worker */
+        xcvrInfo->eepromStaged = FALSE;
+        status = xcvrInfo->eepromStageStatus;
+
+        if (status == FM_OK)
+        {
+            FM_MEMCPY_S(xcvrInfo->eeprom,
+                        sizeof(xcvrInfo->eeprom),
+                        xcvrInfo->eepromStage,
+                        sizeof(xcvrInfo->eepromStage));
+        }
+    }
+    else
+    {
+        status = fmPlatformXcvrEepromRead(sw,
+                                          portCfg->port,
+                                          0,
+                                          0,
+                                          xcvrInfo->eeprom,
+                                          XCVR_EEPROM_CACHE_SIZE);
+    }
+
     if (status == FM_OK)
     {
         if (retry)
@@ -579,6 +638,9 @@ static fm_status XcvrReadAndValidateEeprom(fm_int  sw,
         {
             xcvrInfo->type = FM_PLATFORM_XCVR_TYPE_UNKNOWN;
             xcvrInfo->cableLength = 0;
+
+            /* The module may not be ready yet, do not keep what it sent */
+            fmPlatformXcvrInvalidateCache(sw, portCfg->port);
         }
 
         MOD_TYPE_DEBUG("Port %d:%d Transceiver type: %s length: %d\n",
@@ -719,46 +781,37 @@ static fm_status NotifyXcvrDetection(fm_int sw, fm_int portIndex)
 
 
 /*****************************************************************************/
-/* XcvrUpdateState
+/* XcvrReadState
  * \ingroup intPlatform
  *
- * \desc            Update transceiver state, normally called when there is an
- *                  interrupt notifying state change, or polling.
+ * \desc            Read the transceiver state of the ports with pending
+ *                  interrupts, or of all ports, without applying it.
  *
  * \param[in]       sw is the switch number.
- * 
- * \param[in]       force is update state even without state change.
  *
  * \param[in]       interrupting indicates interrupts are pending.
  *
- * \return          None.
+ * \param[out]      scan points to caller-allocated storage where this
+ *                  function places the transceiver state read.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the platform library cannot read
+ *                  the transceiver state.
+ * \return          FM_ERR_NOT_FOUND if there is no port to process.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
  *
  *****************************************************************************/
-static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
+static fm_status XcvrReadState(fm_int            sw,
+                               fm_bool           interrupting,
+                               fm_xcvrStateScan *scan)
 {
     fm_status           status;
     fm_int              portIdx;
-    fm_int              lanePortIdx;
-    fm_int              hwResIdIdx;
-    fm_int              port;
-    fm_int              lane;
-    fm_int              epl;
     fm_int              swNum;
     fm_platformLib     *libFunc;
     fm_platformCfgPort *portCfg;
-    fm_platformCfgPort *pCfg;
-    fm_platXcvrInfo *   xcvrInfo;
-    fm_uint32           xcvrSignals;
-    fm_uint32           xcvrState;
-    fm_uint32           xcvrStateValid;
-    fm_uint32           oldState;
-    fm_bool             present;
-    fm_bool             notify;
     fm_int              numPorts;
-    fm_uint32           hwResIdList[MAX_TEMP_PORTS];
-    fm_int              hwResIdIdxList[MAX_TEMP_PORTS];
-    fm_uint32           xcvrStateValidList[MAX_TEMP_PORTS];
-    fm_uint32           xcvrStateList[MAX_TEMP_PORTS];
     fm_int              numPortsIntr;
     fm_int              cnt;
 
@@ -767,11 +820,10 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
     if ( !libFunc->GetPortXcvrState )
     {
         /* No support */
-        return;
+        return FM_ERR_UNSUPPORTED;
     }
 
     swNum = FM_PLAT_GET_SWITCH_CFG(sw)->swNum;
-    xcvrInfo = GET_PLAT_STATE(sw)->xcvrInfo;
 
     numPortsIntr = 0;
     numPorts     = 0;
@@ -780,7 +832,7 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
     {
         TAKE_PLAT_I2C_BUS_LOCK(sw);
         status = libFunc->GetPortIntrPending(swNum,
-                                             hwResIdList,
+                                             scan->hwResIdList,
                                              MAX_TEMP_PORTS,
                                              &numPortsIntr);
         DROP_PLAT_I2C_BUS_LOCK(sw);
@@ -799,14 +851,14 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
                 {
                     portCfg = FM_PLAT_GET_PORT_CFG(sw, portIdx);
 
-                    if (portCfg->hwResourceId == hwResIdList[cnt])
+                    if (portCfg->hwResourceId == scan->hwResIdList[cnt])
                     {
                         if (fmRootPlatform->cfg.debug & CFG_DBG_MOD_INTR)
                         {
                             FM_LOG_PRINT(" %d", portCfg->port);
                         }
 
-                        hwResIdIdxList[cnt] = portIdx;
+                        scan->hwResIdIdxList[cnt] = portIdx;
                         numPorts++;
                     }
                 }
@@ -826,13 +878,13 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
                 FM_LOG_PRINT("HwResourceIdList: ");
                 for (cnt = 0 ; cnt < numPortsIntr ; cnt++)
                 {
-                    FM_LOG_PRINT(" %d", hwResIdList[cnt]);
+                    FM_LOG_PRINT(" %d", scan->hwResIdList[cnt]);
                 }
                 FM_LOG_PRINT("\n");
                 FM_LOG_PRINT("hwResIdIdxList: ");
                 for (cnt = 0 ; cnt < numPorts ; cnt++)
                 {
-                    FM_LOG_PRINT(" %d", hwResIdIdxList[cnt]);
+                    FM_LOG_PRINT(" %d", scan->hwResIdIdxList[cnt]);
                 }
                 FM_LOG_PRINT("\n");
             }
@@ -855,8 +907,8 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
                 continue;
             }
 
-            hwResIdList[numPorts]    = portCfg->hwResourceId;
-            hwResIdIdxList[numPorts] = portIdx;
+            scan->hwResIdList[numPorts]    = portCfg->hwResourceId;
+            scan->hwResIdIdxList[numPorts] = portIdx;
             numPorts++;
         }
     }
@@ -864,7 +916,7 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
     if (numPorts == 0)
     {
         MOD_STATE_DEBUG("Switch %d: No port to process\n", sw);
-        return;
+        return FM_ERR_NOT_FOUND;
     }
 
     /* Get transceiver state */
@@ -872,7 +924,7 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
 
     if ( libFunc->SelectBus )
     {
-        status = libFunc->SelectBus(swNum, FM_PLAT_BUS_XCVR_STATE, hwResIdList[0]);
+        status = libFunc->SelectBus(swNum, FM_PLAT_BUS_XCVR_STATE, scan->hwResIdList[0]);
 
         if (status)
         {
@@ -885,10 +937,10 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
     }
 
     status = libFunc->GetPortXcvrState(swNum,
-                                       hwResIdList,
+                                       scan->hwResIdList,
                                        numPorts,
-                                       xcvrStateValidList,
-                                       xcvrStateList);
+                                       scan->xcvrStateValidList,
+                                       scan->xcvrStateList);
 
     DROP_PLAT_I2C_BUS_LOCK(sw);
 
@@ -897,13 +949,58 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
         MOD_STATE_DEBUG("Switch %d: Failed to read transceiver state. %s\n",
                         sw, 
                         fmErrorMsg(status) );
-        return;
+        return status;
     }
 
+    scan->numPorts = numPorts;
 
-    for (hwResIdIdx = 0 ; hwResIdIdx < numPorts ; hwResIdIdx++)
+    return FM_OK;
+
+}   /* end XcvrReadState */
+
+
+
+
+/*****************************************************************************/
+/* XcvrApplyState
+ * \ingroup intPlatform
+ *
+ * \desc            Apply the transceiver state read by ''XcvrReadState'',
+ *                  notifying the changes.
+ *
+ * \param[in]       sw is the switch number.
+ * 
+ * \param[in]       force is update state even without state change.
+ *
+ * \param[in]       scan points to the transceiver state read.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void XcvrApplyState(fm_int sw, fm_bool force, fm_xcvrStateScan *scan)
+{
+    fm_status           status = FM_OK;
+    fm_int              portIdx;
+    fm_int              lanePortIdx;
+    fm_int              hwResIdIdx;
+    fm_int              port;
+    fm_int              lane;
+    fm_int              epl;
+    fm_platformCfgPort *portCfg;
+    fm_platformCfgPort *pCfg;
+    fm_platXcvrInfo *   xcvrInfo;
+    fm_uint32           xcvrSignals;
+    fm_uint32           xcvrState;
+    fm_uint32           xcvrStateValid;
+    fm_uint32           oldState;
+    fm_bool             present;
+    fm_bool             notify;
+
+    xcvrInfo = GET_PLAT_STATE(sw)->xcvrInfo;
+
+    for (hwResIdIdx = 0 ; hwResIdIdx < scan->numPorts ; hwResIdIdx++)
     {
-        portIdx = hwResIdIdxList[hwResIdIdx];
+        portIdx = scan->hwResIdIdxList[hwResIdIdx];
 
         portCfg = FM_PLAT_GET_PORT_CFG(sw, portIdx);
 
@@ -918,8 +1015,8 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
 
         port = portCfg->port;
 
-        xcvrStateValid = xcvrStateValidList[hwResIdIdx];
-        xcvrState      = xcvrStateList[hwResIdIdx];
+        xcvrStateValid = scan->xcvrStateValidList[hwResIdIdx];
+        xcvrState      = scan->xcvrStateList[hwResIdIdx];
         oldState       = xcvrInfo[portIdx].modState;
         present        = (xcvrState & FM_PLAT_XCVR_PRESENT);
         notify         = FALSE;
@@ -949,6 +1046,7 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
                             sizeof(xcvrInfo->eeprom),
                             0xFF, 
                             sizeof(xcvrInfo->eeprom));
+                fmPlatformXcvrInvalidateCache(sw, port);
             }
 
             if ( (xcvrStateValid & FM_PLAT_XCVR_ENABLE) &&
@@ -1145,7 +1243,37 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
 
         }   /* end if (notify || force) */
 
-    }   /* end for (hwResIdIdx = 0 ; hwResIdIdx < numPorts ; hwResIdIdx++) */
+    }   /* end for (hwResIdIdx = 0 ; hwResIdIdx < scan->numPorts ; hwResIdIdx++) */
+
+}   /* end XcvrApplyState */
+
+
+
+
+/*****************************************************************************/
+/* XcvrUpdateState
+ * \ingroup intPlatform
+ *
+ * \desc            Update transceiver state, normally called when there is an
+ *                  interrupt notifying state change, or polling.
+ *
+ * \param[in]       sw is the switch number.
+ * 
+ * \param[in]       force is update state even without state change.
+ *
+ * \param[in]       interrupting indicates interrupts are pending.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
+{
+    fm_xcvrStateScan scan;
+
+    if (XcvrReadState(sw, interrupting, &scan) == FM_OK)
+    {
+        XcvrApplyState(sw, force, &scan);
+    }
 
 }   /* end XcvrUpdateState */
 
@@ -1461,6 +1589,443 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/* XcvrBusWorkerThread
+ * \ingroup intPlatform
+ *
+ * \desc            Thread reading the transceiver EEPROMs queued by
+ *                  ''PrefetchXcvrEeproms'' for one I2C bus.
+ *
+ * \param[in]       args contains thread-initialization parameters
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void *XcvrBusWorkerThread(void *args)
+{
+    fm_xcvrBusWorker *  worker;
+    fm_platformCfgPort *portCfg;
+    fm_platXcvrInfo *   xcvrInfo;
+    fm_int              portIdx;
+    fm_int              i;
+
+    worker = FM_GET_THREAD_PARAM(fm_xcvrBusWorker, args);
+
+    while (1)
+    {
+        if (fmWaitSemaphore(&worker->requestSem, FM_WAIT_FOREVER) != FM_OK)
+        {
+            continue;
+        }
+
+        for (i = 0 ; i < worker->numRequests ; i++)
+        {
+            portIdx  = worker->requests[i];
+            portCfg  = FM_PLAT_GET_PORT_CFG(worker->sw, portIdx);
+            xcvrInfo = &GET_PLAT_STATE(worker->sw)->xcvrInfo[portIdx];
+
+            /* The management thread holds the I2C bus lock for us */
+            xcvrInfo->eepromStageStatus =
+                fmPlatformXcvrEepromReadNoLock(worker->sw,
+                                               portCfg->port,
+                                               0,
+                                               0,
+                                               xcvrInfo->eepromStage,
+                                               XCVR_EEPROM_CACHE_SIZE);
+            xcvrInfo->eepromStaged = TRUE;
+        }
+
+        worker->numRequests = 0;
+
+        fmSignalSemaphore(&busWorkerDoneSem[worker->sw]);
+    }
+
+    return NULL;
+
+}   /* end XcvrBusWorkerThread */
+
+
+
+
+/*****************************************************************************/
+/* CreateBusWorkers
+ * \ingroup intPlatform
+ *
+ * \desc            Create a worker thread for each I2C bus behind which
+ *                  transceivers sit, when the platform library can tell
+ *                  which bus that is and there are several such buses.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void CreateBusWorkers(fm_int sw)
+{
+    fm_status           status;
+    fm_platformLib *    libFunc;
+    fm_platformCfgPort *portCfg;
+    fm_platXcvrInfo *   xcvrInfo;
+    fm_xcvrBusWorker *  workers;
+    fm_int              numWorkers;
+    fm_int              swNum;
+    fm_int              portIdx;
+    fm_int              bus;
+    fm_int              i;
+
+    libFunc  = FM_PLAT_GET_LIB_FUNCS_PTR(sw);
+    xcvrInfo = GET_PLAT_STATE(sw)->xcvrInfo;
+
+    for (portIdx = 0 ; portIdx < FM_PLAT_NUM_PORT(sw) ; portIdx++)
+    {
+        xcvrInfo[portIdx].busWorker = -1;
+    }
+
+    if ( !libFunc->GetXcvrBus || !libFunc->I2cWriteRead )
+    {
+        /* No support */
+        return;
+    }
+
+    workers = fmAlloc( FM_PLAT_NUM_PORT(sw) * sizeof(fm_xcvrBusWorker) );
+
+    if (workers == NULL)
+    {
+        return;
+    }
+
+    FM_MEMSET_S( workers,
+                 FM_PLAT_NUM_PORT(sw) * sizeof(fm_xcvrBusWorker),
+                 0,
+                 FM_PLAT_NUM_PORT(sw) * sizeof(fm_xcvrBusWorker) );
+
+    swNum      = FM_PLAT_GET_SWITCH_CFG(sw)->swNum;
+    numWorkers = 0;
+
+    for (portIdx = 0 ; portIdx < FM_PLAT_NUM_PORT(sw) ; portIdx++)
+    {
+        portCfg = FM_PLAT_GET_PORT_CFG(sw, portIdx);
+
+        if ( portCfg->hwResourceId == FM_DEFAULT_HW_RES_ID || 
+             !(portCfg->intfType == FM_PLAT_INTF_TYPE_SFPP ||
+               portCfg->intfType == FM_PLAT_INTF_TYPE_QSFP_LANE0) )
+        {
+            continue;
+        }
+
+        if (libFunc->GetXcvrBus(swNum, portCfg->hwResourceId, &bus) != FM_OK)
+        {
+            /* Read by the management thread itself */
+            continue;
+        }
+
+        for (i = 0 ; i < numWorkers ; i++)
+        {
+            if (workers[i].bus == bus)
+            {
+                break;
+            }
+        }
+
+        if (i == numWorkers)
+        {
+            workers[i].sw  = sw;
+            workers[i].bus = bus;
+            numWorkers++;
+        }
+
+        xcvrInfo[portIdx].busWorker = i;
+    }
+
+    if (numWorkers < 2)
+    {
+        /* Nothing to access in parallel */
+        numWorkers = 0;
+        status     = FM_OK;
+        goto ABORT;
+    }
+
+    status = fmCreateSemaphore("xcvrBusWorkerDoneSem",
+                               FM_SEM_COUNTING,
+                               &busWorkerDoneSem[sw],
+                               0);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+
+    for (i = 0 ; i < numWorkers ; i++)
+    {
+        workers[i].requests = fmAlloc( FM_PLAT_NUM_PORT(sw) * sizeof(fm_int) );
+
+        if (workers[i].requests == NULL)
+        {
+            status = FM_ERR_NO_MEM;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+        }
+
+        status = fmCreateSemaphore("xcvrBusWorkerSem",
+                                   FM_SEM_BINARY,
+                                   &workers[i].requestSem,
+                                   0);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+
+        status = fmCreateThread("Xcvr Bus Worker",
+                                FM_EVENT_QUEUE_SIZE_NONE,
+                                &XcvrBusWorkerThread,
+                                &workers[i],
+                                &workers[i].thread);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+    }
+
+    busWorkers[sw]    = workers;
+    numBusWorkers[sw] = numWorkers;
+
+    MOD_STATE_DEBUG("Switch %d: Reading transceivers on %d I2C buses "
+                    "in parallel\n",
+                    sw,
+                    numWorkers);
+
+    return;
+
+ABORT:
+    if (status != FM_OK)
+    {
+        /* Threads already created just stay idle */
+        FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
+                     "Switch %d: Unable to create I2C bus workers: %s\n",
+                     sw,
+                     fmErrorMsg(status));
+    }
+    else
+    {
+        fmFree(workers);
+    }
+
+    for (portIdx = 0 ; portIdx < FM_PLAT_NUM_PORT(sw) ; portIdx++)
+    {
+        xcvrInfo[portIdx].busWorker = -1;
+    }
+
+}   /* end CreateBusWorkers */
+
+
+
+
+/*****************************************************************************/
+/* PrefetchXcvrEeproms
+ * \ingroup intPlatform
+ *
+ * \desc            Read the EEPROMs of the given ports in advance, without
+ *                  the switch lock, each I2C bus being served by its own
+ *                  worker thread in parallel with the others. The content
+ *                  read is used by the next ''XcvrReadAndValidateEeprom''
+ *                  on each port.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       portList points to the indexes of the ports to read.
+ *
+ * \param[in]       numPorts is the number of entries in portList.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void PrefetchXcvrEeproms(fm_int sw, fm_int *portList, fm_int numPorts)
+{
+    fm_xcvrBusWorker *workers;
+    fm_xcvrBusWorker *worker;
+    fm_platXcvrInfo * xcvrInfo;
+    fm_int            numActive;
+    fm_int            i;
+
+    if ( (numBusWorkers[sw] == 0) || (numPorts < 2) )
+    {
+        /* Read one at a time by the management thread */
+        return;
+    }
+
+    workers  = busWorkers[sw];
+    xcvrInfo = GET_PLAT_STATE(sw)->xcvrInfo;
+
+    for (i = 0 ; i < numPorts ; i++)
+    {
+        if (xcvrInfo[portList[i]].busWorker >= 0)
+        {
+            worker = &workers[xcvrInfo[portList[i]].busWorker];
+            worker->requests[worker->numRequests++] = portList[i];
+        }
+    }
+
+    /* Keep the other users of the I2C buses out while the workers, one per
+     * bus, access them */
+    TAKE_PLAT_I2C_BUS_LOCK(sw);
+
+    numActive = 0;
+
+    for (i = 0 ; i < numBusWorkers[sw] ; i++)
+    {
+        if (workers[i].numRequests > 0)
+        {
+            fmSignalSemaphore(&workers[i].requestSem);
+            numActive++;
+        }
+    }
+
+    while (numActive-- > 0)
+    {
+        fmWaitSemaphore(&busWorkerDoneSem[sw], FM_WAIT_FOREVER);
+    }
+
+    DROP_PLAT_I2C_BUS_LOCK(sw);
+
+}   /* end PrefetchXcvrEeproms */
+
+
+
+
+/*****************************************************************************/
+/* ClearStagedEeproms
+ * \ingroup intPlatform
+ *
+ * \desc            Discard the EEPROM content read in advance and not used,
+ *                  so that it is never mistaken for a later read.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ClearStagedEeproms(fm_int sw)
+{
+    fm_int portIdx;
+
+    for (portIdx = 0 ; portIdx < FM_PLAT_NUM_PORT(sw) ; portIdx++)
+    {
+        GET_PLAT_STATE(sw)->xcvrInfo[portIdx].eepromStaged = FALSE;
+    }
+
+}   /* end ClearStagedEeproms */
+
+
+
+
+/*****************************************************************************/
+/* AddEepromRead
+ * \ingroup intPlatform
+ *
+ * \desc            Add a port to a list of EEPROMs to read, unless it is
+ *                  already in it or the list is full.
+ *
+ * \param[in,out]   portList points to the list of port indexes, of
+ *                  MAX_TEMP_PORTS entries.
+ *
+ * \param[in,out]   numPorts points to the number of entries in portList.
+ *
+ * \param[in]       portIdx is the index of the port to add.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void AddEepromRead(fm_int *portList, fm_int *numPorts, fm_int portIdx)
+{
+    fm_int i;
+
+    for (i = 0 ; i < *numPorts ; i++)
+    {
+        if (portList[i] == portIdx)
+        {
+            return;
+        }
+    }
+
+    if (*numPorts < MAX_TEMP_PORTS)
+    {
+        portList[(*numPorts)++] = portIdx;
+    }
+
+}   /* end AddEepromRead */
+
+
+
+
+/*****************************************************************************/
+/* GetEepromReads
+ * \ingroup intPlatform
+ *
+ * \desc            List the ports whose EEPROM the next pass of the
+ *                  management thread will read: those retrying to read it
+ *                  and, if a scan is given, those where ''XcvrApplyState''
+ *                  will find a module newly present and enabled.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       retries is TRUE if the ports retrying to read their
+ *                  EEPROM are to be listed.
+ *
+ * \param[in]       scan points to the transceiver state read, or is NULL.
+ *
+ * \param[out]      portList points to caller-allocated storage of
+ *                  MAX_TEMP_PORTS entries where this function places the
+ *                  port indexes.
+ *
+ * \return          The number of entries placed in portList.
+ *
+ *****************************************************************************/
+static fm_int GetEepromReads(fm_int            sw,
+                             fm_bool           retries,
+                             fm_xcvrStateScan *scan,
+                             fm_int *          portList)
+{
+    fm_platXcvrInfo *xcvrInfo;
+    fm_uint32        changed;
+    fm_uint32        valid;
+    fm_uint32        state;
+    fm_int           numPorts = 0;
+    fm_int           portIdx;
+    fm_int           i;
+
+    xcvrInfo = GET_PLAT_STATE(sw)->xcvrInfo;
+
+    if (numBusWorkers[sw] == 0)
+    {
+        return 0;
+    }
+
+    if (retries)
+    {
+        for (portIdx = 0 ; portIdx < FM_PLAT_NUM_PORT(sw) ; portIdx++)
+        {
+            if (xcvrInfo[portIdx].eepromReadRetries > 0)
+            {
+                AddEepromRead(portList, &numPorts, portIdx);
+            }
+        }
+    }
+
+    for (i = 0 ; (scan != NULL) && (i < scan->numPorts) ; i++)
+    {
+        portIdx = scan->hwResIdIdxList[i];
+        valid   = scan->xcvrStateValidList[i];
+        state   = scan->xcvrStateList[i];
+        changed = xcvrInfo[portIdx].modState ^ state;
+
+        /* Same conditions as in XcvrApplyState */
+        if ( ( ( (valid & FM_PLAT_XCVR_PRESENT) &&
+                 (changed & FM_PLAT_XCVR_PRESENT) ) ||
+               ( (valid & FM_PLAT_XCVR_ENABLE) &&
+                 (changed & FM_PLAT_XCVR_ENABLE) ) ) &&
+             (state & FM_PLAT_XCVR_PRESENT) &&
+             (state & FM_PLAT_XCVR_ENABLE) )
+        {
+            AddEepromRead(portList, &numPorts, portIdx);
+        }
+    }
+
+    return numPorts;
+
+}   /* end GetEepromReads */
+
+
+
+
 /*****************************************************************************/
 /* fmPlatformMgmtThread
  * \ingroup intPlatform
@@ -1481,6 +2046,11 @@ static void *fmPlatformMgmtThread(void *args)
     fm_timestamp timeout;
     fm_uint      xcvrPollPeriodMsec;
     fm_bool      interrupt;
+    fm_bool      polling;
+    fm_bool      scanned;
+    fm_int       numReads;
+    fm_int       readList[MAX_TEMP_PORTS];
+    fm_xcvrStateScan scan;
 
     /* grab arguments */
     thread = FM_GET_THREAD_HANDLE(args);
@@ -1523,6 +2093,8 @@ static void *fmPlatformMgmtThread(void *args)
         timeout.usec = 0;        
     }
 
+    CreateBusWorkers(sw);
+
     while (1)
     {
         /* Handle interrupt and polling */
@@ -1537,12 +2109,36 @@ static void *fmPlatformMgmtThread(void *args)
             continue;
         }
 
+        /**************************************************
+         * Read the transceiver state and the EEPROMs about
+         * to be needed without the switch lock, the EEPROMs
+         * behind different I2C buses in parallel. The switch
+         * lock is only taken to apply the results.
+         **************************************************/
+
+        polling = (!interrupt || pollingPendingTask[sw]);
+        scanned = FALSE;
+
+        if (interrupt || pollXcvrStatus)
+        {
+            /* Read SFP+ and QSFP state */
+            scanned = (XcvrReadState(sw, interrupt, &scan) == FM_OK);
+        }
+
+        numReads = GetEepromReads(sw,
+                                  polling,
+                                  scanned ? &scan : NULL,
+                                  readList);
+
+        PrefetchXcvrEeproms(sw, readList, numReads);
+
         if (fmPlatformMgmtTakeSwitchLock(sw) != FM_OK)
         {
+            ClearStagedEeproms(sw);
             continue;
         }
 
-        if (!interrupt || pollingPendingTask[sw])
+        if (polling)
         {
             /* Do polling task here */
             pollingPendingTask[sw] = FALSE;
@@ -1554,12 +2150,13 @@ static void *fmPlatformMgmtThread(void *args)
             XcvrRetryConfig(sw);
         }
 
-        if (interrupt || pollXcvrStatus)
+        if (scanned)
         {
-            /* Read SFP+ and QSFP state */
-            XcvrUpdateState( sw, FALSE, interrupt );
+            XcvrApplyState(sw, FALSE, &scan);
         }
 
+        ClearStagedEeproms(sw);
+
         fmPlatformMgmtDropSwitchLock(sw);
 
     }   /* end while (1) */
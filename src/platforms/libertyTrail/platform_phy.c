@@ -263,11 +263,74 @@ static fm_status PhyI2cWriteRead(fm_uintptr handle,
 
 
 
+/*****************************************************************************/
+/** GetGN2412Cfg
+ * \ingroup intPlatform
+ *
+ * \desc            Builds the GN2412 retimer configuration from the
+ *                  platform configuration.
+ *
+ * \param[in]       sw is the switch number
+ *
+ * \param[in]       phyIdx is the retimer number
+ *
+ * \param[out]      cfg points to caller-allocated storage where the
+ *                  configuration is written.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status GetGN2412Cfg(fm_int sw, fm_int phyIdx, fm_gn2412Cfg *cfg)
+{
+    fm_platformCfgPhy *phyCfg;
+    fm_status          status;
+
+    phyCfg = FM_PLAT_GET_PHY_CFG(sw, phyIdx);
+
+    /* Get the default timebase 0 configuration for 156.25MHz / 5156,25MHz */
+    status = fmUtilGN2412GetTimebaseCfg(0,
+                                        FM_GN2412_REFCLK_156P25,
+                                        FM_GN2412_OUTFREQ_5156P25,
+                                        &cfg->timebase[0]);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY, status);
+
+    /* Get the default timebase 1 configuration for 156.25MHz / 5156,25MHz */
+    status = fmUtilGN2412GetTimebaseCfg(1,
+                                        FM_GN2412_REFCLK_156P25,
+                                        FM_GN2412_OUTFREQ_5156P25,
+                                        &cfg->timebase[1]);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY, status);
+
+    /* Select refClk_1 input pin for both timebases */
+    cfg->timebase[0].refClkSel = 1;
+    cfg->timebase[1].refClkSel = 1;
+
+    cfg->setTxEq =
+        (FM_PLAT_GET_SWITCH_CFG(sw)->enablePhyDeEmphasis) ? TRUE : FALSE;
+
+    FM_MEMCPY_S(cfg->lane,
+                sizeof(cfg->lane),
+                phyCfg->gn2412Lane,
+                sizeof(phyCfg->gn2412Lane));
+
+ABORT:
+    return status;
+
+}   /* end GetGN2412Cfg */
+
+
+
+
 /*****************************************************************************/
 /** InitializeGN2412
  * \ingroup intPlatform
  *
- * \desc            Initializes the GN2412 retimer
+ * \desc            Checks the GN2412 retimer firmware and starts its
+ *                  initialization. The initialization is completed by
+ *                  CompleteGN2412Init once every retimer has been started,
+ *                  so that their timebase calibrations overlap.
  *
  * \param[in]       sw is the switch number
  *
@@ -368,36 +431,85 @@ static fm_status InitializeGN2412(fm_int sw, fm_int phyIdx)
         FM_LOG_ABORT(FM_LOG_CAT_PHY, status);
     }
 
-    /* Get the default timebase 0 configuration for 156.25MHz / 5156,25MHz */
-    status = fmUtilGN2412GetTimebaseCfg(0,
-                                        FM_GN2412_REFCLK_156P25,
-                                        FM_GN2412_OUTFREQ_5156P25,
-                                        &cfg.timebase[0]);
+    status = GetGN2412Cfg(sw, phyIdx, &cfg);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY, status);
 
-    /* Get the default timebase 1 configuration for 156.25MHz / 5156,25MHz */
-    status = fmUtilGN2412GetTimebaseCfg(1,
-                                        FM_GN2412_REFCLK_156P25,
-                                        FM_GN2412_OUTFREQ_5156P25,
-                                        &cfg.timebase[1]);
+    status = fmUtilGN2412InitializeStart((fm_uintptr) sw,
+                                         PhyI2cWriteRead,
+                                         phyCfg->addr,
+                                         &cfg);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY, status);
 
-    /* Select refClk_1 input pin for both timebases */
-    cfg.timebase[0].refClkSel = 1;
-    cfg.timebase[1].refClkSel = 1;
+ABORT:
+    DROP_PLAT_I2C_BUS_LOCK(sw);
 
-    cfg.setTxEq = 
-        (FM_PLAT_GET_SWITCH_CFG(sw)->enablePhyDeEmphasis) ? TRUE : FALSE;
+    if (GET_PLAT_PROC_STATE(sw)->fileLock >= 0)
+    {
+        fmUtilDeviceLockDrop(GET_PLAT_PROC_STATE(sw)->fileLock);
+    }
 
-    FM_MEMCPY_S(cfg.lane, 
-                sizeof(cfg.lane), 
-                phyCfg->gn2412Lane, 
-                sizeof(phyCfg->gn2412Lane));
+    fmPlatformMgmtDropSwitchLock(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PHY, status);
+
+}   /* end InitializeGN2412 */
+
+
+
+
+/*****************************************************************************/
+/** CompleteGN2412Init
+ * \ingroup intPlatform
+ *
+ * \desc            Completes the initialization of a GN2412 retimer
+ *                  started by InitializeGN2412.
+ *
+ * \param[in]       sw is the switch number
+ *
+ * \param[in]       phyIdx is the retimer number
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status CompleteGN2412Init(fm_int sw, fm_int phyIdx)
+{
+    fm_platformCfgPhy *  phyCfg;
+    fm_status            status;
+    fm_gn2412Cfg         cfg;
+    fm_platformLib *     libFunc;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PHY, "sw=%d, phyIdx=%d\n", sw, phyIdx);
+
+    phyCfg = FM_PLAT_GET_PHY_CFG(sw, phyIdx);
+    libFunc = FM_PLAT_GET_LIB_FUNCS_PTR(sw);
+
+    status = GetGN2412Cfg(sw, phyIdx, &cfg);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PHY, status);
 
-    status = fmUtilGN2412Initialize((fm_uintptr) sw,
-                                    PhyI2cWriteRead,
-                                    phyCfg->addr,
-                                    &cfg);
+    if ((status = fmPlatformMgmtTakeSwitchLock(sw)) != FM_OK)
+    {
+         FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, status);
+    }
+
+    if (GET_PLAT_PROC_STATE(sw)->fileLock >= 0)
+    {
+        fmUtilDeviceLockTake(GET_PLAT_PROC_STATE(sw)->fileLock);
+    }
+
+    TAKE_PLAT_I2C_BUS_LOCK(sw);
+
+    if ( libFunc->SelectBus )
+    {
+        status = libFunc->SelectBus(sw, FM_PLAT_BUS_PHY, phyCfg->hwResourceId);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+    }
+
+    status = fmUtilGN2412InitializeComplete((fm_uintptr) sw,
+                                            PhyI2cWriteRead,
+                                            phyCfg->addr,
+                                            &cfg);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY, status);
 
 ABORT:
@@ -412,7 +524,7 @@ ABORT:
 
     FM_LOG_EXIT(FM_LOG_CAT_PHY, status);
 
-}   /* end InitializeGN2412 */
+}   /* end CompleteGN2412Init */
 
 
 /*****************************************************************************
@@ -462,6 +574,18 @@ fm_status fmInitializePhysicalInterfaces(fm_int     sw,
         }
     }
 
+    /* Every retimer is calibrating its timebases, complete them in turn */
+    for ( phyIdx = 0 ; phyIdx < FM_PLAT_NUM_PHY(sw) ; phyIdx++ )
+    {
+        phyCfg = FM_PLAT_GET_PHY_CFG(sw, phyIdx);
+
+        if ( phyCfg->model == FM_PLAT_PHY_GN2412 )
+        {
+            status = CompleteGN2412Init(sw, phyIdx);
+            FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PHY, status);
+        }
+    }
+
     /* Assume first one is for CPU */
     for (portIdx = 1 ; portIdx < FM_PLAT_NUM_PORT(sw) ; portIdx++)
     {
@@ -135,6 +135,7 @@
 #define DBG_I2C_MUX                 (1<<3)
 #define DBG_PORT_LED                (1<<4)
 #define DBG_DUMP_CFG                (1<<5)
+#define DBG_NO_MUX_CACHE            (1<<6)
 
 #define LED_USAGE_LINK              (1<<0)
 #define LED_USAGE_TRAFFIC           (1<<1)
@@ -202,6 +203,10 @@ typedef struct
     /* default or disabled value */
     fm_byte         initVal;
 
+    /* Value last written to the mux, valid when valueCached is set */
+    fm_byte         value;
+    fm_bool         valueCached;
+
 } fm_pcaMux;
 
 
@@ -472,9 +477,6 @@ typedef struct
 
 typedef struct
 {
-    /* Current I2C bus selected by fmPlatformLibSelectBus */
-    fm_uint         selectedBus[FM_MAX_NUM_SWITCHES];
-
     /* I2C Device config */
     fm_uint         numBus;
     fm_i2cCfg       i2c[NUM_I2C_BUS];
@@ -509,6 +511,15 @@ typedef struct
     /* debug control */
     fm_uint         debug;
 
+    /* Whether mux values may be cached, i.e. no other application or I2C
+     * master can change them behind our back */
+    fm_bool         muxCacheable;
+
+    /* Number of mux writes issued, and skipped because the mux was
+     * already set to the requested value */
+    fm_uint64       muxWrites;
+    fm_uint64       muxWritesSkipped;
+
 } fm_hwCfg;
 
 
@@ -546,6 +557,10 @@ typedef union
  *****************************************************************************/
 static fm_hwCfg hwCfg;
 
+/* Current I2C bus selected by fmPlatformLibSelectBus. Kept per thread, so
+ * that threads accessing different I2C buses keep their own selection. */
+static __thread fm_uint selectedBus[FM_MAX_NUM_SWITCHES];
+
 static fm_platformStrMap ledTypeMap[] =
 {
     { "NONE", LED_TYPE_NONE },
@@ -620,6 +635,7 @@ static fm_platformStrMap debugMap[] =
     { "I2C_MUX",        DBG_I2C_MUX       },
     { "PORT_LED",       DBG_PORT_LED      },
     { "DUMP_CFG",       DBG_DUMP_CFG      },
+    { "NO_MUX_CACHE",   DBG_NO_MUX_CACHE  },
 };
 
 static fm_platformStrMap hwResourceTypeMap[] =
@@ -1992,6 +2008,7 @@ static fm_status LoadTlv(fm_byte *tlv)
         for (idx = 0 ; idx < hwCfg.numPcaMux ; idx++)
         {
             hwCfg.pcaMux[idx].parentMuxIdx = UINT_NOT_USED;
+            hwCfg.pcaMux[idx].valueCached  = FALSE;
         }
 
         break;
@@ -3053,6 +3070,102 @@ static void DumpConfig(void)
 
 
 
+/*****************************************************************************/
+/* WriteMux
+ * \ingroup intPlatform
+ *
+ * \desc            Set the channel selection of a PCA mux, unless the mux
+ *                  is known to be set to that value already.
+ *
+ * \param[in]       pcaMux points to the pca mux structure.
+ *
+ * \param[in]       value is the channel selection to write.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status WriteMux(fm_pcaMux *pcaMux, fm_byte value)
+{
+    fm_i2cCfg *i2c;
+    fm_status  status;
+    fm_byte    data[1];
+    fm_bool    useCache;
+
+    useCache = hwCfg.muxCacheable && !(hwCfg.debug & DBG_NO_MUX_CACHE);
+
+    if (useCache && pcaMux->valueCached && pcaMux->value == value)
+    {
+        FM_ATOMIC_ADD_RELAXED(&hwCfg.muxWritesSkipped, 1);
+        return FM_OK;
+    }
+
+    if (hwCfg.debug & DBG_I2C_MUX)
+    {
+        if (value)
+        {
+            FM_LOG_PRINT("Set Mux 0x%x => 0x%x\n", pcaMux->addr, value);
+        }
+        else
+        {
+            FM_LOG_PRINT("Clear Mux 0x%x\n", pcaMux->addr);
+        }
+    }
+
+    i2c = &hwCfg.i2c[pcaMux->bus];
+    data[0] = value;
+    status = i2c->writeReadFunc(i2c->handle, pcaMux->addr, data, 1, 0);
+    FM_ATOMIC_ADD_RELAXED(&hwCfg.muxWrites, 1);
+
+    /* The mux state is unknown after a failed write */
+    pcaMux->value       = value;
+    pcaMux->valueCached = useCache && (status == FM_OK);
+
+    return status;
+
+}   /* end WriteMux */
+
+
+
+
+/*****************************************************************************/
+/* IsMuxOnPath
+ * \ingroup intPlatform
+ *
+ * \desc            Indicates whether a mux is the given mux or one of its
+ *                  parents.
+ *
+ * \param[in]       idx is the index of the mux to look for.
+ *
+ * \param[in]       muxIdx is the index of the last mux of the path.
+ *
+ * \return          TRUE if the mux is on the path.
+ *
+ *****************************************************************************/
+static fm_bool IsMuxOnPath(fm_uint idx, fm_uint muxIdx)
+{
+    fm_uint depth;
+
+    for (depth = 0 ;
+         muxIdx < hwCfg.numPcaMux && depth < hwCfg.numPcaMux ;
+         depth++)
+    {
+        if (muxIdx == idx)
+        {
+            return TRUE;
+        }
+
+        muxIdx = hwCfg.pcaMux[muxIdx].parentMuxIdx;
+    }
+
+    return FALSE;
+
+}   /* end IsMuxOnPath */
+
+
+
+
 /*****************************************************************************/
 /* SetupMuxPathRcrsv
  * \ingroup intPlatform
@@ -3079,7 +3192,6 @@ static fm_status SetupMuxPathRcrsv(fm_uint muxIdx,
     fm_pcaMux *pcaMux;
     fm_pcaMux *mux;
     fm_status  status;
-    fm_byte    data[1];
     fm_uint    cnt;
 
     if ( muxIdx == UINT_NOT_USED)
@@ -3126,27 +3238,13 @@ static fm_status SetupMuxPathRcrsv(fm_uint muxIdx,
                      mux->model != PCA_MUX_9541 )
                 {
                     /* Disable that mux */
-                    data[0] = 0;
-                    if (hwCfg.debug & DBG_I2C_MUX)
-                    {
-                        FM_LOG_PRINT("Clear Mux 0x%x\n", mux->addr);
-                    }
-                    status = i2c->writeReadFunc(i2c->handle,
-                                                mux->addr,
-                                                data,
-                                                1,
-                                                0);
+                    status = WriteMux(mux, 0);
                     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
                 }
             }
         }
 
-        data[0] = muxValue;
-        if (hwCfg.debug & DBG_I2C_MUX)
-        {
-            FM_LOG_PRINT("Set Mux 0x%x => 0x%x\n", pcaMux->addr, muxValue);
-        }
-        status = i2c->writeReadFunc(i2c->handle, pcaMux->addr, data, 1, 0);
+        status = WriteMux(pcaMux, muxValue);
     }
 
     return status;
@@ -3174,9 +3272,7 @@ static fm_status SetupMuxPathRcrsv(fm_uint muxIdx,
 static fm_status SetupMuxPath(fm_uint muxIdx, fm_uint muxValue)
 {
     fm_status  status;
-    fm_i2cCfg *i2c;
     fm_pcaMux *pcaMux;
-    fm_byte    data[1];
     fm_uint    cnt;
 
     if (muxIdx == UINT_NOT_USED)
@@ -3184,10 +3280,11 @@ static fm_status SetupMuxPath(fm_uint muxIdx, fm_uint muxValue)
         return FM_OK;
     }
 
-    /* Disable all top level mux first */
+    /* Disable all top level mux first. The top level mux of the path is
+     * left alone since it is set below anyway. */
     for (cnt = 0 ; cnt < hwCfg.numPcaMux; cnt++)
     {
-        if (cnt == muxIdx)
+        if ( IsMuxOnPath(cnt, muxIdx) )
         {
             continue;
         }
@@ -3200,13 +3297,7 @@ static fm_status SetupMuxPath(fm_uint muxIdx, fm_uint muxValue)
         {
             if (pcaMux->model != PCA_MUX_9541)
             {
-                i2c = &hwCfg.i2c[pcaMux->bus];
-                data[0] = 0;
-                if (hwCfg.debug & DBG_I2C_MUX)
-                {
-                    FM_LOG_PRINT("Clear Mux 0x%x\n", pcaMux->addr);
-                }
-                status = i2c->writeReadFunc(i2c->handle, pcaMux->addr, data, 1, 0);
+                status = WriteMux(pcaMux, 0);
                 FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
             }
         }
@@ -3249,8 +3340,19 @@ static fm_status InitPca(void)
 
     FM_LOG_ENTRY_NOARGS(FM_LOG_CAT_PLATFORM);
 
+    /* Another application sharing the file lock, or another I2C master
+     * behind a PCA9541, may reprogram the muxes. */
+    hwCfg.muxCacheable = (hwCfg.fileLock < 0);
+
     for (cnt = 0 ; cnt < hwCfg.numPcaMux; cnt++)
     {
+        hwCfg.pcaMux[cnt].valueCached = FALSE;
+
+        if (hwCfg.pcaMux[cnt].model == PCA_MUX_9541)
+        {
+            hwCfg.muxCacheable = FALSE;
+        }
+
         switch (hwCfg.pcaMux[cnt].model)
         {
             case PCA_MUX_9541:
@@ -3598,6 +3700,27 @@ static void DumpPca(void)
 {
     fm_uint cnt;
 
+    for (cnt = 0 ; cnt < hwCfg.numPcaMux; cnt++)
+    {
+        if (hwCfg.pcaMux[cnt].valueCached)
+        {
+            FM_LOG_PRINT("PCA MUX #%d at 0x%x: 0x%02x\n",
+                         cnt,
+                         hwCfg.pcaMux[cnt].addr,
+                         hwCfg.pcaMux[cnt].value);
+        }
+        else
+        {
+            FM_LOG_PRINT("PCA MUX #%d at 0x%x: unknown\n",
+                         cnt,
+                         hwCfg.pcaMux[cnt].addr);
+        }
+    }
+
+    FM_LOG_PRINT("PCA MUX writes: %llu, skipped: %llu\n\n",
+                 (unsigned long long) hwCfg.muxWrites,
+                 (unsigned long long) hwCfg.muxWritesSkipped);
+
     for (cnt = 0 ; cnt < hwCfg.numPcaIo; cnt++)
     {
         FM_LOG_PRINT("##### PCA IO #%d at 0x%x #####\n",
@@ -4062,6 +4185,7 @@ fm_status fmPlatformLibDebugDump(fm_int    sw,
                                  fm_text   args)
 {
     fm_status status = FM_OK;
+    fm_uint   cnt;
 
     FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                  "sw=%d resId=%d action=%s\n",
@@ -4096,6 +4220,23 @@ fm_status fmPlatformLibDebugDump(fm_int    sw,
         else
             hwCfg.debug &= ~DBG_I2C_MUX;
     }
+    else if (strncasecmp(action, "muxCache", 8) == 0)
+    {
+        if (strncasecmp(args, "off", 3) == 0)
+        {
+            hwCfg.debug |= DBG_NO_MUX_CACHE;
+        }
+        else
+        {
+            hwCfg.debug &= ~DBG_NO_MUX_CACHE;
+        }
+
+        /* Forget the mux states either way */
+        for (cnt = 0 ; cnt < hwCfg.numPcaMux ; cnt++)
+        {
+            hwCfg.pcaMux[cnt].valueCached = FALSE;
+        }
+    }
     else if (strncasecmp(action, "skipSelBus", 10) == 0)
     {
         if (strncasecmp(args, "on", 2) == 0)
@@ -4115,6 +4256,7 @@ fm_status fmPlatformLibDebugDump(fm_int    sw,
         printf("Available Commands:\n");
         printf("    dumpPca             - Dump PCA registers\n");
         printf("    dumpConfig          - Dump configuration\n");
+        printf("    muxCache on|off     - Skip writes to muxes already set\n");
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, status);
@@ -4213,7 +4355,7 @@ fm_status fmPlatformLibSelectBus(fm_int    sw,
     }
 
     /* Default to 0 */
-    hwCfg.selectedBus[sw] = 0;
+    selectedBus[sw] = 0;
 
     if ( busType == FM_PLAT_BUS_NUMBER )
     {
@@ -4222,7 +4364,7 @@ fm_status fmPlatformLibSelectBus(fm_int    sw,
 
         if ( status == FM_OK )
         {
-            hwCfg.selectedBus[sw] = hwResourceId;
+            selectedBus[sw] = hwResourceId;
         }
         else
         {
@@ -4261,7 +4403,7 @@ fm_status fmPlatformLibSelectBus(fm_int    sw,
         {
             /* Means the IO is not behind a MUX and located directly on the
                main I2C branch. So use the IO bus number for bus selection */
-            hwCfg.selectedBus[sw] = hwCfg.pcaIo[idx].dev.bus;
+            selectedBus[sw] = hwCfg.pcaIo[idx].dev.bus;
         }
     }
     else if (busType == FM_PLAT_BUS_XCVR_EEPROM)
@@ -4285,7 +4427,7 @@ fm_status fmPlatformLibSelectBus(fm_int    sw,
             {
                 /* Means the IO is not behind a MUX and located directly on the
                    main I2C branch. So use the IO bus number for bus selection */
-                hwCfg.selectedBus[sw] = hwCfg.pcaIo[idx].dev.bus;
+                selectedBus[sw] = hwCfg.pcaIo[idx].dev.bus;
             }
 
             /* Enable I2C select bit only on the one selected
@@ -4352,7 +4494,7 @@ fm_status fmPlatformLibSelectBus(fm_int    sw,
                 /* Means the PHY is not behind a MUX and located directly on
                    the main I2C branch. So use the PHY bus number for bus
                    selection */
-                hwCfg.selectedBus[sw] = hwResId->phy.bus;
+                selectedBus[sw] = hwResId->phy.bus;
             }
         }
         else if (hwResId->phy.busSelType == BUS_SEL_TYPE_PCA_IO)
@@ -4367,7 +4509,7 @@ fm_status fmPlatformLibSelectBus(fm_int    sw,
 
     if ( muxIdx != UINT_NOT_USED && muxIdx < hwCfg.numPcaMux )
     {
-        hwCfg.selectedBus[sw] = hwCfg.pcaMux[muxIdx].bus;
+        selectedBus[sw] = hwCfg.pcaMux[muxIdx].bus;
         status = SetupMuxPath(muxIdx, muxValue);
     }
 
@@ -4380,6 +4522,99 @@ fm_status fmPlatformLibSelectBus(fm_int    sw,
 
 
 
+/*****************************************************************************/
+/* fmPlatformLibGetXcvrBus
+ * \ingroup platformLib
+ *
+ * \desc            Returns the I2C bus behind which the transceiver EEPROM of
+ *                  a port sits, so that the caller can access transceivers
+ *                  on different buses from different threads. Buses opening
+ *                  the same I2C device are reported as the same bus.
+ *
+ * \param[in]       sw is the switch number, as specified by property
+ *                  api.platform.config.switch.n.switchNumber.
+ *
+ * \param[in]       hwResourceId is the hardware resource id to identify
+ *                  a port, as specified by property
+ *                  api.platform.config.switch.n.portIndex.port.hwResourceId.
+ *
+ * \param[out]      bus points to caller-allocated storage where this
+ *                  function places the bus number.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_UNSUPPORTED if selecting the transceiver bus of
+ *                  the port also affects other ports, as with PCA IO
+ *                  selection pins.
+ *
+ *****************************************************************************/
+fm_status fmPlatformLibGetXcvrBus(fm_int    sw,
+                                  fm_uint32 hwResourceId,
+                                  fm_int *  bus)
+{
+    fm_hwResId *hwResId;
+    fm_uint     hwIdx;
+    fm_uint     muxIdx;
+    fm_uint     busNum;
+    fm_uint     idx;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
+                 "sw=%d resId=%d\n",
+                 sw, hwResourceId);
+
+    if ( (sw >= FM_MAX_NUM_SWITCHES) || (bus == NULL) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    hwIdx = HW_RESOURCE_ID_TO_IDX(hwResourceId);
+
+    if (hwIdx >= hwCfg.numResId)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    hwResId = &hwCfg.hwResId[hwIdx];
+
+    if (hwResId->xcvrI2cBusSel.busSelType != BUS_SEL_TYPE_PCA_MUX)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_UNSUPPORTED);
+    }
+
+    muxIdx = hwResId->xcvrI2cBusSel.parentMuxIdx;
+
+    if (muxIdx == UINT_NOT_USED)
+    {
+        /* fmPlatformLibSelectBus defaults to bus 0 */
+        busNum = 0;
+    }
+    else if (muxIdx < hwCfg.numPcaMux)
+    {
+        busNum = hwCfg.pcaMux[muxIdx].bus;
+    }
+    else
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    for (idx = 0 ; idx < busNum ; idx++)
+    {
+        if ( strcmp(hwCfg.i2c[idx].devName, hwCfg.i2c[busNum].devName) == 0 )
+        {
+            busNum = idx;
+            break;
+        }
+    }
+
+    *bus = busNum;
+
+    FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_OK);
+
+}   /* end fmPlatformLibGetXcvrBus */
+
+
+
+
 /*****************************************************************************/
 /* fmPlatformLibI2cWriteRead
  * \ingroup platformLib
@@ -4424,16 +4659,16 @@ fm_status fmPlatformLibI2cWriteRead(fm_int   sw,
         return FM_ERR_INVALID_ARGUMENT;
     }
 
-    if (hwCfg.selectedBus[sw] < hwCfg.numBus)
+    if (selectedBus[sw] < hwCfg.numBus)
     {
-        i2c = &hwCfg.i2c[hwCfg.selectedBus[sw]];
+        i2c = &hwCfg.i2c[selectedBus[sw]];
 
         if (!i2c->writeReadFunc)
         {
             FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
                          "No I2C write-read function for switch %d bus %d\n",
                          sw,
-                         hwCfg.selectedBus[sw]);
+                         selectedBus[sw]);
             return FM_ERR_INVALID_ARGUMENT;
         }
 
@@ -4501,7 +4736,10 @@ fm_status fmPlatformLibGetPortXcvrState(fm_int     sw,
     fm_pcaIoDevice *ioDev;
     fm_status       status = FM_OK;
     fm_uint         cnt;
+    fm_uint         next;
     fm_uint         hwIdx;
+    fm_uint         ioIdx;
+    fm_uint         nextIoIdx;
     fm_uint         offset;
     fm_uint         byteIdx;
     fm_uint         bitIdx;
@@ -4561,12 +4799,22 @@ fm_status fmPlatformLibGetPortXcvrState(fm_int     sw,
             status = FM_ERR_INVALID_ARGUMENT;
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
         }
+    }
 
-        xcvrStateValid[cnt] = 0;
-        xcvrState[cnt] = 0;
+    /* Read the input registers of each PCA IO once. The devices behind the
+     * same mux path as the one just read are read next, so that the mux
+     * path is set up once for all of them. */
+    for (cnt = 0 ; cnt < (fm_uint)numPorts ; cnt++)
+    {
+        hwIdx = HW_RESOURCE_ID_TO_IDX(hwResourceIdList[cnt]);
+        ioIdx = hwCfg.hwResId[hwIdx].xcvrStateIo.ioIdx;
+
+        if (regSynced[ioIdx])
+        {
+            continue;
+        }
 
-        /* The caller already selected the bus for the first port,
-         * so select bus is required for subsequent ports only.  */
+        /* The caller already selected the bus for the first port */
         if (cnt > 0)
         {
             status = fmPlatformLibSelectBus(sw, FM_PLAT_BUS_XCVR_STATE, hwIdx);
@@ -4580,14 +4828,22 @@ fm_status fmPlatformLibGetPortXcvrState(fm_int     sw,
             }
         }
 
-        /* Transceiver status/control */
-        xcvrIo = &hwCfg.hwResId[hwIdx].xcvrStateIo;
-        ioDev  = &hwCfg.pcaIo[xcvrIo->ioIdx].dev;
-
-        /* Only read from HW when input registers are not in sync */
-        if (regSynced[xcvrIo->ioIdx] == FALSE)
+        for (next = cnt ; next < (fm_uint)numPorts ; next++)
         {
+            nextIoIdx = hwCfg.hwResId[HW_RESOURCE_ID_TO_IDX(
+                                  hwResourceIdList[next])].xcvrStateIo.ioIdx;
+
+            if ( regSynced[nextIoIdx] ||
+                 hwCfg.pcaIo[nextIoIdx].parentMuxIdx !=
+                    hwCfg.pcaIo[ioIdx].parentMuxIdx ||
+                 hwCfg.pcaIo[nextIoIdx].parentMuxValue !=
+                    hwCfg.pcaIo[ioIdx].parentMuxValue )
+            {
+                continue;
+            }
+
             /* Read all the input registers from that PCA IO */
+            ioDev  = &hwCfg.pcaIo[nextIoIdx].dev;
             status = fmUtilPcaIoReadRegs(ioDev,
                                          PCA_IO_REG_TYPE_INPUT,
                                          0,
@@ -4596,12 +4852,30 @@ fm_status fmPlatformLibGetPortXcvrState(fm_int     sw,
             {
                 FM_LOG_ERROR(FM_LOG_CAT_PLATFORM,
                              "Failed to read PCA IO regs (hwResourceId %u)\n",
-                             hwIdx);
+                             HW_RESOURCE_ID_TO_IDX(hwResourceIdList[next]));
                 continue;
             }
 
             /* Indicates the INPUT reg has been read */
-            regSynced[xcvrIo->ioIdx] = TRUE;
+            regSynced[nextIoIdx] = TRUE;
+        }
+    }
+
+    for (cnt = 0 ; cnt < (fm_uint)numPorts ; cnt++)
+    {
+        hwIdx = HW_RESOURCE_ID_TO_IDX(hwResourceIdList[cnt]);
+
+        xcvrStateValid[cnt] = 0;
+        xcvrState[cnt] = 0;
+
+        /* Transceiver status/control */
+        xcvrIo = &hwCfg.hwResId[hwIdx].xcvrStateIo;
+        ioDev  = &hwCfg.pcaIo[xcvrIo->ioIdx].dev;
+
+        /* Nothing to report if the input registers could not be read */
+        if (regSynced[xcvrIo->ioIdx] == FALSE)
+        {
+            continue;
         }
 
         if (xcvrIo->intfType == INTF_TYPE_SFPP)
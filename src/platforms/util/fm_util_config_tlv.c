@@ -143,6 +143,45 @@ typedef struct
 
 } fm_utilPropMap;
 
+
+/* Group of properties sharing the same text prefix and TLV arguments */
+typedef struct
+{
+    /* Property map of the group */
+    fm_utilPropMap *propMap;
+
+    /* Number of entries in propMap */
+    fm_int          propMapLen;
+
+    /* Text prefix of the properties */
+    fm_text         prefix;
+
+    /* Format of the TLV argument bytes, printed after the prefix */
+    fm_text         argFmt;
+
+    /* Number of argument bytes between the TLV header and the value */
+    fm_int          numArgs;
+
+} fm_utilTlvGroup;
+
+
+/* Entry of the TLV type index, sorted on tlvId */
+typedef struct
+{
+    /* TLV Type */
+    fm_uint          tlvId;
+
+    /* Position in the group table, to keep the first match on duplicates */
+    fm_int           order;
+
+    /* Property describing the TLV */
+    fm_utilPropMap  *propMap;
+
+    /* Group the property belongs to */
+    fm_utilTlvGroup *group;
+
+} fm_utilTlvDesc;
+
 /* Forward declaration for propMap initialization */
 static fm_status EnDecodePortMapping(fm_utilEnDecode encode,
                                      void    *propMap,
@@ -383,6 +422,7 @@ static fm_utilStrMap regModeMap[] =
     { "PCIE", 0},
     { "EBI", 1},
     { "I2C", 2},
+    { "SIM", 3},
 };
 
 static fm_utilStrMap isrModeMap[] =
@@ -422,6 +462,7 @@ static fm_utilStrMap libDebugMap[] =
     { "I2C_MUX",         (1 << 3)},
     { "PORT_LED",        (1 << 4)},
     { "DUMP_CFG",        (1 << 5)},
+    { "NO_MUX_CACHE",    (1 << 6)},
 
 
 };
@@ -514,6 +555,10 @@ static fm_utilPropMap apiProp[] = {
         PROP_INT, FM_TLV_API_EVENT_UNBLK_THRESHOLD, 2, NULL, 0, 0},
     {"api.event.semaphoreTimeout",
         PROP_INT, FM_TLV_API_EVENT_SEM_TIMEOUT, 2, NULL, 0, 0},
+    {"api.event.linkReserve",
+        PROP_INT, FM_TLV_API_EVENT_LINK_RESERVE, 4, NULL, 0, 0},
+    {"api.event.mailboxReserve",
+        PROP_INT, FM_TLV_API_EVENT_MAILBOX_RESERVE, 4, NULL, 0, 0},
     {"api.packet.rxDirectEnqueueing",
         PROP_BOOL, FM_TLV_API_RX_DIRECTED_ENQ, 1, NULL, 0, 0},
     {"api.packet.rxDriverDestinations",
@@ -536,6 +581,20 @@ static fm_utilPropMap apiProp[] = {
         PROP_BOOL, FM_TLV_API_FLUSH_ON_LAG_CHG, 1, NULL, 0, 0},
     {"api.ma.tcnFifoBurstSize",
         PROP_INT, FM_TLV_API_TCN_FIFO_BURST_SIZE, 2, NULL, 0, 0},
+    {"api.ma.maintSliceEntries",
+        PROP_INT, FM_TLV_API_MA_MAINT_SLICE_ENTRIES, 4, NULL, 0, 0},
+    {"api.ma.maintSliceTime",
+        PROP_INT, FM_TLV_API_MA_MAINT_SLICE_TIME, 4, NULL, 0, 0},
+    {"api.ma.journalSize",
+        PROP_INT, FM_TLV_API_MA_JOURNAL_SIZE, 4, NULL, 0, 0},
+    {"api.intr.pollBudget",
+        PROP_INT, FM_TLV_API_INTR_POLL_BUDGET, 4, NULL, 0, 0},
+    {"api.intr.pollInterval",
+        PROP_INT, FM_TLV_API_INTR_POLL_INTERVAL, 4, NULL, 0, 0},
+    {"api.mailbox.workerThreads",
+        PROP_INT, FM_TLV_API_MAILBOX_WORKER_THREADS, 4, NULL, 0, 0},
+    {"api.perSwitchTasks",
+        PROP_BOOL, FM_TLV_API_PER_SWITCH_TASKS, 1, NULL, 0, 0},
     {"api.swag.internalPort.vlanStats",
         PROP_BOOL, FM_TLV_API_SWAG_INT_VLAN_STATS, 1, NULL, 0, 0},
     {"api.perLagManagement",
@@ -676,6 +735,8 @@ static fm_utilPropMap apiProp[] = {
         PROP_INT, FM_TLV_API_GSME_TS_MODE, 1, NULL, 0, 0},
     {"api.multicast.hni.flooding",
         PROP_BOOL, FM_TLV_API_MC_HNI_FLOODING, 1, NULL, 0, 0},
+    {"api.multicast.hni.floodCoalesceTime",
+        PROP_INT, FM_TLV_API_MC_HNI_FLOOD_COALESCE, 4, NULL, 0, 0},
     {"api.hni.macEntriesPerPep",
         PROP_INT, FM_TLV_API_HNI_MAC_ENTRIES_PER_PEP, 2, NULL, 0, 0},
     {"api.hni.macEntriesPerPort",
@@ -698,6 +759,34 @@ static fm_utilPropMap apiProp[] = {
         PROP_BOOL, FM_TLV_API_SBMASTER_VALIDATE, 1, NULL, 0, 0},
     {"api.serdes.actionUpState",
         PROP_BOOL, FM_TVL_API_SERDES_ACTION_UP_ALLOWED, 1, NULL, 0, 0},
+    {"api.platform.rawSocket.txBatchSize",
+        PROP_INT, FM_TLV_API_PLAT_RAW_SOCK_TX_BATCH, 2, NULL, 0, 0},
+    {"api.platform.rawSocket.rxBatchSize",
+        PROP_INT, FM_TLV_API_PLAT_RAW_SOCK_RX_BATCH, 2, NULL, 0, 0},
+    {"api.platform.tpacket.rxBlockCount",
+        PROP_INT, FM_TLV_API_PLAT_TPACKET_RX_BLOCKS, 2, NULL, 0, 0},
+    {"api.platform.tpacket.txFrameCount",
+        PROP_INT, FM_TLV_API_PLAT_TPACKET_TX_FRAMES, 2, NULL, 0, 0},
+    {"api.platform.tpacket.txTimestamps",
+        PROP_BOOL, FM_TLV_API_PLAT_TPACKET_TX_TIMESTAMPS, 1, NULL, 0, 0},
+    {"api.platform.pktQueueSize",
+        PROP_INT, FM_TLV_API_PLAT_PKT_QUEUE_SIZE, 2, NULL, 0, 0},
+    {"api.platform.bufferSize",
+        PROP_INT, FM_TLV_API_PLAT_BUFFER_SIZE, 4, NULL, 0, 0},
+    {"api.platform.numBuffers",
+        PROP_INT, FM_TLV_API_PLAT_NUM_BUFFERS, 4, NULL, 0, 0},
+    {"api.platform.bufferHugePages",
+        PROP_BOOL, FM_TLV_API_PLAT_BUF_HUGE_PAGES, 1, NULL, 0, 0},
+    {"api.event.ringQueues",
+        PROP_BOOL, FM_TLV_API_EVENT_RING_QUEUES, 1, NULL, 0, 0},
+    {"api.lock.fastPath",
+        PROP_BOOL, FM_TLV_API_LOCK_FAST_PATH, 1, NULL, 0, 0},
+    {"api.thread.placement",
+        PROP_TEXT, FM_TLV_API_THREAD_PLACEMENT, 0, NULL, 0, 0},
+    {"api.regCache.snapshotFile",
+        PROP_TEXT, FM_TLV_API_REG_CACHE_SNAPSHOT_FILE, 0, NULL, 0, 0},
+    {"api.debug.bootProfileFile",
+        PROP_TEXT, FM_TLV_API_DEBUG_BOOT_PROFILE_FILE, 0, NULL, 0, 0},
 
 };
 
@@ -787,6 +876,44 @@ static fm_utilPropMap fm10kProp[] = {
         NULL, 0, 0},
     {"parity.crmTimeout", PROP_INT, FM_TLV_FM10K_PARITY_CRM_TIMEOUT, 1,
         NULL, 0, 0},
+    {"parity.sweepBudget", PROP_INT, FM_TLV_FM10K_PARITY_SWEEP_BUDGET, 4,
+        NULL, 0, 0},
+    {"parity.coalesceWindow", PROP_INT, FM_TLV_FM10K_PARITY_COALESCE_WINDOW, 4,
+        NULL, 0, 0},
+    {"parity.coalesceThreshold", PROP_INT, FM_TLV_FM10K_PARITY_COALESCE_THRESHOLD, 4,
+        NULL, 0, 0},
+    {"portInitThreads", PROP_INT, FM_TLV_FM10K_PORT_INIT_THREADS, 1,
+        NULL, 0, 0},
+    {"ma.tcnBurstRead", PROP_BOOL, FM_TLV_FM10K_MA_TCN_BURST_READ, 1,
+        NULL, 0, 0},
+    {"ma.learningRateLimit", PROP_INT, FM_TLV_FM10K_MA_LEARNING_RATE_LIMIT, 4,
+        NULL, 0, 0},
+    {"ma.portLearningRateLimit", PROP_INT,
+        FM_TLV_FM10K_MA_PORT_LEARNING_RATE_LIMIT, 4, NULL, 0, 0},
+    {"acl.compileThreads", PROP_INT, FM_TLV_FM10K_ACL_COMPILE_THREADS, 1,
+        NULL, 0, 0},
+    {"acl.compileValidate", PROP_BOOL, FM_TLV_FM10K_ACL_COMPILE_VALIDATE, 1,
+        NULL, 0, 0},
+    {"intr.linkPollTime", PROP_INT, FM_TLV_FM10K_INTR_LINK_POLL_TIME, 4,
+        NULL, 0, 0},
+    {"intr.maTcnPollTime", PROP_INT, FM_TLV_FM10K_INTR_MATCN_POLL_TIME, 4,
+        NULL, 0, 0},
+    {"intr.mailboxPollTime", PROP_INT, FM_TLV_FM10K_INTR_MAILBOX_POLL_TIME, 4,
+        NULL, 0, 0},
+    {"dfe.maxConcurrentTunings", PROP_INT, FM_TLV_FM10K_DFE_MAX_CONCURRENT_TUNINGS, 4,
+        NULL, 0, 0},
+    {"dfe.uplinkEplMask", PROP_INT, FM_TLV_FM10K_DFE_UPLINK_EPL_MASK, 4,
+        NULL, 0, 0},
+    {"dfe.adaptiveTimeout", PROP_BOOL, FM_TLV_FM10K_DFE_ADAPTIVE_TIMEOUT, 1,
+        NULL, 0, 0},
+    {"mailbox.batchRequests", PROP_BOOL, FM_TLV_FM10K_MAILBOX_BATCH_REQUESTS, 1,
+        NULL, 0, 0},
+    {"lag.fastFailover", PROP_BOOL, FM_TLV_FM10K_LAG_FAST_FAILOVER, 1,
+        NULL, 0, 0},
+    {"mtable.cleanupBudget", PROP_INT, FM_TLV_FM10K_MTABLE_CLEANUP_BUDGET, 4,
+        NULL, 0, 0},
+    {"mtable.cleanupFreeBlock", PROP_INT, FM_TLV_FM10K_MTABLE_CLEANUP_FREE_BLOCK, 4,
+        NULL, 0, 0},
 
 
     {"createRemoteLogicalPorts", PROP_BOOL, FM_TLV_FM10K_CREATE_REMOTE_LOGICAL_PORTS, 1,
@@ -831,6 +958,8 @@ static fm_utilPropMap fm10kProp[] = {
         NULL, 0, 0},
     {"allowKrPcalOnEee", PROP_BOOL, FM_TLV_FM10K_ALLOW_KRPCAL_ON_EEE, 1,
         NULL, 0, 0},
+    {"reuseLoadedSpicoFw", PROP_BOOL, FM_TLV_FM10K_REUSE_LOADED_SPICO_FW, 1,
+        NULL, 0, 0},
 };
 
 
@@ -923,6 +1052,8 @@ static fm_utilPropMap platConfigSw[] = {
         EnDecodeByMap, (fm_intptr)isrModeMap, FM_NENTRIES(isrModeMap)},
     {"cpuPort", PROP_UINT, FM_TLV_PLAT_CPU_PORT, 2, NULL, 0, 0},
     {"intPollMsec", PROP_UINT, FM_TLV_PLAT_INTR_POLL_PER, 2, NULL, 0, 0},
+    {"simAccessLatencyNsec",
+        PROP_UINT, FM_TLV_PLAT_SIM_ACCESS_LATENCY, 4, NULL, 0, 0},
     {"phyEnableDeemphasis",
         PROP_INT, FM_TLV_PLAT_PHY_EN_DEEMPHASIS, 1, NULL, 0, 0},
     {"msiEnabled", PROP_BOOL, FM_TLV_PLAT_SW_MSI_ENABLE, 1, NULL, 0, 0},
@@ -932,6 +1063,10 @@ static fm_utilPropMap platConfigSw[] = {
     {"VDDF.hwResourceId", PROP_INT_H, FM_TLV_PLAT_SW_VDDF_USE_HW_RESOURCE_ID, 4, NULL, 0, 0},
     {"AVDD.hwResourceId", PROP_INT_H, FM_TLV_PLAT_SW_AVDD_USE_HW_RESOURCE_ID, 4, NULL, 0, 0},
     {"i2cClkDivider", PROP_UINT, FM_TLV_PLAT_SW_I2C_CLKDIVIDER, 1, NULL, 0, 0},
+    {"csrWideAccess", PROP_BOOL, FM_TLV_PLAT_SW_CSR_WIDE_ACCESS, 1, NULL, 0, 0},
+    {"i2cBurstWords", PROP_UINT, FM_TLV_PLAT_SW_I2C_BURST_WORDS, 1, NULL, 0, 0},
+    {"xcvrDomRefreshMsec",
+        PROP_UINT, FM_TLV_PLAT_SW_XCVR_DOM_REFRESH_PER, 2, NULL, 0, 0},
 };
 
 /* Property starting with api.platform.config.switch.%d.internalPortIndex.%d */
@@ -1254,6 +1389,62 @@ static fm_utilPropMap platLibConfigBus[] = {
 };
 
 
+/* All property groups, in the order they are matched when decoding */
+static fm_utilTlvGroup tlvGroups[] = {
+    { apiProp, FM_NENTRIES(apiProp), "", "", 0 },
+    { fm10kProp, FM_NENTRIES(fm10kProp), FM10K_CFG_PREFIX, "", 0 },
+    { platConfig, FM_NENTRIES(platConfig), PLAT_CFG_PREFIX, "", 0 },
+    { platConfigSw, FM_NENTRIES(platConfigSw),
+      PLAT_CFG_SW_PREFIX, "%d.", 1 },
+    { platConfigSwPortIdx, FM_NENTRIES(platConfigSwPortIdx),
+      PLAT_CFG_SW_PREFIX, "%d.portIndex.%d.", 2 },
+    { platConfigSwIntPortIdx, FM_NENTRIES(platConfigSwIntPortIdx),
+      PLAT_CFG_SW_PREFIX, "%d.internalPortIndex.%d.", 2 },
+    { platConfigSwPhy, FM_NENTRIES(platConfigSwPhy),
+      PLAT_CFG_SW_PREFIX, "%d.phy.%d.", 2 },
+    { platConfigSwPortIdxLane, FM_NENTRIES(platConfigSwPortIdxLane),
+      PLAT_CFG_SW_PREFIX, "%d.portIndex.%d.lane.%d.", 3 },
+    { platConfigSwPhyLane, FM_NENTRIES(platConfigSwPhyLane),
+      PLAT_CFG_SW_PREFIX, "%d.phy.%d.lane.%d.", 3 },
+    { platLibConfigBus, FM_NENTRIES(platLibConfigBus),
+      PLAT_LIB_CFG_BUS_PREFIX, "%d.", 1 },
+    { platLibConfigPcaMux, FM_NENTRIES(platLibConfigPcaMux),
+      PLAT_LIB_CFG_PCAMUX_PREFIX, "%d.", 1 },
+    { platLibConfigPcaIo, FM_NENTRIES(platLibConfigPcaIo),
+      PLAT_LIB_CFG_PCAIO_PREFIX, "%d.", 1 },
+    { platLibConfigHwResId, FM_NENTRIES(platLibConfigHwResId),
+      PLAT_LIB_CFG_HWRESID_PREFIX, "%d.", 1 },
+    { platLibConfigHwResIdPortLed, FM_NENTRIES(platLibConfigHwResIdPortLed),
+      PLAT_LIB_CFG_HWRESID_PREFIX, "%d.portLed.%d.", 2 },
+    { platLibConfigHwResIdPortLedLane,
+      FM_NENTRIES(platLibConfigHwResIdPortLedLane),
+      PLAT_LIB_CFG_HWRESID_PREFIX, "%d.portLed.%d.%d.", 3 },
+    { platLibConfig, FM_NENTRIES(platLibConfig), PLAT_LIB_CFG_PREFIX, "", 0 },
+};
+
+#define NUM_TLV_DESC                                   \
+    ( FM_NENTRIES(apiProp) +                           \
+      FM_NENTRIES(fm10kProp) +                         \
+      FM_NENTRIES(platConfig) +                        \
+      FM_NENTRIES(platConfigSw) +                      \
+      FM_NENTRIES(platConfigSwPortIdx) +               \
+      FM_NENTRIES(platConfigSwIntPortIdx) +            \
+      FM_NENTRIES(platConfigSwPhy) +                   \
+      FM_NENTRIES(platConfigSwPortIdxLane) +           \
+      FM_NENTRIES(platConfigSwPhyLane) +               \
+      FM_NENTRIES(platLibConfigBus) +                  \
+      FM_NENTRIES(platLibConfigPcaMux) +               \
+      FM_NENTRIES(platLibConfigPcaIo) +                \
+      FM_NENTRIES(platLibConfigHwResId) +              \
+      FM_NENTRIES(platLibConfigHwResIdPortLed) +       \
+      FM_NENTRIES(platLibConfigHwResIdPortLedLane) +   \
+      FM_NENTRIES(platLibConfig) )
+
+/* Descriptors of all properties sorted on TLV type, built on first use */
+static fm_utilTlvDesc tlvDescIndex[NUM_TLV_DESC];
+static fm_int         tlvDescIndexSize = 0;
+
+
 
 /*****************************************************************************
  * Local function prototypes.
@@ -2366,40 +2557,128 @@ static fm_status EncodeGenericConfig(fm_utilPropMap *propMap,
 
 
 /*****************************************************************************/
-/** FindTlvMap
+/** CompareTlvDesc
  * \ingroup intPlatform
  *
- * \desc            Find TLV index to the structure given the value if found.
+ * \desc            qsort comparison function ordering TLV descriptors by
+ *                  TLV type, then by position in the group table.
  *
- * \param[in]       propMap is an array of fm_utilPropMap structure describing the
- *                  properties.
+ * \param[in]       a points to the first fm_utilTlvDesc.
  *
- * \param[in]       propMapLen is the length of the propMap array.
+ * \param[in]       b points to the second fm_utilTlvDesc.
+ *
+ * \return          negative, zero or positive as a sorts before, equal to
+ *                  or after b.
+ *
+ *****************************************************************************/
+static int CompareTlvDesc(const void *a, const void *b)
+{
+    const fm_utilTlvDesc *descA = a;
+    const fm_utilTlvDesc *descB = b;
+
+    if (descA->tlvId != descB->tlvId)
+    {
+        return (descA->tlvId < descB->tlvId) ? -1 : 1;
+    }
+
+    return descA->order - descB->order;
+
+}   /* end CompareTlvDesc */
+
+
+
+
+/*****************************************************************************/
+/** BuildTlvDescIndex
+ * \ingroup intPlatform
+ *
+ * \desc            Build the TLV descriptor index from all the property
+ *                  groups, sorted on TLV type.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BuildTlvDescIndex(void)
+{
+    fm_utilTlvGroup *group;
+    fm_int           groupIdx;
+    fm_int           i;
+    fm_int           size;
+
+    size = 0;
+
+    for (groupIdx = 0 ; groupIdx < (fm_int) FM_NENTRIES(tlvGroups) ; groupIdx++)
+    {
+        group = &tlvGroups[groupIdx];
+
+        for (i = 0 ; i < group->propMapLen ; i++)
+        {
+            tlvDescIndex[size].tlvId   = group->propMap[i].tlvId;
+            tlvDescIndex[size].order   = size;
+            tlvDescIndex[size].propMap = &group->propMap[i];
+            tlvDescIndex[size].group   = group;
+            size++;
+        }
+    }
+
+    qsort(tlvDescIndex, size, sizeof(fm_utilTlvDesc), CompareTlvDesc);
+
+    tlvDescIndexSize = size;
+
+}   /* end BuildTlvDescIndex */
+
+
+
+
+/*****************************************************************************/
+/** FindTlvDesc
+ * \ingroup intPlatform
+ *
+ * \desc            Find the descriptor of the given TLV type.
  *
  * \param[in]       tlvType is TLV type to match.
  *
- * \return          pointer to coresponding fm_utilPropMap if found.
+ * \return          pointer to coresponding fm_utilTlvDesc if found.
  * \return          NULL if not found.
  *
  *****************************************************************************/
-static fm_utilPropMap * FindTlvMap(fm_utilPropMap *propMap,
-                               fm_int      propMapLen,
-                               fm_uint     tlvType)
+static fm_utilTlvDesc * FindTlvDesc(fm_uint tlvType)
 {
-    fm_int      i;
+    fm_int lo;
+    fm_int hi;
+    fm_int mid;
 
-    for (i = 0; i < propMapLen; i++)
+    if (tlvDescIndexSize == 0)
     {
-        if (propMap[i].tlvId == tlvType)
+        BuildTlvDescIndex();
+    }
+
+    /* Lower bound, so the first group listing the type wins */
+    lo = 0;
+    hi = tlvDescIndexSize;
+
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+
+        if (tlvDescIndex[mid].tlvId < tlvType)
+        {
+            lo = mid + 1;
+        }
+        else
         {
-            return &propMap[i];
+            hi = mid;
         }
     }
 
+    if ( (lo < tlvDescIndexSize) && (tlvDescIndex[lo].tlvId == tlvType) )
+    {
+        return &tlvDescIndex[lo];
+    }
 
     return NULL;
 
-}   /* end FindTlvMap */
+}   /* end FindTlvDesc */
 
 
 
@@ -3816,281 +4095,65 @@ fm_status fmUtilConfigPropertyDecodeTlv(fm_byte *tlv,
                                         fm_text propBuf,
                                         fm_int bufSize)
 {
-    fm_status           status;
-    fm_uint             tlvType;
-    fm_uint             tlvLen;
-    fm_utilPropMap          *propMap;
-    fm_int              bufLen;
-
-    status = FM_ERR_NOT_FOUND;
+    fm_utilTlvDesc *desc;
+    fm_utilTlvGroup *group;
+    fm_uint         tlvType;
+    fm_int          tlvLen;
+    fm_int          numArgs;
+    fm_int          bufLen;
 
     tlvType = (tlv[0] << 8) | tlv[1];
     tlvLen = tlv[2];
 
-
-    if (tlvType < 0x2000)
+    if (tlvType >= 0x6000)
     {
-        /* API properties */
-        propMap = FindTlvMap(apiProp,
-                             sizeof(apiProp)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s",
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 3, tlvLen, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
-    }
-    else if (tlvType < 0x3000)
-    {
-        /* FM10K properties */
-        propMap = FindTlvMap(fm10kProp,
-                             sizeof(fm10kProp)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s%s",
-                        FM10K_CFG_PREFIX,
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 3, tlvLen, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
+        return FM_ERR_INVALID_ARGUMENT;
     }
-    else if (tlvType < 0x5000)
-    {
-        /* Platform LT config */
-
-        /* Properties with no argument, start after prefix */
-        propMap = FindTlvMap(platConfig,
-                             sizeof(platConfig)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s%s",
-                        PLAT_CFG_PREFIX,
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 3, tlvLen, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
 
-        /* Properties with switch */
-        propMap = FindTlvMap(platConfigSw,
-                             sizeof(platConfigSw)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s%d.%s",
-                        PLAT_CFG_SW_PREFIX,
-                        tlv[3], 
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 4, tlvLen - 1, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
-
-        /* Properties with switch and portIndex */
-        propMap = FindTlvMap(platConfigSwPortIdx,
-                             sizeof(platConfigSwPortIdx)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s%d.portIndex.%d.%s",
-                        PLAT_CFG_SW_PREFIX, 
-                        tlv[3], 
-                        tlv[4], 
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 5, tlvLen - 2, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
-
-        /* Properties with switch and internalPortIndex */
-        propMap = FindTlvMap(platConfigSwIntPortIdx,
-                             sizeof(platConfigSwIntPortIdx)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s%d.internalPortIndex.%d.%s",
-                        PLAT_CFG_SW_PREFIX, 
-                        tlv[3], 
-                        tlv[4], 
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 5, tlvLen - 2, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
-
-        /* Properties with switch and phy */
-        propMap = FindTlvMap(platConfigSwPhy,
-                             sizeof(platConfigSwPhy)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s%d.phy.%d.%s",
-                        PLAT_CFG_SW_PREFIX, 
-                        tlv[3], 
-                        tlv[4], 
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 5, tlvLen - 2, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
+    desc = FindTlvDesc(tlvType);
 
-        /* Properties with switch and portIndex and lane */
-        propMap = FindTlvMap(platConfigSwPortIdxLane,
-                             sizeof(platConfigSwPortIdxLane)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s%d.portIndex.%d.lane.%d.%s",
-                        PLAT_CFG_SW_PREFIX, 
-                        tlv[3], 
-                        tlv[4], 
-                        tlv[5], 
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 6, tlvLen - 3, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
-
-        /* Properties with switch and portIndex and lane */
-        propMap = FindTlvMap(platConfigSwPhyLane,
-                             sizeof(platConfigSwPhyLane)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s%d.phy.%d.lane.%d.%s",
-                        PLAT_CFG_SW_PREFIX, 
-                        tlv[3], 
-                        tlv[4], 
-                        tlv[5], 
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 6, tlvLen - 3, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
-    }
-    else if (tlvType < 0x6000)
+    if (desc == NULL)
     {
-        /* Platform LT lib config */
-
-        /* Properties with only bus argument */
-        propMap = FindTlvMap(platLibConfigBus,
-                             sizeof(platLibConfigBus)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s%d.%s ",
-                        PLAT_LIB_CFG_BUS_PREFIX,
-                        tlv[3], 
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 4, tlvLen - 1, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
+        return FM_ERR_NOT_FOUND;
+    }
 
-        /* Properties with only pcaMux argument */
-        propMap = FindTlvMap(platLibConfigPcaMux,
-                             sizeof(platLibConfigPcaMux)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s%d.%s",
-                        PLAT_LIB_CFG_PCAMUX_PREFIX,
-                        tlv[3], 
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 4, tlvLen - 1, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
+    group   = desc->group;
+    numArgs = group->numArgs;
 
-        /* Properties with only pcaIo argument */
-        propMap = FindTlvMap(platLibConfigPcaIo,
-                             sizeof(platLibConfigPcaIo)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s%d.%s",
-                        PLAT_LIB_CFG_PCAIO_PREFIX,
-                        tlv[3], 
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 4, tlvLen - 1, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
+    bufLen = FM_SNPRINTF_S(propBuf,
+                           bufSize,
+                           "%s",
+                           group->prefix);
 
-        /* Properties with only hwResourceId argument */
-        propMap = FindTlvMap(platLibConfigHwResId,
-                             sizeof(platLibConfigHwResId)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s%d.%s",
-                        PLAT_LIB_CFG_HWRESID_PREFIX,
-                        tlv[3], 
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 4, tlvLen - 1, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
-
-        /* Properties with hwResourceId and portLed argument */
-        propMap = FindTlvMap(platLibConfigHwResIdPortLed,
-                             sizeof(platLibConfigHwResIdPortLed)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s%d.portLed.%d.%s",
-                        PLAT_LIB_CFG_HWRESID_PREFIX,
-                        tlv[3],
-                        tlv[4],
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 5, tlvLen - 2, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
-
-        /* Properties with hwResourceId, portLed and lane arguments */
-        propMap = FindTlvMap(platLibConfigHwResIdPortLedLane,
-                             sizeof(platLibConfigHwResIdPortLedLane)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s%d.portLed.%d.%d.%s",
-                        PLAT_LIB_CFG_HWRESID_PREFIX,
-                        tlv[3],
-                        tlv[4],
-                        tlv[5],
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 6, tlvLen - 3, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
+    if (numArgs > 0 && bufLen < bufSize)
+    {
+        /* The format only consumes the arguments it references */
+        bufLen += FM_SNPRINTF_S(propBuf + bufLen,
+                                bufSize - bufLen,
+                                group->argFmt,
+                                tlv[3],
+                                (numArgs > 1) ? tlv[4] : 0,
+                                (numArgs > 2) ? tlv[5] : 0);
+    }
 
-        /* Properties with no argument, start after prefix */
-        propMap = FindTlvMap(platLibConfig,
-                             sizeof(platLibConfig)/
-                             sizeof(fm_utilPropMap),
-                             tlvType);
-        if (propMap)
-        {
-            bufLen = FM_SNPRINTF_S(propBuf, bufSize, "%s%s",
-                        PLAT_LIB_CFG_PREFIX,
-                        propMap->key);
-            PrintPropTypeValue(propMap, tlv + 3, tlvLen, propBuf + bufLen, bufSize - bufLen);
-            return FM_OK;
-        }
+    if (bufLen < bufSize)
+    {
+        bufLen += FM_SNPRINTF_S(propBuf + bufLen,
+                                bufSize - bufLen,
+                                "%s",
+                                desc->propMap->key);
     }
-    else
+
+    if (bufLen < bufSize)
     {
-        return FM_ERR_INVALID_ARGUMENT;
+        PrintPropTypeValue(desc->propMap,
+                           tlv + 3 + numArgs,
+                           tlvLen - numArgs,
+                           propBuf + bufLen,
+                           bufSize - bufLen);
     }
 
-    return status;
+    return FM_OK;
 
 }   /* end fmUtilConfigPropertyDecodeTlv */
 
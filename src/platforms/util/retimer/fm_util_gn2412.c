@@ -66,6 +66,10 @@
 #define CMD_REG                     0x140
 #define DATA_REG                    0x141
 
+/* Largest command argument block written to the data buffer registers
+ * in a single I2C transfer. */
+#define DATA_REG_BURST_MAX          8
+
 #define NUM_DIAG_COUNTERS           13
 
 /* GN2412 CSR */
@@ -265,6 +269,58 @@ static fm_status RegisterWrite(fm_uintptr                  handle,
 
 
 
+/*****************************************************************************/
+/* RegisterWriteBurst
+ * \ingroup platformUtils
+ *
+ * \desc            Write consecutive GN2412 registers in one I2C transfer,
+ *                  relying on the register address auto-increment.
+ *
+ * \param[in]       handle is the handle to the I2C device.
+ *
+ * \param[in]       func is the I2C write read function to call.
+ *
+ * \param[in]       dev is the device address.
+ *
+ * \param[in]       reg is the address of the first register.
+ *
+ * \param[in]       vals points to the values to write.
+ *
+ * \param[in]       len is the number of registers to write, at most
+ *                  DATA_REG_BURST_MAX.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if len is out of range.
+ *
+ *****************************************************************************/
+static fm_status RegisterWriteBurst(fm_uintptr                  handle,
+                                    fm_utilI2cWriteReadHdnlFunc func,
+                                    fm_uint                     dev,
+                                    fm_uint                     reg,
+                                    const fm_byte *             vals,
+                                    fm_int                      len)
+{
+    fm_byte   data[2 + DATA_REG_BURST_MAX];
+    fm_status status;
+
+    if ( len <= 0 || len > DATA_REG_BURST_MAX )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    /* Address MSB first, followed by the values */
+    data[0] = (fm_byte)((reg >> 8) & 0xff);
+    data[1] = (fm_byte)(reg & 0xff);
+    FM_MEMCPY_S(&data[2], DATA_REG_BURST_MAX, vals, len);
+
+    status = func(handle, dev, data, 2 + len, 0);
+
+    return status;
+
+}   /* end RegisterWriteBurst */
+
+
+
 /*****************************************************************************/
 /* IssueCommandCode
  * \ingroup platformUtils
@@ -662,21 +718,18 @@ static fm_status ConfigureAllCrosspoint(fm_uintptr                  handle,
                                         fm_gn2412Cfg *              cfg)
 {
     fm_status status;
-    fm_uint16 reg;
-    fm_byte   data;
+    fm_byte   data[FM_GN2412_NUM_LANES / 2];
     fm_int    i;
 
-    reg = DATA_REG;
-
     /* Configure Cross-Connections per values provided in config file */
     for ( i = 0 ; i < FM_GN2412_NUM_LANES ; i+=2 )
     {
-        data = (cfg->lane[i+1].rxPort << 4) | cfg->lane[i].rxPort;
-
-        status = RegisterWrite(handle, func, dev, reg++, data);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
+        data[i / 2] = (cfg->lane[i+1].rxPort << 4) | cfg->lane[i].rxPort;
     }
 
+    status = RegisterWriteBurst(handle, func, dev, DATA_REG, data, i / 2);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
+
     /* Issue the "Configure all cross-connection" command code: 0x11 */
     status = IssueCommandCode(handle, func, dev, 0x11);
 
@@ -820,27 +873,15 @@ static fm_status ConfigurePortPairs(fm_uintptr                  handle,
                                     fm_utilI2cWriteReadHdnlFunc func,
                                     fm_uint                     dev)
 {
+    static const fm_byte pairs[] = { 0x10, 0x32, 0x54, 0x76, 0x98, 0xBA };
     fm_status status;
-    fm_uint16 reg;
-
-    reg = DATA_REG;
-
-    status = RegisterWrite(handle, func, dev, reg++, 0x10);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
-
-    status = RegisterWrite(handle, func, dev, reg++, 0x32);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
-
-    status = RegisterWrite(handle, func, dev, reg++, 0x54);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
-
-    status = RegisterWrite(handle, func, dev, reg++, 0x76);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
 
-    status = RegisterWrite(handle, func, dev, reg++, 0x98);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
-
-    status = RegisterWrite(handle, func, dev, reg++, 0xBA);
+    status = RegisterWriteBurst(handle,
+                                func,
+                                dev,
+                                DATA_REG,
+                                pairs,
+                                FM_NENTRIES(pairs));
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
 
     /* Issue the command code: 0x15 */
@@ -1002,25 +1043,15 @@ static fm_status ConfigureLaneDeEmphasis(fm_uintptr                  handle,
                                          fm_int                      postTap)
 {
     fm_status status;
-    fm_uint16 reg;
+    fm_byte   data[5];
 
-    reg = DATA_REG;
-
-    status = RegisterWrite(handle, func, dev, reg++, lane);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
-#if 1
-    status = RegisterWrite(handle, func, dev, reg++, polarity);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
-#else
-    i++;
-#endif
-    status = RegisterWrite(handle, func, dev, reg++, preTap);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
-
-    status = RegisterWrite(handle, func, dev, reg++, att);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
+    data[0] = lane;
+    data[1] = polarity;
+    data[2] = preTap;
+    data[3] = att;
+    data[4] = postTap;
 
-    status = RegisterWrite(handle, func, dev, reg++, postTap);
+    status = RegisterWriteBurst(handle, func, dev, DATA_REG, data, 5);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
 
     /* Issue the "Control Non-KR Transmit Equalization" command code: 0x17 */
@@ -1212,13 +1243,12 @@ static fm_status SetAppMode(fm_uintptr                  handle,
                             fm_int                      mode)
 {
     fm_status status;
-    fm_int    i;
+    fm_byte   data[2];
 
-    i = 0;
-    status = RegisterWrite(handle, func, dev, (DATA_REG + i++), lane);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
+    data[0] = lane;
+    data[1] = mode;
 
-    status = RegisterWrite(handle, func, dev, (DATA_REG + i++), mode);
+    status = RegisterWriteBurst(handle, func, dev, DATA_REG, data, 2);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
 
     /* Issue the command code: 0x19 */
@@ -2347,6 +2377,88 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/* fmUtilGN2412SetAppModes
+ * \ingroup platformUtils
+ *
+ * \desc            Set the application mode of several data lanes of the
+ *                  same retimer. All the lanes are disabled first, then
+ *                  configured, then re-enabled, so a group of lanes such
+ *                  as the internal and external side of a port only goes
+ *                  down once.
+ *
+ * \param[in]       handle is the handle to the I2C device.
+ *
+ * \param[in]       func is the I2C write read function to call.
+ *
+ * \param[in]       dev is the device I2C address.
+ *
+ * \param[in]       numLanes is the number of entries in lanes and modes.
+ *
+ * \param[in]       lanes points to the data lanes to configure.
+ *
+ * \param[in]       modes points to the application mode of each lane.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if a lane is out of range.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+fm_status fmUtilGN2412SetAppModes(fm_uintptr                  handle,
+                                  fm_utilI2cWriteReadHdnlFunc func,
+                                  fm_uint                     dev,
+                                  fm_int                      numLanes,
+                                  const fm_int *              lanes,
+                                  const fm_int *              modes)
+{
+    fm_status status;
+    fm_int    i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PHY, "dev=0x%x, numLanes=%d\n", dev, numLanes);
+
+    status = FM_OK;
+
+    if ( lanes == NULL || modes == NULL )
+    {
+        status = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT(FM_LOG_CAT_PHY, status);
+    }
+
+    for ( i = 0 ; i < numLanes ; i++ )
+    {
+        if ( lanes[i] < 0 || lanes[i] >= FM_GN2412_NUM_LANES )
+        {
+            status = FM_ERR_INVALID_ARGUMENT;
+            FM_LOG_ABORT(FM_LOG_CAT_PHY, status);
+        }
+    }
+
+    for ( i = 0 ; i < numLanes ; i++ )
+    {
+        status = DisableLane(handle, func, dev, lanes[i]);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
+    }
+
+    for ( i = 0 ; i < numLanes ; i++ )
+    {
+        status = SetAppMode(handle, func, dev, lanes[i], modes[i]);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
+    }
+
+    for ( i = 0 ; i < numLanes ; i++ )
+    {
+        status = EnableLane(handle, func, dev, lanes[i]);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
+    }
+
+ABORT:
+    FM_LOG_EXIT(FM_LOG_CAT_PHY, status);
+
+}   /* end fmUtilGN2412SetAppModes */
+
+
+
+
 /*****************************************************************************/
 /* fmUtilGN2412GetLaneTxEq
  * \ingroup platformUtils
@@ -2494,10 +2606,15 @@ fm_status fmUtilGN2412SetLaneTxEq(fm_uintptr                  handle,
 
 
 /*****************************************************************************/
-/* fmUtilGN2412Initialize
+/* fmUtilGN2412InitializeStart
  * \ingroup platformUtils
  *
- * \desc            Returns the Retimer's boot error code.
+ * \desc            Performs the first phase of the retimer initialization:
+ *                  selects API mode and programs both timebases, which
+ *                  starts their calibration. The caller may start other
+ *                  retimers before completing this one with
+ *                  fmUtilGN2412InitializeComplete, so that the timebase
+ *                  calibrations of all retimers run in parallel.
  *
  * \param[in]       handle is the handle to the I2C device.
  *
@@ -2511,10 +2628,10 @@ fm_status fmUtilGN2412SetLaneTxEq(fm_uintptr                  handle,
  * \return          Other ''Status Codes'' as appropriate in case of failure.
  *
  *****************************************************************************/
-fm_status fmUtilGN2412Initialize(fm_uintptr                  handle,
-                                 fm_utilI2cWriteReadHdnlFunc func,
-                                 fm_uint                     dev,
-                                 fm_gn2412Cfg *              cfg)
+fm_status fmUtilGN2412InitializeStart(fm_uintptr                  handle,
+                                      fm_utilI2cWriteReadHdnlFunc func,
+                                      fm_uint                     dev,
+                                      fm_gn2412Cfg *              cfg)
 {
     fm_status status;
     fm_int    i;
@@ -2523,7 +2640,7 @@ fm_status fmUtilGN2412Initialize(fm_uintptr                  handle,
 
     if (cfg == NULL)
     {
-        return FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_EXIT(FM_LOG_CAT_PHY, FM_ERR_INVALID_ARGUMENT);
     }
 
     /* Set firmware for API mode (0xff)*/
@@ -2541,6 +2658,50 @@ fm_status fmUtilGN2412Initialize(fm_uintptr                  handle,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
     }
 
+ABORT:
+    FM_LOG_EXIT(FM_LOG_CAT_PHY, status);
+
+}   /* end fmUtilGN2412InitializeStart */
+
+
+
+
+/*****************************************************************************/
+/* fmUtilGN2412InitializeComplete
+ * \ingroup platformUtils
+ *
+ * \desc            Completes a retimer initialization started with
+ *                  fmUtilGN2412InitializeStart: waits for the timebase
+ *                  calibration, then configures and enables the data
+ *                  lanes.
+ *
+ * \param[in]       handle is the handle to the I2C device.
+ *
+ * \param[in]       func is the I2C write read function to call.
+ *
+ * \param[in]       dev is the device I2C address.
+ *
+ * \param[in]       cfg pointer to GN2412 configuration.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+fm_status fmUtilGN2412InitializeComplete(fm_uintptr                  handle,
+                                         fm_utilI2cWriteReadHdnlFunc func,
+                                         fm_uint                     dev,
+                                         fm_gn2412Cfg *              cfg)
+{
+    fm_status status;
+    fm_int    i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PHY, "dev=0x%x\n", dev);
+
+    if (cfg == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PHY, FM_ERR_INVALID_ARGUMENT);
+    }
+
     /* Wait for both timebase calibration completion */
     for ( i = 0 ; i < FM_GN2412_NUM_TIMEBASES ; i++ )
     {
@@ -2601,4 +2762,46 @@ fm_status fmUtilGN2412Initialize(fm_uintptr                  handle,
 ABORT:
     FM_LOG_EXIT(FM_LOG_CAT_PHY, status);
 
+}   /* end fmUtilGN2412InitializeComplete */
+
+
+
+
+/*****************************************************************************/
+/* fmUtilGN2412Initialize
+ * \ingroup platformUtils
+ *
+ * \desc            Initializes a retimer. Equivalent to
+ *                  fmUtilGN2412InitializeStart followed by
+ *                  fmUtilGN2412InitializeComplete.
+ *
+ * \param[in]       handle is the handle to the I2C device.
+ *
+ * \param[in]       func is the I2C write read function to call.
+ *
+ * \param[in]       dev is the device I2C address.
+ *
+ * \param[in]       cfg pointer to GN2412 configuration.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+fm_status fmUtilGN2412Initialize(fm_uintptr                  handle,
+                                 fm_utilI2cWriteReadHdnlFunc func,
+                                 fm_uint                     dev,
+                                 fm_gn2412Cfg *              cfg)
+{
+    fm_status status;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PHY, "dev=0x%x\n", dev);
+
+    status = fmUtilGN2412InitializeStart(handle, func, dev, cfg);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PHY,status);
+
+    status = fmUtilGN2412InitializeComplete(handle, func, dev, cfg);
+
+ABORT:
+    FM_LOG_EXIT(FM_LOG_CAT_PHY, status);
+
 }   /* end fmUtilGN2412Initialize */